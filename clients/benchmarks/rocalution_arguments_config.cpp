@@ -107,6 +107,16 @@ void rocalution_arguments_config::set_description(options_description& desc)
             ADD_OPTION(double, e, 0.005, "coupling strength coefficient for multigrid");
             break;
         }
+        case rocalution_bench_solver_parameters::stencil_coef:
+        {
+            ADD_OPTION(double,
+                       e,
+                       0.0,
+                       "coefficient of the synthetic 3D matrices (anisotropy, coefficient jump, "
+                       "cell Peclet number or coupling strength), 0 selects the default of the "
+                       "matrix");
+            break;
+        }
         }
     }
 
@@ -209,6 +219,12 @@ void rocalution_arguments_config::set_description(options_description& desc)
             ADD_OPTION(int, e, 3, "block dimension.");
             break;
         }
+
+        case rocalution_bench_solver_parameters::kernel_iter:
+        {
+            ADD_OPTION(int, e, 100, "number of timed repetitions per kernel (see --kernel).");
+            break;
+        }
         }
     }
 
@@ -255,6 +271,15 @@ void rocalution_arguments_config::set_description(options_description& desc)
             ADD_OPTION(std::string, e, "Default", "ItILU0 algorithm");
             break;
         }
+        case rocalution_bench_solver_parameters::kernel:
+        {
+            ADD_OPTION(std::string,
+                       e,
+                       "",
+                       "run kernel microbenchmarks instead of an iterative solve (spmv, spgemm, "
+                       "trisolve, blas1 or all).");
+            break;
+        }
         case rocalution_bench_solver_parameters::matrix:
         {
             ADD_OPTION(std::string, e, "", "matrix initialization");
@@ -294,6 +319,25 @@ void rocalution_arguments_config::set_description(options_description& desc)
             ADD_OPTION(bool, e, false, "use level in mcilu");
             break;
         }
+        case rocalution_bench_solver_parameters::kernel_counters:
+        {
+            ADD_OPTION(bool,
+                       e,
+                       false,
+                       "sample host hardware counters (DRAM bytes, cache hit rate, IPC) with "
+                       "PAPI during the kernel microbenchmarks, runs on the host (see --kernel).");
+            break;
+        }
+        case rocalution_bench_solver_parameters::tune_amg:
+        {
+            ADD_OPTION(bool,
+                       e,
+                       false,
+                       "search the AMG parameters with the minimal setup plus solve time, the AMG "
+                       "preconditions --iterative_solver (cg, fcg, bicgstab, gmres, fgmres) or is "
+                       "tuned as solver.");
+            break;
+        }
         }
     }
 }
@@ -322,6 +366,10 @@ int rocalution_arguments_config::parse(int& argc, char**& argv, options_descript
         {
             break;
         }
+        case rocalution_bench_solver_parameters::kernel:
+        {
+            break;
+        }
         case rocalution_bench_solver_parameters::smoother:
         {
 
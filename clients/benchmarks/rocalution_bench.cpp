@@ -23,7 +23,9 @@
 * ************************************************************************ */
 
 #include "rocalution_bench.hpp"
+#include "rocalution_bench_kernels.hpp"
 #include "rocalution_bench_template.hpp"
+#include "rocalution_bench_tune.hpp"
 
 #define TO_STR2(x) #x
 #define TO_STR(x) TO_STR2(x)
@@ -68,16 +70,42 @@ bool rocalution_bench::execute()
     // Set up rocalution.
     //
     set_device_rocalution(device);
+
+    // Host hardware counters are only meaningful, if the kernels run on the host
+    const bool kernels = this->config.Get(rocalution_bench_solver_parameters::kernel) != "";
+
+    disable_accelerator_rocalution(
+        kernels && this->config.Get(rocalution_bench_solver_parameters::kernel_counters));
+
     init_rocalution();
 
     //
     // Run the benchmark.
     //
     bool success;
-    success = rocalution_bench_template<double>(this->config);
-    if(!success)
+    if(this->config.Get(rocalution_bench_solver_parameters::tune_amg))
+    {
+        success = rocalution_bench_tune_template<double>(this->config);
+        if(!success)
+        {
+            rocalution_bench_errmsg << "rocalution_bench_tune_template failed." << std::endl;
+        }
+    }
+    else if(kernels)
+    {
+        success = rocalution_bench_kernels_template<double>(this->config);
+        if(!success)
+        {
+            rocalution_bench_errmsg << "rocalution_bench_kernels_template failed." << std::endl;
+        }
+    }
+    else
     {
-        rocalution_bench_errmsg << "rocalution_bench_template failed." << std::endl;
+        success = rocalution_bench_template<double>(this->config);
+        if(!success)
+        {
+            rocalution_bench_errmsg << "rocalution_bench_template failed." << std::endl;
+        }
     }
 
     //
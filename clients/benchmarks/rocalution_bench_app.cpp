@@ -161,12 +161,21 @@ void rocalution_bench_app::series_lower_upper(int
                                               double& lower,
                                               double& upper)
 {
-    static constexpr double alpha = 0.95;
-    std::vector<double>     s(N);
+    std::vector<double> s(N);
     for(int i = 0; i < N; ++i)
     {
         s[i] = r[i].Get(e);
     }
+    series_lower_upper(s, median, lower, upper);
+}
+
+void rocalution_bench_app::series_lower_upper(std::vector<double>& s,
+                                              double&              median,
+                                              double&              lower,
+                                              double&              upper)
+{
+    static constexpr double alpha = 0.95;
+    const int               N     = s.size();
     std::sort(s.begin(), s.end());
     double interval[2];
 
@@ -178,7 +187,10 @@ void rocalution_bench_app::series_lower_upper(int
     upper  = interval[1];
 }
 
-void rocalution_bench_app::export_item(std::ostream& out, rocalution_bench_timing_t::item_t& item)
+void rocalution_bench_app::export_item(std::ostream&                      out,
+                                       std::ostream&                      csv,
+                                       int                                isample,
+                                       rocalution_bench_timing_t::item_t& item)
 {
     out << " \"setup\"  : { ";
     item.m_parameters.WriteJson(out);
@@ -239,6 +251,60 @@ void rocalution_bench_app::export_item(std::ostream& out, rocalution_bench_timin
             res_up.Set(e, upper);
         }
 
+        const int nlevels = item.m_results[0].GetNumLevels();
+        res.SetNumLevels(nlevels);
+        res_low.SetNumLevels(nlevels);
+        res_up.SetNumLevels(nlevels);
+        for(int level = 0; level < nlevels; ++level)
+        {
+            for(auto e : rocalution_bench_solver_results::e_level_all)
+            {
+                std::vector<double> s(N);
+                for(int i = 0; i < N; ++i)
+                {
+                    s[i] = item.m_results[i].Get(level, e);
+                }
+
+                double median;
+                double lower;
+                double upper;
+                series_lower_upper(s, median, lower, upper);
+
+                res.Set(level, e, median);
+                res_low.Set(level, e, lower);
+                res_up.Set(level, e, upper);
+            }
+        }
+
+        const int nkernels = item.m_results[0].GetNumKernels();
+        res.SetNumKernels(nkernels);
+        res_low.SetNumKernels(nkernels);
+        res_up.SetNumKernels(nkernels);
+        for(int kernel = 0; kernel < nkernels; ++kernel)
+        {
+            const std::string& name = item.m_results[0].GetKernelName(kernel);
+            res.SetKernelName(kernel, name);
+            res_low.SetKernelName(kernel, name);
+            res_up.SetKernelName(kernel, name);
+            for(auto e : rocalution_bench_solver_results::e_kernel_all)
+            {
+                std::vector<double> s(N);
+                for(int i = 0; i < N; ++i)
+                {
+                    s[i] = item.m_results[i].Get(kernel, e);
+                }
+
+                double median;
+                double lower;
+                double upper;
+                series_lower_upper(s, median, lower, upper);
+
+                res.Set(kernel, e, median);
+                res_low.Set(kernel, e, lower);
+                res_up.Set(kernel, e, upper);
+            }
+        }
+
         out << " \"nsamples\": \"" << N << "\"," << std::endl;
         out << " \"median\"  : { ";
         res.WriteJson(out);
@@ -249,6 +315,8 @@ void rocalution_bench_app::export_item(std::ostream& out, rocalution_bench_timin
         out << " \"up\"      : { ";
         res_up.WriteJson(out);
         out << " }" << std::endl;
+
+        res.WriteCsv(csv, isample);
     }
     else
     {
@@ -262,6 +330,8 @@ void rocalution_bench_app::export_item(std::ostream& out, rocalution_bench_timin
         out << " \"up\"  : { ";
         item.m_results[0].WriteJson(out);
         out << " }" << std::endl;
+
+        item.m_results[0].WriteCsv(csv, isample);
     }
 }
 
@@ -280,6 +350,12 @@ bool rocalution_bench_app::export_file()
 
     std::ofstream out(ofilename);
 
+    //
+    // The median results are also written as csv rows next to the json file.
+    //
+    std::ofstream csv(std::string(ofilename) + ".csv");
+    csv << "sample,level,name,value" << std::endl;
+
     int   sample_argc;
     char* sample_argv[64];
 
@@ -318,7 +394,7 @@ bool rocalution_bench_app::export_file()
         this->define_case_json(out, isample, sample_argc, sample_argv);
         out << "{ ";
         {
-            this->export_item(out, this->m_bench_timing[isample]);
+            this->export_item(out, csv, isample, this->m_bench_timing[isample]);
         }
         out << " }";
         this->close_case_json(out, isample, sample_argc, sample_argv);
@@ -334,6 +410,7 @@ bool rocalution_bench_app::export_file()
         return status;
     }
     out.close();
+    csv.close();
     return true;
 }
 
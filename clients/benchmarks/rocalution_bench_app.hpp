@@ -290,7 +290,10 @@ public:
     }
 
 protected:
-    void        export_item(std::ostream& out, rocalution_bench_timing_t::item_t& item);
+    void        export_item(std::ostream&                      out,
+                            std::ostream&                      csv,
+                            int                                isample,
+                            rocalution_bench_timing_t::item_t& item);
     bool        define_case_json(std::ostream& out, int isample, int argc, char** argv);
     bool        close_case_json(std::ostream& out, int isample, int argc, char** argv);
     bool        define_results_json(std::ostream& out);
@@ -306,4 +309,8 @@ protected:
                                    double&                                             median,
                                    double&                                             lower,
                                    double&                                             upper);
+    static void series_lower_upper(std::vector<double>& s,
+                                   double&              median,
+                                   double&              lower,
+                                   double&              upper);
 };
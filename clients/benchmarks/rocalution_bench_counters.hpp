@@ -0,0 +1,278 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#ifdef ROCALUTION_BENCH_WITH_PAPI
+#include <papi.h>
+#include <pthread.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//
+// @brief Hardware counter sampling of the kernel microbenchmarks.
+// @details Reads the last level cache and instruction counters of the host with PAPI while
+// a kernel is repeated, and derives the DRAM traffic (last level cache misses times the
+// cache line size), the last level cache hit rate and the instructions per cycle. Each
+// OpenMP thread counts with its own event set and the counts are summed over the threads.
+// Counting requires the benchmark to be built with BUILD_CLIENTS_BENCHMARKS_PAPI; without
+// it, Init() fails and the counters are reported as zero. Events that are not available on
+// the host are skipped and the metrics derived from them are reported as zero.
+//
+struct rocalution_bench_counters
+{
+    //
+    // @brief Metrics per kernel call.
+    //
+    struct metrics
+    {
+        double dram_bytes{};
+        double cache_hit_rate{};
+        double ipc{};
+    };
+
+private:
+    typedef enum e_event_ : int
+    {
+        llc_misses,
+        llc_accesses,
+        instructions,
+        cycles,
+        nevents
+    } e_event;
+
+    //
+    // @brief Bytes per cache line, used to convert cache misses into DRAM traffic.
+    //
+    static constexpr double s_line_size = 64.0;
+
+    bool m_init{};
+
+    //
+    // @brief Position of each event in the counter values, -1 if not available.
+    //
+    int m_slot[nevents]{};
+    int m_nslots{};
+
+    //
+    // @brief Event set and counter values of each thread.
+    //
+    std::vector<int>       m_eventsets{};
+    std::vector<long long> m_values{};
+
+    static int NumThreads()
+    {
+#ifdef _OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
+    static int ThreadNum()
+    {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
+#ifdef ROCALUTION_BENCH_WITH_PAPI
+    static unsigned long ThreadId()
+    {
+        return static_cast<unsigned long>(pthread_self());
+    }
+#endif
+
+public:
+    rocalution_bench_counters()
+    {
+        for(int e = 0; e < nevents; ++e)
+        {
+            this->m_slot[e] = -1;
+        }
+    }
+
+    ~rocalution_bench_counters()
+    {
+#ifdef ROCALUTION_BENCH_WITH_PAPI
+        if(this->m_init)
+        {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                int& eventset = this->m_eventsets[ThreadNum()];
+                PAPI_cleanup_eventset(eventset);
+                PAPI_destroy_eventset(&eventset);
+                PAPI_unregister_thread();
+            }
+        }
+#endif
+    }
+
+    //
+    // @brief Set up the event sets, returns false if counting is not possible.
+    //
+    bool Init()
+    {
+#ifdef ROCALUTION_BENCH_WITH_PAPI
+        if(PAPI_library_init(PAPI_VER_CURRENT) != PAPI_VER_CURRENT)
+        {
+            return false;
+        }
+
+        if(PAPI_thread_init(ThreadId) != PAPI_OK)
+        {
+            return false;
+        }
+
+        // Every thread adds the same events, the availability is queried once
+        const char* names[nevents]
+            = {"PAPI_L3_TCM", "PAPI_L3_TCA", "PAPI_TOT_INS", "PAPI_TOT_CYC"};
+
+        std::vector<std::string> available;
+        for(int e = 0; e < nevents; ++e)
+        {
+            if(PAPI_query_named_event(names[e]) == PAPI_OK)
+            {
+                this->m_slot[e] = this->m_nslots++;
+                available.push_back(names[e]);
+            }
+        }
+
+        if(this->m_nslots == 0)
+        {
+            return false;
+        }
+
+        const int nthreads = NumThreads();
+
+        this->m_eventsets.assign(nthreads, PAPI_NULL);
+        this->m_values.assign(nthreads * this->m_nslots, 0);
+
+        bool success = true;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(&& : success)
+#endif
+        {
+            int& eventset = this->m_eventsets[ThreadNum()];
+
+            success = PAPI_register_thread() == PAPI_OK
+                      && PAPI_create_eventset(&eventset) == PAPI_OK;
+
+            for(size_t i = 0; success && i < available.size(); ++i)
+            {
+                success = PAPI_add_named_event(eventset, available[i].c_str()) == PAPI_OK;
+            }
+        }
+
+        this->m_init = success;
+#endif
+
+        return this->m_init;
+    }
+
+    //
+    // @brief Start counting on all threads.
+    //
+    void Start()
+    {
+#ifdef ROCALUTION_BENCH_WITH_PAPI
+        if(!this->m_init)
+        {
+            return;
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            PAPI_start(this->m_eventsets[ThreadNum()]);
+        }
+#endif
+    }
+
+    //
+    // @brief Stop counting on all threads and return the metrics per call of @p ncalls
+    // calls.
+    //
+    metrics Stop(int ncalls)
+    {
+        metrics m;
+
+#ifdef ROCALUTION_BENCH_WITH_PAPI
+        if(!this->m_init)
+        {
+            return m;
+        }
+
+        const int nslots = this->m_nslots;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            const int tid = ThreadNum();
+            PAPI_stop(this->m_eventsets[tid], &this->m_values[tid * nslots]);
+        }
+
+        // Sum the counts of the threads
+        double count[nevents] = {};
+        for(int e = 0; e < nevents; ++e)
+        {
+            if(this->m_slot[e] < 0)
+            {
+                continue;
+            }
+
+            for(size_t t = 0; t < this->m_eventsets.size(); ++t)
+            {
+                count[e] += static_cast<double>(this->m_values[t * nslots + this->m_slot[e]]);
+            }
+        }
+
+        m.dram_bytes = count[llc_misses] * s_line_size / ncalls;
+
+        if(this->m_slot[llc_misses] >= 0 && count[llc_accesses] > 0.0)
+        {
+            m.cache_hit_rate = 1.0 - count[llc_misses] / count[llc_accesses];
+        }
+
+        if(count[cycles] > 0.0)
+        {
+            m.ipc = count[instructions] / count[cycles];
+        }
+#endif
+
+        return m;
+    }
+};
@@ -0,0 +1,115 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include <rocalution/rocalution.hpp>
+using namespace rocalution;
+
+#include "rocalution_bench_solver_parameters.hpp"
+
+//
+// @brief Import the matrix of the configuration.
+//
+template <typename T>
+bool rocalution_bench_import_matrix(const rocalution_bench_solver_parameters& params,
+                                    LocalMatrix<T>&                           A)
+{
+    using params_t = rocalution_bench_solver_parameters;
+
+    auto matrix_init = params.GetEnumMatrixInit();
+    if(matrix_init.is_invalid())
+    {
+        rocalution_bench_errmsg << "matrix initialization is invalid" << std::endl;
+        return false;
+    }
+
+    switch(matrix_init.value)
+    {
+    case rocalution_enum_matrix_init::laplacian:
+    {
+        int*      csr_ptr = NULL;
+        int*      csr_col = NULL;
+        T*        csr_val = NULL;
+        const int ndim    = params.Get(params_t::ndim);
+        auto      nrow    = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+        A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", csr_ptr[nrow], nrow, nrow);
+        return true;
+    }
+
+    case rocalution_enum_matrix_init::permuted_identity:
+    {
+        int*      csr_ptr = NULL;
+        int*      csr_col = NULL;
+        T*        csr_val = NULL;
+        const int ndim    = params.Get(params_t::ndim);
+        auto      nrow    = gen_permuted_identity(ndim, &csr_ptr, &csr_col, &csr_val);
+        A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", csr_ptr[nrow], nrow, nrow);
+        return true;
+    }
+
+    case rocalution_enum_matrix_init::laplacian_3d_7pt:
+    case rocalution_enum_matrix_init::laplacian_3d_27pt:
+    case rocalution_enum_matrix_init::anisotropic_3d:
+    case rocalution_enum_matrix_init::jump_3d:
+    case rocalution_enum_matrix_init::convection_diffusion_3d:
+    case rocalution_enum_matrix_init::elasticity_3d:
+    {
+        //
+        // Synthetic 3D problems with ndim grid points in each direction.
+        //
+        stencil_3d_problem problem{};
+        matrix_init.is_stencil_3d(&problem);
+
+        double coef = params.Get(params_t::stencil_coef);
+        if(coef == 0.0)
+        {
+            coef = stencil_3d_default_coef(problem);
+        }
+
+        int*      csr_ptr = NULL;
+        int*      csr_col = NULL;
+        T*        csr_val = NULL;
+        const int ndim    = params.Get(params_t::ndim);
+        auto      nrow    = gen_3d_stencil(problem, coef, ndim, &csr_ptr, &csr_col, &csr_val);
+        A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", csr_ptr[nrow], nrow, nrow);
+        return true;
+    }
+
+    case rocalution_enum_matrix_init::file:
+    {
+        const std::string matrix_filename = params.Get(params_t::matrix_filename);
+        if(matrix_filename == "")
+        {
+            rocalution_bench_errmsg << "no filename for matrix file initialization." << std::endl;
+            return false;
+        }
+
+        A.ReadFileMTX(matrix_filename);
+        A.ConvertToCSR();
+        return true;
+    }
+    }
+
+    return false;
+}
@@ -205,10 +205,34 @@ public:
             return false;
         }
 
+        //
+        // Multigrid preconditioners record the time spent on each level.
+        //
+        BaseMultiGrid<LocalMatrix<T>, LocalVector<T>, T>* multigrid = nullptr;
+        {
+            Solver<LocalMatrix<T>, LocalVector<T>, T>* preconditioner
+                = this->m_driver.GetPreconditioner();
+            multigrid
+                = dynamic_cast<BaseMultiGrid<LocalMatrix<T>, LocalVector<T>, T>*>(preconditioner);
+        }
+
+        if(multigrid != nullptr)
+        {
+            multigrid->SetLevelTiming(true);
+            multigrid->ResetLevelTime();
+        }
+
         //
         // Solve
         //
+        set_time_breakdown_rocalution(true);
+        reset_time_breakdown_rocalution();
+
+        double t_solve = rocalution_time();
         this->m_solver.Solve(B, &X);
+        t_solve = (rocalution_time() - t_solve) / 1e3;
+
+        set_time_breakdown_rocalution(false);
 
         //
         // Post solve.
@@ -231,6 +255,53 @@ public:
             results.Set(results_t::convergence, (status == 1) ? true : false);
         }
 
+        //
+        // Record the time breakdown of the solve (in ms), the remaining time is spent in
+        // vector operations.
+        //
+        {
+            const double t_spmv    = get_time_breakdown_rocalution(TimeSpMV) * 1e3;
+            const double t_precond = get_time_breakdown_rocalution(TimePreconditioner) * 1e3;
+            const double t_comm    = (get_time_breakdown_rocalution(TimeCommunication)
+                                   + get_time_breakdown_rocalution(TimeAllreduce))
+                                  * 1e3;
+
+            results.Set(results_t::time_spmv, t_spmv);
+            results.Set(results_t::time_precond, t_precond);
+            results.Set(results_t::time_comm, t_comm);
+            results.Set(results_t::time_vector,
+                        std::max(t_solve - t_spmv - t_precond - t_comm, 0.0));
+        }
+
+        if(multigrid != nullptr)
+        {
+            auto* amg = dynamic_cast<BaseAMG<LocalMatrix<T>, LocalVector<T>, T>*>(multigrid);
+
+            const int nlevels = amg != nullptr ? amg->GetNumLevels() : 0;
+            results.SetNumLevels(nlevels);
+
+            for(int level = 0; level < nlevels; ++level)
+            {
+                double smoother_build;
+                double smoothing;
+                double residual;
+                double transfer;
+                multigrid->GetLevelTime(level, &smoother_build, &smoothing, &residual, &transfer);
+
+                // The coarsest level has no transfer operators.
+                const double setup
+                    = (level < nlevels - 1) ? amg->GetHierarchyTime(level) * 1e3 : 0.0;
+
+                results.Set(level, results_t::time_level_setup, setup);
+                results.Set(level, results_t::time_smoother_build, smoother_build * 1e3);
+                results.Set(level, results_t::time_smoothing, smoothing * 1e3);
+                results.Set(level, results_t::time_residual, residual * 1e3);
+                results.Set(level, results_t::time_transfer, transfer * 1e3);
+            }
+
+            multigrid->SetLevelTiming(false);
+        }
+
         return true;
     }
 };
@@ -0,0 +1,496 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include <rocalution/rocalution.hpp>
+using namespace rocalution;
+
+#include "rocalution_bench_counters.hpp"
+#include "rocalution_bench_import.hpp"
+#include "rocalution_bench_solver_parameters.hpp"
+#include "rocalution_bench_solver_results.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+bool rocalution_bench_record_results(const rocalution_bench_solver_parameters&,
+                                     const rocalution_bench_solver_results&);
+
+//
+// @brief Kernel microbenchmarks.
+// @details Times single kernels (SpMV per matrix format, SpGEMM, Galerkin triple product,
+// triangular solves and BLAS1 vector operations) on the matrix of the benchmark
+// configuration and reports the achieved bandwidth and throughput. The bandwidth is
+// compared against a STREAM copy bandwidth measured with the same backend. Bytes are
+// counted for the compulsory traffic of the CSR representation, i.e. padding of ELL, DIA
+// or BCSR is not counted and shows up as lower effective bandwidth. The per kernel results
+// are recorded like the solver results and are written to the json output file. With
+// --kernel-counters, the kernels run on the host and are repeated once more while the
+// hardware counters are sampled (see rocalution_bench_counters).
+//
+template <typename T>
+struct rocalution_bench_kernels
+{
+    using params_t = rocalution_bench_solver_parameters;
+
+private:
+    const params_t* m_params{};
+
+    //
+    // @brief Number of timed repetitions per kernel.
+    //
+    int m_iter{};
+
+    //
+    // @brief Measured STREAM copy bandwidth in GB/s.
+    //
+    double m_stream_bw{};
+
+    //
+    // @brief Per kernel results, recorded with the benchmark results.
+    //
+    rocalution_bench_solver_results m_results{};
+
+    //
+    // @brief Hardware counters, sampled if enabled.
+    //
+    rocalution_bench_counters m_counters{};
+    bool                      m_sample_counters{};
+
+    //
+    // @brief Counter metrics of the last timed kernel.
+    //
+    rocalution_bench_counters::metrics m_metrics{};
+
+    //
+    // @brief Time a kernel in microseconds per call, after one warm up call. The counters
+    // are sampled in a separate set of repetitions, to keep them out of the timing.
+    //
+    template <typename F>
+    double Time(F&& f)
+    {
+        f();
+
+        double t = rocalution_time();
+        for(int i = 0; i < this->m_iter; ++i)
+        {
+            f();
+        }
+
+        t = (rocalution_time() - t) / this->m_iter;
+
+        this->m_metrics = rocalution_bench_counters::metrics();
+
+        if(this->m_sample_counters)
+        {
+            this->m_counters.Start();
+            for(int i = 0; i < this->m_iter; ++i)
+            {
+                f();
+            }
+            this->m_metrics = this->m_counters.Stop(this->m_iter);
+        }
+
+        return t;
+    }
+
+    //
+    // @brief Print one result line.
+    //
+    void Report(const std::string& name, double usec, double bytes, double flops)
+    {
+        const double gbs    = bytes / (usec * 1e3);
+        const double gflops = flops / (usec * 1e3);
+
+        const int kernel = this->m_results.GetNumKernels();
+        this->m_results.AddKernel(name);
+        this->m_results.Set(kernel, rocalution_bench_solver_results::time_kernel, usec);
+        this->m_results.Set(kernel, rocalution_bench_solver_results::bandwidth, gbs);
+        this->m_results.Set(kernel, rocalution_bench_solver_results::gflops, gflops);
+        this->m_results.Set(
+            kernel, rocalution_bench_solver_results::dram_bytes, this->m_metrics.dram_bytes);
+        this->m_results.Set(kernel,
+                            rocalution_bench_solver_results::cache_hit_rate,
+                            this->m_metrics.cache_hit_rate);
+        this->m_results.Set(kernel, rocalution_bench_solver_results::ipc, this->m_metrics.ipc);
+
+        std::cout << std::setw(24) << name << std::setw(14) << std::fixed << std::setprecision(2)
+                  << usec << std::setw(12) << gbs << std::setw(12) << gflops << std::setw(12)
+                  << (this->m_stream_bw > 0.0 ? 100.0 * gbs / this->m_stream_bw : 0.0);
+
+        if(this->m_sample_counters)
+        {
+            std::cout << std::setw(14) << this->m_metrics.dram_bytes / 1e6 << std::setw(12)
+                      << 100.0 * this->m_metrics.cache_hit_rate << std::setw(8)
+                      << this->m_metrics.ipc;
+        }
+
+        std::cout << std::endl;
+    }
+
+    //
+    // @brief Bytes of a CSR matrix.
+    //
+    static double CSRBytes(const LocalMatrix<T>& A)
+    {
+        return static_cast<double>(A.GetNnz()) * (sizeof(T) + sizeof(int))
+               + static_cast<double>(A.GetM() + 1) * sizeof(PtrType);
+    }
+
+    //
+    // @brief STREAM copy bandwidth of the current backend.
+    //
+    void BenchStream(int64_t size)
+    {
+        LocalVector<T> x;
+        LocalVector<T> y;
+
+        x.MoveToAccelerator();
+        y.MoveToAccelerator();
+
+        x.Allocate("x", size);
+        y.Allocate("y", size);
+
+        x.Ones();
+
+        double usec      = this->Time([&] { y.CopyFrom(x); });
+        this->m_stream_bw = 2.0 * size * sizeof(T) / (usec * 1e3);
+
+        this->Report("stream_copy", usec, 2.0 * size * sizeof(T), 0.0);
+    }
+
+    //
+    // @brief SpMV for each matrix format.
+    //
+    void BenchSpMV(const LocalMatrix<T>& A)
+    {
+        const int    blockdim = this->m_params->Get(params_t::blockdim);
+        const double bytes    = CSRBytes(A) + (A.GetM() + A.GetN()) * sizeof(T);
+        const double flops    = 2.0 * A.GetNnz();
+
+        LocalVector<T> x;
+        LocalVector<T> y;
+
+        x.MoveToAccelerator();
+        y.MoveToAccelerator();
+
+        x.Allocate("x", A.GetN());
+        y.Allocate("y", A.GetM());
+
+        x.Ones();
+
+        const unsigned int formats[] = {CSR, BCSR, ELL, HYB, DIA, SELL, VBR};
+
+        for(auto format : formats)
+        {
+            // BCSR requires the dimension to be a multiple of the block dimension
+            if(format == BCSR && (A.GetM() % blockdim != 0 || A.GetN() % blockdim != 0))
+            {
+                continue;
+            }
+
+            LocalMatrix<T> B;
+            B.CloneFrom(A);
+            B.ConvertTo(format, format == BCSR ? blockdim : 1);
+
+            // Skip formats, the matrix cannot be converted to (e.g. DIA)
+            if(B.GetFormat() != format)
+            {
+                continue;
+            }
+
+            double usec = this->Time([&] { B.Apply(x, &y); });
+
+            this->Report("spmv_" + _matrix_format_names[format], usec, bytes, flops);
+        }
+    }
+
+    //
+    // @brief SpGEMM C = A * A and Galerkin product A_c = P^T A P of an aggregation.
+    //
+    void BenchSpGEMM(const LocalMatrix<T>& A)
+    {
+        // Flops of A * A from the row lengths of A
+        std::vector<PtrType> ptr(A.GetM() + 1);
+        std::vector<int>     col(A.GetNnz());
+        std::vector<T>       val(A.GetNnz());
+        A.CopyToCSR(ptr.data(), col.data(), val.data());
+
+        double flops = 0.0;
+        for(int64_t j = 0; j < A.GetNnz(); ++j)
+        {
+            flops += 2.0 * (ptr[col[j] + 1] - ptr[col[j]]);
+        }
+
+        LocalMatrix<T> C;
+        C.CloneBackend(A);
+
+        double usec = this->Time([&] { C.MatrixMult(A, A); });
+
+        this->Report("spgemm", usec, 2.0 * CSRBytes(A) + CSRBytes(C), flops);
+
+        // Prolongation of a plain aggregation
+        LocalVector<bool>    connections;
+        LocalVector<int64_t> aggregates;
+        LocalVector<int64_t> aggregate_root_nodes;
+
+        connections.CloneBackend(A);
+        aggregates.CloneBackend(A);
+        aggregate_root_nodes.CloneBackend(A);
+
+        A.AMGGreedyAggregate(
+            static_cast<T>(0.01), &connections, &aggregates, &aggregate_root_nodes);
+
+        LocalMatrix<T> P;
+        LocalMatrix<T> R;
+        P.CloneBackend(A);
+        R.CloneBackend(A);
+
+        A.AMGUnsmoothedAggregation(aggregates, aggregate_root_nodes, &P);
+        P.Transpose(&R);
+
+        LocalMatrix<T> Ac;
+        Ac.CloneBackend(A);
+
+        usec = this->Time([&] { Ac.TripleMatrixProduct(R, A, P); });
+
+        this->Report("galerkin_RAP",
+                     usec,
+                     CSRBytes(R) + CSRBytes(A) + CSRBytes(P) + CSRBytes(Ac),
+                     2.0 * A.GetNnz() + 2.0 * R.GetNnz());
+
+        usec = this->Time([&] { Ac.TripleMatrixProductNumeric(R, A, P); });
+
+        this->Report("galerkin_RAP_numeric",
+                     usec,
+                     CSRBytes(R) + CSRBytes(A) + CSRBytes(P) + CSRBytes(Ac),
+                     2.0 * A.GetNnz() + 2.0 * R.GetNnz());
+    }
+
+    //
+    // @brief Level scheduled and iterative (Jacobi) triangular solves with the lower and
+    // upper triangular part of A.
+    //
+    void BenchTriangular(const LocalMatrix<T>& A)
+    {
+        const int    itsolve_max_iter = this->m_params->Get(params_t::itsolve_max_iter);
+        const double itsolve_tol      = this->m_params->Get(params_t::itsolve_tol);
+
+        LocalMatrix<T> L;
+        LocalMatrix<T> U;
+        L.CloneBackend(A);
+        U.CloneBackend(A);
+
+        A.ExtractL(&L, true);
+        A.ExtractU(&U, true);
+
+        LocalVector<T> x;
+        LocalVector<T> y;
+
+        x.MoveToAccelerator();
+        y.MoveToAccelerator();
+
+        x.Allocate("x", A.GetN());
+        y.Allocate("y", A.GetM());
+
+        x.Ones();
+
+        const double vec_bytes = 2.0 * A.GetM() * sizeof(T);
+
+        L.LAnalyse(false);
+        U.UAnalyse(false);
+
+        double usec = this->Time([&] { L.LSolve(x, &y); });
+        this->Report("lsolve", usec, CSRBytes(L) + vec_bytes, 2.0 * L.GetNnz());
+
+        usec = this->Time([&] { U.USolve(x, &y); });
+        this->Report("usolve", usec, CSRBytes(U) + vec_bytes, 2.0 * U.GetNnz());
+
+        L.LAnalyseClear();
+        U.UAnalyseClear();
+
+        // Bytes and flops of the iterative solves are given per sweep
+        L.ItLAnalyse(false);
+
+        usec = this->Time([&] { L.ItLSolve(itsolve_max_iter, itsolve_tol, false, x, &y); })
+               / itsolve_max_iter;
+        this->Report("itlsolve_sweep", usec, CSRBytes(L) + vec_bytes, 2.0 * L.GetNnz());
+
+        L.ItLAnalyseClear();
+    }
+
+    //
+    // @brief BLAS1 vector operations.
+    //
+    void BenchBLAS1(int64_t size)
+    {
+        LocalVector<T> x;
+        LocalVector<T> y;
+        LocalVector<T> z;
+
+        x.MoveToAccelerator();
+        y.MoveToAccelerator();
+        z.MoveToAccelerator();
+
+        x.Allocate("x", size);
+        y.Allocate("y", size);
+        z.Allocate("z", size);
+
+        x.Ones();
+        y.Ones();
+        z.Ones();
+
+        const double n = static_cast<double>(size);
+        const double s = sizeof(T);
+
+        // Scalars close to one keep the values bounded over many repetitions
+        const T alpha = static_cast<T>(1e-3);
+        const T one   = static_cast<T>(1);
+        T       res[2];
+
+        double usec;
+
+        usec = this->Time([&] { x.Dot(y); });
+        this->Report("dot", usec, 2.0 * n * s, 2.0 * n);
+
+        usec = this->Time([&] { x.Norm(); });
+        this->Report("norm", usec, n * s, 2.0 * n);
+
+        usec = this->Time([&] { y.AddScale(x, alpha); });
+        this->Report("axpy", usec, 3.0 * n * s, 2.0 * n);
+
+        usec = this->Time([&] { y.ScaleAdd(one, x); });
+        this->Report("scaleadd", usec, 3.0 * n * s, 2.0 * n);
+
+        usec = this->Time([&] { y.ScaleAddScale(one, x, alpha); });
+        this->Report("axpby", usec, 3.0 * n * s, 3.0 * n);
+
+        usec = this->Time([&] { z.ScaleAdd2(one, x, alpha, y, alpha); });
+        this->Report("scaleadd2", usec, 4.0 * n * s, 5.0 * n);
+
+        usec = this->Time([&] { z.PointWiseMult(x, y); });
+        this->Report("pointwisemult", usec, 3.0 * n * s, n);
+
+        usec = this->Time([&] { z.AddScaleDot(x, alpha, y); });
+        this->Report("axpy_dot", usec, 4.0 * n * s, 4.0 * n);
+
+        usec = this->Time([&] { z.AddScaleNorm(x, alpha); });
+        this->Report("axpy_norm", usec, 3.0 * n * s, 4.0 * n);
+
+        usec = this->Time([&] { z.DualDot(x, y, res); });
+        this->Report("dual_dot", usec, 3.0 * n * s, 4.0 * n);
+    }
+
+public:
+    rocalution_bench_kernels(const params_t* params)
+        : m_params(params)
+    {
+    }
+
+    bool Run()
+    {
+        const std::string kernel = this->m_params->Get(params_t::kernel);
+
+        const bool all = (kernel == "all");
+
+        if(!all && kernel != "spmv" && kernel != "spgemm" && kernel != "trisolve"
+           && kernel != "blas1")
+        {
+            rocalution_bench_errmsg << "invalid kernel '" << kernel
+                                    << "', use spmv, spgemm, trisolve, blas1 or all."
+                                    << std::endl;
+            return false;
+        }
+
+        this->m_iter = std::max(1, this->m_params->Get(params_t::kernel_iter));
+
+        if(this->m_params->Get(params_t::kernel_counters))
+        {
+            this->m_sample_counters = this->m_counters.Init();
+            if(!this->m_sample_counters)
+            {
+                std::cout << "hardware counters are not available, the benchmark is not built "
+                             "with PAPI or PAPI cannot access the events."
+                          << std::endl;
+            }
+        }
+
+        LocalMatrix<T> A;
+        if(!rocalution_bench_import_matrix(*this->m_params, A))
+        {
+            return false;
+        }
+
+        A.MoveToAccelerator();
+
+        std::cout << "matrix: " << A.GetM() << " x " << A.GetN() << ", nnz " << A.GetNnz()
+                  << ", repetitions " << this->m_iter << std::endl;
+
+        std::cout << std::setw(24) << "kernel" << std::setw(14) << "time (us)" << std::setw(12)
+                  << "GB/s" << std::setw(12) << "GFLOP/s" << std::setw(12) << "% STREAM";
+
+        if(this->m_sample_counters)
+        {
+            std::cout << std::setw(14) << "DRAM (MB)" << std::setw(12) << "LLC hit %"
+                      << std::setw(8) << "IPC";
+        }
+
+        std::cout << std::endl;
+
+        // The STREAM reference uses a vector that does not fit into the caches
+        const int64_t stream_size = std::max<int64_t>(A.GetNnz(), int64_t(1) << 25);
+
+        this->BenchStream(stream_size);
+
+        if(all || kernel == "spmv")
+        {
+            this->BenchSpMV(A);
+        }
+        if(all || kernel == "spgemm")
+        {
+            this->BenchSpGEMM(A);
+        }
+        if(all || kernel == "trisolve")
+        {
+            this->BenchTriangular(A);
+        }
+        if(all || kernel == "blas1")
+        {
+            this->BenchBLAS1(A.GetM());
+        }
+
+        return rocalution_bench_record_results(*this->m_params, this->m_results);
+    }
+};
+
+//
+// @brief One function to call the kernel bench execution.
+//
+template <typename T>
+bool rocalution_bench_kernels_template(const rocalution_bench_solver_parameters& config)
+{
+    rocalution_bench_kernels<T> bench_kernels(&config);
+    return bench_kernels.Run();
+}
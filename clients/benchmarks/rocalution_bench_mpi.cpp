@@ -0,0 +1,68 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocalution_bench_mpi.hpp"
+
+#include <iostream>
+
+int device = 0;
+int main(int argc, char* argv[])
+{
+    MPI_Init(&argc, &argv);
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    bool success = false;
+
+    try
+    {
+        rocalution_bench_mpi bench(argc, argv);
+
+        // Disable OpenMP thread affinity, ranks share the host
+        set_omp_affinity_rocalution(false);
+
+        // Initialize platform with rank and # of accelerator devices in the node
+        init_rocalution(rank);
+        set_omp_threads_rocalution(1);
+
+        if(rank == 0)
+        {
+            info_rocalution();
+        }
+
+        success = bench.run();
+
+        stop_rocalution();
+    }
+    catch(const bool& exception_success)
+    {
+        std::cout << "ERROR SUCCESS EXCEPTION FAILURE rocalution_bench_mpi.cpp line " << __LINE__
+                  << std::endl;
+        success = exception_success;
+    }
+
+    MPI_Finalize();
+
+    return !success;
+}
@@ -0,0 +1,825 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "common.hpp"
+#include "rocalution_arguments_config.hpp"
+#include "rocalution_bench_preconditioner.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+//
+// @brief Iterative solver for distributed matrices, configured from the same
+// parameters as rocalution_bench. The multigrid entries of \ref rocalution_enum_itsolver
+// are used as preconditioner of the Krylov solver rocalution_bench pairs them with.
+//
+template <typename T>
+struct rocalution_bench_mpi_solver
+{
+    using matrix_t        = GlobalMatrix<T>;
+    using vector_t        = GlobalVector<T>;
+    using solver_t        = IterativeLinearSolver<matrix_t, vector_t, T>;
+    using precond_t       = Solver<matrix_t, vector_t, T>;
+    using local_precond_t = Preconditioner<LocalMatrix<T>, LocalVector<T>, T>;
+    using params_t        = rocalution_bench_solver_parameters;
+
+private:
+    solver_t*        m_solver{};
+    precond_t*       m_preconditioner{};
+    local_precond_t* m_local_preconditioner{};
+
+    //
+    // @brief Configure the parameters shared by all multigrid preconditioners.
+    //
+    void ConfigureMultiGrid(BaseAMG<matrix_t, vector_t, T>* amg, const params_t& parameters)
+    {
+        amg->SetCoarsestLevel(parameters.Get(params_t::solver_coarsest_level));
+        amg->SetCycle(parameters.Get(params_t::cycle));
+        amg->SetSmootherPreIter(parameters.Get(params_t::solver_pre_smooth));
+        amg->SetSmootherPostIter(parameters.Get(params_t::solver_post_smooth));
+        amg->Verbose(0);
+    }
+
+    //
+    // @brief Coarsening strategy of the configuration, PMIS by default.
+    //
+    CoarseningStrategy GetCoarseningStrategy(const params_t& parameters) const
+    {
+        auto enum_coarsening_strategy = parameters.GetEnumCoarseningStrategy();
+        if(!enum_coarsening_strategy.is_invalid()
+           && enum_coarsening_strategy.value == rocalution_enum_coarsening_strategy::Greedy)
+        {
+            return CoarseningStrategy::Greedy;
+        }
+
+        return CoarseningStrategy::PMIS;
+    }
+
+    //
+    // @brief Create the preconditioner of a Krylov solver.
+    //
+    bool CreatePreconditioner(const matrix_t& A, const params_t& parameters)
+    {
+        auto enum_preconditioner = parameters.GetEnumPreconditioner();
+        if(enum_preconditioner.is_invalid())
+        {
+            // No preconditioner.
+            return true;
+        }
+
+        switch(enum_preconditioner.value)
+        {
+        case rocalution_enum_preconditioner::none:
+        {
+            return true;
+        }
+
+        case rocalution_enum_preconditioner::Jacobi:
+        {
+            this->m_preconditioner = new Jacobi<matrix_t, vector_t, T>;
+            return true;
+        }
+
+        default:
+        {
+            //
+            // Node local preconditioners are applied block-wise, one block per rank.
+            //
+            if(!rocalution_bench_create_preconditioner(
+                   A.GetInterior(), parameters, &this->m_local_preconditioner))
+            {
+                return false;
+            }
+
+            auto* p = new BlockJacobi<matrix_t, vector_t, T>;
+            p->Set(*this->m_local_preconditioner);
+
+            this->m_preconditioner = p;
+            return true;
+        }
+        }
+    }
+
+public:
+    ~rocalution_bench_mpi_solver()
+    {
+        this->Clear();
+    }
+
+    //
+    // @brief Create the solver of the configuration and set its operator.
+    // @return true if successful, false otherwise.
+    //
+    bool Create(matrix_t& A, const params_t& parameters)
+    {
+        this->Clear();
+
+        auto enum_itsolver = parameters.GetEnumIterativeSolver();
+        if(enum_itsolver.is_invalid())
+        {
+            rocalution_bench_errmsg << "iterative solver is invalid." << std::endl;
+            return false;
+        }
+
+        const auto krylov_basis      = parameters.Get(params_t::krylov_basis);
+        const auto coupling_strength = parameters.Get(params_t::solver_coupling_strength);
+
+        bool krylov = true;
+
+        switch(enum_itsolver.value)
+        {
+        case rocalution_enum_itsolver::gmres:
+        {
+            auto* s = new GMRES<matrix_t, vector_t, T>;
+            s->SetBasisSize(krylov_basis);
+            this->m_solver = s;
+            break;
+        }
+        case rocalution_enum_itsolver::fgmres:
+        {
+            auto* s = new FGMRES<matrix_t, vector_t, T>;
+            s->SetBasisSize(krylov_basis);
+            this->m_solver = s;
+            break;
+        }
+        case rocalution_enum_itsolver::bicgstab:
+        {
+            this->m_solver = new BiCGStab<matrix_t, vector_t, T>;
+            break;
+        }
+        case rocalution_enum_itsolver::cg:
+        {
+            this->m_solver = new CG<matrix_t, vector_t, T>;
+            break;
+        }
+        case rocalution_enum_itsolver::cr:
+        {
+            this->m_solver = new CR<matrix_t, vector_t, T>;
+            break;
+        }
+        case rocalution_enum_itsolver::fcg:
+        {
+            this->m_solver = new FCG<matrix_t, vector_t, T>;
+            break;
+        }
+        case rocalution_enum_itsolver::idr:
+        {
+            this->m_solver = new IDR<matrix_t, vector_t, T>;
+            break;
+        }
+        case rocalution_enum_itsolver::qmrcgstab:
+        {
+            this->m_solver = new QMRCGStab<matrix_t, vector_t, T>;
+            break;
+        }
+        case rocalution_enum_itsolver::pairwise_amg:
+        {
+            auto* p = new PairwiseAMG<matrix_t, vector_t, T>;
+            this->ConfigureMultiGrid(p, parameters);
+
+            this->m_solver         = new CG<matrix_t, vector_t, T>;
+            this->m_preconditioner = p;
+            krylov                 = false;
+            break;
+        }
+        case rocalution_enum_itsolver::ruge_stueben_amg:
+        {
+            auto* p = new RugeStuebenAMG<matrix_t, vector_t, T>;
+            this->ConfigureMultiGrid(p, parameters);
+            p->SetCoarseningStrategy(CoarseningStrategy::PMIS);
+            p->SetInterpolationType(InterpolationType::ExtPI);
+
+            this->m_solver         = new BiCGStab<matrix_t, vector_t, T>;
+            this->m_preconditioner = p;
+            krylov                 = false;
+            break;
+        }
+        case rocalution_enum_itsolver::saamg:
+        {
+            auto* p = new SAAMG<matrix_t, vector_t, T>;
+            this->ConfigureMultiGrid(p, parameters);
+            p->SetCoarseningStrategy(this->GetCoarseningStrategy(parameters));
+            p->SetCouplingStrength(coupling_strength);
+
+            this->m_solver         = new FCG<matrix_t, vector_t, T>;
+            this->m_preconditioner = p;
+            krylov                 = false;
+            break;
+        }
+        case rocalution_enum_itsolver::uaamg:
+        {
+            auto* p = new UAAMG<matrix_t, vector_t, T>;
+            this->ConfigureMultiGrid(p, parameters);
+            p->SetCoarseningStrategy(this->GetCoarseningStrategy(parameters));
+            p->SetCouplingStrength(coupling_strength);
+            p->SetOverInterp(parameters.Get(params_t::solver_over_interp));
+
+            this->m_solver         = new FCG<matrix_t, vector_t, T>;
+            this->m_preconditioner = p;
+            krylov                 = false;
+            break;
+        }
+        }
+
+        if(krylov && !this->CreatePreconditioner(A, parameters))
+        {
+            rocalution_bench_errmsg << "create preconditioner failed." << std::endl;
+            return false;
+        }
+
+        this->m_solver->SetOperator(A);
+
+        if(this->m_preconditioner != nullptr)
+        {
+            this->m_solver->SetPreconditioner(*this->m_preconditioner);
+        }
+
+        this->m_solver->Init(parameters.Get(params_t::abs_tol),
+                             parameters.Get(params_t::rel_tol),
+                             parameters.Get(params_t::div_tol),
+                             parameters.Get(params_t::max_iter));
+        this->m_solver->Verbose(0);
+
+        return true;
+    }
+
+    //
+    // @brief Get the solver.
+    //
+    solver_t& Get()
+    {
+        return *this->m_solver;
+    }
+
+    //
+    // @brief Get the multigrid preconditioner, nullptr if the solver does not use one.
+    //
+    BaseAMG<matrix_t, vector_t, T>* GetMultiGrid()
+    {
+        return dynamic_cast<BaseAMG<matrix_t, vector_t, T>*>(this->m_preconditioner);
+    }
+
+    //
+    // @brief Clear the solver and its preconditioners.
+    //
+    void Clear()
+    {
+        if(this->m_solver != nullptr)
+        {
+            this->m_solver->Clear();
+            delete this->m_solver;
+            this->m_solver = nullptr;
+        }
+
+        if(this->m_preconditioner != nullptr)
+        {
+            delete this->m_preconditioner;
+            this->m_preconditioner = nullptr;
+        }
+
+        if(this->m_local_preconditioner != nullptr)
+        {
+            delete this->m_local_preconditioner;
+            this->m_local_preconditioner = nullptr;
+        }
+    }
+};
+
+//
+// @brief Statistics of a per rank quantity across the ranks of a run.
+//
+struct rocalution_bench_mpi_stat
+{
+    double min{};
+    double max{};
+    double avg{};
+
+    //
+    // @brief Reduce the local value of each rank, the result is valid on rank 0 of comm.
+    //
+    void Reduce(double local, MPI_Comm comm)
+    {
+        int nprocs;
+        MPI_Comm_size(comm, &nprocs);
+
+        double sum;
+        MPI_Reduce(&local, &this->min, 1, MPI_DOUBLE, MPI_MIN, 0, comm);
+        MPI_Reduce(&local, &this->max, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+        MPI_Reduce(&local, &sum, 1, MPI_DOUBLE, MPI_SUM, 0, comm);
+
+        this->avg = sum / nprocs;
+    }
+
+    void WriteJson(std::ostream& out) const
+    {
+        out << "{\"min\": " << this->min << ", \"max\": " << this->max
+            << ", \"avg\": " << this->avg << "}";
+    }
+};
+
+//
+// @brief Results of a single run, i.e. one problem size on one number of ranks.
+//
+struct rocalution_bench_mpi_result
+{
+    int     size{};
+    int     nprocs{};
+    int64_t nrow{};
+    int64_t nnz{};
+    int     iter{};
+    double  residual{};
+    bool    convergence{};
+
+    //
+    // @brief Parallel efficiency of the solve (and per iteration), relative to the run
+    // with the smallest number of ranks of the same problem size.
+    //
+    double efficiency{};
+    double efficiency_iter{};
+
+    //
+    // @brief Times per rank (in ms).
+    //
+    rocalution_bench_mpi_stat time_build;
+    rocalution_bench_mpi_stat time_solve;
+    rocalution_bench_mpi_stat time_spmv;
+    rocalution_bench_mpi_stat time_precond;
+    rocalution_bench_mpi_stat time_halo;
+    rocalution_bench_mpi_stat time_allreduce;
+
+    void WriteJson(std::ostream& out) const
+    {
+        out << "    {\"size\": " << this->size << ", \"nprocs\": " << this->nprocs
+            << ", \"nrow\": " << this->nrow << ", \"nnz\": " << this->nnz
+            << ", \"iter\": " << this->iter << ", \"residual\": " << this->residual
+            << ", \"convergence\": " << (this->convergence ? "true" : "false")
+            << ", \"efficiency\": " << this->efficiency
+            << ", \"efficiency_iter\": " << this->efficiency_iter;
+
+        const std::pair<const char*, const rocalution_bench_mpi_stat*> stats[]
+            = {{"time_build", &this->time_build},
+               {"time_solve", &this->time_solve},
+               {"time_spmv", &this->time_spmv},
+               {"time_precond", &this->time_precond},
+               {"time_halo", &this->time_halo},
+               {"time_allreduce", &this->time_allreduce}};
+
+        for(auto& stat : stats)
+        {
+            out << ", \"" << stat.first << "\": ";
+            stat.second->WriteJson(out);
+        }
+
+        out << "}";
+    }
+};
+
+//
+// @brief Weak and strong scaling benchmark of the distributed solvers.
+//
+// Each run uses the first nprocs ranks of MPI_COMM_WORLD, such that a single job sweeps
+// all requested rank counts. In weak scaling mode, each rank owns a grid of size^3
+// points, in strong scaling mode the global grid of size^3 points is split across the
+// ranks.
+//
+struct rocalution_bench_mpi
+{
+    using params_t = rocalution_bench_solver_parameters;
+
+private:
+    options_description         m_desc;
+    rocalution_arguments_config m_config;
+
+    std::string m_scaling{"weak"};
+    std::string m_ranks{};
+    std::string m_sizes{};
+    std::string m_output{};
+    int         m_samples{1};
+
+    int m_rank{};
+    int m_nprocs{};
+
+    std::vector<rocalution_bench_mpi_result> m_results;
+
+    //
+    // @brief Parse a comma separated list of integers.
+    //
+    static std::vector<int> ParseList(const std::string& list)
+    {
+        std::vector<int>  values;
+        std::stringstream ss(list);
+        std::string       item;
+
+        while(std::getline(ss, item, ','))
+        {
+            if(item != "")
+            {
+                values.push_back(std::stoi(item));
+            }
+        }
+
+        return values;
+    }
+
+    //
+    // @brief Generate the distributed matrix of a run.
+    //
+    template <typename T>
+    bool GenerateMatrix(int              size,
+                        const MPI_Comm*  comm,
+                        int              rank,
+                        int              nprocs,
+                        GlobalMatrix<T>* A,
+                        ParallelManager* pm) const
+    {
+        auto matrix_init = this->m_config.GetEnumMatrixInit();
+
+        // The 27 point laplacian is used by default
+        stencil_3d_problem problem = stencil_3d_laplacian_27pt;
+
+        if(!matrix_init.is_invalid() && !matrix_init.is_stencil_3d(&problem))
+        {
+            if(matrix_init.value != rocalution_enum_matrix_init::laplacian)
+            {
+                rocalution_bench_errmsg << "matrix initialization is not supported by the "
+                                           "scaling benchmark."
+                                        << std::endl;
+                return false;
+            }
+
+            // 2D laplacian
+            int local_dimx = size;
+            int local_dimy = size;
+
+            if(this->m_scaling == "strong")
+            {
+                int nproc_x;
+                int nproc_y;
+                compute_2d_process_distribution(nprocs, nproc_x, nproc_y);
+
+                local_dimx = std::max(size / nproc_x, 1);
+                local_dimy = std::max(size / nproc_y, 1);
+            }
+
+            generate_2d_laplacian(local_dimx, local_dimy, comm, A, pm, rank, nprocs);
+            return true;
+        }
+
+        int local_dimx = size;
+        int local_dimy = size;
+        int local_dimz = size;
+
+        if(this->m_scaling == "strong")
+        {
+            int nproc_x;
+            int nproc_y;
+            int nproc_z;
+            compute_3d_process_distribution(nprocs, nproc_x, nproc_y, nproc_z);
+
+            local_dimx = std::max(size / nproc_x, 1);
+            local_dimy = std::max(size / nproc_y, 1);
+            local_dimz = std::max(size / nproc_z, 1);
+        }
+
+        double coef = this->m_config.Get(params_t::stencil_coef);
+        if(coef == 0.0)
+        {
+            coef = stencil_3d_default_coef(problem);
+        }
+
+        generate_3d_stencil(
+            problem, coef, local_dimx, local_dimy, local_dimz, comm, A, pm, rank, nprocs);
+
+        return true;
+    }
+
+    //
+    // @brief Run the benchmark for one problem size on the first nprocs ranks.
+    //
+    template <typename T>
+    bool Run(int size, int nprocs, rocalution_bench_mpi_result& result)
+    {
+        // Communicator of the ranks taking part in this run
+        MPI_Comm comm;
+        MPI_Comm_split(MPI_COMM_WORLD, this->m_rank < nprocs ? 0 : MPI_UNDEFINED, 0, &comm);
+
+        bool success = true;
+
+        if(comm != MPI_COMM_NULL)
+        {
+            ParallelManager pm;
+            GlobalMatrix<T> A;
+
+            success = this->GenerateMatrix(size, &comm, this->m_rank, nprocs, &A, &pm);
+
+            if(success)
+            {
+                GlobalVector<T> b(pm);
+                GlobalVector<T> x(pm);
+                GlobalVector<T> e(pm);
+
+                A.MoveToAccelerator();
+                b.MoveToAccelerator();
+                x.MoveToAccelerator();
+                e.MoveToAccelerator();
+
+                const auto format   = this->m_config.Get(params_t::format);
+                const auto blockdim = this->m_config.Get(params_t::blockdim);
+                A.ConvertTo(format, format == BCSR ? blockdim : 1);
+
+                b.Allocate("b", A.GetM());
+                x.Allocate("x", A.GetN());
+                e.Allocate("e", A.GetN());
+
+                // Right-hand side such that A 1 = b
+                e.Ones();
+                A.Apply(e, &b);
+
+                rocalution_bench_mpi_solver<T> solver;
+                success = solver.Create(A, this->m_config);
+
+                if(success)
+                {
+                    // Build
+                    MPI_Barrier(comm);
+                    double t_build = rocalution_time();
+                    solver.Get().Build();
+                    MPI_Barrier(comm);
+                    t_build = (rocalution_time() - t_build) / 1e3;
+
+                    // Solve
+                    double t_solve   = 0.0;
+                    double t_spmv    = 0.0;
+                    double t_precond = 0.0;
+                    double t_halo    = 0.0;
+                    double t_reduce  = 0.0;
+
+                    for(int sample = 0; sample < this->m_samples; ++sample)
+                    {
+                        x.Zeros();
+
+                        set_time_breakdown_rocalution(true);
+                        reset_time_breakdown_rocalution();
+
+                        MPI_Barrier(comm);
+                        double t = rocalution_time();
+                        solver.Get().Solve(b, &x);
+                        t_solve += (rocalution_time() - t) / 1e3;
+
+                        set_time_breakdown_rocalution(false);
+
+                        t_spmv += get_time_breakdown_rocalution(TimeSpMV) * 1e3;
+                        t_precond += get_time_breakdown_rocalution(TimePreconditioner) * 1e3;
+                        t_halo += get_time_breakdown_rocalution(TimeCommunication) * 1e3;
+                        t_reduce += get_time_breakdown_rocalution(TimeAllreduce) * 1e3;
+                    }
+
+                    result.size        = size;
+                    result.nprocs      = nprocs;
+                    result.nrow        = A.GetM();
+                    result.nnz         = A.GetNnz();
+                    result.iter        = solver.Get().GetIterationCount();
+                    result.residual    = solver.Get().GetCurrentResidual();
+                    result.convergence = solver.Get().GetSolverStatus() == 1;
+
+                    result.time_build.Reduce(t_build, comm);
+                    result.time_solve.Reduce(t_solve / this->m_samples, comm);
+                    result.time_spmv.Reduce(t_spmv / this->m_samples, comm);
+                    result.time_precond.Reduce(t_precond / this->m_samples, comm);
+                    result.time_halo.Reduce(t_halo / this->m_samples, comm);
+                    result.time_allreduce.Reduce(t_reduce / this->m_samples, comm);
+                }
+            }
+
+            MPI_Comm_free(&comm);
+        }
+
+        // All ranks agree on the success of the run
+        int local_success = success ? 1 : 0;
+        int global_success;
+        MPI_Allreduce(&local_success, &global_success, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+        return global_success == 1;
+    }
+
+    //
+    // @brief Compute the parallel efficiencies of the results (on rank 0).
+    //
+    void ComputeEfficiency()
+    {
+        for(auto& result : this->m_results)
+        {
+            // Reference run, the smallest number of ranks of the same size
+            const rocalution_bench_mpi_result* ref = nullptr;
+            for(auto& r : this->m_results)
+            {
+                if(r.size == result.size && (ref == nullptr || r.nprocs < ref->nprocs))
+                {
+                    ref = &r;
+                }
+            }
+
+            double t_ref  = ref->time_solve.max;
+            double t      = result.time_solve.max;
+            double it_ref = std::max(ref->iter, 1);
+            double it     = std::max(result.iter, 1);
+
+            // Weak scaling keeps the work per rank, strong scaling the total work
+            double work = (this->m_scaling == "strong")
+                              ? static_cast<double>(result.nprocs) / ref->nprocs
+                              : 1.0;
+
+            result.efficiency      = (t > 0.0) ? t_ref / (t * work) : 0.0;
+            result.efficiency_iter = (t > 0.0) ? (t_ref / it_ref) / (t / it * work) : 0.0;
+        }
+    }
+
+    //
+    // @brief Print the results as a table (on rank 0).
+    //
+    void WriteNicely(std::ostream& out) const
+    {
+        out << std::endl
+            << this->m_scaling << " scaling, times in ms as min / avg / max across ranks"
+            << std::endl;
+
+        out << std::setw(8) << "size" << std::setw(8) << "nprocs" << std::setw(14) << "nrow"
+            << std::setw(8) << "iter" << std::setw(8) << "eff" << std::setw(10) << "eff/iter"
+            << std::setw(12) << "build" << std::setw(30) << "solve" << std::setw(30)
+            << "halo" << std::setw(30) << "allreduce" << std::endl;
+
+        auto stat = [](const rocalution_bench_mpi_stat& s) {
+            std::ostringstream os;
+            os << std::fixed << std::setprecision(2) << s.min << " / " << s.avg << " / "
+               << s.max;
+            return os.str();
+        };
+
+        for(auto& r : this->m_results)
+        {
+            out << std::setw(8) << r.size << std::setw(8) << r.nprocs << std::setw(14) << r.nrow
+                << std::setw(8) << r.iter << std::setw(8) << std::fixed << std::setprecision(2)
+                << r.efficiency << std::setw(10) << r.efficiency_iter << std::setw(12)
+                << r.time_build.max << std::setw(30) << stat(r.time_solve) << std::setw(30)
+                << stat(r.time_halo) << std::setw(30) << stat(r.time_allreduce) << std::endl;
+        }
+    }
+
+    //
+    // @brief Write the results in json format (on rank 0).
+    //
+    void WriteJson(std::ostream& out) const
+    {
+        out << "{" << std::endl;
+        out << "  \"scaling\": \"" << this->m_scaling << "\"," << std::endl;
+        out << "  \"iterative_solver\": \"" << this->m_config.Get(params_t::iterative_solver)
+            << "\"," << std::endl;
+        out << "  \"preconditioner\": \"" << this->m_config.Get(params_t::preconditioner)
+            << "\"," << std::endl;
+        out << "  \"matrix\": \"" << this->m_config.Get(params_t::matrix) << "\"," << std::endl;
+        out << "  \"results\": [" << std::endl;
+
+        for(size_t i = 0; i < this->m_results.size(); ++i)
+        {
+            this->m_results[i].WriteJson(out);
+            out << ((i + 1 < this->m_results.size()) ? "," : "") << std::endl;
+        }
+
+        out << "  ]" << std::endl;
+        out << "}" << std::endl;
+    }
+
+public:
+    rocalution_bench_mpi(int& argc, char**& argv)
+        : m_desc("rocalution mpi scaling benchmark command line options")
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &this->m_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &this->m_nprocs);
+
+        this->m_config.set_description(this->m_desc);
+        this->m_desc.add_options()("scaling",
+                                   value<std::string>(&this->m_scaling)->default_value("weak"),
+                                   "scaling mode, weak (size^3 grid points per rank) or strong "
+                                   "(size^3 grid points in total).");
+        this->m_desc.add_options()("ranks",
+                                   value<std::string>(&this->m_ranks)->default_value(""),
+                                   "comma separated list of rank counts, powers of two up to "
+                                   "the number of MPI ranks by default.");
+        this->m_desc.add_options()("sizes",
+                                   value<std::string>(&this->m_sizes)->default_value(""),
+                                   "comma separated list of grid sizes per dimension, --ndim "
+                                   "by default.");
+        this->m_desc.add_options()("samples",
+                                   value<int>(&this->m_samples)->default_value(1),
+                                   "number of solves per run.");
+        this->m_desc.add_options()("output",
+                                   value<std::string>(&this->m_output)->default_value(""),
+                                   "json output file.");
+
+        this->m_config.precision = 'd';
+        this->m_config.indextype = 's';
+        this->m_config.parse(argc, argv, this->m_desc);
+    }
+
+    //
+    // @brief Run all rank counts and sizes.
+    //
+    bool run()
+    {
+        if(this->m_scaling != "weak" && this->m_scaling != "strong")
+        {
+            rocalution_bench_errmsg << "scaling mode '" << this->m_scaling << "' is invalid."
+                                    << std::endl;
+            return false;
+        }
+
+        std::vector<int> ranks = ParseList(this->m_ranks);
+        if(ranks.empty())
+        {
+            for(int n = 1; n < this->m_nprocs; n *= 2)
+            {
+                ranks.push_back(n);
+            }
+
+            ranks.push_back(this->m_nprocs);
+        }
+
+        std::vector<int> sizes = ParseList(this->m_sizes);
+        if(sizes.empty())
+        {
+            sizes.push_back(this->m_config.Get(params_t::ndim));
+        }
+
+        this->m_samples = std::max(this->m_samples, 1);
+
+        for(int size : sizes)
+        {
+            for(int nprocs : ranks)
+            {
+                if(nprocs < 1 || nprocs > this->m_nprocs)
+                {
+                    if(this->m_rank == 0)
+                    {
+                        rocalution_bench_errmsg << "skipping " << nprocs
+                                                << " ranks, only " << this->m_nprocs
+                                                << " ranks are available." << std::endl;
+                    }
+                    continue;
+                }
+
+                if(this->m_rank == 0)
+                {
+                    std::cout << "Running size " << size << " on " << nprocs << " ranks ..."
+                              << std::endl;
+                }
+
+                rocalution_bench_mpi_result result;
+                if(!this->Run<double>(size, nprocs, result))
+                {
+                    rocalution_bench_errmsg << "run failed." << std::endl;
+                    return false;
+                }
+
+                this->m_results.push_back(result);
+            }
+        }
+
+        if(this->m_rank == 0)
+        {
+            this->ComputeEfficiency();
+            this->WriteNicely(std::cout);
+
+            if(this->m_output != "")
+            {
+                std::ofstream out(this->m_output);
+                this->WriteJson(out);
+            }
+        }
+
+        return true;
+    }
+};
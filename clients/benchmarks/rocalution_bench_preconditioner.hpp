@@ -0,0 +1,265 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include <rocalution/rocalution.hpp>
+
+#include "rocalution_bench_solver_parameters.hpp"
+
+using namespace rocalution;
+
+//
+// @brief Create the (node local) preconditioner of the configuration.
+// @param[in]
+// A               matrix the preconditioner is built for.
+// @param[in]
+// parameters      parameters to configure the preconditioner.
+// @param[out]
+// preconditioner  created preconditioner, nullptr if no preconditioner is configured.
+// @return true if successful, false otherwise.
+//
+template <typename T>
+bool rocalution_bench_create_preconditioner(
+    const LocalMatrix<T>&                               A,
+    const rocalution_bench_solver_parameters&           parameters,
+    Preconditioner<LocalMatrix<T>, LocalVector<T>, T>** preconditioner)
+{
+    using params_t = rocalution_bench_solver_parameters;
+
+    auto enum_preconditioner = parameters.GetEnumPreconditioner();
+    if(enum_preconditioner.is_invalid())
+    {
+        rocalution_bench_errmsg << "enum preconditioner is invalid." << std::endl;
+        return false;
+    }
+    *preconditioner = nullptr;
+    switch(enum_preconditioner.value)
+    {
+    case rocalution_enum_preconditioner::none:
+    {
+        return true;
+    }
+    case rocalution_enum_preconditioner::chebyshev:
+    {
+        // Chebyshev preconditioner
+
+        // Determine min and max eigenvalues
+        T lambda_min;
+        T lambda_max;
+
+        A.Gershgorin(lambda_min, lambda_max);
+
+        auto* p = new rocalution::
+            AIChebyshev<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        p->Set(3, lambda_max / 7.0, lambda_max);
+        *preconditioner = p;
+        break;
+    }
+
+    case rocalution_enum_preconditioner::FSAI:
+    {
+        auto* p
+            = new rocalution::FSAI<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        *preconditioner = p;
+        break;
+    }
+
+    case rocalution_enum_preconditioner::SPAI:
+    {
+        auto* p
+            = new rocalution::SPAI<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        *preconditioner = p;
+        break;
+    }
+    case rocalution_enum_preconditioner::TNS:
+    {
+        auto* p
+            = new rocalution::TNS<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        *preconditioner = p;
+        break;
+    }
+
+    case rocalution_enum_preconditioner::Jacobi:
+    {
+        auto* p
+            = new rocalution::Jacobi<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        //
+        // no specific parameters
+        //
+        *preconditioner = p;
+        break;
+    }
+
+    case rocalution_enum_preconditioner::GS:
+    {
+        auto* p = new rocalution::GS<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        //
+        // no specific parameters
+        //
+        *preconditioner = p;
+        break;
+    }
+
+    case rocalution_enum_preconditioner::SGS:
+    {
+        auto* p
+            = new rocalution::SGS<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        //
+        // no specific parameters
+        //
+        *preconditioner = p;
+        break;
+    }
+
+    case rocalution_enum_preconditioner::ILU:
+    {
+        auto* p
+            = new rocalution::ILU<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        //
+        // no specific parameters
+        //
+        *preconditioner = p;
+        break;
+    }
+    case rocalution_enum_preconditioner::ItILU0:
+    {
+        auto enum_itilu0_alg = parameters.GetEnumItILU0Algorithm();
+        if(enum_itilu0_alg.is_invalid())
+        {
+            rocalution_bench_errmsg << "enum_itilu0_alg is invalid." << std::endl;
+            return false;
+        }
+
+        auto* p
+            = new rocalution::ItILU0<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        p->SetMaxIter(parameters.Get(params_t::itilu0_max_iter));
+        p->SetTolerance(parameters.Get(params_t::itilu0_tol));
+        p->SetOptions(parameters.Get(params_t::itilu0_options));
+
+        switch(enum_itilu0_alg.value)
+        {
+        case rocalution_enum_itilu0_alg::Default:
+        {
+            p->SetAlgorithm(ItILU0Algorithm::Default);
+            break;
+        }
+        case rocalution_enum_itilu0_alg::AsyncInPlace:
+        {
+            p->SetAlgorithm(ItILU0Algorithm::AsyncInPlace);
+            break;
+        }
+        case rocalution_enum_itilu0_alg::AsyncSplit:
+        {
+            p->SetAlgorithm(ItILU0Algorithm::AsyncSplit);
+            break;
+        }
+        case rocalution_enum_itilu0_alg::SyncSplit:
+        {
+            p->SetAlgorithm(ItILU0Algorithm::SyncSplit);
+            break;
+        }
+        case rocalution_enum_itilu0_alg::SyncSplitFusion:
+        {
+            p->SetAlgorithm(ItILU0Algorithm::SyncSplitFusion);
+            break;
+        }
+        }
+
+        *preconditioner = p;
+        return true;
+    }
+    case rocalution_enum_preconditioner::ILUT:
+    {
+        auto* p
+            = new rocalution::ILUT<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        p->Set(parameters.Get(params_t::ilut_tol), parameters.Get(params_t::ilut_n));
+
+        *preconditioner = p;
+        break;
+    }
+    case rocalution_enum_preconditioner::IC:
+    {
+        auto* p = new rocalution::IC<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        //
+        // no specific parameters
+        //
+        *preconditioner = p;
+        break;
+    }
+    case rocalution_enum_preconditioner::MCGS:
+    {
+        auto* p = new rocalution::
+            MultiColoredGS<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        p->SetRelaxation(parameters.Get(params_t::mcgs_relax));
+        *preconditioner = p;
+        break;
+    }
+    case rocalution_enum_preconditioner::MCSGS:
+    {
+        auto* p = new rocalution::
+            MultiColoredSGS<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+        //
+        // no specific parameters
+        //
+        *preconditioner = p;
+        break;
+    }
+    case rocalution_enum_preconditioner::MCILU:
+    {
+        auto* p = new rocalution::
+            MultiColoredILU<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
+
+        p->Set(parameters.Get(params_t::mcilu_p),
+               parameters.Get(params_t::mcilu_q),
+               parameters.Get(params_t::mcilu_use_level));
+
+        *preconditioner = p;
+        break;
+    }
+    }
+
+    if(*preconditioner != nullptr)
+    {
+        const auto itsolve = parameters.Get(params_t::iterative_solve);
+
+        rocalution::SolverDescr descr;
+
+        if(itsolve)
+        {
+            descr.SetTriSolverAlg(TriSolverAlg_Iterative);
+            descr.SetIterativeSolverMaxIteration(parameters.Get(params_t::itsolve_max_iter));
+            descr.SetIterativeSolverTolerance(parameters.Get(params_t::itsolve_tol));
+        }
+        else
+        {
+            descr.SetTriSolverAlg(TriSolverAlg_Default);
+        }
+
+        (*preconditioner)->SetSolverDescriptor(descr);
+
+        return true;
+    }
+
+    return false;
+}
@@ -112,7 +112,9 @@ public:
 #define PBOOL_TRANSFORM_EACH			\
   PBOOL_TRANSFORM(iterative_solve) \
   PBOOL_TRANSFORM(verbose)			\
-  PBOOL_TRANSFORM(mcilu_use_level)
+  PBOOL_TRANSFORM(mcilu_use_level)			\
+  PBOOL_TRANSFORM(kernel_counters)			\
+  PBOOL_TRANSFORM(tune_amg)
     // clang-format on
 
 #define PBOOL_TRANSFORM(x_) x_,
@@ -145,7 +147,8 @@ public:
   PINT_TRANSFORM(rebuild_numeric)					\
   PINT_TRANSFORM(cycle)							\
   PINT_TRANSFORM(solver_coarsest_level)					\
-  PINT_TRANSFORM(blockdim)
+  PINT_TRANSFORM(blockdim)						\
+  PINT_TRANSFORM(kernel_iter)
 
     // clang-format on
 
@@ -168,6 +171,7 @@ public:
   PSTRING_TRANSFORM(direct_solver)					\
   PSTRING_TRANSFORM(iterative_solver)					\
   PSTRING_TRANSFORM(itilu0_alg)					\
+  PSTRING_TRANSFORM(kernel)						\
   PSTRING_TRANSFORM(matrix)						\
   PSTRING_TRANSFORM(matrix_filename)					\
   PSTRING_TRANSFORM(preconditioner)					\
@@ -217,6 +221,7 @@ public:
   PDOUBLE_TRANSFORM(mcgs_relax)				\
   PDOUBLE_TRANSFORM(solver_over_interp)			\
   PDOUBLE_TRANSFORM(solver_coupling_strength) \
+  PDOUBLE_TRANSFORM(stencil_coef) \
     // clang-format on
 
 #define PDOUBLE_TRANSFORM(x_) x_,
@@ -25,10 +25,14 @@
 constexpr rocalution_bench_solver_results::e_bool   rocalution_bench_solver_results::e_bool_all[];
 constexpr rocalution_bench_solver_results::e_int    rocalution_bench_solver_results::e_int_all[];
 constexpr rocalution_bench_solver_results::e_double rocalution_bench_solver_results::e_double_all[];
+constexpr rocalution_bench_solver_results::e_level  rocalution_bench_solver_results::e_level_all[];
+constexpr rocalution_bench_solver_results::e_kernel rocalution_bench_solver_results::e_kernel_all[];
 
 constexpr const char* rocalution_bench_solver_results::e_bool_names[];
 constexpr const char* rocalution_bench_solver_results::e_int_names[];
 constexpr const char* rocalution_bench_solver_results::e_double_names[];
+constexpr const char* rocalution_bench_solver_results::e_level_names[];
+constexpr const char* rocalution_bench_solver_results::e_kernel_names[];
 
 bool rocalution_bench_solver_results::Get(e_bool v) const
 {
@@ -57,6 +61,56 @@ void rocalution_bench_solver_results::Set(e_double v, double s)
     double_values[v] = s;
 }
 
+int rocalution_bench_solver_results::GetNumLevels() const
+{
+    return static_cast<int>(level_values.size() / e_level_size);
+}
+void rocalution_bench_solver_results::SetNumLevels(int nlevels)
+{
+    level_values.assign(nlevels * e_level_size, 0.0);
+}
+
+double rocalution_bench_solver_results::Get(int level, e_level v) const
+{
+    return level_values[level * e_level_size + v];
+}
+void rocalution_bench_solver_results::Set(int level, e_level v, double s)
+{
+    level_values[level * e_level_size + v] = s;
+}
+
+int rocalution_bench_solver_results::GetNumKernels() const
+{
+    return static_cast<int>(kernel_names.size());
+}
+const std::string& rocalution_bench_solver_results::GetKernelName(int kernel) const
+{
+    return kernel_names[kernel];
+}
+void rocalution_bench_solver_results::AddKernel(const std::string& name)
+{
+    kernel_names.push_back(name);
+    kernel_values.resize(kernel_names.size() * e_kernel_size, 0.0);
+}
+void rocalution_bench_solver_results::SetNumKernels(int nkernels)
+{
+    kernel_names.assign(nkernels, "");
+    kernel_values.assign(nkernels * e_kernel_size, 0.0);
+}
+void rocalution_bench_solver_results::SetKernelName(int kernel, const std::string& name)
+{
+    kernel_names[kernel] = name;
+}
+
+double rocalution_bench_solver_results::Get(int kernel, e_kernel v) const
+{
+    return kernel_values[kernel * e_kernel_size + v];
+}
+void rocalution_bench_solver_results::Set(int kernel, e_kernel v, double s)
+{
+    kernel_values[kernel * e_kernel_size + v] = s;
+}
+
 void rocalution_bench_solver_results::WriteJson(std::ostream& out) const
 {
     bool first = false;
@@ -87,6 +141,72 @@ void rocalution_bench_solver_results::WriteJson(std::ostream& out) const
         out << "\"" << e_double_names[e] << "\" : "
             << "\"" << double_values[e] << "\"";
     }
+    if(GetNumLevels() > 0)
+    {
+        out << ", \"levels\" : [";
+        for(int level = 0; level < GetNumLevels(); ++level)
+        {
+            if(level > 0)
+                out << ",";
+            out << " { \"level\" : \"" << level << "\"";
+            for(auto e : e_level_all)
+            {
+                out << ", \"" << e_level_names[e] << "\" : "
+                    << "\"" << Get(level, e) << "\"";
+            }
+            out << " }";
+        }
+        out << " ]";
+    }
+    if(GetNumKernels() > 0)
+    {
+        out << ", \"kernels\" : [";
+        for(int kernel = 0; kernel < GetNumKernels(); ++kernel)
+        {
+            if(kernel > 0)
+                out << ",";
+            out << " { \"kernel\" : \"" << kernel_names[kernel] << "\"";
+            for(auto e : e_kernel_all)
+            {
+                out << ", \"" << e_kernel_names[e] << "\" : "
+                    << "\"" << Get(kernel, e) << "\"";
+            }
+            out << " }";
+        }
+        out << " ]";
+    }
+}
+
+void rocalution_bench_solver_results::WriteCsv(std::ostream& out, int sample) const
+{
+    for(auto e : e_bool_all)
+    {
+        out << sample << ",," << e_bool_names[e] << "," << bool_values[e] << std::endl;
+    }
+    for(auto e : e_int_all)
+    {
+        out << sample << ",," << e_int_names[e] << "," << int_values[e] << std::endl;
+    }
+    for(auto e : e_double_all)
+    {
+        out << sample << ",," << e_double_names[e] << "," << double_values[e] << std::endl;
+    }
+    for(int level = 0; level < GetNumLevels(); ++level)
+    {
+        for(auto e : e_level_all)
+        {
+            out << sample << "," << level << "," << e_level_names[e] << "," << Get(level, e)
+                << std::endl;
+        }
+    }
+    for(int kernel = 0; kernel < GetNumKernels(); ++kernel)
+    {
+        for(auto e : e_kernel_all)
+        {
+            out << sample << ",," << kernel_names[kernel] << "." << e_kernel_names[e] << ","
+                << Get(kernel, e) << std::endl;
+        }
+    }
 }
 
 void rocalution_bench_solver_results::WriteNicely(std::ostream& out) const
@@ -122,4 +242,23 @@ void rocalution_bench_solver_results::WriteNicely(std::ostream& out) const
         out << std::setw(14) << double_values[e];
     }
     out << std::endl;
+
+    if(GetNumLevels() > 0)
+    {
+        out << std::setw(14) << "level";
+        for(auto e : e_level_all)
+        {
+            out << std::setw(22) << e_level_names[e];
+        }
+        out << std::endl;
+        for(int level = 0; level < GetNumLevels(); ++level)
+        {
+            out << std::setw(14) << level;
+            for(auto e : e_level_all)
+            {
+                out << std::setw(22) << Get(level, e);
+            }
+            out << std::endl;
+        }
+    }
 }
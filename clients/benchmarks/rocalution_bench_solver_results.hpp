@@ -27,6 +27,8 @@
 #include "rocalution_enum_preconditioner.hpp"
 #include "rocalution_enum_smoother.hpp"
 #include <iomanip>
+#include <string>
+#include <vector>
 
 struct rocalution_bench_solver_results
 {
@@ -64,6 +66,10 @@ struct rocalution_bench_solver_results
   RESDOUBLE_TRANSFORM(time_analyze)					\
   RESDOUBLE_TRANSFORM(time_solve)					\
   RESDOUBLE_TRANSFORM(time_global)					\
+  RESDOUBLE_TRANSFORM(time_spmv)					\
+  RESDOUBLE_TRANSFORM(time_precond)					\
+  RESDOUBLE_TRANSFORM(time_comm)					\
+  RESDOUBLE_TRANSFORM(time_vector)					\
   RESDOUBLE_TRANSFORM(norm_residual)					\
   RESDOUBLE_TRANSFORM(nrmmax_err)					\
   RESDOUBLE_TRANSFORM(nrmmax95_err)					\
@@ -79,10 +85,53 @@ struct rocalution_bench_solver_results
     static constexpr e_double e_double_all[] = {RESDOUBLE_TRANSFORM_EACH};
 #undef RESDOUBLE_TRANSFORM
 
+    //
+    // Per level timing of multigrid preconditioners.
+    //
+    // clang-format off
+#define RESLEVEL_TRANSFORM_EACH						\
+  RESLEVEL_TRANSFORM(time_level_setup)					\
+  RESLEVEL_TRANSFORM(time_smoother_build)				\
+  RESLEVEL_TRANSFORM(time_smoothing)					\
+  RESLEVEL_TRANSFORM(time_residual)					\
+  RESLEVEL_TRANSFORM(time_transfer)
+    // clang-format on
+
+#define RESLEVEL_TRANSFORM(x_) x_,
+    typedef enum e_level_ : int
+    {
+        RESLEVEL_TRANSFORM_EACH
+    } e_level;
+    static constexpr e_level e_level_all[] = {RESLEVEL_TRANSFORM_EACH};
+#undef RESLEVEL_TRANSFORM
+
+    //
+    // Per kernel results of the kernel microbenchmarks.
+    //
+    // clang-format off
+#define RESKERNEL_TRANSFORM_EACH					\
+  RESKERNEL_TRANSFORM(time_kernel)					\
+  RESKERNEL_TRANSFORM(bandwidth)					\
+  RESKERNEL_TRANSFORM(gflops)						\
+  RESKERNEL_TRANSFORM(dram_bytes)					\
+  RESKERNEL_TRANSFORM(cache_hit_rate)					\
+  RESKERNEL_TRANSFORM(ipc)
+    // clang-format on
+
+#define RESKERNEL_TRANSFORM(x_) x_,
+    typedef enum e_kernel_ : int
+    {
+        RESKERNEL_TRANSFORM_EACH
+    } e_kernel;
+    static constexpr e_kernel e_kernel_all[] = {RESKERNEL_TRANSFORM_EACH};
+#undef RESKERNEL_TRANSFORM
+
 private:
     static constexpr std::size_t e_bool_size   = countof(e_bool_all);
     static constexpr std::size_t e_int_size    = countof(e_int_all);
     static constexpr std::size_t e_double_size = countof(e_double_all);
+    static constexpr std::size_t e_level_size  = countof(e_level_all);
+    static constexpr std::size_t e_kernel_size = countof(e_kernel_all);
 
 #define RESBOOL_TRANSFORM(x_) #x_,
     static constexpr const char* e_bool_names[e_bool_size]{RESBOOL_TRANSFORM_EACH};
@@ -95,10 +144,25 @@ private:
 #define RESDOUBLE_TRANSFORM(x_) #x_,
     static constexpr const char* e_double_names[e_double_size]{RESDOUBLE_TRANSFORM_EACH};
 #undef RESDOUBLE_TRANSFORM
+
+#define RESLEVEL_TRANSFORM(x_) #x_,
+    static constexpr const char* e_level_names[e_level_size]{RESLEVEL_TRANSFORM_EACH};
+#undef RESLEVEL_TRANSFORM
+
+#define RESKERNEL_TRANSFORM(x_) #x_,
+    static constexpr const char* e_kernel_names[e_kernel_size]{RESKERNEL_TRANSFORM_EACH};
+#undef RESKERNEL_TRANSFORM
     bool   bool_values[e_bool_size]{};
     int    int_values[e_int_size]{};
     double double_values[e_double_size]{};
 
+    // Level values, stored level by level.
+    std::vector<double> level_values{};
+
+    // Kernel names and values, stored kernel by kernel.
+    std::vector<std::string> kernel_names{};
+    std::vector<double>      kernel_values{};
+
 public:
     static const char* Name(e_bool v)
     {
@@ -112,6 +176,14 @@ public:
     {
         return e_int_names[v];
     };
+    static const char* Name(e_level v)
+    {
+        return e_level_names[v];
+    };
+    static const char* Name(e_kernel v)
+    {
+        return e_kernel_names[v];
+    };
 
     bool Get(e_bool v) const;
     void Set(e_bool v, bool s);
@@ -122,6 +194,21 @@ public:
     double Get(e_double v) const;
     void   Set(e_double v, double s);
 
+    int  GetNumLevels() const;
+    void SetNumLevels(int nlevels);
+
+    double Get(int level, e_level v) const;
+    void   Set(int level, e_level v, double s);
+
+    int                GetNumKernels() const;
+    const std::string& GetKernelName(int kernel) const;
+    void               AddKernel(const std::string& name);
+    void               SetNumKernels(int nkernels);
+    void               SetKernelName(int kernel, const std::string& name);
+
+    double Get(int kernel, e_kernel v) const;
+    void   Set(int kernel, e_kernel v, double s);
+
     void Info(std::ostream& out) const
     {
         out << "bool:  " << std::endl;
@@ -140,8 +227,32 @@ public:
             out << std::setw(20) << e_double_names[e] << std::setw(20) << double_values[e]
                 << std::endl;
         }
+        for(int level = 0; level < GetNumLevels(); ++level)
+        {
+            out << "level " << level << ":  " << std::endl;
+            for(auto e : e_level_all)
+            {
+                out << std::setw(20) << e_level_names[e] << std::setw(20) << Get(level, e)
+                    << std::endl;
+            }
+        }
+        for(int kernel = 0; kernel < GetNumKernels(); ++kernel)
+        {
+            out << "kernel " << kernel_names[kernel] << ":  " << std::endl;
+            for(auto e : e_kernel_all)
+            {
+                out << std::setw(20) << e_kernel_names[e] << std::setw(20) << Get(kernel, e)
+                    << std::endl;
+            }
+        }
     }
 
     void WriteJson(std::ostream& out) const;
     void WriteNicely(std::ostream& out) const;
+
+    //
+    // @brief Write the results as csv rows 'sample,level,name,value', the level
+    // is empty for results that are not level specific.
+    //
+    void WriteCsv(std::ostream& out, int sample) const;
 };
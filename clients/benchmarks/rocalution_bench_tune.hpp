@@ -0,0 +1,157 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include <rocalution/rocalution.hpp>
+using namespace rocalution;
+
+#include "rocalution_bench_import.hpp"
+#include "rocalution_bench_solver_parameters.hpp"
+#include "rocalution_bench_solver_results.hpp"
+
+#include <iostream>
+
+bool rocalution_bench_record_results(const rocalution_bench_solver_parameters&,
+                                     const rocalution_bench_solver_results&);
+
+//
+// @brief AMG parameter tuning.
+// @details Searches the AMG algorithm, coupling strength, coarsening strategy, smoother,
+// sweeps and cycle with AMGTuner on the matrix of the benchmark configuration, for the
+// minimal setup plus solve time. The AMG preconditions the iterative solver of the
+// configuration (cg, fcg, bicgstab, gmres or fgmres), or is tuned as a solver otherwise.
+// The best configuration is printed and its times are recorded in milliseconds as
+// time_analyze and time_solve.
+//
+template <typename T>
+struct rocalution_bench_tune
+{
+    using params_t  = rocalution_bench_solver_parameters;
+    using results_t = rocalution_bench_solver_results;
+
+private:
+    const params_t* m_params{};
+
+    //
+    // @brief Tune with the outer solver S, or with the AMG as solver if S is null.
+    //
+    bool Tune(IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>* S)
+    {
+        LocalMatrix<T> A;
+        if(!rocalution_bench_import_matrix(*this->m_params, A))
+        {
+            return false;
+        }
+
+        A.MoveToAccelerator();
+
+        // Right-hand side of the solution of ones
+        LocalVector<T> S1;
+        LocalVector<T> B;
+
+        S1.MoveToAccelerator();
+        B.MoveToAccelerator();
+
+        S1.Allocate("s", A.GetN());
+        B.Allocate("b", A.GetM());
+
+        S1.Ones();
+        A.Apply(S1, &B);
+
+        AMGTuner<LocalMatrix<T>, LocalVector<T>, T> tuner;
+
+        if(S != nullptr)
+        {
+            tuner.SetSolver(*S);
+        }
+
+        tuner.Init(this->m_params->Get(params_t::abs_tol),
+                   this->m_params->Get(params_t::rel_tol),
+                   this->m_params->Get(params_t::div_tol),
+                   this->m_params->Get(params_t::max_iter));
+        tuner.Verbose(this->m_params->Get(params_t::verbose) ? 2 : 1);
+
+        const AMGTuningConfig best = tuner.Tune(A, B);
+
+        results_t results;
+        results.Set(results_t::convergence, best.converged);
+        results.Set(results_t::iter, best.iter);
+        results.Set(results_t::time_analyze, best.setup_time * 1e3);
+        results.Set(results_t::time_solve, best.solve_time * 1e3);
+        results.Set(results_t::time_global, (best.setup_time + best.solve_time) * 1e3);
+
+        return rocalution_bench_record_results(*this->m_params, results);
+    }
+
+public:
+    rocalution_bench_tune(const params_t* params)
+        : m_params(params)
+    {
+    }
+
+    bool Run()
+    {
+        const std::string itsolver = this->m_params->Get(params_t::iterative_solver);
+
+        if(itsolver == "cg")
+        {
+            CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+            return this->Tune(&ls);
+        }
+        if(itsolver == "fcg")
+        {
+            FCG<LocalMatrix<T>, LocalVector<T>, T> ls;
+            return this->Tune(&ls);
+        }
+        if(itsolver == "bicgstab")
+        {
+            BiCGStab<LocalMatrix<T>, LocalVector<T>, T> ls;
+            return this->Tune(&ls);
+        }
+        if(itsolver == "gmres")
+        {
+            GMRES<LocalMatrix<T>, LocalVector<T>, T> ls;
+            ls.SetBasisSize(this->m_params->Get(params_t::krylov_basis));
+            return this->Tune(&ls);
+        }
+        if(itsolver == "fgmres")
+        {
+            FGMRES<LocalMatrix<T>, LocalVector<T>, T> ls;
+            ls.SetBasisSize(this->m_params->Get(params_t::krylov_basis));
+            return this->Tune(&ls);
+        }
+
+        return this->Tune(nullptr);
+    }
+};
+
+//
+// @brief One function to call the AMG tuning.
+//
+template <typename T>
+bool rocalution_bench_tune_template(const rocalution_bench_solver_parameters& config)
+{
+    rocalution_bench_tune<T> bench_tune(&config);
+    return bench_tune.Run();
+}
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "rocalution_bench_preconditioner.hpp"
 #include "rocalution_driver_itsolver_template.hpp"
 
 //
@@ -142,6 +143,38 @@ public:
             return true;
         }
 
+        case rocalution_enum_matrix_init::laplacian_3d_7pt:
+        case rocalution_enum_matrix_init::laplacian_3d_27pt:
+        case rocalution_enum_matrix_init::anisotropic_3d:
+        case rocalution_enum_matrix_init::jump_3d:
+        case rocalution_enum_matrix_init::convection_diffusion_3d:
+        case rocalution_enum_matrix_init::elasticity_3d:
+        {
+            //
+            // Synthetic 3D problems with ndim grid points in each direction.
+            //
+            stencil_3d_problem problem{};
+            matrix_init.is_stencil_3d(&problem);
+
+            double coef = parameters.Get(params_t::stencil_coef);
+            if(coef == 0.0)
+            {
+                coef = stencil_3d_default_coef(problem);
+            }
+
+            int*      csr_ptr = NULL;
+            int*      csr_col = NULL;
+            T*        csr_val = NULL;
+            const int ndim    = parameters.Get(params_t::ndim);
+            auto      nrow    = gen_3d_stencil(problem, coef, ndim, &csr_ptr, &csr_col, &csr_val);
+            if(rebuild_numeric)
+            {
+                this->Cache(nrow, nrow, csr_ptr[nrow], csr_ptr, csr_col, csr_val, parameters);
+            }
+            A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", csr_ptr[nrow], nrow, nrow);
+            return true;
+        }
+
         case rocalution_enum_matrix_init::file:
         {
             const std::string matrix_filename = parameters.Get(params_t::matrix_filename);
@@ -229,221 +262,7 @@ struct rocalution_driver_itsolver_default : rocalution_driver_itsolver_base<ITSO
                                       const params_t& parameters) override
     {
 
-        auto enum_preconditioner = parameters.GetEnumPreconditioner();
-        if(enum_preconditioner.is_invalid())
-        {
-            rocalution_bench_errmsg << "enum preconditioner is invalid." << std::endl;
-            return false;
-        }
-        this->m_preconditioner = nullptr;
-        switch(enum_preconditioner.value)
-        {
-        case rocalution_enum_preconditioner::none:
-        {
-            return true;
-        }
-        case rocalution_enum_preconditioner::chebyshev:
-        {
-            // Chebyshev preconditioner
-
-            // Determine min and max eigenvalues
-            T lambda_min;
-            T lambda_max;
-
-            A.Gershgorin(lambda_min, lambda_max);
-
-            auto* p = new rocalution::
-                AIChebyshev<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            p->Set(3, lambda_max / 7.0, lambda_max);
-            this->m_preconditioner = p;
-            break;
-        }
-
-        case rocalution_enum_preconditioner::FSAI:
-        {
-            auto* p
-                = new rocalution::FSAI<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            this->m_preconditioner = p;
-            break;
-        }
-
-        case rocalution_enum_preconditioner::SPAI:
-        {
-            auto* p
-                = new rocalution::SPAI<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            this->m_preconditioner = p;
-            break;
-        }
-        case rocalution_enum_preconditioner::TNS:
-        {
-            auto* p
-                = new rocalution::TNS<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            this->m_preconditioner = p;
-            break;
-        }
-
-        case rocalution_enum_preconditioner::Jacobi:
-        {
-            auto* p
-                = new rocalution::Jacobi<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            //
-            // no specific parameters
-            //
-            this->m_preconditioner = p;
-            break;
-        }
-
-        case rocalution_enum_preconditioner::GS:
-        {
-            auto* p = new rocalution::GS<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            //
-            // no specific parameters
-            //
-            this->m_preconditioner = p;
-            break;
-        }
-
-        case rocalution_enum_preconditioner::SGS:
-        {
-            auto* p
-                = new rocalution::SGS<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            //
-            // no specific parameters
-            //
-            this->m_preconditioner = p;
-            break;
-        }
-
-        case rocalution_enum_preconditioner::ILU:
-        {
-            auto* p
-                = new rocalution::ILU<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            //
-            // no specific parameters
-            //
-            this->m_preconditioner = p;
-            break;
-        }
-        case rocalution_enum_preconditioner::ItILU0:
-        {
-            auto enum_itilu0_alg = parameters.GetEnumItILU0Algorithm();
-            if(enum_itilu0_alg.is_invalid())
-            {
-                rocalution_bench_errmsg << "enum_itilu0_alg is invalid." << std::endl;
-                return false;
-            }
-
-            auto* p
-                = new rocalution::ItILU0<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            p->SetMaxIter(parameters.Get(params_t::itilu0_max_iter));
-            p->SetTolerance(parameters.Get(params_t::itilu0_tol));
-            p->SetOptions(parameters.Get(params_t::itilu0_options));
-
-            switch(enum_itilu0_alg.value)
-            {
-            case rocalution_enum_itilu0_alg::Default:
-            {
-                p->SetAlgorithm(ItILU0Algorithm::Default);
-                break;
-            }
-            case rocalution_enum_itilu0_alg::AsyncInPlace:
-            {
-                p->SetAlgorithm(ItILU0Algorithm::AsyncInPlace);
-                break;
-            }
-            case rocalution_enum_itilu0_alg::AsyncSplit:
-            {
-                p->SetAlgorithm(ItILU0Algorithm::AsyncSplit);
-                break;
-            }
-            case rocalution_enum_itilu0_alg::SyncSplit:
-            {
-                p->SetAlgorithm(ItILU0Algorithm::SyncSplit);
-                break;
-            }
-            case rocalution_enum_itilu0_alg::SyncSplitFusion:
-            {
-                p->SetAlgorithm(ItILU0Algorithm::SyncSplitFusion);
-                break;
-            }
-            }
-
-            this->m_preconditioner = p;
-            return true;
-        }
-        case rocalution_enum_preconditioner::ILUT:
-        {
-            auto* p
-                = new rocalution::ILUT<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            p->Set(parameters.Get(params_t::ilut_tol), parameters.Get(params_t::ilut_n));
-
-            this->m_preconditioner = p;
-            break;
-        }
-        case rocalution_enum_preconditioner::IC:
-        {
-            auto* p = new rocalution::IC<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            //
-            // no specific parameters
-            //
-            this->m_preconditioner = p;
-            break;
-        }
-        case rocalution_enum_preconditioner::MCGS:
-        {
-            auto* p = new rocalution::
-                MultiColoredGS<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            p->SetRelaxation(parameters.Get(params_t::mcgs_relax));
-            this->m_preconditioner = p;
-            break;
-        }
-        case rocalution_enum_preconditioner::MCSGS:
-        {
-            auto* p = new rocalution::
-                MultiColoredSGS<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-            //
-            // no specific parameters
-            //
-            this->m_preconditioner = p;
-            break;
-        }
-        case rocalution_enum_preconditioner::MCILU:
-        {
-            auto* p = new rocalution::
-                MultiColoredILU<rocalution::LocalMatrix<T>, rocalution::LocalVector<T>, T>;
-
-            p->Set(parameters.Get(params_t::mcilu_p),
-                   parameters.Get(params_t::mcilu_q),
-                   parameters.Get(params_t::mcilu_use_level));
-
-            this->m_preconditioner = p;
-            break;
-        }
-        }
-
-        if(this->m_preconditioner != nullptr)
-        {
-            const auto itsolve = parameters.Get(params_t::iterative_solve);
-
-            rocalution::SolverDescr descr;
-
-            if(itsolve)
-            {
-                descr.SetTriSolverAlg(TriSolverAlg_Iterative);
-                descr.SetIterativeSolverMaxIteration(parameters.Get(params_t::itsolve_max_iter));
-                descr.SetIterativeSolverTolerance(parameters.Get(params_t::itsolve_tol));
-            }
-            else
-            {
-                descr.SetTriSolverAlg(TriSolverAlg_Default);
-            }
-
-            this->m_preconditioner->SetSolverDescriptor(descr);
-
-            return true;
-        }
-
-        return false;
+        return rocalution_bench_create_preconditioner(A, parameters, &this->m_preconditioner);
     }
 };
 
@@ -158,20 +158,31 @@ struct rocalution_driver_itsolver<rocalution_enum_itsolver::uaamg, T>
 
         for(int i = 0; i < levels - 1; ++i)
         {
-            this->sm[i] = new FixedPoint<LocalMatrix<T>, LocalVector<T>, T>;
-
             switch(enum_smoother.value)
             {
             case rocalution_enum_smoother::FSAI:
             {
+                this->sm[i]     = new FixedPoint<LocalMatrix<T>, LocalVector<T>, T>;
                 this->smooth[i] = new FSAI<LocalMatrix<T>, LocalVector<T>, T>;
                 break;
             }
             case rocalution_enum_smoother::ILU:
             {
+                this->sm[i]     = new FixedPoint<LocalMatrix<T>, LocalVector<T>, T>;
                 this->smooth[i] = new ILU<LocalMatrix<T>, LocalVector<T>, T>;
                 break;
             }
+            case rocalution_enum_smoother::Chebyshev:
+            {
+                // Jacobi preconditioned Chebyshev, eigenvalue bounds are estimated per level
+                Chebyshev<LocalMatrix<T>, LocalVector<T>, T>* cheb
+                    = new Chebyshev<LocalMatrix<T>, LocalVector<T>, T>;
+                cheb->SetSpectrumEstimation(10, 1.1, 0.3);
+
+                this->sm[i]     = cheb;
+                this->smooth[i] = new Jacobi<LocalMatrix<T>, LocalVector<T>, T>;
+                break;
+            }
             }
             this->sm[i]->SetPreconditioner(*(this->smooth[i]));
             this->sm[i]->Verbose(0);
@@ -40,6 +40,33 @@ bool rocalution_enum_matrix_init::is_invalid() const
     return true;
 }
 
+bool rocalution_enum_matrix_init::is_stencil_3d(stencil_3d_problem* problem) const
+{
+    switch(this->value)
+    {
+    case laplacian_3d_7pt:
+        *problem = stencil_3d_laplacian_7pt;
+        return true;
+    case laplacian_3d_27pt:
+        *problem = stencil_3d_laplacian_27pt;
+        return true;
+    case anisotropic_3d:
+        *problem = stencil_3d_anisotropic;
+        return true;
+    case jump_3d:
+        *problem = stencil_3d_jump;
+        return true;
+    case convection_diffusion_3d:
+        *problem = stencil_3d_convection_diffusion;
+        return true;
+    case elasticity_3d:
+        *problem = stencil_3d_elasticity;
+        return true;
+    default:
+        return false;
+    }
+}
+
 rocalution_enum_matrix_init::rocalution_enum_matrix_init(const char* name_)
 {
     for(auto v : all)
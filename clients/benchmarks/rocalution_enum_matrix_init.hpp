@@ -30,10 +30,16 @@
 struct rocalution_enum_matrix_init
 {
 
-#define LIST_ROCALUTION_ENUM_MATRIX_INIT \
-    ENUM_MATRIX_INIT(laplacian)          \
-    ENUM_MATRIX_INIT(permuted_identity)  \
-    ENUM_MATRIX_INIT(file)
+#define LIST_ROCALUTION_ENUM_MATRIX_INIT      \
+    ENUM_MATRIX_INIT(laplacian)               \
+    ENUM_MATRIX_INIT(permuted_identity)       \
+    ENUM_MATRIX_INIT(file)                    \
+    ENUM_MATRIX_INIT(laplacian_3d_7pt)        \
+    ENUM_MATRIX_INIT(laplacian_3d_27pt)       \
+    ENUM_MATRIX_INIT(anisotropic_3d)          \
+    ENUM_MATRIX_INIT(jump_3d)                 \
+    ENUM_MATRIX_INIT(convection_diffusion_3d) \
+    ENUM_MATRIX_INIT(elasticity_3d)
 
     //
     //
@@ -60,6 +66,11 @@ struct rocalution_enum_matrix_init
 #undef ENUM_MATRIX_INIT
 
     bool is_invalid() const;
+
+    //
+    // @brief Returns true if the matrix is one of the synthetic 3D problems.
+    //
+    bool is_stencil_3d(stencil_3d_problem* problem) const;
     rocalution_enum_matrix_init();
     rocalution_enum_matrix_init& operator()(const char* name_);
     rocalution_enum_matrix_init(const char* name_);
@@ -32,7 +32,8 @@ struct rocalution_enum_smoother
 
 #define LIST_ROCALUTION_ENUM_SMOOTHER \
     ENUM_SMOOTHER(FSAI)               \
-    ENUM_SMOOTHER(ILU)
+    ENUM_SMOOTHER(ILU)                \
+    ENUM_SMOOTHER(Chebyshev)
 
     //
     //
@@ -27,6 +27,8 @@
 #include <rocalution/rocalution.hpp>
 #include <set>
 
+#include "utility.hpp"
+
 using namespace rocalution;
 
 static void my_irecv(int* buf, int count, int source, int tag, MPI_Comm comm, MPI_Request* request)
@@ -1248,3 +1250,254 @@ void generate_3d_laplacian(int                      local_dimx,
     mat->SetGhostDataPtrCSR(&gst_csr_row_ptr, &gst_csr_col_ind, &gst_csr_val, "gst", ghost_nnz);
     mat->Sort();
 }
+
+// Generates one of the synthetic 3D problems of utility.hpp directly into a distributed
+// matrix. Each process owns a local_dimx x local_dimy x local_dimz box of grid points
+// (with all unknowns of its grid points), such that the global problem grows with the
+// number of processes.
+template <typename ValueType>
+void generate_3d_stencil(stencil_3d_problem       problem,
+                         double                   coef,
+                         int                      local_dimx,
+                         int                      local_dimy,
+                         int                      local_dimz,
+                         const MPI_Comm*          comm,
+                         GlobalMatrix<ValueType>* mat,
+                         ParallelManager*         pm,
+                         int                      rank,
+                         int                      nprocs)
+{
+    // First, we need to determine process pattern for the unit cube
+    int nproc_x;
+    int nproc_y;
+    int nproc_z;
+
+    compute_3d_process_distribution(nprocs, nproc_x, nproc_y, nproc_z);
+
+    // Next, determine process index into the unit cube
+    int iproc_z = rank / (nproc_x * nproc_y);
+    int iproc_y = (rank - iproc_z * nproc_x * nproc_y) / nproc_x;
+    int iproc_x = rank % nproc_x;
+
+    // Global sizes
+    int64_t global_dimx = static_cast<int64_t>(nproc_x) * local_dimx;
+    int64_t global_dimy = static_cast<int64_t>(nproc_y) * local_dimy;
+    int64_t global_dimz = static_cast<int64_t>(nproc_z) * local_dimz;
+
+    // Global process entry points
+    int64_t global_iproc_x = static_cast<int64_t>(iproc_x) * local_dimx;
+    int64_t global_iproc_y = static_cast<int64_t>(iproc_y) * local_dimy;
+    int64_t global_iproc_z = static_cast<int64_t>(iproc_z) * local_dimz;
+
+    // Unknowns per grid point
+    int dof     = stencil_3d_dof(problem);
+    int max_nnz = stencil_3d_max_row_nnz(problem);
+
+    // Number of rows (global and local)
+    int64_t local_nrow  = static_cast<int64_t>(local_dimx) * local_dimy * local_dimz * dof;
+    int64_t global_nrow = global_dimx * global_dimy * global_dimz * dof;
+
+    // Global column index of a local row
+    auto local2global = [&](int64_t local_row) {
+        int64_t local_point = local_row / dof;
+
+        int64_t local_x = local_point % local_dimx;
+        int64_t local_y = (local_point / local_dimx) % local_dimy;
+        int64_t local_z = local_point / (local_dimx * local_dimy);
+
+        int64_t global_point = ((global_iproc_z + local_z) * global_dimy + global_iproc_y + local_y)
+                                   * global_dimx
+                               + global_iproc_x + local_x;
+
+        return global_point * dof + local_row % dof;
+    };
+
+    // Owning process and local row of a global column
+    auto owner_of = [&](int64_t global_col, int64_t* local_row) {
+        int64_t global_point = global_col / dof;
+
+        int64_t idx_x = global_point % global_dimx;
+        int64_t idx_y = (global_point / global_dimx) % global_dimy;
+        int64_t idx_z = global_point / (global_dimx * global_dimy);
+
+        *local_row = (((idx_z % local_dimz) * local_dimy + idx_y % local_dimy) * local_dimx
+                      + idx_x % local_dimx)
+                         * dof
+                     + global_col % dof;
+
+        return static_cast<int>(idx_x / local_dimx + (idx_y / local_dimy) * nproc_x
+                                + (idx_z / local_dimz) * nproc_y * nproc_x);
+    };
+
+    // Assemble the local rows with global column indices
+    std::vector<PtrType>   global_csr_row_ptr(local_nrow + 1);
+    std::vector<int64_t>   global_csr_col_ind(local_nrow * max_nnz);
+    std::vector<ValueType> global_csr_val(local_nrow * max_nnz);
+
+    global_csr_row_ptr[0] = 0;
+
+    for(int64_t i = 0; i < local_nrow; ++i)
+    {
+        int64_t global_row   = local2global(i);
+        int64_t global_point = global_row / dof;
+
+        int64_t global_x = global_point % global_dimx;
+        int64_t global_y = (global_point / global_dimx) % global_dimy;
+        int64_t global_z = global_point / (global_dimx * global_dimy);
+
+        PtrType idx = global_csr_row_ptr[i];
+
+        global_csr_row_ptr[i + 1] = idx
+                                    + gen_3d_stencil_row(problem,
+                                                         coef,
+                                                         global_dimx,
+                                                         global_dimy,
+                                                         global_dimz,
+                                                         global_x,
+                                                         global_y,
+                                                         global_z,
+                                                         static_cast<int>(global_row % dof),
+                                                         global_csr_col_ind.data() + idx,
+                                                         global_csr_val.data() + idx);
+    }
+
+    // Now, we need to setup the communication pattern
+    std::map<int, std::set<int64_t>> recv_indices;
+    std::map<int, std::set<int64_t>> send_indices;
+
+    // CSR matrix row pointers
+    PtrType* int_csr_row_ptr = NULL;
+    PtrType* gst_csr_row_ptr = NULL;
+
+    allocate_host(local_nrow + 1, &int_csr_row_ptr);
+    allocate_host(local_nrow + 1, &gst_csr_row_ptr);
+
+    int_csr_row_ptr[0] = 0;
+    gst_csr_row_ptr[0] = 0;
+
+    // Determine, which rows need to be sent / received
+    for(int64_t i = 0; i < local_nrow; ++i)
+    {
+        int_csr_row_ptr[i + 1] = int_csr_row_ptr[i];
+        gst_csr_row_ptr[i + 1] = gst_csr_row_ptr[i];
+
+        for(PtrType j = global_csr_row_ptr[i]; j < global_csr_row_ptr[i + 1]; ++j)
+        {
+            int64_t local_col;
+            int     owner = owner_of(global_csr_col_ind[j], &local_col);
+
+            // If we do not own it, we need to receive it from our neighbor
+            // and also send the current row to this neighbor
+            if(owner != rank)
+            {
+                recv_indices[owner].insert(global_csr_col_ind[j]);
+                send_indices[owner].insert(i);
+
+                ++gst_csr_row_ptr[i + 1];
+            }
+            else
+            {
+                ++int_csr_row_ptr[i + 1];
+            }
+        }
+    }
+
+    // Number of processes we communicate with
+    int nrecv = recv_indices.size();
+    int nsend = send_indices.size();
+
+    // Process ids we communicate with and index offsets for each neighbor
+    std::vector<int> recvs;
+    std::vector<int> sends;
+    std::vector<int> recv_index_offset(1, 0);
+    std::vector<int> send_index_offset(1, 0);
+
+    // Go through the recv data, ghost columns are numbered by owner and global column
+    int                    cnt = 0;
+    std::map<int64_t, int> global2ghost;
+
+    for(auto it = recv_indices.begin(); it != recv_indices.end(); ++it)
+    {
+        recvs.push_back(it->first);
+        recv_index_offset.push_back(recv_index_offset.back() + it->second.size());
+
+        for(auto iit = it->second.begin(); iit != it->second.end(); ++iit)
+        {
+            global2ghost[*iit] = cnt++;
+        }
+    }
+
+    // Go through the send data, the boundary holds the local rows to send
+    std::vector<int> boundary;
+
+    for(auto it = send_indices.begin(); it != send_indices.end(); ++it)
+    {
+        sends.push_back(it->first);
+        send_index_offset.push_back(send_index_offset.back() + it->second.size());
+
+        for(auto iit = it->second.begin(); iit != it->second.end(); ++iit)
+        {
+            boundary.push_back(static_cast<int>(*iit));
+        }
+    }
+
+    // Initialize manager
+    pm->SetMPICommunicator(comm);
+    pm->SetGlobalNrow(global_nrow);
+    pm->SetGlobalNcol(global_nrow);
+    pm->SetLocalNrow(local_nrow);
+    pm->SetLocalNcol(local_nrow);
+
+    if(nprocs > 1)
+    {
+        pm->SetBoundaryIndex(boundary.size(), boundary.data());
+        pm->SetReceivers(nrecv, recvs.data(), recv_index_offset.data());
+        pm->SetSenders(nsend, sends.data(), send_index_offset.data());
+    }
+
+    mat->SetParallelManager(*pm);
+
+    // Generate local and ghost matrices
+    int64_t local_nnz = int_csr_row_ptr[local_nrow];
+    int64_t ghost_nnz = gst_csr_row_ptr[local_nrow];
+
+    int*       int_csr_col_ind = NULL;
+    int*       gst_csr_col_ind = NULL;
+    ValueType* int_csr_val     = NULL;
+    ValueType* gst_csr_val     = NULL;
+
+    allocate_host(local_nnz, &int_csr_col_ind);
+    allocate_host(local_nnz, &int_csr_val);
+    allocate_host(ghost_nnz, &gst_csr_col_ind);
+    allocate_host(ghost_nnz, &gst_csr_val);
+
+    // Convert global matrix columns to local and ghost columns
+    for(int64_t i = 0; i < local_nrow; ++i)
+    {
+        PtrType local_idx = int_csr_row_ptr[i];
+        PtrType ghost_idx = gst_csr_row_ptr[i];
+
+        for(PtrType j = global_csr_row_ptr[i]; j < global_csr_row_ptr[i + 1]; ++j)
+        {
+            int64_t local_col;
+            int     owner = owner_of(global_csr_col_ind[j], &local_col);
+
+            if(owner != rank)
+            {
+                gst_csr_col_ind[ghost_idx] = global2ghost[global_csr_col_ind[j]];
+                gst_csr_val[ghost_idx]     = global_csr_val[j];
+                ++ghost_idx;
+            }
+            else
+            {
+                int_csr_col_ind[local_idx] = static_cast<int>(local_col);
+                int_csr_val[local_idx]     = global_csr_val[j];
+                ++local_idx;
+            }
+        }
+    }
+
+    mat->SetLocalDataPtrCSR(&int_csr_row_ptr, &int_csr_col_ind, &int_csr_val, "mat", local_nnz);
+    mat->SetGhostDataPtrCSR(&gst_csr_row_ptr, &gst_csr_col_ind, &gst_csr_val, "gst", ghost_nnz);
+    mat->Sort();
+}
@@ -0,0 +1,168 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_AMG_TUNER_HPP
+#define TESTING_AMG_TUNER_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+#include <type_traits>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-5);
+}
+
+template <typename T>
+bool testing_amg_tuner(Arguments argus)
+{
+    int         ndim   = argus.size;
+    std::string solver = argus.solver;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    CG<LocalMatrix<T>, LocalVector<T>, T> cg;
+
+    // Relative tolerance within the precision
+    const double tol = std::is_same<T, float>::value ? 1e-5 : 1e-10;
+
+    // Small search space
+    AMGTuner<LocalMatrix<T>, LocalVector<T>, T> tuner;
+
+    if(solver == "CG")
+    {
+        tuner.SetSolver(cg);
+    }
+
+    tuner.SetAMGTypes({TuneSAAMG, TuneUAAMG});
+    tuner.SetCouplingStrengths({0.01, 0.08});
+    tuner.SetCoarseningStrategies({Greedy});
+    tuner.SetSmoothers({JacobiSmoother});
+    tuner.SetSweeps({1, 2});
+    tuner.SetCycles({Vcycle});
+    tuner.SetCoarsestLevels({10});
+    tuner.Init(0.0, tol, 1e+8, 10000);
+    tuner.Verbose(0);
+
+    AMGTuningConfig best = tuner.Tune(A, b);
+
+    bool success = best.converged && tuner.GetNumConfigs() == 8;
+
+    // The best configuration has the minimal time-to-solution of all converged ones
+    for(int i = 0; i < tuner.GetNumConfigs(); ++i)
+    {
+        const AMGTuningConfig& config = tuner.GetConfig(i);
+
+        if(config.converged)
+        {
+            success = success
+                      && best.setup_time + best.solve_time
+                             <= config.setup_time + config.solve_time;
+        }
+    }
+
+    // Solve with the best configuration
+    BaseAMG<LocalMatrix<T>, LocalVector<T>, T>* p
+        = AMGTuner<LocalMatrix<T>, LocalVector<T>, T>::CreateAMG(best);
+
+    p->Verbose(0);
+
+    x.Zeros();
+
+    if(solver == "CG")
+    {
+        p->InitMaxIter(1);
+
+        cg.Verbose(0);
+        cg.SetOperator(A);
+        cg.SetPreconditioner(*p);
+        cg.Init(0.0, tol, 1e+8, 10000);
+        cg.Build();
+        cg.Solve(b, &x);
+        cg.Clear();
+    }
+    else
+    {
+        p->SetOperator(A);
+        p->Init(0.0, tol, 1e+8, 10000);
+        p->Build();
+        p->Solve(b, &x);
+    }
+
+    p->Clear();
+    delete p;
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    success = success && check_residual(x.Norm());
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_AMG_TUNER_HPP
@@ -27,8 +27,12 @@
 
 #include "utility.hpp"
 
+#include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <sstream>
 #include <rocalution/rocalution.hpp>
+#include <thread>
 
 using namespace rocalution;
 
@@ -49,6 +53,10 @@ void testing_backend_init_order(void)
     // Set OpenMP threshold size
     ASSERT_DEATH(set_omp_threshold_rocalution(threshold), ".*Assertion.*");
 
+    // Initialize rocalution platform on an invalid MPI communicator
+    const void* null_comm = nullptr;
+    ASSERT_DEATH(init_rocalution(null_comm), ".*Assertion.*comm != (NULL|__null)*");
+
     // Initialize rocalution platform
     set_device_rocalution(device);
     init_rocalution();
@@ -66,6 +74,146 @@ void testing_backend_init_order(void)
     stop_rocalution();
 }
 
+void testing_backend_host_fallback(void)
+{
+    int64_t count;
+    int64_t bytes;
+    double  time;
+
+    // Initialize rocalution platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Statistics are empty after reset
+    reset_host_fallback_rocalution();
+
+    ASSERT_TRUE(get_host_fallback_rocalution("", &count, &bytes, &time));
+    EXPECT_EQ(count, 0);
+    EXPECT_EQ(bytes, 0);
+    EXPECT_EQ(time, 0.0);
+
+    // Unknown functions are not recorded
+    EXPECT_FALSE(get_host_fallback_rocalution("LocalMatrix::Unknown()", &count, &bytes, &time));
+
+    // Generate A
+    int*    csr_ptr = NULL;
+    int*    csr_col = NULL;
+    double* csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(16, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<double> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<double> x;
+    LocalVector<double> y;
+    LocalVector<int>    perm;
+
+    // Host objects never fall back, even in strict mode
+    set_strict_host_fallback_rocalution(true);
+    A.RCMK(&perm);
+    set_strict_host_fallback_rocalution(false);
+
+    ASSERT_TRUE(get_host_fallback_rocalution("", &count, &bytes, &time));
+    EXPECT_EQ(count, 0);
+
+    // Operations on the accelerator are recorded, if they fall back to the host
+    A.MoveToAccelerator();
+    A.RCMK(&perm);
+
+    if(get_host_fallback_rocalution("LocalMatrix::RCMK()", &count, &bytes, &time) == true)
+    {
+        EXPECT_GT(count, 0);
+        EXPECT_GT(bytes, 0);
+        EXPECT_GE(time, 0.0);
+    }
+
+    // Supported operations do not trigger the strict mode
+    x.MoveToAccelerator();
+    y.MoveToAccelerator();
+    x.Allocate("x", A.GetN());
+    y.Allocate("y", A.GetM());
+    x.Ones();
+
+    int64_t count_before;
+    ASSERT_TRUE(get_host_fallback_rocalution("", &count_before, &bytes, &time));
+
+    set_strict_host_fallback_rocalution(true);
+    A.Apply(x, &y);
+    set_strict_host_fallback_rocalution(false);
+
+    ASSERT_TRUE(get_host_fallback_rocalution("", &count, &bytes, &time));
+    EXPECT_EQ(count, count_before);
+
+    reset_host_fallback_rocalution();
+
+    // Stop rocalution platform
+    stop_rocalution();
+}
+
+void testing_backend_tuning_cache(void)
+{
+    const std::string filename = "rocalution_tuning_cache_test.txt";
+    std::remove(filename.c_str());
+
+    // Initialize rocalution platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    set_tuning_cache_rocalution(filename);
+
+    // Generate A, the size is not used by other tests, so it has not been tuned yet
+    int*    csr_ptr = NULL;
+    int*    csr_col = NULL;
+    double* csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(37, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<double> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalMatrix<double> B;
+    B.CloneFrom(A);
+
+    // The decision is appended to the file
+    A.ConvertToBest(2);
+
+    std::string line;
+    {
+        std::ifstream file(filename);
+        ASSERT_TRUE(file.is_open());
+        ASSERT_TRUE(std::getline(file, line));
+    }
+
+    size_t pos = line.rfind(';');
+    ASSERT_NE(pos, std::string::npos);
+
+    // Matrices with the same signature use the cached decision
+    B.ConvertToBest(2);
+    EXPECT_EQ(B.GetFormat(), A.GetFormat());
+
+    // Decisions are loaded from the file, later entries win
+    {
+        std::ofstream file(filename, std::ios::app);
+        file << line.substr(0, pos) << ";" << ELL << " 1 256" << std::endl;
+    }
+
+    set_tuning_cache_rocalution(filename);
+
+    B.ConvertToCSR();
+    B.ConvertToBest(2);
+    EXPECT_EQ(B.GetFormat(), ELL);
+    EXPECT_TRUE(B.Check());
+
+    set_tuning_cache_rocalution("");
+    std::remove(filename.c_str());
+
+    // Stop rocalution platform
+    stop_rocalution();
+}
+
 void testing_backend(Arguments argus)
 {
     int  rank         = argus.rank;
@@ -98,4 +246,429 @@ void testing_backend(Arguments argus)
     stop_rocalution();
 }
 
+void testing_backend_log_record(void)
+{
+    // Initialize rocalution platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    reset_transfer_bytes_rocalution();
+
+    int64_t h2d;
+    int64_t d2h;
+    get_transfer_bytes_rocalution(&h2d, &d2h);
+
+    EXPECT_EQ(h2d, 0);
+    EXPECT_EQ(d2h, 0);
+
+    // Generate A
+    int*    csr_ptr = NULL;
+    int*    csr_col = NULL;
+    double* csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(8, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<double> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<double> v;
+    v.Allocate("v", nrow);
+    v.Ones();
+
+    // A round trip moves the same number of bytes in both directions, if an
+    // accelerator is available
+    v.MoveToAccelerator();
+    v.MoveToHost();
+
+    get_transfer_bytes_rocalution(&h2d, &d2h);
+
+    EXPECT_EQ(h2d, d2h);
+    EXPECT_TRUE(h2d == 0 || h2d >= static_cast<int64_t>(sizeof(double) * nrow));
+
+    // Solver tree of the structured solve records
+    CG<LocalMatrix<double>, LocalVector<double>, double>     ls;
+    Jacobi<LocalMatrix<double>, LocalVector<double>, double> p;
+
+    ls.SetOperator(A);
+    ls.SetPreconditioner(p);
+    ls.Build();
+
+    std::ostringstream tree;
+    tree << "{\"name\": \"CG\", \"m\": " << nrow << ", \"n\": " << nrow
+         << ", \"nnz\": " << nnz << ", \"precond\": {\"name\": \"Jacobi\"";
+
+    EXPECT_EQ(ls.LogTree().find(tree.str()), static_cast<size_t>(0));
+
+    ls.Clear();
+
+    // Stop rocalution platform
+    stop_rocalution();
+}
+
+void testing_backend_execution_context(void)
+{
+    // Initialize rocalution platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    {
+        ExecutionContext ctx;
+
+        // Generate A
+        int*    csr_ptr = NULL;
+        int*    csr_col = NULL;
+        double* csr_val = NULL;
+
+        int nrow = gen_2d_laplacian(16, &csr_ptr, &csr_col, &csr_val);
+        int nnz  = csr_ptr[nrow];
+
+        LocalMatrix<double> A;
+        LocalVector<double> x;
+        LocalVector<double> b;
+        LocalVector<double> e;
+
+        A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+        A.MoveToAccelerator();
+        A.SetExecutionContext(ctx);
+
+        // Vectors inherit the context from the matrix
+        x.CloneBackend(A);
+        b.CloneBackend(A);
+        e.CloneBackend(A);
+
+        x.Allocate("x", nrow);
+        b.Allocate("b", nrow);
+        e.Allocate("e", nrow);
+
+        e.Ones();
+        A.Apply(e, &b);
+        x.Zeros();
+
+        CG<LocalMatrix<double>, LocalVector<double>, double> ls;
+
+        ls.Verbose(0);
+        ls.SetOperator(A);
+        ls.Init(1e-10, 0.0, 1e+8, 1000);
+        ls.Build();
+        ls.Solve(b, &x);
+
+        ctx.Sync();
+
+        x.ScaleAdd(-1.0, e);
+        EXPECT_LT(x.Norm(), 1e-6);
+
+        ls.Clear();
+    }
+
+    // Stop rocalution platform
+    stop_rocalution();
+}
+
+void testing_backend_execution_context_device(void)
+{
+    // Initialize rocalution platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    {
+        ExecutionContext ctx1;
+        ExecutionContext ctx2(NULL, device);
+
+        // Generate A
+        int*    csr_ptr = NULL;
+        int*    csr_col = NULL;
+        double* csr_val = NULL;
+
+        int nrow = gen_2d_laplacian(16, &csr_ptr, &csr_col, &csr_val);
+        int nnz  = csr_ptr[nrow];
+
+        LocalMatrix<double> A;
+        LocalVector<double> x;
+        LocalVector<double> b;
+        LocalVector<double> e;
+
+        A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+        x.Allocate("x", nrow);
+        b.Allocate("b", nrow);
+        e.Allocate("e", nrow);
+
+        e.Ones();
+        A.Apply(e, &b);
+        x.Zeros();
+
+        // Host to device of the first context, then to the device of the second one
+        A.MoveToAccelerator(ctx1);
+        b.MoveToAccelerator(ctx1);
+
+        A.MoveToAccelerator(ctx2);
+        b.MoveToAccelerator(ctx2);
+        x.MoveToAccelerator(ctx2);
+        e.MoveToAccelerator(ctx2);
+
+        ctx2.Activate();
+
+        CG<LocalMatrix<double>, LocalVector<double>, double> ls;
+
+        ls.Verbose(0);
+        ls.SetOperator(A);
+        ls.Init(1e-10, 0.0, 1e+8, 1000);
+        ls.Build();
+        ls.Solve(b, &x);
+
+        ctx2.Sync();
+
+        x.ScaleAdd(-1.0, e);
+        EXPECT_LT(x.Norm(), 1e-6);
+
+        ls.Clear();
+    }
+
+    // Stop rocalution platform
+    stop_rocalution();
+}
+
+void testing_backend_threads(void)
+{
+    // Initialize rocalution platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    set_time_breakdown_rocalution(true);
+    reset_time_breakdown_rocalution();
+
+    const int nthreads = 4;
+
+    std::vector<int>    iter(nthreads, 0);
+    std::vector<double> error(nthreads, 1.0);
+
+    // Independent solves, each thread creates its objects on its own context
+    std::vector<std::thread> threads;
+
+    for(int t = 0; t < nthreads; ++t)
+    {
+        threads.push_back(std::thread([t, &iter, &error]() {
+            ExecutionContext ctx;
+            ctx.MakeCurrent();
+
+            int*    csr_ptr = NULL;
+            int*    csr_col = NULL;
+            double* csr_val = NULL;
+
+            int nrow = gen_2d_laplacian(16 + 4 * t, &csr_ptr, &csr_col, &csr_val);
+            int nnz  = csr_ptr[nrow];
+
+            LocalMatrix<double> A;
+            LocalVector<double> x;
+            LocalVector<double> b;
+            LocalVector<double> e;
+
+            A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+            A.MoveToAccelerator();
+            x.MoveToAccelerator();
+            b.MoveToAccelerator();
+            e.MoveToAccelerator();
+
+            x.Allocate("x", nrow);
+            b.Allocate("b", nrow);
+            e.Allocate("e", nrow);
+
+            e.Ones();
+            A.Apply(e, &b);
+            x.Zeros();
+
+            CG<LocalMatrix<double>, LocalVector<double>, double> ls;
+            Jacobi<LocalMatrix<double>, LocalVector<double>, double> p;
+
+            ls.Verbose(0);
+            ls.SetOperator(A);
+            ls.SetPreconditioner(p);
+            ls.Init(1e-10, 0.0, 1e+8, 1000);
+            ls.Build();
+            ls.Solve(b, &x);
+
+            ctx.Sync();
+
+            x.ScaleAdd(-1.0, e);
+
+            iter[t]  = ls.GetIterationCount();
+            error[t] = x.Norm();
+
+            ls.Clear();
+        }));
+    }
+
+    for(int t = 0; t < nthreads; ++t)
+    {
+        threads[t].join();
+    }
+
+    for(int t = 0; t < nthreads; ++t)
+    {
+        EXPECT_GT(iter[t], 0);
+        EXPECT_LT(error[t], 1e-6);
+    }
+
+    // The time of all threads is accumulated
+    EXPECT_GT(get_time_breakdown_rocalution(TimeSpMV), 0.0);
+    EXPECT_GT(get_time_breakdown_rocalution(TimePreconditioner), 0.0);
+
+    set_time_breakdown_rocalution(false);
+    reset_time_breakdown_rocalution();
+
+    // Stop rocalution platform
+    stop_rocalution();
+}
+
+void testing_backend_graph_replay(void)
+{
+    // Initialize rocalution platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    {
+        ExecutionContext ctx;
+
+        // Generate A
+        int*    csr_ptr = NULL;
+        int*    csr_col = NULL;
+        double* csr_val = NULL;
+
+        int nrow = gen_2d_laplacian(16, &csr_ptr, &csr_col, &csr_val);
+        int nnz  = csr_ptr[nrow];
+
+        LocalMatrix<double> A;
+        LocalVector<double> b;
+        LocalVector<double> x1;
+        LocalVector<double> x2;
+
+        A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+        A.MoveToAccelerator(ctx);
+
+        b.CloneBackend(A);
+        x1.CloneBackend(A);
+        x2.CloneBackend(A);
+
+        b.Allocate("b", nrow);
+        x1.Allocate("x1", nrow);
+        x2.Allocate("x2", nrow);
+
+        b.Ones();
+        x1.Zeros();
+        x2.Zeros();
+
+        // Jacobi smoothing, launched as usual and replayed from a graph
+        FixedPoint<LocalMatrix<double>, LocalVector<double>, double> fp1;
+        FixedPoint<LocalMatrix<double>, LocalVector<double>, double> fp2;
+        Jacobi<LocalMatrix<double>, LocalVector<double>, double>     p1;
+        Jacobi<LocalMatrix<double>, LocalVector<double>, double>     p2;
+
+        fp1.SetOperator(A);
+        fp1.SetPreconditioner(p1);
+        fp1.SetRelaxation(0.8);
+        fp1.Init(0.0, 0.0, 1e+8, 5);
+        fp1.Verbose(0);
+        fp1.Build();
+        fp1.FlagSmoother();
+
+        fp2.SetOperator(A);
+        fp2.SetPreconditioner(p2);
+        fp2.SetRelaxation(0.8);
+        fp2.Init(0.0, 0.0, 1e+8, 5);
+        fp2.Verbose(0);
+        fp2.SetGraphReplay(true);
+        fp2.Build();
+        fp2.FlagSmoother();
+
+        // The second solve launches the captured graph only
+        for(int i = 0; i < 2; ++i)
+        {
+            fp1.Solve(b, &x1);
+            fp2.Solve(b, &x2);
+        }
+
+        ctx.Sync();
+
+        x1.ScaleAdd(-1.0, x2);
+        EXPECT_LT(x1.Norm(), 1e-12);
+
+        fp1.Clear();
+        fp2.Clear();
+    }
+
+    // Stop rocalution platform
+    stop_rocalution();
+}
+
+void testing_backend_reproducible_reductions(void)
+{
+    // Initialize rocalution platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    set_reproducible_reductions_rocalution(true);
+
+    // Several reduction blocks, with a partial last block
+    const int64_t size = 100003;
+
+    LocalVector<double> x;
+    LocalVector<double> y;
+
+    x.Allocate("x", size);
+    y.Allocate("y", size);
+
+    x.SetRandomUniform(12345ULL, -1.0, 1.0);
+    y.SetRandomUniform(67890ULL, -1.0, 1.0);
+
+    // The host results do not depend on the number of threads
+    set_omp_threads_rocalution(1);
+
+    double dot  = x.Dot(y);
+    double nrm  = x.Norm();
+    double sum  = x.Reduce();
+    double asum = x.Asum();
+
+    for(int nthreads = 2; nthreads <= 4; ++nthreads)
+    {
+        set_omp_threads_rocalution(nthreads);
+
+        EXPECT_EQ(x.Dot(y), dot);
+        EXPECT_EQ(x.Norm(), nrm);
+        EXPECT_EQ(x.Reduce(), sum);
+        EXPECT_EQ(x.Asum(), asum);
+    }
+
+    // The accelerator results are identical between runs
+    x.MoveToAccelerator();
+    y.MoveToAccelerator();
+
+    double acc_dot  = x.Dot(y);
+    double acc_nrm  = x.Norm();
+    double acc_sum  = x.Reduce();
+    double acc_asum = x.Asum();
+
+    for(int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(x.Dot(y), acc_dot);
+        EXPECT_EQ(x.Norm(), acc_nrm);
+        EXPECT_EQ(x.Reduce(), acc_sum);
+        EXPECT_EQ(x.Asum(), acc_asum);
+    }
+
+    // Host and accelerator sum in a different order
+    EXPECT_NEAR(acc_dot, dot, 1e-10 * size);
+    EXPECT_NEAR(acc_nrm, nrm, 1e-10 * nrm);
+    EXPECT_NEAR(acc_sum, sum, 1e-10 * size);
+    EXPECT_NEAR(acc_asum, asum, 1e-10 * asum);
+
+    set_reproducible_reductions_rocalution(false);
+
+    // Stop rocalution platform
+    stop_rocalution();
+}
+
 #endif // TESTING_BACKEND_HPP
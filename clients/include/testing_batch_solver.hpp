@@ -0,0 +1,205 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#pragma once
+#ifndef TESTING_BATCH_SOLVER_HPP
+#define TESTING_BATCH_SOLVER_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+#include <type_traits>
+#include <vector>
+
+using namespace rocalution;
+
+static bool check_error(float err)
+{
+    return (err < 1e-3f);
+}
+
+static bool check_error(double err)
+{
+    return (err < 1e-6);
+}
+
+template <typename T>
+bool testing_batch_solver(Arguments argus)
+{
+    int         ndim    = argus.size;
+    int         batch   = argus.index;
+    std::string solver  = argus.solver;
+    std::string precond = argus.precond;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T>      A;
+    LocalBatchMatrix<T> Ab;
+    LocalMultiVector<T> X;
+    LocalMultiVector<T> B;
+    LocalMultiVector<T> E;
+
+    // Generate the shared pattern
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    // Perturb the values of each system, such that all systems differ and become
+    // non-symmetric
+    std::vector<T> val(static_cast<size_t>(nnz) * batch);
+
+    for(int k = 0; k < batch; ++k)
+    {
+        for(int i = 0; i < nrow; ++i)
+        {
+            for(int j = csr_ptr[i]; j < csr_ptr[i + 1]; ++j)
+            {
+                T scale = (csr_col[j] == i)
+                              ? static_cast<T>(1.2 + 0.4 * (k % 3))
+                              : static_cast<T>(1.0 + 0.05 * ((k + j) % 5 - 2));
+
+                val[k * nnz + j] = scale * csr_val[j];
+            }
+        }
+    }
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    Ab.MoveToAccelerator();
+    X.MoveToAccelerator();
+    B.MoveToAccelerator();
+    E.MoveToAccelerator();
+
+    Ab.SetPattern(A, batch);
+    Ab.CopyFromHostValues(val.data());
+
+    // Allocate X, B and E
+    X.Allocate("X", nrow, batch);
+    B.Allocate("B", nrow, batch);
+    E.Allocate("E", nrow, batch);
+
+    // B_k = A_k * E_k
+    E.SetRandomUniform(12345ULL, -1.0, 1.0);
+    Ab.Apply(E, &B);
+
+    // Verify the batched product of the last system against a single product
+    bool success = true;
+
+    LocalMatrix<T> Ak;
+    LocalVector<T> ek;
+    LocalVector<T> bk;
+    LocalVector<T> rk;
+
+    Ab.ExtractSystem(batch - 1, &Ak);
+
+    ek.CloneBackend(Ak);
+    bk.CloneBackend(Ak);
+
+    E.GetColumn(batch - 1, &ek);
+    B.GetColumn(batch - 1, &bk);
+
+    rk.CloneBackend(Ak);
+    rk.Allocate("r", nrow);
+
+    Ak.Apply(ek, &rk);
+    rk.ScaleAdd(-1.0, bk);
+
+    success = success && check_error(rk.Norm() / bk.Norm());
+
+    // Zero initial guess
+    X.Zeros();
+
+    // Solver
+    BaseBatchSolver<T>* ls;
+
+    if(solver == "BatchBiCGStab")
+    {
+        ls = new BatchBiCGStab<T>;
+    }
+    else if(solver == "BatchGMRES")
+    {
+        BatchGMRES<T>* gmres = new BatchGMRES<T>;
+        gmres->SetBasisSize(20);
+        ls = gmres;
+    }
+    else
+    {
+        return false;
+    }
+
+    if(precond == "None")
+        ls->SetPreconditioner(BatchPrecondNone);
+    else if(precond == "Jacobi")
+        ls->SetPreconditioner(BatchPrecondJacobi);
+    else if(precond == "ILU0")
+        ls->SetPreconditioner(BatchPrecondILU0);
+    else
+        return false;
+
+    ls->Verbose(0);
+    ls->SetOperator(Ab);
+    ls->Init(0.0, std::is_same<T, float>::value ? 1e-6 : 1e-10, 1000);
+    ls->Build();
+
+    ls->Solve(B, &X);
+
+    // Verify the solution of each system, relative to the norm of the solution
+    X.ScaleAdd(-1.0, E);
+    X.MoveToHost();
+    E.MoveToHost();
+
+    for(int k = 0; k < batch; ++k)
+    {
+        T nrm2 = static_cast<T>(0);
+        T ref2 = static_cast<T>(0);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            nrm2 += X(i, k) * X(i, k);
+            ref2 += E(i, k) * E(i, k);
+        }
+
+        success = success && check_error(std::sqrt(nrm2 / ref2));
+        success = success && (ls->GetIterationCount(k) < 1000);
+    }
+
+    // Clean up
+    ls->Clear();
+    delete ls;
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_BATCH_SOLVER_HPP
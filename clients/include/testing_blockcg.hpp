@@ -0,0 +1,156 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#pragma once
+#ifndef TESTING_BLOCKCG_HPP
+#define TESTING_BLOCKCG_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-3f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-6);
+}
+
+template <typename T>
+bool testing_blockcg(Arguments argus)
+{
+    int          ndim    = argus.size;
+    int          nrhs    = argus.nrhs;
+    std::string  precond = argus.precond;
+    unsigned int format  = argus.format;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T>      A;
+    LocalMultiVector<T> X;
+    LocalMultiVector<T> B;
+    LocalMultiVector<T> E;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    X.MoveToAccelerator();
+    B.MoveToAccelerator();
+    E.MoveToAccelerator();
+
+    // Allocate X, B and E
+    X.Allocate("X", A.GetN(), nrhs);
+    B.Allocate("B", A.GetM(), nrhs);
+    E.Allocate("E", A.GetN(), nrhs);
+
+    // B = A * E, with linearly independent columns of E
+    E.SetRandomUniform(12345ULL, -1.0, 1.0);
+    A.Apply(E, &B);
+
+    // Zero initial guess
+    X.Zeros();
+
+    // Solver
+    BlockCG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+    // Preconditioner
+    Preconditioner<LocalMatrix<T>, LocalVector<T>, T>* p;
+
+    if(precond == "None")
+        p = NULL;
+    else if(precond == "Jacobi")
+        p = new Jacobi<LocalMatrix<T>, LocalVector<T>, T>;
+    else if(precond == "SGS")
+        p = new SGS<LocalMatrix<T>, LocalVector<T>, T>;
+    else if(precond == "IC")
+        p = new IC<LocalMatrix<T>, LocalVector<T>, T>;
+    else
+        return false;
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+
+    // Set preconditioner
+    if(p != NULL)
+    {
+        ls.SetPreconditioner(*p);
+    }
+
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    // Matrix format
+    A.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
+
+    ls.Solve(B, &X);
+
+    // Verify solution of each right-hand side
+    X.ScaleAdd(-1.0, E);
+    X.MoveToHost();
+
+    bool success = true;
+
+    for(int j = 0; j < nrhs; ++j)
+    {
+        T nrm2 = static_cast<T>(0);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            nrm2 += X(i, j) * X(i, j);
+        }
+
+        success = success && check_residual(std::sqrt(nrm2));
+    }
+
+    // Clean up
+    ls.Clear();
+    if(p != NULL)
+    {
+        delete p;
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_BLOCKCG_HPP
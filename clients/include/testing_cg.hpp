@@ -112,6 +112,15 @@ bool testing_cg(Arguments argus)
     }
     else if(precond == "FSAI")
         p = new FSAI<LocalMatrix<T>, LocalVector<T>, T>;
+    else if(precond == "FSAI2T")
+    {
+        // FSAI(2) with a thresholded pattern
+        FSAI<LocalMatrix<T>, LocalVector<T>, T>* fsai = new FSAI<LocalMatrix<T>, LocalVector<T>, T>;
+        fsai->Set(2);
+        fsai->SetPatternThreshold(0.1);
+
+        p = fsai;
+    }
     else if(precond == "SPAI")
         p = new SPAI<LocalMatrix<T>, LocalVector<T>, T>;
     else if(precond == "TNS")
@@ -175,4 +184,177 @@ bool testing_cg(Arguments argus)
     return success;
 }
 
+template <typename T>
+bool testing_cg_check_interval(void)
+{
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(63, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    bool success = true;
+
+    // Reference solve, checking the residual in every iteration
+    x.Zeros();
+    ls.Solve(b, &x);
+
+    int ref_iter   = ls.GetIterationCount();
+    int ref_status = ls.GetSolverStatus();
+
+    // Check the residual every 8 iterations
+    int interval = 8;
+
+    x.Zeros();
+    ls.SetResidualCheckInterval(interval);
+    ls.Solve(b, &x);
+
+    int iter = ls.GetIterationCount();
+
+    // The solver stops at the first checked iteration past convergence
+    success &= (iter % interval == 0);
+    success &= (iter >= ref_iter && iter < ref_iter + interval);
+    success &= (ls.GetSolverStatus() == ref_status);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    success &= check_residual(x.Norm());
+
+    // Clean up
+    ls.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_cg_solution_history(void)
+{
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+    LocalVector<T> d;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(63, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+    d.MoveToAccelerator();
+
+    // Allocate x, b, e and d
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+    d.Allocate("d", A.GetN());
+
+    d.SetRandomUniform(1234ULL, static_cast<T>(-1), static_cast<T>(1));
+
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.Init(1e-4, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    bool success = true;
+
+    int ref_iter = 0;
+
+    for(int alg = 0; alg < 2; ++alg)
+    {
+        ls.SetSolutionHistory(3, static_cast<InitialGuessAlg>(alg));
+
+        // Time steps with the exact solutions e_t = 1 + t * d, the solutions of the
+        // first two steps determine the following ones
+        for(int t = 0; t < 4; ++t)
+        {
+            e.Ones();
+            e.AddScale(d, static_cast<T>(t));
+            A.Apply(e, &b);
+
+            x.Zeros();
+            ls.Solve(b, &x);
+
+            int iter = ls.GetIterationCount();
+
+            if(t == 0)
+            {
+                // Reference without history
+                ref_iter = iter;
+            }
+            else if(t >= 2)
+            {
+                success &= (2 * iter < ref_iter);
+            }
+
+            // Verify solution
+            x.ScaleAdd(-1.0, e);
+            success &= check_residual(x.Norm());
+        }
+    }
+
+    // Clean up
+    ls.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_CG_HPP
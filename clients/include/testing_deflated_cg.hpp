@@ -0,0 +1,197 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_DEFLATED_CG_HPP
+#define TESTING_DEFLATED_CG_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-3);
+}
+
+template <typename T>
+bool testing_deflated_cg(Arguments argus)
+{
+    int          ndim     = argus.size;
+    int          mode     = argus.index;
+    bool         flexible = (argus.chunk_size != 0);
+    std::string  precond  = argus.precond;
+    unsigned int format   = argus.format;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Subdomain indicator vectors as user defined deflation space
+    int            nsub = 4;
+    LocalVector<T> w[4];
+
+    for(int k = 0; k < nsub; ++k)
+    {
+        w[k].Allocate("w", nrow);
+
+        T* val = NULL;
+        w[k].LeaveDataPtr(&val);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            val[i] = (i * nsub / nrow == k) ? static_cast<T>(1) : static_cast<T>(0);
+        }
+
+        w[k].SetDataPtr(&val, "w", nrow);
+        w[k].MoveToAccelerator();
+    }
+
+    const LocalVector<T>* wptr[4] = {&w[0], &w[1], &w[2], &w[3]};
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // Solver
+    DeflatedCG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+    // Preconditioner
+    Preconditioner<LocalMatrix<T>, LocalVector<T>, T>* p;
+
+    if(precond == "None")
+        p = NULL;
+    else if(precond == "Jacobi")
+        p = new Jacobi<LocalMatrix<T>, LocalVector<T>, T>;
+    else if(precond == "IC")
+        p = new IC<LocalMatrix<T>, LocalVector<T>, T>;
+    else if(precond == "MCSGS")
+        p = new MultiColoredSGS<LocalMatrix<T>, LocalVector<T>, T>;
+    else
+        return false;
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.SetFlexible(flexible);
+
+    // Deflation space, 0 = none, 1 = user defined, 2 = Ritz vectors of previous solves
+    if(mode == 1)
+    {
+        ls.SetDeflationVectors(nsub, wptr);
+    }
+    else if(mode == 2)
+    {
+        ls.SetRitzDeflation(4, 20);
+    }
+
+    // Set preconditioner
+    if(p != NULL)
+    {
+        ls.SetPreconditioner(*p);
+    }
+
+    ls.Init(1e-6, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    // Matrix format
+    A.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
+
+    bool success = true;
+
+    // Sequence of solves with different right-hand sides
+    for(int t = 0; t < 3; ++t)
+    {
+        // b = A * e
+        e.SetRandomUniform(12345ULL + t, 0.5, 1.5);
+        A.Apply(e, &b);
+
+        // Random initial guess
+        x.SetRandomUniform(54321ULL + t, -4.0, 6.0);
+
+        ls.Solve(b, &x);
+
+        // Verify solution
+        x.ScaleAdd(-1.0, e);
+        T nrm2 = x.Norm();
+
+        success &= check_residual(nrm2);
+
+        // Deflation space size
+        if(mode == 0)
+        {
+            success &= (ls.GetDeflationSize() == 0);
+        }
+        else if(mode == 1)
+        {
+            success &= (ls.GetDeflationSize() == nsub);
+        }
+        else
+        {
+            success &= (ls.GetDeflationSize() > 0);
+        }
+    }
+
+    // Clean up
+    ls.Clear();
+    if(p != NULL)
+    {
+        delete p;
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_DEFLATED_CG_HPP
@@ -0,0 +1,160 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_EIGEN_SOLVER_HPP
+#define TESTING_EIGEN_SOLVER_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static double eigen_solver_tolerance(float)
+{
+    return 1e-3;
+}
+
+static double eigen_solver_tolerance(double)
+{
+    return 1e-8;
+}
+
+template <typename T>
+bool testing_eigen_solver(Arguments argus)
+{
+    int          ndim    = argus.size;
+    std::string  solver  = argus.solver;
+    EigenTarget  target  = (argus.index == 0) ? EigenTarget_Smallest : EigenTarget_Largest;
+    std::string  precond = argus.precond;
+    unsigned int format  = argus.format;
+
+    int    nev = 4;
+    double tol = eigen_solver_tolerance(T());
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> r;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    r.MoveToAccelerator();
+
+    r.Allocate("r", A.GetM());
+
+    // Eigenvalue solver
+    EigenSolver<LocalMatrix<T>, LocalVector<T>, T>* es;
+
+    // Preconditioner
+    Preconditioner<LocalMatrix<T>, LocalVector<T>, T>* p = NULL;
+
+    if(solver == "LOBPCG")
+    {
+        LOBPCG<LocalMatrix<T>, LocalVector<T>, T>* lobpcg
+            = new LOBPCG<LocalMatrix<T>, LocalVector<T>, T>;
+
+        if(precond == "Jacobi")
+            p = new Jacobi<LocalMatrix<T>, LocalVector<T>, T>;
+        else if(precond == "MCSGS")
+            p = new MultiColoredSGS<LocalMatrix<T>, LocalVector<T>, T>;
+        else if(precond != "None")
+            return false;
+
+        if(p != NULL)
+        {
+            lobpcg->SetPreconditioner(*p);
+        }
+
+        es = lobpcg;
+    }
+    else if(solver == "Lanczos")
+        es = new Lanczos<LocalMatrix<T>, LocalVector<T>, T>;
+    else
+        return false;
+
+    es->Verbose(0);
+    es->SetOperator(A);
+    es->SetNumberOfEigenpairs(nev);
+    es->SetTarget(target);
+    es->Init(tol, 10000);
+    es->Build();
+
+    // Matrix format
+    A.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
+
+    es->Solve();
+
+    bool success = (es->GetNumberOfConvergedEigenpairs() == nev);
+
+    // The extreme eigenvalues of the 2D Laplacian are simple
+    double h      = std::sin(M_PI / (2.0 * (ndim + 1)));
+    double lambda = (target == EigenTarget_Smallest) ? 8.0 * h * h : 8.0 - 8.0 * h * h;
+
+    success &= (std::abs(static_cast<double>(es->GetEigenvalue(0)) - lambda)
+                <= 100.0 * tol * lambda);
+
+    // Verify the eigenpairs, r = Ax - lambda x
+    for(int i = 0; i < nev; ++i)
+    {
+        const LocalVector<T>& x = es->GetEigenvector(i);
+
+        A.Apply(x, &r);
+        r.AddScale(x, -es->GetEigenvalue(i));
+
+        double res = static_cast<double>(r.Norm());
+        double ref = std::abs(static_cast<double>(es->GetEigenvalue(i)));
+
+        success &= (res <= 10.0 * tol * ref);
+    }
+
+    // Clean up
+    es->Clear();
+    delete es;
+
+    if(p != NULL)
+    {
+        delete p;
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_EIGEN_SOLVER_HPP
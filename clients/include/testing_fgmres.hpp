@@ -141,6 +141,14 @@ bool testing_fgmres(Arguments argus)
 
     ls.Init(1e-6, 0.0, 1e+8, 10000);
     ls.SetBasisSize(basis);
+    ls.SetOrthogonalization(static_cast<OrthoAlg>(argus.ortho));
+    ls.SetReducedPrecisionBasis(argus.reducedbasis != 0);
+
+    if(argus.adaptive > 0)
+    {
+        ls.SetAdaptiveRestart(5, argus.adaptive);
+        ls.InitStagnation(100, 1.0);
+    }
 
     ls.Build();
 
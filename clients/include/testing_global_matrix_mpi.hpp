@@ -0,0 +1,1770 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#pragma once
+#ifndef TESTING_GLOBAL_MATRIX_MPI_HPP
+#define TESTING_GLOBAL_MATRIX_MPI_HPP
+
+#include "common.hpp"
+#include "utility.hpp"
+
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <map>
+#include <mpi.h>
+#include <rocalution/rocalution.hpp>
+#include <set>
+
+using namespace rocalution;
+
+// Distribute a copy of the (identical on all ranks) matrix lmat
+template <typename T>
+void distribute_matrix_copy(const LocalMatrix<T>& lmat, GlobalMatrix<T>* gmat, ParallelManager* pm)
+{
+    // The parallel manager keeps a pointer to the communicator
+    static MPI_Comm comm = MPI_COMM_WORLD;
+
+    LocalMatrix<T> tmp;
+    tmp.CopyFrom(lmat);
+    tmp.MoveToHost();
+    tmp.ConvertToCSR();
+
+    distribute_matrix(&comm, &tmp, gmat, pm);
+}
+
+// Test passes only if it passes on all ranks
+static inline bool global_success(bool success)
+{
+    int local  = success ? 1 : 0;
+    int global = 0;
+
+    MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+    return global == 1;
+}
+
+// Relative distance of the gathered global vector and a vector of global size
+template <typename T>
+double global_vector_error(const GlobalVector<T>& x, const LocalVector<T>& ref)
+{
+    LocalVector<T> gathered;
+    gathered.CloneBackend(ref);
+
+    x.Gather(&gathered);
+    gathered.AddScale(ref, static_cast<T>(-1));
+
+    return std::abs(gathered.Norm())
+           / std::max(static_cast<double>(std::abs(ref.Norm())), 1e-300);
+}
+
+// Relative distance of the gathered global vector and a vector of global size, whose
+// entry i is moved to perm[i] of the distributed permutation, given in the previous
+// distribution
+template <typename T>
+double global_permuted_vector_error(const GlobalVector<T>&      x,
+                                    const LocalVector<T>&       ref,
+                                    const LocalVector<int64_t>& perm)
+{
+    int num_procs;
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+    // Permutation of all rows, in the rank order of the previous distribution
+    int64_t              local_size = perm.GetSize();
+    std::vector<int64_t> local_perm(local_size);
+    std::vector<int64_t> size(num_procs);
+
+    perm.CopyToHostData(local_perm.data());
+
+    MPI_Allgather(&local_size, 1, MPI_INT64_T, size.data(), 1, MPI_INT64_T, MPI_COMM_WORLD);
+
+    std::vector<int> count(num_procs);
+    std::vector<int> offset(num_procs + 1, 0);
+
+    for(int n = 0; n < num_procs; ++n)
+    {
+        count[n]      = static_cast<int>(size[n]);
+        offset[n + 1] = offset[n] + count[n];
+    }
+
+    std::vector<int64_t> global_perm(offset[num_procs]);
+
+    MPI_Allgatherv(local_perm.data(),
+                   static_cast<int>(local_size),
+                   MPI_INT64_T,
+                   global_perm.data(),
+                   count.data(),
+                   offset.data(),
+                   MPI_INT64_T,
+                   MPI_COMM_WORLD);
+
+    LocalVector<T> lref;
+    LocalVector<T> permuted;
+
+    lref.CloneFrom(ref);
+    lref.MoveToHost();
+
+    permuted.Allocate("permuted", lref.GetSize());
+
+    for(int64_t i = 0; i < lref.GetSize(); ++i)
+    {
+        permuted[global_perm[i]] = lref[i];
+    }
+
+    return global_vector_error(x, permuted);
+}
+
+// Relative distance of the gathered global matrix and a matrix of global size, in terms of
+// their products with a vector
+template <typename T>
+double global_matrix_error(const GlobalMatrix<T>& mat, const LocalMatrix<T>& ref)
+{
+    LocalMatrix<T> gathered;
+    mat.Gather(&gathered);
+    gathered.MoveToHost();
+
+    LocalMatrix<T> lref;
+    lref.CloneFrom(ref);
+    lref.MoveToHost();
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+
+    x.Allocate("x", lref.GetN());
+    y.Allocate("y", lref.GetM());
+    z.Allocate("z", lref.GetM());
+
+    for(int64_t i = 0; i < x.GetSize(); ++i)
+    {
+        x[i] = static_cast<T>(1) / static_cast<T>(3 + i % 7);
+    }
+
+    gathered.Apply(x, &y);
+    lref.Apply(x, &z);
+
+    y.AddScale(z, static_cast<T>(-1));
+
+    return std::abs(y.Norm()) / std::max(static_cast<double>(std::abs(z.Norm())), 1e-300);
+}
+
+// Square matrix with a symmetric sparsity pattern that couples rows far apart, such that
+// each rank has several neighbors, and non-symmetric values
+template <typename T>
+void generate_coupled_matrix(int nrow, LocalMatrix<T>* mat)
+{
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    allocate_host(nrow + 1, &csr_ptr);
+    allocate_host(3 * nrow, &csr_col);
+    allocate_host(3 * nrow, &csr_val);
+
+    csr_ptr[0] = 0;
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        std::set<int> cols = {i, (7 * i + 1) % nrow, (13 * i + 5) % nrow};
+
+        int idx = csr_ptr[i];
+        for(int c : cols)
+        {
+            csr_col[idx] = c;
+            csr_val[idx] = (c == i) ? static_cast<T>(4)
+                                    : static_cast<T>(-1) / static_cast<T>(1 + (i + c) % 5);
+            ++idx;
+        }
+
+        csr_ptr[i + 1] = idx;
+    }
+
+    LocalMatrix<T> G;
+    LocalMatrix<T> Gt;
+
+    G.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "G", csr_ptr[nrow], nrow, nrow);
+    G.Transpose(&Gt);
+
+    // Symmetric pattern, non-symmetric values
+    mat->MatrixAdd(G, static_cast<T>(1), Gt, static_cast<T>(0.5));
+}
+
+template <typename T>
+bool testing_global_matrix_reduced_halo(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> lA;
+    lA.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix_copy(lA, &A, &pm);
+
+    // Values that are not representable in single precision
+    LocalVector<T> lx;
+    LocalVector<T> ref;
+
+    lx.Allocate("x", nrow);
+    ref.Allocate("ref", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        lx[i] = static_cast<T>(1) / static_cast<T>(3 + i % 7);
+    }
+
+    lA.Apply(lx, &ref);
+
+    bool success = true;
+
+    for(int acc = 0; acc < 2; ++acc)
+    {
+        if(acc == 1)
+        {
+            A.MoveToAccelerator();
+            lx.MoveToAccelerator();
+            ref.MoveToAccelerator();
+        }
+
+        GlobalVector<T> x(pm);
+        GlobalVector<T> y_full(pm);
+        GlobalVector<T> y_reduced(pm);
+        GlobalVector<T> y(pm);
+
+        x.CloneBackend(A);
+        y_full.CloneBackend(A);
+        y_reduced.CloneBackend(A);
+        y.CloneBackend(A);
+
+        x.Allocate("x", nrow);
+        y_full.Allocate("y full", nrow);
+        y_reduced.Allocate("y reduced", nrow);
+        y.Allocate("y", nrow);
+
+        x.Scatter(lx);
+
+        // Full precision reference
+        A.SetReducedPrecisionHalo(false);
+        A.Apply(x, &y_full);
+        success &= (global_vector_error(y_full, ref) <= 1e-14);
+
+        // Single precision halo, the error is in the order of the float round-off
+        A.SetReducedPrecisionHalo(true);
+        A.Apply(x, &y_reduced);
+        success &= (global_vector_error(y_reduced, ref) <= 1e-6);
+
+        // Toggling back has to restore the exact full precision product
+        A.SetReducedPrecisionHalo(false);
+        A.Apply(x, &y);
+        y.AddScale(y_full, static_cast<T>(-1));
+        success &= (std::abs(y.Norm()) == 0.0);
+
+        // And toggling again the exact reduced precision product
+        A.SetReducedPrecisionHalo(true);
+        A.Apply(x, &y);
+        y.AddScale(y_reduced, static_cast<T>(-1));
+        success &= (std::abs(y.Norm()) == 0.0);
+
+        A.SetReducedPrecisionHalo(false);
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_matrix_mult(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // A is a Laplacian with non-symmetric values, B couples rows far apart
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        for(int j = csr_ptr[i]; j < csr_ptr[i + 1]; ++j)
+        {
+            csr_val[j] *= static_cast<T>(1) + static_cast<T>(i % 5) / static_cast<T>(10);
+        }
+    }
+
+    LocalMatrix<T> lA;
+    LocalMatrix<T> lB;
+    LocalMatrix<T> lP;
+    LocalMatrix<T> lR;
+
+    lA.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+    generate_coupled_matrix(nrow, &lB);
+
+    // Prolongation with the pattern of B and its transpose as restriction
+    lP.CloneFrom(lB);
+    lP.Transpose(&lR);
+
+    bool success = true;
+
+    for(int acc = 0; acc < 2; ++acc)
+    {
+        ParallelManager pm_A;
+        ParallelManager pm_B;
+        ParallelManager pm_P;
+        ParallelManager pm_R;
+
+        GlobalMatrix<T> A;
+        GlobalMatrix<T> B;
+        GlobalMatrix<T> P;
+        GlobalMatrix<T> R;
+
+        distribute_matrix_copy(lA, &A, &pm_A);
+        distribute_matrix_copy(lB, &B, &pm_B);
+        distribute_matrix_copy(lP, &P, &pm_P);
+        distribute_matrix_copy(lR, &R, &pm_R);
+
+        if(acc == 1)
+        {
+            A.MoveToAccelerator();
+            B.MoveToAccelerator();
+            P.MoveToAccelerator();
+            R.MoveToAccelerator();
+        }
+
+        // C = A * B
+        GlobalMatrix<T> C;
+        C.CloneBackend(A);
+        C.MatrixMult(A, B);
+
+        LocalMatrix<T> lC;
+        lC.MatrixMult(lA, lB);
+
+        success &= (global_matrix_error(C, lC) <= 1e-5);
+
+        // Matrices with the patterns of A and B, but different values
+        LocalMatrix<T> lA2;
+        LocalMatrix<T> lB2;
+
+        lA2.CloneFrom(lA);
+        lB2.CloneFrom(lB);
+        lA2.ScaleDiagonal(static_cast<T>(3));
+        lB2.ScaleOffDiagonal(static_cast<T>(0.5));
+
+        ParallelManager pm_A2;
+        ParallelManager pm_B2;
+
+        GlobalMatrix<T> A2;
+        GlobalMatrix<T> B2;
+
+        distribute_matrix_copy(lA2, &A2, &pm_A2);
+        distribute_matrix_copy(lB2, &B2, &pm_B2);
+
+        // CloneBackend() would also take over the parallel manager of A
+        if(acc == 1)
+        {
+            A2.MoveToAccelerator();
+            B2.MoveToAccelerator();
+        }
+
+        // Recompute the values of C, the structure is reused
+        C.MatrixMultNumeric(A2, B2);
+        lC.MatrixMult(lA2, lB2);
+
+        success &= (global_matrix_error(C, lC) <= 1e-5);
+
+        // D = 2 * A + 0.5 * B
+        GlobalMatrix<T> D;
+        D.CloneBackend(A);
+        D.MatrixAdd(A2, static_cast<T>(2), B2, static_cast<T>(0.5));
+
+        LocalMatrix<T> lD;
+        lD.MatrixAdd(lA2, static_cast<T>(2), lB2, static_cast<T>(0.5));
+
+        success &= (global_matrix_error(D, lD) <= 1e-5);
+
+        // E = R * A * P
+        GlobalMatrix<T> E;
+        E.CloneBackend(A);
+        E.TripleMatrixProduct(R, A2, P);
+
+        LocalMatrix<T> lE;
+        lE.TripleMatrixProduct(lR, lA2, lP);
+
+        success &= (global_matrix_error(E, lE) <= 1e-5);
+
+        // The structure of the product moves along with it
+        C.MoveToHost();
+        A2.MoveToHost();
+        B2.MoveToHost();
+        C.MatrixMultNumeric(A2, B2);
+
+        success &= (global_matrix_error(C, lC) <= 1e-5);
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_schur_ilu(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> lA;
+    lA.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix_copy(lA, &A, &pm);
+
+    LocalVector<T> lb;
+    lb.Allocate("b", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        lb[i] = static_cast<T>(1) / static_cast<T>(3 + i % 7);
+    }
+
+    const double tol = std::is_same<T, float>::value ? 1e-4 : 1e-10;
+
+    bool success = true;
+
+    for(int acc = 0; acc < 2; ++acc)
+    {
+        if(acc == 1)
+        {
+            A.MoveToAccelerator();
+            lb.MoveToAccelerator();
+        }
+
+        GlobalVector<T> b(pm);
+        GlobalVector<T> x(pm);
+        GlobalVector<T> y(pm);
+
+        b.CloneBackend(A);
+        x.CloneBackend(A);
+        y.CloneBackend(A);
+
+        b.Allocate("b", nrow);
+        x.Allocate("x", nrow);
+        y.Allocate("y", nrow);
+
+        b.Scatter(lb);
+
+        // Without interface iterations, SchurILU is a Block-Jacobi preconditioner. With
+        // unlimited fill-in, both solve the interior systems exactly, independent of the
+        // ordering of the interface unknowns
+        SchurILU<GlobalMatrix<T>, GlobalVector<T>, T> schur;
+        schur.Set(nrow);
+        schur.SetInterfaceIterations(0);
+        schur.SetOperator(A);
+        schur.Build();
+        schur.Solve(b, &x);
+
+        ILU<LocalMatrix<T>, LocalVector<T>, T>           ilu;
+        BlockJacobi<GlobalMatrix<T>, GlobalVector<T>, T> bj;
+        ilu.Set(nrow);
+        bj.Set(ilu);
+        bj.SetOperator(A);
+        bj.Build();
+        bj.Solve(b, &y);
+
+        y.AddScale(x, static_cast<T>(-1));
+        success &= (std::abs(y.Norm()) <= tol * std::abs(x.Norm()));
+
+        schur.Clear();
+        bj.Clear();
+
+        // The interface iterations restore the coupling between the processes
+        int iter[3];
+
+        for(int k = 0; k < 3; ++k)
+        {
+            SchurILU<GlobalMatrix<T>, GlobalVector<T>, T> p;
+            BiCGStab<GlobalMatrix<T>, GlobalVector<T>, T> ls;
+
+            p.Set(0);
+            p.SetInterfaceIterations(k);
+
+            ls.Verbose(0);
+            ls.SetOperator(A);
+            ls.SetPreconditioner(p);
+            ls.Init(1e-8, 0.0, 1e+8, 1000);
+            ls.Build();
+
+            x.Zeros();
+            ls.Solve(b, &x);
+
+            iter[k] = ls.GetIterationCount();
+
+            // r = b - Ax
+            A.Apply(x, &y);
+            y.ScaleAdd(static_cast<T>(-1), b);
+
+            // Absolute tolerance reached
+            success &= (ls.GetSolverStatus() == 1);
+            success &= (std::abs(y.Norm()) <= 1e-4 * std::abs(b.Norm()));
+
+            ls.Clear();
+        }
+
+        success &= (iter[1] <= iter[0] && iter[2] <= iter[0]);
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_matrix_overlap(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int num_procs;
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+    LocalMatrix<T> lA;
+    generate_coupled_matrix(size, &lA);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix_copy(lA, &A, &pm);
+
+    // Reference entries with global indices
+    LocalMatrix<T> ref;
+    ref.CloneFrom(lA);
+    ref.MoveToHost();
+    ref.ConvertToCSR();
+
+    PtrType* ref_ptr = NULL;
+    int*     ref_col = NULL;
+    T*       ref_val = NULL;
+
+    ref.LeaveDataPtrCSR(&ref_ptr, &ref_col, &ref_val);
+
+    bool success = true;
+
+    for(int acc = 0; acc < 2; ++acc)
+    {
+        if(acc == 1)
+        {
+            A.MoveToAccelerator();
+        }
+
+        LocalMatrix<T> O;
+        A.ExtractOverlapMatrix(&O);
+        O.MoveToHost();
+
+        // A single process has no communication pattern
+        int64_t local_nrow = pm.GetLocalNrow();
+        int64_t row_begin  = (num_procs > 1) ? pm.GetGlobalRowBegin() : 0;
+        int     nghost     = (num_procs > 1) ? pm.GetNumReceivers() : 0;
+
+        const int64_t* ghost_map = (num_procs > 1) ? pm.GetGhostToGlobalMap() : NULL;
+
+        success &= (O.GetM() == local_nrow + nghost);
+        success &= (O.GetN() == local_nrow + nghost);
+
+        // Global index of each unknown of the overlapping subdomain
+        std::vector<int64_t>   global(local_nrow + nghost);
+        std::map<int64_t, int> local;
+
+        for(int64_t i = 0; i < local_nrow + nghost; ++i)
+        {
+            global[i] = (i < local_nrow) ? row_begin + i : ghost_map[i - local_nrow];
+            local[global[i]] = static_cast<int>(i);
+        }
+
+        PtrType* ptr = NULL;
+        int*     col = NULL;
+        T*       val = NULL;
+
+        int64_t m   = O.GetM();
+        int64_t n   = O.GetN();
+        int64_t nnz = O.GetNnz();
+
+        O.LeaveDataPtrCSR(&ptr, &col, &val);
+
+        // Each row holds exactly the entries of the global row, whose columns are part
+        // of the overlapping subdomain
+        for(int64_t i = 0; i < m && success == true; ++i)
+        {
+            std::map<int, T> expected;
+
+            for(PtrType j = ref_ptr[global[i]]; j < ref_ptr[global[i] + 1]; ++j)
+            {
+                auto it = local.find(ref_col[j]);
+
+                if(it != local.end())
+                {
+                    expected[it->second] = ref_val[j];
+                }
+            }
+
+            success &= (ptr[i + 1] - ptr[i] == static_cast<PtrType>(expected.size()));
+
+            for(PtrType j = ptr[i]; j < ptr[i + 1]; ++j)
+            {
+                auto it = expected.find(col[j]);
+
+                success &= (it != expected.end() && it->second == val[j]);
+            }
+        }
+
+        O.SetDataPtrCSR(&ptr, &col, &val, "O", nnz, m, n);
+    }
+
+    free_host(&ref_ptr);
+    free_host(&ref_col);
+    free_host(&ref_val);
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_ras(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    LocalMatrix<T> lA;
+    generate_coupled_matrix(size, &lA);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix_copy(lA, &A, &pm);
+
+    int nrow = static_cast<int>(lA.GetM());
+
+    LocalVector<T> lb;
+    lb.Allocate("b", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        lb[i] = static_cast<T>(1) / static_cast<T>(3 + i % 7);
+    }
+
+    bool success = true;
+
+    for(int acc = 0; acc < 2; ++acc)
+    {
+        if(acc == 1)
+        {
+            A.MoveToAccelerator();
+            lb.MoveToAccelerator();
+        }
+
+        GlobalVector<T> b(pm);
+        GlobalVector<T> x(pm);
+        GlobalVector<T> r(pm);
+
+        b.CloneBackend(A);
+        x.CloneBackend(A);
+        r.CloneBackend(A);
+
+        b.Allocate("b", nrow);
+        x.Allocate("x", nrow);
+        r.Allocate("r", nrow);
+
+        b.Scatter(lb);
+
+        // The overlap makes RAS at least as strong as Block-Jacobi with the same local
+        // preconditioner
+        int iter[2];
+
+        for(int k = 0; k < 2; ++k)
+        {
+            ILU<LocalMatrix<T>, LocalVector<T>, T>           ilu;
+            GlobalRAS<GlobalMatrix<T>, GlobalVector<T>, T>   ras;
+            BlockJacobi<GlobalMatrix<T>, GlobalVector<T>, T> bj;
+            BiCGStab<GlobalMatrix<T>, GlobalVector<T>, T>    ls;
+
+            ls.Verbose(0);
+            ls.SetOperator(A);
+
+            if(k == 0)
+            {
+                bj.Set(ilu);
+                ls.SetPreconditioner(bj);
+            }
+            else
+            {
+                ras.Set(ilu);
+                ls.SetPreconditioner(ras);
+            }
+
+            ls.Init(1e-8, 0.0, 1e+8, 1000);
+            ls.Build();
+
+            x.Zeros();
+            ls.Solve(b, &x);
+
+            iter[k] = ls.GetIterationCount();
+
+            // r = b - Ax
+            A.Apply(x, &r);
+            r.ScaleAdd(static_cast<T>(-1), b);
+
+            // Absolute tolerance reached
+            success &= (ls.GetSolverStatus() == 1);
+            success &= (std::abs(r.Norm()) <= 1e-4 * std::abs(b.Norm()));
+
+            ls.Clear();
+        }
+
+        success &= (iter[1] <= iter[0]);
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_matrix_assemble_coo(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int rank;
+    int num_procs;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+    LocalMatrix<T> lA;
+    generate_coupled_matrix(size, &lA);
+
+    // Reference distribution
+    ParallelManager pm_ref;
+    GlobalMatrix<T> A_ref;
+
+    distribute_matrix_copy(lA, &A_ref, &pm_ref);
+
+    // Global triplets
+    LocalMatrix<T> coo;
+    coo.CloneFrom(lA);
+    coo.MoveToHost();
+    coo.ConvertToCOO();
+
+    int64_t nrow = coo.GetM();
+    int64_t ncol = coo.GetN();
+    int64_t nnz  = coo.GetNnz();
+
+    int* coo_row = NULL;
+    int* coo_col = NULL;
+    T*   coo_val = NULL;
+
+    coo.LeaveDataPtrCOO(&coo_row, &coo_col, &coo_val);
+
+    // Each entry is split into two contributions, handed to different ranks in a
+    // round-robin fashion, such that most of them belong to rows of other ranks and
+    // have to be summed up by their owner. On a single rank, both are duplicates on the
+    // same rank
+    std::vector<int64_t> row;
+    std::vector<int64_t> col;
+    std::vector<T>       val;
+
+    for(int64_t k = 0; k < nnz; ++k)
+    {
+        if(k % num_procs == rank)
+        {
+            row.push_back(coo_row[k]);
+            col.push_back(coo_col[k]);
+            val.push_back(static_cast<T>(0.25) * coo_val[k]);
+        }
+
+        if((k + 1) % num_procs == rank)
+        {
+            row.push_back(coo_row[k]);
+            col.push_back(coo_col[k]);
+            val.push_back(static_cast<T>(0.75) * coo_val[k]);
+        }
+    }
+
+    free_host(&coo_row);
+    free_host(&coo_col);
+    free_host(&coo_val);
+
+    // The parallel manager keeps a pointer to the communicator
+    static MPI_Comm comm = MPI_COMM_WORLD;
+
+    ParallelManager pm;
+    pm.SetMPICommunicator(&comm);
+
+    GlobalMatrix<T> A;
+    A.AssembleCOO(row.size(), row.data(), col.data(), val.data(), nrow, ncol, &pm);
+
+    const double tol = std::is_same<T, float>::value ? 1e-5 : 1e-10;
+
+    bool success = true;
+
+    // Same row partitioning and number of non-zeros as the distributed CSR matrix
+    success &= (pm.GetGlobalNrow() == nrow);
+    success &= (pm.GetGlobalNcol() == ncol);
+    success &= (pm.GetLocalNrow() == pm_ref.GetLocalNrow());
+    success &= (A.GetLocalNnz() == A_ref.GetLocalNnz());
+    success &= (A.GetGhostNnz() == A_ref.GetGhostNnz());
+    success &= (global_matrix_error(A, lA) <= tol);
+
+    // A single process has no communication pattern
+    if(num_procs > 1)
+    {
+        success &= (pm.GetGlobalRowBegin() == pm_ref.GetGlobalRowBegin());
+    }
+
+    // The generated communication pattern is usable
+    GlobalVector<T> x(pm);
+    GlobalVector<T> y(pm);
+    LocalVector<T>  lx;
+    LocalVector<T>  ly;
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    lx.Allocate("lx", nrow);
+    ly.Allocate("ly", nrow);
+
+    for(int64_t i = 0; i < nrow; ++i)
+    {
+        lx[i] = static_cast<T>(1) / static_cast<T>(2 + i % 5);
+    }
+
+    x.Scatter(lx);
+    A.Apply(x, &y);
+    lA.Apply(lx, &ly);
+
+    success &= (global_vector_error(y, ly) <= tol);
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_matrix_file_io(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    LocalMatrix<T> lA;
+    generate_coupled_matrix(size, &lA);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix_copy(lA, &A, &pm);
+
+    int64_t nrow = lA.GetM();
+
+    LocalVector<T> lx;
+    lx.Allocate("x", nrow);
+
+    for(int64_t i = 0; i < nrow; ++i)
+    {
+        lx[i] = static_cast<T>(1) / static_cast<T>(3 + i % 7);
+    }
+
+    const std::string mat_file = "rocalution_distributed_matrix_test.csr";
+    const std::string vec_file = "rocalution_distributed_vector_test.bin";
+
+    const double tol = std::is_same<T, float>::value ? 1e-5 : 1e-10;
+
+    bool success = true;
+
+    // Write the matrix from all ranks into one file
+    A.WriteFileDistributedCSR(mat_file);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // The file holds the complete matrix in the format of the serial reader
+    LocalMatrix<T> B;
+    B.ReadFileCSR(mat_file);
+
+    success &= (B.GetM() == lA.GetM());
+    success &= (B.GetN() == lA.GetN());
+    success &= (B.GetNnz() == lA.GetNnz());
+
+    LocalVector<T> y;
+    LocalVector<T> z;
+
+    y.Allocate("y", nrow);
+    z.Allocate("z", nrow);
+
+    B.Apply(lx, &y);
+    lA.Apply(lx, &z);
+    y.AddScale(z, static_cast<T>(-1));
+
+    success &= (std::abs(y.Norm()) <= tol * std::abs(z.Norm()));
+
+    // Read it back distributed
+    static MPI_Comm comm = MPI_COMM_WORLD;
+
+    ParallelManager pm2;
+    pm2.SetMPICommunicator(&comm);
+
+    GlobalMatrix<T> A2;
+    A2.ReadFileDistributedCSR(mat_file, &pm2);
+
+    success &= (global_matrix_error(A2, lA) <= tol);
+
+    // Write a vector from all ranks into one file
+    GlobalVector<T> x(pm2);
+    x.Allocate("x", nrow);
+    x.Scatter(lx);
+
+    x.WriteFileDistributedBinary(vec_file);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // The file holds the complete vector in the format of the serial reader
+    LocalVector<T> ly;
+    ly.ReadFileBinary(vec_file);
+
+    success &= (ly.GetSize() == nrow);
+
+    if(ly.GetSize() == nrow)
+    {
+        ly.AddScale(lx, static_cast<T>(-1));
+        success &= (std::abs(ly.Norm()) == static_cast<T>(0));
+    }
+
+    // Read it back distributed
+    GlobalVector<T> x2(pm2);
+    x2.ReadFileDistributedBinary(vec_file);
+
+    success &= (global_vector_error(x2, lx) == 0.0);
+
+    // All ranks are done with the files
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    if(rank == 0)
+    {
+        std::remove(mat_file.c_str());
+        std::remove(vec_file.c_str());
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_vector_expression(Arguments argus)
+{
+    int size = argus.size;
+
+    T a = static_cast<T>(2);
+    T b = static_cast<T>(-3);
+    T c = static_cast<T>(0.5);
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // The matrix only provides the row distribution
+    LocalMatrix<T> lA;
+    generate_coupled_matrix(size, &lA);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix_copy(lA, &A, &pm);
+
+    int64_t nrow = lA.GetM();
+
+    LocalVector<T> ly;
+    LocalVector<T> lz;
+    LocalVector<T> lw;
+
+    ly.Allocate("y", nrow);
+    lz.Allocate("z", nrow);
+    lw.Allocate("w", nrow);
+
+    for(int64_t i = 0; i < nrow; ++i)
+    {
+        ly[i] = static_cast<T>(1 + i % 7);
+        lz[i] = static_cast<T>(1 + i % 5);
+        lw[i] = static_cast<T>(1 + i % 3);
+    }
+
+    // Reference of the complete vectors
+    LocalVector<T> ref;
+    ref.Allocate("ref", nrow);
+    ref = a * ly + b * lz - c * lw;
+
+    T dot  = Sum(ref * ly);
+    T norm = ref.Norm();
+
+    const double tol = std::is_same<T, float>::value ? 1e-5 : 1e-12;
+
+    bool success = true;
+
+    for(int acc = 0; acc < 2; ++acc)
+    {
+        if(acc == 1)
+        {
+            A.MoveToAccelerator();
+            ly.MoveToAccelerator();
+            lz.MoveToAccelerator();
+            lw.MoveToAccelerator();
+            ref.MoveToAccelerator();
+        }
+
+        GlobalVector<T> x(pm);
+        GlobalVector<T> y(pm);
+        GlobalVector<T> z(pm);
+        GlobalVector<T> w(pm);
+
+        x.CloneBackend(A);
+        y.CloneBackend(A);
+        z.CloneBackend(A);
+        w.CloneBackend(A);
+
+        x.Allocate("x", nrow);
+        y.Allocate("y", nrow);
+        z.Allocate("z", nrow);
+        w.Allocate("w", nrow);
+
+        y.Scatter(ly);
+        z.Scatter(lz);
+        w.Scatter(lw);
+
+        // Evaluated on the interior of each process
+        x = a * y + b * z - c * w;
+        x = x - static_cast<T>(2) * y + y + y;
+
+        success &= (global_vector_error(x, ref) <= tol);
+
+        // The sums are reduced over all processes
+        T sum_xy = Sum(x * y);
+        T sum_xx = Sum(-x * -x);
+
+        success &= (std::abs(sum_xy - dot) <= tol * std::abs(dot));
+        success &= (std::abs(sum_xx - norm * norm) <= tol * std::abs(norm * norm));
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_amg_redundant(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> lA;
+    lA.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix_copy(lA, &A, &pm);
+
+    GlobalVector<T> b(pm);
+    GlobalVector<T> x(pm);
+    GlobalVector<T> r(pm);
+
+    b.Allocate("b", nrow);
+    x.Allocate("x", nrow);
+    r.Allocate("r", nrow);
+
+    b.Ones();
+
+    const double tol = std::is_same<T, float>::value ? 1e-4 : 1e-10;
+
+    bool success = true;
+
+    // Redundant with LU solves exactly, CG converges in a single iteration
+    {
+        LU<LocalMatrix<T>, LocalVector<T>, T>          lu;
+        Redundant<GlobalMatrix<T>, GlobalVector<T>, T> p;
+        CG<GlobalMatrix<T>, GlobalVector<T>, T>        ls;
+
+        lu.Verbose(0);
+        p.Set(lu);
+
+        ls.Verbose(0);
+        ls.SetOperator(A);
+        ls.SetPreconditioner(p);
+        ls.Init(0.0, tol, 1e+8, 10);
+        ls.Build();
+
+        x.Zeros();
+        ls.Solve(b, &x);
+
+        success &= (ls.GetIterationCount() <= 1);
+
+        ls.Clear();
+    }
+
+    // Redundant as coarse grid solver of a distributed AMG hierarchy, with and without
+    // aggressive coarsening of the first level
+    for(int aggressive = 0; aggressive < 2; ++aggressive)
+    {
+        int iter[2];
+
+        for(int k = 0; k < 2; ++k)
+        {
+            LU<LocalMatrix<T>, LocalVector<T>, T>          lu;
+            Redundant<GlobalMatrix<T>, GlobalVector<T>, T> cgs;
+            SAAMG<GlobalMatrix<T>, GlobalVector<T>, T>     p;
+            CG<GlobalMatrix<T>, GlobalVector<T>, T>        ls;
+
+            p.SetCoarseningStrategy(CoarseningStrategy::PMIS);
+            p.SetCoarsestLevel(50);
+            p.SetAggressiveCoarsening(aggressive == 1);
+            p.Verbose(0);
+
+            if(k == 0)
+            {
+                // Passed by the user
+                lu.Verbose(0);
+                cgs.Set(lu);
+                cgs.Verbose(0);
+
+                p.SetManualSolver(true);
+                p.SetOperator(A);
+                p.BuildHierarchy();
+                p.SetSolver(cgs);
+            }
+            else
+            {
+                // Built by the hierarchy
+                p.SetDefaultCoarseSolver(DirectCoarseSolver);
+            }
+
+            ls.Verbose(0);
+            ls.SetOperator(A);
+            ls.SetPreconditioner(p);
+            ls.Init(1e-8, 0.0, 1e+8, 1000);
+            ls.Build();
+
+            x.Zeros();
+            ls.Solve(b, &x);
+
+            iter[k] = ls.GetIterationCount();
+
+            // r = b - Ax
+            A.Apply(x, &r);
+            r.ScaleAdd(static_cast<T>(-1), b);
+
+            success &= (ls.GetSolverStatus() == 1);
+            success &= (std::abs(r.Norm()) <= 1e-4 * std::abs(b.Norm()));
+
+            ls.Clear();
+        }
+
+        // Both coarse grid solvers factorize the same coarsest operator
+        success &= (std::abs(iter[0] - iter[1]) <= 1);
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_matrix_progress_thread(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    LocalMatrix<T> lA;
+    generate_coupled_matrix(size, &lA);
+
+    int64_t nrow = lA.GetM();
+
+    LocalVector<T> lx;
+    lx.Allocate("x", nrow);
+
+    bool success = true;
+
+    for(int acc = 0; acc < 2; ++acc)
+    {
+        // Reference without progress thread
+        ParallelManager pm_ref;
+        GlobalMatrix<T> A_ref;
+
+        distribute_matrix_copy(lA, &A_ref, &pm_ref);
+
+        GlobalVector<T> x_ref(pm_ref);
+        GlobalVector<T> y_ref(pm_ref);
+
+        if(acc == 1)
+        {
+            A_ref.MoveToAccelerator();
+            x_ref.MoveToAccelerator();
+            y_ref.MoveToAccelerator();
+            lx.MoveToAccelerator();
+        }
+
+        x_ref.Allocate("x", nrow);
+        y_ref.Allocate("y", nrow);
+
+        // The parallel manager, and with it the thread, is destroyed at the end of the
+        // scope while the thread is enabled
+        {
+            ParallelManager pm;
+            GlobalMatrix<T> A;
+
+            distribute_matrix_copy(lA, &A, &pm);
+
+            // Without MPI_THREAD_MULTIPLE, no thread is started. Enabling it twice keeps
+            // the thread
+            pm.SetProgressThread(true);
+            pm.SetProgressThread(true);
+
+            GlobalVector<T> x(pm);
+            GlobalVector<T> y(pm);
+
+            if(acc == 1)
+            {
+                A.MoveToAccelerator();
+                x.MoveToAccelerator();
+                y.MoveToAccelerator();
+            }
+
+            x.Allocate("x", nrow);
+            y.Allocate("y", nrow);
+
+            LocalVector<T> ly;
+            ly.CloneBackend(lx);
+            ly.Allocate("y", nrow);
+
+            // Several exchanges start and stop the polling of the same thread, the thread
+            // is also stopped and restarted in between
+            for(int k = 0; k < 8; ++k)
+            {
+                if(k == 4)
+                {
+                    pm.SetProgressThread(false);
+                    pm.SetProgressThread(true);
+                }
+
+                lx.MoveToHost();
+
+                for(int64_t i = 0; i < nrow; ++i)
+                {
+                    lx[i] = static_cast<T>(1) / static_cast<T>(2 + (i + k) % 7);
+                }
+
+                if(acc == 1)
+                {
+                    lx.MoveToAccelerator();
+                }
+
+                x_ref.Scatter(lx);
+                x.Scatter(lx);
+
+                A_ref.Apply(x_ref, &y_ref);
+                A.Apply(x, &y);
+
+                // Same arithmetic, the products agree exactly
+                y_ref.Gather(&ly);
+                success &= (global_vector_error(y, ly) == 0.0);
+            }
+        }
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+// Distribute lmat into pm and mat in the given way, 0 and 1 with a copy of the complete
+// matrix on all ranks, 2 assembled from triplets spread round-robin over the ranks
+template <typename T>
+void distribute_matrix_phase(int                   phase,
+                             const LocalMatrix<T>& lmat,
+                             GlobalMatrix<T>*      mat,
+                             ParallelManager*      pm)
+{
+    if(phase < 2)
+    {
+        distribute_matrix_copy(lmat, mat, pm);
+        return;
+    }
+
+    int rank;
+    int num_procs;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+    LocalMatrix<T> coo;
+    coo.CloneFrom(lmat);
+    coo.MoveToHost();
+    coo.ConvertToCOO();
+
+    int* coo_row = NULL;
+    int* coo_col = NULL;
+    T*   coo_val = NULL;
+
+    int64_t nrow = coo.GetM();
+    int64_t ncol = coo.GetN();
+    int64_t nnz  = coo.GetNnz();
+
+    coo.LeaveDataPtrCOO(&coo_row, &coo_col, &coo_val);
+
+    std::vector<int64_t> row;
+    std::vector<int64_t> col;
+    std::vector<T>       val;
+
+    for(int64_t k = 0; k < nnz; ++k)
+    {
+        if(k % num_procs == rank)
+        {
+            row.push_back(coo_row[k]);
+            col.push_back(coo_col[k]);
+            val.push_back(coo_val[k]);
+        }
+    }
+
+    free_host(&coo_row);
+    free_host(&coo_col);
+    free_host(&coo_val);
+
+    // The parallel manager keeps a pointer to the communicator
+    static MPI_Comm comm = MPI_COMM_WORLD;
+
+    // AssembleCOO() clears the previous pattern of the parallel manager
+    pm->SetMPICommunicator(&comm);
+    mat->AssembleCOO(row.size(), row.data(), col.data(), val.data(), nrow, ncol, pm);
+}
+
+template <typename T>
+bool testing_global_matrix_neighbor_collectives(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Three operators with different communication patterns, a coupled matrix with
+    // several neighbors per rank, a 2D Laplacian with the adjacent ranks as neighbors
+    // only and a coupled matrix of a different size
+    LocalMatrix<T> lA[3];
+
+    generate_coupled_matrix(size, &lA[0]);
+    generate_coupled_matrix(size + 13, &lA[2]);
+
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(10, &csr_ptr, &csr_col, &csr_val);
+    lA[1].SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", csr_ptr[nrow], nrow, nrow);
+
+    bool success = true;
+
+    for(int acc = 0; acc < 2; ++acc)
+    {
+        // The same parallel manager is used for all operators, its graph communicator
+        // has to be rebuilt whenever the pattern changes
+        ParallelManager pm;
+        pm.SetNeighborCollectives(true);
+
+        for(int phase = 0; phase < 3; ++phase)
+        {
+            if(phase == 1)
+            {
+                pm.Clear();
+            }
+
+            int64_t n = lA[phase].GetM();
+
+            // Reference with point-to-point messages
+            ParallelManager pm_ref;
+            GlobalMatrix<T> A_ref;
+            GlobalMatrix<T> A;
+
+            distribute_matrix_phase(phase, lA[phase], &A_ref, &pm_ref);
+            distribute_matrix_phase(phase, lA[phase], &A, &pm);
+
+            GlobalVector<T> x_ref(pm_ref);
+            GlobalVector<T> y_ref(pm_ref);
+            GlobalVector<T> x(pm);
+            GlobalVector<T> y(pm);
+
+            LocalVector<T> lx;
+            LocalVector<T> ly;
+
+            if(acc == 1)
+            {
+                A_ref.MoveToAccelerator();
+                A.MoveToAccelerator();
+                x_ref.MoveToAccelerator();
+                y_ref.MoveToAccelerator();
+                x.MoveToAccelerator();
+                y.MoveToAccelerator();
+                ly.MoveToAccelerator();
+            }
+
+            x_ref.Allocate("x", n);
+            y_ref.Allocate("y", n);
+            x.Allocate("x", n);
+            y.Allocate("y", n);
+            lx.Allocate("x", n);
+            ly.Allocate("y", n);
+
+            // Repeated exchanges reuse the graph communicator
+            for(int k = 0; k < 3; ++k)
+            {
+                lx.MoveToHost();
+
+                for(int64_t i = 0; i < n; ++i)
+                {
+                    lx[i] = static_cast<T>(1) / static_cast<T>(2 + (i + k) % 7);
+                }
+
+                if(acc == 1)
+                {
+                    lx.MoveToAccelerator();
+                }
+
+                x_ref.Scatter(lx);
+                x.Scatter(lx);
+
+                A_ref.Apply(x_ref, &y_ref);
+                A.Apply(x, &y);
+
+                // Same arithmetic, the products agree exactly
+                y_ref.Gather(&ly);
+                success &= (global_vector_error(y, ly) == 0.0);
+            }
+        }
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_matrix_reorder_boundary_first(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // A 2D Laplacian, whose boundary rows are sent to a single neighbor each, such that
+    // the send buffers become slices of the input vector, and a coupled matrix, whose
+    // rows are sent to several, differently overlapping sets of neighbors. From four
+    // ranks on, these sets cannot be ordered such that the rows of each neighbor are
+    // contiguous, and the send buffer has to be packed
+    LocalMatrix<T> lA[2];
+
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    lA[0].SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", csr_ptr[nrow], nrow, nrow);
+
+    generate_coupled_matrix(size * size, &lA[1]);
+
+    // The parallel manager keeps a pointer to the communicator
+    static MPI_Comm comm = MPI_COMM_WORLD;
+
+    const double tol = std::is_same<T, float>::value ? 1e-5 : 1e-12;
+
+    bool success = true;
+
+    for(int acc = 0; acc < 2; ++acc)
+    {
+        for(int m = 0; m < 2; ++m)
+        {
+            int64_t n = lA[m].GetM();
+
+            ParallelManager pm;
+            GlobalMatrix<T> A;
+
+            distribute_matrix_copy(lA[m], &A, &pm);
+
+            GlobalVector<T> x(pm);
+            GlobalVector<T> y_ref(pm);
+
+            LocalVector<T> lx;
+            LocalVector<T> ly;
+
+            lx.Allocate("x", n);
+
+            for(int64_t i = 0; i < n; ++i)
+            {
+                lx[i] = static_cast<T>(1) / static_cast<T>(2 + i % 7);
+            }
+
+            if(acc == 1)
+            {
+                A.MoveToAccelerator();
+                x.MoveToAccelerator();
+                y_ref.MoveToAccelerator();
+                lx.MoveToAccelerator();
+            }
+
+            x.Allocate("x", n);
+            y_ref.Allocate("y", n);
+
+            x.Scatter(lx);
+
+            // Product in the previous numbering
+            A.Apply(x, &y_ref);
+            y_ref.Gather(&ly);
+
+            int64_t local_nnz = A.GetLocalNnz() + A.GetGhostNnz();
+
+            ParallelManager      pm_reorder;
+            LocalVector<int64_t> perm;
+
+            pm_reorder.SetMPICommunicator(&comm);
+
+            A.ReorderBoundaryFirst(&pm_reorder, &perm);
+            x.Repartition(pm_reorder, perm);
+
+            // Each rank keeps its rows
+            success &= (pm_reorder.GetLocalNrow() == pm.GetLocalNrow());
+            success &= (A.GetLocalNnz() + A.GetGhostNnz() == local_nnz);
+
+            GlobalVector<T> y(pm_reorder);
+
+            if(acc == 1)
+            {
+                y.MoveToAccelerator();
+            }
+
+            y.Allocate("y", n);
+
+            // Repeated products use the same send path
+            for(int k = 0; k < 2; ++k)
+            {
+                A.Apply(x, &y);
+                success &= (global_permuted_vector_error(y, ly, perm) <= tol);
+            }
+        }
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+template <typename T>
+bool testing_global_matrix_repartition(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    LocalMatrix<T> lA;
+    generate_coupled_matrix(size, &lA);
+
+    int64_t nrow = lA.GetM();
+
+    LocalVector<T> lx;
+    LocalVector<T> lb;
+
+    lx.Allocate("x", nrow);
+    lb.Allocate("b", nrow);
+
+    for(int64_t i = 0; i < nrow; ++i)
+    {
+        lx[i] = static_cast<T>(1) / static_cast<T>(2 + i % 7);
+        lb[i] = static_cast<T>(1) / static_cast<T>(3 + i % 5);
+    }
+
+    // The parallel manager keeps a pointer to the communicator
+    static MPI_Comm comm = MPI_COMM_WORLD;
+
+    const double tol = std::is_same<T, float>::value ? 1e-5 : 1e-12;
+
+    bool success = true;
+
+    for(int acc = 0; acc < 2; ++acc)
+    {
+        ParallelManager pm;
+        GlobalMatrix<T> A;
+
+        distribute_matrix_copy(lA, &A, &pm);
+
+        GlobalVector<T> x(pm);
+        GlobalVector<T> b(pm);
+        GlobalVector<T> y_ref(pm);
+
+        if(acc == 1)
+        {
+            A.MoveToAccelerator();
+            x.MoveToAccelerator();
+            b.MoveToAccelerator();
+            y_ref.MoveToAccelerator();
+            lx.MoveToAccelerator();
+            lb.MoveToAccelerator();
+        }
+
+        x.Allocate("x", nrow);
+        b.Allocate("b", nrow);
+        y_ref.Allocate("y", nrow);
+
+        x.Scatter(lx);
+        b.Scatter(lb);
+
+        // Product and residual in the previous distribution
+        LocalVector<T> ly;
+        LocalVector<T> lr;
+
+        A.Apply(x, &y_ref);
+        y_ref.Gather(&ly);
+
+        y_ref.ScaleAdd(static_cast<T>(-1), b);
+        y_ref.Gather(&lr);
+
+        int64_t nnz = A.GetNnz();
+
+        ParallelManager      pm_part;
+        LocalVector<int64_t> perm;
+
+        pm_part.SetMPICommunicator(&comm);
+
+        A.Repartition(&pm_part, &perm);
+
+        x.Repartition(pm_part, perm);
+        b.Repartition(pm_part, perm);
+
+        success &= (pm_part.GetGlobalNrow() == nrow);
+        success &= (A.GetNnz() == nnz);
+
+        // The vectors are moved without arithmetic
+        success &= (global_permuted_vector_error(x, lx, perm) == 0.0);
+        success &= (global_permuted_vector_error(b, lb, perm) == 0.0);
+
+        GlobalVector<T> y(pm_part);
+
+        if(acc == 1)
+        {
+            y.MoveToAccelerator();
+        }
+
+        y.Allocate("y", nrow);
+
+        A.Apply(x, &y);
+        success &= (global_permuted_vector_error(y, ly, perm) <= tol);
+
+        y.ScaleAdd(static_cast<T>(-1), b);
+        success &= (global_permuted_vector_error(y, lr, perm) <= tol);
+
+        lx.MoveToHost();
+        lb.MoveToHost();
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return global_success(success);
+}
+
+#endif // TESTING_GLOBAL_MATRIX_MPI_HPP
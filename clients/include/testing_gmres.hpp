@@ -91,6 +91,9 @@ bool testing_gmres(Arguments argus, bool expectConvergence = true)
     // Preconditioner
     Preconditioner<LocalMatrix<T>, LocalVector<T>, T>* p;
 
+    // Block preconditioners of RAS
+    Solver<LocalMatrix<T>, LocalVector<T>, T>* blocks[4] = {NULL, NULL, NULL, NULL};
+
     if(precond == "None")
         p = NULL;
     else if(precond == "Chebyshev")
@@ -109,6 +112,15 @@ bool testing_gmres(Arguments argus, bool expectConvergence = true)
 
         p = cheb;
     }
+    else if(precond == "GMRESPoly")
+    {
+        // GMRES polynomial preconditioner
+        GMRESPolynomial<LocalMatrix<T>, LocalVector<T>, T>* poly
+            = new GMRESPolynomial<LocalMatrix<T>, LocalVector<T>, T>;
+        poly->Set(5);
+
+        p = poly;
+    }
     else if(precond == "FSAI")
         p = new FSAI<LocalMatrix<T>, LocalVector<T>, T>;
     else if(precond == "SPAI")
@@ -117,6 +129,15 @@ bool testing_gmres(Arguments argus, bool expectConvergence = true)
         p = new TNS<LocalMatrix<T>, LocalVector<T>, T>;
     else if(precond == "Jacobi")
         p = new Jacobi<LocalMatrix<T>, LocalVector<T>, T>;
+    else if(precond == "PBJacobi")
+    {
+        // Point-block Jacobi with grid lines as blocks
+        PointBlockJacobi<LocalMatrix<T>, LocalVector<T>, T>* pbj
+            = new PointBlockJacobi<LocalMatrix<T>, LocalVector<T>, T>;
+        pbj->SetBlockDimension(7);
+
+        p = pbj;
+    }
     else if(precond == "GS")
         p = new GS<LocalMatrix<T>, LocalVector<T>, T>;
     else if(precond == "SGS")
@@ -133,8 +154,32 @@ bool testing_gmres(Arguments argus, bool expectConvergence = true)
         p = new MultiColoredGS<LocalMatrix<T>, LocalVector<T>, T>;
     else if(precond == "MCSGS")
         p = new MultiColoredSGS<LocalMatrix<T>, LocalVector<T>, T>;
+    else if(precond == "PBMCGS")
+    {
+        // Point-block multi-colored GS with grid lines as blocks
+        MultiColoredGS<LocalMatrix<T>, LocalVector<T>, T>* mcgs
+            = new MultiColoredGS<LocalMatrix<T>, LocalVector<T>, T>;
+        mcgs->SetBlockDimension(7);
+
+        p = mcgs;
+    }
     else if(precond == "MCILU")
         p = new MultiColoredILU<LocalMatrix<T>, LocalVector<T>, T>;
+    else if(precond == "RAS")
+    {
+        // RAS with ILU blocks, solved concurrently
+        RAS<LocalMatrix<T>, LocalVector<T>, T>* ras = new RAS<LocalMatrix<T>, LocalVector<T>, T>;
+
+        for(int i = 0; i < 4; ++i)
+        {
+            blocks[i] = new ILU<LocalMatrix<T>, LocalVector<T>, T>;
+        }
+
+        ras->Set(4, 2, blocks);
+        ras->SetConcurrentBlocks(2);
+
+        p = ras;
+    }
     else
         return false;
 
@@ -149,6 +194,14 @@ bool testing_gmres(Arguments argus, bool expectConvergence = true)
 
     ls.Init(1e-6, 0.0, 1e+8, 10000);
     ls.SetBasisSize(basis);
+    ls.SetOrthogonalization(static_cast<OrthoAlg>(argus.ortho));
+    ls.SetReducedPrecisionBasis(argus.reducedbasis != 0);
+
+    if(argus.adaptive > 0)
+    {
+        ls.SetAdaptiveRestart(5, argus.adaptive);
+        ls.InitStagnation(100, 1.0);
+    }
 
     ls.Build();
 
@@ -170,6 +223,11 @@ bool testing_gmres(Arguments argus, bool expectConvergence = true)
         delete p;
     }
 
+    for(int i = 0; i < 4; ++i)
+    {
+        delete blocks[i];
+    }
+
     // Stop rocALUTION platform
     stop_rocalution();
 
@@ -0,0 +1,155 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_LEAST_SQUARES_HPP
+#define TESTING_LEAST_SQUARES_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-5);
+}
+
+template <typename T>
+bool testing_least_squares(Arguments argus)
+{
+    int          ndim   = argus.size;
+    std::string  solver = argus.solver;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate the 2D Laplacian L
+    int* lap_ptr = NULL;
+    int* lap_col = NULL;
+    T*   lap_val = NULL;
+
+    int ncol    = gen_2d_laplacian(ndim, &lap_ptr, &lap_col, &lap_val);
+    int lap_nnz = lap_ptr[ncol];
+
+    // Overdetermined system A = [L; I] with full column rank
+    int nrow = 2 * ncol;
+    int nnz  = lap_nnz + ncol;
+
+    int* csr_ptr = new int[nrow + 1];
+    int* csr_col = new int[nnz];
+    T*   csr_val = new T[nnz];
+
+    for(int i = 0; i <= ncol; ++i)
+    {
+        csr_ptr[i] = lap_ptr[i];
+    }
+
+    for(int j = 0; j < lap_nnz; ++j)
+    {
+        csr_col[j] = lap_col[j];
+        csr_val[j] = lap_val[j];
+    }
+
+    for(int i = 0; i < ncol; ++i)
+    {
+        csr_ptr[ncol + i + 1] = lap_nnz + i + 1;
+        csr_col[lap_nnz + i]  = i;
+        csr_val[lap_nnz + i]  = static_cast<T>(1);
+    }
+
+    delete[] lap_ptr;
+    delete[] lap_col;
+    delete[] lap_val;
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, ncol);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Random initial guess
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+    // Solver
+    IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>* ls;
+
+    if(solver == "CGLS")
+        ls = new CGLS<LocalMatrix<T>, LocalVector<T>, T>;
+    else if(solver == "LSQR")
+        ls = new LSQR<LocalMatrix<T>, LocalVector<T>, T>;
+    else
+        return false;
+
+    ls->Verbose(0);
+    ls->SetOperator(A);
+    ls->Init(1e-10, 1e-8, 1e+8, 10000);
+    ls->Build();
+
+    // Matrix format
+    A.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
+
+    ls->Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    bool success = check_residual(nrm2);
+
+    // Clean up
+    ls->Clear();
+    delete ls;
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_LEAST_SQUARES_HPP
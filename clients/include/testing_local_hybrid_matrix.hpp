@@ -0,0 +1,152 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_LOCAL_HYBRID_MATRIX_HPP
+#define TESTING_LOCAL_HYBRID_MATRIX_HPP
+
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-3f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-6);
+}
+
+template <typename T>
+bool testing_local_hybrid_matrix(Arguments argus)
+{
+    int         ndim   = argus.size;
+    std::string solver = argus.solver;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // Split with a fixed host fraction, and with a measured one
+    LocalHybridMatrix<T> op;
+    op.MoveToAccelerator();
+
+    if(argus.alpha >= 0.0)
+    {
+        op.SetHostFraction(argus.alpha);
+    }
+
+    op.SetMatrix(A);
+
+    bool success = (op.GetM() == A.GetM()) && (op.GetNnz() == A.GetNnz());
+
+    // The hybrid product has to match the one of A
+    e.SetRandomUniform(12345ULL, -1.0, 1.0);
+    A.Apply(e, &b);
+    op.Apply(e, &x);
+    x.ScaleAdd(-1.0, b);
+
+    success = success && check_residual(x.Norm());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // x = 0
+    x.Zeros();
+
+    IterativeLinearSolver<LocalShellOperator<T>, LocalVector<T>, T>* ls = NULL;
+
+    if(solver == "CG")
+    {
+        ls = new CG<LocalShellOperator<T>, LocalVector<T>, T>;
+    }
+    else if(solver == "GMRES")
+    {
+        ls = new GMRES<LocalShellOperator<T>, LocalVector<T>, T>;
+    }
+    else
+    {
+        return false;
+    }
+
+    Jacobi<LocalShellOperator<T>, LocalVector<T>, T> p;
+
+    ls->Verbose(0);
+    ls->SetOperator(op);
+    ls->SetPreconditioner(p);
+    ls->Init(1e-8, 0.0, 1e+8, 10000);
+    ls->Build();
+
+    ls->Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    success = success && check_residual(nrm2);
+
+    // Clean up
+    ls->Clear();
+
+    delete ls;
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_LOCAL_HYBRID_MATRIX_HPP
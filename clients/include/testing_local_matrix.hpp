@@ -30,6 +30,9 @@
 #include <gtest/gtest.h>
 #include <rocalution/rocalution.hpp>
 
+#include <cstdio>
+#include <set>
+
 using namespace rocalution;
 
 template <typename T>
@@ -84,6 +87,7 @@ void testing_local_matrix_bad_args(void)
         ASSERT_DEATH(mat1.ExtractDiagonal(null_vec), ".*Assertion.*vec_diag != (NULL|__null)*");
         ASSERT_DEATH(mat1.ExtractInverseDiagonal(null_vec),
                      ".*Assertion.*vec_inv_diag != (NULL|__null)*");
+        ASSERT_DEATH(mat1.ExtractRowL1Norm(null_vec), ".*Assertion.*vec_l1 != (NULL|__null)*");
         ASSERT_DEATH(mat1.ExtractL(mat_null, true), ".*Assertion.*L != (NULL|__null)*");
         ASSERT_DEATH(mat1.ExtractU(mat_null, true), ".*Assertion.*U != (NULL|__null)*");
         delete pmat[0][0];
@@ -429,8 +433,22 @@ bool testing_local_matrix_conversions(Arguments argus)
     success &= A.Check();
     A.ConvertToBCSR(blockdim);
     success &= A.Check();
+    A.ConvertToSELL();
+    success &= A.Check();
+    A.ConvertToVBR();
+    success &= A.Check();
+    A.ConvertToCSR();
+    success &= A.Check();
+
+    // Check format selection, the second call uses the cached decision
+    A.ConvertToBest(2);
+    success &= A.Check();
+    unsigned int best_format = A.GetFormat();
     A.ConvertToCSR();
+    A.ConvertToBest(2);
     success &= A.Check();
+    success &= (A.GetFormat() == best_format);
+    A.ConvertToCSR();
 
     // Check accelerator conversions
     A.MoveToAccelerator();
@@ -449,9 +467,17 @@ bool testing_local_matrix_conversions(Arguments argus)
     success &= A.Check();
     A.ConvertToBCSR(blockdim);
     success &= A.Check();
+    A.ConvertToSELL();
+    success &= A.Check();
+    A.ConvertToVBR();
+    success &= A.Check();
     A.ConvertToCSR();
     success &= A.Check();
 
+    A.ConvertToBest(2);
+    success &= A.Check();
+    A.ConvertToCSR();
+
     // Stop rocALUTION platform
     stop_rocalution();
 
@@ -459,60 +485,1923 @@ bool testing_local_matrix_conversions(Arguments argus)
 }
 
 template <typename T>
-bool testing_local_matrix_allocations(Arguments argus)
+bool testing_local_matrix_spmv_alg(Arguments argus)
 {
-    int size     = argus.size;
-    int blockdim = argus.blockdim;
+    int         size        = argus.size;
+    std::string matrix_type = argus.matrix_type;
 
-    int m  = size;
-    int n  = size;
-    int mb = (m + blockdim - 1) / blockdim;
-    int nb = (n + blockdim - 1) / blockdim;
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
 
-    int nnz = 0.05 * m * n;
-    if(nnz == 0)
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = 0;
+    int ncol = 0;
+    if(matrix_type == "Laplacian2D")
     {
-        nnz = m * n;
+        nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+        ncol = nrow;
+    }
+    else if(matrix_type == "PermutedIdentity")
+    {
+        nrow = gen_permuted_identity(size, &csr_ptr, &csr_col, &csr_val);
+        ncol = nrow;
+    }
+    else if(matrix_type == "Random")
+    {
+        nrow = gen_random(100 * size, 50 * size, 6, &csr_ptr, &csr_col, &csr_val);
+        ncol = 50 * size;
     }
+    else if(matrix_type == "HyperSparse")
+    {
+        // Only every 16th row of the Laplacian is kept, like the ghost part of a thin halo
+        nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+        ncol = nrow;
 
-    int nnzb = 0.01 * mb * nb;
-    if(nnzb == 0)
+        int nz = 0;
+        for(int i = 0; i < nrow; ++i)
+        {
+            int begin  = csr_ptr[i];
+            int end    = csr_ptr[i + 1];
+            csr_ptr[i] = nz;
+
+            for(int j = begin; j < end && i % 16 == 0; ++j)
+            {
+                csr_col[nz] = csr_col[j];
+                csr_val[nz] = csr_val[j];
+                ++nz;
+            }
+        }
+
+        csr_ptr[nrow] = nz;
+    }
+    else if(matrix_type == "WideRows")
     {
-        nnzb = mb * nb;
+        // Narrow rows with a few rows, whose column span exceeds 8 and 16 bit offsets
+        nrow = 100 * size;
+        ncol = 70000;
+
+        allocate_host(nrow + 1, &csr_ptr);
+        allocate_host(4 * nrow, &csr_col);
+        allocate_host(4 * nrow, &csr_val);
+
+        int nz     = 0;
+        csr_ptr[0] = 0;
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            int base = (31 * i) % (ncol - 4);
+
+            csr_col[nz++] = base;
+            csr_col[nz++] = base + 1;
+            csr_col[nz++] = base + 3;
+
+            if(i % 10 == 0)
+            {
+                csr_col[nz++] = (base + 66000) % ncol;
+            }
+            else if(i % 7 == 0)
+            {
+                csr_col[nz++] = (base + 300) % ncol;
+            }
+
+            std::sort(csr_col + csr_ptr[i], csr_col + nz);
+
+            for(int j = csr_ptr[i]; j < nz; ++j)
+            {
+                csr_val[j] = static_cast<T>(1 + (i + j) % 5);
+            }
+
+            csr_ptr[i + 1] = nz;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    int nnz = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, ncol);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> ref;
+
+    x.Allocate("x", ncol);
+    y.Allocate("y", nrow);
+    ref.Allocate("ref", nrow);
+
+    for(int i = 0; i < ncol; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 11);
+    }
+
+    // Host reference
+    A.Apply(x, &ref);
+
+    T ref_norm = ref.Norm();
+
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    y.MoveToAccelerator();
+    ref.MoveToAccelerator();
+
+    bool success = true;
+
+    SpMVAlg algs[]
+        = {SpMVAlg_Auto, SpMVAlg_Adaptive, SpMVAlg_Stream, SpMVAlg_LRB, SpMVAlg_RowList};
+
+    for(SpMVAlg alg : algs)
+    {
+        A.SetSpMVAlg(alg);
+        success &= (A.GetSpMVAlg() == alg);
+
+        // y = A * x
+        A.Apply(x, &y);
+        y.AddScale(ref, static_cast<T>(-1));
+        success &= (std::abs(y.Norm()) <= 1e-5 * std::abs(ref_norm));
+
+        // y = ref + 2 * A * x
+        y.CopyFrom(ref);
+        A.ApplyAdd(x, static_cast<T>(2), &y);
+        y.AddScale(ref, static_cast<T>(-3));
+        success &= (std::abs(y.Norm()) <= 1e-5 * std::abs(ref_norm));
+    }
+
+    // Float value storage, the error is in the order of the float round-off
+    A.SetSpMVStorage(SpMVStorage_Float);
+    success &= (A.GetSpMVStorage() == SpMVStorage_Float);
+
+    A.Apply(x, &y);
+    y.AddScale(ref, static_cast<T>(-1));
+    success &= (std::abs(y.Norm()) <= 1e-5 * std::abs(ref_norm));
+
+    // The float copy has to follow in-place updates of the values
+    A.Scale(static_cast<T>(2));
+    A.Apply(x, &y);
+    y.AddScale(ref, static_cast<T>(-2));
+    success &= (std::abs(y.Norm()) <= 2e-5 * std::abs(ref_norm));
+
+    // Half and bfloat16 value storage, 11 and 8 significant bits
+    A.SetSpMVStorage(SpMVStorage_Half);
+    success &= (A.GetSpMVStorage() == SpMVStorage_Half);
+
+    A.Apply(x, &y);
+    y.AddScale(ref, static_cast<T>(-2));
+    success &= (std::abs(y.Norm()) <= 2e-2 * std::abs(ref_norm));
+
+    A.SetSpMVStorage(SpMVStorage_BFloat16);
+    success &= (A.GetSpMVStorage() == SpMVStorage_BFloat16);
+
+    y.CopyFrom(ref);
+    A.ApplyAdd(x, static_cast<T>(1), &y);
+    y.AddScale(ref, static_cast<T>(-3));
+    success &= (std::abs(y.Norm()) <= 1e-1 * std::abs(ref_norm));
+
+    // Compressed column indices, the product is exact
+    A.SetSpMVStorage(SpMVStorage_Full);
+    A.SetSpMVIndex(SpMVIndex_Compressed);
+    success &= (A.GetSpMVIndex() == SpMVIndex_Compressed);
+
+    y.CopyFrom(ref);
+    A.ApplyAdd(x, static_cast<T>(1), &y);
+    y.AddScale(ref, static_cast<T>(-3));
+    success &= (std::abs(y.Norm()) <= 2e-5 * std::abs(ref_norm));
+
+    // Value updates keep the compressed indices
+    A.Scale(static_cast<T>(0.5));
+    A.Apply(x, &y);
+    y.AddScale(ref, static_cast<T>(-1));
+    success &= (std::abs(y.Norm()) <= 1e-5 * std::abs(ref_norm));
+
+    // Compressed column indices on the host
+    A.MoveToHost();
+    x.MoveToHost();
+    y.MoveToHost();
+    ref.MoveToHost();
+
+    success &= (A.GetSpMVIndex() == SpMVIndex_Compressed);
+
+    y.CopyFrom(ref);
+    A.ApplyAdd(x, static_cast<T>(2), &y);
+    y.AddScale(ref, static_cast<T>(-3));
+    success &= (std::abs(y.Norm()) <= 1e-5 * std::abs(ref_norm));
+
+    // The compressed indices have to be rebuilt after changes of the structure
+    LocalMatrix<T> AT;
+    AT.CopyFrom(A);
+    AT.SetSpMVIndex(SpMVIndex_Full);
+    AT.Transpose();
+
+    LocalVector<T> xt;
+    LocalVector<T> yt;
+    LocalVector<T> reft;
+
+    xt.Allocate("xt", nrow);
+    yt.Allocate("yt", ncol);
+    reft.Allocate("reft", ncol);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        xt[i] = static_cast<T>(1 + i % 13);
+    }
+
+    AT.Apply(xt, &reft);
+
+    T reft_norm = reft.Norm();
+
+    for(int backend = 0; backend < 2; ++backend)
+    {
+        if(backend == 1)
+        {
+            A.MoveToAccelerator();
+            x.MoveToAccelerator();
+            y.MoveToAccelerator();
+            xt.MoveToAccelerator();
+            yt.MoveToAccelerator();
+            reft.MoveToAccelerator();
+        }
+
+        LocalMatrix<T> B;
+        B.CloneFrom(A);
+        B.SetSpMVIndex(SpMVIndex_Compressed);
+
+        // Build the compressed indices of B, before its structure changes
+        B.Apply(x, &y);
+
+        B.Transpose();
+        B.Apply(xt, &yt);
+        yt.AddScale(reft, static_cast<T>(-1));
+        success &= (std::abs(yt.Norm()) <= 1e-5 * std::abs(reft_norm));
     }
 
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_fsai(Arguments argus)
+{
+    int size = argus.size;
+
     // Initialize rocALUTION
     set_device_rocalution(device);
     init_rocalution();
 
-    int ndiag       = 5;
-    int ell_max_row = 6;
-    int ell_nnz     = ell_max_row * m;
-    int coo_nnz     = (nnz - ell_nnz) < 0 ? 0 : nnz - ell_nnz;
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
 
-    // Testing allocating matrix types
     LocalMatrix<T> A;
-    A.AllocateCSR("A", nnz, m, n);
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
 
-    LocalMatrix<T> B;
-    B.AllocateBCSR("B", nnzb, mb, nb, blockdim);
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> ref;
 
-    LocalMatrix<T> C;
-    C.AllocateCOO("C", nnz, m, n);
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    ref.Allocate("ref", nrow);
 
-    LocalMatrix<T> D;
-    D.AllocateDIA("D", nnz, m, n, ndiag);
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 11);
+    }
 
-    LocalMatrix<T> F;
-    F.AllocateELL("F", ell_nnz, m, n, ell_max_row);
+    bool success = true;
 
-    LocalMatrix<T> G;
-    G.AllocateHYB("G", ell_nnz, coo_nnz, ell_max_row, m, n);
+    for(int power = 1; power <= 2; ++power)
+    {
+        LocalMatrix<T> L_host;
+        LocalMatrix<T> L_accel;
+
+        // Host reference
+        L_host.CloneFrom(A);
+        L_host.FSAI(power, NULL);
+
+        L_host.Apply(x, &ref);
+
+        // Accelerator
+        L_accel.CloneFrom(A);
+        L_accel.MoveToAccelerator();
+        L_accel.FSAI(power, NULL);
+
+        success &= (L_accel.GetNnz() == L_host.GetNnz());
+
+        L_accel.MoveToHost();
+        L_accel.Apply(x, &y);
+
+        y.AddScale(ref, static_cast<T>(-1));
+        success &= (std::abs(y.Norm()) <= 1e-5 * std::abs(ref.Norm()));
+    }
 
     // Stop rocALUTION platform
     stop_rocalution();
 
-    return true;
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_ai_setup(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> ref;
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    ref.Allocate("ref", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 11);
+    }
+
+    bool success = true;
+
+    // Host reference
+    LocalMatrix<T> M_host;
+    M_host.CloneFrom(A);
+    M_host.SPAI();
+    M_host.Apply(x, &ref);
+
+    reset_host_fallback_rocalution();
+
+    // Accelerator
+    LocalMatrix<T> M_accel;
+    M_accel.CloneFrom(A);
+    M_accel.MoveToAccelerator();
+    M_accel.SPAI();
+
+    success &= (M_accel.GetNnz() == M_host.GetNnz());
+
+    // TNS setup, both variants
+    A.MoveToAccelerator();
+
+    for(int impl = 0; impl < 2; ++impl)
+    {
+        TNS<LocalMatrix<T>, LocalVector<T>, T> tns;
+
+        tns.Set(impl == 1);
+        tns.SetOperator(A);
+        tns.Build();
+        tns.Clear();
+    }
+
+    // The setup of both preconditioners stays on the accelerator
+    int64_t count = 0;
+    int64_t bytes = 0;
+    double  time  = 0.0;
+
+    success &= get_host_fallback_rocalution("", &count, &bytes, &time);
+    success &= (count == 0);
+
+    M_accel.MoveToHost();
+    M_accel.Apply(x, &y);
+
+    y.AddScale(ref, static_cast<T>(-1));
+    success &= (std::abs(y.Norm()) <= 1e-4 * std::abs(ref.Norm()));
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_maximal_independent_set(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+    A.MoveToAccelerator();
+
+    bool success = true;
+
+    reset_host_fallback_rocalution();
+
+    LocalVector<int> perm;
+    perm.MoveToAccelerator();
+
+    int mis_size = 0;
+    A.MaximalIndependentSet(mis_size, &perm);
+
+    // Multi-elimination setup
+    Jacobi<LocalMatrix<T>, LocalVector<T>, T>           jac;
+    MultiElimination<LocalMatrix<T>, LocalVector<T>, T> me;
+
+    me.SetOperator(A);
+    me.Set(jac, 2);
+    me.Build();
+    me.Clear();
+
+    // Both stay on the accelerator
+    int64_t count = 0;
+    int64_t bytes = 0;
+    double  time  = 0.0;
+
+    success &= get_host_fallback_rocalution("", &count, &bytes, &time);
+    success &= (count == 0);
+
+    A.MoveToHost();
+    perm.MoveToHost();
+
+    success &= (mis_size > 0 && mis_size <= nrow);
+
+    // perm must be a permutation
+    std::vector<int> hit(nrow, 0);
+    for(int i = 0; i < nrow; ++i)
+    {
+        success &= (perm[i] >= 0 && perm[i] < nrow);
+
+        if(perm[i] >= 0 && perm[i] < nrow)
+        {
+            ++hit[perm[i]];
+        }
+    }
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        success &= (hit[i] == 1);
+    }
+
+    // The set is independent and maximal
+    int* row_offset = NULL;
+    int* col        = NULL;
+    T*   val        = NULL;
+
+    A.LeaveDataPtrCSR(&row_offset, &col, &val);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        bool in_set = (perm[i] < mis_size);
+        bool nbh    = false;
+
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+        {
+            if(col[j] != i && perm[col[j]] < mis_size)
+            {
+                nbh = true;
+            }
+        }
+
+        success &= (in_set != nbh);
+    }
+
+    free_host(&row_offset);
+    free_host(&col);
+    free_host(&val);
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_extract_submatrices(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+
+    // Drop the diagonal entry of every third row
+    int nnz = 0;
+    for(int i = 0; i < nrow; ++i)
+    {
+        int row_begin = csr_ptr[i];
+        csr_ptr[i]    = nnz;
+
+        for(int j = row_begin; j < csr_ptr[i + 1]; ++j)
+        {
+            if(i % 3 == 0 && csr_col[j] == i)
+            {
+                continue;
+            }
+
+            csr_col[nnz] = csr_col[j];
+            csr_val[nnz] = csr_val[j];
+            ++nnz;
+        }
+    }
+    csr_ptr[nrow] = nnz;
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    bool success = true;
+
+    // Zero block permutation
+    LocalVector<int> perm_host;
+    LocalVector<int> perm_accel;
+
+    int size_host  = 0;
+    int size_accel = 0;
+
+    A.ZeroBlockPermutation(size_host, &perm_host);
+
+    A.MoveToAccelerator();
+    perm_accel.MoveToAccelerator();
+    A.ZeroBlockPermutation(size_accel, &perm_accel);
+    perm_accel.MoveToHost();
+
+    success &= (size_host == size_accel);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        success &= (perm_host[i] == perm_accel[i]);
+    }
+
+    // Uneven 3 x 2 block structure
+    int row_offset[4] = {0, nrow / 4, nrow / 2 + 1, nrow};
+    int col_offset[3] = {0, nrow / 3, nrow};
+
+    LocalMatrix<T>  blocks_host[6];
+    LocalMatrix<T>  blocks_accel[6];
+    LocalMatrix<T>* rows_host[3][2];
+    LocalMatrix<T>* rows_accel[3][2];
+
+    for(int i = 0; i < 3; ++i)
+    {
+        for(int j = 0; j < 2; ++j)
+        {
+            rows_host[i][j]  = &blocks_host[i * 2 + j];
+            rows_accel[i][j] = &blocks_accel[i * 2 + j];
+            rows_accel[i][j]->MoveToAccelerator();
+        }
+    }
+
+    LocalMatrix<T>** mat_host[3]  = {rows_host[0], rows_host[1], rows_host[2]};
+    LocalMatrix<T>** mat_accel[3] = {rows_accel[0], rows_accel[1], rows_accel[2]};
+
+    A.ExtractSubMatrices(3, 2, row_offset, col_offset, mat_accel);
+
+    A.MoveToHost();
+    A.ExtractSubMatrices(3, 2, row_offset, col_offset, mat_host);
+
+    for(int i = 0; i < 3; ++i)
+    {
+        for(int j = 0; j < 2; ++j)
+        {
+            LocalMatrix<T>& B_host  = blocks_host[i * 2 + j];
+            LocalMatrix<T>& B_accel = blocks_accel[i * 2 + j];
+
+            B_accel.MoveToHost();
+
+            success &= (B_accel.GetM() == B_host.GetM());
+            success &= (B_accel.GetN() == B_host.GetN());
+            success &= (B_accel.GetNnz() == B_host.GetNnz());
+
+            LocalVector<T> x;
+            LocalVector<T> y;
+            LocalVector<T> ref;
+
+            x.Allocate("x", B_host.GetN());
+            y.Allocate("y", B_host.GetM());
+            ref.Allocate("ref", B_host.GetM());
+
+            for(int k = 0; k < B_host.GetN(); ++k)
+            {
+                x[k] = static_cast<T>(1 + k % 7);
+            }
+
+            B_host.Apply(x, &ref);
+            B_accel.Apply(x, &y);
+
+            y.AddScale(ref, static_cast<T>(-1));
+            success &= (std::abs(y.Norm()) <= 1e-5 * (1 + std::abs(ref.Norm())));
+        }
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_host_trsv(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<T> b;
+    b.Allocate("b", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        b[i] = static_cast<T>(1 + i % 13);
+    }
+
+    bool success = true;
+
+    // Sequential reference and level scheduled solve
+    LocalVector<T> x[2];
+    LocalVector<T> y[2];
+
+    for(int k = 0; k < 2; ++k)
+    {
+        set_omp_threads_rocalution(k == 0 ? 1 : 4);
+
+        LocalMatrix<T> LU;
+        LocalMatrix<T> LL;
+        LocalVector<T> inv_diag;
+
+        LU.CloneFrom(A);
+        LU.ILU0Factorize();
+        LU.LUAnalyse();
+
+        LL.CloneFrom(A);
+        LL.ICFactorize(&inv_diag);
+        LL.LLAnalyse();
+
+        x[k].Allocate("x", nrow);
+        y[k].Allocate("y", nrow);
+
+        LU.LUSolve(b, &x[k]);
+        LL.LLSolve(b, inv_diag, &y[k]);
+    }
+
+    x[1].AddScale(x[0], static_cast<T>(-1));
+    y[1].AddScale(y[0], static_cast<T>(-1));
+
+    success &= (std::abs(x[1].Norm()) <= 1e-5 * std::abs(x[0].Norm()));
+    success &= (std::abs(y[1].Norm()) <= 1e-5 * std::abs(y[0].Norm()));
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_update_values(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Reference with new values in CSR order
+    LocalMatrix<T> ref;
+    ref.CloneFrom(A);
+
+    std::vector<T> new_val(nnz);
+    for(int k = 0; k < nnz; ++k)
+    {
+        new_val[k] = static_cast<T>(1 + k % 5);
+    }
+
+    ref.UpdateValuesCSR(new_val.data());
+
+    // Same values in reversed assembly order, updated on the accelerator
+    LocalVector<T>   val;
+    LocalVector<int> perm;
+
+    val.Allocate("val", nnz);
+    perm.Allocate("perm", nnz);
+
+    for(int k = 0; k < nnz; ++k)
+    {
+        val[k]  = new_val[nnz - 1 - k];
+        perm[k] = nnz - 1 - k;
+    }
+
+    A.MoveToAccelerator();
+    val.MoveToAccelerator();
+    perm.MoveToAccelerator();
+
+    A.UpdateValuesCSR(val, &perm);
+
+    A.MoveToHost();
+
+    // Compare both matrices
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    z.Allocate("z", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 7);
+    }
+
+    ref.Apply(x, &y);
+    A.Apply(x, &z);
+
+    z.AddScale(y, static_cast<T>(-1));
+
+    bool success = (std::abs(z.Norm()) <= 1e-5 * (1 + std::abs(y.Norm())));
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_assemble_coo(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // 1D linear finite elements, assembled in reversed element order, shared nodes
+    // produce duplicate entries
+    int nrow = size + 1;
+    int nnz  = 4 * size;
+
+    std::vector<int> row(nnz);
+    std::vector<int> col(nnz);
+
+    for(int e = size - 1, k = 0; e >= 0; --e)
+    {
+        for(int a = 0; a < 2; ++a)
+        {
+            for(int b = 0; b < 2; ++b)
+            {
+                row[k] = e + a;
+                col[k] = e + b;
+                ++k;
+            }
+        }
+    }
+
+    LocalMatrix<T>   A;
+    LocalVector<int> offset;
+    LocalVector<int> perm;
+
+    A.MoveToAccelerator();
+    A.AssembleCOOSymbolic(nnz, row.data(), col.data(), nrow, nrow, &offset, &perm);
+
+    bool success = (A.GetNnz() == 3 * nrow - 2);
+
+    LocalVector<T> val;
+    LocalVector<T> x;
+    LocalVector<T> y;
+
+    val.Allocate("val", nnz);
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 7);
+    }
+
+    // Two time steps with different element contributions
+    for(int step = 1; step <= 2; ++step)
+    {
+        std::vector<T> ref(nrow, static_cast<T>(0));
+
+        val.MoveToHost();
+
+        for(int k = 0; k < nnz; ++k)
+        {
+            int e  = row[k] < col[k] ? row[k] : col[k];
+            val[k] = static_cast<T>(step * (e + 1) * (row[k] == col[k] ? 1 : -1));
+            ref[row[k]] += val[k] * x[col[k]];
+        }
+
+        val.MoveToAccelerator();
+
+        A.AssembleCOONumeric(val, offset, perm);
+
+        A.MoveToHost();
+        A.Apply(x, &y);
+        A.MoveToAccelerator();
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            success &= (std::abs(y[i] - ref[i]) <= 1e-5 * (1 + std::abs(ref[i])));
+        }
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_coo_unsorted(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // COO entries in a scrambled order, neither rows nor columns are sorted
+    A.ConvertToCOO();
+
+    int* coo_row = NULL;
+    int* coo_col = NULL;
+    T*   coo_val = NULL;
+
+    A.LeaveDataPtrCOO(&coo_row, &coo_col, &coo_val);
+
+    int* row = NULL;
+    int* col = NULL;
+    T*   val = NULL;
+
+    allocate_host(nnz, &row);
+    allocate_host(nnz, &col);
+    allocate_host(nnz, &val);
+
+    // 7919 is prime, the reordering is a permutation unless nnz is a multiple of it
+    for(int k = 0; k < nnz; ++k)
+    {
+        int idx = static_cast<int>((static_cast<int64_t>(k) * 7919) % nnz);
+
+        row[k] = coo_row[idx];
+        col[k] = coo_col[idx];
+        val[k] = coo_val[idx];
+    }
+
+    A.SetDataPtrCOO(&coo_row, &coo_col, &coo_val, "A", nnz, nrow, nrow);
+
+    LocalMatrix<T> B_host;
+    LocalMatrix<T> B_accel;
+
+    B_host.AllocateCOO("B", nnz, nrow, nrow);
+    B_host.CopyFromCOO(row, col, val);
+
+    B_accel.CloneFrom(B_host);
+    B_accel.MoveToAccelerator();
+
+    B_host.ConvertToCSR();
+    B_accel.ConvertToCSR();
+    B_accel.MoveToHost();
+
+    free_host(&row);
+    free_host(&col);
+    free_host(&val);
+
+    bool success = (B_host.Check() == true) && (B_accel.Check() == true);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> ref;
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    ref.Allocate("ref", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 7);
+    }
+
+    A.Apply(x, &ref);
+
+    B_host.Apply(x, &y);
+    y.AddScale(ref, static_cast<T>(-1));
+    success &= (std::abs(y.Norm()) <= 1e-5 * (1 + std::abs(ref.Norm())));
+
+    B_accel.Apply(x, &y);
+    y.AddScale(ref, static_cast<T>(-1));
+    success &= (std::abs(y.Norm()) <= 1e-5 * (1 + std::abs(ref.Norm())));
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_allocations(Arguments argus)
+{
+    int size     = argus.size;
+    int blockdim = argus.blockdim;
+
+    int m  = size;
+    int n  = size;
+    int mb = (m + blockdim - 1) / blockdim;
+    int nb = (n + blockdim - 1) / blockdim;
+
+    int nnz = 0.05 * m * n;
+    if(nnz == 0)
+    {
+        nnz = m * n;
+    }
+
+    int nnzb = 0.01 * mb * nb;
+    if(nnzb == 0)
+    {
+        nnzb = mb * nb;
+    }
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    int ndiag       = 5;
+    int ell_max_row = 6;
+    int ell_nnz     = ell_max_row * m;
+    int coo_nnz     = (nnz - ell_nnz) < 0 ? 0 : nnz - ell_nnz;
+
+    // Testing allocating matrix types
+    LocalMatrix<T> A;
+    A.AllocateCSR("A", nnz, m, n);
+
+    LocalMatrix<T> B;
+    B.AllocateBCSR("B", nnzb, mb, nb, blockdim);
+
+    LocalMatrix<T> C;
+    C.AllocateCOO("C", nnz, m, n);
+
+    LocalMatrix<T> D;
+    D.AllocateDIA("D", nnz, m, n, ndiag);
+
+    LocalMatrix<T> F;
+    F.AllocateELL("F", ell_nnz, m, n, ell_max_row);
+
+    LocalMatrix<T> G;
+    G.AllocateHYB("G", ell_nnz, coo_nnz, ell_max_row, m, n);
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return true;
+}
+
+template <typename T>
+bool testing_local_matrix_conversion_memory(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+    A.MoveToAccelerator();
+
+    int64_t si  = sizeof(int);
+    int64_t sv  = sizeof(T);
+    int64_t csr = (nrow + 1) * static_cast<int64_t>(sizeof(PtrType)) + nnz * (si + sv);
+    int64_t coo = nnz * (2 * si + sv);
+    int64_t ell = 5 * static_cast<int64_t>(nrow) * (si + sv);
+    int64_t dia = 5 * si + 5 * static_cast<int64_t>(nrow) * sv;
+
+    int64_t format_bytes;
+    int64_t peak_bytes;
+
+    bool success = true;
+
+    A.EstimateConversionMemory(CSR, 1, &format_bytes, &peak_bytes);
+    success &= (format_bytes == csr) && (peak_bytes == csr);
+
+    A.EstimateConversionMemory(COO, 1, &format_bytes, &peak_bytes);
+    success &= (format_bytes == coo) && (peak_bytes == csr + coo);
+
+    A.EstimateConversionMemory(ELL, 1, &format_bytes, &peak_bytes);
+    success &= (format_bytes == ell) && (peak_bytes == csr + ell);
+
+    // Non-CSR to non-CSR conversions go through CSR
+    A.ConvertToCOO();
+
+    A.EstimateConversionMemory(DIA, 1, &format_bytes, &peak_bytes);
+    success &= (format_bytes == dia) && (peak_bytes == std::max(coo + csr, csr + dia));
+
+    // Format analysis of the 5-point stencil
+    MatrixFormatAnalysis analysis;
+    A.AnalyzeFormats(&analysis);
+
+    success &= (analysis.num_diag == 5) && (analysis.max_row == 5);
+    success &= (analysis.format_bytes[CSR] == csr) && (analysis.format_bytes[ELL] == ell);
+    success &= (analysis.format_bytes[DIA] == dia);
+    success &= (analysis.spmv_bytes[CSR] == csr + 2 * nrow * sv);
+
+    // The estimate and the analysis must not modify the matrix
+    success &= (A.GetFormat() == COO) && (A.GetNnz() == nnz) && (A.Check() == true);
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_statistics(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    bool success = true;
+
+    // Host, accelerator and a non-CSR format must agree
+    for(int pass = 0; pass < 3; ++pass)
+    {
+        if(pass == 1)
+        {
+            A.MoveToAccelerator();
+        }
+        else if(pass == 2)
+        {
+            A.ConvertToELL();
+        }
+
+        MatrixStatistics stats;
+        A.Statistics(&stats);
+
+        double mean = static_cast<double>(nnz) / nrow;
+
+        success &= (stats.min_row == 3) && (stats.max_row == 5);
+        success &= (std::abs(stats.mean_row - mean) < 1e-12);
+        success &= (stats.var_row >= 0.0);
+        success &= (stats.bandwidth == size);
+        success &= (stats.profile == static_cast<int64_t>(size) * size * (size - 1) + size - 1);
+        success &= (stats.diag_dominance == 1.0);
+        success &= (stats.symmetric == true);
+    }
+
+    // Changing a single off-diagonal value of row 1 breaks the symmetry
+    nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    csr_val[csr_ptr[1]] = static_cast<T>(-2);
+
+    LocalMatrix<T> B;
+    B.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "B", nnz, nrow, nrow);
+    B.MoveToAccelerator();
+
+    MatrixStatistics stats;
+    B.Statistics(&stats);
+
+    success &= (stats.symmetric == false);
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_symmetric_storage(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalMatrix<T> S;
+    S.CloneFrom(A);
+    S.ConvertToSymmetricStorage();
+
+    bool success = (S.GetSymmetricStorage() == true) && (S.GetNnz() == (nnz + nrow) / 2);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> ref;
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    ref.Allocate("ref", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 7);
+        y[i] = static_cast<T>(i % 3);
+    }
+
+    // ref = y + 2 * A * x
+    ref.CopyFrom(y);
+    A.ApplyAdd(x, static_cast<T>(2), &ref);
+
+    for(int accel = 0; accel < 2; ++accel)
+    {
+        LocalMatrix<T> B;
+        LocalVector<T> u;
+        LocalVector<T> v;
+
+        B.CloneFrom(S);
+        u.CloneFrom(x);
+        v.CloneFrom(y);
+
+        if(accel == 1)
+        {
+            B.MoveToAccelerator();
+            u.MoveToAccelerator();
+            v.MoveToAccelerator();
+        }
+
+        success &= (B.GetSymmetricStorage() == true);
+
+        B.ApplyAdd(u, static_cast<T>(2), &v);
+        v.MoveToHost();
+        v.AddScale(ref, static_cast<T>(-1));
+        success &= (std::abs(v.Norm()) <= 1e-5 * (1 + std::abs(ref.Norm())));
+
+        // CG with IC and Jacobi on the upper triangle
+        LocalVector<T> b;
+        LocalVector<T> e;
+
+        b.CloneBackend(B);
+        e.CloneBackend(B);
+        b.Allocate("b", nrow);
+        e.Allocate("e", nrow);
+
+        e.Ones();
+        B.Apply(e, &b);
+
+        CG<LocalMatrix<T>, LocalVector<T>, T>     ls;
+        IC<LocalMatrix<T>, LocalVector<T>, T>     ic;
+        Jacobi<LocalMatrix<T>, LocalVector<T>, T> jacobi;
+
+        for(int p = 0; p < 2; ++p)
+        {
+            if(p == 0)
+            {
+                ls.SetPreconditioner(ic);
+            }
+            else
+            {
+                ls.SetPreconditioner(jacobi);
+            }
+
+            ls.Verbose(0);
+            ls.SetOperator(B);
+            ls.Init(1e-8, 0.0, 1e+8, 10000);
+            ls.Build();
+
+            u.Zeros();
+            ls.Solve(b, &u);
+
+            u.ScaleAdd(static_cast<T>(-1), e);
+            success &= (std::abs(u.Norm()) <= 1e-3 * std::abs(e.Norm()));
+
+            ls.Clear();
+        }
+    }
+
+    // Restore both triangles
+    S.ConvertToFullStorage();
+
+    success &= (S.GetSymmetricStorage() == false) && (S.GetNnz() == nnz);
+
+    S.Apply(x, &y);
+    A.Apply(x, &ref);
+    y.AddScale(ref, static_cast<T>(-1));
+    success &= (std::abs(y.Norm()) <= 1e-5 * (1 + std::abs(ref.Norm())));
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_share_structure(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<T>   x;
+    LocalVector<T>   ref;
+    LocalVector<int> perm;
+
+    x.Allocate("x", nrow);
+    ref.Allocate("ref", nrow);
+    perm.Allocate("perm", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i]    = static_cast<T>(1 + i % 7);
+        perm[i] = nrow - 1 - i;
+    }
+
+    A.Apply(x, &ref);
+
+    bool success = true;
+
+    for(int accel = 0; accel < 2; ++accel)
+    {
+        LocalMatrix<T> B;
+        LocalMatrix<T> F;
+        LocalMatrix<T> R;
+        LocalVector<T> u;
+        LocalVector<T> v;
+        LocalVector<T> w;
+
+        B.CloneFrom(A);
+        u.CloneFrom(x);
+
+        if(accel == 1)
+        {
+            B.MoveToAccelerator();
+            u.MoveToAccelerator();
+        }
+
+        v.CloneBackend(B);
+        w.CloneBackend(B);
+        v.Allocate("v", nrow);
+        w.Allocate("w", nrow);
+
+        // ILU(0) on the shared pattern has to match ILU(0) on a copy
+        F.ShareStructureFrom(B);
+        R.CloneFrom(B);
+
+        success &= (F.GetFormat() == CSR) && (F.GetNnz() == nnz);
+
+        F.ILU0Factorize();
+        R.ILU0Factorize();
+
+        F.Apply(u, &v);
+        R.Apply(u, &w);
+        v.AddScale(w, static_cast<T>(-1));
+        success &= (std::abs(v.Norm()) <= 1e-5 * (1 + std::abs(w.Norm())));
+
+        // The values of the operator are left untouched
+        B.Apply(u, &v);
+        v.MoveToHost();
+        v.AddScale(ref, static_cast<T>(-1));
+        success &= (std::abs(v.Norm()) <= 1e-5 * (1 + std::abs(ref.Norm())));
+
+        // Changing the pattern of a sharing matrix does not affect the others
+        LocalMatrix<T> P;
+        P.ShareStructureFrom(B);
+        perm.CloneBackend(B);
+        P.Permute(perm);
+        perm.MoveToHost();
+
+        v.CloneBackend(B);
+        B.Apply(u, &v);
+        v.MoveToHost();
+        v.AddScale(ref, static_cast<T>(-1));
+        success &= (std::abs(v.Norm()) <= 1e-5 * (1 + std::abs(ref.Norm())));
+
+        // The pattern outlives the matrix it was shared from
+        B.Clear();
+
+        v.CloneBackend(F);
+        F.Apply(u, &v);
+        v.AddScale(w, static_cast<T>(-1));
+        success &= (std::abs(v.Norm()) <= 1e-5 * (1 + std::abs(w.Norm())));
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_views(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A, the arrays stay owned by the test
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    T* x_data = new T[nrow];
+    T* y_data = new T[nrow];
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x_data[i] = static_cast<T>(1 + i % 7);
+        y_data[i] = static_cast<T>(0);
+    }
+
+    // Reference on owned copies
+    LocalMatrix<T> R;
+    LocalVector<T> rx;
+    LocalVector<T> ry;
+
+    R.AllocateCSR("R", nnz, nrow, nrow);
+    R.CopyFromCSR(csr_ptr, csr_col, csr_val);
+    rx.Allocate("rx", nrow);
+    ry.Allocate("ry", nrow);
+    rx.CopyFromData(x_data);
+
+    R.Scale(static_cast<T>(2));
+    R.Apply(rx, &ry);
+
+    bool success = true;
+
+    for(int pass = 0; pass < 2; ++pass)
+    {
+        LocalMatrix<T> A;
+        LocalVector<T> x;
+        LocalVector<T> y;
+
+        A.AttachCSRView(csr_ptr, csr_col, csr_val, "A", nnz, nrow, nrow);
+        x.AttachView(x_data, "x", nrow);
+        y.AttachView(y_data, "y", nrow);
+
+        success &= (A.GetNnz() == nnz) && (x.GetSize() == nrow);
+
+        // Value updates and results go to the external arrays, the second pass
+        // sees the values scaled by the first one
+        if(pass == 0)
+        {
+            A.Scale(static_cast<T>(2));
+        }
+
+        A.Apply(x, &y);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            success &= (std::abs(y_data[i] - ry[i]) <= 1e-5 * (1 + std::abs(ry[i])));
+        }
+
+        // Moving to the accelerator works on a copy
+        A.MoveToAccelerator();
+        x.MoveToAccelerator();
+        y.MoveToAccelerator();
+
+        y.Zeros();
+        A.Apply(x, &y);
+        y.MoveToHost();
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            success &= (std::abs(y[i] - ry[i]) <= 1e-5 * (1 + std::abs(ry[i])));
+        }
+
+        // Leaving the data hands out a copy, the external arrays stay valid
+        T* data = NULL;
+        y.LeaveDataPtr(&data);
+        free_host(&data);
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    delete[] csr_ptr;
+    delete[] csr_col;
+    delete[] csr_val;
+    delete[] x_data;
+    delete[] y_data;
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_out_of_core(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> ref;
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    ref.Allocate("ref", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 11);
+    }
+
+    // Host reference
+    A.Apply(x, &ref);
+
+    T ref_norm = ref.Norm();
+
+    bool success = true;
+
+    // Chunks of several rows, of single rows and longer than the matrix
+    int64_t chunks[] = {4 * size, 1, 2 * nnz};
+
+    for(int64_t chunk_nnz : chunks)
+    {
+        LocalMatrix<T> B;
+        B.CloneFrom(A);
+        B.SetOutOfCore(true, chunk_nnz);
+
+        B.MoveToAccelerator();
+        x.MoveToAccelerator();
+        y.MoveToAccelerator();
+        ref.MoveToAccelerator();
+
+        // y = B * x
+        B.Apply(x, &y);
+        y.AddScale(ref, static_cast<T>(-1));
+        success &= (std::abs(y.Norm()) <= 1e-5 * std::abs(ref_norm));
+
+        // y = ref + 2 * B * x
+        y.CopyFrom(ref);
+        B.ApplyAdd(x, static_cast<T>(2), &y);
+        y.AddScale(ref, static_cast<T>(-3));
+        success &= (std::abs(y.Norm()) <= 1e-5 * std::abs(ref_norm));
+
+        // Back to device resident storage
+        B.SetOutOfCore(false);
+        B.Apply(x, &y);
+        y.AddScale(ref, static_cast<T>(-1));
+        success &= (std::abs(y.Norm()) <= 1e-5 * std::abs(ref_norm));
+
+        x.MoveToHost();
+        y.MoveToHost();
+        ref.MoveToHost();
+    }
+
+    // Solve with the operator streamed from host memory
+    LocalVector<T> sol;
+    sol.Allocate("sol", nrow);
+    sol.Zeros();
+
+    A.SetOutOfCore(true, 4 * size);
+    A.MoveToAccelerator();
+    ref.MoveToAccelerator();
+    sol.MoveToAccelerator();
+
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.Build();
+    ls.Solve(ref, &sol);
+
+    sol.MoveToHost();
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        success &= (std::abs(sol[i] - static_cast<T>(1 + i % 11)) <= 1e-3 * (1 + i % 11));
+    }
+
+    ls.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_apply_rows(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> ref;
+
+    x.Allocate("x", nrow);
+    b.Allocate("b", nrow);
+    ref.Allocate("ref", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 7);
+        b[i] = static_cast<T>(i % 3);
+    }
+
+    // Reference product
+    A.Apply(x, &ref);
+
+    // Every third row, in descending order
+    int              nrows = (nrow + 2) / 3;
+    LocalVector<int> rows;
+    rows.Allocate("rows", nrows);
+
+    for(int i = 0; i < nrows; ++i)
+    {
+        rows[i] = nrow - 1 - 3 * i;
+    }
+
+    bool success = true;
+
+    // Accelerator CSR, accelerator ELL (host fallback) and host CSR
+    for(int pass = 0; pass < 3; ++pass)
+    {
+        LocalMatrix<T> B;
+        B.CloneFrom(A);
+
+        LocalVector<T>   y;
+        LocalVector<T>   r;
+        LocalVector<int> idx;
+
+        y.Allocate("y", nrow);
+        r.Allocate("r", nrow);
+        idx.CloneFrom(rows);
+
+        y.Ones();
+        r.Ones();
+
+        if(pass < 2)
+        {
+            B.MoveToAccelerator();
+            x.MoveToAccelerator();
+            b.MoveToAccelerator();
+            y.MoveToAccelerator();
+            r.MoveToAccelerator();
+            idx.MoveToAccelerator();
+        }
+
+        if(pass == 1)
+        {
+            B.ConvertToELL();
+        }
+
+        B.ApplyRows(x, idx, &y);
+        B.ResidualRows(b, x, idx, &r);
+
+        // Rows that are not listed must be left untouched
+        B.ApplyAddRows(x, idx, static_cast<T>(2), &r);
+
+        x.MoveToHost();
+        b.MoveToHost();
+        y.MoveToHost();
+        r.MoveToHost();
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            bool listed = ((nrow - 1 - i) % 3 == 0);
+
+            T y_ref = listed ? ref[i] : static_cast<T>(1);
+            T r_ref = listed ? b[i] + ref[i] : static_cast<T>(1);
+
+            success &= (std::abs(y[i] - y_ref) <= 1e-5 * (1 + std::abs(y_ref)));
+            success &= (std::abs(r[i] - r_ref) <= 1e-5 * (1 + std::abs(r_ref)));
+        }
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_matrix_add(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // M has a wider pattern than A
+    LocalMatrix<T> M;
+    M.MatrixMult(A, A);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> ref;
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    ref.Allocate("ref", nrow);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 7);
+    }
+
+    A.MoveToAccelerator();
+    M.MoveToAccelerator();
+    x.MoveToAccelerator();
+    y.MoveToAccelerator();
+    ref.MoveToAccelerator();
+
+    bool success = true;
+
+    // C = A + sigma * M, then reuse the pattern for another shift
+    LocalMatrix<T> C;
+    C.MoveToAccelerator();
+
+    C.MatrixAdd(A, static_cast<T>(1), M, static_cast<T>(0.5));
+
+    success &= (C.GetNnz() == M.GetNnz());
+
+    for(T sigma : {static_cast<T>(0.5), static_cast<T>(-2)})
+    {
+        if(sigma != static_cast<T>(0.5))
+        {
+            C.MatrixAddNumeric(A, static_cast<T>(1), M, sigma);
+        }
+
+        A.Apply(x, &ref);
+        M.ApplyAdd(x, sigma, &ref);
+
+        C.Apply(x, &y);
+        y.AddScale(ref, static_cast<T>(-1));
+
+        success &= (std::abs(y.Norm()) <= 1e-5 * std::abs(ref.Norm()));
+    }
+
+    // Structure of A^3 on the accelerator and on the host
+    LocalMatrix<T> P;
+    P.CloneFrom(A);
+    P.SymbolicPower(3);
+
+    A.MoveToHost();
+    A.SymbolicPower(3);
+
+    success &= (P.GetNnz() == A.GetNnz());
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_rsio(Arguments argus)
+{
+    int nrow = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Rows with column deltas of both signs and of different magnitudes
+    std::vector<int> row_ptr(nrow + 1, 0);
+    std::vector<int> col;
+    std::vector<T>   val;
+
+    // Random values of the first rows do not pay off to be XOR encoded and are stored
+    // raw, the regular values of the last rows are XOR encoded. There are enough rows for
+    // both a raw and an XOR encoded chunk.
+    int nrandom = nrow - nrow / 8;
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        std::set<int> cols = {i / 3, i, static_cast<int>((7919LL * i) % nrow)};
+
+        for(int c : cols)
+        {
+            col.push_back(c);
+
+            if(i < nrandom)
+            {
+                uint32_t h = (static_cast<uint32_t>(i) * 2654435761u) ^ static_cast<uint32_t>(c);
+                val.push_back(static_cast<T>(h % 1000003) / static_cast<T>(1000003));
+            }
+            else
+            {
+                val.push_back(static_cast<T>(c == i ? 4 : -1));
+            }
+        }
+
+        row_ptr[i + 1] = static_cast<int>(col.size());
+    }
+
+    int nnz = row_ptr[nrow];
+
+    PtrType* csr_ptr = NULL;
+    int*     csr_col = NULL;
+    T*       csr_val = NULL;
+
+    allocate_host(nrow + 1, &csr_ptr);
+    allocate_host(nnz, &csr_col);
+    allocate_host(nnz, &csr_val);
+
+    std::copy(row_ptr.begin(), row_ptr.end(), csr_ptr);
+    std::copy(col.begin(), col.end(), csr_col);
+    std::copy(val.begin(), val.end(), csr_val);
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Compressed files are written from an accelerator matrix as well
+    A.MoveToAccelerator();
+
+    const std::string filename = "rocalution_rsio_test.rsio";
+
+    bool success = true;
+
+    for(int compress = 0; compress < 2; ++compress)
+    {
+        A.WriteFileRSIO(filename, compress == 1);
+
+        LocalMatrix<T> B;
+        B.ReadFileRSIO(filename);
+        B.MoveToHost();
+        B.ConvertToCSR();
+
+        success &= (B.GetM() == nrow);
+        success &= (B.GetN() == nrow);
+        success &= (B.GetNnz() == nnz);
+
+        if(B.GetNnz() != nnz)
+        {
+            continue;
+        }
+
+        PtrType* ptr  = NULL;
+        int*     ind  = NULL;
+        T*       data = NULL;
+
+        B.LeaveDataPtrCSR(&ptr, &ind, &data);
+
+        // The encoding is lossless
+        for(int i = 0; i <= nrow; ++i)
+        {
+            success &= (ptr[i] == row_ptr[i]);
+        }
+
+        for(int j = 0; j < nnz; ++j)
+        {
+            success &= (ind[j] == col[j]);
+            success &= (data[j] == val[j]);
+        }
+
+        free_host(&ptr);
+        free_host(&ind);
+        free_host(&data);
+    }
+
+    std::remove(filename.c_str());
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
 }
 
 #endif // TESTING_LOCAL_MATRIX_HPP
@@ -471,3 +471,357 @@ bool testing_local_matrix_itusolve(Arguments argus)
 
     return success;
 }
+
+template <typename T>
+bool testing_local_matrix_tri_solver_auto(Arguments argus)
+{
+    const int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // The 5-point stencil in natural ordering has one level per anti-diagonal
+    bool success = (A.GetTriangularLevels(true) == 2 * size - 1);
+    success &= (A.GetTriangularLevels(false) == 2 * size - 1);
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Below and above the parallelism threshold of the auto mode
+    for(double min_parallelism : {static_cast<double>(nrow), 1.0})
+    {
+        SolverDescr descr;
+        descr.SetTriSolverAlg(TriSolverAlg_Auto);
+        descr.SetTriSolverAutoParallelism(min_parallelism);
+
+        FGMRES<LocalMatrix<T>, LocalVector<T>, T> ls;
+        ILU<LocalMatrix<T>, LocalVector<T>, T>    p;
+
+        p.SetSolverDescriptor(descr);
+
+        ls.Verbose(0);
+        ls.SetOperator(A);
+        ls.SetPreconditioner(p);
+        ls.Init(1e-8, 0.0, 1e+8, 1000);
+        ls.Build();
+
+        const SolverDescr& active = p.GetSolverDescriptor();
+
+        success &= (active.GetTriSolverLevels() == 2 * size - 1);
+        success &= (active.GetActiveTriSolverAlg()
+                    == (min_parallelism > 1.0 ? TriSolverAlg_Iterative : TriSolverAlg_Default));
+
+        x.Zeros();
+        ls.Solve(b, &x);
+
+        x.ScaleAdd(-1.0, e);
+        success &= check_residual(x.Norm());
+
+        ls.Clear();
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_tri_block_inverse(Arguments argus)
+{
+    const int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    y.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    x.Allocate("x", A.GetN());
+    y.Allocate("y", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    bool success = true;
+
+    // With one sweep per block, the block inverse solve is exact
+    {
+        SolverDescr descr;
+        descr.SetTriSolverAlg(TriSolverAlg_BlockInverse);
+        descr.SetTriSolverBlockSize(7);
+        descr.SetIterativeSolverMaxIteration(nrow);
+
+        ILU<LocalMatrix<T>, LocalVector<T>, T> p_ref;
+        ILU<LocalMatrix<T>, LocalVector<T>, T> p_blk;
+
+        p_blk.SetSolverDescriptor(descr);
+
+        p_ref.SetOperator(A);
+        p_blk.SetOperator(A);
+        p_ref.Build();
+        p_blk.Build();
+
+        p_ref.Solve(b, &x);
+        p_blk.Solve(b, &y);
+
+        y.ScaleAdd(-1.0, x);
+        success &= check_residual(y.Norm() / x.Norm());
+    }
+
+    // A few sweeps precondition the Krylov solver
+    {
+        SolverDescr descr;
+        descr.SetTriSolverAlg(TriSolverAlg_BlockInverse);
+        descr.SetIterativeSolverMaxIteration(2);
+
+        FGMRES<LocalMatrix<T>, LocalVector<T>, T> ls;
+        IC<LocalMatrix<T>, LocalVector<T>, T>     p;
+
+        p.SetSolverDescriptor(descr);
+
+        ls.Verbose(0);
+        ls.SetOperator(A);
+        ls.SetPreconditioner(p);
+        ls.Init(1e-8, 0.0, 1e+8, 1000);
+        ls.Build();
+
+        x.Zeros();
+        ls.Solve(b, &x);
+
+        x.ScaleAdd(-1.0, e);
+        success &= check_residual(x.Norm());
+
+        ls.Clear();
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_refactorize(Arguments argus)
+{
+    const int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> b;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    y.MoveToAccelerator();
+    b.MoveToAccelerator();
+
+    x.Allocate("x", A.GetN());
+    y.Allocate("y", A.GetN());
+    b.Allocate("b", A.GetM());
+
+    b.Ones();
+
+    bool success = true;
+
+    for(int k = 0; k < 5; ++k)
+    {
+        Preconditioner<LocalMatrix<T>, LocalVector<T>, T>* p_num = NULL;
+        Preconditioner<LocalMatrix<T>, LocalVector<T>, T>* p_ref = NULL;
+
+        if(k < 2)
+        {
+            ILU<LocalMatrix<T>, LocalVector<T>, T>* ilu_num
+                = new ILU<LocalMatrix<T>, LocalVector<T>, T>;
+            ILU<LocalMatrix<T>, LocalVector<T>, T>* ilu_ref
+                = new ILU<LocalMatrix<T>, LocalVector<T>, T>;
+            ilu_num->Set(k);
+            ilu_ref->Set(k);
+            p_num = ilu_num;
+            p_ref = ilu_ref;
+        }
+        else if(k == 2)
+        {
+            p_num = new IC<LocalMatrix<T>, LocalVector<T>, T>;
+            p_ref = new IC<LocalMatrix<T>, LocalVector<T>, T>;
+        }
+        else if(k == 3)
+        {
+            p_num = new ItILU0<LocalMatrix<T>, LocalVector<T>, T>;
+            p_ref = new ItILU0<LocalMatrix<T>, LocalVector<T>, T>;
+        }
+        else
+        {
+            MultiColoredILU<LocalMatrix<T>, LocalVector<T>, T>* mc_num
+                = new MultiColoredILU<LocalMatrix<T>, LocalVector<T>, T>;
+            MultiColoredILU<LocalMatrix<T>, LocalVector<T>, T>* mc_ref
+                = new MultiColoredILU<LocalMatrix<T>, LocalVector<T>, T>;
+            mc_num->SetDecomposition(false);
+            mc_ref->SetDecomposition(false);
+            p_num = mc_num;
+            p_ref = mc_ref;
+        }
+
+        p_num->SetOperator(A);
+        p_num->Build();
+
+        // Change the values, keeping the pattern
+        A.ScaleDiagonal(static_cast<T>(2));
+
+        p_num->ReBuildNumeric();
+
+        p_ref->SetOperator(A);
+        p_ref->Build();
+
+        p_num->Solve(b, &x);
+        p_ref->Solve(b, &y);
+
+        y.ScaleAdd(-1.0, x);
+        success &= check_residual(y.Norm() / x.Norm());
+
+        A.ScaleDiagonal(static_cast<T>(0.5));
+
+        delete p_num;
+        delete p_ref;
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_host_itilu0(Arguments argus)
+{
+    const int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalMatrix<T> LU;
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> b;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    x.Allocate("x", A.GetN());
+    y.Allocate("y", A.GetN());
+    b.Allocate("b", A.GetM());
+
+    b.Ones();
+
+    // Reference ILU0
+    LU.CloneFrom(A);
+    LU.ILU0Factorize();
+    LU.LUAnalyse();
+    LU.LUSolve(b, &y);
+    LU.LUAnalyseClear();
+
+    bool success = true;
+
+    // The fixed-point sweeps on the host converge to the ILU0 factors
+    const ItILU0Algorithm alg[] = {ItILU0Algorithm::AsyncInPlace, ItILU0Algorithm::SyncSplit};
+
+    for(ItILU0Algorithm a : alg)
+    {
+        int niter = 0;
+
+        LU.CloneFrom(A);
+        LU.ItILU0Factorize(a, ItILU0Option::StoppingCriteria, 500, 1e-14, &niter, NULL);
+        LU.LUAnalyse();
+        LU.LUSolve(b, &x);
+        LU.LUAnalyseClear();
+
+        success &= (niter > 0 && niter <= 500);
+
+        x.ScaleAdd(-1.0, y);
+        success &= check_residual(x.Norm() / y.Norm());
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
@@ -0,0 +1,437 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#pragma once
+
+#include "utility.hpp"
+#include "validate.hpp"
+
+#include <gtest/gtest.h>
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+template <typename T>
+bool testing_local_matrix_reordering(Arguments argus)
+{
+    const int          size        = argus.size;
+    const std::string  matrix_type = argus.matrix_type;
+    const unsigned int format      = argus.format;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = 0;
+    int ncol = 0;
+    if(matrix_type == "Laplacian2D")
+    {
+        nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+        ncol = nrow;
+    }
+    else if(matrix_type == "PermutedIdentity")
+    {
+        nrow = gen_permuted_identity(size, &csr_ptr, &csr_col, &csr_val);
+        ncol = nrow;
+    }
+    else if(matrix_type == "Random")
+    {
+        nrow = gen_random(100 * size, 100 * size, 6, &csr_ptr, &csr_col, &csr_val);
+        ncol = 100 * size;
+    }
+    else
+    {
+        return false;
+    }
+
+    int nnz = csr_ptr[nrow];
+
+    assert(csr_ptr != NULL);
+    assert(csr_col != NULL);
+    assert(csr_val != NULL);
+
+    LocalMatrix<T> A;
+
+    A.MoveToHost();
+    A.AllocateCSR("A", nnz, nrow, ncol);
+    A.CopyFromCSR(csr_ptr, csr_col, csr_val);
+
+    // Matrix format
+    A.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
+
+    LocalVector<int> perm;
+
+    int* cmk  = new int[nrow];
+    int* rcmk = new int[nrow];
+    int* conn = new int[nrow];
+
+    bool success = true;
+
+    for(int accel = 0; accel < 2; ++accel)
+    {
+        if(accel == 1)
+        {
+            // Check accelerator reordering
+            A.MoveToAccelerator();
+            perm.MoveToAccelerator();
+        }
+
+        A.CMK(&perm);
+        perm.CopyToHostData(cmk);
+        success &= valid_permutation(nrow, cmk);
+
+        // RCMK is the reversed CMK ordering
+        A.RCMK(&perm);
+        perm.CopyToHostData(rcmk);
+        success &= valid_permutation(nrow, rcmk);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            success &= (rcmk[i] == nrow - 1 - cmk[i]);
+        }
+
+        // Rows are ordered by their number of entries
+        A.ConnectivityOrder(&perm);
+        perm.CopyToHostData(conn);
+        success &= valid_permutation(nrow, conn);
+
+        for(int i = 1; i < nrow; ++i)
+        {
+            success &= (csr_ptr[conn[i] + 1] - csr_ptr[conn[i]]
+                        >= csr_ptr[conn[i - 1] + 1] - csr_ptr[conn[i - 1]]);
+        }
+
+        perm.Clear();
+    }
+
+    // Clean up
+    delete[] csr_ptr;
+    delete[] csr_col;
+    delete[] csr_val;
+
+    delete[] cmk;
+    delete[] rcmk;
+    delete[] conn;
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_graph_partition(Arguments argus)
+{
+    const int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+
+    A.AllocateCSR("A", nnz, nrow, nrow);
+    A.CopyFromCSR(csr_ptr, csr_col, csr_val);
+
+    LocalVector<int> part;
+
+    int* hpart = new int[nrow];
+
+    bool success = true;
+
+    for(int accel = 0; accel < 2; ++accel)
+    {
+        if(accel == 1)
+        {
+            A.MoveToAccelerator();
+            part.MoveToAccelerator();
+        }
+
+        for(int nparts : {2, 3, 4})
+        {
+            A.GraphPartition(nparts, &part);
+            part.CopyToHostData(hpart);
+
+            // Parts are balanced like a contiguous block distribution
+            std::vector<int> count(nparts, 0);
+
+            for(int i = 0; i < nrow; ++i)
+            {
+                success &= (hpart[i] >= 0 && hpart[i] < nparts);
+
+                if(hpart[i] >= 0 && hpart[i] < nparts)
+                {
+                    ++count[hpart[i]];
+                }
+            }
+
+            for(int p = 0; p < nparts; ++p)
+            {
+                success &= (count[p] == nrow / nparts + (p < nrow % nparts ? 1 : 0));
+            }
+
+            // The edge cut is far below the one of a round robin distribution
+            int cut       = 0;
+            int cut_round = 0;
+
+            for(int i = 0; i < nrow; ++i)
+            {
+                for(int j = csr_ptr[i]; j < csr_ptr[i + 1]; ++j)
+                {
+                    cut += (hpart[i] != hpart[csr_col[j]]) ? 1 : 0;
+                    cut_round += (i % nparts != csr_col[j] % nparts) ? 1 : 0;
+                }
+            }
+
+            success &= (2 * cut < cut_round);
+        }
+    }
+
+    // Clean up
+    delete[] csr_ptr;
+    delete[] csr_col;
+    delete[] csr_val;
+
+    delete[] hpart;
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_fill_reducing(Arguments argus)
+{
+    const int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+
+    A.AllocateCSR("A", nnz, nrow, nrow);
+    A.CopyFromCSR(csr_ptr, csr_col, csr_val);
+
+    LocalVector<int> perm;
+
+    int* hperm = new int[nrow];
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        hperm[i] = i;
+    }
+
+    // Fill of the lexicographic ordering
+    int natural = symbolic_factor_nnz(nrow, csr_ptr, csr_col, hperm);
+
+    bool success = true;
+
+    for(int accel = 0; accel < 2; ++accel)
+    {
+        if(accel == 1)
+        {
+            A.MoveToAccelerator();
+            perm.MoveToAccelerator();
+        }
+
+        A.AMD(&perm);
+        perm.CopyToHostData(hperm);
+
+        success &= valid_permutation(nrow, hperm);
+        success &= (symbolic_factor_nnz(nrow, csr_ptr, csr_col, hperm) < natural);
+
+        for(int leaf_size : {8, 64})
+        {
+            int  num_nodes   = 0;
+            int* node_offset = NULL;
+            int* node_parent = NULL;
+
+            A.NestedDissection(num_nodes, &node_offset, &node_parent, &perm, leaf_size);
+            perm.CopyToHostData(hperm);
+
+            success &= valid_permutation(nrow, hperm);
+            success &= valid_separator_tree(
+                nrow, csr_ptr, csr_col, num_nodes, node_offset, node_parent, hperm);
+            success &= (symbolic_factor_nnz(nrow, csr_ptr, csr_col, hperm) < natural);
+
+            // Leaves do not exceed the leaf size
+            for(int k = 0; k < num_nodes; ++k)
+            {
+                bool leaf = true;
+
+                for(int c = 0; c < k; ++c)
+                {
+                    leaf &= (node_parent[c] != k);
+                }
+
+                success &= (leaf == false || node_offset[k + 1] - node_offset[k] <= leaf_size);
+            }
+
+            free_host(&node_offset);
+            free_host(&node_parent);
+        }
+    }
+
+    // Clean up
+    delete[] csr_ptr;
+    delete[] csr_col;
+    delete[] csr_val;
+
+    delete[] hperm;
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_permute(Arguments argus)
+{
+    const int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> px;
+    LocalVector<T> py;
+
+    LocalVector<int> perm;
+
+    T* hy  = new T[nrow];
+    T* hpy = new T[nrow];
+
+    bool success = true;
+
+    for(int accel = 0; accel < 2; ++accel)
+    {
+        A.AllocateCSR("A", nnz, nrow, nrow);
+        A.CopyFromCSR(csr_ptr, csr_col, csr_val);
+
+        x.Allocate("x", nrow);
+        y.Allocate("y", nrow);
+        px.Allocate("px", nrow);
+        py.Allocate("py", nrow);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            x[i] = static_cast<T>(i % 7 + 1);
+        }
+
+        if(accel == 1)
+        {
+            A.MoveToAccelerator();
+            x.MoveToAccelerator();
+            y.MoveToAccelerator();
+            px.MoveToAccelerator();
+            py.MoveToAccelerator();
+            perm.MoveToAccelerator();
+        }
+
+        A.RCMK(&perm);
+        A.Apply(x, &y);
+
+        // (P A P^T) (P x) = P (A x)
+        px.CopyFrom(x);
+        px.Permute(perm);
+
+        A.Permute(perm);
+        A.Apply(px, &py);
+        py.PermuteBackward(perm);
+
+        y.CopyToHostData(hy);
+        py.CopyToHostData(hpy);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            success &= (std::abs(hy[i] - hpy[i]) <= static_cast<T>(1e-4) * std::abs(hy[i]));
+        }
+
+        // Permuting backward restores A
+        A.PermuteBackward(perm);
+        A.Apply(x, &py);
+
+        py.CopyToHostData(hpy);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            success &= (std::abs(hy[i] - hpy[i]) <= static_cast<T>(1e-4) * std::abs(hy[i]));
+        }
+
+        A.Clear();
+        x.Clear();
+        y.Clear();
+        px.Clear();
+        py.Clear();
+        perm.Clear();
+    }
+
+    // Clean up
+    delete[] csr_ptr;
+    delete[] csr_col;
+    delete[] csr_val;
+
+    delete[] hy;
+    delete[] hpy;
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
@@ -0,0 +1,200 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#pragma once
+#ifndef TESTING_LOCAL_MULTI_VECTOR_HPP
+#define TESTING_LOCAL_MULTI_VECTOR_HPP
+
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_multi_vector(float val, float ref)
+{
+    return std::abs(val - ref) <= 1e-4f * (1.0f + std::abs(ref));
+}
+
+static bool check_multi_vector(double val, double ref)
+{
+    return std::abs(val - ref) <= 1e-12 * (1.0 + std::abs(ref));
+}
+
+template <typename T>
+void testing_local_multi_vector_bad_args(void)
+{
+    int safe_size = 100;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // LocalMultiVector object
+    LocalMultiVector<T> X;
+    X.Allocate("X", safe_size, 4);
+
+    // SetDataPtr
+    {
+        ASSERT_DEATH(X.SetDataPtr(nullptr, "", safe_size, 4), ".*Assertion.*ptr != (NULL|__null)*");
+    }
+
+    // GetColumn
+    {
+        LocalVector<T> vec;
+        ASSERT_DEATH(X.GetColumn(0, nullptr), ".*Assertion.*vec != (NULL|__null)*");
+        ASSERT_DEATH(X.GetColumn(4, &vec), ".*Assertion.*j < this->ncol_*");
+    }
+
+    // SetColumn
+    {
+        LocalVector<T> vec;
+        vec.Allocate("", safe_size + 1);
+        ASSERT_DEATH(X.SetColumn(0, vec), ".*Assertion.*vec.GetSize\\(\\) == this->nrow_*");
+    }
+
+    // Apply
+    {
+        LocalMatrix<T>      A;
+        LocalMultiVector<T> Y;
+        Y.Allocate("Y", safe_size, 3);
+        ASSERT_DEATH(A.Apply(X, nullptr), ".*Assertion.*out != (NULL|__null)*");
+        ASSERT_DEATH(A.Apply(X, &Y), ".*Assertion.*in.GetNcol\\(\\) == out->GetNcol\\(\\)*");
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+bool testing_local_multi_vector_apply(Arguments argus)
+{
+    int          size        = argus.size;
+    int          nrhs        = argus.nrhs;
+    unsigned int format      = argus.format;
+    std::string  matrix_type = argus.matrix_type;
+    T            scalar      = static_cast<T>(argus.alpha);
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = 0;
+    int ncol = 0;
+
+    if(matrix_type == "Laplacian2D")
+    {
+        nrow = gen_2d_laplacian(size, &csr_ptr, &csr_col, &csr_val);
+        ncol = nrow;
+    }
+    else if(matrix_type == "Random")
+    {
+        ncol = size * size / 2 + 1;
+        nrow = gen_random(size * size, ncol, 9, &csr_ptr, &csr_col, &csr_val);
+    }
+    else
+    {
+        return false;
+    }
+
+    int nnz = csr_ptr[nrow];
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, ncol);
+
+    // Block of random right-hand sides and initial output
+    LocalMultiVector<T> X;
+    LocalMultiVector<T> Y;
+    LocalMultiVector<T> Z;
+
+    X.Allocate("X", ncol, nrhs);
+    Y.Allocate("Y", nrow, nrhs);
+
+    X.SetRandomUniform(12345ULL, -1.0, 1.0);
+    Y.SetRandomUniform(67890ULL, -1.0, 1.0);
+
+    // Reference, one matrix-vector product per column on the host in CSR format
+    std::vector<T> ref_apply(static_cast<size_t>(nrow) * nrhs);
+    std::vector<T> ref_apply_add(static_cast<size_t>(nrow) * nrhs);
+
+    {
+        LocalVector<T> x;
+        LocalVector<T> y;
+
+        y.Allocate("y", nrow);
+
+        for(int j = 0; j < nrhs; ++j)
+        {
+            X.GetColumn(j, &x);
+            A.Apply(x, &y);
+
+            for(int i = 0; i < nrow; ++i)
+            {
+                ref_apply[j * nrow + i]     = y[i];
+                ref_apply_add[j * nrow + i] = Y(i, j) + scalar * y[i];
+            }
+        }
+    }
+
+    Z.CopyFrom(Y);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    X.MoveToAccelerator();
+    Y.MoveToAccelerator();
+    Z.MoveToAccelerator();
+
+    // Matrix format
+    A.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
+
+    A.Apply(X, &Y);
+    A.ApplyAdd(X, scalar, &Z);
+
+    Y.MoveToHost();
+    Z.MoveToHost();
+
+    bool success = true;
+
+    for(int j = 0; j < nrhs; ++j)
+    {
+        for(int i = 0; i < nrow; ++i)
+        {
+            success &= check_multi_vector(Y(i, j), ref_apply[j * nrow + i]);
+            success &= check_multi_vector(Z(i, j), ref_apply_add[j * nrow + i]);
+        }
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_LOCAL_MULTI_VECTOR_HPP
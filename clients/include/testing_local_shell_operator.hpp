@@ -0,0 +1,236 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_LOCAL_SHELL_OPERATOR_HPP
+#define TESTING_LOCAL_SHELL_OPERATOR_HPP
+
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-3f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-6);
+}
+
+// Matrix-free wrapper of a LocalMatrix, the raw pointers passed to the shell are
+// wrapped into vectors on the backend of the operator
+template <typename T>
+class MatrixShell : public LocalShellOperator<T>
+{
+public:
+    explicit MatrixShell(const LocalMatrix<T>& mat)
+        : mat_(mat)
+    {
+        this->SetSize(mat.GetM(), mat.GetN());
+    }
+
+    virtual void MoveToAccelerator(void)
+    {
+        LocalShellOperator<T>::MoveToAccelerator();
+
+        this->in_.CloneBackend(*this);
+        this->out_.CloneBackend(*this);
+        this->diag_.CloneBackend(*this);
+    }
+
+    virtual void MoveToHost(void)
+    {
+        LocalShellOperator<T>::MoveToHost();
+
+        this->in_.CloneBackend(*this);
+        this->out_.CloneBackend(*this);
+        this->diag_.CloneBackend(*this);
+    }
+
+protected:
+    virtual void ShellApply(const T* in, T* out) const
+    {
+        T* pin  = const_cast<T*>(in);
+        T* pout = out;
+
+        this->in_.SetDataPtr(&pin, "in", this->GetN());
+        this->out_.SetDataPtr(&pout, "out", this->GetM());
+
+        this->mat_.Apply(this->in_, &this->out_);
+
+        this->in_.LeaveDataPtr(&pin);
+        this->out_.LeaveDataPtr(&pout);
+    }
+
+    virtual bool ShellDiagonal(T* diag) const
+    {
+        LocalVector<T> d;
+        this->mat_.ExtractDiagonal(&d);
+
+        this->diag_.SetDataPtr(&diag, "diag", this->GetM());
+        this->diag_.CopyFrom(d);
+        this->diag_.LeaveDataPtr(&diag);
+
+        return true;
+    }
+
+private:
+    const LocalMatrix<T>& mat_;
+
+    mutable LocalVector<T> in_;
+    mutable LocalVector<T> out_;
+    mutable LocalVector<T> diag_;
+};
+
+template <typename T>
+bool testing_local_shell_operator(Arguments argus)
+{
+    int         ndim   = argus.size;
+    std::string solver = argus.solver;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    MatrixShell<T> op(A);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    op.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", op.GetN());
+    b.Allocate("b", op.GetM());
+    e.Allocate("e", op.GetN());
+
+    // b = A * 1
+    e.Ones();
+    op.Apply(e, &b);
+
+    // x = 0
+    x.Zeros();
+
+    IterativeLinearSolver<LocalShellOperator<T>, LocalVector<T>, T>* ls = NULL;
+    Preconditioner<LocalShellOperator<T>, LocalVector<T>, T>*        p  = NULL;
+
+    SAAMG<LocalMatrix<T>, LocalVector<T>, T> amg;
+
+    if(solver == "CG")
+    {
+        ls = new CG<LocalShellOperator<T>, LocalVector<T>, T>;
+        p  = new Jacobi<LocalShellOperator<T>, LocalVector<T>, T>;
+    }
+    else if(solver == "GMRES")
+    {
+        ls = new GMRES<LocalShellOperator<T>, LocalVector<T>, T>;
+        p  = new Jacobi<LocalShellOperator<T>, LocalVector<T>, T>;
+    }
+    else if(solver == "Chebyshev")
+    {
+        Chebyshev<LocalShellOperator<T>, LocalVector<T>, T>* cheb
+            = new Chebyshev<LocalShellOperator<T>, LocalVector<T>, T>;
+
+        // Eigenvalues of the 2D Laplacian are in (0, 8)
+        T lambda_max = static_cast<T>(8);
+        T lambda_min = static_cast<T>(4.0 * (1.0 - std::cos(M_PI / (ndim + 1))));
+
+        cheb->Set(lambda_min, lambda_max);
+        ls = cheb;
+    }
+    else if(solver == "AMG")
+    {
+        amg.SetCoarsestLevel(10);
+        amg.InitMaxIter(1);
+        amg.Verbose(0);
+
+        AssembledPreconditioner<LocalShellOperator<T>, LocalVector<T>, T>* ap
+            = new AssembledPreconditioner<LocalShellOperator<T>, LocalVector<T>, T>;
+        ap->Set(amg, A);
+
+        ls = new CG<LocalShellOperator<T>, LocalVector<T>, T>;
+        p  = ap;
+    }
+    else
+    {
+        return false;
+    }
+
+    ls->Verbose(0);
+    ls->SetOperator(op);
+
+    if(p != NULL)
+    {
+        ls->SetPreconditioner(*p);
+    }
+
+    ls->Init(1e-8, 0.0, 1e+8, 10000);
+    ls->Build();
+
+    ls->Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    bool success = check_residual(nrm2);
+
+    // Clean up
+    ls->Clear();
+
+    delete ls;
+    if(p != NULL)
+    {
+        delete p;
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_LOCAL_SHELL_OPERATOR_HPP
@@ -58,4 +58,142 @@ void testing_local_stencil_bad_args(void)
     stop_rocalution();
 }
 
+// Reference stencil on the host, points outside of the grid are zero
+template <typename T>
+void local_stencil_reference(unsigned int type, int size, const T* x, T* y)
+{
+    int ndim = (type == Laplace2D) ? 2 : 3;
+    int nz   = (ndim == 2) ? 1 : size;
+
+    for(int iz = 0; iz < nz; ++iz)
+    {
+        for(int iy = 0; iy < size; ++iy)
+        {
+            for(int ix = 0; ix < size; ++ix)
+            {
+                int row = (iz * size + iy) * size + ix;
+
+                T sum = static_cast<T>(0);
+
+                for(int dz = (ndim == 2 ? 0 : -1); dz <= (ndim == 2 ? 0 : 1); ++dz)
+                {
+                    for(int dy = -1; dy <= 1; ++dy)
+                    {
+                        for(int dx = -1; dx <= 1; ++dx)
+                        {
+                            int nb = std::abs(dx) + std::abs(dy) + std::abs(dz);
+
+                            // 5-point and 7-point stencils only couple direct neighbours
+                            if(nb == 0 || (type != Laplace3D27 && nb > 1))
+                            {
+                                continue;
+                            }
+
+                            int jx = ix + dx;
+                            int jy = iy + dy;
+                            int jz = iz + dz;
+
+                            if(jx < 0 || jx >= size || jy < 0 || jy >= size || jz < 0 || jz >= nz)
+                            {
+                                continue;
+                            }
+
+                            sum -= x[(jz * size + jy) * size + jx];
+                        }
+                    }
+                }
+
+                T diag = static_cast<T>((type == Laplace2D) ? 4 : (type == Laplace3D) ? 6 : 26);
+
+                y[row] = diag * x[row] + sum;
+            }
+        }
+    }
+}
+
+template <typename T>
+bool testing_local_stencil_apply(Arguments argus)
+{
+    int size = argus.size;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    bool success = true;
+
+    unsigned int types[] = {Laplace2D, Laplace3D, Laplace3D27};
+
+    for(unsigned int type : types)
+    {
+        LocalStencil<T> stn(type);
+        stn.SetGrid(size);
+
+        int nrow = stn.GetM();
+
+        success &= (stn.GetNDim() == ((type == Laplace2D) ? 2 : 3));
+        success &= (stn.GetNnz() == ((type == Laplace2D) ? 5 : (type == Laplace3D) ? 7 : 27));
+
+        LocalVector<T> x;
+        LocalVector<T> y;
+
+        x.Allocate("x", nrow);
+        y.Allocate("y", nrow);
+
+        std::vector<T> hx(nrow);
+        std::vector<T> ref(nrow);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            hx[i] = static_cast<T>(1 + i % 7);
+            x[i]  = hx[i];
+        }
+
+        local_stencil_reference(type, size, hx.data(), ref.data());
+
+        for(int acc = 0; acc < 2; ++acc)
+        {
+            if(acc == 1)
+            {
+                stn.MoveToAccelerator();
+                x.MoveToAccelerator();
+                y.MoveToAccelerator();
+            }
+
+            // y = A * x
+            y.Zeros();
+            stn.Apply(x, &y);
+
+            y.MoveToHost();
+            for(int i = 0; i < nrow; ++i)
+            {
+                success &= (std::abs(y[i] - ref[i]) <= 1e-5 * std::abs(ref[i]) + 1e-5);
+            }
+
+            // y = y + 2 * A * x, y = 1
+            y.Ones();
+            if(acc == 1)
+            {
+                y.MoveToAccelerator();
+            }
+            stn.ApplyAdd(x, static_cast<T>(2), &y);
+
+            y.MoveToHost();
+            for(int i = 0; i < nrow; ++i)
+            {
+                T val = static_cast<T>(1) + static_cast<T>(2) * ref[i];
+                success &= (std::abs(y[i] - val) <= 1e-5 * std::abs(val) + 1e-5);
+            }
+        }
+
+        stn.MoveToHost();
+        success &= (stn.GetM() == nrow);
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_LOCAL_STENCIL_HPP
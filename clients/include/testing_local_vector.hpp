@@ -108,6 +108,211 @@ void testing_local_vector_bad_args(void)
         free_host(&vint);
     }
 
+    // MultiDot
+    {
+        const LocalVector<T>* x[1] = {&vec};
+        T                     res[1];
+        T*                    null_T = nullptr;
+        ASSERT_DEATH(vec.MultiDot(1, nullptr, res), ".*Assertion.*x != (NULL|__null)*");
+        ASSERT_DEATH(vec.MultiDot(1, x, null_T), ".*Assertion.*res != (NULL|__null)*");
+    }
+
+    // DualDot
+    {
+        T* null_T = nullptr;
+        ASSERT_DEATH(vec.DualDot(vec, vec, null_T), ".*Assertion.*res != (NULL|__null)*");
+    }
+
+    // DotToScalar, NormToScalar
+    {
+        LocalVector<T>* null_vec = nullptr;
+        ASSERT_DEATH(vec.DotToScalar(vec, null_vec, 0), ".*Assertion.*res != (NULL|__null)*");
+        ASSERT_DEATH(vec.DotNonConjToScalar(vec, null_vec, 0),
+                     ".*Assertion.*res != (NULL|__null)*");
+        ASSERT_DEATH(vec.NormToScalar(null_vec, 0), ".*Assertion.*res != (NULL|__null)*");
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_vector_scalars(void)
+{
+    int size = 1000;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+    LocalVector<T> s;
+
+    x.Allocate("x", size);
+    y.Allocate("y", size);
+    z.Allocate("z", size);
+    s.Allocate("s", 3);
+
+    for(int i = 0; i < size; ++i)
+    {
+        x[i] = static_cast<T>(1 + i % 7);
+        y[i] = static_cast<T>(1 + i % 5);
+    }
+
+    // Host reference
+    T dot  = x.Dot(y);
+    T norm = x.Norm();
+
+    z.CopyFrom(y);
+    z.AddScale(x, static_cast<T>(-2) * dot / norm);
+    z.ScaleAdd(norm / dot, x);
+
+    T ref = z.Norm();
+
+    x.MoveToAccelerator();
+    y.MoveToAccelerator();
+    z.MoveToAccelerator();
+    s.MoveToAccelerator();
+
+    // Same computation with the scalars kept on the backend
+    x.DotToScalar(y, &s, 0);
+    x.NormToScalar(&s, 1);
+
+    z.CopyFrom(y);
+    z.AddScaleRatio(x, static_cast<T>(-2), s, 0, 1);
+    z.ScaleRatioAdd(s, 1, 0, x);
+
+    z.NormToScalar(&s, 2);
+
+    s.MoveToHost();
+
+    ASSERT_NEAR(s[0], dot, 1e-4 * std::abs(dot));
+    ASSERT_NEAR(s[1], norm, 1e-4 * std::abs(norm));
+    ASSERT_NEAR(s[2], ref, 1e-4 * std::abs(ref));
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_vector_unique(void)
+{
+    int size = 1000;
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    for(int k = 0; k < 2; ++k)
+    {
+        LocalVector<T> x;
+        LocalVector<T> sorted;
+        LocalVector<T> unique;
+
+        x.Allocate("x", size);
+        sorted.Allocate("sorted", size);
+
+        for(int i = 0; i < size; ++i)
+        {
+            x[i] = static_cast<T>((7 * i) % 13);
+        }
+
+        // First pass on the host, second pass on the accelerator
+        if(k == 1)
+        {
+            x.MoveToAccelerator();
+            sorted.MoveToAccelerator();
+            unique.MoveToAccelerator();
+        }
+
+        x.Sort(&sorted, NULL);
+        sorted.Unique(&unique);
+
+        unique.MoveToHost();
+
+        ASSERT_EQ(unique.GetSize(), 13);
+
+        for(int i = 0; i < 13; ++i)
+        {
+            ASSERT_EQ(unique[i], static_cast<T>(i));
+        }
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+}
+
+template <typename T>
+void testing_local_vector_expression(void)
+{
+    int size = 1000;
+
+    T a = static_cast<T>(2);
+    T b = static_cast<T>(-3);
+    T c = static_cast<T>(0.5);
+
+    // Initialize rocALUTION
+    set_device_rocalution(device);
+    init_rocalution();
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+    LocalVector<T> w;
+    LocalVector<T> ref;
+
+    x.Allocate("x", size);
+    y.Allocate("y", size);
+    z.Allocate("z", size);
+    w.Allocate("w", size);
+    ref.Allocate("ref", size);
+
+    for(int i = 0; i < size; ++i)
+    {
+        y[i] = static_cast<T>(1 + i % 7);
+        z[i] = static_cast<T>(1 + i % 5);
+        w[i] = static_cast<T>(1 + i % 3);
+    }
+
+    // Host reference
+    ref.ScaleAddScale(static_cast<T>(0), y, a);
+    ref.ScaleAdd2(static_cast<T>(1), z, b, w, -c);
+
+    T dot  = ref.Dot(y);
+    T norm = ref.Norm();
+
+    for(int k = 0; k < 2; ++k)
+    {
+        // First pass on the host, second pass on the accelerator
+        if(k == 1)
+        {
+            x.MoveToAccelerator();
+            y.MoveToAccelerator();
+            z.MoveToAccelerator();
+            w.MoveToAccelerator();
+        }
+
+        x = a * y + b * z - c * w;
+
+        // The result may be an operand of its own expression
+        x = x - static_cast<T>(2) * y + y + y;
+
+        T sum_xy = Sum(x * y);
+        T sum_xx = Sum(-x * -x);
+
+        x.MoveToHost();
+
+        for(int i = 0; i < size; ++i)
+        {
+            ASSERT_NEAR(x[i], ref[i], 1e-5 * std::abs(ref[i]));
+        }
+
+        ASSERT_NEAR(sum_xy, dot, 1e-4 * std::abs(dot));
+        ASSERT_NEAR(sum_xx, norm * norm, 1e-4 * norm * norm);
+    }
+
     // Stop rocALUTION
     stop_rocalution();
 }
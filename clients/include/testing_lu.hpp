@@ -130,4 +130,91 @@ bool testing_lu(Arguments argus)
     return success;
 }
 
+template <typename T>
+bool testing_lu_backend_move(Arguments argus)
+{
+    int ndim = argus.size;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Factorize on the accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    LU<LocalMatrix<T>, LocalVector<T>, T> dls;
+
+    dls.Verbose(0);
+    dls.SetOperator(A);
+    dls.Build();
+
+    bool success = true;
+
+    // Solve on the accelerator
+    x.Zeros();
+    dls.Solve(b, &x);
+    x.ScaleAdd(-1.0, e);
+    success &= check_residual(x.Norm());
+
+    // The factors computed on the accelerator have to be valid on the host
+    dls.MoveToHost();
+    x.MoveToHost();
+    b.MoveToHost();
+    e.MoveToHost();
+
+    x.Zeros();
+    dls.Solve(b, &x);
+    x.ScaleAdd(-1.0, e);
+    success &= check_residual(x.Norm());
+
+    // Factorize on the host and solve on the accelerator
+    A.MoveToHost();
+    dls.Build();
+
+    dls.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    x.Zeros();
+    dls.Solve(b, &x);
+    x.ScaleAdd(-1.0, e);
+    success &= check_residual(x.Norm());
+
+    // Clean up
+    dls.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_QR_HPP
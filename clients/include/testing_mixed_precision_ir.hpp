@@ -0,0 +1,143 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_MIXED_PRECISION_IR_HPP
+#define TESTING_MIXED_PRECISION_IR_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static Solver<LocalMatrix<float>, LocalVector<float>, float>*
+    mixed_precision_ir_create(const std::string& name)
+{
+    if(name == "LU")
+    {
+        return new LU<LocalMatrix<float>, LocalVector<float>, float>;
+    }
+    else if(name == "ILU")
+    {
+        return new ILU<LocalMatrix<float>, LocalVector<float>, float>;
+    }
+
+    return NULL;
+}
+
+bool testing_mixed_precision_ir(Arguments argus)
+{
+    int         ndim          = argus.size;
+    std::string factorization = argus.precond;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<double> A;
+    LocalVector<double> x;
+    LocalVector<double> b;
+    LocalVector<double> e;
+
+    // Generate A
+    int*    csr_ptr = NULL;
+    int*    csr_col = NULL;
+    double* csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    bool success = true;
+
+    // Classical refinement converges only with an accurate factorization, GMRES-IR with both
+    int modes[] = {0, 30};
+
+    for(int gmres : modes)
+    {
+        if(gmres == 0 && factorization != "LU")
+        {
+            continue;
+        }
+
+        Solver<LocalMatrix<float>, LocalVector<float>, float>* f
+            = mixed_precision_ir_create(factorization);
+
+        if(f == NULL)
+        {
+            return false;
+        }
+
+        MixedPrecisionIR<LocalMatrix<double>,
+                         LocalVector<double>,
+                         double,
+                         LocalMatrix<float>,
+                         LocalVector<float>,
+                         float>
+            ls;
+
+        ls.Verbose(0);
+        ls.SetOperator(A);
+        ls.Set(*f);
+        ls.SetGMRES(gmres);
+        ls.Init(1e-12, 0.0, 1e+8, 1000);
+        ls.Build();
+
+        x.Zeros();
+        ls.Solve(b, &x);
+
+        // The residual is below the accuracy of the factorization
+        success &= (ls.GetCurrentResidual() <= 1e-12);
+
+        x.ScaleAdd(-1.0, e);
+        success &= (x.Norm() < 1e-8);
+
+        ls.Clear();
+        delete f;
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_MIXED_PRECISION_IR_HPP
@@ -118,50 +118,67 @@ bool testing_pairwise_amg(Arguments argus)
     p.SetCoarsestLevel(300);
     p.SetCycle(Kcycle);
     p.SetOperator(A);
-    p.SetManualSmoothers(true);
+    p.SetManualSmoothers(smoother != "Chebyshev");
     p.SetManualSolver(true);
-    p.BuildHierarchy();
 
-    // Get number of hierarchy levels
-    int levels = p.GetNumLevels();
+    // Default smoothers are built while the hierarchy is coarsened
+    p.SetOverlappedSetup(smoother == "Chebyshev");
+
+    // Get number of hierarchy levels, required for the manual smoothers
+    int levels = 0;
+
+    if(smoother != "Chebyshev")
+    {
+        p.BuildHierarchy();
+        levels = p.GetNumLevels();
+    }
 
     // Coarse grid solver
     CG<LocalMatrix<T>, LocalVector<T>, T> cgs;
     cgs.Verbose(0);
 
     // Smoother for each level
-    IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>** sm
-        = new IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
-
-    Preconditioner<LocalMatrix<T>, LocalVector<T>, T>** smooth
-        = new Preconditioner<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
+    IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>** sm     = NULL;
+    Preconditioner<LocalMatrix<T>, LocalVector<T>, T>**        smooth = NULL;
 
-    for(int i = 0; i < levels - 1; ++i)
+    if(smoother == "Chebyshev")
     {
-        FixedPoint<LocalMatrix<T>, LocalVector<T>, T>* fp
-            = new FixedPoint<LocalMatrix<T>, LocalVector<T>, T>;
-        sm[i] = fp;
+        // Jacobi preconditioned Chebyshev smoothers, built by the AMG class
+        p.SetDefaultSmoother(ChebyshevSmoother);
+    }
+    else
+    {
+        sm     = new IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
+        smooth = new Preconditioner<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
 
-        if(smoother == "Jacobi")
-        {
-            smooth[i] = new Jacobi<LocalMatrix<T>, LocalVector<T>, T>;
-            fp->SetRelaxation(0.67);
-        }
-        else if(smoother == "MCGS")
+        for(int i = 0; i < levels - 1; ++i)
         {
-            smooth[i] = new MultiColoredGS<LocalMatrix<T>, LocalVector<T>, T>;
-            fp->SetRelaxation(1.3);
+            FixedPoint<LocalMatrix<T>, LocalVector<T>, T>* fp
+                = new FixedPoint<LocalMatrix<T>, LocalVector<T>, T>;
+            sm[i] = fp;
+
+            if(smoother == "Jacobi")
+            {
+                smooth[i] = new Jacobi<LocalMatrix<T>, LocalVector<T>, T>;
+                fp->SetRelaxation(0.67);
+            }
+            else if(smoother == "MCGS")
+            {
+                smooth[i] = new MultiColoredGS<LocalMatrix<T>, LocalVector<T>, T>;
+                fp->SetRelaxation(1.3);
+            }
+            else if(smoother == "MCILU")
+                smooth[i] = new MultiColoredILU<LocalMatrix<T>, LocalVector<T>, T>;
+            else
+                return false;
+
+            sm[i]->SetPreconditioner(*(smooth[i]));
+            sm[i]->Verbose(0);
         }
-        else if(smoother == "MCILU")
-            smooth[i] = new MultiColoredILU<LocalMatrix<T>, LocalVector<T>, T>;
-        else
-            return false;
 
-        sm[i]->SetPreconditioner(*(smooth[i]));
-        sm[i]->Verbose(0);
+        p.SetSmoother(sm);
     }
 
-    p.SetSmoother(sm);
     p.SetSolver(cgs);
     p.SetSmootherPreIter(pre_iter);
     p.SetSmootherPostIter(post_iter);
@@ -204,13 +221,16 @@ bool testing_pairwise_amg(Arguments argus)
     // Stop rocALUTION platform
     stop_rocalution();
 
-    for(int i = 0; i < levels - 1; ++i)
+    if(sm != NULL)
     {
-        delete smooth[i];
-        delete sm[i];
+        for(int i = 0; i < levels - 1; ++i)
+        {
+            delete smooth[i];
+            delete sm[i];
+        }
+        delete[] smooth;
+        delete[] sm;
     }
-    delete[] smooth;
-    delete[] sm;
 
     return success;
 }
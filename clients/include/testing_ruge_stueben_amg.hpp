@@ -52,6 +52,7 @@ bool testing_ruge_stueben_amg(Arguments argus)
     int          cycle          = argus.cycle;
     bool         scaling        = argus.ordering;
     bool         rebuildnumeric = argus.rebuildnumeric;
+    bool         fused          = argus.fused;
 
     // Initialize rocALUTION platform
     set_device_rocalution(device);
@@ -120,9 +121,10 @@ bool testing_ruge_stueben_amg(Arguments argus)
     p.SetCoarsestLevel(300);
     p.SetCycle(cycle);
     p.SetOperator(A);
-    p.SetManualSmoothers(true);
-    p.SetManualSolver(true);
+    p.SetManualSmoothers(smoother != "Chebyshev");
+    p.SetManualSolver(smoother != "Chebyshev");
     p.SetScaling(scaling);
+    p.SetFusedLevelOperations(fused);
     p.BuildHierarchy();
 
     // Get number of hierarchy levels
@@ -133,37 +135,48 @@ bool testing_ruge_stueben_amg(Arguments argus)
     cgs.Verbose(0);
 
     // Smoother for each level
-    IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>** sm
-        = new IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
+    IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>** sm     = NULL;
+    Preconditioner<LocalMatrix<T>, LocalVector<T>, T>**        smooth = NULL;
 
-    Preconditioner<LocalMatrix<T>, LocalVector<T>, T>** smooth
-        = new Preconditioner<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
-
-    for(int i = 0; i < levels - 1; ++i)
+    if(smoother == "Chebyshev")
     {
-        FixedPoint<LocalMatrix<T>, LocalVector<T>, T>* fp
-            = new FixedPoint<LocalMatrix<T>, LocalVector<T>, T>;
-        sm[i] = fp;
+        // Jacobi preconditioned Chebyshev smoothers and a direct coarse grid solver,
+        // built by the AMG class
+        p.SetDefaultSmoother(ChebyshevSmoother);
+        p.SetDefaultCoarseSolver(DirectCoarseSolver);
+    }
+    else
+    {
+        sm     = new IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
+        smooth = new Preconditioner<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
 
-        if(smoother == "Jacobi")
+        for(int i = 0; i < levels - 1; ++i)
         {
-            smooth[i] = new Jacobi<LocalMatrix<T>, LocalVector<T>, T>;
-            fp->SetRelaxation(0.67);
+            FixedPoint<LocalMatrix<T>, LocalVector<T>, T>* fp
+                = new FixedPoint<LocalMatrix<T>, LocalVector<T>, T>;
+            sm[i] = fp;
+
+            if(smoother == "Jacobi")
+            {
+                smooth[i] = new Jacobi<LocalMatrix<T>, LocalVector<T>, T>;
+                fp->SetRelaxation(0.67);
+            }
+            else if(smoother == "MCGS")
+            {
+                smooth[i] = new MultiColoredGS<LocalMatrix<T>, LocalVector<T>, T>;
+                fp->SetRelaxation(1.3);
+            }
+            else
+                return false;
+
+            sm[i]->SetPreconditioner(*(smooth[i]));
+            sm[i]->Verbose(0);
         }
-        else if(smoother == "MCGS")
-        {
-            smooth[i] = new MultiColoredGS<LocalMatrix<T>, LocalVector<T>, T>;
-            fp->SetRelaxation(1.3);
-        }
-        else
-            return false;
 
-        sm[i]->SetPreconditioner(*(smooth[i]));
-        sm[i]->Verbose(0);
+        p.SetSmoother(sm);
+        p.SetSolver(cgs);
     }
 
-    p.SetSmoother(sm);
-    p.SetSolver(cgs);
     p.SetSmootherPreIter(pre_iter);
     p.SetSmootherPostIter(post_iter);
     p.SetOperatorFormat(format, format == BCSR ? argus.blockdim : 1);
@@ -188,6 +201,26 @@ bool testing_ruge_stueben_amg(Arguments argus)
         ls.ReBuildNumeric();
     }
 
+    // Setup time breakdown of each coarse level
+    bool setup_time_ok = true;
+
+    for(int i = 0; i < levels - 1; ++i)
+    {
+        double  coarsening;
+        double  interpolation;
+        double  transpose;
+        double  galerkin;
+        int64_t host_fallbacks;
+
+        p.GetSetupTime(i, &coarsening, &interpolation, &transpose, &galerkin, &host_fallbacks);
+
+        if(coarsening < 0.0 || interpolation < 0.0 || transpose < 0.0 || galerkin < 0.0
+           || host_fallbacks < 0)
+        {
+            setup_time_ok = false;
+        }
+    }
+
     // Matrix format
     A.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
 
@@ -197,7 +230,7 @@ bool testing_ruge_stueben_amg(Arguments argus)
     x.ScaleAdd(-1.0, e);
     T nrm2 = x.Norm();
 
-    bool success = check_residual(nrm2);
+    bool success = check_residual(nrm2) && setup_time_ok;
 
     // Clean up
     ls.Clear(); // TODO
@@ -205,13 +238,16 @@ bool testing_ruge_stueben_amg(Arguments argus)
     // Stop rocALUTION platform
     stop_rocalution();
 
-    for(int i = 0; i < levels - 1; ++i)
+    if(sm != NULL)
     {
-        delete smooth[i];
-        delete sm[i];
+        for(int i = 0; i < levels - 1; ++i)
+        {
+            delete smooth[i];
+            delete sm[i];
+        }
+        delete[] smooth;
+        delete[] sm;
     }
-    delete[] smooth;
-    delete[] sm;
 
     return success;
 }
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -29,6 +29,9 @@
 
 #include <rocalution/rocalution.hpp>
 
+#include <cstdio>
+#include <sstream>
+
 using namespace rocalution;
 
 static bool check_residual(float res)
@@ -53,7 +56,10 @@ bool testing_saamg(Arguments argus)
     unsigned int format              = argus.format;
     int          cycle               = argus.cycle;
     bool         scaling             = argus.ordering;
-    bool         rebuildnumeric      = argus.rebuildnumeric;
+    int          rebuildnumeric      = argus.rebuildnumeric;
+    bool         aggressive          = argus.aggressive;
+    bool         lowmemory           = argus.lowmemory;
+    bool         hybrid              = argus.hybrid;
 
     // Initialize rocALUTION platform
     set_device_rocalution(device);
@@ -94,6 +100,21 @@ bool testing_saamg(Arguments argus)
         {
             csr_val2[i] = csr_val[i];
         }
+
+        if(rebuildnumeric >= 3)
+        {
+            // Localized change, the diagonal of the first rows is increased
+            for(int i = 0; i < nrow / 8 + 1; ++i)
+            {
+                for(int j = csr_ptr[i]; j < csr_ptr[i + 1]; ++j)
+                {
+                    if(csr_col[j] == i)
+                    {
+                        csr_val2[j] += static_cast<T>(1);
+                    }
+                }
+            }
+        }
     }
 
     A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
@@ -135,6 +156,19 @@ bool testing_saamg(Arguments argus)
     p.SetManualSmoothers(true);
     p.SetManualSolver(true);
     p.SetScaling(scaling);
+    p.SetAggressiveCoarsening(aggressive);
+    p.SetLowMemorySetup(lowmemory);
+
+    if(hybrid == true)
+    {
+        p.SetCycleSwitchSize(100);
+        p.SetKcycleFixedCoefficients(1000, static_cast<T>(1), static_cast<T>(1));
+    }
+
+    if(cycle == Acycle)
+    {
+        p.SetConcurrentLevels(2);
+    }
 
     if(coarsening_strategy == "Greedy")
     {
@@ -196,17 +230,77 @@ bool testing_saamg(Arguments argus)
 
     ls.Init(1e-8, 0.0, 1e+8, 10000);
 
+    if(rebuildnumeric == 4)
+    {
+        // The setup of an unchanged operator is skipped
+        p.SetSkipUnchangedBuild(true);
+    }
+
     ls.Build();
 
+    bool hash_ok = true;
+
     if(rebuildnumeric)
     {
+        uint64_t hash = A.Hash();
+
+        if(rebuildnumeric == 4)
+        {
+            // Host and accelerator hashes agree
+            A.MoveToHost();
+            hash_ok = A.Hash() == hash;
+            A.MoveToAccelerator();
+
+            ls.ReBuildNumeric();
+        }
+
+        if(rebuildnumeric == 2)
+        {
+            // Frozen hierarchy, the first rebuild caches the Galerkin product structures
+            // and the second one only recomputes their values
+            p.SetFrozenHierarchy(true);
+            A.Scale(static_cast<T>(2));
+            ls.ReBuildNumeric();
+        }
+
+        if(rebuildnumeric == 3)
+        {
+            // Frozen hierarchy, the first rebuild caches the Galerkin product structures
+            p.SetFrozenHierarchy(true);
+            ls.ReBuildNumeric();
+        }
+
         A.UpdateValuesCSR(csr_val2);
         delete[] csr_val2;
 
         // b2 = A * 1
         A.Apply(e, &b2);
 
-        ls.ReBuildNumeric();
+        // Modified values change the hash
+        if(rebuildnumeric >= 3)
+        {
+            hash_ok = hash_ok && A.Hash() != hash;
+        }
+
+        if(rebuildnumeric == 3)
+        {
+            // Only the first rows have changed
+            int  nmod = nrow / 8 + 1;
+            int* rows = new int[nmod];
+
+            for(int i = 0; i < nmod; ++i)
+            {
+                rows[i] = i;
+            }
+
+            p.UpdateHierarchy(nmod, rows);
+
+            delete[] rows;
+        }
+        else
+        {
+            ls.ReBuildNumeric();
+        }
     }
 
     // Matrix format
@@ -218,7 +312,7 @@ bool testing_saamg(Arguments argus)
     x.ScaleAdd(-1.0, e);
     T nrm2 = x.Norm();
 
-    bool success = check_residual(nrm2);
+    bool success = check_residual(nrm2) && hash_ok;
 
     // Clean up
     ls.Clear(); // TODO
@@ -242,4 +336,526 @@ bool testing_saamg(Arguments argus)
     return success;
 }
 
+// SAAMG test problem, a 2D Laplacian with blockdim coupled unknowns per grid point,
+// A = L x B with B = 4 I + (1 - I), b = A * 1 and a random initial guess
+template <typename T>
+void generate_saamg_problem(int             ndim,
+                            int             blockdim,
+                            LocalMatrix<T>* A,
+                            LocalVector<T>* x,
+                            LocalVector<T>* b,
+                            LocalVector<T>* e)
+{
+    // Generate the scalar Laplacian
+    int* lap_ptr = NULL;
+    int* lap_col = NULL;
+    T*   lap_val = NULL;
+
+    int nnode = gen_2d_laplacian(ndim, &lap_ptr, &lap_col, &lap_val);
+
+    if(blockdim == 1)
+    {
+        A->SetDataPtrCSR(&lap_ptr, &lap_col, &lap_val, "A", lap_ptr[nnode], nnode, nnode);
+    }
+    else
+    {
+        int  nrow    = nnode * blockdim;
+        int  nnz     = lap_ptr[nnode] * blockdim * blockdim;
+        int* csr_ptr = new int[nrow + 1];
+        int* csr_col = new int[nnz];
+        T*   csr_val = new T[nnz];
+
+        csr_ptr[0] = 0;
+        for(int i = 0, idx = 0; i < nnode; ++i)
+        {
+            for(int r = 0; r < blockdim; ++r)
+            {
+                for(int j = lap_ptr[i]; j < lap_ptr[i + 1]; ++j)
+                {
+                    for(int c = 0; c < blockdim; ++c)
+                    {
+                        csr_col[idx] = lap_col[j] * blockdim + c;
+                        csr_val[idx] = lap_val[j] * static_cast<T>(r == c ? 4 : 1);
+                        ++idx;
+                    }
+                }
+
+                csr_ptr[i * blockdim + r + 1] = idx;
+            }
+        }
+
+        delete[] lap_ptr;
+        delete[] lap_col;
+        delete[] lap_val;
+
+        A->SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+    }
+
+    // Move data to accelerator
+    A->MoveToAccelerator();
+    x->MoveToAccelerator();
+    b->MoveToAccelerator();
+    e->MoveToAccelerator();
+
+    // Allocate x, b and e
+    x->Allocate("x", A->GetN());
+    b->Allocate("b", A->GetM());
+    e->Allocate("e", A->GetN());
+
+    // b = A * 1
+    e->Ones();
+    A->Apply(*e, b);
+
+    // Random initial guess
+    x->SetRandomUniform(12345ULL, -4.0, 6.0);
+}
+
+// SAAMG preconditioned CG with one of the options
+// - "MixedPrecision": hierarchy in single precision for a solver in double precision
+// - "Block": block-aware aggregation with coarse operators in BCSR format
+// - "NullSpace": near null space of a constant per component and a grid coordinate
+// - "Truncation": truncated and energy minimized prolongations
+// - "Sparsification": non-Galerkin coarse operators, compared to Galerkin ones
+// - "HierarchyIO": saved hierarchy, compared to the solve with the loaded hierarchy
+// The hierarchy is rebuilt for scaled values before each solve
+template <typename T>
+bool testing_saamg_option(Arguments argus, const std::string& option)
+{
+    int         ndim                = argus.size;
+    std::string coarsening_strategy = argus.coarsening_strategy;
+    bool        aggressive          = argus.aggressive;
+
+    CoarseningStrategy strat;
+
+    if(coarsening_strategy == "Greedy")
+    {
+        strat = CoarseningStrategy::Greedy;
+    }
+    else if(coarsening_strategy == "PMIS")
+    {
+        strat = CoarseningStrategy::PMIS;
+    }
+    else
+    {
+        return false;
+    }
+
+    // Block options couple several unknowns per grid point, on a coarser grid
+    bool block    = (option == "Block" || option == "NullSpace");
+    int  blockdim = block ? argus.blockdim : 1;
+
+    ndim /= blockdim;
+
+    // Near null space, one constant vector per component and the grid coordinate
+    int num_null = blockdim + 1;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    bool success = true;
+
+    if(option == "MixedPrecision")
+    {
+        // rocALUTION structures
+        LocalMatrix<double> A;
+        LocalVector<double> x;
+        LocalVector<double> b;
+        LocalVector<double> e;
+
+        generate_saamg_problem(ndim, 1, &A, &x, &b, &e);
+
+        // Hierarchy in lower precision
+        SAAMG<LocalMatrix<float>, LocalVector<float>, float> amg;
+        amg.SetCoarsestLevel(10);
+        amg.SetCoarseningStrategy(strat);
+        amg.SetAggressiveCoarsening(aggressive);
+        amg.InitMaxIter(1);
+        amg.Verbose(0);
+
+        MixedPrecisionPreconditioner<LocalMatrix<double>,
+                                     LocalVector<double>,
+                                     double,
+                                     LocalMatrix<float>,
+                                     LocalVector<float>,
+                                     float>
+            p;
+        p.Set(amg);
+
+        CG<LocalMatrix<double>, LocalVector<double>, double> ls;
+        ls.Verbose(0);
+        ls.SetOperator(A);
+        ls.SetPreconditioner(p);
+        ls.Init(1e-10, 0.0, 1e+8, 10000);
+        ls.Build();
+
+        // Updated values with the same structure, b = 2 * A * 1
+        A.Scale(2.0);
+        b.Scale(2.0);
+        ls.ReBuildNumeric();
+
+        ls.Solve(b, &x);
+
+        // Verify solution
+        x.ScaleAdd(-1.0, e);
+        double nrm2 = x.Norm();
+
+        success = check_residual(nrm2);
+
+        if(!success)
+        {
+            std::cout << "nrm2: " << nrm2 << std::endl;
+        }
+
+        // Clean up
+        ls.Clear();
+
+        // Stop rocALUTION platform
+        stop_rocalution();
+
+        return success;
+    }
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    generate_saamg_problem(ndim, blockdim, &A, &x, &b, &e);
+
+    int64_t nrow = A.GetM();
+    int64_t nnz  = A.GetNnz();
+
+    if(option == "Block")
+    {
+        // The diagonal of the BCSR matrix has to match the one of the CSR matrix
+        LocalMatrix<T> A_bcsr;
+        LocalVector<T> diag;
+        LocalVector<T> diag_bcsr;
+
+        A_bcsr.CloneFrom(A);
+        A_bcsr.ConvertTo(BCSR, blockdim);
+
+        diag.CloneBackend(A);
+        diag_bcsr.CloneBackend(A);
+
+        A.ExtractInverseDiagonal(&diag);
+        A_bcsr.ExtractInverseDiagonal(&diag_bcsr);
+
+        diag.ScaleAdd(-1.0, diag_bcsr);
+
+        success = check_residual(diag.Norm());
+    }
+    else if(option == "Truncation")
+    {
+        // Truncation to a single entry per row has to keep the row sums
+        LocalMatrix<T> P;
+        P.CloneFrom(A);
+        P.AMGProlongTruncate(0.0, 1);
+
+        LocalVector<T> r;
+        r.CloneFrom(b);
+
+        P.Apply(e, &r);
+        r.ScaleAdd(-1.0, b);
+
+        success = (P.GetNnz() == nrow) && check_residual(r.Norm());
+    }
+    else if(option == "Sparsification")
+    {
+        // Lumping all off-diagonal entries has to keep the row sums
+        LocalMatrix<T> S;
+        S.CloneFrom(A);
+        S.CompressLumped(0.5);
+
+        LocalVector<T> r;
+        r.CloneFrom(b);
+
+        S.Apply(e, &r);
+        r.ScaleAdd(-1.0, b);
+
+        success = (S.GetNnz() == nrow) && check_residual(r.Norm());
+
+        // Nothing is dropped below the threshold
+        S.CloneFrom(A);
+        S.CompressLumped(0.2);
+
+        success = success && (S.GetNnz() == nnz);
+    }
+
+    const std::string filename = "rocalution_amg_hierarchy_test";
+
+    // Sparsification and hierarchy output compare two solves
+    int npass = (option == "Sparsification" || option == "HierarchyIO") ? 2 : 1;
+
+    int    iter[2];
+    int    levels[2];
+    double op_complexity[2];
+    double grid_complexity;
+
+    for(int pass = 0; pass < npass; ++pass)
+    {
+        // Random initial guess
+        x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+        // Solver
+        CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+        // AMG
+        SAAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+
+        p.SetCoarsestLevel(10 * (option == "NullSpace" ? num_null : blockdim));
+        p.SetCoarseningStrategy(strat);
+        p.SetAggressiveCoarsening(aggressive);
+        p.InitMaxIter(1);
+        p.Verbose(0);
+
+        if(block == true)
+        {
+            p.SetBlockDimension(blockdim);
+        }
+
+        if(option == "Block")
+        {
+            p.SetOperatorFormat(BCSR, blockdim);
+        }
+        else if(option == "NullSpace")
+        {
+            // Each aggregate carries num_null coarse dofs
+            LocalVector<T>* null_space = new LocalVector<T>[num_null];
+
+            for(int k = 0; k < num_null; ++k)
+            {
+                null_space[k].Allocate("null space", nrow);
+
+                T* data = NULL;
+                null_space[k].LeaveDataPtr(&data);
+
+                for(int64_t i = 0; i < nrow; ++i)
+                {
+                    int64_t node = i / blockdim;
+
+                    if(k < blockdim)
+                    {
+                        data[i] = static_cast<T>(i % blockdim == k ? 1 : 0);
+                    }
+                    else
+                    {
+                        data[i] = static_cast<T>(node % ndim) / static_cast<T>(ndim);
+                    }
+                }
+
+                null_space[k].SetDataPtr(&data, "null space", nrow);
+                null_space[k].MoveToAccelerator();
+            }
+
+            p.SetNearNullSpace(num_null, null_space);
+
+            delete[] null_space;
+        }
+        else if(option == "Truncation")
+        {
+            p.SetProlongTruncation(0.2, 4);
+            p.SetEnergyMinimization(2);
+        }
+        else if(option == "Sparsification")
+        {
+            p.SetFrozenHierarchy(true);
+
+            if(pass == 1)
+            {
+                // The lumping keeps the row sums, thresholds that drop all off-diagonal
+                // entries of a row would leave a zero diagonal
+                p.SetCoarseSparsification(0.02);
+                p.SetCoarseSparsification(0.05, 1);
+            }
+        }
+        else if(option == "HierarchyIO" && pass == 1)
+        {
+            p.SetOperator(A);
+            p.LoadHierarchy(filename);
+        }
+
+        ls.Verbose(0);
+        ls.SetOperator(A);
+        ls.SetPreconditioner(p);
+        ls.Init(1e-8, 0.0, 1e+8, 10000);
+        ls.Build();
+
+        if(option == "HierarchyIO" && pass == 0)
+        {
+            p.SaveHierarchy(filename);
+        }
+
+        p.GetComplexity(&op_complexity[pass], &grid_complexity);
+        levels[pass] = p.GetNumLevels();
+
+        // Updated values with the same structure, b = 2 * A * 1
+        A.Scale(static_cast<T>(2));
+        b.Scale(static_cast<T>(2));
+        ls.ReBuildNumeric();
+
+        ls.Solve(b, &x);
+
+        iter[pass] = ls.GetIterationCount();
+
+        A.Scale(static_cast<T>(0.5));
+        b.Scale(static_cast<T>(0.5));
+
+        // Verify solution
+        x.ScaleAdd(-1.0, e);
+        T nrm2 = x.Norm();
+
+        success = success && check_residual(nrm2);
+
+        if(!success)
+        {
+            std::cout << "nrm2: " << nrm2 << std::endl;
+        }
+
+        // Clean up
+        ls.Clear();
+    }
+
+    if(option == "Sparsification")
+    {
+        // Sparsification reduces the operator complexity
+        success = success && (op_complexity[1] < op_complexity[0]);
+    }
+    else if(option == "HierarchyIO")
+    {
+        // The loaded hierarchy is identical to the saved one
+        success = success && (levels[1] == levels[0]) && (iter[1] == iter[0]);
+
+        // Remove the hierarchy files
+        for(int i = 0; i < levels[0] - 1; ++i)
+        {
+            const char* types[] = {"op", "pro", "res"};
+
+            for(int j = 0; j < 3; ++j)
+            {
+                std::ostringstream name;
+                name << filename << ".level." << i << "." << types[j];
+
+                std::remove(name.str().c_str());
+            }
+        }
+
+        std::remove(filename.c_str());
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_saamg_multi(Arguments argus)
+{
+    int ndim = argus.size;
+    int nrhs = argus.nrhs;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T>      A;
+    LocalMultiVector<T> X;
+    LocalMultiVector<T> B;
+    LocalMultiVector<T> E;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    X.MoveToAccelerator();
+    B.MoveToAccelerator();
+    E.MoveToAccelerator();
+
+    // Allocate X, B and E
+    X.Allocate("X", A.GetN(), nrhs);
+    B.Allocate("B", A.GetM(), nrhs);
+    E.Allocate("E", A.GetN(), nrhs);
+
+    // B = A * E
+    E.SetRandomUniform(12345ULL, -1.0, 1.0);
+    A.Apply(E, &B);
+
+    bool success = true;
+
+    for(int precond = 0; precond < 2; ++precond)
+    {
+        // Zero initial guess
+        X.Zeros();
+
+        SAAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+
+        p.SetCoarsestLevel(10);
+        p.Verbose(0);
+
+        if(precond == 0)
+        {
+            // Block V-cycles until all columns have converged
+            p.SetOperator(A);
+            p.Init(1e-8, 0.0, 1e+8, 10000);
+            p.Build();
+
+            p.SolveMulti(B, &X);
+
+            p.Clear();
+        }
+        else
+        {
+            // One block V-cycle per block CG iteration
+            BlockCG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+            p.InitMaxIter(1);
+
+            ls.Verbose(0);
+            ls.SetOperator(A);
+            ls.SetPreconditioner(p);
+            ls.Init(1e-8, 0.0, 1e+8, 10000);
+            ls.Build();
+
+            ls.Solve(B, &X);
+
+            ls.Clear();
+        }
+
+        // Verify solution of each right-hand side
+        X.ScaleAdd(-1.0, E);
+        X.MoveToHost();
+
+        for(int j = 0; j < nrhs; ++j)
+        {
+            T nrm2 = static_cast<T>(0);
+
+            for(int i = 0; i < nrow; ++i)
+            {
+                nrm2 += X(i, j) * X(i, j);
+            }
+
+            success = success && check_residual(std::sqrt(nrm2));
+        }
+
+        X.MoveToAccelerator();
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_SAAMG_HPP
@@ -0,0 +1,218 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_SHARED_PRECONDITIONER_HPP
+#define TESTING_SHARED_PRECONDITIONER_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-3);
+}
+
+template <typename T>
+static Solver<LocalMatrix<T>, LocalVector<T>, T>* shared_precond_create(const std::string& name)
+{
+    if(name == "SAAMG")
+    {
+        SAAMG<LocalMatrix<T>, LocalVector<T>, T>* p
+            = new SAAMG<LocalMatrix<T>, LocalVector<T>, T>;
+        p->InitMaxIter(1);
+        p->Verbose(0);
+
+        return p;
+    }
+    else if(name == "ILU")
+    {
+        return new ILU<LocalMatrix<T>, LocalVector<T>, T>;
+    }
+
+    return NULL;
+}
+
+template <typename T>
+bool testing_shared_preconditioner(Arguments argus)
+{
+    int         ndim    = argus.size;
+    std::string precond = argus.precond;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x1;
+    LocalVector<T> x2;
+    LocalVector<T> b1;
+    LocalVector<T> b2;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x1.MoveToAccelerator();
+    x2.MoveToAccelerator();
+    b1.MoveToAccelerator();
+    b2.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x1.Allocate("x1", A.GetN());
+    x2.Allocate("x2", A.GetN());
+    b1.Allocate("b1", A.GetM());
+    b2.Allocate("b2", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b1 = A * 1, b2 = A * 2
+    e.Ones();
+    A.Apply(e, &b1);
+    b2.CopyFrom(b1);
+    b2.Scale(static_cast<T>(2));
+
+    // Reference solve with a preconditioner of its own
+    Solver<LocalMatrix<T>, LocalVector<T>, T>* ref = shared_precond_create<T>(precond);
+
+    if(ref == NULL)
+    {
+        return false;
+    }
+
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls_ref;
+
+    ls_ref.Verbose(0);
+    ls_ref.SetOperator(A);
+    ls_ref.SetPreconditioner(*ref);
+    ls_ref.Init(1e-8, 0.0, 1e+8, 10000);
+    ls_ref.Build();
+
+    x1.Zeros();
+    ls_ref.Solve(b1, &x1);
+
+    int iter = ls_ref.GetIterationCount();
+
+    ls_ref.Clear();
+    delete ref;
+
+    // The shared preconditioner is built once by its owner
+    Solver<LocalMatrix<T>, LocalVector<T>, T>* p = shared_precond_create<T>(precond);
+
+    p->SetOperator(A);
+    p->Build();
+
+    SharedPreconditioner<LocalMatrix<T>, LocalVector<T>, T> p1;
+    SharedPreconditioner<LocalMatrix<T>, LocalVector<T>, T> p2;
+
+    p1.Set(*p);
+    p2.Set(*p);
+
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls1;
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls2;
+
+    ls1.Verbose(0);
+    ls1.SetOperator(A);
+    ls1.SetPreconditioner(p1);
+    ls1.Init(1e-8, 0.0, 1e+8, 10000);
+    ls1.Build();
+
+    ls2.Verbose(0);
+    ls2.SetOperator(A);
+    ls2.SetPreconditioner(p2);
+    ls2.Init(1e-8, 0.0, 1e+8, 10000);
+    ls2.Build();
+
+    // Solves in sequence
+    x1.Zeros();
+    x2.Zeros();
+    ls1.Solve(b1, &x1);
+    ls2.Solve(b2, &x2);
+
+    bool success = (ls1.GetIterationCount() == iter);
+    success &= (ls2.GetIterationCount() == iter);
+
+    x1.ScaleAdd(-1.0, e);
+    x2.ScaleAdd(static_cast<T>(-0.5), e);
+    success &= check_residual(x1.Norm());
+    success &= check_residual(x2.Norm());
+
+    // Concurrent solves, the application of the preconditioner is serialized
+    SolveHandle handle1;
+    SolveHandle handle2;
+
+    x1.Zeros();
+    x2.Zeros();
+    ls1.SolveAsync(b1, &x1, &handle1);
+    ls2.SolveAsync(b2, &x2, &handle2);
+
+    handle1.Wait();
+    handle2.Wait();
+
+    success &= (handle1.GetIterationCount() == iter);
+    success &= (handle2.GetIterationCount() == iter);
+
+    x1.ScaleAdd(-1.0, e);
+    x2.ScaleAdd(static_cast<T>(-0.5), e);
+    success &= check_residual(x1.Norm());
+    success &= check_residual(x2.Norm());
+
+    // Clearing a solver does not clear the shared preconditioner
+    ls1.Clear();
+
+    x2.Zeros();
+    ls2.Solve(b2, &x2);
+
+    success &= (ls2.GetIterationCount() == iter);
+
+    // Clean up
+    ls2.Clear();
+
+    p->Clear();
+    delete p;
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_SHARED_PRECONDITIONER_HPP
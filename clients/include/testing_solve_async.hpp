@@ -0,0 +1,189 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_SOLVE_ASYNC_HPP
+#define TESTING_SOLVE_ASYNC_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-3);
+}
+
+template <typename T>
+bool testing_solve_async(Arguments argus)
+{
+    int          ndim   = argus.size;
+    std::string  solver = argus.solver;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Solver
+    IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>* ls;
+
+    if(solver == "CG")
+    {
+        ls = new CG<LocalMatrix<T>, LocalVector<T>, T>;
+    }
+    else if(solver == "BiCGStab")
+    {
+        ls = new BiCGStab<LocalMatrix<T>, LocalVector<T>, T>;
+    }
+    else if(solver == "GMRES")
+    {
+        ls = new GMRES<LocalMatrix<T>, LocalVector<T>, T>;
+    }
+    else
+        return false;
+
+    Jacobi<LocalMatrix<T>, LocalVector<T>, T> p;
+
+    ls->Verbose(0);
+    ls->SetOperator(A);
+    ls->SetPreconditioner(p);
+
+    ls->Init(1e-8, 0.0, 1e+8, 10000);
+    ls->Build();
+
+    // Matrix format
+    A.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
+
+    // Blocking reference solve
+    x.Zeros();
+    ls->Solve(b, &x);
+
+    int iter = ls->GetIterationCount();
+
+    SolveHandle handle;
+
+    bool success = (handle.Test() == true);
+
+    // Assemble the next system on the host, while the solve is running
+    x.Zeros();
+    ls->SolveAsync(b, &x, &handle);
+
+    LocalMatrix<T> B;
+
+    csr_ptr = NULL;
+    csr_col = NULL;
+    csr_val = NULL;
+
+    nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    nnz  = csr_ptr[nrow];
+
+    B.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "B", nnz, nrow, nrow);
+    B.MoveToAccelerator();
+    B.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
+
+    // The progress can be queried at any time
+    success &= (handle.GetIterationCount() >= 0);
+    success &= (handle.GetCurrentResidual() >= 0.0);
+
+    handle.Wait();
+
+    success &= (handle.Test() == true);
+    success &= (handle.GetIterationCount() == iter);
+    success &= (handle.GetIterationCount() == ls->GetIterationCount());
+    success &= (handle.GetCurrentResidual() == ls->GetCurrentResidual());
+    success &= (handle.GetSolverStatus() == ls->GetSolverStatus());
+    success &= (handle.GetSolverStatus() > 0);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    success &= check_residual(nrm2);
+
+    // Reuse the handle for the next system
+    ls->ResetOperator(B);
+
+    x.Zeros();
+    B.Apply(e, &b);
+
+    ls->SolveAsync(b, &x, &handle);
+    handle.Wait();
+
+    success &= (handle.GetIterationCount() == iter);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    nrm2 = x.Norm();
+
+    success &= check_residual(nrm2);
+
+    // Clean up
+    ls->Clear();
+    delete ls;
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_SOLVE_ASYNC_HPP
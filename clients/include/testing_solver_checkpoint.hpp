@@ -0,0 +1,212 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_SOLVER_CHECKPOINT_HPP
+#define TESTING_SOLVER_CHECKPOINT_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+#include <cstdio>
+#include <sstream>
+#include <type_traits>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-5);
+}
+
+template <typename T>
+static IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>*
+    create_checkpoint_solver(const std::string& solver)
+{
+    if(solver == "GMRES")
+    {
+        GMRES<LocalMatrix<T>, LocalVector<T>, T>* gmres
+            = new GMRES<LocalMatrix<T>, LocalVector<T>, T>;
+
+        gmres->SetBasisSize(10);
+
+        return gmres;
+    }
+
+    return new CG<LocalMatrix<T>, LocalVector<T>, T>;
+}
+
+// Solve with max_iter iterations, checkpoint or resume from filename
+template <typename T>
+static int checkpoint_solve(const std::string&    solver,
+                            const std::string&    precond,
+                            const LocalMatrix<T>& A,
+                            const LocalVector<T>& b,
+                            LocalVector<T>*       x,
+                            int                   max_iter,
+                            const std::string&    checkpoint,
+                            const std::string&    resume,
+                            int*                  status)
+{
+    IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>* ls
+        = create_checkpoint_solver<T>(solver);
+
+    Jacobi<LocalMatrix<T>, LocalVector<T>, T> p;
+
+    // Relative tolerance within the precision
+    const double tol = std::is_same<T, float>::value ? 1e-5 : 1e-10;
+
+    ls->Verbose(0);
+    ls->SetOperator(A);
+    ls->Init(0.0, tol, 1e+8, max_iter);
+
+    if(precond == "Jacobi")
+    {
+        ls->SetPreconditioner(p);
+    }
+
+    if(checkpoint.empty() == false)
+    {
+        ls->SetCheckpoint(checkpoint, 5);
+    }
+
+    if(resume.empty() == false)
+    {
+        ls->Resume(resume);
+    }
+
+    ls->Build();
+
+    x->Zeros();
+    ls->Solve(b, x);
+
+    int iter = ls->GetIterationCount();
+    *status  = ls->GetSolverStatus();
+
+    ls->Clear();
+    delete ls;
+
+    return iter;
+}
+
+template <typename T>
+bool testing_solver_checkpoint(Arguments argus)
+{
+    int         ndim    = argus.size;
+    std::string solver  = argus.solver;
+    std::string precond = argus.precond;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    const std::string filename = "rocalution_checkpoint_test";
+
+    int status;
+
+    // Uninterrupted solve
+    int ref_iter = checkpoint_solve(solver, precond, A, b, &x, 10000, "", "", &status);
+
+    bool success = (status == 2);
+
+    // Solve interrupted after half of the iterations
+    int half = ref_iter / 2;
+    int iter = checkpoint_solve(solver, precond, A, b, &x, half, filename, "", &status);
+
+    success = success && (iter == half) && (status == 4);
+
+    // Continue from the last checkpoint
+    iter = checkpoint_solve(solver, precond, A, b, &x, 10000, "", filename, &status);
+
+    // The resumed solve continues the iteration count, CG repeats the recurrence
+    success = success && (status == 2) && (iter > half);
+
+    if(solver == "CG")
+    {
+        success = success && (std::abs(iter - ref_iter) <= 2);
+    }
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    success = success && check_residual(x.Norm());
+
+    // Remove the checkpoint files
+    for(int slot = 0; slot < 2; ++slot)
+    {
+        const char* names[] = {"0", "1", "2", "scalars"};
+
+        for(int i = 0; i < 4; ++i)
+        {
+            std::ostringstream name;
+            name << filename << ".0." << slot << "." << names[i] << ".bin";
+
+            std::remove(name.str().c_str());
+        }
+    }
+
+    std::remove((filename + ".0").c_str());
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_SOLVER_CHECKPOINT_HPP
@@ -0,0 +1,206 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_SOLVER_WORKSPACE_HPP
+#define TESTING_SOLVER_WORKSPACE_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-3);
+}
+
+template <typename T>
+bool testing_solver_workspace(Arguments argus)
+{
+    int          ndim   = argus.size;
+    int          basis  = argus.index;
+    std::string  solver = argus.solver;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Random initial guess
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+    // Shared workspace of the solver tree
+    SolverWorkspace<LocalVector<T>, T> ws;
+
+    // Solver
+    FGMRES<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+    // Inner GMRES preconditioner
+    GMRES<LocalMatrix<T>, LocalVector<T>, T> gmres;
+
+    // AMG preconditioner with GMRES smoothers and coarse grid solver
+    SAAMG<LocalMatrix<T>, LocalVector<T>, T> amg;
+    GMRES<LocalMatrix<T>, LocalVector<T>, T> cgs;
+
+    IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>** sm = NULL;
+
+    int levels = 0;
+
+    if(solver == "GMRES")
+    {
+        gmres.SetBasisSize(10);
+        gmres.InitMaxIter(10);
+        gmres.Verbose(0);
+
+        ls.SetPreconditioner(gmres);
+    }
+    else if(solver == "SAAMG")
+    {
+        amg.SetCoarsestLevel(10);
+        amg.SetOperator(A);
+        amg.SetManualSmoothers(true);
+        amg.SetManualSolver(true);
+        amg.BuildHierarchy();
+
+        levels = amg.GetNumLevels();
+
+        // Smoother for each level
+        sm = new IterativeLinearSolver<LocalMatrix<T>, LocalVector<T>, T>*[levels - 1];
+
+        for(int i = 0; i < levels - 1; ++i)
+        {
+            GMRES<LocalMatrix<T>, LocalVector<T>, T>* smoother
+                = new GMRES<LocalMatrix<T>, LocalVector<T>, T>;
+            smoother->SetBasisSize(4);
+            smoother->Verbose(0);
+
+            sm[i] = smoother;
+        }
+
+        cgs.Verbose(0);
+
+        amg.SetSmoother(sm);
+        amg.SetSolver(cgs);
+        amg.SetSmootherPreIter(2);
+        amg.SetSmootherPostIter(2);
+        amg.InitMaxIter(1);
+        amg.Verbose(0);
+
+        ls.SetPreconditioner(amg);
+    }
+    else
+        return false;
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.SetBasisSize(basis);
+    ls.SetWorkspace(ws);
+
+    ls.Init(1e-6, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    // Matrix format
+    A.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
+
+    ls.Solve(b, &x);
+
+    // All temporaries have been returned to the workspace
+    bool success = (ws.GetNumVectorsInUse() == 0);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    success &= check_residual(nrm2);
+
+    // A second solve reuses the vectors of the workspace
+    int nvec = ws.GetNumVectors();
+
+    x.Zeros();
+    ls.Solve(b, &x);
+
+    success &= (ws.GetNumVectors() == nvec);
+    success &= (ws.GetNumVectorsInUse() == 0);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    nrm2 = x.Norm();
+
+    success &= check_residual(nrm2);
+
+    // Clean up
+    ls.Clear();
+
+    for(int i = 0; i < levels - 1; ++i)
+    {
+        delete sm[i];
+    }
+    delete[] sm;
+
+    ws.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_SOLVER_WORKSPACE_HPP
@@ -0,0 +1,199 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_SPARSE_LU_HPP
+#define TESTING_SPARSE_LU_HPP
+
+#include "utility.hpp"
+
+#include <rocalution/rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-3f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-6);
+}
+
+template <typename T>
+bool testing_sparse_lu(Arguments argus)
+{
+    int ndim = argus.size;
+
+    // 0 is approximate minimum degree, otherwise the nested dissection leaf size
+    int leaf_size = argus.ordering;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Solver
+    SparseLU<LocalMatrix<T>, LocalVector<T>, T> dls;
+
+    dls.Verbose(0);
+    dls.SetNestedDissection(leaf_size);
+    dls.SetOperator(A);
+
+    dls.Build();
+    dls.Print();
+
+    bool success = true;
+
+    // The factors stay sparse
+    success &= (dls.GetFactorNnz() >= nnz);
+    success &= (dls.GetFactorNnz() < static_cast<int64_t>(nrow) * nrow / 2);
+
+    x.Zeros();
+    dls.Solve(b, &x);
+
+    x.ScaleAdd(-1.0, e);
+    success &= check_residual(x.Norm());
+
+    // Refactorize a scaled operator with the same pattern, x = 1 / 2
+    A.Scale(static_cast<T>(2));
+    dls.ReBuildNumeric();
+
+    x.Zeros();
+    dls.Solve(b, &x);
+
+    x.ScaleAdd(-2.0, e);
+    success &= check_residual(x.Norm());
+
+    // Clean up
+    dls.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_sparse_lu_coarse_solver(Arguments argus)
+{
+    int ndim = argus.size;
+
+    // Initialize rocALUTION platform
+    set_device_rocalution(device);
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T*   csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // AMG with a sparse direct solve on a large coarsest level
+    CG<LocalMatrix<T>, LocalVector<T>, T>    ls;
+    SAAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+
+    p.SetCoarsestLevel(nrow / 4);
+    p.SetDefaultCoarseSolver(SparseDirectCoarseSolver);
+    p.InitMaxIter(1);
+    p.Verbose(0);
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.SetPreconditioner(p);
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    x.Zeros();
+    ls.Solve(b, &x);
+
+    x.ScaleAdd(-1.0, e);
+
+    bool success = check_residual(x.Norm());
+
+    ls.Clear();
+    p.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_SPARSE_LU_HPP
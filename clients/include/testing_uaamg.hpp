@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2022 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -53,7 +53,8 @@ bool testing_uaamg(Arguments argus)
     unsigned int format              = argus.format;
     int          cycle               = argus.cycle;
     bool         scaling             = argus.ordering;
-    bool         rebuildnumeric      = argus.rebuildnumeric;
+    int          rebuildnumeric      = argus.rebuildnumeric;
+    bool         matrixfree          = argus.matrixfree;
 
     // Initialize rocALUTION platform
     set_device_rocalution(device);
@@ -135,6 +136,7 @@ bool testing_uaamg(Arguments argus)
     p.SetManualSmoothers(true);
     p.SetManualSolver(true);
     p.SetScaling(scaling);
+    p.SetAutoHostLevels(true);
 
     if(coarsening_strategy == "Greedy")
     {
@@ -151,6 +153,7 @@ bool testing_uaamg(Arguments argus)
 
     p.SetCouplingStrength(0.005);
     p.SetOverInterp(1.2);
+    p.SetMatrixFreeTransfer(matrixfree);
     p.BuildHierarchy();
 
     // Get number of hierarchy levels
@@ -199,6 +202,15 @@ bool testing_uaamg(Arguments argus)
 
     if(rebuildnumeric)
     {
+        if(rebuildnumeric == 2)
+        {
+            // Frozen hierarchy, the first rebuild caches the Galerkin product structures
+            // and the second one only recomputes their values
+            p.SetFrozenHierarchy(true);
+            A.Scale(static_cast<T>(2));
+            ls.ReBuildNumeric();
+        }
+
         A.UpdateValuesCSR(csr_val2);
         delete[] csr_val2;
 
@@ -211,13 +223,38 @@ bool testing_uaamg(Arguments argus)
     // Matrix format
     A.ConvertTo(format, format == BCSR ? argus.blockdim : 1);
 
+    // Record the time breakdown of the solve
+    p.SetLevelTiming(true);
+    set_time_breakdown_rocalution(true);
+    reset_time_breakdown_rocalution();
+
     ls.Solve(rebuildnumeric ? b2 : b, &x);
 
+    set_time_breakdown_rocalution(false);
+
+    // The solve is spent in the preconditioner to a large extent, and every level
+    // is visited by the cycles
+    bool timing = get_time_breakdown_rocalution(TimePreconditioner) > 0.0
+                  && get_time_breakdown_rocalution(TimeSpMV) >= 0.0;
+
+    for(int i = 0; i < levels; ++i)
+    {
+        double smoothing;
+        p.GetLevelTime(i, NULL, &smoothing, NULL, NULL);
+
+        timing = timing && smoothing > 0.0;
+    }
+
+    for(int i = 0; i < levels - 1; ++i)
+    {
+        timing = timing && p.GetHierarchyTime(i) >= 0.0;
+    }
+
     // Verify solution
     x.ScaleAdd(-1.0, e);
     T nrm2 = x.Norm();
 
-    bool success = check_residual(nrm2);
+    bool success = check_residual(nrm2) && timing;
 
     // Clean up
     ls.Clear(); // TODO
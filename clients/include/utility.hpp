@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -26,7 +26,9 @@
 #define TESTING_UTILITY_HPP
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "random.hpp"
 
@@ -277,6 +279,295 @@ int gen_random(int m, int n, int max_nnz_per_row, int** rowptr, int** col, T** v
     return m;
 }
 
+/* ============================================================================================ */
+/*! \brief  Synthetic 3D problems on the unit cube with homogeneous Dirichlet boundary */
+typedef enum stencil_3d_problem_
+{
+    stencil_3d_laplacian_7pt, // 7 point Laplacian
+    stencil_3d_laplacian_27pt, // 27 point Laplacian
+    stencil_3d_anisotropic, // 7 point -coef u_xx - u_yy - u_zz
+    stencil_3d_jump, // 7 point diffusion, checkerboard of sub cubes with coefficient 1 and coef
+    stencil_3d_convection_diffusion, // 7 point upwind, cell Peclet number coef in each direction
+    stencil_3d_elasticity // 3 unknowns per grid point, coupling strength coef
+} stencil_3d_problem;
+
+/*! \brief  Number of unknowns per grid point */
+inline int stencil_3d_dof(stencil_3d_problem problem)
+{
+    return (problem == stencil_3d_elasticity) ? 3 : 1;
+}
+
+/*! \brief  Maximum number of non-zero entries per row */
+inline int stencil_3d_max_row_nnz(stencil_3d_problem problem)
+{
+    switch(problem)
+    {
+    case stencil_3d_laplacian_27pt:
+        return 27;
+    case stencil_3d_elasticity:
+        return 9;
+    default:
+        return 7;
+    }
+}
+
+/*! \brief  Coefficient that is used when none is specified */
+inline double stencil_3d_default_coef(stencil_3d_problem problem)
+{
+    switch(problem)
+    {
+    case stencil_3d_anisotropic:
+        return 1e-3;
+    case stencil_3d_jump:
+        return 1e3;
+    default:
+        return 1.0;
+    }
+}
+
+/*! \brief  Diffusion coefficient of the cell at grid point (x, y, z) for the jump problem */
+inline double stencil_3d_jump_coef(
+    double coef, int64_t dimx, int64_t dimy, int64_t dimz, int64_t x, int64_t y, int64_t z)
+{
+    // 4 x 4 x 4 checkerboard of sub cubes
+    int64_t cx = (4 * x) / dimx;
+    int64_t cy = (4 * y) / dimy;
+    int64_t cz = (4 * z) / dimz;
+
+    return ((cx + cy + cz) % 2 == 0) ? 1.0 : coef;
+}
+
+/* ============================================================================================ */
+/*! \brief  Generate the row(s) of a single grid point of a synthetic 3D problem
+ *
+ *  The grid point (x, y, z) lives on a global grid of size dimx x dimy x dimz. Row
+ *  component c of the grid point is written to col and val, with global column indices
+ *  in ascending order. Returns the number of entries of the row. Since each row only
+ *  depends on its global grid position, rows can be generated independently on each
+ *  process of a distributed matrix.
+ */
+template <typename T>
+int gen_3d_stencil_row(stencil_3d_problem problem,
+                       double             coef,
+                       int64_t            dimx,
+                       int64_t            dimy,
+                       int64_t            dimz,
+                       int64_t            x,
+                       int64_t            y,
+                       int64_t            z,
+                       int                c,
+                       int64_t*           col,
+                       T*                 val)
+{
+    const int     dof   = stencil_3d_dof(problem);
+    const int64_t point = (z * dimy + y) * dimx + x;
+    const int64_t row   = point * dof + c;
+
+    int nnz = 0;
+
+    if(problem == stencil_3d_laplacian_27pt)
+    {
+        for(int sz = -1; sz <= 1; ++sz)
+        {
+            if(z + sz > -1 && z + sz < dimz)
+            {
+                for(int sy = -1; sy <= 1; ++sy)
+                {
+                    if(y + sy > -1 && y + sy < dimy)
+                    {
+                        for(int sx = -1; sx <= 1; ++sx)
+                        {
+                            if(x + sx > -1 && x + sx < dimx)
+                            {
+                                col[nnz] = row + (sz * dimy + sy) * dimx + sx;
+                                val[nnz] = (col[nnz] == row) ? 26.0 : -1.0;
+                                ++nnz;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return nnz;
+    }
+
+    // All other problems couple the 6 face neighbors, in ascending column order
+    const int     dir[6]    = {2, 1, 0, 0, 1, 2};
+    const int     shift[6]  = {-1, -1, -1, 1, 1, 1};
+    const int64_t stride[3] = {1, dimx, dimx * dimy};
+    const int64_t pos[3]    = {x, y, z};
+    const int64_t dim[3]    = {dimx, dimy, dimz};
+
+    // Coupling to the 6 face neighbors, boundary couplings contribute to the diagonal only
+    double coupling[6];
+    double diag = 0.0;
+
+    for(int k = 0; k < 6; ++k)
+    {
+        switch(problem)
+        {
+        case stencil_3d_anisotropic:
+            coupling[k] = (dir[k] == 0) ? coef : 1.0;
+            break;
+        case stencil_3d_jump:
+        {
+            // Harmonic average of the two cell coefficients
+            double k0 = stencil_3d_jump_coef(coef, dimx, dimy, dimz, x, y, z);
+            double k1 = k0;
+
+            int64_t n[3] = {x, y, z};
+            n[dir[k]] += shift[k];
+
+            if(n[dir[k]] > -1 && n[dir[k]] < dim[dir[k]])
+            {
+                k1 = stencil_3d_jump_coef(coef, dimx, dimy, dimz, n[0], n[1], n[2]);
+            }
+
+            coupling[k] = 2.0 * k0 * k1 / (k0 + k1);
+            break;
+        }
+        case stencil_3d_convection_diffusion:
+            // Upwind discretization of a constant flow into the positive directions
+            coupling[k] = (shift[k] < 0) ? 1.0 + coef : 1.0;
+            break;
+        case stencil_3d_elasticity:
+            // Stronger coupling of each displacement component along its own axis
+            coupling[k] = (dir[k] == c) ? 1.0 + coef : 1.0;
+            break;
+        default:
+            coupling[k] = 1.0;
+            break;
+        }
+
+        diag += coupling[k];
+    }
+
+    for(int k = 0; k < 6; ++k)
+    {
+        // Diagonal block of the grid point
+        if(k == 3)
+        {
+            for(int cc = 0; cc < dof; ++cc)
+            {
+                col[nnz] = point * dof + cc;
+
+                // Elasticity couples the components of a grid point by a symmetric positive
+                // semi-definite block
+                if(dof > 1)
+                {
+                    val[nnz] = (cc == c) ? diag + 0.5 * coef : 0.5 * coef;
+                }
+                else
+                {
+                    val[nnz] = diag;
+                }
+
+                ++nnz;
+            }
+        }
+
+        if(pos[dir[k]] + shift[k] > -1 && pos[dir[k]] + shift[k] < dim[dir[k]])
+        {
+            col[nnz] = row + shift[k] * stride[dir[k]] * dof;
+            val[nnz] = -coupling[k];
+            ++nnz;
+        }
+    }
+
+    return nnz;
+}
+
+/* ============================================================================================ */
+/*! \brief  Generate synthetic 3D problem on the unit cube in CSR format, with ndim grid
+ *  points in each direction */
+template <typename T>
+int gen_3d_stencil(stencil_3d_problem problem, double coef, int ndim, int** row_ptr, int** col_ind, T** val)
+{
+    // Do nothing
+    if(ndim == 0)
+    {
+        return 0;
+    }
+
+    const int dof     = stencil_3d_dof(problem);
+    const int max_nnz = stencil_3d_max_row_nnz(problem);
+    const int npoint  = ndim * ndim * ndim;
+    const int n       = npoint * dof;
+
+    *row_ptr = new int[n + 1];
+
+    // Count the entries of each row
+    (*row_ptr)[0] = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int64_t> col(max_nnz);
+        std::vector<T>       entry(max_nnz);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+        for(int p = 0; p < npoint; ++p)
+        {
+            int ix = p % ndim;
+            int iy = (p / ndim) % ndim;
+            int iz = p / (ndim * ndim);
+
+            for(int c = 0; c < dof; ++c)
+            {
+                (*row_ptr)[p * dof + c + 1] = gen_3d_stencil_row(
+                    problem, coef, ndim, ndim, ndim, ix, iy, iz, c, col.data(), entry.data());
+            }
+        }
+    }
+
+    for(int i = 0; i < n; ++i)
+    {
+        (*row_ptr)[i + 1] += (*row_ptr)[i];
+    }
+
+    int nnz = (*row_ptr)[n];
+
+    *col_ind = new int[nnz];
+    *val     = new T[nnz];
+
+    // Fill the rows
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int64_t> col(max_nnz);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+        for(int p = 0; p < npoint; ++p)
+        {
+            int ix = p % ndim;
+            int iy = (p / ndim) % ndim;
+            int iz = p / (ndim * ndim);
+
+            for(int c = 0; c < dof; ++c)
+            {
+                int row = p * dof + c;
+                int idx = (*row_ptr)[row];
+                int len = gen_3d_stencil_row(
+                    problem, coef, ndim, ndim, ndim, ix, iy, iz, c, col.data(), *val + idx);
+
+                for(int j = 0; j < len; ++j)
+                {
+                    (*col_ind)[idx + j] = static_cast<int>(col[j]);
+                }
+            }
+        }
+    }
+
+    return n;
+}
+
 /* ============================================================================================ */
 
 /*! \brief Class used to parse command arguments in both client & gtest   */
@@ -305,6 +596,7 @@ public:
     int index      = 50;
     int chunk_size = 20;
     int blockdim   = 4;
+    int nrhs       = 1;
 
     // Computation variables
     double alpha = 1.0;
@@ -324,6 +616,14 @@ public:
     int ordering       = 1;
     int cycle          = 0;
     int rebuildnumeric = 0;
+    int ortho          = 0;
+    int adaptive       = 0;
+    int aggressive     = 0;
+    int lowmemory      = 0;
+    int fused          = 0;
+    int hybrid         = 0;
+    int matrixfree     = 0;
+    int reducedbasis   = 0;
 
     unsigned int format;
 
@@ -345,6 +645,7 @@ public:
         this->index      = rhs.index;
         this->chunk_size = rhs.chunk_size;
         this->blockdim   = rhs.blockdim;
+        this->nrhs       = rhs.nrhs;
 
         this->alpha = rhs.alpha;
         this->beta  = rhs.beta;
@@ -361,6 +662,14 @@ public:
         this->ordering       = rhs.ordering;
         this->cycle          = rhs.cycle;
         this->rebuildnumeric = rhs.rebuildnumeric;
+        this->ortho          = rhs.ortho;
+        this->adaptive       = rhs.adaptive;
+        this->aggressive     = rhs.aggressive;
+        this->lowmemory      = rhs.lowmemory;
+        this->fused          = rhs.fused;
+        this->hybrid         = rhs.hybrid;
+        this->matrixfree     = rhs.matrixfree;
+        this->reducedbasis   = rhs.reducedbasis;
 
         this->coarsening_strategy = rhs.coarsening_strategy;
 
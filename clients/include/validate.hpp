@@ -23,9 +23,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <set>
 #include <vector>
 
-bool valid_permutation(int m, const int* permutation)
+inline bool valid_permutation(int m, const int* permutation)
 {
     std::vector<int> check(m, 0);
 
@@ -50,12 +52,12 @@ bool valid_permutation(int m, const int* permutation)
     return true;
 }
 
-bool valid_coloring(int        m,
-                    const int* csr_ptr,
-                    const int* csr_ind,
-                    int        num_colors,
-                    const int* size_colors,
-                    const int* permutation)
+inline bool valid_coloring(int        m,
+                           const int* csr_ptr,
+                           const int* csr_ind,
+                           int        num_colors,
+                           const int* size_colors,
+                           const int* permutation)
 {
     /*
     *   Create Inverse Permutation
@@ -106,3 +108,111 @@ bool valid_coloring(int        m,
 
     return true;
 }
+
+// Number of entries of the Cholesky factor of the symmetrized, permuted pattern
+inline int
+    symbolic_factor_nnz(int m, const int* csr_ptr, const int* csr_ind, const int* permutation)
+{
+    std::vector<std::set<int>> L(m);
+
+    for(int i = 0; i < m; i++)
+    {
+        for(int k = csr_ptr[i]; k < csr_ptr[i + 1]; k++)
+        {
+            const int r = permutation[i];
+            const int c = permutation[csr_ind[k]];
+
+            if(r != c)
+            {
+                L[std::min(r, c)].insert(std::max(r, c));
+            }
+        }
+    }
+
+    int nnz = m;
+
+    // Column j of L is merged into the column of its parent in the elimination tree
+    for(int j = 0; j < m; j++)
+    {
+        nnz += static_cast<int>(L[j].size());
+
+        if(L[j].empty() == false)
+        {
+            const int parent = *L[j].begin();
+
+            for(int r : L[j])
+            {
+                if(r != parent)
+                {
+                    L[parent].insert(r);
+                }
+            }
+        }
+    }
+
+    return nnz;
+}
+
+inline bool valid_separator_tree(int        m,
+                                 const int* csr_ptr,
+                                 const int* csr_ind,
+                                 int        num_nodes,
+                                 const int* node_offset,
+                                 const int* node_parent,
+                                 const int* permutation)
+{
+    if(num_nodes <= 0 || node_offset[0] != 0 || node_offset[num_nodes] != m)
+    {
+        return false;
+    }
+
+    // Post order, the root comes last
+    for(int k = 0; k < num_nodes; k++)
+    {
+        if(node_offset[k] > node_offset[k + 1])
+        {
+            return false;
+        }
+
+        if((k == num_nodes - 1) != (node_parent[k] == -1))
+        {
+            return false;
+        }
+
+        if(node_parent[k] != -1 && node_parent[k] <= k)
+        {
+            return false;
+        }
+    }
+
+    std::vector<int> node(m);
+    for(int k = 0; k < num_nodes; k++)
+    {
+        for(int j = node_offset[k]; j < node_offset[k + 1]; j++)
+        {
+            node[j] = k;
+        }
+    }
+
+    // Rows of different nodes only couple if one node is an ancestor of the other
+    for(int i = 0; i < m; i++)
+    {
+        for(int k = csr_ptr[i]; k < csr_ptr[i + 1]; k++)
+        {
+            int lo = std::min(node[permutation[i]], node[permutation[csr_ind[k]]]);
+            int hi = std::max(node[permutation[i]], node[permutation[csr_ind[k]]]);
+
+            while(lo != -1 && lo != hi)
+            {
+                lo = node_parent[lo];
+            }
+
+            if(lo != hi)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,144 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "common.hpp"
+
+#include <iostream>
+#include <mpi.h>
+#include <rocalution/rocalution.hpp>
+
+#define ValueType double
+
+using namespace rocalution;
+
+int main(int argc, char* argv[])
+{
+    // Initialize MPI
+    MPI_Init(&argc, &argv);
+
+    int world_rank;
+    int world_procs;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &world_procs);
+
+    if(argc < 3)
+    {
+        std::cerr << argv[0] << " <procs per member> <ndim>" << std::endl;
+        MPI_Finalize();
+        return -1;
+    }
+
+    int procs_per_member = atoi(argv[1]);
+    int ndim             = atoi(argv[2]);
+
+    // Split the processes into ensemble members, each member solves its own system on
+    // its sub-communicator
+    int member = world_rank / procs_per_member;
+
+    MPI_Comm comm;
+    MPI_Comm_split(MPI_COMM_WORLD, member, world_rank, &comm);
+
+    int rank;
+    int num_procs;
+
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &num_procs);
+
+    // Disable OpenMP thread affinity
+    set_omp_affinity_rocalution(false);
+
+    // Initialize platform on the sub-communicator, the devices of a node are shared by
+    // the processes of all members on that node
+    init_rocalution(&comm);
+
+    // Disable OpenMP
+    set_omp_threads_rocalution(1);
+
+    // Print platform
+    info_rocalution();
+
+    // Global structures on the sub-communicator
+    ParallelManager         manager;
+    GlobalMatrix<ValueType> mat;
+
+    generate_2d_laplacian(ndim, ndim, &comm, &mat, &manager, rank, num_procs, 5);
+
+    // rocALUTION vectors
+    GlobalVector<ValueType> rhs(manager);
+    GlobalVector<ValueType> x(manager);
+    GlobalVector<ValueType> e(manager);
+
+    // Move structures to accelerator, if available
+    mat.MoveToAccelerator();
+    rhs.MoveToAccelerator();
+    x.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate memory
+    rhs.Allocate("rhs", mat.GetM());
+    x.Allocate("x", mat.GetN());
+    e.Allocate("sol", mat.GetN());
+
+    // Each member solves for a different solution
+    e.Ones();
+    e.Scale(static_cast<ValueType>(member + 1));
+    mat.Apply(e, &rhs);
+
+    // Initial zero guess
+    x.Zeros();
+
+    // Linear solver
+    CG<GlobalMatrix<ValueType>, GlobalVector<ValueType>, ValueType> ls;
+    Jacobi<GlobalMatrix<ValueType>, GlobalVector<ValueType>, ValueType> p;
+
+    ls.SetOperator(mat);
+    ls.SetPreconditioner(p);
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.Build();
+    ls.Verbose(1);
+
+    double time = rocalution_time();
+
+    ls.Solve(rhs, &x);
+
+    time = rocalution_time() - time;
+
+    e.ScaleAdd(-1.0, x);
+    double nrm2 = e.Norm();
+
+    if(rank == 0)
+    {
+        std::cout << "Member " << member << ": solving " << time / 1e6
+                  << " sec, ||e - x||_2 = " << nrm2 << std::endl;
+    }
+
+    ls.Clear();
+
+    stop_rocalution();
+
+    MPI_Comm_free(&comm);
+    MPI_Finalize();
+
+    return 0;
+}
@@ -23,6 +23,7 @@
 
 #include "common.hpp"
 
+#include <cstring>
 #include <iostream>
 #include <mpi.h>
 #include <rocalution/rocalution.hpp>
@@ -45,10 +46,45 @@ int main(int argc, char* argv[])
 
     if(argc < 4)
     {
-        std::cerr << argv[0] << " <x> <y> <z>" << std::endl;
+        std::cerr << argv[0] << " <x> <y> <z> [problem] [coef]" << std::endl;
+        std::cerr << "  problem: laplacian (default), laplacian_7pt, anisotropic, jump, "
+                     "convection_diffusion, elasticity"
+                  << std::endl;
         return -1;
     }
 
+    // Synthetic problem, the 27 point laplacian is generated by default
+    const char*        problem_name = (argc > 4) ? argv[4] : "laplacian";
+    stencil_3d_problem problem      = stencil_3d_laplacian_27pt;
+
+    if(strcmp(problem_name, "laplacian_7pt") == 0)
+    {
+        problem = stencil_3d_laplacian_7pt;
+    }
+    else if(strcmp(problem_name, "anisotropic") == 0)
+    {
+        problem = stencil_3d_anisotropic;
+    }
+    else if(strcmp(problem_name, "jump") == 0)
+    {
+        problem = stencil_3d_jump;
+    }
+    else if(strcmp(problem_name, "convection_diffusion") == 0)
+    {
+        problem = stencil_3d_convection_diffusion;
+    }
+    else if(strcmp(problem_name, "elasticity") == 0)
+    {
+        problem = stencil_3d_elasticity;
+    }
+    else if(strcmp(problem_name, "laplacian") != 0)
+    {
+        std::cerr << "unknown problem " << problem_name << std::endl;
+        return -1;
+    }
+
+    double coef = (argc > 5) ? atof(argv[5]) : stencil_3d_default_coef(problem);
+
     // Disable OpenMP thread affinity
     set_omp_affinity_rocalution(false);
 
@@ -65,14 +101,30 @@ int main(int argc, char* argv[])
     ParallelManager         manager;
     GlobalMatrix<ValueType> mat;
 
-    // Generate distributed 3D laplacian
+    // Generate distributed 3D problem
     if(rank == 0)
     {
-        std::cout << "Generating 3D laplacian..." << std::endl;
+        std::cout << "Generating 3D " << problem_name << "..." << std::endl;
     }
 
-    generate_3d_laplacian(
-        atoi(argv[1]), atoi(argv[2]), atoi(argv[3]), &comm, &mat, &manager, rank, num_procs);
+    if(problem == stencil_3d_laplacian_27pt)
+    {
+        generate_3d_laplacian(
+            atoi(argv[1]), atoi(argv[2]), atoi(argv[3]), &comm, &mat, &manager, rank, num_procs);
+    }
+    else
+    {
+        generate_3d_stencil(problem,
+                            coef,
+                            atoi(argv[1]),
+                            atoi(argv[2]),
+                            atoi(argv[3]),
+                            &comm,
+                            &mat,
+                            &manager,
+                            rank,
+                            num_procs);
+    }
 
     // rocALUTION vectors
     GlobalVector<ValueType> rhs(manager);
@@ -100,8 +152,16 @@ int main(int argc, char* argv[])
     // Print matrix info
     mat.Info();
 
-    // Linear solver
-    CG<GlobalMatrix<ValueType>, GlobalVector<ValueType>, ValueType> ls;
+    // Linear solver, the convection diffusion problem is non-symmetric
+    CG<GlobalMatrix<ValueType>, GlobalVector<ValueType>, ValueType>       cg;
+    BiCGStab<GlobalMatrix<ValueType>, GlobalVector<ValueType>, ValueType> bicgstab;
+
+    IterativeLinearSolver<GlobalMatrix<ValueType>, GlobalVector<ValueType>, ValueType>& ls
+        = (problem == stencil_3d_convection_diffusion)
+              ? static_cast<IterativeLinearSolver<GlobalMatrix<ValueType>,
+                                                  GlobalVector<ValueType>,
+                                                  ValueType>&>(bicgstab)
+              : cg;
 
     // Preconditioner
     RugeStuebenAMG<GlobalMatrix<ValueType>, GlobalVector<ValueType>, ValueType> p;
@@ -0,0 +1,81 @@
+/* ************************************************************************
+ * Copyright (C) 2018-2020 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <rocalution/rocalution.hpp>
+
+int device;
+
+/* =====================================================================
+      Main function of the multi process tests:
+=================================================================== */
+
+int main(int argc, char** argv)
+{
+    // The progress thread of the parallel manager requires MPI_THREAD_MULTIPLE, with
+    // --mpi-thread-single its fallback without thread is tested
+    int required = MPI_THREAD_MULTIPLE;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(strcmp(argv[i], "--mpi-thread-single") == 0)
+        {
+            required = MPI_THREAD_SINGLE;
+        }
+    }
+
+    int provided;
+    MPI_Init_thread(&argc, &argv, required, &provided);
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    // Get device id from command line
+    device = 0;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(strcmp(argv[i], "--device") == 0 && argc > i + 1)
+        {
+            device = atoi(argv[i + 1]);
+        }
+    }
+
+    ::testing::InitGoogleTest(&argc, argv);
+
+    // Only the first process reports the results
+    if(rank != 0)
+    {
+        ::testing::TestEventListeners& listeners = ::testing::UnitTest::GetInstance()->listeners();
+        delete listeners.Release(listeners.default_result_printer());
+    }
+
+    int ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+
+    return ret;
+}
@@ -0,0 +1,66 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_amg_tuner.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string> amg_tuner_tuple;
+
+int         amg_tuner_size[]   = {22, 63};
+std::string amg_tuner_solver[] = {"CG", "None"};
+
+class parameterized_amg_tuner : public testing::TestWithParam<amg_tuner_tuple>
+{
+protected:
+    parameterized_amg_tuner() {}
+    virtual ~parameterized_amg_tuner() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_amg_tuner_arguments(amg_tuner_tuple tup)
+{
+    Arguments arg;
+    arg.size   = std::get<0>(tup);
+    arg.solver = std::get<1>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_amg_tuner, amg_tuner_float)
+{
+    Arguments arg = setup_amg_tuner_arguments(GetParam());
+    ASSERT_EQ(testing_amg_tuner<float>(arg), true);
+}
+
+TEST_P(parameterized_amg_tuner, amg_tuner_double)
+{
+    Arguments arg = setup_amg_tuner_arguments(GetParam());
+    ASSERT_EQ(testing_amg_tuner<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(amg_tuner,
+                        parameterized_amg_tuner,
+                        testing::Combine(testing::ValuesIn(amg_tuner_size),
+                                         testing::ValuesIn(amg_tuner_solver)));
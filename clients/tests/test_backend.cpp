@@ -63,6 +63,46 @@ TEST(backend_init_order, backend)
     testing_backend_init_order();
 }
 
+TEST(backend_host_fallback, backend)
+{
+    testing_backend_host_fallback();
+}
+
+TEST(backend_tuning_cache, backend)
+{
+    testing_backend_tuning_cache();
+}
+
+TEST(backend_log_record, backend)
+{
+    testing_backend_log_record();
+}
+
+TEST(backend_execution_context, backend)
+{
+    testing_backend_execution_context();
+}
+
+TEST(backend_execution_context_device, backend)
+{
+    testing_backend_execution_context_device();
+}
+
+TEST(backend_threads, backend)
+{
+    testing_backend_threads();
+}
+
+TEST(backend_graph_replay, backend)
+{
+    testing_backend_graph_replay();
+}
+
+TEST(backend_reproducible_reductions, backend)
+{
+    testing_backend_reproducible_reductions();
+}
+
 TEST_P(parameterized_backend, backend)
 {
     Arguments arg = setup_backend_arguments(GetParam());
@@ -0,0 +1,73 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "testing_blockcg.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, std::string, unsigned int> blockcg_tuple;
+
+int          blockcg_size[]    = {7, 63};
+int          blockcg_nrhs[]    = {1, 4, 8};
+std::string  blockcg_precond[] = {"None", "Jacobi", "SGS", "IC"};
+unsigned int blockcg_format[]  = {1, 2, 6};
+
+class parameterized_blockcg : public testing::TestWithParam<blockcg_tuple>
+{
+protected:
+    parameterized_blockcg() {}
+    virtual ~parameterized_blockcg() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_blockcg_arguments(blockcg_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.nrhs    = std::get<1>(tup);
+    arg.precond = std::get<2>(tup);
+    arg.format  = std::get<3>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_blockcg, blockcg_float)
+{
+    Arguments arg = setup_blockcg_arguments(GetParam());
+    ASSERT_EQ(testing_blockcg<float>(arg), true);
+}
+
+TEST_P(parameterized_blockcg, blockcg_double)
+{
+    Arguments arg = setup_blockcg_arguments(GetParam());
+    ASSERT_EQ(testing_blockcg<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(blockcg,
+                        parameterized_blockcg,
+                        testing::Combine(testing::ValuesIn(blockcg_size),
+                                         testing::ValuesIn(blockcg_nrhs),
+                                         testing::ValuesIn(blockcg_precond),
+                                         testing::ValuesIn(blockcg_format)));
@@ -0,0 +1,76 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "testing_blockgmres.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, int, std::string, unsigned int> blockgmres_tuple;
+
+int          blockgmres_size[]    = {7, 31};
+int          blockgmres_basis[]   = {10, 30};
+int          blockgmres_nrhs[]    = {1, 4, 8};
+std::string  blockgmres_precond[] = {"None", "Jacobi", "GS", "ILU"};
+unsigned int blockgmres_format[]  = {1, 2, 6};
+
+class parameterized_blockgmres : public testing::TestWithParam<blockgmres_tuple>
+{
+protected:
+    parameterized_blockgmres() {}
+    virtual ~parameterized_blockgmres() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_blockgmres_arguments(blockgmres_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.index   = std::get<1>(tup);
+    arg.nrhs    = std::get<2>(tup);
+    arg.precond = std::get<3>(tup);
+    arg.format  = std::get<4>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_blockgmres, blockgmres_float)
+{
+    Arguments arg = setup_blockgmres_arguments(GetParam());
+    ASSERT_EQ(testing_blockgmres<float>(arg), true);
+}
+
+TEST_P(parameterized_blockgmres, blockgmres_double)
+{
+    Arguments arg = setup_blockgmres_arguments(GetParam());
+    ASSERT_EQ(testing_blockgmres<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(blockgmres,
+                        parameterized_blockgmres,
+                        testing::Combine(testing::ValuesIn(blockgmres_size),
+                                         testing::ValuesIn(blockgmres_basis),
+                                         testing::ValuesIn(blockgmres_nrhs),
+                                         testing::ValuesIn(blockgmres_precond),
+                                         testing::ValuesIn(blockgmres_format)));
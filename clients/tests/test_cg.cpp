@@ -29,8 +29,8 @@
 typedef std::tuple<int, std::string, unsigned int> cg_tuple;
 
 int          cg_size[]    = {7, 63};
-std::string  cg_precond[] = {"None", "FSAI", "SPAI", "TNS", "Jacobi", "IC", "MCSGS"};
-unsigned int cg_format[]  = {1, 3, 4, 6};
+std::string  cg_precond[] = {"None", "FSAI", "FSAI2T", "SPAI", "TNS", "Jacobi", "IC", "MCSGS"};
+unsigned int cg_format[]  = {1, 3, 4, 6, 8, 9};
 
 class parameterized_cg : public testing::TestWithParam<cg_tuple>
 {
@@ -67,3 +67,23 @@ INSTANTIATE_TEST_CASE_P(cg,
                         testing::Combine(testing::ValuesIn(cg_size),
                                          testing::ValuesIn(cg_precond),
                                          testing::ValuesIn(cg_format)));
+
+TEST(cg_check_interval, cg_float)
+{
+    ASSERT_EQ(testing_cg_check_interval<float>(), true);
+}
+
+TEST(cg_check_interval, cg_double)
+{
+    ASSERT_EQ(testing_cg_check_interval<double>(), true);
+}
+
+TEST(cg_solution_history, cg_float)
+{
+    ASSERT_EQ(testing_cg_solution_history<float>(), true);
+}
+
+TEST(cg_solution_history, cg_double)
+{
+    ASSERT_EQ(testing_cg_solution_history<double>(), true);
+}
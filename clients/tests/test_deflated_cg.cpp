@@ -0,0 +1,75 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_deflated_cg.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, int, std::string, unsigned int> deflated_cg_tuple;
+
+int          deflated_cg_size[]     = {7, 63};
+int          deflated_cg_mode[]     = {0, 1, 2};
+int          deflated_cg_flexible[] = {0, 1};
+std::string  deflated_cg_precond[]  = {"None", "Jacobi", "IC", "MCSGS"};
+unsigned int deflated_cg_format[]   = {1, 2, 6};
+
+class parameterized_deflated_cg : public testing::TestWithParam<deflated_cg_tuple>
+{
+protected:
+    parameterized_deflated_cg() {}
+    virtual ~parameterized_deflated_cg() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_deflated_cg_arguments(deflated_cg_tuple tup)
+{
+    Arguments arg;
+    arg.size       = std::get<0>(tup);
+    arg.index      = std::get<1>(tup);
+    arg.chunk_size = std::get<2>(tup);
+    arg.precond    = std::get<3>(tup);
+    arg.format     = std::get<4>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_deflated_cg, deflated_cg_float)
+{
+    Arguments arg = setup_deflated_cg_arguments(GetParam());
+    ASSERT_EQ(testing_deflated_cg<float>(arg), true);
+}
+
+TEST_P(parameterized_deflated_cg, deflated_cg_double)
+{
+    Arguments arg = setup_deflated_cg_arguments(GetParam());
+    ASSERT_EQ(testing_deflated_cg<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(deflated_cg,
+                        parameterized_deflated_cg,
+                        testing::Combine(testing::ValuesIn(deflated_cg_size),
+                                         testing::ValuesIn(deflated_cg_mode),
+                                         testing::ValuesIn(deflated_cg_flexible),
+                                         testing::ValuesIn(deflated_cg_precond),
+                                         testing::ValuesIn(deflated_cg_format)));
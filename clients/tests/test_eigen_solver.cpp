@@ -0,0 +1,95 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_eigen_solver.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, int, std::string, unsigned int> eigen_solver_tuple;
+
+int          eigen_solver_size[]           = {7, 20};
+std::string  eigen_solver_lobpcg[]         = {"LOBPCG"};
+std::string  eigen_solver_lanczos[]        = {"Lanczos"};
+int          eigen_solver_smallest[]       = {0};
+int          eigen_solver_target[]         = {0, 1};
+std::string  eigen_solver_lobpcg_precond[] = {"Jacobi", "MCSGS"};
+std::string  eigen_solver_precond[]        = {"None"};
+unsigned int eigen_solver_format[]         = {1, 2, 6};
+
+class parameterized_eigen_solver : public testing::TestWithParam<eigen_solver_tuple>
+{
+protected:
+    parameterized_eigen_solver() {}
+    virtual ~parameterized_eigen_solver() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_eigen_solver_arguments(eigen_solver_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.solver  = std::get<1>(tup);
+    arg.index   = std::get<2>(tup);
+    arg.precond = std::get<3>(tup);
+    arg.format  = std::get<4>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_eigen_solver, eigen_solver_float)
+{
+    Arguments arg = setup_eigen_solver_arguments(GetParam());
+    ASSERT_EQ(testing_eigen_solver<float>(arg), true);
+}
+
+TEST_P(parameterized_eigen_solver, eigen_solver_double)
+{
+    Arguments arg = setup_eigen_solver_arguments(GetParam());
+    ASSERT_EQ(testing_eigen_solver<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(lobpcg,
+                        parameterized_eigen_solver,
+                        testing::Combine(testing::ValuesIn(eigen_solver_size),
+                                         testing::ValuesIn(eigen_solver_lobpcg),
+                                         testing::ValuesIn(eigen_solver_target),
+                                         testing::ValuesIn(eigen_solver_precond),
+                                         testing::ValuesIn(eigen_solver_format)));
+
+// Preconditioners that approximate A only accelerate the smallest eigenpairs
+INSTANTIATE_TEST_CASE_P(lobpcg_precond,
+                        parameterized_eigen_solver,
+                        testing::Combine(testing::ValuesIn(eigen_solver_size),
+                                         testing::ValuesIn(eigen_solver_lobpcg),
+                                         testing::ValuesIn(eigen_solver_smallest),
+                                         testing::ValuesIn(eigen_solver_lobpcg_precond),
+                                         testing::ValuesIn(eigen_solver_format)));
+
+INSTANTIATE_TEST_CASE_P(lanczos,
+                        parameterized_eigen_solver,
+                        testing::Combine(testing::ValuesIn(eigen_solver_size),
+                                         testing::ValuesIn(eigen_solver_lanczos),
+                                         testing::ValuesIn(eigen_solver_target),
+                                         testing::ValuesIn(eigen_solver_precond),
+                                         testing::ValuesIn(eigen_solver_format)));
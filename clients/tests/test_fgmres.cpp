@@ -27,12 +27,20 @@
 #include <gtest/gtest.h>
 
 typedef std::tuple<int, int, std::string, unsigned int> fgmres_tuple;
+typedef std::tuple<int, int, std::string, int>          fgmres_ortho_tuple;
+typedef std::tuple<int, int, std::string, int>          fgmres_adaptive_tuple;
 
 int          fgmres_size[]    = {7, 63};
 int          fgmres_basis[]   = {20, 60};
 std::string  fgmres_precond[] = {"None", "SPAI", "TNS", "Jacobi", "GS", "ILUT", "MCGS"};
 unsigned int fgmres_format[]  = {1, 4, 5, 7};
 
+std::string fgmres_ortho_precond[] = {"None", "Jacobi"};
+int         fgmres_ortho[]         = {1, 2};
+
+std::string fgmres_adaptive_precond[] = {"None", "Jacobi"};
+int         fgmres_adaptive[]         = {10, 100};
+
 class parameterized_fgmres : public testing::TestWithParam<fgmres_tuple>
 {
 protected:
@@ -42,6 +50,24 @@ protected:
     virtual void TearDown() {}
 };
 
+class parameterized_fgmres_ortho : public testing::TestWithParam<fgmres_ortho_tuple>
+{
+protected:
+    parameterized_fgmres_ortho() {}
+    virtual ~parameterized_fgmres_ortho() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+class parameterized_fgmres_adaptive : public testing::TestWithParam<fgmres_adaptive_tuple>
+{
+protected:
+    parameterized_fgmres_adaptive() {}
+    virtual ~parameterized_fgmres_adaptive() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
 Arguments setup_fgmres_arguments(fgmres_tuple tup)
 {
     Arguments arg;
@@ -52,6 +78,28 @@ Arguments setup_fgmres_arguments(fgmres_tuple tup)
     return arg;
 }
 
+Arguments setup_fgmres_ortho_arguments(fgmres_ortho_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.index   = std::get<1>(tup);
+    arg.precond = std::get<2>(tup);
+    arg.format  = 1;
+    arg.ortho   = std::get<3>(tup);
+    return arg;
+}
+
+Arguments setup_fgmres_adaptive_arguments(fgmres_adaptive_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.index   = std::get<1>(tup);
+    arg.precond = std::get<2>(tup);
+    arg.format  = 1;
+    arg.adaptive= std::get<3>(tup);
+    return arg;
+}
+
 TEST_P(parameterized_fgmres, fgmres_float)
 {
     Arguments arg = setup_fgmres_arguments(GetParam());
@@ -64,9 +112,61 @@ TEST_P(parameterized_fgmres, fgmres_double)
     ASSERT_EQ(testing_fgmres<double>(arg), true);
 }
 
+TEST_P(parameterized_fgmres_ortho, fgmres_ortho_float)
+{
+    Arguments arg = setup_fgmres_ortho_arguments(GetParam());
+    ASSERT_EQ(testing_fgmres<float>(arg), true);
+}
+
+TEST_P(parameterized_fgmres_ortho, fgmres_ortho_double)
+{
+    Arguments arg = setup_fgmres_ortho_arguments(GetParam());
+    ASSERT_EQ(testing_fgmres<double>(arg), true);
+}
+
+TEST_P(parameterized_fgmres_ortho, fgmres_ortho_reduced_basis_double)
+{
+    Arguments arg    = setup_fgmres_ortho_arguments(GetParam());
+    arg.reducedbasis = 1;
+    ASSERT_EQ(testing_fgmres<double>(arg), true);
+}
+
+TEST_P(parameterized_fgmres_adaptive, fgmres_adaptive_float)
+{
+    Arguments arg = setup_fgmres_adaptive_arguments(GetParam());
+    ASSERT_EQ(testing_fgmres<float>(arg), true);
+}
+
+TEST_P(parameterized_fgmres_adaptive, fgmres_adaptive_double)
+{
+    Arguments arg = setup_fgmres_adaptive_arguments(GetParam());
+    ASSERT_EQ(testing_fgmres<double>(arg), true);
+}
+
+TEST_P(parameterized_fgmres_adaptive, fgmres_adaptive_reduced_basis_double)
+{
+    Arguments arg    = setup_fgmres_adaptive_arguments(GetParam());
+    arg.reducedbasis = 1;
+    ASSERT_EQ(testing_fgmres<double>(arg), true);
+}
+
 INSTANTIATE_TEST_CASE_P(fgmres,
                         parameterized_fgmres,
                         testing::Combine(testing::ValuesIn(fgmres_size),
                                          testing::ValuesIn(fgmres_basis),
                                          testing::ValuesIn(fgmres_precond),
                                          testing::ValuesIn(fgmres_format)));
+
+INSTANTIATE_TEST_CASE_P(fgmres_ortho,
+                        parameterized_fgmres_ortho,
+                        testing::Combine(testing::ValuesIn(fgmres_size),
+                                         testing::ValuesIn(fgmres_basis),
+                                         testing::ValuesIn(fgmres_ortho_precond),
+                                         testing::ValuesIn(fgmres_ortho)));
+
+INSTANTIATE_TEST_CASE_P(fgmres_adaptive,
+                        parameterized_fgmres_adaptive,
+                        testing::Combine(testing::ValuesIn(fgmres_size),
+                                         testing::ValuesIn(fgmres_basis),
+                                         testing::ValuesIn(fgmres_adaptive_precond),
+                                         testing::ValuesIn(fgmres_adaptive)));
@@ -0,0 +1,143 @@
+/* ************************************************************************
+ * Copyright (C) 2018-2020 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_global_matrix_mpi.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(global_matrix_reduced_halo, global_matrix)
+{
+    Arguments arg;
+    arg.size = 23;
+
+    ASSERT_EQ(testing_global_matrix_reduced_halo<double>(arg), true);
+}
+
+TEST(global_matrix_mult, global_matrix)
+{
+    Arguments arg;
+    arg.size = 17;
+
+    ASSERT_EQ(testing_global_matrix_mult<float>(arg), true);
+    ASSERT_EQ(testing_global_matrix_mult<double>(arg), true);
+}
+
+TEST(global_schur_ilu, global_matrix)
+{
+    Arguments arg;
+    arg.size = 12;
+
+    ASSERT_EQ(testing_global_schur_ilu<float>(arg), true);
+    ASSERT_EQ(testing_global_schur_ilu<double>(arg), true);
+}
+
+TEST(global_matrix_overlap, global_matrix)
+{
+    Arguments arg;
+    arg.size = 97;
+
+    ASSERT_EQ(testing_global_matrix_overlap<float>(arg), true);
+    ASSERT_EQ(testing_global_matrix_overlap<double>(arg), true);
+}
+
+TEST(global_ras, global_matrix)
+{
+    Arguments arg;
+    arg.size = 97;
+
+    ASSERT_EQ(testing_global_ras<float>(arg), true);
+    ASSERT_EQ(testing_global_ras<double>(arg), true);
+}
+
+TEST(global_matrix_assemble_coo, global_matrix)
+{
+    Arguments arg;
+    arg.size = 97;
+
+    ASSERT_EQ(testing_global_matrix_assemble_coo<float>(arg), true);
+    ASSERT_EQ(testing_global_matrix_assemble_coo<double>(arg), true);
+}
+
+TEST(global_matrix_file_io, global_matrix)
+{
+    Arguments arg;
+    arg.size = 97;
+
+    ASSERT_EQ(testing_global_matrix_file_io<float>(arg), true);
+    ASSERT_EQ(testing_global_matrix_file_io<double>(arg), true);
+}
+
+TEST(global_vector_expression, global_matrix)
+{
+    Arguments arg;
+    arg.size = 97;
+
+    ASSERT_EQ(testing_global_vector_expression<float>(arg), true);
+    ASSERT_EQ(testing_global_vector_expression<double>(arg), true);
+}
+
+TEST(global_amg_redundant, global_matrix)
+{
+    Arguments arg;
+    arg.size = 30;
+
+    ASSERT_EQ(testing_global_amg_redundant<float>(arg), true);
+    ASSERT_EQ(testing_global_amg_redundant<double>(arg), true);
+}
+
+TEST(global_matrix_progress_thread, global_matrix)
+{
+    Arguments arg;
+    arg.size = 97;
+
+    ASSERT_EQ(testing_global_matrix_progress_thread<float>(arg), true);
+    ASSERT_EQ(testing_global_matrix_progress_thread<double>(arg), true);
+}
+
+TEST(global_matrix_neighbor_collectives, global_matrix)
+{
+    Arguments arg;
+    arg.size = 97;
+
+    ASSERT_EQ(testing_global_matrix_neighbor_collectives<float>(arg), true);
+    ASSERT_EQ(testing_global_matrix_neighbor_collectives<double>(arg), true);
+}
+
+TEST(global_matrix_reorder_boundary_first, global_matrix)
+{
+    Arguments arg;
+    arg.size = 12;
+
+    ASSERT_EQ(testing_global_matrix_reorder_boundary_first<float>(arg), true);
+    ASSERT_EQ(testing_global_matrix_reorder_boundary_first<double>(arg), true);
+}
+
+TEST(global_matrix_repartition, global_matrix)
+{
+    Arguments arg;
+    arg.size = 97;
+
+    ASSERT_EQ(testing_global_matrix_repartition<float>(arg), true);
+    ASSERT_EQ(testing_global_matrix_repartition<double>(arg), true);
+}
@@ -27,15 +27,34 @@
 #include <gtest/gtest.h>
 
 typedef std::tuple<int, int, std::string, std::string, unsigned int> gmres_tuple;
+typedef std::tuple<int, int, std::string, int>                         gmres_ortho_tuple;
+typedef std::tuple<int, int, std::string, int>                         gmres_adaptive_tuple;
 
 int         gmres_size[]               = {7, 63};
 int         gmres_basis[]              = {20, 60};
 std::string gmres_matrix[]             = {"laplacian"};
 std::string gmres_bad_precond_matrix[] = {"permuted_identity"};
-std::string gmres_precond[] = {"None", "Chebyshev", "GS", "ILU", "ItILU0", "ILUT", "MCGS", "MCILU"};
+std::string gmres_precond[] = {"None",
+                              "Chebyshev",
+                              "GMRESPoly",
+                              "PBJacobi",
+                              "GS",
+                              "ILU",
+                              "ItILU0",
+                              "ILUT",
+                              "MCGS",
+                              "PBMCGS",
+                              "MCILU",
+                              "RAS"};
 std::string gmres_bad_precond[] = {"MCGS"};
 unsigned int gmres_format[]     = {1, 2, 5, 6};
 
+std::string gmres_ortho_precond[] = {"None", "ILU"};
+int         gmres_ortho[]         = {1, 2};
+
+std::string gmres_adaptive_precond[] = {"None", "ILU"};
+int         gmres_adaptive[]         = {10, 100};
+
 class parameterized_gmres : public testing::TestWithParam<gmres_tuple>
 {
 protected:
@@ -54,6 +73,24 @@ protected:
     virtual void TearDown() {}
 };
 
+class parameterized_gmres_ortho : public testing::TestWithParam<gmres_ortho_tuple>
+{
+protected:
+    parameterized_gmres_ortho() {}
+    virtual ~parameterized_gmres_ortho() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+class parameterized_gmres_adaptive : public testing::TestWithParam<gmres_adaptive_tuple>
+{
+protected:
+    parameterized_gmres_adaptive() {}
+    virtual ~parameterized_gmres_adaptive() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
 Arguments setup_gmres_arguments(gmres_tuple tup)
 {
     Arguments arg;
@@ -65,6 +102,30 @@ Arguments setup_gmres_arguments(gmres_tuple tup)
     return arg;
 }
 
+Arguments setup_gmres_ortho_arguments(gmres_ortho_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.index   = std::get<1>(tup);
+    arg.matrix  = "laplacian";
+    arg.precond = std::get<2>(tup);
+    arg.format  = 1;
+    arg.ortho   = std::get<3>(tup);
+    return arg;
+}
+
+Arguments setup_gmres_adaptive_arguments(gmres_adaptive_tuple tup)
+{
+    Arguments arg;
+    arg.size     = std::get<0>(tup);
+    arg.index    = std::get<1>(tup);
+    arg.matrix   = "laplacian";
+    arg.precond  = std::get<2>(tup);
+    arg.format   = 1;
+    arg.adaptive = std::get<3>(tup);
+    return arg;
+}
+
 TEST_P(parameterized_gmres, gmres_float)
 {
     Arguments arg = setup_gmres_arguments(GetParam());
@@ -83,6 +144,44 @@ TEST_P(parameterized_gmres_bad_precond, gmres_float)
     ASSERT_EQ(testing_gmres<float>(arg, false), true);
 }
 
+TEST_P(parameterized_gmres_ortho, gmres_ortho_float)
+{
+    Arguments arg = setup_gmres_ortho_arguments(GetParam());
+    ASSERT_EQ(testing_gmres<float>(arg), true);
+}
+
+TEST_P(parameterized_gmres_ortho, gmres_ortho_double)
+{
+    Arguments arg = setup_gmres_ortho_arguments(GetParam());
+    ASSERT_EQ(testing_gmres<double>(arg), true);
+}
+
+TEST_P(parameterized_gmres_ortho, gmres_ortho_reduced_basis_double)
+{
+    Arguments arg    = setup_gmres_ortho_arguments(GetParam());
+    arg.reducedbasis = 1;
+    ASSERT_EQ(testing_gmres<double>(arg), true);
+}
+
+TEST_P(parameterized_gmres_adaptive, gmres_adaptive_float)
+{
+    Arguments arg = setup_gmres_adaptive_arguments(GetParam());
+    ASSERT_EQ(testing_gmres<float>(arg), true);
+}
+
+TEST_P(parameterized_gmres_adaptive, gmres_adaptive_double)
+{
+    Arguments arg = setup_gmres_adaptive_arguments(GetParam());
+    ASSERT_EQ(testing_gmres<double>(arg), true);
+}
+
+TEST_P(parameterized_gmres_adaptive, gmres_adaptive_reduced_basis_double)
+{
+    Arguments arg    = setup_gmres_adaptive_arguments(GetParam());
+    arg.reducedbasis = 1;
+    ASSERT_EQ(testing_gmres<double>(arg), true);
+}
+
 INSTANTIATE_TEST_CASE_P(gmres,
                         parameterized_gmres,
                         testing::Combine(testing::ValuesIn(gmres_size),
@@ -98,3 +197,17 @@ INSTANTIATE_TEST_CASE_P(gmres_bad_precond,
                                          testing::ValuesIn(gmres_bad_precond_matrix),
                                          testing::ValuesIn(gmres_bad_precond),
                                          testing::ValuesIn(gmres_format)));
+
+INSTANTIATE_TEST_CASE_P(gmres_ortho,
+                        parameterized_gmres_ortho,
+                        testing::Combine(testing::ValuesIn(gmres_size),
+                                         testing::ValuesIn(gmres_basis),
+                                         testing::ValuesIn(gmres_ortho_precond),
+                                         testing::ValuesIn(gmres_ortho)));
+
+INSTANTIATE_TEST_CASE_P(gmres_adaptive,
+                        parameterized_gmres_adaptive,
+                        testing::Combine(testing::ValuesIn(gmres_size),
+                                         testing::ValuesIn(gmres_basis),
+                                         testing::ValuesIn(gmres_adaptive_precond),
+                                         testing::ValuesIn(gmres_adaptive)));
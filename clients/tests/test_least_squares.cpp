@@ -0,0 +1,69 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_least_squares.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, unsigned int> least_squares_tuple;
+
+int          least_squares_size[]   = {7, 31};
+std::string  least_squares_solver[] = {"CGLS", "LSQR"};
+unsigned int least_squares_format[] = {1, 6};
+
+class parameterized_least_squares : public testing::TestWithParam<least_squares_tuple>
+{
+protected:
+    parameterized_least_squares() {}
+    virtual ~parameterized_least_squares() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_least_squares_arguments(least_squares_tuple tup)
+{
+    Arguments arg;
+    arg.size   = std::get<0>(tup);
+    arg.solver = std::get<1>(tup);
+    arg.format = std::get<2>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_least_squares, least_squares_float)
+{
+    Arguments arg = setup_least_squares_arguments(GetParam());
+    ASSERT_EQ(testing_least_squares<float>(arg), true);
+}
+
+TEST_P(parameterized_least_squares, least_squares_double)
+{
+    Arguments arg = setup_least_squares_arguments(GetParam());
+    ASSERT_EQ(testing_least_squares<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(least_squares,
+                        parameterized_least_squares,
+                        testing::Combine(testing::ValuesIn(least_squares_size),
+                                         testing::ValuesIn(least_squares_solver),
+                                         testing::ValuesIn(least_squares_format)));
@@ -0,0 +1,69 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_local_hybrid_matrix.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, double> local_hybrid_matrix_tuple;
+
+int         local_hybrid_matrix_size[]          = {7, 32};
+std::string local_hybrid_matrix_solver[]        = {"CG", "GMRES"};
+double      local_hybrid_matrix_host_fraction[] = {-1.0, 0.0, 0.3, 1.0};
+
+class parameterized_local_hybrid_matrix : public testing::TestWithParam<local_hybrid_matrix_tuple>
+{
+protected:
+    parameterized_local_hybrid_matrix() {}
+    virtual ~parameterized_local_hybrid_matrix() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_local_hybrid_matrix_arguments(local_hybrid_matrix_tuple tup)
+{
+    Arguments arg;
+    arg.size   = std::get<0>(tup);
+    arg.solver = std::get<1>(tup);
+    arg.alpha  = std::get<2>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_local_hybrid_matrix, local_hybrid_matrix_float)
+{
+    Arguments arg = setup_local_hybrid_matrix_arguments(GetParam());
+    ASSERT_EQ(testing_local_hybrid_matrix<float>(arg), true);
+}
+
+TEST_P(parameterized_local_hybrid_matrix, local_hybrid_matrix_double)
+{
+    Arguments arg = setup_local_hybrid_matrix_arguments(GetParam());
+    ASSERT_EQ(testing_local_hybrid_matrix<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(local_hybrid_matrix,
+                        parameterized_local_hybrid_matrix,
+                        testing::Combine(testing::ValuesIn(local_hybrid_matrix_size),
+                                         testing::ValuesIn(local_hybrid_matrix_solver),
+                                         testing::ValuesIn(local_hybrid_matrix_host_fraction)));
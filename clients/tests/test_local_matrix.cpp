@@ -32,6 +32,8 @@ typedef std::tuple<int, int>              local_matrix_allocations_tuple;
 int         local_matrix_conversions_size[]     = {10, 17, 21};
 int         local_matrix_conversions_blockdim[] = {4, 7, 11};
 std::string local_matrix_type[]                 = {"Laplacian2D", "PermutedIdentity", "Random"};
+std::string local_matrix_spmv_type[]
+    = {"Laplacian2D", "PermutedIdentity", "Random", "HyperSparse", "WideRows"};
 
 int local_matrix_allocations_size[]     = {100, 1475, 2524};
 int local_matrix_allocations_blockdim[] = {4, 7, 11};
@@ -96,6 +98,221 @@ INSTANTIATE_TEST_CASE_P(local_matrix_conversions,
                                          testing::ValuesIn(local_matrix_conversions_blockdim),
                                          testing::ValuesIn(local_matrix_type)));
 
+TEST(local_matrix_spmv_alg, local_matrix)
+{
+    for(const std::string& type : local_matrix_spmv_type)
+    {
+        Arguments arg;
+        arg.size        = 21;
+        arg.matrix_type = type;
+
+        ASSERT_EQ(testing_local_matrix_spmv_alg<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_spmv_alg<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_out_of_core, local_matrix)
+{
+    for(int size : {7, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_out_of_core<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_out_of_core<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_fsai, local_matrix)
+{
+    for(int size : {7, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_fsai<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_fsai<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_ai_setup, local_matrix)
+{
+    for(int size : {7, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_ai_setup<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_ai_setup<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_maximal_independent_set, local_matrix)
+{
+    for(int size : {7, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_maximal_independent_set<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_maximal_independent_set<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_extract_submatrices, local_matrix)
+{
+    for(int size : {7, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_extract_submatrices<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_extract_submatrices<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_host_trsv, local_matrix)
+{
+    for(int size : {7, 100})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_host_trsv<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_host_trsv<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_update_values, local_matrix)
+{
+    for(int size : {7, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_update_values<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_update_values<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_assemble_coo, local_matrix)
+{
+    for(int size : {7, 100})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_assemble_coo<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_assemble_coo<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_coo_unsorted, local_matrix)
+{
+    for(int size : {7, 63})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_coo_unsorted<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_coo_unsorted<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_conversion_memory, local_matrix)
+{
+    for(int size : {7, 63})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_conversion_memory<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_conversion_memory<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_statistics, local_matrix)
+{
+    for(int size : {7, 63})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_statistics<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_statistics<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_symmetric_storage, local_matrix)
+{
+    for(int size : {7, 63})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_symmetric_storage<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_symmetric_storage<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_share_structure, local_matrix)
+{
+    for(int size : {7, 63})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_share_structure<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_share_structure<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_views, local_matrix)
+{
+    for(int size : {7, 63})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_views<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_views<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_apply_rows, local_matrix)
+{
+    for(int size : {7, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_apply_rows<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_apply_rows<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_matrix_add, local_matrix)
+{
+    for(int size : {7, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_matrix_add<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_matrix_add<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_rsio, local_matrix)
+{
+    // More than one chunk of a compressed file
+    Arguments arg;
+    arg.size = 400000;
+
+    ASSERT_EQ(testing_local_matrix_rsio<float>(arg), true);
+    ASSERT_EQ(testing_local_matrix_rsio<double>(arg), true);
+}
+
 TEST_P(parameterized_local_matrix_allocations, local_matrix_allocations_float)
 {
     Arguments arg = setup_local_matrix_allocations_arguments(GetParam());
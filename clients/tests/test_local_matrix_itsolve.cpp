@@ -159,3 +159,83 @@ INSTANTIATE_TEST_CASE_P(local_matrix_itsolve,
                         testing::Combine(testing::ValuesIn(local_matrix_solve_size),
                                          testing::ValuesIn(local_matrix_solve_format),
                                          testing::ValuesIn(local_matrix_solve_unit_diag)));
+
+TEST(local_matrix_tri_solver_auto, local_matrix_tri_solver_auto_float)
+{
+    for(int size : local_matrix_solve_size)
+    {
+        Arguments arg;
+        arg.size = size;
+        ASSERT_EQ(testing_local_matrix_tri_solver_auto<float>(arg), true);
+    }
+}
+
+TEST(local_matrix_tri_solver_auto, local_matrix_tri_solver_auto_double)
+{
+    for(int size : local_matrix_solve_size)
+    {
+        Arguments arg;
+        arg.size = size;
+        ASSERT_EQ(testing_local_matrix_tri_solver_auto<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_tri_block_inverse, local_matrix_tri_block_inverse_float)
+{
+    for(int size : local_matrix_solve_size)
+    {
+        Arguments arg;
+        arg.size = size;
+        ASSERT_EQ(testing_local_matrix_tri_block_inverse<float>(arg), true);
+    }
+}
+
+TEST(local_matrix_tri_block_inverse, local_matrix_tri_block_inverse_double)
+{
+    for(int size : local_matrix_solve_size)
+    {
+        Arguments arg;
+        arg.size = size;
+        ASSERT_EQ(testing_local_matrix_tri_block_inverse<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_refactorize, local_matrix_refactorize_float)
+{
+    for(int size : local_matrix_solve_size)
+    {
+        Arguments arg;
+        arg.size = size;
+        ASSERT_EQ(testing_local_matrix_refactorize<float>(arg), true);
+    }
+}
+
+TEST(local_matrix_refactorize, local_matrix_refactorize_double)
+{
+    for(int size : local_matrix_solve_size)
+    {
+        Arguments arg;
+        arg.size = size;
+        ASSERT_EQ(testing_local_matrix_refactorize<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_host_itilu0, local_matrix_host_itilu0_float)
+{
+    for(int size : local_matrix_solve_size)
+    {
+        Arguments arg;
+        arg.size = size;
+        ASSERT_EQ(testing_local_matrix_host_itilu0<float>(arg), true);
+    }
+}
+
+TEST(local_matrix_host_itilu0, local_matrix_host_itilu0_double)
+{
+    for(int size : local_matrix_solve_size)
+    {
+        Arguments arg;
+        arg.size = size;
+        ASSERT_EQ(testing_local_matrix_host_itilu0<double>(arg), true);
+    }
+}
@@ -0,0 +1,106 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_local_matrix_reordering.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, unsigned int> local_matrix_reordering_tuple;
+
+int          local_matrix_reordering_size[]   = {10, 17, 21};
+std::string  local_matrix_reordering_type[]   = {"Laplacian2D", "PermutedIdentity", "Random"};
+unsigned int local_matrix_reordering_format[] = {1};
+
+class parameterized_local_matrix_reordering
+    : public testing::TestWithParam<local_matrix_reordering_tuple>
+{
+protected:
+    parameterized_local_matrix_reordering() {}
+    virtual ~parameterized_local_matrix_reordering() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_local_matrix_reordering_arguments(local_matrix_reordering_tuple tup)
+{
+    Arguments arg;
+    arg.size        = std::get<0>(tup);
+    arg.matrix_type = std::get<1>(tup);
+    arg.format      = std::get<2>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_local_matrix_reordering, local_matrix_reordering_float)
+{
+    Arguments arg = setup_local_matrix_reordering_arguments(GetParam());
+    ASSERT_EQ(testing_local_matrix_reordering<float>(arg), true);
+}
+
+TEST_P(parameterized_local_matrix_reordering, local_matrix_reordering_double)
+{
+    Arguments arg = setup_local_matrix_reordering_arguments(GetParam());
+    ASSERT_EQ(testing_local_matrix_reordering<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(local_matrix_reordering,
+                        parameterized_local_matrix_reordering,
+                        testing::Combine(testing::ValuesIn(local_matrix_reordering_size),
+                                         testing::ValuesIn(local_matrix_reordering_type),
+                                         testing::ValuesIn(local_matrix_reordering_format)));
+
+TEST(local_matrix_graph_partition, local_matrix_reordering)
+{
+    for(int size : {10, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_graph_partition<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_graph_partition<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_fill_reducing, local_matrix_reordering)
+{
+    for(int size : {10, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_fill_reducing<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_fill_reducing<double>(arg), true);
+    }
+}
+
+TEST(local_matrix_permute, local_matrix_reordering)
+{
+    for(int size : {10, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_local_matrix_permute<float>(arg), true);
+        ASSERT_EQ(testing_local_matrix_permute<double>(arg), true);
+    }
+}
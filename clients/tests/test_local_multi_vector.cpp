@@ -0,0 +1,80 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "testing_local_multi_vector.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, std::string, unsigned int> local_multi_vector_apply_tuple;
+
+int          local_multi_vector_size[]        = {7, 30};
+int          local_multi_vector_nrhs[]        = {1, 8, 13};
+std::string  local_multi_vector_matrix_type[] = {"Laplacian2D", "Random"};
+unsigned int local_multi_vector_format[]      = {1, 4, 6};
+
+class parameterized_local_multi_vector_apply
+    : public testing::TestWithParam<local_multi_vector_apply_tuple>
+{
+protected:
+    parameterized_local_multi_vector_apply() {}
+    virtual ~parameterized_local_multi_vector_apply() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_local_multi_vector_apply_arguments(local_multi_vector_apply_tuple tup)
+{
+    Arguments arg;
+    arg.size        = std::get<0>(tup);
+    arg.nrhs        = std::get<1>(tup);
+    arg.matrix_type = std::get<2>(tup);
+    arg.format      = std::get<3>(tup);
+    arg.alpha       = -2.0;
+    return arg;
+}
+
+TEST(local_multi_vector_bad_args, local_multi_vector)
+{
+    testing_local_multi_vector_bad_args<float>();
+}
+
+TEST_P(parameterized_local_multi_vector_apply, local_multi_vector_apply_float)
+{
+    Arguments arg = setup_local_multi_vector_apply_arguments(GetParam());
+    ASSERT_EQ(testing_local_multi_vector_apply<float>(arg), true);
+}
+
+TEST_P(parameterized_local_multi_vector_apply, local_multi_vector_apply_double)
+{
+    Arguments arg = setup_local_multi_vector_apply_arguments(GetParam());
+    ASSERT_EQ(testing_local_multi_vector_apply<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(local_multi_vector_apply,
+                        parameterized_local_multi_vector_apply,
+                        testing::Combine(testing::ValuesIn(local_multi_vector_size),
+                                         testing::ValuesIn(local_multi_vector_nrhs),
+                                         testing::ValuesIn(local_multi_vector_matrix_type),
+                                         testing::ValuesIn(local_multi_vector_format)));
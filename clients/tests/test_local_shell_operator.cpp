@@ -0,0 +1,67 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_local_shell_operator.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string> local_shell_operator_tuple;
+
+int         local_shell_operator_size[]   = {7, 32};
+std::string local_shell_operator_solver[] = {"CG", "GMRES", "Chebyshev", "AMG"};
+
+class parameterized_local_shell_operator
+    : public testing::TestWithParam<local_shell_operator_tuple>
+{
+protected:
+    parameterized_local_shell_operator() {}
+    virtual ~parameterized_local_shell_operator() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_local_shell_operator_arguments(local_shell_operator_tuple tup)
+{
+    Arguments arg;
+    arg.size   = std::get<0>(tup);
+    arg.solver = std::get<1>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_local_shell_operator, local_shell_operator_float)
+{
+    Arguments arg = setup_local_shell_operator_arguments(GetParam());
+    ASSERT_EQ(testing_local_shell_operator<float>(arg), true);
+}
+
+TEST_P(parameterized_local_shell_operator, local_shell_operator_double)
+{
+    Arguments arg = setup_local_shell_operator_arguments(GetParam());
+    ASSERT_EQ(testing_local_shell_operator<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(local_shell_operator,
+                        parameterized_local_shell_operator,
+                        testing::Combine(testing::ValuesIn(local_shell_operator_size),
+                                         testing::ValuesIn(local_shell_operator_solver)));
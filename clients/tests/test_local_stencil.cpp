@@ -62,6 +62,15 @@ TEST(local_stencil_bad_args, local_stencil)
 {
     testing_local_stencil_bad_args<float>();
 }
+
+TEST(local_stencil_apply, local_stencil)
+{
+    Arguments arg;
+    arg.size = 19;
+
+    ASSERT_EQ(testing_local_stencil_apply<float>(arg), true);
+    ASSERT_EQ(testing_local_stencil_apply<double>(arg), true);
+}
 /*
 TEST_P(parameterized_backend, backend)
 {
@@ -62,6 +62,24 @@ TEST(local_vector_bad_args, local_vector)
 {
     testing_local_vector_bad_args<float>();
 }
+
+TEST(local_vector_scalars, local_vector)
+{
+    testing_local_vector_scalars<float>();
+    testing_local_vector_scalars<double>();
+}
+
+TEST(local_vector_unique, local_vector)
+{
+    testing_local_vector_unique<float>();
+    testing_local_vector_unique<double>();
+}
+
+TEST(local_vector_expression, local_vector)
+{
+    testing_local_vector_expression<float>();
+    testing_local_vector_expression<double>();
+}
 /*
 TEST_P(parameterized_backend, backend)
 {
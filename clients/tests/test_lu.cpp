@@ -67,3 +67,15 @@ INSTANTIATE_TEST_CASE_P(lu,
                         testing::Combine(testing::ValuesIn(lu_size),
                                          testing::ValuesIn(lu_format),
                                          testing::ValuesIn(lu_matrix_type)));
+
+TEST(lu_backend_move, lu)
+{
+    for(int size : {7, 21})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_lu_backend_move<float>(arg), true);
+        ASSERT_EQ(testing_lu_backend_move<double>(arg), true);
+    }
+}
@@ -0,0 +1,60 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_mixed_precision_ir.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string> mixed_precision_ir_tuple;
+
+int         mixed_precision_ir_size[]          = {7, 31};
+std::string mixed_precision_ir_factorization[] = {"LU", "ILU"};
+
+class parameterized_mixed_precision_ir : public testing::TestWithParam<mixed_precision_ir_tuple>
+{
+protected:
+    parameterized_mixed_precision_ir() {}
+    virtual ~parameterized_mixed_precision_ir() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_mixed_precision_ir_arguments(mixed_precision_ir_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.precond = std::get<1>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_mixed_precision_ir, mixed_precision_ir_double_float)
+{
+    Arguments arg = setup_mixed_precision_ir_arguments(GetParam());
+    ASSERT_EQ(testing_mixed_precision_ir(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(mixed_precision_ir,
+                        parameterized_mixed_precision_ir,
+                        testing::Combine(testing::ValuesIn(mixed_precision_ir_size),
+                                         testing::ValuesIn(mixed_precision_ir_factorization)));
@@ -29,7 +29,7 @@
 typedef std::tuple<int, std::string, unsigned int, int, int, int, int> pwamg_tuple;
 
 int          pwamg_size[]           = {63, 134};
-std::string  pwamg_smoother[]       = {"Jacobi"}; //, "MCILU"};
+std::string  pwamg_smoother[]       = {"Jacobi", "Chebyshev"}; //, "MCILU"};
 unsigned int pwamg_format[]         = {1, 7};
 int          pwamg_pre_iter[]       = {1, 2};
 int          pwamg_post_iter[]      = {1, 2};
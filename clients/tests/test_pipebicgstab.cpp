@@ -0,0 +1,72 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_pipebicgstab.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, std::string, unsigned int> pipebicgstab_tuple;
+
+int          pipebicgstab_size[]    = {7, 23};
+std::string  pipebicgstab_matrix[]  = {"laplacian", "convection"};
+std::string  pipebicgstab_precond[] = {"None", "Chebyshev", "Jacobi", "ILU", "MCGS", "MCILU"};
+unsigned int pipebicgstab_format[]  = {1, 2, 4, 6};
+
+class parameterized_pipebicgstab : public testing::TestWithParam<pipebicgstab_tuple>
+{
+protected:
+    parameterized_pipebicgstab() {}
+    virtual ~parameterized_pipebicgstab() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_pipebicgstab_arguments(pipebicgstab_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.matrix  = std::get<1>(tup);
+    arg.precond = std::get<2>(tup);
+    arg.format  = std::get<3>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_pipebicgstab, pipebicgstab_float)
+{
+    Arguments arg = setup_pipebicgstab_arguments(GetParam());
+    ASSERT_EQ(testing_pipebicgstab<float>(arg), true);
+}
+
+TEST_P(parameterized_pipebicgstab, pipebicgstab_double)
+{
+    Arguments arg = setup_pipebicgstab_arguments(GetParam());
+    ASSERT_EQ(testing_pipebicgstab<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(pipebicgstab,
+                        parameterized_pipebicgstab,
+                        testing::Combine(testing::ValuesIn(pipebicgstab_size),
+                                         testing::ValuesIn(pipebicgstab_matrix),
+                                         testing::ValuesIn(pipebicgstab_precond),
+                                         testing::ValuesIn(pipebicgstab_format)));
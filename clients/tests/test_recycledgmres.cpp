@@ -0,0 +1,75 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_recycledgmres.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, int, std::string, unsigned int> recycledgmres_tuple;
+
+int          recycledgmres_size[]    = {7, 63};
+int          recycledgmres_basis[]   = {20, 60};
+int          recycledgmres_recycle[] = {0, 10};
+std::string  recycledgmres_precond[] = {"None", "Jacobi", "ILU", "MCGS"};
+unsigned int recycledgmres_format[]  = {1, 2, 6};
+
+class parameterized_recycledgmres : public testing::TestWithParam<recycledgmres_tuple>
+{
+protected:
+    parameterized_recycledgmres() {}
+    virtual ~parameterized_recycledgmres() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_recycledgmres_arguments(recycledgmres_tuple tup)
+{
+    Arguments arg;
+    arg.size       = std::get<0>(tup);
+    arg.index      = std::get<1>(tup);
+    arg.chunk_size = std::get<2>(tup);
+    arg.precond    = std::get<3>(tup);
+    arg.format     = std::get<4>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_recycledgmres, recycledgmres_float)
+{
+    Arguments arg = setup_recycledgmres_arguments(GetParam());
+    ASSERT_EQ(testing_recycledgmres<float>(arg), true);
+}
+
+TEST_P(parameterized_recycledgmres, recycledgmres_double)
+{
+    Arguments arg = setup_recycledgmres_arguments(GetParam());
+    ASSERT_EQ(testing_recycledgmres<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(recycledgmres,
+                        parameterized_recycledgmres,
+                        testing::Combine(testing::ValuesIn(recycledgmres_size),
+                                         testing::ValuesIn(recycledgmres_basis),
+                                         testing::ValuesIn(recycledgmres_recycle),
+                                         testing::ValuesIn(recycledgmres_precond),
+                                         testing::ValuesIn(recycledgmres_format)));
@@ -26,16 +26,17 @@
 
 #include <gtest/gtest.h>
 
-typedef std::tuple<int, std::string, unsigned int, int, int, int, int, int> rsamg_tuple;
+typedef std::tuple<int, std::string, unsigned int, int, int, int, int, int, int> rsamg_tuple;
 
 int          rsamg_size[]           = {63, 134};
-std::string  rsamg_smoother[]       = {"Jacobi"};
+std::string  rsamg_smoother[]       = {"Jacobi", "Chebyshev"};
 unsigned int rsamg_format[]         = {1, 7};
 int          rsamg_pre_iter[]       = {1, 2};
 int          rsamg_post_iter[]      = {1, 2};
 int          rsamg_cycle[]          = {0, 1};
 int          rsamg_scaling[]        = {0, 1};
 int          rsamg_rebuildnumeric[] = {0, 1};
+int          rsamg_fused[]          = {0, 1};
 
 class parameterized_ruge_stueben_amg : public testing::TestWithParam<rsamg_tuple>
 {
@@ -57,6 +58,7 @@ Arguments setup_rsamg_arguments(rsamg_tuple tup)
     arg.cycle          = std::get<5>(tup);
     arg.ordering       = std::get<6>(tup);
     arg.rebuildnumeric = std::get<7>(tup);
+    arg.fused          = std::get<8>(tup);
     return arg;
 }
 
@@ -81,4 +83,5 @@ INSTANTIATE_TEST_CASE_P(ruge_stueben_amg,
                                          testing::ValuesIn(rsamg_post_iter),
                                          testing::ValuesIn(rsamg_cycle),
                                          testing::ValuesIn(rsamg_scaling),
-                                         testing::ValuesIn(rsamg_rebuildnumeric)));
+                                         testing::ValuesIn(rsamg_rebuildnumeric),
+                                         testing::ValuesIn(rsamg_fused)));
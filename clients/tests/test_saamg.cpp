@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2022 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -26,9 +26,20 @@
 
 #include <gtest/gtest.h>
 
-typedef std::
-    tuple<int, int, int, std::string, std::string, std::string, unsigned int, int, int, int>
-        saamg_tuple;
+typedef std::tuple<int,
+                   int,
+                   int,
+                   std::string,
+                   std::string,
+                   std::string,
+                   unsigned int,
+                   int,
+                   int,
+                   int,
+                   std::string>
+    saamg_tuple;
+
+typedef std::tuple<int, std::string, int, std::string> saamg_option_tuple;
 
 int          saamg_size[]             = {22, 63, 134, 207};
 int          saamg_pre_iter[]         = {2};
@@ -40,6 +51,29 @@ unsigned int saamg_format[]           = {1, 6};
 int          saamg_cycle[]            = {2};
 int          saamg_scaling[]          = {1};
 int          saamg_rebuildnumeric[]   = {0, 1};
+std::string  saamg_mode[]             = {"Default"};
+
+// Hierarchy setup modes on a reduced grid
+int         saamg_mode_size[]     = {63};
+std::string saamg_mode_smoother[] = {"FSAI"};
+int         saamg_mode_rebuild[]  = {0};
+std::string saamg_modes[]         = {"FrozenHierarchy",
+                                     "IncrementalUpdate",
+                                     "SkipUnchanged",
+                                     "Aggressive",
+                                     "LowMemory",
+                                     "Hybrid",
+                                     "Additive"};
+
+// Options of the SAAMG preconditioned CG, see testing_saamg_option()
+int         saamg_option_size[]       = {22, 63};
+int         saamg_option_aggressive[] = {0, 1};
+std::string saamg_options[]           = {"MixedPrecision",
+                                         "Block",
+                                         "NullSpace",
+                                         "Truncation",
+                                         "Sparsification",
+                                         "HierarchyIO"};
 
 class parameterized_saamg : public testing::TestWithParam<saamg_tuple>
 {
@@ -64,6 +98,41 @@ Arguments setup_saamg_arguments(saamg_tuple tup)
     arg.ordering            = std::get<8>(tup);
     arg.rebuildnumeric      = std::get<9>(tup);
 
+    std::string mode = std::get<10>(tup);
+
+    if(mode == "FrozenHierarchy")
+    {
+        // Frozen hierarchy rebuilds
+        arg.rebuildnumeric = 2;
+    }
+    else if(mode == "IncrementalUpdate")
+    {
+        // Incremental update of the first rows
+        arg.rebuildnumeric = 3;
+    }
+    else if(mode == "SkipUnchanged")
+    {
+        arg.rebuildnumeric = 4;
+    }
+    else if(mode == "Aggressive")
+    {
+        arg.aggressive = 1;
+    }
+    else if(mode == "LowMemory")
+    {
+        // The low memory setup is also rebuilt with new values
+        arg.lowmemory      = 1;
+        arg.rebuildnumeric = 1;
+    }
+    else if(mode == "Hybrid")
+    {
+        arg.hybrid = 1;
+    }
+    else if(mode == "Additive")
+    {
+        arg.cycle = 4;
+    }
+
     return arg;
 }
 
@@ -90,4 +159,70 @@ INSTANTIATE_TEST_CASE_P(saamg,
                                          testing::ValuesIn(saamg_format),
                                          testing::ValuesIn(saamg_cycle),
                                          testing::ValuesIn(saamg_scaling),
-                                         testing::ValuesIn(saamg_rebuildnumeric)));
+                                         testing::ValuesIn(saamg_rebuildnumeric),
+                                         testing::ValuesIn(saamg_mode)));
+
+INSTANTIATE_TEST_CASE_P(saamg_modes,
+                        parameterized_saamg,
+                        testing::Combine(testing::ValuesIn(saamg_mode_size),
+                                         testing::ValuesIn(saamg_pre_iter),
+                                         testing::ValuesIn(saamg_post_iter),
+                                         testing::ValuesIn(saamg_mode_smoother),
+                                         testing::ValuesIn(saamg_coarsening_strat),
+                                         testing::ValuesIn(saamg_matrix_type),
+                                         testing::ValuesIn(saamg_format),
+                                         testing::ValuesIn(saamg_cycle),
+                                         testing::ValuesIn(saamg_scaling),
+                                         testing::ValuesIn(saamg_mode_rebuild),
+                                         testing::ValuesIn(saamg_modes)));
+
+class parameterized_saamg_option : public testing::TestWithParam<saamg_option_tuple>
+{
+protected:
+    parameterized_saamg_option() {}
+    virtual ~parameterized_saamg_option() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_saamg_option_arguments(saamg_option_tuple tup)
+{
+    Arguments arg;
+    arg.size                = std::get<0>(tup);
+    arg.coarsening_strategy = std::get<1>(tup);
+    arg.aggressive          = std::get<2>(tup);
+    arg.blockdim            = 2;
+
+    return arg;
+}
+
+TEST_P(parameterized_saamg_option, saamg_option_float)
+{
+    Arguments arg = setup_saamg_option_arguments(GetParam());
+    ASSERT_EQ(testing_saamg_option<float>(arg, std::get<3>(GetParam())), true);
+}
+
+TEST_P(parameterized_saamg_option, saamg_option_double)
+{
+    Arguments arg = setup_saamg_option_arguments(GetParam());
+    ASSERT_EQ(testing_saamg_option<double>(arg, std::get<3>(GetParam())), true);
+}
+
+INSTANTIATE_TEST_CASE_P(saamg_option,
+                        parameterized_saamg_option,
+                        testing::Combine(testing::ValuesIn(saamg_option_size),
+                                         testing::ValuesIn(saamg_coarsening_strat),
+                                         testing::ValuesIn(saamg_option_aggressive),
+                                         testing::ValuesIn(saamg_options)));
+
+TEST(saamg_multi, saamg_double)
+{
+    for(int size : {22, 63})
+    {
+        Arguments arg;
+        arg.size = size;
+        arg.nrhs = 4;
+
+        ASSERT_EQ(testing_saamg_multi<double>(arg), true);
+    }
+}
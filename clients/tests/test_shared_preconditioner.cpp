@@ -0,0 +1,67 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_shared_preconditioner.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string> shared_preconditioner_tuple;
+
+int         shared_preconditioner_size[]    = {7, 63};
+std::string shared_preconditioner_precond[] = {"SAAMG", "ILU"};
+
+class parameterized_shared_preconditioner
+    : public testing::TestWithParam<shared_preconditioner_tuple>
+{
+protected:
+    parameterized_shared_preconditioner() {}
+    virtual ~parameterized_shared_preconditioner() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_shared_preconditioner_arguments(shared_preconditioner_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.precond = std::get<1>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_shared_preconditioner, shared_preconditioner_float)
+{
+    Arguments arg = setup_shared_preconditioner_arguments(GetParam());
+    ASSERT_EQ(testing_shared_preconditioner<float>(arg), true);
+}
+
+TEST_P(parameterized_shared_preconditioner, shared_preconditioner_double)
+{
+    Arguments arg = setup_shared_preconditioner_arguments(GetParam());
+    ASSERT_EQ(testing_shared_preconditioner<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(shared_preconditioner,
+                        parameterized_shared_preconditioner,
+                        testing::Combine(testing::ValuesIn(shared_preconditioner_size),
+                                         testing::ValuesIn(shared_preconditioner_precond)));
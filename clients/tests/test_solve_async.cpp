@@ -0,0 +1,69 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_solve_async.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, unsigned int> solve_async_tuple;
+
+int          solve_async_size[]   = {7, 63};
+std::string  solve_async_solver[] = {"CG", "BiCGStab", "GMRES"};
+unsigned int solve_async_format[] = {1, 2, 6};
+
+class parameterized_solve_async : public testing::TestWithParam<solve_async_tuple>
+{
+protected:
+    parameterized_solve_async() {}
+    virtual ~parameterized_solve_async() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_solve_async_arguments(solve_async_tuple tup)
+{
+    Arguments arg;
+    arg.size   = std::get<0>(tup);
+    arg.solver = std::get<1>(tup);
+    arg.format = std::get<2>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_solve_async, solve_async_float)
+{
+    Arguments arg = setup_solve_async_arguments(GetParam());
+    ASSERT_EQ(testing_solve_async<float>(arg), true);
+}
+
+TEST_P(parameterized_solve_async, solve_async_double)
+{
+    Arguments arg = setup_solve_async_arguments(GetParam());
+    ASSERT_EQ(testing_solve_async<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(solve_async,
+                        parameterized_solve_async,
+                        testing::Combine(testing::ValuesIn(solve_async_size),
+                                         testing::ValuesIn(solve_async_solver),
+                                         testing::ValuesIn(solve_async_format)));
@@ -0,0 +1,69 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_solver_checkpoint.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, std::string> solver_checkpoint_tuple;
+
+int         solver_checkpoint_size[]    = {22, 63};
+std::string solver_checkpoint_solver[]  = {"CG", "GMRES"};
+std::string solver_checkpoint_precond[] = {"None", "Jacobi"};
+
+class parameterized_solver_checkpoint : public testing::TestWithParam<solver_checkpoint_tuple>
+{
+protected:
+    parameterized_solver_checkpoint() {}
+    virtual ~parameterized_solver_checkpoint() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_solver_checkpoint_arguments(solver_checkpoint_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.solver  = std::get<1>(tup);
+    arg.precond = std::get<2>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_solver_checkpoint, solver_checkpoint_float)
+{
+    Arguments arg = setup_solver_checkpoint_arguments(GetParam());
+    ASSERT_EQ(testing_solver_checkpoint<float>(arg), true);
+}
+
+TEST_P(parameterized_solver_checkpoint, solver_checkpoint_double)
+{
+    Arguments arg = setup_solver_checkpoint_arguments(GetParam());
+    ASSERT_EQ(testing_solver_checkpoint<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(solver_checkpoint,
+                        parameterized_solver_checkpoint,
+                        testing::Combine(testing::ValuesIn(solver_checkpoint_size),
+                                         testing::ValuesIn(solver_checkpoint_solver),
+                                         testing::ValuesIn(solver_checkpoint_precond)));
@@ -0,0 +1,72 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_solver_workspace.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, std::string, unsigned int> solver_workspace_tuple;
+
+int          solver_workspace_size[]   = {7, 63};
+int          solver_workspace_basis[]  = {20, 60};
+std::string  solver_workspace_solver[] = {"GMRES", "SAAMG"};
+unsigned int solver_workspace_format[] = {1, 2, 6};
+
+class parameterized_solver_workspace : public testing::TestWithParam<solver_workspace_tuple>
+{
+protected:
+    parameterized_solver_workspace() {}
+    virtual ~parameterized_solver_workspace() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_solver_workspace_arguments(solver_workspace_tuple tup)
+{
+    Arguments arg;
+    arg.size   = std::get<0>(tup);
+    arg.index  = std::get<1>(tup);
+    arg.solver = std::get<2>(tup);
+    arg.format = std::get<3>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_solver_workspace, solver_workspace_float)
+{
+    Arguments arg = setup_solver_workspace_arguments(GetParam());
+    ASSERT_EQ(testing_solver_workspace<float>(arg), true);
+}
+
+TEST_P(parameterized_solver_workspace, solver_workspace_double)
+{
+    Arguments arg = setup_solver_workspace_arguments(GetParam());
+    ASSERT_EQ(testing_solver_workspace<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(solver_workspace,
+                        parameterized_solver_workspace,
+                        testing::Combine(testing::ValuesIn(solver_workspace_size),
+                                         testing::ValuesIn(solver_workspace_basis),
+                                         testing::ValuesIn(solver_workspace_solver),
+                                         testing::ValuesIn(solver_workspace_format)));
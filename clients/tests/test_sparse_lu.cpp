@@ -0,0 +1,78 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_sparse_lu.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int> sparse_lu_tuple;
+
+int sparse_lu_size[]     = {7, 16, 21};
+int sparse_lu_ordering[] = {0, 8};
+
+class parameterized_sparse_lu : public testing::TestWithParam<sparse_lu_tuple>
+{
+protected:
+    parameterized_sparse_lu() {}
+    virtual ~parameterized_sparse_lu() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_sparse_lu_arguments(sparse_lu_tuple tup)
+{
+    Arguments arg;
+    arg.size     = std::get<0>(tup);
+    arg.ordering = std::get<1>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_sparse_lu, sparse_lu_float)
+{
+    Arguments arg = setup_sparse_lu_arguments(GetParam());
+    ASSERT_EQ(testing_sparse_lu<float>(arg), true);
+}
+
+TEST_P(parameterized_sparse_lu, sparse_lu_double)
+{
+    Arguments arg = setup_sparse_lu_arguments(GetParam());
+    ASSERT_EQ(testing_sparse_lu<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(sparse_lu,
+                        parameterized_sparse_lu,
+                        testing::Combine(testing::ValuesIn(sparse_lu_size),
+                                         testing::ValuesIn(sparse_lu_ordering)));
+
+TEST(sparse_lu_coarse_solver, sparse_lu)
+{
+    for(int size : {16, 32})
+    {
+        Arguments arg;
+        arg.size = size;
+
+        ASSERT_EQ(testing_sparse_lu_coarse_solver<float>(arg), true);
+        ASSERT_EQ(testing_sparse_lu_coarse_solver<double>(arg), true);
+    }
+}
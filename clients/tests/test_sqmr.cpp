@@ -0,0 +1,72 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_sqmr.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, std::string, unsigned int> sqmr_tuple;
+
+int          sqmr_size[]    = {7, 63};
+std::string  sqmr_matrix[]  = {"laplacian", "indefinite"};
+std::string  sqmr_precond[] = {"None", "Jacobi", "SGS"};
+unsigned int sqmr_format[]  = {1, 2, 6};
+
+class parameterized_sqmr : public testing::TestWithParam<sqmr_tuple>
+{
+protected:
+    parameterized_sqmr() {}
+    virtual ~parameterized_sqmr() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_sqmr_arguments(sqmr_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.matrix  = std::get<1>(tup);
+    arg.precond = std::get<2>(tup);
+    arg.format  = std::get<3>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_sqmr, sqmr_float)
+{
+    Arguments arg = setup_sqmr_arguments(GetParam());
+    ASSERT_EQ(testing_sqmr<float>(arg), true);
+}
+
+TEST_P(parameterized_sqmr, sqmr_double)
+{
+    Arguments arg = setup_sqmr_arguments(GetParam());
+    ASSERT_EQ(testing_sqmr<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(sqmr,
+                        parameterized_sqmr,
+                        testing::Combine(testing::ValuesIn(sqmr_size),
+                                         testing::ValuesIn(sqmr_matrix),
+                                         testing::ValuesIn(sqmr_precond),
+                                         testing::ValuesIn(sqmr_format)));
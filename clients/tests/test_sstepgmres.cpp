@@ -0,0 +1,75 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_sstepgmres.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, int, std::string, unsigned int> sstepgmres_tuple;
+
+int          sstepgmres_size[]    = {7, 63};
+int          sstepgmres_basis[]   = {20, 60};
+int          sstepgmres_step[]    = {1, 4};
+std::string  sstepgmres_precond[] = {"None", "Jacobi", "ILU", "MCGS"};
+unsigned int sstepgmres_format[]  = {1, 2, 6};
+
+class parameterized_sstepgmres : public testing::TestWithParam<sstepgmres_tuple>
+{
+protected:
+    parameterized_sstepgmres() {}
+    virtual ~parameterized_sstepgmres() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_sstepgmres_arguments(sstepgmres_tuple tup)
+{
+    Arguments arg;
+    arg.size       = std::get<0>(tup);
+    arg.index      = std::get<1>(tup);
+    arg.chunk_size = std::get<2>(tup);
+    arg.precond    = std::get<3>(tup);
+    arg.format     = std::get<4>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_sstepgmres, sstepgmres_float)
+{
+    Arguments arg = setup_sstepgmres_arguments(GetParam());
+    ASSERT_EQ(testing_sstepgmres<float>(arg), true);
+}
+
+TEST_P(parameterized_sstepgmres, sstepgmres_double)
+{
+    Arguments arg = setup_sstepgmres_arguments(GetParam());
+    ASSERT_EQ(testing_sstepgmres<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(sstepgmres,
+                        parameterized_sstepgmres,
+                        testing::Combine(testing::ValuesIn(sstepgmres_size),
+                                         testing::ValuesIn(sstepgmres_basis),
+                                         testing::ValuesIn(sstepgmres_step),
+                                         testing::ValuesIn(sstepgmres_precond),
+                                         testing::ValuesIn(sstepgmres_format)));
@@ -27,7 +27,7 @@
 #include <gtest/gtest.h>
 
 typedef std::
-    tuple<int, int, int, std::string, std::string, std::string, unsigned int, int, int, int>
+    tuple<int, int, int, std::string, std::string, std::string, unsigned int, int, int, int, int>
         uaamg_tuple;
 
 int          uaamg_size[]             = {22, 63, 134, 157};
@@ -39,7 +39,8 @@ std::string  uaamg_matrix_type[]      = {"Laplacian2D", "Laplacian3D"};
 unsigned int uaamg_format[]           = {1, 6};
 int          uaamg_cycle[]            = {2};
 int          uaamg_scaling[]          = {1};
-int          uaamg_rebuildnumeric[]   = {0, 1};
+int          uaamg_rebuildnumeric[]   = {0, 1, 2};
+int          uaamg_matrixfree[]       = {0, 1};
 
 class parameterized_uaamg : public testing::TestWithParam<uaamg_tuple>
 {
@@ -63,6 +64,7 @@ Arguments setup_uaamg_arguments(uaamg_tuple tup)
     arg.cycle               = std::get<7>(tup);
     arg.ordering            = std::get<8>(tup);
     arg.rebuildnumeric      = std::get<9>(tup);
+    arg.matrixfree          = std::get<10>(tup);
 
     return arg;
 }
@@ -90,4 +92,5 @@ INSTANTIATE_TEST_CASE_P(uaamg,
                                          testing::ValuesIn(uaamg_format),
                                          testing::ValuesIn(uaamg_cycle),
                                          testing::ValuesIn(uaamg_scaling),
-                                         testing::ValuesIn(uaamg_rebuildnumeric)));
+                                         testing::ValuesIn(uaamg_rebuildnumeric),
+                                         testing::ValuesIn(uaamg_matrixfree)));
@@ -26,6 +26,8 @@ function display_help()
   echo "    [--verbose] print additional cmake build information"
   echo "    [--address-sanitizer] Build with address sanitizer enabled. Uses hipcc as compiler"
   echo "    [--codecoverage] build with code coverage profiling enabled"
+  echo "    [--roctx] build with roctx range markers for rocprof / omnitrace timelines"
+  echo "    [--trace] build with the built-in timeline trace (Chrome trace JSON)"
   echo "    [--rm-legacy-include-dir] Remove legacy include dir Packaging added for file/folder reorg backward compatibility"
 }
 
@@ -275,6 +277,8 @@ build_relocatable=false
 build_static=false
 build_address_sanitizer=false
 build_codecoverage=false
+build_roctx=false
+build_trace=false
 build_freorg_bkwdcomp=false
 compiler=c++
 verb=false
@@ -286,7 +290,7 @@ verb=false
 # check if we have a modern version of getopt that can handle whitespace and long parameters
 getopt -T
 if [[ $? -eq 4 ]]; then
-  GETOPT_PARSE=$(getopt --name "${0}" --longoptions help,install,clients,dependencies,debug,build-dir:,host,no-openmp,mpi:,relocatable,codecoverage,static,compiler:,verbose,address-sanitizer,rm-legacy-include-dir --options hicgdr -- "$@")
+  GETOPT_PARSE=$(getopt --name "${0}" --longoptions help,install,clients,dependencies,debug,build-dir:,host,no-openmp,mpi:,relocatable,codecoverage,roctx,trace,static,compiler:,verbose,address-sanitizer,rm-legacy-include-dir --options hicgdr -- "$@")
 else
   echo "Need a new version of getopt"
   exit 1
@@ -336,6 +340,12 @@ while true; do
     --codecoverage)
         build_codecoverage=true
         shift ;;
+    --roctx)
+        build_roctx=true
+        shift ;;
+    --trace)
+        build_trace=true
+        shift ;;
     --rm-legacy-include-dir)
         build_freorg_bkwdcomp=false
         shift ;;
@@ -502,6 +512,16 @@ pushd .
       cmake_common_options="${cmake_common_options} -DBUILD_CODE_COVERAGE=ON"
   fi
 
+  # roctx range markers
+  if [[ "${build_roctx}" == true ]]; then
+    cmake_common_options="${cmake_common_options} -DBUILD_WITH_ROCTX=ON"
+  fi
+
+  # Built-in timeline trace
+  if [[ "${build_trace}" == true ]]; then
+    cmake_common_options="${cmake_common_options} -DBUILD_WITH_TRACE=ON"
+  fi
+
   #Enable backward compatibility wrappers
   if [[ "${build_freorg_bkwdcomp}" == true ]]; then
     cmake_common_options="${cmake_common_options} -DBUILD_FILE_REORG_BACKWARD_COMPATIBILITY=ON"
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+
+# ########################################################################
+# Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# ########################################################################
+
+import argparse
+import subprocess
+import os
+import sys
+import tempfile
+import json
+import datetime
+
+#
+# Metrics that are gated, with a flag telling whether a larger value is better.
+#
+kernel_metrics = [('bandwidth', True)]
+solver_metrics = [('time_analyze', False), ('time_solve', False)]
+
+def prefix():
+    return '//rocalution-bench-perf-gate'
+
+#
+# Run one case of the corpus and return its median metrics, or None if the case is skipped.
+#
+def run_case(prog, cmdline, datadir, nruns, verbose):
+    if '${ROCALUTION_BENCH_DATA_DIR}' in cmdline:
+        if datadir == None:
+            print(prefix() + ':warning skip \'' + cmdline + '\', ROCALUTION_BENCH_DATA_DIR is not defined.')
+            return None
+        cmdline = cmdline.replace('${ROCALUTION_BENCH_DATA_DIR}', datadir)
+        for w in cmdline.split(' '):
+            if w.startswith(datadir) and not os.path.isfile(w):
+                print(prefix() + ':warning skip \'' + cmdline + '\', unable to find ' + w)
+                return None
+
+    fd, ofilename = tempfile.mkstemp(suffix='.json')
+    os.close(fd)
+    subprocess_arg = [prog] + cmdline.split(' ') + ['--bench-n', str(nruns), '--bench-o', ofilename]
+    if verbose:
+        print(prefix() + ':verbose:execute command "' + ' '.join(subprocess_arg) + '"')
+    proc = subprocess.Popen(subprocess_arg, stdout=subprocess.DEVNULL)
+    proc.wait()
+    rc = proc.returncode
+    if rc != 0:
+        print(prefix() + ':failure \'' + cmdline + '\' (err=' + str(rc) + ')')
+        exit(1)
+
+    with open(ofilename, "r") as f:
+        data = json.load(f)
+    os.remove(ofilename)
+    if os.path.isfile(ofilename + '.csv'):
+        os.remove(ofilename + '.csv')
+
+    median = data['results'][0]['timing']['median']
+    metrics = {}
+    if 'kernels' in median:
+        for k in median['kernels']:
+            for m, _ in kernel_metrics:
+                metrics[k['kernel'] + '.' + m] = float(k[m])
+    else:
+        for m, _ in solver_metrics:
+            metrics[m] = float(median[m])
+    return metrics
+
+#
+# Relative loss of throughput in percent, positive values are regressions.
+#
+def relative_loss(metric, value, reference):
+    larger_is_better = False
+    for m, b in kernel_metrics + solver_metrics:
+        if metric.endswith(m):
+            larger_is_better = b
+    if reference == 0.0 or value == 0.0:
+        return 0.0
+    if larger_is_better:
+        return 100.0 * (reference - value) / reference
+    return 100.0 * (1.0 - reference / value)
+
+def main():
+    parser = argparse.ArgumentParser(formatter_class=argparse.RawDescriptionHelpFormatter,description="Run a corpus of rocalution-bench commands and compare the throughput against a stored baseline", epilog="The corpus .json file must contain an array 'cmdlines' of strings, as for rocalution-bench-execute.py. Kernel cases (--kernel) are gated on the bandwidth of each kernel, solver cases on time_analyze and time_solve. The script exits with a non-zero status if a metric is worse than the baseline by more than the tolerance.\n")
+    parser.add_argument('-w', '--workingdir',      required=False, default = './')
+    parser.add_argument('-c', '--corpus',          required=True)
+    parser.add_argument('-b', '--baseline',        required=True)
+    parser.add_argument('-t', '--tol',             required=False, default = 5.0, type=float, help='tolerance in percent')
+    parser.add_argument('-n', '--nruns',           required=False, default = 5, type=int, help='number of runs per case, the median is compared')
+    parser.add_argument('-o', '--output',          required=False, default = None, help='write the current results to this file')
+    parser.add_argument('-u', '--update-baseline', required=False, default = False, action = "store_true")
+    parser.add_argument('-v', '--verbose',         required=False, default = False, action = "store_true")
+    user_args, unknown_args = parser.parse_known_args()
+
+    verbose = user_args.verbose
+    percentage_tol = user_args.tol
+    datadir = os.getenv('ROCALUTION_BENCH_DATA_DIR')
+
+    prog = os.path.join(user_args.workingdir, "rocalution-bench")
+    if not os.path.isfile(prog):
+        print("**** Error: unable to find " + prog)
+        sys.exit(1)
+
+    with open(user_args.corpus, "r") as f:
+        cmdlines = json.load(f)['cmdlines']
+
+    #
+    # Run the corpus.
+    #
+    results = {}
+    for cmdline in cmdlines:
+        metrics = run_case(prog, cmdline, datadir, user_args.nruns, verbose)
+        if metrics != None:
+            results[cmdline] = metrics
+
+    current = {'date': str(datetime.datetime.now()), 'cases': results}
+    if user_args.output != None:
+        with open(user_args.output, "w") as f:
+            json.dump(current, f, indent=2)
+
+    if user_args.update_baseline:
+        with open(user_args.baseline, "w") as f:
+            json.dump(current, f, indent=2)
+        print(prefix() + ' baseline \'' + user_args.baseline + '\' updated (' + str(len(results)) + ' cases).')
+        return
+
+    with open(user_args.baseline, "r") as f:
+        baseline = json.load(f)['cases']
+
+    #
+    # Compare against the baseline.
+    #
+    if verbose:
+        print(prefix() + ' percentage_tol: ' + str(percentage_tol) + '%')
+
+    regression = False
+    for cmdline, metrics in results.items():
+        if not cmdline in baseline:
+            print(prefix() + ':warning no baseline for \'' + cmdline + '\'')
+            continue
+        for metric, value in metrics.items():
+            if not metric in baseline[cmdline]:
+                print(prefix() + ':warning no baseline for \'' + metric + '\' of \'' + cmdline + '\'')
+                continue
+            reference = baseline[cmdline][metric]
+            loss = relative_loss(metric, value, reference)
+            if loss > percentage_tol:
+                regression = True
+                print(prefix() + '   FAIL ' + metric + ' loses ' + "{:.2f}".format(loss) + '% (tolerance ' + str(percentage_tol) + '%), ' + "{:.4g}".format(value) + ' vs ' + "{:.4g}".format(reference) + ' from \'' + cmdline + '\'')
+            elif verbose:
+                print(prefix() + '   PASS ' + metric + ' ' + "{:.2f}".format(-loss) + '% from \'' + cmdline + '\'')
+
+    if regression:
+        print(prefix() + ' FAILED')
+        exit(1)
+    print(prefix() + ' PASSED')
+
+if __name__ == "__main__":
+    main()
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -24,8 +24,10 @@
 #include "backend_manager.hpp"
 #include "../utils/def.hpp"
 #include "../utils/log.hpp"
+#include "../utils/time_functions.hpp"
 #include "base_matrix.hpp"
 #include "base_rocalution.hpp"
+#include "base_stencil.hpp"
 #include "base_vector.hpp"
 #include "host/host_affinity.hpp"
 #include "host/host_matrix_bcsr.hpp"
@@ -36,11 +38,24 @@
 #include "host/host_matrix_ell.hpp"
 #include "host/host_matrix_hyb.hpp"
 #include "host/host_matrix_mcsr.hpp"
+#include "host/host_matrix_sell.hpp"
+#include "host/host_matrix_vbr.hpp"
+#include "host/host_stencil_laplace2d.hpp"
+#include "host/host_stencil_laplace3d.hpp"
 #include "host/host_vector.hpp"
+#include "stencil_types.hpp"
 #include "rocalution/version.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
 #include <stdlib.h>
 #include <string.h>
+#include <unordered_map>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -76,6 +91,9 @@ namespace rocalution
         0, // pre-init OpenMP threads
         true, // host affinity (active)
         10000, // threshold size
+        false, // threshold calibration
+        {-1, -1}, // threshold size per operation class
+        {{0}}, // threads per operation and size class
         // HIP section
         NULL, // *HIP_blas_handle
         NULL, // *HIP_sparse_handle
@@ -89,8 +107,15 @@ namespace rocalution
         65535, // Maximum threads in the block
         13, // HIP_num_procs
         2048, // HIP_threads_per_proc
+        true, // HIP memory pool
+        false, // HIP managed memory
         // MPI rank/id
         0,
+        NULL, // MPI communicator
+        -1, // MPI communicator id
+        false, // GPU-aware MPI
+        false, // strict host fallback
+        false, // reproducible reductions
         // LOG
         0,
         NULL // FILE, file log
@@ -107,7 +132,234 @@ namespace rocalution
     /// Backend names
     const std::string _rocalution_backend_name[2] = {"None", "HIP"};
 
-    int init_rocalution(int rank, int dev_per_node)
+    // Bind the host cpus of the process to the NUMA node of its device
+    static bool _rocalution_topology_binding = false;
+
+    // Topology binding can also be requested through the environment
+    static bool _rocalution_topology_binding_enabled(void)
+    {
+        const char* str_binding = getenv("ROCALUTION_TOPOLOGY_BINDING");
+
+        return _rocalution_topology_binding == true
+               || (str_binding != NULL && atoi(str_binding) == 1);
+    }
+
+    // Restrict the host cpus of the process to the NUMA node its device is attached to.
+    // The cpus of the node are split among the nslots processes that share it.
+    static void _rocalution_bind_topology(int device, int slot, int nslots)
+    {
+#ifdef SUPPORT_HIP
+        int node = rocalution_hip_device_numa_node(device);
+        int ncpu = rocalution_bind_numa_node(node, slot, nslots);
+
+        if(ncpu == 0)
+        {
+            LOG_VERBOSE_INFO(2, "No NUMA information for device " << device << ", no binding");
+            return;
+        }
+
+#ifdef _OPENMP
+        // One thread per bound cpu at most
+        if(omp_get_max_threads() > ncpu)
+        {
+            omp_set_num_threads(ncpu);
+        }
+#endif
+#endif
+    }
+
+#ifdef _OPENMP
+    // Best time of three runs of reps calls of func with nthreads OpenMP threads
+    template <typename Func>
+    static double _rocalution_omp_time(int nthreads, int reps, Func func)
+    {
+        omp_set_num_threads(nthreads);
+
+        // Warm up the thread pool and the caches
+        func();
+
+        double best = std::numeric_limits<double>::max();
+
+        for(int t = 0; t < 3; ++t)
+        {
+            double tick = rocalution_time();
+
+            for(int r = 0; r < reps; ++r)
+            {
+                func();
+            }
+
+            best = std::min(best, rocalution_time() - tick);
+        }
+
+        return best;
+    }
+#endif
+
+    // Calibrate the OpenMP threshold size and the number of threads per size class of the
+    // host operation classes with short microbenchmarks
+    static void _rocalution_calibrate_omp(void)
+    {
+#ifdef _OPENMP
+        Rocalution_Backend_Descriptor* backend = _get_backend_descriptor();
+
+        int max_threads = backend->OpenMP_threads;
+
+        if(max_threads <= 1)
+        {
+            return;
+        }
+
+        double tick = rocalution_time();
+
+        // Probed thread counts, powers of two and the maximum
+        std::vector<int> threads;
+
+        for(int nt = 1; nt < max_threads; nt *= 2)
+        {
+            threads.push_back(nt);
+        }
+
+        threads.push_back(max_threads);
+
+        // Probed sizes 2^min_class, 2^(min_class + 2), ..., 2^max_class
+        const int min_class = 8;
+        const int max_class = 20;
+        const int max_size  = 1 << max_class;
+
+        std::vector<double> x(max_size, 1.0);
+        std::vector<double> y(max_size, 0.0);
+
+        // Five point stencil for the sparse matrix vector product
+        const int nx = 1024;
+
+        std::vector<int>    ptr(max_size + 1, 0);
+        std::vector<int>    col;
+        std::vector<double> val;
+
+        col.reserve(5 * max_size);
+        val.reserve(5 * max_size);
+
+        for(int i = 0; i < max_size; ++i)
+        {
+            const int offset[5] = {-nx, -1, 0, 1, nx};
+
+            for(int k = 0; k < 5; ++k)
+            {
+                int j = i + offset[k];
+
+                if(j >= 0 && j < max_size)
+                {
+                    col.push_back(j);
+                    val.push_back(k == 2 ? 4.0 : -1.0);
+                }
+            }
+
+            ptr[i + 1] = static_cast<int>(col.size());
+        }
+
+        const double* px   = x.data();
+        double*       py   = y.data();
+        const int*    pptr = ptr.data();
+        const int*    pcol = col.data();
+        const double* pval = val.data();
+
+        for(int op = 0; op < _rocalution_omp_num_ops; ++op)
+        {
+            // Sizes below the smallest probe run single threaded
+            for(int c = 0; c < min_class; ++c)
+            {
+                backend->OpenMP_op_threads[op][c] = 1;
+            }
+
+            int64_t threshold = (int64_t(1) << min_class) - 1;
+            bool    single    = true;
+
+            for(int c = min_class; c <= max_class; c += 2)
+            {
+                int n = 1 << c;
+
+                // Roughly the same amount of work for all sizes
+                int reps = std::max(1, max_size / n);
+
+                int    best_threads = 1;
+                double best_time    = std::numeric_limits<double>::max();
+
+                for(int nt : threads)
+                {
+                    double time;
+
+                    if(op == OMP_OP_VECTOR)
+                    {
+                        time = _rocalution_omp_time(nt, reps, [&]() {
+#pragma omp parallel for
+                            for(int i = 0; i < n; ++i)
+                            {
+                                py[i] += 1e-8 * px[i];
+                            }
+                        });
+                    }
+                    else
+                    {
+                        time = _rocalution_omp_time(nt, reps, [&]() {
+#pragma omp parallel for
+                            for(int i = 0; i < n; ++i)
+                            {
+                                double sum = 0.0;
+
+                                for(int j = pptr[i]; j < pptr[i + 1]; ++j)
+                                {
+                                    sum += pval[j] * px[pcol[j]];
+                                }
+
+                                py[i] = sum;
+                            }
+                        });
+                    }
+
+                    if(time < best_time)
+                    {
+                        best_time    = time;
+                        best_threads = nt;
+                    }
+                }
+
+                // The probe covers the size classes c and c + 1
+                backend->OpenMP_op_threads[op][c]     = best_threads;
+                backend->OpenMP_op_threads[op][c + 1] = best_threads;
+
+                // The threshold ends at the first size that benefits from threads
+                single = single && (best_threads == 1);
+
+                if(single == true)
+                {
+                    threshold = (int64_t(1) << (c + 2)) - 1;
+                }
+            }
+
+            // Larger sizes use all threads
+            for(int c = max_class + 2; c < _rocalution_omp_size_classes; ++c)
+            {
+                backend->OpenMP_op_threads[op][c] = 0;
+            }
+
+            backend->OpenMP_op_threshold[op] = threshold;
+        }
+
+        omp_set_num_threads(max_threads);
+
+        LOG_VERBOSE_INFO(2,
+                         "OpenMP thresholds calibrated in "
+                             << (rocalution_time() - tick) / 1e6 << " sec, vector "
+                             << backend->OpenMP_op_threshold[OMP_OP_VECTOR] << ", SpMV "
+                             << backend->OpenMP_op_threshold[OMP_OP_SPMV]);
+#endif
+    }
+
+    // Initialize the platform for the given rank and select the accelerator device, if
+    // device is not negative. With topology binding, the process is bound to the part slot
+    // of nslots of the cpus close to the device.
+    static int _rocalution_init(int rank, int device, int slot = 0, int nslots = 1)
     {
         // please note your MPI communicator
         if(rank >= 0)
@@ -140,7 +392,9 @@ namespace rocalution
 
         _rocalution_open_log_file();
 
-        log_debug(0, "init_rocalution()", "* begin", rank, dev_per_node);
+        log_debug(0, "init_rocalution()", "* begin", rank, device);
+
+        double tick = rocalution_time();
 
         if(_get_backend_descriptor()->init == true)
         {
@@ -156,7 +410,20 @@ namespace rocalution
 
 #ifdef _OPENMP
         _get_backend_descriptor()->OpenMP_def_threads = omp_get_max_threads();
-        _get_backend_descriptor()->OpenMP_threads     = omp_get_max_threads();
+#endif
+
+        // The binding has to precede the thread affinity, which pins the threads within the
+        // cpus of the process
+        if(_rocalution_topology_binding_enabled() == true
+           && _get_backend_descriptor()->disable_accelerator == false)
+        {
+            int dev = device >= 0 ? device : _get_backend_descriptor()->HIP_dev;
+
+            _rocalution_bind_topology(dev >= 0 ? dev : 0, slot, nslots);
+        }
+
+#ifdef _OPENMP
+        _get_backend_descriptor()->OpenMP_threads = omp_get_max_threads();
 #if _OPENMP >= 201811
         _get_backend_descriptor()->OpenMP_def_nested = omp_get_max_active_levels();
 #else
@@ -175,12 +442,32 @@ namespace rocalution
         _get_backend_descriptor()->OpenMP_threads = 1;
 #endif
 
+        // The OpenMP threshold calibration can be requested through the environment
+        const char* str_omp_calibration = getenv("ROCALUTION_OMP_CALIBRATION");
+
+        if(str_omp_calibration != NULL && atoi(str_omp_calibration) == 1)
+        {
+            _get_backend_descriptor()->OpenMP_calibrate = true;
+        }
+
+        if(_get_backend_descriptor()->OpenMP_calibrate == true)
+        {
+            _rocalution_calibrate_omp();
+        }
+        else
+        {
+            for(int op = 0; op < _rocalution_omp_num_ops; ++op)
+            {
+                _get_backend_descriptor()->OpenMP_op_threshold[op] = -1;
+            }
+        }
+
         if(_get_backend_descriptor()->disable_accelerator == false)
         {
 #ifdef SUPPORT_HIP
-            if(rank > -1 && dev_per_node > 0)
+            if(device >= 0)
             {
-                set_device_rocalution(rank % dev_per_node);
+                set_device_rocalution(device);
             }
 
             _get_backend_descriptor()->accelerator = rocalution_init_hip();
@@ -196,6 +483,76 @@ namespace rocalution
             LOG_INFO("Warning: the accelerator is disabled");
         }
 
+#ifdef SUPPORT_MULTINODE
+        // GPU-aware MPI can be requested through the environment
+        const char* str_gpu_aware_mpi = getenv("ROCALUTION_GPU_AWARE_MPI");
+
+        if(str_gpu_aware_mpi != NULL && atoi(str_gpu_aware_mpi) == 1)
+        {
+            _get_backend_descriptor()->GPU_aware_MPI = true;
+        }
+#endif
+
+        // The device memory pool can be disabled through the environment
+        const char* str_hip_mem_pool = getenv("ROCALUTION_HIP_MEMORY_POOL");
+
+        if(str_hip_mem_pool != NULL && atoi(str_hip_mem_pool) == 0)
+        {
+            _get_backend_descriptor()->HIP_mem_pool = false;
+        }
+
+        // Managed device memory can be requested through the environment
+        const char* str_hip_managed = getenv("ROCALUTION_HIP_MANAGED_MEMORY");
+
+        if(str_hip_managed != NULL && atoi(str_hip_managed) == 1)
+        {
+            _get_backend_descriptor()->HIP_managed_memory = true;
+        }
+
+        // The strict host fallback mode can be requested through the environment
+        const char* str_strict_fallback = getenv("ROCALUTION_STRICT_HOST_FALLBACK");
+
+        if(str_strict_fallback != NULL && atoi(str_strict_fallback) == 1)
+        {
+            _get_backend_descriptor()->strict_host_fallback = true;
+        }
+
+        // Reproducible reductions can be requested through the environment
+        const char* str_reproducible = getenv("ROCALUTION_REPRODUCIBLE_REDUCTIONS");
+
+        if(str_reproducible != NULL && atoi(str_reproducible) == 1)
+        {
+            _get_backend_descriptor()->reproducible_reductions = true;
+        }
+
+        // The persistent tuning cache can be set through the environment
+        const char* str_tuning_cache = getenv("ROCALUTION_TUNING_CACHE");
+
+        if(str_tuning_cache != NULL)
+        {
+            set_tuning_cache_rocalution(str_tuning_cache);
+        }
+
+        // The timeline trace can be requested through the environment
+        const char* str_trace = getenv("ROCALUTION_TRACE");
+
+        if(str_trace != NULL)
+        {
+            set_trace_rocalution(str_trace);
+        }
+
+        // The structured solve records contain the time breakdown
+        if(_get_backend_descriptor()->log_mode == 2)
+        {
+            set_time_breakdown_rocalution(true);
+        }
+
+        // GPU-aware MPI is only meaningful with an active accelerator
+        if(_get_backend_descriptor()->accelerator == false)
+        {
+            _get_backend_descriptor()->GPU_aware_MPI = false;
+        }
+
         if(_rocalution_check_if_any_obj() == false)
         {
             LOG_INFO("Error: rocALUTION objects have been created before calling the "
@@ -205,11 +562,107 @@ namespace rocalution
 
         _get_backend_descriptor()->init = true;
 
+        LOG_VERBOSE_INFO(2,
+                         "rocALUTION platform initialized in " << (rocalution_time() - tick) / 1e6
+                                                               << " sec");
+
         log_debug(0, "init_rocalution()", "* end");
 
         return 0;
     }
 
+    int init_rocalution(int rank, int dev_per_node)
+    {
+        _get_backend_descriptor()->MPI_comm    = NULL;
+        _get_backend_descriptor()->MPI_comm_id = -1;
+
+        return _rocalution_init(rank, (rank > -1 && dev_per_node > 0) ? rank % dev_per_node : -1);
+    }
+
+    int init_rocalution(const void* comm, int dev_per_node)
+    {
+        assert(comm != NULL);
+
+#ifdef SUPPORT_MULTINODE
+        MPI_Comm mpi_comm = *(const MPI_Comm*)comm;
+
+        int rank;
+        int world_rank;
+
+        CHECK_MPI_ERROR(MPI_Comm_rank(mpi_comm, &rank), __FILE__, __LINE__);
+        CHECK_MPI_ERROR(MPI_Comm_rank(MPI_COMM_WORLD, &world_rank), __FILE__, __LINE__);
+
+        // The communicator is identified by the MPI_COMM_WORLD rank of its first process
+        int comm_id = world_rank;
+        CHECK_MPI_ERROR(MPI_Bcast(&comm_id, 1, MPI_INT, 0, mpi_comm), __FILE__, __LINE__);
+
+        // Rank of the process among all processes of its node, which may belong to
+        // different communicators
+        MPI_Comm node_comm;
+        int      node_rank;
+
+        CHECK_MPI_ERROR(
+            MPI_Comm_split_type(
+                MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, world_rank, MPI_INFO_NULL, &node_comm),
+            __FILE__,
+            __LINE__);
+        CHECK_MPI_ERROR(MPI_Comm_rank(node_comm, &node_rank), __FILE__, __LINE__);
+
+#ifdef SUPPORT_HIP
+        if(dev_per_node <= 0)
+        {
+            dev_per_node = rocalution_hip_num_devices();
+        }
+#endif
+
+        int device = dev_per_node > 0 ? node_rank % dev_per_node : -1;
+
+        // The processes of the node, whose devices are attached to the same NUMA node,
+        // share its cpus
+        int slot   = 0;
+        int nslots = 1;
+
+#ifdef SUPPORT_HIP
+        if(_rocalution_topology_binding_enabled() == true && device >= 0)
+        {
+            int node_size;
+            CHECK_MPI_ERROR(MPI_Comm_size(node_comm, &node_size), __FILE__, __LINE__);
+
+            int              numa = rocalution_hip_device_numa_node(device);
+            std::vector<int> numa_nodes(node_size);
+
+            CHECK_MPI_ERROR(
+                MPI_Allgather(&numa, 1, MPI_INT, numa_nodes.data(), 1, MPI_INT, node_comm),
+                __FILE__,
+                __LINE__);
+
+            nslots = 0;
+            for(int r = 0; r < node_size; ++r)
+            {
+                if(numa_nodes[r] == numa)
+                {
+                    slot += (r < node_rank) ? 1 : 0;
+                    ++nslots;
+                }
+            }
+        }
+#endif
+
+        CHECK_MPI_ERROR(MPI_Comm_free(&node_comm), __FILE__, __LINE__);
+
+        _get_backend_descriptor()->MPI_comm    = comm;
+        _get_backend_descriptor()->MPI_comm_id = comm_id;
+
+        return _rocalution_init(rank, device, slot, nslots);
+#else
+        // Without MPI support, the process is the only member of its communicator
+        _get_backend_descriptor()->MPI_comm    = NULL;
+        _get_backend_descriptor()->MPI_comm_id = -1;
+
+        return _rocalution_init(0, -1);
+#endif
+    }
+
     int stop_rocalution(void)
     {
         log_debug(0, "stop_rocalution()", "* begin");
@@ -221,6 +674,9 @@ namespace rocalution
 
         _rocalution_delete_all_obj();
 
+        // The accelerator events of the trace are resolved before the accelerator is stopped
+        _rocalution_trace_write();
+
 #ifdef SUPPORT_HIP
         if(_get_backend_descriptor()->disable_accelerator == false)
         {
@@ -247,170 +703,1149 @@ namespace rocalution
 
         _rocalution_close_log_file();
 
-        return 0;
+        return 0;
+    }
+
+    void set_omp_threads_rocalution(int nthreads)
+    {
+        log_debug(0, "set_omp_threads_rocalution()", nthreads);
+
+        assert(_get_backend_descriptor()->init == true);
+
+#ifdef _OPENMP
+        _get_backend_descriptor()->OpenMP_threads = nthreads;
+
+        omp_set_num_threads(nthreads);
+
+#if defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__)
+
+        rocalution_set_omp_affinity(_get_backend_descriptor()->OpenMP_affinity);
+
+#endif // linux
+
+#else // !omp
+        LOG_INFO("No OpenMP support");
+        _get_backend_descriptor()->OpenMP_threads = 1;
+#endif // omp
+    }
+
+    void set_device_rocalution(int dev)
+    {
+        log_debug(0, "set_device_rocalution()", dev);
+
+        assert(_get_backend_descriptor()->init == false);
+
+        _get_backend_descriptor()->HIP_dev = dev;
+    }
+
+    void set_topology_binding_rocalution(bool onoff)
+    {
+        log_debug(0, "set_topology_binding_rocalution()", onoff);
+
+        assert(_get_backend_descriptor()->init == false);
+
+        _rocalution_topology_binding = onoff;
+    }
+
+    void info_rocalution(void)
+    {
+        LOG_INFO("rocALUTION ver " << __ROCALUTION_VER_MAJOR << "." << __ROCALUTION_VER_MINOR << "."
+                                   << __ROCALUTION_VER_PATCH << __ROCALUTION_VER_PRE << "-"
+                                   << TO_STR(__ROCALUTION_VER_TWEAK));
+
+#if defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__)
+
+        LOG_VERBOSE_INFO(3, "Compiled for Linux/Unix OS");
+
+#else // Linux
+
+#if defined(__APPLE__)
+
+        LOG_VERBOSE_INFO(3, "Compiled for Mac OS");
+
+#else // Apple
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32) \
+    || defined(__WIN64) && !defined(__CYGWIN__)
+
+        LOG_VERBOSE_INFO(3, "Compiled for Windows OS");
+
+#else // Win
+
+        // unknown
+        LOG_VERBOSE_INFO(3, "Compiled for unknown OS");
+
+#endif // Win
+
+#endif // Apple
+
+#endif // Linux
+
+        info_rocalution(_Backend_Descriptor);
+    }
+
+    void info_rocalution(const struct Rocalution_Backend_Descriptor& backend_descriptor)
+    {
+        if(backend_descriptor.init == true)
+        {
+            LOG_INFO("rocALUTION platform is initialized");
+        }
+        else
+        {
+            LOG_INFO("rocALUTION platform is NOT initialized");
+        }
+
+        LOG_INFO("Accelerator backend: " << _rocalution_backend_name[backend_descriptor.backend]);
+
+#ifdef _OPENMP
+        LOG_INFO("OpenMP threads: " << backend_descriptor.OpenMP_threads);
+
+        if(backend_descriptor.OpenMP_op_threshold[OMP_OP_VECTOR] >= 0)
+        {
+            LOG_INFO("OpenMP calibrated thresholds: vector "
+                     << backend_descriptor.OpenMP_op_threshold[OMP_OP_VECTOR] << ", SpMV "
+                     << backend_descriptor.OpenMP_op_threshold[OMP_OP_SPMV]);
+        }
+#else
+        LOG_INFO("No OpenMP support");
+#endif
+
+        if(backend_descriptor.disable_accelerator == true)
+        {
+            LOG_INFO("The accelerator is disabled");
+        }
+
+#ifdef SUPPORT_HIP
+        if(backend_descriptor.accelerator)
+        {
+            rocalution_info_hip(backend_descriptor);
+        }
+        else
+        {
+            LOG_INFO("HIP is not initialized");
+        }
+#else
+        LOG_VERBOSE_INFO(3, "No HIP support");
+#endif
+
+#ifdef SUPPORT_MULTINODE
+        LOG_INFO("MPI rank: " << backend_descriptor.rank);
+
+        if(backend_descriptor.MPI_comm_id >= 0)
+        {
+            LOG_INFO("MPI communicator: " << backend_descriptor.MPI_comm_id);
+        }
+
+        if(backend_descriptor.GPU_aware_MPI == true)
+        {
+            LOG_INFO("GPU-aware MPI is enabled");
+        }
+
+        MPI_Comm comm = (backend_descriptor.MPI_comm != NULL)
+                            ? *(const MPI_Comm*)backend_descriptor.MPI_comm
+                            : MPI_COMM_WORLD;
+        int      num_procs;
+
+        int status_init;
+        MPI_Initialized(&status_init);
+
+        if(status_init == 1)
+        {
+            int status = MPI_Comm_size(comm, &num_procs);
+
+            if(status == MPI_SUCCESS)
+            {
+                LOG_INFO("MPI size: " << num_procs);
+            }
+            else
+            {
+                LOG_INFO("MPI is not initialized");
+            }
+        }
+        else
+        {
+            LOG_INFO("MPI is not initialized");
+        }
+#else
+        LOG_INFO("MPI is not initialized");
+#endif
+    }
+
+    void set_omp_affinity_rocalution(bool affinity)
+    {
+        assert(_get_backend_descriptor()->init == false);
+
+        _get_backend_descriptor()->OpenMP_affinity = affinity;
+    }
+
+    void set_omp_threshold_rocalution(int threshold)
+    {
+        assert(_get_backend_descriptor()->init == true);
+
+        _get_backend_descriptor()->OpenMP_threshold = threshold;
+
+        // An explicit threshold replaces the calibrated ones
+        for(int op = 0; op < _rocalution_omp_num_ops; ++op)
+        {
+            _get_backend_descriptor()->OpenMP_op_threshold[op] = -1;
+        }
+    }
+
+    void set_omp_calibration_rocalution(bool onoff)
+    {
+        log_debug(0, "set_omp_calibration_rocalution()", onoff);
+
+        assert(_get_backend_descriptor()->init == false);
+
+        _get_backend_descriptor()->OpenMP_calibrate = onoff;
+    }
+
+    bool _rocalution_available_accelerator(void)
+    {
+        return _get_backend_descriptor()->accelerator;
+    }
+
+    int64_t _rocalution_accelerator_free_memory(void)
+    {
+        if(_rocalution_available_accelerator() == false)
+        {
+            return -1;
+        }
+
+#ifdef SUPPORT_HIP
+        return rocalution_hip_free_memory();
+#else
+        return -1;
+#endif
+    }
+
+    void disable_accelerator_rocalution(bool onoff)
+    {
+        assert(_get_backend_descriptor()->init == false);
+
+        _get_backend_descriptor()->disable_accelerator = onoff;
+    }
+
+    void set_gpu_aware_mpi_rocalution(bool onoff)
+    {
+        log_debug(0, "set_gpu_aware_mpi_rocalution()", onoff);
+
+        assert(_get_backend_descriptor()->init == false);
+
+        _get_backend_descriptor()->GPU_aware_MPI = onoff;
+    }
+
+    void set_hip_memory_pool_rocalution(bool onoff)
+    {
+        log_debug(0, "set_hip_memory_pool_rocalution()", onoff);
+
+        assert(_get_backend_descriptor()->init == false);
+
+        _get_backend_descriptor()->HIP_mem_pool = onoff;
+    }
+
+    void set_hip_managed_memory_rocalution(bool onoff)
+    {
+        log_debug(0, "set_hip_managed_memory_rocalution()", onoff);
+
+        assert(_get_backend_descriptor()->init == false);
+
+        _get_backend_descriptor()->HIP_managed_memory = onoff;
+    }
+
+    void set_strict_host_fallback_rocalution(bool onoff)
+    {
+        log_debug(0, "set_strict_host_fallback_rocalution()", onoff);
+
+        _get_backend_descriptor()->strict_host_fallback = onoff;
+    }
+
+    void set_reproducible_reductions_rocalution(bool onoff)
+    {
+        log_debug(0, "set_reproducible_reductions_rocalution()", onoff);
+
+        _get_backend_descriptor()->reproducible_reductions = onoff;
+    }
+
+    // Statistics of the host fallbacks of a single function
+    struct Rocalution_Host_Fallback_Stats
+    {
+        int64_t count;
+        int64_t bytes;
+        double  time;
+    };
+
+    // Host fallback statistics, keyed by the function name
+    static std::map<std::string, Rocalution_Host_Fallback_Stats> _rocalution_host_fallback_stats;
+    static std::mutex _rocalution_host_fallback_mutex;
+
+    double _rocalution_host_fallback_begin(const std::string& function, bool is_accel)
+    {
+        if(is_accel == true && _get_backend_descriptor()->strict_host_fallback == true)
+        {
+            LOG_INFO("Error: " << function << " is not available on the accelerator and "
+                                              "strict host fallback mode is enabled");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        ROCALUTION_RANGE_PUSH("Host fallback " + function);
+
+        return rocalution_time();
+    }
+
+    void _rocalution_host_fallback_end(const std::string& function, double start, int64_t bytes)
+    {
+        double time = (rocalution_time() - start) / 1e6;
+
+        {
+            std::lock_guard<std::mutex> lock(_rocalution_host_fallback_mutex);
+
+            Rocalution_Host_Fallback_Stats& stats = _rocalution_host_fallback_stats[function];
+
+            // Data is moved to the host and back again
+            stats.count += 1;
+            stats.bytes += 2 * bytes;
+            stats.time += time;
+        }
+
+        LOG_VERBOSE_INFO(2, "*** warning: " << function << " is performed on the host");
+
+        ROCALUTION_RANGE_POP();
+    }
+
+    // Tuning decisions, keyed by the matrix signature
+    static std::map<std::string, Rocalution_Tuning_Decision> _rocalution_tuning_cache;
+
+    // File of the persistent tuning cache, empty if disabled
+    static std::string _rocalution_tuning_cache_file;
+
+    static std::mutex _rocalution_tuning_cache_mutex;
+
+    void set_tuning_cache_rocalution(const std::string& filename)
+    {
+        log_debug(0, "set_tuning_cache_rocalution()", filename);
+
+        std::lock_guard<std::mutex> lock(_rocalution_tuning_cache_mutex);
+
+        _rocalution_tuning_cache_file = filename;
+
+        if(filename.empty() == true)
+        {
+            return;
+        }
+
+        // A missing file is created with the first decision
+        std::ifstream file(filename);
+
+        if(file.is_open() == false)
+        {
+            return;
+        }
+
+        // Each line holds 'signature;format blockdim block_size', later lines win
+        std::string line;
+        while(std::getline(file, line))
+        {
+            size_t pos = line.rfind(';');
+
+            if(pos == std::string::npos)
+            {
+                continue;
+            }
+
+            Rocalution_Tuning_Decision decision;
+            std::istringstream         values(line.substr(pos + 1));
+
+            if((values >> decision.format >> decision.blockdim >> decision.block_size)
+               && decision.format <= SELL && decision.blockdim > 0 && decision.block_size > 0)
+            {
+                _rocalution_tuning_cache[line.substr(0, pos)] = decision;
+            }
+            else
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: invalid entry in tuning cache " << filename
+                                                                               << " ignored");
+            }
+        }
+    }
+
+    bool _rocalution_tuning_cache_find(const std::string&          signature,
+                                       Rocalution_Tuning_Decision* decision)
+    {
+        assert(decision != NULL);
+
+        std::lock_guard<std::mutex> lock(_rocalution_tuning_cache_mutex);
+
+        auto it = _rocalution_tuning_cache.find(signature);
+
+        if(it == _rocalution_tuning_cache.end())
+        {
+            return false;
+        }
+
+        *decision = it->second;
+
+        return true;
+    }
+
+    void _rocalution_tuning_cache_insert(const std::string&                signature,
+                                         const Rocalution_Tuning_Decision& decision)
+    {
+        std::lock_guard<std::mutex> lock(_rocalution_tuning_cache_mutex);
+
+        _rocalution_tuning_cache[signature] = decision;
+
+        if(_rocalution_tuning_cache_file.empty() == true)
+        {
+            return;
+        }
+
+        std::ofstream file(_rocalution_tuning_cache_file, std::ios::app);
+
+        if(file.is_open() == false)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: cannot write tuning cache "
+                                 << _rocalution_tuning_cache_file);
+            return;
+        }
+
+        // Write the entry at once, such that concurrent jobs append whole lines
+        std::ostringstream line;
+        line << signature << ";" << decision.format << " " << decision.blockdim << " "
+             << decision.block_size << std::endl;
+
+        file << line.str();
+    }
+
+    bool get_host_fallback_rocalution(const std::string& function,
+                                      int64_t*           count,
+                                      int64_t*           bytes,
+                                      double*            time)
+    {
+        assert(count != NULL);
+        assert(bytes != NULL);
+        assert(time != NULL);
+
+        *count = 0;
+        *bytes = 0;
+        *time  = 0.0;
+
+        std::lock_guard<std::mutex> lock(_rocalution_host_fallback_mutex);
+
+        if(function.empty() == true)
+        {
+            for(std::map<std::string, Rocalution_Host_Fallback_Stats>::const_iterator it
+                = _rocalution_host_fallback_stats.begin();
+                it != _rocalution_host_fallback_stats.end();
+                ++it)
+            {
+                *count += it->second.count;
+                *bytes += it->second.bytes;
+                *time += it->second.time;
+            }
+
+            return true;
+        }
+
+        std::map<std::string, Rocalution_Host_Fallback_Stats>::const_iterator it
+            = _rocalution_host_fallback_stats.find(function);
+
+        if(it == _rocalution_host_fallback_stats.end())
+        {
+            return false;
+        }
+
+        *count = it->second.count;
+        *bytes = it->second.bytes;
+        *time  = it->second.time;
+
+        return true;
+    }
+
+    void info_host_fallback_rocalution(void)
+    {
+        LOG_INFO("Host fallbacks:");
+
+        std::lock_guard<std::mutex> lock(_rocalution_host_fallback_mutex);
+
+        if(_rocalution_host_fallback_stats.empty() == true)
+        {
+            LOG_INFO("none");
+            return;
+        }
+
+        for(std::map<std::string, Rocalution_Host_Fallback_Stats>::const_iterator it
+            = _rocalution_host_fallback_stats.begin();
+            it != _rocalution_host_fallback_stats.end();
+            ++it)
+        {
+            LOG_INFO(it->first << " count=" << it->second.count << " bytes=" << it->second.bytes
+                               << " time=" << it->second.time << " sec");
+        }
+    }
+
+    void reset_host_fallback_rocalution(void)
+    {
+        std::lock_guard<std::mutex> lock(_rocalution_host_fallback_mutex);
+
+        _rocalution_host_fallback_stats.clear();
+    }
+
+    // Current and peak number of allocated bytes
+    struct Rocalution_Memory_Usage
+    {
+        int64_t current;
+        int64_t peak;
+    };
+
+    // A recorded buffer, with its location and the tags it has been allocated under
+    struct Rocalution_Memory_Buffer
+    {
+        int64_t                                bytes;
+        int                                    location;
+        std::vector<Rocalution_Memory_Usage*> tags;
+    };
+
+    // Memory usage statistics of all locations and tags
+    struct Rocalution_Memory_Stats
+    {
+        std::mutex mutex;
+
+        Rocalution_Memory_Usage location[3];
+
+        // Tag statistics, keyed by the tag name. Elements of a map are never moved.
+        std::map<std::string, Rocalution_Memory_Usage> tag;
+
+        std::unordered_map<const void*, Rocalution_Memory_Buffer> buffer;
+    };
+
+    // The statistics are never destroyed, objects can be released after the static
+    // objects of the library have been destroyed
+    static Rocalution_Memory_Stats& _rocalution_memory_stats(void)
+    {
+        static Rocalution_Memory_Stats* stats = new Rocalution_Memory_Stats();
+
+        return *stats;
+    }
+
+    // Active tags of the calling thread
+    static thread_local std::vector<Rocalution_Memory_Usage*> _rocalution_memory_tags;
+
+    static void _rocalution_memory_add(Rocalution_Memory_Usage& usage, int64_t bytes)
+    {
+        usage.current += bytes;
+        usage.peak = std::max(usage.peak, usage.current);
+    }
+
+    void _rocalution_memory_allocate(const void* ptr, int64_t bytes, int location)
+    {
+        assert(location >= HostMemory && location <= AcceleratorMemory);
+
+        if(ptr == NULL || bytes <= 0)
+        {
+            return;
+        }
+
+        Rocalution_Memory_Stats&    stats = _rocalution_memory_stats();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+
+        Rocalution_Memory_Buffer& buffer = stats.buffer[ptr];
+
+        buffer.bytes    = bytes;
+        buffer.location = location;
+        buffer.tags     = _rocalution_memory_tags;
+
+        _rocalution_memory_add(stats.location[location], bytes);
+
+        for(size_t i = 0; i < buffer.tags.size(); ++i)
+        {
+            _rocalution_memory_add(*buffer.tags[i], bytes);
+        }
+    }
+
+    void _rocalution_memory_free(const void* ptr)
+    {
+        if(ptr == NULL)
+        {
+            return;
+        }
+
+        Rocalution_Memory_Stats&    stats = _rocalution_memory_stats();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+
+        std::unordered_map<const void*, Rocalution_Memory_Buffer>::iterator it
+            = stats.buffer.find(ptr);
+
+        if(it == stats.buffer.end())
+        {
+            return;
+        }
+
+        const Rocalution_Memory_Buffer& buffer = it->second;
+
+        stats.location[buffer.location].current -= buffer.bytes;
+
+        for(size_t i = 0; i < buffer.tags.size(); ++i)
+        {
+            buffer.tags[i]->current -= buffer.bytes;
+        }
+
+        stats.buffer.erase(it);
+    }
+
+    RocalutionMemoryTag::RocalutionMemoryTag(const std::string& name)
+        : active_(false)
+    {
+        if(name.empty() == true)
+        {
+            return;
+        }
+
+        Rocalution_Memory_Stats&    stats = _rocalution_memory_stats();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+
+        Rocalution_Memory_Usage* usage = &stats.tag[name];
+
+        // Nested scopes of the same tag count the allocations only once
+        if(std::find(_rocalution_memory_tags.begin(), _rocalution_memory_tags.end(), usage)
+           == _rocalution_memory_tags.end())
+        {
+            _rocalution_memory_tags.push_back(usage);
+            this->active_ = true;
+        }
+    }
+
+    RocalutionMemoryTag::~RocalutionMemoryTag()
+    {
+        if(this->active_ == true)
+        {
+            _rocalution_memory_tags.pop_back();
+        }
+    }
+
+    void get_memory_usage_rocalution(int location, int64_t* current, int64_t* peak)
+    {
+        assert(location >= HostMemory && location <= AcceleratorMemory);
+        assert(current != NULL);
+        assert(peak != NULL);
+
+        Rocalution_Memory_Stats&    stats = _rocalution_memory_stats();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+
+        *current = stats.location[location].current;
+        *peak    = stats.location[location].peak;
+    }
+
+    bool get_memory_usage_tag_rocalution(const std::string& tag, int64_t* current, int64_t* peak)
+    {
+        assert(current != NULL);
+        assert(peak != NULL);
+
+        Rocalution_Memory_Stats&    stats = _rocalution_memory_stats();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+
+        std::map<std::string, Rocalution_Memory_Usage>::const_iterator it = stats.tag.find(tag);
+
+        if(it == stats.tag.end())
+        {
+            *current = 0;
+            *peak    = 0;
+
+            return false;
+        }
+
+        *current = it->second.current;
+        *peak    = it->second.peak;
+
+        return true;
+    }
+
+    void info_memory_usage_rocalution(void)
+    {
+        Rocalution_Memory_Stats&    stats = _rocalution_memory_stats();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+
+        const char* location_name[3] = {"Host", "Pinned host", "Accelerator"};
+
+        LOG_INFO("Memory usage:");
+
+        for(int i = HostMemory; i <= AcceleratorMemory; ++i)
+        {
+            LOG_INFO(location_name[i] << " memory current=" << stats.location[i].current
+                                      << " bytes peak=" << stats.location[i].peak << " bytes");
+        }
+
+        for(std::map<std::string, Rocalution_Memory_Usage>::const_iterator it = stats.tag.begin();
+            it != stats.tag.end();
+            ++it)
+        {
+            LOG_INFO(it->first << " current=" << it->second.current
+                               << " bytes peak=" << it->second.peak << " bytes");
+        }
+    }
+
+    void reset_memory_peak_rocalution(void)
+    {
+        Rocalution_Memory_Stats&    stats = _rocalution_memory_stats();
+        std::lock_guard<std::mutex> lock(stats.mutex);
+
+        for(int i = HostMemory; i <= AcceleratorMemory; ++i)
+        {
+            stats.location[i].peak = stats.location[i].current;
+        }
+
+        for(std::map<std::string, Rocalution_Memory_Usage>::iterator it = stats.tag.begin();
+            it != stats.tag.end();
+            ++it)
+        {
+            it->second.peak = it->second.current;
+        }
+    }
+
+    // Solver time breakdown, accumulated time per category (in usec) of all host threads
+    static bool       _rocalution_time_breakdown = false;
+    static double     _rocalution_time_category[4] = {0.0, 0.0, 0.0, 0.0};
+    static std::mutex _rocalution_time_mutex;
+
+    // Currently open categories of the host thread and the time the innermost one has been
+    // (re-)started
+    static thread_local std::vector<int> _rocalution_time_scopes;
+    static thread_local double           _rocalution_time_scope_start = 0.0;
+
+    static void _rocalution_time_add(int category, double time)
+    {
+        std::lock_guard<std::mutex> lock(_rocalution_time_mutex);
+
+        _rocalution_time_category[category] += time;
+    }
+
+    void set_time_breakdown_rocalution(bool onoff)
+    {
+        log_debug(0, "set_time_breakdown_rocalution()", onoff);
+
+        _rocalution_time_breakdown = onoff;
+    }
+
+    double get_time_breakdown_rocalution(int category)
+    {
+        assert(category >= TimeSpMV && category <= TimeAllreduce);
+
+        std::lock_guard<std::mutex> lock(_rocalution_time_mutex);
+
+        return _rocalution_time_category[category] / 1e6;
+    }
+
+    void reset_time_breakdown_rocalution(void)
+    {
+        std::lock_guard<std::mutex> lock(_rocalution_time_mutex);
+
+        for(int i = TimeSpMV; i <= TimeAllreduce; ++i)
+        {
+            _rocalution_time_category[i] = 0.0;
+        }
+    }
+
+    RocalutionTimeScope::RocalutionTimeScope(int category)
+        : active_(false)
+    {
+        assert(category >= TimeSpMV && category <= TimeAllreduce);
+
+        if(_rocalution_time_breakdown == false)
+        {
+            return;
+        }
+
+        double now = rocalution_time();
+
+        // Pause the enclosing category
+        if(_rocalution_time_scopes.empty() == false)
+        {
+            _rocalution_time_add(_rocalution_time_scopes.back(),
+                                 now - _rocalution_time_scope_start);
+        }
+
+        _rocalution_time_scopes.push_back(category);
+        _rocalution_time_scope_start = now;
+
+        this->active_ = true;
+    }
+
+    RocalutionTimeScope::~RocalutionTimeScope()
+    {
+        if(this->active_ == false)
+        {
+            return;
+        }
+
+        double now = rocalution_time();
+
+        // Record this category and resume the enclosing one
+        _rocalution_time_add(_rocalution_time_scopes.back(), now - _rocalution_time_scope_start);
+
+        _rocalution_time_scopes.pop_back();
+        _rocalution_time_scope_start = now;
+    }
+
+    // Serializes the compute mode switches of different host threads
+    static std::mutex _rocalution_compute_mutex;
+
+    RocalutionComputeScope::RocalutionComputeScope()
+    {
+        _rocalution_compute_mutex.lock();
+    }
+
+    RocalutionComputeScope::~RocalutionComputeScope()
+    {
+        _rocalution_compute_mutex.unlock();
+    }
+
+    // Bytes copied between host and accelerator
+    static std::atomic<int64_t> _rocalution_transfer_h2d(0);
+    static std::atomic<int64_t> _rocalution_transfer_d2h(0);
+
+    void _rocalution_transfer_record(int64_t bytes, bool to_accelerator)
+    {
+        if(to_accelerator == true)
+        {
+            _rocalution_transfer_h2d += bytes;
+        }
+        else
+        {
+            _rocalution_transfer_d2h += bytes;
+        }
+    }
+
+    void get_transfer_bytes_rocalution(int64_t* h2d, int64_t* d2h)
+    {
+        assert(h2d != NULL);
+        assert(d2h != NULL);
+
+        *h2d = _rocalution_transfer_h2d;
+        *d2h = _rocalution_transfer_d2h;
+    }
+
+    void reset_transfer_bytes_rocalution(void)
+    {
+        _rocalution_transfer_h2d = 0;
+        _rocalution_transfer_d2h = 0;
+    }
+
+    // Execution context that is current on the host thread, see
+    // ExecutionContext::MakeCurrent()
+    static thread_local const ExecutionContext* _rocalution_current_context = NULL;
+
+    ExecutionContext::ExecutionContext(void* stream, int device)
+        : own_stream_(false)
+        , device_(-1)
+        , stream_(NULL)
+        , blas_handle_(NULL)
+        , sparse_handle_(NULL)
+    {
+        log_debug(this, "ExecutionContext::ExecutionContext()", stream, device);
+
+        if(_rocalution_available_accelerator() == false)
+        {
+            return;
+        }
+
+#ifdef SUPPORT_HIP
+        if(device < 0)
+        {
+            device = _get_backend_descriptor()->HIP_dev;
+        }
+
+        if(device >= rocalution_hip_num_devices())
+        {
+            LOG_INFO("ExecutionContext: device " << device << " is not available");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        this->device_ = device;
+
+        if(rocalution_hip_create_context(
+               device, stream, &this->stream_, &this->blas_handle_, &this->sparse_handle_)
+           == false)
+        {
+            LOG_INFO("Cannot create the stream of the execution context");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        this->own_stream_ = (stream == NULL);
+#endif
+    }
+
+    ExecutionContext::~ExecutionContext()
+    {
+        log_debug(this, "ExecutionContext::~ExecutionContext()");
+
+        if(_rocalution_current_context == this)
+        {
+            _rocalution_current_context = NULL;
+        }
+
+#ifdef SUPPORT_HIP
+        if(this->stream_ != NULL)
+        {
+            rocalution_hip_destroy_context(this->device_,
+                                           this->own_stream_,
+                                           this->stream_,
+                                           this->blas_handle_,
+                                           this->sparse_handle_);
+        }
+#endif
+    }
+
+    void ExecutionContext::Sync(void) const
+    {
+#ifdef SUPPORT_HIP
+        if(this->stream_ != NULL)
+        {
+            rocalution_hip_sync_context(this->stream_);
+        }
+#endif
     }
 
-    void set_omp_threads_rocalution(int nthreads)
+    void* ExecutionContext::GetStream(void) const
     {
-        log_debug(0, "set_omp_threads_rocalution()", nthreads);
+        if(this->stream_ == NULL)
+        {
+            return NULL;
+        }
 
-        assert(_get_backend_descriptor()->init == true);
+        // The stream is a pointer type
+        return *static_cast<void**>(this->stream_);
+    }
 
-#ifdef _OPENMP
-        _get_backend_descriptor()->OpenMP_threads = nthreads;
+    int ExecutionContext::GetDevice(void) const
+    {
+        return this->device_;
+    }
 
-        omp_set_num_threads(nthreads);
+    void ExecutionContext::Activate(void) const
+    {
+#ifdef SUPPORT_HIP
+        if(this->stream_ != NULL)
+        {
+            rocalution_hip_set_device(this->device_);
+        }
+#endif
+    }
 
-#if defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__)
+    void ExecutionContext::MakeCurrent(void) const
+    {
+        log_debug(this, "ExecutionContext::MakeCurrent()");
 
-        rocalution_set_omp_affinity(_get_backend_descriptor()->OpenMP_affinity);
+        this->Activate();
 
-#endif // linux
+        // The number of OpenMP threads is a property of the host thread
+        _set_omp_backend_threads(*_get_backend_descriptor(), -1);
 
-#else // !omp
-        LOG_INFO("No OpenMP support");
-        _get_backend_descriptor()->OpenMP_threads = 1;
-#endif // omp
+        _rocalution_current_context = this;
     }
 
-    void set_device_rocalution(int dev)
+    void ExecutionContext::ReleaseCurrent(void)
     {
-        log_debug(0, "set_device_rocalution()", dev);
-
-        assert(_get_backend_descriptor()->init == false);
+        log_debug(0, "ExecutionContext::ReleaseCurrent()");
 
-        _get_backend_descriptor()->HIP_dev = dev;
+        _rocalution_current_context = NULL;
     }
 
-    void info_rocalution(void)
+    void ExecutionContext::Attach(Rocalution_Backend_Descriptor* backend) const
     {
-        LOG_INFO("rocALUTION ver " << __ROCALUTION_VER_MAJOR << "." << __ROCALUTION_VER_MINOR << "."
-                                   << __ROCALUTION_VER_PATCH << __ROCALUTION_VER_PRE << "-"
-                                   << TO_STR(__ROCALUTION_VER_TWEAK));
-
-#if defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__)
-
-        LOG_VERBOSE_INFO(3, "Compiled for Linux/Unix OS");
-
-#else // Linux
-
-#if defined(__APPLE__)
+        assert(backend != NULL);
 
-        LOG_VERBOSE_INFO(3, "Compiled for Mac OS");
+        if(this->stream_ == NULL)
+        {
+            return;
+        }
 
-#else // Apple
+        backend->HIP_dev            = this->device_;
+        backend->HIP_stream_current = this->stream_;
+        backend->ROC_blas_handle    = this->blas_handle_;
+        backend->ROC_sparse_handle  = this->sparse_handle_;
+    }
 
-#if defined(WIN32) || defined(_WIN32) || defined(__WIN32) \
-    || defined(__WIN64) && !defined(__CYGWIN__)
+    // Nesting depth of the structured log records of the host thread
+    static thread_local int _rocalution_log_record_depth = 0;
 
-        LOG_VERBOSE_INFO(3, "Compiled for Windows OS");
+    // Serializes the records of different host threads in the log file
+    static std::mutex _rocalution_log_record_mutex;
 
-#else // Win
+    RocalutionLogRecord::RocalutionLogRecord(const std::string& event)
+        : active_(false)
+        , counted_(false)
+        , event_(event)
+    {
+        if(_get_backend_descriptor()->log_mode != 2)
+        {
+            return;
+        }
 
-        // unknown
-        LOG_VERBOSE_INFO(3, "Compiled for unknown OS");
+        this->counted_ = true;
 
-#endif // Win
+        if(_rocalution_log_record_depth++ > 0)
+        {
+            return;
+        }
 
-#endif // Apple
+        this->start_ = rocalution_time();
+        this->h2d_   = _rocalution_transfer_h2d;
+        this->d2h_   = _rocalution_transfer_d2h;
 
-#endif // Linux
+        for(int i = TimeSpMV; i <= TimeAllreduce; ++i)
+        {
+            this->breakdown_[i] = get_time_breakdown_rocalution(i);
+        }
 
-        info_rocalution(_Backend_Descriptor);
+        this->active_ = true;
     }
 
-    void info_rocalution(const struct Rocalution_Backend_Descriptor& backend_descriptor)
+    RocalutionLogRecord::~RocalutionLogRecord()
     {
-        if(backend_descriptor.init == true)
+        if(this->counted_ == true)
         {
-            LOG_INFO("rocALUTION platform is initialized");
+            --_rocalution_log_record_depth;
         }
-        else
+
+        if(this->active_ == false || _get_backend_descriptor()->log_file == NULL)
         {
-            LOG_INFO("rocALUTION platform is NOT initialized");
+            return;
         }
 
-        LOG_INFO("Accelerator backend: " << _rocalution_backend_name[backend_descriptor.backend]);
-
-#ifdef _OPENMP
-        LOG_INFO("OpenMP threads: " << backend_descriptor.OpenMP_threads);
-#else
-        LOG_INFO("No OpenMP support");
-#endif
+        double now = rocalution_time();
 
-        if(backend_descriptor.disable_accelerator == true)
+        std::ostringstream record;
+        record << "{\"rank\": " << _get_backend_descriptor()->rank;
+        if(_get_backend_descriptor()->MPI_comm_id >= 0)
         {
-            LOG_INFO("The accelerator is disabled");
+            record << ", \"comm\": " << _get_backend_descriptor()->MPI_comm_id;
         }
+        record << ", \"event\": \"" << this->event_ << "\"";
+        record << ", \"time\": " << (now - this->start_) / 1e6;
+        record << ", \"time_spmv\": "
+               << get_time_breakdown_rocalution(TimeSpMV) - this->breakdown_[TimeSpMV];
+        record << ", \"time_preconditioner\": "
+               << get_time_breakdown_rocalution(TimePreconditioner)
+                      - this->breakdown_[TimePreconditioner];
+        record << ", \"time_communication\": "
+               << get_time_breakdown_rocalution(TimeCommunication)
+                      - this->breakdown_[TimeCommunication];
+        record << ", \"time_allreduce\": "
+               << get_time_breakdown_rocalution(TimeAllreduce) - this->breakdown_[TimeAllreduce];
+        record << ", \"bytes_h2d\": " << _rocalution_transfer_h2d - this->h2d_;
+        record << ", \"bytes_d2h\": " << _rocalution_transfer_d2h - this->d2h_;
+        record << this->fields_ << "}";
+
+        std::lock_guard<std::mutex> lock(_rocalution_log_record_mutex);
+
+        *_get_backend_descriptor()->log_file << record.str() << std::endl;
+    }
 
-#ifdef SUPPORT_HIP
-        if(backend_descriptor.accelerator)
-        {
-            rocalution_info_hip(backend_descriptor);
-        }
-        else
+    bool RocalutionLogRecord::IsActive(void) const
+    {
+        return this->active_;
+    }
+
+    void RocalutionLogRecord::Add(const std::string& key, const std::string& value)
+    {
+        this->fields_ += ", \"" + key + "\": " + value;
+    }
+
+    void RocalutionLogRecord::Add(const std::string& key, int64_t value)
+    {
+        this->Add(key, std::to_string(value));
+    }
+
+    void RocalutionLogRecord::Add(const std::string& key, double value)
+    {
+        // JSON has no representation of inf and NaN
+        if(std::isfinite(value) == false)
         {
-            LOG_INFO("HIP is not initialized");
+            this->Add(key, std::string("null"));
+            return;
         }
-#else
-        LOG_VERBOSE_INFO(3, "No HIP support");
-#endif
 
-#ifdef SUPPORT_MULTINODE
-        LOG_INFO("MPI rank: " << backend_descriptor.rank);
+        std::ostringstream str;
+        str.precision(std::numeric_limits<double>::max_digits10);
+        str << value;
 
-        MPI_Comm comm = MPI_COMM_WORLD;
-        int      num_procs;
+        this->Add(key, str.str());
+    }
 
-        int status_init;
-        MPI_Initialized(&status_init);
+    RocalutionGraph::RocalutionGraph()
+        : stream_(NULL)
+        , graph_(NULL)
+    {
+    }
 
-        if(status_init == 1)
-        {
-            int status = MPI_Comm_size(comm, &num_procs);
+    RocalutionGraph::~RocalutionGraph()
+    {
+        this->Clear();
+    }
 
-            if(status == MPI_SUCCESS)
-            {
-                LOG_INFO("MPI size: " << num_procs);
-            }
-            else
-            {
-                LOG_INFO("MPI is not initialized");
-            }
-        }
-        else
+    bool RocalutionGraph::BeginCapture_(const Rocalution_Backend_Descriptor& backend)
+    {
+        this->Clear();
+
+        // Work on the default stream cannot be captured and the timers of the time
+        // breakdown synchronize with the host
+        if(_rocalution_available_accelerator() == false || _rocalution_time_breakdown == true
+           || backend.HIP_stream_current == NULL
+           || backend.HIP_stream_current == _get_backend_descriptor()->HIP_stream_default)
         {
-            LOG_INFO("MPI is not initialized");
+            return false;
         }
+
+#ifdef SUPPORT_HIP
+        log_debug(0, "RocalutionGraph::BeginCapture_()", backend.HIP_stream_current);
+
+        rocalution_hip_graph_begin(backend.HIP_stream_current);
+
+        this->stream_ = backend.HIP_stream_current;
+
+        return true;
 #else
-        LOG_INFO("MPI is not initialized");
+        return false;
 #endif
     }
 
-    void set_omp_affinity_rocalution(bool affinity)
+    void RocalutionGraph::EndCapture(void)
     {
-        assert(_get_backend_descriptor()->init == false);
+        assert(this->stream_ != NULL);
+        assert(this->graph_ == NULL);
 
-        _get_backend_descriptor()->OpenMP_affinity = affinity;
+#ifdef SUPPORT_HIP
+        this->graph_ = rocalution_hip_graph_end(this->stream_);
+#endif
     }
 
-    void set_omp_threshold_rocalution(int threshold)
+    bool RocalutionGraph::Launch(void) const
     {
-        assert(_get_backend_descriptor()->init == true);
+        if(this->graph_ == NULL)
+        {
+            return false;
+        }
 
-        _get_backend_descriptor()->OpenMP_threshold = threshold;
-    }
+#ifdef SUPPORT_HIP
+        rocalution_hip_graph_launch(this->graph_, this->stream_);
+#endif
 
-    bool _rocalution_available_accelerator(void)
-    {
-        return _get_backend_descriptor()->accelerator;
+        return true;
     }
 
-    void disable_accelerator_rocalution(bool onoff)
+    void RocalutionGraph::Clear(void)
     {
-        assert(_get_backend_descriptor()->init == false);
+#ifdef SUPPORT_HIP
+        if(this->graph_ != NULL)
+        {
+            rocalution_hip_graph_destroy(this->graph_);
+        }
+#endif
 
-        _get_backend_descriptor()->disable_accelerator = onoff;
+        this->stream_ = NULL;
+        this->graph_  = NULL;
     }
 
     struct Rocalution_Backend_Descriptor* _get_backend_descriptor(void)
@@ -512,11 +1947,99 @@ namespace rocalution
             return new HostMatrixMCSR<ValueType>(backend_descriptor);
         case BCSR:
             return new HostMatrixBCSR<ValueType>(backend_descriptor, blockdim);
+        case SELL:
+            return new HostMatrixSELL<ValueType>(backend_descriptor);
+        case VBR:
+            return new HostMatrixVBR<ValueType>(backend_descriptor);
+        default:
+            return NULL;
+        }
+    }
+
+    template <typename ValueType>
+    HostStencil<ValueType>* _rocalution_init_base_host_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type)
+    {
+        log_debug(0, "_rocalution_init_base_host_stencil()", stencil_type);
+
+        switch(stencil_type)
+        {
+        case Laplace2D:
+            return new HostStencilLaplace2D<ValueType>(backend_descriptor);
+        case Laplace3D:
+        case Laplace3D27:
+            return new HostStencilLaplace3D<ValueType>(backend_descriptor, stencil_type);
+        default:
+            return NULL;
+        }
+    }
+
+    template <typename ValueType>
+    AcceleratorStencil<ValueType>* _rocalution_init_base_backend_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type)
+    {
+        log_debug(0, "_rocalution_init_base_backend_stencil()", stencil_type);
+
+        switch(backend_descriptor.backend)
+        {
+#ifdef SUPPORT_HIP
+        case HIP:
+            return _rocalution_init_base_hip_stencil<ValueType>(backend_descriptor, stencil_type);
+#endif
+
         default:
+            LOG_INFO("Rocalution was not compiled with "
+                     << _rocalution_backend_name[backend_descriptor.backend] << " support");
+            LOG_INFO("Building " << _stencil_type_names[stencil_type] << " Stencil on "
+                                 << _rocalution_backend_name[backend_descriptor.backend]
+                                 << " failed");
+
+            FATAL_ERROR(__FILE__, __LINE__);
             return NULL;
         }
     }
 
+    void _rocalution_init_local_backend(Rocalution_Backend_Descriptor* backend)
+    {
+        assert(backend != NULL);
+
+        *backend = *_get_backend_descriptor();
+
+        if(_rocalution_current_context != NULL)
+        {
+            _rocalution_current_context->Attach(backend);
+        }
+    }
+
+    void _rocalution_activate_backend(const Rocalution_Backend_Descriptor& backend)
+    {
+        _set_omp_backend_threads(backend, -1);
+        _rocalution_set_device(backend.HIP_dev);
+    }
+
+    void _rocalution_sync_backend(const Rocalution_Backend_Descriptor& backend)
+    {
+        if(_rocalution_available_accelerator() == true)
+        {
+#ifdef SUPPORT_HIP
+            const Rocalution_Backend_Descriptor* global = _get_backend_descriptor();
+
+            // Objects without an execution context queue their work on the global streams
+            if(backend.HIP_stream_current == NULL
+               || backend.HIP_stream_current == global->HIP_stream_default
+               || backend.HIP_stream_current == global->HIP_stream_interior
+               || backend.HIP_stream_current == global->HIP_stream_ghost)
+            {
+                rocalution_hip_sync();
+            }
+            else
+            {
+                rocalution_hip_sync_context(backend.HIP_stream_current);
+            }
+#endif
+        }
+    }
+
     void _rocalution_sync(void)
     {
         if(_rocalution_available_accelerator() == true)
@@ -587,6 +2110,18 @@ namespace rocalution
         }
     }
 
+    int _rocalution_set_device(int device)
+    {
+        if(_rocalution_available_accelerator() == true && device >= 0)
+        {
+#ifdef SUPPORT_HIP
+            return rocalution_hip_set_device(device);
+#endif
+        }
+
+        return -1;
+    }
+
     void _set_omp_backend_threads(const struct Rocalution_Backend_Descriptor& backend_descriptor,
                                   int64_t                                     size)
     {
@@ -606,12 +2141,53 @@ namespace rocalution
         }
     }
 
+    void _set_omp_backend_threads(const struct Rocalution_Backend_Descriptor& backend_descriptor,
+                                  int64_t                                     size,
+                                  _rocalution_omp_op                          op)
+    {
+        // Without calibration, the global threshold applies
+        if((backend_descriptor.OpenMP_op_threshold[op] < 0) || (size < 0))
+        {
+            _set_omp_backend_threads(backend_descriptor, size);
+            return;
+        }
+
+#ifdef _OPENMP
+        if(size <= backend_descriptor.OpenMP_op_threshold[op])
+        {
+            omp_set_num_threads(1);
+        }
+        else
+        {
+            // Power of two size class
+            int c = 0;
+
+            while((c < _rocalution_omp_size_classes - 1) && (size >> (c + 1)) > 0)
+            {
+                ++c;
+            }
+
+            int nthreads = backend_descriptor.OpenMP_op_threads[op][c];
+
+            omp_set_num_threads((nthreads > 0)
+                                    ? std::min(nthreads, backend_descriptor.OpenMP_threads)
+                                    : backend_descriptor.OpenMP_threads);
+        }
+#endif
+    }
+
+    // Objects can be created and destroyed concurrently, e.g. by the worker thread of an
+    // asynchronous solve
+    static std::mutex _rocalution_obj_mutex;
+
     size_t _rocalution_add_obj(class RocalutionObj* ptr)
     {
 #ifndef OBJ_TRACKING_OFF
 
         log_debug(0, "Creating new rocALUTION object, ptr=", ptr);
 
+        std::lock_guard<std::mutex> lock(_rocalution_obj_mutex);
+
         Rocalution_Object_Data_Tracking.all_obj.push_back(ptr);
 
         int id = Rocalution_Object_Data_Tracking.all_obj.size() - 1;
@@ -637,6 +2213,8 @@ namespace rocalution
 
         log_debug(0, "Deleting rocALUTION object, id=", id);
 
+        std::lock_guard<std::mutex> lock(_rocalution_obj_mutex);
+
         if(Rocalution_Object_Data_Tracking.all_obj[id] == ptr)
         {
             ok = true;
@@ -760,4 +2338,26 @@ namespace rocalution
         int                                         blockdim);
 #endif
 
+    template HostStencil<float>* _rocalution_init_base_host_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+    template HostStencil<double>* _rocalution_init_base_host_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+#ifdef SUPPORT_COMPLEX
+    template HostStencil<std::complex<float>>* _rocalution_init_base_host_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+    template HostStencil<std::complex<double>>* _rocalution_init_base_host_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+#endif
+
+    template AcceleratorStencil<float>* _rocalution_init_base_backend_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+    template AcceleratorStencil<double>* _rocalution_init_base_backend_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+#ifdef SUPPORT_COMPLEX
+    template AcceleratorStencil<std::complex<float>>* _rocalution_init_base_backend_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+    template AcceleratorStencil<std::complex<double>>* _rocalution_init_base_backend_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+#endif
+
 } // namespace rocalution
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -41,6 +41,29 @@ namespace rocalution
     class AcceleratorMatrix;
     template <typename ValueType>
     class HostMatrix;
+    template <typename ValueType>
+    class AcceleratorStencil;
+    template <typename ValueType>
+    class HostStencil;
+    template <typename ValueType>
+    class BaseRocalution;
+
+    /** \ingroup backend_module
+  * \brief Host operation classes with their own OpenMP threshold
+  * \details
+  * The OpenMP thresholds and thread counts of these classes can be calibrated at
+  * initialization, see set_omp_calibration_rocalution().
+  */
+    enum _rocalution_omp_op : int
+    {
+        OMP_OP_VECTOR = 0, /**< Vector operations (BLAS1) */
+        OMP_OP_SPMV   = 1 /**< Sparse matrix vector products */
+    };
+
+    /** \brief Number of host operation classes */
+    const int _rocalution_omp_num_ops = 2;
+    /** \brief Number of power of two size classes of the calibrated thread counts */
+    const int _rocalution_omp_size_classes = 32;
 
     /** \ingroup backend_module
   * \struct Rocalution_Backend_Descriptor
@@ -70,6 +93,13 @@ namespace rocalution
         bool OpenMP_affinity;
         /** \brief Host threshold size */
         int64_t OpenMP_threshold;
+        /** \brief Flag whether the OpenMP thresholds are calibrated at initialization */
+        bool OpenMP_calibrate;
+        /** \brief Host threshold size per operation class (-1 - use OpenMP_threshold) */
+        int64_t OpenMP_op_threshold[_rocalution_omp_num_ops];
+        /** \brief Host threads per operation class and power of two size class (0 - use
+        * OpenMP_threads) */
+        int OpenMP_op_threads[_rocalution_omp_num_ops][_rocalution_omp_size_classes];
 
         // HIP handle section
         /** \brief rocblas_handle casted in void ** */
@@ -99,11 +129,27 @@ namespace rocalution
         int HIP_num_procs;
         /** \brief HIP thread per processor count */
         int HIP_threads_per_proc;
+        /** \brief Flag whether device buffers are cached in a memory pool */
+        bool HIP_mem_pool;
+        /** \brief Flag whether device buffers are allocated as managed memory */
+        bool HIP_managed_memory;
 
         /** \brief MPI rank/id */
         int rank;
+        /** \brief MPI communicator casted in void* (NULL - MPI_COMM_WORLD) */
+        const void* MPI_comm;
+        /** \brief MPI communicator id, the MPI_COMM_WORLD rank of its first process (-1 -
+        * MPI_COMM_WORLD) */
+        int MPI_comm_id;
+        /** \brief Flag whether MPI can directly access accelerator memory */
+        bool GPU_aware_MPI;
 
-        /** \brief Logging mode */
+        /** \brief Flag whether host fallbacks of accelerator objects are errors */
+        bool strict_host_fallback;
+        /** \brief Flag whether floating point sums are reduced in a fixed order */
+        bool reproducible_reductions;
+
+        /** \brief Logging mode (0 - off, 1 - trace, 2 - structured solve records) */
         int log_mode;
         /** \brief Logging file */
         std::ofstream* log_file;
@@ -168,6 +214,51 @@ namespace rocalution
     ROCALUTION_EXPORT
     int init_rocalution(int rank = -1, int dev_per_node = 1);
 
+    /** \ingroup backend_module
+  * \brief Initialize rocALUTION platform on an MPI communicator
+  * \details
+  * \p init_rocalution initializes the rocALUTION platform for a process of the MPI
+  * communicator \p comm, e.g. a sub-communicator created with \p MPI_Comm_split, such
+  * that independent ensemble members can run concurrently on disjoint sub-communicators
+  * of a single MPI job. The process is identified by its rank in \p comm, and log output
+  * and log files are tagged with the MPI_COMM_WORLD rank of the first process of \p comm,
+  * to tell the communicators apart. If the library is compiled with \p LOG_MPI_RANK, the
+  * process of that rank in each communicator prints log output.
+  *
+  * The accelerator device is selected from the rank of the process among all processes
+  * of its node, independent of the communicator it belongs to, so that the processes of
+  * all ensemble members are distributed densely over the devices of a node.
+  *
+  * \note This function is collective over MPI_COMM_WORLD. \p comm has to stay valid
+  * until stop_rocalution() is called, and it should be passed to the ParallelManager
+  * objects of the process.
+  *
+  * @param[in]
+  * comm            pointer to the MPI communicator of the process
+  * @param[in]
+  * dev_per_node    number of accelerator devices per node, if less or equal to zero all
+  *                 devices that are visible to the process are used
+  *
+  * \par Example
+  * \code{.cpp}
+  *   MPI_Comm comm;
+  *   MPI_Comm_split(MPI_COMM_WORLD, world_rank / procs_per_member, world_rank, &comm);
+  *
+  *   init_rocalution(&comm);
+  *
+  *   ParallelManager pm;
+  *   pm.SetMPICommunicator(&comm);
+  *
+  *   // ...
+  *
+  *   stop_rocalution();
+  *
+  *   MPI_Comm_free(&comm);
+  * \endcode
+  */
+    ROCALUTION_EXPORT
+    int init_rocalution(const void* comm, int dev_per_node = 0);
+
     /** \ingroup backend_module
   * \brief Shutdown rocALUTION platform
   * \details
@@ -188,6 +279,26 @@ namespace rocalution
     ROCALUTION_EXPORT
     void set_device_rocalution(int dev);
 
+    /** \ingroup backend_module
+  * \brief Enable/disable topology-aware host binding
+  * \details
+  * \p set_topology_binding_rocalution binds the host cpus of each process to the NUMA
+  * node its accelerator device is attached to, as reported by Linux \p /sys. With
+  * init_rocalution(const void*, int), the cpus of a NUMA node are split among the
+  * processes of the node, whose devices are attached to it. The OpenMP threads are
+  * limited to and pinned within the bound cpus. The binding can also be enabled through
+  * the environment variable \p ROCALUTION_TOPOLOGY_BINDING=1.
+  *
+  * \note
+  * This function has to be called before init_rocalution(), with the same value on all
+  * processes of a node.
+  *
+  * @param[in]
+  * onoff   boolean to turn on/off the topology binding
+  */
+    ROCALUTION_EXPORT
+    void set_topology_binding_rocalution(bool onoff);
+
     /** \ingroup backend_module
   * \brief Set number of OpenMP threads
   * \details
@@ -195,10 +306,17 @@ namespace rocalution
   * \p set_omp_threads_rocalution or by the global OpenMP environment variable (for
   * Unix-like OS this is \p OMP_NUM_THREADS). During the initialization phase, the
   * library provides affinity thread-core mapping:
-  * - If the number of cores (including SMT cores) is greater or equal than two times the
-  *   number of threads, then all the threads can occupy every second core ID (e.g. 0, 2,
-  *   4, \f$\ldots\f$). This is to avoid having two threads working on the same physical
-  *   core, when SMT is enabled.
+  * - If the OpenMP runtime binds its threads (e.g. \p OMP_PROC_BIND is set), its binding
+  *   is kept.
+  * - If the CPU topology is available (Linux \p /sys), each thread is pinned to its own
+  *   core. Consecutive threads are spread round robin across the NUMA nodes, and each
+  *   physical core gets a thread before SMT cores are used. Large host buffers are first
+  *   touched with the static OpenMP schedule of the host kernels, such that their pages
+  *   reside on the NUMA node of the threads that work on them.
+  * - Otherwise, if the number of cores (including SMT cores) is greater or equal than two
+  *   times the number of threads, then all the threads can occupy every second core ID
+  *   (e.g. 0, 2, 4, \f$\ldots\f$). This is to avoid having two threads working on the
+  *   same physical core, when SMT is enabled.
   * - If the number of threads is less or equal to the number of cores (including SMT),
   *   and the previous clause is false, then the threads can occupy every core ID (e.g.
   *   0, 1, 2, 3, \f$\ldots\f$).
@@ -239,7 +357,8 @@ namespace rocalution
   * rocALUTION. The default threshold is set to 10000, which means that all matrices
   * under (and equal) this size will use only one thread (disregarding the number of
   * OpenMP threads set in the system). The threshold can be modified with
-  * \p set_omp_threshold_rocalution.
+  * \p set_omp_threshold_rocalution, which also replaces calibrated thresholds (see
+  * set_omp_calibration_rocalution()).
   *
   * @param[in]
   * threshold   OpenMP threshold size
@@ -247,6 +366,24 @@ namespace rocalution
     ROCALUTION_EXPORT
     void set_omp_threshold_rocalution(int threshold);
 
+    /** \ingroup backend_module
+  * \brief Enable/disable the calibration of the OpenMP thresholds
+  * \details
+  * A single OpenMP threshold size does not fit all host operations, and small operations
+  * pay the full fork/join cost of all threads above it. With
+  * \p set_omp_calibration_rocalution, init_rocalution() runs short microbenchmarks of
+  * vector updates and sparse matrix vector products of several sizes, and stores a
+  * threshold size and the fastest number of threads per size for each operation class
+  * in the backend descriptor. The calibration takes a fraction of a second and can also
+  * be enabled by setting the environment variable \p ROCALUTION_OMP_CALIBRATION=1. This
+  * function has to be called before init_rocalution().
+  *
+  * @param[in]
+  * onoff   boolean to turn on/off the OpenMP threshold calibration
+  */
+    ROCALUTION_EXPORT
+    void set_omp_calibration_rocalution(bool onoff = true);
+
     /** \ingroup backend_module
   * \brief Print info about rocALUTION
   * \details
@@ -279,9 +416,575 @@ namespace rocalution
     ROCALUTION_EXPORT
     void disable_accelerator_rocalution(bool onoff = true);
 
+    /** \ingroup backend_module
+  * \brief Enable/disable GPU-aware MPI
+  * \details
+  * If the MPI library is able to directly access accelerator memory (e.g. ROCm-aware
+  * MPI), \p set_gpu_aware_mpi_rocalution lets rocALUTION pass accelerator pointers
+  * straight to MPI during halo exchanges, skipping the host staging buffers. GPU-aware
+  * MPI can also be enabled by setting the environment variable
+  * \p ROCALUTION_GPU_AWARE_MPI=1. This function has to be called before
+  * init_rocalution().
+  *
+  * @param[in]
+  * onoff   boolean to turn on/off GPU-aware MPI
+  */
+    ROCALUTION_EXPORT
+    void set_gpu_aware_mpi_rocalution(bool onoff = true);
+
+    /** \ingroup backend_module
+  * \brief Enable/disable the device memory pool
+  * \details
+  * By default, device buffers that are released by rocALUTION are cached and reused by
+  * subsequent allocations of similar size, instead of calling \p hipFree, which
+  * synchronizes the device. \p set_hip_memory_pool_rocalution can be used to turn the
+  * pool off, e.g. when device memory is shared with other libraries. The pool can also be
+  * disabled by setting the environment variable \p ROCALUTION_HIP_MEMORY_POOL=0. This
+  * function has to be called before init_rocalution().
+  *
+  * @param[in]
+  * onoff   boolean to turn on/off the device memory pool
+  */
+    ROCALUTION_EXPORT
+    void set_hip_memory_pool_rocalution(bool onoff = true);
+
+    /** \ingroup backend_module
+  * \brief Enable/disable managed device memory
+  * \details
+  * By default, device buffers are allocated with \p hipMalloc and problems have to fit
+  * into device memory. With \p set_hip_managed_memory_rocalution, device buffers are
+  * allocated as managed memory (\p hipMallocManaged) instead, with the device as
+  * preferred location. Problems that are larger than the device memory can then be
+  * solved, the runtime migrates pages between host and device on demand. Multigrid
+  * solvers prefetch the operators and vectors of the next level ahead of use, see
+  * BaseRocalution::Prefetch(). Managed memory buffers are not cached by the device
+  * memory pool. The mode can also be enabled by setting the environment variable
+  * \p ROCALUTION_HIP_MANAGED_MEMORY=1. If the device does not support managed memory,
+  * the mode is turned off. This function has to be called before init_rocalution().
+  *
+  * @param[in]
+  * onoff   boolean to turn on/off managed device memory
+  */
+    ROCALUTION_EXPORT
+    void set_hip_managed_memory_rocalution(bool onoff = true);
+
+    /** \ingroup backend_module
+  * \brief Enable/disable the strict host fallback mode
+  * \details
+  * Operations that are not available on the accelerator backend are silently performed
+  * on the host, which requires moving the data back and forth. In strict mode, such a
+  * host fallback of an accelerator object is treated as an error and aborts the program,
+  * before any data is moved. The strict mode can also be enabled by setting the
+  * environment variable \p ROCALUTION_STRICT_HOST_FALLBACK=1. This function can be called
+  * at any time.
+  *
+  * @param[in]
+  * onoff   boolean to turn on/off the strict host fallback mode
+  */
+    ROCALUTION_EXPORT
+    void set_strict_host_fallback_rocalution(bool onoff = true);
+
+    /** \ingroup backend_module
+  * \brief Enable/disable reproducible reductions
+  * \details
+  * The floating point sums of \p Dot, \p DotNonConj, \p Norm, \p Reduce and \p Asum are
+  * accumulated in an order that depends on the number of OpenMP threads, and on the
+  * scheduling of the reduction on the accelerator and of the MPI allreduce. In
+  * reproducible mode, the vector is split into blocks of a fixed size, independent of the
+  * number of threads and of the device, and the block sums are added in a fixed order.
+  * The partial sums of the MPI processes are gathered and added in rank order. Results
+  * are then bitwise identical between runs and thread counts, for the same backend and
+  * number of processes; host and accelerator results still differ. The reductions keep
+  * streaming the vectors once, at the cost of an additional pass over the block sums.
+  * Asynchronous reductions (\p DotAsync, \p NormAsync) are not affected. The mode can
+  * also be enabled by setting the environment variable
+  * \p ROCALUTION_REPRODUCIBLE_REDUCTIONS=1. This function can be called at any time.
+  *
+  * @param[in]
+  * onoff   boolean to turn on/off the reproducible reductions
+  */
+    ROCALUTION_EXPORT
+    void set_reproducible_reductions_rocalution(bool onoff = true);
+
+    /** \ingroup backend_module
+  * \brief Query the host fallback statistics
+  * \details
+  * rocALUTION keeps track of all operations of accelerator objects that have been
+  * performed on the host. \p get_host_fallback_rocalution returns the number of host
+  * fallbacks of \p function (e.g. "LocalMatrix::ILU0Factorize()"), the estimated number
+  * of bytes that had to be moved and the time spent in the fallback (including the
+  * transfers). If \p function is empty, the totals over all functions are returned.
+  *
+  * @param[in]
+  * function    name of the function, or an empty string for the totals
+  * @param[out]
+  * count       number of host fallbacks
+  * @param[out]
+  * bytes       estimated number of bytes moved between accelerator and host
+  * @param[out]
+  * time        time spent in the host fallbacks in seconds
+  *
+  * \retval true if statistics for \p function have been recorded (always true for the
+  *         totals).
+  * \retval false if \p function did not fall back to the host so far.
+  */
+    ROCALUTION_EXPORT
+    bool get_host_fallback_rocalution(const std::string& function,
+                                      int64_t*           count,
+                                      int64_t*           bytes,
+                                      double*            time);
+
+    /** \ingroup backend_module
+  * \brief Print the host fallback statistics of all functions */
+    ROCALUTION_EXPORT
+    void info_host_fallback_rocalution(void);
+
+    /** \ingroup backend_module
+  * \brief Reset the host fallback statistics */
+    ROCALUTION_EXPORT
+    void reset_host_fallback_rocalution(void);
+
+    // Memory locations of the memory usage statistics
+    enum _rocalution_memory_location
+    {
+        HostMemory        = 0,
+        PinnedMemory      = 1,
+        AcceleratorMemory = 2
+    };
+
+    /** \ingroup backend_module
+  * \brief Query the memory usage of a memory location
+  * \details
+  * rocALUTION keeps track of all buffers that are allocated by its objects.
+  * \p get_memory_usage_rocalution returns the number of bytes that are currently
+  * allocated in \p location (\p HostMemory, \p PinnedMemory or \p AcceleratorMemory)
+  * and the peak number of bytes since init_rocalution() or the last call to
+  * reset_memory_peak_rocalution(). Buffers that are cached by the device memory pool,
+  * but not in use, are not counted.
+  *
+  * @param[in]
+  * location    memory location
+  * @param[out]
+  * current     number of bytes currently allocated
+  * @param[out]
+  * peak        peak number of bytes allocated
+  */
+    ROCALUTION_EXPORT
+    void get_memory_usage_rocalution(int location, int64_t* current, int64_t* peak);
+
+    /** \ingroup backend_module
+  * \brief Query the memory usage of a tag
+  * \details
+  * Allocations are tagged with the names of the objects that own them (e.g. the name
+  * passed to LocalVector::Allocate()) and with the names of the solver scopes they are
+  * performed in (e.g. "MultiGrid 0x1a2b3c level 2" for the second level of the multigrid
+  * solver at address 0x1a2b3c). \p get_memory_usage_tag_rocalution returns the number of bytes
+  * currently allocated under \p tag, summed over all memory locations, and its peak.
+  *
+  * @param[in]
+  * tag         name of the tag
+  * @param[out]
+  * current     number of bytes currently allocated
+  * @param[out]
+  * peak        peak number of bytes allocated
+  *
+  * \retval true if allocations have been tagged with \p tag.
+  * \retval false if no allocation has been tagged with \p tag so far.
+  */
+    ROCALUTION_EXPORT
+    bool get_memory_usage_tag_rocalution(const std::string& tag, int64_t* current, int64_t* peak);
+
+    /** \ingroup backend_module
+  * \brief Print the memory usage of all memory locations and tags */
+    ROCALUTION_EXPORT
+    void info_memory_usage_rocalution(void);
+
+    /** \ingroup backend_module
+  * \brief Reset the peak memory usage to the current memory usage */
+    ROCALUTION_EXPORT
+    void reset_memory_peak_rocalution(void);
+
+    // Categories of the solver time breakdown
+    enum _rocalution_time_category
+    {
+        TimeSpMV           = 0,
+        TimePreconditioner = 1,
+        TimeCommunication  = 2,
+        TimeAllreduce      = 3
+    };
+
+    /** \ingroup backend_module
+  * \brief Enable/disable the solver time breakdown
+  * \details
+  * When enabled, rocALUTION records the time spent in sparse matrix vector products
+  * (\p TimeSpMV), in the application of preconditioners (\p TimePreconditioner), in
+  * waiting for the completion of MPI point-to-point (halo) communication
+  * (\p TimeCommunication) and in MPI reductions (\p TimeAllreduce). The
+  * categories are exclusive, e.g. a matrix vector product within a preconditioner only
+  * counts as preconditioner time. The remaining time of a solve is spent in vector
+  * operations. As the accelerator is synchronized at the start and end of each recorded
+  * operation, the breakdown is disabled by default.
+  *
+  * @param[in]
+  * onoff   boolean to turn on/off the time breakdown
+  */
+    ROCALUTION_EXPORT
+    void set_time_breakdown_rocalution(bool onoff = true);
+
+    /** \ingroup backend_module
+  * \brief Return the time (in seconds) recorded for a category of the solver time
+  * breakdown since init_rocalution() or the last call to reset_time_breakdown_rocalution()
+  *
+  * @param[in]
+  * category    \p TimeSpMV, \p TimePreconditioner, \p TimeCommunication or
+  *             \p TimeAllreduce
+  */
+    ROCALUTION_EXPORT
+    double get_time_breakdown_rocalution(int category);
+
+    /** \ingroup backend_module
+  * \brief Reset the solver time breakdown */
+    ROCALUTION_EXPORT
+    void reset_time_breakdown_rocalution(void);
+
+    /** \ingroup backend_module
+  * \brief Query the number of bytes copied between host and accelerator
+  * \details
+  * \p get_transfer_bytes_rocalution returns the number of bytes that have been copied from
+  * the host to the accelerator and from the accelerator to the host since
+  * init_rocalution() or the last call to reset_transfer_bytes_rocalution().
+  *
+  * @param[out]
+  * h2d     number of bytes copied from the host to the accelerator
+  * @param[out]
+  * d2h     number of bytes copied from the accelerator to the host
+  */
+    ROCALUTION_EXPORT
+    void get_transfer_bytes_rocalution(int64_t* h2d, int64_t* d2h);
+
+    /** \ingroup backend_module
+  * \brief Reset the number of bytes copied between host and accelerator */
+    ROCALUTION_EXPORT
+    void reset_transfer_bytes_rocalution(void);
+
+    /** \ingroup backend_module
+  * \brief Set the file of the persistent tuning cache
+  * \details
+  * The formats selected by LocalMatrix::ConvertToBest() are cached for the lifetime of
+  * the process. With \p set_tuning_cache_rocalution, the decisions are also loaded from
+  * and appended to \p filename, such that matrices with the same signature (device
+  * architecture, value type, sizes, row length histogram and structure keys) are
+  * converted without timing in subsequent runs. The file is created if it does not
+  * exist. It can also be set with the environment variable \p ROCALUTION_TUNING_CACHE.
+  * An empty filename disables the persistent cache.
+  *
+  * @param[in]
+  * filename    name of the tuning cache file
+  */
+    ROCALUTION_EXPORT
+    void set_tuning_cache_rocalution(const std::string& filename);
+
+    /** \ingroup backend_module
+  * \brief Record a timeline trace of this process
+  * \details
+  * With \p set_trace_rocalution, rocALUTION records the ranges of solver builds, solver
+  * iterations, multigrid levels, the phases of GlobalMatrix::Apply(), sparse matrix vector
+  * products, copies between host and accelerator and MPI waits with host timestamps. With
+  * an accelerator, the ranges are also recorded with events on the current stream, and
+  * shown on a separate accelerator track. At stop_rocalution(), the trace is written in the
+  * Chrome trace event format to \p filename.<rank>.json, which can be opened with
+  * Perfetto or chrome://tracing. It can also be set with the environment variable
+  * \p ROCALUTION_TRACE. An empty filename stops the recording. This requires rocALUTION to
+  * be built with BUILD_WITH_TRACE=ON.
+  *
+  * @param[in]
+  * filename    prefix of the trace file
+  */
+    ROCALUTION_EXPORT
+    void set_trace_rocalution(const std::string& filename);
+
+    /** \ingroup backend_module
+  * \class ExecutionContext
+  * \brief Execution context with its own accelerator stream
+  * \details
+  * By default, all accelerator work of rocALUTION is queued on the streams of the global
+  * backend descriptor, and thus serializes. An execution context carries its own HIP
+  * stream and rocBLAS/rocSPARSE handles bound to that stream. Objects that are attached
+  * to a context with BaseRocalution::SetExecutionContext() queue their work on the
+  * stream of the context. Objects created with CloneBackend() from an attached object
+  * (e.g. the temporary vectors of a solver, which clone the backend of its operator)
+  * are attached to the same context. Independent solves on different contexts can run
+  * concurrently on one device.
+  *
+  * The stream can be supplied by the application (a \p hipStream_t casted to \p void*),
+  * to interleave rocALUTION with its own kernels, otherwise a stream is created. The
+  * context has to be created after init_rocalution() and has to outlive all attached
+  * objects. Without accelerator, the context has no effect.
+  *
+  * A context can also be bound to another device than the one selected in
+  * init_rocalution(), to distribute independent work (e.g. the blocks of a block-Jacobi
+  * preconditioner) over several devices of a node without MPI. Objects are moved to the
+  * device of a context with LocalMatrix::MoveToAccelerator(const ExecutionContext&) and
+  * LocalVector::MoveToAccelerator(const ExecutionContext&). Peer access between the
+  * devices in use is enabled where supported, such that CopyFrom() between objects on
+  * different devices is a direct device to device copy. Accelerator memory is allocated
+  * on the current device of the calling thread, thus a host thread that works on the
+  * objects of a context has to call Activate() first.
+  *
+  * Objects on different contexts can be used concurrently from different host threads,
+  * e.g. by the tasks of a task-based runtime, as long as no object, solver or
+  * SolverWorkspace is shared between the threads. A thread that calls MakeCurrent()
+  * attaches all objects it creates to the context. The halo exchange of
+  * GlobalMatrix::Apply() switches the streams of the global backend and is therefore
+  * serialized between host threads.
+  *
+  * \par Example
+  * \code{.cpp}
+  *   ExecutionContext ctx1;
+  *   ExecutionContext ctx2(my_stream);
+  *
+  *   A1.SetExecutionContext(ctx1);
+  *   x1.SetExecutionContext(ctx1);
+  *   b1.SetExecutionContext(ctx1);
+  *
+  *   A2.SetExecutionContext(ctx2);
+  *   x2.SetExecutionContext(ctx2);
+  *   b2.SetExecutionContext(ctx2);
+  *
+  *   // Build the solvers after attaching their operators
+  *   ls1.SetOperator(A1);
+  *   ls1.Build();
+  *
+  *   ls2.SetOperator(A2);
+  *   ls2.Build();
+  *
+  *   // Solve from two host threads
+  *   #pragma omp parallel sections num_threads(2)
+  *   {
+  *       #pragma omp section
+  *       ls1.Solve(b1, &x1);
+  *       #pragma omp section
+  *       ls2.Solve(b2, &x2);
+  *   }
+  * \endcode
+  */
+    class ExecutionContext
+    {
+    public:
+        /** \brief Create a context on \p stream, or on a new stream if it is NULL. The
+        * context is bound to \p device, or to the device of the backend if it is negative.
+        * A user supplied stream has to belong to that device. */
+        ROCALUTION_EXPORT
+        explicit ExecutionContext(void* stream = NULL, int device = -1);
+        ROCALUTION_EXPORT
+        ~ExecutionContext();
+
+        /** \brief Block the host until all work of the context is completed */
+        ROCALUTION_EXPORT
+        void Sync(void) const;
+
+        /** \brief Return the stream of the context (a \p hipStream_t casted to \p void*) */
+        ROCALUTION_EXPORT
+        void* GetStream(void) const;
+
+        /** \brief Return the device of the context, -1 without accelerator */
+        ROCALUTION_EXPORT
+        int GetDevice(void) const;
+
+        /** \brief Make the device of the context the current device of the calling thread */
+        ROCALUTION_EXPORT
+        void Activate(void) const;
+
+        /** \brief Make the context current on the calling host thread
+        * \details
+        * In addition to Activate(), \p MakeCurrent sets the number of OpenMP threads of
+        * the calling thread (see set_omp_threads_rocalution()) and attaches all objects
+        * that the calling thread creates afterwards to the context. A host thread can thus
+        * work on its own objects without calling BaseRocalution::SetExecutionContext() for
+        * each of them. The context stays current on the thread until ReleaseCurrent() is
+        * called or the context is destroyed.
+        */
+        ROCALUTION_EXPORT
+        void MakeCurrent(void) const;
+
+        /** \brief Create the objects of the calling host thread on the global backend
+        * again, see MakeCurrent() */
+        ROCALUTION_EXPORT
+        static void ReleaseCurrent(void);
+
+        /** \private */
+        // Attach a backend descriptor to the context
+        void Attach(Rocalution_Backend_Descriptor* backend) const;
+
+    private:
+        ExecutionContext(const ExecutionContext&);
+        ExecutionContext& operator=(const ExecutionContext&);
+
+        // Flag whether the stream has been created by the context
+        bool own_stream_;
+
+        // Device of the context
+        int device_;
+
+        // hipStream_t*, rocblas_handle* and rocsparse_handle* casted in void*
+        void* stream_;
+        void* blas_handle_;
+        void* sparse_handle_;
+    };
+
+    // Record a buffer of bytes, that has been allocated in location, under the
+    // currently active tags
+    void _rocalution_memory_allocate(const void* ptr, int64_t bytes, int location);
+
+    // Record the release of a buffer
+    void _rocalution_memory_free(const void* ptr);
+
+    /** \private */
+    // Scope of a memory usage tag, allocations of the calling thread are recorded under
+    // all active tags. An empty name does not open a tag.
+    class RocalutionMemoryTag
+    {
+    public:
+        explicit RocalutionMemoryTag(const std::string& name);
+        ~RocalutionMemoryTag();
+
+    private:
+        bool active_;
+    };
+
+    /** \private */
+    // Scope of a category of the solver time breakdown. Nested scopes pause the
+    // enclosing category, such that each period of time is recorded only once.
+    class RocalutionTimeScope
+    {
+    public:
+        explicit RocalutionTimeScope(int category);
+        ~RocalutionTimeScope();
+
+    private:
+        bool active_;
+    };
+
+    /** \private */
+    // Scope of the compute mode switches of the global backend, see
+    // _rocalution_compute_interior(). The compute mode is process wide, thus the scopes of
+    // different host threads are serialized.
+    class RocalutionComputeScope
+    {
+    public:
+        RocalutionComputeScope();
+        ~RocalutionComputeScope();
+
+    private:
+        RocalutionComputeScope(const RocalutionComputeScope&);
+        RocalutionComputeScope& operator=(const RocalutionComputeScope&);
+    };
+
+    // Record a copy of bytes between host and accelerator
+    void _rocalution_transfer_record(int64_t bytes, bool to_accelerator);
+
+    /** \private */
+    // Structured record of a solve, written as a single JSON line into the log file if
+    // ROCALUTION_LAYER=2. The record contains the elapsed time, the time breakdown and the
+    // bytes copied between host and accelerator within the scope, and all added fields.
+    // Only the outermost of nested records (e.g. of inner solvers) is written.
+    class RocalutionLogRecord
+    {
+    public:
+        explicit RocalutionLogRecord(const std::string& event);
+        ~RocalutionLogRecord();
+
+        // Return true if the record is going to be written
+        bool IsActive(void) const;
+
+        // Add a field, value has to be valid JSON (e.g. a number or an object)
+        void Add(const std::string& key, const std::string& value);
+        void Add(const std::string& key, int64_t value);
+        void Add(const std::string& key, double value);
+
+    private:
+        bool        active_;
+        bool        counted_;
+        std::string event_;
+        std::string fields_;
+
+        double  start_;
+        double  breakdown_[4];
+        int64_t h2d_;
+        int64_t d2h_;
+    };
+
+    /** \private */
+    // Graph of accelerator work, that is captured once from the stream of an execution
+    // context and launched repeatedly with a single call. Only work that does not
+    // synchronize with the host can be captured.
+    class RocalutionGraph
+    {
+    public:
+        RocalutionGraph();
+        ~RocalutionGraph();
+
+        // Begin to capture the work queued on the stream of obj and other, which have to
+        // share the stream. Returns false if the stream cannot be captured (host objects,
+        // default stream, active time breakdown).
+        template <typename ValueType>
+        bool BeginCapture(const BaseRocalution<ValueType>& obj,
+                          const BaseRocalution<ValueType>& other)
+        {
+            return obj.local_backend_.HIP_stream_current == other.local_backend_.HIP_stream_current
+                   && obj.is_accel_() == true && other.is_accel_() == true
+                   && this->BeginCapture_(obj.local_backend_);
+        }
+
+        // End the capture and instantiate the graph
+        void EndCapture(void);
+
+        // Launch the graph on its stream, returns false if no graph has been captured
+        bool Launch(void) const;
+
+        // Release the graph
+        void Clear(void);
+
+    private:
+        RocalutionGraph(const RocalutionGraph&);
+        RocalutionGraph& operator=(const RocalutionGraph&);
+
+        bool BeginCapture_(const Rocalution_Backend_Descriptor& backend);
+
+        // hipStream_t* and hipGraphExec_t* casted in void*
+        void* stream_;
+        void* graph_;
+    };
+
+    // Start a host fallback of function, aborts in strict mode if is_accel is true.
+    // Returns the start time of the fallback.
+    double _rocalution_host_fallback_begin(const std::string& function, bool is_accel);
+
+    // Finish a host fallback of function and record its statistics
+    void _rocalution_host_fallback_end(const std::string& function, double start, int64_t bytes);
+
+    // Format and kernel configuration selected by LocalMatrix::ConvertToBest()
+    struct Rocalution_Tuning_Decision
+    {
+        unsigned int format;
+        int          blockdim;
+        int          block_size;
+    };
+
+    // Look up the tuning decision of a matrix signature
+    bool _rocalution_tuning_cache_find(const std::string&          signature,
+                                       Rocalution_Tuning_Decision* decision);
+
+    // Record the tuning decision of a matrix signature, it is appended to the cache file
+    void _rocalution_tuning_cache_insert(const std::string&                signature,
+                                         const Rocalution_Tuning_Decision& decision);
+
     // Return true if any accelerator is available
     bool _rocalution_available_accelerator(void);
 
+    // Return the free memory of the current accelerator in bytes, -1 if unknown
+    int64_t _rocalution_accelerator_free_memory(void);
+
     // Return backend descriptor
     struct Rocalution_Backend_Descriptor* _get_backend_descriptor(void);
 
@@ -292,6 +995,11 @@ namespace rocalution
     void _set_omp_backend_threads(const struct Rocalution_Backend_Descriptor& backend_descriptor,
                                   int64_t                                     size);
 
+    // Set the OMP threads based on the (calibrated) threshold of the operation class
+    void _set_omp_backend_threads(const struct Rocalution_Backend_Descriptor& backend_descriptor,
+                                  int64_t                                     size,
+                                  _rocalution_omp_op                          op);
+
     // Build (and return) a vector on the selected in the descriptor accelerator
     template <typename ValueType>
     AcceleratorVector<ValueType>* _rocalution_init_base_backend_vector(
@@ -311,6 +1019,27 @@ namespace rocalution
         unsigned int                                matrix_format,
         int                                         blockdim = 1);
 
+    // Build (and return) a stencil on the host
+    template <typename ValueType>
+    HostStencil<ValueType>* _rocalution_init_base_host_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+
+    // Build (and return) a stencil on the selected in the descriptor accelerator
+    template <typename ValueType>
+    AcceleratorStencil<ValueType>* _rocalution_init_base_backend_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+
+    // Initialize the backend descriptor of a new object from the global descriptor and the
+    // execution context that is current on the calling host thread
+    void _rocalution_init_local_backend(struct Rocalution_Backend_Descriptor* backend);
+
+    // Make the device and the OpenMP threads of the backend current on the calling host
+    // thread
+    void _rocalution_activate_backend(const struct Rocalution_Backend_Descriptor& backend);
+
+    // Block the host until the work queued on the stream of the backend is completed
+    void _rocalution_sync_backend(const struct Rocalution_Backend_Descriptor& backend);
+
     /** \ingroup backend_module
   * \brief Sync rocALUTION
   * \details
@@ -367,6 +1096,14 @@ namespace rocalution
     ROCALUTION_EXPORT
     void _rocalution_compute_default(void);
 
+    /** \ingroup backend_module
+  * \brief Set the accelerator device of the calling thread
+  * \details
+  * \p _rocalution_set_device makes \p device the current accelerator device of the calling
+  * thread and returns the previous one, or -1 without accelerator.
+  */
+    int _rocalution_set_device(int device);
+
     /** \ingroup backend_module
   * \brief get rocALUTION backend architecture
   * \details
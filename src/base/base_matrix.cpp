@@ -72,6 +72,30 @@ namespace rocalution
         this->local_backend_ = local_backend;
     }
 
+    template <typename ValueType>
+    void BaseMatrix<ValueType>::SetSpMVAlg(unsigned int alg)
+    {
+        // Only used by backends that provide several algorithms
+    }
+
+    template <typename ValueType>
+    void BaseMatrix<ValueType>::SetSpMVStorage(unsigned int storage)
+    {
+        // Only used by backends that provide a reduced precision product
+    }
+
+    template <typename ValueType>
+    void BaseMatrix<ValueType>::SetSpMVIndex(unsigned int index)
+    {
+        // Only used by backends that provide a product with compressed column indices
+    }
+
+    template <typename ValueType>
+    void BaseMatrix<ValueType>::SetOutOfCore(int64_t chunk_nnz)
+    {
+        // Only used by accelerator backends, host matrices are always in host memory
+    }
+
     template <typename ValueType>
     int BaseMatrix<ValueType>::GetMatBlockDimension(void) const
     {
@@ -267,6 +291,12 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::WriteFileCompressedRSIO(const std::string& filename) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::ExtractDiagonal(BaseVector<ValueType>* vec_diag) const
     {
@@ -279,6 +309,32 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ExtractInverseBlockDiagonal(int                    blockdim,
+                                                            BaseMatrix<ValueType>* inv_diag) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ExtractRowL1Norm(BaseVector<ValueType>* vec_l1) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ExtractConnectedRows(const BaseVector<bool>& cols,
+                                                     BaseVector<bool>*       rows) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::Statistics(MatrixStatistics* stats) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::ExtractSubMatrix(int                    row_offset,
                                                  int                    col_offset,
@@ -289,6 +345,16 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ExtractSubMatrices(int                     row_num_blocks,
+                                                   int                     col_num_blocks,
+                                                   const int*              row_offset,
+                                                   const int*              col_offset,
+                                                   BaseMatrix<ValueType>** mat) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::ExtractL(BaseMatrix<ValueType>* L) const
     {
@@ -434,6 +500,28 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::GraphPartition(int nparts, BaseVector<int>* partition) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::AMD(BaseVector<int>* permutation) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::NestedDissection(int              leaf_size,
+                                                 int&             num_nodes,
+                                                 int**            node_offset,
+                                                 int**            node_parent,
+                                                 BaseVector<int>* permutation) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::MultiColoring(int&             num_colors,
                                               int**            size_colors,
@@ -492,6 +580,22 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::SymbolicMatrixAdd(const BaseMatrix<ValueType>& A,
+                                                  const BaseMatrix<ValueType>& B)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::NumericMatrixAdd(const BaseMatrix<ValueType>& A,
+                                                 ValueType                    alpha,
+                                                 const BaseMatrix<ValueType>& B,
+                                                 ValueType                    beta)
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const
     {
@@ -554,6 +658,22 @@ namespace rocalution
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::TriangularLevels(bool lower, int* levels) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::TriangularBlockInverse(bool                   lower,
+                                                       bool                   diag_unit,
+                                                       int                    block_size,
+                                                       BaseMatrix<ValueType>* inv,
+                                                       BaseMatrix<ValueType>* off) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     void BaseMatrix<ValueType>::ItLUAnalyse(void)
     {
@@ -722,6 +842,31 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::TripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                                 const BaseMatrix<ValueType>& A,
+                                                 const BaseMatrix<ValueType>& P)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::NumericTripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                                        const BaseMatrix<ValueType>& A,
+                                                        const BaseMatrix<ValueType>& P)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::NumericTripleMatMatMultRows(const BaseMatrix<ValueType>& R,
+                                                            const BaseMatrix<ValueType>& A,
+                                                            const BaseMatrix<ValueType>& P,
+                                                            const BaseVector<bool>&      rows)
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::AMGConnect(ValueType eps, BaseVector<int>* connections) const
     {
@@ -799,6 +944,25 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::AMGNodeGraph(int blockdim, BaseMatrix<ValueType>* node) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::AMGNodeExpand(int                          blockdim,
+                                              const BaseMatrix<ValueType>& node,
+                                              const BaseVector<bool>&      node_connections,
+                                              const BaseVector<int64_t>&   node_aggregates,
+                                              const BaseVector<int64_t>& node_aggregate_root_nodes,
+                                              BaseVector<bool>*          connections,
+                                              BaseVector<int64_t>*       aggregates,
+                                              BaseVector<int64_t>* aggregate_root_nodes) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::AMGPMISInitializeState(int64_t                 global_column_begin,
                                                        const BaseVector<bool>& connections,
@@ -942,6 +1106,35 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::AMGProlongTruncate(double trunc_factor, int max_row_nnz)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::AMGEnergyMinimization(ValueType              relax,
+                                                      int                    iterations,
+                                                      BaseMatrix<ValueType>* prolong) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::AMGSmoothedAggregationNullSpace(
+        ValueType                    relax,
+        int                          lumping_strat,
+        const BaseVector<bool>&      connections,
+        const BaseVector<int64_t>&   aggregates,
+        const BaseVector<int64_t>&   aggregate_root_nodes,
+        int                          num_null,
+        const BaseVector<ValueType>& null_space,
+        BaseMatrix<ValueType>*       prolong,
+        BaseVector<ValueType>*       coarse_null_space) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::RSCoarsening(float             eps,
                                              BaseVector<int>*  CFmap,
@@ -1220,12 +1413,156 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::UpdateValues(const BaseVector<ValueType>& val,
+                                             const BaseVector<int>*       perm,
+                                             int64_t                      offset)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::AssembleValues(const BaseVector<ValueType>& val,
+                                               const BaseVector<int>&       offset,
+                                               const BaseVector<int>&       perm)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ApplyTranspose(const BaseVector<ValueType>& in,
+                                               BaseVector<ValueType>*       out) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ApplyTransposeAdd(const BaseVector<ValueType>& in,
+                                                  ValueType                    scalar,
+                                                  BaseVector<ValueType>*       out) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ApplyAddSymmetric(const BaseVector<ValueType>& in,
+                                                  ValueType                    scalar,
+                                                  BaseVector<ValueType>*       out) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ApplyMulti(int                          ncol,
+                                           const BaseVector<ValueType>& in,
+                                           BaseVector<ValueType>*       out) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ApplyAddMulti(int                          ncol,
+                                              const BaseVector<ValueType>& in,
+                                              ValueType                    scalar,
+                                              BaseVector<ValueType>*       out) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ApplyRows(const BaseVector<ValueType>& in,
+                                          const BaseVector<int>&       rows,
+                                          BaseVector<ValueType>*       out) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ApplyAddRows(const BaseVector<ValueType>& in,
+                                             const BaseVector<int>&       rows,
+                                             ValueType                    scalar,
+                                             BaseVector<ValueType>*       out) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ResidualRows(const BaseVector<ValueType>& rhs,
+                                             const BaseVector<ValueType>& x,
+                                             const BaseVector<int>&       rows,
+                                             BaseVector<ValueType>*       res) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::BatchApply(int                          batch,
+                                           const BaseVector<ValueType>& val,
+                                           const BaseVector<ValueType>& in,
+                                           BaseVector<ValueType>*       out) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::BatchExtractInverseDiagonal(int                          batch,
+                                                            const BaseVector<ValueType>& val,
+                                                            BaseVector<ValueType>* inv_diag) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::BatchILU0Factorize(int batch, BaseVector<ValueType>* val) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::BatchBiCGStab(int                          batch,
+                                              const BaseVector<ValueType>& val,
+                                              const BaseVector<ValueType>* inv_diag,
+                                              const BaseVector<ValueType>* lu,
+                                              const BaseVector<ValueType>& rhs,
+                                              BaseVector<ValueType>*       x,
+                                              double                       abs_tol,
+                                              double                       rel_tol,
+                                              int                          max_iter,
+                                              int*                         iter,
+                                              double*                      res) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::BatchGMRES(int                          batch,
+                                           int                          basis,
+                                           const BaseVector<ValueType>& val,
+                                           const BaseVector<ValueType>* inv_diag,
+                                           const BaseVector<ValueType>* lu,
+                                           const BaseVector<ValueType>& rhs,
+                                           BaseVector<ValueType>*       x,
+                                           double                       abs_tol,
+                                           double                       rel_tol,
+                                           int                          max_iter,
+                                           int*                         iter,
+                                           double*                      res) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::Compress(double drop_off)
     {
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::CompressLumped(double drop_off)
+    {
+        return false;
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::Transpose(void)
     {
@@ -1250,6 +1587,12 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::Hash(uint64_t* hash) const
+    {
+        return false;
+    }
+
     template <typename ValueType>
     void BaseMatrix<ValueType>::SetDataPtrCOO(
         int** row, int** col, ValueType** val, int64_t nnz, int nrow, int ncol)
@@ -1292,6 +1635,17 @@ namespace rocalution
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
+    template <typename ValueType>
+    void BaseMatrix<ValueType>::AttachViewCSR(
+        PtrType* row_offset, int* col, ValueType* val, int64_t nnz, int nrow, int ncol)
+    {
+        LOG_INFO("BaseMatrix<ValueType>::AttachViewCSR(...)");
+        LOG_INFO("Matrix format=" << _matrix_format_names[this->GetMatFormat()]);
+        this->Info();
+        LOG_INFO("The function is not implemented (yet)! Check the backend?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
     template <typename ValueType>
     void BaseMatrix<ValueType>::SetDataPtrBCSR(int**       row_offset,
                                                int**       col,
@@ -1419,6 +1773,12 @@ namespace rocalution
         return false;
     }
 
+    template <typename ValueType>
+    bool BaseMatrix<ValueType>::ShareStructureFrom(const BaseMatrix<ValueType>& mat)
+    {
+        return false;
+    }
+
     template <typename ValueType>
     void BaseMatrix<ValueType>::CopyFromAsync(const BaseMatrix<ValueType>& mat)
     {
@@ -1437,6 +1797,12 @@ namespace rocalution
         this->CopyTo(mat);
     }
 
+    template <typename ValueType>
+    void BaseMatrix<ValueType>::Prefetch(void) const
+    {
+        // default is no prefetch
+    }
+
     template <typename ValueType>
     bool BaseMatrix<ValueType>::ReplaceColumnVector(int idx, const BaseVector<ValueType>& vec)
     {
@@ -49,6 +49,10 @@ namespace rocalution
     template <typename ValueType>
     class HostMatrixELL;
     template <typename ValueType>
+    class HostMatrixSELL;
+    template <typename ValueType>
+    class HostMatrixVBR;
+    template <typename ValueType>
     class HostMatrixHYB;
     template <typename ValueType>
     class HostMatrixDENSE;
@@ -70,6 +74,10 @@ namespace rocalution
     template <typename ValueType>
     class HIPAcceleratorMatrixELL;
     template <typename ValueType>
+    class HIPAcceleratorMatrixSELL;
+    template <typename ValueType>
+    class HIPAcceleratorMatrixVBR;
+    template <typename ValueType>
     class HIPAcceleratorMatrixHYB;
     template <typename ValueType>
     class HIPAcceleratorMatrixDENSE;
@@ -98,6 +106,15 @@ namespace rocalution
         virtual void set_backend(const Rocalution_Backend_Descriptor& local_backend);
         /** \brief Perform a sanity check of the matrix */
         virtual bool Check(void) const;
+        /** \brief Set the matrix-vector product algorithm (see SpMVAlg) */
+        virtual void SetSpMVAlg(unsigned int alg);
+        /** \brief Set the value storage of the matrix-vector product (see SpMVStorage) */
+        virtual void SetSpMVStorage(unsigned int storage);
+        /** \brief Set the column index storage of the matrix-vector product (see SpMVIndex) */
+        virtual void SetSpMVIndex(unsigned int index);
+        /** \brief Keep the matrix in host memory and stream it to the device in chunks of
+        * chunk_nnz entries during SpMV, 0 disables streaming */
+        virtual void SetOutOfCore(int64_t chunk_nnz);
 
         /** \brief Allocate CSR Matrix */
         virtual void AllocateCSR(int64_t nnz, int nrow, int ncol);
@@ -128,6 +145,9 @@ namespace rocalution
             PtrType** row_offset, int** col, ValueType** val, int64_t nnz, int nrow, int ncol);
         /** \brief Leave a CSR matrix to Host pointers */
         virtual void LeaveDataPtrCSR(PtrType** row_offset, int** col, ValueType** val);
+        /** \brief Use externally allocated CSR data in place, without taking its ownership */
+        virtual void AttachViewCSR(
+            PtrType* row_offset, int* col, ValueType* val, int64_t nnz, int nrow, int ncol);
 
         /** \brief Initialize a BCSR matrix on the Host with externally allocated data */
         virtual void SetDataPtrBCSR(int**       row_offset,
@@ -168,6 +188,17 @@ namespace rocalution
 
         /** \brief Set all the values to zero */
         virtual bool Zeros(void);
+        /** \brief Update the values in place, the structure remains unchanged. Without
+        * perm, val[offset + i] is the new value of entry i. With perm, val[k] is the new
+        * value of entry perm[k] - offset, entries of perm outside of [offset, offset + nnz)
+        * belong to a different matrix and are skipped */
+        virtual bool UpdateValues(const BaseVector<ValueType>& val,
+                                  const BaseVector<int>*       perm,
+                                  int64_t                      offset);
+        /** \brief Set entry j to the sum of val[perm[k]] for k in [offset[j], offset[j + 1]) */
+        virtual bool AssembleValues(const BaseVector<ValueType>& val,
+                                    const BaseVector<int>&       offset,
+                                    const BaseVector<int>&       perm);
 
         /** \brief Scale all values */
         virtual bool Scale(ValueType alpha);
@@ -188,11 +219,30 @@ namespace rocalution
                                       int                    row_size,
                                       int                    col_size,
                                       BaseMatrix<ValueType>* mat) const;
+        /** \brief Extract all row_num_blocks x col_num_blocks sub-matrices in a single pass,
+        * mat is stored row-major and row/col_offset hold num_blocks + 1 entries */
+        virtual bool ExtractSubMatrices(int                     row_num_blocks,
+                                        int                     col_num_blocks,
+                                        const int*              row_offset,
+                                        const int*              col_offset,
+                                        BaseMatrix<ValueType>** mat) const;
 
         /** \brief Extract the diagonal values of the matrix into a LocalVector */
         virtual bool ExtractDiagonal(BaseVector<ValueType>* vec_diag) const;
         /** \brief Extract the inverse (reciprocal) diagonal values of the matrix into a LocalVector */
         virtual bool ExtractInverseDiagonal(BaseVector<ValueType>* vec_inv_diag) const;
+        /** \brief Extract the inverses of the dense diagonal blocks of size blockdim into a
+      * block diagonal matrix, see LocalMatrix::ExtractInverseBlockDiagonal()
+      */
+        virtual bool ExtractInverseBlockDiagonal(int                    blockdim,
+                                                 BaseMatrix<ValueType>* inv_diag) const;
+        /** \brief Extract the l1 norm (sum of absolute values) of each row into a LocalVector */
+        virtual bool ExtractRowL1Norm(BaseVector<ValueType>* vec_l1) const;
+        /** \brief Flag all rows with an entry in one of the flagged columns */
+        virtual bool ExtractConnectedRows(const BaseVector<bool>& cols,
+                                          BaseVector<bool>*       rows) const;
+        /** \brief Compute the statistics of the matrix, see LocalMatrix::Statistics() */
+        virtual bool Statistics(MatrixStatistics* stats) const;
         /** \brief Extract the upper triangular matrix */
         virtual bool ExtractU(BaseMatrix<ValueType>* U) const;
         /** \brief Extract the upper triangular matrix including diagonal */
@@ -214,6 +264,23 @@ namespace rocalution
         virtual bool RCMK(BaseVector<int>* permutation) const;
         /** \brief Create permutation vector for connectivity reordering of the matrix (increasing nnz per row) */
         virtual bool ConnectivityOrder(BaseVector<int>* permutation) const;
+        /** \brief Partition the graph of the matrix into nparts balanced parts with a small
+        * edge cut
+        */
+        virtual bool GraphPartition(int nparts, BaseVector<int>* partition) const;
+        /** \brief Create permutation vector for approximate minimum degree reordering of
+        * the matrix
+        */
+        virtual bool AMD(BaseVector<int>* permutation) const;
+        /** \brief Create permutation vector for nested dissection reordering of the matrix;
+        * Returns the separator tree in post order (the arrays are allocated in the
+        * function)
+        */
+        virtual bool NestedDissection(int              leaf_size,
+                                      int&             num_nodes,
+                                      int**            node_offset,
+                                      int**            node_parent,
+                                      BaseVector<int>* permutation) const;
 
         /** \brief Perform multi-coloring decomposition of the matrix; Returns number of
         * colors, the corresponding sizes (the array is allocated in the function)
@@ -240,11 +307,17 @@ namespace rocalution
         /** \brief Copy to another matrix */
         virtual void CopyTo(BaseMatrix<ValueType>* mat) const = 0;
 
+        /** \brief Copy the values of another matrix of the same format and backend, sharing
+        * its sparsity pattern; returns false if the format does not support sharing */
+        virtual bool ShareStructureFrom(const BaseMatrix<ValueType>& mat);
+
         /** \brief Async copy from another matrix */
         virtual void CopyFromAsync(const BaseMatrix<ValueType>& mat);
 
         /** \brief Copy to another matrix */
         virtual void CopyToAsync(BaseMatrix<ValueType>* mat) const;
+        /** \brief Migrate the data of the matrix to the device (managed memory mode) */
+        virtual void Prefetch(void) const;
 
         /** \brief Copy from CSR array (the matrix has to be allocated) */
         virtual void CopyFromCSR(const PtrType* row_offsets, const int* col, const ValueType* val);
@@ -286,6 +359,8 @@ namespace rocalution
         virtual bool ReadFileRSIO(const std::string& filename);
         /** \brief Write matrix to rocsparse I/O file */
         virtual bool WriteFileRSIO(const std::string& filename) const;
+        /** \brief Write matrix to compressed rocsparse I/O file */
+        virtual bool WriteFileCompressedRSIO(const std::string& filename) const;
 
         /** \brief Perform symbolic computation (structure only) of |this|^p */
         virtual bool SymbolicPower(int p);
@@ -303,6 +378,22 @@ namespace rocalution
         * this = A*B */
         virtual bool NumericMatMatMult(const BaseMatrix<ValueType>& A,
                                        const BaseMatrix<ValueType>& B);
+        /** \brief Multiply three matrices without storing the intermediate product,
+        * this = R*A*P */
+        virtual bool TripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                      const BaseMatrix<ValueType>& A,
+                                      const BaseMatrix<ValueType>& P);
+        /** \brief Perform numerical triple matrix product (i.e. value computation),
+        * this = R*A*P */
+        virtual bool NumericTripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                             const BaseMatrix<ValueType>& A,
+                                             const BaseMatrix<ValueType>& P);
+        /** \brief Perform numerical triple matrix product for the flagged rows only,
+        * this = R*A*P */
+        virtual bool NumericTripleMatMatMultRows(const BaseMatrix<ValueType>& R,
+                                                 const BaseMatrix<ValueType>& A,
+                                                 const BaseMatrix<ValueType>& P,
+                                                 const BaseVector<bool>&      rows);
         /** \brief Multiply the matrix with diagonal matrix (stored in LocalVector),
         * this=this*diag (right multiplication) */
         virtual bool DiagonalMatrixMultR(const BaseVector<ValueType>& diag);
@@ -316,6 +407,15 @@ namespace rocalution
                                ValueType                    alpha,
                                ValueType                    beta,
                                bool                         structure);
+        /** \brief Compute the sparsity pattern of the matrix sum, this = A + B */
+        virtual bool SymbolicMatrixAdd(const BaseMatrix<ValueType>& A,
+                                       const BaseMatrix<ValueType>& B);
+        /** \brief Compute the values of the matrix sum for the known sparsity pattern of
+        * this, this = alpha*A + beta*B */
+        virtual bool NumericMatrixAdd(const BaseMatrix<ValueType>& A,
+                                      ValueType                    alpha,
+                                      const BaseMatrix<ValueType>& B,
+                                      ValueType                    beta);
 
         /** \brief Perform ILU(0) factorization */
         virtual bool ILU0Factorize(void);
@@ -379,6 +479,16 @@ namespace rocalution
         * graph traversing is performed in parallel */
         virtual bool USolve(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
 
+        /// Number of levels of the dependency graph of the lower or upper triangular part
+        virtual bool TriangularLevels(bool lower, int* levels) const;
+        /// Split a triangular part into the inverses of its diagonal blocks and the
+        /// couplings between the blocks
+        virtual bool TriangularBlockInverse(bool                   lower,
+                                            bool                   diag_unit,
+                                            int                    block_size,
+                                            BaseMatrix<ValueType>* inv,
+                                            BaseMatrix<ValueType>* off) const;
+
         /// Analyse the structure for Iterative solve
         virtual void ItLUAnalyse(void);
         /// Delete the analysed data (see ItLUAnalyse)
@@ -452,11 +562,103 @@ namespace rocalution
         virtual void ApplyAdd(const BaseVector<ValueType>& in,
                               ValueType                    scalar,
                               BaseVector<ValueType>*       out) const = 0;
+        /** \brief Apply the transposed matrix to vector, out = this^T*in; */
+        virtual bool ApplyTranspose(const BaseVector<ValueType>& in,
+                                    BaseVector<ValueType>*       out) const;
+        /** \brief Apply and add the transposed matrix to vector, out = out + scalar*this^T*in; */
+        virtual bool ApplyTransposeAdd(const BaseVector<ValueType>& in,
+                                       ValueType                    scalar,
+                                       BaseVector<ValueType>*       out) const;
+        /** \brief Apply and add the symmetric matrix, of which this stores the upper
+        * triangle and the diagonal, to vector, out = out + scalar*(this + this^T - D)*in;
+        */
+        virtual bool ApplyAddSymmetric(const BaseVector<ValueType>& in,
+                                       ValueType                    scalar,
+                                       BaseVector<ValueType>*       out) const;
+        /** \brief Apply the matrix to a column-major block of ncol vectors, out = this*in; */
+        virtual bool
+            ApplyMulti(int ncol, const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+        /** \brief Apply and add the matrix to a column-major block of ncol vectors,
+        * out = out + scalar*this*in;
+        */
+        virtual bool ApplyAddMulti(int                          ncol,
+                                   const BaseVector<ValueType>& in,
+                                   ValueType                    scalar,
+                                   BaseVector<ValueType>*       out) const;
+        /** \brief Apply the rows listed in rows to vector, out[i] = (this*in)[i]; */
+        virtual bool ApplyRows(const BaseVector<ValueType>& in,
+                               const BaseVector<int>&       rows,
+                               BaseVector<ValueType>*       out) const;
+        /** \brief Apply and add the rows listed in rows to vector,
+        * out[i] = out[i] + scalar*(this*in)[i];
+        */
+        virtual bool ApplyAddRows(const BaseVector<ValueType>& in,
+                                  const BaseVector<int>&       rows,
+                                  ValueType                    scalar,
+                                  BaseVector<ValueType>*       out) const;
+        /** \brief Compute the residual of the rows listed in rows, res[i] = (rhs - this*x)[i]; */
+        virtual bool ResidualRows(const BaseVector<ValueType>& rhs,
+                                  const BaseVector<ValueType>& x,
+                                  const BaseVector<int>&       rows,
+                                  BaseVector<ValueType>*       res) const;
+
+        /** \brief Apply a batch of matrices, that share the sparsity pattern of this, to a
+        * column-major block of batch vectors, out_k = A_k*in_k; the batch*nnz values of all
+        * matrices are stored consecutively in val
+        */
+        virtual bool BatchApply(int                          batch,
+                                const BaseVector<ValueType>& val,
+                                const BaseVector<ValueType>& in,
+                                BaseVector<ValueType>*       out) const;
+        /** \brief Extract the inverse diagonals of a batch of matrices with the sparsity
+        * pattern of this into a column-major block of batch vectors
+        */
+        virtual bool BatchExtractInverseDiagonal(int                          batch,
+                                                 const BaseVector<ValueType>& val,
+                                                 BaseVector<ValueType>*       inv_diag) const;
+        /** \brief In-place ILU(0) factorization of a batch of matrices with the sparsity
+        * pattern of this
+        */
+        virtual bool BatchILU0Factorize(int batch, BaseVector<ValueType>* val) const;
+        /** \brief Solve a batch of systems with the sparsity pattern of this by right
+        * preconditioned BiCGStab; the preconditioner is either Jacobi (inv_diag) or ILU(0)
+        * (lu) or none, if both are NULL; iter and res are host arrays of size batch
+        */
+        virtual bool BatchBiCGStab(int                          batch,
+                                   const BaseVector<ValueType>& val,
+                                   const BaseVector<ValueType>* inv_diag,
+                                   const BaseVector<ValueType>* lu,
+                                   const BaseVector<ValueType>& rhs,
+                                   BaseVector<ValueType>*       x,
+                                   double                       abs_tol,
+                                   double                       rel_tol,
+                                   int                          max_iter,
+                                   int*                         iter,
+                                   double*                      res) const;
+        /** \brief Solve a batch of systems with the sparsity pattern of this by right
+        * preconditioned GMRES(basis), see BatchBiCGStab()
+        */
+        virtual bool BatchGMRES(int                          batch,
+                                int                          basis,
+                                const BaseVector<ValueType>& val,
+                                const BaseVector<ValueType>* inv_diag,
+                                const BaseVector<ValueType>* lu,
+                                const BaseVector<ValueType>& rhs,
+                                BaseVector<ValueType>*       x,
+                                double                       abs_tol,
+                                double                       rel_tol,
+                                int                          max_iter,
+                                int*                         iter,
+                                double*                      res) const;
 
         /** \brief Delete all entries abs(a_ij) <= drop_off;
         * the diagonal elements are never deleted */
         virtual bool Compress(double drop_off);
 
+        /** \brief Delete all off-diagonal entries abs(a_ij) <= drop_off * sqrt(abs(a_ii * a_jj))
+        * and add them to the diagonal, such that the row sums are preserved */
+        virtual bool CompressLumped(double drop_off);
+
         /** \brief Transpose the matrix */
         virtual bool Transpose(void);
         /** \brief Transpose the matrix */
@@ -468,6 +670,9 @@ namespace rocalution
         /** \brief Return key for row, col and val */
         virtual bool Key(long int& row_key, long int& col_key, long int& val_key) const;
 
+        /** \brief Return an order independent hash of sizes, pattern and values */
+        virtual bool Hash(uint64_t* hash) const;
+
         /** \brief Replace a column vector of a matrix */
         virtual bool ReplaceColumnVector(int idx, const BaseVector<ValueType>& vec);
 
@@ -541,6 +746,17 @@ namespace rocalution
                                                  const BaseVector<int64_t>&   l2g,
                                                  BaseVector<bool>*            connections,
                                                  const BaseMatrix<ValueType>& ghost) const;
+        /// Collapse the blockdim x blockdim blocks into a node graph holding their norms
+        virtual bool AMGNodeGraph(int blockdim, BaseMatrix<ValueType>* node) const;
+        /// Expand node connections and aggregates to the dofs of the blocks
+        virtual bool AMGNodeExpand(int                          blockdim,
+                                   const BaseMatrix<ValueType>& node,
+                                   const BaseVector<bool>&      node_connections,
+                                   const BaseVector<int64_t>&   node_aggregates,
+                                   const BaseVector<int64_t>&   node_aggregate_root_nodes,
+                                   BaseVector<bool>*            connections,
+                                   BaseVector<int64_t>*         aggregates,
+                                   BaseVector<int64_t>*         aggregate_root_nodes) const;
 
         virtual bool AMGPMISInitializeState(int64_t                      global_column_begin,
                                             const BaseVector<bool>&      connections,
@@ -592,6 +808,30 @@ namespace rocalution
         virtual bool AMGUnsmoothedAggregation(const BaseVector<int64_t>& aggregates,
                                               BaseMatrix<ValueType>*     prolong) const;
 
+        /// Smoothed aggregation with a near null space, the tentative prolongation of each
+        /// aggregate is the orthonormal factor of the local QR decomposition of the null
+        /// space vectors, the triangular factors form the coarse null space
+        virtual bool
+            AMGSmoothedAggregationNullSpace(ValueType                    relax,
+                                            int                          lumping_strat,
+                                            const BaseVector<bool>&      connections,
+                                            const BaseVector<int64_t>&   aggregates,
+                                            const BaseVector<int64_t>&   aggregate_root_nodes,
+                                            int                          num_null,
+                                            const BaseVector<ValueType>& null_space,
+                                            BaseMatrix<ValueType>*       prolong,
+                                            BaseVector<ValueType>*       coarse_null_space) const;
+
+        /// Truncate the interpolation (this) by dropping entries smaller than trunc_factor
+        /// times the largest entry of the row and keeping at most max_row_nnz entries per
+        /// row, the remaining entries are scaled to preserve the row sums
+        virtual bool AMGProlongTruncate(double trunc_factor, int max_row_nnz);
+        /// Energy minimization of the interpolation on its sparsity pattern, the row sums
+        /// of prolong are kept fixed
+        virtual bool AMGEnergyMinimization(ValueType              relax,
+                                           int                    iterations,
+                                           BaseMatrix<ValueType>* prolong) const;
+
         virtual bool
             AMGSmoothedAggregationProlongNnz(int64_t                      global_column_begin,
                                              int64_t                      global_column_end,
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -66,7 +66,7 @@ namespace rocalution
         log_debug(this, "BaseRocalution::BaseRocalution()");
 
         // copy the backend description
-        this->local_backend_ = *_get_backend_descriptor();
+        _rocalution_init_local_backend(&this->local_backend_);
 
         this->asyncf_ = false;
 
@@ -159,6 +159,20 @@ namespace rocalution
         this->MoveToHost();
     }
 
+    template <typename ValueType>
+    void BaseRocalution<ValueType>::SetExecutionContext(const ExecutionContext& context)
+    {
+        log_debug(this, "BaseRocalution::SetExecutionContext()", (const void*&)context);
+
+        context.Attach(&this->local_backend_);
+    }
+
+    template <typename ValueType>
+    void BaseRocalution<ValueType>::Prefetch(void) const
+    {
+        // default is no prefetch
+    }
+
     template <typename ValueType>
     void BaseRocalution<ValueType>::Sync(void)
     {
@@ -207,6 +221,8 @@ namespace rocalution
         BaseRocalution<float>::CloneBackend(const BaseRocalution<std::complex<double>>& src);
     template void
         BaseRocalution<float>::CloneBackend(const BaseRocalution<std::complex<float>>& src);
+    template void
+        BaseRocalution<double>::CloneBackend(const BaseRocalution<std::complex<double>>& src);
     template void BaseRocalution<std::complex<float>>::CloneBackend(
         const BaseRocalution<std::complex<double>>& src);
     template void BaseRocalution<std::complex<double>>::CloneBackend(
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -95,6 +95,15 @@ namespace rocalution
         /** \brief Sync (the async move) */
         virtual void Sync(void);
 
+        /** \brief Migrate the data of the object to the accelerator ahead of use
+        * \details
+        * In managed memory mode (see set_hip_managed_memory_rocalution()), the data of
+        * accelerator objects is migrated between host and device on demand. \p Prefetch
+        * starts the migration of the data to the device asynchronously. It does nothing
+        * for host objects or without managed memory.
+        */
+        virtual void Prefetch(void) const;
+
         /** \brief Clone the Backend descriptor from another object
       * \details
       * With \p CloneBackend, the backend can be cloned without copying any data. This is
@@ -130,6 +139,19 @@ namespace rocalution
         template <typename ValueType2>
         ROCALUTION_EXPORT void CloneBackend(const BaseRocalution<ValueType2>& src); /**< \private */
 
+        /** \brief Attach the object to an execution context
+      * \details
+      * The accelerator work of the object is queued on the stream of \p context, see
+      * ExecutionContext. Objects that are created with CloneBackend() from this object
+      * are attached to the same context. The context has to outlive the object.
+      * Supported by LocalMatrix and LocalVector.
+      *
+      * @param[in]
+      * context Execution context.
+      */
+        ROCALUTION_EXPORT
+        virtual void SetExecutionContext(const ExecutionContext& context);
+
         /** \brief Print object information
       * \details
       * \p Info can print object information about any rocALUTION object. This
@@ -181,6 +203,9 @@ namespace rocalution
         friend class GlobalMatrix<int>;
         friend class GlobalMatrix<float>;
         friend class GlobalMatrix<double>;
+
+        friend class RocalutionGraph;
+        friend class SolveHandle;
     };
 
 } // namespace rocalution
@@ -39,9 +39,13 @@ namespace rocalution
     template <typename ValueType>
     class HostStencilLaplace2D;
     template <typename ValueType>
+    class HostStencilLaplace3D;
+    template <typename ValueType>
     class HIPAcceleratorStencil;
     template <typename ValueType>
     class HIPAcceleratorStencilLaplace2D;
+    template <typename ValueType>
+    class HIPAcceleratorStencilLaplace3D;
 
     /// Base class for all host/accelerator stencils
     template <typename ValueType>
@@ -89,6 +93,9 @@ namespace rocalution
         friend class HostVector<ValueType>;
         friend class AcceleratorVector<ValueType>;
         friend class HIPAcceleratorVector<ValueType>;
+
+        friend class HIPAcceleratorStencilLaplace2D<ValueType>;
+        friend class HIPAcceleratorStencilLaplace3D<ValueType>;
     };
 
     template <typename ValueType>
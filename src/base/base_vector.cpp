@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -124,6 +124,59 @@ namespace rocalution
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
+    template <typename ValueType>
+    void BaseVector<ValueType>::GetIndexValuesFloat(const BaseVector<int>& index,
+                                                    BaseVector<float>*     values) const
+    {
+        LOG_INFO("BaseVector::GetIndexValuesFloat(const BaseVector<int>& index, "
+                 "BaseVector<float>* values)");
+        this->Info();
+        LOG_INFO("Float casting is not available for this backend");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void BaseVector<ValueType>::BlockPointWiseMult(int64_t                      nrow,
+                                                   int                          ncol,
+                                                   const BaseVector<ValueType>& x)
+    {
+        LOG_INFO("BaseVector::BlockPointWiseMult(int64_t nrow, int ncol, const "
+                 "BaseVector<ValueType>& x)");
+        this->Info();
+        x.Info();
+        LOG_INFO("This function is not available for this backend");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    ValueType BaseVector<ValueType>::DotFloat(const BaseVector<float>& x) const
+    {
+        LOG_INFO("BaseVector::DotFloat(const BaseVector<float>& x)");
+        this->Info();
+        x.Info();
+        LOG_INFO("Float casting is not available for this backend");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void BaseVector<ValueType>::AddScaleFloat(const BaseVector<float>& x, ValueType alpha)
+    {
+        LOG_INFO("BaseVector::AddScaleFloat(const BaseVector<float>& x, ValueType alpha)");
+        this->Info();
+        x.Info();
+        LOG_INFO("Float casting is not available for this backend");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void BaseVector<ValueType>::ScaleCopyToFloat(ValueType alpha, BaseVector<float>* vec)
+    {
+        LOG_INFO("BaseVector::ScaleCopyToFloat(ValueType alpha, BaseVector<float>* vec)");
+        this->Info();
+        LOG_INFO("Float casting is not available for this backend");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
     template <typename ValueType>
     bool BaseVector<ValueType>::Restriction(const BaseVector<ValueType>& vec_fine,
                                             const BaseVector<int>&       map)
@@ -156,6 +209,12 @@ namespace rocalution
         this->CopyTo(vec);
     }
 
+    template <typename ValueType>
+    void BaseVector<ValueType>::Prefetch(void) const
+    {
+        // default is no prefetch
+    }
+
     template <typename ValueType>
     AcceleratorVector<ValueType>::AcceleratorVector()
     {
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -25,6 +25,7 @@
 #define ROCALUTION_BASE_VECTOR_HPP_
 
 #include "backend_manager.hpp"
+#include "vector_expression.hpp"
 
 namespace rocalution
 {
@@ -66,6 +67,10 @@ namespace rocalution
         virtual void SetDataPtr(ValueType** ptr, int64_t size) = 0;
         /** \brief Get a pointer from the vector data and free the vector object */
         virtual void LeaveDataPtr(ValueType** ptr) = 0;
+        /** \brief Use externally allocated data in place, without taking its ownership */
+        virtual void AttachView(ValueType* ptr, int64_t size) = 0;
+        /** \brief Return a pointer to the vector data, the vector keeps the ownership */
+        virtual ValueType* GetDataPtr(void) const = 0;
 
         /** \brief Clear (free) the vector */
         virtual void Clear(void) = 0;
@@ -93,6 +98,8 @@ namespace rocalution
         virtual void CopyTo(BaseVector<ValueType>* vec) const = 0;
         /** \brief Async copy values to another vector */
         virtual void CopyToAsync(BaseVector<ValueType>* vec) const;
+        /** \brief Migrate the data of the vector to the device (managed memory mode) */
+        virtual void Prefetch(void) const;
         /** \brief Copy data (not entire vector) from another vector with specified
         * src/dst offsets and size */
         virtual void CopyFrom(const BaseVector<ValueType>& src,
@@ -151,6 +158,76 @@ namespace rocalution
         virtual ValueType Dot(const BaseVector<ValueType>& x) const = 0;
         /** \brief Compute non-conjugated dot (scalar) product, return this^T y */
         virtual ValueType DotNonConj(const BaseVector<ValueType>& x) const = 0;
+        /** \brief Compute count dot products at once, res[k] = x[k]^T this */
+        virtual void
+            MultiDot(int count, const BaseVector<ValueType>* const* x, ValueType* res) const = 0;
+        /** \brief Perform this = this + sum_k alpha[k] * x[k] in a single pass */
+        virtual void MultiAddScale(int                                 count,
+                                   const BaseVector<ValueType>* const* x,
+                                   const ValueType*                    alpha)
+            = 0;
+        /** \brief Perform vector update of type this = this + alpha*x and return this^H y
+        * in a single pass (y may be this) */
+        virtual ValueType AddScaleDot(const BaseVector<ValueType>& x,
+                                      ValueType                    alpha,
+                                      const BaseVector<ValueType>& y)
+            = 0;
+        /** \brief Compute two dot products in a single pass, res[0] = this^H x and
+        * res[1] = this^H y (x or y may be this) */
+        virtual void DualDot(const BaseVector<ValueType>& x,
+                             const BaseVector<ValueType>& y,
+                             ValueType*                   res) const = 0;
+        /** \brief Compute this^H x (this^T x if conj is false) and store it in res[index]
+        * without synchronizing with the host */
+        virtual void DotToScalar(const BaseVector<ValueType>& x,
+                                 bool                         conj,
+                                 BaseVector<ValueType>*       res,
+                                 int64_t                      index) const = 0;
+        /** \brief Compute the L2 norm of this and store it in res[index] without
+        * synchronizing with the host */
+        virtual void NormToScalar(BaseVector<ValueType>* res, int64_t index) const = 0;
+        /** \brief Perform this = this + factor * s[num] / s[den] * x, where the scalars
+        * s are read from the vector scalars on its backend */
+        virtual void AddScaleRatio(const BaseVector<ValueType>& x,
+                                   ValueType                    factor,
+                                   const BaseVector<ValueType>& scalars,
+                                   int64_t                      num,
+                                   int64_t                      den)
+            = 0;
+        /** \brief Perform this = s[num] / s[den] * this + x, where the scalars s are read
+        * from the vector scalars on its backend */
+        virtual void ScaleRatioAdd(const BaseVector<ValueType>& scalars,
+                                   int64_t                      num,
+                                   int64_t                      den,
+                                   const BaseVector<ValueType>& x)
+            = 0;
+        /** \brief Evaluate the expression program over the vectors vec element-wise into
+        * this (this may be one of vec) */
+        virtual void Evaluate(const VectorExpressionProgram<ValueType>& program,
+                              const BaseVector<ValueType>* const*       vec)
+            = 0;
+        /** \brief Return the sum of the elements of the expression program over vec */
+        virtual ValueType EvaluateSum(const VectorExpressionProgram<ValueType>& program,
+                                      const BaseVector<ValueType>* const*       vec) const = 0;
+        /** \brief Compute the inner products of two column-major blocks with nrow rows,
+        * res = x^H this, where res is a column-major ncol_x x ncol host array */
+        virtual void BlockDot(int64_t                      nrow,
+                              int                          ncol_x,
+                              int                          ncol,
+                              const BaseVector<ValueType>& x,
+                              ValueType*                   res) const = 0;
+        /** \brief Perform this = alpha * this + beta * x * C for column-major blocks with
+        * nrow rows, where C is a column-major ncol_x x ncol host array (x may be this) */
+        virtual void BlockScaleAddProduct(int64_t                      nrow,
+                                          int                          ncol_x,
+                                          int                          ncol,
+                                          ValueType                    alpha,
+                                          const BaseVector<ValueType>& x,
+                                          const ValueType*             C,
+                                          ValueType                    beta) = 0;
+        /** \brief Perform this_ij = x_i * this_ij for a column-major block with nrow rows,
+        * i.e. scale the rows of the block by x */
+        virtual void BlockPointWiseMult(int64_t nrow, int ncol, const BaseVector<ValueType>& x);
         /** \brief Compute L2 norm of the vector, return =  srqt(this^T this) */
         virtual ValueType Norm(void) const = 0;
         /** \brief Reduce vector */
@@ -174,6 +251,19 @@ namespace rocalution
         /** \brief Gets index values */
         virtual void GetIndexValues(const BaseVector<int>& index,
                                     BaseVector<ValueType>* values) const = 0;
+        /** \brief Gets index values, rounded to single precision */
+        virtual void GetIndexValuesFloat(const BaseVector<int>& index,
+                                         BaseVector<float>*     values) const;
+        /** \brief Dot product with a single precision vector */
+        virtual ValueType DotFloat(const BaseVector<float>& x) const;
+        /** \brief Perform vector update of type this = this + alpha * x with a single
+      * precision vector x
+      */
+        virtual void AddScaleFloat(const BaseVector<float>& x, ValueType alpha);
+        /** \brief Perform this = alpha * this and store the result rounded to single
+      * precision in vec
+      */
+        virtual void ScaleCopyToFloat(ValueType alpha, BaseVector<float>* vec);
         /** \brief Sets index values */
         virtual void SetIndexValues(const BaseVector<int>&       index,
                                     const BaseVector<ValueType>& values)
@@ -204,6 +294,7 @@ namespace rocalution
         virtual void SetRandomNormal(unsigned long long seed, ValueType mean, ValueType var) = 0;
 
         virtual void Sort(BaseVector<ValueType>* sorted, BaseVector<int>* perm) const = 0;
+        virtual void Unique(BaseVector<ValueType>* unique) const                        = 0;
 
     protected:
         /** \brief The size of the vector */
@@ -28,6 +28,7 @@
 #include "../utils/math_functions.hpp"
 #include "base_matrix.hpp"
 #include "base_vector.hpp"
+#include "host/host_io.hpp"
 #include "global_vector.hpp"
 #include "local_matrix.hpp"
 #include "local_vector.hpp"
@@ -41,9 +42,37 @@
 #include <complex>
 #include <limits>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 namespace rocalution
 {
+    // Sort and deduplicate global ghost column ids on the backend of the vector, only the
+    // distinct ids are transferred to the host. Returns the number of distinct ids.
+    static int64_t unique_ghost_columns(const LocalVector<int64_t>& ghost_col, int64_t** host_col)
+    {
+        LocalVector<int64_t> sorted_col;
+        LocalVector<int64_t> unique_col;
+
+        sorted_col.CloneBackend(ghost_col);
+        unique_col.CloneBackend(ghost_col);
+
+        sorted_col.Allocate("sorted global ghost columns", ghost_col.GetSize());
+
+        // Sort the global ghost columns (we do not need the permutation vector)
+        ghost_col.Sort(&sorted_col, NULL);
+        sorted_col.Unique(&unique_col);
+        sorted_col.Clear();
+
+        int64_t size = unique_col.GetSize();
+
+        // Get the distinct ghost columns on host
+        unique_col.MoveToHost();
+        unique_col.LeaveDataPtr(host_col);
+
+        return size;
+    }
+
     template <typename ValueType>
     GlobalMatrix<ValueType>::GlobalMatrix()
     {
@@ -63,6 +92,14 @@ namespace rocalution
 
         this->recv_boundary_ = NULL;
         this->send_boundary_ = NULL;
+
+        this->halo_slice_ = NULL;
+
+        this->halo_float_          = false;
+        this->recv_boundary_float_ = NULL;
+        this->send_boundary_float_ = NULL;
+
+        this->mult_ = NULL;
     }
 
     template <typename ValueType>
@@ -80,6 +117,14 @@ namespace rocalution
 
         this->recv_boundary_ = NULL;
         this->send_boundary_ = NULL;
+
+        this->halo_slice_ = NULL;
+
+        this->halo_float_          = false;
+        this->recv_boundary_float_ = NULL;
+        this->send_boundary_float_ = NULL;
+
+        this->mult_ = NULL;
     }
 
     template <typename ValueType>
@@ -110,11 +155,27 @@ namespace rocalution
         this->halo_.Clear();
         this->recv_buffer_.Clear();
         this->send_buffer_.Clear();
+        this->recv_buffer_float_.Clear();
+        this->send_buffer_float_.Clear();
 
         this->nnz_ = 0;
 
+        // Cached persistent requests must not outlive the boundary buffers
+        if(this->pm_ != NULL)
+        {
+            this->pm_->FreePersistent_(this->send_boundary_, this->recv_boundary_);
+            this->pm_->FreePersistent_(this->send_boundary_float_, this->recv_boundary_float_);
+        }
+
         free_pinned(&this->recv_boundary_);
         free_pinned(&this->send_boundary_);
+        free_pinned(&this->recv_boundary_float_);
+        free_pinned(&this->send_boundary_float_);
+
+        free_host(&this->halo_slice_);
+
+        delete this->mult_;
+        this->mult_ = NULL;
     }
 
     template <typename ValueType>
@@ -222,6 +283,11 @@ namespace rocalution
 
         assert(pm.Status() == true);
 
+        if(this->pm_ != NULL)
+        {
+            this->pm_->FreePersistent_(this->send_boundary_, this->recv_boundary_);
+        }
+
         this->pm_ = &pm;
         this->InitCommPattern_();
     }
@@ -735,6 +801,21 @@ namespace rocalution
         this->nnz_ = 0;
     }
 
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::UpdateValuesCSR(const LocalVector<ValueType>& val,
+                                                  const LocalVector<int>*       perm)
+    {
+        log_debug(this, "GlobalMatrix::UpdateValuesCSR()", (const void*&)val, perm);
+
+        assert(this->GetFormat() == CSR);
+        assert(val.GetSize() == this->GetLocalNnz() + this->GetGhostNnz());
+        assert(perm == NULL || perm->GetSize() == val.GetSize());
+
+        // Interior entries are numbered first, ghost entries follow
+        this->matrix_interior_.UpdateValues_(val, perm, 0);
+        this->matrix_ghost_.UpdateValues_(val, perm, this->GetLocalNnz());
+    }
+
     template <typename ValueType>
     void GlobalMatrix<ValueType>::MoveToAccelerator(void)
     {
@@ -745,6 +826,15 @@ namespace rocalution
         this->halo_.MoveToAccelerator();
         this->recv_buffer_.MoveToAccelerator();
         this->send_buffer_.MoveToAccelerator();
+        this->recv_buffer_float_.MoveToAccelerator();
+        this->send_buffer_float_.MoveToAccelerator();
+
+        if(this->mult_ != NULL)
+        {
+            this->mult_->ext_col.MoveToAccelerator();
+            this->mult_->gst_ext_local.MoveToAccelerator();
+            this->mult_->product.MoveToAccelerator();
+        }
     }
 
     template <typename ValueType>
@@ -757,6 +847,27 @@ namespace rocalution
         this->halo_.MoveToHost();
         this->recv_buffer_.MoveToHost();
         this->send_buffer_.MoveToHost();
+        this->recv_buffer_float_.MoveToHost();
+        this->send_buffer_float_.MoveToHost();
+
+        if(this->mult_ != NULL)
+        {
+            this->mult_->ext_col.MoveToHost();
+            this->mult_->gst_ext_local.MoveToHost();
+            this->mult_->product.MoveToHost();
+        }
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::Prefetch(void) const
+    {
+        log_debug(this, "GlobalMatrix::Prefetch()");
+
+        this->matrix_interior_.Prefetch();
+        this->matrix_ghost_.Prefetch();
+        this->halo_.Prefetch();
+        this->recv_buffer_.Prefetch();
+        this->send_buffer_.Prefetch();
     }
 
     template <typename ValueType>
@@ -817,6 +928,18 @@ namespace rocalution
                  << " current=" << current_backend_name);
     }
 
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::CommunicationInfo(void) const
+    {
+        log_debug(this, "GlobalMatrix::CommunicationInfo()");
+
+        if(this->pm_ != NULL)
+        {
+            LOG_INFO("GlobalMatrix name=" << this->object_name_ << ";");
+            this->pm_->CommunicationInfo(sizeof(ValueType));
+        }
+    }
+
     template <typename ValueType>
     bool GlobalMatrix<ValueType>::Check(void) const
     {
@@ -862,1304 +985,4064 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void GlobalMatrix<ValueType>::ConvertToCSR(void)
+    void GlobalMatrix<ValueType>::Gather(LocalMatrix<ValueType>* mat) const
     {
-        this->ConvertTo(CSR);
-    }
+        log_debug(this, "GlobalMatrix::Gather()", mat);
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ConvertToMCSR(void)
-    {
-        this->ConvertTo(MCSR);
-    }
+        assert(mat != NULL);
+        assert(mat != &this->matrix_interior_);
+        assert(this->pm_ != NULL);
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ConvertToBCSR(int blockdim)
-    {
-        this->ConvertTo(BCSR, blockdim);
-    }
+        mat->Clear();
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ConvertToCOO(void)
-    {
-        this->ConvertTo(COO);
-    }
+        // Calling local routine with single process
+        if(this->pm_->num_procs_ == 1)
+        {
+            mat->CloneFrom(this->matrix_interior_);
+            mat->ConvertToCSR();
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ConvertToELL(void)
-    {
-        this->ConvertTo(ELL);
-    }
+            return;
+        }
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ConvertToDIA(void)
-    {
-        this->ConvertTo(DIA);
-    }
+#ifdef SUPPORT_MULTINODE
+        // The gathered matrix uses 32 bit column indices
+        assert(this->pm_->GetGlobalNcol() <= std::numeric_limits<int>::max());
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ConvertToHYB(void)
-    {
-        this->ConvertTo(HYB);
-    }
+        int     num_procs = this->pm_->num_procs_;
+        int64_t nrow      = this->pm_->GetGlobalNrow();
+        int64_t ncol      = this->pm_->GetGlobalNcol();
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ConvertToDENSE(void)
-    {
-        this->ConvertTo(DENSE);
-    }
+        // Local rows with global column indices, sorted by column
+        std::vector<int64_t>   local_row_offset;
+        std::vector<int64_t>   col_ind;
+        std::vector<ValueType> val;
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ConvertTo(unsigned int matrix_format, int blockdim)
-    {
-        log_debug(this, "GlobalMatrix::ConverTo()", matrix_format, blockdim);
+        this->MergeLocalRows_(&local_row_offset, &col_ind, &val);
 
-        this->matrix_interior_.ConvertTo(matrix_format, blockdim);
+        int64_t local_nrow = this->pm_->GetLocalNrow();
+        int64_t local_nnz  = local_row_offset[local_nrow];
 
-        // Ghost part remains COO
-        this->matrix_ghost_.ConvertTo(COO);
-    }
+        std::vector<int> row_nnz(local_nrow);
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::Apply(const GlobalVector<ValueType>& in,
-                                        GlobalVector<ValueType>*       out) const
-    {
-        log_debug(this, "GlobalMatrix::Apply()", (const void*&)in, out);
+        for(int64_t i = 0; i < local_nrow; ++i)
+        {
+            row_nnz[i] = static_cast<int>(local_row_offset[i + 1] - local_row_offset[i]);
+        }
 
-        assert(out != NULL);
-        assert(&in != out);
+        // Gather the number of non-zeros of each process
+        int              send_nnz = static_cast<int>(local_nnz);
+        std::vector<int> nnz_count(num_procs);
+        std::vector<int> nnz_offset(num_procs);
 
-        // Calling global routine with single process
-        if(this->pm_ == NULL)
-        {
-            // no PM, do interior apply
-            this->matrix_interior_.Apply(in.vector_interior_, &out->vector_interior_);
+        communication_sync_allgather_single(&send_nnz, nnz_count.data(), this->pm_->comm_);
 
-            return;
+        int64_t nnz = 0;
+        for(int n = 0; n < num_procs; ++n)
+        {
+            nnz_offset[n] = static_cast<int>(nnz);
+            nnz += nnz_count[n];
         }
 
-        assert(this->GetM() == out->GetSize());
-        assert(this->GetN() == in.GetSize());
-        assert(this->is_host_() == in.is_host_());
-        assert(this->is_host_() == out->is_host_());
-        assert(this->is_host_() == this->halo_.is_host_());
-        assert(this->is_host_() == this->recv_buffer_.is_host_());
-        assert(this->is_host_() == this->send_buffer_.is_host_());
-
-        // Prepare send buffer
-        in.vector_interior_.GetIndexValues(this->halo_, &this->send_buffer_);
+        assert(nnz <= std::numeric_limits<int>::max());
 
-        // Change to compute mode ghost
-        _rocalution_compute_ghost();
+        // Rows are distributed contiguously in rank order
+        std::vector<int> row_count(num_procs);
+        std::vector<int> row_offset(num_procs);
 
-        // Make send buffer available for communication
-        ValueType* send_buffer = NULL;
-        if(this->is_host_() == true)
+        for(int n = 0; n < num_procs; ++n)
         {
-            // On host, we can directly use the host pointer
-            this->send_buffer_.LeaveDataPtr(&send_buffer);
+            row_offset[n] = static_cast<int>(this->pm_->GetGlobalRowBegin(n));
+            row_count[n]  = static_cast<int>(this->pm_->GetGlobalRowEnd(n) - row_offset[n]);
         }
-        else
+
+        std::vector<int>     recv_row_nnz(nrow);
+        std::vector<int64_t> recv_col_ind(nnz);
+
+        communication_sync_allgatherv(row_nnz.data(),
+                                      static_cast<int>(local_nrow),
+                                      recv_row_nnz.data(),
+                                      row_count.data(),
+                                      row_offset.data(),
+                                      this->pm_->comm_);
+
+        communication_sync_allgatherv(col_ind.data(),
+                                      send_nnz,
+                                      recv_col_ind.data(),
+                                      nnz_count.data(),
+                                      nnz_offset.data(),
+                                      this->pm_->comm_);
+
+        PtrType*   csr_row_ptr = NULL;
+        int*       csr_col_ind = NULL;
+        ValueType* csr_val     = NULL;
+
+        allocate_host(nrow + 1, &csr_row_ptr);
+        allocate_host(nnz, &csr_col_ind);
+        allocate_host(nnz, &csr_val);
+
+        communication_sync_allgatherv(val.data(),
+                                      send_nnz,
+                                      csr_val,
+                                      nnz_count.data(),
+                                      nnz_offset.data(),
+                                      this->pm_->comm_);
+
+        csr_row_ptr[0] = 0;
+        for(int64_t i = 0; i < nrow; ++i)
         {
-            // On the accelerator, we need to (asynchronously) make the data
-            // available on the host
-            this->send_buffer_.GetContinuousValues(
-                0, this->pm_->GetNumSenders(), this->send_boundary_);
+            csr_row_ptr[i + 1] = csr_row_ptr[i] + recv_row_nnz[i];
+        }
 
-            send_buffer = this->send_boundary_;
+        for(int64_t j = 0; j < nnz; ++j)
+        {
+            csr_col_ind[j] = static_cast<int>(recv_col_ind[j]);
         }
 
-        // Change to compute mode interior
-        _rocalution_compute_interior();
+        mat->SetDataPtrCSR(&csr_row_ptr,
+                           &csr_col_ind,
+                           &csr_val,
+                           "gathered " + this->object_name_,
+                           nnz,
+                           nrow,
+                           ncol);
+        mat->CloneBackend(*this);
+#endif
+    }
 
-        // Interior
-        this->matrix_interior_.Apply(in.vector_interior_, &out->vector_interior_);
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::MergeLocalRows_(std::vector<int64_t>*   row_offset,
+                                                  std::vector<int64_t>*   col,
+                                                  std::vector<ValueType>* val) const
+    {
+        assert(row_offset != NULL);
+        assert(col != NULL);
+        assert(val != NULL);
 
-        // Synchronize compute mode ghost
-        _rocalution_sync_ghost();
+        // Local rows in CSR format on the host
+        LocalMatrix<ValueType> interior;
+        LocalMatrix<ValueType> ghost;
 
-        // Initiate communication
-        this->pm_->CommunicateAsync_(send_buffer, this->recv_boundary_);
+        interior.CloneFrom(this->matrix_interior_);
+        interior.MoveToHost();
+        interior.ConvertToCSR();
 
-        // Sync communication
-        this->pm_->CommunicateSync_();
+        PtrType*   int_row_ptr = NULL;
+        int*       int_col_ind = NULL;
+        ValueType* int_val     = NULL;
 
-        if(this->is_host_() == true)
+        PtrType*   gst_row_ptr = NULL;
+        int*       gst_col_ind = NULL;
+        ValueType* gst_val     = NULL;
+
+        int64_t local_nrow = interior.GetM();
+        int64_t local_nnz  = interior.GetNnz() + this->matrix_ghost_.GetNnz();
+
+        interior.LeaveDataPtrCSR(&int_row_ptr, &int_col_ind, &int_val);
+
+        if(this->matrix_ghost_.GetNnz() > 0)
         {
-            // On host, we need to set back the pointer into its structure
-            this->send_buffer_.SetDataPtr(&send_buffer, "send buffer", this->pm_->GetNumSenders());
+            ghost.CloneFrom(this->matrix_ghost_);
+            ghost.MoveToHost();
+            ghost.ConvertToCSR();
+            ghost.LeaveDataPtrCSR(&gst_row_ptr, &gst_col_ind, &gst_val);
         }
 
-        // Change to compute mode ghost
-        _rocalution_compute_ghost();
+        // Merge interior and ghost part, using global column indices, rows are sorted
+        int64_t        col_begin = this->pm_->GetGlobalColumnBegin();
+        const int64_t* ghost_map = this->pm_->GetGhostToGlobalMap();
 
-        // Process receive buffer
-        this->recv_buffer_.SetContinuousValues(
-            0, this->pm_->GetNumReceivers(), this->recv_boundary_);
+        row_offset->resize(local_nrow + 1);
+        col->resize(local_nnz);
+        val->resize(local_nnz);
 
-        // Change to compute mode default
-        _rocalution_compute_default();
+        std::vector<std::pair<int64_t, ValueType>> row;
 
-        // Ghost
-        this->matrix_ghost_.ApplyAdd(
-            this->recv_buffer_, static_cast<ValueType>(1), &out->vector_interior_);
-    }
+        int64_t idx = 0;
+        for(int64_t i = 0; i < local_nrow; ++i)
+        {
+            row.clear();
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ApplyAdd(const GlobalVector<ValueType>& in,
-                                           ValueType                      scalar,
-                                           GlobalVector<ValueType>*       out) const
-    {
-        log_debug(this, "GlobalMatrix::ApplyAdd()", (const void*&)in, scalar, out);
+            for(PtrType j = int_row_ptr[i]; j < int_row_ptr[i + 1]; ++j)
+            {
+                row.push_back(std::make_pair(col_begin + int_col_ind[j], int_val[j]));
+            }
 
-        assert(out != NULL);
-        assert(&in != out);
+            if(gst_row_ptr != NULL)
+            {
+                for(PtrType j = gst_row_ptr[i]; j < gst_row_ptr[i + 1]; ++j)
+                {
+                    row.push_back(std::make_pair(ghost_map[gst_col_ind[j]], gst_val[j]));
+                }
+            }
 
-        assert(this->GetM() == out->GetSize());
-        assert(this->GetN() == in.GetSize());
-        assert(this->is_host_() == in.is_host_());
-        assert(this->is_host_() == out->is_host_());
+            std::sort(row.begin(),
+                      row.end(),
+                      [](const std::pair<int64_t, ValueType>& a,
+                         const std::pair<int64_t, ValueType>& b) { return a.first < b.first; });
 
-        FATAL_ERROR(__FILE__, __LINE__);
-    }
+            (*row_offset)[i] = idx;
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::Transpose(void)
-    {
-        log_debug(this, "GlobalMatrix::Transpose()");
+            for(size_t j = 0; j < row.size(); ++j)
+            {
+                (*col)[idx] = row[j].first;
+                (*val)[idx] = row[j].second;
+                ++idx;
+            }
+        }
 
-        FATAL_ERROR(__FILE__, __LINE__);
+        (*row_offset)[local_nrow] = idx;
+
+        free_host(&int_row_ptr);
+        free_host(&int_col_ind);
+        free_host(&int_val);
+
+        if(gst_row_ptr != NULL)
+        {
+            free_host(&gst_row_ptr);
+            free_host(&gst_col_ind);
+            free_host(&gst_val);
+        }
     }
 
     template <typename ValueType>
-    void GlobalMatrix<ValueType>::Transpose(GlobalMatrix<ValueType>* T) const
+    void GlobalMatrix<ValueType>::ExtractOverlapMatrix(LocalMatrix<ValueType>* mat) const
     {
-        log_debug(this, "GlobalMatrix::Transpose()", T);
+        log_debug(this, "GlobalMatrix::ExtractOverlapMatrix()", mat);
 
-        assert(T != NULL);
-        assert(T != this);
-        assert(this->is_host_() == T->is_host_());
+        assert(mat != NULL);
+        assert(mat != &this->matrix_interior_);
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+        mat->Clear();
 
-        // Calling global routine with single process
+        // Calling local routine with single process
         if(this->pm_ == NULL || this->pm_->num_procs_ == 1)
         {
-            this->matrix_interior_.Transpose(&T->matrix_interior_);
+            mat->CloneFrom(this->matrix_interior_);
+            mat->ConvertToCSR();
 
-            T->CreateParallelManager_();
+            return;
+        }
 
-            T->pm_self_->SetMPICommunicator(this->pm_->comm_);
+        int64_t local_nrow = this->matrix_interior_.GetM();
 
-            T->pm_self_->SetGlobalNrow(T->matrix_interior_.GetM());
-            T->pm_self_->SetGlobalNcol(T->matrix_interior_.GetN());
+        int nsend = this->pm_->GetNumSenders();
+        int nrecv = this->pm_->GetNumReceivers();
 
-            T->pm_self_->SetLocalNrow(T->matrix_interior_.GetM());
-            T->pm_self_->SetLocalNcol(T->matrix_interior_.GetN());
+        // Local rows in CSR format on the host
+        LocalMatrix<ValueType> interior;
+        LocalMatrix<ValueType> ghost;
 
-            return;
-        }
+        interior.CloneFrom(this->matrix_interior_);
+        interior.MoveToHost();
+        interior.ConvertToCSR();
 
-        if(this->GetNnz() > 0)
-        {
-            // Some dummy structures
-            LocalVector<int64_t> global_zero;
-            global_zero.CloneBackend(*this);
+        PtrType*   int_row_ptr = NULL;
+        int*       int_col_ind = NULL;
+        ValueType* int_val     = NULL;
 
-            // Transpose local matrices
-            LocalMatrix<ValueType> T_ext;
-            T_ext.CloneBackend(*this);
+        PtrType*   gst_row_ptr = NULL;
+        int*       gst_col_ind = NULL;
+        ValueType* gst_val     = NULL;
 
-            // Transpose ghost part into T ext
-            this->matrix_ghost_.Transpose(&T_ext);
+        interior.LeaveDataPtrCSR(&int_row_ptr, &int_col_ind, &int_val);
 
-            // Generate T ghost and parallel manager of T
+        if(this->matrix_ghost_.GetNnz() > 0)
+        {
+            ghost.CloneFrom(this->matrix_ghost_);
+            ghost.MoveToHost();
+            ghost.ConvertToCSR();
+            ghost.LeaveDataPtrCSR(&gst_row_ptr, &gst_col_ind, &gst_val);
+        }
 
-            // T_ext and T ghost MUST be CSR
-            assert(T_ext.GetFormat() == CSR);
-            assert(T->matrix_ghost_.GetFormat() == CSR);
+        // Boundary rows, that are requested by our neighbors
+        LocalVector<int> halo;
+        halo.CloneFrom(this->halo_);
+        halo.MoveToHost();
 
-            // Now we need to extract rows that do not belong to us and thus
-            // need to be sent to neighboring processes
-            int64_t nrows_send = T_ext.GetM();
-            int     nrows_recv = this->pm_->GetNumSenders();
+        int* bnd = NULL;
+        halo.LeaveDataPtr(&bnd);
 
-            // Extract row nnz for the rows that we have to send to neighbors
-            LocalVector<PtrType> T_ext_row_ptr_send;
-            T_ext_row_ptr_send.CloneBackend(*this);
-            T_ext_row_ptr_send.Allocate("row nnz send", nrows_send);
+        int64_t        col_begin = this->pm_->GetGlobalColumnBegin();
+        int64_t        col_end   = this->pm_->GetGlobalColumnEnd();
+        const int64_t* ghost_map = this->pm_->GetGhostToGlobalMap();
 
-            // send number of nonzeros that will be in the ghost restriction rows
-            T_ext.matrix_->ExtractExtRowNnz(0, T_ext_row_ptr_send.vector_);
+        // Number of non-zeros of each boundary row, including the ghost part
+        int* send_row_nnz = NULL;
+        int* recv_row_nnz = NULL;
+        allocate_host(nsend, &send_row_nnz);
+        allocate_host(nrecv, &recv_row_nnz);
 
-            // Prepare send / receive buffers
-            PtrType* pT_ext_row_nnz_send = NULL;
-            PtrType* pT_ext_row_ptr_recv = NULL;
+        for(int i = 0; i < nsend; ++i)
+        {
+            int row = bnd[i];
 
-            LocalVector<PtrType> T_ext_row_ptr_recv;
-#ifdef SUPPORT_RDMA
+            send_row_nnz[i] = static_cast<int>(int_row_ptr[row + 1] - int_row_ptr[row]);
+
+            if(gst_row_ptr != NULL)
+            {
+                send_row_nnz[i] += static_cast<int>(gst_row_ptr[row + 1] - gst_row_ptr[row]);
+            }
+        }
+
+        // Initiate communication of nnz per row
+        this->pm_->CommunicateAsync_(send_row_nnz, recv_row_nnz);
+
+        // Extract the boundary rows with global column indices
+        PtrType* send_row_ptr = NULL;
+        allocate_host(nsend + 1, &send_row_ptr);
+
+        send_row_ptr[0] = 0;
+        for(int i = 0; i < nsend; ++i)
+        {
+            send_row_ptr[i + 1] = send_row_ptr[i] + send_row_nnz[i];
+        }
+
+        int64_t*   send_col_ind = NULL;
+        ValueType* send_val     = NULL;
+        allocate_host(send_row_ptr[nsend], &send_col_ind);
+        allocate_host(send_row_ptr[nsend], &send_val);
+
+        for(int i = 0; i < nsend; ++i)
+        {
+            int     row = bnd[i];
+            PtrType idx = send_row_ptr[i];
+
+            for(PtrType j = int_row_ptr[row]; j < int_row_ptr[row + 1]; ++j)
+            {
+                send_col_ind[idx] = col_begin + int_col_ind[j];
+                send_val[idx]     = int_val[j];
+                ++idx;
+            }
+
+            if(gst_row_ptr != NULL)
+            {
+                for(PtrType j = gst_row_ptr[row]; j < gst_row_ptr[row + 1]; ++j)
+                {
+                    send_col_ind[idx] = ghost_map[gst_col_ind[j]];
+                    send_val[idx]     = gst_val[j];
+                    ++idx;
+                }
+            }
+        }
+
+        // Wait for nnz per row communication to finish
+        this->pm_->CommunicateSync_();
+
+        PtrType* recv_row_ptr = NULL;
+        allocate_host(nrecv + 1, &recv_row_ptr);
+
+        recv_row_ptr[0] = 0;
+        for(int i = 0; i < nrecv; ++i)
+        {
+            recv_row_ptr[i + 1] = recv_row_ptr[i] + recv_row_nnz[i];
+        }
+
+        int64_t*   recv_col_ind = NULL;
+        ValueType* recv_val     = NULL;
+        allocate_host(recv_row_ptr[nrecv], &recv_col_ind);
+        allocate_host(recv_row_ptr[nrecv], &recv_val);
+
+        // Communicate column indices and values, the received rows are ordered
+        // like the ghost columns
+        this->pm_->CommunicateCSRAsync_(
+            send_row_ptr, send_col_ind, send_val, recv_row_ptr, recv_col_ind, recv_val);
+        this->pm_->CommunicateCSRSync_();
+
+        free_host(&bnd);
+        free_host(&send_row_nnz);
+        free_host(&recv_row_nnz);
+        free_host(&send_row_ptr);
+        free_host(&send_col_ind);
+        free_host(&send_val);
+
+        // Global to local map of the ghost columns, these are numbered after the
+        // local columns in the overlapping matrix
+        std::vector<std::pair<int64_t, int>> ghost_index(nrecv);
+        for(int i = 0; i < nrecv; ++i)
+        {
+            ghost_index[i] = std::make_pair(ghost_map[i], static_cast<int>(local_nrow) + i);
+        }
+
+        std::sort(ghost_index.begin(), ghost_index.end());
+
+        // Assemble the overlapping matrix, columns that are not part of the
+        // overlapping subdomain are dropped
+        int64_t nrow = local_nrow + nrecv;
+
+        PtrType* csr_row_ptr = NULL;
+        allocate_host(nrow + 1, &csr_row_ptr);
+
+        std::vector<int>       col_ind;
+        std::vector<ValueType> val;
+        col_ind.reserve(int_row_ptr[local_nrow] + recv_row_ptr[nrecv]);
+        val.reserve(int_row_ptr[local_nrow] + recv_row_ptr[nrecv]);
+
+        std::vector<std::pair<int, ValueType>> row;
+
+        csr_row_ptr[0] = 0;
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            row.clear();
+
+            if(i < local_nrow)
+            {
+                for(PtrType j = int_row_ptr[i]; j < int_row_ptr[i + 1]; ++j)
+                {
+                    row.push_back(std::make_pair(int_col_ind[j], int_val[j]));
+                }
+
+                if(gst_row_ptr != NULL)
+                {
+                    for(PtrType j = gst_row_ptr[i]; j < gst_row_ptr[i + 1]; ++j)
+                    {
+                        row.push_back(std::make_pair(
+                            static_cast<int>(local_nrow) + gst_col_ind[j], gst_val[j]));
+                    }
+                }
+            }
+            else
+            {
+                int64_t k = i - local_nrow;
+
+                for(PtrType j = recv_row_ptr[k]; j < recv_row_ptr[k + 1]; ++j)
+                {
+                    int64_t col = recv_col_ind[j];
+
+                    if(col >= col_begin && col < col_end)
+                    {
+                        row.push_back(
+                            std::make_pair(static_cast<int>(col - col_begin), recv_val[j]));
+                        continue;
+                    }
+
+                    auto it = std::lower_bound(ghost_index.begin(),
+                                               ghost_index.end(),
+                                               std::make_pair(col, 0));
+
+                    if(it != ghost_index.end() && it->first == col)
+                    {
+                        row.push_back(std::make_pair(it->second, recv_val[j]));
+                    }
+                }
+            }
+
+            std::sort(row.begin(),
+                      row.end(),
+                      [](const std::pair<int, ValueType>& a, const std::pair<int, ValueType>& b)
+                      { return a.first < b.first; });
+
+            for(size_t j = 0; j < row.size(); ++j)
+            {
+                col_ind.push_back(row[j].first);
+                val.push_back(row[j].second);
+            }
+
+            csr_row_ptr[i + 1] = static_cast<PtrType>(col_ind.size());
+        }
+
+        free_host(&int_row_ptr);
+        free_host(&int_col_ind);
+        free_host(&int_val);
+
+        if(gst_row_ptr != NULL)
+        {
+            free_host(&gst_row_ptr);
+            free_host(&gst_col_ind);
+            free_host(&gst_val);
+        }
+
+        free_host(&recv_row_ptr);
+        free_host(&recv_col_ind);
+        free_host(&recv_val);
+
+        int64_t nnz = csr_row_ptr[nrow];
+
+        int*       csr_col_ind = NULL;
+        ValueType* csr_val     = NULL;
+        allocate_host(nnz, &csr_col_ind);
+        allocate_host(nnz, &csr_val);
+
+        copy_h2h(nnz, col_ind.data(), csr_col_ind);
+        copy_h2h(nnz, val.data(), csr_val);
+
+        mat->SetDataPtrCSR(&csr_row_ptr,
+                           &csr_col_ind,
+                           &csr_val,
+                           "overlap of " + this->object_name_,
+                           nnz,
+                           nrow,
+                           nrow);
+        mat->CloneBackend(*this);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::GetGhostValues(const GlobalVector<ValueType>& in,
+                                                 LocalVector<ValueType>*        ghost) const
+    {
+        log_debug(this, "GlobalMatrix::GetGhostValues()", (const void*&)in, ghost);
+
+        assert(ghost != NULL);
+
+        int nrecv = (this->pm_ == NULL) ? 0 : this->pm_->GetNumReceivers();
+
+        ghost->Clear();
+        ghost->CloneBackend(*this);
+        ghost->Allocate("ghost values", nrecv);
+
+        // Calling local routine with single process
+        if(this->pm_ == NULL || this->pm_->num_procs_ == 1)
+        {
+            return;
+        }
+
+        int nsend = this->pm_->GetNumSenders();
+
+        // Pack the boundary values, requested by our neighbors
+        LocalVector<ValueType> send;
+        send.CloneBackend(*this);
+        send.Allocate("send buffer", nsend);
+
+        in.vector_interior_.GetIndexValues(this->halo_, &send);
+
+        ValueType* send_buffer = NULL;
+        ValueType* recv_buffer = NULL;
+        allocate_host(nsend, &send_buffer);
+        allocate_host(nrecv, &recv_buffer);
+
+        if(nsend > 0)
+        {
+            send.CopyToHostData(send_buffer);
+        }
+
+        this->pm_->CommunicateAsync_(send_buffer, recv_buffer);
+        this->pm_->CommunicateSync_();
+
+        if(nrecv > 0)
+        {
+            ghost->CopyFromHostData(recv_buffer);
+        }
+
+        free_host(&send_buffer);
+        free_host(&recv_buffer);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToCSR(void)
+    {
+        this->ConvertTo(CSR);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToMCSR(void)
+    {
+        this->ConvertTo(MCSR);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToBCSR(int blockdim)
+    {
+        this->ConvertTo(BCSR, blockdim);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToCOO(void)
+    {
+        this->ConvertTo(COO);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToELL(void)
+    {
+        this->ConvertTo(ELL);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToDIA(void)
+    {
+        this->ConvertTo(DIA);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToHYB(void)
+    {
+        this->ConvertTo(HYB);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToDENSE(void)
+    {
+        this->ConvertTo(DENSE);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToSELL(void)
+    {
+        this->ConvertTo(SELL);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToVBR(void)
+    {
+        this->ConvertTo(VBR);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertTo(unsigned int matrix_format, int blockdim)
+    {
+        log_debug(this, "GlobalMatrix::ConverTo()", matrix_format, blockdim);
+
+        this->matrix_interior_.ConvertTo(matrix_format, blockdim);
+
+        // Ghost part remains COO
+        this->matrix_ghost_.ConvertTo(COO);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ConvertToBest(int trials)
+    {
+        log_debug(this, "GlobalMatrix::ConvertToBest()", trials);
+
+        this->matrix_interior_.ConvertToBest(trials);
+
+        // Ghost part remains COO
+        this->matrix_ghost_.ConvertTo(COO);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::SetSpMVAlg(SpMVAlg alg)
+    {
+        log_debug(this, "GlobalMatrix::SetSpMVAlg()", alg);
+
+        this->matrix_interior_.SetSpMVAlg(alg);
+        this->matrix_ghost_.SetSpMVAlg(alg);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::SetSpMVStorage(SpMVStorage storage)
+    {
+        log_debug(this, "GlobalMatrix::SetSpMVStorage()", storage);
+
+        this->matrix_interior_.SetSpMVStorage(storage);
+        this->matrix_ghost_.SetSpMVStorage(storage);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::SetSpMVIndex(SpMVIndex index)
+    {
+        log_debug(this, "GlobalMatrix::SetSpMVIndex()", index);
+
+        this->matrix_interior_.SetSpMVIndex(index);
+        this->matrix_ghost_.SetSpMVIndex(index);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::SetReducedPrecisionHalo(bool enable)
+    {
+        log_debug(this, "GlobalMatrix::SetReducedPrecisionHalo()", enable);
+
+        if(enable == true && std::is_same<ValueType, double>::value == false)
+        {
+            LOG_INFO("Reduced precision halo exchange is only available for double precision");
+
+            return;
+        }
+
+        this->halo_float_ = enable;
+
+        // Cached persistent requests may be bound to the single precision buffers that are
+        // released below
+        if(this->pm_ != NULL)
+        {
+            this->pm_->FreePersistent_();
+        }
+
+        this->recv_buffer_float_.Clear();
+        this->send_buffer_float_.Clear();
+
+        free_pinned(&this->recv_boundary_float_);
+        free_pinned(&this->send_boundary_float_);
+
+        // Allocate the single precision buffers, if the communication pattern is known
+        if(enable == true && this->recv_buffer_.GetSize() + this->send_buffer_.GetSize() > 0)
+        {
+            this->recv_buffer_float_.CloneBackend(this->recv_buffer_);
+            this->send_buffer_float_.CloneBackend(this->send_buffer_);
+
+            this->recv_buffer_float_.Allocate("receive buffer", this->recv_buffer_.GetSize());
+            this->send_buffer_float_.Allocate("send buffer", this->send_buffer_.GetSize());
+
+            allocate_pinned(this->recv_buffer_.GetSize(), &this->recv_boundary_float_);
+            allocate_pinned(this->send_buffer_.GetSize(), &this->send_boundary_float_);
+        }
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::Apply(const GlobalVector<ValueType>& in,
+                                        GlobalVector<ValueType>*       out) const
+    {
+        log_debug(this, "GlobalMatrix::Apply()", (const void*&)in, out);
+        ROCALUTION_RANGE("GlobalMatrix::Apply()");
+
+        assert(out != NULL);
+        assert(&in != out);
+
+        // Calling global routine with single process
+        if(this->pm_ == NULL)
+        {
+            // no PM, do interior apply
+            this->matrix_interior_.Apply(in.vector_interior_, &out->vector_interior_);
+
+            return;
+        }
+
+        assert(this->GetM() == out->GetSize());
+        assert(this->GetN() == in.GetSize());
+        assert(this->is_host_() == in.is_host_());
+        assert(this->is_host_() == out->is_host_());
+        assert(this->is_host_() == this->halo_.is_host_());
+        assert(this->is_host_() == this->recv_buffer_.is_host_());
+        assert(this->is_host_() == this->send_buffer_.is_host_());
+
+        // The compute mode is switched for the whole process
+        RocalutionComputeScope compute_scope;
+
+        // Halo values are exchanged in single precision
+        if(this->halo_float_ == true)
+        {
+            this->ApplyReducedHalo_(in, out);
+
+            return;
+        }
+
+        // With contiguous boundary rows, the send buffers are slices of the input vector
+        bool zero_copy = (this->halo_slice_ != NULL);
+
+        // Prepare send buffer
+        if(zero_copy == false)
+        {
+            ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() pack");
+            in.vector_interior_.GetIndexValues(this->halo_, &this->send_buffer_);
+            ROCALUTION_RANGE_POP();
+        }
+
+        // Change to compute mode ghost
+        _rocalution_compute_ghost();
+
+        // Make send buffer available for communication
+        ValueType* send_buffer = NULL;
+        ValueType* recv_buffer = this->recv_boundary_;
+
+        // With GPU-aware MPI, accelerator buffers are directly passed to MPI
+        bool gpu_aware_mpi = (this->is_host_() == false && this->local_backend_.GPU_aware_MPI);
+
+        if(this->is_host_() == true)
+        {
+            if(zero_copy == true)
+            {
+                // Send directly from the input vector
+                this->pm_->CommunicateAsync_(
+                    in.vector_interior_.vector_->GetDataPtr(), recv_buffer, this->halo_slice_);
+            }
+            else
+            {
+                // On host, we can directly use the host pointer
+                this->send_buffer_.LeaveDataPtr(&send_buffer);
+
+                // Initiate communication as soon as the send buffer is packed, such
+                // that the transfer overlaps with the interior SpMV
+                this->pm_->CommunicatePersistentAsync_(send_buffer, recv_buffer);
+            }
+
+            // Change to compute mode interior
+            _rocalution_compute_interior();
+
+            // Interior
+            ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() interior");
+            this->matrix_interior_.Apply(in.vector_interior_, &out->vector_interior_);
+            ROCALUTION_RANGE_POP();
+        }
+        else if(gpu_aware_mpi == true)
+        {
+            // Hand the accelerator pointers directly to MPI
+            this->recv_buffer_.LeaveDataPtr(&recv_buffer);
+
+            if(zero_copy == false)
+            {
+                this->send_buffer_.LeaveDataPtr(&send_buffer);
+            }
+
+            // Send buffer (or the input vector) is written on the default stream, it needs
+            // to be completed before MPI can access it
+            _rocalution_sync_default();
+
+            // Initiate communication
+            if(zero_copy == true)
+            {
+                this->pm_->CommunicateAsync_(
+                    in.vector_interior_.vector_->GetDataPtr(), recv_buffer, this->halo_slice_);
+            }
+            else
+            {
+                this->pm_->CommunicatePersistentAsync_(send_buffer, recv_buffer);
+            }
+
+            // Change to compute mode interior
+            _rocalution_compute_interior();
+
+            // Interior, this is launched asynchronously on the interior stream
+            ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() interior");
+            this->matrix_interior_.Apply(in.vector_interior_, &out->vector_interior_);
+            ROCALUTION_RANGE_POP();
+        }
+        else
+        {
+            // On the accelerator, we need to (asynchronously) make the data
+            // available on the host
+            if(zero_copy == true)
+            {
+                // Copy the slice of each neighbor, no gather is required
+                const int* send_offset = this->pm_->send_offset_index_;
+
+                for(int n = 0; n < this->pm_->nsend_; ++n)
+                {
+                    in.vector_interior_.GetContinuousValues(
+                        this->halo_slice_[n],
+                        this->halo_slice_[n] + send_offset[n + 1] - send_offset[n],
+                        this->send_boundary_ + send_offset[n]);
+                }
+            }
+            else
+            {
+                this->send_buffer_.GetContinuousValues(
+                    0, this->pm_->GetNumSenders(), this->send_boundary_);
+            }
+
+            send_buffer = this->send_boundary_;
+
+            // Change to compute mode interior
+            _rocalution_compute_interior();
+
+            // Interior, this is launched asynchronously on the interior stream
+            ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() interior");
+            this->matrix_interior_.Apply(in.vector_interior_, &out->vector_interior_);
+            ROCALUTION_RANGE_POP();
+
+            // Synchronize compute mode ghost, send buffer is now available on the host
+            _rocalution_sync_ghost();
+
+            // Initiate communication while the interior SpMV is in flight
+            this->pm_->CommunicatePersistentAsync_(send_buffer, recv_buffer);
+        }
+
+        // Sync communication
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() wait");
+        this->pm_->CommunicateSync_();
+        ROCALUTION_RANGE_POP();
+
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() ghost");
+
+        if((this->is_host_() == true || gpu_aware_mpi == true) && zero_copy == false)
+        {
+            // We need to set back the pointer into its structure
+            this->send_buffer_.SetDataPtr(&send_buffer, "send buffer", this->pm_->GetNumSenders());
+        }
+
+        if(gpu_aware_mpi == true)
+        {
+            // Receive buffer has been filled directly by MPI
+            this->recv_buffer_.SetDataPtr(
+                &recv_buffer, "receive buffer", this->pm_->GetNumReceivers());
+        }
+        else
+        {
+            // Change to compute mode ghost
+            _rocalution_compute_ghost();
+
+            // Process receive buffer
+            this->recv_buffer_.SetContinuousValues(
+                0, this->pm_->GetNumReceivers(), this->recv_boundary_);
+        }
+
+        // Change to compute mode default
+        _rocalution_compute_default();
+
+        // Ghost
+        this->matrix_ghost_.ApplyAdd(
+            this->recv_buffer_, static_cast<ValueType>(1), &out->vector_interior_);
+        ROCALUTION_RANGE_POP();
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ApplyReducedHalo_(const GlobalVector<ValueType>& in,
+                                                    GlobalVector<ValueType>*       out) const
+    {
+        assert(this->is_host_() == this->recv_buffer_float_.is_host_());
+        assert(this->is_host_() == this->send_buffer_float_.is_host_());
+
+        // Prepare send buffer, rounding to single precision is fused into the gather
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() pack");
+        in.vector_interior_.GetIndexValuesFloat(this->halo_, &this->send_buffer_float_);
+        ROCALUTION_RANGE_POP();
+
+        // Change to compute mode ghost
+        _rocalution_compute_ghost();
+
+        // On the host and with GPU-aware MPI, the buffers are directly passed to MPI
+        bool direct = (this->is_host_() == true || this->local_backend_.GPU_aware_MPI == true);
+
+        float* send_buffer = NULL;
+        float* recv_buffer = (direct == true) ? NULL : this->recv_boundary_float_;
+
+        if(direct == true)
+        {
+            this->send_buffer_float_.LeaveDataPtr(&send_buffer);
+            this->recv_buffer_float_.LeaveDataPtr(&recv_buffer);
+
+            // Send buffer is packed on the default stream, it needs to be completed
+            // before MPI can access it
+            if(this->is_host_() == false)
+            {
+                _rocalution_sync_default();
+            }
+
+            // Initiate communication
+            this->pm_->CommunicatePersistentAsync_(send_buffer, recv_buffer);
+
+            // Change to compute mode interior
+            _rocalution_compute_interior();
+
+            // Interior
+            ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() interior");
+            this->matrix_interior_.Apply(in.vector_interior_, &out->vector_interior_);
+            ROCALUTION_RANGE_POP();
+        }
+        else
+        {
+            // On the accelerator, we need to (asynchronously) make the data
+            // available on the host
+            send_buffer = this->send_boundary_float_;
+
+            this->send_buffer_float_.GetContinuousValues(
+                0, this->pm_->GetNumSenders(), send_buffer);
+
+            // Change to compute mode interior
+            _rocalution_compute_interior();
+
+            // Interior, this is launched asynchronously on the interior stream
+            ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() interior");
+            this->matrix_interior_.Apply(in.vector_interior_, &out->vector_interior_);
+            ROCALUTION_RANGE_POP();
+
+            // Synchronize compute mode ghost, send buffer is now available on the host
+            _rocalution_sync_ghost();
+
+            // Initiate communication while the interior SpMV is in flight
+            this->pm_->CommunicatePersistentAsync_(send_buffer, recv_buffer);
+        }
+
+        // Sync communication
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() wait");
+        this->pm_->CommunicateSync_();
+        ROCALUTION_RANGE_POP();
+
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::Apply() ghost");
+
+        // Change to compute mode ghost
+        _rocalution_compute_ghost();
+
+        if(direct == true)
+        {
+            // We need to set back the pointers into their structures
+            this->send_buffer_float_.SetDataPtr(
+                &send_buffer, "send buffer", this->pm_->GetNumSenders());
+            this->recv_buffer_float_.SetDataPtr(
+                &recv_buffer, "receive buffer", this->pm_->GetNumReceivers());
+        }
+        else
+        {
+            // Process receive buffer
+            this->recv_buffer_float_.SetContinuousValues(
+                0, this->pm_->GetNumReceivers(), recv_buffer);
+        }
+
+        // Expand to double precision
+        this->recv_buffer_.CopyFromFloat(this->recv_buffer_float_);
+
+        // Change to compute mode default
+        _rocalution_compute_default();
+
+        // Ghost
+        this->matrix_ghost_.ApplyAdd(
+            this->recv_buffer_, static_cast<ValueType>(1), &out->vector_interior_);
+        ROCALUTION_RANGE_POP();
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ApplyAdd(const GlobalVector<ValueType>& in,
+                                           ValueType                      scalar,
+                                           GlobalVector<ValueType>*       out) const
+    {
+        log_debug(this, "GlobalMatrix::ApplyAdd()", (const void*&)in, scalar, out);
+
+        assert(out != NULL);
+        assert(&in != out);
+
+        assert(this->GetM() == out->GetSize());
+        assert(this->GetN() == in.GetSize());
+        assert(this->is_host_() == in.is_host_());
+        assert(this->is_host_() == out->is_host_());
+
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ApplyTranspose(const GlobalVector<ValueType>& in,
+                                                 GlobalVector<ValueType>*       out) const
+    {
+        log_debug(this, "GlobalMatrix::ApplyTranspose()", (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(&in != out);
+
+        // Calling global routine with single process
+        if(this->pm_ == NULL)
+        {
+            this->matrix_interior_.ApplyTranspose(in.vector_interior_, &out->vector_interior_);
+
+            return;
+        }
+
+        out->vector_interior_.Zeros();
+
+        this->ApplyTransposeAdd(in, static_cast<ValueType>(1), out);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ApplyTransposeAdd(const GlobalVector<ValueType>& in,
+                                                    ValueType                      scalar,
+                                                    GlobalVector<ValueType>*       out) const
+    {
+        log_debug(this, "GlobalMatrix::ApplyTransposeAdd()", (const void*&)in, scalar, out);
+        ROCALUTION_RANGE("GlobalMatrix::ApplyTransposeAdd()");
+
+        assert(out != NULL);
+        assert(&in != out);
+
+        // Calling global routine with single process
+        if(this->pm_ == NULL)
+        {
+            this->matrix_interior_.ApplyTransposeAdd(
+                in.vector_interior_, scalar, &out->vector_interior_);
+
+            return;
+        }
+
+        assert(this->GetN() == out->GetSize());
+        assert(this->GetM() == in.GetSize());
+        assert(this->is_host_() == in.is_host_());
+        assert(this->is_host_() == out->is_host_());
+        assert(this->is_host_() == this->halo_.is_host_());
+        assert(this->is_host_() == this->recv_buffer_.is_host_());
+        assert(this->is_host_() == this->send_buffer_.is_host_());
+
+        // The compute mode is switched for the whole process
+        RocalutionComputeScope compute_scope;
+
+        // Change to compute mode ghost
+        _rocalution_compute_ghost();
+
+        // The ghost columns belong to the neighbors, such that their contributions
+        // are accumulated in the receive buffer and sent back to the owning process
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::ApplyTransposeAdd() ghost");
+        this->recv_buffer_.Zeros();
+        this->matrix_ghost_.ApplyTransposeAdd(in.vector_interior_, scalar, &this->recv_buffer_);
+        this->recv_buffer_.GetContinuousValues(
+            0, this->pm_->GetNumReceivers(), this->recv_boundary_);
+        ROCALUTION_RANGE_POP();
+
+        // Ghost contributions need to be available on the host
+        _rocalution_sync_ghost();
+
+        // Initiate the inverse halo exchange, it overlaps with the interior product
+        this->pm_->InverseCommunicateAsync_(this->recv_boundary_, this->send_boundary_);
+
+        // Change to compute mode interior
+        _rocalution_compute_interior();
+
+        // Interior
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::ApplyTransposeAdd() interior");
+        this->matrix_interior_.ApplyTransposeAdd(
+            in.vector_interior_, scalar, &out->vector_interior_);
+        ROCALUTION_RANGE_POP();
+
+        // Sync communication
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::ApplyTransposeAdd() wait");
+        this->pm_->InverseCommunicateSync_();
+        ROCALUTION_RANGE_POP();
+
+        // Change to compute mode default
+        _rocalution_compute_default();
+
+        // Add the contributions of the neighbors to the boundary entries, a boundary
+        // entry can be a ghost of several neighbors
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::ApplyTransposeAdd() unpack");
+        this->send_buffer_.SetContinuousValues(
+            0, this->pm_->GetNumSenders(), this->send_boundary_);
+        out->vector_interior_.AddIndexValues(this->halo_, this->send_buffer_);
+        ROCALUTION_RANGE_POP();
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ApplyRows(const GlobalVector<ValueType>& in,
+                                            const LocalVector<int>&        rows,
+                                            GlobalVector<ValueType>*       out) const
+    {
+        log_debug(this, "GlobalMatrix::ApplyRows()", (const void*&)in, (const void*&)rows, out);
+        ROCALUTION_RANGE("GlobalMatrix::ApplyRows()");
+
+        this->ApplyRows_(in, rows, NULL, out);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ResidualRows(const GlobalVector<ValueType>& rhs,
+                                               const GlobalVector<ValueType>& x,
+                                               const LocalVector<int>&        rows,
+                                               GlobalVector<ValueType>*       res) const
+    {
+        log_debug(this,
+                  "GlobalMatrix::ResidualRows()",
+                  (const void*&)rhs,
+                  (const void*&)x,
+                  (const void*&)rows,
+                  res);
+        ROCALUTION_RANGE("GlobalMatrix::ResidualRows()");
+
+        assert(rhs.GetSize() == this->GetM());
+
+        this->ApplyRows_(x, rows, &rhs, res);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ApplyRowsInterior_(const GlobalVector<ValueType>& in,
+                                                     const LocalVector<int>&        rows,
+                                                     const GlobalVector<ValueType>* rhs,
+                                                     GlobalVector<ValueType>*       out) const
+    {
+        // Residual, if a right-hand side is given, product otherwise
+        if(rhs != NULL)
+        {
+            this->matrix_interior_.ResidualRows(
+                rhs->vector_interior_, in.vector_interior_, rows, &out->vector_interior_);
+        }
+        else
+        {
+            this->matrix_interior_.ApplyRows(in.vector_interior_, rows, &out->vector_interior_);
+        }
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ApplyRows_(const GlobalVector<ValueType>& in,
+                                             const LocalVector<int>&        rows,
+                                             const GlobalVector<ValueType>* rhs,
+                                             GlobalVector<ValueType>*       out) const
+    {
+        assert(out != NULL);
+        assert(&in != out);
+        assert(rows.is_host_() == this->is_host_());
+
+        // Calling global routine with single process
+        if(this->pm_ == NULL)
+        {
+            this->ApplyRowsInterior_(in, rows, rhs, out);
+
+            return;
+        }
+
+        assert(this->GetM() == out->GetSize());
+        assert(this->GetN() == in.GetSize());
+        assert(this->is_host_() == in.is_host_());
+        assert(this->is_host_() == out->is_host_());
+        assert(this->is_host_() == this->halo_.is_host_());
+        assert(this->is_host_() == this->recv_buffer_.is_host_());
+        assert(this->is_host_() == this->send_buffer_.is_host_());
+
+        // The compute mode is switched for the whole process
+        RocalutionComputeScope compute_scope;
+
+        // Prepare send buffer, the neighbors do not know which of our boundary values
+        // their rows require, thus the complete halo is exchanged
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::ApplyRows() pack");
+        in.vector_interior_.GetIndexValues(this->halo_, &this->send_buffer_);
+        ROCALUTION_RANGE_POP();
+
+        // Change to compute mode ghost
+        _rocalution_compute_ghost();
+
+        this->send_buffer_.GetContinuousValues(
+            0, this->pm_->GetNumSenders(), this->send_boundary_);
+
+        // Change to compute mode interior
+        _rocalution_compute_interior();
+
+        // Interior rows, overlapping with the transfer of the send buffer
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::ApplyRows() interior");
+        this->ApplyRowsInterior_(in, rows, rhs, out);
+        ROCALUTION_RANGE_POP();
+
+        // Synchronize compute mode ghost, send buffer is now available on the host
+        _rocalution_sync_ghost();
+
+        this->pm_->CommunicatePersistentAsync_(this->send_boundary_, this->recv_boundary_);
+
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::ApplyRows() wait");
+        this->pm_->CommunicateSync_();
+        ROCALUTION_RANGE_POP();
+
+        // Change to compute mode ghost
+        _rocalution_compute_ghost();
+
+        // Process receive buffer
+        this->recv_buffer_.SetContinuousValues(
+            0, this->pm_->GetNumReceivers(), this->recv_boundary_);
+
+        // Change to compute mode default
+        _rocalution_compute_default();
+
+        // Ghost, only the listed rows read the received halo values
+        ROCALUTION_RANGE_PUSH("GlobalMatrix::ApplyRows() ghost");
+        this->matrix_ghost_.ApplyAddRows(this->recv_buffer_,
+                                         rows,
+                                         (rhs == NULL) ? static_cast<ValueType>(1)
+                                                       : static_cast<ValueType>(-1),
+                                         &out->vector_interior_);
+        ROCALUTION_RANGE_POP();
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::Transpose(void)
+    {
+        log_debug(this, "GlobalMatrix::Transpose()");
+
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::Transpose(GlobalMatrix<ValueType>* T) const
+    {
+        log_debug(this, "GlobalMatrix::Transpose()", T);
+
+        assert(T != NULL);
+        assert(T != this);
+        assert(this->is_host_() == T->is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        // Calling global routine with single process
+        if(this->pm_ == NULL || this->pm_->num_procs_ == 1)
+        {
+            this->matrix_interior_.Transpose(&T->matrix_interior_);
+
+            T->CreateParallelManager_();
+
+            T->pm_self_->SetMPICommunicator(this->pm_->comm_);
+
+            T->pm_self_->SetGlobalNrow(T->matrix_interior_.GetM());
+            T->pm_self_->SetGlobalNcol(T->matrix_interior_.GetN());
+
+            T->pm_self_->SetLocalNrow(T->matrix_interior_.GetM());
+            T->pm_self_->SetLocalNcol(T->matrix_interior_.GetN());
+
+            return;
+        }
+
+        if(this->GetNnz() > 0)
+        {
+            // Some dummy structures
+            LocalVector<int64_t> global_zero;
+            global_zero.CloneBackend(*this);
+
+            // Transpose local matrices
+            LocalMatrix<ValueType> T_ext;
+            T_ext.CloneBackend(*this);
+
+            // Transpose ghost part into T ext
+            this->matrix_ghost_.Transpose(&T_ext);
+
+            // Generate T ghost and parallel manager of T
+
+            // T_ext and T ghost MUST be CSR
+            assert(T_ext.GetFormat() == CSR);
+            assert(T->matrix_ghost_.GetFormat() == CSR);
+
+            // Now we need to extract rows that do not belong to us and thus
+            // need to be sent to neighboring processes
+            int64_t nrows_send = T_ext.GetM();
+            int     nrows_recv = this->pm_->GetNumSenders();
+
+            // Extract row nnz for the rows that we have to send to neighbors
+            LocalVector<PtrType> T_ext_row_ptr_send;
+            T_ext_row_ptr_send.CloneBackend(*this);
+            T_ext_row_ptr_send.Allocate("row nnz send", nrows_send);
+
+            // send number of nonzeros that will be in the ghost restriction rows
+            T_ext.matrix_->ExtractExtRowNnz(0, T_ext_row_ptr_send.vector_);
+
+            // Prepare send / receive buffers
+            PtrType* pT_ext_row_nnz_send = NULL;
+            PtrType* pT_ext_row_ptr_recv = NULL;
+
+            LocalVector<PtrType> T_ext_row_ptr_recv;
+#ifdef SUPPORT_RDMA
+            T_ext_row_ptr_recv.CloneBackend(*this);
+#endif
+            T_ext_row_ptr_recv.Allocate("row ptr recv", nrows_recv + 1);
+
+#ifndef SUPPORT_RDMA
+            T_ext_row_ptr_send.MoveToHost();
+#endif
+
+            // Get host pointers for communication
+            T_ext_row_ptr_recv.LeaveDataPtr(&pT_ext_row_ptr_recv);
+            T_ext_row_ptr_send.LeaveDataPtr(&pT_ext_row_nnz_send);
+
+            // Initiate communication of nnz per row
+            this->pm_->InverseCommunicateAsync_(pT_ext_row_nnz_send, pT_ext_row_ptr_recv);
+
+            // Extract column indices and transform them to global indices (for sending)
+            LocalVector<int64_t> T_ext_col_ind_send;
+            T_ext_col_ind_send.CloneBackend(*this);
+            T_ext_col_ind_send.Allocate("col ind send", T_ext.GetNnz());
+
+            T_ext.matrix_->ExtractGlobalColumnIndices(T_ext.GetN(),
+                                                      this->pm_->GetGlobalRowBegin(),
+                                                      *global_zero.vector_,
+                                                      T_ext_col_ind_send.vector_);
+
+            // Wait for nnz per row communication to finish
+            this->pm_->InverseCommunicateSync_();
+
+            // Clean up
+            free_host(&pT_ext_row_nnz_send);
+
+            // Put receive buffer back in structure
+            T_ext_row_ptr_recv.SetDataPtr(&pT_ext_row_ptr_recv, "row ptr recv", nrows_recv + 1);
+
+#ifndef SUPPORT_RDMA
+            T_ext_row_ptr_recv.CloneBackend(*this);
+#endif
+
+            // Exclusive sum to obtain recv row pointers
+            PtrType nnz_recv = T_ext_row_ptr_recv.ExclusiveSum();
+
+            // Prepare receive buffers
+            int64_t*   pT_ext_col_ind_recv = NULL;
+            ValueType* pT_ext_val_recv     = NULL;
+
+            LocalVector<int64_t>   T_ext_col_ind_recv;
+            LocalVector<ValueType> T_ext_val_recv;
+
+#ifdef SUPPORT_RDMA
+            T_ext_col_ind_recv.CloneBackend(*this);
+            T_ext_val_recv.CloneBackend(*this);
+#endif
+
+            T_ext_col_ind_recv.Allocate("col ind recv", nnz_recv);
+            T_ext_val_recv.Allocate("val recv", nnz_recv);
+
+            T_ext_col_ind_recv.LeaveDataPtr(&pT_ext_col_ind_recv);
+            T_ext_val_recv.LeaveDataPtr(&pT_ext_val_recv);
+
+            // Prepare send buffers
+            int64_t*   pT_ext_col_ind_send_global = NULL;
+            PtrType*   pT_ext_row_ptr_send        = NULL;
+            int*       pT_ext_col_ind_send        = NULL;
+            ValueType* pT_ext_val_send            = NULL;
+
+#ifndef SUPPORT_RDMA
+            T_ext_row_ptr_recv.MoveToHost();
+            T_ext_col_ind_send.MoveToHost();
+            T_ext.MoveToHost();
+#endif
+
+            T_ext_row_ptr_recv.LeaveDataPtr(&pT_ext_row_ptr_recv);
+            T_ext_col_ind_send.LeaveDataPtr(&pT_ext_col_ind_send_global);
+            T_ext.LeaveDataPtrCSR(&pT_ext_row_ptr_send, &pT_ext_col_ind_send, &pT_ext_val_send);
+
+            // Initiate communication of column indices and values
+            this->pm_->InverseCommunicateCSRAsync_(pT_ext_row_ptr_send,
+                                                   pT_ext_col_ind_send_global,
+                                                   pT_ext_val_send,
+                                                   pT_ext_row_ptr_recv,
+                                                   pT_ext_col_ind_recv,
+                                                   pT_ext_val_recv);
+
+            // Perform interior transpose while we do the communication
+            this->matrix_interior_.Transpose(&T->matrix_interior_);
+
+            // Wait for additional column indices and values communication to finish
+            this->pm_->InverseCommunicateCSRSync_();
+
+            // Now we can clear T ext related send buffers
+            free_host(&pT_ext_row_ptr_send);
+            free_host(&pT_ext_col_ind_send);
+            free_host(&pT_ext_val_send);
+            free_host(&pT_ext_col_ind_send_global);
+
+            // Setup manager of T
+
+            // Start with a clean manager
+            T->CreateParallelManager_();
+
+            // Same communicator as initial matrix
+            T->pm_self_->SetMPICommunicator(this->pm_->comm_);
+
+            // Sizes of the transposed
+            T->pm_self_->SetGlobalNrow(this->pm_->global_ncol_);
+            T->pm_self_->SetGlobalNcol(this->pm_->global_nrow_);
+            T->pm_self_->SetLocalNrow(this->pm_->local_ncol_);
+            T->pm_self_->SetLocalNcol(this->pm_->local_nrow_);
+
+            // Put the global column indices back into structure
+            T_ext_col_ind_recv.SetDataPtr(&pT_ext_col_ind_recv, "col ind recv", nnz_recv);
+            T_ext_col_ind_recv.CloneBackend(*this);
+
+            // To generate the parallel manager, we need the distinct global ghost column ids
+            int64_t* pghost_col = NULL;
+            int64_t  nghost_col = unique_ghost_columns(T_ext_col_ind_recv, &pghost_col);
+
+            // Generate the manager from ghost of T and manager of non-transposed
+            T->pm_self_->GenerateFromGhostColumnsWithParent_(
+                nghost_col, pghost_col, *this->pm_, true);
+
+            // Communicate global offsets
+            T->pm_self_->CommunicateGlobalOffsetAsync_();
+
+            // Clear
+            free_host(&pghost_col);
+
+            // Wrap received data into structure
+            T_ext_row_ptr_recv.SetDataPtr(&pT_ext_row_ptr_recv, "row ptr recv", nrows_recv + 1);
+            T_ext_val_recv.SetDataPtr(&pT_ext_val_recv, "val recv", nnz_recv);
+
+#ifndef SUPPORT_RDMA
             T_ext_row_ptr_recv.CloneBackend(*this);
+            T_ext_val_recv.CloneBackend(*this);
+#endif
+
+            T->pm_self_->CommunicateGlobalOffsetSync_();
+
+            // Convert global boundary index into local index
+            T->pm_self_->BoundaryTransformGlobalToLocal_();
+
+            // Communicate ghost to global map
+            T->pm_self_->CommunicateGhostToGlobalMapAsync_();
+
+            // Allocate T ghost
+            T->matrix_ghost_.AllocateCSR(
+                "ghost", nnz_recv, T->pm_self_->local_nrow_, T->pm_self_->local_ncol_);
+
+            // Finally generate the ghost of T (global columns)
+            LocalVector<int64_t> T_ext_cols;
+            T_ext_cols.CloneBackend(*this);
+
+            T->matrix_ghost_.matrix_->CopyGhostFromGlobalReceive(*this->halo_.vector_,
+                                                                 *T_ext_row_ptr_recv.vector_,
+                                                                 *T_ext_col_ind_recv.vector_,
+                                                                 *T_ext_val_recv.vector_,
+                                                                 T_ext_cols.vector_);
+
+            // Transform global to local ghost columns
+            T->matrix_ghost_.matrix_->RenumberGlobalToLocal(*T_ext_cols.vector_);
+
+            // Synchronize
+            T->pm_self_->CommunicateGhostToGlobalMapSync_();
+
+            T->SetParallelManager(*T->pm_self_);
+        }
+
+#ifdef DEBUG_MODE
+        T->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::TripleMatrixProduct(const GlobalMatrix<ValueType>& R,
+                                                      const GlobalMatrix<ValueType>& A,
+                                                      const GlobalMatrix<ValueType>& P)
+    {
+        log_debug(this,
+                  "GlobalMatrix::TripleMatrixProduct()",
+                  (const void*&)R,
+                  (const void*&)A,
+                  (const void*&)P);
+
+        assert(&R != this);
+        assert(&A != this);
+        assert(&P != this);
+
+        assert(R.GetN() == A.GetM());
+        assert(A.GetN() == P.GetM());
+        assert(this->is_host_() == R.is_host_());
+        assert(this->is_host_() == A.is_host_());
+        assert(this->is_host_() == P.is_host_());
+
+#ifdef DEBUG_MODE
+        R.Check();
+        A.Check();
+        P.Check();
+#endif
+
+        // Calling global routine with single process
+        if(this->pm_ == NULL || this->pm_->num_procs_ == 1)
+        {
+            this->matrix_interior_.TripleMatrixProduct(
+                R.matrix_interior_, A.matrix_interior_, P.matrix_interior_);
+
+            this->CreateParallelManager_();
+
+            this->pm_self_->SetMPICommunicator(A.pm_->comm_);
+
+            this->pm_self_->SetGlobalNrow(this->matrix_interior_.GetM());
+            this->pm_self_->SetGlobalNcol(this->matrix_interior_.GetN());
+
+            this->pm_self_->SetLocalNrow(this->matrix_interior_.GetM());
+            this->pm_self_->SetLocalNcol(this->matrix_interior_.GetN());
+
+            return;
+        }
+
+        // Only CSR matrices are supported
+        LocalMatrix<ValueType> R_int;
+        LocalMatrix<ValueType> R_gst;
+        LocalMatrix<ValueType> A_int;
+        LocalMatrix<ValueType> A_gst;
+        LocalMatrix<ValueType> P_int;
+        LocalMatrix<ValueType> P_gst;
+
+        const LocalMatrix<ValueType>* R_int_ptr = &R.matrix_interior_;
+        const LocalMatrix<ValueType>* R_gst_ptr = &R.matrix_ghost_;
+        const LocalMatrix<ValueType>* A_int_ptr = &A.matrix_interior_;
+        const LocalMatrix<ValueType>* A_gst_ptr = &A.matrix_ghost_;
+        const LocalMatrix<ValueType>* P_int_ptr = &P.matrix_interior_;
+        const LocalMatrix<ValueType>* P_gst_ptr = &P.matrix_ghost_;
+
+        if(R_int_ptr->GetFormat() != CSR)
+        {
+            R_int.CloneFrom(*R_int_ptr);
+            R_int.ConvertToCSR();
+            R_int_ptr = &R_int;
+        }
+
+        if(A_int_ptr->GetFormat() != CSR)
+        {
+            A_int.CloneFrom(*A_int_ptr);
+            A_int.ConvertToCSR();
+            A_int_ptr = &A_int;
+        }
+
+        if(A_gst_ptr->GetFormat() != CSR)
+        {
+            A_gst.CloneFrom(*A_gst_ptr);
+            A_gst.ConvertToCSR();
+            A_gst_ptr = &A_gst;
+        }
+
+        if(P_int_ptr->GetFormat() != CSR)
+        {
+            P_int.CloneFrom(*P_int_ptr);
+            P_int.ConvertToCSR();
+            P_int_ptr = &P_int;
+        }
+
+        if(P_gst_ptr->GetFormat() != CSR)
+        {
+            P_gst.CloneFrom(*P_gst_ptr);
+            P_gst.ConvertToCSR();
+            P_gst_ptr = &P_gst;
+        }
+
+        // Convert to CSR
+        unsigned int format   = this->GetFormat();
+        int          blockdim = this->matrix_interior_.GetBlockDimension();
+        this->ConvertToCSR();
+
+        // Transpose ghost of P to obtain R ext
+        LocalMatrix<ValueType> R_ext;
+        R_ext.CloneBackend(*this);
+        P_gst_ptr->Transpose(&R_ext);
+
+        // Compute AP = A * P, the additional rows of P are fetched from the neighbors
+        LocalMatrix<ValueType> AP;
+        LocalVector<int64_t>   l2g;
+
+        AP.CloneBackend(*this);
+
+        this->MatrixMultExtRows_(A, *A_int_ptr, *A_gst_ptr, P, *P_int_ptr, *P_gst_ptr, &AP, &l2g);
+
+        bool gpu_aware_mpi = (this->is_host_() == false && this->local_backend_.GPU_aware_MPI);
+
+        LocalVector<int64_t> zero_vector64;
+        zero_vector64.CloneBackend(*this);
+
+        // The rows of RAP that have to be sent to neighboring processes are computed first,
+        // RAP_ext = R_ext * AP, such that their exchange overlaps with the local product
+        // RAP = R_int * AP
+        int64_t RAP_ext_m_send = R_ext.GetLocalM();
+        int64_t RAP_ext_m_recv = P.pm_->GetNumSenders();
+
+        LocalMatrix<ValueType> RAP_ext;
+        RAP_ext.CloneBackend(*this);
+
+        if(RAP_ext_m_send > 0)
+        {
+            RAP_ext.MatrixMult(R_ext, AP);
+        }
+        else
+        {
+            RAP_ext.AllocateCSR("RAP ext", 0, 0, AP.GetLocalN());
+        }
+
+        R_ext.Clear();
+
+        LocalVector<PtrType> RAP_ext_row_ptr_send;
+        RAP_ext_row_ptr_send.CloneBackend(*this);
+        RAP_ext_row_ptr_send.Allocate("RAP ext row ptr send", RAP_ext_m_send + 1);
+
+        RAP_ext.matrix_->ExtractExtRowNnz(0, RAP_ext_row_ptr_send.vector_);
+
+        // Communication buffers
+        PtrType* hRAP_ext_row_nnz_send = NULL;
+        PtrType* hRAP_ext_row_ptr_recv = NULL;
+
+        allocate_host(RAP_ext_m_send + 1, &hRAP_ext_row_nnz_send);
+        allocate_host(RAP_ext_m_recv + 1, &hRAP_ext_row_ptr_recv);
+
+        RAP_ext_row_ptr_send.CopyToHostData(hRAP_ext_row_nnz_send);
+
+        // Initiate communication of nnz per row
+        P.pm_->InverseCommunicateAsync_(hRAP_ext_row_nnz_send, hRAP_ext_row_ptr_recv + 1);
+
+        // Exclusive sum to obtain row pointers of send buffer
+        RAP_ext_row_ptr_send.ExclusiveSum();
+
+        // We need a copy of RAP_ext_row_ptr on host for the communication
+        PtrType* hRAP_ext_row_ptr_send = NULL;
+        allocate_host(RAP_ext_m_send + 1, &hRAP_ext_row_ptr_send);
+        RAP_ext_row_ptr_send.CopyToHostData(hRAP_ext_row_ptr_send);
+        RAP_ext_row_ptr_send.Clear();
+
+        // Extract column indices and transform them to global indices (for sending)
+        LocalVector<int64_t> RAP_ext_col_ind_send;
+        RAP_ext_col_ind_send.CloneBackend(*this);
+        RAP_ext_col_ind_send.Allocate("col ind send", RAP_ext.GetNnz());
+
+        RAP_ext.matrix_->ExtractGlobalColumnIndices(P_int_ptr->GetN(),
+                                                    P.pm_->GetGlobalColumnBegin(),
+                                                    *l2g.vector_,
+                                                    RAP_ext_col_ind_send.vector_);
+
+        // Compute RAP = R_int * AP, while the nnz per row are in flight
+        LocalMatrix<ValueType> RAP_full;
+        RAP_full.CloneBackend(*this);
+        RAP_full.MatrixMult(*R_int_ptr, AP);
+
+        AP.Clear();
+
+        // Wait for nnz per row communication to finish
+        P.pm_->InverseCommunicateSync_();
+
+        // Clean up
+        free_host(&hRAP_ext_row_nnz_send);
+
+        // Exclusive sum to obtain recv row pointers
+        hRAP_ext_row_ptr_recv[0] = 0;
+        for(int64_t i = 0; i < RAP_ext_m_recv; ++i)
+        {
+            hRAP_ext_row_ptr_recv[i + 1] += hRAP_ext_row_ptr_recv[i];
+        }
+
+        int64_t RAP_ext_n        = RAP_ext.GetLocalN();
+        PtrType RAP_ext_nnz_send = RAP_ext.GetLocalNnz();
+        PtrType RAP_ext_nnz_recv = hRAP_ext_row_ptr_recv[RAP_ext_m_recv];
+
+        if(gpu_aware_mpi == true)
+        {
+            // Send buffers are written on the default stream
+            _rocalution_sync_default();
+        }
+        else
+        {
+            RAP_ext.MoveToHost();
+            RAP_ext_col_ind_send.MoveToHost();
+        }
+
+        // Send buffers, the local column indices are not sent
+        PtrType*   RAP_ext_row_ptr     = NULL;
+        int*       RAP_ext_col_ind     = NULL;
+        ValueType* RAP_ext_val_send    = NULL;
+        int64_t*   RAP_ext_col_ind_ptr = NULL;
+
+        RAP_ext.LeaveDataPtrCSR(&RAP_ext_row_ptr, &RAP_ext_col_ind, &RAP_ext_val_send);
+        RAP_ext_col_ind_send.LeaveDataPtr(&RAP_ext_col_ind_ptr);
+
+        // Receive buffers
+        LocalVector<int64_t>   RAP_ext_col_ind_recv;
+        LocalVector<ValueType> RAP_ext_val_recv;
+
+        if(gpu_aware_mpi == true)
+        {
+            RAP_ext_col_ind_recv.CloneBackend(*this);
+            RAP_ext_val_recv.CloneBackend(*this);
+        }
+
+        RAP_ext_col_ind_recv.Allocate("RAP_ext_col_ind_recv", RAP_ext_nnz_recv);
+        RAP_ext_val_recv.Allocate("RAP_ext_val_recv", RAP_ext_nnz_recv);
+
+        int64_t*   RAP_ext_col_ind_recv_ptr = NULL;
+        ValueType* RAP_ext_val_recv_ptr     = NULL;
+
+        RAP_ext_col_ind_recv.LeaveDataPtr(&RAP_ext_col_ind_recv_ptr);
+        RAP_ext_val_recv.LeaveDataPtr(&RAP_ext_val_recv_ptr);
+
+        // Initiate communication of column indices and values
+        P.pm_->InverseCommunicateCSRAsync_(hRAP_ext_row_ptr_send,
+                                           RAP_ext_col_ind_ptr,
+                                           RAP_ext_val_send,
+                                           hRAP_ext_row_ptr_recv,
+                                           RAP_ext_col_ind_recv_ptr,
+                                           RAP_ext_val_recv_ptr);
+
+        // Split RAP into interior and ghost
+        LocalMatrix<ValueType> RAP_interior;
+        LocalMatrix<ValueType> RAP_ghost;
+
+        RAP_interior.CloneBackend(RAP_full);
+        RAP_ghost.CloneBackend(RAP_full);
+
+        RAP_full.matrix_->SplitInteriorGhost(RAP_interior.matrix_, RAP_ghost.matrix_);
+
+        RAP_full.Clear();
+
+        // Wait for additional column indices and values communication to finish
+        P.pm_->InverseCommunicateCSRSync_();
+
+        // Clean up
+        free_host(&hRAP_ext_row_ptr_send);
+
+        RAP_ext.SetDataPtrCSR(&RAP_ext_row_ptr,
+                              &RAP_ext_col_ind,
+                              &RAP_ext_val_send,
+                              "RAP ext",
+                              RAP_ext_nnz_send,
+                              RAP_ext_m_send,
+                              RAP_ext_n);
+        RAP_ext.Clear();
+
+        RAP_ext_col_ind_send.SetDataPtr(&RAP_ext_col_ind_ptr, "", RAP_ext_nnz_send);
+        RAP_ext_col_ind_send.Clear();
+
+        LocalMatrix<ValueType> RAP_ext_interior;
+        LocalMatrix<ValueType> RAP_ext_ghost;
+
+        RAP_ext_interior.CloneBackend(*this);
+        RAP_ext_ghost.CloneBackend(*this);
+
+        // Temporary array to store global ghost columns
+        LocalVector<int64_t> ghost_col;
+        ghost_col.CloneBackend(*this);
+
+        LocalVector<PtrType> RAP_ext_row_ptr_recv;
+
+        RAP_ext_row_ptr_recv.SetDataPtr(&hRAP_ext_row_ptr_recv, "", RAP_ext_m_recv + 1);
+        RAP_ext_col_ind_recv.SetDataPtr(&RAP_ext_col_ind_recv_ptr, "", RAP_ext_nnz_recv);
+        RAP_ext_val_recv.SetDataPtr(&RAP_ext_val_recv_ptr, "", RAP_ext_nnz_recv);
+
+        RAP_ext_row_ptr_recv.CloneBackend(*this);
+        RAP_ext_col_ind_recv.CloneBackend(*this);
+        RAP_ext_val_recv.CloneBackend(*this);
+
+        RAP_ext_interior.matrix_->CopyFromGlobalReceive(P_int_ptr->GetN(),
+                                                        P.pm_->GetGlobalColumnBegin(),
+                                                        P.pm_->GetGlobalColumnEnd(),
+                                                        *P.halo_.vector_,
+                                                        *RAP_ext_row_ptr_recv.vector_,
+                                                        *RAP_ext_col_ind_recv.vector_,
+                                                        *RAP_ext_val_recv.vector_,
+                                                        RAP_ext_ghost.matrix_,
+                                                        ghost_col.vector_);
+
+        // Merged global ghost columns
+        LocalVector<int64_t> merged_col;
+        merged_col.CloneBackend(*this);
+
+        // Merge RAP ghost with RAP ext
+        RAP_ghost.CompressAdd(l2g, ghost_col, RAP_ext_ghost, &merged_col);
+
+        // Merge RAP interior with RAP ext
+        RAP_interior.CompressAdd(zero_vector64, zero_vector64, RAP_ext_interior, NULL);
+
+        // Generate the manager from ghost of RAP and manager of P, RAP has the number of rows
+        // of R and the number of columns of P
+        this->SetFromInteriorGhost_(&RAP_interior,
+                                    &RAP_ghost,
+                                    merged_col,
+                                    R.pm_->GetGlobalNrow(),
+                                    P.pm_->GetGlobalNcol(),
+                                    *P.pm_,
+                                    "RAP");
+
+        if(format != CSR || R.GetFormat() != CSR || A.GetFormat() != CSR || P.GetFormat() != CSR)
+        {
+            LOG_VERBOSE_INFO(
+                2, "*** warning: GlobalMatrix::TripleMatrixProduct() is performed in CSR format");
+
+            this->matrix_interior_.ConvertTo(format, blockdim);
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
 #endif
-            T_ext_row_ptr_recv.Allocate("row ptr recv", nrows_recv + 1);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::MatrixMult(const GlobalMatrix<ValueType>& A,
+                                             const GlobalMatrix<ValueType>& B)
+    {
+        log_debug(this, "GlobalMatrix::MatrixMult()", (const void*&)A, (const void*&)B);
+
+        assert(&A != this);
+        assert(&B != this);
+
+        assert(A.GetN() == B.GetM());
+        assert(A.pm_ != NULL);
+        assert(B.pm_ != NULL);
+        assert(this->is_host_() == A.is_host_());
+        assert(this->is_host_() == B.is_host_());
+
+#ifdef DEBUG_MODE
+        A.Check();
+        B.Check();
+#endif
+
+        // Calling global routine with single process
+        if(A.pm_->num_procs_ == 1)
+        {
+            this->matrix_interior_.MatrixMult(A.matrix_interior_, B.matrix_interior_);
+
+            this->CreateParallelManager_();
+
+            this->pm_self_->SetMPICommunicator(A.pm_->comm_);
+
+            this->pm_self_->SetGlobalNrow(this->matrix_interior_.GetM());
+            this->pm_self_->SetGlobalNcol(this->matrix_interior_.GetN());
+
+            this->pm_self_->SetLocalNrow(this->matrix_interior_.GetM());
+            this->pm_self_->SetLocalNcol(this->matrix_interior_.GetN());
+
+            return;
+        }
+
+        // Convert to CSR
+        unsigned int format   = this->GetFormat();
+        int          blockdim = this->matrix_interior_.GetBlockDimension();
+        this->ConvertToCSR();
+
+        // Local rows of AB, split into interior and ghost part. The structure of the product
+        // is kept for MatrixMultNumeric()
+        LocalMatrix<ValueType> AB_interior;
+        LocalMatrix<ValueType> AB_ghost;
+        LocalVector<int64_t>   ghost_col;
+        MatrixMultStructure*   structure = new MatrixMultStructure;
+
+        this->MatrixMultLocalRows_(A, B, &AB_interior, &AB_ghost, &ghost_col, structure, false);
+
+        // The rows of A are local, hence there is nothing to be sent back to neighbors. The
+        // manager is generated from the ghost of AB and the column ownership of B
+        this->SetFromInteriorGhost_(&AB_interior,
+                                    &AB_ghost,
+                                    ghost_col,
+                                    A.pm_->GetGlobalNrow(),
+                                    B.pm_->GetGlobalNcol(),
+                                    *B.pm_,
+                                    "AB");
+
+        // Setting the data clears the previous structure
+        this->mult_ = structure;
+
+        if(format != CSR || A.GetFormat() != CSR || B.GetFormat() != CSR)
+        {
+            LOG_VERBOSE_INFO(
+                2, "*** warning: GlobalMatrix::MatrixMult() is performed in CSR format");
+
+            this->matrix_interior_.ConvertTo(format, blockdim);
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::MatrixMultNumeric(const GlobalMatrix<ValueType>& A,
+                                                    const GlobalMatrix<ValueType>& B)
+    {
+        log_debug(this, "GlobalMatrix::MatrixMultNumeric()", (const void*&)A, (const void*&)B);
+
+        assert(&A != this);
+        assert(&B != this);
+
+        assert(A.GetN() == B.GetM());
+        assert(A.GetM() == this->GetM());
+        assert(B.GetN() == this->GetN());
+        assert(this->pm_ != NULL);
+        assert(this->is_host_() == A.is_host_());
+        assert(this->is_host_() == B.is_host_());
+
+#ifdef DEBUG_MODE
+        A.Check();
+        B.Check();
+#endif
+
+        // Calling global routine with single process
+        if(this->pm_->num_procs_ == 1)
+        {
+            this->matrix_interior_.MatrixMultNumeric(A.matrix_interior_, B.matrix_interior_);
+
+            return;
+        }
+
+        if(this->mult_ == NULL)
+        {
+            LOG_INFO("GlobalMatrix::MatrixMultNumeric() requires a previous MatrixMult()");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        // Convert to CSR
+        unsigned int format   = this->GetFormat();
+        int          blockdim = this->matrix_interior_.GetBlockDimension();
+        this->ConvertToCSR();
+
+        int64_t ghost_nnz = this->GetGhostNnz();
+
+        // Values of the local rows of AB, split into interior and ghost part. The split
+        // preserves the order of the entries, which is the order of the existing interior and
+        // ghost parts
+        LocalMatrix<ValueType> AB_interior;
+        LocalMatrix<ValueType> AB_ghost;
+
+        this->MatrixMultLocalRows_(A, B, &AB_interior, &AB_ghost, NULL, this->mult_, true);
+
+        assert(AB_interior.GetLocalNnz() == this->GetLocalNnz());
+        assert(AB_ghost.GetLocalNnz() == ghost_nnz);
+
+        // Only the values of AB are used, the structure is released on its backend
+        LocalVector<PtrType>   AB_row_ptr;
+        LocalVector<int>       AB_col;
+        LocalVector<ValueType> AB_val;
+
+        AB_row_ptr.CloneBackend(*this);
+        AB_col.CloneBackend(*this);
+        AB_val.CloneBackend(*this);
+
+        PtrType*   AB_csr_row_ptr = NULL;
+        int*       AB_csr_col_ind = NULL;
+        ValueType* AB_csr_val     = NULL;
+
+        // Update the interior values in place
+        AB_interior.LeaveDataPtrCSR(&AB_csr_row_ptr, &AB_csr_col_ind, &AB_csr_val);
+
+        AB_row_ptr.SetDataPtr(&AB_csr_row_ptr, "AB row ptr", this->pm_->GetLocalNrow() + 1);
+        AB_col.SetDataPtr(&AB_csr_col_ind, "AB col", this->GetLocalNnz());
+        AB_val.SetDataPtr(&AB_csr_val, "AB val", this->GetLocalNnz());
+
+        this->matrix_interior_.UpdateValuesCSR(AB_val);
+
+        AB_row_ptr.Clear();
+        AB_col.Clear();
+        AB_val.Clear();
+
+        // The ghost part is stored in COO format, its values are replaced
+        if(ghost_nnz > 0)
+        {
+            assert(this->matrix_ghost_.GetFormat() == COO);
+
+            AB_ghost.LeaveDataPtrCSR(&AB_csr_row_ptr, &AB_csr_col_ind, &AB_csr_val);
+
+            AB_row_ptr.SetDataPtr(&AB_csr_row_ptr, "AB row ptr", this->pm_->GetLocalNrow() + 1);
+            AB_col.SetDataPtr(&AB_csr_col_ind, "AB col", ghost_nnz);
+
+            int*       ghost_row = NULL;
+            int*       ghost_col = NULL;
+            ValueType* ghost_val = NULL;
+
+            this->matrix_ghost_.LeaveDataPtrCOO(&ghost_row, &ghost_col, &ghost_val);
+            this->matrix_ghost_.SetDataPtrCOO(&ghost_row,
+                                              &ghost_col,
+                                              &AB_csr_val,
+                                              "Ghost of " + this->object_name_,
+                                              ghost_nnz,
+                                              this->pm_->GetLocalNrow(),
+                                              this->pm_->GetNumReceivers());
+
+            AB_val.SetDataPtr(&ghost_val, "AB val", ghost_nnz);
+
+            AB_row_ptr.Clear();
+            AB_col.Clear();
+            AB_val.Clear();
+        }
+
+        if(format != CSR)
+        {
+            this->matrix_interior_.ConvertTo(format, blockdim);
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::MatrixAdd(const GlobalMatrix<ValueType>& A,
+                                            ValueType                      alpha,
+                                            const GlobalMatrix<ValueType>& B,
+                                            ValueType                      beta)
+    {
+        log_debug(this,
+                  "GlobalMatrix::MatrixAdd()",
+                  (const void*&)A,
+                  alpha,
+                  (const void*&)B,
+                  beta);
+
+        assert(&A != this);
+        assert(&B != this);
+
+        assert(A.GetM() == B.GetM());
+        assert(A.GetN() == B.GetN());
+        assert(A.GetLocalM() == B.GetLocalM());
+        assert(A.GetLocalN() == B.GetLocalN());
+        assert(A.pm_ != NULL);
+        assert(B.pm_ != NULL);
+        assert(this->is_host_() == A.is_host_());
+        assert(this->is_host_() == B.is_host_());
+
+#ifdef DEBUG_MODE
+        A.Check();
+        B.Check();
+#endif
+
+        // Convert to CSR
+        unsigned int format   = this->GetFormat();
+        int          blockdim = this->matrix_interior_.GetBlockDimension();
+        this->ConvertToCSR();
+
+        // Both matrices share the row and column distribution, thus the interior parts can
+        // be added directly
+        LocalMatrix<ValueType> A_int;
+        LocalMatrix<ValueType> B_int;
+
+        const LocalMatrix<ValueType>* A_int_ptr = &A.matrix_interior_;
+        const LocalMatrix<ValueType>* B_int_ptr = &B.matrix_interior_;
+
+        if(A_int_ptr->GetFormat() != CSR)
+        {
+            A_int.CloneFrom(*A_int_ptr);
+            A_int.ConvertToCSR();
+            A_int_ptr = &A_int;
+        }
+
+        if(B_int_ptr->GetFormat() != CSR)
+        {
+            B_int.CloneFrom(*B_int_ptr);
+            B_int.ConvertToCSR();
+            B_int_ptr = &B_int;
+        }
+
+        // Calling global routine with single process
+        if(A.pm_->num_procs_ == 1)
+        {
+            this->matrix_interior_.MatrixAdd(*A_int_ptr, alpha, *B_int_ptr, beta);
+            this->matrix_interior_.ConvertTo(format, blockdim);
+
+            this->CreateParallelManager_();
+
+            this->pm_self_->SetMPICommunicator(A.pm_->comm_);
+
+            this->pm_self_->SetGlobalNrow(this->matrix_interior_.GetM());
+            this->pm_self_->SetGlobalNcol(this->matrix_interior_.GetN());
+
+            this->pm_self_->SetLocalNrow(this->matrix_interior_.GetM());
+            this->pm_self_->SetLocalNcol(this->matrix_interior_.GetN());
+
+            return;
+        }
+
+        LocalMatrix<ValueType> C_interior;
+        C_interior.CloneBackend(*this);
+        C_interior.MatrixAdd(*A_int_ptr, alpha, *B_int_ptr, beta);
+
+        A_int.Clear();
+        B_int.Clear();
+
+        // The ghost parts refer to different ghost columns, they are merged in terms of
+        // global column ids. The ghost matrices are stored in COO format, thus scaled copies
+        // are converted to CSR.
+        LocalMatrix<ValueType> A_gst;
+        LocalMatrix<ValueType> B_gst;
+
+        A_gst.CloneFrom(A.matrix_ghost_);
+        B_gst.CloneFrom(B.matrix_ghost_);
+        A_gst.ConvertToCSR();
+        B_gst.ConvertToCSR();
+        A_gst.Scale(alpha);
+        B_gst.Scale(beta);
+
+        // Ghost mappings of A and B
+        LocalVector<int64_t> A_mapping;
+        LocalVector<int64_t> B_mapping;
+
+        A_mapping.CloneBackend(*this);
+        B_mapping.CloneBackend(*this);
+
+        A_mapping.Allocate("A ghost mapping", A.pm_->GetNumReceivers());
+        B_mapping.Allocate("B ghost mapping", B.pm_->GetNumReceivers());
+
+        A_mapping.CopyFromHostData(A.pm_->GetGhostToGlobalMap());
+        B_mapping.CopyFromHostData(B.pm_->GetGhostToGlobalMap());
+
+        // Global column ids of each ghost entry of B
+        LocalVector<int64_t> B_gst_col;
+        B_gst_col.CloneBackend(*this);
+        B_gst_col.Allocate("B ghost global columns", B_gst.GetNnz());
+
+        B_gst.matrix_->ExtractGlobalColumnIndices(0, 0, *B_mapping.vector_, B_gst_col.vector_);
+
+        B_mapping.Clear();
+
+        // Merged global ghost columns
+        LocalVector<int64_t> merged_col;
+        merged_col.CloneBackend(*this);
+
+        // Merge A ghost with B ghost
+        A_gst.CompressAdd(A_mapping, B_gst_col, B_gst, &merged_col);
+
+        A_mapping.Clear();
+        B_gst_col.Clear();
+        B_gst.Clear();
+
+        // Generate the manager from the merged ghost and the column ownership of A
+        this->SetFromInteriorGhost_(&C_interior,
+                                    &A_gst,
+                                    merged_col,
+                                    A.pm_->GetGlobalNrow(),
+                                    A.pm_->GetGlobalNcol(),
+                                    *A.pm_,
+                                    "A + B");
+
+        if(format != CSR || A.GetFormat() != CSR || B.GetFormat() != CSR)
+        {
+            LOG_VERBOSE_INFO(
+                2, "*** warning: GlobalMatrix::MatrixAdd() is performed in CSR format");
+
+            this->matrix_interior_.ConvertTo(format, blockdim);
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    // Computes the local rows of AB = A * B, where the rows of B that are required due to
+    // ghost columns of A are fetched from the neighbors. The columns of AB are the local
+    // columns of B followed by the additional ghost columns, with their global ids in l2g.
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::MatrixMultExtRows_(const GlobalMatrix<ValueType>& A,
+                                                     const LocalMatrix<ValueType>&  A_int,
+                                                     const LocalMatrix<ValueType>&  A_gst,
+                                                     const GlobalMatrix<ValueType>& B,
+                                                     const LocalMatrix<ValueType>&  B_int,
+                                                     const LocalMatrix<ValueType>&  B_gst,
+                                                     LocalMatrix<ValueType>*        AB,
+                                                     LocalVector<int64_t>*          l2g,
+                                                     MatrixMultStructure*           structure) const
+    {
+        assert(AB != NULL);
+        assert(l2g != NULL);
+
+        // Fetch boundary rows of B
+        // To compute AB = A * B we need to fetch additional rows of B, such that
+        // we can locally access all rows that do not belong to the current rank,
+        // but are required due to column dependencies.
+
+        // This means, we need to send all rows of B where A has a dependency on
+        // to the neighboring rank
+        int B_ext_m_send = A.pm_->GetNumSenders();
+        // Number of rows of B we receive from our neighbors
+        int B_ext_m_recv = A.pm_->GetNumReceivers();
+
+        // First, count the total number of non-zero entries per boundary row, including
+        // ghost part (we need to send full rows)
+        LocalVector<PtrType> B_ext_row_ptr_send;
+        B_ext_row_ptr_send.CloneBackend(*this);
+        B_ext_row_ptr_send.Allocate("B_ext_row_ptr_send", B_ext_m_send + 1);
+        B_int.matrix_->ExtractBoundaryRowNnz(
+            B_ext_row_ptr_send.vector_, *A.halo_.vector_, *B_gst.matrix_);
+
+        // We need the send buffer on host for communication
+        PtrType* hB_ext_row_nnz_send = NULL;
+        allocate_host(B_ext_m_send + 1, &hB_ext_row_nnz_send);
+        B_ext_row_ptr_send.CopyToHostData(hB_ext_row_nnz_send);
+
+        // Receive buffer
+        PtrType* hB_ext_row_ptr_recv = NULL;
+        allocate_host(B_ext_m_recv + 1, &hB_ext_row_ptr_recv);
+
+        // Initiate communication of nnz per row
+        A.pm_->CommunicateAsync_(hB_ext_row_nnz_send, hB_ext_row_ptr_recv);
+
+        // Exclusive sum to obtain row pointers of send buffer
+        PtrType B_ext_nnz_send = B_ext_row_ptr_send.ExclusiveSum();
+
+        // We need a copy of B_ext_row_ptr on host for the communication
+        PtrType* hB_ext_row_ptr_send = NULL;
+        allocate_host(B_ext_m_send + 1, &hB_ext_row_ptr_send);
+        B_ext_row_ptr_send.CopyToHostData(hB_ext_row_ptr_send);
+
+        if(structure != NULL)
+        {
+            structure->ext_row_ptr_send.assign(hB_ext_row_ptr_send,
+                                               hB_ext_row_ptr_send + B_ext_m_send + 1);
+        }
+
+        // Extract the ghost mapping of B
+        LocalVector<int64_t> B_mapping;
+        B_mapping.CloneBackend(*this);
+        B_mapping.Allocate("B ghost mapping", B.pm_->GetNumReceivers());
+        const int64_t* ghost_mapping = B.pm_->GetGhostToGlobalMap();
+        B_mapping.CopyFromHostData(ghost_mapping);
+
+        // Now, extract boundary column indices and values
+        LocalVector<int64_t>   B_ext_col_ind_send;
+        LocalVector<ValueType> B_ext_val_send;
+
+        B_ext_col_ind_send.CloneBackend(*this);
+        B_ext_val_send.CloneBackend(*this);
+
+        B_ext_col_ind_send.Allocate("B_ext_col_ind_send", B_ext_nnz_send);
+        B_ext_val_send.Allocate("B_ext_val_send", B_ext_nnz_send);
+
+        B_int.matrix_->ExtractBoundaryRows(*B_ext_row_ptr_send.vector_,
+                                           B_ext_col_ind_send.vector_,
+                                           B_ext_val_send.vector_,
+                                           B.pm_->GetGlobalColumnBegin(),
+                                           *A.halo_.vector_,
+                                           *B_mapping.vector_,
+                                           *B_gst.matrix_);
+
+        // We do not need this anymore
+        B_ext_row_ptr_send.Clear();
+
+        // Wait for nnz per row communication to finish
+        A.pm_->CommunicateSync_();
+
+        // Clean up
+        free_host(&hB_ext_row_nnz_send);
+
+        // Obtain row pointer array
+        // We can do this on the host, as the number of external rows is typically very small
+        // and skips h2d followed by d2h copy
+        LocalVector<PtrType> B_ext_row_ptr_recv;
+        B_ext_row_ptr_recv.SetDataPtr(&hB_ext_row_ptr_recv, "B_ext_row_ptr_recv", B_ext_m_recv + 1);
+
+        // Exclusive sum
+        PtrType B_ext_nnz_recv = B_ext_row_ptr_recv.ExclusiveSum();
+
+        // We need a copy of B_ext_row_ptr on host for the communication
+        B_ext_row_ptr_recv.LeaveDataPtr(&hB_ext_row_ptr_recv);
+
+        if(structure != NULL)
+        {
+            structure->ext_row_ptr_recv.assign(hB_ext_row_ptr_recv,
+                                               hB_ext_row_ptr_recv + B_ext_m_recv + 1);
+        }
+
+        // With GPU-aware MPI, column indices and values are exchanged directly from and into
+        // accelerator buffers. Only the row pointers are staged on the host, as they are
+        // required to set up the messages.
+        bool gpu_aware_mpi = (this->is_host_() == false && this->local_backend_.GPU_aware_MPI);
+
+        if(gpu_aware_mpi == true)
+        {
+            // Send buffers are written on the default stream, they need to be completed
+            // before MPI can access them
+            _rocalution_sync_default();
+        }
+        else
+        {
+            B_ext_col_ind_send.MoveToHost();
+            B_ext_val_send.MoveToHost();
+        }
+
+        // Send buffers
+        int64_t*   B_ext_col_ind_send_ptr = NULL;
+        ValueType* B_ext_val_send_ptr     = NULL;
+
+        B_ext_col_ind_send.LeaveDataPtr(&B_ext_col_ind_send_ptr);
+        B_ext_val_send.LeaveDataPtr(&B_ext_val_send_ptr);
+
+        // Receive buffers
+        LocalVector<int64_t>   B_ext_col_ind_recv;
+        LocalVector<ValueType> B_ext_val_recv;
+
+        if(gpu_aware_mpi == true)
+        {
+            B_ext_col_ind_recv.CloneBackend(*this);
+            B_ext_val_recv.CloneBackend(*this);
+        }
+
+        B_ext_col_ind_recv.Allocate("B_ext_col_ind_recv", B_ext_nnz_recv);
+        B_ext_val_recv.Allocate("B_ext_val_recv", B_ext_nnz_recv);
+
+        int64_t*   B_ext_col_ind_recv_ptr = NULL;
+        ValueType* B_ext_val_recv_ptr     = NULL;
+
+        B_ext_col_ind_recv.LeaveDataPtr(&B_ext_col_ind_recv_ptr);
+        B_ext_val_recv.LeaveDataPtr(&B_ext_val_recv_ptr);
+
+        // Initiate communication of column indices and values
+        A.pm_->CommunicateCSRAsync_(hB_ext_row_ptr_send,
+                                    B_ext_col_ind_send_ptr,
+                                    B_ext_val_send_ptr,
+                                    hB_ext_row_ptr_recv,
+                                    B_ext_col_ind_recv_ptr,
+                                    B_ext_val_recv_ptr);
+
+        // The local work that does not depend on the external rows of B overlaps with the
+        // communication
+
+        // Now, A interior need to be merged with its ghost part to obtain A_full
+        int64_t A_full_m   = A_int.GetM();
+        int64_t A_full_n   = A_int.GetN() + A_gst.GetN();
+        int64_t A_full_nnz = A_int.GetNnz() + A_gst.GetNnz();
+
+        LocalMatrix<ValueType> zero_matrix;
+        LocalVector<int>       zero_vector;
+        zero_matrix.CloneBackend(*this);
+        zero_vector.CloneBackend(*this);
+
+        LocalMatrix<ValueType> A_full;
+        A_full.CloneBackend(*this);
+        A_full.AllocateCSR("A full", A_full_nnz, A_full_m, A_full_n);
+        A_full.matrix_->MergeToLocal(
+            *A_int.matrix_, *A_gst.matrix_, *zero_matrix.matrix_, *zero_vector.vector_);
+
+        // Wait for additional column indices and values communication from B to finish
+        A.pm_->CommunicateCSRSync_();
+
+        // Clean up
+        free_host(&hB_ext_row_ptr_send);
+
+        B_ext_col_ind_send.SetDataPtr(&B_ext_col_ind_send_ptr, "", B_ext_nnz_send);
+        B_ext_val_send.SetDataPtr(&B_ext_val_send_ptr, "", B_ext_nnz_send);
+        B_ext_col_ind_send.Clear();
+        B_ext_val_send.Clear();
+
+        // Wrap received data into structure
+        B_ext_col_ind_recv.SetDataPtr(
+            &B_ext_col_ind_recv_ptr, "B_ext_col_ind_recv", B_ext_nnz_recv);
+        B_ext_val_recv.SetDataPtr(&B_ext_val_recv_ptr, "B_ext_val_recv", B_ext_nnz_recv);
+        B_ext_col_ind_recv.CloneBackend(*this);
+        B_ext_val_recv.CloneBackend(*this);
+
+        // Combine B ghost with the ghost part of the additional rows from neighbors
+        // in order to match the column indices when doing SpGEMM on the ghost part
+        LocalVector<int> B_gst_ext_local;
+
+        B_gst_ext_local.CloneBackend(*this);
+        l2g->CloneBackend(*this);
+
+        LocalVector<int> B_local_col;
+        B_local_col.CloneBackend(*this);
+        B_local_col.Allocate("local col", B_ext_nnz_recv);
+
+        B_gst.matrix_->CombineAndRenumber(B_int.GetN(),
+                                          B_ext_nnz_recv,
+                                          B.pm_->GetGlobalColumnBegin(),
+                                          B.pm_->GetGlobalColumnEnd(),
+                                          *B_mapping.vector_,
+                                          *B_ext_col_ind_recv.vector_,
+                                          B_gst_ext_local.vector_,
+                                          l2g->vector_,
+                                          B_local_col.vector_);
+
+        B_ext_col_ind_recv.Clear();
+
+        if(structure != NULL)
+        {
+            structure->ext_col.CloneFrom(B_local_col);
+            structure->gst_ext_local.CloneFrom(B_gst_ext_local);
+            structure->ext_ncol = l2g->GetSize();
+        }
+
+        // Wrap B ext into structure, on the backend of the product
+        B_ext_row_ptr_recv.SetDataPtr(&hB_ext_row_ptr_recv, "B_ext_row_ptr_recv", B_ext_m_recv + 1);
+        B_ext_row_ptr_recv.CloneBackend(*this);
+
+        PtrType*   B_ext_row_ptr = NULL;
+        int*       B_ext_col_ind = NULL;
+        ValueType* B_ext_val     = NULL;
+
+        B_ext_row_ptr_recv.LeaveDataPtr(&B_ext_row_ptr);
+        B_local_col.LeaveDataPtr(&B_ext_col_ind);
+        B_ext_val_recv.LeaveDataPtr(&B_ext_val);
+
+        LocalMatrix<ValueType> B_ext;
+        B_ext.CloneBackend(*this);
+        B_ext.SetDataPtrCSR(&B_ext_row_ptr,
+                            &B_ext_col_ind,
+                            &B_ext_val,
+                            "B ext",
+                            B_ext_nnz_recv,
+                            B_ext_m_recv,
+                            INT32_MAX);
+
+        // B_ext can potentially be unsorted, which might cause problems later on
+        B_ext.Sort();
+
+        int64_t B_full_ghost_n = l2g->GetSize();
+
+        // Merge B with the additional rows of B_ext in order to do the SpGEMM with A
+        LocalMatrix<ValueType> B_full;
+        B_full.CloneBackend(*this);
+        B_full.AllocateCSR("B full",
+                           B_int.GetNnz() + B_gst.GetNnz() + B_ext_nnz_recv,
+                           B_int.GetM() + B_ext_m_recv,
+                           B_int.GetN() + B_full_ghost_n);
+        B_full.matrix_->MergeToLocal(
+            *B_int.matrix_, *B_gst.matrix_, *B_ext.matrix_, *B_gst_ext_local.vector_);
+
+        B_ext.Clear();
+        B_gst_ext_local.Clear();
+
+        // Compute AB = A_full * B_full
+        AB->MatrixMult(A_full, B_full);
+
+        A_full.Clear();
+        B_full.Clear();
+
+        if(structure != NULL)
+        {
+            structure->product.CloneFrom(*AB);
+        }
+    }
+
+    // Numeric counterpart of MatrixMultExtRows_(). The boundary rows of B are fetched with the
+    // row pointers and local column ids of the given structure, such that only their values are
+    // exchanged, and the values of the local product are computed with its sparsity pattern.
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::MatrixMultExtRowsNumeric_(const GlobalMatrix<ValueType>& A,
+                                                            const LocalMatrix<ValueType>&  A_int,
+                                                            const LocalMatrix<ValueType>&  A_gst,
+                                                            const GlobalMatrix<ValueType>& B,
+                                                            const LocalMatrix<ValueType>&  B_int,
+                                                            const LocalMatrix<ValueType>&  B_gst,
+                                                            MatrixMultStructure* structure) const
+    {
+        assert(structure != NULL);
+
+        int B_ext_m_send = A.pm_->GetNumSenders();
+        int B_ext_m_recv = A.pm_->GetNumReceivers();
+
+        assert(static_cast<int>(structure->ext_row_ptr_send.size()) == B_ext_m_send + 1);
+        assert(static_cast<int>(structure->ext_row_ptr_recv.size()) == B_ext_m_recv + 1);
+
+        PtrType* hB_ext_row_ptr_send = structure->ext_row_ptr_send.data();
+        PtrType* hB_ext_row_ptr_recv = structure->ext_row_ptr_recv.data();
+
+        PtrType B_ext_nnz_send = hB_ext_row_ptr_send[B_ext_m_send];
+        PtrType B_ext_nnz_recv = hB_ext_row_ptr_recv[B_ext_m_recv];
+
+        // Row pointers of the boundary rows that are sent
+        LocalVector<PtrType> B_ext_row_ptr_send;
+        B_ext_row_ptr_send.CloneBackend(*this);
+        B_ext_row_ptr_send.Allocate("B_ext_row_ptr_send", B_ext_m_send + 1);
+        B_ext_row_ptr_send.CopyFromHostData(hB_ext_row_ptr_send);
+
+        // Extract the ghost mapping of B
+        LocalVector<int64_t> B_mapping;
+        B_mapping.CloneBackend(*this);
+        B_mapping.Allocate("B ghost mapping", B.pm_->GetNumReceivers());
+        B_mapping.CopyFromHostData(B.pm_->GetGhostToGlobalMap());
+
+        // Extract the boundary rows, only their values are sent
+        LocalVector<int64_t>   B_ext_col_ind_send;
+        LocalVector<ValueType> B_ext_val_send;
+
+        B_ext_col_ind_send.CloneBackend(*this);
+        B_ext_val_send.CloneBackend(*this);
+
+        B_ext_col_ind_send.Allocate("B_ext_col_ind_send", B_ext_nnz_send);
+        B_ext_val_send.Allocate("B_ext_val_send", B_ext_nnz_send);
+
+        B_int.matrix_->ExtractBoundaryRows(*B_ext_row_ptr_send.vector_,
+                                           B_ext_col_ind_send.vector_,
+                                           B_ext_val_send.vector_,
+                                           B.pm_->GetGlobalColumnBegin(),
+                                           *A.halo_.vector_,
+                                           *B_mapping.vector_,
+                                           *B_gst.matrix_);
+
+        B_ext_row_ptr_send.Clear();
+        B_ext_col_ind_send.Clear();
+        B_mapping.Clear();
+
+        // With GPU-aware MPI, the values are exchanged directly from and into accelerator
+        // buffers
+        bool gpu_aware_mpi = (this->is_host_() == false && this->local_backend_.GPU_aware_MPI);
+
+        if(gpu_aware_mpi == true)
+        {
+            _rocalution_sync_default();
+        }
+        else
+        {
+            B_ext_val_send.MoveToHost();
+        }
+
+        LocalVector<ValueType> B_ext_val_recv;
+
+        if(gpu_aware_mpi == true)
+        {
+            B_ext_val_recv.CloneBackend(*this);
+        }
+
+        B_ext_val_recv.Allocate("B_ext_val_recv", B_ext_nnz_recv);
+
+        ValueType* B_ext_val_send_ptr = NULL;
+        ValueType* B_ext_val_recv_ptr = NULL;
+
+        B_ext_val_send.LeaveDataPtr(&B_ext_val_send_ptr);
+        B_ext_val_recv.LeaveDataPtr(&B_ext_val_recv_ptr);
+
+        // Initiate communication of the values, the column indices are known
+        A.pm_->CommunicateCSRAsync_(hB_ext_row_ptr_send,
+                                    static_cast<int64_t*>(NULL),
+                                    B_ext_val_send_ptr,
+                                    hB_ext_row_ptr_recv,
+                                    static_cast<int64_t*>(NULL),
+                                    B_ext_val_recv_ptr);
+
+        // Merge A interior and ghost part while the values are exchanged
+        LocalMatrix<ValueType> zero_matrix;
+        LocalVector<int>       zero_vector;
+        zero_matrix.CloneBackend(*this);
+        zero_vector.CloneBackend(*this);
+
+        LocalMatrix<ValueType> A_full;
+        A_full.CloneBackend(*this);
+        A_full.AllocateCSR("A full",
+                           A_int.GetNnz() + A_gst.GetNnz(),
+                           A_int.GetM(),
+                           A_int.GetN() + A_gst.GetN());
+        A_full.matrix_->MergeToLocal(
+            *A_int.matrix_, *A_gst.matrix_, *zero_matrix.matrix_, *zero_vector.vector_);
+
+        A.pm_->CommunicateCSRSync_();
+
+        B_ext_val_send.SetDataPtr(&B_ext_val_send_ptr, "", B_ext_nnz_send);
+        B_ext_val_send.Clear();
+
+        B_ext_val_recv.SetDataPtr(&B_ext_val_recv_ptr, "B_ext_val_recv", B_ext_nnz_recv);
+        B_ext_val_recv.CloneBackend(*this);
+
+        // Wrap B ext into structure, using the local column ids of the structure
+        LocalVector<PtrType> B_ext_row_ptr_recv;
+        LocalVector<int>     B_ext_col;
+
+        B_ext_row_ptr_recv.CloneBackend(*this);
+        B_ext_row_ptr_recv.Allocate("B_ext_row_ptr_recv", B_ext_m_recv + 1);
+        B_ext_row_ptr_recv.CopyFromHostData(hB_ext_row_ptr_recv);
+
+        B_ext_col.CloneFrom(structure->ext_col);
+
+        PtrType*   B_ext_row_ptr = NULL;
+        int*       B_ext_col_ind = NULL;
+        ValueType* B_ext_val     = NULL;
+
+        B_ext_row_ptr_recv.LeaveDataPtr(&B_ext_row_ptr);
+        B_ext_col.LeaveDataPtr(&B_ext_col_ind);
+        B_ext_val_recv.LeaveDataPtr(&B_ext_val);
+
+        LocalMatrix<ValueType> B_ext;
+        B_ext.CloneBackend(*this);
+        B_ext.SetDataPtrCSR(&B_ext_row_ptr,
+                            &B_ext_col_ind,
+                            &B_ext_val,
+                            "B ext",
+                            B_ext_nnz_recv,
+                            B_ext_m_recv,
+                            INT32_MAX);
+
+        // Same ordering as in MatrixMultExtRows_()
+        B_ext.Sort();
+
+        // Merge B with the additional rows of B_ext
+        LocalMatrix<ValueType> B_full;
+        B_full.CloneBackend(*this);
+        B_full.AllocateCSR("B full",
+                           B_int.GetNnz() + B_gst.GetNnz() + B_ext_nnz_recv,
+                           B_int.GetM() + B_ext_m_recv,
+                           B_int.GetN() + structure->ext_ncol);
+        B_full.matrix_->MergeToLocal(
+            *B_int.matrix_, *B_gst.matrix_, *B_ext.matrix_, *structure->gst_ext_local.vector_);
+
+        B_ext.Clear();
+
+        // Values of AB = A_full * B_full, keeping the sparsity pattern of the product
+        structure->product.MatrixMultNumeric(A_full, B_full);
+    }
+
+    // Computes the local rows of AB = A * B in CSR format, split into interior and ghost part.
+    // The ghost part is returned with global column ids in gst_col and the structure of the
+    // product is stored in structure. In the numeric case, only the values of the product are
+    // computed, using the given structure, and gst_col is not required.
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::MatrixMultLocalRows_(const GlobalMatrix<ValueType>& A,
+                                                       const GlobalMatrix<ValueType>& B,
+                                                       LocalMatrix<ValueType>*        interior,
+                                                       LocalMatrix<ValueType>*        ghost,
+                                                       LocalVector<int64_t>*          gst_col,
+                                                       MatrixMultStructure*           structure,
+                                                       bool                           numeric) const
+    {
+        assert(interior != NULL);
+        assert(ghost != NULL);
+        assert(structure != NULL);
+        assert(numeric == true || gst_col != NULL);
+
+        // Only CSR matrices are supported
+        LocalMatrix<ValueType> A_int;
+        LocalMatrix<ValueType> A_gst;
+        LocalMatrix<ValueType> B_int;
+        LocalMatrix<ValueType> B_gst;
+
+        const LocalMatrix<ValueType>* A_int_ptr = &A.matrix_interior_;
+        const LocalMatrix<ValueType>* A_gst_ptr = &A.matrix_ghost_;
+        const LocalMatrix<ValueType>* B_int_ptr = &B.matrix_interior_;
+        const LocalMatrix<ValueType>* B_gst_ptr = &B.matrix_ghost_;
+
+        if(A_int_ptr->GetFormat() != CSR)
+        {
+            A_int.CloneFrom(*A_int_ptr);
+            A_int.ConvertToCSR();
+            A_int_ptr = &A_int;
+        }
+
+        if(A_gst_ptr->GetFormat() != CSR)
+        {
+            A_gst.CloneFrom(*A_gst_ptr);
+            A_gst.ConvertToCSR();
+            A_gst_ptr = &A_gst;
+        }
+
+        if(B_int_ptr->GetFormat() != CSR)
+        {
+            B_int.CloneFrom(*B_int_ptr);
+            B_int.ConvertToCSR();
+            B_int_ptr = &B_int;
+        }
+
+        if(B_gst_ptr->GetFormat() != CSR)
+        {
+            B_gst.CloneFrom(*B_gst_ptr);
+            B_gst.ConvertToCSR();
+            B_gst_ptr = &B_gst;
+        }
+
+        // Compute AB = A * B, the additional rows of B are fetched from the neighbors
+        LocalMatrix<ValueType> AB_full;
+        LocalVector<int64_t>   l2g;
+
+        AB_full.CloneBackend(*this);
+
+        if(numeric == true)
+        {
+            this->MatrixMultExtRowsNumeric_(
+                A, *A_int_ptr, *A_gst_ptr, B, *B_int_ptr, *B_gst_ptr, structure);
+        }
+        else
+        {
+            this->MatrixMultExtRows_(
+                A, *A_int_ptr, *A_gst_ptr, B, *B_int_ptr, *B_gst_ptr, &AB_full, &l2g, structure);
+        }
+
+        // The product of the numeric pass is held by the structure
+        const LocalMatrix<ValueType>& AB = (numeric == true) ? structure->product : AB_full;
+
+        // Split AB into interior and ghost, the interior columns are the local columns of B
+        int64_t AB_m     = AB.GetLocalM();
+        int64_t AB_int_n = B_int_ptr->GetLocalN();
+
+        A_int.Clear();
+        A_gst.Clear();
+        B_int.Clear();
+        B_gst.Clear();
+
+        interior->CloneBackend(*this);
+        ghost->CloneBackend(*this);
+
+        if(AB_m == AB_int_n)
+        {
+            AB.matrix_->SplitInteriorGhost(interior->matrix_, ghost->matrix_);
+        }
+        else
+        {
+            // SplitInteriorGhost() requires a square interior
+            AB.ExtractSubMatrix(0, 0, AB_m, AB_int_n, interior);
+            AB.ExtractSubMatrix(0, AB_int_n, AB_m, AB.GetLocalN() - AB_int_n, ghost);
+        }
+
+        AB_full.Clear();
+
+        if(numeric == true)
+        {
+            return;
+        }
+
+        // Transform the ghost columns to global column ids
+        gst_col->CloneBackend(*this);
+        gst_col->Allocate("ghost col", ghost->GetLocalNnz());
+
+        ghost->matrix_->ExtractGlobalColumnIndices(0, 0, *l2g.vector_, gst_col->vector_);
+    }
+
+    // Generates the parallel manager of this matrix from the distinct global ghost columns of
+    // the given interior and ghost part, using the column ownership of the parent manager, and
+    // takes over the data of both parts.
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::SetFromInteriorGhost_(LocalMatrix<ValueType>*     interior,
+                                                        LocalMatrix<ValueType>*     ghost,
+                                                        const LocalVector<int64_t>& ghost_col,
+                                                        int64_t                     global_nrow,
+                                                        int64_t                     global_ncol,
+                                                        const ParallelManager&      parent,
+                                                        const std::string&          name)
+    {
+        assert(interior != NULL);
+        assert(ghost != NULL);
+
+        // Generate PM
+        this->CreateParallelManager_();
+        this->pm_self_->SetMPICommunicator(parent.comm_);
+
+        // To generate the parallel manager, we need the distinct global ghost column ids
+        int64_t* pghost_col = NULL;
+        int64_t  nghost_col = unique_ghost_columns(ghost_col, &pghost_col);
+
+        this->pm_self_->SetGlobalNrow(global_nrow);
+        this->pm_self_->SetGlobalNcol(global_ncol);
+
+        this->pm_self_->SetLocalNrow(interior->GetLocalM());
+        this->pm_self_->SetLocalNcol(interior->GetLocalN());
+
+        // Generate the manager from the ghost columns and the manager of the parent
+        this->pm_self_->GenerateFromGhostColumnsWithParent_(nghost_col, pghost_col, parent);
+
+        // Communicate global offsets
+        this->pm_self_->CommunicateGlobalOffsetAsync_();
+
+        // Clear
+        free_host(&pghost_col);
+
+        // Sync global offsets communication
+        this->pm_self_->CommunicateGlobalOffsetSync_();
+
+        // Convert global boundary index to local index
+        this->pm_self_->BoundaryTransformGlobalToLocal_();
+
+        // Communicate ghost to global map
+        this->pm_self_->CommunicateGhostToGlobalMapAsync_();
+
+        // Renumber ghost columns (from global to local)
+        ghost->matrix_->RenumberGlobalToLocal(*ghost_col.vector_);
+
+        // Synchronize
+        this->pm_self_->CommunicateGhostToGlobalMapSync_();
+
+        this->SetParallelManager(*this->pm_self_);
+
+        int64_t ghost_nnz = ghost->GetLocalNnz();
+
+        PtrType*   ghost_csr_row_ptr = NULL;
+        int*       ghost_csr_col_ind = NULL;
+        ValueType* ghost_csr_val     = NULL;
+
+        ghost->LeaveDataPtrCSR(&ghost_csr_row_ptr, &ghost_csr_col_ind, &ghost_csr_val);
+
+        // Obtain raw pointers
+        int64_t interior_nnz = interior->GetLocalNnz();
+
+        PtrType*   interior_csr_row_ptr = NULL;
+        int*       interior_csr_col_ind = NULL;
+        ValueType* interior_csr_val     = NULL;
+
+        interior->LeaveDataPtrCSR(&interior_csr_row_ptr, &interior_csr_col_ind, &interior_csr_val);
+
+        this->SetDataPtrCSR(&interior_csr_row_ptr,
+                            &interior_csr_col_ind,
+                            &interior_csr_val,
+                            &ghost_csr_row_ptr,
+                            &ghost_csr_col_ind,
+                            &ghost_csr_val,
+                            name,
+                            interior_nnz,
+                            ghost_nnz);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ReadFileMTX(const std::string& filename)
+    {
+        log_debug(this, "GlobalMatrix::ReadFileMTX()", filename);
+
+        assert(this->pm_ != NULL);
+        assert(this->pm_->Status() == true);
+
+        // Read header file
+        std::ifstream headfile(filename.c_str(), std::ifstream::in);
+
+        if(!headfile.is_open())
+        {
+            LOG_INFO("Cannot open GlobalMatrix file [read]: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        // Go to this ranks line in the headfile
+        for(int i = 0; i < this->pm_->rank_; ++i)
+        {
+            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+
+        std::string interior_name;
+        std::string ghost_name;
+
+        std::getline(headfile, interior_name);
+        std::getline(headfile, ghost_name);
+
+        headfile.close();
+
+        // Extract directory containing the subfiles
+        size_t      found = filename.find_last_of("\\/");
+        std::string path  = filename.substr(0, found + 1);
+
+        interior_name.erase(remove_if(interior_name.begin(), interior_name.end(), isspace),
+                            interior_name.end());
+        ghost_name.erase(remove_if(ghost_name.begin(), ghost_name.end(), isspace),
+                         ghost_name.end());
 
-#ifndef SUPPORT_RDMA
-            T_ext_row_ptr_send.MoveToHost();
-#endif
+        this->matrix_interior_.ReadFileMTX(path + interior_name);
+        this->matrix_ghost_.ReadFileMTX(path + ghost_name);
 
-            // Get host pointers for communication
-            T_ext_row_ptr_recv.LeaveDataPtr(&pT_ext_row_ptr_recv);
-            T_ext_row_ptr_send.LeaveDataPtr(&pT_ext_row_nnz_send);
+        // Convert ghost matrix to COO
+        this->matrix_ghost_.ConvertToCOO();
 
-            // Initiate communication of nnz per row
-            this->pm_->InverseCommunicateAsync_(pT_ext_row_nnz_send, pT_ext_row_ptr_recv);
+        this->object_name_ = filename;
 
-            // Extract column indices and transform them to global indices (for sending)
-            LocalVector<int64_t> T_ext_col_ind_send;
-            T_ext_col_ind_send.CloneBackend(*this);
-            T_ext_col_ind_send.Allocate("col ind send", T_ext.GetNnz());
+        // Initialize communication pattern
+        this->InitCommPattern_();
+    }
 
-            T_ext.matrix_->ExtractGlobalColumnIndices(T_ext.GetN(),
-                                                      this->pm_->GetGlobalRowBegin(),
-                                                      *global_zero.vector_,
-                                                      T_ext_col_ind_send.vector_);
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::WriteFileMTX(const std::string& filename) const
+    {
+        log_debug(this, "GlobalMatrix::WriteFileMTX()", filename);
 
-            // Wait for nnz per row communication to finish
-            this->pm_->InverseCommunicateSync_();
+        assert(this->pm_ != NULL);
 
-            // Clean up
-            free_host(&pT_ext_row_nnz_send);
+        // Master rank writes the global headfile
+        if(this->pm_->rank_ == 0)
+        {
+            std::ofstream headfile;
 
-            // Put receive buffer back in structure
-            T_ext_row_ptr_recv.SetDataPtr(&pT_ext_row_ptr_recv, "row ptr recv", nrows_recv + 1);
+            headfile.open((char*)filename.c_str(), std::ofstream::out);
+            if(!headfile.is_open())
+            {
+                LOG_INFO("Cannot open GlobalMatrix file [write]: " << filename);
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
 
-#ifndef SUPPORT_RDMA
-            T_ext_row_ptr_recv.CloneBackend(*this);
-#endif
+            for(int i = 0; i < this->pm_->num_procs_; ++i)
+            {
+                std::ostringstream rs;
+                rs << i;
 
-            // Exclusive sum to obtain recv row pointers
-            PtrType nnz_recv = T_ext_row_ptr_recv.ExclusiveSum();
+                std::string interior_name = filename + ".interior.rank." + rs.str();
+                std::string ghost_name    = filename + ".ghost.rank." + rs.str();
 
-            // Prepare receive buffers
-            int64_t*   pT_ext_col_ind_recv = NULL;
-            ValueType* pT_ext_val_recv     = NULL;
+                headfile << interior_name << "\n";
+                headfile << ghost_name << "\n";
+            }
 
-            LocalVector<int64_t>   T_ext_col_ind_recv;
-            LocalVector<ValueType> T_ext_val_recv;
+            headfile.close();
+        }
 
-#ifdef SUPPORT_RDMA
-            T_ext_col_ind_recv.CloneBackend(*this);
-            T_ext_val_recv.CloneBackend(*this);
-#endif
+        std::ostringstream rs;
+        rs << this->pm_->rank_;
 
-            T_ext_col_ind_recv.Allocate("col ind recv", nnz_recv);
-            T_ext_val_recv.Allocate("val recv", nnz_recv);
+        std::string interior_name = filename + ".interior.rank." + rs.str();
+        std::string ghost_name    = filename + ".ghost.rank." + rs.str();
 
-            T_ext_col_ind_recv.LeaveDataPtr(&pT_ext_col_ind_recv);
-            T_ext_val_recv.LeaveDataPtr(&pT_ext_val_recv);
+        this->matrix_interior_.WriteFileMTX(interior_name);
+        this->matrix_ghost_.WriteFileMTX(ghost_name);
+    }
 
-            // Prepare send buffers
-            int64_t*   pT_ext_col_ind_send_global = NULL;
-            PtrType*   pT_ext_row_ptr_send        = NULL;
-            int*       pT_ext_col_ind_send        = NULL;
-            ValueType* pT_ext_val_send            = NULL;
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ReadFileCSR(const std::string& filename)
+    {
+        log_debug(this, "GlobalMatrix::ReadFileCSR()", filename);
 
-#ifndef SUPPORT_RDMA
-            T_ext_row_ptr_recv.MoveToHost();
-            T_ext_col_ind_send.MoveToHost();
-            T_ext.MoveToHost();
-#endif
+        assert(this->pm_ != NULL);
+        assert(this->pm_->Status() == true);
 
-            T_ext_row_ptr_recv.LeaveDataPtr(&pT_ext_row_ptr_recv);
-            T_ext_col_ind_send.LeaveDataPtr(&pT_ext_col_ind_send_global);
-            T_ext.LeaveDataPtrCSR(&pT_ext_row_ptr_send, &pT_ext_col_ind_send, &pT_ext_val_send);
+        // Read header file
+        std::ifstream headfile(filename.c_str(), std::ifstream::in);
 
-            // Initiate communication of column indices and values
-            this->pm_->InverseCommunicateCSRAsync_(pT_ext_row_ptr_send,
-                                                   pT_ext_col_ind_send_global,
-                                                   pT_ext_val_send,
-                                                   pT_ext_row_ptr_recv,
-                                                   pT_ext_col_ind_recv,
-                                                   pT_ext_val_recv);
+        if(!headfile.is_open())
+        {
+            LOG_INFO("Cannot open GlobalMatrix file [read]: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-            // Perform interior transpose while we do the communication
-            this->matrix_interior_.Transpose(&T->matrix_interior_);
+        // Go to this ranks line in the headfile
+        for(int i = 0; i < this->pm_->rank_; ++i)
+        {
+            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
 
-            // Wait for additional column indices and values communication to finish
-            this->pm_->InverseCommunicateCSRSync_();
+        std::string interior_name;
+        std::string ghost_name;
 
-            // Now we can clear T ext related send buffers
-            free_host(&pT_ext_row_ptr_send);
-            free_host(&pT_ext_col_ind_send);
-            free_host(&pT_ext_val_send);
-            free_host(&pT_ext_col_ind_send_global);
+        std::getline(headfile, interior_name);
+        std::getline(headfile, ghost_name);
 
-            // Setup manager of T
+        headfile.close();
 
-            // Start with a clean manager
-            T->CreateParallelManager_();
+        // Extract directory containing the subfiles
+        size_t      found = filename.find_last_of("\\/");
+        std::string path  = filename.substr(0, found + 1);
 
-            // Same communicator as initial matrix
-            T->pm_self_->SetMPICommunicator(this->pm_->comm_);
+        interior_name.erase(remove_if(interior_name.begin(), interior_name.end(), isspace),
+                            interior_name.end());
+        ghost_name.erase(remove_if(ghost_name.begin(), ghost_name.end(), isspace),
+                         ghost_name.end());
 
-            // Sizes of the transposed
-            T->pm_self_->SetGlobalNrow(this->pm_->global_ncol_);
-            T->pm_self_->SetGlobalNcol(this->pm_->global_nrow_);
-            T->pm_self_->SetLocalNrow(this->pm_->local_ncol_);
-            T->pm_self_->SetLocalNcol(this->pm_->local_nrow_);
+        this->matrix_interior_.ReadFileCSR(path + interior_name);
+        this->matrix_ghost_.ReadFileCSR(path + ghost_name);
 
-            // Put the global column indices back into structure
-            T_ext_col_ind_recv.SetDataPtr(&pT_ext_col_ind_recv, "col ind recv", nnz_recv);
-            T_ext_col_ind_recv.CloneBackend(*this);
+        // Convert ghost matrix to COO
+        this->matrix_ghost_.ConvertToCOO();
 
-            // To generate the parallel manager, we need to access the sorted global ghost column ids
-            LocalVector<int64_t> sorted_ghost_col;
-            sorted_ghost_col.CloneBackend(*this);
-            sorted_ghost_col.Allocate("sorted global ghost columns", T_ext_col_ind_recv.GetSize());
+        this->object_name_ = filename;
 
-            // Sort the global ghost columns (we do not need the permutation vector)
-            T_ext_col_ind_recv.Sort(&sorted_ghost_col, NULL);
+        // Initialize communication pattern
+        this->InitCommPattern_();
+    }
 
-            // Get the sorted ghost columns on host
-            int64_t* pghost_col = NULL;
-            sorted_ghost_col.MoveToHost();
-            sorted_ghost_col.LeaveDataPtr(&pghost_col);
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::WriteFileCSR(const std::string& filename) const
+    {
+        log_debug(this, "GlobalMatrix::WriteFileCSR()", filename);
 
-            // Generate the manager from ghost of T and manager of non-transposed
-            T->pm_self_->GenerateFromGhostColumnsWithParent_(
-                nnz_recv, pghost_col, *this->pm_, true);
+        assert(this->pm_ != NULL);
 
-            // Communicate global offsets
-            T->pm_self_->CommunicateGlobalOffsetAsync_();
+        // Master rank writes the global headfile
+        if(this->pm_->rank_ == 0)
+        {
+            std::ofstream headfile;
 
-            // Clear
-            free_host(&pghost_col);
+            headfile.open((char*)filename.c_str(), std::ofstream::out);
+            if(!headfile.is_open())
+            {
+                LOG_INFO("Cannot open GlobalMatrix file [write]: " << filename);
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
 
-            // Wrap received data into structure
-            T_ext_row_ptr_recv.SetDataPtr(&pT_ext_row_ptr_recv, "row ptr recv", nrows_recv + 1);
-            T_ext_val_recv.SetDataPtr(&pT_ext_val_recv, "val recv", nnz_recv);
+            for(int i = 0; i < this->pm_->num_procs_; ++i)
+            {
+                std::ostringstream rs;
+                rs << i;
 
-#ifndef SUPPORT_RDMA
-            T_ext_row_ptr_recv.CloneBackend(*this);
-            T_ext_val_recv.CloneBackend(*this);
-#endif
+                std::string interior_name = filename + ".interior.rank." + rs.str();
+                std::string ghost_name    = filename + ".ghost.rank." + rs.str();
 
-            T->pm_self_->CommunicateGlobalOffsetSync_();
+                headfile << interior_name << "\n";
+                headfile << ghost_name << "\n";
+            }
+        }
 
-            // Convert global boundary index into local index
-            T->pm_self_->BoundaryTransformGlobalToLocal_();
+        std::ostringstream rs;
+        rs << this->pm_->rank_;
 
-            // Communicate ghost to global map
-            T->pm_self_->CommunicateGhostToGlobalMapAsync_();
+        std::string interior_name = filename + ".interior.rank." + rs.str();
+        std::string ghost_name    = filename + ".ghost.rank." + rs.str();
 
-            // Allocate T ghost
-            T->matrix_ghost_.AllocateCSR(
-                "ghost", nnz_recv, T->pm_self_->local_nrow_, T->pm_self_->local_ncol_);
+        this->matrix_interior_.WriteFileCSR(interior_name);
+        this->matrix_ghost_.WriteFileCSR(ghost_name);
+    }
 
-            // Finally generate the ghost of T (global columns)
-            LocalVector<int64_t> T_ext_cols;
-            T_ext_cols.CloneBackend(*this);
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ReadFileRSIO(const std::string& filename,
+                                               bool               maintain_initial_format)
+    {
+        log_debug(this, "GlobalMatrix::ReadFileRSIO()", filename);
 
-            T->matrix_ghost_.matrix_->CopyGhostFromGlobalReceive(*this->halo_.vector_,
-                                                                 *T_ext_row_ptr_recv.vector_,
-                                                                 *T_ext_col_ind_recv.vector_,
-                                                                 *T_ext_val_recv.vector_,
-                                                                 T_ext_cols.vector_);
+        assert(this->pm_ != NULL);
+        assert(this->pm_->Status() == true);
+
+        // Read header file
+        std::ifstream headfile(filename.c_str(), std::ifstream::in);
+
+        if(!headfile.is_open())
+        {
+            LOG_INFO("Cannot open GlobalMatrix file [read]: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        // Go to this ranks line in the headfile
+        for(int i = 0; i < this->pm_->rank_; ++i)
+        {
+            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+
+        std::string interior_name;
+        std::string ghost_name;
+
+        std::getline(headfile, interior_name);
+        std::getline(headfile, ghost_name);
+
+        headfile.close();
+
+        // Extract directory containing the subfiles
+        size_t      found = filename.find_last_of("\\/");
+        std::string path  = filename.substr(0, found + 1);
 
-            // Transform global to local ghost columns
-            T->matrix_ghost_.matrix_->RenumberGlobalToLocal(*T_ext_cols.vector_);
+        interior_name.erase(remove_if(interior_name.begin(), interior_name.end(), isspace),
+                            interior_name.end());
+        ghost_name.erase(remove_if(ghost_name.begin(), ghost_name.end(), isspace),
+                         ghost_name.end());
 
-            // Synchronize
-            T->pm_self_->CommunicateGhostToGlobalMapSync_();
+        this->matrix_interior_.ReadFileRSIO(path + interior_name, maintain_initial_format);
+        this->matrix_ghost_.ReadFileRSIO(path + ghost_name);
 
-            T->SetParallelManager(*T->pm_self_);
-        }
+        // Convert ghost matrix to COO
+        this->matrix_ghost_.ConvertToCOO();
 
-#ifdef DEBUG_MODE
-        T->Check();
-#endif
+        this->object_name_ = filename;
+
+        // Initialize communication pattern
+        this->InitCommPattern_();
     }
 
     template <typename ValueType>
-    void GlobalMatrix<ValueType>::TripleMatrixProduct(const GlobalMatrix<ValueType>& R,
-                                                      const GlobalMatrix<ValueType>& A,
-                                                      const GlobalMatrix<ValueType>& P)
+    void GlobalMatrix<ValueType>::WriteFileRSIO(const std::string& filename, bool compress) const
     {
-        log_debug(this,
-                  "GlobalMatrix::TripleMatrixProduct()",
-                  (const void*&)R,
-                  (const void*&)A,
-                  (const void*&)P);
+        log_debug(this, "GlobalMatrix::WriteFileRSIO()", filename, compress);
 
-        assert(&R != this);
-        assert(&A != this);
-        assert(&P != this);
-
-        assert(R.GetN() == A.GetM());
-        assert(A.GetN() == P.GetM());
-        assert(this->is_host_() == R.is_host_());
-        assert(this->is_host_() == A.is_host_());
-        assert(this->is_host_() == P.is_host_());
-
-#ifdef DEBUG_MODE
-        R.Check();
-        A.Check();
-        P.Check();
-#endif
+        assert(this->pm_ != NULL);
 
-        // Calling global routine with single process
-        if(this->pm_ == NULL || this->pm_->num_procs_ == 1)
+        // Master rank writes the global headfile
+        if(this->pm_->rank_ == 0)
         {
-            this->matrix_interior_.TripleMatrixProduct(
-                R.matrix_interior_, A.matrix_interior_, P.matrix_interior_);
-
-            this->CreateParallelManager_();
+            std::ofstream headfile;
 
-            this->pm_self_->SetMPICommunicator(A.pm_->comm_);
+            headfile.open((char*)filename.c_str(), std::ofstream::out);
+            if(!headfile.is_open())
+            {
+                LOG_INFO("Cannot open GlobalMatrix file [write]: " << filename);
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
 
-            this->pm_self_->SetGlobalNrow(this->matrix_interior_.GetM());
-            this->pm_self_->SetGlobalNcol(this->matrix_interior_.GetN());
+            for(int i = 0; i < this->pm_->num_procs_; ++i)
+            {
+                std::ostringstream rs;
+                rs << i;
 
-            this->pm_self_->SetLocalNrow(this->matrix_interior_.GetM());
-            this->pm_self_->SetLocalNcol(this->matrix_interior_.GetN());
+                std::string interior_name = filename + ".interior.rank." + rs.str();
+                std::string ghost_name    = filename + ".ghost.rank." + rs.str();
 
-            return;
+                headfile << interior_name << "\n";
+                headfile << ghost_name << "\n";
+            }
         }
 
-        // Only CSR matrices are supported
-        LocalMatrix<ValueType> R_int;
-        LocalMatrix<ValueType> R_gst;
-        LocalMatrix<ValueType> A_int;
-        LocalMatrix<ValueType> A_gst;
-        LocalMatrix<ValueType> P_int;
-        LocalMatrix<ValueType> P_gst;
-
-        const LocalMatrix<ValueType>* R_int_ptr = &R.matrix_interior_;
-        const LocalMatrix<ValueType>* R_gst_ptr = &R.matrix_ghost_;
-        const LocalMatrix<ValueType>* A_int_ptr = &A.matrix_interior_;
-        const LocalMatrix<ValueType>* A_gst_ptr = &A.matrix_ghost_;
-        const LocalMatrix<ValueType>* P_int_ptr = &P.matrix_interior_;
-        const LocalMatrix<ValueType>* P_gst_ptr = &P.matrix_ghost_;
-
-        if(R_int_ptr->GetFormat() != CSR)
-        {
-            R_int.CloneFrom(*R_int_ptr);
-            R_int.ConvertToCSR();
-            R_int_ptr = &R_int;
-        }
+        std::ostringstream rs;
+        rs << this->pm_->rank_;
 
-        if(A_int_ptr->GetFormat() != CSR)
-        {
-            A_int.CloneFrom(*A_int_ptr);
-            A_int.ConvertToCSR();
-            A_int_ptr = &A_int;
-        }
+        std::string interior_name = filename + ".interior.rank." + rs.str();
+        std::string ghost_name    = filename + ".ghost.rank." + rs.str();
 
-        if(A_gst_ptr->GetFormat() != CSR)
-        {
-            A_gst.CloneFrom(*A_gst_ptr);
-            A_gst.ConvertToCSR();
-            A_gst_ptr = &A_gst;
-        }
+        this->matrix_interior_.WriteFileRSIO(interior_name, compress);
+        this->matrix_ghost_.WriteFileRSIO(ghost_name, compress);
+    }
 
-        if(P_int_ptr->GetFormat() != CSR)
-        {
-            P_int.CloneFrom(*P_int_ptr);
-            P_int.ConvertToCSR();
-            P_int_ptr = &P_int;
-        }
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ReadFileDistributedCSR(const std::string& filename,
+                                                         ParallelManager*   pm)
+    {
+        log_debug(this, "GlobalMatrix::ReadFileDistributedCSR()", filename, pm);
 
-        if(P_gst_ptr->GetFormat() != CSR)
-        {
-            P_gst.CloneFrom(*P_gst_ptr);
-            P_gst.ConvertToCSR();
-            P_gst_ptr = &P_gst;
-        }
+        this->ReadFileDistributed_(filename, false, pm);
+    }
 
-        // Convert to CSR
-        unsigned int format   = this->GetFormat();
-        int          blockdim = this->matrix_interior_.GetBlockDimension();
-        this->ConvertToCSR();
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ReadFileDistributedRSIO(const std::string& filename,
+                                                          ParallelManager*   pm)
+    {
+        log_debug(this, "GlobalMatrix::ReadFileDistributedRSIO()", filename, pm);
 
-        // Fetch boundary rows of P
-        // To compute AP = A * P we need to fetch additional rows of P, such that
-        // we can locally access all rows that do not belong to the current rank,
-        // but are required due to column dependencies.
+        this->ReadFileDistributed_(filename, true, pm);
+    }
 
-        // This means, we need to send all rows of P where A has a dependency on
-        // to the neighboring rank
-        int P_ext_m_send = A.pm_->GetNumSenders();
-        // Number of rows of P we receive from our neighbors
-        int P_ext_m_recv = A.pm_->GetNumReceivers();
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::WriteFileDistributedCSR(const std::string& filename) const
+    {
+        log_debug(this, "GlobalMatrix::WriteFileDistributedCSR()", filename);
 
-        // First, count the total number of non-zero entries per boundary row, including
-        // ghost part (we need to send full rows)
-        LocalVector<PtrType> P_ext_row_ptr_send;
-        P_ext_row_ptr_send.CloneBackend(*this);
-        P_ext_row_ptr_send.Allocate("P_ext_row_ptr_send", P_ext_m_send + 1);
-        P_int_ptr->matrix_->ExtractBoundaryRowNnz(
-            P_ext_row_ptr_send.vector_, *A.halo_.vector_, *P_gst_ptr->matrix_);
+        assert(this->pm_ != NULL);
+        assert(this->pm_->comm_ != NULL);
 
-        // We need the send buffer on host for communication
-        PtrType* hP_ext_row_nnz_send = NULL;
-        allocate_host(P_ext_m_send + 1, &hP_ext_row_nnz_send);
-        P_ext_row_ptr_send.CopyToHostData(hP_ext_row_nnz_send);
+        int     rank       = this->pm_->rank_;
+        int64_t nrow       = this->pm_->GetGlobalNrow();
+        int64_t ncol       = this->pm_->GetGlobalNcol();
+        int64_t local_nrow = this->pm_->GetLocalNrow();
+        int64_t row_begin  = this->pm_->GetGlobalRowBegin();
 
-        // Receive buffer
-        PtrType* hP_ext_row_ptr_recv = NULL;
-        allocate_host(P_ext_m_recv + 1, &hP_ext_row_ptr_recv);
+        // Column indices are stored with 32 bits
+        if(ncol > std::numeric_limits<int>::max())
+        {
+            LOG_INFO("GlobalMatrix::WriteFileDistributedCSR() too many columns for file "
+                     << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-        // Initiate communication of nnz per row
-        A.pm_->CommunicateAsync_(hP_ext_row_nnz_send, hP_ext_row_ptr_recv);
+        // Local rows with global column indices, sorted by column
+        std::vector<int64_t>   row_offset;
+        std::vector<int64_t>   col;
+        std::vector<ValueType> val;
 
-        // Exclusive sum to obtain row pointers of send buffer
-        PtrType P_ext_nnz_send = P_ext_row_ptr_send.ExclusiveSum();
+        this->MergeLocalRows_(&row_offset, &col, &val);
 
-        // We need a copy of P_ext_row_ptr on host for the communication
-        PtrType* hP_ext_row_ptr_send = NULL;
-        allocate_host(P_ext_m_send + 1, &hP_ext_row_ptr_send);
-        P_ext_row_ptr_send.CopyToHostData(hP_ext_row_ptr_send);
+        int64_t nnz       = this->GetNnz();
+        int64_t local_nnz = row_offset[local_nrow];
+        int64_t nnz_begin = 0;
 
-        // Extract the ghost mapping of P
-        LocalVector<int64_t> P_mapping;
-        P_mapping.CloneBackend(*this);
-        P_mapping.Allocate("P ghost mapping", P.pm_->GetNumReceivers());
-        const int64_t* ghost_mapping = P.pm_->GetGhostToGlobalMap();
-        P_mapping.CopyFromHostData(ghost_mapping);
+#ifdef SUPPORT_MULTINODE
+        // Position of the local non-zeros in the global arrays
+        communication_sync_exscan(&local_nnz, &nnz_begin, 1, this->pm_->comm_);
+#endif
 
-        // Now, extract boundary column indices and values
-        LocalVector<int64_t>   P_ext_col_ind_send;
-        LocalVector<ValueType> P_ext_val_send;
+        if(rank == 0)
+        {
+            nnz_begin = 0;
+        }
 
-        P_ext_col_ind_send.CloneBackend(*this);
-        P_ext_val_send.CloneBackend(*this);
+        CSRFileLayout layout;
+        std::string   header;
 
-        P_ext_col_ind_send.Allocate("P_ext_col_ind_send", P_ext_nnz_send);
-        P_ext_val_send.Allocate("P_ext_val_send", P_ext_nnz_send);
+        write_matrix_csr_layout<ValueType>(nrow, ncol, nnz, layout, header);
 
-        P_int_ptr->matrix_->ExtractBoundaryRows(*P_ext_row_ptr_send.vector_,
-                                                P_ext_col_ind_send.vector_,
-                                                P_ext_val_send.vector_,
-                                                P.pm_->GetGlobalColumnBegin(),
-                                                *A.halo_.vector_,
-                                                *P_mapping.vector_,
-                                                *P_gst_ptr->matrix_);
+        // The last rank also writes the closing row offset
+        int64_t nptr = local_nrow + (rank == this->pm_->num_procs_ - 1 ? 1 : 0);
 
-        // We do not need this anymore
-        P_ext_row_ptr_send.Clear();
+        for(int64_t i = 0; i < nptr; ++i)
+        {
+            row_offset[i] += nnz_begin;
+        }
 
-        // Wait for nnz per row communication to finish
-        A.pm_->CommunicateSync_();
+        std::vector<char> raw(nptr * layout.ptr_size);
+        convert_csr_file_indices_raw(nptr, layout.ptr_type, row_offset.data(), raw.data());
 
-        // Clean up
-        free_host(&hP_ext_row_nnz_send);
+#ifdef SUPPORT_MULTINODE
+        MFile file;
 
-        // Obtain row pointer array
-        // We can do this on the host, as the number of external rows is typically very small
-        // and skips h2d followed by d2h copy
-        LocalVector<PtrType> P_ext_row_ptr_recv;
-        P_ext_row_ptr_recv.SetDataPtr(&hP_ext_row_ptr_recv, "P_ext_row_ptr_recv", P_ext_m_recv + 1);
+        if(communication_file_create(filename.c_str(), &file, this->pm_->comm_) != true)
+        {
+            LOG_INFO("Cannot open GlobalMatrix file [write]: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-        // Exclusive sum
-        PtrType P_ext_nnz_recv = P_ext_row_ptr_recv.ExclusiveSum();
+        // Master rank writes the header, all ranks write their rows at aligned offsets
+        communication_file_write_at_all(
+            &file, 0, (rank == 0) ? header.size() : 0, header.data(), this->pm_->comm_);
 
-        // We need a copy of A_ext_row_ptr on host for the communication
-        P_ext_row_ptr_recv.LeaveDataPtr(&hP_ext_row_ptr_recv);
+        communication_file_write_at_all(&file,
+                                        layout.ptr_offset + row_begin * layout.ptr_size,
+                                        raw.size(),
+                                        raw.data(),
+                                        this->pm_->comm_);
 
-        // We need a copy of P_ext on host for the communication
-        int64_t*   hP_ext_col_ind_send = NULL;
-        ValueType* hP_ext_val_send     = NULL;
+        raw.resize(local_nnz * layout.col_size);
+        convert_csr_file_indices_raw(local_nnz, layout.col_type, col.data(), raw.data());
+        std::vector<int64_t>().swap(col);
 
-        allocate_host(P_ext_nnz_send, &hP_ext_col_ind_send);
-        allocate_host(P_ext_nnz_send, &hP_ext_val_send);
+        communication_file_write_at_all(&file,
+                                        layout.col_offset + nnz_begin * layout.col_size,
+                                        raw.size(),
+                                        raw.data(),
+                                        this->pm_->comm_);
 
-        P_ext_col_ind_send.CopyToHostData(hP_ext_col_ind_send);
-        P_ext_val_send.CopyToHostData(hP_ext_val_send);
+        raw.resize(local_nnz * layout.val_size);
+        convert_csr_file_values_raw(local_nnz, layout.val_type, val.data(), raw.data());
 
-        // Clean up
-        P_ext_col_ind_send.Clear();
-        P_ext_val_send.Clear();
+        communication_file_write_at_all(&file,
+                                        layout.val_offset + nnz_begin * layout.val_size,
+                                        raw.size(),
+                                        raw.data(),
+                                        this->pm_->comm_);
 
-        // Receive buffers
-        int64_t*   hP_ext_col_ind_recv_global = NULL;
-        ValueType* hP_ext_val_recv            = NULL;
+        communication_file_close(&file);
+#endif
+    }
 
-        allocate_host(P_ext_nnz_recv, &hP_ext_col_ind_recv_global);
-        allocate_host(P_ext_nnz_recv, &hP_ext_val_recv);
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::ReadFileDistributed_(const std::string& filename,
+                                                       bool               rsio,
+                                                       ParallelManager*   pm)
+    {
+        assert(pm != NULL);
+        assert(pm->comm_ != NULL);
 
-        // Initiate communication of column indices and values
-        A.pm_->CommunicateCSRAsync_(hP_ext_row_ptr_send,
-                                    hP_ext_col_ind_send,
-                                    hP_ext_val_send,
-                                    hP_ext_row_ptr_recv,
-                                    hP_ext_col_ind_recv_global,
-                                    hP_ext_val_recv);
+        CSRFileLayout layout;
 
-        // Now, A interior need to be merged with its ghost part to obtain A_full
-        int64_t A_full_m   = A_int_ptr->GetM();
-        int64_t A_full_n   = A_int_ptr->GetN() + A_gst_ptr->GetN();
-        int64_t A_full_nnz = A_int_ptr->GetNnz() + A_gst_ptr->GetNnz();
+        bool status = (rsio == true)
+                          ? read_matrix_csr_rocsparseio_layout<ValueType>(layout, filename.c_str())
+                          : read_matrix_csr_layout<ValueType>(layout, filename.c_str());
 
-        LocalMatrix<ValueType> zero_matrix;
-        LocalVector<int>       zero_vector;
-        LocalVector<int64_t>   zero_vector64;
-        zero_matrix.CloneBackend(*this);
-        zero_vector.CloneBackend(*this);
-        zero_vector64.CloneBackend(*this);
+        if(status != true)
+        {
+            LOG_INFO("GlobalMatrix::ReadFileDistributed() failed for file " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-        LocalMatrix<ValueType> A_full;
-        A_full.CloneBackend(*this);
-        A_full.AllocateCSR("A full", A_full_nnz, A_full_m, A_full_n);
-        A_full.matrix_->MergeToLocal(
-            *A_int_ptr->matrix_, *A_gst_ptr->matrix_, *zero_matrix.matrix_, *zero_vector.vector_);
+        this->PartitionContiguous_(layout.nrow, layout.ncol, pm);
 
-        // Wait for additional column indices and values communication from P to finish
-        A.pm_->CommunicateCSRSync_();
+        int64_t row_begin  = pm->global_row_offset_[pm->rank_];
+        int64_t local_nrow = pm->GetLocalNrow();
 
-        // Clean up
-        free_host(&hP_ext_row_ptr_send);
-        free_host(&hP_ext_col_ind_send);
-        free_host(&hP_ext_val_send);
+        std::vector<int64_t>   row_offset(local_nrow + 1);
+        std::vector<int64_t>   col;
+        std::vector<ValueType> val;
+        std::vector<char>      raw;
 
-        // Wrap received data into structure
+        int64_t nnz_begin = 0;
+        int64_t nnz       = 0;
 
-        // Combine P ghost with the ghost part of the additional rows from neighbors
-        // in order to match the column indices when doing SpGEMM on the ghost part
-        LocalVector<int>     P_gst_ext_local;
-        LocalVector<int64_t> l2g;
+#ifdef SUPPORT_MULTINODE
+        MFile file;
 
-        P_gst_ext_local.CloneBackend(*this);
-        l2g.CloneBackend(*this);
+        if(communication_file_open(filename.c_str(), &file, pm->comm_) != true)
+        {
+            LOG_INFO("Cannot open GlobalMatrix file [read]: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-        LocalVector<int> P_local_col;
-        P_local_col.CloneBackend(*this);
-        P_local_col.Allocate("local col", P_ext_nnz_recv);
-
-        LocalVector<int64_t> P_ext_col_ind_recv;
-        P_ext_col_ind_recv.SetDataPtr(&hP_ext_col_ind_recv_global, "", P_ext_nnz_recv);
-        P_ext_col_ind_recv.CloneBackend(*this);
-        P_gst_ptr->matrix_->CombineAndRenumber(P_int_ptr->GetN(),
-                                               P_ext_nnz_recv,
-                                               P.pm_->GetGlobalColumnBegin(),
-                                               P.pm_->GetGlobalColumnEnd(),
-                                               *P_mapping.vector_,
-                                               *P_ext_col_ind_recv.vector_,
-                                               P_gst_ext_local.vector_,
-                                               l2g.vector_,
-                                               P_local_col.vector_);
-
-        // Wrap P ext into structure
-        int* hP_ext_col_ind_recv = NULL;
-        P_local_col.MoveToHost();
-        P_local_col.LeaveDataPtr(&hP_ext_col_ind_recv);
-
-        LocalMatrix<ValueType> P_ext;
-        P_ext.SetDataPtrCSR(&hP_ext_row_ptr_recv,
-                            &hP_ext_col_ind_recv,
-                            &hP_ext_val_recv,
-                            "P ext",
-                            P_ext_nnz_recv,
-                            P_ext_m_recv,
-                            INT32_MAX);
-        P_ext.CloneBackend(*this);
+        // Row offsets of the local rows
+        raw.resize((local_nrow + 1) * layout.ptr_size);
+        communication_file_read_at_all(&file,
+                                       layout.ptr_offset + row_begin * layout.ptr_size,
+                                       raw.size(),
+                                       raw.data(),
+                                       pm->comm_);
+        convert_csr_file_indices(local_nrow + 1, layout.ptr_type, raw.data(), row_offset.data());
 
-        // P_ext can potentially be unsorted, which might cause problems later on
-        P_ext.Sort();
+        nnz_begin = row_offset[0] - layout.base;
+        nnz       = row_offset[local_nrow] - row_offset[0];
 
-        int64_t P_full_ghost_n = l2g.GetSize();
+        if(nnz_begin < 0 || nnz < 0 || nnz_begin + nnz > layout.nnz)
+        {
+            LOG_INFO("GlobalMatrix::ReadFileDistributed() invalid row offsets in " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-        // Merge P with the additional rows of P_ext in order to do the SpGEMM with A
-        LocalMatrix<ValueType> P_full;
-        P_full.CloneBackend(*this);
-        P_full.AllocateCSR("P full",
-                           P_int_ptr->GetNnz() + P_gst_ptr->GetNnz() + P_ext_nnz_recv,
-                           P_int_ptr->GetM() + P_ext_m_recv,
-                           P_int_ptr->GetN() + P_full_ghost_n);
-        P_full.matrix_->MergeToLocal(
-            *P_int_ptr->matrix_, *P_gst_ptr->matrix_, *P_ext.matrix_, *P_gst_ext_local.vector_);
+        // Column indices and values of the local rows
+        col.resize(nnz);
+        val.resize(nnz);
+
+        raw.resize(nnz * layout.col_size);
+        communication_file_read_at_all(&file,
+                                       layout.col_offset + nnz_begin * layout.col_size,
+                                       raw.size(),
+                                       raw.data(),
+                                       pm->comm_);
+        convert_csr_file_indices(nnz, layout.col_type, raw.data(), col.data());
+
+        raw.resize(nnz * layout.val_size);
+        communication_file_read_at_all(&file,
+                                       layout.val_offset + nnz_begin * layout.val_size,
+                                       raw.size(),
+                                       raw.data(),
+                                       pm->comm_);
+        convert_csr_file_values(nnz, layout.val_type, raw.data(), val.data());
+
+        communication_file_close(&file);
+#endif
 
-        P_ext.Clear();
-        P_gst_ext_local.Clear();
+        std::vector<char>().swap(raw);
 
-        // Compute AP = A_full * P_full
-        LocalMatrix<ValueType> AP;
-        AP.CloneBackend(*this);
+        for(int64_t j = 0; j < nnz; ++j)
+        {
+            col[j] -= layout.base;
 
-        AP.MatrixMult(A_full, P_full);
+            if(col[j] < 0 || col[j] >= layout.ncol)
+            {
+                LOG_INFO("GlobalMatrix::ReadFileDistributed() invalid column index in "
+                         << filename);
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
 
-        // Transpose ghost of P to obtain R ext
-        LocalMatrix<ValueType> R_ext;
-        R_ext.CloneBackend(*this);
-        P_gst_ptr->Transpose(&R_ext);
+        this->AssembleLocalRows_(row_offset.data(), col.data(), val.data(), filename, pm);
+    }
 
-        // Merge R interior and ghost into R full
-        LocalMatrix<ValueType> R_full;
-        R_full.CloneBackend(*this);
-        R_full.AllocateCSR("R full",
-                           P_int_ptr->GetNnz() + P_gst_ptr->GetNnz(),
-                           P_int_ptr->GetN() + P_gst_ptr->GetN(),
-                           P_int_ptr->GetM());
-        R_full.matrix_->MergeToLocal(
-            *R_int_ptr->matrix_, *zero_matrix.matrix_, *R_ext.matrix_, *zero_vector.vector_);
-
-        // Compute RAP_full = R_full * AP
-        LocalMatrix<ValueType> RAP_full;
-        RAP_full.CloneBackend(*this);
-        RAP_full.MatrixMult(R_full, AP);
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::PartitionContiguous_(int64_t          nrow,
+                                                       int64_t          ncol,
+                                                       ParallelManager* pm) const
+    {
+        int num_procs = pm->num_procs_;
 
-        // Now we need to extract rows that need to be sent to neighboring processes
+        // Contiguous blocks of rows and columns, the first ranks get one more row / column
+        std::vector<int64_t> row_offset(num_procs + 1);
+        std::vector<int64_t> col_offset(num_procs + 1);
 
-        // Extract RAP_ext from RAP_full
-        int64_t RAP_ext_m_send = RAP_full.GetLocalM() - P_int_ptr->GetN();
-        int64_t RAP_ext_m_recv = P.pm_->GetNumSenders();
+        for(int n = 0; n <= num_procs; ++n)
+        {
+            row_offset[n] = n * (nrow / num_procs) + std::min<int64_t>(n, nrow % num_procs);
+            col_offset[n] = n * (ncol / num_procs) + std::min<int64_t>(n, ncol % num_procs);
+        }
 
-        LocalVector<PtrType> RAP_ext_row_ptr_send;
-        RAP_ext_row_ptr_send.CloneBackend(*this);
-        RAP_ext_row_ptr_send.Allocate("RAP ext row ptr send", RAP_ext_m_send + 1);
+        this->PartitionOffsets_(row_offset.data(), col_offset.data(), pm);
+    }
 
-        RAP_full.matrix_->ExtractExtRowNnz(P_int_ptr->GetN(), RAP_ext_row_ptr_send.vector_);
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::PartitionOffsets_(const int64_t*   row_offset,
+                                                    const int64_t*   col_offset,
+                                                    ParallelManager* pm) const
+    {
+        int rank      = pm->rank_;
+        int num_procs = pm->num_procs_;
 
-        // Communication buffers
-        PtrType* hRAP_ext_row_nnz_send = NULL;
-        PtrType* hRAP_ext_row_ptr_recv = NULL;
+        // Replace all data of the parallel manager, the communicator is kept
+        pm->Clear();
 
-        allocate_host(RAP_ext_m_send + 1, &hRAP_ext_row_nnz_send);
-        allocate_host(RAP_ext_m_recv + 1, &hRAP_ext_row_ptr_recv);
+        pm->SetGlobalNrow(row_offset[num_procs]);
+        pm->SetGlobalNcol(col_offset[num_procs]);
 
-        RAP_ext_row_ptr_send.CopyToHostData(hRAP_ext_row_nnz_send);
+        for(int n = 0; n <= num_procs; ++n)
+        {
+            pm->global_row_offset_[n] = row_offset[n];
+            pm->global_col_offset_[n] = col_offset[n];
+        }
 
-        // Initiate communication of nnz per row
-        P.pm_->InverseCommunicateAsync_(hRAP_ext_row_nnz_send, hRAP_ext_row_ptr_recv + 1);
+        // Offsets are known on all ranks, no communication required
+        pm->global_offset_ = true;
 
-        // Extract RAP ext
-        LocalMatrix<ValueType> RAP_ext;
-        RAP_ext.CloneBackend(*this);
-        RAP_full.ExtractSubMatrix(P_int_ptr->GetN(),
-                                  0,
-                                  RAP_full.GetLocalM() - P_int_ptr->GetN(),
-                                  RAP_full.GetLocalN(),
-                                  &RAP_ext);
-
-        // Set new sizes for local RAP ext
-        int64_t RAP_local_n   = RAP_full.GetLocalN();
-        PtrType RAP_local_nnz = RAP_full.GetLocalNnz() - RAP_ext.GetLocalNnz();
-
-        PtrType*   RAP_csr_row_ptr = NULL;
-        int*       RAP_csr_col_ind = NULL;
-        ValueType* RAP_csr_val     = NULL;
-
-        RAP_full.LeaveDataPtrCSR(&RAP_csr_row_ptr, &RAP_csr_col_ind, &RAP_csr_val);
-        RAP_full.SetDataPtrCSR(&RAP_csr_row_ptr,
-                               &RAP_csr_col_ind,
-                               &RAP_csr_val,
-                               "RAP",
-                               RAP_local_nnz,
-                               P_int_ptr->GetN(),
-                               RAP_local_n);
+        int64_t row_begin = pm->global_row_offset_[rank];
+        int64_t col_begin = pm->global_col_offset_[rank];
 
-        // Extract column indices and transform them to global indices (for sending)
-        LocalVector<int64_t> RAP_ext_col_ind_send;
-        RAP_ext_col_ind_send.CloneBackend(*this);
-        RAP_ext_col_ind_send.Allocate("col ind send", RAP_ext.GetNnz());
+        int64_t local_nrow = pm->global_row_offset_[rank + 1] - row_begin;
+        int64_t local_ncol = pm->global_col_offset_[rank + 1] - col_begin;
 
-        RAP_ext.matrix_->ExtractGlobalColumnIndices(P_int_ptr->GetN(),
-                                                    P.pm_->GetGlobalColumnBegin(),
-                                                    *l2g.vector_,
-                                                    RAP_ext_col_ind_send.vector_);
+        if(local_nrow > std::numeric_limits<int>::max()
+           || local_ncol > std::numeric_limits<int>::max())
+        {
+            LOG_INFO("GlobalMatrix local block is too large for " << num_procs << " ranks");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-        // Communication buffers
-        PtrType*   hRAP_ext_row_ptr_send        = NULL;
-        int*       hRAP_ext_col_ind_send        = NULL;
-        ValueType* hRAP_ext_val_send            = NULL;
-        int64_t*   hRAP_ext_col_ind_send_global = NULL;
+        pm->SetLocalNrow(local_nrow);
+        pm->SetLocalNcol(local_ncol);
+    }
 
-        RAP_ext.MoveToHost();
-        RAP_ext.LeaveDataPtrCSR(&hRAP_ext_row_ptr_send, &hRAP_ext_col_ind_send, &hRAP_ext_val_send);
-        RAP_ext_col_ind_send.MoveToHost();
-        RAP_ext_col_ind_send.LeaveDataPtr(&hRAP_ext_col_ind_send_global);
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::AssembleLocalRows_(const int64_t*     row_offset,
+                                                     const int64_t*     col,
+                                                     const ValueType*   val,
+                                                     const std::string& name,
+                                                     ParallelManager*   pm)
+    {
+        // Row offsets may start at an arbitrary position, column indices are global
+        int64_t local_nrow = pm->GetLocalNrow();
+        int64_t local_ncol = pm->GetLocalNcol();
+        int64_t col_begin  = pm->GetGlobalColumnBegin();
 
-        // Wait for nnz per row communication to finish
-        P.pm_->InverseCommunicateSync_();
+        // Split the local rows into interior and ghost part
+        PtrType* interior_row_offset = NULL;
+        PtrType* ghost_row_offset    = NULL;
 
-        // Clean up
-        free_host(&hRAP_ext_row_nnz_send);
+        allocate_host(local_nrow + 1, &interior_row_offset);
+        allocate_host(local_nrow + 1, &ghost_row_offset);
 
-        // Exclusive sum to obtain recv row pointers
-        hRAP_ext_row_ptr_recv[0] = 0;
-        for(int64_t i = 0; i < RAP_ext_m_recv; ++i)
+        interior_row_offset[0] = 0;
+        ghost_row_offset[0]    = 0;
+
+        for(int64_t i = 0; i < local_nrow; ++i)
         {
-            hRAP_ext_row_ptr_recv[i + 1] += hRAP_ext_row_ptr_recv[i];
-        }
+            PtrType interior_nnz = 0;
+            PtrType ghost_nnz    = 0;
 
-        // Initiate communication of column indices and values
-        PtrType RAP_ext_nnz_recv = hRAP_ext_row_ptr_recv[RAP_ext_m_recv];
+            for(int64_t j = row_offset[i] - row_offset[0]; j < row_offset[i + 1] - row_offset[0];
+                ++j)
+            {
+                if(col[j] >= col_begin && col[j] < col_begin + local_ncol)
+                {
+                    ++interior_nnz;
+                }
+                else
+                {
+                    ++ghost_nnz;
+                }
+            }
 
-        int64_t*   hRAP_ext_col_ind_recv = NULL;
-        ValueType* hRAP_ext_val_recv     = NULL;
+            interior_row_offset[i + 1] = interior_row_offset[i] + interior_nnz;
+            ghost_row_offset[i + 1]    = ghost_row_offset[i] + ghost_nnz;
+        }
 
-        allocate_host(RAP_ext_nnz_recv, &hRAP_ext_col_ind_recv);
-        allocate_host(RAP_ext_nnz_recv, &hRAP_ext_val_recv);
+        int64_t interior_nnz = interior_row_offset[local_nrow];
+        int64_t ghost_nnz    = ghost_row_offset[local_nrow];
 
-        P.pm_->InverseCommunicateCSRAsync_(hRAP_ext_row_ptr_send,
-                                           hRAP_ext_col_ind_send_global,
-                                           hRAP_ext_val_send,
-                                           hRAP_ext_row_ptr_recv,
-                                           hRAP_ext_col_ind_recv,
-                                           hRAP_ext_val_recv);
+        int*       interior_col = NULL;
+        int*       ghost_col    = NULL;
+        ValueType* interior_val = NULL;
+        ValueType* ghost_val    = NULL;
 
-        // Split RAP into interior and ghost
-        LocalMatrix<ValueType> RAP_interior;
-        LocalMatrix<ValueType> RAP_ghost;
+        allocate_host(interior_nnz, &interior_col);
+        allocate_host(interior_nnz, &interior_val);
+        allocate_host(ghost_nnz, &ghost_col);
+        allocate_host(ghost_nnz, &ghost_val);
 
-        RAP_interior.CloneBackend(RAP_full);
-        RAP_ghost.CloneBackend(RAP_full);
+        // Global column indices of the ghost part
+        std::vector<int64_t> ghost_global_col(ghost_nnz);
 
-        RAP_full.matrix_->SplitInteriorGhost(RAP_interior.matrix_, RAP_ghost.matrix_);
+        for(int64_t i = 0, interior_idx = 0, ghost_idx = 0; i < local_nrow; ++i)
+        {
+            for(int64_t j = row_offset[i] - row_offset[0]; j < row_offset[i + 1] - row_offset[0];
+                ++j)
+            {
+                if(col[j] >= col_begin && col[j] < col_begin + local_ncol)
+                {
+                    interior_col[interior_idx] = static_cast<int>(col[j] - col_begin);
+                    interior_val[interior_idx] = val[j];
+                    ++interior_idx;
+                }
+                else
+                {
+                    ghost_global_col[ghost_idx] = col[j];
+                    ghost_val[ghost_idx]        = val[j];
+                    ++ghost_idx;
+                }
+            }
+        }
 
-        // Wait for additional column indices and values communication to finish
-        P.pm_->InverseCommunicateCSRSync_();
+        // Ghost columns are numbered in ascending order of their global index, which is the
+        // order the ghost values are received in
+        std::vector<int64_t> sorted_ghost_col(ghost_global_col);
 
-        // Clean up
-        free_host(&hRAP_ext_row_ptr_send);
-        free_host(&hRAP_ext_col_ind_send);
-        free_host(&hRAP_ext_val_send);
-        free_host(&hRAP_ext_col_ind_send_global);
+        std::sort(sorted_ghost_col.begin(), sorted_ghost_col.end());
+        sorted_ghost_col.erase(std::unique(sorted_ghost_col.begin(), sorted_ghost_col.end()),
+                               sorted_ghost_col.end());
 
-        LocalMatrix<ValueType> RAP_ext_interior;
-        LocalMatrix<ValueType> RAP_ext_ghost;
+        for(int64_t j = 0; j < ghost_nnz; ++j)
+        {
+            ghost_col[j] = static_cast<int>(std::lower_bound(sorted_ghost_col.begin(),
+                                                             sorted_ghost_col.end(),
+                                                             ghost_global_col[j])
+                                            - sorted_ghost_col.begin());
+        }
 
-        RAP_ext_interior.CloneBackend(*this);
-        RAP_ext_ghost.CloneBackend(*this);
+        // Generate the communication pattern, the manager is its own parent as its
+        // offsets are already known
+        pm->GenerateFromGhostColumnsWithParent_(
+            sorted_ghost_col.size(), sorted_ghost_col.data(), *pm);
 
-        // Temporary array to store global ghost columns
-        LocalVector<int64_t> ghost_col;
-        ghost_col.CloneBackend(*this);
+        // Convert global boundary index to local index
+        pm->BoundaryTransformGlobalToLocal_();
 
-        LocalVector<PtrType>   RAP_ext_row_ptr_recv;
-        LocalVector<int64_t>   RAP_ext_col_ind_recv;
-        LocalVector<ValueType> RAP_ext_val_recv;
+        // Communicate ghost to global map
+        pm->CommunicateGhostToGlobalMapAsync_();
+        pm->CommunicateGhostToGlobalMapSync_();
 
-        RAP_ext_row_ptr_recv.SetDataPtr(&hRAP_ext_row_ptr_recv, "", RAP_ext_m_recv + 1);
-        RAP_ext_col_ind_recv.SetDataPtr(&hRAP_ext_col_ind_recv, "", RAP_ext_nnz_recv);
-        RAP_ext_val_recv.SetDataPtr(&hRAP_ext_val_recv, "", RAP_ext_nnz_recv);
+        // The matrix is assembled on the host
+        bool accel = this->is_accel_();
 
-        RAP_ext_row_ptr_recv.CloneBackend(*this);
-        RAP_ext_col_ind_recv.CloneBackend(*this);
-        RAP_ext_val_recv.CloneBackend(*this);
+        this->Clear();
+        this->MoveToHost();
+        this->SetParallelManager(*pm);
+
+        this->SetDataPtrCSR(&interior_row_offset,
+                            &interior_col,
+                            &interior_val,
+                            &ghost_row_offset,
+                            &ghost_col,
+                            &ghost_val,
+                            name,
+                            interior_nnz,
+                            ghost_nnz);
+
+        if(accel == true)
+        {
+            this->MoveToAccelerator();
+        }
+    }
 
-        RAP_ext_interior.matrix_->CopyFromGlobalReceive(P_int_ptr->GetN(),
-                                                        P.pm_->GetGlobalColumnBegin(),
-                                                        P.pm_->GetGlobalColumnEnd(),
-                                                        *P.halo_.vector_,
-                                                        *RAP_ext_row_ptr_recv.vector_,
-                                                        *RAP_ext_col_ind_recv.vector_,
-                                                        *RAP_ext_val_recv.vector_,
-                                                        RAP_ext_ghost.matrix_,
-                                                        ghost_col.vector_);
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::AssembleCOO(int64_t          nnz,
+                                              const int64_t*   row,
+                                              const int64_t*   col,
+                                              const ValueType* val,
+                                              int64_t          global_nrow,
+                                              int64_t          global_ncol,
+                                              ParallelManager* pm)
+    {
+        log_debug(this,
+                  "GlobalMatrix::AssembleCOO()",
+                  nnz,
+                  row,
+                  col,
+                  val,
+                  global_nrow,
+                  global_ncol,
+                  pm);
 
-        // Merged global ghost columns
-        LocalVector<int64_t> merged_col;
-        merged_col.CloneBackend(*this);
+        assert(nnz >= 0);
+        assert(pm != NULL);
+        assert(pm->comm_ != NULL);
 
-        // Merge RAP ghost with RAP ext
-        RAP_ghost.CompressAdd(l2g, ghost_col, RAP_ext_ghost, &merged_col);
+        if(nnz > 0)
+        {
+            assert(row != NULL);
+            assert(col != NULL);
+            assert(val != NULL);
+        }
 
-        // Merge RAP interior with RAP ext
-        RAP_interior.CompressAdd(zero_vector64, zero_vector64, RAP_ext_interior, NULL);
+        this->PartitionContiguous_(global_nrow, global_ncol, pm);
 
-        // Communicate local sizes
-        int64_t global_nrow;
-        int64_t local_nrow = RAP_interior.GetLocalM();
+        int rank      = pm->rank_;
+        int num_procs = pm->num_procs_;
 
-#ifdef SUPPORT_MULTINODE
-        MRequest req;
-        communication_async_allreduce_single_sum(&local_nrow, &global_nrow, P.pm_->comm_, &req);
-#endif
+        const int64_t* global_row_offset = pm->global_row_offset_;
 
-        // Generate PM for RAP
-        this->CreateParallelManager_();
-        this->pm_self_->SetMPICommunicator(P.pm_->comm_);
+        // Number of triplets for each owning rank
+        std::vector<int> send_count(num_procs, 0);
+        std::vector<int> owner(nnz);
+
+        for(int64_t i = 0; i < nnz; ++i)
+        {
+            if(row[i] < 0 || row[i] >= global_nrow || col[i] < 0 || col[i] >= global_ncol)
+            {
+                LOG_INFO("GlobalMatrix::AssembleCOO() invalid triplet (" << row[i] << ", "
+                                                                          << col[i] << ")");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
 
-        // To generate the parallel manager, we need to access the sorted global ghost column ids
-        LocalVector<int64_t> sorted_ghost_col;
-        sorted_ghost_col.CloneBackend(*this);
-        sorted_ghost_col.Allocate("sorted global ghost columns", merged_col.GetSize());
+            owner[i] = static_cast<int>(
+                std::upper_bound(global_row_offset, global_row_offset + num_procs + 1, row[i])
+                - global_row_offset - 1);
 
-        // Sort the global ghost columns (we do not need the permutation vector)
-        merged_col.Sort(&sorted_ghost_col, NULL);
+            ++send_count[owner[i]];
+        }
 
-        // Get the sorted ghost columns on host
-        int64_t* pghost_col = NULL;
-        sorted_ghost_col.MoveToHost();
-        sorted_ghost_col.LeaveDataPtr(&pghost_col);
+        std::vector<int> recv_count(num_procs, 0);
 
 #ifdef SUPPORT_MULTINODE
-        communication_sync(&req);
+        communication_sync_alltoall_single(send_count.data(), recv_count.data(), pm->comm_);
+#else
+        recv_count[rank] = send_count[rank];
 #endif
 
-        // RAP is a square matrix, we can skip the column allreduce
-        this->pm_self_->SetGlobalNrow(global_nrow);
-        this->pm_self_->SetGlobalNcol(global_nrow);
-
-        this->pm_self_->SetLocalNrow(RAP_interior.GetLocalM());
-        this->pm_self_->SetLocalNcol(RAP_interior.GetLocalN());
+        std::vector<int64_t> send_offset(num_procs + 1, 0);
+        std::vector<int64_t> recv_offset(num_procs + 1, 0);
 
-        // Generate the manager from ghost of RAP and manager of P
-        this->pm_self_->GenerateFromGhostColumnsWithParent_(RAP_ghost.GetNnz(), pghost_col, *P.pm_);
-
-        // Communicate global offsets
-        this->pm_self_->CommunicateGlobalOffsetAsync_();
+        for(int n = 0; n < num_procs; ++n)
+        {
+            send_offset[n + 1] = send_offset[n] + send_count[n];
+            recv_offset[n + 1] = recv_offset[n] + recv_count[n];
+        }
 
-        // Clear
-        free_host(&pghost_col);
+        // Pack the triplets by owning rank
+        std::vector<int64_t>   send_row(nnz);
+        std::vector<int64_t>   send_col(nnz);
+        std::vector<ValueType> send_val(nnz);
 
-        // Sync global offsets communication
-        this->pm_self_->CommunicateGlobalOffsetSync_();
+        std::vector<int64_t> pos(send_offset.begin(), send_offset.end() - 1);
 
-        // Convert global boundary index to local index
-        this->pm_self_->BoundaryTransformGlobalToLocal_();
+        for(int64_t i = 0; i < nnz; ++i)
+        {
+            int64_t idx = pos[owner[i]]++;
 
-        // Communicate ghost to global map
-        this->pm_self_->CommunicateGhostToGlobalMapAsync_();
+            send_row[idx] = row[i];
+            send_col[idx] = col[i];
+            send_val[idx] = val[i];
+        }
 
-        // Renumber ghost columns (from global to local)
-        RAP_ghost.matrix_->RenumberGlobalToLocal(*merged_col.vector_);
+        std::vector<int>().swap(owner);
 
-        // Synchronize
-        this->pm_self_->CommunicateGhostToGlobalMapSync_();
+        int64_t recv_nnz = recv_offset[num_procs];
 
-        this->SetParallelManager(*this->pm_self_);
+        std::vector<int64_t>   recv_row(recv_nnz);
+        std::vector<int64_t>   recv_col(recv_nnz);
+        std::vector<ValueType> recv_val(recv_nnz);
 
-        int64_t RAP_ghost_nnz = RAP_ghost.GetLocalNnz();
+        // Exchange the triplets with all ranks we share entries with
+#ifdef SUPPORT_MULTINODE
+        std::vector<MRequest> req;
+        req.reserve(6 * num_procs);
 
-        PtrType*   hRAP_ghost_csr_row_ptr = NULL;
-        int*       hRAP_ghost_csr_col_ind = NULL;
-        ValueType* hRAP_ghost_csr_val     = NULL;
+        for(int n = 0; n < num_procs; ++n)
+        {
+            if(n == rank || recv_count[n] == 0)
+            {
+                continue;
+            }
 
-        RAP_ghost.LeaveDataPtrCSR(
-            &hRAP_ghost_csr_row_ptr, &hRAP_ghost_csr_col_ind, &hRAP_ghost_csr_val);
+            int64_t offset = recv_offset[n];
+            int     count  = recv_count[n];
 
-        // Obtain raw pointers
-        int64_t RAP_interior_nnz = RAP_interior.GetLocalNnz();
-
-        PtrType*   RAP_interior_csr_row_ptr = NULL;
-        int*       RAP_interior_csr_col_ind = NULL;
-        ValueType* RAP_interior_csr_val     = NULL;
-
-        RAP_interior.LeaveDataPtrCSR(
-            &RAP_interior_csr_row_ptr, &RAP_interior_csr_col_ind, &RAP_interior_csr_val);
-
-        // Set global coarse matrix
-        this->SetDataPtrCSR(&RAP_interior_csr_row_ptr,
-                            &RAP_interior_csr_col_ind,
-                            &RAP_interior_csr_val,
-                            &hRAP_ghost_csr_row_ptr,
-                            &hRAP_ghost_csr_col_ind,
-                            &hRAP_ghost_csr_val,
-                            "RAP",
-                            RAP_interior_nnz,
-                            RAP_ghost_nnz);
+            req.resize(req.size() + 3);
+            communication_async_recv(
+                recv_row.data() + offset, count, n, 0, &req[req.size() - 3], pm->comm_);
+            communication_async_recv(
+                recv_col.data() + offset, count, n, 1, &req[req.size() - 2], pm->comm_);
+            communication_async_recv(
+                recv_val.data() + offset, count, n, 2, &req[req.size() - 1], pm->comm_);
+        }
 
-        if(format != CSR || R.GetFormat() != CSR || A.GetFormat() != CSR || P.GetFormat() != CSR)
+        for(int n = 0; n < num_procs; ++n)
         {
-            LOG_VERBOSE_INFO(
-                2, "*** warning: GlobalMatrix::TripleMatrixProduct() is performed in CSR format");
+            if(n == rank || send_count[n] == 0)
+            {
+                continue;
+            }
 
-            this->matrix_interior_.ConvertTo(format, blockdim);
+            int64_t offset = send_offset[n];
+            int     count  = send_count[n];
+
+            req.resize(req.size() + 3);
+            communication_async_send(
+                send_row.data() + offset, count, n, 0, &req[req.size() - 3], pm->comm_);
+            communication_async_send(
+                send_col.data() + offset, count, n, 1, &req[req.size() - 2], pm->comm_);
+            communication_async_send(
+                send_val.data() + offset, count, n, 2, &req[req.size() - 1], pm->comm_);
         }
+#endif
 
-#ifdef DEBUG_MODE
-        this->Check();
+        // Own triplets do not need to be communicated
+        std::copy(send_row.begin() + send_offset[rank],
+                  send_row.begin() + send_offset[rank + 1],
+                  recv_row.begin() + recv_offset[rank]);
+        std::copy(send_col.begin() + send_offset[rank],
+                  send_col.begin() + send_offset[rank + 1],
+                  recv_col.begin() + recv_offset[rank]);
+        std::copy(send_val.begin() + send_offset[rank],
+                  send_val.begin() + send_offset[rank + 1],
+                  recv_val.begin() + recv_offset[rank]);
+
+#ifdef SUPPORT_MULTINODE
+        communication_syncall(static_cast<int>(req.size()), req.data());
 #endif
-    }
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ReadFileMTX(const std::string& filename)
-    {
-        log_debug(this, "GlobalMatrix::ReadFileMTX()", filename);
+        std::vector<int64_t>().swap(send_row);
+        std::vector<int64_t>().swap(send_col);
+        std::vector<ValueType>().swap(send_val);
 
-        assert(this->pm_ != NULL);
-        assert(this->pm_->Status() == true);
+        // Bucket the received triplets by local row
+        int64_t row_begin  = pm->GetGlobalRowBegin();
+        int64_t local_nrow = pm->GetLocalNrow();
 
-        // Read header file
-        std::ifstream headfile(filename.c_str(), std::ifstream::in);
+        std::vector<int64_t> row_offset(local_nrow + 1, 0);
 
-        if(!headfile.is_open())
+        for(int64_t i = 0; i < recv_nnz; ++i)
         {
-            LOG_INFO("Cannot open GlobalMatrix file [read]: " << filename);
-            FATAL_ERROR(__FILE__, __LINE__);
+            ++row_offset[recv_row[i] - row_begin + 1];
         }
 
-        // Go to this ranks line in the headfile
-        for(int i = 0; i < this->pm_->rank_; ++i)
+        for(int64_t i = 0; i < local_nrow; ++i)
         {
-            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            row_offset[i + 1] += row_offset[i];
         }
 
-        std::string interior_name;
-        std::string ghost_name;
-
-        std::getline(headfile, interior_name);
-        std::getline(headfile, ghost_name);
+        std::vector<std::pair<int64_t, ValueType>> entries(recv_nnz);
 
-        headfile.close();
+        pos.assign(row_offset.begin(), row_offset.end() - 1);
 
-        // Extract directory containing the subfiles
-        size_t      found = filename.find_last_of("\\/");
-        std::string path  = filename.substr(0, found + 1);
+        for(int64_t i = 0; i < recv_nnz; ++i)
+        {
+            entries[pos[recv_row[i] - row_begin]++] = std::make_pair(recv_col[i], recv_val[i]);
+        }
 
-        interior_name.erase(remove_if(interior_name.begin(), interior_name.end(), isspace),
-                            interior_name.end());
-        ghost_name.erase(remove_if(ghost_name.begin(), ghost_name.end(), isspace),
-                         ghost_name.end());
+        std::vector<int64_t>().swap(recv_row);
+        std::vector<int64_t>().swap(recv_col);
+        std::vector<ValueType>().swap(recv_val);
 
-        this->matrix_interior_.ReadFileMTX(path + interior_name);
-        this->matrix_ghost_.ReadFileMTX(path + ghost_name);
+        // Sort each row by column and sum up duplicates, rows are compressed in place
+        std::vector<int64_t> assembled_nnz(local_nrow + 1, 0);
 
-        // Convert ghost matrix to COO
-        this->matrix_ghost_.ConvertToCOO();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int64_t i = 0; i < local_nrow; ++i)
+        {
+            auto first = entries.begin() + row_offset[i];
+            auto last  = entries.begin() + row_offset[i + 1];
 
-        this->object_name_ = filename;
+            std::sort(first,
+                      last,
+                      [](const std::pair<int64_t, ValueType>& a,
+                         const std::pair<int64_t, ValueType>& b) { return a.first < b.first; });
 
-        // Initialize communication pattern
-        this->InitCommPattern_();
-    }
+            int64_t count = 0;
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::WriteFileMTX(const std::string& filename) const
-    {
-        log_debug(this, "GlobalMatrix::WriteFileMTX()", filename);
+            for(auto it = first; it != last; ++it)
+            {
+                if(count > 0 && (first + count - 1)->first == it->first)
+                {
+                    (first + count - 1)->second += it->second;
+                }
+                else
+                {
+                    *(first + count) = *it;
+                    ++count;
+                }
+            }
 
-        assert(this->pm_ != NULL);
+            assembled_nnz[i + 1] = count;
+        }
 
-        // Master rank writes the global headfile
-        if(this->pm_->rank_ == 0)
+        for(int64_t i = 0; i < local_nrow; ++i)
         {
-            std::ofstream headfile;
+            assembled_nnz[i + 1] += assembled_nnz[i];
+        }
 
-            headfile.open((char*)filename.c_str(), std::ofstream::out);
-            if(!headfile.is_open())
-            {
-                LOG_INFO("Cannot open GlobalMatrix file [write]: " << filename);
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
+        std::vector<int64_t>   assembled_col(assembled_nnz[local_nrow]);
+        std::vector<ValueType> assembled_val(assembled_nnz[local_nrow]);
 
-            for(int i = 0; i < this->pm_->num_procs_; ++i)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int64_t i = 0; i < local_nrow; ++i)
+        {
+            for(int64_t j = assembled_nnz[i]; j < assembled_nnz[i + 1]; ++j)
             {
-                std::ostringstream rs;
-                rs << i;
+                const std::pair<int64_t, ValueType>& e
+                    = entries[row_offset[i] + j - assembled_nnz[i]];
 
-                std::string interior_name = filename + ".interior.rank." + rs.str();
-                std::string ghost_name    = filename + ".ghost.rank." + rs.str();
-
-                headfile << interior_name << "\n";
-                headfile << ghost_name << "\n";
+                assembled_col[j] = e.first;
+                assembled_val[j] = e.second;
             }
-
-            headfile.close();
         }
 
-        std::ostringstream rs;
-        rs << this->pm_->rank_;
-
-        std::string interior_name = filename + ".interior.rank." + rs.str();
-        std::string ghost_name    = filename + ".ghost.rank." + rs.str();
+        std::vector<std::pair<int64_t, ValueType>>().swap(entries);
 
-        this->matrix_interior_.WriteFileMTX(interior_name);
-        this->matrix_ghost_.WriteFileMTX(ghost_name);
+        this->AssembleLocalRows_(
+            assembled_nnz.data(), assembled_col.data(), assembled_val.data(), "mat", pm);
     }
 
     template <typename ValueType>
-    void GlobalMatrix<ValueType>::ReadFileCSR(const std::string& filename)
+    void GlobalMatrix<ValueType>::Repartition(ParallelManager*      pm,
+                                              LocalVector<int64_t>* permutation)
     {
-        log_debug(this, "GlobalMatrix::ReadFileCSR()", filename);
+        log_debug(this, "GlobalMatrix::Repartition()", pm, permutation);
 
+        assert(pm != NULL);
+        assert(pm->comm_ != NULL);
+        assert(permutation != NULL);
         assert(this->pm_ != NULL);
-        assert(this->pm_->Status() == true);
+        assert(this->GetM() == this->GetN());
+        assert(pm->num_procs_ == this->pm_->num_procs_);
 
-        // Read header file
-        std::ifstream headfile(filename.c_str(), std::ifstream::in);
+        int     num_procs  = this->pm_->num_procs_;
+        int64_t nrow       = this->pm_->GetGlobalNrow();
+        int64_t row_begin  = this->pm_->GetGlobalRowBegin();
+        int64_t local_nrow = this->pm_->GetLocalNrow();
 
-        if(!headfile.is_open())
+        bool        accel = this->is_accel_();
+        std::string name  = this->object_name_;
+
+        // Partition the complete graph, every rank computes the same partition
+        LocalMatrix<ValueType> graph;
+        LocalVector<int>       part;
+
+        this->Gather(&graph);
+
+        graph.MoveToHost();
+        graph.ConvertToCSR();
+        graph.GraphPartition(num_procs, &part);
+
+        // Rows are numbered contiguously per part, keeping their relative order
+        std::vector<int64_t> new_index(nrow);
+        std::vector<int64_t> part_offset(num_procs + 1, 0);
+
+        for(int64_t i = 0; i < nrow; ++i)
         {
-            LOG_INFO("Cannot open GlobalMatrix file [read]: " << filename);
-            FATAL_ERROR(__FILE__, __LINE__);
+            ++part_offset[part[i] + 1];
         }
 
-        // Go to this ranks line in the headfile
-        for(int i = 0; i < this->pm_->rank_; ++i)
+        for(int n = 0; n < num_procs; ++n)
         {
-            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            part_offset[n + 1] += part_offset[n];
         }
 
-        std::string interior_name;
-        std::string ghost_name;
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            new_index[i] = part_offset[part[i]]++;
+        }
 
-        std::getline(headfile, interior_name);
-        std::getline(headfile, ghost_name);
+        part.Clear();
 
-        headfile.close();
+        // Local rows as triplets in the new numbering
+        PtrType*   csr_row_ptr = NULL;
+        int*       csr_col_ind = NULL;
+        ValueType* csr_val     = NULL;
+
+        graph.LeaveDataPtrCSR(&csr_row_ptr, &csr_col_ind, &csr_val);
+
+        PtrType begin = csr_row_ptr[row_begin];
+        int64_t nnz   = csr_row_ptr[row_begin + local_nrow] - begin;
+
+        std::vector<int64_t>   row(nnz);
+        std::vector<int64_t>   col(nnz);
+        std::vector<ValueType> val(nnz);
+
+        for(int64_t i = 0; i < local_nrow; ++i)
+        {
+            for(PtrType j = csr_row_ptr[row_begin + i]; j < csr_row_ptr[row_begin + i + 1]; ++j)
+            {
+                row[j - begin] = new_index[row_begin + i];
+                col[j - begin] = new_index[csr_col_ind[j]];
+                val[j - begin] = csr_val[j];
+            }
+        }
 
-        // Extract directory containing the subfiles
-        size_t      found = filename.find_last_of("\\/");
-        std::string path  = filename.substr(0, found + 1);
+        free_host(&csr_row_ptr);
+        free_host(&csr_col_ind);
+        free_host(&csr_val);
 
-        interior_name.erase(remove_if(interior_name.begin(), interior_name.end(), isspace),
-                            interior_name.end());
-        ghost_name.erase(remove_if(ghost_name.begin(), ghost_name.end(), isspace),
-                         ghost_name.end());
+        permutation->Clear();
+        permutation->MoveToHost();
+        permutation->Allocate("repartition permutation", local_nrow);
+        permutation->CopyFromHostData(new_index.data() + row_begin);
 
-        this->matrix_interior_.ReadFileCSR(path + interior_name);
-        this->matrix_ghost_.ReadFileCSR(path + ghost_name);
+        std::vector<int64_t>().swap(new_index);
 
-        // Convert ghost matrix to COO
-        this->matrix_ghost_.ConvertToCOO();
+        // Redistribute, the parts match the contiguous distribution of AssembleCOO()
+        this->AssembleCOO(nnz, row.data(), col.data(), val.data(), nrow, nrow, pm);
 
-        this->object_name_ = filename;
+        this->object_name_ = name;
 
-        // Initialize communication pattern
-        this->InitCommPattern_();
+        if(accel == true)
+        {
+            permutation->MoveToAccelerator();
+        }
     }
 
     template <typename ValueType>
-    void GlobalMatrix<ValueType>::WriteFileCSR(const std::string& filename) const
+    void GlobalMatrix<ValueType>::ReorderBoundaryFirst(ParallelManager*      pm,
+                                                       LocalVector<int64_t>* permutation)
     {
-        log_debug(this, "GlobalMatrix::WriteFileCSR()", filename);
+        log_debug(this, "GlobalMatrix::ReorderBoundaryFirst()", pm, permutation);
 
+        assert(pm != NULL);
+        assert(pm->comm_ != NULL);
+        assert(permutation != NULL);
         assert(this->pm_ != NULL);
+        assert(pm->num_procs_ == this->pm_->num_procs_);
 
-        // Master rank writes the global headfile
-        if(this->pm_->rank_ == 0)
+        const ParallelManager* pm_old = this->pm_;
+
+        int     num_procs  = pm_old->num_procs_;
+        int64_t local_nrow = pm_old->GetLocalNrow();
+        int64_t row_begin  = pm_old->GetGlobalRowBegin();
+
+        // Rows and columns are permuted alike, this requires the same distribution
+        assert(local_nrow == pm_old->GetLocalNcol());
+
+        // Offsets of all ranks, the distribution is kept
+        std::vector<int64_t> row_offset(num_procs + 1);
+        std::vector<int64_t> col_offset(num_procs + 1);
+
+        for(int n = 0; n < num_procs; ++n)
         {
-            std::ofstream headfile;
+            row_offset[n] = pm_old->GetGlobalRowBegin(n);
+            col_offset[n] = pm_old->GetGlobalColumnBegin(n);
 
-            headfile.open((char*)filename.c_str(), std::ofstream::out);
-            if(!headfile.is_open())
-            {
-                LOG_INFO("Cannot open GlobalMatrix file [write]: " << filename);
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
+            assert(row_offset[n] == col_offset[n]);
+        }
 
-            for(int i = 0; i < this->pm_->num_procs_; ++i)
-            {
-                std::ostringstream rs;
-                rs << i;
+        row_offset[num_procs] = pm_old->GetGlobalNrow();
+        col_offset[num_procs] = pm_old->GetGlobalNcol();
 
-                std::string interior_name = filename + ".interior.rank." + rs.str();
-                std::string ghost_name    = filename + ".ghost.rank." + rs.str();
+        // Neighbors each local row is sent to
+        int        nsend          = pm_old->nsend_;
+        const int* send_offset    = pm_old->send_offset_index_;
+        const int* boundary_index = pm_old->GetBoundaryIndex();
 
-                headfile << interior_name << "\n";
-                headfile << ghost_name << "\n";
+        std::vector<std::vector<int>> neighbors(local_nrow);
+
+        for(int n = 0; n < nsend; ++n)
+        {
+            for(int i = send_offset[n]; i < send_offset[n + 1]; ++i)
+            {
+                neighbors[boundary_index[i]].push_back(n);
             }
         }
 
-        std::ostringstream rs;
-        rs << this->pm_->rank_;
+        // Boundary rows first, grouped by their set of neighbors, such that the rows of
+        // each neighbor are contiguous whenever possible. Interior rows come last.
+        std::vector<int> order(local_nrow);
 
-        std::string interior_name = filename + ".interior.rank." + rs.str();
-        std::string ghost_name    = filename + ".ghost.rank." + rs.str();
+        for(int64_t i = 0; i < local_nrow; ++i)
+        {
+            order[i] = static_cast<int>(i);
+        }
 
-        this->matrix_interior_.WriteFileCSR(interior_name);
-        this->matrix_ghost_.WriteFileCSR(ghost_name);
-    }
+        std::stable_sort(order.begin(), order.end(), [&neighbors](int a, int b) {
+            if(neighbors[a].empty() != neighbors[b].empty())
+            {
+                return neighbors[b].empty();
+            }
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::ReadFileRSIO(const std::string& filename,
-                                               bool               maintain_initial_format)
-    {
-        log_debug(this, "GlobalMatrix::ReadFileRSIO()", filename);
+            return neighbors[a] < neighbors[b];
+        });
 
-        assert(this->pm_ != NULL);
-        assert(this->pm_->Status() == true);
+        std::vector<std::vector<int>>().swap(neighbors);
 
-        // Read header file
-        std::ifstream headfile(filename.c_str(), std::ifstream::in);
+        std::vector<int> new_pos(local_nrow);
 
-        if(!headfile.is_open())
+        for(int64_t i = 0; i < local_nrow; ++i)
         {
-            LOG_INFO("Cannot open GlobalMatrix file [read]: " << filename);
-            FATAL_ERROR(__FILE__, __LINE__);
+            new_pos[order[i]] = static_cast<int>(i);
         }
 
-        // Go to this ranks line in the headfile
-        for(int i = 0; i < this->pm_->rank_; ++i)
+        // Exchange the new local positions of the boundary rows, to renumber the ghost
+        // columns
+        std::vector<int> send_pos(pm_old->GetNumSenders());
+        std::vector<int> recv_pos(pm_old->GetNumReceivers());
+
+        for(int i = 0; i < pm_old->GetNumSenders(); ++i)
         {
-            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            headfile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            send_pos[i] = new_pos[boundary_index[i]];
         }
 
-        std::string interior_name;
-        std::string ghost_name;
+        pm_old->CommunicateAsync_(send_pos.data(), recv_pos.data());
+        pm_old->CommunicateSync_();
 
-        std::getline(headfile, interior_name);
-        std::getline(headfile, ghost_name);
+        std::vector<int64_t> ghost_col(pm_old->GetNumReceivers());
 
-        headfile.close();
+        for(int n = 0; n < pm_old->nrecv_; ++n)
+        {
+            for(int i = pm_old->recv_offset_index_[n]; i < pm_old->recv_offset_index_[n + 1];
+                ++i)
+            {
+                ghost_col[i] = col_offset[pm_old->recvs_[n]] + recv_pos[i];
+            }
+        }
 
-        // Extract directory containing the subfiles
-        size_t      found = filename.find_last_of("\\/");
-        std::string path  = filename.substr(0, found + 1);
+        // Local rows in CSR format on the host
+        LocalMatrix<ValueType> interior;
+        LocalMatrix<ValueType> ghost;
 
-        interior_name.erase(remove_if(interior_name.begin(), interior_name.end(), isspace),
-                            interior_name.end());
-        ghost_name.erase(remove_if(ghost_name.begin(), ghost_name.end(), isspace),
-                         ghost_name.end());
+        interior.CloneFrom(this->matrix_interior_);
+        interior.MoveToHost();
+        interior.ConvertToCSR();
 
-        this->matrix_interior_.ReadFileRSIO(path + interior_name, maintain_initial_format);
-        this->matrix_ghost_.ReadFileRSIO(path + ghost_name);
+        PtrType*   int_row_ptr = NULL;
+        int*       int_col_ind = NULL;
+        ValueType* int_val     = NULL;
 
-        // Convert ghost matrix to COO
-        this->matrix_ghost_.ConvertToCOO();
+        PtrType*   gst_row_ptr = NULL;
+        int*       gst_col_ind = NULL;
+        ValueType* gst_val     = NULL;
 
-        this->object_name_ = filename;
+        int64_t nnz = interior.GetNnz() + this->matrix_ghost_.GetNnz();
 
-        // Initialize communication pattern
-        this->InitCommPattern_();
-    }
+        interior.LeaveDataPtrCSR(&int_row_ptr, &int_col_ind, &int_val);
 
-    template <typename ValueType>
-    void GlobalMatrix<ValueType>::WriteFileRSIO(const std::string& filename) const
-    {
-        log_debug(this, "GlobalMatrix::WriteFileRSIO()", filename);
+        if(this->matrix_ghost_.GetNnz() > 0)
+        {
+            ghost.CloneFrom(this->matrix_ghost_);
+            ghost.MoveToHost();
+            ghost.ConvertToCSR();
+            ghost.LeaveDataPtrCSR(&gst_row_ptr, &gst_col_ind, &gst_val);
+        }
 
-        assert(this->pm_ != NULL);
+        // Permuted rows with global column indices
+        int64_t col_begin = col_offset[pm_old->rank_];
 
-        // Master rank writes the global headfile
-        if(this->pm_->rank_ == 0)
+        std::vector<int64_t>   row_ptr(local_nrow + 1);
+        std::vector<int64_t>   col(nnz);
+        std::vector<ValueType> val(nnz);
+
+        row_ptr[0] = 0;
+
+        for(int64_t k = 0; k < local_nrow; ++k)
         {
-            std::ofstream headfile;
+            int     i   = order[k];
+            int64_t idx = row_ptr[k];
 
-            headfile.open((char*)filename.c_str(), std::ofstream::out);
-            if(!headfile.is_open())
+            for(PtrType j = int_row_ptr[i]; j < int_row_ptr[i + 1]; ++j, ++idx)
             {
-                LOG_INFO("Cannot open GlobalMatrix file [write]: " << filename);
-                FATAL_ERROR(__FILE__, __LINE__);
+                col[idx] = col_begin + new_pos[int_col_ind[j]];
+                val[idx] = int_val[j];
             }
 
-            for(int i = 0; i < this->pm_->num_procs_; ++i)
+            if(gst_row_ptr != NULL)
             {
-                std::ostringstream rs;
-                rs << i;
+                for(PtrType j = gst_row_ptr[i]; j < gst_row_ptr[i + 1]; ++j, ++idx)
+                {
+                    col[idx] = ghost_col[gst_col_ind[j]];
+                    val[idx] = gst_val[j];
+                }
+            }
 
-                std::string interior_name = filename + ".interior.rank." + rs.str();
-                std::string ghost_name    = filename + ".ghost.rank." + rs.str();
+            row_ptr[k + 1] = idx;
+        }
 
-                headfile << interior_name << "\n";
-                headfile << ghost_name << "\n";
-            }
+        free_host(&int_row_ptr);
+        free_host(&int_col_ind);
+        free_host(&int_val);
+        free_host(&gst_row_ptr);
+        free_host(&gst_col_ind);
+        free_host(&gst_val);
+
+        std::vector<int64_t> new_index(local_nrow);
+
+        for(int64_t i = 0; i < local_nrow; ++i)
+        {
+            new_index[i] = row_begin + new_pos[i];
         }
 
-        std::ostringstream rs;
-        rs << this->pm_->rank_;
+        // Assemble with the new numbering, each rank keeps its rows
+        std::string name = this->object_name_;
 
-        std::string interior_name = filename + ".interior.rank." + rs.str();
-        std::string ghost_name    = filename + ".ghost.rank." + rs.str();
+        this->PartitionOffsets_(row_offset.data(), col_offset.data(), pm);
+        this->AssembleLocalRows_(row_ptr.data(), col.data(), val.data(), name, pm);
+
+        bool accel = this->is_accel_();
 
-        this->matrix_interior_.WriteFileRSIO(interior_name);
-        this->matrix_ghost_.WriteFileRSIO(ghost_name);
+        permutation->Clear();
+        permutation->MoveToHost();
+        permutation->Allocate("boundary first permutation", local_nrow);
+        permutation->CopyFromHostData(new_index.data());
+
+        if(accel == true)
+        {
+            permutation->MoveToAccelerator();
+        }
     }
 
     template <typename ValueType>
@@ -2314,10 +5197,37 @@ namespace rocalution
         }
 
 #ifdef SUPPORT_MULTINODE
+        assert(this->is_host_() == G.is_host_());
+
         // MPI Requests for sync
         std::vector<MRequest> req_mapping(this->pm_->nrecv_ + this->pm_->nsend_);
         std::vector<MRequest> req_offsets(this->pm_->nrecv_ + this->pm_->nsend_);
 
+        // Gather the coarse indices of the fine boundary on the backend of G, such that only
+        // the boundary instead of the full mapping is transferred to the host
+        int* hG_boundary = NULL;
+        allocate_host(this->pm_->send_index_size_, &hG_boundary);
+
+        LocalVector<int> G_boundary;
+        G_boundary.CloneBackend(*this);
+        G_boundary.Allocate("G boundary", this->pm_->send_index_size_);
+
+        G.GetIndexValues(this->halo_, &G_boundary);
+        G_boundary.CopyToHostData(hG_boundary);
+        G_boundary.Clear();
+
+        LocalVector<int> host_G_boundary;
+        host_G_boundary.SetDataPtr(&hG_boundary, "G boundary", this->pm_->send_index_size_);
+
+        // The gathered boundary is addressed contiguously
+        int* boundary_position = NULL;
+        allocate_host(this->pm_->send_index_size_, &boundary_position);
+
+        for(int i = 0; i < this->pm_->send_index_size_; ++i)
+        {
+            boundary_position[i] = i;
+        }
+
         // Determine connected pairs for the ghost layer of neighboring ranks
         int** send_ghost_map = new int*[this->pm_->nsend_];
         int** recv_ghost_map = new int*[this->pm_->nrecv_];
@@ -2341,12 +5251,12 @@ namespace rocalution
             send_ghost_map[n]
                 = new int[this->pm_->send_offset_index_[n + 1] - this->pm_->send_offset_index_[n]];
 
-            G.ExtractCoarseMapping(this->pm_->send_offset_index_[n],
-                                   this->pm_->send_offset_index_[n + 1],
-                                   this->pm_->boundary_index_,
-                                   nrow,
-                                   &send_map_size[n],
-                                   send_ghost_map[n]);
+            host_G_boundary.ExtractCoarseMapping(this->pm_->send_offset_index_[n],
+                                                 this->pm_->send_offset_index_[n + 1],
+                                                 boundary_position,
+                                                 nrow,
+                                                 &send_map_size[n],
+                                                 send_ghost_map[n]);
 
             // Send sizes
             communication_async_send(&send_map_size[n],
@@ -2397,16 +5307,19 @@ namespace rocalution
         int m = 0;
         for(int n = 0; n < this->pm_->nsend_; ++n)
         {
-            G.ExtractCoarseBoundary(this->pm_->send_offset_index_[n],
-                                    this->pm_->send_offset_index_[n + 1],
-                                    this->pm_->boundary_index_,
-                                    nrow,
-                                    &m,
-                                    boundary_index);
+            host_G_boundary.ExtractCoarseBoundary(this->pm_->send_offset_index_[n],
+                                                  this->pm_->send_offset_index_[n + 1],
+                                                  boundary_position,
+                                                  nrow,
+                                                  &m,
+                                                  boundary_index);
 
             send_offset_index[n + 1] = m;
         }
 
+        free_host(&boundary_position);
+        host_G_boundary.Clear();
+
         // Communicate boundary offsets
         for(int n = 0; n < this->pm_->nrecv_; ++n)
         {
@@ -2430,32 +5343,32 @@ namespace rocalution
 
         int boundary_size = m;
 
-        // Coarsen interior part of the matrix on the host (no accelerator support)
-        LocalMatrix<ValueType> tmp;
-        LocalMatrix<ValueType> host_interior;
-
-        if(this->is_accel_())
-        {
-            host_interior.ConvertTo(this->GetInterior().GetFormat(),
-                                    this->GetInterior().GetBlockDimension());
-            host_interior.CopyFrom(this->GetInterior());
+        // Only CSR matrices are supported
+        LocalMatrix<ValueType> csr_int;
+        LocalMatrix<ValueType> csr_gst;
 
-            LocalVector<int> host_G;
-            host_G.CopyFrom(G);
+        const LocalMatrix<ValueType>* int_ptr = &this->matrix_interior_;
+        const LocalMatrix<ValueType>* gst_ptr = &this->matrix_ghost_;
 
-            host_interior.CoarsenOperator(&tmp, nrow, nrow, host_G, Gsize, rG, rGsize);
+        if(int_ptr->GetFormat() != CSR)
+        {
+            csr_int.CloneFrom(*int_ptr);
+            csr_int.ConvertToCSR();
+            int_ptr = &csr_int;
         }
-        else
+
+        if(gst_ptr->GetFormat() != CSR)
         {
-            this->matrix_interior_.CoarsenOperator(&tmp, nrow, nrow, G, Gsize, rG, rGsize);
+            csr_gst.CloneFrom(*gst_ptr);
+            csr_gst.ConvertToCSR();
+            gst_ptr = &csr_gst;
         }
 
-        PtrType*   Ac_interior_row_offset = NULL;
-        int*       Ac_interior_col        = NULL;
-        ValueType* Ac_interior_val        = NULL;
+        // Coarsen interior part of the matrix on the backend of this matrix
+        LocalMatrix<ValueType> tmp;
+        tmp.CloneBackend(*this);
 
-        int64_t nnzc = tmp.GetNnz();
-        tmp.LeaveDataPtrCSR(&Ac_interior_row_offset, &Ac_interior_col, &Ac_interior_val);
+        int_ptr->CoarsenOperator(&tmp, nrow, nrow, G, Gsize, rG, rGsize);
 
         // Wait for boundary offset communication to finish
         communication_syncall(this->pm_->nrecv_ + this->pm_->nsend_, &req_offsets[0]);
@@ -2505,30 +5418,33 @@ namespace rocalution
         delete[] recv_ghost_map;
         free_host(&recv_map_size);
 
-        // Coarsen ghost part of the matrix on the host (no accelerator support)
+        // Coarsen ghost part of the matrix on the backend of this matrix
         LocalVector<int> G_ghost;
         G_ghost.SetDataPtr(&ghost_G, "G ghost", this->pm_->recv_offset_index_[this->pm_->nrecv_]);
+        G_ghost.CloneBackend(*this);
 
         LocalMatrix<ValueType> tmp_ghost;
-        LocalMatrix<ValueType> host_ghost;
-
-        if(this->is_accel_())
-        {
-            host_ghost.ConvertTo(this->GetGhost().GetFormat(),
-                                 this->GetGhost().GetBlockDimension());
-            host_ghost.CopyFrom(this->GetGhost());
+        tmp_ghost.CloneBackend(*this);
 
-            host_ghost.CoarsenOperator(
-                &tmp_ghost, nrow, this->pm_->GetNumReceivers(), G_ghost, Gsize, rG, rGsize);
-        }
-        else
-        {
-            this->matrix_ghost_.CoarsenOperator(
-                &tmp_ghost, nrow, this->pm_->GetNumReceivers(), G_ghost, Gsize, rG, rGsize);
-        }
+        gst_ptr->CoarsenOperator(
+            &tmp_ghost, nrow, this->pm_->GetNumReceivers(), G_ghost, Gsize, rG, rGsize);
 
         G_ghost.Clear();
 
+        // Clear old Ac, the coarse parts are moved to its backend
+        Ac->Clear();
+        tmp.CloneBackend(*Ac);
+        tmp_ghost.CloneBackend(*Ac);
+        tmp.ConvertToCSR();
+        tmp_ghost.ConvertToCSR();
+
+        PtrType*   Ac_interior_row_offset = NULL;
+        int*       Ac_interior_col        = NULL;
+        ValueType* Ac_interior_val        = NULL;
+
+        int64_t nnzc = tmp.GetNnz();
+        tmp.LeaveDataPtrCSR(&Ac_interior_row_offset, &Ac_interior_col, &Ac_interior_val);
+
         PtrType*   Ac_ghost_row_offset = NULL;
         int*       Ac_ghost_col        = NULL;
         ValueType* Ac_ghost_val        = NULL;
@@ -2536,11 +5452,6 @@ namespace rocalution
         int64_t nnzg = tmp_ghost.GetNnz();
         tmp_ghost.LeaveDataPtrCSR(&Ac_ghost_row_offset, &Ac_ghost_col, &Ac_ghost_val);
 
-        // Clear old Ac
-        Ac->Clear();
-        bool isaccel = Ac->is_accel_();
-        Ac->MoveToHost();
-
         // Communicator
         Ac->CreateParallelManager_();
         Ac->pm_self_->SetMPICommunicator(this->pm_->comm_);
@@ -2577,11 +5488,6 @@ namespace rocalution
                           "",
                           nnzc,
                           nnzg);
-
-        if(isaccel == true)
-        {
-            Ac->MoveToAccelerator();
-        }
 #endif
     }
 
@@ -2600,6 +5506,21 @@ namespace rocalution
         this->matrix_interior_.CreateFromMap(map, n, m, &pro->matrix_interior_);
     }
 
+    template <typename ValueType>
+    bool GlobalMatrix<ValueType>::ExtractAggregateMap(LocalVector<int>* map,
+                                                      ValueType*        weight) const
+    {
+        log_debug(this, "GlobalMatrix::ExtractAggregateMap()", map, weight);
+
+        // Operators with parallel manager may couple to the aggregates of other processes
+        if(this->pm_ != NULL)
+        {
+            return false;
+        }
+
+        return this->matrix_interior_.ExtractAggregateMap(map, weight);
+    }
+
     template <typename ValueType>
     void GlobalMatrix<ValueType>::AMGGreedyAggregate(
         ValueType             eps,
@@ -2640,6 +5561,45 @@ namespace rocalution
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::AMGNodeGraph(int blockdim, GlobalMatrix<ValueType>* node) const
+    {
+        log_debug(this, "GlobalMatrix::AMGNodeGraph()", blockdim, node);
+
+        LOG_VERBOSE_INFO(2,
+                         "*** error: GlobalMatrix::AMGNodeGraph() is not available on "
+                         "GlobalMatrix class");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void GlobalMatrix<ValueType>::AMGNodeExpand(
+        int                            blockdim,
+        const GlobalMatrix<ValueType>& node,
+        const LocalVector<bool>&       node_connections,
+        const LocalVector<int64_t>&    node_aggregates,
+        const LocalVector<int64_t>&    node_aggregate_root_nodes,
+        LocalVector<bool>*             connections,
+        LocalVector<int64_t>*          aggregates,
+        LocalVector<int64_t>*          aggregate_root_nodes) const
+    {
+        log_debug(this,
+                  "GlobalMatrix::AMGNodeExpand()",
+                  blockdim,
+                  (const void*&)node,
+                  (const void*&)node_connections,
+                  (const void*&)node_aggregates,
+                  (const void*&)node_aggregate_root_nodes,
+                  connections,
+                  aggregates,
+                  aggregate_root_nodes);
+
+        LOG_VERBOSE_INFO(2,
+                         "*** error: GlobalMatrix::AMGNodeExpand() is not available on "
+                         "GlobalMatrix class");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
     template <typename ValueType>
     void GlobalMatrix<ValueType>::AMGPMISAggregate(ValueType             eps,
                                                    LocalVector<bool>*    connections,
@@ -3259,18 +6219,9 @@ namespace rocalution
         prolong->CreateParallelManager_();
         prolong->pm_self_->SetMPICommunicator(this->pm_->comm_);
 
-        // To generate the parallel manager, we need to access the sorted global ghost column ids
-        LocalVector<int64_t> sorted_ghost_col;
-        sorted_ghost_col.CloneBackend(*this);
-        sorted_ghost_col.Allocate("sorted global ghost columns", ghost_col.GetSize());
-
-        // Sort the global ghost columns (we do not need the permutation vector)
-        ghost_col.Sort(&sorted_ghost_col, NULL);
-
-        // Get the sorted ghost columns on host
+        // To generate the parallel manager, we need the distinct global ghost column ids
         int64_t* pghost_col = NULL;
-        sorted_ghost_col.MoveToHost();
-        sorted_ghost_col.LeaveDataPtr(&pghost_col);
+        int64_t  nghost_col = unique_ghost_columns(ghost_col, &pghost_col);
 
         // Sizes
         prolong->pm_self_->SetGlobalNrow(this->pm_->global_nrow_);
@@ -3279,8 +6230,7 @@ namespace rocalution
         prolong->pm_self_->SetLocalNcol(local_ncol);
 
         // Generate the PM
-        prolong->pm_self_->GenerateFromGhostColumnsWithParent_(
-            prolong->matrix_ghost_.GetNnz(), pghost_col, *this->pm_);
+        prolong->pm_self_->GenerateFromGhostColumnsWithParent_(nghost_col, pghost_col, *this->pm_);
 
         // Communicate offsets
         prolong->pm_self_->CommunicateGlobalOffsetAsync_();
@@ -3467,18 +6417,9 @@ namespace rocalution
         prolong->CreateParallelManager_();
         prolong->pm_self_->SetMPICommunicator(this->pm_->comm_);
 
-        // To generate the parallel manager, we need to access the sorted global ghost column ids
-        LocalVector<int64_t> sorted_ghost_col;
-        sorted_ghost_col.CloneBackend(*this);
-        sorted_ghost_col.Allocate("sorted global ghost columns", ghost_col.GetSize());
-
-        // Sort the global ghost columns (we do not need the permutation vector)
-        ghost_col.Sort(&sorted_ghost_col, NULL);
-
-        // Get the sorted ghost columns on host
+        // To generate the parallel manager, we need the distinct global ghost column ids
         int64_t* pghost_col = NULL;
-        sorted_ghost_col.MoveToHost();
-        sorted_ghost_col.LeaveDataPtr(&pghost_col);
+        int64_t  nghost_col = unique_ghost_columns(ghost_col, &pghost_col);
 
         // Sizes
         prolong->pm_self_->SetGlobalNrow(this->pm_->global_nrow_);
@@ -3487,8 +6428,7 @@ namespace rocalution
         prolong->pm_self_->SetLocalNcol(local_ncol);
 
         // Generate the PM
-        prolong->pm_self_->GenerateFromGhostColumnsWithParent_(
-            prolong->matrix_ghost_.GetNnz(), pghost_col, *this->pm_);
+        prolong->pm_self_->GenerateFromGhostColumnsWithParent_(nghost_col, pghost_col, *this->pm_);
 
         // Communicate offsets
         prolong->pm_self_->CommunicateGlobalOffsetAsync_();
@@ -3959,18 +6899,9 @@ namespace rocalution
         prolong->CreateParallelManager_();
         prolong->pm_self_->SetMPICommunicator(this->pm_->comm_);
 
-        // To generate the parallel manager, we need to access the sorted global ghost column ids
-        LocalVector<int64_t> sorted_ghost_col;
-        sorted_ghost_col.CloneBackend(*this);
-        sorted_ghost_col.Allocate("sorted global ghost columns", ghost_col.GetSize());
-
-        // Sort the global ghost columns (we do not need the permutation vector)
-        ghost_col.Sort(&sorted_ghost_col, NULL);
-
-        // Get the sorted ghost columns on host
+        // To generate the parallel manager, we need the distinct global ghost column ids
         int64_t* pghost_col = NULL;
-        sorted_ghost_col.MoveToHost();
-        sorted_ghost_col.LeaveDataPtr(&pghost_col);
+        int64_t  nghost_col = unique_ghost_columns(ghost_col, &pghost_col);
 
 #ifdef SUPPORT_MULTINODE
         communication_sync(&req);
@@ -3983,8 +6914,7 @@ namespace rocalution
         prolong->pm_self_->SetLocalNcol(local_ncol);
 
         // Generate the PM
-        prolong->pm_self_->GenerateFromGhostColumnsWithParent_(
-            prolong->matrix_ghost_.GetNnz(), pghost_col, *this->pm_);
+        prolong->pm_self_->GenerateFromGhostColumnsWithParent_(nghost_col, pghost_col, *this->pm_);
 
         // Communicate global offsets
         prolong->pm_self_->CommunicateGlobalOffsetAsync_();
@@ -4378,18 +7308,9 @@ namespace rocalution
         prolong->CreateParallelManager_();
         prolong->pm_self_->SetMPICommunicator(this->pm_->comm_);
 
-        // To generate the parallel manager, we need to access the sorted global ghost column ids
-        LocalVector<int64_t> sorted_ghost_col;
-        sorted_ghost_col.CloneBackend(*this);
-        sorted_ghost_col.Allocate("sorted global ghost columns", ghost_col.GetSize());
-
-        // Sort the global ghost columns (we do not need the permutation vector)
-        ghost_col.Sort(&sorted_ghost_col, NULL);
-
-        // Get the sorted ghost columns on host
+        // To generate the parallel manager, we need the distinct global ghost column ids
         int64_t* pghost_col = NULL;
-        sorted_ghost_col.MoveToHost();
-        sorted_ghost_col.LeaveDataPtr(&pghost_col);
+        int64_t  nghost_col = unique_ghost_columns(ghost_col, &pghost_col);
 
 #ifdef SUPPORT_MULTINODE
         communication_sync(&req);
@@ -4402,8 +7323,7 @@ namespace rocalution
         prolong->pm_self_->SetLocalNcol(local_ncol);
 
         // Generate the PM
-        prolong->pm_self_->GenerateFromGhostColumnsWithParent_(
-            prolong->matrix_ghost_.GetNnz(), pghost_col, *this->pm_);
+        prolong->pm_self_->GenerateFromGhostColumnsWithParent_(nghost_col, pghost_col, *this->pm_);
 
         // Communicate offsets
         prolong->pm_self_->CommunicateGlobalOffsetAsync_();
@@ -4492,9 +7412,57 @@ namespace rocalution
         this->halo_.Allocate(halo_name, this->pm_->GetNumSenders());
         this->halo_.CopyFromHostData(this->pm_->GetBoundaryIndex());
 
+        // If the boundary rows of each neighbor form a contiguous range, the send
+        // buffers can alias the vector directly
+        const int* boundary_index = this->pm_->GetBoundaryIndex();
+        const int* send_offset    = this->pm_->send_offset_index_;
+
+        bool contiguous = this->pm_->nsend_ > 0;
+
+        for(int n = 0; n < this->pm_->nsend_ && contiguous == true; ++n)
+        {
+            for(int i = send_offset[n] + 1; i < send_offset[n + 1]; ++i)
+            {
+                if(boundary_index[i] != boundary_index[i - 1] + 1)
+                {
+                    contiguous = false;
+                    break;
+                }
+            }
+        }
+
+        free_host(&this->halo_slice_);
+
+        if(contiguous == true)
+        {
+            allocate_host(this->pm_->nsend_, &this->halo_slice_);
+
+            for(int n = 0; n < this->pm_->nsend_; ++n)
+            {
+                this->halo_slice_[n]
+                    = send_offset[n] < send_offset[n + 1] ? boundary_index[send_offset[n]] : 0;
+            }
+        }
+
         this->recv_buffer_.Allocate("receive buffer", this->pm_->GetNumReceivers());
         this->send_buffer_.Allocate("send buffer", this->pm_->GetNumSenders());
 
+        if(this->halo_float_ == true)
+        {
+            this->recv_buffer_float_.Allocate("receive buffer", this->pm_->GetNumReceivers());
+            this->send_buffer_float_.Allocate("send buffer", this->pm_->GetNumSenders());
+
+            if(this->recv_boundary_float_ == NULL)
+            {
+                allocate_pinned(this->pm_->GetNumReceivers(), &this->recv_boundary_float_);
+            }
+
+            if(this->send_boundary_float_ == NULL)
+            {
+                allocate_pinned(this->pm_->GetNumSenders(), &this->send_boundary_float_);
+            }
+        }
+
         if(this->recv_boundary_ == NULL)
         {
             allocate_pinned(this->pm_->GetNumReceivers(), &this->recv_boundary_);
@@ -25,6 +25,7 @@
 #define ROCALUTION_GLOBAL_MATRIX_HPP_
 
 #include "local_vector.hpp"
+#include "matrix_formats.hpp"
 #include "operator.hpp"
 #include "parallel_manager.hpp"
 #include "rocalution/utils/types.hpp"
@@ -93,8 +94,13 @@ namespace rocalution
         virtual void MoveToAccelerator(void);
         /** \brief Move all data (i.e. move the part of the global matrix stored on this rank) to the host */
         virtual void MoveToHost(void);
+        /** \brief Migrate the matrix data to the accelerator (managed memory mode) */
+        virtual void Prefetch(void) const;
         /** \brief Shows simple info about the matrix. */
         virtual void Info(void) const;
+        /** \brief Print statistics of the halo exchange, see
+      * ParallelManager::CommunicationInfo(). This is a collective call. */
+        void CommunicationInfo(void) const;
 
         /** \brief Perform a sanity check of the matrix
         * \details
@@ -176,12 +182,47 @@ namespace rocalution
         /** \brief Leave a COO ghost matrix to host pointers */
         void LeaveGhostDataPtrCOO(int** row, int** col, ValueType** val);
 
+        /** \brief Update interior and ghost CSR entries only, structure and communication
+        * pattern remain the same
+        * \details
+        * \p val holds the interior values in CSR order, followed by the ghost values in
+        * CSR order. If \p perm is given, \p val[k] is the new value of entry \p perm[k] of
+        * this combined numbering instead, e.g. to update the values directly from the
+        * order they are assembled in. \p val and \p perm have to be on the same backend as
+        * the matrix, no data is transferred between host and accelerator and the
+        * ParallelManager is not touched.
+        */
+        ROCALUTION_EXPORT
+        void UpdateValuesCSR(const LocalVector<ValueType>& val,
+                             const LocalVector<int>*       perm = NULL);
+
         /** \brief Clone the entire matrix (values,structure+backend descr) from another
         * GlobalMatrix
         */
         void CloneFrom(const GlobalMatrix<ValueType>& src);
         /** \brief Copy matrix (values and structure) from another GlobalMatrix */
         void CopyFrom(const GlobalMatrix<ValueType>& src);
+        /** \brief Gather the whole matrix on each process
+      * \details
+      * All rows of the matrix are gathered into \p mat, such that each process holds a
+      * copy of the entire matrix in CSR format with global row and column numbering.
+      * \p mat is placed on the backend of this matrix. This is meant for small matrices
+      * only, e.g. the coarsest level of a multigrid hierarchy.
+      */
+        void Gather(LocalMatrix<ValueType>* mat) const;
+        /** \brief Extract the local matrix extended by one layer of overlap
+      * \details
+      * The rows of all ghost columns are fetched from the neighboring processes and
+      * appended to the interior rows, such that \p mat holds the matrix of the
+      * overlapping subdomain in CSR format. The ghost unknowns are numbered after the
+      * local unknowns, in the order of the ghost columns. Columns of the fetched rows
+      * that lie outside of the overlapping subdomain are dropped. \p mat is placed on
+      * the backend of this matrix.
+      */
+        void ExtractOverlapMatrix(LocalMatrix<ValueType>* mat) const;
+        /** \brief Obtain the values of \p in at the ghost columns of this matrix */
+        void GetGhostValues(const GlobalVector<ValueType>& in,
+                            LocalVector<ValueType>*        ghost) const;
 
         /** \brief Convert the matrix to CSR structure */
         void ConvertToCSR(void);
@@ -199,8 +240,37 @@ namespace rocalution
         void ConvertToHYB(void);
         /** \brief Convert the matrix to DENSE structure */
         void ConvertToDENSE(void);
+        /** \brief Convert the matrix to SELL-C-sigma (sliced ELL) structure */
+        void ConvertToSELL(void);
+        /** \brief Convert the matrix to VBR (variable block row) structure */
+        void ConvertToVBR(void);
         /** \brief Convert the matrix to specified matrix ID format */
         void ConvertTo(unsigned int matrix_format, int blockdim = 1);
+        /** \brief Convert the interior matrix to the format with the fastest
+      * matrix-vector product, see LocalMatrix::ConvertToBest()
+      */
+        void ConvertToBest(int trials = 10);
+        /** \brief Set the algorithm of the CSR matrix-vector product of the interior
+      * and ghost matrices, see LocalMatrix::SetSpMVAlg()
+      */
+        void SetSpMVAlg(SpMVAlg alg);
+        /** \brief Set the value storage of the CSR matrix-vector product of the interior
+      * and ghost matrices, see LocalMatrix::SetSpMVStorage()
+      */
+        void SetSpMVStorage(SpMVStorage storage);
+        /** \brief Set the column index storage of the CSR matrix-vector product of the
+      * interior and ghost matrices, see LocalMatrix::SetSpMVIndex()
+      */
+        void SetSpMVIndex(SpMVIndex index);
+        /** \brief Exchange the halo values of Apply() in single precision
+      * \details
+      * Boundary values are rounded to single precision while the send buffer is
+      * gathered and expanded to double precision on receipt, halving the communication
+      * volume of each matrix-vector product. This is meant for operators where the
+      * accuracy of the ghost contribution is not critical, e.g. within preconditioners or
+      * on coarse AMG levels, and is only available for double precision matrices.
+      */
+        void SetReducedPrecisionHalo(bool enable);
 
         /** \brief Perform matrix-vector multiplication, out = this * in; */
         virtual void Apply(const GlobalVector<ValueType>& in, GlobalVector<ValueType>* out) const;
@@ -209,6 +279,35 @@ namespace rocalution
                               ValueType                      scalar,
                               GlobalVector<ValueType>*       out) const;
 
+        /** \brief Perform transposed matrix-vector multiplication, out = this^T * in;
+      * \details
+      * The transposed matrix is not formed explicitly. The contributions of the ghost
+      * part are sent back to the processes owning the corresponding columns.
+      */
+        void ApplyTranspose(const GlobalVector<ValueType>& in, GlobalVector<ValueType>* out) const;
+        /** \brief Perform transposed matrix-vector multiplication, out = scalar * this^T * in
+      * + out;
+      */
+        void ApplyTransposeAdd(const GlobalVector<ValueType>& in,
+                               ValueType                      scalar,
+                               GlobalVector<ValueType>*       out) const;
+
+        /** \brief Perform matrix-vector multiplication for a subset of local rows,
+      * out[i] = (this * in)[i] for all i in \p rows, see LocalMatrix::ApplyRows()
+      * \details
+      * Only the ghost rows of the listed rows are applied to the received halo values.
+      */
+        void ApplyRows(const GlobalVector<ValueType>& in,
+                       const LocalVector<int>&        rows,
+                       GlobalVector<ValueType>*       out) const;
+        /** \brief Compute the residual for a subset of local rows,
+      * res[i] = (rhs - this * x)[i] for all i in \p rows, see LocalMatrix::ResidualRows()
+      */
+        void ResidualRows(const GlobalVector<ValueType>& rhs,
+                          const GlobalVector<ValueType>& x,
+                          const LocalVector<int>&        rows,
+                          GlobalVector<ValueType>*       res) const;
+
         /** \brief Transpose the matrix */
         virtual void Transpose(void);
 
@@ -220,6 +319,47 @@ namespace rocalution
                                  const GlobalMatrix<ValueType>& A,
                                  const GlobalMatrix<ValueType>& P);
 
+        /** \brief Perform distributed matrix-matrix multiplication, this = A * B
+      * \details
+      * The rows of \p B that are required due to the ghost columns of \p A are fetched
+      * from the neighboring processes, as in TripleMatrixProduct(). The parallel manager
+      * of the product is generated from its ghost columns and the column distribution of
+      * \p B.
+      */
+        void MatrixMult(const GlobalMatrix<ValueType>& A, const GlobalMatrix<ValueType>& B);
+        /** \brief Recompute the values of a distributed matrix-matrix product
+      * \details
+      * \p MatrixMultNumeric requires a previous MatrixMult() of two matrices with the same
+      * sparsity patterns as \p A and \p B. MatrixMult() keeps the structure of the
+      * product until the matrix is cleared: the parallel manager, the row lengths and
+      * local column ids of the boundary rows of \p B that are fetched from the neighbors
+      * and the sparsity pattern of the local rows of the product. MatrixMultNumeric
+      * therefore only exchanges the values of the boundary rows of \p B and performs a
+      * numeric SpGEMM pass, the sparsity pattern of the product is not changed. Keeping
+      * the structure requires additional memory in the order of the local rows of the
+      * product.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   C.MatrixMult(A, B);
+      *
+      *   // Modify the values of A and B, keeping their sparsity patterns
+      *
+      *   C.MatrixMultNumeric(A, B);
+      * \endcode
+      */
+        void MatrixMultNumeric(const GlobalMatrix<ValueType>& A, const GlobalMatrix<ValueType>& B);
+        /** \brief Perform distributed matrix-matrix addition, this = alpha * A + beta * B
+      * \details
+      * \p A and \p B need to have the same row and column distribution. Their ghost
+      * parts are merged in terms of global column ids and the parallel manager of the
+      * sum is generated from the merged ghost columns.
+      */
+        void MatrixAdd(const GlobalMatrix<ValueType>& A,
+                       ValueType                      alpha,
+                       const GlobalMatrix<ValueType>& B,
+                       ValueType                      beta);
+
         /** \brief Read matrix from MTX (Matrix Market Format) file */
         void ReadFileMTX(const std::string& filename);
         /** \brief Write matrix to MTX (Matrix Market Format) file */
@@ -241,9 +381,137 @@ namespace rocalution
         ROCALUTION_EXPORT
         void ReadFileRSIO(const std::string& filename, bool maintain_initial_format = false);
 
-        /** \brief Write a matrix to binary file using rocsparse I/O format */
+        /** \brief Write a matrix to binary file using rocsparse I/O format
+        * \details
+        * If \p compress is true, interior and ghost part are written to compressed CSR
+        * files, see LocalMatrix::WriteFileRSIO().
+        */
+        ROCALUTION_EXPORT
+        void WriteFileRSIO(const std::string& filename, bool compress = false) const;
+
+        /** \brief Read and distribute a matrix from a single CSR (ROCALUTION binary format)
+        * file
+        * \details
+        * In contrast to ReadFileCSR(), the file holds the complete matrix and no per rank
+        * files are required. Rows and columns are partitioned into contiguous blocks of
+        * (almost) equal size, each rank reads its block of rows with collective MPI-IO
+        * reads. The communication pattern is generated on the fly and stored in \p pm,
+        * which only requires its communicator to be set. All other data of \p pm is
+        * replaced, the matrix is then attached to \p pm.
+        *
+        * \par Example
+        * \code{.cpp}
+        *   ParallelManager pm;
+        *   pm.SetMPICommunicator(&comm);
+        *
+        *   GlobalMatrix<ValueType> mat;
+        *   mat.ReadFileDistributedCSR("matrix.csr", &pm);
+        *
+        *   GlobalVector<ValueType> vec(pm);
+        * \endcode
+        */
+        ROCALUTION_EXPORT
+        void ReadFileDistributedCSR(const std::string& filename, ParallelManager* pm);
+
+        /** \brief Read and distribute a matrix from a single file using rocsparse I/O
+        * format
+        * \details
+        * See ReadFileDistributedCSR(). The file has to contain a CSR matrix.
+        */
+        ROCALUTION_EXPORT
+        void ReadFileDistributedRSIO(const std::string& filename, ParallelManager* pm);
+
+        /** \brief Write a distributed matrix to a single CSR (ROCALUTION binary format) file
+        * \details
+        * Counterpart of ReadFileDistributedCSR(). All ranks write their rows with global
+        * column indices into one file, using collective MPI-IO writes at the offsets of
+        * their row blocks. The file can be read by LocalMatrix::ReadFileCSR() or by
+        * ReadFileDistributedCSR() with an arbitrary number of ranks.
+        */
+        ROCALUTION_EXPORT
+        void WriteFileDistributedCSR(const std::string& filename) const;
+
+        /** \brief Assemble a distributed matrix from global COO triplets
+        * \details
+        * Each rank passes \p nnz triplets (\p row, \p col, \p val) in global indices.
+        * Triplets are not required to belong to the local rows of the rank, entries of
+        * rows owned by other ranks are sent to their owner. Rows and columns of the
+        * \p global_nrow x \p global_ncol matrix are partitioned into contiguous blocks of
+        * (almost) equal size, as in ReadFileDistributedCSR(). Duplicate entries are
+        * summed up. The communication pattern is generated on the fly and stored in
+        * \p pm, which only requires its communicator to be set. All other data of \p pm
+        * is replaced, the matrix is then attached to \p pm.
+        *
+        * \par Example
+        * \code{.cpp}
+        *   ParallelManager pm;
+        *   pm.SetMPICommunicator(&comm);
+        *
+        *   // Element contributions, possibly touching rows of neighboring ranks
+        *   GlobalMatrix<ValueType> mat;
+        *   mat.AssembleCOO(nnz, row, col, val, nrow, ncol, &pm);
+        *
+        *   GlobalVector<ValueType> vec(pm);
+        * \endcode
+        */
+        ROCALUTION_EXPORT
+        void AssembleCOO(int64_t          nnz,
+                         const int64_t*   row,
+                         const int64_t*   col,
+                         const ValueType* val,
+                         int64_t          global_nrow,
+                         int64_t          global_ncol,
+                         ParallelManager* pm);
+
+        /** \brief Redistribute the rows of a square matrix to reduce communication
+        * \details
+        * The rows are repartitioned with LocalMatrix::GraphPartition() on the gathered
+        * sparsity pattern, one part per rank, such that few entries couple rows of
+        * different ranks. This reduces the ghost part and the number of neighbors of each
+        * rank, and thus the communication volume of each SpMV. Rows are renumbered
+        * contiguously per part, each rank keeps its number of rows of a contiguous block
+        * distribution. The complete matrix is gathered on the host of every rank, thus each
+        * rank requires O(global nnz) memory for it, plus O(global nrow) for the partition
+        * and the new numbering, regardless of its local share. The repartitioning is meant
+        * to be done once after assembly, for matrices that fit into the memory of a single
+        * rank.
+        *
+        * As in AssembleCOO(), the communication pattern is stored in \p pm, which only
+        * requires its communicator to be set, and the matrix is attached to \p pm.
+        * \p permutation returns the new global index of each local row of the previous
+        * distribution, vectors are moved along with GlobalVector::Repartition().
+        *
+        * \par Example
+        * \code{.cpp}
+        *   ParallelManager pm_part;
+        *   pm_part.SetMPICommunicator(&comm);
+        *
+        *   LocalVector<int64_t> perm;
+        *   mat.Repartition(&pm_part, &perm);
+        *
+        *   rhs.Repartition(pm_part, perm);
+        *
+        *   GlobalVector<ValueType> x(pm_part);
+        * \endcode
+        */
+        ROCALUTION_EXPORT
+        void Repartition(ParallelManager* pm, LocalVector<int64_t>* permutation);
+
+        /** \brief Renumber the local rows such that boundary rows come first
+        * \details
+        * Rows that are sent to other ranks are placed first, grouped by the set of ranks
+        * they are sent to, interior rows are placed last. Whenever the boundary rows of
+        * each neighbor form a contiguous range, Apply() sends slices of the input vector
+        * directly, instead of gathering the send buffer with an index kernel on every SpMV.
+        * Each rank keeps its rows, only the numbering within a rank changes.
+        *
+        * The communication pattern is stored in \p pm, which only requires its
+        * communicator to be set, and the matrix is attached to \p pm. \p permutation
+        * returns the new global index of each local row, vectors are moved along with
+        * GlobalVector::Repartition().
+        */
         ROCALUTION_EXPORT
-        void WriteFileRSIO(const std::string& filename) const;
+        void ReorderBoundaryFirst(ParallelManager* pm, LocalVector<int64_t>* permutation);
 
         /** \brief Sort the matrix indices
         * \details
@@ -294,6 +562,13 @@ namespace rocalution
                            int64_t                  n,
                            int64_t                  m,
                            GlobalMatrix<ValueType>* pro);
+        /** \brief Extract the aggregate map of a piecewise constant prolongation, see
+        * LocalMatrix::ExtractAggregateMap()
+        * \details
+        * Only operators without parallel manager, i.e. the local transfer operators
+        * created by CreateFromMap(), are supported. False is returned otherwise.
+        */
+        bool ExtractAggregateMap(LocalVector<int>* map, ValueType* weight) const;
 
         /** \brief Plain aggregation - Modification of a greedy aggregation scheme from
         * Vanek (1996)
@@ -313,6 +588,21 @@ namespace rocalution
                               LocalVector<int64_t>* aggregates,
                               LocalVector<int64_t>* aggregate_root_nodes) const;
 
+        /** \brief Node graph for block-aware aggregation, not supported for GlobalMatrix */
+        ROCALUTION_EXPORT
+        void AMGNodeGraph(int blockdim, GlobalMatrix<ValueType>* node) const;
+
+        /** \brief Expand the aggregation of a node graph, not supported for GlobalMatrix */
+        ROCALUTION_EXPORT
+        void AMGNodeExpand(int                            blockdim,
+                           const GlobalMatrix<ValueType>& node,
+                           const LocalVector<bool>&       node_connections,
+                           const LocalVector<int64_t>&    node_aggregates,
+                           const LocalVector<int64_t>&    node_aggregate_root_nodes,
+                           LocalVector<bool>*             connections,
+                           LocalVector<int64_t>*          aggregates,
+                           LocalVector<int64_t>*          aggregate_root_nodes) const;
+
         /** \brief Interpolation scheme based on smoothed aggregation from Vanek (1996) */
         ROCALUTION_EXPORT
         void AMGSmoothedAggregation(ValueType                   relax,
@@ -352,6 +642,75 @@ namespace rocalution
     private:
         void CreateParallelManager_(void);
         void InitCommPattern_(void);
+        void ApplyReducedHalo_(const GlobalVector<ValueType>& in,
+                               GlobalVector<ValueType>*       out) const;
+        void ApplyRowsInterior_(const GlobalVector<ValueType>& in,
+                                const LocalVector<int>&        rows,
+                                const GlobalVector<ValueType>* rhs,
+                                GlobalVector<ValueType>*       out) const;
+        void ApplyRows_(const GlobalVector<ValueType>& in,
+                        const LocalVector<int>&        rows,
+                        const GlobalVector<ValueType>* rhs,
+                        GlobalVector<ValueType>*       out) const;
+        // Structure of the local product of MatrixMult(), reused by MatrixMultNumeric()
+        struct MatrixMultStructure
+        {
+            // Row pointers of the boundary rows of B that are sent and received (host)
+            std::vector<PtrType> ext_row_ptr_send;
+            std::vector<PtrType> ext_row_ptr_recv;
+            // Local column ids of the received boundary rows of B, before sorting
+            LocalVector<int> ext_col;
+            // Local column ids of the ghost part of B in the merged numbering
+            LocalVector<int> gst_ext_local;
+            // Number of ghost columns of the merged B
+            int64_t ext_ncol;
+            // Local rows of the product, with the columns of the merged B
+            LocalMatrix<ValueType> product;
+        };
+
+        void MatrixMultExtRows_(const GlobalMatrix<ValueType>& A,
+                                const LocalMatrix<ValueType>&  A_int,
+                                const LocalMatrix<ValueType>&  A_gst,
+                                const GlobalMatrix<ValueType>& B,
+                                const LocalMatrix<ValueType>&  B_int,
+                                const LocalMatrix<ValueType>&  B_gst,
+                                LocalMatrix<ValueType>*        AB,
+                                LocalVector<int64_t>*          l2g,
+                                MatrixMultStructure*           structure = NULL) const;
+        void MatrixMultExtRowsNumeric_(const GlobalMatrix<ValueType>& A,
+                                       const LocalMatrix<ValueType>&  A_int,
+                                       const LocalMatrix<ValueType>&  A_gst,
+                                       const GlobalMatrix<ValueType>& B,
+                                       const LocalMatrix<ValueType>&  B_int,
+                                       const LocalMatrix<ValueType>&  B_gst,
+                                       MatrixMultStructure*           structure) const;
+        void MatrixMultLocalRows_(const GlobalMatrix<ValueType>& A,
+                                  const GlobalMatrix<ValueType>& B,
+                                  LocalMatrix<ValueType>*        interior,
+                                  LocalMatrix<ValueType>*        ghost,
+                                  LocalVector<int64_t>*          gst_col,
+                                  MatrixMultStructure*           structure,
+                                  bool                           numeric) const;
+        void SetFromInteriorGhost_(LocalMatrix<ValueType>*     interior,
+                                   LocalMatrix<ValueType>*     ghost,
+                                   const LocalVector<int64_t>& ghost_col,
+                                   int64_t                     global_nrow,
+                                   int64_t                     global_ncol,
+                                   const ParallelManager&      parent,
+                                   const std::string&          name);
+        void ReadFileDistributed_(const std::string& filename, bool rsio, ParallelManager* pm);
+        void MergeLocalRows_(std::vector<int64_t>*   row_offset,
+                             std::vector<int64_t>*   col,
+                             std::vector<ValueType>* val) const;
+        void PartitionContiguous_(int64_t nrow, int64_t ncol, ParallelManager* pm) const;
+        void PartitionOffsets_(const int64_t*   row_offset,
+                               const int64_t*   col_offset,
+                               ParallelManager* pm) const;
+        void AssembleLocalRows_(const int64_t*     row_offset,
+                                const int64_t*     col,
+                                const ValueType*   val,
+                                const std::string& name,
+                                ParallelManager*   pm);
 
         ParallelManager* pm_self_;
 
@@ -363,11 +722,24 @@ namespace rocalution
 
         LocalVector<int> halo_;
 
+        // Start of the contiguous boundary rows of each neighbor, NULL if not contiguous
+        int* halo_slice_;
+
+        // Halo values are exchanged in single precision
+        bool                       halo_float_;
+        mutable LocalVector<float> recv_buffer_float_;
+        mutable LocalVector<float> send_buffer_float_;
+        float*                     recv_boundary_float_;
+        float*                     send_boundary_float_;
+
         int64_t nnz_;
 
         LocalMatrix<ValueType> matrix_interior_;
         LocalMatrix<ValueType> matrix_ghost_;
 
+        // Structure of the last MatrixMult(), NULL if not available
+        MatrixMultStructure* mult_;
+
         friend class GlobalVector<ValueType>;
         friend class LocalMatrix<ValueType>;
         friend class LocalVector<ValueType>;
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -25,6 +25,7 @@
 #include "../utils/allocate_free.hpp"
 #include "../utils/def.hpp"
 #include "../utils/log.hpp"
+#include "host/host_io.hpp"
 #include "local_vector.hpp"
 
 #ifdef SUPPORT_MULTINODE
@@ -37,6 +38,7 @@
 #include <limits>
 #include <math.h>
 #include <sstream>
+#include <vector>
 
 namespace rocalution
 {
@@ -54,6 +56,12 @@ namespace rocalution
         this->pm_ = NULL;
 
         this->object_name_ = "";
+
+        this->dot_async_   = false;
+        this->dot_size_    = 0;
+        this->dot_local_   = NULL;
+        this->dot_request_ = NULL;
+        this->dot_norm_    = NULL;
     }
 
     template <typename ValueType>
@@ -66,6 +74,12 @@ namespace rocalution
         this->object_name_ = "";
 
         this->pm_ = &pm;
+
+        this->dot_async_   = false;
+        this->dot_size_    = 0;
+        this->dot_local_   = NULL;
+        this->dot_request_ = NULL;
+        this->dot_norm_    = NULL;
     }
 
     template <typename ValueType>
@@ -82,6 +96,16 @@ namespace rocalution
         log_debug(this, "GlobalVector::Clear()");
 
         this->vector_interior_.Clear();
+
+        // Complete any pending reduction before releasing its buffers
+        this->DotSync();
+
+#ifdef SUPPORT_MULTINODE
+        free_host(&this->dot_local_);
+        free_host(&this->dot_request_);
+#endif
+
+        this->dot_size_ = 0;
     }
 
     template <typename ValueType>
@@ -264,6 +288,239 @@ namespace rocalution
         this->vector_interior_.CopyFrom(src.vector_interior_);
     }
 
+    template <typename ValueType>
+    void GlobalVector<ValueType>::Gather(LocalVector<ValueType>* vec) const
+    {
+        log_debug(this, "GlobalVector::Gather()", vec);
+
+        assert(vec != NULL);
+        assert(vec != &this->vector_interior_);
+        assert(this->pm_ != NULL);
+
+        int64_t nrow = this->pm_->GetGlobalNrow();
+
+        if(vec->GetSize() == 0)
+        {
+            vec->CloneBackend(*this);
+            vec->Allocate("gathered " + this->object_name_, nrow);
+        }
+
+        assert(vec->GetSize() == nrow);
+
+        if(this->pm_->num_procs_ == 1)
+        {
+            vec->CopyFrom(this->vector_interior_);
+            return;
+        }
+
+#ifdef SUPPORT_MULTINODE
+        int num_procs = this->pm_->num_procs_;
+
+        // Receive counts and offsets are given by the row distribution
+        std::vector<int> recv_count(num_procs);
+        std::vector<int> recv_offset(num_procs);
+
+        for(int n = 0; n < num_procs; ++n)
+        {
+            recv_offset[n] = static_cast<int>(this->pm_->GetGlobalRowBegin(n));
+            recv_count[n]  = static_cast<int>(this->pm_->GetGlobalRowEnd(n) - recv_offset[n]);
+        }
+
+        // Communication is done via host buffers
+        int64_t    local_size = this->vector_interior_.GetSize();
+        ValueType* send       = NULL;
+        ValueType* recv       = NULL;
+
+        allocate_host(local_size, &send);
+        allocate_host(nrow, &recv);
+
+        this->vector_interior_.CopyToHostData(send);
+
+        communication_sync_allgatherv(send,
+                                      static_cast<int>(local_size),
+                                      recv,
+                                      recv_count.data(),
+                                      recv_offset.data(),
+                                      this->pm_->comm_);
+
+        vec->CopyFromHostData(recv);
+
+        free_host(&send);
+        free_host(&recv);
+#endif
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::Scatter(const LocalVector<ValueType>& vec)
+    {
+        log_debug(this, "GlobalVector::Scatter()", (const void*&)vec);
+
+        assert(&vec != &this->vector_interior_);
+        assert(this->pm_ != NULL);
+        assert(vec.GetSize() == this->pm_->GetGlobalNrow());
+
+        if(this->pm_->num_procs_ == 1)
+        {
+            this->vector_interior_.CopyFrom(vec);
+            return;
+        }
+
+        this->vector_interior_.CopyFrom(
+            vec, this->pm_->GetGlobalRowBegin(), 0, this->vector_interior_.GetSize());
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::Repartition(const ParallelManager&      pm,
+                                              const LocalVector<int64_t>& permutation)
+    {
+        log_debug(this, "GlobalVector::Repartition()", (const void*&)pm, (const void*&)permutation);
+
+        assert(this->pm_ != NULL);
+        assert(pm.Status() == true);
+        assert(permutation.GetSize() == this->GetLocalSize());
+
+        int rank      = pm.rank_;
+        int num_procs = pm.num_procs_;
+
+        // Communication is done via host buffers
+        int64_t local_size = this->GetLocalSize();
+
+        std::vector<int64_t>   index(local_size);
+        std::vector<ValueType> value(local_size);
+
+        permutation.CopyToHostData(index.data());
+        this->vector_interior_.CopyToHostData(value.data());
+
+        // Number of entries for each new owner
+        const int64_t* global_row_offset = pm.global_row_offset_;
+
+        std::vector<int> send_count(num_procs, 0);
+        std::vector<int> owner(local_size);
+
+        for(int64_t i = 0; i < local_size; ++i)
+        {
+            owner[i] = static_cast<int>(
+                std::upper_bound(global_row_offset, global_row_offset + num_procs + 1, index[i])
+                - global_row_offset - 1);
+
+            ++send_count[owner[i]];
+        }
+
+        std::vector<int> recv_count(num_procs, 0);
+
+#ifdef SUPPORT_MULTINODE
+        communication_sync_alltoall_single(send_count.data(), recv_count.data(), pm.comm_);
+#else
+        recv_count[rank] = send_count[rank];
+#endif
+
+        std::vector<int64_t> send_offset(num_procs + 1, 0);
+        std::vector<int64_t> recv_offset(num_procs + 1, 0);
+
+        for(int n = 0; n < num_procs; ++n)
+        {
+            send_offset[n + 1] = send_offset[n] + send_count[n];
+            recv_offset[n + 1] = recv_offset[n] + recv_count[n];
+        }
+
+        // Pack the entries by new owner
+        std::vector<int64_t>   send_index(local_size);
+        std::vector<ValueType> send_value(local_size);
+
+        std::vector<int64_t> pos(send_offset.begin(), send_offset.end() - 1);
+
+        for(int64_t i = 0; i < local_size; ++i)
+        {
+            int64_t idx = pos[owner[i]]++;
+
+            send_index[idx] = index[i];
+            send_value[idx] = value[i];
+        }
+
+        int64_t recv_size = recv_offset[num_procs];
+
+        std::vector<int64_t>   recv_index(recv_size);
+        std::vector<ValueType> recv_value(recv_size);
+
+#ifdef SUPPORT_MULTINODE
+        std::vector<MRequest> req;
+        req.reserve(4 * num_procs);
+
+        for(int n = 0; n < num_procs; ++n)
+        {
+            if(n == rank || recv_count[n] == 0)
+            {
+                continue;
+            }
+
+            req.resize(req.size() + 2);
+            communication_async_recv(recv_index.data() + recv_offset[n],
+                                     recv_count[n],
+                                     n,
+                                     0,
+                                     &req[req.size() - 2],
+                                     pm.comm_);
+            communication_async_recv(recv_value.data() + recv_offset[n],
+                                     recv_count[n],
+                                     n,
+                                     1,
+                                     &req[req.size() - 1],
+                                     pm.comm_);
+        }
+
+        for(int n = 0; n < num_procs; ++n)
+        {
+            if(n == rank || send_count[n] == 0)
+            {
+                continue;
+            }
+
+            req.resize(req.size() + 2);
+            communication_async_send(send_index.data() + send_offset[n],
+                                     send_count[n],
+                                     n,
+                                     0,
+                                     &req[req.size() - 2],
+                                     pm.comm_);
+            communication_async_send(send_value.data() + send_offset[n],
+                                     send_count[n],
+                                     n,
+                                     1,
+                                     &req[req.size() - 1],
+                                     pm.comm_);
+        }
+#endif
+
+        // Own entries do not need to be communicated
+        std::copy(send_index.begin() + send_offset[rank],
+                  send_index.begin() + send_offset[rank + 1],
+                  recv_index.begin() + recv_offset[rank]);
+        std::copy(send_value.begin() + send_offset[rank],
+                  send_value.begin() + send_offset[rank + 1],
+                  recv_value.begin() + recv_offset[rank]);
+
+#ifdef SUPPORT_MULTINODE
+        communication_syncall(static_cast<int>(req.size()), req.data());
+#endif
+
+        // Place the received entries at their new local position
+        int64_t row_begin = pm.GetGlobalRowBegin();
+
+        value.resize(pm.GetLocalNrow());
+
+        for(int64_t i = 0; i < recv_size; ++i)
+        {
+            value[recv_index[i] - row_begin] = recv_value[i];
+        }
+
+        std::string name = this->object_name_;
+
+        this->Clear();
+        this->SetParallelManager(pm);
+        this->Allocate(name, pm.GetGlobalNrow());
+        this->vector_interior_.CopyFromHostData(value.data());
+    }
+
     template <typename ValueType>
     void GlobalVector<ValueType>::CloneFrom(const GlobalVector<ValueType>& src)
     {
@@ -288,6 +545,14 @@ namespace rocalution
         this->vector_interior_.MoveToHost();
     }
 
+    template <typename ValueType>
+    void GlobalVector<ValueType>::Prefetch(void) const
+    {
+        log_debug(this, "GlobalVector::Prefetch()");
+
+        this->vector_interior_.Prefetch();
+    }
+
     template <typename ValueType>
     ValueType& GlobalVector<ValueType>::operator[](int64_t i)
     {
@@ -490,6 +755,124 @@ namespace rocalution
         this->vector_interior_.WriteFileBinary(name);
     }
 
+    template <typename ValueType>
+    void GlobalVector<ValueType>::ReadFileDistributedBinary(const std::string& filename)
+    {
+        log_debug(this, "GlobalVector::ReadFileDistributedBinary()", filename);
+
+        assert(this->pm_ != NULL);
+        assert(this->pm_->Status() == true);
+
+        int64_t size;
+        int64_t offset;
+        int     val_type;
+        int     val_size;
+
+        if(read_vector_layout<ValueType>(size, offset, val_type, val_size, filename.c_str())
+           != true)
+        {
+            LOG_INFO("GlobalVector::ReadFileDistributedBinary() failed for file " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        // Block of the interior inside the global vector
+        int64_t begin;
+
+        if(size == this->pm_->GetGlobalNrow())
+        {
+            begin = this->pm_->GetGlobalRowBegin();
+        }
+        else if(size == this->pm_->GetGlobalNcol())
+        {
+            begin = this->pm_->GetGlobalColumnBegin();
+        }
+        else
+        {
+            LOG_INFO("GlobalVector::ReadFileDistributedBinary() size mismatch in " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        this->Clear();
+        this->Allocate(filename, size);
+
+        int64_t local_size = this->vector_interior_.GetSize();
+
+        std::vector<char>      raw(local_size * val_size);
+        std::vector<ValueType> val(local_size);
+
+#ifdef SUPPORT_MULTINODE
+        MFile file;
+
+        if(communication_file_open(filename.c_str(), &file, this->pm_->comm_) != true)
+        {
+            LOG_INFO("Cannot open GlobalVector file [read]: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        communication_file_read_at_all(
+            &file, offset + begin * val_size, raw.size(), raw.data(), this->pm_->comm_);
+
+        communication_file_close(&file);
+#endif
+
+        convert_csr_file_values(local_size, val_type, raw.data(), val.data());
+
+        this->vector_interior_.CopyFromData(val.data());
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::WriteFileDistributedBinary(const std::string& filename) const
+    {
+        log_debug(this, "GlobalVector::WriteFileDistributedBinary()", filename);
+
+        assert(this->pm_ != NULL);
+        assert(this->pm_->Status() == true);
+
+        int64_t size       = this->GetSize();
+        int64_t local_size = this->vector_interior_.GetSize();
+
+        // Block of the interior inside the global vector
+        int64_t begin = (size == this->pm_->GetGlobalNrow()) ? this->pm_->GetGlobalRowBegin()
+                                                              : this->pm_->GetGlobalColumnBegin();
+
+        int         val_type;
+        int         val_size;
+        std::string header;
+
+        write_vector_layout<ValueType>(size, val_type, val_size, header);
+
+        std::vector<ValueType> val(local_size);
+        std::vector<char>      raw(local_size * val_size);
+
+        this->vector_interior_.CopyToData(val.data());
+        convert_csr_file_values_raw(local_size, val_type, val.data(), raw.data());
+
+#ifdef SUPPORT_MULTINODE
+        MFile file;
+
+        if(communication_file_create(filename.c_str(), &file, this->pm_->comm_) != true)
+        {
+            LOG_INFO("Cannot open GlobalVector file [write]: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        // Master rank writes the header, all ranks write their block
+        communication_file_write_at_all(&file,
+                                        0,
+                                        (this->pm_->rank_ == 0) ? header.size() : 0,
+                                        header.data(),
+                                        this->pm_->comm_);
+
+        communication_file_write_at_all(&file,
+                                        header.size() + begin * val_size,
+                                        raw.size(),
+                                        raw.data(),
+                                        this->pm_->comm_);
+
+        communication_file_close(&file);
+#endif
+    }
+
     template <typename ValueType>
     void GlobalVector<ValueType>::AddScale(const GlobalVector<ValueType>& x, ValueType alpha)
     {
@@ -560,6 +943,39 @@ namespace rocalution
         return global;
     }
 
+    template <typename ValueType>
+    ValueType GlobalVector<ValueType>::DotFloat(const LocalVector<float>& x) const
+    {
+        log_debug(this, "GlobalVector::DotFloat()", (const void*&)x);
+
+        ValueType local = this->vector_interior_.DotFloat(x);
+        ValueType global;
+
+#ifdef SUPPORT_MULTINODE
+        communication_sync_allreduce_single_sum(&local, &global, this->pm_->comm_);
+#else
+        global = local;
+#endif
+
+        return global;
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::AddScaleFloat(const LocalVector<float>& x, ValueType alpha)
+    {
+        log_debug(this, "GlobalVector::AddScaleFloat()", (const void*&)x, alpha);
+
+        this->vector_interior_.AddScaleFloat(x, alpha);
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::ScaleCopyToFloat(ValueType alpha, LocalVector<float>* vec)
+    {
+        log_debug(this, "GlobalVector::ScaleCopyToFloat()", alpha, vec);
+
+        this->vector_interior_.ScaleCopyToFloat(alpha, vec);
+    }
+
     template <typename ValueType>
     ValueType GlobalVector<ValueType>::DotNonConj(const GlobalVector<ValueType>& x) const
     {
@@ -577,6 +993,340 @@ namespace rocalution
         return global;
     }
 
+    template <typename ValueType>
+    void GlobalVector<ValueType>::MultiDot(int                                   count,
+                                           const GlobalVector<ValueType>* const* x,
+                                           ValueType*                            res) const
+    {
+        log_debug(this, "GlobalVector::MultiDot()", count, x, res);
+
+        assert(count > 0);
+        assert(x != NULL);
+        assert(res != NULL);
+
+        std::vector<const LocalVector<ValueType>*> interior(count);
+
+        for(int k = 0; k < count; ++k)
+        {
+            assert(x[k] != NULL);
+
+            interior[k] = &x[k]->vector_interior_;
+        }
+
+#ifdef SUPPORT_MULTINODE
+        std::vector<ValueType> local(count);
+
+        this->vector_interior_.MultiDot(count, interior.data(), local.data());
+
+        communication_sync_allreduce_sum(local.data(), res, count, this->pm_->comm_);
+#else
+        this->vector_interior_.MultiDot(count, interior.data(), res);
+#endif
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::MultiAddScale(int                                   count,
+                                                const GlobalVector<ValueType>* const* x,
+                                                const ValueType*                      alpha)
+    {
+        log_debug(this, "GlobalVector::MultiAddScale()", count, x, alpha);
+
+        assert(count >= 0);
+        assert(x != NULL || count == 0);
+
+        std::vector<const LocalVector<ValueType>*> interior(count);
+
+        for(int k = 0; k < count; ++k)
+        {
+            assert(x[k] != NULL);
+
+            interior[k] = &x[k]->vector_interior_;
+        }
+
+        this->vector_interior_.MultiAddScale(count, interior.data(), alpha);
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::DotNonConjAsync(int                                   n,
+                                                  const GlobalVector<ValueType>* const* x,
+                                                  const GlobalVector<ValueType>* const* y,
+                                                  ValueType*                            res) const
+    {
+        log_debug(this, "GlobalVector::DotNonConjAsync()", n, x, y, res);
+
+        this->DotAsync_(n, x, y, res, false);
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::DotAsync(int                                   n,
+                                           const GlobalVector<ValueType>* const* x,
+                                           const GlobalVector<ValueType>* const* y,
+                                           ValueType*                            res) const
+    {
+        log_debug(this, "GlobalVector::DotAsync()", n, x, y, res);
+
+        this->DotAsync_(n, x, y, res, true);
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::DotAsync_(int                                   n,
+                                            const GlobalVector<ValueType>* const* x,
+                                            const GlobalVector<ValueType>* const* y,
+                                            ValueType*                            res,
+                                            bool                                  conj) const
+    {
+        assert(n > 0);
+        assert(x != NULL);
+        assert(y != NULL);
+        assert(res != NULL);
+        assert(this->dot_async_ == false);
+        assert(this->dot_norm_ == NULL);
+
+#ifdef SUPPORT_MULTINODE
+        if(n > this->dot_size_)
+        {
+            free_host(&this->dot_local_);
+            allocate_host(n, &this->dot_local_);
+
+            this->dot_size_ = n;
+        }
+
+        if(this->dot_request_ == NULL)
+        {
+            allocate_host(1, &this->dot_request_);
+        }
+
+        // Local contributions
+        for(int i = 0; i < n; ++i)
+        {
+            this->dot_local_[i] = conj ? x[i]->vector_interior_.Dot(y[i]->vector_interior_)
+                                       : x[i]->vector_interior_.DotNonConj(y[i]->vector_interior_);
+        }
+
+        // Single non-blocking reduction for all dot products
+        communication_async_allreduce_sum(
+            this->dot_local_, res, n, this->pm_->comm_, this->dot_request_);
+
+        this->dot_async_ = true;
+#else
+        for(int i = 0; i < n; ++i)
+        {
+            res[i] = conj ? x[i]->vector_interior_.Dot(y[i]->vector_interior_)
+                          : x[i]->vector_interior_.DotNonConj(y[i]->vector_interior_);
+        }
+#endif
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::NormAsync(ValueType* res) const
+    {
+        log_debug(this, "GlobalVector::NormAsync()", res);
+
+        const GlobalVector<ValueType>* self = this;
+
+        this->DotAsync_(1, &self, &self, res, true);
+
+        this->dot_norm_ = res;
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::DotSync(void) const
+    {
+        log_debug(this, "GlobalVector::DotSync()");
+
+#ifdef SUPPORT_MULTINODE
+        if(this->dot_async_ == true)
+        {
+            communication_sync(this->dot_request_);
+
+            this->dot_async_ = false;
+        }
+#endif
+
+        if(this->dot_norm_ != NULL)
+        {
+            *this->dot_norm_ = std::sqrt(*this->dot_norm_);
+
+            this->dot_norm_ = NULL;
+        }
+    }
+
+    template <typename ValueType>
+    ValueType GlobalVector<ValueType>::AddScaleDot(const GlobalVector<ValueType>& x,
+                                                   ValueType                      alpha,
+                                                   const GlobalVector<ValueType>& y)
+    {
+        log_debug(this, "GlobalVector::AddScaleDot()", (const void*&)x, alpha, (const void*&)y);
+
+        ValueType local
+            = this->vector_interior_.AddScaleDot(x.vector_interior_, alpha, y.vector_interior_);
+        ValueType global;
+
+#ifdef SUPPORT_MULTINODE
+        communication_sync_allreduce_single_sum(&local, &global, this->pm_->comm_);
+#else
+        global = local;
+#endif
+
+        return global;
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::Evaluate(const VectorExpressionProgram<ValueType>& program,
+                                           const GlobalVector<ValueType>* const*     vec)
+    {
+        log_debug(this, "GlobalVector::Evaluate()", program.num_ops, vec);
+
+        assert(program.num_vectors <= _vector_expression_max_vectors);
+
+        const LocalVector<ValueType>* interior[_vector_expression_max_vectors];
+
+        for(int k = 0; k < program.num_vectors; ++k)
+        {
+            interior[k] = &vec[k]->vector_interior_;
+        }
+
+        this->vector_interior_.Evaluate(program, interior);
+    }
+
+    template <typename ValueType>
+    ValueType
+        GlobalVector<ValueType>::EvaluateSum(const VectorExpressionProgram<ValueType>& program,
+                                             const GlobalVector<ValueType>* const*     vec) const
+    {
+        log_debug(this, "GlobalVector::EvaluateSum()", program.num_ops, vec);
+
+        assert(program.num_vectors <= _vector_expression_max_vectors);
+
+        const LocalVector<ValueType>* interior[_vector_expression_max_vectors];
+
+        for(int k = 0; k < program.num_vectors; ++k)
+        {
+            interior[k] = &vec[k]->vector_interior_;
+        }
+
+        ValueType local = this->vector_interior_.EvaluateSum(program, interior);
+        ValueType global;
+
+#ifdef SUPPORT_MULTINODE
+        communication_sync_allreduce_single_sum(&local, &global, this->pm_->comm_);
+#else
+        global = local;
+#endif
+
+        return global;
+    }
+
+    template <typename ValueType>
+    ValueType GlobalVector<ValueType>::AddScaleNorm(const GlobalVector<ValueType>& x,
+                                                    ValueType                      alpha)
+    {
+        log_debug(this, "GlobalVector::AddScaleNorm()", (const void*&)x, alpha);
+
+        return std::sqrt(this->AddScaleDot(x, alpha, *this));
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::DualDot(const GlobalVector<ValueType>& x,
+                                          const GlobalVector<ValueType>& y,
+                                          ValueType*                     res) const
+    {
+        log_debug(this, "GlobalVector::DualDot()", (const void*&)x, (const void*&)y, res);
+
+        assert(res != NULL);
+
+#ifdef SUPPORT_MULTINODE
+        ValueType local[2];
+
+        this->vector_interior_.DualDot(x.vector_interior_, y.vector_interior_, local);
+
+        communication_sync_allreduce_sum(local, res, 2, this->pm_->comm_);
+#else
+        this->vector_interior_.DualDot(x.vector_interior_, y.vector_interior_, res);
+#endif
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::DotToScalar(const GlobalVector<ValueType>& x,
+                                              LocalVector<ValueType>*        res,
+                                              int64_t                        index) const
+    {
+        log_debug(this, "GlobalVector::DotToScalar()", (const void*&)x, res, index);
+
+        assert(res != NULL);
+
+        ValueType val = this->Dot(x);
+        res->SetContinuousValues(index, index + 1, &val);
+
+        // The copy to the backend of res might be asynchronous
+        _rocalution_sync();
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::DotNonConjToScalar(const GlobalVector<ValueType>& x,
+                                                     LocalVector<ValueType>*        res,
+                                                     int64_t                        index) const
+    {
+        log_debug(this, "GlobalVector::DotNonConjToScalar()", (const void*&)x, res, index);
+
+        assert(res != NULL);
+
+        ValueType val = this->DotNonConj(x);
+        res->SetContinuousValues(index, index + 1, &val);
+
+        // The copy to the backend of res might be asynchronous
+        _rocalution_sync();
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::NormToScalar(LocalVector<ValueType>* res, int64_t index) const
+    {
+        log_debug(this, "GlobalVector::NormToScalar()", res, index);
+
+        assert(res != NULL);
+
+        ValueType val = this->Norm();
+        res->SetContinuousValues(index, index + 1, &val);
+
+        // The copy to the backend of res might be asynchronous
+        _rocalution_sync();
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::AddScaleRatio(const GlobalVector<ValueType>& x,
+                                                ValueType                      factor,
+                                                const LocalVector<ValueType>&  scalars,
+                                                int64_t                        num,
+                                                int64_t                        den)
+    {
+        log_debug(this,
+                  "GlobalVector::AddScaleRatio()",
+                  (const void*&)x,
+                  factor,
+                  (const void*&)scalars,
+                  num,
+                  den);
+
+        // The scalars are already reduced, the update is purely local
+        this->vector_interior_.AddScaleRatio(x.vector_interior_, factor, scalars, num, den);
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::ScaleRatioAdd(const LocalVector<ValueType>&  scalars,
+                                                int64_t                        num,
+                                                int64_t                        den,
+                                                const GlobalVector<ValueType>& x)
+    {
+        log_debug(this,
+                  "GlobalVector::ScaleRatioAdd()",
+                  (const void*&)scalars,
+                  num,
+                  den,
+                  (const void*&)x);
+
+        this->vector_interior_.ScaleRatioAdd(scalars, num, den, x.vector_interior_);
+    }
+
     template <typename ValueType>
     ValueType GlobalVector<ValueType>::Norm(void) const
     {
@@ -688,12 +1438,43 @@ namespace rocalution
     void GlobalVector<ValueType>::Restriction(const GlobalVector<ValueType>& vec_fine,
                                               const LocalVector<int>&        map)
     {
+        log_debug(this, "GlobalVector::Restriction()", (const void*&)vec_fine, (const void*&)map);
+
+        // The aggregates of a level do not cross the process boundaries
+        this->vector_interior_.Restriction(vec_fine.vector_interior_, map);
+    }
+
+    template <typename ValueType>
+    void GlobalVector<ValueType>::Sketch(const LocalVector<int>& map,
+                                         LocalVector<ValueType>* work,
+                                         ValueType*              res) const
+    {
+        log_debug(this, "GlobalVector::Sketch()", (const void*&)map, work, res);
+
+        assert(work != NULL);
+        assert(res != NULL);
+
+#ifdef SUPPORT_MULTINODE
+        int64_t size = work->GetSize() / 2;
+
+        std::vector<ValueType> local(size);
+
+        this->vector_interior_.Sketch(map, work, local.data());
+
+        communication_sync_allreduce_sum(local.data(), res, size, this->pm_->comm_);
+#else
+        this->vector_interior_.Sketch(map, work, res);
+#endif
     }
 
     template <typename ValueType>
     void GlobalVector<ValueType>::Prolongation(const GlobalVector<ValueType>& vec_coarse,
                                                const LocalVector<int>&        map)
     {
+        log_debug(
+            this, "GlobalVector::Prolongation()", (const void*&)vec_coarse, (const void*&)map);
+
+        this->vector_interior_.Prolongation(vec_coarse.vector_interior_, map);
     }
 
     template <typename ValueType>
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -26,6 +26,7 @@
 
 #include "parallel_manager.hpp"
 #include "vector.hpp"
+#include "vector_expression.hpp"
 
 namespace rocalution
 {
@@ -61,6 +62,8 @@ namespace rocalution
         virtual void MoveToAccelerator(void);
         /** \brief Move all data (i.e. move the part of the global vector stored on this rank) to the host */
         virtual void MoveToHost(void);
+        /** \brief Migrate the vector data to the accelerator (managed memory mode) */
+        virtual void Prefetch(void) const;
 
         /** \brief Shows simple info about the matrix. */
         virtual void Info(void) const;
@@ -129,6 +132,40 @@ namespace rocalution
 
         /** \brief Copy vector (values and structure) from another GlobalVector */
         virtual void CopyFrom(const GlobalVector<ValueType>& src);
+        /** \brief Gather the whole vector on each process
+      * \details
+      * All interior parts are gathered into \p vec, such that each process holds a copy
+      * of the entire vector in global numbering. \p vec is allocated on the backend of
+      * this vector, if it is empty.
+      */
+        void Gather(LocalVector<ValueType>* vec) const;
+        /** \brief Copy the local rows of a gathered vector into the interior part
+      * \details
+      * Inverse of Gather(). The rows of \p vec that belong to this process are copied
+      * into the interior of this vector, no communication is required.
+      */
+        void Scatter(const LocalVector<ValueType>& vec);
+        /** \brief Redistribute the vector to a repartitioned matrix
+      * \details
+      * Moves the vector to the row distribution of \p pm, as produced by
+      * GlobalMatrix::Repartition(). \p permutation holds the new global index of each
+      * local row, entry \f$i\f$ is sent to the rank owning row \p permutation[i]. The
+      * vector is attached to \p pm afterwards. Unlike the matrix, the vector is not
+      * gathered, the memory per rank is proportional to its local size.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   ParallelManager pm_part;
+      *   pm_part.SetMPICommunicator(&comm);
+      *
+      *   LocalVector<int64_t> perm;
+      *   mat.Repartition(&pm_part, &perm);
+      *
+      *   rhs.Repartition(pm_part, perm);
+      *   x.Repartition(pm_part, perm);
+      * \endcode
+      */
+        void Repartition(const ParallelManager& pm, const LocalVector<int64_t>& permutation);
         /** \brief Read GlobalVector from ASCII file. This method reads the current ranks interior vector from the file */
         virtual void ReadFileASCII(const std::string& filename);
         /** \brief Write GlobalVector to ASCII file. This method writes the current ranks interior vector to the file */
@@ -137,6 +174,22 @@ namespace rocalution
         virtual void ReadFileBinary(const std::string& filename);
         /** \brief Write GlobalVector to binary file. This method writes the current ranks interior vector to the file */
         virtual void WriteFileBinary(const std::string& filename) const;
+        /** \brief Read GlobalVector from a single binary file
+        * \details
+        * In contrast to ReadFileBinary(), the file holds the complete vector in the format
+        * of LocalVector::WriteFileBinary() and no per rank files are required. Each rank
+        * reads the block of its interior with collective MPI-IO reads. The global size
+        * stored in the file has to match the global number of rows or columns of the
+        * parallel manager.
+        */
+        void ReadFileDistributedBinary(const std::string& filename);
+        /** \brief Write GlobalVector to a single binary file
+        * \details
+        * All ranks write their interior into one file at the offset of their block, using
+        * collective MPI-IO writes. The file can be read by LocalVector::ReadFileBinary() or
+        * by ReadFileDistributedBinary() with an arbitrary number of ranks.
+        */
+        void WriteFileDistributedBinary(const std::string& filename) const;
 
         /** \brief Perform scalar-vector multiplication and add it to another vector, this = this + alpha * x; */
         virtual void AddScale(const GlobalVector<ValueType>& x, ValueType alpha);
@@ -155,8 +208,130 @@ namespace rocalution
         virtual void Scale(ValueType alpha);
         /** \brief Perform dot product */
         virtual ValueType Dot(const GlobalVector<ValueType>& x) const;
+        /** \brief Perform dot product with a single precision copy of the local part */
+        virtual ValueType DotFloat(const LocalVector<float>& x) const;
+        /** \brief Perform this = this + alpha * x, x is a single precision copy of the local
+      * part
+      */
+        virtual void AddScaleFloat(const LocalVector<float>& x, ValueType alpha);
+        /** \brief Scale vector, this = alpha * this, and store the local part rounded to
+      * single precision in vec
+      */
+        virtual void ScaleCopyToFloat(ValueType alpha, LocalVector<float>* vec);
         /** \brief Perform non conjugate (when T is complex) dot product */
         virtual ValueType DotNonConj(const GlobalVector<ValueType>& x) const;
+        /** \brief Perform multiple dot products with this vector at once
+        * \details
+        * \p MultiDot computes \f$res_{k} = x_{k}^{H} this\f$ for
+        * \f$k = 0, \dots, count-1\f$ in a single pass over the local part of this
+        * vector, followed by a single global reduction for all \p count values.
+        */
+        void MultiDot(int count, const GlobalVector<ValueType>* const* x, ValueType* res) const;
+        /** \brief Perform multiple vector updates at once, see
+        * LocalVector::MultiAddScale() */
+        void MultiAddScale(int                                   count,
+                           const GlobalVector<ValueType>* const* x,
+                           const ValueType*                      alpha);
+        /** \brief Perform multiple non conjugate dot products with a single reduction
+        * \details
+        * \p DotNonConjAsync computes \f$res_{i} = x_{i}^{T} y_{i}\f$ for
+        * \f$i = 0, \dots, n-1\f$. The local contributions are computed immediately and
+        * merged into a single non-blocking global reduction, which can be overlapped
+        * with other work. DotSync() must be called on the same vector before \p res
+        * is accessed, and \p res must stay valid until then.
+        */
+        void DotNonConjAsync(int                                   n,
+                             const GlobalVector<ValueType>* const* x,
+                             const GlobalVector<ValueType>* const* y,
+                             ValueType*                            res) const;
+        /** \brief Perform multiple dot products with a single reduction
+        * \details
+        * \p DotAsync computes \f$res_{i} = x_{i}^{H} y_{i}\f$ for \f$i = 0, \dots, n-1\f$,
+        * with the same interface and completion semantics as DotNonConjAsync().
+        */
+        void DotAsync(int                                   n,
+                      const GlobalVector<ValueType>* const* x,
+                      const GlobalVector<ValueType>* const* y,
+                      ValueType*                            res) const;
+        /** \brief Compute the L2 norm with a non-blocking reduction
+        * \details
+        * \p NormAsync computes the local contribution immediately and starts the global
+        * reduction, the norm is written to \p res by DotSync(). Completion semantics are
+        * the same as for DotAsync().
+        */
+        void NormAsync(ValueType* res) const;
+        /** \brief Wait for the reduction started by DotNonConjAsync(), DotAsync() or
+        * NormAsync() to complete */
+        void DotSync(void) const;
+        /** \brief Perform vector update and dot product in a single pass
+        * \details
+        * \p AddScaleDot computes \f$this = this + \alpha x\f$ and returns
+        * \f$this^{H} y\f$ with the updated vector. \p y may be this vector.
+        */
+        ValueType AddScaleDot(const GlobalVector<ValueType>& x,
+                              ValueType                      alpha,
+                              const GlobalVector<ValueType>& y);
+        /** \brief Perform vector update and compute the L2 norm in a single pass */
+        ValueType AddScaleNorm(const GlobalVector<ValueType>& x, ValueType alpha);
+        /** \brief Evaluate a lazy vector expression on the interior, see
+        * LocalVector::operator=(const VectorExpression<Expr>&) */
+        template <class Expr>
+        GlobalVector<ValueType>& operator=(const VectorExpression<Expr>& expr)
+        {
+            static_assert(
+                std::is_same<typename Expr::vector_type, GlobalVector<ValueType>>::value,
+                "The expression has to consist of GlobalVector<ValueType> objects");
+
+            VectorExpressionBuilder<GlobalVector<ValueType>, ValueType> builder;
+            expr.Self().Compile(&builder);
+
+            this->Evaluate(builder.program, builder.vec);
+
+            return *this;
+        }
+        /** \brief Evaluate an expression program over the vectors vec into this vector */
+        void Evaluate(const VectorExpressionProgram<ValueType>& program,
+                      const GlobalVector<ValueType>* const*     vec);
+        /** \brief Return the global sum of the elements of an expression program over the
+        * vectors vec, see Sum() */
+        ValueType EvaluateSum(const VectorExpressionProgram<ValueType>& program,
+                              const GlobalVector<ValueType>* const*     vec) const;
+        /** \brief Perform two dot products with this vector in a single pass
+        * \details
+        * \p DualDot computes \f$res_{0} = this^{H} x\f$ and \f$res_{1} = this^{H} y\f$
+        * with a single global reduction for both values.
+        */
+        void DualDot(const GlobalVector<ValueType>& x,
+                     const GlobalVector<ValueType>& y,
+                     ValueType*                     res) const;
+        /** \brief Compute a dot product into a vector of scalars
+        * \details
+        * \p DotToScalar computes \f$res_{index} = this^{H} x\f$, see
+        * LocalVector::DotToScalar(). The global reduction is completed on the host
+        * before the result is written to \p res.
+        */
+        void DotToScalar(const GlobalVector<ValueType>& x,
+                         LocalVector<ValueType>*        res,
+                         int64_t                        index) const;
+        /** \brief Compute a non conjugate dot product into a vector of scalars */
+        void DotNonConjToScalar(const GlobalVector<ValueType>& x,
+                                LocalVector<ValueType>*        res,
+                                int64_t                        index) const;
+        /** \brief Compute the L2 norm into a vector of scalars */
+        void NormToScalar(LocalVector<ValueType>* res, int64_t index) const;
+        /** \brief Perform vector update with a ratio of scalars, see
+        * LocalVector::AddScaleRatio() */
+        void AddScaleRatio(const GlobalVector<ValueType>& x,
+                           ValueType                      factor,
+                           const LocalVector<ValueType>&  scalars,
+                           int64_t                        num,
+                           int64_t                        den);
+        /** \brief Perform vector scaling with a ratio of scalars and addition, see
+        * LocalVector::ScaleRatioAdd() */
+        void ScaleRatioAdd(const LocalVector<ValueType>&  scalars,
+                           int64_t                        num,
+                           int64_t                        den,
+                           const GlobalVector<ValueType>& x);
         /** \brief Compute L2 (Euclidean) norm of vector */
         virtual ValueType Norm(void) const;
         /** \brief Reduce (sum) the vector components */
@@ -187,6 +362,11 @@ namespace rocalution
         /** \brief Prolongation operator based on restriction mapping vector */
         void Prolongation(const GlobalVector<ValueType>& vec_coarse, const LocalVector<int>& map);
 
+        /** \brief Apply a sparse sign embedding to the vector, see LocalVector::Sketch().
+        * The local sketches of all processes are summed by a single global reduction.
+        */
+        void Sketch(const LocalVector<int>& map, LocalVector<ValueType>* work, ValueType* res) const;
+
     protected:
         /** \brief Return true if the object is on the host */
         virtual bool is_host_(void) const;
@@ -194,8 +374,23 @@ namespace rocalution
         virtual bool is_accel_(void) const;
 
     private:
+        // Local dot products and a single non-blocking reduction, conjugated or not
+        void DotAsync_(int                                   n,
+                       const GlobalVector<ValueType>* const* x,
+                       const GlobalVector<ValueType>* const* y,
+                       ValueType*                            res,
+                       bool                                  conj) const;
+
         LocalVector<ValueType> vector_interior_;
 
+        // Pending non-blocking reduction of DotNonConjAsync() and DotAsync()
+        mutable bool       dot_async_;
+        mutable int        dot_size_;
+        mutable ValueType* dot_local_;
+        mutable MRequest*  dot_request_;
+        // Result of NormAsync(), the square root is taken by DotSync()
+        mutable ValueType* dot_norm_;
+
         friend class LocalMatrix<ValueType>;
         friend class GlobalMatrix<ValueType>;
 
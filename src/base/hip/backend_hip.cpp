@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2022 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -24,9 +24,13 @@
 #include "backend_hip.hpp"
 #include "../../utils/def.hpp"
 #include "../../utils/log.hpp"
+#include "../../utils/time_functions.hpp"
 #include "../backend_manager.hpp"
 #include "../base_matrix.hpp"
+#include "../base_stencil.hpp"
 #include "../base_vector.hpp"
+#include "../stencil_types.hpp"
+#include "hip_allocate_free.hpp"
 #include "hip_utils.hpp"
 
 #include "hip_matrix_bcsr.hpp"
@@ -37,16 +41,94 @@
 #include "hip_matrix_ell.hpp"
 #include "hip_matrix_hyb.hpp"
 #include "hip_matrix_mcsr.hpp"
+#include "hip_matrix_sell.hpp"
+#include "hip_matrix_vbr.hpp"
+#include "hip_stencil_laplace2d.hpp"
+#include "hip_stencil_laplace3d.hpp"
 #include "hip_vector.hpp"
 
 #include <hip/hip_runtime_api.h>
 #include <rocblas/rocblas.h>
 #include <rocsparse/rocsparse.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <complex>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
 
 namespace rocalution
 {
+    // Devices of the backend and the execution contexts, that have peer access to each
+    // other (where supported)
+    static std::set<int> _rocalution_hip_peer_devices;
+    static std::mutex    _rocalution_hip_peer_mutex;
+
+    // The rocBLAS / rocSPARSE handles of the global backend descriptor are created on the
+    // first accelerator use, which saves their setup cost for host-only runs
+    static std::atomic<bool> _rocalution_hip_handles_ready(false);
+    static std::mutex        _rocalution_hip_handles_mutex;
+
+    static void rocalution_hip_create_handles_(void)
+    {
+        std::lock_guard<std::mutex> lock(_rocalution_hip_handles_mutex);
+
+        if(_rocalution_hip_handles_ready.load(std::memory_order_relaxed) == true)
+        {
+            return;
+        }
+
+        double tick = rocalution_time();
+
+        // The handles belong to the device of the backend
+        int prev = rocalution_hip_set_device(_get_backend_descriptor()->HIP_dev);
+
+        if((rocblas_create_handle(
+                static_cast<rocblas_handle*>(_get_backend_descriptor()->ROC_blas_handle))
+            != rocblas_status_success)
+           || (rocsparse_create_handle(
+                   static_cast<rocsparse_handle*>(_get_backend_descriptor()->ROC_sparse_handle))
+               != rocsparse_status_success))
+        {
+            LOG_INFO("HIP device " << _get_backend_descriptor()->HIP_dev
+                                   << " cannot create rocBLAS/rocSPARSE context");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        rocalution_hip_set_device(prev);
+
+        _rocalution_hip_handles_ready.store(true, std::memory_order_release);
+
+        LOG_VERBOSE_INFO(2,
+                         "rocBLAS/rocSPARSE handles created in " << (rocalution_time() - tick) / 1e6
+                                                                 << " sec");
+    }
+
+    rocblas_handle rocalution_hip_rocblas_handle(void* handle)
+    {
+        if(_rocalution_hip_handles_ready.load(std::memory_order_acquire) == false
+           && handle == _get_backend_descriptor()->ROC_blas_handle)
+        {
+            rocalution_hip_create_handles_();
+        }
+
+        return *static_cast<rocblas_handle*>(handle);
+    }
+
+    rocsparse_handle rocalution_hip_rocsparse_handle(void* handle)
+    {
+        if(_rocalution_hip_handles_ready.load(std::memory_order_acquire) == false
+           && handle == _get_backend_descriptor()->ROC_sparse_handle)
+        {
+            rocalution_hip_create_handles_();
+        }
+
+        return *static_cast<rocsparse_handle*>(handle);
+    }
+
     bool rocalution_init_hip(void)
     {
         log_debug(0, "rocalution_init_hip()", "* begin");
@@ -59,6 +141,9 @@ namespace rocalution
         _get_backend_descriptor()->ROC_blas_handle   = new rocblas_handle;
         _get_backend_descriptor()->ROC_sparse_handle = new rocsparse_handle;
 
+        *static_cast<rocblas_handle*>(_get_backend_descriptor()->ROC_blas_handle)     = NULL;
+        *static_cast<rocsparse_handle*>(_get_backend_descriptor()->ROC_sparse_handle) = NULL;
+
         // get last error (if any)
         hipGetLastError();
 
@@ -130,33 +215,27 @@ namespace rocalution
                     return false;
                 }
 
+                // The rocBLAS/rocSPARSE handles are created on first use
                 if(hip_status_t == hipSuccess)
                 {
-                    if((rocblas_create_handle(static_cast<rocblas_handle*>(
-                            _get_backend_descriptor()->ROC_blas_handle))
-                        == rocblas_status_success)
-                       && (rocsparse_create_handle(static_cast<rocsparse_handle*>(
-                               _get_backend_descriptor()->ROC_sparse_handle))
-                           == rocsparse_status_success)
 #ifdef SUPPORT_MULTINODE
-                       && (hipStreamCreate(static_cast<hipStream_t*>(
-                               _get_backend_descriptor()->HIP_stream_interior))
-                           == hipSuccess)
+                    if((hipStreamCreate(static_cast<hipStream_t*>(
+                            _get_backend_descriptor()->HIP_stream_interior))
+                        == hipSuccess)
                        && (hipStreamCreate(static_cast<hipStream_t*>(
                                _get_backend_descriptor()->HIP_stream_ghost))
-                           == hipSuccess)
+                           == hipSuccess))
 #endif
-                    )
                     {
                         _get_backend_descriptor()->HIP_dev = dev;
                         break;
                     }
+#ifdef SUPPORT_MULTINODE
                     else
                     {
-                        LOG_INFO("HIP device "
-                                 << dev
-                                 << " cannot create rocBLAS/rocSPARSE context and HIP streams");
+                        LOG_INFO("HIP device " << dev << " cannot create HIP streams");
                     }
+#endif
                 }
             }
         }
@@ -184,6 +263,22 @@ namespace rocalution
         _get_backend_descriptor()->HIP_max_threads
             = dev_prop.regsPerBlock > 0 ? dev_prop.regsPerBlock : 65536;
 
+        // Managed device memory requires support by the device
+        if(_get_backend_descriptor()->HIP_managed_memory == true)
+        {
+            int managed = 0;
+            hipDeviceGetAttribute(
+                &managed, hipDeviceAttributeManagedMemory, _get_backend_descriptor()->HIP_dev);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            if(managed == 0)
+            {
+                LOG_INFO("HIP device " << _get_backend_descriptor()->HIP_dev
+                                       << " does not support managed memory");
+                _get_backend_descriptor()->HIP_managed_memory = false;
+            }
+        }
+
         log_debug(0, "rocalution_init_hip()", "* end");
 
         return true;
@@ -194,6 +289,14 @@ namespace rocalution
         log_debug(0, "rocalution_stop_hip()", "* begin");
 
         if(_get_backend_descriptor()->accelerator)
+        {
+            // Free the cached device buffers and the pinned staging buffers
+            release_hip_memory_pool();
+            release_hip_staging_ring();
+        }
+
+        // The handles only exist, if the accelerator has been used
+        if(_rocalution_hip_handles_ready.load() == true)
         {
             if(rocblas_destroy_handle(
                    *(static_cast<rocblas_handle*>(_get_backend_descriptor()->ROC_blas_handle)))
@@ -209,6 +312,11 @@ namespace rocalution
                 LOG_INFO("Error in rocsparse_destroy_handle");
             }
 
+            _rocalution_hip_handles_ready = false;
+        }
+
+        if(_get_backend_descriptor()->accelerator)
+        {
 #ifdef SUPPORT_MULTINODE
             if(hipStreamDestroy(
                    *(static_cast<hipStream_t*>(_get_backend_descriptor()->HIP_stream_interior)))
@@ -245,6 +353,8 @@ namespace rocalution
 
         _get_backend_descriptor()->HIP_dev = -1;
 
+        _rocalution_hip_peer_devices.clear();
+
         log_debug(0, "rocalution_stop_hip()", "* end");
     }
 
@@ -306,6 +416,11 @@ namespace rocalution
             LOG_INFO("minor: "                       << dev_prop.minor);                       // int minor;
             */
             LOG_INFO("compute capability: " << dev_prop.major << "." << dev_prop.minor);
+
+            if(backend_descriptor.HIP_managed_memory == true)
+            {
+                LOG_INFO("HIP managed memory is enabled");
+            }
             /*
             LOG_INFO("textureAlignment: "            << dev_prop.textureAlignment);            // size_t textureAlignment;
             LOG_INFO("deviceOverlap: "               << dev_prop.deviceOverlap);               // int deviceOverlap;
@@ -355,38 +470,35 @@ namespace rocalution
         return dev_prop.gcnArchName;
     }
 
-    void rocalution_hip_compute_interior(void)
-    {
 #ifdef SUPPORT_MULTINODE
-        _get_backend_descriptor()->HIP_stream_current
-            = _get_backend_descriptor()->HIP_stream_interior;
-
-        rocsparse_status status_sparse = rocsparse_set_stream(
-            *(static_cast<rocsparse_handle*>(_get_backend_descriptor()->ROC_sparse_handle)),
-            *(static_cast<hipStream_t*>(_get_backend_descriptor()->HIP_stream_current)));
+    // Bind the global rocSPARSE and rocBLAS handles to stream. The stream of the global
+    // descriptor is left unchanged, such that objects created meanwhile by other host
+    // threads do not pick up the compute mode.
+    static void rocalution_hip_compute_stream(void* stream)
+    {
+        rocsparse_status status_sparse
+            = rocsparse_set_stream(ROCSPARSE_HANDLE(_get_backend_descriptor()->ROC_sparse_handle),
+                                   *(static_cast<hipStream_t*>(stream)));
         CHECK_ROCSPARSE_ERROR(status_sparse, __FILE__, __LINE__);
 
-        rocblas_status status_blas = rocblas_set_stream(
-            *(static_cast<rocblas_handle*>(_get_backend_descriptor()->ROC_blas_handle)),
-            *(static_cast<hipStream_t*>(_get_backend_descriptor()->HIP_stream_current)));
+        rocblas_status status_blas
+            = rocblas_set_stream(ROCBLAS_HANDLE(_get_backend_descriptor()->ROC_blas_handle),
+                                 *(static_cast<hipStream_t*>(stream)));
         CHECK_ROCBLAS_ERROR(status_blas, __FILE__, __LINE__);
+    }
+#endif
+
+    void rocalution_hip_compute_interior(void)
+    {
+#ifdef SUPPORT_MULTINODE
+        rocalution_hip_compute_stream(_get_backend_descriptor()->HIP_stream_interior);
 #endif
     }
 
     void rocalution_hip_compute_ghost(void)
     {
 #ifdef SUPPORT_MULTINODE
-        _get_backend_descriptor()->HIP_stream_current = _get_backend_descriptor()->HIP_stream_ghost;
-
-        rocsparse_status status_sparse = rocsparse_set_stream(
-            *(static_cast<rocsparse_handle*>(_get_backend_descriptor()->ROC_sparse_handle)),
-            *(static_cast<hipStream_t*>(_get_backend_descriptor()->HIP_stream_current)));
-        CHECK_ROCSPARSE_ERROR(status_sparse, __FILE__, __LINE__);
-
-        rocblas_status status_blas = rocblas_set_stream(
-            *(static_cast<rocblas_handle*>(_get_backend_descriptor()->ROC_blas_handle)),
-            *(static_cast<hipStream_t*>(_get_backend_descriptor()->HIP_stream_current)));
-        CHECK_ROCBLAS_ERROR(status_blas, __FILE__, __LINE__);
+        rocalution_hip_compute_stream(_get_backend_descriptor()->HIP_stream_ghost);
 #endif
     }
 
@@ -394,18 +506,7 @@ namespace rocalution
     {
 #ifdef SUPPORT_MULTINODE
         // Default stream is NULL
-        _get_backend_descriptor()->HIP_stream_current
-            = _get_backend_descriptor()->HIP_stream_default;
-
-        rocsparse_status status_sparse = rocsparse_set_stream(
-            *(static_cast<rocsparse_handle*>(_get_backend_descriptor()->ROC_sparse_handle)),
-            *(static_cast<hipStream_t*>(_get_backend_descriptor()->HIP_stream_current)));
-        CHECK_ROCSPARSE_ERROR(status_sparse, __FILE__, __LINE__);
-
-        rocblas_status status_blas = rocblas_set_stream(
-            *(static_cast<rocblas_handle*>(_get_backend_descriptor()->ROC_blas_handle)),
-            *(static_cast<hipStream_t*>(_get_backend_descriptor()->HIP_stream_current)));
-        CHECK_ROCBLAS_ERROR(status_blas, __FILE__, __LINE__);
+        rocalution_hip_compute_stream(_get_backend_descriptor()->HIP_stream_default);
 #endif
     }
 
@@ -440,6 +541,10 @@ namespace rocalution
             return new HIPAcceleratorMatrixHYB<ValueType>(backend_descriptor);
         case BCSR:
             return new HIPAcceleratorMatrixBCSR<ValueType>(backend_descriptor, blockdim);
+        case SELL:
+            return new HIPAcceleratorMatrixSELL<ValueType>(backend_descriptor);
+        case VBR:
+            return new HIPAcceleratorMatrixVBR<ValueType>(backend_descriptor);
         default:
             LOG_INFO("This backed is not supported for Matrix types");
             FATAL_ERROR(__FILE__, __LINE__);
@@ -447,6 +552,26 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    AcceleratorStencil<ValueType>* _rocalution_init_base_hip_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type)
+    {
+        assert(backend_descriptor.backend == HIP);
+
+        switch(stencil_type)
+        {
+        case Laplace2D:
+            return new HIPAcceleratorStencilLaplace2D<ValueType>(backend_descriptor);
+        case Laplace3D:
+        case Laplace3D27:
+            return new HIPAcceleratorStencilLaplace3D<ValueType>(backend_descriptor, stencil_type);
+        default:
+            LOG_INFO("This backed is not supported for Stencil types");
+            FATAL_ERROR(__FILE__, __LINE__);
+            return NULL;
+        }
+    }
+
     template <typename ValueType>
     AcceleratorVector<ValueType>* _rocalution_init_base_hip_vector(
         const struct Rocalution_Backend_Descriptor& backend_descriptor)
@@ -461,6 +586,327 @@ namespace rocalution
         CHECK_HIP_ERROR(__FILE__, __LINE__);
     }
 
+    int64_t rocalution_hip_free_memory(void)
+    {
+        size_t free_mem  = 0;
+        size_t total_mem = 0;
+
+        hipMemGetInfo(&free_mem, &total_mem);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        return static_cast<int64_t>(free_mem);
+    }
+
+    int rocalution_hip_num_devices(void)
+    {
+        int num_dev = 0;
+
+        if(hipGetDeviceCount(&num_dev) != hipSuccess)
+        {
+            hipGetLastError();
+
+            return 0;
+        }
+
+        return num_dev;
+    }
+
+    int rocalution_hip_device_numa_node(int device)
+    {
+        char bus_id[64];
+
+        if(hipDeviceGetPCIBusId(bus_id, sizeof(bus_id), device) != hipSuccess)
+        {
+            hipGetLastError();
+
+            return -1;
+        }
+
+        // sysfs uses lower case PCI addresses (e.g. 0000:c1:00.0)
+        std::string id(bus_id);
+        std::transform(id.begin(), id.end(), id.begin(), ::tolower);
+
+        std::ifstream file("/sys/bus/pci/devices/" + id + "/numa_node");
+
+        int node = -1;
+        if(!(file >> node))
+        {
+            return -1;
+        }
+
+        return node;
+    }
+
+    int rocalution_hip_set_device(int device)
+    {
+        int prev;
+
+        hipGetDevice(&prev);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        if(device != prev)
+        {
+            hipSetDevice(device);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return prev;
+    }
+
+    // Enable peer access between device and all other devices in use (current device is
+    // changed)
+    static void rocalution_hip_enable_peer_access_(int device)
+    {
+        std::lock_guard<std::mutex> lock(_rocalution_hip_peer_mutex);
+
+        _rocalution_hip_peer_devices.insert(_get_backend_descriptor()->HIP_dev);
+
+        if(_rocalution_hip_peer_devices.insert(device).second == false)
+        {
+            return;
+        }
+
+        for(auto it = _rocalution_hip_peer_devices.begin();
+            it != _rocalution_hip_peer_devices.end();
+            ++it)
+        {
+            int peer = *it;
+
+            if(peer == device || peer < 0)
+            {
+                continue;
+            }
+
+            int access_to   = 0;
+            int access_from = 0;
+
+            hipDeviceCanAccessPeer(&access_to, device, peer);
+            hipDeviceCanAccessPeer(&access_from, peer, device);
+
+            // Without peer access, copies between the devices are staged by the runtime
+            if(access_to == 1)
+            {
+                hipSetDevice(device);
+                hipDeviceEnablePeerAccess(peer, 0);
+            }
+
+            if(access_from == 1)
+            {
+                hipSetDevice(peer);
+                hipDeviceEnablePeerAccess(device, 0);
+            }
+
+            // Peer access might have been enabled already by the application
+            hipGetLastError();
+
+            log_debug(0, "rocalution_hip_enable_peer_access_()", device, peer, access_to);
+        }
+    }
+
+    bool rocalution_hip_create_context(int    device,
+                                       void*  user_stream,
+                                       void** stream,
+                                       void** blas_handle,
+                                       void** sparse_handle)
+    {
+        log_debug(0, "rocalution_hip_create_context()", device, user_stream);
+
+        int prev = rocalution_hip_set_device(device);
+
+        rocalution_hip_enable_peer_access_(device);
+
+        // Stream and handles are created on the device of the context
+        hipSetDevice(device);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        hipStream_t*      hip_stream = new hipStream_t;
+        rocblas_handle*   blas       = new rocblas_handle;
+        rocsparse_handle* sparse     = new rocsparse_handle;
+
+        // The stream of the context has to be a blocking stream, such that work on the null
+        // stream (e.g. synchronous copies) stays ordered with respect to the context
+        if(user_stream != NULL)
+        {
+            *hip_stream = static_cast<hipStream_t>(user_stream);
+        }
+        else if(hipStreamCreate(hip_stream) != hipSuccess)
+        {
+            hipGetLastError();
+
+            delete hip_stream;
+            delete blas;
+            delete sparse;
+
+            rocalution_hip_set_device(prev);
+
+            return false;
+        }
+
+        if((rocblas_create_handle(blas) != rocblas_status_success)
+           || (rocsparse_create_handle(sparse) != rocsparse_status_success)
+           || (rocblas_set_stream(*blas, *hip_stream) != rocblas_status_success)
+           || (rocsparse_set_stream(*sparse, *hip_stream) != rocsparse_status_success))
+        {
+            LOG_INFO("Cannot create rocBLAS/rocSPARSE handles of the execution context");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        *stream        = hip_stream;
+        *blas_handle   = blas;
+        *sparse_handle = sparse;
+
+        hip_memory_pool_contexts(1);
+
+        rocalution_hip_set_device(prev);
+
+        return true;
+    }
+
+    void rocalution_hip_destroy_context(int   device,
+                                        bool  own_stream,
+                                        void* stream,
+                                        void* blas_handle,
+                                        void* sparse_handle)
+    {
+        log_debug(0, "rocalution_hip_destroy_context()", device, own_stream, stream);
+
+        int prev = rocalution_hip_set_device(device);
+
+        hipStream_t*      hip_stream = static_cast<hipStream_t*>(stream);
+        rocblas_handle*   blas       = static_cast<rocblas_handle*>(blas_handle);
+        rocsparse_handle* sparse     = static_cast<rocsparse_handle*>(sparse_handle);
+
+        // Work of the context has to be completed, before its resources are released
+        hipStreamSynchronize(*hip_stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        if(rocblas_destroy_handle(*blas) != rocblas_status_success)
+        {
+            LOG_INFO("Error in rocblas_destroy_handle");
+        }
+
+        if(rocsparse_destroy_handle(*sparse) != rocsparse_status_success)
+        {
+            LOG_INFO("Error in rocsparse_destroy_handle");
+        }
+
+        if(own_stream == true && hipStreamDestroy(*hip_stream) != hipSuccess)
+        {
+            LOG_INFO("Error in hipStreamDestroy");
+        }
+
+        delete hip_stream;
+        delete blas;
+        delete sparse;
+
+        hip_memory_pool_contexts(-1);
+
+        rocalution_hip_set_device(prev);
+    }
+
+    void rocalution_hip_sync_context(void* stream)
+    {
+        hipStreamSynchronize(*(static_cast<hipStream_t*>(stream)));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
+
+    void rocalution_hip_graph_begin(void* stream)
+    {
+        // Relaxed mode, such that the memory pool may still allocate during the capture
+        hipStreamBeginCapture(*(static_cast<hipStream_t*>(stream)), hipStreamCaptureModeRelaxed);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
+
+    void* rocalution_hip_graph_end(void* stream)
+    {
+        hipGraph_t      graph;
+        hipGraphExec_t* exec = new hipGraphExec_t;
+
+        hipStreamEndCapture(*(static_cast<hipStream_t*>(stream)), &graph);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        hipGraphInstantiate(exec, graph, NULL, NULL, 0);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        hipGraphDestroy(graph);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        log_debug(0, "rocalution_hip_graph_end()", stream, exec);
+
+        return exec;
+    }
+
+    void rocalution_hip_graph_launch(void* graph, void* stream)
+    {
+        hipGraphLaunch(*(static_cast<hipGraphExec_t*>(graph)),
+                       *(static_cast<hipStream_t*>(stream)));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
+
+    void rocalution_hip_graph_destroy(void* graph)
+    {
+        hipGraphExec_t* exec = static_cast<hipGraphExec_t*>(graph);
+
+        hipGraphExecDestroy(*exec);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        delete exec;
+    }
+
+    void* rocalution_hip_trace_event(void)
+    {
+        // The streams are created with the first use of the accelerator
+        if(_get_backend_descriptor()->HIP_stream_current == NULL)
+        {
+            return NULL;
+        }
+
+        hipStream_t stream = HIPSTREAM(_get_backend_descriptor()->HIP_stream_current);
+
+        // Events cannot be recorded into a graph
+        hipStreamCaptureStatus status;
+        hipStreamIsCapturing(stream, &status);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        if(status != hipStreamCaptureStatusNone)
+        {
+            return NULL;
+        }
+
+        hipEvent_t* event = new hipEvent_t;
+
+        hipEventCreate(event);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        hipEventRecord(*event, stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        return event;
+    }
+
+    double rocalution_hip_trace_elapsed(void* begin, void* end)
+    {
+        hipEventSynchronize(*static_cast<hipEvent_t*>(end));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        float ms;
+
+        hipEventElapsedTime(&ms, *static_cast<hipEvent_t*>(begin), *static_cast<hipEvent_t*>(end));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        return 1e3 * ms;
+    }
+
+    void rocalution_hip_trace_event_destroy(void* event)
+    {
+        hipEvent_t* ev = static_cast<hipEvent_t*>(event);
+
+        hipEventDestroy(*ev);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        delete ev;
+    }
+
     void rocalution_hip_sync_default(void)
     {
         hipStreamSynchronize(
@@ -522,4 +968,15 @@ namespace rocalution
         int                                         blockdim);
 #endif
 
+    template AcceleratorStencil<float>* _rocalution_init_base_hip_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+    template AcceleratorStencil<double>* _rocalution_init_base_hip_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+#ifdef SUPPORT_COMPLEX
+    template AcceleratorStencil<std::complex<float>>* _rocalution_init_base_hip_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+    template AcceleratorStencil<std::complex<double>>* _rocalution_init_base_hip_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+#endif
+
 } // namespace rocalution
@@ -35,6 +35,8 @@ namespace rocalution
     class AcceleratorMatrix;
     template <typename ValueType>
     class HostMatrix;
+    template <typename ValueType>
+    class AcceleratorStencil;
 
     /** \brief Initialize HIP (rocBLAS, rocSPARSE) */
     bool rocalution_init_hip();
@@ -56,6 +58,61 @@ namespace rocalution
     /** \brief Sync the ghost stream */
     void rocalution_hip_sync_ghost(void);
 
+    /** \brief Return the number of HIP devices */
+    int rocalution_hip_num_devices(void);
+
+    /** \brief Return the NUMA node the PCIe device \p device is attached to, -1 if it is
+    * not available */
+    int rocalution_hip_device_numa_node(int device);
+
+    /** \brief Return the free memory of the current device in bytes */
+    int64_t rocalution_hip_free_memory(void);
+
+    /** \brief Make \p device the current device of the calling thread, returns the
+    * previous one */
+    int rocalution_hip_set_device(int device);
+
+    /** \brief Create the rocBLAS/rocSPARSE handles of an execution context on \p device,
+    * bound to \p user_stream (a hipStream_t), or to a newly created stream if it is NULL.
+    * Peer access between \p device and the other devices in use is enabled. */
+    bool rocalution_hip_create_context(int    device,
+                                       void*  user_stream,
+                                       void** stream,
+                                       void** blas_handle,
+                                       void** sparse_handle);
+
+    /** \brief Destroy the handles of an execution context, and its stream if it is owned */
+    void rocalution_hip_destroy_context(int   device,
+                                        bool  own_stream,
+                                        void* stream,
+                                        void* blas_handle,
+                                        void* sparse_handle);
+
+    /** \brief Sync the stream of an execution context */
+    void rocalution_hip_sync_context(void* stream);
+
+    /** \brief Begin to capture the work queued on \p stream into a graph */
+    void rocalution_hip_graph_begin(void* stream);
+
+    /** \brief End the capture on \p stream and return the instantiated graph */
+    void* rocalution_hip_graph_end(void* stream);
+
+    /** \brief Launch an instantiated graph on \p stream */
+    void rocalution_hip_graph_launch(void* graph, void* stream);
+
+    /** \brief Destroy an instantiated graph */
+    void rocalution_hip_graph_destroy(void* graph);
+
+    /** \brief Record an event on the current stream for the timeline trace, returns NULL
+    * if the stream is being captured */
+    void* rocalution_hip_trace_event(void);
+
+    /** \brief Return the time in microseconds between two trace events, waits for \p end */
+    double rocalution_hip_trace_elapsed(void* begin, void* end);
+
+    /** \brief Destroy a trace event */
+    void rocalution_hip_trace_event_destroy(void* event);
+
     /** \brief Returns name of device architecture */
     std::string rocalution_get_arch_hip(void);
 
@@ -80,6 +137,11 @@ namespace rocalution
         unsigned int                                matrix_format,
         int                                         blockdim = 1);
 
+    /** \brief Build (and return) a stencil on HIP */
+    template <typename ValueType>
+    AcceleratorStencil<ValueType>* _rocalution_init_base_hip_stencil(
+        const struct Rocalution_Backend_Descriptor& backend_descriptor, unsigned int stencil_type);
+
 } // namespace rocalution
 
 #endif // ROCALUTION_BACKEND_HIP_HPP_
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -24,14 +24,22 @@
 #include "hip_allocate_free.hpp"
 #include "../../utils/allocate_free.hpp"
 #include "../../utils/def.hpp"
+#include "../backend_manager.hpp"
 #include "hip_kernels_general.hpp"
 #include "hip_utils.hpp"
 #include "rocalution/utils/types.hpp"
 
 #include <hip/hip_runtime.h>
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace rocalution
 {
@@ -51,6 +59,8 @@ namespace rocalution
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
             assert(*ptr != NULL);
+
+            _rocalution_memory_allocate(*ptr, n * sizeof(DataType), PinnedMemory);
         }
     }
 
@@ -61,6 +71,8 @@ namespace rocalution
 
         assert(*ptr != NULL);
 
+        _rocalution_memory_free(*ptr);
+
         //  delete[] *ptr;
         hipFreeHost(*ptr);
         CHECK_HIP_ERROR(__FILE__, __LINE__);
@@ -69,6 +81,435 @@ namespace rocalution
     }
 #endif
 
+    // Caching device memory pool
+    //
+    // Device buffers that are released through free_hip() are kept in a size ordered
+    // free list and are handed out again to later allocate_hip() calls of similar size.
+    // This keeps hipMalloc / hipFree (which implicitly synchronizes the device) out of
+    // hot paths that allocate temporary buffers on every call. The cached blocks are
+    // returned to the device when rocALUTION is stopped or when the device runs out of
+    // memory.
+    //
+    // While execution contexts exist, a released block may still be accessed by work on
+    // the stream of its context. Such blocks are kept pending and only become available
+    // after the device has been synchronized, which is done when an allocation cannot be
+    // served from the cached blocks.
+    //
+    // Blocks are only handed out again on the device they have been allocated on.
+    typedef std::pair<int, size_t> HIPBlockKey;
+
+    struct HIPMemoryPool
+    {
+        // Cached blocks, ordered by device and size
+        std::multimap<HIPBlockKey, void*> free_blocks;
+        // Released blocks that wait for a device synchronization
+        std::multimap<HIPBlockKey, void*> pending_blocks;
+        // Blocks in use, their device and size
+        std::unordered_map<void*, HIPBlockKey> used_blocks;
+
+        // Number of execution contexts
+        int contexts = 0;
+
+        // Total size of the cached blocks
+        size_t cached_bytes = 0;
+
+        // Event recorded on the null stream at the release of a block, the stream that a
+        // cached block is handed out on waits for it, and its device
+        hipEvent_t event     = NULL;
+        int        event_dev = -1;
+
+        std::mutex mutex;
+    };
+
+    static HIPMemoryPool& hip_memory_pool(void)
+    {
+        static HIPMemoryPool pool;
+
+        return pool;
+    }
+
+    // Make the pending blocks of device dev available, all devices if dev is negative
+    // (pool has to be locked)
+    static void hip_memory_pool_flush_pending_(HIPMemoryPool& pool, int dev)
+    {
+        for(auto it = pool.pending_blocks.begin(); it != pool.pending_blocks.end();)
+        {
+            if(dev < 0 || it->first.first == dev)
+            {
+                pool.free_blocks.insert(*it);
+                it = pool.pending_blocks.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Return all cached blocks of device dev to the device, of all devices if dev is
+    // negative (pool has to be locked)
+    static void hip_memory_pool_release_(HIPMemoryPool& pool, int dev)
+    {
+        int current;
+        hipGetDevice(&current);
+
+        std::set<int> devices;
+
+        for(auto it = pool.pending_blocks.begin(); it != pool.pending_blocks.end(); ++it)
+        {
+            devices.insert(it->first.first);
+        }
+
+        for(auto it = pool.free_blocks.begin(); it != pool.free_blocks.end(); ++it)
+        {
+            devices.insert(it->first.first);
+        }
+
+        for(auto d = devices.begin(); d != devices.end(); ++d)
+        {
+            if(dev >= 0 && *d != dev)
+            {
+                continue;
+            }
+
+            hipSetDevice(*d);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            hipDeviceSynchronize();
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            hip_memory_pool_flush_pending_(pool, *d);
+
+            for(auto it = pool.free_blocks.begin(); it != pool.free_blocks.end();)
+            {
+                if(it->first.first != *d)
+                {
+                    ++it;
+                    continue;
+                }
+
+                hipFree(it->second);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+                pool.cached_bytes -= it->first.second;
+                it = pool.free_blocks.erase(it);
+            }
+        }
+
+        hipSetDevice(current);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
+
+    // Managed memory is preferably placed on the device and stays accessible from there,
+    // when pages have been migrated to the host
+    static void* hip_managed_allocate(size_t bytes)
+    {
+        void* ptr = NULL;
+        int   dev;
+
+        hipGetDevice(&dev);
+
+        hipMallocManaged(&ptr, bytes, hipMemAttachGlobal);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        hipMemAdvise(ptr, bytes, hipMemAdviseSetPreferredLocation, dev);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        hipMemAdvise(ptr, bytes, hipMemAdviseSetAccessedBy, dev);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        return ptr;
+    }
+
+    static void* hip_memory_pool_allocate(size_t bytes)
+    {
+        void* ptr = NULL;
+
+        // Managed buffers are not cached, hipFree() releases them in hip_memory_pool_free()
+        if(_get_backend_descriptor()->HIP_managed_memory == true)
+        {
+            return hip_managed_allocate(bytes);
+        }
+
+        if(_get_backend_descriptor()->HIP_mem_pool == false)
+        {
+            hipMalloc(&ptr, bytes);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            return ptr;
+        }
+
+        // Round up to 512 bytes, to get more hits for buffers of nearly identical size
+        bytes = ((bytes - 1) / 512 + 1) * 512;
+
+        int dev;
+        hipGetDevice(&dev);
+
+        HIPMemoryPool&              pool = hip_memory_pool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+
+        // Smallest cached block of the device that fits, but does not waste more than half
+        // of it
+        auto it  = pool.free_blocks.lower_bound(HIPBlockKey(dev, bytes));
+        auto fit = [&](void) {
+            return it != pool.free_blocks.end() && it->first.first == dev
+                   && it->first.second <= 2 * bytes;
+        };
+
+        if(fit() == false && pool.pending_blocks.empty() == false)
+        {
+            // Wait for the work of the execution contexts on the pending blocks
+            hipDeviceSynchronize();
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            hip_memory_pool_flush_pending_(pool, dev);
+
+            it = pool.free_blocks.lower_bound(HIPBlockKey(dev, bytes));
+        }
+
+        if(fit() == true)
+        {
+            ptr   = it->second;
+            bytes = it->first.second;
+
+            pool.cached_bytes -= bytes;
+            pool.free_blocks.erase(it);
+
+            // The current stream waits for the work that has been queued before the block
+            // has been released
+            if(pool.event != NULL && dev == pool.event_dev
+               && _get_backend_descriptor()->HIP_stream_current != NULL)
+            {
+                hipStreamWaitEvent(
+                    HIPSTREAM(_get_backend_descriptor()->HIP_stream_current), pool.event, 0);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+            }
+        }
+        else
+        {
+            if(hipMalloc(&ptr, bytes) == hipErrorOutOfMemory)
+            {
+                // Give the cached blocks back to the device and try again
+                hipGetLastError();
+                hip_memory_pool_release_(pool, dev);
+
+                hipMalloc(&ptr, bytes);
+            }
+
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        pool.used_blocks[ptr] = HIPBlockKey(dev, bytes);
+
+        return ptr;
+    }
+
+    static void hip_memory_pool_free(void* ptr)
+    {
+        HIPMemoryPool&              pool = hip_memory_pool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+
+        auto it = pool.used_blocks.find(ptr);
+
+        // Block has not been allocated from the pool
+        if(it == pool.used_blocks.end())
+        {
+            hipFree(ptr);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            return;
+        }
+
+        HIPBlockKey key = it->second;
+        pool.used_blocks.erase(it);
+
+        int dev;
+        hipGetDevice(&dev);
+
+        // Blocks that cannot be ordered by the event of the current device wait for a
+        // synchronization of their device, too
+        if(pool.contexts > 0 || key.first != dev || (pool.event != NULL && dev != pool.event_dev))
+        {
+            pool.pending_blocks.insert(std::make_pair(key, ptr));
+            pool.cached_bytes += key.second;
+
+            return;
+        }
+
+        // Recording the event on the null stream captures all work that has been queued so
+        // far, on any blocking stream. The stream of the next user of a block waits for it,
+        // see hip_memory_pool_allocate(). Each record covers the work of all earlier ones,
+        // such that the last record orders every cached block.
+        if(pool.event == NULL)
+        {
+            hipEventCreateWithFlags(&pool.event, hipEventDisableTiming);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            pool.event_dev = dev;
+        }
+
+        hipEventRecord(pool.event, NULL);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        pool.free_blocks.insert(std::make_pair(key, ptr));
+        pool.cached_bytes += key.second;
+    }
+
+    void hip_memory_pool_contexts(int delta)
+    {
+        HIPMemoryPool&              pool = hip_memory_pool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+
+        pool.contexts += delta;
+
+        assert(pool.contexts >= 0);
+
+        // Destroying a context completes its work, the last one releases all pending blocks
+        if(pool.contexts == 0)
+        {
+            hip_memory_pool_flush_pending_(pool, -1);
+        }
+    }
+
+    void release_hip_memory_pool(void)
+    {
+        HIPMemoryPool&              pool = hip_memory_pool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+
+        log_debug(0, "release_hip_memory_pool()", pool.cached_bytes, pool.used_blocks.size());
+
+        hip_memory_pool_release_(pool, -1);
+
+        if(pool.event != NULL)
+        {
+            hipEventDestroy(pool.event);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            pool.event     = NULL;
+            pool.event_dev = -1;
+        }
+    }
+
+    // Pinned staging ring
+    //
+    // hipMemcpyAsync() from pageable host memory does not return before the data has been
+    // staged by the runtime, i.e. it is not asynchronous. Asynchronous host to device
+    // copies from pageable memory are therefore split into chunks, that are copied into a
+    // ring of page-locked slots. Each slot is transferred asynchronously while the next
+    // chunk is copied into the following slot, and a slot is only reused once its previous
+    // transfer has completed. When the copy returns, the source buffer is not accessed
+    // anymore, while the transfers of the last slots are still in flight. The slots are
+    // allocated on first use and are kept until rocALUTION is stopped.
+    static const int     hip_staging_slots      = 4;
+    static const int64_t hip_staging_slot_bytes = 8 * 1024 * 1024;
+
+    // Smaller pageable copies are left to the runtime
+    static const int64_t hip_staging_min_bytes = 64 * 1024;
+
+    struct HIPStagingRing
+    {
+        char*      slot[hip_staging_slots]  = {};
+        hipEvent_t event[hip_staging_slots] = {};
+
+        // Next slot to use
+        int current = 0;
+
+        std::mutex mutex;
+    };
+
+    static HIPStagingRing& hip_staging_ring(void)
+    {
+        static HIPStagingRing ring;
+
+        return ring;
+    }
+
+    // Return true, if ptr is page-locked (allocated or registered) host memory
+    static bool hip_is_pinned(const void* ptr)
+    {
+        unsigned int flags;
+
+        if(hipHostGetFlags(&flags, const_cast<void*>(ptr)) != hipSuccess)
+        {
+            // Clear the error state of the runtime
+            hipGetLastError();
+
+            return false;
+        }
+
+        return true;
+    }
+
+    static void
+        hip_staging_ring_copy_h2d(int64_t bytes, const void* src, void* dst, hipStream_t stream)
+    {
+        HIPStagingRing&             ring = hip_staging_ring();
+        std::lock_guard<std::mutex> lock(ring.mutex);
+
+        const char* src_bytes = static_cast<const char*>(src);
+        char*       dst_bytes = static_cast<char*>(dst);
+
+        for(int64_t offset = 0; offset < bytes; offset += hip_staging_slot_bytes)
+        {
+            int64_t chunk = std::min(hip_staging_slot_bytes, bytes - offset);
+            int     k     = ring.current;
+
+            ring.current = (k + 1) % hip_staging_slots;
+
+            if(ring.slot[k] == NULL)
+            {
+                hipHostMalloc((void**)&ring.slot[k], hip_staging_slot_bytes);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+                hipEventCreateWithFlags(&ring.event[k], hipEventDisableTiming);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+            }
+            else
+            {
+                // Wait for the previous transfer out of this slot
+                hipEventSynchronize(ring.event[k]);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+            }
+
+            std::memcpy(ring.slot[k], src_bytes + offset, chunk);
+
+            hipMemcpyAsync(
+                dst_bytes + offset, ring.slot[k], chunk, hipMemcpyHostToDevice, stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            hipEventRecord(ring.event[k], stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    void release_hip_staging_ring(void)
+    {
+        HIPStagingRing&             ring = hip_staging_ring();
+        std::lock_guard<std::mutex> lock(ring.mutex);
+
+        log_debug(0, "release_hip_staging_ring()");
+
+        for(int k = 0; k < hip_staging_slots; ++k)
+        {
+            if(ring.slot[k] != NULL)
+            {
+                hipEventSynchronize(ring.event[k]);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+                hipEventDestroy(ring.event[k]);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+                hipHostFree(ring.slot[k]);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+                ring.slot[k]  = NULL;
+                ring.event[k] = NULL;
+            }
+        }
+
+        ring.current = 0;
+    }
+
     template <typename DataType>
     void allocate_hip(int64_t n, DataType** ptr)
     {
@@ -78,10 +519,11 @@ namespace rocalution
         {
             assert(*ptr == NULL);
 
-            hipMalloc((void**)ptr, n * sizeof(DataType));
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            *ptr = static_cast<DataType*>(hip_memory_pool_allocate(n * sizeof(DataType)));
 
             assert(*ptr != NULL);
+
+            _rocalution_memory_allocate(*ptr, n * sizeof(DataType), AcceleratorMemory);
         }
     }
 
@@ -98,6 +540,8 @@ namespace rocalution
             {
                 hipHostMalloc((void**)ptr, n * sizeof(DataType));
                 CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+                _rocalution_memory_allocate(*ptr, n * sizeof(DataType), PinnedMemory);
             }
             else
             {
@@ -108,6 +552,37 @@ namespace rocalution
         }
     }
 
+    template <typename DataType>
+    void allocate_hip_host_resident(int64_t n, DataType** ptr)
+    {
+        log_debug(0, "allocate_hip_host_resident()", n, ptr);
+
+        if(n > 0)
+        {
+            assert(*ptr == NULL);
+
+            size_t bytes = n * sizeof(DataType);
+            int    dev;
+
+            hipGetDevice(&dev);
+
+            // Managed memory that stays in host memory, but can be read by the device. It
+            // is not taken from the pool, hence free_hip() releases it with hipFree().
+            hipMallocManaged((void**)ptr, bytes, hipMemAttachGlobal);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            hipMemAdvise(*ptr, bytes, hipMemAdviseSetPreferredLocation, hipCpuDeviceId);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            hipMemAdvise(*ptr, bytes, hipMemAdviseSetAccessedBy, dev);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            assert(*ptr != NULL);
+
+            _rocalution_memory_allocate(*ptr, bytes, PinnedMemory);
+        }
+    }
+
     template <typename DataType>
     void free_hip(DataType** ptr)
     {
@@ -115,8 +590,8 @@ namespace rocalution
 
         if(*ptr != NULL)
         {
-            hipFree(*ptr);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            _rocalution_memory_free(*ptr);
+            hip_memory_pool_free(*ptr);
 
             *ptr = NULL;
         }
@@ -131,6 +606,7 @@ namespace rocalution
         {
             if(_rocalution_available_accelerator() == true)
             {
+                _rocalution_memory_free(*ptr);
                 hipHostFree(*ptr);
                 CHECK_HIP_ERROR(__FILE__, __LINE__);
             }
@@ -224,6 +700,8 @@ namespace rocalution
 
         if(n > 0)
         {
+            ROCALUTION_RANGE("Copy accelerator to host");
+
             assert(src != NULL);
             assert(dst != NULL);
 
@@ -237,6 +715,8 @@ namespace rocalution
             }
 
             CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            _rocalution_transfer_record(sizeof(DataType) * n, false);
         }
     }
 
@@ -247,19 +727,30 @@ namespace rocalution
 
         if(n > 0)
         {
+            ROCALUTION_RANGE("Copy host to accelerator");
+
             assert(src != NULL);
             assert(dst != NULL);
 
+            int64_t bytes = sizeof(DataType) * n;
+
             if(async == false)
             {
-                hipMemcpy(dst, src, sizeof(DataType) * n, hipMemcpyHostToDevice);
+                hipMemcpy(dst, src, bytes, hipMemcpyHostToDevice);
+            }
+            else if(bytes >= hip_staging_min_bytes && hip_is_pinned(src) == false)
+            {
+                // Pageable source, stream it through the pinned staging ring
+                hip_staging_ring_copy_h2d(bytes, src, dst, stream);
             }
             else
             {
-                hipMemcpyAsync(dst, src, sizeof(DataType) * n, hipMemcpyHostToDevice, stream);
+                hipMemcpyAsync(dst, src, bytes, hipMemcpyHostToDevice, stream);
             }
 
             CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            _rocalution_transfer_record(bytes, true);
         }
     }
 
@@ -286,6 +777,24 @@ namespace rocalution
         }
     }
 
+    template <typename DataType>
+    void prefetch_hip(int64_t n, const DataType* ptr, hipStream_t stream)
+    {
+        log_debug(0, "prefetch_hip()", n, ptr, stream);
+
+        // Only managed buffers can be migrated
+        if(n > 0 && _get_backend_descriptor()->HIP_managed_memory == true)
+        {
+            assert(ptr != NULL);
+
+            int dev;
+            hipGetDevice(&dev);
+
+            hipMemPrefetchAsync(ptr, sizeof(DataType) * n, dev, stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
 #ifdef ROCALUTION_HIP_PINNED_MEMORY
     template void allocate_host<float>(int64_t, float**);
     template void allocate_host<double>(int64_t, double**);
@@ -322,8 +831,11 @@ namespace rocalution
     template void allocate_hip<int>(int64_t, int**);
     template void allocate_hip<unsigned int>(int64_t, unsigned int**);
     template void allocate_hip<int64_t>(int64_t, int64_t**);
+    template void allocate_hip<unsigned long long>(int64_t, unsigned long long**);
     template void allocate_hip<char>(int64_t, char**);
     template void allocate_hip<mis_tuple>(int64_t, mis_tuple**);
+    template void allocate_hip<csr_statistics_t>(int64_t, csr_statistics_t**);
+    template void allocate_hip<void*>(int64_t, void***);
 
     template void allocate_pinned<float>(int64_t, float**);
     template void allocate_pinned<double>(int64_t, double**);
@@ -332,6 +844,16 @@ namespace rocalution
     template void allocate_pinned<std::complex<double>>(int64_t, std::complex<double>**);
 #endif
 
+    template void allocate_hip_host_resident<float>(int64_t, float**);
+    template void allocate_hip_host_resident<double>(int64_t, double**);
+#ifdef SUPPORT_COMPLEX
+    template void allocate_hip_host_resident<std::complex<float>>(int64_t, std::complex<float>**);
+    template void allocate_hip_host_resident<std::complex<double>>(int64_t,
+                                                                   std::complex<double>**);
+#endif
+    template void allocate_hip_host_resident<int>(int64_t, int**);
+    template void allocate_hip_host_resident<int64_t>(int64_t, int64_t**);
+
     template void free_hip<float>(float**);
     template void free_hip<double>(double**);
 #ifdef SUPPORT_COMPLEX
@@ -342,8 +864,11 @@ namespace rocalution
     template void free_hip<int>(int**);
     template void free_hip<unsigned int>(unsigned int**);
     template void free_hip<int64_t>(int64_t**);
+    template void free_hip<unsigned long long>(unsigned long long**);
     template void free_hip<char>(char**);
     template void free_hip<mis_tuple>(mis_tuple**);
+    template void free_hip<csr_statistics_t>(csr_statistics_t**);
+    template void free_hip<void*>(void***);
 
     template void free_pinned<float>(float**);
     template void free_pinned<double>(double**);
@@ -363,6 +888,8 @@ namespace rocalution
     template void set_to_zero_hip<bool>(int, int64_t, bool*, bool, hipStream_t);
     template void set_to_zero_hip<int>(int, int64_t, int*, bool, hipStream_t);
     template void set_to_zero_hip<int64_t>(int, int64_t, int64_t*, bool, hipStream_t);
+    template void
+        set_to_zero_hip<unsigned long long>(int, int64_t, unsigned long long*, bool, hipStream_t);
 
     template void set_to_one_hip<float>(int, int64_t, float*, bool, hipStream_t);
     template void set_to_one_hip<double>(int, int64_t, double*, bool, hipStream_t);
@@ -387,6 +914,8 @@ namespace rocalution
     template void set_to_value_hip<bool>(int, int64_t, bool*, bool, bool, hipStream_t);
     template void set_to_value_hip<int>(int, int64_t, int*, int, bool, hipStream_t);
     template void set_to_value_hip<int64_t>(int, int64_t, int64_t*, int64_t, bool, hipStream_t);
+    template void set_to_value_hip<unsigned long long>(
+        int, int64_t, unsigned long long*, unsigned long long, bool, hipStream_t);
 
     template void copy_d2h<float>(int64_t, const float*, float*, bool, hipStream_t);
     template void copy_d2h<double>(int64_t, const double*, double*, bool, hipStream_t);
@@ -399,6 +928,10 @@ namespace rocalution
     template void copy_d2h<int>(int64_t, const int*, int*, bool, hipStream_t);
     template void copy_d2h<int64_t>(int64_t, const int64_t*, int64_t*, bool, hipStream_t);
     template void copy_d2h<bool>(int64_t, const bool*, bool*, bool, hipStream_t);
+    template void copy_d2h<unsigned long long>(
+        int64_t, const unsigned long long*, unsigned long long*, bool, hipStream_t);
+    template void copy_d2h<csr_statistics_t>(
+        int64_t, const csr_statistics_t*, csr_statistics_t*, bool, hipStream_t);
 
     template void copy_h2d<float>(int64_t, const float*, float*, bool, hipStream_t);
     template void copy_h2d<double>(int64_t, const double*, double*, bool, hipStream_t);
@@ -411,6 +944,7 @@ namespace rocalution
     template void copy_h2d<int>(int64_t, const int*, int*, bool, hipStream_t);
     template void copy_h2d<int64_t>(int64_t, const int64_t*, int64_t*, bool, hipStream_t);
     template void copy_h2d<bool>(int64_t, const bool*, bool*, bool, hipStream_t);
+    template void copy_h2d<void*>(int64_t, void* const*, void**, bool, hipStream_t);
 
     template void copy_d2d<float>(int64_t, const float*, float*, bool, hipStream_t);
     template void copy_d2d<double>(int64_t, const double*, double*, bool, hipStream_t);
@@ -423,4 +957,18 @@ namespace rocalution
     template void copy_d2d<int>(int64_t, const int*, int*, bool, hipStream_t);
     template void copy_d2d<int64_t>(int64_t, const int64_t*, int64_t*, bool, hipStream_t);
     template void copy_d2d<bool>(int64_t, const bool*, bool*, bool, hipStream_t);
+
+    template void prefetch_hip<float>(int64_t, const float*, hipStream_t);
+    template void prefetch_hip<double>(int64_t, const double*, hipStream_t);
+#ifdef SUPPORT_COMPLEX
+    template void prefetch_hip<std::complex<float>>(int64_t,
+                                                    const std::complex<float>*,
+                                                    hipStream_t);
+    template void prefetch_hip<std::complex<double>>(int64_t,
+                                                     const std::complex<double>*,
+                                                     hipStream_t);
+#endif
+    template void prefetch_hip<int>(int64_t, const int*, hipStream_t);
+    template void prefetch_hip<int64_t>(int64_t, const int64_t*, hipStream_t);
+    template void prefetch_hip<bool>(int64_t, const bool*, hipStream_t);
 } // namespace rocalution
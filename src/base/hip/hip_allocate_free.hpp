@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -32,9 +32,24 @@ namespace rocalution
     template <typename DataType>
     void allocate_hip(int64_t n, DataType** ptr);
 
+    /** \brief Allocate a managed buffer that resides in host memory and is read by the
+    * device over the interconnect, released by free_hip() */
+    template <typename DataType>
+    void allocate_hip_host_resident(int64_t n, DataType** ptr);
+
     template <typename DataType>
     void free_hip(DataType** ptr);
 
+    /** \brief Return all cached blocks of the device memory pool to the device */
+    void release_hip_memory_pool(void);
+
+    /** \brief Register (+1) or unregister (-1) an execution context with the device
+    * memory pool */
+    void hip_memory_pool_contexts(int delta);
+
+    /** \brief Release the pinned staging buffers of asynchronous host to device copies */
+    void release_hip_staging_ring(void);
+
     template <typename DataType>
     void set_to_zero_hip(
         int blocksize, int64_t n, DataType* ptr, bool async = false, hipStream_t stream = 0);
@@ -62,6 +77,10 @@ namespace rocalution
     template <typename DataType>
     void copy_d2d(
         int64_t n, const DataType* src, DataType* dst, bool async = false, hipStream_t stream = 0);
+
+    /** \brief Migrate a managed device buffer to the device (managed memory mode only) */
+    template <typename DataType>
+    void prefetch_hip(int64_t n, const DataType* ptr, hipStream_t stream = 0);
 } // namespace rocalution
 
 #endif // ROCALUTION_HIP_ALLOCATE_FREE_HPP_
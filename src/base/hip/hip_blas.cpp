@@ -831,4 +831,77 @@ namespace rocalution
                              ldc);
     }
 
+    // rocblas_trsv
+    template <>
+    rocblas_status rocblasTtrsv(rocblas_handle    handle,
+                                rocblas_fill      uplo,
+                                rocblas_operation trans,
+                                rocblas_diagonal  diag,
+                                int               m,
+                                const float*      A,
+                                int               lda,
+                                float*            x,
+                                int               incx)
+    {
+        return rocblas_strsv(handle, uplo, trans, diag, m, A, lda, x, incx);
+    }
+
+    template <>
+    rocblas_status rocblasTtrsv(rocblas_handle    handle,
+                                rocblas_fill      uplo,
+                                rocblas_operation trans,
+                                rocblas_diagonal  diag,
+                                int               m,
+                                const double*     A,
+                                int               lda,
+                                double*           x,
+                                int               incx)
+    {
+        return rocblas_dtrsv(handle, uplo, trans, diag, m, A, lda, x, incx);
+    }
+
+    template <>
+    rocblas_status rocblasTtrsv(rocblas_handle             handle,
+                                rocblas_fill               uplo,
+                                rocblas_operation          trans,
+                                rocblas_diagonal           diag,
+                                int                        m,
+                                const std::complex<float>* A,
+                                int                        lda,
+                                std::complex<float>*       x,
+                                int                        incx)
+    {
+        return rocblas_ctrsv(handle,
+                             uplo,
+                             trans,
+                             diag,
+                             m,
+                             (const rocblas_float_complex*)A,
+                             lda,
+                             (rocblas_float_complex*)x,
+                             incx);
+    }
+
+    template <>
+    rocblas_status rocblasTtrsv(rocblas_handle              handle,
+                                rocblas_fill                uplo,
+                                rocblas_operation           trans,
+                                rocblas_diagonal            diag,
+                                int                         m,
+                                const std::complex<double>* A,
+                                int                         lda,
+                                std::complex<double>*       x,
+                                int                         incx)
+    {
+        return rocblas_ztrsv(handle,
+                             uplo,
+                             trans,
+                             diag,
+                             m,
+                             (const rocblas_double_complex*)A,
+                             lda,
+                             (rocblas_double_complex*)x,
+                             incx);
+    }
+
 } // namespace rocalution
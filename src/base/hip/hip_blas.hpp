@@ -154,6 +154,18 @@ namespace rocalution
                                 ValueType*        C,
                                 int               ldc);
 
+    // rocblas_trsv
+    template <typename ValueType>
+    rocblas_status rocblasTtrsv(rocblas_handle    handle,
+                                rocblas_fill      uplo,
+                                rocblas_operation trans,
+                                rocblas_diagonal  diag,
+                                int               m,
+                                const ValueType*  A,
+                                int               lda,
+                                ValueType*        x,
+                                int               incx);
+
 } // namespace rocalution
 
 #endif // ROCALUTION_HIP_HIP_BLAS_HPP_
@@ -27,6 +27,8 @@
 #include "hip_allocate_free.hpp"
 #include "hip_blas.hpp"
 #include "hip_kernels_conversion.hpp"
+#include "hip_kernels_coo.hpp"
+#include "hip_kernels_sell.hpp"
 #include "hip_sparse.hpp"
 #include "hip_utils.hpp"
 #include "rocalution/utils/types.hpp"
@@ -93,15 +95,111 @@ namespace rocalution
         assert(dst != NULL);
         assert(backend != NULL);
 
+        int         blocksize = backend->HIP_block_size;
+        hipStream_t stream    = HIPSTREAM(backend->HIP_stream_current);
+
         allocate_hip(nrow + 1, &dst->row_offset);
         allocate_hip(nnz, &dst->col);
         allocate_hip(nnz, &dst->val);
 
-        copy_d2d(nnz, src.col, dst->col, true, HIPSTREAM(backend->HIP_stream_current));
-        copy_d2d(nnz, src.val, dst->val, true, HIPSTREAM(backend->HIP_stream_current));
+        // Detect whether the entries are already sorted by row and column
+        int  h_order[2];
+        int* d_order = NULL;
+
+        allocate_hip(2, &d_order);
+        set_to_zero_hip(blocksize, 2, d_order);
+
+        kernel_coo_detect_order<<<(nnz - 1) / blocksize + 1, blocksize, 0, stream>>>(
+            nnz, src.row, src.col, d_order);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        copy_d2h(2, d_order, h_order, true, stream);
+        hipStreamSynchronize(stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&d_order);
+
+        const IndexType* sorted_row = src.row;
+        IndexType*       tmp_row    = NULL;
+
+        if(h_order[0] == 0 && h_order[1] == 0)
+        {
+            // Fast path, the row offsets follow directly from the row indices
+            copy_d2d(nnz, src.col, dst->col, true, stream);
+            copy_d2d(nnz, src.val, dst->val, true, stream);
+        }
+        else
+        {
+            // Unordered input, radix sort by the linearized (row, col) index
+            uint64_t*  key      = NULL;
+            uint64_t*  key_sort = NULL;
+            IndexType* perm     = NULL;
+            IndexType* perm_out = NULL;
+
+            allocate_hip(nnz, &key);
+            allocate_hip(nnz, &key_sort);
+            allocate_hip(nnz, &perm);
+            allocate_hip(nnz, &perm_out);
+            allocate_hip(nnz, &tmp_row);
+
+            kernel_coo_sort_key<<<(nnz - 1) / blocksize + 1, blocksize, 0, stream>>>(
+                nnz, ncol, src.row, src.col, key, perm);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            // Only the significant bits of the key are sorted
+            uint64_t max_key = static_cast<uint64_t>(nrow) * ncol - 1;
+            int      end_bit = 1;
+
+            while(end_bit < 64 && (max_key >> end_bit) > 0)
+            {
+                ++end_bit;
+            }
+
+            size_t rocprim_size   = 0;
+            char*  rocprim_buffer = NULL;
+
+            rocprim::radix_sort_pairs(rocprim_buffer,
+                                      rocprim_size,
+                                      key,
+                                      key_sort,
+                                      perm,
+                                      perm_out,
+                                      nnz,
+                                      0,
+                                      end_bit,
+                                      stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            allocate_hip(rocprim_size, &rocprim_buffer);
+
+            rocprim::radix_sort_pairs(rocprim_buffer,
+                                      rocprim_size,
+                                      key,
+                                      key_sort,
+                                      perm,
+                                      perm_out,
+                                      nnz,
+                                      0,
+                                      end_bit,
+                                      stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&rocprim_buffer);
+            free_hip(&perm);
+            free_hip(&key);
+
+            kernel_coo_sort_gather<<<(nnz - 1) / blocksize + 1, blocksize, 0, stream>>>(
+                nnz, ncol, key_sort, perm_out, src.val, tmp_row, dst->col, dst->val);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&perm_out);
+            free_hip(&key_sort);
+
+            sorted_row = tmp_row;
+        }
 
         rocsparse_status status = rocsparse_coo2csr(ROCSPARSE_HANDLE(backend->ROC_sparse_handle),
-                                                    src.row,
+                                                    sorted_row,
                                                     nnz,
                                                     nrow,
                                                     dst->row_offset,
@@ -111,6 +209,8 @@ namespace rocalution
         // Sync memcopy
         hipDeviceSynchronize();
 
+        free_hip(&tmp_row);
+
         return true;
     }
 
@@ -554,6 +654,251 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool csr_to_sell_hip(const Rocalution_Backend_Descriptor*                backend,
+                         int64_t                                             nnz,
+                         IndexType                                           nrow,
+                         IndexType                                           ncol,
+                         const MatrixCSR<ValueType, IndexType, PointerType>& src,
+                         IndexType                                           slice_size,
+                         IndexType                                           sigma,
+                         MatrixSELL<ValueType, IndexType, PointerType>*      dst,
+                         int64_t*                                            nnz_sell)
+    {
+        assert(nnz > 0);
+        assert(nrow > 0);
+        assert(ncol > 0);
+        assert(slice_size > 0);
+        assert(sigma % slice_size == 0);
+        assert(backend != NULL);
+
+        assert(dst != NULL);
+        assert(nnz_sell != NULL);
+
+        // Get blocksize
+        int blocksize = backend->HIP_block_size;
+
+        // Get stream
+        hipStream_t stream = HIPSTREAM(backend->HIP_stream_current);
+
+        IndexType nslice  = (nrow - 1) / slice_size + 1;
+        IndexType nwindow = (nrow - 1) / sigma + 1;
+
+        dst->slice_size = slice_size;
+        dst->nslice     = nslice;
+
+        allocate_hip(nslice + 1, &dst->slice_offset);
+        allocate_hip(nrow, &dst->perm);
+
+        // Row lengths (sort keys) and identity permutation
+        IndexType* row_nnz  = NULL;
+        IndexType* row_nnz2 = NULL;
+        IndexType* perm     = NULL;
+
+        allocate_hip(nrow, &row_nnz);
+        allocate_hip(nrow, &row_nnz2);
+        allocate_hip(nrow, &perm);
+
+        kernel_sell_row_nnz<<<(nrow - 1) / blocksize + 1, blocksize, 0, stream>>>(
+            nrow, src.row_offset, row_nnz, perm);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        IndexType* window_offset = NULL;
+        allocate_hip(nwindow + 1, &window_offset);
+
+        kernel_sell_window_offset<<<nwindow / blocksize + 1, blocksize, 0, stream>>>(
+            nrow, nwindow, sigma, window_offset);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        // Sort rows by decreasing length within each window (radix sort is stable)
+        size_t rocprim_size   = 0;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::segmented_radix_sort_pairs_desc(rocprim_buffer,
+                                                 rocprim_size,
+                                                 row_nnz,
+                                                 row_nnz2,
+                                                 perm,
+                                                 dst->perm,
+                                                 nrow,
+                                                 nwindow,
+                                                 window_offset,
+                                                 window_offset + 1,
+                                                 0,
+                                                 8 * sizeof(IndexType),
+                                                 stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::segmented_radix_sort_pairs_desc(rocprim_buffer,
+                                                 rocprim_size,
+                                                 row_nnz,
+                                                 row_nnz2,
+                                                 perm,
+                                                 dst->perm,
+                                                 nrow,
+                                                 nwindow,
+                                                 window_offset,
+                                                 window_offset + 1,
+                                                 0,
+                                                 8 * sizeof(IndexType),
+                                                 stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+        free_hip(&window_offset);
+        free_hip(&perm);
+        free_hip(&row_nnz);
+
+        // Slice offsets
+        PointerType* slice_nnz = NULL;
+        allocate_hip(nslice + 1, &slice_nnz);
+
+        kernel_sell_slice_nnz<<<nslice / blocksize + 1, blocksize, 0, stream>>>(
+            nslice, slice_size, row_nnz2, slice_nnz);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&row_nnz2);
+
+        rocprim_size   = 0;
+        rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                slice_nnz,
+                                dst->slice_offset,
+                                0,
+                                nslice + 1,
+                                rocprim::plus<PointerType>(),
+                                stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                slice_nnz,
+                                dst->slice_offset,
+                                0,
+                                nslice + 1,
+                                rocprim::plus<PointerType>(),
+                                stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+        free_hip(&slice_nnz);
+
+        PointerType total;
+        copy_d2h(1, dst->slice_offset + nslice, &total);
+
+        *nnz_sell = total;
+
+        // Fill SELL structures
+        allocate_hip(*nnz_sell, &dst->col);
+        allocate_hip(*nnz_sell, &dst->val);
+
+        kernel_sell_fill<<<(nslice * slice_size - 1) / blocksize + 1, blocksize, 0, stream>>>(
+            nrow,
+            nslice,
+            slice_size,
+            src.row_offset,
+            src.col,
+            src.val,
+            dst->slice_offset,
+            dst->perm,
+            dst->col,
+            dst->val);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        return true;
+    }
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool sell_to_csr_hip(const Rocalution_Backend_Descriptor*                 backend,
+                         int64_t                                              nnz,
+                         IndexType                                            nrow,
+                         IndexType                                            ncol,
+                         const MatrixSELL<ValueType, IndexType, PointerType>& src,
+                         MatrixCSR<ValueType, IndexType, PointerType>*        dst,
+                         int64_t*                                             nnz_csr)
+    {
+        assert(nnz > 0);
+        assert(nrow > 0);
+        assert(ncol > 0);
+        assert(backend != NULL);
+
+        assert(dst != NULL);
+        assert(nnz_csr != NULL);
+
+        // Get blocksize
+        int blocksize = backend->HIP_block_size;
+
+        // Get stream
+        hipStream_t stream = HIPSTREAM(backend->HIP_stream_current);
+
+        // Non-padded entries per row
+        PointerType* row_nnz = NULL;
+        allocate_hip(nrow + 1, &row_nnz);
+        set_to_zero_hip(blocksize, nrow + 1, row_nnz);
+
+        kernel_sell_csr_row_nnz<<<(nrow - 1) / blocksize + 1, blocksize, 0, stream>>>(
+            nrow, src.slice_size, src.slice_offset, src.perm, src.col, row_nnz);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(nrow + 1, &dst->row_offset);
+
+        size_t rocprim_size   = 0;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                row_nnz,
+                                dst->row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PointerType>(),
+                                stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                row_nnz,
+                                dst->row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PointerType>(),
+                                stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+        free_hip(&row_nnz);
+
+        PointerType total;
+        copy_d2h(1, dst->row_offset + nrow, &total);
+
+        *nnz_csr = total;
+
+        allocate_hip(*nnz_csr, &dst->col);
+        allocate_hip(*nnz_csr, &dst->val);
+
+        kernel_sell_csr_fill<<<(nrow - 1) / blocksize + 1, blocksize, 0, stream>>>(
+            nrow,
+            src.slice_size,
+            src.slice_offset,
+            src.perm,
+            src.col,
+            src.val,
+            dst->row_offset,
+            dst->col,
+            dst->val);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        return true;
+    }
+
     template <typename ValueType, typename IndexType, typename PointerType>
     bool csr_to_hyb_hip(const Rocalution_Backend_Descriptor*                backend,
                         int64_t                                             nnz,
@@ -1152,6 +1497,84 @@ namespace rocalution
                                  int*                                                 num_diag);
 #endif
 
+    // csr_to_sell
+    template bool csr_to_sell_hip(const Rocalution_Backend_Descriptor*  backend,
+                                  int64_t                               nnz,
+                                  int                                   nrow,
+                                  int                                   ncol,
+                                  const MatrixCSR<float, int, PtrType>& src,
+                                  int                                   slice_size,
+                                  int                                   sigma,
+                                  MatrixSELL<float, int, PtrType>*      dst,
+                                  int64_t*                              nnz_sell);
+
+    template bool csr_to_sell_hip(const Rocalution_Backend_Descriptor*   backend,
+                                  int64_t                                nnz,
+                                  int                                    nrow,
+                                  int                                    ncol,
+                                  const MatrixCSR<double, int, PtrType>& src,
+                                  int                                    slice_size,
+                                  int                                    sigma,
+                                  MatrixSELL<double, int, PtrType>*      dst,
+                                  int64_t*                               nnz_sell);
+
+#ifdef SUPPORT_COMPLEX
+    template bool csr_to_sell_hip(const Rocalution_Backend_Descriptor*                backend,
+                                  int64_t                                             nnz,
+                                  int                                                 nrow,
+                                  int                                                 ncol,
+                                  const MatrixCSR<std::complex<float>, int, PtrType>& src,
+                                  int                                                 slice_size,
+                                  int                                                 sigma,
+                                  MatrixSELL<std::complex<float>, int, PtrType>*      dst,
+                                  int64_t*                                            nnz_sell);
+
+    template bool csr_to_sell_hip(const Rocalution_Backend_Descriptor*                 backend,
+                                  int64_t                                              nnz,
+                                  int                                                  nrow,
+                                  int                                                  ncol,
+                                  const MatrixCSR<std::complex<double>, int, PtrType>& src,
+                                  int                                                  slice_size,
+                                  int                                                  sigma,
+                                  MatrixSELL<std::complex<double>, int, PtrType>*      dst,
+                                  int64_t*                                             nnz_sell);
+#endif
+
+    // sell_to_csr
+    template bool sell_to_csr_hip(const Rocalution_Backend_Descriptor*   backend,
+                                  int64_t                                nnz,
+                                  int                                    nrow,
+                                  int                                    ncol,
+                                  const MatrixSELL<float, int, PtrType>& src,
+                                  MatrixCSR<float, int, PtrType>*        dst,
+                                  int64_t*                               nnz_csr);
+
+    template bool sell_to_csr_hip(const Rocalution_Backend_Descriptor*    backend,
+                                  int64_t                                 nnz,
+                                  int                                     nrow,
+                                  int                                     ncol,
+                                  const MatrixSELL<double, int, PtrType>& src,
+                                  MatrixCSR<double, int, PtrType>*        dst,
+                                  int64_t*                                nnz_csr);
+
+#ifdef SUPPORT_COMPLEX
+    template bool sell_to_csr_hip(const Rocalution_Backend_Descriptor*                 backend,
+                                  int64_t                                              nnz,
+                                  int                                                  nrow,
+                                  int                                                  ncol,
+                                  const MatrixSELL<std::complex<float>, int, PtrType>& src,
+                                  MatrixCSR<std::complex<float>, int, PtrType>*        dst,
+                                  int64_t*                                             nnz_csr);
+
+    template bool sell_to_csr_hip(const Rocalution_Backend_Descriptor*                  backend,
+                                  int64_t                                               nnz,
+                                  int                                                   nrow,
+                                  int                                                   ncol,
+                                  const MatrixSELL<std::complex<double>, int, PtrType>& src,
+                                  MatrixCSR<std::complex<double>, int, PtrType>*        dst,
+                                  int64_t*                                              nnz_csr);
+#endif
+
     // csr_to_hyb
     template bool csr_to_hyb_hip(const Rocalution_Backend_Descriptor*  backend,
                                  int64_t                               nnz,
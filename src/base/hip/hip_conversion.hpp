@@ -100,6 +100,26 @@ namespace rocalution
                         int64_t*                                            nnz_dia,
                         IndexType*                                          num_diag);
 
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool csr_to_sell_hip(const Rocalution_Backend_Descriptor*                backend,
+                         int64_t                                             nnz,
+                         IndexType                                           nrow,
+                         IndexType                                           ncol,
+                         const MatrixCSR<ValueType, IndexType, PointerType>& src,
+                         IndexType                                           slice_size,
+                         IndexType                                           sigma,
+                         MatrixSELL<ValueType, IndexType, PointerType>*      dst,
+                         int64_t*                                            nnz_sell);
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool sell_to_csr_hip(const Rocalution_Backend_Descriptor*                 backend,
+                         int64_t                                              nnz,
+                         IndexType                                            nrow,
+                         IndexType                                            ncol,
+                         const MatrixSELL<ValueType, IndexType, PointerType>& src,
+                         MatrixCSR<ValueType, IndexType, PointerType>*        dst,
+                         int64_t*                                             nnz_csr);
+
     template <typename ValueType, typename IndexType, typename PointerType>
     bool csr_to_hyb_hip(const Rocalution_Backend_Descriptor*                backend,
                         int64_t                                             nnz,
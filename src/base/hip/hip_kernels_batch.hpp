@@ -0,0 +1,755 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_HIP_HIP_KERNELS_BATCH_HPP_
+#define ROCALUTION_HIP_HIP_KERNELS_BATCH_HPP_
+
+#include "hip_utils.hpp"
+
+#include <hip/hip_runtime.h>
+
+namespace rocalution
+{
+
+    // Kernels for batches of small systems that share a CSR sparsity pattern. The values
+    // of system k start at val + k * nnz, its vectors at vec + k * nrow. The solvers run
+    // entirely within a single kernel, where each thread block iterates on one system.
+
+    // Sum over a wavefront, the result is returned to all lanes
+    template <unsigned int WFSIZE, typename ValueType>
+    static __device__ __forceinline__ ValueType batch_wf_sum(ValueType val)
+    {
+        for(unsigned int i = WFSIZE >> 1; i > 0; i >>= 1)
+        {
+            val += __shfl_xor(val, i);
+        }
+
+        return val;
+    }
+
+#ifdef SUPPORT_COMPLEX
+    template <unsigned int WFSIZE, typename ValueType>
+    static __device__ __forceinline__ std::complex<ValueType>
+                                      batch_wf_sum(std::complex<ValueType> val)
+    {
+        return std::complex<ValueType>(batch_wf_sum<WFSIZE>(val.real()),
+                                       batch_wf_sum<WFSIZE>(val.imag()));
+    }
+#endif
+
+    // Offsets of the diagonal entries, missing is set to 1 if a row has no diagonal entry
+    template <typename IndexType, typename PointerType>
+    __global__ void kernel_batch_csr_diag_offset(IndexType nrow,
+                                                 const PointerType* __restrict__ row_offset,
+                                                 const IndexType* __restrict__ col,
+                                                 PointerType* __restrict__ diag,
+                                                 int* __restrict__ missing)
+    {
+        IndexType row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        PointerType row_end = row_offset[row + 1];
+
+        for(PointerType j = row_offset[row]; j < row_end; ++j)
+        {
+            if(col[j] == row)
+            {
+                diag[row] = j;
+                return;
+            }
+        }
+
+        diag[row] = -1;
+        *missing  = 1;
+    }
+
+    // One thread per row of all systems
+    template <typename ValueType, typename IndexType, typename PointerType>
+    __global__ void kernel_batch_csr_spmv(int64_t   size,
+                                          IndexType nrow,
+                                          int64_t   nnz,
+                                          const PointerType* __restrict__ row_offset,
+                                          const IndexType* __restrict__ col,
+                                          const ValueType* __restrict__ val,
+                                          const ValueType* __restrict__ in,
+                                          ValueType* __restrict__ out)
+    {
+        int64_t gid = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+
+        if(gid >= size)
+        {
+            return;
+        }
+
+        int64_t   k   = gid / nrow;
+        IndexType row = gid % nrow;
+
+        const ValueType* A = val + k * nnz;
+        const ValueType* x = in + k * nrow;
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        PointerType row_end = row_offset[row + 1];
+
+        for(PointerType j = row_offset[row]; j < row_end; ++j)
+        {
+            sum += A[j] * x[col[j]];
+        }
+
+        out[gid] = sum;
+    }
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    __global__ void kernel_batch_csr_extract_inv_diag(int64_t   size,
+                                                      IndexType nrow,
+                                                      int64_t   nnz,
+                                                      const PointerType* __restrict__ diag,
+                                                      const ValueType* __restrict__ val,
+                                                      ValueType* __restrict__ inv_diag,
+                                                      int* __restrict__ detect_zero_diag)
+    {
+        int64_t gid = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+
+        if(gid >= size)
+        {
+            return;
+        }
+
+        int64_t   k   = gid / nrow;
+        IndexType row = gid % nrow;
+
+        ValueType d = val[k * nnz + diag[row]];
+
+        if(d == static_cast<ValueType>(0))
+        {
+            inv_diag[gid]     = static_cast<ValueType>(1);
+            *detect_zero_diag = 1;
+        }
+        else
+        {
+            inv_diag[gid] = static_cast<ValueType>(1) / d;
+        }
+    }
+
+    // Position of column key within the sorted column indices [begin, end), -1 if the
+    // entry is not present
+    template <typename IndexType, typename PointerType>
+    static __device__ __forceinline__ PointerType
+        batch_csr_find(PointerType begin, PointerType end, const IndexType* col, IndexType key)
+    {
+        PointerType last = end;
+
+        while(begin < end)
+        {
+            PointerType mid = (begin + end) >> 1;
+
+            if(col[mid] < key)
+            {
+                begin = mid + 1;
+            }
+            else
+            {
+                end = mid;
+            }
+        }
+
+        return (begin < last && col[begin] == key) ? begin : -1;
+    }
+
+    // In-place ILU(0), one thread block per system. The rows are eliminated one after
+    // another, the threads of the block update the entries of the current row.
+    template <unsigned int BLOCKSIZE, typename ValueType, typename IndexType, typename PointerType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_batch_csr_ilu0(IndexType nrow,
+                                   int64_t   nnz,
+                                   const PointerType* __restrict__ row_offset,
+                                   const IndexType* __restrict__ col,
+                                   const PointerType* __restrict__ diag,
+                                   ValueType* __restrict__ val)
+    {
+        IndexType  tid = threadIdx.x;
+        ValueType* A   = val + blockIdx.x * nnz;
+
+        for(IndexType row = 0; row < nrow; ++row)
+        {
+            PointerType row_end = row_offset[row + 1];
+
+            for(PointerType j = row_offset[row]; j < diag[row]; ++j)
+            {
+                IndexType   col_j  = col[j];
+                PointerType diag_j = diag[col_j];
+                ValueType   d      = A[diag_j];
+
+                if(d != static_cast<ValueType>(0))
+                {
+                    ValueType factor = A[j] / d;
+
+                    __syncthreads();
+
+                    if(tid == 0)
+                    {
+                        A[j] = factor;
+                    }
+
+                    // Linear combination with the upper part of row col_j
+                    PointerType end_j = row_offset[col_j + 1];
+
+                    for(PointerType l = diag_j + 1 + tid; l < end_j; l += BLOCKSIZE)
+                    {
+                        PointerType pos = batch_csr_find(j + 1, row_end, col, col[l]);
+
+                        if(pos != -1)
+                        {
+                            A[pos] -= factor * A[l];
+                        }
+                    }
+                }
+
+                __syncthreads();
+            }
+        }
+    }
+
+    // y = A * x for a single system, the block has to be synchronized, because x was
+    // computed by other threads
+    template <unsigned int BLOCKSIZE, typename ValueType, typename IndexType, typename PointerType>
+    static __device__ __forceinline__ void
+        batch_block_spmv(IndexType nrow,
+                         const PointerType* __restrict__ row_offset,
+                         const IndexType* __restrict__ col,
+                         const ValueType* __restrict__ A,
+                         const ValueType* x,
+                         ValueType*       y)
+    {
+        __syncthreads();
+
+        for(IndexType row = threadIdx.x; row < nrow; row += BLOCKSIZE)
+        {
+            ValueType sum = static_cast<ValueType>(0);
+
+            PointerType row_end = row_offset[row + 1];
+
+            for(PointerType j = row_offset[row]; j < row_end; ++j)
+            {
+                sum += A[j] * x[col[j]];
+            }
+
+            y[row] = sum;
+        }
+    }
+
+    // Dot product x^H y of a single system, the result is returned to all threads
+    template <unsigned int BLOCKSIZE, typename ValueType, typename IndexType>
+    static __device__ __forceinline__ ValueType
+        batch_block_dot(IndexType nrow, const ValueType* x, const ValueType* y, ValueType* sdata)
+    {
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(IndexType i = threadIdx.x; i < nrow; i += BLOCKSIZE)
+        {
+            sum += hip_conj(x[i]) * y[i];
+        }
+
+        sdata[threadIdx.x] = sum;
+
+        __syncthreads();
+
+        block_reduce_sum<BLOCKSIZE>(threadIdx.x, sdata);
+
+        sum = sdata[0];
+
+        __syncthreads();
+
+        return sum;
+    }
+
+    template <unsigned int BLOCKSIZE, typename ValueType, typename IndexType>
+    static __device__ __forceinline__ double
+        batch_block_norm(IndexType nrow, const ValueType* x, ValueType* sdata)
+    {
+        return sqrt(static_cast<double>(hip_real(batch_block_dot<BLOCKSIZE>(nrow, x, x, sdata))));
+    }
+
+    // out = M^-1 in with M either Jacobi (inv_diag), ILU(0) (lu) or the identity. The
+    // triangular solves are carried out by the first wavefront, row after row.
+    template <unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              typename ValueType,
+              typename IndexType,
+              typename PointerType>
+    static __device__ __forceinline__ void
+        batch_block_precond(IndexType nrow,
+                            const PointerType* __restrict__ row_offset,
+                            const IndexType* __restrict__ col,
+                            const PointerType* __restrict__ diag,
+                            const ValueType* inv_diag,
+                            const ValueType* lu,
+                            const ValueType* in,
+                            ValueType*       out)
+    {
+        if(inv_diag != NULL)
+        {
+            for(IndexType i = threadIdx.x; i < nrow; i += BLOCKSIZE)
+            {
+                out[i] = inv_diag[i] * in[i];
+            }
+        }
+        else if(lu != NULL)
+        {
+            __syncthreads();
+
+            if(threadIdx.x < WFSIZE)
+            {
+                IndexType lid = threadIdx.x;
+
+                // Forward substitution with the unit lower triangular part
+                for(IndexType row = 0; row < nrow; ++row)
+                {
+                    ValueType sum = static_cast<ValueType>(0);
+
+                    for(PointerType j = row_offset[row] + lid; j < diag[row]; j += WFSIZE)
+                    {
+                        sum += lu[j] * out[col[j]];
+                    }
+
+                    sum = batch_wf_sum<WFSIZE>(sum);
+
+                    // All lanes hold the sum and store the same value, such that each
+                    // lane only depends on its own stores in the following rows
+                    out[row] = in[row] - sum;
+                }
+
+                // Backward substitution with the upper triangular part
+                for(IndexType row = nrow - 1; row >= 0; --row)
+                {
+                    ValueType sum = static_cast<ValueType>(0);
+                    ValueType val = out[row];
+
+                    PointerType row_end = row_offset[row + 1];
+
+                    for(PointerType j = diag[row] + 1 + lid; j < row_end; j += WFSIZE)
+                    {
+                        sum += lu[j] * out[col[j]];
+                    }
+
+                    sum = batch_wf_sum<WFSIZE>(sum);
+
+                    out[row] = (val - sum) / lu[diag[row]];
+                }
+            }
+
+            __syncthreads();
+        }
+        else
+        {
+            for(IndexType i = threadIdx.x; i < nrow; i += BLOCKSIZE)
+            {
+                out[i] = in[i];
+            }
+        }
+    }
+
+    // Right preconditioned BiCGStab, one thread block per system, work holds 7 * nrow
+    // values per system
+    template <unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              typename ValueType,
+              typename IndexType,
+              typename PointerType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_batch_csr_bicgstab(IndexType nrow,
+                                       int64_t   nnz,
+                                       const PointerType* __restrict__ row_offset,
+                                       const IndexType* __restrict__ col,
+                                       const PointerType* __restrict__ diag,
+                                       const ValueType* __restrict__ val,
+                                       const ValueType* __restrict__ inv_diag,
+                                       const ValueType* __restrict__ lu,
+                                       const ValueType* __restrict__ rhs,
+                                       ValueType* __restrict__ x,
+                                       ValueType* __restrict__ work,
+                                       double abs_tol,
+                                       double rel_tol,
+                                       int    max_iter,
+                                       int* __restrict__ iter,
+                                       double* __restrict__ res)
+    {
+        __shared__ ValueType sdata[BLOCKSIZE];
+
+        IndexType tid = threadIdx.x;
+        int64_t   k   = blockIdx.x;
+
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        const ValueType* A  = val + k * nnz;
+        const ValueType* D  = (inv_diag != NULL) ? inv_diag + k * nrow : NULL;
+        const ValueType* LU = (lu != NULL) ? lu + k * nnz : NULL;
+        const ValueType* b  = rhs + k * nrow;
+        ValueType*       xk = x + k * nrow;
+
+        ValueType* r  = work + k * 7 * nrow;
+        ValueType* r0 = r + nrow;
+        ValueType* p  = r + 2 * nrow;
+        ValueType* v  = r + 3 * nrow;
+        ValueType* ph = r + 4 * nrow;
+        ValueType* sh = r + 5 * nrow;
+        ValueType* t  = r + 6 * nrow;
+
+        // r = r0 = b - Ax
+        batch_block_spmv<BLOCKSIZE>(nrow, row_offset, col, A, xk, r);
+
+        for(IndexType i = tid; i < nrow; i += BLOCKSIZE)
+        {
+            r[i]  = b[i] - r[i];
+            r0[i] = r[i];
+            p[i]  = zero;
+            v[i]  = zero;
+        }
+
+        double res0 = batch_block_norm<BLOCKSIZE>(nrow, r, sdata);
+        double nrm  = res0;
+        int    it   = 0;
+
+        ValueType rho_old = one;
+        ValueType alpha   = one;
+        ValueType omega   = one;
+
+        while(it < max_iter && nrm > abs_tol && nrm > rel_tol * res0)
+        {
+            ++it;
+
+            ValueType rho = batch_block_dot<BLOCKSIZE>(nrow, r0, r, sdata);
+
+            if(rho == zero)
+            {
+                break;
+            }
+
+            ValueType beta = (rho / rho_old) * (alpha / omega);
+
+            // p = r + beta * (p - omega * v)
+            for(IndexType i = tid; i < nrow; i += BLOCKSIZE)
+            {
+                p[i] = r[i] + beta * (p[i] - omega * v[i]);
+            }
+
+            // v = A M^-1 p
+            batch_block_precond<BLOCKSIZE, WFSIZE>(nrow, row_offset, col, diag, D, LU, p, ph);
+            batch_block_spmv<BLOCKSIZE>(nrow, row_offset, col, A, ph, v);
+
+            ValueType r0v = batch_block_dot<BLOCKSIZE>(nrow, r0, v, sdata);
+
+            if(r0v == zero)
+            {
+                break;
+            }
+
+            alpha = rho / r0v;
+
+            // s = r - alpha * v, stored in r
+            for(IndexType i = tid; i < nrow; i += BLOCKSIZE)
+            {
+                r[i] -= alpha * v[i];
+            }
+
+            nrm = batch_block_norm<BLOCKSIZE>(nrow, r, sdata);
+
+            if(nrm <= abs_tol || nrm <= rel_tol * res0)
+            {
+                for(IndexType i = tid; i < nrow; i += BLOCKSIZE)
+                {
+                    xk[i] += alpha * ph[i];
+                }
+
+                break;
+            }
+
+            // t = A M^-1 s
+            batch_block_precond<BLOCKSIZE, WFSIZE>(nrow, row_offset, col, diag, D, LU, r, sh);
+            batch_block_spmv<BLOCKSIZE>(nrow, row_offset, col, A, sh, t);
+
+            ValueType tt = batch_block_dot<BLOCKSIZE>(nrow, t, t, sdata);
+            ValueType ts = batch_block_dot<BLOCKSIZE>(nrow, t, r, sdata);
+
+            omega = (tt == zero) ? zero : ts / tt;
+
+            // x = x + alpha * p + omega * s, r = s - omega * t
+            for(IndexType i = tid; i < nrow; i += BLOCKSIZE)
+            {
+                xk[i] += alpha * ph[i] + omega * sh[i];
+                r[i] -= omega * t[i];
+            }
+
+            nrm     = batch_block_norm<BLOCKSIZE>(nrow, r, sdata);
+            rho_old = rho;
+
+            if(omega == zero)
+            {
+                break;
+            }
+        }
+
+        if(tid == 0)
+        {
+            iter[k] = it;
+            res[k]  = nrm;
+        }
+    }
+
+    // Right preconditioned GMRES(m), one thread block per system, work holds
+    // (m + 2) * nrow + (m + 1) * m + 3 * m + 1 values per system. The small least squares
+    // problem is updated by the first thread.
+    template <unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              typename ValueType,
+              typename IndexType,
+              typename PointerType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_batch_csr_gmres(IndexType nrow,
+                                    int       m,
+                                    int64_t   nnz,
+                                    const PointerType* __restrict__ row_offset,
+                                    const IndexType* __restrict__ col,
+                                    const PointerType* __restrict__ diag,
+                                    const ValueType* __restrict__ val,
+                                    const ValueType* __restrict__ inv_diag,
+                                    const ValueType* __restrict__ lu,
+                                    const ValueType* __restrict__ rhs,
+                                    ValueType* __restrict__ x,
+                                    ValueType* __restrict__ work,
+                                    double abs_tol,
+                                    double rel_tol,
+                                    int    max_iter,
+                                    int* __restrict__ iter,
+                                    double* __restrict__ res)
+    {
+        __shared__ ValueType sdata[BLOCKSIZE];
+
+        IndexType tid = threadIdx.x;
+        int64_t   k   = blockIdx.x;
+
+        ValueType zero = static_cast<ValueType>(0);
+
+        const ValueType* A  = val + k * nnz;
+        const ValueType* D  = (inv_diag != NULL) ? inv_diag + k * nrow : NULL;
+        const ValueType* LU = (lu != NULL) ? lu + k * nnz : NULL;
+        const ValueType* b  = rhs + k * nrow;
+        ValueType*       xk = x + k * nrow;
+
+        // Krylov basis, column-major Hessenberg matrix, rotations and right-hand side of
+        // the least squares problem
+        ValueType* V = work + k * ((m + 2) * static_cast<int64_t>(nrow) + (m + 1) * m + 3 * m + 1);
+        ValueType* z = V + (m + 1) * nrow;
+        ValueType* H = z + nrow;
+        ValueType* c = H + (m + 1) * m;
+        ValueType* s = c + m;
+        ValueType* g = s + m;
+
+        // r = b - Ax
+        batch_block_spmv<BLOCKSIZE>(nrow, row_offset, col, A, xk, V);
+
+        for(IndexType i = tid; i < nrow; i += BLOCKSIZE)
+        {
+            V[i] = b[i] - V[i];
+        }
+
+        double res0 = batch_block_norm<BLOCKSIZE>(nrow, V, sdata);
+        double nrm  = res0;
+        int    it   = 0;
+
+        while(it < max_iter && nrm > abs_tol && nrm > rel_tol * res0)
+        {
+            ValueType scale = static_cast<ValueType>(1.0 / nrm);
+
+            for(IndexType i = tid; i < nrow; i += BLOCKSIZE)
+            {
+                V[i] *= scale;
+            }
+
+            if(tid == 0)
+            {
+                g[0] = static_cast<ValueType>(nrm);
+
+                for(int i = 1; i <= m; ++i)
+                {
+                    g[i] = zero;
+                }
+            }
+
+            int j = 0;
+
+            while(j < m && it < max_iter)
+            {
+                ValueType* w = V + (j + 1) * nrow;
+                ValueType* h = H + j * (m + 1);
+
+                // w = A M^-1 v_j
+                batch_block_precond<BLOCKSIZE, WFSIZE>(
+                    nrow, row_offset, col, diag, D, LU, V + j * nrow, z);
+                batch_block_spmv<BLOCKSIZE>(nrow, row_offset, col, A, z, w);
+
+                // Modified Gram-Schmidt
+                for(int i = 0; i <= j; ++i)
+                {
+                    ValueType hij = batch_block_dot<BLOCKSIZE>(nrow, V + i * nrow, w, sdata);
+
+                    for(IndexType l = tid; l < nrow; l += BLOCKSIZE)
+                    {
+                        w[l] -= hij * V[i * nrow + l];
+                    }
+
+                    if(tid == 0)
+                    {
+                        h[i] = hij;
+                    }
+                }
+
+                double hn = batch_block_norm<BLOCKSIZE>(nrow, w, sdata);
+
+                if(hn != 0.0)
+                {
+                    scale = static_cast<ValueType>(1.0 / hn);
+
+                    for(IndexType l = tid; l < nrow; l += BLOCKSIZE)
+                    {
+                        w[l] *= scale;
+                    }
+                }
+
+                // Apply the previous rotations to the new column and eliminate h_(j+1)j
+                if(tid == 0)
+                {
+                    h[j + 1] = static_cast<ValueType>(hn);
+
+                    for(int i = 0; i < j; ++i)
+                    {
+                        ValueType tmp = h[i];
+
+                        h[i]     = c[i] * tmp + s[i] * h[i + 1];
+                        h[i + 1] = -hip_conj(s[i]) * tmp + c[i] * h[i + 1];
+                    }
+
+                    double ax = static_cast<double>(hip_abs(h[j]));
+                    double ay = hn;
+
+                    if(ay == 0.0)
+                    {
+                        c[j] = static_cast<ValueType>(1);
+                        s[j] = zero;
+                    }
+                    else if(ax == 0.0)
+                    {
+                        c[j] = zero;
+                        s[j] = static_cast<ValueType>(1);
+                    }
+                    else
+                    {
+                        double r = sqrt(ax * ax + ay * ay);
+
+                        c[j] = static_cast<ValueType>(ax / r);
+                        s[j] = h[j] / static_cast<ValueType>(ax) * static_cast<ValueType>(ay / r);
+                    }
+
+                    h[j]     = c[j] * h[j] + s[j] * h[j + 1];
+                    h[j + 1] = zero;
+
+                    g[j + 1] = -hip_conj(s[j]) * g[j];
+                    g[j]     = c[j] * g[j];
+                }
+
+                __syncthreads();
+
+                ++j;
+                ++it;
+
+                nrm = static_cast<double>(hip_abs(g[j]));
+
+                if(nrm <= abs_tol || nrm <= rel_tol * res0 || hn == 0.0)
+                {
+                    break;
+                }
+            }
+
+            // Solve the upper triangular system H y = g, y is stored in g
+            if(tid == 0)
+            {
+                for(int i = j - 1; i >= 0; --i)
+                {
+                    for(int l = i + 1; l < j; ++l)
+                    {
+                        g[i] -= H[i + l * (m + 1)] * g[l];
+                    }
+
+                    g[i] /= H[i + i * (m + 1)];
+                }
+            }
+
+            __syncthreads();
+
+            // x = x + M^-1 V y, the last basis vector is not needed anymore
+            for(IndexType l = tid; l < nrow; l += BLOCKSIZE)
+            {
+                ValueType sum = zero;
+
+                for(int i = 0; i < j; ++i)
+                {
+                    sum += g[i] * V[i * nrow + l];
+                }
+
+                z[l] = sum;
+            }
+
+            batch_block_precond<BLOCKSIZE, WFSIZE>(
+                nrow, row_offset, col, diag, D, LU, z, V + m * nrow);
+
+            for(IndexType l = tid; l < nrow; l += BLOCKSIZE)
+            {
+                xk[l] += V[m * nrow + l];
+            }
+
+            // True residual for the restart
+            batch_block_spmv<BLOCKSIZE>(nrow, row_offset, col, A, xk, V);
+
+            for(IndexType i = tid; i < nrow; i += BLOCKSIZE)
+            {
+                V[i] = b[i] - V[i];
+            }
+
+            nrm = batch_block_norm<BLOCKSIZE>(nrow, V, sdata);
+        }
+
+        if(tid == 0)
+        {
+            iter[k] = it;
+            res[k]  = nrm;
+        }
+    }
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HIP_HIP_KERNELS_BATCH_HPP_
@@ -0,0 +1,106 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_HIP_HIP_KERNELS_BCSR_HPP_
+#define ROCALUTION_HIP_HIP_KERNELS_BCSR_HPP_
+
+#include "../matrix_formats_ind.hpp"
+
+#include <hip/hip_runtime.h>
+
+namespace rocalution
+{
+    // One thread per block row, the diagonal block is stored in the block row itself
+    template <typename T, typename I>
+    __global__ void kernel_bcsr_extract_diag(I nrowb,
+                                             I blockdim,
+                                             const I* __restrict__ row_offset,
+                                             const I* __restrict__ col,
+                                             const T* __restrict__ val,
+                                             T* __restrict__ vec)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrowb)
+        {
+            return;
+        }
+
+        for(I aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            if(ai == col[aj])
+            {
+                for(I bi = 0; bi < blockdim; ++bi)
+                {
+                    vec[ai * blockdim + bi] = val[BCSR_IND(aj, bi, bi, blockdim)];
+                }
+
+                break;
+            }
+        }
+    }
+
+    template <typename T, typename I>
+    __global__ void kernel_bcsr_extract_inv_diag(I nrowb,
+                                                 I blockdim,
+                                                 const I* __restrict__ row_offset,
+                                                 const I* __restrict__ col,
+                                                 const T* __restrict__ val,
+                                                 T* __restrict__ vec,
+                                                 int* __restrict__ detect_zero)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrowb)
+        {
+            return;
+        }
+
+        for(I aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            if(ai == col[aj])
+            {
+                for(I bi = 0; bi < blockdim; ++bi)
+                {
+                    T diag = val[BCSR_IND(aj, bi, bi, blockdim)];
+
+                    if(diag != static_cast<T>(0))
+                    {
+                        vec[ai * blockdim + bi] = static_cast<T>(1) / diag;
+                    }
+                    else
+                    {
+                        vec[ai * blockdim + bi] = static_cast<T>(1);
+
+                        *detect_zero = 1;
+                    }
+                }
+
+                break;
+            }
+        }
+    }
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HIP_HIP_KERNELS_BCSR_HPP_
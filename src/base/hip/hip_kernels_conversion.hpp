@@ -170,6 +170,49 @@ namespace rocalution
         }
     }
 
+    // Linearized (row, col) sort key and identity permutation
+    template <typename I>
+    __global__ void kernel_coo_sort_key(int64_t nnz,
+                                        I       ncol,
+                                        const I* __restrict__ row,
+                                        const I* __restrict__ col,
+                                        uint64_t* __restrict__ key,
+                                        I* __restrict__ perm)
+    {
+        int64_t i = static_cast<int64_t>(hipBlockDim_x) * hipBlockIdx_x + hipThreadIdx_x;
+
+        if(i >= nnz)
+        {
+            return;
+        }
+
+        key[i]  = static_cast<uint64_t>(row[i]) * ncol + col[i];
+        perm[i] = static_cast<I>(i);
+    }
+
+    // Recover row and column from the sorted keys and gather the values
+    template <typename T, typename I>
+    __global__ void kernel_coo_sort_gather(int64_t nnz,
+                                           I       ncol,
+                                           const uint64_t* __restrict__ key,
+                                           const I* __restrict__ perm,
+                                           const T* __restrict__ val,
+                                           I* __restrict__ sorted_row,
+                                           I* __restrict__ sorted_col,
+                                           T* __restrict__ sorted_val)
+    {
+        int64_t i = static_cast<int64_t>(hipBlockDim_x) * hipBlockIdx_x + hipThreadIdx_x;
+
+        if(i >= nnz)
+        {
+            return;
+        }
+
+        sorted_row[i] = static_cast<I>(key[i] / ncol);
+        sorted_col[i] = static_cast<I>(key[i] % ncol);
+        sorted_val[i] = val[perm[i]];
+    }
+
 } // namespace rocalution
 
 #endif // ROCALUTION_HIP_HIP_KERNELS_CONVERSION_HPP_
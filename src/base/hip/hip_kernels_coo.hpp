@@ -24,6 +24,9 @@
 #ifndef ROCALUTION_HIP_HIP_KERNELS_COO_HPP_
 #define ROCALUTION_HIP_HIP_KERNELS_COO_HPP_
 
+#include "hip_atomics.hpp"
+#include "hip_utils.hpp"
+
 #include <hip/hip_runtime.h>
 
 namespace rocalution
@@ -46,6 +49,47 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType, typename IndexType>
+    __global__ void kernel_coo_row_l1_norm(int64_t nnz,
+                                           const IndexType* __restrict__ row,
+                                           const ValueType* __restrict__ val,
+                                           ValueType* __restrict__ vec)
+    {
+        int64_t ind = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ind >= nnz)
+        {
+            return;
+        }
+
+        atomicAdd(&vec[row[ind]], static_cast<ValueType>(hip_abs(val[ind])));
+    }
+
+    // Flag unordered COO entries, order[0] is set if the rows are not grouped in
+    // ascending order, order[1] if the columns within a row are not sorted
+    template <typename I>
+    __global__ void kernel_coo_detect_order(int64_t nnz,
+                                            const I* __restrict__ row,
+                                            const I* __restrict__ col,
+                                            int* __restrict__ order)
+    {
+        int64_t i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x + 1;
+
+        if(i >= nnz)
+        {
+            return;
+        }
+
+        if(row[i] < row[i - 1])
+        {
+            order[0] = 1;
+        }
+        else if(row[i] == row[i - 1] && col[i] < col[i - 1])
+        {
+            order[1] = 1;
+        }
+    }
+
 } // namespace rocalution
 
 #endif // ROCALUTION_HIP_HIP_KERNELS_COO_HPP_
@@ -30,6 +30,9 @@
 #include "hip_unordered_set.hpp"
 #include "hip_utils.hpp"
 
+#include <hip/hip_bfloat16.h>
+#include <hip/hip_cooperative_groups.h>
+#include <hip/hip_fp16.h>
 #include <hip/hip_runtime.h>
 
 namespace rocalution
@@ -155,371 +158,361 @@ namespace rocalution
         }
     }
 
-    template <typename T, typename I, typename J>
-    __global__ void kernel_csr_extract_inv_diag(I nrow,
-                                                const J* __restrict__ row_offset,
-                                                const I* __restrict__ col,
-                                                const T* __restrict__ val,
-                                                T* __restrict__ vec,
-                                                int* __restrict__ detect_zero)
+    // Copy the row offsets into 32 bit indices, all offsets have to fit into 32 bits
+    template <typename PointerType>
+    __global__ void kernel_csr_row_offset_32(int nrow,
+                                             const PointerType* __restrict__ row_offset,
+                                             int* __restrict__ row_offset_32)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        int row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(ai >= nrow)
+        if(row > nrow)
         {
             return;
         }
 
-        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
-        {
-            if(ai == col[aj])
-            {
-                if(val[aj] != static_cast<T>(0))
-                {
-                    vec[ai] = static_cast<T>(1) / val[aj];
-                }
-                else
-                {
-                    vec[ai] = static_cast<T>(1);
-
-                    *detect_zero = 1;
-                }
-            }
-        }
+        row_offset_32[row] = static_cast<int>(row_offset[row]);
     }
 
-    template <typename T, typename I, typename J>
-    __global__ void kernel_csr_extract_submatrix_row_nnz(const J* __restrict__ row_offset,
-                                                         const I* __restrict__ col,
-                                                         const T* __restrict__ val,
-                                                         I smrow_offset,
-                                                         I smcol_offset,
-                                                         I smrow_size,
-                                                         I smcol_size,
-                                                         J* __restrict__ row_nnz)
+    // Round the values to the storage precision S of the reduced precision product
+    template <typename T, typename S>
+    __global__ void kernel_csr_round_values(int64_t nnz,
+                                            const T* __restrict__ val,
+                                            S* __restrict__ val_reduced)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
 
-        if(ai >= smrow_size)
+        if(idx >= nnz)
         {
             return;
         }
 
-        I nnz = 0;
-        I ind = ai + smrow_offset;
-
-        for(J aj = row_offset[ind]; aj < row_offset[ind + 1]; ++aj)
-        {
-            I c = col[aj];
-
-            if((c >= smcol_offset) && (c < smcol_offset + smcol_size))
-            {
-                ++nnz;
-            }
-        }
-
-        row_nnz[ai] = nnz;
+        val_reduced[idx] = static_cast<S>(static_cast<float>(val[idx]));
     }
 
-    template <typename T, typename I, typename J>
-    __global__ void kernel_csr_extract_submatrix_copy(const J* __restrict__ row_offset,
-                                                      const I* __restrict__ col,
-                                                      const T* __restrict__ val,
-                                                      I smrow_offset,
-                                                      I smcol_offset,
-                                                      I smrow_size,
-                                                      I smcol_size,
-                                                      const J* __restrict__ sm_row_offset,
-                                                      I* __restrict__ sm_col,
-                                                      T* __restrict__ sm_val)
+    // y = alpha * A * x + beta * y with the values of A stored in reduced precision S,
+    // products are accumulated in T
+    template <unsigned int WFSIZE, typename T, typename S, typename I, typename J>
+    __global__ void kernel_csrmv_reduced_precision(I nrow,
+                                                   const J* __restrict__ row_offset,
+                                                   const I* __restrict__ col,
+                                                   const S* __restrict__ val,
+                                                   T alpha,
+                                                   const T* __restrict__ x,
+                                                   T beta,
+                                                   T* __restrict__ y)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        I tid = threadIdx.x;
+        I gid = blockIdx.x * blockDim.x + tid;
+        I lid = tid & (WFSIZE - 1);
+        I row = gid / WFSIZE;
 
-        if(ai >= smrow_size)
+        if(row >= nrow)
         {
             return;
         }
 
-        J row_nnz = sm_row_offset[ai];
-        I ind     = ai + smrow_offset;
+        J start = row_offset[row];
+        J end   = row_offset[row + 1];
 
-        for(J aj = row_offset[ind]; aj < row_offset[ind + 1]; ++aj)
+        T sum = static_cast<T>(0);
+
+        for(J aj = start + lid; aj < end; aj += WFSIZE)
         {
-            I c = col[aj];
+            sum += static_cast<T>(static_cast<float>(val[aj])) * x[col[aj]];
+        }
 
-            if((c >= smcol_offset) && (c < smcol_offset + smcol_size))
-            {
-                sm_col[row_nnz] = c - smcol_offset;
-                sm_val[row_nnz] = val[aj];
-                ++row_nnz;
-            }
+        wf_reduce_sum<WFSIZE>(&sum);
+
+        if(lid == 0)
+        {
+            y[row] = (beta == static_cast<T>(0)) ? alpha * sum : alpha * sum + beta * y[row];
         }
     }
 
-    template <typename T, typename I, typename J>
-    __global__ void kernel_csr_diagmatmult_r(I nrow,
-                                             const J* __restrict__ row_offset,
-                                             const I* __restrict__ col,
-                                             const T* __restrict__ diag,
-                                             T* __restrict__ val)
+    // Smallest column of each row as base of the compressed column indices, the number of
+    // non-zeros of the rows whose column span exceeds 8 and 16 bits is accumulated in
+    // nnz_over[0] and nnz_over[1]
+    template <typename I, typename J>
+    __global__ void kernel_csr_column_base(I nrow,
+                                           const J* __restrict__ row_offset,
+                                           const I* __restrict__ col,
+                                           I* __restrict__ col_base,
+                                           I* __restrict__ col_span,
+                                           unsigned long long* __restrict__ nnz_over)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(ai >= nrow)
+        if(row >= nrow)
         {
             return;
         }
 
-        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        J start = row_offset[row];
+        J end   = row_offset[row + 1];
+
+        I col_min = (start < end) ? col[start] : 0;
+        I col_max = col_min;
+
+        for(J aj = start + 1; aj < end; ++aj)
         {
-            val[aj] = val[aj] * diag[col[aj]];
+            col_min = min(col_min, col[aj]);
+            col_max = max(col_max, col[aj]);
         }
-    }
 
-    template <typename T, typename I, typename J>
-    __global__ void kernel_csr_diagmatmult_l(I nrow,
-                                             const J* __restrict__ row_offset,
-                                             const T* __restrict__ diag,
-                                             T* __restrict__ val)
-    {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        col_base[row] = col_min;
+        col_span[row] = col_max - col_min;
 
-        if(ai >= nrow)
+        unsigned long long row_nnz = static_cast<unsigned long long>(end - start);
+
+        if(col_max - col_min > 255)
         {
-            return;
+            atomicAdd(&nnz_over[0], row_nnz);
         }
 
-        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        if(col_max - col_min > 65535)
         {
-            val[aj] = val[aj] * diag[ai];
+            atomicAdd(&nnz_over[1], row_nnz);
         }
     }
 
-    // Calculates the number of non-zero elements per row
-    template <typename I, typename J>
-    __global__ void
-        kernel_calc_row_nnz(I nrow, const J* __restrict__ row_offset, I* __restrict__ row_nnz)
+    // Store the column indices as offsets C to the base column of their row. Rows whose
+    // span exceeds C are marked by a negative base and keep their full column indices
+    template <typename C, typename I, typename J>
+    __global__ void kernel_csr_column_compress(I nrow,
+                                               const J* __restrict__ row_offset,
+                                               const I* __restrict__ col,
+                                               const I* __restrict__ col_span,
+                                               I* __restrict__ col_base,
+                                               C* __restrict__ col_off)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(ai >= nrow)
+        if(row >= nrow)
         {
             return;
         }
 
-        row_nnz[ai] = row_offset[ai + 1] - row_offset[ai];
-    }
-
-    // Performs a permutation on the vector of non-zero elements per row
-    //
-    // Inputs:   nrow:         number of rows in matrix
-    //           row_nnz_src:  original number of non-zero elements per row
-    //           perm_vec:     permutation vector
-    // Outputs:  row_nnz_dst   permuted number of non-zero elements per row
-    template <typename I, typename J>
-    __global__ void kernel_permute_row_nnz(I nrow,
-                                           const J* __restrict__ row_offset,
-                                           const I* __restrict__ perm_vec,
-                                           J* __restrict__ row_nnz_dst)
-    {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
-
-        if(ai >= nrow)
+        if(col_span[row] >= (static_cast<I>(1) << (8 * sizeof(C))))
         {
+            col_base[row] = -1;
+
             return;
         }
 
-        if(ai == 0)
+        J start = row_offset[row];
+        J end   = row_offset[row + 1];
+        I base  = col_base[row];
+
+        for(J aj = start; aj < end; ++aj)
         {
-            row_nnz_dst[0] = 0;
+            col_off[aj] = static_cast<C>(col[aj] - base);
         }
-
-        row_nnz_dst[perm_vec[ai] + 1] = row_offset[ai + 1] - row_offset[ai];
     }
 
-    // Permutes rows
-    //
-    // Inputs:   nrow:             number of rows in matrix
-    //           row_offset:       original row pointer
-    //           perm_row_offset:  permuted row pointer
-    //           col:              original column indices of elements
-    //           data:             original data vector
-    //           perm_vec:         permutation vector
-    //           row_nnz:          number of non-zero elements per row
-    // Outputs:  perm_col:         permuted column indices of elements
-    //           perm_data:        permuted data vector
-    template <unsigned int WF_SIZE, typename T, typename I, typename J>
-    __global__ void kernel_permute_rows(I nrow,
-                                        const J* __restrict__ row_offset,
-                                        const J* __restrict__ perm_row_offset,
-                                        const I* __restrict__ col,
-                                        const T* __restrict__ data,
-                                        const I* __restrict__ perm_vec,
-                                        I* __restrict__ perm_col,
-                                        T* __restrict__ perm_data)
+    // y = alpha * A * x + beta * y with the column indices of A decoded from the base
+    // column of each row and the offsets C, rows with a negative base read their full
+    // column indices
+    template <unsigned int WFSIZE, typename T, typename C, typename I, typename J>
+    __global__ void kernel_csrmv_compressed_col(I nrow,
+                                                const J* __restrict__ row_offset,
+                                                const I* __restrict__ col,
+                                                const I* __restrict__ col_base,
+                                                const C* __restrict__ col_off,
+                                                const T* __restrict__ val,
+                                                T alpha,
+                                                const T* __restrict__ x,
+                                                T beta,
+                                                T* __restrict__ y)
     {
         I tid = threadIdx.x;
         I gid = blockIdx.x * blockDim.x + tid;
-        I lid = tid & (WF_SIZE - 1);
-        I row = gid / WF_SIZE;
+        I lid = tid & (WFSIZE - 1);
+        I row = gid / WFSIZE;
 
         if(row >= nrow)
         {
             return;
         }
 
-        J perm_index = perm_row_offset[perm_vec[row]];
-        J prev_index = row_offset[row];
-        I num_elems  = row_offset[row + 1] - prev_index;
+        J start = row_offset[row];
+        J end   = row_offset[row + 1];
+        I base  = col_base[row];
 
-        for(I i = lid; i < num_elems; i += WF_SIZE)
+        T sum = static_cast<T>(0);
+
+        if(base >= 0)
         {
-            perm_data[perm_index + i] = data[prev_index + i];
-            perm_col[perm_index + i]  = col[prev_index + i];
+            for(J aj = start + lid; aj < end; aj += WFSIZE)
+            {
+                sum += val[aj] * x[base + static_cast<I>(col_off[aj])];
+            }
+        }
+        else
+        {
+            for(J aj = start + lid; aj < end; aj += WFSIZE)
+            {
+                sum += val[aj] * x[col[aj]];
+            }
+        }
+
+        wf_reduce_sum<WFSIZE>(&sum);
+
+        if(lid == 0)
+        {
+            y[row] = (beta == static_cast<T>(0)) ? alpha * sum : alpha * sum + beta * y[row];
         }
     }
 
-    // Permutes columns
-    //
-    // Inputs:   nrow:             number of rows in matrix
-    //           row_offset:       row pointer
-    //           perm_vec:         permutation vector
-    //           perm_col:         row-permuted column indices of elements
-    //           perm_data:        row-permuted data
-    // Outputs:  col:              fully permuted column indices of elements
-    //           data:             fully permuted data
-    template <unsigned int size, typename T, typename I, typename J>
-    __launch_bounds__(256) __global__ void kernel_permute_cols(I nrow,
-                                                               const J* __restrict__ row_offset,
-                                                               const I* __restrict__ perm_vec,
-                                                               const I* __restrict__ perm_col,
-                                                               const T* __restrict__ perm_data,
-                                                               I* __restrict__ col,
-                                                               T* __restrict__ data)
+    // y = alpha * A * x + beta * z for the rows of A listed in rows only, all other
+    // entries of y are left untouched; z may alias y
+    template <unsigned int WFSIZE, typename T, typename I, typename J>
+    __global__ void kernel_csrmv_rows(I nrows,
+                                      const I* __restrict__ rows,
+                                      const J* __restrict__ row_offset,
+                                      const I* __restrict__ col,
+                                      const T* __restrict__ val,
+                                      T alpha,
+                                      const T* __restrict__ x,
+                                      T        beta,
+                                      const T* z,
+                                      T*       y)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        I tid = threadIdx.x;
+        I gid = blockIdx.x * blockDim.x + tid;
+        I lid = tid & (WFSIZE - 1);
+        I idx = gid / WFSIZE;
 
-        if(ai >= nrow)
+        if(idx >= nrows)
         {
             return;
         }
 
-        J elem_index = row_offset[ai];
-        I num_elems  = row_offset[ai + 1] - elem_index;
+        I row = rows[idx];
 
-        I ccol[size];
-        T cval[size];
+        J start = row_offset[row];
+        J end   = row_offset[row + 1];
 
-        col += elem_index;
-        data += elem_index;
-        perm_col += elem_index;
-        perm_data += elem_index;
+        T sum = static_cast<T>(0);
 
-        for(I i = 0; i < num_elems; ++i)
+        for(J aj = start + lid; aj < end; aj += WFSIZE)
         {
-            ccol[i] = col[i];
-            cval[i] = data[i];
+            sum += val[aj] * x[col[aj]];
         }
 
-        for(I i = 0; i < num_elems; ++i)
+        wf_reduce_sum<WFSIZE>(&sum);
+
+        if(lid == 0)
         {
-            I comp = perm_vec[perm_col[i]];
+            y[row] = (beta == static_cast<T>(0)) ? alpha * sum : alpha * sum + beta * z[row];
+        }
+    }
 
-            I j;
-            for(j = i - 1; j >= 0; --j)
-            {
-                I c = ccol[j];
-                if(c > comp)
-                {
-                    cval[j + 1] = cval[j];
-                    ccol[j + 1] = c;
-                }
-                else
-                {
-                    break;
-                }
-            }
+    // y = alpha * A * x + beta * y for a block of rows of A, whose entries have been staged
+    // to col and val starting at the row offset base
+    template <unsigned int WFSIZE, typename T, typename I, typename J>
+    __global__ void kernel_csrmv_chunk(I nrow,
+                                       const J* __restrict__ row_offset,
+                                       J base,
+                                       const I* __restrict__ col,
+                                       const T* __restrict__ val,
+                                       T alpha,
+                                       const T* __restrict__ x,
+                                       T beta,
+                                       T* __restrict__ y)
+    {
+        I tid = threadIdx.x;
+        I gid = blockIdx.x * blockDim.x + tid;
+        I lid = tid & (WFSIZE - 1);
+        I row = gid / WFSIZE;
 
-            cval[j + 1] = perm_data[i];
-            ccol[j + 1] = comp;
+        if(row >= nrow)
+        {
+            return;
         }
 
-        for(I i = 0; i < num_elems; ++i)
+        J start = row_offset[row] - base;
+        J end   = row_offset[row + 1] - base;
+
+        T sum = static_cast<T>(0);
+
+        for(J aj = start + lid; aj < end; aj += WFSIZE)
         {
-            col[i]  = ccol[i];
-            data[i] = cval[i];
+            sum += val[aj] * x[col[aj]];
+        }
+
+        wf_reduce_sum<WFSIZE>(&sum);
+
+        if(lid == 0)
+        {
+            y[row] = (beta == static_cast<T>(0)) ? alpha * sum : alpha * sum + beta * y[row];
         }
     }
 
-    // Permutes columns
-    //
-    // Inputs:   nrow:             number of rows in matrix
-    //           row_offset:       row pointer
-    //           perm_vec:         permutation vector
-    //           perm_col:         row-permuted column indices of elements
-    //           perm_data:        row-permuted data
-    // Outputs:  col:              fully permuted column indices of elements
-    //           data:             fully permuted data
-    template <typename T, typename I, typename J>
-    __global__ void kernel_permute_cols_fallback(I nrow,
-                                                 const J* __restrict__ row_offset,
-                                                 const I* __restrict__ perm_vec,
-                                                 const I* __restrict__ perm_col,
-                                                 const T* __restrict__ perm_data,
-                                                 I* __restrict__ col,
-                                                 T* __restrict__ data)
+    // Flag the non-empty rows
+    template <typename I, typename J>
+    __global__ void kernel_csr_row_nonempty(I nrow,
+                                            const J* __restrict__ row_offset,
+                                            I* __restrict__ flag)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(ai >= nrow)
+        if(row >= nrow)
         {
             return;
         }
 
-        J elem_index = row_offset[ai];
-        I num_elems  = row_offset[ai + 1] - elem_index;
+        flag[row] = (row_offset[row + 1] > row_offset[row]) ? 1 : 0;
+    }
 
-        col += elem_index;
-        data += elem_index;
-        perm_col += elem_index;
-        perm_data += elem_index;
+    // y = alpha * A * x + y on the non-empty rows of A, which are listed in rows
+    template <unsigned int WFSIZE, typename T, typename I, typename J>
+    __global__ void kernel_csrmv_rowlist(I nrows,
+                                         const I* __restrict__ rows,
+                                         const J* __restrict__ row_offset,
+                                         const I* __restrict__ col,
+                                         const T* __restrict__ val,
+                                         T alpha,
+                                         const T* __restrict__ x,
+                                         T* __restrict__ y)
+    {
+        I tid = threadIdx.x;
+        I gid = blockIdx.x * blockDim.x + tid;
+        I lid = tid & (WFSIZE - 1);
+        I idx = gid / WFSIZE;
 
-        for(I i = 0; i < num_elems; ++i)
+        if(idx >= nrows)
         {
-            I comp = perm_vec[perm_col[i]];
+            return;
+        }
 
-            I j;
-            for(j = i - 1; j >= 0; --j)
-            {
-                I c = col[j];
-                if(c > comp)
-                {
-                    data[j + 1] = data[j];
-                    col[j + 1]  = c;
-                }
-                else
-                {
-                    break;
-                }
-            }
+        I row = rows[idx];
 
-            data[j + 1] = perm_data[i];
-            col[j + 1]  = comp;
+        J start = row_offset[row];
+        J end   = row_offset[row + 1];
+
+        T sum = static_cast<T>(0);
+
+        for(J aj = start + lid; aj < end; aj += WFSIZE)
+        {
+            sum += val[aj] * x[col[aj]];
+        }
+
+        wf_reduce_sum<WFSIZE>(&sum);
+
+        if(lid == 0)
+        {
+            y[row] += alpha * sum;
         }
     }
 
-    // TODO
-    // kind of ugly and inefficient ... but works
     template <typename T, typename I, typename J>
-    __global__ void kernel_csr_add_csr_same_struct(I nrow,
-                                                   const J* __restrict__ out_row_offset,
-                                                   const I* __restrict__ out_col,
-                                                   const J* __restrict__ in_row_offset,
-                                                   const I* __restrict__ in_col,
-                                                   const T* __restrict__ in_val,
-                                                   T alpha,
-                                                   T beta,
-                                                   T* __restrict__ out_val)
+    __global__ void kernel_csr_extract_inv_diag(I nrow,
+                                                const J* __restrict__ row_offset,
+                                                const I* __restrict__ col,
+                                                const T* __restrict__ val,
+                                                T* __restrict__ vec,
+                                                int* __restrict__ detect_zero)
     {
         I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
@@ -528,161 +521,244 @@ namespace rocalution
             return;
         }
 
-        J first_col = in_row_offset[ai];
-
-        for(J ajj = out_row_offset[ai]; ajj < out_row_offset[ai + 1]; ++ajj)
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            for(J aj = first_col; aj < in_row_offset[ai + 1]; ++aj)
+            if(ai == col[aj])
             {
-                if(in_col[aj] == out_col[ajj])
+                if(val[aj] != static_cast<T>(0))
                 {
-                    out_val[ajj] = alpha * out_val[ajj] + beta * in_val[aj];
-                    ++first_col;
-                    break;
+                    vec[ai] = static_cast<T>(1) / val[aj];
+                }
+                else
+                {
+                    vec[ai] = static_cast<T>(1);
+
+                    *detect_zero = 1;
                 }
             }
         }
     }
 
-    // Computes the lower triangular part nnz per row
-    template <typename I, typename J>
-    __global__ void kernel_csr_lower_nnz_per_row(I nrow,
-                                                 const J* __restrict__ src_row_offset,
-                                                 const I* __restrict__ src_col,
-                                                 J* __restrict__ nnz_per_row)
+    // Gather and invert the dense diagonal blocks, one thread per block row. The block is
+    // inverted in place by Gauss-Jordan elimination with partial pivoting.
+    template <unsigned int MAXDIM, typename T, typename I, typename J>
+    __global__ void kernel_csr_extract_inv_block_diag(I nrowb,
+                                                      I blockdim,
+                                                      const J* __restrict__ row_offset,
+                                                      const I* __restrict__ col,
+                                                      const T* __restrict__ val,
+                                                      J* __restrict__ inv_row_offset,
+                                                      I* __restrict__ inv_col,
+                                                      T* __restrict__ inv_val,
+                                                      int* __restrict__ detect_zero)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        I bi = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(ai >= nrow)
+        if(bi >= nrowb)
         {
             return;
         }
 
-        nnz_per_row[ai] = 0;
+        I  r0 = bi * blockdim;
+        T* A  = inv_val + static_cast<int64_t>(r0) * blockdim;
 
-        for(J aj = src_row_offset[ai]; aj < src_row_offset[ai + 1]; ++aj)
+        if(bi == 0)
         {
-            if(src_col[aj] <= ai)
+            inv_row_offset[0] = 0;
+        }
+
+        for(I i = 0; i < blockdim; ++i)
+        {
+            I ai = r0 + i;
+
+            inv_row_offset[ai + 1] = static_cast<J>(ai + 1) * blockdim;
+
+            for(I j = 0; j < blockdim; ++j)
             {
-                ++nnz_per_row[ai];
+                inv_col[static_cast<int64_t>(ai) * blockdim + j] = r0 + j;
+                A[i * blockdim + j]                                = static_cast<T>(0);
+            }
+
+            for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+            {
+                I j = col[aj] - r0;
+
+                if(j >= 0 && j < blockdim)
+                {
+                    A[i * blockdim + j] = val[aj];
+                }
             }
         }
-    }
 
-    // Computes the upper triangular part nnz per row
-    template <typename I, typename J>
-    __global__ void kernel_csr_upper_nnz_per_row(I nrow,
-                                                 const J* __restrict__ src_row_offset,
-                                                 const I* __restrict__ src_col,
-                                                 J* __restrict__ nnz_per_row)
-    {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        I pivot[MAXDIM];
 
-        if(ai >= nrow)
+        for(I k = 0; k < blockdim; ++k)
         {
-            return;
-        }
+            I p = k;
 
-        nnz_per_row[ai] = 0;
+            for(I i = k + 1; i < blockdim; ++i)
+            {
+                if(hip_abs(A[i * blockdim + k]) > hip_abs(A[p * blockdim + k]))
+                {
+                    p = i;
+                }
+            }
 
-        for(J aj = src_row_offset[ai]; aj < src_row_offset[ai + 1]; ++aj)
+            pivot[k] = p;
+
+            if(p != k)
+            {
+                for(I j = 0; j < blockdim; ++j)
+                {
+                    T tmp               = A[k * blockdim + j];
+                    A[k * blockdim + j] = A[p * blockdim + j];
+                    A[p * blockdim + j] = tmp;
+                }
+            }
+
+            if(A[k * blockdim + k] == static_cast<T>(0))
+            {
+                A[k * blockdim + k] = static_cast<T>(1);
+                *detect_zero        = 1;
+            }
+
+            T d                 = static_cast<T>(1) / A[k * blockdim + k];
+            A[k * blockdim + k] = static_cast<T>(1);
+
+            for(I j = 0; j < blockdim; ++j)
+            {
+                A[k * blockdim + j] *= d;
+            }
+
+            for(I i = 0; i < blockdim; ++i)
+            {
+                if(i != k)
+                {
+                    T f                 = A[i * blockdim + k];
+                    A[i * blockdim + k] = static_cast<T>(0);
+
+                    for(I j = 0; j < blockdim; ++j)
+                    {
+                        A[i * blockdim + j] -= f * A[k * blockdim + j];
+                    }
+                }
+            }
+        }
+
+        for(I k = blockdim - 1; k >= 0; --k)
         {
-            if(src_col[aj] >= ai)
+            if(pivot[k] != k)
             {
-                ++nnz_per_row[ai];
+                for(I i = 0; i < blockdim; ++i)
+                {
+                    T tmp                      = A[i * blockdim + k];
+                    A[i * blockdim + k]        = A[i * blockdim + pivot[k]];
+                    A[i * blockdim + pivot[k]] = tmp;
+                }
             }
         }
     }
 
-    // Computes the stricktly lower triangular part nnz per row
-    template <typename I, typename J>
-    __global__ void kernel_csr_slower_nnz_per_row(I nrow,
-                                                  const J* __restrict__ src_row_offset,
-                                                  const I* __restrict__ src_col,
-                                                  J* __restrict__ nnz_per_row)
+    template <typename T, typename I, typename J>
+    __launch_bounds__(256) __global__ void kernel_csr_update_values_perm(J size,
+                                                                         J offset,
+                                                                         J nnz,
+                                                                         const I* __restrict__ perm,
+                                                                         const T* __restrict__ in,
+                                                                         T* __restrict__ val)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        J k = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(ai >= nrow)
+        if(k >= size)
         {
             return;
         }
 
-        nnz_per_row[ai] = 0;
+        J idx = perm[k] - offset;
 
-        for(J aj = src_row_offset[ai]; aj < src_row_offset[ai + 1]; ++aj)
+        if(idx >= 0 && idx < nnz)
         {
-            if(src_col[aj] < ai)
-            {
-                ++nnz_per_row[ai];
-            }
+            val[idx] = in[k];
         }
     }
 
-    // Computes the stricktly upper triangular part nnz per row
-    template <typename I, typename J>
-    __global__ void kernel_csr_supper_nnz_per_row(I nrow,
-                                                  const J* __restrict__ src_row_offset,
-                                                  const I* __restrict__ src_col,
-                                                  J* __restrict__ nnz_per_row)
+    // Symmetric matrix-vector product y = y + scalar * A * x, where only the upper
+    // triangle and the diagonal of A are stored. WFSIZE threads process a row and
+    // scatter the mirrored entries of the strictly upper triangle atomically.
+    template <unsigned int BLOCKSIZE, unsigned int WFSIZE, typename T, typename I, typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_symmetric_spmv(I nrow,
+                                       const J* __restrict__ row_offset,
+                                       const I* __restrict__ col,
+                                       const T* __restrict__ val,
+                                       T scalar,
+                                       const T* __restrict__ x,
+                                       T* __restrict__ y)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        unsigned int lid = threadIdx.x & (WFSIZE - 1);
+        int64_t      row = (static_cast<int64_t>(blockIdx.x) * BLOCKSIZE + threadIdx.x) / WFSIZE;
 
-        if(ai >= nrow)
+        // All threads of a row leave together
+        if(row >= nrow)
         {
             return;
         }
 
-        nnz_per_row[ai] = 0;
+        T xi  = scalar * x[row];
+        T sum = static_cast<T>(0);
 
-        for(J aj = src_row_offset[ai]; aj < src_row_offset[ai + 1]; ++aj)
+        for(J j = row_offset[row] + lid; j < row_offset[row + 1]; j += WFSIZE)
         {
-            if(src_col[aj] > ai)
+            I c = col[j];
+            T v = val[j];
+
+            sum += v * x[c];
+
+            if(c != row)
             {
-                ++nnz_per_row[ai];
+                atomicAdd(&y[c], v * xi);
             }
         }
+
+        wf_reduce_sum<WFSIZE>(&sum);
+
+        if(lid == 0)
+        {
+            atomicAdd(&y[row], scalar * sum);
+        }
     }
 
-    // Extracts lower triangular part for given nnz per row array (partial sums nnz)
     template <typename T, typename I, typename J>
-    __global__ void kernel_csr_extract_l_triangular(I nrow,
-                                                    const J* __restrict__ src_row_offset,
-                                                    const I* __restrict__ src_col,
-                                                    const T* __restrict__ src_val,
-                                                    J* __restrict__ nnz_per_row,
-                                                    I* __restrict__ dst_col,
-                                                    T* __restrict__ dst_val)
+    __launch_bounds__(256) __global__ void kernel_csr_assemble_values(J nnz,
+                                                                      const I* __restrict__ offset,
+                                                                      const I* __restrict__ perm,
+                                                                      const T* __restrict__ in,
+                                                                      T* __restrict__ val)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        J j = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(ai >= nrow)
+        if(j >= nnz)
         {
             return;
         }
 
-        J dst_index = nnz_per_row[ai];
-        J src_index = src_row_offset[ai];
+        T sum = static_cast<T>(0);
 
-        for(J aj = 0; aj < nnz_per_row[ai + 1] - nnz_per_row[ai]; ++aj)
+        for(I k = offset[j]; k < offset[j + 1]; ++k)
         {
-            dst_col[dst_index] = src_col[src_index];
-            dst_val[dst_index] = src_val[src_index];
-
-            ++dst_index;
-            ++src_index;
+            sum += in[perm[k]];
         }
+
+        val[j] = sum;
     }
 
-    // Extracts upper triangular part for given nnz per row array (partial sums nnz)
-    template <typename T, typename I, typename J>
-    __global__ void kernel_csr_extract_u_triangular(I nrow,
-                                                    const J* __restrict__ src_row_offset,
-                                                    const I* __restrict__ src_col,
-                                                    const T* __restrict__ src_val,
-                                                    J* __restrict__ nnz_per_row,
-                                                    I* __restrict__ dst_col,
-                                                    T* __restrict__ dst_val)
+    // Flag all rows with an entry in one of the flagged columns
+    template <typename I, typename J>
+    __global__ void kernel_csr_extract_connected_rows(I nrow,
+                                                      const J* __restrict__ row_offset,
+                                                      const I* __restrict__ col,
+                                                      const bool* __restrict__ cols,
+                                                      bool* __restrict__ rows)
     {
         I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
@@ -691,28 +767,36 @@ namespace rocalution
             return;
         }
 
-        I num_elements = nnz_per_row[ai + 1] - nnz_per_row[ai];
-        J src_index    = src_row_offset[ai + 1] - num_elements;
-        J dst_index    = nnz_per_row[ai];
+        bool connected = false;
 
-        for(I aj = 0; aj < num_elements; ++aj)
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            dst_col[dst_index] = src_col[src_index];
-            dst_val[dst_index] = src_val[src_index];
-
-            ++dst_index;
-            ++src_index;
+            if(cols[col[aj]] == true)
+            {
+                connected = true;
+                break;
+            }
         }
+
+        rows[ai] = connected;
+    }
+
+    // splitmix64 finalizer, kept identical to the host version in host_matrix_csr.cpp
+    __device__ __forceinline__ uint64_t hash_mix(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+
+        return x ^ (x >> 31);
     }
 
-    // Compress
     template <typename T, typename I, typename J>
-    __global__ void kernel_csr_compress_count_nrow(const J* __restrict__ row_offset,
-                                                   const I* __restrict__ col,
-                                                   const T* __restrict__ val,
-                                                   I      nrow,
-                                                   double drop_off,
-                                                   I* __restrict__ row_offset_new)
+    __global__ void kernel_csr_hash(I nrow,
+                                    const J* __restrict__ row_offset,
+                                    const I* __restrict__ col,
+                                    const T* __restrict__ val,
+                                    unsigned long long* __restrict__ row_hash)
     {
         I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
@@ -721,25 +805,33 @@ namespace rocalution
             return;
         }
 
+        const int nword = sizeof(T) / sizeof(uint32_t);
+
+        unsigned long long sum = 0;
+
         for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            if((hip_abs(val[aj]) > drop_off) || (col[aj] == ai))
+            const uint32_t* bits = reinterpret_cast<const uint32_t*>(&val[aj]);
+
+            uint64_t h
+                = hash_mix((static_cast<uint64_t>(ai) << 32) | static_cast<uint32_t>(col[aj]));
+
+            for(int w = 0; w < nword; ++w)
             {
-                ++row_offset_new[ai];
+                h = hash_mix(h ^ bits[w]);
             }
+
+            sum += h;
         }
+
+        row_hash[ai] = sum;
     }
 
-    // Compress
     template <typename T, typename I, typename J>
-    __global__ void kernel_csr_compress_copy(const J* __restrict__ row_offset,
-                                             const I* __restrict__ col,
-                                             const T* __restrict__ val,
-                                             I      nrow,
-                                             double drop_off,
-                                             const J* __restrict__ row_offset_new,
-                                             I* __restrict__ col_new,
-                                             T* __restrict__ val_new)
+    __global__ void kernel_csr_extract_row_l1_norm(I nrow,
+                                                   const J* __restrict__ row_offset,
+                                                   const T* __restrict__ val,
+                                                   T* __restrict__ vec)
     {
         I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
@@ -748,27 +840,44 @@ namespace rocalution
             return;
         }
 
-        J ajj = row_offset_new[ai];
+        T sum = static_cast<T>(0);
 
         for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            if((hip_abs(val[aj]) > drop_off) || (col[aj] == ai))
-            {
-                col_new[ajj] = col[aj];
-                val_new[ajj] = val[aj];
-                ++ajj;
-            }
+            sum += hip_abs(val[aj]);
         }
+
+        vec[ai] = sum;
     }
 
-    // Extract column vector
+    // Combines the statistics of two ranges of rows
+    struct csr_statistics_merge
+    {
+        __device__ __host__ csr_statistics_t operator()(const csr_statistics_t& a,
+                                                        const csr_statistics_t& b) const
+        {
+            csr_statistics_t c;
+
+            c.min_row    = min(a.min_row, b.min_row);
+            c.max_row    = max(a.max_row, b.max_row);
+            c.sum_row2   = a.sum_row2 + b.sum_row2;
+            c.bandwidth  = max(a.bandwidth, b.bandwidth);
+            c.profile    = a.profile + b.profile;
+            c.dominant   = a.dominant + b.dominant;
+            c.asymmetric = a.asymmetric + b.asymmetric;
+
+            return c;
+        }
+    };
+
+    // One thread per row, a_ji is searched in the (sorted) row j for the symmetry check
     template <typename T, typename I, typename J>
-    __global__ void kernel_csr_extract_column_vector(const J* __restrict__ row_offset,
-                                                     const I* __restrict__ col,
-                                                     const T* __restrict__ val,
-                                                     I nrow,
-                                                     I idx,
-                                                     T* __restrict__ vec)
+    __global__ void kernel_csr_statistics(I nrow,
+                                          I ncol,
+                                          const J* __restrict__ row_offset,
+                                          const I* __restrict__ col,
+                                          const T* __restrict__ val,
+                                          csr_statistics_t* __restrict__ stats)
     {
         I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
@@ -777,2949 +886,5558 @@ namespace rocalution
             return;
         }
 
-        vec[ai] = static_cast<T>(0);
+        J       row_begin = row_offset[ai];
+        J       row_end   = row_offset[ai + 1];
+        int64_t length    = row_end - row_begin;
 
-        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        csr_statistics_t s;
+
+        s.min_row    = length;
+        s.max_row    = length;
+        s.sum_row2   = length * length;
+        s.bandwidth  = 0;
+        s.profile    = 0;
+        s.dominant   = 0;
+        s.asymmetric = (nrow == ncol) ? 0 : 1;
+
+        if(length > 0)
         {
-            if(idx == col[aj])
+            I first = col[row_begin];
+            I last  = col[row_end - 1];
+
+            s.bandwidth = max(ai - first, last - ai);
+            s.profile   = max(ai - first, 0);
+
+            double diag    = 0.0;
+            double offdiag = 0.0;
+
+            for(J aj = row_begin; aj < row_end; ++aj)
             {
-                vec[ai] = val[aj];
+                I cj = col[aj];
+
+                if(cj == ai)
+                {
+                    diag += hip_abs(val[aj]);
+                }
+                else
+                {
+                    offdiag += hip_abs(val[aj]);
+                }
+
+                if(nrow == ncol)
+                {
+                    // Binary search of column ai in row cj
+                    J lo = row_offset[cj];
+                    J hi = row_offset[cj + 1];
+
+                    while(lo < hi)
+                    {
+                        J mid = lo + (hi - lo) / 2;
+
+                        if(col[mid] < ai)
+                        {
+                            lo = mid + 1;
+                        }
+                        else
+                        {
+                            hi = mid;
+                        }
+                    }
+
+                    if(lo == row_offset[cj + 1] || col[lo] != ai || val[lo] != val[aj])
+                    {
+                        ++s.asymmetric;
+                    }
+                }
             }
+
+            s.dominant = (diag >= offdiag) ? 1 : 0;
         }
+
+        stats[ai] = s;
     }
 
-    // Replace column vector - compute new offset
     template <typename T, typename I, typename J>
-    __global__ void kernel_csr_replace_column_vector_offset(const J* __restrict__ row_offset,
-                                                            const I* __restrict__ col,
-                                                            I nrow,
-                                                            I idx,
-                                                            const T* __restrict__ vec,
-                                                            J* __restrict__ offset)
+    __global__ void kernel_csr_extract_submatrix_row_nnz(const J* __restrict__ row_offset,
+                                                         const I* __restrict__ col,
+                                                         const T* __restrict__ val,
+                                                         I smrow_offset,
+                                                         I smcol_offset,
+                                                         I smrow_size,
+                                                         I smcol_size,
+                                                         J* __restrict__ row_nnz)
     {
         I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(ai >= nrow)
+        if(ai >= smrow_size)
         {
             return;
         }
 
-        bool add = true;
-        I    val = row_offset[ai + 1] - row_offset[ai];
+        I nnz = 0;
+        I ind = ai + smrow_offset;
 
-        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        for(J aj = row_offset[ind]; aj < row_offset[ind + 1]; ++aj)
         {
-            if(col[aj] == idx)
+            I c = col[aj];
+
+            if((c >= smcol_offset) && (c < smcol_offset + smcol_size))
             {
-                add = false;
-                break;
+                ++nnz;
             }
         }
 
-        if(add == true && hip_abs(vec[ai]) != 0.0)
-        {
-            ++val;
-        }
-
-        if(add == false && hip_abs(vec[ai]) == 0.0)
-        {
-            --val;
-        }
-
-        offset[ai] = val;
+        row_nnz[ai] = nnz;
     }
 
-    // Replace column vector - compute new offset
     template <typename T, typename I, typename J>
-    __global__ void kernel_csr_replace_column_vector(const J* __restrict__ row_offset,
-                                                     const I* __restrict__ col,
-                                                     const T* __restrict__ val,
-                                                     I nrow,
-                                                     I idx,
-                                                     const T* __restrict__ vec,
-                                                     const J* __restrict__ offset,
-                                                     I* __restrict__ new_col,
-                                                     T* __restrict__ new_val)
+    __global__ void kernel_csr_extract_submatrix_copy(const J* __restrict__ row_offset,
+                                                      const I* __restrict__ col,
+                                                      const T* __restrict__ val,
+                                                      I smrow_offset,
+                                                      I smcol_offset,
+                                                      I smrow_size,
+                                                      I smcol_size,
+                                                      const J* __restrict__ sm_row_offset,
+                                                      I* __restrict__ sm_col,
+                                                      T* __restrict__ sm_val)
     {
         I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(ai >= nrow)
+        if(ai >= smrow_size)
         {
             return;
         }
 
-        J aj = row_offset[ai];
-        J k  = offset[ai];
+        J row_nnz = sm_row_offset[ai];
+        I ind     = ai + smrow_offset;
 
-        for(; aj < row_offset[ai + 1]; ++aj)
+        for(J aj = row_offset[ind]; aj < row_offset[ind + 1]; ++aj)
         {
-            if(col[aj] < idx)
+            I c = col[aj];
+
+            if((c >= smcol_offset) && (c < smcol_offset + smcol_size))
             {
-                new_col[k] = col[aj];
-                new_val[k] = val[aj];
-                ++k;
+                sm_col[row_nnz] = c - smcol_offset;
+                sm_val[row_nnz] = val[aj];
+                ++row_nnz;
+            }
+        }
+    }
+
+    // Find the block that contains index i, offset holds num_blocks + 1 entries
+    template <typename I>
+    __device__ __forceinline__ I csr_find_block(I i, I num_blocks, const I* __restrict__ offset)
+    {
+        I left  = 0;
+        I right = num_blocks;
+
+        while(right - left > 1)
+        {
+            I mid = (left + right) >> 1;
+
+            if(offset[mid] <= i)
+            {
+                left = mid;
             }
             else
             {
-                break;
+                right = mid;
             }
         }
 
-        if(hip_abs(vec[ai]) != 0.0)
+        return left;
+    }
+
+    // Count the entries of each row per column block, count is stored column block major
+    template <typename I, typename J>
+    __global__ void kernel_csr_extract_submatrices_nnz(I nrow,
+                                                       I row_begin,
+                                                       I col_num_blocks,
+                                                       const J* __restrict__ row_offset,
+                                                       const I* __restrict__ col,
+                                                       const I* __restrict__ col_block_offset,
+                                                       J* __restrict__ count)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
-            new_col[k] = idx;
-            new_val[k] = vec[ai];
-            ++k;
-            ++aj;
+            return;
         }
 
-        for(; aj < row_offset[ai + 1]; ++aj)
+        J row_begin_nnz = row_offset[ai + row_begin];
+        J row_end_nnz   = row_offset[ai + row_begin + 1];
+
+        for(I bj = 0; bj < col_num_blocks; ++bj)
         {
-            if(col[aj] > idx)
+            I c_begin = col_block_offset[bj];
+            I c_end   = col_block_offset[bj + 1];
+
+            J nnz = 0;
+
+            for(J aj = row_begin_nnz; aj < row_end_nnz; ++aj)
             {
-                new_col[k] = col[aj];
-                new_val[k] = val[aj];
-                ++k;
+                I c = col[aj];
+
+                if(c >= c_begin && c < c_end)
+                {
+                    ++nnz;
+                }
             }
+
+            count[bj * nrow + ai] = nnz;
         }
     }
 
-    // Extract row vector
-    template <typename T, typename I, typename J>
-    __global__ void kernel_csr_extract_row_vector(const J* __restrict__ row_offset,
-                                                  const I* __restrict__ col,
-                                                  const T* __restrict__ val,
-                                                  I row_nnz,
-                                                  I idx,
-                                                  T* __restrict__ vec)
+    // Gather the first position of each block from the scanned counts
+    template <typename I, typename J>
+    __global__ void kernel_csr_extract_submatrices_bounds(I nrow,
+                                                          I row_num_blocks,
+                                                          I col_num_blocks,
+                                                          const I* __restrict__ row_block_offset,
+                                                          const J* __restrict__ scan,
+                                                          J* __restrict__ bounds)
     {
-        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+        I idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(ai >= row_nnz)
+        if(idx >= (row_num_blocks + 1) * col_num_blocks)
         {
             return;
         }
 
-        J aj         = row_offset[idx] + ai;
-        vec[col[aj]] = val[aj];
+        I bi = idx / col_num_blocks;
+        I bj = idx % col_num_blocks;
+
+        bounds[idx] = scan[bj * nrow + row_block_offset[bi] - row_block_offset[0]];
     }
 
-    template <typename I, typename J>
-    __global__ void kernel_csr_boundary_nnz(I       boundary_size,
-                                            int64_t nnz,
-                                            const I* __restrict__ boundary_index,
-                                            const J* __restrict__ csr_row_ptr,
-                                            const I* __restrict__ csr_col_ind,
-                                            const J* __restrict__ ghost_csr_row_ptr,
-                                            const I* __restrict__ ghost_csr_col_ind,
-                                            const bool* __restrict__ connections,
-                                            J* __restrict__ row_nnz)
+    // Fill all sub-matrices, each thread processes one row of the source matrix
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_extract_submatrices_fill(I nrow,
+                                                        I row_num_blocks,
+                                                        I col_num_blocks,
+                                                        const J* __restrict__ row_offset,
+                                                        const I* __restrict__ col,
+                                                        const T* __restrict__ val,
+                                                        const I* __restrict__ row_block_offset,
+                                                        const I* __restrict__ col_block_offset,
+                                                        const J* __restrict__ scan,
+                                                        const J* __restrict__ bounds,
+                                                        void* const* __restrict__ sm_ptr)
     {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(gid >= boundary_size)
+        if(ai >= nrow)
         {
             return;
         }
 
-        // This row is a boundary row
-        I row = boundary_index[gid];
+        I row = ai + row_block_offset[0];
+        I bi  = csr_find_block(row, row_num_blocks, row_block_offset);
+        I lr  = row - row_block_offset[bi];
 
-        J ext_nnz = 0;
+        bool last = (row + 1 == row_block_offset[bi + 1]);
 
-        // Extract interior part
-        J row_begin = csr_row_ptr[row];
-        J row_end   = csr_row_ptr[row + 1];
+        J row_begin_nnz = row_offset[row];
+        J row_end_nnz   = row_offset[row + 1];
 
-        // Interior
-        for(J j = row_begin; j < row_end; ++j)
+        I nblocks = row_num_blocks * col_num_blocks;
+
+        for(I bj = 0; bj < col_num_blocks; ++bj)
         {
-            // Check whether this vertex is strongly connected
-            if(connections[j] == true)
+            I blk  = bi * col_num_blocks + bj;
+            J base = bounds[blk];
+            J pos  = scan[bj * nrow + ai] - base;
+
+            // The pointer table holds row offsets, columns and values of all blocks
+            J* sm_row_offset = static_cast<J*>(sm_ptr[blk]);
+            I* sm_col        = static_cast<I*>(sm_ptr[nblocks + blk]);
+            T* sm_val        = static_cast<T*>(sm_ptr[2 * nblocks + blk]);
+
+            sm_row_offset[lr] = pos;
+
+            if(last == true)
             {
-                ++ext_nnz;
+                sm_row_offset[lr + 1] = scan[bj * nrow + ai + 1] - base;
             }
-        }
 
-        // Ghost part
-        J gst_row_begin = ghost_csr_row_ptr[row];
-        J gst_row_end   = ghost_csr_row_ptr[row + 1];
+            I c_begin = col_block_offset[bj];
+            I c_end   = col_block_offset[bj + 1];
 
-        for(J j = gst_row_begin; j < gst_row_end; ++j)
-        {
-            // Check whether this vertex is strongly connected
-            if(connections[j + nnz] == true)
+            for(J aj = row_begin_nnz; aj < row_end_nnz; ++aj)
             {
-                ++ext_nnz;
+                I c = col[aj];
+
+                if(c >= c_begin && c < c_end)
+                {
+                    sm_col[pos] = c - c_begin;
+                    sm_val[pos] = val[aj];
+                    ++pos;
+                }
             }
         }
-
-        // Write total number of strongly connected coarse vertices to global memory
-        row_nnz[gid] = ext_nnz;
     }
 
+    // Mark all rows that hold a diagonal entry
     template <typename I, typename J>
-    __global__ void kernel_csr_extract_boundary(I       boundary_size,
-                                                int64_t nnz,
-                                                int64_t global_column_begin,
-                                                const I* __restrict__ boundary_index,
-                                                const J* __restrict__ csr_row_ptr,
-                                                const I* __restrict__ csr_col_ind,
-                                                const J* __restrict__ ghost_csr_row_ptr,
-                                                const I* __restrict__ ghost_csr_col_ind,
-                                                const bool* __restrict__ connections,
-                                                const int64_t* __restrict__ l2g,
-                                                const J* __restrict__ bnd_row_ptr,
-                                                int64_t* __restrict__ bnd_col_ind)
+    __global__ void kernel_csr_zero_block_mark(I nrow,
+                                               const J* __restrict__ row_offset,
+                                               const I* __restrict__ col,
+                                               I* __restrict__ hit)
     {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(gid >= boundary_size)
+        if(ai >= nrow)
         {
             return;
         }
 
-        // This row is a boundary row
-        I row = boundary_index[gid];
-
-        // Index into boundary array
-        J idx = bnd_row_ptr[gid];
-
-        // Extract interior part
-        J row_begin = csr_row_ptr[row];
-        J row_end   = csr_row_ptr[row + 1];
+        I h = 0;
 
-        // Interior
-        for(J j = row_begin; j < row_end; ++j)
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            if(connections[j] == true)
+            if(col[aj] == ai)
             {
-                // Get column index
-                I col = csr_col_ind[j];
-
-                // Shift column by global column offset, to obtain the global column index
-                bnd_col_ind[idx++] = col + global_column_begin;
+                h = 1;
+                break;
             }
         }
 
-        // Extract ghost part
-        J gst_row_begin = ghost_csr_row_ptr[row];
-        J gst_row_end   = ghost_csr_row_ptr[row + 1];
+        hit[ai] = h;
+    }
 
-        for(J j = gst_row_begin; j < gst_row_end; ++j)
-        {
-            // Check whether this vertex is strongly connected
-            if(connections[j + nnz] == true)
-            {
-                // Get column index
-                I col = ghost_csr_col_ind[j];
+    // Rows with a diagonal entry go first, all others are moved to the last block
+    template <typename I>
+    __global__ void kernel_csr_zero_block_permutation(I nrow,
+                                                      I size,
+                                                      const I* __restrict__ hit,
+                                                      const I* __restrict__ scan,
+                                                      I* __restrict__ perm)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-                // Transform local ghost index into global column index
-                bnd_col_ind[idx++] = l2g[col];
-            }
+        if(ai >= nrow)
+        {
+            return;
         }
+
+        perm[ai] = (hit[ai] == 1) ? scan[ai] : size + ai - scan[ai];
     }
 
-    __device__ __forceinline__ mis_tuple lexographical_max(mis_tuple* ti, mis_tuple* tj)
+    // Luby maximal independent set, state is -1 (undecided), 2 (selected in the
+    // current round), 1 (in the set) or 0 (excluded)
+    __device__ __forceinline__ bool mis_priority_greater(int64_t i, int64_t j)
     {
-        // find lexographical maximum
-        if(tj->s > ti->s)
+        uint64_t pi = hash_mix(static_cast<uint64_t>(i));
+        uint64_t pj = hash_mix(static_cast<uint64_t>(j));
+
+        return (pi > pj) || (pi == pj && i > j);
+    }
+
+    // Select all undecided rows with the highest priority among their undecided neighbors
+    template <typename I, typename J>
+    __global__ void kernel_csr_mis_select(I nrow,
+                                          const J* __restrict__ row_offset,
+                                          const I* __restrict__ col,
+                                          int* __restrict__ state)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow || state[ai] != -1)
         {
-            return *tj;
+            return;
         }
-        else if(tj->s == ti->s)
+
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            if(tj->v > ti->v)
+            I c = col[aj];
+
+            if(c != ai && (state[c] == -1 || state[c] == 2) && mis_priority_greater(c, ai))
             {
-                return *tj;
+                return;
             }
         }
 
-        return *ti;
+        state[ai] = 2;
     }
 
-    // Note: Remove in next major release
-    template <unsigned int WF_SIZE, typename T, typename I, typename J>
-    __global__ void kernel_csr_amg_connect(I nrow,
-                                           T eps2,
-                                           const J* __restrict__ row_offset,
-                                           const I* __restrict__ col,
-                                           const T* __restrict__ val,
-                                           const T* __restrict__ diag,
-                                           I* __restrict__ connections)
+    // Exclude all undecided neighbors of the selected rows
+    template <typename I, typename J>
+    __global__ void kernel_csr_mis_update(I nrow,
+                                          const J* __restrict__ row_offset,
+                                          const I* __restrict__ col,
+                                          int* __restrict__ state,
+                                          int* __restrict__ undecided)
     {
-        I tid = threadIdx.x;
-        I gid = blockIdx.x * blockDim.x + tid;
-        I lid = tid & (WF_SIZE - 1);
-        I row = gid / WF_SIZE;
-        if(row >= nrow)
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
             return;
         }
 
-        T eps_diag_r = eps2 * diag[row];
+        int s = state[ai];
 
-        J start = row_offset[row];
-        J end   = row_offset[row + 1];
+        if(s == 2)
+        {
+            state[ai] = 1;
+            return;
+        }
 
-        for(J i = start + lid; i < end; i += WF_SIZE)
+        if(s != -1)
         {
-            I c = col[i];
-            T v = val[i];
+            return;
+        }
 
-            connections[i] = (c != row) && (hip_real(v * v) > hip_real(eps_diag_r * diag[c]));
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            I c = col[aj];
+
+            if(c != ai && (state[c] == 1 || state[c] == 2))
+            {
+                state[ai] = 0;
+                return;
+            }
         }
-    }
 
-    // Note: Remove in next major release
-    __device__ __forceinline__ unsigned int hash(unsigned int x)
-    {
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = (x >> 16) ^ x;
-        return x;
+        *undecided = 1;
     }
 
-    // Note: Remove in next major release
-    template <typename I, typename J>
-    __global__ void kernel_csr_amg_init_mis_tuples(I nrow,
-                                                   const J* __restrict__ row_offset,
-                                                   const I* __restrict__ connections,
-                                                   mis_tuple* __restrict__ tuples)
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_diagmatmult_r(I nrow,
+                                             const J* __restrict__ row_offset,
+                                             const I* __restrict__ col,
+                                             const T* __restrict__ diag,
+                                             T* __restrict__ val)
     {
-        I row = blockIdx.x * blockDim.x + threadIdx.x;
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(row >= nrow)
+        if(ai >= nrow)
         {
             return;
         }
 
-        I state = -2;
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            val[aj] = val[aj] * diag[col[aj]];
+        }
+    }
 
-        J row_start = row_offset[row];
-        J row_end   = row_offset[row + 1];
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_diagmatmult_l(I nrow,
+                                             const J* __restrict__ row_offset,
+                                             const T* __restrict__ diag,
+                                             T* __restrict__ val)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        for(J j = row_start; j < row_end; j++)
+        if(ai >= nrow)
         {
-            if(connections[j] == 1)
-            {
-                state = 0;
-                break;
-            }
+            return;
         }
 
-        tuples[row].s = state;
-        tuples[row].v = hash(row);
-        tuples[row].i = row;
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            val[aj] = val[aj] * diag[ai];
+        }
     }
 
-    // Note: Remove in next major release
-    template <unsigned int BLOCKSIZE, unsigned int WFSIZE, typename I, typename J>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_amg_find_max_mis_tuples_shared(I nrow,
-                                                       const J* __restrict__ row_offset,
-                                                       const I* __restrict__ cols,
-                                                       const I* __restrict__ connections,
-                                                       const mis_tuple* __restrict__ tuples,
-                                                       mis_tuple* __restrict__ max_tuples,
-                                                       bool* done)
+    // Calculates the number of non-zero elements per row
+    template <typename I, typename J>
+    __global__ void
+        kernel_calc_row_nnz(I nrow, const J* __restrict__ row_offset, I* __restrict__ row_nnz)
     {
-        I                    tid = threadIdx.x;
-        I                    gid = blockIdx.x * BLOCKSIZE + tid;
-        I                    lid = tid & (WFSIZE - 1);
-        I                    wid = tid / WFSIZE;
-        I                    row = gid / WFSIZE;
-        __shared__ mis_tuple smax_tuple[BLOCKSIZE];
-        if(row >= nrow)
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
             return;
         }
 
-        smax_tuple[WFSIZE * wid] = max_tuples[row];
+        row_nnz[ai] = row_offset[ai + 1] - row_offset[ai];
+    }
 
-        __syncthreads();
+    // Performs a permutation on the vector of non-zero elements per row
+    //
+    // Inputs:   nrow:         number of rows in matrix
+    //           row_nnz_src:  original number of non-zero elements per row
+    //           perm_vec:     permutation vector
+    // Outputs:  row_nnz_dst   permuted number of non-zero elements per row
+    template <typename I, typename J>
+    __global__ void kernel_permute_row_nnz(I nrow,
+                                           const J* __restrict__ row_offset,
+                                           const I* __restrict__ perm_vec,
+                                           J* __restrict__ row_nnz_dst)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        for(I k = 0; k < 2; k++)
+        if(ai >= nrow)
         {
-            mis_tuple t_max = smax_tuple[WFSIZE * wid];
+            return;
+        }
 
-            J row_start = row_offset[t_max.i];
-            J row_end   = row_offset[t_max.i + 1];
+        if(ai == 0)
+        {
+            row_nnz_dst[0] = 0;
+        }
 
-            for(J j = row_start + lid; j < row_end; j += WFSIZE)
-            {
-                if(connections[j] == 1)
-                {
-                    I         col = cols[j];
-                    mis_tuple tj  = tuples[col];
-
-                    t_max = lexographical_max(&tj, &t_max);
-                }
-            }
-
-            smax_tuple[WFSIZE * wid + lid] = t_max;
-
-            __syncthreads();
-
-            // Finish reducing the intra block lexographical max
-            if(WFSIZE >= 64)
-            {
-                if(lid < 32)
-                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 32]);
-                __threadfence_block();
-            }
-            if(WFSIZE >= 32)
-            {
-                if(lid < 16)
-                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 16]);
-                __threadfence_block();
-            }
-            if(WFSIZE >= 16)
-            {
-                if(lid < 8)
-                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 8]);
-                __threadfence_block();
-            }
-            if(WFSIZE >= 8)
-            {
-                if(lid < 4)
-                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 4]);
-                __threadfence_block();
-            }
-            if(WFSIZE >= 4)
-            {
-                if(lid < 2)
-                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 2]);
-                __threadfence_block();
-            }
-            if(WFSIZE >= 2)
-            {
-                if(lid < 1)
-                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 1]);
-                __threadfence_block();
-            }
+        row_nnz_dst[perm_vec[ai] + 1] = row_offset[ai + 1] - row_offset[ai];
+    }
 
-            __syncthreads();
-        }
+    // Permutes rows
+    //
+    // Inputs:   nrow:             number of rows in matrix
+    //           row_offset:       original row pointer
+    //           perm_row_offset:  permuted row pointer
+    //           col:              original column indices of elements
+    //           data:             original data vector
+    //           perm_vec:         permutation vector
+    //           row_nnz:          number of non-zero elements per row
+    // Outputs:  perm_col:         permuted column indices of elements
+    //           perm_data:        permuted data vector
+    template <unsigned int WF_SIZE, typename T, typename I, typename J>
+    __global__ void kernel_permute_rows(I nrow,
+                                        const J* __restrict__ row_offset,
+                                        const J* __restrict__ perm_row_offset,
+                                        const I* __restrict__ col,
+                                        const T* __restrict__ data,
+                                        const I* __restrict__ perm_vec,
+                                        I* __restrict__ perm_col,
+                                        T* __restrict__ perm_data)
+    {
+        I tid = threadIdx.x;
+        I gid = blockIdx.x * blockDim.x + tid;
+        I lid = tid & (WF_SIZE - 1);
+        I row = gid / WF_SIZE;
 
-        if(lid == 0)
+        if(row >= nrow)
         {
-            max_tuples[row] = smax_tuple[WFSIZE * wid];
+            return;
         }
 
-        if(gid == 0)
+        J perm_index = perm_row_offset[perm_vec[row]];
+        J prev_index = row_offset[row];
+        I num_elems  = row_offset[row + 1] - prev_index;
+
+        for(I i = lid; i < num_elems; i += WF_SIZE)
         {
-            *done = true;
+            perm_data[perm_index + i] = data[prev_index + i];
+            perm_col[perm_index + i]  = col[prev_index + i];
         }
     }
 
-    // Note: Remove in next major release
-    template <typename I>
-    __global__ void kernel_csr_amg_update_mis_tuples(I nrow,
-                                                     const mis_tuple* __restrict__ max_tuples,
-                                                     mis_tuple* __restrict__ tuples,
-                                                     I* __restrict__ aggregates,
-                                                     bool* done)
+    // Permutes columns
+    //
+    // Inputs:   nrow:             number of rows in matrix
+    //           row_offset:       row pointer
+    //           perm_vec:         permutation vector
+    //           perm_col:         row-permuted column indices of elements
+    //           perm_data:        row-permuted data
+    // Outputs:  col:              fully permuted column indices of elements
+    //           data:             fully permuted data
+    template <unsigned int size, typename T, typename I, typename J>
+    __launch_bounds__(256) __global__ void kernel_permute_cols(I nrow,
+                                                               const J* __restrict__ row_offset,
+                                                               const I* __restrict__ perm_vec,
+                                                               const I* __restrict__ perm_col,
+                                                               const T* __restrict__ perm_data,
+                                                               I* __restrict__ col,
+                                                               T* __restrict__ data)
     {
-        I row = blockIdx.x * blockDim.x + threadIdx.x;
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(row >= nrow)
+        if(ai >= nrow)
         {
             return;
         }
 
-        if(tuples[row].s == 0)
-        {
-            mis_tuple t_max = max_tuples[row];
+        J elem_index = row_offset[ai];
+        I num_elems  = row_offset[ai + 1] - elem_index;
 
-            if(t_max.i == row)
-            {
-                tuples[row].s   = 1;
-                aggregates[row] = 1;
-            }
-            else if(t_max.s == 1)
-            {
-                tuples[row].s   = -1;
-                aggregates[row] = 0;
-            }
-            else
-            {
-                *done = false;
-            }
-        }
-    }
+        I ccol[size];
+        T cval[size];
 
-    // Note: Remove in next major release
-    template <typename I, typename J>
-    __global__ void kernel_csr_amg_update_aggregates(I nrow,
-                                                     const J* __restrict__ row_offset,
-                                                     const I* __restrict__ cols,
-                                                     const I* __restrict__ connections,
-                                                     const mis_tuple* __restrict__ max_tuples,
-                                                     mis_tuple* __restrict__ tuples,
-                                                     I* __restrict__ aggregates)
-    {
-        I row = blockIdx.x * blockDim.x + threadIdx.x;
+        col += elem_index;
+        data += elem_index;
+        perm_col += elem_index;
+        perm_data += elem_index;
 
-        if(row >= nrow)
+        for(I i = 0; i < num_elems; ++i)
         {
-            return;
+            ccol[i] = col[i];
+            cval[i] = data[i];
         }
 
-        mis_tuple t = max_tuples[row];
-
-        if(t.s == -1)
+        for(I i = 0; i < num_elems; ++i)
         {
-            J row_start = row_offset[row];
-            J row_end   = row_offset[row + 1];
+            I comp = perm_vec[perm_col[i]];
 
-            for(J j = row_start; j < row_end; j++)
+            I j;
+            for(j = i - 1; j >= 0; --j)
             {
-                if(connections[j] == 1)
+                I c = ccol[j];
+                if(c > comp)
                 {
-                    I col = cols[j];
-
-                    if(max_tuples[col].s == 1)
-                    {
-                        aggregates[row] = aggregates[col];
-                        tuples[row].s   = 1;
-                        break;
-                    }
+                    cval[j + 1] = cval[j];
+                    ccol[j + 1] = c;
+                }
+                else
+                {
+                    break;
                 }
             }
+
+            cval[j + 1] = perm_data[i];
+            ccol[j + 1] = comp;
         }
-        else if(t.s == -2)
+
+        for(I i = 0; i < num_elems; ++i)
         {
-            aggregates[row] = -2;
+            col[i]  = ccol[i];
+            data[i] = cval[i];
         }
     }
 
-    // Note: Remove in next major release
-    template <unsigned int BLOCKSIZE,
-              unsigned int WFSIZE,
-              unsigned int HASHSIZE,
-              typename I,
-              typename J>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_sa_prolong_nnz(I nrow,
-                                       const J* __restrict__ csr_row_ptr,
-                                       const I* __restrict__ csr_col_ind,
-                                       const I* __restrict__ connections,
-                                       const I* __restrict__ aggregates,
-                                       J* __restrict__ row_nnz)
+    // Permutes columns
+    //
+    // Inputs:   nrow:             number of rows in matrix
+    //           row_offset:       row pointer
+    //           perm_vec:         permutation vector
+    //           perm_col:         row-permuted column indices of elements
+    //           perm_data:        row-permuted data
+    // Outputs:  col:              fully permuted column indices of elements
+    //           data:             fully permuted data
+    template <typename T, typename I, typename J>
+    __global__ void kernel_permute_cols_fallback(I nrow,
+                                                 const J* __restrict__ row_offset,
+                                                 const I* __restrict__ perm_vec,
+                                                 const I* __restrict__ perm_col,
+                                                 const T* __restrict__ perm_data,
+                                                 I* __restrict__ col,
+                                                 T* __restrict__ data)
     {
-        unsigned int lid = threadIdx.x & (WFSIZE - 1);
-        unsigned int wid = threadIdx.x / WFSIZE;
-        if(warpSize == WFSIZE)
-        {
-            wid = __builtin_amdgcn_readfirstlane(wid);
-        }
-
-        // The row this thread operates on
-        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(row >= nrow)
+        if(ai >= nrow)
         {
             return;
         }
 
-        // Shared memory for the unordered set
-        __shared__ I stable[BLOCKSIZE / WFSIZE * HASHSIZE];
-
-        // Each wavefront operates on its own set
-        unordered_set<I, HASHSIZE, WFSIZE> set(&stable[wid * HASHSIZE]);
+        J elem_index = row_offset[ai];
+        I num_elems  = row_offset[ai + 1] - elem_index;
 
-        // Row nnz counter
-        I nnz = 0;
-
-        // Row entry and exit points
-        I row_begin = csr_row_ptr[row];
-        I row_end   = csr_row_ptr[row + 1];
+        col += elem_index;
+        data += elem_index;
+        perm_col += elem_index;
+        perm_data += elem_index;
 
-        // Loop over all columns of the i-th row, whereas each lane processes a column
-        for(I j = row_begin + lid; j < row_end; j += WFSIZE)
+        for(I i = 0; i < num_elems; ++i)
         {
-            // Get the column index
-            I col = csr_col_ind[j];
-
-            // Get connection state
-            I con = connections[j];
-
-            // Get aggregation state for this column
-            I agg = aggregates[col];
+            I comp = perm_vec[perm_col[i]];
 
-            // When aggregate is defined, diagonal entries and connected columns will
-            // generate a fill in
-            if((row == col || con) && agg >= 0)
+            I j;
+            for(j = i - 1; j >= 0; --j)
             {
-                // Insert into unordered set, to discard duplicates
-                nnz += set.insert(agg);
+                I c = col[j];
+                if(c > comp)
+                {
+                    data[j + 1] = data[j];
+                    col[j + 1]  = c;
+                }
+                else
+                {
+                    break;
+                }
             }
-        }
-
-        // Sum up the row nnz from all lanes
-        wf_reduce_sum<WFSIZE>(&nnz);
 
-        if(lid == WFSIZE - 1)
-        {
-            // Write row nnz back to global memory
-            row_nnz[row] = nnz;
+            data[j + 1] = perm_data[i];
+            col[j + 1]  = comp;
         }
     }
 
-    // Note: Remove in next major release
-    template <unsigned int BLOCKSIZE,
-              unsigned int WFSIZE,
-              unsigned int HASHSIZE,
-              typename T,
-              typename I,
-              typename J>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_sa_prolong_fill(I   nrow,
-                                        T   relax,
-                                        int lumping_strat,
-                                        const J* __restrict__ csr_row_ptr,
-                                        const I* __restrict__ csr_col_ind,
-                                        const T* __restrict__ csr_val,
-                                        const I* __restrict__ connections,
-                                        const I* __restrict__ aggregates,
-                                        const J* __restrict__ csr_row_ptr_P,
-                                        I* __restrict__ csr_col_ind_P,
-                                        T* __restrict__ csr_val_P)
+    // TODO
+    // kind of ugly and inefficient ... but works
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_add_csr_same_struct(I nrow,
+                                                   const J* __restrict__ out_row_offset,
+                                                   const I* __restrict__ out_col,
+                                                   const J* __restrict__ in_row_offset,
+                                                   const I* __restrict__ in_col,
+                                                   const T* __restrict__ in_val,
+                                                   T alpha,
+                                                   T beta,
+                                                   T* __restrict__ out_val)
     {
-        unsigned int lid = threadIdx.x & (WFSIZE - 1);
-        unsigned int wid = threadIdx.x / WFSIZE;
-        if(warpSize == WFSIZE)
-        {
-            wid = __builtin_amdgcn_readfirstlane(wid);
-        }
-        // The row this thread operates on
-        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
-        // Do not run out of bounds
-        if(row >= nrow)
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
             return;
         }
 
-        // Shared memory for the unordered map
-        __shared__ I    stable[(BLOCKSIZE / WFSIZE) * HASHSIZE];
-        __shared__ char smem[(BLOCKSIZE / WFSIZE) * HASHSIZE * sizeof(T)];
-
-        T* sdata = reinterpret_cast<T*>(smem);
-
-        // Each wavefront operates on its own map
-        unordered_map<I, T, HASHSIZE, WFSIZE> map(&stable[wid * HASHSIZE], &sdata[wid * HASHSIZE]);
-
-        // Row entry and exit points
-        J row_begin = csr_row_ptr[row];
-        J row_end   = csr_row_ptr[row + 1];
+        J first_col = in_row_offset[ai];
 
-        // Accumulator
-        T dia = static_cast<T>(0);
-        // Loop over all columns of the i-th row, whereas each lane processes a column
-        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        for(J ajj = out_row_offset[ai]; ajj < out_row_offset[ai + 1]; ++ajj)
         {
-            // Get the column index
-            I col_j = csr_col_ind[j];
-
-            // Get the value
-            T val_j = csr_val[j];
-
-            // Add the diagonal
-            if(col_j == row)
-            {
-                dia += val_j;
-            }
-            else if(connections[j] == false)
+            for(J aj = first_col; aj < in_row_offset[ai + 1]; ++aj)
             {
-                dia = (lumping_strat == 0) ? dia + val_j : dia - val_j;
+                if(in_col[aj] == out_col[ajj])
+                {
+                    out_val[ajj] = alpha * out_val[ajj] + beta * in_val[aj];
+                    ++first_col;
+                    break;
+                }
             }
         }
+    }
 
-        // Sum up the accumulator from all lanes
-        for(unsigned int i = WFSIZE >> 1; i > 0; i >>= 1)
+    // Computes the lower triangular part nnz per row
+    template <typename I, typename J>
+    __global__ void kernel_csr_lower_nnz_per_row(I nrow,
+                                                 const J* __restrict__ src_row_offset,
+                                                 const I* __restrict__ src_col,
+                                                 J* __restrict__ nnz_per_row)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
-            dia += hip_shfl_xor(dia, i);
+            return;
         }
 
-        dia = static_cast<T>(1) / dia;
+        nnz_per_row[ai] = 0;
 
-        // Loop over all columns of the i-th row, whereas each lane processes a column
-        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        for(J aj = src_row_offset[ai]; aj < src_row_offset[ai + 1]; ++aj)
         {
-            // Get the column index
-            I col_j = csr_col_ind[j];
-
-            // Get the value
-            T val_j = csr_val[j];
-
-            // Get connection state
-            I con = connections[j];
-
-            // Get aggregation state for this column
-            I agg = aggregates[col_j];
-
-            // When aggregate is defined, diagonal entries and connected columns will
-            // generate a fill in
-            if((row == col_j || con) && agg >= 0)
+            if(src_col[aj] <= ai)
             {
-                // Insert or add if already present into unordered map
-                T val = (col_j == row) ? static_cast<T>(1) - relax : -relax * dia * val_j;
-
-                map.insert_or_add(agg, val);
+                ++nnz_per_row[ai];
             }
         }
-
-        // Access into P
-        J aj = csr_row_ptr_P[row];
-
-        // Store key val pairs from map into P
-        map.store_sorted(&csr_col_ind_P[aj], &csr_val_P[aj]);
     }
 
-    // Note: Remove in next major release
-    template <unsigned int BLOCKSIZE, typename I, typename J>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_unsmoothed_prolong_nnz_per_row(I nrow,
-                                                       const I* __restrict__ aggregates,
-                                                       J* __restrict__ prolong_row_offset)
+    // Computes the upper triangular part nnz per row
+    template <typename I, typename J>
+    __global__ void kernel_csr_upper_nnz_per_row(I nrow,
+                                                 const J* __restrict__ src_row_offset,
+                                                 const I* __restrict__ src_col,
+                                                 J* __restrict__ nnz_per_row)
     {
-        I tid = threadIdx.x;
-        I row = blockIdx.x * BLOCKSIZE + tid;
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(row >= nrow)
+        if(ai >= nrow)
         {
             return;
         }
 
-        if(aggregates[row] >= 0)
+        nnz_per_row[ai] = 0;
+
+        for(J aj = src_row_offset[ai]; aj < src_row_offset[ai + 1]; ++aj)
         {
-            prolong_row_offset[row + 1] = 1;
+            if(src_col[aj] >= ai)
+            {
+                ++nnz_per_row[ai];
+            }
         }
-        else
+    }
+
+    // Computes the stricktly lower triangular part nnz per row
+    template <typename I, typename J>
+    __global__ void kernel_csr_slower_nnz_per_row(I nrow,
+                                                  const J* __restrict__ src_row_offset,
+                                                  const I* __restrict__ src_col,
+                                                  J* __restrict__ nnz_per_row)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
-            prolong_row_offset[row + 1] = 0;
+            return;
         }
 
-        if(row == 0)
+        nnz_per_row[ai] = 0;
+
+        for(J aj = src_row_offset[ai]; aj < src_row_offset[ai + 1]; ++aj)
         {
-            prolong_row_offset[row] = 0;
+            if(src_col[aj] < ai)
+            {
+                ++nnz_per_row[ai];
+            }
         }
     }
 
-    // Note: Remove in next major release
-    template <unsigned int BLOCKSIZE, typename T, typename I>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_unsmoothed_prolong_fill_simple(I nrow,
-                                                       const I* __restrict__ aggregates,
-                                                       I* __restrict__ prolong_cols,
-                                                       T* __restrict__ prolong_vals)
+    // Computes the stricktly upper triangular part nnz per row
+    template <typename I, typename J>
+    __global__ void kernel_csr_supper_nnz_per_row(I nrow,
+                                                  const J* __restrict__ src_row_offset,
+                                                  const I* __restrict__ src_col,
+                                                  J* __restrict__ nnz_per_row)
     {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        I tid = threadIdx.x;
-        I row = blockIdx.x * BLOCKSIZE + tid;
-
-        if(row >= nrow)
+        if(ai >= nrow)
         {
             return;
         }
 
-        prolong_cols[row] = aggregates[row];
-        prolong_vals[row] = static_cast<T>(1);
+        nnz_per_row[ai] = 0;
+
+        for(J aj = src_row_offset[ai]; aj < src_row_offset[ai + 1]; ++aj)
+        {
+            if(src_col[aj] > ai)
+            {
+                ++nnz_per_row[ai];
+            }
+        }
     }
 
-    // Note: Remove in next major release
-    template <unsigned int BLOCKSIZE, typename T, typename I, typename J>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_unsmoothed_prolong_fill(I nrow,
-                                                const I* __restrict__ aggregates,
-                                                const J* __restrict__ prolong_row_offset,
-                                                I* __restrict__ prolong_cols,
-                                                T* __restrict__ prolong_vals)
+    // Extracts lower triangular part for given nnz per row array (partial sums nnz)
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_extract_l_triangular(I nrow,
+                                                    const J* __restrict__ src_row_offset,
+                                                    const I* __restrict__ src_col,
+                                                    const T* __restrict__ src_val,
+                                                    J* __restrict__ nnz_per_row,
+                                                    I* __restrict__ dst_col,
+                                                    T* __restrict__ dst_val)
     {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        I tid = threadIdx.x;
-        I row = blockIdx.x * BLOCKSIZE + tid;
-
-        if(row >= nrow)
+        if(ai >= nrow)
         {
             return;
         }
 
-        I agg = aggregates[row];
+        J dst_index = nnz_per_row[ai];
+        J src_index = src_row_offset[ai];
 
-        if(agg >= 0)
+        for(J aj = 0; aj < nnz_per_row[ai + 1] - nnz_per_row[ai]; ++aj)
         {
-            J j = prolong_row_offset[row];
+            dst_col[dst_index] = src_col[src_index];
+            dst_val[dst_index] = src_val[src_index];
 
-            prolong_cols[j] = agg;
-            prolong_vals[j] = static_cast<T>(1);
+            ++dst_index;
+            ++src_index;
         }
     }
 
-    // AMG Connect
-    template <bool GLOBAL, unsigned int WF_SIZE, typename T, typename I, typename J>
-    __global__ void kernel_csr_amg_connect(I       nrow,
-                                           int64_t nnz,
-                                           T       eps2,
-                                           const J* __restrict__ row_offset,
-                                           const I* __restrict__ col,
-                                           const T* __restrict__ val,
-                                           const J* __restrict__ gst_row_offset,
-                                           const I* __restrict__ gst_col,
-                                           const T* __restrict__ gst_val,
-                                           const T* __restrict__ diag,
-                                           const int64_t* __restrict__ l2g,
-                                           bool* __restrict__ connections)
+    // Extracts upper triangular part for given nnz per row array (partial sums nnz)
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_extract_u_triangular(I nrow,
+                                                    const J* __restrict__ src_row_offset,
+                                                    const I* __restrict__ src_col,
+                                                    const T* __restrict__ src_val,
+                                                    J* __restrict__ nnz_per_row,
+                                                    I* __restrict__ dst_col,
+                                                    T* __restrict__ dst_val)
     {
-        I tid = threadIdx.x;
-        I gid = blockIdx.x * blockDim.x + tid;
-        I lid = tid & (WF_SIZE - 1);
-        I row = gid / WF_SIZE;
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(row >= nrow)
+        if(ai >= nrow)
         {
             return;
         }
 
-        T eps_diag_r = eps2 * diag[row];
-
-        J row_begin = row_offset[row];
-        J row_end   = row_offset[row + 1];
+        I num_elements = nnz_per_row[ai + 1] - nnz_per_row[ai];
+        J src_index    = src_row_offset[ai + 1] - num_elements;
+        J dst_index    = nnz_per_row[ai];
 
-        for(J i = row_begin + lid; i < row_end; i += WF_SIZE)
+        for(I aj = 0; aj < num_elements; ++aj)
         {
-            I c = col[i];
-            T v = val[i];
+            dst_col[dst_index] = src_col[src_index];
+            dst_val[dst_index] = src_val[src_index];
 
-            connections[i] = (c != row) && (hip_real(v * v) > hip_real(eps_diag_r * diag[c]));
+            ++dst_index;
+            ++src_index;
         }
+    }
 
-        if(GLOBAL)
+    // Compress
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_compress_count_nrow(const J* __restrict__ row_offset,
+                                                   const I* __restrict__ col,
+                                                   const T* __restrict__ val,
+                                                   I      nrow,
+                                                   double drop_off,
+                                                   I* __restrict__ row_offset_new)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
-            J gst_row_begin = gst_row_offset[row];
-            J gst_row_end   = gst_row_offset[row + 1];
+            return;
+        }
 
-            for(J i = gst_row_begin + lid; i < gst_row_end; i += WF_SIZE)
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            if((hip_abs(val[aj]) > drop_off) || (col[aj] == ai))
             {
-                I c = gst_col[i];
-                T v = gst_val[i];
-
-                connections[i + nnz] = (hip_real(v * v) > hip_real(eps_diag_r * diag[c + nrow]));
+                ++row_offset_new[ai];
             }
         }
     }
 
-    // AMG Aggregate
-    __device__ __forceinline__ unsigned int hash1(unsigned int x)
-    {
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = (x >> 16) ^ x;
-        return x / 2;
-    }
-
-    template <bool GLOBAL, typename I, typename J>
-    __global__ void kernel_csr_amg_init_mis_tuples(int64_t global_column_begin,
-                                                   I       nrow,
-                                                   int64_t nnz,
-                                                   const J* __restrict__ row_offset,
-                                                   const J* __restrict__ gst_row_offset,
-                                                   const bool* __restrict__ connections,
-                                                   int* __restrict__ state,
-                                                   int* __restrict__ hash)
+    // Compress
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_compress_copy(const J* __restrict__ row_offset,
+                                             const I* __restrict__ col,
+                                             const T* __restrict__ val,
+                                             I      nrow,
+                                             double drop_off,
+                                             const J* __restrict__ row_offset_new,
+                                             I* __restrict__ col_new,
+                                             T* __restrict__ val_new)
     {
-        I row = blockIdx.x * blockDim.x + threadIdx.x;
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(row >= nrow)
+        if(ai >= nrow)
         {
             return;
         }
 
-        int s = -2;
-
-        J row_begin = row_offset[row];
-        J row_end   = row_offset[row + 1];
+        J ajj = row_offset_new[ai];
 
-        for(J j = row_begin; j < row_end; j++)
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            if(connections[j] == true)
+            if((hip_abs(val[aj]) > drop_off) || (col[aj] == ai))
             {
-                s = 0;
-                break;
+                col_new[ajj] = col[aj];
+                val_new[ajj] = val[aj];
+                ++ajj;
             }
         }
+    }
 
-        if(GLOBAL == true)
+    // Compress with lumping, count the entries that are kept in each row
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_compress_lumped_count_nrow(const J* __restrict__ row_offset,
+                                                          const I* __restrict__ col,
+                                                          const T* __restrict__ val,
+                                                          const T* __restrict__ diag,
+                                                          I      nrow,
+                                                          double drop_off,
+                                                          J* __restrict__ row_offset_new)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
-            J gst_row_begin = gst_row_offset[row];
-            J gst_row_end   = gst_row_offset[row + 1];
+            return;
+        }
 
-            for(J j = gst_row_begin; j < gst_row_end; ++j)
+        double diag_i = hip_abs(diag[ai]);
+        J      nnz    = 0;
+
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            I ac = col[aj];
+
+            if((ac == ai) || (hip_abs(val[aj]) > drop_off * sqrt(diag_i * hip_abs(diag[ac]))))
             {
-                if(connections[j + nnz] == true)
-                {
-                    s = 0;
-                    break;
-                }
+                ++nnz;
             }
         }
 
-        state[row] = s;
-        hash[row]  = hash1(row + global_column_begin);
+        row_offset_new[ai] = nnz;
     }
 
-    template <bool GLOBAL, unsigned int BLOCKSIZE, unsigned int WFSIZE, typename I, typename J>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_amg_find_max_node(I       nrow,
-                                          int64_t nnz,
-                                          int64_t global_column_begin,
-                                          int64_t global_column_end,
-                                          const J* __restrict__ row_offset,
-                                          const I* __restrict__ cols,
-                                          const J* __restrict__ gst_row_offset,
-                                          const I* __restrict__ gst_cols,
-                                          const bool* __restrict__ connections,
-                                          const I* __restrict__ state,
-                                          const I* __restrict__ hash,
-                                          const J* __restrict__ bnd_row_offset,
-                                          const int64_t* __restrict__ bnd_cols,
-                                          const I* __restrict__ bnd_state,
-                                          const I* __restrict__ bnd_hash,
-                                          I* __restrict__ max_state,
-                                          int64_t* __restrict__ aggregates,
-                                          bool* undecided)
+    // Compress with lumping, the dropped entries are added to the diagonal
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_compress_lumped_copy(const J* __restrict__ row_offset,
+                                                    const I* __restrict__ col,
+                                                    const T* __restrict__ val,
+                                                    const T* __restrict__ diag,
+                                                    I      nrow,
+                                                    double drop_off,
+                                                    const J* __restrict__ row_offset_new,
+                                                    I* __restrict__ col_new,
+                                                    T* __restrict__ val_new)
     {
-        I tid = threadIdx.x;
-        I gid = blockIdx.x * BLOCKSIZE + tid;
-        I lid = tid & (WFSIZE - 1);
-        I wid = tid / WFSIZE;
-        I row = gid / WFSIZE;
-
-        __shared__ mis_tuple smax_tuple[BLOCKSIZE];
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(row >= nrow)
+        if(ai >= nrow)
         {
             return;
         }
 
-        smax_tuple[WFSIZE * wid].s = state[row];
-        smax_tuple[WFSIZE * wid].v = hash[row];
-        smax_tuple[WFSIZE * wid].i = row;
-
-        __syncthreads();
-
-        mis_tuple t_max = smax_tuple[WFSIZE * wid];
-
-        // Find distance one max node
-        J row_begin = row_offset[row];
-        J row_end   = row_offset[row + 1];
+        double diag_i = hip_abs(diag[ai]);
+        T      lumped = static_cast<T>(0);
 
-        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            if(connections[j] == true)
-            {
-                I col = cols[j];
-
-                mis_tuple tj;
-                tj.s = state[col];
-                tj.v = hash[col];
-                tj.i = col;
+            I ac = col[aj];
 
-                t_max = lexographical_max(&tj, &t_max);
+            if((ac != ai) && (hip_abs(val[aj]) <= drop_off * sqrt(diag_i * hip_abs(diag[ac]))))
+            {
+                lumped += val[aj];
             }
         }
 
-        if(GLOBAL)
+        J ajj = row_offset_new[ai];
+
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            J gst_row_begin = gst_row_offset[row];
-            J gst_row_end   = gst_row_offset[row + 1];
+            I ac = col[aj];
 
-            for(J j = gst_row_begin + lid; j < gst_row_end; j += WFSIZE)
+            if(ac == ai)
             {
-                if(connections[j + nnz] == true)
-                {
-                    I col = gst_cols[j];
-
-                    mis_tuple tj;
-                    tj.s = state[nrow + col];
-                    tj.v = hash[nrow + col];
-                    tj.i = nrow + col;
-
-                    t_max = lexographical_max(&tj, &t_max);
-                }
+                col_new[ajj] = ac;
+                val_new[ajj] = val[aj] + lumped;
+                ++ajj;
+            }
+            else if(hip_abs(val[aj]) > drop_off * sqrt(diag_i * hip_abs(diag[ac])))
+            {
+                col_new[ajj] = ac;
+                val_new[ajj] = val[aj];
+                ++ajj;
+            }
+        }
+    }
+
+    // Extract column vector
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_extract_column_vector(const J* __restrict__ row_offset,
+                                                     const I* __restrict__ col,
+                                                     const T* __restrict__ val,
+                                                     I nrow,
+                                                     I idx,
+                                                     T* __restrict__ vec)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
+        {
+            return;
+        }
+
+        vec[ai] = static_cast<T>(0);
+
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            if(idx == col[aj])
+            {
+                vec[ai] = val[aj];
+            }
+        }
+    }
+
+    // Replace column vector - compute new offset
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_replace_column_vector_offset(const J* __restrict__ row_offset,
+                                                            const I* __restrict__ col,
+                                                            I nrow,
+                                                            I idx,
+                                                            const T* __restrict__ vec,
+                                                            J* __restrict__ offset)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
+        {
+            return;
+        }
+
+        bool add = true;
+        I    val = row_offset[ai + 1] - row_offset[ai];
+
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            if(col[aj] == idx)
+            {
+                add = false;
+                break;
+            }
+        }
+
+        if(add == true && hip_abs(vec[ai]) != 0.0)
+        {
+            ++val;
+        }
+
+        if(add == false && hip_abs(vec[ai]) == 0.0)
+        {
+            --val;
+        }
+
+        offset[ai] = val;
+    }
+
+    // Replace column vector - compute new offset
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_replace_column_vector(const J* __restrict__ row_offset,
+                                                     const I* __restrict__ col,
+                                                     const T* __restrict__ val,
+                                                     I nrow,
+                                                     I idx,
+                                                     const T* __restrict__ vec,
+                                                     const J* __restrict__ offset,
+                                                     I* __restrict__ new_col,
+                                                     T* __restrict__ new_val)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
+        {
+            return;
+        }
+
+        J aj = row_offset[ai];
+        J k  = offset[ai];
+
+        for(; aj < row_offset[ai + 1]; ++aj)
+        {
+            if(col[aj] < idx)
+            {
+                new_col[k] = col[aj];
+                new_val[k] = val[aj];
+                ++k;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if(hip_abs(vec[ai]) != 0.0)
+        {
+            new_col[k] = idx;
+            new_val[k] = vec[ai];
+            ++k;
+            ++aj;
+        }
+
+        for(; aj < row_offset[ai + 1]; ++aj)
+        {
+            if(col[aj] > idx)
+            {
+                new_col[k] = col[aj];
+                new_val[k] = val[aj];
+                ++k;
+            }
+        }
+    }
+
+    // Extract row vector
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_extract_row_vector(const J* __restrict__ row_offset,
+                                                  const I* __restrict__ col,
+                                                  const T* __restrict__ val,
+                                                  I row_nnz,
+                                                  I idx,
+                                                  T* __restrict__ vec)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= row_nnz)
+        {
+            return;
+        }
+
+        J aj         = row_offset[idx] + ai;
+        vec[col[aj]] = val[aj];
+    }
+
+    template <typename I, typename J>
+    __global__ void kernel_csr_boundary_nnz(I       boundary_size,
+                                            int64_t nnz,
+                                            const I* __restrict__ boundary_index,
+                                            const J* __restrict__ csr_row_ptr,
+                                            const I* __restrict__ csr_col_ind,
+                                            const J* __restrict__ ghost_csr_row_ptr,
+                                            const I* __restrict__ ghost_csr_col_ind,
+                                            const bool* __restrict__ connections,
+                                            J* __restrict__ row_nnz)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= boundary_size)
+        {
+            return;
+        }
+
+        // This row is a boundary row
+        I row = boundary_index[gid];
+
+        J ext_nnz = 0;
+
+        // Extract interior part
+        J row_begin = csr_row_ptr[row];
+        J row_end   = csr_row_ptr[row + 1];
+
+        // Interior
+        for(J j = row_begin; j < row_end; ++j)
+        {
+            // Check whether this vertex is strongly connected
+            if(connections[j] == true)
+            {
+                ++ext_nnz;
+            }
+        }
+
+        // Ghost part
+        J gst_row_begin = ghost_csr_row_ptr[row];
+        J gst_row_end   = ghost_csr_row_ptr[row + 1];
+
+        for(J j = gst_row_begin; j < gst_row_end; ++j)
+        {
+            // Check whether this vertex is strongly connected
+            if(connections[j + nnz] == true)
+            {
+                ++ext_nnz;
+            }
+        }
+
+        // Write total number of strongly connected coarse vertices to global memory
+        row_nnz[gid] = ext_nnz;
+    }
+
+    template <typename I, typename J>
+    __global__ void kernel_csr_extract_boundary(I       boundary_size,
+                                                int64_t nnz,
+                                                int64_t global_column_begin,
+                                                const I* __restrict__ boundary_index,
+                                                const J* __restrict__ csr_row_ptr,
+                                                const I* __restrict__ csr_col_ind,
+                                                const J* __restrict__ ghost_csr_row_ptr,
+                                                const I* __restrict__ ghost_csr_col_ind,
+                                                const bool* __restrict__ connections,
+                                                const int64_t* __restrict__ l2g,
+                                                const J* __restrict__ bnd_row_ptr,
+                                                int64_t* __restrict__ bnd_col_ind)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= boundary_size)
+        {
+            return;
+        }
+
+        // This row is a boundary row
+        I row = boundary_index[gid];
+
+        // Index into boundary array
+        J idx = bnd_row_ptr[gid];
+
+        // Extract interior part
+        J row_begin = csr_row_ptr[row];
+        J row_end   = csr_row_ptr[row + 1];
+
+        // Interior
+        for(J j = row_begin; j < row_end; ++j)
+        {
+            if(connections[j] == true)
+            {
+                // Get column index
+                I col = csr_col_ind[j];
+
+                // Shift column by global column offset, to obtain the global column index
+                bnd_col_ind[idx++] = col + global_column_begin;
+            }
+        }
+
+        // Extract ghost part
+        J gst_row_begin = ghost_csr_row_ptr[row];
+        J gst_row_end   = ghost_csr_row_ptr[row + 1];
+
+        for(J j = gst_row_begin; j < gst_row_end; ++j)
+        {
+            // Check whether this vertex is strongly connected
+            if(connections[j + nnz] == true)
+            {
+                // Get column index
+                I col = ghost_csr_col_ind[j];
+
+                // Transform local ghost index into global column index
+                bnd_col_ind[idx++] = l2g[col];
+            }
+        }
+    }
+
+    __device__ __forceinline__ mis_tuple lexographical_max(mis_tuple* ti, mis_tuple* tj)
+    {
+        // find lexographical maximum
+        if(tj->s > ti->s)
+        {
+            return *tj;
+        }
+        else if(tj->s == ti->s)
+        {
+            if(tj->v > ti->v)
+            {
+                return *tj;
+            }
+        }
+
+        return *ti;
+    }
+
+    // Note: Remove in next major release
+    template <unsigned int WF_SIZE, typename T, typename I, typename J>
+    __global__ void kernel_csr_amg_connect(I nrow,
+                                           T eps2,
+                                           const J* __restrict__ row_offset,
+                                           const I* __restrict__ col,
+                                           const T* __restrict__ val,
+                                           const T* __restrict__ diag,
+                                           I* __restrict__ connections)
+    {
+        I tid = threadIdx.x;
+        I gid = blockIdx.x * blockDim.x + tid;
+        I lid = tid & (WF_SIZE - 1);
+        I row = gid / WF_SIZE;
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        T eps_diag_r = eps2 * diag[row];
+
+        J start = row_offset[row];
+        J end   = row_offset[row + 1];
+
+        for(J i = start + lid; i < end; i += WF_SIZE)
+        {
+            I c = col[i];
+            T v = val[i];
+
+            connections[i] = (c != row) && (hip_real(v * v) > hip_real(eps_diag_r * diag[c]));
+        }
+    }
+
+    // Note: Remove in next major release
+    __device__ __forceinline__ unsigned int hash(unsigned int x)
+    {
+        x = ((x >> 16) ^ x) * 0x45d9f3b;
+        x = ((x >> 16) ^ x) * 0x45d9f3b;
+        x = (x >> 16) ^ x;
+        return x;
+    }
+
+    // Note: Remove in next major release
+    template <typename I, typename J>
+    __global__ void kernel_csr_amg_init_mis_tuples(I nrow,
+                                                   const J* __restrict__ row_offset,
+                                                   const I* __restrict__ connections,
+                                                   mis_tuple* __restrict__ tuples)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        I state = -2;
+
+        J row_start = row_offset[row];
+        J row_end   = row_offset[row + 1];
+
+        for(J j = row_start; j < row_end; j++)
+        {
+            if(connections[j] == 1)
+            {
+                state = 0;
+                break;
+            }
+        }
+
+        tuples[row].s = state;
+        tuples[row].v = hash(row);
+        tuples[row].i = row;
+    }
+
+    // Note: Remove in next major release
+    template <unsigned int BLOCKSIZE, unsigned int WFSIZE, typename I, typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_amg_find_max_mis_tuples_shared(I nrow,
+                                                       const J* __restrict__ row_offset,
+                                                       const I* __restrict__ cols,
+                                                       const I* __restrict__ connections,
+                                                       const mis_tuple* __restrict__ tuples,
+                                                       mis_tuple* __restrict__ max_tuples,
+                                                       bool* done)
+    {
+        I                    tid = threadIdx.x;
+        I                    gid = blockIdx.x * BLOCKSIZE + tid;
+        I                    lid = tid & (WFSIZE - 1);
+        I                    wid = tid / WFSIZE;
+        I                    row = gid / WFSIZE;
+        __shared__ mis_tuple smax_tuple[BLOCKSIZE];
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        smax_tuple[WFSIZE * wid] = max_tuples[row];
+
+        __syncthreads();
+
+        for(I k = 0; k < 2; k++)
+        {
+            mis_tuple t_max = smax_tuple[WFSIZE * wid];
+
+            J row_start = row_offset[t_max.i];
+            J row_end   = row_offset[t_max.i + 1];
+
+            for(J j = row_start + lid; j < row_end; j += WFSIZE)
+            {
+                if(connections[j] == 1)
+                {
+                    I         col = cols[j];
+                    mis_tuple tj  = tuples[col];
+
+                    t_max = lexographical_max(&tj, &t_max);
+                }
+            }
+
+            smax_tuple[WFSIZE * wid + lid] = t_max;
+
+            __syncthreads();
+
+            // Finish reducing the intra block lexographical max
+            if(WFSIZE >= 64)
+            {
+                if(lid < 32)
+                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 32]);
+                __threadfence_block();
+            }
+            if(WFSIZE >= 32)
+            {
+                if(lid < 16)
+                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 16]);
+                __threadfence_block();
+            }
+            if(WFSIZE >= 16)
+            {
+                if(lid < 8)
+                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 8]);
+                __threadfence_block();
+            }
+            if(WFSIZE >= 8)
+            {
+                if(lid < 4)
+                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 4]);
+                __threadfence_block();
+            }
+            if(WFSIZE >= 4)
+            {
+                if(lid < 2)
+                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 2]);
+                __threadfence_block();
+            }
+            if(WFSIZE >= 2)
+            {
+                if(lid < 1)
+                    smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                        &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 1]);
+                __threadfence_block();
+            }
+
+            __syncthreads();
+        }
+
+        if(lid == 0)
+        {
+            max_tuples[row] = smax_tuple[WFSIZE * wid];
+        }
+
+        if(gid == 0)
+        {
+            *done = true;
+        }
+    }
+
+    // Note: Remove in next major release
+    template <typename I>
+    __global__ void kernel_csr_amg_update_mis_tuples(I nrow,
+                                                     const mis_tuple* __restrict__ max_tuples,
+                                                     mis_tuple* __restrict__ tuples,
+                                                     I* __restrict__ aggregates,
+                                                     bool* done)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        if(tuples[row].s == 0)
+        {
+            mis_tuple t_max = max_tuples[row];
+
+            if(t_max.i == row)
+            {
+                tuples[row].s   = 1;
+                aggregates[row] = 1;
+            }
+            else if(t_max.s == 1)
+            {
+                tuples[row].s   = -1;
+                aggregates[row] = 0;
+            }
+            else
+            {
+                *done = false;
+            }
+        }
+    }
+
+    // Note: Remove in next major release
+    template <typename I, typename J>
+    __global__ void kernel_csr_amg_update_aggregates(I nrow,
+                                                     const J* __restrict__ row_offset,
+                                                     const I* __restrict__ cols,
+                                                     const I* __restrict__ connections,
+                                                     const mis_tuple* __restrict__ max_tuples,
+                                                     mis_tuple* __restrict__ tuples,
+                                                     I* __restrict__ aggregates)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        mis_tuple t = max_tuples[row];
+
+        if(t.s == -1)
+        {
+            J row_start = row_offset[row];
+            J row_end   = row_offset[row + 1];
+
+            for(J j = row_start; j < row_end; j++)
+            {
+                if(connections[j] == 1)
+                {
+                    I col = cols[j];
+
+                    if(max_tuples[col].s == 1)
+                    {
+                        aggregates[row] = aggregates[col];
+                        tuples[row].s   = 1;
+                        break;
+                    }
+                }
+            }
+        }
+        else if(t.s == -2)
+        {
+            aggregates[row] = -2;
+        }
+    }
+
+    // Note: Remove in next major release
+    template <unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              unsigned int HASHSIZE,
+              typename I,
+              typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_sa_prolong_nnz(I nrow,
+                                       const J* __restrict__ csr_row_ptr,
+                                       const I* __restrict__ csr_col_ind,
+                                       const I* __restrict__ connections,
+                                       const I* __restrict__ aggregates,
+                                       J* __restrict__ row_nnz)
+    {
+        unsigned int lid = threadIdx.x & (WFSIZE - 1);
+        unsigned int wid = threadIdx.x / WFSIZE;
+        if(warpSize == WFSIZE)
+        {
+            wid = __builtin_amdgcn_readfirstlane(wid);
+        }
+
+        // The row this thread operates on
+        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
+
+        // Do not run out of bounds
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        // Shared memory for the unordered set
+        __shared__ I stable[BLOCKSIZE / WFSIZE * HASHSIZE];
+
+        // Each wavefront operates on its own set
+        unordered_set<I, HASHSIZE, WFSIZE> set(&stable[wid * HASHSIZE]);
+
+        // Row nnz counter
+        I nnz = 0;
+
+        // Row entry and exit points
+        I row_begin = csr_row_ptr[row];
+        I row_end   = csr_row_ptr[row + 1];
+
+        // Loop over all columns of the i-th row, whereas each lane processes a column
+        for(I j = row_begin + lid; j < row_end; j += WFSIZE)
+        {
+            // Get the column index
+            I col = csr_col_ind[j];
+
+            // Get connection state
+            I con = connections[j];
+
+            // Get aggregation state for this column
+            I agg = aggregates[col];
+
+            // When aggregate is defined, diagonal entries and connected columns will
+            // generate a fill in
+            if((row == col || con) && agg >= 0)
+            {
+                // Insert into unordered set, to discard duplicates
+                nnz += set.insert(agg);
+            }
+        }
+
+        // Sum up the row nnz from all lanes
+        wf_reduce_sum<WFSIZE>(&nnz);
+
+        if(lid == WFSIZE - 1)
+        {
+            // Write row nnz back to global memory
+            row_nnz[row] = nnz;
+        }
+    }
+
+    // Note: Remove in next major release
+    template <unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              unsigned int HASHSIZE,
+              typename T,
+              typename I,
+              typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_sa_prolong_fill(I   nrow,
+                                        T   relax,
+                                        int lumping_strat,
+                                        const J* __restrict__ csr_row_ptr,
+                                        const I* __restrict__ csr_col_ind,
+                                        const T* __restrict__ csr_val,
+                                        const I* __restrict__ connections,
+                                        const I* __restrict__ aggregates,
+                                        const J* __restrict__ csr_row_ptr_P,
+                                        I* __restrict__ csr_col_ind_P,
+                                        T* __restrict__ csr_val_P)
+    {
+        unsigned int lid = threadIdx.x & (WFSIZE - 1);
+        unsigned int wid = threadIdx.x / WFSIZE;
+        if(warpSize == WFSIZE)
+        {
+            wid = __builtin_amdgcn_readfirstlane(wid);
+        }
+        // The row this thread operates on
+        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
+        // Do not run out of bounds
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        // Shared memory for the unordered map
+        __shared__ I    stable[(BLOCKSIZE / WFSIZE) * HASHSIZE];
+        __shared__ char smem[(BLOCKSIZE / WFSIZE) * HASHSIZE * sizeof(T)];
+
+        T* sdata = reinterpret_cast<T*>(smem);
+
+        // Each wavefront operates on its own map
+        unordered_map<I, T, HASHSIZE, WFSIZE> map(&stable[wid * HASHSIZE], &sdata[wid * HASHSIZE]);
+
+        // Row entry and exit points
+        J row_begin = csr_row_ptr[row];
+        J row_end   = csr_row_ptr[row + 1];
+
+        // Accumulator
+        T dia = static_cast<T>(0);
+        // Loop over all columns of the i-th row, whereas each lane processes a column
+        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        {
+            // Get the column index
+            I col_j = csr_col_ind[j];
+
+            // Get the value
+            T val_j = csr_val[j];
+
+            // Add the diagonal
+            if(col_j == row)
+            {
+                dia += val_j;
+            }
+            else if(connections[j] == false)
+            {
+                dia = (lumping_strat == 0) ? dia + val_j : dia - val_j;
+            }
+        }
+
+        // Sum up the accumulator from all lanes
+        for(unsigned int i = WFSIZE >> 1; i > 0; i >>= 1)
+        {
+            dia += hip_shfl_xor(dia, i);
+        }
+
+        dia = static_cast<T>(1) / dia;
+
+        // Loop over all columns of the i-th row, whereas each lane processes a column
+        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        {
+            // Get the column index
+            I col_j = csr_col_ind[j];
+
+            // Get the value
+            T val_j = csr_val[j];
+
+            // Get connection state
+            I con = connections[j];
+
+            // Get aggregation state for this column
+            I agg = aggregates[col_j];
+
+            // When aggregate is defined, diagonal entries and connected columns will
+            // generate a fill in
+            if((row == col_j || con) && agg >= 0)
+            {
+                // Insert or add if already present into unordered map
+                T val = (col_j == row) ? static_cast<T>(1) - relax : -relax * dia * val_j;
+
+                map.insert_or_add(agg, val);
+            }
+        }
+
+        // Access into P
+        J aj = csr_row_ptr_P[row];
+
+        // Store key val pairs from map into P
+        map.store_sorted(&csr_col_ind_P[aj], &csr_val_P[aj]);
+    }
+
+    // Note: Remove in next major release
+    template <unsigned int BLOCKSIZE, typename I, typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_unsmoothed_prolong_nnz_per_row(I nrow,
+                                                       const I* __restrict__ aggregates,
+                                                       J* __restrict__ prolong_row_offset)
+    {
+        I tid = threadIdx.x;
+        I row = blockIdx.x * BLOCKSIZE + tid;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        if(aggregates[row] >= 0)
+        {
+            prolong_row_offset[row + 1] = 1;
+        }
+        else
+        {
+            prolong_row_offset[row + 1] = 0;
+        }
+
+        if(row == 0)
+        {
+            prolong_row_offset[row] = 0;
+        }
+    }
+
+    // Note: Remove in next major release
+    template <unsigned int BLOCKSIZE, typename T, typename I>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_unsmoothed_prolong_fill_simple(I nrow,
+                                                       const I* __restrict__ aggregates,
+                                                       I* __restrict__ prolong_cols,
+                                                       T* __restrict__ prolong_vals)
+    {
+
+        I tid = threadIdx.x;
+        I row = blockIdx.x * BLOCKSIZE + tid;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        prolong_cols[row] = aggregates[row];
+        prolong_vals[row] = static_cast<T>(1);
+    }
+
+    // Note: Remove in next major release
+    template <unsigned int BLOCKSIZE, typename T, typename I, typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_unsmoothed_prolong_fill(I nrow,
+                                                const I* __restrict__ aggregates,
+                                                const J* __restrict__ prolong_row_offset,
+                                                I* __restrict__ prolong_cols,
+                                                T* __restrict__ prolong_vals)
+    {
+
+        I tid = threadIdx.x;
+        I row = blockIdx.x * BLOCKSIZE + tid;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        I agg = aggregates[row];
+
+        if(agg >= 0)
+        {
+            J j = prolong_row_offset[row];
+
+            prolong_cols[j] = agg;
+            prolong_vals[j] = static_cast<T>(1);
+        }
+    }
+
+    // AMG Connect
+    template <bool GLOBAL, unsigned int WF_SIZE, typename T, typename I, typename J>
+    __global__ void kernel_csr_amg_connect(I       nrow,
+                                           int64_t nnz,
+                                           T       eps2,
+                                           const J* __restrict__ row_offset,
+                                           const I* __restrict__ col,
+                                           const T* __restrict__ val,
+                                           const J* __restrict__ gst_row_offset,
+                                           const I* __restrict__ gst_col,
+                                           const T* __restrict__ gst_val,
+                                           const T* __restrict__ diag,
+                                           const int64_t* __restrict__ l2g,
+                                           bool* __restrict__ connections)
+    {
+        I tid = threadIdx.x;
+        I gid = blockIdx.x * blockDim.x + tid;
+        I lid = tid & (WF_SIZE - 1);
+        I row = gid / WF_SIZE;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        T eps_diag_r = eps2 * diag[row];
+
+        J row_begin = row_offset[row];
+        J row_end   = row_offset[row + 1];
+
+        for(J i = row_begin + lid; i < row_end; i += WF_SIZE)
+        {
+            I c = col[i];
+            T v = val[i];
+
+            connections[i] = (c != row) && (hip_real(v * v) > hip_real(eps_diag_r * diag[c]));
+        }
+
+        if(GLOBAL)
+        {
+            J gst_row_begin = gst_row_offset[row];
+            J gst_row_end   = gst_row_offset[row + 1];
+
+            for(J i = gst_row_begin + lid; i < gst_row_end; i += WF_SIZE)
+            {
+                I c = gst_col[i];
+                T v = gst_val[i];
+
+                connections[i + nnz] = (hip_real(v * v) > hip_real(eps_diag_r * diag[c + nrow]));
+            }
+        }
+    }
+
+    // AMG Aggregate
+    __device__ __forceinline__ unsigned int hash1(unsigned int x)
+    {
+        x = ((x >> 16) ^ x) * 0x45d9f3b;
+        x = ((x >> 16) ^ x) * 0x45d9f3b;
+        x = (x >> 16) ^ x;
+        return x / 2;
+    }
+
+    template <bool GLOBAL, typename I, typename J>
+    __global__ void kernel_csr_amg_init_mis_tuples(int64_t global_column_begin,
+                                                   I       nrow,
+                                                   int64_t nnz,
+                                                   const J* __restrict__ row_offset,
+                                                   const J* __restrict__ gst_row_offset,
+                                                   const bool* __restrict__ connections,
+                                                   int* __restrict__ state,
+                                                   int* __restrict__ hash)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        int s = -2;
+
+        J row_begin = row_offset[row];
+        J row_end   = row_offset[row + 1];
+
+        for(J j = row_begin; j < row_end; j++)
+        {
+            if(connections[j] == true)
+            {
+                s = 0;
+                break;
+            }
+        }
+
+        if(GLOBAL == true)
+        {
+            J gst_row_begin = gst_row_offset[row];
+            J gst_row_end   = gst_row_offset[row + 1];
+
+            for(J j = gst_row_begin; j < gst_row_end; ++j)
+            {
+                if(connections[j + nnz] == true)
+                {
+                    s = 0;
+                    break;
+                }
+            }
+        }
+
+        state[row] = s;
+        hash[row]  = hash1(row + global_column_begin);
+    }
+
+    template <bool GLOBAL, unsigned int BLOCKSIZE, unsigned int WFSIZE, typename I, typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_amg_find_max_node(I       nrow,
+                                          int64_t nnz,
+                                          int64_t global_column_begin,
+                                          int64_t global_column_end,
+                                          const J* __restrict__ row_offset,
+                                          const I* __restrict__ cols,
+                                          const J* __restrict__ gst_row_offset,
+                                          const I* __restrict__ gst_cols,
+                                          const bool* __restrict__ connections,
+                                          const I* __restrict__ state,
+                                          const I* __restrict__ hash,
+                                          const J* __restrict__ bnd_row_offset,
+                                          const int64_t* __restrict__ bnd_cols,
+                                          const I* __restrict__ bnd_state,
+                                          const I* __restrict__ bnd_hash,
+                                          I* __restrict__ max_state,
+                                          int64_t* __restrict__ aggregates,
+                                          bool* undecided)
+    {
+        I tid = threadIdx.x;
+        I gid = blockIdx.x * BLOCKSIZE + tid;
+        I lid = tid & (WFSIZE - 1);
+        I wid = tid / WFSIZE;
+        I row = gid / WFSIZE;
+
+        __shared__ mis_tuple smax_tuple[BLOCKSIZE];
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        smax_tuple[WFSIZE * wid].s = state[row];
+        smax_tuple[WFSIZE * wid].v = hash[row];
+        smax_tuple[WFSIZE * wid].i = row;
+
+        __syncthreads();
+
+        mis_tuple t_max = smax_tuple[WFSIZE * wid];
+
+        // Find distance one max node
+        J row_begin = row_offset[row];
+        J row_end   = row_offset[row + 1];
+
+        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        {
+            if(connections[j] == true)
+            {
+                I col = cols[j];
+
+                mis_tuple tj;
+                tj.s = state[col];
+                tj.v = hash[col];
+                tj.i = col;
+
+                t_max = lexographical_max(&tj, &t_max);
+            }
+        }
+
+        if(GLOBAL)
+        {
+            J gst_row_begin = gst_row_offset[row];
+            J gst_row_end   = gst_row_offset[row + 1];
+
+            for(J j = gst_row_begin + lid; j < gst_row_end; j += WFSIZE)
+            {
+                if(connections[j + nnz] == true)
+                {
+                    I col = gst_cols[j];
+
+                    mis_tuple tj;
+                    tj.s = state[nrow + col];
+                    tj.v = hash[nrow + col];
+                    tj.i = nrow + col;
+
+                    t_max = lexographical_max(&tj, &t_max);
+                }
+            }
+        }
+
+        smax_tuple[WFSIZE * wid + lid] = t_max;
+
+        __syncthreads();
+
+        // Finish reducing the intra block lexographical max
+        if(WFSIZE >= 64)
+        {
+            if(lid < 32)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 32]);
+            __threadfence_block();
+        }
+        if(WFSIZE >= 32)
+        {
+            if(lid < 16)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 16]);
+            __threadfence_block();
+        }
+        if(WFSIZE >= 16)
+        {
+            if(lid < 8)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 8]);
+            __threadfence_block();
+        }
+        if(WFSIZE >= 8)
+        {
+            if(lid < 4)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 4]);
+            __threadfence_block();
+        }
+        if(WFSIZE >= 4)
+        {
+            if(lid < 2)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 2]);
+            __threadfence_block();
+        }
+        if(WFSIZE >= 2)
+        {
+            if(lid < 1)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 1]);
+            __threadfence_block();
+        }
+
+        __syncthreads();
+        t_max = smax_tuple[WFSIZE * wid];
+        __syncthreads();
+
+        // Find distance two max node
+        if(t_max.i < nrow)
+        {
+            I r = t_max.i;
+
+            row_begin = row_offset[r];
+            row_end   = row_offset[r + 1];
+
+            for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+            {
+                if(connections[j] == true)
+                {
+                    I col = cols[j];
+
+                    mis_tuple tj;
+                    tj.s = state[col];
+                    tj.v = hash[col];
+                    tj.i = col;
+
+                    t_max = lexographical_max(&tj, &t_max);
+                }
+            }
+
+            if(GLOBAL)
+            {
+                J gst_row_begin = gst_row_offset[r];
+                J gst_row_end   = gst_row_offset[r + 1];
+
+                for(J j = gst_row_begin + lid; j < gst_row_end; j += WFSIZE)
+                {
+                    if(connections[j + nnz] == true)
+                    {
+                        I col = gst_cols[j];
+
+                        mis_tuple tj;
+                        tj.s = state[nrow + col];
+                        tj.v = hash[nrow + col];
+                        tj.i = nrow + col;
+
+                        t_max = lexographical_max(&tj, &t_max);
+                    }
+                }
+            }
+        }
+        else
+        {
+            J bnd_row_begin = bnd_row_offset[t_max.i - nrow];
+            J bnd_row_end   = bnd_row_offset[t_max.i - nrow + 1];
+
+            for(J j = bnd_row_begin + lid; j < bnd_row_end; j += WFSIZE)
+            {
+                int64_t gcol = bnd_cols[j];
+
+                // Differentiate between local and ghost column
+                I col = -1;
+                if(gcol >= global_column_begin && gcol < global_column_end)
+                {
+                    col = static_cast<I>(gcol - global_column_begin);
+                }
+
+                mis_tuple tj;
+                tj.s = bnd_state[j];
+                tj.v = bnd_hash[j];
+                tj.i = col;
+
+                t_max = lexographical_max(&tj, &t_max);
             }
         }
 
         smax_tuple[WFSIZE * wid + lid] = t_max;
 
-        __syncthreads();
+        __syncthreads();
+
+        // Finish reducing the intra block lexographical max
+        if(WFSIZE >= 64)
+        {
+            if(lid < 32)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 32]);
+            __threadfence_block();
+        }
+        if(WFSIZE >= 32)
+        {
+            if(lid < 16)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 16]);
+            __threadfence_block();
+        }
+        if(WFSIZE >= 16)
+        {
+            if(lid < 8)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 8]);
+            __threadfence_block();
+        }
+        if(WFSIZE >= 8)
+        {
+            if(lid < 4)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 4]);
+            __threadfence_block();
+        }
+        if(WFSIZE >= 4)
+        {
+            if(lid < 2)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 2]);
+            __threadfence_block();
+        }
+        if(WFSIZE >= 2)
+        {
+            if(lid < 1)
+                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
+                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 1]);
+            __threadfence_block();
+        }
+
+        __syncthreads();
+        t_max = smax_tuple[WFSIZE * wid];
+        __syncthreads();
+
+        if(lid == 0)
+        {
+            if(state[row] == 0)
+            {
+                if(t_max.i == row)
+                {
+                    max_state[row]  = 1;
+                    aggregates[row] = 1;
+                }
+                else if(t_max.s == 1)
+                {
+                    max_state[row]  = -1;
+                    aggregates[row] = 0;
+                }
+                else
+                {
+                    *undecided = true;
+                }
+            }
+        }
+    }
+
+    template <bool GLOBAL, typename I, typename J>
+    __global__ void kernel_csr_amg_update_aggregates(I       nrow,
+                                                     int64_t nnz,
+                                                     int64_t global_column_begin,
+                                                     const J* __restrict__ row_offset,
+                                                     const I* __restrict__ cols,
+                                                     const J* __restrict__ gst_row_offset,
+                                                     const I* __restrict__ gst_cols,
+                                                     const bool* __restrict__ connections,
+                                                     const I* __restrict__ state,
+                                                     const int64_t* __restrict__ l2g,
+                                                     I* __restrict__ max_state,
+                                                     int64_t* __restrict__ aggregates,
+                                                     int64_t* __restrict__ aggregate_root_nodes)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        I s = state[row];
+        if(s == -1)
+        {
+            J row_begin = row_offset[row];
+            J row_end   = row_offset[row + 1];
+
+            int64_t global_col = -1;
+            for(J j = row_begin; j < row_end; j++)
+            {
+                if(connections[j] == true)
+                {
+                    I col = cols[j];
+
+                    if(state[col] == 1)
+                    {
+                        aggregates[row]           = aggregates[col];
+                        aggregate_root_nodes[row] = aggregate_root_nodes[col];
+                        max_state[row]            = 1;
+                        global_col                = global_column_begin + col;
+                        break;
+                    }
+                }
+            }
+            if(GLOBAL)
+            {
+                J gst_row_begin = gst_row_offset[row];
+                J gst_row_end   = gst_row_offset[row + 1];
+                for(J j = gst_row_begin; j < gst_row_end; j++)
+                {
+                    if(connections[j + nnz] == true)
+                    {
+                        I col = gst_cols[j];
+                        if(state[col + nrow] == 1)
+                        {
+                            if(global_col == -1 || (global_col >= 0 && l2g[col] < global_col))
+                            {
+                                aggregates[row]           = aggregates[col + nrow];
+                                aggregate_root_nodes[row] = aggregate_root_nodes[col + nrow];
+                                max_state[row]            = 1;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        else if(s == -2)
+        {
+            aggregates[row] = -2;
+        }
+    }
+
+    template <typename I>
+    __global__ void
+        kernel_csr_amg_initialize_aggregate_nodes(I       nrow,
+                                                  I       agg_size,
+                                                  int64_t global_column_begin,
+                                                  const int64_t* __restrict__ aggregates,
+                                                  int64_t* __restrict__ aggregate_root_nodes)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        aggregate_root_nodes[row] = (aggregates[row] == 1) ? global_column_begin + row : -1;
+    }
+
+    // // AMGSmoothedAggregation
+    // template <unsigned int BLOCKSIZE,
+    //           unsigned int WFSIZE,
+    //           unsigned int HASHSIZE,
+    //           typename I,
+    //           typename J>
+    // __launch_bounds__(BLOCKSIZE) __global__
+    //     void kernel_csr_sa_prolong_nnz(I nrow,
+    //                                    const J* __restrict__ row_offsets,
+    //                                    const I* __restrict__ cols,
+    //                                    const bool* __restrict__ connections,
+    //                                    const int64_t* __restrict__ aggregates,
+    //                                    J* __restrict__ pi_row_nnz)
+    // {
+    //     unsigned int lid = threadIdx.x & (WFSIZE - 1);
+    //     unsigned int wid = threadIdx.x / WFSIZE;
+
+    //     if(warpSize == WFSIZE)
+    //     {
+    //         wid = __builtin_amdgcn_readfirstlane(wid);
+    //     }
+
+    //     // The row this thread operates on
+    //     I row = blockIdx.x * (BLOCKSIZE / WFSIZE) + wid;
+
+    //     // Do not run out of bounds
+    //     if(row >= nrow)
+    //     {
+    //         return;
+    //     }
+
+    //     // Shared memory for the unordered set
+    //     __shared__ int64_t int_table[BLOCKSIZE / WFSIZE * HASHSIZE];
+
+    //     // Each wavefront operates on its own set
+    //     unordered_set<int64_t, HASHSIZE, WFSIZE> int_set(&int_table[wid * HASHSIZE]);
+
+    //     // Row nnz counter
+    //     J pi_nnz = 0;
+    //     J pg_nnz = 0;
+
+    //     // Row entry and exit points
+    //     J row_begin = row_offsets[row];
+    //     J row_end   = row_offsets[row + 1];
+
+    //     // Loop over all columns of the i-th row, whereas each lane processes a column
+    //     for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+    //     {
+    //         // Get the column index
+    //         I col = cols[j];
+
+    //         // Get connection state
+    //         bool con = connections[j];
+
+    //         // Get aggregation state for this column
+    //         int64_t agg = aggregates[col];
+
+    //         // When aggregate is defined, diagonal entries and connected columns will
+    //         // generate a fill in
+    //         if((row == col || con) && agg >= 0)
+    //         {
+    //             // Insert into unordered int_set, to discard duplicates
+    //             pi_nnz += int_set.insert(agg);
+    //         }
+    //     }
+
+    //     // Sum up the row nnz from all lanes
+    //     wf_reduce_sum<WFSIZE>(&pi_nnz);
+
+    //     if(lid == WFSIZE - 1)
+    //     {
+    //         // Write row pi_nnz back to global memory
+    //         pi_row_nnz[row] = pi_nnz;
+    //     }
+    // }
+
+    template <bool         GLOBAL,
+              unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              unsigned int HASHSIZE,
+              typename I,
+              typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_sa_prolong_nnz(I       nrow,
+                                       int64_t nnz,
+                                       int64_t global_column_begin,
+                                       int64_t global_column_end,
+                                       const J* __restrict__ row_offsets,
+                                       const I* __restrict__ cols,
+                                       const J* __restrict__ gst_row_offsets,
+                                       const I* __restrict__ gst_cols,
+                                       const bool* __restrict__ connections,
+                                       const int64_t* __restrict__ aggregates,
+                                       const int64_t* __restrict__ aggregate_root_nodes,
+                                       int* f2c,
+                                       J* __restrict__ pi_row_nnz,
+                                       J* __restrict__ pg_row_nnz)
+    {
+        unsigned int lid = threadIdx.x & (WFSIZE - 1);
+        unsigned int wid = threadIdx.x / WFSIZE;
+
+        if(warpSize == WFSIZE)
+        {
+            wid = __builtin_amdgcn_readfirstlane(wid);
+        }
+
+        // The row this thread operates on
+        I row = blockIdx.x * (BLOCKSIZE / WFSIZE) + wid;
+
+        // Do not run out of bounds
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        // Shared memory for the unordered set
+        __shared__ int64_t int_table[BLOCKSIZE / WFSIZE * HASHSIZE];
+        __shared__ int64_t gst_table[BLOCKSIZE / WFSIZE * HASHSIZE];
+
+        // Each wavefront operates on its own set
+        unordered_set<int64_t, HASHSIZE, WFSIZE> int_set(&int_table[wid * HASHSIZE]);
+        unordered_set<int64_t, HASHSIZE, WFSIZE> gst_set(&gst_table[wid * HASHSIZE]);
+
+        // Row nnz counter
+        J pi_nnz = 0;
+        J pg_nnz = 0;
+
+        // Row entry and exit points
+        J row_begin = row_offsets[row];
+        J row_end   = row_offsets[row + 1];
+
+        // Loop over all columns of the i-th row, whereas each lane processes a column
+        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        {
+            // Get the column index
+            I col = cols[j];
+
+            // Get connection state
+            bool con = connections[j];
+
+            // Get aggregation state for this column
+            int64_t agg = aggregates[col];
+
+            // When aggregate is defined, diagonal entries and connected columns will
+            // generate a fill in
+            if((row == col || con) && agg >= 0)
+            {
+                int64_t global_node = aggregate_root_nodes[col];
+
+                if(global_node >= global_column_begin && global_node < global_column_end)
+                {
+                    // Insert into unordered int_set, to discard duplicates
+                    pi_nnz += int_set.insert(global_node);
+                    f2c[global_node - global_column_begin] = 1;
+                }
+                else
+                {
+                    pg_nnz += gst_set.insert(global_node);
+                }
+            }
+        }
+        if(GLOBAL)
+        {
+            J gst_row_begin = gst_row_offsets[row];
+            J gst_row_end   = gst_row_offsets[row + 1];
+            for(J j = gst_row_begin + lid; j < gst_row_end; j += WFSIZE)
+            {
+                // Get the column index
+                I col = gst_cols[j];
+
+                // Get connection state
+                bool con = connections[j + nnz];
+
+                // Get aggregation state for this column
+                int64_t agg = aggregates[col + nrow];
+
+                if(con && agg >= 0)
+                {
+                    int64_t global_node = aggregate_root_nodes[col + nrow];
+
+                    if(global_node >= global_column_begin && global_node < global_column_end)
+                    {
+                        // Insert into unordered int_set, to discard duplicates
+                        pi_nnz += int_set.insert(global_node);
+                        f2c[global_node - global_column_begin] = 1;
+                    }
+                    else
+                    {
+                        pg_nnz += gst_set.insert(global_node);
+                    }
+                }
+            }
+        }
+
+        // Sum up the row nnz from all lanes
+        wf_reduce_sum<WFSIZE>(&pi_nnz);
+
+        if(lid == WFSIZE - 1)
+        {
+            // Write row pi_nnz back to global memory
+            pi_row_nnz[row] = pi_nnz;
+        }
+
+        if(GLOBAL)
+        {
+            wf_reduce_sum<WFSIZE>(&pg_nnz);
+
+            if(lid == WFSIZE - 1)
+            {
+                // Write row pg_nnz back to global memory
+                pg_row_nnz[row] = pg_nnz;
+            }
+        }
+    }
+
+    // template <unsigned int BLOCKSIZE,
+    //           unsigned int WFSIZE,
+    //           unsigned int HASHSIZE,
+    //           typename T,
+    //           typename I,
+    //           typename J>
+    // __launch_bounds__(BLOCKSIZE) __global__
+    //     void kernel_csr_sa_prolong_fill(I   nrow,
+    //                                     T   relax,
+    //                                     int lumping_strat,
+    //                                     const J* __restrict__ row_offsets,
+    //                                     const I* __restrict__ cols,
+    //                                     const T* __restrict__ vals,
+    //                                     const bool* __restrict__ connections,
+    //                                     const int64_t* __restrict__ aggregates,
+    //                                     const J* __restrict__ pi_row_offsets,
+    //                                     I* __restrict__ pi_cols,
+    //                                     T* __restrict__ pi_vals)
+    // {
+    //     unsigned int lid = threadIdx.x & (WFSIZE - 1);
+    //     unsigned int wid = threadIdx.x / WFSIZE;
+
+    //     if(warpSize == WFSIZE)
+    //     {
+    //         wid = __builtin_amdgcn_readfirstlane(wid);
+    //     }
+
+    //     // The row this thread operates on
+    //     I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
+
+    //     // Do not run out of bounds
+    //     if(row >= nrow)
+    //     {
+    //         return;
+    //     }
+
+    //     // Shared memory for the unordered map
+    //     __shared__ int64_t int_table[(BLOCKSIZE / WFSIZE) * HASHSIZE];
+    //     __shared__ char    int_mem[(BLOCKSIZE / WFSIZE) * HASHSIZE * sizeof(T)];
+
+    //     T* int_data = reinterpret_cast<T*>(int_mem);
+
+    //     // Each wavefront operates on its own map
+    //     unordered_map<int64_t, T, HASHSIZE, WFSIZE>   int_map(&int_table[wid * HASHSIZE],
+    //                                                   &int_data[wid * HASHSIZE]);
+
+    //     // Row entry and exit points
+    //     J row_begin = row_offsets[row];
+    //     J row_end   = row_offsets[row + 1];
+
+    //     // Accumulator
+    //     T dia = static_cast<T>(0);
+
+    //     // Loop over all columns of the i-th row, whereas each lane processes a column
+    //     for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+    //     {
+    //         // Get the column index
+    //         I col_j = cols[j];
+
+    //         // Get the value
+    //         T val_j = vals[j];
+
+    //         // Add the diagonal
+    //         if(col_j == row)
+    //         {
+    //             dia += val_j;
+    //         }
+    //         else if(connections[j] == false)
+    //         {
+    //             dia = (lumping_strat == 0) ? dia + val_j : dia - val_j;
+    //         }
+    //     }
+
+    //     // Sum up the accumulator from all lanes
+    //     for(unsigned int i = WFSIZE >> 1; i > 0; i >>= 1)
+    //     {
+    //         dia += hip_shfl_xor(dia, i);
+    //     }
+
+    //     dia = static_cast<T>(1) / dia;
+
+    //     // Loop over all columns of the i-th row, whereas each lane processes a column
+    //     for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+    //     {
+    //         // Get the column index
+    //         I col_j = cols[j];
+
+    //         // Get the value
+    //         T val_j = vals[j];
+
+    //         // Get connection state
+    //         bool con = connections[j];
+
+    //         // Get aggregation state for this column
+    //         int64_t agg = aggregates[col_j];
+
+    //         // When aggregate is defined, diagonal entries and connected columns will
+    //         // generate a fill in
+    //         if((row == col_j || con) && agg >= 0)
+    //         {
+    //             // Insert or add if already present into unordered map
+    //             T val = (col_j == row) ? static_cast<T>(1) - relax : -relax * dia * val_j;
+
+    //             int_map.insert_or_add(agg, val);
+    //         }
+    //     }
+
+    //     // Access into P
+    //     J aj = pi_row_offsets[row];
+
+    //     // Store key val pairs from map into P
+    //     int_map.store_sorted(&pi_cols[aj], &pi_vals[aj]);
+    // }
+
+    template <bool         GLOBAL,
+              unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              unsigned int HASHSIZE,
+              typename T,
+              typename I,
+              typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_sa_prolong_fill(I       nrow,
+                                        int64_t nnz,
+                                        int64_t global_column_begin,
+                                        int64_t global_column_end,
+                                        T       relax,
+                                        int     lumping_strat,
+                                        const J* __restrict__ row_offsets,
+                                        const I* __restrict__ cols,
+                                        const T* __restrict__ vals,
+                                        const J* __restrict__ gst_row_offsets,
+                                        const I* __restrict__ gst_cols,
+                                        const T* __restrict__ gst_vals,
+                                        const bool* __restrict__ connections,
+                                        const int64_t* __restrict__ aggregates,
+                                        const int64_t* __restrict__ aggregate_root_nodes,
+                                        const int* __restrict__ f2c,
+                                        const J* __restrict__ pi_row_offsets,
+                                        I* __restrict__ pi_cols,
+                                        T* __restrict__ pi_vals,
+                                        const J* __restrict__ pg_row_offsets,
+                                        I* __restrict__ pg_cols,
+                                        T* __restrict__ pg_vals,
+                                        int64_t* __restrict__ global_ghost_col)
+    {
+        unsigned int lid = threadIdx.x & (WFSIZE - 1);
+        unsigned int wid = threadIdx.x / WFSIZE;
+
+        if(warpSize == WFSIZE)
+        {
+            wid = __builtin_amdgcn_readfirstlane(wid);
+        }
+
+        // The row this thread operates on
+        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
+
+        // Do not run out of bounds
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        // Shared memory for the unordered map
+        __shared__ int64_t int_table[(BLOCKSIZE / WFSIZE) * HASHSIZE];
+        __shared__ int64_t gst_table[(BLOCKSIZE / WFSIZE) * HASHSIZE];
+        __shared__ char    int_mem[(BLOCKSIZE / WFSIZE) * HASHSIZE * sizeof(T)];
+        __shared__ char    gst_mem[(BLOCKSIZE / WFSIZE) * HASHSIZE * sizeof(T)];
+
+        T* int_data = reinterpret_cast<T*>(int_mem);
+        T* gst_data = reinterpret_cast<T*>(gst_mem);
+
+        // Each wavefront operates on its own map
+        unordered_map<int64_t, T, HASHSIZE, WFSIZE> int_map(&int_table[wid * HASHSIZE],
+                                                            &int_data[wid * HASHSIZE]);
+        unordered_map<int64_t, T, HASHSIZE, WFSIZE> gst_map(&gst_table[wid * HASHSIZE],
+                                                            &gst_data[wid * HASHSIZE]);
+
+        // Row entry and exit points
+        J row_begin = row_offsets[row];
+        J row_end   = row_offsets[row + 1];
+
+        // Accumulator
+        T dia = static_cast<T>(0);
+
+        // Loop over all columns of the i-th row, whereas each lane processes a column
+        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        {
+            // Get the column index
+            I col_j = cols[j];
+
+            // Get the value
+            T val_j = vals[j];
+
+            // Add the diagonal
+            if(col_j == row)
+            {
+                dia += val_j;
+            }
+            else if(connections[j] == false)
+            {
+                dia = (lumping_strat == 0) ? dia + val_j : dia - val_j;
+            }
+        }
+
+        if(GLOBAL)
+        {
+            // Row entry and exit points
+            J gst_row_begin = gst_row_offsets[row];
+            J gst_row_end   = gst_row_offsets[row + 1];
+
+            for(J j = gst_row_begin + lid; j < gst_row_end; j += WFSIZE)
+            {
+                if(connections[j + nnz] == false)
+                {
+                    if(lumping_strat == 0)
+                    {
+                        dia += gst_vals[j];
+                    }
+                    else
+                    {
+                        dia -= gst_vals[j];
+                    }
+                }
+            }
+        }
+
+        // Sum up the accumulator from all lanes
+        for(unsigned int i = WFSIZE >> 1; i > 0; i >>= 1)
+        {
+            dia += hip_shfl_xor(dia, i);
+        }
+
+        dia = static_cast<T>(1) / dia;
+
+        // Loop over all columns of the i-th row, whereas each lane processes a column
+        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        {
+            // Get the column index
+            I col_j = cols[j];
+
+            // Get the value
+            T val_j = vals[j];
+
+            // Get connection state
+            bool con = connections[j];
+
+            // Get aggregation state for this column
+            int64_t agg = aggregates[col_j];
+
+            // When aggregate is defined, diagonal entries and connected columns will
+            // generate a fill in
+            if((row == col_j || con) && agg >= 0)
+            {
+                // Insert or add if already present into unordered map
+                T val = (col_j == row) ? static_cast<T>(1) - relax : -relax * dia * val_j;
+
+                int64_t global_node = aggregate_root_nodes[col_j];
+
+                if(global_node >= global_column_begin && global_node < global_column_end)
+                {
+                    // int_map.insert_or_add(agg, val);
+                    // int_map.insert_or_add(f2c[global_node - global_column_begin], val);
+                    int_map.insert_or_add(global_node, val);
+                }
+                else
+                {
+                    gst_map.insert_or_add(global_node, val);
+                }
+            }
+        }
+
+        if(GLOBAL)
+        {
+            // Row entry and exit points
+            J gst_row_begin = gst_row_offsets[row];
+            J gst_row_end   = gst_row_offsets[row + 1];
+
+            for(J j = gst_row_begin + lid; j < gst_row_end; j += WFSIZE)
+            {
+                // Get the column index
+                I col_j = gst_cols[j];
+
+                // Get the value
+                T val_j = gst_vals[j];
+
+                // Get connection state
+                bool con = connections[j + nnz];
+
+                // Get aggregation state for this column
+                int64_t agg = aggregates[col_j + nrow];
+
+                // When aggregate is defined, diagonal entries and connected columns will
+                // generate a fill in
+                if(con && agg >= 0)
+                {
+                    // Insert or add if already present into unordered map
+                    T val = -relax * dia * val_j;
+
+                    int64_t global_node = aggregate_root_nodes[col_j + nrow];
+
+                    if(global_node >= global_column_begin && global_node < global_column_end)
+                    {
+                        // int_map.insert_or_add(agg, val);
+                        // int_map.insert_or_add(f2c[global_node - global_column_begin], val);
+                        int_map.insert_or_add(global_node, val);
+                    }
+                    else
+                    {
+                        gst_map.insert_or_add(global_node, val);
+                    }
+                }
+            }
+
+            // Access into P
+            J aj = pg_row_offsets[row];
+
+            // Store key val pairs from map into P
+            gst_map.store_sorted(&global_ghost_col[aj], &pg_vals[aj]);
+        }
+
+        // Access into P
+        J aj   = pi_row_offsets[row];
+        J ajp1 = pi_row_offsets[row + 1];
+
+        // Store key val pairs from map into P
+        //int_map.store_sorted(&pi_cols[aj], &pi_vals[aj]);
+        int_map.sort();
+
+        for(J i = aj + lid; i < ajp1; i += WFSIZE)
+        {
+            pi_cols[i] = f2c[int_map.get_key(i - aj) - global_column_begin];
+            pi_vals[i] = int_map.get_val(i - aj);
+        }
+    }
+
+    // AMGUnsmoothedAggregation
+    template <unsigned int BLOCKSIZE, typename I, typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_unsmoothed_prolong_nnz_per_row(I nrow,
+                                                       const int64_t* __restrict__ aggregates,
+                                                       J* __restrict__ prolong_row_offset)
+    {
+        I tid = threadIdx.x;
+        I row = blockIdx.x * BLOCKSIZE + tid;
+        if(row >= nrow)
+        {
+            return;
+        }
+        if(aggregates[row] >= 0)
+        {
+            prolong_row_offset[row + 1] = 1;
+        }
+        else
+        {
+            prolong_row_offset[row + 1] = 0;
+        }
+        if(row == 0)
+        {
+            prolong_row_offset[row] = 0;
+        }
+    }
+
+    template <unsigned int BLOCKSIZE, typename T, typename I>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_unsmoothed_prolong_fill_simple(I nrow,
+                                                       const int64_t* __restrict__ aggregates,
+                                                       I* __restrict__ prolong_cols,
+                                                       T* __restrict__ prolong_vals)
+    {
+        I tid = threadIdx.x;
+        I row = blockIdx.x * BLOCKSIZE + tid;
+        if(row >= nrow)
+        {
+            return;
+        }
+        prolong_cols[row] = aggregates[row];
+        prolong_vals[row] = static_cast<T>(1);
+    }
+
+    template <unsigned int BLOCKSIZE, typename T, typename I, typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_unsmoothed_prolong_fill(I nrow,
+                                                const int64_t* __restrict__ aggregates,
+                                                const J* __restrict__ prolong_row_offset,
+                                                I* __restrict__ prolong_cols,
+                                                T* __restrict__ prolong_vals)
+    {
+        I tid = threadIdx.x;
+        I row = blockIdx.x * BLOCKSIZE + tid;
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        int64_t agg = aggregates[row];
+
+        if(agg >= 0)
+        {
+            J j             = prolong_row_offset[row];
+            prolong_cols[j] = agg;
+            prolong_vals[j] = static_cast<T>(1);
+        }
+    }
+
+    template <unsigned int BLOCKSIZE, typename I, typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_ua_prolong_nnz(I       nrow,
+                                       int64_t global_column_begin,
+                                       int64_t global_column_end,
+                                       const int64_t* __restrict__ aggregates,
+                                       const int64_t* __restrict__ aggregate_root_nodes,
+                                       int* __restrict__ f2c,
+                                       J* __restrict__ pi_row_nnz,
+                                       J* __restrict__ pg_row_nnz)
+    {
+        I tid = threadIdx.x;
+        I row = blockIdx.x * BLOCKSIZE + tid;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        int64_t agg = aggregates[row];
+
+        if(agg >= 0)
+        {
+            int64_t global_node = aggregate_root_nodes[row];
+
+            if(global_node >= global_column_begin && global_node < global_column_end)
+            {
+                pi_row_nnz[row]                        = 1;
+                f2c[global_node - global_column_begin] = 1;
+            }
+            else
+            {
+                pg_row_nnz[row] = 1;
+            }
+        }
+    }
+
+    template <bool GLOBAL, unsigned int BLOCKSIZE, typename T, typename I, typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_ua_prolong_fill(I       nrow,
+                                        int64_t global_column_begin,
+                                        int64_t global_column_end,
+                                        const int64_t* __restrict__ aggregates,
+                                        const int64_t* __restrict__ aggregate_root_nodes,
+                                        const int* __restrict__ f2c,
+                                        const J* __restrict__ pi_row_offsets,
+                                        I* __restrict__ pi_cols,
+                                        T* __restrict__ pi_vals,
+                                        const J* __restrict__ pg_row_offsets,
+                                        I* __restrict__ pg_cols,
+                                        T* __restrict__ pg_vals,
+                                        int64_t* __restrict__ global_ghost_col)
+    {
+        I tid = threadIdx.x;
+        I row = blockIdx.x * BLOCKSIZE + tid;
+
+        if(row >= nrow)
+        {
+            return;
+        }
+
+        int64_t agg = aggregates[row];
+
+        if(agg >= 0)
+        {
+            int64_t global_node = aggregate_root_nodes[row];
+
+            if(global_node >= global_column_begin && global_node < global_column_end)
+            {
+                J pi_row_end = pi_row_offsets[row];
+
+                pi_cols[pi_row_end] = f2c[global_node - global_column_begin];
+                pi_vals[pi_row_end] = 1;
+            }
+            else
+            {
+                J pg_row_end = pg_row_offsets[row];
+
+                pg_vals[pg_row_end]          = 1;
+                global_ghost_col[pg_row_end] = global_node;
+            }
+        }
+    }
+
+    template <typename I, typename J>
+    __global__ void kernel_csr_extract_boundary_state(I       boundary_size,
+                                                      I       nrow,
+                                                      int64_t nnz,
+                                                      const I* __restrict__ boundary_index,
+                                                      const J* __restrict__ csr_row_ptr,
+                                                      const I* __restrict__ csr_col_ind,
+                                                      const J* __restrict__ ghost_csr_row_ptr,
+                                                      const I* __restrict__ ghost_csr_col_ind,
+                                                      const bool* __restrict__ connections,
+                                                      const I* __restrict__ max_state,
+                                                      const I* __restrict__ hash,
+                                                      const J* __restrict__ bnd_row_ptr,
+                                                      I* __restrict__ bnd_max_state,
+                                                      I* __restrict__ bnd_hash)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= boundary_size)
+        {
+            return;
+        }
+
+        // This row is a boundary row
+        I row = boundary_index[gid];
+
+        // Index into boundary array
+        J idx = bnd_row_ptr[gid];
+
+        // Extract interior part
+        J row_begin = csr_row_ptr[row];
+        J row_end   = csr_row_ptr[row + 1];
+
+        // Interior
+        for(J j = row_begin; j < row_end; ++j)
+        {
+            if(connections[j] == true)
+            {
+                I col = csr_col_ind[j];
+
+                bnd_max_state[idx] = max_state[col];
+                bnd_hash[idx]      = hash[col];
+
+                ++idx;
+            }
+        }
+
+        // Extract ghost part
+        row_begin = ghost_csr_row_ptr[row];
+        row_end   = ghost_csr_row_ptr[row + 1];
+
+        for(J j = row_begin; j < row_end; ++j)
+        {
+            if(connections[j + nnz] == true)
+            {
+                I col = ghost_csr_col_ind[j];
+
+                bnd_max_state[idx] = max_state[col + nrow];
+                bnd_hash[idx]      = hash[col + nrow];
+
+                ++idx;
+            }
+        }
+    }
+
+    template <typename I, typename J>
+    __global__ void kernel_csr_merge_interior_ghost_ext_nnz(I       m,
+                                                            I       m_ext,
+                                                            int64_t nnz_gst,
+                                                            const J* __restrict__ int_csr_row_ptr,
+                                                            const J* __restrict__ gst_csr_row_ptr,
+                                                            const J* __restrict__ ext_csr_row_ptr,
+                                                            J* __restrict__ row_nnz)
+    {
+        // Current row
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Count row nnz
+        if(row < m)
+        {
+            int nnz = int_csr_row_ptr[row + 1] - int_csr_row_ptr[row];
+
+            // If ghost part is available
+            if(nnz_gst > 0)
+            {
+                nnz += gst_csr_row_ptr[row + 1] - gst_csr_row_ptr[row];
+            }
+
+            row_nnz[row] = nnz;
+        }
+        else if(row - m < m_ext)
+        {
+            row_nnz[row] = ext_csr_row_ptr[row - m + 1] - ext_csr_row_ptr[row - m];
+        }
+    }
+
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_merge_interior_ghost_nnz(I m,
+                                                        I m_ext,
+                                                        I n,
+                                                        I nnz_gst,
+                                                        const J* __restrict__ int_csr_row_ptr,
+                                                        const I* __restrict__ int_csr_col_ind,
+                                                        const T* __restrict__ int_csr_val,
+                                                        const J* __restrict__ gst_csr_row_ptr,
+                                                        const I* __restrict__ gst_csr_col_ind,
+                                                        const T* __restrict__ gst_csr_val,
+                                                        const J* __restrict__ ext_csr_row_ptr,
+                                                        const I* __restrict__ ext_csr_col_ind,
+                                                        const T* __restrict__ ext_csr_val,
+                                                        const I* __restrict__ ext_gst_csr_col_ind,
+                                                        const J* __restrict__ merged_csr_row_ptr,
+                                                        I* __restrict__ merged_csr_col_ind,
+                                                        T* __restrict__ merged_csr_val)
+    {
+        // Current row
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Access into merged structure
+        J idx = merged_csr_row_ptr[row];
+
+        if(row < m)
+        {
+            // Interior
+            J row_begin = int_csr_row_ptr[row];
+            J row_end   = int_csr_row_ptr[row + 1];
+
+            for(J j = row_begin; j < row_end; ++j)
+            {
+                merged_csr_col_ind[idx] = int_csr_col_ind[j];
+                merged_csr_val[idx]     = int_csr_val[j];
+
+                ++idx;
+            }
+
+            // If ghost is available
+            if(nnz_gst > 0)
+            {
+                J row_begin = gst_csr_row_ptr[row];
+                J row_end   = gst_csr_row_ptr[row + 1];
+
+                for(J j = row_begin; j < row_end; ++j)
+                {
+                    merged_csr_col_ind[idx] = ext_gst_csr_col_ind[j] + n;
+                    merged_csr_val[idx]     = gst_csr_val[j];
+
+                    ++idx;
+                }
+            }
+        }
+        else if(row - m < m_ext)
+        {
+            J row_begin = ext_csr_row_ptr[row - m];
+            J row_end   = ext_csr_row_ptr[row - m + 1];
+
+            for(J j = row_begin; j < row_end; ++j)
+            {
+                merged_csr_col_ind[idx] = ext_csr_col_ind[j];
+                merged_csr_val[idx]     = ext_csr_val[j];
+
+                ++idx;
+            }
+        }
+    }
+
+    // Count the total vertices of this boundary row
+    template <typename I, typename J>
+    __global__ void kernel_csr_extract_boundary_rows_nnz(I boundary_size,
+                                                         const I* __restrict__ boundary_index,
+                                                         const J* __restrict__ int_csr_row_ptr,
+                                                         const J* __restrict__ gst_csr_row_ptr,
+                                                         I* __restrict__ row_nnz)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        // Do not run out of bounds
+        if(gid >= boundary_size)
+        {
+            return;
+        }
+        // Get boundary row
+        I row = boundary_index[gid];
+        // Write total number of nnz for this boundary row
+        row_nnz[gid] = int_csr_row_ptr[row + 1] - int_csr_row_ptr[row] + gst_csr_row_ptr[row + 1]
+                       - gst_csr_row_ptr[row];
+    }
+
+    template <typename I, typename J, typename K>
+    __global__ void kernel_csr_extract_boundary_rows(I boundary_size,
+                                                     const I* __restrict__ boundary_index,
+                                                     K global_col_offset,
+                                                     const J* __restrict__ csr_row_ptr,
+                                                     const I* __restrict__ csr_col_ind,
+                                                     const J* __restrict__ ghost_csr_row_ptr,
+                                                     const I* __restrict__ ghost_csr_col_ind,
+                                                     const K* __restrict__ l2g,
+                                                     const I* __restrict__ send_row_ptr,
+                                                     K* __restrict__ send_col_ind)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= boundary_size)
+        {
+            return;
+        }
+
+        // This row is a boundary row
+        I row = boundary_index[gid];
+
+        // Index into send array
+        I send_row = send_row_ptr[gid];
+
+        // Extract interior part
+        J row_begin = csr_row_ptr[row];
+        J row_end   = csr_row_ptr[row + 1];
+
+        // Interior
+        for(J j = row_begin; j < row_end; ++j)
+        {
+            // Shift column by global column offset, to obtain the global column index
+            send_col_ind[send_row] = csr_col_ind[j] + global_col_offset;
+            ++send_row;
+        }
+
+        // Extract ghost part
+        row_begin = ghost_csr_row_ptr[row];
+        row_end   = ghost_csr_row_ptr[row + 1];
 
-        // Finish reducing the intra block lexographical max
-        if(WFSIZE >= 64)
+        for(J j = row_begin; j < row_end; ++j)
         {
-            if(lid < 32)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 32]);
-            __threadfence_block();
+            // Map the local ghost column to global column
+            send_col_ind[send_row] = l2g[ghost_csr_col_ind[j]];
+            ++send_row;
+        }
+    }
+
+    template <typename T, typename I, typename J, typename K>
+    __global__ void kernel_csr_extract_boundary_rows(I boundary_size,
+                                                     const I* __restrict__ boundary_index,
+                                                     K global_col_offset,
+                                                     const J* __restrict__ csr_row_ptr,
+                                                     const I* __restrict__ csr_col_ind,
+                                                     const T* __restrict__ csr_val,
+                                                     const J* __restrict__ ghost_csr_row_ptr,
+                                                     const I* __restrict__ ghost_csr_col_ind,
+                                                     const T* __restrict__ ghost_csr_val,
+                                                     const K* __restrict__ l2g,
+                                                     const I* __restrict__ send_row_ptr,
+                                                     K* __restrict__ send_col_ind,
+                                                     T* __restrict__ send_val)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= boundary_size)
+        {
+            return;
+        }
+
+        // This row is a boundary row
+        I row = boundary_index[gid];
+
+        // Index into send array
+        I send_row = send_row_ptr[gid];
+
+        // Extract interior part
+        J row_begin = csr_row_ptr[row];
+        J row_end   = csr_row_ptr[row + 1];
+
+        // Interior
+        for(J j = row_begin; j < row_end; ++j)
+        {
+            // Shift column by global column offset, to obtain the global column index
+            send_col_ind[send_row] = csr_col_ind[j] + global_col_offset;
+            send_val[send_row]     = csr_val[j];
+            ++send_row;
+        }
+
+        // Extract ghost part
+        row_begin = ghost_csr_row_ptr[row];
+        row_end   = ghost_csr_row_ptr[row + 1];
+
+        for(J j = row_begin; j < row_end; ++j)
+        {
+            // Map the local ghost column to global column
+            send_col_ind[send_row] = l2g[ghost_csr_col_ind[j]];
+            send_val[send_row]     = ghost_csr_val[j];
+            ++send_row;
+        }
+    }
+
+    template <typename I, typename J>
+    __global__ void kernel_csr_copy_ghost_from_global_nnz(I boundary_size,
+                                                          const I* __restrict__ boundary_index,
+                                                          const I* __restrict__ csr_row_ptr,
+                                                          J* __restrict__ row_nnz)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= boundary_size)
+        {
+            return;
+        }
+
+        // Get boundary row
+        I row = boundary_index[gid];
+
+        // Write total number of nnz for this boundary row
+        atomicAdd(row_nnz + row, csr_row_ptr[gid + 1] - csr_row_ptr[gid]);
+    }
+
+    template <typename T, typename I, typename J, typename K>
+    __global__ void kernel_csr_copy_ghost_from_global(I boundary_size,
+                                                      const I* __restrict__ boundary_index,
+                                                      const I* __restrict__ csr_row_ptr,
+                                                      const K* __restrict__ csr_col_ind,
+                                                      const T* __restrict__ csr_val,
+                                                      J* __restrict__ ext_row_ptr,
+                                                      K* __restrict__ ext_col_ind,
+                                                      T* __restrict__ ext_val)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= boundary_size)
+        {
+            return;
+        }
+
+        // This row is a boundary row
+        I row = boundary_index[gid];
+
+        I row_begin = csr_row_ptr[gid];
+        I row_end   = csr_row_ptr[gid + 1];
+
+        // Index into extracted matrix, we have to use atomics here, because other
+        // blocks might also update this row
+        J idx = atomicAdd(ext_row_ptr + row, row_end - row_begin);
+
+        for(I j = row_begin; j < row_end; ++j)
+        {
+            ext_col_ind[idx] = csr_col_ind[j];
+            ext_val[idx]     = csr_val[j];
+            ++idx;
+        }
+    }
+
+    template <typename I, typename J, typename K>
+    __global__ void kernel_csr_copy_from_global_nnz(I boundary_size,
+                                                    K global_column_begin,
+                                                    K global_column_end,
+                                                    const I* __restrict__ boundary_index,
+                                                    const I* __restrict__ csr_row_ptr,
+                                                    const K* __restrict__ csr_col_ind,
+                                                    J* __restrict__ int_row_nnz,
+                                                    J* __restrict__ gst_row_nnz)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= boundary_size)
+        {
+            return;
+        }
+
+        // Get boundary row
+        I row = boundary_index[gid];
+
+        I int_nnz = 0;
+        I gst_nnz = 0;
+
+        I row_begin = csr_row_ptr[gid];
+        I row_end   = csr_row_ptr[gid + 1];
+
+        for(I j = row_begin; j < row_end; ++j)
+        {
+            K col = csr_col_ind[j];
+
+            if(col >= global_column_begin && col < global_column_end)
+            {
+                // Interior column
+                ++int_nnz;
+            }
+            else
+            {
+                // Ghost column
+                ++gst_nnz;
+            }
+        }
+
+        // Write total number of nnz for this row
+        atomicAdd(int_row_nnz + row, int_nnz);
+        atomicAdd(gst_row_nnz + row, gst_nnz);
+    }
+
+    template <typename T, typename I, typename J, typename K>
+    __global__ void kernel_csr_copy_from_global(I boundary_size,
+                                                K global_column_begin,
+                                                K global_column_end,
+                                                const I* __restrict__ boundary_index,
+                                                const I* __restrict__ csr_row_ptr,
+                                                const K* __restrict__ csr_col_ind,
+                                                const T* __restrict__ csr_val,
+                                                J* __restrict__ int_csr_row_ptr,
+                                                I* __restrict__ int_csr_col_ind,
+                                                T* __restrict__ int_csr_val,
+                                                J* __restrict__ gst_csr_row_ptr,
+                                                K* __restrict__ gst_csr_col_ind,
+                                                T* __restrict__ gst_csr_val)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= boundary_size)
+        {
+            return;
+        }
+
+        // This row is a boundary row
+        I row = boundary_index[gid];
+
+        I row_begin = csr_row_ptr[gid];
+        I row_end   = csr_row_ptr[gid + 1];
+
+        // Pre-determine, how many nnz we are going to add for this boundary row
+        I int_nnz = 0;
+        I gst_nnz = 0;
+
+        for(I j = row_begin; j < row_end; ++j)
+        {
+            K col = csr_col_ind[j];
+
+            if(col >= global_column_begin && col < global_column_end)
+            {
+                // Interior column
+                ++int_nnz;
+            }
+            else
+            {
+                // Ghost column
+                ++gst_nnz;
+            }
+        }
+
+        // Index into extracted matrix, we have to use atomics here, because other
+        // blocks might also update this row
+        I idx_int = atomicAdd(int_csr_row_ptr + row, int_nnz);
+        I idx_gst = atomicAdd(gst_csr_row_ptr + row, gst_nnz);
+
+        for(I j = row_begin; j < row_end; ++j)
+        {
+            K col = csr_col_ind[j];
+
+            if(col >= global_column_begin && col < global_column_end)
+            {
+                // Interior column
+                int_csr_col_ind[idx_int] = col - global_column_begin;
+                int_csr_val[idx_int]     = csr_val[j];
+
+                ++idx_int;
+            }
+            else
+            {
+                // Ghost column
+                gst_csr_col_ind[idx_gst] = col;
+                gst_csr_val[idx_gst]     = csr_val[j];
+
+                ++idx_gst;
+            }
         }
-        if(WFSIZE >= 32)
+    }
+
+    template <typename I>
+    __global__ void kernel_csr_update_numbering(I size,
+                                                const I* __restrict__ counts,
+                                                const I* __restrict__ perm,
+                                                I* __restrict__ out)
+    {
+        I idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(idx >= size)
         {
-            if(lid < 16)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 16]);
-            __threadfence_block();
+            return;
         }
-        if(WFSIZE >= 16)
+
+        // Entry and exit point from run length encode
+        I begin = counts[idx];
+        I end   = counts[idx + 1];
+
+        for(I i = begin; i < end; ++i)
         {
-            if(lid < 8)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 8]);
-            __threadfence_block();
+            out[perm[i]] = idx;
         }
-        if(WFSIZE >= 8)
+    }
+
+    template <typename I, typename J>
+    __global__ void kernel_csr_split_interior_ghost_nnz(I m,
+                                                        const J* __restrict__ csr_row_ptr,
+                                                        const I* __restrict__ csr_col_ind,
+                                                        J* __restrict__ int_row_nnz,
+                                                        J* __restrict__ gst_row_nnz)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(row >= m)
         {
-            if(lid < 4)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 4]);
-            __threadfence_block();
+            return;
         }
-        if(WFSIZE >= 4)
+
+        I int_nnz = 0;
+        I gst_nnz = 0;
+
+        J row_begin = csr_row_ptr[row];
+        J row_end   = csr_row_ptr[row + 1];
+
+        for(J j = row_begin; j < row_end; ++j)
         {
-            if(lid < 2)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 2]);
-            __threadfence_block();
+            I col = csr_col_ind[j];
+
+            if(col >= m)
+            {
+                // This is a ghost column
+                ++gst_nnz;
+            }
+            else
+            {
+                // This is an interior column
+                ++int_nnz;
+            }
         }
-        if(WFSIZE >= 2)
+
+        int_row_nnz[row] = int_nnz;
+        gst_row_nnz[row] = gst_nnz;
+    }
+
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_split_interior_ghost(I m,
+                                                    const J* __restrict__ csr_row_ptr,
+                                                    const I* __restrict__ csr_col_ind,
+                                                    const T* __restrict__ csr_val,
+                                                    const J* __restrict__ int_csr_row_ptr,
+                                                    I* __restrict__ int_csr_col_ind,
+                                                    T* __restrict__ int_csr_val,
+                                                    const J* __restrict__ gst_csr_row_ptr,
+                                                    I* __restrict__ gst_csr_col_ind,
+                                                    T* __restrict__ gst_csr_val)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(row >= m)
         {
-            if(lid < 1)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 1]);
-            __threadfence_block();
+            return;
         }
 
-        __syncthreads();
-        t_max = smax_tuple[WFSIZE * wid];
-        __syncthreads();
+        J row_begin = csr_row_ptr[row];
+        J row_end   = csr_row_ptr[row + 1];
 
-        // Find distance two max node
-        if(t_max.i < nrow)
-        {
-            I r = t_max.i;
+        J idx_int = int_csr_row_ptr[row];
+        J idx_gst = gst_csr_row_ptr[row];
 
-            row_begin = row_offset[r];
-            row_end   = row_offset[r + 1];
+        for(J j = row_begin; j < row_end; ++j)
+        {
+            I col = csr_col_ind[j];
 
-            for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+            if(col >= m)
             {
-                if(connections[j] == true)
-                {
-                    I col = cols[j];
+                // This is a ghost column
+                gst_csr_col_ind[idx_gst] = col - m;
+                gst_csr_val[idx_gst]     = csr_val[j];
 
-                    mis_tuple tj;
-                    tj.s = state[col];
-                    tj.v = hash[col];
-                    tj.i = col;
+                ++idx_gst;
+            }
+            else
+            {
+                // This is an interior column
+                int_csr_col_ind[idx_int] = col;
+                int_csr_val[idx_int]     = csr_val[j];
 
-                    t_max = lexographical_max(&tj, &t_max);
-                }
+                ++idx_int;
             }
+        }
+    }
 
-            if(GLOBAL)
-            {
-                J gst_row_begin = gst_row_offset[r];
-                J gst_row_end   = gst_row_offset[r + 1];
+    template <typename I, typename K>
+    __global__ void kernel_csr_extract_global_column_indices(I ncol,
+                                                             I nnz,
+                                                             K global_offset,
+                                                             const I* __restrict__ csr_col_ind,
+                                                             const K* __restrict__ l2g,
+                                                             K* __restrict__ global_col)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
 
-                for(J j = gst_row_begin + lid; j < gst_row_end; j += WFSIZE)
-                {
-                    if(connections[j + nnz] == true)
-                    {
-                        I col = gst_cols[j];
+        // Do not run out of bounds
+        if(gid >= nnz)
+        {
+            return;
+        }
 
-                        mis_tuple tj;
-                        tj.s = state[nrow + col];
-                        tj.v = hash[nrow + col];
-                        tj.i = nrow + col;
+        int local_col = csr_col_ind[gid];
 
-                        t_max = lexographical_max(&tj, &t_max);
-                    }
-                }
-            }
+        if(local_col >= ncol)
+        {
+            // This is an ext column, map to global
+            global_col[gid] = l2g[local_col - ncol];
         }
         else
         {
-            J bnd_row_begin = bnd_row_offset[t_max.i - nrow];
-            J bnd_row_end   = bnd_row_offset[t_max.i - nrow + 1];
+            // This is a local column, shift by offset
+            global_col[gid] = local_col + global_offset;
+        }
+    }
 
-            for(J j = bnd_row_begin + lid; j < bnd_row_end; j += WFSIZE)
-            {
-                int64_t gcol = bnd_cols[j];
+    template <typename I, typename K>
+    __global__ void kernel_csr_renumber_global_to_local_count(I nnz,
+                                                              const K* __restrict__ global_sorted,
+                                                              I* __restrict__ local_col)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
 
-                // Differentiate between local and ghost column
-                I col = -1;
-                if(gcol >= global_column_begin && gcol < global_column_end)
-                {
-                    col = static_cast<I>(gcol - global_column_begin);
-                }
+        // Do not run out of bounds
+        if(gid >= nnz)
+        {
+            return;
+        }
 
-                mis_tuple tj;
-                tj.s = bnd_state[j];
-                tj.v = bnd_hash[j];
-                tj.i = col;
+        // First column entry cannot be a duplicate
+        if(gid == 0)
+        {
+            local_col[0] = 1;
 
-                t_max = lexographical_max(&tj, &t_max);
-            }
+            return;
         }
 
-        smax_tuple[WFSIZE * wid + lid] = t_max;
-
-        __syncthreads();
+        // Get global column
+        K global_col = global_sorted[gid];
+        K prev_col   = global_sorted[gid - 1];
 
-        // Finish reducing the intra block lexographical max
-        if(WFSIZE >= 64)
+        // Compare column indices
+        if(global_col == prev_col)
         {
-            if(lid < 32)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 32]);
-            __threadfence_block();
+            // Same index as previous column
+            local_col[gid] = 0;
         }
-        if(WFSIZE >= 32)
+        else
         {
-            if(lid < 16)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 16]);
-            __threadfence_block();
+            // New local column index
+            local_col[gid] = 1;
         }
-        if(WFSIZE >= 16)
-        {
-            if(lid < 8)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 8]);
-            __threadfence_block();
+    }
+
+    template <typename I>
+    __global__ void kernel_csr_renumber_global_to_local_fill(I nnz,
+                                                             const I* __restrict__ local_col,
+                                                             const I* __restrict__ perm,
+                                                             I* __restrict__ csr_col_ind)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= nnz)
+        {
+            return;
         }
-        if(WFSIZE >= 8)
+
+        // Back permutation into matrix
+        csr_col_ind[perm[gid]] = local_col[gid] - 1;
+    }
+
+    template <typename I, typename K>
+    __global__ void kernel_csr_local_to_global(I nnz,
+                                               const K* __restrict__ l2g,
+                                               const I* __restrict__ local,
+                                               K* __restrict__ global)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= nnz)
         {
-            if(lid < 4)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 4]);
-            __threadfence_block();
+            return;
         }
-        if(WFSIZE >= 4)
+
+        // Convert local to global
+        global[gid] = l2g[local[gid]];
+    }
+
+    template <typename I, typename K>
+    __global__ void kernel_csr_ghost_columns_nnz(int64_t size,
+                                                 K       global_column_begin,
+                                                 K       global_column_end,
+                                                 const K* __restrict__ in,
+                                                 I* __restrict__ nnz)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= size)
         {
-            if(lid < 2)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 2]);
-            __threadfence_block();
+            return;
         }
-        if(WFSIZE >= 2)
+
+        // Get global column id
+        K col = in[gid];
+
+        // Count this column if its not interior
+        nnz[gid] = (col < global_column_begin || col >= global_column_end) ? 1 : 0;
+    }
+
+    template <typename I, typename K>
+    __global__ void kernel_csr_ghost_columns_fill(int64_t nnz,
+                                                  K       global_column_begin,
+                                                  K       global_column_end,
+                                                  const K* __restrict__ in,
+                                                  const I* __restrict__ nnz_ptr,
+                                                  K* __restrict__ out)
+    {
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+
+        // Do not run out of bounds
+        if(gid >= nnz)
         {
-            if(lid < 1)
-                smax_tuple[WFSIZE * wid + lid] = lexographical_max(
-                    &smax_tuple[WFSIZE * wid + lid], &smax_tuple[WFSIZE * wid + lid + 1]);
-            __threadfence_block();
+            return;
         }
 
-        __syncthreads();
-        t_max = smax_tuple[WFSIZE * wid];
-        __syncthreads();
+        // Get global column id
+        K col = in[gid];
 
-        if(lid == 0)
+        // Count this column if its not interior
+        if(col < global_column_begin || col >= global_column_end)
         {
-            if(state[row] == 0)
-            {
-                if(t_max.i == row)
-                {
-                    max_state[row]  = 1;
-                    aggregates[row] = 1;
-                }
-                else if(t_max.s == 1)
-                {
-                    max_state[row]  = -1;
-                    aggregates[row] = 0;
-                }
-                else
-                {
-                    *undecided = true;
-                }
-            }
+            out[nnz_ptr[gid]] = col;
         }
     }
 
-    template <bool GLOBAL, typename I, typename J>
-    __global__ void kernel_csr_amg_update_aggregates(I       nrow,
-                                                     int64_t nnz,
-                                                     int64_t global_column_begin,
-                                                     const J* __restrict__ row_offset,
-                                                     const I* __restrict__ cols,
-                                                     const J* __restrict__ gst_row_offset,
-                                                     const I* __restrict__ gst_cols,
-                                                     const bool* __restrict__ connections,
-                                                     const I* __restrict__ state,
-                                                     const int64_t* __restrict__ l2g,
-                                                     I* __restrict__ max_state,
-                                                     int64_t* __restrict__ aggregates,
-                                                     int64_t* __restrict__ aggregate_root_nodes)
+    template <typename I, typename K>
+    __global__ void kernel_csr_column_id_transfer(int64_t nnz,
+                                                  I       ncol,
+                                                  K       global_column_begin,
+                                                  K       global_column_end,
+                                                  const K* __restrict__ global,
+                                                  const I* __restrict__ cmb,
+                                                  const I* __restrict__ nnz_ptr,
+                                                  I* __restrict__ out)
     {
-        I row = blockIdx.x * blockDim.x + threadIdx.x;
+        I gid = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(row >= nrow)
+        // Do not run out of bounds
+        if(gid >= nnz)
         {
             return;
         }
 
-        I s = state[row];
-        if(s == -1)
-        {
-            J row_begin = row_offset[row];
-            J row_end   = row_offset[row + 1];
-
-            int64_t global_col = -1;
-            for(J j = row_begin; j < row_end; j++)
-            {
-                if(connections[j] == true)
-                {
-                    I col = cols[j];
+        K global_col = global[gid];
 
-                    if(state[col] == 1)
-                    {
-                        aggregates[row]           = aggregates[col];
-                        aggregate_root_nodes[row] = aggregate_root_nodes[col];
-                        max_state[row]            = 1;
-                        global_col                = global_column_begin + col;
-                        break;
-                    }
-                }
-            }
-            if(GLOBAL)
-            {
-                J gst_row_begin = gst_row_offset[row];
-                J gst_row_end   = gst_row_offset[row + 1];
-                for(J j = gst_row_begin; j < gst_row_end; j++)
-                {
-                    if(connections[j + nnz] == true)
-                    {
-                        I col = gst_cols[j];
-                        if(state[col + nrow] == 1)
-                        {
-                            if(global_col == -1 || (global_col >= 0 && l2g[col] < global_col))
-                            {
-                                aggregates[row]           = aggregates[col + nrow];
-                                aggregate_root_nodes[row] = aggregate_root_nodes[col + nrow];
-                                max_state[row]            = 1;
-                                break;
-                            }
-                        }
-                    }
-                }
-            }
+        // Filter external source to match given column id interval
+        if(global_col >= global_column_begin && global_col < global_column_end)
+        {
+            // Map column into interval
+            out[gid] = global_col - global_column_begin;
         }
-        else if(s == -2)
+        else
         {
-            aggregates[row] = -2;
+            out[gid] = cmb[nnz_ptr[gid]] + ncol;
         }
     }
 
-    template <typename I>
-    __global__ void
-        kernel_csr_amg_initialize_aggregate_nodes(I       nrow,
-                                                  I       agg_size,
-                                                  int64_t global_column_begin,
-                                                  const int64_t* __restrict__ aggregates,
-                                                  int64_t* __restrict__ aggregate_root_nodes)
+    // Count the number of nnz per row of two matrices
+    template <typename I, typename J>
+    __global__ void kernel_csr_combined_row_nnz(I m,
+                                                const J* __restrict__ csr_row_ptr_A,
+                                                const J* __restrict__ csr_row_ptr_B,
+                                                J* __restrict__ row_nnz)
     {
         I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(row >= nrow)
+        // Do not run out of bounds
+        if(row >= m)
         {
             return;
         }
 
-        aggregate_root_nodes[row] = (aggregates[row] == 1) ? global_column_begin + row : -1;
+        // Write combined number of row nnz for this row
+        row_nnz[row] = csr_row_ptr_A[row + 1] - csr_row_ptr_A[row] + csr_row_ptr_B[row + 1]
+                       - csr_row_ptr_B[row];
     }
 
-    // // AMGSmoothedAggregation
-    // template <unsigned int BLOCKSIZE,
-    //           unsigned int WFSIZE,
-    //           unsigned int HASHSIZE,
-    //           typename I,
-    //           typename J>
-    // __launch_bounds__(BLOCKSIZE) __global__
-    //     void kernel_csr_sa_prolong_nnz(I nrow,
-    //                                    const J* __restrict__ row_offsets,
-    //                                    const I* __restrict__ cols,
-    //                                    const bool* __restrict__ connections,
-    //                                    const int64_t* __restrict__ aggregates,
-    //                                    J* __restrict__ pi_row_nnz)
-    // {
-    //     unsigned int lid = threadIdx.x & (WFSIZE - 1);
-    //     unsigned int wid = threadIdx.x / WFSIZE;
-
-    //     if(warpSize == WFSIZE)
-    //     {
-    //         wid = __builtin_amdgcn_readfirstlane(wid);
-    //     }
+    template <bool         GLOBAL,
+              unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              unsigned int HASHSIZE,
+              typename I,
+              typename J,
+              typename K>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_compress_add_nnz(I m,
+                                         const J* __restrict__ csr_row_ptr_A,
+                                         const I* __restrict__ csr_col_ind_A,
+                                         const J* __restrict__ csr_row_ptr_B,
+                                         const K* __restrict__ csr_col_ind_B,
+                                         const K* __restrict__ l2g,
+                                         J* __restrict__ row_nnz)
+    {
+        unsigned int lid = threadIdx.x & (WFSIZE - 1);
+        unsigned int wid = threadIdx.x / WFSIZE;
 
-    //     // The row this thread operates on
-    //     I row = blockIdx.x * (BLOCKSIZE / WFSIZE) + wid;
+        // The row this thread operates on
+        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
 
-    //     // Do not run out of bounds
-    //     if(row >= nrow)
-    //     {
-    //         return;
-    //     }
+        // Do not run out of bounds
+        if(row >= m)
+        {
+            return;
+        }
 
-    //     // Shared memory for the unordered set
-    //     __shared__ int64_t int_table[BLOCKSIZE / WFSIZE * HASHSIZE];
+        // Row nnz counter
+        I nnz = 0;
 
-    //     // Each wavefront operates on its own set
-    //     unordered_set<int64_t, HASHSIZE, WFSIZE> int_set(&int_table[wid * HASHSIZE]);
+        // Shared memory for the unordered set
+        __shared__ K sdata[BLOCKSIZE / WFSIZE * HASHSIZE];
 
-    //     // Row nnz counter
-    //     J pi_nnz = 0;
-    //     J pg_nnz = 0;
+        // Each wavefront operates on its own set
+        unordered_set<K, HASHSIZE, WFSIZE> set(&sdata[wid * HASHSIZE]);
 
-    //     // Row entry and exit points
-    //     J row_begin = row_offsets[row];
-    //     J row_end   = row_offsets[row + 1];
+        // Row entry and exit points of A
+        J row_begin_A = csr_row_ptr_A[row];
+        J row_end_A   = csr_row_ptr_A[row + 1];
 
-    //     // Loop over all columns of the i-th row, whereas each lane processes a column
-    //     for(J j = row_begin + lid; j < row_end; j += WFSIZE)
-    //     {
-    //         // Get the column index
-    //         I col = cols[j];
+        // Loop over all columns of the i-th row, whereas each lane processes a column
+        for(J j = row_begin_A + lid; j < row_end_A; j += WFSIZE)
+        {
+            // Get the column index
+            K col_j = GLOBAL ? l2g[csr_col_ind_A[j]] : csr_col_ind_A[j];
 
-    //         // Get connection state
-    //         bool con = connections[j];
+            // Add column to the set
+            nnz += set.insert(col_j);
+        }
 
-    //         // Get aggregation state for this column
-    //         int64_t agg = aggregates[col];
+        // Row entry and exit points of B
+        J row_begin_B = csr_row_ptr_B[row];
+        J row_end_B   = csr_row_ptr_B[row + 1];
 
-    //         // When aggregate is defined, diagonal entries and connected columns will
-    //         // generate a fill in
-    //         if((row == col || con) && agg >= 0)
-    //         {
-    //             // Insert into unordered int_set, to discard duplicates
-    //             pi_nnz += int_set.insert(agg);
-    //         }
-    //     }
+        // Loop over all columns of the i-th row, whereas each lane processes a column
+        for(J j = row_begin_B + lid; j < row_end_B; j += WFSIZE)
+        {
+            // Add column to the set
+            nnz += set.insert(csr_col_ind_B[j]);
+        }
 
-    //     // Sum up the row nnz from all lanes
-    //     wf_reduce_sum<WFSIZE>(&pi_nnz);
+        // Sum up the row nnz from all lanes
+        wf_reduce_sum<WFSIZE>(&nnz);
 
-    //     if(lid == WFSIZE - 1)
-    //     {
-    //         // Write row pi_nnz back to global memory
-    //         pi_row_nnz[row] = pi_nnz;
-    //     }
-    // }
+        // Last lane in wavefront writes row nnz back to global memory
+        if(lid == WFSIZE - 1)
+        {
+            row_nnz[row] = nnz;
+        }
+    }
 
     template <bool         GLOBAL,
               unsigned int BLOCKSIZE,
               unsigned int WFSIZE,
               unsigned int HASHSIZE,
+              typename T,
               typename I,
-              typename J>
+              typename J,
+              typename K>
     __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_sa_prolong_nnz(I       nrow,
-                                       int64_t nnz,
-                                       int64_t global_column_begin,
-                                       int64_t global_column_end,
-                                       const J* __restrict__ row_offsets,
-                                       const I* __restrict__ cols,
-                                       const J* __restrict__ gst_row_offsets,
-                                       const I* __restrict__ gst_cols,
-                                       const bool* __restrict__ connections,
-                                       const int64_t* __restrict__ aggregates,
-                                       const int64_t* __restrict__ aggregate_root_nodes,
-                                       int* f2c,
-                                       J* __restrict__ pi_row_nnz,
-                                       J* __restrict__ pg_row_nnz)
+        void kernel_csr_compress_add_fill(I m,
+                                          const J* __restrict__ csr_row_ptr_A,
+                                          const I* __restrict__ csr_col_ind_A,
+                                          const T* __restrict__ csr_val_A,
+                                          const J* __restrict__ csr_row_ptr_B,
+                                          const K* __restrict__ csr_col_ind_B,
+                                          const T* __restrict__ csr_val_B,
+                                          const K* __restrict__ l2g,
+                                          const J* __restrict__ csr_row_ptr_C,
+                                          K* __restrict__ csr_col_ind_C,
+                                          T* __restrict__ csr_val_C)
     {
         unsigned int lid = threadIdx.x & (WFSIZE - 1);
         unsigned int wid = threadIdx.x / WFSIZE;
 
-        if(warpSize == WFSIZE)
-        {
-            wid = __builtin_amdgcn_readfirstlane(wid);
-        }
-
         // The row this thread operates on
-        I row = blockIdx.x * (BLOCKSIZE / WFSIZE) + wid;
+        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
 
         // Do not run out of bounds
-        if(row >= nrow)
+        if(row >= m)
         {
             return;
         }
 
-        // Shared memory for the unordered set
-        __shared__ int64_t int_table[BLOCKSIZE / WFSIZE * HASHSIZE];
-        __shared__ int64_t gst_table[BLOCKSIZE / WFSIZE * HASHSIZE];
+        // Shared memory for the map
+        extern __shared__ char smem[];
 
-        // Each wavefront operates on its own set
-        unordered_set<int64_t, HASHSIZE, WFSIZE> int_set(&int_table[wid * HASHSIZE]);
-        unordered_set<int64_t, HASHSIZE, WFSIZE> gst_set(&gst_table[wid * HASHSIZE]);
+        K* stable = reinterpret_cast<K*>(smem);
+        T* sdata  = reinterpret_cast<T*>(stable + BLOCKSIZE / WFSIZE * HASHSIZE);
 
-        // Row nnz counter
-        J pi_nnz = 0;
-        J pg_nnz = 0;
+        // Each wavefront operates on its own map
+        unordered_map<K, T, HASHSIZE, WFSIZE> map(&stable[wid * HASHSIZE], &sdata[wid * HASHSIZE]);
 
-        // Row entry and exit points
-        J row_begin = row_offsets[row];
-        J row_end   = row_offsets[row + 1];
+        // Row entry and exit points of A
+        J row_begin_A = csr_row_ptr_A[row];
+        J row_end_A   = csr_row_ptr_A[row + 1];
 
         // Loop over all columns of the i-th row, whereas each lane processes a column
-        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        for(J j = row_begin_A + lid; j < row_end_A; j += WFSIZE)
         {
-            // Get the column index
-            I col = cols[j];
+            // Get the column index and value
+            K col_j = GLOBAL ? l2g[csr_col_ind_A[j]] : csr_col_ind_A[j];
 
-            // Get connection state
-            bool con = connections[j];
+            // Accumulate
+            map.insert_or_add(col_j, csr_val_A[j]);
+        }
 
-            // Get aggregation state for this column
-            int64_t agg = aggregates[col];
+        // Row entry and exit points of B
+        J row_begin_B = csr_row_ptr_B[row];
+        J row_end_B   = csr_row_ptr_B[row + 1];
 
-            // When aggregate is defined, diagonal entries and connected columns will
-            // generate a fill in
-            if((row == col || con) && agg >= 0)
+        // Loop over all columns of the i-th row, whereas each lane processes a column
+        for(J j = row_begin_B + lid; j < row_end_B; j += WFSIZE)
+        {
+            // Accumulate
+            map.insert_or_add(csr_col_ind_B[j], csr_val_B[j]);
+        }
+
+        // Finally, extract the numerical values from the hash map and fill C such
+        // that the resulting matrix is sorted by columns
+        for(unsigned int i = lid; i < HASHSIZE; i += WFSIZE)
+        {
+            // Get column from map to fill into C
+            K col = map.get_key(i);
+
+            // Skip, if table is empty
+            if(col == map.empty_key())
             {
-                int64_t global_node = aggregate_root_nodes[col];
+                continue;
+            }
 
-                if(global_node >= global_column_begin && global_node < global_column_end)
-                {
-                    // Insert into unordered int_set, to discard duplicates
-                    pi_nnz += int_set.insert(global_node);
-                    f2c[global_node - global_column_begin] = 1;
-                }
-                else
+            // Get index into C
+            J idx = csr_row_ptr_C[row];
+
+            // Hash table index counter
+            unsigned int cnt = 0;
+
+            // Go through the hash table, until we reach its end
+            while(cnt < HASHSIZE)
+            {
+                // We are searching for the right place in C to
+                // insert the i-th hash table entry.
+                // If the i-th hash table column entry is greater then the current one,
+                // we need to leave a slot to its left.
+                if(col > map.get_key(cnt))
                 {
-                    pg_nnz += gst_set.insert(global_node);
+                    ++idx;
                 }
+
+                // Process next hash table entry
+                ++cnt;
             }
+
+            // Add hash table entry into P
+            csr_col_ind_C[idx] = col;
+            csr_val_C[idx]     = map.get_val(i);
         }
-        if(GLOBAL)
+    }
+
+    // Unique random weight of a vertex for the parallel graph coloring, the vertex
+    // index in the lower bits breaks ties of the hash
+    template <typename I>
+    __device__ __forceinline__ unsigned long long coloring_weight(I i)
+    {
+        unsigned int x = static_cast<unsigned int>(i);
+
+        x = ((x >> 16) ^ x) * 0x45d9f3b;
+        x = ((x >> 16) ^ x) * 0x45d9f3b;
+        x = (x >> 16) ^ x;
+
+        return (static_cast<unsigned long long>(x) << 32) | static_cast<unsigned int>(i);
+    }
+
+    // Jones-Plassmann coloring, step 1: determine the largest and smallest weight of all
+    // uncolored neighbors of each uncolored vertex. Since the sparsity pattern does not
+    // need to be symmetric, weights are also scattered to the columns, such that the
+    // adjacency of A + A^T is taken into account.
+    template <typename I, typename J>
+    __global__ void kernel_csr_coloring_neighbor_weights(I nrow,
+                                                         const J* __restrict__ row_offset,
+                                                         const I* __restrict__ col,
+                                                         const I* __restrict__ color,
+                                                         unsigned long long* __restrict__ wmax,
+                                                         unsigned long long* __restrict__ wmin)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
-            J gst_row_begin = gst_row_offsets[row];
-            J gst_row_end   = gst_row_offsets[row + 1];
-            for(J j = gst_row_begin + lid; j < gst_row_end; j += WFSIZE)
-            {
-                // Get the column index
-                I col = gst_cols[j];
+            return;
+        }
 
-                // Get connection state
-                bool con = connections[j + nnz];
+        if(color[ai] != 0)
+        {
+            return;
+        }
 
-                // Get aggregation state for this column
-                int64_t agg = aggregates[col + nrow];
+        unsigned long long w    = coloring_weight(ai);
+        unsigned long long rmax = 0;
+        unsigned long long rmin = ~0ULL;
 
-                if(con && agg >= 0)
-                {
-                    int64_t global_node = aggregate_root_nodes[col + nrow];
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            I c = col[aj];
 
-                    if(global_node >= global_column_begin && global_node < global_column_end)
-                    {
-                        // Insert into unordered int_set, to discard duplicates
-                        pi_nnz += int_set.insert(global_node);
-                        f2c[global_node - global_column_begin] = 1;
-                    }
-                    else
-                    {
-                        pg_nnz += gst_set.insert(global_node);
-                    }
-                }
+            if(c == ai || color[c] != 0)
+            {
+                continue;
             }
+
+            unsigned long long wc = coloring_weight(c);
+
+            rmax = (wc > rmax) ? wc : rmax;
+            rmin = (wc < rmin) ? wc : rmin;
+
+            atomicMax(&wmax[c], w);
+            atomicMin(&wmin[c], w);
         }
 
-        // Sum up the row nnz from all lanes
-        wf_reduce_sum<WFSIZE>(&pi_nnz);
+        atomicMax(&wmax[ai], rmax);
+        atomicMin(&wmin[ai], rmin);
+    }
+
+    // Jones-Plassmann coloring, step 2: local maxima get the first and local minima the
+    // second color of this round, all other uncolored vertices are counted
+    template <typename I>
+    __global__ void kernel_csr_coloring_assign(I      nrow,
+                                               I      color_max,
+                                               const unsigned long long* __restrict__ wmax,
+                                               const unsigned long long* __restrict__ wmin,
+                                               I* __restrict__ color,
+                                               I* __restrict__ uncolored)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(lid == WFSIZE - 1)
+        if(ai >= nrow)
         {
-            // Write row pi_nnz back to global memory
-            pi_row_nnz[row] = pi_nnz;
+            return;
         }
 
-        if(GLOBAL)
+        if(color[ai] != 0)
         {
-            wf_reduce_sum<WFSIZE>(&pg_nnz);
+            return;
+        }
 
-            if(lid == WFSIZE - 1)
-            {
-                // Write row pg_nnz back to global memory
-                pg_row_nnz[row] = pg_nnz;
-            }
+        unsigned long long w = coloring_weight(ai);
+
+        if(w > wmax[ai])
+        {
+            color[ai] = color_max;
+        }
+        else if(w < wmin[ai])
+        {
+            color[ai] = color_max + 1;
+        }
+        else
+        {
+            atomicAdd(uncolored, 1);
         }
     }
 
-    // template <unsigned int BLOCKSIZE,
-    //           unsigned int WFSIZE,
-    //           unsigned int HASHSIZE,
-    //           typename T,
-    //           typename I,
-    //           typename J>
-    // __launch_bounds__(BLOCKSIZE) __global__
-    //     void kernel_csr_sa_prolong_fill(I   nrow,
-    //                                     T   relax,
-    //                                     int lumping_strat,
-    //                                     const J* __restrict__ row_offsets,
-    //                                     const I* __restrict__ cols,
-    //                                     const T* __restrict__ vals,
-    //                                     const bool* __restrict__ connections,
-    //                                     const int64_t* __restrict__ aggregates,
-    //                                     const J* __restrict__ pi_row_offsets,
-    //                                     I* __restrict__ pi_cols,
-    //                                     T* __restrict__ pi_vals)
-    // {
-    //     unsigned int lid = threadIdx.x & (WFSIZE - 1);
-    //     unsigned int wid = threadIdx.x / WFSIZE;
+    // Count the vertices of each color
+    template <typename I>
+    __global__ void kernel_csr_coloring_count(I nrow,
+                                              const I* __restrict__ color,
+                                              I* __restrict__ size_colors)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-    //     if(warpSize == WFSIZE)
-    //     {
-    //         wid = __builtin_amdgcn_readfirstlane(wid);
-    //     }
+        if(ai >= nrow)
+        {
+            return;
+        }
 
-    //     // The row this thread operates on
-    //     I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
+        atomicAdd(&size_colors[color[ai] - 1], 1);
+    }
 
-    //     // Do not run out of bounds
-    //     if(row >= nrow)
-    //     {
-    //         return;
-    //     }
+    // Renumber the colors (1-based) such that empty colors are removed
+    template <typename I>
+    __global__ void kernel_csr_coloring_compress(I nrow,
+                                                 const I* __restrict__ map,
+                                                 I* __restrict__ color)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-    //     // Shared memory for the unordered map
-    //     __shared__ int64_t int_table[(BLOCKSIZE / WFSIZE) * HASHSIZE];
-    //     __shared__ char    int_mem[(BLOCKSIZE / WFSIZE) * HASHSIZE * sizeof(T)];
+        if(ai >= nrow)
+        {
+            return;
+        }
 
-    //     T* int_data = reinterpret_cast<T*>(int_mem);
+        color[ai] = map[color[ai] - 1];
+    }
 
-    //     // Each wavefront operates on its own map
-    //     unordered_map<int64_t, T, HASHSIZE, WFSIZE>   int_map(&int_table[wid * HASHSIZE],
-    //                                                   &int_data[wid * HASHSIZE]);
+    // Assign consecutive labels, starting at label_begin, to size vertices
+    // in the given order, i.e. perm[order[i]] = label_begin + i
+    template <typename I>
+    __global__ void kernel_csr_cmk_label(I size,
+                                         I label_begin,
+                                         const I* __restrict__ order,
+                                         I* __restrict__ perm)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-    //     // Row entry and exit points
-    //     J row_begin = row_offsets[row];
-    //     J row_end   = row_offsets[row + 1];
+        if(ai >= size)
+        {
+            return;
+        }
 
-    //     // Accumulator
-    //     T dia = static_cast<T>(0);
+        perm[order[ai]] = label_begin + ai;
+    }
 
-    //     // Loop over all columns of the i-th row, whereas each lane processes a column
-    //     for(J j = row_begin + lid; j < row_end; j += WFSIZE)
-    //     {
-    //         // Get the column index
-    //         I col_j = cols[j];
+    // Level-synchronous BFS step of the Cuthill-McKee ordering. All unlabeled neighbors
+    // of the current level (labels level_begin to level_begin + level_size - 1) are
+    // collected in next. The smallest label of all parents is stored for each of them,
+    // parent has to be initialized with nrow.
+    template <typename I, typename J>
+    __global__ void kernel_csr_cmk_expand(I nrow,
+                                          I level_begin,
+                                          I level_size,
+                                          const J* __restrict__ row_offset,
+                                          const I* __restrict__ col,
+                                          const I* __restrict__ order,
+                                          const I* __restrict__ perm,
+                                          I* __restrict__ parent,
+                                          I* __restrict__ next,
+                                          I* __restrict__ next_size)
+    {
+        I idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    //         // Get the value
-    //         T val_j = vals[j];
+        if(idx >= level_size)
+        {
+            return;
+        }
 
-    //         // Add the diagonal
-    //         if(col_j == row)
-    //         {
-    //             dia += val_j;
-    //         }
-    //         else if(connections[j] == false)
-    //         {
-    //             dia = (lumping_strat == 0) ? dia + val_j : dia - val_j;
-    //         }
-    //     }
+        I label = level_begin + idx;
+        I ai    = order[label];
 
-    //     // Sum up the accumulator from all lanes
-    //     for(unsigned int i = WFSIZE >> 1; i > 0; i >>= 1)
-    //     {
-    //         dia += hip_shfl_xor(dia, i);
-    //     }
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        {
+            I c = col[aj];
 
-    //     dia = static_cast<T>(1) / dia;
+            if(perm[c] != -1)
+            {
+                continue;
+            }
 
-    //     // Loop over all columns of the i-th row, whereas each lane processes a column
-    //     for(J j = row_begin + lid; j < row_end; j += WFSIZE)
-    //     {
-    //         // Get the column index
-    //         I col_j = cols[j];
+            // First parent to visit c appends it to the next level
+            if(atomicMin(&parent[c], label) == nrow)
+            {
+                next[atomicAdd(next_size, 1)] = c;
+            }
+        }
+    }
 
-    //         // Get the value
-    //         T val_j = vals[j];
+    // Sort key of the Cuthill-McKee ordering, vertices of a level are ordered by the
+    // label of their parent first and by their degree second
+    template <typename I, typename J>
+    __global__ void kernel_csr_cmk_keys(I size,
+                                        const J* __restrict__ row_offset,
+                                        const I* __restrict__ next,
+                                        const I* __restrict__ parent,
+                                        unsigned long long* __restrict__ keys)
+    {
+        I idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    //         // Get connection state
-    //         bool con = connections[j];
+        if(idx >= size)
+        {
+            return;
+        }
 
-    //         // Get aggregation state for this column
-    //         int64_t agg = aggregates[col_j];
+        I ai = next[idx];
 
-    //         // When aggregate is defined, diagonal entries and connected columns will
-    //         // generate a fill in
-    //         if((row == col_j || con) && agg >= 0)
-    //         {
-    //             // Insert or add if already present into unordered map
-    //             T val = (col_j == row) ? static_cast<T>(1) - relax : -relax * dia * val_j;
+        keys[idx] = (static_cast<unsigned long long>(parent[ai]) << 32)
+                    | static_cast<unsigned int>(row_offset[ai + 1] - row_offset[ai]);
+    }
 
-    //             int_map.insert_or_add(agg, val);
-    //         }
-    //     }
+    // Flag all vertices that have not been labeled
+    template <typename I>
+    __global__ void
+        kernel_csr_cmk_unlabeled(I nrow, const I* __restrict__ perm, I* __restrict__ flag)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-    //     // Access into P
-    //     J aj = pi_row_offsets[row];
+        if(ai >= nrow)
+        {
+            return;
+        }
 
-    //     // Store key val pairs from map into P
-    //     int_map.store_sorted(&pi_cols[aj], &pi_vals[aj]);
-    // }
+        flag[ai] = (perm[ai] == -1) ? 1 : 0;
+    }
 
-    template <bool         GLOBAL,
-              unsigned int BLOCKSIZE,
-              unsigned int WFSIZE,
-              unsigned int HASHSIZE,
-              typename T,
-              typename I,
-              typename J>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_sa_prolong_fill(I       nrow,
-                                        int64_t nnz,
-                                        int64_t global_column_begin,
-                                        int64_t global_column_end,
-                                        T       relax,
-                                        int     lumping_strat,
-                                        const J* __restrict__ row_offsets,
-                                        const I* __restrict__ cols,
-                                        const T* __restrict__ vals,
-                                        const J* __restrict__ gst_row_offsets,
-                                        const I* __restrict__ gst_cols,
-                                        const T* __restrict__ gst_vals,
-                                        const bool* __restrict__ connections,
-                                        const int64_t* __restrict__ aggregates,
-                                        const int64_t* __restrict__ aggregate_root_nodes,
-                                        const int* __restrict__ f2c,
-                                        const J* __restrict__ pi_row_offsets,
-                                        I* __restrict__ pi_cols,
-                                        T* __restrict__ pi_vals,
-                                        const J* __restrict__ pg_row_offsets,
-                                        I* __restrict__ pg_cols,
-                                        T* __restrict__ pg_vals,
-                                        int64_t* __restrict__ global_ghost_col)
+    // Label all remaining vertices in their natural order
+    template <typename I>
+    __global__ void kernel_csr_cmk_label_remaining(I nrow,
+                                                   I label_begin,
+                                                   const I* __restrict__ offset,
+                                                   I* __restrict__ perm)
     {
-        unsigned int lid = threadIdx.x & (WFSIZE - 1);
-        unsigned int wid = threadIdx.x / WFSIZE;
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(warpSize == WFSIZE)
+        if(ai >= nrow)
         {
-            wid = __builtin_amdgcn_readfirstlane(wid);
+            return;
         }
 
-        // The row this thread operates on
-        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
+        if(perm[ai] == -1)
+        {
+            perm[ai] = label_begin + offset[ai];
+        }
+    }
 
-        // Do not run out of bounds
-        if(row >= nrow)
+    // Reverse a permutation, i.e. perm[i] = nrow - 1 - perm[i]
+    template <typename I>
+    __global__ void kernel_csr_rcmk_reverse(I nrow, I* __restrict__ perm)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
             return;
         }
 
-        // Shared memory for the unordered map
-        __shared__ int64_t int_table[(BLOCKSIZE / WFSIZE) * HASHSIZE];
-        __shared__ int64_t gst_table[(BLOCKSIZE / WFSIZE) * HASHSIZE];
-        __shared__ char    int_mem[(BLOCKSIZE / WFSIZE) * HASHSIZE * sizeof(T)];
-        __shared__ char    gst_mem[(BLOCKSIZE / WFSIZE) * HASHSIZE * sizeof(T)];
+        perm[ai] = nrow - 1 - perm[ai];
+    }
 
-        T* int_data = reinterpret_cast<T*>(int_mem);
-        T* gst_data = reinterpret_cast<T*>(gst_mem);
+    // Number of entries of each row
+    template <typename I, typename J>
+    __global__ void
+        kernel_csr_row_nnz(I nrow, const J* __restrict__ row_offset, I* __restrict__ row_nnz)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Each wavefront operates on its own map
-        unordered_map<int64_t, T, HASHSIZE, WFSIZE> int_map(&int_table[wid * HASHSIZE],
-                                                            &int_data[wid * HASHSIZE]);
-        unordered_map<int64_t, T, HASHSIZE, WFSIZE> gst_map(&gst_table[wid * HASHSIZE],
-                                                            &gst_data[wid * HASHSIZE]);
+        if(ai >= nrow)
+        {
+            return;
+        }
 
-        // Row entry and exit points
-        J row_begin = row_offsets[row];
-        J row_end   = row_offsets[row + 1];
+        row_nnz[ai] = static_cast<I>(row_offset[ai + 1] - row_offset[ai]);
+    }
+
+    // Gather the values of A into the sorted pattern S, entries that are not in A are zero.
+    // If levels is not NULL, entries of A get level 0 and fill-in entries get fill_level
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_ilu_gather(I nrow,
+                                          const J* __restrict__ A_row_offset,
+                                          const I* __restrict__ A_col,
+                                          const T* __restrict__ A_val,
+                                          const J* __restrict__ S_row_offset,
+                                          const I* __restrict__ S_col,
+                                          T* __restrict__ S_val,
+                                          I fill_level,
+                                          I* __restrict__ levels)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
+        {
+            return;
+        }
 
-        // Accumulator
-        T dia = static_cast<T>(0);
+        J aj     = A_row_offset[ai];
+        J aj_end = A_row_offset[ai + 1];
 
-        // Loop over all columns of the i-th row, whereas each lane processes a column
-        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        for(J sj = S_row_offset[ai]; sj < S_row_offset[ai + 1]; ++sj)
         {
-            // Get the column index
-            I col_j = cols[j];
-
-            // Get the value
-            T val_j = vals[j];
+            I col = S_col[sj];
 
-            // Add the diagonal
-            if(col_j == row)
-            {
-                dia += val_j;
-            }
-            else if(connections[j] == false)
+            while(aj < aj_end && A_col[aj] < col)
             {
-                dia = (lumping_strat == 0) ? dia + val_j : dia - val_j;
+                ++aj;
             }
-        }
 
-        if(GLOBAL)
-        {
-            // Row entry and exit points
-            J gst_row_begin = gst_row_offsets[row];
-            J gst_row_end   = gst_row_offsets[row + 1];
+            bool is_a = (aj < aj_end && A_col[aj] == col);
 
-            for(J j = gst_row_begin + lid; j < gst_row_end; j += WFSIZE)
+            S_val[sj] = is_a ? A_val[aj] : static_cast<T>(0);
+
+            if(levels != NULL)
             {
-                if(connections[j + nnz] == false)
-                {
-                    if(lumping_strat == 0)
-                    {
-                        dia += gst_vals[j];
-                    }
-                    else
-                    {
-                        dia -= gst_vals[j];
-                    }
-                }
+                levels[sj] = is_a ? 0 : fill_level;
             }
         }
+    }
 
-        // Sum up the accumulator from all lanes
-        for(unsigned int i = WFSIZE >> 1; i > 0; i >>= 1)
+    // One sweep of the ILU(p) level of fill recurrence
+    // lev(i,j) = min(lev(i,j), lev(i,k) + lev(k,j) + 1), k < min(i,j), lev(i,k) <= p
+    // After p sweeps, all levels <= p are exact, all others are > p
+    template <typename I, typename J>
+    __global__ void kernel_csr_ilup_levels(I nrow,
+                                           I p,
+                                           const J* __restrict__ row_offset,
+                                           const I* __restrict__ col,
+                                           const I* __restrict__ levels_in,
+                                           I* __restrict__ levels_out)
+    {
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
-            dia += hip_shfl_xor(dia, i);
+            return;
         }
 
-        dia = static_cast<T>(1) / dia;
+        J row_begin = row_offset[ai];
+        J row_end   = row_offset[ai + 1];
 
-        // Loop over all columns of the i-th row, whereas each lane processes a column
-        for(J j = row_begin + lid; j < row_end; j += WFSIZE)
+        for(J aj = row_begin; aj < row_end; ++aj)
         {
-            // Get the column index
-            I col_j = cols[j];
-
-            // Get the value
-            T val_j = vals[j];
-
-            // Get connection state
-            bool con = connections[j];
-
-            // Get aggregation state for this column
-            int64_t agg = aggregates[col_j];
+            I j   = col[aj];
+            I lev = levels_in[aj];
 
-            // When aggregate is defined, diagonal entries and connected columns will
-            // generate a fill in
-            if((row == col_j || con) && agg >= 0)
+            for(J ak = row_begin; ak < row_end; ++ak)
             {
-                // Insert or add if already present into unordered map
-                T val = (col_j == row) ? static_cast<T>(1) - relax : -relax * dia * val_j;
-
-                int64_t global_node = aggregate_root_nodes[col_j];
+                I k = col[ak];
 
-                if(global_node >= global_column_begin && global_node < global_column_end)
-                {
-                    // int_map.insert_or_add(agg, val);
-                    // int_map.insert_or_add(f2c[global_node - global_column_begin], val);
-                    int_map.insert_or_add(global_node, val);
-                }
-                else
+                if(k >= ai || k >= j)
                 {
-                    gst_map.insert_or_add(global_node, val);
+                    break;
                 }
-            }
-        }
-
-        if(GLOBAL)
-        {
-            // Row entry and exit points
-            J gst_row_begin = gst_row_offsets[row];
-            J gst_row_end   = gst_row_offsets[row + 1];
-
-            for(J j = gst_row_begin + lid; j < gst_row_end; j += WFSIZE)
-            {
-                // Get the column index
-                I col_j = gst_cols[j];
 
-                // Get the value
-                T val_j = gst_vals[j];
+                I lev_ik = levels_in[ak];
 
-                // Get connection state
-                bool con = connections[j + nnz];
+                if(lev_ik > p)
+                {
+                    continue;
+                }
 
-                // Get aggregation state for this column
-                int64_t agg = aggregates[col_j + nrow];
+                // Binary search for a_k,j
+                J l = row_offset[k];
+                J r = row_offset[k + 1] - 1;
 
-                // When aggregate is defined, diagonal entries and connected columns will
-                // generate a fill in
-                if(con && agg >= 0)
+                while(l <= r)
                 {
-                    // Insert or add if already present into unordered map
-                    T val = -relax * dia * val_j;
+                    J m = l + (r - l) / 2;
+                    I c = col[m];
 
-                    int64_t global_node = aggregate_root_nodes[col_j + nrow];
+                    if(c == j)
+                    {
+                        lev = min(lev, lev_ik + levels_in[m] + 1);
+                        break;
+                    }
 
-                    if(global_node >= global_column_begin && global_node < global_column_end)
+                    if(c < j)
                     {
-                        // int_map.insert_or_add(agg, val);
-                        // int_map.insert_or_add(f2c[global_node - global_column_begin], val);
-                        int_map.insert_or_add(global_node, val);
+                        l = m + 1;
                     }
                     else
                     {
-                        gst_map.insert_or_add(global_node, val);
+                        r = m - 1;
                     }
                 }
             }
 
-            // Access into P
-            J aj = pg_row_offsets[row];
-
-            // Store key val pairs from map into P
-            gst_map.store_sorted(&global_ghost_col[aj], &pg_vals[aj]);
-        }
-
-        // Access into P
-        J aj   = pi_row_offsets[row];
-        J ajp1 = pi_row_offsets[row + 1];
-
-        // Store key val pairs from map into P
-        //int_map.store_sorted(&pi_cols[aj], &pi_vals[aj]);
-        int_map.sort();
-
-        for(J i = aj + lid; i < ajp1; i += WFSIZE)
-        {
-            pi_cols[i] = f2c[int_map.get_key(i - aj) - global_column_begin];
-            pi_vals[i] = int_map.get_val(i - aj);
+            levels_out[aj] = min(lev, p + 1);
         }
     }
 
-    // AMGUnsmoothedAggregation
-    template <unsigned int BLOCKSIZE, typename I, typename J>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_unsmoothed_prolong_nnz_per_row(I nrow,
-                                                       const int64_t* __restrict__ aggregates,
-                                                       J* __restrict__ prolong_row_offset)
+    // ILUT dual dropping on the exact factorization of the candidate pattern, mirrors the
+    // host driver: keep the maxrow largest L entries with |l_ij| > t and the maxrow - 1
+    // largest U entries with |u_ij| > t * norm(a_i) / nnz(a_i). The diagonal is always kept.
+    // Kept entries get level 0, dropped ones level 1.
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_ilut_select(I      nrow,
+                                           double t,
+                                           I      maxrow,
+                                           const J* __restrict__ A_row_offset,
+                                           const T* __restrict__ A_val,
+                                           const J* __restrict__ row_offset,
+                                           const I* __restrict__ col,
+                                           const T* __restrict__ val,
+                                           I* __restrict__ levels)
     {
-        I tid = threadIdx.x;
-        I row = blockIdx.x * BLOCKSIZE + tid;
-        if(row >= nrow)
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
             return;
         }
-        if(aggregates[row] >= 0)
-        {
-            prolong_row_offset[row + 1] = 1;
-        }
-        else
+
+        double norm = 0.0;
+
+        for(J aj = A_row_offset[ai]; aj < A_row_offset[ai + 1]; ++aj)
         {
-            prolong_row_offset[row + 1] = 0;
+            norm += hip_abs(A_val[aj]);
         }
-        if(row == 0)
+
+        if(A_row_offset[ai + 1] > A_row_offset[ai])
         {
-            prolong_row_offset[row] = 0;
+            norm /= static_cast<double>(A_row_offset[ai + 1] - A_row_offset[ai]);
         }
-    }
 
-    template <unsigned int BLOCKSIZE, typename T, typename I>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_unsmoothed_prolong_fill_simple(I nrow,
-                                                       const int64_t* __restrict__ aggregates,
-                                                       I* __restrict__ prolong_cols,
-                                                       T* __restrict__ prolong_vals)
-    {
-        I tid = threadIdx.x;
-        I row = blockIdx.x * BLOCKSIZE + tid;
-        if(row >= nrow)
+        J row_begin = row_offset[ai];
+        J row_end   = row_offset[ai + 1];
+
+        for(J aj = row_begin; aj < row_end; ++aj)
         {
-            return;
+            I j = col[aj];
+
+            if(j == ai)
+            {
+                levels[aj] = 0;
+                continue;
+            }
+
+            bool   lower = j < ai;
+            double tol   = lower ? t : t * norm;
+            I      size  = lower ? maxrow : maxrow - 1;
+            double mag   = hip_abs(val[aj]);
+
+            if(mag <= tol || size <= 0)
+            {
+                levels[aj] = 1;
+                continue;
+            }
+
+            // Rank of this entry among the candidates of its triangular part
+            I rank = 0;
+
+            for(J ak = row_begin; ak < row_end && rank < size; ++ak)
+            {
+                I k = col[ak];
+
+                if(k == ai || (k < ai) != lower)
+                {
+                    continue;
+                }
+
+                double mag_k = hip_abs(val[ak]);
+
+                if(mag_k > mag || (mag_k == mag && ak < aj))
+                {
+                    ++rank;
+                }
+            }
+
+            levels[aj] = (rank < size) ? 0 : 1;
         }
-        prolong_cols[row] = aggregates[row];
-        prolong_vals[row] = static_cast<T>(1);
     }
 
-    template <unsigned int BLOCKSIZE, typename T, typename I, typename J>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_unsmoothed_prolong_fill(I nrow,
-                                                const int64_t* __restrict__ aggregates,
-                                                const J* __restrict__ prolong_row_offset,
-                                                I* __restrict__ prolong_cols,
-                                                T* __restrict__ prolong_vals)
+    // Count the entries of each row with level <= p
+    template <typename I, typename J>
+    __global__ void kernel_csr_ilu_count(I nrow,
+                                         I p,
+                                         const J* __restrict__ row_offset,
+                                         const I* __restrict__ levels,
+                                         J* __restrict__ row_nnz)
     {
-        I tid = threadIdx.x;
-        I row = blockIdx.x * BLOCKSIZE + tid;
-        if(row >= nrow)
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(ai >= nrow)
         {
             return;
         }
 
-        int64_t agg = aggregates[row];
+        J nnz = 0;
 
-        if(agg >= 0)
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            J j             = prolong_row_offset[row];
-            prolong_cols[j] = agg;
-            prolong_vals[j] = static_cast<T>(1);
+            if(levels[aj] <= p)
+            {
+                ++nnz;
+            }
         }
+
+        row_nnz[ai] = nnz;
     }
 
-    template <unsigned int BLOCKSIZE, typename I, typename J>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_ua_prolong_nnz(I       nrow,
-                                       int64_t global_column_begin,
-                                       int64_t global_column_end,
-                                       const int64_t* __restrict__ aggregates,
-                                       const int64_t* __restrict__ aggregate_root_nodes,
-                                       int* __restrict__ f2c,
-                                       J* __restrict__ pi_row_nnz,
-                                       J* __restrict__ pg_row_nnz)
+    // Copy all entries with level <= p into the compressed pattern
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_ilu_compress(I nrow,
+                                            I p,
+                                            const J* __restrict__ row_offset,
+                                            const I* __restrict__ col,
+                                            const T* __restrict__ val,
+                                            const I* __restrict__ levels,
+                                            const J* __restrict__ row_offset_new,
+                                            I* __restrict__ col_new,
+                                            T* __restrict__ val_new)
     {
-        I tid = threadIdx.x;
-        I row = blockIdx.x * BLOCKSIZE + tid;
+        I ai = blockIdx.x * blockDim.x + threadIdx.x;
 
-        if(row >= nrow)
+        if(ai >= nrow)
         {
             return;
         }
 
-        int64_t agg = aggregates[row];
+        J ajj = row_offset_new[ai];
 
-        if(agg >= 0)
+        for(J aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            int64_t global_node = aggregate_root_nodes[row];
-
-            if(global_node >= global_column_begin && global_node < global_column_end)
-            {
-                pi_row_nnz[row]                        = 1;
-                f2c[global_node - global_column_begin] = 1;
-            }
-            else
+            if(levels[aj] <= p)
             {
-                pg_row_nnz[row] = 1;
+                col_new[ajj] = col[aj];
+                val_new[ajj] = val[aj];
+                ++ajj;
             }
         }
     }
 
-    template <bool GLOBAL, unsigned int BLOCKSIZE, typename T, typename I, typename J>
+    // FSAI, one block per row of the lower triangular pattern L. The dense system
+    // A(J, J) m = e_n of the pattern J of the row is factorized in shared memory and
+    // the row of L is scaled by 1 / sqrt(|m_n|). Rows with more than MAXN entries set
+    // overflow and are skipped.
+    template <unsigned int BLOCKSIZE, unsigned int MAXN, typename T, typename I, typename J>
     __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_ua_prolong_fill(I       nrow,
-                                        int64_t global_column_begin,
-                                        int64_t global_column_end,
-                                        const int64_t* __restrict__ aggregates,
-                                        const int64_t* __restrict__ aggregate_root_nodes,
-                                        const int* __restrict__ f2c,
-                                        const J* __restrict__ pi_row_offsets,
-                                        I* __restrict__ pi_cols,
-                                        T* __restrict__ pi_vals,
-                                        const J* __restrict__ pg_row_offsets,
-                                        I* __restrict__ pg_cols,
-                                        T* __restrict__ pg_vals,
-                                        int64_t* __restrict__ global_ghost_col)
+        void kernel_csr_fsai(I nrow,
+                             const J* __restrict__ row_offset,
+                             const I* __restrict__ col,
+                             const T* __restrict__ val,
+                             const J* __restrict__ L_row_offset,
+                             const I* __restrict__ L_col,
+                             T* __restrict__ L_val,
+                             bool* __restrict__ overflow)
     {
+        I ai  = blockIdx.x;
         I tid = threadIdx.x;
-        I row = blockIdx.x * BLOCKSIZE + tid;
 
-        if(row >= nrow)
+        __shared__ T sA[MAXN * MAXN];
+        __shared__ T sm[MAXN];
+        __shared__ I sJ[MAXN];
+
+        if(ai >= nrow)
         {
             return;
         }
 
-        int64_t agg = aggregates[row];
+        J row_begin = L_row_offset[ai];
+        I n         = L_row_offset[ai + 1] - row_begin;
 
-        if(agg >= 0)
+        if(n == 0)
         {
-            int64_t global_node = aggregate_root_nodes[row];
+            return;
+        }
 
-            if(global_node >= global_column_begin && global_node < global_column_end)
+        if(n > MAXN)
+        {
+            if(tid == 0)
             {
-                J pi_row_end = pi_row_offsets[row];
-
-                pi_cols[pi_row_end] = f2c[global_node - global_column_begin];
-                pi_vals[pi_row_end] = 1;
+                *overflow = true;
             }
-            else
-            {
-                J pg_row_end = pg_row_offsets[row];
 
-                pg_vals[pg_row_end]          = 1;
-                global_ghost_col[pg_row_end] = global_node;
-            }
+            return;
         }
-    }
-
-    template <typename I, typename J>
-    __global__ void kernel_csr_extract_boundary_state(I       boundary_size,
-                                                      I       nrow,
-                                                      int64_t nnz,
-                                                      const I* __restrict__ boundary_index,
-                                                      const J* __restrict__ csr_row_ptr,
-                                                      const I* __restrict__ csr_col_ind,
-                                                      const J* __restrict__ ghost_csr_row_ptr,
-                                                      const I* __restrict__ ghost_csr_col_ind,
-                                                      const bool* __restrict__ connections,
-                                                      const I* __restrict__ max_state,
-                                                      const I* __restrict__ hash,
-                                                      const J* __restrict__ bnd_row_ptr,
-                                                      I* __restrict__ bnd_max_state,
-                                                      I* __restrict__ bnd_hash)
-    {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(gid >= boundary_size)
+        for(I k = tid; k < n; k += BLOCKSIZE)
         {
-            return;
+            sJ[k] = L_col[row_begin + k];
+            sm[k] = static_cast<T>(0);
         }
 
-        // This row is a boundary row
-        I row = boundary_index[gid];
-
-        // Index into boundary array
-        J idx = bnd_row_ptr[gid];
+        for(I k = tid; k < n * n; k += BLOCKSIZE)
+        {
+            sA[k] = static_cast<T>(0);
+        }
 
-        // Extract interior part
-        J row_begin = csr_row_ptr[row];
-        J row_end   = csr_row_ptr[row + 1];
+        __syncthreads();
 
-        // Interior
-        for(J j = row_begin; j < row_end; ++j)
+        // Gather A(J, J), each thread merges one row of A with the sorted pattern
+        for(I k = tid; k < n; k += BLOCKSIZE)
         {
-            if(connections[j] == true)
+            I r = sJ[k];
+            I j = 0;
+
+            for(J aj = row_offset[r]; aj < row_offset[r + 1]; ++aj)
             {
-                I col = csr_col_ind[j];
+                I c = col[aj];
 
-                bnd_max_state[idx] = max_state[col];
-                bnd_hash[idx]      = hash[col];
+                if(c > ai)
+                {
+                    break;
+                }
 
-                ++idx;
+                while(j < n && sJ[j] < c)
+                {
+                    ++j;
+                }
+
+                if(j == n)
+                {
+                    break;
+                }
+
+                if(sJ[j] == c)
+                {
+                    sA[k * n + j] = val[aj];
+                }
             }
         }
 
-        // Extract ghost part
-        row_begin = ghost_csr_row_ptr[row];
-        row_end   = ghost_csr_row_ptr[row + 1];
+        if(tid == 0)
+        {
+            sm[n - 1] = static_cast<T>(1);
+        }
 
-        for(J j = row_begin; j < row_end; ++j)
+        __syncthreads();
+
+        // In place LU factorization of A(J, J)
+        for(I i = 0; i < n - 1; ++i)
         {
-            if(connections[j + nnz] == true)
+            for(I k = i + 1 + tid; k < n; k += BLOCKSIZE)
             {
-                I col = ghost_csr_col_ind[j];
+                sA[k * n + i] /= sA[i * n + i];
+            }
 
-                bnd_max_state[idx] = max_state[col + nrow];
-                bnd_hash[idx]      = hash[col + nrow];
+            __syncthreads();
 
-                ++idx;
+            I m = n - i - 1;
+
+            for(I idx = tid; idx < m * m; idx += BLOCKSIZE)
+            {
+                I k = i + 1 + idx / m;
+                I j = i + 1 + idx % m;
+
+                sA[k * n + j] -= sA[k * n + i] * sA[i * n + j];
             }
-        }
-    }
 
-    template <typename I, typename J>
-    __global__ void kernel_csr_merge_interior_ghost_ext_nnz(I       m,
-                                                            I       m_ext,
-                                                            int64_t nnz_gst,
-                                                            const J* __restrict__ int_csr_row_ptr,
-                                                            const J* __restrict__ gst_csr_row_ptr,
-                                                            const J* __restrict__ ext_csr_row_ptr,
-                                                            J* __restrict__ row_nnz)
-    {
-        // Current row
-        I row = blockIdx.x * blockDim.x + threadIdx.x;
+            __syncthreads();
+        }
 
-        // Count row nnz
-        if(row < m)
+        // Backward sweeps, as on the host
+        for(I i = n - 1; i >= 0; --i)
         {
-            int nnz = int_csr_row_ptr[row + 1] - int_csr_row_ptr[row];
+            if(tid == 0)
+            {
+                sm[i] /= sA[i * n + i];
+            }
 
-            // If ghost part is available
-            if(nnz_gst > 0)
+            __syncthreads();
+
+            for(I j = tid; j < i; j += BLOCKSIZE)
             {
-                nnz += gst_csr_row_ptr[row + 1] - gst_csr_row_ptr[row];
+                sm[j] -= sm[i] * sA[i * n + j];
             }
 
-            row_nnz[row] = nnz;
+            __syncthreads();
         }
-        else if(row - m < m_ext)
+
+        T fac = static_cast<T>(sqrt(1.0 / hip_abs(sm[n - 1])));
+
+        for(I k = tid; k < n; k += BLOCKSIZE)
         {
-            row_nnz[row] = ext_csr_row_ptr[row - m + 1] - ext_csr_row_ptr[row - m];
+            L_val[row_begin + k] = sm[k] * fac;
         }
     }
 
-    template <typename T, typename I, typename J>
-    __global__ void kernel_csr_merge_interior_ghost_nnz(I m,
-                                                        I m_ext,
-                                                        I n,
-                                                        I nnz_gst,
-                                                        const J* __restrict__ int_csr_row_ptr,
-                                                        const I* __restrict__ int_csr_col_ind,
-                                                        const T* __restrict__ int_csr_val,
-                                                        const J* __restrict__ gst_csr_row_ptr,
-                                                        const I* __restrict__ gst_csr_col_ind,
-                                                        const T* __restrict__ gst_csr_val,
-                                                        const J* __restrict__ ext_csr_row_ptr,
-                                                        const I* __restrict__ ext_csr_col_ind,
-                                                        const T* __restrict__ ext_csr_val,
-                                                        const I* __restrict__ ext_gst_csr_col_ind,
-                                                        const J* __restrict__ merged_csr_row_ptr,
-                                                        I* __restrict__ merged_csr_col_ind,
-                                                        T* __restrict__ merged_csr_val)
+    // SPAI, one block per column i of A, given as row i of the transpose AT. The least
+    // squares problem min ||A(I, J) m - e_i|| is solved in shared memory by a modified
+    // Gram-Schmidt QR decomposition, where J is the pattern of column i and I the union
+    // of the patterns of the columns J. The solution m is written to the row i of M^T,
+    // which has the pattern of AT. Columns with more than MAXJ entries or more than MAXI
+    // rows in I set overflow and are skipped.
+    template <unsigned int BLOCKSIZE,
+              unsigned int MAXI,
+              unsigned int MAXJ,
+              typename T,
+              typename I,
+              typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_spai(I nrow,
+                             const J* __restrict__ AT_row_offset,
+                             const I* __restrict__ AT_col,
+                             const T* __restrict__ AT_val,
+                             T* __restrict__ MT_val,
+                             bool* __restrict__ overflow)
     {
-        // Current row
-        I row = blockIdx.x * blockDim.x + threadIdx.x;
+        I ai  = blockIdx.x;
+        I tid = threadIdx.x;
 
-        // Access into merged structure
-        J idx = merged_csr_row_ptr[row];
+        // Columns of A(I, J), followed by the right-hand side
+        __shared__ T sA[MAXI * (MAXJ + 1)];
+        __shared__ T sR[MAXJ * (MAXJ + 1)];
+        __shared__ T sred[BLOCKSIZE];
+        __shared__ I sI[MAXI];
+        __shared__ I sm;
 
-        if(row < m)
+        if(ai >= nrow)
         {
-            // Interior
-            J row_begin = int_csr_row_ptr[row];
-            J row_end   = int_csr_row_ptr[row + 1];
+            return;
+        }
 
-            for(J j = row_begin; j < row_end; ++j)
-            {
-                merged_csr_col_ind[idx] = int_csr_col_ind[j];
-                merged_csr_val[idx]     = int_csr_val[j];
+        J row_begin = AT_row_offset[ai];
+        I n         = AT_row_offset[ai + 1] - row_begin;
 
-                ++idx;
-            }
+        if(n == 0)
+        {
+            return;
+        }
 
-            // If ghost is available
-            if(nnz_gst > 0)
+        if(n > MAXJ)
+        {
+            if(tid == 0)
             {
-                J row_begin = gst_csr_row_ptr[row];
-                J row_end   = gst_csr_row_ptr[row + 1];
-
-                for(J j = row_begin; j < row_end; ++j)
-                {
-                    merged_csr_col_ind[idx] = ext_gst_csr_col_ind[j] + n;
-                    merged_csr_val[idx]     = gst_csr_val[j];
-
-                    ++idx;
-                }
+                *overflow = true;
             }
+
+            return;
         }
-        else if(row - m < m_ext)
+
+        // Sorted union I of the column patterns
+        if(tid == 0)
         {
-            J row_begin = ext_csr_row_ptr[row - m];
-            J row_end   = ext_csr_row_ptr[row - m + 1];
+            I m = 0;
 
-            for(J j = row_begin; j < row_end; ++j)
+            for(I j = 0; j < n && m >= 0; ++j)
             {
-                merged_csr_col_ind[idx] = ext_csr_col_ind[j];
-                merged_csr_val[idx]     = ext_csr_val[j];
+                I c = AT_col[row_begin + j];
 
-                ++idx;
-            }
-        }
-    }
+                for(J aj = AT_row_offset[c]; aj < AT_row_offset[c + 1]; ++aj)
+                {
+                    I r   = AT_col[aj];
+                    I pos = 0;
 
-    // Count the total vertices of this boundary row
-    template <typename I, typename J>
-    __global__ void kernel_csr_extract_boundary_rows_nnz(I boundary_size,
-                                                         const I* __restrict__ boundary_index,
-                                                         const J* __restrict__ int_csr_row_ptr,
-                                                         const J* __restrict__ gst_csr_row_ptr,
-                                                         I* __restrict__ row_nnz)
-    {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
-        // Do not run out of bounds
-        if(gid >= boundary_size)
-        {
-            return;
-        }
-        // Get boundary row
-        I row = boundary_index[gid];
-        // Write total number of nnz for this boundary row
-        row_nnz[gid] = int_csr_row_ptr[row + 1] - int_csr_row_ptr[row] + gst_csr_row_ptr[row + 1]
-                       - gst_csr_row_ptr[row];
-    }
+                    while(pos < m && sI[pos] < r)
+                    {
+                        ++pos;
+                    }
 
-    template <typename I, typename J, typename K>
-    __global__ void kernel_csr_extract_boundary_rows(I boundary_size,
-                                                     const I* __restrict__ boundary_index,
-                                                     K global_col_offset,
-                                                     const J* __restrict__ csr_row_ptr,
-                                                     const I* __restrict__ csr_col_ind,
-                                                     const J* __restrict__ ghost_csr_row_ptr,
-                                                     const I* __restrict__ ghost_csr_col_ind,
-                                                     const K* __restrict__ l2g,
-                                                     const I* __restrict__ send_row_ptr,
-                                                     K* __restrict__ send_col_ind)
-    {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+                    if(pos < m && sI[pos] == r)
+                    {
+                        continue;
+                    }
 
-        // Do not run out of bounds
-        if(gid >= boundary_size)
-        {
-            return;
+                    if(m == MAXI)
+                    {
+                        m = -1;
+                        break;
+                    }
+
+                    for(I k = m; k > pos; --k)
+                    {
+                        sI[k] = sI[k - 1];
+                    }
+
+                    sI[pos] = r;
+                    ++m;
+                }
+            }
+
+            sm = m;
         }
 
-        // This row is a boundary row
-        I row = boundary_index[gid];
+        __syncthreads();
 
-        // Index into send array
-        I send_row = send_row_ptr[gid];
+        I m = sm;
 
-        // Extract interior part
-        J row_begin = csr_row_ptr[row];
-        J row_end   = csr_row_ptr[row + 1];
+        if(m < 0)
+        {
+            if(tid == 0)
+            {
+                *overflow = true;
+            }
 
-        // Interior
-        for(J j = row_begin; j < row_end; ++j)
+            return;
+        }
+
+        // Gather A(I, J) and e_i, each thread scatters one column of A
+        for(I k = tid; k < m * (n + 1); k += BLOCKSIZE)
         {
-            // Shift column by global column offset, to obtain the global column index
-            send_col_ind[send_row] = csr_col_ind[j] + global_col_offset;
-            ++send_row;
+            sA[k] = (k >= m * n && sI[k - m * n] == ai) ? static_cast<T>(1) : static_cast<T>(0);
         }
 
-        // Extract ghost part
-        row_begin = ghost_csr_row_ptr[row];
-        row_end   = ghost_csr_row_ptr[row + 1];
+        __syncthreads();
 
-        for(J j = row_begin; j < row_end; ++j)
+        for(I j = tid; j < n; j += BLOCKSIZE)
         {
-            // Map the local ghost column to global column
-            send_col_ind[send_row] = l2g[ghost_csr_col_ind[j]];
-            ++send_row;
+            I c = AT_col[row_begin + j];
+            I k = 0;
+
+            for(J aj = AT_row_offset[c]; aj < AT_row_offset[c + 1]; ++aj)
+            {
+                I r = AT_col[aj];
+
+                while(sI[k] < r)
+                {
+                    ++k;
+                }
+
+                sA[j * m + k] = AT_val[aj];
+            }
         }
-    }
 
-    template <typename T, typename I, typename J, typename K>
-    __global__ void kernel_csr_extract_boundary_rows(I boundary_size,
-                                                     const I* __restrict__ boundary_index,
-                                                     K global_col_offset,
-                                                     const J* __restrict__ csr_row_ptr,
-                                                     const I* __restrict__ csr_col_ind,
-                                                     const T* __restrict__ csr_val,
-                                                     const J* __restrict__ ghost_csr_row_ptr,
-                                                     const I* __restrict__ ghost_csr_col_ind,
-                                                     const T* __restrict__ ghost_csr_val,
-                                                     const K* __restrict__ l2g,
-                                                     const I* __restrict__ send_row_ptr,
-                                                     K* __restrict__ send_col_ind,
-                                                     T* __restrict__ send_val)
-    {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        __syncthreads();
 
-        // Do not run out of bounds
-        if(gid >= boundary_size)
+        // Modified Gram-Schmidt, the right-hand side is orthogonalized as column n
+        for(I j = 0; j < n; ++j)
         {
-            return;
-        }
+            T* qj = sA + j * m;
 
-        // This row is a boundary row
-        I row = boundary_index[gid];
+            T sum = static_cast<T>(0);
 
-        // Index into send array
-        I send_row = send_row_ptr[gid];
+            for(I k = tid; k < m; k += BLOCKSIZE)
+            {
+                sum += hip_conj(qj[k]) * qj[k];
+            }
 
-        // Extract interior part
-        J row_begin = csr_row_ptr[row];
-        J row_end   = csr_row_ptr[row + 1];
+            sred[tid] = sum;
 
-        // Interior
-        for(J j = row_begin; j < row_end; ++j)
-        {
-            // Shift column by global column offset, to obtain the global column index
-            send_col_ind[send_row] = csr_col_ind[j] + global_col_offset;
-            send_val[send_row]     = csr_val[j];
-            ++send_row;
-        }
+            __syncthreads();
 
-        // Extract ghost part
-        row_begin = ghost_csr_row_ptr[row];
-        row_end   = ghost_csr_row_ptr[row + 1];
+            block_reduce_sum<BLOCKSIZE>(tid, sred);
 
-        for(J j = row_begin; j < row_end; ++j)
-        {
-            // Map the local ghost column to global column
-            send_col_ind[send_row] = l2g[ghost_csr_col_ind[j]];
-            send_val[send_row]     = ghost_csr_val[j];
-            ++send_row;
-        }
-    }
+            T rjj = static_cast<T>(sqrt(hip_real(sred[0])));
 
-    template <typename I, typename J>
-    __global__ void kernel_csr_copy_ghost_from_global_nnz(I boundary_size,
-                                                          const I* __restrict__ boundary_index,
-                                                          const I* __restrict__ csr_row_ptr,
-                                                          J* __restrict__ row_nnz)
-    {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+            for(I k = tid; k < m; k += BLOCKSIZE)
+            {
+                qj[k] /= rjj;
+            }
 
-        // Do not run out of bounds
-        if(gid >= boundary_size)
+            if(tid == 0)
+            {
+                sR[j * (n + 1) + j] = rjj;
+            }
+
+            __syncthreads();
+
+            for(I l = j + 1 + tid; l <= n; l += BLOCKSIZE)
+            {
+                T* al = sA + l * m;
+                T  rjl = static_cast<T>(0);
+
+                for(I k = 0; k < m; ++k)
+                {
+                    rjl += hip_conj(qj[k]) * al[k];
+                }
+
+                for(I k = 0; k < m; ++k)
+                {
+                    al[k] -= rjl * qj[k];
+                }
+
+                sR[j * (n + 1) + l] = rjl;
+            }
+
+            __syncthreads();
+        }
+
+        // Backward substitution R m = Q^H e_i, the solution overwrites column n of R
+        if(tid == 0)
         {
-            return;
+            for(I j = n - 1; j >= 0; --j)
+            {
+                T sum = sR[j * (n + 1) + n];
+
+                for(I l = j + 1; l < n; ++l)
+                {
+                    sum -= sR[j * (n + 1) + l] * sR[l * (n + 1) + n];
+                }
+
+                sR[j * (n + 1) + n] = sum / sR[j * (n + 1) + j];
+            }
         }
 
-        // Get boundary row
-        I row = boundary_index[gid];
+        __syncthreads();
 
-        // Write total number of nnz for this boundary row
-        atomicAdd(row_nnz + row, csr_row_ptr[gid + 1] - csr_row_ptr[gid]);
+        for(I j = tid; j < n; j += BLOCKSIZE)
+        {
+            MT_val[row_begin + j] = sR[j * (n + 1) + n];
+        }
     }
 
-    template <typename T, typename I, typename J, typename K>
-    __global__ void kernel_csr_copy_ghost_from_global(I boundary_size,
-                                                      const I* __restrict__ boundary_index,
-                                                      const I* __restrict__ csr_row_ptr,
-                                                      const K* __restrict__ csr_col_ind,
-                                                      const T* __restrict__ csr_val,
-                                                      J* __restrict__ ext_row_ptr,
-                                                      K* __restrict__ ext_col_ind,
-                                                      T* __restrict__ ext_val)
+    // Upper bound of the number of non-zero entries per row of the triple product
+    // C = R * A * P, limited by the number of columns of P
+    template <unsigned int BLOCKSIZE, typename I, typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_rap_row_bound(I nrow,
+                                      I ncol,
+                                      const J* __restrict__ csr_row_ptr_R,
+                                      const I* __restrict__ csr_col_ind_R,
+                                      const J* __restrict__ csr_row_ptr_A,
+                                      const I* __restrict__ csr_col_ind_A,
+                                      const J* __restrict__ csr_row_ptr_P,
+                                      J* __restrict__ row_bound)
     {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        I row = blockIdx.x * BLOCKSIZE + threadIdx.x;
 
-        // Do not run out of bounds
-        if(gid >= boundary_size)
+        if(row >= nrow)
         {
             return;
         }
 
-        // This row is a boundary row
-        I row = boundary_index[gid];
+        J bound = 0;
 
-        I row_begin = csr_row_ptr[gid];
-        I row_end   = csr_row_ptr[gid + 1];
+        for(J r = csr_row_ptr_R[row]; r < csr_row_ptr_R[row + 1]; ++r)
+        {
+            I col_r = csr_col_ind_R[r];
 
-        // Index into extracted matrix, we have to use atomics here, because other
-        // blocks might also update this row
-        J idx = atomicAdd(ext_row_ptr + row, row_end - row_begin);
+            for(J a = csr_row_ptr_A[col_r]; a < csr_row_ptr_A[col_r + 1]; ++a)
+            {
+                I col_a = csr_col_ind_A[a];
 
-        for(I j = row_begin; j < row_end; ++j)
-        {
-            ext_col_ind[idx] = csr_col_ind[j];
-            ext_val[idx]     = csr_val[j];
-            ++idx;
+                bound += csr_row_ptr_P[col_a + 1] - csr_row_ptr_P[col_a];
+            }
         }
+
+        row_bound[row] = (bound < ncol) ? bound : ncol;
     }
 
-    template <typename I, typename J, typename K>
-    __global__ void kernel_csr_copy_from_global_nnz(I boundary_size,
-                                                    K global_column_begin,
-                                                    K global_column_end,
-                                                    const I* __restrict__ boundary_index,
-                                                    const I* __restrict__ csr_row_ptr,
-                                                    const K* __restrict__ csr_col_ind,
-                                                    J* __restrict__ int_row_nnz,
-                                                    J* __restrict__ gst_row_nnz)
+    // Number of non-zero entries per row of the triple product C = R * A * P. Each
+    // wavefront processes a row of R, whereas the lanes process the columns of the
+    // corresponding rows of A
+    template <unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              unsigned int HASHSIZE,
+              typename I,
+              typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_rap_nnz(I nrow,
+                                const J* __restrict__ csr_row_ptr_R,
+                                const I* __restrict__ csr_col_ind_R,
+                                const J* __restrict__ csr_row_ptr_A,
+                                const I* __restrict__ csr_col_ind_A,
+                                const J* __restrict__ csr_row_ptr_P,
+                                const I* __restrict__ csr_col_ind_P,
+                                J* __restrict__ row_nnz)
     {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        unsigned int lid = threadIdx.x & (WFSIZE - 1);
+        unsigned int wid = threadIdx.x / WFSIZE;
+
+        // The row this thread operates on
+        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
 
         // Do not run out of bounds
-        if(gid >= boundary_size)
+        if(row >= nrow)
         {
             return;
         }
 
-        // Get boundary row
-        I row = boundary_index[gid];
+        // Row nnz counter
+        I nnz = 0;
 
-        I int_nnz = 0;
-        I gst_nnz = 0;
+        // Shared memory for the unordered set
+        __shared__ I sdata[BLOCKSIZE / WFSIZE * HASHSIZE];
 
-        I row_begin = csr_row_ptr[gid];
-        I row_end   = csr_row_ptr[gid + 1];
+        // Each wavefront operates on its own set
+        unordered_set<I, HASHSIZE, WFSIZE> set(&sdata[wid * HASHSIZE]);
 
-        for(I j = row_begin; j < row_end; ++j)
+        // Loop over all columns of the i-th row of R
+        for(J r = csr_row_ptr_R[row]; r < csr_row_ptr_R[row + 1]; ++r)
         {
-            K col = csr_col_ind[j];
+            I col_r = csr_col_ind_R[r];
 
-            if(col >= global_column_begin && col < global_column_end)
-            {
-                // Interior column
-                ++int_nnz;
-            }
-            else
+            // Loop over the corresponding row of A, whereas each lane processes a column
+            for(J a = csr_row_ptr_A[col_r] + lid; a < csr_row_ptr_A[col_r + 1]; a += WFSIZE)
             {
-                // Ghost column
-                ++gst_nnz;
+                I col_a = csr_col_ind_A[a];
+
+                // Add the columns of the corresponding row of P to the set
+                for(J p = csr_row_ptr_P[col_a]; p < csr_row_ptr_P[col_a + 1]; ++p)
+                {
+                    nnz += set.insert(csr_col_ind_P[p]);
+                }
             }
         }
 
-        // Write total number of nnz for this row
-        atomicAdd(int_row_nnz + row, int_nnz);
-        atomicAdd(gst_row_nnz + row, gst_nnz);
+        // Sum up the row nnz from all lanes
+        wf_reduce_sum<WFSIZE>(&nnz);
+
+        // Last lane in wavefront writes row nnz back to global memory
+        if(lid == WFSIZE - 1)
+        {
+            row_nnz[row] = nnz;
+        }
     }
 
-    template <typename T, typename I, typename J, typename K>
-    __global__ void kernel_csr_copy_from_global(I boundary_size,
-                                                K global_column_begin,
-                                                K global_column_end,
-                                                const I* __restrict__ boundary_index,
-                                                const I* __restrict__ csr_row_ptr,
-                                                const K* __restrict__ csr_col_ind,
-                                                const T* __restrict__ csr_val,
-                                                J* __restrict__ int_csr_row_ptr,
-                                                I* __restrict__ int_csr_col_ind,
-                                                T* __restrict__ int_csr_val,
-                                                J* __restrict__ gst_csr_row_ptr,
-                                                K* __restrict__ gst_csr_col_ind,
-                                                T* __restrict__ gst_csr_val)
+    // Triple product C = R * A * P for a given structure of C. The products are
+    // accumulated in the hash map of the wavefront and stored sorted by columns, such
+    // that the structure of C is reproduced if it has been computed for the same
+    // sparsity patterns of R, A and P. If rows is not NULL, only the flagged rows of C
+    // are computed
+    template <unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              unsigned int HASHSIZE,
+              typename T,
+              typename I,
+              typename J>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_csr_rap_fill(I nrow,
+                                 const bool* __restrict__ rows,
+                                 const J* __restrict__ csr_row_ptr_R,
+                                 const I* __restrict__ csr_col_ind_R,
+                                 const T* __restrict__ csr_val_R,
+                                 const J* __restrict__ csr_row_ptr_A,
+                                 const I* __restrict__ csr_col_ind_A,
+                                 const T* __restrict__ csr_val_A,
+                                 const J* __restrict__ csr_row_ptr_P,
+                                 const I* __restrict__ csr_col_ind_P,
+                                 const T* __restrict__ csr_val_P,
+                                 const J* __restrict__ csr_row_ptr_C,
+                                 I* __restrict__ csr_col_ind_C,
+                                 T* __restrict__ csr_val_C)
     {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        unsigned int lid = threadIdx.x & (WFSIZE - 1);
+        unsigned int wid = threadIdx.x / WFSIZE;
+
+        // The row this thread operates on
+        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
 
         // Do not run out of bounds
-        if(gid >= boundary_size)
+        if(row >= nrow)
         {
             return;
         }
 
-        // This row is a boundary row
-        I row = boundary_index[gid];
+        // Rows that are not flagged keep their values
+        if(rows != NULL && rows[row] == false)
+        {
+            return;
+        }
+
+        // Shared memory for the unordered map
+        __shared__ I    stable[(BLOCKSIZE / WFSIZE) * HASHSIZE];
+        __shared__ char smem[(BLOCKSIZE / WFSIZE) * HASHSIZE * sizeof(T)];
 
-        I row_begin = csr_row_ptr[gid];
-        I row_end   = csr_row_ptr[gid + 1];
+        T* sdata = reinterpret_cast<T*>(smem);
 
-        // Pre-determine, how many nnz we are going to add for this boundary row
-        I int_nnz = 0;
-        I gst_nnz = 0;
+        // Each wavefront operates on its own map
+        unordered_map<I, T, HASHSIZE, WFSIZE> map(&stable[wid * HASHSIZE], &sdata[wid * HASHSIZE]);
 
-        for(I j = row_begin; j < row_end; ++j)
+        // Loop over all columns of the i-th row of R
+        for(J r = csr_row_ptr_R[row]; r < csr_row_ptr_R[row + 1]; ++r)
         {
-            K col = csr_col_ind[j];
+            I col_r = csr_col_ind_R[r];
+            T val_r = csr_val_R[r];
 
-            if(col >= global_column_begin && col < global_column_end)
-            {
-                // Interior column
-                ++int_nnz;
-            }
-            else
+            // Loop over the corresponding row of A, whereas each lane processes a column
+            for(J a = csr_row_ptr_A[col_r] + lid; a < csr_row_ptr_A[col_r + 1]; a += WFSIZE)
             {
-                // Ghost column
-                ++gst_nnz;
+                I col_a = csr_col_ind_A[a];
+                T val_a = val_r * csr_val_A[a];
+
+                // Accumulate the corresponding row of P
+                for(J p = csr_row_ptr_P[col_a]; p < csr_row_ptr_P[col_a + 1]; ++p)
+                {
+                    map.insert_or_add(csr_col_ind_P[p], val_a * csr_val_P[p]);
+                }
             }
         }
 
-        // Index into extracted matrix, we have to use atomics here, because other
-        // blocks might also update this row
-        I idx_int = atomicAdd(int_csr_row_ptr + row, int_nnz);
-        I idx_gst = atomicAdd(gst_csr_row_ptr + row, gst_nnz);
-
-        for(I j = row_begin; j < row_end; ++j)
-        {
-            K col = csr_col_ind[j];
+        // Access into C
+        J idx = csr_row_ptr_C[row];
 
-            if(col >= global_column_begin && col < global_column_end)
-            {
-                // Interior column
-                int_csr_col_ind[idx_int] = col - global_column_begin;
-                int_csr_val[idx_int]     = csr_val[j];
+        // Store key val pairs from map into C
+        map.store_sorted(&csr_col_ind_C[idx], &csr_val_C[idx]);
+    }
 
-                ++idx_int;
-            }
-            else
-            {
-                // Ghost column
-                gst_csr_col_ind[idx_gst] = col;
-                gst_csr_val[idx_gst]     = csr_val[j];
+    // Number of non-zero entries per row of the prolongation created from a map, i.e.
+    // one entry for each fine row that is mapped to a coarse row
+    template <typename I, typename J>
+    __global__ void
+        kernel_csr_map_prolong_nnz(I nrow, const I* __restrict__ map, J* __restrict__ row_nnz)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-                ++idx_gst;
-            }
+        if(row >= nrow)
+        {
+            return;
         }
+
+        row_nnz[row] = (map[row] < 0) ? 0 : 1;
     }
 
-    template <typename I>
-    __global__ void kernel_csr_update_numbering(I size,
-                                                const I* __restrict__ counts,
-                                                const I* __restrict__ perm,
-                                                I* __restrict__ out)
+    // Fill the prolongation created from a map
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_map_prolong_fill(I nrow,
+                                                const I* __restrict__ map,
+                                                const J* __restrict__ csr_row_ptr,
+                                                I* __restrict__ csr_col_ind,
+                                                T* __restrict__ csr_val)
     {
-        I idx = blockIdx.x * blockDim.x + threadIdx.x;
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(idx >= size)
+        if(row >= nrow)
         {
             return;
         }
 
-        // Entry and exit point from run length encode
-        I begin = counts[idx];
-        I end   = counts[idx + 1];
+        I col = map[row];
 
-        for(I i = begin; i < end; ++i)
+        if(col < 0)
         {
-            out[perm[i]] = idx;
+            return;
         }
+
+        J idx = csr_row_ptr[row];
+
+        csr_col_ind[idx] = col;
+        csr_val[idx]     = static_cast<T>(1);
     }
 
+    // Number of fine rows of each coarse row, where rG holds the Gsize fine rows of all
+    // coarse rows with leading dimension rGsize (-1 marks empty slots)
     template <typename I, typename J>
-    __global__ void kernel_csr_split_interior_ghost_nnz(I m,
-                                                        const J* __restrict__ csr_row_ptr,
-                                                        const I* __restrict__ csr_col_ind,
-                                                        J* __restrict__ int_row_nnz,
-                                                        J* __restrict__ gst_row_nnz)
+    __global__ void kernel_csr_coarsen_restrict_nnz(
+        I nrow, I Gsize, I rGsize, const I* __restrict__ rG, J* __restrict__ row_nnz)
     {
         I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(row >= m)
+        if(row >= nrow)
         {
             return;
         }
 
-        I int_nnz = 0;
-        I gst_nnz = 0;
-
-        J row_begin = csr_row_ptr[row];
-        J row_end   = csr_row_ptr[row + 1];
+        J nnz = 0;
 
-        for(J j = row_begin; j < row_end; ++j)
+        for(I r = 0; r < Gsize; ++r)
         {
-            I col = csr_col_ind[j];
-
-            if(col >= m)
-            {
-                // This is a ghost column
-                ++gst_nnz;
-            }
-            else
+            if(rG[r * rGsize + row] >= 0)
             {
-                // This is an interior column
-                ++int_nnz;
+                ++nnz;
             }
         }
 
-        int_row_nnz[row] = int_nnz;
-        gst_row_nnz[row] = gst_nnz;
+        row_nnz[row] = nnz;
     }
 
+    // Fill the restriction of the fine rows of each coarse row, sorted by column
     template <typename T, typename I, typename J>
-    __global__ void kernel_csr_split_interior_ghost(I m,
-                                                    const J* __restrict__ csr_row_ptr,
-                                                    const I* __restrict__ csr_col_ind,
-                                                    const T* __restrict__ csr_val,
-                                                    const J* __restrict__ int_csr_row_ptr,
-                                                    I* __restrict__ int_csr_col_ind,
-                                                    T* __restrict__ int_csr_val,
-                                                    const J* __restrict__ gst_csr_row_ptr,
-                                                    I* __restrict__ gst_csr_col_ind,
-                                                    T* __restrict__ gst_csr_val)
+    __global__ void kernel_csr_coarsen_restrict_fill(I nrow,
+                                                     I Gsize,
+                                                     I rGsize,
+                                                     const I* __restrict__ rG,
+                                                     const J* __restrict__ csr_row_ptr,
+                                                     I* __restrict__ csr_col_ind,
+                                                     T* __restrict__ csr_val)
     {
         I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(row >= m)
+        if(row >= nrow)
         {
             return;
         }
 
         J row_begin = csr_row_ptr[row];
-        J row_end   = csr_row_ptr[row + 1];
-
-        J idx_int = int_csr_row_ptr[row];
-        J idx_gst = gst_csr_row_ptr[row];
+        J idx       = row_begin;
 
-        for(J j = row_begin; j < row_end; ++j)
+        for(I r = 0; r < Gsize; ++r)
         {
-            I col = csr_col_ind[j];
+            I col = rG[r * rGsize + row];
 
-            if(col >= m)
+            if(col < 0)
             {
-                // This is a ghost column
-                gst_csr_col_ind[idx_gst] = col - m;
-                gst_csr_val[idx_gst]     = csr_val[j];
-
-                ++idx_gst;
+                continue;
             }
-            else
-            {
-                // This is an interior column
-                int_csr_col_ind[idx_int] = col;
-                int_csr_val[idx_int]     = csr_val[j];
 
-                ++idx_int;
+            // Insertion sort, Gsize is small
+            J j = idx;
+
+            while(j > row_begin && csr_col_ind[j - 1] > col)
+            {
+                csr_col_ind[j] = csr_col_ind[j - 1];
+                --j;
             }
+
+            csr_col_ind[j] = col;
+            csr_val[idx]   = static_cast<T>(1);
+
+            ++idx;
         }
     }
 
-    template <typename I, typename K>
-    __global__ void kernel_csr_extract_global_column_indices(I ncol,
-                                                             I nnz,
-                                                             K global_offset,
-                                                             const I* __restrict__ csr_col_ind,
-                                                             const K* __restrict__ l2g,
-                                                             K* __restrict__ global_col)
+    // Pairwise aggregation by handshake matching. The state of each row is -2 while it is
+    // unmatched, -1 if it is excluded from the aggregation and the matched row otherwise
+    // (the row itself for a singleton). In each round, all unmatched rows propose their
+    // strongest unmatched neighbor, and two rows that propose each other form a pair.
+
+    // Exclude the rows with strong diagonal dominance from the initial aggregation
+    template <typename T, typename I, typename J>
+    __global__ void kernel_csr_pairwise_exclude(I nrow,
+                                                const J* __restrict__ csr_row_ptr,
+                                                const I* __restrict__ csr_col_ind,
+                                                const T* __restrict__ csr_val,
+                                                I* __restrict__ match)
     {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(gid >= nnz)
+        if(row >= nrow)
         {
             return;
         }
 
-        int local_col = csr_col_ind[gid];
+        double diag = 0.0;
+        double sum  = 0.0;
 
-        if(local_col >= ncol)
-        {
-            // This is an ext column, map to global
-            global_col[gid] = l2g[local_col - ncol];
-        }
-        else
+        for(J j = csr_row_ptr[row]; j < csr_row_ptr[row + 1]; ++j)
         {
-            // This is a local column, shift by offset
-            global_col[gid] = local_col + global_offset;
+            if(csr_col_ind[j] == row)
+            {
+                diag = hip_real(csr_val[j]);
+            }
+            else
+            {
+                sum += hip_abs(csr_val[j]);
+            }
         }
+
+        match[row] = (diag > 5.0 * sum) ? -1 : -2;
     }
 
-    template <typename I, typename K>
-    __global__ void kernel_csr_renumber_global_to_local_count(I nnz,
-                                                              const K* __restrict__ global_sorted,
-                                                              I* __restrict__ local_col)
+    // Symmetric hash of the edge between rows a and b
+    template <typename I>
+    __device__ __forceinline__ uint64_t pairwise_edge_hash(I a, I b)
     {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        uint64_t lo = static_cast<uint64_t>(a < b ? a : b);
+        uint64_t hi = static_cast<uint64_t>(a < b ? b : a);
 
-        // Do not run out of bounds
-        if(gid >= nnz)
+        return hash_mix((lo << 32) | hi);
+    }
+
+    // Propose the unmatched neighbor with the most negative (relative to the sign of the
+    // diagonal) coupling, if it is strong compared to the largest (initial aggregation) or
+    // smallest (further aggregation) off-diagonal entry of the row
+    template <bool INITIAL, typename T, typename I, typename J>
+    __global__ void kernel_csr_pairwise_candidate(I      nrow,
+                                                  double beta,
+                                                  const J* __restrict__ csr_row_ptr,
+                                                  const I* __restrict__ csr_col_ind,
+                                                  const T* __restrict__ csr_val,
+                                                  const I* __restrict__ match,
+                                                  I* __restrict__ cand)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(row >= nrow)
         {
             return;
         }
 
-        // First column entry cannot be a duplicate
-        if(gid == 0)
+        if(match[row] != -2)
         {
-            local_col[0] = 1;
-
+            cand[row] = -1;
             return;
         }
 
-        // Get global column
-        K global_col = global_sorted[gid];
-        K prev_col   = global_sorted[gid - 1];
-
-        // Compare column indices
-        if(global_col == prev_col)
-        {
-            // Same index as previous column
-            local_col[gid] = 0;
-        }
-        else
-        {
-            // New local column index
-            local_col[gid] = 1;
-        }
-    }
+        J row_begin = csr_row_ptr[row];
+        J row_end   = csr_row_ptr[row + 1];
 
-    template <typename I>
-    __global__ void kernel_csr_renumber_global_to_local_fill(I nnz,
-                                                             const I* __restrict__ local_col,
-                                                             const I* __restrict__ perm,
-                                                             I* __restrict__ csr_col_ind)
-    {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        double sign = 1.0;
 
-        // Do not run out of bounds
-        if(gid >= nnz)
+        for(J j = row_begin; j < row_end; ++j)
         {
-            return;
+            if(csr_col_ind[j] == row && hip_real(csr_val[j]) < 0.0)
+            {
+                sign = -1.0;
+            }
         }
 
-        // Back permutation into matrix
-        csr_col_ind[perm[gid]] = local_col[gid] - 1;
-    }
-
-    template <typename I, typename K>
-    __global__ void kernel_csr_local_to_global(I nnz,
-                                               const K* __restrict__ l2g,
-                                               const I* __restrict__ local,
-                                               K* __restrict__ global)
-    {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        bool     found     = false;
+        double   ref       = 0.0;
+        double   best_val  = 0.0;
+        I        best_col  = -1;
+        uint64_t best_hash = 0;
 
-        // Do not run out of bounds
-        if(gid >= nnz)
+        for(J j = row_begin; j < row_end; ++j)
         {
-            return;
-        }
+            I col = csr_col_ind[j];
 
-        // Convert local to global
-        global[gid] = l2g[local[gid]];
-    }
+            if(col == row)
+            {
+                continue;
+            }
 
-    template <typename I, typename K>
-    __global__ void kernel_csr_ghost_columns_nnz(int64_t size,
-                                                 K       global_column_begin,
-                                                 K       global_column_end,
-                                                 const K* __restrict__ in,
-                                                 I* __restrict__ nnz)
-    {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+            double val = sign * hip_real(csr_val[j]);
+
+            if(found == false)
+            {
+                ref   = val;
+                found = true;
+            }
+            else
+            {
+                ref = INITIAL ? (val > ref ? val : ref) : (val < ref ? val : ref);
+            }
 
-        // Do not run out of bounds
-        if(gid >= size)
-        {
-            return;
-        }
+            if(match[col] != -2)
+            {
+                continue;
+            }
 
-        // Get global column id
-        K col = in[gid];
+            // Ties are broken by a hash of the edge, which both rows agree on, such that
+            // equal couplings (e.g. of a stencil) do not form chains of proposals
+            uint64_t hash = pairwise_edge_hash(row, col);
 
-        // Count this column if its not interior
-        nnz[gid] = (col < global_column_begin || col >= global_column_end) ? 1 : 0;
+            if(best_col == -1 || val < best_val || (val == best_val && hash > best_hash))
+            {
+                best_val  = val;
+                best_col  = col;
+                best_hash = hash;
+            }
+        }
+
+        cand[row] = (best_col != -1 && best_val < -beta * ref) ? best_col : -1;
     }
 
-    template <typename I, typename K>
-    __global__ void kernel_csr_ghost_columns_fill(int64_t nnz,
-                                                  K       global_column_begin,
-                                                  K       global_column_end,
-                                                  const K* __restrict__ in,
-                                                  const I* __restrict__ nnz_ptr,
-                                                  K* __restrict__ out)
+    // Match the rows that propose each other
+    template <typename I>
+    __global__ void
+        kernel_csr_pairwise_handshake(I nrow, const I* __restrict__ cand, I* __restrict__ match)
     {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(gid >= nnz)
+        if(row >= nrow)
         {
             return;
         }
 
-        // Get global column id
-        K col = in[gid];
+        I col = cand[row];
 
-        // Count this column if its not interior
-        if(col < global_column_begin || col >= global_column_end)
+        if(col >= 0 && cand[col] == row)
         {
-            out[nnz_ptr[gid]] = col;
+            match[row] = col;
         }
     }
 
-    template <typename I, typename K>
-    __global__ void kernel_csr_column_id_transfer(int64_t nnz,
-                                                  I       ncol,
-                                                  K       global_column_begin,
-                                                  K       global_column_end,
-                                                  const K* __restrict__ global,
-                                                  const I* __restrict__ cmb,
-                                                  const I* __restrict__ nnz_ptr,
-                                                  I* __restrict__ out)
+    // Turn the remaining unmatched rows into singletons and flag the first row of each
+    // aggregate
+    template <typename I, typename J>
+    __global__ void
+        kernel_csr_pairwise_leader(I nrow, I* __restrict__ match, J* __restrict__ leader)
     {
-        I gid = blockIdx.x * blockDim.x + threadIdx.x;
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(gid >= nnz)
+        if(row >= nrow)
         {
             return;
         }
 
-        K global_col = global[gid];
+        I m = match[row];
 
-        // Filter external source to match given column id interval
-        if(global_col >= global_column_begin && global_col < global_column_end)
-        {
-            // Map column into interval
-            out[gid] = global_col - global_column_begin;
-        }
-        else
+        if(m == -2)
         {
-            out[gid] = cmb[nnz_ptr[gid]] + ncol;
+            m          = row;
+            match[row] = m;
         }
+
+        leader[row] = (m >= row) ? 1 : 0;
     }
 
-    // Count the number of nnz per row of two matrices
+    // Aggregate G of each row and rows rG of each aggregate of the initial aggregation,
+    // agg holds the aggregate numbers of the first rows
     template <typename I, typename J>
-    __global__ void kernel_csr_combined_row_nnz(I m,
-                                                const J* __restrict__ csr_row_ptr_A,
-                                                const J* __restrict__ csr_row_ptr_B,
-                                                J* __restrict__ row_nnz)
+    __global__ void kernel_csr_pairwise_initial_fill(I nrow,
+                                                     I rGsize,
+                                                     const I* __restrict__ match,
+                                                     const J* __restrict__ agg,
+                                                     I* __restrict__ G,
+                                                     I* __restrict__ rG)
     {
         I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Do not run out of bounds
-        if(row >= m)
+        if(row >= nrow)
         {
             return;
         }
 
-        // Write combined number of row nnz for this row
-        row_nnz[row] = csr_row_ptr_A[row + 1] - csr_row_ptr_A[row] + csr_row_ptr_B[row + 1]
-                       - csr_row_ptr_B[row];
-    }
-
-    template <bool         GLOBAL,
-              unsigned int BLOCKSIZE,
-              unsigned int WFSIZE,
-              unsigned int HASHSIZE,
-              typename I,
-              typename J,
-              typename K>
-    __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_compress_add_nnz(I m,
-                                         const J* __restrict__ csr_row_ptr_A,
-                                         const I* __restrict__ csr_col_ind_A,
-                                         const J* __restrict__ csr_row_ptr_B,
-                                         const K* __restrict__ csr_col_ind_B,
-                                         const K* __restrict__ l2g,
-                                         J* __restrict__ row_nnz)
-    {
-        unsigned int lid = threadIdx.x & (WFSIZE - 1);
-        unsigned int wid = threadIdx.x / WFSIZE;
-
-        // The row this thread operates on
-        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
+        I m = match[row];
 
-        // Do not run out of bounds
-        if(row >= m)
+        if(m == -1)
         {
+            G[row] = -1;
             return;
         }
 
-        // Row nnz counter
-        I nnz = 0;
+        I first = (m < row) ? m : row;
+        I k     = static_cast<I>(agg[first]);
 
-        // Shared memory for the unordered set
-        __shared__ K sdata[BLOCKSIZE / WFSIZE * HASHSIZE];
+        G[row] = k;
 
-        // Each wavefront operates on its own set
-        unordered_set<K, HASHSIZE, WFSIZE> set(&sdata[wid * HASHSIZE]);
+        if(first == row)
+        {
+            rG[k]          = row;
+            rG[rGsize + k] = (m != row) ? m : -1;
+        }
+    }
 
-        // Row entry and exit points of A
-        J row_begin_A = csr_row_ptr_A[row];
-        J row_end_A   = csr_row_ptr_A[row + 1];
+    // Merge the fine rows of the matched coarse rows of a further aggregation, the first
+    // row of each aggregate writes the Gsize fine rows of both coarse rows
+    template <typename I, typename J>
+    __global__ void kernel_csr_pairwise_further_fill(I nrow,
+                                                     I Gsize,
+                                                     I rGsize,
+                                                     const I* __restrict__ rG,
+                                                     I rGsizec,
+                                                     const I* __restrict__ match,
+                                                     const J* __restrict__ agg,
+                                                     I* __restrict__ G,
+                                                     I* __restrict__ rGc)
+    {
+        I row = blockIdx.x * blockDim.x + threadIdx.x;
 
-        // Loop over all columns of the i-th row, whereas each lane processes a column
-        for(J j = row_begin_A + lid; j < row_end_A; j += WFSIZE)
+        if(row >= nrow)
         {
-            // Get the column index
-            K col_j = GLOBAL ? l2g[csr_col_ind_A[j]] : csr_col_ind_A[j];
-
-            // Add column to the set
-            nnz += set.insert(col_j);
+            return;
         }
 
-        // Row entry and exit points of B
-        J row_begin_B = csr_row_ptr_B[row];
-        J row_end_B   = csr_row_ptr_B[row + 1];
+        I m = match[row];
 
-        // Loop over all columns of the i-th row, whereas each lane processes a column
-        for(J j = row_begin_B + lid; j < row_end_B; j += WFSIZE)
+        if(m < row)
         {
-            // Add column to the set
-            nnz += set.insert(csr_col_ind_B[j]);
+            return;
         }
 
-        // Sum up the row nnz from all lanes
-        wf_reduce_sum<WFSIZE>(&nnz);
+        I k = static_cast<I>(agg[row]);
 
-        // Last lane in wavefront writes row nnz back to global memory
-        if(lid == WFSIZE - 1)
+        for(I r = 0; r < Gsize; ++r)
         {
-            row_nnz[row] = nnz;
+            I fine    = rG[r * rGsize + row];
+            I partner = (m != row) ? rG[r * rGsize + m] : -1;
+
+            rGc[r * rGsizec + k]           = fine;
+            rGc[(r + Gsize) * rGsizec + k] = partner;
+
+            if(fine >= 0)
+            {
+                G[fine] = k;
+            }
+
+            if(partner >= 0)
+            {
+                G[partner] = k;
+            }
         }
     }
 
-    template <bool         GLOBAL,
-              unsigned int BLOCKSIZE,
-              unsigned int WFSIZE,
-              unsigned int HASHSIZE,
-              typename T,
-              typename I,
-              typename J,
-              typename K>
+    // Jacobi sweeps x = D^-1 (b - (L or U) x) of the iterative triangular solve, starting
+    // from x = 0. All sweeps run in a single cooperative launch, the grid synchronizes
+    // after each sweep and the max norm of the update is reduced into one of three
+    // rotating slots of delta, such that all blocks can exit early on convergence.
+    // The slots of delta have to be zero on entry.
+    template <unsigned int BLOCKSIZE, bool LOWER, typename T, typename I, typename J>
     __launch_bounds__(BLOCKSIZE) __global__
-        void kernel_csr_compress_add_fill(I m,
-                                          const J* __restrict__ csr_row_ptr_A,
-                                          const I* __restrict__ csr_col_ind_A,
-                                          const T* __restrict__ csr_val_A,
-                                          const J* __restrict__ csr_row_ptr_B,
-                                          const K* __restrict__ csr_col_ind_B,
-                                          const T* __restrict__ csr_val_B,
-                                          const K* __restrict__ l2g,
-                                          const J* __restrict__ csr_row_ptr_C,
-                                          K* __restrict__ csr_col_ind_C,
-                                          T* __restrict__ csr_val_C)
+        void kernel_csr_itsv_persistent(I nrow,
+                                        const J* __restrict__ row_offset,
+                                        const I* __restrict__ col,
+                                        const T* __restrict__ val,
+                                        bool unit_diag,
+                                        int  max_iter,
+                                        double tol,
+                                        bool   use_tol,
+                                        const T* __restrict__ b,
+                                        T* x,
+                                        T* buffer,
+                                        unsigned long long* __restrict__ delta)
     {
-        unsigned int lid = threadIdx.x & (WFSIZE - 1);
-        unsigned int wid = threadIdx.x / WFSIZE;
+        cooperative_groups::grid_group grid = cooperative_groups::this_grid();
 
-        // The row this thread operates on
-        I row = blockIdx.x * BLOCKSIZE / WFSIZE + wid;
-
-        // Do not run out of bounds
-        if(row >= m)
-        {
-            return;
-        }
+        __shared__ double sdata[BLOCKSIZE];
 
-        // Shared memory for the map
-        extern __shared__ char smem[];
+        unsigned int tid    = threadIdx.x;
+        I            gid    = blockIdx.x * BLOCKSIZE + tid;
+        I            stride = gridDim.x * BLOCKSIZE;
 
-        K* stable = reinterpret_cast<K*>(smem);
-        T* sdata  = reinterpret_cast<T*>(stable + BLOCKSIZE / WFSIZE * HASHSIZE);
+        // Previous and current iterate
+        T* prev = x;
+        T* next = buffer;
 
-        // Each wavefront operates on its own map
-        unordered_map<K, T, HASHSIZE, WFSIZE> map(&stable[wid * HASHSIZE], &sdata[wid * HASHSIZE]);
+        for(int iter = 0; iter < max_iter; ++iter)
+        {
+            double local = 0.0;
 
-        // Row entry and exit points of A
-        J row_begin_A = csr_row_ptr_A[row];
-        J row_end_A   = csr_row_ptr_A[row + 1];
+            for(I row = gid; row < nrow; row += stride)
+            {
+                T sum  = b[row];
+                T diag = static_cast<T>(1);
 
-        // Loop over all columns of the i-th row, whereas each lane processes a column
-        for(J j = row_begin_A + lid; j < row_end_A; j += WFSIZE)
-        {
-            // Get the column index and value
-            K col_j = GLOBAL ? l2g[csr_col_ind_A[j]] : csr_col_ind_A[j];
+                for(J j = row_offset[row]; j < row_offset[row + 1]; ++j)
+                {
+                    I c = col[j];
 
-            // Accumulate
-            map.insert_or_add(col_j, csr_val_A[j]);
-        }
+                    if(c == row)
+                    {
+                        if(unit_diag == false)
+                        {
+                            diag = val[j];
+                        }
+                    }
+                    else if((LOWER == true && c < row) || (LOWER == false && c > row))
+                    {
+                        if(iter > 0)
+                        {
+                            sum = sum - val[j] * prev[c];
+                        }
+                    }
+                }
 
-        // Row entry and exit points of B
-        J row_begin_B = csr_row_ptr_B[row];
-        J row_end_B   = csr_row_ptr_B[row + 1];
+                T xnew = sum / diag;
+                T xold = (iter > 0) ? prev[row] : static_cast<T>(0);
 
-        // Loop over all columns of the i-th row, whereas each lane processes a column
-        for(J j = row_begin_B + lid; j < row_end_B; j += WFSIZE)
-        {
-            // Accumulate
-            map.insert_or_add(csr_col_ind_B[j], csr_val_B[j]);
-        }
+                local = max(local, static_cast<double>(hip_abs(xnew - xold)));
 
-        // Finally, extract the numerical values from the hash map and fill C such
-        // that the resulting matrix is sorted by columns
-        for(unsigned int i = lid; i < HASHSIZE; i += WFSIZE)
-        {
-            // Get column from map to fill into C
-            K col = map.get_key(i);
+                next[row] = xnew;
+            }
 
-            // Skip, if table is empty
-            if(col == map.empty_key())
+            if(use_tol == true)
             {
-                continue;
-            }
+                // Block wide max reduction of the update
+                sdata[tid] = local;
 
-            // Get index into C
-            J idx = csr_row_ptr_C[row];
+                __syncthreads();
 
-            // Hash table index counter
-            unsigned int cnt = 0;
+                for(unsigned int i = BLOCKSIZE >> 1; i > 0; i >>= 1)
+                {
+                    if(tid < i)
+                    {
+                        sdata[tid] = max(sdata[tid], sdata[tid + i]);
+                    }
 
-            // Go through the hash table, until we reach its end
-            while(cnt < HASHSIZE)
-            {
-                // We are searching for the right place in C to
-                // insert the i-th hash table entry.
-                // If the i-th hash table column entry is greater then the current one,
-                // we need to leave a slot to its left.
-                if(col > map.get_key(cnt))
+                    __syncthreads();
+                }
+
+                // Non-negative doubles order like their bit patterns
+                if(tid == 0)
                 {
-                    ++idx;
+                    atomicMax(&delta[iter % 3],
+                              static_cast<unsigned long long>(__double_as_longlong(sdata[0])));
                 }
 
-                // Process next hash table entry
-                ++cnt;
+                // The slot of the next sweep has been read by all blocks two sweeps ago
+                if(gid == 0)
+                {
+                    delta[(iter + 1) % 3] = 0ULL;
+                }
             }
 
-            // Add hash table entry into P
-            csr_col_ind_C[idx] = col;
-            csr_val_C[idx]     = map.get_val(i);
+            grid.sync();
+
+            T* tmp = prev;
+            prev   = next;
+            next   = tmp;
+
+            if(use_tol == true && __longlong_as_double(delta[iter % 3]) <= tol)
+            {
+                break;
+            }
+        }
+
+        // Move the result into x, if the last sweep wrote into the buffer
+        if(prev != x)
+        {
+            for(I row = gid; row < nrow; row += stride)
+            {
+                x[row] = prev[row];
+            }
         }
     }
 
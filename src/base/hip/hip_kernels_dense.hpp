@@ -25,6 +25,7 @@
 #define ROCALUTION_HIP_HIP_KERNELS_DENSE_HPP_
 
 #include "../matrix_formats_ind.hpp"
+#include "hip_utils.hpp"
 
 #include <hip/hip_runtime.h>
 
@@ -103,6 +104,42 @@ namespace rocalution
         vec[aj] = mat[DENSE_IND(idx, aj, nrow, ncol)];
     }
 
+    // Householder scalars of the reflectors stored below the diagonal with implicit unit
+    // leading entry, tau = 2 / (1 + ||v||^2), zero if the reflection is the identity
+    template <unsigned int BLOCKSIZE, typename ValueType, typename IndexType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_dense_householder_tau(IndexType nrow,
+                                          IndexType ncol,
+                                          const ValueType* __restrict__ mat,
+                                          ValueType* __restrict__ tau)
+    {
+        unsigned int tid = hipThreadIdx_x;
+        IndexType    col = hipBlockIdx_x;
+
+        __shared__ ValueType sdata[BLOCKSIZE];
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(IndexType ai = col + 1 + tid; ai < nrow; ai += BLOCKSIZE)
+        {
+            ValueType v = mat[DENSE_IND(ai, col, nrow, ncol)];
+            sum += v * v;
+        }
+
+        sdata[tid] = sum;
+
+        __syncthreads();
+
+        block_reduce_sum<BLOCKSIZE>(tid, sdata);
+
+        if(tid == 0)
+        {
+            ValueType beta = static_cast<ValueType>(2) / (static_cast<ValueType>(1) + sdata[0]);
+
+            tau[col] = (beta == static_cast<ValueType>(2)) ? static_cast<ValueType>(0) : beta;
+        }
+    }
+
 } // namespace rocalution
 
 #endif // ROCALUTION_HIP_HIP_KERNELS_DENSE_HPP_
@@ -0,0 +1,291 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_HIP_HIP_KERNELS_SELL_HPP_
+#define ROCALUTION_HIP_HIP_KERNELS_SELL_HPP_
+
+#include "../matrix_formats_ind.hpp"
+
+#include <hip/hip_runtime.h>
+
+namespace rocalution
+{
+
+    // One thread per (sorted) row, consecutive threads access consecutive
+    // entries of a slice column
+    template <typename ValueType, typename IndexType, typename PointerType>
+    __global__ void kernel_sell_spmv(IndexType num_rows,
+                                     IndexType slice_size,
+                                     const PointerType* __restrict__ slice_offset,
+                                     const IndexType* __restrict__ perm,
+                                     const IndexType* __restrict__ Acol,
+                                     const ValueType* __restrict__ Aval,
+                                     const ValueType* __restrict__ x,
+                                     ValueType* __restrict__ y)
+    {
+        IndexType row = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+
+        if(row >= num_rows)
+        {
+            return;
+        }
+
+        IndexType   slice  = row / slice_size;
+        IndexType   r      = row % slice_size;
+        PointerType offset = slice_offset[slice];
+        PointerType width  = (slice_offset[slice + 1] - offset) / slice_size;
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(PointerType n = 0; n < width; ++n)
+        {
+            PointerType ind = SELL_IND(offset, r, n, slice_size);
+            IndexType   col = Acol[ind];
+
+            if(col >= 0)
+            {
+                sum = sum + Aval[ind] * x[col];
+            }
+        }
+
+        y[perm[row]] = sum;
+    }
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    __global__ void kernel_sell_add_spmv(IndexType num_rows,
+                                         IndexType slice_size,
+                                         const PointerType* __restrict__ slice_offset,
+                                         const IndexType* __restrict__ perm,
+                                         const IndexType* __restrict__ Acol,
+                                         const ValueType* __restrict__ Aval,
+                                         ValueType scalar,
+                                         const ValueType* __restrict__ x,
+                                         ValueType* __restrict__ y)
+    {
+        IndexType row = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+
+        if(row >= num_rows)
+        {
+            return;
+        }
+
+        IndexType   slice  = row / slice_size;
+        IndexType   r      = row % slice_size;
+        PointerType offset = slice_offset[slice];
+        PointerType width  = (slice_offset[slice + 1] - offset) / slice_size;
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(PointerType n = 0; n < width; ++n)
+        {
+            PointerType ind = SELL_IND(offset, r, n, slice_size);
+            IndexType   col = Acol[ind];
+
+            if(col >= 0)
+            {
+                sum = sum + Aval[ind] * x[col];
+            }
+        }
+
+        IndexType ai = perm[row];
+
+        y[ai] = y[ai] + scalar * sum;
+    }
+
+    // Row lengths and identity permutation, the sort keys of csr_to_sell
+    template <typename IndexType, typename PointerType>
+    __global__ void kernel_sell_row_nnz(IndexType num_rows,
+                                        const PointerType* __restrict__ csr_row_ptr,
+                                        IndexType* __restrict__ row_nnz,
+                                        IndexType* __restrict__ perm)
+    {
+        IndexType row = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+
+        if(row >= num_rows)
+        {
+            return;
+        }
+
+        row_nnz[row] = static_cast<IndexType>(csr_row_ptr[row + 1] - csr_row_ptr[row]);
+        perm[row]    = row;
+    }
+
+    // Boundaries of the sorting windows
+    template <typename IndexType>
+    __global__ void kernel_sell_window_offset(IndexType num_rows,
+                                              IndexType num_windows,
+                                              IndexType sigma,
+                                              IndexType* __restrict__ window_offset)
+    {
+        IndexType w = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+
+        if(w > num_windows)
+        {
+            return;
+        }
+
+        window_offset[w] = min(w * sigma, num_rows);
+    }
+
+    // Size of each slice, given by its first (i.e. longest) row
+    template <typename IndexType, typename PointerType>
+    __global__ void kernel_sell_slice_nnz(IndexType num_slices,
+                                          IndexType slice_size,
+                                          const IndexType* __restrict__ sorted_row_nnz,
+                                          PointerType* __restrict__ slice_nnz)
+    {
+        IndexType s = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+
+        if(s > num_slices)
+        {
+            return;
+        }
+
+        slice_nnz[s] = (s < num_slices)
+                           ? static_cast<PointerType>(sorted_row_nnz[s * slice_size]) * slice_size
+                           : static_cast<PointerType>(0);
+    }
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    __global__ void kernel_sell_fill(IndexType num_rows,
+                                     IndexType num_slices,
+                                     IndexType slice_size,
+                                     const PointerType* __restrict__ csr_row_ptr,
+                                     const IndexType* __restrict__ csr_col_ind,
+                                     const ValueType* __restrict__ csr_val,
+                                     const PointerType* __restrict__ slice_offset,
+                                     const IndexType* __restrict__ perm,
+                                     IndexType* __restrict__ sell_col,
+                                     ValueType* __restrict__ sell_val)
+    {
+        IndexType row = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+
+        if(row >= num_slices * slice_size)
+        {
+            return;
+        }
+
+        IndexType   slice  = row / slice_size;
+        IndexType   r      = row % slice_size;
+        PointerType offset = slice_offset[slice];
+        PointerType width  = (slice_offset[slice + 1] - offset) / slice_size;
+        PointerType n      = 0;
+
+        if(row < num_rows)
+        {
+            IndexType ai = perm[row];
+
+            for(PointerType aj = csr_row_ptr[ai]; aj < csr_row_ptr[ai + 1]; ++aj)
+            {
+                PointerType ind = SELL_IND(offset, r, n, slice_size);
+
+                sell_col[ind] = csr_col_ind[aj];
+                sell_val[ind] = csr_val[aj];
+                ++n;
+            }
+        }
+
+        // Pad the remaining entries of the slice
+        for(; n < width; ++n)
+        {
+            PointerType ind = SELL_IND(offset, r, n, slice_size);
+
+            sell_col[ind] = static_cast<IndexType>(-1);
+            sell_val[ind] = static_cast<ValueType>(0);
+        }
+    }
+
+    template <typename IndexType, typename PointerType>
+    __global__ void kernel_sell_csr_row_nnz(IndexType num_rows,
+                                            IndexType slice_size,
+                                            const PointerType* __restrict__ slice_offset,
+                                            const IndexType* __restrict__ perm,
+                                            const IndexType* __restrict__ sell_col,
+                                            PointerType* __restrict__ csr_row_nnz)
+    {
+        IndexType row = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+
+        if(row >= num_rows)
+        {
+            return;
+        }
+
+        IndexType   slice  = row / slice_size;
+        IndexType   r      = row % slice_size;
+        PointerType offset = slice_offset[slice];
+        PointerType width  = (slice_offset[slice + 1] - offset) / slice_size;
+
+        PointerType nnz = 0;
+
+        for(PointerType n = 0; n < width; ++n)
+        {
+            if(sell_col[SELL_IND(offset, r, n, slice_size)] >= 0)
+            {
+                ++nnz;
+            }
+        }
+
+        csr_row_nnz[perm[row]] = nnz;
+    }
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    __global__ void kernel_sell_csr_fill(IndexType num_rows,
+                                         IndexType slice_size,
+                                         const PointerType* __restrict__ slice_offset,
+                                         const IndexType* __restrict__ perm,
+                                         const IndexType* __restrict__ sell_col,
+                                         const ValueType* __restrict__ sell_val,
+                                         const PointerType* __restrict__ csr_row_ptr,
+                                         IndexType* __restrict__ csr_col_ind,
+                                         ValueType* __restrict__ csr_val)
+    {
+        IndexType row = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+
+        if(row >= num_rows)
+        {
+            return;
+        }
+
+        IndexType   slice  = row / slice_size;
+        IndexType   r      = row % slice_size;
+        PointerType offset = slice_offset[slice];
+        PointerType width  = (slice_offset[slice + 1] - offset) / slice_size;
+        PointerType idx    = csr_row_ptr[perm[row]];
+
+        for(PointerType n = 0; n < width; ++n)
+        {
+            PointerType ind = SELL_IND(offset, r, n, slice_size);
+            IndexType   col = sell_col[ind];
+
+            if(col >= 0)
+            {
+                csr_col_ind[idx] = col;
+                csr_val[idx]     = sell_val[ind];
+                ++idx;
+            }
+        }
+    }
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HIP_HIP_KERNELS_SELL_HPP_
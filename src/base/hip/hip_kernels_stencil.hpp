@@ -0,0 +1,182 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_HIP_HIP_KERNELS_STENCIL_HPP_
+#define ROCALUTION_HIP_HIP_KERNELS_STENCIL_HPP_
+
+#include <hip/hip_runtime.h>
+
+namespace rocalution
+{
+    // Load the (BX + 2) x (BY + 2) tile of plane iz, including its halo, into shared
+    // memory. Points outside of the grid are zero (homogeneous Dirichlet boundary).
+    template <unsigned int BX, unsigned int BY, typename ValueType>
+    __device__ void stencil_load_tile(int iz,
+                                      int size,
+                                      const ValueType* __restrict__ x,
+                                      ValueType* __restrict__ tile)
+    {
+        int x0 = hipBlockIdx_x * BX - 1;
+        int y0 = hipBlockIdx_y * BY - 1;
+
+        for(unsigned int j = hipThreadIdx_y; j < BY + 2; j += BY)
+        {
+            for(unsigned int i = hipThreadIdx_x; i < BX + 2; i += BX)
+            {
+                int ix = x0 + i;
+                int iy = y0 + j;
+
+                bool inside = iz >= 0 && iz < size && iy >= 0 && iy < size && ix >= 0 && ix < size;
+
+                tile[j * (BX + 2) + i] = inside ? x[(static_cast<int64_t>(iz) * size + iy) * size + ix]
+                                                : static_cast<ValueType>(0);
+            }
+        }
+    }
+
+    // 5-point 2D Laplace, y = A * x or y = y + scalar * A * x
+    template <unsigned int BX, unsigned int BY, bool ADD, typename ValueType>
+    __launch_bounds__(BX* BY) __global__
+        void kernel_stencil_laplace2d(int       size,
+                                      ValueType scalar,
+                                      const ValueType* __restrict__ x,
+                                      ValueType* __restrict__ y)
+    {
+        __shared__ char smem[(BX + 2) * (BY + 2) * sizeof(ValueType)];
+
+        ValueType* tile = reinterpret_cast<ValueType*>(smem);
+
+        stencil_load_tile<BX, BY>(0, size, x, tile);
+
+        __syncthreads();
+
+        int ix = hipBlockIdx_x * BX + hipThreadIdx_x;
+        int iy = hipBlockIdx_y * BY + hipThreadIdx_y;
+
+        if(ix >= size || iy >= size)
+        {
+            return;
+        }
+
+        int t = (hipThreadIdx_y + 1) * (BX + 2) + hipThreadIdx_x + 1;
+
+        ValueType val = static_cast<ValueType>(4) * tile[t] - tile[t - 1] - tile[t + 1]
+                        - tile[t - (BX + 2)] - tile[t + (BX + 2)];
+
+        int64_t idx = static_cast<int64_t>(iy) * size + ix;
+
+        if(ADD)
+        {
+            y[idx] = y[idx] + scalar * val;
+        }
+        else
+        {
+            y[idx] = val;
+        }
+    }
+
+    // 7-point (P27 == false) or 27-point (P27 == true) 3D Laplace,
+    // y = A * x or y = y + scalar * A * x.
+    // Each block owns a BX x BY column of the grid and marches through z, keeping
+    // the planes iz - 1, iz and iz + 1 in shared memory, such that every entry of x
+    // is read once per block (2.5D blocking).
+    template <unsigned int BX, unsigned int BY, bool P27, bool ADD, typename ValueType>
+    __launch_bounds__(BX* BY) __global__
+        void kernel_stencil_laplace3d(int       size,
+                                      ValueType scalar,
+                                      const ValueType* __restrict__ x,
+                                      ValueType* __restrict__ y)
+    {
+        constexpr unsigned int TILE = (BX + 2) * (BY + 2);
+
+        __shared__ char smem[3 * TILE * sizeof(ValueType)];
+
+        ValueType* planes = reinterpret_cast<ValueType*>(smem);
+
+        int ix = hipBlockIdx_x * BX + hipThreadIdx_x;
+        int iy = hipBlockIdx_y * BY + hipThreadIdx_y;
+
+        bool active = ix < size && iy < size;
+
+        int t = (hipThreadIdx_y + 1) * (BX + 2) + hipThreadIdx_x + 1;
+
+        // Plane z is kept in slot (z + 1) % 3
+        stencil_load_tile<BX, BY>(-1, size, x, planes);
+        stencil_load_tile<BX, BY>(0, size, x, planes + TILE);
+
+        for(int iz = 0; iz < size; ++iz)
+        {
+            stencil_load_tile<BX, BY>(iz + 1, size, x, planes + ((iz + 2) % 3) * TILE);
+
+            __syncthreads();
+
+            const ValueType* prev = planes + (iz % 3) * TILE;
+            const ValueType* cur  = planes + ((iz + 1) % 3) * TILE;
+            const ValueType* next = planes + ((iz + 2) % 3) * TILE;
+
+            if(active)
+            {
+                ValueType val;
+
+                if(P27)
+                {
+                    ValueType sum = static_cast<ValueType>(0);
+
+                    for(int j = -1; j <= 1; ++j)
+                    {
+                        for(int i = -1; i <= 1; ++i)
+                        {
+                            int k = t + j * static_cast<int>(BX + 2) + i;
+
+                            sum = sum + prev[k] + cur[k] + next[k];
+                        }
+                    }
+
+                    val = static_cast<ValueType>(27) * cur[t] - sum;
+                }
+                else
+                {
+                    val = static_cast<ValueType>(6) * cur[t] - cur[t - 1] - cur[t + 1]
+                          - cur[t - (BX + 2)] - cur[t + (BX + 2)] - prev[t] - next[t];
+                }
+
+                int64_t idx = (static_cast<int64_t>(iz) * size + iy) * size + ix;
+
+                if(ADD)
+                {
+                    y[idx] = y[idx] + scalar * val;
+                }
+                else
+                {
+                    y[idx] = val;
+                }
+            }
+
+            // The slot of plane iz - 1 is overwritten in the next iteration
+            __syncthreads();
+        }
+    }
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HIP_HIP_KERNELS_STENCIL_HPP_
@@ -0,0 +1,132 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_HIP_HIP_KERNELS_VBR_HPP_
+#define ROCALUTION_HIP_HIP_KERNELS_VBR_HPP_
+
+#include "../matrix_formats_ind.hpp"
+
+#include <hip/hip_runtime.h>
+
+namespace rocalution
+{
+
+    // MAXDIM threads per block row, thread bi computes row bi of the block row.
+    // Blocks are stored column-major, thus neighbouring threads load consecutive
+    // entries of a block column
+    template <unsigned int MAXDIM, typename ValueType, typename IndexType, typename PointerType>
+    __global__ void kernel_vbr_spmv(IndexType nrowb,
+                                    const IndexType* __restrict__ row_block,
+                                    const IndexType* __restrict__ col_block,
+                                    const PointerType* __restrict__ row_offset,
+                                    const IndexType* __restrict__ col,
+                                    const PointerType* __restrict__ val_offset,
+                                    const ValueType* __restrict__ val,
+                                    const ValueType* __restrict__ x,
+                                    ValueType* __restrict__ y)
+    {
+        int64_t   gid = static_cast<int64_t>(hipBlockIdx_x) * hipBlockDim_x + hipThreadIdx_x;
+        IndexType row = static_cast<IndexType>(gid / MAXDIM);
+        IndexType bi  = static_cast<IndexType>(gid % MAXDIM);
+
+        if(row >= nrowb)
+        {
+            return;
+        }
+
+        IndexType first = row_block[row];
+        IndexType rbs   = row_block[row + 1] - first;
+
+        if(bi >= rbs)
+        {
+            return;
+        }
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(PointerType k = row_offset[row]; k < row_offset[row + 1]; ++k)
+        {
+            IndexType   bcol   = col[k];
+            IndexType   cfirst = col_block[bcol];
+            IndexType   cbs    = col_block[bcol + 1] - cfirst;
+            PointerType offset = val_offset[k];
+
+            for(IndexType bj = 0; bj < cbs; ++bj)
+            {
+                sum = sum + val[VBR_IND(offset, bi, bj, rbs)] * x[cfirst + bj];
+            }
+        }
+
+            y[first + bi] = sum;
+    }
+
+    template <unsigned int MAXDIM, typename ValueType, typename IndexType, typename PointerType>
+    __global__ void kernel_vbr_add_spmv(IndexType nrowb,
+                                        const IndexType* __restrict__ row_block,
+                                        const IndexType* __restrict__ col_block,
+                                        const PointerType* __restrict__ row_offset,
+                                        const IndexType* __restrict__ col,
+                                        const PointerType* __restrict__ val_offset,
+                                        const ValueType* __restrict__ val,
+                                        ValueType scalar,
+                                        const ValueType* __restrict__ x,
+                                        ValueType* __restrict__ y)
+    {
+        int64_t   gid = static_cast<int64_t>(hipBlockIdx_x) * hipBlockDim_x + hipThreadIdx_x;
+        IndexType row = static_cast<IndexType>(gid / MAXDIM);
+        IndexType bi  = static_cast<IndexType>(gid % MAXDIM);
+
+        if(row >= nrowb)
+        {
+            return;
+        }
+
+        IndexType first = row_block[row];
+        IndexType rbs   = row_block[row + 1] - first;
+
+        if(bi >= rbs)
+        {
+            return;
+        }
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(PointerType k = row_offset[row]; k < row_offset[row + 1]; ++k)
+        {
+            IndexType   bcol   = col[k];
+            IndexType   cfirst = col_block[bcol];
+            IndexType   cbs    = col_block[bcol + 1] - cfirst;
+            PointerType offset = val_offset[k];
+
+            for(IndexType bj = 0; bj < cbs; ++bj)
+            {
+                sum = sum + val[VBR_IND(offset, bi, bj, rbs)] * x[cfirst + bj];
+            }
+        }
+
+            y[first + bi] = y[first + bi] + scalar * sum;
+    }
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HIP_HIP_KERNELS_VBR_HPP_
@@ -26,7 +26,9 @@
 
 #include <hip/hip_runtime.h>
 
+#include "../vector_expression.hpp"
 #include "hip_atomics.hpp"
+#include "hip_utils.hpp"
 
 namespace rocalution
 {
@@ -62,6 +64,50 @@ namespace rocalution
         out[ind] = alpha * out[ind] + x[ind];
     }
 
+    // out = alpha * out + x, with alpha = scalars[num] / scalars[den] read from device memory
+    template <typename ValueType, typename IndexType>
+    __global__ void kernel_scaleadd_ratio(IndexType n,
+                                          const ValueType* __restrict__ scalars,
+                                          int64_t num,
+                                          int64_t den,
+                                          const ValueType* __restrict__ x,
+                                          ValueType* __restrict__ out)
+    {
+        IndexType ind = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+        if(ind >= n)
+        {
+            return;
+        }
+
+        ValueType alpha = scalars[num] / scalars[den];
+
+        out[ind] = alpha * out[ind] + x[ind];
+    }
+
+    // out = out + alpha * x, with alpha = factor * scalars[num] / scalars[den] read from
+    // device memory
+    template <typename ValueType, typename IndexType>
+    __global__ void kernel_axpy_ratio(IndexType n,
+                                      ValueType factor,
+                                      const ValueType* __restrict__ scalars,
+                                      int64_t num,
+                                      int64_t den,
+                                      const ValueType* __restrict__ x,
+                                      ValueType* __restrict__ out)
+    {
+        IndexType ind = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+        if(ind >= n)
+        {
+            return;
+        }
+
+        ValueType alpha = factor * scalars[num] / scalars[den];
+
+        out[ind] = out[ind] + alpha * x[ind];
+    }
+
     template <typename ValueType, typename IndexType>
     __global__ void kernel_scaleaddscale(IndexType n,
                                          ValueType alpha,
@@ -197,11 +243,11 @@ namespace rocalution
         out[ind] = in[permute[ind]];
     }
 
-    template <typename ValueType, typename IndexType>
+    template <typename ValueType, typename IndexType, typename OutType>
     __global__ void kernel_get_index_values(int64_t size,
                                             const IndexType* __restrict__ index,
                                             const ValueType* __restrict__ in,
-                                            ValueType* __restrict__ out)
+                                            OutType* __restrict__ out)
     {
         int64_t i = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
 
@@ -210,7 +256,7 @@ namespace rocalution
             return;
         }
 
-        out[i] = in[index[i]];
+        out[i] = static_cast<OutType>(in[index[i]]);
     }
 
     template <typename ValueType, typename IndexType>
@@ -271,6 +317,60 @@ namespace rocalution
         out[ind] = static_cast<ValueType>(in[ind]);
     }
 
+    // Scale the rows of a column-major block with nrow rows, out_ij = x_i * out_ij
+    template <typename ValueType>
+    __global__ void kernel_block_pointwise_mult(int64_t nrow,
+                                                int64_t size,
+                                                const ValueType* __restrict__ x,
+                                                ValueType* __restrict__ out)
+    {
+        int64_t ind = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+        if(ind >= size)
+        {
+            return;
+        }
+
+        out[ind] = x[ind % nrow] * out[ind];
+    }
+
+    // out = out + alpha * in, with single precision in
+    template <typename ValueType>
+    __global__ void kernel_axpy_from_float(int64_t   n,
+                                           ValueType alpha,
+                                           const float* __restrict__ in,
+                                           ValueType* __restrict__ out)
+    {
+        int64_t ind = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+        if(ind >= n)
+        {
+            return;
+        }
+
+        out[ind] += alpha * static_cast<ValueType>(in[ind]);
+    }
+
+    // vec = alpha * vec, rounded copy to out
+    template <typename ValueType>
+    __global__ void kernel_scale_copy_to_float(int64_t   n,
+                                               ValueType alpha,
+                                               ValueType* __restrict__ vec,
+                                               float* __restrict__ out)
+    {
+        int64_t ind = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+        if(ind >= n)
+        {
+            return;
+        }
+
+        ValueType val = alpha * vec[ind];
+
+        vec[ind] = val;
+        out[ind] = static_cast<float>(val);
+    }
+
     // Add index values from communication
     template <typename ValueType, typename IndexType>
     __global__ void kernel_add_index_values(int64_t size,
@@ -290,6 +390,372 @@ namespace rocalution
         atomicAdd(&out[index[i]], in[i]);
     }
 
+    // Sum of the fine entries of each aggregate, out has to be zero initialized
+    template <typename ValueType, typename IndexType>
+    __global__ void kernel_restriction(int64_t size,
+                                       const IndexType* __restrict__ map,
+                                       const ValueType* __restrict__ fine,
+                                       ValueType* __restrict__ coarse)
+    {
+        int64_t i = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(i >= size)
+        {
+            return;
+        }
+
+        IndexType agg = map[i];
+
+        // Fine entries without aggregate do not contribute
+        if(agg != -1)
+        {
+            atomicAdd(&coarse[agg], fine[i]);
+        }
+    }
+
+    // Piecewise constant interpolation of the aggregate values
+    template <typename ValueType, typename IndexType>
+    __global__ void kernel_prolongation(int64_t size,
+                                        const IndexType* __restrict__ map,
+                                        const ValueType* __restrict__ coarse,
+                                        ValueType* __restrict__ fine)
+    {
+        int64_t i = blockIdx.x * blockDim.x + threadIdx.x;
+
+        if(i >= size)
+        {
+            return;
+        }
+
+        IndexType agg = map[i];
+
+        fine[i] = (agg != -1) ? coarse[agg] : static_cast<ValueType>(0);
+    }
+
+    // Fused update out = out + alpha * x and block partial sums of out^H y, y may be out
+    template <unsigned int BLOCKSIZE, typename ValueType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_axpy_dot_blockreduce(int64_t   size,
+                                         ValueType alpha,
+                                         const ValueType* __restrict__ x,
+                                         const ValueType* y,
+                                         ValueType*       out,
+                                         ValueType* __restrict__ workspace)
+    {
+        unsigned int tid = hipThreadIdx_x;
+        int64_t      gid = hipBlockIdx_x * BLOCKSIZE + tid;
+
+        __shared__ ValueType sdata[BLOCKSIZE];
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(int64_t idx = gid; idx < size; idx += hipGridDim_x * BLOCKSIZE)
+        {
+            ValueType val = out[idx] + alpha * x[idx];
+
+            out[idx] = val;
+            sum += hip_conj(val) * y[idx];
+        }
+
+        sdata[tid] = sum;
+
+        __syncthreads();
+
+        block_reduce_sum<BLOCKSIZE>(tid, sdata);
+
+        if(tid == 0)
+        {
+            workspace[hipBlockIdx_x] = sdata[0];
+        }
+    }
+
+    // Block partial sums of vec^H x and vec^H y
+    template <unsigned int BLOCKSIZE, typename ValueType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_dualdot_blockreduce(int64_t size,
+                                        const ValueType* __restrict__ vec,
+                                        const ValueType* __restrict__ x,
+                                        const ValueType* __restrict__ y,
+                                        ValueType* __restrict__ workspace)
+    {
+        unsigned int tid = hipThreadIdx_x;
+        int64_t      gid = hipBlockIdx_x * BLOCKSIZE + tid;
+
+        __shared__ ValueType sdata_x[BLOCKSIZE];
+        __shared__ ValueType sdata_y[BLOCKSIZE];
+
+        ValueType sum_x = static_cast<ValueType>(0);
+        ValueType sum_y = static_cast<ValueType>(0);
+
+        for(int64_t idx = gid; idx < size; idx += hipGridDim_x * BLOCKSIZE)
+        {
+            ValueType val = hip_conj(vec[idx]);
+
+            sum_x += val * x[idx];
+            sum_y += val * y[idx];
+        }
+
+        sdata_x[tid] = sum_x;
+        sdata_y[tid] = sum_y;
+
+        __syncthreads();
+
+        block_reduce_sum<BLOCKSIZE>(tid, sdata_x);
+        block_reduce_sum<BLOCKSIZE>(tid, sdata_y);
+
+        if(tid == 0)
+        {
+            workspace[hipBlockIdx_x]             = sdata_x[0];
+            workspace[BLOCKSIZE + hipBlockIdx_x] = sdata_y[0];
+        }
+    }
+
+    // Operand arrays of a vector expression, passed to the kernels by value
+    template <typename ValueType>
+    struct vector_expression_operands
+    {
+        const ValueType* ptr[_vector_expression_max_vectors];
+    };
+
+    // Evaluate a vector expression program for element idx
+    template <typename ValueType>
+    static __device__ __forceinline__ ValueType
+        vector_expression_eval(const VectorExpressionProgram<ValueType>&     program,
+                               const vector_expression_operands<ValueType>& operands,
+                               int64_t                                      idx)
+    {
+        ValueType stack[_vector_expression_max_stack];
+
+        int top = -1;
+
+        for(int k = 0; k < program.num_ops; ++k)
+        {
+            switch(program.op[k])
+            {
+            case VExprVector:
+                stack[++top] = operands.ptr[program.arg[k]][idx];
+                break;
+            case VExprScalar:
+                stack[++top] = program.scalar[program.arg[k]];
+                break;
+            case VExprAdd:
+                --top;
+                stack[top] += stack[top + 1];
+                break;
+            case VExprSub:
+                --top;
+                stack[top] -= stack[top + 1];
+                break;
+            case VExprMul:
+                --top;
+                stack[top] *= stack[top + 1];
+                break;
+            case VExprDiv:
+                --top;
+                stack[top] /= stack[top + 1];
+                break;
+            case VExprNeg:
+                stack[top] = -stack[top];
+                break;
+            }
+        }
+
+        return stack[0];
+    }
+
+    // Fused element-wise evaluation out = program(operands), out may be an operand
+    template <typename ValueType>
+    __global__ void kernel_vector_expression(int64_t                                   size,
+                                             const VectorExpressionProgram<ValueType> program,
+                                             const vector_expression_operands<ValueType> operands,
+                                             ValueType* out)
+    {
+        int64_t gid = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+        for(int64_t idx = gid; idx < size; idx += hipGridDim_x * hipBlockDim_x)
+        {
+            out[idx] = vector_expression_eval(program, operands, idx);
+        }
+    }
+
+    // Block partial sums of program(operands)
+    template <unsigned int BLOCKSIZE, typename ValueType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_vector_expression_blockreduce(
+            int64_t                                     size,
+            const VectorExpressionProgram<ValueType>    program,
+            const vector_expression_operands<ValueType> operands,
+            ValueType* __restrict__ workspace)
+    {
+        unsigned int tid = hipThreadIdx_x;
+        int64_t      gid = hipBlockIdx_x * BLOCKSIZE + tid;
+
+        __shared__ ValueType sdata[BLOCKSIZE];
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(int64_t idx = gid; idx < size; idx += hipGridDim_x * BLOCKSIZE)
+        {
+            sum += vector_expression_eval(program, operands, idx);
+        }
+
+        sdata[tid] = sum;
+
+        __syncthreads();
+
+        block_reduce_sum<BLOCKSIZE>(tid, sdata);
+
+        if(tid == 0)
+        {
+            workspace[hipBlockIdx_x] = sdata[0];
+        }
+    }
+
+    // Scalars of a fused multi-vector update, passed to the kernels by value
+    template <typename ValueType>
+    struct multi_axpy_scalars
+    {
+        ValueType alpha[_vector_expression_max_vectors];
+    };
+
+    // Fused update out = out + sum_k alpha[k] * x[k] of up to
+    // _vector_expression_max_vectors vectors
+    template <typename ValueType>
+    __global__ void kernel_multi_axpy(int64_t                                     size,
+                                      int                                         count,
+                                      const vector_expression_operands<ValueType> x,
+                                      const multi_axpy_scalars<ValueType>         alpha,
+                                      ValueType* __restrict__ out)
+    {
+        int64_t gid = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+        for(int64_t idx = gid; idx < size; idx += hipGridDim_x * hipBlockDim_x)
+        {
+            ValueType val = out[idx];
+
+            for(int k = 0; k < count; ++k)
+            {
+                val += alpha.alpha[k] * x.ptr[k][idx];
+            }
+
+            out[idx] = val;
+        }
+    }
+
+    // Final reduction of count segments of BLOCKSIZE partial sums, the k-th sum is
+    // stored in workspace[k]
+    template <unsigned int BLOCKSIZE, typename ValueType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_dot_finalreduce(int count, ValueType* __restrict__ workspace)
+    {
+        unsigned int tid = hipThreadIdx_x;
+
+        __shared__ ValueType sdata[BLOCKSIZE];
+
+        for(int k = 0; k < count; ++k)
+        {
+            sdata[tid] = workspace[k * BLOCKSIZE + tid];
+
+            __syncthreads();
+
+            block_reduce_sum<BLOCKSIZE>(tid, sdata);
+
+            if(tid == 0)
+            {
+                workspace[k] = sdata[0];
+            }
+
+            __syncthreads();
+        }
+    }
+
+    // Block partial sums of vec^H x, or of vec^T x if CONJ is false. The entries of x
+    // may be stored in a lower precision, they are widened to ValueType.
+    template <unsigned int BLOCKSIZE, bool CONJ, typename ValueType, typename XType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_dot_blockreduce(int64_t size,
+                                    const ValueType* __restrict__ vec,
+                                    const XType* __restrict__ x,
+                                    ValueType* __restrict__ workspace)
+    {
+        unsigned int tid = hipThreadIdx_x;
+        int64_t      gid = hipBlockIdx_x * BLOCKSIZE + tid;
+
+        __shared__ ValueType sdata[BLOCKSIZE];
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(int64_t idx = gid; idx < size; idx += hipGridDim_x * BLOCKSIZE)
+        {
+            sum += (CONJ ? hip_conj(vec[idx]) : vec[idx]) * static_cast<ValueType>(x[idx]);
+        }
+
+        sdata[tid] = sum;
+
+        __syncthreads();
+
+        block_reduce_sum<BLOCKSIZE>(tid, sdata);
+
+        if(tid == 0)
+        {
+            workspace[hipBlockIdx_x] = sdata[0];
+        }
+    }
+
+    // Block partial sums of vec, or of hip_asum(vec) if ABS is true
+    template <unsigned int BLOCKSIZE, bool ABS, typename ValueType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_reduce_blockreduce(int64_t size,
+                                       const ValueType* __restrict__ vec,
+                                       ValueType* __restrict__ workspace)
+    {
+        unsigned int tid = hipThreadIdx_x;
+        int64_t      gid = hipBlockIdx_x * BLOCKSIZE + tid;
+
+        __shared__ ValueType sdata[BLOCKSIZE];
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(int64_t idx = gid; idx < size; idx += hipGridDim_x * BLOCKSIZE)
+        {
+            sum += ABS ? static_cast<ValueType>(hip_asum(vec[idx])) : vec[idx];
+        }
+
+        sdata[tid] = sum;
+
+        __syncthreads();
+
+        block_reduce_sum<BLOCKSIZE>(tid, sdata);
+
+        if(tid == 0)
+        {
+            workspace[hipBlockIdx_x] = sdata[0];
+        }
+    }
+
+    // Final reduction of BLOCKSIZE partial sums into the device scalar res, the square
+    // root of the (real) sum is stored if NORM is true
+    template <unsigned int BLOCKSIZE, bool NORM, typename ValueType>
+    __launch_bounds__(BLOCKSIZE) __global__
+        void kernel_dot_finalreduce_scalar(const ValueType* __restrict__ workspace,
+                                           ValueType* __restrict__ res)
+    {
+        unsigned int tid = hipThreadIdx_x;
+
+        __shared__ ValueType sdata[BLOCKSIZE];
+
+        sdata[tid] = workspace[tid];
+
+        __syncthreads();
+
+        block_reduce_sum<BLOCKSIZE>(tid, sdata);
+
+        if(tid == 0)
+        {
+            res[0] = NORM ? static_cast<ValueType>(sqrt(hip_real(sdata[0]))) : sdata[0];
+        }
+    }
+
     // Update and pack CF map for communication
     template <unsigned int BLOCKSIZE, typename IndexType>
     __launch_bounds__(BLOCKSIZE) __global__
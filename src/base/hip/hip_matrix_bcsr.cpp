@@ -31,6 +31,7 @@
 #include "../matrix_formats_ind.hpp"
 #include "hip_allocate_free.hpp"
 #include "hip_conversion.hpp"
+#include "hip_kernels_bcsr.hpp"
 #include "hip_matrix_csr.hpp"
 #include "hip_sparse.hpp"
 #include "hip_utils.hpp"
@@ -1618,6 +1619,89 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixBCSR<ValueType>::ExtractDiagonal(BaseVector<ValueType>* vec_diag) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(vec_diag != NULL);
+
+            HIPAcceleratorVector<ValueType>* cast_vec_diag
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(vec_diag);
+
+            assert(cast_vec_diag != NULL);
+            assert(cast_vec_diag->size_ == this->nrow_);
+
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize((this->mat_.nrowb - 1) / this->local_backend_.HIP_block_size + 1);
+
+            kernel_bcsr_extract_diag<<<GridSize,
+                                       BlockSize,
+                                       0,
+                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->mat_.nrowb,
+                this->mat_.blockdim,
+                this->mat_.row_offset,
+                this->mat_.col,
+                this->mat_.val,
+                cast_vec_diag->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixBCSR<ValueType>::ExtractInverseDiagonal(
+        BaseVector<ValueType>* vec_inv_diag) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(vec_inv_diag != NULL);
+
+            HIPAcceleratorVector<ValueType>* cast_vec_inv_diag
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(vec_inv_diag);
+
+            assert(cast_vec_inv_diag != NULL);
+            assert(cast_vec_inv_diag->size_ == this->nrow_);
+
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize((this->mat_.nrowb - 1) / this->local_backend_.HIP_block_size + 1);
+
+            int* d_detect_zero_diag = NULL;
+            allocate_hip(1, &d_detect_zero_diag);
+            set_to_zero_hip(1, 1, d_detect_zero_diag);
+
+            kernel_bcsr_extract_inv_diag<<<GridSize,
+                                           BlockSize,
+                                           0,
+                                           HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->mat_.nrowb,
+                this->mat_.blockdim,
+                this->mat_.row_offset,
+                this->mat_.col,
+                this->mat_.val,
+                cast_vec_inv_diag->vec_,
+                d_detect_zero_diag);
+
+            int detect_zero_diag = 0;
+            copy_d2h(1, d_detect_zero_diag, &detect_zero_diag);
+
+            if(detect_zero_diag == 1)
+            {
+                LOG_VERBOSE_INFO(
+                    2,
+                    "*** warning: in HIPAcceleratorMatrixBCSR::ExtractInverseDiagonal() a zero "
+                    "has been detected on the diagonal. It has been replaced with one to avoid "
+                    "inf");
+            }
+            free_hip(&d_detect_zero_diag);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
     template <typename ValueType>
     void HIPAcceleratorMatrixBCSR<ValueType>::Apply(const BaseVector<ValueType>& in,
                                                     BaseVector<ValueType>*       out) const
@@ -1710,6 +1794,97 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void HIPAcceleratorMatrixBCSR<ValueType>::SpMM_(int                                    ncol,
+                                                    ValueType                              alpha,
+                                                    const HIPAcceleratorVector<ValueType>& in,
+                                                    ValueType                              beta,
+                                                    HIPAcceleratorVector<ValueType>* out) const
+    {
+        // Determine whether we are using row or column major for the blocks
+        rocsparse_direction dir
+            = BCSR_IND_BASE ? rocsparse_direction_row : rocsparse_direction_column;
+
+        // The blocks are applied to all vectors at once, such that rocSPARSE can pick its
+        // dense block kernels for the block dimension and architecture
+        rocsparse_status status
+            = rocsparseTbsrmm(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                              dir,
+                              rocsparse_operation_none,
+                              rocsparse_operation_none,
+                              this->mat_.nrowb,
+                              ncol,
+                              this->mat_.ncolb,
+                              this->mat_.nnzb,
+                              &alpha,
+                              this->mat_descr_,
+                              this->mat_.val,
+                              this->mat_.row_offset,
+                              this->mat_.col,
+                              this->mat_.blockdim,
+                              in.vec_,
+                              this->ncol_,
+                              &beta,
+                              out->vec_,
+                              this->nrow_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixBCSR<ValueType>::ApplyMulti(int                          ncol,
+                                                         const BaseVector<ValueType>& in,
+                                                         BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0 && ncol > 0)
+        {
+            assert(out != NULL);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == static_cast<int64_t>(this->ncol_) * ncol);
+            assert(cast_out->size_ == static_cast<int64_t>(this->nrow_) * ncol);
+
+            this->SpMM_(ncol,
+                        static_cast<ValueType>(1),
+                        *cast_in,
+                        static_cast<ValueType>(0),
+                        cast_out);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixBCSR<ValueType>::ApplyAddMulti(int                          ncol,
+                                                            const BaseVector<ValueType>& in,
+                                                            ValueType                    scalar,
+                                                            BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0 && ncol > 0)
+        {
+            assert(out != NULL);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == static_cast<int64_t>(this->ncol_) * ncol);
+            assert(cast_out->size_ == static_cast<int64_t>(this->nrow_) * ncol);
+
+            this->SpMM_(ncol, scalar, *cast_in, static_cast<ValueType>(1), cast_out);
+        }
+
+        return true;
+    }
+
     template class HIPAcceleratorMatrixBCSR<double>;
     template class HIPAcceleratorMatrixBCSR<float>;
 #ifdef SUPPORT_COMPLEX
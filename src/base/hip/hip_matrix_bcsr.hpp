@@ -97,12 +97,28 @@ namespace rocalution
         virtual void UAnalyseClear(void);
         virtual bool USolve(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
 
+        virtual bool ExtractDiagonal(BaseVector<ValueType>* vec_diag) const;
+        virtual bool ExtractInverseDiagonal(BaseVector<ValueType>* vec_inv_diag) const;
+
         virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
         virtual void ApplyAdd(const BaseVector<ValueType>& in,
                               ValueType                    scalar,
                               BaseVector<ValueType>*       out) const;
+        virtual bool
+            ApplyMulti(int ncol, const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+        virtual bool ApplyAddMulti(int                          ncol,
+                                   const BaseVector<ValueType>& in,
+                                   ValueType                    scalar,
+                                   BaseVector<ValueType>*       out) const;
 
     private:
+        // out = alpha * this * in + beta * out for a column-major block of ncol vectors
+        void SpMM_(int                                    ncol,
+                   ValueType                              alpha,
+                   const HIPAcceleratorVector<ValueType>& in,
+                   ValueType                              beta,
+                   HIPAcceleratorVector<ValueType>*       out) const;
+
         MatrixBCSR<ValueType, int> mat_;
 
         rocsparse_mat_descr L_mat_descr_;
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -486,6 +486,16 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCOO<ValueType>::Prefetch(void) const
+    {
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
+
+        prefetch_hip(this->nnz_, this->mat_.row, stream);
+        prefetch_hip(this->nnz_, this->mat_.col, stream);
+        prefetch_hip(this->nnz_, this->mat_.val, stream);
+    }
+
     template <typename ValueType>
     void HIPAcceleratorMatrixCOO<ValueType>::CopyToAsync(BaseMatrix<ValueType>* dst) const
     {
@@ -786,11 +796,65 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCOO<ValueType>::ExtractRowL1Norm(BaseVector<ValueType>* vec_l1) const
+    {
+        assert(vec_l1 != NULL);
+
+        HIPAcceleratorVector<ValueType>* cast_vec_l1
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(vec_l1);
+
+        assert(cast_vec_l1 != NULL);
+        assert(cast_vec_l1->size_ == this->nrow_);
+
+        set_to_zero_hip(this->local_backend_.HIP_block_size, this->nrow_, cast_vec_l1->vec_);
+
+        if(this->nnz_ > 0)
+        {
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->nnz_ / this->local_backend_.HIP_block_size + 1);
+
+            kernel_coo_row_l1_norm<<<GridSize,
+                                     BlockSize,
+                                     0,
+                                     HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nnz_, this->mat_.row, this->mat_.val, cast_vec_l1->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
     template <typename ValueType>
     bool HIPAcceleratorMatrixCOO<ValueType>::Sort(void)
     {
         if(this->nnz_ > 0)
         {
+            int         blocksize = this->local_backend_.HIP_block_size;
+            hipStream_t stream    = HIPSTREAM(this->local_backend_.HIP_stream_current);
+
+            // Nothing to do if the entries are already sorted by row and column
+            int  h_order[2];
+            int* d_order = NULL;
+
+            allocate_hip(2, &d_order);
+            set_to_zero_hip(blocksize, 2, d_order);
+
+            kernel_coo_detect_order<<<(this->nnz_ - 1) / blocksize + 1, blocksize, 0, stream>>>(
+                this->nnz_, this->mat_.row, this->mat_.col, d_order);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            copy_d2h(2, d_order, h_order, true, stream);
+            hipStreamSynchronize(stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&d_order);
+
+            if(h_order[0] == 0 && h_order[1] == 0)
+            {
+                return true;
+            }
+
             rocsparse_status status;
 
             size_t buffer_size = 0;
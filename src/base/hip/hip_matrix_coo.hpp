@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -63,6 +63,7 @@ namespace rocalution
         virtual void CopyFromAsync(const BaseMatrix<ValueType>& src);
         virtual void CopyTo(BaseMatrix<ValueType>* dst) const;
         virtual void CopyToAsync(BaseMatrix<ValueType>* dst) const;
+        virtual void Prefetch(void) const;
 
         virtual void CopyFromHost(const HostMatrix<ValueType>& src);
         virtual void CopyFromHostAsync(const HostMatrix<ValueType>& src);
@@ -76,6 +77,9 @@ namespace rocalution
         virtual void ApplyAdd(const BaseVector<ValueType>& in,
                               ValueType                    scalar,
                               BaseVector<ValueType>*       out) const;
+
+        virtual bool ExtractRowL1Norm(BaseVector<ValueType>* vec_l1) const;
+
         virtual bool Sort(void);
 
     private:
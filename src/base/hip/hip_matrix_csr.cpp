@@ -29,6 +29,8 @@
 #include "hip_matrix_ell.hpp"
 #include "hip_matrix_hyb.hpp"
 #include "hip_matrix_mcsr.hpp"
+#include "hip_matrix_sell.hpp"
+#include "hip_matrix_vbr.hpp"
 
 #include "hip_matrix_bcsr.hpp"
 #include "hip_matrix_dense.hpp"
@@ -36,7 +38,9 @@
 
 #include "hip_conversion.hpp"
 
+#include "../host/host_io.hpp"
 #include "../host/host_matrix_csr.hpp"
+#include "../host/host_matrix_vbr.hpp"
 
 #include "../base_matrix.hpp"
 #include "../base_vector.hpp"
@@ -50,6 +54,7 @@
 
 #include "hip_kernels_general.hpp"
 
+#include "hip_kernels_batch.hpp"
 #include "hip_kernels_csr.hpp"
 #include "hip_kernels_vector.hpp"
 
@@ -62,6 +67,7 @@
 
 #include "../../solvers/preconditioners/preconditioner.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -92,6 +98,9 @@ namespace rocalution
         this->mat_.val        = NULL;
         this->set_backend(local_backend);
 
+        this->structure_ref_ = NULL;
+        this->view_          = false;
+
         this->L_mat_descr_ = 0;
         this->U_mat_descr_ = 0;
 
@@ -102,6 +111,39 @@ namespace rocalution
         this->mat_buffer_size_ = 0;
         this->mat_buffer_      = NULL;
 
+        this->spmv_alg_     = SpMVAlg_Auto;
+        this->spmv_alg_sel_ = SpMVAlg_Adaptive;
+
+        this->spmv_descr_       = NULL;
+        this->spmv_buffer_size_ = 0;
+        this->spmv_buffer_      = NULL;
+
+        this->spmv_storage_ = SpMVStorage_Full;
+        this->spmv_val_     = NULL;
+
+        this->spmv_index_     = SpMVIndex_Full;
+        this->spmv_col_base_  = NULL;
+        this->spmv_col_off_   = NULL;
+        this->spmv_col_width_ = 0;
+
+        this->spmv_row_offset_ = NULL;
+
+        this->spmv_rows_  = NULL;
+        this->spmv_nrows_ = 0;
+
+        this->ooc_chunk_nnz_ = 0;
+
+        for(int k = 0; k < 2; ++k)
+        {
+            this->ooc_col_[k]    = NULL;
+            this->ooc_val_[k]    = NULL;
+            this->ooc_stream_[k] = NULL;
+            this->ooc_event_[k]  = NULL;
+        }
+
+        this->itsv_buffer_ = NULL;
+        this->itsv_delta_  = NULL;
+
         this->tmp_vec_ = NULL;
 
         CHECK_HIP_ERROR(__FILE__, __LINE__);
@@ -130,6 +172,7 @@ namespace rocalution
         log_debug(this, "HIPAcceleratorMatrixCSR::~HIPAcceleratorMatrixCSR()", "destructor");
 
         this->Clear();
+        this->SetOutOfCore(0);
 
         rocsparse_status status;
 
@@ -149,6 +192,20 @@ namespace rocalution
         LOG_INFO("HIPAcceleratorMatrixCSR<ValueType>");
     }
 
+    // Column indices and values are kept in host memory in out-of-core mode
+    template <typename DataType>
+    static void allocate_csr_entries(bool out_of_core, int64_t n, DataType** ptr)
+    {
+        if(out_of_core == true)
+        {
+            allocate_hip_host_resident(n, ptr);
+        }
+        else
+        {
+            allocate_hip(n, ptr);
+        }
+    }
+
     template <typename ValueType>
     void HIPAcceleratorMatrixCSR<ValueType>::AllocateCSR(int64_t nnz, int nrow, int ncol)
     {
@@ -161,8 +218,8 @@ namespace rocalution
         allocate_hip(nrow + 1, &this->mat_.row_offset);
         set_to_zero_hip(this->local_backend_.HIP_block_size, nrow + 1, mat_.row_offset);
 
-        allocate_hip(nnz, &this->mat_.col);
-        allocate_hip(nnz, &this->mat_.val);
+        allocate_csr_entries(this->ooc_chunk_nnz_ > 0, nnz, &this->mat_.col);
+        allocate_csr_entries(this->ooc_chunk_nnz_ > 0, nnz, &this->mat_.val);
 
         set_to_zero_hip(this->local_backend_.HIP_block_size, nnz, mat_.col);
         set_to_zero_hip(this->local_backend_.HIP_block_size, nnz, mat_.val);
@@ -202,11 +259,48 @@ namespace rocalution
         this->ApplyAnalysis();
     }
 
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::AttachViewCSR(
+        PtrType* row_offset, int* col, ValueType* val, int64_t nnz, int nrow, int ncol)
+    {
+        assert(nnz >= 0);
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+        assert(row_offset != NULL);
+
+        if(nnz > 0)
+        {
+            assert(col != NULL);
+            assert(val != NULL);
+        }
+
+        this->Clear();
+
+        hipDeviceSynchronize();
+
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+        this->nnz_  = nnz;
+
+        this->mat_.row_offset = row_offset;
+        this->mat_.col        = col;
+        this->mat_.val        = val;
+
+        this->view_ = true;
+
+        this->ApplyAnalysis();
+    }
+
     template <typename ValueType>
     void HIPAcceleratorMatrixCSR<ValueType>::LeaveDataPtrCSR(PtrType**   row_offset,
                                                              int**       col,
                                                              ValueType** val)
     {
+        free_hip(&this->spmv_val_);
+        this->InvalidateSpMVStructure_();
+
+        this->DetachStructure_();
+
         assert(this->nrow_ >= 0);
         assert(this->ncol_ >= 0);
         assert(this->nnz_ >= 0);
@@ -230,6 +324,18 @@ namespace rocalution
     template <typename ValueType>
     void HIPAcceleratorMatrixCSR<ValueType>::Clear(void)
     {
+        this->ReleaseStructure_();
+
+        if(this->view_ == true)
+        {
+            // External buffers are left to their owner
+            this->mat_.row_offset = NULL;
+            this->mat_.col        = NULL;
+            this->mat_.val        = NULL;
+
+            this->view_ = false;
+        }
+
         free_hip(&this->mat_.row_offset);
         free_hip(&this->mat_.col);
         free_hip(&this->mat_.val);
@@ -247,11 +353,106 @@ namespace rocalution
         this->ItUAnalyseClear();
         this->ItLUAnalyseClear();
         this->ItLLAnalyseClear();
+
+        this->SpMVClear_();
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ReleaseStructure_(void)
+    {
+        if(this->structure_ref_ == NULL)
+        {
+            return;
+        }
+
+        if(--(*this->structure_ref_) > 0)
+        {
+            // The pattern is still used by another matrix
+            this->mat_.row_offset = NULL;
+            this->mat_.col        = NULL;
+        }
+        else
+        {
+            free_host(&this->structure_ref_);
+        }
+
+        this->structure_ref_ = NULL;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::DetachStructure_(void)
+    {
+        this->DetachView_();
+
+        if(this->structure_ref_ == NULL)
+        {
+            return;
+        }
+
+        if(*this->structure_ref_ > 1)
+        {
+            PtrType* row_offset = NULL;
+            int*     col        = NULL;
+
+            allocate_hip(this->nrow_ + 1, &row_offset);
+            allocate_csr_entries(this->ooc_chunk_nnz_ > 0, this->nnz_, &col);
+
+            copy_d2d(this->nrow_ + 1, this->mat_.row_offset, row_offset);
+            copy_d2d(this->nnz_, this->mat_.col, col);
+
+            this->ReleaseStructure_();
+
+            this->mat_.row_offset = row_offset;
+            this->mat_.col        = col;
+
+            // The generic SpMV descriptor points to the previous arrays
+            this->SpMVClear_();
+        }
+        else
+        {
+            this->ReleaseStructure_();
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::DetachView_(void)
+    {
+        if(this->view_ == false)
+        {
+            return;
+        }
+
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
+
+        allocate_hip(this->nrow_ + 1, &row_offset);
+        copy_d2d(this->nrow_ + 1, this->mat_.row_offset, row_offset);
+
+        if(this->nnz_ > 0)
+        {
+            allocate_csr_entries(this->ooc_chunk_nnz_ > 0, this->nnz_, &col);
+            allocate_csr_entries(this->ooc_chunk_nnz_ > 0, this->nnz_, &val);
+
+            copy_d2d(this->nnz_, this->mat_.col, col);
+            copy_d2d(this->nnz_, this->mat_.val, val);
+        }
+
+        this->mat_.row_offset = row_offset;
+        this->mat_.col        = col;
+        this->mat_.val        = val;
+
+        this->view_ = false;
+
+        // The generic SpMV descriptor points to the external buffers
+        this->SpMVClear_();
     }
 
     template <typename ValueType>
     bool HIPAcceleratorMatrixCSR<ValueType>::Zeros()
     {
+        free_hip(&this->spmv_val_);
+
         if(this->nnz_ > 0)
         {
             set_to_zero_hip(this->local_backend_.HIP_block_size, this->nnz_, mat_.val);
@@ -260,6 +461,101 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::UpdateValues(const BaseVector<ValueType>& val,
+                                                          const BaseVector<int>*       perm,
+                                                          int64_t                      offset)
+    {
+        const HIPAcceleratorVector<ValueType>* cast_val
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&val);
+
+        assert(cast_val != NULL);
+        assert(offset >= 0);
+
+        // Values of the SpMV storage have to be regenerated
+        free_hip(&this->spmv_val_);
+
+        if(this->nnz_ == 0)
+        {
+            return true;
+        }
+
+        if(perm == NULL)
+        {
+            assert(cast_val->size_ >= offset + this->nnz_);
+
+            copy_d2d(this->nnz_,
+                     cast_val->vec_ + offset,
+                     this->mat_.val,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+
+            return true;
+        }
+
+        const HIPAcceleratorVector<int>* cast_perm
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(perm);
+
+        assert(cast_perm != NULL);
+        assert(cast_perm->size_ == cast_val->size_);
+
+        int64_t size = cast_perm->size_;
+
+        if(size > 0)
+        {
+            dim3 BlockSize(256);
+            dim3 GridSize((size - 1) / 256 + 1);
+
+            kernel_csr_update_values_perm<<<GridSize,
+                                            BlockSize,
+                                            0,
+                                            HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                size, offset, this->nnz_, cast_perm->vec_, cast_val->vec_, this->mat_.val);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::AssembleValues(const BaseVector<ValueType>& val,
+                                                            const BaseVector<int>&       offset,
+                                                            const BaseVector<int>&       perm)
+    {
+        const HIPAcceleratorVector<ValueType>* cast_val
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&val);
+        const HIPAcceleratorVector<int>* cast_off
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(&offset);
+        const HIPAcceleratorVector<int>* cast_perm
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(&perm);
+
+        assert(cast_val != NULL);
+        assert(cast_off != NULL);
+        assert(cast_perm != NULL);
+        assert(cast_off->size_ == this->nnz_ + 1);
+        assert(cast_perm->size_ == cast_val->size_);
+
+        // Values of the SpMV storage have to be regenerated
+        free_hip(&this->spmv_val_);
+
+        if(this->nnz_ > 0)
+        {
+            // One thread per CSR entry, the contributions of each entry are contiguous in
+            // perm, such that no atomics are required
+            dim3 BlockSize(256);
+            dim3 GridSize((this->nnz_ - 1) / 256 + 1);
+
+            kernel_csr_assemble_values<<<GridSize,
+                                         BlockSize,
+                                         0,
+                                         HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nnz_, cast_off->vec_, cast_perm->vec_, cast_val->vec_, this->mat_.val);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
     template <typename ValueType>
     void HIPAcceleratorMatrixCSR<ValueType>::CopyFromHost(const HostMatrix<ValueType>& src)
     {
@@ -280,6 +576,8 @@ namespace rocalution
             assert(this->nrow_ == cast_mat->nrow_);
             assert(this->ncol_ == cast_mat->ncol_);
 
+            this->DetachStructure_();
+
             if(cast_mat->mat_.row_offset != NULL)
             {
                 copy_h2d(this->nrow_ + 1, cast_mat->mat_.row_offset, this->mat_.row_offset);
@@ -319,6 +617,8 @@ namespace rocalution
             assert(this->nrow_ == cast_mat->nrow_);
             assert(this->ncol_ == cast_mat->ncol_);
 
+            this->DetachStructure_();
+
             if(cast_mat->mat_.row_offset != NULL)
             {
                 copy_h2d(this->nrow_ + 1,
@@ -368,6 +668,8 @@ namespace rocalution
                 cast_mat->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
             }
 
+            cast_mat->DetachStructure_();
+
             assert(this->nnz_ == cast_mat->nnz_);
             assert(this->nrow_ == cast_mat->nrow_);
             assert(this->ncol_ == cast_mat->ncol_);
@@ -407,6 +709,8 @@ namespace rocalution
                 cast_mat->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
             }
 
+            cast_mat->DetachStructure_();
+
             assert(this->nnz_ == cast_mat->nnz_);
             assert(this->ncol_ == cast_mat->ncol_);
 
@@ -460,12 +764,21 @@ namespace rocalution
             assert(this->nrow_ == hip_cast_mat->nrow_);
             assert(this->ncol_ == hip_cast_mat->ncol_);
 
-            if(hip_cast_mat->mat_.row_offset)
+            // Matrices sharing the pattern only copy the values
+            if(this->mat_.col != hip_cast_mat->mat_.col
+               || this->mat_.row_offset != hip_cast_mat->mat_.row_offset)
             {
-                copy_d2d(this->nrow_ + 1, hip_cast_mat->mat_.row_offset, this->mat_.row_offset);
+                this->DetachStructure_();
+
+                if(hip_cast_mat->mat_.row_offset)
+                {
+                    copy_d2d(
+                        this->nrow_ + 1, hip_cast_mat->mat_.row_offset, this->mat_.row_offset);
+                }
+
+                copy_d2d(this->nnz_, hip_cast_mat->mat_.col, this->mat_.col);
             }
 
-            copy_d2d(this->nnz_, hip_cast_mat->mat_.col, this->mat_.col);
             copy_d2d(this->nnz_, hip_cast_mat->mat_.val, this->mat_.val);
         }
         else
@@ -508,20 +821,28 @@ namespace rocalution
             assert(this->nrow_ == hip_cast_mat->nrow_);
             assert(this->ncol_ == hip_cast_mat->ncol_);
 
-            if(hip_cast_mat->mat_.row_offset != NULL)
+            // Matrices sharing the pattern only copy the values
+            if(this->mat_.col != hip_cast_mat->mat_.col
+               || this->mat_.row_offset != hip_cast_mat->mat_.row_offset)
             {
-                copy_d2d(this->nrow_ + 1,
-                         hip_cast_mat->mat_.row_offset,
-                         this->mat_.row_offset,
+                this->DetachStructure_();
+
+                if(hip_cast_mat->mat_.row_offset != NULL)
+                {
+                    copy_d2d(this->nrow_ + 1,
+                             hip_cast_mat->mat_.row_offset,
+                             this->mat_.row_offset,
+                             true,
+                             HIPSTREAM(this->local_backend_.HIP_stream_current));
+                }
+
+                copy_d2d(this->nnz_,
+                         hip_cast_mat->mat_.col,
+                         this->mat_.col,
                          true,
                          HIPSTREAM(this->local_backend_.HIP_stream_current));
             }
 
-            copy_d2d(this->nnz_,
-                     hip_cast_mat->mat_.col,
-                     this->mat_.col,
-                     true,
-                     HIPSTREAM(this->local_backend_.HIP_stream_current));
             copy_d2d(this->nnz_,
                      hip_cast_mat->mat_.val,
                      this->mat_.val,
@@ -547,6 +868,51 @@ namespace rocalution
         this->ApplyAnalysis();
     }
 
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ShareStructureFrom(const BaseMatrix<ValueType>& src)
+    {
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&src);
+
+        // External buffers may go away with their owner, views are copied instead
+        if(cast_mat == NULL || cast_mat->view_ == true)
+        {
+            return false;
+        }
+
+        assert(cast_mat != this);
+
+        this->Clear();
+
+        if(cast_mat->mat_.row_offset == NULL)
+        {
+            return true;
+        }
+
+        if(cast_mat->structure_ref_ == NULL)
+        {
+            allocate_host(1, &cast_mat->structure_ref_);
+            *cast_mat->structure_ref_ = 1;
+        }
+
+        ++(*cast_mat->structure_ref_);
+
+        this->structure_ref_  = cast_mat->structure_ref_;
+        this->mat_.row_offset = cast_mat->mat_.row_offset;
+        this->mat_.col        = cast_mat->mat_.col;
+
+        this->nrow_ = cast_mat->nrow_;
+        this->ncol_ = cast_mat->ncol_;
+        this->nnz_  = cast_mat->nnz_;
+
+        allocate_hip(this->nnz_, &this->mat_.val);
+        copy_d2d(this->nnz_, cast_mat->mat_.val, this->mat_.val);
+
+        this->ApplyAnalysis();
+
+        return true;
+    }
+
     template <typename ValueType>
     void HIPAcceleratorMatrixCSR<ValueType>::CopyTo(BaseMatrix<ValueType>* dst) const
     {
@@ -595,6 +961,20 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::Prefetch(void) const
+    {
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
+
+        if(this->mat_.row_offset != NULL)
+        {
+            prefetch_hip(this->nrow_ + 1, this->mat_.row_offset, stream);
+        }
+
+        prefetch_hip(this->nnz_, this->mat_.col, stream);
+        prefetch_hip(this->nnz_, this->mat_.val, stream);
+    }
+
     template <typename ValueType>
     void HIPAcceleratorMatrixCSR<ValueType>::CopyToAsync(BaseMatrix<ValueType>* dst) const
     {
@@ -660,6 +1040,8 @@ namespace rocalution
                                                          const int*       col,
                                                          const ValueType* val)
     {
+        this->DetachStructure_();
+
         copy_d2d(this->nrow_ + 1, row_offsets, this->mat_.row_offset);
 
         if(this->nnz_ > 0)
@@ -762,6 +1144,50 @@ namespace rocalution
             }
         }
 
+        const HIPAcceleratorMatrixSELL<ValueType>* cast_mat_sell;
+        if((cast_mat_sell = dynamic_cast<const HIPAcceleratorMatrixSELL<ValueType>*>(&mat))
+           != NULL)
+        {
+            this->Clear();
+            int64_t nnz;
+
+            if(sell_to_csr_hip(&this->local_backend_,
+                               cast_mat_sell->nnz_,
+                               cast_mat_sell->nrow_,
+                               cast_mat_sell->ncol_,
+                               cast_mat_sell->mat_,
+                               &this->mat_,
+                               &nnz)
+               == true)
+            {
+                this->nrow_ = cast_mat_sell->nrow_;
+                this->ncol_ = cast_mat_sell->ncol_;
+                this->nnz_  = nnz;
+
+                this->ApplyAnalysis();
+
+                return true;
+            }
+        }
+
+        const HIPAcceleratorMatrixVBR<ValueType>* cast_mat_vbr;
+        if((cast_mat_vbr = dynamic_cast<const HIPAcceleratorMatrixVBR<ValueType>*>(&mat)) != NULL)
+        {
+            // Staged through the host, see HIPAcceleratorMatrixVBR::ConvertFrom()
+            HostMatrixVBR<ValueType> host_vbr(this->local_backend_);
+            HostMatrixCSR<ValueType> host_csr(this->local_backend_);
+
+            cast_mat_vbr->CopyToHost(&host_vbr);
+
+            if(host_csr.ConvertFrom(host_vbr) == true)
+            {
+                this->Clear();
+                this->CopyFromHost(host_csr);
+
+                return true;
+            }
+        }
+
         const HIPAcceleratorMatrixDENSE<ValueType>* cast_mat_dense;
         if((cast_mat_dense = dynamic_cast<const HIPAcceleratorMatrixDENSE<ValueType>*>(&mat))
            != NULL)
@@ -897,28 +1323,323 @@ namespace rocalution
         this->ApplyAnalysis();
     }
 
+    // Receiver of read_matrix_csr_blocks(), that streams the blocks through two page-locked
+    // staging buffers into device memory. While one block is transferred asynchronously,
+    // the next block is read from the file into the other staging buffer.
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::Sort(void)
+    class HIPCSRBlockReceiver : public CSRBlockReceiver<ValueType, int, PtrType>
     {
-        if(this->nnz_ > 0)
+    public:
+        explicit HIPCSRBlockReceiver(hipStream_t stream)
         {
-            rocsparse_status status;
+            this->stream_ = stream;
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+            this->nrow = 0;
+            this->ncol = 0;
+            this->nnz  = 0;
 
-            size_t buffer_size = 0;
-            status             = rocsparse_csrsort_buffer_size(
-                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                this->nrow_,
-                this->ncol_,
-                this->nnz_,
-                this->mat_.row_offset,
-                this->mat_.col,
-                &buffer_size);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            this->ptr = NULL;
+            this->col = NULL;
+            this->val = NULL;
 
-            char* buffer = nullptr;
-            allocate_hip(buffer_size, &buffer);
+            for(int k = 0; k < 2; ++k)
+            {
+                this->staging_[k] = NULL;
+                allocate_pinned(csr_block_size / static_cast<int64_t>(sizeof(double)),
+                                &this->staging_[k]);
+
+                hipEventCreateWithFlags(&this->event_[k], hipEventDisableTiming);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+            }
+
+            this->current_ = 0;
+            this->dst_     = NULL;
+            this->bytes_   = 0;
+        }
+
+        virtual ~HIPCSRBlockReceiver()
+        {
+            // Wait for all pending transfers before the staging buffers are released
+            hipStreamSynchronize(this->stream_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            for(int k = 0; k < 2; ++k)
+            {
+                hipEventDestroy(this->event_[k]);
+                free_pinned(&this->staging_[k]);
+            }
+
+            free_hip(&this->ptr);
+            free_hip(&this->col);
+            free_hip(&this->val);
+        }
+
+        virtual bool Allocate(int64_t nrow, int64_t ncol, int64_t nnz)
+        {
+            // Number of rows and columns are expected to be within 32 bits locally
+            if(nrow > std::numeric_limits<int>::max() || ncol > std::numeric_limits<int>::max())
+            {
+                return false;
+            }
+
+            this->nrow = static_cast<int>(nrow);
+            this->ncol = static_cast<int>(ncol);
+            this->nnz  = nnz;
+
+            allocate_hip(nrow + 1, &this->ptr);
+            allocate_hip(nnz, &this->col);
+            allocate_hip(nnz, &this->val);
+
+            return true;
+        }
+
+        virtual PtrType* RowOffsetBlock(int64_t offset, int64_t n)
+        {
+            return static_cast<PtrType*>(this->Stage_(this->ptr + offset, sizeof(PtrType) * n));
+        }
+
+        virtual int* ColumnBlock(int64_t offset, int64_t n)
+        {
+            return static_cast<int*>(this->Stage_(this->col + offset, sizeof(int) * n));
+        }
+
+        virtual ValueType* ValueBlock(int64_t offset, int64_t n)
+        {
+            return static_cast<ValueType*>(this->Stage_(this->val + offset, sizeof(ValueType) * n));
+        }
+
+        virtual void Commit(void)
+        {
+            hipMemcpyAsync(this->dst_,
+                           this->staging_[this->current_],
+                           this->bytes_,
+                           hipMemcpyHostToDevice,
+                           this->stream_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            hipEventRecord(this->event_[this->current_], this->stream_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        // Wait until all blocks have arrived in device memory
+        void Synchronize(void)
+        {
+            hipStreamSynchronize(this->stream_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        int     nrow;
+        int     ncol;
+        int64_t nnz;
+
+        PtrType*   ptr;
+        int*       col;
+        ValueType* val;
+
+    private:
+        void* Stage_(void* dst, size_t bytes)
+        {
+            assert(bytes <= static_cast<size_t>(csr_block_size));
+
+            // Switch buffers and wait, until the last transfer out of this buffer has finished
+            this->current_ = 1 - this->current_;
+
+            hipEventSynchronize(this->event_[this->current_]);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            this->dst_   = dst;
+            this->bytes_ = bytes;
+
+            return this->staging_[this->current_];
+        }
+
+        hipStream_t stream_;
+
+        double*    staging_[2];
+        hipEvent_t event_[2];
+        int        current_;
+
+        void*  dst_;
+        size_t bytes_;
+    };
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ReadFileCSR(const std::string& filename)
+    {
+        HIPCSRBlockReceiver<ValueType> recv(HIPSTREAM(this->local_backend_.HIP_stream_current));
+
+        if(read_matrix_csr_blocks(recv, filename.c_str()) != true)
+        {
+            return false;
+        }
+
+        recv.Synchronize();
+
+        this->Clear();
+        this->SetDataPtrCSR(&recv.ptr, &recv.col, &recv.val, recv.nnz, recv.nrow, recv.ncol);
+
+        // The matrix owns the arrays now
+        recv.ptr = NULL;
+        recv.col = NULL;
+        recv.val = NULL;
+
+        return true;
+    }
+
+    // Exclusive sum of the row nnz stored in csr_row_ptr, returns the total nnz
+    static PtrType csr_row_ptr_scan(int nrow, PtrType* csr_row_ptr, hipStream_t stream)
+    {
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(NULL,
+                                rocprim_size,
+                                csr_row_ptr,
+                                csr_row_ptr,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                csr_row_ptr,
+                                csr_row_ptr,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+
+        PtrType nnz;
+        copy_d2h(1, csr_row_ptr + nrow, &nnz);
+
+        return nnz;
+    }
+
+    // Prolongation with a single entry of one in each fine row i that is mapped to a
+    // coarse column map[i] >= 0
+    template <typename ValueType>
+    static PtrType csr_prolong_from_map(int         n,
+                                        const int*  map,
+                                        hipStream_t stream,
+                                        PtrType**   csr_row_ptr,
+                                        int**       csr_col_ind,
+                                        ValueType** csr_val)
+    {
+        allocate_hip(n + 1, csr_row_ptr);
+
+        if(n > 0)
+        {
+            kernel_csr_map_prolong_nnz<<<(n - 1) / 256 + 1, 256, 0, stream>>>(
+                n, map, *csr_row_ptr);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        PtrType nnz = csr_row_ptr_scan(n, *csr_row_ptr, stream);
+
+        allocate_hip(nnz, csr_col_ind);
+        allocate_hip(nnz, csr_val);
+
+        if(nnz > 0)
+        {
+            kernel_csr_map_prolong_fill<<<(n - 1) / 256 + 1, 256, 0, stream>>>(
+                n, map, *csr_row_ptr, *csr_col_ind, *csr_val);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return nnz;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map, int n, int m)
+    {
+        assert(map.GetSize() == n);
+
+        HIPAcceleratorMatrixCSR<ValueType> pro(this->local_backend_);
+
+        return this->CreateFromMap(map, n, m, &pro);
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map,
+                                                           int                    n,
+                                                           int                    m,
+                                                           BaseMatrix<ValueType>* pro)
+    {
+        assert(map.GetSize() == n);
+        assert(pro != NULL);
+
+        const HIPAcceleratorVector<int>* cast_map
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(&map);
+        HIPAcceleratorMatrixCSR<ValueType>* cast_pro
+            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(pro);
+
+        assert(cast_map != NULL);
+        assert(cast_pro != NULL);
+
+        PtrType*   csr_row_ptr = NULL;
+        int*       csr_col_ind = NULL;
+        ValueType* csr_val     = NULL;
+
+        PtrType nnz = csr_prolong_from_map(n,
+                                           cast_map->vec_,
+                                           HIPSTREAM(this->local_backend_.HIP_stream_current),
+                                           &csr_row_ptr,
+                                           &csr_col_ind,
+                                           &csr_val);
+
+        // Build prolongation operator
+        cast_pro->Clear();
+        cast_pro->SetDataPtrCSR(&csr_row_ptr, &csr_col_ind, &csr_val, nnz, n, m);
+
+        // Build restriction operator, its rows are sorted by the transposition
+        this->Clear();
+
+        if(nnz > 0)
+        {
+            cast_pro->Transpose(this);
+        }
+        else
+        {
+            this->AllocateCSR(0, m, n);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::Sort(void)
+    {
+        free_hip(&this->spmv_val_);
+        this->InvalidateSpMVStructure_();
+
+        if(this->nnz_ > 0)
+        {
+            this->DetachStructure_();
+
+            rocsparse_status status;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            size_t buffer_size = 0;
+            status             = rocsparse_csrsort_buffer_size(
+                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                this->nrow_,
+                this->ncol_,
+                this->nnz_,
+                this->mat_.row_offset,
+                this->mat_.col,
+                &buffer_size);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            char* buffer = nullptr;
+            allocate_hip(buffer_size, &buffer);
 
             int* perm = nullptr;
             allocate_hip(this->nnz_, &perm);
@@ -970,6 +1691,8 @@ namespace rocalution
             assert(cast_perm->size_ == this->nrow_);
             assert(cast_perm->size_ == this->ncol_);
 
+            this->DetachStructure_();
+
             PtrType*   d_nnzPerm = NULL;
             int*       d_offset  = NULL;
             ValueType* d_data    = NULL;
@@ -1191,1067 +1914,1390 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::ApplyAnalysis(void) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::PermuteBackward(const BaseVector<int>& permutation)
     {
         if(this->nnz_ > 0)
         {
-            rocsparse_status status;
-            status
-                = rocsparseTcsrmv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                           rocsparse_operation_none,
-                                           this->nrow_,
-                                           this->ncol_,
-                                           this->nnz_,
-                                           this->mat_descr_,
-                                           this->mat_.val,
-                                           this->mat_.row_offset,
-                                           this->mat_.col,
-                                           this->mat_info_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
-    }
+            const HIPAcceleratorVector<int>* cast_perm
+                = dynamic_cast<const HIPAcceleratorVector<int>*>(&permutation);
 
-    template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::Apply(const BaseVector<ValueType>& in,
-                                                   BaseVector<ValueType>*       out) const
-    {
-        if(this->nnz_ > 0)
-        {
-            assert(out != NULL);
+            assert(cast_perm != NULL);
+            assert(cast_perm->size_ == this->nrow_);
+            assert(cast_perm->size_ == this->ncol_);
 
-            const HIPAcceleratorVector<ValueType>* cast_in
-                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
-            HIPAcceleratorVector<ValueType>* cast_out
-                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+            // Backward permutation is the forward permutation with the inverse, which is
+            // built on the device
+            HIPAcceleratorVector<int> inverse(this->local_backend_);
+            inverse.Allocate(this->nrow_);
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
-            assert(cast_in->size_ == this->ncol_);
-            assert(cast_out->size_ == this->nrow_);
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->nrow_ / this->local_backend_.HIP_block_size + 1);
 
-            ValueType alpha = static_cast<ValueType>(1);
-            ValueType beta  = static_cast<ValueType>(0);
+            kernel_reverse_index<<<GridSize,
+                                   BlockSize,
+                                   0,
+                                   HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_, cast_perm->vec_, inverse.vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            rocsparse_status status;
-            status = rocsparseTcsrmv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                     rocsparse_operation_none,
-                                     this->nrow_,
-                                     this->ncol_,
-                                     this->nnz_,
-                                     &alpha,
-                                     this->mat_descr_,
-                                     this->mat_.val,
-                                     this->mat_.row_offset,
-                                     this->mat_.col,
-                                     this->mat_info_,
-                                     cast_in->vec_,
-                                     &beta,
-                                     cast_out->vec_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            return this->Permute(inverse);
         }
+
+        return true;
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
-                                                      ValueType                    scalar,
-                                                      BaseVector<ValueType>*       out) const
+    void HIPAcceleratorMatrixCSR<ValueType>::SetSpMVAlg(unsigned int alg)
     {
-        if(this->nnz_ > 0)
+        if(alg != this->spmv_alg_)
         {
-            assert(out != NULL);
-
-            const HIPAcceleratorVector<ValueType>* cast_in
-                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
-            HIPAcceleratorVector<ValueType>* cast_out
-                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
-
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
-            assert(cast_in->size_ == this->ncol_);
-            assert(cast_out->size_ == this->nrow_);
-
-            ValueType beta = static_cast<ValueType>(1);
+            this->spmv_alg_ = alg;
+            this->ApplyAnalysis();
+        }
+    }
 
-            rocsparse_status status;
-            status = rocsparseTcsrmv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                     rocsparse_operation_none,
-                                     this->nrow_,
-                                     this->ncol_,
-                                     this->nnz_,
-                                     &scalar,
-                                     this->mat_descr_,
-                                     this->mat_.val,
-                                     this->mat_.row_offset,
-                                     this->mat_.col,
-                                     this->mat_info_,
-                                     cast_in->vec_,
-                                     &beta,
-                                     cast_out->vec_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::SetSpMVStorage(unsigned int storage)
+    {
+        if(storage != this->spmv_storage_)
+        {
+            this->spmv_storage_ = storage;
+            free_hip(&this->spmv_val_);
         }
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ILU0Factorize(void)
+    void HIPAcceleratorMatrixCSR<ValueType>::SetSpMVIndex(unsigned int index)
     {
-        if(this->nnz_ > 0)
+        if(index != this->spmv_index_)
         {
-            rocsparse_status status;
+            this->spmv_index_ = index;
+            this->InvalidateSpMVStructure_();
+        }
+    }
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::SetOutOfCore(int64_t chunk_nnz)
+    {
+        assert(chunk_nnz >= 0);
 
-            // Create buffer, if not already available
-            size_t buffer_size = 0;
-            status             = rocsparseTcsrilu0_buffer_size(
-                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                this->nrow_,
-                this->nnz_,
-                this->mat_descr_,
-                this->mat_.val,
-                this->mat_.row_offset,
-                this->mat_.col,
-                this->mat_info_,
-                &buffer_size);
+        if(chunk_nnz == this->ooc_chunk_nnz_)
+        {
+            return;
+        }
 
-            // Buffer is shared with ILU0 and other solve functions
-            if(this->mat_buffer_ == NULL)
+        bool out_of_core = chunk_nnz > 0;
+
+        // The chunks and the staging buffers depend on the chunk size
+        this->SpMVClear_();
+
+        if(out_of_core != (this->ooc_chunk_nnz_ > 0))
+        {
+            if(this->nnz_ > 0)
             {
-                this->mat_buffer_size_ = buffer_size;
-                allocate_hip(buffer_size, &this->mat_buffer_);
-            }
+                this->DetachStructure_();
 
-            assert(this->mat_buffer_size_ >= buffer_size);
-            assert(this->mat_buffer_ != NULL);
+                int*       col = NULL;
+                ValueType* val = NULL;
 
-            status = rocsparseTcsrilu0_analysis(
-                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                this->nrow_,
-                this->nnz_,
-                this->mat_descr_,
-                this->mat_.val,
-                this->mat_.row_offset,
-                this->mat_.col,
-                this->mat_info_,
-                rocsparse_analysis_policy_reuse,
-                rocsparse_solve_policy_auto,
-                this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+                allocate_csr_entries(out_of_core, this->nnz_, &col);
+                allocate_csr_entries(out_of_core, this->nnz_, &val);
 
-            status = rocsparseTcsrilu0(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                       this->nrow_,
-                                       this->nnz_,
-                                       this->mat_descr_,
-                                       this->mat_.val,
-                                       this->mat_.row_offset,
-                                       this->mat_.col,
-                                       this->mat_info_,
-                                       rocsparse_solve_policy_auto,
-                                       this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+                hipMemcpy(col, this->mat_.col, sizeof(int) * this->nnz_, hipMemcpyDefault);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            status = rocsparse_csrilu0_clear(
-                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle), this->mat_info_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+                hipMemcpy(val, this->mat_.val, sizeof(ValueType) * this->nnz_, hipMemcpyDefault);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+                free_hip(&this->mat_.col);
+                free_hip(&this->mat_.val);
+
+                this->mat_.col = col;
+                this->mat_.val = val;
+            }
+
+            if(out_of_core == false)
+            {
+                for(int k = 0; k < 2; ++k)
+                {
+                    if(this->ooc_stream_[k] != NULL)
+                    {
+                        hipStreamDestroy(this->ooc_stream_[k]);
+                        hipEventDestroy(this->ooc_event_[k]);
+                        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+                        this->ooc_stream_[k] = NULL;
+                        this->ooc_event_[k]  = NULL;
+                    }
+                }
+            }
         }
 
-        return true;
+        this->ooc_chunk_nnz_ = chunk_nnz;
+
+        this->ApplyAnalysis();
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ItILU0Factorize(ItILU0Algorithm alg,
-                                                             int             option,
-                                                             int             max_iter,
-                                                             double          tolerance,
-                                                             int*            niter,
-                                                             double*         history)
+    unsigned int HIPAcceleratorMatrixCSR<ValueType>::SpMVSelect_(void) const
     {
-        if(this->nnz_ > 0)
+        // Rows that are much longer than the average stall the adaptive and the stream
+        // algorithms, logarithmic row binning processes them with whole blocks
+        const int lrb_min_row_nnz = 1024;
+        const int lrb_imbalance   = 32;
+
+        // Matrices with at most one non-empty row in rowlist_sparsity rows, e.g. ghost
+        // parts or coarse transfer operators, only process their non-empty rows
+        const int rowlist_sparsity = 8;
+
+        this->SpMVRows_();
+
+        if(static_cast<int64_t>(this->spmv_nrows_) * rowlist_sparsity <= this->nrow_)
         {
-            rocsparse_status status;
+            return SpMVAlg_RowList;
+        }
 
-            rocsparse_itilu0_alg itilu0_alg;
-            rocsparse_int        itilu0_option = 0;
+        free_hip(&this->spmv_rows_);
+        this->spmv_nrows_ = 0;
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+        int* d_row_nnz = NULL;
+        int* d_max     = NULL;
 
-            switch(alg)
-            {
-            case ItILU0Algorithm::Default:
-                itilu0_alg = rocsparse_itilu0_alg_default;
-                break;
-            case ItILU0Algorithm::AsyncInPlace:
-                itilu0_alg = rocsparse_itilu0_alg_async_inplace;
-                break;
-            case ItILU0Algorithm::AsyncSplit:
-                itilu0_alg = rocsparse_itilu0_alg_async_split;
-                break;
-            case ItILU0Algorithm::SyncSplit:
-                itilu0_alg = rocsparse_itilu0_alg_sync_split;
-                break;
-            case ItILU0Algorithm::SyncSplitFusion:
-                itilu0_alg = rocsparse_itilu0_alg_sync_split_fusion;
-                break;
-            default:
-                itilu0_alg = rocsparse_itilu0_alg_default;
-                break;
-            }
+        allocate_hip(this->nrow_, &d_row_nnz);
+        allocate_hip(1, &d_max);
 
-            itilu0_option
-                |= ((option & ItILU0Option::Verbose) > 0) ? rocsparse_itilu0_option_verbose : 0;
-            itilu0_option |= ((option & ItILU0Option::StoppingCriteria) > 0)
-                                 ? rocsparse_itilu0_option_stopping_criteria
-                                 : 0;
-            itilu0_option |= ((option & ItILU0Option::ComputeNrmCorrection) > 0)
-                                 ? rocsparse_itilu0_option_compute_nrm_correction
-                                 : 0;
-            itilu0_option |= ((option & ItILU0Option::ComputeNrmResidual) > 0)
-                                 ? rocsparse_itilu0_option_compute_nrm_residual
-                                 : 0;
-            itilu0_option |= ((option & ItILU0Option::ConvergenceHistory) > 0)
-                                 ? rocsparse_itilu0_option_convergence_history
-                                 : 0;
-            itilu0_option |= ((option & ItILU0Option::COOFormat) > 0)
-                                 ? rocsparse_itilu0_option_coo_format
-                                 : 0;
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(this->nrow_ / this->local_backend_.HIP_block_size + 1);
 
-            // Create buffer
-            size_t buffer_size = 0;
-            status             = rocsparse_csritilu0_buffer_size(
-                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                itilu0_alg,
-                itilu0_option,
-                max_iter,
-                this->nrow_,
-                this->nnz_,
-                this->mat_.row_offset,
-                this->mat_.col,
-                rocsparse_index_base_zero,
-                rocsparseTdatatype<ValueType>(),
-                &buffer_size);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        kernel_calc_row_nnz<<<GridSize,
+                              BlockSize,
+                              0,
+                              HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_, this->mat_.row_offset, d_row_nnz);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            char* buffer = NULL;
-            allocate_hip(buffer_size, &buffer);
+        // rocprim buffer
+        size_t size   = 0;
+        char*  buffer = NULL;
 
-            if(buffer_size > 0)
-            {
-                assert(buffer != NULL);
-            }
+        // Determine maximum
+        rocprim::reduce(buffer,
+                        size,
+                        d_row_nnz,
+                        d_max,
+                        0,
+                        this->nrow_,
+                        rocprim::maximum<int>(),
+                        HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            status = rocsparse_csritilu0_preprocess(
-                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                itilu0_alg,
-                itilu0_option,
-                max_iter,
-                this->nrow_,
-                this->nnz_,
-                this->mat_.row_offset,
-                this->mat_.col,
-                rocsparse_index_base_zero,
-                rocsparseTdatatype<ValueType>(),
-                buffer_size,
-                buffer);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        allocate_hip(size, &buffer);
 
-            ValueType* ilu0 = NULL;
-            allocate_hip(this->nnz_, &ilu0);
-            set_to_zero_hip(this->local_backend_.HIP_block_size, this->nnz_, ilu0);
-            assert(ilu0 != NULL);
+        rocprim::reduce(buffer,
+                        size,
+                        d_row_nnz,
+                        d_max,
+                        0,
+                        this->nrow_,
+                        rocprim::maximum<int>(),
+                        HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            status = rocsparseTcsritilu0_compute(
-                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                itilu0_alg,
-                itilu0_option,
-                &max_iter,
-                tolerance,
-                this->nrow_,
-                this->nnz_,
-                this->mat_.row_offset,
-                this->mat_.col,
-                this->mat_.val,
-                ilu0,
-                rocsparse_index_base_zero,
-                buffer_size,
-                buffer);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-            niter[0] = max_iter;
-            if(history != NULL)
-            {
-                assert((option & ItILU0Option::StoppingCriteria) > 0);
-                if(std::is_same<ValueType, double>{}
-                   || std::is_same<ValueType, std::complex<double>>{})
-                {
-                    rocsparseTcsritilu0_history<double>(
-                        ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                        itilu0_alg,
-                        niter,
-                        history,
-                        buffer_size,
-                        buffer);
-                }
-                else
-                {
-                    int    num_iter      = max_iter;
-                    float* local_history = new float[num_iter * 2];
-                    rocsparseTcsritilu0_history<float>(
-                        ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                        itilu0_alg,
-                        niter,
-                        local_history,
-                        buffer_size,
-                        buffer);
+        int max_row_nnz;
+        copy_d2h(1, d_max, &max_row_nnz, true, HIPSTREAM(this->local_backend_.HIP_stream_current));
 
-                    for(int i = 0; i < num_iter * 2; ++i)
-                    {
-                        history[i] = local_history[i];
-                    }
-                }
-            }
+        hipStreamSynchronize(HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            free_hip(&buffer);
-            free_hip(&this->mat_.val);
+        free_hip(&buffer);
+        free_hip(&d_max);
+        free_hip(&d_row_nnz);
 
-            this->mat_.val = ilu0;
+        int64_t avg_row_nnz = (this->nnz_ - 1) / this->nrow_ + 1;
+
+        if(max_row_nnz >= lrb_min_row_nnz && max_row_nnz > lrb_imbalance * avg_row_nnz)
+        {
+            return SpMVAlg_LRB;
         }
 
-        return true;
+        return SpMVAlg_Adaptive;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ICFactorize(BaseVector<ValueType>* inv_diag)
+    void HIPAcceleratorMatrixCSR<ValueType>::SpMVClear_(void) const
     {
-        if(this->nnz_ > 0)
+        if(this->spmv_descr_ != NULL)
         {
-            rocsparse_status status;
+            rocsparse_status status = rocsparse_destroy_spmat_descr(this->spmv_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+            this->spmv_descr_ = NULL;
+        }
 
-            // Create buffer, if not already available
-            size_t buffer_size = 0;
-            status             = rocsparseTcsric0_buffer_size(
-                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                this->nrow_,
-                this->nnz_,
-                this->mat_descr_,
-                this->mat_.val,
-                this->mat_.row_offset,
-                this->mat_.col,
-                this->mat_info_,
-                &buffer_size);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        free_hip(&this->spmv_buffer_);
+        this->spmv_buffer_size_ = 0;
 
-            // Buffer is shared with IC0 and other solve functions
-            if(this->mat_buffer_ == NULL)
+        free_hip(&this->spmv_val_);
+        this->InvalidateSpMVStructure_();
+        free_hip(&this->spmv_row_offset_);
+
+        free_hip(&this->spmv_rows_);
+        this->spmv_nrows_ = 0;
+
+        // Chunks in flight still read the staging buffers
+        for(int k = 0; k < 2; ++k)
+        {
+            if(this->ooc_stream_[k] != NULL)
             {
-                this->mat_buffer_size_ = buffer_size;
-                allocate_hip(buffer_size, &this->mat_buffer_);
-            }
-            else if(this->mat_buffer_size_ < buffer_size)
-            {
-                this->mat_buffer_size_ = buffer_size;
-                free_hip(&this->mat_buffer_);
-                allocate_hip(buffer_size, &this->mat_buffer_);
+                hipStreamSynchronize(this->ooc_stream_[k]);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
             }
 
-            assert(this->mat_buffer_size_ >= buffer_size);
-            assert(this->mat_buffer_ != NULL);
+            free_hip(&this->ooc_col_[k]);
+            free_hip(&this->ooc_val_[k]);
+        }
 
-            status = rocsparseTcsric0_analysis(
-                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                this->nrow_,
-                this->nnz_,
-                this->mat_descr_,
-                this->mat_.val,
-                this->mat_.row_offset,
-                this->mat_.col,
-                this->mat_info_,
-                rocsparse_analysis_policy_reuse,
-                rocsparse_solve_policy_auto,
-                this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        this->ooc_row_.clear();
+        this->ooc_offset_.clear();
+    }
 
-            status = rocsparseTcsric0(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                      this->nrow_,
-                                      this->nnz_,
-                                      this->mat_descr_,
-                                      this->mat_.val,
-                                      this->mat_.row_offset,
-                                      this->mat_.col,
-                                      this->mat_info_,
-                                      rocsparse_solve_policy_auto,
-                                      this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::InvalidateSpMVStructure_(void) const
+    {
+        free_hip(&this->spmv_col_base_);
+        free_hip(&this->spmv_col_off_);
+        this->spmv_col_width_ = 0;
+    }
 
-            status = rocsparse_csric0_clear(
-                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle), this->mat_info_);
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ApplyAnalysis(void) const
+    {
+        // The generic descriptor holds the LRB analysis of the previous structure
+        this->SpMVClear_();
+
+        // The out-of-core product requires no analysis
+        if(this->nnz_ > 0 && this->ooc_chunk_nnz_ == 0)
+        {
+            this->spmv_alg_sel_
+                = (this->spmv_alg_ == SpMVAlg_Auto) ? this->SpMVSelect_() : this->spmv_alg_;
+
+            // The adaptive and the stream algorithm require 32 bit row offsets
+            if(this->spmv_alg_sel_ != SpMVAlg_RowList && this->SpMVRowOffset_() == NULL)
+            {
+                this->spmv_alg_sel_ = SpMVAlg_LRB;
+            }
+
+            // The stream algorithm requires no analysis, LRB is analysed on first use
+            if(this->spmv_alg_sel_ != SpMVAlg_Adaptive)
+            {
+                return;
+            }
+
+            rocsparse_status status;
+            status
+                = rocsparseTcsrmv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                           rocsparse_operation_none,
+                                           this->nrow_,
+                                           this->ncol_,
+                                           this->nnz_,
+                                           this->mat_descr_,
+                                           this->mat_.val,
+                                           this->SpMVRowOffset_(),
+                                           this->mat_.col,
+                                           this->mat_info_);
             CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
         }
-
-        return true;
     }
 
-    template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::LUAnalyse(void)
+    // Row offsets that are already stored with 32 bits are used directly
+    static const int* csr_row_offset_32(
+        int nrow, int64_t nnz, const int* row_offset, int** buffer, int blocksize, hipStream_t)
     {
-        assert(this->ncol_ == this->nrow_);
-        assert(this->tmp_vec_ == NULL);
+        return row_offset;
+    }
 
-        this->tmp_vec_ = new HIPAcceleratorVector<ValueType>(this->local_backend_);
+    // 64 bit row offsets are converted once, if all offsets fit into 32 bits
+    static const int* csr_row_offset_32(int            nrow,
+                                        int64_t        nnz,
+                                        const int64_t* row_offset,
+                                        int**          buffer,
+                                        int            blocksize,
+                                        hipStream_t    stream)
+    {
+        if(nnz > std::numeric_limits<int>::max())
+        {
+            return NULL;
+        }
 
-        assert(this->tmp_vec_ != NULL);
+        if(*buffer == NULL)
+        {
+            allocate_hip(nrow + 1, buffer);
 
-        // Status
-        rocsparse_status status;
+            kernel_csr_row_offset_32<<<nrow / blocksize + 1, blocksize, 0, stream>>>(
+                nrow, row_offset, *buffer);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
 
-        // L part
-        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        return *buffer;
+    }
 
-        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    template <typename ValueType>
+    const int* HIPAcceleratorMatrixCSR<ValueType>::SpMVRowOffset_(void) const
+    {
+        // The copy is released with the SpMV analysis whenever the structure changes
+        return csr_row_offset_32(this->nrow_,
+                                 this->nnz_,
+                                 this->mat_.row_offset,
+                                 &this->spmv_row_offset_,
+                                 this->local_backend_.HIP_block_size,
+                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+    }
 
-        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    template <typename ValueType>
+    const int* HIPAcceleratorMatrixCSR<ValueType>::SpMVRows_(void) const
+    {
+        // The list is released with the SpMV analysis whenever the structure changes
+        if(this->spmv_rows_ == NULL && this->nrow_ > 0)
+        {
+            hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
 
-        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            int* d_flag  = NULL;
+            int* d_count = NULL;
 
-        status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_unit);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            allocate_hip(this->nrow_, &d_flag);
+            allocate_hip(this->nrow_, &this->spmv_rows_);
+            allocate_hip(1, &d_count);
 
-        // U part
-        status = rocsparse_create_mat_descr(&this->U_mat_descr_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->nrow_ / this->local_backend_.HIP_block_size + 1);
 
-        status = rocsparse_set_mat_type(this->U_mat_descr_, rocsparse_matrix_type_general);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            kernel_csr_row_nonempty<<<GridSize, BlockSize, 0, stream>>>(
+                this->nrow_, this->mat_.row_offset, d_flag);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        status = rocsparse_set_mat_index_base(this->U_mat_descr_, rocsparse_index_base_zero);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            // rocprim buffer
+            size_t size   = 0;
+            char*  buffer = NULL;
 
-        status = rocsparse_set_mat_fill_mode(this->U_mat_descr_, rocsparse_fill_mode_upper);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            rocprim::select(buffer,
+                            size,
+                            rocprim::counting_iterator<int>(0),
+                            d_flag,
+                            this->spmv_rows_,
+                            d_count,
+                            this->nrow_,
+                            stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_non_unit);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            allocate_hip(size, &buffer);
 
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
+            rocprim::select(buffer,
+                            size,
+                            rocprim::counting_iterator<int>(0),
+                            d_flag,
+                            this->spmv_rows_,
+                            d_count,
+                            this->nrow_,
+                            stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        // Create buffer, if not already available
-        size_t buffer_size = 0;
+            copy_d2h(1, d_count, &this->spmv_nrows_, true, stream);
 
-        status
-            = rocsparseTcsrsv_buffer_size(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          &buffer_size);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            hipStreamSynchronize(stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        // Buffer is shared with ILU0 and other solve functions
-        if(this->mat_buffer_ == NULL)
-        {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_hip(buffer_size, &this->mat_buffer_);
+            free_hip(&buffer);
+            free_hip(&d_count);
+            free_hip(&d_flag);
         }
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
-
-        // L part analysis
-        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          rocsparse_analysis_policy_reuse,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        return this->spmv_rows_;
+    }
 
-        // U part analysis
-        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->U_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          rocsparse_analysis_policy_reuse,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    template <unsigned int WFSIZE, typename ValueType>
+    static void csrmv_rowlist_launch(int              blocksize,
+                                     int              nrows,
+                                     const int*       rows,
+                                     const PtrType*   row_offset,
+                                     const int*       col,
+                                     const ValueType* val,
+                                     ValueType        alpha,
+                                     const ValueType* x,
+                                     ValueType*       y,
+                                     hipStream_t      stream)
+    {
+        dim3 BlockSize(blocksize);
+        dim3 GridSize((static_cast<int64_t>(nrows) * WFSIZE - 1) / blocksize + 1);
 
-        // Allocate temporary vector
-        this->tmp_vec_->Allocate(this->nrow_);
+        kernel_csrmv_rowlist<WFSIZE><<<GridSize, BlockSize, 0, stream>>>(
+            nrows, rows, row_offset, col, val, alpha, x, y);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::LUAnalyseClear(void)
+    void HIPAcceleratorMatrixCSR<ValueType>::SpMVRowList_(
+        ValueType                              alpha,
+        const HIPAcceleratorVector<ValueType>& in,
+        ValueType                              beta,
+        HIPAcceleratorVector<ValueType>*       out) const
     {
-        rocsparse_status status;
+        const int* rows = this->SpMVRows_();
 
-        // Clear analysis info
-        if(this->L_mat_descr_ != NULL)
+        // The empty rows are only scaled by beta
+        if(beta == static_cast<ValueType>(0))
         {
-            status = rocsparse_csrsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                           this->L_mat_descr_,
-                                           this->mat_info_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            out->Zeros();
         }
-
-        if(this->U_mat_descr_ != NULL)
+        else if(beta != static_cast<ValueType>(1))
         {
-            status = rocsparse_csrsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                           this->U_mat_descr_,
-                                           this->mat_info_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            out->Scale(beta);
         }
 
-        // Clear matrix descriptor
-        if(this->L_mat_descr_ != NULL)
+        if(this->spmv_nrows_ == 0)
         {
-            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            return;
         }
 
-        if(this->U_mat_descr_ != NULL)
+        int         blocksize       = this->local_backend_.HIP_block_size;
+        int64_t     avg_nnz_per_row = (this->nnz_ - 1) / this->spmv_nrows_ + 1;
+        hipStream_t stream          = HIPSTREAM(this->local_backend_.HIP_stream_current);
+
+        if(avg_nnz_per_row <= 8)
         {
-            status = rocsparse_destroy_mat_descr(this->U_mat_descr_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            csrmv_rowlist_launch<1>(blocksize,
+                                    this->spmv_nrows_,
+                                    rows,
+                                    this->mat_.row_offset,
+                                    this->mat_.col,
+                                    this->mat_.val,
+                                    alpha,
+                                    in.vec_,
+                                    out->vec_,
+                                    stream);
         }
-
-        this->L_mat_descr_ = 0;
-        this->U_mat_descr_ = 0;
-
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
+        else if(avg_nnz_per_row <= 32)
         {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            csrmv_rowlist_launch<4>(blocksize,
+                                    this->spmv_nrows_,
+                                    rows,
+                                    this->mat_.row_offset,
+                                    this->mat_.col,
+                                    this->mat_.val,
+                                    alpha,
+                                    in.vec_,
+                                    out->vec_,
+                                    stream);
         }
-
-        this->mat_buffer_size_ = 0;
-
-        // Clear temporary vector
-        if(this->tmp_vec_ != NULL)
+        else if(avg_nnz_per_row <= 128)
         {
-            delete this->tmp_vec_;
-            this->tmp_vec_ = NULL;
+            csrmv_rowlist_launch<16>(blocksize,
+                                     this->spmv_nrows_,
+                                     rows,
+                                     this->mat_.row_offset,
+                                     this->mat_.col,
+                                     this->mat_.val,
+                                     alpha,
+                                     in.vec_,
+                                     out->vec_,
+                                     stream);
+        }
+        else
+        {
+            csrmv_rowlist_launch<32>(blocksize,
+                                     this->spmv_nrows_,
+                                     rows,
+                                     this->mat_.row_offset,
+                                     this->mat_.col,
+                                     this->mat_.val,
+                                     alpha,
+                                     in.vec_,
+                                     out->vec_,
+                                     stream);
         }
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::LUSolve(const BaseVector<ValueType>& in,
-                                                     BaseVector<ValueType>*       out) const
+    void HIPAcceleratorMatrixCSR<ValueType>::SpMV_(ValueType                              alpha,
+                                                   const HIPAcceleratorVector<ValueType>& in,
+                                                   ValueType                              beta,
+                                                   HIPAcceleratorVector<ValueType>* out) const
     {
-        if(this->nnz_ > 0)
+        if(this->ooc_chunk_nnz_ > 0)
         {
-            assert(out != NULL);
-            assert(this->L_mat_descr_ != 0);
-            assert(this->U_mat_descr_ != 0);
-            assert(this->mat_info_ != 0);
-            assert(this->ncol_ == this->nrow_);
-            assert(this->tmp_vec_ != NULL);
+            this->SpMVOutOfCore_(alpha, in, beta, out);
 
-            const HIPAcceleratorVector<ValueType>* cast_in
-                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
-            HIPAcceleratorVector<ValueType>* cast_out
-                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+            return;
+        }
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
-            assert(cast_in->size_ == this->ncol_);
-            assert(cast_out->size_ == this->nrow_);
+        if(this->spmv_storage_ != SpMVStorage_Full
+           && this->SpMVReduced_(alpha, in, beta, out) == true)
+        {
+            return;
+        }
 
-            rocsparse_status status;
+        if(this->spmv_index_ == SpMVIndex_Compressed
+           && this->SpMVCompressed_(alpha, in, beta, out) == true)
+        {
+            return;
+        }
 
-            ValueType alpha = static_cast<ValueType>(1);
+        if(this->spmv_alg_sel_ == SpMVAlg_RowList)
+        {
+            this->SpMVRowList_(alpha, in, beta, out);
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+            return;
+        }
 
-            // Solve L
-            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                     rocsparse_operation_none,
-                                     this->nrow_,
-                                     this->nnz_,
-                                     &alpha,
-                                     this->L_mat_descr_,
-                                     this->mat_.val,
-                                     this->mat_.row_offset,
-                                     this->mat_.col,
-                                     this->mat_info_,
-                                     cast_in->vec_,
-                                     this->tmp_vec_->vec_,
-                                     rocsparse_solve_policy_auto,
-                                     this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        rocsparse_handle handle = ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle);
+        rocsparse_status status;
 
-            // Solve U
-            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                     rocsparse_operation_none,
-                                     this->nrow_,
-                                     this->nnz_,
-                                     &alpha,
-                                     this->U_mat_descr_,
-                                     this->mat_.val,
-                                     this->mat_.row_offset,
-                                     this->mat_.col,
-                                     this->mat_info_,
-                                     this->tmp_vec_->vec_,
-                                     cast_out->vec_,
-                                     rocsparse_solve_policy_auto,
-                                     this->mat_buffer_);
+        if(this->spmv_alg_sel_ != SpMVAlg_LRB)
+        {
+            // Adaptive uses the csrmv analysis, stream runs without
+            status = rocsparseTcsrmv(
+                handle,
+                rocsparse_operation_none,
+                this->nrow_,
+                this->ncol_,
+                this->nnz_,
+                &alpha,
+                this->mat_descr_,
+                this->mat_.val,
+                this->SpMVRowOffset_(),
+                this->mat_.col,
+                (this->spmv_alg_sel_ == SpMVAlg_Adaptive) ? this->mat_info_ : NULL,
+                in.vec_,
+                &beta,
+                out->vec_);
             CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            return;
         }
 
-        return true;
-    }
+        rocsparse_dnvec_descr vecX;
+        rocsparse_dnvec_descr vecY;
 
-    template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::ItLUAnalyse(void)
-    {
-        assert(this->ncol_ == this->nrow_);
-        assert(this->tmp_vec_ == NULL);
+        status = rocsparse_create_dnvec_descr(
+            &vecX, this->ncol_, in.vec_, rocsparseTdatatype<ValueType>());
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        this->tmp_vec_ = new HIPAcceleratorVector<ValueType>(this->local_backend_);
+        status = rocsparse_create_dnvec_descr(
+            &vecY, this->nrow_, out->vec_, rocsparseTdatatype<ValueType>());
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        assert(this->tmp_vec_ != NULL);
+        // Row offsets of 32 bits, unless the non-zeros exceed them
+        const int* row_offset_32 = this->SpMVRowOffset_();
+
+        void* row_offset = (row_offset_32 != NULL)
+                               ? static_cast<void*>(const_cast<int*>(row_offset_32))
+                               : static_cast<void*>(this->mat_.row_offset);
+
+        if(this->spmv_descr_ == NULL)
+        {
+            status = rocsparse_create_csr_descr(&this->spmv_descr_,
+                                                this->nrow_,
+                                                this->ncol_,
+                                                this->nnz_,
+                                                row_offset,
+                                                this->mat_.col,
+                                                this->mat_.val,
+                                                (row_offset_32 != NULL)
+                                                    ? rocsparse_indextype_i32
+                                                    : rocsparseTindextype<PtrType>(),
+                                                rocsparse_indextype_i32,
+                                                rocsparse_index_base_zero,
+                                                rocsparseTdatatype<ValueType>());
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        // Status
-        rocsparse_status status;
+            status = rocsparse_spmv(handle,
+                                    rocsparse_operation_none,
+                                    &alpha,
+                                    this->spmv_descr_,
+                                    vecX,
+                                    &beta,
+                                    vecY,
+                                    rocsparseTdatatype<ValueType>(),
+                                    rocsparse_spmv_alg_csr_lrb,
+                                    rocsparse_spmv_stage_buffer_size,
+                                    &this->spmv_buffer_size_,
+                                    NULL);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        // L part
-        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            allocate_hip(this->spmv_buffer_size_, &this->spmv_buffer_);
+
+            // Row binning, kept until the structure changes
+            status = rocsparse_spmv(handle,
+                                    rocsparse_operation_none,
+                                    &alpha,
+                                    this->spmv_descr_,
+                                    vecX,
+                                    &beta,
+                                    vecY,
+                                    rocsparseTdatatype<ValueType>(),
+                                    rocsparse_spmv_alg_csr_lrb,
+                                    rocsparse_spmv_stage_preprocess,
+                                    &this->spmv_buffer_size_,
+                                    this->spmv_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+        else
+        {
+            // Values might have been reallocated with the same structure
+            status = rocsparse_csr_set_pointers(
+                this->spmv_descr_, row_offset, this->mat_.col, this->mat_.val);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
 
-        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
+        status = rocsparse_spmv(handle,
+                                rocsparse_operation_none,
+                                &alpha,
+                                this->spmv_descr_,
+                                vecX,
+                                &beta,
+                                vecY,
+                                rocsparseTdatatype<ValueType>(),
+                                rocsparse_spmv_alg_csr_lrb,
+                                rocsparse_spmv_stage_compute,
+                                &this->spmv_buffer_size_,
+                                this->spmv_buffer_);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
+        status = rocsparse_destroy_dnvec_descr(vecX);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
+        status = rocsparse_destroy_dnvec_descr(vecY);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    }
 
-        status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_unit);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    template <unsigned int WFSIZE, typename ValueType>
+    static void csrmv_chunk_launch(int              blocksize,
+                                   int              nrow,
+                                   const PtrType*   row_offset,
+                                   PtrType          base,
+                                   const int*       col,
+                                   const ValueType* val,
+                                   ValueType        alpha,
+                                   const ValueType* x,
+                                   ValueType        beta,
+                                   ValueType*       y,
+                                   hipStream_t      stream)
+    {
+        dim3 BlockSize(blocksize);
+        dim3 GridSize((static_cast<int64_t>(nrow) * WFSIZE - 1) / blocksize + 1);
 
-        // U part
-        status = rocsparse_create_mat_descr(&this->U_mat_descr_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        kernel_csrmv_chunk<WFSIZE><<<GridSize, BlockSize, 0, stream>>>(
+            nrow, row_offset, base, col, val, alpha, x, beta, y);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
 
-        status = rocsparse_set_mat_type(this->U_mat_descr_, rocsparse_matrix_type_general);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::SpMVOutOfCore_(
+        ValueType                              alpha,
+        const HIPAcceleratorVector<ValueType>& in,
+        ValueType                              beta,
+        HIPAcceleratorVector<ValueType>*       out) const
+    {
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
 
-        status = rocsparse_set_mat_index_base(this->U_mat_descr_, rocsparse_index_base_zero);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        // Split the rows into chunks of at most ooc_chunk_nnz_ entries, a longer row forms
+        // a chunk of its own
+        if(this->ooc_row_.empty() == true)
+        {
+            std::vector<PtrType> row_offset(this->nrow_ + 1);
 
-        status = rocsparse_set_mat_fill_mode(this->U_mat_descr_, rocsparse_fill_mode_upper);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            copy_d2h(this->nrow_ + 1, this->mat_.row_offset, row_offset.data(), true, stream);
 
-        status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_non_unit);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            hipStreamSynchronize(stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
+            this->ooc_row_.push_back(0);
+            this->ooc_offset_.push_back(0);
 
-        // Create buffer, if not already available
-        size_t buffer_size   = 0;
-        size_t L_buffer_size = 0;
-        size_t U_buffer_size = 0;
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                if(i > this->ooc_row_.back()
+                   && row_offset[i + 1] - this->ooc_offset_.back() > this->ooc_chunk_nnz_)
+                {
+                    this->ooc_row_.push_back(i);
+                    this->ooc_offset_.push_back(row_offset[i]);
+                }
+            }
 
-        status = rocsparseTcsritsv_buffer_size(
-            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-            rocsparse_operation_none,
-            this->nrow_,
-            this->nnz_,
-            this->L_mat_descr_,
-            this->mat_.val,
-            this->mat_.row_offset,
-            this->mat_.col,
-            this->mat_info_itsv_,
-            &L_buffer_size);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        status = rocsparseTcsritsv_buffer_size(
-            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-            rocsparse_operation_none,
-            this->nrow_,
-            this->nnz_,
-            this->U_mat_descr_,
-            this->mat_.val,
-            this->mat_.row_offset,
-            this->mat_.col,
-            this->mat_info_itsv_,
-            &U_buffer_size);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            this->ooc_row_.push_back(this->nrow_);
+            this->ooc_offset_.push_back(row_offset[this->nrow_]);
 
-        buffer_size = std::max(L_buffer_size, U_buffer_size);
+            int64_t max_chunk_nnz = 0;
 
-        // Check buffer size
-        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
-        {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
-        }
+            for(size_t c = 0; c + 1 < this->ooc_offset_.size(); ++c)
+            {
+                max_chunk_nnz = std::max(
+                    max_chunk_nnz,
+                    static_cast<int64_t>(this->ooc_offset_[c + 1] - this->ooc_offset_[c]));
+            }
 
-        if(this->mat_buffer_ == NULL)
-        {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_hip(buffer_size, &this->mat_buffer_);
+            for(int k = 0; k < 2; ++k)
+            {
+                allocate_hip(max_chunk_nnz, &this->ooc_col_[k]);
+                allocate_hip(max_chunk_nnz, &this->ooc_val_[k]);
+
+                if(this->ooc_stream_[k] == NULL)
+                {
+                    hipStreamCreate(&this->ooc_stream_[k]);
+                    hipEventCreateWithFlags(&this->ooc_event_[k], hipEventDisableTiming);
+                    CHECK_HIP_ERROR(__FILE__, __LINE__);
+                }
+            }
         }
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
+        // The chunks wait for the input vectors of the current stream
+        hipEventRecord(this->ooc_event_[0], stream);
+        hipStreamWaitEvent(this->ooc_stream_[0], this->ooc_event_[0], 0);
+        hipStreamWaitEvent(this->ooc_stream_[1], this->ooc_event_[0], 0);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        // L part analysis
-        status
-            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                         rocsparse_operation_none,
-                                         this->nrow_,
-                                         this->nnz_,
-                                         this->L_mat_descr_,
-                                         this->mat_.val,
-                                         this->mat_.row_offset,
-                                         this->mat_.col,
-                                         this->mat_info_itsv_,
-                                         rocsparse_analysis_policy_reuse,
-                                         rocsparse_solve_policy_auto,
-                                         this->mat_buffer_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        int64_t avg_nnz_per_row = this->nnz_ / this->nrow_;
+        int     blocksize       = this->local_backend_.HIP_block_size;
+
+        // While one stream transfers the entries of the next chunk, the other one processes
+        // the chunk that has been staged before
+        for(size_t c = 0; c + 1 < this->ooc_row_.size(); ++c)
+        {
+            int         k         = c & 1;
+            hipStream_t ooc       = this->ooc_stream_[k];
+            int         row_begin = this->ooc_row_[c];
+            int         nrow      = this->ooc_row_[c + 1] - row_begin;
+            PtrType     base      = this->ooc_offset_[c];
+            int64_t     nnz       = this->ooc_offset_[c + 1] - base;
+
+            hipMemcpyAsync(this->ooc_col_[k],
+                           this->mat_.col + base,
+                           sizeof(int) * nnz,
+                           hipMemcpyDefault,
+                           ooc);
+            hipMemcpyAsync(this->ooc_val_[k],
+                           this->mat_.val + base,
+                           sizeof(ValueType) * nnz,
+                           hipMemcpyDefault,
+                           ooc);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        // U part analysis
-        status
-            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                         rocsparse_operation_none,
-                                         this->nrow_,
-                                         this->nnz_,
-                                         this->U_mat_descr_,
-                                         this->mat_.val,
-                                         this->mat_.row_offset,
-                                         this->mat_.col,
-                                         this->mat_info_itsv_,
-                                         rocsparse_analysis_policy_reuse,
-                                         rocsparse_solve_policy_auto,
-                                         this->mat_buffer_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            const PtrType* row_offset = this->mat_.row_offset + row_begin;
+            ValueType*     y          = out->vec_ + row_begin;
 
-        // Allocate temporary vector
-        this->tmp_vec_->Allocate(this->nrow_);
+            if(avg_nnz_per_row <= 8)
+            {
+                csrmv_chunk_launch<1>(blocksize,
+                                      nrow,
+                                      row_offset,
+                                      base,
+                                      this->ooc_col_[k],
+                                      this->ooc_val_[k],
+                                      alpha,
+                                      in.vec_,
+                                      beta,
+                                      y,
+                                      ooc);
+            }
+            else if(avg_nnz_per_row <= 32)
+            {
+                csrmv_chunk_launch<4>(blocksize,
+                                      nrow,
+                                      row_offset,
+                                      base,
+                                      this->ooc_col_[k],
+                                      this->ooc_val_[k],
+                                      alpha,
+                                      in.vec_,
+                                      beta,
+                                      y,
+                                      ooc);
+            }
+            else if(avg_nnz_per_row <= 128)
+            {
+                csrmv_chunk_launch<16>(blocksize,
+                                       nrow,
+                                       row_offset,
+                                       base,
+                                       this->ooc_col_[k],
+                                       this->ooc_val_[k],
+                                       alpha,
+                                       in.vec_,
+                                       beta,
+                                       y,
+                                       ooc);
+            }
+            else
+            {
+                csrmv_chunk_launch<32>(blocksize,
+                                       nrow,
+                                       row_offset,
+                                       base,
+                                       this->ooc_col_[k],
+                                       this->ooc_val_[k],
+                                       alpha,
+                                       in.vec_,
+                                       beta,
+                                       y,
+                                       ooc);
+            }
+        }
+
+        // Consumers of the output on the current stream wait for both chunk streams
+        for(int k = 0; k < 2; ++k)
+        {
+            hipEventRecord(this->ooc_event_[k], this->ooc_stream_[k]);
+            hipStreamWaitEvent(stream, this->ooc_event_[k], 0);
+        }
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        _rocalution_transfer_record((sizeof(int) + sizeof(ValueType)) * this->nnz_, true);
     }
 
-    template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::ItLUAnalyseClear(void)
+    template <unsigned int WFSIZE, typename S, typename ValueType>
+    static void csrmv_reduced_launch(int              blocksize,
+                                     int              nrow,
+                                     const PtrType*   row_offset,
+                                     const int*       col,
+                                     const S*         val,
+                                     ValueType        alpha,
+                                     const ValueType* x,
+                                     ValueType        beta,
+                                     ValueType*       y,
+                                     hipStream_t      stream)
     {
-        rocsparse_status status;
+        dim3 BlockSize(blocksize);
+        dim3 GridSize((static_cast<int64_t>(nrow) * WFSIZE - 1) / blocksize + 1);
 
-        // Clear analysis info
-        if(this->L_mat_descr_ != NULL)
+        kernel_csrmv_reduced_precision<WFSIZE><<<GridSize, BlockSize, 0, stream>>>(
+            nrow, row_offset, col, val, alpha, x, beta, y);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
+
+    // y = alpha * A * x + beta * y with the values of A rounded to S, the rounded values
+    // are built on first use
+    template <typename S, typename ValueType>
+    static void csrmv_reduced(int              blocksize,
+                              int              warp,
+                              int              nrow,
+                              int64_t          nnz,
+                              const PtrType*   row_offset,
+                              const int*       col,
+                              const ValueType* val,
+                              char**           val_reduced,
+                              ValueType        alpha,
+                              const ValueType* x,
+                              ValueType        beta,
+                              ValueType*       y,
+                              hipStream_t      stream)
+    {
+        if(*val_reduced == NULL)
         {
-            status
-                = rocsparse_csritsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          this->L_mat_descr_,
-                                          this->mat_info_itsv_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            allocate_hip(nnz * static_cast<int64_t>(sizeof(S)), val_reduced);
+
+            kernel_csr_round_values<<<(nnz - 1) / blocksize + 1, blocksize, 0, stream>>>(
+                nnz, val, reinterpret_cast<S*>(*val_reduced));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
         }
 
-        if(this->U_mat_descr_ != NULL)
+        const S* sval            = reinterpret_cast<const S*>(*val_reduced);
+        int64_t  avg_nnz_per_row = nnz / nrow;
+
+        if(avg_nnz_per_row <= 8)
         {
-            status
-                = rocsparse_csritsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          this->U_mat_descr_,
-                                          this->mat_info_itsv_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            csrmv_reduced_launch<1>(
+                blocksize, nrow, row_offset, col, sval, alpha, x, beta, y, stream);
         }
-
-        // Clear matrix descriptor
-        if(this->L_mat_descr_ != NULL)
+        else if(avg_nnz_per_row <= 16)
         {
-            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            csrmv_reduced_launch<2>(
+                blocksize, nrow, row_offset, col, sval, alpha, x, beta, y, stream);
         }
-
-        if(this->U_mat_descr_ != NULL)
+        else if(avg_nnz_per_row <= 32)
         {
-            status = rocsparse_destroy_mat_descr(this->U_mat_descr_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            csrmv_reduced_launch<4>(
+                blocksize, nrow, row_offset, col, sval, alpha, x, beta, y, stream);
         }
-
-        this->L_mat_descr_ = 0;
-        this->U_mat_descr_ = 0;
-
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
+        else if(avg_nnz_per_row <= 64)
         {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            csrmv_reduced_launch<8>(
+                blocksize, nrow, row_offset, col, sval, alpha, x, beta, y, stream);
         }
-
-        this->mat_buffer_size_ = 0;
-
-        // Clear temporary vector
-        if(this->tmp_vec_ != NULL)
+        else if(avg_nnz_per_row <= 128)
         {
-            delete this->tmp_vec_;
-            this->tmp_vec_ = NULL;
+            csrmv_reduced_launch<16>(
+                blocksize, nrow, row_offset, col, sval, alpha, x, beta, y, stream);
+        }
+        else if(avg_nnz_per_row <= 256 || warp == 32)
+        {
+            csrmv_reduced_launch<32>(
+                blocksize, nrow, row_offset, col, sval, alpha, x, beta, y, stream);
+        }
+        else
+        {
+            csrmv_reduced_launch<64>(
+                blocksize, nrow, row_offset, col, sval, alpha, x, beta, y, stream);
         }
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ItLUSolve(int                          max_iter,
-                                                       double                       tolerance,
-                                                       bool                         use_tol,
-                                                       const BaseVector<ValueType>& in,
-                                                       BaseVector<ValueType>*       out) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::SpMVReduced_(ValueType                              alpha,
+                                                          const HIPAcceleratorVector<ValueType>& in,
+                                                          ValueType                              beta,
+                                                          HIPAcceleratorVector<ValueType>* out) const
     {
-        if(this->nnz_ > 0)
-        {
-            assert(out != NULL);
-            assert(this->L_mat_descr_ != 0);
-            assert(this->U_mat_descr_ != 0);
-            assert(this->mat_info_itsv_ != 0);
-            assert(this->ncol_ == this->nrow_);
-            assert(this->tmp_vec_ != NULL);
+        // Reduced precision values are only provided for float and double
+        return false;
+    }
 
-            const HIPAcceleratorVector<ValueType>* cast_in
-                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
-            HIPAcceleratorVector<ValueType>* cast_out
-                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+    template <>
+    bool HIPAcceleratorMatrixCSR<double>::SpMVReduced_(double                              alpha,
+                                                       const HIPAcceleratorVector<double>& in,
+                                                       double                              beta,
+                                                       HIPAcceleratorVector<double>*       out) const
+    {
+        int         blocksize = this->local_backend_.HIP_block_size;
+        int         warp      = this->local_backend_.HIP_warp;
+        hipStream_t stream    = HIPSTREAM(this->local_backend_.HIP_stream_current);
+
+        // The rounded copy is released whenever the values or the structure change
+        switch(this->spmv_storage_)
+        {
+        case SpMVStorage_Float:
+            csrmv_reduced<float>(blocksize,
+                                 warp,
+                                 this->nrow_,
+                                 this->nnz_,
+                                 this->mat_.row_offset,
+                                 this->mat_.col,
+                                 this->mat_.val,
+                                 &this->spmv_val_,
+                                 alpha,
+                                 in.vec_,
+                                 beta,
+                                 out->vec_,
+                                 stream);
+            return true;
+        case SpMVStorage_Half:
+            csrmv_reduced<__half>(blocksize,
+                                  warp,
+                                  this->nrow_,
+                                  this->nnz_,
+                                  this->mat_.row_offset,
+                                  this->mat_.col,
+                                  this->mat_.val,
+                                  &this->spmv_val_,
+                                  alpha,
+                                  in.vec_,
+                                  beta,
+                                  out->vec_,
+                                  stream);
+            return true;
+        case SpMVStorage_BFloat16:
+            csrmv_reduced<hip_bfloat16>(blocksize,
+                                        warp,
+                                        this->nrow_,
+                                        this->nnz_,
+                                        this->mat_.row_offset,
+                                        this->mat_.col,
+                                        this->mat_.val,
+                                        &this->spmv_val_,
+                                        alpha,
+                                        in.vec_,
+                                        beta,
+                                        out->vec_,
+                                        stream);
+            return true;
+        }
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
-            assert(cast_in->size_ == this->ncol_);
-            assert(cast_out->size_ == this->nrow_);
+        return false;
+    }
 
-            rocsparse_status status;
+    template <>
+    bool HIPAcceleratorMatrixCSR<float>::SpMVReduced_(float                              alpha,
+                                                      const HIPAcceleratorVector<float>& in,
+                                                      float                              beta,
+                                                      HIPAcceleratorVector<float>*       out) const
+    {
+        int         blocksize = this->local_backend_.HIP_block_size;
+        int         warp      = this->local_backend_.HIP_warp;
+        hipStream_t stream    = HIPSTREAM(this->local_backend_.HIP_stream_current);
 
-            const ValueType                   alpha = static_cast<ValueType>(1);
-            const numeric_traits_t<ValueType> temp_tol
-                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+        // Float values are already stored in full precision
+        switch(this->spmv_storage_)
+        {
+        case SpMVStorage_Half:
+            csrmv_reduced<__half>(blocksize,
+                                  warp,
+                                  this->nrow_,
+                                  this->nnz_,
+                                  this->mat_.row_offset,
+                                  this->mat_.col,
+                                  this->mat_.val,
+                                  &this->spmv_val_,
+                                  alpha,
+                                  in.vec_,
+                                  beta,
+                                  out->vec_,
+                                  stream);
+            return true;
+        case SpMVStorage_BFloat16:
+            csrmv_reduced<hip_bfloat16>(blocksize,
+                                        warp,
+                                        this->nrow_,
+                                        this->nnz_,
+                                        this->mat_.row_offset,
+                                        this->mat_.col,
+                                        this->mat_.val,
+                                        &this->spmv_val_,
+                                        alpha,
+                                        in.vec_,
+                                        beta,
+                                        out->vec_,
+                                        stream);
+            return true;
+        }
 
-            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+        return false;
+    }
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+    template <unsigned int WFSIZE, typename C, typename ValueType>
+    static void csrmv_compressed_col_launch(int              blocksize,
+                                            int              nrow,
+                                            const PtrType*   row_offset,
+                                            const int*       col,
+                                            const int*       col_base,
+                                            const C*         col_off,
+                                            const ValueType* val,
+                                            ValueType        alpha,
+                                            const ValueType* x,
+                                            ValueType        beta,
+                                            ValueType*       y,
+                                            hipStream_t      stream)
+    {
+        dim3 BlockSize(blocksize);
+        dim3 GridSize((static_cast<int64_t>(nrow) * WFSIZE - 1) / blocksize + 1);
 
-            // Solve L
-            status
-                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          &max_iter,
-                                          tol_ptr,
-                                          nullptr,
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          &alpha,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_itsv_,
-                                          cast_in->vec_,
-                                          this->tmp_vec_->vec_,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        kernel_csrmv_compressed_col<WFSIZE><<<GridSize, BlockSize, 0, stream>>>(
+            nrow, row_offset, col, col_base, col_off, val, alpha, x, beta, y);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
 
-            // Solve U
-            status
-                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          &max_iter,
-                                          tol_ptr,
-                                          nullptr,
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          &alpha,
-                                          this->U_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_itsv_,
-                                          this->tmp_vec_->vec_,
-                                          cast_out->vec_,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
+    // y = alpha * A * x + beta * y with the column indices of A stored as offsets C to the
+    // base column of their row
+    template <typename C, typename ValueType>
+    static void csrmv_compressed_col(int              blocksize,
+                                     int              warp,
+                                     int              nrow,
+                                     int64_t          nnz,
+                                     const PtrType*   row_offset,
+                                     const int*       col,
+                                     const int*       col_base,
+                                     const char*      col_off,
+                                     const ValueType* val,
+                                     ValueType        alpha,
+                                     const ValueType* x,
+                                     ValueType        beta,
+                                     ValueType*       y,
+                                     hipStream_t      stream)
+    {
+        const C* off             = reinterpret_cast<const C*>(col_off);
+        int64_t  avg_nnz_per_row = nnz / nrow;
 
-        return true;
+        if(avg_nnz_per_row <= 8)
+        {
+            csrmv_compressed_col_launch<1>(
+                blocksize, nrow, row_offset, col, col_base, off, val, alpha, x, beta, y, stream);
+        }
+        else if(avg_nnz_per_row <= 16)
+        {
+            csrmv_compressed_col_launch<2>(
+                blocksize, nrow, row_offset, col, col_base, off, val, alpha, x, beta, y, stream);
+        }
+        else if(avg_nnz_per_row <= 32)
+        {
+            csrmv_compressed_col_launch<4>(
+                blocksize, nrow, row_offset, col, col_base, off, val, alpha, x, beta, y, stream);
+        }
+        else if(avg_nnz_per_row <= 64)
+        {
+            csrmv_compressed_col_launch<8>(
+                blocksize, nrow, row_offset, col, col_base, off, val, alpha, x, beta, y, stream);
+        }
+        else if(avg_nnz_per_row <= 128)
+        {
+            csrmv_compressed_col_launch<16>(
+                blocksize, nrow, row_offset, col, col_base, off, val, alpha, x, beta, y, stream);
+        }
+        else if(avg_nnz_per_row <= 256 || warp == 32)
+        {
+            csrmv_compressed_col_launch<32>(
+                blocksize, nrow, row_offset, col, col_base, off, val, alpha, x, beta, y, stream);
+        }
+        else
+        {
+            csrmv_compressed_col_launch<64>(
+                blocksize, nrow, row_offset, col, col_base, off, val, alpha, x, beta, y, stream);
+        }
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::LLAnalyse(void)
+    bool HIPAcceleratorMatrixCSR<ValueType>::SpMVCompressed_(
+        ValueType                              alpha,
+        const HIPAcceleratorVector<ValueType>& in,
+        ValueType                              beta,
+        HIPAcceleratorVector<ValueType>*       out) const
     {
-        assert(this->ncol_ == this->nrow_);
-        assert(this->tmp_vec_ == NULL);
+        int         blocksize = this->local_backend_.HIP_block_size;
+        int         warp      = this->local_backend_.HIP_warp;
+        hipStream_t stream    = HIPSTREAM(this->local_backend_.HIP_stream_current);
 
-        this->tmp_vec_ = new HIPAcceleratorVector<ValueType>(this->local_backend_);
+        // The compressed indices are built on first use, they are released whenever the
+        // sparsity pattern changes
+        if(this->spmv_col_base_ == NULL)
+        {
+            int*                col_span = NULL;
+            unsigned long long* nnz_over = NULL;
 
-        assert(this->tmp_vec_ != NULL);
+            allocate_hip(this->nrow_, &this->spmv_col_base_);
+            allocate_hip(this->nrow_, &col_span);
+            allocate_hip(2, &nnz_over);
 
-        rocsparse_status status;
+            set_to_zero_hip(blocksize, 2, nnz_over, true, stream);
 
-        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            int nblocks = (this->nrow_ - 1) / blocksize + 1;
 
-        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            kernel_csr_column_base<<<nblocks, blocksize, 0, stream>>>(this->nrow_,
+                                                                      this->mat_.row_offset,
+                                                                      this->mat_.col,
+                                                                      this->spmv_col_base_,
+                                                                      col_span,
+                                                                      nnz_over);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            unsigned long long hnnz_over[2];
+            copy_d2h(2, nnz_over, hnnz_over, true, stream);
 
-        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            hipStreamSynchronize(stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_non_unit);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            free_hip(&nnz_over);
 
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
+            // Index traffic of 8 and 16 bit offsets, the rows whose span exceeds the offsets
+            // read their full column indices instead
+            int64_t nnz_over_8  = static_cast<int64_t>(hnnz_over[0]);
+            int64_t nnz_over_16 = static_cast<int64_t>(hnnz_over[1]);
 
-        // Create buffer, if not already available
-        size_t buffer_size_L  = 0;
-        size_t buffer_size_Lt = 0;
+            int64_t bytes_full = sizeof(int) * this->nnz_;
+            int64_t bytes_8    = (this->nnz_ - nnz_over_8) + sizeof(int) * nnz_over_8;
+            int64_t bytes_16   = 2 * (this->nnz_ - nnz_over_16) + sizeof(int) * nnz_over_16;
 
-        status
-            = rocsparseTcsrsv_buffer_size(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          &buffer_size_L);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            // The base columns are read once per row
+            bytes_8 += sizeof(int) * this->nrow_;
+            bytes_16 += sizeof(int) * this->nrow_;
 
-        status
-            = rocsparseTcsrsv_buffer_size(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_transpose,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          &buffer_size_Lt);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            this->spmv_col_width_ = (bytes_8 <= bytes_16) ? 1 : 2;
 
-        size_t buffer_size = std::max(buffer_size_L, buffer_size_Lt);
+            if(std::min(bytes_8, bytes_16) < bytes_full)
+            {
+                allocate_hip(this->nnz_ * this->spmv_col_width_, &this->spmv_col_off_);
 
-        // Buffer is shared with ILU0, IC0 and other solve functions
-        if(this->mat_buffer_ == NULL)
+                if(this->spmv_col_width_ == 1)
+                {
+                    kernel_csr_column_compress<<<nblocks, blocksize, 0, stream>>>(
+                        this->nrow_,
+                        this->mat_.row_offset,
+                        this->mat_.col,
+                        col_span,
+                        this->spmv_col_base_,
+                        reinterpret_cast<unsigned char*>(this->spmv_col_off_));
+                }
+                else
+                {
+                    kernel_csr_column_compress<<<nblocks, blocksize, 0, stream>>>(
+                        this->nrow_,
+                        this->mat_.row_offset,
+                        this->mat_.col,
+                        col_span,
+                        this->spmv_col_base_,
+                        reinterpret_cast<unsigned short*>(this->spmv_col_off_));
+                }
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+            }
+
+            free_hip(&col_span);
+        }
+
+        // The structure does not benefit from the compression
+        if(this->spmv_col_off_ == NULL)
         {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_hip(buffer_size, &this->mat_buffer_);
+            return false;
         }
-        else if(this->mat_buffer_size_ < buffer_size)
+
+        if(this->spmv_col_width_ == 1)
         {
-            this->mat_buffer_size_ = buffer_size;
-            free_hip(&this->mat_buffer_);
-            allocate_hip(buffer_size, &this->mat_buffer_);
+            csrmv_compressed_col<unsigned char>(blocksize,
+                                                warp,
+                                                this->nrow_,
+                                                this->nnz_,
+                                                this->mat_.row_offset,
+                                                this->mat_.col,
+                                                this->spmv_col_base_,
+                                                this->spmv_col_off_,
+                                                this->mat_.val,
+                                                alpha,
+                                                in.vec_,
+                                                beta,
+                                                out->vec_,
+                                                stream);
+        }
+        else
+        {
+            csrmv_compressed_col<unsigned short>(blocksize,
+                                                 warp,
+                                                 this->nrow_,
+                                                 this->nnz_,
+                                                 this->mat_.row_offset,
+                                                 this->mat_.col,
+                                                 this->spmv_col_base_,
+                                                 this->spmv_col_off_,
+                                                 this->mat_.val,
+                                                 alpha,
+                                                 in.vec_,
+                                                 beta,
+                                                 out->vec_,
+                                                 stream);
         }
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
+        return true;
+    }
 
-        // L part analysis
-        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          rocsparse_analysis_policy_reuse,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                                   BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
 
-        // L^T part analysis
-        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_transpose,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          rocsparse_analysis_policy_reuse,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
 
-        // Allocate temporary vector
-        this->tmp_vec_->Allocate(this->nrow_);
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == this->ncol_);
+            assert(cast_out->size_ == this->nrow_);
+
+            this->SpMV_(static_cast<ValueType>(1), *cast_in, static_cast<ValueType>(0), cast_out);
+        }
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::LLAnalyseClear(void)
+    void HIPAcceleratorMatrixCSR<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                                      ValueType                    scalar,
+                                                      BaseVector<ValueType>*       out) const
     {
-        rocsparse_status status;
-
-        // Clear analysis info
-        if(this->L_mat_descr_ != 0)
+        if(this->nnz_ > 0)
         {
-            status = rocsparse_csrsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                           this->L_mat_descr_,
-                                           this->mat_info_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
+            assert(out != NULL);
 
-        // Clear matrix descriptor
-        if(this->L_mat_descr_ != NULL)
-        {
-            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == this->ncol_);
+            assert(cast_out->size_ == this->nrow_);
+
+            this->SpMV_(scalar, *cast_in, static_cast<ValueType>(1), cast_out);
         }
+    }
 
-        this->L_mat_descr_ = 0;
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ApplyTranspose(const BaseVector<ValueType>& in,
+                                                            BaseVector<ValueType>*       out) const
+    {
+        return this->TransposeSpMV_(
+            static_cast<ValueType>(1), in, static_cast<ValueType>(0), out);
+    }
 
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ApplyTransposeAdd(const BaseVector<ValueType>& in,
+                                                               ValueType                    scalar,
+                                                               BaseVector<ValueType>* out) const
+    {
+        return this->TransposeSpMV_(scalar, in, static_cast<ValueType>(1), out);
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::TransposeSpMV_(ValueType                    alpha,
+                                                            const BaseVector<ValueType>& in,
+                                                            ValueType                    beta,
+                                                            BaseVector<ValueType>* out) const
+    {
+        assert(out != NULL);
+
+        const HIPAcceleratorVector<ValueType>* cast_in
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+        HIPAcceleratorVector<ValueType>* cast_out
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+        assert(cast_in->size_ == this->nrow_);
+        assert(cast_out->size_ == this->ncol_);
+
+        if(this->nnz_ == 0)
         {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            if(beta == static_cast<ValueType>(0))
+            {
+                cast_out->Zeros();
+            }
+
+            return true;
         }
 
-        this->mat_buffer_size_ = 0;
+        // csrmv requires 32 bit row offsets, fall back to the host otherwise
+        const int* row_offset = this->SpMVRowOffset_();
 
-        // Clear temporary vector
-        if(this->tmp_vec_ != NULL)
+        if(row_offset == NULL)
         {
-            delete this->tmp_vec_;
-            this->tmp_vec_ = NULL;
+            return false;
         }
+
+        // The csrmv analysis data only applies to the non-transposed product
+        rocsparse_status status;
+        status = rocsparseTcsrmv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                 rocsparse_operation_transpose,
+                                 this->nrow_,
+                                 this->ncol_,
+                                 this->nnz_,
+                                 &alpha,
+                                 this->mat_descr_,
+                                 this->mat_.val,
+                                 row_offset,
+                                 this->mat_.col,
+                                 NULL,
+                                 cast_in->vec_,
+                                 &beta,
+                                 cast_out->vec_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
-                                                     BaseVector<ValueType>*       out) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::ApplyAddSymmetric(const BaseVector<ValueType>& in,
+                                                               ValueType                    scalar,
+                                                               BaseVector<ValueType>* out) const
     {
         if(this->nnz_ > 0)
         {
+            assert(this->nrow_ == this->ncol_);
             assert(out != NULL);
-            assert(this->L_mat_descr_ != 0);
-            assert(this->mat_info_ != 0);
-            assert(this->ncol_ == this->nrow_);
-            assert(this->tmp_vec_ != NULL);
-            assert(this->mat_buffer_ != NULL);
 
             const HIPAcceleratorVector<ValueType>* cast_in
                 = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
@@ -2263,227 +3309,189 @@ namespace rocalution
             assert(cast_in->size_ == this->ncol_);
             assert(cast_out->size_ == this->nrow_);
 
-            rocsparse_status status;
-
-            ValueType alpha = static_cast<ValueType>(1);
+            dim3 BlockSize(256);
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+            // Short rows are processed by 8 threads, long rows by 32
+            if(this->nnz_ / this->nrow_ < 16)
+            {
+                dim3 GridSize((static_cast<int64_t>(this->nrow_) * 8 - 1) / 256 + 1);
 
-            // Solve L
-            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                     rocsparse_operation_none,
-                                     this->nrow_,
-                                     this->nnz_,
-                                     &alpha,
-                                     this->L_mat_descr_,
-                                     this->mat_.val,
-                                     this->mat_.row_offset,
-                                     this->mat_.col,
-                                     this->mat_info_,
-                                     cast_in->vec_,
-                                     this->tmp_vec_->vec_,
-                                     rocsparse_solve_policy_auto,
-                                     this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+                kernel_csr_symmetric_spmv<256, 8>
+                    <<<GridSize, BlockSize, 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                        this->nrow_,
+                        this->mat_.row_offset,
+                        this->mat_.col,
+                        this->mat_.val,
+                        scalar,
+                        cast_in->vec_,
+                        cast_out->vec_);
+            }
+            else
+            {
+                dim3 GridSize((static_cast<int64_t>(this->nrow_) * 32 - 1) / 256 + 1);
 
-            // Solve L^T
-            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                     rocsparse_operation_transpose,
-                                     this->nrow_,
-                                     this->nnz_,
-                                     &alpha,
-                                     this->L_mat_descr_,
-                                     this->mat_.val,
-                                     this->mat_.row_offset,
-                                     this->mat_.col,
-                                     this->mat_info_,
-                                     this->tmp_vec_->vec_,
-                                     cast_out->vec_,
-                                     rocsparse_solve_policy_auto,
-                                     this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+                kernel_csr_symmetric_spmv<256, 32>
+                    <<<GridSize, BlockSize, 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                        this->nrow_,
+                        this->mat_.row_offset,
+                        this->mat_.col,
+                        this->mat_.val,
+                        scalar,
+                        cast_in->vec_,
+                        cast_out->vec_);
+            }
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
         }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
-                                                     const BaseVector<ValueType>& inv_diag,
-                                                     BaseVector<ValueType>*       out) const
-    {
-        return LLSolve(in, out);
-    }
-
-    template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::ItLLAnalyse(void)
+    void HIPAcceleratorMatrixCSR<ValueType>::SpMM_(int                                    ncol,
+                                                   ValueType                              alpha,
+                                                   const HIPAcceleratorVector<ValueType>& in,
+                                                   ValueType                              beta,
+                                                   HIPAcceleratorVector<ValueType>* out) const
     {
-        assert(this->ncol_ == this->nrow_);
-        assert(this->tmp_vec_ == NULL);
-
-        this->tmp_vec_ = new HIPAcceleratorVector<ValueType>(this->local_backend_);
+        rocsparse_handle handle = ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle);
 
-        assert(this->tmp_vec_ != NULL);
+        rocsparse_spmat_descr matA;
+        rocsparse_dnmat_descr matB;
+        rocsparse_dnmat_descr matC;
 
         rocsparse_status status;
 
-        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
+        status = rocsparse_create_csr_descr(&matA,
+                                            this->nrow_,
+                                            this->ncol_,
+                                            this->nnz_,
+                                            this->mat_.row_offset,
+                                            this->mat_.col,
+                                            this->mat_.val,
+                                            rocsparseTindextype<PtrType>(),
+                                            rocsparse_indextype_i32,
+                                            rocsparse_index_base_zero,
+                                            rocsparseTdatatype<ValueType>());
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
+        status = rocsparse_create_dnmat_descr(&matB,
+                                              this->ncol_,
+                                              ncol,
+                                              this->ncol_,
+                                              in.vec_,
+                                              rocsparseTdatatype<ValueType>(),
+                                              rocsparse_order_column);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
+        status = rocsparse_create_dnmat_descr(&matC,
+                                              this->nrow_,
+                                              ncol,
+                                              this->nrow_,
+                                              out->vec_,
+                                              rocsparseTdatatype<ValueType>(),
+                                              rocsparse_order_column);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        size_t buffer_size = 0;
 
-        status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_non_unit);
+        status = rocsparse_spmm(handle,
+                                rocsparse_operation_none,
+                                rocsparse_operation_none,
+                                &alpha,
+                                matA,
+                                matB,
+                                &beta,
+                                matC,
+                                rocsparseTdatatype<ValueType>(),
+                                rocsparse_spmm_alg_default,
+                                rocsparse_spmm_stage_buffer_size,
+                                &buffer_size,
+                                NULL);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
-
-        // Create buffer, if not already available
-        size_t buffer_size_L  = 0;
-        size_t buffer_size_Lt = 0;
+        char* buffer = NULL;
+        allocate_hip(buffer_size, &buffer);
 
-        status = rocsparseTcsritsv_buffer_size(
-            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-            rocsparse_operation_none,
-            this->nrow_,
-            this->nnz_,
-            this->L_mat_descr_,
-            this->mat_.val,
-            this->mat_.row_offset,
-            this->mat_.col,
-            this->mat_info_itsv_,
-            &buffer_size_L);
+        status = rocsparse_spmm(handle,
+                                rocsparse_operation_none,
+                                rocsparse_operation_none,
+                                &alpha,
+                                matA,
+                                matB,
+                                &beta,
+                                matC,
+                                rocsparseTdatatype<ValueType>(),
+                                rocsparse_spmm_alg_default,
+                                rocsparse_spmm_stage_preprocess,
+                                &buffer_size,
+                                buffer);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        status = rocsparseTcsritsv_buffer_size(
-            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-            rocsparse_operation_transpose,
-            this->nrow_,
-            this->nnz_,
-            this->L_mat_descr_,
-            this->mat_.val,
-            this->mat_.row_offset,
-            this->mat_.col,
-            this->mat_info_itsv_,
-            &buffer_size_Lt);
+        status = rocsparse_spmm(handle,
+                                rocsparse_operation_none,
+                                rocsparse_operation_none,
+                                &alpha,
+                                matA,
+                                matB,
+                                &beta,
+                                matC,
+                                rocsparseTdatatype<ValueType>(),
+                                rocsparse_spmm_alg_default,
+                                rocsparse_spmm_stage_compute,
+                                &buffer_size,
+                                buffer);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        size_t buffer_size = std::max(buffer_size_L, buffer_size_Lt);
-
-        // Check buffer size
-        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
-        {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
-        }
-
-        if(this->mat_buffer_ == NULL)
-        {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_hip(buffer_size, &this->mat_buffer_);
-        }
-
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
+        free_hip(&buffer);
 
-        // L part analysis
-        status
-            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                         rocsparse_operation_none,
-                                         this->nrow_,
-                                         this->nnz_,
-                                         this->L_mat_descr_,
-                                         this->mat_.val,
-                                         this->mat_.row_offset,
-                                         this->mat_.col,
-                                         this->mat_info_itsv_,
-                                         rocsparse_analysis_policy_reuse,
-                                         rocsparse_solve_policy_auto,
-                                         this->mat_buffer_);
+        status = rocsparse_destroy_spmat_descr(matA);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        // L^T part analysis
-        status
-            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                         rocsparse_operation_transpose,
-                                         this->nrow_,
-                                         this->nnz_,
-                                         this->L_mat_descr_,
-                                         this->mat_.val,
-                                         this->mat_.row_offset,
-                                         this->mat_.col,
-                                         this->mat_info_itsv_,
-                                         rocsparse_analysis_policy_reuse,
-                                         rocsparse_solve_policy_auto,
-                                         this->mat_buffer_);
+        status = rocsparse_destroy_dnmat_descr(matB);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        // Allocate temporary vector
-        this->tmp_vec_->Allocate(this->nrow_);
+        status = rocsparse_destroy_dnmat_descr(matC);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::ItLLAnalyseClear(void)
+    bool HIPAcceleratorMatrixCSR<ValueType>::ApplyMulti(int                          ncol,
+                                                        const BaseVector<ValueType>& in,
+                                                        BaseVector<ValueType>*       out) const
     {
-        rocsparse_status status;
-
-        // Clear analysis info
-        if(this->L_mat_descr_ != 0)
+        if(this->nnz_ > 0 && ncol > 0)
         {
-            status
-                = rocsparse_csritsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          this->L_mat_descr_,
-                                          this->mat_info_itsv_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
+            assert(out != NULL);
 
-        // Clear matrix descriptor
-        if(this->L_mat_descr_ != NULL)
-        {
-            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
 
-        this->L_mat_descr_ = 0;
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == static_cast<int64_t>(this->ncol_) * ncol);
+            assert(cast_out->size_ == static_cast<int64_t>(this->nrow_) * ncol);
 
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
-        {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            this->SpMM_(ncol,
+                        static_cast<ValueType>(1),
+                        *cast_in,
+                        static_cast<ValueType>(0),
+                        cast_out);
         }
 
-        this->mat_buffer_size_ = 0;
-
-        // Clear temporary vector
-        if(this->tmp_vec_ != NULL)
-        {
-            delete this->tmp_vec_;
-            this->tmp_vec_ = NULL;
-        }
+        return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ItLLSolve(int                          max_iter,
-                                                       double                       tolerance,
-                                                       bool                         use_tol,
-                                                       const BaseVector<ValueType>& in,
-                                                       BaseVector<ValueType>*       out) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::ApplyAddMulti(int                          ncol,
+                                                           const BaseVector<ValueType>& in,
+                                                           ValueType                    scalar,
+                                                           BaseVector<ValueType>*       out) const
     {
-        if(this->nnz_ > 0)
+        if(this->nnz_ > 0 && ncol > 0)
         {
             assert(out != NULL);
-            assert(this->L_mat_descr_ != 0);
-            assert(this->mat_info_itsv_ != 0);
-            assert(this->ncol_ == this->nrow_);
-            assert(this->tmp_vec_ != NULL);
-            assert(this->mat_buffer_ != NULL);
 
             const HIPAcceleratorVector<ValueType>* cast_in
                 = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
@@ -2492,828 +3500,4883 @@ namespace rocalution
 
             assert(cast_in != NULL);
             assert(cast_out != NULL);
-            assert(cast_in->size_ == this->ncol_);
-            assert(cast_out->size_ == this->nrow_);
+            assert(cast_in->size_ == static_cast<int64_t>(this->ncol_) * ncol);
+            assert(cast_out->size_ == static_cast<int64_t>(this->nrow_) * ncol);
 
-            rocsparse_status status;
-
-            const ValueType                   alpha = static_cast<ValueType>(1);
-            const numeric_traits_t<ValueType> temp_tol
-                = static_cast<numeric_traits_t<ValueType>>(tolerance);
-
-            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
-
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
-
-            // Solve L
-            status
-                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          &max_iter,
-                                          tol_ptr,
-                                          nullptr,
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          &alpha,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_itsv_,
-                                          cast_in->vec_,
-                                          this->tmp_vec_->vec_,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-
-            // Solve L^T
-            status
-                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          &max_iter,
-                                          tol_ptr,
-                                          nullptr,
-                                          rocsparse_operation_transpose,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          &alpha,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_itsv_,
-                                          this->tmp_vec_->vec_,
-                                          cast_out->vec_,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            this->SpMM_(ncol, scalar, *cast_in, static_cast<ValueType>(1), cast_out);
         }
 
         return true;
     }
 
-    template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ItLLSolve(int                          max_iter,
-                                                       double                       tolerance,
-                                                       bool                         use_tol,
-                                                       const BaseVector<ValueType>& in,
-                                                       const BaseVector<ValueType>& inv_diag,
-                                                       BaseVector<ValueType>*       out) const
+    template <unsigned int WFSIZE, typename ValueType>
+    static void csrmv_rows_launch(int              blocksize,
+                                  int              nrows,
+                                  const int*       rows,
+                                  const PtrType*   row_offset,
+                                  const int*       col,
+                                  const ValueType* val,
+                                  ValueType        alpha,
+                                  const ValueType* x,
+                                  ValueType        beta,
+                                  const ValueType* z,
+                                  ValueType*       y,
+                                  hipStream_t      stream)
     {
-        return ItLLSolve(max_iter, tolerance, use_tol, in, out);
+        dim3 BlockSize(blocksize);
+        dim3 GridSize((static_cast<int64_t>(nrows) * WFSIZE - 1) / blocksize + 1);
+
+        kernel_csrmv_rows<WFSIZE><<<GridSize, BlockSize, 0, stream>>>(
+            nrows, rows, row_offset, col, val, alpha, x, beta, z, y);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
     }
 
+    // y = alpha * A * x + beta * z for the listed rows of A, the wavefront size per row
+    // is chosen from the average row length of A
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::LAnalyse(bool diag_unit)
+    static void csrmv_rows(int              blocksize,
+                           int              warp,
+                           int              nrow,
+                           int64_t          nnz,
+                           int              nrows,
+                           const int*       rows,
+                           const PtrType*   row_offset,
+                           const int*       col,
+                           const ValueType* val,
+                           ValueType        alpha,
+                           const ValueType* x,
+                           ValueType        beta,
+                           const ValueType* z,
+                           ValueType*       y,
+                           hipStream_t      stream)
     {
-        rocsparse_status status;
-
-        // L part
-        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-
-        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-
-        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        if(nrows == 0)
+        {
+            return;
+        }
 
-        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        int64_t avg_nnz_per_row = nnz / nrow;
 
-        if(diag_unit == true)
+        if(avg_nnz_per_row <= 8)
         {
-            status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_unit);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            csrmv_rows_launch<1>(
+                blocksize, nrows, rows, row_offset, col, val, alpha, x, beta, z, y, stream);
         }
-        else
+        else if(avg_nnz_per_row <= 16)
         {
-            status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_non_unit);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            csrmv_rows_launch<2>(
+                blocksize, nrows, rows, row_offset, col, val, alpha, x, beta, z, y, stream);
         }
-
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
-
-        // Create buffer, if not already available
-        size_t buffer_size = 0;
-        status
-            = rocsparseTcsrsv_buffer_size(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          &buffer_size);
-
-        // Buffer is shared with ILU0 and other solve functions
-        if(this->mat_buffer_ == NULL)
+        else if(avg_nnz_per_row <= 32)
         {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_hip(buffer_size, &this->mat_buffer_);
+            csrmv_rows_launch<4>(
+                blocksize, nrows, rows, row_offset, col, val, alpha, x, beta, z, y, stream);
+        }
+        else if(avg_nnz_per_row <= 64)
+        {
+            csrmv_rows_launch<8>(
+                blocksize, nrows, rows, row_offset, col, val, alpha, x, beta, z, y, stream);
+        }
+        else if(avg_nnz_per_row <= 128)
+        {
+            csrmv_rows_launch<16>(
+                blocksize, nrows, rows, row_offset, col, val, alpha, x, beta, z, y, stream);
         }
+        else if(avg_nnz_per_row <= 256 || warp == 32)
+        {
+            csrmv_rows_launch<32>(
+                blocksize, nrows, rows, row_offset, col, val, alpha, x, beta, z, y, stream);
+        }
+        else
+        {
+            csrmv_rows_launch<64>(
+                blocksize, nrows, rows, row_offset, col, val, alpha, x, beta, z, y, stream);
+        }
+    }
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ApplyRows(const BaseVector<ValueType>& in,
+                                                       const BaseVector<int>&       rows,
+                                                       BaseVector<ValueType>*       out) const
+    {
+        assert(out != NULL);
+
+        const HIPAcceleratorVector<ValueType>* cast_in
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+        const HIPAcceleratorVector<int>* cast_rows
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(&rows);
+        HIPAcceleratorVector<ValueType>* cast_out
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_rows != NULL);
+        assert(cast_out != NULL);
+        assert(cast_in->size_ == this->ncol_);
+        assert(cast_out->size_ == this->nrow_);
+
+        csrmv_rows(this->local_backend_.HIP_block_size,
+                   this->local_backend_.HIP_warp,
+                   this->nrow_,
+                   this->nnz_,
+                   static_cast<int>(cast_rows->size_),
+                   cast_rows->vec_,
+                   this->mat_.row_offset,
+                   this->mat_.col,
+                   this->mat_.val,
+                   static_cast<ValueType>(1),
+                   cast_in->vec_,
+                   static_cast<ValueType>(0),
+                   cast_out->vec_,
+                   cast_out->vec_,
+                   HIPSTREAM(this->local_backend_.HIP_stream_current));
 
-        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          rocsparse_analysis_policy_reuse,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        return true;
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::UAnalyse(bool diag_unit)
+    bool HIPAcceleratorMatrixCSR<ValueType>::ApplyAddRows(const BaseVector<ValueType>& in,
+                                                          const BaseVector<int>&       rows,
+                                                          ValueType                    scalar,
+                                                          BaseVector<ValueType>*       out) const
     {
-        rocsparse_status status;
+        assert(out != NULL);
+
+        const HIPAcceleratorVector<ValueType>* cast_in
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+        const HIPAcceleratorVector<int>* cast_rows
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(&rows);
+        HIPAcceleratorVector<ValueType>* cast_out
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_rows != NULL);
+        assert(cast_out != NULL);
+        assert(cast_in->size_ == this->ncol_);
+        assert(cast_out->size_ == this->nrow_);
+
+        csrmv_rows(this->local_backend_.HIP_block_size,
+                   this->local_backend_.HIP_warp,
+                   this->nrow_,
+                   this->nnz_,
+                   static_cast<int>(cast_rows->size_),
+                   cast_rows->vec_,
+                   this->mat_.row_offset,
+                   this->mat_.col,
+                   this->mat_.val,
+                   scalar,
+                   cast_in->vec_,
+                   static_cast<ValueType>(1),
+                   cast_out->vec_,
+                   cast_out->vec_,
+                   HIPSTREAM(this->local_backend_.HIP_stream_current));
 
-        // U part
-        status = rocsparse_create_mat_descr(&this->U_mat_descr_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        return true;
+    }
 
-        status = rocsparse_set_mat_type(this->U_mat_descr_, rocsparse_matrix_type_general);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ResidualRows(const BaseVector<ValueType>& rhs,
+                                                          const BaseVector<ValueType>& x,
+                                                          const BaseVector<int>&       rows,
+                                                          BaseVector<ValueType>*       res) const
+    {
+        assert(res != NULL);
+
+        const HIPAcceleratorVector<ValueType>* cast_rhs
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&rhs);
+        const HIPAcceleratorVector<ValueType>* cast_x
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&x);
+        const HIPAcceleratorVector<int>* cast_rows
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(&rows);
+        HIPAcceleratorVector<ValueType>* cast_res
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(res);
+
+        assert(cast_rhs != NULL);
+        assert(cast_x != NULL);
+        assert(cast_rows != NULL);
+        assert(cast_res != NULL);
+        assert(cast_rhs->size_ == this->nrow_);
+        assert(cast_x->size_ == this->ncol_);
+        assert(cast_res->size_ == this->nrow_);
+
+        // Product and subtraction are fused, such that A*x is never stored
+        csrmv_rows(this->local_backend_.HIP_block_size,
+                   this->local_backend_.HIP_warp,
+                   this->nrow_,
+                   this->nnz_,
+                   static_cast<int>(cast_rows->size_),
+                   cast_rows->vec_,
+                   this->mat_.row_offset,
+                   this->mat_.col,
+                   this->mat_.val,
+                   static_cast<ValueType>(-1),
+                   cast_x->vec_,
+                   static_cast<ValueType>(1),
+                   cast_rhs->vec_,
+                   cast_res->vec_,
+                   HIPSTREAM(this->local_backend_.HIP_stream_current));
 
-        status = rocsparse_set_mat_index_base(this->U_mat_descr_, rocsparse_index_base_zero);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        return true;
+    }
 
-        status = rocsparse_set_mat_fill_mode(this->U_mat_descr_, rocsparse_fill_mode_upper);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::BatchApply(int                          batch,
+                                                        const BaseVector<ValueType>& val,
+                                                        const BaseVector<ValueType>& in,
+                                                        BaseVector<ValueType>*       out) const
+    {
+        assert(batch >= 0);
+        assert(this->nrow_ == this->ncol_);
 
-        if(diag_unit == true)
-        {
-            status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_unit);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
-        else
+        int64_t size = static_cast<int64_t>(this->nrow_) * batch;
+
+        if(size > 0)
         {
-            status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_non_unit);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
+            assert(out != NULL);
 
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
+            const HIPAcceleratorVector<ValueType>* cast_val
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&val);
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
 
-        // Create buffer, if not already available
-        size_t buffer_size = 0;
-        status
-            = rocsparseTcsrsv_buffer_size(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->U_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          &buffer_size);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            assert(cast_val != NULL);
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_val->size_ == this->nnz_ * batch);
+            assert(cast_in->size_ == size);
+            assert(cast_out->size_ == size);
 
-        // Buffer is shared with ILU0 and other solve functions
-        if(this->mat_buffer_ == NULL)
-        {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_hip(buffer_size, &this->mat_buffer_);
-        }
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize((size - 1) / this->local_backend_.HIP_block_size + 1);
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
+            kernel_batch_csr_spmv<<<GridSize,
+                                    BlockSize,
+                                    0,
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                size,
+                this->nrow_,
+                this->nnz_,
+                this->mat_.row_offset,
+                this->mat_.col,
+                cast_val->vec_,
+                cast_in->vec_,
+                cast_out->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
 
-        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          this->U_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_,
-                                          rocsparse_analysis_policy_reuse,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        return true;
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::LAnalyseClear(void)
+    bool HIPAcceleratorMatrixCSR<ValueType>::BatchExtractInverseDiagonal(
+        int batch, const BaseVector<ValueType>& val, BaseVector<ValueType>* inv_diag) const
     {
-        rocsparse_status status;
+        assert(batch >= 0);
+        assert(this->nrow_ == this->ncol_);
 
-        // Clear analysis info
-        if(this->L_mat_descr_ != NULL)
-        {
-            status = rocsparse_csrsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                           this->L_mat_descr_,
-                                           this->mat_info_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
+        int64_t size = static_cast<int64_t>(this->nrow_) * batch;
 
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
+        if(size > 0)
         {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
-        }
+            assert(inv_diag != NULL);
 
-        this->mat_buffer_size_ = 0;
+            const HIPAcceleratorVector<ValueType>* cast_val
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&val);
+            HIPAcceleratorVector<ValueType>* cast_inv
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(inv_diag);
 
-        // Clear matrix descriptor
-        if(this->L_mat_descr_ != NULL)
-        {
-            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
+            assert(cast_val != NULL);
+            assert(cast_inv != NULL);
+            assert(cast_val->size_ == this->nnz_ * batch);
+            assert(cast_inv->size_ == size);
 
-        this->L_mat_descr_ = 0;
-    }
+            PtrType* diag = NULL;
 
-    template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::UAnalyseClear(void)
-    {
-        rocsparse_status status;
+            if(this->BatchDiagOffset_(&diag) == false)
+            {
+                return false;
+            }
 
-        // Clear analysis info
-        if(this->U_mat_descr_ != NULL)
-        {
-            status = rocsparse_csrsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                           this->U_mat_descr_,
-                                           this->mat_info_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
+            int* d_detect_zero_diag = NULL;
+            allocate_hip(1, &d_detect_zero_diag);
+            set_to_zero_hip(1, 1, d_detect_zero_diag);
 
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
-        {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
-        }
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize((size - 1) / this->local_backend_.HIP_block_size + 1);
+
+            kernel_batch_csr_extract_inv_diag<<<GridSize,
+                                                BlockSize,
+                                                0,
+                                                HIPSTREAM(
+                                                    this->local_backend_.HIP_stream_current)>>>(
+                size,
+                this->nrow_,
+                this->nnz_,
+                diag,
+                cast_val->vec_,
+                cast_inv->vec_,
+                d_detect_zero_diag);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        this->mat_buffer_size_ = 0;
+            int detect_zero_diag = 0;
+            copy_d2h(1, d_detect_zero_diag, &detect_zero_diag);
 
-        // Clear matrix descriptor
-        if(this->U_mat_descr_ != NULL)
-        {
-            status = rocsparse_destroy_mat_descr(this->U_mat_descr_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            if(detect_zero_diag == 1)
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: in HIPAcceleratorMatrixCSR::"
+                                 "BatchExtractInverseDiagonal() a zero has been detected on the "
+                                 "diagonal. It has been replaced with one to avoid inf");
+            }
+
+            free_hip(&d_detect_zero_diag);
+            free_hip(&diag);
         }
 
-        this->U_mat_descr_ = 0;
+        return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::LSolve(const BaseVector<ValueType>& in,
-                                                    BaseVector<ValueType>*       out) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::BatchILU0Factorize(int                    batch,
+                                                                BaseVector<ValueType>* val) const
     {
-        if(this->nnz_ > 0)
+        assert(batch >= 0);
+        assert(this->nrow_ == this->ncol_);
+
+        if(batch > 0 && this->nnz_ > 0)
         {
-            assert(out != NULL);
-            assert(this->L_mat_descr_ != 0);
-            assert(this->mat_info_ != 0);
-            assert(this->ncol_ == this->nrow_);
-            assert(this->mat_buffer_size_ > 0);
-            assert(this->mat_buffer_ != NULL);
+            assert(val != NULL);
 
-            const HIPAcceleratorVector<ValueType>* cast_in
-                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
-            HIPAcceleratorVector<ValueType>* cast_out
-                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+            HIPAcceleratorVector<ValueType>* cast_val
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(val);
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
-            assert(cast_in->size_ == this->ncol_);
-            assert(cast_out->size_ == this->nrow_);
+            assert(cast_val != NULL);
+            assert(cast_val->size_ == this->nnz_ * batch);
 
-            rocsparse_status status;
+            PtrType* diag = NULL;
 
-            ValueType alpha = static_cast<ValueType>(1);
+            if(this->BatchDiagOffset_(&diag) == false)
+            {
+                return false;
+            }
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+            kernel_batch_csr_ilu0<64><<<batch,
+                                        64,
+                                        0,
+                                        HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_,
+                this->nnz_,
+                this->mat_.row_offset,
+                this->mat_.col,
+                diag,
+                cast_val->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            // Solve L
-            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                     rocsparse_operation_none,
-                                     this->nrow_,
-                                     this->nnz_,
-                                     &alpha,
-                                     this->L_mat_descr_,
-                                     this->mat_.val,
-                                     this->mat_.row_offset,
-                                     this->mat_.col,
-                                     this->mat_info_,
-                                     cast_in->vec_,
-                                     cast_out->vec_,
-                                     rocsparse_solve_policy_auto,
-                                     this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            free_hip(&diag);
         }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::USolve(const BaseVector<ValueType>& in,
-                                                    BaseVector<ValueType>*       out) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::BatchBiCGStab(int                          batch,
+                                                           const BaseVector<ValueType>& val,
+                                                           const BaseVector<ValueType>* inv_diag,
+                                                           const BaseVector<ValueType>* lu,
+                                                           const BaseVector<ValueType>& rhs,
+                                                           BaseVector<ValueType>*       x,
+                                                           double                       abs_tol,
+                                                           double                       rel_tol,
+                                                           int                          max_iter,
+                                                           int*                         iter,
+                                                           double*                      res) const
     {
-        if(this->nnz_ > 0)
-        {
-            assert(out != NULL);
-            assert(this->U_mat_descr_ != 0);
-            assert(this->mat_info_ != 0);
-            assert(this->ncol_ == this->nrow_);
-            assert(this->mat_buffer_size_ > 0);
-            assert(this->mat_buffer_ != NULL);
+        return this->BatchSolve_(
+            batch, 0, val, inv_diag, lu, rhs, x, abs_tol, rel_tol, max_iter, iter, res);
+    }
 
-            const HIPAcceleratorVector<ValueType>* cast_in
-                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
-            HIPAcceleratorVector<ValueType>* cast_out
-                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::BatchGMRES(int                          batch,
+                                                        int                          basis,
+                                                        const BaseVector<ValueType>& val,
+                                                        const BaseVector<ValueType>* inv_diag,
+                                                        const BaseVector<ValueType>* lu,
+                                                        const BaseVector<ValueType>& rhs,
+                                                        BaseVector<ValueType>*       x,
+                                                        double                       abs_tol,
+                                                        double                       rel_tol,
+                                                        int                          max_iter,
+                                                        int*                         iter,
+                                                        double*                      res) const
+    {
+        assert(basis > 0);
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
-            assert(cast_in->size_ == this->ncol_);
-            assert(cast_out->size_ == this->nrow_);
+        return this->BatchSolve_(
+            batch, basis, val, inv_diag, lu, rhs, x, abs_tol, rel_tol, max_iter, iter, res);
+    }
 
-            rocsparse_status status;
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::BatchDiagOffset_(PtrType** diag) const
+    {
+        assert(diag != NULL);
+        assert(*diag == NULL);
 
-            ValueType alpha = static_cast<ValueType>(1);
+        allocate_hip(this->nrow_, diag);
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+        int* d_missing = NULL;
+        allocate_hip(1, &d_missing);
+        set_to_zero_hip(1, 1, d_missing);
 
-            // Solve U
-            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                     rocsparse_operation_none,
-                                     this->nrow_,
-                                     this->nnz_,
-                                     &alpha,
-                                     this->U_mat_descr_,
-                                     this->mat_.val,
-                                     this->mat_.row_offset,
-                                     this->mat_.col,
-                                     this->mat_info_,
-                                     cast_in->vec_,
-                                     cast_out->vec_,
-                                     rocsparse_solve_policy_auto,
-                                     this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize((this->nrow_ - 1) / this->local_backend_.HIP_block_size + 1);
+
+        kernel_batch_csr_diag_offset<<<GridSize,
+                                       BlockSize,
+                                       0,
+                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_, this->mat_.row_offset, this->mat_.col, *diag, d_missing);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        int missing = 0;
+        copy_d2h(1, d_missing, &missing);
+
+        free_hip(&d_missing);
+
+        if(missing == 1)
+        {
+            free_hip(diag);
+            return false;
         }
 
         return true;
     }
 
+    // Launch the fused batched solver with one thread block of size BLOCKSIZE per system
+    template <unsigned int BLOCKSIZE, unsigned int WFSIZE, typename ValueType>
+    static void batch_solve_launch(int              batch,
+                                   int              basis,
+                                   int              nrow,
+                                   int64_t          nnz,
+                                   const PtrType*   row_offset,
+                                   const int*       col,
+                                   const PtrType*   diag,
+                                   const ValueType* val,
+                                   const ValueType* inv_diag,
+                                   const ValueType* lu,
+                                   const ValueType* rhs,
+                                   ValueType*       x,
+                                   ValueType*       work,
+                                   double           abs_tol,
+                                   double           rel_tol,
+                                   int              max_iter,
+                                   int*             iter,
+                                   double*          res,
+                                   hipStream_t      stream)
+    {
+        if(basis == 0)
+        {
+            kernel_batch_csr_bicgstab<BLOCKSIZE, WFSIZE><<<batch, BLOCKSIZE, 0, stream>>>(nrow,
+                                                                                        nnz,
+                                                                                        row_offset,
+                                                                                        col,
+                                                                                        diag,
+                                                                                        val,
+                                                                                        inv_diag,
+                                                                                        lu,
+                                                                                        rhs,
+                                                                                        x,
+                                                                                        work,
+                                                                                        abs_tol,
+                                                                                        rel_tol,
+                                                                                        max_iter,
+                                                                                        iter,
+                                                                                        res);
+        }
+        else
+        {
+            kernel_batch_csr_gmres<BLOCKSIZE, WFSIZE><<<batch, BLOCKSIZE, 0, stream>>>(nrow,
+                                                                                     basis,
+                                                                                     nnz,
+                                                                                     row_offset,
+                                                                                     col,
+                                                                                     diag,
+                                                                                     val,
+                                                                                     inv_diag,
+                                                                                     lu,
+                                                                                     rhs,
+                                                                                     x,
+                                                                                     work,
+                                                                                     abs_tol,
+                                                                                     rel_tol,
+                                                                                     max_iter,
+                                                                                     iter,
+                                                                                     res);
+        }
+    }
+
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::ItLAnalyse(bool diag_unit)
+    bool HIPAcceleratorMatrixCSR<ValueType>::BatchSolve_(int                          batch,
+                                                         int                          basis,
+                                                         const BaseVector<ValueType>& val,
+                                                         const BaseVector<ValueType>* inv_diag,
+                                                         const BaseVector<ValueType>* lu,
+                                                         const BaseVector<ValueType>& rhs,
+                                                         BaseVector<ValueType>*       x,
+                                                         double                       abs_tol,
+                                                         double                       rel_tol,
+                                                         int                          max_iter,
+                                                         int*                         iter,
+                                                         double*                      res) const
     {
-        rocsparse_status status;
+        assert(batch >= 0);
+        assert(this->nrow_ == this->ncol_);
+        assert(iter != NULL);
+        assert(res != NULL);
 
-        // L part
-        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        if(batch == 0 || this->nrow_ == 0)
+        {
+            for(int k = 0; k < batch; ++k)
+            {
+                iter[k] = 0;
+                res[k]  = 0.0;
+            }
 
-        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            return true;
+        }
 
-        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        assert(x != NULL);
 
-        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        const HIPAcceleratorVector<ValueType>* cast_val
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&val);
+        const HIPAcceleratorVector<ValueType>* cast_rhs
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&rhs);
+        HIPAcceleratorVector<ValueType>* cast_x
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(x);
 
-        if(diag_unit == true)
+        assert(cast_val != NULL);
+        assert(cast_rhs != NULL);
+        assert(cast_x != NULL);
+        assert(cast_val->size_ == this->nnz_ * batch);
+        assert(cast_rhs->size_ == static_cast<int64_t>(this->nrow_) * batch);
+        assert(cast_x->size_ == static_cast<int64_t>(this->nrow_) * batch);
+
+        const ValueType* d_inv_diag = NULL;
+        const ValueType* d_lu       = NULL;
+
+        PtrType* diag = NULL;
+
+        if(inv_diag != NULL)
         {
-            status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_unit);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            const HIPAcceleratorVector<ValueType>* cast_inv
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(inv_diag);
+
+            assert(cast_inv != NULL);
+            assert(cast_inv->size_ == static_cast<int64_t>(this->nrow_) * batch);
+
+            d_inv_diag = cast_inv->vec_;
         }
-        else
+        else if(lu != NULL)
         {
-            status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_non_unit);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            const HIPAcceleratorVector<ValueType>* cast_lu
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(lu);
+
+            assert(cast_lu != NULL);
+            assert(cast_lu->size_ == this->nnz_ * batch);
+
+            d_lu = cast_lu->vec_;
+
+            if(this->BatchDiagOffset_(&diag) == false)
+            {
+                return false;
+            }
         }
 
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
+        // Workspace of all systems, see kernel_batch_csr_bicgstab() and
+        // kernel_batch_csr_gmres()
+        int64_t n     = this->nrow_;
+        int64_t wsize = (basis == 0) ? 7 * n
+                                     : (basis + 2) * n + (basis + 1) * basis + 3 * basis + 1;
 
-        // Create buffer, if not already available
-        size_t buffer_size = 0;
-        status             = rocsparseTcsritsv_buffer_size(
-            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-            rocsparse_operation_none,
-            this->nrow_,
-            this->nnz_,
-            this->L_mat_descr_,
-            this->mat_.val,
-            this->mat_.row_offset,
-            this->mat_.col,
-            this->mat_info_itsv_,
-            &buffer_size);
+        ValueType* work   = NULL;
+        int*       d_iter = NULL;
+        double*    d_res  = NULL;
 
-        // Check buffer size
-        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        allocate_hip(wsize * batch, &work);
+        allocate_hip(batch, &d_iter);
+        allocate_hip(batch, &d_res);
+
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
+
+        // Small systems do not occupy more than a single wavefront
+        bool small = (this->nrow_ <= 64);
+
+        if(this->local_backend_.HIP_warp == 32)
         {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            if(small)
+            {
+                batch_solve_launch<64, 32>(batch,
+                                           basis,
+                                           this->nrow_,
+                                           this->nnz_,
+                                           this->mat_.row_offset,
+                                           this->mat_.col,
+                                           diag,
+                                           cast_val->vec_,
+                                           d_inv_diag,
+                                           d_lu,
+                                           cast_rhs->vec_,
+                                           cast_x->vec_,
+                                           work,
+                                           abs_tol,
+                                           rel_tol,
+                                           max_iter,
+                                           d_iter,
+                                           d_res,
+                                           stream);
+            }
+            else
+            {
+                batch_solve_launch<256, 32>(batch,
+                                            basis,
+                                            this->nrow_,
+                                            this->nnz_,
+                                            this->mat_.row_offset,
+                                            this->mat_.col,
+                                            diag,
+                                            cast_val->vec_,
+                                            d_inv_diag,
+                                            d_lu,
+                                            cast_rhs->vec_,
+                                            cast_x->vec_,
+                                            work,
+                                            abs_tol,
+                                            rel_tol,
+                                            max_iter,
+                                            d_iter,
+                                            d_res,
+                                            stream);
+            }
         }
-
-        if(this->mat_buffer_ == NULL)
+        else if(this->local_backend_.HIP_warp == 64)
         {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_hip(buffer_size, &this->mat_buffer_);
+            if(small)
+            {
+                batch_solve_launch<64, 64>(batch,
+                                           basis,
+                                           this->nrow_,
+                                           this->nnz_,
+                                           this->mat_.row_offset,
+                                           this->mat_.col,
+                                           diag,
+                                           cast_val->vec_,
+                                           d_inv_diag,
+                                           d_lu,
+                                           cast_rhs->vec_,
+                                           cast_x->vec_,
+                                           work,
+                                           abs_tol,
+                                           rel_tol,
+                                           max_iter,
+                                           d_iter,
+                                           d_res,
+                                           stream);
+            }
+            else
+            {
+                batch_solve_launch<256, 64>(batch,
+                                            basis,
+                                            this->nrow_,
+                                            this->nnz_,
+                                            this->mat_.row_offset,
+                                            this->mat_.col,
+                                            diag,
+                                            cast_val->vec_,
+                                            d_inv_diag,
+                                            d_lu,
+                                            cast_rhs->vec_,
+                                            cast_x->vec_,
+                                            work,
+                                            abs_tol,
+                                            rel_tol,
+                                            max_iter,
+                                            d_iter,
+                                            d_res,
+                                            stream);
+            }
+        }
+        else
+        {
+            LOG_INFO("Unsupported HIP warp size of " << this->local_backend_.HIP_warp);
+            FATAL_ERROR(__FILE__, __LINE__);
         }
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        status
-            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                         rocsparse_operation_none,
-                                         this->nrow_,
-                                         this->nnz_,
-                                         this->L_mat_descr_,
-                                         this->mat_.val,
-                                         this->mat_.row_offset,
-                                         this->mat_.col,
-                                         this->mat_info_itsv_,
-                                         rocsparse_analysis_policy_reuse,
-                                         rocsparse_solve_policy_auto,
-                                         this->mat_buffer_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        copy_d2h(batch, d_iter, iter);
+        copy_d2h(batch, d_res, res);
+
+        free_hip(&work);
+        free_hip(&d_iter);
+        free_hip(&d_res);
+        free_hip(&diag);
+
+        return true;
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::ItLAnalyseClear(void)
+    bool HIPAcceleratorMatrixCSR<ValueType>::ILU0Factorize(void)
     {
-        rocsparse_status status;
+        free_hip(&this->spmv_val_);
 
-        // Clear analysis info
-        if(this->L_mat_descr_ != NULL)
+        if(this->nnz_ > 0)
         {
-            status
-                = rocsparse_csritsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          this->L_mat_descr_,
-                                          this->mat_info_itsv_);
+            rocsparse_status status;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Create buffer, if not already available
+            size_t buffer_size = 0;
+            status             = rocsparseTcsrilu0_buffer_size(
+                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                this->nrow_,
+                this->nnz_,
+                this->mat_descr_,
+                this->mat_.val,
+                this->mat_.row_offset,
+                this->mat_.col,
+                this->mat_info_,
+                &buffer_size);
+
+            // Buffer is shared with ILU0 and other solve functions
+            if(this->mat_buffer_ == NULL)
+            {
+                this->mat_buffer_size_ = buffer_size;
+                allocate_hip(buffer_size, &this->mat_buffer_);
+            }
+            else if(this->mat_buffer_size_ < buffer_size)
+            {
+                // The pattern might have grown, e.g. by ILU(p) or ILUT fill-in
+                this->mat_buffer_size_ = buffer_size;
+                free_hip(&this->mat_buffer_);
+                allocate_hip(buffer_size, &this->mat_buffer_);
+            }
+
+            assert(this->mat_buffer_size_ >= buffer_size);
+            assert(this->mat_buffer_ != NULL);
+
+            status = rocsparseTcsrilu0_analysis(
+                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                this->nrow_,
+                this->nnz_,
+                this->mat_descr_,
+                this->mat_.val,
+                this->mat_.row_offset,
+                this->mat_.col,
+                this->mat_info_,
+                rocsparse_analysis_policy_reuse,
+                rocsparse_solve_policy_auto,
+                this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            status = rocsparseTcsrilu0(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                       this->nrow_,
+                                       this->nnz_,
+                                       this->mat_descr_,
+                                       this->mat_.val,
+                                       this->mat_.row_offset,
+                                       this->mat_.col,
+                                       this->mat_info_,
+                                       rocsparse_solve_policy_auto,
+                                       this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            status = rocsparse_csrilu0_clear(
+                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle), this->mat_info_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ItILU0Factorize(ItILU0Algorithm alg,
+                                                             int             option,
+                                                             int             max_iter,
+                                                             double          tolerance,
+                                                             int*            niter,
+                                                             double*         history)
+    {
+        free_hip(&this->spmv_val_);
+
+        if(this->nnz_ > 0)
+        {
+            rocsparse_status status;
+
+            rocsparse_itilu0_alg itilu0_alg;
+            rocsparse_int        itilu0_option = 0;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            switch(alg)
+            {
+            case ItILU0Algorithm::Default:
+                itilu0_alg = rocsparse_itilu0_alg_default;
+                break;
+            case ItILU0Algorithm::AsyncInPlace:
+                itilu0_alg = rocsparse_itilu0_alg_async_inplace;
+                break;
+            case ItILU0Algorithm::AsyncSplit:
+                itilu0_alg = rocsparse_itilu0_alg_async_split;
+                break;
+            case ItILU0Algorithm::SyncSplit:
+                itilu0_alg = rocsparse_itilu0_alg_sync_split;
+                break;
+            case ItILU0Algorithm::SyncSplitFusion:
+                itilu0_alg = rocsparse_itilu0_alg_sync_split_fusion;
+                break;
+            default:
+                itilu0_alg = rocsparse_itilu0_alg_default;
+                break;
+            }
+
+            itilu0_option
+                |= ((option & ItILU0Option::Verbose) > 0) ? rocsparse_itilu0_option_verbose : 0;
+            itilu0_option |= ((option & ItILU0Option::StoppingCriteria) > 0)
+                                 ? rocsparse_itilu0_option_stopping_criteria
+                                 : 0;
+            itilu0_option |= ((option & ItILU0Option::ComputeNrmCorrection) > 0)
+                                 ? rocsparse_itilu0_option_compute_nrm_correction
+                                 : 0;
+            itilu0_option |= ((option & ItILU0Option::ComputeNrmResidual) > 0)
+                                 ? rocsparse_itilu0_option_compute_nrm_residual
+                                 : 0;
+            itilu0_option |= ((option & ItILU0Option::ConvergenceHistory) > 0)
+                                 ? rocsparse_itilu0_option_convergence_history
+                                 : 0;
+            itilu0_option |= ((option & ItILU0Option::COOFormat) > 0)
+                                 ? rocsparse_itilu0_option_coo_format
+                                 : 0;
+
+            // Create buffer
+            size_t buffer_size = 0;
+            status             = rocsparse_csritilu0_buffer_size(
+                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                itilu0_alg,
+                itilu0_option,
+                max_iter,
+                this->nrow_,
+                this->nnz_,
+                this->mat_.row_offset,
+                this->mat_.col,
+                rocsparse_index_base_zero,
+                rocsparseTdatatype<ValueType>(),
+                &buffer_size);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            char* buffer = NULL;
+            allocate_hip(buffer_size, &buffer);
+
+            if(buffer_size > 0)
+            {
+                assert(buffer != NULL);
+            }
+
+            status = rocsparse_csritilu0_preprocess(
+                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                itilu0_alg,
+                itilu0_option,
+                max_iter,
+                this->nrow_,
+                this->nnz_,
+                this->mat_.row_offset,
+                this->mat_.col,
+                rocsparse_index_base_zero,
+                rocsparseTdatatype<ValueType>(),
+                buffer_size,
+                buffer);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            ValueType* ilu0 = NULL;
+            allocate_hip(this->nnz_, &ilu0);
+            set_to_zero_hip(this->local_backend_.HIP_block_size, this->nnz_, ilu0);
+            assert(ilu0 != NULL);
+
+            status = rocsparseTcsritilu0_compute(
+                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                itilu0_alg,
+                itilu0_option,
+                &max_iter,
+                tolerance,
+                this->nrow_,
+                this->nnz_,
+                this->mat_.row_offset,
+                this->mat_.col,
+                this->mat_.val,
+                ilu0,
+                rocsparse_index_base_zero,
+                buffer_size,
+                buffer);
             CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            niter[0] = max_iter;
+            if(history != NULL)
+            {
+                assert((option & ItILU0Option::StoppingCriteria) > 0);
+                if(std::is_same<ValueType, double>{}
+                   || std::is_same<ValueType, std::complex<double>>{})
+                {
+                    rocsparseTcsritilu0_history<double>(
+                        ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                        itilu0_alg,
+                        niter,
+                        history,
+                        buffer_size,
+                        buffer);
+                }
+                else
+                {
+                    int    num_iter      = max_iter;
+                    float* local_history = new float[num_iter * 2];
+                    rocsparseTcsritilu0_history<float>(
+                        ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                        itilu0_alg,
+                        niter,
+                        local_history,
+                        buffer_size,
+                        buffer);
+
+                    for(int i = 0; i < num_iter * 2; ++i)
+                    {
+                        history[i] = local_history[i];
+                    }
+                }
+            }
+
+            free_hip(&buffer);
+
+            this->DetachView_();
+            free_hip(&this->mat_.val);
+
+            this->mat_.val = ilu0;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ILUTFactorize(double t, int maxrow)
+    {
+        free_hip(&this->spmv_val_);
+        this->InvalidateSpMVStructure_();
+
+        assert(this->nrow_ == this->ncol_);
+        assert(this->nnz_ > 0);
+
+        // Number of pattern updates, each one extends the pattern by one level of fill-in
+        const int nsweeps = 2;
+
+        int nrow = this->nrow_;
+
+        // The values of A are sampled on each candidate pattern
+        HIPAcceleratorMatrixCSR<ValueType> A(this->local_backend_);
+        HIPAcceleratorMatrixCSR<ValueType> L(this->local_backend_);
+        HIPAcceleratorMatrixCSR<ValueType> U(this->local_backend_);
+
+        A.CopyFrom(*this);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+        for(int sweep = 0; sweep < nsweeps; ++sweep)
+        {
+            // Candidate pattern is the pattern of L * U, which contains the current pattern
+            this->ExtractLDiagonal(&L);
+            this->ExtractUDiagonal(&U);
+
+            // Unit values avoid cancellation in the product
+            set_to_value_hip(this->local_backend_.HIP_block_size,
+                             L.nnz_,
+                             L.mat_.val,
+                             static_cast<ValueType>(1));
+            set_to_value_hip(this->local_backend_.HIP_block_size,
+                             U.nnz_,
+                             U.mat_.val,
+                             static_cast<ValueType>(1));
+
+            this->MatMatMult(L, U);
+
+            // Exact incomplete factorization of A on the candidate pattern
+            this->ILUGather_(A, 0, NULL);
+            this->ILU0Factorize();
+
+            // Drop entries following the threshold and the row size limit
+            int* levels = NULL;
+            allocate_hip(this->nnz_, &levels);
+
+            kernel_csr_ilut_select<<<GridSize,
+                                     BlockSize,
+                                     0,
+                                     HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow,
+                t,
+                maxrow,
+                A.mat_.row_offset,
+                A.mat_.val,
+                this->mat_.row_offset,
+                this->mat_.col,
+                this->mat_.val,
+                levels);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            this->ILUCompress_(0, levels);
+
+            free_hip(&levels);
+        }
+
+        // Final factorization on the dropped pattern
+        this->ILUGather_(A, 0, NULL);
+
+        return this->ILU0Factorize();
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ILUpFactorizeNumeric(
+        int p, const BaseMatrix<ValueType>& mat)
+    {
+        free_hip(&this->spmv_val_);
+
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&mat);
+
+        assert(cast_mat != NULL);
+        assert(cast_mat->nrow_ == this->nrow_);
+        assert(cast_mat->ncol_ == this->ncol_);
+        assert(this->nnz_ > 0);
+        assert(cast_mat->nnz_ > 0);
+
+        int nrow = this->nrow_;
+
+        // Levels of fill are computed on the structure, fill-in starts at level p + 1
+        HIPAcceleratorMatrixCSR<ValueType> fill(this->local_backend_);
+        fill.CopyFrom(*cast_mat);
+
+        int* levels     = NULL;
+        int* levels_tmp = NULL;
+
+        allocate_hip(fill.nnz_, &levels);
+        allocate_hip(fill.nnz_, &levels_tmp);
+
+        fill.ILUGather_(*this, p + 1, levels);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+        // An entry of level l only depends on entries of lower levels, thus p sweeps
+        // determine all levels up to p exactly
+        for(int sweep = 0; sweep < p; ++sweep)
+        {
+            kernel_csr_ilup_levels<<<GridSize,
+                                     BlockSize,
+                                     0,
+                                     HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow, p, fill.mat_.row_offset, fill.mat_.col, levels, levels_tmp);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            std::swap(levels, levels_tmp);
+        }
+
+        free_hip(&levels_tmp);
+
+        fill.ILUCompress_(p, levels);
+
+        free_hip(&levels);
+
+        // Numeric factorization on the ILU(p) pattern
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
+
+        int64_t nnz = fill.nnz_;
+
+        fill.LeaveDataPtrCSR(&row_offset, &col, &val);
+        this->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, this->ncol_);
+
+        return this->ILU0Factorize();
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ILUGather_(const HIPAcceleratorMatrixCSR<ValueType>& A,
+                                                        int  fill_level,
+                                                        int* levels)
+    {
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(this->nrow_ / this->local_backend_.HIP_block_size + 1);
+
+        kernel_csr_ilu_gather<<<GridSize,
+                                BlockSize,
+                                0,
+                                HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_,
+            A.mat_.row_offset,
+            A.mat_.col,
+            A.mat_.val,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_.val,
+            fill_level,
+            levels);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ILUCompress_(int p, const int* levels)
+    {
+        int nrow = this->nrow_;
+        int ncol = this->ncol_;
+
+        PtrType* row_offset = NULL;
+        allocate_hip(nrow + 1, &row_offset);
+
+        set_to_zero_hip(this->local_backend_.HIP_block_size, nrow + 1, row_offset);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+        kernel_csr_ilu_count<<<GridSize,
+                               BlockSize,
+                               0,
+                               HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow, p, this->mat_.row_offset, levels, row_offset);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(NULL,
+                                rocprim_size,
+                                row_offset,
+                                row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                row_offset,
+                                row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+
+        PtrType nnz;
+        copy_d2h(1, row_offset + nrow, &nnz);
+
+        int*       col = NULL;
+        ValueType* val = NULL;
+
+        allocate_hip(nnz, &col);
+        allocate_hip(nnz, &val);
+
+        kernel_csr_ilu_compress<<<GridSize,
+                                  BlockSize,
+                                  0,
+                                  HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow,
+            p,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_.val,
+            levels,
+            row_offset,
+            col,
+            val);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        this->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ICFactorize(BaseVector<ValueType>* inv_diag)
+    {
+        free_hip(&this->spmv_val_);
+
+        if(this->nnz_ > 0)
+        {
+            rocsparse_status status;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Create buffer, if not already available
+            size_t buffer_size = 0;
+            status             = rocsparseTcsric0_buffer_size(
+                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                this->nrow_,
+                this->nnz_,
+                this->mat_descr_,
+                this->mat_.val,
+                this->mat_.row_offset,
+                this->mat_.col,
+                this->mat_info_,
+                &buffer_size);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            // Buffer is shared with IC0 and other solve functions
+            if(this->mat_buffer_ == NULL)
+            {
+                this->mat_buffer_size_ = buffer_size;
+                allocate_hip(buffer_size, &this->mat_buffer_);
+            }
+            else if(this->mat_buffer_size_ < buffer_size)
+            {
+                this->mat_buffer_size_ = buffer_size;
+                free_hip(&this->mat_buffer_);
+                allocate_hip(buffer_size, &this->mat_buffer_);
+            }
+
+            assert(this->mat_buffer_size_ >= buffer_size);
+            assert(this->mat_buffer_ != NULL);
+
+            status = rocsparseTcsric0_analysis(
+                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                this->nrow_,
+                this->nnz_,
+                this->mat_descr_,
+                this->mat_.val,
+                this->mat_.row_offset,
+                this->mat_.col,
+                this->mat_info_,
+                rocsparse_analysis_policy_reuse,
+                rocsparse_solve_policy_auto,
+                this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            status = rocsparseTcsric0(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                      this->nrow_,
+                                      this->nnz_,
+                                      this->mat_descr_,
+                                      this->mat_.val,
+                                      this->mat_.row_offset,
+                                      this->mat_.col,
+                                      this->mat_info_,
+                                      rocsparse_solve_policy_auto,
+                                      this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            status = rocsparse_csric0_clear(
+                ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle), this->mat_info_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::LUAnalyse(void)
+    {
+        assert(this->ncol_ == this->nrow_);
+        assert(this->tmp_vec_ == NULL);
+
+        this->tmp_vec_ = new HIPAcceleratorVector<ValueType>(this->local_backend_);
+
+        assert(this->tmp_vec_ != NULL);
+
+        // Status
+        rocsparse_status status;
+
+        // L part
+        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_unit);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // U part
+        status = rocsparse_create_mat_descr(&this->U_mat_descr_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_type(this->U_mat_descr_, rocsparse_matrix_type_general);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_index_base(this->U_mat_descr_, rocsparse_index_base_zero);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_fill_mode(this->U_mat_descr_, rocsparse_fill_mode_upper);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_non_unit);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        // Create buffer, if not already available
+        size_t buffer_size = 0;
+
+        status
+            = rocsparseTcsrsv_buffer_size(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          &buffer_size);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // Buffer is shared with ILU0 and other solve functions
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_hip(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+
+        // L part analysis
+        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          rocsparse_analysis_policy_reuse,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // U part analysis
+        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->U_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          rocsparse_analysis_policy_reuse,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // Allocate temporary vector
+        this->tmp_vec_->Allocate(this->nrow_);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::LUAnalyseClear(void)
+    {
+        rocsparse_status status;
+
+        // Clear analysis info
+        if(this->L_mat_descr_ != NULL)
+        {
+            status = rocsparse_csrsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                           this->L_mat_descr_,
+                                           this->mat_info_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        if(this->U_mat_descr_ != NULL)
+        {
+            status = rocsparse_csrsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                           this->U_mat_descr_,
+                                           this->mat_info_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        // Clear matrix descriptor
+        if(this->L_mat_descr_ != NULL)
+        {
+            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        if(this->U_mat_descr_ != NULL)
+        {
+            status = rocsparse_destroy_mat_descr(this->U_mat_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        this->L_mat_descr_ = 0;
+        this->U_mat_descr_ = 0;
+
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+
+        // Clear temporary vector
+        if(this->tmp_vec_ != NULL)
+        {
+            delete this->tmp_vec_;
+            this->tmp_vec_ = NULL;
+        }
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::LUSolve(const BaseVector<ValueType>& in,
+                                                     BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->L_mat_descr_ != 0);
+            assert(this->U_mat_descr_ != 0);
+            assert(this->mat_info_ != 0);
+            assert(this->ncol_ == this->nrow_);
+            assert(this->tmp_vec_ != NULL);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == this->ncol_);
+            assert(cast_out->size_ == this->nrow_);
+
+            rocsparse_status status;
+
+            ValueType alpha = static_cast<ValueType>(1);
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve L
+            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                     rocsparse_operation_none,
+                                     this->nrow_,
+                                     this->nnz_,
+                                     &alpha,
+                                     this->L_mat_descr_,
+                                     this->mat_.val,
+                                     this->mat_.row_offset,
+                                     this->mat_.col,
+                                     this->mat_info_,
+                                     cast_in->vec_,
+                                     this->tmp_vec_->vec_,
+                                     rocsparse_solve_policy_auto,
+                                     this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            // Solve U
+            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                     rocsparse_operation_none,
+                                     this->nrow_,
+                                     this->nnz_,
+                                     &alpha,
+                                     this->U_mat_descr_,
+                                     this->mat_.val,
+                                     this->mat_.row_offset,
+                                     this->mat_.col,
+                                     this->mat_info_,
+                                     this->tmp_vec_->vec_,
+                                     cast_out->vec_,
+                                     rocsparse_solve_policy_auto,
+                                     this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ItLUAnalyse(void)
+    {
+        assert(this->ncol_ == this->nrow_);
+        assert(this->tmp_vec_ == NULL);
+
+        this->tmp_vec_ = new HIPAcceleratorVector<ValueType>(this->local_backend_);
+
+        assert(this->tmp_vec_ != NULL);
+
+        // Status
+        rocsparse_status status;
+
+        // L part
+        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_unit);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // U part
+        status = rocsparse_create_mat_descr(&this->U_mat_descr_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_type(this->U_mat_descr_, rocsparse_matrix_type_general);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_index_base(this->U_mat_descr_, rocsparse_index_base_zero);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_fill_mode(this->U_mat_descr_, rocsparse_fill_mode_upper);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_non_unit);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        // Create buffer, if not already available
+        size_t buffer_size   = 0;
+        size_t L_buffer_size = 0;
+        size_t U_buffer_size = 0;
+
+        status = rocsparseTcsritsv_buffer_size(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+            rocsparse_operation_none,
+            this->nrow_,
+            this->nnz_,
+            this->L_mat_descr_,
+            this->mat_.val,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_info_itsv_,
+            &L_buffer_size);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        status = rocsparseTcsritsv_buffer_size(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+            rocsparse_operation_none,
+            this->nrow_,
+            this->nnz_,
+            this->U_mat_descr_,
+            this->mat_.val,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_info_itsv_,
+            &U_buffer_size);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        buffer_size = std::max(L_buffer_size, U_buffer_size);
+
+        // Check buffer size
+        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_hip(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+
+        // L part analysis
+        status
+            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                         rocsparse_operation_none,
+                                         this->nrow_,
+                                         this->nnz_,
+                                         this->L_mat_descr_,
+                                         this->mat_.val,
+                                         this->mat_.row_offset,
+                                         this->mat_.col,
+                                         this->mat_info_itsv_,
+                                         rocsparse_analysis_policy_reuse,
+                                         rocsparse_solve_policy_auto,
+                                         this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // U part analysis
+        status
+            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                         rocsparse_operation_none,
+                                         this->nrow_,
+                                         this->nnz_,
+                                         this->U_mat_descr_,
+                                         this->mat_.val,
+                                         this->mat_.row_offset,
+                                         this->mat_.col,
+                                         this->mat_info_itsv_,
+                                         rocsparse_analysis_policy_reuse,
+                                         rocsparse_solve_policy_auto,
+                                         this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // Allocate temporary vector
+        this->tmp_vec_->Allocate(this->nrow_);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ItLUAnalyseClear(void)
+    {
+        rocsparse_status status;
+
+        // Clear analysis info
+        if(this->L_mat_descr_ != NULL)
+        {
+            status
+                = rocsparse_csritsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          this->L_mat_descr_,
+                                          this->mat_info_itsv_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        if(this->U_mat_descr_ != NULL)
+        {
+            status
+                = rocsparse_csritsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          this->U_mat_descr_,
+                                          this->mat_info_itsv_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        // Clear matrix descriptor
+        if(this->L_mat_descr_ != NULL)
+        {
+            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        if(this->U_mat_descr_ != NULL)
+        {
+            status = rocsparse_destroy_mat_descr(this->U_mat_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        this->L_mat_descr_ = 0;
+        this->U_mat_descr_ = 0;
+
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+
+        // Clear persistent solve scratch
+        free_hip(&this->itsv_buffer_);
+        free_hip(&this->itsv_delta_);
+
+        // Clear temporary vector
+        if(this->tmp_vec_ != NULL)
+        {
+            delete this->tmp_vec_;
+            this->tmp_vec_ = NULL;
+        }
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ItLUSolve(int                          max_iter,
+                                                       double                       tolerance,
+                                                       bool                         use_tol,
+                                                       const BaseVector<ValueType>& in,
+                                                       BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->L_mat_descr_ != 0);
+            assert(this->U_mat_descr_ != 0);
+            assert(this->mat_info_itsv_ != 0);
+            assert(this->ncol_ == this->nrow_);
+            assert(this->tmp_vec_ != NULL);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == this->ncol_);
+            assert(cast_out->size_ == this->nrow_);
+
+            // Run all sweeps of both solves in a single kernel each, if supported by the
+            // device
+            if(this->ItSolvePersistent_(true,
+                                        rocsparse_get_mat_diag_type(this->L_mat_descr_)
+                                            == rocsparse_diag_type_unit,
+                                        max_iter,
+                                        tolerance,
+                                        use_tol,
+                                        cast_in->vec_,
+                                        this->tmp_vec_->vec_)
+               == true)
+            {
+                this->ItSolvePersistent_(false,
+                                         rocsparse_get_mat_diag_type(this->U_mat_descr_)
+                                             == rocsparse_diag_type_unit,
+                                         max_iter,
+                                         tolerance,
+                                         use_tol,
+                                         this->tmp_vec_->vec_,
+                                         cast_out->vec_);
+
+                return true;
+            }
+
+            rocsparse_status status;
+
+            const ValueType                   alpha = static_cast<ValueType>(1);
+            const numeric_traits_t<ValueType> temp_tol
+                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+
+            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve L
+            status
+                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          &max_iter,
+                                          tol_ptr,
+                                          nullptr,
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          &alpha,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_itsv_,
+                                          cast_in->vec_,
+                                          this->tmp_vec_->vec_,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            // Solve U
+            status
+                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          &max_iter,
+                                          tol_ptr,
+                                          nullptr,
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          &alpha,
+                                          this->U_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_itsv_,
+                                          this->tmp_vec_->vec_,
+                                          cast_out->vec_,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::LLAnalyse(void)
+    {
+        assert(this->ncol_ == this->nrow_);
+        assert(this->tmp_vec_ == NULL);
+
+        this->tmp_vec_ = new HIPAcceleratorVector<ValueType>(this->local_backend_);
+
+        assert(this->tmp_vec_ != NULL);
+
+        rocsparse_status status;
+
+        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_non_unit);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        // Create buffer, if not already available
+        size_t buffer_size_L  = 0;
+        size_t buffer_size_Lt = 0;
+
+        status
+            = rocsparseTcsrsv_buffer_size(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          &buffer_size_L);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status
+            = rocsparseTcsrsv_buffer_size(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_transpose,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          &buffer_size_Lt);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        size_t buffer_size = std::max(buffer_size_L, buffer_size_Lt);
+
+        // Buffer is shared with ILU0, IC0 and other solve functions
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_hip(buffer_size, &this->mat_buffer_);
+        }
+        else if(this->mat_buffer_size_ < buffer_size)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            free_hip(&this->mat_buffer_);
+            allocate_hip(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+
+        // L part analysis
+        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          rocsparse_analysis_policy_reuse,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // L^T part analysis
+        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_transpose,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          rocsparse_analysis_policy_reuse,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // Allocate temporary vector
+        this->tmp_vec_->Allocate(this->nrow_);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::LLAnalyseClear(void)
+    {
+        rocsparse_status status;
+
+        // Clear analysis info
+        if(this->L_mat_descr_ != 0)
+        {
+            status = rocsparse_csrsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                           this->L_mat_descr_,
+                                           this->mat_info_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        // Clear matrix descriptor
+        if(this->L_mat_descr_ != NULL)
+        {
+            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        this->L_mat_descr_ = 0;
+
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+
+        // Clear temporary vector
+        if(this->tmp_vec_ != NULL)
+        {
+            delete this->tmp_vec_;
+            this->tmp_vec_ = NULL;
+        }
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
+                                                     BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->L_mat_descr_ != 0);
+            assert(this->mat_info_ != 0);
+            assert(this->ncol_ == this->nrow_);
+            assert(this->tmp_vec_ != NULL);
+            assert(this->mat_buffer_ != NULL);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == this->ncol_);
+            assert(cast_out->size_ == this->nrow_);
+
+            rocsparse_status status;
+
+            ValueType alpha = static_cast<ValueType>(1);
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve L
+            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                     rocsparse_operation_none,
+                                     this->nrow_,
+                                     this->nnz_,
+                                     &alpha,
+                                     this->L_mat_descr_,
+                                     this->mat_.val,
+                                     this->mat_.row_offset,
+                                     this->mat_.col,
+                                     this->mat_info_,
+                                     cast_in->vec_,
+                                     this->tmp_vec_->vec_,
+                                     rocsparse_solve_policy_auto,
+                                     this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            // Solve L^T
+            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                     rocsparse_operation_transpose,
+                                     this->nrow_,
+                                     this->nnz_,
+                                     &alpha,
+                                     this->L_mat_descr_,
+                                     this->mat_.val,
+                                     this->mat_.row_offset,
+                                     this->mat_.col,
+                                     this->mat_info_,
+                                     this->tmp_vec_->vec_,
+                                     cast_out->vec_,
+                                     rocsparse_solve_policy_auto,
+                                     this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
+                                                     const BaseVector<ValueType>& inv_diag,
+                                                     BaseVector<ValueType>*       out) const
+    {
+        return LLSolve(in, out);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ItLLAnalyse(void)
+    {
+        assert(this->ncol_ == this->nrow_);
+        assert(this->tmp_vec_ == NULL);
+
+        this->tmp_vec_ = new HIPAcceleratorVector<ValueType>(this->local_backend_);
+
+        assert(this->tmp_vec_ != NULL);
+
+        rocsparse_status status;
+
+        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_non_unit);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        // Create buffer, if not already available
+        size_t buffer_size_L  = 0;
+        size_t buffer_size_Lt = 0;
+
+        status = rocsparseTcsritsv_buffer_size(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+            rocsparse_operation_none,
+            this->nrow_,
+            this->nnz_,
+            this->L_mat_descr_,
+            this->mat_.val,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_info_itsv_,
+            &buffer_size_L);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparseTcsritsv_buffer_size(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+            rocsparse_operation_transpose,
+            this->nrow_,
+            this->nnz_,
+            this->L_mat_descr_,
+            this->mat_.val,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_info_itsv_,
+            &buffer_size_Lt);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        size_t buffer_size = std::max(buffer_size_L, buffer_size_Lt);
+
+        // Check buffer size
+        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_hip(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+
+        // L part analysis
+        status
+            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                         rocsparse_operation_none,
+                                         this->nrow_,
+                                         this->nnz_,
+                                         this->L_mat_descr_,
+                                         this->mat_.val,
+                                         this->mat_.row_offset,
+                                         this->mat_.col,
+                                         this->mat_info_itsv_,
+                                         rocsparse_analysis_policy_reuse,
+                                         rocsparse_solve_policy_auto,
+                                         this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // L^T part analysis
+        status
+            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                         rocsparse_operation_transpose,
+                                         this->nrow_,
+                                         this->nnz_,
+                                         this->L_mat_descr_,
+                                         this->mat_.val,
+                                         this->mat_.row_offset,
+                                         this->mat_.col,
+                                         this->mat_info_itsv_,
+                                         rocsparse_analysis_policy_reuse,
+                                         rocsparse_solve_policy_auto,
+                                         this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // Allocate temporary vector
+        this->tmp_vec_->Allocate(this->nrow_);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ItLLAnalyseClear(void)
+    {
+        rocsparse_status status;
+
+        // Clear analysis info
+        if(this->L_mat_descr_ != 0)
+        {
+            status
+                = rocsparse_csritsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          this->L_mat_descr_,
+                                          this->mat_info_itsv_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        // Clear matrix descriptor
+        if(this->L_mat_descr_ != NULL)
+        {
+            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        this->L_mat_descr_ = 0;
+
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+
+        // Clear temporary vector
+        if(this->tmp_vec_ != NULL)
+        {
+            delete this->tmp_vec_;
+            this->tmp_vec_ = NULL;
+        }
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ItLLSolve(int                          max_iter,
+                                                       double                       tolerance,
+                                                       bool                         use_tol,
+                                                       const BaseVector<ValueType>& in,
+                                                       BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->L_mat_descr_ != 0);
+            assert(this->mat_info_itsv_ != 0);
+            assert(this->ncol_ == this->nrow_);
+            assert(this->tmp_vec_ != NULL);
+            assert(this->mat_buffer_ != NULL);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == this->ncol_);
+            assert(cast_out->size_ == this->nrow_);
+
+            rocsparse_status status;
+
+            const ValueType                   alpha = static_cast<ValueType>(1);
+            const numeric_traits_t<ValueType> temp_tol
+                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+
+            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve L
+            status
+                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          &max_iter,
+                                          tol_ptr,
+                                          nullptr,
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          &alpha,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_itsv_,
+                                          cast_in->vec_,
+                                          this->tmp_vec_->vec_,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+            // Solve L^T
+            status
+                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          &max_iter,
+                                          tol_ptr,
+                                          nullptr,
+                                          rocsparse_operation_transpose,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          &alpha,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_itsv_,
+                                          this->tmp_vec_->vec_,
+                                          cast_out->vec_,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ItLLSolve(int                          max_iter,
+                                                       double                       tolerance,
+                                                       bool                         use_tol,
+                                                       const BaseVector<ValueType>& in,
+                                                       const BaseVector<ValueType>& inv_diag,
+                                                       BaseVector<ValueType>*       out) const
+    {
+        return ItLLSolve(max_iter, tolerance, use_tol, in, out);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::LAnalyse(bool diag_unit)
+    {
+        rocsparse_status status;
+
+        // L part
+        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        if(diag_unit == true)
+        {
+            status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_unit);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+        else
+        {
+            status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_non_unit);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        // Create buffer, if not already available
+        size_t buffer_size = 0;
+        status
+            = rocsparseTcsrsv_buffer_size(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          &buffer_size);
+
+        // Buffer is shared with ILU0 and other solve functions
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_hip(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+
+        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          rocsparse_analysis_policy_reuse,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::UAnalyse(bool diag_unit)
+    {
+        rocsparse_status status;
+
+        // U part
+        status = rocsparse_create_mat_descr(&this->U_mat_descr_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_type(this->U_mat_descr_, rocsparse_matrix_type_general);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_index_base(this->U_mat_descr_, rocsparse_index_base_zero);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_fill_mode(this->U_mat_descr_, rocsparse_fill_mode_upper);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        if(diag_unit == true)
+        {
+            status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_unit);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+        else
+        {
+            status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_non_unit);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        // Create buffer, if not already available
+        size_t buffer_size = 0;
+        status
+            = rocsparseTcsrsv_buffer_size(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->U_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          &buffer_size);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // Buffer is shared with ILU0 and other solve functions
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_hip(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+
+        status = rocsparseTcsrsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          this->U_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_,
+                                          rocsparse_analysis_policy_reuse,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::LAnalyseClear(void)
+    {
+        rocsparse_status status;
+
+        // Clear analysis info
+        if(this->L_mat_descr_ != NULL)
+        {
+            status = rocsparse_csrsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                           this->L_mat_descr_,
+                                           this->mat_info_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+
+        // Clear matrix descriptor
+        if(this->L_mat_descr_ != NULL)
+        {
+            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        this->L_mat_descr_ = 0;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::UAnalyseClear(void)
+    {
+        rocsparse_status status;
+
+        // Clear analysis info
+        if(this->U_mat_descr_ != NULL)
+        {
+            status = rocsparse_csrsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                           this->U_mat_descr_,
+                                           this->mat_info_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+
+        // Clear matrix descriptor
+        if(this->U_mat_descr_ != NULL)
+        {
+            status = rocsparse_destroy_mat_descr(this->U_mat_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        this->U_mat_descr_ = 0;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::LSolve(const BaseVector<ValueType>& in,
+                                                    BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->L_mat_descr_ != 0);
+            assert(this->mat_info_ != 0);
+            assert(this->ncol_ == this->nrow_);
+            assert(this->mat_buffer_size_ > 0);
+            assert(this->mat_buffer_ != NULL);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == this->ncol_);
+            assert(cast_out->size_ == this->nrow_);
+
+            rocsparse_status status;
+
+            ValueType alpha = static_cast<ValueType>(1);
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve L
+            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                     rocsparse_operation_none,
+                                     this->nrow_,
+                                     this->nnz_,
+                                     &alpha,
+                                     this->L_mat_descr_,
+                                     this->mat_.val,
+                                     this->mat_.row_offset,
+                                     this->mat_.col,
+                                     this->mat_info_,
+                                     cast_in->vec_,
+                                     cast_out->vec_,
+                                     rocsparse_solve_policy_auto,
+                                     this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::USolve(const BaseVector<ValueType>& in,
+                                                    BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->U_mat_descr_ != 0);
+            assert(this->mat_info_ != 0);
+            assert(this->ncol_ == this->nrow_);
+            assert(this->mat_buffer_size_ > 0);
+            assert(this->mat_buffer_ != NULL);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == this->ncol_);
+            assert(cast_out->size_ == this->nrow_);
+
+            rocsparse_status status;
+
+            ValueType alpha = static_cast<ValueType>(1);
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve U
+            status = rocsparseTcsrsv(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                     rocsparse_operation_none,
+                                     this->nrow_,
+                                     this->nnz_,
+                                     &alpha,
+                                     this->U_mat_descr_,
+                                     this->mat_.val,
+                                     this->mat_.row_offset,
+                                     this->mat_.col,
+                                     this->mat_info_,
+                                     cast_in->vec_,
+                                     cast_out->vec_,
+                                     rocsparse_solve_policy_auto,
+                                     this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ItLAnalyse(bool diag_unit)
+    {
+        rocsparse_status status;
+
+        // L part
+        status = rocsparse_create_mat_descr(&this->L_mat_descr_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_type(this->L_mat_descr_, rocsparse_matrix_type_general);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_index_base(this->L_mat_descr_, rocsparse_index_base_zero);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_fill_mode(this->L_mat_descr_, rocsparse_fill_mode_lower);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        if(diag_unit == true)
+        {
+            status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_unit);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+        else
+        {
+            status = rocsparse_set_mat_diag_type(this->L_mat_descr_, rocsparse_diag_type_non_unit);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        // Create buffer, if not already available
+        size_t buffer_size = 0;
+        status             = rocsparseTcsritsv_buffer_size(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+            rocsparse_operation_none,
+            this->nrow_,
+            this->nnz_,
+            this->L_mat_descr_,
+            this->mat_.val,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_info_itsv_,
+            &buffer_size);
+
+        // Check buffer size
+        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_hip(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+
+        status
+            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                         rocsparse_operation_none,
+                                         this->nrow_,
+                                         this->nnz_,
+                                         this->L_mat_descr_,
+                                         this->mat_.val,
+                                         this->mat_.row_offset,
+                                         this->mat_.col,
+                                         this->mat_info_itsv_,
+                                         rocsparse_analysis_policy_reuse,
+                                         rocsparse_solve_policy_auto,
+                                         this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ItLAnalyseClear(void)
+    {
+        rocsparse_status status;
+
+        // Clear analysis info
+        if(this->L_mat_descr_ != NULL)
+        {
+            status
+                = rocsparse_csritsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          this->L_mat_descr_,
+                                          this->mat_info_itsv_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+
+        // Clear persistent solve scratch
+        free_hip(&this->itsv_buffer_);
+        free_hip(&this->itsv_delta_);
+
+        // Clear matrix descriptor
+        if(this->L_mat_descr_ != NULL)
+        {
+            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        this->L_mat_descr_ = 0;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ItLSolve(int                          max_iter,
+                                                      double                       tolerance,
+                                                      bool                         use_tol,
+                                                      const BaseVector<ValueType>& in,
+                                                      BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->L_mat_descr_ != 0);
+            assert(this->mat_info_itsv_ != 0);
+            assert(this->ncol_ == this->nrow_);
+            assert(this->mat_buffer_size_ > 0);
+            assert(this->mat_buffer_ != NULL);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == this->ncol_);
+            assert(cast_out->size_ == this->nrow_);
+
+            // Run all sweeps in a single kernel, if supported by the device
+            if(this->ItSolvePersistent_(true,
+                                        rocsparse_get_mat_diag_type(this->L_mat_descr_)
+                                            == rocsparse_diag_type_unit,
+                                        max_iter,
+                                        tolerance,
+                                        use_tol,
+                                        cast_in->vec_,
+                                        cast_out->vec_)
+               == true)
+            {
+                return true;
+            }
+
+            rocsparse_status status;
+
+            const ValueType                   alpha = static_cast<ValueType>(1);
+            const numeric_traits_t<ValueType> temp_tol
+                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+
+            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve L
+            status
+                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          &max_iter,
+                                          tol_ptr,
+                                          nullptr,
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          &alpha,
+                                          this->L_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_itsv_,
+                                          cast_in->vec_,
+                                          cast_out->vec_,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ItUAnalyse(bool diag_unit)
+    {
+        rocsparse_status status;
+
+        // U part
+        status = rocsparse_create_mat_descr(&this->U_mat_descr_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_type(this->U_mat_descr_, rocsparse_matrix_type_general);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_index_base(this->U_mat_descr_, rocsparse_index_base_zero);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_set_mat_fill_mode(this->U_mat_descr_, rocsparse_fill_mode_upper);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        if(diag_unit == true)
+        {
+            status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_unit);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+        else
+        {
+            status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_non_unit);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        // Create buffer, if not already available
+        size_t buffer_size = 0;
+        status             = rocsparseTcsritsv_buffer_size(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+            rocsparse_operation_none,
+            this->nrow_,
+            this->nnz_,
+            this->U_mat_descr_,
+            this->mat_.val,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_info_itsv_,
+            &buffer_size);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // Check buffer size
+        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_hip(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+
+        status
+            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                         rocsparse_operation_none,
+                                         this->nrow_,
+                                         this->nnz_,
+                                         this->U_mat_descr_,
+                                         this->mat_.val,
+                                         this->mat_.row_offset,
+                                         this->mat_.col,
+                                         this->mat_info_itsv_,
+                                         rocsparse_analysis_policy_reuse,
+                                         rocsparse_solve_policy_auto,
+                                         this->mat_buffer_);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixCSR<ValueType>::ItUAnalyseClear(void)
+    {
+        rocsparse_status status;
+
+        // Clear analysis info
+        if(this->U_mat_descr_ != NULL)
+        {
+            status
+                = rocsparse_csritsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          this->U_mat_descr_,
+                                          this->mat_info_itsv_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_hip(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+
+        // Clear persistent solve scratch
+        free_hip(&this->itsv_buffer_);
+        free_hip(&this->itsv_delta_);
+
+        // Clear matrix descriptor
+        if(this->U_mat_descr_ != NULL)
+        {
+            status = rocsparse_destroy_mat_descr(this->U_mat_descr_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        this->U_mat_descr_ = 0;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ItUSolve(int                          max_iter,
+                                                      double                       tolerance,
+                                                      bool                         use_tol,
+                                                      const BaseVector<ValueType>& in,
+                                                      BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->U_mat_descr_ != 0);
+            assert(this->mat_info_itsv_ != 0);
+            assert(this->ncol_ == this->nrow_);
+            assert(this->mat_buffer_size_ > 0);
+            assert(this->mat_buffer_ != NULL);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+            assert(cast_in->size_ == this->ncol_);
+            assert(cast_out->size_ == this->nrow_);
+
+            // Run all sweeps in a single kernel, if supported by the device
+            if(this->ItSolvePersistent_(false,
+                                        rocsparse_get_mat_diag_type(this->U_mat_descr_)
+                                            == rocsparse_diag_type_unit,
+                                        max_iter,
+                                        tolerance,
+                                        use_tol,
+                                        cast_in->vec_,
+                                        cast_out->vec_)
+               == true)
+            {
+                return true;
+            }
+
+            rocsparse_status status;
+
+            const ValueType                   alpha = static_cast<ValueType>(1);
+            const numeric_traits_t<ValueType> temp_tol
+                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+
+            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve U
+            status
+                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                          &max_iter,
+                                          tol_ptr,
+                                          nullptr,
+                                          rocsparse_operation_none,
+                                          this->nrow_,
+                                          this->nnz_,
+                                          &alpha,
+                                          this->U_mat_descr_,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_info_itsv_,
+                                          cast_in->vec_,
+                                          cast_out->vec_,
+                                          rocsparse_solve_policy_auto,
+                                          this->mat_buffer_);
+            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ItSolvePersistent_(bool             lower,
+                                                                bool             unit_diag,
+                                                                int              max_iter,
+                                                                double           tolerance,
+                                                                bool             use_tol,
+                                                                const ValueType* in,
+                                                                ValueType*       out) const
+    {
+        // Grid wide synchronization requires cooperative launch support
+        int cooperative = 0;
+        hipDeviceGetAttribute(
+            &cooperative, hipDeviceAttributeCooperativeLaunch, this->local_backend_.HIP_dev);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        if(cooperative == 0)
+        {
+            return false;
+        }
+
+        const void* kernel
+            = (lower == true)
+                  ? reinterpret_cast<const void*>(
+                      &kernel_csr_itsv_persistent<256, true, ValueType, int, PtrType>)
+                  : reinterpret_cast<const void*>(
+                      &kernel_csr_itsv_persistent<256, false, ValueType, int, PtrType>);
+
+        // All blocks have to be resident at the same time
+        int blocks_per_cu = 0;
+        hipOccupancyMaxActiveBlocksPerMultiprocessor(&blocks_per_cu, kernel, 256, 0);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        int nblocks = std::min(blocks_per_cu * this->local_backend_.HIP_num_procs,
+                               (this->nrow_ - 1) / 256 + 1);
+
+        if(nblocks <= 0)
+        {
+            return false;
+        }
+
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
+
+        if(this->itsv_buffer_ == NULL)
+        {
+            allocate_hip(this->nrow_, &this->itsv_buffer_);
+            allocate_hip(3, &this->itsv_delta_);
+        }
+
+        set_to_zero_hip(this->local_backend_.HIP_block_size, 3, this->itsv_delta_, true, stream);
+
+        int                 nrow       = this->nrow_;
+        const PtrType*      row_offset = this->mat_.row_offset;
+        const int*          col        = this->mat_.col;
+        const ValueType*    val        = this->mat_.val;
+        ValueType*          buffer     = this->itsv_buffer_;
+        unsigned long long* delta      = this->itsv_delta_;
+
+        void* args[] = {&nrow,
+                        &row_offset,
+                        &col,
+                        &val,
+                        &unit_diag,
+                        &max_iter,
+                        &tolerance,
+                        &use_tol,
+                        &in,
+                        &out,
+                        &buffer,
+                        &delta};
+
+        hipLaunchCooperativeKernel(kernel, dim3(nblocks), dim3(256), args, 0, stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractDiagonal(BaseVector<ValueType>* vec_diag) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(vec_diag != NULL);
+
+            HIPAcceleratorVector<ValueType>* cast_vec_diag
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(vec_diag);
+
+            assert(cast_vec_diag != NULL);
+            assert(cast_vec_diag->size_ >= this->nrow_);
+
+            int     nrow            = this->nrow_;
+            int64_t avg_nnz_per_row = this->nnz_ / nrow;
+
+            if(avg_nnz_per_row <= 8)
+            {
+                kernel_csr_extract_diag<1>
+                    <<<dim3((this->nrow_ * 1 - 1) / this->local_backend_.HIP_block_size + 1),
+                       dim3(this->local_backend_.HIP_block_size),
+                       0,
+                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
+                                                                             this->mat_.row_offset,
+                                                                             this->mat_.col,
+                                                                             this->mat_.val,
+                                                                             cast_vec_diag->vec_);
+            }
+            else if(avg_nnz_per_row <= 16)
+            {
+                kernel_csr_extract_diag<2>
+                    <<<dim3((this->nrow_ * 2 - 1) / this->local_backend_.HIP_block_size + 1),
+                       dim3(this->local_backend_.HIP_block_size),
+                       0,
+                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
+                                                                             this->mat_.row_offset,
+                                                                             this->mat_.col,
+                                                                             this->mat_.val,
+                                                                             cast_vec_diag->vec_);
+            }
+            else if(avg_nnz_per_row <= 32)
+            {
+                kernel_csr_extract_diag<4>
+                    <<<dim3((this->nrow_ * 4 - 1) / this->local_backend_.HIP_block_size + 1),
+                       dim3(this->local_backend_.HIP_block_size),
+                       0,
+                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
+                                                                             this->mat_.row_offset,
+                                                                             this->mat_.col,
+                                                                             this->mat_.val,
+                                                                             cast_vec_diag->vec_);
+            }
+            else if(avg_nnz_per_row <= 64)
+            {
+                kernel_csr_extract_diag<8>
+                    <<<dim3((this->nrow_ * 8 - 1) / this->local_backend_.HIP_block_size + 1),
+                       dim3(this->local_backend_.HIP_block_size),
+                       0,
+                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
+                                                                             this->mat_.row_offset,
+                                                                             this->mat_.col,
+                                                                             this->mat_.val,
+                                                                             cast_vec_diag->vec_);
+            }
+            else if(avg_nnz_per_row <= 128)
+            {
+                kernel_csr_extract_diag<16>
+                    <<<dim3((this->nrow_ * 16 - 1) / this->local_backend_.HIP_block_size + 1),
+                       dim3(this->local_backend_.HIP_block_size),
+                       0,
+                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
+                                                                             this->mat_.row_offset,
+                                                                             this->mat_.col,
+                                                                             this->mat_.val,
+                                                                             cast_vec_diag->vec_);
+            }
+            else if(avg_nnz_per_row <= 256 || this->local_backend_.HIP_warp == 32)
+            {
+                kernel_csr_extract_diag<32>
+                    <<<dim3((this->nrow_ * 32 - 1) / this->local_backend_.HIP_block_size + 1),
+                       dim3(this->local_backend_.HIP_block_size),
+                       0,
+                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
+                                                                             this->mat_.row_offset,
+                                                                             this->mat_.col,
+                                                                             this->mat_.val,
+                                                                             cast_vec_diag->vec_);
+            }
+            else
+            {
+                kernel_csr_extract_diag<64>
+                    <<<dim3((this->nrow_ * 64 - 1) / this->local_backend_.HIP_block_size + 1),
+                       dim3(this->local_backend_.HIP_block_size),
+                       0,
+                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
+                                                                             this->mat_.row_offset,
+                                                                             this->mat_.col,
+                                                                             this->mat_.val,
+                                                                             cast_vec_diag->vec_);
+            }
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractInverseDiagonal(
+        BaseVector<ValueType>* vec_inv_diag) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(vec_inv_diag != NULL);
+
+            HIPAcceleratorVector<ValueType>* cast_vec_inv_diag
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(vec_inv_diag);
+
+            assert(cast_vec_inv_diag != NULL);
+            assert(cast_vec_inv_diag->size_ == this->nrow_);
+
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+            int* d_detect_zero_diag = NULL;
+            allocate_hip(1, &d_detect_zero_diag);
+            set_to_zero_hip(1, 1, d_detect_zero_diag);
+
+            kernel_csr_extract_inv_diag<<<GridSize,
+                                          BlockSize,
+                                          0,
+                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow,
+                this->mat_.row_offset,
+                this->mat_.col,
+                this->mat_.val,
+                cast_vec_inv_diag->vec_,
+                d_detect_zero_diag);
+
+            int detect_zero_diag = 0;
+            copy_d2h(1, d_detect_zero_diag, &detect_zero_diag);
+
+            if(detect_zero_diag == 1)
+            {
+                LOG_VERBOSE_INFO(
+                    2,
+                    "*** warning: in HIPAcceleratorMatrixCSR::ExtractInverseDiagonal() a zero has "
+                    "been detected on the diagonal. It has been replaced with one to avoid inf");
+            }
+            free_hip(&d_detect_zero_diag);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractInverseBlockDiagonal(
+        int blockdim, BaseMatrix<ValueType>* inv_diag) const
+    {
+        assert(inv_diag != NULL);
+        assert(blockdim > 0);
+        assert(this->nrow_ > 0);
+        assert(this->nrow_ == this->ncol_);
+        assert(this->nrow_ % blockdim == 0);
+
+        // Larger blocks exceed the per thread pivot storage, fall back to the host
+        if(blockdim > 16)
+        {
+            return false;
+        }
+
+        HIPAcceleratorMatrixCSR<ValueType>* cast_inv
+            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(inv_diag);
+
+        assert(cast_inv != NULL);
+
+        cast_inv->Clear();
+
+        int     nrowb = this->nrow_ / blockdim;
+        int64_t nnz   = static_cast<int64_t>(this->nrow_) * blockdim;
+
+        allocate_hip(this->nrow_ + 1, &cast_inv->mat_.row_offset);
+        allocate_hip(nnz, &cast_inv->mat_.col);
+        allocate_hip(nnz, &cast_inv->mat_.val);
+
+        int* d_detect_zero_pivot = NULL;
+        allocate_hip(1, &d_detect_zero_pivot);
+        set_to_zero_hip(1, 1, d_detect_zero_pivot);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize((nrowb - 1) / this->local_backend_.HIP_block_size + 1);
+
+        kernel_csr_extract_inv_block_diag<16>
+            <<<GridSize,
+               BlockSize,
+               0,
+               HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrowb,
+                                                                     blockdim,
+                                                                     this->mat_.row_offset,
+                                                                     this->mat_.col,
+                                                                     this->mat_.val,
+                                                                     cast_inv->mat_.row_offset,
+                                                                     cast_inv->mat_.col,
+                                                                     cast_inv->mat_.val,
+                                                                     d_detect_zero_pivot);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        int detect_zero_pivot = 0;
+        copy_d2h(1, d_detect_zero_pivot, &detect_zero_pivot);
+
+        if(detect_zero_pivot == 1)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: in HIPAcceleratorMatrixCSR::"
+                             "ExtractInverseBlockDiagonal() a singular diagonal block has "
+                             "been detected. Its zero pivots have been replaced with one to "
+                             "avoid inf");
+        }
+
+        free_hip(&d_detect_zero_pivot);
+
+        cast_inv->nrow_ = this->nrow_;
+        cast_inv->ncol_ = this->ncol_;
+        cast_inv->nnz_  = nnz;
+
+        cast_inv->ApplyAnalysis();
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractRowL1Norm(BaseVector<ValueType>* vec_l1) const
+    {
+        assert(vec_l1 != NULL);
+
+        HIPAcceleratorVector<ValueType>* cast_vec_l1
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(vec_l1);
+
+        assert(cast_vec_l1 != NULL);
+        assert(cast_vec_l1->size_ == this->nrow_);
+
+        if(this->nrow_ > 0)
+        {
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+            kernel_csr_extract_row_l1_norm<<<GridSize,
+                                             BlockSize,
+                                             0,
+                                             HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow, this->mat_.row_offset, this->mat_.val, cast_vec_l1->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractConnectedRows(const BaseVector<bool>& cols,
+                                                                  BaseVector<bool>* rows) const
+    {
+        assert(rows != NULL);
+
+        const HIPAcceleratorVector<bool>* cast_cols
+            = dynamic_cast<const HIPAcceleratorVector<bool>*>(&cols);
+        HIPAcceleratorVector<bool>* cast_rows = dynamic_cast<HIPAcceleratorVector<bool>*>(rows);
+
+        assert(cast_cols != NULL);
+        assert(cast_rows != NULL);
+        assert(cast_cols->size_ == this->ncol_);
+        assert(cast_rows->size_ == this->nrow_);
+
+        if(this->nrow_ > 0)
+        {
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+            hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
+
+            kernel_csr_extract_connected_rows<<<GridSize, BlockSize, 0, stream>>>(
+                nrow, this->mat_.row_offset, this->mat_.col, cast_cols->vec_, cast_rows->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::Hash(uint64_t* hash) const
+    {
+        assert(hash != NULL);
+
+        *hash = 0;
+
+        if(this->nrow_ == 0)
+        {
+            return true;
+        }
+
+        int  nrow = this->nrow_;
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
+
+        unsigned long long* d_row_hash = NULL;
+        unsigned long long* d_hash     = NULL;
+
+        allocate_hip(nrow, &d_row_hash);
+        allocate_hip(1, &d_hash);
+
+        kernel_csr_hash<<<GridSize, BlockSize, 0, stream>>>(
+            nrow, this->mat_.row_offset, this->mat_.col, this->mat_.val, d_row_hash);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        // Unsigned wrap around makes the sum independent of the reduction order
+        size_t size   = 0;
+        char*  buffer = NULL;
+
+        rocprim::reduce(buffer,
+                        size,
+                        d_row_hash,
+                        d_hash,
+                        0ull,
+                        nrow,
+                        rocprim::plus<unsigned long long>(),
+                        stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(size, &buffer);
+
+        rocprim::reduce(buffer,
+                        size,
+                        d_row_hash,
+                        d_hash,
+                        0ull,
+                        nrow,
+                        rocprim::plus<unsigned long long>(),
+                        stream);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        unsigned long long h_hash;
+        copy_d2h(1, d_hash, &h_hash);
+
+        *hash = h_hash;
+
+        free_hip(&buffer);
+        free_hip(&d_row_hash);
+        free_hip(&d_hash);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::Statistics(MatrixStatistics* stats) const
+    {
+        assert(stats != NULL);
+        assert(this->nrow_ > 0);
+
+        // Per row statistics, reduced on the device, such that only the result is copied
+        csr_statistics_t* d_stats = NULL;
+        allocate_hip(this->nrow_ + 1, &d_stats);
+
+        int  nrow = this->nrow_;
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+        kernel_csr_statistics<<<GridSize,
+                                BlockSize,
+                                0,
+                                HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow, this->ncol_, this->mat_.row_offset, this->mat_.col, this->mat_.val, d_stats);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        csr_statistics_t init;
+
+        init.min_row    = std::numeric_limits<int64_t>::max();
+        init.max_row    = 0;
+        init.sum_row2   = 0;
+        init.bandwidth  = 0;
+        init.profile    = 0;
+        init.dominant   = 0;
+        init.asymmetric = 0;
+
+        // rocprim buffer
+        size_t size   = 0;
+        char*  buffer = NULL;
+
+        rocprim::reduce(buffer,
+                        size,
+                        d_stats,
+                        d_stats + nrow,
+                        init,
+                        nrow,
+                        csr_statistics_merge(),
+                        HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(size, &buffer);
+
+        rocprim::reduce(buffer,
+                        size,
+                        d_stats,
+                        d_stats + nrow,
+                        init,
+                        nrow,
+                        csr_statistics_merge(),
+                        HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        csr_statistics_t result;
+        copy_d2h(1,
+                 d_stats + nrow,
+                 &result,
+                 true,
+                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+
+        hipStreamSynchronize(HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&buffer);
+        free_hip(&d_stats);
+
+        double mean = static_cast<double>(this->nnz_) / this->nrow_;
+
+        stats->min_row        = result.min_row;
+        stats->max_row        = result.max_row;
+        stats->mean_row       = mean;
+        stats->var_row        = static_cast<double>(result.sum_row2) / this->nrow_ - mean * mean;
+        stats->bandwidth      = result.bandwidth;
+        stats->profile        = result.profile;
+        stats->diag_dominance = static_cast<double>(result.dominant) / this->nrow_;
+        stats->symmetric      = (result.asymmetric == 0);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractSubMatrix(int                    row_offset,
+                                                              int                    col_offset,
+                                                              int                    row_size,
+                                                              int                    col_size,
+                                                              BaseMatrix<ValueType>* mat) const
+    {
+        assert(mat != NULL);
+
+        assert(row_offset >= 0);
+        assert(col_offset >= 0);
+
+        assert(this->nrow_ >= 0);
+        assert(this->ncol_ >= 0);
+
+        HIPAcceleratorMatrixCSR<ValueType>* cast_mat
+            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(mat);
+        assert(cast_mat != NULL);
+
+        PtrType mat_nnz = 0;
+
+        PtrType* row_nnz = NULL;
+        allocate_hip(row_size + 1, &row_nnz);
+
+        // compute the nnz per row in the new matrix
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(row_size / this->local_backend_.HIP_block_size + 1);
+
+        kernel_csr_extract_submatrix_row_nnz<<<
+            GridSize,
+            BlockSize,
+            0,
+            HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(this->mat_.row_offset,
+                                                                  this->mat_.col,
+                                                                  this->mat_.val,
+                                                                  row_offset,
+                                                                  col_offset,
+                                                                  row_size,
+                                                                  col_size,
+                                                                  row_nnz);
+
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        // compute the new nnz by reduction
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(NULL,
+                                rocprim_size,
+                                row_nnz,
+                                row_nnz,
+                                0,
+                                row_size + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                row_nnz,
+                                row_nnz,
+                                0,
+                                row_size + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+
+        copy_d2h(1, row_nnz + row_size, &mat_nnz);
+
+        cast_mat->AllocateCSR(mat_nnz, row_size, col_size);
+
+        // not empty submatrix
+        if(mat_nnz > 0)
+        {
+            free_hip(&cast_mat->mat_.row_offset);
+            cast_mat->mat_.row_offset = row_nnz;
+            // copying the sub matrix
+
+            kernel_csr_extract_submatrix_copy<<<
+                GridSize,
+                BlockSize,
+                0,
+                HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(this->mat_.row_offset,
+                                                                      this->mat_.col,
+                                                                      this->mat_.val,
+                                                                      row_offset,
+                                                                      col_offset,
+                                                                      row_size,
+                                                                      col_size,
+                                                                      cast_mat->mat_.row_offset,
+                                                                      cast_mat->mat_.col,
+                                                                      cast_mat->mat_.val);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+        else
+        {
+            free_hip(&row_nnz);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractSubMatrices(int        row_num_blocks,
+                                                                int        col_num_blocks,
+                                                                const int* row_offset,
+                                                                const int* col_offset,
+                                                                BaseMatrix<ValueType>** mat) const
+    {
+        assert(row_num_blocks > 0);
+        assert(col_num_blocks > 0);
+        assert(row_offset != NULL);
+        assert(col_offset != NULL);
+        assert(mat != NULL);
+
+        int nblocks = row_num_blocks * col_num_blocks;
+        int nrow    = row_offset[row_num_blocks] - row_offset[0];
+
+        assert(row_offset[0] >= 0);
+        assert(row_offset[row_num_blocks] <= this->nrow_);
+        assert(col_offset[0] >= 0);
+        assert(col_offset[col_num_blocks] <= this->ncol_);
+
+        std::vector<HIPAcceleratorMatrixCSR<ValueType>*> cast_mat(nblocks);
+
+        for(int i = 0; i < nblocks; ++i)
+        {
+            cast_mat[i] = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(mat[i]);
+
+            if(cast_mat[i] == NULL)
+            {
+                return false;
+            }
+        }
+
+        // Block offsets on the device
+        int* d_row_offset = NULL;
+        int* d_col_offset = NULL;
+
+        allocate_hip(row_num_blocks + 1, &d_row_offset);
+        allocate_hip(col_num_blocks + 1, &d_col_offset);
+
+        copy_h2d(row_num_blocks + 1, row_offset, d_row_offset);
+        copy_h2d(col_num_blocks + 1, col_offset, d_col_offset);
+
+        // Count the nnz of each row per column block, all blocks share a single scan
+        int64_t  count_size = static_cast<int64_t>(col_num_blocks) * nrow + 1;
+        PtrType* count      = NULL;
+
+        allocate_hip(count_size, &count);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, count_size, count);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+        kernel_csr_extract_submatrices_nnz<<<GridSize,
+                                             BlockSize,
+                                             0,
+                                             HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow, row_offset[0], col_num_blocks, this->mat_.row_offset, this->mat_.col,
+            d_col_offset, count);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(NULL,
+                                rocprim_size,
+                                count,
+                                count,
+                                0,
+                                count_size,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                count,
+                                count,
+                                0,
+                                count_size,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+
+        // Start of each block in the scan, a single transfer gives the nnz of all blocks
+        int      nbounds  = (row_num_blocks + 1) * col_num_blocks;
+        PtrType* d_bounds = NULL;
+
+        allocate_hip(nbounds, &d_bounds);
+
+        kernel_csr_extract_submatrices_bounds<<<
+            (nbounds - 1) / this->local_backend_.HIP_block_size + 1,
+            BlockSize,
+            0,
+            HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow, row_num_blocks, col_num_blocks, d_row_offset, count, d_bounds);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        std::vector<PtrType> bounds(nbounds);
+        copy_d2h(nbounds, d_bounds, bounds.data());
+
+        // Row offsets, columns and values of all blocks in a single pointer table
+        std::vector<void*> h_sm_ptr(3 * nblocks);
+
+        for(int i = 0; i < row_num_blocks; ++i)
+        {
+            for(int j = 0; j < col_num_blocks; ++j)
+            {
+                int idx = i * col_num_blocks + j;
+
+                cast_mat[idx]->AllocateCSR(bounds[idx + col_num_blocks] - bounds[idx],
+                                           row_offset[i + 1] - row_offset[i],
+                                           col_offset[j + 1] - col_offset[j]);
+
+                h_sm_ptr[idx]               = cast_mat[idx]->mat_.row_offset;
+                h_sm_ptr[nblocks + idx]     = cast_mat[idx]->mat_.col;
+                h_sm_ptr[2 * nblocks + idx] = cast_mat[idx]->mat_.val;
+            }
+        }
+
+        if(nrow > 0)
+        {
+            void** d_sm_ptr = NULL;
+
+            allocate_hip(3 * nblocks, &d_sm_ptr);
+            copy_h2d(3 * nblocks, h_sm_ptr.data(), d_sm_ptr);
+
+            kernel_csr_extract_submatrices_fill<<<
+                GridSize,
+                BlockSize,
+                0,
+                HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
+                                                                      row_num_blocks,
+                                                                      col_num_blocks,
+                                                                      this->mat_.row_offset,
+                                                                      this->mat_.col,
+                                                                      this->mat_.val,
+                                                                      d_row_offset,
+                                                                      d_col_offset,
+                                                                      count,
+                                                                      d_bounds,
+                                                                      d_sm_ptr);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&d_sm_ptr);
+        }
+
+        free_hip(&d_row_offset);
+        free_hip(&d_col_offset);
+        free_hip(&count);
+        free_hip(&d_bounds);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractL(BaseMatrix<ValueType>* L) const
+    {
+        assert(L != NULL);
+
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
+
+        HIPAcceleratorMatrixCSR<ValueType>* cast_L
+            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(L);
+
+        assert(cast_L != NULL);
+
+        cast_L->Clear();
+
+        // compute nnz per row
+        int nrow = this->nrow_;
+
+        allocate_hip(nrow + 1, &cast_L->mat_.row_offset);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+        kernel_csr_slower_nnz_per_row<<<GridSize,
+                                        BlockSize,
+                                        0,
+                                        HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow, this->mat_.row_offset, this->mat_.col, cast_L->mat_.row_offset);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        // partial sum row_nnz to obtain row_offset vector
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(NULL,
+                                rocprim_size,
+                                cast_L->mat_.row_offset,
+                                cast_L->mat_.row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                cast_L->mat_.row_offset,
+                                cast_L->mat_.row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+
+        PtrType nnz_L;
+        copy_d2h(1, cast_L->mat_.row_offset + nrow, &nnz_L);
+
+        // allocate lower triangular part structure
+        allocate_hip(nnz_L, &cast_L->mat_.col);
+        allocate_hip(nnz_L, &cast_L->mat_.val);
+
+        // fill lower triangular part
+        kernel_csr_extract_l_triangular<<<GridSize,
+                                          BlockSize,
+                                          0,
+                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_.val,
+            cast_L->mat_.row_offset,
+            cast_L->mat_.col,
+            cast_L->mat_.val);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        cast_L->nrow_ = this->nrow_;
+        cast_L->ncol_ = this->ncol_;
+        cast_L->nnz_  = nnz_L;
+
+        cast_L->ApplyAnalysis();
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractLDiagonal(BaseMatrix<ValueType>* L) const
+    {
+        assert(L != NULL);
+
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
+
+        HIPAcceleratorMatrixCSR<ValueType>* cast_L
+            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(L);
+
+        assert(cast_L != NULL);
+
+        cast_L->Clear();
+
+        // compute nnz per row
+        int nrow = this->nrow_;
+
+        allocate_hip(nrow + 1, &cast_L->mat_.row_offset);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+        kernel_csr_lower_nnz_per_row<<<GridSize,
+                                       BlockSize,
+                                       0,
+                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow, this->mat_.row_offset, this->mat_.col, cast_L->mat_.row_offset);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        // partial sum row_nnz to obtain row_offset vector
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(NULL,
+                                rocprim_size,
+                                cast_L->mat_.row_offset,
+                                cast_L->mat_.row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                cast_L->mat_.row_offset,
+                                cast_L->mat_.row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+
+        PtrType nnz_L;
+        copy_d2h(1, cast_L->mat_.row_offset + nrow, &nnz_L);
+
+        // allocate lower triangular part structure
+        allocate_hip(nnz_L, &cast_L->mat_.col);
+        allocate_hip(nnz_L, &cast_L->mat_.val);
+
+        // fill lower triangular part
+        kernel_csr_extract_l_triangular<<<GridSize,
+                                          BlockSize,
+                                          0,
+                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_.val,
+            cast_L->mat_.row_offset,
+            cast_L->mat_.col,
+            cast_L->mat_.val);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        cast_L->nrow_ = this->nrow_;
+        cast_L->ncol_ = this->ncol_;
+        cast_L->nnz_  = nnz_L;
+
+        cast_L->ApplyAnalysis();
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractU(BaseMatrix<ValueType>* U) const
+    {
+        assert(U != NULL);
+
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
+
+        HIPAcceleratorMatrixCSR<ValueType>* cast_U
+            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(U);
+
+        assert(cast_U != NULL);
+
+        cast_U->Clear();
+
+        // compute nnz per row
+        int nrow = this->nrow_;
+
+        allocate_hip(nrow + 1, &cast_U->mat_.row_offset);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+        kernel_csr_supper_nnz_per_row<<<GridSize,
+                                        BlockSize,
+                                        0,
+                                        HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow, this->mat_.row_offset, this->mat_.col, cast_U->mat_.row_offset);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        // partial sum row_nnz to obtain row_offset vector
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(NULL,
+                                rocprim_size,
+                                cast_U->mat_.row_offset,
+                                cast_U->mat_.row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                cast_U->mat_.row_offset,
+                                cast_U->mat_.row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+
+        PtrType nnz_U;
+        copy_d2h(1, cast_U->mat_.row_offset + nrow, &nnz_U);
+
+        // allocate lower triangular part structure
+        allocate_hip(nnz_U, &cast_U->mat_.col);
+        allocate_hip(nnz_U, &cast_U->mat_.val);
+
+        // fill upper triangular part
+        kernel_csr_extract_u_triangular<<<GridSize,
+                                          BlockSize,
+                                          0,
+                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_.val,
+            cast_U->mat_.row_offset,
+            cast_U->mat_.col,
+            cast_U->mat_.val);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        cast_U->nrow_ = this->nrow_;
+        cast_U->ncol_ = this->ncol_;
+        cast_U->nnz_  = nnz_U;
+
+        cast_U->ApplyAnalysis();
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractUDiagonal(BaseMatrix<ValueType>* U) const
+    {
+        assert(U != NULL);
+
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
+
+        HIPAcceleratorMatrixCSR<ValueType>* cast_U
+            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(U);
+
+        assert(cast_U != NULL);
+
+        cast_U->Clear();
+
+        // compute nnz per row
+        int nrow = this->nrow_;
+
+        allocate_hip(nrow + 1, &cast_U->mat_.row_offset);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+        kernel_csr_upper_nnz_per_row<<<GridSize,
+                                       BlockSize,
+                                       0,
+                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow, this->mat_.row_offset, this->mat_.col, cast_U->mat_.row_offset);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        // partial sum row_nnz to obtain row_offset vector
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(NULL,
+                                rocprim_size,
+                                cast_U->mat_.row_offset,
+                                cast_U->mat_.row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                cast_U->mat_.row_offset,
+                                cast_U->mat_.row_offset,
+                                0,
+                                nrow + 1,
+                                rocprim::plus<PtrType>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+
+        PtrType nnz_U;
+        copy_d2h(1, cast_U->mat_.row_offset + nrow, &nnz_U);
+
+        // allocate lower triangular part structure
+        allocate_hip(nnz_U, &cast_U->mat_.col);
+        allocate_hip(nnz_U, &cast_U->mat_.val);
+
+        // fill lower triangular part
+        kernel_csr_extract_u_triangular<<<GridSize,
+                                          BlockSize,
+                                          0,
+                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            nrow,
+            this->mat_.row_offset,
+            this->mat_.col,
+            this->mat_.val,
+            cast_U->mat_.row_offset,
+            cast_U->mat_.col,
+            cast_U->mat_.val);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        cast_U->nrow_ = this->nrow_;
+        cast_U->ncol_ = this->ncol_;
+        cast_U->nnz_  = nnz_U;
+
+        cast_U->ApplyAnalysis();
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::MaximalIndependentSet(
+        int& size, BaseVector<int>* permutation) const
+    {
+        assert(permutation != NULL);
+
+        HIPAcceleratorVector<int>* cast_perm
+            = dynamic_cast<HIPAcceleratorVector<int>*>(permutation);
+
+        assert(cast_perm != NULL);
+        assert(this->nrow_ == this->ncol_);
+
+        size = 0;
+
+        cast_perm->Allocate(this->nrow_);
+
+        if(this->nrow_ == 0)
+        {
+            return true;
+        }
+
+        // Row states, the final state is 1 for rows in the set and 0 otherwise
+        int* state     = NULL;
+        int* scan      = NULL;
+        int* undecided = NULL;
+
+        allocate_hip(this->nrow_ + 1, &state);
+        allocate_hip(this->nrow_ + 1, &scan);
+        allocate_hip(1, &undecided);
+
+        set_to_value_hip(this->local_backend_.HIP_block_size, this->nrow_, state, -1);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, 1, state + this->nrow_);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(this->nrow_ / this->local_backend_.HIP_block_size + 1);
+
+        // Luby rounds until all rows are decided
+        int h_undecided = 1;
+
+        while(h_undecided != 0)
+        {
+            set_to_zero_hip(this->local_backend_.HIP_block_size, 1, undecided);
+
+            kernel_csr_mis_select<<<GridSize,
+                                    BlockSize,
+                                    0,
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_, this->mat_.row_offset, this->mat_.col, state);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            kernel_csr_mis_update<<<GridSize,
+                                    BlockSize,
+                                    0,
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_, this->mat_.row_offset, this->mat_.col, state, undecided);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            copy_d2h(1, undecided, &h_undecided);
+        }
+
+        // Rows of the set go first, keeping their relative order
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(NULL,
+                                rocprim_size,
+                                state,
+                                scan,
+                                0,
+                                this->nrow_ + 1,
+                                rocprim::plus<int>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                state,
+                                scan,
+                                0,
+                                this->nrow_ + 1,
+                                rocprim::plus<int>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+
+        copy_d2h(1, scan + this->nrow_, &size);
+
+        kernel_csr_zero_block_permutation<<<GridSize,
+                                            BlockSize,
+                                            0,
+                                            HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_, size, state, scan, cast_perm->vec_);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&state);
+        free_hip(&scan);
+        free_hip(&undecided);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ZeroBlockPermutation(
+        int& size, BaseVector<int>* permutation) const
+    {
+        assert(permutation != NULL);
+        assert(permutation->GetSize() == this->nrow_);
+        assert(permutation->GetSize() == this->ncol_);
+
+        HIPAcceleratorVector<int>* cast_perm
+            = dynamic_cast<HIPAcceleratorVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        size = 0;
+
+        if(this->nrow_ == 0)
+        {
+            return true;
+        }
+
+        int* hit  = NULL;
+        int* scan = NULL;
+
+        allocate_hip(this->nrow_ + 1, &hit);
+        allocate_hip(this->nrow_ + 1, &scan);
+
+        set_to_zero_hip(this->local_backend_.HIP_block_size, this->nrow_ + 1, hit);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(this->nrow_ / this->local_backend_.HIP_block_size + 1);
+
+        // Mark all rows with a diagonal entry
+        kernel_csr_zero_block_mark<<<GridSize,
+                                     BlockSize,
+                                     0,
+                                     HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_, this->mat_.row_offset, this->mat_.col, hit);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        // Position of each row within its block
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::exclusive_scan(NULL,
+                                rocprim_size,
+                                hit,
+                                scan,
+                                0,
+                                this->nrow_ + 1,
+                                rocprim::plus<int>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::exclusive_scan(rocprim_buffer,
+                                rocprim_size,
+                                hit,
+                                scan,
+                                0,
+                                this->nrow_ + 1,
+                                rocprim::plus<int>(),
+                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+
+        copy_d2h(1, scan + this->nrow_, &size);
+
+        kernel_csr_zero_block_permutation<<<GridSize,
+                                            BlockSize,
+                                            0,
+                                            HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_, size, hit, scan, cast_perm->vec_);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&hit);
+        free_hip(&scan);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::MultiColoring(int&             num_colors,
+                                                           int**            size_colors,
+                                                           BaseVector<int>* permutation) const
+    {
+        assert(*size_colors == NULL);
+        assert(permutation != NULL);
+
+        HIPAcceleratorVector<int>* cast_perm
+            = dynamic_cast<HIPAcceleratorVector<int>*>(permutation);
+
+        assert(cast_perm != NULL);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(this->nrow_ / this->local_backend_.HIP_block_size + 1);
+
+        // node colors (init value = 0 i.e. no color)
+        int*                color     = NULL;
+        int*                uncolored = NULL;
+        unsigned long long* wmax      = NULL;
+        unsigned long long* wmin      = NULL;
+
+        allocate_hip(this->nrow_, &color);
+        allocate_hip(this->nrow_, &wmax);
+        allocate_hip(this->nrow_, &wmin);
+        allocate_hip(1, &uncolored);
+
+        set_to_zero_hip(this->local_backend_.HIP_block_size, this->nrow_, color);
+
+        // Jones-Plassmann coloring, where each round assigns two colors, one to the
+        // local maxima and one to the local minima of the random vertex weights
+        int num_uncolored = this->nrow_;
+        num_colors        = 0;
+
+        while(num_uncolored > 0)
+        {
+            set_to_zero_hip(this->local_backend_.HIP_block_size, this->nrow_, wmax);
+            set_to_value_hip(this->local_backend_.HIP_block_size, this->nrow_, wmin, ~0ULL);
+            set_to_zero_hip(this->local_backend_.HIP_block_size, 1, uncolored);
+
+            kernel_csr_coloring_neighbor_weights<<<
+                GridSize,
+                BlockSize,
+                0,
+                HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_, this->mat_.row_offset, this->mat_.col, color, wmax, wmin);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            kernel_csr_coloring_assign<<<GridSize,
+                                         BlockSize,
+                                         0,
+                                         HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_, num_colors + 1, wmax, wmin, color, uncolored);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            copy_d2h(1, uncolored, &num_uncolored);
+
+            num_colors += 2;
         }
 
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
+        free_hip(&wmax);
+        free_hip(&wmin);
+        free_hip(&uncolored);
+
+        // Count the vertices of each color
+        int* d_size_colors = NULL;
+        allocate_hip(num_colors, &d_size_colors);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, num_colors, d_size_colors);
+
+        kernel_csr_coloring_count<<<GridSize,
+                                    BlockSize,
+                                    0,
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_, color, d_size_colors);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        int* h_size_colors = NULL;
+        allocate_host(num_colors, &h_size_colors);
+        copy_d2h(num_colors, d_size_colors, h_size_colors);
+
+        // Remove empty colors
+        int* h_map = NULL;
+        allocate_host(num_colors, &h_map);
+
+        int ncolors = 0;
+        for(int i = 0; i < num_colors; ++i)
         {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            if(h_size_colors[i] > 0)
+            {
+                h_size_colors[ncolors] = h_size_colors[i];
+                h_map[i]               = ++ncolors;
+            }
         }
 
-        this->mat_buffer_size_ = 0;
+        copy_h2d(num_colors, h_map, d_size_colors);
 
-        // Clear matrix descriptor
-        if(this->L_mat_descr_ != NULL)
+        kernel_csr_coloring_compress<<<GridSize,
+                                       BlockSize,
+                                       0,
+                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_, d_size_colors, color);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        num_colors = ncolors;
+
+        allocate_host(num_colors, size_colors);
+        copy_h2h(num_colors, h_size_colors, *size_colors);
+
+        free_host(&h_size_colors);
+        free_host(&h_map);
+        free_hip(&d_size_colors);
+
+        // Stable sort by color, such that the vertices of each color keep their order
+        int* order      = NULL;
+        int* identity   = NULL;
+        int* color_sort = NULL;
+
+        allocate_hip(this->nrow_, &order);
+        allocate_hip(this->nrow_, &identity);
+        allocate_hip(this->nrow_, &color_sort);
+
+        rocsparse_status status = rocsparse_create_identity_permutation(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle), this->nrow_, identity);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        unsigned int end_bit = 0;
+        while((1 << end_bit) <= num_colors)
         {
-            status = rocsparse_destroy_mat_descr(this->L_mat_descr_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            ++end_bit;
         }
 
-        this->L_mat_descr_ = 0;
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::radix_sort_pairs(NULL,
+                                  rocprim_size,
+                                  color,
+                                  color_sort,
+                                  identity,
+                                  order,
+                                  this->nrow_,
+                                  0,
+                                  end_bit,
+                                  HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(rocprim_size, &rocprim_buffer);
+
+        rocprim::radix_sort_pairs(rocprim_buffer,
+                                  rocprim_size,
+                                  color,
+                                  color_sort,
+                                  identity,
+                                  order,
+                                  this->nrow_,
+                                  0,
+                                  end_bit,
+                                  HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rocprim_buffer);
+        free_hip(&identity);
+        free_hip(&color_sort);
+        free_hip(&color);
+
+        cast_perm->Allocate(this->nrow_);
+
+        kernel_reverse_index<<<GridSize,
+                               BlockSize,
+                               0,
+                               HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_, order, cast_perm->vec_);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&order);
+
+        return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ItLSolve(int                          max_iter,
-                                                      double                       tolerance,
-                                                      bool                         use_tol,
-                                                      const BaseVector<ValueType>& in,
-                                                      BaseVector<ValueType>*       out) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::CMK(BaseVector<int>* permutation) const
     {
-        if(this->nnz_ > 0)
+        assert(this->nnz_ > 0);
+        assert(permutation != NULL);
+
+        HIPAcceleratorVector<int>* cast_perm
+            = dynamic_cast<HIPAcceleratorVector<int>*>(permutation);
+
+        assert(cast_perm != NULL);
+
+        cast_perm->Clear();
+        cast_perm->Allocate(this->nrow_);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(this->nrow_ / this->local_backend_.HIP_block_size + 1);
+
+        // order[label] holds the vertex with the given label, i.e. the inverse permutation
+        int*                order     = NULL;
+        int*                parent    = NULL;
+        int*                next      = NULL;
+        int*                next_sort = NULL;
+        int*                next_size = NULL;
+        unsigned long long* keys      = NULL;
+        unsigned long long* keys_sort = NULL;
+
+        allocate_hip(this->nrow_, &order);
+        allocate_hip(this->nrow_, &parent);
+        allocate_hip(this->nrow_, &next);
+        allocate_hip(this->nrow_, &next_sort);
+        allocate_hip(this->nrow_, &keys);
+        allocate_hip(this->nrow_, &keys_sort);
+        allocate_hip(1, &next_size);
+
+        // Unlabeled vertices
+        set_to_value_hip(this->local_backend_.HIP_block_size, this->nrow_, cast_perm->vec_, -1);
+        set_to_value_hip(this->local_backend_.HIP_block_size, this->nrow_, parent, this->nrow_);
+
+        // Temporary storage for sorting the levels
+        size_t rocprim_size_keys;
+        size_t rocprim_size_pairs;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::radix_sort_keys(NULL,
+                                 rocprim_size_keys,
+                                 next,
+                                 next_sort,
+                                 this->nrow_,
+                                 0,
+                                 8 * sizeof(int),
+                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        rocprim::radix_sort_pairs(NULL,
+                                  rocprim_size_pairs,
+                                  keys,
+                                  keys_sort,
+                                  next_sort,
+                                  order,
+                                  this->nrow_,
+                                  0,
+                                  8 * sizeof(unsigned long long),
+                                  HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        allocate_hip(std::max(rocprim_size_keys, rocprim_size_pairs), &rocprim_buffer);
+
+        // The BFS starts at the first column entry of the first row
+        int head  = 0;
+        int label = 0;
+
+        copy_d2h(1, this->mat_.col, &head);
+        copy_h2d(1, &head, order);
+        copy_h2d(1, &label, cast_perm->vec_ + head);
+
+        int level_begin = 0;
+        int level_size  = 1;
+        int nlabel      = 1;
+
+        // Level-synchronous BFS, each level is ordered by the labels of the parents
+        // and by the degree of the vertices
+        while(level_size > 0)
         {
-            assert(out != NULL);
-            assert(this->L_mat_descr_ != 0);
-            assert(this->mat_info_itsv_ != 0);
-            assert(this->ncol_ == this->nrow_);
-            assert(this->mat_buffer_size_ > 0);
-            assert(this->mat_buffer_ != NULL);
+            set_to_zero_hip(this->local_backend_.HIP_block_size, 1, next_size);
 
-            const HIPAcceleratorVector<ValueType>* cast_in
-                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
-            HIPAcceleratorVector<ValueType>* cast_out
-                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+            dim3 LevelGridSize(level_size / this->local_backend_.HIP_block_size + 1);
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
-            assert(cast_in->size_ == this->ncol_);
-            assert(cast_out->size_ == this->nrow_);
+            kernel_csr_cmk_expand<<<LevelGridSize,
+                                    BlockSize,
+                                    0,
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_,
+                level_begin,
+                level_size,
+                this->mat_.row_offset,
+                this->mat_.col,
+                order,
+                cast_perm->vec_,
+                parent,
+                next,
+                next_size);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            rocsparse_status status;
+            int size = 0;
+            copy_d2h(1, next_size, &size);
 
-            const ValueType                   alpha = static_cast<ValueType>(1);
-            const numeric_traits_t<ValueType> temp_tol
-                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+            if(size == 0)
+            {
+                break;
+            }
 
-            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+            // Vertices are appended in arbitrary order, sort them by index first, such
+            // that the ordering is deterministic
+            size_t buffer_size = rocprim_size_keys;
+            rocprim::radix_sort_keys(rocprim_buffer,
+                                     buffer_size,
+                                     next,
+                                     next_sort,
+                                     size,
+                                     0,
+                                     8 * sizeof(int),
+                                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+            dim3 NextGridSize(size / this->local_backend_.HIP_block_size + 1);
 
-            // Solve L
-            status
-                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          &max_iter,
-                                          tol_ptr,
-                                          nullptr,
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          &alpha,
-                                          this->L_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_itsv_,
-                                          cast_in->vec_,
-                                          cast_out->vec_,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            kernel_csr_cmk_keys<<<NextGridSize,
+                                  BlockSize,
+                                  0,
+                                  HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                size, this->mat_.row_offset, next_sort, parent, keys);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            buffer_size = rocprim_size_pairs;
+            rocprim::radix_sort_pairs(rocprim_buffer,
+                                      buffer_size,
+                                      keys,
+                                      keys_sort,
+                                      next_sort,
+                                      order + nlabel,
+                                      size,
+                                      0,
+                                      8 * sizeof(unsigned long long),
+                                      HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            kernel_csr_cmk_label<<<NextGridSize,
+                                   BlockSize,
+                                   0,
+                                   HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                size, nlabel, order + nlabel, cast_perm->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            level_begin = nlabel;
+            level_size  = size;
+            nlabel += size;
+        }
+
+        free_hip(&rocprim_buffer);
+
+        // Vertices that are not connected to the first row are labeled in their natural
+        // order, like on the host
+        if(nlabel < this->nrow_)
+        {
+            kernel_csr_cmk_unlabeled<<<GridSize,
+                                       BlockSize,
+                                       0,
+                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_, cast_perm->vec_, next);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            size_t rocprim_size;
+
+            rocprim::exclusive_scan(NULL,
+                                    rocprim_size,
+                                    next,
+                                    next_sort,
+                                    0,
+                                    this->nrow_,
+                                    rocprim::plus<int>(),
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            allocate_hip(rocprim_size, &rocprim_buffer);
+
+            rocprim::exclusive_scan(rocprim_buffer,
+                                    rocprim_size,
+                                    next,
+                                    next_sort,
+                                    0,
+                                    this->nrow_,
+                                    rocprim::plus<int>(),
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&rocprim_buffer);
+
+            kernel_csr_cmk_label_remaining<<<GridSize,
+                                             BlockSize,
+                                             0,
+                                             HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_, nlabel, next_sort, cast_perm->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
         }
 
+        free_hip(&order);
+        free_hip(&parent);
+        free_hip(&next);
+        free_hip(&next_sort);
+        free_hip(&next_size);
+        free_hip(&keys);
+        free_hip(&keys_sort);
+
         return true;
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::ItUAnalyse(bool diag_unit)
+    bool HIPAcceleratorMatrixCSR<ValueType>::RCMK(BaseVector<int>* permutation) const
     {
-        rocsparse_status status;
+        HIPAcceleratorVector<int>* cast_perm
+            = dynamic_cast<HIPAcceleratorVector<int>*>(permutation);
 
-        // U part
-        status = rocsparse_create_mat_descr(&this->U_mat_descr_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        assert(cast_perm != NULL);
 
-        status = rocsparse_set_mat_type(this->U_mat_descr_, rocsparse_matrix_type_general);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        this->CMK(cast_perm);
 
-        status = rocsparse_set_mat_index_base(this->U_mat_descr_, rocsparse_index_base_zero);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(this->nrow_ / this->local_backend_.HIP_block_size + 1);
 
-        status = rocsparse_set_mat_fill_mode(this->U_mat_descr_, rocsparse_fill_mode_upper);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        kernel_csr_rcmk_reverse<<<GridSize,
+                                  BlockSize,
+                                  0,
+                                  HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_, cast_perm->vec_);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        if(diag_unit == true)
-        {
-            status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_unit);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
-        else
-        {
-            status = rocsparse_set_mat_diag_type(this->U_mat_descr_, rocsparse_diag_type_non_unit);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
+        return true;
+    }
 
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ConnectivityOrder(BaseVector<int>* permutation) const
+    {
+        HIPAcceleratorVector<int>* cast_perm
+            = dynamic_cast<HIPAcceleratorVector<int>*>(permutation);
 
-        // Create buffer, if not already available
-        size_t buffer_size = 0;
-        status             = rocsparseTcsritsv_buffer_size(
-            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-            rocsparse_operation_none,
-            this->nrow_,
-            this->nnz_,
-            this->U_mat_descr_,
-            this->mat_.val,
-            this->mat_.row_offset,
-            this->mat_.col,
-            this->mat_info_itsv_,
-            &buffer_size);
+        assert(cast_perm != NULL);
+
+        cast_perm->Clear();
+        cast_perm->Allocate(this->nrow_);
+
+        dim3 BlockSize(this->local_backend_.HIP_block_size);
+        dim3 GridSize(this->nrow_ / this->local_backend_.HIP_block_size + 1);
+
+        int* row_nnz      = NULL;
+        int* row_nnz_sort = NULL;
+        int* identity     = NULL;
+
+        allocate_hip(this->nrow_, &row_nnz);
+        allocate_hip(this->nrow_, &row_nnz_sort);
+        allocate_hip(this->nrow_, &identity);
+
+        kernel_csr_row_nnz<<<GridSize,
+                             BlockSize,
+                             0,
+                             HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+            this->nrow_, this->mat_.row_offset, row_nnz);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        rocsparse_status status = rocsparse_create_identity_permutation(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle), this->nrow_, identity);
         CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        // Check buffer size
-        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
-        {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
-        }
+        // Stable sort of the rows by their number of entries
+        size_t rocprim_size;
+        char*  rocprim_buffer = NULL;
+
+        rocprim::radix_sort_pairs(NULL,
+                                  rocprim_size,
+                                  row_nnz,
+                                  row_nnz_sort,
+                                  identity,
+                                  cast_perm->vec_,
+                                  this->nrow_,
+                                  0,
+                                  8 * sizeof(int),
+                                  HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        if(this->mat_buffer_ == NULL)
-        {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_hip(buffer_size, &this->mat_buffer_);
-        }
+        allocate_hip(rocprim_size, &rocprim_buffer);
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
+        rocprim::radix_sort_pairs(rocprim_buffer,
+                                  rocprim_size,
+                                  row_nnz,
+                                  row_nnz_sort,
+                                  identity,
+                                  cast_perm->vec_,
+                                  this->nrow_,
+                                  0,
+                                  8 * sizeof(int),
+                                  HIPSTREAM(this->local_backend_.HIP_stream_current));
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        status
-            = rocsparseTcsritsv_analysis(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                         rocsparse_operation_none,
-                                         this->nrow_,
-                                         this->nnz_,
-                                         this->U_mat_descr_,
-                                         this->mat_.val,
-                                         this->mat_.row_offset,
-                                         this->mat_.col,
-                                         this->mat_info_itsv_,
-                                         rocsparse_analysis_policy_reuse,
-                                         rocsparse_solve_policy_auto,
-                                         this->mat_buffer_);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        free_hip(&rocprim_buffer);
+        free_hip(&row_nnz);
+        free_hip(&row_nnz_sort);
+        free_hip(&identity);
+
+        return true;
     }
 
     template <typename ValueType>
-    void HIPAcceleratorMatrixCSR<ValueType>::ItUAnalyseClear(void)
+    bool HIPAcceleratorMatrixCSR<ValueType>::Scale(ValueType alpha)
     {
-        rocsparse_status status;
+        free_hip(&this->spmv_val_);
 
-        // Clear analysis info
-        if(this->U_mat_descr_ != NULL)
+        if(this->nnz_ > 0)
         {
-            status
-                = rocsparse_csritsv_clear(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          this->U_mat_descr_,
-                                          this->mat_info_itsv_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
-        }
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
 
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
-        {
-            free_hip(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            rocblas_status status;
+            status = rocblasTscal(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                                  this->nnz_,
+                                  &alpha,
+                                  this->mat_.val,
+                                  1);
+            CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
         }
 
-        this->mat_buffer_size_ = 0;
+        return true;
+    }
 
-        // Clear matrix descriptor
-        if(this->U_mat_descr_ != NULL)
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::ScaleDiagonal(ValueType alpha)
+    {
+        free_hip(&this->spmv_val_);
+
+        if(this->nnz_ > 0)
         {
-            status = rocsparse_destroy_mat_descr(this->U_mat_descr_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+            kernel_csr_scale_diagonal<<<GridSize,
+                                        BlockSize,
+                                        0,
+                                        HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow, this->mat_.row_offset, this->mat_.col, alpha, this->mat_.val);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
         }
 
-        this->U_mat_descr_ = 0;
+        return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ItUSolve(int                          max_iter,
-                                                      double                       tolerance,
-                                                      bool                         use_tol,
-                                                      const BaseVector<ValueType>& in,
-                                                      BaseVector<ValueType>*       out) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::ScaleOffDiagonal(ValueType alpha)
     {
+        free_hip(&this->spmv_val_);
+
         if(this->nnz_ > 0)
         {
-            assert(out != NULL);
-            assert(this->U_mat_descr_ != 0);
-            assert(this->mat_info_itsv_ != 0);
-            assert(this->ncol_ == this->nrow_);
-            assert(this->mat_buffer_size_ > 0);
-            assert(this->mat_buffer_ != NULL);
-
-            const HIPAcceleratorVector<ValueType>* cast_in
-                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
-            HIPAcceleratorVector<ValueType>* cast_out
-                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
-
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
-            assert(cast_in->size_ == this->ncol_);
-            assert(cast_out->size_ == this->nrow_);
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
 
-            rocsparse_status status;
+            kernel_csr_scale_offdiagonal<<<GridSize,
+                                           BlockSize,
+                                           0,
+                                           HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow, this->mat_.row_offset, this->mat_.col, alpha, this->mat_.val);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
 
-            const ValueType                   alpha = static_cast<ValueType>(1);
-            const numeric_traits_t<ValueType> temp_tol
-                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+        return true;
+    }
 
-            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::AddScalarDiagonal(ValueType alpha)
+    {
+        free_hip(&this->spmv_val_);
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+        if(this->nnz_ > 0)
+        {
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
 
-            // Solve U
-            status
-                = rocsparseTcsritsv_solve(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                          &max_iter,
-                                          tol_ptr,
-                                          nullptr,
-                                          rocsparse_operation_none,
-                                          this->nrow_,
-                                          this->nnz_,
-                                          &alpha,
-                                          this->U_mat_descr_,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          this->mat_info_itsv_,
-                                          cast_in->vec_,
-                                          cast_out->vec_,
-                                          rocsparse_solve_policy_auto,
-                                          this->mat_buffer_);
-            CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+            kernel_csr_add_diagonal<<<GridSize,
+                                      BlockSize,
+                                      0,
+                                      HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow, this->mat_.row_offset, this->mat_.col, alpha, this->mat_.val);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
         }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractDiagonal(BaseVector<ValueType>* vec_diag) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::AddScalarOffDiagonal(ValueType alpha)
     {
+        free_hip(&this->spmv_val_);
+
         if(this->nnz_ > 0)
         {
-            assert(vec_diag != NULL);
-
-            HIPAcceleratorVector<ValueType>* cast_vec_diag
-                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(vec_diag);
-
-            assert(cast_vec_diag != NULL);
-            assert(cast_vec_diag->size_ >= this->nrow_);
-
-            int     nrow            = this->nrow_;
-            int64_t avg_nnz_per_row = this->nnz_ / nrow;
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
 
-            if(avg_nnz_per_row <= 8)
-            {
-                kernel_csr_extract_diag<1>
-                    <<<dim3((this->nrow_ * 1 - 1) / this->local_backend_.HIP_block_size + 1),
-                       dim3(this->local_backend_.HIP_block_size),
-                       0,
-                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
-                                                                             this->mat_.row_offset,
-                                                                             this->mat_.col,
-                                                                             this->mat_.val,
-                                                                             cast_vec_diag->vec_);
-            }
-            else if(avg_nnz_per_row <= 16)
-            {
-                kernel_csr_extract_diag<2>
-                    <<<dim3((this->nrow_ * 2 - 1) / this->local_backend_.HIP_block_size + 1),
-                       dim3(this->local_backend_.HIP_block_size),
-                       0,
-                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
-                                                                             this->mat_.row_offset,
-                                                                             this->mat_.col,
-                                                                             this->mat_.val,
-                                                                             cast_vec_diag->vec_);
-            }
-            else if(avg_nnz_per_row <= 32)
-            {
-                kernel_csr_extract_diag<4>
-                    <<<dim3((this->nrow_ * 4 - 1) / this->local_backend_.HIP_block_size + 1),
-                       dim3(this->local_backend_.HIP_block_size),
-                       0,
-                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
-                                                                             this->mat_.row_offset,
-                                                                             this->mat_.col,
-                                                                             this->mat_.val,
-                                                                             cast_vec_diag->vec_);
-            }
-            else if(avg_nnz_per_row <= 64)
-            {
-                kernel_csr_extract_diag<8>
-                    <<<dim3((this->nrow_ * 8 - 1) / this->local_backend_.HIP_block_size + 1),
-                       dim3(this->local_backend_.HIP_block_size),
-                       0,
-                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
-                                                                             this->mat_.row_offset,
-                                                                             this->mat_.col,
-                                                                             this->mat_.val,
-                                                                             cast_vec_diag->vec_);
-            }
-            else if(avg_nnz_per_row <= 128)
-            {
-                kernel_csr_extract_diag<16>
-                    <<<dim3((this->nrow_ * 16 - 1) / this->local_backend_.HIP_block_size + 1),
-                       dim3(this->local_backend_.HIP_block_size),
-                       0,
-                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
-                                                                             this->mat_.row_offset,
-                                                                             this->mat_.col,
-                                                                             this->mat_.val,
-                                                                             cast_vec_diag->vec_);
-            }
-            else if(avg_nnz_per_row <= 256 || this->local_backend_.HIP_warp == 32)
-            {
-                kernel_csr_extract_diag<32>
-                    <<<dim3((this->nrow_ * 32 - 1) / this->local_backend_.HIP_block_size + 1),
-                       dim3(this->local_backend_.HIP_block_size),
-                       0,
-                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
-                                                                             this->mat_.row_offset,
-                                                                             this->mat_.col,
-                                                                             this->mat_.val,
-                                                                             cast_vec_diag->vec_);
-            }
-            else
-            {
-                kernel_csr_extract_diag<64>
-                    <<<dim3((this->nrow_ * 64 - 1) / this->local_backend_.HIP_block_size + 1),
-                       dim3(this->local_backend_.HIP_block_size),
-                       0,
-                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(nrow,
-                                                                             this->mat_.row_offset,
-                                                                             this->mat_.col,
-                                                                             this->mat_.val,
-                                                                             cast_vec_diag->vec_);
-            }
+            kernel_csr_add_offdiagonal<<<GridSize,
+                                         BlockSize,
+                                         0,
+                                         HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow, this->mat_.row_offset, this->mat_.col, alpha, this->mat_.val);
             CHECK_HIP_ERROR(__FILE__, __LINE__);
         }
 
@@ -3321,49 +8384,22 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractInverseDiagonal(
-        BaseVector<ValueType>* vec_inv_diag) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::AddScalar(ValueType alpha)
     {
+        free_hip(&this->spmv_val_);
+
         if(this->nnz_ > 0)
         {
-            assert(vec_inv_diag != NULL);
-
-            HIPAcceleratorVector<ValueType>* cast_vec_inv_diag
-                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(vec_inv_diag);
-
-            assert(cast_vec_inv_diag != NULL);
-            assert(cast_vec_inv_diag->size_ == this->nrow_);
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
 
-            int  nrow = this->nrow_;
             dim3 BlockSize(this->local_backend_.HIP_block_size);
-            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
-
-            int* d_detect_zero_diag = NULL;
-            allocate_hip(1, &d_detect_zero_diag);
-            set_to_zero_hip(1, 1, d_detect_zero_diag);
-
-            kernel_csr_extract_inv_diag<<<GridSize,
-                                          BlockSize,
-                                          0,
-                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-                nrow,
-                this->mat_.row_offset,
-                this->mat_.col,
-                this->mat_.val,
-                cast_vec_inv_diag->vec_,
-                d_detect_zero_diag);
-
-            int detect_zero_diag = 0;
-            copy_d2h(1, d_detect_zero_diag, &detect_zero_diag);
+            dim3 GridSize(this->nnz_ / this->local_backend_.HIP_block_size + 1);
 
-            if(detect_zero_diag == 1)
-            {
-                LOG_VERBOSE_INFO(
-                    2,
-                    "*** warning: in HIPAcceleratorMatrixCSR::ExtractInverseDiagonal() a zero has "
-                    "been detected on the diagonal. It has been replaced with one to avoid inf");
-            }
-            free_hip(&d_detect_zero_diag);
+            kernel_buffer_addscalar<<<GridSize,
+                                      BlockSize,
+                                      0,
+                                      HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nnz_, alpha, this->mat_.val);
             CHECK_HIP_ERROR(__FILE__, __LINE__);
         }
 
@@ -3371,985 +8407,1302 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractSubMatrix(int                    row_offset,
-                                                              int                    col_offset,
-                                                              int                    row_size,
-                                                              int                    col_size,
-                                                              BaseMatrix<ValueType>* mat) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::DiagonalMatrixMultR(const BaseVector<ValueType>& diag)
     {
-        assert(mat != NULL);
-
-        assert(row_offset >= 0);
-        assert(col_offset >= 0);
-
-        assert(this->nrow_ >= 0);
-        assert(this->ncol_ >= 0);
-
-        HIPAcceleratorMatrixCSR<ValueType>* cast_mat
-            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(mat);
-        assert(cast_mat != NULL);
+        free_hip(&this->spmv_val_);
 
-        PtrType mat_nnz = 0;
-
-        PtrType* row_nnz = NULL;
-        allocate_hip(row_size + 1, &row_nnz);
-
-        // compute the nnz per row in the new matrix
-
-        dim3 BlockSize(this->local_backend_.HIP_block_size);
-        dim3 GridSize(row_size / this->local_backend_.HIP_block_size + 1);
-
-        kernel_csr_extract_submatrix_row_nnz<<<
-            GridSize,
-            BlockSize,
-            0,
-            HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(this->mat_.row_offset,
-                                                                  this->mat_.col,
-                                                                  this->mat_.val,
-                                                                  row_offset,
-                                                                  col_offset,
-                                                                  row_size,
-                                                                  col_size,
-                                                                  row_nnz);
-
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        const HIPAcceleratorVector<ValueType>* cast_diag
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&diag);
 
-        // compute the new nnz by reduction
-        size_t rocprim_size;
-        char*  rocprim_buffer = NULL;
+        assert(cast_diag != NULL);
+        assert(cast_diag->size_ == this->ncol_);
 
-        rocprim::exclusive_scan(NULL,
-                                rocprim_size,
-                                row_nnz,
-                                row_nnz,
-                                0,
-                                row_size + 1,
-                                rocprim::plus<PtrType>(),
-                                HIPSTREAM(this->local_backend_.HIP_stream_current));
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        if(this->nnz_ > 0)
+        {
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
 
-        allocate_hip(rocprim_size, &rocprim_buffer);
+            kernel_csr_diagmatmult_r<<<GridSize,
+                                       BlockSize,
+                                       0,
+                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow, this->mat_.row_offset, this->mat_.col, cast_diag->vec_, this->mat_.val);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
 
-        rocprim::exclusive_scan(rocprim_buffer,
-                                rocprim_size,
-                                row_nnz,
-                                row_nnz,
-                                0,
-                                row_size + 1,
-                                rocprim::plus<PtrType>(),
-                                HIPSTREAM(this->local_backend_.HIP_stream_current));
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        return true;
+    }
 
-        free_hip(&rocprim_buffer);
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::DiagonalMatrixMultL(const BaseVector<ValueType>& diag)
+    {
+        free_hip(&this->spmv_val_);
 
-        copy_d2h(1, row_nnz + row_size, &mat_nnz);
+        const HIPAcceleratorVector<ValueType>* cast_diag
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&diag);
 
-        cast_mat->AllocateCSR(mat_nnz, row_size, col_size);
+        assert(cast_diag != NULL);
+        assert(cast_diag->size_ == this->ncol_);
 
-        // not empty submatrix
-        if(mat_nnz > 0)
+        if(this->nnz_ > 0)
         {
-            free_hip(&cast_mat->mat_.row_offset);
-            cast_mat->mat_.row_offset = row_nnz;
-            // copying the sub matrix
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
 
-            kernel_csr_extract_submatrix_copy<<<
-                GridSize,
-                BlockSize,
-                0,
-                HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(this->mat_.row_offset,
-                                                                      this->mat_.col,
-                                                                      this->mat_.val,
-                                                                      row_offset,
-                                                                      col_offset,
-                                                                      row_size,
-                                                                      col_size,
-                                                                      cast_mat->mat_.row_offset,
-                                                                      cast_mat->mat_.col,
-                                                                      cast_mat->mat_.val);
+            kernel_csr_diagmatmult_l<<<GridSize,
+                                       BlockSize,
+                                       0,
+                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow, this->mat_.row_offset, cast_diag->vec_, this->mat_.val);
             CHECK_HIP_ERROR(__FILE__, __LINE__);
         }
-        else
-        {
-            free_hip(&row_nnz);
-        }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractL(BaseMatrix<ValueType>* L) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::MatMatMult(const BaseMatrix<ValueType>& A,
+                                                        const BaseMatrix<ValueType>& B)
     {
-        assert(L != NULL);
-
-        assert(this->nrow_ > 0);
-        assert(this->ncol_ > 0);
-
-        HIPAcceleratorMatrixCSR<ValueType>* cast_L
-            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(L);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&A);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_B
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&B);
 
-        assert(cast_L != NULL);
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_B != NULL);
+        assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
+        assert(cast_mat_A->nrow_ >= 0);
+        assert(cast_mat_B->ncol_ >= 0);
+        assert(cast_mat_B->nrow_ >= 0);
 
-        cast_L->Clear();
+        this->Clear();
 
-        // compute nnz per row
-        int nrow = this->nrow_;
+        int m = cast_mat_A->nrow_;
+        int n = cast_mat_B->ncol_;
+        int k = cast_mat_B->nrow_;
 
-        allocate_hip(nrow + 1, &cast_L->mat_.row_offset);
+        int nnzC = 0;
 
-        dim3 BlockSize(this->local_backend_.HIP_block_size);
-        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+        ValueType alpha = static_cast<ValueType>(1);
 
-        kernel_csr_slower_nnz_per_row<<<GridSize,
-                                        BlockSize,
-                                        0,
-                                        HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-            nrow, this->mat_.row_offset, this->mat_.col, cast_L->mat_.row_offset);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        rocsparse_status status;
 
-        // partial sum row_nnz to obtain row_offset vector
-        size_t rocprim_size;
-        char*  rocprim_buffer = NULL;
+        size_t buffer_size = 0;
 
-        rocprim::exclusive_scan(NULL,
-                                rocprim_size,
-                                cast_L->mat_.row_offset,
-                                cast_L->mat_.row_offset,
-                                0,
-                                nrow + 1,
-                                rocprim::plus<PtrType>(),
-                                HIPSTREAM(this->local_backend_.HIP_stream_current));
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        assert(cast_mat_A->nnz_ <= std::numeric_limits<int>::max());
+        assert(cast_mat_B->nnz_ <= std::numeric_limits<int>::max());
 
-        allocate_hip(rocprim_size, &rocprim_buffer);
+        status = rocsparseTcsrgemm_buffer_size(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+            rocsparse_operation_none,
+            rocsparse_operation_none,
+            m,
+            n,
+            k,
+            &alpha,
+            cast_mat_A->mat_descr_,
+            cast_mat_A->nnz_,
+            cast_mat_A->mat_.row_offset,
+            cast_mat_A->mat_.col,
+            cast_mat_B->mat_descr_,
+            cast_mat_B->nnz_,
+            cast_mat_B->mat_.row_offset,
+            cast_mat_B->mat_.col,
+            this->mat_info_,
+            &buffer_size);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        rocprim::exclusive_scan(rocprim_buffer,
-                                rocprim_size,
-                                cast_L->mat_.row_offset,
-                                cast_L->mat_.row_offset,
-                                0,
-                                nrow + 1,
-                                rocprim::plus<PtrType>(),
-                                HIPSTREAM(this->local_backend_.HIP_stream_current));
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        char* buffer = NULL;
+        allocate_hip(buffer_size, &buffer);
+        allocate_hip(m + 1, &this->mat_.row_offset);
 
-        free_hip(&rocprim_buffer);
+        status = rocsparse_csrgemm_nnz(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                       rocsparse_operation_none,
+                                       rocsparse_operation_none,
+                                       m,
+                                       n,
+                                       k,
+                                       cast_mat_A->mat_descr_,
+                                       cast_mat_A->nnz_,
+                                       cast_mat_A->mat_.row_offset,
+                                       cast_mat_A->mat_.col,
+                                       cast_mat_B->mat_descr_,
+                                       cast_mat_B->nnz_,
+                                       cast_mat_B->mat_.row_offset,
+                                       cast_mat_B->mat_.col,
+                                       NULL,
+                                       0,
+                                       NULL,
+                                       NULL,
+                                       this->mat_descr_,
+                                       this->mat_.row_offset,
+                                       &nnzC,
+                                       this->mat_info_,
+                                       buffer);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        PtrType nnz_L;
-        copy_d2h(1, cast_L->mat_.row_offset + nrow, &nnz_L);
+        allocate_hip(nnzC, &this->mat_.col);
+        allocate_hip(nnzC, &this->mat_.val);
 
-        // allocate lower triangular part structure
-        allocate_hip(nnz_L, &cast_L->mat_.col);
-        allocate_hip(nnz_L, &cast_L->mat_.val);
+        this->nrow_ = m;
+        this->ncol_ = n;
+        this->nnz_  = nnzC;
 
-        // fill lower triangular part
-        kernel_csr_extract_l_triangular<<<GridSize,
-                                          BlockSize,
-                                          0,
-                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-            nrow,
-            this->mat_.row_offset,
-            this->mat_.col,
-            this->mat_.val,
-            cast_L->mat_.row_offset,
-            cast_L->mat_.col,
-            cast_L->mat_.val);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        status = rocsparseTcsrgemm(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                   rocsparse_operation_none,
+                                   rocsparse_operation_none,
+                                   m,
+                                   n,
+                                   k,
+                                   &alpha,
+                                   cast_mat_A->mat_descr_,
+                                   cast_mat_A->nnz_,
+                                   cast_mat_A->mat_.val,
+                                   cast_mat_A->mat_.row_offset,
+                                   cast_mat_A->mat_.col,
+                                   cast_mat_B->mat_descr_,
+                                   cast_mat_B->nnz_,
+                                   cast_mat_B->mat_.val,
+                                   cast_mat_B->mat_.row_offset,
+                                   cast_mat_B->mat_.col,
+                                   this->mat_descr_,
+                                   this->mat_.val,
+                                   this->mat_.row_offset,
+                                   this->mat_.col,
+                                   this->mat_info_,
+                                   buffer);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        cast_L->nrow_ = this->nrow_;
-        cast_L->ncol_ = this->ncol_;
-        cast_L->nnz_  = nnz_L;
+        this->ApplyAnalysis();
 
-        cast_L->ApplyAnalysis();
+        free_hip(&buffer);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
         return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractLDiagonal(BaseMatrix<ValueType>* L) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::NumericMatMatMult(const BaseMatrix<ValueType>& A,
+                                                               const BaseMatrix<ValueType>& B)
     {
-        assert(L != NULL);
-
-        assert(this->nrow_ > 0);
-        assert(this->ncol_ > 0);
-
-        HIPAcceleratorMatrixCSR<ValueType>* cast_L
-            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(L);
+        free_hip(&this->spmv_val_);
 
-        assert(cast_L != NULL);
-
-        cast_L->Clear();
-
-        // compute nnz per row
-        int nrow = this->nrow_;
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&A);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_B
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&B);
 
-        allocate_hip(nrow + 1, &cast_L->mat_.row_offset);
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_B != NULL);
+        assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
+        assert(this->nrow_ == cast_mat_A->nrow_);
+        assert(this->ncol_ == cast_mat_B->ncol_);
 
-        dim3 BlockSize(this->local_backend_.HIP_block_size);
-        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+        if(this->nnz_ == 0)
+        {
+            return true;
+        }
 
-        kernel_csr_lower_nnz_per_row<<<GridSize,
-                                       BlockSize,
-                                       0,
-                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-            nrow, this->mat_.row_offset, this->mat_.col, cast_L->mat_.row_offset);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        int m = cast_mat_A->nrow_;
+        int n = cast_mat_B->ncol_;
+        int k = cast_mat_B->nrow_;
 
-        // partial sum row_nnz to obtain row_offset vector
-        size_t rocprim_size;
-        char*  rocprim_buffer = NULL;
+        ValueType alpha = static_cast<ValueType>(1);
 
-        rocprim::exclusive_scan(NULL,
-                                rocprim_size,
-                                cast_L->mat_.row_offset,
-                                cast_L->mat_.row_offset,
-                                0,
-                                nrow + 1,
-                                rocprim::plus<PtrType>(),
-                                HIPSTREAM(this->local_backend_.HIP_stream_current));
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        rocsparse_status status;
 
-        allocate_hip(rocprim_size, &rocprim_buffer);
+        size_t buffer_size = 0;
 
-        rocprim::exclusive_scan(rocprim_buffer,
-                                rocprim_size,
-                                cast_L->mat_.row_offset,
-                                cast_L->mat_.row_offset,
-                                0,
-                                nrow + 1,
-                                rocprim::plus<PtrType>(),
-                                HIPSTREAM(this->local_backend_.HIP_stream_current));
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        assert(cast_mat_A->nnz_ <= std::numeric_limits<int>::max());
+        assert(cast_mat_B->nnz_ <= std::numeric_limits<int>::max());
 
-        free_hip(&rocprim_buffer);
+        status = rocsparseTcsrgemm_buffer_size(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+            rocsparse_operation_none,
+            rocsparse_operation_none,
+            m,
+            n,
+            k,
+            &alpha,
+            cast_mat_A->mat_descr_,
+            cast_mat_A->nnz_,
+            cast_mat_A->mat_.row_offset,
+            cast_mat_A->mat_.col,
+            cast_mat_B->mat_descr_,
+            cast_mat_B->nnz_,
+            cast_mat_B->mat_.row_offset,
+            cast_mat_B->mat_.col,
+            this->mat_info_,
+            &buffer_size);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        PtrType nnz_L;
-        copy_d2h(1, cast_L->mat_.row_offset + nrow, &nnz_L);
+        char* buffer = NULL;
+        allocate_hip(buffer_size, &buffer);
 
-        // allocate lower triangular part structure
-        allocate_hip(nnz_L, &cast_L->mat_.col);
-        allocate_hip(nnz_L, &cast_L->mat_.val);
+        // The structure of this is already known, skip the csrgemm_nnz stage and only
+        // compute the values
+        status = rocsparseTcsrgemm(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                   rocsparse_operation_none,
+                                   rocsparse_operation_none,
+                                   m,
+                                   n,
+                                   k,
+                                   &alpha,
+                                   cast_mat_A->mat_descr_,
+                                   cast_mat_A->nnz_,
+                                   cast_mat_A->mat_.val,
+                                   cast_mat_A->mat_.row_offset,
+                                   cast_mat_A->mat_.col,
+                                   cast_mat_B->mat_descr_,
+                                   cast_mat_B->nnz_,
+                                   cast_mat_B->mat_.val,
+                                   cast_mat_B->mat_.row_offset,
+                                   cast_mat_B->mat_.col,
+                                   this->mat_descr_,
+                                   this->mat_.val,
+                                   this->mat_.row_offset,
+                                   this->mat_.col,
+                                   this->mat_info_,
+                                   buffer);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
 
-        // fill lower triangular part
-        kernel_csr_extract_l_triangular<<<GridSize,
-                                          BlockSize,
-                                          0,
-                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-            nrow,
-            this->mat_.row_offset,
-            this->mat_.col,
-            this->mat_.val,
-            cast_L->mat_.row_offset,
-            cast_L->mat_.col,
-            cast_L->mat_.val);
+        free_hip(&buffer);
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        cast_L->nrow_ = this->nrow_;
-        cast_L->ncol_ = this->ncol_;
-        cast_L->nnz_  = nnz_L;
-
-        cast_L->ApplyAnalysis();
-
         return true;
     }
 
-    template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractU(BaseMatrix<ValueType>* U) const
+    template <unsigned int BLOCKSIZE, unsigned int WFSIZE, unsigned int HASHSIZE>
+    static void rap_nnz_launch(int            nrow,
+                               const PtrType* row_offset_R,
+                               const int*     col_R,
+                               const PtrType* row_offset_A,
+                               const int*     col_A,
+                               const PtrType* row_offset_P,
+                               const int*     col_P,
+                               PtrType*       row_nnz,
+                               hipStream_t    stream)
     {
-        assert(U != NULL);
-
-        assert(this->nrow_ > 0);
-        assert(this->ncol_ > 0);
-
-        HIPAcceleratorMatrixCSR<ValueType>* cast_U
-            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(U);
-
-        assert(cast_U != NULL);
-
-        cast_U->Clear();
-
-        // compute nnz per row
-        int nrow = this->nrow_;
-
-        allocate_hip(nrow + 1, &cast_U->mat_.row_offset);
-
-        dim3 BlockSize(this->local_backend_.HIP_block_size);
-        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+        kernel_csr_rap_nnz<BLOCKSIZE, WFSIZE, HASHSIZE>
+            <<<(nrow - 1) / (BLOCKSIZE / WFSIZE) + 1, BLOCKSIZE, 0, stream>>>(nrow,
+                                                                              row_offset_R,
+                                                                              col_R,
+                                                                              row_offset_A,
+                                                                              col_A,
+                                                                              row_offset_P,
+                                                                              col_P,
+                                                                              row_nnz);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
 
-        kernel_csr_supper_nnz_per_row<<<GridSize,
-                                        BlockSize,
-                                        0,
-                                        HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-            nrow, this->mat_.row_offset, this->mat_.col, cast_U->mat_.row_offset);
+    template <unsigned int BLOCKSIZE,
+              unsigned int WFSIZE,
+              unsigned int HASHSIZE,
+              typename ValueType>
+    static void rap_fill_launch(int              nrow,
+                                const bool*      rows,
+                                const PtrType*   row_offset_R,
+                                const int*       col_R,
+                                const ValueType* val_R,
+                                const PtrType*   row_offset_A,
+                                const int*       col_A,
+                                const ValueType* val_A,
+                                const PtrType*   row_offset_P,
+                                const int*       col_P,
+                                const ValueType* val_P,
+                                const PtrType*   row_offset_C,
+                                int*             col_C,
+                                ValueType*       val_C,
+                                hipStream_t      stream)
+    {
+        kernel_csr_rap_fill<BLOCKSIZE, WFSIZE, HASHSIZE>
+            <<<(nrow - 1) / (BLOCKSIZE / WFSIZE) + 1, BLOCKSIZE, 0, stream>>>(nrow,
+                                                                              rows,
+                                                                              row_offset_R,
+                                                                              col_R,
+                                                                              val_R,
+                                                                              row_offset_A,
+                                                                              col_A,
+                                                                              val_A,
+                                                                              row_offset_P,
+                                                                              col_P,
+                                                                              val_P,
+                                                                              row_offset_C,
+                                                                              col_C,
+                                                                              val_C);
         CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
 
-        // partial sum row_nnz to obtain row_offset vector
+    // Maximum of the first nrow entries of array, stored in array[nrow]
+    template <typename I>
+    static I rap_max_row(int nrow, I* array, hipStream_t stream)
+    {
         size_t rocprim_size;
         char*  rocprim_buffer = NULL;
 
-        rocprim::exclusive_scan(NULL,
-                                rocprim_size,
-                                cast_U->mat_.row_offset,
-                                cast_U->mat_.row_offset,
-                                0,
-                                nrow + 1,
-                                rocprim::plus<PtrType>(),
-                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        rocprim::reduce(NULL,
+                        rocprim_size,
+                        array,
+                        array + nrow,
+                        0,
+                        nrow,
+                        rocprim::maximum<I>(),
+                        stream);
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
         allocate_hip(rocprim_size, &rocprim_buffer);
 
-        rocprim::exclusive_scan(rocprim_buffer,
-                                rocprim_size,
-                                cast_U->mat_.row_offset,
-                                cast_U->mat_.row_offset,
-                                0,
-                                nrow + 1,
-                                rocprim::plus<PtrType>(),
-                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+        rocprim::reduce(rocprim_buffer,
+                        rocprim_size,
+                        array,
+                        array + nrow,
+                        0,
+                        nrow,
+                        rocprim::maximum<I>(),
+                        stream);
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
         free_hip(&rocprim_buffer);
 
-        PtrType nnz_U;
-        copy_d2h(1, cast_U->mat_.row_offset + nrow, &nnz_U);
-
-        // allocate lower triangular part structure
-        allocate_hip(nnz_U, &cast_U->mat_.col);
-        allocate_hip(nnz_U, &cast_U->mat_.val);
-
-        // fill upper triangular part
-        kernel_csr_extract_u_triangular<<<GridSize,
-                                          BlockSize,
-                                          0,
-                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-            nrow,
-            this->mat_.row_offset,
-            this->mat_.col,
-            this->mat_.val,
-            cast_U->mat_.row_offset,
-            cast_U->mat_.col,
-            cast_U->mat_.val);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        I max_row;
+        copy_d2h(1, array + nrow, &max_row);
 
-        cast_U->nrow_ = this->nrow_;
-        cast_U->ncol_ = this->ncol_;
-        cast_U->nnz_  = nnz_U;
+        return max_row;
+    }
 
-        cast_U->ApplyAnalysis();
+    // Fill the values (and columns) of C = R * A * P, where the hash table size is
+    // selected from the maximum number of entries per row of C. The map stores keys and
+    // values in static shared memory, which limits the rows of C to 2048 entries
+    template <typename ValueType>
+    static bool rap_fill(PtrType          max_row_nnz,
+                         int              nrow,
+                         const bool*      rows,
+                         const PtrType*   row_offset_R,
+                         const int*       col_R,
+                         const ValueType* val_R,
+                         const PtrType*   row_offset_A,
+                         const int*       col_A,
+                         const ValueType* val_A,
+                         const PtrType*   row_offset_P,
+                         const int*       col_P,
+                         const ValueType* val_P,
+                         const PtrType*   row_offset_C,
+                         int*             col_C,
+                         ValueType*       val_C,
+                         hipStream_t      stream)
+    {
+        if(max_row_nnz < 16)
+        {
+            rap_fill_launch<256, 8, 16>(nrow,
+                                        rows,
+                                        row_offset_R,
+                                        col_R,
+                                        val_R,
+                                        row_offset_A,
+                                        col_A,
+                                        val_A,
+                                        row_offset_P,
+                                        col_P,
+                                        val_P,
+                                        row_offset_C,
+                                        col_C,
+                                        val_C,
+                                        stream);
+        }
+        else if(max_row_nnz < 32)
+        {
+            rap_fill_launch<256, 16, 32>(nrow,
+                                         rows,
+                                         row_offset_R,
+                                         col_R,
+                                         val_R,
+                                         row_offset_A,
+                                         col_A,
+                                         val_A,
+                                         row_offset_P,
+                                         col_P,
+                                         val_P,
+                                         row_offset_C,
+                                         col_C,
+                                         val_C,
+                                         stream);
+        }
+        else if(max_row_nnz < 64)
+        {
+            rap_fill_launch<256, 32, 64>(nrow,
+                                         rows,
+                                         row_offset_R,
+                                         col_R,
+                                         val_R,
+                                         row_offset_A,
+                                         col_A,
+                                         val_A,
+                                         row_offset_P,
+                                         col_P,
+                                         val_P,
+                                         row_offset_C,
+                                         col_C,
+                                         val_C,
+                                         stream);
+        }
+        else if(max_row_nnz < 128)
+        {
+            rap_fill_launch<256, 64, 128>(nrow,
+                                          rows,
+                                          row_offset_R,
+                                          col_R,
+                                          val_R,
+                                          row_offset_A,
+                                          col_A,
+                                          val_A,
+                                          row_offset_P,
+                                          col_P,
+                                          val_P,
+                                          row_offset_C,
+                                          col_C,
+                                          val_C,
+                                          stream);
+        }
+        else if(max_row_nnz < 256)
+        {
+            rap_fill_launch<256, 64, 256>(nrow,
+                                          rows,
+                                          row_offset_R,
+                                          col_R,
+                                          val_R,
+                                          row_offset_A,
+                                          col_A,
+                                          val_A,
+                                          row_offset_P,
+                                          col_P,
+                                          val_P,
+                                          row_offset_C,
+                                          col_C,
+                                          val_C,
+                                          stream);
+        }
+        else if(max_row_nnz < 512)
+        {
+            rap_fill_launch<128, 64, 512>(nrow,
+                                          rows,
+                                          row_offset_R,
+                                          col_R,
+                                          val_R,
+                                          row_offset_A,
+                                          col_A,
+                                          val_A,
+                                          row_offset_P,
+                                          col_P,
+                                          val_P,
+                                          row_offset_C,
+                                          col_C,
+                                          val_C,
+                                          stream);
+        }
+        else if(max_row_nnz < 1024)
+        {
+            rap_fill_launch<64, 64, 1024>(nrow,
+                                          rows,
+                                          row_offset_R,
+                                          col_R,
+                                          val_R,
+                                          row_offset_A,
+                                          col_A,
+                                          val_A,
+                                          row_offset_P,
+                                          col_P,
+                                          val_P,
+                                          row_offset_C,
+                                          col_C,
+                                          val_C,
+                                          stream);
+        }
+        else if(max_row_nnz < 2048)
+        {
+            rap_fill_launch<64, 64, 2048>(nrow,
+                                          rows,
+                                          row_offset_R,
+                                          col_R,
+                                          val_R,
+                                          row_offset_A,
+                                          col_A,
+                                          val_A,
+                                          row_offset_P,
+                                          col_P,
+                                          val_P,
+                                          row_offset_C,
+                                          col_C,
+                                          val_C,
+                                          stream);
+        }
+        else
+        {
+            return false;
+        }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ExtractUDiagonal(BaseMatrix<ValueType>* U) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::TripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                                              const BaseMatrix<ValueType>& A,
+                                                              const BaseMatrix<ValueType>& P)
     {
-        assert(U != NULL);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_R
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&R);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&A);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_P
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&P);
 
-        assert(this->nrow_ > 0);
-        assert(this->ncol_ > 0);
+        assert(cast_mat_R != NULL);
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_P != NULL);
+        assert(cast_mat_R->ncol_ == cast_mat_A->nrow_);
+        assert(cast_mat_A->ncol_ == cast_mat_P->nrow_);
 
-        HIPAcceleratorMatrixCSR<ValueType>* cast_U
-            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(U);
+        int m = cast_mat_R->nrow_;
+        int n = cast_mat_P->ncol_;
 
-        assert(cast_U != NULL);
+        this->Clear();
 
-        cast_U->Clear();
+        if(cast_mat_R->nnz_ == 0 || cast_mat_A->nnz_ == 0 || cast_mat_P->nnz_ == 0)
+        {
+            this->AllocateCSR(0, m, n);
 
-        // compute nnz per row
-        int nrow = this->nrow_;
+            return true;
+        }
 
-        allocate_hip(nrow + 1, &cast_U->mat_.row_offset);
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
 
-        dim3 BlockSize(this->local_backend_.HIP_block_size);
-        dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+        PtrType* csr_row_ptr = NULL;
+        allocate_hip(m + 1, &csr_row_ptr);
 
-        kernel_csr_upper_nnz_per_row<<<GridSize,
-                                       BlockSize,
-                                       0,
-                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-            nrow, this->mat_.row_offset, this->mat_.col, cast_U->mat_.row_offset);
+        // Upper bound of the row nnz, to select the hash table size of the symbolic phase
+        kernel_csr_rap_row_bound<256><<<(m - 1) / 256 + 1, 256, 0, stream>>>(
+            m,
+            n,
+            cast_mat_R->mat_.row_offset,
+            cast_mat_R->mat_.col,
+            cast_mat_A->mat_.row_offset,
+            cast_mat_A->mat_.col,
+            cast_mat_P->mat_.row_offset,
+            csr_row_ptr);
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        // partial sum row_nnz to obtain row_offset vector
+        PtrType max_bound = rap_max_row(m, csr_row_ptr, stream);
+
+        const PtrType* R_row = cast_mat_R->mat_.row_offset;
+        const int*     R_col = cast_mat_R->mat_.col;
+        const PtrType* A_row = cast_mat_A->mat_.row_offset;
+        const int*     A_col = cast_mat_A->mat_.col;
+        const PtrType* P_row = cast_mat_P->mat_.row_offset;
+        const int*     P_col = cast_mat_P->mat_.col;
+
+        // Count non-zeros of C
+        if(max_bound < 16)
+        {
+            rap_nnz_launch<256, 8, 16>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else if(max_bound < 32)
+        {
+            rap_nnz_launch<256, 16, 32>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else if(max_bound < 64)
+        {
+            rap_nnz_launch<256, 32, 64>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else if(max_bound < 128)
+        {
+            rap_nnz_launch<256, 64, 128>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else if(max_bound < 256)
+        {
+            rap_nnz_launch<256, 64, 256>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else if(max_bound < 512)
+        {
+            rap_nnz_launch<256, 64, 512>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else if(max_bound < 1024)
+        {
+            rap_nnz_launch<256, 64, 1024>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else if(max_bound < 2048)
+        {
+            rap_nnz_launch<256, 64, 2048>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else if(max_bound < 4096)
+        {
+            rap_nnz_launch<256, 64, 4096>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else if(max_bound < 8192)
+        {
+            rap_nnz_launch<128, 64, 8192>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else if(max_bound < 16384)
+        {
+            rap_nnz_launch<64, 64, 16384>(
+                m, R_row, R_col, A_row, A_col, P_row, P_col, csr_row_ptr, stream);
+        }
+        else
+        {
+            // Exceeding maximum hash table size, fall back to two matrix products
+            free_hip(&csr_row_ptr);
+            return false;
+        }
+
+        PtrType max_row_nnz = rap_max_row(m, csr_row_ptr, stream);
+
+        if(max_row_nnz >= 2048)
+        {
+            // Exceeding maximum hash table size, fall back to two matrix products
+            free_hip(&csr_row_ptr);
+            return false;
+        }
+
+        // Exclusive sum to obtain row offsets
         size_t rocprim_size;
         char*  rocprim_buffer = NULL;
 
         rocprim::exclusive_scan(NULL,
                                 rocprim_size,
-                                cast_U->mat_.row_offset,
-                                cast_U->mat_.row_offset,
+                                csr_row_ptr,
+                                csr_row_ptr,
                                 0,
-                                nrow + 1,
+                                m + 1,
                                 rocprim::plus<PtrType>(),
-                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+                                stream);
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
         allocate_hip(rocprim_size, &rocprim_buffer);
 
         rocprim::exclusive_scan(rocprim_buffer,
                                 rocprim_size,
-                                cast_U->mat_.row_offset,
-                                cast_U->mat_.row_offset,
+                                csr_row_ptr,
+                                csr_row_ptr,
                                 0,
-                                nrow + 1,
+                                m + 1,
                                 rocprim::plus<PtrType>(),
-                                HIPSTREAM(this->local_backend_.HIP_stream_current));
+                                stream);
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
         free_hip(&rocprim_buffer);
 
-        PtrType nnz_U;
-        copy_d2h(1, cast_U->mat_.row_offset + nrow, &nnz_U);
-
-        // allocate lower triangular part structure
-        allocate_hip(nnz_U, &cast_U->mat_.col);
-        allocate_hip(nnz_U, &cast_U->mat_.val);
-
-        // fill lower triangular part
-        kernel_csr_extract_u_triangular<<<GridSize,
-                                          BlockSize,
-                                          0,
-                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-            nrow,
-            this->mat_.row_offset,
-            this->mat_.col,
-            this->mat_.val,
-            cast_U->mat_.row_offset,
-            cast_U->mat_.col,
-            cast_U->mat_.val);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
-
-        cast_U->nrow_ = this->nrow_;
-        cast_U->ncol_ = this->ncol_;
-        cast_U->nnz_  = nnz_U;
-
-        cast_U->ApplyAnalysis();
+        PtrType nnz;
+        copy_d2h(1, csr_row_ptr + m, &nnz);
+
+        int*       csr_col_ind = NULL;
+        ValueType* csr_val     = NULL;
+
+        allocate_hip(nnz, &csr_col_ind);
+        allocate_hip(nnz, &csr_val);
+
+        // The maximum row nnz has been checked above, such that the fill cannot fail
+        rap_fill(max_row_nnz,
+                 m,
+                 NULL,
+                 R_row,
+                 R_col,
+                 cast_mat_R->mat_.val,
+                 A_row,
+                 A_col,
+                 cast_mat_A->mat_.val,
+                 P_row,
+                 P_col,
+                 cast_mat_P->mat_.val,
+                 csr_row_ptr,
+                 csr_col_ind,
+                 csr_val,
+                 stream);
+
+        this->SetDataPtrCSR(&csr_row_ptr, &csr_col_ind, &csr_val, nnz, m, n);
 
         return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::MaximalIndependentSet(
-        int& size, BaseVector<int>* permutation) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::NumericTripleMatMatMult(
+        const BaseMatrix<ValueType>& R,
+        const BaseMatrix<ValueType>& A,
+        const BaseMatrix<ValueType>& P)
     {
-        assert(permutation != NULL);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_R
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&R);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&A);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_P
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&P);
 
-        HIPAcceleratorVector<int>* cast_perm
-            = dynamic_cast<HIPAcceleratorVector<int>*>(permutation);
+        assert(cast_mat_R != NULL);
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_P != NULL);
 
-        assert(cast_perm != NULL);
-        assert(this->nrow_ == this->ncol_);
+        return this->NumericTripleMatMatMult_(*cast_mat_R, *cast_mat_A, *cast_mat_P, NULL);
+    }
 
-        PtrType* h_row_offset = NULL;
-        int*     h_col        = NULL;
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::NumericTripleMatMatMultRows(
+        const BaseMatrix<ValueType>& R,
+        const BaseMatrix<ValueType>& A,
+        const BaseMatrix<ValueType>& P,
+        const BaseVector<bool>&      rows)
+    {
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_R
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&R);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&A);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_P
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&P);
+        const HIPAcceleratorVector<bool>* cast_rows
+            = dynamic_cast<const HIPAcceleratorVector<bool>*>(&rows);
 
-        allocate_host(this->nrow_ + 1, &h_row_offset);
-        allocate_host(this->nnz_, &h_col);
+        assert(cast_mat_R != NULL);
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_P != NULL);
+        assert(cast_rows != NULL);
+        assert(cast_rows->size_ == this->nrow_);
 
-        copy_d2h(this->nrow_ + 1, this->mat_.row_offset, h_row_offset);
-        copy_d2h(this->nnz_, this->mat_.col, h_col);
+        return this->NumericTripleMatMatMult_(
+            *cast_mat_R, *cast_mat_A, *cast_mat_P, cast_rows->vec_);
+    }
 
-        int* mis = NULL;
-        allocate_host(this->nrow_, &mis);
-        memset(mis, 0, sizeof(int) * this->nrow_);
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::NumericTripleMatMatMult_(
+        const HIPAcceleratorMatrixCSR<ValueType>& R,
+        const HIPAcceleratorMatrixCSR<ValueType>& A,
+        const HIPAcceleratorMatrixCSR<ValueType>& P,
+        const bool*                               rows)
+    {
+        free_hip(&this->spmv_val_);
 
-        size = 0;
+        assert(R.ncol_ == A.nrow_);
+        assert(A.ncol_ == P.nrow_);
+        assert(this->nrow_ == R.nrow_);
+        assert(this->ncol_ == P.ncol_);
 
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        if(this->nnz_ == 0)
         {
-            if(mis[ai] == 0)
-            {
-                // set the node
-                mis[ai] = 1;
-                ++size;
-
-                // remove all nbh nodes (without diagonal)
-                for(PtrType aj = h_row_offset[ai]; aj < h_row_offset[ai + 1]; ++aj)
-                {
-                    if(ai != h_col[aj])
-                    {
-                        mis[h_col[aj]] = -1;
-                    }
-                }
-            }
+            return true;
         }
 
-        int* h_perm = NULL;
-        allocate_host(this->nrow_, &h_perm);
-
-        int pos = 0;
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            if(mis[ai] == 1)
-            {
-                h_perm[ai] = pos;
-                ++pos;
-            }
-            else
-            {
-                h_perm[ai] = size + ai - pos;
-            }
-        }
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
 
-        // Check the permutation
-        //
-        //  for (int ai=0; ai<this->nrow_; ++ai) {
-        //    assert( h_perm[ai] >= 0 );
-        //    assert( h_perm[ai] < this->nrow_ );
-        //  }
+        // The structure of this is already known, only its maximum row nnz is required to
+        // select the hash table size
+        int* row_nnz = NULL;
+        allocate_hip(this->nrow_ + 1, &row_nnz);
 
-        cast_perm->Allocate(this->nrow_);
-        copy_h2d(cast_perm->size_, h_perm, cast_perm->vec_);
+        kernel_calc_row_nnz<<<(this->nrow_ - 1) / 256 + 1, 256, 0, stream>>>(
+            this->nrow_, this->mat_.row_offset, row_nnz);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        free_host(&h_row_offset);
-        free_host(&h_col);
+        int max_row_nnz = rap_max_row(this->nrow_, row_nnz, stream);
 
-        free_host(&h_perm);
-        free_host(&mis);
+        free_hip(&row_nnz);
 
-        return true;
+        // The map reproduces the sorted columns of this and overwrites the values
+        return rap_fill(static_cast<PtrType>(max_row_nnz),
+                        this->nrow_,
+                        rows,
+                        R.mat_.row_offset,
+                        R.mat_.col,
+                        R.mat_.val,
+                        A.mat_.row_offset,
+                        A.mat_.col,
+                        A.mat_.val,
+                        P.mat_.row_offset,
+                        P.mat_.col,
+                        P.mat_.val,
+                        this->mat_.row_offset,
+                        this->mat_.col,
+                        this->mat_.val,
+                        stream);
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::MultiColoring(int&             num_colors,
-                                                           int**            size_colors,
-                                                           BaseVector<int>* permutation) const
+    bool HIPAcceleratorMatrixCSR<ValueType>::CoarsenOperator(BaseMatrix<ValueType>* Ac,
+                                                             int                    nrow,
+                                                             int                    ncol,
+                                                             const BaseVector<int>& G,
+                                                             int                    Gsize,
+                                                             const int*             rG,
+                                                             int                    rGsize) const
     {
-        assert(permutation != NULL);
+        assert(Ac != NULL);
+        assert(rG != NULL);
 
-        HIPAcceleratorVector<int>* cast_perm
-            = dynamic_cast<HIPAcceleratorVector<int>*>(permutation);
+        HIPAcceleratorMatrixCSR<ValueType>* cast_Ac
+            = dynamic_cast<HIPAcceleratorMatrixCSR<ValueType>*>(Ac);
+        const HIPAcceleratorVector<int>* cast_G
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(&G);
 
-        assert(cast_perm != NULL);
+        assert(cast_Ac != NULL);
+        assert(cast_G != NULL);
+        assert(cast_G->size_ == this->ncol_);
 
-        // node colors (init value = 0 i.e. no color)
-        int*     color        = NULL;
-        PtrType* h_row_offset = NULL;
-        int*     h_col        = NULL;
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
 
-        allocate_host(this->nrow_, &color);
-        allocate_host(this->nrow_ + 1, &h_row_offset);
-        allocate_host(this->nnz_, &h_col);
+        // (Ac)_kl = sum i in G_k (sum j in G_l (a_ij)) is computed as R * A * P, where the
+        // restriction R collects the fine rows rG of each coarse row and the prolongation P
+        // maps the fine columns to the coarse columns G
+        int* rG_dev = NULL;
+        allocate_hip(Gsize * rGsize, &rG_dev);
+        copy_h2d(Gsize * rGsize, rG, rG_dev);
 
-        copy_d2h(this->nrow_ + 1, this->mat_.row_offset, h_row_offset);
-        copy_d2h(this->nnz_, this->mat_.col, h_col);
+        PtrType*   R_row_ptr = NULL;
+        int*       R_col_ind = NULL;
+        ValueType* R_val     = NULL;
 
-        /*
-        *   Create CSC
-        */
-        PtrType* csc_ptr = NULL;
-        int*     csc_ind = NULL;
+        allocate_hip(nrow + 1, &R_row_ptr);
 
-        allocate_host(this->ncol_ + 1, &csc_ptr);
-        allocate_host(this->nnz_, &csc_ind);
+        kernel_csr_coarsen_restrict_nnz<<<(nrow - 1) / 256 + 1, 256, 0, stream>>>(
+            nrow, Gsize, rGsize, rG_dev, R_row_ptr);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        set_to_zero_host(this->nrow_ + 1, csc_ptr);
+        PtrType R_nnz = csr_row_ptr_scan(nrow, R_row_ptr, stream);
 
-        for(PtrType i = 0; i < this->nnz_; ++i)
-        {
-            csc_ptr[h_col[i] + 1] += 1;
-        }
+        allocate_hip(R_nnz, &R_col_ind);
+        allocate_hip(R_nnz, &R_val);
+
+        kernel_csr_coarsen_restrict_fill<<<(nrow - 1) / 256 + 1, 256, 0, stream>>>(
+            nrow, Gsize, rGsize, rG_dev, R_row_ptr, R_col_ind, R_val);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_hip(&rG_dev);
+
+        HIPAcceleratorMatrixCSR<ValueType> R(this->local_backend_);
+        R.SetDataPtrCSR(&R_row_ptr, &R_col_ind, &R_val, R_nnz, nrow, this->nrow_);
+
+        // Coarse column indices are bounded by the larger of both sizes, as on the host
+        int size = (nrow > ncol) ? nrow : ncol;
+
+        PtrType*   P_row_ptr = NULL;
+        int*       P_col_ind = NULL;
+        ValueType* P_val     = NULL;
+
+        PtrType P_nnz = csr_prolong_from_map(
+            this->ncol_, cast_G->vec_, stream, &P_row_ptr, &P_col_ind, &P_val);
 
-        for(int i = 1; i < this->nrow_ + 1; ++i)
+        HIPAcceleratorMatrixCSR<ValueType> P(this->local_backend_);
+        P.SetDataPtrCSR(&P_row_ptr, &P_col_ind, &P_val, P_nnz, this->ncol_, size);
+
+        if(R_nnz == 0 || P_nnz == 0)
         {
-            csc_ptr[i] += csc_ptr[i - 1];
+            cast_Ac->Clear();
+            cast_Ac->AllocateCSR(0, nrow, size);
+
+            return true;
         }
 
-        for(int i = 0; i < this->nrow_; ++i)
+        if(cast_Ac->TripleMatMatMult(R, *this, P) == false)
         {
-            for(PtrType k = h_row_offset[i]; k < h_row_offset[i + 1]; ++k)
+            HIPAcceleratorMatrixCSR<ValueType> RA(this->local_backend_);
+
+            if(RA.MatMatMult(R, *this) == false || cast_Ac->MatMatMult(RA, P) == false)
             {
-                csc_ind[csc_ptr[h_col[k]]++] = i;
+                return false;
             }
         }
-        for(int i = this->nrow_; i > 0; --i)
-        {
-            csc_ptr[i] = csc_ptr[i - 1];
-        }
-        csc_ptr[0] = 0;
 
-        memset(color, 0, this->nrow_ * sizeof(int));
-        num_colors = 0;
-        std::vector<bool> row_col;
+        return true;
+    }
 
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            color[ai] = 1;
-            row_col.clear();
-            row_col.assign(num_colors + 2, false);
+    // Number of handshake rounds of the pairwise matching, the rows that are unmatched
+    // after the last round become singletons
+    static const int pairwise_rounds = 4;
+
+    // Pairwise matching of the rows, see kernel_csr_pairwise_candidate(). On entry, match
+    // holds -1 for the excluded and -2 for all other rows. On exit, match holds the matched
+    // row of each row, agg the aggregate numbers of the first rows of the aggregates, and
+    // the number of aggregates is returned.
+    template <bool INITIAL, typename ValueType>
+    static int csr_pairwise_matching(int              nrow,
+                                     const PtrType*   csr_row_ptr,
+                                     const int*       csr_col_ind,
+                                     const ValueType* csr_val,
+                                     double           beta,
+                                     hipStream_t      stream,
+                                     int*             match,
+                                     PtrType*         agg)
+    {
+        int* cand = NULL;
+        allocate_hip(nrow, &cand);
 
-            for(PtrType aj = h_row_offset[ai]; aj < h_row_offset[ai + 1]; ++aj)
-            {
-                if(ai != h_col[aj])
-                {
-                    row_col[color[h_col[aj]]] = true;
-                }
-            }
+        dim3 BlockSize(256);
+        dim3 GridSize((nrow - 1) / 256 + 1);
 
-            for(PtrType aj = csc_ptr[ai]; aj < csc_ptr[ai + 1]; ++aj)
-            {
-                if(ai != csc_ind[aj])
-                {
-                    row_col[color[csc_ind[aj]]] = true;
-                }
-            }
+        for(int round = 0; round < pairwise_rounds; ++round)
+        {
+            kernel_csr_pairwise_candidate<INITIAL><<<GridSize, BlockSize, 0, stream>>>(
+                nrow, beta, csr_row_ptr, csr_col_ind, csr_val, match, cand);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            PtrType count = h_row_offset[ai + 1] - h_row_offset[ai] + csc_ptr[ai + 1] - csc_ptr[ai];
+            kernel_csr_pairwise_handshake<<<GridSize, BlockSize, 0, stream>>>(
+                nrow, cand, match);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
 
-            for(PtrType aj = 0; aj < count; ++aj)
-            {
-                if(row_col[color[ai]] == true)
-                {
-                    ++color[ai];
-                }
-                else
-                {
-                    break;
-                }
-            }
+        free_hip(&cand);
+
+        kernel_csr_pairwise_leader<<<GridSize, BlockSize, 0, stream>>>(nrow, match, agg);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            if(color[ai] > num_colors)
-            {
-                num_colors = color[ai];
-            }
-        }
+        return static_cast<int>(csr_row_ptr_scan(nrow, agg, stream));
+    }
 
-        free_host(&h_row_offset);
-        free_host(&h_col);
-        free_host(&csc_ptr);
-        free_host(&csc_ind);
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::InitialPairwiseAggregation(ValueType        beta,
+                                                                        int&             nc,
+                                                                        BaseVector<int>* G,
+                                                                        int&             Gsize,
+                                                                        int**            rG,
+                                                                        int&             rGsize,
+                                                                        int ordering) const
+    {
+        assert(G != NULL);
+        assert(*rG == NULL);
 
-        allocate_host(num_colors, size_colors);
-        set_to_zero_host(num_colors, *size_colors);
+        HIPAcceleratorVector<int>* cast_G = dynamic_cast<HIPAcceleratorVector<int>*>(G);
 
-        int* offsets_color = NULL;
-        allocate_host(num_colors, &offsets_color);
-        memset(offsets_color, 0, sizeof(int) * num_colors);
+        assert(cast_G != NULL);
+        assert(cast_G->size_ == this->nrow_);
 
-        for(int i = 0; i < this->nrow_; ++i)
+        if(this->nrow_ == 0)
         {
-            ++(*size_colors)[color[i] - 1];
+            return false;
         }
 
-        int total = 0;
-        for(int i = 1; i < num_colors; ++i)
-        {
-            total += (*size_colors)[i - 1];
-            offsets_color[i] = total;
-            //   LOG_INFO("offsets = " << total);
-        }
+        // The matching is parallel and does not depend on the ordering
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
 
-        int* h_perm = NULL;
-        allocate_host(this->nrow_, &h_perm);
+        int*     match = NULL;
+        PtrType* agg   = NULL;
 
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            h_perm[i] = offsets_color[color[i] - 1];
-            ++offsets_color[color[i] - 1];
-        }
+        allocate_hip(this->nrow_, &match);
+        allocate_hip(this->nrow_ + 1, &agg);
 
-        cast_perm->Allocate(this->nrow_);
-        copy_h2d(cast_perm->size_, h_perm, cast_perm->vec_);
+        dim3 BlockSize(256);
+        dim3 GridSize((this->nrow_ - 1) / 256 + 1);
 
-        free_host(&h_perm);
-        free_host(&color);
-        free_host(&offsets_color);
+        kernel_csr_pairwise_exclude<<<GridSize, BlockSize, 0, stream>>>(
+            this->nrow_, this->mat_.row_offset, this->mat_.col, this->mat_.val, match);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        return true;
-    }
+        nc = csr_pairwise_matching<true>(this->nrow_,
+                                         this->mat_.row_offset,
+                                         this->mat_.col,
+                                         this->mat_.val,
+                                         static_cast<double>(std::real(beta)),
+                                         stream,
+                                         match,
+                                         agg);
 
-    template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::Scale(ValueType alpha)
-    {
-        if(this->nnz_ > 0)
-        {
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+        // The rows of the aggregates are returned on the host, see CoarsenOperator()
+        Gsize  = 2;
+        rGsize = nc;
 
-            rocblas_status status;
-            status = rocblasTscal(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
-                                  this->nnz_,
-                                  &alpha,
-                                  this->mat_.val,
-                                  1);
-            CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
-        }
+        int* rG_dev = NULL;
+        allocate_hip(Gsize * rGsize, &rG_dev);
 
-        return true;
-    }
+        kernel_csr_pairwise_initial_fill<<<GridSize, BlockSize, 0, stream>>>(
+            this->nrow_, rGsize, match, agg, cast_G->vec_, rG_dev);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-    template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ScaleDiagonal(ValueType alpha)
-    {
-        if(this->nnz_ > 0)
-        {
-            int  nrow = this->nrow_;
-            dim3 BlockSize(this->local_backend_.HIP_block_size);
-            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+        allocate_host(Gsize * rGsize, rG);
+        copy_d2h(Gsize * rGsize, rG_dev, *rG);
 
-            kernel_csr_scale_diagonal<<<GridSize,
-                                        BlockSize,
-                                        0,
-                                        HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-                nrow, this->mat_.row_offset, this->mat_.col, alpha, this->mat_.val);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
-        }
+        free_hip(&rG_dev);
+        free_hip(&agg);
+        free_hip(&match);
 
         return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::ScaleOffDiagonal(ValueType alpha)
+    bool HIPAcceleratorMatrixCSR<ValueType>::FurtherPairwiseAggregation(ValueType        beta,
+                                                                        int&             nc,
+                                                                        BaseVector<int>* G,
+                                                                        int&             Gsize,
+                                                                        int**            rG,
+                                                                        int&             rGsize,
+                                                                        int ordering) const
     {
-        if(this->nnz_ > 0)
-        {
-            int  nrow = this->nrow_;
-            dim3 BlockSize(this->local_backend_.HIP_block_size);
-            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+        assert(G != NULL);
+        assert(*rG != NULL);
 
-            kernel_csr_scale_offdiagonal<<<GridSize,
-                                           BlockSize,
-                                           0,
-                                           HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-                nrow, this->mat_.row_offset, this->mat_.col, alpha, this->mat_.val);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
-        }
+        HIPAcceleratorVector<int>* cast_G = dynamic_cast<HIPAcceleratorVector<int>*>(G);
 
-        return true;
-    }
+        assert(cast_G != NULL);
 
-    template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::AddScalarDiagonal(ValueType alpha)
-    {
-        if(this->nnz_ > 0)
+        if(this->nrow_ == 0)
         {
-            int  nrow = this->nrow_;
-            dim3 BlockSize(this->local_backend_.HIP_block_size);
-            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
-
-            kernel_csr_add_diagonal<<<GridSize,
-                                      BlockSize,
-                                      0,
-                                      HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-                nrow, this->mat_.row_offset, this->mat_.col, alpha, this->mat_.val);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            return false;
         }
 
-        return true;
-    }
+        // The matching is parallel and does not depend on the ordering
+        hipStream_t stream = HIPSTREAM(this->local_backend_.HIP_stream_current);
 
-    template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::AddScalarOffDiagonal(ValueType alpha)
-    {
-        if(this->nnz_ > 0)
-        {
-            int  nrow = this->nrow_;
-            dim3 BlockSize(this->local_backend_.HIP_block_size);
-            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+        int*     match = NULL;
+        PtrType* agg   = NULL;
 
-            kernel_csr_add_offdiagonal<<<GridSize,
-                                         BlockSize,
-                                         0,
-                                         HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-                nrow, this->mat_.row_offset, this->mat_.col, alpha, this->mat_.val);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
-        }
+        allocate_hip(this->nrow_, &match);
+        allocate_hip(this->nrow_ + 1, &agg);
+
+        set_to_value_hip(this->local_backend_.HIP_block_size,
+                         this->nrow_,
+                         match,
+                         -2,
+                         true,
+                         stream);
+
+        nc = csr_pairwise_matching<false>(this->nrow_,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          this->mat_.val,
+                                          static_cast<double>(std::real(beta)),
+                                          stream,
+                                          match,
+                                          agg);
+
+        // Fine rows of the coarse rows of the previous aggregation
+        int* rG_dev = NULL;
+        allocate_hip(Gsize * rGsize, &rG_dev);
+        copy_h2d(Gsize * rGsize, *rG, rG_dev);
+
+        int  rGsizec = nc;
+        int* rGc_dev = NULL;
+        allocate_hip(2 * Gsize * rGsizec, &rGc_dev);
+
+        set_to_value_hip(this->local_backend_.HIP_block_size,
+                         cast_G->size_,
+                         cast_G->vec_,
+                         -1,
+                         true,
+                         stream);
+
+        dim3 BlockSize(256);
+        dim3 GridSize((this->nrow_ - 1) / 256 + 1);
+
+        kernel_csr_pairwise_further_fill<<<GridSize, BlockSize, 0, stream>>>(
+            this->nrow_, Gsize, rGsize, rG_dev, rGsizec, match, agg, cast_G->vec_, rGc_dev);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        free_host(rG);
+
+        Gsize *= 2;
+        rGsize = rGsizec;
+
+        allocate_host(Gsize * rGsize, rG);
+        copy_d2h(Gsize * rGsize, rGc_dev, *rG);
+
+        free_hip(&rGc_dev);
+        free_hip(&rG_dev);
+        free_hip(&agg);
+        free_hip(&match);
 
         return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::AddScalar(ValueType alpha)
+    static void csr_take_product(HIPAcceleratorMatrixCSR<ValueType>* src,
+                                 HIPAcceleratorMatrixCSR<ValueType>* dst)
     {
-        if(this->nnz_ > 0)
-        {
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
 
-            dim3 BlockSize(this->local_backend_.HIP_block_size);
-            dim3 GridSize(this->nnz_ / this->local_backend_.HIP_block_size + 1);
-
-            kernel_buffer_addscalar<<<GridSize,
-                                      BlockSize,
-                                      0,
-                                      HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-                this->nnz_, alpha, this->mat_.val);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
-        }
+        int64_t nnz  = src->GetNnz();
+        int     nrow = src->GetM();
+        int     ncol = src->GetN();
 
-        return true;
+        src->LeaveDataPtrCSR(&row_offset, &col, &val);
+        dst->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::DiagonalMatrixMultR(const BaseVector<ValueType>& diag)
+    bool HIPAcceleratorMatrixCSR<ValueType>::SymbolicPower(int p)
     {
-        const HIPAcceleratorVector<ValueType>* cast_diag
-            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&diag);
-
-        assert(cast_diag != NULL);
-        assert(cast_diag->size_ == this->ncol_);
+        assert(p >= 1);
 
         if(this->nnz_ > 0)
         {
-            int  nrow = this->nrow_;
-            dim3 BlockSize(this->local_backend_.HIP_block_size);
-            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+            HIPAcceleratorMatrixCSR<ValueType> base(this->local_backend_);
+            HIPAcceleratorMatrixCSR<ValueType> tmp(this->local_backend_);
 
-            kernel_csr_diagmatmult_r<<<GridSize,
-                                       BlockSize,
-                                       0,
-                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-                nrow, this->mat_.row_offset, this->mat_.col, cast_diag->vec_, this->mat_.val);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
-        }
+            // Unit values avoid cancellation in the products
+            set_to_value_hip(this->local_backend_.HIP_block_size,
+                             this->nnz_,
+                             this->mat_.val,
+                             static_cast<ValueType>(1));
 
-        return true;
-    }
+            base.CopyFrom(*this);
 
-    template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::DiagonalMatrixMultL(const BaseVector<ValueType>& diag)
-    {
-        const HIPAcceleratorVector<ValueType>* cast_diag
-            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&diag);
+            // Square and multiply, starting below the leading bit of p, such that
+            // only O(log p) sparse products are required
+            int bit = 0;
+            while((p >> (bit + 1)) > 0)
+            {
+                ++bit;
+            }
 
-        assert(cast_diag != NULL);
-        assert(cast_diag->size_ == this->ncol_);
+            for(--bit; bit >= 0; --bit)
+            {
+                tmp.MatMatMult(*this, *this);
+                csr_take_product(&tmp, this);
 
-        if(this->nnz_ > 0)
-        {
-            int  nrow = this->nrow_;
-            dim3 BlockSize(this->local_backend_.HIP_block_size);
-            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+                if(((p >> bit) & 1) == 1)
+                {
+                    tmp.MatMatMult(*this, base);
+                    csr_take_product(&tmp, this);
+                }
 
-            kernel_csr_diagmatmult_l<<<GridSize,
-                                       BlockSize,
-                                       0,
-                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-                nrow, this->mat_.row_offset, cast_diag->vec_, this->mat_.val);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+                // Entries count paths, reset them to keep the values bounded
+                set_to_value_hip(this->local_backend_.HIP_block_size,
+                                 this->nnz_,
+                                 this->mat_.val,
+                                 static_cast<ValueType>(1));
+            }
+
+            this->Zeros();
         }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HIPAcceleratorMatrixCSR<ValueType>::MatMatMult(const BaseMatrix<ValueType>& A,
-                                                        const BaseMatrix<ValueType>& B)
+    bool HIPAcceleratorMatrixCSR<ValueType>::FSAI(int power, const BaseMatrix<ValueType>* pattern)
     {
-        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_A
-            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&A);
-        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_B
-            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&B);
+        // Extract lower triangular pattern
+        HIPAcceleratorMatrixCSR<ValueType> L(this->local_backend_);
 
-        assert(cast_mat_A != NULL);
-        assert(cast_mat_B != NULL);
-        assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
-        assert(cast_mat_A->nrow_ >= 0);
-        assert(cast_mat_B->ncol_ >= 0);
-        assert(cast_mat_B->nrow_ >= 0);
+        if(pattern != NULL)
+        {
+            const HIPAcceleratorMatrixCSR<ValueType>* cast_pattern
+                = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(pattern);
 
-        this->Clear();
+            assert(cast_pattern != NULL);
 
-        int m = cast_mat_A->nrow_;
-        int n = cast_mat_B->ncol_;
-        int k = cast_mat_B->nrow_;
+            cast_pattern->ExtractLDiagonal(&L);
+        }
+        else if(power > 1)
+        {
+            HIPAcceleratorMatrixCSR<ValueType> structure(this->local_backend_);
+            structure.CopyFrom(*this);
+            structure.SymbolicPower(power);
+            structure.ExtractLDiagonal(&L);
+        }
+        else
+        {
+            this->ExtractLDiagonal(&L);
+        }
 
-        int nnzC = 0;
+        bool* d_overflow = NULL;
+        allocate_hip(1, &d_overflow);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, 1, d_overflow);
 
-        ValueType alpha = static_cast<ValueType>(1);
+        // One block per row, the small dense systems are solved in shared memory
+        kernel_csr_fsai<64, 32>
+            <<<dim3(this->nrow_),
+               dim3(64),
+               0,
+               HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(this->nrow_,
+                                                                      this->mat_.row_offset,
+                                                                      this->mat_.col,
+                                                                      this->mat_.val,
+                                                                      L.mat_.row_offset,
+                                                                      L.mat_.col,
+                                                                      L.mat_.val,
+                                                                      d_overflow);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        rocsparse_status status;
+        bool overflow;
+        copy_d2h(1, d_overflow, &overflow);
+        free_hip(&d_overflow);
 
-        size_t buffer_size = 0;
+        // Patterns with long rows are computed on the host
+        if(overflow == true)
+        {
+            return false;
+        }
 
-        assert(cast_mat_A->nnz_ <= std::numeric_limits<int>::max());
-        assert(cast_mat_B->nnz_ <= std::numeric_limits<int>::max());
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
 
-        status = rocsparseTcsrgemm_buffer_size(
-            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-            rocsparse_operation_none,
-            rocsparse_operation_none,
-            m,
-            n,
-            k,
-            &alpha,
-            cast_mat_A->mat_descr_,
-            cast_mat_A->nnz_,
-            cast_mat_A->mat_.row_offset,
-            cast_mat_A->mat_.col,
-            cast_mat_B->mat_descr_,
-            cast_mat_B->nnz_,
-            cast_mat_B->mat_.row_offset,
-            cast_mat_B->mat_.col,
-            this->mat_info_,
-            &buffer_size);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        int64_t nnz  = L.nnz_;
+        int     nrow = L.nrow_;
+        int     ncol = L.ncol_;
 
-        char* buffer = NULL;
-        allocate_hip(buffer_size, &buffer);
-        allocate_hip(m + 1, &this->mat_.row_offset);
+        L.LeaveDataPtrCSR(&row_offset, &col, &val);
 
-        status = rocsparse_csrgemm_nnz(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                       rocsparse_operation_none,
-                                       rocsparse_operation_none,
-                                       m,
-                                       n,
-                                       k,
-                                       cast_mat_A->mat_descr_,
-                                       cast_mat_A->nnz_,
-                                       cast_mat_A->mat_.row_offset,
-                                       cast_mat_A->mat_.col,
-                                       cast_mat_B->mat_descr_,
-                                       cast_mat_B->nnz_,
-                                       cast_mat_B->mat_.row_offset,
-                                       cast_mat_B->mat_.col,
-                                       NULL,
-                                       0,
-                                       NULL,
-                                       NULL,
-                                       this->mat_descr_,
-                                       this->mat_.row_offset,
-                                       &nnzC,
-                                       this->mat_info_,
-                                       buffer);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        this->Clear();
+        this->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
+
+        return true;
+    }
 
-        allocate_hip(nnzC, &this->mat_.col);
-        allocate_hip(nnzC, &this->mat_.val);
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::SPAI(void)
+    {
+        assert(this->nrow_ == this->ncol_);
 
-        this->nrow_ = m;
-        this->ncol_ = n;
-        this->nnz_  = nnzC;
+        if(this->nnz_ == 0)
+        {
+            return true;
+        }
 
-        status = rocsparseTcsrgemm(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
-                                   rocsparse_operation_none,
-                                   rocsparse_operation_none,
-                                   m,
-                                   n,
-                                   k,
-                                   &alpha,
-                                   cast_mat_A->mat_descr_,
-                                   cast_mat_A->nnz_,
-                                   cast_mat_A->mat_.val,
-                                   cast_mat_A->mat_.row_offset,
-                                   cast_mat_A->mat_.col,
-                                   cast_mat_B->mat_descr_,
-                                   cast_mat_B->nnz_,
-                                   cast_mat_B->mat_.val,
-                                   cast_mat_B->mat_.row_offset,
-                                   cast_mat_B->mat_.col,
-                                   this->mat_descr_,
-                                   this->mat_.val,
-                                   this->mat_.row_offset,
-                                   this->mat_.col,
-                                   this->mat_info_,
-                                   buffer);
-        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+        // The columns of A are the rows of its transpose
+        HIPAcceleratorMatrixCSR<ValueType> T(this->local_backend_);
+        this->Transpose(&T);
 
-        this->ApplyAnalysis();
+        ValueType* val        = NULL;
+        bool*      d_overflow = NULL;
 
-        free_hip(&buffer);
+        allocate_hip(T.nnz_, &val);
+        allocate_hip(1, &d_overflow);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, 1, d_overflow);
+
+        // One block per column, the least squares problems are solved in shared memory
+        kernel_csr_spai<64, 128, 32>
+            <<<dim3(this->nrow_),
+               dim3(64),
+               0,
+               HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_, T.mat_.row_offset, T.mat_.col, T.mat_.val, val, d_overflow);
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
+        bool overflow;
+        copy_d2h(1, d_overflow, &overflow);
+        free_hip(&d_overflow);
+
+        // Columns with large patterns are computed on the host
+        if(overflow == true)
+        {
+            free_hip(&val);
+
+            return false;
+        }
+
+        // M^T has the pattern of A^T, its rows are the least squares solutions
+        copy_d2d(T.nnz_, val, T.mat_.val);
+        free_hip(&val);
+
+        T.Transpose(this);
+
         return true;
     }
 
@@ -4480,6 +9833,144 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::SymbolicMatrixAdd(const BaseMatrix<ValueType>& A,
+                                                               const BaseMatrix<ValueType>& B)
+    {
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&A);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_B
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&B);
+
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_B != NULL);
+        assert(cast_mat_A->nrow_ == cast_mat_B->nrow_);
+        assert(cast_mat_A->ncol_ == cast_mat_B->ncol_);
+
+        int        m          = cast_mat_A->nrow_;
+        int        n          = cast_mat_A->ncol_;
+        PtrType*   csrRowPtrC = NULL;
+        int*       csrColC    = NULL;
+        ValueType* csrValC    = NULL;
+        PtrType    nnzC;
+
+        allocate_hip(m + 1, &csrRowPtrC);
+
+        rocsparse_status status = rocsparse_set_pointer_mode(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle), rocsparse_pointer_mode_host);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        status = rocsparse_csrgeam_nnz(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                       m,
+                                       n,
+                                       cast_mat_A->mat_descr_,
+                                       cast_mat_A->nnz_,
+                                       cast_mat_A->mat_.row_offset,
+                                       cast_mat_A->mat_.col,
+                                       cast_mat_B->mat_descr_,
+                                       cast_mat_B->nnz_,
+                                       cast_mat_B->mat_.row_offset,
+                                       cast_mat_B->mat_.col,
+                                       this->mat_descr_,
+                                       csrRowPtrC,
+                                       &nnzC);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        allocate_hip(nnzC, &csrColC);
+        allocate_hip(nnzC, &csrValC);
+
+        // rocSPARSE computes the column indices only together with the values, they are
+        // overwritten by the numeric phase
+        ValueType one = static_cast<ValueType>(1);
+
+        status = rocsparseTcsrgeam(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                   m,
+                                   n,
+                                   // A
+                                   &one,
+                                   cast_mat_A->mat_descr_,
+                                   cast_mat_A->nnz_,
+                                   cast_mat_A->mat_.val,
+                                   cast_mat_A->mat_.row_offset,
+                                   cast_mat_A->mat_.col,
+                                   // B
+                                   &one,
+                                   cast_mat_B->mat_descr_,
+                                   cast_mat_B->nnz_,
+                                   cast_mat_B->mat_.val,
+                                   cast_mat_B->mat_.row_offset,
+                                   cast_mat_B->mat_.col,
+                                   // C
+                                   this->mat_descr_,
+                                   csrValC,
+                                   csrRowPtrC,
+                                   csrColC);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        this->Clear();
+        this->SetDataPtrCSR(&csrRowPtrC, &csrColC, &csrValC, nnzC, m, n);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::NumericMatrixAdd(const BaseMatrix<ValueType>& A,
+                                                              ValueType                    alpha,
+                                                              const BaseMatrix<ValueType>& B,
+                                                              ValueType                    beta)
+    {
+        free_hip(&this->spmv_val_);
+
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&A);
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_B
+            = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&B);
+
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_B != NULL);
+        assert(cast_mat_A->nrow_ == this->nrow_);
+        assert(cast_mat_A->ncol_ == this->ncol_);
+        assert(cast_mat_B->nrow_ == this->nrow_);
+        assert(cast_mat_B->ncol_ == this->ncol_);
+
+        if(this->nnz_ == 0)
+        {
+            return true;
+        }
+
+        rocsparse_status status = rocsparse_set_pointer_mode(
+            ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle), rocsparse_pointer_mode_host);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        // The structure of this is already known, skip the csrgeam_nnz stage and the
+        // allocation of the sum and only compute the values
+        status = rocsparseTcsrgeam(ROCSPARSE_HANDLE(this->local_backend_.ROC_sparse_handle),
+                                   this->nrow_,
+                                   this->ncol_,
+                                   // A
+                                   &alpha,
+                                   cast_mat_A->mat_descr_,
+                                   cast_mat_A->nnz_,
+                                   cast_mat_A->mat_.val,
+                                   cast_mat_A->mat_.row_offset,
+                                   cast_mat_A->mat_.col,
+                                   // B
+                                   &beta,
+                                   cast_mat_B->mat_descr_,
+                                   cast_mat_B->nnz_,
+                                   cast_mat_B->mat_.val,
+                                   cast_mat_B->mat_.row_offset,
+                                   cast_mat_B->mat_.col,
+                                   // C
+                                   this->mat_descr_,
+                                   this->mat_.val,
+                                   this->mat_.row_offset,
+                                   this->mat_.col);
+        CHECK_ROCSPARSE_ERROR(status, __FILE__, __LINE__);
+
+        return true;
+    }
+
     template <typename ValueType>
     bool HIPAcceleratorMatrixCSR<ValueType>::Compress(double drop_off)
     {
@@ -4569,6 +10060,110 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixCSR<ValueType>::CompressLumped(double drop_off)
+    {
+        assert(this->nrow_ == this->ncol_);
+
+        if(this->nnz_ > 0)
+        {
+            HIPAcceleratorMatrixCSR<ValueType> tmp(this->local_backend_);
+
+            tmp.CopyFrom(*this);
+
+            int     nrow    = this->nrow_;
+            PtrType mat_nnz = 0;
+
+            ValueType* diag = NULL;
+            allocate_hip(nrow, &diag);
+
+            PtrType* row_nnz = NULL;
+            allocate_hip(nrow + 1, &row_nnz);
+
+            PtrType* mat_row_offset = NULL;
+            allocate_hip(nrow + 1, &mat_row_offset);
+
+            set_to_zero_hip(this->local_backend_.HIP_block_size, nrow, diag);
+            set_to_zero_hip(this->local_backend_.HIP_block_size, nrow + 1, row_nnz);
+
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+            // The drop criterion is relative to the diagonal entries
+            kernel_csr_extract_diag<1><<<GridSize,
+                                         BlockSize,
+                                         0,
+                                         HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow, tmp.mat_.row_offset, tmp.mat_.col, tmp.mat_.val, diag);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            kernel_csr_compress_lumped_count_nrow<<<
+                GridSize,
+                BlockSize,
+                0,
+                HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                tmp.mat_.row_offset, tmp.mat_.col, tmp.mat_.val, diag, nrow, drop_off, row_nnz);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            size_t rocprim_size;
+            char*  rocprim_buffer = NULL;
+
+            rocprim::exclusive_scan(NULL,
+                                    rocprim_size,
+                                    row_nnz,
+                                    mat_row_offset,
+                                    0,
+                                    nrow + 1,
+                                    rocprim::plus<PtrType>(),
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            allocate_hip(rocprim_size, &rocprim_buffer);
+
+            rocprim::exclusive_scan(rocprim_buffer,
+                                    rocprim_size,
+                                    row_nnz,
+                                    mat_row_offset,
+                                    0,
+                                    nrow + 1,
+                                    rocprim::plus<PtrType>(),
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&rocprim_buffer);
+
+            // get the new mat nnz
+            copy_d2h(1, mat_row_offset + nrow, &mat_nnz);
+
+            this->AllocateCSR(mat_nnz, nrow, this->ncol_);
+
+            copy_d2d(nrow + 1, mat_row_offset, this->mat_.row_offset);
+
+            kernel_csr_compress_lumped_copy<<<GridSize,
+                                              BlockSize,
+                                              0,
+                                              HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                tmp.mat_.row_offset,
+                tmp.mat_.col,
+                tmp.mat_.val,
+                diag,
+                nrow,
+                drop_off,
+                this->mat_.row_offset,
+                this->mat_.col,
+                this->mat_.val);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&diag);
+            free_hip(&row_nnz);
+            free_hip(&mat_row_offset);
+        }
+
+        this->ApplyAnalysis();
+
+        return true;
+    }
+
     template <typename ValueType>
     bool HIPAcceleratorMatrixCSR<ValueType>::Transpose(void)
     {
@@ -4643,6 +10238,9 @@ namespace rocalution
     bool HIPAcceleratorMatrixCSR<ValueType>::ReplaceColumnVector(int                          idx,
                                                                  const BaseVector<ValueType>& vec)
     {
+        free_hip(&this->spmv_val_);
+        this->InvalidateSpMVStructure_();
+
         if(this->nnz_ > 0)
         {
             const HIPAcceleratorVector<ValueType>* cast_vec
@@ -4968,7 +10566,7 @@ namespace rocalution
                                                                   this->mat_.row_offset);
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        void*  buffer = NULL;
+        char*  buffer = NULL;
         size_t size   = 0;
 
         // Exclusive sum to obtain pointers
@@ -4980,8 +10578,7 @@ namespace rocalution
                              HIPSTREAM(this->local_backend_.HIP_stream_current));
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        hipMalloc(&buffer, size);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        allocate_hip(size, &buffer);
 
         rocprimTexclusivesum(buffer,
                              size,
@@ -4991,8 +10588,7 @@ namespace rocalution
                              HIPSTREAM(this->local_backend_.HIP_stream_current));
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        hipFree(buffer);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        free_hip(&buffer);
 
         // Fill
         kernel_csr_merge_interior_ghost_nnz<<<(this->nrow_ - 1) / 256 + 1,
@@ -9110,7 +14706,7 @@ namespace rocalution
 
         // Exclusive scan
         size_t rocprim_size;
-        void*  rocprim_buffer = NULL;
+        char*  rocprim_buffer = NULL;
 
         rocprim::exclusive_scan(rocprim_buffer,
                                 rocprim_size,
@@ -9120,7 +14716,7 @@ namespace rocalution
                                 ext_nnz + 1,
                                 rocprim::plus<int>(),
                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
-        hipMalloc(&rocprim_buffer, rocprim_size);
+        allocate_hip(rocprim_size, &rocprim_buffer);
         rocprim::exclusive_scan(rocprim_buffer,
                                 rocprim_size,
                                 workspace,
@@ -9129,7 +14725,7 @@ namespace rocalution
                                 ext_nnz + 1,
                                 rocprim::plus<int>(),
                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
-        hipFree(rocprim_buffer);
+        free_hip(&rocprim_buffer);
         rocprim_buffer = NULL;
 
         // Fill
@@ -9182,8 +14778,7 @@ namespace rocalution
                                    HIPSTREAM(this->local_backend_.HIP_stream_current));
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        hipMalloc(&rocprim_buffer, rocprim_size);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        allocate_hip(rocprim_size, &rocprim_buffer);
 
         rocprim::run_length_encode(rocprim_buffer,
                                    rocprim_size,
@@ -9195,8 +14790,7 @@ namespace rocalution
                                    HIPSTREAM(this->local_backend_.HIP_stream_current));
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        hipFree(rocprim_buffer);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        free_hip(&rocprim_buffer);
 
         rocprim_buffer = NULL;
 
@@ -9226,8 +14820,7 @@ namespace rocalution
                                     HIPSTREAM(this->local_backend_.HIP_stream_current));
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            hipMalloc(&rocprim_buffer, rocprim_size);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            allocate_hip(rocprim_size, &rocprim_buffer);
 
             rocprim::exclusive_scan(rocprim_buffer,
                                     rocprim_size,
@@ -9239,8 +14832,7 @@ namespace rocalution
                                     HIPSTREAM(this->local_backend_.HIP_stream_current));
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            hipFree(rocprim_buffer);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            free_hip(&rocprim_buffer);
         }
 
         // Renumbered column ids
@@ -9309,7 +14901,7 @@ namespace rocalution
 
         // Exclusive sum to obtain pointers
         size_t size;
-        void*  buffer = NULL;
+        char*  buffer = NULL;
 
         rocprimTexclusivesum(buffer,
                              size,
@@ -9319,8 +14911,7 @@ namespace rocalution
                              HIPSTREAM(this->local_backend_.HIP_stream_current));
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        hipMalloc(&buffer, size);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        allocate_hip(size, &buffer);
 
         rocprimTexclusivesum(buffer,
                              size,
@@ -9336,8 +14927,7 @@ namespace rocalution
                              HIPSTREAM(this->local_backend_.HIP_stream_current));
         CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-        hipFree(buffer);
-        CHECK_HIP_ERROR(__FILE__, __LINE__);
+        free_hip(&buffer);
 
         PtrType int_nnz;
         PtrType gst_nnz;
@@ -9624,7 +15214,7 @@ namespace rocalution
 
         // Exclusive sum to obtain offsets
         size_t rocprim_size;
-        void*  rocprim_buffer = NULL;
+        char*  rocprim_buffer = NULL;
 
         rocprim::exclusive_scan(rocprim_buffer,
                                 rocprim_size,
@@ -9634,7 +15224,7 @@ namespace rocalution
                                 nrow + 1,
                                 rocprim::plus<PtrType>(),
                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
-        hipMalloc(&rocprim_buffer, rocprim_size);
+        allocate_hip(rocprim_size, &rocprim_buffer);
         rocprim::exclusive_scan(rocprim_buffer,
                                 rocprim_size,
                                 int_csr_row_ptr,
@@ -9650,7 +15240,7 @@ namespace rocalution
                                 nrow + 1,
                                 rocprim::plus<PtrType>(),
                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
-        hipFree(rocprim_buffer);
+        free_hip(&rocprim_buffer);
 
         PtrType int_nnz;
         PtrType gst_nnz;
@@ -9760,7 +15350,7 @@ namespace rocalution
 
             // Find maximum over all rows
             size_t rocprim_size;
-            void*  rocprim_buffer;
+            char*  rocprim_buffer = NULL;
 
             rocprim::reduce(NULL,
                             rocprim_size,
@@ -9772,8 +15362,7 @@ namespace rocalution
                             HIPSTREAM(this->local_backend_.HIP_stream_current));
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            hipMalloc(&rocprim_buffer, rocprim_size);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            allocate_hip(rocprim_size, &rocprim_buffer);
 
             rocprim::reduce(rocprim_buffer,
                             rocprim_size,
@@ -9785,8 +15374,7 @@ namespace rocalution
                             HIPSTREAM(this->local_backend_.HIP_stream_current));
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            hipFree(rocprim_buffer);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            free_hip(&rocprim_buffer);
 
             // Get maximum row nnz on host
             PtrType max_row_nnz;
@@ -10143,8 +15731,7 @@ namespace rocalution
                             HIPSTREAM(this->local_backend_.HIP_stream_current));
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            hipMalloc(&rocprim_buffer, rocprim_size);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            allocate_hip(rocprim_size, &rocprim_buffer);
 
             rocprim::reduce(rocprim_buffer,
                             rocprim_size,
@@ -10156,8 +15743,7 @@ namespace rocalution
                             HIPSTREAM(this->local_backend_.HIP_stream_current));
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            hipFree(rocprim_buffer);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            free_hip(&rocprim_buffer);
 
             // Get actual maximum row nnz on host
             copy_d2h(1, csr_row_ptr + nrow, &max_row_nnz);
@@ -10173,8 +15759,7 @@ namespace rocalution
                                     HIPSTREAM(this->local_backend_.HIP_stream_current));
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            hipMalloc(&rocprim_buffer, rocprim_size);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            allocate_hip(rocprim_size, &rocprim_buffer);
 
             rocprim::exclusive_scan(rocprim_buffer,
                                     rocprim_size,
@@ -10186,8 +15771,7 @@ namespace rocalution
                                     HIPSTREAM(this->local_backend_.HIP_stream_current));
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            hipFree(rocprim_buffer);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            free_hip(&rocprim_buffer);
 
             // Obtain nnz
             PtrType nnz;
@@ -29,8 +29,11 @@
 #include "../matrix_formats.hpp"
 #include "rocalution/utils/types.hpp"
 
+#include <hip/hip_runtime_api.h>
 #include <rocsparse/rocsparse.h>
 
+#include <vector>
+
 namespace rocalution
 {
 
@@ -50,18 +53,28 @@ namespace rocalution
 
         virtual void Clear(void);
         virtual bool Zeros(void);
+        virtual bool UpdateValues(const BaseVector<ValueType>& val,
+                                  const BaseVector<int>*       perm,
+                                  int64_t                      offset);
+        virtual bool AssembleValues(const BaseVector<ValueType>& val,
+                                    const BaseVector<int>&       offset,
+                                    const BaseVector<int>&       perm);
 
         virtual void AllocateCSR(int64_t nnz, int nrow, int ncol);
         virtual void SetDataPtrCSR(
             PtrType** row_offset, int** col, ValueType** val, int64_t nnz, int nrow, int ncol);
         virtual void LeaveDataPtrCSR(PtrType** row_offset, int** col, ValueType** val);
+        virtual void AttachViewCSR(
+            PtrType* row_offset, int* col, ValueType* val, int64_t nnz, int nrow, int ncol);
 
         virtual bool ConvertFrom(const BaseMatrix<ValueType>& mat);
 
         virtual void CopyFrom(const BaseMatrix<ValueType>& src);
         virtual void CopyFromAsync(const BaseMatrix<ValueType>& src);
+        virtual bool ShareStructureFrom(const BaseMatrix<ValueType>& src);
         virtual void CopyTo(BaseMatrix<ValueType>* dst) const;
         virtual void CopyToAsync(BaseMatrix<ValueType>* dst) const;
+        virtual void Prefetch(void) const;
 
         virtual void CopyFromHost(const HostMatrix<ValueType>& src);
         virtual void CopyFromHostAsync(const HostMatrix<ValueType>& src);
@@ -78,7 +91,14 @@ namespace rocalution
                                      int              nrow,
                                      int              ncol);
 
+        virtual bool ReadFileCSR(const std::string& filename);
+
+        virtual bool CreateFromMap(const BaseVector<int>& map, int n, int m);
+        virtual bool
+            CreateFromMap(const BaseVector<int>& map, int n, int m, BaseMatrix<ValueType>* pro);
+
         virtual bool Permute(const BaseVector<int>& permutation);
+        virtual bool PermuteBackward(const BaseVector<int>& permutation);
 
         virtual bool Scale(ValueType alpha);
         virtual bool ScaleDiagonal(ValueType alpha);
@@ -92,9 +112,21 @@ namespace rocalution
                                       int                    row_size,
                                       int                    col_size,
                                       BaseMatrix<ValueType>* mat) const;
+        virtual bool ExtractSubMatrices(int                     row_num_blocks,
+                                        int                     col_num_blocks,
+                                        const int*              row_offset,
+                                        const int*              col_offset,
+                                        BaseMatrix<ValueType>** mat) const;
 
         virtual bool ExtractDiagonal(BaseVector<ValueType>* vec_diag) const;
         virtual bool ExtractInverseDiagonal(BaseVector<ValueType>* vec_inv_diag) const;
+        virtual bool ExtractInverseBlockDiagonal(int                    blockdim,
+                                                 BaseMatrix<ValueType>* inv_diag) const;
+        virtual bool ExtractRowL1Norm(BaseVector<ValueType>* vec_l1) const;
+        virtual bool ExtractConnectedRows(const BaseVector<bool>& cols,
+                                          BaseVector<bool>*       rows) const;
+        virtual bool Statistics(MatrixStatistics* stats) const;
+        virtual bool Hash(uint64_t* hash) const;
         virtual bool ExtractL(BaseMatrix<ValueType>* L) const;
         virtual bool ExtractLDiagonal(BaseMatrix<ValueType>* L) const;
 
@@ -102,18 +134,65 @@ namespace rocalution
         virtual bool ExtractUDiagonal(BaseMatrix<ValueType>* U) const;
 
         virtual bool MaximalIndependentSet(int& size, BaseVector<int>* permutation) const;
+        virtual bool ZeroBlockPermutation(int& size, BaseVector<int>* permutation) const;
         virtual bool
             MultiColoring(int& num_colors, int** size_colors, BaseVector<int>* permutation) const;
 
+        virtual bool CMK(BaseVector<int>* permutation) const;
+        virtual bool RCMK(BaseVector<int>* permutation) const;
+        virtual bool ConnectivityOrder(BaseVector<int>* permutation) const;
+
         virtual bool DiagonalMatrixMultR(const BaseVector<ValueType>& diag);
         virtual bool DiagonalMatrixMultL(const BaseVector<ValueType>& diag);
 
         virtual bool MatMatMult(const BaseMatrix<ValueType>& A, const BaseMatrix<ValueType>& B);
+        virtual bool NumericMatMatMult(const BaseMatrix<ValueType>& A,
+                                       const BaseMatrix<ValueType>& B);
+        virtual bool TripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                      const BaseMatrix<ValueType>& A,
+                                      const BaseMatrix<ValueType>& P);
+        virtual bool NumericTripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                             const BaseMatrix<ValueType>& A,
+                                             const BaseMatrix<ValueType>& P);
+        virtual bool NumericTripleMatMatMultRows(const BaseMatrix<ValueType>& R,
+                                                 const BaseMatrix<ValueType>& A,
+                                                 const BaseMatrix<ValueType>& P,
+                                                 const BaseVector<bool>&      rows);
+        virtual bool InitialPairwiseAggregation(ValueType        beta,
+                                                int&             nc,
+                                                BaseVector<int>* G,
+                                                int&             Gsize,
+                                                int**            rG,
+                                                int&             rGsize,
+                                                int              ordering) const;
+        virtual bool FurtherPairwiseAggregation(ValueType        beta,
+                                                int&             nc,
+                                                BaseVector<int>* G,
+                                                int&             Gsize,
+                                                int**            rG,
+                                                int&             rGsize,
+                                                int              ordering) const;
+        virtual bool CoarsenOperator(BaseMatrix<ValueType>* Ac,
+                                     int                    nrow,
+                                     int                    ncol,
+                                     const BaseVector<int>& G,
+                                     int                    Gsize,
+                                     const int*             rG,
+                                     int                    rGsize) const;
+        virtual bool SymbolicPower(int p);
+        virtual bool FSAI(int power, const BaseMatrix<ValueType>* pattern);
+        virtual bool SPAI(void);
 
         virtual bool MatrixAdd(const BaseMatrix<ValueType>& mat,
                                ValueType                    alpha,
                                ValueType                    beta,
                                bool                         structure);
+        virtual bool SymbolicMatrixAdd(const BaseMatrix<ValueType>& A,
+                                       const BaseMatrix<ValueType>& B);
+        virtual bool NumericMatrixAdd(const BaseMatrix<ValueType>& A,
+                                      ValueType                    alpha,
+                                      const BaseMatrix<ValueType>& B,
+                                      ValueType                    beta);
 
         virtual bool ILU0Factorize(void);
         virtual bool ItILU0Factorize(ItILU0Algorithm alg,
@@ -123,6 +202,9 @@ namespace rocalution
                                      int*            niter,
                                      double*         history);
 
+        virtual bool ILUTFactorize(double t, int maxrow);
+        virtual bool ILUpFactorizeNumeric(int p, const BaseMatrix<ValueType>& mat);
+
         virtual bool ICFactorize(BaseVector<ValueType>* inv_diag = NULL);
 
         virtual void LUAnalyse(void);
@@ -184,13 +266,76 @@ namespace rocalution
 
         virtual bool Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const;
 
+        virtual void SetSpMVAlg(unsigned int alg);
+        virtual void SetSpMVStorage(unsigned int storage);
+        virtual void SetSpMVIndex(unsigned int index);
+        virtual void SetOutOfCore(int64_t chunk_nnz);
+
         void         ApplyAnalysis(void) const;
         virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
         virtual void ApplyAdd(const BaseVector<ValueType>& in,
                               ValueType                    scalar,
                               BaseVector<ValueType>*       out) const;
+        virtual bool ApplyTranspose(const BaseVector<ValueType>& in,
+                                    BaseVector<ValueType>*       out) const;
+        virtual bool ApplyTransposeAdd(const BaseVector<ValueType>& in,
+                                       ValueType                    scalar,
+                                       BaseVector<ValueType>*       out) const;
+        virtual bool ApplyAddSymmetric(const BaseVector<ValueType>& in,
+                                       ValueType                    scalar,
+                                       BaseVector<ValueType>*       out) const;
+        virtual bool
+            ApplyMulti(int ncol, const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+        virtual bool ApplyAddMulti(int                          ncol,
+                                   const BaseVector<ValueType>& in,
+                                   ValueType                    scalar,
+                                   BaseVector<ValueType>*       out) const;
+        virtual bool ApplyRows(const BaseVector<ValueType>& in,
+                               const BaseVector<int>&       rows,
+                               BaseVector<ValueType>*       out) const;
+        virtual bool ApplyAddRows(const BaseVector<ValueType>& in,
+                                  const BaseVector<int>&       rows,
+                                  ValueType                    scalar,
+                                  BaseVector<ValueType>*       out) const;
+        virtual bool ResidualRows(const BaseVector<ValueType>& rhs,
+                                  const BaseVector<ValueType>& x,
+                                  const BaseVector<int>&       rows,
+                                  BaseVector<ValueType>*       res) const;
+
+        virtual bool BatchApply(int                          batch,
+                                const BaseVector<ValueType>& val,
+                                const BaseVector<ValueType>& in,
+                                BaseVector<ValueType>*       out) const;
+        virtual bool BatchExtractInverseDiagonal(int                          batch,
+                                                 const BaseVector<ValueType>& val,
+                                                 BaseVector<ValueType>*       inv_diag) const;
+        virtual bool BatchILU0Factorize(int batch, BaseVector<ValueType>* val) const;
+        virtual bool BatchBiCGStab(int                          batch,
+                                   const BaseVector<ValueType>& val,
+                                   const BaseVector<ValueType>* inv_diag,
+                                   const BaseVector<ValueType>* lu,
+                                   const BaseVector<ValueType>& rhs,
+                                   BaseVector<ValueType>*       x,
+                                   double                       abs_tol,
+                                   double                       rel_tol,
+                                   int                          max_iter,
+                                   int*                         iter,
+                                   double*                      res) const;
+        virtual bool BatchGMRES(int                          batch,
+                                int                          basis,
+                                const BaseVector<ValueType>& val,
+                                const BaseVector<ValueType>* inv_diag,
+                                const BaseVector<ValueType>* lu,
+                                const BaseVector<ValueType>& rhs,
+                                BaseVector<ValueType>*       x,
+                                double                       abs_tol,
+                                double                       rel_tol,
+                                int                          max_iter,
+                                int*                         iter,
+                                double*                      res) const;
 
         virtual bool Compress(double drop_off);
+        virtual bool CompressLumped(double drop_off);
         virtual bool Sort(void);
 
         virtual bool ReplaceColumnVector(int idx, const BaseVector<ValueType>& vec);
@@ -457,8 +602,112 @@ namespace rocalution
                                  BaseVector<int64_t>*         global_col);
 
     private:
+        // Drop the reference to a shared sparsity pattern, freeing it if this is the last one
+        void ReleaseStructure_(void);
+        // Give the matrix its own copy of a shared sparsity pattern before modifying it
+        void DetachStructure_(void);
+        // Give the matrix its own copy of external buffers (see AttachViewCSR()) before
+        // reallocating them
+        void DetachView_(void);
+
+        // Values of this = R * A * P for the known structure of this, restricted to the
+        // flagged rows if rows is not NULL
+        bool NumericTripleMatMatMult_(const HIPAcceleratorMatrixCSR<ValueType>& R,
+                                      const HIPAcceleratorMatrixCSR<ValueType>& A,
+                                      const HIPAcceleratorMatrixCSR<ValueType>& P,
+                                      const bool*                               rows);
+
+        // out = alpha * this * in + beta * out with the selected SpMV algorithm
+        void SpMV_(ValueType                              alpha,
+                   const HIPAcceleratorVector<ValueType>& in,
+                   ValueType                              beta,
+                   HIPAcceleratorVector<ValueType>*       out) const;
+        // out = alpha * this^T * in + beta * out, returns false if not available
+        bool TransposeSpMV_(ValueType                    alpha,
+                            const BaseVector<ValueType>& in,
+                            ValueType                    beta,
+                            BaseVector<ValueType>*       out) const;
+        // Select the SpMV algorithm from the row length distribution
+        unsigned int SpMVSelect_(void) const;
+        // Release the generic SpMV descriptor and buffer
+        void SpMVClear_(void) const;
+        // Release the compressed column indices (SpMVIndex_Compressed) after the sparsity
+        // pattern changed
+        void InvalidateSpMVStructure_(void) const;
+        // Product with the entries streamed from host memory in chunks of rows
+        void SpMVOutOfCore_(ValueType                              alpha,
+                            const HIPAcceleratorVector<ValueType>& in,
+                            ValueType                              beta,
+                            HIPAcceleratorVector<ValueType>*       out) const;
+        // Row offsets of the SpMV with 32 bit indices, NULL if the non-zeros exceed 32 bits
+        const int* SpMVRowOffset_(void) const;
+        // Non-empty rows of the doubly compressed SpMV (SpMVAlg_RowList)
+        const int* SpMVRows_(void) const;
+        // Doubly compressed product, processes the non-empty rows only
+        void SpMVRowList_(ValueType                              alpha,
+                          const HIPAcceleratorVector<ValueType>& in,
+                          ValueType                              beta,
+                          HIPAcceleratorVector<ValueType>*       out) const;
+        // Reduced precision product, returns false if not available for ValueType
+        bool SpMVReduced_(ValueType                              alpha,
+                          const HIPAcceleratorVector<ValueType>& in,
+                          ValueType                              beta,
+                          HIPAcceleratorVector<ValueType>*       out) const;
+        // Product with compressed column indices, returns false if the structure does not
+        // benefit from the compression
+        bool SpMVCompressed_(ValueType                              alpha,
+                             const HIPAcceleratorVector<ValueType>& in,
+                             ValueType                              beta,
+                             HIPAcceleratorVector<ValueType>*       out) const;
+
+        // out = alpha * this * in + beta * out for a column-major block of ncol vectors
+        void SpMM_(int                                    ncol,
+                   ValueType                              alpha,
+                   const HIPAcceleratorVector<ValueType>& in,
+                   ValueType                              beta,
+                   HIPAcceleratorVector<ValueType>*       out) const;
+
+        // Batched BiCGStab (basis == 0) or GMRES(basis)
+        bool BatchSolve_(int                          batch,
+                         int                          basis,
+                         const BaseVector<ValueType>& val,
+                         const BaseVector<ValueType>* inv_diag,
+                         const BaseVector<ValueType>* lu,
+                         const BaseVector<ValueType>& rhs,
+                         BaseVector<ValueType>*       x,
+                         double                       abs_tol,
+                         double                       rel_tol,
+                         int                          max_iter,
+                         int*                         iter,
+                         double*                      res) const;
+        // Offsets of the diagonal entries, returns false if a diagonal entry is missing
+        bool BatchDiagOffset_(PtrType** diag) const;
+
+        // Gather the values of A into the pattern of this matrix, if levels is not NULL,
+        // entries of A get level 0 and fill-in entries get fill_level
+        void ILUGather_(const HIPAcceleratorMatrixCSR<ValueType>& A, int fill_level, int* levels);
+        // Remove all entries with level > p from the pattern
+        void ILUCompress_(int p, const int* levels);
+
+        // Iterative triangular solve with all sweeps in a single cooperative kernel,
+        // returns false if the device does not support cooperative launches
+        bool ItSolvePersistent_(bool             lower,
+                                bool             unit_diag,
+                                int              max_iter,
+                                double           tolerance,
+                                bool             use_tol,
+                                const ValueType* in,
+                                ValueType*       out) const;
+
         MatrixCSR<ValueType, int, PtrType> mat_;
 
+        // Number of matrices sharing row_offset and col (see ShareStructureFrom()), NULL if
+        // the pattern is not shared
+        mutable int* structure_ref_;
+
+        // True if the arrays are external buffers that are not freed by the matrix
+        bool view_;
+
         rocsparse_mat_descr L_mat_descr_;
         rocsparse_mat_descr U_mat_descr_;
         rocsparse_mat_descr mat_descr_;
@@ -470,11 +719,66 @@ namespace rocalution
         size_t mat_buffer_size_;
         char*  mat_buffer_;
 
+        // Requested SpMV algorithm (SpMVAlg) and the one selected by ApplyAnalysis()
+        unsigned int         spmv_alg_;
+        mutable unsigned int spmv_alg_sel_;
+
+        // Generic SpMV descriptor and buffer (LRB), built on first use
+        mutable rocsparse_spmat_descr spmv_descr_;
+        mutable size_t                spmv_buffer_size_;
+        mutable char*                 spmv_buffer_;
+
+        // Value storage of the SpMV (SpMVStorage) and the copy of the values in that
+        // precision, built on first use and released whenever the values change
+        unsigned int  spmv_storage_;
+        mutable char* spmv_val_;
+
+        // Column index storage of the SpMV (SpMVIndex), the base column of each row and the
+        // offsets of spmv_col_width_ bytes to it, built on first use and released by
+        // InvalidateSpMVStructure_() whenever the sparsity pattern changes. Without offsets,
+        // the structure does not benefit from the compression.
+        unsigned int  spmv_index_;
+        mutable int*  spmv_col_base_;
+        mutable char* spmv_col_off_;
+        mutable int   spmv_col_width_;
+
+        // Row offsets of the SpMV with 32 bit indices, if PtrType is 64 bit and the
+        // non-zeros fit into 32 bits, built on first use. Small matrices, e.g. coarse
+        // levels, do not pay for the width required by the largest matrix of the build.
+        mutable int* spmv_row_offset_;
+
+        // Indices of the non-empty rows of the doubly compressed SpMV, built on first use.
+        // Hyper-sparse matrices, e.g. with few coupled rows, skip their empty rows.
+        mutable int* spmv_rows_;
+        mutable int  spmv_nrows_;
+
+        // Entries per chunk of the out-of-core SpMV (SetOutOfCore()), 0 if col and val are
+        // device resident
+        int64_t ooc_chunk_nnz_;
+
+        // First row and first entry of each chunk, built on first use
+        mutable std::vector<int>     ooc_row_;
+        mutable std::vector<PtrType> ooc_offset_;
+
+        // Double buffered device staging of the chunk entries, and the streams that
+        // transfer and process the chunks alternately
+        mutable int*        ooc_col_[2];
+        mutable ValueType*  ooc_val_[2];
+        mutable hipStream_t ooc_stream_[2];
+        mutable hipEvent_t  ooc_event_[2];
+
+        // Scratch iterate and convergence slots of the persistent iterative triangular
+        // solve, built on first use
+        mutable ValueType*          itsv_buffer_;
+        mutable unsigned long long* itsv_delta_;
+
         HIPAcceleratorVector<ValueType>* tmp_vec_;
 
         friend class HIPAcceleratorMatrixCOO<ValueType>;
         friend class HIPAcceleratorMatrixDIA<ValueType>;
         friend class HIPAcceleratorMatrixELL<ValueType>;
+        friend class HIPAcceleratorMatrixSELL<ValueType>;
+        friend class HIPAcceleratorMatrixVBR<ValueType>;
         friend class HIPAcceleratorMatrixHYB<ValueType>;
         friend class HIPAcceleratorMatrixDENSE<ValueType>;
         friend class HIPAcceleratorMatrixBCSR<ValueType>;
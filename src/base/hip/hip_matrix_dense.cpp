@@ -40,6 +40,7 @@
 #include "hip_matrix_ell.hpp"
 #include "hip_matrix_hyb.hpp"
 #include "hip_matrix_mcsr.hpp"
+#include "hip_solver.hpp"
 #include "hip_utils.hpp"
 #include "hip_vector.hpp"
 
@@ -686,6 +687,294 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixDENSE<ValueType>::QRDecompose(void)
+    {
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
+        assert(this->nnz_ > 0);
+
+        if(DENSE_IND_BASE != 0)
+        {
+            return false;
+        }
+
+        int size = (this->nrow_ < this->ncol_) ? this->nrow_ : this->ncol_;
+
+        // The Householder scalars are not kept, QRSolve() recomputes them from the
+        // reflectors, which keeps the factors compatible with the host backend
+        ValueType* tau = NULL;
+        allocate_hip(size, &tau);
+
+        rocblas_status status
+            = rocsolverTgeqrf(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                              this->nrow_,
+                              this->ncol_,
+                              this->mat_.val,
+                              this->nrow_,
+                              tau);
+
+        free_hip(&tau);
+
+        if(status == rocblas_status_not_implemented)
+        {
+            return false;
+        }
+
+        CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixDENSE<ValueType>::QRSolve(const BaseVector<ValueType>& in,
+                                                       BaseVector<ValueType>*       out) const
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->nrow_);
+        assert(out->GetSize() == this->ncol_);
+
+        if(DENSE_IND_BASE != 0 || this->nrow_ < this->ncol_)
+        {
+            return false;
+        }
+
+        const HIPAcceleratorVector<ValueType>* cast_in
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+        HIPAcceleratorVector<ValueType>* cast_out
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        int size = this->ncol_;
+
+        ValueType* tau = NULL;
+        ValueType* rhs = NULL;
+        allocate_hip(size, &tau);
+        allocate_hip(this->nrow_, &rhs);
+
+        // Householder scalars
+        kernel_dense_householder_tau<256>
+            <<<size, 256, 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->nrow_, this->ncol_, this->mat_.val, tau);
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+        copy_d2d(this->nrow_,
+                 cast_in->vec_,
+                 rhs,
+                 true,
+                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+
+        // Apply Q^T on the right-hand side, ormqr does not modify the reflectors
+        rocblas_status status
+            = rocsolverTormqr(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                              rocblas_side_left,
+                              rocblas_operation_transpose,
+                              this->nrow_,
+                              1,
+                              size,
+                              this->mat_.val,
+                              this->nrow_,
+                              tau,
+                              rhs,
+                              this->nrow_);
+
+        if(status == rocblas_status_not_implemented)
+        {
+            free_hip(&tau);
+            free_hip(&rhs);
+
+            return false;
+        }
+
+        CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+        copy_d2d(size,
+                 rhs,
+                 cast_out->vec_,
+                 true,
+                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+
+        // Backsolve Rx = Q^T b
+        status = rocblasTtrsv(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                              rocblas_fill_upper,
+                              rocblas_operation_none,
+                              rocblas_diagonal_non_unit,
+                              size,
+                              this->mat_.val,
+                              this->nrow_,
+                              cast_out->vec_,
+                              1);
+        CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+        free_hip(&tau);
+        free_hip(&rhs);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixDENSE<ValueType>::LUFactorize(void)
+    {
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
+        assert(this->nnz_ > 0);
+        assert(this->nrow_ == this->ncol_);
+
+        if(DENSE_IND_BASE != 0)
+        {
+            return false;
+        }
+
+        int* d_info = NULL;
+        allocate_hip(1, &d_info);
+
+        // No pivoting, such that the factors match the host LUSolve()
+        rocblas_status status
+            = rocsolverTgetrf_npvt(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                                   this->nrow_,
+                                   this->ncol_,
+                                   this->mat_.val,
+                                   this->nrow_,
+                                   d_info);
+        CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+        int info;
+        copy_d2h(1, d_info, &info);
+        free_hip(&d_info);
+
+        if(info != 0)
+        {
+            LOG_INFO("*** warning: LUFactorize() zero pivot in row " << info - 1);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixDENSE<ValueType>::LUAnalyse(void)
+    {
+        // The dense factors need no analysis
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixDENSE<ValueType>::LUAnalyseClear(void)
+    {
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixDENSE<ValueType>::LUSolve(const BaseVector<ValueType>& in,
+                                                       BaseVector<ValueType>*       out) const
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->nrow_);
+        assert(out->GetSize() == this->ncol_);
+
+        if(DENSE_IND_BASE != 0)
+        {
+            return false;
+        }
+
+        const HIPAcceleratorVector<ValueType>* cast_in
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+        HIPAcceleratorVector<ValueType>* cast_out
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        // fill solution vector
+        copy_d2d(this->nrow_,
+                 cast_in->vec_,
+                 cast_out->vec_,
+                 true,
+                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+
+        // forward sweep with the unit lower factor
+        rocblas_status status = rocblasTtrsv(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                                             rocblas_fill_lower,
+                                             rocblas_operation_none,
+                                             rocblas_diagonal_unit,
+                                             this->nrow_,
+                                             this->mat_.val,
+                                             this->nrow_,
+                                             cast_out->vec_,
+                                             1);
+        CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+        // backward sweep with the upper factor
+        status = rocblasTtrsv(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                              rocblas_fill_upper,
+                              rocblas_operation_none,
+                              rocblas_diagonal_non_unit,
+                              this->nrow_,
+                              this->mat_.val,
+                              this->nrow_,
+                              cast_out->vec_,
+                              1);
+        CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixDENSE<ValueType>::Invert(void)
+    {
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
+        assert(this->nnz_ > 0);
+        assert(this->nrow_ == this->ncol_);
+
+        if(DENSE_IND_BASE != 0)
+        {
+            return false;
+        }
+
+        int* ipiv   = NULL;
+        int* d_info = NULL;
+        allocate_hip(this->nrow_, &ipiv);
+        allocate_hip(1, &d_info);
+
+        int info = 0;
+
+        // Partial pivoting LU, followed by the inversion of the factors
+        rocblas_status status
+            = rocsolverTgetrf(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                              this->nrow_,
+                              this->ncol_,
+                              this->mat_.val,
+                              this->nrow_,
+                              ipiv,
+                              d_info);
+        CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+        copy_d2h(1, d_info, &info);
+
+        if(info == 0)
+        {
+            status = rocsolverTgetri(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                                     this->nrow_,
+                                     this->mat_.val,
+                                     this->nrow_,
+                                     ipiv,
+                                     d_info);
+            CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+        }
+
+        free_hip(&ipiv);
+        free_hip(&d_info);
+
+        if(info != 0)
+        {
+            LOG_INFO("*** warning: Invert() matrix is singular, zero pivot in row " << info - 1);
+        }
+
+        return true;
+    }
+
     template <typename ValueType>
     bool HIPAcceleratorMatrixDENSE<ValueType>::ReplaceColumnVector(int                          idx,
                                                                    const BaseVector<ValueType>& vec)
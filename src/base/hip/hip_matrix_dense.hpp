@@ -69,6 +69,16 @@ namespace rocalution
 
         virtual bool MatMatMult(const BaseMatrix<ValueType>& A, const BaseMatrix<ValueType>& B);
 
+        virtual bool QRDecompose(void);
+        virtual bool QRSolve(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+
+        virtual bool LUFactorize(void);
+        virtual void LUAnalyse(void);
+        virtual void LUAnalyseClear(void);
+        virtual bool LUSolve(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+
+        virtual bool Invert(void);
+
         virtual bool ReplaceColumnVector(int idx, const BaseVector<ValueType>& vec);
         virtual bool ReplaceRowVector(int idx, const BaseVector<ValueType>& vec);
         virtual bool ExtractColumnVector(int idx, BaseVector<ValueType>* vec) const;
@@ -0,0 +1,625 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "hip_matrix_sell.hpp"
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/def.hpp"
+#include "../../utils/log.hpp"
+#include "../backend_manager.hpp"
+#include "../base_matrix.hpp"
+#include "../base_vector.hpp"
+#include "../host/host_matrix_sell.hpp"
+#include "../matrix_formats_ind.hpp"
+#include "hip_allocate_free.hpp"
+#include "hip_conversion.hpp"
+#include "hip_kernels_sell.hpp"
+#include "hip_matrix_csr.hpp"
+#include "hip_utils.hpp"
+#include "hip_vector.hpp"
+
+#include <hip/hip_runtime.h>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    HIPAcceleratorMatrixSELL<ValueType>::HIPAcceleratorMatrixSELL()
+    {
+        // no default constructors
+        LOG_INFO("no default constructor");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    HIPAcceleratorMatrixSELL<ValueType>::HIPAcceleratorMatrixSELL(
+        const Rocalution_Backend_Descriptor& local_backend)
+    {
+        log_debug(this,
+                  "HIPAcceleratorMatrixSELL::HIPAcceleratorMatrixSELL()",
+                  "constructor with local_backend");
+
+        this->mat_.slice_size   = _sell_slice_size;
+        this->mat_.nslice       = 0;
+        this->mat_.slice_offset = NULL;
+        this->mat_.perm         = NULL;
+        this->mat_.col          = NULL;
+        this->mat_.val          = NULL;
+        this->set_backend(local_backend);
+
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    HIPAcceleratorMatrixSELL<ValueType>::~HIPAcceleratorMatrixSELL()
+    {
+        log_debug(this, "HIPAcceleratorMatrixSELL::~HIPAcceleratorMatrixSELL()", "destructor");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::Info(void) const
+    {
+        LOG_INFO("HIPAcceleratorMatrixSELL<ValueType>"
+                 << " slice size=" << this->mat_.slice_size << " slices=" << this->mat_.nslice);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::AllocateSELL(int64_t nnz,
+                                                           int     nrow,
+                                                           int     ncol,
+                                                           int     slice_size)
+    {
+        assert(nnz >= 0);
+        assert(ncol >= 0);
+        assert(nrow >= 0);
+        assert(slice_size > 0);
+        assert(nnz % slice_size == 0);
+
+        this->Clear();
+
+        this->mat_.slice_size = slice_size;
+        this->mat_.nslice     = (nrow + slice_size - 1) / slice_size;
+
+        allocate_hip(this->mat_.nslice + 1, &this->mat_.slice_offset);
+        allocate_hip(nrow, &this->mat_.perm);
+        allocate_hip(nnz, &this->mat_.col);
+        allocate_hip(nnz, &this->mat_.val);
+
+        set_to_zero_hip(
+            this->local_backend_.HIP_block_size, this->mat_.nslice + 1, this->mat_.slice_offset);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, nrow, this->mat_.perm);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, nnz, this->mat_.col);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, nnz, this->mat_.val);
+
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+        this->nnz_  = nnz;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::Clear()
+    {
+        free_hip(&this->mat_.slice_offset);
+        free_hip(&this->mat_.perm);
+        free_hip(&this->mat_.col);
+        free_hip(&this->mat_.val);
+
+        this->mat_.nslice = 0;
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+        this->nnz_  = 0;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::CopyFromHost(const HostMatrix<ValueType>& src)
+    {
+        const HostMatrixSELL<ValueType>* cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == src.GetMatFormat());
+
+        // CPU to HIP copy
+        if((cast_mat = dynamic_cast<const HostMatrixSELL<ValueType>*>(&src)) != NULL)
+        {
+            if(this->nnz_ == 0)
+            {
+                this->AllocateSELL(
+                    cast_mat->nnz_, cast_mat->nrow_, cast_mat->ncol_, cast_mat->mat_.slice_size);
+            }
+
+            assert(this->nnz_ == cast_mat->nnz_);
+            assert(this->nrow_ == cast_mat->nrow_);
+            assert(this->ncol_ == cast_mat->ncol_);
+            assert(this->mat_.slice_size == cast_mat->mat_.slice_size);
+
+            copy_h2d(this->mat_.nslice + 1, cast_mat->mat_.slice_offset, this->mat_.slice_offset);
+            copy_h2d(this->nrow_, cast_mat->mat_.perm, this->mat_.perm);
+            copy_h2d(this->nnz_, cast_mat->mat_.col, this->mat_.col);
+            copy_h2d(this->nnz_, cast_mat->mat_.val, this->mat_.val);
+        }
+        else
+        {
+            LOG_INFO("Error unsupported HIP matrix type");
+            this->Info();
+            src.Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::CopyToHost(HostMatrix<ValueType>* dst) const
+    {
+        HostMatrixSELL<ValueType>* cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == dst->GetMatFormat());
+
+        // HIP to CPU copy
+        if((cast_mat = dynamic_cast<HostMatrixSELL<ValueType>*>(dst)) != NULL)
+        {
+            cast_mat->set_backend(this->local_backend_);
+
+            if(cast_mat->nnz_ == 0)
+            {
+                cast_mat->AllocateSELL(
+                    this->nnz_, this->nrow_, this->ncol_, this->mat_.slice_size);
+            }
+
+            assert(this->nnz_ == cast_mat->nnz_);
+            assert(this->nrow_ == cast_mat->nrow_);
+            assert(this->ncol_ == cast_mat->ncol_);
+            assert(this->mat_.slice_size == cast_mat->mat_.slice_size);
+
+            copy_d2h(this->mat_.nslice + 1, this->mat_.slice_offset, cast_mat->mat_.slice_offset);
+            copy_d2h(this->nrow_, this->mat_.perm, cast_mat->mat_.perm);
+            copy_d2h(this->nnz_, this->mat_.col, cast_mat->mat_.col);
+            copy_d2h(this->nnz_, this->mat_.val, cast_mat->mat_.val);
+        }
+        else
+        {
+            LOG_INFO("Error unsupported HIP matrix type");
+            this->Info();
+            dst->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::CopyFrom(const BaseMatrix<ValueType>& src)
+    {
+        const HIPAcceleratorMatrixSELL<ValueType>* hip_cast_mat;
+        const HostMatrix<ValueType>*               host_cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == src.GetMatFormat());
+
+        // HIP to HIP copy
+        if((hip_cast_mat = dynamic_cast<const HIPAcceleratorMatrixSELL<ValueType>*>(&src)) != NULL)
+        {
+            if(this->nnz_ == 0)
+            {
+                this->AllocateSELL(hip_cast_mat->nnz_,
+                                   hip_cast_mat->nrow_,
+                                   hip_cast_mat->ncol_,
+                                   hip_cast_mat->mat_.slice_size);
+            }
+
+            assert(this->nnz_ == hip_cast_mat->nnz_);
+            assert(this->nrow_ == hip_cast_mat->nrow_);
+            assert(this->ncol_ == hip_cast_mat->ncol_);
+            assert(this->mat_.slice_size == hip_cast_mat->mat_.slice_size);
+
+            copy_d2d(
+                this->mat_.nslice + 1, hip_cast_mat->mat_.slice_offset, this->mat_.slice_offset);
+            copy_d2d(this->nrow_, hip_cast_mat->mat_.perm, this->mat_.perm);
+            copy_d2d(this->nnz_, hip_cast_mat->mat_.col, this->mat_.col);
+            copy_d2d(this->nnz_, hip_cast_mat->mat_.val, this->mat_.val);
+        }
+        else
+        {
+            // CPU to HIP
+            if((host_cast_mat = dynamic_cast<const HostMatrix<ValueType>*>(&src)) != NULL)
+            {
+                this->CopyFromHost(*host_cast_mat);
+            }
+            else
+            {
+                LOG_INFO("Error unsupported HIP matrix type");
+                this->Info();
+                src.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::CopyTo(BaseMatrix<ValueType>* dst) const
+    {
+        HIPAcceleratorMatrixSELL<ValueType>* hip_cast_mat;
+        HostMatrix<ValueType>*               host_cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == dst->GetMatFormat());
+
+        // HIP to HIP copy
+        if((hip_cast_mat = dynamic_cast<HIPAcceleratorMatrixSELL<ValueType>*>(dst)) != NULL)
+        {
+            hip_cast_mat->CopyFrom(*this);
+        }
+        else
+        {
+            // HIP to CPU
+            if((host_cast_mat = dynamic_cast<HostMatrix<ValueType>*>(dst)) != NULL)
+            {
+                this->CopyToHost(host_cast_mat);
+            }
+            else
+            {
+                LOG_INFO("Error unsupported HIP matrix type");
+                this->Info();
+                dst->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::CopyFromHostAsync(const HostMatrix<ValueType>& src)
+    {
+        const HostMatrixSELL<ValueType>* cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == src.GetMatFormat());
+
+        // CPU to HIP copy
+        if((cast_mat = dynamic_cast<const HostMatrixSELL<ValueType>*>(&src)) != NULL)
+        {
+            if(this->nnz_ == 0)
+            {
+                this->AllocateSELL(
+                    cast_mat->nnz_, cast_mat->nrow_, cast_mat->ncol_, cast_mat->mat_.slice_size);
+            }
+
+            assert(this->nnz_ == cast_mat->nnz_);
+            assert(this->nrow_ == cast_mat->nrow_);
+            assert(this->ncol_ == cast_mat->ncol_);
+            assert(this->mat_.slice_size == cast_mat->mat_.slice_size);
+
+            copy_h2d(this->mat_.nslice + 1,
+                     cast_mat->mat_.slice_offset,
+                     this->mat_.slice_offset,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_h2d(this->nrow_,
+                     cast_mat->mat_.perm,
+                     this->mat_.perm,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_h2d(this->nnz_,
+                     cast_mat->mat_.col,
+                     this->mat_.col,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_h2d(this->nnz_,
+                     cast_mat->mat_.val,
+                     this->mat_.val,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+        }
+        else
+        {
+            LOG_INFO("Error unsupported HIP matrix type");
+            this->Info();
+            src.Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::CopyToHostAsync(HostMatrix<ValueType>* dst) const
+    {
+        HostMatrixSELL<ValueType>* cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == dst->GetMatFormat());
+
+        // HIP to CPU copy
+        if((cast_mat = dynamic_cast<HostMatrixSELL<ValueType>*>(dst)) != NULL)
+        {
+            cast_mat->set_backend(this->local_backend_);
+
+            if(cast_mat->nnz_ == 0)
+            {
+                cast_mat->AllocateSELL(
+                    this->nnz_, this->nrow_, this->ncol_, this->mat_.slice_size);
+            }
+
+            assert(this->nnz_ == cast_mat->nnz_);
+            assert(this->nrow_ == cast_mat->nrow_);
+            assert(this->ncol_ == cast_mat->ncol_);
+            assert(this->mat_.slice_size == cast_mat->mat_.slice_size);
+
+            copy_d2h(this->mat_.nslice + 1,
+                     this->mat_.slice_offset,
+                     cast_mat->mat_.slice_offset,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2h(this->nrow_,
+                     this->mat_.perm,
+                     cast_mat->mat_.perm,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2h(this->nnz_,
+                     this->mat_.col,
+                     cast_mat->mat_.col,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2h(this->nnz_,
+                     this->mat_.val,
+                     cast_mat->mat_.val,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+        }
+        else
+        {
+            LOG_INFO("Error unsupported HIP matrix type");
+            this->Info();
+            dst->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::CopyFromAsync(const BaseMatrix<ValueType>& src)
+    {
+        const HIPAcceleratorMatrixSELL<ValueType>* hip_cast_mat;
+        const HostMatrix<ValueType>*               host_cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == src.GetMatFormat());
+
+        // HIP to HIP copy
+        if((hip_cast_mat = dynamic_cast<const HIPAcceleratorMatrixSELL<ValueType>*>(&src)) != NULL)
+        {
+            if(this->nnz_ == 0)
+            {
+                this->AllocateSELL(hip_cast_mat->nnz_,
+                                   hip_cast_mat->nrow_,
+                                   hip_cast_mat->ncol_,
+                                   hip_cast_mat->mat_.slice_size);
+            }
+
+            assert(this->nnz_ == hip_cast_mat->nnz_);
+            assert(this->nrow_ == hip_cast_mat->nrow_);
+            assert(this->ncol_ == hip_cast_mat->ncol_);
+            assert(this->mat_.slice_size == hip_cast_mat->mat_.slice_size);
+
+            copy_d2d(this->mat_.nslice + 1,
+                     hip_cast_mat->mat_.slice_offset,
+                     this->mat_.slice_offset,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2d(this->nrow_,
+                     hip_cast_mat->mat_.perm,
+                     this->mat_.perm,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2d(this->nnz_,
+                     hip_cast_mat->mat_.col,
+                     this->mat_.col,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2d(this->nnz_,
+                     hip_cast_mat->mat_.val,
+                     this->mat_.val,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+        }
+        else
+        {
+            // CPU to HIP
+            if((host_cast_mat = dynamic_cast<const HostMatrix<ValueType>*>(&src)) != NULL)
+            {
+                this->CopyFromHostAsync(*host_cast_mat);
+            }
+            else
+            {
+                LOG_INFO("Error unsupported HIP matrix type");
+                this->Info();
+                src.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::CopyToAsync(BaseMatrix<ValueType>* dst) const
+    {
+        HIPAcceleratorMatrixSELL<ValueType>* hip_cast_mat;
+        HostMatrix<ValueType>*               host_cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == dst->GetMatFormat());
+
+        // HIP to HIP copy
+        if((hip_cast_mat = dynamic_cast<HIPAcceleratorMatrixSELL<ValueType>*>(dst)) != NULL)
+        {
+            hip_cast_mat->CopyFromAsync(*this);
+        }
+        else
+        {
+            // HIP to CPU
+            if((host_cast_mat = dynamic_cast<HostMatrix<ValueType>*>(dst)) != NULL)
+            {
+                this->CopyToHostAsync(host_cast_mat);
+            }
+            else
+            {
+                LOG_INFO("Error unsupported HIP matrix type");
+                this->Info();
+                dst->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixSELL<ValueType>::ConvertFrom(const BaseMatrix<ValueType>& mat)
+    {
+        this->Clear();
+
+        // Empty matrix
+        if(mat.GetNnz() == 0)
+        {
+            this->AllocateSELL(0, mat.GetM(), mat.GetN(), _sell_slice_size);
+            return true;
+        }
+
+        const HIPAcceleratorMatrixSELL<ValueType>* cast_mat_sell;
+
+        if((cast_mat_sell = dynamic_cast<const HIPAcceleratorMatrixSELL<ValueType>*>(&mat))
+           != NULL)
+        {
+            this->CopyFrom(*cast_mat_sell);
+            return true;
+        }
+
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_csr;
+        if((cast_mat_csr = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&mat)) != NULL)
+        {
+            this->Clear();
+
+            int64_t sell_nnz;
+
+            if(csr_to_sell_hip(&this->local_backend_,
+                               cast_mat_csr->nnz_,
+                               cast_mat_csr->nrow_,
+                               cast_mat_csr->ncol_,
+                               cast_mat_csr->mat_,
+                               _sell_slice_size,
+                               _sell_sigma,
+                               &this->mat_,
+                               &sell_nnz)
+               == true)
+            {
+                this->nrow_ = cast_mat_csr->nrow_;
+                this->ncol_ = cast_mat_csr->ncol_;
+                this->nnz_  = sell_nnz;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                                    BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(in.GetSize() >= 0);
+            assert(out->GetSize() >= 0);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+            kernel_sell_spmv<<<GridSize,
+                               BlockSize,
+                               0,
+                               HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow,
+                this->mat_.slice_size,
+                this->mat_.slice_offset,
+                this->mat_.perm,
+                this->mat_.col,
+                this->mat_.val,
+                cast_in->vec_,
+                cast_out->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixSELL<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                                       ValueType                    scalar,
+                                                       BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(in.GetSize() >= 0);
+            assert(out->GetSize() >= 0);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            int  nrow = this->nrow_;
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(nrow / this->local_backend_.HIP_block_size + 1);
+
+            kernel_sell_add_spmv<<<GridSize,
+                                   BlockSize,
+                                   0,
+                                   HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow,
+                this->mat_.slice_size,
+                this->mat_.slice_offset,
+                this->mat_.perm,
+                this->mat_.col,
+                this->mat_.val,
+                scalar,
+                cast_in->vec_,
+                cast_out->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template class HIPAcceleratorMatrixSELL<double>;
+    template class HIPAcceleratorMatrixSELL<float>;
+#ifdef SUPPORT_COMPLEX
+    template class HIPAcceleratorMatrixSELL<std::complex<double>>;
+    template class HIPAcceleratorMatrixSELL<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,696 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "hip_matrix_vbr.hpp"
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/def.hpp"
+#include "../../utils/log.hpp"
+#include "../backend_manager.hpp"
+#include "../base_matrix.hpp"
+#include "../base_vector.hpp"
+#include "../host/host_matrix_csr.hpp"
+#include "../host/host_matrix_vbr.hpp"
+#include "../matrix_formats_ind.hpp"
+#include "hip_allocate_free.hpp"
+#include "hip_kernels_vbr.hpp"
+#include "hip_matrix_csr.hpp"
+#include "hip_utils.hpp"
+#include "hip_vector.hpp"
+
+#include <hip/hip_runtime.h>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    HIPAcceleratorMatrixVBR<ValueType>::HIPAcceleratorMatrixVBR()
+    {
+        // no default constructors
+        LOG_INFO("no default constructor");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    HIPAcceleratorMatrixVBR<ValueType>::HIPAcceleratorMatrixVBR(
+        const Rocalution_Backend_Descriptor& local_backend)
+    {
+        log_debug(this,
+                  "HIPAcceleratorMatrixVBR::HIPAcceleratorMatrixVBR()",
+                  "constructor with local_backend");
+
+        this->mat_.nrowb      = 0;
+        this->mat_.ncolb      = 0;
+        this->mat_.nnzb       = 0;
+        this->mat_.row_block  = NULL;
+        this->mat_.col_block  = NULL;
+        this->mat_.row_offset = NULL;
+        this->mat_.col        = NULL;
+        this->mat_.val_offset = NULL;
+        this->mat_.val        = NULL;
+        this->set_backend(local_backend);
+
+        CHECK_HIP_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    HIPAcceleratorMatrixVBR<ValueType>::~HIPAcceleratorMatrixVBR()
+    {
+        log_debug(this, "HIPAcceleratorMatrixVBR::~HIPAcceleratorMatrixVBR()", "destructor");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::Info(void) const
+    {
+        LOG_INFO("HIPAcceleratorMatrixVBR<ValueType>"
+                 << " block rows=" << this->mat_.nrowb << " block cols=" << this->mat_.ncolb
+                 << " blocks=" << this->mat_.nnzb);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::AllocateVBR(
+        int64_t nnz, int64_t nnzb, int nrowb, int ncolb, int nrow, int ncol)
+    {
+        assert(nnz >= 0);
+        assert(nnzb >= 0);
+        assert(nrowb >= 0);
+        assert(ncolb >= 0);
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+
+        this->Clear();
+
+        allocate_hip(nrowb + 1, &this->mat_.row_block);
+        allocate_hip(ncolb + 1, &this->mat_.col_block);
+        allocate_hip(nrowb + 1, &this->mat_.row_offset);
+        allocate_hip(nnzb, &this->mat_.col);
+        allocate_hip(nnzb + 1, &this->mat_.val_offset);
+        allocate_hip(nnz, &this->mat_.val);
+
+        set_to_zero_hip(this->local_backend_.HIP_block_size, nrowb + 1, this->mat_.row_block);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, ncolb + 1, this->mat_.col_block);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, nrowb + 1, this->mat_.row_offset);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, nnzb, this->mat_.col);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, nnzb + 1, this->mat_.val_offset);
+        set_to_zero_hip(this->local_backend_.HIP_block_size, nnz, this->mat_.val);
+
+        this->mat_.nrowb = nrowb;
+        this->mat_.ncolb = ncolb;
+        this->mat_.nnzb  = nnzb;
+
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+        this->nnz_  = nnz;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::Clear()
+    {
+        free_hip(&this->mat_.row_block);
+        free_hip(&this->mat_.col_block);
+        free_hip(&this->mat_.row_offset);
+        free_hip(&this->mat_.col);
+        free_hip(&this->mat_.val_offset);
+        free_hip(&this->mat_.val);
+
+        this->mat_.nrowb = 0;
+        this->mat_.ncolb = 0;
+        this->mat_.nnzb  = 0;
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+        this->nnz_  = 0;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::CopyFromHost(const HostMatrix<ValueType>& src)
+    {
+        const HostMatrixVBR<ValueType>* cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == src.GetMatFormat());
+
+        // CPU to HIP copy
+        if((cast_mat = dynamic_cast<const HostMatrixVBR<ValueType>*>(&src)) != NULL)
+        {
+            if(this->nnz_ == 0)
+            {
+                this->AllocateVBR(cast_mat->nnz_,
+                                  cast_mat->mat_.nnzb,
+                                  cast_mat->mat_.nrowb,
+                                  cast_mat->mat_.ncolb,
+                                  cast_mat->nrow_,
+                                  cast_mat->ncol_);
+            }
+
+            assert(this->nnz_ == cast_mat->nnz_);
+            assert(this->nrow_ == cast_mat->nrow_);
+            assert(this->ncol_ == cast_mat->ncol_);
+            assert(this->mat_.nnzb == cast_mat->mat_.nnzb);
+            assert(this->mat_.nrowb == cast_mat->mat_.nrowb);
+            assert(this->mat_.ncolb == cast_mat->mat_.ncolb);
+
+            copy_h2d(this->mat_.nrowb + 1, cast_mat->mat_.row_block, this->mat_.row_block);
+            copy_h2d(this->mat_.ncolb + 1, cast_mat->mat_.col_block, this->mat_.col_block);
+            copy_h2d(this->mat_.nrowb + 1, cast_mat->mat_.row_offset, this->mat_.row_offset);
+            copy_h2d(this->mat_.nnzb, cast_mat->mat_.col, this->mat_.col);
+            copy_h2d(this->mat_.nnzb + 1, cast_mat->mat_.val_offset, this->mat_.val_offset);
+            copy_h2d(this->nnz_, cast_mat->mat_.val, this->mat_.val);
+        }
+        else
+        {
+            LOG_INFO("Error unsupported HIP matrix type");
+            this->Info();
+            src.Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::CopyToHost(HostMatrix<ValueType>* dst) const
+    {
+        HostMatrixVBR<ValueType>* cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == dst->GetMatFormat());
+
+        // HIP to CPU copy
+        if((cast_mat = dynamic_cast<HostMatrixVBR<ValueType>*>(dst)) != NULL)
+        {
+            cast_mat->set_backend(this->local_backend_);
+
+            if(cast_mat->nnz_ == 0)
+            {
+                cast_mat->AllocateVBR(this->nnz_,
+                                      this->mat_.nnzb,
+                                      this->mat_.nrowb,
+                                      this->mat_.ncolb,
+                                      this->nrow_,
+                                      this->ncol_);
+            }
+
+            assert(this->nnz_ == cast_mat->nnz_);
+            assert(this->nrow_ == cast_mat->nrow_);
+            assert(this->ncol_ == cast_mat->ncol_);
+            assert(this->mat_.nnzb == cast_mat->mat_.nnzb);
+            assert(this->mat_.nrowb == cast_mat->mat_.nrowb);
+            assert(this->mat_.ncolb == cast_mat->mat_.ncolb);
+
+            copy_d2h(this->mat_.nrowb + 1, this->mat_.row_block, cast_mat->mat_.row_block);
+            copy_d2h(this->mat_.ncolb + 1, this->mat_.col_block, cast_mat->mat_.col_block);
+            copy_d2h(this->mat_.nrowb + 1, this->mat_.row_offset, cast_mat->mat_.row_offset);
+            copy_d2h(this->mat_.nnzb, this->mat_.col, cast_mat->mat_.col);
+            copy_d2h(this->mat_.nnzb + 1, this->mat_.val_offset, cast_mat->mat_.val_offset);
+            copy_d2h(this->nnz_, this->mat_.val, cast_mat->mat_.val);
+        }
+        else
+        {
+            LOG_INFO("Error unsupported HIP matrix type");
+            this->Info();
+            dst->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::CopyFrom(const BaseMatrix<ValueType>& src)
+    {
+        const HIPAcceleratorMatrixVBR<ValueType>* hip_cast_mat;
+        const HostMatrix<ValueType>*              host_cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == src.GetMatFormat());
+
+        // HIP to HIP copy
+        if((hip_cast_mat = dynamic_cast<const HIPAcceleratorMatrixVBR<ValueType>*>(&src)) != NULL)
+        {
+            if(this->nnz_ == 0)
+            {
+                this->AllocateVBR(hip_cast_mat->nnz_,
+                                  hip_cast_mat->mat_.nnzb,
+                                  hip_cast_mat->mat_.nrowb,
+                                  hip_cast_mat->mat_.ncolb,
+                                  hip_cast_mat->nrow_,
+                                  hip_cast_mat->ncol_);
+            }
+
+            assert(this->nnz_ == hip_cast_mat->nnz_);
+            assert(this->nrow_ == hip_cast_mat->nrow_);
+            assert(this->ncol_ == hip_cast_mat->ncol_);
+            assert(this->mat_.nnzb == hip_cast_mat->mat_.nnzb);
+            assert(this->mat_.nrowb == hip_cast_mat->mat_.nrowb);
+            assert(this->mat_.ncolb == hip_cast_mat->mat_.ncolb);
+
+            copy_d2d(this->mat_.nrowb + 1, hip_cast_mat->mat_.row_block, this->mat_.row_block);
+            copy_d2d(this->mat_.ncolb + 1, hip_cast_mat->mat_.col_block, this->mat_.col_block);
+            copy_d2d(this->mat_.nrowb + 1, hip_cast_mat->mat_.row_offset, this->mat_.row_offset);
+            copy_d2d(this->mat_.nnzb, hip_cast_mat->mat_.col, this->mat_.col);
+            copy_d2d(this->mat_.nnzb + 1, hip_cast_mat->mat_.val_offset, this->mat_.val_offset);
+            copy_d2d(this->nnz_, hip_cast_mat->mat_.val, this->mat_.val);
+        }
+        else
+        {
+            // CPU to HIP
+            if((host_cast_mat = dynamic_cast<const HostMatrix<ValueType>*>(&src)) != NULL)
+            {
+                this->CopyFromHost(*host_cast_mat);
+            }
+            else
+            {
+                LOG_INFO("Error unsupported HIP matrix type");
+                this->Info();
+                src.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::CopyTo(BaseMatrix<ValueType>* dst) const
+    {
+        HIPAcceleratorMatrixVBR<ValueType>* hip_cast_mat;
+        HostMatrix<ValueType>*              host_cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == dst->GetMatFormat());
+
+        // HIP to HIP copy
+        if((hip_cast_mat = dynamic_cast<HIPAcceleratorMatrixVBR<ValueType>*>(dst)) != NULL)
+        {
+            hip_cast_mat->CopyFrom(*this);
+        }
+        else
+        {
+            // HIP to CPU
+            if((host_cast_mat = dynamic_cast<HostMatrix<ValueType>*>(dst)) != NULL)
+            {
+                this->CopyToHost(host_cast_mat);
+            }
+            else
+            {
+                LOG_INFO("Error unsupported HIP matrix type");
+                this->Info();
+                dst->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::CopyFromHostAsync(const HostMatrix<ValueType>& src)
+    {
+        const HostMatrixVBR<ValueType>* cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == src.GetMatFormat());
+
+        // CPU to HIP copy
+        if((cast_mat = dynamic_cast<const HostMatrixVBR<ValueType>*>(&src)) != NULL)
+        {
+            if(this->nnz_ == 0)
+            {
+                this->AllocateVBR(cast_mat->nnz_,
+                                  cast_mat->mat_.nnzb,
+                                  cast_mat->mat_.nrowb,
+                                  cast_mat->mat_.ncolb,
+                                  cast_mat->nrow_,
+                                  cast_mat->ncol_);
+            }
+
+            assert(this->nnz_ == cast_mat->nnz_);
+            assert(this->nrow_ == cast_mat->nrow_);
+            assert(this->ncol_ == cast_mat->ncol_);
+            assert(this->mat_.nnzb == cast_mat->mat_.nnzb);
+            assert(this->mat_.nrowb == cast_mat->mat_.nrowb);
+            assert(this->mat_.ncolb == cast_mat->mat_.ncolb);
+
+            copy_h2d(this->mat_.nrowb + 1,
+                     cast_mat->mat_.row_block,
+                     this->mat_.row_block,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_h2d(this->mat_.ncolb + 1,
+                     cast_mat->mat_.col_block,
+                     this->mat_.col_block,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_h2d(this->mat_.nrowb + 1,
+                     cast_mat->mat_.row_offset,
+                     this->mat_.row_offset,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_h2d(this->mat_.nnzb,
+                     cast_mat->mat_.col,
+                     this->mat_.col,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_h2d(this->mat_.nnzb + 1,
+                     cast_mat->mat_.val_offset,
+                     this->mat_.val_offset,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_h2d(this->nnz_,
+                     cast_mat->mat_.val,
+                     this->mat_.val,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+        }
+        else
+        {
+            LOG_INFO("Error unsupported HIP matrix type");
+            this->Info();
+            src.Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::CopyToHostAsync(HostMatrix<ValueType>* dst) const
+    {
+        HostMatrixVBR<ValueType>* cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == dst->GetMatFormat());
+
+        // HIP to CPU copy
+        if((cast_mat = dynamic_cast<HostMatrixVBR<ValueType>*>(dst)) != NULL)
+        {
+            cast_mat->set_backend(this->local_backend_);
+
+            if(cast_mat->nnz_ == 0)
+            {
+                cast_mat->AllocateVBR(this->nnz_,
+                                      this->mat_.nnzb,
+                                      this->mat_.nrowb,
+                                      this->mat_.ncolb,
+                                      this->nrow_,
+                                      this->ncol_);
+            }
+
+            assert(this->nnz_ == cast_mat->nnz_);
+            assert(this->nrow_ == cast_mat->nrow_);
+            assert(this->ncol_ == cast_mat->ncol_);
+            assert(this->mat_.nnzb == cast_mat->mat_.nnzb);
+            assert(this->mat_.nrowb == cast_mat->mat_.nrowb);
+            assert(this->mat_.ncolb == cast_mat->mat_.ncolb);
+
+            copy_d2h(this->mat_.nrowb + 1,
+                     this->mat_.row_block,
+                     cast_mat->mat_.row_block,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2h(this->mat_.ncolb + 1,
+                     this->mat_.col_block,
+                     cast_mat->mat_.col_block,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2h(this->mat_.nrowb + 1,
+                     this->mat_.row_offset,
+                     cast_mat->mat_.row_offset,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2h(this->mat_.nnzb,
+                     this->mat_.col,
+                     cast_mat->mat_.col,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2h(this->mat_.nnzb + 1,
+                     this->mat_.val_offset,
+                     cast_mat->mat_.val_offset,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2h(this->nnz_,
+                     this->mat_.val,
+                     cast_mat->mat_.val,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+        }
+        else
+        {
+            LOG_INFO("Error unsupported HIP matrix type");
+            this->Info();
+            dst->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::CopyFromAsync(const BaseMatrix<ValueType>& src)
+    {
+        const HIPAcceleratorMatrixVBR<ValueType>* hip_cast_mat;
+        const HostMatrix<ValueType>*              host_cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == src.GetMatFormat());
+
+        // HIP to HIP copy
+        if((hip_cast_mat = dynamic_cast<const HIPAcceleratorMatrixVBR<ValueType>*>(&src)) != NULL)
+        {
+            if(this->nnz_ == 0)
+            {
+                this->AllocateVBR(hip_cast_mat->nnz_,
+                                  hip_cast_mat->mat_.nnzb,
+                                  hip_cast_mat->mat_.nrowb,
+                                  hip_cast_mat->mat_.ncolb,
+                                  hip_cast_mat->nrow_,
+                                  hip_cast_mat->ncol_);
+            }
+
+            assert(this->nnz_ == hip_cast_mat->nnz_);
+            assert(this->nrow_ == hip_cast_mat->nrow_);
+            assert(this->ncol_ == hip_cast_mat->ncol_);
+            assert(this->mat_.nnzb == hip_cast_mat->mat_.nnzb);
+            assert(this->mat_.nrowb == hip_cast_mat->mat_.nrowb);
+            assert(this->mat_.ncolb == hip_cast_mat->mat_.ncolb);
+
+            copy_d2d(this->mat_.nrowb + 1,
+                     hip_cast_mat->mat_.row_block,
+                     this->mat_.row_block,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2d(this->mat_.ncolb + 1,
+                     hip_cast_mat->mat_.col_block,
+                     this->mat_.col_block,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2d(this->mat_.nrowb + 1,
+                     hip_cast_mat->mat_.row_offset,
+                     this->mat_.row_offset,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2d(this->mat_.nnzb,
+                     hip_cast_mat->mat_.col,
+                     this->mat_.col,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2d(this->mat_.nnzb + 1,
+                     hip_cast_mat->mat_.val_offset,
+                     this->mat_.val_offset,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+            copy_d2d(this->nnz_,
+                     hip_cast_mat->mat_.val,
+                     this->mat_.val,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+        }
+        else
+        {
+            // CPU to HIP
+            if((host_cast_mat = dynamic_cast<const HostMatrix<ValueType>*>(&src)) != NULL)
+            {
+                this->CopyFromHostAsync(*host_cast_mat);
+            }
+            else
+            {
+                LOG_INFO("Error unsupported HIP matrix type");
+                this->Info();
+                src.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::CopyToAsync(BaseMatrix<ValueType>* dst) const
+    {
+        HIPAcceleratorMatrixVBR<ValueType>* hip_cast_mat;
+        HostMatrix<ValueType>*              host_cast_mat;
+
+        // copy only in the same format
+        assert(this->GetMatFormat() == dst->GetMatFormat());
+
+        // HIP to HIP copy
+        if((hip_cast_mat = dynamic_cast<HIPAcceleratorMatrixVBR<ValueType>*>(dst)) != NULL)
+        {
+            hip_cast_mat->CopyFromAsync(*this);
+        }
+        else
+        {
+            // HIP to CPU
+            if((host_cast_mat = dynamic_cast<HostMatrix<ValueType>*>(dst)) != NULL)
+            {
+                this->CopyToHostAsync(host_cast_mat);
+            }
+            else
+            {
+                LOG_INFO("Error unsupported HIP matrix type");
+                this->Info();
+                dst->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorMatrixVBR<ValueType>::ConvertFrom(const BaseMatrix<ValueType>& mat)
+    {
+        this->Clear();
+
+        // Empty matrix
+        if(mat.GetNnz() == 0)
+        {
+            this->AllocateVBR(0, 0, 0, 0, mat.GetM(), mat.GetN());
+            return true;
+        }
+
+        const HIPAcceleratorMatrixVBR<ValueType>* cast_mat_vbr;
+
+        if((cast_mat_vbr = dynamic_cast<const HIPAcceleratorMatrixVBR<ValueType>*>(&mat)) != NULL)
+        {
+            this->CopyFrom(*cast_mat_vbr);
+            return true;
+        }
+
+        const HIPAcceleratorMatrixCSR<ValueType>* cast_mat_csr;
+        if((cast_mat_csr = dynamic_cast<const HIPAcceleratorMatrixCSR<ValueType>*>(&mat)) != NULL)
+        {
+            // The block detection is inherently sequential (consecutive rows are
+            // compared pattern-wise), hence the conversion is staged through the host
+            HostMatrixCSR<ValueType> host_csr(this->local_backend_);
+            HostMatrixVBR<ValueType> host_vbr(this->local_backend_);
+
+            cast_mat_csr->CopyToHost(&host_csr);
+
+            if(host_vbr.ConvertFrom(host_csr) == true)
+            {
+                this->CopyFromHost(host_vbr);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                                   BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(in.GetSize() >= 0);
+            assert(out->GetSize() >= 0);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            // One group of _vbr_max_blockdim threads per block row
+            int64_t nthreads = static_cast<int64_t>(this->mat_.nrowb) * _vbr_max_blockdim;
+
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize((nthreads - 1) / this->local_backend_.HIP_block_size + 1);
+
+            kernel_vbr_spmv<_vbr_max_blockdim>
+                <<<GridSize, BlockSize, 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    this->mat_.nrowb,
+                    this->mat_.row_block,
+                    this->mat_.col_block,
+                    this->mat_.row_offset,
+                    this->mat_.col,
+                    this->mat_.val_offset,
+                    this->mat_.val,
+                    cast_in->vec_,
+                    cast_out->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorMatrixVBR<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                                      ValueType                    scalar,
+                                                      BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(in.GetSize() >= 0);
+            assert(out->GetSize() >= 0);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            // One group of _vbr_max_blockdim threads per block row
+            int64_t nthreads = static_cast<int64_t>(this->mat_.nrowb) * _vbr_max_blockdim;
+
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize((nthreads - 1) / this->local_backend_.HIP_block_size + 1);
+
+            kernel_vbr_add_spmv<_vbr_max_blockdim>
+                <<<GridSize, BlockSize, 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    this->mat_.nrowb,
+                    this->mat_.row_block,
+                    this->mat_.col_block,
+                    this->mat_.row_offset,
+                    this->mat_.col,
+                    this->mat_.val_offset,
+                    this->mat_.val,
+                    scalar,
+                    cast_in->vec_,
+                    cast_out->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template class HIPAcceleratorMatrixVBR<double>;
+    template class HIPAcceleratorMatrixVBR<float>;
+#ifdef SUPPORT_COMPLEX
+    template class HIPAcceleratorMatrixVBR<std::complex<double>>;
+    template class HIPAcceleratorMatrixVBR<std::complex<float>>;
+#endif
+
+} // namespace rocalution
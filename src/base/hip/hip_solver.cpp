@@ -0,0 +1,227 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "hip_solver.hpp"
+#include "../../utils/def.hpp"
+#include "../../utils/log.hpp"
+
+#include <rocblas/rocblas.h>
+#include <rocsolver/rocsolver.h>
+
+#include <complex>
+
+namespace rocalution
+{
+    // rocsolver getrf without pivoting
+    template <>
+    rocblas_status rocsolverTgetrf_npvt(
+        rocblas_handle handle, int m, int n, float* A, int lda, int* info)
+    {
+        return rocsolver_sgetrf_npvt(handle, m, n, A, lda, info);
+    }
+
+    template <>
+    rocblas_status rocsolverTgetrf_npvt(
+        rocblas_handle handle, int m, int n, double* A, int lda, int* info)
+    {
+        return rocsolver_dgetrf_npvt(handle, m, n, A, lda, info);
+    }
+
+    template <>
+    rocblas_status rocsolverTgetrf_npvt(
+        rocblas_handle handle, int m, int n, std::complex<float>* A, int lda, int* info)
+    {
+        return rocsolver_cgetrf_npvt(handle, m, n, (rocblas_float_complex*)A, lda, info);
+    }
+
+    template <>
+    rocblas_status rocsolverTgetrf_npvt(
+        rocblas_handle handle, int m, int n, std::complex<double>* A, int lda, int* info)
+    {
+        return rocsolver_zgetrf_npvt(handle, m, n, (rocblas_double_complex*)A, lda, info);
+    }
+
+    // rocsolver getrf
+    template <>
+    rocblas_status rocsolverTgetrf(
+        rocblas_handle handle, int m, int n, float* A, int lda, int* ipiv, int* info)
+    {
+        return rocsolver_sgetrf(handle, m, n, A, lda, ipiv, info);
+    }
+
+    template <>
+    rocblas_status rocsolverTgetrf(
+        rocblas_handle handle, int m, int n, double* A, int lda, int* ipiv, int* info)
+    {
+        return rocsolver_dgetrf(handle, m, n, A, lda, ipiv, info);
+    }
+
+    template <>
+    rocblas_status rocsolverTgetrf(
+        rocblas_handle handle, int m, int n, std::complex<float>* A, int lda, int* ipiv, int* info)
+    {
+        return rocsolver_cgetrf(handle, m, n, (rocblas_float_complex*)A, lda, ipiv, info);
+    }
+
+    template <>
+    rocblas_status rocsolverTgetrf(
+        rocblas_handle handle, int m, int n, std::complex<double>* A, int lda, int* ipiv, int* info)
+    {
+        return rocsolver_zgetrf(handle, m, n, (rocblas_double_complex*)A, lda, ipiv, info);
+    }
+
+    // rocsolver getri
+    template <>
+    rocblas_status
+        rocsolverTgetri(rocblas_handle handle, int n, float* A, int lda, int* ipiv, int* info)
+    {
+        return rocsolver_sgetri(handle, n, A, lda, ipiv, info);
+    }
+
+    template <>
+    rocblas_status
+        rocsolverTgetri(rocblas_handle handle, int n, double* A, int lda, int* ipiv, int* info)
+    {
+        return rocsolver_dgetri(handle, n, A, lda, ipiv, info);
+    }
+
+    template <>
+    rocblas_status rocsolverTgetri(
+        rocblas_handle handle, int n, std::complex<float>* A, int lda, int* ipiv, int* info)
+    {
+        return rocsolver_cgetri(handle, n, (rocblas_float_complex*)A, lda, ipiv, info);
+    }
+
+    template <>
+    rocblas_status rocsolverTgetri(
+        rocblas_handle handle, int n, std::complex<double>* A, int lda, int* ipiv, int* info)
+    {
+        return rocsolver_zgetri(handle, n, (rocblas_double_complex*)A, lda, ipiv, info);
+    }
+
+    // rocsolver geqrf
+    template <>
+    rocblas_status
+        rocsolverTgeqrf(rocblas_handle handle, int m, int n, float* A, int lda, float* tau)
+    {
+        return rocsolver_sgeqrf(handle, m, n, A, lda, tau);
+    }
+
+    template <>
+    rocblas_status
+        rocsolverTgeqrf(rocblas_handle handle, int m, int n, double* A, int lda, double* tau)
+    {
+        return rocsolver_dgeqrf(handle, m, n, A, lda, tau);
+    }
+
+    template <>
+    rocblas_status rocsolverTgeqrf(rocblas_handle       handle,
+                                   int                  m,
+                                   int                  n,
+                                   std::complex<float>* A,
+                                   int                  lda,
+                                   std::complex<float>* tau)
+    {
+        // The host QRSolve() Householder convention is only compatible for real types
+        return rocblas_status_not_implemented;
+    }
+
+    template <>
+    rocblas_status rocsolverTgeqrf(rocblas_handle        handle,
+                                   int                   m,
+                                   int                   n,
+                                   std::complex<double>* A,
+                                   int                   lda,
+                                   std::complex<double>* tau)
+    {
+        // The host QRSolve() Householder convention is only compatible for real types
+        return rocblas_status_not_implemented;
+    }
+
+    // rocsolver ormqr
+    template <>
+    rocblas_status rocsolverTormqr(rocblas_handle    handle,
+                                   rocblas_side      side,
+                                   rocblas_operation trans,
+                                   int               m,
+                                   int               n,
+                                   int               k,
+                                   float*            A,
+                                   int               lda,
+                                   float*            tau,
+                                   float*            C,
+                                   int               ldc)
+    {
+        return rocsolver_sormqr(handle, side, trans, m, n, k, A, lda, tau, C, ldc);
+    }
+
+    template <>
+    rocblas_status rocsolverTormqr(rocblas_handle    handle,
+                                   rocblas_side      side,
+                                   rocblas_operation trans,
+                                   int               m,
+                                   int               n,
+                                   int               k,
+                                   double*           A,
+                                   int               lda,
+                                   double*           tau,
+                                   double*           C,
+                                   int               ldc)
+    {
+        return rocsolver_dormqr(handle, side, trans, m, n, k, A, lda, tau, C, ldc);
+    }
+
+    template <>
+    rocblas_status rocsolverTormqr(rocblas_handle       handle,
+                                   rocblas_side         side,
+                                   rocblas_operation    trans,
+                                   int                  m,
+                                   int                  n,
+                                   int                  k,
+                                   std::complex<float>* A,
+                                   int                  lda,
+                                   std::complex<float>* tau,
+                                   std::complex<float>* C,
+                                   int                  ldc)
+    {
+        return rocblas_status_not_implemented;
+    }
+
+    template <>
+    rocblas_status rocsolverTormqr(rocblas_handle        handle,
+                                   rocblas_side          side,
+                                   rocblas_operation     trans,
+                                   int                   m,
+                                   int                   n,
+                                   int                   k,
+                                   std::complex<double>* A,
+                                   int                   lda,
+                                   std::complex<double>* tau,
+                                   std::complex<double>* C,
+                                   int                   ldc)
+    {
+        return rocblas_status_not_implemented;
+    }
+
+} // namespace rocalution
@@ -0,0 +1,68 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_HIP_HIP_SOLVER_HPP_
+#define ROCALUTION_HIP_HIP_SOLVER_HPP_
+
+#include <rocblas/rocblas.h>
+
+namespace rocalution
+{
+    // rocsolver getrf without pivoting
+    template <typename ValueType>
+    rocblas_status rocsolverTgetrf_npvt(
+        rocblas_handle handle, int m, int n, ValueType* A, int lda, int* info);
+
+    // rocsolver getrf
+    template <typename ValueType>
+    rocblas_status rocsolverTgetrf(
+        rocblas_handle handle, int m, int n, ValueType* A, int lda, int* ipiv, int* info);
+
+    // rocsolver getri
+    template <typename ValueType>
+    rocblas_status
+        rocsolverTgetri(rocblas_handle handle, int n, ValueType* A, int lda, int* ipiv, int* info);
+
+    // rocsolver geqrf
+    template <typename ValueType>
+    rocblas_status
+        rocsolverTgeqrf(rocblas_handle handle, int m, int n, ValueType* A, int lda, ValueType* tau);
+
+    // rocsolver ormqr
+    template <typename ValueType>
+    rocblas_status rocsolverTormqr(rocblas_handle    handle,
+                                   rocblas_side      side,
+                                   rocblas_operation trans,
+                                   int               m,
+                                   int               n,
+                                   int               k,
+                                   ValueType*        A,
+                                   int               lda,
+                                   ValueType*        tau,
+                                   ValueType*        C,
+                                   int               ldc);
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HIP_HIP_SOLVER_HPP_
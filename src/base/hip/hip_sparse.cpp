@@ -72,6 +72,18 @@ namespace rocalution
         return rocsparse_datatype_u32_r;
     }
 
+    // IndexType to rocsparse_indextype
+    template <>
+    rocsparse_indextype rocsparseTindextype<int32_t>()
+    {
+        return rocsparse_indextype_i32;
+    }
+    template <>
+    rocsparse_indextype rocsparseTindextype<int64_t>()
+    {
+        return rocsparse_indextype_i64;
+    }
+
     // rocsparse csrmv analysis
     template <>
     rocsparse_status rocsparseTcsrmv_analysis(rocsparse_handle          handle,
@@ -1680,6 +1692,175 @@ namespace rocalution
                                 (rocsparse_double_complex*)y);
     }
 
+    // rocsparse bsrmm
+    template <>
+    rocsparse_status rocsparseTbsrmm(rocsparse_handle          handle,
+                                     rocsparse_direction       dir,
+                                     rocsparse_operation       trans_A,
+                                     rocsparse_operation       trans_B,
+                                     int                       mb,
+                                     int                       n,
+                                     int                       kb,
+                                     int                       nnzb,
+                                     const float*              alpha,
+                                     const rocsparse_mat_descr descr,
+                                     const float*              bsr_val,
+                                     const int*                bsr_row_ptr,
+                                     const int*                bsr_col_ind,
+                                     int                       bsr_dim,
+                                     const float*              B,
+                                     int                       ldb,
+                                     const float*              beta,
+                                     float*                    C,
+                                     int                       ldc)
+    {
+        return rocsparse_sbsrmm(handle,
+                                dir,
+                                trans_A,
+                                trans_B,
+                                mb,
+                                n,
+                                kb,
+                                nnzb,
+                                alpha,
+                                descr,
+                                bsr_val,
+                                bsr_row_ptr,
+                                bsr_col_ind,
+                                bsr_dim,
+                                B,
+                                ldb,
+                                beta,
+                                C,
+                                ldc);
+    }
+
+    template <>
+    rocsparse_status rocsparseTbsrmm(rocsparse_handle          handle,
+                                     rocsparse_direction       dir,
+                                     rocsparse_operation       trans_A,
+                                     rocsparse_operation       trans_B,
+                                     int                       mb,
+                                     int                       n,
+                                     int                       kb,
+                                     int                       nnzb,
+                                     const double*             alpha,
+                                     const rocsparse_mat_descr descr,
+                                     const double*             bsr_val,
+                                     const int*                bsr_row_ptr,
+                                     const int*                bsr_col_ind,
+                                     int                       bsr_dim,
+                                     const double*             B,
+                                     int                       ldb,
+                                     const double*             beta,
+                                     double*                   C,
+                                     int                       ldc)
+    {
+        return rocsparse_dbsrmm(handle,
+                                dir,
+                                trans_A,
+                                trans_B,
+                                mb,
+                                n,
+                                kb,
+                                nnzb,
+                                alpha,
+                                descr,
+                                bsr_val,
+                                bsr_row_ptr,
+                                bsr_col_ind,
+                                bsr_dim,
+                                B,
+                                ldb,
+                                beta,
+                                C,
+                                ldc);
+    }
+
+    template <>
+    rocsparse_status rocsparseTbsrmm(rocsparse_handle           handle,
+                                     rocsparse_direction        dir,
+                                     rocsparse_operation        trans_A,
+                                     rocsparse_operation        trans_B,
+                                     int                        mb,
+                                     int                        n,
+                                     int                        kb,
+                                     int                        nnzb,
+                                     const std::complex<float>* alpha,
+                                     const rocsparse_mat_descr  descr,
+                                     const std::complex<float>* bsr_val,
+                                     const int*                 bsr_row_ptr,
+                                     const int*                 bsr_col_ind,
+                                     int                        bsr_dim,
+                                     const std::complex<float>* B,
+                                     int                        ldb,
+                                     const std::complex<float>* beta,
+                                     std::complex<float>*       C,
+                                     int                        ldc)
+    {
+        return rocsparse_cbsrmm(handle,
+                                dir,
+                                trans_A,
+                                trans_B,
+                                mb,
+                                n,
+                                kb,
+                                nnzb,
+                                (const rocsparse_float_complex*)alpha,
+                                descr,
+                                (const rocsparse_float_complex*)bsr_val,
+                                bsr_row_ptr,
+                                bsr_col_ind,
+                                bsr_dim,
+                                (const rocsparse_float_complex*)B,
+                                ldb,
+                                (const rocsparse_float_complex*)beta,
+                                (rocsparse_float_complex*)C,
+                                ldc);
+    }
+
+    template <>
+    rocsparse_status rocsparseTbsrmm(rocsparse_handle            handle,
+                                     rocsparse_direction         dir,
+                                     rocsparse_operation         trans_A,
+                                     rocsparse_operation         trans_B,
+                                     int                         mb,
+                                     int                         n,
+                                     int                         kb,
+                                     int                         nnzb,
+                                     const std::complex<double>* alpha,
+                                     const rocsparse_mat_descr   descr,
+                                     const std::complex<double>* bsr_val,
+                                     const int*                  bsr_row_ptr,
+                                     const int*                  bsr_col_ind,
+                                     int                         bsr_dim,
+                                     const std::complex<double>* B,
+                                     int                         ldb,
+                                     const std::complex<double>* beta,
+                                     std::complex<double>*       C,
+                                     int                         ldc)
+    {
+        return rocsparse_zbsrmm(handle,
+                                dir,
+                                trans_A,
+                                trans_B,
+                                mb,
+                                n,
+                                kb,
+                                nnzb,
+                                (const rocsparse_double_complex*)alpha,
+                                descr,
+                                (const rocsparse_double_complex*)bsr_val,
+                                bsr_row_ptr,
+                                bsr_col_ind,
+                                bsr_dim,
+                                (const rocsparse_double_complex*)B,
+                                ldb,
+                                (const rocsparse_double_complex*)beta,
+                                (rocsparse_double_complex*)C,
+                                ldc);
+    }
+
     // rocsparse csrgeam
     template <>
     rocsparse_status rocsparseTcsrgeam(rocsparse_handle          handle,
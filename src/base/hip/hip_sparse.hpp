@@ -33,6 +33,10 @@ namespace rocalution
     template <typename ValueType>
     rocsparse_datatype rocsparseTdatatype();
 
+    // IndexType to rocsparse_indextype
+    template <typename IndexType>
+    rocsparse_indextype rocsparseTindextype();
+
     // rocsparse csrmv analysis
     template <typename ValueType>
     rocsparse_status rocsparseTcsrmv_analysis(rocsparse_handle          handle,
@@ -256,6 +260,28 @@ namespace rocalution
                                      const ValueType*          beta,
                                      ValueType*                y);
 
+    // rocsparse bsrmm
+    template <typename ValueType>
+    rocsparse_status rocsparseTbsrmm(rocsparse_handle          handle,
+                                     rocsparse_direction       dir,
+                                     rocsparse_operation       trans_A,
+                                     rocsparse_operation       trans_B,
+                                     int                       mb,
+                                     int                       n,
+                                     int                       kb,
+                                     int                       nnzb,
+                                     const ValueType*          alpha,
+                                     const rocsparse_mat_descr descr,
+                                     const ValueType*          bsr_val,
+                                     const int*                bsr_row_ptr,
+                                     const int*                bsr_col_ind,
+                                     int                       bsr_dim,
+                                     const ValueType*          B,
+                                     int                       ldb,
+                                     const ValueType*          beta,
+                                     ValueType*                C,
+                                     int                       ldc);
+
     // rocsparse csrgeam
     template <typename ValueType>
     rocsparse_status rocsparseTcsrgeam(rocsparse_handle          handle,
@@ -0,0 +1,158 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "hip_stencil_laplace2d.hpp"
+#include "../../utils/def.hpp"
+#include "../../utils/log.hpp"
+#include "../backend_manager.hpp"
+#include "../host/host_stencil_laplace2d.hpp"
+#include "../stencil_types.hpp"
+#include "hip_kernels_stencil.hpp"
+#include "hip_utils.hpp"
+#include "hip_vector.hpp"
+
+#include <hip/hip_runtime.h>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    HIPAcceleratorStencilLaplace2D<ValueType>::HIPAcceleratorStencilLaplace2D()
+    {
+        // no default constructors
+        LOG_INFO("no default constructor");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    HIPAcceleratorStencilLaplace2D<ValueType>::HIPAcceleratorStencilLaplace2D(
+        const Rocalution_Backend_Descriptor& local_backend)
+    {
+        log_debug(this,
+                  "HIPAcceleratorStencilLaplace2D::HIPAcceleratorStencilLaplace2D()",
+                  "constructor with local_backend");
+
+        this->set_backend(local_backend);
+
+        this->ndim_ = 2;
+    }
+
+    template <typename ValueType>
+    HIPAcceleratorStencilLaplace2D<ValueType>::~HIPAcceleratorStencilLaplace2D()
+    {
+        log_debug(this, "HIPAcceleratorStencilLaplace2D::~HIPAcceleratorStencilLaplace2D()");
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorStencilLaplace2D<ValueType>::Info(void) const
+    {
+        LOG_INFO("Stencil 2D Laplace (HIP) size=" << this->size_ << " dim=" << this->GetNDim());
+    }
+
+    template <typename ValueType>
+    int64_t HIPAcceleratorStencilLaplace2D<ValueType>::GetNnz(void) const
+    {
+        return 5;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorStencilLaplace2D<ValueType>::CopyFromHost(const HostStencil<ValueType>& src)
+    {
+        // copy only in the same format
+        assert(this->GetStencilId() == src.GetStencilId());
+
+        this->size_ = src.size_;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorStencilLaplace2D<ValueType>::CopyToHost(HostStencil<ValueType>* dst) const
+    {
+        assert(dst != NULL);
+
+        // copy only in the same format
+        assert(this->GetStencilId() == dst->GetStencilId());
+
+        dst->size_ = this->size_;
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorStencilLaplace2D<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                                          BaseVector<ValueType>*       out) const
+    {
+        this->Apply_(in, static_cast<ValueType>(1), false, out);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorStencilLaplace2D<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                                             ValueType                    scalar,
+                                                             BaseVector<ValueType>*       out) const
+    {
+        this->Apply_(in, scalar, true, out);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorStencilLaplace2D<ValueType>::Apply_(const BaseVector<ValueType>& in,
+                                                           ValueType                    scalar,
+                                                           bool                         add,
+                                                           BaseVector<ValueType>*       out) const
+    {
+        if((this->ndim_ > 0) && (this->size_ > 0))
+        {
+            assert(in.GetSize() == this->GetM());
+            assert(out->GetSize() == this->GetM());
+
+            const HIPAcceleratorVector<ValueType>* cast_in
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&in);
+            HIPAcceleratorVector<ValueType>* cast_out
+                = dynamic_cast<HIPAcceleratorVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            dim3 BlockSize(32, 8);
+            dim3 GridSize((this->size_ - 1) / 32 + 1, (this->size_ - 1) / 8 + 1);
+
+            if(add == true)
+            {
+                kernel_stencil_laplace2d<32, 8, true>
+                    <<<GridSize, BlockSize, 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                        this->size_, scalar, cast_in->vec_, cast_out->vec_);
+            }
+            else
+            {
+                kernel_stencil_laplace2d<32, 8, false>
+                    <<<GridSize, BlockSize, 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                        this->size_, scalar, cast_in->vec_, cast_out->vec_);
+            }
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template class HIPAcceleratorStencilLaplace2D<double>;
+    template class HIPAcceleratorStencilLaplace2D<float>;
+#ifdef SUPPORT_COMPLEX
+    template class HIPAcceleratorStencilLaplace2D<std::complex<double>>;
+    template class HIPAcceleratorStencilLaplace2D<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -49,8 +49,8 @@
 #endif
 // clang-format on
 
-#define ROCBLAS_HANDLE(handle) *static_cast<rocblas_handle*>(handle)
-#define ROCSPARSE_HANDLE(handle) *static_cast<rocsparse_handle*>(handle)
+#define ROCBLAS_HANDLE(handle) rocalution::rocalution_hip_rocblas_handle(handle)
+#define ROCSPARSE_HANDLE(handle) rocalution::rocalution_hip_rocsparse_handle(handle)
 #define HIPSTREAM(handle) *static_cast<hipStream_t*>(handle)
 
 #define CHECK_HIP_ERROR(file, line)                              \
@@ -114,6 +114,11 @@
 
 namespace rocalution
 {
+    // Return the rocBLAS / rocSPARSE handle stored in handle. The handles of the global
+    // backend descriptor are created on first use.
+    rocblas_handle   rocalution_hip_rocblas_handle(void* handle);
+    rocsparse_handle rocalution_hip_rocsparse_handle(void* handle);
+
     static __device__ __forceinline__ float hip_nontemporal_load(const float* ptr)
     {
         return __builtin_nontemporal_load(ptr);
@@ -194,6 +199,39 @@ namespace rocalution
     }
 #endif
 
+    // |real| + |imag|, the contribution of an element to asum
+    static __device__ __forceinline__ float hip_asum(float val)
+    {
+        return fabsf(val);
+    }
+
+    static __device__ __forceinline__ double hip_asum(double val)
+    {
+        return fabs(val);
+    }
+
+    static __device__ __forceinline__ int hip_asum(int val)
+    {
+        return abs(val);
+    }
+
+    static __device__ __forceinline__ int64_t hip_asum(int64_t val)
+    {
+        return val < 0 ? -val : val;
+    }
+
+#ifdef SUPPORT_COMPLEX
+    static __device__ __forceinline__ float hip_asum(std::complex<float> val)
+    {
+        return fabsf(val.real()) + fabsf(val.imag());
+    }
+
+    static __device__ __forceinline__ double hip_asum(std::complex<double> val)
+    {
+        return fabs(val.real()) + fabs(val.imag());
+    }
+#endif
+
     // real()
     static __device__ __forceinline__ float hip_real(float val)
     {
@@ -217,6 +255,29 @@ namespace rocalution
     }
 #endif
 
+    // conj()
+    static __device__ __forceinline__ float hip_conj(float val)
+    {
+        return val;
+    }
+
+    static __device__ __forceinline__ double hip_conj(double val)
+    {
+        return val;
+    }
+
+#ifdef SUPPORT_COMPLEX
+    static __device__ __forceinline__ std::complex<float> hip_conj(std::complex<float> val)
+    {
+        return std::complex<float>(val.real(), -val.imag());
+    }
+
+    static __device__ __forceinline__ std::complex<double> hip_conj(std::complex<double> val)
+    {
+        return std::complex<double>(val.real(), -val.imag());
+    }
+#endif
+
 #if ROCALUTION_USE_MOVE_DPP
     template <unsigned int WFSIZE>
     static __device__ __forceinline__ void wf_reduce_sum(int* sum)
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -48,6 +48,75 @@
 
 namespace rocalution
 {
+    // Reproducible reductions partition the vector into a fixed grid of 256 blocks of 256
+    // threads, independent of the device, such that every partial sum is accumulated in
+    // the same order. The final reduction of the block sums is a fixed tree as well.
+    template <bool CONJ, bool NORM, typename ValueType, typename YType>
+    static ValueType hip_reproducible_dot(const Rocalution_Backend_Descriptor& backend,
+                                          int64_t                              size,
+                                          const ValueType*                     x,
+                                          const YType*                         y)
+    {
+        hipStream_t stream = HIPSTREAM(backend.HIP_stream_current);
+
+        ValueType res = static_cast<ValueType>(0);
+
+        if(size > 0)
+        {
+            ValueType* workspace = NULL;
+            allocate_hip(257, &workspace);
+
+            kernel_dot_blockreduce<256, CONJ>
+                <<<dim3(256), dim3(256), 0, stream>>>(size, x, y, workspace);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            kernel_dot_finalreduce_scalar<256, NORM>
+                <<<dim3(1), dim3(256), 0, stream>>>(workspace, workspace + 256);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            copy_d2h(1, workspace + 256, &res, true, stream);
+
+            hipStreamSynchronize(stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&workspace);
+        }
+
+        return res;
+    }
+
+    template <bool ABS, typename ValueType>
+    static ValueType hip_reproducible_reduce(const Rocalution_Backend_Descriptor& backend,
+                                             int64_t                              size,
+                                             const ValueType*                     x)
+    {
+        hipStream_t stream = HIPSTREAM(backend.HIP_stream_current);
+
+        ValueType res = static_cast<ValueType>(0);
+
+        if(size > 0)
+        {
+            ValueType* workspace = NULL;
+            allocate_hip(256, &workspace);
+
+            kernel_reduce_blockreduce<256, ABS>
+                <<<dim3(256), dim3(256), 0, stream>>>(size, x, workspace);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            kernel_dot_finalreduce<256><<<dim3(1), dim3(256), 0, stream>>>(1, workspace);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            copy_d2h(1, workspace, &res, true, stream);
+
+            hipStreamSynchronize(stream);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&workspace);
+        }
+
+        return res;
+    }
+
     template <typename ValueType>
     HIPAcceleratorVector<ValueType>::HIPAcceleratorVector()
     {
@@ -63,7 +132,8 @@ namespace rocalution
         log_debug(
             this, "HIPAcceleratorVector::HIPAcceleratorVector()", "constructor with local_backend");
 
-        this->vec_ = NULL;
+        this->vec_  = NULL;
+        this->view_ = false;
         this->set_backend(local_backend);
 
         CHECK_HIP_ERROR(__FILE__, __LINE__);
@@ -115,6 +185,7 @@ namespace rocalution
 
         this->vec_  = *ptr;
         this->size_ = size;
+        this->view_ = false;
     }
 
     template <typename ValueType>
@@ -122,6 +193,21 @@ namespace rocalution
     {
         assert(this->size_ >= 0);
 
+        // A view hands out a copy, the external buffer is not ours to give away
+        if(this->view_ == true)
+        {
+            ValueType* vec = NULL;
+
+            if(this->size_ > 0)
+            {
+                allocate_hip(this->size_, &vec);
+                copy_d2d(this->size_, this->vec_, vec);
+            }
+
+            this->vec_  = vec;
+            this->view_ = false;
+        }
+
         hipDeviceSynchronize();
         *ptr       = this->vec_;
         this->vec_ = NULL;
@@ -129,14 +215,50 @@ namespace rocalution
         this->size_ = 0;
     }
 
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::AttachView(ValueType* ptr, int64_t size)
+    {
+        assert(size >= 0);
+
+        this->Clear();
+
+        if(size > 0)
+        {
+            assert(ptr != NULL);
+        }
+
+        hipDeviceSynchronize();
+
+        this->vec_  = ptr;
+        this->size_ = size;
+        this->view_ = true;
+    }
+
+    template <typename ValueType>
+    ValueType* HIPAcceleratorVector<ValueType>::GetDataPtr(void) const
+    {
+        return this->vec_;
+    }
+
     template <typename ValueType>
     void HIPAcceleratorVector<ValueType>::Clear(void)
     {
         if(this->size_ > 0)
         {
-            free_hip(&this->vec_);
+            if(this->view_ == true)
+            {
+                // External buffers are left to their owner
+                this->vec_ = NULL;
+            }
+            else
+            {
+                free_hip(&this->vec_);
+            }
+
             this->size_ = 0;
         }
+
+        this->view_ = false;
     }
 
     template <typename ValueType>
@@ -400,6 +522,12 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::Prefetch(void) const
+    {
+        prefetch_hip(this->size_, this->vec_, HIPSTREAM(this->local_backend_.HIP_stream_current));
+    }
+
     template <typename ValueType>
     void HIPAcceleratorVector<ValueType>::CopyToAsync(BaseVector<ValueType>* dst) const
     {
@@ -790,6 +918,12 @@ namespace rocalution
         assert(cast_x != NULL);
         assert(this->size_ == cast_x->size_);
 
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return hip_reproducible_dot<true, false>(
+                this->local_backend_, this->size_, this->vec_, cast_x->vec_);
+        }
+
         ValueType res = static_cast<ValueType>(0);
 
         if(this->size_ > 0)
@@ -842,6 +976,12 @@ namespace rocalution
         assert(cast_x != NULL);
         assert(this->size_ == cast_x->size_);
 
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return hip_reproducible_dot<false, false>(
+                this->local_backend_, this->size_, this->vec_, cast_x->vec_);
+        }
+
         ValueType res = static_cast<ValueType>(0);
 
         if(this->size_ > 0)
@@ -886,189 +1026,1056 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    ValueType HIPAcceleratorVector<ValueType>::Norm(void) const
+    void HIPAcceleratorVector<ValueType>::MultiDot(int                                 count,
+                                                   const BaseVector<ValueType>* const* x,
+                                                   ValueType*                          res) const
     {
-        ValueType res = static_cast<ValueType>(0);
+        assert(count > 0);
+        assert(x != NULL);
+        assert(res != NULL);
 
         if(this->size_ > 0)
         {
+            rocblas_handle handle = ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle);
+
+            // Keep all results on the device, such that only a single
+            // synchronization is required
+            ValueType* dres = NULL;
+            allocate_hip(count, &dres);
+
             rocblas_status status;
-            status = rocblasTnrm2(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
-                                  this->size_,
-                                  this->vec_,
-                                  1,
-                                  &res);
+            status = rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device);
             CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
 
-            // Synchronize stream to make sure, result is available on the host
+            for(int k = 0; k < count; ++k)
+            {
+                const HIPAcceleratorVector<ValueType>* cast_x
+                    = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(x[k]);
+
+                assert(cast_x != NULL);
+                assert(this->size_ == cast_x->size_);
+
+                status = rocblasTdotc(
+                    handle, this->size_, cast_x->vec_, 1, this->vec_, 1, dres + k);
+                CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+            }
+
+            status = rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host);
+            CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+            copy_d2h(count,
+                     dres,
+                     res,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+
+            // Synchronize stream to make sure, results are available on the host
             hipStreamSynchronize(HIPSTREAM(this->local_backend_.HIP_stream_current));
             CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&dres);
+        }
+        else
+        {
+            set_to_zero_host(count, res);
         }
+    }
 
-        return res;
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::MultiAddScale(int                                 count,
+                                                        const BaseVector<ValueType>* const* x,
+                                                        const ValueType*                    alpha)
+    {
+        assert(count > 0);
+        assert(x != NULL);
+        assert(alpha != NULL);
+
+        if(this->size_ > 0)
+        {
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->size_ / this->local_backend_.HIP_block_size + 1);
+
+            // Update with chunks of vectors, each chunk in a single pass over this vector
+            for(int first = 0; first < count; first += _vector_expression_max_vectors)
+            {
+                int chunk = std::min(count - first, _vector_expression_max_vectors);
+
+                vector_expression_operands<ValueType> operands;
+                multi_axpy_scalars<ValueType>         scalars;
+
+                for(int k = 0; k < chunk; ++k)
+                {
+                    const HIPAcceleratorVector<ValueType>* cast_x
+                        = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(x[first + k]);
+
+                    assert(cast_x != NULL);
+                    assert(this->size_ == cast_x->size_);
+
+                    operands.ptr[k] = cast_x->vec_;
+                    scalars.alpha[k] = alpha[first + k];
+                }
+
+                kernel_multi_axpy<<<GridSize,
+                                    BlockSize,
+                                    0,
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    this->size_, chunk, operands, scalars, this->vec_);
+                CHECK_HIP_ERROR(__FILE__, __LINE__);
+            }
+        }
     }
 
     template <>
-    bool HIPAcceleratorVector<bool>::Norm(void) const
+    void HIPAcceleratorVector<bool>::MultiAddScale(int                            count,
+                                                   const BaseVector<bool>* const* x,
+                                                   const bool*                    alpha)
     {
-        LOG_INFO("What is bool HIPAcceleratorVector<ValueType>::Norm(void) const?");
+        LOG_INFO("No bool multi axpy function");
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
     template <>
-    int HIPAcceleratorVector<int>::Norm(void) const
+    void HIPAcceleratorVector<bool>::MultiDot(int                            count,
+                                              const BaseVector<bool>* const* x,
+                                              bool*                          res) const
     {
-        LOG_INFO("What is int HIPAcceleratorVector<ValueType>::Norm(void) const?");
+        LOG_INFO("No bool multi dot function");
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
     template <>
-    int64_t HIPAcceleratorVector<int64_t>::Norm(void) const
+    void HIPAcceleratorVector<int>::MultiDot(int                           count,
+                                             const BaseVector<int>* const* x,
+                                             int*                          res) const
     {
-        LOG_INFO("What is integral HIPAcceleratorVector<ValueType>::Norm(void) const?");
+        LOG_INFO("No int multi dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int64_t>::MultiDot(int                               count,
+                                                 const BaseVector<int64_t>* const* x,
+                                                 int64_t*                          res) const
+    {
+        LOG_INFO("No integral multi dot function");
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
     template <typename ValueType>
-    ValueType HIPAcceleratorVector<ValueType>::Reduce(void) const
+    ValueType HIPAcceleratorVector<ValueType>::AddScaleDot(const BaseVector<ValueType>& x,
+                                                           ValueType                    alpha,
+                                                           const BaseVector<ValueType>& y)
     {
         ValueType res = static_cast<ValueType>(0);
 
         if(this->size_ > 0)
         {
-            char*  buffer = NULL;
-            size_t size   = 0;
+            const HIPAcceleratorVector<ValueType>* cast_x
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&x);
+            const HIPAcceleratorVector<ValueType>* cast_y
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&y);
 
-            ValueType* dres = NULL;
-            allocate_hip(1, &dres);
+            assert(cast_x != NULL);
+            assert(cast_y != NULL);
+            assert(this->size_ == cast_x->size_);
+            assert(this->size_ == cast_y->size_);
 
-            rocprimTreduce(buffer,
-                           size,
-                           this->vec_,
-                           dres,
-                           this->size_,
-                           HIPSTREAM(this->local_backend_.HIP_stream_current));
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            ValueType* workspace = NULL;
+            allocate_hip(256, &workspace);
 
-            allocate_hip(size, &buffer);
+            // Update and partial dot products in a single pass over the vectors
+            kernel_axpy_dot_blockreduce<256>
+                <<<dim3(256), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    this->size_, alpha, cast_x->vec_, cast_y->vec_, this->vec_, workspace);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            rocprimTreduce(buffer,
-                           size,
-                           this->vec_,
-                           dres,
-                           this->size_,
-                           HIPSTREAM(this->local_backend_.HIP_stream_current));
+            kernel_dot_finalreduce<256>
+                <<<dim3(1), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    1, workspace);
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            free_hip(&buffer);
+            copy_d2h(
+                1, workspace, &res, true, HIPSTREAM(this->local_backend_.HIP_stream_current));
 
-            copy_d2h(1, dres, &res);
+            // Synchronize stream to make sure, result is available on the host
+            hipStreamSynchronize(HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            free_hip(&dres);
+            free_hip(&workspace);
         }
 
         return res;
     }
 
     template <>
-    bool HIPAcceleratorVector<bool>::Reduce(void) const
+    bool HIPAcceleratorVector<bool>::AddScaleDot(const BaseVector<bool>& x,
+                                                 bool                    alpha,
+                                                 const BaseVector<bool>& y)
     {
-        LOG_INFO("What is bool HIPAcceleratorVector::<ValueType>::Reduce(void) const?");
+        LOG_INFO("No bool axpy dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    int HIPAcceleratorVector<int>::AddScaleDot(const BaseVector<int>& x,
+                                               int                    alpha,
+                                               const BaseVector<int>& y)
+    {
+        LOG_INFO("No int axpy dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    int64_t HIPAcceleratorVector<int64_t>::AddScaleDot(const BaseVector<int64_t>& x,
+                                                       int64_t                    alpha,
+                                                       const BaseVector<int64_t>& y)
+    {
+        LOG_INFO("No integral axpy dot function");
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
     template <typename ValueType>
-    ValueType HIPAcceleratorVector<ValueType>::InclusiveSum(const BaseVector<ValueType>& vec)
+    void HIPAcceleratorVector<ValueType>::Evaluate(
+        const VectorExpressionProgram<ValueType>& program, const BaseVector<ValueType>* const* vec)
     {
         if(this->size_ > 0)
         {
-            const HIPAcceleratorVector<ValueType>* cast_vec
-                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&vec);
+            assert(program.num_ops > 0);
+            assert(program.num_vectors <= _vector_expression_max_vectors);
 
-            assert(cast_vec != NULL);
+            vector_expression_operands<ValueType> operands;
 
-            char*  buffer = NULL;
-            size_t size   = 0;
+            for(int k = 0; k < program.num_vectors; ++k)
+            {
+                const HIPAcceleratorVector<ValueType>* cast_v
+                    = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(vec[k]);
 
-            rocprimTinclusivesum(buffer,
-                                 size,
-                                 cast_vec->vec_,
-                                 this->vec_,
-                                 this->size_,
-                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+                assert(cast_v != NULL);
+                assert(cast_v->size_ == this->size_);
 
-            allocate_hip(size, &buffer);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+                operands.ptr[k] = cast_v->vec_;
+            }
 
-            rocprimTinclusivesum(buffer,
-                                 size,
-                                 cast_vec->vec_,
-                                 this->vec_,
-                                 this->size_,
-                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->size_ / this->local_backend_.HIP_block_size + 1);
 
-            free_hip(&buffer);
+            // All operations of the expression in a single pass over the vectors
+            kernel_vector_expression<<<GridSize,
+                                       BlockSize,
+                                       0,
+                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->size_, program, operands, this->vec_);
             CHECK_HIP_ERROR(__FILE__, __LINE__);
-
-            ValueType ret;
-            copy_d2h(1, this->vec_ + this->size_ - 1, &ret);
-
-            return ret;
         }
-
-        return 0;
     }
 
     template <>
-    bool HIPAcceleratorVector<bool>::InclusiveSum(const BaseVector<bool>& vec)
+    void HIPAcceleratorVector<bool>::Evaluate(const VectorExpressionProgram<bool>& program,
+                                              const BaseVector<bool>* const*       vec)
     {
-        LOG_INFO("What is bool HIPAcceleratorVector::InclusiveSum()?");
+        LOG_INFO("No bool vector expression function");
         FATAL_ERROR(__FILE__, __LINE__);
-
-        return false;
     }
 
     template <typename ValueType>
-    ValueType HIPAcceleratorVector<ValueType>::ExclusiveSum(const BaseVector<ValueType>& vec)
+    ValueType HIPAcceleratorVector<ValueType>::EvaluateSum(
+        const VectorExpressionProgram<ValueType>& program,
+        const BaseVector<ValueType>* const*       vec) const
     {
+        ValueType res = static_cast<ValueType>(0);
+
         if(this->size_ > 0)
         {
-            const HIPAcceleratorVector<ValueType>* cast_vec
-                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&vec);
+            assert(program.num_ops > 0);
+            assert(program.num_vectors <= _vector_expression_max_vectors);
 
-            assert(cast_vec != NULL);
+            vector_expression_operands<ValueType> operands;
 
-            char*  buffer = NULL;
-            size_t size   = 0;
+            for(int k = 0; k < program.num_vectors; ++k)
+            {
+                const HIPAcceleratorVector<ValueType>* cast_v
+                    = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(vec[k]);
 
-            rocprimTexclusivesum(buffer,
-                                 size,
-                                 cast_vec->vec_,
-                                 this->vec_,
-                                 this->size_,
-                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+                assert(cast_v != NULL);
+                assert(cast_v->size_ == this->size_);
 
-            allocate_hip(size, &buffer);
-            CHECK_HIP_ERROR(__FILE__, __LINE__);
+                operands.ptr[k] = cast_v->vec_;
+            }
 
-            rocprimTexclusivesum(buffer,
-                                 size,
-                                 cast_vec->vec_,
-                                 this->vec_,
-                                 this->size_,
-                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+            ValueType* workspace = NULL;
+            allocate_hip(256, &workspace);
+
+            kernel_vector_expression_blockreduce<256>
+                <<<dim3(256), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    this->size_, program, operands, workspace);
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            free_hip(&buffer);
+            kernel_dot_finalreduce<256>
+                <<<dim3(1), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    1, workspace);
             CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-            ValueType ret;
-            copy_d2h(1, this->vec_ + this->size_ - 1, &ret);
+            copy_d2h(
+                1, workspace, &res, true, HIPSTREAM(this->local_backend_.HIP_stream_current));
 
-            return ret;
+            // Synchronize stream to make sure, result is available on the host
+            hipStreamSynchronize(HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&workspace);
+        }
+
+        return res;
+    }
+
+    template <>
+    bool HIPAcceleratorVector<bool>::EvaluateSum(const VectorExpressionProgram<bool>& program,
+                                                 const BaseVector<bool>* const*       vec) const
+    {
+        LOG_INFO("No bool vector expression function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::DualDot(const BaseVector<ValueType>& x,
+                                                  const BaseVector<ValueType>& y,
+                                                  ValueType*                   res) const
+    {
+        assert(res != NULL);
+
+        if(this->size_ > 0)
+        {
+            const HIPAcceleratorVector<ValueType>* cast_x
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&x);
+            const HIPAcceleratorVector<ValueType>* cast_y
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&y);
+
+            assert(cast_x != NULL);
+            assert(cast_y != NULL);
+            assert(this->size_ == cast_x->size_);
+            assert(this->size_ == cast_y->size_);
+
+            ValueType* workspace = NULL;
+            allocate_hip(2 * 256, &workspace);
+
+            // Both dot products share a single pass over this vector
+            kernel_dualdot_blockreduce<256>
+                <<<dim3(256), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    this->size_, this->vec_, cast_x->vec_, cast_y->vec_, workspace);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            kernel_dot_finalreduce<256>
+                <<<dim3(1), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    2, workspace);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            copy_d2h(
+                2, workspace, res, true, HIPSTREAM(this->local_backend_.HIP_stream_current));
+
+            // Synchronize stream to make sure, results are available on the host
+            hipStreamSynchronize(HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&workspace);
+        }
+        else
+        {
+            set_to_zero_host(2, res);
+        }
+    }
+
+    template <>
+    void HIPAcceleratorVector<bool>::DualDot(const BaseVector<bool>& x,
+                                             const BaseVector<bool>& y,
+                                             bool*                   res) const
+    {
+        LOG_INFO("No bool dual dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int>::DualDot(const BaseVector<int>& x,
+                                            const BaseVector<int>& y,
+                                            int*                   res) const
+    {
+        LOG_INFO("No int dual dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int64_t>::DualDot(const BaseVector<int64_t>& x,
+                                                const BaseVector<int64_t>& y,
+                                                int64_t*                   res) const
+    {
+        LOG_INFO("No integral dual dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::DotToScalar(const BaseVector<ValueType>& x,
+                                                      bool                         conj,
+                                                      BaseVector<ValueType>*       res,
+                                                      int64_t                      index) const
+    {
+        HIPAcceleratorVector<ValueType>* cast_res
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(res);
+
+        assert(cast_res != NULL);
+        assert(index >= 0);
+        assert(index < cast_res->size_);
+
+        if(this->size_ > 0)
+        {
+            const HIPAcceleratorVector<ValueType>* cast_x
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&x);
+
+            assert(cast_x != NULL);
+            assert(this->size_ == cast_x->size_);
+
+            ValueType* workspace = NULL;
+            allocate_hip(256, &workspace);
+
+            // The result stays in device memory, no host synchronization is required
+            if(conj == true)
+            {
+                kernel_dot_blockreduce<256, true>
+                    <<<dim3(256), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                        this->size_, this->vec_, cast_x->vec_, workspace);
+            }
+            else
+            {
+                kernel_dot_blockreduce<256, false>
+                    <<<dim3(256), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                        this->size_, this->vec_, cast_x->vec_, workspace);
+            }
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            kernel_dot_finalreduce_scalar<256, false>
+                <<<dim3(1), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    workspace, cast_res->vec_ + index);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&workspace);
+        }
+        else
+        {
+            set_to_zero_hip(this->local_backend_.HIP_block_size,
+                            1,
+                            cast_res->vec_ + index,
+                            true,
+                            HIPSTREAM(this->local_backend_.HIP_stream_current));
+        }
+    }
+
+    template <>
+    void HIPAcceleratorVector<bool>::DotToScalar(const BaseVector<bool>& x,
+                                                 bool                    conj,
+                                                 BaseVector<bool>*       res,
+                                                 int64_t                 index) const
+    {
+        LOG_INFO("No bool dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int>::DotToScalar(const BaseVector<int>& x,
+                                                bool                   conj,
+                                                BaseVector<int>*       res,
+                                                int64_t                index) const
+    {
+        LOG_INFO("No int dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int64_t>::DotToScalar(const BaseVector<int64_t>& x,
+                                                    bool                       conj,
+                                                    BaseVector<int64_t>*       res,
+                                                    int64_t                    index) const
+    {
+        LOG_INFO("No integral dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::NormToScalar(BaseVector<ValueType>* res,
+                                                       int64_t                index) const
+    {
+        HIPAcceleratorVector<ValueType>* cast_res
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(res);
+
+        assert(cast_res != NULL);
+        assert(index >= 0);
+        assert(index < cast_res->size_);
+
+        if(this->size_ > 0)
+        {
+            ValueType* workspace = NULL;
+            allocate_hip(256, &workspace);
+
+            // The result stays in device memory, no host synchronization is required
+            kernel_dot_blockreduce<256, true>
+                <<<dim3(256), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    this->size_, this->vec_, this->vec_, workspace);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            kernel_dot_finalreduce_scalar<256, true>
+                <<<dim3(1), dim3(256), 0, HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                    workspace, cast_res->vec_ + index);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&workspace);
+        }
+        else
+        {
+            set_to_zero_hip(this->local_backend_.HIP_block_size,
+                            1,
+                            cast_res->vec_ + index,
+                            true,
+                            HIPSTREAM(this->local_backend_.HIP_stream_current));
+        }
+    }
+
+    template <>
+    void HIPAcceleratorVector<bool>::NormToScalar(BaseVector<bool>* res, int64_t index) const
+    {
+        LOG_INFO("No bool norm function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int>::NormToScalar(BaseVector<int>* res, int64_t index) const
+    {
+        LOG_INFO("No int norm function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int64_t>::NormToScalar(BaseVector<int64_t>* res,
+                                                     int64_t              index) const
+    {
+        LOG_INFO("No integral norm function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::AddScaleRatio(const BaseVector<ValueType>& x,
+                                                        ValueType                    factor,
+                                                        const BaseVector<ValueType>& scalars,
+                                                        int64_t                      num,
+                                                        int64_t                      den)
+    {
+        if(this->size_ > 0)
+        {
+            const HIPAcceleratorVector<ValueType>* cast_x
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&x);
+            const HIPAcceleratorVector<ValueType>* cast_s
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&scalars);
+
+            assert(cast_x != NULL);
+            assert(cast_s != NULL);
+            assert(this->size_ == cast_x->size_);
+            assert(num >= 0 && num < cast_s->size_);
+            assert(den >= 0 && den < cast_s->size_);
+
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->size_ / this->local_backend_.HIP_block_size + 1);
+
+            kernel_axpy_ratio<<<GridSize,
+                                BlockSize,
+                                0,
+                                HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->size_, factor, cast_s->vec_, num, den, cast_x->vec_, this->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::ScaleRatioAdd(const BaseVector<ValueType>& scalars,
+                                                        int64_t                      num,
+                                                        int64_t                      den,
+                                                        const BaseVector<ValueType>& x)
+    {
+        if(this->size_ > 0)
+        {
+            const HIPAcceleratorVector<ValueType>* cast_x
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&x);
+            const HIPAcceleratorVector<ValueType>* cast_s
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&scalars);
+
+            assert(cast_x != NULL);
+            assert(cast_s != NULL);
+            assert(this->size_ == cast_x->size_);
+            assert(num >= 0 && num < cast_s->size_);
+            assert(den >= 0 && den < cast_s->size_);
+
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->size_ / this->local_backend_.HIP_block_size + 1);
+
+            kernel_scaleadd_ratio<<<GridSize,
+                                    BlockSize,
+                                    0,
+                                    HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->size_, cast_s->vec_, num, den, cast_x->vec_, this->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::BlockDot(int64_t                      nrow,
+                                                   int                          ncol_x,
+                                                   int                          ncol,
+                                                   const BaseVector<ValueType>& x,
+                                                   ValueType*                   res) const
+    {
+        assert(nrow >= 0);
+        assert(ncol_x >= 0);
+        assert(ncol >= 0);
+        assert(res != NULL);
+
+        const HIPAcceleratorVector<ValueType>* cast_x
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&x);
+
+        assert(cast_x != NULL);
+        assert(this->size_ == nrow * ncol);
+        assert(cast_x->size_ == nrow * ncol_x);
+
+        int nres = ncol_x * ncol;
+
+        if(nrow > 0 && nres > 0)
+        {
+            ValueType* dres = NULL;
+            allocate_hip(nres, &dres);
+
+            ValueType alpha = static_cast<ValueType>(1);
+            ValueType beta  = static_cast<ValueType>(0);
+
+            // res = x^H * this
+            rocblas_status status;
+            status = rocblasTgemm(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                                  rocblas_operation_conjugate_transpose,
+                                  rocblas_operation_none,
+                                  ncol_x,
+                                  ncol,
+                                  nrow,
+                                  &alpha,
+                                  cast_x->vec_,
+                                  nrow,
+                                  this->vec_,
+                                  nrow,
+                                  &beta,
+                                  dres,
+                                  ncol_x);
+            CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+            copy_d2h(nres, dres, res, true, HIPSTREAM(this->local_backend_.HIP_stream_current));
+
+            // Synchronize stream to make sure, results are available on the host
+            hipStreamSynchronize(HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&dres);
+        }
+        else
+        {
+            set_to_zero_host(nres, res);
+        }
+    }
+
+    template <>
+    void HIPAcceleratorVector<bool>::BlockDot(
+        int64_t nrow, int ncol_x, int ncol, const BaseVector<bool>& x, bool* res) const
+    {
+        LOG_INFO("No bool block dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int>::BlockDot(
+        int64_t nrow, int ncol_x, int ncol, const BaseVector<int>& x, int* res) const
+    {
+        LOG_INFO("No int block dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int64_t>::BlockDot(
+        int64_t nrow, int ncol_x, int ncol, const BaseVector<int64_t>& x, int64_t* res) const
+    {
+        LOG_INFO("No integral block dot function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::BlockScaleAddProduct(int64_t                      nrow,
+                                                               int                          ncol_x,
+                                                               int                          ncol,
+                                                               ValueType                    alpha,
+                                                               const BaseVector<ValueType>& x,
+                                                               const ValueType*             C,
+                                                               ValueType                    beta)
+    {
+        assert(nrow >= 0);
+        assert(ncol_x >= 0);
+        assert(ncol >= 0);
+        assert(C != NULL);
+
+        const HIPAcceleratorVector<ValueType>* cast_x
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&x);
+
+        assert(cast_x != NULL);
+        assert(this->size_ == nrow * ncol);
+        assert(cast_x->size_ == nrow * ncol_x);
+
+        if(nrow > 0 && ncol > 0)
+        {
+            rocblas_handle handle = ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle);
+
+            ValueType* dC = NULL;
+            allocate_hip(ncol_x * ncol, &dC);
+            copy_h2d(ncol_x * ncol, C, dC);
+
+            rocblas_status status;
+
+            if(cast_x == this)
+            {
+                // gemm cannot work in place, compute tmp = x * C first
+                ValueType* tmp = NULL;
+                allocate_hip(nrow * ncol, &tmp);
+
+                ValueType one  = static_cast<ValueType>(1);
+                ValueType zero = static_cast<ValueType>(0);
+
+                status = rocblasTgemm(handle,
+                                      rocblas_operation_none,
+                                      rocblas_operation_none,
+                                      nrow,
+                                      ncol,
+                                      ncol_x,
+                                      &one,
+                                      cast_x->vec_,
+                                      nrow,
+                                      dC,
+                                      ncol_x,
+                                      &zero,
+                                      tmp,
+                                      nrow);
+                CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+                // this = alpha * this + beta * tmp
+                status = rocblasTgeam(handle,
+                                      rocblas_operation_none,
+                                      rocblas_operation_none,
+                                      nrow,
+                                      ncol,
+                                      &alpha,
+                                      this->vec_,
+                                      nrow,
+                                      &beta,
+                                      tmp,
+                                      nrow,
+                                      this->vec_,
+                                      nrow);
+                CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+                free_hip(&tmp);
+            }
+            else
+            {
+                // this = beta * x * C + alpha * this
+                status = rocblasTgemm(handle,
+                                      rocblas_operation_none,
+                                      rocblas_operation_none,
+                                      nrow,
+                                      ncol,
+                                      ncol_x,
+                                      &beta,
+                                      cast_x->vec_,
+                                      nrow,
+                                      dC,
+                                      ncol_x,
+                                      &alpha,
+                                      this->vec_,
+                                      nrow);
+                CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+            }
+
+            free_hip(&dC);
+        }
+    }
+
+    template <>
+    void HIPAcceleratorVector<bool>::BlockScaleAddProduct(int64_t                 nrow,
+                                                          int                     ncol_x,
+                                                          int                     ncol,
+                                                          bool                    alpha,
+                                                          const BaseVector<bool>& x,
+                                                          const bool*             C,
+                                                          bool                    beta)
+    {
+        LOG_INFO("No bool block product function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int>::BlockScaleAddProduct(int64_t                nrow,
+                                                         int                    ncol_x,
+                                                         int                    ncol,
+                                                         int                    alpha,
+                                                         const BaseVector<int>& x,
+                                                         const int*             C,
+                                                         int                    beta)
+    {
+        LOG_INFO("No int block product function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<int64_t>::BlockScaleAddProduct(int64_t                    nrow,
+                                                             int                        ncol_x,
+                                                             int                        ncol,
+                                                             int64_t                    alpha,
+                                                             const BaseVector<int64_t>& x,
+                                                             const int64_t*             C,
+                                                             int64_t                    beta)
+    {
+        LOG_INFO("No integral block product function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::BlockPointWiseMult(int64_t                      nrow,
+                                                             int                          ncol,
+                                                             const BaseVector<ValueType>& x)
+    {
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+
+        const HIPAcceleratorVector<ValueType>* cast_x
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&x);
+
+        assert(cast_x != NULL);
+        assert(cast_x->size_ == nrow);
+        assert(this->size_ == nrow * ncol);
+
+        if(this->size_ > 0)
+        {
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->size_ / this->local_backend_.HIP_block_size + 1);
+
+            kernel_block_pointwise_mult<<<GridSize,
+                                          BlockSize,
+                                          0,
+                                          HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                nrow, this->size_, cast_x->vec_, this->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <>
+    void HIPAcceleratorVector<bool>::BlockPointWiseMult(int64_t                 nrow,
+                                                        int                     ncol,
+                                                        const BaseVector<bool>& x)
+    {
+        LOG_INFO("No bool block point-wise product function");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    ValueType HIPAcceleratorVector<ValueType>::Norm(void) const
+    {
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return hip_reproducible_dot<true, true>(
+                this->local_backend_, this->size_, this->vec_, this->vec_);
+        }
+
+        ValueType res = static_cast<ValueType>(0);
+
+        if(this->size_ > 0)
+        {
+            rocblas_status status;
+            status = rocblasTnrm2(ROCBLAS_HANDLE(this->local_backend_.ROC_blas_handle),
+                                  this->size_,
+                                  this->vec_,
+                                  1,
+                                  &res);
+            CHECK_ROCBLAS_ERROR(status, __FILE__, __LINE__);
+
+            // Synchronize stream to make sure, result is available on the host
+            hipStreamSynchronize(HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return res;
+    }
+
+    template <>
+    bool HIPAcceleratorVector<bool>::Norm(void) const
+    {
+        LOG_INFO("What is bool HIPAcceleratorVector<ValueType>::Norm(void) const?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    int HIPAcceleratorVector<int>::Norm(void) const
+    {
+        LOG_INFO("What is int HIPAcceleratorVector<ValueType>::Norm(void) const?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    int64_t HIPAcceleratorVector<int64_t>::Norm(void) const
+    {
+        LOG_INFO("What is integral HIPAcceleratorVector<ValueType>::Norm(void) const?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    ValueType HIPAcceleratorVector<ValueType>::Reduce(void) const
+    {
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return hip_reproducible_reduce<false>(this->local_backend_, this->size_, this->vec_);
+        }
+
+        ValueType res = static_cast<ValueType>(0);
+
+        if(this->size_ > 0)
+        {
+            char*  buffer = NULL;
+            size_t size   = 0;
+
+            ValueType* dres = NULL;
+            allocate_hip(1, &dres);
+
+            rocprimTreduce(buffer,
+                           size,
+                           this->vec_,
+                           dres,
+                           this->size_,
+                           HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            allocate_hip(size, &buffer);
+
+            rocprimTreduce(buffer,
+                           size,
+                           this->vec_,
+                           dres,
+                           this->size_,
+                           HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&buffer);
+
+            copy_d2h(1, dres, &res);
+
+            free_hip(&dres);
+        }
+
+        return res;
+    }
+
+    template <>
+    bool HIPAcceleratorVector<bool>::Reduce(void) const
+    {
+        LOG_INFO("What is bool HIPAcceleratorVector::<ValueType>::Reduce(void) const?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    ValueType HIPAcceleratorVector<ValueType>::InclusiveSum(const BaseVector<ValueType>& vec)
+    {
+        if(this->size_ > 0)
+        {
+            const HIPAcceleratorVector<ValueType>* cast_vec
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&vec);
+
+            assert(cast_vec != NULL);
+
+            char*  buffer = NULL;
+            size_t size   = 0;
+
+            rocprimTinclusivesum(buffer,
+                                 size,
+                                 cast_vec->vec_,
+                                 this->vec_,
+                                 this->size_,
+                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            allocate_hip(size, &buffer);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            rocprimTinclusivesum(buffer,
+                                 size,
+                                 cast_vec->vec_,
+                                 this->vec_,
+                                 this->size_,
+                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&buffer);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            ValueType ret;
+            copy_d2h(1, this->vec_ + this->size_ - 1, &ret);
+
+            return ret;
+        }
+
+        return 0;
+    }
+
+    template <>
+    bool HIPAcceleratorVector<bool>::InclusiveSum(const BaseVector<bool>& vec)
+    {
+        LOG_INFO("What is bool HIPAcceleratorVector::InclusiveSum()?");
+        FATAL_ERROR(__FILE__, __LINE__);
+
+        return false;
+    }
+
+    template <typename ValueType>
+    ValueType HIPAcceleratorVector<ValueType>::ExclusiveSum(const BaseVector<ValueType>& vec)
+    {
+        if(this->size_ > 0)
+        {
+            const HIPAcceleratorVector<ValueType>* cast_vec
+                = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&vec);
+
+            assert(cast_vec != NULL);
+
+            char*  buffer = NULL;
+            size_t size   = 0;
+
+            rocprimTexclusivesum(buffer,
+                                 size,
+                                 cast_vec->vec_,
+                                 this->vec_,
+                                 this->size_,
+                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            allocate_hip(size, &buffer);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            rocprimTexclusivesum(buffer,
+                                 size,
+                                 cast_vec->vec_,
+                                 this->vec_,
+                                 this->size_,
+                                 HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&buffer);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            ValueType ret;
+            copy_d2h(1, this->vec_ + this->size_ - 1, &ret);
+
+            return ret;
         }
 
         return 0;
@@ -1086,6 +2093,11 @@ namespace rocalution
     template <typename ValueType>
     ValueType HIPAcceleratorVector<ValueType>::Asum(void) const
     {
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return hip_reproducible_reduce<true>(this->local_backend_, this->size_, this->vec_);
+        }
+
         ValueType res = static_cast<ValueType>(0);
 
         if(this->size_ > 0)
@@ -1222,6 +2234,26 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::SwapData_(HIPAcceleratorVector<ValueType>* vec)
+    {
+        assert(vec != NULL);
+        assert(vec->size_ == this->size_);
+
+        if(this->view_ == true)
+        {
+            copy_d2d(this->size_,
+                     vec->vec_,
+                     this->vec_,
+                     true,
+                     HIPSTREAM(this->local_backend_.HIP_stream_current));
+        }
+        else
+        {
+            std::swap(this->vec_, vec->vec_);
+        }
+    }
+
     template <typename ValueType>
     void HIPAcceleratorVector<ValueType>::Permute(const BaseVector<int>& permutation)
     {
@@ -1233,20 +2265,22 @@ namespace rocalution
             assert(cast_perm != NULL);
             assert(this->size_ == cast_perm->size_);
 
+            // The permuted values are written into a new buffer, that replaces the old one
             HIPAcceleratorVector<ValueType> vec_tmp(this->local_backend_);
             vec_tmp.Allocate(this->size_);
-            vec_tmp.CopyFrom(*this);
 
             dim3 BlockSize(this->local_backend_.HIP_block_size);
             dim3 GridSize(this->size_ / this->local_backend_.HIP_block_size + 1);
 
-            // this->vec_[ cast_perm->vec_[i] ] = vec_tmp.vec_[i];
+            // vec_tmp.vec_[ cast_perm->vec_[i] ] = this->vec_[i];
             kernel_permute<<<GridSize,
                              BlockSize,
                              0,
                              HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-                this->size_, cast_perm->vec_, vec_tmp.vec_, this->vec_);
+                this->size_, cast_perm->vec_, this->vec_, vec_tmp.vec_);
             CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            this->SwapData_(&vec_tmp);
         }
     }
 
@@ -1261,20 +2295,22 @@ namespace rocalution
             assert(cast_perm != NULL);
             assert(this->size_ == cast_perm->size_);
 
+            // The permuted values are written into a new buffer, that replaces the old one
             HIPAcceleratorVector<ValueType> vec_tmp(this->local_backend_);
             vec_tmp.Allocate(this->size_);
-            vec_tmp.CopyFrom(*this);
 
             dim3 BlockSize(this->local_backend_.HIP_block_size);
             dim3 GridSize(this->size_ / this->local_backend_.HIP_block_size + 1);
 
-            //    this->vec_[i] = vec_tmp.vec_[ cast_perm->vec_[i] ];
+            //    vec_tmp.vec_[i] = this->vec_[ cast_perm->vec_[i] ];
             kernel_permute_backward<<<GridSize,
                                       BlockSize,
                                       0,
                                       HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
-                this->size_, cast_perm->vec_, vec_tmp.vec_, this->vec_);
+                this->size_, cast_perm->vec_, this->vec_, vec_tmp.vec_);
             CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            this->SwapData_(&vec_tmp);
         }
     }
 
@@ -1367,6 +2403,155 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::GetIndexValuesFloat(const BaseVector<int>& index,
+                                                              BaseVector<float>*     values) const
+    {
+        LOG_INFO("Mixed precision for non-complex to complex casting is not allowed");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<double>::GetIndexValuesFloat(const BaseVector<int>& index,
+                                                           BaseVector<float>*     values) const
+    {
+        assert(values != NULL);
+
+        const HIPAcceleratorVector<int>* cast_idx
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(&index);
+        HIPAcceleratorVector<float>* cast_vec = dynamic_cast<HIPAcceleratorVector<float>*>(values);
+
+        assert(cast_idx != NULL);
+        assert(cast_vec != NULL);
+        assert(cast_vec->size_ == cast_idx->size_);
+
+        if(cast_idx->size_ > 0)
+        {
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(cast_idx->size_ / this->local_backend_.HIP_block_size + 1);
+
+            // Prepare send buffer, rounding is fused into the gather
+            kernel_get_index_values<<<GridSize,
+                                      BlockSize,
+                                      0,
+                                      HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                cast_idx->size_, cast_idx->vec_, this->vec_, cast_vec->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <>
+    void HIPAcceleratorVector<float>::GetIndexValuesFloat(const BaseVector<int>& index,
+                                                          BaseVector<float>*     values) const
+    {
+        this->GetIndexValues(index, values);
+    }
+
+    template <typename ValueType>
+    ValueType HIPAcceleratorVector<ValueType>::DotFloat(const BaseVector<float>& x) const
+    {
+        LOG_INFO("Mixed precision for non-complex to complex casting is not allowed");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    double HIPAcceleratorVector<double>::DotFloat(const BaseVector<float>& x) const
+    {
+        const HIPAcceleratorVector<float>* cast_x
+            = dynamic_cast<const HIPAcceleratorVector<float>*>(&x);
+
+        assert(cast_x != NULL);
+        assert(this->size_ == cast_x->size_);
+
+        // There is no mixed precision dot in rocBLAS, the single precision entries are
+        // widened while they are loaded in the block reduction
+        return hip_reproducible_dot<false, false>(
+            this->local_backend_, this->size_, this->vec_, cast_x->vec_);
+    }
+
+    template <>
+    float HIPAcceleratorVector<float>::DotFloat(const BaseVector<float>& x) const
+    {
+        return this->Dot(x);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::AddScaleFloat(const BaseVector<float>& x,
+                                                        ValueType                alpha)
+    {
+        LOG_INFO("Mixed precision for non-complex to complex casting is not allowed");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<double>::AddScaleFloat(const BaseVector<float>& x, double alpha)
+    {
+        const HIPAcceleratorVector<float>* cast_x
+            = dynamic_cast<const HIPAcceleratorVector<float>*>(&x);
+
+        assert(cast_x != NULL);
+        assert(this->size_ == cast_x->size_);
+
+        if(this->size_ > 0)
+        {
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->size_ / this->local_backend_.HIP_block_size + 1);
+
+            kernel_axpy_from_float<<<GridSize,
+                                     BlockSize,
+                                     0,
+                                     HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->size_, alpha, cast_x->vec_, this->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <>
+    void HIPAcceleratorVector<float>::AddScaleFloat(const BaseVector<float>& x, float alpha)
+    {
+        this->AddScale(x, alpha);
+    }
+
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::ScaleCopyToFloat(ValueType alpha, BaseVector<float>* vec)
+    {
+        LOG_INFO("Mixed precision for non-complex to complex casting is not allowed");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<double>::ScaleCopyToFloat(double alpha, BaseVector<float>* vec)
+    {
+        assert(vec != NULL);
+
+        HIPAcceleratorVector<float>* cast_vec = dynamic_cast<HIPAcceleratorVector<float>*>(vec);
+
+        assert(cast_vec != NULL);
+        assert(this->size_ == cast_vec->size_);
+
+        if(this->size_ > 0)
+        {
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->size_ / this->local_backend_.HIP_block_size + 1);
+
+            kernel_scale_copy_to_float<<<GridSize,
+                                         BlockSize,
+                                         0,
+                                         HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->size_, alpha, this->vec_, cast_vec->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <>
+    void HIPAcceleratorVector<float>::ScaleCopyToFloat(float alpha, BaseVector<float>* vec)
+    {
+        assert(vec != NULL);
+
+        this->Scale(alpha);
+        vec->CopyFrom(*this);
+    }
+
     template <typename ValueType>
     void HIPAcceleratorVector<ValueType>::SetIndexValues(const BaseVector<int>&       index,
                                                          const BaseVector<ValueType>& values)
@@ -1429,6 +2614,77 @@ namespace rocalution
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
+    template <typename ValueType>
+    bool HIPAcceleratorVector<ValueType>::Restriction(const BaseVector<ValueType>& vec_fine,
+                                                      const BaseVector<int>&       map)
+    {
+        assert(this != &vec_fine);
+
+        const HIPAcceleratorVector<ValueType>* cast_vec
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&vec_fine);
+        const HIPAcceleratorVector<int>* cast_map
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(&map);
+
+        assert(cast_vec != NULL);
+        assert(cast_map != NULL);
+        assert(cast_map->size_ == cast_vec->size_);
+
+        this->Zeros();
+
+        if(cast_map->size_ > 0)
+        {
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(cast_map->size_ / this->local_backend_.HIP_block_size + 1);
+
+            kernel_restriction<<<GridSize,
+                                 BlockSize,
+                                 0,
+                                 HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                cast_map->size_, cast_map->vec_, cast_vec->vec_, this->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
+    template <>
+    bool HIPAcceleratorVector<bool>::Restriction(const BaseVector<bool>& vec_fine,
+                                                 const BaseVector<int>&  map)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool HIPAcceleratorVector<ValueType>::Prolongation(const BaseVector<ValueType>& vec_coarse,
+                                                       const BaseVector<int>&       map)
+    {
+        assert(this != &vec_coarse);
+
+        const HIPAcceleratorVector<ValueType>* cast_vec
+            = dynamic_cast<const HIPAcceleratorVector<ValueType>*>(&vec_coarse);
+        const HIPAcceleratorVector<int>* cast_map
+            = dynamic_cast<const HIPAcceleratorVector<int>*>(&map);
+
+        assert(cast_vec != NULL);
+        assert(cast_map != NULL);
+        assert(cast_map->size_ == this->size_);
+
+        if(this->size_ > 0)
+        {
+            dim3 BlockSize(this->local_backend_.HIP_block_size);
+            dim3 GridSize(this->size_ / this->local_backend_.HIP_block_size + 1);
+
+            kernel_prolongation<<<GridSize,
+                                  BlockSize,
+                                  0,
+                                  HIPSTREAM(this->local_backend_.HIP_stream_current)>>>(
+                this->size_, cast_map->vec_, cast_vec->vec_, this->vec_);
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+        }
+
+        return true;
+    }
+
     template <typename ValueType>
     void HIPAcceleratorVector<ValueType>::GetContinuousValues(int64_t    start,
                                                               int64_t    end,
@@ -1677,7 +2933,7 @@ namespace rocalution
 
             assert(cast_sort != NULL);
 
-            void*  buffer = NULL;
+            char*  buffer = NULL;
             size_t size;
 
             unsigned int begin_bit = 0;
@@ -1696,8 +2952,7 @@ namespace rocalution
                                          HIPSTREAM(this->local_backend_.HIP_stream_current));
                 CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-                hipMalloc(&buffer, size);
-                CHECK_HIP_ERROR(__FILE__, __LINE__);
+                allocate_hip(size, &buffer);
 
                 rocprim::radix_sort_keys(buffer,
                                          size,
@@ -1709,8 +2964,7 @@ namespace rocalution
                                          HIPSTREAM(this->local_backend_.HIP_stream_current));
                 CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-                hipFree(buffer);
-                CHECK_HIP_ERROR(__FILE__, __LINE__);
+                free_hip(&buffer);
             }
             else
             {
@@ -1740,8 +2994,7 @@ namespace rocalution
                                           HIPSTREAM(this->local_backend_.HIP_stream_current));
                 CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-                hipMalloc(&buffer, size);
-                CHECK_HIP_ERROR(__FILE__, __LINE__);
+                allocate_hip(size, &buffer);
 
                 rocprim::radix_sort_pairs(buffer,
                                           size,
@@ -1755,8 +3008,7 @@ namespace rocalution
                                           HIPSTREAM(this->local_backend_.HIP_stream_current));
                 CHECK_HIP_ERROR(__FILE__, __LINE__);
 
-                hipFree(buffer);
-                CHECK_HIP_ERROR(__FILE__, __LINE__);
+                free_hip(&buffer);
             }
         }
     }
@@ -1777,6 +3029,82 @@ namespace rocalution
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
+    template <typename ValueType>
+    void HIPAcceleratorVector<ValueType>::Unique(BaseVector<ValueType>* unique) const
+    {
+        assert(unique != NULL);
+
+        HIPAcceleratorVector<ValueType>* cast_uniq
+            = dynamic_cast<HIPAcceleratorVector<ValueType>*>(unique);
+
+        assert(cast_uniq != NULL);
+
+        cast_uniq->Clear();
+
+        if(this->size_ > 0)
+        {
+            ValueType* tmp   = NULL;
+            int64_t*   count = NULL;
+
+            allocate_hip(this->size_, &tmp);
+            allocate_hip(1, &count);
+
+            char*  buffer = NULL;
+            size_t size;
+
+            rocprim::unique(buffer,
+                            size,
+                            this->vec_,
+                            tmp,
+                            count,
+                            this->size_,
+                            rocprim::equal_to<ValueType>(),
+                            HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            allocate_hip(size, &buffer);
+
+            rocprim::unique(buffer,
+                            size,
+                            this->vec_,
+                            tmp,
+                            count,
+                            this->size_,
+                            rocprim::equal_to<ValueType>(),
+                            HIPSTREAM(this->local_backend_.HIP_stream_current));
+            CHECK_HIP_ERROR(__FILE__, __LINE__);
+
+            free_hip(&buffer);
+
+            // Number of distinct entries
+            int64_t nuniq;
+            copy_d2h(1, count, &nuniq);
+
+            cast_uniq->Allocate(nuniq);
+
+            copy_d2d(nuniq, tmp, cast_uniq->vec_);
+
+            free_hip(&tmp);
+            free_hip(&count);
+        }
+    }
+
+    template <>
+    void HIPAcceleratorVector<std::complex<float>>::Unique(
+        BaseVector<std::complex<float>>* unique) const
+    {
+        LOG_INFO("HIPAcceleratorVector::Unique(), how to compare complex numbers?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HIPAcceleratorVector<std::complex<double>>::Unique(
+        BaseVector<std::complex<double>>* unique) const
+    {
+        LOG_INFO("HIPAcceleratorVector::Unique(), how to compare complex numbers?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
     template class HIPAcceleratorVector<double>;
     template class HIPAcceleratorVector<float>;
 #ifdef SUPPORT_COMPLEX
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -27,6 +27,7 @@
 #include "../../utils/log.hpp"
 #include "../backend_manager.hpp"
 #include "../base_matrix.hpp"
+#include "../base_stencil.hpp"
 #include "../base_vector.hpp"
 
 #include <hip/hip_runtime.h>
@@ -50,6 +51,8 @@ namespace rocalution
         virtual void Allocate(int64_t n);
         virtual void SetDataPtr(ValueType** ptr, int64_t size);
         virtual void LeaveDataPtr(ValueType** ptr);
+        virtual void AttachView(ValueType* ptr, int64_t size);
+        virtual ValueType* GetDataPtr(void) const;
         virtual void Clear(void);
         virtual void Zeros(void);
         virtual void Ones(void);
@@ -64,6 +67,7 @@ namespace rocalution
 
         virtual void CopyTo(BaseVector<ValueType>* dst) const;
         virtual void CopyToAsync(BaseVector<ValueType>* dst) const;
+        virtual void Prefetch(void) const;
         virtual void CopyFromFloat(const BaseVector<float>& src);
         virtual void CopyFromDouble(const BaseVector<double>& src);
 
@@ -85,6 +89,10 @@ namespace rocalution
         virtual void Permute(const BaseVector<int>& permutation);
         virtual void PermuteBackward(const BaseVector<int>& permutation);
 
+        virtual bool Restriction(const BaseVector<ValueType>& vec_fine, const BaseVector<int>& map);
+        virtual bool Prolongation(const BaseVector<ValueType>& vec_coarse,
+                                  const BaseVector<int>&       map);
+
         // this = this + alpha*x
         virtual void AddScale(const BaseVector<ValueType>& x, ValueType alpha);
         // this = alpha*this + x
@@ -110,6 +118,58 @@ namespace rocalution
         virtual ValueType Dot(const BaseVector<ValueType>& x) const;
         // this^T x
         virtual ValueType DotNonConj(const BaseVector<ValueType>& x) const;
+        // res[k] = x[k]^T this, k = 0, ..., count - 1
+        virtual void
+            MultiDot(int count, const BaseVector<ValueType>* const* x, ValueType* res) const;
+        // this = this + sum_k alpha[k] * x[k], k = 0, ..., count - 1
+        virtual void MultiAddScale(int                                 count,
+                                   const BaseVector<ValueType>* const* x,
+                                   const ValueType*                    alpha);
+        // this = this + alpha * x, return this^H y
+        virtual ValueType AddScaleDot(const BaseVector<ValueType>& x,
+                                      ValueType                    alpha,
+                                      const BaseVector<ValueType>& y);
+        // res[0] = this^H x, res[1] = this^H y
+        virtual void DualDot(const BaseVector<ValueType>& x,
+                             const BaseVector<ValueType>& y,
+                             ValueType*                   res) const;
+        // res[index] = this^H x (this^T x if conj is false), kept on the backend
+        virtual void DotToScalar(const BaseVector<ValueType>& x,
+                                 bool                         conj,
+                                 BaseVector<ValueType>*       res,
+                                 int64_t                      index) const;
+        // res[index] = ||this||_2, kept on the backend
+        virtual void NormToScalar(BaseVector<ValueType>* res, int64_t index) const;
+        // this = this + factor * scalars[num] / scalars[den] * x
+        virtual void AddScaleRatio(const BaseVector<ValueType>& x,
+                                   ValueType                    factor,
+                                   const BaseVector<ValueType>& scalars,
+                                   int64_t                      num,
+                                   int64_t                      den);
+        // this = scalars[num] / scalars[den] * this + x
+        virtual void ScaleRatioAdd(const BaseVector<ValueType>& scalars,
+                                   int64_t                      num,
+                                   int64_t                      den,
+                                   const BaseVector<ValueType>& x);
+        // this = program(vec), element-wise in a single pass
+        virtual void Evaluate(const VectorExpressionProgram<ValueType>& program,
+                              const BaseVector<ValueType>* const*       vec);
+        // sum(program(vec))
+        virtual ValueType EvaluateSum(const VectorExpressionProgram<ValueType>& program,
+                                      const BaseVector<ValueType>* const*       vec) const;
+        virtual void BlockDot(int64_t                      nrow,
+                              int                          ncol_x,
+                              int                          ncol,
+                              const BaseVector<ValueType>& x,
+                              ValueType*                   res) const;
+        virtual void BlockScaleAddProduct(int64_t                      nrow,
+                                          int                          ncol_x,
+                                          int                          ncol,
+                                          ValueType                    alpha,
+                                          const BaseVector<ValueType>& x,
+                                          const ValueType*             C,
+                                          ValueType                    beta);
+        virtual void BlockPointWiseMult(int64_t nrow, int ncol, const BaseVector<ValueType>& x);
         // srqt(this^T this)
         virtual ValueType Norm(void) const;
         // reduce
@@ -130,6 +190,11 @@ namespace rocalution
         // get index values
         virtual void GetIndexValues(const BaseVector<int>& index,
                                     BaseVector<ValueType>* values) const;
+        virtual void GetIndexValuesFloat(const BaseVector<int>& index,
+                                         BaseVector<float>*     values) const;
+        virtual ValueType DotFloat(const BaseVector<float>& x) const;
+        virtual void      AddScaleFloat(const BaseVector<float>& x, ValueType alpha);
+        virtual void      ScaleCopyToFloat(ValueType alpha, BaseVector<float>* vec);
         // set index values
         virtual void SetIndexValues(const BaseVector<int>&       index,
                                     const BaseVector<ValueType>& values);
@@ -167,10 +232,18 @@ namespace rocalution
 
         // out of place sort with permutation
         virtual void Sort(BaseVector<ValueType>* sorted, BaseVector<int>* perm) const;
+        virtual void Unique(BaseVector<ValueType>* unique) const;
 
     private:
+        // Take over the data of vec, which has the same size, external buffers are
+        // overwritten instead
+        void SwapData_(HIPAcceleratorVector<ValueType>* vec);
+
         ValueType* vec_;
 
+        // True if vec_ is an external buffer that is not freed by the vector
+        bool view_;
+
         friend class HIPAcceleratorVector<float>;
         friend class HIPAcceleratorVector<double>;
         friend class HIPAcceleratorVector<std::complex<float>>;
@@ -190,6 +263,8 @@ namespace rocalution
         friend class HIPAcceleratorMatrixELL<ValueType>;
         friend class HIPAcceleratorMatrixDENSE<ValueType>;
         friend class HIPAcceleratorMatrixHYB<ValueType>;
+        friend class HIPAcceleratorMatrixSELL<ValueType>;
+        friend class HIPAcceleratorMatrixVBR<ValueType>;
 
         friend class HIPAcceleratorMatrixCOO<double>;
         friend class HIPAcceleratorMatrixCOO<float>;
@@ -200,6 +275,9 @@ namespace rocalution
         friend class HIPAcceleratorMatrixCSR<float>;
         friend class HIPAcceleratorMatrixCSR<std::complex<double>>;
         friend class HIPAcceleratorMatrixCSR<std::complex<float>>;
+
+        friend class HIPAcceleratorStencilLaplace2D<ValueType>;
+        friend class HIPAcceleratorStencilLaplace3D<ValueType>;
     };
 
 } // namespace rocalution
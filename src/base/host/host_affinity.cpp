@@ -33,7 +33,16 @@
 #endif
 
 #if defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__)
+#include <algorithm>
+#include <cstdio>
+#include <dirent.h>
+#include <fstream>
+#include <map>
 #include <sched.h>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
 #endif
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32) \
@@ -48,14 +57,227 @@
 namespace rocalution
 {
 
+#if defined(_OPENMP) \
+    && (defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__))
+
+    // Read a single integer from a sysfs file, -1 if it is not available
+    static int read_sysfs_int(const std::string& path)
+    {
+        std::ifstream file(path);
+
+        int value = -1;
+        if(!(file >> value))
+        {
+            return -1;
+        }
+
+        return value;
+    }
+
+    // NUMA node of each cpu, parsed from the cpu lists (e.g. 0-15,32-47) of the nodes
+    static std::map<int, int> read_sysfs_numa_nodes(void)
+    {
+        std::map<int, int> cpu2node;
+
+        DIR* dir = opendir("/sys/devices/system/node");
+        if(dir == NULL)
+        {
+            return cpu2node;
+        }
+
+        struct dirent* entry;
+        while((entry = readdir(dir)) != NULL)
+        {
+            int node;
+            if(sscanf(entry->d_name, "node%d", &node) != 1)
+            {
+                continue;
+            }
+
+            std::ifstream file("/sys/devices/system/node/" + std::string(entry->d_name)
+                               + "/cpulist");
+            std::string   list;
+            std::getline(file, list);
+
+            std::stringstream ranges(list);
+            std::string       range;
+            while(std::getline(ranges, range, ','))
+            {
+                int first;
+                int last;
+                int n = sscanf(range.c_str(), "%d-%d", &first, &last);
+
+                if(n < 1)
+                {
+                    continue;
+                }
+
+                for(int cpu = first; cpu <= (n == 2 ? last : first); ++cpu)
+                {
+                    cpu2node[cpu] = node;
+                }
+            }
+        }
+
+        closedir(dir);
+
+        return cpu2node;
+    }
+
+    // Order the cpus of the process such that consecutive threads are spread round robin
+    // across the NUMA nodes (or packages, if there is no NUMA information), and such that
+    // each physical core gets one thread before hyperthreads are used. Empty, if the
+    // topology is not available.
+    static std::vector<int> host_cpu_order(void)
+    {
+        cpu_set_t avail;
+        CPU_ZERO(&avail);
+
+        if(sched_getaffinity(0, sizeof(avail), &avail) != 0)
+        {
+            return std::vector<int>();
+        }
+
+        std::map<int, int> cpu2node = read_sysfs_numa_nodes();
+
+        // (smt level, domain, core, cpu), hyperthreads of a core get increasing levels
+        std::vector<std::tuple<int, int, int, int>> topo;
+        std::map<std::pair<int, int>, int>          smt_level;
+
+        for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if(!CPU_ISSET(cpu, &avail))
+            {
+                continue;
+            }
+
+            std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+
+            int package = read_sysfs_int(path + "physical_package_id");
+            int core    = read_sysfs_int(path + "core_id");
+
+            if(package < 0 || core < 0)
+            {
+                return std::vector<int>();
+            }
+
+            int domain = cpu2node.count(cpu) > 0 ? cpu2node[cpu] : package;
+            int smt    = smt_level[std::make_pair(package, core)]++;
+
+            topo.push_back(std::make_tuple(smt, domain, core, cpu));
+        }
+
+        // (smt level, rank within the domain, domain, cpu)
+        std::vector<std::tuple<int, int, int, int>> cpus;
+        std::map<int, int>                          domain_size;
+
+        std::sort(topo.begin(), topo.end());
+
+        for(size_t i = 0; i < topo.size(); ++i)
+        {
+            int domain = std::get<1>(topo[i]);
+
+            cpus.push_back(std::make_tuple(
+                std::get<0>(topo[i]), domain_size[domain]++, domain, std::get<3>(topo[i])));
+        }
+
+        std::sort(cpus.begin(), cpus.end());
+
+        std::vector<int> order(cpus.size());
+        for(size_t i = 0; i < cpus.size(); ++i)
+        {
+            order[i] = std::get<3>(cpus[i]);
+        }
+
+        return order;
+    }
+
+#endif
+
+    int rocalution_bind_numa_node(int node, int slot, int nslots)
+    {
+        assert(slot >= 0);
+        assert(slot < nslots);
+
+#if defined(_OPENMP) \
+    && (defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__))
+        if(node < 0)
+        {
+            return 0;
+        }
+
+        cpu_set_t avail;
+        CPU_ZERO(&avail);
+
+        if(sched_getaffinity(0, sizeof(avail), &avail) != 0)
+        {
+            return 0;
+        }
+
+        std::map<int, int> cpu2node = read_sysfs_numa_nodes();
+
+        // Available cpus of the node, in ascending order
+        std::vector<int> cpus;
+        for(std::map<int, int>::const_iterator it = cpu2node.begin(); it != cpu2node.end(); ++it)
+        {
+            if(it->second == node && CPU_ISSET(it->first, &avail))
+            {
+                cpus.push_back(it->first);
+            }
+        }
+
+        if(cpus.empty())
+        {
+            return 0;
+        }
+
+        // Processes sharing the node get disjoint parts, unless it is oversubscribed
+        size_t begin = 0;
+        size_t end   = cpus.size();
+
+        if(cpus.size() >= static_cast<size_t>(nslots))
+        {
+            begin = cpus.size() * slot / nslots;
+            end   = cpus.size() * (slot + 1) / nslots;
+        }
+
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+
+        for(size_t i = begin; i < end; ++i)
+        {
+            CPU_SET(cpus[i], &mask);
+        }
+
+        if(sched_setaffinity(0, sizeof(mask), &mask) != 0)
+        {
+            return 0;
+        }
+
+        LOG_VERBOSE_INFO(2,
+                         "Host cpus " << cpus[begin] << "-" << cpus[end - 1] << " of NUMA node "
+                                      << node);
+
+        return static_cast<int>(end - begin);
+#else
+        return 0;
+#endif
+    }
+
     void rocalution_set_omp_affinity(bool aff)
     {
         if(aff == true)
         {
 #ifdef _OPENMP
+            // Do not override an explicit binding of the OpenMP runtime
+            if(omp_get_proc_bind() != omp_proc_bind_false)
+            {
+                LOG_VERBOSE_INFO(2, "Host thread affinity policy - OpenMP binding (OMP_PROC_BIND)");
+                return;
+            }
+
 #if defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__)
             cpu_set_t mask;
-            mask.__bits[0] = 600;
 
             CPU_ZERO(&mask);
 #endif // linux
@@ -90,8 +312,28 @@ namespace rocalution
 
             int max_threads = omp_get_max_threads();
 
+            // Pin each thread to its own cpu, spread across the NUMA domains. Together with
+            // the first touch of the host buffers, each thread then works on memory of its
+            // own NUMA node.
+            std::vector<int> order = host_cpu_order();
+
+            if(static_cast<int>(order.size()) >= max_threads)
+            {
+#pragma omp parallel num_threads(max_threads)
+                {
+                    cpu_set_t thread_mask;
+                    CPU_ZERO(&thread_mask);
+                    CPU_SET(order[omp_get_thread_num()], &thread_mask);
+
+                    sched_setaffinity(0, sizeof(thread_mask), &thread_mask);
+                }
+
+                LOG_VERBOSE_INFO(2,
+                                 "Host thread affinity policy - one thread per core, spread "
+                                 "across NUMA nodes");
+            }
             // hyperthreading (2threads <= cores)
-            if(max_threads * 2 <= numCPU)
+            else if(max_threads * 2 <= numCPU)
             {
                 int max_cpu = numCPU;
 
@@ -29,6 +29,11 @@ namespace rocalution
 
     void rocalution_set_omp_affinity(bool aff);
 
+    // Restrict the calling process to the cpus of NUMA node node, that are split into
+    // nslots contiguous parts of which part slot is used. Returns the number of cpus the
+    // process is bound to, 0 if the topology is not available.
+    int rocalution_bind_numa_node(int node, int slot, int nslots);
+
 } // namespace rocalution
 
 #endif // ROCALUTION_HOST_HOST_AFFINITY_HPP_
@@ -29,9 +29,11 @@
 #include "../matrix_formats_ind.hpp"
 #include "rocalution/utils/types.hpp"
 
+#include <algorithm>
 #include <complex>
 #include <cstdlib>
 #include <limits>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -686,6 +688,490 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool csr_to_sell(int                                                 omp_threads,
+                     int64_t                                             nnz,
+                     IndexType                                           nrow,
+                     IndexType                                           ncol,
+                     const MatrixCSR<ValueType, IndexType, PointerType>& src,
+                     IndexType                                           slice_size,
+                     IndexType                                           sigma,
+                     MatrixSELL<ValueType, IndexType, PointerType>*      dst,
+                     int64_t*                                            nnz_sell)
+    {
+        assert(nnz > 0);
+        assert(nrow > 0);
+        assert(ncol > 0);
+        assert(slice_size > 0);
+        assert(sigma > 0);
+        assert(sigma % slice_size == 0);
+
+        omp_set_num_threads(omp_threads);
+
+        dst->slice_size = slice_size;
+        dst->nslice     = (nrow - 1) / slice_size + 1;
+
+        allocate_host(nrow, &dst->perm);
+        allocate_host(dst->nslice + 1, &dst->slice_offset);
+
+        // Sort the rows by decreasing length within each window of sigma rows
+        IndexType nwindow = (nrow - 1) / sigma + 1;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(IndexType w = 0; w < nwindow; ++w)
+        {
+            IndexType begin = w * sigma;
+            IndexType end   = std::min(begin + sigma, nrow);
+
+            for(IndexType i = begin; i < end; ++i)
+            {
+                dst->perm[i] = i;
+            }
+
+            std::stable_sort(dst->perm + begin, dst->perm + end, [&](IndexType a, IndexType b) {
+                return src.row_offset[a + 1] - src.row_offset[a]
+                       > src.row_offset[b + 1] - src.row_offset[b];
+            });
+        }
+
+        // Each slice is as wide as its longest (i.e. first) row
+        dst->slice_offset[0] = 0;
+        for(IndexType s = 0; s < dst->nslice; ++s)
+        {
+            IndexType   row   = dst->perm[s * slice_size];
+            PointerType width = src.row_offset[row + 1] - src.row_offset[row];
+
+            dst->slice_offset[s + 1] = dst->slice_offset[s] + width * slice_size;
+        }
+
+        *nnz_sell = dst->slice_offset[dst->nslice];
+
+        allocate_host(*nnz_sell, &dst->col);
+        allocate_host(*nnz_sell, &dst->val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(IndexType s = 0; s < dst->nslice; ++s)
+        {
+            PointerType offset = dst->slice_offset[s];
+            PointerType width  = (dst->slice_offset[s + 1] - offset) / slice_size;
+
+            for(IndexType r = 0; r < slice_size; ++r)
+            {
+                IndexType   i = s * slice_size + r;
+                PointerType n = 0;
+
+                if(i < nrow)
+                {
+                    IndexType row = dst->perm[i];
+
+                    for(PointerType j = src.row_offset[row]; j < src.row_offset[row + 1]; ++j)
+                    {
+                        PointerType ind = SELL_IND(offset, r, n, slice_size);
+
+                        dst->col[ind] = src.col[j];
+                        dst->val[ind] = src.val[j];
+                        ++n;
+                    }
+                }
+
+                // Pad the remaining entries of the slice
+                for(; n < width; ++n)
+                {
+                    PointerType ind = SELL_IND(offset, r, n, slice_size);
+
+                    dst->col[ind] = static_cast<IndexType>(-1);
+                    dst->val[ind] = static_cast<ValueType>(0);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename IndexType, typename PointerType>
+    IndexType csr_vbr_partition(IndexType               nrow,
+                                const PointerType*      row_offset,
+                                const IndexType*        col,
+                                IndexType               max_blockdim,
+                                std::vector<IndexType>* row_block)
+    {
+        assert(nrow >= 0);
+        assert(max_blockdim > 0);
+        assert(row_block != NULL);
+
+        row_block->clear();
+        row_block->push_back(0);
+
+        for(IndexType i = 1; i < nrow; ++i)
+        {
+            IndexType first = row_block->back();
+
+            // A row joins the current block row, if it has the pattern of its first row
+            bool same = (i - first < max_blockdim)
+                        && (row_offset[i + 1] - row_offset[i]
+                            == row_offset[first + 1] - row_offset[first])
+                        && std::equal(col + row_offset[i],
+                                      col + row_offset[i + 1],
+                                      col + row_offset[first]);
+
+            if(same == false)
+            {
+                row_block->push_back(i);
+            }
+        }
+
+        if(nrow > 0)
+        {
+            row_block->push_back(nrow);
+        }
+
+        return static_cast<IndexType>(row_block->size()) - 1;
+    }
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool csr_to_vbr(int                                                 omp_threads,
+                    int64_t                                             nnz,
+                    IndexType                                           nrow,
+                    IndexType                                           ncol,
+                    const MatrixCSR<ValueType, IndexType, PointerType>& src,
+                    IndexType                                           max_blockdim,
+                    MatrixVBR<ValueType, IndexType, PointerType>*       dst,
+                    int64_t*                                            nnz_vbr)
+    {
+        assert(nnz > 0);
+        assert(nrow > 0);
+        assert(ncol > 0);
+        assert(max_blockdim > 0);
+
+        omp_set_num_threads(omp_threads);
+
+        // Row blocks from the sparsity pattern, square matrices use them for the columns,
+        // too, such that the diagonal blocks are square
+        std::vector<IndexType> row_block;
+
+        dst->nrowb = csr_vbr_partition(nrow, src.row_offset, src.col, max_blockdim, &row_block);
+        dst->ncolb = (nrow == ncol) ? dst->nrowb : ncol;
+
+        allocate_host(dst->nrowb + 1, &dst->row_block);
+        allocate_host(dst->ncolb + 1, &dst->col_block);
+
+        for(IndexType i = 0; i < dst->nrowb + 1; ++i)
+        {
+            dst->row_block[i] = row_block[i];
+        }
+
+        for(IndexType j = 0; j < dst->ncolb + 1; ++j)
+        {
+            dst->col_block[j] = (nrow == ncol) ? row_block[j] : j;
+        }
+
+        // Block column of each column
+        std::vector<IndexType> col2block(ncol);
+
+        for(IndexType j = 0; j < dst->ncolb; ++j)
+        {
+            for(IndexType c = dst->col_block[j]; c < dst->col_block[j + 1]; ++c)
+            {
+                col2block[c] = j;
+            }
+        }
+
+        allocate_host(dst->nrowb + 1, &dst->row_offset);
+        set_to_zero_host(dst->nrowb + 1, dst->row_offset);
+
+        // Number of distinct block columns of each block row
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<IndexType> marker(dst->ncolb, -1);
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(IndexType i = 0; i < dst->nrowb; ++i)
+            {
+                PointerType nblock = 0;
+
+                for(IndexType r = dst->row_block[i]; r < dst->row_block[i + 1]; ++r)
+                {
+                    for(PointerType j = src.row_offset[r]; j < src.row_offset[r + 1]; ++j)
+                    {
+                        IndexType cb = col2block[src.col[j]];
+
+                        if(marker[cb] != i)
+                        {
+                            marker[cb] = i;
+                            ++nblock;
+                        }
+                    }
+                }
+
+                dst->row_offset[i + 1] = nblock;
+            }
+        }
+
+        for(IndexType i = 0; i < dst->nrowb; ++i)
+        {
+            dst->row_offset[i + 1] += dst->row_offset[i];
+        }
+
+        dst->nnzb = dst->row_offset[dst->nrowb];
+
+        allocate_host(dst->nnzb, &dst->col);
+        allocate_host(dst->nnzb + 1, &dst->val_offset);
+
+        // Block columns of each block row in ascending order
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<IndexType> marker(dst->ncolb, -1);
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(IndexType i = 0; i < dst->nrowb; ++i)
+            {
+                PointerType k = dst->row_offset[i];
+
+                for(IndexType r = dst->row_block[i]; r < dst->row_block[i + 1]; ++r)
+                {
+                    for(PointerType j = src.row_offset[r]; j < src.row_offset[r + 1]; ++j)
+                    {
+                        IndexType cb = col2block[src.col[j]];
+
+                        if(marker[cb] != i)
+                        {
+                            marker[cb]    = i;
+                            dst->col[k++] = cb;
+                        }
+                    }
+                }
+
+                std::sort(dst->col + dst->row_offset[i], dst->col + dst->row_offset[i + 1]);
+            }
+        }
+
+        // Each block is stored densely
+        dst->val_offset[0] = 0;
+
+        for(IndexType i = 0; i < dst->nrowb; ++i)
+        {
+            IndexType rbs = dst->row_block[i + 1] - dst->row_block[i];
+
+            for(PointerType k = dst->row_offset[i]; k < dst->row_offset[i + 1]; ++k)
+            {
+                IndexType cbs = dst->col_block[dst->col[k] + 1] - dst->col_block[dst->col[k]];
+
+                dst->val_offset[k + 1] = dst->val_offset[k] + rbs * cbs;
+            }
+        }
+
+        *nnz_vbr = dst->val_offset[dst->nnzb];
+
+        allocate_host(*nnz_vbr, &dst->val);
+        set_to_zero_host(*nnz_vbr, dst->val);
+
+        // Scatter the entries into their blocks
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<PointerType> block(dst->ncolb, -1);
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(IndexType i = 0; i < dst->nrowb; ++i)
+            {
+                IndexType rbs = dst->row_block[i + 1] - dst->row_block[i];
+
+                for(PointerType k = dst->row_offset[i]; k < dst->row_offset[i + 1]; ++k)
+                {
+                    block[dst->col[k]] = k;
+                }
+
+                for(IndexType r = dst->row_block[i]; r < dst->row_block[i + 1]; ++r)
+                {
+                    for(PointerType j = src.row_offset[r]; j < src.row_offset[r + 1]; ++j)
+                    {
+                        IndexType   cb = col2block[src.col[j]];
+                        PointerType k  = block[cb];
+
+                        dst->val[VBR_IND(dst->val_offset[k],
+                                         r - dst->row_block[i],
+                                         src.col[j] - dst->col_block[cb],
+                                         rbs)]
+                            = src.val[j];
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool vbr_to_csr(int                                                 omp_threads,
+                    int64_t                                             nnz,
+                    IndexType                                           nrow,
+                    IndexType                                           ncol,
+                    const MatrixVBR<ValueType, IndexType, PointerType>& src,
+                    MatrixCSR<ValueType, IndexType, PointerType>*       dst,
+                    int64_t*                                            nnz_csr)
+    {
+        assert(nnz > 0);
+        assert(nrow > 0);
+        assert(ncol > 0);
+
+        omp_set_num_threads(omp_threads);
+
+        allocate_host(nrow + 1, &dst->row_offset);
+        set_to_zero_host(nrow + 1, dst->row_offset);
+
+        // All rows of a block row have the columns of its blocks
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(IndexType i = 0; i < src.nrowb; ++i)
+        {
+            PointerType row_nnz = 0;
+
+            for(PointerType k = src.row_offset[i]; k < src.row_offset[i + 1]; ++k)
+            {
+                row_nnz += src.col_block[src.col[k] + 1] - src.col_block[src.col[k]];
+            }
+
+            for(IndexType r = src.row_block[i]; r < src.row_block[i + 1]; ++r)
+            {
+                dst->row_offset[r + 1] = row_nnz;
+            }
+        }
+
+        for(IndexType i = 0; i < nrow; ++i)
+        {
+            dst->row_offset[i + 1] += dst->row_offset[i];
+        }
+
+        *nnz_csr = dst->row_offset[nrow];
+
+        allocate_host(*nnz_csr, &dst->col);
+        allocate_host(*nnz_csr, &dst->val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(IndexType i = 0; i < src.nrowb; ++i)
+        {
+            IndexType rbs = src.row_block[i + 1] - src.row_block[i];
+
+            for(IndexType r = src.row_block[i]; r < src.row_block[i + 1]; ++r)
+            {
+                PointerType ind = dst->row_offset[r];
+
+                for(PointerType k = src.row_offset[i]; k < src.row_offset[i + 1]; ++k)
+                {
+                    IndexType first = src.col_block[src.col[k]];
+                    IndexType cbs   = src.col_block[src.col[k] + 1] - first;
+
+                    for(IndexType c = 0; c < cbs; ++c)
+                    {
+                        dst->col[ind] = first + c;
+                        dst->val[ind]
+                            = src.val[VBR_IND(src.val_offset[k], r - src.row_block[i], c, rbs)];
+                        ++ind;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool sell_to_csr(int                                                  omp_threads,
+                     int64_t                                              nnz,
+                     IndexType                                            nrow,
+                     IndexType                                            ncol,
+                     const MatrixSELL<ValueType, IndexType, PointerType>& src,
+                     MatrixCSR<ValueType, IndexType, PointerType>*        dst,
+                     int64_t*                                             nnz_csr)
+    {
+        assert(nnz > 0);
+        assert(nrow > 0);
+        assert(ncol > 0);
+
+        omp_set_num_threads(omp_threads);
+
+        allocate_host(nrow + 1, &dst->row_offset);
+        set_to_zero_host(nrow + 1, dst->row_offset);
+
+        IndexType slice_size = src.slice_size;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(IndexType i = 0; i < nrow; ++i)
+        {
+            IndexType   s      = i / slice_size;
+            IndexType   r      = i % slice_size;
+            PointerType offset = src.slice_offset[s];
+            PointerType width  = (src.slice_offset[s + 1] - offset) / slice_size;
+
+            for(PointerType n = 0; n < width; ++n)
+            {
+                if(src.col[SELL_IND(offset, r, n, slice_size)] >= 0)
+                {
+                    ++dst->row_offset[src.perm[i]];
+                }
+            }
+        }
+
+        *nnz_csr = 0;
+        for(IndexType i = 0; i < nrow; ++i)
+        {
+            PointerType tmp    = dst->row_offset[i];
+            dst->row_offset[i] = *nnz_csr;
+            *nnz_csr += tmp;
+        }
+
+        dst->row_offset[nrow] = *nnz_csr;
+
+        allocate_host(*nnz_csr, &dst->col);
+        allocate_host(*nnz_csr, &dst->val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(IndexType i = 0; i < nrow; ++i)
+        {
+            IndexType   s      = i / slice_size;
+            IndexType   r      = i % slice_size;
+            PointerType offset = src.slice_offset[s];
+            PointerType width  = (src.slice_offset[s + 1] - offset) / slice_size;
+            PointerType ind    = dst->row_offset[src.perm[i]];
+
+            for(PointerType n = 0; n < width; ++n)
+            {
+                PointerType aj = SELL_IND(offset, r, n, slice_size);
+
+                if(src.col[aj] >= 0)
+                {
+                    dst->col[ind] = src.col[aj];
+                    dst->val[ind] = src.val[aj];
+                    ++ind;
+                }
+            }
+        }
+
+        return true;
+    }
+
     template <typename ValueType, typename IndexType, typename PointerType>
     bool ell_to_csr(int                                           omp_threads,
                     int64_t                                       nnz,
@@ -898,55 +1384,116 @@ namespace rocalution
         allocate_host(nnz, &dst->col);
         allocate_host(nnz, &dst->val);
 
-        // COO has to be sorted by rows
+        // Detect the order of the COO entries
+        bool row_sorted = true;
+        bool col_sorted = true;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(&& : row_sorted, col_sorted)
+#endif
         for(int64_t i = 1; i < nnz; ++i)
         {
-            assert(src.row[i] >= src.row[i - 1]);
+            row_sorted = row_sorted && (src.row[i] >= src.row[i - 1]);
+            col_sorted
+                = col_sorted && (src.row[i] != src.row[i - 1] || src.col[i] >= src.col[i - 1]);
         }
 
-        // Initialize row offset with zeros
-        set_to_zero_host(nrow + 1, dst->row_offset);
-
-        // Compute nnz entries per row of CSR
-        for(int64_t i = 0; i < nnz; ++i)
+        if(row_sorted == true)
         {
-            ++dst->row_offset[src.row[i] + 1];
-        }
+            // Row offsets follow from the positions where the row index changes, no
+            // counting and scan required. Row r starts at the first entry i with
+            // row[i] >= r, each row is assigned by exactly one entry
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int64_t i = 0; i <= nnz; ++i)
+            {
+                IndexType first = (i == 0) ? 0 : src.row[i - 1] + 1;
+                IndexType last  = (i == nnz) ? nrow : src.row[i];
 
-        // Do exclusive scan to obtain row ptrs
-        for(IndexType i = 0; i < nrow; ++i)
+                for(IndexType r = first; r <= last; ++r)
+                {
+                    dst->row_offset[r] = static_cast<PointerType>(i);
+                }
+            }
+
+            copy_h2h(nnz, src.col, dst->col);
+            copy_h2h(nnz, src.val, dst->val);
+        }
+        else
         {
-            dst->row_offset[i + 1] += dst->row_offset[i];
+            // Rows are not grouped, stable counting sort by row
+            set_to_zero_host(nrow + 1, dst->row_offset);
+
+            for(int64_t i = 0; i < nnz; ++i)
+            {
+                ++dst->row_offset[src.row[i] + 1];
+            }
+
+            for(IndexType i = 0; i < nrow; ++i)
+            {
+                dst->row_offset[i + 1] += dst->row_offset[i];
+            }
+
+            std::vector<PointerType> pos(dst->row_offset, dst->row_offset + nrow);
+
+            for(int64_t i = 0; i < nnz; ++i)
+            {
+                PointerType idx = pos[src.row[i]]++;
+
+                dst->col[idx] = src.col[i];
+                dst->val[idx] = src.val[i];
+            }
         }
 
         assert(dst->row_offset[nrow] == nnz);
 
-        copy_h2h(nnz, src.col, dst->col);
-        copy_h2h(nnz, src.val, dst->val);
+        if(col_sorted == true && row_sorted == true)
+        {
+            return true;
+        }
 
-// Sorting the col (per row)
-// Bubble sort algorithm
+        // Sort the columns of each row that is out of order
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-        for(IndexType i = 0; i < nrow; ++i)
         {
-            for(PointerType j = dst->row_offset[i]; j < dst->row_offset[i + 1]; ++j)
+            std::vector<PointerType> perm;
+            std::vector<IndexType>   tmp_col;
+            std::vector<ValueType>   tmp_val;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+            for(IndexType i = 0; i < nrow; ++i)
             {
-                for(PointerType jj = dst->row_offset[i]; jj < dst->row_offset[i + 1] - 1; ++jj)
+                PointerType row_begin = dst->row_offset[i];
+                PointerType row_end   = dst->row_offset[i + 1];
+
+                if(std::is_sorted(dst->col + row_begin, dst->col + row_end) == true)
                 {
-                    if(dst->col[jj] > dst->col[jj + 1])
-                    {
-                        // swap elements
-                        IndexType ind = dst->col[jj];
-                        ValueType val = dst->val[jj];
+                    continue;
+                }
 
-                        dst->col[jj] = dst->col[jj + 1];
-                        dst->val[jj] = dst->val[jj + 1];
+                PointerType row_nnz = row_end - row_begin;
 
-                        dst->col[jj + 1] = ind;
-                        dst->val[jj + 1] = val;
-                    }
+                perm.resize(row_nnz);
+                tmp_col.assign(dst->col + row_begin, dst->col + row_end);
+                tmp_val.assign(dst->val + row_begin, dst->val + row_end);
+
+                for(PointerType j = 0; j < row_nnz; ++j)
+                {
+                    perm[j] = j;
+                }
+
+                std::stable_sort(perm.begin(), perm.end(), [&](PointerType a, PointerType b) {
+                    return tmp_col[a] < tmp_col[b];
+                });
+
+                for(PointerType j = 0; j < row_nnz; ++j)
+                {
+                    dst->col[row_begin + j] = tmp_col[perm[j]];
+                    dst->val[row_begin + j] = tmp_val[perm[j]];
                 }
             }
         }
@@ -1721,6 +2268,160 @@ namespace rocalution
                              MatrixCSR<int, int, PtrType>* dst,
                              int64_t*                      nnz_csr);
 
+    template bool csr_to_sell(int                                    omp_threads,
+                              int64_t                                nnz,
+                              int                                    nrow,
+                              int                                    ncol,
+                              const MatrixCSR<double, int, PtrType>& src,
+                              int                                    slice_size,
+                              int                                    sigma,
+                              MatrixSELL<double, int, PtrType>*      dst,
+                              int64_t*                               nnz_sell);
+
+    template bool csr_to_sell(int                                   omp_threads,
+                              int64_t                               nnz,
+                              int                                   nrow,
+                              int                                   ncol,
+                              const MatrixCSR<float, int, PtrType>& src,
+                              int                                   slice_size,
+                              int                                   sigma,
+                              MatrixSELL<float, int, PtrType>*      dst,
+                              int64_t*                              nnz_sell);
+
+#ifdef SUPPORT_COMPLEX
+    template bool csr_to_sell(int                                                  omp_threads,
+                              int64_t                                              nnz,
+                              int                                                  nrow,
+                              int                                                  ncol,
+                              const MatrixCSR<std::complex<double>, int, PtrType>& src,
+                              int                                                  slice_size,
+                              int                                                  sigma,
+                              MatrixSELL<std::complex<double>, int, PtrType>*      dst,
+                              int64_t*                                             nnz_sell);
+
+    template bool csr_to_sell(int                                                 omp_threads,
+                              int64_t                                             nnz,
+                              int                                                 nrow,
+                              int                                                 ncol,
+                              const MatrixCSR<std::complex<float>, int, PtrType>& src,
+                              int                                                 slice_size,
+                              int                                                 sigma,
+                              MatrixSELL<std::complex<float>, int, PtrType>*      dst,
+                              int64_t*                                            nnz_sell);
+#endif
+
+    template int csr_vbr_partition(int               nrow,
+                                   const PtrType*    row_offset,
+                                   const int*        col,
+                                   int               max_blockdim,
+                                   std::vector<int>* row_block);
+
+    template bool csr_to_vbr(int                                    omp_threads,
+                             int64_t                                nnz,
+                             int                                    nrow,
+                             int                                    ncol,
+                             const MatrixCSR<double, int, PtrType>& src,
+                             int                                    max_blockdim,
+                             MatrixVBR<double, int, PtrType>*       dst,
+                             int64_t*                               nnz_vbr);
+
+    template bool csr_to_vbr(int                                   omp_threads,
+                             int64_t                               nnz,
+                             int                                   nrow,
+                             int                                   ncol,
+                             const MatrixCSR<float, int, PtrType>& src,
+                             int                                   max_blockdim,
+                             MatrixVBR<float, int, PtrType>*       dst,
+                             int64_t*                              nnz_vbr);
+
+#ifdef SUPPORT_COMPLEX
+    template bool csr_to_vbr(int                                                  omp_threads,
+                             int64_t                                              nnz,
+                             int                                                  nrow,
+                             int                                                  ncol,
+                             const MatrixCSR<std::complex<double>, int, PtrType>& src,
+                             int                                                  max_blockdim,
+                             MatrixVBR<std::complex<double>, int, PtrType>*       dst,
+                             int64_t*                                             nnz_vbr);
+
+    template bool csr_to_vbr(int                                                 omp_threads,
+                             int64_t                                             nnz,
+                             int                                                 nrow,
+                             int                                                 ncol,
+                             const MatrixCSR<std::complex<float>, int, PtrType>& src,
+                             int                                                 max_blockdim,
+                             MatrixVBR<std::complex<float>, int, PtrType>*       dst,
+                             int64_t*                                            nnz_vbr);
+#endif
+
+    template bool vbr_to_csr(int                                    omp_threads,
+                             int64_t                                nnz,
+                             int                                    nrow,
+                             int                                    ncol,
+                             const MatrixVBR<double, int, PtrType>& src,
+                             MatrixCSR<double, int, PtrType>*       dst,
+                             int64_t*                               nnz_csr);
+
+    template bool vbr_to_csr(int                                   omp_threads,
+                             int64_t                               nnz,
+                             int                                   nrow,
+                             int                                   ncol,
+                             const MatrixVBR<float, int, PtrType>& src,
+                             MatrixCSR<float, int, PtrType>*       dst,
+                             int64_t*                              nnz_csr);
+
+#ifdef SUPPORT_COMPLEX
+    template bool vbr_to_csr(int                                                  omp_threads,
+                             int64_t                                              nnz,
+                             int                                                  nrow,
+                             int                                                  ncol,
+                             const MatrixVBR<std::complex<double>, int, PtrType>& src,
+                             MatrixCSR<std::complex<double>, int, PtrType>*       dst,
+                             int64_t*                                             nnz_csr);
+
+    template bool vbr_to_csr(int                                                 omp_threads,
+                             int64_t                                             nnz,
+                             int                                                 nrow,
+                             int                                                 ncol,
+                             const MatrixVBR<std::complex<float>, int, PtrType>& src,
+                             MatrixCSR<std::complex<float>, int, PtrType>*       dst,
+                             int64_t*                                            nnz_csr);
+#endif
+
+    template bool sell_to_csr(int                                     omp_threads,
+                              int64_t                                 nnz,
+                              int                                     nrow,
+                              int                                     ncol,
+                              const MatrixSELL<double, int, PtrType>& src,
+                              MatrixCSR<double, int, PtrType>*        dst,
+                              int64_t*                                nnz_csr);
+
+    template bool sell_to_csr(int                                    omp_threads,
+                              int64_t                                nnz,
+                              int                                    nrow,
+                              int                                    ncol,
+                              const MatrixSELL<float, int, PtrType>& src,
+                              MatrixCSR<float, int, PtrType>*        dst,
+                              int64_t*                               nnz_csr);
+
+#ifdef SUPPORT_COMPLEX
+    template bool sell_to_csr(int                                                   omp_threads,
+                              int64_t                                               nnz,
+                              int                                                   nrow,
+                              int                                                   ncol,
+                              const MatrixSELL<std::complex<double>, int, PtrType>& src,
+                              MatrixCSR<std::complex<double>, int, PtrType>*        dst,
+                              int64_t*                                              nnz_csr);
+
+    template bool sell_to_csr(int                                                  omp_threads,
+                              int64_t                                              nnz,
+                              int                                                  nrow,
+                              int                                                  ncol,
+                              const MatrixSELL<std::complex<float>, int, PtrType>& src,
+                              MatrixCSR<std::complex<float>, int, PtrType>*        dst,
+                              int64_t*                                             nnz_csr);
+#endif
+
     template bool coo_to_csr(int                              omp_threads,
                              int64_t                          nnz,
                              int                              nrow,
@@ -26,6 +26,8 @@
 
 #include "../matrix_formats.hpp"
 
+#include <vector>
+
 namespace rocalution
 {
 
@@ -79,6 +81,37 @@ namespace rocalution
                     MatrixELL<ValueType, IndexType>*                    dst,
                     int64_t*                                            nnz_ell);
 
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool csr_to_sell(int                                                 omp_threads,
+                     int64_t                                             nnz,
+                     IndexType                                           nrow,
+                     IndexType                                           ncol,
+                     const MatrixCSR<ValueType, IndexType, PointerType>& src,
+                     IndexType                                           slice_size,
+                     IndexType                                           sigma,
+                     MatrixSELL<ValueType, IndexType, PointerType>*      dst,
+                     int64_t*                                            nnz_sell);
+
+    // Partition the rows into blocks of consecutive rows with identical sparsity pattern
+    // (e.g. the degrees of freedom of a node), of at most max_blockdim rows. row_block
+    // holds the first row of each block row and nrow, the number of block rows is returned.
+    template <typename IndexType, typename PointerType>
+    IndexType csr_vbr_partition(IndexType               nrow,
+                                const PointerType*      row_offset,
+                                const IndexType*        col,
+                                IndexType               max_blockdim,
+                                std::vector<IndexType>* row_block);
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool csr_to_vbr(int                                                 omp_threads,
+                    int64_t                                             nnz,
+                    IndexType                                           nrow,
+                    IndexType                                           ncol,
+                    const MatrixCSR<ValueType, IndexType, PointerType>& src,
+                    IndexType                                           max_blockdim,
+                    MatrixVBR<ValueType, IndexType, PointerType>*       dst,
+                    int64_t*                                            nnz_vbr);
+
     template <typename ValueType, typename IndexType, typename PointerType>
     bool csr_to_hyb(int                                                 omp_threads,
                     int64_t                                             nnz,
@@ -124,6 +157,24 @@ namespace rocalution
                     MatrixCSR<ValueType, IndexType, PointerType>* dst,
                     int64_t*                                      nnz_csr);
 
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool sell_to_csr(int                                                  omp_threads,
+                     int64_t                                              nnz,
+                     IndexType                                            nrow,
+                     IndexType                                            ncol,
+                     const MatrixSELL<ValueType, IndexType, PointerType>& src,
+                     MatrixCSR<ValueType, IndexType, PointerType>*        dst,
+                     int64_t*                                             nnz_csr);
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool vbr_to_csr(int                                                 omp_threads,
+                    int64_t                                             nnz,
+                    IndexType                                           nrow,
+                    IndexType                                           ncol,
+                    const MatrixVBR<ValueType, IndexType, PointerType>& src,
+                    MatrixCSR<ValueType, IndexType, PointerType>*       dst,
+                    int64_t*                                            nnz_csr);
+
     template <typename ValueType, typename IndexType, typename PointerType>
     bool coo_to_csr(int                                           omp_threads,
                     int64_t                                       nnz,
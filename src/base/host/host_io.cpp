@@ -28,6 +28,7 @@
 #include "../../utils/rocsparseio.h"
 #include "rocalution/version.hpp"
 
+#include <algorithm>
 #include <cinttypes>
 #include <complex>
 #include <cstdio>
@@ -36,8 +37,15 @@
 #include <fstream>
 #include <limits>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_max_threads() 1
+#endif
+
 namespace rocalution
 {
 
@@ -131,15 +139,33 @@ namespace rocalution
         return ValueType(real, imag);
     }
 
-    template <typename ValueType>
-    bool mm_read_coordinate(FILE*       fin,
-                            mm_banner&  b,
-                            int&        nrow,
-                            int&        ncol,
-                            int64_t&    nnz,
-                            int**       row,
-                            int**       col,
-                            ValueType** val)
+    // Field of the matrix market values
+    typedef enum _mm_field : int
+    {
+        mm_pattern = 0,
+        mm_real    = 1,
+        mm_complex = 2
+    } mm_field;
+
+    // Size of the blocks, the data section of a matrix market file is read in
+    static const size_t mm_block_size = 16 * 1024 * 1024;
+
+    static mm_field mm_get_field(const mm_banner& b)
+    {
+        if(!strncmp(b.matrix_type, "complex", 7))
+        {
+            return mm_complex;
+        }
+
+        if(!strncmp(b.matrix_type, "pattern", 7))
+        {
+            return mm_pattern;
+        }
+
+        return mm_real;
+    }
+
+    static bool mm_read_size(FILE* fin, int& nrow, int& ncol, int64_t& nnz)
     {
         char line[1025];
 
@@ -163,54 +189,405 @@ namespace rocalution
             }
         }
 
-        // Allocate arrays
-        allocate_host(nnz, row);
-        allocate_host(nnz, col);
-        allocate_host(nnz, val);
+        return (nrow >= 0 && ncol >= 0 && nnz >= 0);
+    }
 
-        // Read data
-        if(!strncmp(b.matrix_type, "complex", 7))
+    // Skip spaces, tabs and carriage returns
+    static inline const char* mm_skip_blank(const char* p, const char* end)
+    {
+        while(p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
         {
-            double real, imag;
-            for(int64_t i = 0; i < nnz; ++i)
+            ++p;
+        }
+
+        return p;
+    }
+
+    // Return the beginning of the line that follows p
+    static inline const char* mm_next_line(const char* p, const char* end)
+    {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+
+        return (eol != NULL) ? eol + 1 : end;
+    }
+
+    // Move p to the beginning of the next entry, empty lines and comments are skipped
+    static inline bool mm_find_entry(const char*& p, const char* end)
+    {
+        while(p < end)
+        {
+            p = mm_skip_blank(p, end);
+
+            if(p < end && *p != '\n' && *p != '%')
+            {
+                return true;
+            }
+
+            p = mm_next_line(p, end);
+        }
+
+        return false;
+    }
+
+    // Parse a (one based) index in [1, max]
+    static inline bool mm_parse_index(const char*& p, const char* end, int max, int& idx)
+    {
+        p = mm_skip_blank(p, end);
+
+        if(p == end || *p < '0' || *p > '9')
+        {
+            return false;
+        }
+
+        int64_t val = 0;
+
+        while(p < end && *p >= '0' && *p <= '9')
+        {
+            val = val * 10 + (*p - '0');
+            ++p;
+
+            if(val > max)
+            {
+                return false;
+            }
+        }
+
+        idx = static_cast<int>(val);
+
+        return idx >= 1;
+    }
+
+    // Parse a floating point number. Decimal numbers with at most 19 significant digits,
+    // whose mantissa is exactly representable and whose exponent is small enough, are
+    // converted by a single (correctly rounded) multiplication or division with an exact
+    // power of ten. All other numbers are left to strtod().
+    static inline bool mm_parse_real(const char*& p, const char* end, double& val)
+    {
+        static const double pow10[]
+            = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+        p = mm_skip_blank(p, end);
+
+        const char* begin = p;
+
+        bool neg = false;
+        if(p < end && (*p == '-' || *p == '+'))
+        {
+            neg = (*p == '-');
+            ++p;
+        }
+
+        uint64_t mant   = 0;
+        int      nsig   = 0;
+        int      exp10  = 0;
+        bool     digits = false;
+        bool     exact  = true;
+
+        // Integer part
+        for(; p < end && *p >= '0' && *p <= '9'; ++p)
+        {
+            digits = true;
+
+            if(nsig < 19)
+            {
+                mant = mant * 10 + (*p - '0');
+                nsig += (mant != 0);
+            }
+            else
+            {
+                exact = false;
+            }
+        }
+
+        // Fractional part
+        if(p < end && *p == '.')
+        {
+            for(++p; p < end && *p >= '0' && *p <= '9'; ++p)
             {
-                if(fscanf(fin, "%d %d %lg %lg", (*row) + i, (*col) + i, &real, &imag) != 4)
+                digits = true;
+
+                if(nsig < 19)
                 {
-                    return false;
+                    mant = mant * 10 + (*p - '0');
+                    nsig += (mant != 0);
+                    --exp10;
+                }
+                else
+                {
+                    exact = false;
                 }
-                --(*row)[i];
-                --(*col)[i];
-                (*val)[i] = read_complex<ValueType>(real, imag);
             }
         }
-        else if(!strncmp(b.matrix_type, "real", 4) || !strncmp(b.matrix_type, "integer", 7))
+
+        // Exponent
+        if(digits && p < end && (*p == 'e' || *p == 'E'))
         {
-            double tmp;
-            for(int64_t i = 0; i < nnz; ++i)
+            const char* q = p + 1;
+
+            bool eneg = false;
+            if(q < end && (*q == '-' || *q == '+'))
+            {
+                eneg = (*q == '-');
+                ++q;
+            }
+
+            if(q < end && *q >= '0' && *q <= '9')
             {
-                if(fscanf(fin, "%d %d %lg\n", (*row) + i, (*col) + i, &tmp) != 3)
+                int e = 0;
+                for(; q < end && *q >= '0' && *q <= '9'; ++q)
                 {
-                    return false;
+                    e = (e < 10000) ? e * 10 + (*q - '0') : e;
                 }
-                --(*row)[i];
-                --(*col)[i];
-                (*val)[i] = read_complex<ValueType>(tmp, tmp);
+
+                exp10 += eneg ? -e : e;
+                p = q;
             }
         }
-        else if(!strncmp(b.matrix_type, "pattern", 7))
+
+        if(digits && exact && mant <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
         {
-            for(int64_t i = 0; i < nnz; ++i)
+            double tmp = static_cast<double>(mant);
+            tmp        = (exp10 < 0) ? tmp / pow10[-exp10] : tmp * pow10[exp10];
+            val        = neg ? -tmp : tmp;
+
+            return true;
+        }
+
+        // Everything else (many digits, large exponents, inf, nan) goes through strtod.
+        // The data is terminated by a line break or the end of the block.
+        char* stop;
+        val = strtod(begin, &stop);
+
+        if(stop == begin)
+        {
+            return false;
+        }
+
+        p = stop;
+
+        return true;
+    }
+
+    // Parse a single entry of a coordinate matrix market file
+    template <typename ValueType>
+    static inline bool mm_parse_entry(const char*& p,
+                                      const char*  end,
+                                      mm_field     field,
+                                      int          nrow,
+                                      int          ncol,
+                                      int&         row,
+                                      int&         col,
+                                      ValueType&   val)
+    {
+        if(!mm_parse_index(p, end, nrow, row) || !mm_parse_index(p, end, ncol, col))
+        {
+            return false;
+        }
+
+        --row;
+        --col;
+
+        if(field == mm_pattern)
+        {
+            val = static_cast<ValueType>(1);
+            return true;
+        }
+
+        double real;
+        if(!mm_parse_real(p, end, real))
+        {
+            return false;
+        }
+
+        double imag = real;
+        if(field == mm_complex && !mm_parse_real(p, end, imag))
+        {
+            return false;
+        }
+
+        val = read_complex<ValueType>(real, imag);
+
+        return true;
+    }
+
+    // Read the (remaining) data section of a matrix market file in large blocks. Each block
+    // ends at a line break and is split at line breaks into one range per thread, thread t
+    // processes [bounds[t], bounds[t + 1]). parse(bounds) is called for each block and
+    // returns false on invalid data.
+    template <typename Function>
+    static bool mm_read_blocks(FILE* fin, Function parse)
+    {
+        int nthreads = omp_get_max_threads();
+
+        std::vector<char>        buffer(mm_block_size + 1);
+        std::vector<const char*> bounds(nthreads + 1);
+
+        size_t size  = mm_block_size;
+        size_t carry = 0;
+
+        while(true)
+        {
+            size_t nread = fread(buffer.data() + carry, 1, size - carry, fin);
+            size_t len   = carry + nread;
+            bool   last  = (nread < size - carry);
+
+            if(last && ferror(fin))
+            {
+                return false;
+            }
+
+            // Cut the block after its last line break, the remainder is carried over
+            size_t stop = len;
+
+            if(last == false)
             {
-                if(fscanf(fin, "%d %d\n", (*row) + i, (*col) + i) != 2)
+                while(stop > 0 && buffer[stop - 1] != '\n')
+                {
+                    --stop;
+                }
+
+                // A single line does not fit into the block
+                if(stop == 0)
                 {
                     return false;
                 }
-                --(*row)[i];
-                --(*col)[i];
-                (*val)[i] = static_cast<ValueType>(1);
             }
+
+            // Terminate the block for strtod()
+            char tail    = buffer[stop];
+            buffer[stop] = '\0';
+
+            const char* begin = buffer.data();
+            const char* end   = begin + stop;
+
+            bounds[0]        = begin;
+            bounds[nthreads] = end;
+
+            for(int t = 1; t < nthreads; ++t)
+            {
+                const char* b = std::max(begin + (stop / nthreads) * t, bounds[t - 1]);
+
+                if(b > begin && b[-1] != '\n')
+                {
+                    b = mm_next_line(b, end);
+                }
+
+                bounds[t] = b;
+            }
+
+            bool status = parse(bounds);
+
+            buffer[stop] = tail;
+
+            if(status == false)
+            {
+                return false;
+            }
+
+            if(last == true)
+            {
+                return true;
+            }
+
+            carry = len - stop;
+            memmove(buffer.data(), buffer.data() + stop, carry);
         }
-        else
+    }
+
+    template <typename ValueType>
+    bool mm_read_coordinate(FILE*       fin,
+                            mm_banner&  b,
+                            int&        nrow,
+                            int&        ncol,
+                            int64_t&    nnz,
+                            int**       row,
+                            int**       col,
+                            ValueType** val)
+    {
+        if(mm_read_size(fin, nrow, ncol, nnz) != true)
+        {
+            return false;
+        }
+
+        // Allocate arrays
+        allocate_host(nnz, row);
+        allocate_host(nnz, col);
+        allocate_host(nnz, val);
+
+        mm_field field = mm_get_field(b);
+
+        // Number of entries that have been read
+        int64_t pos = 0;
+
+        // Each thread counts the entries of its range first, such that all threads can
+        // then write their entries in file order
+        auto parse = [&](const std::vector<const char*>& bounds) -> bool {
+            int nt = static_cast<int>(bounds.size()) - 1;
+
+            std::vector<int64_t> offset(nt + 1, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+            for(int t = 0; t < nt; ++t)
+            {
+                const char* p = bounds[t];
+
+                while(mm_find_entry(p, bounds[t + 1]))
+                {
+                    ++offset[t + 1];
+                    p = mm_next_line(p, bounds[t + 1]);
+                }
+            }
+
+            offset[0] = pos;
+            for(int t = 0; t < nt; ++t)
+            {
+                offset[t + 1] += offset[t];
+            }
+
+            if(offset[nt] > nnz)
+            {
+                return false;
+            }
+
+            int nerr = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1) reduction(+ : nerr)
+#endif
+            for(int t = 0; t < nt; ++t)
+            {
+                const char* p   = bounds[t];
+                int64_t     idx = offset[t];
+
+                while(mm_find_entry(p, bounds[t + 1]))
+                {
+                    if(!mm_parse_entry(p,
+                                       bounds[t + 1],
+                                       field,
+                                       nrow,
+                                       ncol,
+                                       (*row)[idx],
+                                       (*col)[idx],
+                                       (*val)[idx]))
+                    {
+                        ++nerr;
+                        break;
+                    }
+
+                    ++idx;
+                    p = mm_next_line(p, bounds[t + 1]);
+                }
+            }
+
+            pos = offset[nt];
+
+            return nerr == 0;
+        };
+
+        if(mm_read_blocks(fin, parse) != true || pos != nnz)
         {
             return false;
         }
@@ -276,51 +653,275 @@ namespace rocalution
         return true;
     }
 
-    template <typename ValueType>
-    bool read_matrix_mtx(int&        nrow,
-                         int&        ncol,
-                         int64_t&    nnz,
-                         int**       row,
-                         int**       col,
-                         ValueType** val,
-                         const char* filename)
+    template <typename ValueType, typename PointerType>
+    bool mm_read_coordinate_csr(FILE*         fin,
+                                mm_banner&    b,
+                                int&          nrow,
+                                int&          ncol,
+                                int64_t&      nnz,
+                                PointerType** ptr,
+                                int**         col,
+                                ValueType**   val)
     {
-        FILE* file = fopen(filename, "r");
-
-        if(!file)
+        if(mm_read_size(fin, nrow, ncol, nnz) != true)
         {
-            LOG_INFO("ReadFileMTX: cannot open file " << filename);
             return false;
         }
 
-        // read banner
-        mm_banner banner;
-        if(mm_read_banner(file, banner) != true)
-        {
-            LOG_INFO("ReadFileMTX: invalid matrix market banner");
-            return false;
-        }
+        // Symmetric and hermitian matrices are expanded
+        bool     sym   = (strncmp(b.storage_type, "general", 7) != 0);
+        mm_field field = mm_get_field(b);
 
-        if(strncmp(banner.array_type, "coordinate", 10))
+        // The data section is read twice, first to count the entries of each row
+        long data = ftell(fin);
+
+        if(data < 0)
         {
             return false;
         }
-        else
-        {
-            if(mm_read_coordinate(file, banner, nrow, ncol, nnz, row, col, val) != true)
-            {
-                LOG_INFO("ReadFileMTX: invalid matrix data");
-                return false;
-            }
-        }
 
-        fclose(file);
+        allocate_host(nrow + 1, ptr);
+        set_to_zero_host(nrow + 1, *ptr);
 
-        return true;
-    }
+        int64_t nentries = 0;
+        int64_t ntot     = 0;
 
-    template <typename ValueType,
-              typename std::enable_if<std::is_same<ValueType, float>::value
+        auto count = [&](const std::vector<const char*>& bounds) -> bool {
+            int nt = static_cast<int>(bounds.size()) - 1;
+
+            int     nerr   = 0;
+            int64_t nent   = 0;
+            int64_t nentry = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1) reduction(+ : nerr, nent, nentry)
+#endif
+            for(int t = 0; t < nt; ++t)
+            {
+                const char* p = bounds[t];
+
+                while(mm_find_entry(p, bounds[t + 1]))
+                {
+                    int i;
+                    int j;
+
+                    if(!mm_parse_index(p, bounds[t + 1], nrow, i)
+                       || !mm_parse_index(p, bounds[t + 1], ncol, j))
+                    {
+                        ++nerr;
+                        break;
+                    }
+
+                    // Indices are one based, i.e. row i - 1 is counted in ptr[i]
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+                    ++(*ptr)[i];
+
+                    ++nentry;
+                    ++nent;
+
+                    if(sym && i != j)
+                    {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+                        ++(*ptr)[j];
+
+                        ++nent;
+                    }
+
+                    p = mm_next_line(p, bounds[t + 1]);
+                }
+            }
+
+            nentries += nentry;
+            ntot += nent;
+
+            return (nerr == 0) && (nentries <= nnz);
+        };
+
+        if(mm_read_blocks(fin, count) != true || nentries != nnz
+           || ntot > static_cast<int64_t>(std::numeric_limits<PointerType>::max()))
+        {
+            free_host(ptr);
+            return false;
+        }
+
+        // Row offsets from the row counts
+        for(int i = 0; i < nrow; ++i)
+        {
+            (*ptr)[i + 1] += (*ptr)[i];
+        }
+
+        allocate_host(ntot, col);
+        allocate_host(ntot, val);
+
+        // Next free slot of each row
+        std::vector<PointerType> offset(*ptr, *ptr + nrow);
+        PointerType*             next = offset.data();
+
+        // Second pass, scatter the entries into their rows. The order of the entries within
+        // a row depends on the scheduling, the caller sorts the rows.
+        auto scatter = [&](const std::vector<const char*>& bounds) -> bool {
+            int nt = static_cast<int>(bounds.size()) - 1;
+
+            int nerr = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1) reduction(+ : nerr)
+#endif
+            for(int t = 0; t < nt; ++t)
+            {
+                const char* p = bounds[t];
+
+                while(mm_find_entry(p, bounds[t + 1]))
+                {
+                    int       i;
+                    int       j;
+                    ValueType v;
+
+                    if(!mm_parse_entry(p, bounds[t + 1], field, nrow, ncol, i, j, v))
+                    {
+                        ++nerr;
+                        break;
+                    }
+
+                    PointerType idx;
+
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+                    idx = next[i]++;
+
+                    (*col)[idx] = j;
+                    (*val)[idx] = v;
+
+                    if(sym && i != j)
+                    {
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+                        idx = next[j]++;
+
+                        (*col)[idx] = i;
+                        (*val)[idx] = v;
+                    }
+
+                    p = mm_next_line(p, bounds[t + 1]);
+                }
+            }
+
+            return nerr == 0;
+        };
+
+        if(fseek(fin, data, SEEK_SET) != 0 || mm_read_blocks(fin, scatter) != true)
+        {
+            free_host(ptr);
+            free_host(col);
+            free_host(val);
+            return false;
+        }
+
+        nnz = ntot;
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool read_matrix_mtx(int&        nrow,
+                         int&        ncol,
+                         int64_t&    nnz,
+                         int**       row,
+                         int**       col,
+                         ValueType** val,
+                         const char* filename)
+    {
+        FILE* file = fopen(filename, "rb");
+
+        if(!file)
+        {
+            LOG_INFO("ReadFileMTX: cannot open file " << filename);
+            return false;
+        }
+
+        // read banner
+        mm_banner banner;
+        if(mm_read_banner(file, banner) != true)
+        {
+            LOG_INFO("ReadFileMTX: invalid matrix market banner");
+            fclose(file);
+            return false;
+        }
+
+        if(strncmp(banner.array_type, "coordinate", 10))
+        {
+            fclose(file);
+            return false;
+        }
+        else
+        {
+            if(mm_read_coordinate(file, banner, nrow, ncol, nnz, row, col, val) != true)
+            {
+                LOG_INFO("ReadFileMTX: invalid matrix data");
+                fclose(file);
+                return false;
+            }
+        }
+
+        fclose(file);
+
+        return true;
+    }
+
+    template <typename ValueType, typename PointerType>
+    bool read_matrix_mtx_csr(int&          nrow,
+                             int&          ncol,
+                             int64_t&      nnz,
+                             PointerType** ptr,
+                             int**         col,
+                             ValueType**   val,
+                             const char*   filename)
+    {
+        FILE* file = fopen(filename, "rb");
+
+        if(!file)
+        {
+            LOG_INFO("ReadFileMTX: cannot open file " << filename);
+            return false;
+        }
+
+        // read banner
+        mm_banner banner;
+        if(mm_read_banner(file, banner) != true)
+        {
+            LOG_INFO("ReadFileMTX: invalid matrix market banner");
+            fclose(file);
+            return false;
+        }
+
+        if(strncmp(banner.array_type, "coordinate", 10))
+        {
+            fclose(file);
+            return false;
+        }
+        else
+        {
+            if(mm_read_coordinate_csr(file, banner, nrow, ncol, nnz, ptr, col, val) != true)
+            {
+                LOG_INFO("ReadFileMTX: invalid matrix data");
+                fclose(file);
+                return false;
+            }
+        }
+
+        fclose(file);
+
+        return true;
+    }
+
+    template <typename ValueType,
+              typename std::enable_if<std::is_same<ValueType, float>::value
                                           || std::is_same<ValueType, double>::value,
                                       int>::type
               = 0>
@@ -410,98 +1011,93 @@ namespace rocalution
         return true;
     }
 
-    static inline void read_csr_values(std::ifstream& in, int64_t nnz, float* val)
+    // Read n entries of an array, that is stored as FileType, in blocks into the buffers of
+    // the receiver. Entries are converted if the types differ.
+    template <typename FileType, typename DataType, typename Receiver>
+    static bool read_csr_array_blocks(std::ifstream& in,
+                                      int64_t        n,
+                                      Receiver&      recv,
+                                      DataType* (Receiver::*block)(int64_t, int64_t))
     {
-        // Temporary array to convert from double to float
-        std::vector<double> tmp(nnz);
+        int64_t block_size
+            = csr_block_size / static_cast<int64_t>(std::max(sizeof(FileType), sizeof(DataType)));
 
-        // Read double values
-        in.read((char*)tmp.data(), sizeof(double) * nnz);
+        // Temporary block to convert from the file type
+        std::vector<FileType> tmp;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(int64_t i = 0; i < nnz; ++i)
+        for(int64_t offset = 0; offset < n; offset += block_size)
         {
-            val[i] = static_cast<float>(tmp[i]);
-        }
-    }
-
-    static inline void read_csr_values(std::ifstream& in, int64_t nnz, double* val)
-    {
-        // Read double values
-        in.read((char*)val, sizeof(double) * nnz);
-    }
+            int64_t   size = std::min(block_size, n - offset);
+            DataType* data = (recv.*block)(offset, size);
 
-    static inline void read_csr_values(std::ifstream& in, int64_t nnz, std::complex<float>* val)
-    {
-        // Temporary array to convert from complex double to complex float
-        std::vector<std::complex<double>> tmp(nnz);
+            if(data == NULL)
+            {
+                return false;
+            }
 
-        // Read in double complex values
-        in.read((char*)tmp.data(), sizeof(std::complex<double>) * nnz);
+            if(std::is_same<FileType, DataType>::value)
+            {
+                // We can directly read into the block
+                in.read((char*)data, sizeof(DataType) * size);
+            }
+            else
+            {
+                tmp.resize(size);
+                in.read((char*)tmp.data(), sizeof(FileType) * size);
 
 #ifdef _OPENMP
 #pragma omp parallel for schedule(dynamic, 1024)
 #endif
-        for(int64_t i = 0; i < nnz; ++i)
-        {
-            val[i] = std::complex<float>(static_cast<float>(tmp[i].real()),
-                                         static_cast<float>(tmp[i].imag()));
+                for(int64_t i = 0; i < size; ++i)
+                {
+                    data[i] = static_cast<DataType>(tmp[i]);
+                }
+            }
+
+            if(!in)
+            {
+                return false;
+            }
+
+            recv.Commit();
         }
-    }
 
-    static inline void read_csr_values(std::ifstream& in, int64_t nnz, std::complex<double>* val)
-    {
-        // Read in double complex values
-        in.read((char*)val, sizeof(std::complex<double>) * nnz);
+        return true;
     }
 
-    static inline void read_csr_row_ptr_32(std::ifstream& in, int64_t nrow, int* ptr)
+    // Values are stored in double precision
+    template <typename Receiver>
+    static bool read_csr_value_blocks(std::ifstream& in, int64_t nnz, Receiver& recv, float*)
     {
-        // We can directly read into array
-        in.read((char*)ptr, sizeof(int) * (nrow + 1));
+        return read_csr_array_blocks<double>(in, nnz, recv, &Receiver::ValueBlock);
     }
 
-    static inline void read_csr_row_ptr_32(std::ifstream& in, int64_t nrow, int64_t* ptr)
+    template <typename Receiver>
+    static bool read_csr_value_blocks(std::ifstream& in, int64_t nnz, Receiver& recv, double*)
     {
-        // Temporary array to convert from 32 to 64 bit
-        std::vector<int> tmp(nrow + 1);
-
-        // Read 32 bit integers
-        in.read((char*)tmp.data(), sizeof(int) * (nrow + 1));
-
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(int64_t i = 0; i < nrow + 1; ++i)
-        {
-            ptr[i] = static_cast<int64_t>(tmp[i]);
-        }
+        return read_csr_array_blocks<double>(in, nnz, recv, &Receiver::ValueBlock);
     }
 
-    static inline void read_csr_row_ptr_64(std::ifstream& in, int64_t nrow, int* ptr)
+    template <typename Receiver>
+    static bool
+        read_csr_value_blocks(std::ifstream& in, int64_t nnz, Receiver& recv, std::complex<float>*)
     {
-        // We cannot read without overflow, skip and throw warning
-        LOG_INFO("ReadFileCSR: cannot read 64 bit sparsity pattern into 32 bit structure");
-        FATAL_ERROR(__FILE__, __LINE__);
+        return read_csr_array_blocks<std::complex<double>>(in, nnz, recv, &Receiver::ValueBlock);
     }
 
-    static inline void read_csr_row_ptr_64(std::ifstream& in, int64_t nrow, int64_t* ptr)
+    template <typename Receiver>
+    static bool
+        read_csr_value_blocks(std::ifstream& in, int64_t nnz, Receiver& recv, std::complex<double>*)
     {
-        // We can directly read into array
-        in.read((char*)ptr, sizeof(int64_t) * (nrow + 1));
+        return read_csr_array_blocks<std::complex<double>>(in, nnz, recv, &Receiver::ValueBlock);
     }
 
     template <typename ValueType, typename IndexType, typename PointerType>
-    bool read_matrix_csr(int64_t&      nrow,
-                         int64_t&      ncol,
-                         int64_t&      nnz,
-                         PointerType** ptr,
-                         IndexType**   col,
-                         ValueType**   val,
-                         const char*   filename)
+    bool read_matrix_csr_blocks(CSRBlockReceiver<ValueType, IndexType, PointerType>& recv,
+                                const char*                                          filename)
     {
+        typedef CSRBlockReceiver<ValueType, IndexType, PointerType> Receiver;
+
         std::ifstream in(filename, std::ios::in | std::ios::binary);
 
         if(!in.is_open())
@@ -514,234 +1110,1285 @@ namespace rocalution
         std::string header;
         std::getline(in, header);
 
-        if(header != "#rocALUTION binary csr file")
+        if(header != "#rocALUTION binary csr file")
+        {
+            LOG_INFO("ReadFileCSR: invalid rocALUTION matrix header");
+            return false;
+        }
+
+        // rocALUTION version
+        int version;
+        in.read((char*)&version, sizeof(int));
+
+        int64_t nrow;
+        int64_t ncol;
+        int64_t nnz;
+
+        // Row pointers are stored in 64 bit only for large files
+        bool ptr64 = false;
+
+        // We need backward compatibility
+        if(version < 30000)
+        {
+            // 32 bit backward compatibility sizes
+            int nrow32;
+            int ncol32;
+            int nnz32;
+
+            // Read sizes
+            in.read((char*)&nrow32, sizeof(int));
+            in.read((char*)&ncol32, sizeof(int));
+            in.read((char*)&nnz32, sizeof(int));
+
+            // Convert to 64 bit
+            nrow = static_cast<int64_t>(nrow32);
+            ncol = static_cast<int64_t>(ncol32);
+            nnz  = static_cast<int64_t>(nnz32);
+        }
+        else
+        {
+            // Read sizes
+            in.read((char*)&nrow, sizeof(int64_t));
+            in.read((char*)&ncol, sizeof(int64_t));
+            in.read((char*)&nnz, sizeof(int64_t));
+
+            // Precision is determined by nnz
+            ptr64 = (nnz >= std::numeric_limits<int>::max());
+        }
+
+        //        if(version != __ROCALUTION_VER)
+        //        {
+        //            LOG_INFO("ReadFileCSR: file version mismatch");
+        //            return false;
+        //        }
+
+        if(!in || nrow < 0 || ncol < 0 || nnz < 0)
+        {
+            LOG_INFO("ReadFileCSR: invalid matrix data");
+            return false;
+        }
+
+        if(ptr64 == true && sizeof(PointerType) < sizeof(int64_t))
+        {
+            // We cannot read without overflow
+            LOG_INFO("ReadFileCSR: cannot read 64 bit sparsity pattern into 32 bit structure");
+            return false;
+        }
+
+        if(recv.Allocate(nrow, ncol, nnz) != true)
+        {
+            return false;
+        }
+
+        // Read row pointers, columns and values
+        bool status
+            = (ptr64 == true)
+                  ? read_csr_array_blocks<int64_t>(in, nrow + 1, recv, &Receiver::RowOffsetBlock)
+                  : read_csr_array_blocks<int>(in, nrow + 1, recv, &Receiver::RowOffsetBlock);
+
+        status = status && read_csr_array_blocks<int>(in, nnz, recv, &Receiver::ColumnBlock);
+        status = status && read_csr_value_blocks(in, nnz, recv, static_cast<ValueType*>(NULL));
+
+        if(status == false)
+        {
+            LOG_INFO("ReadFileCSR: invalid matrix data");
+            return false;
+        }
+
+        in.close();
+
+        return true;
+    }
+
+    // Receiver that reads the blocks directly into host arrays
+    template <typename ValueType, typename IndexType, typename PointerType>
+    class HostCSRBlockReceiver : public CSRBlockReceiver<ValueType, IndexType, PointerType>
+    {
+    public:
+        HostCSRBlockReceiver()
+            : nrow(0)
+            , ncol(0)
+            , nnz(0)
+            , ptr(NULL)
+            , col(NULL)
+            , val(NULL)
+        {
+        }
+
+        virtual ~HostCSRBlockReceiver()
+        {
+            free_host(&this->ptr);
+            free_host(&this->col);
+            free_host(&this->val);
+        }
+
+        virtual bool Allocate(int64_t nrow, int64_t ncol, int64_t nnz)
+        {
+            this->nrow = nrow;
+            this->ncol = ncol;
+            this->nnz  = nnz;
+
+            allocate_host(nrow + 1, &this->ptr);
+            allocate_host(nnz, &this->col);
+            allocate_host(nnz, &this->val);
+
+            return true;
+        }
+
+        virtual PointerType* RowOffsetBlock(int64_t offset, int64_t n)
+        {
+            return this->ptr + offset;
+        }
+
+        virtual IndexType* ColumnBlock(int64_t offset, int64_t n)
+        {
+            return this->col + offset;
+        }
+
+        virtual ValueType* ValueBlock(int64_t offset, int64_t n)
+        {
+            return this->val + offset;
+        }
+
+        virtual void Commit(void) {}
+
+        int64_t nrow;
+        int64_t ncol;
+        int64_t nnz;
+
+        PointerType* ptr;
+        IndexType*   col;
+        ValueType*   val;
+    };
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool read_matrix_csr(int64_t&      nrow,
+                         int64_t&      ncol,
+                         int64_t&      nnz,
+                         PointerType** ptr,
+                         IndexType**   col,
+                         ValueType**   val,
+                         const char*   filename)
+    {
+        HostCSRBlockReceiver<ValueType, IndexType, PointerType> recv;
+
+        if(read_matrix_csr_blocks(recv, filename) != true)
+        {
+            return false;
+        }
+
+        nrow = recv.nrow;
+        ncol = recv.ncol;
+        nnz  = recv.nnz;
+
+        // Hand over the arrays
+        *ptr = recv.ptr;
+        *col = recv.col;
+        *val = recv.val;
+
+        recv.ptr = NULL;
+        recv.col = NULL;
+        recv.val = NULL;
+
+        return true;
+    }
+
+    template <typename T>
+    rocsparseio_type type2rocsparseio_type();
+
+    template <>
+    rocsparseio_type type2rocsparseio_type<std::complex<float>>()
+    {
+        return rocsparseio_type_complex32;
+    }
+
+    template <>
+    rocsparseio_type type2rocsparseio_type<std::complex<double>>()
+    {
+        return rocsparseio_type_complex64;
+    }
+
+    template <>
+    rocsparseio_type type2rocsparseio_type<float>()
+    {
+        return rocsparseio_type_float32;
+    }
+
+    template <>
+    rocsparseio_type type2rocsparseio_type<double>()
+    {
+        return rocsparseio_type_float64;
+    }
+
+    template <>
+    rocsparseio_type type2rocsparseio_type<int32_t>()
+    {
+        return rocsparseio_type_int32;
+    }
+
+    template <>
+    rocsparseio_type type2rocsparseio_type<int8_t>()
+    {
+        return rocsparseio_type_int8;
+    }
+
+    template <>
+    rocsparseio_type type2rocsparseio_type<int64_t>()
+    {
+        return rocsparseio_type_int64;
+    }
+
+    template <typename X, typename Y>
+    inline void copy_mixed_arrays(size_t size, X* __restrict__ x, const Y* __restrict__ y)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(size_t i = 0; i < size; ++i)
+        {
+            x[i] = static_cast<X>(y[i]);
+        }
+    }
+
+    template <>
+    inline void copy_mixed_arrays(size_t size,
+                                  std::complex<float>* __restrict__ x,
+                                  const std::complex<double>* __restrict__ y)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(size_t i = 0; i < size; ++i)
+        {
+            x[i] = std::complex<float>(static_cast<float>(std::real(y[i])),
+                                       static_cast<float>(std::imag(y[i])));
+        }
+    }
+
+    template <>
+    inline void copy_mixed_arrays(size_t size,
+                                  std::complex<double>* __restrict__ x,
+                                  const std::complex<float>* __restrict__ y)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(size_t i = 0; i < size; ++i)
+        {
+            x[i] = std::complex<double>(static_cast<double>(std::real(y[i])),
+                                        static_cast<double>(std::imag(y[i])));
+        }
+    }
+
+    template <>
+    inline void copy_mixed_arrays(size_t size,
+                                  int8_t* __restrict__ x,
+                                  const std::complex<float>* __restrict__ y)
+    {
+        throw 1;
+    }
+
+    template <>
+    inline void copy_mixed_arrays(size_t size,
+                                  int8_t* __restrict__ x,
+                                  const std::complex<double>* __restrict__ y)
+    {
+        throw 1;
+    }
+
+    template <>
+    inline void copy_mixed_arrays(size_t size,
+                                  float* __restrict__ x,
+                                  const std::complex<float>* __restrict__ y)
+    {
+        throw 1;
+    }
+
+    template <>
+    inline void copy_mixed_arrays(size_t size,
+                                  float* __restrict__ x,
+                                  const std::complex<double>* __restrict__ y)
+    {
+        throw 1;
+    }
+
+    template <>
+    inline void copy_mixed_arrays(size_t size,
+                                  double* __restrict__ x,
+                                  const std::complex<float>* __restrict__ y)
+    {
+        throw 1;
+    }
+
+    template <>
+    inline void copy_mixed_arrays(size_t size,
+                                  double* __restrict__ x,
+                                  const std::complex<double>* __restrict__ y)
+    {
+        throw 1;
+    }
+
+    // Check the size and member count that precede an array of a rocsparseio file
+    static bool rsio_check_array(FILE* in, int64_t offset, uint64_t size, uint64_t nmemb)
+    {
+        uint64_t meta[2];
+
+        if(fseek(in, offset, SEEK_SET) != 0 || fread(meta, sizeof(uint64_t), 2, in) != 2)
+        {
+            return false;
+        }
+
+        return meta[0] == size && meta[1] == nmemb;
+    }
+
+    template <typename ValueType>
+    bool read_matrix_csr_layout(CSRFileLayout& layout, const char* filename)
+    {
+        std::ifstream in(filename, std::ios::in | std::ios::binary);
+
+        if(!in.is_open())
+        {
+            LOG_INFO("ReadFileCSR: cannot open file " << filename);
+            return false;
+        }
+
+        // Header
+        std::string header;
+        std::getline(in, header);
+
+        if(header != "#rocALUTION binary csr file")
+        {
+            LOG_INFO("ReadFileCSR: invalid rocALUTION matrix header");
+            return false;
+        }
+
+        // rocALUTION version
+        int version;
+        in.read((char*)&version, sizeof(int));
+
+        // Row pointers are stored in 64 bit only for large files
+        bool ptr64 = false;
+
+        // We need backward compatibility
+        if(version < 30000)
+        {
+            int nrow32;
+            int ncol32;
+            int nnz32;
+
+            in.read((char*)&nrow32, sizeof(int));
+            in.read((char*)&ncol32, sizeof(int));
+            in.read((char*)&nnz32, sizeof(int));
+
+            layout.nrow = static_cast<int64_t>(nrow32);
+            layout.ncol = static_cast<int64_t>(ncol32);
+            layout.nnz  = static_cast<int64_t>(nnz32);
+        }
+        else
+        {
+            in.read((char*)&layout.nrow, sizeof(int64_t));
+            in.read((char*)&layout.ncol, sizeof(int64_t));
+            in.read((char*)&layout.nnz, sizeof(int64_t));
+
+            ptr64 = (layout.nnz >= std::numeric_limits<int>::max());
+        }
+
+        if(!in || layout.nrow < 0 || layout.ncol < 0 || layout.nnz < 0)
+        {
+            LOG_INFO("ReadFileCSR: invalid matrix data");
+            return false;
+        }
+
+        // Values are stored in double precision
+        rocsparseio_type type = type2rocsparseio_type<ValueType>();
+        bool             cplx = (type == rocsparseio_type_complex32)
+                    || (type == rocsparseio_type_complex64);
+
+        layout.base = 0;
+
+        layout.ptr_type = ptr64 ? rocsparseio_type_int64 : rocsparseio_type_int32;
+        layout.col_type = rocsparseio_type_int32;
+        layout.val_type = cplx ? rocsparseio_type_complex64 : rocsparseio_type_float64;
+
+        layout.ptr_size = ptr64 ? sizeof(int64_t) : sizeof(int);
+        layout.col_size = sizeof(int);
+        layout.val_size = cplx ? sizeof(std::complex<double>) : sizeof(double);
+
+        layout.ptr_offset = static_cast<int64_t>(in.tellg());
+        layout.col_offset = layout.ptr_offset + (layout.nrow + 1) * layout.ptr_size;
+        layout.val_offset = layout.col_offset + layout.nnz * layout.col_size;
+
+        // The file has to hold all arrays
+        in.seekg(0, std::ios::end);
+
+        if(static_cast<int64_t>(in.tellg()) < layout.val_offset + layout.nnz * layout.val_size)
+        {
+            LOG_INFO("ReadFileCSR: invalid matrix data");
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool read_matrix_csr_rocsparseio_layout(CSRFileLayout& layout, const char* filename)
+    {
+        if(is_matrix_csr_compressed(filename) == true)
+        {
+            LOG_INFO("ReadFileRSIO: rows of compressed files cannot be addressed directly");
+            return false;
+        }
+
+        rocsparseio_handle handle;
+
+        if(rocsparseio_open(&handle, rocsparseio_rwmode_read, filename)
+           != rocsparseio_status_success)
+        {
+            LOG_INFO("ReadFileRSIO: cannot open file " << filename);
+            return false;
+        }
+
+        rocsparseio_direction  file_direction;
+        rocsparseio_index_base file_base;
+        uint64_t               file_nrow;
+        uint64_t               file_ncol;
+        uint64_t               file_nnz;
+        rocsparseio_type       file_ptr_type;
+        rocsparseio_type       file_ind_type;
+        rocsparseio_type       file_val_type;
+
+        rocsparseio_status status = rocsparseiox_read_metadata_sparse_csx(handle,
+                                                                          &file_direction,
+                                                                          &file_nrow,
+                                                                          &file_ncol,
+                                                                          &file_nnz,
+                                                                          &file_ptr_type,
+                                                                          &file_ind_type,
+                                                                          &file_val_type,
+                                                                          &file_base);
+        rocsparseio_close(handle);
+
+        if(status != rocsparseio_status_success)
+        {
+            LOG_INFO("ReadFileRSIO: rocsparseiox_read_metadata_sparse_csx failed");
+            return false;
+        }
+
+        if(file_direction != rocsparseio_direction_row)
+        {
+            LOG_INFO("ReadFileRSIO: the matrix is stored with a CSC format.");
+            return false;
+        }
+
+        if(file_nrow > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())
+           || file_ncol > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())
+           || file_nnz > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+        {
+            LOG_INFO("ReadFileRSIO: matrix sizes from file exceed int64_t limit");
+            return false;
+        }
+
+        bool index_type = (file_ptr_type == rocsparseio_type_int32
+                           || file_ptr_type == rocsparseio_type_int64)
+                          && (file_ind_type == rocsparseio_type_int32
+                              || file_ind_type == rocsparseio_type_int64);
+
+        // Complex values cannot be read into a real matrix
+        rocsparseio_type type = type2rocsparseio_type<ValueType>();
+        bool             cplx = (type == rocsparseio_type_complex32)
+                    || (type == rocsparseio_type_complex64);
+
+        bool value_type = (file_val_type == rocsparseio_type_float32)
+                          || (file_val_type == rocsparseio_type_float64)
+                          || (cplx == true && file_val_type == rocsparseio_type_complex32)
+                          || (cplx == true && file_val_type == rocsparseio_type_complex64);
+
+        if(index_type == false || value_type == false)
+        {
+            LOG_INFO("ReadFileRSIO: unsupported data types");
+            return false;
+        }
+
+        uint64_t ptr_size;
+        uint64_t col_size;
+        uint64_t val_size;
+
+        rocsparseio_type_get_size(file_ptr_type, &ptr_size);
+        rocsparseio_type_get_size(file_ind_type, &col_size);
+        rocsparseio_type_get_size(file_val_type, &val_size);
+
+        layout.nrow = static_cast<int64_t>(file_nrow);
+        layout.ncol = static_cast<int64_t>(file_ncol);
+        layout.nnz  = static_cast<int64_t>(file_nnz);
+        layout.base = (file_base == rocsparseio_index_base_one) ? 1 : 0;
+
+        layout.ptr_type = file_ptr_type;
+        layout.col_type = file_ind_type;
+        layout.val_type = file_val_type;
+
+        layout.ptr_size = static_cast<int>(ptr_size);
+        layout.col_size = static_cast<int>(col_size);
+        layout.val_size = static_cast<int>(val_size);
+
+        // File header, object name and meta data are followed by the arrays, each array is
+        // preceded by its element size and member count
+        int64_t ptr_meta
+            = 2 * sizeof(uint64_t) + sizeof(rocsparseio_string) + 9 * sizeof(uint64_t);
+        int64_t col_meta = ptr_meta + 2 * sizeof(uint64_t) + (layout.nrow + 1) * layout.ptr_size;
+        int64_t val_meta = col_meta + 2 * sizeof(uint64_t) + layout.nnz * layout.col_size;
+
+        layout.ptr_offset = ptr_meta + 2 * sizeof(uint64_t);
+        layout.col_offset = col_meta + 2 * sizeof(uint64_t);
+        layout.val_offset = val_meta + 2 * sizeof(uint64_t);
+
+        // Verify the array meta data
+        FILE* in = fopen(filename, "rb");
+
+        if(in == NULL)
+        {
+            LOG_INFO("ReadFileRSIO: cannot open file " << filename);
+            return false;
+        }
+
+        bool valid = rsio_check_array(in, ptr_meta, ptr_size, file_nrow + 1)
+                     && rsio_check_array(in, col_meta, col_size, file_nnz)
+                     && rsio_check_array(in, val_meta, val_size, file_nnz);
+
+        fclose(in);
+
+        if(valid == false)
+        {
+            LOG_INFO("ReadFileRSIO: invalid matrix data");
+            return false;
+        }
+
+        return true;
+    }
+
+    void convert_csr_file_indices(int64_t n, int type, const char* raw, int64_t* idx)
+    {
+        if(type == rocsparseio_type_int32)
+        {
+            copy_mixed_arrays(n, idx, reinterpret_cast<const int32_t*>(raw));
+        }
+        else
+        {
+            // rocsparseio_type_int64
+            copy_mixed_arrays(n, idx, reinterpret_cast<const int64_t*>(raw));
+        }
+    }
+
+    template <typename ValueType>
+    void convert_csr_file_values(int64_t n, int type, const char* raw, ValueType* val)
+    {
+        switch(type)
+        {
+        case rocsparseio_type_float32:
+            copy_mixed_arrays(n, val, reinterpret_cast<const float*>(raw));
+            break;
+        case rocsparseio_type_float64:
+            copy_mixed_arrays(n, val, reinterpret_cast<const double*>(raw));
+            break;
+        case rocsparseio_type_complex32:
+            copy_mixed_arrays(n, val, reinterpret_cast<const std::complex<float>*>(raw));
+            break;
+        case rocsparseio_type_complex64:
+            copy_mixed_arrays(n, val, reinterpret_cast<const std::complex<double>*>(raw));
+            break;
+        }
+    }
+
+    template <typename ValueType>
+    void write_matrix_csr_layout(
+        int64_t nrow, int64_t ncol, int64_t nnz, CSRFileLayout& layout, std::string& header)
+    {
+        // Same choice of types as in read_matrix_csr_layout()
+        bool ptr64 = (nnz >= std::numeric_limits<int>::max());
+
+        rocsparseio_type type = type2rocsparseio_type<ValueType>();
+        bool             cplx = (type == rocsparseio_type_complex32)
+                    || (type == rocsparseio_type_complex64);
+
+        int version = __ROCALUTION_VER;
+
+        header = "#rocALUTION binary csr file\n";
+        header.append(reinterpret_cast<const char*>(&version), sizeof(int));
+        header.append(reinterpret_cast<const char*>(&nrow), sizeof(int64_t));
+        header.append(reinterpret_cast<const char*>(&ncol), sizeof(int64_t));
+        header.append(reinterpret_cast<const char*>(&nnz), sizeof(int64_t));
+
+        layout.nrow = nrow;
+        layout.ncol = ncol;
+        layout.nnz  = nnz;
+        layout.base = 0;
+
+        layout.ptr_type = ptr64 ? rocsparseio_type_int64 : rocsparseio_type_int32;
+        layout.col_type = rocsparseio_type_int32;
+        layout.val_type = cplx ? rocsparseio_type_complex64 : rocsparseio_type_float64;
+
+        layout.ptr_size = ptr64 ? sizeof(int64_t) : sizeof(int);
+        layout.col_size = sizeof(int);
+        layout.val_size = cplx ? sizeof(std::complex<double>) : sizeof(double);
+
+        layout.ptr_offset = static_cast<int64_t>(header.size());
+        layout.col_offset = layout.ptr_offset + (layout.nrow + 1) * layout.ptr_size;
+        layout.val_offset = layout.col_offset + layout.nnz * layout.col_size;
+    }
+
+    template <typename ValueType>
+    bool read_vector_layout(
+        int64_t& size, int64_t& offset, int& val_type, int& val_size, const char* filename)
+    {
+        std::ifstream in(filename, std::ios::in | std::ios::binary);
+
+        if(!in.is_open())
+        {
+            LOG_INFO("ReadFileBinary: cannot open file " << filename);
+            return false;
+        }
+
+        // Header
+        std::string header;
+        std::getline(in, header);
+
+        if(header != "#rocALUTION binary vector file")
+        {
+            LOG_INFO("ReadFileBinary: invalid rocALUTION vector header");
+            return false;
+        }
+
+        // rocALUTION version
+        int version;
+        in.read((char*)&version, sizeof(int));
+
+        // We need backward compatibility, v3.0.0 and later store sizes with 64 bits
+        if(version < 30000)
+        {
+            int size32;
+            in.read((char*)&size32, sizeof(int));
+
+            size = static_cast<int64_t>(size32);
+        }
+        else
+        {
+            in.read((char*)&size, sizeof(int64_t));
+        }
+
+        if(!in || size < 0)
+        {
+            LOG_INFO("ReadFileBinary: invalid vector data");
+            return false;
+        }
+
+        // Values are stored in double precision
+        rocsparseio_type type = type2rocsparseio_type<ValueType>();
+        bool             cplx = (type == rocsparseio_type_complex32)
+                    || (type == rocsparseio_type_complex64);
+
+        val_type = cplx ? rocsparseio_type_complex64 : rocsparseio_type_float64;
+        val_size = cplx ? sizeof(std::complex<double>) : sizeof(double);
+        offset   = static_cast<int64_t>(in.tellg());
+
+        // The file has to hold all values
+        in.seekg(0, std::ios::end);
+
+        if(static_cast<int64_t>(in.tellg()) < offset + size * val_size)
+        {
+            LOG_INFO("ReadFileBinary: invalid vector data");
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void write_vector_layout(int64_t size, int& val_type, int& val_size, std::string& header)
+    {
+        rocsparseio_type type = type2rocsparseio_type<ValueType>();
+        bool             cplx = (type == rocsparseio_type_complex32)
+                    || (type == rocsparseio_type_complex64);
+
+        int version = __ROCALUTION_VER;
+
+        header = "#rocALUTION binary vector file\n";
+        header.append(reinterpret_cast<const char*>(&version), sizeof(int));
+        header.append(reinterpret_cast<const char*>(&size), sizeof(int64_t));
+
+        val_type = cplx ? rocsparseio_type_complex64 : rocsparseio_type_float64;
+        val_size = cplx ? sizeof(std::complex<double>) : sizeof(double);
+    }
+
+    void convert_csr_file_indices_raw(int64_t n, int type, const int64_t* idx, char* raw)
+    {
+        if(type == rocsparseio_type_int32)
+        {
+            copy_mixed_arrays(n, reinterpret_cast<int32_t*>(raw), idx);
+        }
+        else
+        {
+            // rocsparseio_type_int64
+            copy_mixed_arrays(n, reinterpret_cast<int64_t*>(raw), idx);
+        }
+    }
+
+    template <typename ValueType>
+    void convert_csr_file_values_raw(int64_t n, int type, const ValueType* val, char* raw)
+    {
+        if(type == rocsparseio_type_complex64)
+        {
+            copy_mixed_arrays(n, reinterpret_cast<std::complex<double>*>(raw), val);
+        }
+        else
+        {
+            // rocsparseio_type_float64
+            copy_mixed_arrays(n, reinterpret_cast<double*>(raw), val);
+        }
+    }
+
+    // Compressed CSR files start with this magic
+    static const char csr_compressed_magic[16] = "ROCALUTION.CSRZ";
+
+    // Version of the compressed CSR format
+    static const uint64_t csr_compressed_version = 1;
+
+    // Chunks of a compressed CSR file hold whole rows and up to this number of entries, the
+    // chunks are encoded and decoded in parallel
+    static const int64_t csr_compressed_chunk_nnz = 1 << 20;
+
+    // Values in a chunk start at this alignment, chunk sizes are multiples of it
+    static const int64_t csr_compressed_align = 16;
+
+    // Value encodings of a chunk
+    enum csr_compressed_codec
+    {
+        csr_codec_raw = 0,
+        csr_codec_xor = 1
+    };
+
+    // XOR encoding of n words, each word is XORed with the word stride positions before
+    // (the same component of the previous value) and only the non-zero low order bytes of
+    // the result are stored. The byte counts of two words share a header byte.
+    template <typename WordType>
+    static void
+        xor_encode(int64_t n, int stride, const WordType* w, std::vector<unsigned char>& buf)
+    {
+        for(int64_t k = 0; k < n; k += 2)
+        {
+            size_t head = buf.size();
+            buf.push_back(0);
+
+            for(int64_t q = k; q < std::min(n, k + 2); ++q)
+            {
+                WordType x = w[q] ^ ((q >= stride) ? w[q - stride] : 0);
+
+                int nbytes = 0;
+                for(WordType t = x; t != 0; t >>= 8)
+                {
+                    buf.push_back(static_cast<unsigned char>(t & 0xff));
+                    ++nbytes;
+                }
+
+                buf[head] |= static_cast<unsigned char>(nbytes << (4 * (q - k)));
+            }
+        }
+    }
+
+    template <typename WordType>
+    static bool xor_decode(
+        const unsigned char*& p, const unsigned char* end, int64_t n, int stride, WordType* w)
+    {
+        for(int64_t k = 0; k < n; k += 2)
+        {
+            if(p >= end)
+            {
+                return false;
+            }
+
+            unsigned char head = *p++;
+
+            for(int64_t q = k; q < std::min(n, k + 2); ++q)
+            {
+                int nbytes = (head >> (4 * (q - k))) & 0xf;
+
+                if(nbytes > static_cast<int>(sizeof(WordType)) || end - p < nbytes)
+                {
+                    return false;
+                }
+
+                WordType x = 0;
+                for(int b = 0; b < nbytes; ++b)
+                {
+                    x |= static_cast<WordType>(*p++) << (8 * b);
+                }
+
+                w[q] = x ^ ((q >= stride) ? w[q - stride] : 0);
+            }
+        }
+
+        return true;
+    }
+
+    // Encode n values of rocsparseio type id type with the XOR encoding
+    static void encode_values_xor(int64_t                     n,
+                                  int                         type,
+                                  const char*                 raw,
+                                  std::vector<unsigned char>& buf)
+    {
+        int cplx = (type == rocsparseio_type_complex32 || type == rocsparseio_type_complex64);
+
+        if(type == rocsparseio_type_float32 || type == rocsparseio_type_complex32)
+        {
+            std::vector<uint32_t> w((1 + cplx) * n);
+            memcpy(w.data(), raw, w.size() * sizeof(uint32_t));
+            xor_encode(static_cast<int64_t>(w.size()), 1 + cplx, w.data(), buf);
+        }
+        else
+        {
+            std::vector<uint64_t> w((1 + cplx) * n);
+            memcpy(w.data(), raw, w.size() * sizeof(uint64_t));
+            xor_encode(static_cast<int64_t>(w.size()), 1 + cplx, w.data(), buf);
+        }
+    }
+
+    static bool decode_values_xor(
+        const unsigned char*& p, const unsigned char* end, int64_t n, int type, char* raw)
+    {
+        int cplx = (type == rocsparseio_type_complex32 || type == rocsparseio_type_complex64);
+
+        bool status;
+
+        if(type == rocsparseio_type_float32 || type == rocsparseio_type_complex32)
+        {
+            std::vector<uint32_t> w((1 + cplx) * n);
+            status = xor_decode(p, end, static_cast<int64_t>(w.size()), 1 + cplx, w.data());
+            memcpy(raw, w.data(), w.size() * sizeof(uint32_t));
+        }
+        else
+        {
+            std::vector<uint64_t> w((1 + cplx) * n);
+            status = xor_decode(p, end, static_cast<int64_t>(w.size()), 1 + cplx, w.data());
+            memcpy(raw, w.data(), w.size() * sizeof(uint64_t));
+        }
+
+        return status;
+    }
+
+    static inline void varint_put(uint64_t x, std::vector<unsigned char>& buf)
+    {
+        while(x >= 0x80)
+        {
+            buf.push_back(static_cast<unsigned char>(x | 0x80));
+            x >>= 7;
+        }
+
+        buf.push_back(static_cast<unsigned char>(x));
+    }
+
+    static inline bool varint_get(const unsigned char*& p, const unsigned char* end, uint64_t& x)
+    {
+        x = 0;
+
+        for(int shift = 0; p < end && shift < 64; shift += 7)
+        {
+            unsigned char b = *p++;
+
+            x |= static_cast<uint64_t>(b & 0x7f) << shift;
+
+            if((b & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Map signed deltas to unsigned integers, small magnitudes give short varints
+    static inline uint64_t zigzag_encode(int64_t x)
+    {
+        return (static_cast<uint64_t>(x) << 1) ^ static_cast<uint64_t>(x >> 63);
+    }
+
+    static inline int64_t zigzag_decode(uint64_t x)
+    {
+        return static_cast<int64_t>(x >> 1) ^ -static_cast<int64_t>(x & 1);
+    }
+
+    bool is_matrix_csr_compressed(const char* filename)
+    {
+        std::ifstream in(filename, std::ios::in | std::ios::binary);
+
+        char magic[16];
+
+        if(!in.is_open() || !in.read(magic, sizeof(magic)))
+        {
+            return false;
+        }
+
+        return memcmp(magic, csr_compressed_magic, sizeof(magic)) == 0;
+    }
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool write_matrix_csr_compressed(int64_t            nrow,
+                                     int64_t            ncol,
+                                     int64_t            nnz,
+                                     const PointerType* ptr,
+                                     const IndexType*   col,
+                                     const ValueType*   val,
+                                     const char*        filename)
+    {
+        std::ofstream out(filename, std::ios::out | std::ios::binary);
+
+        if(!out.is_open())
+        {
+            LOG_INFO("WriteFileRSIO: cannot open file " << filename);
+            return false;
+        }
+
+        // Chunk boundaries
+        std::vector<int64_t> chunk_row(1, 0);
+
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            int64_t begin = chunk_row.back();
+
+            if(ptr[i + 1] - ptr[begin] >= csr_compressed_chunk_nnz
+               || i + 1 - begin >= csr_compressed_chunk_nnz || i + 1 == nrow)
+            {
+                chunk_row.push_back(i + 1);
+            }
+        }
+
+        int64_t nchunk = static_cast<int64_t>(chunk_row.size()) - 1;
+
+        // Encode the chunks, each chunk consists of the varint row lengths, the zigzag
+        // varint column deltas and the XOR encoded or (aligned) raw values
+        std::vector<std::vector<unsigned char>> chunk(nchunk);
+        std::vector<uint64_t>                   codec(nchunk);
+
+        int val_type = type2rocsparseio_type<ValueType>();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for(int64_t c = 0; c < nchunk; ++c)
+        {
+            std::vector<unsigned char>& buf = chunk[c];
+
+            int64_t row_begin = chunk_row[c];
+            int64_t row_end   = chunk_row[c + 1];
+            int64_t chunk_nnz = ptr[row_end] - ptr[row_begin];
+
+            buf.reserve(row_end - row_begin + 2 * chunk_nnz
+                        + chunk_nnz * sizeof(ValueType) + 2 * csr_compressed_align);
+
+            for(int64_t i = row_begin; i < row_end; ++i)
+            {
+                varint_put(ptr[i + 1] - ptr[i], buf);
+            }
+
+            for(int64_t i = row_begin; i < row_end; ++i)
+            {
+                // Deltas of the first entry of a row are taken from the diagonal
+                int64_t prev = i;
+
+                for(PointerType j = ptr[i]; j < ptr[i + 1]; ++j)
+                {
+                    varint_put(zigzag_encode(static_cast<int64_t>(col[j]) - prev), buf);
+                    prev = col[j];
+                }
+            }
+
+            const char* v = reinterpret_cast<const char*>(val + ptr[row_begin]);
+
+            // Values are XOR encoded, unless this does not pay off, e.g. for random values
+            std::vector<unsigned char> xor_buf;
+            encode_values_xor(chunk_nnz, val_type, v, xor_buf);
+
+            if(xor_buf.size() < chunk_nnz * sizeof(ValueType))
+            {
+                codec[c] = csr_codec_xor;
+                buf.insert(buf.end(), xor_buf.begin(), xor_buf.end());
+            }
+            else
+            {
+                codec[c] = csr_codec_raw;
+                buf.resize((buf.size() + csr_compressed_align - 1) / csr_compressed_align
+                           * csr_compressed_align);
+                buf.insert(buf.end(), v, v + chunk_nnz * sizeof(ValueType));
+            }
+
+            buf.resize((buf.size() + csr_compressed_align - 1) / csr_compressed_align
+                       * csr_compressed_align);
+        }
+
+        // Header
+        uint64_t version   = csr_compressed_version;
+        uint64_t file_type = val_type;
+
+        out.write(csr_compressed_magic, sizeof(csr_compressed_magic));
+        out.write((char*)&version, sizeof(uint64_t));
+        out.write((char*)&nrow, sizeof(int64_t));
+        out.write((char*)&ncol, sizeof(int64_t));
+        out.write((char*)&nnz, sizeof(int64_t));
+        out.write((char*)&file_type, sizeof(uint64_t));
+        out.write((char*)&nchunk, sizeof(int64_t));
+
+        // Chunk table, number of rows, entries, bytes and value encoding of each chunk
+        for(int64_t c = 0; c < nchunk; ++c)
+        {
+            uint64_t entry[4];
+
+            entry[0] = chunk_row[c + 1] - chunk_row[c];
+            entry[1] = ptr[chunk_row[c + 1]] - ptr[chunk_row[c]];
+            entry[2] = chunk[c].size();
+            entry[3] = codec[c];
+
+            out.write((char*)entry, sizeof(entry));
+        }
+
+        // Chunk data
+        for(int64_t c = 0; c < nchunk; ++c)
+        {
+            out.write((char*)chunk[c].data(), chunk[c].size());
+        }
+
+        if(!out)
+        {
+            LOG_INFO("WriteFileRSIO: filename=" << filename << "; could not write to file");
+            return false;
+        }
+
+        out.close();
+
+        return true;
+    }
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool read_matrix_csr_compressed(int64_t&      nrow,
+                                    int64_t&      ncol,
+                                    int64_t&      nnz,
+                                    PointerType** ptr,
+                                    IndexType**   col,
+                                    ValueType**   val,
+                                    const char*   filename)
+    {
+        std::ifstream in(filename, std::ios::in | std::ios::binary);
+
+        if(!in.is_open())
+        {
+            LOG_INFO("ReadFileRSIO: cannot open file " << filename);
+            return false;
+        }
+
+        char     magic[16];
+        uint64_t version;
+        uint64_t val_type;
+        int64_t  nchunk;
+
+        in.read(magic, sizeof(magic));
+        in.read((char*)&version, sizeof(uint64_t));
+        in.read((char*)&nrow, sizeof(int64_t));
+        in.read((char*)&ncol, sizeof(int64_t));
+        in.read((char*)&nnz, sizeof(int64_t));
+        in.read((char*)&val_type, sizeof(uint64_t));
+        in.read((char*)&nchunk, sizeof(int64_t));
+
+        if(!in || memcmp(magic, csr_compressed_magic, sizeof(magic)) != 0)
+        {
+            LOG_INFO("ReadFileRSIO: invalid compressed matrix header");
+            return false;
+        }
+
+        if(version != csr_compressed_version)
         {
-            LOG_INFO("ReadFileCSR: invalid rocALUTION matrix header");
+            LOG_INFO("ReadFileRSIO: unsupported compressed matrix version " << version);
             return false;
         }
 
-        // rocALUTION version
-        int version;
-        in.read((char*)&version, sizeof(int));
-
-        // Read sizes
+        if(nrow < 0 || ncol < 0 || nnz < 0 || nchunk < 0 || nchunk > nrow)
+        {
+            LOG_INFO("ReadFileRSIO: invalid matrix data");
+            return false;
+        }
 
-        // We need backward compatibility
-        if(version < 30000)
+        if(nnz > std::numeric_limits<PointerType>::max()
+           || nrow > std::numeric_limits<IndexType>::max()
+           || ncol > std::numeric_limits<IndexType>::max())
         {
-            // 32 bit backward compatibility sizes
-            int nrow32;
-            int ncol32;
-            int nnz32;
+            LOG_INFO("ReadFileRSIO: matrix sizes exceed the index type limits");
+            return false;
+        }
 
-            // Read sizes
-            in.read((char*)&nrow32, sizeof(int));
-            in.read((char*)&ncol32, sizeof(int));
-            in.read((char*)&nnz32, sizeof(int));
+        // Complex values cannot be read into a real matrix
+        rocsparseio_type type = type2rocsparseio_type<ValueType>();
+        bool             cplx = (type == rocsparseio_type_complex32)
+                    || (type == rocsparseio_type_complex64);
 
-            // Convert to 64 bit
-            nrow = static_cast<int64_t>(nrow32);
-            ncol = static_cast<int64_t>(ncol32);
-            nnz  = static_cast<int64_t>(nnz32);
+        bool value_type = (val_type == rocsparseio_type_float32)
+                          || (val_type == rocsparseio_type_float64)
+                          || (cplx == true && val_type == rocsparseio_type_complex32)
+                          || (cplx == true && val_type == rocsparseio_type_complex64);
 
-            // Always read 32 bit row pointers
-            int* ptr32 = NULL;
+        if(value_type == false)
+        {
+            LOG_INFO("ReadFileRSIO: unsupported value type");
+            return false;
+        }
 
-            // Allocate for row pointers
-            allocate_host(nrow32 + 1, &ptr32);
-            allocate_host(nrow + 1, ptr);
+        uint64_t val_size;
+        rocsparseio_type_get_size(static_cast<rocsparseio_type>(val_type), &val_size);
 
-            // Read row pointers in 32bit
-            in.read((char*)ptr32, (nrow32 + 1) * sizeof(int));
+        // Chunk table and offsets
+        std::vector<uint64_t> table(4 * nchunk);
+        in.read((char*)table.data(), table.size() * sizeof(uint64_t));
 
-            // Convert to actual precision
-            for(int i = 0; i < nrow32 + 1; ++i)
-            {
-                (*ptr)[i] = ptr32[i];
-            }
+        std::vector<int64_t> row_offset(nchunk + 1, 0);
+        std::vector<int64_t> nnz_offset(nchunk + 1, 0);
+        std::vector<int64_t> byte_offset(nchunk + 1, 0);
 
-            free_host(&ptr32);
+        for(int64_t c = 0; c < nchunk; ++c)
+        {
+            row_offset[c + 1]  = row_offset[c] + table[4 * c + 0];
+            nnz_offset[c + 1]  = nnz_offset[c] + table[4 * c + 1];
+            byte_offset[c + 1] = byte_offset[c] + table[4 * c + 2];
         }
-        else
+
+        if(!in || row_offset[nchunk] != nrow || nnz_offset[nchunk] != nnz)
         {
-            // Read sizes
-            in.read((char*)&nrow, sizeof(int64_t));
-            in.read((char*)&ncol, sizeof(int64_t));
-            in.read((char*)&nnz, sizeof(int64_t));
+            LOG_INFO("ReadFileRSIO: invalid matrix data");
+            return false;
+        }
 
-            // Allocate row pointer array
-            allocate_host(nrow + 1, ptr);
+        std::vector<unsigned char> data(byte_offset[nchunk]);
+        in.read((char*)data.data(), data.size());
 
-            // Read data - precision is determined by nnz
-            if(nnz < std::numeric_limits<int>::max())
-            {
-                read_csr_row_ptr_32(in, nrow, *ptr);
-            }
-            else
-            {
-                read_csr_row_ptr_64(in, nrow, *ptr);
-            }
+        if(!in)
+        {
+            LOG_INFO("ReadFileRSIO: invalid matrix data");
+            return false;
         }
 
-        //        if(version != __ROCALUTION_VER)
-        //        {
-        //            LOG_INFO("ReadFileCSR: file version mismatch");
-        //            return false;
-        //        }
+        in.close();
 
-        // Allocate arrays
+        allocate_host(nrow + 1, ptr);
         allocate_host(nnz, col);
         allocate_host(nnz, val);
 
-        // Read in columns and values
-        in.read((char*)*col, nnz * sizeof(int));
-        read_csr_values(in, nnz, *val);
+        (*ptr)[0] = 0;
 
-        // Check ifstream status
-        if(!in)
+        // Decode the chunks
+        std::vector<char> valid(nchunk, 1);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for(int64_t c = 0; c < nchunk; ++c)
         {
-            LOG_INFO("ReadFileCSR: invalid matrix data");
-            return false;
-        }
+            const unsigned char* begin = data.data() + byte_offset[c];
+            const unsigned char* end   = data.data() + byte_offset[c + 1];
+            const unsigned char* p     = begin;
 
-        in.close();
+            int64_t chunk_nnz = nnz_offset[c + 1] - nnz_offset[c];
+            int64_t row_nnz   = nnz_offset[c];
 
-        return true;
-    }
+            for(int64_t i = row_offset[c]; i < row_offset[c + 1]; ++i)
+            {
+                uint64_t len;
 
-    template <typename T>
-    rocsparseio_type type2rocsparseio_type();
+                if(varint_get(p, end, len) == false || len > static_cast<uint64_t>(chunk_nnz))
+                {
+                    valid[c] = 0;
+                    break;
+                }
 
-    template <>
-    rocsparseio_type type2rocsparseio_type<std::complex<float>>()
-    {
-        return rocsparseio_type_complex32;
-    }
+                row_nnz += len;
+                (*ptr)[i + 1] = static_cast<PointerType>(row_nnz);
+            }
 
-    template <>
-    rocsparseio_type type2rocsparseio_type<std::complex<double>>()
-    {
-        return rocsparseio_type_complex64;
-    }
+            if(valid[c] == 0 || row_nnz != nnz_offset[c + 1])
+            {
+                valid[c] = 0;
+                continue;
+            }
 
-    template <>
-    rocsparseio_type type2rocsparseio_type<float>()
-    {
-        return rocsparseio_type_float32;
-    }
+            for(int64_t i = row_offset[c]; i < row_offset[c + 1] && valid[c] == 1; ++i)
+            {
+                int64_t prev = i;
 
-    template <>
-    rocsparseio_type type2rocsparseio_type<double>()
-    {
-        return rocsparseio_type_float64;
-    }
+                for(PointerType j = (*ptr)[i]; j < (*ptr)[i + 1]; ++j)
+                {
+                    uint64_t delta;
 
-    template <>
-    rocsparseio_type type2rocsparseio_type<int32_t>()
-    {
-        return rocsparseio_type_int32;
-    }
+                    if(varint_get(p, end, delta) == false)
+                    {
+                        valid[c] = 0;
+                        break;
+                    }
 
-    template <>
-    rocsparseio_type type2rocsparseio_type<int8_t>()
-    {
-        return rocsparseio_type_int8;
-    }
+                    prev = prev + zigzag_decode(delta);
 
-    template <>
-    rocsparseio_type type2rocsparseio_type<int64_t>()
-    {
-        return rocsparseio_type_int64;
-    }
+                    if(prev < 0 || prev >= ncol)
+                    {
+                        valid[c] = 0;
+                        break;
+                    }
 
-    template <typename X, typename Y>
-    inline void copy_mixed_arrays(size_t size, X* __restrict__ x, const Y* __restrict__ y)
-    {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(size_t i = 0; i < size; ++i)
-        {
-            x[i] = static_cast<X>(y[i]);
-        }
-    }
+                    (*col)[j] = static_cast<IndexType>(prev);
+                }
+            }
 
-    template <>
-    inline void copy_mixed_arrays(size_t size,
-                                  std::complex<float>* __restrict__ x,
-                                  const std::complex<double>* __restrict__ y)
-    {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(size_t i = 0; i < size; ++i)
-        {
-            x[i] = std::complex<float>(static_cast<float>(std::real(y[i])),
-                                       static_cast<float>(std::imag(y[i])));
-        }
-    }
+            if(valid[c] == 0)
+            {
+                continue;
+            }
 
-    template <>
-    inline void copy_mixed_arrays(size_t size,
-                                  std::complex<double>* __restrict__ x,
-                                  const std::complex<float>* __restrict__ y)
-    {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(size_t i = 0; i < size; ++i)
-        {
-            x[i] = std::complex<double>(static_cast<double>(std::real(y[i])),
-                                        static_cast<double>(std::imag(y[i])));
-        }
-    }
+            if(table[4 * c + 3] == csr_codec_xor)
+            {
+                std::vector<char> raw(chunk_nnz * val_size);
 
-    template <>
-    inline void copy_mixed_arrays(size_t size,
-                                  int8_t* __restrict__ x,
-                                  const std::complex<float>* __restrict__ y)
-    {
-        throw 1;
-    }
+                if(decode_values_xor(p, end, chunk_nnz, static_cast<int>(val_type), raw.data())
+                   == false)
+                {
+                    valid[c] = 0;
+                    continue;
+                }
 
-    template <>
-    inline void copy_mixed_arrays(size_t size,
-                                  int8_t* __restrict__ x,
-                                  const std::complex<double>* __restrict__ y)
-    {
-        throw 1;
-    }
+                convert_csr_file_values(
+                    chunk_nnz, static_cast<int>(val_type), raw.data(), *val + nnz_offset[c]);
+            }
+            else
+            {
+                // Raw values start aligned
+                int64_t pos = (p - begin + csr_compressed_align - 1) / csr_compressed_align
+                              * csr_compressed_align;
 
-    template <>
-    inline void copy_mixed_arrays(size_t size,
-                                  float* __restrict__ x,
-                                  const std::complex<float>* __restrict__ y)
-    {
-        throw 1;
-    }
+                if(table[4 * c + 3] != csr_codec_raw
+                   || pos + chunk_nnz * static_cast<int64_t>(val_size) > end - begin)
+                {
+                    valid[c] = 0;
+                    continue;
+                }
 
-    template <>
-    inline void copy_mixed_arrays(size_t size,
-                                  float* __restrict__ x,
-                                  const std::complex<double>* __restrict__ y)
-    {
-        throw 1;
-    }
+                convert_csr_file_values(chunk_nnz,
+                                        static_cast<int>(val_type),
+                                        reinterpret_cast<const char*>(begin + pos),
+                                        *val + nnz_offset[c]);
+            }
+        }
 
-    template <>
-    inline void copy_mixed_arrays(size_t size,
-                                  double* __restrict__ x,
-                                  const std::complex<float>* __restrict__ y)
-    {
-        throw 1;
-    }
+        if(std::find(valid.begin(), valid.end(), 0) != valid.end())
+        {
+            LOG_INFO("ReadFileRSIO: invalid compressed matrix data");
 
-    template <>
-    inline void copy_mixed_arrays(size_t size,
-                                  double* __restrict__ x,
-                                  const std::complex<double>* __restrict__ y)
-    {
-        throw 1;
+            free_host(ptr);
+            free_host(col);
+            free_host(val);
+
+            return false;
+        }
+
+        return true;
     }
 
     template <typename ValueType, typename IndexType, typename PointerType>
@@ -3673,6 +5320,68 @@ namespace rocalution
                                   const char*            filename);
 #endif
 
+    template bool read_matrix_mtx_csr(int&        nrow,
+                                      int&        ncol,
+                                      int64_t&    nnz,
+                                      int**       ptr,
+                                      int**       col,
+                                      float**     val,
+                                      const char* filename);
+    template bool read_matrix_mtx_csr(int&        nrow,
+                                      int&        ncol,
+                                      int64_t&    nnz,
+                                      int**       ptr,
+                                      int**       col,
+                                      double**    val,
+                                      const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_mtx_csr(int&                  nrow,
+                                      int&                  ncol,
+                                      int64_t&              nnz,
+                                      int**                 ptr,
+                                      int**                 col,
+                                      std::complex<float>** val,
+                                      const char*           filename);
+    template bool read_matrix_mtx_csr(int&                   nrow,
+                                      int&                   ncol,
+                                      int64_t&               nnz,
+                                      int**                  ptr,
+                                      int**                  col,
+                                      std::complex<double>** val,
+                                      const char*            filename);
+#endif
+
+    template bool read_matrix_mtx_csr(int&        nrow,
+                                      int&        ncol,
+                                      int64_t&    nnz,
+                                      int64_t**   ptr,
+                                      int**       col,
+                                      float**     val,
+                                      const char* filename);
+    template bool read_matrix_mtx_csr(int&        nrow,
+                                      int&        ncol,
+                                      int64_t&    nnz,
+                                      int64_t**   ptr,
+                                      int**       col,
+                                      double**    val,
+                                      const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_mtx_csr(int&                  nrow,
+                                      int&                  ncol,
+                                      int64_t&              nnz,
+                                      int64_t**             ptr,
+                                      int**                 col,
+                                      std::complex<float>** val,
+                                      const char*           filename);
+    template bool read_matrix_mtx_csr(int&                   nrow,
+                                      int&                   ncol,
+                                      int64_t&               nnz,
+                                      int64_t**              ptr,
+                                      int**                  col,
+                                      std::complex<double>** val,
+                                      const char*            filename);
+#endif
+
     template bool write_matrix_mtx(int          nrow,
                                    int          ncol,
                                    int64_t      nnz,
@@ -3766,6 +5475,31 @@ namespace rocalution
                                   const char*            filename);
 #endif
 
+    template bool read_matrix_csr_blocks(CSRBlockReceiver<float, int, int>& recv,
+                                         const char*                        filename);
+    template bool read_matrix_csr_blocks(CSRBlockReceiver<double, int, int>& recv,
+                                         const char*                         filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_csr_blocks(CSRBlockReceiver<std::complex<float>, int, int>& recv,
+                                         const char*                                      filename);
+    template bool
+        read_matrix_csr_blocks(CSRBlockReceiver<std::complex<double>, int, int>& recv,
+                               const char*                                       filename);
+#endif
+
+    template bool read_matrix_csr_blocks(CSRBlockReceiver<float, int, int64_t>& recv,
+                                         const char*                            filename);
+    template bool read_matrix_csr_blocks(CSRBlockReceiver<double, int, int64_t>& recv,
+                                         const char*                             filename);
+#ifdef SUPPORT_COMPLEX
+    template bool
+        read_matrix_csr_blocks(CSRBlockReceiver<std::complex<float>, int, int64_t>& recv,
+                               const char*                                          filename);
+    template bool
+        read_matrix_csr_blocks(CSRBlockReceiver<std::complex<double>, int, int64_t>& recv,
+                               const char*                                           filename);
+#endif
+
     template bool write_matrix_csr(int64_t      nrow,
                                    int64_t      ncol,
                                    int64_t      nnz,
@@ -4526,4 +6260,215 @@ namespace rocalution
                                                  const char*                 filename);
 #endif
 
+    template bool read_matrix_csr_compressed(int64_t&    nrow,
+                                             int64_t&    ncol,
+                                             int64_t&    nnz,
+                                             int**       ptr,
+                                             int**       col,
+                                             float**     val,
+                                             const char* filename);
+    template bool read_matrix_csr_compressed(int64_t&    nrow,
+                                             int64_t&    ncol,
+                                             int64_t&    nnz,
+                                             int**       ptr,
+                                             int**       col,
+                                             double**    val,
+                                             const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_csr_compressed(int64_t&              nrow,
+                                             int64_t&              ncol,
+                                             int64_t&              nnz,
+                                             int**                 ptr,
+                                             int**                 col,
+                                             std::complex<float>** val,
+                                             const char*           filename);
+    template bool read_matrix_csr_compressed(int64_t&               nrow,
+                                             int64_t&               ncol,
+                                             int64_t&               nnz,
+                                             int**                  ptr,
+                                             int**                  col,
+                                             std::complex<double>** val,
+                                             const char*            filename);
+#endif
+
+    template bool read_matrix_csr_compressed(int64_t&    nrow,
+                                             int64_t&    ncol,
+                                             int64_t&    nnz,
+                                             int64_t**   ptr,
+                                             int**       col,
+                                             float**     val,
+                                             const char* filename);
+    template bool read_matrix_csr_compressed(int64_t&    nrow,
+                                             int64_t&    ncol,
+                                             int64_t&    nnz,
+                                             int64_t**   ptr,
+                                             int**       col,
+                                             double**    val,
+                                             const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_csr_compressed(int64_t&              nrow,
+                                             int64_t&              ncol,
+                                             int64_t&              nnz,
+                                             int64_t**             ptr,
+                                             int**                 col,
+                                             std::complex<float>** val,
+                                             const char*           filename);
+    template bool read_matrix_csr_compressed(int64_t&               nrow,
+                                             int64_t&               ncol,
+                                             int64_t&               nnz,
+                                             int64_t**              ptr,
+                                             int**                  col,
+                                             std::complex<double>** val,
+                                             const char*            filename);
+#endif
+
+    template bool write_matrix_csr_compressed(int64_t      nrow,
+                                              int64_t      ncol,
+                                              int64_t      nnz,
+                                              const int*   ptr,
+                                              const int*   col,
+                                              const float* val,
+                                              const char*  filename);
+    template bool write_matrix_csr_compressed(int64_t       nrow,
+                                              int64_t       ncol,
+                                              int64_t       nnz,
+                                              const int*    ptr,
+                                              const int*    col,
+                                              const double* val,
+                                              const char*   filename);
+#ifdef SUPPORT_COMPLEX
+    template bool write_matrix_csr_compressed(int64_t                    nrow,
+                                              int64_t                    ncol,
+                                              int64_t                    nnz,
+                                              const int*                 ptr,
+                                              const int*                 col,
+                                              const std::complex<float>* val,
+                                              const char*                filename);
+    template bool write_matrix_csr_compressed(int64_t                     nrow,
+                                              int64_t                     ncol,
+                                              int64_t                     nnz,
+                                              const int*                  ptr,
+                                              const int*                  col,
+                                              const std::complex<double>* val,
+                                              const char*                 filename);
+#endif
+
+    template bool write_matrix_csr_compressed(int64_t        nrow,
+                                              int64_t        ncol,
+                                              int64_t        nnz,
+                                              const int64_t* ptr,
+                                              const int*     col,
+                                              const float*   val,
+                                              const char*    filename);
+    template bool write_matrix_csr_compressed(int64_t        nrow,
+                                              int64_t        ncol,
+                                              int64_t        nnz,
+                                              const int64_t* ptr,
+                                              const int*     col,
+                                              const double*  val,
+                                              const char*    filename);
+#ifdef SUPPORT_COMPLEX
+    template bool write_matrix_csr_compressed(int64_t                    nrow,
+                                              int64_t                    ncol,
+                                              int64_t                    nnz,
+                                              const int64_t*             ptr,
+                                              const int*                 col,
+                                              const std::complex<float>* val,
+                                              const char*                filename);
+    template bool write_matrix_csr_compressed(int64_t                     nrow,
+                                              int64_t                     ncol,
+                                              int64_t                     nnz,
+                                              const int64_t*              ptr,
+                                              const int*                  col,
+                                              const std::complex<double>* val,
+                                              const char*                 filename);
+#endif
+
+    template bool read_matrix_csr_layout<float>(CSRFileLayout& layout, const char* filename);
+    template bool read_matrix_csr_layout<double>(CSRFileLayout& layout, const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_csr_layout<std::complex<float>>(CSRFileLayout& layout,
+                                                              const char*    filename);
+    template bool read_matrix_csr_layout<std::complex<double>>(CSRFileLayout& layout,
+                                                               const char*    filename);
+#endif
+
+    template bool read_matrix_csr_rocsparseio_layout<float>(CSRFileLayout& layout,
+                                                            const char*    filename);
+    template bool read_matrix_csr_rocsparseio_layout<double>(CSRFileLayout& layout,
+                                                             const char*    filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_matrix_csr_rocsparseio_layout<std::complex<float>>(CSRFileLayout& layout,
+                                                                          const char* filename);
+    template bool read_matrix_csr_rocsparseio_layout<std::complex<double>>(CSRFileLayout& layout,
+                                                                           const char* filename);
+#endif
+
+    template void convert_csr_file_values(int64_t n, int type, const char* raw, float* val);
+    template void convert_csr_file_values(int64_t n, int type, const char* raw, double* val);
+#ifdef SUPPORT_COMPLEX
+    template void convert_csr_file_values(int64_t              n,
+                                          int                  type,
+                                          const char*          raw,
+                                          std::complex<float>* val);
+    template void convert_csr_file_values(int64_t               n,
+                                          int                   type,
+                                          const char*           raw,
+                                          std::complex<double>* val);
+#endif
+
+    template void write_matrix_csr_layout<float>(
+        int64_t nrow, int64_t ncol, int64_t nnz, CSRFileLayout& layout, std::string& header);
+    template void write_matrix_csr_layout<double>(
+        int64_t nrow, int64_t ncol, int64_t nnz, CSRFileLayout& layout, std::string& header);
+#ifdef SUPPORT_COMPLEX
+    template void write_matrix_csr_layout<std::complex<float>>(
+        int64_t nrow, int64_t ncol, int64_t nnz, CSRFileLayout& layout, std::string& header);
+    template void write_matrix_csr_layout<std::complex<double>>(
+        int64_t nrow, int64_t ncol, int64_t nnz, CSRFileLayout& layout, std::string& header);
+#endif
+
+    template bool read_vector_layout<float>(
+        int64_t& size, int64_t& offset, int& val_type, int& val_size, const char* filename);
+    template bool read_vector_layout<double>(
+        int64_t& size, int64_t& offset, int& val_type, int& val_size, const char* filename);
+#ifdef SUPPORT_COMPLEX
+    template bool read_vector_layout<std::complex<float>>(
+        int64_t& size, int64_t& offset, int& val_type, int& val_size, const char* filename);
+    template bool read_vector_layout<std::complex<double>>(
+        int64_t& size, int64_t& offset, int& val_type, int& val_size, const char* filename);
+#endif
+
+    template void write_vector_layout<float>(int64_t      size,
+                                             int&         val_type,
+                                             int&         val_size,
+                                             std::string& header);
+    template void write_vector_layout<double>(int64_t      size,
+                                              int&         val_type,
+                                              int&         val_size,
+                                              std::string& header);
+#ifdef SUPPORT_COMPLEX
+    template void write_vector_layout<std::complex<float>>(int64_t      size,
+                                                           int&         val_type,
+                                                           int&         val_size,
+                                                           std::string& header);
+    template void write_vector_layout<std::complex<double>>(int64_t      size,
+                                                            int&         val_type,
+                                                            int&         val_size,
+                                                            std::string& header);
+#endif
+
+    template void convert_csr_file_values_raw(int64_t n, int type, const float* val, char* raw);
+    template void convert_csr_file_values_raw(int64_t n, int type, const double* val, char* raw);
+#ifdef SUPPORT_COMPLEX
+    template void convert_csr_file_values_raw(int64_t                    n,
+                                              int                        type,
+                                              const std::complex<float>* val,
+                                              char*                      raw);
+    template void convert_csr_file_values_raw(int64_t                     n,
+                                              int                         type,
+                                              const std::complex<double>* val,
+                                              char*                       raw);
+#endif
+
 } // namespace rocalution
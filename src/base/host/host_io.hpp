@@ -38,6 +38,15 @@ namespace rocalution
                          ValueType** val,
                          const char* filename);
 
+    template <typename ValueType, typename PointerType>
+    bool read_matrix_mtx_csr(int&          nrow,
+                             int&          ncol,
+                             int64_t&      nnz,
+                             PointerType** ptr,
+                             int**         col,
+                             ValueType**   val,
+                             const char*   filename);
+
     template <typename ValueType>
     bool write_matrix_mtx(int              nrow,
                           int              ncol,
@@ -56,6 +65,100 @@ namespace rocalution
                          ValueType**   val,
                          const char*   filename);
 
+    // Destination of read_matrix_csr_blocks(). The reader requests a buffer for each block
+    // of the row offsets, column and value arrays, fills it and calls Commit(). A block
+    // buffer may be the final location of the data or a staging buffer.
+    template <typename ValueType, typename IndexType, typename PointerType>
+    class CSRBlockReceiver
+    {
+    public:
+        virtual ~CSRBlockReceiver() {}
+
+        // Called once with the matrix sizes, before any block is requested
+        virtual bool Allocate(int64_t nrow, int64_t ncol, int64_t nnz) = 0;
+
+        // Return a buffer for entries [offset, offset + n) of the respective array
+        virtual PointerType* RowOffsetBlock(int64_t offset, int64_t n) = 0;
+        virtual IndexType*   ColumnBlock(int64_t offset, int64_t n)    = 0;
+        virtual ValueType*   ValueBlock(int64_t offset, int64_t n)     = 0;
+
+        // The last requested block has been filled
+        virtual void Commit(void) = 0;
+    };
+
+    // Read a rocALUTION binary CSR file in blocks of csr_block_size bytes, without holding
+    // the complete file in host memory
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool read_matrix_csr_blocks(CSRBlockReceiver<ValueType, IndexType, PointerType>& recv,
+                                const char*                                          filename);
+
+    // Size of the blocks of read_matrix_csr_blocks() in bytes
+    static const int64_t csr_block_size = 32 * 1024 * 1024;
+
+    // Position of the CSR arrays inside a rocALUTION binary or rocsparseio file. Entry i of
+    // an array starts at byte offset + i * size, types are rocsparseio type ids. This allows
+    // to read a range of rows without reading the complete file.
+    struct CSRFileLayout
+    {
+        int64_t nrow;
+        int64_t ncol;
+        int64_t nnz;
+
+        // Index base of row offsets and column indices
+        int base;
+
+        int64_t ptr_offset;
+        int64_t col_offset;
+        int64_t val_offset;
+
+        int ptr_size;
+        int col_size;
+        int val_size;
+
+        int ptr_type;
+        int col_type;
+        int val_type;
+    };
+
+    // Obtain the layout of a rocALUTION binary CSR file, that is read into ValueType
+    template <typename ValueType>
+    bool read_matrix_csr_layout(CSRFileLayout& layout, const char* filename);
+
+    // Obtain the layout of a rocsparseio CSR file, that is read into ValueType
+    template <typename ValueType>
+    bool read_matrix_csr_rocsparseio_layout(CSRFileLayout& layout, const char* filename);
+
+    // Convert n raw file entries of type ptr_type or col_type into indices
+    void convert_csr_file_indices(int64_t n, int type, const char* raw, int64_t* idx);
+
+    // Convert n raw file entries of type val_type into values
+    template <typename ValueType>
+    void convert_csr_file_values(int64_t n, int type, const char* raw, ValueType* val);
+
+    // Obtain the header and the layout of a rocALUTION binary CSR file of the given sizes,
+    // that is written from ValueType. The arrays follow directly after the header.
+    template <typename ValueType>
+    void write_matrix_csr_layout(
+        int64_t nrow, int64_t ncol, int64_t nnz, CSRFileLayout& layout, std::string& header);
+
+    // Obtain size and data offset of a rocALUTION binary vector file, that is read into
+    // ValueType. The values are stored as file entries of type val_type and val_size bytes.
+    template <typename ValueType>
+    bool read_vector_layout(
+        int64_t& size, int64_t& offset, int& val_type, int& val_size, const char* filename);
+
+    // Obtain the header of a rocALUTION binary vector file of the given size, that is
+    // written from ValueType. The values follow directly after the header.
+    template <typename ValueType>
+    void write_vector_layout(int64_t size, int& val_type, int& val_size, std::string& header);
+
+    // Convert n indices into raw file entries of type ptr_type or col_type
+    void convert_csr_file_indices_raw(int64_t n, int type, const int64_t* idx, char* raw);
+
+    // Convert n values into raw file entries of type val_type
+    template <typename ValueType>
+    void convert_csr_file_values_raw(int64_t n, int type, const ValueType* val, char* raw);
+
     template <typename ValueType, typename IndexType, typename PointerType>
     bool write_matrix_csr(int64_t            nrow,
                           int64_t            ncol,
@@ -83,6 +186,29 @@ namespace rocalution
                                       const ValueType*   val,
                                       const char*        filename);
 
+    // Return true if the file holds a compressed CSR matrix
+    bool is_matrix_csr_compressed(const char* filename);
+
+    // Compressed CSR files store the row lengths and column deltas as varints and the values
+    // XOR encoded, the rows are split into chunks that are encoded and decoded in parallel
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool read_matrix_csr_compressed(int64_t&      nrow,
+                                    int64_t&      ncol,
+                                    int64_t&      nnz,
+                                    PointerType** ptr,
+                                    IndexType**   col,
+                                    ValueType**   val,
+                                    const char*   filename);
+
+    template <typename ValueType, typename IndexType, typename PointerType>
+    bool write_matrix_csr_compressed(int64_t            nrow,
+                                     int64_t            ncol,
+                                     int64_t            nnz,
+                                     const PointerType* ptr,
+                                     const IndexType*   col,
+                                     const ValueType*   val,
+                                     const char*        filename);
+
     template <typename ValueType, typename IndexType, typename PointerType>
     bool read_matrix_mcsr_rocsparseio(int64_t&      nrow,
                                       int64_t&      ncol,
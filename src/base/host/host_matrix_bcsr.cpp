@@ -43,6 +43,130 @@
 namespace rocalution
 {
 
+    // BCSR SpMV out = A * in (or out += scalar * A * in, if ADD) with the block dimension
+    // known at compile time. The block row sums are kept in registers, such that the block
+    // loops are unrolled and, for column-major blocks, vectorized over the block rows.
+    template <int BLOCKDIM, bool ADD, typename ValueType>
+    static void host_bcsr_spmv_kernel(int              nrowb,
+                                      const int*       row_offset,
+                                      const int*       col,
+                                      const ValueType* val,
+                                      const ValueType* in,
+                                      ValueType        scalar,
+                                      ValueType*       out)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < nrowb; ++ai)
+        {
+            ValueType sum[BLOCKDIM];
+
+            for(int bi = 0; bi < BLOCKDIM; ++bi)
+            {
+                sum[bi] = static_cast<ValueType>(0);
+            }
+
+            for(int aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+            {
+                const ValueType* x = in + static_cast<int64_t>(col[aj]) * BLOCKDIM;
+
+                for(int bj = 0; bj < BLOCKDIM; ++bj)
+                {
+                    for(int bi = 0; bi < BLOCKDIM; ++bi)
+                    {
+                        sum[bi] += val[BCSR_IND(static_cast<int64_t>(aj), bi, bj, BLOCKDIM)]
+                                   * x[bj];
+                    }
+                }
+            }
+
+            for(int bi = 0; bi < BLOCKDIM; ++bi)
+            {
+                if(ADD == true)
+                {
+                    out[ai * BLOCKDIM + bi] += scalar * sum[bi];
+                }
+                else
+                {
+                    out[ai * BLOCKDIM + bi] = sum[bi];
+                }
+            }
+        }
+    }
+
+    // BCSR SpMV for block dimensions without a specialized kernel
+    template <bool ADD, typename ValueType>
+    static void host_bcsr_spmv_generic(int              nrowb,
+                                       int              bsrdim,
+                                       const int*       row_offset,
+                                       const int*       col,
+                                       const ValueType* val,
+                                       const ValueType* in,
+                                       ValueType        scalar,
+                                       ValueType*       out)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < nrowb; ++ai)
+        {
+            for(int bi = 0; bi < bsrdim; ++bi)
+            {
+                ValueType sum = static_cast<ValueType>(0);
+
+                for(int aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+                {
+                    for(int bj = 0; bj < bsrdim; ++bj)
+                    {
+                        sum += val[BCSR_IND(aj, bi, bj, bsrdim)] * in[bsrdim * col[aj] + bj];
+                    }
+                }
+
+                if(ADD == true)
+                {
+                    out[ai * bsrdim + bi] += scalar * sum;
+                }
+                else
+                {
+                    out[ai * bsrdim + bi] = sum;
+                }
+            }
+        }
+    }
+
+    // Dispatch the BCSR SpMV to the kernel of the block dimension
+    template <bool ADD, typename ValueType>
+    static void host_bcsr_spmv(const MatrixBCSR<ValueType, int>& mat,
+                               const ValueType*                  in,
+                               ValueType                         scalar,
+                               ValueType*                        out)
+    {
+        switch(mat.blockdim)
+        {
+#define HOST_BCSR_SPMV_CASE(dim)                                                              \
+    case dim:                                                                                 \
+        host_bcsr_spmv_kernel<dim, ADD>(                                                      \
+            mat.nrowb, mat.row_offset, mat.col, mat.val, in, scalar, out);                    \
+        break;
+
+            HOST_BCSR_SPMV_CASE(2)
+            HOST_BCSR_SPMV_CASE(3)
+            HOST_BCSR_SPMV_CASE(4)
+            HOST_BCSR_SPMV_CASE(5)
+            HOST_BCSR_SPMV_CASE(6)
+            HOST_BCSR_SPMV_CASE(7)
+            HOST_BCSR_SPMV_CASE(8)
+
+#undef HOST_BCSR_SPMV_CASE
+
+        default:
+            host_bcsr_spmv_generic<ADD>(
+                mat.nrowb, mat.blockdim, mat.row_offset, mat.col, mat.val, in, scalar, out);
+            break;
+        }
+    }
+
     template <typename ValueType>
     HostMatrixBCSR<ValueType>::HostMatrixBCSR()
     {
@@ -345,34 +469,8 @@ namespace rocalution
 
             _set_omp_backend_threads(this->local_backend_, this->mat_.nrowb);
 
-            int bsrdim = this->mat_.blockdim;
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int ai = 0; ai < this->mat_.nrowb; ++ai)
-            {
-                for(int bi = 0; bi < bsrdim; ++bi)
-                {
-                    int row_begin = this->mat_.row_offset[ai];
-                    int row_end   = this->mat_.row_offset[ai + 1];
-
-                    ValueType sum = static_cast<ValueType>(0);
-
-                    for(int aj = row_begin; aj < row_end; ++aj)
-                    {
-                        int col = this->mat_.col[aj];
-
-                        for(int bj = 0; bj < bsrdim; ++bj)
-                        {
-                            sum += this->mat_.val[BCSR_IND(aj, bi, bj, bsrdim)]
-                                   * cast_in->vec_[bsrdim * col + bj];
-                        }
-                    }
-
-                    cast_out->vec_[ai * bsrdim + bi] = sum;
-                }
-            }
+            host_bcsr_spmv<false>(
+                this->mat_, cast_in->vec_, static_cast<ValueType>(1), cast_out->vec_);
         }
     }
 
@@ -398,34 +496,104 @@ namespace rocalution
 
             assert(this->nrow_ == this->ncol_);
 
-            int bsrdim = this->mat_.blockdim;
+            host_bcsr_spmv<true>(this->mat_, cast_in->vec_, scalar, cast_out->vec_);
+        }
+    }
+
+    template <typename ValueType>
+    bool HostMatrixBCSR<ValueType>::ExtractDiagonal(BaseVector<ValueType>* vec_diag) const
+    {
+        assert(vec_diag != NULL);
+        assert(vec_diag->GetSize() == this->nrow_);
+
+        HostVector<ValueType>* cast_vec_diag = dynamic_cast<HostVector<ValueType>*>(vec_diag);
+
+        assert(cast_vec_diag != NULL);
+
+        _set_omp_backend_threads(this->local_backend_, this->mat_.nrowb);
+
+        int bsrdim = this->mat_.blockdim;
+
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int ai = 0; ai < this->mat_.nrowb; ++ai)
+        for(int ai = 0; ai < this->mat_.nrowb; ++ai)
+        {
+            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                for(int bi = 0; bi < bsrdim; ++bi)
+                if(ai == this->mat_.col[aj])
                 {
-                    int row_begin = this->mat_.row_offset[ai];
-                    int row_end   = this->mat_.row_offset[ai + 1];
+                    for(int bi = 0; bi < bsrdim; ++bi)
+                    {
+                        cast_vec_diag->vec_[ai * bsrdim + bi]
+                            = this->mat_.val[BCSR_IND(aj, bi, bi, bsrdim)];
+                    }
 
-                    ValueType sum = static_cast<ValueType>(0);
+                    break;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixBCSR<ValueType>::ExtractInverseDiagonal(
+        BaseVector<ValueType>* vec_inv_diag) const
+    {
+        assert(vec_inv_diag != NULL);
+        assert(vec_inv_diag->GetSize() == this->nrow_);
+
+        HostVector<ValueType>* cast_vec_inv_diag
+            = dynamic_cast<HostVector<ValueType>*>(vec_inv_diag);
+
+        assert(cast_vec_inv_diag != NULL);
+
+        int detect_zero_diag = 0;
+
+        _set_omp_backend_threads(this->local_backend_, this->mat_.nrowb);
+
+        int bsrdim = this->mat_.blockdim;
 
-                    for(int aj = row_begin; aj < row_end; ++aj)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->mat_.nrowb; ++ai)
+        {
+            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai == this->mat_.col[aj])
+                {
+                    for(int bi = 0; bi < bsrdim; ++bi)
                     {
-                        int col = this->mat_.col[aj];
+                        ValueType val = this->mat_.val[BCSR_IND(aj, bi, bi, bsrdim)];
 
-                        for(int bj = 0; bj < bsrdim; ++bj)
+                        if(val != static_cast<ValueType>(0))
                         {
-                            sum += this->mat_.val[BCSR_IND(aj, bi, bj, bsrdim)]
-                                   * cast_in->vec_[bsrdim * col + bj];
+                            cast_vec_inv_diag->vec_[ai * bsrdim + bi]
+                                = static_cast<ValueType>(1) / val;
+                        }
+                        else
+                        {
+                            cast_vec_inv_diag->vec_[ai * bsrdim + bi] = static_cast<ValueType>(1);
+                            detect_zero_diag                          = 1;
                         }
                     }
 
-                    cast_out->vec_[ai * bsrdim + bi] += scalar * sum;
+                    break;
                 }
             }
         }
+
+        if(detect_zero_diag == 1)
+        {
+            LOG_VERBOSE_INFO(
+                2,
+                "*** warning: in HostMatrixBCSR::ExtractInverseDiagonal() a zero has been detected "
+                "on the diagonal. It has been replaced with one to avoid inf");
+        }
+
+        return true;
     }
 
     template class HostMatrixBCSR<double>;
@@ -69,6 +69,9 @@ namespace rocalution
         virtual bool ReadFileRSIO(const std::string& filename);
         virtual bool WriteFileRSIO(const std::string& filename) const;
 
+        virtual bool ExtractDiagonal(BaseVector<ValueType>* vec_diag) const;
+        virtual bool ExtractInverseDiagonal(BaseVector<ValueType>* vec_inv_diag) const;
+
         virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
         virtual void ApplyAdd(const BaseVector<ValueType>& in,
                               ValueType                    scalar,
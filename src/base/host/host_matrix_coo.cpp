@@ -40,6 +40,7 @@
 #include <complex>
 #include <cstdio>
 #include <numeric>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -403,20 +404,84 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    bool HostMatrixCOO<ValueType>::Sort(void)
+    bool HostMatrixCOO<ValueType>::ExtractRowL1Norm(BaseVector<ValueType>* vec_l1) const
     {
-        if(this->nnz_ > 0)
+        assert(vec_l1 != NULL);
+        assert(vec_l1->GetSize() == this->nrow_);
+
+        HostVector<ValueType>* cast_vec_l1 = dynamic_cast<HostVector<ValueType>*>(vec_l1);
+
+        assert(cast_vec_l1 != NULL);
+
+        cast_vec_l1->Zeros();
+
+        // Entries of a row can be scattered, accumulate sequentially
+        for(int64_t i = 0; i < this->nnz_; ++i)
         {
-            // Sort by row and column index
-            std::vector<int64_t> perm(this->nnz_);
+            cast_vec_l1->vec_[this->mat_.row[i]] += std::abs(this->mat_.val[i]);
+        }
 
-            // Create identity permutation
-            std::iota(perm.begin(), perm.end(), 0);
+        return true;
+    }
 
+    template <typename ValueType>
+    bool HostMatrixCOO<ValueType>::Sort(void)
+    {
+        if(this->nnz_ > 0)
+        {
             int*       row = this->mat_.row;
             int*       col = this->mat_.col;
             ValueType* val = this->mat_.val;
 
+            // Nothing to do if the entries are already sorted by row and column
+            bool sorted = true;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(&& : sorted)
+#endif
+            for(int64_t i = 1; i < this->nnz_; ++i)
+            {
+                sorted = sorted
+                         && (row[i] > row[i - 1] || (row[i] == row[i - 1] && col[i] >= col[i - 1]));
+            }
+
+            if(sorted == true)
+            {
+                return true;
+            }
+
+            // Stable counting sort by row index
+            std::vector<int64_t> row_offset(this->nrow_ + 1, 0);
+
+            for(int64_t i = 0; i < this->nnz_; ++i)
+            {
+                ++row_offset[row[i] + 1];
+            }
+
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                row_offset[i + 1] += row_offset[i];
+            }
+
+            std::vector<int64_t> perm(this->nnz_);
+            std::vector<int64_t> pos(row_offset.begin(), row_offset.end() - 1);
+
+            for(int64_t i = 0; i < this->nnz_; ++i)
+            {
+                perm[pos[row[i]]++] = i;
+            }
+
+            // Sort by column index within each row
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                std::stable_sort(perm.begin() + row_offset[i],
+                                 perm.begin() + row_offset[i + 1],
+                                 [&](int64_t a, int64_t b) { return col[a] < col[b]; });
+            }
+
             this->mat_.row = NULL;
             this->mat_.col = NULL;
             this->mat_.val = NULL;
@@ -425,15 +490,6 @@ namespace rocalution
             allocate_host(this->nnz_, &this->mat_.col);
             allocate_host(this->nnz_, &this->mat_.val);
 
-            // Compare function object to sort by row first, then by column
-            std::sort(perm.begin(), perm.end(), [&](const int& a, const int& b) {
-                if(row[a] < row[b])
-                    return true;
-                if(row[a] == row[b])
-                    return col[a] < col[b];
-                return false;
-            });
-
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
@@ -59,6 +59,8 @@ namespace rocalution
         virtual bool AddScalarDiagonal(ValueType alpha);
         virtual bool AddScalarOffDiagonal(ValueType alpha);
 
+        virtual bool ExtractRowL1Norm(BaseVector<ValueType>* vec_l1) const;
+
         virtual bool ConvertFrom(const BaseMatrix<ValueType>& mat);
 
         virtual bool Sort(void);
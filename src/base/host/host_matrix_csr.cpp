@@ -36,18 +36,23 @@
 #include "host_matrix_ell.hpp"
 #include "host_matrix_hyb.hpp"
 #include "host_matrix_mcsr.hpp"
+#include "host_matrix_sell.hpp"
+#include "host_matrix_vbr.hpp"
 #include "host_sparse.hpp"
 #include "host_vector.hpp"
 #include "rocalution/utils/types.hpp"
 
 #include "host_ilut_driver_csr.hpp"
 
+#include "../../solvers/preconditioners/preconditioner.hpp"
+
 #include <algorithm>
 #include <complex>
 #include <limits>
 #include <map>
 #include <math.h>
 #include <numeric>
+#include <set>
 #include <string.h>
 #include <unordered_map>
 #include <unordered_set>
@@ -84,9 +89,25 @@ namespace rocalution
         this->mat_.val        = NULL;
         this->set_backend(local_backend);
 
+        this->structure_ref_ = NULL;
+        this->view_          = false;
+
+        this->spmv_index_     = SpMVIndex_Full;
+        this->spmv_col_base_  = NULL;
+        this->spmv_col_off_   = NULL;
+        this->spmv_col_width_ = 0;
+
         this->L_diag_unit_ = false;
         this->U_diag_unit_ = false;
 
+        this->L_schedule_  = {0, NULL, NULL};
+        this->U_schedule_  = {0, NULL, NULL};
+        this->LT_schedule_ = {0, NULL, NULL};
+
+        this->LT_row_offset_ = NULL;
+        this->LT_col_        = NULL;
+        this->LT_pos_        = NULL;
+
         this->mat_buffer_size_ = 0;
         this->mat_buffer_      = NULL;
 
@@ -104,6 +125,19 @@ namespace rocalution
     template <typename ValueType>
     void HostMatrixCSR<ValueType>::Clear(void)
     {
+        this->InvalidateSpMVStructure_();
+        this->ReleaseStructure_();
+
+        if(this->view_ == true)
+        {
+            // External buffers are left to their owner
+            this->mat_.row_offset = NULL;
+            this->mat_.col        = NULL;
+            this->mat_.val        = NULL;
+
+            this->view_ = false;
+        }
+
         free_host(&this->mat_.row_offset);
         free_host(&this->mat_.col);
         free_host(&this->mat_.val);
@@ -116,6 +150,106 @@ namespace rocalution
         this->ItUAnalyseClear();
         this->ItLUAnalyseClear();
         this->ItLLAnalyseClear();
+
+        this->ClearLevelSchedule_(&this->L_schedule_);
+        this->ClearLevelSchedule_(&this->U_schedule_);
+        this->ClearLevelSchedule_(&this->LT_schedule_);
+        this->ClearTransposedLower_();
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::ReleaseStructure_(void)
+    {
+        if(this->structure_ref_ == NULL)
+        {
+            return;
+        }
+
+        if(--(*this->structure_ref_) > 0)
+        {
+            // The pattern is still used by another matrix
+            this->mat_.row_offset = NULL;
+            this->mat_.col        = NULL;
+        }
+        else
+        {
+            free_host(&this->structure_ref_);
+        }
+
+        this->structure_ref_ = NULL;
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::DetachStructure_(void)
+    {
+        // Every in-place change of the pattern detaches it first
+        this->InvalidateSpMVStructure_();
+        this->DetachView_();
+
+        if(this->structure_ref_ == NULL)
+        {
+            return;
+        }
+
+        if(*this->structure_ref_ > 1)
+        {
+            PtrType* row_offset = NULL;
+            int*     col        = NULL;
+
+            allocate_host(this->nrow_ + 1, &row_offset);
+            allocate_host(this->nnz_, &col);
+
+            copy_h2h(this->nrow_ + 1, this->mat_.row_offset, row_offset);
+            copy_h2h(this->nnz_, this->mat_.col, col);
+
+            this->ReleaseStructure_();
+
+            this->mat_.row_offset = row_offset;
+            this->mat_.col        = col;
+        }
+        else
+        {
+            this->ReleaseStructure_();
+        }
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::DetachView_(void)
+    {
+        if(this->view_ == false)
+        {
+            return;
+        }
+
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
+
+        allocate_host(this->nrow_ + 1, &row_offset);
+        copy_h2h(this->nrow_ + 1, this->mat_.row_offset, row_offset);
+
+        if(this->nnz_ > 0)
+        {
+            allocate_host(this->nnz_, &col);
+            allocate_host(this->nnz_, &val);
+
+            copy_h2h(this->nnz_, this->mat_.col, col);
+            copy_h2h(this->nnz_, this->mat_.val, val);
+        }
+
+        this->mat_.row_offset = row_offset;
+        this->mat_.col        = col;
+        this->mat_.val        = val;
+
+        this->view_ = false;
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::InvalidateSpMVStructure_(void) const
+    {
+        free_host(&this->spmv_col_base_);
+        free_host(&this->spmv_col_off_);
+        this->spmv_col_width_ = 0;
     }
 
     template <typename ValueType>
@@ -126,6 +260,81 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::UpdateValues(const BaseVector<ValueType>& val,
+                                                const BaseVector<int>*       perm,
+                                                int64_t                      offset)
+    {
+        const HostVector<ValueType>* cast_val = dynamic_cast<const HostVector<ValueType>*>(&val);
+
+        assert(cast_val != NULL);
+        assert(offset >= 0);
+
+        if(perm == NULL)
+        {
+            assert(cast_val->size_ >= offset + this->nnz_);
+
+            copy_h2h(this->nnz_, cast_val->vec_ + offset, this->mat_.val);
+
+            return true;
+        }
+
+        const HostVector<int>* cast_perm = dynamic_cast<const HostVector<int>*>(perm);
+
+        assert(cast_perm != NULL);
+        assert(cast_perm->size_ == cast_val->size_);
+
+        int64_t size = cast_perm->size_;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int64_t k = 0; k < size; ++k)
+        {
+            int64_t idx = cast_perm->vec_[k] - offset;
+
+            if(idx >= 0 && idx < this->nnz_)
+            {
+                this->mat_.val[idx] = cast_val->vec_[k];
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AssembleValues(const BaseVector<ValueType>& val,
+                                                  const BaseVector<int>&       offset,
+                                                  const BaseVector<int>&       perm)
+    {
+        const HostVector<ValueType>* cast_val  = dynamic_cast<const HostVector<ValueType>*>(&val);
+        const HostVector<int>*       cast_off  = dynamic_cast<const HostVector<int>*>(&offset);
+        const HostVector<int>*       cast_perm = dynamic_cast<const HostVector<int>*>(&perm);
+
+        assert(cast_val != NULL);
+        assert(cast_off != NULL);
+        assert(cast_perm != NULL);
+        assert(cast_off->size_ == this->nnz_ + 1);
+        assert(cast_perm->size_ == cast_val->size_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int64_t j = 0; j < this->nnz_; ++j)
+        {
+            ValueType sum = static_cast<ValueType>(0);
+
+            for(int k = cast_off->vec_[j]; k < cast_off->vec_[j + 1]; ++k)
+            {
+                sum += cast_val->vec_[cast_perm->vec_[k]];
+            }
+
+            this->mat_.val[j] = sum;
+        }
+
+        return true;
+    }
+
     template <typename ValueType>
     void HostMatrixCSR<ValueType>::Info(void) const
     {
@@ -295,9 +504,39 @@ namespace rocalution
         this->mat_.val        = *val;
     }
 
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::AttachViewCSR(
+        PtrType* row_offset, int* col, ValueType* val, int64_t nnz, int nrow, int ncol)
+    {
+        assert(nnz >= 0);
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+        assert(row_offset != NULL);
+
+        if(nnz > 0)
+        {
+            assert(col != NULL);
+            assert(val != NULL);
+        }
+
+        this->Clear();
+
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+        this->nnz_  = nnz;
+
+        this->mat_.row_offset = row_offset;
+        this->mat_.col        = col;
+        this->mat_.val        = val;
+
+        this->view_ = true;
+    }
+
     template <typename ValueType>
     void HostMatrixCSR<ValueType>::LeaveDataPtrCSR(PtrType** row_offset, int** col, ValueType** val)
     {
+        this->DetachStructure_();
+
         assert(this->nrow_ >= 0);
         assert(this->ncol_ >= 0);
         assert(this->nnz_ >= 0);
@@ -313,6 +552,11 @@ namespace rocalution
         this->nrow_ = 0;
         this->ncol_ = 0;
         this->nnz_  = 0;
+
+        this->ClearLevelSchedule_(&this->L_schedule_);
+        this->ClearLevelSchedule_(&this->U_schedule_);
+        this->ClearLevelSchedule_(&this->LT_schedule_);
+        this->ClearTransposedLower_();
     }
 
     template <typename ValueType>
@@ -322,6 +566,8 @@ namespace rocalution
     {
         assert(row_offsets != NULL);
 
+        this->DetachStructure_();
+
         copy_h2h(this->nrow_ + 1, row_offsets, this->mat_.row_offset);
 
         if(this->nnz_ > 0)
@@ -373,13 +619,21 @@ namespace rocalution
             assert(this->nrow_ == cast_mat->nrow_);
             assert(this->ncol_ == cast_mat->ncol_);
 
-            // Copy only if initialized
-            if(cast_mat->mat_.row_offset != NULL)
+            // Matrices sharing the pattern only copy the values
+            if(this->mat_.col != cast_mat->mat_.col
+               || this->mat_.row_offset != cast_mat->mat_.row_offset)
             {
-                copy_h2h(this->nrow_ + 1, cast_mat->mat_.row_offset, this->mat_.row_offset);
+                this->DetachStructure_();
+
+                // Copy only if initialized
+                if(cast_mat->mat_.row_offset != NULL)
+                {
+                    copy_h2h(this->nrow_ + 1, cast_mat->mat_.row_offset, this->mat_.row_offset);
+                }
+
+                copy_h2h(this->nnz_, cast_mat->mat_.col, this->mat_.col);
             }
 
-            copy_h2h(this->nnz_, cast_mat->mat_.col, this->mat_.col);
             copy_h2h(this->nnz_, cast_mat->mat_.val, this->mat_.val);
         }
         else
@@ -390,6 +644,49 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ShareStructureFrom(const BaseMatrix<ValueType>& mat)
+    {
+        const HostMatrixCSR<ValueType>* cast_mat
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
+
+        // External buffers may go away with their owner, views are copied instead
+        if(cast_mat == NULL || cast_mat->view_ == true)
+        {
+            return false;
+        }
+
+        assert(cast_mat != this);
+
+        this->Clear();
+
+        if(cast_mat->mat_.row_offset == NULL)
+        {
+            return true;
+        }
+
+        if(cast_mat->structure_ref_ == NULL)
+        {
+            allocate_host(1, &cast_mat->structure_ref_);
+            *cast_mat->structure_ref_ = 1;
+        }
+
+        ++(*cast_mat->structure_ref_);
+
+        this->structure_ref_  = cast_mat->structure_ref_;
+        this->mat_.row_offset = cast_mat->mat_.row_offset;
+        this->mat_.col        = cast_mat->mat_.col;
+
+        this->nrow_ = cast_mat->nrow_;
+        this->ncol_ = cast_mat->ncol_;
+        this->nnz_  = cast_mat->nnz_;
+
+        allocate_host(this->nnz_, &this->mat_.val);
+        copy_h2h(this->nnz_, cast_mat->mat_.val, this->mat_.val);
+
+        return true;
+    }
+
     template <typename ValueType>
     void HostMatrixCSR<ValueType>::CopyTo(BaseMatrix<ValueType>* mat) const
     {
@@ -407,7 +704,14 @@ namespace rocalution
         int*       col = NULL;
         ValueType* val = NULL;
 
-        if(read_matrix_csr_rocsparseio(nrow, ncol, nnz, &ptr, &col, &val, filename.c_str()) != true)
+        // Compressed files are detected by their header
+        const char* name = filename.c_str();
+
+        bool status = is_matrix_csr_compressed(name)
+                          ? read_matrix_csr_compressed(nrow, ncol, nnz, &ptr, &col, &val, name)
+                          : read_matrix_csr_rocsparseio(nrow, ncol, nnz, &ptr, &col, &val, name);
+
+        if(status != true)
         {
             return false;
         }
@@ -422,6 +726,29 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ReadFileMTX(const std::string& filename)
+    {
+        int     nrow;
+        int     ncol;
+        int64_t nnz;
+
+        PtrType*   ptr = NULL;
+        int*       col = NULL;
+        ValueType* val = NULL;
+
+        // Entries are scattered into their rows in parallel, rows are not sorted
+        if(read_matrix_mtx_csr(nrow, ncol, nnz, &ptr, &col, &val, filename.c_str()) != true)
+        {
+            return false;
+        }
+
+        this->Clear();
+        this->SetDataPtrCSR(&ptr, &col, &val, nnz, nrow, ncol);
+
+        return true;
+    }
+
     template <typename ValueType>
     bool HostMatrixCSR<ValueType>::ReadFileCSR(const std::string& filename)
     {
@@ -497,6 +824,18 @@ namespace rocalution
                                             filename.c_str());
     }
 
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::WriteFileCompressedRSIO(const std::string& filename) const
+    {
+        return write_matrix_csr_compressed(this->nrow_,
+                                           this->ncol_,
+                                           this->nnz_,
+                                           this->mat_.row_offset,
+                                           this->mat_.col,
+                                           this->mat_.val,
+                                           filename.c_str());
+    }
+
     template <typename ValueType>
     bool HostMatrixCSR<ValueType>::WriteFileCSR(const std::string& filename) const
     {
@@ -649,6 +988,52 @@ namespace rocalution
             }
         }
 
+        if(const HostMatrixSELL<ValueType>* cast_mat
+           = dynamic_cast<const HostMatrixSELL<ValueType>*>(&mat))
+        {
+            this->Clear();
+            int64_t nnz;
+
+            if(sell_to_csr(this->local_backend_.OpenMP_threads,
+                           cast_mat->nnz_,
+                           cast_mat->nrow_,
+                           cast_mat->ncol_,
+                           cast_mat->mat_,
+                           &this->mat_,
+                           &nnz)
+               == true)
+            {
+                this->nrow_ = cast_mat->nrow_;
+                this->ncol_ = cast_mat->ncol_;
+                this->nnz_  = nnz;
+
+                return true;
+            }
+        }
+
+        if(const HostMatrixVBR<ValueType>* cast_mat
+           = dynamic_cast<const HostMatrixVBR<ValueType>*>(&mat))
+        {
+            this->Clear();
+            int64_t nnz;
+
+            if(vbr_to_csr(this->local_backend_.OpenMP_threads,
+                          cast_mat->nnz_,
+                          cast_mat->nrow_,
+                          cast_mat->ncol_,
+                          cast_mat->mat_,
+                          &this->mat_,
+                          &nnz)
+               == true)
+            {
+                this->nrow_ = cast_mat->nrow_;
+                this->ncol_ = cast_mat->ncol_;
+                this->nnz_  = nnz;
+
+                return true;
+            }
+        }
+
         if(const HostMatrixMCSR<ValueType>* cast_mat
            = dynamic_cast<const HostMatrixMCSR<ValueType>*>(&mat))
         {
@@ -698,475 +1083,708 @@ namespace rocalution
         return false;
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::Apply(const BaseVector<ValueType>& in,
-                                         BaseVector<ValueType>*       out) const
+    // First row of chunk part out of nparts, such that all chunks hold (nearly) the same
+    // amount of work. The work of a row is its number of non-zeros plus one, to account
+    // for writing the result. Rows are contiguous within a chunk, thus power-law row
+    // lengths do not load-imbalance the threads as a static split of the rows does.
+    static inline int
+        csr_balanced_row_begin(int nrow, const PtrType* row_offset, int part, int nparts)
     {
-        assert(in.GetSize() >= 0);
-        assert(out->GetSize() >= 0);
-        assert(in.GetSize() == this->ncol_);
-        assert(out->GetSize() == this->nrow_);
+        if(part <= 0)
+        {
+            return 0;
+        }
 
-        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+        if(part >= nparts)
+        {
+            return nrow;
+        }
 
-        assert(cast_in != NULL);
-        assert(cast_out != NULL);
+        int64_t work = (static_cast<int64_t>(row_offset[nrow]) + nrow) * part / nparts;
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        // Binary search for the first row, where the accumulated work reaches the target
+        int lo = 0;
+        int hi = nrow;
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        while(lo < hi)
         {
-            ValueType sum     = static_cast<ValueType>(0);
-            PtrType   row_beg = this->mat_.row_offset[ai];
-            PtrType   row_end = this->mat_.row_offset[ai + 1];
+            int mid = lo + (hi - lo) / 2;
 
-            for(PtrType aj = row_beg; aj < row_end; ++aj)
+            if(static_cast<int64_t>(row_offset[mid]) + mid < work)
             {
-                sum += this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
             }
-
-            cast_out->vec_[ai] = sum;
         }
+
+        return lo;
     }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
-                                            ValueType                    scalar,
-                                            BaseVector<ValueType>*       out) const
+    // Convert the row counts in row_offset[0, nrow) into the row offsets
+    // row_offset[0, nrow] by an exclusive sum. Each thread scans a contiguous chunk of
+    // rows, and the chunk sums are added in a second pass.
+    static void csr_row_count_to_offset(int nrow, PtrType* row_offset)
     {
-        if(this->nnz_ > 0)
+        // Small arrays are not worth the fork
+        int nt = std::max(1, std::min(omp_get_max_threads(), nrow / 16384));
+
+        std::vector<PtrType> chunk_sum(nt + 1, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nt)
+#endif
         {
-            assert(in.GetSize() >= 0);
-            assert(out->GetSize() >= 0);
-            assert(in.GetSize() == this->ncol_);
-            assert(out->GetSize() == this->nrow_);
+            int nthreads = omp_get_num_threads();
+            int tid      = omp_get_thread_num();
 
-            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+            int row_beg = static_cast<int>(static_cast<int64_t>(nrow) * tid / nthreads);
+            int row_end = static_cast<int>(static_cast<int64_t>(nrow) * (tid + 1) / nthreads);
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
+            PtrType sum = 0;
 
-            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+            for(int i = row_beg; i < row_end; ++i)
+            {
+                PtrType count = row_offset[i];
+                row_offset[i] = sum;
+                sum += count;
+            }
+
+            chunk_sum[tid + 1] = sum;
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp barrier
+#pragma omp single
 #endif
-            for(int ai = 0; ai < this->nrow_; ++ai)
+            for(int t = 0; t < nthreads; ++t)
             {
-                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
-                    ++aj)
-                {
-                    cast_out->vec_[ai]
-                        += scalar * this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
-                }
+                chunk_sum[t + 1] += chunk_sum[t];
+            }
+
+            for(int i = row_beg; i < row_end; ++i)
+            {
+                row_offset[i] += chunk_sum[tid];
+            }
+
+            if(tid == nthreads - 1)
+            {
+                row_offset[nrow] = chunk_sum[nthreads];
             }
         }
     }
 
+    // Dot product of a sparse row with a dense vector. The real types are reduced in
+    // SIMD lanes, such that the compiler can use gather instructions, when available.
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ExtractDiagonal(BaseVector<ValueType>* vec_diag) const
+    static inline ValueType csr_row_dot(PtrType          row_beg,
+                                        PtrType          row_end,
+                                        const int*       col,
+                                        const ValueType* val,
+                                        const ValueType* x)
     {
-        assert(vec_diag != NULL);
-        assert(vec_diag->GetSize() >= this->nrow_);
+        ValueType sum = static_cast<ValueType>(0);
 
-        HostVector<ValueType>* cast_vec_diag = dynamic_cast<HostVector<ValueType>*>(vec_diag);
+        for(PtrType aj = row_beg; aj < row_end; ++aj)
+        {
+            sum += val[aj] * x[col[aj]];
+        }
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        return sum;
+    }
+
+    static inline float csr_row_dot(
+        PtrType row_beg, PtrType row_end, const int* col, const float* val, const float* x)
+    {
+        float sum = 0.0f;
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp simd reduction(+ : sum)
 #endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        for(PtrType aj = row_beg; aj < row_end; ++aj)
         {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                if(ai == this->mat_.col[aj])
-                {
-                    cast_vec_diag->vec_[ai] = this->mat_.val[aj];
-                    break;
-                }
-            }
+            sum += val[aj] * x[col[aj]];
         }
 
-        return true;
+        return sum;
     }
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ExtractInverseDiagonal(BaseVector<ValueType>* vec_inv_diag) const
+    static inline double csr_row_dot(
+        PtrType row_beg, PtrType row_end, const int* col, const double* val, const double* x)
     {
-        assert(vec_inv_diag != NULL);
-        assert(vec_inv_diag->GetSize() == this->nrow_);
-
-        HostVector<ValueType>* cast_vec_inv_diag
-            = dynamic_cast<HostVector<ValueType>*>(vec_inv_diag);
-
-        int detect_zero_diag = 0;
-
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        double sum = 0.0;
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp simd reduction(+ : sum)
 #endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        for(PtrType aj = row_beg; aj < row_end; ++aj)
         {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            sum += val[aj] * x[col[aj]];
+        }
+
+        return sum;
+    }
+
+    // Rows [row_beg, row_end) of y = alpha * A * x + beta * y, the column indices are read
+    // as offsets C to the base column of their row. Rows with a negative base keep their
+    // full column indices.
+    template <typename C, typename ValueType>
+    static inline void csr_rows_spmv_compressed(int              row_beg,
+                                                int              row_end,
+                                                const PtrType*   row_offset,
+                                                const int*       col,
+                                                const int*       col_base,
+                                                const C*         col_off,
+                                                const ValueType* val,
+                                                ValueType        alpha,
+                                                const ValueType* x,
+                                                ValueType        beta,
+                                                ValueType*       y)
+    {
+        for(int ai = row_beg; ai < row_end; ++ai)
+        {
+            PtrType start = row_offset[ai];
+            PtrType end   = row_offset[ai + 1];
+            int     base  = col_base[ai];
+
+            ValueType sum;
+
+            if(base < 0)
             {
-                if(ai == this->mat_.col[aj])
-                {
-                    if(this->mat_.val[aj] != static_cast<ValueType>(0))
-                    {
-                        cast_vec_inv_diag->vec_[ai]
-                            = static_cast<ValueType>(1) / this->mat_.val[aj];
-                    }
-                    else
-                    {
-                        cast_vec_inv_diag->vec_[ai] = static_cast<ValueType>(1);
-                        detect_zero_diag            = 1;
-                    }
+                sum = csr_row_dot(start, end, col, val, x);
+            }
+            else
+            {
+                const ValueType* xb = x + base;
 
-                    break;
+                sum = static_cast<ValueType>(0);
+
+                for(PtrType aj = start; aj < end; ++aj)
+                {
+                    sum += val[aj] * xb[col_off[aj]];
                 }
             }
+
+            y[ai] = (beta == static_cast<ValueType>(0)) ? alpha * sum : alpha * sum + beta * y[ai];
         }
+    }
 
-        if(detect_zero_diag == 1)
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::SetSpMVIndex(unsigned int index)
+    {
+        if(index != this->spmv_index_)
         {
-            LOG_VERBOSE_INFO(
-                2,
-                "*** warning: in HostMatrixCSR::ExtractInverseDiagonal() a zero has been detected "
-                "on the diagonal. It has been replaced with one to avoid inf");
+            this->spmv_index_ = index;
+            this->InvalidateSpMVStructure_();
         }
-        return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ExtractSubMatrix(int                    row_offset,
-                                                    int                    col_offset,
-                                                    int                    row_size,
-                                                    int                    col_size,
-                                                    BaseMatrix<ValueType>* mat) const
+    bool HostMatrixCSR<ValueType>::SpMVCompressed_(ValueType                    alpha,
+                                                   const HostVector<ValueType>& in,
+                                                   ValueType                    beta,
+                                                   HostVector<ValueType>*       out) const
     {
-        assert(mat != NULL);
+        // The compressed indices are built on first use, they are released whenever the
+        // sparsity pattern changes
+        if(this->spmv_col_base_ == NULL)
+        {
+            std::vector<int> col_span(this->nrow_);
 
-        assert(row_offset >= 0);
-        assert(col_offset >= 0);
+            allocate_host(this->nrow_, &this->spmv_col_base_);
 
-        assert(this->nrow_ >= 0);
-        assert(this->ncol_ >= 0);
+            // Number of non-zeros of the rows whose column span exceeds 8 and 16 bits
+            int64_t nnz_over_8  = 0;
+            int64_t nnz_over_16 = 0;
 
-        HostMatrixCSR<ValueType>* cast_mat = dynamic_cast<HostMatrixCSR<ValueType>*>(mat);
-        assert(cast_mat != NULL);
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nnz_over_8, nnz_over_16)
+#endif
+            for(int ai = 0; ai < this->nrow_; ++ai)
+            {
+                PtrType row_begin = this->mat_.row_offset[ai];
+                PtrType row_end   = this->mat_.row_offset[ai + 1];
 
-        int64_t mat_nnz = 0;
+                int col_min = (row_begin < row_end) ? this->mat_.col[row_begin] : 0;
+                int col_max = col_min;
 
-        // use omp in local_matrix (higher level)
+                for(PtrType aj = row_begin + 1; aj < row_end; ++aj)
+                {
+                    col_min = std::min(col_min, this->mat_.col[aj]);
+                    col_max = std::max(col_max, this->mat_.col[aj]);
+                }
 
-        //  _set_omp_backend_threads(this->local_backend_, this->nrow_);
+                this->spmv_col_base_[ai] = col_min;
+                col_span[ai]             = col_max - col_min;
 
-        //#ifdef _OPENMP
-        //#pragma omp parallel for reduction(+:mat_nnz)
-        //#endif
-        for(int ai = row_offset; ai < row_offset + row_size; ++ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                if((this->mat_.col[aj] >= col_offset)
-                   && (this->mat_.col[aj] < col_offset + col_size))
+                if(col_max - col_min > 255)
                 {
-                    ++mat_nnz;
+                    nnz_over_8 += row_end - row_begin;
+                }
+
+                if(col_max - col_min > 65535)
+                {
+                    nnz_over_16 += row_end - row_begin;
                 }
             }
-        }
 
-        cast_mat->AllocateCSR(mat_nnz, row_size, col_size);
+            // Index traffic of 8 and 16 bit offsets, the rows whose span exceeds the offsets
+            // read their full column indices instead. The base columns are read once per row.
+            int64_t bytes_full = sizeof(int) * this->nnz_;
+            int64_t bytes_8    = (this->nnz_ - nnz_over_8) + sizeof(int) * nnz_over_8
+                              + sizeof(int) * this->nrow_;
+            int64_t bytes_16 = 2 * (this->nnz_ - nnz_over_16) + sizeof(int) * nnz_over_16
+                               + sizeof(int) * this->nrow_;
 
-        // not empty submatrix
-        if(mat_nnz > 0)
-        {
-            PtrType mat_row_offset       = 0;
-            cast_mat->mat_.row_offset[0] = mat_row_offset;
+            this->spmv_col_width_ = (bytes_8 <= bytes_16) ? 1 : 2;
 
-            for(int ai = row_offset; ai < row_offset + row_size; ++ai)
+            if(std::min(bytes_8, bytes_16) < bytes_full)
             {
-                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
-                    ++aj)
+                allocate_host(this->nnz_ * this->spmv_col_width_, &this->spmv_col_off_);
+
+                int span_max = (1 << (8 * this->spmv_col_width_)) - 1;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+                for(int ai = 0; ai < this->nrow_; ++ai)
                 {
-                    if((this->mat_.col[aj] >= col_offset)
-                       && (this->mat_.col[aj] < col_offset + col_size))
+                    if(col_span[ai] > span_max)
                     {
-                        cast_mat->mat_.col[mat_row_offset] = this->mat_.col[aj] - col_offset;
-                        cast_mat->mat_.val[mat_row_offset] = this->mat_.val[aj];
-                        ++mat_row_offset;
+                        this->spmv_col_base_[ai] = -1;
+
+                        continue;
                     }
-                }
 
-                cast_mat->mat_.row_offset[ai - row_offset + 1] = mat_row_offset;
+                    int base = this->spmv_col_base_[ai];
+
+                    for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
+                        ++aj)
+                    {
+                        if(this->spmv_col_width_ == 1)
+                        {
+                            reinterpret_cast<unsigned char*>(this->spmv_col_off_)[aj]
+                                = static_cast<unsigned char>(this->mat_.col[aj] - base);
+                        }
+                        else
+                        {
+                            reinterpret_cast<unsigned short*>(this->spmv_col_off_)[aj]
+                                = static_cast<unsigned short>(this->mat_.col[aj] - base);
+                        }
+                    }
+                }
             }
+        }
 
-            cast_mat->mat_.row_offset[row_size] = mat_row_offset;
-            assert(mat_row_offset == mat_nnz);
+        // The structure does not benefit from the compression
+        if(this->spmv_col_off_ == NULL)
+        {
+            return false;
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // nnz balanced chunk of rows for this thread
+            int nt  = omp_get_num_threads();
+            int tid = omp_get_thread_num();
+
+            int row_beg = csr_balanced_row_begin(this->nrow_, this->mat_.row_offset, tid, nt);
+            int row_end = csr_balanced_row_begin(this->nrow_, this->mat_.row_offset, tid + 1, nt);
+
+            if(this->spmv_col_width_ == 1)
+            {
+                csr_rows_spmv_compressed(
+                    row_beg,
+                    row_end,
+                    this->mat_.row_offset,
+                    this->mat_.col,
+                    this->spmv_col_base_,
+                    reinterpret_cast<const unsigned char*>(this->spmv_col_off_),
+                    this->mat_.val,
+                    alpha,
+                    in.vec_,
+                    beta,
+                    out->vec_);
+            }
+            else
+            {
+                csr_rows_spmv_compressed(
+                    row_beg,
+                    row_end,
+                    this->mat_.row_offset,
+                    this->mat_.col,
+                    this->spmv_col_base_,
+                    reinterpret_cast<const unsigned short*>(this->spmv_col_off_),
+                    this->mat_.val,
+                    alpha,
+                    in.vec_,
+                    beta,
+                    out->vec_);
+            }
         }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ExtractU(BaseMatrix<ValueType>* U) const
+    void HostMatrixCSR<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                         BaseVector<ValueType>*       out) const
     {
-        assert(U != NULL);
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
 
-        assert(this->nrow_ > 0);
-        assert(this->ncol_ > 0);
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
 
-        HostMatrixCSR<ValueType>* cast_U = dynamic_cast<HostMatrixCSR<ValueType>*>(U);
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_, OMP_OP_SPMV);
+
+        if(this->spmv_index_ == SpMVIndex_Compressed && this->nnz_ > 0
+           && this->SpMVCompressed_(static_cast<ValueType>(1),
+                                    *cast_in,
+                                    static_cast<ValueType>(0),
+                                    cast_out)
+                  == true)
+        {
+            return;
+        }
 
-        assert(cast_U != NULL);
 
-        // count nnz of upper triangular part
-        int64_t nnz_U = 0;
 #ifdef _OPENMP
-#pragma omp parallel for reduction(+ : nnz_U)
+#pragma omp parallel
 #endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            // nnz balanced chunk of rows for this thread
+            int nt  = omp_get_num_threads();
+            int tid = omp_get_thread_num();
+
+            int row_beg = csr_balanced_row_begin(this->nrow_, this->mat_.row_offset, tid, nt);
+            int row_end = csr_balanced_row_begin(this->nrow_, this->mat_.row_offset, tid + 1, nt);
+
+            for(int ai = row_beg; ai < row_end; ++ai)
             {
-                if(this->mat_.col[aj] > ai)
-                {
-                    ++nnz_U;
-                }
+                cast_out->vec_[ai] = csr_row_dot(this->mat_.row_offset[ai],
+                                                 this->mat_.row_offset[ai + 1],
+                                                 this->mat_.col,
+                                                 this->mat_.val,
+                                                 cast_in->vec_);
             }
         }
+    }
 
-        // allocate upper triangular part structure
-        PtrType*   row_offset = NULL;
-        int*       col        = NULL;
-        ValueType* val        = NULL;
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                            ValueType                    scalar,
+                                            BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(in.GetSize() >= 0);
+            assert(out->GetSize() >= 0);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
 
-        allocate_host(this->nrow_ + 1, &row_offset);
-        allocate_host(nnz_U, &col);
-        allocate_host(nnz_U, &val);
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
 
-        // fill upper triangular part
-        PtrType nnz   = 0;
-        row_offset[0] = 0;
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_, OMP_OP_SPMV);
+
+            if(this->spmv_index_ == SpMVIndex_Compressed
+               && this->SpMVCompressed_(scalar, *cast_in, static_cast<ValueType>(1), cast_out)
+                      == true)
             {
-                if(this->mat_.col[aj] > ai)
+                return;
+            }
+
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                // nnz balanced chunk of rows for this thread
+                int nt  = omp_get_num_threads();
+                int tid = omp_get_thread_num();
+
+                int row_beg = csr_balanced_row_begin(this->nrow_, this->mat_.row_offset, tid, nt);
+                int row_end
+                    = csr_balanced_row_begin(this->nrow_, this->mat_.row_offset, tid + 1, nt);
+
+                for(int ai = row_beg; ai < row_end; ++ai)
                 {
-                    col[nnz] = this->mat_.col[aj];
-                    val[nnz] = this->mat_.val[aj];
-                    ++nnz;
+                    cast_out->vec_[ai] += scalar
+                                          * csr_row_dot(this->mat_.row_offset[ai],
+                                                        this->mat_.row_offset[ai + 1],
+                                                        this->mat_.col,
+                                                        this->mat_.val,
+                                                        cast_in->vec_);
                 }
             }
-
-            row_offset[ai + 1] = nnz;
         }
+    }
 
-        cast_U->Clear();
-        cast_U->SetDataPtrCSR(&row_offset, &col, &val, nnz_U, this->nrow_, this->ncol_);
+    // Atomic dst += val, complex values are updated component-wise
+    template <typename ValueType>
+    static inline void csr_atomic_add(ValueType* dst, ValueType val)
+    {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        *dst += val;
+    }
 
-        return true;
+    template <typename ValueType>
+    static inline void csr_atomic_add(std::complex<ValueType>* dst, std::complex<ValueType> val)
+    {
+        ValueType* ptr = reinterpret_cast<ValueType*>(dst);
+
+        csr_atomic_add(ptr, val.real());
+        csr_atomic_add(ptr + 1, val.imag());
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ExtractUDiagonal(BaseMatrix<ValueType>* U) const
+    bool HostMatrixCSR<ValueType>::ApplyTranspose(const BaseVector<ValueType>& in,
+                                                  BaseVector<ValueType>*       out) const
     {
-        assert(U != NULL);
+        assert(in.GetSize() == this->nrow_);
+        assert(out->GetSize() == this->ncol_);
 
-        assert(this->nrow_ > 0);
-        assert(this->ncol_ > 0);
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
 
-        HostMatrixCSR<ValueType>* cast_U = dynamic_cast<HostMatrixCSR<ValueType>*>(U);
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
 
-        assert(cast_U != NULL);
+        cast_out->Zeros();
 
-        // count nnz of upper triangular part
-        int64_t nnz_U = 0;
-#ifdef _OPENMP
-#pragma omp parallel for reduction(+ : nnz_U)
-#endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                if(this->mat_.col[aj] >= ai)
-                {
-                    ++nnz_U;
-                }
-            }
-        }
+        return this->ApplyTransposeAdd(in, static_cast<ValueType>(1), out);
+    }
 
-        // allocate upper triangular part structure
-        PtrType*   row_offset = NULL;
-        int*       col        = NULL;
-        ValueType* val        = NULL;
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ApplyTransposeAdd(const BaseVector<ValueType>& in,
+                                                     ValueType                    scalar,
+                                                     BaseVector<ValueType>*       out) const
+    {
+        assert(in.GetSize() == this->nrow_);
+        assert(out->GetSize() == this->ncol_);
 
-        allocate_host(this->nrow_ + 1, &row_offset);
-        allocate_host(nnz_U, &col);
-        allocate_host(nnz_U, &val);
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
 
-        // fill upper triangular part
-        PtrType nnz   = 0;
-        row_offset[0] = 0;
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        // Row i of the matrix scatters scalar*in[i] into the entries of its columns
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for(int ai = 0; ai < this->nrow_; ++ai)
         {
+            ValueType x = scalar * cast_in->vec_[ai];
+
             for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                if(this->mat_.col[aj] >= ai)
-                {
-                    col[nnz] = this->mat_.col[aj];
-                    val[nnz] = this->mat_.val[aj];
-                    ++nnz;
-                }
+                csr_atomic_add(&cast_out->vec_[this->mat_.col[aj]], this->mat_.val[aj] * x);
             }
-
-            row_offset[ai + 1] = nnz;
         }
 
-        cast_U->Clear();
-        cast_U->SetDataPtrCSR(&row_offset, &col, &val, nnz_U, this->nrow_, this->ncol_);
-
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ExtractL(BaseMatrix<ValueType>* L) const
+    bool HostMatrixCSR<ValueType>::ApplyAddSymmetric(const BaseVector<ValueType>& in,
+                                                     ValueType                    scalar,
+                                                     BaseVector<ValueType>*       out) const
     {
-        assert(L != NULL);
+        assert(this->nrow_ == this->ncol_);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
 
-        assert(this->nrow_ > 0);
-        assert(this->ncol_ > 0);
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
 
-        HostMatrixCSR<ValueType>* cast_L = dynamic_cast<HostMatrixCSR<ValueType>*>(L);
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
 
-        assert(cast_L != NULL);
+        const ValueType* x = cast_in->vec_;
+        ValueType*       y = cast_out->vec_;
 
-        // count nnz of lower triangular part
-        int64_t nnz_L = 0;
+        int64_t nrow = this->nrow_;
+
+        // Private accumulators of the threads, see below
+        std::vector<int64_t>   acc_offset;
+        std::vector<ValueType> acc;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        // Each thread owns a contiguous chunk of rows. The mirrored entries of the upper
+        // triangle land in columns behind the first row of the chunk. Those within the
+        // chunk are added directly, the others are accumulated privately and reduced into
+        // the chunks of the subsequent threads afterwards, such that no atomics are needed.
 #ifdef _OPENMP
-#pragma omp parallel for reduction(+ : nnz_L)
+#pragma omp parallel
 #endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            int nthreads = omp_get_num_threads();
+            int tid      = omp_get_thread_num();
+
+#ifdef _OPENMP
+#pragma omp single
+#endif
             {
-                if(this->mat_.col[aj] < ai)
+                acc_offset.assign(nthreads + 1, 0);
+
+                for(int t = 0; t < nthreads; ++t)
                 {
-                    ++nnz_L;
+                    acc_offset[t + 1] = acc_offset[t] + nrow - nrow * (t + 1) / nthreads;
                 }
+
+                acc.assign(acc_offset[nthreads], static_cast<ValueType>(0));
             }
-        }
 
-        // allocate lower triangular part structure
-        PtrType*   row_offset = NULL;
-        int*       col        = NULL;
-        ValueType* val        = NULL;
+            int row_beg = static_cast<int>(nrow * tid / nthreads);
+            int row_end = static_cast<int>(nrow * (tid + 1) / nthreads);
 
-        allocate_host(this->nrow_ + 1, &row_offset);
-        allocate_host(nnz_L, &col);
-        allocate_host(nnz_L, &val);
+            ValueType* priv = acc.data() + acc_offset[tid];
 
-        // fill lower triangular part
-        PtrType nnz   = 0;
-        row_offset[0] = 0;
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            for(int ai = row_beg; ai < row_end; ++ai)
             {
-                if(this->mat_.col[aj] < ai)
+                ValueType xi  = scalar * x[ai];
+                ValueType sum = static_cast<ValueType>(0);
+
+                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
+                    ++aj)
                 {
-                    col[nnz] = this->mat_.col[aj];
-                    val[nnz] = this->mat_.val[aj];
-                    ++nnz;
+                    int       col = this->mat_.col[aj];
+                    ValueType val = this->mat_.val[aj];
+
+                    assert(col >= ai);
+
+                    sum += val * x[col];
+
+                    if(col == ai)
+                    {
+                        continue;
+                    }
+
+                    if(col < row_end)
+                    {
+                        y[col] += val * xi;
+                    }
+                    else
+                    {
+                        priv[col - row_end] += val * xi;
+                    }
                 }
+
+                y[ai] += scalar * sum;
             }
 
-            row_offset[ai + 1] = nnz;
-        }
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
 
-        cast_L->Clear();
-        cast_L->SetDataPtrCSR(&row_offset, &col, &val, nnz_L, this->nrow_, this->ncol_);
+            for(int ai = row_beg; ai < row_end; ++ai)
+            {
+                ValueType sum = static_cast<ValueType>(0);
+
+                for(int t = 0; t < tid; ++t)
+                {
+                    sum += acc[acc_offset[t] + ai - nrow * (t + 1) / nthreads];
+                }
+
+                y[ai] += sum;
+            }
+        }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ExtractLDiagonal(BaseMatrix<ValueType>* L) const
+    bool HostMatrixCSR<ValueType>::ApplyMulti(int                          ncol,
+                                              const BaseVector<ValueType>& in,
+                                              BaseVector<ValueType>*       out) const
     {
-        assert(L != NULL);
+        assert(ncol >= 0);
+        assert(in.GetSize() == static_cast<int64_t>(this->ncol_) * ncol);
+        assert(out->GetSize() == static_cast<int64_t>(this->nrow_) * ncol);
 
-        assert(this->nrow_ > 0);
-        assert(this->ncol_ > 0);
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
 
-        HostMatrixCSR<ValueType>* cast_L = dynamic_cast<HostMatrixCSR<ValueType>*>(L);
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
 
-        assert(cast_L != NULL);
+        // Number of columns that are processed within a single sweep over the matrix.
+        // Their partial sums are kept in registers while a row is traversed. Larger tiles
+        // would read the matrix less often, but the number of concurrently accessed
+        // column streams would exceed what caches and TLB can hold.
+        const int tile = 8;
+
+        int64_t ldin  = this->ncol_;
+        int64_t ldout = this->nrow_;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        for(int j = 0; j < ncol; j += tile)
+        {
+            int nj = std::min(tile, ncol - j);
 
-        // count nnz of lower triangular part
-        int64_t nnz_L = 0;
 #ifdef _OPENMP
-#pragma omp parallel for reduction(+ : nnz_L)
+#pragma omp parallel for
 #endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            for(int ai = 0; ai < this->nrow_; ++ai)
             {
-                if(this->mat_.col[aj] <= ai)
+                PtrType   row_beg = this->mat_.row_offset[ai];
+                PtrType   row_end = this->mat_.row_offset[ai + 1];
+                ValueType sum[tile];
+
+                for(int k = 0; k < nj; ++k)
                 {
-                    ++nnz_L;
+                    sum[k] = static_cast<ValueType>(0);
                 }
-            }
-        }
 
-        // allocate lower triangular part structure
-        PtrType*   row_offset = NULL;
-        int*       col        = NULL;
-        ValueType* val        = NULL;
+                for(PtrType aj = row_beg; aj < row_end; ++aj)
+                {
+                    ValueType        val = this->mat_.val[aj];
+                    const ValueType* x   = cast_in->vec_ + j * ldin + this->mat_.col[aj];
 
-        allocate_host(this->nrow_ + 1, &row_offset);
-        allocate_host(nnz_L, &col);
-        allocate_host(nnz_L, &val);
+                    for(int k = 0; k < nj; ++k)
+                    {
+                        sum[k] += val * x[k * ldin];
+                    }
+                }
 
-        // fill lower triangular part
-        PtrType nnz   = 0;
-        row_offset[0] = 0;
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                if(this->mat_.col[aj] <= ai)
+                for(int k = 0; k < nj; ++k)
                 {
-                    col[nnz] = this->mat_.col[aj];
-                    val[nnz] = this->mat_.val[aj];
-                    ++nnz;
+                    cast_out->vec_[(j + k) * ldout + ai] = sum[k];
                 }
             }
-
-            row_offset[ai + 1] = nnz;
         }
 
-        cast_L->Clear();
-        cast_L->SetDataPtrCSR(&row_offset, &col, &val, nnz_L, this->nrow_, this->ncol_);
-
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::LUSolve(const BaseVector<ValueType>& in,
-                                           BaseVector<ValueType>*       out) const
+    bool HostMatrixCSR<ValueType>::ApplyAddMulti(int                          ncol,
+                                                 const BaseVector<ValueType>& in,
+                                                 ValueType                    scalar,
+                                                 BaseVector<ValueType>*       out) const
     {
-        assert(in.GetSize() >= 0);
-        assert(out->GetSize() >= 0);
-        assert(in.GetSize() == this->ncol_);
-        assert(out->GetSize() == this->nrow_);
+        assert(ncol >= 0);
+        assert(in.GetSize() == static_cast<int64_t>(this->ncol_) * ncol);
+        assert(out->GetSize() == static_cast<int64_t>(this->nrow_) * ncol);
 
         const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
         HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
@@ -1174,3066 +1792,7435 @@ namespace rocalution
         assert(cast_in != NULL);
         assert(cast_out != NULL);
 
-        // Solve L
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        const int tile = 8;
+
+        int64_t ldin  = this->ncol_;
+        int64_t ldout = this->nrow_;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        for(int j = 0; j < ncol; j += tile)
         {
-            cast_out->vec_[ai] = cast_in->vec_[ai];
+            int nj = std::min(tile, ncol - j);
 
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int ai = 0; ai < this->nrow_; ++ai)
             {
-                if(this->mat_.col[aj] < ai)
+                PtrType   row_beg = this->mat_.row_offset[ai];
+                PtrType   row_end = this->mat_.row_offset[ai + 1];
+                ValueType sum[tile];
+
+                for(int k = 0; k < nj; ++k)
                 {
-                    // under the diagonal
-                    cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
-                }
-                else
-                {
-                    // CSR should be sorted
-                    break;
+                    sum[k] = static_cast<ValueType>(0);
                 }
-            }
-        }
 
-        // last elements should be the diagonal one (last)
-        int64_t diag_aj = this->nnz_ - 1;
-
-        // Solve U
-        for(int ai = this->nrow_ - 1; ai >= 0; --ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                if(this->mat_.col[aj] > ai)
+                for(PtrType aj = row_beg; aj < row_end; ++aj)
                 {
-                    // above the diagonal
-                    cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+                    ValueType        val = this->mat_.val[aj];
+                    const ValueType* x   = cast_in->vec_ + j * ldin + this->mat_.col[aj];
+
+                    for(int k = 0; k < nj; ++k)
+                    {
+                        sum[k] += val * x[k * ldin];
+                    }
                 }
 
-                if(this->mat_.col[aj] == ai)
+                for(int k = 0; k < nj; ++k)
                 {
-                    diag_aj = aj;
+                    cast_out->vec_[(j + k) * ldout + ai] += scalar * sum[k];
                 }
             }
-
-            cast_out->vec_[ai] /= this->mat_.val[diag_aj];
         }
 
         return true;
     }
 
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::LLAnalyse(void)
-    {
-        // do nothing
-    }
-
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::LLAnalyseClear(void)
-    {
-        // do nothing
-    }
-
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::LUAnalyse(void)
-    {
-        // do nothing
-    }
-
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::LUAnalyseClear(void)
-    {
-        // do nothing
-    }
-
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
-                                           BaseVector<ValueType>*       out) const
+    bool HostMatrixCSR<ValueType>::ApplyRows(const BaseVector<ValueType>& in,
+                                             const BaseVector<int>&       rows,
+                                             BaseVector<ValueType>*       out) const
     {
-        assert(in.GetSize() >= 0);
-        assert(out->GetSize() >= 0);
         assert(in.GetSize() == this->ncol_);
         assert(out->GetSize() == this->nrow_);
 
-        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+        const HostVector<ValueType>* cast_in   = dynamic_cast<const HostVector<ValueType>*>(&in);
+        const HostVector<int>*       cast_rows = dynamic_cast<const HostVector<int>*>(&rows);
+        HostVector<ValueType>*       cast_out  = dynamic_cast<HostVector<ValueType>*>(out);
 
         assert(cast_in != NULL);
+        assert(cast_rows != NULL);
         assert(cast_out != NULL);
 
-        // Solve L
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            ValueType value    = cast_in->vec_[ai];
-            PtrType   diag_idx = this->mat_.row_offset[ai + 1] - 1;
-
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
-            {
-                value -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
-            }
+        int nrows = static_cast<int>(cast_rows->size_);
 
-            cast_out->vec_[ai] = value / this->mat_.val[diag_idx];
-        }
+        _set_omp_backend_threads(this->local_backend_, nrows);
 
-        // Solve L^T
-        for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < nrows; ++i)
         {
-            PtrType   diag_idx = this->mat_.row_offset[ai + 1] - 1;
-            ValueType value    = cast_out->vec_[ai] / this->mat_.val[diag_idx];
+            int       ai  = cast_rows->vec_[i];
+            ValueType sum = static_cast<ValueType>(0);
 
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                cast_out->vec_[this->mat_.col[aj]] -= value * this->mat_.val[aj];
+                sum += this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
             }
 
-            cast_out->vec_[ai] = value;
+            cast_out->vec_[ai] = sum;
         }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
-                                           const BaseVector<ValueType>& inv_diag,
-                                           BaseVector<ValueType>*       out) const
+    bool HostMatrixCSR<ValueType>::ApplyAddRows(const BaseVector<ValueType>& in,
+                                                const BaseVector<int>&       rows,
+                                                ValueType                    scalar,
+                                                BaseVector<ValueType>*       out) const
     {
-        assert(in.GetSize() >= 0);
-        assert(out->GetSize() >= 0);
         assert(in.GetSize() == this->ncol_);
         assert(out->GetSize() == this->nrow_);
-        assert(inv_diag.GetSize() == this->nrow_ || inv_diag.GetSize() == this->ncol_);
 
-        const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
-        const HostVector<ValueType>* cast_diag
-            = dynamic_cast<const HostVector<ValueType>*>(&inv_diag);
-        HostVector<ValueType>* cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+        const HostVector<ValueType>* cast_in   = dynamic_cast<const HostVector<ValueType>*>(&in);
+        const HostVector<int>*       cast_rows = dynamic_cast<const HostVector<int>*>(&rows);
+        HostVector<ValueType>*       cast_out  = dynamic_cast<HostVector<ValueType>*>(out);
 
         assert(cast_in != NULL);
+        assert(cast_rows != NULL);
         assert(cast_out != NULL);
 
-        // Solve L
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            ValueType value    = cast_in->vec_[ai];
-            PtrType   diag_idx = this->mat_.row_offset[ai + 1] - 1;
-
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
-            {
-                value -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
-            }
+        int nrows = static_cast<int>(cast_rows->size_);
 
-            cast_out->vec_[ai] = value * cast_diag->vec_[ai];
-        }
+        _set_omp_backend_threads(this->local_backend_, nrows);
 
-        // Solve L^T
-        for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < nrows; ++i)
         {
-            PtrType   diag_idx = this->mat_.row_offset[ai + 1] - 1;
-            ValueType value    = cast_out->vec_[ai] * cast_diag->vec_[ai];
+            int       ai  = cast_rows->vec_[i];
+            ValueType sum = static_cast<ValueType>(0);
 
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                cast_out->vec_[this->mat_.col[aj]] -= value * this->mat_.val[aj];
+                sum += this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
             }
 
-            cast_out->vec_[ai] = value;
+            cast_out->vec_[ai] += scalar * sum;
         }
 
         return true;
     }
 
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::LAnalyse(bool diag_unit)
-    {
-        this->L_diag_unit_ = diag_unit;
-    }
-
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::LAnalyseClear(void)
+    bool HostMatrixCSR<ValueType>::ResidualRows(const BaseVector<ValueType>& rhs,
+                                                const BaseVector<ValueType>& x,
+                                                const BaseVector<int>&       rows,
+                                                BaseVector<ValueType>*       res) const
     {
-        // do nothing
-        this->L_diag_unit_ = true;
-    }
+        assert(rhs.GetSize() == this->nrow_);
+        assert(x.GetSize() == this->ncol_);
+        assert(res->GetSize() == this->nrow_);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::LSolve(const BaseVector<ValueType>& in,
-                                          BaseVector<ValueType>*       out) const
-    {
-        assert(in.GetSize() >= 0);
-        assert(out->GetSize() >= 0);
-        assert(in.GetSize() == this->ncol_);
-        assert(out->GetSize() == this->nrow_);
+        const HostVector<ValueType>* cast_rhs  = dynamic_cast<const HostVector<ValueType>*>(&rhs);
+        const HostVector<ValueType>* cast_x    = dynamic_cast<const HostVector<ValueType>*>(&x);
+        const HostVector<int>*       cast_rows = dynamic_cast<const HostVector<int>*>(&rows);
+        HostVector<ValueType>*       cast_res  = dynamic_cast<HostVector<ValueType>*>(res);
 
-        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+        assert(cast_rhs != NULL);
+        assert(cast_x != NULL);
+        assert(cast_rows != NULL);
+        assert(cast_res != NULL);
 
-        assert(cast_in != NULL);
-        assert(cast_out != NULL);
+        int nrows = static_cast<int>(cast_rows->size_);
 
-        PtrType diag_aj = 0;
+        _set_omp_backend_threads(this->local_backend_, nrows);
 
-        // Solve L
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        // Product and subtraction are fused, such that A*x is never stored
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < nrows; ++i)
         {
-            cast_out->vec_[ai] = cast_in->vec_[ai];
+            int       ai  = cast_rows->vec_[i];
+            ValueType sum = cast_rhs->vec_[ai];
 
             for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                if(this->mat_.col[aj] < ai)
-                {
-                    // under the diagonal
-                    cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
-                }
-                else
-                {
-                    // CSR should be sorted
-                    if(this->L_diag_unit_ == false)
-                    {
-                        assert(this->mat_.col[aj] == ai);
-                        diag_aj = aj;
-                    }
-                    break;
-                }
+                sum -= this->mat_.val[aj] * cast_x->vec_[this->mat_.col[aj]];
             }
 
-            if(this->L_diag_unit_ == false)
-            {
-                cast_out->vec_[ai] /= this->mat_.val[diag_aj];
-            }
+            cast_res->vec_[ai] = sum;
         }
 
         return true;
     }
 
+    // Kernels for batches of small systems that share a sparsity pattern. Each system is
+    // processed by a single thread, so that all vectors of a system stay in its cache.
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::UAnalyse(bool diag_unit)
+    static inline void host_batch_csr_spmv(int              n,
+                                           const PtrType*   row_offset,
+                                           const int*       col,
+                                           const ValueType* val,
+                                           const ValueType* x,
+                                           ValueType*       y)
     {
-        this->U_diag_unit_ = diag_unit;
+        for(int i = 0; i < n; ++i)
+        {
+            ValueType sum = static_cast<ValueType>(0);
+
+            for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                sum += val[j] * x[col[j]];
+            }
+
+            y[i] = sum;
+        }
     }
 
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::UAnalyseClear(void)
+    static inline ValueType host_batch_dot(int n, const ValueType* x, const ValueType* y)
     {
-        // do nothing
-        this->U_diag_unit_ = false;
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(int i = 0; i < n; ++i)
+        {
+            sum += rocalution_conj(x[i]) * y[i];
+        }
+
+        return sum;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::USolve(const BaseVector<ValueType>& in,
-                                          BaseVector<ValueType>*       out) const
+    static inline double host_batch_norm(int n, const ValueType* x)
     {
-        assert(in.GetSize() >= 0);
-        assert(out->GetSize() >= 0);
-        assert(in.GetSize() == this->ncol_);
-        assert(out->GetSize() == this->nrow_);
+        return std::sqrt(static_cast<double>(std::abs(host_batch_dot(n, x, x))));
+    }
 
-        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+    // Offsets of the diagonal entries, returns false if a diagonal entry is missing
+    static bool
+        host_batch_diag_offset(int n, const PtrType* row_offset, const int* col, PtrType* diag)
+    {
+        for(int i = 0; i < n; ++i)
+        {
+            PtrType j = row_offset[i];
 
-        assert(cast_in != NULL);
-        assert(cast_out != NULL);
+            while(j < row_offset[i + 1] && col[j] < i)
+            {
+                ++j;
+            }
 
-        // last elements should the diagonal one (last)
-        int64_t diag_aj = this->nnz_ - 1;
+            if(j == row_offset[i + 1] || col[j] != i)
+            {
+                return false;
+            }
 
-        // Solve U
-        for(int ai = this->nrow_ - 1; ai >= 0; --ai)
-        {
-            cast_out->vec_[ai] = cast_in->vec_[ai];
+            diag[i] = j;
+        }
 
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        return true;
+    }
+
+    // out = M^-1 in with M either Jacobi (inv_diag), ILU(0) (lu) or the identity
+    template <typename ValueType>
+    static inline void host_batch_precond(int              n,
+                                          const PtrType*   row_offset,
+                                          const int*       col,
+                                          const PtrType*   diag,
+                                          const ValueType* inv_diag,
+                                          const ValueType* lu,
+                                          const ValueType* in,
+                                          ValueType*       out)
+    {
+        if(inv_diag != NULL)
+        {
+            for(int i = 0; i < n; ++i)
             {
-                if(this->mat_.col[aj] > ai)
+                out[i] = inv_diag[i] * in[i];
+            }
+        }
+        else if(lu != NULL)
+        {
+            // Forward substitution with the unit lower triangular part
+            for(int i = 0; i < n; ++i)
+            {
+                ValueType sum = in[i];
+
+                for(PtrType j = row_offset[i]; j < diag[i]; ++j)
                 {
-                    // above the diagonal
-                    cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+                    sum -= lu[j] * out[col[j]];
                 }
 
-                if(this->U_diag_unit_ == false)
+                out[i] = sum;
+            }
+
+            // Backward substitution with the upper triangular part
+            for(int i = n - 1; i >= 0; --i)
+            {
+                ValueType sum = out[i];
+
+                for(PtrType j = diag[i] + 1; j < row_offset[i + 1]; ++j)
                 {
-                    if(this->mat_.col[aj] == ai)
-                    {
-                        diag_aj = aj;
-                    }
+                    sum -= lu[j] * out[col[j]];
                 }
-            }
 
-            if(this->U_diag_unit_ == false)
+                out[i] = sum / lu[diag[i]];
+            }
+        }
+        else
+        {
+            for(int i = 0; i < n; ++i)
             {
-                cast_out->vec_[ai] /= this->mat_.val[diag_aj];
+                out[i] = in[i];
             }
         }
-
-        return true;
     }
 
+    // Apply the rotation (c, s) to (dx, dy)
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::ItLUAnalyse(void)
+    static inline void host_batch_rotate(ValueType c, ValueType s, ValueType& dx, ValueType& dy)
     {
-        assert(this->ncol_ == this->nrow_);
-        assert(this->tmp_vec_ == NULL);
-
-        this->tmp_vec_ = new HostVector<ValueType>(this->local_backend_);
+        ValueType tmp = dx;
 
-        assert(this->tmp_vec_ != NULL);
+        dx = c * dx + s * dy;
+        dy = -rocalution_conj(s) * tmp + c * dy;
+    }
 
-        // Status
-        bool status;
+    // Generate the rotation (c, s) with real c, that annihilates dy
+    template <typename ValueType>
+    static inline void host_batch_givens(ValueType dx, ValueType dy, ValueType& c, ValueType& s)
+    {
+        double ax = static_cast<double>(std::abs(dx));
+        double ay = static_cast<double>(std::abs(dy));
 
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
+        if(ay == 0.0)
+        {
+            c = static_cast<ValueType>(1);
+            s = static_cast<ValueType>(0);
+        }
+        else if(ax == 0.0)
+        {
+            c = static_cast<ValueType>(0);
+            s = rocalution_conj(dy) / static_cast<ValueType>(ay);
+        }
+        else
+        {
+            double r = std::sqrt(ax * ax + ay * ay);
 
-        // Create buffer, if not already available
-        size_t buffer_size   = 0;
-        size_t L_buffer_size = 0;
-        size_t U_buffer_size = 0;
+            c = static_cast<ValueType>(ax / r);
+            s = dx / static_cast<ValueType>(ax) * rocalution_conj(dy) / static_cast<ValueType>(r);
+        }
+    }
 
-        status = host_csritsv_buffer_size(host_sparse_operation_none,
-                                          this->nrow_,
-                                          static_cast<PtrType>(this->nnz_),
-                                          host_sparse_fill_mode_lower,
-                                          host_sparse_diag_type_unit,
-                                          host_sparse_matrix_type_general,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          &L_buffer_size);
+    // Right preconditioned BiCGStab for a single system, work holds 7 * n values
+    template <typename ValueType>
+    static void host_batch_bicgstab(int              n,
+                                    const PtrType*   row_offset,
+                                    const int*       col,
+                                    const PtrType*   diag,
+                                    const ValueType* val,
+                                    const ValueType* inv_diag,
+                                    const ValueType* lu,
+                                    const ValueType* b,
+                                    ValueType*       x,
+                                    ValueType*       work,
+                                    double           abs_tol,
+                                    double           rel_tol,
+                                    int              max_iter,
+                                    int*             iter,
+                                    double*          res)
+    {
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
 
-        if(!status)
-        {
-            LOG_INFO("ItLUAnalyse() failed");
-            FATAL_ERROR(__FILE__, __LINE__);
-        }
+        ValueType* r  = work;
+        ValueType* r0 = work + n;
+        ValueType* p  = work + 2 * n;
+        ValueType* v  = work + 3 * n;
+        ValueType* ph = work + 4 * n;
+        ValueType* sh = work + 5 * n;
+        ValueType* t  = work + 6 * n;
 
-        status = host_csritsv_buffer_size(host_sparse_operation_none,
-                                          this->nrow_,
-                                          static_cast<PtrType>(this->nnz_),
-                                          host_sparse_fill_mode_upper,
-                                          host_sparse_diag_type_non_unit,
-                                          host_sparse_matrix_type_general,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          &U_buffer_size);
+        // r = r0 = b - Ax
+        host_batch_csr_spmv(n, row_offset, col, val, x, r);
 
-        if(!status)
+        for(int i = 0; i < n; ++i)
         {
-            LOG_INFO("ItLUAnalyse() failed");
-            FATAL_ERROR(__FILE__, __LINE__);
+            r[i]  = b[i] - r[i];
+            r0[i] = r[i];
+            p[i]  = zero;
+            v[i]  = zero;
         }
 
-        buffer_size = std::max(L_buffer_size, U_buffer_size);
+        double res0 = host_batch_norm(n, r);
+        double nrm  = res0;
+        int    k    = 0;
 
-        // Check buffer size
-        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
-        {
-            free_host(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
-        }
+        ValueType rho_old = one;
+        ValueType alpha   = one;
+        ValueType omega   = one;
 
-        if(this->mat_buffer_ == NULL)
+        while(k < max_iter && nrm > abs_tol && nrm > rel_tol * res0)
         {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_host(buffer_size, &this->mat_buffer_);
-        }
+            ++k;
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
+            ValueType rho = host_batch_dot(n, r0, r);
 
-        // Allocate temporary vector
-        this->tmp_vec_->Allocate(this->nrow_);
-    }
+            if(rho == zero)
+            {
+                break;
+            }
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::ItLUAnalyseClear(void)
-    {
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
-        {
-            free_host(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
-        }
+            ValueType beta = (rho / rho_old) * (alpha / omega);
 
-        this->mat_buffer_size_ = 0;
+            // p = r + beta * (p - omega * v)
+            for(int i = 0; i < n; ++i)
+            {
+                p[i] = r[i] + beta * (p[i] - omega * v[i]);
+            }
 
-        // Clear temporary vector
-        if(this->tmp_vec_ != NULL)
-        {
-            delete this->tmp_vec_;
-            this->tmp_vec_ = NULL;
-        }
-    }
+            // v = A M^-1 p
+            host_batch_precond(n, row_offset, col, diag, inv_diag, lu, p, ph);
+            host_batch_csr_spmv(n, row_offset, col, val, ph, v);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ItLUSolve(int                          max_iter,
-                                             double                       tolerance,
-                                             bool                         use_tol,
-                                             const BaseVector<ValueType>& in,
-                                             BaseVector<ValueType>*       out) const
-    {
-        if(this->nnz_ > 0)
-        {
-            assert(out != NULL);
-            assert(this->ncol_ == this->nrow_);
-            assert(in.GetSize() == this->ncol_);
-            assert(out->GetSize() == this->nrow_);
+            ValueType r0v = host_batch_dot(n, r0, v);
 
-            assert(this->tmp_vec_ != NULL);
+            if(r0v == zero)
+            {
+                break;
+            }
 
-            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+            alpha = rho / r0v;
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
+            // s = r - alpha * v, stored in r
+            for(int i = 0; i < n; ++i)
+            {
+                r[i] -= alpha * v[i];
+            }
 
-            bool status;
+            nrm = host_batch_norm(n, r);
 
-            int                               zero_pivot;
-            const ValueType                   alpha = static_cast<ValueType>(1);
-            const numeric_traits_t<ValueType> temp_tol
-                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+            if(nrm <= abs_tol || nrm <= rel_tol * res0)
+            {
+                for(int i = 0; i < n; ++i)
+                {
+                    x[i] += alpha * ph[i];
+                }
 
-            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+                break;
+            }
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+            // t = A M^-1 s
+            host_batch_precond(n, row_offset, col, diag, inv_diag, lu, r, sh);
+            host_batch_csr_spmv(n, row_offset, col, val, sh, t);
 
-            // Solve L
-            status = host_csritsv_solve(&max_iter,
-                                        tol_ptr,
-                                        nullptr,
-                                        host_sparse_operation_none,
-                                        this->nrow_,
-                                        static_cast<PtrType>(this->nnz_),
-                                        &alpha,
-                                        host_sparse_fill_mode_lower,
-                                        host_sparse_diag_type_unit,
-                                        host_sparse_matrix_type_general,
-                                        this->mat_.val,
-                                        this->mat_.row_offset,
-                                        this->mat_.col,
-                                        cast_in->vec_,
-                                        this->tmp_vec_->vec_,
-                                        this->mat_buffer_,
-                                        &zero_pivot);
+            ValueType tt = host_batch_dot(n, t, t);
 
-            if(!status)
+            omega = (tt == zero) ? zero : host_batch_dot(n, t, r) / tt;
+
+            // x = x + alpha * p + omega * s, r = s - omega * t
+            for(int i = 0; i < n; ++i)
             {
-                LOG_INFO("ItLUSolve() failed to solve L");
-                FATAL_ERROR(__FILE__, __LINE__);
+                x[i] += alpha * ph[i] + omega * sh[i];
+                r[i] -= omega * t[i];
             }
 
-            // Solve U
-            status = host_csritsv_solve(&max_iter,
-                                        tol_ptr,
-                                        nullptr,
-                                        host_sparse_operation_none,
-                                        this->nrow_,
-                                        static_cast<PtrType>(this->nnz_),
-                                        &alpha,
-                                        host_sparse_fill_mode_upper,
-                                        host_sparse_diag_type_non_unit,
-                                        host_sparse_matrix_type_general,
-                                        this->mat_.val,
-                                        this->mat_.row_offset,
-                                        this->mat_.col,
-                                        this->tmp_vec_->vec_,
-                                        cast_out->vec_,
-                                        this->mat_buffer_,
-                                        &zero_pivot);
+            nrm     = host_batch_norm(n, r);
+            rho_old = rho;
 
-            if(!status)
+            if(omega == zero)
             {
-                LOG_INFO("ItLUSolve() failed to solve U");
-                FATAL_ERROR(__FILE__, __LINE__);
+                break;
             }
         }
 
-        return true;
+        *iter = k;
+        *res  = nrm;
     }
 
+    // Right preconditioned GMRES(m) for a single system, work holds
+    // (m + 2) * n + (m + 1) * m + 3 * m + 1 values
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::ItLLAnalyse(void)
+    static void host_batch_gmres(int              n,
+                                 int              m,
+                                 const PtrType*   row_offset,
+                                 const int*       col,
+                                 const PtrType*   diag,
+                                 const ValueType* val,
+                                 const ValueType* inv_diag,
+                                 const ValueType* lu,
+                                 const ValueType* b,
+                                 ValueType*       x,
+                                 ValueType*       work,
+                                 double           abs_tol,
+                                 double           rel_tol,
+                                 int              max_iter,
+                                 int*             iter,
+                                 double*          res)
     {
-        assert(this->ncol_ == this->nrow_);
-        assert(this->tmp_vec_ == NULL);
-
-        this->tmp_vec_ = new HostVector<ValueType>(this->local_backend_);
-
-        assert(this->tmp_vec_ != NULL);
-
-        // Status
-        bool status;
-
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
+        ValueType zero = static_cast<ValueType>(0);
 
-        // Create buffer, if not already available
-        size_t buffer_size    = 0;
-        size_t L_buffer_size  = 0;
-        size_t Lt_buffer_size = 0;
+        // Krylov basis, column-major Hessenberg matrix, rotations and right-hand side of
+        // the least squares problem
+        ValueType* V = work;
+        ValueType* z = V + (m + 1) * n;
+        ValueType* H = z + n;
+        ValueType* c = H + (m + 1) * m;
+        ValueType* s = c + m;
+        ValueType* g = s + m;
 
-        status = host_csritsv_buffer_size(host_sparse_operation_none,
-                                          this->nrow_,
-                                          static_cast<PtrType>(this->nnz_),
-                                          host_sparse_fill_mode_lower,
-                                          host_sparse_diag_type_non_unit,
-                                          host_sparse_matrix_type_general,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          &L_buffer_size);
+        // r = b - Ax
+        host_batch_csr_spmv(n, row_offset, col, val, x, V);
 
-        if(!status)
+        for(int i = 0; i < n; ++i)
         {
-            LOG_INFO("ItLLAnalyse() failed");
-            FATAL_ERROR(__FILE__, __LINE__);
+            V[i] = b[i] - V[i];
         }
 
-        status = host_csritsv_buffer_size(host_sparse_operation_transpose,
-                                          this->nrow_,
-                                          static_cast<PtrType>(this->nnz_),
-                                          host_sparse_fill_mode_lower,
-                                          host_sparse_diag_type_non_unit,
-                                          host_sparse_matrix_type_general,
-                                          this->mat_.val,
-                                          this->mat_.row_offset,
-                                          this->mat_.col,
-                                          &Lt_buffer_size);
+        double res0 = host_batch_norm(n, V);
+        double nrm  = res0;
+        int    k    = 0;
 
-        if(!status)
+        while(k < max_iter && nrm > abs_tol && nrm > rel_tol * res0)
         {
-            LOG_INFO("ItLLAnalyse() failed");
-            FATAL_ERROR(__FILE__, __LINE__);
-        }
+            ValueType scale = static_cast<ValueType>(1.0 / nrm);
 
-        buffer_size = std::max(L_buffer_size, Lt_buffer_size);
+            for(int i = 0; i < n; ++i)
+            {
+                V[i] *= scale;
+            }
 
-        // Check buffer size
-        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
-        {
-            free_host(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
-        }
+            g[0] = static_cast<ValueType>(nrm);
 
-        if(this->mat_buffer_ == NULL)
-        {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_host(buffer_size, &this->mat_buffer_);
-        }
+            for(int i = 1; i <= m; ++i)
+            {
+                g[i] = zero;
+            }
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
+            int j = 0;
 
-        // Allocate temporary vector
-        this->tmp_vec_->Allocate(this->nrow_);
-    }
+            while(j < m && k < max_iter)
+            {
+                ValueType* w = V + (j + 1) * n;
+                ValueType* h = H + j * (m + 1);
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::ItLLAnalyseClear(void)
-    {
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
-        {
-            free_host(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
-        }
+                // w = A M^-1 v_j
+                host_batch_precond(n, row_offset, col, diag, inv_diag, lu, V + j * n, z);
+                host_batch_csr_spmv(n, row_offset, col, val, z, w);
 
-        this->mat_buffer_size_ = 0;
+                // Modified Gram-Schmidt
+                for(int i = 0; i <= j; ++i)
+                {
+                    h[i] = host_batch_dot(n, V + i * n, w);
 
-        // Clear temporary vector
-        if(this->tmp_vec_ != NULL)
-        {
-            delete this->tmp_vec_;
-            this->tmp_vec_ = NULL;
-        }
-    }
+                    for(int l = 0; l < n; ++l)
+                    {
+                        w[l] -= h[i] * V[i * n + l];
+                    }
+                }
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ItLLSolve(int                          max_iter,
-                                             double                       tolerance,
-                                             bool                         use_tol,
-                                             const BaseVector<ValueType>& in,
-                                             BaseVector<ValueType>*       out) const
-    {
-        if(this->nnz_ > 0)
-        {
-            assert(out != NULL);
-            assert(this->ncol_ == this->nrow_);
-            assert(in.GetSize() == this->ncol_);
-            assert(out->GetSize() == this->nrow_);
+                double hn = host_batch_norm(n, w);
 
-            assert(this->tmp_vec_ != NULL);
+                h[j + 1] = static_cast<ValueType>(hn);
 
-            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+                if(hn != 0.0)
+                {
+                    scale = static_cast<ValueType>(1.0 / hn);
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
+                    for(int l = 0; l < n; ++l)
+                    {
+                        w[l] *= scale;
+                    }
+                }
 
-            bool status;
+                // Apply the previous rotations to the new column and eliminate h_(j+1)j
+                for(int i = 0; i < j; ++i)
+                {
+                    host_batch_rotate(c[i], s[i], h[i], h[i + 1]);
+                }
 
-            int                               zero_pivot;
-            const ValueType                   alpha = static_cast<ValueType>(1);
-            const numeric_traits_t<ValueType> temp_tol
-                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+                host_batch_givens(h[j], h[j + 1], c[j], s[j]);
+                host_batch_rotate(c[j], s[j], h[j], h[j + 1]);
+                host_batch_rotate(c[j], s[j], g[j], g[j + 1]);
 
-            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+                ++j;
+                ++k;
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+                nrm = static_cast<double>(std::abs(g[j]));
 
-            // Solve L
-            status = host_csritsv_solve(&max_iter,
-                                        tol_ptr,
-                                        nullptr,
-                                        host_sparse_operation_none,
-                                        this->nrow_,
-                                        static_cast<PtrType>(this->nnz_),
-                                        &alpha,
-                                        host_sparse_fill_mode_lower,
-                                        host_sparse_diag_type_non_unit,
-                                        host_sparse_matrix_type_general,
-                                        this->mat_.val,
-                                        this->mat_.row_offset,
-                                        this->mat_.col,
-                                        cast_in->vec_,
-                                        this->tmp_vec_->vec_,
-                                        this->mat_buffer_,
-                                        &zero_pivot);
+                if(nrm <= abs_tol || nrm <= rel_tol * res0 || hn == 0.0)
+                {
+                    break;
+                }
+            }
 
-            if(!status)
+            // Solve the upper triangular system H y = g, y is stored in g
+            for(int i = j - 1; i >= 0; --i)
             {
-                LOG_INFO("ItLLSolve() failed");
-                FATAL_ERROR(__FILE__, __LINE__);
+                for(int l = i + 1; l < j; ++l)
+                {
+                    g[i] -= H[i + l * (m + 1)] * g[l];
+                }
+
+                g[i] /= H[i + i * (m + 1)];
             }
 
-            // Solve Lt
-            status = host_csritsv_solve(&max_iter,
-                                        tol_ptr,
-                                        nullptr,
-                                        host_sparse_operation_transpose,
-                                        this->nrow_,
-                                        static_cast<PtrType>(this->nnz_),
-                                        &alpha,
-                                        host_sparse_fill_mode_lower,
-                                        host_sparse_diag_type_non_unit,
-                                        host_sparse_matrix_type_general,
-                                        this->mat_.val,
-                                        this->mat_.row_offset,
-                                        this->mat_.col,
-                                        this->tmp_vec_->vec_,
-                                        cast_out->vec_,
-                                        this->mat_buffer_,
-                                        &zero_pivot);
+            // x = x + M^-1 V y, the last basis vector is not needed anymore
+            for(int l = 0; l < n; ++l)
+            {
+                z[l] = zero;
+            }
 
-            if(!status)
+            for(int i = 0; i < j; ++i)
             {
-                LOG_INFO("ItLLSolve() failed");
-                FATAL_ERROR(__FILE__, __LINE__);
+                for(int l = 0; l < n; ++l)
+                {
+                    z[l] += g[i] * V[i * n + l];
+                }
+            }
+
+            host_batch_precond(n, row_offset, col, diag, inv_diag, lu, z, V + m * n);
+
+            for(int l = 0; l < n; ++l)
+            {
+                x[l] += V[m * n + l];
+            }
+
+            // True residual for the restart
+            host_batch_csr_spmv(n, row_offset, col, val, x, V);
+
+            for(int i = 0; i < n; ++i)
+            {
+                V[i] = b[i] - V[i];
             }
+
+            nrm = host_batch_norm(n, V);
         }
 
-        return true;
+        *iter = k;
+        *res  = nrm;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ItLLSolve(int                          max_iter,
-                                             double                       tolerance,
-                                             bool                         use_tol,
-                                             const BaseVector<ValueType>& in,
-                                             const BaseVector<ValueType>& inv_diag,
-                                             BaseVector<ValueType>*       out) const
+    bool HostMatrixCSR<ValueType>::BatchApply(int                          batch,
+                                              const BaseVector<ValueType>& val,
+                                              const BaseVector<ValueType>& in,
+                                              BaseVector<ValueType>*       out) const
     {
-        return ItLLSolve(max_iter, tolerance, use_tol, in, out);
+        assert(batch >= 0);
+        assert(this->nrow_ == this->ncol_);
+        assert(val.GetSize() == this->nnz_ * batch);
+        assert(in.GetSize() == static_cast<int64_t>(this->nrow_) * batch);
+        assert(out->GetSize() == static_cast<int64_t>(this->nrow_) * batch);
+
+        const HostVector<ValueType>* cast_val = dynamic_cast<const HostVector<ValueType>*>(&val);
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_val != NULL);
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        int     n   = this->nrow_;
+        int64_t nnz = this->nnz_;
+
+        _set_omp_backend_threads(this->local_backend_, nnz * batch);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int k = 0; k < batch; ++k)
+        {
+            host_batch_csr_spmv(n,
+                                this->mat_.row_offset,
+                                this->mat_.col,
+                                cast_val->vec_ + k * nnz,
+                                cast_in->vec_ + static_cast<int64_t>(k) * n,
+                                cast_out->vec_ + static_cast<int64_t>(k) * n);
+        }
+
+        return true;
     }
 
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::ItLAnalyse(bool diag_unit)
+    bool HostMatrixCSR<ValueType>::BatchExtractInverseDiagonal(
+        int batch, const BaseVector<ValueType>& val, BaseVector<ValueType>* inv_diag) const
     {
-        assert(this->ncol_ == this->nrow_);
-
-        // Status
-        bool status;
+        assert(batch >= 0);
+        assert(this->nrow_ == this->ncol_);
+        assert(val.GetSize() == this->nnz_ * batch);
+        assert(inv_diag->GetSize() == static_cast<int64_t>(this->nrow_) * batch);
 
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
+        const HostVector<ValueType>* cast_val = dynamic_cast<const HostVector<ValueType>*>(&val);
+        HostVector<ValueType>*       cast_inv = dynamic_cast<HostVector<ValueType>*>(inv_diag);
 
-        this->L_diag_unit_ = diag_unit;
+        assert(cast_val != NULL);
+        assert(cast_inv != NULL);
 
-        // Create buffer, if not already available
-        size_t buffer_size = 0;
+        int     n   = this->nrow_;
+        int64_t nnz = this->nnz_;
 
-        status = host_csritsv_buffer_size(
-            host_sparse_operation_none,
-            this->nrow_,
-            static_cast<PtrType>(this->nnz_),
-            host_sparse_fill_mode_lower,
-            (this->L_diag_unit_ ? host_sparse_diag_type_unit : host_sparse_diag_type_non_unit),
-            host_sparse_matrix_type_general,
-            this->mat_.val,
-            this->mat_.row_offset,
-            this->mat_.col,
-            &buffer_size);
+        PtrType* diag = NULL;
+        allocate_host(n, &diag);
 
-        if(!status)
+        if(host_batch_diag_offset(n, this->mat_.row_offset, this->mat_.col, diag) == false)
         {
-            LOG_INFO("ItLAnalyse() failed");
-            FATAL_ERROR(__FILE__, __LINE__);
+            free_host(&diag);
+            return false;
         }
 
-        // Check buffer size
-        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        bool detect_zero_diag = false;
+
+        _set_omp_backend_threads(this->local_backend_, n * batch);
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(|| : detect_zero_diag)
+#endif
+        for(int k = 0; k < batch; ++k)
         {
-            free_host(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            const ValueType* v   = cast_val->vec_ + k * nnz;
+            ValueType*       inv = cast_inv->vec_ + static_cast<int64_t>(k) * n;
+
+            for(int i = 0; i < n; ++i)
+            {
+                if(v[diag[i]] == static_cast<ValueType>(0))
+                {
+                    inv[i]           = static_cast<ValueType>(1);
+                    detect_zero_diag = true;
+                }
+                else
+                {
+                    inv[i] = static_cast<ValueType>(1) / v[diag[i]];
+                }
+            }
         }
 
-        if(this->mat_buffer_ == NULL)
+        if(detect_zero_diag == true)
         {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_host(buffer_size, &this->mat_buffer_);
+            LOG_VERBOSE_INFO(
+                2,
+                "*** warning: in HostMatrixCSR::BatchExtractInverseDiagonal() a zero has been "
+                "detected on the diagonal. It has been replaced with one to avoid inf");
         }
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
+        free_host(&diag);
+
+        return true;
     }
 
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::ItLAnalyseClear(void)
+    bool HostMatrixCSR<ValueType>::BatchILU0Factorize(int batch, BaseVector<ValueType>* val) const
     {
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
+        assert(batch >= 0);
+        assert(this->nrow_ == this->ncol_);
+        assert(val->GetSize() == this->nnz_ * batch);
+
+        HostVector<ValueType>* cast_val = dynamic_cast<HostVector<ValueType>*>(val);
+
+        assert(cast_val != NULL);
+
+        int            n          = this->nrow_;
+        int64_t        nnz        = this->nnz_;
+        const PtrType* row_offset = this->mat_.row_offset;
+        const int*     col        = this->mat_.col;
+
+        PtrType* diag = NULL;
+        allocate_host(n, &diag);
+
+        if(host_batch_diag_offset(n, row_offset, col, diag) == false)
         {
-            free_host(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            free_host(&diag);
+            return false;
         }
 
-        this->mat_buffer_size_ = 0;
-    }
+        _set_omp_backend_threads(this->local_backend_, nnz * batch);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ItLSolve(int                          max_iter,
-                                            double                       tolerance,
-                                            bool                         use_tol,
-                                            const BaseVector<ValueType>& in,
-                                            BaseVector<ValueType>*       out) const
-    {
-        if(this->nnz_ > 0)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
         {
-            assert(out != NULL);
-            assert(this->ncol_ == this->nrow_);
-            assert(in.GetSize() == this->ncol_);
-            assert(out->GetSize() == this->nrow_);
-
-            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+            // Position of each column in the current row, -1 if not present
+            std::vector<PtrType> nnz_entries(n, -1);
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int k = 0; k < batch; ++k)
+            {
+                ValueType* v = cast_val->vec_ + k * nnz;
 
-            bool status;
+                for(int i = 0; i < n; ++i)
+                {
+                    for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                    {
+                        nnz_entries[col[j]] = j;
+                    }
 
-            int                               zero_pivot;
-            const ValueType                   alpha = static_cast<ValueType>(1);
-            const numeric_traits_t<ValueType> temp_tol
-                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+                    // Eliminate the lower part of row i
+                    for(PtrType j = row_offset[i]; j < diag[i]; ++j)
+                    {
+                        PtrType diag_j = diag[col[j]];
 
-            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+                        if(v[diag_j] != static_cast<ValueType>(0))
+                        {
+                            v[j] /= v[diag_j];
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+                            for(PtrType l = diag_j + 1; l < row_offset[col[j] + 1]; ++l)
+                            {
+                                PtrType pos = nnz_entries[col[l]];
 
-            // Solve L
-            status = host_csritsv_solve(
-                &max_iter,
-                tol_ptr,
-                nullptr,
-                host_sparse_operation_none,
-                this->nrow_,
-                static_cast<PtrType>(this->nnz_),
-                &alpha,
-                host_sparse_fill_mode_lower,
-                (this->L_diag_unit_ ? host_sparse_diag_type_unit : host_sparse_diag_type_non_unit),
-                host_sparse_matrix_type_general,
-                this->mat_.val,
-                this->mat_.row_offset,
-                this->mat_.col,
-                cast_in->vec_,
-                cast_out->vec_,
-                this->mat_buffer_,
-                &zero_pivot);
+                                if(pos != -1)
+                                {
+                                    v[pos] -= v[j] * v[l];
+                                }
+                            }
+                        }
+                    }
 
-            if(!status)
-            {
-                LOG_INFO("ItLSolve() failed");
-                FATAL_ERROR(__FILE__, __LINE__);
+                    for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                    {
+                        nnz_entries[col[j]] = -1;
+                    }
+                }
             }
         }
 
+        free_host(&diag);
+
         return true;
     }
 
     template <typename ValueType>
-    void HostMatrixCSR<ValueType>::ItUAnalyse(bool diag_unit)
+    bool HostMatrixCSR<ValueType>::BatchBiCGStab(int                          batch,
+                                                 const BaseVector<ValueType>& val,
+                                                 const BaseVector<ValueType>* inv_diag,
+                                                 const BaseVector<ValueType>* lu,
+                                                 const BaseVector<ValueType>& rhs,
+                                                 BaseVector<ValueType>*       x,
+                                                 double                       abs_tol,
+                                                 double                       rel_tol,
+                                                 int                          max_iter,
+                                                 int*                         iter,
+                                                 double*                      res) const
     {
-        assert(this->ncol_ == this->nrow_);
-
-        // Status
-        bool status;
+        return this->BatchSolve_(
+            batch, 0, val, inv_diag, lu, rhs, x, abs_tol, rel_tol, max_iter, iter, res);
+    }
 
-        assert(this->nnz_ <= std::numeric_limits<int>::max());
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::BatchGMRES(int                          batch,
+                                              int                          basis,
+                                              const BaseVector<ValueType>& val,
+                                              const BaseVector<ValueType>* inv_diag,
+                                              const BaseVector<ValueType>* lu,
+                                              const BaseVector<ValueType>& rhs,
+                                              BaseVector<ValueType>*       x,
+                                              double                       abs_tol,
+                                              double                       rel_tol,
+                                              int                          max_iter,
+                                              int*                         iter,
+                                              double*                      res) const
+    {
+        assert(basis > 0);
 
-        this->U_diag_unit_ = diag_unit;
+        return this->BatchSolve_(
+            batch, basis, val, inv_diag, lu, rhs, x, abs_tol, rel_tol, max_iter, iter, res);
+    }
 
-        // Create buffer, if not already available
-        size_t buffer_size = 0;
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::BatchSolve_(int                          batch,
+                                               int                          basis,
+                                               const BaseVector<ValueType>& val,
+                                               const BaseVector<ValueType>* inv_diag,
+                                               const BaseVector<ValueType>* lu,
+                                               const BaseVector<ValueType>& rhs,
+                                               BaseVector<ValueType>*       x,
+                                               double                       abs_tol,
+                                               double                       rel_tol,
+                                               int                          max_iter,
+                                               int*                         iter,
+                                               double*                      res) const
+    {
+        assert(batch >= 0);
+        assert(this->nrow_ == this->ncol_);
+        assert(val.GetSize() == this->nnz_ * batch);
+        assert(rhs.GetSize() == static_cast<int64_t>(this->nrow_) * batch);
+        assert(x->GetSize() == static_cast<int64_t>(this->nrow_) * batch);
+        assert(iter != NULL);
+        assert(res != NULL);
 
-        status = host_csritsv_buffer_size(
-            host_sparse_operation_none,
-            this->nrow_,
-            static_cast<PtrType>(this->nnz_),
-            host_sparse_fill_mode_upper,
-            (this->U_diag_unit_ ? host_sparse_diag_type_unit : host_sparse_diag_type_non_unit),
-            host_sparse_matrix_type_general,
-            this->mat_.val,
-            this->mat_.row_offset,
-            this->mat_.col,
-            &buffer_size);
+        const HostVector<ValueType>* cast_val = dynamic_cast<const HostVector<ValueType>*>(&val);
+        const HostVector<ValueType>* cast_rhs = dynamic_cast<const HostVector<ValueType>*>(&rhs);
+        HostVector<ValueType>*       cast_x   = dynamic_cast<HostVector<ValueType>*>(x);
 
-        if(!status)
-        {
-            LOG_INFO("ItUAnalyse() failed");
-            FATAL_ERROR(__FILE__, __LINE__);
-        }
+        assert(cast_val != NULL);
+        assert(cast_rhs != NULL);
+        assert(cast_x != NULL);
 
-        // Check buffer size
-        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        const HostVector<ValueType>* cast_inv = NULL;
+        const HostVector<ValueType>* cast_lu  = NULL;
+
+        if(inv_diag != NULL)
         {
-            free_host(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            cast_inv = dynamic_cast<const HostVector<ValueType>*>(inv_diag);
+            assert(cast_inv != NULL);
+            assert(cast_inv->size_ == static_cast<int64_t>(this->nrow_) * batch);
         }
-
-        if(this->mat_buffer_ == NULL)
+        else if(lu != NULL)
         {
-            this->mat_buffer_size_ = buffer_size;
-            allocate_host(buffer_size, &this->mat_buffer_);
+            cast_lu = dynamic_cast<const HostVector<ValueType>*>(lu);
+            assert(cast_lu != NULL);
+            assert(cast_lu->size_ == this->nnz_ * batch);
         }
 
-        assert(this->mat_buffer_size_ >= buffer_size);
-        assert(this->mat_buffer_ != NULL);
-    }
+        int     n   = this->nrow_;
+        int64_t nnz = this->nnz_;
 
-    template <typename ValueType>
-    void HostMatrixCSR<ValueType>::ItUAnalyseClear(void)
-    {
-        // Clear buffer
-        if(this->mat_buffer_ != NULL)
+        PtrType* diag = NULL;
+
+        if(cast_lu != NULL)
         {
-            free_host(&this->mat_buffer_);
-            this->mat_buffer_ = NULL;
+            allocate_host(n, &diag);
+
+            if(host_batch_diag_offset(n, this->mat_.row_offset, this->mat_.col, diag) == false)
+            {
+                free_host(&diag);
+                return false;
+            }
         }
 
-        this->mat_buffer_size_ = 0;
-    }
+        // Workspace of a single system, see host_batch_bicgstab() and host_batch_gmres()
+        int64_t wsize
+            = (basis == 0) ? 7 * n : (basis + 2) * n + (basis + 1) * basis + 3 * basis + 1;
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ItUSolve(int                          max_iter,
-                                            double                       tolerance,
-                                            bool                         use_tol,
-                                            const BaseVector<ValueType>& in,
-                                            BaseVector<ValueType>*       out) const
-    {
-        if(this->nnz_ > 0)
+        _set_omp_backend_threads(this->local_backend_, nnz * batch);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
         {
-            assert(out != NULL);
-            assert(this->ncol_ == this->nrow_);
-            assert(in.GetSize() == this->ncol_);
-            assert(out->GetSize() == this->nrow_);
+            ValueType* work = NULL;
+            allocate_host(wsize, &work);
 
-            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
-            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for(int k = 0; k < batch; ++k)
+            {
+                int64_t voff = static_cast<int64_t>(k) * n;
 
-            assert(cast_in != NULL);
-            assert(cast_out != NULL);
+                const ValueType* inv = (cast_inv != NULL) ? cast_inv->vec_ + voff : NULL;
+                const ValueType* fac = (cast_lu != NULL) ? cast_lu->vec_ + k * nnz : NULL;
 
-            bool status;
+                if(basis == 0)
+                {
+                    host_batch_bicgstab(n,
+                                        this->mat_.row_offset,
+                                        this->mat_.col,
+                                        diag,
+                                        cast_val->vec_ + k * nnz,
+                                        inv,
+                                        fac,
+                                        cast_rhs->vec_ + voff,
+                                        cast_x->vec_ + voff,
+                                        work,
+                                        abs_tol,
+                                        rel_tol,
+                                        max_iter,
+                                        iter + k,
+                                        res + k);
+                }
+                else
+                {
+                    host_batch_gmres(n,
+                                     basis,
+                                     this->mat_.row_offset,
+                                     this->mat_.col,
+                                     diag,
+                                     cast_val->vec_ + k * nnz,
+                                     inv,
+                                     fac,
+                                     cast_rhs->vec_ + voff,
+                                     cast_x->vec_ + voff,
+                                     work,
+                                     abs_tol,
+                                     rel_tol,
+                                     max_iter,
+                                     iter + k,
+                                     res + k);
+                }
+            }
 
-            int                               zero_pivot;
-            const ValueType                   alpha = static_cast<ValueType>(1);
-            const numeric_traits_t<ValueType> temp_tol
-                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+            free_host(&work);
+        }
 
-            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+        free_host(&diag);
 
-            assert(this->nnz_ <= std::numeric_limits<int>::max());
+        return true;
+    }
 
-            // Solve U
-            status = host_csritsv_solve(
-                &max_iter,
-                tol_ptr,
-                nullptr,
-                host_sparse_operation_none,
-                this->nrow_,
-                static_cast<PtrType>(this->nnz_),
-                &alpha,
-                host_sparse_fill_mode_upper,
-                (this->U_diag_unit_ ? host_sparse_diag_type_unit : host_sparse_diag_type_non_unit),
-                host_sparse_matrix_type_general,
-                this->mat_.val,
-                this->mat_.row_offset,
-                this->mat_.col,
-                cast_in->vec_,
-                cast_out->vec_,
-                this->mat_buffer_,
-                &zero_pivot);
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ExtractDiagonal(BaseVector<ValueType>* vec_diag) const
+    {
+        assert(vec_diag != NULL);
+        assert(vec_diag->GetSize() >= this->nrow_);
 
-            if(!status)
+        HostVector<ValueType>* cast_vec_diag = dynamic_cast<HostVector<ValueType>*>(vec_diag);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                LOG_INFO("ItUSolve() failed");
-                FATAL_ERROR(__FILE__, __LINE__);
+                if(ai == this->mat_.col[aj])
+                {
+                    cast_vec_diag->vec_[ai] = this->mat_.val[aj];
+                    break;
+                }
             }
         }
 
         return true;
     }
 
-    // Algorithm for ILU factorization is based on
-    // Y. Saad, Iterative methods for sparse linear systems, 2nd edition, SIAM
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ILU0Factorize(void)
+    bool HostMatrixCSR<ValueType>::ExtractInverseDiagonal(BaseVector<ValueType>* vec_inv_diag) const
     {
-        assert(this->nrow_ == this->ncol_);
-        assert(this->nnz_ > 0);
+        assert(vec_inv_diag != NULL);
+        assert(vec_inv_diag->GetSize() == this->nrow_);
 
-        // pointer of upper part of each row
-        PtrType* diag_offset = NULL;
-        PtrType* nnz_entries = NULL;
+        HostVector<ValueType>* cast_vec_inv_diag
+            = dynamic_cast<HostVector<ValueType>*>(vec_inv_diag);
 
-        allocate_host(this->nrow_, &diag_offset);
-        allocate_host(this->nrow_, &nnz_entries);
+        int detect_zero_diag = 0;
 
-        set_to_zero_host(this->nrow_, nnz_entries);
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-        // ai = 0 to N loop over all rows
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            // ai-th row entries
-            PtrType row_start = this->mat_.row_offset[ai];
-            PtrType row_end   = this->mat_.row_offset[ai + 1];
-            PtrType j;
-
-            // nnz position of ai-th row in mat_.val array
-            for(j = row_start; j < row_end; ++j)
-            {
-                nnz_entries[this->mat_.col[j]] = j;
-            }
-
-            // loop over ai-th row nnz entries
-            for(j = row_start; j < row_end; ++j)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                // if nnz entry is in lower matrix
-                if(this->mat_.col[j] < ai)
+                if(ai == this->mat_.col[aj])
                 {
-                    int     col_j  = this->mat_.col[j];
-                    PtrType diag_j = diag_offset[col_j];
-
-                    if(this->mat_.val[diag_j] != static_cast<ValueType>(0))
+                    if(this->mat_.val[aj] != static_cast<ValueType>(0))
                     {
-                        // multiplication factor
-                        this->mat_.val[j] = this->mat_.val[j] / this->mat_.val[diag_j];
-
-                        // loop over upper offset pointer and do linear combination for nnz entry
-                        for(PtrType k = diag_j + 1; k < this->mat_.row_offset[col_j + 1]; ++k)
-                        {
-                            // if nnz at this position do linear combination
-                            if(nnz_entries[this->mat_.col[k]] != 0)
-                            {
-                                this->mat_.val[nnz_entries[this->mat_.col[k]]]
-                                    -= this->mat_.val[j] * this->mat_.val[k];
-                            }
-                        }
+                        cast_vec_inv_diag->vec_[ai]
+                            = static_cast<ValueType>(1) / this->mat_.val[aj];
                     }
-                }
-                else
-                {
+                    else
+                    {
+                        cast_vec_inv_diag->vec_[ai] = static_cast<ValueType>(1);
+                        detect_zero_diag            = 1;
+                    }
+
                     break;
                 }
             }
-
-            // set diagonal pointer to diagonal element
-            diag_offset[ai] = j;
-
-            // clear nnz entries
-            for(j = row_start; j < row_end; ++j)
-            {
-                nnz_entries[this->mat_.col[j]] = 0;
-            }
         }
 
-        free_host(&diag_offset);
-        free_host(&nnz_entries);
-
+        if(detect_zero_diag == 1)
+        {
+            LOG_VERBOSE_INFO(
+                2,
+                "*** warning: in HostMatrixCSR::ExtractInverseDiagonal() a zero has been detected "
+                "on the diagonal. It has been replaced with one to avoid inf");
+        }
         return true;
     }
 
-    // Algorithm for ILUT factorization is based on
-    // Y. Saad, Iterative methods for sparse linear systems, 2nd edition, SIAM
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ILUTFactorize(double t, int maxrow)
+    bool HostMatrixCSR<ValueType>::ExtractInverseBlockDiagonal(
+        int blockdim, BaseMatrix<ValueType>* inv_diag) const
     {
+        assert(inv_diag != NULL);
+        assert(blockdim > 0);
+        assert(this->nrow_ > 0);
         assert(this->nrow_ == this->ncol_);
-        assert(this->nnz_ > 0);
+        assert(this->nrow_ % blockdim == 0);
 
-        int nrow = this->nrow_;
-        int ncol = this->ncol_;
+        HostMatrixCSR<ValueType>* cast_inv = dynamic_cast<HostMatrixCSR<ValueType>*>(inv_diag);
 
-        int64_t nnz = std::min(2 * maxrow, nrow) * nrow;
+        assert(cast_inv != NULL);
 
-        int remaining_nnz = nnz;
+        int     nrowb = this->nrow_ / blockdim;
+        int64_t nnz   = static_cast<int64_t>(this->nrow_) * blockdim;
 
         PtrType*   row_offset = NULL;
         int*       col        = NULL;
         ValueType* val        = NULL;
 
-        allocate_host(nrow + 1, &row_offset);
+        allocate_host(this->nrow_ + 1, &row_offset);
         allocate_host(nnz, &col);
         allocate_host(nnz, &val);
 
-        void*    buffer            = NULL;
-        PtrType* temp_pivot_buffer = NULL;
+        int detect_zero_pivot = 0;
 
-        ILUTDriverCSR<ValueType, int> driver(nrow, nrow);
+        _set_omp_backend_threads(this->local_backend_, nrowb);
 
-        buffer = (void*)malloc(driver.buffer_size());
-        driver.set_buffer(buffer);
+#ifdef _OPENMP
+#pragma omp parallel for reduction(max : detect_zero_pivot)
+#endif
+        for(int bi = 0; bi < nrowb; ++bi)
+        {
+            int        r0 = bi * blockdim;
+            ValueType* A  = val + static_cast<int64_t>(r0) * blockdim;
 
-        allocate_host(nrow, &temp_pivot_buffer);
-        memset(temp_pivot_buffer, 0, sizeof(PtrType) * nrow);
+            // Gather the dense diagonal block (row major)
+            for(int i = 0; i < blockdim; ++i)
+            {
+                int ai = r0 + i;
 
-        // initialize row ptr B
-        row_offset[0] = 0;
+                row_offset[ai + 1] = static_cast<PtrType>(ai + 1) * blockdim;
 
-        // for each row
-        for(int i = 0; i < nrow; i++)
-        {
-            PtrType row_begin = mat_.row_offset[i];
-            PtrType row_end   = mat_.row_offset[i + 1];
-            PtrType row_size  = row_end - row_begin;
+                for(int j = 0; j < blockdim; ++j)
+                {
+                    col[ai * blockdim + j] = r0 + j;
+                    A[i * blockdim + j]    = static_cast<ValueType>(0);
+                }
 
-            // Initialize working structure
-            driver.initialize(&mat_.val[row_begin], &mat_.col[row_begin], row_size, 0, i);
+                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
+                    ++aj)
+                {
+                    int j = this->mat_.col[aj] - r0;
 
-            ValueType k_val;
-            int       k_col;
-
-            // for each column in row i under the diagonal
-            while(driver.next_lower(k_col, k_val))
-            {
-                //find the index of element k, k in the upper matrix
-                PtrType pivot_index;
-                if((pivot_index = temp_pivot_buffer[k_col]) <= 0)
-                {
-                    // zero pivot
-                    continue;
+                    if(j >= 0 && j < blockdim)
+                    {
+                        A[i * blockdim + j] = this->mat_.val[aj];
+                    }
                 }
-                pivot_index--;
+            }
 
-                // get the coefficient to perform row(i) = row(i) - factor * row(k)
-                // factor = a(i, k) / a(k, k)
-                ValueType factor = static_cast<ValueType>(1) / val[pivot_index];
+            // In-place Gauss-Jordan inversion with partial pivoting
+            std::vector<int> pivot(blockdim);
 
-                factor = factor * k_val;
+            for(int k = 0; k < blockdim; ++k)
+            {
+                int p = k;
 
-                if(std::abs(factor) > std::abs(t))
+                for(int i = k + 1; i < blockdim; ++i)
                 {
-                    // put pivot in lower matrix; put in a(i, k)
-                    driver.save_lower(factor);
-
-                    // subtract row(k) from row(i); perform row(i) = row(i) - pivot * row(k)
-                    // for each non-zero element in row k after column k
-                    for(PtrType subtrahend_index = pivot_index + 1;
-                        subtrahend_index < row_offset[k_col + 1];
-                        subtrahend_index++)
+                    if(std::abs(A[i * blockdim + k]) > std::abs(A[p * blockdim + k]))
                     {
-                        // a(i, j) = a(i, j) - pivot * a(k, j)
-                        int       column     = col[subtrahend_index];
-                        ValueType val_to_add = -factor * val[subtrahend_index];
-
-                        driver.add_to_element(column, val_to_add);
+                        p = i;
                     }
                 }
-            }
-
-            // filter elements
-            driver.trim(t, maxrow);
 
-            // store elements
-            int store_size = driver.row_size();
+                pivot[k] = p;
 
-            if(remaining_nnz < store_size)
-            {
-                nnz += static_cast<size_t>(nnz * 1.5f);
-                remaining_nnz += static_cast<size_t>(nnz * 1.5f);
+                if(p != k)
+                {
+                    for(int j = 0; j < blockdim; ++j)
+                    {
+                        std::swap(A[k * blockdim + j], A[p * blockdim + j]);
+                    }
+                }
 
-                LOG_INFO("ILUTFactorize reallocating");
+                if(A[k * blockdim + k] == static_cast<ValueType>(0))
+                {
+                    A[k * blockdim + k] = static_cast<ValueType>(1);
+                    detect_zero_pivot   = 1;
+                }
 
-                int*       col_tmp = (int*)realloc(col, nnz * sizeof(int));
-                ValueType* val_tmp = (ValueType*)realloc(val, nnz * sizeof(ValueType));
+                ValueType d         = static_cast<ValueType>(1) / A[k * blockdim + k];
+                A[k * blockdim + k] = static_cast<ValueType>(1);
 
-                if(col_tmp == NULL || val_tmp == NULL)
+                for(int j = 0; j < blockdim; ++j)
                 {
-                    free(col);
-                    free(val);
-
-                    LOG_INFO("ILUTFactorize failed on realloc");
-                    FATAL_ERROR(__FILE__, __LINE__);
+                    A[k * blockdim + j] *= d;
                 }
-                else
+
+                for(int i = 0; i < blockdim; ++i)
                 {
-                    col = col_tmp;
-                    val = val_tmp;
+                    if(i != k)
+                    {
+                        ValueType f         = A[i * blockdim + k];
+                        A[i * blockdim + k] = static_cast<ValueType>(0);
+
+                        for(int j = 0; j < blockdim; ++j)
+                        {
+                            A[i * blockdim + j] -= f * A[k * blockdim + j];
+                        }
+                    }
                 }
             }
 
-            int diag_in;
-            if(driver.store_row(&val[row_offset[i]], &col[row_offset[i]], diag_in))
-            {
-                temp_pivot_buffer[i] = row_offset[i] + diag_in + 1;
-            }
-            else
+            // Undo the row interchanges as column interchanges in reverse order
+            for(int k = blockdim - 1; k >= 0; --k)
             {
-                LOG_INFO("(ILUT) zero row");
+                if(pivot[k] != k)
+                {
+                    for(int i = 0; i < blockdim; ++i)
+                    {
+                        std::swap(A[i * blockdim + k], A[i * blockdim + pivot[k]]);
+                    }
+                }
             }
+        }
 
-            row_offset[i + 1] = row_offset[i] + store_size;
-            remaining_nnz -= store_size;
+        row_offset[0] = 0;
+
+        if(detect_zero_pivot == 1)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: in HostMatrixCSR::ExtractInverseBlockDiagonal() a "
+                             "singular diagonal block has been detected. Its zero pivots have been "
+                             "replaced with one to avoid inf");
         }
 
-        free(buffer);
-        free(temp_pivot_buffer);
+        cast_inv->Clear();
+        cast_inv->SetDataPtrCSR(&row_offset, &col, &val, nnz, this->nrow_, this->ncol_);
 
-        // pinned memory
-        int*       p_col = NULL;
-        ValueType* p_val = NULL;
+        return true;
+    }
 
-        nnz = row_offset[nrow];
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ExtractRowL1Norm(BaseVector<ValueType>* vec_l1) const
+    {
+        assert(vec_l1 != NULL);
+        assert(vec_l1->GetSize() == this->nrow_);
 
-        allocate_host(nnz, &p_col);
-        allocate_host(nnz, &p_val);
+        HostVector<ValueType>* cast_vec_l1 = dynamic_cast<HostVector<ValueType>*>(vec_l1);
 
-        copy_h2h(nnz, col, p_col);
-        copy_h2h(nnz, val, p_val);
+        assert(cast_vec_l1 != NULL);
 
-        free(col);
-        free(val);
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-        this->Clear();
-        this->SetDataPtrCSR(&row_offset, &p_col, &p_val, nnz, nrow, ncol);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            ValueType sum = static_cast<ValueType>(0);
 
-        this->Sort();
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                sum += std::abs(this->mat_.val[aj]);
+            }
+
+            cast_vec_l1->vec_[ai] = sum;
+        }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ItILU0Factorize(ItILU0Algorithm alg,
-                                                   int             option,
-                                                   int             max_iter,
-                                                   double          tolerance,
-                                                   int*            niter,
-                                                   double*         history)
+    bool HostMatrixCSR<ValueType>::ExtractConnectedRows(const BaseVector<bool>& cols,
+                                                        BaseVector<bool>*       rows) const
     {
-        // On host, we fall back to default ILU0
-        return this->ILU0Factorize();
-    }
+        assert(rows != NULL);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ICFactorize(BaseVector<ValueType>* inv_diag)
-    {
-        assert(this->nrow_ == this->ncol_);
-        assert(this->nnz_ > 0);
+        const HostVector<bool>* cast_cols = dynamic_cast<const HostVector<bool>*>(&cols);
+        HostVector<bool>*       cast_rows = dynamic_cast<HostVector<bool>*>(rows);
 
-        assert(inv_diag != NULL);
-        HostVector<ValueType>* cast_diag = dynamic_cast<HostVector<ValueType>*>(inv_diag);
-        assert(cast_diag != NULL);
+        assert(cast_cols != NULL);
+        assert(cast_rows != NULL);
+        assert(cast_cols->size_ == this->ncol_);
+        assert(cast_rows->size_ == this->nrow_);
 
-        cast_diag->Allocate(this->nrow_);
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-        PtrType* diag_offset = NULL;
-        PtrType* nnz_entries = NULL;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            bool connected = false;
 
-        allocate_host(this->nrow_, &diag_offset);
-        allocate_host(this->nrow_, &nnz_entries);
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(cast_cols->vec_[this->mat_.col[aj]] == true)
+                {
+                    connected = true;
+                    break;
+                }
+            }
 
-        set_to_zero_host(this->nrow_, nnz_entries);
+            cast_rows->vec_[ai] = connected;
+        }
 
-        // i=0,..n
-        for(int i = 0; i < this->nrow_; ++i)
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Statistics(MatrixStatistics* stats) const
+    {
+        assert(stats != NULL);
+        assert(this->nrow_ > 0);
+
+        int64_t min_row    = std::numeric_limits<int64_t>::max();
+        int64_t max_row    = 0;
+        int64_t sum_row2   = 0;
+        int64_t bandwidth  = 0;
+        int64_t profile    = 0;
+        int64_t dominant   = 0;
+        int64_t asymmetric = (this->nrow_ == this->ncol_) ? 0 : 1;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(min : min_row) reduction(max : max_row, bandwidth) \
+    reduction(+ : sum_row2, profile, dominant, asymmetric)
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            PtrType row_begin = this->mat_.row_offset[i];
-            PtrType row_end   = this->mat_.row_offset[i + 1];
+            PtrType row_begin = this->mat_.row_offset[ai];
+            PtrType row_end   = this->mat_.row_offset[ai + 1];
+            int64_t length    = row_end - row_begin;
 
-            for(PtrType j = row_begin; j < row_end; ++j)
+            min_row = std::min(min_row, length);
+            max_row = std::max(max_row, length);
+            sum_row2 += length * length;
+
+            if(length == 0)
             {
-                nnz_entries[this->mat_.col[j]] = j;
+                continue;
             }
 
-            ValueType sum = static_cast<ValueType>(0);
+            // Columns are sorted, the first and the last entry bound the row
+            int first = this->mat_.col[row_begin];
+            int last  = this->mat_.col[row_end - 1];
 
-            bool has_diag = false;
+            bandwidth = std::max(bandwidth, static_cast<int64_t>(std::max(ai - first, last - ai)));
+            profile += std::max(ai - first, 0);
 
-            // j=0,..i
-            PtrType j;
-            for(j = row_begin; j < row_end; ++j)
-            {
-                int       col_j = this->mat_.col[j];
-                ValueType val_j = this->mat_.val[j];
+            double diag    = 0.0;
+            double offdiag = 0.0;
 
-                // Mark diagonal and skip row
-                if(col_j == i)
-                {
-                    has_diag = true;
-                    break;
-                }
+            for(PtrType aj = row_begin; aj < row_end; ++aj)
+            {
+                int col = this->mat_.col[aj];
 
-                // Skip upper triangular
-                if(col_j > i)
+                if(col == ai)
                 {
-                    break;
+                    diag += std::abs(this->mat_.val[aj]);
                 }
-
-                PtrType row_begin_j = this->mat_.row_offset[col_j];
-                PtrType row_diag_j  = diag_offset[col_j];
-
-                ValueType local_sum = static_cast<ValueType>(0);
-                ValueType inv_diag  = this->mat_.val[row_diag_j];
-
-                // Check for numeric zero
-                if(inv_diag == static_cast<ValueType>(0))
+                else
                 {
-                    LOG_INFO("IC breakdown: division by zero");
-                    FATAL_ERROR(__FILE__, __LINE__);
+                    offdiag += std::abs(this->mat_.val[aj]);
                 }
 
-                inv_diag = static_cast<ValueType>(1) / inv_diag;
-
-                for(PtrType k = row_begin_j; k < row_diag_j; ++k)
+                // Look up a_ji in row j
+                if(this->nrow_ == this->ncol_)
                 {
-                    int col_k = this->mat_.col[k];
+                    const int* begin = this->mat_.col + this->mat_.row_offset[col];
+                    const int* end   = this->mat_.col + this->mat_.row_offset[col + 1];
+                    const int* pos   = std::lower_bound(begin, end, ai);
 
-                    if(nnz_entries[col_k] != 0)
+                    if(pos == end || *pos != ai
+                       || this->mat_.val[pos - this->mat_.col] != this->mat_.val[aj])
                     {
-                        PtrType idx = nnz_entries[col_k];
-                        local_sum += this->mat_.val[k] * this->mat_.val[idx];
+                        ++asymmetric;
                     }
                 }
-
-                val_j = (val_j - local_sum) * inv_diag;
-                sum += val_j * val_j;
-
-                this->mat_.val[j] = val_j;
-            }
-
-            if(!has_diag)
-            {
-                // Structural zero
-                LOG_INFO("IC breakdown: structural zero diagonal");
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
-
-            // Process diagonal entry
-            ValueType diag_entry = std::sqrt(std::abs(this->mat_.val[j] - sum));
-            this->mat_.val[j]    = diag_entry;
-
-            // Check for numerical zero
-            if(diag_entry == static_cast<ValueType>(0))
-            {
-                LOG_INFO("IC breakdown: division by zero");
-                FATAL_ERROR(__FILE__, __LINE__);
             }
 
-            // Store inverse diagonal entry
-            cast_diag->vec_[i] = static_cast<ValueType>(1) / diag_entry;
-
-            // Store diagonal offset
-            diag_offset[i] = j;
-
-            // Clear nnz entries
-            for(j = row_begin; j < row_end; ++j)
+            if(diag >= offdiag)
             {
-                nnz_entries[this->mat_.col[j]] = 0;
+                ++dominant;
             }
         }
 
-        // Free temporary storage
-        free_host(&diag_offset);
-        free_host(&nnz_entries);
+        double mean = static_cast<double>(this->nnz_) / this->nrow_;
+
+        stats->min_row        = min_row;
+        stats->max_row        = max_row;
+        stats->mean_row       = mean;
+        stats->var_row        = static_cast<double>(sum_row2) / this->nrow_ - mean * mean;
+        stats->bandwidth      = bandwidth;
+        stats->profile        = profile;
+        stats->diag_dominance = static_cast<double>(dominant) / this->nrow_;
+        stats->symmetric      = (asymmetric == 0);
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::MultiColoring(int&             num_colors,
-                                                 int**            size_colors,
-                                                 BaseVector<int>* permutation) const
+    bool HostMatrixCSR<ValueType>::ExtractSubMatrix(int                    row_offset,
+                                                    int                    col_offset,
+                                                    int                    row_size,
+                                                    int                    col_size,
+                                                    BaseMatrix<ValueType>* mat) const
     {
-        assert(*size_colors == NULL);
-        assert(permutation != NULL);
-        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-        assert(cast_perm != NULL);
-
-        /*
-        *   Create CSC
-        */
-        PtrType* csc_ptr = NULL;
-        int*     csc_ind = NULL;
-
-        allocate_host(this->ncol_ + 1, &csc_ptr);
-        allocate_host(this->nnz_, &csc_ind);
+        assert(mat != NULL);
 
-        set_to_zero_host(this->nrow_ + 1, csc_ptr);
+        assert(row_offset >= 0);
+        assert(col_offset >= 0);
 
-        for(PtrType i = 0; i < this->nnz_; ++i)
-        {
-            csc_ptr[this->mat_.col[i] + 1] += 1;
-        }
+        assert(this->nrow_ >= 0);
+        assert(this->ncol_ >= 0);
 
-        for(int i = 1; i < this->nrow_ + 1; ++i)
-        {
-            csc_ptr[i] += csc_ptr[i - 1];
-        }
+        HostMatrixCSR<ValueType>* cast_mat = dynamic_cast<HostMatrixCSR<ValueType>*>(mat);
+        assert(cast_mat != NULL);
 
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            for(PtrType k = this->mat_.row_offset[i]; k < this->mat_.row_offset[i + 1]; ++k)
-            {
-                csc_ind[csc_ptr[this->mat_.col[k]]++] = i;
-            }
-        }
-        for(int i = this->nrow_; i > 0; --i)
-        {
-            csc_ptr[i] = csc_ptr[i - 1];
-        }
-        csc_ptr[0] = 0;
+        int64_t mat_nnz = 0;
 
-        // node colors (init value = 0 i.e. no color)
-        int* color = NULL;
-        allocate_host(this->nrow_, &color);
+        // use omp in local_matrix (higher level)
 
-        memset(color, 0, sizeof(int) * this->nrow_);
-        num_colors = 0;
-        std::vector<bool> row_col;
+        //  _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        //#ifdef _OPENMP
+        //#pragma omp parallel for reduction(+:mat_nnz)
+        //#endif
+        for(int ai = row_offset; ai < row_offset + row_size; ++ai)
         {
-            color[ai] = 1;
-            row_col.clear();
-            row_col.reserve(num_colors + 2);
-            row_col.assign(num_colors + 2, false);
-
             for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                if(ai != this->mat_.col[aj])
+                if((this->mat_.col[aj] >= col_offset)
+                   && (this->mat_.col[aj] < col_offset + col_size))
                 {
-                    row_col[color[this->mat_.col[aj]]] = true;
+                    ++mat_nnz;
                 }
             }
+        }
 
-            for(PtrType aj = csc_ptr[ai]; aj < csc_ptr[ai + 1]; ++aj)
-            {
-                if(ai != csc_ind[aj])
-                {
-                    row_col[color[csc_ind[aj]]] = true;
-                }
-            }
+        cast_mat->AllocateCSR(mat_nnz, row_size, col_size);
 
-            PtrType count = this->mat_.row_offset[ai + 1] - this->mat_.row_offset[ai]
-                            + csc_ptr[ai + 1] - csc_ptr[ai];
+        // not empty submatrix
+        if(mat_nnz > 0)
+        {
+            PtrType mat_row_offset       = 0;
+            cast_mat->mat_.row_offset[0] = mat_row_offset;
 
-            for(PtrType aj = 0; aj < count; ++aj)
+            for(int ai = row_offset; ai < row_offset + row_size; ++ai)
             {
-                if(row_col[color[ai]] == true)
-                {
-                    ++color[ai];
-                }
-                else
+                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
+                    ++aj)
                 {
-                    break;
+                    if((this->mat_.col[aj] >= col_offset)
+                       && (this->mat_.col[aj] < col_offset + col_size))
+                    {
+                        cast_mat->mat_.col[mat_row_offset] = this->mat_.col[aj] - col_offset;
+                        cast_mat->mat_.val[mat_row_offset] = this->mat_.val[aj];
+                        ++mat_row_offset;
+                    }
                 }
-            }
 
-            if(color[ai] > num_colors)
-            {
-                num_colors = color[ai];
+                cast_mat->mat_.row_offset[ai - row_offset + 1] = mat_row_offset;
             }
-        }
-
-        free_host(&csc_ptr);
-        free_host(&csc_ind);
-
-        allocate_host(num_colors, size_colors);
-        set_to_zero_host(num_colors, *size_colors);
-
-        int* offsets_color = NULL;
-        allocate_host(num_colors, &offsets_color);
-        memset(offsets_color, 0, sizeof(int) * num_colors);
 
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            ++(*size_colors)[color[i] - 1];
-        }
-
-        int total = 0;
-        for(int i = 1; i < num_colors; ++i)
-        {
-            total += (*size_colors)[i - 1];
-            offsets_color[i] = total;
-            //   LOG_INFO("offsets = " << total);
-        }
-
-        cast_perm->Allocate(this->nrow_);
-
-        for(int i = 0; i < permutation->GetSize(); ++i)
-        {
-            cast_perm->vec_[i] = offsets_color[color[i] - 1];
-            ++offsets_color[color[i] - 1];
+            cast_mat->mat_.row_offset[row_size] = mat_row_offset;
+            assert(mat_row_offset == mat_nnz);
         }
 
-        free_host(&color);
-        free_host(&offsets_color);
-
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::MaximalIndependentSet(int&             size,
-                                                         BaseVector<int>* permutation) const
+    bool HostMatrixCSR<ValueType>::ExtractU(BaseMatrix<ValueType>* U) const
     {
-        assert(permutation != NULL);
-        assert(this->nrow_ == this->ncol_);
+        assert(U != NULL);
 
-        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-        assert(cast_perm != NULL);
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
 
-        int* mis = NULL;
-        allocate_host(this->nrow_, &mis);
-        memset(mis, 0, sizeof(int) * this->nrow_);
+        HostMatrixCSR<ValueType>* cast_U = dynamic_cast<HostMatrixCSR<ValueType>*>(U);
 
-        size = 0;
+        assert(cast_U != NULL);
 
+        // count nnz of upper triangular part
+        int64_t nnz_U = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nnz_U)
+#endif
         for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            if(mis[ai] == 0)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                // set the node
-                mis[ai] = 1;
-                ++size;
-
-                // remove all nbh nodes (without diagonal)
-                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
-                    ++aj)
+                if(this->mat_.col[aj] > ai)
                 {
-                    if(ai != this->mat_.col[aj])
-                    {
-                        mis[this->mat_.col[aj]] = -1;
-                    }
+                    ++nnz_U;
                 }
             }
         }
 
-        cast_perm->Allocate(this->nrow_);
+        // allocate upper triangular part structure
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
 
-        int pos = 0;
+        allocate_host(this->nrow_ + 1, &row_offset);
+        allocate_host(nnz_U, &col);
+        allocate_host(nnz_U, &val);
+
+        // fill upper triangular part
+        PtrType nnz   = 0;
+        row_offset[0] = 0;
         for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            if(mis[ai] == 1)
-            {
-                cast_perm->vec_[ai] = pos;
-                ++pos;
-            }
-            else
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                cast_perm->vec_[ai] = size + ai - pos;
+                if(this->mat_.col[aj] > ai)
+                {
+                    col[nnz] = this->mat_.col[aj];
+                    val[nnz] = this->mat_.val[aj];
+                    ++nnz;
+                }
             }
-        }
 
-        // Check the permutation
-        //
-        //  for (int ai=0; ai<this->nrow_; ++ai) {
-        //    assert( cast_perm->vec_[ai] >= 0 );
-        //    assert( cast_perm->vec_[ai] < this->nrow_ );
-        //  }
+            row_offset[ai + 1] = nnz;
+        }
 
-        free_host(&mis);
+        cast_U->Clear();
+        cast_U->SetDataPtrCSR(&row_offset, &col, &val, nnz_U, this->nrow_, this->ncol_);
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ZeroBlockPermutation(int&             size,
-                                                        BaseVector<int>* permutation) const
+    bool HostMatrixCSR<ValueType>::ExtractUDiagonal(BaseMatrix<ValueType>* U) const
     {
-        assert(permutation != NULL);
-        assert(permutation->GetSize() == this->nrow_);
-        assert(permutation->GetSize() == this->ncol_);
+        assert(U != NULL);
 
-        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-        assert(cast_perm != NULL);
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
 
-        size = 0;
+        HostMatrixCSR<ValueType>* cast_U = dynamic_cast<HostMatrixCSR<ValueType>*>(U);
 
+        assert(cast_U != NULL);
+
+        // count nnz of upper triangular part
+        int64_t nnz_U = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nnz_U)
+#endif
         for(int ai = 0; ai < this->nrow_; ++ai)
         {
             for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                if(ai == this->mat_.col[aj])
+                if(this->mat_.col[aj] >= ai)
                 {
-                    ++size;
+                    ++nnz_U;
                 }
             }
         }
 
-        int k_z  = size;
-        int k_nz = 0;
+        // allocate upper triangular part structure
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
+
+        allocate_host(this->nrow_ + 1, &row_offset);
+        allocate_host(nnz_U, &col);
+        allocate_host(nnz_U, &val);
 
+        // fill upper triangular part
+        PtrType nnz   = 0;
+        row_offset[0] = 0;
         for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            bool hit = false;
-
             for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                if(ai == this->mat_.col[aj])
+                if(this->mat_.col[aj] >= ai)
                 {
-                    cast_perm->vec_[ai] = k_nz;
-                    ++k_nz;
-                    hit = true;
-                }
+                    col[nnz] = this->mat_.col[aj];
+                    val[nnz] = this->mat_.val[aj];
+                    ++nnz;
+                }
             }
 
-            if(hit == false)
-            {
-                cast_perm->vec_[ai] = k_z;
-                ++k_z;
-            }
+            row_offset[ai + 1] = nnz;
         }
 
+        cast_U->Clear();
+        cast_U->SetDataPtrCSR(&row_offset, &col, &val, nnz_U, this->nrow_, this->ncol_);
+
         return true;
     }
 
-    // following R.E.Bank and C.C.Douglas paper
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::SymbolicMatMatMult(const BaseMatrix<ValueType>& src)
+    bool HostMatrixCSR<ValueType>::ExtractL(BaseMatrix<ValueType>* L) const
     {
-        const HostMatrixCSR<ValueType>* cast_mat
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&src);
-
-        assert(cast_mat != NULL);
-        assert(this->ncol_ == cast_mat->nrow_);
-
-        std::vector<PtrType> row_offset;
-        std::vector<int>*    new_col = new std::vector<int>[this->nrow_];
+        assert(L != NULL);
 
-        row_offset.resize(this->nrow_ + 1);
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
 
-        row_offset[0] = 0;
+        HostMatrixCSR<ValueType>* cast_L = dynamic_cast<HostMatrixCSR<ValueType>*>(L);
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        assert(cast_L != NULL);
 
+        // count nnz of lower triangular part
+        int64_t nnz_L = 0;
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for reduction(+ : nnz_L)
 #endif
-        for(int i = 0; i < this->nrow_; ++i)
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            // loop over the row
-            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                int ii = this->mat_.col[j];
-
-                // loop corresponding row
-                for(PtrType k = cast_mat->mat_.row_offset[ii];
-                    k < cast_mat->mat_.row_offset[ii + 1];
-                    ++k)
+                if(this->mat_.col[aj] < ai)
                 {
-                    new_col[i].push_back(cast_mat->mat_.col[k]);
+                    ++nnz_L;
                 }
             }
-
-            std::sort(new_col[i].begin(), new_col[i].end());
-            new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()), new_col[i].end());
-
-            row_offset[i + 1] = static_cast<PtrType>(new_col[i].size());
-        }
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            row_offset[i + 1] += row_offset[i];
         }
 
-        this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+        // allocate lower triangular part structure
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
 
-        copy_h2h(this->nrow_ + 1, row_offset.data(), this->mat_.row_offset);
+        allocate_host(this->nrow_ + 1, &row_offset);
+        allocate_host(nnz_L, &col);
+        allocate_host(nnz_L, &val);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int i = 0; i < this->nrow_; ++i)
+        // fill lower triangular part
+        PtrType nnz   = 0;
+        row_offset[0] = 0;
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            PtrType jj = 0;
-            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                this->mat_.col[j] = new_col[i][jj];
-                ++jj;
+                if(this->mat_.col[aj] < ai)
+                {
+                    col[nnz] = this->mat_.col[aj];
+                    val[nnz] = this->mat_.val[aj];
+                    ++nnz;
+                }
             }
-        }
 
-        //#ifdef _OPENMP
-        //#pragma omp parallel for
-        //#endif
-        //  for (int64_t i=0; i<this->nnz_; ++i)
-        //    this->mat_.val[i] = static_cast<ValueType>(1);
+            row_offset[ai + 1] = nnz;
+        }
 
-        delete[] new_col;
+        cast_L->Clear();
+        cast_L->SetDataPtrCSR(&row_offset, &col, &val, nnz_L, this->nrow_, this->ncol_);
 
         return true;
     }
 
-    // ----------------------------------------------------------
-    // original function prod(const spmat1 &A, const spmat2 &B)
-    // ----------------------------------------------------------
-    // Modified and adapted from AMGCL,
-    // https://github.com/ddemidov/amgcl
-    // MIT License
-    // ----------------------------------------------------------
-    // CHANGELOG
-    // - adapted interface
-    // sorting is added
-    // ----------------------------------------------------------
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::MatMatMult(const BaseMatrix<ValueType>& A,
-                                              const BaseMatrix<ValueType>& B)
+    bool HostMatrixCSR<ValueType>::ExtractLDiagonal(BaseMatrix<ValueType>* L) const
     {
-        assert((this != &A) && (this != &B));
-
-        //  this->SymbolicMatMatMult(A, B);
-        //  this->NumericMatMatMult (A, B);
-        //
-        //  return true;
-
-        const HostMatrixCSR<ValueType>* cast_mat_A
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
-        const HostMatrixCSR<ValueType>* cast_mat_B
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
-
-        assert(cast_mat_A != NULL);
-        assert(cast_mat_B != NULL);
-        assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
+        assert(L != NULL);
 
-        int n = cast_mat_A->nrow_;
-        int m = cast_mat_B->ncol_;
+        assert(this->nrow_ > 0);
+        assert(this->ncol_ > 0);
 
-        PtrType* row_offset = NULL;
-        allocate_host(n + 1, &row_offset);
-        int*       col = NULL;
-        ValueType* val = NULL;
+        HostMatrixCSR<ValueType>* cast_L = dynamic_cast<HostMatrixCSR<ValueType>*>(L);
 
-        set_to_zero_host(n + 1, row_offset);
+        assert(cast_L != NULL);
 
+        // count nnz of lower triangular part
+        int64_t nnz_L = 0;
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel for reduction(+ : nnz_L)
 #endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            std::vector<PtrType> marker(m, -1);
-
-#ifdef _OPENMP
-            int nt  = omp_get_num_threads();
-            int tid = omp_get_thread_num();
-
-            int chunk_size  = (n + nt - 1) / nt;
-            int chunk_start = tid * chunk_size;
-            int chunk_end   = std::min(n, chunk_start + chunk_size);
-#else
-            int chunk_start = 0;
-            int chunk_end   = n;
-#endif
-
-            for(int ia = chunk_start; ia < chunk_end; ++ia)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                for(PtrType ja = cast_mat_A->mat_.row_offset[ia],
-                            ea = cast_mat_A->mat_.row_offset[ia + 1];
-                    ja < ea;
-                    ++ja)
+                if(this->mat_.col[aj] <= ai)
                 {
-                    int ca = cast_mat_A->mat_.col[ja];
-                    for(PtrType jb = cast_mat_B->mat_.row_offset[ca],
-                                eb = cast_mat_B->mat_.row_offset[ca + 1];
-                        jb < eb;
-                        ++jb)
-                    {
-                        int cb = cast_mat_B->mat_.col[jb];
-
-                        if(marker[cb] != ia)
-                        {
-                            marker[cb] = ia;
-                            ++row_offset[ia + 1];
-                        }
-                    }
+                    ++nnz_L;
                 }
             }
+        }
 
-            std::fill(marker.begin(), marker.end(), -1);
-
-#ifdef _OPENMP
-#pragma omp barrier
-#endif
-#ifdef _OPENMP
-#pragma omp single
-#endif
-            {
-                for(int i = 1; i < n + 1; ++i)
-                {
-                    row_offset[i] += row_offset[i - 1];
-                }
+        // allocate lower triangular part structure
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
 
-                allocate_host(row_offset[n], &col);
-                allocate_host(row_offset[n], &val);
-            }
+        allocate_host(this->nrow_ + 1, &row_offset);
+        allocate_host(nnz_L, &col);
+        allocate_host(nnz_L, &val);
 
-            for(int ia = chunk_start; ia < chunk_end; ++ia)
+        // fill lower triangular part
+        PtrType nnz   = 0;
+        row_offset[0] = 0;
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                PtrType row_begin = row_offset[ia];
-                PtrType row_end   = row_begin;
-
-                for(PtrType ja = cast_mat_A->mat_.row_offset[ia],
-                            ea = cast_mat_A->mat_.row_offset[ia + 1];
-                    ja < ea;
-                    ++ja)
+                if(this->mat_.col[aj] <= ai)
                 {
-                    int       ca = cast_mat_A->mat_.col[ja];
-                    ValueType va = cast_mat_A->mat_.val[ja];
-
-                    for(PtrType jb = cast_mat_B->mat_.row_offset[ca],
-                                eb = cast_mat_B->mat_.row_offset[ca + 1];
-                        jb < eb;
-                        ++jb)
-                    {
-                        int       cb = cast_mat_B->mat_.col[jb];
-                        ValueType vb = cast_mat_B->mat_.val[jb];
-
-                        if(marker[cb] < row_begin)
-                        {
-                            marker[cb]   = row_end;
-                            col[row_end] = cb;
-                            val[row_end] = va * vb;
-                            ++row_end;
-                        }
-                        else
-                        {
-                            val[marker[cb]] += va * vb;
-                        }
-                    }
+                    col[nnz] = this->mat_.col[aj];
+                    val[nnz] = this->mat_.val[aj];
+                    ++nnz;
                 }
             }
-        }
 
-        this->SetDataPtrCSR(
-            &row_offset, &col, &val, row_offset[n], cast_mat_A->nrow_, cast_mat_B->ncol_);
+            row_offset[ai + 1] = nnz;
+        }
 
-        // Sorting the col (per row)
-        this->Sort();
+        cast_L->Clear();
+        cast_L->SetDataPtrCSR(&row_offset, &col, &val, nnz_L, this->nrow_, this->ncol_);
 
         return true;
     }
 
-    // following R.E.Bank and C.C.Douglas paper
-    // this = A * B
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::SymbolicMatMatMult(const BaseMatrix<ValueType>& A,
-                                                      const BaseMatrix<ValueType>& B)
+    bool HostMatrixCSR<ValueType>::LUSolve(const BaseVector<ValueType>& in,
+                                           BaseVector<ValueType>*       out) const
     {
-        const HostMatrixCSR<ValueType>* cast_mat_A
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
-        const HostMatrixCSR<ValueType>* cast_mat_B
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
 
-        assert(cast_mat_A != NULL);
-        assert(cast_mat_B != NULL);
-        assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
 
-        std::vector<PtrType> row_offset;
-        std::vector<int>*    new_col = new std::vector<int>[cast_mat_A->nrow_];
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
 
-        row_offset.resize(cast_mat_A->nrow_ + 1);
+        // Level scheduled solve, if the analysis found enough parallelism
+        if(this->local_backend_.OpenMP_threads > 1 && this->L_schedule_.nlevels > 0
+           && this->U_schedule_.nlevels > 0)
+        {
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-        row_offset[0] = 0;
+            this->LevelLSolve_(cast_in->vec_, cast_out->vec_, true);
+            this->LevelUSolve_(cast_out->vec_, cast_out->vec_, false);
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+            return true;
+        }
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int i = 0; i < cast_mat_A->nrow_; ++i)
+        // Solve L
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            // loop over the row
-            for(PtrType j = cast_mat_A->mat_.row_offset[i]; j < cast_mat_A->mat_.row_offset[i + 1];
-                ++j)
-            {
-                int ii = cast_mat_A->mat_.col[j];
-                //      new_col[i].push_back(ii);
+            cast_out->vec_[ai] = cast_in->vec_[ai];
 
-                // loop corresponding row
-                for(PtrType k = cast_mat_B->mat_.row_offset[ii];
-                    k < cast_mat_B->mat_.row_offset[ii + 1];
-                    ++k)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(this->mat_.col[aj] < ai)
                 {
-                    new_col[i].push_back(cast_mat_B->mat_.col[k]);
+                    // under the diagonal
+                    cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+                }
+                else
+                {
+                    // CSR should be sorted
+                    break;
                 }
             }
-
-            std::sort(new_col[i].begin(), new_col[i].end());
-            new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()), new_col[i].end());
-
-            row_offset[i + 1] = static_cast<PtrType>(new_col[i].size());
-        }
-
-        for(int i = 0; i < cast_mat_A->nrow_; ++i)
-        {
-            row_offset[i + 1] += row_offset[i];
         }
 
-        this->AllocateCSR(row_offset[cast_mat_A->nrow_], cast_mat_A->nrow_, cast_mat_B->ncol_);
-
-        copy_h2h(cast_mat_A->nrow_ + 1, row_offset.data(), this->mat_.row_offset);
+        // last elements should be the diagonal one (last)
+        int64_t diag_aj = this->nnz_ - 1;
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int i = 0; i < cast_mat_A->nrow_; ++i)
+        // Solve U
+        for(int ai = this->nrow_ - 1; ai >= 0; --ai)
         {
-            PtrType jj = 0;
-            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                this->mat_.col[j] = new_col[i][jj];
-                ++jj;
-            }
-        }
+                if(this->mat_.col[aj] > ai)
+                {
+                    // above the diagonal
+                    cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+                }
 
-        //#ifdef _OPENMP
-        //#pragma omp parallel for
-        //#endif
-        //      for (int64_t i=0; i<this->nnz_; ++i)
-        //      this->mat_.val[i] = static_cast<ValueType>(1);
+                if(this->mat_.col[aj] == ai)
+                {
+                    diag_aj = aj;
+                }
+            }
 
-        delete[] new_col;
+            cast_out->vec_[ai] /= this->mat_.val[diag_aj];
+        }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::NumericMatMatMult(const BaseMatrix<ValueType>& A,
-                                                     const BaseMatrix<ValueType>& B)
+    void HostMatrixCSR<ValueType>::LLAnalyse(void)
     {
-        const HostMatrixCSR<ValueType>* cast_mat_A
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
-        const HostMatrixCSR<ValueType>* cast_mat_B
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
-
-        assert(cast_mat_A != NULL);
-        assert(cast_mat_B != NULL);
-        assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
-        assert(this->nrow_ == cast_mat_A->nrow_);
-        assert(this->ncol_ == cast_mat_B->ncol_);
-
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int i = 0; i < cast_mat_A->nrow_; ++i)
-        {
-            // loop over the row
-            for(PtrType j = cast_mat_A->mat_.row_offset[i]; j < cast_mat_A->mat_.row_offset[i + 1];
-                ++j)
-            {
-                int ii = cast_mat_A->mat_.col[j];
+        assert(this->nrow_ == this->ncol_);
 
-                // loop corresponding row
-                for(PtrType k = cast_mat_B->mat_.row_offset[ii];
-                    k < cast_mat_B->mat_.row_offset[ii + 1];
-                    ++k)
-                {
-                    for(PtrType p = this->mat_.row_offset[i]; p < this->mat_.row_offset[i + 1]; ++p)
-                    {
-                        if(cast_mat_B->mat_.col[k] == this->mat_.col[p])
-                        {
-                            this->mat_.val[p] += cast_mat_B->mat_.val[k] * cast_mat_A->mat_.val[j];
-                            break;
-                        }
-                    }
-                }
-            }
-        }
+        // L is solved by its rows, L^T by the rows of the transposed pattern
+        this->BuildLevelSchedule_(this->mat_.row_offset, this->mat_.col, true, &this->L_schedule_);
 
-        return true;
+        this->BuildTransposedLower_();
+        this->BuildLevelSchedule_(this->LT_row_offset_, this->LT_col_, false, &this->LT_schedule_);
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::SymbolicPower(int p)
+    void HostMatrixCSR<ValueType>::LLAnalyseClear(void)
     {
-        assert(p > 1);
-
-        // The optimal values for the firsts values
+        this->ClearLevelSchedule_(&this->L_schedule_);
+        this->ClearLevelSchedule_(&this->LT_schedule_);
+        this->ClearTransposedLower_();
+    }
 
-        if(p == 2)
-        {
-            this->SymbolicMatMatMult(*this);
-        }
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::LUAnalyse(void)
+    {
+        assert(this->nrow_ == this->ncol_);
 
-        if(p == 3)
-        {
-            HostMatrixCSR<ValueType> tmp(this->local_backend_);
-            tmp.CopyFrom(*this);
+        this->BuildLevelSchedule_(this->mat_.row_offset, this->mat_.col, true, &this->L_schedule_);
+        this->BuildLevelSchedule_(
+            this->mat_.row_offset, this->mat_.col, false, &this->U_schedule_);
+    }
 
-            this->SymbolicPower(2);
-            this->SymbolicMatMatMult(tmp);
-        }
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::LUAnalyseClear(void)
+    {
+        this->ClearLevelSchedule_(&this->L_schedule_);
+        this->ClearLevelSchedule_(&this->U_schedule_);
+    }
 
-        if(p == 4)
-        {
-            this->SymbolicPower(2);
-            this->SymbolicPower(2);
-        }
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
+                                           BaseVector<ValueType>*       out) const
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
 
-        if(p == 5)
-        {
-            HostMatrixCSR<ValueType> tmp(this->local_backend_);
-            tmp.CopyFrom(*this);
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
 
-            this->SymbolicPower(4);
-            this->SymbolicMatMatMult(tmp);
-        }
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
 
-        if(p == 6)
+        // Level scheduled solve, if the analysis found enough parallelism
+        if(this->local_backend_.OpenMP_threads > 1 && this->L_schedule_.nlevels > 0
+           && this->LT_schedule_.nlevels > 0)
         {
-            this->SymbolicPower(2);
-            this->SymbolicPower(3);
-        }
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-        if(p == 7)
-        {
-            HostMatrixCSR<ValueType> tmp(this->local_backend_);
-            tmp.CopyFrom(*this);
+            this->LevelLLSolve_(cast_in->vec_, NULL, cast_out->vec_);
 
-            this->SymbolicPower(6);
-            this->SymbolicMatMatMult(tmp);
+            return true;
         }
 
-        if(p == 8)
+        // Solve L
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            HostMatrixCSR<ValueType> tmp(this->local_backend_);
-            tmp.CopyFrom(*this);
+            ValueType value    = cast_in->vec_[ai];
+            PtrType   diag_idx = this->mat_.row_offset[ai + 1] - 1;
 
-            this->SymbolicPower(6);
-            tmp.SymbolicPower(2);
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+            {
+                value -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+            }
 
-            this->SymbolicMatMatMult(tmp);
+            cast_out->vec_[ai] = value / this->mat_.val[diag_idx];
         }
 
-        if(p > 8)
+        // Solve L^T
+        for(int ai = this->nrow_ - 1; ai >= 0; --ai)
         {
-            HostMatrixCSR<ValueType> tmp(this->local_backend_);
-            tmp.CopyFrom(*this);
+            PtrType   diag_idx = this->mat_.row_offset[ai + 1] - 1;
+            ValueType value    = cast_out->vec_[ai] / this->mat_.val[diag_idx];
 
-            for(int i = 0; i < p; ++i)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
             {
-                this->SymbolicMatMatMult(tmp);
+                cast_out->vec_[this->mat_.col[aj]] -= value * this->mat_.val[aj];
             }
+
+            cast_out->vec_[ai] = value;
         }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ILUpFactorizeNumeric(int p, const BaseMatrix<ValueType>& mat)
+    bool HostMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
+                                           const BaseVector<ValueType>& inv_diag,
+                                           BaseVector<ValueType>*       out) const
     {
-        const HostMatrixCSR<ValueType>* cast_mat
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+        assert(inv_diag.GetSize() == this->nrow_ || inv_diag.GetSize() == this->ncol_);
 
-        assert(cast_mat != NULL);
-        assert(cast_mat->nrow_ == this->nrow_);
-        assert(cast_mat->ncol_ == this->ncol_);
-        assert(this->nnz_ > 0);
-        assert(cast_mat->nnz_ > 0);
+        const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+        const HostVector<ValueType>* cast_diag
+            = dynamic_cast<const HostVector<ValueType>*>(&inv_diag);
+        HostVector<ValueType>* cast_out = dynamic_cast<HostVector<ValueType>*>(out);
 
-        PtrType*   row_offset = NULL;
-        PtrType*   ind_diag   = NULL;
-        int*       levels     = NULL;
-        ValueType* val        = NULL;
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
 
-        allocate_host(cast_mat->nrow_ + 1, &row_offset);
-        allocate_host(cast_mat->nrow_, &ind_diag);
-        allocate_host(cast_mat->nnz_, &levels);
-        allocate_host(cast_mat->nnz_, &val);
+        // Level scheduled solve, if the analysis found enough parallelism
+        if(this->local_backend_.OpenMP_threads > 1 && this->L_schedule_.nlevels > 0
+           && this->LT_schedule_.nlevels > 0)
+        {
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-        int     inf_level = 99999;
-        int64_t nnz       = 0;
+            this->LevelLLSolve_(cast_in->vec_, cast_diag->vec_, cast_out->vec_);
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+            return true;
+        }
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        // find diagonals
-        for(int ai = 0; ai < cast_mat->nrow_; ++ai)
+        // Solve L
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            for(PtrType aj = cast_mat->mat_.row_offset[ai]; aj < cast_mat->mat_.row_offset[ai + 1];
-                ++aj)
+            ValueType value    = cast_in->vec_[ai];
+            PtrType   diag_idx = this->mat_.row_offset[ai + 1] - 1;
+
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
             {
-                if(ai == cast_mat->mat_.col[aj])
-                {
-                    ind_diag[ai] = aj;
-                    break;
-                }
+                value -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
             }
+
+            cast_out->vec_[ai] = value * cast_diag->vec_[ai];
         }
 
-        // init row_offset
-        set_to_zero_host(cast_mat->nrow_ + 1, row_offset);
+        // Solve L^T
+        for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+        {
+            PtrType   diag_idx = this->mat_.row_offset[ai + 1] - 1;
+            ValueType value    = cast_out->vec_[ai] * cast_diag->vec_[ai];
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        // init inf levels
-        for(int64_t i = 0; i < cast_mat->nnz_; ++i)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+            {
+                cast_out->vec_[this->mat_.col[aj]] -= value * this->mat_.val[aj];
+            }
+
+            cast_out->vec_[ai] = value;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::LAnalyse(bool diag_unit)
+    {
+        this->L_diag_unit_ = diag_unit;
+
+        this->BuildLevelSchedule_(this->mat_.row_offset, this->mat_.col, true, &this->L_schedule_);
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::LAnalyseClear(void)
+    {
+        this->L_diag_unit_ = true;
+
+        this->ClearLevelSchedule_(&this->L_schedule_);
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::LSolve(const BaseVector<ValueType>& in,
+                                          BaseVector<ValueType>*       out) const
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        // Level scheduled solve, if the analysis found enough parallelism
+        if(this->local_backend_.OpenMP_threads > 1 && this->L_schedule_.nlevels > 0)
         {
-            levels[i] = inf_level;
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+            this->LevelLSolve_(cast_in->vec_, cast_out->vec_, this->L_diag_unit_);
+
+            return true;
         }
 
-        set_to_zero_host(cast_mat->nnz_, val);
+        PtrType diag_aj = 0;
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        // fill levels and values
-        for(int ai = 0; ai < cast_mat->nrow_; ++ai)
+        // Solve L
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            for(PtrType aj = cast_mat->mat_.row_offset[ai]; aj < cast_mat->mat_.row_offset[ai + 1];
-                ++aj)
+            cast_out->vec_[ai] = cast_in->vec_[ai];
+
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                for(PtrType ajj = this->mat_.row_offset[ai]; ajj < this->mat_.row_offset[ai + 1];
-                    ++ajj)
+                if(this->mat_.col[aj] < ai)
                 {
-                    if(cast_mat->mat_.col[aj] == this->mat_.col[ajj])
+                    // under the diagonal
+                    cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+                }
+                else
+                {
+                    // CSR should be sorted
+                    if(this->L_diag_unit_ == false)
                     {
-                        val[aj]    = this->mat_.val[ajj];
-                        levels[aj] = 0;
-                        break;
+                        assert(this->mat_.col[aj] == ai);
+                        diag_aj = aj;
                     }
+                    break;
                 }
             }
-        }
 
-        // ai = 1 to N
-        for(int ai = 1; ai < cast_mat->nrow_; ++ai)
-        {
-            // ak = 1 to ai-1
-            for(PtrType ak = cast_mat->mat_.row_offset[ai]; ai > cast_mat->mat_.col[ak]; ++ak)
+            if(this->L_diag_unit_ == false)
             {
-                if(levels[ak] <= p)
-                {
-                    val[ak] /= val[ind_diag[cast_mat->mat_.col[ak]]];
+                cast_out->vec_[ai] /= this->mat_.val[diag_aj];
+            }
+        }
 
-                    // aj = ak+1 to N
-                    for(PtrType aj = ak + 1; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
-                    {
-                        ValueType val_kj   = static_cast<ValueType>(0);
-                        int       level_kj = inf_level;
+        return true;
+    }
 
-                        // find a_k,j
-                        for(PtrType kj = cast_mat->mat_.row_offset[cast_mat->mat_.col[ak]];
-                            kj < cast_mat->mat_.row_offset[cast_mat->mat_.col[ak] + 1];
-                            ++kj)
-                        {
-                            if(cast_mat->mat_.col[aj] == cast_mat->mat_.col[kj])
-                            {
-                                level_kj = levels[kj];
-                                val_kj   = val[kj];
-                                break;
-                            }
-                        }
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::UAnalyse(bool diag_unit)
+    {
+        this->U_diag_unit_ = diag_unit;
 
-                        int lev = level_kj + levels[ak] + 1;
+        this->BuildLevelSchedule_(
+            this->mat_.row_offset, this->mat_.col, false, &this->U_schedule_);
+    }
 
-                        if(levels[aj] > lev)
-                        {
-                            levels[aj] = lev;
-                        }
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::UAnalyseClear(void)
+    {
+        this->U_diag_unit_ = false;
 
-                        // a_i,j = a_i,j - a_i,k * a_k,j
-                        val[aj] -= val[ak] * val_kj;
-                    }
-                }
-            }
+        this->ClearLevelSchedule_(&this->U_schedule_);
+    }
 
-            for(PtrType ak = cast_mat->mat_.row_offset[ai]; ak < cast_mat->mat_.row_offset[ai + 1];
-                ++ak)
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::USolve(const BaseVector<ValueType>& in,
+                                          BaseVector<ValueType>*       out) const
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        // Level scheduled solve, if the analysis found enough parallelism
+        if(this->local_backend_.OpenMP_threads > 1 && this->U_schedule_.nlevels > 0)
+        {
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+            this->LevelUSolve_(cast_in->vec_, cast_out->vec_, this->U_diag_unit_);
+
+            return true;
+        }
+
+        // last elements should the diagonal one (last)
+        int64_t diag_aj = this->nnz_ - 1;
+
+        // Solve U
+        for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+        {
+            cast_out->vec_[ai] = cast_in->vec_[ai];
+
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                if(levels[ak] > p)
+                if(this->mat_.col[aj] > ai)
                 {
-                    levels[ak] = inf_level;
-                    val[ak]    = static_cast<ValueType>(0);
+                    // above the diagonal
+                    cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
                 }
-                else
+
+                if(this->U_diag_unit_ == false)
                 {
-                    ++row_offset[ai + 1];
+                    if(this->mat_.col[aj] == ai)
+                    {
+                        diag_aj = aj;
+                    }
                 }
             }
+
+            if(this->U_diag_unit_ == false)
+            {
+                cast_out->vec_[ai] /= this->mat_.val[diag_aj];
+            }
         }
 
-        row_offset[0] = this->mat_.row_offset[0];
-        row_offset[1] = this->mat_.row_offset[1];
+        return true;
+    }
 
-        for(int i = 0; i < cast_mat->nrow_; ++i)
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::BuildLevelSchedule_(const PtrType* row_offset,
+                                                       const int*     col,
+                                                       bool           lower,
+                                                       LevelSchedule* schedule) const
+    {
+        assert(schedule != NULL);
+
+        this->ClearLevelSchedule_(schedule);
+
+        if(this->nrow_ == 0)
         {
-            row_offset[i + 1] += row_offset[i];
+            return;
         }
 
-        nnz = row_offset[cast_mat->nrow_];
+        // Level of each row, i.e. the longest path to it in the dependency graph
+        std::vector<int> row_level(this->nrow_, 0);
 
-        this->AllocateCSR(nnz, cast_mat->nrow_, cast_mat->ncol_);
+        int nlevels = 0;
 
-        PtrType jj = 0;
-        for(int i = 0; i < cast_mat->nrow_; ++i)
+        for(int k = 0; k < this->nrow_; ++k)
         {
-            for(PtrType j = cast_mat->mat_.row_offset[i]; j < cast_mat->mat_.row_offset[i + 1]; ++j)
+            int ai = lower ? k : this->nrow_ - 1 - k;
+
+            int level = 0;
+
+            for(PtrType aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
             {
-                if(levels[j] <= p)
+                int c = col[aj];
+
+                if((lower == true && c < ai) || (lower == false && c > ai))
                 {
-                    this->mat_.col[jj] = cast_mat->mat_.col[j];
-                    this->mat_.val[jj] = val[j];
-                    ++jj;
+                    level = std::max(level, row_level[c] + 1);
                 }
             }
+
+            row_level[ai] = level;
+            nlevels       = std::max(nlevels, level + 1);
         }
 
-        assert(jj == nnz);
+        // A barrier per level does not pay off for (nearly) sequential dependencies
+        if(this->nrow_ < 32 * nlevels)
+        {
+            return;
+        }
 
-        copy_h2h(this->nrow_ + 1, row_offset, this->mat_.row_offset);
+        schedule->nlevels = nlevels;
 
-        free_host(&row_offset);
-        free_host(&ind_diag);
-        free_host(&levels);
-        free_host(&val);
+        allocate_host(nlevels + 1, &schedule->level_offset);
+        allocate_host(this->nrow_, &schedule->level_row);
 
-        return true;
+        set_to_zero_host(nlevels + 1, schedule->level_offset);
+
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            ++schedule->level_offset[row_level[ai] + 1];
+        }
+
+        for(int l = 0; l < nlevels; ++l)
+        {
+            schedule->level_offset[l + 1] += schedule->level_offset[l];
+        }
+
+        // Rows of a level are kept in ascending order for locality
+        std::vector<int> pos(schedule->level_offset, schedule->level_offset + nlevels);
+
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            schedule->level_row[pos[row_level[ai]]++] = ai;
+        }
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::MatrixAdd(const BaseMatrix<ValueType>& mat,
-                                             ValueType                    alpha,
-                                             ValueType                    beta,
-                                             bool                         structure)
+    void HostMatrixCSR<ValueType>::ClearLevelSchedule_(LevelSchedule* schedule) const
     {
-        const HostMatrixCSR<ValueType>* cast_mat
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
+        assert(schedule != NULL);
 
-        assert(cast_mat != NULL);
-        assert(cast_mat->nrow_ == this->nrow_);
-        assert(cast_mat->ncol_ == this->ncol_);
-        assert(this->nnz_ >= 0);
-        assert(cast_mat->nnz_ >= 0);
+        free_host(&schedule->level_offset);
+        free_host(&schedule->level_row);
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        schedule->nlevels = 0;
+    }
 
-        // the structure is sub-set
-        if(structure == false)
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::BuildTransposedLower_(void)
+    {
+        this->ClearTransposedLower_();
+
+        allocate_host(this->nrow_ + 1, &this->LT_row_offset_);
+        set_to_zero_host(this->nrow_ + 1, this->LT_row_offset_);
+
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            // CSR should be sorted
-            for(int ai = 0; ai < cast_mat->nrow_; ++ai)
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                PtrType first_col = cast_mat->mat_.row_offset[ai];
-
-                for(PtrType ajj = this->mat_.row_offset[ai]; ajj < this->mat_.row_offset[ai + 1];
-                    ++ajj)
+                if(this->mat_.col[aj] < ai)
                 {
-                    for(PtrType aj = first_col; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
-                    {
-                        if(cast_mat->mat_.col[aj] == this->mat_.col[ajj])
-                        {
-                            this->mat_.val[ajj]
-                                = alpha * this->mat_.val[ajj] + beta * cast_mat->mat_.val[aj];
-                            ++first_col;
-                            break;
-                        }
-                    }
+                    ++this->LT_row_offset_[this->mat_.col[aj] + 1];
                 }
             }
         }
-        else
-        {
-            std::vector<PtrType> row_offset;
-            std::vector<int>*    new_col = new std::vector<int>[this->nrow_];
 
-            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            this->LT_row_offset_[ai + 1] += this->LT_row_offset_[ai];
+        }
 
-            tmp.CopyFrom(*this);
+        PtrType nnz = this->LT_row_offset_[this->nrow_];
 
-            row_offset.resize(this->nrow_ + 1);
+        allocate_host(nnz, &this->LT_col_);
+        allocate_host(nnz, &this->LT_pos_);
 
-            row_offset[0] = 0;
+        std::vector<PtrType> pos(this->LT_row_offset_, this->LT_row_offset_ + this->nrow_);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int i = 0; i < this->nrow_; ++i)
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-                {
-                    new_col[i].push_back(this->mat_.col[j]);
-                }
+                int c = this->mat_.col[aj];
 
-                for(PtrType k = cast_mat->mat_.row_offset[i]; k < cast_mat->mat_.row_offset[i + 1];
-                    ++k)
+                if(c < ai)
                 {
-                    new_col[i].push_back(cast_mat->mat_.col[k]);
+                    this->LT_col_[pos[c]] = ai;
+                    this->LT_pos_[pos[c]] = aj;
+                    ++pos[c];
                 }
-
-                std::sort(new_col[i].begin(), new_col[i].end());
-                new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()),
-                                 new_col[i].end());
-
-                row_offset[i + 1] = static_cast<PtrType>(new_col[i].size());
-            }
-
-            for(int i = 0; i < this->nrow_; ++i)
-            {
-                row_offset[i + 1] += row_offset[i];
             }
+        }
+    }
 
-            this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::ClearTransposedLower_(void)
+    {
+        free_host(&this->LT_row_offset_);
+        free_host(&this->LT_col_);
+        free_host(&this->LT_pos_);
+    }
 
-            // copy structure
-            copy_h2h(this->nrow_ + 1, row_offset.data(), this->mat_.row_offset);
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::LevelLSolve_(const ValueType* in,
+                                                ValueType*       out,
+                                                bool             diag_unit) const
+    {
+        const LevelSchedule& schedule = this->L_schedule_;
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-            for(int i = 0; i < this->nrow_; ++i)
-            {
-                PtrType jj = 0;
-                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-                {
-                    this->mat_.col[j] = new_col[i][jj];
-                    ++jj;
-                }
-            }
-
+        for(int l = 0; l < schedule.nlevels; ++l)
+        {
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp for schedule(static)
 #endif
-            // add values
-            for(int i = 0; i < this->nrow_; ++i)
+            for(int k = schedule.level_offset[l]; k < schedule.level_offset[l + 1]; ++k)
             {
-                PtrType Aj = tmp.mat_.row_offset[i];
-                PtrType Bj = cast_mat->mat_.row_offset[i];
+                int ai = schedule.level_row[k];
 
-                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                ValueType value   = in[ai];
+                PtrType   diag_aj = 0;
+
+                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
+                    ++aj)
                 {
-                    for(PtrType jj = Aj; jj < tmp.mat_.row_offset[i + 1]; ++jj)
+                    if(this->mat_.col[aj] < ai)
                     {
-                        if(this->mat_.col[j] == tmp.mat_.col[jj])
-                        {
-                            this->mat_.val[j] += alpha * tmp.mat_.val[jj];
-                            ++Aj;
-                            break;
-                        }
+                        value -= this->mat_.val[aj] * out[this->mat_.col[aj]];
                     }
-
-                    for(PtrType jj = Bj; jj < cast_mat->mat_.row_offset[i + 1]; ++jj)
+                    else
                     {
-                        if(this->mat_.col[j] == cast_mat->mat_.col[jj])
-                        {
-                            this->mat_.val[j] += beta * cast_mat->mat_.val[jj];
-                            ++Bj;
-                            break;
-                        }
+                        // CSR should be sorted
+                        diag_aj = aj;
+                        break;
                     }
                 }
+
+                out[ai] = diag_unit ? value : value / this->mat_.val[diag_aj];
             }
-            delete[] new_col;
         }
-
-        return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const
+    void HostMatrixCSR<ValueType>::LevelUSolve_(const ValueType* in,
+                                                ValueType*       out,
+                                                bool             diag_unit) const
     {
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
-
-        lambda_min = static_cast<ValueType>(0);
-        lambda_max = static_cast<ValueType>(0);
-
-        // TODO (parallel max, min)
-        //#ifdef _OPENMP
-        // #pragma omp parallel for
-        //#endif
+        const LevelSchedule& schedule = this->U_schedule_;
 
-        for(int ai = 0; ai < this->nrow_; ++ai)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for(int l = 0; l < schedule.nlevels; ++l)
         {
-            ValueType sum  = static_cast<ValueType>(0);
-            ValueType diag = static_cast<ValueType>(0);
-
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for(int k = schedule.level_offset[l]; k < schedule.level_offset[l + 1]; ++k)
             {
-                if(ai != this->mat_.col[aj])
-                {
-                    sum += std::abs(this->mat_.val[aj]);
-                }
-                else
+                int ai = schedule.level_row[k];
+
+                ValueType value   = in[ai];
+                PtrType   diag_aj = 0;
+
+                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
+                    ++aj)
                 {
-                    diag = this->mat_.val[aj];
+                    if(this->mat_.col[aj] > ai)
+                    {
+                        value -= this->mat_.val[aj] * out[this->mat_.col[aj]];
+                    }
+                    else if(this->mat_.col[aj] == ai)
+                    {
+                        diag_aj = aj;
+                    }
                 }
-            }
-
-            if(sum + diag > lambda_max)
-            {
-                lambda_max = sum + diag;
-            }
 
-            if(diag - sum < lambda_min)
-            {
-                lambda_min = diag - sum;
+                out[ai] = diag_unit ? value : value / this->mat_.val[diag_aj];
             }
         }
-
-        return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::Scale(ValueType alpha)
+    void HostMatrixCSR<ValueType>::LevelLLSolve_(const ValueType* in,
+                                                 const ValueType* inv_diag,
+                                                 ValueType*       out) const
     {
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        const LevelSchedule& L  = this->L_schedule_;
+        const LevelSchedule& LT = this->LT_schedule_;
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-        for(int64_t ai = 0; ai < this->nnz_; ++ai)
         {
-            this->mat_.val[ai] *= alpha;
-        }
+            // Solve L, the diagonal entry is the last one of each row
+            for(int l = 0; l < L.nlevels; ++l)
+            {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+                for(int k = L.level_offset[l]; k < L.level_offset[l + 1]; ++k)
+                {
+                    int ai = L.level_row[k];
 
-        return true;
-    }
+                    ValueType value    = in[ai];
+                    PtrType   diag_idx = this->mat_.row_offset[ai + 1] - 1;
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ScaleDiagonal(ValueType alpha)
-    {
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+                    for(PtrType aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+                    {
+                        value -= this->mat_.val[aj] * out[this->mat_.col[aj]];
+                    }
+
+                    out[ai] = (inv_diag != NULL) ? value * inv_diag[ai]
+                                                 : value / this->mat_.val[diag_idx];
+                }
+            }
 
+            // Solve L^T, gathering over the transposed pattern
+            for(int l = 0; l < LT.nlevels; ++l)
+            {
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp for schedule(static)
 #endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                if(ai == this->mat_.col[aj])
+                for(int k = LT.level_offset[l]; k < LT.level_offset[l + 1]; ++k)
                 {
-                    this->mat_.val[aj] *= alpha;
-                    break;
+                    int ai = LT.level_row[k];
+
+                    ValueType value    = out[ai];
+                    PtrType   diag_idx = this->mat_.row_offset[ai + 1] - 1;
+
+                    for(PtrType aj = this->LT_row_offset_[ai]; aj < this->LT_row_offset_[ai + 1];
+                        ++aj)
+                    {
+                        value -= this->mat_.val[this->LT_pos_[aj]] * out[this->LT_col_[aj]];
+                    }
+
+                    out[ai] = (inv_diag != NULL) ? value * inv_diag[ai]
+                                                 : value / this->mat_.val[diag_idx];
                 }
             }
         }
-
-        return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ScaleOffDiagonal(ValueType alpha)
+    bool HostMatrixCSR<ValueType>::TriangularLevels(bool lower, int* levels) const
     {
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        assert(levels != NULL);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        // Level of each row, i.e. the longest path to it in the dependency graph
+        std::vector<int> row_level(this->nrow_, 0);
+
+        int max_level = -1;
+
+        for(int k = 0; k < this->nrow_; ++k)
         {
+            // Forward substitution for the lower part, backward for the upper part
+            int ai = lower ? k : this->nrow_ - 1 - k;
+
+            int level = 0;
+
             for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                if(ai != this->mat_.col[aj])
+                int col = this->mat_.col[aj];
+
+                if((lower == true && col < ai) || (lower == false && col > ai))
                 {
-                    this->mat_.val[aj] *= alpha;
+                    level = std::max(level, row_level[col] + 1);
                 }
             }
+
+            row_level[ai] = level;
+            max_level     = std::max(max_level, level);
         }
 
+        *levels = max_level + 1;
+
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AddScalar(ValueType alpha)
+    bool HostMatrixCSR<ValueType>::TriangularBlockInverse(bool                   lower,
+                                                          bool                   diag_unit,
+                                                          int                    block_size,
+                                                          BaseMatrix<ValueType>* inv,
+                                                          BaseMatrix<ValueType>* off) const
     {
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        assert(inv != NULL);
+        assert(off != NULL);
+        assert(block_size > 0);
+        assert(this->nrow_ == this->ncol_);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int64_t ai = 0; ai < this->nnz_; ++ai)
-        {
-            this->mat_.val[ai] += alpha;
-        }
+        HostMatrixCSR<ValueType>* cast_inv = dynamic_cast<HostMatrixCSR<ValueType>*>(inv);
+        HostMatrixCSR<ValueType>* cast_off = dynamic_cast<HostMatrixCSR<ValueType>*>(off);
 
-        return true;
-    }
+        assert(cast_inv != NULL);
+        assert(cast_off != NULL);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AddScalarDiagonal(ValueType alpha)
-    {
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        std::vector<PtrType>   inv_row_offset(this->nrow_ + 1, 0);
+        std::vector<int>       inv_col;
+        std::vector<ValueType> inv_val;
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
+        std::vector<PtrType>   off_row_offset(this->nrow_ + 1, 0);
+        std::vector<int>       off_col;
+        std::vector<ValueType> off_val;
+
+        // Dense diagonal block and its inverse
+        std::vector<ValueType> T(block_size * block_size);
+        std::vector<ValueType> X(block_size * block_size);
+
+        for(int r0 = 0; r0 < this->nrow_; r0 += block_size)
         {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            int r1 = std::min(r0 + block_size, this->nrow_);
+            int n  = r1 - r0;
+
+            std::fill(T.begin(), T.end(), static_cast<ValueType>(0));
+
+            for(int i = r0; i < r1; ++i)
             {
-                if(ai == this->mat_.col[aj])
+                if(diag_unit == true)
                 {
-                    this->mat_.val[aj] += alpha;
-                    break;
+                    T[(i - r0) * n + i - r0] = static_cast<ValueType>(1);
                 }
-            }
-        }
 
-        return true;
-    }
+                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    int col = this->mat_.col[j];
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AddScalarOffDiagonal(ValueType alpha)
-    {
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+                    if(col == i)
+                    {
+                        if(diag_unit == false)
+                        {
+                            T[(i - r0) * n + i - r0] = this->mat_.val[j];
+                        }
+                    }
+                    else if((lower == true && col < i) || (lower == false && col > i))
+                    {
+                        if(col >= r0 && col < r1)
+                        {
+                            T[(i - r0) * n + col - r0] = this->mat_.val[j];
+                        }
+                        else
+                        {
+                            off_col.push_back(col);
+                            off_val.push_back(this->mat_.val[j]);
+                        }
+                    }
+                }
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                if(ai != this->mat_.col[aj])
+                off_row_offset[i + 1] = off_col.size();
+
+                if(T[(i - r0) * n + i - r0] == static_cast<ValueType>(0))
                 {
-                    this->mat_.val[aj] += alpha;
+                    LOG_INFO("TriangularBlockInverse() zero pivot in row " << i);
+                    return false;
                 }
             }
-        }
 
-        return true;
-    }
+            // Invert the triangular block column by column
+            for(int c = 0; c < n; ++c)
+            {
+                for(int k = 0; k < n; ++k)
+                {
+                    int i = lower ? k : n - 1 - k;
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::DiagonalMatrixMultR(const BaseVector<ValueType>& diag)
-    {
-        assert(diag.GetSize() == this->ncol_);
+                    if((lower == true && i < c) || (lower == false && i > c))
+                    {
+                        X[i * n + c] = static_cast<ValueType>(0);
+                        continue;
+                    }
 
-        const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&diag);
-        assert(cast_diag != NULL);
+                    ValueType sum
+                        = (i == c) ? static_cast<ValueType>(1) : static_cast<ValueType>(0);
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+                    int jbegin = lower ? c : i + 1;
+                    int jend   = lower ? i : c + 1;
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                this->mat_.val[aj] *= cast_diag->vec_[this->mat_.col[aj]];
+                    for(int j = jbegin; j < jend; ++j)
+                    {
+                        sum -= T[i * n + j] * X[j * n + c];
+                    }
+
+                    X[i * n + c] = sum / T[i * n + i];
+                }
             }
-        }
 
-        return true;
-    }
+            for(int i = 0; i < n; ++i)
+            {
+                for(int c = 0; c < n; ++c)
+                {
+                    if(X[i * n + c] != static_cast<ValueType>(0))
+                    {
+                        inv_col.push_back(r0 + c);
+                        inv_val.push_back(X[i * n + c]);
+                    }
+                }
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::DiagonalMatrixMultL(const BaseVector<ValueType>& diag)
-    {
-        assert(diag.GetSize() == this->ncol_);
+                inv_row_offset[r0 + i + 1] = inv_col.size();
+            }
+        }
 
-        const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&diag);
-        assert(cast_diag != NULL);
+        cast_inv->Clear();
+        cast_inv->AllocateCSR(inv_col.size(), this->nrow_, this->ncol_);
+        cast_off->Clear();
+        cast_off->AllocateCSR(off_col.size(), this->nrow_, this->ncol_);
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        copy_h2h(this->nrow_ + 1, inv_row_offset.data(), cast_inv->mat_.row_offset);
+        copy_h2h(inv_col.size(), inv_col.data(), cast_inv->mat_.col);
+        copy_h2h(inv_val.size(), inv_val.data(), cast_inv->mat_.val);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
-        {
-            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-            {
-                this->mat_.val[aj] *= cast_diag->vec_[ai];
-            }
-        }
+        copy_h2h(this->nrow_ + 1, off_row_offset.data(), cast_off->mat_.row_offset);
+        copy_h2h(off_col.size(), off_col.data(), cast_off->mat_.col);
+        copy_h2h(off_val.size(), off_val.data(), cast_off->mat_.val);
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::Compress(double drop_off)
+    void HostMatrixCSR<ValueType>::ItLUAnalyse(void)
     {
-        if(this->nnz_ > 0)
-        {
-            std::vector<PtrType> row_offset;
+        assert(this->ncol_ == this->nrow_);
+        assert(this->tmp_vec_ == NULL);
 
-            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+        this->tmp_vec_ = new HostVector<ValueType>(this->local_backend_);
 
-            tmp.CopyFrom(*this);
+        assert(this->tmp_vec_ != NULL);
 
-            row_offset.resize(this->nrow_ + 1);
+        // Status
+        bool status;
 
-            row_offset[0] = 0;
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
 
-            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        // Create buffer, if not already available
+        size_t buffer_size   = 0;
+        size_t L_buffer_size = 0;
+        size_t U_buffer_size = 0;
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int i = 0; i < this->nrow_; ++i)
-            {
-                row_offset[i + 1] = 0;
+        status = host_csritsv_buffer_size(host_sparse_operation_none,
+                                          this->nrow_,
+                                          static_cast<PtrType>(this->nnz_),
+                                          host_sparse_fill_mode_lower,
+                                          host_sparse_diag_type_unit,
+                                          host_sparse_matrix_type_general,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          &L_buffer_size);
 
-                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-                {
-                    if((std::abs(this->mat_.val[j]) > drop_off) || (this->mat_.col[j] == i))
-                    {
-                        row_offset[i + 1] += 1;
-                    }
-                }
-            }
+        if(!status)
+        {
+            LOG_INFO("ItLUAnalyse() failed");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-            for(int i = 0; i < this->nrow_; ++i)
-            {
-                row_offset[i + 1] += row_offset[i];
-            }
+        status = host_csritsv_buffer_size(host_sparse_operation_none,
+                                          this->nrow_,
+                                          static_cast<PtrType>(this->nnz_),
+                                          host_sparse_fill_mode_upper,
+                                          host_sparse_diag_type_non_unit,
+                                          host_sparse_matrix_type_general,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          &U_buffer_size);
 
-            this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+        if(!status)
+        {
+            LOG_INFO("ItLUAnalyse() failed");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-            copy_h2h(this->nrow_ + 1, row_offset.data(), this->mat_.row_offset);
+        buffer_size = std::max(L_buffer_size, U_buffer_size);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int i = 0; i < this->nrow_; ++i)
-            {
-                PtrType jj = this->mat_.row_offset[i];
+        // Check buffer size
+        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        {
+            free_host(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
 
-                for(PtrType j = tmp.mat_.row_offset[i]; j < tmp.mat_.row_offset[i + 1]; ++j)
-                {
-                    if((std::abs(tmp.mat_.val[j]) > drop_off) || (tmp.mat_.col[j] == i))
-                    {
-                        this->mat_.col[jj] = tmp.mat_.col[j];
-                        this->mat_.val[jj] = tmp.mat_.val[j];
-                        ++jj;
-                    }
-                }
-            }
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_host(buffer_size, &this->mat_buffer_);
         }
 
-        return true;
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+
+        // Allocate temporary vector
+        this->tmp_vec_->Allocate(this->nrow_);
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::Transpose(void)
+    void HostMatrixCSR<ValueType>::ItLUAnalyseClear(void)
     {
-        if(this->nnz_ > 0)
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
         {
-            HostMatrixCSR<ValueType> tmp(this->local_backend_);
-
-            tmp.CopyFrom(*this);
-            tmp.Transpose(this);
+            free_host(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
         }
 
-        return true;
+        this->mat_buffer_size_ = 0;
+
+        // Clear temporary vector
+        if(this->tmp_vec_ != NULL)
+        {
+            delete this->tmp_vec_;
+            this->tmp_vec_ = NULL;
+        }
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::Transpose(BaseMatrix<ValueType>* T) const
+    bool HostMatrixCSR<ValueType>::ItLUSolve(int                          max_iter,
+                                             double                       tolerance,
+                                             bool                         use_tol,
+                                             const BaseVector<ValueType>& in,
+                                             BaseVector<ValueType>*       out) const
     {
-        assert(T != NULL);
-
-        HostMatrixCSR<ValueType>* cast_T = dynamic_cast<HostMatrixCSR<ValueType>*>(T);
-
-        assert(cast_T != NULL);
-
         if(this->nnz_ > 0)
         {
-            cast_T->Clear();
-            cast_T->AllocateCSR(this->nnz_, this->ncol_, this->nrow_);
+            assert(out != NULL);
+            assert(this->ncol_ == this->nrow_);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
 
-            for(int64_t i = 0; i < cast_T->nnz_; ++i)
-            {
-                cast_T->mat_.row_offset[this->mat_.col[i] + 1] += 1;
-            }
+            assert(this->tmp_vec_ != NULL);
 
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            bool status;
+
+            int                               zero_pivot;
+            const ValueType                   alpha = static_cast<ValueType>(1);
+            const numeric_traits_t<ValueType> temp_tol
+                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+
+            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve L
+            status = host_csritsv_solve(&max_iter,
+                                        tol_ptr,
+                                        nullptr,
+                                        host_sparse_operation_none,
+                                        this->nrow_,
+                                        static_cast<PtrType>(this->nnz_),
+                                        &alpha,
+                                        host_sparse_fill_mode_lower,
+                                        host_sparse_diag_type_unit,
+                                        host_sparse_matrix_type_general,
+                                        this->mat_.val,
+                                        this->mat_.row_offset,
+                                        this->mat_.col,
+                                        cast_in->vec_,
+                                        this->tmp_vec_->vec_,
+                                        this->mat_buffer_,
+                                        &zero_pivot);
+
+            if(!status)
+            {
+                LOG_INFO("ItLUSolve() failed to solve L");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            // Solve U
+            status = host_csritsv_solve(&max_iter,
+                                        tol_ptr,
+                                        nullptr,
+                                        host_sparse_operation_none,
+                                        this->nrow_,
+                                        static_cast<PtrType>(this->nnz_),
+                                        &alpha,
+                                        host_sparse_fill_mode_upper,
+                                        host_sparse_diag_type_non_unit,
+                                        host_sparse_matrix_type_general,
+                                        this->mat_.val,
+                                        this->mat_.row_offset,
+                                        this->mat_.col,
+                                        this->tmp_vec_->vec_,
+                                        cast_out->vec_,
+                                        this->mat_buffer_,
+                                        &zero_pivot);
+
+            if(!status)
+            {
+                LOG_INFO("ItLUSolve() failed to solve U");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::ItLLAnalyse(void)
+    {
+        assert(this->ncol_ == this->nrow_);
+        assert(this->tmp_vec_ == NULL);
+
+        this->tmp_vec_ = new HostVector<ValueType>(this->local_backend_);
+
+        assert(this->tmp_vec_ != NULL);
+
+        // Status
+        bool status;
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        // Create buffer, if not already available
+        size_t buffer_size    = 0;
+        size_t L_buffer_size  = 0;
+        size_t Lt_buffer_size = 0;
+
+        status = host_csritsv_buffer_size(host_sparse_operation_none,
+                                          this->nrow_,
+                                          static_cast<PtrType>(this->nnz_),
+                                          host_sparse_fill_mode_lower,
+                                          host_sparse_diag_type_non_unit,
+                                          host_sparse_matrix_type_general,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          &L_buffer_size);
+
+        if(!status)
+        {
+            LOG_INFO("ItLLAnalyse() failed");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        status = host_csritsv_buffer_size(host_sparse_operation_transpose,
+                                          this->nrow_,
+                                          static_cast<PtrType>(this->nnz_),
+                                          host_sparse_fill_mode_lower,
+                                          host_sparse_diag_type_non_unit,
+                                          host_sparse_matrix_type_general,
+                                          this->mat_.val,
+                                          this->mat_.row_offset,
+                                          this->mat_.col,
+                                          &Lt_buffer_size);
+
+        if(!status)
+        {
+            LOG_INFO("ItLLAnalyse() failed");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        buffer_size = std::max(L_buffer_size, Lt_buffer_size);
+
+        // Check buffer size
+        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        {
+            free_host(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_host(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+
+        // Allocate temporary vector
+        this->tmp_vec_->Allocate(this->nrow_);
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::ItLLAnalyseClear(void)
+    {
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_host(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+
+        // Clear temporary vector
+        if(this->tmp_vec_ != NULL)
+        {
+            delete this->tmp_vec_;
+            this->tmp_vec_ = NULL;
+        }
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ItLLSolve(int                          max_iter,
+                                             double                       tolerance,
+                                             bool                         use_tol,
+                                             const BaseVector<ValueType>& in,
+                                             BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->ncol_ == this->nrow_);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+
+            assert(this->tmp_vec_ != NULL);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            bool status;
+
+            int                               zero_pivot;
+            const ValueType                   alpha = static_cast<ValueType>(1);
+            const numeric_traits_t<ValueType> temp_tol
+                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+
+            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve L
+            status = host_csritsv_solve(&max_iter,
+                                        tol_ptr,
+                                        nullptr,
+                                        host_sparse_operation_none,
+                                        this->nrow_,
+                                        static_cast<PtrType>(this->nnz_),
+                                        &alpha,
+                                        host_sparse_fill_mode_lower,
+                                        host_sparse_diag_type_non_unit,
+                                        host_sparse_matrix_type_general,
+                                        this->mat_.val,
+                                        this->mat_.row_offset,
+                                        this->mat_.col,
+                                        cast_in->vec_,
+                                        this->tmp_vec_->vec_,
+                                        this->mat_buffer_,
+                                        &zero_pivot);
+
+            if(!status)
+            {
+                LOG_INFO("ItLLSolve() failed");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            // Solve Lt
+            status = host_csritsv_solve(&max_iter,
+                                        tol_ptr,
+                                        nullptr,
+                                        host_sparse_operation_transpose,
+                                        this->nrow_,
+                                        static_cast<PtrType>(this->nnz_),
+                                        &alpha,
+                                        host_sparse_fill_mode_lower,
+                                        host_sparse_diag_type_non_unit,
+                                        host_sparse_matrix_type_general,
+                                        this->mat_.val,
+                                        this->mat_.row_offset,
+                                        this->mat_.col,
+                                        this->tmp_vec_->vec_,
+                                        cast_out->vec_,
+                                        this->mat_buffer_,
+                                        &zero_pivot);
+
+            if(!status)
+            {
+                LOG_INFO("ItLLSolve() failed");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ItLLSolve(int                          max_iter,
+                                             double                       tolerance,
+                                             bool                         use_tol,
+                                             const BaseVector<ValueType>& in,
+                                             const BaseVector<ValueType>& inv_diag,
+                                             BaseVector<ValueType>*       out) const
+    {
+        return ItLLSolve(max_iter, tolerance, use_tol, in, out);
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::ItLAnalyse(bool diag_unit)
+    {
+        assert(this->ncol_ == this->nrow_);
+
+        // Status
+        bool status;
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        this->L_diag_unit_ = diag_unit;
+
+        // Create buffer, if not already available
+        size_t buffer_size = 0;
+
+        status = host_csritsv_buffer_size(
+            host_sparse_operation_none,
+            this->nrow_,
+            static_cast<PtrType>(this->nnz_),
+            host_sparse_fill_mode_lower,
+            (this->L_diag_unit_ ? host_sparse_diag_type_unit : host_sparse_diag_type_non_unit),
+            host_sparse_matrix_type_general,
+            this->mat_.val,
+            this->mat_.row_offset,
+            this->mat_.col,
+            &buffer_size);
+
+        if(!status)
+        {
+            LOG_INFO("ItLAnalyse() failed");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        // Check buffer size
+        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        {
+            free_host(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_host(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::ItLAnalyseClear(void)
+    {
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_host(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ItLSolve(int                          max_iter,
+                                            double                       tolerance,
+                                            bool                         use_tol,
+                                            const BaseVector<ValueType>& in,
+                                            BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->ncol_ == this->nrow_);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            bool status;
+
+            int                               zero_pivot;
+            const ValueType                   alpha = static_cast<ValueType>(1);
+            const numeric_traits_t<ValueType> temp_tol
+                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+
+            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve L
+            status = host_csritsv_solve(
+                &max_iter,
+                tol_ptr,
+                nullptr,
+                host_sparse_operation_none,
+                this->nrow_,
+                static_cast<PtrType>(this->nnz_),
+                &alpha,
+                host_sparse_fill_mode_lower,
+                (this->L_diag_unit_ ? host_sparse_diag_type_unit : host_sparse_diag_type_non_unit),
+                host_sparse_matrix_type_general,
+                this->mat_.val,
+                this->mat_.row_offset,
+                this->mat_.col,
+                cast_in->vec_,
+                cast_out->vec_,
+                this->mat_buffer_,
+                &zero_pivot);
+
+            if(!status)
+            {
+                LOG_INFO("ItLSolve() failed");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::ItUAnalyse(bool diag_unit)
+    {
+        assert(this->ncol_ == this->nrow_);
+
+        // Status
+        bool status;
+
+        assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+        this->U_diag_unit_ = diag_unit;
+
+        // Create buffer, if not already available
+        size_t buffer_size = 0;
+
+        status = host_csritsv_buffer_size(
+            host_sparse_operation_none,
+            this->nrow_,
+            static_cast<PtrType>(this->nnz_),
+            host_sparse_fill_mode_upper,
+            (this->U_diag_unit_ ? host_sparse_diag_type_unit : host_sparse_diag_type_non_unit),
+            host_sparse_matrix_type_general,
+            this->mat_.val,
+            this->mat_.row_offset,
+            this->mat_.col,
+            &buffer_size);
+
+        if(!status)
+        {
+            LOG_INFO("ItUAnalyse() failed");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        // Check buffer size
+        if(this->mat_buffer_ != NULL && buffer_size > this->mat_buffer_size_)
+        {
+            free_host(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        if(this->mat_buffer_ == NULL)
+        {
+            this->mat_buffer_size_ = buffer_size;
+            allocate_host(buffer_size, &this->mat_buffer_);
+        }
+
+        assert(this->mat_buffer_size_ >= buffer_size);
+        assert(this->mat_buffer_ != NULL);
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::ItUAnalyseClear(void)
+    {
+        // Clear buffer
+        if(this->mat_buffer_ != NULL)
+        {
+            free_host(&this->mat_buffer_);
+            this->mat_buffer_ = NULL;
+        }
+
+        this->mat_buffer_size_ = 0;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ItUSolve(int                          max_iter,
+                                            double                       tolerance,
+                                            bool                         use_tol,
+                                            const BaseVector<ValueType>& in,
+                                            BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(out != NULL);
+            assert(this->ncol_ == this->nrow_);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            bool status;
+
+            int                               zero_pivot;
+            const ValueType                   alpha = static_cast<ValueType>(1);
+            const numeric_traits_t<ValueType> temp_tol
+                = static_cast<numeric_traits_t<ValueType>>(tolerance);
+
+            const numeric_traits_t<ValueType>* tol_ptr = (use_tol == false) ? nullptr : &temp_tol;
+
+            assert(this->nnz_ <= std::numeric_limits<int>::max());
+
+            // Solve U
+            status = host_csritsv_solve(
+                &max_iter,
+                tol_ptr,
+                nullptr,
+                host_sparse_operation_none,
+                this->nrow_,
+                static_cast<PtrType>(this->nnz_),
+                &alpha,
+                host_sparse_fill_mode_upper,
+                (this->U_diag_unit_ ? host_sparse_diag_type_unit : host_sparse_diag_type_non_unit),
+                host_sparse_matrix_type_general,
+                this->mat_.val,
+                this->mat_.row_offset,
+                this->mat_.col,
+                cast_in->vec_,
+                cast_out->vec_,
+                this->mat_buffer_,
+                &zero_pivot);
+
+            if(!status)
+            {
+                LOG_INFO("ItUSolve() failed");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+
+        return true;
+    }
+
+    // Algorithm for ILU factorization is based on
+    // Y. Saad, Iterative methods for sparse linear systems, 2nd edition, SIAM
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ILU0Factorize(void)
+    {
+        assert(this->nrow_ == this->ncol_);
+        assert(this->nnz_ > 0);
+
+        // pointer of upper part of each row
+        PtrType* diag_offset = NULL;
+        PtrType* nnz_entries = NULL;
+
+        allocate_host(this->nrow_, &diag_offset);
+        allocate_host(this->nrow_, &nnz_entries);
+
+        set_to_zero_host(this->nrow_, nnz_entries);
+
+        // ai = 0 to N loop over all rows
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            // ai-th row entries
+            PtrType row_start = this->mat_.row_offset[ai];
+            PtrType row_end   = this->mat_.row_offset[ai + 1];
+            PtrType j;
+
+            // nnz position of ai-th row in mat_.val array
+            for(j = row_start; j < row_end; ++j)
+            {
+                nnz_entries[this->mat_.col[j]] = j;
+            }
+
+            // loop over ai-th row nnz entries
+            for(j = row_start; j < row_end; ++j)
+            {
+                // if nnz entry is in lower matrix
+                if(this->mat_.col[j] < ai)
+                {
+                    int     col_j  = this->mat_.col[j];
+                    PtrType diag_j = diag_offset[col_j];
+
+                    if(this->mat_.val[diag_j] != static_cast<ValueType>(0))
+                    {
+                        // multiplication factor
+                        this->mat_.val[j] = this->mat_.val[j] / this->mat_.val[diag_j];
+
+                        // loop over upper offset pointer and do linear combination for nnz entry
+                        for(PtrType k = diag_j + 1; k < this->mat_.row_offset[col_j + 1]; ++k)
+                        {
+                            // if nnz at this position do linear combination
+                            if(nnz_entries[this->mat_.col[k]] != 0)
+                            {
+                                this->mat_.val[nnz_entries[this->mat_.col[k]]]
+                                    -= this->mat_.val[j] * this->mat_.val[k];
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            // set diagonal pointer to diagonal element
+            diag_offset[ai] = j;
+
+            // clear nnz entries
+            for(j = row_start; j < row_end; ++j)
+            {
+                nnz_entries[this->mat_.col[j]] = 0;
+            }
+        }
+
+        free_host(&diag_offset);
+        free_host(&nnz_entries);
+
+        return true;
+    }
+
+    // Algorithm for ILUT factorization is based on
+    // Y. Saad, Iterative methods for sparse linear systems, 2nd edition, SIAM
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ILUTFactorize(double t, int maxrow)
+    {
+        assert(this->nrow_ == this->ncol_);
+        assert(this->nnz_ > 0);
+
+        int nrow = this->nrow_;
+        int ncol = this->ncol_;
+
+        int64_t nnz = std::min(2 * maxrow, nrow) * nrow;
+
+        int remaining_nnz = nnz;
+
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
+
+        allocate_host(nrow + 1, &row_offset);
+        allocate_host(nnz, &col);
+        allocate_host(nnz, &val);
+
+        void*    buffer            = NULL;
+        PtrType* temp_pivot_buffer = NULL;
+
+        ILUTDriverCSR<ValueType, int> driver(nrow, nrow);
+
+        buffer = (void*)malloc(driver.buffer_size());
+        driver.set_buffer(buffer);
+
+        allocate_host(nrow, &temp_pivot_buffer);
+        memset(temp_pivot_buffer, 0, sizeof(PtrType) * nrow);
+
+        // initialize row ptr B
+        row_offset[0] = 0;
+
+        // for each row
+        for(int i = 0; i < nrow; i++)
+        {
+            PtrType row_begin = mat_.row_offset[i];
+            PtrType row_end   = mat_.row_offset[i + 1];
+            PtrType row_size  = row_end - row_begin;
+
+            // Initialize working structure
+            driver.initialize(&mat_.val[row_begin], &mat_.col[row_begin], row_size, 0, i);
+
+            ValueType k_val;
+            int       k_col;
+
+            // for each column in row i under the diagonal
+            while(driver.next_lower(k_col, k_val))
+            {
+                //find the index of element k, k in the upper matrix
+                PtrType pivot_index;
+                if((pivot_index = temp_pivot_buffer[k_col]) <= 0)
+                {
+                    // zero pivot
+                    continue;
+                }
+                pivot_index--;
+
+                // get the coefficient to perform row(i) = row(i) - factor * row(k)
+                // factor = a(i, k) / a(k, k)
+                ValueType factor = static_cast<ValueType>(1) / val[pivot_index];
+
+                factor = factor * k_val;
+
+                if(std::abs(factor) > std::abs(t))
+                {
+                    // put pivot in lower matrix; put in a(i, k)
+                    driver.save_lower(factor);
+
+                    // subtract row(k) from row(i); perform row(i) = row(i) - pivot * row(k)
+                    // for each non-zero element in row k after column k
+                    for(PtrType subtrahend_index = pivot_index + 1;
+                        subtrahend_index < row_offset[k_col + 1];
+                        subtrahend_index++)
+                    {
+                        // a(i, j) = a(i, j) - pivot * a(k, j)
+                        int       column     = col[subtrahend_index];
+                        ValueType val_to_add = -factor * val[subtrahend_index];
+
+                        driver.add_to_element(column, val_to_add);
+                    }
+                }
+            }
+
+            // filter elements
+            driver.trim(t, maxrow);
+
+            // store elements
+            int store_size = driver.row_size();
+
+            if(remaining_nnz < store_size)
+            {
+                nnz += static_cast<size_t>(nnz * 1.5f);
+                remaining_nnz += static_cast<size_t>(nnz * 1.5f);
+
+                LOG_INFO("ILUTFactorize reallocating");
+
+                int*       col_tmp = (int*)realloc(col, nnz * sizeof(int));
+                ValueType* val_tmp = (ValueType*)realloc(val, nnz * sizeof(ValueType));
+
+                if(col_tmp == NULL || val_tmp == NULL)
+                {
+                    free(col);
+                    free(val);
+
+                    LOG_INFO("ILUTFactorize failed on realloc");
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+                else
+                {
+                    col = col_tmp;
+                    val = val_tmp;
+                }
+            }
+
+            int diag_in;
+            if(driver.store_row(&val[row_offset[i]], &col[row_offset[i]], diag_in))
+            {
+                temp_pivot_buffer[i] = row_offset[i] + diag_in + 1;
+            }
+            else
+            {
+                LOG_INFO("(ILUT) zero row");
+            }
+
+            row_offset[i + 1] = row_offset[i] + store_size;
+            remaining_nnz -= store_size;
+        }
+
+        free(buffer);
+        free(temp_pivot_buffer);
+
+        // pinned memory
+        int*       p_col = NULL;
+        ValueType* p_val = NULL;
+
+        nnz = row_offset[nrow];
+
+        allocate_host(nnz, &p_col);
+        allocate_host(nnz, &p_val);
+
+        copy_h2h(nnz, col, p_col);
+        copy_h2h(nnz, val, p_val);
+
+        free(col);
+        free(val);
+
+        this->Clear();
+        this->SetDataPtrCSR(&row_offset, &p_col, &p_val, nnz, nrow, ncol);
+
+        this->Sort();
+
+        return true;
+    }
+
+    // Algorithm for the fixed-point ILU0 factorization is based on
+    // E. Chow, A. Patel, Fine-grained parallel incomplete LU factorization, SIAM J. Sci.
+    // Comput. 37(2), 2015
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ItILU0Factorize(ItILU0Algorithm alg,
+                                                   int             option,
+                                                   int             max_iter,
+                                                   double          tolerance,
+                                                   int*            niter,
+                                                   double*         history)
+    {
+        assert(this->nrow_ == this->ncol_);
+        assert(this->nnz_ > 0);
+        assert(niter != NULL);
+
+        int            nrow       = this->nrow_;
+        const PtrType* row_offset = this->mat_.row_offset;
+        const int*     col        = this->mat_.col;
+
+        bool stop    = (option & ItILU0Option::StoppingCriteria) > 0;
+        bool verbose = (option & ItILU0Option::Verbose) > 0;
+
+        // The synchronous variants read the previous sweep only, the asynchronous ones
+        // read the latest values of the rows of their own chunk
+        bool async
+            = (alg != ItILU0Algorithm::SyncSplit) && (alg != ItILU0Algorithm::SyncSplitFusion);
+
+        _set_omp_backend_threads(this->local_backend_, nrow);
+
+        // Position of the diagonal entries
+        std::vector<PtrType> diag(nrow);
+        bool                 missing_diag = false;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(|| : missing_diag)
+#endif
+        for(int ai = 0; ai < nrow; ++ai)
+        {
+            const int* begin = col + row_offset[ai];
+            const int* end   = col + row_offset[ai + 1];
+            const int* pos   = std::lower_bound(begin, end, ai);
+
+            if(pos == end || *pos != ai)
+            {
+                missing_diag = true;
+            }
+            else
+            {
+                diag[ai] = pos - col;
+            }
+        }
+
+        if(missing_diag == true)
+        {
+            return false;
+        }
+
+        // The sweeps start from the values of A
+        std::vector<ValueType> val(this->mat_.val, this->mat_.val + this->nnz_);
+        std::vector<ValueType> prev(this->nnz_);
+
+        ValueType*       cur  = this->mat_.val;
+        const ValueType* last = prev.data();
+
+        niter[0] = 0;
+
+        for(int iter = 0; iter < max_iter; ++iter)
+        {
+            copy_h2h(this->nnz_, cur, prev.data());
+
+            double nrm_corr = 0.0;
+            double nrm_res  = 0.0;
+            double nrm_val  = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(max : nrm_corr, nrm_res, nrm_val)
+#endif
+            {
+                // nnz balanced chunk of rows for this thread
+                int nt  = omp_get_num_threads();
+                int tid = omp_get_thread_num();
+
+                int row_beg = csr_balanced_row_begin(nrow, row_offset, tid, nt);
+                int row_end = csr_balanced_row_begin(nrow, row_offset, tid + 1, nt);
+
+                for(int ai = row_beg; ai < row_end; ++ai)
+                {
+                    const ValueType* own = (async == true) ? cur : last;
+
+                    for(PtrType aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+                    {
+                        int       j   = col[aj];
+                        int       m   = std::min(ai, j);
+                        ValueType sum = val[aj];
+
+                        // sum -= l_ik * u_kj for all k < min(i, j)
+                        for(PtrType ak = row_offset[ai]; ak < row_offset[ai + 1] && col[ak] < m;
+                            ++ak)
+                        {
+                            int k = col[ak];
+
+                            const int* begin = col + diag[k];
+                            const int* end   = col + row_offset[k + 1];
+                            const int* pos   = std::lower_bound(begin, end, j);
+
+                            if(pos != end && *pos == j)
+                            {
+                                const ValueType* src
+                                    = (async == true && k >= row_beg && k < row_end) ? cur : last;
+
+                                sum -= own[ak] * src[pos - col];
+                            }
+                        }
+
+                        ValueType x;
+
+                        if(ai > j)
+                        {
+                            // l_ij
+                            const ValueType* src
+                                = (async == true && j >= row_beg && j < row_end) ? cur : last;
+                            ValueType u_jj = src[diag[j]];
+
+                            if(u_jj == static_cast<ValueType>(0))
+                            {
+                                continue;
+                            }
+
+                            nrm_res = std::max(
+                                nrm_res, static_cast<double>(std::abs(sum - last[aj] * u_jj)));
+
+                            x = sum / u_jj;
+                        }
+                        else
+                        {
+                            // u_ij
+                            nrm_res
+                                = std::max(nrm_res, static_cast<double>(std::abs(sum - last[aj])));
+
+                            x = sum;
+                        }
+
+                        nrm_corr = std::max(nrm_corr, static_cast<double>(std::abs(x - last[aj])));
+                        nrm_val  = std::max(nrm_val, static_cast<double>(std::abs(x)));
+
+                        cur[aj] = x;
+                    }
+                }
+            }
+
+            // Correction relative to the factors
+            nrm_corr = (nrm_val > 0.0) ? nrm_corr / nrm_val : nrm_corr;
+
+            if(history != NULL)
+            {
+                history[2 * iter]     = nrm_corr;
+                history[2 * iter + 1] = nrm_res;
+            }
+
+            if(verbose == true)
+            {
+                LOG_INFO("ItILU0 iteration " << iter + 1 << " correction " << nrm_corr
+                                             << " residual " << nrm_res);
+            }
+
+            niter[0] = iter + 1;
+
+            if(stop == true && nrm_corr <= tolerance)
+            {
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ICFactorize(BaseVector<ValueType>* inv_diag)
+    {
+        assert(this->nrow_ == this->ncol_);
+        assert(this->nnz_ > 0);
+
+        assert(inv_diag != NULL);
+        HostVector<ValueType>* cast_diag = dynamic_cast<HostVector<ValueType>*>(inv_diag);
+        assert(cast_diag != NULL);
+
+        cast_diag->Allocate(this->nrow_);
+
+        PtrType* diag_offset = NULL;
+        PtrType* nnz_entries = NULL;
+
+        allocate_host(this->nrow_, &diag_offset);
+        allocate_host(this->nrow_, &nnz_entries);
+
+        set_to_zero_host(this->nrow_, nnz_entries);
+
+        // i=0,..n
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            PtrType row_begin = this->mat_.row_offset[i];
+            PtrType row_end   = this->mat_.row_offset[i + 1];
+
+            for(PtrType j = row_begin; j < row_end; ++j)
+            {
+                nnz_entries[this->mat_.col[j]] = j;
+            }
+
+            ValueType sum = static_cast<ValueType>(0);
+
+            bool has_diag = false;
+
+            // j=0,..i
+            PtrType j;
+            for(j = row_begin; j < row_end; ++j)
+            {
+                int       col_j = this->mat_.col[j];
+                ValueType val_j = this->mat_.val[j];
+
+                // Mark diagonal and skip row
+                if(col_j == i)
+                {
+                    has_diag = true;
+                    break;
+                }
+
+                // Skip upper triangular
+                if(col_j > i)
+                {
+                    break;
+                }
+
+                PtrType row_begin_j = this->mat_.row_offset[col_j];
+                PtrType row_diag_j  = diag_offset[col_j];
+
+                ValueType local_sum = static_cast<ValueType>(0);
+                ValueType inv_diag  = this->mat_.val[row_diag_j];
+
+                // Check for numeric zero
+                if(inv_diag == static_cast<ValueType>(0))
+                {
+                    LOG_INFO("IC breakdown: division by zero");
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                inv_diag = static_cast<ValueType>(1) / inv_diag;
+
+                for(PtrType k = row_begin_j; k < row_diag_j; ++k)
+                {
+                    int col_k = this->mat_.col[k];
+
+                    if(nnz_entries[col_k] != 0)
+                    {
+                        PtrType idx = nnz_entries[col_k];
+                        local_sum += this->mat_.val[k] * this->mat_.val[idx];
+                    }
+                }
+
+                val_j = (val_j - local_sum) * inv_diag;
+                sum += val_j * val_j;
+
+                this->mat_.val[j] = val_j;
+            }
+
+            if(!has_diag)
+            {
+                // Structural zero
+                LOG_INFO("IC breakdown: structural zero diagonal");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            // Process diagonal entry
+            ValueType diag_entry = std::sqrt(std::abs(this->mat_.val[j] - sum));
+            this->mat_.val[j]    = diag_entry;
+
+            // Check for numerical zero
+            if(diag_entry == static_cast<ValueType>(0))
+            {
+                LOG_INFO("IC breakdown: division by zero");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            // Store inverse diagonal entry
+            cast_diag->vec_[i] = static_cast<ValueType>(1) / diag_entry;
+
+            // Store diagonal offset
+            diag_offset[i] = j;
+
+            // Clear nnz entries
+            for(j = row_begin; j < row_end; ++j)
+            {
+                nnz_entries[this->mat_.col[j]] = 0;
+            }
+        }
+
+        // Free temporary storage
+        free_host(&diag_offset);
+        free_host(&nnz_entries);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::MultiColoring(int&             num_colors,
+                                                 int**            size_colors,
+                                                 BaseVector<int>* permutation) const
+    {
+        assert(*size_colors == NULL);
+        assert(permutation != NULL);
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        /*
+        *   Create CSC
+        */
+        PtrType* csc_ptr = NULL;
+        int*     csc_ind = NULL;
+
+        allocate_host(this->ncol_ + 1, &csc_ptr);
+        allocate_host(this->nnz_, &csc_ind);
+
+        set_to_zero_host(this->nrow_ + 1, csc_ptr);
+
+        for(PtrType i = 0; i < this->nnz_; ++i)
+        {
+            csc_ptr[this->mat_.col[i] + 1] += 1;
+        }
+
+        for(int i = 1; i < this->nrow_ + 1; ++i)
+        {
+            csc_ptr[i] += csc_ptr[i - 1];
+        }
+
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            for(PtrType k = this->mat_.row_offset[i]; k < this->mat_.row_offset[i + 1]; ++k)
+            {
+                csc_ind[csc_ptr[this->mat_.col[k]]++] = i;
+            }
+        }
+        for(int i = this->nrow_; i > 0; --i)
+        {
+            csc_ptr[i] = csc_ptr[i - 1];
+        }
+        csc_ptr[0] = 0;
+
+        // node colors (init value = 0 i.e. no color)
+        int* color = NULL;
+        allocate_host(this->nrow_, &color);
+
+        memset(color, 0, sizeof(int) * this->nrow_);
+        num_colors = 0;
+        std::vector<bool> row_col;
+
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            color[ai] = 1;
+            row_col.clear();
+            row_col.reserve(num_colors + 2);
+            row_col.assign(num_colors + 2, false);
+
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai != this->mat_.col[aj])
+                {
+                    row_col[color[this->mat_.col[aj]]] = true;
+                }
+            }
+
+            for(PtrType aj = csc_ptr[ai]; aj < csc_ptr[ai + 1]; ++aj)
+            {
+                if(ai != csc_ind[aj])
+                {
+                    row_col[color[csc_ind[aj]]] = true;
+                }
+            }
+
+            PtrType count = this->mat_.row_offset[ai + 1] - this->mat_.row_offset[ai]
+                            + csc_ptr[ai + 1] - csc_ptr[ai];
+
+            for(PtrType aj = 0; aj < count; ++aj)
+            {
+                if(row_col[color[ai]] == true)
+                {
+                    ++color[ai];
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            if(color[ai] > num_colors)
+            {
+                num_colors = color[ai];
+            }
+        }
+
+        free_host(&csc_ptr);
+        free_host(&csc_ind);
+
+        allocate_host(num_colors, size_colors);
+        set_to_zero_host(num_colors, *size_colors);
+
+        int* offsets_color = NULL;
+        allocate_host(num_colors, &offsets_color);
+        memset(offsets_color, 0, sizeof(int) * num_colors);
+
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            ++(*size_colors)[color[i] - 1];
+        }
+
+        int total = 0;
+        for(int i = 1; i < num_colors; ++i)
+        {
+            total += (*size_colors)[i - 1];
+            offsets_color[i] = total;
+            //   LOG_INFO("offsets = " << total);
+        }
+
+        cast_perm->Allocate(this->nrow_);
+
+        for(int i = 0; i < permutation->GetSize(); ++i)
+        {
+            cast_perm->vec_[i] = offsets_color[color[i] - 1];
+            ++offsets_color[color[i] - 1];
+        }
+
+        free_host(&color);
+        free_host(&offsets_color);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::MaximalIndependentSet(int&             size,
+                                                         BaseVector<int>* permutation) const
+    {
+        assert(permutation != NULL);
+        assert(this->nrow_ == this->ncol_);
+
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        int* mis = NULL;
+        allocate_host(this->nrow_, &mis);
+        memset(mis, 0, sizeof(int) * this->nrow_);
+
+        size = 0;
+
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            if(mis[ai] == 0)
+            {
+                // set the node
+                mis[ai] = 1;
+                ++size;
+
+                // remove all nbh nodes (without diagonal)
+                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
+                    ++aj)
+                {
+                    if(ai != this->mat_.col[aj])
+                    {
+                        mis[this->mat_.col[aj]] = -1;
+                    }
+                }
+            }
+        }
+
+        cast_perm->Allocate(this->nrow_);
+
+        int pos = 0;
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            if(mis[ai] == 1)
+            {
+                cast_perm->vec_[ai] = pos;
+                ++pos;
+            }
+            else
+            {
+                cast_perm->vec_[ai] = size + ai - pos;
+            }
+        }
+
+        // Check the permutation
+        //
+        //  for (int ai=0; ai<this->nrow_; ++ai) {
+        //    assert( cast_perm->vec_[ai] >= 0 );
+        //    assert( cast_perm->vec_[ai] < this->nrow_ );
+        //  }
+
+        free_host(&mis);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ZeroBlockPermutation(int&             size,
+                                                        BaseVector<int>* permutation) const
+    {
+        assert(permutation != NULL);
+        assert(permutation->GetSize() == this->nrow_);
+        assert(permutation->GetSize() == this->ncol_);
+
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        size = 0;
+
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai == this->mat_.col[aj])
+                {
+                    ++size;
+                }
+            }
+        }
+
+        int k_z  = size;
+        int k_nz = 0;
+
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            bool hit = false;
+
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai == this->mat_.col[aj])
+                {
+                    cast_perm->vec_[ai] = k_nz;
+                    ++k_nz;
+                    hit = true;
+                }
+            }
+
+            if(hit == false)
+            {
+                cast_perm->vec_[ai] = k_z;
+                ++k_z;
+            }
+        }
+
+        return true;
+    }
+
+    // following R.E.Bank and C.C.Douglas paper
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::SymbolicMatMatMult(const BaseMatrix<ValueType>& src)
+    {
+        const HostMatrixCSR<ValueType>* cast_mat
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&src);
+
+        assert(cast_mat != NULL);
+        assert(this->ncol_ == cast_mat->nrow_);
+
+        std::vector<PtrType> row_offset;
+        std::vector<int>*    new_col = new std::vector<int>[this->nrow_];
+
+        row_offset.resize(this->nrow_ + 1);
+
+        row_offset[0] = 0;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            // loop over the row
+            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                int ii = this->mat_.col[j];
+
+                // loop corresponding row
+                for(PtrType k = cast_mat->mat_.row_offset[ii];
+                    k < cast_mat->mat_.row_offset[ii + 1];
+                    ++k)
+                {
+                    new_col[i].push_back(cast_mat->mat_.col[k]);
+                }
+            }
+
+            std::sort(new_col[i].begin(), new_col[i].end());
+            new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()), new_col[i].end());
+
+            row_offset[i + 1] = static_cast<PtrType>(new_col[i].size());
+        }
+
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            row_offset[i + 1] += row_offset[i];
+        }
+
+        this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+
+        copy_h2h(this->nrow_ + 1, row_offset.data(), this->mat_.row_offset);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            PtrType jj = 0;
+            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                this->mat_.col[j] = new_col[i][jj];
+                ++jj;
+            }
+        }
+
+        //#ifdef _OPENMP
+        //#pragma omp parallel for
+        //#endif
+        //  for (int64_t i=0; i<this->nnz_; ++i)
+        //    this->mat_.val[i] = static_cast<ValueType>(1);
+
+        delete[] new_col;
+
+        return true;
+    }
+
+    // ----------------------------------------------------------
+    // original function prod(const spmat1 &A, const spmat2 &B)
+    // ----------------------------------------------------------
+    // Modified and adapted from AMGCL,
+    // https://github.com/ddemidov/amgcl
+    // MIT License
+    // ----------------------------------------------------------
+    // CHANGELOG
+    // - adapted interface
+    // sorting is added
+    // ----------------------------------------------------------
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::MatMatMult(const BaseMatrix<ValueType>& A,
+                                              const BaseMatrix<ValueType>& B)
+    {
+        assert((this != &A) && (this != &B));
+
+        //  this->SymbolicMatMatMult(A, B);
+        //  this->NumericMatMatMult (A, B);
+        //
+        //  return true;
+
+        const HostMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+        const HostMatrixCSR<ValueType>* cast_mat_B
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
+
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_B != NULL);
+        assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
+
+        int n = cast_mat_A->nrow_;
+        int m = cast_mat_B->ncol_;
+
+        PtrType* row_offset = NULL;
+        allocate_host(n + 1, &row_offset);
+        int*       col = NULL;
+        ValueType* val = NULL;
+
+        set_to_zero_host(n + 1, row_offset);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<PtrType> marker(m, -1);
+
+#ifdef _OPENMP
+            int nt  = omp_get_num_threads();
+            int tid = omp_get_thread_num();
+
+            int chunk_size  = (n + nt - 1) / nt;
+            int chunk_start = tid * chunk_size;
+            int chunk_end   = std::min(n, chunk_start + chunk_size);
+#else
+            int chunk_start = 0;
+            int chunk_end   = n;
+#endif
+
+            for(int ia = chunk_start; ia < chunk_end; ++ia)
+            {
+                for(PtrType ja = cast_mat_A->mat_.row_offset[ia],
+                            ea = cast_mat_A->mat_.row_offset[ia + 1];
+                    ja < ea;
+                    ++ja)
+                {
+                    int ca = cast_mat_A->mat_.col[ja];
+                    for(PtrType jb = cast_mat_B->mat_.row_offset[ca],
+                                eb = cast_mat_B->mat_.row_offset[ca + 1];
+                        jb < eb;
+                        ++jb)
+                    {
+                        int cb = cast_mat_B->mat_.col[jb];
+
+                        if(marker[cb] != ia)
+                        {
+                            marker[cb] = ia;
+                            ++row_offset[ia + 1];
+                        }
+                    }
+                }
+            }
+
+            std::fill(marker.begin(), marker.end(), -1);
+
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+#ifdef _OPENMP
+#pragma omp single
+#endif
+            {
+                for(int i = 1; i < n + 1; ++i)
+                {
+                    row_offset[i] += row_offset[i - 1];
+                }
+
+                allocate_host(row_offset[n], &col);
+                allocate_host(row_offset[n], &val);
+            }
+
+            for(int ia = chunk_start; ia < chunk_end; ++ia)
+            {
+                PtrType row_begin = row_offset[ia];
+                PtrType row_end   = row_begin;
+
+                for(PtrType ja = cast_mat_A->mat_.row_offset[ia],
+                            ea = cast_mat_A->mat_.row_offset[ia + 1];
+                    ja < ea;
+                    ++ja)
+                {
+                    int       ca = cast_mat_A->mat_.col[ja];
+                    ValueType va = cast_mat_A->mat_.val[ja];
+
+                    for(PtrType jb = cast_mat_B->mat_.row_offset[ca],
+                                eb = cast_mat_B->mat_.row_offset[ca + 1];
+                        jb < eb;
+                        ++jb)
+                    {
+                        int       cb = cast_mat_B->mat_.col[jb];
+                        ValueType vb = cast_mat_B->mat_.val[jb];
+
+                        if(marker[cb] < row_begin)
+                        {
+                            marker[cb]   = row_end;
+                            col[row_end] = cb;
+                            val[row_end] = va * vb;
+                            ++row_end;
+                        }
+                        else
+                        {
+                            val[marker[cb]] += va * vb;
+                        }
+                    }
+                }
+            }
+        }
+
+        this->SetDataPtrCSR(
+            &row_offset, &col, &val, row_offset[n], cast_mat_A->nrow_, cast_mat_B->ncol_);
+
+        // Sorting the col (per row)
+        this->Sort();
+
+        return true;
+    }
+
+    // following R.E.Bank and C.C.Douglas paper
+    // this = A * B
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::SymbolicMatMatMult(const BaseMatrix<ValueType>& A,
+                                                      const BaseMatrix<ValueType>& B)
+    {
+        const HostMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+        const HostMatrixCSR<ValueType>* cast_mat_B
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
+
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_B != NULL);
+        assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
+
+        std::vector<PtrType> row_offset;
+        std::vector<int>*    new_col = new std::vector<int>[cast_mat_A->nrow_];
+
+        row_offset.resize(cast_mat_A->nrow_ + 1);
+
+        row_offset[0] = 0;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < cast_mat_A->nrow_; ++i)
+        {
+            // loop over the row
+            for(PtrType j = cast_mat_A->mat_.row_offset[i]; j < cast_mat_A->mat_.row_offset[i + 1];
+                ++j)
+            {
+                int ii = cast_mat_A->mat_.col[j];
+                //      new_col[i].push_back(ii);
+
+                // loop corresponding row
+                for(PtrType k = cast_mat_B->mat_.row_offset[ii];
+                    k < cast_mat_B->mat_.row_offset[ii + 1];
+                    ++k)
+                {
+                    new_col[i].push_back(cast_mat_B->mat_.col[k]);
+                }
+            }
+
+            std::sort(new_col[i].begin(), new_col[i].end());
+            new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()), new_col[i].end());
+
+            row_offset[i + 1] = static_cast<PtrType>(new_col[i].size());
+        }
+
+        for(int i = 0; i < cast_mat_A->nrow_; ++i)
+        {
+            row_offset[i + 1] += row_offset[i];
+        }
+
+        this->AllocateCSR(row_offset[cast_mat_A->nrow_], cast_mat_A->nrow_, cast_mat_B->ncol_);
+
+        copy_h2h(cast_mat_A->nrow_ + 1, row_offset.data(), this->mat_.row_offset);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < cast_mat_A->nrow_; ++i)
+        {
+            PtrType jj = 0;
+            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                this->mat_.col[j] = new_col[i][jj];
+                ++jj;
+            }
+        }
+
+        //#ifdef _OPENMP
+        //#pragma omp parallel for
+        //#endif
+        //      for (int64_t i=0; i<this->nnz_; ++i)
+        //      this->mat_.val[i] = static_cast<ValueType>(1);
+
+        delete[] new_col;
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::NumericMatMatMult(const BaseMatrix<ValueType>& A,
+                                                     const BaseMatrix<ValueType>& B)
+    {
+        const HostMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+        const HostMatrixCSR<ValueType>* cast_mat_B
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
+
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_B != NULL);
+        assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
+        assert(this->nrow_ == cast_mat_A->nrow_);
+        assert(this->ncol_ == cast_mat_B->ncol_);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // Position of each column in the current row of this, -1 if not present
+            std::vector<PtrType> pos(this->ncol_, -1);
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int i = 0; i < cast_mat_A->nrow_; ++i)
+            {
+                PtrType row_begin = this->mat_.row_offset[i];
+                PtrType row_end   = this->mat_.row_offset[i + 1];
+
+                for(PtrType p = row_begin; p < row_end; ++p)
+                {
+                    pos[this->mat_.col[p]] = p;
+                    this->mat_.val[p]      = static_cast<ValueType>(0);
+                }
+
+                // loop over the row
+                for(PtrType j = cast_mat_A->mat_.row_offset[i];
+                    j < cast_mat_A->mat_.row_offset[i + 1];
+                    ++j)
+                {
+                    int       ii    = cast_mat_A->mat_.col[j];
+                    ValueType val_j = cast_mat_A->mat_.val[j];
+
+                    // loop corresponding row
+                    for(PtrType k = cast_mat_B->mat_.row_offset[ii];
+                        k < cast_mat_B->mat_.row_offset[ii + 1];
+                        ++k)
+                    {
+                        PtrType p = pos[cast_mat_B->mat_.col[k]];
+
+                        // Entries outside of the given structure are dropped
+                        if(p >= 0)
+                        {
+                            this->mat_.val[p] += val_j * cast_mat_B->mat_.val[k];
+                        }
+                    }
+                }
+
+                for(PtrType p = row_begin; p < row_end; ++p)
+                {
+                    pos[this->mat_.col[p]] = -1;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // this = R * A * P, computed row by row without forming R * A or A * P
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::TripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                                    const BaseMatrix<ValueType>& A,
+                                                    const BaseMatrix<ValueType>& P)
+    {
+        assert((this != &R) && (this != &A) && (this != &P));
+
+        const HostMatrixCSR<ValueType>* cast_mat_R
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&R);
+        const HostMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+        const HostMatrixCSR<ValueType>* cast_mat_P
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&P);
+
+        assert(cast_mat_R != NULL);
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_P != NULL);
+        assert(cast_mat_R->ncol_ == cast_mat_A->nrow_);
+        assert(cast_mat_A->ncol_ == cast_mat_P->nrow_);
+
+        int m = cast_mat_R->nrow_;
+        int n = cast_mat_P->ncol_;
+
+        PtrType* row_offset = NULL;
+        allocate_host(m + 1, &row_offset);
+        int*       col = NULL;
+        ValueType* val = NULL;
+
+        set_to_zero_host(m + 1, row_offset);
+
+        _set_omp_backend_threads(this->local_backend_, m);
+
+        // Count the entries of each row
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<int> marker(n, -1);
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int i = 0; i < m; ++i)
+            {
+                for(PtrType r = cast_mat_R->mat_.row_offset[i];
+                    r < cast_mat_R->mat_.row_offset[i + 1];
+                    ++r)
+                {
+                    int cr = cast_mat_R->mat_.col[r];
+
+                    for(PtrType a = cast_mat_A->mat_.row_offset[cr];
+                        a < cast_mat_A->mat_.row_offset[cr + 1];
+                        ++a)
+                    {
+                        int ca = cast_mat_A->mat_.col[a];
+
+                        for(PtrType p = cast_mat_P->mat_.row_offset[ca];
+                            p < cast_mat_P->mat_.row_offset[ca + 1];
+                            ++p)
+                        {
+                            int cp = cast_mat_P->mat_.col[p];
+
+                            if(marker[cp] != i)
+                            {
+                                marker[cp] = i;
+                                ++row_offset[i + 1];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        for(int i = 1; i < m + 1; ++i)
+        {
+            row_offset[i] += row_offset[i - 1];
+        }
+
+        allocate_host(row_offset[m], &col);
+        allocate_host(row_offset[m], &val);
+
+        // Accumulate the products, the rows of each thread are processed in increasing
+        // order such that marker entries of previous rows are below row_begin
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<PtrType> marker(n, -1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for(int i = 0; i < m; ++i)
+            {
+                PtrType row_begin = row_offset[i];
+                PtrType row_end   = row_begin;
+
+                for(PtrType r = cast_mat_R->mat_.row_offset[i];
+                    r < cast_mat_R->mat_.row_offset[i + 1];
+                    ++r)
+                {
+                    int       cr = cast_mat_R->mat_.col[r];
+                    ValueType vr = cast_mat_R->mat_.val[r];
+
+                    for(PtrType a = cast_mat_A->mat_.row_offset[cr];
+                        a < cast_mat_A->mat_.row_offset[cr + 1];
+                        ++a)
+                    {
+                        int       ca = cast_mat_A->mat_.col[a];
+                        ValueType va = vr * cast_mat_A->mat_.val[a];
+
+                        for(PtrType p = cast_mat_P->mat_.row_offset[ca];
+                            p < cast_mat_P->mat_.row_offset[ca + 1];
+                            ++p)
+                        {
+                            int       cp = cast_mat_P->mat_.col[p];
+                            ValueType vp = va * cast_mat_P->mat_.val[p];
+
+                            if(marker[cp] < row_begin)
+                            {
+                                marker[cp]   = row_end;
+                                col[row_end] = cp;
+                                val[row_end] = vp;
+                                ++row_end;
+                            }
+                            else
+                            {
+                                val[marker[cp]] += vp;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        this->SetDataPtrCSR(&row_offset, &col, &val, row_offset[m], m, n);
+
+        // Sorting the col (per row)
+        this->Sort();
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::NumericTripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                                           const BaseMatrix<ValueType>& A,
+                                                           const BaseMatrix<ValueType>& P)
+    {
+        const HostMatrixCSR<ValueType>* cast_mat_R
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&R);
+        const HostMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+        const HostMatrixCSR<ValueType>* cast_mat_P
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&P);
+
+        assert(cast_mat_R != NULL);
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_P != NULL);
+
+        this->NumericTripleMatMatMult_(*cast_mat_R, *cast_mat_A, *cast_mat_P, NULL);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::NumericTripleMatMatMultRows(const BaseMatrix<ValueType>& R,
+                                                               const BaseMatrix<ValueType>& A,
+                                                               const BaseMatrix<ValueType>& P,
+                                                               const BaseVector<bool>&      rows)
+    {
+        const HostMatrixCSR<ValueType>* cast_mat_R
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&R);
+        const HostMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+        const HostMatrixCSR<ValueType>* cast_mat_P
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&P);
+        const HostVector<bool>* cast_rows = dynamic_cast<const HostVector<bool>*>(&rows);
+
+        assert(cast_mat_R != NULL);
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_P != NULL);
+        assert(cast_rows != NULL);
+        assert(cast_rows->size_ == this->nrow_);
+
+        this->NumericTripleMatMatMult_(*cast_mat_R, *cast_mat_A, *cast_mat_P, cast_rows->vec_);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    void HostMatrixCSR<ValueType>::NumericTripleMatMatMult_(const HostMatrixCSR<ValueType>& R,
+                                                            const HostMatrixCSR<ValueType>& A,
+                                                            const HostMatrixCSR<ValueType>& P,
+                                                            const bool*                     rows)
+    {
+        assert(R.ncol_ == A.nrow_);
+        assert(A.ncol_ == P.nrow_);
+        assert(this->nrow_ == R.nrow_);
+        assert(this->ncol_ == P.ncol_);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // Position of each column in the current row of this, -1 if not present
+            std::vector<PtrType> pos(this->ncol_, -1);
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                // Rows that are not flagged keep their values
+                if(rows != NULL && rows[i] == false)
+                {
+                    continue;
+                }
+
+                PtrType row_begin = this->mat_.row_offset[i];
+                PtrType row_end   = this->mat_.row_offset[i + 1];
+
+                for(PtrType j = row_begin; j < row_end; ++j)
+                {
+                    pos[this->mat_.col[j]] = j;
+                    this->mat_.val[j]      = static_cast<ValueType>(0);
+                }
+
+                for(PtrType r = R.mat_.row_offset[i]; r < R.mat_.row_offset[i + 1]; ++r)
+                {
+                    int       cr = R.mat_.col[r];
+                    ValueType vr = R.mat_.val[r];
+
+                    for(PtrType a = A.mat_.row_offset[cr]; a < A.mat_.row_offset[cr + 1]; ++a)
+                    {
+                        int       ca = A.mat_.col[a];
+                        ValueType va = vr * A.mat_.val[a];
+
+                        for(PtrType p = P.mat_.row_offset[ca]; p < P.mat_.row_offset[ca + 1]; ++p)
+                        {
+                            PtrType j = pos[P.mat_.col[p]];
+
+                            // Entries outside of the given structure are dropped
+                            if(j >= 0)
+                            {
+                                this->mat_.val[j] += va * P.mat_.val[p];
+                            }
+                        }
+                    }
+                }
+
+                for(PtrType j = row_begin; j < row_end; ++j)
+                {
+                    pos[this->mat_.col[j]] = -1;
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::SymbolicPower(int p)
+    {
+        assert(p > 1);
+
+        // The optimal values for the firsts values
+
+        if(p == 2)
+        {
+            this->SymbolicMatMatMult(*this);
+        }
+
+        if(p == 3)
+        {
+            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+            tmp.CopyFrom(*this);
+
+            this->SymbolicPower(2);
+            this->SymbolicMatMatMult(tmp);
+        }
+
+        if(p == 4)
+        {
+            this->SymbolicPower(2);
+            this->SymbolicPower(2);
+        }
+
+        if(p == 5)
+        {
+            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+            tmp.CopyFrom(*this);
+
+            this->SymbolicPower(4);
+            this->SymbolicMatMatMult(tmp);
+        }
+
+        if(p == 6)
+        {
+            this->SymbolicPower(2);
+            this->SymbolicPower(3);
+        }
+
+        if(p == 7)
+        {
+            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+            tmp.CopyFrom(*this);
+
+            this->SymbolicPower(6);
+            this->SymbolicMatMatMult(tmp);
+        }
+
+        if(p == 8)
+        {
+            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+            tmp.CopyFrom(*this);
+
+            this->SymbolicPower(6);
+            tmp.SymbolicPower(2);
+
+            this->SymbolicMatMatMult(tmp);
+        }
+
+        if(p > 8)
+        {
+            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+            tmp.CopyFrom(*this);
+
+            for(int i = 0; i < p; ++i)
+            {
+                this->SymbolicMatMatMult(tmp);
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ILUpFactorizeNumeric(int p, const BaseMatrix<ValueType>& mat)
+    {
+        const HostMatrixCSR<ValueType>* cast_mat
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
+
+        assert(cast_mat != NULL);
+        assert(cast_mat->nrow_ == this->nrow_);
+        assert(cast_mat->ncol_ == this->ncol_);
+        assert(this->nnz_ > 0);
+        assert(cast_mat->nnz_ > 0);
+
+        PtrType*   row_offset = NULL;
+        PtrType*   ind_diag   = NULL;
+        int*       levels     = NULL;
+        ValueType* val        = NULL;
+
+        allocate_host(cast_mat->nrow_ + 1, &row_offset);
+        allocate_host(cast_mat->nrow_, &ind_diag);
+        allocate_host(cast_mat->nnz_, &levels);
+        allocate_host(cast_mat->nnz_, &val);
+
+        int     inf_level = 99999;
+        int64_t nnz       = 0;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        // find diagonals
+        for(int ai = 0; ai < cast_mat->nrow_; ++ai)
+        {
+            for(PtrType aj = cast_mat->mat_.row_offset[ai]; aj < cast_mat->mat_.row_offset[ai + 1];
+                ++aj)
+            {
+                if(ai == cast_mat->mat_.col[aj])
+                {
+                    ind_diag[ai] = aj;
+                    break;
+                }
+            }
+        }
+
+        // init row_offset
+        set_to_zero_host(cast_mat->nrow_ + 1, row_offset);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        // init inf levels
+        for(int64_t i = 0; i < cast_mat->nnz_; ++i)
+        {
+            levels[i] = inf_level;
+        }
+
+        set_to_zero_host(cast_mat->nnz_, val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        // fill levels and values
+        for(int ai = 0; ai < cast_mat->nrow_; ++ai)
+        {
+            for(PtrType aj = cast_mat->mat_.row_offset[ai]; aj < cast_mat->mat_.row_offset[ai + 1];
+                ++aj)
+            {
+                for(PtrType ajj = this->mat_.row_offset[ai]; ajj < this->mat_.row_offset[ai + 1];
+                    ++ajj)
+                {
+                    if(cast_mat->mat_.col[aj] == this->mat_.col[ajj])
+                    {
+                        val[aj]    = this->mat_.val[ajj];
+                        levels[aj] = 0;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // ai = 1 to N
+        for(int ai = 1; ai < cast_mat->nrow_; ++ai)
+        {
+            // ak = 1 to ai-1
+            for(PtrType ak = cast_mat->mat_.row_offset[ai]; ai > cast_mat->mat_.col[ak]; ++ak)
+            {
+                if(levels[ak] <= p)
+                {
+                    val[ak] /= val[ind_diag[cast_mat->mat_.col[ak]]];
+
+                    // aj = ak+1 to N
+                    for(PtrType aj = ak + 1; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
+                    {
+                        ValueType val_kj   = static_cast<ValueType>(0);
+                        int       level_kj = inf_level;
+
+                        // find a_k,j
+                        for(PtrType kj = cast_mat->mat_.row_offset[cast_mat->mat_.col[ak]];
+                            kj < cast_mat->mat_.row_offset[cast_mat->mat_.col[ak] + 1];
+                            ++kj)
+                        {
+                            if(cast_mat->mat_.col[aj] == cast_mat->mat_.col[kj])
+                            {
+                                level_kj = levels[kj];
+                                val_kj   = val[kj];
+                                break;
+                            }
+                        }
+
+                        int lev = level_kj + levels[ak] + 1;
+
+                        if(levels[aj] > lev)
+                        {
+                            levels[aj] = lev;
+                        }
+
+                        // a_i,j = a_i,j - a_i,k * a_k,j
+                        val[aj] -= val[ak] * val_kj;
+                    }
+                }
+            }
+
+            for(PtrType ak = cast_mat->mat_.row_offset[ai]; ak < cast_mat->mat_.row_offset[ai + 1];
+                ++ak)
+            {
+                if(levels[ak] > p)
+                {
+                    levels[ak] = inf_level;
+                    val[ak]    = static_cast<ValueType>(0);
+                }
+                else
+                {
+                    ++row_offset[ai + 1];
+                }
+            }
+        }
+
+        row_offset[0] = this->mat_.row_offset[0];
+        row_offset[1] = this->mat_.row_offset[1];
+
+        for(int i = 0; i < cast_mat->nrow_; ++i)
+        {
+            row_offset[i + 1] += row_offset[i];
+        }
+
+        nnz = row_offset[cast_mat->nrow_];
+
+        this->AllocateCSR(nnz, cast_mat->nrow_, cast_mat->ncol_);
+
+        PtrType jj = 0;
+        for(int i = 0; i < cast_mat->nrow_; ++i)
+        {
+            for(PtrType j = cast_mat->mat_.row_offset[i]; j < cast_mat->mat_.row_offset[i + 1]; ++j)
+            {
+                if(levels[j] <= p)
+                {
+                    this->mat_.col[jj] = cast_mat->mat_.col[j];
+                    this->mat_.val[jj] = val[j];
+                    ++jj;
+                }
+            }
+        }
+
+        assert(jj == nnz);
+
+        copy_h2h(this->nrow_ + 1, row_offset, this->mat_.row_offset);
+
+        free_host(&row_offset);
+        free_host(&ind_diag);
+        free_host(&levels);
+        free_host(&val);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::MatrixAdd(const BaseMatrix<ValueType>& mat,
+                                             ValueType                    alpha,
+                                             ValueType                    beta,
+                                             bool                         structure)
+    {
+        const HostMatrixCSR<ValueType>* cast_mat
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
+
+        assert(cast_mat != NULL);
+        assert(cast_mat->nrow_ == this->nrow_);
+        assert(cast_mat->ncol_ == this->ncol_);
+        assert(this->nnz_ >= 0);
+        assert(cast_mat->nnz_ >= 0);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        // the structure is sub-set
+        if(structure == false)
+        {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            // CSR should be sorted
+            for(int ai = 0; ai < cast_mat->nrow_; ++ai)
+            {
+                PtrType first_col = cast_mat->mat_.row_offset[ai];
+
+                for(PtrType ajj = this->mat_.row_offset[ai]; ajj < this->mat_.row_offset[ai + 1];
+                    ++ajj)
+                {
+                    for(PtrType aj = first_col; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
+                    {
+                        if(cast_mat->mat_.col[aj] == this->mat_.col[ajj])
+                        {
+                            this->mat_.val[ajj]
+                                = alpha * this->mat_.val[ajj] + beta * cast_mat->mat_.val[aj];
+                            ++first_col;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            std::vector<PtrType> row_offset;
+            std::vector<int>*    new_col = new std::vector<int>[this->nrow_];
+
+            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+
+            tmp.CopyFrom(*this);
+
+            row_offset.resize(this->nrow_ + 1);
+
+            row_offset[0] = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    new_col[i].push_back(this->mat_.col[j]);
+                }
+
+                for(PtrType k = cast_mat->mat_.row_offset[i]; k < cast_mat->mat_.row_offset[i + 1];
+                    ++k)
+                {
+                    new_col[i].push_back(cast_mat->mat_.col[k]);
+                }
+
+                std::sort(new_col[i].begin(), new_col[i].end());
+                new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()),
+                                 new_col[i].end());
+
+                row_offset[i + 1] = static_cast<PtrType>(new_col[i].size());
+            }
+
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                row_offset[i + 1] += row_offset[i];
+            }
+
+            this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+
+            // copy structure
+            copy_h2h(this->nrow_ + 1, row_offset.data(), this->mat_.row_offset);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                PtrType jj = 0;
+                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    this->mat_.col[j] = new_col[i][jj];
+                    ++jj;
+                }
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            // add values
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                PtrType Aj = tmp.mat_.row_offset[i];
+                PtrType Bj = cast_mat->mat_.row_offset[i];
+
+                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    for(PtrType jj = Aj; jj < tmp.mat_.row_offset[i + 1]; ++jj)
+                    {
+                        if(this->mat_.col[j] == tmp.mat_.col[jj])
+                        {
+                            this->mat_.val[j] += alpha * tmp.mat_.val[jj];
+                            ++Aj;
+                            break;
+                        }
+                    }
+
+                    for(PtrType jj = Bj; jj < cast_mat->mat_.row_offset[i + 1]; ++jj)
+                    {
+                        if(this->mat_.col[j] == cast_mat->mat_.col[jj])
+                        {
+                            this->mat_.val[j] += beta * cast_mat->mat_.val[jj];
+                            ++Bj;
+                            break;
+                        }
+                    }
+                }
+            }
+            delete[] new_col;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::SymbolicMatrixAdd(const BaseMatrix<ValueType>& A,
+                                                     const BaseMatrix<ValueType>& B)
+    {
+        const HostMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+        const HostMatrixCSR<ValueType>* cast_mat_B
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
+
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_B != NULL);
+        assert(cast_mat_A->nrow_ == cast_mat_B->nrow_);
+        assert(cast_mat_A->ncol_ == cast_mat_B->ncol_);
+
+        int nrow = cast_mat_A->nrow_;
+
+        const PtrType* A_ptr = cast_mat_A->mat_.row_offset;
+        const int*     A_col = cast_mat_A->mat_.col;
+        const PtrType* B_ptr = cast_mat_B->mat_.row_offset;
+        const int*     B_col = cast_mat_B->mat_.col;
+
+        std::vector<PtrType> row_offset(nrow + 1, 0);
+
+        _set_omp_backend_threads(this->local_backend_, nrow);
+
+        // Count the union of both (sorted) rows
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            PtrType a = A_ptr[i];
+            PtrType b = B_ptr[i];
+            PtrType n = 0;
+
+            while(a < A_ptr[i + 1] || b < B_ptr[i + 1])
+            {
+                int ca = (a < A_ptr[i + 1]) ? A_col[a] : std::numeric_limits<int>::max();
+                int cb = (b < B_ptr[i + 1]) ? B_col[b] : std::numeric_limits<int>::max();
+
+                a += (ca <= cb);
+                b += (cb <= ca);
+                ++n;
+            }
+
+            row_offset[i + 1] = n;
+        }
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            row_offset[i + 1] += row_offset[i];
+        }
+
+        this->Clear();
+        this->AllocateCSR(row_offset[nrow], nrow, cast_mat_A->ncol_);
+
+        copy_h2h(nrow + 1, row_offset.data(), this->mat_.row_offset);
+
+        // Fill the column indices of the union
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            PtrType a = A_ptr[i];
+            PtrType b = B_ptr[i];
+            PtrType j = this->mat_.row_offset[i];
+
+            while(a < A_ptr[i + 1] || b < B_ptr[i + 1])
+            {
+                int ca = (a < A_ptr[i + 1]) ? A_col[a] : std::numeric_limits<int>::max();
+                int cb = (b < B_ptr[i + 1]) ? B_col[b] : std::numeric_limits<int>::max();
+
+                this->mat_.col[j++] = std::min(ca, cb);
+
+                a += (ca <= cb);
+                b += (cb <= ca);
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::NumericMatrixAdd(const BaseMatrix<ValueType>& A,
+                                                    ValueType                    alpha,
+                                                    const BaseMatrix<ValueType>& B,
+                                                    ValueType                    beta)
+    {
+        const HostMatrixCSR<ValueType>* cast_mat_A
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+        const HostMatrixCSR<ValueType>* cast_mat_B
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
+
+        assert(cast_mat_A != NULL);
+        assert(cast_mat_B != NULL);
+        assert(cast_mat_A->nrow_ == this->nrow_);
+        assert(cast_mat_A->ncol_ == this->ncol_);
+        assert(cast_mat_B->nrow_ == this->nrow_);
+        assert(cast_mat_B->ncol_ == this->ncol_);
+
+        const PtrType*   A_ptr = cast_mat_A->mat_.row_offset;
+        const int*       A_col = cast_mat_A->mat_.col;
+        const ValueType* A_val = cast_mat_A->mat_.val;
+        const PtrType*   B_ptr = cast_mat_B->mat_.row_offset;
+        const int*       B_col = cast_mat_B->mat_.col;
+        const ValueType* B_val = cast_mat_B->mat_.val;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        // All rows are sorted and the pattern of this contains the patterns of A and B,
+        // such that a single merge per row places all entries
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            PtrType a = A_ptr[i];
+            PtrType b = B_ptr[i];
+
+            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                int       col = this->mat_.col[j];
+                ValueType val = static_cast<ValueType>(0);
+
+                if(a < A_ptr[i + 1] && A_col[a] == col)
+                {
+                    val += alpha * A_val[a++];
+                }
+
+                if(b < B_ptr[i + 1] && B_col[b] == col)
+                {
+                    val += beta * B_val[b++];
+                }
+
+                this->mat_.val[j] = val;
+            }
+
+            assert(a == A_ptr[i + 1]);
+            assert(b == B_ptr[i + 1]);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const
+    {
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        lambda_min = static_cast<ValueType>(0);
+        lambda_max = static_cast<ValueType>(0);
+
+        // TODO (parallel max, min)
+        //#ifdef _OPENMP
+        // #pragma omp parallel for
+        //#endif
+
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            ValueType sum  = static_cast<ValueType>(0);
+            ValueType diag = static_cast<ValueType>(0);
+
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai != this->mat_.col[aj])
+                {
+                    sum += std::abs(this->mat_.val[aj]);
+                }
+                else
+                {
+                    diag = this->mat_.val[aj];
+                }
+            }
+
+            if(sum + diag > lambda_max)
+            {
+                lambda_max = sum + diag;
+            }
+
+            if(diag - sum < lambda_min)
+            {
+                lambda_min = diag - sum;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Scale(ValueType alpha)
+    {
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int64_t ai = 0; ai < this->nnz_; ++ai)
+        {
+            this->mat_.val[ai] *= alpha;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ScaleDiagonal(ValueType alpha)
+    {
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai == this->mat_.col[aj])
+                {
+                    this->mat_.val[aj] *= alpha;
+                    break;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ScaleOffDiagonal(ValueType alpha)
+    {
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai != this->mat_.col[aj])
+                {
+                    this->mat_.val[aj] *= alpha;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AddScalar(ValueType alpha)
+    {
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int64_t ai = 0; ai < this->nnz_; ++ai)
+        {
+            this->mat_.val[ai] += alpha;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AddScalarDiagonal(ValueType alpha)
+    {
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai == this->mat_.col[aj])
+                {
+                    this->mat_.val[aj] += alpha;
+                    break;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AddScalarOffDiagonal(ValueType alpha)
+    {
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai != this->mat_.col[aj])
+                {
+                    this->mat_.val[aj] += alpha;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::DiagonalMatrixMultR(const BaseVector<ValueType>& diag)
+    {
+        assert(diag.GetSize() == this->ncol_);
+
+        const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&diag);
+        assert(cast_diag != NULL);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                this->mat_.val[aj] *= cast_diag->vec_[this->mat_.col[aj]];
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::DiagonalMatrixMultL(const BaseVector<ValueType>& diag)
+    {
+        assert(diag.GetSize() == this->ncol_);
+
+        const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&diag);
+        assert(cast_diag != NULL);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                this->mat_.val[aj] *= cast_diag->vec_[ai];
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Compress(double drop_off)
+    {
+        if(this->nnz_ > 0)
+        {
+            std::vector<PtrType> row_offset;
+
+            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+
+            tmp.CopyFrom(*this);
+
+            row_offset.resize(this->nrow_ + 1);
+
+            row_offset[0] = 0;
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                row_offset[i + 1] = 0;
+
+                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    if((std::abs(this->mat_.val[j]) > drop_off) || (this->mat_.col[j] == i))
+                    {
+                        row_offset[i + 1] += 1;
+                    }
+                }
+            }
+
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                row_offset[i + 1] += row_offset[i];
+            }
+
+            this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+
+            copy_h2h(this->nrow_ + 1, row_offset.data(), this->mat_.row_offset);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                PtrType jj = this->mat_.row_offset[i];
+
+                for(PtrType j = tmp.mat_.row_offset[i]; j < tmp.mat_.row_offset[i + 1]; ++j)
+                {
+                    if((std::abs(tmp.mat_.val[j]) > drop_off) || (tmp.mat_.col[j] == i))
+                    {
+                        this->mat_.col[jj] = tmp.mat_.col[j];
+                        this->mat_.val[jj] = tmp.mat_.val[j];
+                        ++jj;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::CompressLumped(double drop_off)
+    {
+        assert(this->nrow_ == this->ncol_);
+
+        if(this->nnz_ > 0)
+        {
+            std::vector<PtrType>   row_offset;
+            std::vector<ValueType> diag;
+
+            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+
+            tmp.CopyFrom(*this);
+
+            row_offset.resize(this->nrow_ + 1);
+            diag.resize(this->nrow_, static_cast<ValueType>(0));
+
+            row_offset[0] = 0;
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+            // The drop criterion is relative to the diagonal entries
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                for(PtrType j = tmp.mat_.row_offset[i]; j < tmp.mat_.row_offset[i + 1]; ++j)
+                {
+                    if(tmp.mat_.col[j] == i)
+                    {
+                        diag[i] = tmp.mat_.val[j];
+                    }
+                }
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                row_offset[i + 1] = 0;
+
+                for(PtrType j = tmp.mat_.row_offset[i]; j < tmp.mat_.row_offset[i + 1]; ++j)
+                {
+                    int    c   = tmp.mat_.col[j];
+                    double tol = drop_off * std::sqrt(std::abs(diag[i]) * std::abs(diag[c]));
+
+                    if((c == i) || (std::abs(tmp.mat_.val[j]) > tol))
+                    {
+                        row_offset[i + 1] += 1;
+                    }
+                }
+            }
+
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                row_offset[i + 1] += row_offset[i];
+            }
+
+            this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+
+            copy_h2h(this->nrow_ + 1, row_offset.data(), this->mat_.row_offset);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                // Sum of the dropped entries, the row sum is preserved
+                ValueType lumped = static_cast<ValueType>(0);
+
+                for(PtrType j = tmp.mat_.row_offset[i]; j < tmp.mat_.row_offset[i + 1]; ++j)
+                {
+                    int    c   = tmp.mat_.col[j];
+                    double tol = drop_off * std::sqrt(std::abs(diag[i]) * std::abs(diag[c]));
+
+                    if((c != i) && (std::abs(tmp.mat_.val[j]) <= tol))
+                    {
+                        lumped += tmp.mat_.val[j];
+                    }
+                }
+
+                PtrType jj = this->mat_.row_offset[i];
+
+                for(PtrType j = tmp.mat_.row_offset[i]; j < tmp.mat_.row_offset[i + 1]; ++j)
+                {
+                    int    c   = tmp.mat_.col[j];
+                    double tol = drop_off * std::sqrt(std::abs(diag[i]) * std::abs(diag[c]));
+
+                    if(c == i)
+                    {
+                        this->mat_.col[jj] = c;
+                        this->mat_.val[jj] = tmp.mat_.val[j] + lumped;
+                        ++jj;
+                    }
+                    else if(std::abs(tmp.mat_.val[j]) > tol)
+                    {
+                        this->mat_.col[jj] = c;
+                        this->mat_.val[jj] = tmp.mat_.val[j];
+                        ++jj;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Transpose(void)
+    {
+        if(this->nnz_ > 0)
+        {
+            HostMatrixCSR<ValueType> tmp(this->local_backend_);
+
+            tmp.CopyFrom(*this);
+            tmp.Transpose(this);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Transpose(BaseMatrix<ValueType>* T) const
+    {
+        assert(T != NULL);
+
+        HostMatrixCSR<ValueType>* cast_T = dynamic_cast<HostMatrixCSR<ValueType>*>(T);
+
+        assert(cast_T != NULL);
+
+        if(this->nnz_ > 0)
+        {
+            cast_T->Clear();
+            cast_T->AllocateCSR(this->nnz_, this->ncol_, this->nrow_);
+
+            for(int64_t i = 0; i < cast_T->nnz_; ++i)
+            {
+                cast_T->mat_.row_offset[this->mat_.col[i] + 1] += 1;
+            }
+
+            for(int i = 0; i < cast_T->nrow_; ++i)
+            {
+                cast_T->mat_.row_offset[i + 1] += cast_T->mat_.row_offset[i];
+            }
+
+            for(int ai = 0; ai < cast_T->ncol_; ++ai)
+            {
+                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
+                    ++aj)
+                {
+                    int     ind_col = this->mat_.col[aj];
+                    PtrType ind     = cast_T->mat_.row_offset[ind_col];
+
+                    cast_T->mat_.col[ind] = ai;
+                    cast_T->mat_.val[ind] = this->mat_.val[aj];
+
+                    cast_T->mat_.row_offset[ind_col] += 1;
+                }
+            }
+
+            PtrType shift = 0;
             for(int i = 0; i < cast_T->nrow_; ++i)
             {
-                cast_T->mat_.row_offset[i + 1] += cast_T->mat_.row_offset[i];
+                PtrType tmp                = cast_T->mat_.row_offset[i];
+                cast_T->mat_.row_offset[i] = shift;
+                shift                      = tmp;
+            }
+
+            cast_T->mat_.row_offset[cast_T->nrow_] = shift;
+
+            assert(this->nnz_ == shift);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Sort(void)
+    {
+        if(this->nnz_ > 0)
+        {
+            this->DetachStructure_();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                std::vector<PtrType>   perm;
+                std::vector<int>       tmp_col;
+                std::vector<ValueType> tmp_val;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+                for(int i = 0; i < this->nrow_; ++i)
+                {
+                    PtrType row_begin = this->mat_.row_offset[i];
+                    PtrType row_end   = this->mat_.row_offset[i + 1];
+
+                    // Rows that are already sorted are skipped
+                    if(std::is_sorted(this->mat_.col + row_begin, this->mat_.col + row_end))
+                    {
+                        continue;
+                    }
+
+                    PtrType row_nnz = row_end - row_begin;
+
+                    perm.resize(row_nnz);
+                    tmp_col.assign(this->mat_.col + row_begin, this->mat_.col + row_end);
+                    tmp_val.assign(this->mat_.val + row_begin, this->mat_.val + row_end);
+
+                    std::iota(perm.begin(), perm.end(), 0);
+                    std::stable_sort(perm.begin(), perm.end(), [&](PtrType a, PtrType b) {
+                        return tmp_col[a] < tmp_col[b];
+                    });
+
+                    for(PtrType j = 0; j < row_nnz; ++j)
+                    {
+                        this->mat_.col[row_begin + j] = tmp_col[perm[j]];
+                        this->mat_.val[row_begin + j] = tmp_val[perm[j]];
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Permute(const BaseVector<int>& permutation)
+    {
+        assert((permutation.GetSize() == this->nrow_) && (permutation.GetSize() == this->ncol_));
+
+        if(this->nnz_ > 0)
+        {
+            const HostVector<int>* cast_perm = dynamic_cast<const HostVector<int>*>(&permutation);
+            assert(cast_perm != NULL);
+
+            this->DetachStructure_();
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+            // Calculate nnz per row
+            int* row_nnz = NULL;
+            allocate_host(this->nrow_, &row_nnz);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                row_nnz[i]
+                    = static_cast<int>(this->mat_.row_offset[i + 1] - this->mat_.row_offset[i]);
+            }
+
+            // Permute vector of nnz per row
+            int* perm_row_nnz = NULL;
+            allocate_host(this->nrow_, &perm_row_nnz);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                perm_row_nnz[cast_perm->vec_[i]] = row_nnz[i];
+            }
+
+            // Calculate new nnz
+            PtrType* perm_nnz = NULL;
+            allocate_host(this->nrow_ + 1, &perm_nnz);
+            PtrType sum = 0;
+
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                perm_nnz[i] = sum;
+                sum += perm_row_nnz[i];
+            }
+
+            perm_nnz[this->nrow_] = sum;
+
+            // Permute rows
+            int*       col = NULL;
+            ValueType* val = NULL;
+            allocate_host(this->nnz_, &col);
+            allocate_host(this->nnz_, &val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                PtrType permIndex = perm_nnz[cast_perm->vec_[i]];
+                PtrType prevIndex = this->mat_.row_offset[i];
+
+                for(int j = 0; j < row_nnz[i]; ++j)
+                {
+                    col[permIndex + j] = this->mat_.col[prevIndex + j];
+                    val[permIndex + j] = this->mat_.val[prevIndex + j];
+                }
+            }
+
+// Permute columns
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                PtrType row_index = perm_nnz[i];
+
+                for(int j = 0; j < perm_row_nnz[i]; ++j)
+                {
+                    int k     = j - 1;
+                    int aComp = col[row_index + j];
+                    int comp  = cast_perm->vec_[aComp];
+                    for(; k >= 0; --k)
+                    {
+                        if(this->mat_.col[row_index + k] > comp)
+                        {
+                            this->mat_.val[row_index + k + 1] = this->mat_.val[row_index + k];
+                            this->mat_.col[row_index + k + 1] = this->mat_.col[row_index + k];
+                        }
+                        else
+                        {
+                            break;
+                        }
+                    }
+
+                    this->mat_.val[row_index + k + 1] = val[row_index + j];
+                    this->mat_.col[row_index + k + 1] = comp;
+                }
+            }
+
+            free_host(&this->mat_.row_offset);
+            this->mat_.row_offset = perm_nnz;
+            free_host(&col);
+            free_host(&val);
+            free_host(&row_nnz);
+            free_host(&perm_row_nnz);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::PermuteBackward(const BaseVector<int>& permutation)
+    {
+        assert((permutation.GetSize() == this->nrow_) && (permutation.GetSize() == this->ncol_));
+
+        if(this->nnz_ > 0)
+        {
+            const HostVector<int>* cast_perm = dynamic_cast<const HostVector<int>*>(&permutation);
+            assert(cast_perm != NULL);
+
+            // Backward permutation is the forward permutation with the inverse
+            HostVector<int> inverse(this->local_backend_);
+            inverse.Allocate(this->nrow_);
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                inverse.vec_[cast_perm->vec_[i]] = i;
+            }
+
+            return this->Permute(inverse);
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::CMK(BaseVector<int>* permutation) const
+    {
+        assert(this->nnz_ > 0);
+        assert(permutation != NULL);
+
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        cast_perm->Clear();
+        cast_perm->Allocate(this->nrow_);
+
+        int next   = 0;
+        int head   = 0;
+        int tmp    = 0;
+        int test   = 1;
+        int maxdeg = 0;
+
+        int* nd         = NULL;
+        int* marker     = NULL;
+        int* levset     = NULL;
+        int* nextlevset = NULL;
+
+        allocate_host(this->nrow_, &nd);
+        allocate_host(this->nrow_, &marker);
+        allocate_host(this->nrow_, &levset);
+        allocate_host(this->nrow_, &nextlevset);
+
+        int qlength = 1;
+
+        for(int k = 0; k < this->nrow_; ++k)
+        {
+            marker[k] = 0;
+            nd[k] = static_cast<int>(this->mat_.row_offset[k + 1] - this->mat_.row_offset[k] - 1);
+
+            if(nd[k] > maxdeg)
+            {
+                maxdeg = nd[k];
+            }
+        }
+
+        head               = this->mat_.col[0];
+        levset[0]          = head;
+        cast_perm->vec_[0] = 0;
+        ++next;
+        marker[head] = 1;
+
+        while(next < this->nrow_)
+        {
+            int position = 0;
+
+            for(int h = 0; h < qlength; ++h)
+            {
+                head = levset[h];
+
+                for(PtrType k = this->mat_.row_offset[head]; k < this->mat_.row_offset[head + 1];
+                    ++k)
+                {
+                    tmp = this->mat_.col[k];
+
+                    if((marker[tmp] == 0) && (tmp != head))
+                    {
+                        nextlevset[position] = tmp;
+                        marker[tmp]          = 1;
+                        cast_perm->vec_[tmp] = next;
+                        ++next;
+                        ++position;
+                    }
+                }
+            }
+
+            qlength = position;
+
+            while(test == 1)
+            {
+                test = 0;
+
+                for(int j = position - 1; j > 0; --j)
+                {
+                    if(nd[nextlevset[j]] < nd[nextlevset[j - 1]])
+                    {
+                        tmp               = nextlevset[j];
+                        nextlevset[j]     = nextlevset[j - 1];
+                        nextlevset[j - 1] = tmp;
+                        test              = 1;
+                    }
+                }
+            }
+
+            for(int i = 0; i < position; ++i)
+            {
+                levset[i] = nextlevset[i];
+            }
+
+            if(qlength == 0)
+            {
+                for(int i = 0; i < this->nrow_; ++i)
+                {
+                    if(marker[i] == 0)
+                    {
+                        levset[0]          = i;
+                        qlength            = 1;
+                        cast_perm->vec_[i] = next;
+                        marker[i]          = 1;
+                        ++next;
+                    }
+                }
+            }
+        }
+
+        free_host(&nd);
+        free_host(&marker);
+        free_host(&levset);
+        free_host(&nextlevset);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::RCMK(BaseVector<int>* permutation) const
+    {
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        cast_perm->Clear();
+        cast_perm->Allocate(this->nrow_);
+
+        HostVector<int> tmp_perm(this->local_backend_);
+
+        this->CMK(&tmp_perm);
+
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            cast_perm->vec_[i] = this->nrow_ - tmp_perm.vec_[i] - 1;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::ConnectivityOrder(BaseVector<int>* permutation) const
+    {
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        cast_perm->Clear();
+        cast_perm->Allocate(this->nrow_);
+
+        std::multimap<int, int> map;
+
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            map.insert(
+                std::pair<int, int>(this->mat_.row_offset[i + 1] - this->mat_.row_offset[i], i));
+        }
+
+        std::multimap<int, int>::iterator it = map.begin();
+
+        for(int i = 0; i < this->nrow_; ++i, ++it)
+        {
+            cast_perm->vec_[i] = it->second;
+        }
+
+        return true;
+    }
+
+    // Adjacency of the symmetrized pattern of a square CSR matrix without self loops,
+    // the neighbors of each vertex are sorted and unique
+    static void host_symmetric_graph(int                   n,
+                                     const PtrType*        row_offset,
+                                     const int*            col,
+                                     std::vector<PtrType>& adj_ptr,
+                                     std::vector<int>&     adj)
+    {
+        adj_ptr.assign(n + 1, 0);
+
+        for(int i = 0; i < n; ++i)
+        {
+            for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                int c = col[j];
+
+                if(c != i)
+                {
+                    ++adj_ptr[i + 1];
+                    ++adj_ptr[c + 1];
+                }
+            }
+        }
+
+        for(int i = 0; i < n; ++i)
+        {
+            adj_ptr[i + 1] += adj_ptr[i];
+        }
+
+        adj.resize(adj_ptr[n]);
+
+        std::vector<PtrType> pos(adj_ptr.begin(), adj_ptr.end() - 1);
+
+        for(int i = 0; i < n; ++i)
+        {
+            for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                int c = col[j];
+
+                if(c != i)
+                {
+                    adj[pos[i]++] = c;
+                    adj[pos[c]++] = i;
+                }
+            }
+        }
+
+        // Remove duplicates of symmetric entries
+        PtrType nnz = 0;
+
+        for(int i = 0; i < n; ++i)
+        {
+            PtrType begin = adj_ptr[i];
+
+            std::sort(adj.begin() + begin, adj.begin() + adj_ptr[i + 1]);
+
+            adj_ptr[i] = nnz;
+
+            for(PtrType j = begin; j < adj_ptr[i + 1]; ++j)
+            {
+                if(j == begin || adj[j] != adj[j - 1])
+                {
+                    adj[nnz++] = adj[j];
+                }
+            }
+        }
+
+        adj_ptr[n] = nnz;
+        adj.resize(nnz);
+    }
+
+    // Approximate minimum degree ordering of the subgraph induced by the vertices V
+    // (all vertices v with owner[v] == id). The elimination is tracked on the quotient
+    // graph, eliminated vertices become elements that absorb all elements adjacent to
+    // them. The degree of a variable is bounded by its variable neighbors, the new
+    // element and the parts of its other elements outside of the new element, as in
+    // Amestoy, Davis and Duff. local must be of graph size, the ordered vertices are
+    // written to order.
+    static void host_minimum_degree(const std::vector<int>&     V,
+                                    const std::vector<PtrType>& adj_ptr,
+                                    const std::vector<int>&     adj,
+                                    const std::vector<int>&     owner,
+                                    int                         id,
+                                    std::vector<int>&           local,
+                                    int*                        order)
+    {
+        int m = static_cast<int>(V.size());
+
+        for(int i = 0; i < m; ++i)
+        {
+            local[V[i]] = i;
+        }
+
+        // Variable and element neighbors of each variable, variables of each element
+        std::vector<std::vector<int>> var(m);
+        std::vector<std::vector<int>> elem(m);
+        std::vector<std::vector<int>> evar(m);
+
+        std::vector<char> eliminated(m, 0);
+        std::vector<char> absorbed(m, 0);
+        std::vector<int>  degree(m);
+        std::vector<int>  mark(m, -1);
+        std::vector<int>  wmark(m, -1);
+        std::vector<int>  w(m, 0);
+
+        std::set<std::pair<int, int>> queue;
+
+        for(int i = 0; i < m; ++i)
+        {
+            int v = V[i];
+
+            for(PtrType j = adj_ptr[v]; j < adj_ptr[v + 1]; ++j)
+            {
+                if(owner[adj[j]] == id)
+                {
+                    var[i].push_back(local[adj[j]]);
+                }
+            }
+
+            degree[i] = static_cast<int>(var[i].size());
+            queue.insert(std::make_pair(degree[i], i));
+        }
+
+        std::vector<int> Lp;
+
+        for(int k = 0; k < m; ++k)
+        {
+            int p = queue.begin()->second;
+            queue.erase(queue.begin());
+
+            eliminated[p] = 1;
+            order[k]      = V[p];
+
+            // Variables of the new element p
+            Lp.clear();
+            mark[p] = k;
+
+            for(int v : var[p])
+            {
+                if(mark[v] != k)
+                {
+                    mark[v] = k;
+                    Lp.push_back(v);
+                }
+            }
+
+            for(int e : elem[p])
+            {
+                for(int v : evar[e])
+                {
+                    if(v != p && mark[v] != k)
+                    {
+                        mark[v] = k;
+                        Lp.push_back(v);
+                    }
+                }
+
+                absorbed[e] = 1;
+                std::vector<int>().swap(evar[e]);
+            }
+
+            std::vector<int>().swap(var[p]);
+            std::vector<int>().swap(elem[p]);
+
+            // Size of the other elements outside of Lp
+            for(int i : Lp)
+            {
+                for(int e : elem[i])
+                {
+                    if(absorbed[e] == 1)
+                    {
+                        continue;
+                    }
+
+                    if(wmark[e] != k)
+                    {
+                        wmark[e] = k;
+                        w[e]     = static_cast<int>(evar[e].size());
+                    }
+
+                    --w[e];
+                }
+            }
+
+            int remaining = m - k - 1;
+            int nLp       = static_cast<int>(Lp.size());
+
+            for(int i : Lp)
+            {
+                // Variables in Lp are reached through p
+                size_t nvar = 0;
+
+                for(int v : var[i])
+                {
+                    if(mark[v] != k)
+                    {
+                        var[i][nvar++] = v;
+                    }
+                }
+
+                var[i].resize(nvar);
+
+                size_t nelem = 0;
+                int    d     = static_cast<int>(nvar) + nLp - 1;
+
+                for(int e : elem[i])
+                {
+                    if(absorbed[e] == 0)
+                    {
+                        elem[i][nelem++] = e;
+                        d += w[e];
+                    }
+                }
+
+                elem[i].resize(nelem);
+                elem[i].push_back(p);
+
+                d = std::min(d, remaining - 1);
+
+                queue.erase(std::make_pair(degree[i], i));
+                degree[i] = d;
+                queue.insert(std::make_pair(degree[i], i));
+            }
+
+            evar[p].swap(Lp);
+            Lp.clear();
+        }
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::GraphPartition(int nparts, BaseVector<int>* partition) const
+    {
+        assert(nparts > 0);
+        assert(this->nrow_ == this->ncol_);
+
+        HostVector<int>* cast_part = dynamic_cast<HostVector<int>*>(partition);
+        assert(cast_part != NULL);
+
+        int n = this->nrow_;
+
+        cast_part->Clear();
+        cast_part->Allocate(n);
+
+        std::vector<PtrType> adj_ptr;
+        std::vector<int>     adj;
+
+        host_symmetric_graph(n, this->mat_.row_offset, this->mat_.col, adj_ptr, adj);
+
+        // First vertex of each part, the first parts get one more vertex (same as a
+        // contiguous block distribution of n rows)
+        auto first_vertex = [n, nparts](int p) -> int {
+            return p * (n / nparts) + std::min(p, n % nparts);
+        };
+
+        // Recursive bisection, each task holds a vertex subset and its range of parts
+        struct Task
+        {
+            std::vector<int> vertices;
+            int              part_begin;
+            int              part_end;
+        };
+
+        std::vector<Task> tasks(1);
+
+        tasks[0].vertices.resize(n);
+        tasks[0].part_begin = 0;
+        tasks[0].part_end   = nparts;
+
+        std::iota(tasks[0].vertices.begin(), tasks[0].vertices.end(), 0);
+
+        // Subset id of each vertex, side of the bisection and gain of moving it
+        std::vector<int> subset(n, -1);
+        std::vector<int> side(n, 0);
+        std::vector<int> gain(n, 0);
+        std::vector<int> level(n, -1);
+        std::vector<int> queue;
+
+        int stamp = 0;
+
+        while(tasks.empty() == false)
+        {
+            Task task = std::move(tasks.back());
+            tasks.pop_back();
+
+            std::vector<int>& V = task.vertices;
+
+            if(task.part_end - task.part_begin == 1)
+            {
+                for(int v : V)
+                {
+                    cast_part->vec_[v] = task.part_begin;
+                }
+
+                continue;
+            }
+
+            int part_mid = task.part_begin + (task.part_end - task.part_begin) / 2;
+            int nleft    = first_vertex(part_mid) - first_vertex(task.part_begin);
+
+            ++stamp;
+
+            for(int v : V)
+            {
+                subset[v] = stamp;
+                level[v]  = -1;
+                side[v]   = 1;
+            }
+
+            // Breadth first search inside the subset, returns the last vertex reached
+            auto bfs = [&](int root, bool grow, int& count) -> int {
+                queue.clear();
+                queue.push_back(root);
+                level[root] = stamp;
+
+                int last = root;
+
+                for(size_t q = 0; q < queue.size(); ++q)
+                {
+                    int v = queue[q];
+                    last  = v;
+
+                    if(grow == true)
+                    {
+                        if(count == nleft)
+                        {
+                            break;
+                        }
+
+                        side[v] = 0;
+                        ++count;
+                    }
+
+                    for(PtrType j = adj_ptr[v]; j < adj_ptr[v + 1]; ++j)
+                    {
+                        int w = adj[j];
+
+                        if(subset[w] == stamp && level[w] != stamp)
+                        {
+                            level[w] = stamp;
+                            queue.push_back(w);
+                        }
+                    }
+                }
+
+                return last;
+            };
+
+            // Grow the left side from pseudo-peripheral vertices, one component at a time
+            int count = 0;
+
+            for(size_t k = 0; k < V.size() && count < nleft; ++k)
+            {
+                int root = V[k];
+
+                if(level[root] == stamp)
+                {
+                    continue;
+                }
+
+                int dummy = 0;
+
+                // Two sweeps to find a vertex far away from root
+                int far = bfs(root, false, dummy);
+
+                for(int v : queue)
+                {
+                    level[v] = -1;
+                }
+
+                bfs(far, true, count);
+
+                // Vertices reached but not added are free for the next component
+                for(int v : queue)
+                {
+                    if(side[v] == 1)
+                    {
+                        level[v] = -1;
+                    }
+                }
+            }
+
+            // Kernighan-Lin refinement, swap pairs of boundary vertices with positive gain
+            for(int pass = 0; pass < 8; ++pass)
+            {
+                std::vector<int> candidates[2];
+
+                for(int v : V)
+                {
+                    int external = 0;
+                    int internal = 0;
+
+                    for(PtrType j = adj_ptr[v]; j < adj_ptr[v + 1]; ++j)
+                    {
+                        int w = adj[j];
+
+                        if(subset[w] == stamp)
+                        {
+                            (side[w] == side[v] ? internal : external) += 1;
+                        }
+                    }
+
+                    gain[v] = external - internal;
+
+                    if(external > 0)
+                    {
+                        candidates[side[v]].push_back(v);
+                    }
+                }
+
+                for(int s = 0; s < 2; ++s)
+                {
+                    std::stable_sort(candidates[s].begin(),
+                                     candidates[s].end(),
+                                     [&gain](int a, int b) { return gain[a] > gain[b]; });
+                }
+
+                size_t nswap = std::min(candidates[0].size(), candidates[1].size());
+                int    swaps = 0;
+
+                for(size_t k = 0; k < nswap; ++k)
+                {
+                    int a = candidates[0][k];
+                    int b = candidates[1][k];
+
+                    // Gains are updated on the fly, a and b are still on their sides
+                    int connected = std::binary_search(adj.begin() + adj_ptr[a],
+                                                       adj.begin() + adj_ptr[a + 1],
+                                                       b)
+                                        ? 1
+                                        : 0;
+
+                    if(gain[a] + gain[b] - 2 * connected <= 0)
+                    {
+                        break;
+                    }
+
+                    for(int v : {a, b})
+                    {
+                        for(PtrType j = adj_ptr[v]; j < adj_ptr[v + 1]; ++j)
+                        {
+                            int w = adj[j];
+
+                            if(subset[w] == stamp)
+                            {
+                                gain[w] += (side[w] == side[v]) ? 2 : -2;
+                            }
+                        }
+
+                        side[v] = 1 - side[v];
+                        gain[v] = -gain[v];
+                    }
+
+                    ++swaps;
+                }
+
+                if(swaps == 0)
+                {
+                    break;
+                }
+            }
+
+            // Split the subset, the left side takes the lower half of the parts
+            Task left;
+            Task right;
+
+            left.part_begin  = task.part_begin;
+            left.part_end    = part_mid;
+            right.part_begin = part_mid;
+            right.part_end   = task.part_end;
+
+            left.vertices.reserve(nleft);
+            right.vertices.reserve(V.size() - nleft);
+
+            for(int v : V)
+            {
+                (side[v] == 0 ? left : right).vertices.push_back(v);
+            }
+
+            std::vector<int>().swap(V);
+
+            tasks.push_back(std::move(right));
+            tasks.push_back(std::move(left));
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AMD(BaseVector<int>* permutation) const
+    {
+        assert(this->nrow_ == this->ncol_);
+
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        int n = this->nrow_;
+
+        cast_perm->Clear();
+        cast_perm->Allocate(n);
+
+        std::vector<PtrType> adj_ptr;
+        std::vector<int>     adj;
+
+        host_symmetric_graph(n, this->mat_.row_offset, this->mat_.col, adj_ptr, adj);
+
+        std::vector<int> V(n);
+        std::vector<int> owner(n, 0);
+        std::vector<int> local(n);
+        std::vector<int> order(n);
+
+        std::iota(V.begin(), V.end(), 0);
+
+        host_minimum_degree(V, adj_ptr, adj, owner, 0, local, order.data());
+
+        for(int k = 0; k < n; ++k)
+        {
+            cast_perm->vec_[order[k]] = k;
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::NestedDissection(int              leaf_size,
+                                                    int&             num_nodes,
+                                                    int**            node_offset,
+                                                    int**            node_parent,
+                                                    BaseVector<int>* permutation) const
+    {
+        assert(leaf_size > 0);
+        assert(*node_offset == NULL);
+        assert(*node_parent == NULL);
+        assert(this->nrow_ == this->ncol_);
+
+        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+        assert(cast_perm != NULL);
+
+        int n = this->nrow_;
+
+        cast_perm->Clear();
+        cast_perm->Allocate(n);
+
+        std::vector<PtrType> adj_ptr;
+        std::vector<int>     adj;
+
+        host_symmetric_graph(n, this->mat_.row_offset, this->mat_.col, adj_ptr, adj);
+
+        // Separator tree, inner nodes hold the separator, leaves hold the ordered vertices
+        struct Node
+        {
+            std::vector<int> vertices;
+            int              parent;
+            int              left;
+            int              right;
+        };
+
+        std::vector<Node> tree(1);
+
+        tree[0].vertices.resize(n);
+        tree[0].parent = -1;
+        tree[0].left   = -1;
+        tree[0].right  = -1;
+
+        std::iota(tree[0].vertices.begin(), tree[0].vertices.end(), 0);
+
+        // Task of each vertex within the current level of the tree, BFS level and side
+        // (0 left, 1 right, 2 separator). Tasks only write entries of their own vertices.
+        std::vector<int> owner(n, 0);
+        std::vector<int> level(n, -1);
+        std::vector<int> side(n, 0);
+        std::vector<int> local(n);
+
+        std::vector<int> current(1, 0);
+
+        while(current.empty() == false)
+        {
+            int ntask = static_cast<int>(current.size());
+
+            for(int t = 0; t < ntask; ++t)
+            {
+                for(int v : tree[current[t]].vertices)
+                {
+                    owner[v] = t;
+                }
+            }
+
+            // Left part, right part and separator of each task, empty if not split
+            std::vector<std::vector<int>> split(3 * ntask);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for(int t = 0; t < ntask; ++t)
+            {
+                std::vector<int>& V = tree[current[t]].vertices;
+
+                int nv = static_cast<int>(V.size());
+
+                if(nv <= leaf_size)
+                {
+                    std::vector<int> order(nv);
+
+                    host_minimum_degree(V, adj_ptr, adj, owner, t, local, order.data());
+                    V.swap(order);
+
+                    continue;
+                }
+
+                std::vector<int> queue;
+
+                // Breadth first search inside the task, returns the number of levels
+                auto bfs = [&](int root) -> int {
+                    queue.clear();
+                    queue.push_back(root);
+                    level[root] = 0;
+
+                    for(size_t q = 0; q < queue.size(); ++q)
+                    {
+                        int v = queue[q];
+
+                        for(PtrType j = adj_ptr[v]; j < adj_ptr[v + 1]; ++j)
+                        {
+                            int w = adj[j];
+
+                            if(owner[w] == t && level[w] < 0)
+                            {
+                                level[w] = level[v] + 1;
+                                queue.push_back(w);
+                            }
+                        }
+                    }
+
+                    return level[queue.back()] + 1;
+                };
+
+                auto reset = [&](void) {
+                    for(int v : queue)
+                    {
+                        level[v] = -1;
+                    }
+                };
+
+                std::vector<int>& left  = split[3 * t];
+                std::vector<int>& right = split[3 * t + 1];
+
+                // Disconnected subsets are split into components, the left side collects
+                // components until it holds half of the vertices
+                int ncomp = 0;
+                int last  = 0;
+
+                for(int v : V)
+                {
+                    if(level[v] >= 0)
+                    {
+                        continue;
+                    }
+
+                    bfs(v);
+
+                    if(ncomp == 0 || static_cast<int>(left.size()) < nv / 2)
+                    {
+                        last = static_cast<int>(left.size());
+                        left.insert(left.end(), queue.begin(), queue.end());
+                    }
+                    else
+                    {
+                        right.insert(right.end(), queue.begin(), queue.end());
+                    }
+
+                    ++ncomp;
+                }
+
+                for(int v : V)
+                {
+                    level[v] = -1;
+                }
+
+                if(ncomp > 1)
+                {
+                    if(right.empty() == true)
+                    {
+                        right.assign(left.begin() + last, left.end());
+                        left.resize(last);
+                    }
+
+                    continue;
+                }
+
+                left.clear();
+                right.clear();
+
+                // Level structure rooted at a pseudo-peripheral vertex
+                int root    = V[0];
+                int nlevels = bfs(root);
+
+                for(int sweep = 0; sweep < 8; ++sweep)
+                {
+                    int far = queue.back();
+
+                    reset();
+
+                    int nl = bfs(far);
+
+                    if(nl <= nlevels)
+                    {
+                        reset();
+                        nlevels = bfs(root);
+                        break;
+                    }
+
+                    root    = far;
+                    nlevels = nl;
+                }
+
+                // A separator needs a level on each side
+                if(nlevels < 3)
+                {
+                    reset();
+
+                    std::vector<int> order(nv);
+
+                    host_minimum_degree(V, adj_ptr, adj, owner, t, local, order.data());
+                    V.swap(order);
+
+                    continue;
+                }
+
+                // The middle level splits the vertices in halves
+                std::vector<int> count(nlevels, 0);
+
+                for(int v : queue)
+                {
+                    ++count[level[v]];
+                }
+
+                int mid = 0;
+
+                for(int sum = 0; mid < nlevels - 1; ++mid)
+                {
+                    sum += count[mid];
+
+                    if(sum >= nv / 2)
+                    {
+                        break;
+                    }
+                }
+
+                mid = std::max(1, std::min(mid, nlevels - 2));
+
+                for(int v : queue)
+                {
+                    side[v] = (level[v] < mid) ? 0 : ((level[v] > mid) ? 1 : 2);
+                }
+
+                // Separator vertices adjacent to one side only are moved to that side
+                for(int v : queue)
+                {
+                    if(side[v] != 2)
+                    {
+                        continue;
+                    }
+
+                    bool nbh[2] = {false, false};
+
+                    for(PtrType j = adj_ptr[v]; j < adj_ptr[v + 1]; ++j)
+                    {
+                        int w = adj[j];
+
+                        if(owner[w] == t && side[w] != 2)
+                        {
+                            nbh[side[w]] = true;
+                        }
+                    }
+
+                    if(nbh[1] == false)
+                    {
+                        side[v] = 0;
+                    }
+                    else if(nbh[0] == false)
+                    {
+                        side[v] = 1;
+                    }
+                }
+
+                reset();
+
+                for(int v : V)
+                {
+                    split[3 * t + side[v]].push_back(v);
+                }
+            }
+
+            // Separators become inner nodes with two children on the next level
+            std::vector<int> next;
+
+            for(int t = 0; t < ntask; ++t)
+            {
+                if(split[3 * t].empty() == true)
+                {
+                    continue;
+                }
+
+                int node = current[t];
+
+                for(int s = 0; s < 2; ++s)
+                {
+                    Node child;
+
+                    child.vertices.swap(split[3 * t + s]);
+                    child.parent = node;
+                    child.left   = -1;
+                    child.right  = -1;
+
+                    (s == 0 ? tree[node].left : tree[node].right) = static_cast<int>(tree.size());
+
+                    next.push_back(static_cast<int>(tree.size()));
+                    tree.push_back(std::move(child));
+                }
+
+                tree[node].vertices.swap(split[3 * t + 2]);
+            }
+
+            // Separators and leaves are done
+            for(int t = 0; t < ntask; ++t)
+            {
+                for(int v : tree[current[t]].vertices)
+                {
+                    owner[v] = -1;
+                }
+            }
+
+            current.swap(next);
+        }
+
+        // Number the nodes in post order, children come before their separator
+        std::vector<int> post;
+        std::vector<int> index(tree.size());
+
+        std::vector<std::pair<int, bool>> stack(1, std::make_pair(0, false));
+
+        while(stack.empty() == false)
+        {
+            std::pair<int, bool> top = stack.back();
+            stack.pop_back();
+
+            const Node& node = tree[top.first];
+
+            if(top.second == true || node.left < 0)
+            {
+                index[top.first] = static_cast<int>(post.size());
+                post.push_back(top.first);
+
+                continue;
+            }
+
+            stack.push_back(std::make_pair(top.first, true));
+            stack.push_back(std::make_pair(node.right, false));
+            stack.push_back(std::make_pair(node.left, false));
+        }
+
+        num_nodes = static_cast<int>(post.size());
+
+        allocate_host(num_nodes + 1, node_offset);
+        allocate_host(num_nodes, node_parent);
+
+        (*node_offset)[0] = 0;
+
+        for(int k = 0; k < num_nodes; ++k)
+        {
+            const Node& node = tree[post[k]];
+
+            int pos = (*node_offset)[k];
+
+            for(int v : node.vertices)
+            {
+                cast_perm->vec_[v] = pos++;
+            }
+
+            (*node_offset)[k + 1] = pos;
+            (*node_parent)[k]     = (node.parent < 0) ? -1 : index[node.parent];
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map, int n, int m)
+    {
+        assert(map.GetSize() == n);
+
+        const HostVector<int>* cast_map = dynamic_cast<const HostVector<int>*>(&map);
+
+        assert(cast_map != NULL);
+
+        int*     row_nnz    = NULL;
+        PtrType* row_buffer = NULL;
+        allocate_host(m, &row_nnz);
+        allocate_host(m + 1, &row_buffer);
+
+        set_to_zero_host(m, row_nnz);
+
+        int nnz = 0;
+
+        for(int i = 0; i < n; ++i)
+        {
+            assert(cast_map->vec_[i] < m);
+
+            if(cast_map->vec_[i] < 0)
+            {
+                continue;
             }
 
-            for(int ai = 0; ai < cast_T->ncol_; ++ai)
-            {
-                for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1];
-                    ++aj)
-                {
-                    int     ind_col = this->mat_.col[aj];
-                    PtrType ind     = cast_T->mat_.row_offset[ind_col];
+            ++row_nnz[cast_map->vec_[i]];
+            ++nnz;
+        }
 
-                    cast_T->mat_.col[ind] = ai;
-                    cast_T->mat_.val[ind] = this->mat_.val[aj];
+        this->Clear();
+        this->AllocateCSR(nnz, m, n);
 
-                    cast_T->mat_.row_offset[ind_col] += 1;
-                }
-            }
+        this->mat_.row_offset[0] = 0;
+        row_buffer[0]            = 0;
 
-            PtrType shift = 0;
-            for(int i = 0; i < cast_T->nrow_; ++i)
+        for(int i = 0; i < m; ++i)
+        {
+            this->mat_.row_offset[i + 1] = this->mat_.row_offset[i] + row_nnz[i];
+            row_buffer[i + 1]            = this->mat_.row_offset[i + 1];
+        }
+
+        for(int i = 0; i < nnz; ++i)
+        {
+            if(cast_map->vec_[i] < 0)
             {
-                PtrType tmp                = cast_T->mat_.row_offset[i];
-                cast_T->mat_.row_offset[i] = shift;
-                shift                      = tmp;
+                continue;
             }
 
-            cast_T->mat_.row_offset[cast_T->nrow_] = shift;
-
-            assert(this->nnz_ == shift);
+            this->mat_.col[row_buffer[cast_map->vec_[i]]] = i;
+            this->mat_.val[i]                             = static_cast<ValueType>(1);
+            row_buffer[cast_map->vec_[i]]++;
         }
 
+        assert(this->mat_.row_offset[m] == nnz);
+
+        free_host(&row_nnz);
+        free_host(&row_buffer);
+
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::Sort(void)
+    bool HostMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map,
+                                                 int                    n,
+                                                 int                    m,
+                                                 BaseMatrix<ValueType>* pro)
     {
-        if(this->nnz_ > 0)
+        assert(map.GetSize() == n);
+        assert(pro != NULL);
+
+        const HostVector<int>*    cast_map = dynamic_cast<const HostVector<int>*>(&map);
+        HostMatrixCSR<ValueType>* cast_pro = dynamic_cast<HostMatrixCSR<ValueType>*>(pro);
+
+        assert(cast_pro != NULL);
+        assert(cast_map != NULL);
+
+        // Build restriction operator
+        this->CreateFromMap(map, n, m);
+
+        // Build prolongation operator
+        cast_pro->Clear();
+        cast_pro->AllocateCSR(this->nnz_, n, m);
+
+        int k = 0;
+
+        for(int i = 0; i < n; ++i)
         {
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int i = 0; i < this->nrow_; ++i)
+            cast_pro->mat_.row_offset[i + 1] = cast_pro->mat_.row_offset[i];
+
+            // Check for entry in i-th row
+            if(cast_map->vec_[i] < 0)
             {
-                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-                {
-                    for(PtrType jj = this->mat_.row_offset[i];
-                        jj < this->mat_.row_offset[i + 1] - 1;
-                        ++jj)
-                    {
-                        if(this->mat_.col[jj] > this->mat_.col[jj + 1])
-                        {
-                            // swap elements
-                            int       ind = this->mat_.col[jj];
-                            ValueType val = this->mat_.val[jj];
+                continue;
+            }
 
-                            this->mat_.col[jj] = this->mat_.col[jj + 1];
-                            this->mat_.val[jj] = this->mat_.val[jj + 1];
+            assert(cast_map->vec_[i] < m);
 
-                            this->mat_.col[jj + 1] = ind;
-                            this->mat_.val[jj + 1] = val;
-                        }
-                    }
-                }
-            }
+            ++cast_pro->mat_.row_offset[i + 1];
+            cast_pro->mat_.col[k] = cast_map->vec_[i];
+            cast_pro->mat_.val[k] = static_cast<ValueType>(1);
+            ++k;
         }
 
         return true;
     }
 
+    // ----------------------------------------------------------
+    // original function connect(const spmat &A,
+    //                           float eps_strong)
+    // ----------------------------------------------------------
+    // Modified and adapted from AMGCL,
+    // https://github.com/ddemidov/amgcl
+    // MIT License
+    // ----------------------------------------------------------
+    // CHANGELOG
+    // - adapted interface
+    // ----------------------------------------------------------
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::Permute(const BaseVector<int>& permutation)
+    bool HostMatrixCSR<ValueType>::AMGConnect(ValueType eps, BaseVector<int>* connections) const
     {
-        assert((permutation.GetSize() == this->nrow_) && (permutation.GetSize() == this->ncol_));
+        assert(connections != NULL);
 
-        if(this->nnz_ > 0)
-        {
-            const HostVector<int>* cast_perm = dynamic_cast<const HostVector<int>*>(&permutation);
-            assert(cast_perm != NULL);
+        HostVector<int>* cast_conn = dynamic_cast<HostVector<int>*>(connections);
+        assert(cast_conn != NULL);
 
-            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        cast_conn->Clear();
+        cast_conn->Allocate(this->nnz_);
 
-            // Calculate nnz per row
-            int* row_nnz = NULL;
-            allocate_host(this->nrow_, &row_nnz);
+        ValueType eps2 = eps * eps;
+
+        HostVector<ValueType> vec_diag(this->local_backend_);
+        vec_diag.Allocate(this->nrow_);
+        this->ExtractDiagonal(&vec_diag);
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 1024)
 #endif
-            for(int i = 0; i < this->nrow_; ++i)
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            ValueType eps_dia_i = eps2 * vec_diag.vec_[i];
+
+            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                row_nnz[i]
-                    = static_cast<int>(this->mat_.row_offset[i + 1] - this->mat_.row_offset[i]);
+                int       c = this->mat_.col[j];
+                ValueType v = this->mat_.val[j];
+
+                cast_conn->vec_[j] = (c != i) && (v * v > eps_dia_i * vec_diag.vec_[c]);
             }
+        }
 
-            // Permute vector of nnz per row
-            int* perm_row_nnz = NULL;
-            allocate_host(this->nrow_, &perm_row_nnz);
+        return true;
+    }
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int i = 0; i < this->nrow_; ++i)
+    // ----------------------------------------------------------
+    // original function aggregates( const spmat &A,
+    //                               const std::vector<char> &S )
+    // ----------------------------------------------------------
+    // Modified and adapted from AMGCL,
+    // https://github.com/ddemidov/amgcl
+    // MIT License
+    // ----------------------------------------------------------
+    // CHANGELOG
+    // - adapted interface
+    // ----------------------------------------------------------
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AMGAggregate(const BaseVector<int>& connections,
+                                                BaseVector<int>*       aggregates) const
+    {
+        assert(aggregates != NULL);
+
+        HostVector<int>*       cast_agg  = dynamic_cast<HostVector<int>*>(aggregates);
+        const HostVector<int>* cast_conn = dynamic_cast<const HostVector<int>*>(&connections);
+
+        assert(cast_agg != NULL);
+        assert(cast_conn != NULL);
+
+        aggregates->Clear();
+        aggregates->Allocate(this->nrow_);
+
+        const int undefined = -1;
+        const int removed   = -2;
+
+        // Remove nodes without neighbours
+        int max_neib = 0;
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            PtrType j = this->mat_.row_offset[i];
+            PtrType e = this->mat_.row_offset[i + 1];
+            max_neib  = std::max(static_cast<int>(e - j), max_neib);
+            int state = removed;
+            for(; j < e; ++j)
             {
-                perm_row_nnz[cast_perm->vec_[i]] = row_nnz[i];
+                if(cast_conn->vec_[j])
+                {
+                    state = undefined;
+                    break;
+                }
             }
+            cast_agg->vec_[i] = state;
+        }
+        std::vector<int> neib;
+        neib.reserve(max_neib);
 
-            // Calculate new nnz
-            PtrType* perm_nnz = NULL;
-            allocate_host(this->nrow_ + 1, &perm_nnz);
-            PtrType sum = 0;
+        int last_g = -1;
 
-            for(int i = 0; i < this->nrow_; ++i)
+        // Perform plain aggregation
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            if(cast_agg->vec_[i] != undefined)
             {
-                perm_nnz[i] = sum;
-                sum += perm_row_nnz[i];
+                continue;
             }
 
-            perm_nnz[this->nrow_] = sum;
+            // The point is not adjacent to a core of any previous aggregate:
+            // so its a seed of a new aggregate.
+            cast_agg->vec_[i] = ++last_g;
 
-            // Permute rows
-            int*       col = NULL;
-            ValueType* val = NULL;
-            allocate_host(this->nnz_, &col);
-            allocate_host(this->nnz_, &val);
+            neib.clear();
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int i = 0; i < this->nrow_; ++i)
+            // Include its neighbors as well.
+            for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
             {
-                PtrType permIndex = perm_nnz[cast_perm->vec_[i]];
-                PtrType prevIndex = this->mat_.row_offset[i];
-
-                for(int j = 0; j < row_nnz[i]; ++j)
+                int c = this->mat_.col[j];
+                if(cast_conn->vec_[j] && cast_agg->vec_[c] != removed)
                 {
-                    col[permIndex + j] = this->mat_.col[prevIndex + j];
-                    val[permIndex + j] = this->mat_.val[prevIndex + j];
+                    cast_agg->vec_[c] = last_g;
+                    neib.push_back(c);
                 }
             }
-
-// Permute columns
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int i = 0; i < this->nrow_; ++i)
+            // Temporarily mark undefined points adjacent to the new aggregate as
+            // belonging to the aggregate. If nobody claims them later, they will
+            // stay here.
+            for(typename std::vector<int>::const_iterator nb = neib.begin(); nb != neib.end(); ++nb)
             {
-                PtrType row_index = perm_nnz[i];
-
-                for(int j = 0; j < perm_row_nnz[i]; ++j)
+                for(PtrType j = this->mat_.row_offset[*nb], e = this->mat_.row_offset[*nb + 1];
+                    j < e;
+                    ++j)
                 {
-                    int k     = j - 1;
-                    int aComp = col[row_index + j];
-                    int comp  = cast_perm->vec_[aComp];
-                    for(; k >= 0; --k)
+                    if(cast_conn->vec_[j] && cast_agg->vec_[this->mat_.col[j]] == undefined)
                     {
-                        if(this->mat_.col[row_index + k] > comp)
-                        {
-                            this->mat_.val[row_index + k + 1] = this->mat_.val[row_index + k];
-                            this->mat_.col[row_index + k + 1] = this->mat_.col[row_index + k];
-                        }
-                        else
-                        {
-                            break;
-                        }
+                        cast_agg->vec_[this->mat_.col[j]] = last_g;
                     }
-
-                    this->mat_.val[row_index + k + 1] = val[row_index + j];
-                    this->mat_.col[row_index + k + 1] = comp;
                 }
             }
-
-            free_host(&this->mat_.row_offset);
-            this->mat_.row_offset = perm_nnz;
-            free_host(&col);
-            free_host(&val);
-            free_host(&row_nnz);
-            free_host(&perm_row_nnz);
         }
-
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::CMK(BaseVector<int>* permutation) const
+    bool HostMatrixCSR<ValueType>::AMGPMISAggregate(const BaseVector<int>& connections,
+                                                    BaseVector<int>*       aggregates) const
     {
-        assert(this->nnz_ > 0);
-        assert(permutation != NULL);
-
-        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-        assert(cast_perm != NULL);
-
-        cast_perm->Clear();
-        cast_perm->Allocate(this->nrow_);
+        assert(aggregates != NULL);
 
-        int next   = 0;
-        int head   = 0;
-        int tmp    = 0;
-        int test   = 1;
-        int maxdeg = 0;
+        HostVector<int>*       cast_agg  = dynamic_cast<HostVector<int>*>(aggregates);
+        const HostVector<int>* cast_conn = dynamic_cast<const HostVector<int>*>(&connections);
 
-        int* nd         = NULL;
-        int* marker     = NULL;
-        int* levset     = NULL;
-        int* nextlevset = NULL;
+        assert(cast_agg != NULL);
+        assert(cast_conn != NULL);
 
-        allocate_host(this->nrow_, &nd);
-        allocate_host(this->nrow_, &marker);
-        allocate_host(this->nrow_, &levset);
-        allocate_host(this->nrow_, &nextlevset);
+        aggregates->Clear();
+        aggregates->Allocate(this->nrow_);
 
-        int qlength = 1;
+        std::vector<mis_tuple> tuples(this->nrow_);
+        std::vector<mis_tuple> max_tuples(this->nrow_);
 
-        for(int k = 0; k < this->nrow_; ++k)
+        // Initialize tuples
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            marker[k] = 0;
-            nd[k] = static_cast<int>(this->mat_.row_offset[k + 1] - this->mat_.row_offset[k] - 1);
+            int state = -2;
 
-            if(nd[k] > maxdeg)
+            PtrType row_start = this->mat_.row_offset[i];
+            PtrType row_end   = this->mat_.row_offset[i + 1];
+            for(PtrType j = row_start; j < row_end; j++)
             {
-                maxdeg = nd[k];
+                if(cast_conn->vec_[j] == 1)
+                {
+                    state = 0;
+                    break;
+                }
             }
-        }
 
-        head               = this->mat_.col[0];
-        levset[0]          = head;
-        cast_perm->vec_[0] = 0;
-        ++next;
-        marker[head] = 1;
+            unsigned int hash = i;
+            hash              = ((hash >> 16) ^ hash) * 0x45d9f3b;
+            hash              = ((hash >> 16) ^ hash) * 0x45d9f3b;
+            hash              = (hash >> 16) ^ hash;
 
-        while(next < this->nrow_)
-        {
-            int position = 0;
+            tuples[i].s = state;
+            tuples[i].v = hash;
+            tuples[i].i = i;
+        }
 
-            for(int h = 0; h < qlength; ++h)
+        bool done = false;
+        int  iter = 0;
+        while(!done)
+        {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
             {
-                head = levset[h];
+                max_tuples[i] = tuples[i];
+            }
 
-                for(PtrType k = this->mat_.row_offset[head]; k < this->mat_.row_offset[head + 1];
-                    ++k)
+            for(int k = 0; k < 2; k++)
+            {
+                // Find max tuples
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+                for(int i = 0; i < this->nrow_; ++i)
                 {
-                    tmp = this->mat_.col[k];
+                    mis_tuple t_max = max_tuples[i];
 
-                    if((marker[tmp] == 0) && (tmp != head))
+                    PtrType row_start = this->mat_.row_offset[t_max.i];
+                    PtrType row_end   = this->mat_.row_offset[t_max.i + 1];
+                    for(PtrType j = row_start; j < row_end; j++)
                     {
-                        nextlevset[position] = tmp;
-                        marker[tmp]          = 1;
-                        cast_perm->vec_[tmp] = next;
-                        ++next;
-                        ++position;
+                        if(cast_conn->vec_[j] == 1)
+                        {
+                            int       c  = this->mat_.col[j];
+                            mis_tuple tj = tuples[c];
+
+                            // find lexographical maximum
+                            if(tj.s > t_max.s)
+                            {
+                                t_max = tj;
+                            }
+                            else if(tj.s == t_max.s && (tj.v > t_max.v))
+                            {
+                                t_max = tj;
+                            }
+                        }
                     }
+
+                    max_tuples[i] = t_max;
                 }
             }
 
-            qlength = position;
+            done = true;
 
-            while(test == 1)
+            // Update tuples
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
             {
-                test = 0;
-
-                for(int j = position - 1; j > 0; --j)
+                if(tuples[i].s == 0)
                 {
-                    if(nd[nextlevset[j]] < nd[nextlevset[j - 1]])
+                    mis_tuple t_max = max_tuples[i];
+
+                    if(t_max.i == i)
                     {
-                        tmp               = nextlevset[j];
-                        nextlevset[j]     = nextlevset[j - 1];
-                        nextlevset[j - 1] = tmp;
-                        test              = 1;
+                        tuples[i].s       = 1;
+                        cast_agg->vec_[i] = 1;
+                    }
+                    else if(t_max.s == 1)
+                    {
+                        tuples[i].s       = -1;
+                        cast_agg->vec_[i] = 0;
+                    }
+                    else
+                    {
+                        done = false;
                     }
                 }
             }
 
-            for(int i = 0; i < position; ++i)
+            iter++;
+
+            if(iter > 10)
             {
-                levset[i] = nextlevset[i];
+                LOG_VERBOSE_INFO(
+                    2,
+                    "*** warning: HostMatrixCSR::AMGPMISAggregate() Current number of iterations: "
+                        << iter);
             }
+        }
 
-            if(qlength == 0)
+        // exclusive scan on aggregates array
+        int sum = 0;
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            int temp          = cast_agg->vec_[i];
+            cast_agg->vec_[i] = sum;
+            sum += temp;
+        }
+
+        for(int k = 0; k < 2; k++)
+        {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
             {
-                for(int i = 0; i < this->nrow_; ++i)
+                max_tuples[i] = tuples[i];
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                mis_tuple t = max_tuples[i];
+
+                assert(t.s != 0);
+
+                if(t.s == -1)
                 {
-                    if(marker[i] == 0)
+                    PtrType row_start = this->mat_.row_offset[i];
+                    PtrType row_end   = this->mat_.row_offset[i + 1];
+
+                    for(PtrType j = row_start; j < row_end; j++)
                     {
-                        levset[0]          = i;
-                        qlength            = 1;
-                        cast_perm->vec_[i] = next;
-                        marker[i]          = 1;
-                        ++next;
+                        if(cast_conn->vec_[j] == 1)
+                        {
+                            int c = this->mat_.col[j];
+
+                            if(max_tuples[c].s == 1)
+                            {
+                                cast_agg->vec_[i] = cast_agg->vec_[c];
+                                tuples[i].s       = 1;
+                                break;
+                            }
+                        }
                     }
                 }
+                else if(t.s == -2)
+                {
+                    cast_agg->vec_[i] = -2;
+                }
             }
         }
 
-        free_host(&nd);
-        free_host(&marker);
-        free_host(&levset);
-        free_host(&nextlevset);
-
         return true;
     }
 
+    // ----------------------------------------------------------
+    // original function interp(const sparse::matrix<value_t,
+    //                          index_t> &A, const params &prm)
+    // ----------------------------------------------------------
+    // Modified and adapted from AMGCL,
+    // https://github.com/ddemidov/amgcl
+    // MIT License
+    // ----------------------------------------------------------
+    // CHANGELOG
+    // - adapted interface
+    // ----------------------------------------------------------
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::RCMK(BaseVector<int>* permutation) const
+    bool HostMatrixCSR<ValueType>::AMGSmoothedAggregation(ValueType              relax,
+                                                          const BaseVector<int>& aggregates,
+                                                          const BaseVector<int>& connections,
+                                                          BaseMatrix<ValueType>* prolong,
+                                                          int lumping_strat) const
     {
-        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-        assert(cast_perm != NULL);
-
-        cast_perm->Clear();
-        cast_perm->Allocate(this->nrow_);
-
-        HostVector<int> tmp_perm(this->local_backend_);
-
-        this->CMK(&tmp_perm);
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            cast_perm->vec_[i] = this->nrow_ - tmp_perm.vec_[i] - 1;
-        }
+        assert(prolong != NULL);
 
-        return true;
-    }
+        const HostVector<int>*    cast_agg     = dynamic_cast<const HostVector<int>*>(&aggregates);
+        const HostVector<int>*    cast_conn    = dynamic_cast<const HostVector<int>*>(&connections);
+        HostMatrixCSR<ValueType>* cast_prolong = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::ConnectivityOrder(BaseVector<int>* permutation) const
-    {
-        HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-        assert(cast_perm != NULL);
+        assert(cast_agg != NULL);
+        assert(cast_conn != NULL);
+        assert(cast_prolong != NULL);
 
-        cast_perm->Clear();
-        cast_perm->Allocate(this->nrow_);
+        // Allocate
+        cast_prolong->Clear();
+        cast_prolong->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
 
-        std::multimap<int, int> map;
+        int ncol = 0;
 
-        for(int i = 0; i < this->nrow_; ++i)
+        for(int i = 0; i < cast_agg->GetSize(); ++i)
         {
-            map.insert(
-                std::pair<int, int>(this->mat_.row_offset[i + 1] - this->mat_.row_offset[i], i));
+            if(cast_agg->vec_[i] > ncol)
+            {
+                ncol = cast_agg->vec_[i];
+            }
         }
 
-        std::multimap<int, int>::iterator it = map.begin();
+        ++ncol;
 
-        for(int i = 0; i < this->nrow_; ++i, ++it)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
         {
-            cast_perm->vec_[i] = it->second;
-        }
-
-        return true;
-    }
+            std::vector<PtrType> marker(ncol, -1);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map, int n, int m)
-    {
-        assert(map.GetSize() == n);
+#ifdef _OPENMP
+            int nt  = omp_get_num_threads();
+            int tid = omp_get_thread_num();
 
-        const HostVector<int>* cast_map = dynamic_cast<const HostVector<int>*>(&map);
+            int chunk_size  = (this->nrow_ + nt - 1) / nt;
+            int chunk_start = tid * chunk_size;
+            int chunk_end   = std::min(this->nrow_, chunk_start + chunk_size);
+#else
+            int chunk_start = 0;
+            int chunk_end   = this->nrow_;
+#endif
 
-        assert(cast_map != NULL);
+            // Count number of entries in prolong
+            for(int i = chunk_start; i < chunk_end; ++i)
+            {
+                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
+                    ++j)
+                {
+                    int c = this->mat_.col[j];
 
-        int*     row_nnz    = NULL;
-        PtrType* row_buffer = NULL;
-        allocate_host(m, &row_nnz);
-        allocate_host(m + 1, &row_buffer);
+                    if(c != i && !cast_conn->vec_[j])
+                    {
+                        continue;
+                    }
 
-        set_to_zero_host(m, row_nnz);
+                    int g = cast_agg->vec_[c];
 
-        int nnz = 0;
+                    if(g >= 0 && marker[g] != i)
+                    {
+                        marker[g] = i;
+                        ++cast_prolong->mat_.row_offset[i + 1];
+                    }
+                }
+            }
 
-        for(int i = 0; i < n; ++i)
-        {
-            assert(cast_map->vec_[i] < m);
+            std::fill(marker.begin(), marker.end(), -1);
 
-            if(cast_map->vec_[i] < 0)
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
             {
-                continue;
-            }
+                PtrType* row_offset = NULL;
+                allocate_host(cast_prolong->nrow_ + 1, &row_offset);
 
-            ++row_nnz[cast_map->vec_[i]];
-            ++nnz;
-        }
+                int*       col = NULL;
+                ValueType* val = NULL;
 
-        this->Clear();
-        this->AllocateCSR(nnz, m, n);
+                int64_t nnz   = 0;
+                int     nrow  = cast_prolong->nrow_;
+                row_offset[0] = 0;
+                for(int i = 1; i < nrow + 1; ++i)
+                {
+                    row_offset[i] = cast_prolong->mat_.row_offset[i] + row_offset[i - 1];
+                }
 
-        this->mat_.row_offset[0] = 0;
-        row_buffer[0]            = 0;
+                nnz = row_offset[nrow];
 
-        for(int i = 0; i < m; ++i)
-        {
-            this->mat_.row_offset[i + 1] = this->mat_.row_offset[i] + row_nnz[i];
-            row_buffer[i + 1]            = this->mat_.row_offset[i + 1];
-        }
+                allocate_host(nnz, &col);
+                allocate_host(nnz, &val);
 
-        for(int i = 0; i < nnz; ++i)
-        {
-            if(cast_map->vec_[i] < 0)
-            {
-                continue;
+                cast_prolong->Clear();
+                cast_prolong->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
             }
 
-            this->mat_.col[row_buffer[cast_map->vec_[i]]] = i;
-            this->mat_.val[i]                             = static_cast<ValueType>(1);
-            row_buffer[cast_map->vec_[i]]++;
-        }
-
-        assert(this->mat_.row_offset[m] == nnz);
-
-        free_host(&row_nnz);
-        free_host(&row_buffer);
-
-        return true;
-    }
-
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map,
-                                                 int                    n,
-                                                 int                    m,
-                                                 BaseMatrix<ValueType>* pro)
-    {
-        assert(map.GetSize() == n);
-        assert(pro != NULL);
+            // Fill the interpolation matrix.
+            for(int i = chunk_start; i < chunk_end; ++i)
+            {
+                // Diagonal of the filtered matrix is original matrix diagonal plus (lumping_strat = 0) or
+                // minus (lumping_strat = 1) its weak connections.
+                ValueType dia = static_cast<ValueType>(0);
+                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
+                    ++j)
+                {
+                    if(this->mat_.col[j] == i)
+                    {
+                        dia += this->mat_.val[j];
+                    }
+                    else if(!cast_conn->vec_[j])
+                    {
+                        if(lumping_strat == 0)
+                        {
+                            dia += this->mat_.val[j];
+                        }
+                        else
+                        {
+                            dia -= this->mat_.val[j];
+                        }
+                    }
+                }
 
-        const HostVector<int>*    cast_map = dynamic_cast<const HostVector<int>*>(&map);
-        HostMatrixCSR<ValueType>* cast_pro = dynamic_cast<HostMatrixCSR<ValueType>*>(pro);
+                dia = static_cast<ValueType>(1) / dia;
 
-        assert(cast_pro != NULL);
-        assert(cast_map != NULL);
+                PtrType row_begin = cast_prolong->mat_.row_offset[i];
+                PtrType row_end   = row_begin;
 
-        // Build restriction operator
-        this->CreateFromMap(map, n, m);
+                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
+                    ++j)
+                {
+                    int c = this->mat_.col[j];
 
-        // Build prolongation operator
-        cast_pro->Clear();
-        cast_pro->AllocateCSR(this->nnz_, n, m);
+                    // Skip weak couplings, ...
+                    if(c != i && !cast_conn->vec_[j])
+                    {
+                        continue;
+                    }
 
-        int k = 0;
+                    // ... and the ones not in any aggregate.
+                    int g = cast_agg->vec_[c];
+                    if(g < 0)
+                    {
+                        continue;
+                    }
 
-        for(int i = 0; i < n; ++i)
-        {
-            cast_pro->mat_.row_offset[i + 1] = cast_pro->mat_.row_offset[i];
+                    ValueType v = (c == i) ? static_cast<ValueType>(1) - relax
+                                           : -relax * dia * this->mat_.val[j];
 
-            // Check for entry in i-th row
-            if(cast_map->vec_[i] < 0)
-            {
-                continue;
+                    if(marker[g] < row_begin)
+                    {
+                        marker[g]                       = row_end;
+                        cast_prolong->mat_.col[row_end] = g;
+                        cast_prolong->mat_.val[row_end] = v;
+                        ++row_end;
+                    }
+                    else
+                    {
+                        cast_prolong->mat_.val[marker[g]] += v;
+                    }
+                }
             }
-
-            assert(cast_map->vec_[i] < m);
-
-            ++cast_pro->mat_.row_offset[i + 1];
-            cast_pro->mat_.col[k] = cast_map->vec_[i];
-            cast_pro->mat_.val[k] = static_cast<ValueType>(1);
-            ++k;
         }
 
+        cast_prolong->Sort();
+
         return true;
     }
 
     // ----------------------------------------------------------
-    // original function connect(const spmat &A,
-    //                           float eps_strong)
+    // original function interp(const sparse::matrix<value_t,
+    //                          index_t> &A, const params &prm)
     // ----------------------------------------------------------
     // Modified and adapted from AMGCL,
     // https://github.com/ddemidov/amgcl
@@ -4243,38 +9230,65 @@ namespace rocalution
     // - adapted interface
     // ----------------------------------------------------------
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGConnect(ValueType eps, BaseVector<int>* connections) const
+    bool HostMatrixCSR<ValueType>::AMGAggregation(const BaseVector<int>& aggregates,
+                                                  BaseMatrix<ValueType>* prolong) const
     {
-        assert(connections != NULL);
+        assert(prolong != NULL);
 
-        HostVector<int>* cast_conn = dynamic_cast<HostVector<int>*>(connections);
-        assert(cast_conn != NULL);
+        const HostVector<int>*    cast_agg     = dynamic_cast<const HostVector<int>*>(&aggregates);
+        HostMatrixCSR<ValueType>* cast_prolong = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
 
-        cast_conn->Clear();
-        cast_conn->Allocate(this->nnz_);
+        assert(cast_agg != NULL);
+        assert(cast_prolong != NULL);
 
-        ValueType eps2 = eps * eps;
+        int ncol = 0;
 
-        HostVector<ValueType> vec_diag(this->local_backend_);
-        vec_diag.Allocate(this->nrow_);
-        this->ExtractDiagonal(&vec_diag);
+        for(int i = 0; i < cast_agg->GetSize(); ++i)
+        {
+            if(cast_agg->vec_[i] > ncol)
+            {
+                ncol = cast_agg->vec_[i];
+            }
+        }
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
+        ++ncol;
+
+        PtrType* row_offset = NULL;
+        allocate_host(this->nrow_ + 1, &row_offset);
+
+        int*       col = NULL;
+        ValueType* val = NULL;
+
+        row_offset[0] = 0;
         for(int i = 0; i < this->nrow_; ++i)
         {
-            ValueType eps_dia_i = eps2 * vec_diag.vec_[i];
-
-            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            if(cast_agg->vec_[i] >= 0)
             {
-                int       c = this->mat_.col[j];
-                ValueType v = this->mat_.val[j];
+                row_offset[i + 1] = row_offset[i] + 1;
+            }
+            else
+            {
+                row_offset[i + 1] = row_offset[i];
+            }
+        }
 
-                cast_conn->vec_[j] = (c != i) && (v * v > eps_dia_i * vec_diag.vec_[c]);
+        allocate_host(row_offset[this->nrow_], &col);
+        allocate_host(row_offset[this->nrow_], &val);
+
+        for(int i = 0, j = 0; i < this->nrow_; ++i)
+        {
+            if(cast_agg->vec_[i] >= 0)
+            {
+                col[j] = cast_agg->vec_[i];
+                val[j] = 1.0;
+                ++j;
             }
         }
 
+        cast_prolong->Clear();
+        cast_prolong->SetDataPtrCSR(
+            &row_offset, &col, &val, row_offset[this->nrow_], this->nrow_, ncol);
+
         return true;
     }
 
@@ -4290,20 +9304,23 @@ namespace rocalution
     // - adapted interface
     // ----------------------------------------------------------
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGAggregate(const BaseVector<int>& connections,
-                                                BaseVector<int>*       aggregates) const
+    bool HostMatrixCSR<ValueType>::AMGGreedyAggregate(
+        const BaseVector<bool>& connections,
+        BaseVector<int64_t>*    aggregates,
+        BaseVector<int64_t>*    aggregate_root_nodes) const
     {
+        assert(aggregate_root_nodes != NULL);
         assert(aggregates != NULL);
 
-        HostVector<int>*       cast_agg  = dynamic_cast<HostVector<int>*>(aggregates);
-        const HostVector<int>* cast_conn = dynamic_cast<const HostVector<int>*>(&connections);
+        HostVector<int64_t>* cast_agg_nodes
+            = dynamic_cast<HostVector<int64_t>*>(aggregate_root_nodes);
+        HostVector<int64_t>*    cast_agg  = dynamic_cast<HostVector<int64_t>*>(aggregates);
+        const HostVector<bool>* cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
 
+        assert(cast_agg_nodes != NULL);
         assert(cast_agg != NULL);
         assert(cast_conn != NULL);
 
-        aggregates->Clear();
-        aggregates->Allocate(this->nrow_);
-
         const int undefined = -1;
         const int removed   = -2;
 
@@ -4313,7 +9330,9 @@ namespace rocalution
         {
             PtrType j = this->mat_.row_offset[i];
             PtrType e = this->mat_.row_offset[i + 1];
-            max_neib  = std::max(static_cast<int>(e - j), max_neib);
+
+            max_neib = std::max(static_cast<int>(e - j), max_neib);
+
             int state = removed;
             for(; j < e; ++j)
             {
@@ -4323,12 +9342,14 @@ namespace rocalution
                     break;
                 }
             }
+
             cast_agg->vec_[i] = state;
         }
+
         std::vector<int> neib;
         neib.reserve(max_neib);
 
-        int last_g = -1;
+        int64_t last_g = -1;
 
         // Perform plain aggregation
         for(int i = 0; i < this->nrow_; ++i)
@@ -4340,7 +9361,8 @@ namespace rocalution
 
             // The point is not adjacent to a core of any previous aggregate:
             // so its a seed of a new aggregate.
-            cast_agg->vec_[i] = ++last_g;
+            cast_agg->vec_[i]       = ++last_g;
+            cast_agg_nodes->vec_[i] = i;
 
             neib.clear();
 
@@ -4348,12 +9370,18 @@ namespace rocalution
             for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
             {
                 int c = this->mat_.col[j];
+
+                assert(c >= 0);
+                assert(c < this->nrow_);
+
                 if(cast_conn->vec_[j] && cast_agg->vec_[c] != removed)
                 {
-                    cast_agg->vec_[c] = last_g;
+                    cast_agg->vec_[c]       = last_g;
+                    cast_agg_nodes->vec_[c] = i;
                     neib.push_back(c);
                 }
             }
+
             // Temporarily mark undefined points adjacent to the new aggregate as
             // belonging to the aggregate. If nobody claims them later, they will
             // stay here.
@@ -4365,396 +9393,358 @@ namespace rocalution
                 {
                     if(cast_conn->vec_[j] && cast_agg->vec_[this->mat_.col[j]] == undefined)
                     {
-                        cast_agg->vec_[this->mat_.col[j]] = last_g;
+                        cast_agg->vec_[this->mat_.col[j]]       = last_g;
+                        cast_agg_nodes->vec_[this->mat_.col[j]] = i;
                     }
                 }
             }
         }
+
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGPMISAggregate(const BaseVector<int>& connections,
-                                                    BaseVector<int>*       aggregates) const
+    bool HostMatrixCSR<ValueType>::AMGBoundaryNnz(const BaseVector<int>&       boundary,
+                                                  const BaseVector<bool>&      connections,
+                                                  const BaseMatrix<ValueType>& ghost,
+                                                  BaseVector<PtrType>*         row_nnz) const
     {
-        assert(aggregates != NULL);
-
-        HostVector<int>*       cast_agg  = dynamic_cast<HostVector<int>*>(aggregates);
-        const HostVector<int>* cast_conn = dynamic_cast<const HostVector<int>*>(&connections);
+        const HostVector<int>*  cast_bnd  = dynamic_cast<const HostVector<int>*>(&boundary);
+        const HostVector<bool>* cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
+        const HostMatrixCSR<ValueType>* cast_gst
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
+        HostVector<PtrType>* cast_row_nnz = dynamic_cast<HostVector<PtrType>*>(row_nnz);
 
-        assert(cast_agg != NULL);
+        assert(cast_bnd != NULL);
         assert(cast_conn != NULL);
+        assert(cast_gst != NULL);
+        assert(cast_row_nnz != NULL);
 
-        aggregates->Clear();
-        aggregates->Allocate(this->nrow_);
+        assert(cast_row_nnz->size_ >= cast_bnd->size_);
 
-        std::vector<mis_tuple> tuples(this->nrow_);
-        std::vector<mis_tuple> max_tuples(this->nrow_);
+        bool global = cast_gst->nrow_ > 0;
 
-        // Initialize tuples
 #ifdef _OPENMP
 #pragma omp parallel for schedule(dynamic, 1024)
 #endif
-        for(int i = 0; i < this->nrow_; ++i)
+        for(int64_t i = 0; i < cast_bnd->size_; ++i)
         {
-            int state = -2;
-
-            PtrType row_start = this->mat_.row_offset[i];
-            PtrType row_end   = this->mat_.row_offset[i + 1];
-            for(PtrType j = row_start; j < row_end; j++)
-            {
-                if(cast_conn->vec_[j] == 1)
-                {
-                    state = 0;
-                    break;
-                }
-            }
-
-            unsigned int hash = i;
-            hash              = ((hash >> 16) ^ hash) * 0x45d9f3b;
-            hash              = ((hash >> 16) ^ hash) * 0x45d9f3b;
-            hash              = (hash >> 16) ^ hash;
+            // Get boundary row
+            int row = cast_bnd->vec_[i];
 
-            tuples[i].s = state;
-            tuples[i].v = hash;
-            tuples[i].i = i;
-        }
+            // Counter
+            PtrType ext_nnz = 0;
 
-        bool done = false;
-        int  iter = 0;
-        while(!done)
-        {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-            for(int i = 0; i < this->nrow_; ++i)
-            {
-                max_tuples[i] = tuples[i];
-            }
+            // Interior part
+            PtrType row_begin = this->mat_.row_offset[row];
+            PtrType row_end   = this->mat_.row_offset[row + 1];
 
-            for(int k = 0; k < 2; k++)
+            for(PtrType j = row_begin; j < row_end; ++j)
             {
-                // Find max tuples
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-                for(int i = 0; i < this->nrow_; ++i)
+                // Check whether this vertex is strongly connected
+                if(cast_conn->vec_[j] == true)
                 {
-                    mis_tuple t_max = max_tuples[i];
-
-                    PtrType row_start = this->mat_.row_offset[t_max.i];
-                    PtrType row_end   = this->mat_.row_offset[t_max.i + 1];
-                    for(PtrType j = row_start; j < row_end; j++)
-                    {
-                        if(cast_conn->vec_[j] == 1)
-                        {
-                            int       c  = this->mat_.col[j];
-                            mis_tuple tj = tuples[c];
-
-                            // find lexographical maximum
-                            if(tj.s > t_max.s)
-                            {
-                                t_max = tj;
-                            }
-                            else if(tj.s == t_max.s && (tj.v > t_max.v))
-                            {
-                                t_max = tj;
-                            }
-                        }
-                    }
-
-                    max_tuples[i] = t_max;
+                    ++ext_nnz;
                 }
             }
 
-            done = true;
-
-            // Update tuples
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-            for(int i = 0; i < this->nrow_; ++i)
+            if(global == true)
             {
-                if(tuples[i].s == 0)
-                {
-                    mis_tuple t_max = max_tuples[i];
+                // Ghost part
+                row_begin = cast_gst->mat_.row_offset[row];
+                row_end   = cast_gst->mat_.row_offset[row + 1];
 
-                    if(t_max.i == i)
-                    {
-                        tuples[i].s       = 1;
-                        cast_agg->vec_[i] = 1;
-                    }
-                    else if(t_max.s == 1)
-                    {
-                        tuples[i].s       = -1;
-                        cast_agg->vec_[i] = 0;
-                    }
-                    else
+                for(PtrType j = row_begin; j < row_end; ++j)
+                {
+                    // Check whether this vertex is strongly connected
+                    if(cast_conn->vec_[j + this->nnz_] == true)
                     {
-                        done = false;
+                        ++ext_nnz;
                     }
                 }
             }
 
-            iter++;
-
-            if(iter > 10)
-            {
-                LOG_VERBOSE_INFO(
-                    2,
-                    "*** warning: HostMatrixCSR::AMGPMISAggregate() Current number of iterations: "
-                        << iter);
-            }
+            // Write total number of strongly connected coarse vertices to global memory
+            cast_row_nnz->vec_[i] = ext_nnz;
         }
 
-        // exclusive scan on aggregates array
-        int sum = 0;
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            int temp          = cast_agg->vec_[i];
-            cast_agg->vec_[i] = sum;
-            sum += temp;
-        }
+        return true;
+    }
 
-        for(int k = 0; k < 2; k++)
-        {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-            for(int i = 0; i < this->nrow_; ++i)
-            {
-                max_tuples[i] = tuples[i];
-            }
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AMGExtractBoundary(int64_t                global_column_begin,
+                                                      const BaseVector<int>& boundary,
+                                                      const BaseVector<int64_t>&   l2g,
+                                                      const BaseVector<bool>&      connections,
+                                                      const BaseMatrix<ValueType>& ghost,
+                                                      const BaseVector<PtrType>&   bnd_csr_row_ptr,
+                                                      BaseVector<int64_t>* bnd_csr_col_ind) const
+    {
+        const HostVector<int>*     cast_bnd  = dynamic_cast<const HostVector<int>*>(&boundary);
+        const HostVector<int64_t>* cast_l2g  = dynamic_cast<const HostVector<int64_t>*>(&l2g);
+        const HostVector<bool>*    cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
+        const HostMatrixCSR<ValueType>* cast_gst
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
+        const HostVector<PtrType>* cast_bnd_ptr
+            = dynamic_cast<const HostVector<PtrType>*>(&bnd_csr_row_ptr);
+        HostVector<int64_t>* cast_bnd_col = dynamic_cast<HostVector<int64_t>*>(bnd_csr_col_ind);
+
+        assert(cast_bnd != NULL);
+        assert(cast_l2g != NULL);
+        assert(cast_conn != NULL);
+        assert(cast_gst != NULL);
+        assert(cast_bnd_ptr != NULL);
+        assert(cast_bnd_col != NULL);
 
 #ifdef _OPENMP
 #pragma omp parallel for schedule(dynamic, 1024)
 #endif
-            for(int i = 0; i < this->nrow_; ++i)
-            {
-                mis_tuple t = max_tuples[i];
+        for(int64_t i = 0; i < cast_bnd->size_; ++i)
+        {
+            // Get boundary row and index into A_ext
+            int     row  = cast_bnd->vec_[i];
+            PtrType idx  = cast_bnd_ptr->vec_[i];
+            PtrType idx2 = cast_bnd_ptr->vec_[i + 1];
 
-                assert(t.s != 0);
+            // Extract interior part
+            PtrType row_begin = this->mat_.row_offset[row];
+            PtrType row_end   = this->mat_.row_offset[row + 1];
 
-                if(t.s == -1)
+            for(PtrType j = row_begin; j < row_end; ++j)
+            {
+                // Check whether this vertex is strongly connected
+                if(cast_conn->vec_[j] == true)
                 {
-                    PtrType row_start = this->mat_.row_offset[i];
-                    PtrType row_end   = this->mat_.row_offset[i + 1];
+                    // Get column index
+                    int col = this->mat_.col[j];
 
-                    for(PtrType j = row_start; j < row_end; j++)
-                    {
-                        if(cast_conn->vec_[j] == 1)
-                        {
-                            int c = this->mat_.col[j];
+                    assert(col >= 0);
+                    assert(col < this->nrow_);
 
-                            if(max_tuples[c].s == 1)
-                            {
-                                cast_agg->vec_[i] = cast_agg->vec_[c];
-                                tuples[i].s       = 1;
-                                break;
-                            }
-                        }
-                    }
+                    // Shift column by global column offset, to obtain the global column index
+                    cast_bnd_col->vec_[idx++] = col + global_column_begin;
                 }
-                else if(t.s == -2)
+            }
+
+            // Extract ghost part
+            row_begin = cast_gst->mat_.row_offset[row];
+            row_end   = cast_gst->mat_.row_offset[row + 1];
+
+            for(PtrType j = row_begin; j < row_end; ++j)
+            {
+                // Check whether this vertex is strongly connected
+                if(cast_conn->vec_[j + this->nnz_] == true)
                 {
-                    cast_agg->vec_[i] = -2;
+                    // Get column index
+                    int col = cast_gst->mat_.col[j];
+
+                    // Transform local ghost index into global column index
+                    cast_bnd_col->vec_[idx++] = cast_l2g->vec_[col];
                 }
             }
+
+            assert(idx2 == idx);
         }
 
         return true;
     }
 
-    // ----------------------------------------------------------
-    // original function interp(const sparse::matrix<value_t,
-    //                          index_t> &A, const params &prm)
-    // ----------------------------------------------------------
-    // Modified and adapted from AMGCL,
-    // https://github.com/ddemidov/amgcl
-    // MIT License
-    // ----------------------------------------------------------
-    // CHANGELOG
-    // - adapted interface
-    // ----------------------------------------------------------
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGSmoothedAggregation(ValueType              relax,
-                                                          const BaseVector<int>& aggregates,
-                                                          const BaseVector<int>& connections,
-                                                          BaseMatrix<ValueType>* prolong,
-                                                          int lumping_strat) const
+    bool HostMatrixCSR<ValueType>::AMGNodeGraph(int blockdim, BaseMatrix<ValueType>* node) const
     {
-        assert(prolong != NULL);
-
-        const HostVector<int>*    cast_agg     = dynamic_cast<const HostVector<int>*>(&aggregates);
-        const HostVector<int>*    cast_conn    = dynamic_cast<const HostVector<int>*>(&connections);
-        HostMatrixCSR<ValueType>* cast_prolong = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
+        assert(node != NULL);
+        assert(blockdim > 0);
+        assert(this->nrow_ % blockdim == 0);
+        assert(this->ncol_ % blockdim == 0);
 
-        assert(cast_agg != NULL);
-        assert(cast_conn != NULL);
-        assert(cast_prolong != NULL);
+        HostMatrixCSR<ValueType>* cast_node = dynamic_cast<HostMatrixCSR<ValueType>*>(node);
 
-        // Allocate
-        cast_prolong->Clear();
-        cast_prolong->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
+        assert(cast_node != NULL);
 
-        int ncol = 0;
+        int nrowb = this->nrow_ / blockdim;
+        int ncolb = this->ncol_ / blockdim;
 
-        for(int i = 0; i < cast_agg->GetSize(); ++i)
-        {
-            if(cast_agg->vec_[i] > ncol)
-            {
-                ncol = cast_agg->vec_[i];
-            }
-        }
+        // Last node row that touched a node column and its position in that row
+        std::vector<int>     last(ncolb, -1);
+        std::vector<PtrType> pos(ncolb, 0);
 
-        ++ncol;
+        PtrType* row_offset = NULL;
+        allocate_host(nrowb + 1, &row_offset);
 
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
+        // Count the distinct node columns of each node row
+        row_offset[0] = 0;
+        for(int ib = 0; ib < nrowb; ++ib)
         {
-            std::vector<PtrType> marker(ncol, -1);
-
-#ifdef _OPENMP
-            int nt  = omp_get_num_threads();
-            int tid = omp_get_thread_num();
-
-            int chunk_size  = (this->nrow_ + nt - 1) / nt;
-            int chunk_start = tid * chunk_size;
-            int chunk_end   = std::min(this->nrow_, chunk_start + chunk_size);
-#else
-            int chunk_start = 0;
-            int chunk_end   = this->nrow_;
-#endif
+            PtrType nnzb = 0;
 
-            // Count number of entries in prolong
-            for(int i = chunk_start; i < chunk_end; ++i)
+            for(int i = ib * blockdim; i < (ib + 1) * blockdim; ++i)
             {
-                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
-                    ++j)
+                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
                 {
-                    int c = this->mat_.col[j];
-
-                    if(c != i && !cast_conn->vec_[j])
-                    {
-                        continue;
-                    }
-
-                    int g = cast_agg->vec_[c];
+                    int cb = this->mat_.col[j] / blockdim;
 
-                    if(g >= 0 && marker[g] != i)
+                    if(last[cb] != ib)
                     {
-                        marker[g] = i;
-                        ++cast_prolong->mat_.row_offset[i + 1];
+                        last[cb] = ib;
+                        ++nnzb;
                     }
                 }
             }
 
-            std::fill(marker.begin(), marker.end(), -1);
-
-#ifdef _OPENMP
-#pragma omp barrier
-#pragma omp single
-#endif
-            {
-                PtrType* row_offset = NULL;
-                allocate_host(cast_prolong->nrow_ + 1, &row_offset);
+            row_offset[ib + 1] = row_offset[ib] + nnzb;
+        }
 
-                int*       col = NULL;
-                ValueType* val = NULL;
+        int*       col = NULL;
+        ValueType* val = NULL;
 
-                int64_t nnz   = 0;
-                int     nrow  = cast_prolong->nrow_;
-                row_offset[0] = 0;
-                for(int i = 1; i < nrow + 1; ++i)
-                {
-                    row_offset[i] = cast_prolong->mat_.row_offset[i] + row_offset[i - 1];
-                }
+        allocate_host(row_offset[nrowb], &col);
+        allocate_host(row_offset[nrowb], &val);
 
-                nnz = row_offset[nrow];
+        set_to_zero_host(row_offset[nrowb], val);
 
-                allocate_host(nnz, &col);
-                allocate_host(nnz, &val);
+        std::fill(last.begin(), last.end(), -1);
 
-                cast_prolong->Clear();
-                cast_prolong->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
-            }
+        // Accumulate the squared entries of each block
+        for(int ib = 0; ib < nrowb; ++ib)
+        {
+            PtrType idx = row_offset[ib];
 
-            // Fill the interpolation matrix.
-            for(int i = chunk_start; i < chunk_end; ++i)
+            for(int i = ib * blockdim; i < (ib + 1) * blockdim; ++i)
             {
-                // Diagonal of the filtered matrix is original matrix diagonal plus (lumping_strat = 0) or
-                // minus (lumping_strat = 1) its weak connections.
-                ValueType dia = static_cast<ValueType>(0);
-                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
-                    ++j)
+                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
                 {
-                    if(this->mat_.col[j] == i)
-                    {
-                        dia += this->mat_.val[j];
-                    }
-                    else if(!cast_conn->vec_[j])
+                    int cb = this->mat_.col[j] / blockdim;
+
+                    if(last[cb] != ib)
                     {
-                        if(lumping_strat == 0)
-                        {
-                            dia += this->mat_.val[j];
-                        }
-                        else
-                        {
-                            dia -= this->mat_.val[j];
-                        }
+                        last[cb] = ib;
+                        pos[cb]  = idx;
+                        col[idx] = cb;
+                        ++idx;
                     }
+
+                    ValueType a = static_cast<ValueType>(std::abs(this->mat_.val[j]));
+                    val[pos[cb]] += a * a;
                 }
+            }
 
-                dia = static_cast<ValueType>(1) / dia;
+            assert(idx == row_offset[ib + 1]);
+        }
 
-                PtrType row_begin = cast_prolong->mat_.row_offset[i];
-                PtrType row_end   = row_begin;
+        // Frobenius norm of each block
+        for(PtrType j = 0; j < row_offset[nrowb]; ++j)
+        {
+            val[j] = std::sqrt(val[j]);
+        }
+
+        cast_node->Clear();
+        cast_node->SetDataPtrCSR(&row_offset, &col, &val, row_offset[nrowb], nrowb, ncolb);
+        cast_node->Sort();
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AMGNodeExpand(
+        int                          blockdim,
+        const BaseMatrix<ValueType>& node,
+        const BaseVector<bool>&      node_connections,
+        const BaseVector<int64_t>&   node_aggregates,
+        const BaseVector<int64_t>&   node_aggregate_root_nodes,
+        BaseVector<bool>*            connections,
+        BaseVector<int64_t>*         aggregates,
+        BaseVector<int64_t>*         aggregate_root_nodes) const
+    {
+        assert(connections != NULL);
+        assert(aggregates != NULL);
+        assert(aggregate_root_nodes != NULL);
+        assert(blockdim > 0);
+
+        const HostMatrixCSR<ValueType>* cast_node
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&node);
+        const HostVector<bool>* cast_node_conn
+            = dynamic_cast<const HostVector<bool>*>(&node_connections);
+        const HostVector<int64_t>* cast_node_agg
+            = dynamic_cast<const HostVector<int64_t>*>(&node_aggregates);
+        const HostVector<int64_t>* cast_node_root
+            = dynamic_cast<const HostVector<int64_t>*>(&node_aggregate_root_nodes);
+        HostVector<bool>*    cast_conn = dynamic_cast<HostVector<bool>*>(connections);
+        HostVector<int64_t>* cast_agg  = dynamic_cast<HostVector<int64_t>*>(aggregates);
+        HostVector<int64_t>* cast_root = dynamic_cast<HostVector<int64_t>*>(aggregate_root_nodes);
+
+        assert(cast_node != NULL);
+        assert(cast_node_conn != NULL);
+        assert(cast_node_agg != NULL);
+        assert(cast_node_root != NULL);
+        assert(cast_conn != NULL);
+        assert(cast_agg != NULL);
+        assert(cast_root != NULL);
 
-                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
-                    ++j)
-                {
-                    int c = this->mat_.col[j];
+        assert(cast_node->nrow_ * blockdim == this->nrow_);
 
-                    // Skip weak couplings, ...
-                    if(c != i && !cast_conn->vec_[j])
-                    {
-                        continue;
-                    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            int ib = i / blockdim;
+            int r  = i % blockdim;
 
-                    // ... and the ones not in any aggregate.
-                    int g = cast_agg->vec_[c];
-                    if(g < 0)
-                    {
-                        continue;
-                    }
+            PtrType node_begin = cast_node->mat_.row_offset[ib];
+            PtrType node_end   = cast_node->mat_.row_offset[ib + 1];
 
-                    ValueType v = (c == i) ? static_cast<ValueType>(1) - relax
-                                           : -relax * dia * this->mat_.val[j];
+            // A dof coupling is strong, if the coupling of the two nodes is strong.
+            // Couplings inside a node are always kept.
+            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                int c  = this->mat_.col[j];
+                int cb = c / blockdim;
 
-                    if(marker[g] < row_begin)
+                bool strong = false;
+
+                if(c != i)
+                {
+                    if(cb == ib)
                     {
-                        marker[g]                       = row_end;
-                        cast_prolong->mat_.col[row_end] = g;
-                        cast_prolong->mat_.val[row_end] = v;
-                        ++row_end;
+                        strong = true;
                     }
                     else
                     {
-                        cast_prolong->mat_.val[marker[g]] += v;
+                        // Node rows are sorted
+                        const int* first = cast_node->mat_.col + node_begin;
+                        const int* last  = cast_node->mat_.col + node_end;
+                        const int* it    = std::lower_bound(first, last, cb);
+
+                        assert(it != last && *it == cb);
+
+                        strong = cast_node_conn->vec_[node_begin + (it - first)];
                     }
                 }
+
+                cast_conn->vec_[j] = strong;
             }
-        }
 
-        cast_prolong->Sort();
+            // Each component of a node goes to the same component of the coarse node
+            int64_t agg = cast_node_agg->vec_[ib];
+
+            if(agg >= 0)
+            {
+                cast_agg->vec_[i]  = agg * blockdim + r;
+                cast_root->vec_[i] = cast_node_root->vec_[ib] * blockdim + r;
+            }
+            else
+            {
+                cast_agg->vec_[i]  = agg;
+                cast_root->vec_[i] = cast_node_root->vec_[ib];
+            }
+        }
 
         return true;
     }
 
     // ----------------------------------------------------------
-    // original function interp(const sparse::matrix<value_t,
-    //                          index_t> &A, const params &prm)
+    // original function connect(const spmat &A,
+    //                           float eps_strong)
     // ----------------------------------------------------------
     // Modified and adapted from AMGCL,
     // https://github.com/ddemidov/amgcl
@@ -4764,1179 +9754,1242 @@ namespace rocalution
     // - adapted interface
     // ----------------------------------------------------------
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGAggregation(const BaseVector<int>& aggregates,
-                                                  BaseMatrix<ValueType>* prolong) const
+    bool HostMatrixCSR<ValueType>::AMGComputeStrongConnections(
+        ValueType                    eps,
+        const BaseVector<ValueType>& diag,
+        const BaseVector<int64_t>&   l2g,
+        BaseVector<bool>*            connections,
+        const BaseMatrix<ValueType>& ghost) const
     {
-        assert(prolong != NULL);
+        assert(connections != NULL);
 
-        const HostVector<int>*    cast_agg     = dynamic_cast<const HostVector<int>*>(&aggregates);
-        HostMatrixCSR<ValueType>* cast_prolong = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
+        const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&diag);
+        const HostVector<int64_t>*   cast_l2g  = dynamic_cast<const HostVector<int64_t>*>(&l2g);
+        HostVector<bool>*            cast_conn = dynamic_cast<HostVector<bool>*>(connections);
+        const HostMatrixCSR<ValueType>* cast_gst
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
 
-        assert(cast_agg != NULL);
-        assert(cast_prolong != NULL);
+        assert(cast_diag != NULL);
+        assert(cast_l2g != NULL);
+        assert(cast_conn != NULL);
+        assert(cast_gst != NULL);
 
-        int ncol = 0;
+        bool global = cast_gst->nrow_ > 0;
 
-        for(int i = 0; i < cast_agg->GetSize(); ++i)
+        ValueType eps2 = eps * eps;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            if(cast_agg->vec_[i] > ncol)
-            {
-                ncol = cast_agg->vec_[i];
-            }
-        }
+            ValueType eps_dia_i = eps2 * cast_diag->vec_[i];
 
-        ++ncol;
+            PtrType row_begin = this->mat_.row_offset[i];
+            PtrType row_end   = this->mat_.row_offset[i + 1];
 
-        PtrType* row_offset = NULL;
-        allocate_host(this->nrow_ + 1, &row_offset);
+            for(PtrType j = row_begin; j < row_end; ++j)
+            {
+                int       c = this->mat_.col[j];
+                ValueType v = this->mat_.val[j];
 
-        int*       col = NULL;
-        ValueType* val = NULL;
+                assert(c >= 0);
+                assert(c < this->nrow_);
 
-        row_offset[0] = 0;
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            if(cast_agg->vec_[i] >= 0)
-            {
-                row_offset[i + 1] = row_offset[i] + 1;
+                cast_conn->vec_[j] = (c != i) && (v * v > eps_dia_i * cast_diag->vec_[c]);
             }
-            else
+
+            if(global == true)
             {
-                row_offset[i + 1] = row_offset[i];
-            }
-        }
+                PtrType gst_row_begin = cast_gst->mat_.row_offset[i];
+                PtrType gst_row_end   = cast_gst->mat_.row_offset[i + 1];
 
-        allocate_host(row_offset[this->nrow_], &col);
-        allocate_host(row_offset[this->nrow_], &val);
+                for(PtrType j = gst_row_begin; j < gst_row_end; ++j)
+                {
+                    int       c = cast_gst->mat_.col[j];
+                    ValueType v = cast_gst->mat_.val[j];
 
-        for(int i = 0, j = 0; i < this->nrow_; ++i)
-        {
-            if(cast_agg->vec_[i] >= 0)
-            {
-                col[j] = cast_agg->vec_[i];
-                val[j] = 1.0;
-                ++j;
+                    cast_conn->vec_[j + this->nnz_]
+                        = (v * v > eps_dia_i * cast_diag->vec_[c + this->nrow_]);
+                }
             }
         }
 
-        cast_prolong->Clear();
-        cast_prolong->SetDataPtrCSR(
-            &row_offset, &col, &val, row_offset[this->nrow_], this->nrow_, ncol);
-
         return true;
     }
 
-    // ----------------------------------------------------------
-    // original function aggregates( const spmat &A,
-    //                               const std::vector<char> &S )
-    // ----------------------------------------------------------
-    // Modified and adapted from AMGCL,
-    // https://github.com/ddemidov/amgcl
-    // MIT License
-    // ----------------------------------------------------------
-    // CHANGELOG
-    // - adapted interface
-    // ----------------------------------------------------------
+    unsigned int hash1(unsigned int x)
+    {
+        x = ((x >> 16) ^ x) * 0x45d9f3b;
+        x = ((x >> 16) ^ x) * 0x45d9f3b;
+        x = (x >> 16) ^ x;
+        return x / 2;
+    }
+
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGGreedyAggregate(
-        const BaseVector<bool>& connections,
-        BaseVector<int64_t>*    aggregates,
-        BaseVector<int64_t>*    aggregate_root_nodes) const
+    bool HostMatrixCSR<ValueType>::AMGPMISInitializeState(int64_t global_column_begin,
+                                                          const BaseVector<bool>&      connections,
+                                                          BaseVector<int>*             state,
+                                                          BaseVector<int>*             hash,
+                                                          const BaseMatrix<ValueType>& ghost) const
     {
-        assert(aggregate_root_nodes != NULL);
-        assert(aggregates != NULL);
+        assert(state != NULL);
+        assert(hash != NULL);
 
-        HostVector<int64_t>* cast_agg_nodes
-            = dynamic_cast<HostVector<int64_t>*>(aggregate_root_nodes);
-        HostVector<int64_t>*    cast_agg  = dynamic_cast<HostVector<int64_t>*>(aggregates);
-        const HostVector<bool>* cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
+        HostVector<int>*        cast_state = dynamic_cast<HostVector<int>*>(state);
+        HostVector<int>*        cast_hash  = dynamic_cast<HostVector<int>*>(hash);
+        const HostVector<bool>* cast_conn  = dynamic_cast<const HostVector<bool>*>(&connections);
+        const HostMatrixCSR<ValueType>* cast_gst
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
 
-        assert(cast_agg_nodes != NULL);
-        assert(cast_agg != NULL);
+        assert(cast_state != NULL);
+        assert(cast_hash != NULL);
         assert(cast_conn != NULL);
+        assert(cast_gst != NULL);
 
-        const int undefined = -1;
-        const int removed   = -2;
+        bool global = cast_gst->nrow_ > 0;
 
-        // Remove nodes without neighbours
-        int max_neib = 0;
+        // Initialize state
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
         for(int i = 0; i < this->nrow_; ++i)
         {
-            PtrType j = this->mat_.row_offset[i];
-            PtrType e = this->mat_.row_offset[i + 1];
-
-            max_neib = std::max(static_cast<int>(e - j), max_neib);
+            int s = -2;
 
-            int state = removed;
-            for(; j < e; ++j)
+            PtrType row_start = this->mat_.row_offset[i];
+            PtrType row_end   = this->mat_.row_offset[i + 1];
+            for(PtrType j = row_start; j < row_end; j++)
             {
-                if(cast_conn->vec_[j])
+                if(cast_conn->vec_[j] == true)
                 {
-                    state = undefined;
+                    s = 0;
                     break;
                 }
             }
 
-            cast_agg->vec_[i] = state;
-        }
+            if(global == true)
+            {
+                PtrType gst_row_begin = cast_gst->mat_.row_offset[i];
+                PtrType gst_row_end   = cast_gst->mat_.row_offset[i + 1];
+
+                for(PtrType j = gst_row_begin; j < gst_row_end; ++j)
+                {
+                    if(cast_conn->vec_[j + this->nnz_] == true)
+                    {
+                        s = 0;
+                        break;
+                    }
+                }
+            }
+
+            cast_state->vec_[i] = s;
+            cast_hash->vec_[i]  = hash1(i + global_column_begin);
+        }
+
+        return true;
+    }
+
+    mis_tuple lexographical_max(mis_tuple* ti, mis_tuple* tj)
+    {
+        // find lexographical maximum
+        if(tj->s > ti->s)
+        {
+            return *tj;
+        }
+        else if(tj->s == ti->s)
+        {
+            if(tj->v > ti->v)
+            {
+                return *tj;
+            }
+        }
+
+        return *ti;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AMGExtractBoundaryState(
+        const BaseVector<PtrType>&   bnd_csr_row_ptr,
+        const BaseVector<bool>&      connections,
+        const BaseVector<int>&       max_state,
+        const BaseVector<int>&       hash,
+        BaseVector<int>*             bnd_max_state,
+        BaseVector<int>*             bnd_hash,
+        int64_t                      global_column_offset,
+        const BaseVector<int>&       boundary_index,
+        const BaseMatrix<ValueType>& gst) const
+    {
+        assert(bnd_max_state != NULL);
+        assert(bnd_hash != NULL);
+
+        HostVector<int>* cast_bnd_max_state = dynamic_cast<HostVector<int>*>(bnd_max_state);
+        HostVector<int>* cast_bnd_hash      = dynamic_cast<HostVector<int>*>(bnd_hash);
 
-        std::vector<int> neib;
-        neib.reserve(max_neib);
+        const HostVector<PtrType>* cast_bnd_ptr
+            = dynamic_cast<const HostVector<PtrType>*>(&bnd_csr_row_ptr);
+        const HostVector<bool>* cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
+        const HostVector<int>*  cast_max_state = dynamic_cast<const HostVector<int>*>(&max_state);
+        const HostVector<int>*  cast_hash      = dynamic_cast<const HostVector<int>*>(&hash);
+        const HostVector<int>*  cast_bnd = dynamic_cast<const HostVector<int>*>(&boundary_index);
+        const HostMatrixCSR<ValueType>* cast_gst
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&gst);
 
-        int64_t last_g = -1;
+        assert(cast_bnd_ptr != NULL);
+        assert(cast_conn != NULL);
+        assert(cast_max_state != NULL);
+        assert(cast_hash != NULL);
+        assert(cast_bnd != NULL);
+        assert(cast_gst != NULL);
 
-        // Perform plain aggregation
-        for(int i = 0; i < this->nrow_; ++i)
+        for(int64_t i = 0; i < cast_bnd->size_; ++i)
         {
-            if(cast_agg->vec_[i] != undefined)
-            {
-                continue;
-            }
+            // This is a boundary row
+            int row = cast_bnd->vec_[i];
 
-            // The point is not adjacent to a core of any previous aggregate:
-            // so its a seed of a new aggregate.
-            cast_agg->vec_[i]       = ++last_g;
-            cast_agg_nodes->vec_[i] = i;
+            // Index into boundary structures
+            PtrType idx  = cast_bnd_ptr->vec_[i];
+            PtrType idx2 = cast_bnd_ptr->vec_[i + 1];
 
-            neib.clear();
+            // Entry points
+            PtrType row_begin = this->mat_.row_offset[row];
+            PtrType row_end   = this->mat_.row_offset[row + 1];
 
-            // Include its neighbors as well.
-            for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
+            // Interior
+            for(PtrType j = row_begin; j < row_end; ++j)
             {
-                int c = this->mat_.col[j];
+                if(cast_conn->vec_[j] == true)
+                {
+                    int col = this->mat_.col[j];
 
-                assert(c >= 0);
-                assert(c < this->nrow_);
+                    assert(col >= 0);
+                    assert(col < this->nrow_);
 
-                if(cast_conn->vec_[j] && cast_agg->vec_[c] != removed)
-                {
-                    cast_agg->vec_[c]       = last_g;
-                    cast_agg_nodes->vec_[c] = i;
-                    neib.push_back(c);
+                    cast_bnd_max_state->vec_[idx] = cast_max_state->vec_[col];
+                    cast_bnd_hash->vec_[idx]      = cast_hash->vec_[col];
+
+                    ++idx;
                 }
             }
 
-            // Temporarily mark undefined points adjacent to the new aggregate as
-            // belonging to the aggregate. If nobody claims them later, they will
-            // stay here.
-            for(typename std::vector<int>::const_iterator nb = neib.begin(); nb != neib.end(); ++nb)
+            // Ghost
+            row_begin = cast_gst->mat_.row_offset[row];
+            row_end   = cast_gst->mat_.row_offset[row + 1];
+
+            for(PtrType j = row_begin; j < row_end; ++j)
             {
-                for(PtrType j = this->mat_.row_offset[*nb], e = this->mat_.row_offset[*nb + 1];
-                    j < e;
-                    ++j)
+                if(cast_conn->vec_[j + this->nnz_] == true)
                 {
-                    if(cast_conn->vec_[j] && cast_agg->vec_[this->mat_.col[j]] == undefined)
-                    {
-                        cast_agg->vec_[this->mat_.col[j]]       = last_g;
-                        cast_agg_nodes->vec_[this->mat_.col[j]] = i;
-                    }
+                    int col = cast_gst->mat_.col[j];
+
+                    cast_bnd_max_state->vec_[idx] = cast_max_state->vec_[col + this->nrow_];
+                    cast_bnd_hash->vec_[idx]      = cast_hash->vec_[col + this->nrow_];
+
+                    ++idx;
                 }
             }
+
+            assert(idx2 == idx);
         }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGBoundaryNnz(const BaseVector<int>&       boundary,
-                                                  const BaseVector<bool>&      connections,
-                                                  const BaseMatrix<ValueType>& ghost,
-                                                  BaseVector<PtrType>*         row_nnz) const
+    bool HostMatrixCSR<ValueType>::AMGPMISFindMaxNeighbourNode(
+        int64_t                      global_column_begin,
+        int64_t                      global_column_end,
+        bool&                        undecided,
+        const BaseVector<bool>&      connections,
+        const BaseVector<int>&       state,
+        const BaseVector<int>&       hash,
+        const BaseVector<PtrType>&   bnd_csr_row_ptr,
+        const BaseVector<int64_t>&   bnd_csr_col_ind,
+        const BaseVector<int>&       bnd_state,
+        const BaseVector<int>&       bnd_hash,
+        BaseVector<int>*             max_state,
+        BaseVector<int64_t>*         aggregates,
+        const BaseMatrix<ValueType>& ghost) const
     {
-        const HostVector<int>*  cast_bnd  = dynamic_cast<const HostVector<int>*>(&boundary);
+        HostVector<int>*        cast_max_state = dynamic_cast<HostVector<int>*>(max_state);
+        HostVector<int64_t>*    cast_agg       = dynamic_cast<HostVector<int64_t>*>(aggregates);
+        const HostVector<int>*  cast_hash      = dynamic_cast<const HostVector<int>*>(&hash);
+        const HostVector<int>*  cast_state     = dynamic_cast<const HostVector<int>*>(&state);
         const HostVector<bool>* cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
         const HostMatrixCSR<ValueType>* cast_gst
             = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
-        HostVector<PtrType>* cast_row_nnz = dynamic_cast<HostVector<PtrType>*>(row_nnz);
 
-        assert(cast_bnd != NULL);
+        const HostVector<PtrType>* cast_bnd_ptr
+            = dynamic_cast<const HostVector<PtrType>*>(&bnd_csr_row_ptr);
+        const HostVector<int64_t>* cast_bnd_col
+            = dynamic_cast<const HostVector<int64_t>*>(&bnd_csr_col_ind);
+        const HostVector<int>* cast_bnd_state = dynamic_cast<const HostVector<int>*>(&bnd_state);
+        const HostVector<int>* cast_bnd_hash  = dynamic_cast<const HostVector<int>*>(&bnd_hash);
+
+        assert(cast_max_state != NULL);
+        assert(cast_agg != NULL);
+        assert(cast_bnd_ptr != NULL);
+        assert(cast_bnd_col != NULL);
+        assert(cast_bnd_state != NULL);
+        assert(cast_bnd_hash != NULL);
+        assert(cast_hash != NULL);
+        assert(cast_state != NULL);
         assert(cast_conn != NULL);
         assert(cast_gst != NULL);
-        assert(cast_row_nnz != NULL);
-
-        assert(cast_row_nnz->size_ >= cast_bnd->size_);
 
         bool global = cast_gst->nrow_ > 0;
 
+        // Find distance one max node
 #ifdef _OPENMP
 #pragma omp parallel for schedule(dynamic, 1024)
 #endif
-        for(int64_t i = 0; i < cast_bnd->size_; ++i)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            // Get boundary row
-            int row = cast_bnd->vec_[i];
-
-            // Counter
-            PtrType ext_nnz = 0;
-
-            // Interior part
-            PtrType row_begin = this->mat_.row_offset[row];
-            PtrType row_end   = this->mat_.row_offset[row + 1];
+            mis_tuple t_max;
+            t_max.s = cast_state->vec_[i];
+            t_max.v = cast_hash->vec_[i];
+            t_max.i = i;
 
-            for(PtrType j = row_begin; j < row_end; ++j)
+            PtrType row_start = this->mat_.row_offset[i];
+            PtrType row_end   = this->mat_.row_offset[i + 1];
+            for(PtrType j = row_start; j < row_end; j++)
             {
-                // Check whether this vertex is strongly connected
                 if(cast_conn->vec_[j] == true)
                 {
-                    ++ext_nnz;
+                    int col = this->mat_.col[j];
+
+                    assert(col >= 0);
+                    assert(col < this->nrow_);
+
+                    mis_tuple tj;
+                    tj.s = cast_state->vec_[col];
+                    tj.v = cast_hash->vec_[col];
+                    tj.i = col;
+
+                    t_max = lexographical_max(&tj, &t_max);
                 }
             }
 
             if(global == true)
             {
-                // Ghost part
-                row_begin = cast_gst->mat_.row_offset[row];
-                row_end   = cast_gst->mat_.row_offset[row + 1];
+                PtrType gst_row_begin = cast_gst->mat_.row_offset[i];
+                PtrType gst_row_end   = cast_gst->mat_.row_offset[i + 1];
 
-                for(PtrType j = row_begin; j < row_end; ++j)
+                for(PtrType j = gst_row_begin; j < gst_row_end; ++j)
                 {
-                    // Check whether this vertex is strongly connected
                     if(cast_conn->vec_[j + this->nnz_] == true)
                     {
-                        ++ext_nnz;
+                        int col = cast_gst->mat_.col[j];
+
+                        mis_tuple tj;
+                        tj.s = cast_state->vec_[this->nrow_ + col];
+                        tj.v = cast_hash->vec_[this->nrow_ + col];
+                        tj.i = this->nrow_ + col;
+
+                        t_max = lexographical_max(&tj, &t_max);
                     }
                 }
             }
 
-            // Write total number of strongly connected coarse vertices to global memory
-            cast_row_nnz->vec_[i] = ext_nnz;
-        }
+            // Find distance two max node
+            if(t_max.i < this->nrow_)
+            {
+                int row = t_max.i;
 
-        return true;
-    }
+                assert(row >= 0);
+                assert(row < this->nrow_);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGExtractBoundary(int64_t                global_column_begin,
-                                                      const BaseVector<int>& boundary,
-                                                      const BaseVector<int64_t>&   l2g,
-                                                      const BaseVector<bool>&      connections,
-                                                      const BaseMatrix<ValueType>& ghost,
-                                                      const BaseVector<PtrType>&   bnd_csr_row_ptr,
-                                                      BaseVector<int64_t>* bnd_csr_col_ind) const
-    {
-        const HostVector<int>*     cast_bnd  = dynamic_cast<const HostVector<int>*>(&boundary);
-        const HostVector<int64_t>* cast_l2g  = dynamic_cast<const HostVector<int64_t>*>(&l2g);
-        const HostVector<bool>*    cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
-        const HostMatrixCSR<ValueType>* cast_gst
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
-        const HostVector<PtrType>* cast_bnd_ptr
-            = dynamic_cast<const HostVector<PtrType>*>(&bnd_csr_row_ptr);
-        HostVector<int64_t>* cast_bnd_col = dynamic_cast<HostVector<int64_t>*>(bnd_csr_col_ind);
+                PtrType row_start = this->mat_.row_offset[row];
+                PtrType row_end   = this->mat_.row_offset[row + 1];
 
-        assert(cast_bnd != NULL);
-        assert(cast_l2g != NULL);
-        assert(cast_conn != NULL);
-        assert(cast_gst != NULL);
-        assert(cast_bnd_ptr != NULL);
-        assert(cast_bnd_col != NULL);
+                for(PtrType j = row_start; j < row_end; j++)
+                {
+                    if(cast_conn->vec_[j] == true)
+                    {
+                        int col = this->mat_.col[j];
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(int64_t i = 0; i < cast_bnd->size_; ++i)
-        {
-            // Get boundary row and index into A_ext
-            int     row  = cast_bnd->vec_[i];
-            PtrType idx  = cast_bnd_ptr->vec_[i];
-            PtrType idx2 = cast_bnd_ptr->vec_[i + 1];
+                        assert(col >= 0);
+                        assert(col < this->nrow_);
+
+                        mis_tuple tj;
+                        tj.s = cast_state->vec_[col];
+                        tj.v = cast_hash->vec_[col];
+                        tj.i = col;
+
+                        t_max = lexographical_max(&tj, &t_max);
+                    }
+                }
+
+                if(global == true)
+                {
+                    PtrType gst_row_begin = cast_gst->mat_.row_offset[row];
+                    PtrType gst_row_end   = cast_gst->mat_.row_offset[row + 1];
+
+                    for(PtrType j = gst_row_begin; j < gst_row_end; ++j)
+                    {
+                        if(cast_conn->vec_[j + this->nnz_] == true)
+                        {
+                            int col = cast_gst->mat_.col[j];
 
-            // Extract interior part
-            PtrType row_begin = this->mat_.row_offset[row];
-            PtrType row_end   = this->mat_.row_offset[row + 1];
+                            mis_tuple tj;
+                            tj.s = cast_state->vec_[this->nrow_ + col];
+                            tj.v = cast_hash->vec_[this->nrow_ + col];
+                            tj.i = this->nrow_ + col;
 
-            for(PtrType j = row_begin; j < row_end; ++j)
+                            t_max = lexographical_max(&tj, &t_max);
+                        }
+                    }
+                }
+            }
+            else
             {
-                // Check whether this vertex is strongly connected
-                if(cast_conn->vec_[j] == true)
+                PtrType bnd_row_start = cast_bnd_ptr->vec_[t_max.i - this->nrow_];
+                PtrType bnd_row_end   = cast_bnd_ptr->vec_[t_max.i - this->nrow_ + 1];
+
+                for(PtrType j = bnd_row_start; j < bnd_row_end; j++)
                 {
-                    // Get column index
-                    int col = this->mat_.col[j];
+                    int64_t gcol = cast_bnd_col->vec_[j];
 
-                    assert(col >= 0);
-                    assert(col < this->nrow_);
+                    // Differentiate between local and ghost column
+                    int col = -1;
+                    if(gcol >= global_column_begin && gcol < global_column_end)
+                    {
+                        col = static_cast<int>(gcol - global_column_begin);
 
-                    // Shift column by global column offset, to obtain the global column index
-                    cast_bnd_col->vec_[idx++] = col + global_column_begin;
+                        assert(col >= 0);
+                        assert(col < this->nrow_);
+                    }
+
+                    mis_tuple tj;
+                    tj.s = cast_bnd_state->vec_[j];
+                    tj.v = cast_bnd_hash->vec_[j];
+                    tj.i = col;
+
+                    t_max = lexographical_max(&tj, &t_max);
                 }
             }
 
-            // Extract ghost part
-            row_begin = cast_gst->mat_.row_offset[row];
-            row_end   = cast_gst->mat_.row_offset[row + 1];
-
-            for(PtrType j = row_begin; j < row_end; ++j)
+            if(cast_state->vec_[i] == 0)
             {
-                // Check whether this vertex is strongly connected
-                if(cast_conn->vec_[j + this->nnz_] == true)
+                if(t_max.i == i)
                 {
-                    // Get column index
-                    int col = cast_gst->mat_.col[j];
-
-                    // Transform local ghost index into global column index
-                    cast_bnd_col->vec_[idx++] = cast_l2g->vec_[col];
+                    cast_max_state->vec_[i] = 1;
+                    cast_agg->vec_[i]       = 1;
+                }
+                else if(t_max.s == 1)
+                {
+                    cast_max_state->vec_[i] = -1;
+                    cast_agg->vec_[i]       = 0;
+                }
+                else
+                {
+                    undecided = true;
                 }
             }
-
-            assert(idx2 == idx);
         }
 
         return true;
     }
 
-    // ----------------------------------------------------------
-    // original function connect(const spmat &A,
-    //                           float eps_strong)
-    // ----------------------------------------------------------
-    // Modified and adapted from AMGCL,
-    // https://github.com/ddemidov/amgcl
-    // MIT License
-    // ----------------------------------------------------------
-    // CHANGELOG
-    // - adapted interface
-    // ----------------------------------------------------------
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGComputeStrongConnections(
-        ValueType                    eps,
-        const BaseVector<ValueType>& diag,
+    bool HostMatrixCSR<ValueType>::AMGPMISAddUnassignedNodesToAggregations(
+        int64_t                      global_column_begin,
+        const BaseVector<bool>&      connections,
+        const BaseVector<int>&       state,
         const BaseVector<int64_t>&   l2g,
-        BaseVector<bool>*            connections,
+        BaseVector<int>*             max_state,
+        BaseVector<int64_t>*         aggregates,
+        BaseVector<int64_t>*         aggregate_root_nodes,
         const BaseMatrix<ValueType>& ghost) const
     {
-        assert(connections != NULL);
+        assert(max_state != NULL);
+        assert(aggregates != NULL);
 
-        const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&diag);
-        const HostVector<int64_t>*   cast_l2g  = dynamic_cast<const HostVector<int64_t>*>(&l2g);
-        HostVector<bool>*            cast_conn = dynamic_cast<HostVector<bool>*>(connections);
+        HostVector<int64_t>* cast_agg = dynamic_cast<HostVector<int64_t>*>(aggregates);
+        HostVector<int64_t>* cast_agg_nodes
+            = dynamic_cast<HostVector<int64_t>*>(aggregate_root_nodes);
+        HostVector<int>* cast_max_state = dynamic_cast<HostVector<int>*>(max_state);
+
+        const HostVector<int64_t>* cast_l2g   = dynamic_cast<const HostVector<int64_t>*>(&l2g);
+        const HostVector<int>*     cast_state = dynamic_cast<const HostVector<int>*>(&state);
+        const HostVector<bool>*    cast_conn  = dynamic_cast<const HostVector<bool>*>(&connections);
         const HostMatrixCSR<ValueType>* cast_gst
             = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
 
-        assert(cast_diag != NULL);
+        assert(cast_agg != NULL);
+        assert(cast_max_state != NULL);
+
         assert(cast_l2g != NULL);
+        assert(cast_state != NULL);
         assert(cast_conn != NULL);
         assert(cast_gst != NULL);
 
         bool global = cast_gst->nrow_ > 0;
 
-        ValueType eps2 = eps * eps;
-
 #ifdef _OPENMP
 #pragma omp parallel for schedule(dynamic, 1024)
 #endif
         for(int i = 0; i < this->nrow_; ++i)
         {
-            ValueType eps_dia_i = eps2 * cast_diag->vec_[i];
-
-            PtrType row_begin = this->mat_.row_offset[i];
-            PtrType row_end   = this->mat_.row_offset[i + 1];
+            int s = cast_state->vec_[i];
 
-            for(PtrType j = row_begin; j < row_end; ++j)
+            if(s == -1)
             {
-                int       c = this->mat_.col[j];
-                ValueType v = this->mat_.val[j];
+                PtrType row_begin = this->mat_.row_offset[i];
+                PtrType row_end   = this->mat_.row_offset[i + 1];
 
-                assert(c >= 0);
-                assert(c < this->nrow_);
+                int64_t global_col = -1;
+                for(PtrType j = row_begin; j < row_end; j++)
+                {
+                    if(cast_conn->vec_[j] == true)
+                    {
+                        int c = this->mat_.col[j];
 
-                cast_conn->vec_[j] = (c != i) && (v * v > eps_dia_i * cast_diag->vec_[c]);
-            }
+                        assert(c >= 0);
+                        assert(c < this->nrow_);
 
-            if(global == true)
-            {
-                PtrType gst_row_begin = cast_gst->mat_.row_offset[i];
-                PtrType gst_row_end   = cast_gst->mat_.row_offset[i + 1];
+                        if(cast_state->vec_[c] == 1)
+                        {
+                            cast_agg->vec_[i]       = cast_agg->vec_[c];
+                            cast_max_state->vec_[i] = 1;
 
-                for(PtrType j = gst_row_begin; j < gst_row_end; ++j)
+                            cast_agg_nodes->vec_[i] = cast_agg_nodes->vec_[c];
+
+                            global_col = global_column_begin + c;
+                            break;
+                        }
+                    }
+                }
+
+                if(global)
                 {
-                    int       c = cast_gst->mat_.col[j];
-                    ValueType v = cast_gst->mat_.val[j];
+                    PtrType gst_row_begin = cast_gst->mat_.row_offset[i];
+                    PtrType gst_row_end   = cast_gst->mat_.row_offset[i + 1];
 
-                    cast_conn->vec_[j + this->nnz_]
-                        = (v * v > eps_dia_i * cast_diag->vec_[c + this->nrow_]);
+                    for(PtrType j = gst_row_begin; j < gst_row_end; j++)
+                    {
+                        if(cast_conn->vec_[j + this->nnz_] == true)
+                        {
+                            int c = cast_gst->mat_.col[j];
+
+                            if(cast_state->vec_[c + this->nrow_] == 1)
+                            {
+                                if(global_col == -1
+                                   || (global_col >= 0 && cast_l2g->vec_[c] < global_col))
+                                {
+                                    cast_agg->vec_[i]       = cast_agg->vec_[c + this->nrow_];
+                                    cast_max_state->vec_[i] = 1;
+
+                                    cast_agg_nodes->vec_[i] = cast_agg_nodes->vec_[c + this->nrow_];
+                                    break;
+                                }
+                            }
+                        }
+                    }
                 }
             }
+            else if(s == -2)
+            {
+                cast_agg->vec_[i] = -2;
+            }
         }
 
         return true;
     }
 
-    unsigned int hash1(unsigned int x)
-    {
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = (x >> 16) ^ x;
-        return x / 2;
-    }
-
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGPMISInitializeState(int64_t global_column_begin,
-                                                          const BaseVector<bool>&      connections,
-                                                          BaseVector<int>*             state,
-                                                          BaseVector<int>*             hash,
-                                                          const BaseMatrix<ValueType>& ghost) const
+    bool HostMatrixCSR<ValueType>::AMGPMISInitializeAggregateGlobalIndices(
+        int64_t                    global_column_begin,
+        const BaseVector<int64_t>& aggregates,
+        BaseVector<int64_t>*       aggregate_root_nodes) const
     {
-        assert(state != NULL);
-        assert(hash != NULL);
-
-        HostVector<int>*        cast_state = dynamic_cast<HostVector<int>*>(state);
-        HostVector<int>*        cast_hash  = dynamic_cast<HostVector<int>*>(hash);
-        const HostVector<bool>* cast_conn  = dynamic_cast<const HostVector<bool>*>(&connections);
-        const HostMatrixCSR<ValueType>* cast_gst
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
-
-        assert(cast_state != NULL);
-        assert(cast_hash != NULL);
-        assert(cast_conn != NULL);
-        assert(cast_gst != NULL);
-
-        bool global = cast_gst->nrow_ > 0;
-
-        // Initialize state
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            int s = -2;
-
-            PtrType row_start = this->mat_.row_offset[i];
-            PtrType row_end   = this->mat_.row_offset[i + 1];
-            for(PtrType j = row_start; j < row_end; j++)
-            {
-                if(cast_conn->vec_[j] == true)
-                {
-                    s = 0;
-                    break;
-                }
-            }
-
-            if(global == true)
-            {
-                PtrType gst_row_begin = cast_gst->mat_.row_offset[i];
-                PtrType gst_row_end   = cast_gst->mat_.row_offset[i + 1];
-
-                for(PtrType j = gst_row_begin; j < gst_row_end; ++j)
-                {
-                    if(cast_conn->vec_[j + this->nnz_] == true)
-                    {
-                        s = 0;
-                        break;
-                    }
-                }
-            }
+        assert(aggregate_root_nodes != NULL);
 
-            cast_state->vec_[i] = s;
-            cast_hash->vec_[i]  = hash1(i + global_column_begin);
-        }
+        const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
+        HostVector<int64_t>*       cast_agg_nodes
+            = dynamic_cast<HostVector<int64_t>*>(aggregate_root_nodes);
 
-        return true;
-    }
+        assert(cast_agg != NULL);
+        assert(cast_agg_nodes != NULL);
 
-    mis_tuple lexographical_max(mis_tuple* ti, mis_tuple* tj)
-    {
-        // find lexographical maximum
-        if(tj->s > ti->s)
-        {
-            return *tj;
-        }
-        else if(tj->s == ti->s)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            if(tj->v > ti->v)
-            {
-                return *tj;
-            }
+            cast_agg_nodes->vec_[i] = (cast_agg->vec_[i] == 1) ? global_column_begin + i : -1;
         }
 
-        return *ti;
+        return true;
     }
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGExtractBoundaryState(
-        const BaseVector<PtrType>&   bnd_csr_row_ptr,
-        const BaseVector<bool>&      connections,
-        const BaseVector<int>&       max_state,
-        const BaseVector<int>&       hash,
-        BaseVector<int>*             bnd_max_state,
-        BaseVector<int>*             bnd_hash,
-        int64_t                      global_column_offset,
-        const BaseVector<int>&       boundary_index,
-        const BaseMatrix<ValueType>& gst) const
+    // ----------------------------------------------------------
+    // original function interp(const sparse::matrix<value_t,
+    //                          index_t> &A, const params &prm)
+    // ----------------------------------------------------------
+    // Modified and adapted from AMGCL,
+    // https://github.com/ddemidov/amgcl
+    // MIT License
+    // ----------------------------------------------------------
+    // CHANGELOG
+    // - adapted interface
+    // ----------------------------------------------------------
+    /*template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AMGSmoothedAggregation(ValueType                  relax,
+                                                          const BaseVector<bool>&    connections,
+                                                          const BaseVector<int64_t>& aggregates,
+                                                          BaseMatrix<ValueType>*     prolong,
+                                                          int lumping_strat) const
     {
-        assert(bnd_max_state != NULL);
-        assert(bnd_hash != NULL);
-
-        HostVector<int>* cast_bnd_max_state = dynamic_cast<HostVector<int>*>(bnd_max_state);
-        HostVector<int>* cast_bnd_hash      = dynamic_cast<HostVector<int>*>(bnd_hash);
+        assert(prolong != NULL);
 
-        const HostVector<PtrType>* cast_bnd_ptr
-            = dynamic_cast<const HostVector<PtrType>*>(&bnd_csr_row_ptr);
-        const HostVector<bool>* cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
-        const HostVector<int>*  cast_max_state = dynamic_cast<const HostVector<int>*>(&max_state);
-        const HostVector<int>*  cast_hash      = dynamic_cast<const HostVector<int>*>(&hash);
-        const HostVector<int>*  cast_bnd = dynamic_cast<const HostVector<int>*>(&boundary_index);
-        const HostMatrixCSR<ValueType>* cast_gst
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&gst);
+        const HostVector<bool>*    cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
+        const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
+        HostMatrixCSR<ValueType>*  cast_prolong = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
 
-        assert(cast_bnd_ptr != NULL);
+        assert(cast_agg != NULL);
         assert(cast_conn != NULL);
-        assert(cast_max_state != NULL);
-        assert(cast_hash != NULL);
-        assert(cast_bnd != NULL);
-        assert(cast_gst != NULL);
-
-        for(int64_t i = 0; i < cast_bnd->size_; ++i)
-        {
-            // This is a boundary row
-            int row = cast_bnd->vec_[i];
+        assert(cast_prolong != NULL);
 
-            // Index into boundary structures
-            PtrType idx  = cast_bnd_ptr->vec_[i];
-            PtrType idx2 = cast_bnd_ptr->vec_[i + 1];
+        // Allocate
+        cast_prolong->Clear();
+        cast_prolong->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
 
-            // Entry points
-            PtrType row_begin = this->mat_.row_offset[row];
-            PtrType row_end   = this->mat_.row_offset[row + 1];
+        int ncol = 0;
 
-            // Interior
-            for(PtrType j = row_begin; j < row_end; ++j)
+        for(int i = 0; i < cast_agg->GetSize(); ++i)
+        {
+            if(cast_agg->vec_[i] > ncol)
             {
-                if(cast_conn->vec_[j] == true)
-                {
-                    int col = this->mat_.col[j];
+                ncol = cast_agg->vec_[i];
+            }
+        }
 
-                    assert(col >= 0);
-                    assert(col < this->nrow_);
+        ++ncol;
 
-                    cast_bnd_max_state->vec_[idx] = cast_max_state->vec_[col];
-                    cast_bnd_hash->vec_[idx]      = cast_hash->vec_[col];
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<PtrType> marker(ncol, -1);
 
-                    ++idx;
-                }
-            }
+#ifdef _OPENMP
+            int nt  = omp_get_num_threads();
+            int tid = omp_get_thread_num();
 
-            // Ghost
-            row_begin = cast_gst->mat_.row_offset[row];
-            row_end   = cast_gst->mat_.row_offset[row + 1];
+            int chunk_size  = (this->nrow_ + nt - 1) / nt;
+            int chunk_start = tid * chunk_size;
+            int chunk_end   = std::min(this->nrow_, chunk_start + chunk_size);
+#else
+            int chunk_start = 0;
+            int chunk_end   = this->nrow_;
+#endif
 
-            for(PtrType j = row_begin; j < row_end; ++j)
+            // Count number of entries in prolong
+            for(int i = chunk_start; i < chunk_end; ++i)
             {
-                if(cast_conn->vec_[j + this->nnz_] == true)
+                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
+                    ++j)
                 {
-                    int col = cast_gst->mat_.col[j];
+                    int c = this->mat_.col[j];
 
-                    cast_bnd_max_state->vec_[idx] = cast_max_state->vec_[col + this->nrow_];
-                    cast_bnd_hash->vec_[idx]      = cast_hash->vec_[col + this->nrow_];
+                    assert(c >= 0);
+                    assert(c < this->nrow_);
 
-                    ++idx;
+                    if(c != i && !cast_conn->vec_[j])
+                    {
+                        continue;
+                    }
+
+                    int g = cast_agg->vec_[c];
+
+                    if(g >= 0 && marker[g] != i)
+                    {
+                        marker[g] = i;
+                        ++cast_prolong->mat_.row_offset[i + 1];
+                    }
                 }
             }
 
-            assert(idx2 == idx);
-        }
+            std::fill(marker.begin(), marker.end(), -1);
 
-        return true;
-    }
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
+            {
+                PtrType* row_offset = NULL;
+                allocate_host(cast_prolong->nrow_ + 1, &row_offset);
 
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGPMISFindMaxNeighbourNode(
-        int64_t                      global_column_begin,
-        int64_t                      global_column_end,
-        bool&                        undecided,
-        const BaseVector<bool>&      connections,
-        const BaseVector<int>&       state,
-        const BaseVector<int>&       hash,
-        const BaseVector<PtrType>&   bnd_csr_row_ptr,
-        const BaseVector<int64_t>&   bnd_csr_col_ind,
-        const BaseVector<int>&       bnd_state,
-        const BaseVector<int>&       bnd_hash,
-        BaseVector<int>*             max_state,
-        BaseVector<int64_t>*         aggregates,
-        const BaseMatrix<ValueType>& ghost) const
-    {
-        HostVector<int>*        cast_max_state = dynamic_cast<HostVector<int>*>(max_state);
-        HostVector<int64_t>*    cast_agg       = dynamic_cast<HostVector<int64_t>*>(aggregates);
-        const HostVector<int>*  cast_hash      = dynamic_cast<const HostVector<int>*>(&hash);
-        const HostVector<int>*  cast_state     = dynamic_cast<const HostVector<int>*>(&state);
-        const HostVector<bool>* cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
-        const HostMatrixCSR<ValueType>* cast_gst
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
+                int*       col = NULL;
+                ValueType* val = NULL;
 
-        const HostVector<PtrType>* cast_bnd_ptr
-            = dynamic_cast<const HostVector<PtrType>*>(&bnd_csr_row_ptr);
-        const HostVector<int64_t>* cast_bnd_col
-            = dynamic_cast<const HostVector<int64_t>*>(&bnd_csr_col_ind);
-        const HostVector<int>* cast_bnd_state = dynamic_cast<const HostVector<int>*>(&bnd_state);
-        const HostVector<int>* cast_bnd_hash  = dynamic_cast<const HostVector<int>*>(&bnd_hash);
+                int64_t nnz  = 0;
+                int     nrow = cast_prolong->nrow_;
 
-        assert(cast_max_state != NULL);
-        assert(cast_agg != NULL);
-        assert(cast_bnd_ptr != NULL);
-        assert(cast_bnd_col != NULL);
-        assert(cast_bnd_state != NULL);
-        assert(cast_bnd_hash != NULL);
-        assert(cast_hash != NULL);
-        assert(cast_state != NULL);
-        assert(cast_conn != NULL);
-        assert(cast_gst != NULL);
+                row_offset[0] = 0;
+                for(int i = 1; i < nrow + 1; ++i)
+                {
+                    row_offset[i] = cast_prolong->mat_.row_offset[i] + row_offset[i - 1];
+                }
 
-        bool global = cast_gst->nrow_ > 0;
+                nnz = row_offset[nrow];
 
-        // Find distance one max node
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            mis_tuple t_max;
-            t_max.s = cast_state->vec_[i];
-            t_max.v = cast_hash->vec_[i];
-            t_max.i = i;
+                allocate_host(nnz, &col);
+                allocate_host(nnz, &val);
 
-            PtrType row_start = this->mat_.row_offset[i];
-            PtrType row_end   = this->mat_.row_offset[i + 1];
-            for(PtrType j = row_start; j < row_end; j++)
+                cast_prolong->Clear();
+                cast_prolong->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
+            }
+
+            // Fill the interpolation matrix.
+            for(int i = chunk_start; i < chunk_end; ++i)
             {
-                if(cast_conn->vec_[j] == true)
+                // Diagonal of the filtered matrix is original matrix diagonal plus (lumping_strat = 0) or
+                // minus (lumping_strat = 1) its weak connections.
+                ValueType dia = static_cast<ValueType>(0);
+                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
+                    ++j)
                 {
-                    int col = this->mat_.col[j];
+                    if(this->mat_.col[j] == i)
+                    {
+                        dia += this->mat_.val[j];
+                    }
+                    else if(!cast_conn->vec_[j])
+                    {
+                        if(lumping_strat == 0)
+                        {
+                            dia += this->mat_.val[j];
+                        }
+                        else
+                        {
+                            dia -= this->mat_.val[j];
+                        }
+                    }
+                }
 
-                    assert(col >= 0);
-                    assert(col < this->nrow_);
+                dia = static_cast<ValueType>(1) / dia;
 
-                    mis_tuple tj;
-                    tj.s = cast_state->vec_[col];
-                    tj.v = cast_hash->vec_[col];
-                    tj.i = col;
+                PtrType row_begin = cast_prolong->mat_.row_offset[i];
+                PtrType row_end   = row_begin;
 
-                    t_max = lexographical_max(&tj, &t_max);
-                }
-            }
+                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
+                    ++j)
+                {
+                    int c = this->mat_.col[j];
 
-            if(global == true)
-            {
-                PtrType gst_row_begin = cast_gst->mat_.row_offset[i];
-                PtrType gst_row_end   = cast_gst->mat_.row_offset[i + 1];
+                    assert(c >= 0);
+                    assert(c < this->nrow_);
 
-                for(PtrType j = gst_row_begin; j < gst_row_end; ++j)
-                {
-                    if(cast_conn->vec_[j + this->nnz_] == true)
+                    // Skip weak couplings, ...
+                    if(c != i && !cast_conn->vec_[j])
                     {
-                        int col = cast_gst->mat_.col[j];
+                        continue;
+                    }
 
-                        mis_tuple tj;
-                        tj.s = cast_state->vec_[this->nrow_ + col];
-                        tj.v = cast_hash->vec_[this->nrow_ + col];
-                        tj.i = this->nrow_ + col;
+                    // ... and the ones not in any aggregate.
+                    int g = cast_agg->vec_[c];
+                    if(g < 0)
+                    {
+                        continue;
+                    }
 
-                        t_max = lexographical_max(&tj, &t_max);
+                    ValueType v = (c == i) ? static_cast<ValueType>(1) - relax
+                                           : -relax * dia * this->mat_.val[j];
+
+                    if(marker[g] < row_begin)
+                    {
+                        marker[g]                       = row_end;
+                        cast_prolong->mat_.col[row_end] = g;
+                        cast_prolong->mat_.val[row_end] = v;
+                        ++row_end;
+                    }
+                    else
+                    {
+                        cast_prolong->mat_.val[marker[g]] += v;
                     }
                 }
             }
+        }
 
-            // Find distance two max node
-            if(t_max.i < this->nrow_)
-            {
-                int row = t_max.i;
+        cast_prolong->Sort();
 
-                assert(row >= 0);
-                assert(row < this->nrow_);
+        return true;
+    }*/
 
-                PtrType row_start = this->mat_.row_offset[row];
-                PtrType row_end   = this->mat_.row_offset[row + 1];
+    // ----------------------------------------------------------
+    // original function interp(const sparse::matrix<value_t,
+    //                          index_t> &A, const params &prm)
+    // ----------------------------------------------------------
+    // Modified and adapted from AMGCL,
+    // https://github.com/ddemidov/amgcl
+    // MIT License
+    // ----------------------------------------------------------
+    // CHANGELOG
+    // - adapted interface
+    // ----------------------------------------------------------
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AMGUnsmoothedAggregation(const BaseVector<int64_t>& aggregates,
+                                                            BaseMatrix<ValueType>* prolong) const
+    {
+        assert(prolong != NULL);
 
-                for(PtrType j = row_start; j < row_end; j++)
-                {
-                    if(cast_conn->vec_[j] == true)
-                    {
-                        int col = this->mat_.col[j];
+        const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
+        HostMatrixCSR<ValueType>*  cast_prolong = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
 
-                        assert(col >= 0);
-                        assert(col < this->nrow_);
+        assert(cast_agg != NULL);
+        assert(cast_prolong != NULL);
 
-                        mis_tuple tj;
-                        tj.s = cast_state->vec_[col];
-                        tj.v = cast_hash->vec_[col];
-                        tj.i = col;
+        int64_t ncol = 0;
 
-                        t_max = lexographical_max(&tj, &t_max);
-                    }
-                }
+        for(int i = 0; i < cast_agg->GetSize(); ++i)
+        {
+            if(cast_agg->vec_[i] > ncol)
+            {
+                ncol = cast_agg->vec_[i];
+            }
+        }
 
-                if(global == true)
-                {
-                    PtrType gst_row_begin = cast_gst->mat_.row_offset[row];
-                    PtrType gst_row_end   = cast_gst->mat_.row_offset[row + 1];
+        ++ncol;
 
-                    for(PtrType j = gst_row_begin; j < gst_row_end; ++j)
-                    {
-                        if(cast_conn->vec_[j + this->nnz_] == true)
-                        {
-                            int col = cast_gst->mat_.col[j];
+        PtrType* row_offset = NULL;
+        allocate_host(this->nrow_ + 1, &row_offset);
 
-                            mis_tuple tj;
-                            tj.s = cast_state->vec_[this->nrow_ + col];
-                            tj.v = cast_hash->vec_[this->nrow_ + col];
-                            tj.i = this->nrow_ + col;
+        int*       col = NULL;
+        ValueType* val = NULL;
 
-                            t_max = lexographical_max(&tj, &t_max);
-                        }
-                    }
-                }
+        row_offset[0] = 0;
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            if(cast_agg->vec_[i] >= 0)
+            {
+                row_offset[i + 1] = row_offset[i] + 1;
             }
             else
             {
-                PtrType bnd_row_start = cast_bnd_ptr->vec_[t_max.i - this->nrow_];
-                PtrType bnd_row_end   = cast_bnd_ptr->vec_[t_max.i - this->nrow_ + 1];
-
-                for(PtrType j = bnd_row_start; j < bnd_row_end; j++)
-                {
-                    int64_t gcol = cast_bnd_col->vec_[j];
-
-                    // Differentiate between local and ghost column
-                    int col = -1;
-                    if(gcol >= global_column_begin && gcol < global_column_end)
-                    {
-                        col = static_cast<int>(gcol - global_column_begin);
-
-                        assert(col >= 0);
-                        assert(col < this->nrow_);
-                    }
-
-                    mis_tuple tj;
-                    tj.s = cast_bnd_state->vec_[j];
-                    tj.v = cast_bnd_hash->vec_[j];
-                    tj.i = col;
-
-                    t_max = lexographical_max(&tj, &t_max);
-                }
+                row_offset[i + 1] = row_offset[i];
             }
+        }
 
-            if(cast_state->vec_[i] == 0)
+        allocate_host(row_offset[this->nrow_], &col);
+        allocate_host(row_offset[this->nrow_], &val);
+
+        for(int i = 0, j = 0; i < this->nrow_; ++i)
+        {
+            if(cast_agg->vec_[i] >= 0)
             {
-                if(t_max.i == i)
-                {
-                    cast_max_state->vec_[i] = 1;
-                    cast_agg->vec_[i]       = 1;
-                }
-                else if(t_max.s == 1)
-                {
-                    cast_max_state->vec_[i] = -1;
-                    cast_agg->vec_[i]       = 0;
-                }
-                else
-                {
-                    undecided = true;
-                }
+                col[j] = cast_agg->vec_[i];
+                val[j] = 1.0;
+                ++j;
             }
         }
 
+        cast_prolong->Clear();
+        cast_prolong->SetDataPtrCSR(
+            &row_offset, &col, &val, row_offset[this->nrow_], this->nrow_, ncol);
+
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGPMISAddUnassignedNodesToAggregations(
+    bool HostMatrixCSR<ValueType>::AMGSmoothedAggregationProlongNnz(
         int64_t                      global_column_begin,
+        int64_t                      global_column_end,
         const BaseVector<bool>&      connections,
-        const BaseVector<int>&       state,
-        const BaseVector<int64_t>&   l2g,
-        BaseVector<int>*             max_state,
-        BaseVector<int64_t>*         aggregates,
-        BaseVector<int64_t>*         aggregate_root_nodes,
-        const BaseMatrix<ValueType>& ghost) const
+        const BaseVector<int64_t>&   aggregates,
+        const BaseVector<int64_t>&   aggregate_root_nodes,
+        const BaseMatrix<ValueType>& ghost,
+        BaseVector<int>*             f2c,
+        BaseMatrix<ValueType>*       prolong_int,
+        BaseMatrix<ValueType>*       prolong_gst) const
     {
-        assert(max_state != NULL);
-        assert(aggregates != NULL);
-
-        HostVector<int64_t>* cast_agg = dynamic_cast<HostVector<int64_t>*>(aggregates);
-        HostVector<int64_t>* cast_agg_nodes
-            = dynamic_cast<HostVector<int64_t>*>(aggregate_root_nodes);
-        HostVector<int>* cast_max_state = dynamic_cast<HostVector<int>*>(max_state);
-
-        const HostVector<int64_t>* cast_l2g   = dynamic_cast<const HostVector<int64_t>*>(&l2g);
-        const HostVector<int>*     cast_state = dynamic_cast<const HostVector<int>*>(&state);
-        const HostVector<bool>*    cast_conn  = dynamic_cast<const HostVector<bool>*>(&connections);
+        const HostVector<bool>*    cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
+        const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
+        const HostVector<int64_t>* cast_agg_nodes
+            = dynamic_cast<const HostVector<int64_t>*>(&aggregate_root_nodes);
         const HostMatrixCSR<ValueType>* cast_gst
             = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
+        HostVector<int>*          cast_f2c = dynamic_cast<HostVector<int>*>(f2c);
+        HostMatrixCSR<ValueType>* cast_pi  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_int);
+        HostMatrixCSR<ValueType>* cast_pg  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_gst);
 
+        assert(cast_conn != NULL);
         assert(cast_agg != NULL);
-        assert(cast_max_state != NULL);
+        assert(cast_agg_nodes != NULL);
+        assert(cast_f2c != NULL);
+        assert(cast_pi != NULL);
 
-        assert(cast_l2g != NULL);
-        assert(cast_state != NULL);
-        assert(cast_conn != NULL);
-        assert(cast_gst != NULL);
+        // Do we need communication?
+        bool global = prolong_gst != NULL;
+
+        // Start with fresh P
+        cast_pi->Clear();
+
+        // Allocate P row pointer array
+        allocate_host(this->nrow_ + 1, &cast_pi->mat_.row_offset);
+        set_to_zero_host(this->nrow_ + 1, cast_pi->mat_.row_offset);
+
+        // We already know the number of rows of P
+        cast_pi->nrow_ = this->nrow_;
+
+        // Ghost part
+        if(global == true)
+        {
+            assert(cast_gst != NULL);
+            assert(cast_pg != NULL);
+
+            // Start with fresh P ghost
+            cast_pg->Clear();
+
+            // Allocate P ghost row pointer array
+            allocate_host(this->nrow_ + 1, &cast_pg->mat_.row_offset);
+            set_to_zero_host(this->nrow_ + 1, cast_pg->mat_.row_offset);
 
-        bool global = cast_gst->nrow_ > 0;
+            // Number of ghost rows is identical to interior
+            cast_pg->nrow_ = this->nrow_;
+        }
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
+        // Count number of entries in interior prolong
         for(int i = 0; i < this->nrow_; ++i)
         {
-            int s = cast_state->vec_[i];
+            std::unordered_set<int64_t> int_set;
+            std::unordered_set<int64_t> gst_set;
 
-            if(s == -1)
+            PtrType row_begin = this->mat_.row_offset[i];
+            PtrType row_end   = this->mat_.row_offset[i + 1];
+
+            for(PtrType j = row_begin; j < row_end; ++j)
             {
-                PtrType row_begin = this->mat_.row_offset[i];
-                PtrType row_end   = this->mat_.row_offset[i + 1];
+                int c = this->mat_.col[j];
 
-                int64_t global_col = -1;
-                for(PtrType j = row_begin; j < row_end; j++)
-                {
-                    if(cast_conn->vec_[j] == true)
-                    {
-                        int c = this->mat_.col[j];
+                assert(c >= 0);
+                assert(c < this->nrow_);
 
-                        assert(c >= 0);
-                        assert(c < this->nrow_);
+                if(c != i && !cast_conn->vec_[j])
+                {
+                    continue;
+                }
 
-                        if(cast_state->vec_[c] == 1)
-                        {
-                            cast_agg->vec_[i]       = cast_agg->vec_[c];
-                            cast_max_state->vec_[i] = 1;
+                int64_t agg = cast_agg->vec_[c];
 
-                            cast_agg_nodes->vec_[i] = cast_agg_nodes->vec_[c];
+                if(agg >= 0)
+                {
+                    int64_t global_node = cast_agg_nodes->vec_[c];
+                    assert(global_node != -1);
 
-                            global_col = global_column_begin + c;
-                            break;
-                        }
+                    if(global_node >= global_column_begin && global_node < global_column_end)
+                    {
+                        int_set.insert(global_node);
+                        cast_f2c->vec_[global_node - global_column_begin] = 1;
+                    }
+                    else
+                    {
+                        gst_set.insert(global_node);
                     }
                 }
+            }
 
-                if(global)
-                {
-                    PtrType gst_row_begin = cast_gst->mat_.row_offset[i];
-                    PtrType gst_row_end   = cast_gst->mat_.row_offset[i + 1];
+            if(global == true)
+            {
+                PtrType gst_row_begin = cast_gst->mat_.row_offset[i];
+                PtrType gst_row_end   = cast_gst->mat_.row_offset[i + 1];
 
-                    for(PtrType j = gst_row_begin; j < gst_row_end; j++)
+                for(PtrType j = gst_row_begin; j < gst_row_end; ++j)
+                {
+                    int c = cast_gst->mat_.col[j];
+                    if(!cast_conn->vec_[j + this->nnz_])
                     {
-                        if(cast_conn->vec_[j + this->nnz_] == true)
-                        {
-                            int c = cast_gst->mat_.col[j];
+                        continue;
+                    }
 
-                            if(cast_state->vec_[c + this->nrow_] == 1)
-                            {
-                                if(global_col == -1
-                                   || (global_col >= 0 && cast_l2g->vec_[c] < global_col))
-                                {
-                                    cast_agg->vec_[i]       = cast_agg->vec_[c + this->nrow_];
-                                    cast_max_state->vec_[i] = 1;
+                    int64_t agg = cast_agg->vec_[c + this->nrow_];
 
-                                    cast_agg_nodes->vec_[i] = cast_agg_nodes->vec_[c + this->nrow_];
-                                    break;
-                                }
-                            }
+                    if(agg >= 0)
+                    {
+                        int64_t global_node = cast_agg_nodes->vec_[c + this->nrow_];
+                        assert(global_node != -1);
+
+                        if(global_node >= global_column_begin && global_node < global_column_end)
+                        {
+                            int_set.insert(global_node);
+                            cast_f2c->vec_[global_node - global_column_begin] = 1;
+                        }
+                        else
+                        {
+                            gst_set.insert(global_node);
                         }
                     }
                 }
-            }
-            else if(s == -2)
-            {
-                cast_agg->vec_[i] = -2;
-            }
-        }
-
-        return true;
-    }
-
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGPMISInitializeAggregateGlobalIndices(
-        int64_t                    global_column_begin,
-        const BaseVector<int64_t>& aggregates,
-        BaseVector<int64_t>*       aggregate_root_nodes) const
-    {
-        assert(aggregate_root_nodes != NULL);
-
-        const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
-        HostVector<int64_t>*       cast_agg_nodes
-            = dynamic_cast<HostVector<int64_t>*>(aggregate_root_nodes);
 
-        assert(cast_agg != NULL);
-        assert(cast_agg_nodes != NULL);
+                cast_pg->mat_.row_offset[i + 1] = gst_set.size();
+            }
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            cast_agg_nodes->vec_[i] = (cast_agg->vec_[i] == 1) ? global_column_begin + i : -1;
+            cast_pi->mat_.row_offset[i + 1] = int_set.size();
         }
 
+        cast_f2c->ExclusiveSum(*cast_f2c);
+
         return true;
     }
 
-    // ----------------------------------------------------------
-    // original function interp(const sparse::matrix<value_t,
-    //                          index_t> &A, const params &prm)
-    // ----------------------------------------------------------
-    // Modified and adapted from AMGCL,
-    // https://github.com/ddemidov/amgcl
-    // MIT License
-    // ----------------------------------------------------------
-    // CHANGELOG
-    // - adapted interface
-    // ----------------------------------------------------------
-    /*template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGSmoothedAggregation(ValueType                  relax,
-                                                          const BaseVector<bool>&    connections,
-                                                          const BaseVector<int64_t>& aggregates,
-                                                          BaseMatrix<ValueType>*     prolong,
-                                                          int lumping_strat) const
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AMGSmoothedAggregationProlongFill(
+        int64_t                      global_column_begin,
+        int64_t                      global_column_end,
+        int                          lumping_strat,
+        ValueType                    relax,
+        const BaseVector<bool>&      connections,
+        const BaseVector<int64_t>&   aggregates,
+        const BaseVector<int64_t>&   aggregate_root_nodes,
+        const BaseVector<int64_t>&   l2g,
+        const BaseVector<int>&       f2c,
+        const BaseMatrix<ValueType>& ghost,
+        BaseMatrix<ValueType>*       prolong_int,
+        BaseMatrix<ValueType>*       prolong_gst,
+        BaseVector<int64_t>*         global_ghost_col) const
     {
-        assert(prolong != NULL);
-
         const HostVector<bool>*    cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
         const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
-        HostMatrixCSR<ValueType>*  cast_prolong = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
+        const HostVector<int64_t>* cast_agg_nodes
+            = dynamic_cast<const HostVector<int64_t>*>(&aggregate_root_nodes);
+        const HostVector<int64_t>*      cast_l2g = dynamic_cast<const HostVector<int64_t>*>(&l2g);
+        const HostVector<int>*          cast_f2c = dynamic_cast<const HostVector<int>*>(&f2c);
+        const HostMatrixCSR<ValueType>* cast_gst
+            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
+        HostMatrixCSR<ValueType>* cast_pi  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_int);
+        HostMatrixCSR<ValueType>* cast_pg  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_gst);
+        HostVector<int64_t>*      cast_glo = dynamic_cast<HostVector<int64_t>*>(global_ghost_col);
 
-        assert(cast_agg != NULL);
         assert(cast_conn != NULL);
-        assert(cast_prolong != NULL);
-
-        // Allocate
-        cast_prolong->Clear();
-        cast_prolong->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
+        assert(cast_agg != NULL);
+        assert(cast_agg_nodes != NULL);
+        assert(cast_l2g != NULL);
+        assert(cast_f2c != NULL);
+        assert(cast_pi != NULL);
 
-        int ncol = 0;
+        // Do we need communication?
+        bool global = prolong_gst != NULL;
 
-        for(int i = 0; i < cast_agg->GetSize(); ++i)
+        cast_pi->mat_.row_offset[0] = 0;
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            if(cast_agg->vec_[i] > ncol)
-            {
-                ncol = cast_agg->vec_[i];
-            }
+            cast_pi->mat_.row_offset[i + 1] += cast_pi->mat_.row_offset[i];
         }
 
-        ++ncol;
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-        {
-            std::vector<PtrType> marker(ncol, -1);
-
-#ifdef _OPENMP
-            int nt  = omp_get_num_threads();
-            int tid = omp_get_thread_num();
-
-            int chunk_size  = (this->nrow_ + nt - 1) / nt;
-            int chunk_start = tid * chunk_size;
-            int chunk_end   = std::min(this->nrow_, chunk_start + chunk_size);
-#else
-            int chunk_start = 0;
-            int chunk_end   = this->nrow_;
-#endif
-
-            // Count number of entries in prolong
-            for(int i = chunk_start; i < chunk_end; ++i)
-            {
-                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
-                    ++j)
-                {
-                    int c = this->mat_.col[j];
-
-                    assert(c >= 0);
-                    assert(c < this->nrow_);
-
-                    if(c != i && !cast_conn->vec_[j])
-                    {
-                        continue;
-                    }
+        // Initialize nnz of P
+        cast_pi->nnz_ = cast_pi->mat_.row_offset[this->nrow_];
 
-                    int g = cast_agg->vec_[c];
+        // Initialize ncol of P
+        cast_pi->ncol_ = cast_f2c->vec_[this->nrow_];
 
-                    if(g >= 0 && marker[g] != i)
-                    {
-                        marker[g] = i;
-                        ++cast_prolong->mat_.row_offset[i + 1];
-                    }
-                }
-            }
+        // Allocate column and value arrays
+        allocate_host(cast_pi->nnz_, &cast_pi->mat_.col);
+        allocate_host(cast_pi->nnz_, &cast_pi->mat_.val);
+        set_to_zero_host(cast_pi->nnz_, cast_pi->mat_.col);
+        set_to_zero_host(cast_pi->nnz_, cast_pi->mat_.val);
 
-            std::fill(marker.begin(), marker.end(), -1);
+        // Once again for the ghost part
+        if(global == true)
+        {
+            assert(cast_gst != NULL);
+            assert(cast_pg != NULL);
+            assert(cast_glo != NULL);
 
-#ifdef _OPENMP
-#pragma omp barrier
-#pragma omp single
-#endif
+            cast_pg->mat_.row_offset[0] = 0;
+            for(int i = 0; i < this->nrow_; ++i)
             {
-                PtrType* row_offset = NULL;
-                allocate_host(cast_prolong->nrow_ + 1, &row_offset);
-
-                int*       col = NULL;
-                ValueType* val = NULL;
+                cast_pg->mat_.row_offset[i + 1] += cast_pg->mat_.row_offset[i];
+            }
 
-                int64_t nnz  = 0;
-                int     nrow = cast_prolong->nrow_;
+            // Initialize nnz of P
+            cast_pg->nnz_ = cast_pg->mat_.row_offset[this->nrow_];
 
-                row_offset[0] = 0;
-                for(int i = 1; i < nrow + 1; ++i)
-                {
-                    row_offset[i] = cast_prolong->mat_.row_offset[i] + row_offset[i - 1];
-                }
+            // Initialize ncol of P
+            cast_pg->ncol_ = this->nrow_; // Need to fix this!!!!
 
-                nnz = row_offset[nrow];
+            allocate_host(cast_pg->nnz_, &cast_pg->mat_.col);
+            allocate_host(cast_pg->nnz_, &cast_pg->mat_.val);
+            set_to_zero_host(cast_pg->nnz_, cast_pg->mat_.col);
+            set_to_zero_host(cast_pg->nnz_, cast_pg->mat_.val);
 
-                allocate_host(nnz, &col);
-                allocate_host(nnz, &val);
+            cast_glo->Allocate(cast_pg->nnz_);
+        }
 
-                cast_prolong->Clear();
-                cast_prolong->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
-            }
+        // Fill the interpolation matrix.
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            // Diagonal of the filtered matrix is original matrix diagonal plus (lumping_strat = 0) or
+            // minus (lumping_strat = 1) its weak connections.
+            ValueType dia = static_cast<ValueType>(0);
 
-            // Fill the interpolation matrix.
-            for(int i = chunk_start; i < chunk_end; ++i)
+            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                // Diagonal of the filtered matrix is original matrix diagonal plus (lumping_strat = 0) or
-                // minus (lumping_strat = 1) its weak connections.
-                ValueType dia = static_cast<ValueType>(0);
-                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
-                    ++j)
+                if(this->mat_.col[j] == i)
                 {
-                    if(this->mat_.col[j] == i)
+                    dia += this->mat_.val[j];
+                }
+                else if(!cast_conn->vec_[j])
+                {
+                    if(lumping_strat == 0)
                     {
                         dia += this->mat_.val[j];
                     }
-                    else if(!cast_conn->vec_[j])
+                    else
+                    {
+                        dia -= this->mat_.val[j];
+                    }
+                }
+            }
+
+            if(global == true)
+            {
+                for(PtrType j = cast_gst->mat_.row_offset[i]; j < cast_gst->mat_.row_offset[i + 1];
+                    ++j)
+                {
+                    if(!cast_conn->vec_[j + this->nnz_])
                     {
                         if(lumping_strat == 0)
                         {
-                            dia += this->mat_.val[j];
+                            dia += cast_gst->mat_.val[j];
                         }
                         else
                         {
-                            dia -= this->mat_.val[j];
+                            dia -= cast_gst->mat_.val[j];
                         }
                     }
                 }
+            }
 
-                dia = static_cast<ValueType>(1) / dia;
+            dia = static_cast<ValueType>(1) / dia;
 
-                PtrType row_begin = cast_prolong->mat_.row_offset[i];
-                PtrType row_end   = row_begin;
+            PtrType pi_row_begin = cast_pi->mat_.row_offset[i];
+            PtrType pi_row_end   = pi_row_begin;
 
-                for(PtrType j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e;
-                    ++j)
-                {
-                    int c = this->mat_.col[j];
+            // Hash table
+            std::map<int64_t, ValueType> int_table;
+            std::map<int64_t, ValueType> gst_table;
 
-                    assert(c >= 0);
-                    assert(c < this->nrow_);
+            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                int c = this->mat_.col[j];
 
-                    // Skip weak couplings, ...
-                    if(c != i && !cast_conn->vec_[j])
-                    {
-                        continue;
-                    }
+                assert(c >= 0);
+                assert(c < this->nrow_);
 
-                    // ... and the ones not in any aggregate.
-                    int g = cast_agg->vec_[c];
-                    if(g < 0)
-                    {
-                        continue;
-                    }
+                // Skip weak couplings, ...
+                if(c != i && !cast_conn->vec_[j])
+                {
+                    continue;
+                }
 
+                // ... and the ones not in any aggregate.
+                int64_t agg = cast_agg->vec_[c];
+                if(agg >= 0)
+                {
                     ValueType v = (c == i) ? static_cast<ValueType>(1) - relax
                                            : -relax * dia * this->mat_.val[j];
 
-                    if(marker[g] < row_begin)
+                    int64_t global_node = cast_agg_nodes->vec_[c];
+                    assert(global_node != -1);
+
+                    if(global_node >= global_column_begin && global_node < global_column_end)
                     {
-                        marker[g]                       = row_end;
-                        cast_prolong->mat_.col[row_end] = g;
-                        cast_prolong->mat_.val[row_end] = v;
-                        ++row_end;
+                        if(int_table.find(global_node) != int_table.end())
+                        {
+                            int_table[global_node] += v;
+                        }
+                        else
+                        {
+                            int_table[global_node] = v;
+                        }
                     }
                     else
                     {
-                        cast_prolong->mat_.val[marker[g]] += v;
+                        if(gst_table.find(global_node) != gst_table.end())
+                        {
+                            gst_table[global_node] += v;
+                        }
+                        else
+                        {
+                            gst_table[global_node] = v;
+                        }
                     }
                 }
             }
-        }
-
-        cast_prolong->Sort();
-
-        return true;
-    }*/
-
-    // ----------------------------------------------------------
-    // original function interp(const sparse::matrix<value_t,
-    //                          index_t> &A, const params &prm)
-    // ----------------------------------------------------------
-    // Modified and adapted from AMGCL,
-    // https://github.com/ddemidov/amgcl
-    // MIT License
-    // ----------------------------------------------------------
-    // CHANGELOG
-    // - adapted interface
-    // ----------------------------------------------------------
-    template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGUnsmoothedAggregation(const BaseVector<int64_t>& aggregates,
-                                                            BaseMatrix<ValueType>* prolong) const
-    {
-        assert(prolong != NULL);
-
-        const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
-        HostMatrixCSR<ValueType>*  cast_prolong = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
-
-        assert(cast_agg != NULL);
-        assert(cast_prolong != NULL);
-
-        int64_t ncol = 0;
-
-        for(int i = 0; i < cast_agg->GetSize(); ++i)
-        {
-            if(cast_agg->vec_[i] > ncol)
+            if(global == true)
             {
-                ncol = cast_agg->vec_[i];
-            }
-        }
+                PtrType pg_row_begin = cast_pg->mat_.row_offset[i];
+                PtrType pg_row_end   = pg_row_begin;
 
-        ++ncol;
+                for(PtrType j = cast_gst->mat_.row_offset[i]; j < cast_gst->mat_.row_offset[i + 1];
+                    ++j)
+                {
+                    int c = cast_gst->mat_.col[j];
 
-        PtrType* row_offset = NULL;
-        allocate_host(this->nrow_ + 1, &row_offset);
+                    // Skip weak couplings, ...
+                    if(!cast_conn->vec_[j + this->nnz_])
+                    {
+                        continue;
+                    }
 
-        int*       col = NULL;
-        ValueType* val = NULL;
+                    // ... and the ones not in any aggregate.
+                    int64_t agg = cast_agg->vec_[c + this->nrow_];
 
-        row_offset[0] = 0;
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            if(cast_agg->vec_[i] >= 0)
-            {
-                row_offset[i + 1] = row_offset[i] + 1;
-            }
-            else
-            {
-                row_offset[i + 1] = row_offset[i];
-            }
-        }
+                    if(agg >= 0)
+                    {
+                        ValueType v = -relax * dia * cast_gst->mat_.val[j];
 
-        allocate_host(row_offset[this->nrow_], &col);
-        allocate_host(row_offset[this->nrow_], &val);
+                        int64_t global_node = cast_agg_nodes->vec_[c + this->nrow_];
+                        assert(global_node != -1);
 
-        for(int i = 0, j = 0; i < this->nrow_; ++i)
-        {
-            if(cast_agg->vec_[i] >= 0)
+                        if(global_node >= global_column_begin && global_node < global_column_end)
+                        {
+                            if(int_table.find(global_node) != int_table.end())
+                            {
+                                int_table[global_node] += v;
+                            }
+                            else
+                            {
+                                int_table[global_node] = v;
+                            }
+                        }
+                        else
+                        {
+                            if(gst_table.find(global_node) != gst_table.end())
+                            {
+                                gst_table[global_node] += v;
+                            }
+                            else
+                            {
+                                gst_table[global_node] = v;
+                            }
+                        }
+                    }
+                }
+
+                for(auto it = gst_table.begin(); it != gst_table.end(); it++)
+                {
+                    cast_pg->mat_.val[pg_row_end] = it->second;
+                    cast_glo->vec_[pg_row_end]    = it->first;
+                    ++pg_row_end;
+                }
+            }
+
+            for(auto it = int_table.begin(); it != int_table.end(); it++)
             {
-                col[j] = cast_agg->vec_[i];
-                val[j] = 1.0;
-                ++j;
+                cast_pi->mat_.col[pi_row_end] = cast_f2c->vec_[it->first - global_column_begin];
+                cast_pi->mat_.val[pi_row_end] = it->second;
+                ++pi_row_end;
             }
         }
 
-        cast_prolong->Clear();
-        cast_prolong->SetDataPtrCSR(
-            &row_offset, &col, &val, row_offset[this->nrow_], this->nrow_, ncol);
-
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGSmoothedAggregationProlongNnz(
+    bool HostMatrixCSR<ValueType>::AMGUnsmoothedAggregationProlongNnz(
         int64_t                      global_column_begin,
         int64_t                      global_column_end,
-        const BaseVector<bool>&      connections,
         const BaseVector<int64_t>&   aggregates,
         const BaseVector<int64_t>&   aggregate_root_nodes,
         const BaseMatrix<ValueType>& ghost,
@@ -5944,7 +10997,6 @@ namespace rocalution
         BaseMatrix<ValueType>*       prolong_int,
         BaseMatrix<ValueType>*       prolong_gst) const
     {
-        const HostVector<bool>*    cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
         const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
         const HostVector<int64_t>* cast_agg_nodes
             = dynamic_cast<const HostVector<int64_t>*>(&aggregate_root_nodes);
@@ -5954,7 +11006,6 @@ namespace rocalution
         HostMatrixCSR<ValueType>* cast_pi  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_int);
         HostMatrixCSR<ValueType>* cast_pg  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_gst);
 
-        assert(cast_conn != NULL);
         assert(cast_agg != NULL);
         assert(cast_agg_nodes != NULL);
         assert(cast_f2c != NULL);
@@ -5993,79 +11044,23 @@ namespace rocalution
         // Count number of entries in interior prolong
         for(int i = 0; i < this->nrow_; ++i)
         {
-            std::unordered_set<int64_t> int_set;
-            std::unordered_set<int64_t> gst_set;
-
-            PtrType row_begin = this->mat_.row_offset[i];
-            PtrType row_end   = this->mat_.row_offset[i + 1];
+            int64_t agg = cast_agg->vec_[i];
 
-            for(PtrType j = row_begin; j < row_end; ++j)
+            if(agg >= 0)
             {
-                int c = this->mat_.col[j];
-
-                assert(c >= 0);
-                assert(c < this->nrow_);
-
-                if(c != i && !cast_conn->vec_[j])
-                {
-                    continue;
-                }
-
-                int64_t agg = cast_agg->vec_[c];
+                int64_t global_node = cast_agg_nodes->vec_[i];
+                assert(global_node != -1);
 
-                if(agg >= 0)
+                if(global_node >= global_column_begin && global_node < global_column_end)
                 {
-                    int64_t global_node = cast_agg_nodes->vec_[c];
-                    assert(global_node != -1);
-
-                    if(global_node >= global_column_begin && global_node < global_column_end)
-                    {
-                        int_set.insert(global_node);
-                        cast_f2c->vec_[global_node - global_column_begin] = 1;
-                    }
-                    else
-                    {
-                        gst_set.insert(global_node);
-                    }
+                    cast_pi->mat_.row_offset[i + 1]                   = 1;
+                    cast_f2c->vec_[global_node - global_column_begin] = 1;
                 }
-            }
-
-            if(global == true)
-            {
-                PtrType gst_row_begin = cast_gst->mat_.row_offset[i];
-                PtrType gst_row_end   = cast_gst->mat_.row_offset[i + 1];
-
-                for(PtrType j = gst_row_begin; j < gst_row_end; ++j)
+                else
                 {
-                    int c = cast_gst->mat_.col[j];
-                    if(!cast_conn->vec_[j + this->nnz_])
-                    {
-                        continue;
-                    }
-
-                    int64_t agg = cast_agg->vec_[c + this->nrow_];
-
-                    if(agg >= 0)
-                    {
-                        int64_t global_node = cast_agg_nodes->vec_[c + this->nrow_];
-                        assert(global_node != -1);
-
-                        if(global_node >= global_column_begin && global_node < global_column_end)
-                        {
-                            int_set.insert(global_node);
-                            cast_f2c->vec_[global_node - global_column_begin] = 1;
-                        }
-                        else
-                        {
-                            gst_set.insert(global_node);
-                        }
-                    }
+                    cast_pg->mat_.row_offset[i + 1] = 1;
                 }
-
-                cast_pg->mat_.row_offset[i + 1] = gst_set.size();
             }
-
-            cast_pi->mat_.row_offset[i + 1] = int_set.size();
         }
 
         cast_f2c->ExclusiveSum(*cast_f2c);
@@ -6074,26 +11069,20 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGSmoothedAggregationProlongFill(
+    bool HostMatrixCSR<ValueType>::AMGUnsmoothedAggregationProlongFill(
         int64_t                      global_column_begin,
         int64_t                      global_column_end,
-        int                          lumping_strat,
-        ValueType                    relax,
-        const BaseVector<bool>&      connections,
         const BaseVector<int64_t>&   aggregates,
         const BaseVector<int64_t>&   aggregate_root_nodes,
-        const BaseVector<int64_t>&   l2g,
         const BaseVector<int>&       f2c,
         const BaseMatrix<ValueType>& ghost,
         BaseMatrix<ValueType>*       prolong_int,
         BaseMatrix<ValueType>*       prolong_gst,
         BaseVector<int64_t>*         global_ghost_col) const
     {
-        const HostVector<bool>*    cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
         const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
         const HostVector<int64_t>* cast_agg_nodes
             = dynamic_cast<const HostVector<int64_t>*>(&aggregate_root_nodes);
-        const HostVector<int64_t>*      cast_l2g = dynamic_cast<const HostVector<int64_t>*>(&l2g);
         const HostVector<int>*          cast_f2c = dynamic_cast<const HostVector<int>*>(&f2c);
         const HostMatrixCSR<ValueType>* cast_gst
             = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
@@ -6101,10 +11090,8 @@ namespace rocalution
         HostMatrixCSR<ValueType>* cast_pg  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_gst);
         HostVector<int64_t>*      cast_glo = dynamic_cast<HostVector<int64_t>*>(global_ghost_col);
 
-        assert(cast_conn != NULL);
         assert(cast_agg != NULL);
         assert(cast_agg_nodes != NULL);
-        assert(cast_l2g != NULL);
         assert(cast_f2c != NULL);
         assert(cast_pi != NULL);
 
@@ -6136,382 +11123,664 @@ namespace rocalution
             assert(cast_pg != NULL);
             assert(cast_glo != NULL);
 
-            cast_pg->mat_.row_offset[0] = 0;
-            for(int i = 0; i < this->nrow_; ++i)
+            cast_pg->mat_.row_offset[0] = 0;
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                cast_pg->mat_.row_offset[i + 1] += cast_pg->mat_.row_offset[i];
+            }
+
+            // Initialize nnz of P
+            cast_pg->nnz_ = cast_pg->mat_.row_offset[this->nrow_];
+
+            // Initialize ncol of P
+            cast_pg->ncol_ = this->nrow_; // Need to fix this!!!!
+
+            allocate_host(cast_pg->nnz_, &cast_pg->mat_.col);
+            allocate_host(cast_pg->nnz_, &cast_pg->mat_.val);
+            set_to_zero_host(cast_pg->nnz_, cast_pg->mat_.col);
+            set_to_zero_host(cast_pg->nnz_, cast_pg->mat_.val);
+
+            cast_glo->Allocate(cast_pg->nnz_);
+        }
+
+        // Count number of entries in interior prolong
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            int64_t agg = cast_agg->vec_[i];
+
+            if(agg >= 0)
+            {
+                int64_t global_node = cast_agg_nodes->vec_[i];
+                assert(global_node != -1);
+
+                if(global_node >= global_column_begin && global_node < global_column_end)
+                {
+                    PtrType pi_row_end = cast_pi->mat_.row_offset[i];
+
+                    cast_pi->mat_.col[pi_row_end]
+                        = cast_f2c->vec_[global_node - global_column_begin];
+                    cast_pi->mat_.val[pi_row_end] = 1;
+                }
+                else
+                {
+                    PtrType pg_row_end = cast_pg->mat_.row_offset[i];
+
+                    cast_pg->mat_.val[pg_row_end] = 1;
+                    cast_glo->vec_[pg_row_end]    = global_node;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::AMGSmoothedAggregationNullSpace(
+        ValueType                    relax,
+        int                          lumping_strat,
+        const BaseVector<bool>&      connections,
+        const BaseVector<int64_t>&   aggregates,
+        const BaseVector<int64_t>&   aggregate_root_nodes,
+        int                          num_null,
+        const BaseVector<ValueType>& null_space,
+        BaseMatrix<ValueType>*       prolong,
+        BaseVector<ValueType>*       coarse_null_space) const
+    {
+        const HostVector<bool>*    cast_conn = dynamic_cast<const HostVector<bool>*>(&connections);
+        const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
+        const HostVector<int64_t>* cast_agg_nodes
+            = dynamic_cast<const HostVector<int64_t>*>(&aggregate_root_nodes);
+        const HostVector<ValueType>* cast_ns = dynamic_cast<const HostVector<ValueType>*>(&null_space);
+        HostMatrixCSR<ValueType>*    cast_pr = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
+        HostVector<ValueType>*       cast_cns = dynamic_cast<HostVector<ValueType>*>(coarse_null_space);
+
+        assert(cast_conn != NULL);
+        assert(cast_agg != NULL);
+        assert(cast_agg_nodes != NULL);
+        assert(cast_ns != NULL);
+        assert(cast_pr != NULL);
+        assert(cast_cns != NULL);
+        assert(num_null > 0);
+        assert(cast_ns->size_ == static_cast<int64_t>(this->nrow_) * num_null);
+
+        int nrow = this->nrow_;
+        int k    = num_null;
+
+        // Number the aggregates consecutively by their root nodes
+        std::vector<int> root2agg(nrow + 1, 0);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            if(cast_agg->vec_[i] >= 0)
+            {
+                int64_t root = cast_agg_nodes->vec_[i];
+
+                assert(root >= 0);
+                assert(root < nrow);
+
+                root2agg[root] = 1;
+            }
+        }
+
+        int nagg = 0;
+        for(int i = 0; i < nrow; ++i)
+        {
+            int mark    = root2agg[i];
+            root2agg[i] = nagg;
+            nagg += mark;
+        }
+
+        // Members of each aggregate, stored in CSR like fashion
+        std::vector<int> node2agg(nrow, -1);
+        std::vector<int> node2pos(nrow, -1);
+        std::vector<int> agg_ptr(nagg + 1, 0);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            if(cast_agg->vec_[i] >= 0)
+            {
+                node2agg[i] = root2agg[cast_agg_nodes->vec_[i]];
+                ++agg_ptr[node2agg[i] + 1];
+            }
+        }
+
+        for(int a = 0; a < nagg; ++a)
+        {
+            agg_ptr[a + 1] += agg_ptr[a];
+        }
+
+        std::vector<int> agg_nodes(agg_ptr[nagg]);
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            int a = node2agg[i];
+
+            if(a >= 0)
+            {
+                node2pos[i]           = agg_ptr[a];
+                agg_nodes[agg_ptr[a]] = i;
+                ++agg_ptr[a];
+            }
+        }
+
+        for(int a = nagg; a > 0; --a)
+        {
+            agg_ptr[a] = agg_ptr[a - 1];
+        }
+        agg_ptr[0] = 0;
+
+        // Each aggregate contributes as many coarse dofs as the null space has vectors,
+        // unless it has fewer nodes than that
+        std::vector<int> agg_dof(nagg + 1, 0);
+
+        for(int a = 0; a < nagg; ++a)
+        {
+            agg_dof[a + 1] = agg_dof[a] + std::min(agg_ptr[a + 1] - agg_ptr[a], k);
+        }
+
+        int nc = agg_dof[nagg];
+
+        // Tentative prolongation, stored row wise for each aggregated node
+        std::vector<ValueType> tent(static_cast<size_t>(agg_ptr[nagg]) * k,
+                                    static_cast<ValueType>(0));
+
+        cast_cns->Clear();
+        cast_cns->Allocate(static_cast<int64_t>(nc) * k);
+
+        // Orthonormalize the null space restricted to each aggregate (QR factorization).
+        // Q forms the tentative prolongation, R the coarse null space.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+        for(int a = 0; a < nagg; ++a)
+        {
+            int begin = agg_ptr[a];
+            int na    = agg_ptr[a + 1] - begin;
+            int ka    = agg_dof[a + 1] - agg_dof[a];
+            int nq    = 0;
+
+            std::vector<ValueType> Q(na * ka, static_cast<ValueType>(0));
+            std::vector<ValueType> R(ka * k, static_cast<ValueType>(0));
+            std::vector<ValueType> w(na);
+
+            // Project the current vector w onto the basis Q, twice for stability
+            auto orthogonalize = [&](int j) {
+                for(int pass = 0; pass < 2; ++pass)
+                {
+                    for(int l = 0; l < nq; ++l)
+                    {
+                        ValueType dot = static_cast<ValueType>(0);
+                        for(int m = 0; m < na; ++m)
+                        {
+                            dot += rocalution_conj(Q[l * na + m]) * w[m];
+                        }
+
+                        for(int m = 0; m < na; ++m)
+                        {
+                            w[m] -= dot * Q[l * na + m];
+                        }
+
+                        if(j >= 0)
+                        {
+                            R[l * k + j] += dot;
+                        }
+                    }
+                }
+
+                double nrm = 0.0;
+                for(int m = 0; m < na; ++m)
+                {
+                    nrm += std::abs(w[m]) * std::abs(w[m]);
+                }
+
+                return std::sqrt(nrm);
+            };
+
+            // Modified Gram-Schmidt on the null space vectors
+            for(int j = 0; j < k; ++j)
+            {
+                double nrm0 = 0.0;
+                for(int m = 0; m < na; ++m)
+                {
+                    w[m] = cast_ns->vec_[static_cast<int64_t>(j) * nrow + agg_nodes[begin + m]];
+                    nrm0 += std::abs(w[m]) * std::abs(w[m]);
+                }
+
+                double nrm = orthogonalize(j);
+
+                // Skip vectors that are (numerically) dependent on the previous ones
+                if(nq < ka && nrm > 1e-10 * std::sqrt(nrm0))
+                {
+                    for(int m = 0; m < na; ++m)
+                    {
+                        Q[nq * na + m] = w[m] / static_cast<ValueType>(nrm);
+                    }
+
+                    R[nq * k + j] = static_cast<ValueType>(nrm);
+                    ++nq;
+                }
+            }
+
+            // Complete the basis with unit vectors, if the null space is rank deficient on
+            // this aggregate
+            for(int e = 0; nq < ka && e < na; ++e)
+            {
+                std::fill(w.begin(), w.end(), static_cast<ValueType>(0));
+                w[e] = static_cast<ValueType>(1);
+
+                double nrm = orthogonalize(-1);
+
+                if(nrm > 0.5)
+                {
+                    for(int m = 0; m < na; ++m)
+                    {
+                        Q[nq * na + m] = w[m] / static_cast<ValueType>(nrm);
+                    }
+
+                    ++nq;
+                }
+            }
+
+            for(int m = 0; m < na; ++m)
             {
-                cast_pg->mat_.row_offset[i + 1] += cast_pg->mat_.row_offset[i];
+                for(int l = 0; l < ka; ++l)
+                {
+                    tent[static_cast<size_t>(begin + m) * k + l] = Q[l * na + m];
+                }
             }
 
-            // Initialize nnz of P
-            cast_pg->nnz_ = cast_pg->mat_.row_offset[this->nrow_];
-
-            // Initialize ncol of P
-            cast_pg->ncol_ = this->nrow_; // Need to fix this!!!!
+            for(int j = 0; j < k; ++j)
+            {
+                for(int l = 0; l < ka; ++l)
+                {
+                    cast_cns->vec_[static_cast<int64_t>(j) * nc + agg_dof[a] + l] = R[l * k + j];
+                }
+            }
+        }
 
-            allocate_host(cast_pg->nnz_, &cast_pg->mat_.col);
-            allocate_host(cast_pg->nnz_, &cast_pg->mat_.val);
-            set_to_zero_host(cast_pg->nnz_, cast_pg->mat_.col);
-            set_to_zero_host(cast_pg->nnz_, cast_pg->mat_.val);
+        // Start with fresh P
+        cast_pr->Clear();
 
-            cast_glo->Allocate(cast_pg->nnz_);
-        }
+        allocate_host(nrow + 1, &cast_pr->mat_.row_offset);
+        set_to_zero_host(nrow + 1, cast_pr->mat_.row_offset);
 
-        // Fill the interpolation matrix.
-        for(int i = 0; i < this->nrow_; ++i)
+        // Count the entries of P = (I - relax * D^-1 * A_F) * T, row i has all coarse dofs
+        // of each aggregate it is strongly connected to
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
         {
-            // Diagonal of the filtered matrix is original matrix diagonal plus (lumping_strat = 0) or
-            // minus (lumping_strat = 1) its weak connections.
-            ValueType dia = static_cast<ValueType>(0);
+            std::vector<int> mark(nagg, -1);
 
-            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int i = 0; i < nrow; ++i)
             {
-                if(this->mat_.col[j] == i)
-                {
-                    dia += this->mat_.val[j];
-                }
-                else if(!cast_conn->vec_[j])
+                PtrType row_nnz = 0;
+
+                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
                 {
-                    if(lumping_strat == 0)
+                    int c = this->mat_.col[j];
+
+                    if(c != i && !cast_conn->vec_[j])
                     {
-                        dia += this->mat_.val[j];
+                        continue;
                     }
-                    else
+
+                    int a = node2agg[c];
+
+                    if(a >= 0 && mark[a] != i)
                     {
-                        dia -= this->mat_.val[j];
+                        mark[a] = i;
+                        row_nnz += agg_dof[a + 1] - agg_dof[a];
                     }
                 }
+
+                cast_pr->mat_.row_offset[i] = row_nnz;
             }
+        }
 
-            if(global == true)
+        csr_row_count_to_offset(nrow, cast_pr->mat_.row_offset);
+
+        cast_pr->nrow_ = nrow;
+        cast_pr->ncol_ = nc;
+        cast_pr->nnz_  = cast_pr->mat_.row_offset[nrow];
+
+        allocate_host(cast_pr->nnz_, &cast_pr->mat_.col);
+        allocate_host(cast_pr->nnz_, &cast_pr->mat_.val);
+        set_to_zero_host(cast_pr->nnz_, cast_pr->mat_.col);
+        set_to_zero_host(cast_pr->nnz_, cast_pr->mat_.val);
+
+        // Fill P
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<PtrType> pos(nagg, -1);
+            std::vector<int>     row_agg;
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int i = 0; i < nrow; ++i)
             {
-                for(PtrType j = cast_gst->mat_.row_offset[i]; j < cast_gst->mat_.row_offset[i + 1];
-                    ++j)
+                // Diagonal of the filtered matrix is original matrix diagonal plus
+                // (lumping_strat = 0) or minus (lumping_strat = 1) its weak connections.
+                ValueType dia = static_cast<ValueType>(0);
+
+                row_agg.clear();
+
+                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
                 {
-                    if(!cast_conn->vec_[j + this->nnz_])
+                    int c = this->mat_.col[j];
+
+                    if(c == i)
+                    {
+                        dia += this->mat_.val[j];
+                    }
+                    else if(!cast_conn->vec_[j])
                     {
                         if(lumping_strat == 0)
                         {
-                            dia += cast_gst->mat_.val[j];
+                            dia += this->mat_.val[j];
                         }
                         else
                         {
-                            dia -= cast_gst->mat_.val[j];
+                            dia -= this->mat_.val[j];
                         }
-                    }
-                }
-            }
-
-            dia = static_cast<ValueType>(1) / dia;
 
-            PtrType pi_row_begin = cast_pi->mat_.row_offset[i];
-            PtrType pi_row_end   = pi_row_begin;
+                        continue;
+                    }
 
-            // Hash table
-            std::map<int64_t, ValueType> int_table;
-            std::map<int64_t, ValueType> gst_table;
+                    int a = node2agg[c];
 
-            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                int c = this->mat_.col[j];
+                    if(a >= 0 && pos[a] == -1)
+                    {
+                        pos[a] = 0;
+                        row_agg.push_back(a);
+                    }
+                }
 
-                assert(c >= 0);
-                assert(c < this->nrow_);
+                dia = static_cast<ValueType>(1) / dia;
 
-                // Skip weak couplings, ...
-                if(c != i && !cast_conn->vec_[j])
-                {
-                    continue;
-                }
+                // Aggregates in ascending order give sorted column indices
+                std::sort(row_agg.begin(), row_agg.end());
 
-                // ... and the ones not in any aggregate.
-                int64_t agg = cast_agg->vec_[c];
-                if(agg >= 0)
+                PtrType idx = cast_pr->mat_.row_offset[i];
+                for(size_t r = 0; r < row_agg.size(); ++r)
                 {
-                    ValueType v = (c == i) ? static_cast<ValueType>(1) - relax
-                                           : -relax * dia * this->mat_.val[j];
-
-                    int64_t global_node = cast_agg_nodes->vec_[c];
-                    assert(global_node != -1);
+                    int a  = row_agg[r];
+                    pos[a] = idx;
 
-                    if(global_node >= global_column_begin && global_node < global_column_end)
-                    {
-                        if(int_table.find(global_node) != int_table.end())
-                        {
-                            int_table[global_node] += v;
-                        }
-                        else
-                        {
-                            int_table[global_node] = v;
-                        }
-                    }
-                    else
+                    for(int l = agg_dof[a]; l < agg_dof[a + 1]; ++l)
                     {
-                        if(gst_table.find(global_node) != gst_table.end())
-                        {
-                            gst_table[global_node] += v;
-                        }
-                        else
-                        {
-                            gst_table[global_node] = v;
-                        }
+                        cast_pr->mat_.col[idx++] = l;
                     }
                 }
-            }
-            if(global == true)
-            {
-                PtrType pg_row_begin = cast_pg->mat_.row_offset[i];
-                PtrType pg_row_end   = pg_row_begin;
 
-                for(PtrType j = cast_gst->mat_.row_offset[i]; j < cast_gst->mat_.row_offset[i + 1];
-                    ++j)
+                assert(idx == cast_pr->mat_.row_offset[i + 1]);
+
+                for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
                 {
-                    int c = cast_gst->mat_.col[j];
+                    int c = this->mat_.col[j];
 
-                    // Skip weak couplings, ...
-                    if(!cast_conn->vec_[j + this->nnz_])
+                    if(c != i && !cast_conn->vec_[j])
                     {
                         continue;
                     }
 
-                    // ... and the ones not in any aggregate.
-                    int64_t agg = cast_agg->vec_[c + this->nrow_];
+                    int a = node2agg[c];
 
-                    if(agg >= 0)
+                    if(a < 0)
                     {
-                        ValueType v = -relax * dia * cast_gst->mat_.val[j];
+                        continue;
+                    }
 
-                        int64_t global_node = cast_agg_nodes->vec_[c + this->nrow_];
-                        assert(global_node != -1);
+                    ValueType v = (c == i) ? static_cast<ValueType>(1) - relax
+                                           : -relax * dia * this->mat_.val[j];
 
-                        if(global_node >= global_column_begin && global_node < global_column_end)
-                        {
-                            if(int_table.find(global_node) != int_table.end())
-                            {
-                                int_table[global_node] += v;
-                            }
-                            else
-                            {
-                                int_table[global_node] = v;
-                            }
-                        }
-                        else
-                        {
-                            if(gst_table.find(global_node) != gst_table.end())
-                            {
-                                gst_table[global_node] += v;
-                            }
-                            else
-                            {
-                                gst_table[global_node] = v;
-                            }
-                        }
+                    int ka = agg_dof[a + 1] - agg_dof[a];
+
+                    for(int l = 0; l < ka; ++l)
+                    {
+                        cast_pr->mat_.val[pos[a] + l]
+                            += v * tent[static_cast<size_t>(node2pos[c]) * k + l];
                     }
                 }
 
-                for(auto it = gst_table.begin(); it != gst_table.end(); it++)
+                for(size_t r = 0; r < row_agg.size(); ++r)
                 {
-                    cast_pg->mat_.val[pg_row_end] = it->second;
-                    cast_glo->vec_[pg_row_end]    = it->first;
-                    ++pg_row_end;
+                    pos[row_agg[r]] = -1;
                 }
             }
-
-            for(auto it = int_table.begin(); it != int_table.end(); it++)
-            {
-                cast_pi->mat_.col[pi_row_end] = cast_f2c->vec_[it->first - global_column_begin];
-                cast_pi->mat_.val[pi_row_end] = it->second;
-                ++pi_row_end;
-            }
         }
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGUnsmoothedAggregationProlongNnz(
-        int64_t                      global_column_begin,
-        int64_t                      global_column_end,
-        const BaseVector<int64_t>&   aggregates,
-        const BaseVector<int64_t>&   aggregate_root_nodes,
-        const BaseMatrix<ValueType>& ghost,
-        BaseVector<int>*             f2c,
-        BaseMatrix<ValueType>*       prolong_int,
-        BaseMatrix<ValueType>*       prolong_gst) const
+    bool HostMatrixCSR<ValueType>::AMGProlongTruncate(double trunc_factor, int max_row_nnz)
     {
-        const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
-        const HostVector<int64_t>* cast_agg_nodes
-            = dynamic_cast<const HostVector<int64_t>*>(&aggregate_root_nodes);
-        const HostMatrixCSR<ValueType>* cast_gst
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
-        HostVector<int>*          cast_f2c = dynamic_cast<HostVector<int>*>(f2c);
-        HostMatrixCSR<ValueType>* cast_pi  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_int);
-        HostMatrixCSR<ValueType>* cast_pg  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_gst);
+        assert(trunc_factor >= 0.0);
+        assert(max_row_nnz >= 0);
 
-        assert(cast_agg != NULL);
-        assert(cast_agg_nodes != NULL);
-        assert(cast_f2c != NULL);
-        assert(cast_pi != NULL);
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
 
-        // Do we need communication?
-        bool global = prolong_gst != NULL;
+        allocate_host(this->nrow_ + 1, &row_offset);
+        set_to_zero_host(this->nrow_ + 1, row_offset);
 
-        // Start with fresh P
-        cast_pi->Clear();
+        // Mark the entries to keep, largest entries first
+        std::vector<char> keep(this->nnz_, 0);
 
-        // Allocate P row pointer array
-        allocate_host(this->nrow_ + 1, &cast_pi->mat_.row_offset);
-        set_to_zero_host(this->nrow_ + 1, cast_pi->mat_.row_offset);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<std::pair<double, PtrType>> row;
 
-        // We already know the number of rows of P
-        cast_pi->nrow_ = this->nrow_;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                PtrType row_begin = this->mat_.row_offset[i];
+                PtrType row_end   = this->mat_.row_offset[i + 1];
 
-        // Ghost part
-        if(global == true)
-        {
-            assert(cast_gst != NULL);
-            assert(cast_pg != NULL);
+                row.clear();
+
+                double max_val = 0.0;
+                for(PtrType j = row_begin; j < row_end; ++j)
+                {
+                    double a = std::abs(this->mat_.val[j]);
+
+                    row.push_back(std::make_pair(a, j));
+                    max_val = std::max(max_val, a);
+                }
+
+                std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) {
+                    return a.first > b.first || (a.first == b.first && a.second < b.second);
+                });
+
+                PtrType row_nnz = 0;
+                for(size_t k = 0; k < row.size(); ++k)
+                {
+                    // The largest entry is always kept
+                    if(k > 0 && row[k].first < trunc_factor * max_val)
+                    {
+                        break;
+                    }
 
-            // Start with fresh P ghost
-            cast_pg->Clear();
+                    if(max_row_nnz > 0 && row_nnz == max_row_nnz)
+                    {
+                        break;
+                    }
 
-            // Allocate P ghost row pointer array
-            allocate_host(this->nrow_ + 1, &cast_pg->mat_.row_offset);
-            set_to_zero_host(this->nrow_ + 1, cast_pg->mat_.row_offset);
+                    keep[row[k].second] = 1;
+                    ++row_nnz;
+                }
 
-            // Number of ghost rows is identical to interior
-            cast_pg->nrow_ = this->nrow_;
+                row_offset[i] = row_nnz;
+            }
         }
 
-        // Count number of entries in interior prolong
+        csr_row_count_to_offset(this->nrow_, row_offset);
+
+        int64_t nnz = row_offset[this->nrow_];
+
+        allocate_host(nnz, &col);
+        allocate_host(nnz, &val);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
         for(int i = 0; i < this->nrow_; ++i)
         {
-            int64_t agg = cast_agg->vec_[i];
+            ValueType sum_all  = static_cast<ValueType>(0);
+            ValueType sum_kept = static_cast<ValueType>(0);
 
-            if(agg >= 0)
+            PtrType idx = row_offset[i];
+            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                int64_t global_node = cast_agg_nodes->vec_[i];
-                assert(global_node != -1);
+                sum_all += this->mat_.val[j];
 
-                if(global_node >= global_column_begin && global_node < global_column_end)
+                if(keep[j] == 1)
                 {
-                    cast_pi->mat_.row_offset[i + 1]                   = 1;
-                    cast_f2c->vec_[global_node - global_column_begin] = 1;
+                    sum_kept += this->mat_.val[j];
+
+                    col[idx] = this->mat_.col[j];
+                    val[idx] = this->mat_.val[j];
+                    ++idx;
                 }
-                else
+            }
+
+            // Scale the kept entries to preserve the row sum
+            if(sum_kept != static_cast<ValueType>(0))
+            {
+                ValueType scale = sum_all / sum_kept;
+
+                for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
                 {
-                    cast_pg->mat_.row_offset[i + 1] = 1;
+                    val[j] *= scale;
                 }
             }
         }
 
-        cast_f2c->ExclusiveSum(*cast_f2c);
+        int nrow = this->nrow_;
+        int ncol = this->ncol_;
+
+        this->Clear();
+        this->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
 
         return true;
     }
 
     template <typename ValueType>
-    bool HostMatrixCSR<ValueType>::AMGUnsmoothedAggregationProlongFill(
-        int64_t                      global_column_begin,
-        int64_t                      global_column_end,
-        const BaseVector<int64_t>&   aggregates,
-        const BaseVector<int64_t>&   aggregate_root_nodes,
-        const BaseVector<int>&       f2c,
-        const BaseMatrix<ValueType>& ghost,
-        BaseMatrix<ValueType>*       prolong_int,
-        BaseMatrix<ValueType>*       prolong_gst,
-        BaseVector<int64_t>*         global_ghost_col) const
+    bool HostMatrixCSR<ValueType>::AMGEnergyMinimization(ValueType              relax,
+                                                         int                    iterations,
+                                                         BaseMatrix<ValueType>* prolong) const
     {
-        const HostVector<int64_t>* cast_agg = dynamic_cast<const HostVector<int64_t>*>(&aggregates);
-        const HostVector<int64_t>* cast_agg_nodes
-            = dynamic_cast<const HostVector<int64_t>*>(&aggregate_root_nodes);
-        const HostVector<int>*          cast_f2c = dynamic_cast<const HostVector<int>*>(&f2c);
-        const HostMatrixCSR<ValueType>* cast_gst
-            = dynamic_cast<const HostMatrixCSR<ValueType>*>(&ghost);
-        HostMatrixCSR<ValueType>* cast_pi  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_int);
-        HostMatrixCSR<ValueType>* cast_pg  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong_gst);
-        HostVector<int64_t>*      cast_glo = dynamic_cast<HostVector<int64_t>*>(global_ghost_col);
+        HostMatrixCSR<ValueType>* cast_pr = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
 
-        assert(cast_agg != NULL);
-        assert(cast_agg_nodes != NULL);
-        assert(cast_f2c != NULL);
-        assert(cast_pi != NULL);
+        assert(cast_pr != NULL);
+        assert(cast_pr->nrow_ == this->nrow_);
+        assert(iterations >= 0);
 
-        // Do we need communication?
-        bool global = prolong_gst != NULL;
+        std::vector<ValueType> inv_diag(this->nrow_, static_cast<ValueType>(0));
 
-        cast_pi->mat_.row_offset[0] = 0;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for(int i = 0; i < this->nrow_; ++i)
         {
-            cast_pi->mat_.row_offset[i + 1] += cast_pi->mat_.row_offset[i];
+            for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                if(this->mat_.col[j] == i)
+                {
+                    inv_diag[i] = static_cast<ValueType>(1) / this->mat_.val[j];
+                    break;
+                }
+            }
         }
 
-        // Initialize nnz of P
-        cast_pi->nnz_ = cast_pi->mat_.row_offset[this->nrow_];
-
-        // Initialize ncol of P
-        cast_pi->ncol_ = cast_f2c->vec_[this->nrow_];
-
-        // Allocate column and value arrays
-        allocate_host(cast_pi->nnz_, &cast_pi->mat_.col);
-        allocate_host(cast_pi->nnz_, &cast_pi->mat_.val);
-        set_to_zero_host(cast_pi->nnz_, cast_pi->mat_.col);
-        set_to_zero_host(cast_pi->nnz_, cast_pi->mat_.val);
+        ValueType* val = NULL;
+        allocate_host(cast_pr->nnz_, &val);
 
-        // Once again for the ghost part
-        if(global == true)
+        // Jacobi preconditioned steepest descent of the energy of each column of P, where the
+        // update A * P is restricted to the sparsity pattern of P. Removing the row mean of the
+        // update keeps the row sums of P, i.e. the interpolation of the constant vector.
+        for(int iter = 0; iter < iterations; ++iter)
         {
-            assert(cast_gst != NULL);
-            assert(cast_pg != NULL);
-            assert(cast_glo != NULL);
-
-            cast_pg->mat_.row_offset[0] = 0;
-            for(int i = 0; i < this->nrow_; ++i)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
             {
-                cast_pg->mat_.row_offset[i + 1] += cast_pg->mat_.row_offset[i];
-            }
+                std::vector<PtrType> pos(cast_pr->ncol_, -1);
 
-            // Initialize nnz of P
-            cast_pg->nnz_ = cast_pg->mat_.row_offset[this->nrow_];
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+                for(int i = 0; i < this->nrow_; ++i)
+                {
+                    PtrType row_begin = cast_pr->mat_.row_offset[i];
+                    PtrType row_end   = cast_pr->mat_.row_offset[i + 1];
 
-            // Initialize ncol of P
-            cast_pg->ncol_ = this->nrow_; // Need to fix this!!!!
+                    if(row_begin == row_end)
+                    {
+                        continue;
+                    }
 
-            allocate_host(cast_pg->nnz_, &cast_pg->mat_.col);
-            allocate_host(cast_pg->nnz_, &cast_pg->mat_.val);
-            set_to_zero_host(cast_pg->nnz_, cast_pg->mat_.col);
-            set_to_zero_host(cast_pg->nnz_, cast_pg->mat_.val);
+                    for(PtrType k = row_begin; k < row_end; ++k)
+                    {
+                        pos[cast_pr->mat_.col[k]] = k;
+                        val[k]                    = static_cast<ValueType>(0);
+                    }
 
-            cast_glo->Allocate(cast_pg->nnz_);
-        }
+                    // Row i of A * P on the pattern of P
+                    for(PtrType j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1];
+                        ++j)
+                    {
+                        int       r = this->mat_.col[j];
+                        ValueType a = this->mat_.val[j];
 
-        // Count number of entries in interior prolong
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            int64_t agg = cast_agg->vec_[i];
+                        for(PtrType k = cast_pr->mat_.row_offset[r];
+                            k < cast_pr->mat_.row_offset[r + 1];
+                            ++k)
+                        {
+                            PtrType p = pos[cast_pr->mat_.col[k]];
 
-            if(agg >= 0)
-            {
-                int64_t global_node = cast_agg_nodes->vec_[i];
-                assert(global_node != -1);
+                            if(p != -1)
+                            {
+                                val[p] += a * cast_pr->mat_.val[k];
+                            }
+                        }
+                    }
 
-                if(global_node >= global_column_begin && global_node < global_column_end)
-                {
-                    PtrType pi_row_end = cast_pi->mat_.row_offset[i];
+                    ValueType mean = static_cast<ValueType>(0);
+                    for(PtrType k = row_begin; k < row_end; ++k)
+                    {
+                        val[k] *= inv_diag[i];
+                        mean += val[k];
+                    }
 
-                    cast_pi->mat_.col[pi_row_end]
-                        = cast_f2c->vec_[global_node - global_column_begin];
-                    cast_pi->mat_.val[pi_row_end] = 1;
-                }
-                else
-                {
-                    PtrType pg_row_end = cast_pg->mat_.row_offset[i];
+                    mean /= static_cast<ValueType>(row_end - row_begin);
 
-                    cast_pg->mat_.val[pg_row_end] = 1;
-                    cast_glo->vec_[pg_row_end]    = global_node;
+                    for(PtrType k = row_begin; k < row_end; ++k)
+                    {
+                        val[k] = cast_pr->mat_.val[k] - relax * (val[k] - mean);
+
+                        pos[cast_pr->mat_.col[k]] = -1;
+                    }
                 }
             }
+
+            std::swap(val, cast_pr->mat_.val);
         }
 
+        free_host(&val);
+
         return true;
     }
 
@@ -6755,6 +12024,7 @@ namespace rocalution
         }
 
         // Only reset value array since we keep the sparsity pattern of A
+        this->DetachView_();
         free_host(&this->mat_.val);
         this->mat_.val = val;
 
@@ -7095,8 +12365,11 @@ namespace rocalution
         // Initialize S to false (no dependencies)
         cast_S->Zeros();
 
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         // Sample some numbers using hash function to initialize omega
-        for(int64_t i = 0; i < this->nrow_; ++i)
+        for(int i = 0; i < this->nrow_; ++i)
         {
             cast_w->vec_[i] = hash(i + global_row_offset);
         }
@@ -7283,10 +12556,11 @@ namespace rocalution
         // Do we need communication?
         bool global = cast_gst->nrow_ > 0;
 
+        // Now, correct previously marked vertices with respect to omega. Several rows may
+        // revert the same vertex, thus the states are written atomically.
 #ifdef _OPENMP
 #pragma omp parallel for schedule(dynamic, 1024)
 #endif
-        // Now, correct previously marked vertices with respect to omega
         for(int i = 0; i < this->nrow_; ++i)
         {
             PtrType row_begin = this->mat_.row_offset[i];
@@ -7320,6 +12594,9 @@ namespace rocalution
                                 // The diagonal entry has more edges and will remain
                                 // a coarse point, whereas this vertex gets reverted
                                 // back to undecided, for further processing.
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
                                 cast_cf->vec_[col] = 0;
                             }
                             else if(omega_row < omega_col)
@@ -7328,6 +12605,9 @@ namespace rocalution
                                 // reverted back to undecided for further processing,
                                 // whereas this vertex stays
                                 // a coarse one.
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
                                 cast_cf->vec_[i] = 0;
                             }
                         }
@@ -7360,6 +12640,9 @@ namespace rocalution
                                     // The diagonal entry has more edges and will remain
                                     // a coarse point, whereas this vertex gets reverted
                                     // back to undecided, for further processing.
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
                                     cast_cf->vec_[col + this->nrow_] = 0;
                                 }
                                 else if(omega_row < omega_col)
@@ -7368,6 +12651,9 @@ namespace rocalution
                                     // reverted back to undecided for further processing,
                                     // whereas this vertex stays
                                     // a coarse one.
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
                                     cast_cf->vec_[i] = 0;
                                 }
                             }
@@ -7421,8 +12707,18 @@ namespace rocalution
                         int col = this->mat_.col[j];
 
                         // If this edge is coarse, our vertex must be fine
-                        if(cast_cf->vec_[col] == 1)
+                        int state;
+
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+                        state = cast_cf->vec_[col];
+
+                        if(state == 1)
                         {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
                             cast_cf->vec_[i] = 2;
                             break;
                         }
@@ -7444,8 +12740,18 @@ namespace rocalution
                             int col = cast_gst->mat_.col[j];
 
                             // If this edge is coarse, our vertex must be fine
-                            if(cast_cf->vec_[col + this->nrow_] == 1)
+                            int state;
+
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+                            state = cast_cf->vec_[col + this->nrow_];
+
+                            if(state == 1)
                             {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
                                 cast_cf->vec_[i] = 2;
                                 break;
                             }
@@ -7466,21 +12772,19 @@ namespace rocalution
 
         assert(cast_cf != NULL);
 
-        undecided = false;
+        bool found = false;
 
 #ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
+#pragma omp parallel for reduction(|| : found)
 #endif
         for(int i = 0; i < this->nrow_; ++i)
         {
             // Check whether this vertex is undecided or not
-            if(cast_cf->vec_[i] == 0)
-            {
-                undecided = true;
-                i         = this->nrow_;
-            }
+            found = found || cast_cf->vec_[i] == 0;
         }
 
+        undecided = found;
+
         return true;
     }
 
@@ -7721,17 +13025,7 @@ namespace rocalution
 
         // Exclusive sum to obtain row offset pointers of P
         // P contains only nnz per row, so far
-        for(int i = this->nrow_; i > 0; --i)
-        {
-            cast_pi->mat_.row_offset[i] = cast_pi->mat_.row_offset[i - 1];
-        }
-
-        cast_pi->mat_.row_offset[0] = 0;
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            cast_pi->mat_.row_offset[i + 1] += cast_pi->mat_.row_offset[i];
-        }
+        csr_row_count_to_offset(this->nrow_, cast_pi->mat_.row_offset);
 
         // Initialize nnz of P
         cast_pi->nnz_ = cast_pi->mat_.row_offset[this->nrow_];
@@ -7746,17 +13040,7 @@ namespace rocalution
         // Once again for the ghost part
         if(global == true)
         {
-            for(int i = this->nrow_; i > 0; --i)
-            {
-                cast_pg->mat_.row_offset[i] = cast_pg->mat_.row_offset[i - 1];
-            }
-
-            cast_pg->mat_.row_offset[0] = 0;
-
-            for(int i = 0; i < this->nrow_; ++i)
-            {
-                cast_pg->mat_.row_offset[i + 1] += cast_pg->mat_.row_offset[i];
-            }
+            csr_row_count_to_offset(this->nrow_, cast_pg->mat_.row_offset);
 
             cast_pg->nnz_  = cast_pg->mat_.row_offset[this->nrow_];
             cast_pg->ncol_ = this->nrow_;
@@ -8468,17 +13752,7 @@ namespace rocalution
 
         // Exclusive sum to obtain row offset pointers of P
         // P contains only nnz per row, so far
-        for(int i = this->nrow_; i > 0; --i)
-        {
-            cast_pi->mat_.row_offset[i] = cast_pi->mat_.row_offset[i - 1];
-        }
-
-        cast_pi->mat_.row_offset[0] = 0;
-
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            cast_pi->mat_.row_offset[i + 1] += cast_pi->mat_.row_offset[i];
-        }
+        csr_row_count_to_offset(this->nrow_, cast_pi->mat_.row_offset);
 
         // Initialize nnz of P
         cast_pi->nnz_ = cast_pi->mat_.row_offset[this->nrow_];
@@ -8493,17 +13767,7 @@ namespace rocalution
         // Once again for the ghost part
         if(global == true)
         {
-            for(int i = this->nrow_; i > 0; --i)
-            {
-                cast_pg->mat_.row_offset[i] = cast_pg->mat_.row_offset[i - 1];
-            }
-
-            cast_pg->mat_.row_offset[0] = 0;
-
-            for(int i = 0; i < this->nrow_; ++i)
-            {
-                cast_pg->mat_.row_offset[i + 1] += cast_pg->mat_.row_offset[i];
-            }
+            csr_row_count_to_offset(this->nrow_, cast_pg->mat_.row_offset);
 
             cast_pg->nnz_  = cast_pg->mat_.row_offset[this->nrow_];
             cast_pg->ncol_ = this->nrow_;
@@ -10246,6 +15510,53 @@ namespace rocalution
         return true;
     }
 
+    // splitmix64 finalizer, kept identical to the device version in hip_kernels_csr.hpp
+    static inline uint64_t hash_mix(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+
+        return x ^ (x >> 31);
+    }
+
+    template <typename ValueType>
+    bool HostMatrixCSR<ValueType>::Hash(uint64_t* hash) const
+    {
+        assert(hash != NULL);
+
+        // Every entry contributes a mix of its position and value bits, the sum does
+        // not depend on the summation order and can be reduced in parallel
+        const int nword = sizeof(ValueType) / sizeof(uint32_t);
+
+        uint64_t sum = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : sum)
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            for(PtrType aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                const uint32_t* bits = reinterpret_cast<const uint32_t*>(&this->mat_.val[aj]);
+
+                uint64_t h = hash_mix((static_cast<uint64_t>(ai) << 32)
+                                      | static_cast<uint32_t>(this->mat_.col[aj]));
+
+                for(int w = 0; w < nword; ++w)
+                {
+                    h = hash_mix(h ^ bits[w]);
+                }
+
+                sum += h;
+            }
+        }
+
+        *hash = sum;
+
+        return true;
+    }
+
     template <typename ValueType>
     bool HostMatrixCSR<ValueType>::ReplaceColumnVector(int idx, const BaseVector<ValueType>& vec)
     {
@@ -11327,6 +16638,8 @@ namespace rocalution
             // Inclusive sum
             this->ncol_ = workspace.InclusiveSum(workspace);
 
+            this->DetachStructure_();
+
             // Write new column indices into matrix
             for(int64_t i = 0; i < this->nnz_; ++i)
             {
@@ -50,9 +50,17 @@ namespace rocalution
         virtual void SetDataPtrCSR(
             PtrType** row_offset, int** col, ValueType** val, int64_t nnz, int nrow, int ncol);
         virtual void LeaveDataPtrCSR(PtrType** row_offset, int** col, ValueType** val);
+        virtual void AttachViewCSR(
+            PtrType* row_offset, int* col, ValueType* val, int64_t nnz, int nrow, int ncol);
 
         virtual void Clear(void);
         virtual bool Zeros(void);
+        virtual bool UpdateValues(const BaseVector<ValueType>& val,
+                                  const BaseVector<int>*       perm,
+                                  int64_t                      offset);
+        virtual bool AssembleValues(const BaseVector<ValueType>& val,
+                                    const BaseVector<int>&       offset,
+                                    const BaseVector<int>&       perm);
 
         virtual bool Scale(ValueType alpha);
         virtual bool ScaleDiagonal(ValueType alpha);
@@ -69,6 +77,12 @@ namespace rocalution
 
         virtual bool ExtractDiagonal(BaseVector<ValueType>* vec_diag) const;
         virtual bool ExtractInverseDiagonal(BaseVector<ValueType>* vec_inv_diag) const;
+        virtual bool ExtractInverseBlockDiagonal(int                    blockdim,
+                                                 BaseMatrix<ValueType>* inv_diag) const;
+        virtual bool ExtractRowL1Norm(BaseVector<ValueType>* vec_l1) const;
+        virtual bool ExtractConnectedRows(const BaseVector<bool>& cols,
+                                          BaseVector<bool>*       rows) const;
+        virtual bool Statistics(MatrixStatistics* stats) const;
         virtual bool ExtractU(BaseMatrix<ValueType>* U) const;
         virtual bool ExtractUDiagonal(BaseMatrix<ValueType>* U) const;
         virtual bool ExtractL(BaseMatrix<ValueType>* L) const;
@@ -89,6 +103,16 @@ namespace rocalution
                                         const BaseMatrix<ValueType>& B);
         virtual bool NumericMatMatMult(const BaseMatrix<ValueType>& A,
                                        const BaseMatrix<ValueType>& B);
+        virtual bool TripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                      const BaseMatrix<ValueType>& A,
+                                      const BaseMatrix<ValueType>& P);
+        virtual bool NumericTripleMatMatMult(const BaseMatrix<ValueType>& R,
+                                             const BaseMatrix<ValueType>& A,
+                                             const BaseMatrix<ValueType>& P);
+        virtual bool NumericTripleMatMatMultRows(const BaseMatrix<ValueType>& R,
+                                                 const BaseMatrix<ValueType>& A,
+                                                 const BaseMatrix<ValueType>& P,
+                                                 const BaseVector<bool>&      rows);
 
         virtual bool DiagonalMatrixMultR(const BaseVector<ValueType>& diag);
         virtual bool DiagonalMatrixMultL(const BaseVector<ValueType>& diag);
@@ -97,16 +121,31 @@ namespace rocalution
                                ValueType                    alpha,
                                ValueType                    beta,
                                bool                         structure);
+        virtual bool SymbolicMatrixAdd(const BaseMatrix<ValueType>& A,
+                                       const BaseMatrix<ValueType>& B);
+        virtual bool NumericMatrixAdd(const BaseMatrix<ValueType>& A,
+                                      ValueType                    alpha,
+                                      const BaseMatrix<ValueType>& B,
+                                      ValueType                    beta);
 
         virtual bool Permute(const BaseVector<int>& permutation);
+        virtual bool PermuteBackward(const BaseVector<int>& permutation);
 
         virtual bool CMK(BaseVector<int>* permutation) const;
         virtual bool RCMK(BaseVector<int>* permutation) const;
         virtual bool ConnectivityOrder(BaseVector<int>* permutation) const;
+        virtual bool GraphPartition(int nparts, BaseVector<int>* partition) const;
+        virtual bool AMD(BaseVector<int>* permutation) const;
+        virtual bool NestedDissection(int              leaf_size,
+                                      int&             num_nodes,
+                                      int**            node_offset,
+                                      int**            node_parent,
+                                      BaseVector<int>* permutation) const;
 
         virtual bool ConvertFrom(const BaseMatrix<ValueType>& mat);
 
         virtual void CopyFrom(const BaseMatrix<ValueType>& mat);
+        virtual bool ShareStructureFrom(const BaseMatrix<ValueType>& mat);
 
         virtual void CopyFromCSR(const PtrType* row_offsets, const int* col, const ValueType* val);
         virtual void CopyToCSR(PtrType* row_offsets, int* col, ValueType* val) const;
@@ -120,11 +159,14 @@ namespace rocalution
                                      int              nrow,
                                      int              ncol);
 
+        virtual bool ReadFileMTX(const std::string& filename);
+
         virtual bool ReadFileCSR(const std::string& filename);
         virtual bool WriteFileCSR(const std::string& filename) const;
 
         virtual bool ReadFileRSIO(const std::string& filename);
         virtual bool WriteFileRSIO(const std::string& filename) const;
+        virtual bool WriteFileCompressedRSIO(const std::string& filename) const;
 
         virtual bool CreateFromMap(const BaseVector<int>& map, int n, int m);
         virtual bool
@@ -160,6 +202,12 @@ namespace rocalution
         virtual void UAnalyse(bool diag_unit = false);
         virtual void UAnalyseClear(void);
         virtual bool USolve(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+        virtual bool TriangularLevels(bool lower, int* levels) const;
+        virtual bool TriangularBlockInverse(bool                   lower,
+                                            bool                   diag_unit,
+                                            int                    block_size,
+                                            BaseMatrix<ValueType>* inv,
+                                            BaseMatrix<ValueType>* off) const;
 
         virtual void ItLUAnalyse(void);
         virtual void ItLUAnalyseClear(void);
@@ -201,16 +249,77 @@ namespace rocalution
 
         virtual bool Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const;
 
+        virtual void SetSpMVIndex(unsigned int index);
+
         virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
         virtual void ApplyAdd(const BaseVector<ValueType>& in,
                               ValueType                    scalar,
                               BaseVector<ValueType>*       out) const;
+        virtual bool ApplyTranspose(const BaseVector<ValueType>& in,
+                                    BaseVector<ValueType>*       out) const;
+        virtual bool ApplyTransposeAdd(const BaseVector<ValueType>& in,
+                                       ValueType                    scalar,
+                                       BaseVector<ValueType>*       out) const;
+        virtual bool ApplyAddSymmetric(const BaseVector<ValueType>& in,
+                                       ValueType                    scalar,
+                                       BaseVector<ValueType>*       out) const;
+        virtual bool
+            ApplyMulti(int ncol, const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+        virtual bool ApplyAddMulti(int                          ncol,
+                                   const BaseVector<ValueType>& in,
+                                   ValueType                    scalar,
+                                   BaseVector<ValueType>*       out) const;
+        virtual bool ApplyRows(const BaseVector<ValueType>& in,
+                               const BaseVector<int>&       rows,
+                               BaseVector<ValueType>*       out) const;
+        virtual bool ApplyAddRows(const BaseVector<ValueType>& in,
+                                  const BaseVector<int>&       rows,
+                                  ValueType                    scalar,
+                                  BaseVector<ValueType>*       out) const;
+        virtual bool ResidualRows(const BaseVector<ValueType>& rhs,
+                                  const BaseVector<ValueType>& x,
+                                  const BaseVector<int>&       rows,
+                                  BaseVector<ValueType>*       res) const;
+
+        virtual bool BatchApply(int                          batch,
+                                const BaseVector<ValueType>& val,
+                                const BaseVector<ValueType>& in,
+                                BaseVector<ValueType>*       out) const;
+        virtual bool BatchExtractInverseDiagonal(int                          batch,
+                                                 const BaseVector<ValueType>& val,
+                                                 BaseVector<ValueType>*       inv_diag) const;
+        virtual bool BatchILU0Factorize(int batch, BaseVector<ValueType>* val) const;
+        virtual bool BatchBiCGStab(int                          batch,
+                                   const BaseVector<ValueType>& val,
+                                   const BaseVector<ValueType>* inv_diag,
+                                   const BaseVector<ValueType>* lu,
+                                   const BaseVector<ValueType>& rhs,
+                                   BaseVector<ValueType>*       x,
+                                   double                       abs_tol,
+                                   double                       rel_tol,
+                                   int                          max_iter,
+                                   int*                         iter,
+                                   double*                      res) const;
+        virtual bool BatchGMRES(int                          batch,
+                                int                          basis,
+                                const BaseVector<ValueType>& val,
+                                const BaseVector<ValueType>* inv_diag,
+                                const BaseVector<ValueType>* lu,
+                                const BaseVector<ValueType>& rhs,
+                                BaseVector<ValueType>*       x,
+                                double                       abs_tol,
+                                double                       rel_tol,
+                                int                          max_iter,
+                                int*                         iter,
+                                double*                      res) const;
 
         virtual bool Compress(double drop_off);
+        virtual bool CompressLumped(double drop_off);
         virtual bool Transpose(void);
         virtual bool Transpose(BaseMatrix<ValueType>* T) const;
         virtual bool Sort(void);
         virtual bool Key(long int& row_key, long int& col_key, long int& val_key) const;
+        virtual bool Hash(uint64_t* hash) const;
 
         virtual bool ReplaceColumnVector(int idx, const BaseVector<ValueType>& vec);
         virtual bool ExtractColumnVector(int idx, BaseVector<ValueType>* vec) const;
@@ -270,6 +379,15 @@ namespace rocalution
                                                  const BaseVector<int64_t>&   l2g,
                                                  BaseVector<bool>*            connections,
                                                  const BaseMatrix<ValueType>& ghost) const;
+        virtual bool AMGNodeGraph(int blockdim, BaseMatrix<ValueType>* node) const;
+        virtual bool AMGNodeExpand(int                          blockdim,
+                                   const BaseMatrix<ValueType>& node,
+                                   const BaseVector<bool>&      node_connections,
+                                   const BaseVector<int64_t>&   node_aggregates,
+                                   const BaseVector<int64_t>&   node_aggregate_root_nodes,
+                                   BaseVector<bool>*            connections,
+                                   BaseVector<int64_t>*         aggregates,
+                                   BaseVector<int64_t>*         aggregate_root_nodes) const;
         virtual bool AMGPMISInitializeState(int64_t                      global_column_begin,
                                             const BaseVector<bool>&      connections,
                                             BaseVector<int>*             state,
@@ -319,6 +437,22 @@ namespace rocalution
         virtual bool AMGUnsmoothedAggregation(const BaseVector<int64_t>& aggregates,
                                               BaseMatrix<ValueType>*     prolong) const;
 
+        virtual bool
+            AMGSmoothedAggregationNullSpace(ValueType                    relax,
+                                            int                          lumping_strat,
+                                            const BaseVector<bool>&      connections,
+                                            const BaseVector<int64_t>&   aggregates,
+                                            const BaseVector<int64_t>&   aggregate_root_nodes,
+                                            int                          num_null,
+                                            const BaseVector<ValueType>& null_space,
+                                            BaseMatrix<ValueType>*       prolong,
+                                            BaseVector<ValueType>*       coarse_null_space) const;
+
+        virtual bool AMGProlongTruncate(double trunc_factor, int max_row_nnz);
+        virtual bool AMGEnergyMinimization(ValueType              relax,
+                                           int                    iterations,
+                                           BaseMatrix<ValueType>* prolong) const;
+
         virtual bool
             AMGSmoothedAggregationProlongNnz(int64_t                      global_column_begin,
                                              int64_t                      global_column_end,
@@ -520,11 +654,98 @@ namespace rocalution
                                  BaseVector<int64_t>*         global_col);
 
     private:
+        // Drop the reference to a shared sparsity pattern, freeing it if this is the last one
+        void ReleaseStructure_(void);
+        // Release the compressed column indices (SpMVIndex_Compressed) after the sparsity
+        // pattern changed
+        void InvalidateSpMVStructure_(void) const;
+        // out = alpha * this * in + beta * out with the compressed column indices, built on
+        // first use, returns false if the structure does not benefit from the compression
+        bool SpMVCompressed_(ValueType                    alpha,
+                             const HostVector<ValueType>& in,
+                             ValueType                    beta,
+                             HostVector<ValueType>*       out) const;
+        // Give the matrix its own copy of a shared sparsity pattern before modifying it
+        void DetachStructure_(void);
+        // Give the matrix its own copy of external buffers (see AttachViewCSR()) before
+        // reallocating them
+        void DetachView_(void);
+
+        // Values of this = R * A * P for the known structure of this, restricted to the
+        // flagged rows if rows is not NULL
+        void NumericTripleMatMatMult_(const HostMatrixCSR<ValueType>& R,
+                                      const HostMatrixCSR<ValueType>& A,
+                                      const HostMatrixCSR<ValueType>& P,
+                                      const bool*                     rows);
+
+        // Level schedule of a triangular solve, rows of the same level are independent
+        struct LevelSchedule
+        {
+            int  nlevels;
+            int* level_offset;
+            int* level_row;
+        };
+
+        // Group the rows of the strictly lower (or upper) pattern by level
+        void BuildLevelSchedule_(const PtrType* row_offset,
+                                 const int*     col,
+                                 bool           lower,
+                                 LevelSchedule* schedule) const;
+        void ClearLevelSchedule_(LevelSchedule* schedule) const;
+
+        // Transposed strictly lower pattern of L, used by the L^T solve of LLSolve()
+        void BuildTransposedLower_(void);
+        void ClearTransposedLower_(void);
+
+        // Level scheduled triangular solves (OpenMP, one parallel loop per level)
+        void LevelLSolve_(const ValueType* in, ValueType* out, bool diag_unit) const;
+        void LevelUSolve_(const ValueType* in, ValueType* out, bool diag_unit) const;
+        void LevelLLSolve_(const ValueType* in, const ValueType* inv_diag, ValueType* out) const;
+
+        // Batched BiCGStab (basis == 0) or GMRES(basis)
+        bool BatchSolve_(int                          batch,
+                         int                          basis,
+                         const BaseVector<ValueType>& val,
+                         const BaseVector<ValueType>* inv_diag,
+                         const BaseVector<ValueType>* lu,
+                         const BaseVector<ValueType>& rhs,
+                         BaseVector<ValueType>*       x,
+                         double                       abs_tol,
+                         double                       rel_tol,
+                         int                          max_iter,
+                         int*                         iter,
+                         double*                      res) const;
+
         MatrixCSR<ValueType, int, PtrType> mat_;
 
+        // Number of matrices sharing row_offset and col (see ShareStructureFrom()), NULL if
+        // the pattern is not shared
+        mutable int* structure_ref_;
+
+        // True if the arrays are external buffers that are not freed by the matrix
+        bool view_;
+
+        // Column index storage of Apply() and ApplyAdd() (SpMVIndex), the base column of
+        // each row and the offsets of spmv_col_width_ bytes to it, built on first use and
+        // released by InvalidateSpMVStructure_() whenever the sparsity pattern changes
+        unsigned int  spmv_index_;
+        mutable int*  spmv_col_base_;
+        mutable char* spmv_col_off_;
+        mutable int   spmv_col_width_;
+
         bool L_diag_unit_;
         bool U_diag_unit_;
 
+        // Level schedules of the host triangular solves, built by the *Analyse() functions
+        LevelSchedule L_schedule_;
+        LevelSchedule U_schedule_;
+        LevelSchedule LT_schedule_;
+
+        // Transposed pattern of L, LT_pos_ points into the values of L
+        PtrType* LT_row_offset_;
+        int*     LT_col_;
+        PtrType* LT_pos_;
+
         // Matrix buffer (itcsrsv)
         size_t mat_buffer_size_;
         char*  mat_buffer_;
@@ -536,6 +757,8 @@ namespace rocalution
         friend class HostMatrixCOO<ValueType>;
         friend class HostMatrixDIA<ValueType>;
         friend class HostMatrixELL<ValueType>;
+        friend class HostMatrixSELL<ValueType>;
+        friend class HostMatrixVBR<ValueType>;
         friend class HostMatrixHYB<ValueType>;
         friend class HostMatrixDENSE<ValueType>;
         friend class HostMatrixMCSR<ValueType>;
@@ -589,6 +589,17 @@ namespace rocalution
         return true;
     }
 
+    template <typename ValueType>
+    void HostMatrixDENSE<ValueType>::LUAnalyse(void)
+    {
+        // The dense factors need no analysis
+    }
+
+    template <typename ValueType>
+    void HostMatrixDENSE<ValueType>::LUAnalyseClear(void)
+    {
+    }
+
     template <typename ValueType>
     bool HostMatrixDENSE<ValueType>::LUSolve(const BaseVector<ValueType>& in,
                                              BaseVector<ValueType>*       out) const
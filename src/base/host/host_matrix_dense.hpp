@@ -70,6 +70,8 @@ namespace rocalution
         virtual bool QRSolve(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
 
         virtual bool LUFactorize(void);
+        virtual void LUAnalyse(void);
+        virtual void LUAnalyseClear(void);
         virtual bool LUSolve(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
 
         virtual bool Invert(void);
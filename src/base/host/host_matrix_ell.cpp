@@ -29,6 +29,7 @@
 #include "host_conversion.hpp"
 #include "host_io.hpp"
 #include "host_matrix_csr.hpp"
+#include "host_sparse.hpp"
 #include "host_vector.hpp"
 
 #include <complex>
@@ -295,30 +296,15 @@ namespace rocalution
 
             _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int ai = 0; ai < this->nrow_; ++ai)
-            {
-                ValueType sum = static_cast<ValueType>(0);
-
-                for(int n = 0; n < this->mat_.max_row; ++n)
-                {
-                    int aj     = ELL_IND(ai, n, this->nrow_, this->mat_.max_row);
-                    int col_aj = this->mat_.col[aj];
-
-                    if(col_aj >= 0)
-                    {
-                        sum += this->mat_.val[aj] * cast_in->vec_[col_aj];
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-
-                cast_out->vec_[ai] = sum;
-            }
+            host_ellmv(this->nrow_,
+                       this->ncol_,
+                       this->mat_.max_row,
+                       this->mat_.col,
+                       this->mat_.val,
+                       static_cast<ValueType>(1),
+                       cast_in->vec_,
+                       false,
+                       cast_out->vec_);
         }
     }
 
@@ -342,26 +328,15 @@ namespace rocalution
 
             _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int ai = 0; ai < this->nrow_; ++ai)
-            {
-                for(int n = 0; n < this->mat_.max_row; ++n)
-                {
-                    int aj     = ELL_IND(ai, n, this->nrow_, this->mat_.max_row);
-                    int col_aj = this->mat_.col[aj];
-
-                    if(col_aj >= 0)
-                    {
-                        cast_out->vec_[ai] += scalar * this->mat_.val[aj] * cast_in->vec_[col_aj];
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-            }
+            host_ellmv(this->nrow_,
+                       this->ncol_,
+                       this->mat_.max_row,
+                       this->mat_.col,
+                       this->mat_.val,
+                       scalar,
+                       cast_in->vec_,
+                       true,
+                       cast_out->vec_);
         }
     }
 
@@ -29,6 +29,7 @@
 #include "host_conversion.hpp"
 #include "host_io.hpp"
 #include "host_matrix_csr.hpp"
+#include "host_sparse.hpp"
 #include "host_vector.hpp"
 
 #include <complex>
@@ -334,24 +335,15 @@ namespace rocalution
             // ELL
             if(this->ell_nnz_ > 0)
             {
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-                for(int ai = 0; ai < this->nrow_; ++ai)
-                {
-                    cast_out->vec_[ai] = static_cast<ValueType>(0);
-
-                    for(int n = 0; n < this->mat_.ELL.max_row; ++n)
-                    {
-                        int aj = ELL_IND(ai, n, this->nrow_, this->mat_.ELL.max_row);
-
-                        if((this->mat_.ELL.col[aj] >= 0) && (this->mat_.ELL.col[aj] < this->ncol_))
-                        {
-                            cast_out->vec_[ai]
-                                += this->mat_.ELL.val[aj] * cast_in->vec_[this->mat_.ELL.col[aj]];
-                        }
-                    }
-                }
+                host_ellmv(this->nrow_,
+                           this->ncol_,
+                           this->mat_.ELL.max_row,
+                           this->mat_.ELL.col,
+                           this->mat_.ELL.val,
+                           static_cast<ValueType>(1),
+                           cast_in->vec_,
+                           false,
+                           cast_out->vec_);
             }
 
             // COO
@@ -389,22 +381,15 @@ namespace rocalution
             // ELL
             if(this->ell_nnz_ > 0)
             {
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-                for(int ai = 0; ai < this->nrow_; ++ai)
-                {
-                    for(int n = 0; n < this->mat_.ELL.max_row; ++n)
-                    {
-                        int aj = ELL_IND(ai, n, this->nrow_, this->mat_.ELL.max_row);
-
-                        if((this->mat_.ELL.col[aj] >= 0) && (this->mat_.ELL.col[aj] < this->ncol_))
-                        {
-                            cast_out->vec_[ai] += scalar * this->mat_.ELL.val[aj]
-                                                  * cast_in->vec_[this->mat_.ELL.col[aj]];
-                        }
-                    }
-                }
+                host_ellmv(this->nrow_,
+                           this->ncol_,
+                           this->mat_.ELL.max_row,
+                           this->mat_.ELL.col,
+                           this->mat_.ELL.val,
+                           scalar,
+                           cast_in->vec_,
+                           true,
+                           cast_out->vec_);
             }
 
             // COO
@@ -0,0 +1,349 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "host_matrix_sell.hpp"
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/def.hpp"
+#include "../../utils/log.hpp"
+#include "../matrix_formats_ind.hpp"
+#include "host_conversion.hpp"
+#include "host_matrix_csr.hpp"
+#include "host_vector.hpp"
+
+#include <algorithm>
+#include <complex>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_set_num_threads(num) ;
+#endif
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    HostMatrixSELL<ValueType>::HostMatrixSELL()
+    {
+        // no default constructors
+        LOG_INFO("no default constructor");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    HostMatrixSELL<ValueType>::HostMatrixSELL(const Rocalution_Backend_Descriptor& local_backend)
+    {
+        log_debug(this, "HostMatrixSELL::HostMatrixSELL()", "constructor with local_backend");
+
+        this->mat_.slice_size   = _sell_slice_size;
+        this->mat_.nslice       = 0;
+        this->mat_.slice_offset = NULL;
+        this->mat_.perm         = NULL;
+        this->mat_.col          = NULL;
+        this->mat_.val          = NULL;
+
+        this->set_backend(local_backend);
+    }
+
+    template <typename ValueType>
+    HostMatrixSELL<ValueType>::~HostMatrixSELL()
+    {
+        log_debug(this, "HostMatrixSELL::~HostMatrixSELL()", "destructor");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    void HostMatrixSELL<ValueType>::Info(void) const
+    {
+        LOG_INFO("HostMatrixSELL<ValueType>"
+                 << " slice size=" << this->mat_.slice_size << " slices=" << this->mat_.nslice);
+    }
+
+    template <typename ValueType>
+    void HostMatrixSELL<ValueType>::Clear()
+    {
+        free_host(&this->mat_.slice_offset);
+        free_host(&this->mat_.perm);
+        free_host(&this->mat_.col);
+        free_host(&this->mat_.val);
+
+        this->mat_.nslice = 0;
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+        this->nnz_  = 0;
+    }
+
+    template <typename ValueType>
+    void HostMatrixSELL<ValueType>::AllocateSELL(int64_t nnz, int nrow, int ncol, int slice_size)
+    {
+        assert(nnz >= 0);
+        assert(ncol >= 0);
+        assert(nrow >= 0);
+        assert(slice_size > 0);
+        assert(nnz % slice_size == 0);
+
+        this->Clear();
+
+        this->mat_.slice_size = slice_size;
+        this->mat_.nslice     = (nrow + slice_size - 1) / slice_size;
+
+        allocate_host(this->mat_.nslice + 1, &this->mat_.slice_offset);
+        allocate_host(nrow, &this->mat_.perm);
+        allocate_host(nnz, &this->mat_.col);
+        allocate_host(nnz, &this->mat_.val);
+
+        set_to_zero_host(this->mat_.nslice + 1, this->mat_.slice_offset);
+        set_to_zero_host(nrow, this->mat_.perm);
+        set_to_zero_host(nnz, this->mat_.col);
+        set_to_zero_host(nnz, this->mat_.val);
+
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+        this->nnz_  = nnz;
+    }
+
+    template <typename ValueType>
+    void HostMatrixSELL<ValueType>::CopyFrom(const BaseMatrix<ValueType>& mat)
+    {
+        // copy only in the same format
+        assert(this->GetMatFormat() == mat.GetMatFormat());
+
+        if(const HostMatrixSELL<ValueType>* cast_mat
+           = dynamic_cast<const HostMatrixSELL<ValueType>*>(&mat))
+        {
+            if(this->nnz_ == 0)
+            {
+                this->AllocateSELL(
+                    cast_mat->nnz_, cast_mat->nrow_, cast_mat->ncol_, cast_mat->mat_.slice_size);
+            }
+
+            assert(this->nnz_ == cast_mat->nnz_);
+            assert(this->nrow_ == cast_mat->nrow_);
+            assert(this->ncol_ == cast_mat->ncol_);
+            assert(this->mat_.slice_size == cast_mat->mat_.slice_size);
+
+            copy_h2h(
+                this->mat_.nslice + 1, cast_mat->mat_.slice_offset, this->mat_.slice_offset);
+            copy_h2h(this->nrow_, cast_mat->mat_.perm, this->mat_.perm);
+            copy_h2h(this->nnz_, cast_mat->mat_.col, this->mat_.col);
+            copy_h2h(this->nnz_, cast_mat->mat_.val, this->mat_.val);
+        }
+        else
+        {
+            // Host matrix knows only host matrices
+            // -> dispatching
+            mat.CopyTo(this);
+        }
+    }
+
+    template <typename ValueType>
+    void HostMatrixSELL<ValueType>::CopyTo(BaseMatrix<ValueType>* mat) const
+    {
+        mat->CopyFrom(*this);
+    }
+
+    template <typename ValueType>
+    bool HostMatrixSELL<ValueType>::ConvertFrom(const BaseMatrix<ValueType>& mat)
+    {
+        this->Clear();
+
+        // Empty matrix
+        if(mat.GetNnz() == 0)
+        {
+            this->AllocateSELL(0, mat.GetM(), mat.GetN(), _sell_slice_size);
+
+            return true;
+        }
+
+        if(const HostMatrixSELL<ValueType>* cast_mat
+           = dynamic_cast<const HostMatrixSELL<ValueType>*>(&mat))
+        {
+            this->CopyFrom(*cast_mat);
+            return true;
+        }
+
+        if(const HostMatrixCSR<ValueType>* cast_mat
+           = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat))
+        {
+            this->Clear();
+            int64_t nnz = 0;
+
+            if(csr_to_sell(this->local_backend_.OpenMP_threads,
+                           cast_mat->nnz_,
+                           cast_mat->nrow_,
+                           cast_mat->ncol_,
+                           cast_mat->mat_,
+                           _sell_slice_size,
+                           _sell_sigma,
+                           &this->mat_,
+                           &nnz)
+               == true)
+            {
+                this->nrow_ = cast_mat->nrow_;
+                this->ncol_ = cast_mat->ncol_;
+                this->nnz_  = nnz;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename ValueType>
+    void HostMatrixSELL<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                          BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(in.GetSize() >= 0);
+            assert(out->GetSize() >= 0);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+            assert(this->mat_.slice_size <= _sell_slice_size);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+            int C = this->mat_.slice_size;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+            for(int s = 0; s < this->mat_.nslice; ++s)
+            {
+                PtrType offset = this->mat_.slice_offset[s];
+                PtrType width  = (this->mat_.slice_offset[s + 1] - offset) / C;
+
+                // The rows of a slice are processed in lockstep, such that each
+                // column of the slice is a contiguous, vectorizable load
+                ValueType sum[_sell_slice_size];
+
+                for(int r = 0; r < C; ++r)
+                {
+                    sum[r] = static_cast<ValueType>(0);
+                }
+
+                for(PtrType n = 0; n < width; ++n)
+                {
+                    const int*       col = this->mat_.col + SELL_IND(offset, 0, n, C);
+                    const ValueType* val = this->mat_.val + SELL_IND(offset, 0, n, C);
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                    for(int r = 0; r < C; ++r)
+                    {
+                        sum[r] += (col[r] >= 0) ? val[r] * cast_in->vec_[col[r]]
+                                                : static_cast<ValueType>(0);
+                    }
+                }
+
+                int nr = std::min(C, this->nrow_ - s * C);
+
+                for(int r = 0; r < nr; ++r)
+                {
+                    cast_out->vec_[this->mat_.perm[s * C + r]] = sum[r];
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HostMatrixSELL<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                             ValueType                    scalar,
+                                             BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(in.GetSize() >= 0);
+            assert(out->GetSize() >= 0);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+            assert(this->mat_.slice_size <= _sell_slice_size);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+            int C = this->mat_.slice_size;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+            for(int s = 0; s < this->mat_.nslice; ++s)
+            {
+                PtrType offset = this->mat_.slice_offset[s];
+                PtrType width  = (this->mat_.slice_offset[s + 1] - offset) / C;
+
+                ValueType sum[_sell_slice_size];
+
+                for(int r = 0; r < C; ++r)
+                {
+                    sum[r] = static_cast<ValueType>(0);
+                }
+
+                for(PtrType n = 0; n < width; ++n)
+                {
+                    const int*       col = this->mat_.col + SELL_IND(offset, 0, n, C);
+                    const ValueType* val = this->mat_.val + SELL_IND(offset, 0, n, C);
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                    for(int r = 0; r < C; ++r)
+                    {
+                        sum[r] += (col[r] >= 0) ? val[r] * cast_in->vec_[col[r]]
+                                                : static_cast<ValueType>(0);
+                    }
+                }
+
+                int nr = std::min(C, this->nrow_ - s * C);
+
+                for(int r = 0; r < nr; ++r)
+                {
+                    cast_out->vec_[this->mat_.perm[s * C + r]] += scalar * sum[r];
+                }
+            }
+        }
+    }
+
+    template class HostMatrixSELL<double>;
+    template class HostMatrixSELL<float>;
+#ifdef SUPPORT_COMPLEX
+    template class HostMatrixSELL<std::complex<double>>;
+    template class HostMatrixSELL<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,373 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "host_matrix_vbr.hpp"
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/def.hpp"
+#include "../../utils/log.hpp"
+#include "../matrix_formats_ind.hpp"
+#include "host_conversion.hpp"
+#include "host_matrix_csr.hpp"
+#include "host_vector.hpp"
+
+#include <complex>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_set_num_threads(num) ;
+#endif
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    HostMatrixVBR<ValueType>::HostMatrixVBR()
+    {
+        // no default constructors
+        LOG_INFO("no default constructor");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    HostMatrixVBR<ValueType>::HostMatrixVBR(const Rocalution_Backend_Descriptor& local_backend)
+    {
+        log_debug(this, "HostMatrixVBR::HostMatrixVBR()", "constructor with local_backend");
+
+        this->mat_.nrowb      = 0;
+        this->mat_.ncolb      = 0;
+        this->mat_.nnzb       = 0;
+        this->mat_.row_block  = NULL;
+        this->mat_.col_block  = NULL;
+        this->mat_.row_offset = NULL;
+        this->mat_.col        = NULL;
+        this->mat_.val_offset = NULL;
+        this->mat_.val        = NULL;
+
+        this->set_backend(local_backend);
+    }
+
+    template <typename ValueType>
+    HostMatrixVBR<ValueType>::~HostMatrixVBR()
+    {
+        log_debug(this, "HostMatrixVBR::~HostMatrixVBR()", "destructor");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    void HostMatrixVBR<ValueType>::Info(void) const
+    {
+        LOG_INFO("HostMatrixVBR<ValueType>"
+                 << " block rows=" << this->mat_.nrowb << " block cols=" << this->mat_.ncolb
+                 << " blocks=" << this->mat_.nnzb);
+    }
+
+    template <typename ValueType>
+    void HostMatrixVBR<ValueType>::Clear()
+    {
+        free_host(&this->mat_.row_block);
+        free_host(&this->mat_.col_block);
+        free_host(&this->mat_.row_offset);
+        free_host(&this->mat_.col);
+        free_host(&this->mat_.val_offset);
+        free_host(&this->mat_.val);
+
+        this->mat_.nrowb = 0;
+        this->mat_.ncolb = 0;
+        this->mat_.nnzb  = 0;
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+        this->nnz_  = 0;
+    }
+
+    template <typename ValueType>
+    void HostMatrixVBR<ValueType>::AllocateVBR(
+        int64_t nnz, int64_t nnzb, int nrowb, int ncolb, int nrow, int ncol)
+    {
+        assert(nnz >= 0);
+        assert(nnzb >= 0);
+        assert(nrowb >= 0);
+        assert(ncolb >= 0);
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+
+        this->Clear();
+
+        allocate_host(nrowb + 1, &this->mat_.row_block);
+        allocate_host(ncolb + 1, &this->mat_.col_block);
+        allocate_host(nrowb + 1, &this->mat_.row_offset);
+        allocate_host(nnzb, &this->mat_.col);
+        allocate_host(nnzb + 1, &this->mat_.val_offset);
+        allocate_host(nnz, &this->mat_.val);
+
+        set_to_zero_host(nrowb + 1, this->mat_.row_block);
+        set_to_zero_host(ncolb + 1, this->mat_.col_block);
+        set_to_zero_host(nrowb + 1, this->mat_.row_offset);
+        set_to_zero_host(nnzb, this->mat_.col);
+        set_to_zero_host(nnzb + 1, this->mat_.val_offset);
+        set_to_zero_host(nnz, this->mat_.val);
+
+        this->mat_.nrowb = nrowb;
+        this->mat_.ncolb = ncolb;
+        this->mat_.nnzb  = nnzb;
+
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+        this->nnz_  = nnz;
+    }
+
+    template <typename ValueType>
+    void HostMatrixVBR<ValueType>::CopyFrom(const BaseMatrix<ValueType>& mat)
+    {
+        // copy only in the same format
+        assert(this->GetMatFormat() == mat.GetMatFormat());
+
+        if(const HostMatrixVBR<ValueType>* cast_mat
+           = dynamic_cast<const HostMatrixVBR<ValueType>*>(&mat))
+        {
+            if(this->nnz_ == 0)
+            {
+                this->AllocateVBR(cast_mat->nnz_,
+                                  cast_mat->mat_.nnzb,
+                                  cast_mat->mat_.nrowb,
+                                  cast_mat->mat_.ncolb,
+                                  cast_mat->nrow_,
+                                  cast_mat->ncol_);
+            }
+
+            assert(this->nnz_ == cast_mat->nnz_);
+            assert(this->nrow_ == cast_mat->nrow_);
+            assert(this->ncol_ == cast_mat->ncol_);
+            assert(this->mat_.nnzb == cast_mat->mat_.nnzb);
+            assert(this->mat_.nrowb == cast_mat->mat_.nrowb);
+            assert(this->mat_.ncolb == cast_mat->mat_.ncolb);
+
+            copy_h2h(this->mat_.nrowb + 1, cast_mat->mat_.row_block, this->mat_.row_block);
+            copy_h2h(this->mat_.ncolb + 1, cast_mat->mat_.col_block, this->mat_.col_block);
+            copy_h2h(this->mat_.nrowb + 1, cast_mat->mat_.row_offset, this->mat_.row_offset);
+            copy_h2h(this->mat_.nnzb, cast_mat->mat_.col, this->mat_.col);
+            copy_h2h(this->mat_.nnzb + 1, cast_mat->mat_.val_offset, this->mat_.val_offset);
+            copy_h2h(this->nnz_, cast_mat->mat_.val, this->mat_.val);
+        }
+        else
+        {
+            // Host matrix knows only host matrices
+            // -> dispatching
+            mat.CopyTo(this);
+        }
+    }
+
+    template <typename ValueType>
+    void HostMatrixVBR<ValueType>::CopyTo(BaseMatrix<ValueType>* mat) const
+    {
+        mat->CopyFrom(*this);
+    }
+
+    template <typename ValueType>
+    bool HostMatrixVBR<ValueType>::ConvertFrom(const BaseMatrix<ValueType>& mat)
+    {
+        this->Clear();
+
+        // Empty matrix
+        if(mat.GetNnz() == 0)
+        {
+            this->AllocateVBR(0, 0, 0, 0, mat.GetM(), mat.GetN());
+
+            return true;
+        }
+
+        if(const HostMatrixVBR<ValueType>* cast_mat
+           = dynamic_cast<const HostMatrixVBR<ValueType>*>(&mat))
+        {
+            this->CopyFrom(*cast_mat);
+            return true;
+        }
+
+        if(const HostMatrixCSR<ValueType>* cast_mat
+           = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat))
+        {
+            this->Clear();
+            int64_t nnz = 0;
+
+            if(csr_to_vbr(this->local_backend_.OpenMP_threads,
+                          cast_mat->nnz_,
+                          cast_mat->nrow_,
+                          cast_mat->ncol_,
+                          cast_mat->mat_,
+                          _vbr_max_blockdim,
+                          &this->mat_,
+                          &nnz)
+               == true)
+            {
+                this->nrow_ = cast_mat->nrow_;
+                this->ncol_ = cast_mat->ncol_;
+                this->nnz_  = nnz;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename ValueType>
+    void HostMatrixVBR<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                         BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(in.GetSize() >= 0);
+            assert(out->GetSize() >= 0);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+            for(int i = 0; i < this->mat_.nrowb; ++i)
+            {
+                int first = this->mat_.row_block[i];
+                int rbs   = this->mat_.row_block[i + 1] - first;
+
+                assert(rbs <= _vbr_max_blockdim);
+
+                // The rows of a block row are accumulated in lockstep, such that the
+                // columns of the column-major blocks are contiguous, vectorizable loads
+                ValueType sum[_vbr_max_blockdim];
+
+                for(int bi = 0; bi < rbs; ++bi)
+                {
+                    sum[bi] = static_cast<ValueType>(0);
+                }
+
+                for(PtrType k = this->mat_.row_offset[i]; k < this->mat_.row_offset[i + 1]; ++k)
+                {
+                    int col = this->mat_.col[k];
+                    int cbs = this->mat_.col_block[col + 1] - this->mat_.col_block[col];
+
+                    const ValueType* x   = cast_in->vec_ + this->mat_.col_block[col];
+                    const ValueType* val = this->mat_.val + this->mat_.val_offset[k];
+
+                    for(int bj = 0; bj < cbs; ++bj)
+                    {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                        for(int bi = 0; bi < rbs; ++bi)
+                        {
+                            sum[bi] += val[VBR_IND(0, bi, bj, rbs)] * x[bj];
+                        }
+                    }
+                }
+
+                for(int bi = 0; bi < rbs; ++bi)
+                {
+                    cast_out->vec_[first + bi] = sum[bi];
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HostMatrixVBR<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                            ValueType                    scalar,
+                                            BaseVector<ValueType>*       out) const
+    {
+        if(this->nnz_ > 0)
+        {
+            assert(in.GetSize() >= 0);
+            assert(out->GetSize() >= 0);
+            assert(in.GetSize() == this->ncol_);
+            assert(out->GetSize() == this->nrow_);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+            for(int i = 0; i < this->mat_.nrowb; ++i)
+            {
+                int first = this->mat_.row_block[i];
+                int rbs   = this->mat_.row_block[i + 1] - first;
+
+                assert(rbs <= _vbr_max_blockdim);
+
+                ValueType sum[_vbr_max_blockdim];
+
+                for(int bi = 0; bi < rbs; ++bi)
+                {
+                    sum[bi] = static_cast<ValueType>(0);
+                }
+
+                for(PtrType k = this->mat_.row_offset[i]; k < this->mat_.row_offset[i + 1]; ++k)
+                {
+                    int col = this->mat_.col[k];
+                    int cbs = this->mat_.col_block[col + 1] - this->mat_.col_block[col];
+
+                    const ValueType* x   = cast_in->vec_ + this->mat_.col_block[col];
+                    const ValueType* val = this->mat_.val + this->mat_.val_offset[k];
+
+                    for(int bj = 0; bj < cbs; ++bj)
+                    {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                        for(int bi = 0; bi < rbs; ++bi)
+                        {
+                            sum[bi] += val[VBR_IND(0, bi, bj, rbs)] * x[bj];
+                        }
+                    }
+                }
+
+                for(int bi = 0; bi < rbs; ++bi)
+                {
+                    cast_out->vec_[first + bi] += scalar * sum[bi];
+                }
+            }
+        }
+    }
+
+    template class HostMatrixVBR<double>;
+    template class HostMatrixVBR<float>;
+#ifdef SUPPORT_COMPLEX
+    template class HostMatrixVBR<std::complex<double>>;
+    template class HostMatrixVBR<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -25,6 +25,7 @@
 #include "../../utils/def.hpp"
 #include "../../utils/log.hpp"
 #include "../../utils/math_functions.hpp"
+#include "../matrix_formats_ind.hpp"
 
 #include "rocalution/utils/types.hpp"
 
@@ -523,6 +524,136 @@ namespace rocalution
         return true;
     }
 
+    // Number of rows of a row block of the ELL and DIA kernels. The rows of a block are
+    // processed in lockstep, such that the entries of an ELL column or a diagonal, which
+    // are stored contiguously for consecutive rows, are vectorizable loads.
+    static const int host_row_block = 64;
+
+    template <typename T>
+    void host_ellmv(int        nrow,
+                    int        ncol,
+                    int        max_row,
+                    const int* ell_col,
+                    const T*   ell_val,
+                    T          alpha,
+                    const T*   x,
+                    bool       add,
+                    T*         y)
+    {
+        int nblock = (nrow + host_row_block - 1) / host_row_block;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int b = 0; b < nblock; ++b)
+        {
+            int row_begin = b * host_row_block;
+            int nr        = std::min(host_row_block, nrow - row_begin);
+
+            T sum[host_row_block];
+
+            for(int r = 0; r < nr; ++r)
+            {
+                sum[r] = static_cast<T>(0);
+            }
+
+            for(int n = 0; n < max_row; ++n)
+            {
+                const int* col = ell_col + ELL_IND(row_begin, n, nrow, max_row);
+                const T*   val = ell_val + ELL_IND(row_begin, n, nrow, max_row);
+
+                // Padded entries have a negative column index
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                for(int r = 0; r < nr; ++r)
+                {
+                    sum[r] += (col[r] >= 0 && col[r] < ncol) ? val[r] * x[col[r]]
+                                                             : static_cast<T>(0);
+                }
+            }
+
+            if(add == true)
+            {
+                for(int r = 0; r < nr; ++r)
+                {
+                    y[row_begin + r] += alpha * sum[r];
+                }
+            }
+            else
+            {
+                for(int r = 0; r < nr; ++r)
+                {
+                    y[row_begin + r] = sum[r];
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void host_diamv(int        nrow,
+                    int        ncol,
+                    int        num_diag,
+                    const int* dia_offset,
+                    const T*   dia_val,
+                    T          alpha,
+                    const T*   x,
+                    bool       add,
+                    T*         y)
+    {
+        int nblock = (nrow + host_row_block - 1) / host_row_block;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int b = 0; b < nblock; ++b)
+        {
+            int row_begin = b * host_row_block;
+            int row_end   = std::min(row_begin + host_row_block, nrow);
+
+            T sum[host_row_block];
+
+            for(int i = row_begin; i < row_end; ++i)
+            {
+                sum[i - row_begin] = static_cast<T>(0);
+            }
+
+            for(int j = 0; j < num_diag; ++j)
+            {
+                int offset = dia_offset[j];
+
+                // Rows of the block, whose entry of the diagonal is inside the matrix
+                int begin = std::max(row_begin, -offset);
+                int end   = std::min(row_end, ncol - offset);
+
+                const T* val = dia_val + DIA_IND(0, j, nrow, num_diag);
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                for(int i = begin; i < end; ++i)
+                {
+                    sum[i - row_begin] += val[i] * x[i + offset];
+                }
+            }
+
+            if(add == true)
+            {
+                for(int i = row_begin; i < row_end; ++i)
+                {
+                    y[i] += alpha * sum[i - row_begin];
+                }
+            }
+            else
+            {
+                for(int i = row_begin; i < row_end; ++i)
+                {
+                    y[i] = sum[i - row_begin];
+                }
+            }
+        }
+    }
+
 #define INSTANTIATE_T(TTYPE)                                                                         \
     template bool host_csritsv_buffer_size<PtrType, int, TTYPE>(host_sparse_operation   trans,       \
                                                                 int                     m,           \
@@ -551,7 +682,27 @@ namespace rocalution
                                                           const TTYPE*             x,                \
                                                           TTYPE*                   y,                \
                                                           void*                    temp_buffer,      \
-                                                          int*                     zero_pivot)
+                                                          int*                     zero_pivot);      \
+                                                                                                     \
+    template void host_ellmv<TTYPE>(int          nrow,                                               \
+                                    int          ncol,                                               \
+                                    int          max_row,                                            \
+                                    const int*   ell_col,                                            \
+                                    const TTYPE* ell_val,                                            \
+                                    TTYPE        alpha,                                              \
+                                    const TTYPE* x,                                                  \
+                                    bool         add,                                                \
+                                    TTYPE*       y);                                                 \
+                                                                                                     \
+    template void host_diamv<TTYPE>(int          nrow,                                               \
+                                    int          ncol,                                               \
+                                    int          num_diag,                                           \
+                                    const int*   dia_offset,                                         \
+                                    const TTYPE* dia_val,                                            \
+                                    TTYPE        alpha,                                              \
+                                    const TTYPE* x,                                                  \
+                                    bool         add,                                                \
+                                    TTYPE*       y)
 
     INSTANTIATE_T(float);
     INSTANTIATE_T(double);
@@ -87,6 +87,30 @@ namespace rocalution
                             T*                         y,
                             void*                      temp_buffer,
                             J*                         zero_pivot);
+
+    // y = A x (add == false) or y = y + alpha A x (add == true) for an ELL matrix
+    template <typename T>
+    void host_ellmv(int        nrow,
+                    int        ncol,
+                    int        max_row,
+                    const int* ell_col,
+                    const T*   ell_val,
+                    T          alpha,
+                    const T*   x,
+                    bool       add,
+                    T*         y);
+
+    // y = A x (add == false) or y = y + alpha A x (add == true) for a DIA matrix
+    template <typename T>
+    void host_diamv(int        nrow,
+                    int        ncol,
+                    int        num_diag,
+                    const int* dia_offset,
+                    const T*   dia_val,
+                    T          alpha,
+                    const T*   x,
+                    bool       add,
+                    T*         y);
 } // namespace rocalution
 
 #endif // ROCALUTION_HOST_HOST_SPARSE_HPP_
@@ -0,0 +1,199 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "host_stencil_laplace3d.hpp"
+#include "../../utils/def.hpp"
+#include "../../utils/log.hpp"
+#include "../stencil_types.hpp"
+#include "host_vector.hpp"
+
+#include <complex>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_set_num_threads(num) ;
+#endif
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    HostStencilLaplace3D<ValueType>::HostStencilLaplace3D()
+    {
+        // no default constructors
+        LOG_INFO("no default constructor");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    HostStencilLaplace3D<ValueType>::HostStencilLaplace3D(
+        const Rocalution_Backend_Descriptor& local_backend, unsigned int type)
+    {
+        log_debug(this,
+                  "HostStencilLaplace3D::HostStencilLaplace3D()",
+                  "constructor with local_backend",
+                  type);
+
+        assert(type == Laplace3D || type == Laplace3D27);
+
+        this->set_backend(local_backend);
+
+        this->ndim_ = 3;
+        this->type_ = type;
+    }
+
+    template <typename ValueType>
+    HostStencilLaplace3D<ValueType>::~HostStencilLaplace3D()
+    {
+        log_debug(this, "HostStencilLaplace3D::~HostStencilLaplace3D()", "destructor");
+    }
+
+    template <typename ValueType>
+    void HostStencilLaplace3D<ValueType>::Info(void) const
+    {
+        LOG_INFO("Stencil 3D Laplace " << this->GetNnz() << "-point (Host) size=" << this->size_
+                                       << " dim=" << this->GetNDim());
+    }
+
+    template <typename ValueType>
+    int64_t HostStencilLaplace3D<ValueType>::GetNnz(void) const
+    {
+        return (this->type_ == Laplace3D) ? 7 : 27;
+    }
+
+    template <typename ValueType>
+    void HostStencilLaplace3D<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                                BaseVector<ValueType>*       out) const
+    {
+        this->Apply_(in, static_cast<ValueType>(1), false, out);
+    }
+
+    template <typename ValueType>
+    void HostStencilLaplace3D<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                                   ValueType                    scalar,
+                                                   BaseVector<ValueType>*       out) const
+    {
+        this->Apply_(in, scalar, true, out);
+    }
+
+    template <typename ValueType>
+    void HostStencilLaplace3D<ValueType>::Apply_(const BaseVector<ValueType>& in,
+                                                 ValueType                    scalar,
+                                                 bool                         add,
+                                                 BaseVector<ValueType>*       out) const
+    {
+        if((this->ndim_ > 0) && (this->size_ > 0))
+        {
+            int nrow = this->GetM();
+            assert(in.GetSize() == nrow);
+            assert(out->GetSize() == nrow);
+
+            const HostVector<ValueType>* cast_in  = dynamic_cast<const HostVector<ValueType>*>(&in);
+            HostVector<ValueType>*       cast_out = dynamic_cast<HostVector<ValueType>*>(out);
+
+            assert(cast_in != NULL);
+            assert(cast_out != NULL);
+
+            _set_omp_backend_threads(this->local_backend_, nrow);
+
+            int n  = this->size_;
+            int nn = n * n;
+
+            // Points outside of the grid are zero (homogeneous Dirichlet boundary)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int iz = 0; iz < n; ++iz)
+            {
+                for(int iy = 0; iy < n; ++iy)
+                {
+                    for(int ix = 0; ix < n; ++ix)
+                    {
+                        int idx = iz * nn + iy * n + ix;
+
+                        ValueType sum = static_cast<ValueType>(0);
+                        ValueType val;
+
+                        if(this->type_ == Laplace3D)
+                        {
+                            sum += (iz > 0) ? cast_in->vec_[idx - nn] : static_cast<ValueType>(0);
+                            sum += (iy > 0) ? cast_in->vec_[idx - n] : static_cast<ValueType>(0);
+                            sum += (ix > 0) ? cast_in->vec_[idx - 1] : static_cast<ValueType>(0);
+                            sum += (ix < n - 1) ? cast_in->vec_[idx + 1]
+                                                : static_cast<ValueType>(0);
+                            sum += (iy < n - 1) ? cast_in->vec_[idx + n]
+                                                : static_cast<ValueType>(0);
+                            sum += (iz < n - 1) ? cast_in->vec_[idx + nn]
+                                                : static_cast<ValueType>(0);
+
+                            val = static_cast<ValueType>(6) * cast_in->vec_[idx] - sum;
+                        }
+                        else
+                        {
+                            // All 27 points, the center is included in sum
+                            for(int sz = -1; sz <= 1; ++sz)
+                            {
+                                if(iz + sz < 0 || iz + sz >= n)
+                                {
+                                    continue;
+                                }
+
+                                for(int sy = -1; sy <= 1; ++sy)
+                                {
+                                    if(iy + sy < 0 || iy + sy >= n)
+                                    {
+                                        continue;
+                                    }
+
+                                    for(int sx = -1; sx <= 1; ++sx)
+                                    {
+                                        if(ix + sx < 0 || ix + sx >= n)
+                                        {
+                                            continue;
+                                        }
+
+                                        sum += cast_in->vec_[idx + sz * nn + sy * n + sx];
+                                    }
+                                }
+                            }
+
+                            val = static_cast<ValueType>(27) * cast_in->vec_[idx] - sum;
+                        }
+
+                        cast_out->vec_[idx]
+                            = add ? cast_out->vec_[idx] + scalar * val : scalar * val;
+                    }
+                }
+            }
+        }
+    }
+
+    template class HostStencilLaplace3D<double>;
+    template class HostStencilLaplace3D<float>;
+#ifdef SUPPORT_COMPLEX
+    template class HostStencilLaplace3D<std::complex<double>>;
+    template class HostStencilLaplace3D<std::complex<float>>;
+#endif
+
+} // namespace rocalution
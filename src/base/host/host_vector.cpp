@@ -40,6 +40,7 @@
 #include <numeric>
 #include <typeindex>
 #include <typeinfo>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -53,6 +54,290 @@
 
 namespace rocalution
 {
+    // Block size of the blocked reductions. The partial sums of the blocks are accumulated
+    // separately, which bounds the rounding error growth like a two level pairwise
+    // summation.
+    static const int64_t _host_reduction_block = 1024;
+
+    // Size in bytes above which write-only outputs bypass the caches with streaming stores
+    static const int64_t _host_streaming_bytes = int64_t(1) << 25;
+
+    // Dot product of a block of two arrays
+    template <typename ValueType>
+    static inline ValueType host_block_dot(int64_t n, const ValueType* x, const ValueType* y)
+    {
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(int64_t i = 0; i < n; ++i)
+        {
+            sum += x[i] * y[i];
+        }
+
+        return sum;
+    }
+
+    // The real types are reduced in SIMD lanes
+    static inline float host_block_dot(int64_t n, const float* x, const float* y)
+    {
+        float sum = 0.0f;
+
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : sum)
+#endif
+        for(int64_t i = 0; i < n; ++i)
+        {
+            sum += x[i] * y[i];
+        }
+
+        return sum;
+    }
+
+    static inline double host_block_dot(int64_t n, const double* x, const double* y)
+    {
+        double sum = 0.0;
+
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : sum)
+#endif
+        for(int64_t i = 0; i < n; ++i)
+        {
+            sum += x[i] * y[i];
+        }
+
+        return sum;
+    }
+
+    // Mixed precision dot product of a block, the single precision values are widened
+    static inline double host_block_dot(int64_t n, const double* x, const float* y)
+    {
+        double sum = 0.0;
+
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : sum)
+#endif
+        for(int64_t i = 0; i < n; ++i)
+        {
+            sum += x[i] * static_cast<double>(y[i]);
+        }
+
+        return sum;
+    }
+
+    // Reproducible sum of the blocks of [0, n). The blocks have a fixed size, each block
+    // sum block(first, len) is evaluated by a single thread, and the block sums are added
+    // pairwise in a fixed order, such that the result does not depend on the number of
+    // threads
+    template <typename ValueType, typename BlockSum>
+    static ValueType host_reproducible_sum(int64_t n, BlockSum block)
+    {
+        int64_t nblocks = (n + _host_reduction_block - 1) / _host_reduction_block;
+
+        if(nblocks == 0)
+        {
+            return static_cast<ValueType>(0);
+        }
+
+        ValueType* partial = NULL;
+        allocate_host(nblocks, &partial);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int64_t b = 0; b < nblocks; ++b)
+        {
+            int64_t first = b * _host_reduction_block;
+
+            partial[b] = block(first, std::min(_host_reduction_block, n - first));
+        }
+
+        for(int64_t stride = 1; stride < nblocks; stride *= 2)
+        {
+            for(int64_t b = 0; b + stride < nblocks; b += 2 * stride)
+            {
+                partial[b] += partial[b + stride];
+            }
+        }
+
+        ValueType sum = partial[0];
+
+        free_host(&partial);
+
+        return sum;
+    }
+
+    // Reproducible dot product of two complex arrays, conjugating x if CONJ is true
+    template <bool CONJ, typename ValueType>
+    static std::complex<ValueType> host_reproducible_cdot(int64_t                        n,
+                                                          const std::complex<ValueType>* x,
+                                                          const std::complex<ValueType>* y)
+    {
+        return host_reproducible_sum<std::complex<ValueType>>(
+            n, [x, y](int64_t first, int64_t len) {
+                std::complex<ValueType> sum(0, 0);
+
+                for(int64_t i = first; i < first + len; ++i)
+                {
+                    sum += (CONJ ? std::conj(x[i]) : x[i]) * y[i];
+                }
+
+                return sum;
+            });
+    }
+
+    // Reproducible sum of an array, of the absolute values if ABS is true. The real and
+    // imaginary parts of complex values are summed separately.
+    template <bool ABS, typename ValueType>
+    static ValueType host_reproducible_reduce(int64_t n, const ValueType* x)
+    {
+        return host_reproducible_sum<ValueType>(n, [x](int64_t first, int64_t len) {
+            ValueType sum = static_cast<ValueType>(0);
+
+            for(int64_t i = first; i < first + len; ++i)
+            {
+                sum += ABS ? static_cast<ValueType>(std::abs(x[i])) : x[i];
+            }
+
+            return sum;
+        });
+    }
+
+    template <bool ABS, typename ValueType>
+    static std::complex<ValueType> host_reproducible_reduce(int64_t                        n,
+                                                            const std::complex<ValueType>* x)
+    {
+        return host_reproducible_sum<std::complex<ValueType>>(
+            n, [x](int64_t first, int64_t len) {
+                ValueType real = static_cast<ValueType>(0);
+                ValueType imag = static_cast<ValueType>(0);
+
+                for(int64_t i = first; i < first + len; ++i)
+                {
+                    real += ABS ? std::abs(x[i].real()) : x[i].real();
+                    imag += ABS ? std::abs(x[i].imag()) : x[i].imag();
+                }
+
+                return std::complex<ValueType>(real, imag);
+            });
+    }
+
+    // Blocked dot product of two arrays
+    template <typename ValueType, typename YType>
+    static ValueType host_dot(int64_t n, const ValueType* x, const YType* y)
+    {
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_sum<ValueType>(n, [x, y](int64_t first, int64_t len) {
+                return host_block_dot(len, x + first, y + first);
+            });
+        }
+
+        int64_t nblocks = (n + _host_reduction_block - 1) / _host_reduction_block;
+
+        ValueType dot = static_cast<ValueType>(0);
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : dot)
+#endif
+        for(int64_t b = 0; b < nblocks; ++b)
+        {
+            int64_t first = b * _host_reduction_block;
+
+            dot += host_block_dot(std::min(_host_reduction_block, n - first), x + first, y + first);
+        }
+
+        return dot;
+    }
+
+    // Block size of the vector expression evaluation, the evaluation stack of a block stays
+    // in the L1 cache
+    static const int64_t _host_expression_block = 256;
+
+    // Evaluate a vector expression program for the elements [first, first + len) on the
+    // stack, the result is left in stack[0]
+    template <typename ValueType>
+    static void host_expression_block(const VectorExpressionProgram<ValueType>& program,
+                                      const ValueType* const*                   vec,
+                                      int64_t                                   first,
+                                      int64_t                                   len,
+                                      ValueType (*stack)[_host_expression_block])
+    {
+        int top = -1;
+
+        for(int k = 0; k < program.num_ops; ++k)
+        {
+            switch(program.op[k])
+            {
+            case VExprVector:
+            {
+                const ValueType* v = vec[program.arg[k]] + first;
+                ValueType*       a = stack[++top];
+
+                for(int64_t i = 0; i < len; ++i)
+                {
+                    a[i] = v[i];
+                }
+                break;
+            }
+            case VExprScalar:
+            {
+                ValueType  s = program.scalar[program.arg[k]];
+                ValueType* a = stack[++top];
+
+                for(int64_t i = 0; i < len; ++i)
+                {
+                    a[i] = s;
+                }
+                break;
+            }
+            case VExprNeg:
+            {
+                ValueType* a = stack[top];
+
+                for(int64_t i = 0; i < len; ++i)
+                {
+                    a[i] = -a[i];
+                }
+                break;
+            }
+            default:
+            {
+                ValueType*       a = stack[--top];
+                const ValueType* b = stack[top + 1];
+
+                switch(program.op[k])
+                {
+                case VExprAdd:
+                    for(int64_t i = 0; i < len; ++i)
+                    {
+                        a[i] += b[i];
+                    }
+                    break;
+                case VExprSub:
+                    for(int64_t i = 0; i < len; ++i)
+                    {
+                        a[i] -= b[i];
+                    }
+                    break;
+                case VExprMul:
+                    for(int64_t i = 0; i < len; ++i)
+                    {
+                        a[i] *= b[i];
+                    }
+                    break;
+                case VExprDiv:
+                    for(int64_t i = 0; i < len; ++i)
+                    {
+                        a[i] /= b[i];
+                    }
+                    break;
+                }
+                break;
+            }
+            }
+        }
+
+        assert(top == 0);
+    }
 
     template <typename ValueType>
     HostVector<ValueType>::HostVector()
@@ -67,7 +352,8 @@ namespace rocalution
     {
         log_debug(this, "HostVector::HostVector()", "constructor with local_backend");
 
-        this->vec_ = NULL;
+        this->vec_  = NULL;
+        this->view_ = false;
         this->set_backend(local_backend);
     }
 
@@ -179,6 +465,21 @@ namespace rocalution
     {
         assert(this->size_ >= 0);
 
+        // A view hands out a copy, the external buffer is not ours to give away
+        if(this->view_ == true)
+        {
+            ValueType* vec = NULL;
+
+            if(this->size_ > 0)
+            {
+                allocate_host(this->size_, &vec);
+                copy_h2h(this->size_, this->vec_, vec);
+            }
+
+            this->vec_  = vec;
+            this->view_ = false;
+        }
+
         // see free_host function for details
         *ptr       = this->vec_;
         this->vec_ = NULL;
@@ -186,6 +487,29 @@ namespace rocalution
         this->size_ = 0;
     }
 
+    template <typename ValueType>
+    void HostVector<ValueType>::AttachView(ValueType* ptr, int64_t size)
+    {
+        assert(size >= 0);
+
+        this->Clear();
+
+        if(size > 0)
+        {
+            assert(ptr != NULL);
+        }
+
+        this->vec_  = ptr;
+        this->size_ = size;
+        this->view_ = true;
+    }
+
+    template <typename ValueType>
+    ValueType* HostVector<ValueType>::GetDataPtr(void) const
+    {
+        return this->vec_;
+    }
+
     template <typename ValueType>
     void HostVector<ValueType>::CopyFromData(const ValueType* data)
     {
@@ -217,9 +541,20 @@ namespace rocalution
     {
         if(this->size_ > 0)
         {
-            free_host(&this->vec_);
+            if(this->view_ == true)
+            {
+                // External buffers are left to their owner
+                this->vec_ = NULL;
+            }
+            else
+            {
+                free_host(&this->vec_);
+            }
+
             this->size_ = 0;
         }
+
+        this->view_ = false;
     }
 
     template <typename ValueType>
@@ -248,6 +583,20 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void HostVector<ValueType>::CopyFromAsync(const BaseVector<ValueType>& vec)
+    {
+        if(dynamic_cast<const HostVector<ValueType>*>(&vec) != NULL)
+        {
+            this->CopyFrom(vec);
+        }
+        else
+        {
+            // non-host type, the accelerator starts the transfer to the host
+            vec.CopyToAsync(this);
+        }
+    }
+
     template <typename ValueType>
     void HostVector<ValueType>::CopyTo(BaseVector<ValueType>* vec) const
     {
@@ -274,7 +623,7 @@ namespace rocalution
 
             assert(cast_vec->size_ == this->size_);
 
-            _set_omp_backend_threads(this->local_backend_, this->size_);
+            _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -311,7 +660,7 @@ namespace rocalution
 
             assert(cast_vec->size_ == this->size_);
 
-            _set_omp_backend_threads(this->local_backend_, this->size_);
+            _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -331,7 +680,7 @@ namespace rocalution
     template <typename ValueType>
     void HostVector<ValueType>::Zeros(void)
     {
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -345,7 +694,7 @@ namespace rocalution
     template <typename ValueType>
     void HostVector<ValueType>::Ones(void)
     {
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -359,7 +708,7 @@ namespace rocalution
     template <typename ValueType>
     void HostVector<ValueType>::SetValues(ValueType val)
     {
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -639,10 +988,10 @@ namespace rocalution
         assert(cast_x != NULL);
         assert(this->size_ == cast_x->size_);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for simd
 #endif
         for(int64_t i = 0; i < this->size_; ++i)
         {
@@ -658,10 +1007,10 @@ namespace rocalution
         assert(cast_x != NULL);
         assert(this->size_ == cast_x->size_);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for simd
 #endif
         for(int64_t i = 0; i < this->size_; ++i)
         {
@@ -679,10 +1028,10 @@ namespace rocalution
         assert(cast_x != NULL);
         assert(this->size_ == cast_x->size_);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for simd
 #endif
         for(int64_t i = 0; i < this->size_; ++i)
         {
@@ -734,10 +1083,10 @@ namespace rocalution
         assert(this->size_ == cast_x->size_);
         assert(this->size_ == cast_y->size_);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for simd
 #endif
         for(int64_t i = 0; i < this->size_; ++i)
         {
@@ -749,10 +1098,10 @@ namespace rocalution
     template <typename ValueType>
     void HostVector<ValueType>::Scale(ValueType alpha)
     {
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for simd
 #endif
         for(int64_t i = 0; i < this->size_; ++i)
         {
@@ -775,19 +1124,9 @@ namespace rocalution
         assert(cast_x != NULL);
         assert(this->size_ == cast_x->size_);
 
-        ValueType dot = static_cast<ValueType>(0);
-
-        _set_omp_backend_threads(this->local_backend_, this->size_);
-
-#ifdef _OPENMP
-#pragma omp parallel for reduction(+ : dot)
-#endif
-        for(int64_t i = 0; i < this->size_; ++i)
-        {
-            dot += this->vec_[i] * cast_x->vec_[i];
-        }
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
-        return dot;
+        return host_dot(this->size_, this->vec_, cast_x->vec_);
     }
 
     template <>
@@ -803,7 +1142,12 @@ namespace rocalution
         float dot_real = 0.0f;
         float dot_imag = 0.0f;
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_cdot<true>(this->size_, this->vec_, cast_x->vec_);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+ : dot_real, dot_imag)
@@ -832,7 +1176,12 @@ namespace rocalution
         double dot_real = 0.0;
         double dot_imag = 0.0;
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_cdot<true>(this->size_, this->vec_, cast_x->vec_);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+ : dot_real, dot_imag)
@@ -867,7 +1216,12 @@ namespace rocalution
         float dot_real = 0.0f;
         float dot_imag = 0.0f;
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_cdot<false>(this->size_, this->vec_, cast_x->vec_);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+ : dot_real, dot_imag)
@@ -896,7 +1250,12 @@ namespace rocalution
         double dot_real = 0.0;
         double dot_imag = 0.0;
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_cdot<false>(this->size_, this->vec_, cast_x->vec_);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+ : dot_real, dot_imag)
@@ -917,7 +1276,12 @@ namespace rocalution
     {
         ValueType asum = static_cast<ValueType>(0);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_reduce<true>(this->size_, this->vec_);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+ : asum)
@@ -936,7 +1300,12 @@ namespace rocalution
         float asum_real = 0.0f;
         float asum_imag = 0.0f;
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_reduce<true>(this->size_, this->vec_);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+ : asum_real, asum_imag)
@@ -956,7 +1325,12 @@ namespace rocalution
         double asum_real = 0.0;
         double asum_imag = 0.0;
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_reduce<true>(this->size_, this->vec_);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+ : asum_real, asum_imag)
@@ -984,7 +1358,7 @@ namespace rocalution
 
         value = static_cast<ValueType>(0);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1016,73 +1390,698 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    ValueType HostVector<ValueType>::Norm(void) const
+    void HostVector<ValueType>::MultiAddScale(int                                 count,
+                                              const BaseVector<ValueType>* const* x,
+                                              const ValueType*                    alpha)
     {
-        ValueType norm2 = static_cast<ValueType>(0);
+        assert(count > 0);
+        assert(x != NULL);
+        assert(alpha != NULL);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        std::vector<const ValueType*> vec(count);
 
-#ifdef _OPENMP
-#pragma omp parallel for reduction(+ : norm2)
-#endif
-        for(int64_t i = 0; i < this->size_; ++i)
+        for(int k = 0; k < count; ++k)
         {
-            norm2 += this->vec_[i] * this->vec_[i];
-        }
+            const HostVector<ValueType>* cast_x = dynamic_cast<const HostVector<ValueType>*>(x[k]);
 
-        return std::sqrt(norm2);
-    }
+            assert(cast_x != NULL);
+            assert(this->size_ == cast_x->size_);
 
-    template <>
-    std::complex<float> HostVector<std::complex<float>>::Norm(void) const
-    {
-        float norm2 = 0.0f;
+            vec[k] = cast_x->vec_;
+        }
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
+        // Single pass over this vector, accumulating all updates at once
 #ifdef _OPENMP
-#pragma omp parallel for reduction(+ : norm2)
+#pragma omp parallel for
 #endif
         for(int64_t i = 0; i < this->size_; ++i)
         {
-            norm2 += this->vec_[i].real() * this->vec_[i].real()
-                     + this->vec_[i].imag() * this->vec_[i].imag();
-        }
+            ValueType val = this->vec_[i];
 
-        std::complex<float> res(sqrt(norm2), 0.0f);
+            for(int k = 0; k < count; ++k)
+            {
+                val += alpha[k] * vec[k][i];
+            }
 
-        return res;
+            this->vec_[i] = val;
+        }
     }
 
     template <>
-    std::complex<double> HostVector<std::complex<double>>::Norm(void) const
+    void HostVector<bool>::MultiAddScale(int                            count,
+                                         const BaseVector<bool>* const* x,
+                                         const bool*                    alpha)
     {
-        double norm2 = 0.0;
+        LOG_INFO("What is void HostVector<ValueType>::MultiAddScale(...)?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+    template <typename ValueType>
+    void HostVector<ValueType>::MultiDot(int                                 count,
+                                         const BaseVector<ValueType>* const* x,
+                                         ValueType*                          res) const
+    {
+        assert(count > 0);
+        assert(x != NULL);
+        assert(res != NULL);
 
-#ifdef _OPENMP
-#pragma omp parallel for reduction(+ : norm2)
-#endif
-        for(int64_t i = 0; i < this->size_; ++i)
+        std::vector<const ValueType*> vec(count);
+
+        for(int k = 0; k < count; ++k)
         {
-            norm2 += this->vec_[i].real() * this->vec_[i].real()
-                     + this->vec_[i].imag() * this->vec_[i].imag();
-        }
+            const HostVector<ValueType>* cast_x = dynamic_cast<const HostVector<ValueType>*>(x[k]);
 
-        std::complex<double> res(sqrt(norm2), 0.0);
+            assert(cast_x != NULL);
+            assert(this->size_ == cast_x->size_);
 
-        return res;
-    }
+            vec[k] = cast_x->vec_;
+            res[k] = static_cast<ValueType>(0);
+        }
 
-    template <>
-    int HostVector<int>::Norm(void) const
-    {
-        LOG_INFO("What is int HostVector<ValueType>::Norm(void) const?");
-        FATAL_ERROR(__FILE__, __LINE__);
-    }
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
-    template <>
+        // Single pass over this vector, accumulating all dot products at once
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ValueType* part = NULL;
+            allocate_host(count, &part);
+            set_to_zero_host(count, part);
+
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+            for(int64_t i = 0; i < this->size_; ++i)
+            {
+                ValueType val = this->vec_[i];
+
+                for(int k = 0; k < count; ++k)
+                {
+                    part[k] += rocalution_conj(vec[k][i]) * val;
+                }
+            }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            {
+                for(int k = 0; k < count; ++k)
+                {
+                    res[k] += part[k];
+                }
+            }
+
+            free_host(&part);
+        }
+    }
+
+    template <typename ValueType>
+    ValueType HostVector<ValueType>::AddScaleDot(const BaseVector<ValueType>& x,
+                                                 ValueType                    alpha,
+                                                 const BaseVector<ValueType>& y)
+    {
+        const HostVector<ValueType>* cast_x = dynamic_cast<const HostVector<ValueType>*>(&x);
+        const HostVector<ValueType>* cast_y = dynamic_cast<const HostVector<ValueType>*>(&y);
+
+        assert(cast_x != NULL);
+        assert(cast_y != NULL);
+        assert(this->size_ == cast_x->size_);
+        assert(this->size_ == cast_y->size_);
+
+        ValueType dot = static_cast<ValueType>(0);
+
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        // Update and dot product in a single pass, y is read after the update such that
+        // y may be this vector
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ValueType part = static_cast<ValueType>(0);
+
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+            for(int64_t i = 0; i < this->size_; ++i)
+            {
+                ValueType val = this->vec_[i] + alpha * cast_x->vec_[i];
+
+                this->vec_[i] = val;
+                part += rocalution_conj(val) * cast_y->vec_[i];
+            }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            {
+                dot += part;
+            }
+        }
+
+        return dot;
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::DualDot(const BaseVector<ValueType>& x,
+                                        const BaseVector<ValueType>& y,
+                                        ValueType*                   res) const
+    {
+        assert(res != NULL);
+
+        const HostVector<ValueType>* cast_x = dynamic_cast<const HostVector<ValueType>*>(&x);
+        const HostVector<ValueType>* cast_y = dynamic_cast<const HostVector<ValueType>*>(&y);
+
+        assert(cast_x != NULL);
+        assert(cast_y != NULL);
+        assert(this->size_ == cast_x->size_);
+        assert(this->size_ == cast_y->size_);
+
+        res[0] = static_cast<ValueType>(0);
+        res[1] = static_cast<ValueType>(0);
+
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ValueType part_x = static_cast<ValueType>(0);
+            ValueType part_y = static_cast<ValueType>(0);
+
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+            for(int64_t i = 0; i < this->size_; ++i)
+            {
+                ValueType val = rocalution_conj(this->vec_[i]);
+
+                part_x += val * cast_x->vec_[i];
+                part_y += val * cast_y->vec_[i];
+            }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            {
+                res[0] += part_x;
+                res[1] += part_y;
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::DotToScalar(const BaseVector<ValueType>& x,
+                                            bool                         conj,
+                                            BaseVector<ValueType>*       res,
+                                            int64_t                      index) const
+    {
+        HostVector<ValueType>* cast_res = dynamic_cast<HostVector<ValueType>*>(res);
+
+        assert(cast_res != NULL);
+        assert(index >= 0);
+        assert(index < cast_res->size_);
+
+        cast_res->vec_[index] = (conj == true) ? this->Dot(x) : this->DotNonConj(x);
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::NormToScalar(BaseVector<ValueType>* res, int64_t index) const
+    {
+        HostVector<ValueType>* cast_res = dynamic_cast<HostVector<ValueType>*>(res);
+
+        assert(cast_res != NULL);
+        assert(index >= 0);
+        assert(index < cast_res->size_);
+
+        cast_res->vec_[index] = this->Norm();
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::AddScaleRatio(const BaseVector<ValueType>& x,
+                                              ValueType                    factor,
+                                              const BaseVector<ValueType>& scalars,
+                                              int64_t                      num,
+                                              int64_t                      den)
+    {
+        const HostVector<ValueType>* cast_s = dynamic_cast<const HostVector<ValueType>*>(&scalars);
+
+        assert(cast_s != NULL);
+        assert(num >= 0 && num < cast_s->size_);
+        assert(den >= 0 && den < cast_s->size_);
+
+        this->AddScale(x, factor * cast_s->vec_[num] / cast_s->vec_[den]);
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::ScaleRatioAdd(const BaseVector<ValueType>& scalars,
+                                              int64_t                      num,
+                                              int64_t                      den,
+                                              const BaseVector<ValueType>& x)
+    {
+        const HostVector<ValueType>* cast_s = dynamic_cast<const HostVector<ValueType>*>(&scalars);
+
+        assert(cast_s != NULL);
+        assert(num >= 0 && num < cast_s->size_);
+        assert(den >= 0 && den < cast_s->size_);
+
+        this->ScaleAdd(cast_s->vec_[num] / cast_s->vec_[den], x);
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::Evaluate(const VectorExpressionProgram<ValueType>& program,
+                                         const BaseVector<ValueType>* const*       vec)
+    {
+        assert(program.num_ops > 0);
+        assert(program.num_vectors <= _vector_expression_max_vectors);
+        assert(program.depth <= _vector_expression_max_stack);
+
+        const ValueType* v[_vector_expression_max_vectors];
+
+        for(int k = 0; k < program.num_vectors; ++k)
+        {
+            const HostVector<ValueType>* cast_v
+                = dynamic_cast<const HostVector<ValueType>*>(vec[k]);
+
+            assert(cast_v != NULL);
+            assert(cast_v->size_ == this->size_);
+
+            v[k] = cast_v->vec_;
+        }
+
+        int64_t nblocks = (this->size_ + _host_expression_block - 1) / _host_expression_block;
+
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        // Each block is evaluated completely before it is written, such that this can be
+        // an operand of the expression
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ValueType stack[_vector_expression_max_stack][_host_expression_block];
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int64_t b = 0; b < nblocks; ++b)
+            {
+                int64_t first = b * _host_expression_block;
+                int64_t len   = std::min(_host_expression_block, this->size_ - first);
+
+                host_expression_block(program, v, first, len, stack);
+
+                for(int64_t i = 0; i < len; ++i)
+                {
+                    this->vec_[first + i] = stack[0][i];
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    ValueType HostVector<ValueType>::EvaluateSum(const VectorExpressionProgram<ValueType>& program,
+                                                 const BaseVector<ValueType>* const* vec) const
+    {
+        assert(program.num_ops > 0);
+        assert(program.num_vectors <= _vector_expression_max_vectors);
+        assert(program.depth <= _vector_expression_max_stack);
+
+        const ValueType* v[_vector_expression_max_vectors];
+
+        for(int k = 0; k < program.num_vectors; ++k)
+        {
+            const HostVector<ValueType>* cast_v
+                = dynamic_cast<const HostVector<ValueType>*>(vec[k]);
+
+            assert(cast_v != NULL);
+            assert(cast_v->size_ == this->size_);
+
+            v[k] = cast_v->vec_;
+        }
+
+        int64_t nblocks = (this->size_ + _host_expression_block - 1) / _host_expression_block;
+
+        ValueType sum = static_cast<ValueType>(0);
+
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ValueType stack[_vector_expression_max_stack][_host_expression_block];
+            ValueType partial = static_cast<ValueType>(0);
+
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+            for(int64_t b = 0; b < nblocks; ++b)
+            {
+                int64_t first = b * _host_expression_block;
+                int64_t len   = std::min(_host_expression_block, this->size_ - first);
+
+                host_expression_block(program, v, first, len, stack);
+
+                ValueType block = static_cast<ValueType>(0);
+
+                for(int64_t i = 0; i < len; ++i)
+                {
+                    block += stack[0][i];
+                }
+
+                partial += block;
+            }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            sum += partial;
+        }
+
+        return sum;
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::BlockDot(int64_t                      nrow,
+                                         int                          ncol_x,
+                                         int                          ncol,
+                                         const BaseVector<ValueType>& x,
+                                         ValueType*                   res) const
+    {
+        assert(nrow >= 0);
+        assert(ncol_x >= 0);
+        assert(ncol >= 0);
+        assert(res != NULL);
+
+        const HostVector<ValueType>* cast_x = dynamic_cast<const HostVector<ValueType>*>(&x);
+
+        assert(cast_x != NULL);
+        assert(this->size_ == nrow * ncol);
+        assert(cast_x->size_ == nrow * ncol_x);
+
+        int nres = ncol_x * ncol;
+
+        set_to_zero_host(nres, res);
+
+        // Rows are processed in chunks, such that every column is traversed contiguously
+        // while all partial results stay in cache
+        const int64_t chunk  = 256;
+        int64_t       nchunk = (nrow + chunk - 1) / chunk;
+
+        _set_omp_backend_threads(this->local_backend_, nrow);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ValueType* part = NULL;
+            allocate_host(nres, &part);
+            set_to_zero_host(nres, part);
+
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+            for(int64_t c = 0; c < nchunk; ++c)
+            {
+                int64_t beg = c * chunk;
+                int64_t end = std::min(beg + chunk, nrow);
+
+                for(int j = 0; j < ncol; ++j)
+                {
+                    const ValueType* y = this->vec_ + j * nrow;
+
+                    for(int k = 0; k < ncol_x; ++k)
+                    {
+                        const ValueType* xk  = cast_x->vec_ + k * nrow;
+                        ValueType        sum = static_cast<ValueType>(0);
+
+                        for(int64_t i = beg; i < end; ++i)
+                        {
+                            sum += rocalution_conj(xk[i]) * y[i];
+                        }
+
+                        part[k + j * ncol_x] += sum;
+                    }
+                }
+            }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            {
+                for(int k = 0; k < nres; ++k)
+                {
+                    res[k] += part[k];
+                }
+            }
+
+            free_host(&part);
+        }
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::BlockScaleAddProduct(int64_t                      nrow,
+                                                     int                          ncol_x,
+                                                     int                          ncol,
+                                                     ValueType                    alpha,
+                                                     const BaseVector<ValueType>& x,
+                                                     const ValueType*             C,
+                                                     ValueType                    beta)
+    {
+        assert(nrow >= 0);
+        assert(ncol_x >= 0);
+        assert(ncol >= 0);
+        assert(C != NULL);
+
+        const HostVector<ValueType>* cast_x = dynamic_cast<const HostVector<ValueType>*>(&x);
+
+        assert(cast_x != NULL);
+        assert(this->size_ == nrow * ncol);
+        assert(cast_x->size_ == nrow * ncol_x);
+
+        // Each chunk of rows of x * C is computed into a buffer before the same rows of
+        // this are written, which makes the update safe if x and this are the same block
+        const int64_t chunk  = 256;
+        int64_t       nchunk = (nrow + chunk - 1) / chunk;
+
+        _set_omp_backend_threads(this->local_backend_, nrow);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ValueType* tmp = NULL;
+            allocate_host(chunk * ncol, &tmp);
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int64_t c = 0; c < nchunk; ++c)
+            {
+                int64_t beg = c * chunk;
+                int64_t len = std::min(chunk, nrow - beg);
+
+                for(int j = 0; j < ncol; ++j)
+                {
+                    ValueType* t = tmp + j * chunk;
+
+                    for(int64_t i = 0; i < len; ++i)
+                    {
+                        t[i] = static_cast<ValueType>(0);
+                    }
+
+                    for(int k = 0; k < ncol_x; ++k)
+                    {
+                        const ValueType* xk  = cast_x->vec_ + k * nrow + beg;
+                        ValueType        ckj = C[k + j * ncol_x];
+
+                        for(int64_t i = 0; i < len; ++i)
+                        {
+                            t[i] += xk[i] * ckj;
+                        }
+                    }
+                }
+
+                for(int j = 0; j < ncol; ++j)
+                {
+                    const ValueType* t = tmp + j * chunk;
+                    ValueType*       y = this->vec_ + j * nrow + beg;
+
+                    if(alpha == static_cast<ValueType>(0))
+                    {
+                        for(int64_t i = 0; i < len; ++i)
+                        {
+                            y[i] = beta * t[i];
+                        }
+                    }
+                    else
+                    {
+                        for(int64_t i = 0; i < len; ++i)
+                        {
+                            y[i] = alpha * y[i] + beta * t[i];
+                        }
+                    }
+                }
+            }
+
+            free_host(&tmp);
+        }
+    }
+
+    template <>
+    void HostVector<bool>::BlockDot(
+        int64_t nrow, int ncol_x, int ncol, const BaseVector<bool>& x, bool* res) const
+    {
+        LOG_INFO("What is void HostVector<ValueType>::BlockDot(...) const?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HostVector<bool>::Evaluate(const VectorExpressionProgram<bool>& program,
+                                    const BaseVector<bool>* const*       vec)
+    {
+        LOG_INFO("What is void HostVector<ValueType>::Evaluate(...)?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    bool HostVector<bool>::EvaluateSum(const VectorExpressionProgram<bool>& program,
+                                       const BaseVector<bool>* const*       vec) const
+    {
+        LOG_INFO("What is bool HostVector<ValueType>::EvaluateSum(...) const?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HostVector<bool>::BlockScaleAddProduct(int64_t                 nrow,
+                                                int                     ncol_x,
+                                                int                     ncol,
+                                                bool                    alpha,
+                                                const BaseVector<bool>& x,
+                                                const bool*             C,
+                                                bool                    beta)
+    {
+        LOG_INFO("What is void HostVector<ValueType>::BlockScaleAddProduct(...)?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::BlockPointWiseMult(int64_t                      nrow,
+                                                   int                          ncol,
+                                                   const BaseVector<ValueType>& x)
+    {
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+
+        const HostVector<ValueType>* cast_x = dynamic_cast<const HostVector<ValueType>*>(&x);
+
+        assert(cast_x != NULL);
+        assert(cast_x->size_ == nrow);
+        assert(this->size_ == nrow * ncol);
+
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            ValueType d = cast_x->vec_[i];
+
+            for(int j = 0; j < ncol; ++j)
+            {
+                this->vec_[j * nrow + i] *= d;
+            }
+        }
+    }
+
+    template <>
+    void HostVector<bool>::BlockPointWiseMult(int64_t                 nrow,
+                                              int                     ncol,
+                                              const BaseVector<bool>& x)
+    {
+        LOG_INFO("What is void HostVector<ValueType>::BlockPointWiseMult(...)?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    ValueType HostVector<ValueType>::Norm(void) const
+    {
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        return std::sqrt(host_dot(this->size_, this->vec_, this->vec_));
+    }
+
+    template <>
+    std::complex<float> HostVector<std::complex<float>>::Norm(void) const
+    {
+        float norm2 = 0.0f;
+
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            std::complex<float> norm2
+                = host_reproducible_cdot<true>(this->size_, this->vec_, this->vec_);
+
+            return std::complex<float>(std::sqrt(norm2.real()), 0);
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : norm2)
+#endif
+        for(int64_t i = 0; i < this->size_; ++i)
+        {
+            norm2 += this->vec_[i].real() * this->vec_[i].real()
+                     + this->vec_[i].imag() * this->vec_[i].imag();
+        }
+
+        std::complex<float> res(sqrt(norm2), 0.0f);
+
+        return res;
+    }
+
+    template <>
+    std::complex<double> HostVector<std::complex<double>>::Norm(void) const
+    {
+        double norm2 = 0.0;
+
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            std::complex<double> norm2
+                = host_reproducible_cdot<true>(this->size_, this->vec_, this->vec_);
+
+            return std::complex<double>(std::sqrt(norm2.real()), 0);
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : norm2)
+#endif
+        for(int64_t i = 0; i < this->size_; ++i)
+        {
+            norm2 += this->vec_[i].real() * this->vec_[i].real()
+                     + this->vec_[i].imag() * this->vec_[i].imag();
+        }
+
+        std::complex<double> res(sqrt(norm2), 0.0);
+
+        return res;
+    }
+
+    template <>
+    int HostVector<int>::Norm(void) const
+    {
+        LOG_INFO("What is int HostVector<ValueType>::Norm(void) const?");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
     int64_t HostVector<int64_t>::Norm(void) const
     {
         LOG_INFO("What is int64_t HostVector<ValueType>::Norm(void) const?");
@@ -1101,7 +2100,12 @@ namespace rocalution
     {
         ValueType reduce = static_cast<ValueType>(0);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_reduce<false>(this->size_, this->vec_);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+ : reduce)
@@ -1120,7 +2124,12 @@ namespace rocalution
         float reduce_real = 0.0f;
         float reduce_imag = 0.0f;
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_reduce<false>(this->size_, this->vec_);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+ : reduce_real, reduce_imag)
@@ -1140,7 +2149,12 @@ namespace rocalution
         double reduce_real = 0.0;
         double reduce_imag = 0.0;
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            return host_reproducible_reduce<false>(this->size_, this->vec_);
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for reduction(+ : reduce_real, reduce_imag)
@@ -1235,10 +2249,10 @@ namespace rocalution
         assert(cast_x != NULL);
         assert(this->size_ == cast_x->size_);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for simd
 #endif
         for(int64_t i = 0; i < this->size_; ++i)
         {
@@ -1265,14 +2279,33 @@ namespace rocalution
         assert(this->size_ == cast_x->size_);
         assert(this->size_ == cast_y->size_);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        int64_t          size = this->size_;
+        ValueType*       out  = this->vec_;
+        const ValueType* in_x = cast_x->vec_;
+        const ValueType* in_y = cast_y->vec_;
+
+#if defined(_OPENMP) && _OPENMP >= 201811
+        // The output is write-only, large outputs bypass the caches
+        if(size * static_cast<int64_t>(sizeof(ValueType)) > _host_streaming_bytes)
+        {
+#pragma omp parallel for simd nontemporal(out)
+            for(int64_t i = 0; i < size; ++i)
+            {
+                out[i] = in_y[i] * in_x[i];
+            }
+
+            return;
+        }
+#endif
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for simd
 #endif
-        for(int64_t i = 0; i < this->size_; ++i)
+        for(int64_t i = 0; i < size; ++i)
         {
-            this->vec_[i] = cast_y->vec_[i] * cast_x->vec_[i];
+            out[i] = in_y[i] * in_x[i];
         }
     }
 
@@ -1300,7 +2333,7 @@ namespace rocalution
         assert(src_offset + size <= cast_src->size_);
         assert(dst_offset + size <= this->size_);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1311,6 +2344,22 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void HostVector<ValueType>::SwapData_(HostVector<ValueType>* vec)
+    {
+        assert(vec != NULL);
+        assert(vec->size_ == this->size_);
+
+        if(this->view_ == true)
+        {
+            copy_h2h(this->size_, vec->vec_, this->vec_);
+        }
+        else
+        {
+            std::swap(this->vec_, vec->vec_);
+        }
+    }
+
     template <typename ValueType>
     void HostVector<ValueType>::Permute(const BaseVector<int>& permutation)
     {
@@ -1319,11 +2368,11 @@ namespace rocalution
         assert(cast_perm != NULL);
         assert(this->size_ == cast_perm->size_);
 
+        // The permuted values are written into a new buffer, that replaces the old one
         HostVector<ValueType> vec_tmp(this->local_backend_);
         vec_tmp.Allocate(this->size_);
-        vec_tmp.CopyFrom(*this);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1332,8 +2381,10 @@ namespace rocalution
         {
             assert_dbg(cast_perm->vec_[i] >= 0);
             assert_dbg(cast_perm->vec_[i] < this->size_);
-            this->vec_[cast_perm->vec_[i]] = vec_tmp.vec_[i];
+            vec_tmp.vec_[cast_perm->vec_[i]] = this->vec_[i];
         }
+
+        this->SwapData_(&vec_tmp);
     }
 
     template <typename ValueType>
@@ -1344,11 +2395,11 @@ namespace rocalution
         assert(cast_perm != NULL);
         assert(this->size_ == cast_perm->size_);
 
+        // The permuted values are written into a new buffer, that replaces the old one
         HostVector<ValueType> vec_tmp(this->local_backend_);
         vec_tmp.Allocate(this->size_);
-        vec_tmp.CopyFrom(*this);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1357,8 +2408,10 @@ namespace rocalution
         {
             assert_dbg(cast_perm->vec_[i] >= 0);
             assert_dbg(cast_perm->vec_[i] < this->size_);
-            this->vec_[i] = vec_tmp.vec_[cast_perm->vec_[i]];
+            vec_tmp.vec_[i] = this->vec_[cast_perm->vec_[i]];
         }
+
+        this->SwapData_(&vec_tmp);
     }
 
     template <typename ValueType>
@@ -1375,7 +2428,7 @@ namespace rocalution
         assert(cast_vec->size_ == this->size_);
         assert(cast_perm->size_ == this->size_);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1400,7 +2453,7 @@ namespace rocalution
         assert(cast_vec->size_ == this->size_);
         assert(cast_perm->size_ == this->size_);
 
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1450,6 +2503,9 @@ namespace rocalution
         assert(cast_vec != NULL);
         assert(cast_map->size_ == this->size_);
 
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for(int64_t i = 0; i < this->size_; ++i)
         {
             if(cast_map->vec_[i] != -1)
@@ -1487,6 +2543,139 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void HostVector<ValueType>::GetIndexValuesFloat(const BaseVector<int>& index,
+                                                    BaseVector<float>*     values) const
+    {
+        LOG_INFO("Mixed precision for non-complex to complex casting is not allowed");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HostVector<double>::GetIndexValuesFloat(const BaseVector<int>& index,
+                                                 BaseVector<float>*     values) const
+    {
+        assert(values != NULL);
+
+        const HostVector<int>* cast_idx = dynamic_cast<const HostVector<int>*>(&index);
+        HostVector<float>*     cast_vec = dynamic_cast<HostVector<float>*>(values);
+
+        assert(cast_idx != NULL);
+        assert(cast_vec != NULL);
+        assert(cast_vec->size_ == cast_idx->size_);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < cast_idx->size_; ++i)
+        {
+            cast_vec->vec_[i] = static_cast<float>(this->vec_[cast_idx->vec_[i]]);
+        }
+    }
+
+    template <>
+    void HostVector<float>::GetIndexValuesFloat(const BaseVector<int>& index,
+                                                BaseVector<float>*     values) const
+    {
+        this->GetIndexValues(index, values);
+    }
+
+    template <typename ValueType>
+    ValueType HostVector<ValueType>::DotFloat(const BaseVector<float>& x) const
+    {
+        LOG_INFO("Mixed precision for non-complex to complex casting is not allowed");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    double HostVector<double>::DotFloat(const BaseVector<float>& x) const
+    {
+        const HostVector<float>* cast_x = dynamic_cast<const HostVector<float>*>(&x);
+
+        assert(cast_x != NULL);
+        assert(this->size_ == cast_x->size_);
+
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+        return host_dot(this->size_, this->vec_, cast_x->vec_);
+    }
+
+    template <>
+    float HostVector<float>::DotFloat(const BaseVector<float>& x) const
+    {
+        return this->Dot(x);
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::AddScaleFloat(const BaseVector<float>& x, ValueType alpha)
+    {
+        LOG_INFO("Mixed precision for non-complex to complex casting is not allowed");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HostVector<double>::AddScaleFloat(const BaseVector<float>& x, double alpha)
+    {
+        const HostVector<float>* cast_x = dynamic_cast<const HostVector<float>*>(&x);
+
+        assert(cast_x != NULL);
+        assert(this->size_ == cast_x->size_);
+
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd
+#endif
+        for(int64_t i = 0; i < this->size_; ++i)
+        {
+            this->vec_[i] += alpha * static_cast<double>(cast_x->vec_[i]);
+        }
+    }
+
+    template <>
+    void HostVector<float>::AddScaleFloat(const BaseVector<float>& x, float alpha)
+    {
+        this->AddScale(x, alpha);
+    }
+
+    template <typename ValueType>
+    void HostVector<ValueType>::ScaleCopyToFloat(ValueType alpha, BaseVector<float>* vec)
+    {
+        LOG_INFO("Mixed precision for non-complex to complex casting is not allowed");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <>
+    void HostVector<double>::ScaleCopyToFloat(double alpha, BaseVector<float>* vec)
+    {
+        assert(vec != NULL);
+
+        HostVector<float>* cast_vec = dynamic_cast<HostVector<float>*>(vec);
+
+        assert(cast_vec != NULL);
+        assert(this->size_ == cast_vec->size_);
+
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd
+#endif
+        for(int64_t i = 0; i < this->size_; ++i)
+        {
+            this->vec_[i] *= alpha;
+            cast_vec->vec_[i] = static_cast<float>(this->vec_[i]);
+        }
+    }
+
+    template <>
+    void HostVector<float>::ScaleCopyToFloat(float alpha, BaseVector<float>* vec)
+    {
+        assert(vec != NULL);
+
+        this->Scale(alpha);
+        vec->CopyFrom(*this);
+    }
+
     template <typename ValueType>
     void HostVector<ValueType>::SetIndexValues(const BaseVector<int>&       index,
                                                const BaseVector<ValueType>& values)
@@ -1679,7 +2868,7 @@ namespace rocalution
     template <typename ValueType>
     void HostVector<ValueType>::Power(double power)
     {
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1693,7 +2882,7 @@ namespace rocalution
     template <>
     void HostVector<std::complex<float>>::Power(double power)
     {
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1707,7 +2896,7 @@ namespace rocalution
     template <>
     void HostVector<int>::Power(double power)
     {
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1727,7 +2916,7 @@ namespace rocalution
     template <>
     void HostVector<int64_t>::Power(double power)
     {
-        _set_omp_backend_threads(this->local_backend_, this->size_);
+        _set_omp_backend_threads(this->local_backend_, this->size_, OMP_OP_VECTOR);
 
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1801,6 +2990,32 @@ namespace rocalution
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
+    template <typename ValueType>
+    void HostVector<ValueType>::Unique(BaseVector<ValueType>* unique) const
+    {
+        assert(unique != NULL);
+
+        HostVector<ValueType>* cast_uniq = dynamic_cast<HostVector<ValueType>*>(unique);
+
+        assert(cast_uniq != NULL);
+
+        cast_uniq->Clear();
+
+        if(this->size_ > 0)
+        {
+            ValueType* tmp = NULL;
+            allocate_host(this->size_, &tmp);
+
+            int64_t nuniq = std::unique_copy(this->vec_, this->vec_ + this->size_, tmp) - tmp;
+
+            cast_uniq->Allocate(nuniq);
+
+            copy_h2h(nuniq, tmp, cast_uniq->vec_);
+
+            free_host(&tmp);
+        }
+    }
+
     template class HostVector<bool>;
     template class HostVector<double>;
     template class HostVector<float>;
@@ -50,6 +50,8 @@ namespace rocalution
         virtual void Allocate(int64_t n);
         virtual void SetDataPtr(ValueType** ptr, int64_t size);
         virtual void LeaveDataPtr(ValueType** ptr);
+        virtual void AttachView(ValueType* ptr, int64_t size);
+        virtual ValueType* GetDataPtr(void) const;
         virtual void Clear(void);
         virtual void Zeros(void);
         virtual void Ones(void);
@@ -58,6 +60,7 @@ namespace rocalution
         virtual void SetRandomNormal(unsigned long long seed, ValueType mean, ValueType var);
 
         virtual void CopyFrom(const BaseVector<ValueType>& vec);
+        virtual void CopyFromAsync(const BaseVector<ValueType>& vec);
         virtual void CopyFromFloat(const BaseVector<float>& vec);
         virtual void CopyFromDouble(const BaseVector<double>& vec);
         virtual void CopyTo(BaseVector<ValueType>* vec) const;
@@ -116,6 +119,58 @@ namespace rocalution
         virtual ValueType Dot(const BaseVector<ValueType>& x) const;
         // this^T x
         virtual ValueType DotNonConj(const BaseVector<ValueType>& x) const;
+        // res[k] = x[k]^T this, k = 0, ..., count - 1
+        virtual void
+            MultiDot(int count, const BaseVector<ValueType>* const* x, ValueType* res) const;
+        // this = this + sum_k alpha[k] * x[k], k = 0, ..., count - 1
+        virtual void MultiAddScale(int                                 count,
+                                   const BaseVector<ValueType>* const* x,
+                                   const ValueType*                    alpha);
+        // this = this + alpha * x, return this^H y
+        virtual ValueType AddScaleDot(const BaseVector<ValueType>& x,
+                                      ValueType                    alpha,
+                                      const BaseVector<ValueType>& y);
+        // res[0] = this^H x, res[1] = this^H y
+        virtual void DualDot(const BaseVector<ValueType>& x,
+                             const BaseVector<ValueType>& y,
+                             ValueType*                   res) const;
+        // res[index] = this^H x (this^T x if conj is false), kept on the backend
+        virtual void DotToScalar(const BaseVector<ValueType>& x,
+                                 bool                         conj,
+                                 BaseVector<ValueType>*       res,
+                                 int64_t                      index) const;
+        // res[index] = ||this||_2, kept on the backend
+        virtual void NormToScalar(BaseVector<ValueType>* res, int64_t index) const;
+        // this = this + factor * scalars[num] / scalars[den] * x
+        virtual void AddScaleRatio(const BaseVector<ValueType>& x,
+                                   ValueType                    factor,
+                                   const BaseVector<ValueType>& scalars,
+                                   int64_t                      num,
+                                   int64_t                      den);
+        // this = scalars[num] / scalars[den] * this + x
+        virtual void ScaleRatioAdd(const BaseVector<ValueType>& scalars,
+                                   int64_t                      num,
+                                   int64_t                      den,
+                                   const BaseVector<ValueType>& x);
+        // this = program(vec), element-wise in a single pass
+        virtual void Evaluate(const VectorExpressionProgram<ValueType>& program,
+                              const BaseVector<ValueType>* const*       vec);
+        // sum(program(vec))
+        virtual ValueType EvaluateSum(const VectorExpressionProgram<ValueType>& program,
+                                      const BaseVector<ValueType>* const*       vec) const;
+        virtual void BlockDot(int64_t                      nrow,
+                              int                          ncol_x,
+                              int                          ncol,
+                              const BaseVector<ValueType>& x,
+                              ValueType*                   res) const;
+        virtual void BlockScaleAddProduct(int64_t                      nrow,
+                                          int                          ncol_x,
+                                          int                          ncol,
+                                          ValueType                    alpha,
+                                          const BaseVector<ValueType>& x,
+                                          const ValueType*             C,
+                                          ValueType                    beta);
+        virtual void BlockPointWiseMult(int64_t nrow, int ncol, const BaseVector<ValueType>& x);
         // srqt(this^T this)
         virtual ValueType Norm(void) const;
         // reduce vector
@@ -136,6 +191,11 @@ namespace rocalution
         // get index values
         virtual void GetIndexValues(const BaseVector<int>& index,
                                     BaseVector<ValueType>* values) const;
+        virtual void GetIndexValuesFloat(const BaseVector<int>& index,
+                                         BaseVector<float>*     values) const;
+        virtual ValueType DotFloat(const BaseVector<float>& x) const;
+        virtual void      AddScaleFloat(const BaseVector<float>& x, ValueType alpha);
+        virtual void      ScaleCopyToFloat(ValueType alpha, BaseVector<float>* vec);
         // set index values
         virtual void SetIndexValues(const BaseVector<int>&       index,
                                     const BaseVector<ValueType>& values);
@@ -156,10 +216,18 @@ namespace rocalution
             int64_t start, int64_t end, const int* index, int nc, int* size, int* boundary) const;
         // out of place sort with permutation
         virtual void Sort(BaseVector<ValueType>* sorted, BaseVector<int>* perm) const;
+        virtual void Unique(BaseVector<ValueType>* unique) const;
 
     private:
+        // Take over the data of vec, which has the same size, external buffers are
+        // overwritten instead
+        void SwapData_(HostVector<ValueType>* vec);
+
         ValueType* vec_;
 
+        // True if vec_ is an external buffer that is not freed by the vector
+        bool view_;
+
         // for [] operator in LocalVector
         friend class LocalVector<ValueType>;
 
@@ -180,6 +248,8 @@ namespace rocalution
         friend class HostMatrixDENSE<ValueType>;
         friend class HostMatrixMCSR<ValueType>;
         friend class HostMatrixBCSR<ValueType>;
+        friend class HostMatrixSELL<ValueType>;
+        friend class HostMatrixVBR<ValueType>;
 
         friend class HostMatrixCOO<float>;
         friend class HostMatrixCOO<double>;
@@ -198,6 +268,7 @@ namespace rocalution
 
         friend class HostStencil<ValueType>;
         friend class HostStencilLaplace2D<ValueType>;
+        friend class HostStencilLaplace3D<ValueType>;
     };
 
 } // namespace rocalution
@@ -0,0 +1,677 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "local_batch_matrix.hpp"
+#include "../utils/allocate_free.hpp"
+#include "../utils/def.hpp"
+#include "../utils/log.hpp"
+#include "backend_manager.hpp"
+#include "base_matrix.hpp"
+#include "base_vector.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    // Size of the batch data in bytes, used for the host fallback statistics
+    template <typename ValueType>
+    static int64_t host_fallback_bytes(const LocalBatchMatrix<ValueType>& mat)
+    {
+        return mat.GetBatchSize() * mat.GetNnz() * sizeof(ValueType)
+               + mat.GetNnz() * sizeof(int) + (mat.GetM() + 1) * sizeof(PtrType);
+    }
+
+    template <typename ValueType>
+    LocalBatchMatrix<ValueType>::LocalBatchMatrix()
+    {
+        log_debug(this, "LocalBatchMatrix::LocalBatchMatrix()");
+
+        this->object_name_ = "";
+
+        this->batch_ = 0;
+    }
+
+    template <typename ValueType>
+    LocalBatchMatrix<ValueType>::~LocalBatchMatrix()
+    {
+        log_debug(this, "LocalBatchMatrix::~LocalBatchMatrix()");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    int LocalBatchMatrix<ValueType>::GetBatchSize(void) const
+    {
+        return this->batch_;
+    }
+
+    template <typename ValueType>
+    int64_t LocalBatchMatrix<ValueType>::GetM(void) const
+    {
+        return this->pattern_.GetM();
+    }
+
+    template <typename ValueType>
+    int64_t LocalBatchMatrix<ValueType>::GetNnz(void) const
+    {
+        return this->pattern_.GetNnz();
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::Clear(void)
+    {
+        log_debug(this, "LocalBatchMatrix::Clear()");
+
+        this->pattern_.Clear();
+        this->val_.Clear();
+
+        this->batch_ = 0;
+    }
+
+    template <typename ValueType>
+    bool LocalBatchMatrix<ValueType>::Check(void) const
+    {
+        log_debug(this, "LocalBatchMatrix::Check()");
+
+        if(this->pattern_.Check() == false)
+        {
+            return false;
+        }
+
+        return this->val_.Check();
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::SetPattern(const LocalMatrix<ValueType>& mat, int batch)
+    {
+        log_debug(this, "LocalBatchMatrix::SetPattern()", (const void*&)mat, batch);
+
+        assert(batch >= 0);
+        assert(mat.GetM() == mat.GetN());
+
+        bool is_accel = this->is_accel_();
+
+        this->Clear();
+
+        this->object_name_ = "Batch of " + mat.object_name_;
+
+        // Build the pattern on the host, in CSR format
+        this->pattern_.MoveToHost();
+        this->pattern_.ConvertTo(mat.GetFormat(), mat.GetBlockDimension());
+        this->pattern_.CopyFrom(mat);
+        this->pattern_.ConvertToCSR();
+
+        int64_t m   = this->pattern_.GetM();
+        int64_t nnz = this->pattern_.GetNnz();
+
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
+        ValueType* batch_val  = NULL;
+
+        allocate_host(m + 1, &row_offset);
+        allocate_host(nnz, &col);
+        allocate_host(nnz, &val);
+        allocate_host(nnz * batch, &batch_val);
+
+        this->pattern_.CopyToCSR(row_offset, col, val);
+
+        // Replicate the values of mat into each system
+        for(int k = 0; k < batch; ++k)
+        {
+            copy_h2h(nnz, val, batch_val + k * nnz);
+        }
+
+        this->val_.MoveToHost();
+        this->val_.SetDataPtr(&batch_val, this->object_name_, nnz * batch);
+
+        free_host(&row_offset);
+        free_host(&col);
+        free_host(&val);
+
+        this->batch_ = batch;
+
+        if(is_accel == true)
+        {
+            this->MoveToAccelerator();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::CopyFromHostValues(const ValueType* val)
+    {
+        log_debug(this, "LocalBatchMatrix::CopyFromHostValues()", val);
+
+        assert(val != NULL || this->val_.GetSize() == 0);
+
+        if(this->val_.GetSize() > 0)
+        {
+            this->val_.CopyFromHostData(val);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::CopyToHostValues(ValueType* val) const
+    {
+        log_debug(this, "LocalBatchMatrix::CopyToHostValues()", val);
+
+        assert(val != NULL || this->val_.GetSize() == 0);
+
+        if(this->val_.GetSize() > 0)
+        {
+            this->val_.CopyToHostData(val);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::ExtractSystem(int k, LocalMatrix<ValueType>* mat) const
+    {
+        log_debug(this, "LocalBatchMatrix::ExtractSystem()", k, mat);
+
+        assert(k >= 0);
+        assert(k < this->batch_);
+        assert(mat != NULL);
+
+        int64_t m   = this->GetM();
+        int64_t nnz = this->GetNnz();
+
+        mat->Clear();
+        mat->CloneFrom(this->pattern_);
+
+        if(nnz == 0)
+        {
+            return;
+        }
+
+        // Exchange the values of the cloned pattern with the values of system k, all
+        // arrays stay on the backend of this object
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
+
+        mat->LeaveDataPtrCSR(&row_offset, &col, &val);
+
+        LocalVector<ValueType> pattern_val;
+        pattern_val.CloneBackend(*this);
+        pattern_val.SetDataPtr(&val, "pattern values", nnz);
+
+        LocalVector<ValueType> system_val;
+        system_val.CloneBackend(*this);
+        system_val.Allocate("system values", nnz);
+        system_val.CopyFrom(this->val_, k * nnz, 0, nnz);
+        system_val.LeaveDataPtr(&val);
+
+        mat->SetDataPtrCSR(&row_offset, &col, &val, this->object_name_, nnz, m, m);
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::CopyFrom(const LocalBatchMatrix<ValueType>& src)
+    {
+        log_debug(this, "LocalBatchMatrix::CopyFrom()", (const void*&)src);
+
+        assert(this != &src);
+
+        this->object_name_ = src.object_name_;
+
+        this->pattern_.Clear();
+        this->pattern_.ConvertToCSR();
+        this->pattern_.CopyFrom(src.pattern_);
+
+        this->val_.Clear();
+        this->val_.CopyFrom(src.val_);
+
+        this->batch_ = src.batch_;
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::Apply(const LocalMultiVector<ValueType>& in,
+                                            LocalMultiVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalBatchMatrix::Apply()", (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(in.GetNrow() == this->GetM());
+        assert(in.GetNcol() == this->batch_);
+
+        assert(((this->is_host_() == true) && (in.is_host_() == true))
+               || ((this->is_accel_() == true) && (in.is_accel_() == true)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(out->GetNrow() != this->GetM() || out->GetNcol() != this->batch_)
+        {
+            out->Allocate("batch of " + in.object_name_, this->GetM(), this->batch_);
+        }
+
+        assert(((this->is_host_() == true) && (out->is_host_() == true))
+               || ((this->is_accel_() == true) && (out->is_accel_() == true)));
+
+        if(this->GetM() == 0 || this->batch_ == 0)
+        {
+            return;
+        }
+
+        bool err = this->pattern_.matrix_->BatchApply(
+            this->batch_, *this->val_.vector_, *in.data_.vector_, out->data_.vector_);
+
+        if((err == false) && (this->is_host_() == true))
+        {
+            LOG_INFO("Computation of LocalBatchMatrix::Apply() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalBatchMatrix::Apply()", this->is_accel_());
+
+            LocalBatchMatrix<ValueType> mat_host;
+            LocalMultiVector<ValueType> in_host;
+
+            mat_host.CopyFrom(*this);
+            in_host.CopyFrom(in);
+
+            out->MoveToHost();
+
+            if(mat_host.pattern_.matrix_->BatchApply(mat_host.batch_,
+                                                     *mat_host.val_.vector_,
+                                                     *in_host.data_.vector_,
+                                                     out->data_.vector_)
+               == false)
+            {
+                LOG_INFO("Computation of LocalBatchMatrix::Apply() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            _rocalution_host_fallback_end(
+                "LocalBatchMatrix::Apply()", fallback_start, host_fallback_bytes(*this));
+
+            out->MoveToAccelerator();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::ExtractInverseDiagonal(
+        LocalMultiVector<ValueType>* inv_diag) const
+    {
+        log_debug(this, "LocalBatchMatrix::ExtractInverseDiagonal()", inv_diag);
+
+        assert(inv_diag != NULL);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(inv_diag->GetNrow() != this->GetM() || inv_diag->GetNcol() != this->batch_)
+        {
+            inv_diag->Allocate("Inverse of the diagonal elements of " + this->object_name_,
+                               this->GetM(),
+                               this->batch_);
+        }
+
+        assert(((this->is_host_() == true) && (inv_diag->is_host_() == true))
+               || ((this->is_accel_() == true) && (inv_diag->is_accel_() == true)));
+
+        if(this->GetNnz() == 0 || this->batch_ == 0)
+        {
+            return;
+        }
+
+        bool err = this->pattern_.matrix_->BatchExtractInverseDiagonal(
+            this->batch_, *this->val_.vector_, inv_diag->data_.vector_);
+
+        if((err == false) && (this->is_host_() == true))
+        {
+            LOG_INFO("Computation of LocalBatchMatrix::ExtractInverseDiagonal() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            double fallback_start = _rocalution_host_fallback_begin(
+                "LocalBatchMatrix::ExtractInverseDiagonal()", this->is_accel_());
+
+            LocalBatchMatrix<ValueType> mat_host;
+            mat_host.CopyFrom(*this);
+
+            inv_diag->MoveToHost();
+
+            if(mat_host.pattern_.matrix_->BatchExtractInverseDiagonal(
+                   mat_host.batch_, *mat_host.val_.vector_, inv_diag->data_.vector_)
+               == false)
+            {
+                LOG_INFO("Computation of LocalBatchMatrix::ExtractInverseDiagonal() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            _rocalution_host_fallback_end("LocalBatchMatrix::ExtractInverseDiagonal()",
+                                          fallback_start,
+                                          host_fallback_bytes(*this));
+
+            inv_diag->MoveToAccelerator();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::ILU0Factorize(void)
+    {
+        log_debug(this, "LocalBatchMatrix::ILU0Factorize()");
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() == 0 || this->batch_ == 0)
+        {
+            return;
+        }
+
+        bool err = this->pattern_.matrix_->BatchILU0Factorize(this->batch_, this->val_.vector_);
+
+        if((err == false) && (this->is_host_() == true))
+        {
+            LOG_INFO("Computation of LocalBatchMatrix::ILU0Factorize() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            double fallback_start = _rocalution_host_fallback_begin(
+                "LocalBatchMatrix::ILU0Factorize()", this->is_accel_());
+
+            this->MoveToHost();
+
+            if(this->pattern_.matrix_->BatchILU0Factorize(this->batch_, this->val_.vector_)
+               == false)
+            {
+                LOG_INFO("Computation of LocalBatchMatrix::ILU0Factorize() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            _rocalution_host_fallback_end(
+                "LocalBatchMatrix::ILU0Factorize()", fallback_start, host_fallback_bytes(*this));
+
+            this->MoveToAccelerator();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::Solve_(int                                basis,
+                                             const LocalMultiVector<ValueType>* inv_diag,
+                                             const LocalBatchMatrix<ValueType>* lu,
+                                             const LocalMultiVector<ValueType>& rhs,
+                                             LocalMultiVector<ValueType>*       x,
+                                             double                             abs_tol,
+                                             double                             rel_tol,
+                                             int                                max_iter,
+                                             int*                               iter,
+                                             double*                            res) const
+    {
+        log_debug(this,
+                  "LocalBatchMatrix::Solve_()",
+                  basis,
+                  inv_diag,
+                  lu,
+                  (const void*&)rhs,
+                  x,
+                  abs_tol,
+                  rel_tol,
+                  max_iter);
+
+        assert(basis >= 0);
+        assert(x != NULL);
+        assert(iter != NULL);
+        assert(res != NULL);
+        assert(rhs.GetNrow() == this->GetM());
+        assert(rhs.GetNcol() == this->batch_);
+        assert(x->GetNrow() == this->GetM());
+        assert(x->GetNcol() == this->batch_);
+
+        assert(((this->is_host_() == true) && (rhs.is_host_() == true)
+                && (x->is_host_() == true))
+               || ((this->is_accel_() == true) && (rhs.is_accel_() == true)
+                   && (x->is_accel_() == true)));
+
+        const BaseVector<ValueType>* inv_diag_vec = NULL;
+        const BaseVector<ValueType>* lu_vec       = NULL;
+
+        if(inv_diag != NULL)
+        {
+            assert(inv_diag->GetNrow() == this->GetM());
+            assert(inv_diag->GetNcol() == this->batch_);
+            assert(inv_diag->is_accel_() == this->is_accel_());
+
+            inv_diag_vec = inv_diag->data_.vector_;
+        }
+
+        if(lu != NULL)
+        {
+            assert(inv_diag == NULL);
+            assert(lu->GetNnz() == this->GetNnz());
+            assert(lu->batch_ == this->batch_);
+            assert(lu->is_accel_() == this->is_accel_());
+
+            lu_vec = lu->val_.vector_;
+        }
+
+        bool err;
+
+        if(basis == 0)
+        {
+            err = this->pattern_.matrix_->BatchBiCGStab(this->batch_,
+                                                        *this->val_.vector_,
+                                                        inv_diag_vec,
+                                                        lu_vec,
+                                                        *rhs.data_.vector_,
+                                                        x->data_.vector_,
+                                                        abs_tol,
+                                                        rel_tol,
+                                                        max_iter,
+                                                        iter,
+                                                        res);
+        }
+        else
+        {
+            err = this->pattern_.matrix_->BatchGMRES(this->batch_,
+                                                     basis,
+                                                     *this->val_.vector_,
+                                                     inv_diag_vec,
+                                                     lu_vec,
+                                                     *rhs.data_.vector_,
+                                                     x->data_.vector_,
+                                                     abs_tol,
+                                                     rel_tol,
+                                                     max_iter,
+                                                     iter,
+                                                     res);
+        }
+
+        if((err == false) && (this->is_host_() == true))
+        {
+            LOG_INFO("Computation of LocalBatchMatrix::Solve_() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalBatchMatrix::Solve_()", this->is_accel_());
+
+            LocalBatchMatrix<ValueType> mat_host;
+            LocalBatchMatrix<ValueType> lu_host;
+            LocalMultiVector<ValueType> inv_diag_host;
+            LocalMultiVector<ValueType> rhs_host;
+
+            mat_host.CopyFrom(*this);
+            rhs_host.CopyFrom(rhs);
+
+            inv_diag_vec = NULL;
+            lu_vec       = NULL;
+
+            if(inv_diag != NULL)
+            {
+                inv_diag_host.CopyFrom(*inv_diag);
+                inv_diag_vec = inv_diag_host.data_.vector_;
+            }
+
+            if(lu != NULL)
+            {
+                lu_host.CopyFrom(*lu);
+                lu_vec = lu_host.val_.vector_;
+            }
+
+            x->MoveToHost();
+
+            if(basis == 0)
+            {
+                err = mat_host.pattern_.matrix_->BatchBiCGStab(mat_host.batch_,
+                                                               *mat_host.val_.vector_,
+                                                               inv_diag_vec,
+                                                               lu_vec,
+                                                               *rhs_host.data_.vector_,
+                                                               x->data_.vector_,
+                                                               abs_tol,
+                                                               rel_tol,
+                                                               max_iter,
+                                                               iter,
+                                                               res);
+            }
+            else
+            {
+                err = mat_host.pattern_.matrix_->BatchGMRES(mat_host.batch_,
+                                                            basis,
+                                                            *mat_host.val_.vector_,
+                                                            inv_diag_vec,
+                                                            lu_vec,
+                                                            *rhs_host.data_.vector_,
+                                                            x->data_.vector_,
+                                                            abs_tol,
+                                                            rel_tol,
+                                                            max_iter,
+                                                            iter,
+                                                            res);
+            }
+
+            if(err == false)
+            {
+                LOG_INFO("Computation of LocalBatchMatrix::Solve_() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            _rocalution_host_fallback_end(
+                "LocalBatchMatrix::Solve_()", fallback_start, host_fallback_bytes(*this));
+
+            x->MoveToAccelerator();
+        }
+    }
+
+    template <typename ValueType>
+    bool LocalBatchMatrix<ValueType>::is_host_(void) const
+    {
+        return this->val_.is_host_();
+    }
+
+    template <typename ValueType>
+    bool LocalBatchMatrix<ValueType>::is_accel_(void) const
+    {
+        return this->val_.is_accel_();
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::MoveToAccelerator(void)
+    {
+        log_debug(this, "LocalBatchMatrix::MoveToAccelerator()");
+
+        this->pattern_.MoveToAccelerator();
+        this->val_.MoveToAccelerator();
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::MoveToHost(void)
+    {
+        log_debug(this, "LocalBatchMatrix::MoveToHost()");
+
+        this->pattern_.MoveToHost();
+        this->val_.MoveToHost();
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::CloneBackend(const BaseRocalution<ValueType>& src)
+    {
+        log_debug(this, "LocalBatchMatrix::CloneBackend()", (const void*&)src);
+
+        assert(this != &src);
+
+        // The pattern and the values carry the actual backend
+        this->pattern_.CloneBackend(src);
+        this->val_.CloneBackend(src);
+
+        BaseRocalution<ValueType>::CloneBackend(src);
+    }
+
+    template <typename ValueType>
+    void LocalBatchMatrix<ValueType>::Info(void) const
+    {
+        std::string current_backend_name;
+
+        if(this->is_host_() == true)
+        {
+            current_backend_name = _rocalution_host_name[0];
+        }
+        else
+        {
+            assert(this->is_accel_() == true);
+            current_backend_name = _rocalution_backend_name[this->local_backend_.backend];
+        }
+
+        LOG_INFO("LocalBatchMatrix"
+                 << " name=" << this->object_name_ << ";"
+                 << " rows=" << this->GetM() << ";"
+                 << " nnz=" << this->GetNnz() << ";"
+                 << " batch=" << this->batch_ << ";"
+                 << " prec=" << 8 * sizeof(ValueType) << "bit;"
+                 << " host backend={" << _rocalution_host_name[0] << "};"
+                 << " accelerator backend={"
+                 << _rocalution_backend_name[this->local_backend_.backend] << "};"
+                 << " current=" << current_backend_name);
+    }
+
+    template class LocalBatchMatrix<double>;
+    template class LocalBatchMatrix<float>;
+#ifdef SUPPORT_COMPLEX
+    template class LocalBatchMatrix<std::complex<double>>;
+    template class LocalBatchMatrix<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,213 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_LOCAL_BATCH_MATRIX_HPP_
+#define ROCALUTION_LOCAL_BATCH_MATRIX_HPP_
+
+#include "base_rocalution.hpp"
+#include "local_matrix.hpp"
+#include "local_multi_vector.hpp"
+#include "local_vector.hpp"
+#include "rocalution/export.hpp"
+
+#include <string>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    class BaseBatchSolver;
+
+    /** \ingroup op_vec_module
+  * \class LocalBatchMatrix
+  * \brief LocalBatchMatrix class
+  * \details
+  * A LocalBatchMatrix is a batch of independent, small, square sparse matrices that
+  * share one CSR sparsity pattern. The pattern is stored once, the values of all
+  * systems are stored consecutively, i.e. the values of system \p k start at
+  * \p k * GetNnz(). Batched vectors are represented by a LocalMultiVector with
+  * GetM() rows and GetBatchSize() columns, column \p k belongs to system \p k.
+  * All operations on a LocalBatchMatrix process the whole batch at once.
+  *
+  * \tparam ValueType - can be float, double, std::complex<float> and
+  *                     std::complex<double>
+  */
+    template <typename ValueType>
+    class LocalBatchMatrix : public BaseRocalution<ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        LocalBatchMatrix();
+        ROCALUTION_EXPORT
+        virtual ~LocalBatchMatrix();
+
+        /** \brief Move all data (i.e. move the batch) to the accelerator */
+        ROCALUTION_EXPORT
+        virtual void MoveToAccelerator(void);
+        /** \brief Move all data (i.e. move the batch) to the host */
+        ROCALUTION_EXPORT
+        virtual void MoveToHost(void);
+        /** \brief Clone the backend descriptor from another object */
+        ROCALUTION_EXPORT
+        virtual void CloneBackend(const BaseRocalution<ValueType>& src);
+
+        /** \brief Shows simple info about the batch. */
+        ROCALUTION_EXPORT
+        virtual void Info(void) const;
+        /** \brief Return the number of systems in the batch. */
+        ROCALUTION_EXPORT
+        int GetBatchSize(void) const;
+        /** \brief Return the number of rows (and columns) of each system. */
+        ROCALUTION_EXPORT
+        int64_t GetM(void) const;
+        /** \brief Return the number of non-zeros of each system. */
+        ROCALUTION_EXPORT
+        int64_t GetNnz(void) const;
+
+        /** \brief Perform a sanity check of the batch
+        * \details
+        * Checks, if the shared pattern is a valid CSR structure and if the values of all
+        * systems are not infinity and not NaN (not a number).
+        *
+        * \retval true if the batch is ok (empty batch is also ok).
+        * \retval false if there is something wrong with the structure or values.
+        */
+        ROCALUTION_EXPORT
+        bool Check(void) const;
+
+        /** \brief Initialize the batch from a LocalMatrix
+      * \details
+      * The sparsity pattern of \p mat becomes the shared pattern of the batch and the
+      * values of \p mat are copied into each of the \p batch systems. The values of the
+      * individual systems can then be set by CopyFromHostValues(). \p mat has to be
+      * square. The batch is allocated on the backend of this object.
+      *
+      * @param[in]
+      * mat     matrix that provides the pattern and the initial values
+      * @param[in]
+      * batch   number of systems
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalMatrix<ValueType> A;
+      *   A.ReadFileMTX("small.mtx");
+      *
+      *   LocalBatchMatrix<ValueType> batch;
+      *   batch.SetPattern(A, 10000);
+      *   batch.CopyFromHostValues(values_of_all_systems);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void SetPattern(const LocalMatrix<ValueType>& mat, int batch);
+
+        /** \brief Copy the values of all systems from a host array
+      * \details
+      * \p val holds GetBatchSize() * GetNnz() values, the values of system \p k start
+      * at \p k * GetNnz() and are ordered like the shared CSR pattern.
+      */
+        ROCALUTION_EXPORT
+        void CopyFromHostValues(const ValueType* val);
+        /** \brief Copy the values of all systems into a host array
+      * \details
+      * \p val has to hold GetBatchSize() * GetNnz() values.
+      */
+        ROCALUTION_EXPORT
+        void CopyToHostValues(ValueType* val) const;
+
+        /** \brief Copy system \p k into a LocalMatrix
+      * \details
+      * \p mat receives the shared pattern and the values of system \p k in CSR format
+      * and is placed on the backend of this object.
+      */
+        ROCALUTION_EXPORT
+        void ExtractSystem(int k, LocalMatrix<ValueType>* mat) const;
+
+        /** \brief Clone the entire batch (pattern, values and backend descr) from another
+        * LocalBatchMatrix
+        */
+        ROCALUTION_EXPORT
+        void CopyFrom(const LocalBatchMatrix<ValueType>& src);
+
+        /** \brief Clear (free) the batch */
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Perform the batched matrix-vector multiplication, out_k = A_k in_k
+      * \details
+      * \p in and \p out are LocalMultiVectors with GetM() rows and GetBatchSize()
+      * columns. \p out is allocated, if it is empty.
+      */
+        ROCALUTION_EXPORT
+        void Apply(const LocalMultiVector<ValueType>& in, LocalMultiVector<ValueType>* out) const;
+
+        /** \brief Extract the inverse diagonal values of all systems
+      * \details
+      * The inverse diagonal of system \p k is stored in column \p k of \p inv_diag.
+      * Zero diagonal entries are replaced with one.
+      */
+        ROCALUTION_EXPORT
+        void ExtractInverseDiagonal(LocalMultiVector<ValueType>* inv_diag) const;
+
+        /** \brief Perform ILU(0) factorization of all systems in place */
+        ROCALUTION_EXPORT
+        void ILU0Factorize(void);
+
+    protected:
+        /** \brief Return true if the object is on the host */
+        virtual bool is_host_(void) const;
+        /** \brief Return true if the object is on the accelerator */
+        virtual bool is_accel_(void) const;
+
+        /** \brief Solve all systems with BiCGStab (\p basis == 0) or GMRES(\p basis)
+      * \details
+      * The solvers are preconditioned with the inverse diagonal \p inv_diag, or with
+      * the ILU(0) factors \p lu, or not at all if both are \p NULL. \p iter and
+      * \p res receive the iteration count and the final residual norm of each system.
+      */
+        void Solve_(int                                basis,
+                    const LocalMultiVector<ValueType>* inv_diag,
+                    const LocalBatchMatrix<ValueType>* lu,
+                    const LocalMultiVector<ValueType>& rhs,
+                    LocalMultiVector<ValueType>*       x,
+                    double                             abs_tol,
+                    double                             rel_tol,
+                    int                                max_iter,
+                    int*                               iter,
+                    double*                            res) const;
+
+    private:
+        // Shared CSR pattern of all systems, its own values are not used
+        LocalMatrix<ValueType> pattern_;
+
+        // Values of all systems, system k starts at k * nnz
+        LocalVector<ValueType> val_;
+
+        // Number of systems
+        int batch_;
+
+        friend class BaseBatchSolver<ValueType>;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_LOCAL_BATCH_MATRIX_HPP_
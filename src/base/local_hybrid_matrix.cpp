@@ -0,0 +1,435 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "local_hybrid_matrix.hpp"
+#include "../utils/allocate_free.hpp"
+#include "../utils/def.hpp"
+#include "../utils/log.hpp"
+#include "../utils/time_functions.hpp"
+#include "backend_manager.hpp"
+
+#include <complex>
+#include <vector>
+
+namespace rocalution
+{
+
+    // Time of a matrix vector product on the backend of mat
+    template <typename ValueType>
+    static double spmv_time(const LocalMatrix<ValueType>& mat)
+    {
+        LocalVector<ValueType> x;
+        LocalVector<ValueType> y;
+
+        x.CloneBackend(mat);
+        y.CloneBackend(mat);
+
+        x.Allocate("x", mat.GetN());
+        y.Allocate("y", mat.GetM());
+
+        x.Ones();
+
+        // Warm up
+        mat.Apply(x, &y);
+        _rocalution_sync();
+
+        const int reps = 10;
+
+        double time = rocalution_time();
+
+        for(int i = 0; i < reps; ++i)
+        {
+            mat.Apply(x, &y);
+        }
+
+        _rocalution_sync();
+
+        return (rocalution_time() - time) / reps;
+    }
+
+    template <typename ValueType>
+    LocalHybridMatrix<ValueType>::LocalHybridMatrix()
+    {
+        log_debug(this, "LocalHybridMatrix::LocalHybridMatrix()");
+
+        this->object_name_ = "";
+
+        this->host_fraction_ = -1.0;
+    }
+
+    template <typename ValueType>
+    LocalHybridMatrix<ValueType>::~LocalHybridMatrix()
+    {
+        log_debug(this, "LocalHybridMatrix::~LocalHybridMatrix()");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    void LocalHybridMatrix<ValueType>::Info(void) const
+    {
+        std::string current_backend_name = this->is_accel_()
+                                               ? _rocalution_backend_name[this->local_backend_.backend]
+                                               : _rocalution_host_name[0];
+
+        LOG_INFO("LocalHybridMatrix"
+                 << " name=" << this->object_name_ << ";"
+                 << " rows=" << this->GetM() << ";"
+                 << " cols=" << this->GetN() << ";"
+                 << " nnz=" << this->GetNnz() << ";"
+                 << " host rows=" << this->host_part_.GetM() << ";"
+                 << " host nnz=" << this->host_part_.GetNnz() << ";"
+                 << " prec=" << 8 * sizeof(ValueType) << "bit;"
+                 << " current=" << current_backend_name);
+    }
+
+    template <typename ValueType>
+    void LocalHybridMatrix<ValueType>::SetHostFraction(double fraction)
+    {
+        log_debug(this, "LocalHybridMatrix::SetHostFraction()", fraction);
+
+        assert(fraction <= 1.0);
+
+        this->host_fraction_ = fraction;
+    }
+
+    template <typename ValueType>
+    void LocalHybridMatrix<ValueType>::SetMatrix(const LocalMatrix<ValueType>& mat)
+    {
+        log_debug(this, "LocalHybridMatrix::SetMatrix()", (const void*&)mat);
+
+        this->Clear();
+        this->SetSize(mat.GetM(), mat.GetN());
+
+        int nrow = static_cast<int>(mat.GetM());
+        int ncol = static_cast<int>(mat.GetN());
+
+        // Fraction of the non-zeros on the host, such that both partitions take about
+        // the same time. Without accelerator, there is nothing to split.
+        double fraction = this->host_fraction_;
+
+        if(this->is_accel_() == false)
+        {
+            fraction = 0.0;
+        }
+        else if(fraction < 0.0)
+        {
+            LocalMatrix<ValueType> accel_mat;
+            LocalMatrix<ValueType> host_mat;
+
+            accel_mat.CloneFrom(mat);
+            host_mat.CloneFrom(mat);
+
+            accel_mat.MoveToAccelerator();
+            host_mat.MoveToHost();
+
+            double accel_time = spmv_time(accel_mat);
+            double host_time  = spmv_time(host_mat);
+
+            fraction = accel_time / (accel_time + host_time);
+
+            LOG_VERBOSE_INFO(2,
+                             "LocalHybridMatrix::SetMatrix() SpMV time accelerator="
+                                 << accel_time << " usec; host=" << host_time
+                                 << " usec; host fraction=" << fraction);
+        }
+
+        // Split the CSR matrix on the host
+        LocalMatrix<ValueType> csr;
+        csr.CloneFrom(mat);
+        csr.MoveToHost();
+        csr.ConvertToCSR();
+
+        PtrType*   ptr = NULL;
+        int*       col = NULL;
+        ValueType* val = NULL;
+
+        csr.LeaveDataPtrCSR(&ptr, &col, &val);
+
+        // The last rows with at most the fraction of the non-zeros form the host partition
+        int64_t nnz = (nrow > 0) ? ptr[nrow] : 0;
+        int     k   = nrow;
+
+        while(k > 0 && static_cast<double>(ptr[nrow] - ptr[k - 1]) <= fraction * nnz)
+        {
+            --k;
+        }
+
+        // Empty host rows are handled by the accelerator partition
+        if(nrow > 0 && ptr[nrow] == ptr[k])
+        {
+            k = nrow;
+        }
+
+        int     host_m   = nrow - k;
+        int64_t accel_nz = (nrow > 0) ? ptr[k] : 0;
+        int64_t host_nz  = nnz - accel_nz;
+
+        // Accelerator partition, all rows with the host rows left empty
+        if(accel_nz > 0)
+        {
+            PtrType*   a_ptr = NULL;
+            int*       a_col = NULL;
+            ValueType* a_val = NULL;
+
+            allocate_host(nrow + 1, &a_ptr);
+            allocate_host(accel_nz, &a_col);
+            allocate_host(accel_nz, &a_val);
+
+            for(int i = 0; i <= nrow; ++i)
+            {
+                a_ptr[i] = (i <= k) ? ptr[i] : ptr[k];
+            }
+
+            copy_h2h(accel_nz, col, a_col);
+            copy_h2h(accel_nz, val, a_val);
+
+            this->accel_part_.SetDataPtrCSR(
+                &a_ptr, &a_col, &a_val, "hybrid accelerator partition", accel_nz, nrow, ncol);
+        }
+        else
+        {
+            this->accel_part_.AllocateCSR("hybrid accelerator partition", 0, nrow, ncol);
+        }
+
+        // Host partition, with its columns renumbered to the coupled entries of the input
+        if(host_m > 0)
+        {
+            std::vector<int> col_map(ncol, -1);
+
+            for(PtrType j = ptr[k]; j < ptr[nrow]; ++j)
+            {
+                col_map[col[j]] = 0;
+            }
+
+            int host_n = 0;
+            for(int c = 0; c < ncol; ++c)
+            {
+                if(col_map[c] == 0)
+                {
+                    col_map[c] = host_n++;
+                }
+            }
+
+            int*       h_cols = NULL;
+            PtrType*   h_ptr  = NULL;
+            int*       h_col  = NULL;
+            ValueType* h_val  = NULL;
+
+            allocate_host(host_n, &h_cols);
+            allocate_host(host_m + 1, &h_ptr);
+            allocate_host(host_nz, &h_col);
+            allocate_host(host_nz, &h_val);
+
+            for(int c = 0; c < ncol; ++c)
+            {
+                if(col_map[c] >= 0)
+                {
+                    h_cols[col_map[c]] = c;
+                }
+            }
+
+            for(int i = k; i <= nrow; ++i)
+            {
+                h_ptr[i - k] = ptr[i] - ptr[k];
+            }
+
+            for(PtrType j = ptr[k]; j < ptr[nrow]; ++j)
+            {
+                h_col[j - ptr[k]] = col_map[col[j]];
+                h_val[j - ptr[k]] = val[j];
+            }
+
+            this->host_part_.SetDataPtrCSR(
+                &h_ptr, &h_col, &h_val, "hybrid host partition", host_nz, host_m, host_n);
+            this->host_cols_.SetDataPtr(&h_cols, "hybrid host columns", host_n);
+
+            this->gather_.Allocate("hybrid gather", host_n);
+            this->gather_host_.Allocate("hybrid gather", host_n);
+            this->result_.Allocate("hybrid result", host_m);
+            this->result_host_.Allocate("hybrid result", host_m);
+        }
+
+        free_host(&ptr);
+        free_host(&col);
+        free_host(&val);
+
+        if(nrow == ncol)
+        {
+            this->diag_.CloneBackend(mat);
+            mat.ExtractDiagonal(&this->diag_);
+        }
+
+        this->CloneBackend_();
+
+        LOG_VERBOSE_INFO(2,
+                         "LocalHybridMatrix::SetMatrix() host partition rows="
+                             << host_m << "; nnz=" << host_nz);
+    }
+
+    template <typename ValueType>
+    int64_t LocalHybridMatrix<ValueType>::GetHostM(void) const
+    {
+        return this->host_part_.GetM();
+    }
+
+    template <typename ValueType>
+    int64_t LocalHybridMatrix<ValueType>::GetNnz(void) const
+    {
+        return this->accel_part_.GetNnz() + this->host_part_.GetNnz();
+    }
+
+    template <typename ValueType>
+    void LocalHybridMatrix<ValueType>::Clear(void)
+    {
+        log_debug(this, "LocalHybridMatrix::Clear()");
+
+        LocalShellOperator<ValueType>::Clear();
+
+        this->accel_part_.Clear();
+        this->host_part_.Clear();
+        this->host_cols_.Clear();
+        this->diag_.Clear();
+
+        this->gather_.Clear();
+        this->gather_host_.Clear();
+        this->result_.Clear();
+        this->result_host_.Clear();
+    }
+
+    template <typename ValueType>
+    void LocalHybridMatrix<ValueType>::CloneBackend_(void)
+    {
+        // The host partition and its vectors always stay on the host
+        this->host_part_.MoveToHost();
+        this->gather_host_.MoveToHost();
+        this->result_host_.MoveToHost();
+
+        if(this->is_accel_() == true)
+        {
+            this->accel_part_.MoveToAccelerator();
+            this->host_cols_.MoveToAccelerator();
+            this->diag_.MoveToAccelerator();
+            this->in_.MoveToAccelerator();
+            this->out_.MoveToAccelerator();
+            this->diag_wrap_.MoveToAccelerator();
+            this->gather_.MoveToAccelerator();
+            this->result_.MoveToAccelerator();
+        }
+        else
+        {
+            this->accel_part_.MoveToHost();
+            this->host_cols_.MoveToHost();
+            this->diag_.MoveToHost();
+            this->in_.MoveToHost();
+            this->out_.MoveToHost();
+            this->diag_wrap_.MoveToHost();
+            this->gather_.MoveToHost();
+            this->result_.MoveToHost();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalHybridMatrix<ValueType>::MoveToAccelerator(void)
+    {
+        log_debug(this, "LocalHybridMatrix::MoveToAccelerator()");
+
+        LocalShellOperator<ValueType>::MoveToAccelerator();
+
+        this->CloneBackend_();
+    }
+
+    template <typename ValueType>
+    void LocalHybridMatrix<ValueType>::MoveToHost(void)
+    {
+        log_debug(this, "LocalHybridMatrix::MoveToHost()");
+
+        LocalShellOperator<ValueType>::MoveToHost();
+
+        this->CloneBackend_();
+    }
+
+    template <typename ValueType>
+    void LocalHybridMatrix<ValueType>::HybridApply_(const LocalVector<ValueType>& in,
+                                                    LocalVector<ValueType>*       out) const
+    {
+        int64_t host_m = this->host_part_.GetM();
+
+        if(host_m == 0)
+        {
+            this->accel_part_.Apply(in, out);
+
+            return;
+        }
+
+        // Input entries of the host partition
+        in.GetIndexValues(this->host_cols_, &this->gather_);
+        this->gather_host_.CopyFrom(this->gather_);
+
+        // The accelerator works on its partition while the host threads work on theirs
+        this->accel_part_.Apply(in, out);
+        this->host_part_.Apply(this->gather_host_, &this->result_host_);
+
+        // Insert the result of the host rows
+        this->result_.CopyFrom(this->result_host_);
+        out->CopyFrom(this->result_, 0, this->GetM() - host_m, host_m);
+    }
+
+    template <typename ValueType>
+    void LocalHybridMatrix<ValueType>::ShellApply(const ValueType* in, ValueType* out) const
+    {
+        ValueType* pin  = const_cast<ValueType*>(in);
+        ValueType* pout = out;
+
+        this->in_.SetDataPtr(&pin, "in", this->GetN());
+        this->out_.SetDataPtr(&pout, "out", this->GetM());
+
+        this->HybridApply_(this->in_, &this->out_);
+
+        this->in_.LeaveDataPtr(&pin);
+        this->out_.LeaveDataPtr(&pout);
+    }
+
+    template <typename ValueType>
+    bool LocalHybridMatrix<ValueType>::ShellDiagonal(ValueType* diag) const
+    {
+        if(this->diag_.GetSize() != this->GetM())
+        {
+            return false;
+        }
+
+        this->diag_wrap_.SetDataPtr(&diag, "diag", this->GetM());
+        this->diag_wrap_.CopyFrom(this->diag_);
+        this->diag_wrap_.LeaveDataPtr(&diag);
+
+        return true;
+    }
+
+    template class LocalHybridMatrix<double>;
+    template class LocalHybridMatrix<float>;
+#ifdef SUPPORT_COMPLEX
+    template class LocalHybridMatrix<std::complex<double>>;
+    template class LocalHybridMatrix<std::complex<float>>;
+#endif
+
+} // namespace rocalution
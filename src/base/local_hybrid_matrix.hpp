@@ -0,0 +1,153 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_LOCAL_HYBRID_MATRIX_HPP_
+#define ROCALUTION_LOCAL_HYBRID_MATRIX_HPP_
+
+#include "local_matrix.hpp"
+#include "local_shell_operator.hpp"
+#include "local_vector.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup op_vec_module
+  * \class LocalHybridMatrix
+  * \brief LocalHybridMatrix class
+  * \details
+  * A LocalHybridMatrix splits a LocalMatrix row-wise into an accelerator and a host
+  * partition, such that the host cores take part in the operator application. The last
+  * rows of the matrix form the host partition. In each application, the entries of the
+  * input vector that the host rows couple to are gathered and copied to the host, the
+  * accelerator partition is applied, and the OpenMP threads apply the host partition
+  * while the accelerator is busy. The result of the host rows is then copied into the
+  * output vector.
+  *
+  * By default, the size of the host partition is chosen by timing the matrix vector
+  * product on both backends in SetMatrix(), such that both partitions take about the
+  * same time. It can be set explicitly with SetHostFraction().
+  *
+  * A LocalHybridMatrix is a LocalShellOperator and can be used wherever a
+  * LocalShellOperator is supported.
+  *
+  * \par Example
+  * \code{.cpp}
+  *   LocalHybridMatrix<double> op;
+  *   op.MoveToAccelerator();
+  *   op.SetMatrix(mat);
+  *
+  *   CG<LocalShellOperator<double>, LocalVector<double>, double> ls;
+  *   ls.SetOperator(op);
+  *   ls.Build();
+  * \endcode
+  *
+  * \tparam ValueType - can be float, double, std::complex<float> and
+  *                     std::complex<double>
+  */
+    template <typename ValueType>
+    class LocalHybridMatrix : public LocalShellOperator<ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        LocalHybridMatrix();
+        ROCALUTION_EXPORT
+        virtual ~LocalHybridMatrix();
+
+        /** \brief Shows simple info about the operator. */
+        ROCALUTION_EXPORT
+        virtual void Info(void) const;
+
+        /** \brief Set the fraction of the non-zeros that is assigned to the host
+      * \details
+      * A negative \p fraction (the default) chooses the fraction by timing the matrix
+      * vector product on both backends. Has to be called before SetMatrix().
+      */
+        ROCALUTION_EXPORT
+        void SetHostFraction(double fraction);
+
+        /** \brief Split the matrix into an accelerator and a host partition
+      * \details
+      * The data of \p mat is copied, \p mat is not referenced afterwards. The split
+      * is done for the current backend of the operator, i.e. the operator has to be
+      * moved to the accelerator before. On the host, the matrix is not split.
+      */
+        ROCALUTION_EXPORT
+        void SetMatrix(const LocalMatrix<ValueType>& mat);
+
+        /** \brief Return the number of rows of the host partition */
+        ROCALUTION_EXPORT
+        int64_t GetHostM(void) const;
+        /** \brief Return the number of non-zeros of both partitions */
+        ROCALUTION_EXPORT
+        virtual int64_t GetNnz(void) const;
+
+        /** \brief Clear all data of the operator */
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Move the accelerator partition to the accelerator */
+        ROCALUTION_EXPORT
+        virtual void MoveToAccelerator(void);
+        /** \brief Move the accelerator partition to the host */
+        ROCALUTION_EXPORT
+        virtual void MoveToHost(void);
+
+    protected:
+        virtual void ShellApply(const ValueType* in, ValueType* out) const;
+        virtual bool ShellDiagonal(ValueType* diag) const;
+
+    private:
+        /** \brief Apply both partitions, out = A * in */
+        void HybridApply_(const LocalVector<ValueType>& in, LocalVector<ValueType>* out) const;
+
+        /** \brief Move the data that follows the backend of the operator */
+        void CloneBackend_(void);
+
+        double host_fraction_;
+
+        /** \brief All rows of the matrix, the rows of the host partition are empty */
+        LocalMatrix<ValueType> accel_part_;
+        /** \brief Rows of the host partition, columns numbered as in host_cols_ */
+        LocalMatrix<ValueType> host_part_;
+        /** \brief Columns the host partition couples to */
+        LocalVector<int> host_cols_;
+        /** \brief Diagonal of the matrix */
+        LocalVector<ValueType> diag_;
+
+        // Wrappers of the raw pointers of ShellApply() and ShellDiagonal()
+        mutable LocalVector<ValueType> in_;
+        mutable LocalVector<ValueType> out_;
+        mutable LocalVector<ValueType> diag_wrap_;
+
+        // Input entries of the host partition and its result, on the backend of the
+        // operator and on the host
+        mutable LocalVector<ValueType> gather_;
+        mutable LocalVector<ValueType> gather_host_;
+        mutable LocalVector<ValueType> result_;
+        mutable LocalVector<ValueType> result_host_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_LOCAL_HYBRID_MATRIX_HPP_
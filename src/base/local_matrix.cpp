@@ -27,19 +27,27 @@
 #include "../utils/log.hpp"
 #include "../utils/math_functions.hpp"
 #include "../utils/rocsparseio.h"
+#include "../utils/time_functions.hpp"
+#include "../utils/type_traits.hpp"
 #include "backend_manager.hpp"
 #include "base_matrix.hpp"
 #include "base_vector.hpp"
+#include "host/host_conversion.hpp"
 #include "host/host_matrix_coo.hpp"
+#include "host/host_io.hpp"
 #include "host/host_matrix_csr.hpp"
 #include "host/host_vector.hpp"
+#include "local_multi_vector.hpp"
 #include "local_vector.hpp"
+#include "matrix_formats_ind.hpp"
 
 #include <algorithm>
 #include <complex>
 #include <limits>
 #include <sstream>
 #include <string.h>
+#include <type_traits>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -48,6 +56,270 @@
 namespace rocalution
 {
 
+    // Estimated size of the matrix data in bytes, used for the host fallback statistics
+    template <typename ValueType>
+    static int64_t host_fallback_bytes(const LocalMatrix<ValueType>& mat)
+    {
+        return mat.GetNnz() * (sizeof(ValueType) + sizeof(int))
+               + (mat.GetM() + 1) * sizeof(PtrType);
+    }
+
+    // Maximum padding of ELL, DIA and BCSR, relative to the CSR nnz, that is worth a trial
+    static constexpr double autotune_max_fill = 1.5;
+
+    // Number of buckets of the row length histogram, bucket b > 0 holds the rows with
+    // 2^(b-1) <= length < 2^b, bucket 0 the empty rows and the last bucket all longer rows
+    static constexpr int autotune_histogram_size = 12;
+
+    // Number of non-zero blockdim x blockdim blocks of a CSR matrix
+    static int64_t csr_block_count(
+        int64_t nrow, int64_t ncol, const PtrType* row_offset, const int* col, int blockdim)
+    {
+        std::vector<int64_t> marker((ncol - 1) / blockdim + 1, -1);
+        int64_t              nb = 0;
+
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                int64_t bc = col[j] / blockdim;
+
+                if(marker[bc] != i / blockdim)
+                {
+                    marker[bc] = i / blockdim;
+                    ++nb;
+                }
+            }
+        }
+
+        return nb;
+    }
+
+    // Structure statistics of a CSR matrix, that decide which formats are tried
+    static void autotune_structure(int64_t               nrow,
+                                   int64_t               ncol,
+                                   const PtrType*        row_offset,
+                                   const int*            col,
+                                   int64_t&              max_row,
+                                   int64_t&              num_diag,
+                                   int&                  blockdim,
+                                   int64_t&              nnzb,
+                                   std::vector<int64_t>& histogram)
+    {
+        std::vector<bool> diag(nrow + ncol, false);
+
+        max_row  = 0;
+        num_diag = 0;
+
+        histogram.assign(autotune_histogram_size, 0);
+
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            int64_t length = row_offset[i + 1] - row_offset[i];
+            int     bucket = 0;
+
+            while(length >> bucket != 0 && bucket < autotune_histogram_size - 1)
+            {
+                ++bucket;
+            }
+
+            ++histogram[bucket];
+
+            max_row = std::max(max_row, length);
+
+            for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                int64_t d = col[j] - i + nrow;
+
+                if(diag[d] == false)
+                {
+                    diag[d] = true;
+                    ++num_diag;
+                }
+            }
+        }
+
+        // Block dimension with the least padding, larger blocks win on ties
+        blockdim = 1;
+        nnzb     = 0;
+
+        const int blockdims[] = {2, 3, 4, 5, 6, 8};
+
+        for(int bd : blockdims)
+        {
+            if(nrow % bd != 0 || ncol % bd != 0)
+            {
+                continue;
+            }
+
+            int64_t nb = csr_block_count(nrow, ncol, row_offset, col, bd);
+
+            if(blockdim == 1 || nb * bd * bd <= nnzb * blockdim * blockdim)
+            {
+                blockdim = bd;
+                nnzb     = nb;
+            }
+        }
+    }
+
+    // Bytes of a matrix in matrix_format, given the structure of its CSR representation.
+    // SELL slices are padded to their longest row without sorting, which is an upper
+    // bound of the actual size
+    template <typename ValueType>
+    static int64_t conversion_bytes(unsigned int   matrix_format,
+                                    int            blockdim,
+                                    int64_t        nrow,
+                                    int64_t        ncol,
+                                    const PtrType* row_offset,
+                                    const int*     col)
+    {
+        const int64_t nnz = row_offset[nrow];
+        const int64_t sv  = sizeof(ValueType);
+        const int64_t si  = sizeof(int);
+
+        switch(matrix_format)
+        {
+        case DENSE:
+            return nrow * ncol * sv;
+        case CSR:
+            return (nrow + 1) * static_cast<int64_t>(sizeof(PtrType)) + nnz * (si + sv);
+        case MCSR:
+            return (nrow + 1) * si + nnz * (si + sv);
+        case COO:
+            return nnz * (2 * si + sv);
+        case BCSR:
+        {
+            int64_t nrowb = (nrow - 1) / blockdim + 1;
+            int64_t nnzb  = csr_block_count(nrow, ncol, row_offset, col, blockdim);
+
+            return (nrowb + 1) * si + nnzb * (si + blockdim * blockdim * sv);
+        }
+        case DIA:
+        {
+            std::vector<bool> diag(nrow + ncol, false);
+            int64_t           ndiag = 0;
+
+            for(int64_t i = 0; i < nrow; ++i)
+            {
+                for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
+                {
+                    int64_t d = col[j] - i + nrow;
+
+                    if(diag[d] == false)
+                    {
+                        diag[d] = true;
+                        ++ndiag;
+                    }
+                }
+            }
+
+            return ndiag * si + ndiag * nrow * sv;
+        }
+        case ELL:
+        {
+            int64_t max_row = 0;
+
+            for(int64_t i = 0; i < nrow; ++i)
+            {
+                max_row = std::max<int64_t>(max_row, row_offset[i + 1] - row_offset[i]);
+            }
+
+            return max_row * nrow * (si + sv);
+        }
+        case HYB:
+        {
+            // ELL width is the average row length, the remainder is stored in COO
+            int64_t max_row = (nnz > 0) ? (nnz - 1) / nrow + 1 : 0;
+            int64_t coo_nnz = 0;
+
+            for(int64_t i = 0; i < nrow; ++i)
+            {
+                coo_nnz += std::max<int64_t>(0, row_offset[i + 1] - row_offset[i] - max_row);
+            }
+
+            return max_row * nrow * (si + sv) + coo_nnz * (2 * si + sv);
+        }
+        case SELL:
+        {
+            int64_t nslice   = (nrow - 1) / _sell_slice_size + 1;
+            int64_t sell_nnz = 0;
+
+            for(int64_t s = 0; s < nslice; ++s)
+            {
+                int64_t max_row = 0;
+
+                for(int64_t i = s * _sell_slice_size;
+                    i < std::min<int64_t>(nrow, (s + 1) * _sell_slice_size);
+                    ++i)
+                {
+                    max_row = std::max<int64_t>(max_row, row_offset[i + 1] - row_offset[i]);
+                }
+
+                sell_nnz += max_row * _sell_slice_size;
+            }
+
+            return (nslice + 1) * static_cast<int64_t>(sizeof(PtrType)) + nrow * si
+                   + sell_nnz * (si + sv);
+        }
+        case VBR:
+        {
+            std::vector<int> row_block;
+
+            int64_t nrowb = csr_vbr_partition(static_cast<int>(nrow),
+                                              row_offset,
+                                              col,
+                                              static_cast<int>(_vbr_max_blockdim),
+                                              &row_block);
+
+            // Square matrices share the row partition for the columns
+            int64_t          ncolb = (nrow == ncol) ? nrowb : ncol;
+            std::vector<int> col_block(ncolb + 1);
+            std::vector<int> col2block(ncol);
+
+            for(int64_t j = 0; j < ncolb + 1; ++j)
+            {
+                col_block[j] = (nrow == ncol) ? row_block[j] : static_cast<int>(j);
+            }
+
+            for(int64_t j = 0; j < ncolb; ++j)
+            {
+                for(int c = col_block[j]; c < col_block[j + 1]; ++c)
+                {
+                    col2block[c] = static_cast<int>(j);
+                }
+            }
+
+            // All rows of a block row share their pattern, its first row determines the blocks
+            std::vector<int64_t> marker(ncolb, -1);
+            int64_t              nnzb    = 0;
+            int64_t              vbr_nnz = 0;
+
+            for(int64_t i = 0; i < nrowb; ++i)
+            {
+                int64_t first = row_block[i];
+                int64_t rbs   = row_block[i + 1] - first;
+
+                for(PtrType j = row_offset[first]; j < row_offset[first + 1]; ++j)
+                {
+                    int64_t cb = col2block[col[j]];
+
+                    if(marker[cb] != i)
+                    {
+                        marker[cb] = i;
+                        ++nnzb;
+                        vbr_nnz += rbs * (col_block[cb + 1] - col_block[cb]);
+                    }
+                }
+            }
+
+            return (nrowb + ncolb + 2 + nnzb) * si
+                   + (nrowb + nnzb + 2) * static_cast<int64_t>(sizeof(PtrType)) + vbr_nnz * sv;
+        }
+        }
+
+        return 0;
+    }
+
     template <typename ValueType>
     LocalMatrix<ValueType>::LocalMatrix()
     {
@@ -61,6 +333,12 @@ namespace rocalution
 
         this->matrix_accel_ = NULL;
         this->matrix_       = this->matrix_host_;
+
+        this->spmv_alg_          = SpMVAlg_Auto;
+        this->spmv_storage_      = SpMVStorage_Full;
+        this->spmv_index_        = SpMVIndex_Full;
+        this->ooc_chunk_nnz_     = 0;
+        this->symmetric_storage_ = false;
     }
 
     template <typename ValueType>
@@ -108,6 +386,7 @@ namespace rocalution
         log_debug(this, "LocalMatrix::Clear()", "");
 
         this->matrix_->Clear();
+        this->symmetric_storage_ = false;
     }
 
     template <typename ValueType>
@@ -130,6 +409,8 @@ namespace rocalution
             {
                 // Move to host
                 bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::Zeros()", is_accel);
                 this->MoveToHost();
 
                 // Convert to CSR
@@ -154,8 +435,8 @@ namespace rocalution
 
                 if(is_accel == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::Zeros() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Zeros()", fallback_start, host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -181,6 +462,8 @@ namespace rocalution
 
         this->Clear();
         this->object_name_ = name;
+
+        RocalutionMemoryTag mem_tag(this->object_name_);
         this->ConvertToCSR();
 
         if(nnz > 0)
@@ -235,6 +518,8 @@ namespace rocalution
 
         this->Clear();
         this->object_name_ = name;
+
+        RocalutionMemoryTag mem_tag(this->object_name_);
         this->ConvertToBCSR(blockdim);
 
         if(nnzb > 0)
@@ -291,6 +576,8 @@ namespace rocalution
 
         this->Clear();
         this->object_name_ = name;
+
+        RocalutionMemoryTag mem_tag(this->object_name_);
         this->ConvertToCOO();
 
         if(nnz > 0)
@@ -343,6 +630,8 @@ namespace rocalution
 
         this->Clear();
         this->object_name_ = name;
+
+        RocalutionMemoryTag mem_tag(this->object_name_);
         this->ConvertToDIA();
 
         if(nnz > 0)
@@ -397,6 +686,8 @@ namespace rocalution
 
         this->Clear();
         this->object_name_ = name;
+
+        RocalutionMemoryTag mem_tag(this->object_name_);
         this->ConvertToMCSR();
 
         if(nnz > 0)
@@ -449,6 +740,8 @@ namespace rocalution
 
         this->Clear();
         this->object_name_ = name;
+
+        RocalutionMemoryTag mem_tag(this->object_name_);
         this->ConvertToELL();
 
         if(nnz > 0)
@@ -508,6 +801,8 @@ namespace rocalution
 
         this->Clear();
         this->object_name_ = name;
+
+        RocalutionMemoryTag mem_tag(this->object_name_);
         this->ConvertToHYB();
 
         if(ell_nnz + coo_nnz > 0)
@@ -559,6 +854,8 @@ namespace rocalution
 
         this->Clear();
         this->object_name_ = name;
+
+        RocalutionMemoryTag mem_tag(this->object_name_);
         this->ConvertToDENSE();
 
         if(nrow * ncol > 0)
@@ -605,6 +902,8 @@ namespace rocalution
 
         if(this->is_accel_() == true)
         {
+            double fallback_start = _rocalution_host_fallback_begin("LocalMatrix::Check()", true);
+
             LocalMatrix<ValueType> mat_host;
             mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
             mat_host.CopyFrom(*this);
@@ -619,7 +918,8 @@ namespace rocalution
                 LOG_VERBOSE_INFO(2, "*** warning: LocalMatrix::Check() is performed in CSR format");
             }
 
-            LOG_VERBOSE_INFO(2, "*** warning: LocalMatrix::Check() is performed on the host");
+            _rocalution_host_fallback_end(
+                "LocalMatrix::Check()", fallback_start, host_fallback_bytes(*this));
         }
         else
         {
@@ -753,6 +1053,46 @@ namespace rocalution
         *col        = NULL;
         *val        = NULL;
 
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AttachCSRView(PtrType*    row_offset,
+                                               int*        col,
+                                               ValueType*  val,
+                                               std::string name,
+                                               int64_t     nnz,
+                                               int64_t     nrow,
+                                               int64_t     ncol)
+    {
+        log_debug(
+            this, "LocalMatrix::AttachCSRView()", row_offset, col, val, name, nnz, nrow, ncol);
+
+        assert(nnz >= 0);
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+        assert(row_offset != NULL);
+
+        if(nnz > 0)
+        {
+            assert(col != NULL);
+            assert(val != NULL);
+        }
+
+        this->Clear();
+
+        this->object_name_ = name;
+
+        this->ConvertToCSR();
+
+        assert(nrow <= std::numeric_limits<int>::max());
+        assert(ncol <= std::numeric_limits<int>::max());
+
+        this->matrix_->AttachViewCSR(
+            row_offset, col, val, nnz, static_cast<int>(nrow), static_cast<int>(ncol));
+
 #ifdef DEBUG_MODE
         this->Check();
 #endif
@@ -1276,7 +1616,8 @@ namespace rocalution
 
         bool err = this->matrix_->ReadFileMTX(filename);
 
-        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == COO))
+        if((err == false) && (this->is_host_() == true)
+           && (this->GetFormat() == COO || this->GetFormat() == CSR))
         {
             LOG_INFO("Execution of LocalMatrix::ReadFileMTX() failed");
             this->Info();
@@ -1289,10 +1630,10 @@ namespace rocalution
             bool is_accel = this->is_accel_();
             this->MoveToHost();
 
-            // Convert to COO
+            // Convert to CSR, the host CSR reader builds the matrix without a COO copy
             unsigned int format   = this->GetFormat();
             int          blockdim = this->GetBlockDimension();
-            this->ConvertToCOO();
+            this->ConvertToCSR();
 
             if(this->matrix_->ReadFileMTX(filename) == false)
             {
@@ -1437,36 +1778,41 @@ namespace rocalution
         unsigned int format   = this->GetFormat();
         int          blockdim = this->GetBlockDimension();
 
-        // rocsparse I/O handle
-        rocsparseio_handle handle;
-        rocsparseio_status status;
-
-        // Create handle
-        status = rocsparseio_open(&handle, rocsparseio_rwmode_read, filename.c_str());
+        // Compressed files always hold a CSR matrix
+        rocsparseio_format rsio_format = rocsparseio_format_sparse_csx;
 
-        if(status != rocsparseio_status_success)
+        if(is_matrix_csr_compressed(filename.c_str()) == false)
         {
-            LOG_INFO("Execution of LocalMatrix::ReadFileRSIO() failed: cannot open file");
-            FATAL_ERROR(__FILE__, __LINE__);
-        }
+            // rocsparse I/O handle
+            rocsparseio_handle handle;
+            rocsparseio_status status;
 
-        // Get format
-        rocsparseio_format rsio_format;
-        status = rocsparseio_read_format(handle, &rsio_format);
+            // Create handle
+            status = rocsparseio_open(&handle, rocsparseio_rwmode_read, filename.c_str());
 
-        if(status != rocsparseio_status_success)
-        {
-            LOG_INFO("Execution of LocalMatrix::ReadFileRSIO() failed: cannot read format");
-            FATAL_ERROR(__FILE__, __LINE__);
-        }
+            if(status != rocsparseio_status_success)
+            {
+                LOG_INFO("Execution of LocalMatrix::ReadFileRSIO() failed: cannot open file");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
 
-        // Close file
-        status = rocsparseio_close(handle);
+            // Get format
+            status = rocsparseio_read_format(handle, &rsio_format);
 
-        if(status != rocsparseio_status_success)
-        {
-            LOG_INFO("Execution of LocalMatrix::ReadFileRSIO() failed: cannot close file");
-            FATAL_ERROR(__FILE__, __LINE__);
+            if(status != rocsparseio_status_success)
+            {
+                LOG_INFO("Execution of LocalMatrix::ReadFileRSIO() failed: cannot read format");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            // Close file
+            status = rocsparseio_close(handle);
+
+            if(status != rocsparseio_status_success)
+            {
+                LOG_INFO("Execution of LocalMatrix::ReadFileRSIO() failed: cannot close file");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
         }
 
         switch(rsio_format)
@@ -1606,9 +1952,9 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::WriteFileRSIO(const std::string& filename) const
+    void LocalMatrix<ValueType>::WriteFileRSIO(const std::string& filename, bool compress) const
     {
-        log_debug(this, "LocalMatrix::WriteFileRSIO()", filename);
+        log_debug(this, "LocalMatrix::WriteFileRSIO()", filename, compress);
 
         LOG_INFO("WriteFileRSIO: filename=" << filename << "; writing...");
 
@@ -1616,6 +1962,29 @@ namespace rocalution
         this->Check();
 #endif
 
+        if(compress == true)
+        {
+            // Compressed files are written from host CSR matrices
+            if(this->matrix_->WriteFileCompressedRSIO(filename) == false)
+            {
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->WriteFileCompressedRSIO(filename) == false)
+                {
+                    LOG_INFO("Execution of LocalMatrix::WriteFileRSIO() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+            }
+
+            LOG_INFO("WriteFileRSIO: filename=" << filename << "; done");
+
+            return;
+        }
+
         bool err = this->matrix_->WriteFileRSIO(filename);
 
         if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
@@ -1664,6 +2033,7 @@ namespace rocalution
         assert(this != &src);
 
         this->matrix_->CopyFrom(*src.matrix_);
+        this->symmetric_storage_ = src.symmetric_storage_;
     }
 
     template <typename ValueType>
@@ -1675,6 +2045,7 @@ namespace rocalution
         assert(this != &src);
 
         this->matrix_->CopyFromAsync(*src.matrix_);
+        this->symmetric_storage_ = src.symmetric_storage_;
 
         this->asyncf_ = true;
     }
@@ -1684,6 +2055,20 @@ namespace rocalution
     {
         log_debug(this, "LocalMatrix::CloneFrom()", (const void*&)src);
 
+        this->CloneFrom_(src, false);
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ShareStructureFrom(const LocalMatrix<ValueType>& src)
+    {
+        log_debug(this, "LocalMatrix::ShareStructureFrom()", (const void*&)src);
+
+        this->CloneFrom_(src, true);
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::CloneFrom_(const LocalMatrix<ValueType>& src, bool share_structure)
+    {
         assert(this != &src);
 
 #ifdef DEBUG_MODE
@@ -1723,7 +2108,13 @@ namespace rocalution
             this->matrix_ = this->matrix_accel_;
         }
 
-        this->matrix_->CopyFrom(*src.matrix_);
+        // Only CSR shares its pattern, other formats are copied
+        if(share_structure == false || this->matrix_->ShareStructureFrom(*src.matrix_) == false)
+        {
+            this->matrix_->CopyFrom(*src.matrix_);
+        }
+
+        this->symmetric_storage_ = src.symmetric_storage_;
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -1745,52 +2136,34 @@ namespace rocalution
         this->Check();
 #endif
 
-        // Move to host
-        bool is_accel = this->is_accel_();
-        this->MoveToHost();
-
-        PtrType*   mat_row_offset = NULL;
-        int*       mat_col        = NULL;
-        ValueType* mat_val        = NULL;
-
-        int64_t nrow = this->GetLocalM();
-        int64_t ncol = this->GetLocalN();
-        int64_t nnz  = this->GetLocalNnz();
+        // Stage the host values on the backend of the matrix
+        LocalVector<ValueType> vec;
+        vec.CloneBackend(*this);
+        vec.Allocate("values", this->GetLocalNnz());
+        vec.CopyFromHostData(val);
 
-        // Extract matrix pointers
-        this->matrix_->LeaveDataPtrCSR(&mat_row_offset, &mat_col, &mat_val);
+        this->UpdateValues_(vec, NULL, 0);
 
-        LocalVector<ValueType> vec1;
-        vec1.MoveToHost();
-        vec1.SetDataPtr(&mat_val, "dummy1", nnz);
-        vec1.CloneBackend(*this);
-
-        // Dummy vector to follow the correct backend
-        LocalVector<ValueType> vec2;
-        vec2.MoveToHost();
-        vec2.Allocate("dummy2", nnz);
-        vec2.CopyFromData(val);
-        vec2.CloneBackend(*this);
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
 
-        vec2.LeaveDataPtr(&mat_val);
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::UpdateValuesCSR(const LocalVector<ValueType>& val,
+                                                 const LocalVector<int>*       perm)
+    {
+        log_debug(this, "LocalMatrix::UpdateValuesCSR()", (const void*&)val, perm);
 
-        assert(nrow <= std::numeric_limits<int>::max());
-        assert(ncol <= std::numeric_limits<int>::max());
+        assert(this->GetFormat() == CSR);
+        assert(val.GetSize() == this->GetLocalNnz());
+        assert(perm == NULL || perm->GetSize() == val.GetSize());
 
-        // Set matrix pointers
-        this->matrix_->SetDataPtrCSR(&mat_row_offset,
-                                     &mat_col,
-                                     &mat_val,
-                                     nnz,
-                                     static_cast<int>(nrow),
-                                     static_cast<int>(ncol));
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
 
-        if(is_accel)
-        {
-            LOG_VERBOSE_INFO(
-                2, "*** warning: LocalMatrix::UpdateValuesCSR() is performed on the host");
-            this->MoveToAccelerator();
-        }
+        this->UpdateValues_(val, perm, 0);
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -1798,26 +2171,296 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    bool LocalMatrix<ValueType>::is_host_(void) const
+    void LocalMatrix<ValueType>::UpdateValues_(const LocalVector<ValueType>& val,
+                                               const LocalVector<int>*       perm,
+                                               int64_t                       offset)
     {
-        return (this->matrix_ == this->matrix_host_);
-    }
+        assert(this->GetFormat() == CSR);
+        assert(this->is_host_() == val.is_host_());
+        assert(perm == NULL || this->is_host_() == perm->is_host_());
 
-    template <typename ValueType>
-    bool LocalMatrix<ValueType>::is_accel_(void) const
-    {
-        return (this->matrix_ == this->matrix_accel_);
-    }
+        if(this->GetLocalNnz() == 0)
+        {
+            return;
+        }
 
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::Info(void) const
-    {
-        std::string current_backend_name;
+        bool err = this->matrix_->UpdateValues(
+            *val.vector_, (perm != NULL) ? perm->vector_ : NULL, offset);
 
-        if(this->matrix_ == this->matrix_host_)
+        if(err == false)
         {
-            current_backend_name = _rocalution_host_name[0];
-        }
+            // Try again on the host
+            if(this->is_host_() == true)
+            {
+                LOG_INFO("Computation of LocalMatrix::UpdateValuesCSR() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalMatrix::UpdateValuesCSR()", true);
+
+            LocalVector<ValueType> tmp_val;
+            LocalVector<int>       tmp_perm;
+
+            tmp_val.Allocate("values", val.GetSize());
+            tmp_val.CopyFrom(val);
+
+            if(perm != NULL)
+            {
+                tmp_perm.Allocate("perm", perm->GetSize());
+                tmp_perm.CopyFrom(*perm);
+            }
+
+            this->MoveToHost();
+
+            if(this->matrix_->UpdateValues(
+                   *tmp_val.vector_, (perm != NULL) ? tmp_perm.vector_ : NULL, offset)
+               == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::UpdateValuesCSR() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            _rocalution_host_fallback_end(
+                "LocalMatrix::UpdateValuesCSR()", fallback_start, host_fallback_bytes(*this));
+
+            this->MoveToAccelerator();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AssembleCOOSymbolic(int64_t           nnz,
+                                                     const int*        row,
+                                                     const int*        col,
+                                                     int64_t           nrow,
+                                                     int64_t           ncol,
+                                                     LocalVector<int>* offset,
+                                                     LocalVector<int>* perm)
+    {
+        log_debug(
+            this, "LocalMatrix::AssembleCOOSymbolic()", nnz, row, col, nrow, ncol, offset, perm);
+
+        assert(nnz >= 0);
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+        assert(offset != NULL);
+        assert(perm != NULL);
+        assert(nnz <= std::numeric_limits<int>::max());
+        assert(nrow <= std::numeric_limits<int>::max());
+        assert(ncol <= std::numeric_limits<int>::max());
+
+        if(nnz > 0)
+        {
+            assert(row != NULL);
+            assert(col != NULL);
+        }
+
+        // Bucket the COO entries by row, the order within a row is kept
+        std::vector<int> row_count(nrow + 1, 0);
+
+        for(int64_t k = 0; k < nnz; ++k)
+        {
+            assert(row[k] >= 0 && row[k] < nrow);
+            assert(col[k] >= 0 && col[k] < ncol);
+
+            ++row_count[row[k] + 1];
+        }
+
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            row_count[i + 1] += row_count[i];
+        }
+
+        std::vector<int> order(nnz);
+        std::vector<int> pos(row_count.begin(), row_count.end() - 1);
+
+        for(int64_t k = 0; k < nnz; ++k)
+        {
+            order[pos[row[k]]++] = static_cast<int>(k);
+        }
+
+        // Sort each row by column, duplicates become adjacent
+        std::vector<PtrType> csr_nnz(nrow + 1, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            std::stable_sort(order.begin() + row_count[i],
+                             order.begin() + row_count[i + 1],
+                             [&](int a, int b) { return col[a] < col[b]; });
+
+            PtrType count = 0;
+
+            for(int k = row_count[i]; k < row_count[i + 1]; ++k)
+            {
+                if(k == row_count[i] || col[order[k]] != col[order[k - 1]])
+                {
+                    ++count;
+                }
+            }
+
+            csr_nnz[i + 1] = count;
+        }
+
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            csr_nnz[i + 1] += csr_nnz[i];
+        }
+
+        int64_t mat_nnz = csr_nnz[nrow];
+
+        PtrType*   mat_row_offset = NULL;
+        int*       mat_col        = NULL;
+        ValueType* mat_val        = NULL;
+
+        allocate_host(nrow + 1, &mat_row_offset);
+        allocate_host(mat_nnz, &mat_col);
+        allocate_host(mat_nnz, &mat_val);
+
+        copy_h2h(nrow + 1, csr_nnz.data(), mat_row_offset);
+        set_to_zero_host(mat_nnz, mat_val);
+
+        // Scatter map, the COO entries of each CSR entry are contiguous in perm
+        LocalVector<int> host_offset;
+        LocalVector<int> host_perm;
+
+        host_offset.Allocate("assembly offset", mat_nnz + 1);
+        host_perm.Allocate("assembly permutation", nnz);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            PtrType j = mat_row_offset[i] - 1;
+
+            for(int k = row_count[i]; k < row_count[i + 1]; ++k)
+            {
+                if(k == row_count[i] || col[order[k]] != col[order[k - 1]])
+                {
+                    ++j;
+
+                    mat_col[j]     = col[order[k]];
+                    host_offset[j] = k;
+                }
+
+                host_perm[k] = order[k];
+            }
+        }
+
+        host_offset[mat_nnz] = static_cast<int>(nnz);
+
+        // The matrix keeps its backend
+        bool accel = this->is_accel_();
+
+        this->Clear();
+        this->MoveToHost();
+        this->SetDataPtrCSR(
+            &mat_row_offset, &mat_col, &mat_val, this->object_name_, mat_nnz, nrow, ncol);
+
+        offset->CloneFrom(host_offset);
+        perm->CloneFrom(host_perm);
+
+        if(accel == true)
+        {
+            this->MoveToAccelerator();
+            offset->MoveToAccelerator();
+            perm->MoveToAccelerator();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AssembleCOONumeric(const LocalVector<ValueType>& val,
+                                                    const LocalVector<int>&       offset,
+                                                    const LocalVector<int>&       perm)
+    {
+        log_debug(this,
+                  "LocalMatrix::AssembleCOONumeric()",
+                  (const void*&)val,
+                  (const void*&)offset,
+                  (const void*&)perm);
+
+        assert(this->GetFormat() == CSR);
+        assert(offset.GetSize() == this->GetLocalNnz() + 1);
+        assert(perm.GetSize() == val.GetSize());
+        assert(this->is_host_() == val.is_host_());
+        assert(this->is_host_() == offset.is_host_());
+        assert(this->is_host_() == perm.is_host_());
+
+        bool err = this->matrix_->AssembleValues(*val.vector_, *offset.vector_, *perm.vector_);
+
+        if(err == false)
+        {
+            // Try again on the host
+            if(this->is_host_() == true)
+            {
+                LOG_INFO("Computation of LocalMatrix::AssembleCOONumeric() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalMatrix::AssembleCOONumeric()", true);
+
+            LocalVector<ValueType> tmp_val;
+            LocalVector<int>       tmp_offset;
+            LocalVector<int>       tmp_perm;
+
+            tmp_val.Allocate("values", val.GetSize());
+            tmp_offset.Allocate("offset", offset.GetSize());
+            tmp_perm.Allocate("perm", perm.GetSize());
+
+            tmp_val.CopyFrom(val);
+            tmp_offset.CopyFrom(offset);
+            tmp_perm.CopyFrom(perm);
+
+            this->MoveToHost();
+
+            if(this->matrix_->AssembleValues(
+                   *tmp_val.vector_, *tmp_offset.vector_, *tmp_perm.vector_)
+               == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::AssembleCOONumeric() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            _rocalution_host_fallback_end(
+                "LocalMatrix::AssembleCOONumeric()", fallback_start, host_fallback_bytes(*this));
+
+            this->MoveToAccelerator();
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    bool LocalMatrix<ValueType>::is_host_(void) const
+    {
+        return (this->matrix_ == this->matrix_host_);
+    }
+
+    template <typename ValueType>
+    bool LocalMatrix<ValueType>::is_accel_(void) const
+    {
+        return (this->matrix_ == this->matrix_accel_);
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Info(void) const
+    {
+        std::string current_backend_name;
+
+        if(this->matrix_ == this->matrix_host_)
+        {
+            current_backend_name = _rocalution_host_name[0];
+        }
         else
         {
             assert(this->matrix_ == this->matrix_accel_);
@@ -1833,6 +2476,11 @@ namespace rocalution
             format += sstr.str();
         }
 
+        if(this->symmetric_storage_ == true)
+        {
+            format += " symmetric";
+        }
+
         LOG_INFO("LocalMatrix"
                  << " name=" << this->object_name_ << ";"
                  << " rows=" << this->GetM() << ";"
@@ -1853,6 +2501,8 @@ namespace rocalution
     {
         log_debug(this, "LocalMatrix::MoveToAccelerator()");
 
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
 #ifdef DEBUG_MODE
         this->Check();
 #endif
@@ -1868,6 +2518,7 @@ namespace rocalution
         {
             this->matrix_accel_ = _rocalution_init_base_backend_matrix<ValueType>(
                 this->local_backend_, this->GetFormat(), this->GetBlockDimension());
+            this->matrix_accel_->SetOutOfCore(this->ooc_chunk_nnz_);
             this->matrix_accel_->CopyFrom(*this->matrix_host_);
 
             this->matrix_ = this->matrix_accel_;
@@ -1881,11 +2532,70 @@ namespace rocalution
         // if on accelerator - do nothing
     }
 
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::MoveToAccelerator(const ExecutionContext& context)
+    {
+        log_debug(this, "LocalMatrix::MoveToAccelerator()", (const void*&)context);
+
+        if(_rocalution_available_accelerator() == false)
+        {
+            this->MoveToAccelerator();
+
+            return;
+        }
+
+        // Already on the device of the context
+        if(this->matrix_accel_ != NULL && this->local_backend_.HIP_dev == context.GetDevice())
+        {
+            this->SetExecutionContext(context);
+
+            return;
+        }
+
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
+        int prev = _rocalution_set_device(this->local_backend_.HIP_dev);
+
+        if(this->matrix_accel_ != NULL)
+        {
+            // Work on the previous device has to be completed
+            _rocalution_sync();
+
+            // Allocations are placed on the current device
+            _rocalution_set_device(context.GetDevice());
+
+            BaseRocalution<ValueType>::SetExecutionContext(context);
+
+            // Copy device to device (peer access, or staged by the runtime)
+            AcceleratorMatrix<ValueType>* accel = _rocalution_init_base_backend_matrix<ValueType>(
+                this->local_backend_, this->GetFormat(), this->GetBlockDimension());
+            accel->CopyFrom(*this->matrix_accel_);
+
+            delete this->matrix_accel_;
+            this->matrix_accel_ = accel;
+            this->matrix_       = accel;
+
+            LOG_VERBOSE_INFO(
+                4, "*** info: LocalMatrix::MoveToAccelerator() device to device transfer");
+        }
+        else
+        {
+            _rocalution_set_device(context.GetDevice());
+
+            this->SetExecutionContext(context);
+            this->MoveToAccelerator();
+        }
+
+        _rocalution_set_device(prev);
+    }
+
     template <typename ValueType>
     void LocalMatrix<ValueType>::MoveToHost(void)
     {
         log_debug(this, "LocalMatrix::MoveToHost()");
 
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
         if((_rocalution_available_accelerator()) && (this->matrix_ == this->matrix_accel_))
         {
             this->matrix_host_ = _rocalution_init_base_host_matrix<ValueType>(
@@ -1911,6 +2621,8 @@ namespace rocalution
     {
         log_debug(this, "LocalMatrix::MoveToAcceleratorAsync()");
 
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
 #ifdef DEBUG_MODE
         this->Check();
 #endif
@@ -1926,6 +2638,7 @@ namespace rocalution
         {
             this->matrix_accel_ = _rocalution_init_base_backend_matrix<ValueType>(
                 this->local_backend_, this->GetFormat(), this->GetBlockDimension());
+            this->matrix_accel_->SetOutOfCore(this->ooc_chunk_nnz_);
             this->matrix_accel_->CopyFromAsync(*this->matrix_host_);
             this->asyncf_ = true;
 
@@ -1942,6 +2655,8 @@ namespace rocalution
     {
         log_debug(this, "LocalMatrix::MoveToHostAsync()");
 
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
         if((_rocalution_available_accelerator()) && (this->matrix_ == this->matrix_accel_))
         {
             this->matrix_host_ = _rocalution_init_base_host_matrix<ValueType>(
@@ -1961,6 +2676,30 @@ namespace rocalution
 #endif
     }
 
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Prefetch(void) const
+    {
+        log_debug(this, "LocalMatrix::Prefetch()");
+
+        if(this->is_accel_() == true)
+        {
+            this->matrix_->Prefetch();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::SetExecutionContext(const ExecutionContext& context)
+    {
+        log_debug(this, "LocalMatrix::SetExecutionContext()", (const void*&)context);
+
+        BaseRocalution<ValueType>::SetExecutionContext(context);
+
+        if(this->matrix_accel_ != NULL)
+        {
+            this->matrix_accel_->set_backend(this->local_backend_);
+        }
+    }
+
     template <typename ValueType>
     void LocalMatrix<ValueType>::Sync(void)
     {
@@ -2060,14 +2799,29 @@ namespace rocalution
         this->ConvertTo(DENSE);
     }
 
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ConvertToSELL(void)
+    {
+        this->ConvertTo(SELL);
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ConvertToVBR(void)
+    {
+        this->ConvertTo(VBR);
+    }
+
     template <typename ValueType>
     void LocalMatrix<ValueType>::ConvertTo(unsigned int matrix_format, int blockdim)
     {
         log_debug(this, "LocalMatrix::ConvertTo()", matrix_format, blockdim);
 
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
         assert((matrix_format == DENSE) || (matrix_format == CSR) || (matrix_format == MCSR)
                || (matrix_format == BCSR) || (matrix_format == COO) || (matrix_format == DIA)
-               || (matrix_format == ELL) || (matrix_format == HYB));
+               || (matrix_format == ELL) || (matrix_format == HYB) || (matrix_format == SELL)
+               || (matrix_format == VBR));
 
         LOG_VERBOSE_INFO(5,
                          "Converting " << _matrix_format_names[matrix_format] << " <- "
@@ -2121,6 +2875,21 @@ namespace rocalution
                 // Accelerator Matrix
                 assert(this->matrix_accel_ != NULL);
 
+                if(this->ConvertOnHost_(matrix_format, blockdim) == true)
+                {
+                    LOG_VERBOSE_INFO(2,
+                                     "*** info: Matrix conversion to "
+                                         << _matrix_format_names[matrix_format]
+                                         << " exceeds the free accelerator memory, converting "
+                                            "on the host");
+
+                    this->MoveToHost();
+                    this->ConvertTo(matrix_format, blockdim);
+                    this->MoveToAccelerator();
+
+                    return;
+                }
+
                 AcceleratorMatrix<ValueType>* new_mat;
                 new_mat = _rocalution_init_base_backend_matrix<ValueType>(
                     this->local_backend_, matrix_format, blockdim);
@@ -2130,12 +2899,15 @@ namespace rocalution
                 {
                     delete new_mat;
 
+                    double fallback_start
+                        = _rocalution_host_fallback_begin("LocalMatrix::ConvertTo()", true);
+
                     this->MoveToHost();
                     this->ConvertTo(matrix_format, blockdim);
                     this->MoveToAccelerator();
 
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ConvertTo() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ConvertTo()", fallback_start, host_fallback_bytes(*this));
                 }
                 else
                 {
@@ -2151,398 +2923,433 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::Apply(const LocalVector<ValueType>& in,
-                                       LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::EstimateConversionMemory(unsigned int matrix_format,
+                                                          int          blockdim,
+                                                          int64_t*     format_bytes,
+                                                          int64_t*     peak_bytes) const
     {
-        log_debug(this, "LocalMatrix::Apply()", (const void*&)in, out);
-
-        assert(out != NULL);
+        log_debug(this,
+                  "LocalMatrix::EstimateConversionMemory()",
+                  matrix_format,
+                  blockdim,
+                  format_bytes,
+                  peak_bytes);
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+        assert(format_bytes != NULL);
+        assert(peak_bytes != NULL);
+        assert(matrix_format != BCSR || blockdim > 1);
 
-        if(this->GetNnz() > 0)
+        if(this->GetNnz() == 0)
         {
-            assert(in.GetSize() == this->GetN());
-            assert(out->GetSize() == this->GetM());
-
-            assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                    && (out->vector_ == out->vector_host_))
-                   || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                       && (out->vector_ == out->vector_accel_)));
+            *format_bytes = 0;
+            *peak_bytes   = 0;
 
-            this->matrix_->Apply(*in.vector_, out->vector_);
-        }
-        else
-        {
-            // If matrix is empty, but not a 0x0 matrix, output vector need to be set to zero
-            out->vector_->Zeros();
+            return;
         }
-    }
 
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
-                                          ValueType                     scalar,
-                                          LocalVector<ValueType>*       out) const
-    {
-        log_debug(this, "LocalMatrix::ApplyAdd()", (const void*&)in, scalar, out);
+        // CSR structure on the host, copying avoids an additional accelerator matrix
+        LocalMatrix<ValueType> host;
+        host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+        host.CopyFrom(*this);
+        host.ConvertToCSR();
 
-        assert(out != NULL);
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+        int64_t nrow = host.GetM();
+        int64_t ncol = host.GetN();
 
-        if(this->GetNnz() > 0)
-        {
-            assert(in.GetSize() == this->GetN());
-            assert(out->GetSize() == this->GetM());
+        host.LeaveDataPtrCSR(&row_offset, &col, &val);
 
-            assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                    && (out->vector_ == out->vector_host_))
-                   || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                       && (out->vector_ == out->vector_accel_)));
+        int64_t src_bytes
+            = conversion_bytes<ValueType>(this->GetFormat(),
+                                          std::max(this->GetBlockDimension(), 1),
+                                          nrow,
+                                          ncol,
+                                          row_offset,
+                                          col);
+        int64_t csr_bytes = conversion_bytes<ValueType>(CSR, 1, nrow, ncol, row_offset, col);
 
-            this->matrix_->ApplyAdd(*in.vector_, scalar, out->vector_);
+        *format_bytes
+            = conversion_bytes<ValueType>(matrix_format, blockdim, nrow, ncol, row_offset, col);
+
+        if(this->GetFormat() == matrix_format)
+        {
+            *peak_bytes = src_bytes;
+        }
+        else if(this->GetFormat() != CSR && matrix_format != CSR)
+        {
+            *peak_bytes = std::max(src_bytes + csr_bytes, csr_bytes + *format_bytes);
         }
+        else
+        {
+            *peak_bytes = src_bytes + *format_bytes;
+        }
+
+        free_host(&row_offset);
+        free_host(&col);
+        free_host(&val);
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ExtractDiagonal(LocalVector<ValueType>* vec_diag) const
+    void LocalMatrix<ValueType>::AnalyzeFormats(MatrixFormatAnalysis* analysis) const
     {
-        log_debug(this, "LocalMatrix::ExtractDiagonal()", vec_diag);
+        log_debug(this, "LocalMatrix::AnalyzeFormats()", analysis);
 
-        assert(vec_diag != NULL);
+        assert(analysis != NULL);
 
-        assert(
-            ((this->matrix_ == this->matrix_host_) && (vec_diag->vector_ == vec_diag->vector_host_))
-            || ((this->matrix_ == this->matrix_accel_)
-                && (vec_diag->vector_ == vec_diag->vector_accel_)));
+        analysis->blockdim  = 1;
+        analysis->nnzb      = 0;
+        analysis->num_diag  = 0;
+        analysis->max_row   = 0;
+        analysis->ell_fill  = 0.0;
+        analysis->dia_fill  = 0.0;
+        analysis->bcsr_fill = 0.0;
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+        for(int f = 0; f < _matrix_format_count; ++f)
+        {
+            analysis->format_bytes[f] = 0;
+            analysis->spmv_bytes[f]   = 0;
+        }
 
-        if(this->GetNnz() > 0)
+        if(this->GetNnz() == 0)
         {
-            std::string vec_diag_name = "Diagonal elements of " + this->object_name_;
-            vec_diag->Allocate(vec_diag_name, std::min(this->GetLocalM(), this->GetLocalN()));
+            return;
+        }
 
-            bool err = this->matrix_->ExtractDiagonal(vec_diag->vector_);
+        // CSR structure on the host, copying avoids an additional accelerator matrix
+        LocalMatrix<ValueType> host;
+        host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+        host.CopyFrom(*this);
+        host.ConvertToCSR();
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-            {
-                LOG_INFO("Computation of LocalMatrix::ExtractDiagonal() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
 
-            if(err == false)
-            {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
+        int64_t nrow = host.GetM();
+        int64_t ncol = host.GetN();
+        int64_t nnz  = host.GetNnz();
 
-                vec_diag->MoveToHost();
+        host.LeaveDataPtrCSR(&row_offset, &col, &val);
 
-                mat_host.ConvertToCSR();
+        std::vector<int64_t> histogram;
+        autotune_structure(nrow,
+                           ncol,
+                           row_offset,
+                           col,
+                           analysis->max_row,
+                           analysis->num_diag,
+                           analysis->blockdim,
+                           analysis->nnzb,
+                           histogram);
 
-                if(mat_host.matrix_->ExtractDiagonal(vec_diag->vector_) == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::ExtractDiagonal() failed");
-                    this->Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+        analysis->ell_fill = static_cast<double>(analysis->max_row * nrow) / nnz;
+        analysis->dia_fill = static_cast<double>(analysis->num_diag * std::min(nrow, ncol)) / nnz;
+        analysis->bcsr_fill
+            = static_cast<double>(analysis->nnzb * analysis->blockdim * analysis->blockdim) / nnz;
 
-                if(this->GetFormat() != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::ExtractDiagonal() is performed in CSR format");
-                }
+        // Formats the conversion rejects, see csr_to_mcsr(), csr_to_ell() and csr_to_dia()
+        bool feasible[_matrix_format_count];
 
-                if(this->is_accel_() == true)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ExtractDiagonal() is performed on the host");
+        for(int f = 0; f < _matrix_format_count; ++f)
+        {
+            feasible[f] = true;
+        }
 
-                    vec_diag->MoveToAccelerator();
-                }
+        feasible[MCSR] = (nrow == ncol);
+        feasible[BCSR] = (analysis->blockdim > 1);
+        feasible[ELL]  = (analysis->max_row <= 5 * (nnz / nrow));
+        feasible[DIA]  = (analysis->num_diag <= 5 * (nnz / std::min(nrow, ncol)));
+
+        const int64_t vector_bytes = (nrow + ncol) * static_cast<int64_t>(sizeof(ValueType));
+
+        for(int f = 0; f < _matrix_format_count; ++f)
+        {
+            if(feasible[f] == false)
+            {
+                analysis->format_bytes[f] = -1;
+                analysis->spmv_bytes[f]   = -1;
+
+                continue;
             }
+
+            analysis->format_bytes[f] = conversion_bytes<ValueType>(
+                f, (f == BCSR) ? analysis->blockdim : 1, nrow, ncol, row_offset, col);
+            analysis->spmv_bytes[f] = analysis->format_bytes[f] + vector_bytes;
         }
+
+        free_host(&row_offset);
+        free_host(&col);
+        free_host(&val);
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ExtractInverseDiagonal(LocalVector<ValueType>* vec_inv_diag) const
+    void LocalMatrix<ValueType>::Statistics(MatrixStatistics* stats) const
     {
-        log_debug(this, "LocalMatrix::ExtractInverseDiagonal()", vec_inv_diag);
+        log_debug(this, "LocalMatrix::Statistics()", stats);
 
-        assert(vec_inv_diag != NULL);
+        assert(stats != NULL);
 
-        assert(((this->matrix_ == this->matrix_host_)
-                && (vec_inv_diag->vector_ == vec_inv_diag->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_)
-                   && (vec_inv_diag->vector_ == vec_inv_diag->vector_accel_)));
+        if(this->GetNnz() == 0)
+        {
+            stats->min_row        = 0;
+            stats->max_row        = 0;
+            stats->mean_row       = 0.0;
+            stats->var_row        = 0.0;
+            stats->bandwidth      = 0;
+            stats->profile        = 0;
+            stats->diag_dominance = 0.0;
+            stats->symmetric      = (this->GetM() == this->GetN());
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+            return;
+        }
 
-        if(this->GetNnz() > 0)
+        bool err = this->matrix_->Statistics(stats);
+
+        // Other formats are converted on the current backend, such that an accelerator
+        // matrix does not have to be copied to the host
+        if((err == false) && (this->GetFormat() != CSR))
         {
-            std::string vec_inv_diag_name
-                = "Inverse of the diagonal elements of " + this->object_name_;
-            vec_inv_diag->Allocate(vec_inv_diag_name,
-                                   std::min(this->GetLocalM(), this->GetLocalN()));
+            LocalMatrix<ValueType> csr;
+            csr.CloneFrom(*this);
+            csr.ConvertToCSR();
 
-            bool err = this->matrix_->ExtractInverseDiagonal(vec_inv_diag->vector_);
+            err = csr.matrix_->Statistics(stats);
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            LOG_VERBOSE_INFO(
+                2, "*** warning: LocalMatrix::Statistics() is performed in CSR format");
+        }
+
+        if((err == false) && (this->is_host_() == true))
+        {
+            LOG_INFO("Computation of LocalMatrix::Statistics() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalMatrix::Statistics()", this->is_accel_());
+
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+            mat_host.CopyFrom(*this);
+            mat_host.ConvertToCSR();
+
+            if(mat_host.matrix_->Statistics(stats) == false)
             {
-                LOG_INFO("Computation of LocalMatrix::ExtractInverseDiagonal() failed");
+                LOG_INFO("Computation of LocalMatrix::Statistics() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
-            if(err == false)
-            {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
+            _rocalution_host_fallback_end(
+                "LocalMatrix::Statistics()", fallback_start, host_fallback_bytes(*this));
+        }
+    }
 
-                vec_inv_diag->MoveToHost();
+    template <typename ValueType>
+    bool LocalMatrix<ValueType>::ConvertOnHost_(unsigned int matrix_format, int blockdim) const
+    {
+        int64_t free_bytes = _rocalution_accelerator_free_memory();
 
-                mat_host.ConvertToCSR();
+        if(free_bytes < 0 || this->GetNnz() == 0)
+        {
+            return false;
+        }
 
-                if(mat_host.matrix_->ExtractInverseDiagonal(vec_inv_diag->vector_) == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::ExtractInverseDiagonal() failed");
-                    this->Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+        // Estimating requires a copy of the matrix to the host, thus it is skipped if the
+        // converted matrix obviously fits. Padded formats may grow arbitrarily.
+        bool padded = (matrix_format == DENSE || matrix_format == DIA || matrix_format == ELL);
 
-                if(this->GetFormat() != CSR)
-                {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::ExtractInverseDiagonal() is "
-                                     "performed in CSR format");
-                }
+        if(padded == false && free_bytes >= 3 * host_fallback_bytes(*this))
+        {
+            return false;
+        }
 
-                if(this->is_accel_() == true)
-                {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::ExtractInverseDiagonal() is "
-                                     "performed on the host");
+        int64_t format_bytes;
+        int64_t peak_bytes;
 
-                    vec_inv_diag->MoveToAccelerator();
-                }
-            }
-        }
+        this->EstimateConversionMemory(matrix_format, blockdim, &format_bytes, &peak_bytes);
+
+        // The source is already allocated, the remainder has to fit into the free memory
+        int64_t src_bytes = host_fallback_bytes(*this);
+
+        return (peak_bytes - src_bytes > free_bytes) && (format_bytes <= free_bytes + src_bytes);
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ExtractSubMatrix(int64_t                 row_offset,
-                                                  int64_t                 col_offset,
-                                                  int64_t                 row_size,
-                                                  int64_t                 col_size,
-                                                  LocalMatrix<ValueType>* mat) const
+    void LocalMatrix<ValueType>::ConvertToBest(int trials)
     {
-        log_debug(this,
-                  "LocalMatrix::ExtractSubMatrix()",
-                  row_offset,
-                  col_offset,
-                  row_size,
-                  col_size,
-                  mat);
+        log_debug(this, "LocalMatrix::ConvertToBest()", trials);
 
-        assert(this != mat);
-        assert(mat != NULL);
-        assert(row_size >= 0);
-        assert(col_size >= 0);
-        assert(static_cast<int64_t>(row_offset) <= this->GetM());
-        assert(static_cast<int64_t>(col_offset) <= this->GetN());
-        assert(this->is_host_() == mat->is_host_());
+        assert(trials > 0);
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+        if(this->GetNnz() == 0)
+        {
+            return;
+        }
 
-        // offsets and sizes are expected to be within 32 bits
-        assert(row_offset <= std::numeric_limits<int>::max());
-        assert(col_offset <= std::numeric_limits<int>::max());
-        assert(row_size <= std::numeric_limits<int>::max());
-        assert(col_size <= std::numeric_limits<int>::max());
+        this->ConvertToCSR();
 
-        mat->Clear();
+        // Keys and structure statistics are computed on a host copy
+        LocalMatrix<ValueType> host;
+        host.CloneFrom(*this);
+        host.MoveToHost();
 
-        // Submatrix should be same format as full matrix
-        mat->ConvertTo(this->GetFormat(), this->GetBlockDimension());
+        long int row_key;
+        long int col_key;
+        long int val_key;
+        host.Key(row_key, col_key, val_key);
 
-        bool err = false;
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
+        host.LeaveDataPtrCSR(&row_offset, &col, &val);
 
-        // if the sub matrix has only 1 row
-        // it is computed on the host
-        if((this->is_host_() == true) || (row_size > 1))
-        {
-            err = this->matrix_->ExtractSubMatrix(static_cast<int>(row_offset),
-                                                  static_cast<int>(col_offset),
-                                                  static_cast<int>(row_size),
-                                                  static_cast<int>(col_size),
-                                                  mat->matrix_);
-        }
+        int64_t              max_row;
+        int64_t              num_diag;
+        int                  blockdim;
+        int64_t              nnzb;
+        std::vector<int64_t> histogram;
+        autotune_structure(this->GetM(),
+                           this->GetN(),
+                           row_offset,
+                           col,
+                           max_row,
+                           num_diag,
+                           blockdim,
+                           nnzb,
+                           histogram);
 
-        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        free_host(&row_offset);
+        free_host(&col);
+        free_host(&val);
+
+        // Signature of the matrix, decisions are shared by matrices of the same signature
+        std::ostringstream signature;
+        signature << (this->is_accel_() ? get_arch_rocalution() : "host") << " "
+                  << sizeof(ValueType) << "/" << sizeof(numeric_traits_t<ValueType>) << " "
+                  << this->GetM() << " " << this->GetN() << " " << this->GetNnz();
+        for(int64_t h : histogram)
         {
-            LOG_INFO("Computation of LocalMatrix::ExtractSubMatrix() failed");
-            this->Info();
-            FATAL_ERROR(__FILE__, __LINE__);
+            signature << " " << h;
         }
+        signature << " " << row_key << " " << col_key;
 
-        if(err == false)
-        {
-            LocalMatrix<ValueType> mat_host;
-            mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-            mat_host.CopyFrom(*this);
+        Rocalution_Tuning_Decision best;
 
-            mat->MoveToHost();
+        if(_rocalution_tuning_cache_find(signature.str(), &best) == false)
+        {
+            const double nnz = static_cast<double>(this->GetNnz());
 
-            mat_host.ConvertToCSR();
-            mat->ConvertToCSR();
+            std::vector<std::pair<unsigned int, int>> candidates;
+            candidates.push_back(std::make_pair(HYB, 1));
+            candidates.push_back(std::make_pair(SELL, 1));
 
-            if(mat_host.matrix_->ExtractSubMatrix(static_cast<int>(row_offset),
-                                                  static_cast<int>(col_offset),
-                                                  static_cast<int>(row_size),
-                                                  static_cast<int>(col_size),
-                                                  mat->matrix_)
-               == false)
+            if(max_row * this->GetM() <= autotune_max_fill * nnz)
             {
-                LOG_INFO("Computation of LocalMatrix::ExtractSubMatrix() failed");
-                mat_host.Info();
-                FATAL_ERROR(__FILE__, __LINE__);
+                candidates.push_back(std::make_pair(ELL, 1));
             }
-
-            if(this->GetFormat() != CSR)
+            if(num_diag * std::max(this->GetM(), this->GetN()) <= autotune_max_fill * nnz)
             {
-                if(row_size > 1)
+                candidates.push_back(std::make_pair(DIA, 1));
+            }
+            if(blockdim > 1 && nnzb * blockdim * blockdim <= autotune_max_fill * nnz)
+            {
+                candidates.push_back(std::make_pair(BCSR, blockdim));
+            }
+
+            LocalVector<ValueType> x;
+            LocalVector<ValueType> y;
+            x.CloneBackend(*this);
+            y.CloneBackend(*this);
+            x.Allocate("autotune x", this->GetN());
+            y.Allocate("autotune y", this->GetM());
+            x.Ones();
+
+            auto time_spmv = [&](const LocalMatrix<ValueType>& mat) {
+                mat.Apply(x, &y);
+
+                double time = rocalution_time();
+                for(int i = 0; i < trials; ++i)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::ExtractSubMatrix() is "
-                                     "performed in CSR format");
+                    mat.Apply(x, &y);
                 }
 
-                mat->ConvertTo(this->GetFormat(), this->GetBlockDimension());
-            }
+                return rocalution_time() - time;
+            };
 
-            if(this->is_accel_() == true)
+            best             = {CSR, 1, this->local_backend_.HIP_block_size};
+            double best_time = time_spmv(*this);
+
+            for(auto& c : candidates)
             {
-                if(row_size > 1)
+                LocalMatrix<ValueType> trial;
+                trial.CloneFrom(*this);
+                trial.ConvertTo(c.first, c.second);
+
+                // Conversion has fallen back to CSR
+                if(trial.GetFormat() != c.first)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::ExtractSubMatrix() is "
-                                     "performed on the host");
+                    continue;
                 }
 
-                mat->MoveToAccelerator();
-            }
+                // DIA and SELL kernels are launched with the thread block size of the matrix
+                std::vector<int> block_sizes(1, this->local_backend_.HIP_block_size);
 
-            if(row_size <= 1)
-            {
-                LOG_VERBOSE_INFO(2,
-                                 "*** warning: LocalMatrix::ExtractSubMatrix() is performed on "
-                                 "the host due to size = 1");
-            }
-        }
+                if(this->is_accel_() && (c.first == DIA || c.first == SELL))
+                {
+                    block_sizes = {64, 128, 256};
+                }
 
-        std::ostringstream row_begin;
-        std::ostringstream row_end;
-        std::ostringstream col_begin;
-        std::ostringstream col_end;
-
-        row_begin << row_offset;
-        row_end << row_offset + row_size - 1;
-        col_begin << col_offset;
-        col_end << col_offset + row_size - 1;
-
-        std::string mat_name
-            = "Submatrix of " + this->object_name_ + " " + "["
-              + row_begin
-                    .str() //static_cast<std::ostringstream*>(&(std::ostringstream() << row_offset))->str()
-              + ","
-              + col_begin
-                    .str() //static_cast<std::ostringstream*>(&(std::ostringstream() << col_offset))->str()
-              + "]-" + "["
-              + row_end.str() //static_cast<std::ostringstream*>(
-              //    &(std::ostringstream() << row_offset + row_size - 1))
-              //    ->str()
-              + ","
-              + col_end.str() //static_cast<std::ostringstream*>(
-              //&(std::ostringstream() << col_offset + row_size - 1))
-              //->str()
-              + "]";
+                for(int block_size : block_sizes)
+                {
+                    trial.local_backend_.HIP_block_size = block_size;
+                    trial.matrix_->set_backend(trial.local_backend_);
 
-        mat->object_name_ = mat_name;
+                    double time = time_spmv(trial);
 
-#ifdef DEBUG_MODE
-        mat->Check();
-#endif
-    }
+                    if(time < best_time)
+                    {
+                        best      = {c.first, c.second, block_size};
+                        best_time = time;
+                    }
+                }
+            }
 
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::ExtractSubMatrices(int                       row_num_blocks,
-                                                    int                       col_num_blocks,
-                                                    const int*                row_offset,
-                                                    const int*                col_offset,
-                                                    LocalMatrix<ValueType>*** mat) const
-    {
-        log_debug(this,
-                  "LocalMatrix::ExtractSubMatrices()",
-                  row_num_blocks,
-                  col_num_blocks,
-                  row_offset,
-                  col_offset,
-                  mat);
+            _rocalution_tuning_cache_insert(signature.str(), best);
 
-        assert(row_num_blocks > 0);
-        assert(col_num_blocks > 0);
-        assert(row_offset != NULL);
-        assert(col_offset != NULL);
-        assert(mat != NULL);
-        assert(*mat != NULL);
+            LOG_VERBOSE_INFO(3,
+                             "*** info: LocalMatrix::ConvertToBest() selected "
+                                 << _matrix_format_names[best.format]
+                                 << " blockdim=" << best.blockdim
+                                 << " block size=" << best.block_size << " ("
+                                 << best_time / trials << " usec per SpMV)");
+        }
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+        this->ConvertTo(best.format, best.blockdim);
 
-        if(this->GetNnz() > 0)
+        if(this->local_backend_.HIP_block_size != best.block_size)
         {
-            // implementation via ExtractSubMatrix() calls
-            // TODO OMP
-            //#pragma omp parallel for schedule(dynamic,1) collapse(2)
-            for(int i = 0; i < row_num_blocks; ++i)
-            {
-                for(int j = 0; j < col_num_blocks; ++j)
-                {
-                    this->ExtractSubMatrix(row_offset[i],
-                                           col_offset[j],
-                                           row_offset[i + 1] - row_offset[i],
-                                           col_offset[j + 1] - col_offset[j],
-                                           mat[i][j]);
-                }
-            }
+            this->local_backend_.HIP_block_size = best.block_size;
+            this->matrix_->set_backend(this->local_backend_);
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ExtractU(LocalMatrix<ValueType>* U, bool diag) const
+    void LocalMatrix<ValueType>::Apply(const LocalVector<ValueType>& in,
+                                       LocalVector<ValueType>*       out) const
     {
-        log_debug(this, "LocalMatrix::ExtractU()", U, diag);
+        log_debug(this, "LocalMatrix::Apply()", (const void*&)in, out);
+        ROCALUTION_RANGE("LocalMatrix::Apply()");
 
-        assert(U != NULL);
-        assert(U != this);
+        assert(out != NULL);
 
-        assert(((this->matrix_ == this->matrix_host_) && (U->matrix_ == U->matrix_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (U->matrix_ == U->matrix_accel_)));
+        RocalutionTimeScope time_scope(TimeSpMV);
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -2550,85 +3357,45 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = false;
-
-            if(diag == true)
-            {
-                err = this->matrix_->ExtractUDiagonal(U->matrix_);
-            }
-            else
-            {
-                err = this->matrix_->ExtractU(U->matrix_);
-            }
+            assert(in.GetSize() == this->GetN());
+            assert(out->GetSize() == this->GetM());
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-            {
-                LOG_INFO("Computation of LocalMatrix::ExtractU() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
+            assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                    && (out->vector_ == out->vector_host_))
+                   || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                       && (out->vector_ == out->vector_accel_)));
 
-            if(err == false)
+            if(this->symmetric_storage_ == true)
             {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
-
-                // Move to host
-                U->MoveToHost();
-
-                // Convert to CSR
-                mat_host.ConvertToCSR();
-
-                if(diag == true)
-                {
-                    err = mat_host.matrix_->ExtractUDiagonal(U->matrix_);
-                }
-                else
-                {
-                    err = mat_host.matrix_->ExtractU(U->matrix_);
-                }
-
-                if(err == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::ExtractU() failed");
-                    mat_host.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
-
-                if(this->GetFormat() != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ExtractU() is performed in CSR format");
+                out->vector_->Zeros();
+                this->ApplyAddSymmetric_(in, static_cast<ValueType>(1), out);
 
-                    U->ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                }
-
-                if(this->is_accel_() == true)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ExtractU() is performed on the host");
-
-                    U->MoveToAccelerator();
-                }
+                return;
             }
-        }
 
-#ifdef DEBUG_MODE
-        U->Check();
-#endif
+            this->matrix_->SetSpMVAlg(this->spmv_alg_);
+            this->matrix_->SetSpMVStorage(this->spmv_storage_);
+            this->matrix_->SetSpMVIndex(this->spmv_index_);
+            this->matrix_->SetOutOfCore(this->ooc_chunk_nnz_);
+            this->matrix_->Apply(*in.vector_, out->vector_);
+        }
+        else
+        {
+            // If matrix is empty, but not a 0x0 matrix, output vector need to be set to zero
+            out->vector_->Zeros();
+        }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ExtractL(LocalMatrix<ValueType>* L, bool diag) const
+    void LocalMatrix<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
+                                          ValueType                     scalar,
+                                          LocalVector<ValueType>*       out) const
     {
-        log_debug(this, "LocalMatrix::ExtractL()", L, diag);
+        log_debug(this, "LocalMatrix::ApplyAdd()", (const void*&)in, scalar, out);
 
-        assert(L != NULL);
-        assert(L != this);
+        assert(out != NULL);
 
-        assert(((this->matrix_ == this->matrix_host_) && (L->matrix_ == L->matrix_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (L->matrix_ == L->matrix_accel_)));
+        RocalutionTimeScope time_scope(TimeSpMV);
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -2636,276 +3403,332 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = false;
+            assert(in.GetSize() == this->GetN());
+            assert(out->GetSize() == this->GetM());
 
-            if(diag == true)
-            {
-                err = this->matrix_->ExtractLDiagonal(L->matrix_);
-            }
-            else
-            {
-                err = this->matrix_->ExtractL(L->matrix_);
-            }
+            assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                    && (out->vector_ == out->vector_host_))
+                   || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                       && (out->vector_ == out->vector_accel_)));
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            if(this->symmetric_storage_ == true)
             {
-                LOG_INFO("Computation of LocalMatrix::ExtractL() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
+                this->ApplyAddSymmetric_(in, scalar, out);
+
+                return;
             }
 
-            if(err == false)
-            {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
+            this->matrix_->SetSpMVAlg(this->spmv_alg_);
+            this->matrix_->SetSpMVStorage(this->spmv_storage_);
+            this->matrix_->SetSpMVIndex(this->spmv_index_);
+            this->matrix_->SetOutOfCore(this->ooc_chunk_nnz_);
+            this->matrix_->ApplyAdd(*in.vector_, scalar, out->vector_);
+        }
+    }
 
-                // Move to host
-                L->MoveToHost();
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ApplyAddSymmetric_(const LocalVector<ValueType>& in,
+                                                    ValueType                     scalar,
+                                                    LocalVector<ValueType>*       out) const
+    {
+        bool err = this->matrix_->ApplyAddSymmetric(*in.vector_, scalar, out->vector_);
 
-                // Convert to CSR
-                mat_host.ConvertToCSR();
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::ApplyAdd() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-                if(diag == true)
-                {
-                    err = mat_host.matrix_->ExtractLDiagonal(L->matrix_);
-                }
-                else
-                {
-                    err = mat_host.matrix_->ExtractL(L->matrix_);
-                }
+        if(err == false)
+        {
+            // Symmetric storage is only supported by CSR, compute on the host
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalMatrix::ApplyAdd()", this->is_accel_());
 
-                if(err == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::ExtractL() failed");
-                    mat_host.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+            mat_host.CopyFrom(*this);
+            mat_host.ConvertToCSR();
 
-                if(this->GetFormat() != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ExtractL() is performed in CSR format");
+            LocalVector<ValueType> in_host;
+            LocalVector<ValueType> out_host;
 
-                    L->ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                }
+            in_host.Allocate("in", in.GetSize());
+            out_host.Allocate("out", out->GetSize());
 
-                if(this->is_accel_() == true)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ExtractL() is performed on the host");
+            in_host.CopyFrom(in);
+            out_host.CopyFrom(*out);
 
-                    L->MoveToAccelerator();
-                }
+            if(mat_host.matrix_->ApplyAddSymmetric(*in_host.vector_, scalar, out_host.vector_)
+               == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::ApplyAdd() failed");
+                mat_host.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
             }
-        }
 
-#ifdef DEBUG_MODE
-        L->Check();
-#endif
+            out->CopyFrom(out_host);
+
+            _rocalution_host_fallback_end(
+                "LocalMatrix::ApplyAdd()", fallback_start, host_fallback_bytes(mat_host));
+        }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::LUAnalyse(void)
+    void LocalMatrix<ValueType>::SetSpMVAlg(SpMVAlg alg)
     {
-        log_debug(this, "LocalMatrix::LUAnalyse()");
+        log_debug(this, "LocalMatrix::SetSpMVAlg()", alg);
 
-        if(this->GetNnz() > 0)
-        {
-            this->matrix_->LUAnalyse();
-        }
+        this->spmv_alg_ = alg;
+        this->matrix_->SetSpMVAlg(alg);
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::LUAnalyseClear(void)
+    SpMVAlg LocalMatrix<ValueType>::GetSpMVAlg(void) const
     {
-        log_debug(this, "LocalMatrix::LUAnalyseClear()");
-
-        if(this->GetNnz() > 0)
-        {
-            this->matrix_->LUAnalyseClear();
-        }
+        return this->spmv_alg_;
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::LUSolve(const LocalVector<ValueType>& in,
-                                         LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::SetSpMVStorage(SpMVStorage storage)
     {
-        log_debug(this, "LocalMatrix::LUSolve()", (const void*&)in, out);
+        log_debug(this, "LocalMatrix::SetSpMVStorage()", storage);
 
-        assert(out != NULL);
-        assert(in.GetSize() == this->GetN());
-        assert(out->GetSize() == this->GetM());
+        this->spmv_storage_ = storage;
+        this->matrix_->SetSpMVStorage(storage);
+    }
 
-        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                && (out->vector_ == out->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                   && (out->vector_ == out->vector_accel_)));
+    template <typename ValueType>
+    SpMVStorage LocalMatrix<ValueType>::GetSpMVStorage(void) const
+    {
+        return this->spmv_storage_;
+    }
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::SetSpMVIndex(SpMVIndex index)
+    {
+        log_debug(this, "LocalMatrix::SetSpMVIndex()", index);
 
-        if(this->GetNnz() > 0)
+        this->spmv_index_ = index;
+        this->matrix_->SetSpMVIndex(index);
+    }
+
+    template <typename ValueType>
+    SpMVIndex LocalMatrix<ValueType>::GetSpMVIndex(void) const
+    {
+        return this->spmv_index_;
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::SetOutOfCore(bool onoff, int64_t chunk_nnz)
+    {
+        log_debug(this, "LocalMatrix::SetOutOfCore()", onoff, chunk_nnz);
+
+        assert(chunk_nnz >= 0);
+
+        if(onoff == true)
         {
-            bool err = this->matrix_->LUSolve(*in.vector_, out->vector_);
+            this->ooc_chunk_nnz_ = (chunk_nnz > 0) ? chunk_nnz : (static_cast<int64_t>(1) << 22);
+        }
+        else
+        {
+            this->ooc_chunk_nnz_ = 0;
+        }
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-            {
-                LOG_INFO("Computation of LocalMatrix::LUSolve() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
+        this->matrix_->SetOutOfCore(this->ooc_chunk_nnz_);
+    }
 
-            if(err == false)
-            {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ConvertToSymmetricStorage(void)
+    {
+        log_debug(this, "LocalMatrix::ConvertToSymmetricStorage()");
 
-                LocalVector<ValueType> vec_host;
-                vec_host.CopyFrom(in);
+        assert(this->GetM() == this->GetN());
 
-                out->MoveToHost();
+        if(this->symmetric_storage_ == true)
+        {
+            return;
+        }
 
-                // Try again
-                err = mat_host.matrix_->LUSolve(*vec_host.vector_, out->vector_);
+        this->ConvertToCSR();
 
-                if(err == false)
-                {
-                    mat_host.ConvertToCSR();
+        if(this->GetNnz() > 0)
+        {
+            LocalMatrix<ValueType> U;
+            U.CloneBackend(*this);
 
-                    if(mat_host.matrix_->LUSolve(*vec_host.vector_, out->vector_) == false)
-                    {
-                        LOG_INFO("Computation of LocalMatrix::LUSolve() failed");
-                        mat_host.Info();
-                        FATAL_ERROR(__FILE__, __LINE__);
-                    }
+            this->ExtractU(&U, true);
 
-                    if(this->GetFormat() != CSR)
-                    {
-                        LOG_VERBOSE_INFO(
-                            2, "*** warning: LocalMatrix::LUSolve() is performed in CSR format");
-                    }
-                }
+            PtrType*   row_offset = NULL;
+            int*       col        = NULL;
+            ValueType* val        = NULL;
 
-                if(this->is_accel_() == true)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::LUSolve() is performed on the host");
+            int64_t nnz  = U.GetNnz();
+            int64_t nrow = U.GetM();
 
-                    out->MoveToAccelerator();
-                }
-            }
+            U.LeaveDataPtrCSR(&row_offset, &col, &val);
+
+            // The upper triangle replaces the matrix without a copy
+            this->SetDataPtrCSR(&row_offset, &col, &val, this->object_name_, nnz, nrow, nrow);
         }
+
+        this->symmetric_storage_ = true;
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::LLAnalyse(void)
+    void LocalMatrix<ValueType>::ConvertToFullStorage(void)
     {
-        log_debug(this, "LocalMatrix::LLAnalyse()");
+        log_debug(this, "LocalMatrix::ConvertToFullStorage()");
 
-        if(this->GetNnz() > 0)
+        if(this->symmetric_storage_ == false)
         {
-            this->matrix_->LLAnalyse();
+            return;
         }
-    }
 
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::LLAnalyseClear(void)
-    {
-        log_debug(this, "LocalMatrix::LLAnalyseClear()");
+        this->symmetric_storage_ = false;
 
         if(this->GetNnz() > 0)
         {
-            this->matrix_->LLAnalyseClear();
+            // A = U + L, with L the strictly lower triangle of U^T
+            LocalMatrix<ValueType> Ut;
+            LocalMatrix<ValueType> L;
+
+            Ut.CloneBackend(*this);
+            L.CloneBackend(*this);
+
+            this->Transpose(&Ut);
+            Ut.ExtractL(&L, false);
+            Ut.Clear();
+
+            this->MatrixAdd(L, static_cast<ValueType>(1), static_cast<ValueType>(1), true);
         }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::LLSolve(const LocalVector<ValueType>& in,
-                                         LocalVector<ValueType>*       out) const
+    bool LocalMatrix<ValueType>::GetSymmetricStorage(void) const
     {
-        log_debug(this, "LocalMatrix::LLSolve()", (const void*&)in, out);
+        return this->symmetric_storage_;
+    }
 
-        assert(out != NULL);
-        assert(in.GetSize() == this->GetN());
-        assert(out->GetSize() == this->GetM());
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ExtractRealEquivalent(
+        LocalMatrix<numeric_traits_t<ValueType>>* mat) const
+    {
+        log_debug(this, "LocalMatrix::ExtractRealEquivalent()", mat);
 
-        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                && (out->vector_ == out->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                   && (out->vector_ == out->vector_accel_)));
+        typedef numeric_traits_t<ValueType> RealType;
+
+        assert(mat != NULL);
+        assert(static_cast<const void*>(mat) != static_cast<const void*>(this));
+
+        if(std::is_same<ValueType, RealType>::value == true)
+        {
+            LOG_INFO("LocalMatrix::ExtractRealEquivalent() requires a complex matrix");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
+        mat->Clear();
+        mat->MoveToHost();
+
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->LLSolve(*in.vector_, out->vector_);
+            // Complex CSR matrix with both triangles on the host
+            LocalMatrix<ValueType> host;
+            host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+            host.CopyFrom(*this);
+            host.ConvertToCSR();
+            host.ConvertToFullStorage();
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-            {
-                LOG_INFO("Computation of LocalMatrix::LLSolve() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
+            int64_t nrow = host.GetM();
+            int64_t ncol = host.GetN();
+            int64_t nnz  = host.GetNnz();
 
-            if(err == false)
-            {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
+            assert(nnz <= std::numeric_limits<int>::max());
 
-                LocalVector<ValueType> vec_host;
-                vec_host.CopyFrom(in);
+            PtrType*   csr_row_offset = NULL;
+            int*       csr_col        = NULL;
+            ValueType* csr_val        = NULL;
 
-                out->MoveToHost();
+            host.LeaveDataPtrCSR(&csr_row_offset, &csr_col, &csr_val);
 
-                mat_host.ConvertToCSR();
+            int*      row_offset = NULL;
+            int*      col        = NULL;
+            RealType* val        = NULL;
 
-                if(mat_host.matrix_->LLSolve(*vec_host.vector_, out->vector_) == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::LLSolve() failed");
-                    mat_host.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+            allocate_host(nrow + 1, &row_offset);
+            allocate_host(nnz, &col);
+            allocate_host(4 * nnz, &val);
 
-                if(this->GetFormat() != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::LLSolve() is performed in CSR format");
-                }
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int64_t i = 0; i <= nrow; ++i)
+            {
+                row_offset[i] = static_cast<int>(csr_row_offset[i]);
+            }
 
-                if(this->is_accel_() == true)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::LLSolve() is performed on the host");
+            // Entry a + ib maps the interleaved parts (x, y) of the input to
+            // (ax - by, bx + ay)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int64_t j = 0; j < nnz; ++j)
+            {
+                RealType re = std::real(csr_val[j]);
+                RealType im = std::imag(csr_val[j]);
 
-                    out->MoveToAccelerator();
-                }
+                col[j] = csr_col[j];
+
+                val[BCSR_IND(j, 0, 0, 2)] = re;
+                val[BCSR_IND(j, 0, 1, 2)] = -im;
+                val[BCSR_IND(j, 1, 0, 2)] = im;
+                val[BCSR_IND(j, 1, 1, 2)] = re;
             }
+
+            free_host(&csr_row_offset);
+            free_host(&csr_col);
+            free_host(&csr_val);
+
+            mat->SetDataPtrBCSR(&row_offset,
+                                &col,
+                                &val,
+                                this->object_name_ + " (real equivalent)",
+                                nnz,
+                                nrow,
+                                ncol,
+                                2);
         }
+
+        mat->CloneBackend(*this);
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::LLSolve(const LocalVector<ValueType>& in,
-                                         const LocalVector<ValueType>& inv_diag,
-                                         LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::ApplyTranspose(const LocalVector<ValueType>& in,
+                                                LocalVector<ValueType>*       out) const
     {
-        log_debug(this, "LocalMatrix::LLSolve()", (const void*&)in, (const void*&)inv_diag, out);
+        log_debug(this, "LocalMatrix::ApplyTranspose()", (const void*&)in, out);
 
         assert(out != NULL);
-        assert(in.GetSize() == this->GetN());
-        assert(out->GetSize() == this->GetM());
+        assert(in.GetSize() == this->GetM());
+        assert(out->GetSize() == this->GetN());
 
         assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                && (out->vector_ == out->vector_host_)
-                && (inv_diag.vector_ == inv_diag.vector_host_))
+                && (out->vector_ == out->vector_host_))
                || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                   && (out->vector_ == out->vector_accel_)
-                   && (inv_diag.vector_ == inv_diag.vector_accel_)));
+                   && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -2913,17 +3736,20 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->LLSolve(*in.vector_, *inv_diag.vector_, out->vector_);
+            bool err = this->matrix_->ApplyTranspose(*in.vector_, out->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::LLSolve() failed");
+                LOG_INFO("Computation of LocalMatrix::ApplyTranspose() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::ApplyTranspose()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
@@ -2931,18 +3757,13 @@ namespace rocalution
                 LocalVector<ValueType> vec_host;
                 vec_host.CopyFrom(in);
 
-                LocalVector<ValueType> inv_diag_host;
-                inv_diag_host.CopyFrom(inv_diag);
-
                 out->MoveToHost();
 
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->LLSolve(
-                       *vec_host.vector_, *inv_diag_host.vector_, out->vector_)
-                   == false)
+                if(mat_host.matrix_->ApplyTranspose(*vec_host.vector_, out->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::LLSolve() failed");
+                    LOG_INFO("Computation of LocalMatrix::ApplyTranspose() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
@@ -2950,51 +3771,36 @@ namespace rocalution
                 if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::LLSolve() is performed in CSR format");
+                        2, "*** warning: LocalMatrix::ApplyTranspose() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::LLSolve() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ApplyTranspose()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     out->MoveToAccelerator();
                 }
             }
         }
-    }
-
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::LAnalyse(bool diag_unit)
-    {
-        log_debug(this, "LocalMatrix::LAnalyse()", diag_unit);
-
-        if(this->GetNnz() > 0)
-        {
-            this->matrix_->LAnalyse(diag_unit);
-        }
-    }
-
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::LAnalyseClear(void)
-    {
-        log_debug(this, "LocalMatrix::LAnalyseClear()");
-
-        if(this->GetNnz() > 0)
+        else
         {
-            this->matrix_->LAnalyseClear();
+            // If matrix is empty, but not a 0x0 matrix, output needs to be set to zero
+            out->Zeros();
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::LSolve(const LocalVector<ValueType>& in,
-                                        LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::ApplyTransposeAdd(const LocalVector<ValueType>& in,
+                                                   ValueType                     scalar,
+                                                   LocalVector<ValueType>*       out) const
     {
-        log_debug(this, "LocalMatrix::LSolve()", (const void*&)in, out);
+        log_debug(this, "LocalMatrix::ApplyTransposeAdd()", (const void*&)in, scalar, out);
 
         assert(out != NULL);
-        assert(in.GetSize() == this->GetN());
-        assert(out->GetSize() == this->GetM());
+        assert(in.GetSize() == this->GetM());
+        assert(out->GetSize() == this->GetN());
 
         assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
                 && (out->vector_ == out->vector_host_))
@@ -3007,17 +3813,20 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->LSolve(*in.vector_, out->vector_);
+            bool err = this->matrix_->ApplyTransposeAdd(*in.vector_, scalar, out->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::LSolve() failed");
+                LOG_INFO("Computation of LocalMatrix::ApplyTransposeAdd() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::ApplyTransposeAdd()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
@@ -3029,23 +3838,26 @@ namespace rocalution
 
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->LSolve(*vec_host.vector_, out->vector_) == false)
+                if(mat_host.matrix_->ApplyTransposeAdd(*vec_host.vector_, scalar, out->vector_)
+                   == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::LSolve() failed");
+                    LOG_INFO("Computation of LocalMatrix::ApplyTransposeAdd() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::LSolve() is performed in CSR format");
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::ApplyTransposeAdd() is "
+                                     "performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::LSolve() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ApplyTransposeAdd()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     out->MoveToAccelerator();
                 }
@@ -3054,256 +3866,251 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::UAnalyse(bool diag_unit)
-    {
-        log_debug(this, "LocalMatrix::UAnalyse()", diag_unit);
-
-        if(this->GetNnz() > 0)
-        {
-            this->matrix_->UAnalyse(diag_unit);
-        }
-    }
-
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::UAnalyseClear(void)
-    {
-        log_debug(this, "LocalMatrix::UAnalyseClear()");
-
-        if(this->GetNnz() > 0)
-        {
-            this->matrix_->UAnalyseClear();
-        }
-    }
-
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::USolve(const LocalVector<ValueType>& in,
-                                        LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::ApplyRows(const LocalVector<ValueType>& in,
+                                           const LocalVector<int>&       rows,
+                                           LocalVector<ValueType>*       out) const
     {
-        log_debug(this, "LocalMatrix::USolve()", (const void*&)in, out);
+        log_debug(this, "LocalMatrix::ApplyRows()", (const void*&)in, (const void*&)rows, out);
 
         assert(out != NULL);
         assert(in.GetSize() == this->GetN());
         assert(out->GetSize() == this->GetM());
+        assert(rows.GetSize() <= this->GetM());
 
         assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                && (out->vector_ == out->vector_host_))
+                && (rows.vector_ == rows.vector_host_) && (out->vector_ == out->vector_host_))
                || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (rows.vector_ == rows.vector_accel_)
                    && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
-        if(this->GetNnz() > 0)
-        {
-            bool err = this->matrix_->USolve(*in.vector_, out->vector_);
+        bool err = this->matrix_->ApplyRows(*in.vector_, *rows.vector_, out->vector_);
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-            {
-                LOG_INFO("Computation of LocalMatrix::USolve() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
-
-            if(err == false)
-            {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::ApplyRows() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-                LocalVector<ValueType> vec_host;
-                vec_host.CopyFrom(in);
+        if(err == false)
+        {
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalMatrix::ApplyRows()", this->is_accel_());
 
-                out->MoveToHost();
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+            mat_host.CopyFrom(*this);
 
-                mat_host.ConvertToCSR();
+            LocalVector<ValueType> vec_host;
+            vec_host.CopyFrom(in);
 
-                if(mat_host.matrix_->USolve(*vec_host.vector_, out->vector_) == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::USolve() failed");
-                    mat_host.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+            LocalVector<int> rows_host;
+            rows_host.CopyFrom(rows);
 
-                if(this->GetFormat() != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::USolve() is performed in CSR format");
-                }
+            out->MoveToHost();
 
-                if(this->is_accel_() == true)
-                {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::USolve() is performed on the host");
+            mat_host.ConvertToCSR();
 
-                    out->MoveToAccelerator();
-                }
+            if(mat_host.matrix_->ApplyRows(*vec_host.vector_, *rows_host.vector_, out->vector_)
+               == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::ApplyRows() failed");
+                mat_host.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
             }
-        }
-    }
 
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::ItLUAnalyse(void)
-    {
-        log_debug(this, "LocalMatrix::ItLUAnalyse()");
-
-        if(this->GetNnz() > 0)
-        {
-            this->matrix_->ItLUAnalyse();
-        }
-    }
+            if(this->GetFormat() != CSR)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::ApplyRows() is performed in CSR format");
+            }
 
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::ItLUAnalyseClear(void)
-    {
-        log_debug(this, "LocalMatrix::ItLUAnalyseClear()");
+            if(this->is_accel_() == true)
+            {
+                _rocalution_host_fallback_end(
+                    "LocalMatrix::ApplyRows()", fallback_start, host_fallback_bytes(*this));
 
-        if(this->GetNnz() > 0)
-        {
-            this->matrix_->ItLUAnalyseClear();
+                out->MoveToAccelerator();
+            }
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ItLUSolve(int                           max_iter,
-                                           double                        tolerance,
-                                           bool                          use_tol,
-                                           const LocalVector<ValueType>& in,
-                                           LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::ApplyAddRows(const LocalVector<ValueType>& in,
+                                              const LocalVector<int>&       rows,
+                                              ValueType                     scalar,
+                                              LocalVector<ValueType>*       out) const
     {
         log_debug(
-            this, "LocalMatrix::ItLUSolve()", max_iter, tolerance, use_tol, (const void*&)in, out);
+            this, "LocalMatrix::ApplyAddRows()", (const void*&)in, (const void*&)rows, scalar, out);
 
         assert(out != NULL);
         assert(in.GetSize() == this->GetN());
         assert(out->GetSize() == this->GetM());
-        assert(max_iter > 0);
-
-        if(use_tol == true)
-        {
-            assert(tolerance >= 0.0);
-        }
+        assert(rows.GetSize() <= this->GetM());
 
         assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                && (out->vector_ == out->vector_host_))
+                && (rows.vector_ == rows.vector_host_) && (out->vector_ == out->vector_host_))
                || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (rows.vector_ == rows.vector_accel_)
                    && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
-        if(this->GetNnz() > 0)
+        bool err = this->matrix_->ApplyAddRows(*in.vector_, *rows.vector_, scalar, out->vector_);
+
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
         {
-            bool err
-                = this->matrix_->ItLUSolve(max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+            LOG_INFO("Computation of LocalMatrix::ApplyAddRows() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-            {
-                LOG_INFO("Computation of LocalMatrix::ItLUSolve() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
+        if(err == false)
+        {
+            double fallback_start = _rocalution_host_fallback_begin("LocalMatrix::ApplyAddRows()",
+                                                                    this->is_accel_());
 
-            if(err == false)
-            {
-                // Convert to CSR
-                LocalMatrix<ValueType> mat_csr;
-                mat_csr.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_csr.CopyFrom(*this);
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+            mat_host.CopyFrom(*this);
 
-                mat_csr.ConvertToCSR();
+            LocalVector<ValueType> vec_host;
+            vec_host.CopyFrom(in);
 
-                // Try CSR format first
-                err = mat_csr.matrix_->ItLUSolve(
-                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
-                if((err == false) && (this->is_host_() == true))
-                {
-                    LOG_INFO("Computation of LocalMatrix::ItLUSolve() failed");
-                    mat_csr.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+            LocalVector<int> rows_host;
+            rows_host.CopyFrom(rows);
 
-                // Try Host
-                LocalVector<ValueType> vec_host;
-                vec_host.CopyFrom(in);
+            out->MoveToHost();
 
-                vec_host.MoveToHost();
-                out->MoveToHost();
-                mat_csr.MoveToHost();
+            mat_host.ConvertToCSR();
 
-                err = mat_csr.matrix_->ItLUSolve(
-                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
-                if((err == false))
-                {
-                    LOG_INFO("Computation of LocalMatrix::ItLUSolve() failed");
-                    mat_csr.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+            if(mat_host.matrix_->ApplyAddRows(
+                   *vec_host.vector_, *rows_host.vector_, scalar, out->vector_)
+               == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::ApplyAddRows() failed");
+                mat_host.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
 
-                if(this->GetFormat() != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItLUSolve() is performed in CSR format");
-                }
+            if(this->GetFormat() != CSR)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::ApplyAddRows() is performed in CSR format");
+            }
 
-                if(this->is_accel_() == true)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItLUSolve() is performed on the host");
+            if(this->is_accel_() == true)
+            {
+                _rocalution_host_fallback_end(
+                    "LocalMatrix::ApplyAddRows()", fallback_start, host_fallback_bytes(*this));
 
-                    out->MoveToAccelerator();
-                }
+                out->MoveToAccelerator();
             }
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ItLLAnalyse(void)
+    void LocalMatrix<ValueType>::ResidualRows(const LocalVector<ValueType>& rhs,
+                                              const LocalVector<ValueType>& x,
+                                              const LocalVector<int>&       rows,
+                                              LocalVector<ValueType>*       res) const
     {
-        log_debug(this, "LocalMatrix::ItLLAnalyse()");
+        log_debug(this,
+                  "LocalMatrix::ResidualRows()",
+                  (const void*&)rhs,
+                  (const void*&)x,
+                  (const void*&)rows,
+                  res);
 
-        if(this->GetNnz() > 0)
+        assert(res != NULL);
+        assert(rhs.GetSize() == this->GetM());
+        assert(x.GetSize() == this->GetN());
+        assert(res->GetSize() == this->GetM());
+        assert(rows.GetSize() <= this->GetM());
+
+        assert(((this->matrix_ == this->matrix_host_) && (rhs.vector_ == rhs.vector_host_)
+                && (x.vector_ == x.vector_host_) && (rows.vector_ == rows.vector_host_)
+                && (res->vector_ == res->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (rhs.vector_ == rhs.vector_accel_)
+                   && (x.vector_ == x.vector_accel_) && (rows.vector_ == rows.vector_accel_)
+                   && (res->vector_ == res->vector_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        bool err
+            = this->matrix_->ResidualRows(*rhs.vector_, *x.vector_, *rows.vector_, res->vector_);
+
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
         {
-            this->matrix_->ItLLAnalyse();
+            LOG_INFO("Computation of LocalMatrix::ResidualRows() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
         }
-    }
-
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::ItLLAnalyseClear(void)
-    {
-        log_debug(this, "LocalMatrix::ItLLAnalyseClear()");
 
-        if(this->GetNnz() > 0)
+        if(err == false)
         {
-            this->matrix_->ItLLAnalyseClear();
+            double fallback_start = _rocalution_host_fallback_begin("LocalMatrix::ResidualRows()",
+                                                                    this->is_accel_());
+
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+            mat_host.CopyFrom(*this);
+
+            LocalVector<ValueType> rhs_host;
+            rhs_host.CopyFrom(rhs);
+
+            LocalVector<ValueType> x_host;
+            x_host.CopyFrom(x);
+
+            LocalVector<int> rows_host;
+            rows_host.CopyFrom(rows);
+
+            res->MoveToHost();
+
+            mat_host.ConvertToCSR();
+
+            if(mat_host.matrix_->ResidualRows(
+                   *rhs_host.vector_, *x_host.vector_, *rows_host.vector_, res->vector_)
+               == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::ResidualRows() failed");
+                mat_host.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(this->GetFormat() != CSR)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::ResidualRows() is performed in CSR format");
+            }
+
+            if(this->is_accel_() == true)
+            {
+                _rocalution_host_fallback_end(
+                    "LocalMatrix::ResidualRows()", fallback_start, host_fallback_bytes(*this));
+
+                res->MoveToAccelerator();
+            }
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ItLLSolve(int                           max_iter,
-                                           double                        tolerance,
-                                           bool                          use_tol,
-                                           const LocalVector<ValueType>& in,
-                                           LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::Apply(const LocalMultiVector<ValueType>& in,
+                                       LocalMultiVector<ValueType>*       out) const
     {
-        log_debug(
-            this, "LocalMatrix::ItLLSolve()", max_iter, tolerance, use_tol, (const void*&)in, out);
+        log_debug(this, "LocalMatrix::Apply()", (const void*&)in, out);
 
         assert(out != NULL);
-        assert(in.GetSize() == this->GetN());
-        assert(out->GetSize() == this->GetM());
-        assert(max_iter > 0);
-
-        if(use_tol == true)
-        {
-            assert(tolerance >= 0.0);
-        }
-
-        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                && (out->vector_ == out->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                   && (out->vector_ == out->vector_accel_)));
+        assert(in.GetNcol() == out->GetNcol());
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -3311,103 +4118,114 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err
-                = this->matrix_->ItLLSolve(max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+            assert(in.GetNrow() == this->GetN());
+            assert(out->GetNrow() == this->GetM());
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-            {
-                LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
+            assert(((this->matrix_ == this->matrix_host_) && (in.is_host_() == true)
+                    && (out->is_host_() == true))
+                   || ((this->matrix_ == this->matrix_accel_) && (in.is_accel_() == true)
+                       && (out->is_accel_() == true)));
 
-            if(err == false)
+            int ncol = in.GetNcol();
+
+            if(this->matrix_->ApplyMulti(ncol, *in.data_.vector_, out->data_.vector_) == false)
             {
-                // Convert to CSR
-                LocalMatrix<ValueType> mat_csr;
-                mat_csr.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_csr.CopyFrom(*this);
+                // Fall back to one matrix-vector product per column
+                LOG_VERBOSE_INFO(
+                    2,
+                    "*** warning: LocalMatrix::Apply() for LocalMultiVector is performed column "
+                    "by column");
 
-                mat_csr.ConvertToCSR();
+                LocalVector<ValueType> x;
+                LocalVector<ValueType> y;
 
-                // Try CSR format first
-                err = mat_csr.matrix_->ItLLSolve(
-                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
-                if((err == false) && (this->is_host_() == true))
-                {
-                    LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
-                    mat_csr.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+                x.CloneBackend(*this);
+                y.CloneBackend(*this);
 
-                // Try Host
-                LocalVector<ValueType> vec_host;
-                vec_host.CopyFrom(in);
+                x.Allocate("x", this->GetN());
+                y.Allocate("y", this->GetM());
 
-                vec_host.MoveToHost();
-                out->MoveToHost();
-                mat_csr.MoveToHost();
-
-                err = mat_csr.matrix_->ItLLSolve(
-                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
-                if((err == false))
-                {
-                    LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
-                    mat_csr.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
-
-                if(this->GetFormat() != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItLLSolve() is performed in CSR format");
-                }
-
-                if(this->is_accel_() == true)
+                for(int j = 0; j < ncol; ++j)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItLLSolve() is performed on the host");
-
-                    out->MoveToAccelerator();
+                    in.GetColumn(j, &x);
+                    this->Apply(x, &y);
+                    out->SetColumn(j, y);
                 }
             }
         }
+        else
+        {
+            // If matrix is empty, but not a 0x0 matrix, output needs to be set to zero
+            out->Zeros();
+        }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ItLLSolve(int                           max_iter,
-                                           double                        tolerance,
-                                           bool                          use_tol,
-                                           const LocalVector<ValueType>& in,
-                                           const LocalVector<ValueType>& inv_diag,
-                                           LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::ApplyAdd(const LocalMultiVector<ValueType>& in,
+                                          ValueType                          scalar,
+                                          LocalMultiVector<ValueType>*       out) const
     {
-        log_debug(this,
-                  "LocalMatrix::ItLLSolve()",
-                  max_iter,
-                  tolerance,
-                  use_tol,
-                  (const void*&)in,
-                  (const void*&)inv_diag,
-                  out);
+        log_debug(this, "LocalMatrix::ApplyAdd()", (const void*&)in, scalar, out);
 
         assert(out != NULL);
-        assert(in.GetSize() == this->GetN());
-        assert(out->GetSize() == this->GetM());
+        assert(in.GetNcol() == out->GetNcol());
 
-        assert(max_iter > 0);
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
 
-        if(use_tol == true)
+        if(this->GetNnz() > 0)
         {
-            assert(tolerance >= 0.0);
+            assert(in.GetNrow() == this->GetN());
+            assert(out->GetNrow() == this->GetM());
+
+            assert(((this->matrix_ == this->matrix_host_) && (in.is_host_() == true)
+                    && (out->is_host_() == true))
+                   || ((this->matrix_ == this->matrix_accel_) && (in.is_accel_() == true)
+                       && (out->is_accel_() == true)));
+
+            int ncol = in.GetNcol();
+
+            if(this->matrix_->ApplyAddMulti(ncol, *in.data_.vector_, scalar, out->data_.vector_)
+               == false)
+            {
+                // Fall back to one matrix-vector product per column
+                LOG_VERBOSE_INFO(
+                    2,
+                    "*** warning: LocalMatrix::ApplyAdd() for LocalMultiVector is performed "
+                    "column by column");
+
+                LocalVector<ValueType> x;
+                LocalVector<ValueType> y;
+
+                x.CloneBackend(*this);
+                y.CloneBackend(*this);
+
+                x.Allocate("x", this->GetN());
+                y.Allocate("y", this->GetM());
+
+                for(int j = 0; j < ncol; ++j)
+                {
+                    in.GetColumn(j, &x);
+                    out->GetColumn(j, &y);
+                    this->ApplyAdd(x, scalar, &y);
+                    out->SetColumn(j, y);
+                }
+            }
         }
+    }
 
-        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                && (out->vector_ == out->vector_host_)
-                && (inv_diag.vector_ == inv_diag.vector_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                   && (out->vector_ == out->vector_accel_)
-                   && (inv_diag.vector_ == inv_diag.vector_accel_)));
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ExtractDiagonal(LocalVector<ValueType>* vec_diag) const
+    {
+        log_debug(this, "LocalMatrix::ExtractDiagonal()", vec_diag);
+
+        assert(vec_diag != NULL);
+
+        assert(
+            ((this->matrix_ == this->matrix_host_) && (vec_diag->vector_ == vec_diag->vector_host_))
+            || ((this->matrix_ == this->matrix_accel_)
+                && (vec_diag->vector_ == vec_diag->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -3415,115 +4233,69 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->ItLLSolve(
-                max_iter, tolerance, use_tol, *in.vector_, *inv_diag.vector_, out->vector_);
+            std::string vec_diag_name = "Diagonal elements of " + this->object_name_;
+            vec_diag->Allocate(vec_diag_name, std::min(this->GetLocalM(), this->GetLocalN()));
+
+            bool err = this->matrix_->ExtractDiagonal(vec_diag->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
+                LOG_INFO("Computation of LocalMatrix::ExtractDiagonal() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                // Convert to CSR
-                LocalMatrix<ValueType> mat_csr;
-                mat_csr.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_csr.CopyFrom(*this);
-
-                mat_csr.ConvertToCSR();
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ExtractDiagonal()", this->is_accel_());
 
-                err = mat_csr.matrix_->ItLLSolve(
-                    max_iter, tolerance, use_tol, *in.vector_, *inv_diag.vector_, out->vector_);
-                if((err == false) && (this->is_host_() == true))
-                {
-                    LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
-                    mat_csr.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
 
-                // Try Host
-                LocalVector<ValueType> vec_host;
-                vec_host.CopyFrom(in);
+                vec_diag->MoveToHost();
 
-                vec_host.MoveToHost();
-                out->MoveToHost();
-                mat_csr.MoveToHost();
+                mat_host.ConvertToCSR();
 
-                err = mat_csr.matrix_->ItLLSolve(
-                    max_iter, tolerance, use_tol, *in.vector_, *inv_diag.vector_, out->vector_);
-                if((err == false))
+                if(mat_host.matrix_->ExtractDiagonal(vec_diag->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
-                    mat_csr.Info();
+                    LOG_INFO("Computation of LocalMatrix::ExtractDiagonal() failed");
+                    this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItLLSolve() is performed in CSR format");
+                        2,
+                        "*** warning: LocalMatrix::ExtractDiagonal() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItLLSolve() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ExtractDiagonal()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                    out->MoveToAccelerator();
+                    vec_diag->MoveToAccelerator();
                 }
             }
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ItLAnalyse(bool diag_unit)
-    {
-        log_debug(this, "LocalMatrix::ItLAnalyse()", diag_unit);
-
-        if(this->GetNnz() > 0)
-        {
-            this->matrix_->ItLAnalyse(diag_unit);
-        }
-    }
-
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::ItLAnalyseClear(void)
-    {
-        log_debug(this, "LocalMatrix::ItLAnalyseClear()");
-
-        if(this->GetNnz() > 0)
-        {
-            this->matrix_->ItLAnalyseClear();
-        }
-    }
-
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::ItLSolve(int                           max_iter,
-                                          double                        tolerance,
-                                          bool                          use_tol,
-                                          const LocalVector<ValueType>& in,
-                                          LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::ExtractInverseDiagonal(LocalVector<ValueType>* vec_inv_diag) const
     {
-        log_debug(
-            this, "LocalMatrix::ItLSolve()", max_iter, tolerance, use_tol, (const void*&)in, out);
-
-        assert(out != NULL);
-        assert(in.GetSize() == this->GetN());
-        assert(out->GetSize() == this->GetM());
-
-        assert(max_iter > 0);
+        log_debug(this, "LocalMatrix::ExtractInverseDiagonal()", vec_inv_diag);
 
-        if(use_tol == true)
-        {
-            assert(tolerance >= 0.0);
-        }
+        assert(vec_inv_diag != NULL);
 
-        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                && (out->vector_ == out->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                   && (out->vector_ == out->vector_accel_)));
+        assert(((this->matrix_ == this->matrix_host_)
+                && (vec_inv_diag->vector_ == vec_inv_diag->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (vec_inv_diag->vector_ == vec_inv_diag->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -3531,530 +4303,514 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err
-                = this->matrix_->ItLSolve(max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+            std::string vec_inv_diag_name
+                = "Inverse of the diagonal elements of " + this->object_name_;
+            vec_inv_diag->Allocate(vec_inv_diag_name,
+                                   std::min(this->GetLocalM(), this->GetLocalN()));
+
+            bool err = this->matrix_->ExtractInverseDiagonal(vec_inv_diag->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::ItLSolve() failed");
+                LOG_INFO("Computation of LocalMatrix::ExtractInverseDiagonal() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                // Convert to CSR
-                LocalMatrix<ValueType> mat_csr;
-                mat_csr.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_csr.CopyFrom(*this);
-
-                mat_csr.ConvertToCSR();
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ExtractInverseDiagonal()", this->is_accel_());
 
-                err = mat_csr.matrix_->ItLSolve(
-                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
-                if((err == false) && (this->is_host_() == true))
-                {
-                    LOG_INFO("Computation of LocalMatrix::ItLSolve() failed");
-                    mat_csr.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
 
-                // Try Host
-                LocalVector<ValueType> vec_host;
-                vec_host.CopyFrom(in);
+                vec_inv_diag->MoveToHost();
 
-                vec_host.MoveToHost();
-                out->MoveToHost();
-                mat_csr.MoveToHost();
+                mat_host.ConvertToCSR();
 
-                err = mat_csr.matrix_->ItLSolve(
-                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
-                if((err == false))
+                if(mat_host.matrix_->ExtractInverseDiagonal(vec_inv_diag->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::ItLSolve() failed");
-                    mat_csr.Info();
+                    LOG_INFO("Computation of LocalMatrix::ExtractInverseDiagonal() failed");
+                    this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItLSolve() is performed in CSR format");
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::ExtractInverseDiagonal() is "
+                                     "performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItLSolve() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ExtractInverseDiagonal()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                    out->MoveToAccelerator();
+                    vec_inv_diag->MoveToAccelerator();
                 }
             }
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ItUAnalyse(bool diag_unit)
+    void LocalMatrix<ValueType>::ExtractInverseBlockDiagonal(
+        int blockdim, LocalMatrix<ValueType>* inv_diag) const
     {
-        log_debug(this, "LocalMatrix::ItUAnalyse()", diag_unit);
+        log_debug(this, "LocalMatrix::ExtractInverseBlockDiagonal()", blockdim, inv_diag);
 
-        if(this->GetNnz() > 0)
-        {
-            this->matrix_->ItUAnalyse(diag_unit);
-        }
-    }
+        assert(blockdim > 0);
+        assert(inv_diag != NULL);
+        assert(inv_diag != this);
+        assert(this->GetM() == this->GetN());
+        assert(this->GetM() % blockdim == 0);
 
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::ItUAnalyseClear(void)
-    {
-        log_debug(this, "LocalMatrix::ItUAnalyseClear()");
+        assert(((this->matrix_ == this->matrix_host_)
+                && (inv_diag->matrix_ == inv_diag->matrix_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (inv_diag->matrix_ == inv_diag->matrix_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        // The block diagonal inverse is always stored in CSR format
+        inv_diag->Clear();
+        inv_diag->ConvertToCSR();
 
         if(this->GetNnz() > 0)
         {
-            this->matrix_->ItUAnalyseClear();
-        }
-    }
-
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::ItUSolve(int                           max_iter,
-                                          double                        tolerance,
-                                          bool                          use_tol,
-                                          const LocalVector<ValueType>& in,
-                                          LocalVector<ValueType>*       out) const
-    {
-        log_debug(
-            this, "LocalMatrix::ItUSolve()", max_iter, tolerance, use_tol, (const void*&)in, out);
-
-        assert(out != NULL);
-        assert(in.GetSize() == this->GetN());
-        assert(out->GetSize() == this->GetM());
-
-        assert(max_iter > 0);
-
-        if(use_tol == true)
-        {
-            assert(tolerance >= 0.0);
-        }
-
-        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
-                && (out->vector_ == out->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
-                   && (out->vector_ == out->vector_accel_)));
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
-
-        if(this->GetNnz() > 0)
-        {
-            bool err
-                = this->matrix_->ItUSolve(max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+            bool err = this->matrix_->ExtractInverseBlockDiagonal(blockdim, inv_diag->matrix_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::ItUSolve() failed");
+                LOG_INFO("Computation of LocalMatrix::ExtractInverseBlockDiagonal() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                // Convert to CSR
-                LocalMatrix<ValueType> mat_csr;
-                mat_csr.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_csr.CopyFrom(*this);
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::ExtractInverseBlockDiagonal()", this->is_accel_());
 
-                err = mat_csr.matrix_->ItUSolve(
-                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
-                if((err == false) && (this->is_host_() == true))
-                {
-                    LOG_INFO("Computation of LocalMatrix::ItUSolve() failed");
-                    mat_csr.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
 
-                // Try Host
-                LocalVector<ValueType> vec_host;
-                vec_host.CopyFrom(in);
+                inv_diag->MoveToHost();
 
-                vec_host.MoveToHost();
-                out->MoveToHost();
-                mat_csr.MoveToHost();
+                mat_host.ConvertToCSR();
 
-                err = mat_csr.matrix_->ItUSolve(
-                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
-                if((err == false))
+                if(mat_host.matrix_->ExtractInverseBlockDiagonal(blockdim, inv_diag->matrix_)
+                   == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::ItUSolve() failed");
-                    mat_csr.Info();
+                    LOG_INFO("Computation of LocalMatrix::ExtractInverseBlockDiagonal() failed");
+                    mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItUSolve() is performed in CSR format");
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::ExtractInverseBlockDiagonal() is "
+                                     "performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItUSolve() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ExtractInverseBlockDiagonal()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                    out->MoveToAccelerator();
+                    inv_diag->MoveToAccelerator();
                 }
             }
         }
+
+#ifdef DEBUG_MODE
+        inv_diag->Check();
+#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ILU0Factorize(void)
+    void LocalMatrix<ValueType>::ExtractRowL1Norm(LocalVector<ValueType>* vec_l1) const
     {
-        log_debug(this, "LocalMatrix::ILU0Factorize()");
+        log_debug(this, "LocalMatrix::ExtractRowL1Norm()", vec_l1);
+
+        assert(vec_l1 != NULL);
+
+        assert(((this->matrix_ == this->matrix_host_) && (vec_l1->vector_ == vec_l1->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (vec_l1->vector_ == vec_l1->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
+        std::string vec_l1_name = "Row l1 norms of " + this->object_name_;
+        vec_l1->Allocate(vec_l1_name, this->GetLocalM());
+
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->ILU0Factorize();
+            bool err = this->matrix_->ExtractRowL1Norm(vec_l1->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::ILU0Factorize() failed");
+                LOG_INFO("Computation of LocalMatrix::ExtractRowL1Norm() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                // Move to host
-                bool is_accel = this->is_accel_();
-                this->MoveToHost();
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::ExtractRowL1Norm()", this->is_accel_());
 
-                // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
 
-                if(this->matrix_->ILU0Factorize() == false)
+                vec_l1->MoveToHost();
+
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->ExtractRowL1Norm(vec_l1->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::ILU0Factorize() failed");
+                    LOG_INFO("Computation of LocalMatrix::ExtractRowL1Norm() failed");
                     this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != CSR)
+                if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ILU0Factorize() is performed in CSR format");
-
-                    this->ConvertTo(format, blockdim);
+                        2,
+                        "*** warning: LocalMatrix::ExtractRowL1Norm() is performed in CSR format");
                 }
 
-                if(is_accel == true)
+                if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ILU0Factorize() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ExtractRowL1Norm()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                    this->MoveToAccelerator();
+                    vec_l1->MoveToAccelerator();
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ItILU0Factorize(ItILU0Algorithm alg,
-                                                 int             option,
-                                                 int             max_iter,
-                                                 double          tolerance,
-                                                 int*            niter,
-                                                 double*         history)
+    void LocalMatrix<ValueType>::ExtractConnectedRows(const LocalVector<bool>& cols,
+                                                      LocalVector<bool>*       rows) const
     {
-        log_debug(this, "LocalMatrix::ItILU0Factorize()", alg, option, max_iter, tolerance);
+        log_debug(this, "LocalMatrix::ExtractConnectedRows()", (const void*&)cols, rows);
 
-        assert(option >= 0);
-        assert(max_iter > 0);
-        assert(tolerance > 0);
+        assert(rows != NULL);
+        assert(cols.GetSize() == this->GetN());
+
+        assert(((this->matrix_ == this->matrix_host_) && (cols.vector_ == cols.vector_host_)
+                && (rows->vector_ == rows->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (cols.vector_ == cols.vector_accel_)
+                   && (rows->vector_ == rows->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
+        std::string rows_name = "Connected rows of " + this->object_name_;
+        rows->Allocate(rows_name, this->GetLocalM());
+
         if(this->GetNnz() > 0)
         {
-            bool err
-                = this->matrix_->ItILU0Factorize(alg, option, max_iter, tolerance, niter, history);
+            bool err = this->matrix_->ExtractConnectedRows(*cols.vector_, rows->vector_);
 
-            if((err == false) && (this->GetFormat() == CSR) && (this->is_host_() == true))
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::ItILU0Factorize() failed");
+                LOG_INFO("Computation of LocalMatrix::ExtractConnectedRows() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                // Move to host
-                bool is_accel = this->is_accel_();
-                this->MoveToHost();
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::ExtractConnectedRows()", this->is_accel_());
 
-                // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                LocalMatrix<ValueType> mat_host;
+                LocalVector<bool>      cols_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+                cols_host.CopyFrom(cols);
 
-                // We fall back on standard ILU factorization (? assumption we know the implementation)
-                if(this->matrix_->ItILU0Factorize(alg, option, max_iter, tolerance, niter, history)
+                rows->MoveToHost();
+
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->ExtractConnectedRows(*cols_host.vector_, rows->vector_)
                    == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::ItILU0Factorize() failed");
+                    LOG_INFO("Computation of LocalMatrix::ExtractConnectedRows() failed");
                     this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != CSR)
+                if(this->GetFormat() != CSR)
                 {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::ItILU0Factorize() is performed in CSR format");
-
-                    this->ConvertTo(format, blockdim);
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::ExtractConnectedRows() is "
+                                     "performed in CSR format");
                 }
 
-                if(is_accel == true)
+                if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ItILU0Factorize() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ExtractConnectedRows()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                    this->MoveToAccelerator();
+                    rows->MoveToAccelerator();
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ILUTFactorize(double t, int maxrow)
+    void LocalMatrix<ValueType>::ExtractSubMatrix(int64_t                 row_offset,
+                                                  int64_t                 col_offset,
+                                                  int64_t                 row_size,
+                                                  int64_t                 col_size,
+                                                  LocalMatrix<ValueType>* mat) const
     {
-        log_debug(this, "LocalMatrix::ILUTFactorize()", t, maxrow);
+        log_debug(this,
+                  "LocalMatrix::ExtractSubMatrix()",
+                  row_offset,
+                  col_offset,
+                  row_size,
+                  col_size,
+                  mat);
+
+        assert(this != mat);
+        assert(mat != NULL);
+        assert(row_size >= 0);
+        assert(col_size >= 0);
+        assert(static_cast<int64_t>(row_offset) <= this->GetM());
+        assert(static_cast<int64_t>(col_offset) <= this->GetN());
+        assert(this->is_host_() == mat->is_host_());
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
-        assert(maxrow > 0);
-        assert(t >= 0.0);
+        // offsets and sizes are expected to be within 32 bits
+        assert(row_offset <= std::numeric_limits<int>::max());
+        assert(col_offset <= std::numeric_limits<int>::max());
+        assert(row_size <= std::numeric_limits<int>::max());
+        assert(col_size <= std::numeric_limits<int>::max());
 
-        if(this->GetNnz() > 0)
+        mat->Clear();
+
+        // Submatrix should be same format as full matrix
+        mat->ConvertTo(this->GetFormat(), this->GetBlockDimension());
+
+        bool err = false;
+
+        // if the sub matrix has only 1 row
+        // it is computed on the host
+        if((this->is_host_() == true) || (row_size > 1))
         {
-            bool err = this->matrix_->ILUTFactorize(t, maxrow);
+            err = this->matrix_->ExtractSubMatrix(static_cast<int>(row_offset),
+                                                  static_cast<int>(col_offset),
+                                                  static_cast<int>(row_size),
+                                                  static_cast<int>(col_size),
+                                                  mat->matrix_);
+        }
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::ExtractSubMatrix() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            // Single row sub-matrices are extracted on the host deliberately
+            double fallback_start = _rocalution_host_fallback_begin(
+                "LocalMatrix::ExtractSubMatrix()", this->is_accel_() && row_size > 1);
+
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+            mat_host.CopyFrom(*this);
+
+            mat->MoveToHost();
+
+            mat_host.ConvertToCSR();
+            mat->ConvertToCSR();
+
+            if(mat_host.matrix_->ExtractSubMatrix(static_cast<int>(row_offset),
+                                                  static_cast<int>(col_offset),
+                                                  static_cast<int>(row_size),
+                                                  static_cast<int>(col_size),
+                                                  mat->matrix_)
+               == false)
             {
-                LOG_INFO("Computation of LocalMatrix::ILUTFactorize() failed");
-                this->Info();
+                LOG_INFO("Computation of LocalMatrix::ExtractSubMatrix() failed");
+                mat_host.Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
-            if(err == false)
+            if(this->GetFormat() != CSR)
             {
-                // Move to host
-                bool is_accel = this->is_accel_();
-                this->MoveToHost();
-
-                // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
-
-                if(this->matrix_->ILUTFactorize(t, maxrow) == false)
+                if(row_size > 1)
                 {
-                    LOG_INFO("Computation of LocalMatrix::ILUTFactorize() failed");
-                    this->Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::ExtractSubMatrix() is "
+                                     "performed in CSR format");
                 }
 
-                if(format != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ILUTFactorize() is performed in CSR format");
+                mat->ConvertTo(this->GetFormat(), this->GetBlockDimension());
+            }
 
-                    this->ConvertTo(format, blockdim);
+            if(this->is_accel_() == true)
+            {
+                if(row_size > 1)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::ExtractSubMatrix()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
                 }
 
-                if(is_accel == true)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ILUTFactorize() is performed on the host");
+                mat->MoveToAccelerator();
+            }
 
-                    this->MoveToAccelerator();
-                }
+            if(row_size <= 1)
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: LocalMatrix::ExtractSubMatrix() is performed on "
+                                 "the host due to size = 1");
             }
         }
 
+        std::ostringstream row_begin;
+        std::ostringstream row_end;
+        std::ostringstream col_begin;
+        std::ostringstream col_end;
+
+        row_begin << row_offset;
+        row_end << row_offset + row_size - 1;
+        col_begin << col_offset;
+        col_end << col_offset + row_size - 1;
+
+        std::string mat_name
+            = "Submatrix of " + this->object_name_ + " " + "["
+              + row_begin
+                    .str() //static_cast<std::ostringstream*>(&(std::ostringstream() << row_offset))->str()
+              + ","
+              + col_begin
+                    .str() //static_cast<std::ostringstream*>(&(std::ostringstream() << col_offset))->str()
+              + "]-" + "["
+              + row_end.str() //static_cast<std::ostringstream*>(
+              //    &(std::ostringstream() << row_offset + row_size - 1))
+              //    ->str()
+              + ","
+              + col_end.str() //static_cast<std::ostringstream*>(
+              //&(std::ostringstream() << col_offset + row_size - 1))
+              //->str()
+              + "]";
+
+        mat->object_name_ = mat_name;
+
 #ifdef DEBUG_MODE
-        this->Check();
+        mat->Check();
 #endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ILUpFactorize(int p, bool level)
+    void LocalMatrix<ValueType>::ExtractSubMatrices(int                       row_num_blocks,
+                                                    int                       col_num_blocks,
+                                                    const int*                row_offset,
+                                                    const int*                col_offset,
+                                                    LocalMatrix<ValueType>*** mat) const
     {
-        log_debug(this, "LocalMatrix::ILUpFactorize()", p, level);
+        log_debug(this,
+                  "LocalMatrix::ExtractSubMatrices()",
+                  row_num_blocks,
+                  col_num_blocks,
+                  row_offset,
+                  col_offset,
+                  mat);
 
-        assert(p >= 0);
+        assert(row_num_blocks > 0);
+        assert(col_num_blocks > 0);
+        assert(row_offset != NULL);
+        assert(col_offset != NULL);
+        assert(mat != NULL);
+        assert(*mat != NULL);
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
-        if(p == 0)
-        {
-            this->ILU0Factorize();
-        }
-        else
+        if(this->GetNnz() > 0)
         {
-            if(this->GetNnz() > 0)
-            {
-                // with control levels
-                if(level == true)
-                {
-                    LocalMatrix structure;
-                    structure.CloneFrom(*this);
-                    structure.SymbolicPower(p + 1);
-
-                    bool err = this->matrix_->ILUpFactorizeNumeric(p, *structure.matrix_);
+            bool err = false;
 
-                    if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-                    {
-                        LOG_INFO("Computation of LocalMatrix::ILUpFactorize() failed");
-                        this->Info();
-                        FATAL_ERROR(__FILE__, __LINE__);
-                    }
+            // Extract all blocks in a single pass, if supported by the backend
+            if(this->GetFormat() == CSR)
+            {
+                std::vector<BaseMatrix<ValueType>*> blocks(row_num_blocks * col_num_blocks);
 
-                    if(err == false)
+                for(int i = 0; i < row_num_blocks; ++i)
+                {
+                    for(int j = 0; j < col_num_blocks; ++j)
                     {
-                        // Move to host
-                        bool is_accel = this->is_accel_();
-                        this->MoveToHost();
-                        structure.MoveToHost();
-
-                        // Convert to CSR
-                        unsigned int format   = this->GetFormat();
-                        int          blockdim = this->GetBlockDimension();
-                        this->ConvertToCSR();
-                        structure.ConvertToCSR();
-
-                        if(this->matrix_->ILUpFactorizeNumeric(p, *structure.matrix_) == false)
-                        {
-                            LOG_INFO("Computation of LocalMatrix::ILUpFactorize() failed");
-                            this->Info();
-                            FATAL_ERROR(__FILE__, __LINE__);
-                        }
-
-                        if(format != CSR)
-                        {
-                            LOG_VERBOSE_INFO(2,
-                                             "*** warning: LocalMatrix::ILUpFactorize() is "
-                                             "performed in CSR format");
-
-                            this->ConvertTo(format, blockdim);
-                        }
+                        assert(this != mat[i][j]);
+                        assert(this->is_host_() == mat[i][j]->is_host_());
 
-                        if(is_accel == true)
-                        {
-                            LOG_VERBOSE_INFO(2,
-                                             "*** warning: LocalMatrix::ILUpFactorize() is "
-                                             "performed on the host");
+                        mat[i][j]->Clear();
+                        mat[i][j]->ConvertToCSR();
 
-                            this->MoveToAccelerator();
-                        }
+                        blocks[i * col_num_blocks + j] = mat[i][j]->matrix_;
                     }
-
-                    // without control levels
                 }
-                else
-                {
-                    LocalMatrix values;
-                    values.CloneFrom(*this);
-
-                    this->SymbolicPower(p + 1);
-                    this->MatrixAdd(values);
-
-                    bool err = this->matrix_->ILU0Factorize();
 
-                    if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-                    {
-                        LOG_INFO("Computation of LocalMatrix::ILUpFactorize() failed");
-                        this->Info();
-                        FATAL_ERROR(__FILE__, __LINE__);
-                    }
+                err = this->matrix_->ExtractSubMatrices(
+                    row_num_blocks, col_num_blocks, row_offset, col_offset, blocks.data());
+            }
 
-                    if(err == false)
+            if(err == false)
+            {
+                // implementation via ExtractSubMatrix() calls
+                for(int i = 0; i < row_num_blocks; ++i)
+                {
+                    for(int j = 0; j < col_num_blocks; ++j)
                     {
-                        // Move to host
-                        bool is_accel = this->is_accel_();
-                        this->MoveToHost();
-
-                        // Convert to CSR
-                        unsigned int format   = this->GetFormat();
-                        int          blockdim = this->GetBlockDimension();
-                        this->ConvertToCSR();
-
-                        if(this->matrix_->ILU0Factorize() == false)
-                        {
-                            LOG_INFO("Computation of LocalMatrix::ILUpFactorize() failed");
-                            this->Info();
-                            FATAL_ERROR(__FILE__, __LINE__);
-                        }
-
-                        if(format != CSR)
-                        {
-                            LOG_VERBOSE_INFO(2,
-                                             "*** warning: LocalMatrix::ILUpFactorize() is "
-                                             "performed in CSR format");
-
-                            this->ConvertTo(format, blockdim);
-                        }
-
-                        if(is_accel == true)
-                        {
-                            LOG_VERBOSE_INFO(2,
-                                             "*** warning: LocalMatrix::ILUpFactorize() is "
-                                             "performed on the host");
-
-                            this->MoveToAccelerator();
-                        }
+                        this->ExtractSubMatrix(row_offset[i],
+                                               col_offset[j],
+                                               row_offset[i + 1] - row_offset[i],
+                                               col_offset[j + 1] - col_offset[j],
+                                               mat[i][j]);
                     }
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ICFactorize(LocalVector<ValueType>* inv_diag)
+    void LocalMatrix<ValueType>::ExtractU(LocalMatrix<ValueType>* U, bool diag) const
     {
-        log_debug(this, "LocalMatrix::ICFactorize()", inv_diag);
+        log_debug(this, "LocalMatrix::ExtractU()", U, diag);
 
-        assert(inv_diag != NULL);
+        assert(U != NULL);
+        assert(U != this);
 
-        assert(
-            ((this->matrix_ == this->matrix_host_) && (inv_diag->vector_ == inv_diag->vector_host_))
-            || ((this->matrix_ == this->matrix_accel_)
-                && (inv_diag->vector_ == inv_diag->vector_accel_)));
+        assert(((this->matrix_ == this->matrix_host_) && (U->matrix_ == U->matrix_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (U->matrix_ == U->matrix_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -4062,73 +4818,88 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->ICFactorize(inv_diag->vector_);
+            bool err = false;
+
+            if(diag == true)
+            {
+                err = this->matrix_->ExtractUDiagonal(U->matrix_);
+            }
+            else
+            {
+                err = this->matrix_->ExtractU(U->matrix_);
+            }
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::ICFactorize() failed");
+                LOG_INFO("Computation of LocalMatrix::ExtractU() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::ExtractU()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+
                 // Move to host
-                bool is_accel = this->is_accel_();
-                this->MoveToHost();
-                inv_diag->MoveToHost();
+                U->MoveToHost();
 
                 // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                mat_host.ConvertToCSR();
 
-                if(this->matrix_->ICFactorize(inv_diag->vector_) == false)
+                if(diag == true)
                 {
-                    LOG_INFO("Computation of LocalMatrix::ICFactorize() failed");
-                    this->Info();
+                    err = mat_host.matrix_->ExtractUDiagonal(U->matrix_);
+                }
+                else
+                {
+                    err = mat_host.matrix_->ExtractU(U->matrix_);
+                }
+
+                if(err == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::ExtractU() failed");
+                    mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != CSR)
+                if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ICFactorize() is performed in CSR format");
+                        2, "*** warning: LocalMatrix::ExtractU() is performed in CSR format");
 
-                    this->ConvertTo(format, blockdim);
+                    U->ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 }
 
-                if(is_accel == true)
+                if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ICFactorize() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ExtractU()", fallback_start, host_fallback_bytes(*this));
 
-                    this->MoveToAccelerator();
-                    inv_diag->MoveToAccelerator();
+                    U->MoveToAccelerator();
                 }
             }
         }
 
 #ifdef DEBUG_MODE
-        this->Check();
+        U->Check();
 #endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::MultiColoring(int&              num_colors,
-                                               int**             size_colors,
-                                               LocalVector<int>* permutation) const
+    void LocalMatrix<ValueType>::ExtractL(LocalMatrix<ValueType>* L, bool diag) const
     {
-        log_debug(this, "LocalMatrix::MultiColoring()", num_colors, size_colors, permutation);
+        log_debug(this, "LocalMatrix::ExtractL()", L, diag);
 
-        assert(*size_colors == NULL);
-        assert(permutation != NULL);
-        assert(this->GetM() == this->GetN());
+        assert(L != NULL);
+        assert(L != this);
 
-        assert(((this->matrix_ == this->matrix_host_)
-                && (permutation->vector_ == permutation->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_)
-                   && (permutation->vector_ == permutation->vector_accel_)));
+        assert(((this->matrix_ == this->matrix_host_) && (L->matrix_ == L->matrix_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (L->matrix_ == L->matrix_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -4136,69 +4907,114 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            std::string vec_perm_name = "MultiColoring permutation of " + this->object_name_;
-            permutation->Allocate(vec_perm_name, 0);
-            permutation->CloneBackend(*this);
+            bool err = false;
 
-            bool err = this->matrix_->MultiColoring(num_colors, size_colors, permutation->vector_);
+            if(diag == true)
+            {
+                err = this->matrix_->ExtractLDiagonal(L->matrix_);
+            }
+            else
+            {
+                err = this->matrix_->ExtractL(L->matrix_);
+            }
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::MultiColoring() failed");
+                LOG_INFO("Computation of LocalMatrix::ExtractL() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::ExtractL()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
 
                 // Move to host
-                permutation->MoveToHost();
+                L->MoveToHost();
 
                 // Convert to CSR
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->MultiColoring(num_colors, size_colors, permutation->vector_)
-                   == false)
+                if(diag == true)
                 {
-                    LOG_INFO("Computation of LocalMatrix::MultiColoring() failed");
-                    this->Info();
+                    err = mat_host.matrix_->ExtractLDiagonal(L->matrix_);
+                }
+                else
+                {
+                    err = mat_host.matrix_->ExtractL(L->matrix_);
+                }
+
+                if(err == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::ExtractL() failed");
+                    mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::MultiColoring() is performed in CSR format");
+                        2, "*** warning: LocalMatrix::ExtractL() is performed in CSR format");
+
+                    L->ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::MultiColoring() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ExtractL()", fallback_start, host_fallback_bytes(*this));
 
-                    permutation->MoveToAccelerator();
+                    L->MoveToAccelerator();
                 }
             }
         }
+
+#ifdef DEBUG_MODE
+        L->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::LUAnalyse(void)
+    {
+        log_debug(this, "LocalMatrix::LUAnalyse()");
+
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->LUAnalyse();
+        }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::MaximalIndependentSet(int&              size,
-                                                       LocalVector<int>* permutation) const
+    void LocalMatrix<ValueType>::LUAnalyseClear(void)
     {
-        log_debug(this, "LocalMatrix::MaximalIndependentSet()", size, permutation);
+        log_debug(this, "LocalMatrix::LUAnalyseClear()");
 
-        assert(permutation != NULL);
-        assert(this->GetM() == this->GetN());
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->LUAnalyseClear();
+        }
+    }
 
-        assert(((this->matrix_ == this->matrix_host_)
-                && (permutation->vector_ == permutation->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_)
-                   && (permutation->vector_ == permutation->vector_accel_)));
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::LUSolve(const LocalVector<ValueType>& in,
+                                         LocalVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalMatrix::LUSolve()", (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
+
+        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -4206,71 +5022,97 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            std::string vec_perm_name
-                = "MaximalIndependentSet permutation of " + this->object_name_;
-            permutation->Allocate(vec_perm_name, 0);
-            permutation->CloneBackend(*this);
-
-            bool err = this->matrix_->MaximalIndependentSet(size, permutation->vector_);
+            bool err = this->matrix_->LUSolve(*in.vector_, out->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::MaximalIndependentSet() failed");
+                LOG_INFO("Computation of LocalMatrix::LUSolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::LUSolve()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
 
-                // Move to host
-                permutation->MoveToHost();
+                LocalVector<ValueType> vec_host;
+                vec_host.CopyFrom(in);
 
-                // Convert to CSR
-                mat_host.ConvertToCSR();
+                out->MoveToHost();
 
-                if(mat_host.matrix_->MaximalIndependentSet(size, permutation->vector_) == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::MaximalIndependentSet() failed");
-                    this->Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+                // Try again
+                err = mat_host.matrix_->LUSolve(*vec_host.vector_, out->vector_);
 
-                if(this->GetFormat() != CSR)
+                if(err == false)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::MaximalIndependentSet() is "
-                                     "performed in CSR format");
+                    mat_host.ConvertToCSR();
+
+                    if(mat_host.matrix_->LUSolve(*vec_host.vector_, out->vector_) == false)
+                    {
+                        LOG_INFO("Computation of LocalMatrix::LUSolve() failed");
+                        mat_host.Info();
+                        FATAL_ERROR(__FILE__, __LINE__);
+                    }
+
+                    if(this->GetFormat() != CSR)
+                    {
+                        LOG_VERBOSE_INFO(
+                            2, "*** warning: LocalMatrix::LUSolve() is performed in CSR format");
+                    }
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::MaximalIndependentSet() is "
-                                     "performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::LUSolve()", fallback_start, host_fallback_bytes(*this));
 
-                    permutation->MoveToAccelerator();
+                    out->MoveToAccelerator();
                 }
             }
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ZeroBlockPermutation(int&              size,
-                                                      LocalVector<int>* permutation) const
+    void LocalMatrix<ValueType>::LLAnalyse(void)
     {
-        log_debug(this, "LocalMatrix::ZeroBlockPermutation()", size, permutation);
+        log_debug(this, "LocalMatrix::LLAnalyse()");
 
-        assert(permutation != NULL);
-        assert(this->GetM() == this->GetN());
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->LLAnalyse();
+        }
+    }
 
-        assert(((this->matrix_ == this->matrix_host_)
-                && (permutation->vector_ == permutation->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_)
-                   && (permutation->vector_ == permutation->vector_accel_)));
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::LLAnalyseClear(void)
+    {
+        log_debug(this, "LocalMatrix::LLAnalyseClear()");
+
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->LLAnalyseClear();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::LLSolve(const LocalVector<ValueType>& in,
+                                         LocalVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalMatrix::LLSolve()", (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
+
+        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -4278,65 +5120,72 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            std::string vec_perm_name = "ZeroBlockPermutation permutation of " + this->object_name_;
-            permutation->Allocate(vec_perm_name, this->GetLocalM());
-
-            bool err = this->matrix_->ZeroBlockPermutation(size, permutation->vector_);
+            bool err = this->matrix_->LLSolve(*in.vector_, out->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::ZeroBlockPermutation() failed");
+                LOG_INFO("Computation of LocalMatrix::LLSolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::LLSolve()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
 
-                // Move to host
-                permutation->MoveToHost();
+                LocalVector<ValueType> vec_host;
+                vec_host.CopyFrom(in);
+
+                out->MoveToHost();
 
-                // Convert to CSR
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->ZeroBlockPermutation(size, permutation->vector_) == false)
+                if(mat_host.matrix_->LLSolve(*vec_host.vector_, out->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::ZeroBlockPermutation() failed");
+                    LOG_INFO("Computation of LocalMatrix::LLSolve() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::ZeroBlockPermutation() is "
-                                     "performed in CSR format");
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::LLSolve() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::ZeroBlockPermutation() is "
-                                     "performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::LLSolve()", fallback_start, host_fallback_bytes(*this));
 
-                    permutation->MoveToAccelerator();
+                    out->MoveToAccelerator();
                 }
             }
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::Householder(int                     idx,
-                                             ValueType&              beta,
-                                             LocalVector<ValueType>* vec) const
+    void LocalMatrix<ValueType>::LLSolve(const LocalVector<ValueType>& in,
+                                         const LocalVector<ValueType>& inv_diag,
+                                         LocalVector<ValueType>*       out) const
     {
-        log_debug(this, "LocalMatrix::Householder()", idx, beta, vec);
+        log_debug(this, "LocalMatrix::LLSolve()", (const void*&)in, (const void*&)inv_diag, out);
 
-        assert(idx >= 0);
-        assert(vec != NULL);
+        assert(out != NULL);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
+
+        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_)
+                && (inv_diag.vector_ == inv_diag.vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)
+                   && (inv_diag.vector_ == inv_diag.vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -4344,112 +5193,87 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->Householder(idx, beta, vec->vector_);
+            bool err = this->matrix_->LLSolve(*in.vector_, *inv_diag.vector_, out->vector_);
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == DENSE))
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::Householder() failed");
+                LOG_INFO("Computation of LocalMatrix::LLSolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::LLSolve()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
 
-                vec->MoveToHost();
+                LocalVector<ValueType> vec_host;
+                vec_host.CopyFrom(in);
 
-                // Convert to DENSE
-                mat_host.ConvertToDENSE();
+                LocalVector<ValueType> inv_diag_host;
+                inv_diag_host.CopyFrom(inv_diag);
 
-                if(mat_host.matrix_->Householder(idx, beta, vec->vector_) == false)
+                out->MoveToHost();
+
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->LLSolve(
+                       *vec_host.vector_, *inv_diag_host.vector_, out->vector_)
+                   == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::Householder() failed");
+                    LOG_INFO("Computation of LocalMatrix::LLSolve() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(this->GetFormat() != DENSE)
+                if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Householder() is performed in DENSE format");
+                        2, "*** warning: LocalMatrix::LLSolve() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Householder() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::LLSolve()", fallback_start, host_fallback_bytes(*this));
 
-                    vec->MoveToAccelerator();
+                    out->MoveToAccelerator();
                 }
             }
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::QRDecompose(void)
+    void LocalMatrix<ValueType>::LAnalyse(bool diag_unit)
     {
-        log_debug(this, "LocalMatrix::QRDecompose()");
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+        log_debug(this, "LocalMatrix::LAnalyse()", diag_unit);
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->QRDecompose();
-
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == DENSE))
-            {
-                LOG_INFO("Computation of LocalMatrix::QRDecompose() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
-
-            if(err == false)
-            {
-                // Move to host
-                bool is_accel = this->is_accel_();
-                this->MoveToHost();
-
-                // Convert to DENSE
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToDENSE();
-
-                if(this->matrix_->QRDecompose() == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::QRDecompose() failed");
-                    this->Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
-
-                if(format != DENSE)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::QRDecompose() is performed in DENSE format");
-
-                    this->ConvertTo(format, blockdim);
-                }
+            this->matrix_->LAnalyse(diag_unit);
+        }
+    }
 
-                if(is_accel == true)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::QRDecompose() is performed on the host");
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::LAnalyseClear(void)
+    {
+        log_debug(this, "LocalMatrix::LAnalyseClear()");
 
-                    this->MoveToAccelerator();
-                }
-            }
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->LAnalyseClear();
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::QRSolve(const LocalVector<ValueType>& in,
-                                         LocalVector<ValueType>*       out) const
+    void LocalMatrix<ValueType>::LSolve(const LocalVector<ValueType>& in,
+                                        LocalVector<ValueType>*       out) const
     {
-        log_debug(this, "LocalMatrix::QRSolve()", (const void*&)in, out);
+        log_debug(this, "LocalMatrix::LSolve()", (const void*&)in, out);
 
         assert(out != NULL);
         assert(in.GetSize() == this->GetN());
@@ -4466,17 +5290,20 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->QRSolve(*in.vector_, out->vector_);
+            bool err = this->matrix_->LSolve(*in.vector_, out->vector_);
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == DENSE))
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::QRSolve() failed");
+                LOG_INFO("Computation of LocalMatrix::LSolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::LSolve()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
@@ -4484,29 +5311,27 @@ namespace rocalution
                 LocalVector<ValueType> vec_host;
                 vec_host.CopyFrom(in);
 
-                mat_host.MoveToHost();
-                vec_host.MoveToHost();
                 out->MoveToHost();
 
-                mat_host.ConvertToDENSE();
+                mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->QRSolve(*vec_host.vector_, out->vector_) == false)
+                if(mat_host.matrix_->LSolve(*vec_host.vector_, out->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::QRSolve() failed");
+                    LOG_INFO("Computation of LocalMatrix::LSolve() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(this->GetFormat() != DENSE)
+                if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::QRSolve() is performed in DENSE format");
+                        2, "*** warning: LocalMatrix::LSolve() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::QRSolve() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::LSolve()", fallback_start, host_fallback_bytes(*this));
 
                     out->MoveToAccelerator();
                 }
@@ -4515,17 +5340,41 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::Permute(const LocalVector<int>& permutation)
+    void LocalMatrix<ValueType>::UAnalyse(bool diag_unit)
     {
-        log_debug(this, "LocalMatrix::Permute()", (const void*&)permutation);
+        log_debug(this, "LocalMatrix::UAnalyse()", diag_unit);
 
-        assert((permutation.GetSize() == this->GetM()) || (permutation.GetSize() == this->GetN()));
-        assert(permutation.GetSize() > 0);
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->UAnalyse(diag_unit);
+        }
+    }
 
-        assert(((this->matrix_ == this->matrix_host_)
-                && (permutation.vector_ == permutation.vector_host_))
-               || ((this->matrix_ == this->matrix_accel_)
-                   && (permutation.vector_ == permutation.vector_accel_)));
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::UAnalyseClear(void)
+    {
+        log_debug(this, "LocalMatrix::UAnalyseClear()");
+
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->UAnalyseClear();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::USolve(const LocalVector<ValueType>& in,
+                                        LocalVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalMatrix::USolve()", (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
+
+        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -4533,172 +5382,179 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->Permute(*permutation.vector_);
+            bool err = this->matrix_->USolve(*in.vector_, out->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::Permute() failed");
+                LOG_INFO("Computation of LocalMatrix::USolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                LocalVector<int> perm_host;
-                perm_host.CopyFrom(permutation);
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::USolve()", this->is_accel_());
 
-                // Move to host
-                this->MoveToHost();
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
 
-                // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                LocalVector<ValueType> vec_host;
+                vec_host.CopyFrom(in);
 
-                if(this->matrix_->Permute(*perm_host.vector_) == false)
+                out->MoveToHost();
+
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->USolve(*vec_host.vector_, out->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::Permute() failed");
-                    this->Info();
+                    LOG_INFO("Computation of LocalMatrix::USolve() failed");
+                    mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != CSR)
+                if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Permute() is performed in CSR format");
-
-                    this->ConvertTo(format, blockdim);
+                        2, "*** warning: LocalMatrix::USolve() is performed in CSR format");
                 }
 
-                if(permutation.is_accel_() == true)
+                if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Permute() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::USolve()", fallback_start, host_fallback_bytes(*this));
 
-                    this->MoveToAccelerator();
+                    out->MoveToAccelerator();
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::PermuteBackward(const LocalVector<int>& permutation)
+    int LocalMatrix<ValueType>::GetTriangularLevels(bool lower) const
     {
-        log_debug(this, "LocalMatrix::PermuteBackward()", (const void*&)permutation);
-
-        assert((permutation.GetSize() == this->GetM()) || (permutation.GetSize() == this->GetN()));
-        assert(permutation.GetSize() > 0);
+        log_debug(this, "LocalMatrix::GetTriangularLevels()", lower);
 
-        assert(((this->matrix_ == this->matrix_host_)
-                && (permutation.vector_ == permutation.vector_host_))
-               || ((this->matrix_ == this->matrix_accel_)
-                   && (permutation.vector_ == permutation.vector_accel_)));
+        assert(this->GetM() == this->GetN());
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
+        int levels = 0;
+
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->PermuteBackward(*permutation.vector_);
+            bool err = this->matrix_->TriangularLevels(lower, &levels);
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == COO))
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::PermuteBackward() failed");
+                LOG_INFO("Computation of LocalMatrix::GetTriangularLevels() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                LocalVector<int> perm_host;
-                perm_host.CopyFrom(permutation);
+                // The dependency graph is traversed sequentially, it is computed on the host
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::GetTriangularLevels()", this->is_accel_());
 
-                // Move to host
-                this->MoveToHost();
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
 
-                // Convert to COO
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCOO();
+                mat_host.ConvertToCSR();
 
-                if(this->matrix_->PermuteBackward(*perm_host.vector_) == false)
+                if(mat_host.matrix_->TriangularLevels(lower, &levels) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::PermuteBackward() failed");
-                    this->Info();
+                    LOG_INFO("Computation of LocalMatrix::GetTriangularLevels() failed");
+                    mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != COO)
+                if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
                         2,
-                        "*** warning: LocalMatrix::PermuteBackward() is performed in COO format");
-
-                    this->ConvertTo(format, blockdim);
+                        "*** warning: LocalMatrix::GetTriangularLevels() is performed in CSR "
+                        "format");
                 }
 
-                if(permutation.is_accel_() == true)
+                if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::PermuteBackward() is performed on the host");
-
-                    this->MoveToAccelerator();
+                    _rocalution_host_fallback_end("LocalMatrix::GetTriangularLevels()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
                 }
             }
         }
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+        return levels;
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::CMK(LocalVector<int>* permutation) const
+    void LocalMatrix<ValueType>::TriangularBlockInverse(bool                    lower,
+                                                        bool                    diag_unit,
+                                                        int                     block_size,
+                                                        LocalMatrix<ValueType>* inv,
+                                                        LocalMatrix<ValueType>* off) const
     {
-        log_debug(this, "LocalMatrix::CMK()", permutation);
-
-        assert(permutation != NULL);
+        log_debug(this, "LocalMatrix::TriangularBlockInverse()", lower, diag_unit, block_size);
 
-        assert(((this->matrix_ == this->matrix_host_)
-                && (permutation->vector_ == permutation->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_)
-                   && (permutation->vector_ == permutation->vector_accel_)));
+        assert(inv != NULL);
+        assert(off != NULL);
+        assert(inv != this);
+        assert(off != this);
+        assert(inv != off);
+        assert(block_size > 0);
+        assert(this->GetM() == this->GetN());
+        assert(this->is_host_() == inv->is_host_());
+        assert(this->is_host_() == off->is_host_());
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
+        inv->Clear();
+        inv->ConvertToCSR();
+        off->Clear();
+        off->ConvertToCSR();
+
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->CMK(permutation->vector_);
+            bool err = this->matrix_->TriangularBlockInverse(
+                lower, diag_unit, block_size, inv->matrix_, off->matrix_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::CMK() failed");
+                LOG_INFO("Computation of LocalMatrix::TriangularBlockInverse() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::TriangularBlockInverse()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
 
                 // Move to host
-                permutation->MoveToHost();
+                inv->MoveToHost();
+                off->MoveToHost();
 
                 // Convert to CSR
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->CMK(permutation->vector_) == false)
+                if(mat_host.matrix_->TriangularBlockInverse(
+                       lower, diag_unit, block_size, inv->matrix_, off->matrix_)
+                   == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::CMK() failed");
+                    LOG_INFO("Computation of LocalMatrix::TriangularBlockInverse() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
@@ -4706,37 +5562,74 @@ namespace rocalution
                 if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::CMK() is performed in CSR format");
+                                     "*** warning: LocalMatrix::TriangularBlockInverse() is "
+                                     "performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2, "*** warning: LocalMatrix::CMK() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::TriangularBlockInverse()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                    permutation->MoveToAccelerator();
+                    inv->MoveToAccelerator();
+                    off->MoveToAccelerator();
                 }
             }
         }
 
-        std::string vec_name      = "CMK permutation of " + this->object_name_;
-        permutation->object_name_ = vec_name;
-
 #ifdef DEBUG_MODE
-        this->Check();
+        inv->Check();
+        off->Check();
 #endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::RCMK(LocalVector<int>* permutation) const
+    void LocalMatrix<ValueType>::ItLUAnalyse(void)
     {
-        log_debug(this, "LocalMatrix::RCMK()", permutation);
+        log_debug(this, "LocalMatrix::ItLUAnalyse()");
 
-        assert(permutation != NULL);
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->ItLUAnalyse();
+        }
+    }
 
-        assert(((this->matrix_ == this->matrix_host_)
-                && (permutation->vector_ == permutation->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_)
-                   && (permutation->vector_ == permutation->vector_accel_)));
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ItLUAnalyseClear(void)
+    {
+        log_debug(this, "LocalMatrix::ItLUAnalyseClear()");
+
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->ItLUAnalyseClear();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ItLUSolve(int                           max_iter,
+                                           double                        tolerance,
+                                           bool                          use_tol,
+                                           const LocalVector<ValueType>& in,
+                                           LocalVector<ValueType>*       out) const
+    {
+        log_debug(
+            this, "LocalMatrix::ItLUSolve()", max_iter, tolerance, use_tol, (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
+        assert(max_iter > 0);
+
+        if(use_tol == true)
+        {
+            assert(tolerance >= 0.0);
+        }
+
+        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -4744,69 +5637,119 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->RCMK(permutation->vector_);
+            bool err
+                = this->matrix_->ItLUSolve(max_iter, tolerance, use_tol, *in.vector_, out->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::RCMK() failed");
+                LOG_INFO("Computation of LocalMatrix::ItLUSolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
-
-                // Move to host
-                permutation->MoveToHost();
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ItLUSolve()", this->is_accel_());
 
                 // Convert to CSR
-                mat_host.ConvertToCSR();
+                LocalMatrix<ValueType> mat_csr;
+                mat_csr.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_csr.CopyFrom(*this);
 
-                if(mat_host.matrix_->RCMK(permutation->vector_) == false)
+                mat_csr.ConvertToCSR();
+
+                // Try CSR format first
+                err = mat_csr.matrix_->ItLUSolve(
+                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+                if((err == false) && (this->is_host_() == true))
                 {
-                    LOG_INFO("Computation of LocalMatrix::RCMK() failed");
-                    mat_host.Info();
+                    LOG_INFO("Computation of LocalMatrix::ItLUSolve() failed");
+                    mat_csr.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                // Try Host
+                LocalVector<ValueType> vec_host;
+                vec_host.CopyFrom(in);
+
+                vec_host.MoveToHost();
+                out->MoveToHost();
+                mat_csr.MoveToHost();
+
+                err = mat_csr.matrix_->ItLUSolve(
+                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+                if((err == false))
+                {
+                    LOG_INFO("Computation of LocalMatrix::ItLUSolve() failed");
+                    mat_csr.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::RCMK() is performed in CSR format");
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::ItLUSolve() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::RCMK() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ItLUSolve()", fallback_start, host_fallback_bytes(*this));
 
-                    permutation->MoveToAccelerator();
+                    out->MoveToAccelerator();
                 }
             }
         }
+    }
 
-        std::string vec_name      = "RCMK permutation of " + this->object_name_;
-        permutation->object_name_ = vec_name;
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ItLLAnalyse(void)
+    {
+        log_debug(this, "LocalMatrix::ItLLAnalyse()");
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->ItLLAnalyse();
+        }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ConnectivityOrder(LocalVector<int>* permutation) const
+    void LocalMatrix<ValueType>::ItLLAnalyseClear(void)
     {
-        log_debug(this, "LocalMatrix::ConnectivityOrder()", permutation);
+        log_debug(this, "LocalMatrix::ItLLAnalyseClear()");
 
-        assert(permutation != NULL);
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->ItLLAnalyseClear();
+        }
+    }
 
-        assert(((this->matrix_ == this->matrix_host_)
-                && (permutation->vector_ == permutation->vector_host_))
-               || ((this->matrix_ == this->matrix_accel_)
-                   && (permutation->vector_ == permutation->vector_accel_)));
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ItLLSolve(int                           max_iter,
+                                           double                        tolerance,
+                                           bool                          use_tol,
+                                           const LocalVector<ValueType>& in,
+                                           LocalVector<ValueType>*       out) const
+    {
+        log_debug(
+            this, "LocalMatrix::ItLLSolve()", max_iter, tolerance, use_tol, (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
+        assert(max_iter > 0);
+
+        if(use_tol == true)
+        {
+            assert(tolerance >= 0.0);
+        }
+
+        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -4814,62 +5757,107 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->ConnectivityOrder(permutation->vector_);
+            bool err
+                = this->matrix_->ItLLSolve(max_iter, tolerance, use_tol, *in.vector_, out->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::ConnectivityOrder() failed");
+                LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
-
-                // Move to host
-                permutation->MoveToHost();
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ItLLSolve()", this->is_accel_());
 
                 // Convert to CSR
-                mat_host.ConvertToCSR();
+                LocalMatrix<ValueType> mat_csr;
+                mat_csr.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_csr.CopyFrom(*this);
 
-                if(mat_host.matrix_->ConnectivityOrder(permutation->vector_) == false)
+                mat_csr.ConvertToCSR();
+
+                // Try CSR format first
+                err = mat_csr.matrix_->ItLLSolve(
+                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+                if((err == false) && (this->is_host_() == true))
                 {
-                    LOG_INFO("Computation of LocalMatrix::ConnectivityOrder() failed");
-                    mat_host.Info();
+                    LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
+                    mat_csr.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                // Try Host
+                LocalVector<ValueType> vec_host;
+                vec_host.CopyFrom(in);
+
+                vec_host.MoveToHost();
+                out->MoveToHost();
+                mat_csr.MoveToHost();
+
+                err = mat_csr.matrix_->ItLLSolve(
+                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+                if((err == false))
+                {
+                    LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
+                    mat_csr.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::ConnectivityOrder() is performed in CSR format");
+                        2, "*** warning: LocalMatrix::ItLLSolve() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::ConnectivityOrder() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ItLLSolve()", fallback_start, host_fallback_bytes(*this));
 
-                    permutation->MoveToAccelerator();
+                    out->MoveToAccelerator();
                 }
             }
         }
-
-        std::string vec_name      = "ConnectivityOrder permutation of " + this->object_name_;
-        permutation->object_name_ = vec_name;
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::SymbolicPower(int p)
+    void LocalMatrix<ValueType>::ItLLSolve(int                           max_iter,
+                                           double                        tolerance,
+                                           bool                          use_tol,
+                                           const LocalVector<ValueType>& in,
+                                           const LocalVector<ValueType>& inv_diag,
+                                           LocalVector<ValueType>*       out) const
     {
-        log_debug(this, "LocalMatrix::SymbolicPower()", p);
+        log_debug(this,
+                  "LocalMatrix::ItLLSolve()",
+                  max_iter,
+                  tolerance,
+                  use_tol,
+                  (const void*&)in,
+                  (const void*&)inv_diag,
+                  out);
 
-        assert(p >= 1);
+        assert(out != NULL);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
+
+        assert(max_iter > 0);
+
+        if(use_tol == true)
+        {
+            assert(tolerance >= 0.0);
+        }
+
+        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_)
+                && (inv_diag.vector_ == inv_diag.vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)
+                   && (inv_diag.vector_ == inv_diag.vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -4877,130 +5865,119 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->SymbolicPower(p);
+            bool err = this->matrix_->ItLLSolve(
+                max_iter, tolerance, use_tol, *in.vector_, *inv_diag.vector_, out->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::SymbolicPower() failed");
+                LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                // Move to host
-                bool is_accel = this->is_accel_();
-                this->MoveToHost();
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ItLLSolve()", this->is_accel_());
 
                 // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                LocalMatrix<ValueType> mat_csr;
+                mat_csr.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_csr.CopyFrom(*this);
 
-                if(this->matrix_->SymbolicPower(p) == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::SymbolicPower() failed");
-                    this->Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+                mat_csr.ConvertToCSR();
 
-                if(format != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::SymbolicPower() is performed in CSR format");
+                err = mat_csr.matrix_->ItLLSolve(
+                    max_iter, tolerance, use_tol, *in.vector_, *inv_diag.vector_, out->vector_);
+                if((err == false) && (this->is_host_() == true))
+                {
+                    LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
+                    mat_csr.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
 
-                    this->ConvertTo(format, blockdim);
+                // Try Host
+                LocalVector<ValueType> vec_host;
+                vec_host.CopyFrom(in);
+
+                vec_host.MoveToHost();
+                out->MoveToHost();
+                mat_csr.MoveToHost();
+
+                err = mat_csr.matrix_->ItLLSolve(
+                    max_iter, tolerance, use_tol, *in.vector_, *inv_diag.vector_, out->vector_);
+                if((err == false))
+                {
+                    LOG_INFO("Computation of LocalMatrix::ItLLSolve() failed");
+                    mat_csr.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(is_accel == true)
+                if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::SymbolicPower() is performed on the host");
+                        2, "*** warning: LocalMatrix::ItLLSolve() is performed in CSR format");
+                }
 
-                    this->MoveToAccelerator();
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ItLLSolve()", fallback_start, host_fallback_bytes(*this));
+
+                    out->MoveToAccelerator();
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::MatrixAdd(const LocalMatrix<ValueType>& mat,
-                                           ValueType                     alpha,
-                                           ValueType                     beta,
-                                           bool                          structure)
+    void LocalMatrix<ValueType>::ItLAnalyse(bool diag_unit)
     {
-        log_debug(this, "LocalMatrix::MatrixAdd()", (const void*&)mat, alpha, beta, structure);
-
-        assert(&mat != this);
-        assert(this->GetFormat() == mat.GetFormat());
-        assert(this->GetM() == mat.GetM());
-        assert(this->GetN() == mat.GetN());
-
-        assert(((this->matrix_ == this->matrix_host_) && (mat.matrix_ == mat.matrix_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (mat.matrix_ == mat.matrix_accel_)));
-
-#ifdef DEBUG_MODE
-        this->Check();
-        mat.Check();
-#endif
-
-        bool err = this->matrix_->MatrixAdd(*mat.matrix_, alpha, beta, structure);
+        log_debug(this, "LocalMatrix::ItLAnalyse()", diag_unit);
 
-        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        if(this->GetNnz() > 0)
         {
-            LOG_INFO("Computation of LocalMatrix::MatrixAdd() failed");
-            this->Info();
-            FATAL_ERROR(__FILE__, __LINE__);
+            this->matrix_->ItLAnalyse(diag_unit);
         }
+    }
 
-        if(err == false)
-        {
-            LocalMatrix<ValueType> mat_host;
-            mat_host.ConvertTo(mat.GetFormat(), this->GetBlockDimension());
-            mat_host.CopyFrom(mat);
-
-            this->MoveToHost();
-
-            this->ConvertToCSR();
-            mat_host.ConvertToCSR();
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ItLAnalyseClear(void)
+    {
+        log_debug(this, "LocalMatrix::ItLAnalyseClear()");
 
-            if(this->matrix_->MatrixAdd(*mat_host.matrix_, alpha, beta, structure) == false)
-            {
-                LOG_INFO("Computation of LocalMatrix::MatrixAdd() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->ItLAnalyseClear();
+        }
+    }
 
-            if(mat.GetFormat() != CSR)
-            {
-                LOG_VERBOSE_INFO(
-                    2, "*** warning: LocalMatrix::MatrixAdd() is performed in CSR format");
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ItLSolve(int                           max_iter,
+                                          double                        tolerance,
+                                          bool                          use_tol,
+                                          const LocalVector<ValueType>& in,
+                                          LocalVector<ValueType>*       out) const
+    {
+        log_debug(
+            this, "LocalMatrix::ItLSolve()", max_iter, tolerance, use_tol, (const void*&)in, out);
 
-                this->ConvertTo(mat.GetFormat(), this->GetBlockDimension());
-            }
+        assert(out != NULL);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
 
-            if(mat.is_accel_() == true)
-            {
-                LOG_VERBOSE_INFO(2,
-                                 "*** warning: LocalMatrix::MatrixAdd() is performed on the host");
+        assert(max_iter > 0);
 
-                this->MoveToAccelerator();
-            }
+        if(use_tol == true)
+        {
+            assert(tolerance >= 0.0);
         }
 
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
-    }
-
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const
-    {
-        log_debug(this, "LocalMatrix::Gershgorin()");
+        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -5008,50 +5985,118 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->Gershgorin(lambda_min, lambda_max);
+            bool err
+                = this->matrix_->ItLSolve(max_iter, tolerance, use_tol, *in.vector_, out->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::Gershgorin() failed");
+                LOG_INFO("Computation of LocalMatrix::ItLSolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::ItLSolve()", this->is_accel_());
 
                 // Convert to CSR
-                mat_host.ConvertToCSR();
+                LocalMatrix<ValueType> mat_csr;
+                mat_csr.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_csr.CopyFrom(*this);
 
-                if(mat_host.matrix_->Gershgorin(lambda_min, lambda_max) == false)
+                mat_csr.ConvertToCSR();
+
+                err = mat_csr.matrix_->ItLSolve(
+                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+                if((err == false) && (this->is_host_() == true))
                 {
-                    LOG_INFO("Computation of LocalMatrix::Gershgorin() failed");
-                    mat_host.Info();
+                    LOG_INFO("Computation of LocalMatrix::ItLSolve() failed");
+                    mat_csr.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                // Try Host
+                LocalVector<ValueType> vec_host;
+                vec_host.CopyFrom(in);
+
+                vec_host.MoveToHost();
+                out->MoveToHost();
+                mat_csr.MoveToHost();
+
+                err = mat_csr.matrix_->ItLSolve(
+                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+                if((err == false))
+                {
+                    LOG_INFO("Computation of LocalMatrix::ItLSolve() failed");
+                    mat_csr.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Gershgorin() is performed in CSR format");
+                        2, "*** warning: LocalMatrix::ItLSolve() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Gershgorin() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ItLSolve()", fallback_start, host_fallback_bytes(*this));
+
+                    out->MoveToAccelerator();
                 }
             }
         }
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::Scale(ValueType alpha)
+    void LocalMatrix<ValueType>::ItUAnalyse(bool diag_unit)
     {
-        log_debug(this, "LocalMatrix::Scale()", alpha);
+        log_debug(this, "LocalMatrix::ItUAnalyse()", diag_unit);
+
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->ItUAnalyse(diag_unit);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ItUAnalyseClear(void)
+    {
+        log_debug(this, "LocalMatrix::ItUAnalyseClear()");
+
+        if(this->GetNnz() > 0)
+        {
+            this->matrix_->ItUAnalyseClear();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ItUSolve(int                           max_iter,
+                                          double                        tolerance,
+                                          bool                          use_tol,
+                                          const LocalVector<ValueType>& in,
+                                          LocalVector<ValueType>*       out) const
+    {
+        log_debug(
+            this, "LocalMatrix::ItUSolve()", max_iter, tolerance, use_tol, (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
+
+        assert(max_iter > 0);
+
+        if(use_tol == true)
+        {
+            assert(tolerance >= 0.0);
+        }
+
+        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -5059,60 +6104,73 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->Scale(alpha);
+            bool err
+                = this->matrix_->ItUSolve(max_iter, tolerance, use_tol, *in.vector_, out->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::Scale() failed");
+                LOG_INFO("Computation of LocalMatrix::ItUSolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                // Move to host
-                bool is_accel = this->is_accel_();
-                this->MoveToHost();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::ItUSolve()", this->is_accel_());
 
                 // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                LocalMatrix<ValueType> mat_csr;
+                mat_csr.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_csr.CopyFrom(*this);
 
-                if(this->matrix_->Scale(alpha) == false)
+                err = mat_csr.matrix_->ItUSolve(
+                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+                if((err == false) && (this->is_host_() == true))
                 {
-                    LOG_INFO("Computation of LocalMatrix::Scale() failed");
-                    this->Info();
+                    LOG_INFO("Computation of LocalMatrix::ItUSolve() failed");
+                    mat_csr.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Scale() is performed in CSR format");
-
-                    this->ConvertTo(format, blockdim);
-                }
+                // Try Host
+                LocalVector<ValueType> vec_host;
+                vec_host.CopyFrom(in);
 
-                if(is_accel == true)
+                vec_host.MoveToHost();
+                out->MoveToHost();
+                mat_csr.MoveToHost();
+
+                err = mat_csr.matrix_->ItUSolve(
+                    max_iter, tolerance, use_tol, *in.vector_, out->vector_);
+                if((err == false))
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::Scale() is performed on the host");
+                    LOG_INFO("Computation of LocalMatrix::ItUSolve() failed");
+                    mat_csr.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
 
-                    this->MoveToAccelerator();
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::ItUSolve() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ItUSolve()", fallback_start, host_fallback_bytes(*this));
+
+                    out->MoveToAccelerator();
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ScaleDiagonal(ValueType alpha)
+    void LocalMatrix<ValueType>::ILU0Factorize(void)
     {
-        log_debug(this, "LocalMatrix::ScaleDiagonal()", alpha);
+        log_debug(this, "LocalMatrix::ILU0Factorize()");
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -5120,11 +6178,11 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->ScaleDiagonal(alpha);
+            bool err = this->matrix_->ILU0Factorize();
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::ScaleDiagonal() failed");
+                LOG_INFO("Computation of LocalMatrix::ILU0Factorize() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
@@ -5133,6 +6191,8 @@ namespace rocalution
             {
                 // Move to host
                 bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::ILU0Factorize()", is_accel);
                 this->MoveToHost();
 
                 // Convert to CSR
@@ -5140,9 +6200,9 @@ namespace rocalution
                 int          blockdim = this->GetBlockDimension();
                 this->ConvertToCSR();
 
-                if(this->matrix_->ScaleDiagonal(alpha) == false)
+                if(this->matrix_->ILU0Factorize() == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::ScaleDiagonal() failed");
+                    LOG_INFO("Computation of LocalMatrix::ILU0Factorize() failed");
                     this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
@@ -5150,15 +6210,15 @@ namespace rocalution
                 if(format != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ScaleDiagonal() is performed in CSR format");
+                        2, "*** warning: LocalMatrix::ILU0Factorize() is performed in CSR format");
 
                     this->ConvertTo(format, blockdim);
                 }
 
                 if(is_accel == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ScaleDiagonal() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ILU0Factorize()", fallback_start, host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -5171,9 +6231,18 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::ScaleOffDiagonal(ValueType alpha)
+    void LocalMatrix<ValueType>::ItILU0Factorize(ItILU0Algorithm alg,
+                                                 int             option,
+                                                 int             max_iter,
+                                                 double          tolerance,
+                                                 int*            niter,
+                                                 double*         history)
     {
-        log_debug(this, "LocalMatrix::ScaleOffDiagonal()", alpha);
+        log_debug(this, "LocalMatrix::ItILU0Factorize()", alg, option, max_iter, tolerance);
+
+        assert(option >= 0);
+        assert(max_iter > 0);
+        assert(tolerance > 0);
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -5181,11 +6250,12 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->ScaleOffDiagonal(alpha);
+            bool err
+                = this->matrix_->ItILU0Factorize(alg, option, max_iter, tolerance, niter, history);
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            if((err == false) && (this->GetFormat() == CSR) && (this->is_host_() == true))
             {
-                LOG_INFO("Computation of LocalMatrix::ScaleOffDiagonal() failed");
+                LOG_INFO("Computation of LocalMatrix::ItILU0Factorize() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
@@ -5194,6 +6264,8 @@ namespace rocalution
             {
                 // Move to host
                 bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::ItILU0Factorize()", is_accel);
                 this->MoveToHost();
 
                 // Convert to CSR
@@ -5201,9 +6273,11 @@ namespace rocalution
                 int          blockdim = this->GetBlockDimension();
                 this->ConvertToCSR();
 
-                if(this->matrix_->ScaleOffDiagonal(alpha) == false)
+                // Fixed-point ILU0 on the host
+                if(this->matrix_->ItILU0Factorize(alg, option, max_iter, tolerance, niter, history)
+                   == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::ScaleOffDiagonal() failed");
+                    LOG_INFO("Computation of LocalMatrix::ItILU0Factorize() failed");
                     this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
@@ -5212,15 +6286,16 @@ namespace rocalution
                 {
                     LOG_VERBOSE_INFO(
                         2,
-                        "*** warning: LocalMatrix::ScaleOffDiagonal() is performed in CSR format");
+                        "*** warning: LocalMatrix::ItILU0Factorize() is performed in CSR format");
 
                     this->ConvertTo(format, blockdim);
                 }
 
                 if(is_accel == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ScaleOffDiagonal() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ItILU0Factorize()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -5233,21 +6308,24 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AddScalar(ValueType alpha)
+    void LocalMatrix<ValueType>::ILUTFactorize(double t, int maxrow)
     {
-        log_debug(this, "LocalMatrix::AddScalar()", alpha);
+        log_debug(this, "LocalMatrix::ILUTFactorize()", t, maxrow);
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
+        assert(maxrow > 0);
+        assert(t >= 0.0);
+
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->AddScalar(alpha);
+            bool err = this->matrix_->ILUTFactorize(t, maxrow);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::AddScalar() failed");
+                LOG_INFO("Computation of LocalMatrix::ILUTFactorize() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
@@ -5256,6 +6334,8 @@ namespace rocalution
             {
                 // Move to host
                 bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::ILUTFactorize()", is_accel);
                 this->MoveToHost();
 
                 // Convert to CSR
@@ -5263,9 +6343,9 @@ namespace rocalution
                 int          blockdim = this->GetBlockDimension();
                 this->ConvertToCSR();
 
-                if(this->matrix_->AddScalar(alpha) == false)
+                if(this->matrix_->ILUTFactorize(t, maxrow) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::AddScalar() failed");
+                    LOG_INFO("Computation of LocalMatrix::ILUTFactorize() failed");
                     this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
@@ -5273,15 +6353,15 @@ namespace rocalution
                 if(format != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::AddScalar() is performed in CSR format");
+                        2, "*** warning: LocalMatrix::ILUTFactorize() is performed in CSR format");
 
                     this->ConvertTo(format, blockdim);
                 }
 
                 if(is_accel == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::AddScalar() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ILUTFactorize()", fallback_start, host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -5294,59 +6374,140 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AddScalarDiagonal(ValueType alpha)
+    void LocalMatrix<ValueType>::ILUpFactorize(int p, bool level)
     {
-        log_debug(this, "LocalMatrix::AddScalarDiagonal()", alpha);
+        log_debug(this, "LocalMatrix::ILUpFactorize()", p, level);
+
+        assert(p >= 0);
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
-        if(this->GetNnz() > 0)
+        if(p == 0)
         {
-            bool err = this->matrix_->AddScalarDiagonal(alpha);
-
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            this->ILU0Factorize();
+        }
+        else
+        {
+            if(this->GetNnz() > 0)
             {
-                LOG_INFO("Computation of LocalMatrix::AddScalarDiagonal() failed");
-                this->Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
+                // with control levels
+                if(level == true)
+                {
+                    LocalMatrix structure;
+                    structure.CloneFrom(*this);
+                    structure.SymbolicPower(p + 1);
 
-            if(err == false)
-            {
-                // Move to host
-                bool is_accel = this->is_accel_();
-                this->MoveToHost();
+                    bool err = this->matrix_->ILUpFactorizeNumeric(p, *structure.matrix_);
 
-                // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                    if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+                    {
+                        LOG_INFO("Computation of LocalMatrix::ILUpFactorize() failed");
+                        this->Info();
+                        FATAL_ERROR(__FILE__, __LINE__);
+                    }
 
-                if(this->matrix_->AddScalarDiagonal(alpha) == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::AddScalarDiagonal() failed");
-                    this->Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
+                    if(err == false)
+                    {
+                        // Move to host
+                        bool is_accel = this->is_accel_();
+                        double fallback_start
+                            = _rocalution_host_fallback_begin(
+                                "LocalMatrix::ILUpFactorize()", is_accel);
+                        this->MoveToHost();
+                        structure.MoveToHost();
 
-                if(format != CSR)
-                {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::AddScalarDiagonal() is performed in CSR format");
+                        // Convert to CSR
+                        unsigned int format   = this->GetFormat();
+                        int          blockdim = this->GetBlockDimension();
+                        this->ConvertToCSR();
+                        structure.ConvertToCSR();
 
-                    this->ConvertTo(format, blockdim);
-                }
+                        if(this->matrix_->ILUpFactorizeNumeric(p, *structure.matrix_) == false)
+                        {
+                            LOG_INFO("Computation of LocalMatrix::ILUpFactorize() failed");
+                            this->Info();
+                            FATAL_ERROR(__FILE__, __LINE__);
+                        }
 
-                if(is_accel == true)
+                        if(format != CSR)
+                        {
+                            LOG_VERBOSE_INFO(2,
+                                             "*** warning: LocalMatrix::ILUpFactorize() is "
+                                             "performed in CSR format");
+
+                            this->ConvertTo(format, blockdim);
+                        }
+
+                        if(is_accel == true)
+                        {
+                            _rocalution_host_fallback_end("LocalMatrix::ILUpFactorize()",
+                                                          fallback_start,
+                                                          host_fallback_bytes(*this));
+
+                            this->MoveToAccelerator();
+                        }
+                    }
+
+                    // without control levels
+                }
+                else
                 {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::AddScalarDiagonal() is performed on the host");
+                    LocalMatrix values;
+                    values.CloneFrom(*this);
 
-                    this->MoveToAccelerator();
+                    this->SymbolicPower(p + 1);
+                    this->MatrixAdd(values);
+
+                    bool err = this->matrix_->ILU0Factorize();
+
+                    if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+                    {
+                        LOG_INFO("Computation of LocalMatrix::ILUpFactorize() failed");
+                        this->Info();
+                        FATAL_ERROR(__FILE__, __LINE__);
+                    }
+
+                    if(err == false)
+                    {
+                        // Move to host
+                        bool is_accel = this->is_accel_();
+                        double fallback_start
+                            = _rocalution_host_fallback_begin(
+                                "LocalMatrix::ILUpFactorize()", is_accel);
+                        this->MoveToHost();
+
+                        // Convert to CSR
+                        unsigned int format   = this->GetFormat();
+                        int          blockdim = this->GetBlockDimension();
+                        this->ConvertToCSR();
+
+                        if(this->matrix_->ILU0Factorize() == false)
+                        {
+                            LOG_INFO("Computation of LocalMatrix::ILUpFactorize() failed");
+                            this->Info();
+                            FATAL_ERROR(__FILE__, __LINE__);
+                        }
+
+                        if(format != CSR)
+                        {
+                            LOG_VERBOSE_INFO(2,
+                                             "*** warning: LocalMatrix::ILUpFactorize() is "
+                                             "performed in CSR format");
+
+                            this->ConvertTo(format, blockdim);
+                        }
+
+                        if(is_accel == true)
+                        {
+                            _rocalution_host_fallback_end("LocalMatrix::ILUpFactorize()",
+                                                          fallback_start,
+                                                          host_fallback_bytes(*this));
+
+                            this->MoveToAccelerator();
+                        }
+                    }
                 }
             }
         }
@@ -5357,9 +6518,16 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AddScalarOffDiagonal(ValueType alpha)
+    void LocalMatrix<ValueType>::ICFactorize(LocalVector<ValueType>* inv_diag)
     {
-        log_debug(this, "LocalMatrix::AddScalarOffDiagonal()", alpha);
+        log_debug(this, "LocalMatrix::ICFactorize()", inv_diag);
+
+        assert(inv_diag != NULL);
+
+        assert(
+            ((this->matrix_ == this->matrix_host_) && (inv_diag->vector_ == inv_diag->vector_host_))
+            || ((this->matrix_ == this->matrix_accel_)
+                && (inv_diag->vector_ == inv_diag->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -5367,11 +6535,11 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->AddScalarOffDiagonal(alpha);
+            bool err = this->matrix_->ICFactorize(inv_diag->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::AddScalarOffDiagonal() failed");
+                LOG_INFO("Computation of LocalMatrix::ICFactorize() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
@@ -5380,36 +6548,38 @@ namespace rocalution
             {
                 // Move to host
                 bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::ICFactorize()", is_accel);
                 this->MoveToHost();
+                inv_diag->MoveToHost();
 
                 // Convert to CSR
                 unsigned int format   = this->GetFormat();
                 int          blockdim = this->GetBlockDimension();
                 this->ConvertToCSR();
 
-                if(this->matrix_->AddScalarOffDiagonal(alpha) == false)
+                if(this->matrix_->ICFactorize(inv_diag->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::AddScalarOffDiagonal() failed");
+                    LOG_INFO("Computation of LocalMatrix::ICFactorize() failed");
                     this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(format != CSR)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::AddScalarOffDiagonal() is "
-                                     "performed in CSR format");
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::ICFactorize() is performed in CSR format");
 
                     this->ConvertTo(format, blockdim);
                 }
 
                 if(is_accel == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::AddScalarOffDiagonal() is "
-                                     "performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ICFactorize()", fallback_start, host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
+                    inv_diag->MoveToAccelerator();
                 }
             }
         }
@@ -5420,188 +6590,94 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::MatrixMult(const LocalMatrix<ValueType>& A,
-                                            const LocalMatrix<ValueType>& B)
+    void LocalMatrix<ValueType>::MultiColoring(int&              num_colors,
+                                               int**             size_colors,
+                                               LocalVector<int>* permutation) const
     {
-        log_debug(this, "LocalMatrix::MatrixMult()", (const void*&)A, (const void*&)B);
-
-        assert(&A != this);
-        assert(&B != this);
-        assert(A.GetN() == B.GetM());
+        log_debug(this, "LocalMatrix::MultiColoring()", num_colors, size_colors, permutation);
 
-        assert(A.GetFormat() == B.GetFormat());
+        assert(*size_colors == NULL);
+        assert(permutation != NULL);
+        assert(this->GetM() == this->GetN());
 
-        assert(((this->matrix_ == this->matrix_host_) && (A.matrix_ == A.matrix_host_)
-                && (B.matrix_ == B.matrix_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (A.matrix_ == A.matrix_accel_)
-                   && (B.matrix_ == B.matrix_accel_)));
+        assert(((this->matrix_ == this->matrix_host_)
+                && (permutation->vector_ == permutation->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (permutation->vector_ == permutation->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
-        A.Check();
-        B.Check();
 #endif
 
-        if(this->GetFormat() == DENSE)
-        {
-            if(this->GetNnz() != A.GetNnz())
-            {
-                this->Clear();
-                this->AllocateDENSE("", A.GetLocalM(), B.GetLocalN());
-            }
-        }
-        else
-        {
-            this->Clear();
-        }
-
-        this->object_name_ = A.object_name_ + " x " + B.object_name_;
-        this->ConvertTo(A.GetFormat(), A.GetBlockDimension());
-
-        bool err = this->matrix_->MatMatMult(*A.matrix_, *B.matrix_);
-
-        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
-        {
-            LOG_INFO("Computation of LocalMatrix::MatMatMult() failed");
-            this->Info();
-            FATAL_ERROR(__FILE__, __LINE__);
-        }
-
-        if(err == false)
+        if(this->GetNnz() > 0)
         {
-            LocalMatrix<ValueType> A_host;
-            LocalMatrix<ValueType> B_host;
-            A_host.ConvertTo(A.GetFormat(), A.GetBlockDimension());
-            B_host.ConvertTo(B.GetFormat(), B.GetBlockDimension());
-            A_host.CopyFrom(A);
-            B_host.CopyFrom(B);
-
-            this->MoveToHost();
+            std::string vec_perm_name = "MultiColoring permutation of " + this->object_name_;
+            permutation->Allocate(vec_perm_name, 0);
+            permutation->CloneBackend(*this);
 
-            A_host.ConvertToCSR();
-            B_host.ConvertToCSR();
-            this->ConvertToCSR();
+            bool err = this->matrix_->MultiColoring(num_colors, size_colors, permutation->vector_);
 
-            if(this->matrix_->MatMatMult(*A_host.matrix_, *B_host.matrix_) == false)
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::MatMatMult() failed");
+                LOG_INFO("Computation of LocalMatrix::MultiColoring() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
-            if(A.GetFormat() != CSR)
-            {
-                LOG_VERBOSE_INFO(
-                    2, "*** warning: LocalMatrix::MatMatMult() is performed in CSR format");
-
-                this->ConvertTo(A.GetFormat(), A.GetBlockDimension());
-            }
-
-            if(A.is_accel_() == true)
+            if(err == false)
             {
-                LOG_VERBOSE_INFO(2,
-                                 "*** warning: LocalMatrix::MatMatMult() is performed on the host");
-
-                this->MoveToAccelerator();
-            }
-        }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
-    }
-
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::TripleMatrixProduct(const LocalMatrix<ValueType>& R,
-                                                     const LocalMatrix<ValueType>& A,
-                                                     const LocalMatrix<ValueType>& P)
-    {
-        log_debug(this,
-                  "LocalMatrix::TripleMatrixProduct()",
-                  (const void*&)R,
-                  (const void*&)A,
-                  (const void*&)P);
-
-        assert(&R != this);
-        assert(&A != this);
-        assert(&P != this);
-
-        assert(R.GetN() == A.GetM());
-        assert(A.GetN() == P.GetM());
-        assert(this->is_host_() == R.is_host_());
-        assert(this->is_host_() == A.is_host_());
-        assert(this->is_host_() == P.is_host_());
-
-        // Only CSR matrices are supported
-        LocalMatrix<ValueType> csr_R;
-        LocalMatrix<ValueType> csr_A;
-        LocalMatrix<ValueType> csr_P;
-
-        const LocalMatrix<ValueType>* R_ptr = &R;
-        const LocalMatrix<ValueType>* A_ptr = &A;
-        const LocalMatrix<ValueType>* P_ptr = &P;
-
-        // Check R
-        if(R.GetFormat() != CSR)
-        {
-            csr_R.CloneFrom(R);
-            csr_R.ConvertToCSR();
-            R_ptr = &csr_R;
-        }
-
-        // Check A
-        if(A.GetFormat() != CSR)
-        {
-            csr_A.CloneFrom(A);
-            csr_A.ConvertToCSR();
-            A_ptr = &csr_A;
-        }
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::MultiColoring()", this->is_accel_());
 
-        // Check P
-        if(P.GetFormat() != CSR)
-        {
-            csr_P.CloneFrom(P);
-            csr_P.ConvertToCSR();
-            P_ptr = &csr_P;
-        }
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
 
-        // Convert this to CSR
-        unsigned int format   = this->GetFormat();
-        int          blockdim = this->GetBlockDimension();
+                // Move to host
+                permutation->MoveToHost();
 
-        this->ConvertToCSR();
+                // Convert to CSR
+                mat_host.ConvertToCSR();
 
-        LocalMatrix<ValueType> tmp;
-        tmp.CloneBackend(*this);
+                if(mat_host.matrix_->MultiColoring(num_colors, size_colors, permutation->vector_)
+                   == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::MultiColoring() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
 
-        tmp.MatrixMult(*R_ptr, *A_ptr);
-        this->MatrixMult(tmp, *P_ptr);
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::MultiColoring() is performed in CSR format");
+                }
 
-        if(format != CSR || R.GetFormat() != CSR || A.GetFormat() != CSR || P.GetFormat() != CSR)
-        {
-            LOG_VERBOSE_INFO(
-                2, "*** warning: LocalMatrix::TripleMatrixProduct() is performed in CSR format");
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::MultiColoring()", fallback_start, host_fallback_bytes(*this));
 
-            if(format != CSR)
-            {
-                this->ConvertTo(format, blockdim);
+                    permutation->MoveToAccelerator();
+                }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::DiagonalMatrixMultR(const LocalVector<ValueType>& diag)
+    void LocalMatrix<ValueType>::MaximalIndependentSet(int&              size,
+                                                       LocalVector<int>* permutation) const
     {
-        log_debug(this, "LocalMatrix::DiagonalMatrixMultR()", (const void*&)diag);
+        log_debug(this, "LocalMatrix::MaximalIndependentSet()", size, permutation);
 
-        assert((diag.GetSize() == this->GetM()) || (diag.GetSize() == this->GetN()));
+        assert(permutation != NULL);
+        assert(this->GetM() == this->GetN());
 
-        assert(((this->matrix_ == this->matrix_host_) && (diag.vector_ == diag.vector_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (diag.vector_ == diag.vector_accel_)));
+        assert(((this->matrix_ == this->matrix_host_)
+                && (permutation->vector_ == permutation->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (permutation->vector_ == permutation->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -5609,75 +6685,75 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->DiagonalMatrixMultR(*diag.vector_);
+            std::string vec_perm_name
+                = "MaximalIndependentSet permutation of " + this->object_name_;
+            permutation->Allocate(vec_perm_name, 0);
+            permutation->CloneBackend(*this);
+
+            bool err = this->matrix_->MaximalIndependentSet(size, permutation->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::DiagonalMatrixMultR() failed");
+                LOG_INFO("Computation of LocalMatrix::MaximalIndependentSet() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                LocalVector<ValueType> diag_host;
-                diag_host.CopyFrom(diag);
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::MaximalIndependentSet()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
 
                 // Move to host
-                this->MoveToHost();
+                permutation->MoveToHost();
 
                 // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                mat_host.ConvertToCSR();
 
-                if(this->matrix_->DiagonalMatrixMultR(*diag_host.vector_) == false)
+                if(mat_host.matrix_->MaximalIndependentSet(size, permutation->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::DiagonalMatrixMultR() failed");
+                    LOG_INFO("Computation of LocalMatrix::MaximalIndependentSet() failed");
                     this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != CSR)
+                if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::DiagonalMatrixMultR() is performed "
-                                     "in CSR format");
-
-                    this->ConvertTo(format, blockdim);
+                                     "*** warning: LocalMatrix::MaximalIndependentSet() is "
+                                     "performed in CSR format");
                 }
 
-                if(diag.is_accel_() == true)
+                if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::DiagonalMatrixMultR() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::MaximalIndependentSet()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                    this->MoveToAccelerator();
+                    permutation->MoveToAccelerator();
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::DiagonalMatrixMult(const LocalVector<ValueType>& diag)
+    void LocalMatrix<ValueType>::ZeroBlockPermutation(int&              size,
+                                                      LocalVector<int>* permutation) const
     {
-        this->DiagonalMatrixMultR(diag);
-    }
+        log_debug(this, "LocalMatrix::ZeroBlockPermutation()", size, permutation);
 
-    template <typename ValueType>
-    void LocalMatrix<ValueType>::DiagonalMatrixMultL(const LocalVector<ValueType>& diag)
-    {
-        log_debug(this, "LocalMatrix::DiagonalMatrixMultL()", (const void*&)diag);
+        assert(permutation != NULL);
+        assert(this->GetM() == this->GetN());
 
-        assert((diag.GetSize() == this->GetM()) || (diag.GetSize() == this->GetN()));
-
-        assert(((this->matrix_ == this->matrix_host_) && (diag.vector_ == diag.vector_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (diag.vector_ == diag.vector_accel_)));
+        assert(((this->matrix_ == this->matrix_host_)
+                && (permutation->vector_ == permutation->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (permutation->vector_ == permutation->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -5685,66 +6761,69 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->DiagonalMatrixMultL(*diag.vector_);
+            std::string vec_perm_name = "ZeroBlockPermutation permutation of " + this->object_name_;
+            permutation->Allocate(vec_perm_name, this->GetLocalM());
+
+            bool err = this->matrix_->ZeroBlockPermutation(size, permutation->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::DiagonalMatrixMultL() failed");
+                LOG_INFO("Computation of LocalMatrix::ZeroBlockPermutation() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                LocalVector<ValueType> diag_host;
-                diag_host.CopyFrom(diag);
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ZeroBlockPermutation()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
 
                 // Move to host
-                this->MoveToHost();
+                permutation->MoveToHost();
 
                 // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                mat_host.ConvertToCSR();
 
-                if(this->matrix_->DiagonalMatrixMultL(*diag_host.vector_) == false)
+                if(mat_host.matrix_->ZeroBlockPermutation(size, permutation->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::DiagonalMatrixMultL() failed");
-                    this->Info();
+                    LOG_INFO("Computation of LocalMatrix::ZeroBlockPermutation() failed");
+                    mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != CSR)
+                if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::DiagonalMatrixMultL() is performed "
-                                     "in CSR format");
-
-                    this->ConvertTo(format, blockdim);
+                                     "*** warning: LocalMatrix::ZeroBlockPermutation() is "
+                                     "performed in CSR format");
                 }
 
-                if(diag.is_accel_() == true)
+                if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::DiagonalMatrixMultL() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ZeroBlockPermutation()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                    this->MoveToAccelerator();
+                    permutation->MoveToAccelerator();
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::Compress(double drop_off)
+    void LocalMatrix<ValueType>::Householder(int                     idx,
+                                             ValueType&              beta,
+                                             LocalVector<ValueType>* vec) const
     {
-        log_debug(this, "LocalMatrix::Compress()", drop_off);
+        log_debug(this, "LocalMatrix::Householder()", idx, beta, vec);
 
-        assert(std::abs(drop_off) >= 0.0);
+        assert(idx >= 0);
+        assert(vec != NULL);
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -5752,60 +6831,58 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->Compress(drop_off);
+            bool err = this->matrix_->Householder(idx, beta, vec->vector_);
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == DENSE))
             {
-                LOG_INFO("Computation of LocalMatrix::Compress() failed");
+                LOG_INFO("Computation of LocalMatrix::Householder() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                // Move to host
-                bool is_accel = this->is_accel_();
-                this->MoveToHost();
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::Householder()", this->is_accel_());
 
-                // Convert to CSR
-                unsigned int format   = this->GetFormat();
-                int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
 
-                if(this->matrix_->Compress(drop_off) == false)
+                vec->MoveToHost();
+
+                // Convert to DENSE
+                mat_host.ConvertToDENSE();
+
+                if(mat_host.matrix_->Householder(idx, beta, vec->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::Compress() failed");
-                    this->Info();
+                    LOG_INFO("Computation of LocalMatrix::Householder() failed");
+                    mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != CSR)
+                if(this->GetFormat() != DENSE)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Compress() is performed in CSR format");
-
-                    this->ConvertTo(format, blockdim);
+                        2, "*** warning: LocalMatrix::Householder() is performed in DENSE format");
                 }
 
-                if(is_accel == true)
+                if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Compress() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Householder()", fallback_start, host_fallback_bytes(*this));
 
-                    this->MoveToAccelerator();
+                    vec->MoveToAccelerator();
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::Transpose(void)
+    void LocalMatrix<ValueType>::QRDecompose(void)
     {
-        log_debug(this, "LocalMatrix::Transpose()");
+        log_debug(this, "LocalMatrix::QRDecompose()");
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -5813,66 +6890,86 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->Transpose();
+            bool err = this->matrix_->QRDecompose();
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == DENSE))
             {
-                LOG_INFO("Computation of LocalMatrix::Transpose() failed");
+                LOG_INFO("Computation of LocalMatrix::QRDecompose() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
+            // Try DENSE format on the accelerator before falling back to the host
+            if((err == false) && (this->is_accel_() == true) && (this->GetFormat() != DENSE))
+            {
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToDENSE();
+
+                err = this->matrix_->QRDecompose();
+
+                if(err == true)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::QRDecompose() is performed in DENSE format");
+                }
+
+                this->ConvertTo(format, blockdim);
+            }
+
             if(err == false)
             {
                 // Move to host
                 bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::QRDecompose()", is_accel);
                 this->MoveToHost();
 
-                // Convert to CSR
+                // Convert to DENSE
                 unsigned int format   = this->GetFormat();
                 int          blockdim = this->GetBlockDimension();
-                this->ConvertToCSR();
+                this->ConvertToDENSE();
 
-                if(this->matrix_->Transpose() == false)
+                if(this->matrix_->QRDecompose() == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::Transpose() failed");
+                    LOG_INFO("Computation of LocalMatrix::QRDecompose() failed");
                     this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(format != CSR)
+                if(format != DENSE)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Transpose() is performed in CSR format");
+                        2, "*** warning: LocalMatrix::QRDecompose() is performed in DENSE format");
 
                     this->ConvertTo(format, blockdim);
                 }
 
                 if(is_accel == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Transpose() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::QRDecompose()", fallback_start, host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        this->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::Transpose(LocalMatrix<ValueType>* T) const
+    void LocalMatrix<ValueType>::QRSolve(const LocalVector<ValueType>& in,
+                                         LocalVector<ValueType>*       out) const
     {
-        log_debug(this, "LocalMatrix::Transpose()", T);
+        log_debug(this, "LocalMatrix::QRSolve()", (const void*&)in, out);
 
-        assert(T != NULL);
-        assert(T != this);
+        assert(out != NULL);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
 
-        assert(((this->matrix_ == this->matrix_host_) && (T->matrix_ == T->matrix_host_))
-               || ((this->matrix_ == this->matrix_accel_) && (T->matrix_ == T->matrix_accel_)));
+        assert(((this->matrix_ == this->matrix_host_) && (in.vector_ == in.vector_host_)
+                && (out->vector_ == out->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (in.vector_ == in.vector_accel_)
+                   && (out->vector_ == out->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -5880,106 +6977,122 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->Transpose(T->matrix_);
+            bool err = this->matrix_->QRSolve(*in.vector_, out->vector_);
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == DENSE))
             {
-                LOG_INFO("Computation of LocalMatrix::Transpose() failed");
+                LOG_INFO("Computation of LocalMatrix::QRSolve() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                // Move to host
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::QRSolve()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
 
-                T->MoveToHost();
+                LocalVector<ValueType> vec_host;
+                vec_host.CopyFrom(in);
 
-                // Convert to CSR
-                mat_host.ConvertToCSR();
+                mat_host.MoveToHost();
+                vec_host.MoveToHost();
+                out->MoveToHost();
 
-                if(mat_host.matrix_->Transpose(T->matrix_) == false)
+                mat_host.ConvertToDENSE();
+
+                if(mat_host.matrix_->QRSolve(*vec_host.vector_, out->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::Transpose() failed");
+                    LOG_INFO("Computation of LocalMatrix::QRSolve() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(this->GetFormat() != CSR)
+                if(this->GetFormat() != DENSE)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Transpose() is performed in CSR format");
-
-                    T->ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                        2, "*** warning: LocalMatrix::QRSolve() is performed in DENSE format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::Transpose() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::QRSolve()", fallback_start, host_fallback_bytes(*this));
 
-                    T->MoveToAccelerator();
+                    out->MoveToAccelerator();
                 }
             }
         }
-
-#ifdef DEBUG_MODE
-        T->Check();
-#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::Sort(void)
+    void LocalMatrix<ValueType>::Permute(const LocalVector<int>& permutation)
     {
-        log_debug(this, "LocalMatrix::Sort()");
+        log_debug(this, "LocalMatrix::Permute()", (const void*&)permutation);
+
+        assert((permutation.GetSize() == this->GetM()) || (permutation.GetSize() == this->GetN()));
+        assert(permutation.GetSize() > 0);
+
+        assert(((this->matrix_ == this->matrix_host_)
+                && (permutation.vector_ == permutation.vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (permutation.vector_ == permutation.vector_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->Sort();
+            bool err = this->matrix_->Permute(*permutation.vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::Sort() failed");
+                LOG_INFO("Computation of LocalMatrix::Permute() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::Permute()", permutation.is_accel_());
+
+                LocalVector<int> perm_host;
+                perm_host.CopyFrom(permutation);
+
                 // Move to host
-                bool is_accel = this->is_accel_();
                 this->MoveToHost();
 
-                // Try sorting on host
-                if(this->matrix_->Sort() == false)
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->Permute(*perm_host.vector_) == false)
                 {
-                    // Convert to CSR
-                    unsigned int format   = this->GetFormat();
-                    int          blockdim = this->GetBlockDimension();
-                    this->ConvertToCSR();
+                    LOG_INFO("Computation of LocalMatrix::Permute() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
 
-                    if(this->matrix_->Sort() == false)
-                    {
-                        LOG_INFO("Computation of LocalMatrix::Sort() failed");
-                        this->Info();
-                        FATAL_ERROR(__FILE__, __LINE__);
-                    }
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::Permute() is performed in CSR format");
 
-                    if(format != CSR)
-                    {
-                        LOG_VERBOSE_INFO(
-                            2, "*** warning: LocalMatrix::Sort() is performed in CSR format");
-                        this->ConvertTo(format, blockdim);
-                    }
+                    this->ConvertTo(format, blockdim);
                 }
 
-                if(is_accel == true)
+                if(permutation.is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::Sort() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Permute()", fallback_start, host_fallback_bytes(*this));
+
                     this->MoveToAccelerator();
                 }
             }
@@ -5991,9 +7104,17 @@ namespace rocalution
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::Key(long int& row_key, long int& col_key, long int& val_key) const
+    void LocalMatrix<ValueType>::PermuteBackward(const LocalVector<int>& permutation)
     {
-        log_debug(this, "LocalMatrix::Key()", row_key, col_key, val_key);
+        log_debug(this, "LocalMatrix::PermuteBackward()", (const void*&)permutation);
+
+        assert((permutation.GetSize() == this->GetM()) || (permutation.GetSize() == this->GetN()));
+        assert(permutation.GetSize() > 0);
+
+        assert(((this->matrix_ == this->matrix_host_)
+                && (permutation.vector_ == permutation.vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (permutation.vector_ == permutation.vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -6001,58 +7122,75 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->Key(row_key, col_key, val_key);
+            bool err = this->matrix_->PermuteBackward(*permutation.vector_);
 
-            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == COO))
             {
-                LOG_INFO("Computation of LocalMatrix::Key() failed");
+                LOG_INFO("Computation of LocalMatrix::PermuteBackward() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::PermuteBackward()", permutation.is_accel_());
+
+                LocalVector<int> perm_host;
+                perm_host.CopyFrom(permutation);
+
                 // Move to host
-                LocalMatrix<ValueType> mat_host;
-                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
-                mat_host.CopyFrom(*this);
+                this->MoveToHost();
 
-                // Convert to CSR
-                mat_host.ConvertToCSR();
+                // Convert to COO
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCOO();
 
-                if(mat_host.matrix_->Key(row_key, col_key, val_key) == false)
+                if(this->matrix_->PermuteBackward(*perm_host.vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::Key() failed");
-                    mat_host.Info();
+                    LOG_INFO("Computation of LocalMatrix::PermuteBackward() failed");
+                    this->Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                if(this->GetFormat() != CSR)
+                if(format != COO)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::Key() is performed in CSR format");
+                    LOG_VERBOSE_INFO(
+                        2,
+                        "*** warning: LocalMatrix::PermuteBackward() is performed in COO format");
+
+                    this->ConvertTo(format, blockdim);
                 }
 
-                if(this->is_accel_() == true)
+                if(permutation.is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2, "*** warning: LocalMatrix::Key() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::PermuteBackward()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
                 }
             }
         }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AMGConnect(ValueType eps, LocalVector<int>* connections) const
+    void LocalMatrix<ValueType>::CMK(LocalVector<int>* permutation) const
     {
-        log_debug(this, "LocalMatrix::AMGConnect()", eps, connections);
+        log_debug(this, "LocalMatrix::CMK()", permutation);
 
-        assert(eps > static_cast<ValueType>(0));
-        assert(connections != NULL);
+        assert(permutation != NULL);
 
         assert(((this->matrix_ == this->matrix_host_)
-                && (connections->vector_ == connections->vector_host_))
+                && (permutation->vector_ == permutation->vector_host_))
                || ((this->matrix_ == this->matrix_accel_)
-                   && (connections->vector_ == connections->vector_accel_)));
+                   && (permutation->vector_ == permutation->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -6060,65 +7198,72 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->AMGConnect(eps, connections->vector_);
+            bool err = this->matrix_->CMK(permutation->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::AMGConnect() failed");
+                LOG_INFO("Computation of LocalMatrix::CMK() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::CMK()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
 
                 // Move to host
-                connections->MoveToHost();
+                permutation->MoveToHost();
 
                 // Convert to CSR
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->AMGConnect(eps, connections->vector_) == false)
+                if(mat_host.matrix_->CMK(permutation->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::AMGConnect() failed");
+                    LOG_INFO("Computation of LocalMatrix::CMK() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::AMGConnect() is performed in CSR format");
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::CMK() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::AMGConnect() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::CMK()", fallback_start, host_fallback_bytes(*this));
 
-                    connections->MoveToAccelerator();
+                    permutation->MoveToAccelerator();
                 }
             }
         }
+
+        std::string vec_name      = "CMK permutation of " + this->object_name_;
+        permutation->object_name_ = vec_name;
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AMGAggregate(const LocalVector<int>& connections,
-                                              LocalVector<int>*       aggregates) const
+    void LocalMatrix<ValueType>::RCMK(LocalVector<int>* permutation) const
     {
-        log_debug(this, "LocalMatrix::AMGAggregate()", (const void*&)connections, aggregates);
+        log_debug(this, "LocalMatrix::RCMK()", permutation);
 
-        assert(aggregates != NULL);
+        assert(permutation != NULL);
 
         assert(((this->matrix_ == this->matrix_host_)
-                && (connections.vector_ == connections.vector_host_)
-                && (aggregates->vector_ == aggregates->vector_host_))
+                && (permutation->vector_ == permutation->vector_host_))
                || ((this->matrix_ == this->matrix_accel_)
-                   && (connections.vector_ == connections.vector_accel_)
-                   && (aggregates->vector_ == aggregates->vector_accel_)));
+                   && (permutation->vector_ == permutation->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -6126,102 +7271,108 @@ namespace rocalution
 
         if(this->GetNnz() > 0)
         {
-            bool err = this->matrix_->AMGAggregate(*connections.vector_, aggregates->vector_);
+            bool err = this->matrix_->RCMK(permutation->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::AMGAggregate() failed");
+                LOG_INFO("Computation of LocalMatrix::RCMK() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::RCMK()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
-                LocalVector<int>       conn_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
-                conn_host.CopyFrom(connections);
 
                 // Move to host
-                aggregates->MoveToHost();
+                permutation->MoveToHost();
 
                 // Convert to CSR
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->AMGAggregate(*conn_host.vector_, aggregates->vector_) == false)
+                if(mat_host.matrix_->RCMK(permutation->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::AMGAggregate() failed");
+                    LOG_INFO("Computation of LocalMatrix::RCMK() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::AMGAggregate() is performed in CSR format");
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::RCMK() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::AMGAggregate() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::RCMK()", fallback_start, host_fallback_bytes(*this));
 
-                    aggregates->MoveToAccelerator();
+                    permutation->MoveToAccelerator();
                 }
             }
         }
+
+        std::string vec_name      = "RCMK permutation of " + this->object_name_;
+        permutation->object_name_ = vec_name;
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AMGPMISAggregate(const LocalVector<int>& connections,
-                                                  LocalVector<int>*       aggregates) const
+    void LocalMatrix<ValueType>::GraphPartition(int nparts, LocalVector<int>* partition) const
     {
-        log_debug(this, "LocalMatrix::AMGPMISAggregate()", (const void*&)connections, aggregates);
+        log_debug(this, "LocalMatrix::GraphPartition()", nparts, partition);
 
-        assert(aggregates != NULL);
+        assert(nparts > 0);
+        assert(partition != NULL);
+        assert(this->GetM() == this->GetN());
 
         assert(((this->matrix_ == this->matrix_host_)
-                && (connections.vector_ == connections.vector_host_)
-                && (aggregates->vector_ == aggregates->vector_host_))
+                && (partition->vector_ == partition->vector_host_))
                || ((this->matrix_ == this->matrix_accel_)
-                   && (connections.vector_ == connections.vector_accel_)
-                   && (aggregates->vector_ == aggregates->vector_accel_)));
+                   && (partition->vector_ == partition->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
-        if(this->GetNnz() > 0)
+        if(this->GetM() > 0)
         {
-            bool err = this->matrix_->AMGPMISAggregate(*connections.vector_, aggregates->vector_);
+            bool err = this->matrix_->GraphPartition(nparts, partition->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::AMGPMISAggregate() failed");
+                LOG_INFO("Computation of LocalMatrix::GraphPartition() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
-                LocalMatrix<ValueType> mat_host;
-                LocalVector<int>       conn_host;
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::GraphPartition()", this->is_accel_());
 
-                mat_host.ConvertTo(this->GetFormat());
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
-                conn_host.CopyFrom(connections);
 
                 // Move to host
-                aggregates->MoveToHost();
+                partition->MoveToHost();
 
                 // Convert to CSR
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->AMGPMISAggregate(*conn_host.vector_, aggregates->vector_)
-                   == false)
+                if(mat_host.matrix_->GraphPartition(nparts, partition->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::AMGPMISAggregate() failed");
+                    LOG_INFO("Computation of LocalMatrix::GraphPartition() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
@@ -6229,154 +7380,166 @@ namespace rocalution
                 if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::AMGPMISAggregate() is performed in CSR format");
+                        2, "*** warning: LocalMatrix::GraphPartition() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::AMGPMISAggregate() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::GraphPartition()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                    aggregates->MoveToAccelerator();
+                    partition->MoveToAccelerator();
                 }
             }
         }
+
+        std::string vec_name    = "Graph partition of " + this->object_name_;
+        partition->object_name_ = vec_name;
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AMGSmoothedAggregation(ValueType               relax,
-                                                        const LocalVector<int>& aggregates,
-                                                        const LocalVector<int>& connections,
-                                                        LocalMatrix<ValueType>* prolong,
-                                                        int                     lumping_strat) const
+    void LocalMatrix<ValueType>::AMD(LocalVector<int>* permutation) const
     {
-        log_debug(this,
-                  "LocalMatrix::AMGSmoothedAggregation()",
-                  relax,
-                  (const void*&)aggregates,
-                  (const void*&)connections,
-                  prolong);
+        log_debug(this, "LocalMatrix::AMD()", permutation);
 
-        assert(relax > static_cast<ValueType>(0));
-        assert(prolong != NULL);
-        assert(this != prolong);
-        assert(this->is_host_() == aggregates.is_host_());
-        assert(this->is_host_() == connections.is_host_());
-        assert(this->is_host_() == prolong->is_host_());
+        assert(permutation != NULL);
+        assert(this->GetM() == this->GetN());
+
+        assert(((this->matrix_ == this->matrix_host_)
+                && (permutation->vector_ == permutation->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (permutation->vector_ == permutation->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
-        if(this->GetNnz() > 0)
+        if(this->GetM() > 0)
         {
-            bool err = this->matrix_->AMGSmoothedAggregation(
-                relax, *aggregates.vector_, *connections.vector_, prolong->matrix_, lumping_strat);
+            bool err = this->matrix_->AMD(permutation->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::AMGSmoothedAggregation() failed");
+                LOG_INFO("Computation of LocalMatrix::AMD() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::AMD()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
-                LocalVector<int>       conn_host;
-                LocalVector<int>       aggr_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
-                conn_host.CopyFrom(connections);
-                aggr_host.CopyFrom(aggregates);
 
                 // Move to host
-                prolong->MoveToHost();
+                permutation->MoveToHost();
 
                 // Convert to CSR
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->AMGSmoothedAggregation(relax,
-                                                            *aggr_host.vector_,
-                                                            *conn_host.vector_,
-                                                            prolong->matrix_,
-                                                            lumping_strat)
-                   == false)
+                if(mat_host.matrix_->AMD(permutation->vector_) == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::AMGSmoothedAggregation() failed");
+                    LOG_INFO("Computation of LocalMatrix::AMD() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
                 if(this->GetFormat() != CSR)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::AMGSmoothedAggregation() is "
-                                     "performed in CSR format");
-
-                    prolong->ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::AMD() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::AMGSmoothedAggregation() is "
-                                     "performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::AMD()", fallback_start, host_fallback_bytes(*this));
 
-                    prolong->MoveToAccelerator();
+                    permutation->MoveToAccelerator();
                 }
             }
         }
 
+        std::string vec_name      = "AMD permutation of " + this->object_name_;
+        permutation->object_name_ = vec_name;
+
 #ifdef DEBUG_MODE
-        prolong->Check();
+        this->Check();
 #endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AMGAggregation(const LocalVector<int>& aggregates,
-                                                LocalMatrix<ValueType>* prolong) const
+    void LocalMatrix<ValueType>::NestedDissection(int&              num_nodes,
+                                                  int**             node_offset,
+                                                  int**             node_parent,
+                                                  LocalVector<int>* permutation,
+                                                  int               leaf_size) const
     {
-        log_debug(this, "LocalMatrix::AMGAggregation()", (const void*&)aggregates, prolong);
+        log_debug(this,
+                  "LocalMatrix::NestedDissection()",
+                  num_nodes,
+                  node_offset,
+                  node_parent,
+                  permutation,
+                  leaf_size);
+
+        assert(leaf_size > 0);
+        assert(*node_offset == NULL);
+        assert(*node_parent == NULL);
+        assert(permutation != NULL);
+        assert(this->GetM() == this->GetN());
 
-        assert(prolong != NULL);
-        assert(this != prolong);
-        assert(this->is_host_() == aggregates.is_host_());
-        assert(this->is_host_() == prolong->is_host_());
+        assert(((this->matrix_ == this->matrix_host_)
+                && (permutation->vector_ == permutation->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (permutation->vector_ == permutation->vector_accel_)));
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
 
-        if(this->GetNnz() > 0)
+        num_nodes = 0;
+
+        if(this->GetM() > 0)
         {
-            bool err = this->matrix_->AMGAggregation(*aggregates.vector_, prolong->matrix_);
+            bool err = this->matrix_->NestedDissection(
+                leaf_size, num_nodes, node_offset, node_parent, permutation->vector_);
 
             if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
             {
-                LOG_INFO("Computation of LocalMatrix::AMGAggregation() failed");
+                LOG_INFO("Computation of LocalMatrix::NestedDissection() failed");
                 this->Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
             if(err == false)
             {
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::NestedDissection()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
-                LocalVector<int>       aggr_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
-                aggr_host.CopyFrom(aggregates);
 
                 // Move to host
-                prolong->MoveToHost();
+                permutation->MoveToHost();
 
                 // Convert to CSR
                 mat_host.ConvertToCSR();
 
-                if(mat_host.matrix_->AMGAggregation(*aggr_host.vector_, prolong->matrix_) == false)
+                if(mat_host.matrix_->NestedDissection(
+                       leaf_size, num_nodes, node_offset, node_parent, permutation->vector_)
+                   == false)
                 {
-                    LOG_INFO("Computation of LocalMatrix::AMGAggregation() failed");
+                    LOG_INFO("Computation of LocalMatrix::NestedDissection() failed");
                     mat_host.Info();
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
@@ -6384,46 +7547,2939 @@ namespace rocalution
                 if(this->GetFormat() != CSR)
                 {
                     LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::AMGAggregation() is performed in CSR format");
-
-                    prolong->ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                        2,
+                        "*** warning: LocalMatrix::NestedDissection() is performed in CSR format");
                 }
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::AMGAggregation() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::NestedDissection()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                    prolong->MoveToAccelerator();
+                    permutation->MoveToAccelerator();
                 }
             }
         }
 
+        std::string vec_name      = "Nested dissection permutation of " + this->object_name_;
+        permutation->object_name_ = vec_name;
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ConnectivityOrder(LocalVector<int>* permutation) const
+    {
+        log_debug(this, "LocalMatrix::ConnectivityOrder()", permutation);
+
+        assert(permutation != NULL);
+
+        assert(((this->matrix_ == this->matrix_host_)
+                && (permutation->vector_ == permutation->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (permutation->vector_ == permutation->vector_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->ConnectivityOrder(permutation->vector_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::ConnectivityOrder() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ConnectivityOrder()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+
+                // Move to host
+                permutation->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->ConnectivityOrder(permutation->vector_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::ConnectivityOrder() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2,
+                        "*** warning: LocalMatrix::ConnectivityOrder() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::ConnectivityOrder()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    permutation->MoveToAccelerator();
+                }
+            }
+        }
+
+        std::string vec_name      = "ConnectivityOrder permutation of " + this->object_name_;
+        permutation->object_name_ = vec_name;
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::SymbolicPower(int p)
+    {
+        log_debug(this, "LocalMatrix::SymbolicPower()", p);
+
+        assert(p >= 1);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->SymbolicPower(p);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::SymbolicPower() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::SymbolicPower()", is_accel);
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->SymbolicPower(p) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::SymbolicPower() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::SymbolicPower() is performed in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::SymbolicPower()", fallback_start, host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::MatrixAdd(const LocalMatrix<ValueType>& mat,
+                                           ValueType                     alpha,
+                                           ValueType                     beta,
+                                           bool                          structure)
+    {
+        log_debug(this, "LocalMatrix::MatrixAdd()", (const void*&)mat, alpha, beta, structure);
+
+        assert(&mat != this);
+        assert(this->GetFormat() == mat.GetFormat());
+        assert(this->GetM() == mat.GetM());
+        assert(this->GetN() == mat.GetN());
+
+        assert(((this->matrix_ == this->matrix_host_) && (mat.matrix_ == mat.matrix_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (mat.matrix_ == mat.matrix_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+        mat.Check();
+#endif
+
+        bool err = this->matrix_->MatrixAdd(*mat.matrix_, alpha, beta, structure);
+
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::MatrixAdd() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalMatrix::MatrixAdd()", mat.is_accel_());
+
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(mat.GetFormat(), this->GetBlockDimension());
+            mat_host.CopyFrom(mat);
+
+            this->MoveToHost();
+
+            this->ConvertToCSR();
+            mat_host.ConvertToCSR();
+
+            if(this->matrix_->MatrixAdd(*mat_host.matrix_, alpha, beta, structure) == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::MatrixAdd() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(mat.GetFormat() != CSR)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::MatrixAdd() is performed in CSR format");
+
+                this->ConvertTo(mat.GetFormat(), this->GetBlockDimension());
+            }
+
+            if(mat.is_accel_() == true)
+            {
+                _rocalution_host_fallback_end(
+                    "LocalMatrix::MatrixAdd()", fallback_start, host_fallback_bytes(*this));
+
+                this->MoveToAccelerator();
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::MatrixAdd(const LocalMatrix<ValueType>& A,
+                                           ValueType                     alpha,
+                                           const LocalMatrix<ValueType>& B,
+                                           ValueType                     beta)
+    {
+        log_debug(this, "LocalMatrix::MatrixAdd()", (const void*&)A, alpha, (const void*&)B, beta);
+
+        assert(&A != this);
+        assert(&B != this);
+        assert(A.GetM() == B.GetM());
+        assert(A.GetN() == B.GetN());
+
+        assert(A.GetFormat() == CSR);
+        assert(B.GetFormat() == CSR);
+
+        assert(((this->matrix_ == this->matrix_host_) && (A.matrix_ == A.matrix_host_)
+                && (B.matrix_ == B.matrix_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (A.matrix_ == A.matrix_accel_)
+                   && (B.matrix_ == B.matrix_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+        A.Check();
+        B.Check();
+#endif
+
+        this->Clear();
+        this->object_name_ = A.object_name_ + " + " + B.object_name_;
+        this->ConvertToCSR();
+
+        bool err = this->matrix_->SymbolicMatrixAdd(*A.matrix_, *B.matrix_)
+                   && this->matrix_->NumericMatrixAdd(*A.matrix_, alpha, *B.matrix_, beta);
+
+        if((err == false) && (this->is_host_() == true))
+        {
+            LOG_INFO("Computation of LocalMatrix::MatrixAdd() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalMatrix::MatrixAdd()", this->is_accel_());
+
+            LocalMatrix<ValueType> A_host;
+            LocalMatrix<ValueType> B_host;
+            A_host.CopyFrom(A);
+            B_host.CopyFrom(B);
+
+            this->MoveToHost();
+
+            if(this->matrix_->SymbolicMatrixAdd(*A_host.matrix_, *B_host.matrix_) == false
+               || this->matrix_->NumericMatrixAdd(*A_host.matrix_, alpha, *B_host.matrix_, beta)
+                      == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::MatrixAdd() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            _rocalution_host_fallback_end(
+                "LocalMatrix::MatrixAdd()", fallback_start, host_fallback_bytes(*this));
+
+            this->MoveToAccelerator();
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::MatrixAddNumeric(const LocalMatrix<ValueType>& A,
+                                                  ValueType                     alpha,
+                                                  const LocalMatrix<ValueType>& B,
+                                                  ValueType                     beta)
+    {
+        log_debug(
+            this, "LocalMatrix::MatrixAddNumeric()", (const void*&)A, alpha, (const void*&)B, beta);
+
+        assert(&A != this);
+        assert(&B != this);
+        assert(this->GetM() == A.GetM());
+        assert(this->GetN() == A.GetN());
+        assert(this->GetM() == B.GetM());
+        assert(this->GetN() == B.GetN());
+
+        assert(this->GetFormat() == CSR);
+        assert(A.GetFormat() == CSR);
+        assert(B.GetFormat() == CSR);
+
+        assert(((this->matrix_ == this->matrix_host_) && (A.matrix_ == A.matrix_host_)
+                && (B.matrix_ == B.matrix_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (A.matrix_ == A.matrix_accel_)
+                   && (B.matrix_ == B.matrix_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+        A.Check();
+        B.Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->NumericMatrixAdd(*A.matrix_, alpha, *B.matrix_, beta);
+
+            if((err == false) && (this->is_host_() == true))
+            {
+                LOG_INFO("Computation of LocalMatrix::MatrixAddNumeric() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::MatrixAddNumeric()", this->is_accel_());
+
+                LocalMatrix<ValueType> A_host;
+                LocalMatrix<ValueType> B_host;
+                A_host.CopyFrom(A);
+                B_host.CopyFrom(B);
+
+                this->MoveToHost();
+
+                if(this->matrix_->NumericMatrixAdd(*A_host.matrix_, alpha, *B_host.matrix_, beta)
+                   == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::MatrixAddNumeric() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                _rocalution_host_fallback_end(
+                    "LocalMatrix::MatrixAddNumeric()", fallback_start, host_fallback_bytes(*this));
+
+                this->MoveToAccelerator();
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const
+    {
+        log_debug(this, "LocalMatrix::Gershgorin()");
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->Gershgorin(lambda_min, lambda_max);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::Gershgorin() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::Gershgorin()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->Gershgorin(lambda_min, lambda_max) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::Gershgorin() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::Gershgorin() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Gershgorin()", fallback_start, host_fallback_bytes(*this));
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Scale(ValueType alpha)
+    {
+        log_debug(this, "LocalMatrix::Scale()", alpha);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->Scale(alpha);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::Scale() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::Scale()", is_accel);
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->Scale(alpha) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::Scale() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::Scale() is performed in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Scale()", fallback_start, host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ScaleDiagonal(ValueType alpha)
+    {
+        log_debug(this, "LocalMatrix::ScaleDiagonal()", alpha);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->ScaleDiagonal(alpha);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::ScaleDiagonal() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::ScaleDiagonal()", is_accel);
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->ScaleDiagonal(alpha) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::ScaleDiagonal() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::ScaleDiagonal() is performed in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::ScaleDiagonal()", fallback_start, host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::ScaleOffDiagonal(ValueType alpha)
+    {
+        log_debug(this, "LocalMatrix::ScaleOffDiagonal()", alpha);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->ScaleOffDiagonal(alpha);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::ScaleOffDiagonal() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::ScaleOffDiagonal()", is_accel);
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->ScaleOffDiagonal(alpha) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::ScaleOffDiagonal() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2,
+                        "*** warning: LocalMatrix::ScaleOffDiagonal() is performed in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::ScaleOffDiagonal()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AddScalar(ValueType alpha)
+    {
+        log_debug(this, "LocalMatrix::AddScalar()", alpha);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->AddScalar(alpha);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::AddScalar() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::AddScalar()", is_accel);
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->AddScalar(alpha) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AddScalar() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::AddScalar() is performed in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::AddScalar()", fallback_start, host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AddScalarDiagonal(ValueType alpha)
+    {
+        log_debug(this, "LocalMatrix::AddScalarDiagonal()", alpha);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->AddScalarDiagonal(alpha);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::AddScalarDiagonal() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::AddScalarDiagonal()", is_accel);
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->AddScalarDiagonal(alpha) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AddScalarDiagonal() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2,
+                        "*** warning: LocalMatrix::AddScalarDiagonal() is performed in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::AddScalarDiagonal()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AddScalarOffDiagonal(ValueType alpha)
+    {
+        log_debug(this, "LocalMatrix::AddScalarOffDiagonal()", alpha);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->AddScalarOffDiagonal(alpha);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::AddScalarOffDiagonal() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::AddScalarOffDiagonal()", is_accel);
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->AddScalarOffDiagonal(alpha) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AddScalarOffDiagonal() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::AddScalarOffDiagonal() is "
+                                     "performed in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::AddScalarOffDiagonal()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::MatrixMult(const LocalMatrix<ValueType>& A,
+                                            const LocalMatrix<ValueType>& B)
+    {
+        log_debug(this, "LocalMatrix::MatrixMult()", (const void*&)A, (const void*&)B);
+
+        assert(&A != this);
+        assert(&B != this);
+        assert(A.GetN() == B.GetM());
+
+        assert(A.GetFormat() == B.GetFormat());
+
+        assert(((this->matrix_ == this->matrix_host_) && (A.matrix_ == A.matrix_host_)
+                && (B.matrix_ == B.matrix_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (A.matrix_ == A.matrix_accel_)
+                   && (B.matrix_ == B.matrix_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+        A.Check();
+        B.Check();
+#endif
+
+        if(this->GetFormat() == DENSE)
+        {
+            if(this->GetNnz() != A.GetNnz())
+            {
+                this->Clear();
+                this->AllocateDENSE("", A.GetLocalM(), B.GetLocalN());
+            }
+        }
+        else
+        {
+            this->Clear();
+        }
+
+        this->object_name_ = A.object_name_ + " x " + B.object_name_;
+        this->ConvertTo(A.GetFormat(), A.GetBlockDimension());
+
+        bool err = this->matrix_->MatMatMult(*A.matrix_, *B.matrix_);
+
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::MatMatMult() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalMatrix::MatMatMult()", A.is_accel_());
+
+            LocalMatrix<ValueType> A_host;
+            LocalMatrix<ValueType> B_host;
+            A_host.ConvertTo(A.GetFormat(), A.GetBlockDimension());
+            B_host.ConvertTo(B.GetFormat(), B.GetBlockDimension());
+            A_host.CopyFrom(A);
+            B_host.CopyFrom(B);
+
+            this->MoveToHost();
+
+            A_host.ConvertToCSR();
+            B_host.ConvertToCSR();
+            this->ConvertToCSR();
+
+            if(this->matrix_->MatMatMult(*A_host.matrix_, *B_host.matrix_) == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::MatMatMult() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(A.GetFormat() != CSR)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::MatMatMult() is performed in CSR format");
+
+                this->ConvertTo(A.GetFormat(), A.GetBlockDimension());
+            }
+
+            if(A.is_accel_() == true)
+            {
+                _rocalution_host_fallback_end(
+                    "LocalMatrix::MatMatMult()", fallback_start, host_fallback_bytes(*this));
+
+                this->MoveToAccelerator();
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::MatrixMultNumeric(const LocalMatrix<ValueType>& A,
+                                                   const LocalMatrix<ValueType>& B)
+    {
+        log_debug(this, "LocalMatrix::MatrixMultNumeric()", (const void*&)A, (const void*&)B);
+
+        assert(&A != this);
+        assert(&B != this);
+        assert(A.GetN() == B.GetM());
+        assert(this->GetM() == A.GetM());
+        assert(this->GetN() == B.GetN());
+
+        assert(this->GetFormat() == CSR);
+        assert(A.GetFormat() == CSR);
+        assert(B.GetFormat() == CSR);
+
+        assert(((this->matrix_ == this->matrix_host_) && (A.matrix_ == A.matrix_host_)
+                && (B.matrix_ == B.matrix_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (A.matrix_ == A.matrix_accel_)
+                   && (B.matrix_ == B.matrix_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+        A.Check();
+        B.Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->NumericMatMatMult(*A.matrix_, *B.matrix_);
+
+            if((err == false) && (this->is_host_() == true))
+            {
+                LOG_INFO("Computation of LocalMatrix::MatrixMultNumeric() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::MatrixMultNumeric()", this->is_accel_());
+
+                LocalMatrix<ValueType> A_host;
+                LocalMatrix<ValueType> B_host;
+                A_host.CopyFrom(A);
+                B_host.CopyFrom(B);
+
+                this->MoveToHost();
+
+                if(this->matrix_->NumericMatMatMult(*A_host.matrix_, *B_host.matrix_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::MatrixMultNumeric() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                _rocalution_host_fallback_end(
+                    "LocalMatrix::MatrixMultNumeric()", fallback_start, host_fallback_bytes(*this));
+
+                this->MoveToAccelerator();
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::TripleMatrixProduct(const LocalMatrix<ValueType>& R,
+                                                     const LocalMatrix<ValueType>& A,
+                                                     const LocalMatrix<ValueType>& P)
+    {
+        log_debug(this,
+                  "LocalMatrix::TripleMatrixProduct()",
+                  (const void*&)R,
+                  (const void*&)A,
+                  (const void*&)P);
+
+        assert(&R != this);
+        assert(&A != this);
+        assert(&P != this);
+
+        assert(R.GetN() == A.GetM());
+        assert(A.GetN() == P.GetM());
+        assert(this->is_host_() == R.is_host_());
+        assert(this->is_host_() == A.is_host_());
+        assert(this->is_host_() == P.is_host_());
+
+        // Only CSR matrices are supported
+        LocalMatrix<ValueType> csr_R;
+        LocalMatrix<ValueType> csr_A;
+        LocalMatrix<ValueType> csr_P;
+
+        const LocalMatrix<ValueType>* R_ptr = &R;
+        const LocalMatrix<ValueType>* A_ptr = &A;
+        const LocalMatrix<ValueType>* P_ptr = &P;
+
+        // Check R
+        if(R.GetFormat() != CSR)
+        {
+            csr_R.CloneFrom(R);
+            csr_R.ConvertToCSR();
+            R_ptr = &csr_R;
+        }
+
+        // Check A
+        if(A.GetFormat() != CSR)
+        {
+            csr_A.CloneFrom(A);
+            csr_A.ConvertToCSR();
+            A_ptr = &csr_A;
+        }
+
+        // Check P
+        if(P.GetFormat() != CSR)
+        {
+            csr_P.CloneFrom(P);
+            csr_P.ConvertToCSR();
+            P_ptr = &csr_P;
+        }
+
+        // Convert this to CSR
+        unsigned int format   = this->GetFormat();
+        int          blockdim = this->GetBlockDimension();
+
+        this->ConvertToCSR();
+
+        // Compute the product without the intermediate R * A, if supported by the backend
+        if(this->matrix_->TripleMatMatMult(*R_ptr->matrix_, *A_ptr->matrix_, *P_ptr->matrix_)
+           == false)
+        {
+            LocalMatrix<ValueType> tmp;
+            tmp.CloneBackend(*this);
+
+            tmp.MatrixMult(*R_ptr, *A_ptr);
+            this->MatrixMult(tmp, *P_ptr);
+        }
+
+        if(format != CSR || R.GetFormat() != CSR || A.GetFormat() != CSR || P.GetFormat() != CSR)
+        {
+            LOG_VERBOSE_INFO(
+                2, "*** warning: LocalMatrix::TripleMatrixProduct() is performed in CSR format");
+
+            if(format != CSR)
+            {
+                this->ConvertTo(format, blockdim);
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::TripleMatrixProductNumeric(const LocalMatrix<ValueType>& R,
+                                                            const LocalMatrix<ValueType>& A,
+                                                            const LocalMatrix<ValueType>& P)
+    {
+        log_debug(this,
+                  "LocalMatrix::TripleMatrixProductNumeric()",
+                  (const void*&)R,
+                  (const void*&)A,
+                  (const void*&)P);
+
+        assert(&R != this);
+        assert(&A != this);
+        assert(&P != this);
+        assert(R.GetN() == A.GetM());
+        assert(A.GetN() == P.GetM());
+        assert(this->GetM() == R.GetM());
+        assert(this->GetN() == P.GetN());
+
+        assert(this->GetFormat() == CSR);
+        assert(R.GetFormat() == CSR);
+        assert(A.GetFormat() == CSR);
+        assert(P.GetFormat() == CSR);
+
+        assert(this->is_host_() == R.is_host_());
+        assert(this->is_host_() == A.is_host_());
+        assert(this->is_host_() == P.is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+        R.Check();
+        A.Check();
+        P.Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->NumericTripleMatMatMult(
+                *R.matrix_, *A.matrix_, *P.matrix_);
+
+            if((err == false) && (this->is_host_() == true))
+            {
+                LOG_INFO("Computation of LocalMatrix::TripleMatrixProductNumeric() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::TripleMatrixProductNumeric()", this->is_accel_());
+
+                LocalMatrix<ValueType> R_host;
+                LocalMatrix<ValueType> A_host;
+                LocalMatrix<ValueType> P_host;
+                R_host.CopyFrom(R);
+                A_host.CopyFrom(A);
+                P_host.CopyFrom(P);
+
+                this->MoveToHost();
+
+                if(this->matrix_->NumericTripleMatMatMult(
+                       *R_host.matrix_, *A_host.matrix_, *P_host.matrix_)
+                   == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::TripleMatrixProductNumeric() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                _rocalution_host_fallback_end("LocalMatrix::TripleMatrixProductNumeric()",
+                                              fallback_start,
+                                              host_fallback_bytes(*this));
+
+                this->MoveToAccelerator();
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::TripleMatrixProductNumeric(const LocalMatrix<ValueType>& R,
+                                                            const LocalMatrix<ValueType>& A,
+                                                            const LocalMatrix<ValueType>& P,
+                                                            const LocalVector<bool>&      rows)
+    {
+        log_debug(this,
+                  "LocalMatrix::TripleMatrixProductNumeric()",
+                  (const void*&)R,
+                  (const void*&)A,
+                  (const void*&)P,
+                  (const void*&)rows);
+
+        assert(&R != this);
+        assert(&A != this);
+        assert(&P != this);
+        assert(R.GetN() == A.GetM());
+        assert(A.GetN() == P.GetM());
+        assert(this->GetM() == R.GetM());
+        assert(this->GetN() == P.GetN());
+        assert(rows.GetSize() == this->GetM());
+
+        assert(this->GetFormat() == CSR);
+        assert(R.GetFormat() == CSR);
+        assert(A.GetFormat() == CSR);
+        assert(P.GetFormat() == CSR);
+
+        assert(this->is_host_() == R.is_host_());
+        assert(this->is_host_() == A.is_host_());
+        assert(this->is_host_() == P.is_host_());
+        assert(this->is_host_() == rows.is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+        R.Check();
+        A.Check();
+        P.Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->NumericTripleMatMatMultRows(
+                *R.matrix_, *A.matrix_, *P.matrix_, *rows.vector_);
+
+            if((err == false) && (this->is_host_() == true))
+            {
+                LOG_INFO("Computation of LocalMatrix::TripleMatrixProductNumeric() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::TripleMatrixProductNumeric()", this->is_accel_());
+
+                LocalMatrix<ValueType> R_host;
+                LocalMatrix<ValueType> A_host;
+                LocalMatrix<ValueType> P_host;
+                LocalVector<bool>      rows_host;
+                R_host.CopyFrom(R);
+                A_host.CopyFrom(A);
+                P_host.CopyFrom(P);
+                rows_host.CopyFrom(rows);
+
+                this->MoveToHost();
+
+                if(this->matrix_->NumericTripleMatMatMultRows(
+                       *R_host.matrix_, *A_host.matrix_, *P_host.matrix_, *rows_host.vector_)
+                   == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::TripleMatrixProductNumeric() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                _rocalution_host_fallback_end("LocalMatrix::TripleMatrixProductNumeric()",
+                                              fallback_start,
+                                              host_fallback_bytes(*this));
+
+                this->MoveToAccelerator();
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::DiagonalMatrixMultR(const LocalVector<ValueType>& diag)
+    {
+        log_debug(this, "LocalMatrix::DiagonalMatrixMultR()", (const void*&)diag);
+
+        assert((diag.GetSize() == this->GetM()) || (diag.GetSize() == this->GetN()));
+
+        assert(((this->matrix_ == this->matrix_host_) && (diag.vector_ == diag.vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (diag.vector_ == diag.vector_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->DiagonalMatrixMultR(*diag.vector_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::DiagonalMatrixMultR() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::DiagonalMatrixMultR()", diag.is_accel_());
+
+                LocalVector<ValueType> diag_host;
+                diag_host.CopyFrom(diag);
+
+                // Move to host
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->DiagonalMatrixMultR(*diag_host.vector_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::DiagonalMatrixMultR() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::DiagonalMatrixMultR() is performed "
+                                     "in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(diag.is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::DiagonalMatrixMultR()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::DiagonalMatrixMult(const LocalVector<ValueType>& diag)
+    {
+        this->DiagonalMatrixMultR(diag);
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::DiagonalMatrixMultL(const LocalVector<ValueType>& diag)
+    {
+        log_debug(this, "LocalMatrix::DiagonalMatrixMultL()", (const void*&)diag);
+
+        assert((diag.GetSize() == this->GetM()) || (diag.GetSize() == this->GetN()));
+
+        assert(((this->matrix_ == this->matrix_host_) && (diag.vector_ == diag.vector_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (diag.vector_ == diag.vector_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->DiagonalMatrixMultL(*diag.vector_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::DiagonalMatrixMultL() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::DiagonalMatrixMultL()", diag.is_accel_());
+
+                LocalVector<ValueType> diag_host;
+                diag_host.CopyFrom(diag);
+
+                // Move to host
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->DiagonalMatrixMultL(*diag_host.vector_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::DiagonalMatrixMultL() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::DiagonalMatrixMultL() is performed "
+                                     "in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(diag.is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::DiagonalMatrixMultL()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Compress(double drop_off)
+    {
+        log_debug(this, "LocalMatrix::Compress()", drop_off);
+
+        assert(std::abs(drop_off) >= 0.0);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->Compress(drop_off);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::Compress() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::Compress()", is_accel);
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->Compress(drop_off) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::Compress() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::Compress() is performed in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Compress()", fallback_start, host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::CompressLumped(double drop_off)
+    {
+        log_debug(this, "LocalMatrix::CompressLumped()", drop_off);
+
+        assert(drop_off >= 0.0);
+        assert(this->GetM() == this->GetN());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->CompressLumped(drop_off);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::CompressLumped() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::CompressLumped()", is_accel);
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->CompressLumped(drop_off) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::CompressLumped() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::CompressLumped() is performed in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::CompressLumped()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Transpose(void)
+    {
+        log_debug(this, "LocalMatrix::Transpose()");
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        // A symmetric matrix is its own transpose
+        if(this->symmetric_storage_ == true)
+        {
+            return;
+        }
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->Transpose();
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::Transpose() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::Transpose()", is_accel);
+                this->MoveToHost();
+
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
+
+                if(this->matrix_->Transpose() == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::Transpose() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(format != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::Transpose() is performed in CSR format");
+
+                    this->ConvertTo(format, blockdim);
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Transpose()", fallback_start, host_fallback_bytes(*this));
+
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Transpose(LocalMatrix<ValueType>* T) const
+    {
+        log_debug(this, "LocalMatrix::Transpose()", T);
+
+        assert(T != NULL);
+        assert(T != this);
+
+        assert(((this->matrix_ == this->matrix_host_) && (T->matrix_ == T->matrix_host_))
+               || ((this->matrix_ == this->matrix_accel_) && (T->matrix_ == T->matrix_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->Transpose(T->matrix_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::Transpose() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::Transpose()", this->is_accel_());
+
+                // Move to host
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+
+                T->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->Transpose(T->matrix_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::Transpose() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::Transpose() is performed in CSR format");
+
+                    T->ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Transpose()", fallback_start, host_fallback_bytes(*this));
+
+                    T->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        T->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Sort(void)
+    {
+        log_debug(this, "LocalMatrix::Sort()");
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->Sort();
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::Sort() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                // Move to host
+                bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::Sort()", is_accel);
+                this->MoveToHost();
+
+                // Try sorting on host
+                if(this->matrix_->Sort() == false)
+                {
+                    // Convert to CSR
+                    unsigned int format   = this->GetFormat();
+                    int          blockdim = this->GetBlockDimension();
+                    this->ConvertToCSR();
+
+                    if(this->matrix_->Sort() == false)
+                    {
+                        LOG_INFO("Computation of LocalMatrix::Sort() failed");
+                        this->Info();
+                        FATAL_ERROR(__FILE__, __LINE__);
+                    }
+
+                    if(format != CSR)
+                    {
+                        LOG_VERBOSE_INFO(
+                            2, "*** warning: LocalMatrix::Sort() is performed in CSR format");
+                        this->ConvertTo(format, blockdim);
+                    }
+                }
+
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Sort()", fallback_start, host_fallback_bytes(*this));
+                    this->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::Key(long int& row_key, long int& col_key, long int& val_key) const
+    {
+        log_debug(this, "LocalMatrix::Key()", row_key, col_key, val_key);
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->Key(row_key, col_key, val_key);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::Key() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::Key()", this->is_accel_());
+
+                // Move to host
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->Key(row_key, col_key, val_key) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::Key() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::Key() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Key()", fallback_start, host_fallback_bytes(*this));
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    uint64_t LocalMatrix<ValueType>::Hash(void) const
+    {
+        log_debug(this, "LocalMatrix::Hash()");
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        uint64_t hash = 0;
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->Hash(&hash);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::Hash() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::Hash()", this->is_accel_());
+
+                // Move to host
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->Hash(&hash) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::Hash() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::Hash() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Hash()", fallback_start, host_fallback_bytes(*this));
+                }
+            }
+        }
+
+        // Sizes are folded in, such that e.g. empty matrices of different size differ
+        uint64_t sizes[3] = {static_cast<uint64_t>(this->GetM()),
+                             static_cast<uint64_t>(this->GetN()),
+                             static_cast<uint64_t>(this->GetNnz())};
+
+        for(int i = 0; i < 3; ++i)
+        {
+            hash ^= sizes[i] + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        }
+
+        return hash;
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AMGConnect(ValueType eps, LocalVector<int>* connections) const
+    {
+        log_debug(this, "LocalMatrix::AMGConnect()", eps, connections);
+
+        assert(eps > static_cast<ValueType>(0));
+        assert(connections != NULL);
+
+        assert(((this->matrix_ == this->matrix_host_)
+                && (connections->vector_ == connections->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (connections->vector_ == connections->vector_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->AMGConnect(eps, connections->vector_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGConnect() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::AMGConnect()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+
+                // Move to host
+                connections->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->AMGConnect(eps, connections->vector_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AMGConnect() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::AMGConnect() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::AMGConnect()", fallback_start, host_fallback_bytes(*this));
+
+                    connections->MoveToAccelerator();
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AMGAggregate(const LocalVector<int>& connections,
+                                              LocalVector<int>*       aggregates) const
+    {
+        log_debug(this, "LocalMatrix::AMGAggregate()", (const void*&)connections, aggregates);
+
+        assert(aggregates != NULL);
+
+        assert(((this->matrix_ == this->matrix_host_)
+                && (connections.vector_ == connections.vector_host_)
+                && (aggregates->vector_ == aggregates->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (connections.vector_ == connections.vector_accel_)
+                   && (aggregates->vector_ == aggregates->vector_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->AMGAggregate(*connections.vector_, aggregates->vector_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGAggregate() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::AMGAggregate()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                LocalVector<int>       conn_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+                conn_host.CopyFrom(connections);
+
+                // Move to host
+                aggregates->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->AMGAggregate(*conn_host.vector_, aggregates->vector_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AMGAggregate() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::AMGAggregate() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::AMGAggregate()", fallback_start, host_fallback_bytes(*this));
+
+                    aggregates->MoveToAccelerator();
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AMGPMISAggregate(const LocalVector<int>& connections,
+                                                  LocalVector<int>*       aggregates) const
+    {
+        log_debug(this, "LocalMatrix::AMGPMISAggregate()", (const void*&)connections, aggregates);
+
+        assert(aggregates != NULL);
+
+        assert(((this->matrix_ == this->matrix_host_)
+                && (connections.vector_ == connections.vector_host_)
+                && (aggregates->vector_ == aggregates->vector_host_))
+               || ((this->matrix_ == this->matrix_accel_)
+                   && (connections.vector_ == connections.vector_accel_)
+                   && (aggregates->vector_ == aggregates->vector_accel_)));
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->AMGPMISAggregate(*connections.vector_, aggregates->vector_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGPMISAggregate() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::AMGPMISAggregate()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                LocalVector<int>       conn_host;
+
+                mat_host.ConvertTo(this->GetFormat());
+                mat_host.CopyFrom(*this);
+                conn_host.CopyFrom(connections);
+
+                // Move to host
+                aggregates->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->AMGPMISAggregate(*conn_host.vector_, aggregates->vector_)
+                   == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AMGPMISAggregate() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2,
+                        "*** warning: LocalMatrix::AMGPMISAggregate() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::AMGPMISAggregate()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    aggregates->MoveToAccelerator();
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AMGSmoothedAggregation(ValueType               relax,
+                                                        const LocalVector<int>& aggregates,
+                                                        const LocalVector<int>& connections,
+                                                        LocalMatrix<ValueType>* prolong,
+                                                        int                     lumping_strat) const
+    {
+        log_debug(this,
+                  "LocalMatrix::AMGSmoothedAggregation()",
+                  relax,
+                  (const void*&)aggregates,
+                  (const void*&)connections,
+                  prolong);
+
+        assert(relax > static_cast<ValueType>(0));
+        assert(prolong != NULL);
+        assert(this != prolong);
+        assert(this->is_host_() == aggregates.is_host_());
+        assert(this->is_host_() == connections.is_host_());
+        assert(this->is_host_() == prolong->is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->AMGSmoothedAggregation(
+                relax, *aggregates.vector_, *connections.vector_, prolong->matrix_, lumping_strat);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGSmoothedAggregation() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::AMGSmoothedAggregation()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                LocalVector<int>       conn_host;
+                LocalVector<int>       aggr_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+                conn_host.CopyFrom(connections);
+                aggr_host.CopyFrom(aggregates);
+
+                // Move to host
+                prolong->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->AMGSmoothedAggregation(relax,
+                                                            *aggr_host.vector_,
+                                                            *conn_host.vector_,
+                                                            prolong->matrix_,
+                                                            lumping_strat)
+                   == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AMGSmoothedAggregation() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::AMGSmoothedAggregation() is "
+                                     "performed in CSR format");
+
+                    prolong->ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::AMGSmoothedAggregation()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    prolong->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        prolong->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AMGAggregation(const LocalVector<int>& aggregates,
+                                                LocalMatrix<ValueType>* prolong) const
+    {
+        log_debug(this, "LocalMatrix::AMGAggregation()", (const void*&)aggregates, prolong);
+
+        assert(prolong != NULL);
+        assert(this != prolong);
+        assert(this->is_host_() == aggregates.is_host_());
+        assert(this->is_host_() == prolong->is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->AMGAggregation(*aggregates.vector_, prolong->matrix_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGAggregation() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::AMGAggregation()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                LocalVector<int>       aggr_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+                aggr_host.CopyFrom(aggregates);
+
+                // Move to host
+                prolong->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->AMGAggregation(*aggr_host.vector_, prolong->matrix_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AMGAggregation() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::AMGAggregation() is performed in CSR format");
+
+                    prolong->ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::AMGAggregation()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    prolong->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        prolong->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void
+        LocalMatrix<ValueType>::AMGGreedyAggregate(ValueType             eps,
+                                                   LocalVector<bool>*    connections,
+                                                   LocalVector<int64_t>* aggregates,
+                                                   LocalVector<int64_t>* aggregate_root_nodes) const
+    {
+        log_debug(this,
+                  "LocalMatrix::AMGGreedyAggregate()",
+                  connections,
+                  aggregates,
+                  aggregate_root_nodes);
+
+        assert(connections != NULL);
+        assert(aggregates != NULL);
+        assert(aggregate_root_nodes != NULL);
+
+        assert(this->is_host_() == connections->is_host_());
+        assert(this->is_host_() == aggregates->is_host_());
+        assert(this->is_host_() == aggregate_root_nodes->is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+        // Only CSR matrices are supported
+        LocalMatrix<ValueType>        csr_mat;
+        const LocalMatrix<ValueType>* csr_ptr = this;
+
+        if(csr_ptr->GetFormat() != CSR)
+        {
+            csr_mat.CloneFrom(*csr_ptr);
+            csr_mat.ConvertToCSR();
+            csr_ptr = &csr_mat;
+        }
+
+        if(this->GetNnz() > 0)
+        {
+            // Zero structures
+            LocalMatrix<ValueType> zero_mat;
+            zero_mat.CloneBackend(*this);
+
+            LocalVector<int64_t> zero_vec;
+            zero_vec.CloneBackend(*this);
+
+            LocalVector<ValueType> diag;
+            diag.CloneBackend(*this);
+            diag.Allocate("diag", csr_ptr->GetM());
+
+            csr_ptr->ExtractDiagonal(&diag);
+
+            connections->Allocate("Connections", csr_ptr->GetNnz());
+            aggregates->Allocate("Aggregates", csr_ptr->GetM());
+            aggregate_root_nodes->Allocate("Aggregate root nodes", csr_ptr->GetM());
+
+            csr_ptr->matrix_->AMGComputeStrongConnections(
+                eps, *diag.vector_, *zero_vec.vector_, connections->vector_, *zero_mat.matrix_);
+
+            bool status = csr_ptr->matrix_->AMGGreedyAggregate(
+                *connections->vector_, aggregates->vector_, aggregate_root_nodes->vector_);
+
+            if((status == false) && (this->is_host_() == true))
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGGreedyAggregate() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(status == false)
+            {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::AMGGreedyAggregate()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                mat_host.CopyFrom(*this);
+
+                // Move to host
+                aggregates->MoveToHost();
+                aggregate_root_nodes->MoveToHost();
+                connections->MoveToHost();
+
+                if(mat_host.matrix_->AMGGreedyAggregate(
+                       *connections->vector_, aggregates->vector_, aggregate_root_nodes->vector_)
+                   == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AMGGreedyAggregate() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::AMGGreedyAggregate()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
+
+                    aggregates->MoveToAccelerator();
+                    aggregate_root_nodes->MoveToAccelerator();
+                    connections->MoveToAccelerator();
+                }
+            }
+        }
+
+        if(this->GetFormat() != CSR)
+        {
+            LOG_VERBOSE_INFO(
+                2, "*** warning: LocalMatrix::AMGGreedyAggregate() is performed in CSR format");
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AMGNodeGraph(int blockdim, LocalMatrix<ValueType>* node) const
+    {
+        log_debug(this, "LocalMatrix::AMGNodeGraph()", blockdim, node);
+
+        assert(node != NULL);
+        assert(node != this);
+        assert(blockdim > 0);
+        assert(this->GetM() % blockdim == 0);
+        assert(this->GetN() % blockdim == 0);
+        assert(this->is_host_() == node->is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+
+        node->Clear();
+        node->ConvertToCSR();
+
+        if(this->GetNnz() > 0)
+        {
+            bool err = this->matrix_->AMGNodeGraph(blockdim, node->matrix_);
+
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGNodeGraph() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(err == false)
+            {
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::AMGNodeGraph()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
+                mat_host.CopyFrom(*this);
+
+                // Move to host
+                node->MoveToHost();
+
+                // Convert to CSR
+                mat_host.ConvertToCSR();
+
+                if(mat_host.matrix_->AMGNodeGraph(blockdim, node->matrix_) == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AMGNodeGraph() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->GetFormat() != CSR)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::AMGNodeGraph() is performed in CSR format");
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::AMGNodeGraph()", fallback_start, host_fallback_bytes(*this));
+
+                    node->MoveToAccelerator();
+                }
+            }
+        }
+
+#ifdef DEBUG_MODE
+        node->Check();
+#endif
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AMGNodeExpand(
+        int                           blockdim,
+        const LocalMatrix<ValueType>& node,
+        const LocalVector<bool>&      node_connections,
+        const LocalVector<int64_t>&   node_aggregates,
+        const LocalVector<int64_t>&   node_aggregate_root_nodes,
+        LocalVector<bool>*            connections,
+        LocalVector<int64_t>*         aggregates,
+        LocalVector<int64_t>*         aggregate_root_nodes) const
+    {
+        log_debug(this,
+                  "LocalMatrix::AMGNodeExpand()",
+                  blockdim,
+                  (const void*&)node,
+                  (const void*&)node_connections,
+                  (const void*&)node_aggregates,
+                  (const void*&)node_aggregate_root_nodes,
+                  connections,
+                  aggregates,
+                  aggregate_root_nodes);
+
+        assert(connections != NULL);
+        assert(aggregates != NULL);
+        assert(aggregate_root_nodes != NULL);
+        assert(blockdim > 0);
+        assert(node.GetM() * blockdim == this->GetM());
+
+        assert(this->is_host_() == node.is_host_());
+        assert(this->is_host_() == node_connections.is_host_());
+        assert(this->is_host_() == node_aggregates.is_host_());
+        assert(this->is_host_() == node_aggregate_root_nodes.is_host_());
+        assert(this->is_host_() == connections->is_host_());
+        assert(this->is_host_() == aggregates->is_host_());
+        assert(this->is_host_() == aggregate_root_nodes->is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+        // Only CSR matrices are supported
+        LocalMatrix<ValueType>        csr_mat;
+        const LocalMatrix<ValueType>* csr_ptr = this;
+
+        if(csr_ptr->GetFormat() != CSR)
+        {
+            csr_mat.CloneFrom(*csr_ptr);
+            csr_mat.ConvertToCSR();
+            csr_ptr = &csr_mat;
+        }
+
+        connections->Allocate("Connections", csr_ptr->GetNnz());
+        aggregates->Allocate("Aggregates", csr_ptr->GetM());
+        aggregate_root_nodes->Allocate("Aggregate root nodes", csr_ptr->GetM());
+
+        if(this->GetNnz() > 0)
+        {
+            bool status = csr_ptr->matrix_->AMGNodeExpand(blockdim,
+                                                          *node.matrix_,
+                                                          *node_connections.vector_,
+                                                          *node_aggregates.vector_,
+                                                          *node_aggregate_root_nodes.vector_,
+                                                          connections->vector_,
+                                                          aggregates->vector_,
+                                                          aggregate_root_nodes->vector_);
+
+            if((status == false) && (this->is_host_() == true))
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGNodeExpand() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(status == false)
+            {
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::AMGNodeExpand()", this->is_accel_());
+
+                LocalMatrix<ValueType> mat_host;
+                mat_host.CopyFrom(*csr_ptr);
+
+                LocalMatrix<ValueType> node_host;
+                node_host.CopyFrom(node);
+
+                LocalVector<bool> node_conn_host;
+                node_conn_host.CopyFrom(node_connections);
+
+                LocalVector<int64_t> node_agg_host;
+                node_agg_host.CopyFrom(node_aggregates);
+
+                LocalVector<int64_t> node_root_host;
+                node_root_host.CopyFrom(node_aggregate_root_nodes);
+
+                // Move to host
+                connections->MoveToHost();
+                aggregates->MoveToHost();
+                aggregate_root_nodes->MoveToHost();
+
+                if(mat_host.matrix_->AMGNodeExpand(blockdim,
+                                                   *node_host.matrix_,
+                                                   *node_conn_host.vector_,
+                                                   *node_agg_host.vector_,
+                                                   *node_root_host.vector_,
+                                                   connections->vector_,
+                                                   aggregates->vector_,
+                                                   aggregate_root_nodes->vector_)
+                   == false)
+                {
+                    LOG_INFO("Computation of LocalMatrix::AMGNodeExpand() failed");
+                    mat_host.Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->is_accel_() == true)
+                {
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::AMGNodeExpand()", fallback_start, host_fallback_bytes(*this));
+
+                    connections->MoveToAccelerator();
+                    aggregates->MoveToAccelerator();
+                    aggregate_root_nodes->MoveToAccelerator();
+                }
+            }
+        }
+
+        if(this->GetFormat() != CSR)
+        {
+            LOG_VERBOSE_INFO(
+                2, "*** warning: LocalMatrix::AMGNodeExpand() is performed in CSR format");
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AMGPMISAggregate(ValueType             eps,
+                                                  LocalVector<bool>*    connections,
+                                                  LocalVector<int64_t>* aggregates,
+                                                  LocalVector<int64_t>* aggregate_root_nodes) const
+    {
+        log_debug(
+            this, "LocalMatrix::AMGPMISAggregate()", connections, aggregates, aggregate_root_nodes);
+
+        assert(connections != NULL);
+        assert(aggregates != NULL);
+        assert(aggregate_root_nodes != NULL);
+
+        assert(this->is_host_() == connections->is_host_());
+        assert(this->is_host_() == aggregates->is_host_());
+        assert(this->is_host_() == aggregate_root_nodes->is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+        // Only CSR matrices are supported
+        LocalMatrix<ValueType>        csr_mat;
+        const LocalMatrix<ValueType>* csr_ptr = this;
+        if(csr_ptr->GetFormat() != CSR)
+        {
+            csr_mat.CloneFrom(*csr_ptr);
+            csr_mat.ConvertToCSR();
+            csr_ptr = &csr_mat;
+        }
+        if(this->GetNnz() > 0)
+        {
+            // Zero structures
+            LocalMatrix<ValueType> zero_mat;
+            zero_mat.CloneBackend(*this);
+
+            LocalVector<int> izero_vec;
+            izero_vec.CloneBackend(*this);
+
+            LocalVector<int64_t> i64zero_vec;
+            i64zero_vec.CloneBackend(*this);
+
+            LocalVector<PtrType> pzero_vec;
+            pzero_vec.CloneBackend(*this);
+
+            connections->Allocate("Connections", csr_ptr->GetNnz());
+            aggregates->Allocate("Aggregates", csr_ptr->GetM());
+            aggregate_root_nodes->Allocate("Aggregate root nodes", csr_ptr->GetM());
+
+            LocalVector<int> hash;
+            hash.CloneBackend(*this);
+            hash.Allocate("hash", csr_ptr->GetM());
+
+            LocalVector<int> state;
+            state.CloneBackend(*this);
+            state.Allocate("state", csr_ptr->GetM());
+
+            LocalVector<int> max_state;
+            max_state.CloneBackend(*this);
+            max_state.Allocate("max_state", csr_ptr->GetM());
+
+            LocalVector<ValueType> diag;
+            diag.CloneBackend(*this);
+            diag.Allocate("diag", csr_ptr->GetM());
+
+            int64_t global_col_begin = 0;
+            int64_t global_col_end   = this->GetN();
+
+            csr_ptr->ExtractDiagonal(&diag);
+
+            // Compute connections
+            csr_ptr->matrix_->AMGComputeStrongConnections(
+                eps, *diag.vector_, *i64zero_vec.vector_, connections->vector_, *zero_mat.matrix_);
+
+            // Initialize max state
+            csr_ptr->matrix_->AMGPMISInitializeState(global_col_begin,
+                                                     *connections->vector_,
+                                                     max_state.vector_,
+                                                     hash.vector_,
+                                                     *zero_mat.matrix_);
+
+            int iter = 0;
+            while(true)
+            {
+                state.CopyFrom(max_state);
+
+                // Find maximum distance 2 node
+                bool undecided = false;
+                csr_ptr->matrix_->AMGPMISFindMaxNeighbourNode(global_col_begin,
+                                                              global_col_end,
+                                                              undecided,
+                                                              *connections->vector_,
+                                                              *state.vector_,
+                                                              *hash.vector_,
+                                                              *pzero_vec.vector_,
+                                                              *i64zero_vec.vector_,
+                                                              *izero_vec.vector_,
+                                                              *izero_vec.vector_,
+                                                              max_state.vector_,
+                                                              aggregates->vector_,
+                                                              *zero_mat.matrix_);
+
+                // If no more undecided nodes are left, we are done
+                if(undecided == false)
+                {
+                    break;
+                }
+
+                ++iter;
+
+                // Print some warning if number of iteration is getting huge
+                if(iter > 20)
+                {
+                    LOG_VERBOSE_INFO(2,
+                                     "*** warning: LocalMatrix::AMGPMISAggregate() Current "
+                                     "number of iterations: "
+                                         << iter);
+                }
+            }
+
+            aggregate_root_nodes->SetValues(-1);
+
+            csr_ptr->matrix_->AMGPMISInitializeAggregateGlobalIndices(
+                global_col_begin, *aggregates->vector_, aggregate_root_nodes->vector_);
+
+            aggregates->ExclusiveSum();
+
+            // Add any unassigned nodes to existing aggregations
+            for(int k = 0; k < 2; k++)
+            {
+                state.CopyFrom(max_state);
+
+                csr_ptr->matrix_->AMGPMISAddUnassignedNodesToAggregations(
+                    global_col_begin,
+                    *connections->vector_,
+                    *state.vector_,
+                    *i64zero_vec.vector_,
+                    max_state.vector_,
+                    aggregates->vector_,
+                    aggregate_root_nodes->vector_,
+                    *zero_mat.matrix_);
+            }
+        }
+
+        if(this->GetFormat() != CSR)
+        {
+            LOG_VERBOSE_INFO(
+                2, "*** warning: LocalMatrix::AMGPMISAggregate() is performed in CSR format");
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMatrix<ValueType>::AMGSmoothedAggregation(
+        ValueType                   relax,
+        const LocalVector<bool>&    connections,
+        const LocalVector<int64_t>& aggregates,
+        const LocalVector<int64_t>& aggregate_root_nodes,
+        LocalMatrix<ValueType>*     prolong,
+        int                         lumping_strat) const
+    {
+        log_debug(this,
+                  "LocalMatrix::AMGSmoothedAggregation()",
+                  relax,
+                  (const void*&)connections,
+                  (const void*&)aggregates,
+                  (const void*&)aggregate_root_nodes,
+                  prolong);
+
+        assert(relax > static_cast<ValueType>(0));
+        assert(prolong != NULL);
+        assert(this != prolong);
+        assert(this->is_host_() == connections.is_host_());
+        assert(this->is_host_() == aggregates.is_host_());
+        assert(this->is_host_() == aggregate_root_nodes.is_host_());
+        assert(this->is_host_() == prolong->is_host_());
+
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
+        // Only CSR matrices are supported
+        LocalMatrix<ValueType>        csr_mat;
+        const LocalMatrix<ValueType>* csr_ptr = this;
+
+        if(csr_ptr->GetFormat() != CSR)
+        {
+            csr_mat.CloneFrom(*csr_ptr);
+            csr_mat.ConvertToCSR();
+            csr_ptr = &csr_mat;
+        }
+
+        //csr_ptr->matrix_->AMGSmoothedAggregation(relax, *connections.vector_, *aggregates.vector_, prolong->matrix_, lumping_strat);
+
+        // Zero structures
+        LocalMatrix<ValueType> zero_mat;
+        zero_mat.CloneBackend(*this);
+
+        LocalVector<int> izero_vec;
+        izero_vec.CloneBackend(*this);
+
+        LocalVector<int64_t> i64zero_vec;
+        i64zero_vec.CloneBackend(*this);
+
+        int64_t global_col_begin = 0;
+        int64_t global_col_end   = this->GetN();
+
+        // fine to coarse map
+        LocalVector<int> f2c_map;
+        f2c_map.CloneBackend(*this);
+        f2c_map.Allocate("f2c map", csr_ptr->GetM() + 1);
+        f2c_map.Zeros();
+
+        // Determine number of non-zeros for P
+        bool err = csr_ptr->matrix_->AMGSmoothedAggregationProlongNnz(global_col_begin,
+                                                                      global_col_end,
+                                                                      *connections.vector_,
+                                                                      *aggregates.vector_,
+                                                                      *aggregate_root_nodes.vector_,
+                                                                      *zero_mat.matrix_,
+                                                                      f2c_map.vector_,
+                                                                      prolong->matrix_,
+                                                                      NULL);
+
+        if((err == false) && (csr_ptr->is_host_() == true) && (csr_ptr->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::ILU0Factorize() failed");
+            csr_ptr->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            double fallback_start
+                = _rocalution_host_fallback_begin(
+                    "LocalMatrix::AMGSmoothedAggregation()", csr_ptr->is_accel_());
+
+            // Move to host
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(csr_ptr->GetFormat());
+            mat_host.CopyFrom(*csr_ptr);
+
+            LocalVector<bool> connections_host;
+            connections_host.CopyFrom(connections);
+
+            LocalVector<int64_t> aggregates_host;
+            aggregates_host.CopyFrom(aggregates);
+
+            LocalVector<int64_t> aggregate_root_nodes_host;
+            aggregate_root_nodes_host.CopyFrom(aggregate_root_nodes);
+
+            zero_mat.MoveToHost();
+            i64zero_vec.MoveToHost();
+            f2c_map.MoveToHost();
+            prolong->MoveToHost();
+
+            // Convert to CSR
+            unsigned int format   = mat_host.GetFormat();
+            int          blockdim = mat_host.GetBlockDimension();
+            mat_host.ConvertToCSR();
+
+            if(mat_host.matrix_->AMGSmoothedAggregationProlongNnz(
+                   global_col_begin,
+                   global_col_end,
+                   *connections_host.vector_,
+                   *aggregates_host.vector_,
+                   *aggregate_root_nodes_host.vector_,
+                   *zero_mat.matrix_,
+                   f2c_map.vector_,
+                   prolong->matrix_,
+                   NULL)
+               == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGSmoothedAggregation() failed");
+                mat_host.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(mat_host.matrix_->AMGSmoothedAggregationProlongFill(
+                   global_col_begin,
+                   global_col_end,
+                   lumping_strat,
+                   relax,
+                   *connections_host.vector_,
+                   *aggregates_host.vector_,
+                   *aggregate_root_nodes_host.vector_,
+                   *i64zero_vec.vector_,
+                   *f2c_map.vector_,
+                   *zero_mat.matrix_,
+                   prolong->matrix_,
+                   NULL,
+                   NULL)
+               == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGSmoothedAggregation() failed");
+                mat_host.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(format != CSR)
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: LocalMatrix::AMGSmoothedAggregation() is performed "
+                                 "in CSR format");
+            }
+
+            if(csr_ptr->is_accel_() == true)
+            {
+                _rocalution_host_fallback_end("LocalMatrix::AMGSmoothedAggregation()",
+                                              fallback_start,
+                                              host_fallback_bytes(*this));
+
+                zero_mat.MoveToAccelerator();
+                i64zero_vec.MoveToAccelerator();
+                f2c_map.MoveToAccelerator();
+                prolong->MoveToAccelerator();
+            }
+        }
+        else
+        {
+            // Fill P
+            csr_ptr->matrix_->AMGSmoothedAggregationProlongFill(global_col_begin,
+                                                                global_col_end,
+                                                                lumping_strat,
+                                                                relax,
+                                                                *connections.vector_,
+                                                                *aggregates.vector_,
+                                                                *aggregate_root_nodes.vector_,
+                                                                *i64zero_vec.vector_,
+                                                                *f2c_map.vector_,
+                                                                *zero_mat.matrix_,
+                                                                prolong->matrix_,
+                                                                NULL,
+                                                                NULL);
+        }
+
 #ifdef DEBUG_MODE
         prolong->Check();
 #endif
+        if(this->GetFormat() != CSR)
+        {
+            LOG_VERBOSE_INFO(
+                2, "*** warning: LocalMatrix::AMGSmoothedAggregation() is performed in CSR format");
+        }
     }
 
     template <typename ValueType>
-    void
-        LocalMatrix<ValueType>::AMGGreedyAggregate(ValueType             eps,
-                                                   LocalVector<bool>*    connections,
-                                                   LocalVector<int64_t>* aggregates,
-                                                   LocalVector<int64_t>* aggregate_root_nodes) const
+    void LocalMatrix<ValueType>::AMGSmoothedAggregation(
+        ValueType                     relax,
+        const LocalVector<bool>&      connections,
+        const LocalVector<int64_t>&   aggregates,
+        const LocalVector<int64_t>&   aggregate_root_nodes,
+        int                           num_null,
+        const LocalVector<ValueType>& null_space,
+        LocalMatrix<ValueType>*       prolong,
+        LocalVector<ValueType>*       coarse_null_space,
+        int                           lumping_strat) const
     {
         log_debug(this,
-                  "LocalMatrix::AMGGreedyAggregate()",
-                  connections,
-                  aggregates,
-                  aggregate_root_nodes);
-
-        assert(connections != NULL);
-        assert(aggregates != NULL);
-        assert(aggregate_root_nodes != NULL);
+                  "LocalMatrix::AMGSmoothedAggregation()",
+                  relax,
+                  (const void*&)connections,
+                  (const void*&)aggregates,
+                  (const void*&)aggregate_root_nodes,
+                  num_null,
+                  (const void*&)null_space,
+                  prolong,
+                  coarse_null_space);
 
-        assert(this->is_host_() == connections->is_host_());
-        assert(this->is_host_() == aggregates->is_host_());
-        assert(this->is_host_() == aggregate_root_nodes->is_host_());
+        assert(relax > static_cast<ValueType>(0));
+        assert(num_null > 0);
+        assert(null_space.GetSize() == this->GetM() * num_null);
+        assert(prolong != NULL);
+        assert(coarse_null_space != NULL);
+        assert(this != prolong);
+        assert(&null_space != coarse_null_space);
+        assert(this->is_host_() == connections.is_host_());
+        assert(this->is_host_() == aggregates.is_host_());
+        assert(this->is_host_() == aggregate_root_nodes.is_host_());
+        assert(this->is_host_() == null_space.is_host_());
+        assert(this->is_host_() == prolong->is_host_());
+        assert(this->is_host_() == coarse_null_space->is_host_());
 
 #ifdef DEBUG_MODE
         this->Check();
@@ -6439,254 +10495,178 @@ namespace rocalution
             csr_ptr = &csr_mat;
         }
 
-        if(this->GetNnz() > 0)
+        bool err = csr_ptr->matrix_->AMGSmoothedAggregationNullSpace(relax,
+                                                                     lumping_strat,
+                                                                     *connections.vector_,
+                                                                     *aggregates.vector_,
+                                                                     *aggregate_root_nodes.vector_,
+                                                                     num_null,
+                                                                     *null_space.vector_,
+                                                                     prolong->matrix_,
+                                                                     coarse_null_space->vector_);
+
+        if((err == false) && (csr_ptr->is_host_() == true))
         {
-            // Zero structures
-            LocalMatrix<ValueType> zero_mat;
-            zero_mat.CloneBackend(*this);
+            LOG_INFO("Computation of LocalMatrix::AMGSmoothedAggregation() failed");
+            csr_ptr->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-            LocalVector<int64_t> zero_vec;
-            zero_vec.CloneBackend(*this);
+        if(err == false)
+        {
+            double fallback_start
+                = _rocalution_host_fallback_begin(
+                    "LocalMatrix::AMGSmoothedAggregation()", csr_ptr->is_accel_());
 
-            LocalVector<ValueType> diag;
-            diag.CloneBackend(*this);
-            diag.Allocate("diag", csr_ptr->GetM());
+            // Move to host
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(csr_ptr->GetFormat());
+            mat_host.CopyFrom(*csr_ptr);
 
-            csr_ptr->ExtractDiagonal(&diag);
+            LocalVector<bool> connections_host;
+            connections_host.CopyFrom(connections);
 
-            connections->Allocate("Connections", csr_ptr->GetNnz());
-            aggregates->Allocate("Aggregates", csr_ptr->GetM());
-            aggregate_root_nodes->Allocate("Aggregate root nodes", csr_ptr->GetM());
+            LocalVector<int64_t> aggregates_host;
+            aggregates_host.CopyFrom(aggregates);
 
-            csr_ptr->matrix_->AMGComputeStrongConnections(
-                eps, *diag.vector_, *zero_vec.vector_, connections->vector_, *zero_mat.matrix_);
+            LocalVector<int64_t> aggregate_root_nodes_host;
+            aggregate_root_nodes_host.CopyFrom(aggregate_root_nodes);
 
-            bool status = csr_ptr->matrix_->AMGGreedyAggregate(
-                *connections->vector_, aggregates->vector_, aggregate_root_nodes->vector_);
+            LocalVector<ValueType> null_space_host;
+            null_space_host.CopyFrom(null_space);
 
-            if((status == false) && (this->is_host_() == true))
+            prolong->MoveToHost();
+            coarse_null_space->MoveToHost();
+
+            if(mat_host.matrix_->AMGSmoothedAggregationNullSpace(
+                   relax,
+                   lumping_strat,
+                   *connections_host.vector_,
+                   *aggregates_host.vector_,
+                   *aggregate_root_nodes_host.vector_,
+                   num_null,
+                   *null_space_host.vector_,
+                   prolong->matrix_,
+                   coarse_null_space->vector_)
+               == false)
             {
-                LOG_INFO("Computation of LocalMatrix::AMGGreedyAggregate() failed");
-                this->Info();
+                LOG_INFO("Computation of LocalMatrix::AMGSmoothedAggregation() failed");
+                mat_host.Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
-            if(status == false)
+            if(csr_ptr->is_accel_() == true)
             {
-                LocalMatrix<ValueType> mat_host;
-                mat_host.CopyFrom(*this);
+                _rocalution_host_fallback_end("LocalMatrix::AMGSmoothedAggregation()",
+                                              fallback_start,
+                                              host_fallback_bytes(*this));
 
-                // Move to host
-                aggregates->MoveToHost();
-                aggregate_root_nodes->MoveToHost();
-                connections->MoveToHost();
-
-                if(mat_host.matrix_->AMGGreedyAggregate(
-                       *connections->vector_, aggregates->vector_, aggregate_root_nodes->vector_)
-                   == false)
-                {
-                    LOG_INFO("Computation of LocalMatrix::AMGGreedyAggregate() failed");
-                    mat_host.Info();
-                    FATAL_ERROR(__FILE__, __LINE__);
-                }
-
-                if(this->is_accel_() == true)
-                {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::AMGGreedyAggregate() is performed on the host");
-
-                    aggregates->MoveToAccelerator();
-                    aggregate_root_nodes->MoveToAccelerator();
-                    connections->MoveToAccelerator();
-                }
+                prolong->MoveToAccelerator();
+                coarse_null_space->MoveToAccelerator();
             }
         }
 
+#ifdef DEBUG_MODE
+        prolong->Check();
+#endif
         if(this->GetFormat() != CSR)
         {
             LOG_VERBOSE_INFO(
-                2, "*** warning: LocalMatrix::AMGGreedyAggregate() is performed in CSR format");
+                2, "*** warning: LocalMatrix::AMGSmoothedAggregation() is performed in CSR format");
         }
     }
+
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AMGPMISAggregate(ValueType             eps,
-                                                  LocalVector<bool>*    connections,
-                                                  LocalVector<int64_t>* aggregates,
-                                                  LocalVector<int64_t>* aggregate_root_nodes) const
+    void LocalMatrix<ValueType>::AMGProlongTruncate(double trunc_factor, int max_row_nnz)
     {
-        log_debug(
-            this, "LocalMatrix::AMGPMISAggregate()", connections, aggregates, aggregate_root_nodes);
-
-        assert(connections != NULL);
-        assert(aggregates != NULL);
-        assert(aggregate_root_nodes != NULL);
+        log_debug(this, "LocalMatrix::AMGProlongTruncate()", trunc_factor, max_row_nnz);
 
-        assert(this->is_host_() == connections->is_host_());
-        assert(this->is_host_() == aggregates->is_host_());
-        assert(this->is_host_() == aggregate_root_nodes->is_host_());
+        assert(trunc_factor >= 0.0);
+        assert(max_row_nnz >= 0);
 
 #ifdef DEBUG_MODE
         this->Check();
 #endif
-        // Only CSR matrices are supported
-        LocalMatrix<ValueType>        csr_mat;
-        const LocalMatrix<ValueType>* csr_ptr = this;
-        if(csr_ptr->GetFormat() != CSR)
-        {
-            csr_mat.CloneFrom(*csr_ptr);
-            csr_mat.ConvertToCSR();
-            csr_ptr = &csr_mat;
-        }
+
         if(this->GetNnz() > 0)
         {
-            // Zero structures
-            LocalMatrix<ValueType> zero_mat;
-            zero_mat.CloneBackend(*this);
-
-            LocalVector<int> izero_vec;
-            izero_vec.CloneBackend(*this);
-
-            LocalVector<int64_t> i64zero_vec;
-            i64zero_vec.CloneBackend(*this);
-
-            LocalVector<PtrType> pzero_vec;
-            pzero_vec.CloneBackend(*this);
-
-            connections->Allocate("Connections", csr_ptr->GetNnz());
-            aggregates->Allocate("Aggregates", csr_ptr->GetM());
-            aggregate_root_nodes->Allocate("Aggregate root nodes", csr_ptr->GetM());
-
-            LocalVector<int> hash;
-            hash.CloneBackend(*this);
-            hash.Allocate("hash", csr_ptr->GetM());
-
-            LocalVector<int> state;
-            state.CloneBackend(*this);
-            state.Allocate("state", csr_ptr->GetM());
-
-            LocalVector<int> max_state;
-            max_state.CloneBackend(*this);
-            max_state.Allocate("max_state", csr_ptr->GetM());
-
-            LocalVector<ValueType> diag;
-            diag.CloneBackend(*this);
-            diag.Allocate("diag", csr_ptr->GetM());
-
-            int64_t global_col_begin = 0;
-            int64_t global_col_end   = this->GetN();
+            bool err = this->matrix_->AMGProlongTruncate(trunc_factor, max_row_nnz);
 
-            csr_ptr->ExtractDiagonal(&diag);
-
-            // Compute connections
-            csr_ptr->matrix_->AMGComputeStrongConnections(
-                eps, *diag.vector_, *i64zero_vec.vector_, connections->vector_, *zero_mat.matrix_);
-
-            // Initialize max state
-            csr_ptr->matrix_->AMGPMISInitializeState(global_col_begin,
-                                                     *connections->vector_,
-                                                     max_state.vector_,
-                                                     hash.vector_,
-                                                     *zero_mat.matrix_);
+            if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGProlongTruncate() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
 
-            int iter = 0;
-            while(true)
+            if(err == false)
             {
-                state.CopyFrom(max_state);
+                // Move to host
+                bool   is_accel       = this->is_accel_();
+                double fallback_start = _rocalution_host_fallback_begin(
+                    "LocalMatrix::AMGProlongTruncate()", is_accel);
+                this->MoveToHost();
 
-                // Find maximum distance 2 node
-                bool undecided = false;
-                csr_ptr->matrix_->AMGPMISFindMaxNeighbourNode(global_col_begin,
-                                                              global_col_end,
-                                                              undecided,
-                                                              *connections->vector_,
-                                                              *state.vector_,
-                                                              *hash.vector_,
-                                                              *pzero_vec.vector_,
-                                                              *i64zero_vec.vector_,
-                                                              *izero_vec.vector_,
-                                                              *izero_vec.vector_,
-                                                              max_state.vector_,
-                                                              aggregates->vector_,
-                                                              *zero_mat.matrix_);
+                // Convert to CSR
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToCSR();
 
-                // If no more undecided nodes are left, we are done
-                if(undecided == false)
+                if(this->matrix_->AMGProlongTruncate(trunc_factor, max_row_nnz) == false)
                 {
-                    break;
+                    LOG_INFO("Computation of LocalMatrix::AMGProlongTruncate() failed");
+                    this->Info();
+                    FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                ++iter;
-
-                // Print some warning if number of iteration is getting huge
-                if(iter > 20)
+                if(format != CSR)
                 {
                     LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::AMGPMISAggregate() Current "
-                                     "number of iterations: "
-                                         << iter);
-                }
-            }
-
-            aggregate_root_nodes->SetValues(-1);
-
-            csr_ptr->matrix_->AMGPMISInitializeAggregateGlobalIndices(
-                global_col_begin, *aggregates->vector_, aggregate_root_nodes->vector_);
+                                     "*** warning: LocalMatrix::AMGProlongTruncate() is performed "
+                                     "in CSR format");
 
-            aggregates->ExclusiveSum();
+                    this->ConvertTo(format, blockdim);
+                }
 
-            // Add any unassigned nodes to existing aggregations
-            for(int k = 0; k < 2; k++)
-            {
-                state.CopyFrom(max_state);
+                if(is_accel == true)
+                {
+                    _rocalution_host_fallback_end("LocalMatrix::AMGProlongTruncate()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
-                csr_ptr->matrix_->AMGPMISAddUnassignedNodesToAggregations(
-                    global_col_begin,
-                    *connections->vector_,
-                    *state.vector_,
-                    *i64zero_vec.vector_,
-                    max_state.vector_,
-                    aggregates->vector_,
-                    aggregate_root_nodes->vector_,
-                    *zero_mat.matrix_);
+                    this->MoveToAccelerator();
+                }
             }
         }
 
-        if(this->GetFormat() != CSR)
-        {
-            LOG_VERBOSE_INFO(
-                2, "*** warning: LocalMatrix::AMGPMISAggregate() is performed in CSR format");
-        }
+#ifdef DEBUG_MODE
+        this->Check();
+#endif
     }
 
     template <typename ValueType>
-    void LocalMatrix<ValueType>::AMGSmoothedAggregation(
-        ValueType                   relax,
-        const LocalVector<bool>&    connections,
-        const LocalVector<int64_t>& aggregates,
-        const LocalVector<int64_t>& aggregate_root_nodes,
-        LocalMatrix<ValueType>*     prolong,
-        int                         lumping_strat) const
+    void LocalMatrix<ValueType>::AMGEnergyMinimization(ValueType               relax,
+                                                       int                     iterations,
+                                                       LocalMatrix<ValueType>* prolong) const
     {
-        log_debug(this,
-                  "LocalMatrix::AMGSmoothedAggregation()",
-                  relax,
-                  (const void*&)connections,
-                  (const void*&)aggregates,
-                  (const void*&)aggregate_root_nodes,
-                  prolong);
+        log_debug(this, "LocalMatrix::AMGEnergyMinimization()", relax, iterations, prolong);
 
-        assert(relax > static_cast<ValueType>(0));
+        assert(iterations >= 0);
         assert(prolong != NULL);
         assert(this != prolong);
-        assert(this->is_host_() == connections.is_host_());
-        assert(this->is_host_() == aggregates.is_host_());
-        assert(this->is_host_() == aggregate_root_nodes.is_host_());
+        assert(prolong->GetM() == this->GetM());
         assert(this->is_host_() == prolong->is_host_());
 
 #ifdef DEBUG_MODE
         this->Check();
+        prolong->Check();
 #endif
+
+        if(iterations == 0 || this->GetNnz() == 0 || prolong->GetNnz() == 0)
+        {
+            return;
+        }
+
         // Only CSR matrices are supported
         LocalMatrix<ValueType>        csr_mat;
         const LocalMatrix<ValueType>* csr_ptr = this;
@@ -6698,154 +10678,62 @@ namespace rocalution
             csr_ptr = &csr_mat;
         }
 
-        //csr_ptr->matrix_->AMGSmoothedAggregation(relax, *connections.vector_, *aggregates.vector_, prolong->matrix_, lumping_strat);
-
-        // Zero structures
-        LocalMatrix<ValueType> zero_mat;
-        zero_mat.CloneBackend(*this);
-
-        LocalVector<int> izero_vec;
-        izero_vec.CloneBackend(*this);
-
-        LocalVector<int64_t> i64zero_vec;
-        i64zero_vec.CloneBackend(*this);
-
-        int64_t global_col_begin = 0;
-        int64_t global_col_end   = this->GetN();
+        unsigned int format   = prolong->GetFormat();
+        int          blockdim = prolong->GetBlockDimension();
 
-        // fine to coarse map
-        LocalVector<int> f2c_map;
-        f2c_map.CloneBackend(*this);
-        f2c_map.Allocate("f2c map", csr_ptr->GetM() + 1);
-        f2c_map.Zeros();
+        prolong->ConvertToCSR();
 
-        // Determine number of non-zeros for P
-        bool err = csr_ptr->matrix_->AMGSmoothedAggregationProlongNnz(global_col_begin,
-                                                                      global_col_end,
-                                                                      *connections.vector_,
-                                                                      *aggregates.vector_,
-                                                                      *aggregate_root_nodes.vector_,
-                                                                      *zero_mat.matrix_,
-                                                                      f2c_map.vector_,
-                                                                      prolong->matrix_,
-                                                                      NULL);
+        bool err = csr_ptr->matrix_->AMGEnergyMinimization(relax, iterations, prolong->matrix_);
 
-        if((err == false) && (csr_ptr->is_host_() == true) && (csr_ptr->GetFormat() == CSR))
+        if((err == false) && (csr_ptr->is_host_() == true))
         {
-            LOG_INFO("Computation of LocalMatrix::ILU0Factorize() failed");
+            LOG_INFO("Computation of LocalMatrix::AMGEnergyMinimization() failed");
             csr_ptr->Info();
             FATAL_ERROR(__FILE__, __LINE__);
         }
 
         if(err == false)
         {
+            double fallback_start = _rocalution_host_fallback_begin(
+                "LocalMatrix::AMGEnergyMinimization()", csr_ptr->is_accel_());
+
             // Move to host
             LocalMatrix<ValueType> mat_host;
             mat_host.ConvertTo(csr_ptr->GetFormat());
             mat_host.CopyFrom(*csr_ptr);
 
-            LocalVector<bool> connections_host;
-            connections_host.CopyFrom(connections);
-
-            LocalVector<int64_t> aggregates_host;
-            aggregates_host.CopyFrom(aggregates);
-
-            LocalVector<int64_t> aggregate_root_nodes_host;
-            aggregate_root_nodes_host.CopyFrom(aggregate_root_nodes);
-
-            zero_mat.MoveToHost();
-            i64zero_vec.MoveToHost();
-            f2c_map.MoveToHost();
             prolong->MoveToHost();
 
-            // Convert to CSR
-            unsigned int format   = mat_host.GetFormat();
-            int          blockdim = mat_host.GetBlockDimension();
-            mat_host.ConvertToCSR();
-
-            if(mat_host.matrix_->AMGSmoothedAggregationProlongNnz(
-                   global_col_begin,
-                   global_col_end,
-                   *connections_host.vector_,
-                   *aggregates_host.vector_,
-                   *aggregate_root_nodes_host.vector_,
-                   *zero_mat.matrix_,
-                   f2c_map.vector_,
-                   prolong->matrix_,
-                   NULL)
-               == false)
-            {
-                LOG_INFO("Computation of LocalMatrix::AMGSmoothedAggregation() failed");
-                mat_host.Info();
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
-
-            if(mat_host.matrix_->AMGSmoothedAggregationProlongFill(
-                   global_col_begin,
-                   global_col_end,
-                   lumping_strat,
-                   relax,
-                   *connections_host.vector_,
-                   *aggregates_host.vector_,
-                   *aggregate_root_nodes_host.vector_,
-                   *i64zero_vec.vector_,
-                   *f2c_map.vector_,
-                   *zero_mat.matrix_,
-                   prolong->matrix_,
-                   NULL,
-                   NULL)
+            if(mat_host.matrix_->AMGEnergyMinimization(relax, iterations, prolong->matrix_)
                == false)
             {
-                LOG_INFO("Computation of LocalMatrix::AMGSmoothedAggregation() failed");
+                LOG_INFO("Computation of LocalMatrix::AMGEnergyMinimization() failed");
                 mat_host.Info();
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
-            if(format != CSR)
-            {
-                LOG_VERBOSE_INFO(2,
-                                 "*** warning: LocalMatrix::AMGSmoothedAggregation() is performed "
-                                 "in CSR format");
-            }
-
             if(csr_ptr->is_accel_() == true)
             {
-                LOG_VERBOSE_INFO(
-                    2,
-                    "*** warning: LocalMatrix::AMGSmoothedAggregation() is performed on the host");
+                _rocalution_host_fallback_end("LocalMatrix::AMGEnergyMinimization()",
+                                              fallback_start,
+                                              host_fallback_bytes(*this));
 
-                zero_mat.MoveToAccelerator();
-                i64zero_vec.MoveToAccelerator();
-                f2c_map.MoveToAccelerator();
                 prolong->MoveToAccelerator();
             }
         }
-        else
+
+        if(format != CSR)
         {
-            // Fill P
-            csr_ptr->matrix_->AMGSmoothedAggregationProlongFill(global_col_begin,
-                                                                global_col_end,
-                                                                lumping_strat,
-                                                                relax,
-                                                                *connections.vector_,
-                                                                *aggregates.vector_,
-                                                                *aggregate_root_nodes.vector_,
-                                                                *i64zero_vec.vector_,
-                                                                *f2c_map.vector_,
-                                                                *zero_mat.matrix_,
-                                                                prolong->matrix_,
-                                                                NULL,
-                                                                NULL);
+            LOG_VERBOSE_INFO(
+                2,
+                "*** warning: LocalMatrix::AMGEnergyMinimization() is performed in CSR format");
+
+            prolong->ConvertTo(format, blockdim);
         }
 
 #ifdef DEBUG_MODE
         prolong->Check();
 #endif
-        if(this->GetFormat() != CSR)
-        {
-            LOG_VERBOSE_INFO(
-                2, "*** warning: LocalMatrix::AMGSmoothedAggregation() is performed in CSR format");
-        }
     }
 
     template <typename ValueType>
@@ -6970,6 +10858,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::RSCoarsening()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat());
                 mat_host.CopyFrom(*this);
@@ -6996,8 +10888,8 @@ namespace rocalution
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::RSCoarsening() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::RSCoarsening()", fallback_start, host_fallback_bytes(*this));
 
                     CFmap->MoveToAccelerator();
                     S->MoveToAccelerator();
@@ -7352,6 +11244,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::InitialPairwiseAggregation()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
@@ -7380,9 +11276,9 @@ namespace rocalution
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::InitialPairwiseAggregation() is "
-                                     "performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::InitialPairwiseAggregation()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     G->MoveToAccelerator();
                 }
@@ -7440,6 +11336,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::InitialPairwiseAggregation()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 LocalMatrix<ValueType> mat2_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
@@ -7472,9 +11372,9 @@ namespace rocalution
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::InitialPairwiseAggregation() is "
-                                     "performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::InitialPairwiseAggregation()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     G->MoveToAccelerator();
                 }
@@ -7526,6 +11426,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::FurtherPairwiseAggregation()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
@@ -7554,9 +11458,9 @@ namespace rocalution
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::FurtherPairwiseAggregation() is "
-                                     "performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::FurtherPairwiseAggregation()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     G->MoveToAccelerator();
                 }
@@ -7614,6 +11518,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::FurtherPairwiseAggregation()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 LocalMatrix<ValueType> mat2_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
@@ -7645,9 +11553,9 @@ namespace rocalution
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::FurtherPairwiseAggregation() is "
-                                     "performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::FurtherPairwiseAggregation()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     G->MoveToAccelerator();
                 }
@@ -7705,6 +11613,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::CoarsenOperator()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
@@ -7743,8 +11655,9 @@ namespace rocalution
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::CoarsenOperator() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::CoarsenOperator()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     Ac->MoveToAccelerator();
                 }
@@ -7787,6 +11700,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::CreateFromMap()", map.is_accel_());
+
                 LocalVector<int> map_host;
                 map_host.CopyFrom(map);
 
@@ -7817,8 +11734,8 @@ namespace rocalution
 
                 if(map.is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::CreateFromMap() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::CreateFromMap()", fallback_start, host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -7865,6 +11782,9 @@ namespace rocalution
 
         if(err == false)
         {
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalMatrix::CreateFromMap()", map.is_accel_());
+
             LocalVector<int> map_host;
             map_host.CopyFrom(map);
 
@@ -7897,8 +11817,8 @@ namespace rocalution
 
             if(map.is_accel_() == true)
             {
-                LOG_VERBOSE_INFO(
-                    2, "*** warning: LocalMatrix::CreateFromMap() is performed on the host");
+                _rocalution_host_fallback_end(
+                    "LocalMatrix::CreateFromMap()", fallback_start, host_fallback_bytes(*this));
 
                 this->MoveToAccelerator();
                 pro->MoveToAccelerator();
@@ -7911,6 +11831,69 @@ namespace rocalution
 #endif
     }
 
+    template <typename ValueType>
+    bool LocalMatrix<ValueType>::ExtractAggregateMap(LocalVector<int>* map,
+                                                     ValueType*        weight) const
+    {
+        log_debug(this, "LocalMatrix::ExtractAggregateMap()", map, weight);
+
+        assert(map != NULL);
+        assert(weight != NULL);
+
+        int64_t nrow = this->GetM();
+        int64_t nnz  = this->GetNnz();
+
+        // A piecewise constant operator has at most one entry per row
+        if(nnz > nrow)
+        {
+            return false;
+        }
+
+        // Inspect the CSR structure on the host
+        LocalMatrix<ValueType> tmp;
+        tmp.CloneFrom(*this);
+        tmp.MoveToHost();
+        tmp.ConvertToCSR();
+
+        std::vector<PtrType>   row_offset(nrow + 1);
+        std::vector<int>       col(nnz);
+        std::vector<ValueType> val(nnz);
+
+        tmp.CopyToCSR(row_offset.data(), col.data(), val.data());
+        tmp.Clear();
+
+        std::vector<int> agg(nrow, -1);
+
+        *weight = static_cast<ValueType>(1);
+
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            PtrType row_begin = row_offset[i];
+            PtrType row_end   = row_offset[i + 1];
+
+            if(row_end == row_begin)
+            {
+                continue;
+            }
+
+            // All entries have to be equal to the first one, which is at offset 0
+            if(row_end - row_begin > 1 || (row_begin > 0 && val[row_begin] != *weight))
+            {
+                return false;
+            }
+
+            *weight = val[row_begin];
+            agg[i]  = col[row_begin];
+        }
+
+        map->Clear();
+        map->CloneBackend(*this);
+        map->Allocate("aggregate map", nrow);
+        map->CopyFromHostData(agg.data());
+
+        return true;
+    }
+
     template <typename ValueType>
     void LocalMatrix<ValueType>::LUFactorize(void)
     {
@@ -7931,10 +11914,30 @@ namespace rocalution
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
+            // Try DENSE format on the accelerator before falling back to the host
+            if((err == false) && (this->is_accel_() == true) && (this->GetFormat() != DENSE))
+            {
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToDENSE();
+
+                err = this->matrix_->LUFactorize();
+
+                if(err == true)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::LUFactorize() is performed in DENSE format");
+                }
+
+                this->ConvertTo(format, blockdim);
+            }
+
             if(err == false)
             {
                 // Move to host
                 bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::LUFactorize()", is_accel);
                 this->MoveToHost();
 
                 // Convert to DENSE
@@ -7959,8 +11962,8 @@ namespace rocalution
 
                 if(is_accel == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::LUFactorize() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::LUFactorize()", fallback_start, host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -8013,6 +12016,8 @@ namespace rocalution
             {
                 // Move to host
                 bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::FSAI()", is_accel);
                 this->MoveToHost();
 
                 // Convert to CSR
@@ -8052,8 +12057,8 @@ namespace rocalution
 
                 if(is_accel == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::FSAI() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::FSAI()", fallback_start, host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -8091,6 +12096,8 @@ namespace rocalution
             {
                 // Move to host
                 bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::SPAI()", is_accel);
                 this->MoveToHost();
 
                 // Convert to CSR
@@ -8115,8 +12122,8 @@ namespace rocalution
 
                 if(is_accel == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::SPAI() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::SPAI()", fallback_start, host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -8148,10 +12155,30 @@ namespace rocalution
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
+            // Try DENSE format on the accelerator before falling back to the host
+            if((err == false) && (this->is_accel_() == true) && (this->GetFormat() != DENSE))
+            {
+                unsigned int format   = this->GetFormat();
+                int          blockdim = this->GetBlockDimension();
+                this->ConvertToDENSE();
+
+                err = this->matrix_->Invert();
+
+                if(err == true)
+                {
+                    LOG_VERBOSE_INFO(
+                        2, "*** warning: LocalMatrix::Invert() is performed in DENSE format");
+                }
+
+                this->ConvertTo(format, blockdim);
+            }
+
             if(err == false)
             {
                 // Move to host
                 bool is_accel = this->is_accel_();
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalMatrix::Invert()", is_accel);
                 this->MoveToHost();
 
                 // Convert to DENSE
@@ -8176,8 +12203,8 @@ namespace rocalution
 
                 if(is_accel == true)
                 {
-                    LOG_VERBOSE_INFO(2,
-                                     "*** warning: LocalMatrix::Invert() is performed on the host");
+                    _rocalution_host_fallback_end(
+                        "LocalMatrix::Invert()", fallback_start, host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -8217,6 +12244,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ReplaceColumnVector()", vec.is_accel_());
+
                 LocalVector<ValueType> vec_host;
                 vec_host.CopyFrom(vec);
 
@@ -8252,9 +12283,9 @@ namespace rocalution
 
                 if(vec.is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::ReplaceColumnVector() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ReplaceColumnVector()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -8295,6 +12326,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ExtractColumnVector()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
@@ -8321,9 +12356,9 @@ namespace rocalution
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::ExtractColumnVector() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ExtractColumnVector()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     vec->MoveToAccelerator();
                 }
@@ -8359,6 +12394,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ReplaceRowVector()", vec.is_accel_());
+
                 LocalVector<ValueType> vec_host;
                 vec_host.CopyFrom(vec);
 
@@ -8394,8 +12433,9 @@ namespace rocalution
 
                 if(vec.is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ReplaceRowVector() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ReplaceRowVector()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     this->MoveToAccelerator();
                 }
@@ -8436,6 +12476,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::ExtractRowVector()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 mat_host.ConvertTo(this->GetFormat(), this->GetBlockDimension());
                 mat_host.CopyFrom(*this);
@@ -8462,8 +12506,9 @@ namespace rocalution
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2, "*** warning: LocalMatrix::ExtractRowVector() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::ExtractRowVector()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     vec->MoveToAccelerator();
                 }
@@ -8512,6 +12557,9 @@ namespace rocalution
 
         if(err == false)
         {
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalMatrix::CompressAdd()", ext.is_accel_());
+
             LocalVector<int64_t>   l2g_host;
             LocalVector<int64_t>   ggc_host;
             LocalMatrix<ValueType> ext_host;
@@ -8548,8 +12596,8 @@ namespace rocalution
 
             if(ext.is_accel_() == true)
             {
-                LOG_VERBOSE_INFO(
-                    2, "*** warning: LocalMatrix::CompressAdd() is performed on the host");
+                _rocalution_host_fallback_end(
+                    "LocalMatrix::CompressAdd()", fallback_start, host_fallback_bytes(*this));
 
                 this->MoveToAccelerator();
 
@@ -8640,6 +12688,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::RSExtPIProlongNnz()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 LocalVector<int64_t>   l2g_host;
                 LocalVector<int>       cf_host;
@@ -8711,9 +12763,9 @@ namespace rocalution
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::RSExtPIProlongNnz() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::RSExtPIProlongNnz()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     f2c->MoveToAccelerator();
                     prolong_int->MoveToAccelerator();
@@ -8828,6 +12880,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin(
+                        "LocalMatrix::RSExtPIProlongFill()", this->is_accel_());
+
                 LocalMatrix<ValueType> mat_host;
                 LocalVector<int64_t>   l2g_host;
                 LocalVector<int>       f2c_host;
@@ -8916,9 +12972,9 @@ namespace rocalution
 
                 if(this->is_accel_() == true)
                 {
-                    LOG_VERBOSE_INFO(
-                        2,
-                        "*** warning: LocalMatrix::RSExtPIProlongFill() is performed on the host");
+                    _rocalution_host_fallback_end("LocalMatrix::RSExtPIProlongFill()",
+                                                  fallback_start,
+                                                  host_fallback_bytes(*this));
 
                     prolong_int->MoveToAccelerator();
 
@@ -28,6 +28,7 @@
 #include "matrix_formats.hpp"
 #include "operator.hpp"
 #include "rocalution/export.hpp"
+#include "rocalution/utils/type_traits.hpp"
 #include "rocalution/utils/types.hpp"
 
 namespace rocalution
@@ -41,6 +42,10 @@ namespace rocalution
     template <typename ValueType>
     class LocalVector;
     template <typename ValueType>
+    class LocalMultiVector;
+    template <typename ValueType>
+    class LocalBatchMatrix;
+    template <typename ValueType>
     class GlobalVector;
 
     template <typename ValueType>
@@ -57,7 +62,7 @@ namespace rocalution
   * \tparam ValueType - can be int, float, double, std::complex<float> and
   *                     std::complex<double>
   *
-  * A number of matrix formats are supported. These are CSR, BCSR, MCSR, COO, DIA, ELL, HYB, and DENSE.
+  * A number of matrix formats are supported. These are CSR, BCSR, MCSR, COO, DIA, ELL, HYB, SELL, VBR, and DENSE.
   * \note For CSR type matrices, the column indices must be sorted in increasing order. For COO matrices, the row
   * indices must be sorted in increasing order. The function \p Check can be used to check whether a matrix
   * contains valid data. For CSR and COO matrices, the function \p Sort can be used to sort the row or column
@@ -273,6 +278,40 @@ namespace rocalution
         void LeaveDataPtrDENSE(ValueType** val);
         /**@}*/
 
+        /** \brief Use externally allocated CSR arrays in place
+      * \details
+      * \p AttachCSRView makes the LocalMatrix operate directly on the given CSR arrays,
+      * without copying them and without taking their ownership. The arrays have to live
+      * on the current backend of the matrix (host memory on the host, device memory on
+      * the accelerator) and must stay valid until the matrix is cleared, reallocated or
+      * destroyed, which never frees them. Operations that only update values, such as
+      * Scale() or ILU0Factorize(), write into the external arrays. Operations that
+      * reallocate them, such as Sort(), Permute(), format conversions or moving the matrix
+      * to another backend, give the matrix its own copy first. LeaveDataPtrCSR() returns
+      * an owned copy.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // Device arrays from an external assembly
+      *   int*       d_row_ptr = ...;
+      *   int*       d_col_ind = ...;
+      *   ValueType* d_val     = ...;
+      *
+      *   LocalMatrix<ValueType> mat;
+      *   mat.MoveToAccelerator();
+      *
+      *   mat.AttachCSRView(d_row_ptr, d_col_ind, d_val, "mat", nnz, m, n);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void AttachCSRView(PtrType*    row_offset,
+                           int*        col,
+                           ValueType*  val,
+                           std::string name,
+                           int64_t     nnz,
+                           int64_t     nrow,
+                           int64_t     ncol);
+
         /** \brief Clear (free) the matrix */
         ROCALUTION_EXPORT
         void Clear(void);
@@ -337,6 +376,38 @@ namespace rocalution
         ROCALUTION_EXPORT
         void ExtractInverseDiagonal(LocalVector<ValueType>* vec_inv_diag) const;
 
+        /** \brief Extract the inverses of the dense diagonal blocks of the matrix
+      * \details
+      * The matrix is split into dense diagonal blocks of size \p blockdim, each of which
+      * is inverted by Gauss-Jordan elimination with partial pivoting. The inverses are
+      * stored as block diagonal matrix \p inv_diag in CSR format, which can be converted
+      * to BCSR with block dimension \p blockdim for a batched block diagonal product.
+      * The number of rows has to be a multiple of \p blockdim.
+      *
+      * @param[in]
+      * blockdim    dimension of the diagonal blocks.
+      * @param[out]
+      * inv_diag    block diagonal matrix holding the inverted blocks.
+      */
+        ROCALUTION_EXPORT
+        void ExtractInverseBlockDiagonal(int blockdim, LocalMatrix<ValueType>* inv_diag) const;
+
+        /** \brief Extract the l1 norm of each row of the matrix into a LocalVector
+      * \details
+      * Entry \p i of \p vec_l1 holds the sum of the absolute values of all entries in row
+      * \p i, as used for l1 scaled smoothers.
+      */
+        ROCALUTION_EXPORT
+        void ExtractRowL1Norm(LocalVector<ValueType>* vec_l1) const;
+
+        /** \brief Flag all rows with an entry in one of the flagged columns
+      * \details
+      * \p rows[i] is set, if row \f$i\f$ has a non-zero entry \f$a_{ij}\f$ with
+      * \p cols[j] set. Only the sparsity pattern of the matrix is considered.
+      */
+        ROCALUTION_EXPORT
+        void ExtractConnectedRows(const LocalVector<bool>& cols, LocalVector<bool>* rows) const;
+
         /** \brief Extract the upper triangular matrix */
         ROCALUTION_EXPORT
         void ExtractU(LocalMatrix<ValueType>* U, bool diag) const;
@@ -408,6 +479,100 @@ namespace rocalution
         ROCALUTION_EXPORT
         void ConnectivityOrder(LocalVector<int>* permutation) const;
 
+        /** \brief Partition the graph of the matrix
+      * \details
+      * \p GraphPartition splits the rows of a square matrix into \p nparts parts with a
+      * small number of entries coupling different parts (edge cut). The graph is the
+      * symmetrized sparsity pattern of the matrix. Parts are balanced like a contiguous
+      * block distribution, part \f$p\f$ gets \f$n / nparts\f$ rows and the first
+      * \f$n \bmod nparts\f$ parts one row more. The partition is computed by recursive
+      * bisection, growing one side from a pseudo-peripheral vertex and refining the cut
+      * with Kernighan-Lin swaps. It is computed on the host.
+      *
+      * @param[in]
+      * nparts     number of parts.
+      * @param[out]
+      * partition  part of each row.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalVector<int> part;
+      *
+      *   mat.GraphPartition(4, &part);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void GraphPartition(int nparts, LocalVector<int>* partition) const;
+
+        /** \brief Create permutation vector for approximate minimum degree reordering of
+      * the matrix
+      * \details
+      * The approximate minimum degree ordering reduces the fill-in of (incomplete) LU
+      * factorizations. It eliminates, in each step, a row with smallest approximate
+      * external degree in the quotient graph of the symmetrized sparsity pattern. It is
+      * computed on the host.
+      *
+      * @param[out]
+      * permutation permutation vector for approximate minimum degree reordering
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalVector<int> amd;
+      *
+      *   mat.AMD(&amd);
+      *   mat.Permute(amd);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void AMD(LocalVector<int>* permutation) const;
+
+        /** \brief Create permutation vector for nested dissection reordering of the matrix
+      * \details
+      * Nested dissection recursively splits the graph of the symmetrized sparsity
+      * pattern by vertex separators, taken from the middle level of a breadth first
+      * search rooted at a pseudo-peripheral vertex. Both halves are ordered before their
+      * separator, subsets with at most \p leaf_size rows are ordered by approximate
+      * minimum degree. Independent subsets are processed in parallel on the host.
+      *
+      * The separator tree is returned in post order. Node \f$k\f$ holds the permuted
+      * rows \f$[node\_offset[k], node\_offset[k+1])\f$ and its parent is
+      * \f$node\_parent[k]\f$ (-1 for the root). Nodes whose subtrees are disjoint do not
+      * couple, so they can be factorized and solved concurrently.
+      *
+      * @param[out]
+      * num_nodes   number of nodes of the separator tree
+      * @param[out]
+      * node_offset pointer to array of size num_nodes + 1 with the first row of each
+      *             node (allocated in the function)
+      * @param[out]
+      * node_parent pointer to array of size num_nodes with the parent of each node
+      *             (allocated in the function)
+      * @param[out]
+      * permutation permutation vector for nested dissection reordering
+      * @param[in]
+      * leaf_size   maximum number of rows of a leaf
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalVector<int> nd;
+      *   int num_nodes;
+      *   int* node_offset = NULL;
+      *   int* node_parent = NULL;
+      *
+      *   mat.NestedDissection(num_nodes, &node_offset, &node_parent, &nd);
+      *   mat.Permute(nd);
+      *
+      *   free_host(&node_offset);
+      *   free_host(&node_parent);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void NestedDissection(int&              num_nodes,
+                              int**             node_offset,
+                              int**             node_parent,
+                              LocalVector<int>* permutation,
+                              int               leaf_size = 64) const;
+
         /** \brief Perform multi-coloring decomposition of the matrix
       * \details
       * The Multi-Coloring algorithm builds a permutation (coloring of the matrix) in a
@@ -437,6 +602,9 @@ namespace rocalution
       * \details
       * The Maximal Independent Set algorithm finds a set with maximal size, that
       * contains elements that do not depend on other elements in this set.
+      * The host computes the set greedily in row order, while the accelerator uses
+      * Luby's randomized algorithm. Both sets are maximal, but they are in general
+      * not identical.
       *
       * @param[out]
       * size        number of independent sets
@@ -568,6 +736,34 @@ namespace rocalution
         ROCALUTION_EXPORT
         void USolve(const LocalVector<ValueType>& in, LocalVector<ValueType>* out) const;
 
+        /** \brief Number of levels of the triangular dependency graph
+      * \details
+      * Returns the number of levels of the level-scheduling analysis of the lower
+      * (\p lower = true) or upper triangular part, i.e. the number of sequential
+      * steps of LSolve() or USolve(). GetM() divided by the number of levels is the
+      * average parallelism of the triangular solves, see
+      * SolverDescr::SelectTriSolverAlg().
+      */
+        ROCALUTION_EXPORT
+        int GetTriangularLevels(bool lower) const;
+
+        /** \brief Inverses of the diagonal blocks of a triangular part
+      * \details
+      * Partitions the rows of the lower (\p lower = true) or upper triangular part
+      * into contiguous blocks of \p block_size rows. \p inv holds the exact inverses
+      * of the triangular diagonal blocks, with a unit diagonal if \p diag_unit is set,
+      * and \p off the couplings between the blocks. The triangular system T x = b can
+      * then be solved by the block Jacobi sweeps x = inv (b - off x), which only
+      * require SpMV and are exact after as many sweeps as the block dependency graph
+      * has levels.
+      */
+        ROCALUTION_EXPORT
+        void TriangularBlockInverse(bool                    lower,
+                                    bool                    diag_unit,
+                                    int                     block_size,
+                                    LocalMatrix<ValueType>* inv,
+                                    LocalMatrix<ValueType>* off) const;
+
         /** \brief Analyse the structure for Iterative solve */
         ROCALUTION_EXPORT
         void ItLUAnalyse(void);
@@ -802,9 +998,20 @@ namespace rocalution
         * The matrix is written using the current rocalution matrix format,
         * e.g. if this->GetFormat() == ELL, the matrix will be stored in
         * ELL format.
+        *
+        * If \p compress is true, the matrix is stored in a compressed CSR file
+        * instead. Row lengths and column index deltas are stored as variable length
+        * integers, values are XORed with their predecessor and stored without leading
+        * zero bytes. The rows are split into chunks that are encoded and decoded in
+        * parallel. ReadFileRSIO() detects compressed files automatically.
+        *
+        * @param[in]
+        * filename    name of the file to write the data to.
+        * @param[in]
+        * compress    write a compressed CSR file.
         */
         ROCALUTION_EXPORT
-        void WriteFileRSIO(const std::string& filename) const;
+        void WriteFileRSIO(const std::string& filename, bool compress = false) const;
 
         /** \brief Move all data (i.e. move the matrix) to the accelerator */
         ROCALUTION_EXPORT
@@ -812,6 +1019,10 @@ namespace rocalution
         /** \brief Move all data (i.e. move the matrix) to the accelerator asynchronously */
         ROCALUTION_EXPORT
         virtual void MoveToAcceleratorAsync(void);
+        /** \brief Move all data (i.e. move the matrix) to the device of an execution context
+        * and attach the matrix to it. Data on another device is copied device to device. */
+        ROCALUTION_EXPORT
+        void MoveToAccelerator(const ExecutionContext& context);
         /** \brief Move all data (i.e. move the matrix) to the host */
         ROCALUTION_EXPORT
         virtual void MoveToHost(void);
@@ -821,6 +1032,12 @@ namespace rocalution
         /** \brief Synchronize the matrix */
         ROCALUTION_EXPORT
         virtual void Sync(void);
+        /** \brief Migrate the matrix data to the accelerator (managed memory mode) */
+        ROCALUTION_EXPORT
+        virtual void Prefetch(void) const;
+        /** \brief Attach the matrix to an execution context */
+        ROCALUTION_EXPORT
+        virtual void SetExecutionContext(const ExecutionContext& context);
 
         /** \brief Copy matrix from another LocalMatrix
       * \details
@@ -884,10 +1101,106 @@ namespace rocalution
         ROCALUTION_EXPORT
         void CloneFrom(const LocalMatrix<ValueType>& src);
 
-        /** \brief Update CSR matrix entries only, structure will remain the same */
+        /** \brief Clone the matrix, sharing its sparsity pattern
+      * \details
+      * \p ShareStructureFrom clones the matrix like CloneFrom(), but a CSR matrix keeps
+      * referencing the row offsets and column indices of \p src and only owns a copy of
+      * the values. The pattern is reference counted and released with the last matrix
+      * using it. Operations that change the pattern in place, such as Sort() or Permute(),
+      * give the modified matrix its own copy first. Other formats are cloned.
+      *
+      * @param[in]
+      * src Matrix to clone.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // ILU(0) factors on the pattern of the operator
+      *   LocalMatrix<ValueType> ilu;
+      *
+      *   ilu.ShareStructureFrom(mat);
+      *   ilu.ILU0Factorize();
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void ShareStructureFrom(const LocalMatrix<ValueType>& src);
+
+        /** \brief Update CSR matrix entries only, structure will remain the same
+      * \details
+      * \p val is a host array holding the new values in CSR order. The values are copied
+      * to the backend of the matrix directly, a matrix on the accelerator remains there.
+      */
         ROCALUTION_EXPORT
         void UpdateValuesCSR(ValueType* val);
 
+        /** \brief Update CSR matrix entries from a vector, structure will remain the same
+      * \details
+      * \p val and \p perm have to be on the same backend as the matrix, no data is
+      * transferred between host and accelerator. Without \p perm, \p val holds the new
+      * values in CSR order. Otherwise \p perm maps the values from the order they are
+      * assembled in to CSR order, i.e. \p val[k] is the new value of CSR entry
+      * \p perm[k]. The map is typically set up once and reused for all updates.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // Device array of nnz values in assembly order
+      *   LocalVector<ValueType> val;
+      *   val.MoveToAccelerator();
+      *   val.SetDataPtr(&dval, "val", nnz);
+      *
+      *   mat.UpdateValuesCSR(val, &perm);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void UpdateValuesCSR(const LocalVector<ValueType>& val,
+                             const LocalVector<int>*       perm = NULL);
+
+        /** \brief Symbolic phase of the repeated assembly from COO entries
+      * \details
+      * Builds the CSR structure of the \p nrow x \p ncol matrix from the \p nnz host
+      * COO indices \p row and \p col, which may be unsorted and contain duplicates. All
+      * values are set to zero. The scatter map from the COO entries into the CSR value
+      * array is stored in \p offset and \p perm: the CSR entry j sums up the COO values
+      * perm[offset[j]], ..., perm[offset[j + 1] - 1]. The matrix keeps its backend, the
+      * map is placed on the backend of the matrix.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalVector<int> offset;
+      *   LocalVector<int> perm;
+      *
+      *   // Sparsity pattern of the element contributions, once
+      *   mat.AssembleCOOSymbolic(nnz, row, col, nrow, ncol, &offset, &perm);
+      *
+      *   for(int step = 0; step < nsteps; ++step)
+      *   {
+      *       // Element contributions in the same order as row and col
+      *       // ...
+      *       mat.AssembleCOONumeric(val, offset, perm);
+      *   }
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void AssembleCOOSymbolic(int64_t           nnz,
+                                 const int*        row,
+                                 const int*        col,
+                                 int64_t           nrow,
+                                 int64_t           ncol,
+                                 LocalVector<int>* offset,
+                                 LocalVector<int>* perm);
+
+        /** \brief Numeric phase of the repeated assembly from COO entries
+      * \details
+      * Sets the values of the matrix to the sums of the COO values \p val, using the
+      * scatter map \p offset and \p perm of a previous AssembleCOOSymbolic(). \p val
+      * holds the values in the order of the COO indices of the symbolic phase. All
+      * vectors have to be on the same backend as the matrix, the sums are computed in
+      * a single pass without atomics.
+      */
+        ROCALUTION_EXPORT
+        void AssembleCOONumeric(const LocalVector<ValueType>& val,
+                                const LocalVector<int>&       offset,
+                                const LocalVector<int>&       perm);
+
         /** \brief Copy (import) CSR matrix described in three arrays (offsets, columns,
       * values). The object data has to be allocated (call AllocateCSR first)
       */
@@ -954,6 +1267,17 @@ namespace rocalution
                            int64_t                 n,
                            int64_t                 m,
                            LocalMatrix<ValueType>* pro);
+        /** \brief Extract the aggregate map of a piecewise constant prolongation
+      * \details
+      * \p ExtractAggregateMap is the inverse of CreateFromMap(). If the matrix has at
+      * most one non-zero per row and all its non-zeros have the same value, \p map
+      * receives the column of the non-zero of each row (-1 for empty rows) and
+      * \p weight the common value, i.e. the matrix equals \p weight times the
+      * prolongation created from \p map. Otherwise, false is returned and \p map is
+      * not modified.
+      */
+        ROCALUTION_EXPORT
+        bool ExtractAggregateMap(LocalVector<int>* map, ValueType* weight) const;
 
         /** \brief Convert the matrix to CSR structure */
         ROCALUTION_EXPORT
@@ -979,9 +1303,309 @@ namespace rocalution
         /** \brief Convert the matrix to DENSE structure */
         ROCALUTION_EXPORT
         void ConvertToDENSE(void);
-        /** \brief Convert the matrix to specified matrix ID format */
+        /** \brief Convert the matrix to SELL-C-sigma (sliced ELL) structure
+      * \details
+      * Rows are sorted by their length within windows of sigma rows and packed into
+      * slices of C rows, each slice being padded to its longest row only.
+      */
+        ROCALUTION_EXPORT
+        void ConvertToSELL(void);
+        /** \brief Convert the matrix to VBR (variable block row) structure
+      * \details
+      * Consecutive rows with identical sparsity pattern, e.g. the unknowns of a mesh
+      * node, are detected automatically and merged into block rows of up to 16 rows.
+      * For square matrices, the columns are partitioned alike. The blocks are stored
+      * densely.
+      */
+        ROCALUTION_EXPORT
+        void ConvertToVBR(void);
+        /** \brief Convert the matrix to specified matrix ID format
+      * \details
+      * On the accelerator, the converted matrix is allocated while the source still
+      * exists. If both do not fit into the free device memory, the conversion is
+      * carried out on the host and only the converted matrix is moved back, see
+      * EstimateConversionMemory().
+      */
         ROCALUTION_EXPORT
         void ConvertTo(unsigned int matrix_format, int blockdim = 1);
+        /** \brief Estimate the memory required by a format conversion
+      * \details
+      * \p format_bytes returns the size of the matrix in \p matrix_format with block
+      * dimension \p blockdim, \p peak_bytes the peak memory of ConvertTo() on the
+      * current backend, where source and converted matrix (and an intermediate CSR
+      * matrix, if neither of both is CSR) exist at the same time. The sparsity pattern
+      * is analyzed on the host, a matrix on the accelerator is copied to the host for
+      * this purpose. For SELL, the size is an upper bound.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   int64_t format_bytes;
+      *   int64_t peak_bytes;
+      *   mat.EstimateConversionMemory(BCSR, 3, &format_bytes, &peak_bytes);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void EstimateConversionMemory(unsigned int matrix_format,
+                                      int          blockdim,
+                                      int64_t*     format_bytes,
+                                      int64_t*     peak_bytes) const;
+        /** \brief Analyze the sparsity pattern for the matrix format selection
+      * \details
+      * \p AnalyzeFormats detects the natural BCSR block dimension, the number of
+      * distinct diagonals and the padding of ELL, and predicts the size and the SpMV
+      * memory traffic of the matrix in each format, see MatrixFormatAnalysis. Nothing
+      * is converted, such that a format that would not fit into memory can be ruled out
+      * beforehand. The sparsity pattern is analyzed on the host, a matrix on the
+      * accelerator is copied to the host for this purpose.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   MatrixFormatAnalysis analysis;
+      *   mat.AnalyzeFormats(&analysis);
+      *
+      *   if(analysis.format_bytes[DIA] > 0 && analysis.dia_fill < 1.2)
+      *   {
+      *       mat.ConvertToDIA();
+      *   }
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void AnalyzeFormats(MatrixFormatAnalysis* analysis) const;
+        /** \brief Compute statistics of the matrix
+      * \details
+      * \p Statistics computes the row length distribution, the bandwidth and the
+      * profile, the fraction of diagonally dominant rows and whether the matrix is
+      * symmetric, see MatrixStatistics. On the accelerator, the statistics are computed
+      * and reduced on the device and only the result is copied to the host. Matrices
+      * that are not in CSR format are converted to CSR on a temporary copy.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   MatrixStatistics stats;
+      *   mat.Statistics(&stats);
+      *
+      *   if(stats.symmetric == true)
+      *   {
+      *       solver = new CG<LocalMatrix<double>, LocalVector<double>, double>;
+      *   }
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void Statistics(MatrixStatistics* stats) const;
+        /** \brief Convert the matrix to the format with the fastest matrix-vector product
+      * \details
+      * \p ConvertToBest times \p trials matrix-vector products on the current backend
+      * for each candidate format (CSR, BCSR with the block dimension detected from the
+      * structure, ELL, DIA, HYB and SELL) and converts the matrix to the fastest one.
+      * ELL, DIA and BCSR are only tried if their padding is small. On the accelerator,
+      * the thread block size of the DIA and SELL kernels is tuned, too.
+      *
+      * The decision is cached with a signature of the matrix (device architecture,
+      * value type, sizes, row length histogram and the structure keys of \p Key()),
+      * matrices with the same signature are converted without timing. The cache can be
+      * kept across runs in a file, see set_tuning_cache_rocalution().
+      *
+      * @param[in]
+      * trials  number of timed matrix-vector products per candidate
+      *
+      * \par Example
+      * \code{.cpp}
+      *   mat.MoveToAccelerator();
+      *   mat.ConvertToBest();
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void ConvertToBest(int trials = 10);
+
+        /** \brief Set the algorithm of the CSR matrix-vector product
+      * \details
+      * \p SetSpMVAlg selects the algorithm of Apply() and ApplyAdd() for CSR matrices on
+      * the accelerator. With SpMVAlg_Auto (default), the algorithm is selected from the
+      * row length distribution of the matrix, such that matrices with a few very long
+      * rows use the load balanced logarithmic row binning and hyper-sparse matrices, with
+      * at most one non-empty row in eight, only process their non-empty rows
+      * (SpMVAlg_RowList). The setting is kept across
+      * format conversions and moves between host and accelerator.
+      *
+      * @param[in]
+      * alg     matrix-vector product algorithm, see SpMVAlg.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   mat.MoveToAccelerator();
+      *   mat.SetSpMVAlg(SpMVAlg_LRB);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void SetSpMVAlg(SpMVAlg alg);
+        /** \brief Return the algorithm of the CSR matrix-vector product */
+        ROCALUTION_EXPORT
+        SpMVAlg GetSpMVAlg(void) const;
+
+        /** \brief Set the value storage of the CSR matrix-vector product
+      * \details
+      * \p SetSpMVStorage selects the precision in which Apply() and ApplyAdd() read the
+      * matrix values for float and double precision CSR matrices on the accelerator.
+      * With SpMVStorage_Float (double matrices only), SpMVStorage_Half or
+      * SpMVStorage_BFloat16, a rounded copy of the values is kept next to the matrix and
+      * the products are accumulated in the precision of the matrix. This reduces the
+      * memory traffic of the product at the cost of a relative error in the order of
+      * the round-off of the storage precision, about 1e-3 for half and 1e-2 for
+      * bfloat16. Half values are limited to a magnitude of 65504, bfloat16 keeps the
+      * range of float. All other operations keep using the full precision values. The
+      * setting is ignored for other value types and formats and is kept across format
+      * conversions and moves between host and accelerator.
+      *
+      * @param[in]
+      * storage value storage, see SpMVStorage.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // Coarse grid operator, applied at reduced precision
+      *   mat.MoveToAccelerator();
+      *   mat.SetSpMVStorage(SpMVStorage_Float);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void SetSpMVStorage(SpMVStorage storage);
+        /** \brief Return the value storage of the CSR matrix-vector product */
+        ROCALUTION_EXPORT
+        SpMVStorage GetSpMVStorage(void) const;
+
+        /** \brief Set the column index storage of the CSR matrix-vector product
+      * \details
+      * \p SetSpMVIndex selects how Apply() and ApplyAdd() read the column indices of CSR
+      * matrices. With SpMVIndex_Compressed, the smallest column of each row is kept as
+      * base and the column indices are stored as 8 or 16 bit offsets to it, next to the
+      * matrix. Rows whose column span exceeds the offsets read their 32 bit column
+      * indices instead. The offset width is chosen from the column spans of
+      * the rows, such that the index traffic of the product is minimal, and the
+      * compression is skipped if it does not reduce the traffic. The compressed indices
+      * are built on the first product after a change of the sparsity pattern, updates of
+      * the values keep them. On the accelerator, they are used with SpMVStorage_Full
+      * only. The product is exact. The setting is ignored for other formats and is kept
+      * across format conversions and moves between host and accelerator.
+      *
+      * @param[in]
+      * index column index storage, see SpMVIndex.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   mat.MoveToAccelerator();
+      *   mat.SetSpMVIndex(SpMVIndex_Compressed);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void SetSpMVIndex(SpMVIndex index);
+        /** \brief Return the column index storage of the CSR matrix-vector product */
+        ROCALUTION_EXPORT
+        SpMVIndex GetSpMVIndex(void) const;
+
+        /** \brief Keep the matrix in host memory and stream it to the accelerator
+      * \details
+      * \p SetOutOfCore enables the out-of-core mode of CSR matrices on the accelerator,
+      * for operators that do not fit into device memory. The column indices and values
+      * stay in host memory, that is readable by the device, and only the row offsets are
+      * placed in device memory. Apply() and ApplyAdd() split the rows into chunks of at
+      * most \p chunk_nnz entries and transfer them to the device on two streams, such
+      * that the transfer of the next chunk overlaps with the product of the current one.
+      * Vectors stay in device memory. All other operations keep working on the host
+      * resident arrays, but operations that rebuild the matrix place the result in device
+      * memory. The setting is applied whenever the matrix is moved to the accelerator,
+      * and has no effect for other formats and on the host.
+      *
+      * @param[in]
+      * onoff       enable or disable the out-of-core mode.
+      * @param[in]
+      * chunk_nnz   maximum number of entries per chunk, 0 selects 4M entries.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // Operator that exceeds the device memory, solved with vectors on the device
+      *   mat.SetOutOfCore(true);
+      *   mat.MoveToAccelerator();
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void SetOutOfCore(bool onoff, int64_t chunk_nnz = 0);
+
+        /** \brief Store only the upper triangle of a symmetric matrix
+      * \details
+      * \p ConvertToSymmetricStorage converts the matrix to CSR and drops its strictly
+      * lower triangle, such that the matrix keeps the upper triangle and the diagonal
+      * only. Apply() and ApplyAdd() then compute the product with the full symmetric
+      * (not Hermitian) matrix, reading each off-diagonal entry once for both triangles.
+      * For complex matrices, this is the complex symmetric storage, e.g. of frequency
+      * domain discretizations.
+      * This nearly halves the memory and the memory traffic of the matrix-vector
+      * product. Transpose() is a no-op, ExtractDiagonal() and ExtractInverseDiagonal()
+      * are not affected, such that the matrix can be used as operator of CG with the
+      * Jacobi and IC preconditioners. All other operations, including GetNnz(), act on
+      * the stored upper triangle; ConvertToFullStorage() restores both triangles. The
+      * storage is kept across moves between host and accelerator and is copied by
+      * CopyFrom() and CloneFrom(); Clear() and the allocation functions reset it.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   mat.ConvertToSymmetricStorage();
+      *   mat.MoveToAccelerator();
+      *
+      *   CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+      *   IC<LocalMatrix<T>, LocalVector<T>, T> p;
+      *
+      *   ls.SetOperator(mat);
+      *   ls.SetPreconditioner(p);
+      *   ls.Build();
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void ConvertToSymmetricStorage(void);
+        /** \brief Restore both triangles of a matrix in symmetric storage, see
+      * ConvertToSymmetricStorage()
+      */
+        ROCALUTION_EXPORT
+        void ConvertToFullStorage(void);
+        /** \brief Return true if only the upper triangle of the matrix is stored */
+        ROCALUTION_EXPORT
+        bool GetSymmetricStorage(void) const;
+
+        /** \brief Extract the real equivalent of a complex matrix
+      * \details
+      * \p ExtractRealEquivalent stores the complex matrix as a real BCSR matrix with
+      * 2x2 blocks, where each entry \f$a + ib\f$ becomes the block
+      * \f$\begin{pmatrix} a & -b \\ b & a \end{pmatrix}\f$. The real equivalent
+      * operates on vectors with interleaved real and imaginary parts, which is the
+      * memory layout of a complex vector, see LocalVector::ExtractRealEquivalent().
+      * This allows the real BCSR kernels and, after ConvertToCSR(), the real-valued
+      * multigrid methods to be used for complex systems. The real equivalent is
+      * created on the backend of this matrix; the conversion is done on the host. Only
+      * available for complex value types.
+      *
+      * @param[out]
+      * mat     real equivalent of size 2m x 2n.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalMatrix<std::complex<double>> A;
+      *   LocalVector<std::complex<double>> x, b;
+      *
+      *   LocalMatrix<double> Ar;
+      *   LocalVector<double> xr, br;
+      *
+      *   A.ExtractRealEquivalent(&Ar);
+      *   b.ExtractRealEquivalent(&br);
+      *   xr.CloneFrom(br);
+      *
+      *   // Solve Ar xr = br with a real-valued solver
+      *   ls.SetOperator(Ar);
+      *   ls.Build();
+      *   ls.Solve(br, &xr);
+      *
+      *   x.CopyFromRealEquivalent(xr);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void ExtractRealEquivalent(LocalMatrix<numeric_traits_t<ValueType>>* mat) const;
 
         /** \brief Perform matrix-vector multiplication, out = this * in;
       * \par Example
@@ -1028,6 +1652,97 @@ namespace rocalution
                               ValueType                     scalar,
                               LocalVector<ValueType>*       out) const;
 
+        /** \brief Perform transposed matrix-vector multiplication, out = this^T * in;
+      * \details
+      * The transposed matrix is not formed explicitly. This allows e.g. to apply the
+      * restriction \f$R = P^{T}\f$ of a multigrid hierarchy without storing \f$R\f$.
+      */
+        ROCALUTION_EXPORT
+        void ApplyTranspose(const LocalVector<ValueType>& in, LocalVector<ValueType>* out) const;
+        /** \brief Perform transposed matrix-vector multiplication, out = scalar * this^T * in
+      * + out;
+      */
+        ROCALUTION_EXPORT
+        void ApplyTransposeAdd(const LocalVector<ValueType>& in,
+                               ValueType                     scalar,
+                               LocalVector<ValueType>*       out) const;
+
+        /** \brief Perform matrix-vector multiplication for a subset of rows,
+      * out[i] = (this * in)[i] for all i in \p rows;
+      * \details
+      * Only the rows listed in \p rows are computed, all other entries of \p out are
+      * left untouched. This avoids extracting a sub-matrix for row sets that change
+      * frequently, e.g. in Schwarz methods or active set strategies. \p rows must not
+      * contain duplicates.
+      *
+      * \par Example
+      * \code{.cpp}
+      * // Rows that are currently active
+      * LocalVector<int> active;
+      * active.Allocate("active rows", nactive);
+      *
+      * // Fill active row indices
+      *
+      * A.ApplyRows(x, active, &y);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void ApplyRows(const LocalVector<ValueType>& in,
+                       const LocalVector<int>&       rows,
+                       LocalVector<ValueType>*       out) const;
+        /** \brief Perform matrix-vector multiplication for a subset of rows,
+      * out[i] = out[i] + scalar * (this * in)[i] for all i in \p rows;
+      */
+        ROCALUTION_EXPORT
+        void ApplyAddRows(const LocalVector<ValueType>& in,
+                          const LocalVector<int>&       rows,
+                          ValueType                     scalar,
+                          LocalVector<ValueType>*       out) const;
+        /** \brief Compute the residual for a subset of rows,
+      * res[i] = (rhs - this * x)[i] for all i in \p rows;
+      * \details
+      * Product and subtraction are fused, such that \f$Ax\f$ is never stored. All
+      * other entries of \p res are left untouched.
+      */
+        ROCALUTION_EXPORT
+        void ResidualRows(const LocalVector<ValueType>& rhs,
+                          const LocalVector<ValueType>& x,
+                          const LocalVector<int>&       rows,
+                          LocalVector<ValueType>*       res) const;
+
+        /** \brief Perform matrix-multi-vector multiplication, out = this * in;
+      * \details
+      * All columns of \p in are multiplied by the matrix at once, such that the matrix
+      * is read only once for the whole block. Matrices that are not in CSR format are
+      * applied column by column.
+      *
+      * \par Example
+      * \code{.cpp}
+      * // rocALUTION structures
+      * LocalMatrix<T>      A;
+      * LocalMultiVector<T> X;
+      * LocalMultiVector<T> Y;
+      *
+      * // Allocate matrix and 16 right-hand sides
+      * A.AllocateCSR("my CSR matrix", 456, 100, 100);
+      * X.Allocate("X", A.GetN(), 16);
+      * Y.Allocate("Y", A.GetM(), 16);
+      *
+      * // Fill data in A matrix and X block
+      *
+      * A.Apply(X, &Y);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        virtual void Apply(const LocalMultiVector<ValueType>& in,
+                           LocalMultiVector<ValueType>*       out) const;
+
+        /** \brief Perform matrix-multi-vector multiplication, out += scalar * this * in; */
+        ROCALUTION_EXPORT
+        virtual void ApplyAdd(const LocalMultiVector<ValueType>& in,
+                              ValueType                          scalar,
+                              LocalMultiVector<ValueType>*       out) const;
+
         /** \brief Perform symbolic computation (structure only) of \f$|this|^p\f$ */
         ROCALUTION_EXPORT
         void SymbolicPower(int p);
@@ -1042,10 +1757,67 @@ namespace rocalution
                        ValueType                     beta      = static_cast<ValueType>(1),
                        bool                          structure = false);
 
+        /** \brief Perform matrix addition, this = alpha * A + beta * B;
+      * \details
+      * The sparsity pattern of this is the union of the patterns of \p A and \p B. All
+      * matrices have to be in CSR format.
+      */
+        ROCALUTION_EXPORT
+        void MatrixAdd(const LocalMatrix<ValueType>& A,
+                       ValueType                     alpha,
+                       const LocalMatrix<ValueType>& B,
+                       ValueType                     beta);
+
+        /** \brief Recompute the values of this = alpha * A + beta * B for a known sparsity
+      * pattern
+      * \details
+      * \p MatrixAddNumeric only computes the values of the sum of two matrices, whereas
+      * the sparsity pattern of this matrix is reused. It has to be the result of a
+      * previous MatrixAdd() of two matrices with the same sparsity patterns as \p A and
+      * \p B. This avoids the symbolic phase and the allocation of the sum, e.g. when
+      * forming shifted operators in each time step. All matrices have to be in CSR
+      * format.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   C.MatrixAdd(A, 1.0, M, sigma);
+      *
+      *   // Next time step, only sigma has changed
+      *   C.MatrixAddNumeric(A, 1.0, M, sigma);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void MatrixAddNumeric(const LocalMatrix<ValueType>& A,
+                              ValueType                     alpha,
+                              const LocalMatrix<ValueType>& B,
+                              ValueType                     beta);
+
         /** \brief Multiply two matrices, this = A * B */
         ROCALUTION_EXPORT
         void MatrixMult(const LocalMatrix<ValueType>& A, const LocalMatrix<ValueType>& B);
 
+        /** \brief Recompute the values of this = A * B for a known sparsity pattern
+      * \details
+      * \p MatrixMultNumeric only computes the values of the product of two matrices,
+      * whereas the sparsity pattern of this matrix is reused. It has to be the result of a
+      * previous MatrixMult() of two matrices with the same sparsity patterns as \p A and
+      * \p B. This avoids the symbolic phase of the sparse matrix-matrix product, e.g.
+      * if only the values of \p A and \p B have changed. All matrices have to be in
+      * CSR format.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   C.MatrixMult(A, B);
+      *
+      *   // Update values of A
+      *   A.UpdateValuesCSR(val);
+      *
+      *   C.MatrixMultNumeric(A, B);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void MatrixMultNumeric(const LocalMatrix<ValueType>& A, const LocalMatrix<ValueType>& B);
+
         /** \brief Multiply the matrix with diagonal matrix (stored in LocalVector), as
       * DiagonalMatrixMultR()
       */
@@ -1069,6 +1841,42 @@ namespace rocalution
                                  const LocalMatrix<ValueType>& A,
                                  const LocalMatrix<ValueType>& P);
 
+        /** \brief Recompute the values of C=RAP for a known sparsity pattern
+      * \details
+      * \p TripleMatrixProductNumeric only computes the values of the triple matrix
+      * product, whereas the sparsity pattern of this matrix is reused. It has to be the
+      * result of a previous TripleMatrixProduct() of three matrices with the same
+      * sparsity patterns as \p R, \p A and \p P. All matrices have to be in CSR format.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   Ac.TripleMatrixProduct(R, A, P);
+      *
+      *   // Update values of A
+      *   A.UpdateValuesCSR(val);
+      *
+      *   Ac.TripleMatrixProductNumeric(R, A, P);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void TripleMatrixProductNumeric(const LocalMatrix<ValueType>& R,
+                                        const LocalMatrix<ValueType>& A,
+                                        const LocalMatrix<ValueType>& P);
+
+        /** \brief Recompute the values of the flagged rows of C=RAP for a known sparsity
+      * pattern
+      * \details
+      * Same as TripleMatrixProductNumeric(), but only the rows \f$i\f$ with
+      * \p rows[i] set are recomputed, all other rows keep their values. If only a few
+      * rows of \p A have changed, the affected rows of C can be determined with
+      * \p R.ExtractConnectedRows(), see ExtractConnectedRows().
+      */
+        ROCALUTION_EXPORT
+        void TripleMatrixProductNumeric(const LocalMatrix<ValueType>& R,
+                                        const LocalMatrix<ValueType>& A,
+                                        const LocalMatrix<ValueType>& P,
+                                        const LocalVector<bool>&      rows);
+
         /** \brief Compute the spectrum approximation with Gershgorin circles theorem */
         ROCALUTION_EXPORT
         void Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const;
@@ -1079,6 +1887,16 @@ namespace rocalution
         ROCALUTION_EXPORT
         void Compress(double drop_off);
 
+        /** \brief Delete all off-diagonal entries in the matrix which
+      * abs(a_ij) <= drop_off * sqrt(abs(a_ii * a_jj)) and add them to the diagonal
+      * \details
+      * The dropped entries are lumped onto the diagonal, such that the row sums of the
+      * matrix are preserved. For a symmetric matrix, the result is symmetric as well. The
+      * matrix has to be square.
+      */
+        ROCALUTION_EXPORT
+        void CompressLumped(double drop_off);
+
         /** \brief Transpose the matrix */
         ROCALUTION_EXPORT
         virtual void Transpose(void);
@@ -1112,6 +1930,20 @@ namespace rocalution
         ROCALUTION_EXPORT
         void Key(long int& row_key, long int& col_key, long int& val_key) const;
 
+        /** \brief Compute a hash of the matrix sizes, sparsity pattern and values
+      * \details
+      * In contrast to \p Key(), the hash is computed in parallel on the backend the
+      * matrix currently lives on and only a single value is transferred to the host.
+      * It is independent of the backend, such that host and accelerator copies of
+      * the same matrix result in the same hash. It is intended as a cheap change
+      * detection, e.g. to skip redundant setup phases of a preconditioner when the
+      * operator did not change.
+      *
+      * \return 64 bit hash of the matrix.
+      */
+        ROCALUTION_EXPORT
+        uint64_t Hash(void) const;
+
         /** \brief Replace a column vector of a matrix */
         ROCALUTION_EXPORT
         void ReplaceColumnVector(int idx, const LocalVector<ValueType>& vec);
@@ -1194,6 +2026,33 @@ namespace rocalution
                               LocalVector<int64_t>* aggregates,
                               LocalVector<int64_t>* aggregate_root_nodes) const;
 
+        /** \brief Node graph for block-aware aggregation
+      * \details
+      * Collapses each \p blockdim x \p blockdim block of the matrix into a single
+      * entry of \p node, holding the Frobenius norm of the block. The node graph can
+      * be aggregated like a scalar matrix and the result expanded with
+      * AMGNodeExpand().
+      */
+        ROCALUTION_EXPORT
+        void AMGNodeGraph(int blockdim, LocalMatrix<ValueType>* node) const;
+
+        /** \brief Expand the aggregation of a node graph to the dofs of its blocks
+      * \details
+      * A coupling between two dofs is strong, if the coupling between their nodes is
+      * strong. Component \p r of a node in aggregate \p k is placed into coarse dof
+      * \p k * \p blockdim + \p r, such that the coarse operators keep the block
+      * structure.
+      */
+        ROCALUTION_EXPORT
+        void AMGNodeExpand(int                           blockdim,
+                           const LocalMatrix<ValueType>& node,
+                           const LocalVector<bool>&      node_connections,
+                           const LocalVector<int64_t>&   node_aggregates,
+                           const LocalVector<int64_t>&   node_aggregate_root_nodes,
+                           LocalVector<bool>*            connections,
+                           LocalVector<int64_t>*         aggregates,
+                           LocalVector<int64_t>*         aggregate_root_nodes) const;
+
         /** \brief Interpolation scheme based on smoothed aggregation from Vanek (1996) */
         ROCALUTION_EXPORT
         void AMGSmoothedAggregation(ValueType                   relax,
@@ -1202,6 +2061,43 @@ namespace rocalution
                                     const LocalVector<int64_t>& aggregate_root_nodes,
                                     LocalMatrix<ValueType>*     prolong,
                                     int                         lumping_strat = 0) const;
+        /** \brief Smoothed aggregation interpolation with a near null space
+      * \details
+      * Instead of a single constant vector per aggregate, the \p num_null vectors of
+      * \p null_space (stored one after another) are restricted to each aggregate and
+      * orthonormalized. The resulting tentative prolongation is smoothed like in the
+      * scalar case, and \p coarse_null_space holds the representation of the near null
+      * space on the coarse level, to be passed on to the next level.
+      */
+        ROCALUTION_EXPORT
+        void AMGSmoothedAggregation(ValueType                     relax,
+                                    const LocalVector<bool>&      connections,
+                                    const LocalVector<int64_t>&   aggregates,
+                                    const LocalVector<int64_t>&   aggregate_root_nodes,
+                                    int                           num_null,
+                                    const LocalVector<ValueType>& null_space,
+                                    LocalMatrix<ValueType>*       prolong,
+                                    LocalVector<ValueType>*       coarse_null_space,
+                                    int                           lumping_strat = 0) const;
+        /** \brief Truncate an interpolation operator
+      * \details
+      * Drops all entries of a row that are smaller than \p trunc_factor times the
+      * largest entry of the row in magnitude and keeps at most the \p max_row_nnz
+      * largest entries (0 for no limit). The remaining entries are scaled such that the
+      * row sums do not change.
+      */
+        ROCALUTION_EXPORT
+        void AMGProlongTruncate(double trunc_factor, int max_row_nnz = 0);
+        /** \brief Energy minimization of an interpolation operator
+      * \details
+      * Performs \p iterations Jacobi preconditioned steepest descent steps with step
+      * size \p relax on the energy of the columns of \p prolong with respect to this
+      * operator. The sparsity pattern and the row sums of \p prolong do not change.
+      */
+        ROCALUTION_EXPORT
+        void AMGEnergyMinimization(ValueType               relax,
+                                   int                     iterations,
+                                   LocalMatrix<ValueType>* prolong) const;
         /** \brief Aggregation-based interpolation scheme */
         ROCALUTION_EXPORT
         void AMGUnsmoothedAggregation(const LocalVector<int64_t>& aggregates,
@@ -1332,6 +2228,24 @@ namespace rocalution
         virtual bool is_accel_(void) const;
 
     private:
+        // Clone src, sharing its sparsity pattern if requested and supported
+        void CloneFrom_(const LocalMatrix<ValueType>& src, bool share_structure);
+
+        // Return true if a conversion on the accelerator exceeds the free device memory,
+        // while the converted matrix alone fits
+        bool ConvertOnHost_(unsigned int matrix_format, int blockdim) const;
+
+        // Compute out = out + scalar * this * in for a matrix in symmetric storage
+        void ApplyAddSymmetric_(const LocalVector<ValueType>& in,
+                                ValueType                     scalar,
+                                LocalVector<ValueType>*       out) const;
+
+        // Update the values in place from val, starting at offset (see
+        // BaseMatrix::UpdateValues())
+        void UpdateValues_(const LocalVector<ValueType>& val,
+                           const LocalVector<int>*       perm,
+                           int64_t                       offset);
+
         // Pointer from the base matrix class to the current
         // allocated matrix (host_ or accel_)
         BaseMatrix<ValueType>* matrix_;
@@ -1342,9 +2256,22 @@ namespace rocalution
         // Accelerator Matrix
         AcceleratorMatrix<ValueType>* matrix_accel_;
 
+        // Matrix-vector product algorithm, handed to the backend matrix on each product
+        SpMVAlg spmv_alg_;
+        // Matrix-vector product value storage, handed to the backend matrix on each product
+        SpMVStorage spmv_storage_;
+        // Matrix-vector product column index storage, handed to the backend matrix on each
+        // product
+        SpMVIndex spmv_index_;
+        // Entries per chunk of the out-of-core product, 0 if the matrix is device resident
+        int64_t ooc_chunk_nnz_;
+        // Only the upper triangle and the diagonal of a symmetric matrix are stored
+        bool symmetric_storage_;
+
         friend class LocalVector<ValueType>;
         friend class GlobalVector<ValueType>;
         friend class GlobalMatrix<ValueType>;
+        friend class LocalBatchMatrix<ValueType>;
     };
 
 } // namespace rocalution
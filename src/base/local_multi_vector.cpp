@@ -0,0 +1,534 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "local_multi_vector.hpp"
+#include "../utils/allocate_free.hpp"
+#include "../utils/def.hpp"
+#include "../utils/log.hpp"
+#include "../utils/math_functions.hpp"
+#include "backend_manager.hpp"
+#include "base_vector.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    LocalMultiVector<ValueType>::LocalMultiVector()
+    {
+        log_debug(this, "LocalMultiVector::LocalMultiVector()");
+
+        this->object_name_ = "";
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+    }
+
+    template <typename ValueType>
+    LocalMultiVector<ValueType>::~LocalMultiVector()
+    {
+        log_debug(this, "LocalMultiVector::~LocalMultiVector()");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    int64_t LocalMultiVector<ValueType>::GetNrow(void) const
+    {
+        return this->nrow_;
+    }
+
+    template <typename ValueType>
+    int LocalMultiVector<ValueType>::GetNcol(void) const
+    {
+        return this->ncol_;
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::Allocate(std::string name, int64_t nrow, int ncol)
+    {
+        log_debug(this, "LocalMultiVector::Allocate()", name, nrow, ncol);
+
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+
+        this->Clear();
+
+        this->object_name_ = name;
+
+        this->data_.Allocate(name, nrow * ncol);
+
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::SetDataPtr(ValueType** ptr,
+                                                 std::string name,
+                                                 int64_t     nrow,
+                                                 int         ncol)
+    {
+        log_debug(this, "LocalMultiVector::SetDataPtr()", ptr, name, nrow, ncol);
+
+        assert(ptr != NULL);
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+
+        this->Clear();
+
+        this->object_name_ = name;
+
+        this->data_.SetDataPtr(ptr, name, nrow * ncol);
+
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::LeaveDataPtr(ValueType** ptr)
+    {
+        log_debug(this, "LocalMultiVector::LeaveDataPtr()", ptr);
+
+        this->data_.LeaveDataPtr(ptr);
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::Clear(void)
+    {
+        log_debug(this, "LocalMultiVector::Clear()");
+
+        this->data_.Clear();
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+    }
+
+    template <typename ValueType>
+    bool LocalMultiVector<ValueType>::Check(void) const
+    {
+        log_debug(this, "LocalMultiVector::Check()");
+
+        return this->data_.Check();
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::Zeros(void)
+    {
+        log_debug(this, "LocalMultiVector::Zeros()");
+
+        this->data_.Zeros();
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::Ones(void)
+    {
+        log_debug(this, "LocalMultiVector::Ones()");
+
+        this->data_.Ones();
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::SetValues(ValueType val)
+    {
+        log_debug(this, "LocalMultiVector::SetValues()", val);
+
+        this->data_.SetValues(val);
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::SetRandomUniform(unsigned long long seed,
+                                                       ValueType          a,
+                                                       ValueType          b)
+    {
+        log_debug(this, "LocalMultiVector::SetRandomUniform()", seed, a, b);
+
+        this->data_.SetRandomUniform(seed, a, b);
+    }
+
+    template <typename ValueType>
+    ValueType& LocalMultiVector<ValueType>::operator()(int64_t i, int j)
+    {
+        assert((i >= 0) && (i < this->nrow_));
+        assert((j >= 0) && (j < this->ncol_));
+
+        return this->data_[j * this->nrow_ + i];
+    }
+
+    template <typename ValueType>
+    const ValueType& LocalMultiVector<ValueType>::operator()(int64_t i, int j) const
+    {
+        assert((i >= 0) && (i < this->nrow_));
+        assert((j >= 0) && (j < this->ncol_));
+
+        return this->data_[j * this->nrow_ + i];
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::CopyFrom(const LocalMultiVector<ValueType>& src)
+    {
+        log_debug(this, "LocalMultiVector::CopyFrom()", (const void*&)src);
+
+        assert(this != &src);
+
+        if((this->nrow_ != src.nrow_) || (this->ncol_ != src.ncol_))
+        {
+            this->Allocate(src.object_name_, src.nrow_, src.ncol_);
+        }
+
+        this->data_.CopyFrom(src.data_);
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::AddScale(const LocalMultiVector<ValueType>& x,
+                                               ValueType                          alpha)
+    {
+        log_debug(this, "LocalMultiVector::AddScale()", (const void*&)x, alpha);
+
+        assert(this->nrow_ == x.nrow_);
+        assert(this->ncol_ == x.ncol_);
+
+        this->data_.AddScale(x.data_, alpha);
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::ScaleAdd(ValueType                          alpha,
+                                               const LocalMultiVector<ValueType>& x)
+    {
+        log_debug(this, "LocalMultiVector::ScaleAdd()", alpha, (const void*&)x);
+
+        assert(this->nrow_ == x.nrow_);
+        assert(this->ncol_ == x.ncol_);
+
+        this->data_.ScaleAdd(alpha, x.data_);
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::Scale(ValueType alpha)
+    {
+        log_debug(this, "LocalMultiVector::Scale()", alpha);
+
+        this->data_.Scale(alpha);
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::PointWiseMult(const LocalVector<ValueType>& x)
+    {
+        log_debug(this, "LocalMultiVector::PointWiseMult()", (const void*&)x);
+
+        assert(this->nrow_ == x.GetSize());
+
+        assert(((this->is_host_() == true) && (x.is_host_() == true))
+               || ((this->is_accel_() == true) && (x.is_accel_() == true)));
+
+        if(this->nrow_ > 0 && this->ncol_ > 0)
+        {
+            this->data_.vector_->BlockPointWiseMult(this->nrow_, this->ncol_, *x.vector_);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::Dot(const LocalMultiVector<ValueType>& x,
+                                          ValueType*                         res) const
+    {
+        log_debug(this, "LocalMultiVector::Dot()", (const void*&)x, res);
+
+        assert(res != NULL);
+        assert(this->nrow_ == x.nrow_);
+
+        assert(((this->is_host_() == true) && (x.is_host_() == true))
+               || ((this->is_accel_() == true) && (x.is_accel_() == true)));
+
+        this->data_.vector_->BlockDot(this->nrow_, x.ncol_, this->ncol_, *x.data_.vector_, res);
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::ScaleAddProduct(ValueType                          alpha,
+                                                      const LocalMultiVector<ValueType>& x,
+                                                      const ValueType*                   C,
+                                                      ValueType                          beta)
+    {
+        log_debug(this, "LocalMultiVector::ScaleAddProduct()", alpha, (const void*&)x, C, beta);
+
+        assert(C != NULL);
+        assert(this->nrow_ == x.nrow_);
+
+        assert(((this->is_host_() == true) && (x.is_host_() == true))
+               || ((this->is_accel_() == true) && (x.is_accel_() == true)));
+
+        this->data_.vector_->BlockScaleAddProduct(
+            this->nrow_, x.ncol_, this->ncol_, alpha, *x.data_.vector_, C, beta);
+    }
+
+    template <typename ValueType>
+    int LocalMultiVector<ValueType>::Orthonormalize(ValueType* S)
+    {
+        log_debug(this, "LocalMultiVector::Orthonormalize()", S);
+
+        int s = this->ncol_;
+
+        if(s == 0)
+        {
+            return 0;
+        }
+
+        ValueType* gram = NULL;
+        ValueType* C    = NULL;
+        ValueType* S1   = NULL;
+        int*       perm = NULL;
+
+        allocate_host(s * s, &gram);
+        allocate_host(s * s, &C);
+        allocate_host(s * s, &S1);
+        allocate_host(s, &perm);
+
+        // Inverse of the leading r x r block of an upper triangular s x s matrix R,
+        // scattered into the columns 0, ..., r - 1 of C
+        auto invert_upper = [s](int r, const ValueType* R, const int* row, ValueType* C) {
+            set_to_zero_host(s * s, C);
+
+            for(int j = 0; j < r; ++j)
+            {
+                // Column j of R^-1, row k is stored in row row[k] of C
+                C[row[j] + j * s] = static_cast<ValueType>(1) / R[j + j * s];
+
+                for(int i = j - 1; i >= 0; --i)
+                {
+                    ValueType sum = static_cast<ValueType>(0);
+
+                    for(int k = i + 1; k <= j; ++k)
+                    {
+                        sum += R[i + k * s] * C[row[k] + j * s];
+                    }
+
+                    C[row[i] + j * s] = -sum / R[i + i * s];
+                }
+            }
+        };
+
+        // First pass, rank revealing
+        this->Dot(*this, gram);
+
+        double tol  = 100.0 * std::abs(rocalution_eps<ValueType>());
+        int    rank = rocalution_cholesky_pivoted(s, gram, perm, tol);
+
+        // this = this(:, perm) R^-1, with zero columns for the deflated directions
+        invert_upper(rank, gram, perm, C);
+        this->ScaleAddProduct(static_cast<ValueType>(0), *this, C, static_cast<ValueType>(1));
+
+        // Coefficients of the first pass, S1(:, perm) = R
+        set_to_zero_host(s * s, S1);
+
+        for(int j = 0; j < s; ++j)
+        {
+            for(int i = 0; i < rank; ++i)
+            {
+                S1[i + perm[j] * s] = gram[i + j * s];
+            }
+        }
+
+        // Second pass restores the orthogonality lost in the first pass
+        if(rank > 0)
+        {
+            this->Dot(*this, gram);
+
+            // Restrict to the leading rank x rank block
+            for(int j = 0; j < rank; ++j)
+            {
+                for(int i = 0; i < rank; ++i)
+                {
+                    gram[i + j * rank] = gram[i + j * s];
+                }
+            }
+
+            if(rocalution_cholesky(rank, gram) == true)
+            {
+                for(int j = rank - 1; j >= 0; --j)
+                {
+                    for(int i = rank - 1; i >= 0; --i)
+                    {
+                        gram[i + j * s] = (i <= j) ? gram[i + j * rank] : static_cast<ValueType>(0);
+                    }
+                }
+
+                for(int i = 0; i < s; ++i)
+                {
+                    perm[i] = i;
+                }
+
+                invert_upper(rank, gram, perm, C);
+                this->ScaleAddProduct(
+                    static_cast<ValueType>(0), *this, C, static_cast<ValueType>(1));
+
+                // S1 = R2 S1
+                for(int j = 0; j < s; ++j)
+                {
+                    for(int i = 0; i < rank; ++i)
+                    {
+                        ValueType sum = static_cast<ValueType>(0);
+
+                        for(int k = i; k < rank; ++k)
+                        {
+                            sum += gram[i + k * s] * S1[k + j * s];
+                        }
+
+                        C[i + j * s] = sum;
+                    }
+                }
+
+                for(int j = 0; j < s; ++j)
+                {
+                    for(int i = 0; i < rank; ++i)
+                    {
+                        S1[i + j * s] = C[i + j * s];
+                    }
+                }
+            }
+        }
+
+        if(S != NULL)
+        {
+            copy_h2h(s * s, S1, S);
+        }
+
+        free_host(&gram);
+        free_host(&C);
+        free_host(&S1);
+        free_host(&perm);
+
+        return rank;
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::GetColumn(int j, LocalVector<ValueType>* vec) const
+    {
+        log_debug(this, "LocalMultiVector::GetColumn()", j, vec);
+
+        assert(vec != NULL);
+        assert((j >= 0) && (j < this->ncol_));
+
+        if(vec->GetSize() == 0)
+        {
+            vec->Allocate("column of " + this->object_name_, this->nrow_);
+        }
+
+        assert(vec->GetSize() == this->nrow_);
+
+        if(this->nrow_ > 0)
+        {
+            vec->CopyFrom(this->data_, j * this->nrow_, 0, this->nrow_);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::SetColumn(int j, const LocalVector<ValueType>& vec)
+    {
+        log_debug(this, "LocalMultiVector::SetColumn()", j, (const void*&)vec);
+
+        assert((j >= 0) && (j < this->ncol_));
+        assert(vec.GetSize() == this->nrow_);
+
+        if(this->nrow_ > 0)
+        {
+            this->data_.CopyFrom(vec, 0, j * this->nrow_, this->nrow_);
+        }
+    }
+
+    template <typename ValueType>
+    bool LocalMultiVector<ValueType>::is_host_(void) const
+    {
+        return this->data_.is_host_();
+    }
+
+    template <typename ValueType>
+    bool LocalMultiVector<ValueType>::is_accel_(void) const
+    {
+        return this->data_.is_accel_();
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::MoveToAccelerator(void)
+    {
+        log_debug(this, "LocalMultiVector::MoveToAccelerator()");
+
+        this->data_.MoveToAccelerator();
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::MoveToHost(void)
+    {
+        log_debug(this, "LocalMultiVector::MoveToHost()");
+
+        this->data_.MoveToHost();
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::CloneBackend(const BaseRocalution<ValueType>& src)
+    {
+        log_debug(this, "LocalMultiVector::CloneBackend()", (const void*&)src);
+
+        assert(this != &src);
+
+        // The column storage carries the actual backend
+        this->data_.CloneBackend(src);
+
+        BaseRocalution<ValueType>::CloneBackend(src);
+    }
+
+    template <typename ValueType>
+    void LocalMultiVector<ValueType>::Info(void) const
+    {
+        std::string current_backend_name;
+
+        if(this->is_host_() == true)
+        {
+            current_backend_name = _rocalution_host_name[0];
+        }
+        else
+        {
+            assert(this->is_accel_() == true);
+            current_backend_name = _rocalution_backend_name[this->local_backend_.backend];
+        }
+
+        LOG_INFO("LocalMultiVector"
+                 << " name=" << this->object_name_ << ";"
+                 << " rows=" << this->nrow_ << ";"
+                 << " cols=" << this->ncol_ << ";"
+                 << " prec=" << 8 * sizeof(ValueType) << "bit;"
+                 << " host backend={" << _rocalution_host_name[0] << "};"
+                 << " accelerator backend={"
+                 << _rocalution_backend_name[this->local_backend_.backend] << "};"
+                 << " current=" << current_backend_name);
+    }
+
+    template class LocalMultiVector<double>;
+    template class LocalMultiVector<float>;
+#ifdef SUPPORT_COMPLEX
+    template class LocalMultiVector<std::complex<double>>;
+    template class LocalMultiVector<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,254 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_LOCAL_MULTI_VECTOR_HPP_
+#define ROCALUTION_LOCAL_MULTI_VECTOR_HPP_
+
+#include "base_rocalution.hpp"
+#include "local_vector.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    class LocalMatrix;
+    template <typename ValueType>
+    class LocalBatchMatrix;
+
+    /** \ingroup op_vec_module
+  * \class LocalMultiVector
+  * \brief LocalMultiVector class
+  * \details
+  * A LocalMultiVector is a dense block of \p ncol vectors of length \p nrow, that
+  * stays on a single system, like a LocalVector. The block is stored in column-major
+  * order with leading dimension \p nrow, i.e. each column is contiguous in memory and
+  * can be exchanged with a LocalVector. Applying a LocalMatrix to a LocalMultiVector
+  * reads the matrix only once for all columns (sparse matrix times dense matrix
+  * product).
+  *
+  * \tparam ValueType - can be float, double, std::complex<float> and
+  *                     std::complex<double>
+  */
+    template <typename ValueType>
+    class LocalMultiVector : public BaseRocalution<ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        LocalMultiVector();
+        ROCALUTION_EXPORT
+        virtual ~LocalMultiVector();
+
+        /** \brief Move all data (i.e. move the multi-vector) to the accelerator */
+        ROCALUTION_EXPORT
+        virtual void MoveToAccelerator(void);
+        /** \brief Move all data (i.e. move the multi-vector) to the host */
+        ROCALUTION_EXPORT
+        virtual void MoveToHost(void);
+        /** \brief Clone the backend descriptor from another object */
+        ROCALUTION_EXPORT
+        virtual void CloneBackend(const BaseRocalution<ValueType>& src);
+
+        /** \brief Shows simple info about the multi-vector. */
+        ROCALUTION_EXPORT
+        virtual void Info(void) const;
+        /** \brief Return the number of rows, i.e. the length of each vector. */
+        ROCALUTION_EXPORT
+        int64_t GetNrow(void) const;
+        /** \brief Return the number of columns, i.e. the number of vectors. */
+        ROCALUTION_EXPORT
+        int GetNcol(void) const;
+
+        /** \brief Perform a sanity check of the multi-vector
+        * \details
+        * Checks, if the multi-vector contains valid data, i.e. if the values are not
+        * infinity and not NaN (not a number).
+        *
+        * \retval true if the multi-vector is ok (empty multi-vector is also ok).
+        * \retval false if there is something wrong with the values.
+        */
+        ROCALUTION_EXPORT
+        bool Check(void) const;
+
+        /** \brief Allocate a local multi-vector with name and sizes
+      * \details
+      * The local multi-vector allocation function requires a name of the object (this
+      * is only for information purposes), the length of the vectors and the number of
+      * vectors.
+      *
+      * @param[in]
+      * name    object name
+      * @param[in]
+      * nrow    number of elements in each vector
+      * @param[in]
+      * ncol    number of vectors
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalMultiVector<ValueType> X;
+      *
+      *   X.Allocate("my block", 100, 8);
+      *   X.Clear();
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void Allocate(std::string name, int64_t nrow, int ncol);
+
+        /** \brief Initialize a LocalMultiVector on the host with externally allocated data
+      * \details
+      * \p SetDataPtr has direct access to the raw data via pointers. The data has to be
+      * stored in column-major order with leading dimension \p nrow.
+      *
+      * \note
+      * Setting data pointer will leave the original pointer empty (set to \p NULL).
+      */
+        ROCALUTION_EXPORT
+        void SetDataPtr(ValueType** ptr, std::string name, int64_t nrow, int ncol);
+
+        /** \brief Leave a LocalMultiVector to host pointers
+      * \details
+      * \p LeaveDataPtr has direct access to the raw data via pointers. A LocalMultiVector
+      * object can leave its raw (column-major) data to a host pointer. This will leave
+      * the LocalMultiVector empty.
+      */
+        ROCALUTION_EXPORT
+        void LeaveDataPtr(ValueType** ptr);
+
+        /** \brief Clear (free) the multi-vector */
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+        /** \brief Set the values of the multi-vector to zero */
+        ROCALUTION_EXPORT
+        void Zeros(void);
+        /** \brief Set the values of the multi-vector to one */
+        ROCALUTION_EXPORT
+        void Ones(void);
+        /** \brief Set the values of the multi-vector to given argument */
+        ROCALUTION_EXPORT
+        void SetValues(ValueType val);
+        /** \brief Set the values of the multi-vector to random uniformly distributed values (between -1 and 1) */
+        ROCALUTION_EXPORT
+        void SetRandomUniform(unsigned long long seed,
+                              ValueType          a = static_cast<ValueType>(-1),
+                              ValueType          b = static_cast<ValueType>(1));
+
+        /** \brief Access operator (only for host data)
+      * \details
+      * The element in row \p i of column \p j can be accessed via the () operator, when
+      * the multi-vector is allocated on the host.
+      */
+        /**@{*/
+        ROCALUTION_EXPORT
+        ValueType& operator()(int64_t i, int j);
+        ROCALUTION_EXPORT
+        const ValueType& operator()(int64_t i, int j) const;
+        /**@}*/
+
+        /** \brief Clone the entire multi-vector (values, sizes and backend descr) from
+        * another LocalMultiVector
+        */
+        ROCALUTION_EXPORT
+        void CopyFrom(const LocalMultiVector<ValueType>& src);
+
+        /** \brief Perform this = this + alpha * x */
+        ROCALUTION_EXPORT
+        void AddScale(const LocalMultiVector<ValueType>& x, ValueType alpha);
+        /** \brief Perform this = alpha * this + x */
+        ROCALUTION_EXPORT
+        void ScaleAdd(ValueType alpha, const LocalMultiVector<ValueType>& x);
+        /** \brief Perform this = alpha * this */
+        ROCALUTION_EXPORT
+        void Scale(ValueType alpha);
+        /** \brief Scale the rows of the block, this_ij = x_i * this_ij
+      * \details
+      * All columns are scaled in a single pass, e.g. to apply a diagonal (Jacobi)
+      * preconditioner to all vectors of the block at once.
+      */
+        ROCALUTION_EXPORT
+        void PointWiseMult(const LocalVector<ValueType>& x);
+
+        /** \brief Compute the block inner product res = x^H this
+      * \details
+      * \p res is a column-major host array of size x.GetNcol() x this->GetNcol(), i.e.
+      * res[k + j * x.GetNcol()] is the dot product of column \p k of \p x with column
+      * \p j of this multi-vector. All inner products are computed in a single pass.
+      */
+        ROCALUTION_EXPORT
+        void Dot(const LocalMultiVector<ValueType>& x, ValueType* res) const;
+
+        /** \brief Perform this = alpha * this + beta * x * C
+      * \details
+      * \p C is a column-major host array of size x.GetNcol() x this->GetNcol(). \p x can
+      * be this multi-vector itself, e.g. to right-multiply a block in place.
+      */
+        ROCALUTION_EXPORT
+        void ScaleAddProduct(ValueType                          alpha,
+                             const LocalMultiVector<ValueType>& x,
+                             const ValueType*                   C,
+                             ValueType                          beta);
+
+        /** \brief Orthonormalize the columns in place by Cholesky QR
+      * \details
+      * The columns are orthonormalized with two passes of (pivoted) Cholesky QR.
+      * Directions that are numerically linearly dependent are deflated. The numerical
+      * rank r is returned, the first r columns then hold an orthonormal basis and the
+      * remaining columns are set to zero. If \p S is not \p NULL, it receives the
+      * column-major GetNcol() x GetNcol() host matrix of coefficients, such that the
+      * original multi-vector equals the orthonormalized one times \p S (up to the
+      * deflated directions).
+      */
+        ROCALUTION_EXPORT
+        int Orthonormalize(ValueType* S = NULL);
+
+        /** \brief Copy column \p j into a LocalVector
+      * \details
+      * \p vec is allocated to the length of the column, if it is empty. Both objects
+      * have to reside on the same backend.
+      */
+        ROCALUTION_EXPORT
+        void GetColumn(int j, LocalVector<ValueType>* vec) const;
+        /** \brief Copy a LocalVector into column \p j */
+        ROCALUTION_EXPORT
+        void SetColumn(int j, const LocalVector<ValueType>& vec);
+
+    protected:
+        /** \brief Return true if the object is on the host */
+        virtual bool is_host_(void) const;
+        /** \brief Return true if the object is on the accelerator */
+        virtual bool is_accel_(void) const;
+
+    private:
+        // Column-major storage of all vectors
+        LocalVector<ValueType> data_;
+
+        // Number of rows and columns
+        int64_t nrow_;
+        int     ncol_;
+
+        friend class LocalMatrix<ValueType>;
+        friend class LocalBatchMatrix<ValueType>;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_LOCAL_MULTI_VECTOR_HPP_
@@ -0,0 +1,246 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "local_shell_operator.hpp"
+#include "../utils/def.hpp"
+#include "../utils/log.hpp"
+#include "backend_manager.hpp"
+#include "base_vector.hpp"
+#include "local_vector.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    LocalShellOperator<ValueType>::LocalShellOperator()
+    {
+        log_debug(this, "LocalShellOperator::LocalShellOperator()");
+
+        this->object_name_ = "";
+
+        this->nrow_  = 0;
+        this->ncol_  = 0;
+        this->accel_ = false;
+    }
+
+    template <typename ValueType>
+    LocalShellOperator<ValueType>::~LocalShellOperator()
+    {
+        log_debug(this, "LocalShellOperator::~LocalShellOperator()");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    void LocalShellOperator<ValueType>::Info(void) const
+    {
+        std::string current_backend_name = this->accel_
+                                               ? _rocalution_backend_name[this->local_backend_.backend]
+                                               : _rocalution_host_name[0];
+
+        LOG_INFO("LocalShellOperator"
+                 << " name=" << this->object_name_ << ";"
+                 << " rows=" << this->GetM() << ";"
+                 << " cols=" << this->GetN() << ";"
+                 << " prec=" << 8 * sizeof(ValueType) << "bit;"
+                 << " current=" << current_backend_name);
+    }
+
+    template <typename ValueType>
+    void LocalShellOperator<ValueType>::SetSize(int64_t nrow, int64_t ncol)
+    {
+        log_debug(this, "LocalShellOperator::SetSize()", nrow, ncol);
+
+        assert(nrow >= 0);
+        assert(ncol >= 0);
+
+        this->nrow_ = nrow;
+        this->ncol_ = ncol;
+    }
+
+    template <typename ValueType>
+    int64_t LocalShellOperator<ValueType>::GetM(void) const
+    {
+        return this->nrow_;
+    }
+
+    template <typename ValueType>
+    int64_t LocalShellOperator<ValueType>::GetN(void) const
+    {
+        return this->ncol_;
+    }
+
+    template <typename ValueType>
+    int64_t LocalShellOperator<ValueType>::GetNnz(void) const
+    {
+        return 0;
+    }
+
+    template <typename ValueType>
+    void LocalShellOperator<ValueType>::Clear(void)
+    {
+        log_debug(this, "LocalShellOperator::Clear()");
+
+        this->tmp_.Clear();
+    }
+
+    template <typename ValueType>
+    void* LocalShellOperator<ValueType>::GetStream(void) const
+    {
+        if(this->accel_ == false || this->local_backend_.HIP_stream_current == NULL)
+        {
+            return NULL;
+        }
+
+        // HIP_stream_current points to a hipStream_t, which is a pointer type
+        return *static_cast<void**>(this->local_backend_.HIP_stream_current);
+    }
+
+    template <typename ValueType>
+    bool LocalShellOperator<ValueType>::ShellDiagonal(ValueType* diag) const
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    bool LocalShellOperator<ValueType>::is_host_(void) const
+    {
+        return !this->accel_;
+    }
+
+    template <typename ValueType>
+    bool LocalShellOperator<ValueType>::is_accel_(void) const
+    {
+        return this->accel_;
+    }
+
+    template <typename ValueType>
+    void LocalShellOperator<ValueType>::Apply(const LocalVector<ValueType>& in,
+                                              LocalVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalShellOperator::Apply()", (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        assert(((this->is_host_() == true) && (in.is_host_() == true)
+                && (out->is_host_() == true))
+               || ((this->is_accel_() == true) && (in.is_accel_() == true)
+                   && (out->is_accel_() == true)));
+
+        if(this->nrow_ > 0)
+        {
+            this->ShellApply(in.vector_->GetDataPtr(), out->vector_->GetDataPtr());
+        }
+    }
+
+    template <typename ValueType>
+    void LocalShellOperator<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
+                                                 ValueType                     scalar,
+                                                 LocalVector<ValueType>*       out) const
+    {
+        log_debug(this, "LocalShellOperator::ApplyAdd()", (const void*&)in, scalar, out);
+
+        assert(out != NULL);
+
+        if(this->tmp_.GetSize() != this->nrow_)
+        {
+            this->tmp_.Clear();
+            this->tmp_.CloneBackend(*this);
+            this->tmp_.Allocate("shell operator tmp", this->nrow_);
+        }
+
+        this->Apply(in, &this->tmp_);
+        out->AddScale(this->tmp_, scalar);
+    }
+
+    template <typename ValueType>
+    void LocalShellOperator<ValueType>::ExtractDiagonal(LocalVector<ValueType>* vec_diag) const
+    {
+        log_debug(this, "LocalShellOperator::ExtractDiagonal()", vec_diag);
+
+        assert(vec_diag != NULL);
+
+        std::string vec_diag_name = "Diagonal elements of " + this->object_name_;
+
+        vec_diag->Clear();
+        vec_diag->CloneBackend(*this);
+        vec_diag->Allocate(vec_diag_name, this->nrow_);
+
+        if(this->nrow_ > 0 && this->ShellDiagonal(vec_diag->vector_->GetDataPtr()) == false)
+        {
+            LOG_INFO("LocalShellOperator::ExtractDiagonal() failed, ShellDiagonal() is not "
+                     "provided by the operator");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalShellOperator<ValueType>::ExtractInverseDiagonal(
+        LocalVector<ValueType>* vec_inv_diag) const
+    {
+        log_debug(this, "LocalShellOperator::ExtractInverseDiagonal()", vec_inv_diag);
+
+        this->ExtractDiagonal(vec_inv_diag);
+        vec_inv_diag->Power(-1.0);
+    }
+
+    template <typename ValueType>
+    void LocalShellOperator<ValueType>::MoveToAccelerator(void)
+    {
+        log_debug(this, "LocalShellOperator::MoveToAccelerator()");
+
+        if(_rocalution_available_accelerator() == false)
+        {
+            LOG_VERBOSE_INFO(4,
+                             "*** info: LocalShellOperator::MoveToAccelerator() no accelerator "
+                             "available - doing nothing");
+
+            return;
+        }
+
+        this->accel_ = true;
+        this->tmp_.MoveToAccelerator();
+    }
+
+    template <typename ValueType>
+    void LocalShellOperator<ValueType>::MoveToHost(void)
+    {
+        log_debug(this, "LocalShellOperator::MoveToHost()");
+
+        this->accel_ = false;
+        this->tmp_.MoveToHost();
+    }
+
+    template class LocalShellOperator<double>;
+    template class LocalShellOperator<float>;
+#ifdef SUPPORT_COMPLEX
+    template class LocalShellOperator<std::complex<double>>;
+    template class LocalShellOperator<std::complex<float>>;
+#endif
+
+} // namespace rocalution
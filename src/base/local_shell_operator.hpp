@@ -0,0 +1,174 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_LOCAL_SHELL_OPERATOR_HPP_
+#define ROCALUTION_LOCAL_SHELL_OPERATOR_HPP_
+
+#include "local_vector.hpp"
+#include "operator.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    class LocalVector;
+    template <typename ValueType>
+    class GlobalVector;
+
+    /** \ingroup op_vec_module
+  * \class LocalShellOperator
+  * \brief LocalShellOperator class
+  * \details
+  * A LocalShellOperator is a matrix-free operator, where the application of the operator
+  * is provided by the user. Derived classes implement ShellApply() (and optionally
+  * ShellDiagonal()), which work on the raw data of the vectors. If the operator has
+  * been moved to the accelerator, the pointers refer to device memory and the work has
+  * to be queued on the stream returned by GetStream(), or on the null stream.
+  *
+  * A LocalShellOperator can be used as operator of the CG, GMRES and Chebyshev solvers,
+  * the FixedPoint iteration and the Jacobi preconditioner. Multigrid methods can be used
+  * through the AssembledPreconditioner, which builds the solver on an assembled
+  * approximation of the operator.
+  *
+  * \par Example
+  * \code{.cpp}
+  *   class MyOperator : public LocalShellOperator<double>
+  *   {
+  *   protected:
+  *       virtual void ShellApply(const double* in, double* out) const
+  *       {
+  *           // out = A * in
+  *       }
+  *   };
+  *
+  *   MyOperator op;
+  *   op.SetSize(n, n);
+  *   op.MoveToAccelerator();
+  *
+  *   CG<LocalShellOperator<double>, LocalVector<double>, double> ls;
+  *   ls.SetOperator(op);
+  *   ls.Build();
+  * \endcode
+  *
+  * \tparam ValueType - can be float, double, std::complex<float> and
+  *                     std::complex<double>
+  */
+    template <typename ValueType>
+    class LocalShellOperator : public Operator<ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        LocalShellOperator();
+        ROCALUTION_EXPORT
+        virtual ~LocalShellOperator();
+
+        /** \brief Shows simple info about the operator. */
+        ROCALUTION_EXPORT
+        virtual void Info(void) const;
+
+        /** \brief Set the number of rows and columns of the operator */
+        ROCALUTION_EXPORT
+        void SetSize(int64_t nrow, int64_t ncol);
+
+        /** \brief Return the number of rows of the operator. */
+        ROCALUTION_EXPORT
+        virtual int64_t GetM(void) const;
+        /** \brief Return the number of columns of the operator. */
+        ROCALUTION_EXPORT
+        virtual int64_t GetN(void) const;
+        /** \brief Return the number of non-zeros, which is zero for a shell operator. */
+        ROCALUTION_EXPORT
+        virtual int64_t GetNnz(void) const;
+
+        /** \brief Clear the temporary data of the operator */
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Return the stream (a \p hipStream_t casted to \p void*) on which the
+      * accelerator work of ShellApply() and ShellDiagonal() has to be queued, or NULL
+      * for host operators
+      */
+        ROCALUTION_EXPORT
+        void* GetStream(void) const;
+
+        /** \brief Apply the operator, out = Operator(in) */
+        ROCALUTION_EXPORT
+        virtual void Apply(const LocalVector<ValueType>& in, LocalVector<ValueType>* out) const;
+        /** \brief Apply and add the operator, out += scalar * Operator(in) */
+        ROCALUTION_EXPORT
+        virtual void ApplyAdd(const LocalVector<ValueType>& in,
+                              ValueType                     scalar,
+                              LocalVector<ValueType>*       out) const;
+
+        /** \brief Extract the diagonal of the operator, see ShellDiagonal() */
+        ROCALUTION_EXPORT
+        void ExtractDiagonal(LocalVector<ValueType>* vec_diag) const;
+        /** \brief Extract the inverse diagonal of the operator, see ShellDiagonal() */
+        ROCALUTION_EXPORT
+        void ExtractInverseDiagonal(LocalVector<ValueType>* vec_inv_diag) const;
+
+        /** \brief Move the operator to the accelerator
+      * \details
+      * Derived classes that hold data of their own can override MoveToAccelerator() and
+      * MoveToHost() to move it, and have to call the function of this class.
+      */
+        ROCALUTION_EXPORT
+        virtual void MoveToAccelerator(void);
+        /** \brief Move the operator to the host */
+        ROCALUTION_EXPORT
+        virtual void MoveToHost(void);
+
+    protected:
+        /** \brief User defined application of the operator, out = Operator(in)
+      * \details
+      * \p in has GetN() and \p out has GetM() entries, in host memory or, if the
+      * operator is on the accelerator, in device memory.
+      */
+        virtual void ShellApply(const ValueType* in, ValueType* out) const = 0;
+
+        /** \brief User defined extraction of the diagonal of the operator
+      * \details
+      * Writes the GetM() diagonal entries to \p diag and returns true. The default
+      * implementation returns false, i.e. the diagonal is not available.
+      */
+        virtual bool ShellDiagonal(ValueType* diag) const;
+
+        /** \brief Return true if the object is on the host */
+        virtual bool is_host_(void) const;
+        /** \brief Return true if the object is on the accelerator */
+        virtual bool is_accel_(void) const;
+
+    private:
+        int64_t nrow_;
+        int64_t ncol_;
+
+        bool accel_;
+
+        // Temporary vector for ApplyAdd()
+        mutable LocalVector<ValueType> tmp_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_LOCAL_SHELL_OPERATOR_HPP_
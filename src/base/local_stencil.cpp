@@ -23,7 +23,8 @@
 
 #include "local_stencil.hpp"
 #include "../utils/def.hpp"
-#include "host/host_stencil_laplace2d.hpp"
+#include "backend_manager.hpp"
+#include "base_stencil.hpp"
 #include "host/host_vector.hpp"
 #include "local_vector.hpp"
 #include "stencil_types.hpp"
@@ -60,12 +61,26 @@ namespace rocalution
     {
         log_debug(this, "LocalStencil::LocalStencil()", type);
 
-        assert(type == Laplace2D); // the only one at the moment
+        assert(type == Laplace2D || type == Laplace3D || type == Laplace3D27);
 
         this->object_name_ = _stencil_type_names[type];
 
-        this->stencil_host_ = new HostStencilLaplace2D<ValueType>(this->local_backend_);
-        this->stencil_      = this->stencil_host_;
+        this->stencil_host_
+            = _rocalution_init_base_host_stencil<ValueType>(this->local_backend_, type);
+        this->stencil_accel_ = NULL;
+        this->stencil_       = this->stencil_host_;
+    }
+
+    template <typename ValueType>
+    bool LocalStencil<ValueType>::is_host_(void) const
+    {
+        return (this->stencil_ == this->stencil_host_);
+    }
+
+    template <typename ValueType>
+    bool LocalStencil<ValueType>::is_accel_(void) const
+    {
+        return (this->stencil_ == this->stencil_accel_);
     }
 
     template <typename ValueType>
@@ -146,21 +161,58 @@ namespace rocalution
                || ((this->stencil_ == this->stencil_accel_) && (in.vector_ == in.vector_accel_)
                    && (out->vector_ == out->vector_accel_)));
 
-        this->stencil_->Apply(*in.vector_, out->vector_);
+        this->stencil_->ApplyAdd(*in.vector_, scalar, out->vector_);
     }
 
     template <typename ValueType>
     void LocalStencil<ValueType>::MoveToAccelerator(void)
     {
-        LOG_INFO("The function is not implemented (yet)!");
-        FATAL_ERROR(__FILE__, __LINE__);
+        log_debug(this, "LocalStencil::MoveToAccelerator()");
+
+        if(_rocalution_available_accelerator() == false)
+        {
+            LOG_VERBOSE_INFO(4,
+                             "*** info: LocalStencil::MoveToAccelerator() no accelerator available "
+                             "- doing nothing");
+        }
+
+        if((_rocalution_available_accelerator()) && (this->stencil_ == this->stencil_host_))
+        {
+            this->stencil_accel_ = _rocalution_init_base_backend_stencil<ValueType>(
+                this->local_backend_, this->stencil_host_->GetStencilId());
+            this->stencil_accel_->CopyFromHost(*this->stencil_host_);
+
+            this->stencil_ = this->stencil_accel_;
+            delete this->stencil_host_;
+            this->stencil_host_ = NULL;
+
+            LOG_VERBOSE_INFO(
+                4, "*** info: LocalStencil::MoveToAccelerator() host to accelerator transfer");
+        }
+
+        // if on accelerator - do nothing
     }
 
     template <typename ValueType>
     void LocalStencil<ValueType>::MoveToHost(void)
     {
-        LOG_INFO("The function is not implemented (yet)!");
-        FATAL_ERROR(__FILE__, __LINE__);
+        log_debug(this, "LocalStencil::MoveToHost()");
+
+        if((_rocalution_available_accelerator()) && (this->stencil_ == this->stencil_accel_))
+        {
+            this->stencil_host_ = _rocalution_init_base_host_stencil<ValueType>(
+                this->local_backend_, this->stencil_accel_->GetStencilId());
+            this->stencil_accel_->CopyToHost(this->stencil_host_);
+
+            this->stencil_ = this->stencil_host_;
+            delete this->stencil_accel_;
+            this->stencil_accel_ = NULL;
+
+            LOG_VERBOSE_INFO(4,
+                             "*** info: LocalStencil::MoveToHost() accelerator to host transfer");
+        }
+
+        // if on host - do nothing
     }
 
     template class LocalStencil<double>;
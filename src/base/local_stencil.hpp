@@ -110,15 +110,9 @@ namespace rocalution
 
     protected:
         /** \brief Return true if the object is on the host */
-        virtual bool is_host_(void) const
-        {
-            return true;
-        };
+        virtual bool is_host_(void) const;
         /** \brief Return true if the object is on the accelerator */
-        virtual bool is_accel_(void) const
-        {
-            return false;
-        };
+        virtual bool is_accel_(void) const;
 
     private:
         std::string object_name_;
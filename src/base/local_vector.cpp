@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -34,6 +34,8 @@
 #include <complex>
 #include <sstream>
 #include <stdlib.h>
+#include <type_traits>
+#include <vector>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -41,6 +43,13 @@
 namespace rocalution
 {
 
+    // Size of the vector data in bytes, used for the host fallback statistics
+    template <typename ValueType>
+    static int64_t host_fallback_bytes(const LocalVector<ValueType>& vec)
+    {
+        return vec.GetSize() * sizeof(ValueType);
+    }
+
     template <typename ValueType>
     LocalVector<ValueType>::LocalVector()
     {
@@ -90,6 +99,8 @@ namespace rocalution
 
         this->object_name_ = name;
 
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
         if(size > 0)
         {
             Rocalution_Backend_Descriptor backend = this->local_backend_;
@@ -128,12 +139,15 @@ namespace rocalution
 
         if(this->is_accel_() == true)
         {
+            double fallback_start = _rocalution_host_fallback_begin("LocalVector::Check()", true);
+
             LocalVector<ValueType> vec;
             vec.CopyFrom(*this);
 
             check = vec.Check();
 
-            LOG_VERBOSE_INFO(2, "*** warning: LocalVector::Check() is performed on the host");
+            _rocalution_host_fallback_end(
+                "LocalVector::Check()", fallback_start, host_fallback_bytes(*this));
         }
         else
         {
@@ -181,6 +195,25 @@ namespace rocalution
         this->vector_->LeaveDataPtr(ptr);
     }
 
+    template <typename ValueType>
+    void LocalVector<ValueType>::AttachView(ValueType* ptr, std::string name, int64_t size)
+    {
+        log_debug(this, "LocalVector::AttachView()", ptr, name, size);
+
+        assert(size >= 0);
+
+        if(size > 0)
+        {
+            assert(ptr != NULL);
+        }
+
+        this->Clear();
+
+        this->object_name_ = name;
+
+        this->vector_->AttachView(ptr, size);
+    }
+
     template <typename ValueType>
     void LocalVector<ValueType>::Clear(void)
     {
@@ -311,6 +344,8 @@ namespace rocalution
     {
         log_debug(this, "LocalVector::MoveToAccelerator()");
 
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
         if(_rocalution_available_accelerator() == false)
         {
             LOG_VERBOSE_INFO(4,
@@ -335,11 +370,70 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void LocalVector<ValueType>::MoveToAccelerator(const ExecutionContext& context)
+    {
+        log_debug(this, "LocalVector::MoveToAccelerator()", (const void*&)context);
+
+        if(_rocalution_available_accelerator() == false)
+        {
+            this->MoveToAccelerator();
+
+            return;
+        }
+
+        // Already on the device of the context
+        if(this->vector_accel_ != NULL && this->local_backend_.HIP_dev == context.GetDevice())
+        {
+            this->SetExecutionContext(context);
+
+            return;
+        }
+
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
+        int prev = _rocalution_set_device(this->local_backend_.HIP_dev);
+
+        if(this->vector_accel_ != NULL)
+        {
+            // Work on the previous device has to be completed
+            _rocalution_sync();
+
+            // Allocations are placed on the current device
+            _rocalution_set_device(context.GetDevice());
+
+            BaseRocalution<ValueType>::SetExecutionContext(context);
+
+            // Copy device to device (peer access, or staged by the runtime)
+            AcceleratorVector<ValueType>* accel
+                = _rocalution_init_base_backend_vector<ValueType>(this->local_backend_);
+            accel->CopyFrom(*this->vector_accel_);
+
+            delete this->vector_accel_;
+            this->vector_accel_ = accel;
+            this->vector_       = accel;
+
+            LOG_VERBOSE_INFO(
+                4, "*** info: LocalVector::MoveToAccelerator() device to device transfer");
+        }
+        else
+        {
+            _rocalution_set_device(context.GetDevice());
+
+            this->SetExecutionContext(context);
+            this->MoveToAccelerator();
+        }
+
+        _rocalution_set_device(prev);
+    }
+
     template <typename ValueType>
     void LocalVector<ValueType>::MoveToHost(void)
     {
         log_debug(this, "LocalVector::MoveToHost()");
 
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
         if(_rocalution_available_accelerator() == false)
         {
             LOG_VERBOSE_INFO(
@@ -366,6 +460,8 @@ namespace rocalution
     {
         log_debug(this, "LocalVector::MoveToAcceleratorAsync()");
 
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
         assert(this->asyncf_ == false);
 
         if(_rocalution_available_accelerator() == false)
@@ -395,6 +491,8 @@ namespace rocalution
     {
         log_debug(this, "LocalVector::MoveToHostAsync()");
 
+        RocalutionMemoryTag mem_tag(this->object_name_);
+
         assert(this->asyncf_ == false);
 
         if(_rocalution_available_accelerator() == false)
@@ -419,6 +517,30 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void LocalVector<ValueType>::Prefetch(void) const
+    {
+        log_debug(this, "LocalVector::Prefetch()");
+
+        if(this->is_accel_() == true)
+        {
+            this->vector_->Prefetch();
+        }
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::SetExecutionContext(const ExecutionContext& context)
+    {
+        log_debug(this, "LocalVector::SetExecutionContext()", (const void*&)context);
+
+        BaseRocalution<ValueType>::SetExecutionContext(context);
+
+        if(this->vector_accel_ != NULL)
+        {
+            this->vector_accel_->set_backend(this->local_backend_);
+        }
+    }
+
     template <typename ValueType>
     void LocalVector<ValueType>::Sync(void)
     {
@@ -733,6 +855,53 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    ValueType LocalVector<ValueType>::DotFloat(const LocalVector<float>& x) const
+    {
+        log_debug(this, "LocalVector::DotFloat()", (const void*&)x);
+
+        assert(this->GetSize() == x.GetSize());
+        assert(this->is_host_() == x.is_host_());
+
+        if(this->GetSize() > 0)
+        {
+            return this->vector_->DotFloat(*x.vector_);
+        }
+        else
+        {
+            return static_cast<ValueType>(0);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::AddScaleFloat(const LocalVector<float>& x, ValueType alpha)
+    {
+        log_debug(this, "LocalVector::AddScaleFloat()", (const void*&)x, alpha);
+
+        assert(this->GetSize() == x.GetSize());
+        assert(this->is_host_() == x.is_host_());
+
+        if(this->GetSize() > 0)
+        {
+            this->vector_->AddScaleFloat(*x.vector_, alpha);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::ScaleCopyToFloat(ValueType alpha, LocalVector<float>* vec)
+    {
+        log_debug(this, "LocalVector::ScaleCopyToFloat()", alpha, vec);
+
+        assert(vec != NULL);
+        assert(this->GetSize() == vec->GetSize());
+        assert(this->is_host_() == vec->is_host_());
+
+        if(this->GetSize() > 0)
+        {
+            this->vector_->ScaleCopyToFloat(alpha, vec->vector_);
+        }
+    }
+
     template <typename ValueType>
     ValueType LocalVector<ValueType>::DotNonConj(const LocalVector<ValueType>& x) const
     {
@@ -752,6 +921,351 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void LocalVector<ValueType>::MultiDot(int                                  count,
+                                          const LocalVector<ValueType>* const* x,
+                                          ValueType*                           res) const
+    {
+        log_debug(this, "LocalVector::MultiDot()", count, x, res);
+
+        assert(count > 0);
+        assert(x != NULL);
+        assert(res != NULL);
+
+        if(this->GetSize() > 0)
+        {
+            std::vector<const BaseVector<ValueType>*> vec(count);
+
+            for(int k = 0; k < count; ++k)
+            {
+                assert(x[k] != NULL);
+                assert(this->GetSize() == x[k]->GetSize());
+                assert(
+                    ((this->vector_ == this->vector_host_) && (x[k]->vector_ == x[k]->vector_host_))
+                    || ((this->vector_ == this->vector_accel_)
+                        && (x[k]->vector_ == x[k]->vector_accel_)));
+
+                vec[k] = x[k]->vector_;
+            }
+
+            this->vector_->MultiDot(count, vec.data(), res);
+        }
+        else
+        {
+            set_to_zero_host(count, res);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::MultiAddScale(int                                  count,
+                                               const LocalVector<ValueType>* const* x,
+                                               const ValueType*                     alpha)
+    {
+        log_debug(this, "LocalVector::MultiAddScale()", count, x, alpha);
+
+        assert(count >= 0);
+        assert(x != NULL || count == 0);
+        assert(alpha != NULL || count == 0);
+
+        if(this->GetSize() > 0 && count > 0)
+        {
+            std::vector<const BaseVector<ValueType>*> vec(count);
+
+            for(int k = 0; k < count; ++k)
+            {
+                assert(x[k] != NULL);
+                assert(this->GetSize() == x[k]->GetSize());
+                assert(
+                    ((this->vector_ == this->vector_host_) && (x[k]->vector_ == x[k]->vector_host_))
+                    || ((this->vector_ == this->vector_accel_)
+                        && (x[k]->vector_ == x[k]->vector_accel_)));
+
+                vec[k] = x[k]->vector_;
+            }
+
+            this->vector_->MultiAddScale(count, vec.data(), alpha);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::DotNonConjAsync(int                                  n,
+                                                 const LocalVector<ValueType>* const* x,
+                                                 const LocalVector<ValueType>* const* y,
+                                                 ValueType*                           res) const
+    {
+        log_debug(this, "LocalVector::DotNonConjAsync()", n, x, y, res);
+
+        assert(n > 0);
+        assert(x != NULL);
+        assert(y != NULL);
+        assert(res != NULL);
+
+        for(int i = 0; i < n; ++i)
+        {
+            res[i] = x[i]->DotNonConj(*y[i]);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::DotAsync(int                                  n,
+                                          const LocalVector<ValueType>* const* x,
+                                          const LocalVector<ValueType>* const* y,
+                                          ValueType*                           res) const
+    {
+        log_debug(this, "LocalVector::DotAsync()", n, x, y, res);
+
+        assert(n > 0);
+        assert(x != NULL);
+        assert(y != NULL);
+        assert(res != NULL);
+
+        for(int i = 0; i < n; ++i)
+        {
+            res[i] = x[i]->Dot(*y[i]);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::DotSync(void) const
+    {
+        log_debug(this, "LocalVector::DotSync()");
+    }
+
+    template <typename ValueType>
+    ValueType LocalVector<ValueType>::AddScaleDot(const LocalVector<ValueType>& x,
+                                                  ValueType                     alpha,
+                                                  const LocalVector<ValueType>& y)
+    {
+        log_debug(this, "LocalVector::AddScaleDot()", (const void*&)x, alpha, (const void*&)y);
+
+        assert(this->GetSize() == x.GetSize());
+        assert(this->GetSize() == y.GetSize());
+        assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)
+                && (y.vector_ == y.vector_host_))
+               || ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)
+                   && (y.vector_ == y.vector_accel_)));
+
+        if(this->GetSize() > 0)
+        {
+            return this->vector_->AddScaleDot(*x.vector_, alpha, *y.vector_);
+        }
+        else
+        {
+            return static_cast<ValueType>(0);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::Evaluate(const VectorExpressionProgram<ValueType>& program,
+                                          const LocalVector<ValueType>* const*      vec)
+    {
+        log_debug(this, "LocalVector::Evaluate()", program.num_ops, vec);
+
+        if(program.num_ops < 0)
+        {
+            LOG_INFO("LocalVector::Evaluate() the vector expression exceeds the limits of "
+                     << _vector_expression_max_ops << " instructions, "
+                     << _vector_expression_max_vectors << " vectors, "
+                     << _vector_expression_max_scalars << " scalars or a stack depth of "
+                     << _vector_expression_max_stack);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        const BaseVector<ValueType>* base[_vector_expression_max_vectors];
+
+        for(int k = 0; k < program.num_vectors; ++k)
+        {
+            assert(vec[k] != NULL);
+            assert(vec[k]->GetSize() == this->GetSize());
+            assert(vec[k]->is_host_() == this->is_host_());
+
+            base[k] = vec[k]->vector_;
+        }
+
+        if(this->GetSize() > 0)
+        {
+            this->vector_->Evaluate(program, base);
+        }
+    }
+
+    template <typename ValueType>
+    ValueType
+        LocalVector<ValueType>::EvaluateSum(const VectorExpressionProgram<ValueType>& program,
+                                            const LocalVector<ValueType>* const*      vec) const
+    {
+        log_debug(this, "LocalVector::EvaluateSum()", program.num_ops, vec);
+
+        if(program.num_ops < 0)
+        {
+            LOG_INFO("LocalVector::EvaluateSum() the vector expression exceeds the limits of "
+                     << _vector_expression_max_ops << " instructions, "
+                     << _vector_expression_max_vectors << " vectors, "
+                     << _vector_expression_max_scalars << " scalars or a stack depth of "
+                     << _vector_expression_max_stack);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        const BaseVector<ValueType>* base[_vector_expression_max_vectors];
+
+        for(int k = 0; k < program.num_vectors; ++k)
+        {
+            assert(vec[k] != NULL);
+            assert(vec[k]->GetSize() == this->GetSize());
+            assert(vec[k]->is_host_() == this->is_host_());
+
+            base[k] = vec[k]->vector_;
+        }
+
+        if(this->GetSize() > 0)
+        {
+            return this->vector_->EvaluateSum(program, base);
+        }
+        else
+        {
+            return static_cast<ValueType>(0);
+        }
+    }
+
+    template <typename ValueType>
+    ValueType LocalVector<ValueType>::AddScaleNorm(const LocalVector<ValueType>& x,
+                                                   ValueType                     alpha)
+    {
+        log_debug(this, "LocalVector::AddScaleNorm()", (const void*&)x, alpha);
+
+        return std::sqrt(this->AddScaleDot(x, alpha, *this));
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::DualDot(const LocalVector<ValueType>& x,
+                                         const LocalVector<ValueType>& y,
+                                         ValueType*                    res) const
+    {
+        log_debug(this, "LocalVector::DualDot()", (const void*&)x, (const void*&)y, res);
+
+        assert(res != NULL);
+        assert(this->GetSize() == x.GetSize());
+        assert(this->GetSize() == y.GetSize());
+        assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)
+                && (y.vector_ == y.vector_host_))
+               || ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)
+                   && (y.vector_ == y.vector_accel_)));
+
+        if(this->GetSize() > 0)
+        {
+            this->vector_->DualDot(*x.vector_, *y.vector_, res);
+        }
+        else
+        {
+            res[0] = static_cast<ValueType>(0);
+            res[1] = static_cast<ValueType>(0);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::DotToScalar(const LocalVector<ValueType>& x,
+                                             LocalVector<ValueType>*       res,
+                                             int64_t                       index) const
+    {
+        log_debug(this, "LocalVector::DotToScalar()", (const void*&)x, res, index);
+
+        assert(res != NULL);
+        assert(index >= 0);
+        assert(index < res->GetSize());
+        assert(this->GetSize() == x.GetSize());
+        assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)
+                && (res->vector_ == res->vector_host_))
+               || ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)
+                   && (res->vector_ == res->vector_accel_)));
+
+        this->vector_->DotToScalar(*x.vector_, true, res->vector_, index);
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::DotNonConjToScalar(const LocalVector<ValueType>& x,
+                                                    LocalVector<ValueType>*       res,
+                                                    int64_t                       index) const
+    {
+        log_debug(this, "LocalVector::DotNonConjToScalar()", (const void*&)x, res, index);
+
+        assert(res != NULL);
+        assert(index >= 0);
+        assert(index < res->GetSize());
+        assert(this->GetSize() == x.GetSize());
+        assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)
+                && (res->vector_ == res->vector_host_))
+               || ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)
+                   && (res->vector_ == res->vector_accel_)));
+
+        this->vector_->DotToScalar(*x.vector_, false, res->vector_, index);
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::NormToScalar(LocalVector<ValueType>* res, int64_t index) const
+    {
+        log_debug(this, "LocalVector::NormToScalar()", res, index);
+
+        assert(res != NULL);
+        assert(index >= 0);
+        assert(index < res->GetSize());
+        assert(((this->vector_ == this->vector_host_) && (res->vector_ == res->vector_host_))
+               || ((this->vector_ == this->vector_accel_)
+                   && (res->vector_ == res->vector_accel_)));
+
+        this->vector_->NormToScalar(res->vector_, index);
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::AddScaleRatio(const LocalVector<ValueType>& x,
+                                               ValueType                     factor,
+                                               const LocalVector<ValueType>& scalars,
+                                               int64_t                       num,
+                                               int64_t                       den)
+    {
+        log_debug(this,
+                  "LocalVector::AddScaleRatio()",
+                  (const void*&)x,
+                  factor,
+                  (const void*&)scalars,
+                  num,
+                  den);
+
+        assert(num >= 0 && num < scalars.GetSize());
+        assert(den >= 0 && den < scalars.GetSize());
+        assert(this->GetSize() == x.GetSize());
+        assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)
+                && (scalars.vector_ == scalars.vector_host_))
+               || ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)
+                   && (scalars.vector_ == scalars.vector_accel_)));
+
+        if(this->GetSize() > 0)
+        {
+            this->vector_->AddScaleRatio(*x.vector_, factor, *scalars.vector_, num, den);
+        }
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::ScaleRatioAdd(const LocalVector<ValueType>& scalars,
+                                               int64_t                       num,
+                                               int64_t                       den,
+                                               const LocalVector<ValueType>& x)
+    {
+        log_debug(
+            this, "LocalVector::ScaleRatioAdd()", (const void*&)scalars, num, den, (const void*&)x);
+
+        assert(num >= 0 && num < scalars.GetSize());
+        assert(den >= 0 && den < scalars.GetSize());
+        assert(this->GetSize() == x.GetSize());
+        assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)
+                && (scalars.vector_ == scalars.vector_host_))
+               || ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)
+                   && (scalars.vector_ == scalars.vector_accel_)));
+
+        if(this->GetSize() > 0)
+        {
+            this->vector_->ScaleRatioAdd(*scalars.vector_, num, den, *x.vector_);
+        }
+    }
+
     template <typename ValueType>
     ValueType LocalVector<ValueType>::Norm(void) const
     {
@@ -957,6 +1471,78 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void LocalVector<ValueType>::ExtractRealEquivalent(
+        LocalVector<numeric_traits_t<ValueType>>* vec) const
+    {
+        log_debug(this, "LocalVector::ExtractRealEquivalent()", vec);
+
+        typedef numeric_traits_t<ValueType> RealType;
+
+        assert(vec != NULL);
+        assert(static_cast<const void*>(vec) != static_cast<const void*>(this));
+
+        if(std::is_same<ValueType, RealType>::value == true)
+        {
+            LOG_INFO("LocalVector::ExtractRealEquivalent() requires a complex vector");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        vec->Clear();
+        vec->CloneBackend(*this);
+
+        if(this->GetSize() == 0)
+        {
+            return;
+        }
+
+        std::string name = this->object_name_ + " (real equivalent)";
+
+        vec->Allocate(name, 2 * this->GetSize());
+
+        // A complex number is stored as its real part followed by its imaginary part,
+        // such that the data is copied as is
+        RealType* data = NULL;
+        vec->LeaveDataPtr(&data);
+
+        this->CopyToData(reinterpret_cast<ValueType*>(data));
+
+        vec->SetDataPtr(&data, name, 2 * this->GetSize());
+    }
+
+    template <typename ValueType>
+    void LocalVector<ValueType>::CopyFromRealEquivalent(
+        const LocalVector<numeric_traits_t<ValueType>>& vec)
+    {
+        log_debug(this, "LocalVector::CopyFromRealEquivalent()", (const void*&)vec);
+
+        typedef numeric_traits_t<ValueType> RealType;
+
+        assert(vec.GetSize() == 2 * this->GetSize());
+        assert(this->is_host_() == vec.is_host_());
+
+        if(std::is_same<ValueType, RealType>::value == true)
+        {
+            LOG_INFO("LocalVector::CopyFromRealEquivalent() requires a complex vector");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(this->GetSize() == 0)
+        {
+            return;
+        }
+
+        std::string name = this->object_name_;
+        int64_t     size = this->GetSize();
+
+        ValueType* data = NULL;
+        this->LeaveDataPtr(&data);
+
+        vec.CopyToData(reinterpret_cast<RealType*>(data));
+
+        this->SetDataPtr(&data, name, size);
+    }
+
     template <typename ValueType>
     void LocalVector<ValueType>::Permute(const LocalVector<int>& permutation)
     {
@@ -1062,6 +1648,9 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalVector::Restriction()", this->is_accel_());
+
                 this->MoveToHost();
 
                 LocalVector<int> map_tmp;
@@ -1077,14 +1666,54 @@ namespace rocalution
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                LOG_VERBOSE_INFO(
-                    2, "*** warning: LocalVector::Restriction() is performed on the host");
+                _rocalution_host_fallback_end(
+                    "LocalVector::Restriction()", fallback_start, host_fallback_bytes(*this));
 
                 this->MoveToAccelerator();
             }
         }
     }
 
+    template <typename ValueType>
+    void LocalVector<ValueType>::Sketch(const LocalVector<int>& map,
+                                        LocalVector<ValueType>* work,
+                                        ValueType*              res) const
+    {
+        log_debug(this, "LocalVector::Sketch()", (const void*&)map, work, res);
+
+        assert(work != NULL);
+        assert(work != this);
+        assert(res != NULL);
+        assert(map.GetSize() == this->GetSize());
+        assert(work->GetSize() > 0);
+        assert(work->GetSize() % 2 == 0);
+
+        int64_t size = work->GetSize() / 2;
+
+        // Sum up the entries of each bucket and sign, the same scatter as the
+        // aggregation based restriction
+        if(this->GetSize() > 0)
+        {
+            work->Restriction(*this, map);
+        }
+        else
+        {
+            work->Zeros();
+        }
+
+        ValueType* sums = NULL;
+        allocate_host(2 * size, &sums);
+
+        work->CopyToHostData(sums);
+
+        for(int64_t k = 0; k < size; ++k)
+        {
+            res[k] = sums[2 * k] - sums[2 * k + 1];
+        }
+
+        free_host(&sums);
+    }
+
     template <typename ValueType>
     void LocalVector<ValueType>::Prolongation(const LocalVector<ValueType>& vec_coarse,
                                               const LocalVector<int>&       map)
@@ -1112,6 +1741,10 @@ namespace rocalution
 
             if(err == false)
             {
+                double fallback_start
+                    = _rocalution_host_fallback_begin("LocalVector::Prolongation()",
+                                                      this->is_accel_());
+
                 this->MoveToHost();
 
                 LocalVector<int> map_tmp;
@@ -1127,8 +1760,8 @@ namespace rocalution
                     FATAL_ERROR(__FILE__, __LINE__);
                 }
 
-                LOG_VERBOSE_INFO(
-                    2, "*** warning: LocalVector::Prolongation() is performed on the host");
+                _rocalution_host_fallback_end(
+                    "LocalVector::Prolongation()", fallback_start, host_fallback_bytes(*this));
 
                 this->MoveToAccelerator();
             }
@@ -1146,6 +1779,17 @@ namespace rocalution
         this->vector_->GetIndexValues(*index.vector_, values->vector_);
     }
 
+    template <typename ValueType>
+    void LocalVector<ValueType>::GetIndexValuesFloat(const LocalVector<int>& index,
+                                                     LocalVector<float>*     values) const
+    {
+        log_debug(this, "LocalVector::GetIndexValuesFloat()", (const void*&)index, values);
+
+        assert(values != NULL);
+
+        this->vector_->GetIndexValuesFloat(*index.vector_, values->vector_);
+    }
+
     template <typename ValueType>
     void LocalVector<ValueType>::SetIndexValues(const LocalVector<int>&       index,
                                                 const LocalVector<ValueType>& values)
@@ -1218,8 +1862,8 @@ namespace rocalution
         }
         else
         {
-            LOG_VERBOSE_INFO(
-                2, "*** warning: LocalVector::ExtractCoarseMapping() is performed on the host");
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalVector::ExtractCoarseMapping()", true);
 
             LocalVector<ValueType> vec_host;
             vec_host.CloneFrom(*this);
@@ -1227,6 +1871,9 @@ namespace rocalution
             vec_host.MoveToHost();
 
             vec_host.ExtractCoarseMapping(start, end, index, nc, size, map);
+
+            _rocalution_host_fallback_end(
+                "LocalVector::ExtractCoarseMapping()", fallback_start, host_fallback_bytes(*this));
         }
     }
 
@@ -1251,8 +1898,8 @@ namespace rocalution
         }
         else
         {
-            LOG_VERBOSE_INFO(
-                2, "*** warning: LocalVector::ExtractCoarseBoundary() is performed on the host");
+            double fallback_start
+                = _rocalution_host_fallback_begin("LocalVector::ExtractCoarseBoundary()", true);
 
             LocalVector<ValueType> vec_host;
             vec_host.CloneFrom(*this);
@@ -1260,6 +1907,9 @@ namespace rocalution
             vec_host.MoveToHost();
 
             vec_host.ExtractCoarseBoundary(start, end, index, nc, size, boundary);
+
+            _rocalution_host_fallback_end(
+                "LocalVector::ExtractCoarseBoundary()", fallback_start, host_fallback_bytes(*this));
         }
     }
 
@@ -1297,6 +1947,18 @@ namespace rocalution
         }
     }
 
+    template <typename ValueType>
+    void LocalVector<ValueType>::Unique(LocalVector<ValueType>* unique) const
+    {
+        log_debug(this, "LocalVector::Unique()", unique);
+
+        assert(unique != NULL);
+        assert(this != unique);
+        assert(this->is_host_() == unique->is_host_());
+
+        this->vector_->Unique(unique->vector_);
+    }
+
     template class LocalVector<bool>;
     template class LocalVector<double>;
     template class LocalVector<float>;
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -25,7 +25,9 @@
 #define ROCALUTION_LOCAL_VECTOR_HPP_
 
 #include "rocalution/export.hpp"
+#include "rocalution/utils/type_traits.hpp"
 #include "vector.hpp"
+#include "vector_expression.hpp"
 
 namespace rocalution
 {
@@ -42,6 +44,12 @@ namespace rocalution
 
     template <typename ValueType>
     class LocalStencil;
+    template <typename ValueType>
+    class LocalShellOperator;
+    template <typename ValueType>
+    class LocalMultiVector;
+    template <typename ValueType>
+    class LocalBatchMatrix;
 
     /** \ingroup op_vec_module
   * \class LocalVector
@@ -69,6 +77,10 @@ namespace rocalution
         /** \brief Move all data (i.e. move the vector) to the accelerator asynchronously */
         ROCALUTION_EXPORT
         virtual void MoveToAcceleratorAsync(void);
+        /** \brief Move all data (i.e. move the vector) to the device of an execution context
+        * and attach the vector to it. Data on another device is copied device to device. */
+        ROCALUTION_EXPORT
+        void MoveToAccelerator(const ExecutionContext& context);
         /** \brief Move all data (i.e. move the vector) to the host */
         ROCALUTION_EXPORT
         virtual void MoveToHost(void);
@@ -78,6 +90,12 @@ namespace rocalution
         /** \brief Synchronize the vector */
         ROCALUTION_EXPORT
         virtual void Sync(void);
+        /** \brief Migrate the vector data to the accelerator (managed memory mode) */
+        ROCALUTION_EXPORT
+        virtual void Prefetch(void) const;
+        /** \brief Attach the vector to an execution context */
+        ROCALUTION_EXPORT
+        virtual void SetExecutionContext(const ExecutionContext& context);
 
         /** \brief Shows simple info about the vector. */
         ROCALUTION_EXPORT
@@ -177,6 +195,30 @@ namespace rocalution
         ROCALUTION_EXPORT
         void LeaveDataPtr(ValueType** ptr);
 
+        /** \brief Use an externally allocated buffer in place
+      * \details
+      * \p AttachView makes the LocalVector operate directly on \p ptr, without copying
+      * the data and without taking its ownership. The buffer has to live on the current
+      * backend of the vector (host memory on the host, device memory on the
+      * accelerator) and must stay valid until the vector is cleared, reallocated or
+      * destroyed, which never frees it. Moving the vector to another backend creates an
+      * owned copy, and LeaveDataPtr() returns an owned copy of the data.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // Device buffer from an external assembly
+      *   ValueType* d_rhs = ...;
+      *
+      *   LocalVector<ValueType> rhs;
+      *   rhs.MoveToAccelerator();
+      *
+      *   // rhs reads and writes d_rhs directly
+      *   rhs.AttachView(d_rhs, "rhs", n);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void AttachView(ValueType* ptr, std::string name, int64_t size);
+
         /** \brief Clear (free) the vector */
         ROCALUTION_EXPORT
         virtual void Clear();
@@ -329,6 +371,22 @@ namespace rocalution
         ROCALUTION_EXPORT
         void CopyToHostData(ValueType* data) const;
 
+        /** \brief Extract the real equivalent of a complex vector
+      * \details
+      * \p vec is allocated on the backend of this vector with twice its size and holds
+      * the interleaved real and imaginary parts of the entries, see
+      * LocalMatrix::ExtractRealEquivalent(). Only available for complex value types.
+      */
+        ROCALUTION_EXPORT
+        void ExtractRealEquivalent(LocalVector<numeric_traits_t<ValueType>>* vec) const;
+        /** \brief Copy a complex vector from its real equivalent
+      * \details
+      * \p vec holds the interleaved real and imaginary parts, its size is twice the size
+      * of this vector and it has to be on the same backend, see ExtractRealEquivalent().
+      */
+        ROCALUTION_EXPORT
+        void CopyFromRealEquivalent(const LocalVector<numeric_traits_t<ValueType>>& vec);
+
         /** \brief Perform in-place permutation (forward) of the vector */
         ROCALUTION_EXPORT
         void Permute(const LocalVector<int>& permutation);
@@ -345,6 +403,25 @@ namespace rocalution
         ROCALUTION_EXPORT
         void Prolongation(const LocalVector<ValueType>& vec_coarse, const LocalVector<int>& map);
 
+        /** \brief Apply a sparse sign embedding (CountSketch) to the vector
+      * \details
+      * \p Sketch computes the \f$s\f$ entries
+      * \f$res_{k} = \sum_{map_{i} = 2k} this_{i} - \sum_{map_{i} = 2k+1} this_{i}\f$,
+      * where \f$s\f$ is half the size of \p work, i.e. each entry of the vector is
+      * hashed into one bucket with a random sign. Entries with a negative \p map value
+      * are ignored. The sketch is formed with a single pass over the vector, only the
+      * \f$2s\f$ bucket sums are transferred to the host.
+      *
+      * @param[in]
+      * map     hash map of size GetSize(), holding bucket * 2 + sign bit per entry.
+      * @param[inout]
+      * work    work vector of size \f$2s\f$, on the same backend as this vector.
+      * @param[out]
+      * res     host array of \f$s\f$ sketched values.
+      */
+        ROCALUTION_EXPORT
+        void Sketch(const LocalVector<int>& map, LocalVector<ValueType>* work, ValueType* res) const;
+
         /** \brief Perform scalar-vector multiplication and add it to another vector, this = this + alpha * x;
       * \par Example
       * \code{.cpp}
@@ -469,6 +546,22 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual ValueType Dot(const LocalVector<ValueType>& x) const;
 
+        /** \brief Perform dot product with a single precision vector (double and float
+      * only)
+      */
+        ROCALUTION_EXPORT
+        virtual ValueType DotFloat(const LocalVector<float>& x) const;
+        /** \brief Perform vector update of type this = this + alpha * x with a single
+      * precision vector x (double and float only)
+      */
+        ROCALUTION_EXPORT
+        virtual void AddScaleFloat(const LocalVector<float>& x, ValueType alpha);
+        /** \brief Scale vector, this = alpha * this, and store the result rounded to
+      * single precision in vec (double and float only)
+      */
+        ROCALUTION_EXPORT
+        virtual void ScaleCopyToFloat(ValueType alpha, LocalVector<float>* vec);
+
         /** \brief Perform dot product
       * \par Example
       * \code{.cpp}
@@ -489,6 +582,235 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual ValueType DotNonConj(const LocalVector<ValueType>& x) const;
 
+        /** \brief Perform multiple dot products with this vector at once
+      * \details
+      * \p MultiDot computes \f$res_{k} = x_{k}^{H} this\f$ for
+      * \f$k = 0, \dots, count-1\f$ in a single pass over this vector, i.e. the same
+      * as calling x[k]->Dot(*this) for each \p k.
+      *
+      * @param[in]
+      * count   number of dot products.
+      * @param[in]
+      * x       array of \p count vectors.
+      * @param[out]
+      * res     array of \p count dot products.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // Project w onto the basis v[0], ..., v[k-1]
+      *   w.MultiDot(k, v, h);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void MultiDot(int count, const LocalVector<ValueType>* const* x, ValueType* res) const;
+
+        /** \brief Perform multiple vector updates at once
+      * \details
+      * \p MultiAddScale computes \f$this = this + \sum_{k=0}^{count-1} alpha_{k} x_{k}\f$
+      * in a single pass over this vector, i.e. the same as calling
+      * AddScale(*x[k], alpha[k]) for each \p k.
+      *
+      * @param[in]
+      * count   number of vectors.
+      * @param[in]
+      * x       array of \p count vectors.
+      * @param[in]
+      * alpha   array of \p count scalars.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // Add the linear combination of the basis v[0], ..., v[k-1]
+      *   w.MultiAddScale(k, v, h);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void MultiAddScale(int                                  count,
+                           const LocalVector<ValueType>* const* x,
+                           const ValueType*                     alpha);
+
+        /** \brief Perform multiple non conjugate dot products at once
+      * \details
+      * \p DotNonConjAsync computes \f$res_{i} = x_{i}^{T} y_{i}\f$ for
+      * \f$i = 0, \dots, n-1\f$. The interface is shared with GlobalVector, where
+      * all global reductions are merged into a single non-blocking collective. For
+      * LocalVector, the results are available on return. DotSync() must be called
+      * before \p res is accessed.
+      *
+      * @param[in]
+      * n       number of dot products.
+      * @param[in]
+      * x       array of \p n vectors.
+      * @param[in]
+      * y       array of \p n vectors.
+      * @param[out]
+      * res     array of \p n dot products.
+      */
+        ROCALUTION_EXPORT
+        void DotNonConjAsync(int                                n,
+                             const LocalVector<ValueType>* const* x,
+                             const LocalVector<ValueType>* const* y,
+                             ValueType*                          res) const;
+        /** \brief Perform multiple dot products at once
+      * \details
+      * \p DotAsync computes \f$res_{i} = x_{i}^{H} y_{i}\f$ for \f$i = 0, \dots, n-1\f$,
+      * with the same interface and completion semantics as DotNonConjAsync().
+      */
+        ROCALUTION_EXPORT
+        void DotAsync(int                                  n,
+                      const LocalVector<ValueType>* const* x,
+                      const LocalVector<ValueType>* const* y,
+                      ValueType*                           res) const;
+        /** \brief Wait for the dot products started by DotNonConjAsync() or DotAsync() to
+      * complete */
+        ROCALUTION_EXPORT
+        void DotSync(void) const;
+
+        /** \brief Perform vector update and dot product in a single pass
+      * \details
+      * \p AddScaleDot computes \f$this = this + \alpha x\f$ and returns
+      * \f$this^{H} y\f$ with the updated vector, reading and writing this vector only
+      * once. \p y may be this vector.
+      *
+      * @param[in]
+      * x       vector to be added.
+      * @param[in]
+      * alpha   scaling factor of \p x.
+      * @param[in]
+      * y       vector for the dot product.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // r = r - alpha * q and rho = (r, z)
+      *   rho = r.AddScaleDot(q, -alpha, z);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        ValueType AddScaleDot(const LocalVector<ValueType>& x,
+                              ValueType                     alpha,
+                              const LocalVector<ValueType>& y);
+        /** \brief Evaluate a lazy vector expression
+      * \details
+      * Assigning a VectorExpression evaluates it element-wise in a single fused pass over
+      * its vectors, without temporaries. This vector may be part of the expression.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // x = a * y + b * z - c * w
+      *   x = a * y + b * z - c * w;
+      * \endcode
+      */
+        template <class Expr>
+        LocalVector<ValueType>& operator=(const VectorExpression<Expr>& expr)
+        {
+            static_assert(std::is_same<typename Expr::vector_type, LocalVector<ValueType>>::value,
+                          "The expression has to consist of LocalVector<ValueType> objects");
+
+            VectorExpressionBuilder<LocalVector<ValueType>, ValueType> builder;
+            expr.Self().Compile(&builder);
+
+            this->Evaluate(builder.program, builder.vec);
+
+            return *this;
+        }
+
+        /** \brief Evaluate an expression program over the vectors vec into this vector,
+      * see VectorExpression */
+        ROCALUTION_EXPORT
+        void Evaluate(const VectorExpressionProgram<ValueType>& program,
+                      const LocalVector<ValueType>* const*      vec);
+        /** \brief Return the sum of the elements of an expression program over the vectors
+      * vec, evaluated on the backend of this vector, see Sum() */
+        ROCALUTION_EXPORT
+        ValueType EvaluateSum(const VectorExpressionProgram<ValueType>& program,
+                              const LocalVector<ValueType>* const*      vec) const;
+
+        /** \brief Perform vector update and compute the L2 norm in a single pass
+      * \details
+      * \p AddScaleNorm computes \f$this = this + \alpha x\f$ and returns
+      * \f$\|this\|_{2}\f$ of the updated vector.
+      */
+        ROCALUTION_EXPORT
+        ValueType AddScaleNorm(const LocalVector<ValueType>& x, ValueType alpha);
+        /** \brief Perform two dot products with this vector in a single pass
+      * \details
+      * \p DualDot computes \f$res_{0} = this^{H} x\f$ and \f$res_{1} = this^{H} y\f$,
+      * i.e. the same as Dot(x) and Dot(y). \p x or \p y may be this vector.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // (t, r) and (t, t)
+      *   t.DualDot(r, t, res);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void DualDot(const LocalVector<ValueType>& x,
+                     const LocalVector<ValueType>& y,
+                     ValueType*                    res) const;
+
+        /** \brief Compute a dot product into a vector of scalars
+      * \details
+      * \p DotToScalar computes \f$res_{index} = this^{H} x\f$ and
+      * \p DotNonConjToScalar computes \f$res_{index} = this^{T} x\f$. The result stays
+      * on the backend of \p res, which must be the backend of this vector. On the
+      * accelerator, no synchronization with the host is required, such that the
+      * scalar can be consumed by AddScaleRatio() or ScaleRatioAdd() without stalling
+      * the stream.
+      *
+      * @param[in]
+      * x       vector for the dot product.
+      * @param[out]
+      * res     vector of scalars that holds the result.
+      * @param[in]
+      * index   position of the result in \p res.
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // s[0] = (r, z), s[1] = (p, q), x = x + s[0] / s[1] * p
+      *   r.DotToScalar(z, &s, 0);
+      *   p.DotToScalar(q, &s, 1);
+      *   x.AddScaleRatio(p, 1.0, s, 0, 1);
+      * \endcode
+      */
+        ROCALUTION_EXPORT
+        void DotToScalar(const LocalVector<ValueType>& x,
+                         LocalVector<ValueType>*       res,
+                         int64_t                       index) const;
+        /** \brief Compute a non conjugate dot product into a vector of scalars */
+        ROCALUTION_EXPORT
+        void DotNonConjToScalar(const LocalVector<ValueType>& x,
+                                LocalVector<ValueType>*       res,
+                                int64_t                       index) const;
+        /** \brief Compute the L2 norm into a vector of scalars
+      * \details
+      * \p NormToScalar computes \f$res_{index} = \|this\|_{2}\f$, see DotToScalar().
+      */
+        ROCALUTION_EXPORT
+        void NormToScalar(LocalVector<ValueType>* res, int64_t index) const;
+        /** \brief Perform vector update with a ratio of scalars
+      * \details
+      * \p AddScaleRatio computes
+      * \f$this = this + factor \cdot \frac{s_{num}}{s_{den}} x\f$, where \f$s\f$ is
+      * a vector of scalars on the backend of this vector, e.g. filled by
+      * DotToScalar().
+      */
+        ROCALUTION_EXPORT
+        void AddScaleRatio(const LocalVector<ValueType>& x,
+                           ValueType                     factor,
+                           const LocalVector<ValueType>& scalars,
+                           int64_t                       num,
+                           int64_t                       den);
+        /** \brief Perform vector scaling with a ratio of scalars and addition
+      * \details
+      * \p ScaleRatioAdd computes \f$this = \frac{s_{num}}{s_{den}} this + x\f$, where
+      * \f$s\f$ is a vector of scalars on the backend of this vector, e.g. filled by
+      * DotToScalar().
+      */
+        ROCALUTION_EXPORT
+        void ScaleRatioAdd(const LocalVector<ValueType>& scalars,
+                           int64_t                       num,
+                           int64_t                       den,
+                           const LocalVector<ValueType>& x);
+
         /** \brief Compute L2 (Euclidean) norm of vector
       * \par Example
       * \code{.cpp}
@@ -649,6 +971,9 @@ namespace rocalution
         /** \brief Get indexed values */
         ROCALUTION_EXPORT
         void GetIndexValues(const LocalVector<int>& index, LocalVector<ValueType>* values) const;
+        /** \brief Get indexed values, rounded to single precision (double and float only) */
+        ROCALUTION_EXPORT
+        void GetIndexValuesFloat(const LocalVector<int>& index, LocalVector<float>* values) const;
         /** \brief Set indexed values */
         ROCALUTION_EXPORT
         void SetIndexValues(const LocalVector<int>& index, const LocalVector<ValueType>& values);
@@ -673,6 +998,14 @@ namespace rocalution
         /** \brief Out-of-place radix sort that can also obtain the permutation */
         ROCALUTION_EXPORT
         void Sort(LocalVector<ValueType>* sorted, LocalVector<int>* perm = NULL) const;
+        /** \brief Remove consecutive duplicates
+        * \details
+        * \p Unique writes the vector without consecutive duplicate entries into
+        * \p unique, which is resized to the number of remaining entries. Applied to a
+        * sorted vector, \p unique holds the distinct entries in ascending order.
+        */
+        ROCALUTION_EXPORT
+        void Unique(LocalVector<ValueType>* unique) const;
 
     protected:
         /** \brief Return true if the object is on the host */
@@ -713,9 +1046,16 @@ namespace rocalution
         friend class LocalStencil<std::complex<double>>;
         friend class LocalStencil<std::complex<float>>;
 
+        friend class LocalShellOperator<double>;
+        friend class LocalShellOperator<float>;
+        friend class LocalShellOperator<std::complex<double>>;
+        friend class LocalShellOperator<std::complex<float>>;
+
         friend class GlobalVector<ValueType>;
         friend class LocalMatrix<ValueType>;
         friend class GlobalMatrix<ValueType>;
+        friend class LocalMultiVector<ValueType>;
+        friend class LocalBatchMatrix<ValueType>;
     };
 
 } // namespace rocalution
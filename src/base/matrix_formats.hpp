@@ -29,9 +29,12 @@
 namespace rocalution
 {
 
+    // Number of matrix formats
+    const int _matrix_format_count = 10;
+
     // Matrix Names
-    const std::string _matrix_format_names[8]
-        = {"DENSE", "CSR", "MCSR", "BCSR", "COO", "DIA", "ELL", "HYB"};
+    const std::string _matrix_format_names[_matrix_format_count]
+        = {"DENSE", "CSR", "MCSR", "BCSR", "COO", "DIA", "ELL", "HYB", "SELL", "VBR"};
 
     // Matrix Enumeration
     enum _matrix_format
@@ -43,7 +46,113 @@ namespace rocalution
         COO   = 4,
         DIA   = 5,
         ELL   = 6,
-        HYB   = 7
+        HYB   = 7,
+        SELL  = 8,
+        VBR   = 9
+    };
+
+    // SELL-C-sigma slice size C and sorting scope sigma (multiple of C)
+    const int _sell_slice_size = 32;
+    const int _sell_sigma      = 256;
+
+    // Maximum number of rows of a VBR block row
+    const int _vbr_max_blockdim = 16;
+
+    /*! \brief CSR matrix-vector product algorithms
+     *  \details
+     *  This is a list of algorithms for the CSR matrix-vector product on the
+     *  accelerator, see LocalMatrix::SetSpMVAlg()
+     */
+    typedef enum _spmv_alg : unsigned int
+    {
+        SpMVAlg_Auto     = 0, /**< Select from the row length distribution. */
+        SpMVAlg_Adaptive = 1, /**< Adaptive row blocks, requires an analysis. */
+        SpMVAlg_Stream   = 2, /**< Rows split over the threads, no analysis. */
+        SpMVAlg_LRB      = 3, /**< Logarithmic row binning, balances very long rows. */
+        SpMVAlg_RowList  = 4, /**< Doubly compressed, only the non-empty rows are
+                                   processed, for hyper-sparse matrices. */
+    } SpMVAlg;
+
+    /*! \brief CSR matrix-vector product value storage
+     *  \details
+     *  This is a list of precisions in which the values of a CSR matrix are read by the
+     *  matrix-vector product on the accelerator, see LocalMatrix::SetSpMVStorage()
+     */
+    typedef enum _spmv_storage : unsigned int
+    {
+        SpMVStorage_Full     = 0, /**< Values in the precision of the matrix. */
+        SpMVStorage_Float    = 1, /**< Values rounded to float, accumulated in double. */
+        SpMVStorage_Half     = 2, /**< Values rounded to half, accumulated in the matrix
+                                       precision (float or double). */
+        SpMVStorage_BFloat16 = 3, /**< Values rounded to bfloat16, accumulated in the matrix
+                                       precision (float or double). */
+    } SpMVStorage;
+
+    /*! \brief CSR matrix-vector product column index storage
+     *  \details
+     *  This is a list of storages of the column indices read by the CSR matrix-vector
+     *  product, see LocalMatrix::SetSpMVIndex()
+     */
+    typedef enum _spmv_index : unsigned int
+    {
+        SpMVIndex_Full       = 0, /**< 32 bit column indices. */
+        SpMVIndex_Compressed = 1, /**< Base column per row and 8 or 16 bit offsets, rows
+                                       whose column span exceeds them keep 32 bits. */
+    } SpMVIndex;
+
+    /*! \brief Sparsity pattern analysis for the matrix format selection
+     *  \details
+     *  Filled by LocalMatrix::AnalyzeFormats(). The predictions are indexed by the matrix
+     *  format ID and are -1 for formats the matrix cannot be converted to, e.g. DIA with
+     *  too many diagonals. The SpMV traffic is the size of the matrix in a format plus a
+     *  read of the input and a write of the output vector, which ranks the formats for
+     *  the memory bound matrix-vector product.
+     */
+    struct MatrixFormatAnalysis
+    {
+        /** BCSR block dimension with the least fill-in, 1 if none fits. */
+        int blockdim;
+        /** Number of non-zero blocks of BCSR with \p blockdim. */
+        int64_t nnzb;
+        /** Number of distinct diagonals. */
+        int64_t num_diag;
+        /** Length of the longest row. */
+        int64_t max_row;
+        /** Stored ELL entries relative to the number of non-zeros. */
+        double ell_fill;
+        /** Stored DIA entries relative to the number of non-zeros. */
+        double dia_fill;
+        /** Stored BCSR entries relative to the number of non-zeros. */
+        double bcsr_fill;
+        /** Size of the matrix per format. */
+        int64_t format_bytes[_matrix_format_count];
+        /** Traffic of one SpMV per format. */
+        int64_t spmv_bytes[_matrix_format_count];
+    };
+
+    /*! \brief Statistics of a matrix
+     *  \details
+     *  Filled by LocalMatrix::Statistics(), see there.
+     */
+    struct MatrixStatistics
+    {
+        /** Length of the shortest row. */
+        int64_t min_row;
+        /** Length of the longest row. */
+        int64_t max_row;
+        /** Mean row length. */
+        double mean_row;
+        /** Variance of the row lengths. */
+        double var_row;
+        /** Largest distance \f$|i - j|\f$ of a non-zero \f$a_{ij}\f$ from the diagonal. */
+        int64_t bandwidth;
+        /** Profile (envelope size), the sum of the distances of the first non-zero of each
+         *  row left of the diagonal to the diagonal. */
+        int64_t profile;
+        /** Fraction of the rows with \f$|a_{ii}| \geq \sum_{j \neq i} |a_{ij}|\f$. */
+        double diag_dominance;
+        /** True, if \f$a_{ij} = a_{ji}\f$ holds for all non-zeros (pattern and values). */
+        bool symmetric;
     };
 
     // Sparse Matrix - Sparse Compressed Row Format CSR
@@ -139,6 +248,61 @@ namespace rocalution
         ValueType* val;
     };
 
+    // Sparse Matrix - Sliced ELL Format SELL-C-sigma (see SELL_IND for indexing)
+    // Rows are sorted by their length within windows of sigma rows and grouped into
+    // slices of C rows. Each slice is stored in ELL format, padded to its longest row.
+    template <typename ValueType, typename IndexType, typename PointerType = IndexType>
+    struct MatrixSELL
+    {
+        // Number of rows per slice
+        IndexType slice_size;
+        // Number of slices
+        IndexType nslice;
+
+        // Slice offsets (slice ptr)
+        PointerType* slice_offset;
+
+        // Original row index of each sorted row
+        IndexType* perm;
+
+        // Column index
+        IndexType* col;
+
+        // Values
+        ValueType* val;
+    };
+
+    // Sparse Matrix - Variable Block Row Format VBR (see VBR_IND for indexing)
+    // Rows and columns are partitioned into blocks of varying size (e.g. the degrees of
+    // freedom of the nodes). The non-zero blocks are stored densely in column-major order.
+    template <typename ValueType, typename IndexType, typename PointerType = IndexType>
+    struct MatrixVBR
+    {
+        // Number of block rows
+        IndexType nrowb;
+        // Number of block columns
+        IndexType ncolb;
+        // Number of non-zero blocks
+        int64_t nnzb;
+
+        // First row of each block row (nrowb + 1)
+        IndexType* row_block;
+        // First column of each block column (ncolb + 1)
+        IndexType* col_block;
+
+        // Block row offsets (block row ptr)
+        PointerType* row_offset;
+
+        // Block column index
+        IndexType* col;
+
+        // Offset of each block into the values (nnzb + 1)
+        PointerType* val_offset;
+
+        // Values
+        ValueType* val;
+    };
+
     // Sparse Matrix - Hybrid Format HYB (Contains ELL and COO Matrices)
     template <typename ValueType, typename IndexType, typename Index = IndexType>
     struct MatrixHYB
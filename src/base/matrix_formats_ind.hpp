@@ -39,6 +39,12 @@
 #define ELL_IND_EL(row, el, nrow, max_row) (el) + (max_row) * (row)
 #define ELL_IND(row, el, nrow, max_row) ELL_IND_ROW(row, el, nrow, max_row)
 
+// SELL indexing (row within the slice)
+#define SELL_IND(offset, row, el, slice_size) ((offset) + (el) * (slice_size) + (row))
+
+// VBR indexing (column-major block with rbs rows)
+#define VBR_IND(offset, bi, bj, rbs) ((offset) + (bi) + (bj) * (rbs))
+
 // DIA indexing
 #define DIA_IND_ROW(row, el, nrow, ndiag) (el) * (nrow) + (row)
 #define DIA_IND_EL(row, el, nrow, ndiag) (el) + (ndiag) * (row)
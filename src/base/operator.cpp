@@ -146,6 +146,29 @@ namespace rocalution
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
+    template <typename ValueType>
+    void Operator<ValueType>::Apply(const LocalMultiVector<ValueType>& in,
+                                    LocalMultiVector<ValueType>*       out) const
+    {
+        LOG_INFO("Operator<ValueType>::Apply(const LocalMultiVector<ValueType>& in, "
+                 "LocalMultiVector<ValueType>* out)");
+        LOG_INFO("Multi-vector products are not available for this operator");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void Operator<ValueType>::ApplyAdd(const LocalMultiVector<ValueType>& in,
+                                       ValueType                          scalar,
+                                       LocalMultiVector<ValueType>*       out) const
+    {
+        LOG_INFO("Operator<ValueType>::ApplyAdd(const LocalMultiVector<ValueType>& in, "
+                 "ValueType scalar, LocalMultiVector<ValueType>* out)");
+        LOG_INFO("Multi-vector products are not available for this operator");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
     template class Operator<double>;
     template class Operator<float>;
 #ifdef SUPPORT_COMPLEX
@@ -38,6 +38,8 @@ namespace rocalution
     class GlobalVector;
     template <typename ValueType>
     class LocalVector;
+    template <typename ValueType>
+    class LocalMultiVector;
 
     /** \ingroup op_vec_module
   * \class Operator
@@ -116,6 +118,22 @@ namespace rocalution
         virtual void ApplyAdd(const GlobalVector<ValueType>& in,
                               ValueType                      scalar,
                               GlobalVector<ValueType>*       out) const;
+
+        /** \brief Apply the operator to all columns of a block, out = Operator(in)
+        * \details
+        * Implemented by LocalMatrix, where the matrix is read once for the whole block.
+        */
+        ROCALUTION_EXPORT
+        virtual void Apply(const LocalMultiVector<ValueType>& in,
+                           LocalMultiVector<ValueType>*       out) const;
+
+        /** \brief Apply and add the operator to all columns of a block,
+        * out += scalar * Operator(in)
+        */
+        ROCALUTION_EXPORT
+        virtual void ApplyAdd(const LocalMultiVector<ValueType>& in,
+                              ValueType                          scalar,
+                              LocalMultiVector<ValueType>*       out) const;
     };
 
 } // namespace rocalution
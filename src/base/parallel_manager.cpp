@@ -30,9 +30,14 @@
 #include "../utils/log.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <limits>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #ifdef SUPPORT_MULTINODE
@@ -42,6 +47,51 @@
 
 namespace rocalution
 {
+    struct ProgressThread
+    {
+        std::thread             thread;
+        std::mutex              mutex;
+        std::condition_variable cv;
+
+        // Set while an exchange is in flight
+        bool active;
+        // Set to terminate the thread
+        bool quit;
+        // Cleared to stop polling, the thread then resets active
+        std::atomic<bool> polling;
+        // Started by the owning thread and not yet stopped
+        bool running;
+    };
+
+#ifdef SUPPORT_MULTINODE
+    static void progress_loop(ProgressThread* pt, const void* comm)
+    {
+        std::unique_lock<std::mutex> lock(pt->mutex);
+
+        while(true)
+        {
+            pt->cv.wait(lock, [pt] { return pt->active || pt->quit; });
+
+            if(pt->quit == true)
+            {
+                return;
+            }
+
+            lock.unlock();
+
+            while(pt->polling.load(std::memory_order_acquire) == true)
+            {
+                communication_progress(comm);
+                std::this_thread::yield();
+            }
+
+            lock.lock();
+
+            pt->active = false;
+            pt->cv.notify_all();
+        }
+    }
+#endif
 
     ParallelManager::ParallelManager()
     {
@@ -82,12 +132,24 @@ namespace rocalution
         this->recv_event_ = NULL;
         this->send_event_ = NULL;
 
+        this->async_persistent_ = -1;
+
+        this->neighbor_collectives_ = false;
+        this->neighbor_comm_        = NULL;
+
+        this->progress_ = NULL;
+
+        this->exchange_count_ = 0;
+        this->exchange_time_  = 0.0;
+        this->exchange_start_ = -1.0;
+
         // if new values are added, also put check into status function
     }
 
     ParallelManager::~ParallelManager()
     {
         this->Clear();
+        this->FreeProgress_();
 
         free_host(&this->global_row_offset_);
         free_host(&this->global_col_offset_);
@@ -130,6 +192,9 @@ namespace rocalution
         free_host(&this->sends_);
         free_host(&this->send_offset_index_);
 
+        this->FreePersistent_();
+        this->FreeNeighborComm_();
+
 #ifdef SUPPORT_MULTINODE
         free_host(&this->recv_event_);
         free_host(&this->send_event_);
@@ -359,6 +424,10 @@ namespace rocalution
             assert(recvs != NULL);
         }
 
+        // Communication pattern changes, cached requests become invalid
+        this->FreePersistent_();
+        this->FreeNeighborComm_();
+
         this->nrecv_ = nrecv;
 
         allocate_host(nrecv, &this->recvs_);
@@ -391,6 +460,10 @@ namespace rocalution
             assert(sends != NULL);
         }
 
+        // Communication pattern changes, cached requests become invalid
+        this->FreePersistent_();
+        this->FreeNeighborComm_();
+
         this->nsend_ = nsend;
 
         allocate_host(nsend, &this->sends_);
@@ -415,6 +488,207 @@ namespace rocalution
 #endif
     }
 
+    void ParallelManager::SetNeighborCollectives(bool enable)
+    {
+        log_debug(this, "ParallelManager::SetNeighborCollectives()", enable);
+
+        this->neighbor_collectives_ = enable;
+    }
+
+    void ParallelManager::SetProgressThread(bool enable)
+    {
+        log_debug(this, "ParallelManager::SetProgressThread()", enable);
+
+        if(enable == false)
+        {
+            this->FreeProgress_();
+
+            return;
+        }
+
+        if(this->progress_ != NULL)
+        {
+            return;
+        }
+
+#ifdef SUPPORT_MULTINODE
+        assert(this->comm_ != NULL);
+
+        if(communication_thread_multiple() == false)
+        {
+            LOG_INFO("*** warning: ParallelManager::SetProgressThread() requires MPI to be "
+                     "initialized with MPI_THREAD_MULTIPLE, no progress thread is used");
+
+            return;
+        }
+
+        this->progress_ = new ProgressThread;
+
+        this->progress_->active  = false;
+        this->progress_->quit    = false;
+        this->progress_->running = false;
+        this->progress_->polling.store(false);
+
+        this->progress_->thread = std::thread(progress_loop, this->progress_, this->comm_);
+#endif
+    }
+
+    void ParallelManager::StartProgress_(void) const
+    {
+        if(this->progress_ == NULL || this->progress_->running == true)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->progress_->mutex);
+
+            this->progress_->polling.store(true, std::memory_order_release);
+            this->progress_->active = true;
+        }
+
+        this->progress_->cv.notify_all();
+        this->progress_->running = true;
+    }
+
+    void ParallelManager::StopProgress_(void) const
+    {
+        if(this->progress_ == NULL || this->progress_->running == false)
+        {
+            return;
+        }
+
+        // Wait until the thread has left the MPI library, before the requests are completed
+        this->progress_->polling.store(false, std::memory_order_release);
+
+        std::unique_lock<std::mutex> lock(this->progress_->mutex);
+        this->progress_->cv.wait(lock, [this] { return this->progress_->active == false; });
+
+        this->progress_->running = false;
+    }
+
+    void ParallelManager::FreeProgress_(void)
+    {
+        if(this->progress_ == NULL)
+        {
+            return;
+        }
+
+        this->StopProgress_();
+
+        {
+            std::lock_guard<std::mutex> lock(this->progress_->mutex);
+            this->progress_->quit = true;
+        }
+
+        this->progress_->cv.notify_all();
+        this->progress_->thread.join();
+
+        delete this->progress_;
+        this->progress_ = NULL;
+    }
+
+    void ParallelManager::ResetCommunicationStats(void)
+    {
+        log_debug(this, "ParallelManager::ResetCommunicationStats()");
+
+        this->exchange_count_ = 0;
+        this->exchange_time_  = 0.0;
+    }
+
+    void ParallelManager::CommunicationInfo(int value_size) const
+    {
+        log_debug(this, "ParallelManager::CommunicationInfo()", value_size);
+
+        assert(this->Status());
+        assert(value_size > 0);
+
+        // Message size histogram, bins are bounded by 1 KiB, 4 KiB, ..., 1 MiB
+        const int nbins = 7;
+        double    hist[nbins]        = {};
+        double    global_hist[nbins] = {};
+
+        double max_message = 0.0;
+
+        for(int n = 0; n < this->nsend_; ++n)
+        {
+            double bytes = static_cast<double>(value_size)
+                           * (this->send_offset_index_[n + 1] - this->send_offset_index_[n]);
+
+            int bin = 0;
+            for(double bound = 1024.0; bin < nbins - 1 && bytes >= bound; bound *= 4.0)
+            {
+                ++bin;
+            }
+
+            ++hist[bin];
+            max_message = std::max(max_message, bytes);
+        }
+
+        // Local statistics of this rank
+        const int   nstats = 6;
+        const char* names[nstats] = {"send neighbors",
+                                     "recv neighbors",
+                                     "send bytes",
+                                     "recv bytes",
+                                     "max message bytes",
+                                     "time per exchange [s]"};
+
+        double local[nstats];
+        local[0] = this->nsend_;
+        local[1] = this->nrecv_;
+        local[2] = static_cast<double>(value_size) * this->send_index_size_;
+        local[3] = static_cast<double>(value_size) * this->recv_index_size_;
+        local[4] = max_message;
+        local[5] = this->exchange_count_ > 0 ? this->exchange_time_ / this->exchange_count_ : 0.0;
+
+        double stat_min[nstats];
+        double stat_max[nstats];
+        double stat_sum[nstats];
+
+#ifdef SUPPORT_MULTINODE
+        for(int i = 0; i < nstats; ++i)
+        {
+            double neg = -local[i];
+
+            communication_sync_allreduce_single_max(&local[i], &stat_max[i], this->comm_);
+            communication_sync_allreduce_single_max(&neg, &stat_min[i], this->comm_);
+            communication_sync_allreduce_single_sum(&local[i], &stat_sum[i], this->comm_);
+
+            stat_min[i] = -stat_min[i];
+        }
+
+        communication_sync_allreduce_sum(hist, global_hist, nbins, this->comm_);
+#else
+        for(int i = 0; i < nstats; ++i)
+        {
+            stat_min[i] = stat_max[i] = stat_sum[i] = local[i];
+        }
+
+        std::copy(hist, hist + nbins, global_hist);
+#endif
+
+        LOG_INFO("ParallelManager communication statistics (min / avg / max over "
+                 << this->num_procs_ << " ranks)");
+
+        for(int i = 0; i < nstats; ++i)
+        {
+            LOG_INFO("  " << names[i] << ": " << stat_min[i] << " / "
+                          << stat_sum[i] / this->num_procs_ << " / " << stat_max[i]);
+        }
+
+        const char* bins[nbins]
+            = {"<1KiB", "<4KiB", "<16KiB", "<64KiB", "<256KiB", "<1MiB", ">=1MiB"};
+
+        std::ostringstream histogram;
+        for(int i = 0; i < nbins; ++i)
+        {
+            histogram << " " << bins[i] << "=" << global_hist[i] << ";";
+        }
+
+        LOG_INFO("  message size histogram:" << histogram.str());
+    }
+
     bool ParallelManager::Status(void) const
     {
         // clang-format off
@@ -709,21 +983,148 @@ namespace rocalution
         LOG_INFO("ReadFileASCII: filename=" << filename << "; done");
     }
 
+    // Wall clock time in seconds, the accelerator is not synchronized
+    static double exchange_clock(void)
+    {
+        return std::chrono::duration<double>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
     void ParallelManager::Synchronize_(void) const
     {
 #ifdef SUPPORT_MULTINODE
+        // The requests are completed by this thread only
+        this->StopProgress_();
+
         // Sync all events
         communication_syncall(this->async_recv_, this->recv_event_);
         communication_syncall(this->async_send_, this->send_event_);
 
+        // Sync persistent events, the requests become inactive and can be restarted
+        if(this->async_persistent_ >= 0)
+        {
+            const PersistentExchange& ex = this->persistent_[this->async_persistent_];
+
+            communication_syncall(ex.nrecv, ex.recv_event);
+            communication_syncall(ex.nsend, ex.send_event);
+        }
+
         // Reset guard
-        this->async_recv_ = 0;
-        this->async_send_ = 0;
+        this->async_recv_       = 0;
+        this->async_send_       = 0;
+        this->async_persistent_ = -1;
 #endif
+
+        // Boundary exchange statistics
+        if(this->exchange_start_ >= 0.0)
+        {
+            this->exchange_time_ += exchange_clock() - this->exchange_start_;
+            ++this->exchange_count_;
+
+            this->exchange_start_ = -1.0;
+        }
+    }
+
+    void ParallelManager::FreePersistent_(void) const
+    {
+        assert(this->async_persistent_ < 0);
+
+        for(size_t i = 0; i < this->persistent_.size(); ++i)
+        {
+#ifdef SUPPORT_MULTINODE
+            communication_request_freeall(this->persistent_[i].nrecv,
+                                          this->persistent_[i].recv_event);
+            communication_request_freeall(this->persistent_[i].nsend,
+                                          this->persistent_[i].send_event);
+
+            free_host(&this->persistent_[i].recv_event);
+            free_host(&this->persistent_[i].send_event);
+#endif
+        }
+
+        this->persistent_.clear();
+    }
+
+    void ParallelManager::FreePersistent_(const void* send_buffer, const void* recv_buffer) const
+    {
+        assert(this->async_persistent_ < 0);
+
+        size_t keep = 0;
+
+        for(size_t i = 0; i < this->persistent_.size(); ++i)
+        {
+            PersistentExchange& ex = this->persistent_[i];
+
+            if(ex.send_buffer != send_buffer && ex.recv_buffer != recv_buffer)
+            {
+                this->persistent_[keep++] = ex;
+                continue;
+            }
+
+#ifdef SUPPORT_MULTINODE
+            communication_request_freeall(ex.nrecv, ex.recv_event);
+            communication_request_freeall(ex.nsend, ex.send_event);
+
+            free_host(&ex.recv_event);
+            free_host(&ex.send_event);
+#endif
+        }
+
+        this->persistent_.resize(keep);
+    }
+
+    void ParallelManager::CreateNeighborComm_(void) const
+    {
+        assert(this->neighbor_comm_ == NULL);
+
+        this->neighbor_recv_count_.resize(this->nrecv_);
+        this->neighbor_send_count_.resize(this->nsend_);
+
+        for(int n = 0; n < this->nrecv_; ++n)
+        {
+            this->neighbor_recv_count_[n]
+                = this->recv_offset_index_[n + 1] - this->recv_offset_index_[n];
+        }
+
+        for(int n = 0; n < this->nsend_; ++n)
+        {
+            this->neighbor_send_count_[n]
+                = this->send_offset_index_[n + 1] - this->send_offset_index_[n];
+        }
+
+#ifdef SUPPORT_MULTINODE
+        allocate_host(1, &this->neighbor_comm_);
+
+        communication_neighbor_comm_create(this->nrecv_,
+                                           this->recvs_,
+                                           this->nsend_,
+                                           this->sends_,
+                                           this->neighbor_comm_,
+                                           this->comm_);
+#endif
+    }
+
+    void ParallelManager::FreeNeighborComm_(void) const
+    {
+        assert(this->async_recv_ == 0);
+
+        if(this->neighbor_comm_ != NULL)
+        {
+#ifdef SUPPORT_MULTINODE
+            communication_neighbor_comm_free(this->neighbor_comm_);
+            free_host(&this->neighbor_comm_);
+#endif
+        }
+
+        this->neighbor_recv_count_.clear();
+        this->neighbor_send_count_.clear();
     }
 
     template <typename ValueType>
-    void ParallelManager::CommunicateAsync_(ValueType* send_buffer, ValueType* recv_buffer) const
+    void ParallelManager::CommunicateAsync_(ValueType* send_buffer,
+                                            ValueType* recv_buffer,
+                                            const int* send_offset) const
     {
         log_debug(
             this, "ParallelManager::CommunicateAsync_()", "#*# begin", send_buffer, recv_buffer);
@@ -734,6 +1135,43 @@ namespace rocalution
 
         int tag = 0;
 
+        if(send_offset == NULL)
+        {
+            send_offset = this->send_offset_index_;
+        }
+
+        if(this->exchange_start_ < 0.0)
+        {
+            this->exchange_start_ = exchange_clock();
+        }
+
+        // Exchange with all neighbors at once. A single process has no communication
+        // pattern, and thus no request to wait for
+        if(this->neighbor_collectives_ == true && this->num_procs_ > 1)
+        {
+            if(this->neighbor_comm_ == NULL)
+            {
+                this->CreateNeighborComm_();
+            }
+
+#ifdef SUPPORT_MULTINODE
+            communication_async_neighbor_alltoallv(send_buffer,
+                                                   this->neighbor_send_count_.data(),
+                                                   send_offset,
+                                                   recv_buffer,
+                                                   this->neighbor_recv_count_.data(),
+                                                   this->recv_offset_index_,
+                                                   &this->recv_event_[this->async_recv_++],
+                                                   this->neighbor_comm_);
+#endif
+
+            this->StartProgress_();
+
+            log_debug(this, "ParallelManager::CommunicateAsync_()", "#*# end");
+
+            return;
+        }
+
         // async recv boundary from neighbors
         for(int n = 0; n < this->nrecv_; ++n)
         {
@@ -768,7 +1206,7 @@ namespace rocalution
                 assert(send_buffer != NULL);
 
 #ifdef SUPPORT_MULTINODE
-                communication_async_send(send_buffer + this->send_offset_index_[n],
+                communication_async_send(send_buffer + send_offset[n],
                                          nnz,
                                          this->sends_[n],
                                          tag,
@@ -778,6 +1216,8 @@ namespace rocalution
             }
         }
 
+        this->StartProgress_();
+
         log_debug(this, "ParallelManager::CommunicateAsync_()", "#*# end");
     }
 
@@ -786,6 +1226,140 @@ namespace rocalution
         this->Synchronize_();
     }
 
+    template <typename ValueType>
+    void ParallelManager::CommunicatePersistentAsync_(ValueType* send_buffer,
+                                                      ValueType* recv_buffer) const
+    {
+        log_debug(this,
+                  "ParallelManager::CommunicatePersistentAsync_()",
+                  "#*# begin",
+                  send_buffer,
+                  recv_buffer);
+
+        assert(this->async_send_ == 0);
+        assert(this->async_recv_ == 0);
+        assert(this->async_persistent_ < 0);
+        assert(this->Status());
+
+        this->exchange_start_ = exchange_clock();
+
+        // A single neighborhood collective replaces the persistent requests
+        if(this->neighbor_collectives_ == true)
+        {
+            this->CommunicateAsync_(send_buffer, recv_buffer);
+
+            return;
+        }
+
+        // The offsets are not allocated without neighbors, e.g. on a single process
+        int64_t send_size = this->send_index_size_;
+        int64_t recv_size = this->recv_index_size_;
+
+        // Look for requests that are bound to the given buffers, element size and counts
+        int idx = -1;
+        for(size_t i = 0; i < this->persistent_.size(); ++i)
+        {
+            const PersistentExchange& ex = this->persistent_[i];
+
+            if(ex.send_buffer == send_buffer && ex.recv_buffer == recv_buffer
+               && ex.value_size == sizeof(ValueType) && ex.send_size == send_size
+               && ex.recv_size == recv_size)
+            {
+                idx = static_cast<int>(i);
+                break;
+            }
+        }
+
+        // Set up persistent requests, if not yet available
+        if(idx < 0)
+        {
+            int tag = 0;
+
+            PersistentExchange ex;
+
+            ex.send_buffer = send_buffer;
+            ex.recv_buffer = recv_buffer;
+            ex.value_size  = sizeof(ValueType);
+            ex.send_size   = send_size;
+            ex.recv_size   = recv_size;
+            ex.nrecv       = 0;
+            ex.nsend       = 0;
+            ex.recv_event  = NULL;
+            ex.send_event  = NULL;
+
+#ifdef SUPPORT_MULTINODE
+            allocate_host(this->nrecv_ + 1, &ex.recv_event);
+            allocate_host(this->nsend_ + 1, &ex.send_event);
+#endif
+
+            // Persistent recv boundary from neighbors
+            for(int n = 0; n < this->nrecv_; ++n)
+            {
+                // nnz that we receive from process n
+                int nnz = this->recv_offset_index_[n + 1] - this->recv_offset_index_[n];
+
+                if(nnz > 0)
+                {
+                    assert(recv_buffer != NULL);
+
+#ifdef SUPPORT_MULTINODE
+                    communication_persistent_recv_init(recv_buffer + this->recv_offset_index_[n],
+                                                       nnz,
+                                                       this->recvs_[n],
+                                                       tag,
+                                                       &ex.recv_event[ex.nrecv++],
+                                                       this->comm_);
+#endif
+                }
+            }
+
+            // Persistent send boundary to neighbors
+            for(int n = 0; n < this->nsend_; ++n)
+            {
+                // nnz that we send to process n
+                int nnz = this->send_offset_index_[n + 1] - this->send_offset_index_[n];
+
+                if(nnz > 0)
+                {
+                    assert(send_buffer != NULL);
+
+#ifdef SUPPORT_MULTINODE
+                    communication_persistent_send_init(send_buffer + this->send_offset_index_[n],
+                                                       nnz,
+                                                       this->sends_[n],
+                                                       tag,
+                                                       &ex.send_event[ex.nsend++],
+                                                       this->comm_);
+#endif
+                }
+            }
+
+            idx = static_cast<int>(this->persistent_.size());
+            this->persistent_.push_back(ex);
+        }
+
+        const PersistentExchange& ex = this->persistent_[idx];
+
+#ifdef SUPPORT_MULTINODE
+        // Start all receives first, then all sends
+        if(ex.nrecv > 0)
+        {
+            communication_startall(ex.nrecv, ex.recv_event);
+        }
+
+        if(ex.nsend > 0)
+        {
+            communication_startall(ex.nsend, ex.send_event);
+        }
+#endif
+
+        this->async_persistent_ = idx;
+
+        this->StartProgress_();
+
+        log_debug(this, "ParallelManager::CommunicatePersistentAsync_()", "#*# end");
+    }
+
     template <typename ValueType>
     void ParallelManager::InverseCommunicateAsync_(ValueType* send_buffer,
                                                    ValueType* recv_buffer) const
@@ -845,6 +1419,8 @@ namespace rocalution
             }
         }
 
+        this->StartProgress_();
+
         log_debug(this, "ParallelManager::InverseCommunicateAsync_()", "#*# end");
     }
 
@@ -1099,6 +1675,17 @@ namespace rocalution
         int64_t local_nrow = this->local_nrow_;
         int64_t local_ncol = this->local_ncol_;
 
+        // A single process has no requests, if no communication pattern has been set
+        if(this->num_procs_ == 1)
+        {
+            this->global_row_offset_[1] = local_nrow;
+            this->global_col_offset_[1] = local_ncol;
+
+            log_debug(this, "ParallelManager::CommunicateGlobalOffsetAsync_()", "#*# end");
+
+            return;
+        }
+
 #ifdef SUPPORT_MULTINODE
         communication_async_allgather_single(
             &local_nrow, this->global_row_offset_ + 1, this->recv_event_, this->comm_);
@@ -1117,8 +1704,11 @@ namespace rocalution
         assert(this->global_col_offset_ != NULL);
 
 #ifdef SUPPORT_MULTINODE
-        communication_sync(this->recv_event_);
-        communication_sync(this->send_event_);
+        if(this->num_procs_ > 1)
+        {
+            communication_sync(this->recv_event_);
+            communication_sync(this->send_event_);
+        }
 #endif
 
         // Decrement guard
@@ -1170,11 +1760,18 @@ namespace rocalution
                                                               const ParallelManager& parent,
                                                               bool                   transposed)
     {
+        // Communication pattern changes, cached requests become invalid
+        this->FreePersistent_();
+        this->FreeNeighborComm_();
+
         // Allocate
         std::vector<int>     recv_size(parent.num_procs_, 0);
         std::vector<int64_t> recv_index;
         recv_index.reserve(nnz);
 
+        // The ghost columns are sorted, such that the owning process of each column is found
+        // by advancing through the global offsets of the parent once
+        int     owner    = 0;
         int64_t last_col = -1;
         for(int64_t i = 0; i < nnz; ++i)
         {
@@ -1184,6 +1781,7 @@ namespace rocalution
             // Sanity check
             assert(global_col >= 0);
             assert(global_col < transposed ? parent.global_nrow_ : parent.global_ncol_);
+            assert(global_col >= last_col);
 
             // Check for duplicates
             if(global_col == last_col)
@@ -1192,25 +1790,17 @@ namespace rocalution
             }
 
             // Check which process we are expecting to receive this entry from
-            for(int n = 0; n < parent.num_procs_; ++n)
+            while(owner < parent.num_procs_
+                  && global_col >= (transposed ? parent.GetGlobalRowEnd(owner)
+                                               : parent.GetGlobalColumnEnd(owner)))
             {
-                if(n == parent.rank_)
-                {
-                    continue;
-                }
-
-                int64_t col_begin
-                    = transposed ? parent.GetGlobalRowBegin(n) : parent.GetGlobalColumnBegin(n);
-                int64_t col_end
-                    = transposed ? parent.GetGlobalRowEnd(n) : parent.GetGlobalColumnEnd(n);
-
-                if(global_col >= col_begin && global_col < col_end)
-                {
-                    ++recv_size[n];
-                    recv_index.push_back(global_col);
+                ++owner;
+            }
 
-                    break;
-                }
+            if(owner < parent.num_procs_ && owner != parent.rank_)
+            {
+                ++recv_size[owner];
+                recv_index.push_back(global_col);
             }
 
             last_col = global_col;
@@ -1375,15 +1965,20 @@ namespace rocalution
         }
     }
 
-    template void ParallelManager::CommunicateAsync_<int>(int*, int*) const;
-    template void ParallelManager::CommunicateAsync_<float>(float*, float*) const;
-    template void ParallelManager::CommunicateAsync_<double>(double*, double*) const;
-    template void
-        ParallelManager::CommunicateAsync_<std::complex<float>>(std::complex<float>*,
-                                                                std::complex<float>*) const;
-    template void
-        ParallelManager::CommunicateAsync_<std::complex<double>>(std::complex<double>*,
-                                                                 std::complex<double>*) const;
+    template void ParallelManager::CommunicateAsync_<int>(int*, int*, const int*) const;
+    template void ParallelManager::CommunicateAsync_<float>(float*, float*, const int*) const;
+    template void ParallelManager::CommunicateAsync_<double>(double*, double*, const int*) const;
+    template void ParallelManager::CommunicateAsync_<std::complex<float>>(
+        std::complex<float>*, std::complex<float>*, const int*) const;
+    template void ParallelManager::CommunicateAsync_<std::complex<double>>(
+        std::complex<double>*, std::complex<double>*, const int*) const;
+
+    template void ParallelManager::CommunicatePersistentAsync_<float>(float*, float*) const;
+    template void ParallelManager::CommunicatePersistentAsync_<double>(double*, double*) const;
+    template void ParallelManager::CommunicatePersistentAsync_<std::complex<float>>(
+        std::complex<float>*, std::complex<float>*) const;
+    template void ParallelManager::CommunicatePersistentAsync_<std::complex<double>>(
+        std::complex<double>*, std::complex<double>*) const;
 
     template void ParallelManager::InverseCommunicateAsync_<bool>(bool*, bool*) const;
     template void ParallelManager::InverseCommunicateAsync_<int>(int*, int*) const;
@@ -29,6 +29,7 @@
 
 #include <complex>
 #include <string>
+#include <vector>
 
 namespace rocalution
 {
@@ -37,6 +38,8 @@ namespace rocalution
     template <typename ValueType>
     class GlobalVector;
     struct MRequest;
+    struct MComm;
+    struct ProgressThread;
 
     /** \ingroup backend_module
   * \brief Parallel Manager class
@@ -156,6 +159,48 @@ namespace rocalution
         ROCALUTION_EXPORT
         void GlobalToLocal(int global, int& proc, int& local);
 
+        /** \brief Exchange boundary data with MPI neighborhood collectives
+      * \details
+      * If enabled, the boundary exchange of global operators is done with a single
+      * MPI_Ineighbor_alltoallv() on a distributed graph communicator of the neighbors,
+      * instead of one point-to-point message per neighbor. This lets the MPI library
+      * schedule and aggregate the messages, which helps when ranks have many neighbors.
+      * The graph communicator is created collectively at the first exchange after the
+      * communication pattern has been set. Disabled by default.
+      */
+        ROCALUTION_EXPORT
+        void SetNeighborCollectives(bool enable);
+
+        /** \brief Drive the MPI progress engine with a helper thread
+      * \details
+      * Most MPI libraries only advance non-blocking messages inside MPI calls, such that
+      * the boundary exchange of a global operator stalls while the interior product is
+      * computed on the host. If enabled, a helper thread polls the MPI library while a
+      * boundary exchange is in flight, so the transfer overlaps with the interior
+      * computation. The thread sleeps in between exchanges, but it occupies a core while
+      * polling, it is advised to run one OpenMP thread less per process. This requires
+      * MPI to be initialized with MPI_THREAD_MULTIPLE, otherwise it is not enabled. The
+      * parallel manager has to be destroyed before MPI is finalized. Disabled by default.
+      */
+        ROCALUTION_EXPORT
+        void SetProgressThread(bool enable);
+
+        /** \brief Print statistics of the boundary exchange
+      * \details
+      * Prints the number of neighbors, the send and receive volume, the largest message,
+      * a histogram of the message sizes and the measured exchange time (from starting
+      * the exchange until its completion) as minimum, average and maximum over all
+      * ranks. This is a collective call.
+      *
+      * @param[in]
+      * value_size  size in bytes of a boundary value
+      */
+        ROCALUTION_EXPORT
+        void CommunicationInfo(int value_size = sizeof(double)) const;
+        /** \brief Reset the measured exchange time and number of exchanges */
+        ROCALUTION_EXPORT
+        void ResetCommunicationStats(void);
+
         /** \brief Check sanity status of parallel manager */
         ROCALUTION_EXPORT
         bool Status(void) const;
@@ -168,12 +213,29 @@ namespace rocalution
         void WriteFileASCII(const std::string& filename) const;
 
     protected:
-        /** \brief Communicate boundary data (async) */
+        /** \brief Communicate boundary data (async)
+      * \details
+      * The data for each neighbor starts at \p send_buffer + \p send_offset[n], by
+      * default the boundary offsets of the neighbors.
+      */
         template <typename ValueType>
-        void CommunicateAsync_(ValueType* send_buffer, ValueType* recv_buffer) const;
+        void CommunicateAsync_(ValueType* send_buffer,
+                               ValueType* recv_buffer,
+                               const int* send_offset = NULL) const;
         /** \brief Synchronize communication */
         void CommunicateSync_(void) const;
 
+        /** \brief Communicate boundary data (async) using persistent requests
+      * \details
+      * The persistent requests are bound to the given buffers, the value type and the
+      * communication pattern and are set up during the first call only. Consecutive calls
+      * with the same buffers just restart the cached requests. Communication is
+      * synchronized with CommunicateSync_(). Owners of the buffers have to call
+      * FreePersistent_() before the buffers are freed or reallocated.
+      */
+        template <typename ValueType>
+        void CommunicatePersistentAsync_(ValueType* send_buffer, ValueType* recv_buffer) const;
+
         /** \brief Back-communicate boundary data (async) */
         template <typename ValueType>
         void InverseCommunicateAsync_(ValueType* send_buffer, ValueType* recv_buffer) const;
@@ -217,6 +279,21 @@ namespace rocalution
         // Synchronize all events within this PM
         void Synchronize_(void) const;
 
+        // Free all cached persistent requests
+        void FreePersistent_(void) const;
+        // Free the cached persistent requests that are bound to the given buffers
+        void FreePersistent_(const void* send_buffer, const void* recv_buffer) const;
+
+        // Wake up / stop the progress thread around an exchange
+        void StartProgress_(void) const;
+        void StopProgress_(void) const;
+        // Terminate the progress thread
+        void FreeProgress_(void);
+
+        // Create / free the graph communicator for neighborhood collectives
+        void CreateNeighborComm_(void) const;
+        void FreeNeighborComm_(void) const;
+
         // Communicate global row and column offsets (async)
         void CommunicateGlobalOffsetAsync_(void) const;
         // Synchronize communication
@@ -288,6 +365,43 @@ namespace rocalution
         MRequest* recv_event_;
         MRequest* send_event_;
 
+        // Persistent send/receive requests, bound to a pair of buffers, their element
+        // size and the number of elements that are exchanged
+        struct PersistentExchange
+        {
+            const void* send_buffer;
+            const void* recv_buffer;
+            size_t      value_size;
+            int64_t     send_size;
+            int64_t     recv_size;
+            int         nrecv;
+            int         nsend;
+            MRequest*   recv_event;
+            MRequest*   send_event;
+        };
+
+        // Cached persistent requests
+        mutable std::vector<PersistentExchange> persistent_;
+        // Track ongoing persistent communication (-1 if none)
+        mutable int async_persistent_;
+
+        // Number of boundary exchanges and accumulated exchange time (in seconds)
+        mutable int64_t exchange_count_;
+        mutable double  exchange_time_;
+        // Start of the ongoing boundary exchange (negative if none)
+        mutable double exchange_start_;
+
+        // Flag whether boundary data is exchanged with neighborhood collectives
+        bool neighbor_collectives_;
+        // Graph communicator of the neighbors (NULL if not yet created)
+        mutable MComm* neighbor_comm_;
+        // Number of ids per neighbor
+        mutable std::vector<int> neighbor_recv_count_;
+        mutable std::vector<int> neighbor_send_count_;
+
+        // Helper thread that drives MPI progress during exchanges (NULL if disabled)
+        ProgressThread* progress_;
+
         friend class GlobalMatrix<double>;
         friend class GlobalMatrix<float>;
         friend class GlobalMatrix<std::complex<double>>;
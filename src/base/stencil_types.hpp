@@ -30,12 +30,14 @@ namespace rocalution
 {
 
     // Stencil Names
-    const std::string _stencil_type_names[1] = {"Laplace2D"};
+    const std::string _stencil_type_names[3] = {"Laplace2D", "Laplace3D", "Laplace3D27"};
 
     // Stencil Enumeration
     enum _stencil_type
     {
-        Laplace2D = 0
+        Laplace2D   = 0, // 5-point
+        Laplace3D   = 1, // 7-point
+        Laplace3D27 = 2 // 27-point
     };
 
 } // namespace rocalution
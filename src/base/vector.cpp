@@ -238,6 +238,35 @@ namespace rocalution
         FATAL_ERROR(__FILE__, __LINE__);
     }
 
+    template <typename ValueType>
+    ValueType Vector<ValueType>::DotFloat(const LocalVector<float>& x) const
+    {
+        LOG_INFO("Vector<ValueType>::DotFloat(const LocalVector<float>& x) const");
+        LOG_INFO("Mismatched types:");
+        this->Info();
+        x.Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void Vector<ValueType>::AddScaleFloat(const LocalVector<float>& x, ValueType alpha)
+    {
+        LOG_INFO("Vector<ValueType>::AddScaleFloat(const LocalVector<float>& x, ValueType alpha)");
+        LOG_INFO("Mismatched types:");
+        this->Info();
+        x.Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    void Vector<ValueType>::ScaleCopyToFloat(ValueType alpha, LocalVector<float>* vec)
+    {
+        LOG_INFO("Vector<ValueType>::ScaleCopyToFloat(ValueType alpha, LocalVector<float>* vec)");
+        LOG_INFO("Mismatched types:");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
     template <typename ValueType>
     ValueType Vector<ValueType>::DotNonConj(const LocalVector<ValueType>& x) const
     {
@@ -347,6 +347,24 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual ValueType Dot(const GlobalVector<ValueType>& x) const;
 
+        /** \brief Compute dot (scalar) product with the single precision vector x, which
+      * holds the local part of this (double and float only)
+      */
+        ROCALUTION_EXPORT
+        virtual ValueType DotFloat(const LocalVector<float>& x) const;
+
+        /** \brief Perform vector update of type this = this + alpha * x, where the single
+      * precision vector x holds the local part of this (double and float only)
+      */
+        ROCALUTION_EXPORT
+        virtual void AddScaleFloat(const LocalVector<float>& x, ValueType alpha);
+
+        /** \brief Perform vector scaling this = alpha * this and store the local part of
+      * the result, rounded to single precision, in vec (double and float only)
+      */
+        ROCALUTION_EXPORT
+        virtual void ScaleCopyToFloat(ValueType alpha, LocalVector<float>* vec);
+
         /** \brief Compute non-conjugate dot (scalar) product, return this^T y */
         ROCALUTION_EXPORT
         virtual ValueType DotNonConj(const LocalVector<ValueType>& x) const;
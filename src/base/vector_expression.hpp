@@ -0,0 +1,451 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_VECTOR_EXPRESSION_HPP_
+#define ROCALUTION_VECTOR_EXPRESSION_HPP_
+
+#include <algorithm>
+#include <type_traits>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    class LocalVector;
+    template <typename ValueType>
+    class GlobalVector;
+
+    /** \brief Maximum number of instructions of a vector expression */
+    const int _vector_expression_max_ops = 32;
+    /** \brief Maximum number of distinct vectors of a vector expression */
+    const int _vector_expression_max_vectors = 8;
+    /** \brief Maximum number of scalars of a vector expression */
+    const int _vector_expression_max_scalars = 16;
+    /** \brief Maximum evaluation stack depth of a vector expression */
+    const int _vector_expression_max_stack = 8;
+
+    /** \brief Instructions of a vector expression program */
+    enum _vector_expression_op : int
+    {
+        VExprVector = 0, /**< Push the element of a vector */
+        VExprScalar = 1, /**< Push a scalar */
+        VExprAdd    = 2, /**< Replace the two top elements a, b by a + b */
+        VExprSub    = 3, /**< Replace the two top elements a, b by a - b */
+        VExprMul    = 4, /**< Replace the two top elements a, b by a * b */
+        VExprDiv    = 5, /**< Replace the two top elements a, b by a / b */
+        VExprNeg    = 6 /**< Replace the top element a by -a */
+    };
+
+    /** \ingroup op_vec_module
+  * \brief Flattened element-wise vector expression
+  * \details
+  * A VectorExpressionProgram is the postfix form of a lazy vector expression (see
+  * VectorExpression). The backends evaluate it for all elements in a single pass over
+  * the vectors. \p num_ops is negative, if the expression exceeds the limits of the
+  * program.
+  */
+    template <typename ValueType>
+    struct VectorExpressionProgram
+    {
+        /** \brief Number of instructions */
+        int num_ops;
+        /** \brief Number of distinct vectors */
+        int num_vectors;
+        /** \brief Number of scalars */
+        int num_scalars;
+        /** \brief Maximum stack depth of the evaluation */
+        int depth;
+        /** \brief Instructions, see _vector_expression_op */
+        int op[_vector_expression_max_ops];
+        /** \brief Vector or scalar index of the VExprVector and VExprScalar instructions */
+        int arg[_vector_expression_max_ops];
+        /** \brief Scalars */
+        ValueType scalar[_vector_expression_max_scalars];
+    };
+
+    // Program and vectors of an expression during its compilation
+    template <class VectorType, typename ValueType>
+    struct VectorExpressionBuilder
+    {
+        VectorExpressionProgram<ValueType> program;
+        const VectorType*                  vec[_vector_expression_max_vectors];
+
+        // Current stack depth
+        int size;
+
+        VectorExpressionBuilder()
+        {
+            this->program.num_ops     = 0;
+            this->program.num_vectors = 0;
+            this->program.num_scalars = 0;
+            this->program.depth       = 0;
+
+            this->size = 0;
+        }
+
+        void PushVector(const VectorType* v)
+        {
+            // The same vector is loaded through a single slot
+            int k = 0;
+
+            while(k < this->program.num_vectors && this->vec[k] != v)
+            {
+                ++k;
+            }
+
+            if(k == this->program.num_vectors)
+            {
+                if(k == _vector_expression_max_vectors)
+                {
+                    this->program.num_ops = -1;
+                    return;
+                }
+
+                this->vec[k] = v;
+                ++this->program.num_vectors;
+            }
+
+            this->Push_(VExprVector, k, 1);
+        }
+
+        void PushScalar(ValueType s)
+        {
+            int k = this->program.num_scalars;
+
+            if(k == _vector_expression_max_scalars)
+            {
+                this->program.num_ops = -1;
+                return;
+            }
+
+            this->program.scalar[k] = s;
+            ++this->program.num_scalars;
+
+            this->Push_(VExprScalar, k, 1);
+        }
+
+        void PushOp(int op)
+        {
+            this->Push_(op, 0, (op == VExprNeg) ? 0 : -1);
+        }
+
+    private:
+        void Push_(int op, int arg, int delta)
+        {
+            int k = this->program.num_ops;
+
+            if(k < 0 || k == _vector_expression_max_ops)
+            {
+                this->program.num_ops = -1;
+                return;
+            }
+
+            this->program.op[k]  = op;
+            this->program.arg[k] = arg;
+            ++this->program.num_ops;
+
+            this->size += delta;
+            this->program.depth = std::max(this->program.depth, this->size);
+
+            if(this->program.depth > _vector_expression_max_stack)
+            {
+                this->program.num_ops = -1;
+            }
+        }
+    };
+
+    /** \ingroup op_vec_module
+  * \brief Lazy element-wise vector expression
+  * \details
+  * Arithmetic operators (+, -, *, /) on LocalVector or GlobalVector objects, scalars
+  * and other expressions do not compute anything, but build an expression tree at
+  * compile time. Assigning the expression to a vector, or reducing it with Sum(),
+  * evaluates all elements in a single fused pass over the vectors without
+  * temporaries. Products and quotients of vectors are element-wise. All vectors of an
+  * expression have to be of the same type, size and backend. The vectors are
+  * referenced, an expression must not outlive them.
+  *
+  * \par Example
+  * \code{.cpp}
+  *   // x = a * y + b * z - c * w in a single pass
+  *   x = a * y + b * z - c * w;
+  *
+  *   // (r, z) and ||x - y||^2
+  *   ValueType rho = Sum(r * z);
+  *   ValueType err = Sum((x - y) * (x - y));
+  * \endcode
+  */
+    template <class Expr>
+    struct VectorExpression
+    {
+        /** \brief Return the derived expression */
+        const Expr& Self(void) const
+        {
+            return static_cast<const Expr&>(*this);
+        }
+    };
+
+    // Vector operand
+    template <class VectorType, typename ValueType>
+    struct VectorExpressionTerminal
+        : public VectorExpression<VectorExpressionTerminal<VectorType, ValueType>>
+    {
+        typedef VectorType vector_type;
+        typedef ValueType  value_type;
+
+        explicit VectorExpressionTerminal(const VectorType& v)
+            : vec(&v)
+        {
+        }
+
+        template <class Builder>
+        void Compile(Builder* builder) const
+        {
+            builder->PushVector(this->vec);
+        }
+
+        const VectorType* vec;
+    };
+
+    // Scalar operand, it has no vector type
+    template <typename ValueType>
+    struct VectorExpressionScalar : public VectorExpression<VectorExpressionScalar<ValueType>>
+    {
+        typedef void      vector_type;
+        typedef ValueType value_type;
+
+        explicit VectorExpressionScalar(ValueType s)
+            : scalar(s)
+        {
+        }
+
+        template <class Builder>
+        void Compile(Builder* builder) const
+        {
+            builder->PushScalar(this->scalar);
+        }
+
+        ValueType scalar;
+    };
+
+    // Binary operation
+    template <class L, class R, int OP>
+    struct VectorExpressionBinary : public VectorExpression<VectorExpressionBinary<L, R, OP>>
+    {
+        typedef typename std::conditional<std::is_void<typename L::vector_type>::value,
+                                          typename R::vector_type,
+                                          typename L::vector_type>::type vector_type;
+        typedef typename L::value_type                                  value_type;
+
+        static_assert(std::is_void<typename L::vector_type>::value
+                          || std::is_void<typename R::vector_type>::value
+                          || std::is_same<typename L::vector_type,
+                                          typename R::vector_type>::value,
+                      "All vectors of an expression must be of the same type");
+
+        VectorExpressionBinary(const L& l, const R& r)
+            : lhs(l)
+            , rhs(r)
+        {
+        }
+
+        template <class Builder>
+        void Compile(Builder* builder) const
+        {
+            this->lhs.Compile(builder);
+            this->rhs.Compile(builder);
+            builder->PushOp(OP);
+        }
+
+        L lhs;
+        R rhs;
+    };
+
+    // Negation
+    template <class E>
+    struct VectorExpressionNegate : public VectorExpression<VectorExpressionNegate<E>>
+    {
+        typedef typename E::vector_type vector_type;
+        typedef typename E::value_type  value_type;
+
+        explicit VectorExpressionNegate(const E& e)
+            : expr(e)
+        {
+        }
+
+        template <class Builder>
+        void Compile(Builder* builder) const
+        {
+            this->expr.Compile(builder);
+            builder->PushOp(VExprNeg);
+        }
+
+        E expr;
+    };
+
+    // Operands of the expression operators, vectors and expressions
+    template <class T, class Enable = void>
+    struct _vector_expression_operand
+    {
+        static const bool value = false;
+    };
+
+    template <typename ValueType>
+    struct _vector_expression_operand<LocalVector<ValueType>>
+    {
+        static const bool value = true;
+
+        typedef VectorExpressionTerminal<LocalVector<ValueType>, ValueType> node;
+        typedef ValueType                                                   value_type;
+
+        static node make(const LocalVector<ValueType>& v)
+        {
+            return node(v);
+        }
+    };
+
+    template <typename ValueType>
+    struct _vector_expression_operand<GlobalVector<ValueType>>
+    {
+        static const bool value = true;
+
+        typedef VectorExpressionTerminal<GlobalVector<ValueType>, ValueType> node;
+        typedef ValueType                                                    value_type;
+
+        static node make(const GlobalVector<ValueType>& v)
+        {
+            return node(v);
+        }
+    };
+
+    template <class T>
+    struct _vector_expression_operand<
+        T,
+        typename std::enable_if<std::is_base_of<VectorExpression<T>, T>::value>::type>
+    {
+        static const bool value = true;
+
+        typedef T                       node;
+        typedef typename T::value_type value_type;
+
+        static const T& make(const T& e)
+        {
+            return e;
+        }
+    };
+
+// Operator between two operands, and between an operand and a scalar on either side
+#define ROCALUTION_VECTOR_EXPRESSION_OPERATOR(OPERATOR, OP)                                    \
+    template <class L,                                                                         \
+              class R,                                                                         \
+              typename std::enable_if<_vector_expression_operand<L>::value                     \
+                                          && _vector_expression_operand<R>::value,             \
+                                      int>::type = 0>                                          \
+    inline VectorExpressionBinary<typename _vector_expression_operand<L>::node,                \
+                                  typename _vector_expression_operand<R>::node,                \
+                                  OP>                                                          \
+        OPERATOR(const L& lhs, const R& rhs)                                                   \
+    {                                                                                          \
+        return VectorExpressionBinary<typename _vector_expression_operand<L>::node,            \
+                                      typename _vector_expression_operand<R>::node,            \
+                                      OP>(_vector_expression_operand<L>::make(lhs),            \
+                                          _vector_expression_operand<R>::make(rhs));           \
+    }                                                                                          \
+                                                                                               \
+    template <class R,                                                                         \
+              typename std::enable_if<_vector_expression_operand<R>::value, int>::type = 0>    \
+    inline VectorExpressionBinary<                                                             \
+        VectorExpressionScalar<typename _vector_expression_operand<R>::value_type>,            \
+        typename _vector_expression_operand<R>::node,                                          \
+        OP>                                                                                    \
+        OPERATOR(typename _vector_expression_operand<R>::value_type lhs, const R& rhs)         \
+    {                                                                                          \
+        typedef typename _vector_expression_operand<R>::value_type value_type;                 \
+                                                                                               \
+        return VectorExpressionBinary<VectorExpressionScalar<value_type>,                      \
+                                      typename _vector_expression_operand<R>::node,            \
+                                      OP>(VectorExpressionScalar<value_type>(lhs),             \
+                                          _vector_expression_operand<R>::make(rhs));           \
+    }                                                                                          \
+                                                                                               \
+    template <class L,                                                                         \
+              typename std::enable_if<_vector_expression_operand<L>::value, int>::type = 0>    \
+    inline VectorExpressionBinary<                                                             \
+        typename _vector_expression_operand<L>::node,                                          \
+        VectorExpressionScalar<typename _vector_expression_operand<L>::value_type>,            \
+        OP>                                                                                    \
+        OPERATOR(const L& lhs, typename _vector_expression_operand<L>::value_type rhs)         \
+    {                                                                                          \
+        typedef typename _vector_expression_operand<L>::value_type value_type;                 \
+                                                                                               \
+        return VectorExpressionBinary<typename _vector_expression_operand<L>::node,            \
+                                      VectorExpressionScalar<value_type>,                      \
+                                      OP>(_vector_expression_operand<L>::make(lhs),            \
+                                          VectorExpressionScalar<value_type>(rhs));            \
+    }
+
+    ROCALUTION_VECTOR_EXPRESSION_OPERATOR(operator+, VExprAdd)
+    ROCALUTION_VECTOR_EXPRESSION_OPERATOR(operator-, VExprSub)
+    ROCALUTION_VECTOR_EXPRESSION_OPERATOR(operator*, VExprMul)
+    ROCALUTION_VECTOR_EXPRESSION_OPERATOR(operator/, VExprDiv)
+
+#undef ROCALUTION_VECTOR_EXPRESSION_OPERATOR
+
+    template <class E, typename std::enable_if<_vector_expression_operand<E>::value, int>::type = 0>
+    inline VectorExpressionNegate<typename _vector_expression_operand<E>::node>
+        operator-(const E& expr)
+    {
+        return VectorExpressionNegate<typename _vector_expression_operand<E>::node>(
+            _vector_expression_operand<E>::make(expr));
+    }
+
+    /** \ingroup op_vec_module
+  * \brief Sum of the elements of a lazy vector expression
+  * \details
+  * \p Sum evaluates the expression and reduces its elements in a single pass over the
+  * vectors, e.g. Sum(x * y) is the non-conjugated dot product of \p x and \p y. The
+  * expression is evaluated on the backend of its vectors.
+  *
+  * @param[in]
+  * expr    vector expression, see VectorExpression.
+  *
+  * \retval  sum of the elements of the expression.
+  */
+    template <class Expr>
+    typename Expr::value_type Sum(const VectorExpression<Expr>& expr)
+    {
+        typedef typename Expr::vector_type vector_type;
+        typedef typename Expr::value_type  value_type;
+
+        static_assert(!std::is_void<vector_type>::value,
+                      "A vector expression needs at least one vector");
+
+        VectorExpressionBuilder<vector_type, value_type> builder;
+        expr.Self().Compile(&builder);
+
+        return builder.vec[0]->EvaluateSum(builder.program, builder.vec);
+    }
+
+} // namespace rocalution
+
+#endif // ROCALUTION_VECTOR_EXPRESSION_HPP_
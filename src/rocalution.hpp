@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2021 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -41,26 +41,52 @@
 #include "base/matrix_formats.hpp"
 
 #include "base/global_vector.hpp"
+#include "base/local_batch_matrix.hpp"
+#include "base/local_multi_vector.hpp"
 #include "base/local_vector.hpp"
+#include "base/vector_expression.hpp"
 
+#include "base/local_hybrid_matrix.hpp"
+#include "base/local_shell_operator.hpp"
 #include "base/local_stencil.hpp"
 #include "base/stencil_types.hpp"
 
+#include "solvers/batch_solver.hpp"
 #include "solvers/chebyshev.hpp"
 #include "solvers/direct/inversion.hpp"
 #include "solvers/direct/lu.hpp"
 #include "solvers/direct/qr.hpp"
+#include "solvers/direct/sparse_lu.hpp"
+#include "solvers/eigen/eigen_solver.hpp"
+#include "solvers/eigen/lanczos.hpp"
+#include "solvers/eigen/lobpcg.hpp"
 #include "solvers/iter_ctrl.hpp"
+#include "solvers/krylov/batch_bicgstab.hpp"
+#include "solvers/krylov/batch_gmres.hpp"
 #include "solvers/krylov/bicgstab.hpp"
 #include "solvers/krylov/bicgstabl.hpp"
+#include "solvers/krylov/blockcg.hpp"
+#include "solvers/krylov/blockgmres.hpp"
 #include "solvers/krylov/cg.hpp"
+#include "solvers/krylov/cgls.hpp"
 #include "solvers/krylov/cr.hpp"
+#include "solvers/krylov/deflated_cg.hpp"
 #include "solvers/krylov/fcg.hpp"
 #include "solvers/krylov/fgmres.hpp"
 #include "solvers/krylov/gmres.hpp"
 #include "solvers/krylov/idr.hpp"
+#include "solvers/krylov/lsqr.hpp"
+#include "solvers/krylov/minres.hpp"
+#include "solvers/krylov/pipebicgstab.hpp"
+#include "solvers/krylov/pipecg.hpp"
 #include "solvers/krylov/qmrcgstab.hpp"
+#include "solvers/krylov/recycledgmres.hpp"
+#include "solvers/krylov/sstepcg.hpp"
+#include "solvers/krylov/sqmr.hpp"
+#include "solvers/krylov/sstepgmres.hpp"
+#include "solvers/krylov/sketchedgmres.hpp"
 #include "solvers/mixed_precision.hpp"
+#include "solvers/multigrid/amg_tuner.hpp"
 #include "solvers/multigrid/base_amg.hpp"
 #include "solvers/multigrid/base_multigrid.hpp"
 #include "solvers/multigrid/multigrid.hpp"
@@ -68,21 +94,28 @@
 #include "solvers/multigrid/ruge_stueben_amg.hpp"
 #include "solvers/multigrid/smoothed_amg.hpp"
 #include "solvers/multigrid/unsmoothed_amg.hpp"
+#include "solvers/solve_handle.hpp"
 #include "solvers/solver.hpp"
+#include "solvers/workspace.hpp"
 
 #include "solvers/preconditioners/preconditioner.hpp"
 #include "solvers/preconditioners/preconditioner_ai.hpp"
 #include "solvers/preconditioners/preconditioner_as.hpp"
+#include "solvers/preconditioners/preconditioner_assembled.hpp"
 #include "solvers/preconditioners/preconditioner_blockjacobi.hpp"
+#include "solvers/preconditioners/preconditioner_schur_ilu.hpp"
 #include "solvers/preconditioners/preconditioner_blockprecond.hpp"
+#include "solvers/preconditioners/preconditioner_hybrid.hpp"
 #include "solvers/preconditioners/preconditioner_multicolored.hpp"
 #include "solvers/preconditioners/preconditioner_multicolored_gs.hpp"
 #include "solvers/preconditioners/preconditioner_multicolored_ilu.hpp"
 #include "solvers/preconditioners/preconditioner_multielimination.hpp"
+#include "solvers/preconditioners/preconditioner_redundant.hpp"
 #include "solvers/preconditioners/preconditioner_saddlepoint.hpp"
 
 #include "utils/allocate_free.hpp"
 #include "utils/time_functions.hpp"
+#include "utils/type_traits.hpp"
 #include "utils/types.hpp"
 
 #endif // ROCALUTION_ROCALUTION_HPP_
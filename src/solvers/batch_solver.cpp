@@ -0,0 +1,264 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "batch_solver.hpp"
+#include "../utils/def.hpp"
+#include "../utils/log.hpp"
+
+#include <algorithm>
+#include <complex>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    BaseBatchSolver<ValueType>::BaseBatchSolver()
+    {
+        log_debug(this, "BaseBatchSolver::BaseBatchSolver()");
+
+        this->op_      = NULL;
+        this->precond_ = BatchPrecondNone;
+
+        this->abs_tol_  = 1e-15;
+        this->rel_tol_  = 1e-6;
+        this->max_iter_ = 1000;
+
+        this->build_ = false;
+        this->verb_  = 1;
+    }
+
+    template <typename ValueType>
+    BaseBatchSolver<ValueType>::~BaseBatchSolver()
+    {
+        log_debug(this, "BaseBatchSolver::~BaseBatchSolver()");
+
+        // the Clear() is called in the derived class
+    }
+
+    template <typename ValueType>
+    void BaseBatchSolver<ValueType>::SetOperator(const LocalBatchMatrix<ValueType>& op)
+    {
+        log_debug(this, "BaseBatchSolver::SetOperator()", (const void*&)op);
+
+        assert(this->build_ == false);
+
+        this->op_ = &op;
+    }
+
+    template <typename ValueType>
+    void BaseBatchSolver<ValueType>::SetPreconditioner(BatchPreconditioner precond)
+    {
+        log_debug(this, "BaseBatchSolver::SetPreconditioner()", precond);
+
+        assert(this->build_ == false);
+        assert(precond == BatchPrecondNone || precond == BatchPrecondJacobi
+               || precond == BatchPrecondILU0);
+
+        this->precond_ = precond;
+    }
+
+    template <typename ValueType>
+    void BaseBatchSolver<ValueType>::Init(double abs_tol, double rel_tol, int max_iter)
+    {
+        log_debug(this, "BaseBatchSolver::Init()", abs_tol, rel_tol, max_iter);
+
+        assert(abs_tol >= 0.0);
+        assert(rel_tol >= 0.0);
+        assert(max_iter >= 0);
+
+        this->abs_tol_  = abs_tol;
+        this->rel_tol_  = rel_tol;
+        this->max_iter_ = max_iter;
+    }
+
+    template <typename ValueType>
+    void BaseBatchSolver<ValueType>::Build(void)
+    {
+        log_debug(this, "BaseBatchSolver::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("BaseBatchSolver::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        assert(this->op_ != NULL);
+
+        this->build_ = true;
+
+        this->inv_diag_.CloneBackend(*this->op_);
+        this->lu_.CloneBackend(*this->op_);
+
+        this->ReBuildNumeric();
+
+        log_debug(this, "BaseBatchSolver::Build()", this->build_, " #*# end");
+    }
+
+    template <typename ValueType>
+    void BaseBatchSolver<ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "BaseBatchSolver::ReBuildNumeric()", this->build_);
+
+        assert(this->build_ == true);
+        assert(this->op_ != NULL);
+
+        if(this->precond_ == BatchPrecondJacobi)
+        {
+            this->op_->ExtractInverseDiagonal(&this->inv_diag_);
+        }
+        else if(this->precond_ == BatchPrecondILU0)
+        {
+            this->lu_.CopyFrom(*this->op_);
+            this->lu_.ILU0Factorize();
+        }
+    }
+
+    template <typename ValueType>
+    void BaseBatchSolver<ValueType>::Clear(void)
+    {
+        log_debug(this, "BaseBatchSolver::Clear()", this->build_);
+
+        this->inv_diag_.Clear();
+        this->lu_.Clear();
+
+        this->iter_.clear();
+        this->res_.clear();
+
+        this->build_ = false;
+    }
+
+    template <typename ValueType>
+    void BaseBatchSolver<ValueType>::MoveToHost(void)
+    {
+        log_debug(this, "BaseBatchSolver::MoveToHost()", this->build_);
+
+        this->inv_diag_.MoveToHost();
+        this->lu_.MoveToHost();
+    }
+
+    template <typename ValueType>
+    void BaseBatchSolver<ValueType>::MoveToAccelerator(void)
+    {
+        log_debug(this, "BaseBatchSolver::MoveToAccelerator()", this->build_);
+
+        this->inv_diag_.MoveToAccelerator();
+        this->lu_.MoveToAccelerator();
+    }
+
+    template <typename ValueType>
+    void BaseBatchSolver<ValueType>::Verbose(int verb)
+    {
+        log_debug(this, "BaseBatchSolver::Verbose()", verb);
+
+        this->verb_ = verb;
+    }
+
+    template <typename ValueType>
+    int BaseBatchSolver<ValueType>::GetIterationCount(int k) const
+    {
+        assert(k >= 0);
+        assert(k < static_cast<int>(this->iter_.size()));
+
+        return this->iter_[k];
+    }
+
+    template <typename ValueType>
+    double BaseBatchSolver<ValueType>::GetCurrentResidual(int k) const
+    {
+        assert(k >= 0);
+        assert(k < static_cast<int>(this->res_.size()));
+
+        return this->res_[k];
+    }
+
+    template <typename ValueType>
+    void BaseBatchSolver<ValueType>::Solve_(int                                basis,
+                                            const LocalMultiVector<ValueType>& rhs,
+                                            LocalMultiVector<ValueType>*       x)
+    {
+        log_debug(this, "BaseBatchSolver::Solve_()", basis, (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+
+        int batch = this->op_->GetBatchSize();
+
+        this->iter_.resize(batch);
+        this->res_.resize(batch);
+
+        if(this->verb_ > 0)
+        {
+            this->Print();
+
+            LOG_INFO(this->Name_() << " starts, batch=" << batch
+                                   << ", rows=" << this->op_->GetM());
+        }
+
+        this->op_->Solve_(basis,
+                          (this->precond_ == BatchPrecondJacobi) ? &this->inv_diag_ : NULL,
+                          (this->precond_ == BatchPrecondILU0) ? &this->lu_ : NULL,
+                          rhs,
+                          x,
+                          this->abs_tol_,
+                          this->rel_tol_,
+                          this->max_iter_,
+                          this->iter_.data(),
+                          this->res_.data());
+
+        if(this->verb_ > 1)
+        {
+            for(int k = 0; k < batch; ++k)
+            {
+                LOG_INFO("System " << k << ": iterations=" << this->iter_[k]
+                                   << "; residual=" << this->res_[k]);
+            }
+        }
+
+        if(this->verb_ > 0)
+        {
+            int    max_iter = 0;
+            double max_res  = 0.0;
+
+            for(int k = 0; k < batch; ++k)
+            {
+                max_iter = std::max(max_iter, this->iter_[k]);
+                max_res  = std::max(max_res, this->res_[k]);
+            }
+
+            LOG_INFO(this->Name_() << " ends, max iterations=" << max_iter
+                                   << ", max residual=" << max_res);
+        }
+    }
+
+    template class BaseBatchSolver<double>;
+    template class BaseBatchSolver<float>;
+#ifdef SUPPORT_COMPLEX
+    template class BaseBatchSolver<std::complex<double>>;
+    template class BaseBatchSolver<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,167 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_BATCH_SOLVER_HPP_
+#define ROCALUTION_BATCH_SOLVER_HPP_
+
+#include "../base/base_rocalution.hpp"
+#include "../base/local_batch_matrix.hpp"
+#include "../base/local_multi_vector.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+    /*! \brief Batched preconditioners
+     *  \details
+     *  This is a list of preconditioners that can be applied by the batched solvers
+     */
+    typedef enum _batch_precond : unsigned int
+    {
+        BatchPrecondNone   = 0, /**< No preconditioning. */
+        BatchPrecondJacobi = 1, /**< Jacobi (inverse diagonal) preconditioning. */
+        BatchPrecondILU0   = 2, /**< ILU(0) preconditioning. */
+    } BatchPreconditioner;
+
+    /** \ingroup solver_module
+  * \class BaseBatchSolver
+  * \brief Base class for all batched solvers
+  * \details
+  * A batched solver solves all independent systems of a LocalBatchMatrix at once.
+  * The complete iteration of all systems is carried out by the backend in a single
+  * call, i.e. there is no host synchronization per iteration. Each system is solved
+  * until its own residual norm satisfies the stopping criteria, the iteration count
+  * and the final residual norm are then available for each system separately.
+  * Right-hand sides and solutions are LocalMultiVectors with one column per system.
+  *
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <typename ValueType>
+    class BaseBatchSolver : public RocalutionObj
+    {
+    public:
+        ROCALUTION_EXPORT
+        BaseBatchSolver();
+        ROCALUTION_EXPORT
+        virtual ~BaseBatchSolver();
+
+        /** \brief Set the batch of operators of the solver */
+        ROCALUTION_EXPORT
+        void SetOperator(const LocalBatchMatrix<ValueType>& op);
+
+        /** \brief Set the preconditioner of all systems (default BatchPrecondNone) */
+        ROCALUTION_EXPORT
+        void SetPreconditioner(BatchPreconditioner precond);
+
+        /** \brief Initialize the solver with absolute and relative tolerance and the
+        * maximum number of iterations, a system has converged if its residual norm
+        * satisfies the absolute or the relative tolerance
+        */
+        ROCALUTION_EXPORT
+        void Init(double abs_tol, double rel_tol, int max_iter);
+
+        /** \brief Print information about the solver */
+        virtual void Print(void) const = 0;
+
+        /** \brief Solve all systems A_k x_k = rhs_k, x holds the initial guess */
+        virtual void Solve(const LocalMultiVector<ValueType>& rhs,
+                           LocalMultiVector<ValueType>*       x)
+            = 0;
+
+        /** \brief Build the solver (preconditioner setup) */
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+
+        /** \brief Rebuild the preconditioner after the values of the operators have
+        * changed, the pattern has to stay the same
+        */
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+
+        /** \brief Clear (free all local data) the solver */
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Move all data (i.e. move the solver) to the host */
+        ROCALUTION_EXPORT
+        virtual void MoveToHost(void);
+        /** \brief Move all data (i.e. move the solver) to the accelerator */
+        ROCALUTION_EXPORT
+        virtual void MoveToAccelerator(void);
+
+        /** \brief Provide verbose output of the solver
+        * \details
+        * - verb = 0 -> no output
+        * - verb = 1 -> print info about the solver (start, end);
+        * - verb = 2 -> print iteration count and residual of each system;
+        */
+        ROCALUTION_EXPORT
+        void Verbose(int verb = 1);
+
+        /** \brief Return the iteration count of system \p k of the last solve */
+        ROCALUTION_EXPORT
+        int GetIterationCount(int k) const;
+        /** \brief Return the final residual norm of system \p k of the last solve */
+        ROCALUTION_EXPORT
+        double GetCurrentResidual(int k) const;
+
+    protected:
+        /** \brief Solve all systems with BiCGStab (\p basis == 0) or GMRES(\p basis) */
+        void Solve_(int                                basis,
+                    const LocalMultiVector<ValueType>& rhs,
+                    LocalMultiVector<ValueType>*       x);
+
+        /** \brief Return the name of the solver, used for verbose output */
+        virtual std::string Name_(void) const = 0;
+
+        /** \brief Pointer to the batch of operators */
+        const LocalBatchMatrix<ValueType>* op_;
+
+        /** \brief Preconditioner */
+        BatchPreconditioner precond_;
+
+        /** \brief Inverse diagonals, for BatchPrecondJacobi */
+        LocalMultiVector<ValueType> inv_diag_;
+        /** \brief ILU(0) factors, for BatchPrecondILU0 */
+        LocalBatchMatrix<ValueType> lu_;
+
+        /** \brief Stopping criteria */
+        double abs_tol_;
+        double rel_tol_;
+        int    max_iter_;
+
+        /** \brief Iteration count and residual norm of each system of the last solve */
+        std::vector<int>    iter_;
+        std::vector<double> res_;
+
+        /** \brief Flag == true after building the solver (e.g. Build()) */
+        bool build_;
+
+        /** \brief Verbose flag */
+        int verb_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_BATCH_SOLVER_HPP_
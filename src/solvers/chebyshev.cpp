@@ -26,6 +26,7 @@
 #include "iter_ctrl.hpp"
 
 #include "../base/local_matrix.hpp"
+#include "../base/local_shell_operator.hpp"
 #include "../base/local_stencil.hpp"
 #include "../base/local_vector.hpp"
 
@@ -47,6 +48,10 @@ namespace rocalution
         log_debug(this, "Chebyshev::Chebyshev()");
 
         this->init_lambda_ = false;
+
+        this->estimate_steps_  = 0;
+        this->estimate_safety_ = 1.1;
+        this->estimate_ratio_  = 0.0;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -66,7 +71,54 @@ namespace rocalution
         this->lambda_min_ = lambda_min;
         this->lambda_max_ = lambda_max;
 
+        this->init_lambda_    = true;
+        this->estimate_steps_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Chebyshev<OperatorType, VectorType, ValueType>::SetSpectrumEstimation(int    steps,
+                                                                               double safety_factor,
+                                                                               double ratio)
+    {
+        log_debug(this, "Chebyshev::SetSpectrumEstimation()", steps, safety_factor, ratio);
+
+        assert(steps > 0);
+        assert(safety_factor >= 1.0);
+        assert(ratio >= 0.0 && ratio < 1.0);
+
+        this->estimate_steps_  = steps;
+        this->estimate_safety_ = safety_factor;
+        this->estimate_ratio_  = ratio;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Chebyshev<OperatorType, VectorType, ValueType>::EstimateLambda_(void)
+    {
+        log_debug(this, "Chebyshev::EstimateLambda_()");
+
+        ValueType lambda_min;
+        ValueType lambda_max;
+
+        this->EstimateSpectrum_(this->estimate_steps_, &lambda_min, &lambda_max);
+
+        this->lambda_max_ = lambda_max * static_cast<ValueType>(this->estimate_safety_);
+
+        if(this->estimate_ratio_ > 0.0)
+        {
+            this->lambda_min_ = this->lambda_max_ * static_cast<ValueType>(this->estimate_ratio_);
+        }
+        else
+        {
+            this->lambda_min_ = lambda_min / static_cast<ValueType>(this->estimate_safety_);
+        }
+
         this->init_lambda_ = true;
+
+        if(this->verb_ > 0)
+        {
+            LOG_INFO("Chebyshev estimated eigenvalues: lambda_min = "
+                     << this->lambda_min_ << " lambda_max = " << this->lambda_max_);
+        }
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -115,6 +167,8 @@ namespace rocalution
     {
         log_debug(this, "Chebyshev::Build()");
 
+        ROCALUTION_RANGE("Chebyshev::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -142,6 +196,11 @@ namespace rocalution
 
         this->p_.CloneBackend(*this->op_);
         this->p_.Allocate("p", this->op_->GetM());
+
+        if(this->estimate_steps_ > 0)
+        {
+            this->EstimateLambda_();
+        }
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -181,13 +240,15 @@ namespace rocalution
 
             this->iter_ctrl_.Clear();
 
-            this->build_       = false;
-            this->init_lambda_ = false;
-
             if(this->precond_ != NULL)
             {
                 this->precond_->ReBuildNumeric();
             }
+
+            if(this->estimate_steps_ > 0)
+            {
+                this->EstimateLambda_();
+            }
         }
         else
         {
@@ -249,9 +310,63 @@ namespace rocalution
 
         ValueType two = static_cast<ValueType>(2);
         ValueType alpha, beta;
+        bool      first = true;
         ValueType d = (this->lambda_max_ + this->lambda_min_) / two;
         ValueType c = (this->lambda_max_ - this->lambda_min_) / two;
 
+        // Differentiate between smoothing and non-smoothing, as we can skip norm
+        // computation in smoothing case
+        if(this->is_smoother_)
+        {
+            // Number of smoothing steps to perform
+            int steps = this->iter_ctrl_.GetMaximumIterations();
+
+            if(steps < 1)
+            {
+                return;
+            }
+
+            // Feed some dummy residual to initialize IterationControl class
+            this->iter_ctrl_.InitResidual(1.0);
+
+            for(int iter = 0; iter < steps; ++iter)
+            {
+                // compute residual = b - Ax
+                op->Apply(*x, r);
+                r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+                if(iter == 0)
+                {
+                    // p = r
+                    p->CopyFrom(*r);
+
+                    alpha = static_cast<ValueType>(1) / d;
+                }
+                else
+                {
+                    // beta_1 = (c alpha_1)^2 / 2, beta_i = (c alpha_i / 2)^2
+                    beta = (c * alpha / two) * (c * alpha / two);
+
+                    if(iter == 1)
+                    {
+                        beta *= two;
+                    }
+
+                    alpha = static_cast<ValueType>(1) / (d - beta / alpha);
+
+                    // p = beta*p + r
+                    p->ScaleAdd(beta, *r);
+                }
+
+                // x = x + alpha*p
+                x->AddScale(*p, alpha);
+            }
+
+            log_debug(this, "Chebyshev::SolveNonPrecond_()", " #*# end");
+
+            return;
+        }
+
         // initial residual = b - Ax
         op->Apply(*x, r);
         r->ScaleAdd(static_cast<ValueType>(-1), rhs);
@@ -268,7 +383,7 @@ namespace rocalution
         // p = r
         p->CopyFrom(*r);
 
-        alpha = two / d;
+        alpha = static_cast<ValueType>(1) / d;
 
         // x = x + alpha*p
         x->AddScale(*p, alpha);
@@ -277,12 +392,19 @@ namespace rocalution
         op->Apply(*x, r);
         r->ScaleAdd(static_cast<ValueType>(-1), rhs);
 
-        res = this->Norm_(*r);
+        res = this->ResidualNorm_(*r);
         while(!this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
         {
+            // beta_1 = (c alpha_1)^2 / 2, beta_i = (c alpha_i / 2)^2
             beta = (c * alpha / two) * (c * alpha / two);
 
-            alpha = static_cast<ValueType>(1) / (d - beta);
+            if(first == true)
+            {
+                beta *= two;
+                first = false;
+            }
+
+            alpha = static_cast<ValueType>(1) / (d - beta / alpha);
 
             // p = beta*p + r
             p->ScaleAdd(beta, *r);
@@ -293,7 +415,7 @@ namespace rocalution
             // compute residual = b - Ax
             op->Apply(*x, r);
             r->ScaleAdd(static_cast<ValueType>(-1), rhs);
-            res = this->Norm_(*r);
+            res = this->ResidualNorm_(*r);
         }
 
         log_debug(this, "Chebyshev::SolveNonPrecond_()", " #*# end");
@@ -320,9 +442,66 @@ namespace rocalution
 
         ValueType two = static_cast<ValueType>(2);
         ValueType alpha, beta;
+        bool      first = true;
         ValueType d = (this->lambda_max_ + this->lambda_min_) / two;
         ValueType c = (this->lambda_max_ - this->lambda_min_) / two;
 
+        // Differentiate between smoothing and non-smoothing, as we can skip norm
+        // computation in smoothing case
+        if(this->is_smoother_)
+        {
+            // Number of smoothing steps to perform
+            int steps = this->iter_ctrl_.GetMaximumIterations();
+
+            if(steps < 1)
+            {
+                return;
+            }
+
+            // Feed some dummy residual to initialize IterationControl class
+            this->iter_ctrl_.InitResidual(1.0);
+
+            for(int iter = 0; iter < steps; ++iter)
+            {
+                // compute residual = b - Ax
+                op->Apply(*x, r);
+                r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+                // Solve Mz=r
+                this->PrecondSolveZeroSol_(*r, z);
+
+                if(iter == 0)
+                {
+                    // p = z
+                    p->CopyFrom(*z);
+
+                    alpha = static_cast<ValueType>(1) / d;
+                }
+                else
+                {
+                    // beta_1 = (c alpha_1)^2 / 2, beta_i = (c alpha_i / 2)^2
+                    beta = (c * alpha / two) * (c * alpha / two);
+
+                    if(iter == 1)
+                    {
+                        beta *= two;
+                    }
+
+                    alpha = static_cast<ValueType>(1) / (d - beta / alpha);
+
+                    // p = beta*p + z
+                    p->ScaleAdd(beta, *z);
+                }
+
+                // x = x + alpha*p
+                x->AddScale(*p, alpha);
+            }
+
+            log_debug(this, "Chebyshev::SolvePrecond_()", " #*# end");
+
+            return;
+        }
+
         // initial residual = b - Ax
         op->Apply(*x, r);
         r->ScaleAdd(static_cast<ValueType>(-1), rhs);
@@ -337,12 +516,12 @@ namespace rocalution
         }
 
         // Solve Mz=r
-        this->precond_->SolveZeroSol(*r, z);
+        this->PrecondSolveZeroSol_(*r, z);
 
         // p = z
         p->CopyFrom(*z);
 
-        alpha = two / d;
+        alpha = static_cast<ValueType>(1) / d;
 
         // x = x + alpha*p
         x->AddScale(*p, alpha);
@@ -350,16 +529,23 @@ namespace rocalution
         // compute residual = b - Ax
         op->Apply(*x, r);
         r->ScaleAdd(static_cast<ValueType>(-1), rhs);
-        res = this->Norm_(*r);
+        res = this->ResidualNorm_(*r);
 
         while(!this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
         {
             // Solve Mz=r
-            this->precond_->SolveZeroSol(*r, z);
+            this->PrecondSolveZeroSol_(*r, z);
 
+            // beta_1 = (c alpha_1)^2 / 2, beta_i = (c alpha_i / 2)^2
             beta = (c * alpha / two) * (c * alpha / two);
 
-            alpha = static_cast<ValueType>(1) / (d - beta);
+            if(first == true)
+            {
+                beta *= two;
+                first = false;
+            }
+
+            alpha = static_cast<ValueType>(1) / (d - beta / alpha);
 
             // p = beta*p + z
             p->ScaleAdd(beta, *z);
@@ -370,7 +556,7 @@ namespace rocalution
             // compute residual = b - Ax
             op->Apply(*x, r);
             r->ScaleAdd(static_cast<ValueType>(-1), rhs);
-            res = this->Norm_(*r);
+            res = this->ResidualNorm_(*r);
         }
 
         log_debug(this, "Chebyshev::SolvePrecond_()", " #*# end");
@@ -409,4 +595,15 @@ namespace rocalution
                              std::complex<float>>;
 #endif
 
+    template class Chebyshev<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class Chebyshev<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Chebyshev<LocalShellOperator<std::complex<double>>,
+                             LocalVector<std::complex<double>>,
+                             std::complex<double>>;
+    template class Chebyshev<LocalShellOperator<std::complex<float>>,
+                             LocalVector<std::complex<float>>,
+                             std::complex<float>>;
+#endif
+
 } // namespace rocalution
@@ -60,6 +60,29 @@ namespace rocalution
         ROCALUTION_EXPORT
         void Set(ValueType lambda_min, ValueType lambda_max);
 
+        /** \brief Estimate the eigenvalues of the (preconditioned) operator in Build()
+        * \details
+        * The extreme eigenvalues are estimated by \p steps Lanczos (CG) iterations on the
+        * (preconditioned) operator. The largest estimate is multiplied by
+        * \p safety_factor. If \p ratio is positive, the minimum eigenvalue is set to
+        * \p ratio times the maximum eigenvalue, which targets the upper part of the
+        * spectrum, e.g. when Chebyshev is used as a smoother. Otherwise, the smallest
+        * estimate is divided by \p safety_factor. The operator has to be symmetric
+        * positive definite. Calling Set() with explicit eigenvalues disables the
+        * estimation.
+        *
+        * \par Example
+        * \code{.cpp}
+        *   Chebyshev<LocalMatrix<double>, LocalVector<double>, double> ls;
+        *
+        *   ls.SetOperator(mat);
+        *   ls.SetSpectrumEstimation(10, 1.1);
+        *   ls.Build();
+        * \endcode
+        */
+        ROCALUTION_EXPORT
+        void SetSpectrumEstimation(int steps = 10, double safety_factor = 1.1, double ratio = 0.0);
+
         ROCALUTION_EXPORT
         virtual void Build(void);
         ROCALUTION_EXPORT
@@ -81,6 +104,13 @@ namespace rocalution
         bool      init_lambda_;
         ValueType lambda_min_, lambda_max_;
 
+        // Spectrum estimation, disabled if estimate_steps_ is zero
+        int    estimate_steps_;
+        double estimate_safety_;
+        double estimate_ratio_;
+
+        void EstimateLambda_(void);
+
         VectorType r_, z_;
         VectorType p_;
     };
@@ -72,6 +72,8 @@ namespace rocalution
     {
         log_debug(this, "Inversion::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("Inversion::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -85,6 +87,9 @@ namespace rocalution
         assert(this->op_->GetM() > 0);
 
         this->inverse_.CloneFrom(*this->op_);
+
+        // The inverse is dense, keep it in DENSE format to apply it with rocBLAS
+        this->inverse_.ConvertToDENSE();
         this->inverse_.Invert();
 
         log_debug(this, "Inversion::Build()", this->build_, " #*# end");
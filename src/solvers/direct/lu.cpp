@@ -73,6 +73,8 @@ namespace rocalution
     {
         log_debug(this, "LU::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("LU::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -86,6 +88,14 @@ namespace rocalution
         assert(this->op_->GetM() > 0);
 
         this->lu_.CloneFrom(*this->op_);
+
+        // Keep the factors in DENSE format, such that the accelerator factorizes and
+        // solves with rocSOLVER and rocBLAS without leaving the device
+        if(this->solver_descr_.GetActiveTriSolverAlg() != TriSolverAlg_Iterative)
+        {
+            this->lu_.ConvertToDENSE();
+        }
+
         this->lu_.LUFactorize();
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->lu_, LUAnalyse);
 
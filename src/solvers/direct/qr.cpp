@@ -72,6 +72,8 @@ namespace rocalution
     {
         log_debug(this, "QR::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("QR::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -85,6 +87,10 @@ namespace rocalution
         assert(this->op_->GetM() > 0);
 
         this->qr_.CloneFrom(*this->op_);
+
+        // Keep the factors in DENSE format, such that the accelerator factorizes and
+        // solves with rocSOLVER and rocBLAS without leaving the device
+        this->qr_.ConvertToDENSE();
         this->qr_.QRDecompose();
 
         log_debug(this, "QR::Build()", this->build_, " #*# end");
@@ -0,0 +1,447 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "sparse_lu.hpp"
+#include "../../utils/def.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+namespace rocalution
+{
+
+    // Pattern of the L and U factors of a square matrix, given by its CSR structure,
+    // without pivoting. The fill is taken from the elimination tree of the symmetrized
+    // pattern, such that the pattern of U is the transpose of the pattern of L. Columns
+    // are sorted, the arrays are allocated on the host.
+    static void sparse_lu_symbolic(int            n,
+                                   const PtrType* row_offset,
+                                   const int*     col,
+                                   PtrType**      lu_row_offset,
+                                   int**          lu_col,
+                                   int64_t&       lu_nnz)
+    {
+        // Strictly lower triangle of A + A^T
+        std::vector<PtrType> lower_ptr(n + 1, 0);
+
+        for(int i = 0; i < n; ++i)
+        {
+            for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                if(col[j] != i)
+                {
+                    ++lower_ptr[std::max(i, col[j]) + 1];
+                }
+            }
+        }
+
+        for(int i = 0; i < n; ++i)
+        {
+            lower_ptr[i + 1] += lower_ptr[i];
+        }
+
+        std::vector<int>     lower(lower_ptr[n]);
+        std::vector<PtrType> pos(lower_ptr.begin(), lower_ptr.end() - 1);
+
+        for(int i = 0; i < n; ++i)
+        {
+            for(PtrType j = row_offset[i]; j < row_offset[i + 1]; ++j)
+            {
+                if(col[j] != i)
+                {
+                    lower[pos[std::max(i, col[j])]++] = std::min(i, col[j]);
+                }
+            }
+        }
+
+        // Elimination tree, with path compression of the ancestors
+        std::vector<int> parent(n, -1);
+        std::vector<int> ancestor(n, -1);
+
+        for(int i = 0; i < n; ++i)
+        {
+            for(PtrType k = lower_ptr[i]; k < lower_ptr[i + 1]; ++k)
+            {
+                int j = lower[k];
+
+                while(ancestor[j] != -1 && ancestor[j] != i)
+                {
+                    int next    = ancestor[j];
+                    ancestor[j] = i;
+                    j           = next;
+                }
+
+                if(ancestor[j] == -1)
+                {
+                    ancestor[j] = i;
+                    parent[j]   = i;
+                }
+            }
+        }
+
+        // Row i of L is the union of the paths from its entries up to i in the tree
+        std::vector<int> mark(n, -1);
+        std::vector<int> row;
+
+        auto row_pattern = [&](int i) {
+            row.clear();
+            mark[i] = i;
+
+            for(PtrType k = lower_ptr[i]; k < lower_ptr[i + 1]; ++k)
+            {
+                for(int j = lower[k]; mark[j] != i; j = parent[j])
+                {
+                    mark[j] = i;
+                    row.push_back(j);
+                }
+            }
+        };
+
+        // Row i holds L(i, :), the diagonal and U(i, :) = L(:, i)^T
+        std::vector<PtrType> nnz_l(n, 0);
+        std::vector<PtrType> nnz_u(n, 0);
+
+        for(int i = 0; i < n; ++i)
+        {
+            row_pattern(i);
+
+            nnz_l[i] = static_cast<PtrType>(row.size());
+
+            for(int j : row)
+            {
+                ++nnz_u[j];
+            }
+        }
+
+        allocate_host(n + 1, lu_row_offset);
+
+        (*lu_row_offset)[0] = 0;
+
+        for(int i = 0; i < n; ++i)
+        {
+            (*lu_row_offset)[i + 1] = (*lu_row_offset)[i] + nnz_l[i] + 1 + nnz_u[i];
+        }
+
+        lu_nnz = (*lu_row_offset)[n];
+
+        allocate_host(lu_nnz, lu_col);
+
+        // Next free position of the U part of each row
+        for(int i = 0; i < n; ++i)
+        {
+            nnz_u[i] = (*lu_row_offset)[i] + nnz_l[i] + 1;
+        }
+
+        for(int i = 0; i < n; ++i)
+        {
+            row_pattern(i);
+
+            std::sort(row.begin(), row.end());
+
+            PtrType p = (*lu_row_offset)[i];
+
+            for(int j : row)
+            {
+                (*lu_col)[p++] = j;
+
+                // Rows are visited in increasing order, U columns stay sorted
+                (*lu_col)[nnz_u[j]++] = i;
+            }
+
+            (*lu_col)[p] = i;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SparseLU<OperatorType, VectorType, ValueType>::SparseLU()
+    {
+        log_debug(this, "SparseLU::SparseLU()");
+
+        this->nd_leaf_size_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SparseLU<OperatorType, VectorType, ValueType>::~SparseLU()
+    {
+        log_debug(this, "SparseLU::~SparseLU()");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("Sparse LU solver");
+
+        if(this->build_ == true)
+        {
+            LOG_INFO("Sparse LU ordering = "
+                     << (this->nd_leaf_size_ > 0 ? "nested dissection" : "AMD"));
+            LOG_INFO("Sparse LU nnz(L+U) = " << this->lu_.GetNnz());
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        LOG_INFO("Sparse LU direct solver starts");
+        this->solver_descr_.Print();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        LOG_INFO("Sparse LU ends");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::SetNestedDissection(int leaf_size)
+    {
+        log_debug(this, "SparseLU::SetNestedDissection()", leaf_size);
+
+        assert(leaf_size >= 0);
+        assert(this->build_ == false);
+
+        this->nd_leaf_size_ = leaf_size;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int64_t SparseLU<OperatorType, VectorType, ValueType>::GetFactorNnz(void) const
+    {
+        return this->lu_.GetNnz();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "SparseLU::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("SparseLU::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+
+        int n = static_cast<int>(this->op_->GetM());
+
+        // Fill-reducing ordering
+        this->permutation_.CloneBackend(*this->op_);
+
+        if(this->nd_leaf_size_ > 0)
+        {
+            int  num_nodes   = 0;
+            int* node_offset = NULL;
+            int* node_parent = NULL;
+
+            this->op_->NestedDissection(
+                num_nodes, &node_offset, &node_parent, &this->permutation_, this->nd_leaf_size_);
+
+            free_host(&node_offset);
+            free_host(&node_parent);
+        }
+        else
+        {
+            this->op_->AMD(&this->permutation_);
+        }
+
+        // Symbolic factorization of the permuted structure on the host
+        OperatorType A;
+        A.CloneFrom(*this->op_);
+        A.ConvertToCSR();
+        A.Permute(this->permutation_);
+
+        PtrType*   row_offset = NULL;
+        int*       col        = NULL;
+        ValueType* val        = NULL;
+
+        allocate_host(n + 1, &row_offset);
+        allocate_host(A.GetNnz(), &col);
+        allocate_host(A.GetNnz(), &val);
+
+        A.CopyToCSR(row_offset, col, val);
+        A.Clear();
+
+        free_host(&val);
+
+        PtrType* lu_row_offset = NULL;
+        int*     lu_col        = NULL;
+        int64_t  lu_nnz        = 0;
+
+        sparse_lu_symbolic(n, row_offset, col, &lu_row_offset, &lu_col, lu_nnz);
+
+        free_host(&row_offset);
+        free_host(&col);
+
+        allocate_host(lu_nnz, &val);
+        set_to_zero_host(lu_nnz, val);
+
+        this->lu_.SetDataPtrCSR(&lu_row_offset, &lu_col, &val, "Sparse LU", lu_nnz, n, n);
+        this->lu_.CloneBackend(*this->op_);
+
+        // Numerical factorization on the backend of the operator
+        this->Factorize_();
+
+        DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->lu_, LUAnalyse);
+
+        this->rhs_.CloneBackend(*this->op_);
+        this->x_.CloneBackend(*this->op_);
+
+        this->rhs_.Allocate("Permuted rhs", n);
+        this->x_.Allocate("Permuted solution", n);
+
+        log_debug(this, "SparseLU::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "SparseLU::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == false)
+        {
+            this->Build();
+            return;
+        }
+
+        ROCALUTION_RANGE("SparseLU::ReBuildNumeric()");
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->lu_.GetM());
+
+        // Ordering, pattern and analysis of the triangular solves are kept
+        this->Factorize_();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::Factorize_(void)
+    {
+        log_debug(this, "SparseLU::Factorize_()");
+
+        OperatorType A;
+        A.CloneFrom(*this->op_);
+        A.ConvertToCSR();
+        A.Permute(this->permutation_);
+
+        // The exact LU factorization is ILU(0) on the pattern of the fill-in
+        this->lu_.Zeros();
+        this->lu_.MatrixAdd(A, static_cast<ValueType>(0), static_cast<ValueType>(1), false);
+        this->lu_.ILU0Factorize();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "SparseLU::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->lu_, LUAnalyseClear);
+            this->lu_.Clear();
+
+            this->permutation_.Clear();
+            this->rhs_.Clear();
+            this->x_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "SparseLU::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->lu_.MoveToHost();
+            this->permutation_.MoveToHost();
+            this->rhs_.MoveToHost();
+            this->x_.MoveToHost();
+
+            DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->lu_, LUAnalyse);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "SparseLU::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->lu_.MoveToAccelerator();
+            this->permutation_.MoveToAccelerator();
+            this->rhs_.MoveToAccelerator();
+            this->x_.MoveToAccelerator();
+
+            DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->lu_, LUAnalyse);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SparseLU<OperatorType, VectorType, ValueType>::Solve_(const VectorType& rhs,
+                                                               VectorType*       x)
+    {
+        log_debug(this, "SparseLU::Solve_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->build_ == true);
+
+        this->rhs_.CopyFromPermute(rhs, this->permutation_);
+
+        DISPATCH_OPERATOR_SOLVE_STRATEGY(
+            this->solver_descr_, this->lu_, LUSolve, this->rhs_, &this->x_);
+
+        x->CopyFromPermuteBackward(this->x_, this->permutation_);
+
+        log_debug(this, "SparseLU::Solve_()", " #*# end");
+    }
+
+    template class SparseLU<LocalMatrix<double>, LocalVector<double>, double>;
+    template class SparseLU<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SparseLU<LocalMatrix<std::complex<double>>,
+                            LocalVector<std::complex<double>>,
+                            std::complex<double>>;
+    template class SparseLU<LocalMatrix<std::complex<float>>,
+                            LocalVector<std::complex<float>>,
+                            std::complex<float>>;
+#endif
+
+} // namespace rocalution
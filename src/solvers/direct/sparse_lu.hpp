@@ -0,0 +1,116 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_DIRECT_SPARSE_LU_HPP_
+#define ROCALUTION_DIRECT_SPARSE_LU_HPP_
+
+#include "../../base/local_vector.hpp"
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class SparseLU
+  * \brief Sparse LU Decomposition
+  * \details
+  * Sparse LU factorizes a square matrix in CSR format without converting it to dense.
+  * The rows and columns are first reordered by a fill-reducing ordering (approximate
+  * minimum degree by default, optionally nested dissection). The symbolic phase
+  * computes the pattern of the factors from the elimination tree of the symmetrized
+  * pattern. The numerical phase is an ILU(0) factorization on this pattern, which is
+  * the exact LU factorization and runs on the backend of the operator, as do the
+  * triangular solves. No pivoting is performed, the solver is intended for matrices
+  * that can be factorized in any order, such as symmetric positive definite or
+  * diagonally dominant matrices.
+  *
+  * The ordering and the symbolic phase are computed on the host in Build() and kept
+  * by ReBuildNumeric(), which only refactorizes the values of an operator with the
+  * same sparsity pattern. This makes SparseLU suitable as coarse grid solver of
+  * multigrid and as block solver of BlockJacobi or AS for systems well beyond the size
+  * that the dense LU can handle.
+  *
+  * \tparam OperatorType - can be LocalMatrix
+  * \tparam VectorType - can be LocalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class SparseLU : public DirectLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        SparseLU();
+        ROCALUTION_EXPORT
+        virtual ~SparseLU();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Order by nested dissection instead of approximate minimum degree
+        * \details
+        * Nested dissection produces independent subtrees, which increases the level
+        * parallelism of the triangular solves. Subsets with at most \p leaf_size rows
+        * are ordered by approximate minimum degree, \p leaf_size = 0 switches back to
+        * approximate minimum degree ordering of the whole matrix.
+        */
+        ROCALUTION_EXPORT
+        void SetNestedDissection(int leaf_size);
+
+        /** \brief Return the number of non-zero entries of the L and U factors */
+        ROCALUTION_EXPORT
+        int64_t GetFactorNnz(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void Solve_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        /** \brief Factorize the values of the operator on the pattern of lu_ */
+        void Factorize_(void);
+
+        OperatorType lu_;
+
+        LocalVector<int> permutation_;
+
+        VectorType rhs_;
+        VectorType x_;
+
+        int nd_leaf_size_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_DIRECT_SPARSE_LU_HPP_
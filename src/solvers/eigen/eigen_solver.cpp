@@ -0,0 +1,352 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "eigen_solver.hpp"
+#include "../../utils/def.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_shell_operator.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    EigenSolver<OperatorType, VectorType, ValueType>::EigenSolver()
+    {
+        log_debug(this, "EigenSolver::EigenSolver()");
+
+        this->op_ = NULL;
+
+        this->nev_    = 1;
+        this->target_ = EigenTarget_Smallest;
+
+        this->tol_      = 1e-6;
+        this->max_iter_ = 1000;
+
+        this->iter_  = 0;
+        this->nconv_ = 0;
+
+        this->verb_  = 1;
+        this->build_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    EigenSolver<OperatorType, VectorType, ValueType>::~EigenSolver()
+    {
+        log_debug(this, "EigenSolver::~EigenSolver()");
+
+        this->FreeBlock_(this->X_);
+        this->FreeBlock_(this->X0_);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::SetOperator(const OperatorType& op)
+    {
+        log_debug(this, "EigenSolver::SetOperator()", (const void*&)op);
+
+        assert(this->build_ == false);
+
+        this->op_ = &op;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::SetNumberOfEigenpairs(int nev)
+    {
+        log_debug(this, "EigenSolver::SetNumberOfEigenpairs()", nev);
+
+        assert(nev > 0);
+        assert(this->build_ == false);
+
+        this->nev_ = nev;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::SetTarget(EigenTarget target)
+    {
+        log_debug(this, "EigenSolver::SetTarget()", target);
+
+        this->target_ = target;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::SetInitialGuess(
+        int count, const VectorType* const* x)
+    {
+        log_debug(this, "EigenSolver::SetInitialGuess()", count, x);
+
+        assert(count >= 0);
+        assert(x != NULL || count == 0);
+
+        this->FreeBlock_(this->X0_);
+
+        for(int i = 0; i < count; ++i)
+        {
+            assert(x[i] != NULL);
+
+            VectorType* v = new VectorType;
+            v->CloneFrom(*x[i]);
+
+            this->X0_.push_back(v);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::Init(double tol, int max_iter)
+    {
+        log_debug(this, "EigenSolver::Init()", tol, max_iter);
+
+        assert(tol > 0.0);
+        assert(max_iter > 0);
+
+        this->tol_      = tol;
+        this->max_iter_ = max_iter;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "EigenSolver::Build()", this->build_, " #*# begin");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() >= this->nev_);
+
+        this->AllocateBlock_(this->X_, this->nev_, "X");
+
+        this->lambda_.assign(this->nev_, static_cast<ValueType>(0));
+        this->res_.assign(this->nev_, 0.0);
+
+        this->iter_  = 0;
+        this->nconv_ = 0;
+
+        this->build_ = true;
+
+        log_debug(this, "EigenSolver::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "EigenSolver::Clear()", this->build_);
+
+        this->FreeBlock_(this->X_);
+
+        this->lambda_.clear();
+        this->res_.clear();
+
+        this->iter_  = 0;
+        this->nconv_ = 0;
+
+        this->build_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int EigenSolver<OperatorType, VectorType, ValueType>::GetNumberOfConvergedEigenpairs(
+        void) const
+    {
+        return this->nconv_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    ValueType EigenSolver<OperatorType, VectorType, ValueType>::GetEigenvalue(int i) const
+    {
+        assert(i >= 0);
+        assert(i < static_cast<int>(this->lambda_.size()));
+
+        return this->lambda_[i];
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    const VectorType& EigenSolver<OperatorType, VectorType, ValueType>::GetEigenvector(int i) const
+    {
+        assert(i >= 0);
+        assert(i < static_cast<int>(this->X_.size()));
+
+        return *this->X_[i];
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    double EigenSolver<OperatorType, VectorType, ValueType>::GetResidualNorm(int i) const
+    {
+        assert(i >= 0);
+        assert(i < static_cast<int>(this->res_.size()));
+
+        return this->res_[i];
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int EigenSolver<OperatorType, VectorType, ValueType>::GetIterationCount(void) const
+    {
+        return this->iter_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::MoveToHost(void)
+    {
+        log_debug(this, "EigenSolver::MoveToHost()");
+
+        for(size_t i = 0; i < this->X_.size(); ++i)
+        {
+            this->X_[i]->MoveToHost();
+        }
+
+        for(size_t i = 0; i < this->X0_.size(); ++i)
+        {
+            this->X0_[i]->MoveToHost();
+        }
+
+        this->MoveToHostLocalData_();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::MoveToAccelerator(void)
+    {
+        log_debug(this, "EigenSolver::MoveToAccelerator()");
+
+        for(size_t i = 0; i < this->X_.size(); ++i)
+        {
+            this->X_[i]->MoveToAccelerator();
+        }
+
+        for(size_t i = 0; i < this->X0_.size(); ++i)
+        {
+            this->X0_[i]->MoveToAccelerator();
+        }
+
+        this->MoveToAcceleratorLocalData_();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::Verbose(int verb)
+    {
+        log_debug(this, "EigenSolver::Verbose()", verb);
+
+        this->verb_ = verb;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::AllocateBlock_(
+        std::vector<VectorType*>& V, int n, const std::string& name) const
+    {
+        assert(this->op_ != NULL);
+
+        V.resize(n);
+
+        for(int i = 0; i < n; ++i)
+        {
+            V[i] = new VectorType;
+            V[i]->CloneBackend(*this->op_);
+            V[i]->Allocate(name, this->op_->GetM());
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::FreeBlock_(
+        std::vector<VectorType*>& V) const
+    {
+        for(size_t i = 0; i < V.size(); ++i)
+        {
+            delete V[i];
+        }
+
+        V.clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void EigenSolver<OperatorType, VectorType, ValueType>::InitialBlock_(
+        std::vector<VectorType*>& V) const
+    {
+        for(size_t i = 0; i < V.size(); ++i)
+        {
+            if(i < this->X0_.size())
+            {
+                V[i]->CopyFrom(*this->X0_[i]);
+            }
+            else
+            {
+                V[i]->SetRandomUniform(12345ULL + i);
+            }
+        }
+    }
+
+    template class EigenSolver<LocalMatrix<double>, LocalVector<double>, double>;
+    template class EigenSolver<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class EigenSolver<LocalMatrix<std::complex<double>>,
+                               LocalVector<std::complex<double>>,
+                               std::complex<double>>;
+    template class EigenSolver<LocalMatrix<std::complex<float>>,
+                               LocalVector<std::complex<float>>,
+                               std::complex<float>>;
+#endif
+
+    template class EigenSolver<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class EigenSolver<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class EigenSolver<GlobalMatrix<std::complex<double>>,
+                               GlobalVector<std::complex<double>>,
+                               std::complex<double>>;
+    template class EigenSolver<GlobalMatrix<std::complex<float>>,
+                               GlobalVector<std::complex<float>>,
+                               std::complex<float>>;
+#endif
+
+    template class EigenSolver<LocalStencil<double>, LocalVector<double>, double>;
+    template class EigenSolver<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class EigenSolver<LocalStencil<std::complex<double>>,
+                               LocalVector<std::complex<double>>,
+                               std::complex<double>>;
+    template class EigenSolver<LocalStencil<std::complex<float>>,
+                               LocalVector<std::complex<float>>,
+                               std::complex<float>>;
+#endif
+
+    template class EigenSolver<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class EigenSolver<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class EigenSolver<LocalShellOperator<std::complex<double>>,
+                               LocalVector<std::complex<double>>,
+                               std::complex<double>>;
+    template class EigenSolver<LocalShellOperator<std::complex<float>>,
+                               LocalVector<std::complex<float>>,
+                               std::complex<float>>;
+#endif
+
+} // namespace rocalution
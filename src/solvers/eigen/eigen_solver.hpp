@@ -0,0 +1,208 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_EIGEN_EIGEN_SOLVER_HPP_
+#define ROCALUTION_EIGEN_EIGEN_SOLVER_HPP_
+
+#include "../../base/base_rocalution.hpp"
+#include "rocalution/export.hpp"
+
+#include <string>
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \brief Part of the spectrum that is computed by an EigenSolver
+  */
+    typedef enum _eigen_target : unsigned int
+    {
+        /** \brief Eigenvalues of smallest (algebraic) value */
+        EigenTarget_Smallest = 0,
+        /** \brief Eigenvalues of largest (algebraic) value */
+        EigenTarget_Largest = 1
+    } EigenTarget;
+
+    /** \ingroup solver_module
+  * \class EigenSolver
+  * \brief Base class for eigenvalue solvers
+  * \details
+  * An EigenSolver computes a few extreme eigenpairs \f$Ax_{i} = \lambda_{i}x_{i}\f$ of a
+  * Hermitian operator \f$A\f$. The solvers only access the operator through Apply() and
+  * the vectors through block operations (see LocalVector::MultiDot() and
+  * LocalVector::MultiAddScale()), such that they run on the backend of the operator.
+  *
+  * The interface is
+  * - SetOperator() to set the operator \f$A\f$.
+  * - SetNumberOfEigenpairs() and SetTarget() to select the wanted eigenpairs.
+  * - Init() to set the tolerance and the maximum number of iterations.
+  * - Build() to allocate the solver.
+  * - Solve() to compute the eigenpairs, which are then returned by GetEigenvalue() and
+  *   GetEigenvector().
+  *
+  * An eigenpair is converged if \f$\|Ax_{i} - \lambda_{i}x_{i}\|_{2} \leq tol
+  * |\lambda_{i}|\f$. The eigenvalues are returned sorted, starting with the extreme one,
+  * e.g. they provide the spectral bounds for AIChebyshev or Chebyshev, and the
+  * eigenvectors can be used as a deflation space of DeflatedCG.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class EigenSolver : public RocalutionObj
+    {
+    public:
+        ROCALUTION_EXPORT
+        EigenSolver();
+        ROCALUTION_EXPORT
+        virtual ~EigenSolver();
+
+        /** \brief Set the Operator of the eigenvalue solver */
+        ROCALUTION_EXPORT
+        void SetOperator(const OperatorType& op);
+
+        /** \brief Set the number of wanted eigenpairs, default is 1 */
+        ROCALUTION_EXPORT
+        void SetNumberOfEigenpairs(int nev);
+
+        /** \brief Set the wanted part of the spectrum, default is \ref EigenTarget_Smallest */
+        ROCALUTION_EXPORT
+        void SetTarget(EigenTarget target);
+
+        /** \brief Set initial guesses for the eigenvectors
+        * \details
+        * The \p count vectors are copied, e.g. the eigenvectors of a previous solve with
+        * a similar operator. Missing vectors are initialized randomly.
+        */
+        ROCALUTION_EXPORT
+        void SetInitialGuess(int count, const VectorType* const* x);
+
+        /** \brief Initialize the solver with relative tolerance and maximum number of
+        * iterations */
+        ROCALUTION_EXPORT
+        void Init(double tol, int max_iter);
+
+        /** \brief Print information about the solver */
+        virtual void Print(void) const = 0;
+
+        /** \brief Build the solver */
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+
+        /** \brief Clear (free all local data) the solver */
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Compute the wanted eigenpairs */
+        virtual void Solve(void) = 0;
+
+        /** \brief Return the number of converged eigenpairs of the last Solve() */
+        ROCALUTION_EXPORT
+        int GetNumberOfConvergedEigenpairs(void) const;
+
+        /** \brief Return the i-th eigenvalue */
+        ROCALUTION_EXPORT
+        ValueType GetEigenvalue(int i) const;
+
+        /** \brief Return the i-th eigenvector, which is normalized */
+        ROCALUTION_EXPORT
+        const VectorType& GetEigenvector(int i) const;
+
+        /** \brief Return the residual norm \f$\|Ax_{i} - \lambda_{i}x_{i}\|_{2}\f$ of the
+        * i-th eigenpair */
+        ROCALUTION_EXPORT
+        double GetResidualNorm(int i) const;
+
+        /** \brief Return the number of iterations of the last Solve() */
+        ROCALUTION_EXPORT
+        int GetIterationCount(void) const;
+
+        /** \brief Move all data to the host */
+        ROCALUTION_EXPORT
+        virtual void MoveToHost(void);
+        /** \brief Move all data to the accelerator */
+        ROCALUTION_EXPORT
+        virtual void MoveToAccelerator(void);
+
+        /** \brief Provide verbose output of the solver
+        * \details
+        * - verb = 0 -> no output
+        * - verb = 1 -> print info about the solver (start, end);
+        * - verb = 2 -> print the number of converged eigenpairs per iteration;
+        */
+        ROCALUTION_EXPORT
+        virtual void Verbose(int verb = 1);
+
+    protected:
+        /** \brief Allocate n vectors on the backend of the operator */
+        void AllocateBlock_(std::vector<VectorType*>& V, int n, const std::string& name) const;
+        /** \brief Free a block of vectors */
+        void FreeBlock_(std::vector<VectorType*>& V) const;
+        /** \brief Fill a block of vectors with the initial guesses and random vectors */
+        void InitialBlock_(std::vector<VectorType*>& V) const;
+
+        /** \brief Move all local data to the host */
+        virtual void MoveToHostLocalData_(void) = 0;
+        /** \brief Move all local data to the accelerator */
+        virtual void MoveToAcceleratorLocalData_(void) = 0;
+
+        /** \brief Pointer to the operator */
+        const OperatorType* op_;
+
+        /** \brief Number of wanted eigenpairs */
+        int nev_;
+        /** \brief Wanted part of the spectrum */
+        EigenTarget target_;
+
+        /** \brief Relative tolerance */
+        double tol_;
+        /** \brief Maximum number of iterations */
+        int max_iter_;
+
+        /** \brief Number of iterations of the last solve */
+        int iter_;
+        /** \brief Number of converged eigenpairs of the last solve */
+        int nconv_;
+
+        /** \brief Eigenvalues */
+        std::vector<ValueType> lambda_;
+        /** \brief Eigenvectors */
+        std::vector<VectorType*> X_;
+        /** \brief Residual norms of the eigenpairs */
+        std::vector<double> res_;
+
+        /** \brief Initial guesses */
+        std::vector<VectorType*> X0_;
+
+        /** \brief Verbose level */
+        int verb_;
+
+        /** \brief Flag == true after building the solver */
+        bool build_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_EIGEN_EIGEN_SOLVER_HPP_
@@ -0,0 +1,419 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "lanczos.hpp"
+#include "../../utils/def.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_shell_operator.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+#include "../../utils/type_traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    Lanczos<OperatorType, VectorType, ValueType>::Lanczos()
+    {
+        log_debug(this, "Lanczos::Lanczos()", "default constructor");
+
+        this->size_basis_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    Lanczos<OperatorType, VectorType, ValueType>::~Lanczos()
+    {
+        log_debug(this, "Lanczos::~Lanczos()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Lanczos<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("Thick-restart Lanczos eigenvalue solver, basis size = "
+                 << static_cast<int>(this->V_.size()) - 1);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Lanczos<OperatorType, VectorType, ValueType>::SetBasisSize(int size_basis)
+    {
+        log_debug(this, "Lanczos::SetBasisSize()", size_basis);
+
+        assert(size_basis >= 0);
+        assert(this->build_ == false);
+
+        this->size_basis_ = size_basis;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Lanczos<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "Lanczos::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("Lanczos::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        EigenSolver<OperatorType, VectorType, ValueType>::Build();
+
+        int k = this->nev_;
+        int m = (this->size_basis_ > 0) ? this->size_basis_ : std::max(2 * k, k + 16);
+
+        m = static_cast<int>(std::min(static_cast<int64_t>(m), this->op_->GetM()));
+
+        // At least one unwanted Ritz vector is needed for a restart
+        assert(m > k);
+
+        this->AllocateBlock_(this->V_, m + 1, "V");
+        this->AllocateBlock_(this->Vn_, m, "V");
+
+        this->T_.resize(m * m);
+
+        log_debug(this, "Lanczos::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Lanczos<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "Lanczos::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->FreeBlock_(this->V_);
+            this->FreeBlock_(this->Vn_);
+
+            this->T_.clear();
+
+            EigenSolver<OperatorType, VectorType, ValueType>::Clear();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Lanczos<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "Lanczos::MoveToHostLocalData_()", this->build_);
+
+        for(size_t i = 0; i < this->V_.size(); ++i)
+        {
+            this->V_[i]->MoveToHost();
+        }
+
+        for(size_t i = 0; i < this->Vn_.size(); ++i)
+        {
+            this->Vn_[i]->MoveToHost();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Lanczos<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "Lanczos::MoveToAcceleratorLocalData_()", this->build_);
+
+        for(size_t i = 0; i < this->V_.size(); ++i)
+        {
+            this->V_[i]->MoveToAccelerator();
+        }
+
+        for(size_t i = 0; i < this->Vn_.size(); ++i)
+        {
+            this->Vn_[i]->MoveToAccelerator();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Lanczos<OperatorType, VectorType, ValueType>::Solve(void)
+    {
+        log_debug(this, "Lanczos::Solve()", " #*# begin");
+
+        assert(this->build_ == true);
+        assert(this->op_ != NULL);
+
+        if(this->verb_ > 0)
+        {
+            this->Print();
+        }
+
+        typedef numeric_traits_t<ValueType> RealType;
+
+        const OperatorType* op = this->op_;
+
+        int k = this->nev_;
+        int m = static_cast<int>(this->V_.size()) - 1;
+
+        std::vector<ValueType> h(m);
+        std::vector<ValueType> hsum(m);
+        std::vector<ValueType> S(m * m);
+        std::vector<ValueType> U(m * m);
+        std::vector<double>    theta(m);
+
+        // Start vector v0 = sum of the initial guesses, or random
+        VectorType* v0 = this->V_[0];
+
+        if(this->X0_.empty())
+        {
+            v0->SetRandomUniform(12345ULL);
+        }
+        else
+        {
+            v0->CopyFrom(*this->X0_[0]);
+
+            for(size_t i = 1; i < this->X0_.size(); ++i)
+            {
+                v0->AddScale(*this->X0_[i], static_cast<ValueType>(1));
+            }
+        }
+
+        v0->Scale(static_cast<ValueType>(1) / v0->Norm());
+
+        std::fill(this->T_.begin(), this->T_.end(), static_cast<ValueType>(0));
+
+        double anorm = 0.0;
+        double beta  = 0.0;
+        int    nkeep = 0;
+
+        this->iter_  = 0;
+        this->nconv_ = 0;
+
+        while(true)
+        {
+            int  mm        = m;
+            bool invariant = false;
+
+            // Extend the basis from the kept Ritz vectors to m vectors
+            for(int j = nkeep; j < m; ++j)
+            {
+                VectorType* w = this->V_[j + 1];
+
+                op->Apply(*this->V_[j], w);
+
+                ++this->iter_;
+
+                // Full reorthogonalization, the coefficients are column j of V^H A V
+                std::fill(hsum.begin(), hsum.begin() + j + 1, static_cast<ValueType>(0));
+
+                for(int pass = 0; pass < 2; ++pass)
+                {
+                    w->MultiDot(j + 1, this->V_.data(), h.data());
+
+                    for(int i = 0; i <= j; ++i)
+                    {
+                        hsum[i] += h[i];
+                        h[i] = -h[i];
+                    }
+
+                    w->MultiAddScale(j + 1, this->V_.data(), h.data());
+                }
+
+                for(int i = 0; i < j; ++i)
+                {
+                    this->T_[i + j * m] = hsum[i];
+                    this->T_[j + i * m] = rocalution_conj(hsum[i]);
+                }
+
+                this->T_[j + j * m] = static_cast<ValueType>(std::real(hsum[j]));
+
+                beta = static_cast<double>(std::abs(w->Norm()));
+
+                double colnorm = beta * beta;
+
+                for(int i = 0; i <= j; ++i)
+                {
+                    colnorm += static_cast<double>(std::norm(hsum[i]));
+                }
+
+                anorm = std::max(anorm, std::sqrt(colnorm));
+
+                // The Krylov subspace is invariant, its Ritz pairs are exact
+                if(beta <= static_cast<double>(std::numeric_limits<RealType>::epsilon()) * anorm)
+                {
+                    mm        = j + 1;
+                    invariant = true;
+                    break;
+                }
+
+                w->Scale(static_cast<ValueType>(1.0 / beta));
+
+                if(this->iter_ >= this->max_iter_)
+                {
+                    mm = j + 1;
+                    break;
+                }
+            }
+
+            // Ritz pairs of the projected operator
+            for(int j = 0; j < mm; ++j)
+            {
+                for(int i = 0; i < mm; ++i)
+                {
+                    S[i + j * mm] = this->T_[i + j * m];
+                }
+            }
+
+            rocalution_hermitian_eigensystem(mm, S.data(), theta.data(), U.data());
+
+            int nwant = std::min(k, mm);
+
+            // The residual norm of a Ritz pair is beta times the last entry of its
+            // eigenvector
+            this->nconv_ = 0;
+
+            for(int i = 0; i < nwant; ++i)
+            {
+                int col = (this->target_ == EigenTarget_Smallest) ? i : mm - 1 - i;
+
+                this->lambda_[i] = static_cast<ValueType>(theta[col]);
+                this->res_[i]
+                    = invariant ? 0.0 : beta * static_cast<double>(std::abs(U[mm - 1 + col * mm]));
+
+                if(this->res_[i] <= this->tol_ * std::abs(theta[col]))
+                {
+                    ++this->nconv_;
+                }
+            }
+
+            if(this->verb_ > 1)
+            {
+                LOG_INFO("Lanczos iteration " << this->iter_ << ": " << this->nconv_ << " of "
+                                              << k << " eigenpairs converged");
+            }
+
+            bool done = (this->nconv_ == k) || invariant || (this->iter_ >= this->max_iter_);
+
+            // Thick restart with the wanted Ritz vectors, or the final eigenvectors
+            int nnew = done ? nwant : std::min(k + (m - k) / 2, m - 1);
+
+            for(int i = 0; i < nnew; ++i)
+            {
+                int col = (this->target_ == EigenTarget_Smallest) ? i : mm - 1 - i;
+
+                this->Vn_[i]->Zeros();
+                this->Vn_[i]->MultiAddScale(mm, this->V_.data(), U.data() + col * mm);
+            }
+
+            if(done == true)
+            {
+                for(int i = 0; i < nwant; ++i)
+                {
+                    this->X_[i]->CopyFrom(*this->Vn_[i]);
+                }
+
+                break;
+            }
+
+            // V = [Ritz vectors, v_m] and T = diag(theta), the coupling of v_m to the
+            // Ritz vectors is computed in the next extension step
+            for(int i = 0; i < nnew; ++i)
+            {
+                std::swap(this->V_[i], this->Vn_[i]);
+            }
+
+            std::swap(this->V_[nnew], this->V_[m]);
+
+            std::fill(this->T_.begin(), this->T_.end(), static_cast<ValueType>(0));
+
+            for(int i = 0; i < nnew; ++i)
+            {
+                int col = (this->target_ == EigenTarget_Smallest) ? i : mm - 1 - i;
+
+                this->T_[i + i * m] = static_cast<ValueType>(theta[col]);
+            }
+
+            nkeep = nnew;
+        }
+
+        if(this->verb_ > 0)
+        {
+            LOG_INFO("Lanczos: " << this->nconv_ << " of " << k << " eigenpairs converged after "
+                                 << this->iter_ << " iterations");
+
+            for(int i = 0; i < k; ++i)
+            {
+                LOG_INFO("Lanczos: lambda_" << i << " = " << this->lambda_[i]
+                                            << "; residual = " << this->res_[i]);
+            }
+        }
+
+        log_debug(this, "Lanczos::Solve()", " #*# end");
+    }
+
+    template class Lanczos<LocalMatrix<double>, LocalVector<double>, double>;
+    template class Lanczos<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Lanczos<LocalMatrix<std::complex<double>>,
+                           LocalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class Lanczos<LocalMatrix<std::complex<float>>,
+                           LocalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+    template class Lanczos<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class Lanczos<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Lanczos<GlobalMatrix<std::complex<double>>,
+                           GlobalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class Lanczos<GlobalMatrix<std::complex<float>>,
+                           GlobalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+    template class Lanczos<LocalStencil<double>, LocalVector<double>, double>;
+    template class Lanczos<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Lanczos<LocalStencil<std::complex<double>>,
+                           LocalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class Lanczos<LocalStencil<std::complex<float>>,
+                           LocalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+    template class Lanczos<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class Lanczos<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Lanczos<LocalShellOperator<std::complex<double>>,
+                           LocalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class Lanczos<LocalShellOperator<std::complex<float>>,
+                           LocalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+} // namespace rocalution
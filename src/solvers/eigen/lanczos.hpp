@@ -0,0 +1,104 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_EIGEN_LANCZOS_HPP_
+#define ROCALUTION_EIGEN_LANCZOS_HPP_
+
+#include "eigen_solver.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class Lanczos
+  * \brief Thick-Restart Lanczos Method
+  * \details
+  * The Lanczos method computes the \f$k\f$ smallest (or largest) eigenpairs of a
+  * Hermitian operator \f$A\f$ from the Ritz pairs of the Krylov subspace
+  * \f$\mathcal{K}_{m}(v_{0}, A)\f$. When the basis is full, it is restarted with the
+  * \f$k + (m - k)/2\f$ wanted Ritz vectors and the last Lanczos vector, which keeps
+  * the memory bounded without losing the converging Ritz vectors. \cite trlan
+  * As for any single vector Krylov method, only one copy of a multiple eigenvalue is
+  * found, LOBPCG should be used for clustered or multiple eigenvalues.
+  *
+  * The basis is fully reorthogonalized with two classical Gram-Schmidt passes of fused
+  * multi-vector operations, which avoids spurious copies of converged eigenvalues.
+  * Compared to LOBPCG, no preconditioner is used and only one operator application is
+  * needed per iteration, such that it is well suited for spectral bounds, e.g. for
+  * AIChebyshev. The iteration count and the maximum number of iterations refer to the
+  * number of operator applications.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class Lanczos : public EigenSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        Lanczos();
+        ROCALUTION_EXPORT
+        virtual ~Lanczos();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Set the maximum dimension of the Krylov subspace, which has to be set
+        * before Build(); default is max(2k, k + 16) */
+        ROCALUTION_EXPORT
+        void SetBasisSize(int size_basis);
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Compute the wanted eigenpairs
+        * \details
+        * The start vector is the sum of the initial guesses, or a random vector.
+        */
+        ROCALUTION_EXPORT
+        virtual void Solve(void);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        int size_basis_;
+
+        // Lanczos basis (m + 1 vectors) and workspace of the restart
+        std::vector<VectorType*> V_;
+        std::vector<VectorType*> Vn_;
+
+        // Projected operator V^H A V
+        std::vector<ValueType> T_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_EIGEN_LANCZOS_HPP_
@@ -0,0 +1,599 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "lobpcg.hpp"
+#include "../../utils/def.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_shell_operator.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+#include "../../utils/type_traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <math.h>
+
+namespace rocalution
+{
+
+    // Number of iterations after which AX is recomputed
+    static const int _lobpcg_refresh_interval = 10;
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    LOBPCG<OperatorType, VectorType, ValueType>::LOBPCG()
+    {
+        log_debug(this, "LOBPCG::LOBPCG()", "default constructor");
+
+        this->precond_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    LOBPCG<OperatorType, VectorType, ValueType>::~LOBPCG()
+    {
+        log_debug(this, "LOBPCG::~LOBPCG()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LOBPCG<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("LOBPCG eigenvalue solver");
+        }
+        else
+        {
+            LOG_INFO("LOBPCG eigenvalue solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LOBPCG<OperatorType, VectorType, ValueType>::SetPreconditioner(
+        Solver<OperatorType, VectorType, ValueType>& precond)
+    {
+        log_debug(this, "LOBPCG::SetPreconditioner()", (const void*&)precond);
+
+        assert(this->build_ == false);
+
+        this->precond_ = &precond;
+        this->precond_->FlagPrecond();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LOBPCG<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "LOBPCG::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("LOBPCG::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        EigenSolver<OperatorType, VectorType, ValueType>::Build();
+
+        int k = this->nev_;
+
+        // The projection basis [X, W, P] has at most 3k vectors
+        assert(this->op_->GetM() >= 3 * k);
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+            this->precond_->Build();
+        }
+
+        this->AllocateBlock_(this->AX_, k, "AX");
+        this->AllocateBlock_(this->R_, k, "R");
+        this->AllocateBlock_(this->W_, k, "W");
+        this->AllocateBlock_(this->AW_, k, "AW");
+        this->AllocateBlock_(this->P_, k, "P");
+        this->AllocateBlock_(this->AP_, k, "AP");
+
+        this->AllocateBlock_(this->Xn_, k, "X");
+        this->AllocateBlock_(this->AXn_, k, "AX");
+        this->AllocateBlock_(this->Pn_, k, "P");
+        this->AllocateBlock_(this->APn_, k, "AP");
+
+        log_debug(this, "LOBPCG::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LOBPCG<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "LOBPCG::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->FreeBlock_(this->AX_);
+            this->FreeBlock_(this->R_);
+            this->FreeBlock_(this->W_);
+            this->FreeBlock_(this->AW_);
+            this->FreeBlock_(this->P_);
+            this->FreeBlock_(this->AP_);
+
+            this->FreeBlock_(this->Xn_);
+            this->FreeBlock_(this->AXn_);
+            this->FreeBlock_(this->Pn_);
+            this->FreeBlock_(this->APn_);
+
+            this->S_.clear();
+            this->AS_.clear();
+
+            this->theta_.clear();
+            this->Y_.clear();
+
+            EigenSolver<OperatorType, VectorType, ValueType>::Clear();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LOBPCG<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "LOBPCG::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->nev_; ++i)
+            {
+                this->AX_[i]->MoveToHost();
+                this->R_[i]->MoveToHost();
+                this->W_[i]->MoveToHost();
+                this->AW_[i]->MoveToHost();
+                this->P_[i]->MoveToHost();
+                this->AP_[i]->MoveToHost();
+
+                this->Xn_[i]->MoveToHost();
+                this->AXn_[i]->MoveToHost();
+                this->Pn_[i]->MoveToHost();
+                this->APn_[i]->MoveToHost();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LOBPCG<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "LOBPCG::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->nev_; ++i)
+            {
+                this->AX_[i]->MoveToAccelerator();
+                this->R_[i]->MoveToAccelerator();
+                this->W_[i]->MoveToAccelerator();
+                this->AW_[i]->MoveToAccelerator();
+                this->P_[i]->MoveToAccelerator();
+                this->AP_[i]->MoveToAccelerator();
+
+                this->Xn_[i]->MoveToAccelerator();
+                this->AXn_[i]->MoveToAccelerator();
+                this->Pn_[i]->MoveToAccelerator();
+                this->APn_[i]->MoveToAccelerator();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    bool LOBPCG<OperatorType, VectorType, ValueType>::RayleighRitz_(int s)
+    {
+        log_debug(this, "LOBPCG::RayleighRitz_()", s);
+
+        int k = this->nev_;
+
+        // Projected operator K = S^H A S and Gram matrix G = S^H S
+        std::vector<ValueType> K(s * s);
+        std::vector<ValueType> G(s * s);
+
+        for(int j = 0; j < s; ++j)
+        {
+            this->AS_[j]->MultiDot(s, this->S_.data(), K.data() + j * s);
+            this->S_[j]->MultiDot(s, this->S_.data(), G.data() + j * s);
+        }
+
+        for(int j = 0; j < s; ++j)
+        {
+            for(int i = 0; i < j; ++i)
+            {
+                ValueType kij = static_cast<ValueType>(0.5)
+                                * (K[i + j * s] + rocalution_conj(K[j + i * s]));
+                ValueType gij = static_cast<ValueType>(0.5)
+                                * (G[i + j * s] + rocalution_conj(G[j + i * s]));
+
+                K[i + j * s] = kij;
+                K[j + i * s] = rocalution_conj(kij);
+                G[i + j * s] = gij;
+                G[j + i * s] = rocalution_conj(gij);
+            }
+        }
+
+        // Numerically dependent basis vectors are dropped by a pivoted Cholesky
+        // factorization of G, the first r pivots span the basis
+        typedef numeric_traits_t<ValueType> RealType;
+
+        std::vector<ValueType> C(G);
+        std::vector<int>       perm(s);
+
+        int r = rocalution_cholesky_pivoted(
+            s,
+            C.data(),
+            perm.data(),
+            static_cast<double>(std::sqrt(std::numeric_limits<RealType>::epsilon())));
+
+        if(r < k)
+        {
+            return false;
+        }
+
+        std::vector<ValueType> Kr(r * r);
+        std::vector<ValueType> Gr(r * r);
+
+        for(int j = 0; j < r; ++j)
+        {
+            for(int i = 0; i < r; ++i)
+            {
+                Kr[i + j * r] = K[perm[i] + perm[j] * s];
+                Gr[i + j * r] = G[perm[i] + perm[j] * s];
+            }
+        }
+
+        // Ritz pairs K y = theta G y of the reduced basis, ascending
+        std::vector<double>    w(r);
+        std::vector<ValueType> V(r * r);
+
+        if(rocalution_hermitian_generalized_eigensystem(
+               r, Kr.data(), Gr.data(), w.data(), V.data())
+           == false)
+        {
+            return false;
+        }
+
+        this->theta_.resize(k);
+        this->Y_.assign(k * s, static_cast<ValueType>(0));
+
+        for(int i = 0; i < k; ++i)
+        {
+            int col = (this->target_ == EigenTarget_Smallest) ? i : r - 1 - i;
+
+            this->theta_[i] = w[col];
+
+            for(int j = 0; j < r; ++j)
+            {
+                this->Y_[perm[j] + i * s] = V[j + col * r];
+            }
+        }
+
+        return true;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LOBPCG<OperatorType, VectorType, ValueType>::Solve(void)
+    {
+        log_debug(this, "LOBPCG::Solve()", " #*# begin");
+
+        assert(this->build_ == true);
+        assert(this->op_ != NULL);
+
+        if(this->verb_ > 0)
+        {
+            this->Print();
+        }
+
+        const OperatorType* op = this->op_;
+
+        int k = this->nev_;
+
+        std::vector<ValueType> h(k);
+        std::vector<bool>      active(k, true);
+
+        // X = X0 and AX = A X0
+        this->InitialBlock_(this->X_);
+
+        for(int i = 0; i < k; ++i)
+        {
+            op->Apply(*this->X_[i], this->AX_[i]);
+        }
+
+        this->S_.assign(this->X_.begin(), this->X_.end());
+        this->AS_.assign(this->AX_.begin(), this->AX_.end());
+
+        int s  = k;
+        int np = 0;
+
+        this->iter_  = 0;
+        this->nconv_ = 0;
+
+        while(true)
+        {
+            // Rayleigh-Ritz on [X, W, P], without P if the reduced basis is still degenerate
+            bool ritz = this->RayleighRitz_(s);
+
+            if(ritz == false && np > 0)
+            {
+                s -= np;
+                np = 0;
+
+                ritz = this->RayleighRitz_(s);
+            }
+
+            if(ritz == false)
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: LOBPCG::Solve() the search space is numerically "
+                                 "linearly dependent");
+                break;
+            }
+
+            // X = S y, P = [W, P] y and their images, using the coefficients of W and P only
+            for(int i = 0; i < k; ++i)
+            {
+                const ValueType* y = this->Y_.data() + i * s;
+
+                this->Xn_[i]->Zeros();
+                this->Xn_[i]->MultiAddScale(s, this->S_.data(), y);
+                this->AXn_[i]->Zeros();
+                this->AXn_[i]->MultiAddScale(s, this->AS_.data(), y);
+
+                if(s > k)
+                {
+                    this->Pn_[i]->Zeros();
+                    this->Pn_[i]->MultiAddScale(s - k, this->S_.data() + k, y + k);
+                    this->APn_[i]->Zeros();
+                    this->APn_[i]->MultiAddScale(s - k, this->AS_.data() + k, y + k);
+                }
+            }
+
+            this->X_.swap(this->Xn_);
+            this->AX_.swap(this->AXn_);
+
+            if(s > k)
+            {
+                this->P_.swap(this->Pn_);
+                this->AP_.swap(this->APn_);
+            }
+
+            bool have_p = (s > k);
+
+            // AX drifts from A X by the rounding errors of the implicit updates, it is
+            // recomputed periodically and before convergence is accepted
+            bool exact = (this->iter_ % _lobpcg_refresh_interval == 0);
+
+            while(true)
+            {
+                if(exact == true)
+                {
+                    for(int i = 0; i < k; ++i)
+                    {
+                        op->Apply(*this->X_[i], this->AX_[i]);
+                    }
+                }
+
+                // Residuals R = AX - X theta
+                this->nconv_ = 0;
+
+                for(int i = 0; i < k; ++i)
+                {
+                    this->lambda_[i] = static_cast<ValueType>(this->theta_[i]);
+
+                    this->R_[i]->CopyFrom(*this->AX_[i]);
+                    this->R_[i]->AddScale(*this->X_[i],
+                                          static_cast<ValueType>(-this->theta_[i]));
+
+                    this->res_[i] = static_cast<double>(std::abs(this->R_[i]->Norm()));
+
+                    active[i] = (this->res_[i] > this->tol_ * std::abs(this->theta_[i]));
+
+                    if(active[i] == false)
+                    {
+                        ++this->nconv_;
+                    }
+                }
+
+                if(this->nconv_ < k || exact == true)
+                {
+                    break;
+                }
+
+                exact = true;
+            }
+
+            if(this->verb_ > 1)
+            {
+                LOG_INFO("LOBPCG iteration " << this->iter_ << ": " << this->nconv_ << " of " << k
+                                             << " eigenpairs converged");
+            }
+
+            if(this->nconv_ == k || this->iter_ >= this->max_iter_)
+            {
+                break;
+            }
+
+            ++this->iter_;
+
+            // W = M^-1 R for the active eigenpairs, orthogonalized against X and normalized
+            this->S_.assign(this->X_.begin(), this->X_.end());
+            this->AS_.assign(this->AX_.begin(), this->AX_.end());
+
+            int na = 0;
+
+            for(int i = 0; i < k; ++i)
+            {
+                if(active[i] == false)
+                {
+                    continue;
+                }
+
+                VectorType* w  = this->W_[na];
+                VectorType* aw = this->AW_[na];
+
+                if(this->precond_ != NULL)
+                {
+                    this->precond_->SolveZeroSol(*this->R_[i], w);
+                }
+                else
+                {
+                    w->CopyFrom(*this->R_[i]);
+                }
+
+                w->MultiDot(k, this->S_.data(), h.data());
+
+                for(int j = 0; j < k; ++j)
+                {
+                    h[j] = -h[j];
+                }
+
+                w->MultiAddScale(k, this->S_.data(), h.data());
+
+                ValueType nrm = w->Norm();
+
+                if(std::abs(nrm) > 0)
+                {
+                    w->Scale(static_cast<ValueType>(1) / nrm);
+                }
+
+                op->Apply(*w, aw);
+
+                ++na;
+            }
+
+            for(int i = 0; i < na; ++i)
+            {
+                this->S_.push_back(this->W_[i]);
+                this->AS_.push_back(this->AW_[i]);
+            }
+
+            // Normalized search directions of the active eigenpairs
+            np = 0;
+
+            for(int i = 0; i < k && have_p; ++i)
+            {
+                if(active[i] == false)
+                {
+                    continue;
+                }
+
+                ValueType nrm = this->P_[i]->Norm();
+
+                if(std::abs(nrm) > 0)
+                {
+                    this->P_[i]->Scale(static_cast<ValueType>(1) / nrm);
+                    this->AP_[i]->Scale(static_cast<ValueType>(1) / nrm);
+                }
+
+                this->S_.push_back(this->P_[i]);
+                this->AS_.push_back(this->AP_[i]);
+
+                ++np;
+            }
+
+            s = k + na + np;
+        }
+
+        if(this->verb_ > 0)
+        {
+            LOG_INFO("LOBPCG: " << this->nconv_ << " of " << k << " eigenpairs converged after "
+                                << this->iter_ << " iterations");
+
+            for(int i = 0; i < k; ++i)
+            {
+                LOG_INFO("LOBPCG: lambda_" << i << " = " << this->lambda_[i]
+                                           << "; residual = " << this->res_[i]);
+            }
+        }
+
+        log_debug(this, "LOBPCG::Solve()", " #*# end");
+    }
+
+    template class LOBPCG<LocalMatrix<double>, LocalVector<double>, double>;
+    template class LOBPCG<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class LOBPCG<LocalMatrix<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class LOBPCG<LocalMatrix<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class LOBPCG<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class LOBPCG<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class LOBPCG<GlobalMatrix<std::complex<double>>,
+                          GlobalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class LOBPCG<GlobalMatrix<std::complex<float>>,
+                          GlobalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class LOBPCG<LocalStencil<double>, LocalVector<double>, double>;
+    template class LOBPCG<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class LOBPCG<LocalStencil<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class LOBPCG<LocalStencil<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class LOBPCG<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class LOBPCG<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class LOBPCG<LocalShellOperator<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class LOBPCG<LocalShellOperator<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,109 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_EIGEN_LOBPCG_HPP_
+#define ROCALUTION_EIGEN_LOBPCG_HPP_
+
+#include "../solver.hpp"
+#include "eigen_solver.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class LOBPCG
+  * \brief Locally Optimal Block Preconditioned Conjugate Gradient Method
+  * \details
+  * LOBPCG computes the \f$k\f$ smallest (or largest) eigenpairs of a Hermitian operator
+  * \f$A\f$ by Rayleigh-Ritz projections onto the span of the current eigenvector
+  * approximations \f$X\f$, the preconditioned residuals \f$W = M^{-1}(AX - X\Lambda)\f$
+  * and the previous search directions \f$P\f$. \cite lobpcg
+  *
+  * The preconditioner \f$M\f$ should approximate \f$A\f$ (or \f$A - \sigma I\f$ for a
+  * shift \f$\sigma\f$ below the wanted eigenvalues), e.g. a multigrid solver, which
+  * makes the convergence for the smallest eigenpairs of elliptic operators independent
+  * of the mesh size. Per iteration, the operator is applied to \f$k\f$ vectors, the
+  * preconditioner is applied to \f$k\f$ vectors, and the projected matrices are
+  * computed with fused multi-vector operations.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class LOBPCG : public EigenSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        LOBPCG();
+        ROCALUTION_EXPORT
+        virtual ~LOBPCG();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Set the preconditioner, which has to be set before Build() */
+        ROCALUTION_EXPORT
+        void SetPreconditioner(Solver<OperatorType, VectorType, ValueType>& precond);
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        ROCALUTION_EXPORT
+        virtual void Solve(void);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        // Rayleigh-Ritz projection onto the first s vectors of S_, returns false if the
+        // basis does not contain k numerically independent vectors
+        bool RayleighRitz_(int s);
+
+        Solver<OperatorType, VectorType, ValueType>* precond_;
+
+        std::vector<VectorType*> AX_;
+        std::vector<VectorType*> R_;
+        std::vector<VectorType*> W_, AW_;
+        std::vector<VectorType*> P_, AP_;
+
+        std::vector<VectorType*> Xn_, AXn_;
+        std::vector<VectorType*> Pn_, APn_;
+
+        // Basis [X, W, P] of the projection and its image
+        std::vector<const VectorType*> S_, AS_;
+
+        // Ritz values and coefficients of the wanted Ritz vectors
+        std::vector<double>    theta_;
+        std::vector<ValueType> Y_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_EIGEN_LOBPCG_HPP_
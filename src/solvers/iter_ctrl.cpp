@@ -25,7 +25,9 @@
 #include "../utils/def.hpp"
 #include "../utils/log.hpp"
 #include "../utils/math_functions.hpp"
+#include "solve_handle.hpp"
 
+#include <algorithm>
 #include <complex>
 #include <cstdlib>
 #include <fstream>
@@ -40,6 +42,8 @@ namespace rocalution
         this->residual_history_.clear();
         this->iteration_ = 0;
 
+        this->iteration_range_ = false;
+
         this->init_res_ = false;
         this->rec_      = false;
         this->verb_     = 1;
@@ -49,11 +53,17 @@ namespace rocalution
         this->current_res_      = 0.0;
         this->current_index_    = -1;
 
+        this->handle_ = NULL;
+
         this->absolute_tol_   = 1e-15;
         this->relative_tol_   = 1e-6;
         this->divergence_tol_ = 1e+8;
         this->minimum_iter_   = 0;
         this->maximum_iter_   = 1000000;
+        this->check_interval_ = 1;
+
+        this->stagnation_window_ = 0;
+        this->stagnation_rate_   = 1.0;
     }
 
     IterationControl::~IterationControl()
@@ -63,7 +73,10 @@ namespace rocalution
 
     void IterationControl::Clear(void)
     {
+        this->EndIterationRange();
+
         this->residual_history_.clear();
+        this->window_history_.clear();
         this->iteration_ = 0;
 
         this->init_res_ = false;
@@ -88,12 +101,17 @@ namespace rocalution
 
     bool IterationControl::InitResidual(double res)
     {
+        this->EndIterationRange();
+
         this->init_res_         = true;
         this->initial_residual_ = res;
 
         this->reached_   = 0;
         this->iteration_ = 0;
 
+        this->window_history_.clear();
+        this->window_history_.push_back(std::make_pair(0, std::abs(res)));
+
         if(this->verb_ > 0)
         {
             LOG_INFO("IterationControl initial residual = " << res);
@@ -118,9 +136,30 @@ namespace rocalution
             return false;
         }
 
+        // Open the range marker of the first iteration
+        ROCALUTION_RANGE_PUSH("Iteration");
+        this->iteration_range_ = true;
+
         return true;
     }
 
+    void IterationControl::InitIteration(int iter, double res)
+    {
+        assert(this->init_res_ == true);
+        assert(iter >= 0);
+
+        this->iteration_   = iter;
+        this->current_res_ = res;
+
+        this->window_history_.clear();
+        this->window_history_.push_back(std::make_pair(iter, std::abs(res)));
+
+        if(this->verb_ > 0)
+        {
+            LOG_INFO("IterationControl resumed at iter=" << iter << "; residual=" << res);
+        }
+    }
+
     void IterationControl::InitTolerance(double abs, double rel, double div)
     {
         this->absolute_tol_   = abs;
@@ -172,6 +211,34 @@ namespace rocalution
         return this->maximum_iter_;
     }
 
+    void IterationControl::InitCheckInterval(int interval)
+    {
+        assert(interval > 0);
+
+        this->check_interval_ = interval;
+    }
+
+    void IterationControl::InitStagnation(int window, double rate)
+    {
+        assert(window >= 0);
+        assert(rate > 0.0);
+
+        this->stagnation_window_ = window;
+        this->stagnation_rate_   = rate;
+    }
+
+    int IterationControl::GetCheckInterval(void) const
+    {
+        return this->check_interval_;
+    }
+
+    bool IterationControl::CheckNext(void) const
+    {
+        int next = this->iteration_ + 1;
+
+        return (next % this->check_interval_ == 0) || (next >= this->maximum_iter_);
+    }
+
     int IterationControl::GetIterationCount(void) const
     {
         return this->iteration_;
@@ -182,6 +249,11 @@ namespace rocalution
         return this->current_res_;
     }
 
+    double IterationControl::GetInitialResidual(void) const
+    {
+        return this->initial_residual_;
+    }
+
     int64_t IterationControl::GetAmaxResidualIndex(void) const
     {
         return this->current_index_;
@@ -196,9 +268,27 @@ namespace rocalution
     {
         assert(this->init_res_ == true);
 
+        this->EndIterationRange();
+
+        // Only count the iteration, if its residual is not checked
+        if(this->CheckNext() == false)
+        {
+            this->iteration_++;
+
+            ROCALUTION_RANGE_PUSH("Iteration");
+            this->iteration_range_ = true;
+
+            return false;
+        }
+
         this->iteration_++;
         this->current_res_ = res;
 
+        if(this->handle_ != NULL)
+        {
+            this->handle_->Progress_(this->iteration_, res, 0);
+        }
+
         if(this->verb_ > 1)
         {
             LOG_INFO("IterationControl iter=" << this->iteration_ << "; residual=" << res);
@@ -244,12 +334,60 @@ namespace rocalution
             return true;
         }
 
+        if(this->stagnation_window_ > 0)
+        {
+            // Keep the newest residual that is at least window iterations old at the front
+            int oldest = this->iteration_ - this->stagnation_window_;
+
+            while(this->window_history_.size() > 1 && this->window_history_[1].first <= oldest)
+            {
+                this->window_history_.pop_front();
+            }
+
+            if(this->iteration_ >= this->minimum_iter_
+               && this->window_history_.front().first <= oldest
+               && std::abs(res) > this->stagnation_rate_ * this->window_history_.front().second)
+            {
+                this->reached_ = 5;
+                return true;
+            }
+
+            this->window_history_.push_back(std::make_pair(this->iteration_, std::abs(res)));
+        }
+
+        // Open the range marker of the next iteration
+        ROCALUTION_RANGE_PUSH("Iteration");
+        this->iteration_range_ = true;
+
         return false;
     }
 
+    void IterationControl::EndIterationRange(void)
+    {
+        if(this->iteration_range_ == true)
+        {
+            ROCALUTION_RANGE_POP();
+            this->iteration_range_ = false;
+        }
+    }
+
+    void IterationControl::SetSolveHandle(SolveHandle* handle)
+    {
+        if(this->handle_ != NULL)
+        {
+            this->handle_->Progress_(this->iteration_, this->current_res_, this->reached_);
+        }
+
+        this->handle_ = handle;
+    }
+
     bool IterationControl::CheckResidual(double res, int64_t index)
     {
-        this->current_index_ = index;
+        if(this->CheckNext() == true)
+        {
+            this->current_index_ = index;
+        }
+
         return this->CheckResidual(res);
     }
 
@@ -289,6 +427,12 @@ namespace rocalution
             return true;
         }
 
+        // Stagnation detected within a restart cycle terminates the solver
+        if(this->reached_ == 5)
+        {
+            return true;
+        }
+
         return false;
     }
 
@@ -334,7 +478,10 @@ namespace rocalution
 
         file.setf(std::ios::scientific);
 
-        for(int n = 0; n < this->iteration_; n++)
+        // With a check interval, only every check_interval_-th residual is recorded
+        int size = static_cast<int>(this->residual_history_.size());
+
+        for(int n = 0; n < std::min(this->iteration_, size); n++)
         {
             file << this->residual_history_[n] << std::endl;
         }
@@ -363,6 +510,13 @@ namespace rocalution
                      << "div tol=" << this->divergence_tol_ << "; "
                      << "max iter=" << this->maximum_iter_);
         }
+
+        if(this->stagnation_window_ > 0)
+        {
+            LOG_INFO("IterationControl stagnation criteria: "
+                     << "window=" << this->stagnation_window_ << "; "
+                     << "rate=" << this->stagnation_rate_);
+        }
     }
 
     void IterationControl::PrintStatus(void)
@@ -397,6 +551,13 @@ namespace rocalution
                      << "iter=" << this->iteration_);
             break;
 
+        case 5:
+            LOG_INFO("IterationControl STAGNATION criteria has been reached: "
+                     << "res norm=" << std::abs(this->current_res_) << "; "
+                     << "rel val=" << this->current_res_ / this->initial_residual_ << "; "
+                     << "iter=" << this->iteration_);
+            break;
+
         default:
             LOG_INFO("IterationControl NO criteria has been reached: "
                      << "res norm=" << std::abs(this->current_res_) << "; "
@@ -24,11 +24,14 @@
 #ifndef ROCALUTION_ITER_CTRL_HPP_
 #define ROCALUTION_ITER_CTRL_HPP_
 
+#include <deque>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace rocalution
 {
+    class SolveHandle;
 
     // Iteration control for iterative solvers, monitor the
     // residual (L2 norm) behavior
@@ -62,9 +65,27 @@ namespace rocalution
         // Get the maximal number of iterations
         int GetMaximumIterations(void) const;
 
+        // Set the interval (in iterations) at which the residual is checked
+        void InitCheckInterval(int interval);
+
+        // Get the interval (in iterations) at which the residual is checked
+        int GetCheckInterval(void) const;
+
+        // Set the stagnation criteria, the iteration is stopped if the residual has not
+        // decreased below rate times the residual of window iterations before
+        // (window = 0 disables the criteria)
+        void InitStagnation(int window, double rate);
+
+        // Return true if the residual of the next iteration is going to be checked
+        bool CheckNext(void) const;
+
         // Initialize the initial residual
         bool InitResidual(double res);
 
+        // Continue the iteration count of a resumed solve at iteration iter with
+        // residual res (after InitResidual() with its initial residual)
+        void InitIteration(int iter, double res);
+
         // Clear (reset)
         void Clear(void);
 
@@ -102,12 +123,23 @@ namespace rocalution
         // Return the current residual
         double GetCurrentResidual(void) const;
 
+        // Return the initial residual
+        double GetInitialResidual(void) const;
+
         // Return the current status
         int GetSolverStatus(void) const;
 
         // Return absolute maximum index of residual vector when using Linf norm
         int64_t GetAmaxResidualIndex(void) const;
 
+        // Close the range marker of the current iteration, if a solver terminates
+        // without a final residual check
+        void EndIterationRange(void);
+
+        // Report the progress to handle, NULL detaches the current handle after
+        // reporting the final status to it
+        void SetSolveHandle(SolveHandle* handle);
+
     private:
         // Verbose flag
         // verb == 0 no output
@@ -118,6 +150,9 @@ namespace rocalution
         // Iteration count
         int iteration_;
 
+        // Flag == true while the range marker of an iteration is open
+        bool iteration_range_;
+
         // Flag == true after calling InitResidual()
         bool init_res_;
 
@@ -134,13 +169,25 @@ namespace rocalution
         int minimum_iter_;
         // Maximum number of iteration
         int maximum_iter_;
+        // Residual check interval, the residual passed to CheckResidual()
+        // is ignored on all other iterations
+        int check_interval_;
+
+        // Stagnation window (in iterations) and rate, window = 0 disables the criteria
+        int    stagnation_window_;
+        double stagnation_rate_;
+
+        // Residuals of the checked iterations within the stagnation window, the oldest
+        // entry is at the front
+        std::deque<std::pair<int, double>> window_history_;
 
         // Indicator for the reached criteria:
         // 0 - not yet;
         // 1 - abs tol is reached;
         // 2 - rel tol is reached;
         // 3 - div tol is reached;
-        // 4 - max iter is reached
+        // 4 - max iter is reached;
+        // 5 - stagnation is detected
         int reached_;
 
         // STL vector keeping the residual history
@@ -154,6 +201,9 @@ namespace rocalution
 
         // Flag == true then the residual is recorded in the residual_history_ vector
         bool rec_;
+
+        // Handle of an asynchronous solve, NULL if the progress is not reported
+        SolveHandle* handle_;
     };
 
 } // namespace rocalution
@@ -0,0 +1,88 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "batch_bicgstab.hpp"
+#include "../../utils/def.hpp"
+#include "../../utils/log.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    template <typename ValueType>
+    BatchBiCGStab<ValueType>::BatchBiCGStab()
+    {
+        log_debug(this, "BatchBiCGStab::BatchBiCGStab()", "default constructor");
+    }
+
+    template <typename ValueType>
+    BatchBiCGStab<ValueType>::~BatchBiCGStab()
+    {
+        log_debug(this, "BatchBiCGStab::~BatchBiCGStab()", "destructor");
+
+        this->Clear();
+    }
+
+    template <typename ValueType>
+    std::string BatchBiCGStab<ValueType>::Name_(void) const
+    {
+        return "BatchBiCGStab";
+    }
+
+    template <typename ValueType>
+    void BatchBiCGStab<ValueType>::Print(void) const
+    {
+        switch(this->precond_)
+        {
+        case BatchPrecondNone:
+            LOG_INFO("BatchBiCGStab solver");
+            break;
+        case BatchPrecondJacobi:
+            LOG_INFO("BatchBiCGStab solver, with Jacobi preconditioner");
+            break;
+        case BatchPrecondILU0:
+            LOG_INFO("BatchBiCGStab solver, with ILU(0) preconditioner");
+            break;
+        }
+    }
+
+    template <typename ValueType>
+    void BatchBiCGStab<ValueType>::Solve(const LocalMultiVector<ValueType>& rhs,
+                                         LocalMultiVector<ValueType>*       x)
+    {
+        log_debug(this, "BatchBiCGStab::Solve()", " #*# begin", (const void*&)rhs, x);
+
+        this->Solve_(0, rhs, x);
+
+        log_debug(this, "BatchBiCGStab::Solve()", " #*# end");
+    }
+
+    template class BatchBiCGStab<double>;
+    template class BatchBiCGStab<float>;
+#ifdef SUPPORT_COMPLEX
+    template class BatchBiCGStab<std::complex<double>>;
+    template class BatchBiCGStab<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,68 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_BATCH_BICGSTAB_HPP_
+#define ROCALUTION_KRYLOV_BATCH_BICGSTAB_HPP_
+
+#include "../batch_solver.hpp"
+#include "rocalution/export.hpp"
+
+#include <string>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class BatchBiCGStab
+  * \brief Batched Bi-Conjugate Gradient Stabilized Method
+  * \details
+  * The batched BiCGStab method solves all (non) symmetric systems of a LocalBatchMatrix
+  * at once. On accelerators, each system is iterated by its own thread block, and the
+  * whole solve is carried out by a single kernel. The optional preconditioner (see
+  * BaseBatchSolver::SetPreconditioner()) is applied from the right.
+  * \cite SAAD
+  *
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <typename ValueType>
+    class BatchBiCGStab : public BaseBatchSolver<ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        BatchBiCGStab();
+        ROCALUTION_EXPORT
+        virtual ~BatchBiCGStab();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Solve(const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x);
+
+    protected:
+        virtual std::string Name_(void) const;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_BATCH_BICGSTAB_HPP_
@@ -0,0 +1,76 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_BATCH_GMRES_HPP_
+#define ROCALUTION_KRYLOV_BATCH_GMRES_HPP_
+
+#include "../batch_solver.hpp"
+#include "rocalution/export.hpp"
+
+#include <string>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class BatchGMRES
+  * \brief Batched Generalized Minimum Residual Method
+  * \details
+  * The batched restarted GMRES method solves all systems of a LocalBatchMatrix at once.
+  * On accelerators, each system is iterated by its own thread block, and the whole
+  * solve is carried out by a single kernel. The Krylov basis is orthogonalized by
+  * modified Gram-Schmidt and the optional preconditioner (see
+  * BaseBatchSolver::SetPreconditioner()) is applied from the right.
+  * \cite SAAD
+  *
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <typename ValueType>
+    class BatchGMRES : public BaseBatchSolver<ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        BatchGMRES();
+        ROCALUTION_EXPORT
+        virtual ~BatchGMRES();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Solve(const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x);
+
+        /** \brief Set the size of the Krylov subspace basis (default 10) */
+        ROCALUTION_EXPORT
+        void SetBasisSize(int size_basis);
+
+    protected:
+        virtual std::string Name_(void) const;
+
+    private:
+        int size_basis_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_BATCH_GMRES_HPP_
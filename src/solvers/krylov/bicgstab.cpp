@@ -102,6 +102,8 @@ namespace rocalution
     {
         log_debug(this, "BiCGStab::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("BiCGStab::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -305,7 +307,9 @@ namespace rocalution
             op->Apply(*r, t);
 
             // omega = <t,r> / <t,t>
-            omega = t->Dot(*r) / t->Dot(*t);
+            ValueType tr_tt[2];
+            t->DualDot(*r, *t, tr_tt);
+            omega = tr_tt[0] / tr_tt[1];
 
             if((std::abs(omega) == std::numeric_limits<ValueType>::infinity()) || (omega != omega)
                || (omega == static_cast<ValueType>(0)))
@@ -330,11 +334,10 @@ namespace rocalution
             // x = x + alpha * p + omega * r
             x->ScaleAdd2(static_cast<ValueType>(1), *p, alpha, *r, omega);
 
-            // r = r - omega * t
-            r->AddScale(*t, -omega);
+            // r = r - omega * t, fused with the residual norm
+            res_norm = this->AddScaleResidualNorm_(*t, -omega, r);
 
             // Check convergence
-            res_norm = this->Norm_(*r);
             if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
             {
                 break;
@@ -411,7 +414,7 @@ namespace rocalution
         rho = r->Dot(*r);
 
         // Mz = r
-        this->precond_->SolveZeroSol(*r, z);
+        this->PrecondSolveZeroSol_(*r, z);
 
         while(true)
         {
@@ -425,13 +428,15 @@ namespace rocalution
             r->AddScale(*q, -alpha);
 
             // Mv = r
-            this->precond_->SolveZeroSol(*r, v);
+            this->PrecondSolveZeroSol_(*r, v);
 
             // t = Av
             op->Apply(*v, t);
 
             // omega = (t,r) / (t,t)
-            omega = t->Dot(*r) / t->Dot(*t);
+            ValueType tr_tt[2];
+            t->DualDot(*r, *t, tr_tt);
+            omega = tr_tt[0] / tr_tt[1];
 
             if((std::abs(omega) == std::numeric_limits<ValueType>::infinity()) || (omega != omega)
                || (omega == static_cast<ValueType>(0)))
@@ -455,11 +460,10 @@ namespace rocalution
             // x = x + alpha * z + omega * v
             x->ScaleAdd2(static_cast<ValueType>(1), *z, alpha, *v, omega);
 
-            // r = r - omega * t
-            r->AddScale(*t, -omega);
+            // r = r - omega * t, fused with the residual norm
+            res_norm = this->AddScaleResidualNorm_(*t, -omega, r);
 
             // Check convergence
-            res_norm = this->Norm_(*r);
             if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
             {
                 break;
@@ -483,7 +487,7 @@ namespace rocalution
             p->ScaleAdd2(beta, *q, -beta * omega, *r, static_cast<ValueType>(1));
 
             // Mz = p
-            this->precond_->SolveZeroSol(*p, z);
+            this->PrecondSolveZeroSol_(*p, z);
         }
 
         log_debug(this, "BiCGStab::SolvePrecond_()", " #*# end");
@@ -35,6 +35,7 @@
 #include "../../utils/log.hpp"
 #include "../../utils/math_functions.hpp"
 
+#include <algorithm>
 #include <complex>
 #include <math.h>
 
@@ -103,6 +104,8 @@ namespace rocalution
     {
         log_debug(this, "BiCGStabl::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("BiCGStabl::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -146,6 +149,7 @@ namespace rocalution
         this->gamma1_ = new ValueType[this->l_];
         this->gamma2_ = new ValueType[this->l_];
         this->sigma_  = new ValueType[this->l_];
+        this->dots_   = new ValueType[std::max(this->l_, 2)];
 
         this->tau_ = new ValueType*[this->l_];
         for(int i = 0; i < this->l_; ++i)
@@ -181,6 +185,7 @@ namespace rocalution
             delete[] this->gamma1_;
             delete[] this->gamma2_;
             delete[] this->sigma_;
+            delete[] this->dots_;
 
             for(int i = 0; i < this->l_; ++i)
             {
@@ -317,6 +322,7 @@ namespace rocalution
         ValueType*  gamma2 = this->gamma2_;
         ValueType*  sigma  = this->sigma_;
         ValueType** tau    = this->tau_;
+        ValueType*  dots   = this->dots_;
 
         // inital residual r0 = b - Ax
         op->Apply(*x, r0);
@@ -406,23 +412,33 @@ namespace rocalution
                 break;
             }
 
-            // modified Gram Schmidt
+            // Gram Schmidt, the r_i+1 (i<j) are already mutually orthogonal, such that
+            // all tau_ij of column j can be computed in a single reduction
             for(int j = 0; j < l; ++j)
             {
+                // dots_i = (r_i+1, r_j+1), i=0,...,j-1
+                if(j > 0)
+                {
+                    r[j + 1]->MultiDot(j, r + 1, dots);
+                }
+
                 for(int i = 0; i < j; ++i)
                 {
                     // tau_ij = (r_j+1, r_i+1) / sigma_i
-                    tau[i][j] = r[j + 1]->Dot(*r[i + 1]) / sigma[i];
+                    tau[i][j] = rocalution_conj(dots[i]) / sigma[i];
 
                     // r_j+1 = r_j+1 - tau_ij * r_i+1
                     r[j + 1]->AddScale(*r[i + 1], -tau[i][j]);
                 }
 
-                // sigma_j = (r_j+1, r_j+1)
-                sigma[j] = r[j + 1]->Dot(*r[j + 1]);
+                // sigma_j = (r_j+1, r_j+1) and (r_0, r_j+1) in a single reduction
+                const VectorType* x[2] = {r[j + 1], r[0]};
+                r[j + 1]->MultiDot(2, x, dots);
+
+                sigma[j] = dots[0];
 
                 // gamma' = (r_0, r_j+1) / sigma_j
-                gamma1[j] = r[0]->Dot(*r[j + 1]) / sigma[j];
+                gamma1[j] = dots[1] / sigma[j];
             }
 
             // omega = gamma'_l-1; gamma_l-1 = gamma'_l-1
@@ -472,7 +488,7 @@ namespace rocalution
                 r[0]->AddScale(*r[j], -gamma1[j - 1]);
             }
 
-            res = this->Norm_(*r[0]);
+            res = this->ResidualNorm_(*r[0]);
 
             if(this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
             {
@@ -516,13 +532,14 @@ namespace rocalution
         ValueType*  gamma2 = this->gamma2_;
         ValueType*  sigma  = this->sigma_;
         ValueType** tau    = this->tau_;
+        ValueType*  dots   = this->dots_;
 
         // inital residual z = b - Ax
         op->Apply(*x, z);
         z->ScaleAdd(static_cast<ValueType>(-1), rhs);
 
         // M r0 = z
-        this->precond_->SolveZeroSol(*z, r0);
+        this->PrecondSolveZeroSol_(*z, r0);
 
         // Using preconditioned residual
         ValueType res = this->Norm_(*r0);
@@ -566,7 +583,7 @@ namespace rocalution
                 op->Apply(*u[j], z);
 
                 // M u_j+1 = z
-                this->precond_->SolveZeroSol(*z, u[j + 1]);
+                this->PrecondSolveZeroSol_(*z, u[j + 1]);
 
                 // sigma = (u_j+1, r0)
                 rho_old = r0->Dot(*u[j + 1]);
@@ -595,7 +612,7 @@ namespace rocalution
                 op->Apply(*r[j], z);
 
                 // M r_j+1 = z
-                this->precond_->SolveZeroSol(*z, r[j + 1]);
+                this->PrecondSolveZeroSol_(*z, r[j + 1]);
 
                 // x = x + alpha * u_0
                 x->AddScale(*u[0], alpha);
@@ -616,23 +633,33 @@ namespace rocalution
                 break;
             }
 
-            // modified Gram Schmidt
+            // Gram Schmidt, the r_i+1 (i<j) are already mutually orthogonal, such that
+            // all tau_ij of column j can be computed in a single reduction
             for(int j = 0; j < l; ++j)
             {
+                // dots_i = (r_i+1, r_j+1), i=0,...,j-1
+                if(j > 0)
+                {
+                    r[j + 1]->MultiDot(j, r + 1, dots);
+                }
+
                 for(int i = 0; i < j; ++i)
                 {
                     // tau_ij = (r_j+1, r_i+1) / sigma_i
-                    tau[i][j] = r[j + 1]->Dot(*r[i + 1]) / sigma[i];
+                    tau[i][j] = rocalution_conj(dots[i]) / sigma[i];
 
                     // r_j+1 = r_j+1 - tau_ij * r_i+1
                     r[j + 1]->AddScale(*r[i + 1], -tau[i][j]);
                 }
 
-                // sigma_j = (r_j+1, r_j+1)
-                sigma[j] = r[j + 1]->Dot(*r[j + 1]);
+                // sigma_j = (r_j+1, r_j+1) and (r_0, r_j+1) in a single reduction
+                const VectorType* x[2] = {r[j + 1], r[0]};
+                r[j + 1]->MultiDot(2, x, dots);
+
+                sigma[j] = dots[0];
 
                 // gamma' = (r_0, r_j+1) / sigma_j
-                gamma1[j] = r[0]->Dot(*r[j + 1]) / sigma[j];
+                gamma1[j] = dots[1] / sigma[j];
             }
 
             // omega = gamma'_l-1; gamma_l-1 = gamma'_l-1
@@ -682,7 +709,7 @@ namespace rocalution
                 r[0]->AddScale(*r[j], -gamma1[j - 1]);
             }
 
-            res = this->Norm_(*r[0]);
+            res = this->ResidualNorm_(*r[0]);
 
             if(this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
             {
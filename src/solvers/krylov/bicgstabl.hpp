@@ -83,6 +83,7 @@ namespace rocalution
 
         ValueType * gamma0_, *gamma1_, *gamma2_, *sigma_;
         ValueType** tau_;
+        ValueType*  dots_;
 
         VectorType   r0_, z_;
         VectorType **r_, **u_;
@@ -0,0 +1,499 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "blockcg.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_multi_vector.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <complex>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    BlockCG<OperatorType, VectorType, ValueType>::BlockCG()
+    {
+        log_debug(this, "BlockCG::BlockCG()", "default constructor");
+
+        this->pq_ = NULL;
+        this->ab_ = NULL;
+        this->rr_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    BlockCG<OperatorType, VectorType, ValueType>::~BlockCG()
+    {
+        log_debug(this, "BlockCG::~BlockCG()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("BlockCG solver");
+        }
+        else
+        {
+            LOG_INFO("BlockPCG solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("BlockCG (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("BlockPCG solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("BlockCG (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("BlockPCG ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "BlockCG::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("BlockCG::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+
+        if(this->res_norm_type_ != 2)
+        {
+            LOG_INFO("BlockCG solver supports only L2 residual norm. The solver is switching to "
+                     "L2 norm");
+            this->res_norm_type_ = 2;
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+
+            this->precond_->Build();
+        }
+
+        // The work blocks depend on the number of right-hand sides and are allocated
+        // when solving
+
+        log_debug(this, "BlockCG::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "BlockCG::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->r_.Clear();
+            this->z_.Clear();
+            this->p_.Clear();
+            this->q_.Clear();
+
+            free_host(&this->pq_);
+            free_host(&this->ab_);
+            free_host(&this->rr_);
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "BlockCG::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.Zeros();
+            this->z_.Zeros();
+            this->p_.Zeros();
+            this->q_.Zeros();
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "BlockCG::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToHost();
+            this->p_.MoveToHost();
+            this->q_.MoveToHost();
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "BlockCG::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToAccelerator();
+            this->p_.MoveToAccelerator();
+            this->q_.MoveToAccelerator();
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::AllocateBlocks_(int ncol)
+    {
+        log_debug(this, "BlockCG::AllocateBlocks_()", ncol);
+
+        if(this->r_.GetNcol() == ncol)
+        {
+            return;
+        }
+
+        int64_t nrow = this->op_->GetM();
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", nrow, ncol);
+
+        this->p_.CloneBackend(*this->op_);
+        this->p_.Allocate("p", nrow, ncol);
+
+        this->q_.CloneBackend(*this->op_);
+        this->q_.Allocate("q", nrow, ncol);
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.CloneBackend(*this->op_);
+            this->z_.Allocate("z", nrow, ncol);
+        }
+
+        free_host(&this->pq_);
+        free_host(&this->ab_);
+        free_host(&this->rr_);
+
+        allocate_host(ncol * ncol, &this->pq_);
+        allocate_host(ncol * ncol, &this->ab_);
+        allocate_host(ncol * ncol, &this->rr_);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::ApplyPrecond_(
+        const LocalMultiVector<ValueType>& in, LocalMultiVector<ValueType>* out)
+    {
+        log_debug(this, "BlockCG::ApplyPrecond_()", (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(this->precond_ != NULL);
+
+        RocalutionTimeScope time_scope(TimePreconditioner);
+
+        // Preconditioners without block support are applied column by column
+        this->precond_->SolveMultiZeroSol(in, out);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::Solve(const LocalMultiVector<ValueType>& rhs,
+                                                             LocalMultiVector<ValueType>*       x)
+    {
+        log_debug(this, "BlockCG::Solve()", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+
+        if(this->verb_ > 0)
+        {
+            this->PrintStart_();
+            this->iter_ctrl_.PrintInit();
+        }
+
+        this->SolveBlock_(rhs, x);
+
+        if(this->verb_ > 0)
+        {
+            this->iter_ctrl_.PrintStatus();
+            this->PrintEnd_();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                        VectorType*       x)
+    {
+        log_debug(this, "BlockCG::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->precond_ == NULL);
+
+        this->SolvePrecond_(rhs, x);
+
+        log_debug(this, "BlockCG::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                     VectorType*       x)
+    {
+        log_debug(this, "BlockCG::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+
+        // Solve a single right-hand side as block of size one
+        LocalMultiVector<ValueType> B;
+        LocalMultiVector<ValueType> X;
+
+        B.CloneBackend(*this->op_);
+        X.CloneBackend(*this->op_);
+
+        B.Allocate("rhs", rhs.GetSize(), 1);
+        X.Allocate("x", x->GetSize(), 1);
+
+        B.SetColumn(0, rhs);
+        X.SetColumn(0, *x);
+
+        this->SolveBlock_(B, &X);
+
+        X.GetColumn(0, x);
+
+        log_debug(this, "BlockCG::SolvePrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockCG<OperatorType, VectorType, ValueType>::SolveBlock_(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "BlockCG::SolveBlock_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+        assert(this->res_norm_type_ == 2);
+        assert(rhs.GetNrow() == this->op_->GetM());
+        assert(x->GetNrow() == this->op_->GetN());
+        assert(rhs.GetNcol() == x->GetNcol());
+
+        int s = rhs.GetNcol();
+
+        if(s == 0)
+        {
+            log_debug(this, "BlockCG::SolveBlock_()", " #*# end");
+            return;
+        }
+
+        this->AllocateBlocks_(s);
+
+        const OperatorType* op = this->op_;
+
+        LocalMultiVector<ValueType>* r = &this->r_;
+        LocalMultiVector<ValueType>* p = &this->p_;
+        LocalMultiVector<ValueType>* q = &this->q_;
+
+        // Without preconditioner, z and r coincide
+        LocalMultiVector<ValueType>* z = (this->precond_ != NULL) ? &this->z_ : r;
+
+        ValueType* pq = this->pq_;
+        ValueType* ab = this->ab_;
+        ValueType* rr = this->rr_;
+
+        // Initial residual R = B - AX
+        op->Apply(*x, r);
+        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        // Gram matrix of the residual block, its diagonal holds all squared norms
+        r->Dot(*r, rr);
+
+        // Initial residual norm, max_j |b_j - Ax0_j|
+        double res = 0.0;
+        for(int j = 0; j < s; ++j)
+        {
+            res = std::max(res, static_cast<double>(std::sqrt(std::abs(rr[j + j * s]))));
+        }
+
+        if(this->iter_ctrl_.InitResidual(res) == false)
+        {
+            log_debug(this, "BlockCG::SolveBlock_()", " #*# end");
+            return;
+        }
+
+        // Z = M^-1 R
+        if(this->precond_ != NULL)
+        {
+            this->ApplyPrecond_(*r, z);
+        }
+
+        // P = orth(Z)
+        p->CopyFrom(*z);
+        int rank = p->Orthonormalize();
+
+        while(rank > 0)
+        {
+            // Q = AP
+            op->Apply(*p, q);
+
+            // alpha = (P^H Q)^-1 P^H R
+            q->Dot(*p, pq);
+            r->Dot(*p, ab);
+
+            // Deflated columns of P are zero, keep P^H Q regular
+            for(int j = rank; j < s; ++j)
+            {
+                pq[j + j * s] = static_cast<ValueType>(1);
+            }
+
+            if(rocalution_cholesky(s, pq) == false)
+            {
+                LOG_INFO("BlockCG breakdown, operator is not positive definite");
+                break;
+            }
+
+            rocalution_cholesky_solve(s, s, pq, ab);
+
+            // X = X + P alpha
+            x->ScaleAddProduct(static_cast<ValueType>(1), *p, ab, static_cast<ValueType>(1));
+
+            // R = R - Q alpha
+            r->ScaleAddProduct(static_cast<ValueType>(1), *q, ab, static_cast<ValueType>(-1));
+
+            // All residual norms with a single block reduction
+            r->Dot(*r, rr);
+
+            res = 0.0;
+            for(int j = 0; j < s; ++j)
+            {
+                res = std::max(res, static_cast<double>(std::sqrt(std::abs(rr[j + j * s]))));
+            }
+
+            if(this->iter_ctrl_.CheckResidual(res))
+            {
+                break;
+            }
+
+            // Z = M^-1 R
+            if(this->precond_ != NULL)
+            {
+                this->ApplyPrecond_(*r, z);
+            }
+
+            // beta = -(P^H Q)^-1 Q^H Z
+            z->Dot(*q, ab);
+            rocalution_cholesky_solve(s, s, pq, ab);
+
+            // P = orth(Z + P beta)
+            p->ScaleAddProduct(static_cast<ValueType>(0), *p, ab, static_cast<ValueType>(-1));
+            p->AddScale(*z, static_cast<ValueType>(1));
+
+            rank = p->Orthonormalize();
+        }
+
+        if(rank == 0)
+        {
+            LOG_INFO("BlockCG stagnation, search directions are numerically zero");
+        }
+
+        log_debug(this, "BlockCG::SolveBlock_()", " #*# end");
+    }
+
+    template class BlockCG<LocalMatrix<double>, LocalVector<double>, double>;
+    template class BlockCG<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class BlockCG<LocalMatrix<std::complex<double>>,
+                           LocalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class BlockCG<LocalMatrix<std::complex<float>>,
+                           LocalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+} // namespace rocalution
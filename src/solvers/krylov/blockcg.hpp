@@ -0,0 +1,119 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_KRYLOV_BLOCKCG_HPP_
+#define ROCALUTION_KRYLOV_BLOCKCG_HPP_
+
+#include "../../base/local_multi_vector.hpp"
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class BlockCG
+  * \brief Block Conjugate Gradient Method
+  * \details
+  * The block Conjugate Gradient method solves a symmetric positive definite (SPD)
+  * linear system \f$AX=B\f$ with several right-hand sides at once. All \f$s\f$ columns
+  * of \f$X\f$ share a single block Krylov subspace, which typically reduces the number
+  * of iterations compared to \f$s\f$ independent CG solves. Each iteration performs one
+  * sparse matrix times multi-vector product and computes all inner products as a small
+  * dense \f$s \times s\f$ block in a single pass. The stopping criterion is applied to
+  * the maximum L2 residual norm over all right-hand sides.
+  * \cite blockcg
+  *
+  * The block of search directions is orthonormalized in every iteration and
+  * directions that become numerically linearly dependent, e.g. for linearly dependent
+  * right-hand sides or converged columns, are deflated. This avoids the breakdown of
+  * the classical block method. \cite bfbcg
+  *
+  * Right-hand sides are passed as LocalMultiVector. Solving a single LocalVector is
+  * supported and equivalent to CG.
+  *
+  * \tparam OperatorType - can be LocalMatrix
+  * \tparam VectorType - can be LocalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class BlockCG : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        BlockCG();
+        ROCALUTION_EXPORT
+        virtual ~BlockCG();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        using IterativeLinearSolver<OperatorType, VectorType, ValueType>::Solve;
+
+        /** \brief Solve AX = B for all columns of B at once
+        * \details
+        * X holds the initial guess on entry and has to be allocated with the same sizes
+        * as B.
+        */
+        ROCALUTION_EXPORT
+        void Solve(const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+        /** \brief Solve the block system, with or without preconditioner */
+        void SolveBlock_(const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x);
+
+        /** \brief Apply the preconditioner to each column of in */
+        void ApplyPrecond_(const LocalMultiVector<ValueType>& in, LocalMultiVector<ValueType>* out);
+
+        /** \brief Allocate the work blocks for ncol right-hand sides */
+        void AllocateBlocks_(int ncol);
+
+    private:
+        LocalMultiVector<ValueType> r_, z_, p_, q_;
+
+        // s x s work matrices
+        ValueType* pq_;
+        ValueType* ab_;
+        ValueType* rr_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_BLOCKCG_HPP_
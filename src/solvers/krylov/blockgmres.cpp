@@ -0,0 +1,761 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "blockgmres.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_multi_vector.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <complex>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    BlockGMRES<OperatorType, VectorType, ValueType>::BlockGMRES()
+    {
+        log_debug(this, "BlockGMRES::BlockGMRES()", "default constructor");
+
+        this->size_basis_ = 30;
+        this->ncol_       = 0;
+
+        this->v_ = NULL;
+
+        this->c_ = NULL;
+        this->s_ = NULL;
+        this->G_ = NULL;
+        this->H_ = NULL;
+        this->h_ = NULL;
+        this->S_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    BlockGMRES<OperatorType, VectorType, ValueType>::~BlockGMRES()
+    {
+        log_debug(this, "BlockGMRES::~BlockGMRES()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("BlockGMRES(" << this->size_basis_ << ") solver");
+        }
+        else
+        {
+            LOG_INFO("BlockGMRES(" << this->size_basis_ << ") solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("BlockGMRES(" << this->size_basis_ << ") (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("BlockGMRES(" << this->size_basis_
+                                   << ") solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("BlockGMRES(" << this->size_basis_ << ") (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("BlockGMRES(" << this->size_basis_ << ") ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "BlockGMRES::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("BlockGMRES::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() > 0);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->size_basis_ > 0);
+
+        if(this->res_norm_type_ != 2)
+        {
+            LOG_INFO("BlockGMRES solver supports only L2 residual norm. The solver is switching "
+                     "to L2 norm");
+            this->res_norm_type_ = 2;
+        }
+
+        // The blocks are allocated when the number of right-hand sides is known
+        this->v_ = new LocalMultiVector<ValueType>*[this->size_basis_ + 1];
+
+        for(int i = 0; i < this->size_basis_ + 1; ++i)
+        {
+            this->v_[i] = new LocalMultiVector<ValueType>;
+            this->v_[i]->CloneBackend(*this->op_);
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->w_.CloneBackend(*this->op_);
+
+            this->t_.CloneBackend(*this->op_);
+            this->t_.Allocate("t", this->op_->GetM());
+
+            this->u_.CloneBackend(*this->op_);
+            this->u_.Allocate("u", this->op_->GetM());
+
+            this->precond_->SetOperator(*this->op_);
+            this->precond_->Build();
+        }
+
+        this->build_ = true;
+
+        log_debug(this, "BlockGMRES::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "BlockGMRES::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->t_.Clear();
+                this->u_.Clear();
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->FreeBlocks_();
+
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                delete this->v_[i];
+            }
+            delete[] this->v_;
+            this->v_ = NULL;
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "BlockGMRES::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->Zeros();
+            }
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->w_.Zeros();
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "BlockGMRES::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->MoveToHost();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->w_.MoveToHost();
+                this->t_.MoveToHost();
+                this->u_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "BlockGMRES::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->MoveToAccelerator();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->w_.MoveToAccelerator();
+                this->t_.MoveToAccelerator();
+                this->u_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::SetBasisSize(int size_basis)
+    {
+        log_debug(this, "BlockGMRES:SetBasisSize()", size_basis);
+
+        assert(size_basis > 0);
+        assert(this->build_ == false);
+
+        this->size_basis_ = size_basis;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::AllocateBlocks_(int ncol)
+    {
+        log_debug(this, "BlockGMRES::AllocateBlocks_()", ncol);
+
+        if(this->ncol_ == ncol)
+        {
+            return;
+        }
+
+        this->FreeBlocks_();
+
+        int     m    = this->size_basis_;
+        int64_t nrow = this->op_->GetM();
+
+        for(int i = 0; i < m + 1; ++i)
+        {
+            this->v_[i]->CloneBackend(*this->op_);
+            this->v_[i]->Allocate("v", nrow, ncol);
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->w_.CloneBackend(*this->op_);
+            this->w_.Allocate("w", nrow, ncol);
+        }
+
+        // Band Hessenberg matrix and right-hand side of the least squares problem,
+        // both with leading dimension (m + 1) * ncol
+        allocate_host((m + 1) * ncol * m * ncol, &this->H_);
+        allocate_host((m + 1) * ncol * ncol, &this->G_);
+
+        // Up to 2 * ncol - 1 Givens rotations per column of H
+        allocate_host(m * ncol * (2 * ncol - 1), &this->c_);
+        allocate_host(m * ncol * (2 * ncol - 1), &this->s_);
+
+        allocate_host(ncol * ncol, &this->h_);
+        allocate_host(ncol * ncol, &this->S_);
+
+        this->ncol_ = ncol;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::FreeBlocks_(void)
+    {
+        log_debug(this, "BlockGMRES::FreeBlocks_()");
+
+        if(this->v_ != NULL)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->Clear();
+            }
+        }
+
+        this->w_.Clear();
+
+        free_host(&this->c_);
+        free_host(&this->s_);
+        free_host(&this->G_);
+        free_host(&this->H_);
+        free_host(&this->h_);
+        free_host(&this->S_);
+
+        this->ncol_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::ApplyPrecond_(
+        const LocalMultiVector<ValueType>& in, LocalMultiVector<ValueType>* out)
+    {
+        log_debug(this, "BlockGMRES::ApplyPrecond_()", (const void*&)in, out);
+
+        assert(out != NULL);
+        assert(this->precond_ != NULL);
+
+        for(int j = 0; j < in.GetNcol(); ++j)
+        {
+            in.GetColumn(j, &this->t_);
+            this->PrecondSolveZeroSol_(this->t_, &this->u_);
+            out->SetColumn(j, this->u_);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::Residual_(
+        const LocalMultiVector<ValueType>& rhs,
+        const LocalMultiVector<ValueType>& x,
+        LocalMultiVector<ValueType>*       v)
+    {
+        log_debug(this, "BlockGMRES::Residual_()", (const void*&)rhs, (const void*&)x, v);
+
+        if(this->precond_ != NULL)
+        {
+            // v = M^-1 (B - AX)
+            this->op_->Apply(x, &this->w_);
+            this->w_.ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+            this->ApplyPrecond_(this->w_, v);
+        }
+        else
+        {
+            // v = B - AX
+            this->op_->Apply(x, v);
+            v->ScaleAdd(static_cast<ValueType>(-1), rhs);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    double BlockGMRES<OperatorType, VectorType, ValueType>::MaxColumnNorm_(int              nrow,
+                                                                           int              ncol,
+                                                                           int              ld,
+                                                                           const ValueType* A)
+    {
+        double res = 0.0;
+
+        for(int j = 0; j < ncol; ++j)
+        {
+            double sum = 0.0;
+
+            for(int i = 0; i < nrow; ++i)
+            {
+                sum += std::norm(A[i + j * ld]);
+            }
+
+            res = std::max(res, std::sqrt(sum));
+        }
+
+        return res;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::Solve(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "BlockGMRES::Solve()", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+
+        if(this->verb_ > 0)
+        {
+            this->PrintStart_();
+            this->iter_ctrl_.PrintInit();
+        }
+
+        this->SolveBlock_(rhs, x);
+
+        if(this->verb_ > 0)
+        {
+            this->iter_ctrl_.PrintStatus();
+            this->PrintEnd_();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                           VectorType*       x)
+    {
+        log_debug(this, "BlockGMRES::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->precond_ == NULL);
+
+        this->SolvePrecond_(rhs, x);
+
+        log_debug(this, "BlockGMRES::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                        VectorType*       x)
+    {
+        log_debug(this, "BlockGMRES::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+
+        // Solve a single right-hand side as block of size one
+        LocalMultiVector<ValueType> B;
+        LocalMultiVector<ValueType> X;
+
+        B.CloneBackend(*this->op_);
+        X.CloneBackend(*this->op_);
+
+        B.Allocate("rhs", rhs.GetSize(), 1);
+        X.Allocate("x", x->GetSize(), 1);
+
+        B.SetColumn(0, rhs);
+        X.SetColumn(0, *x);
+
+        this->SolveBlock_(B, &X);
+
+        X.GetColumn(0, x);
+
+        log_debug(this, "BlockGMRES::SolvePrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::SolveBlock_(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "BlockGMRES::SolveBlock_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+        assert(this->res_norm_type_ == 2);
+        assert(rhs.GetNrow() == this->op_->GetM());
+        assert(x->GetNrow() == this->op_->GetN());
+        assert(rhs.GetNcol() == x->GetNcol());
+
+        int s = rhs.GetNcol();
+
+        if(s == 0)
+        {
+            log_debug(this, "BlockGMRES::SolveBlock_()", " #*# end");
+            return;
+        }
+
+        this->AllocateBlocks_(s);
+
+        int m   = this->size_basis_;
+        int ldh = (m + 1) * s;
+
+        LocalMultiVector<ValueType>** v = this->v_;
+
+        ValueType* c  = this->c_;
+        ValueType* sn = this->s_;
+        ValueType* G  = this->G_;
+        ValueType* H  = this->H_;
+        ValueType* h  = this->h_;
+        ValueType* S  = this->S_;
+
+        // Initial residual V_0 S = M^-1 (B - AX), the columns of S hold the coordinates
+        // of the residuals in the orthonormal basis V_0
+        this->Residual_(rhs, *x, v[0]);
+        int rank = v[0]->Orthonormalize(S);
+
+        double res = MaxColumnNorm_(s, s, s, S);
+
+        if(this->iter_ctrl_.InitResidual(res) == false)
+        {
+            log_debug(this, "BlockGMRES::SolveBlock_()", " #*# end");
+            return;
+        }
+
+        while(rank > 0)
+        {
+            // G = [S; 0]
+            set_to_zero_host(ldh * s, G);
+
+            for(int j = 0; j < s; ++j)
+            {
+                for(int i = 0; i < s; ++i)
+                {
+                    G[i + j * ldh] = S[i + j * s];
+                }
+            }
+
+            set_to_zero_host(ldh * m * s, H);
+
+            bool converged = false;
+
+            int i = 0;
+            while(i < m)
+            {
+                // V_i+1 = M^-1 A V_i
+                if(this->precond_ != NULL)
+                {
+                    this->op_->Apply(*v[i], &this->w_);
+                    this->ApplyPrecond_(this->w_, v[i + 1]);
+                }
+                else
+                {
+                    this->op_->Apply(*v[i], v[i + 1]);
+                }
+
+                // Block modified Gram-Schmidt, H_k,i = V_k^H V_i+1
+                for(int k = 0; k <= i; ++k)
+                {
+                    v[i + 1]->Dot(*v[k], h);
+                    v[i + 1]->ScaleAddProduct(
+                        static_cast<ValueType>(1), *v[k], h, static_cast<ValueType>(-1));
+
+                    for(int jj = 0; jj < s; ++jj)
+                    {
+                        for(int ii = 0; ii < s; ++ii)
+                        {
+                            H[k * s + ii + (i * s + jj) * ldh] = h[ii + jj * s];
+                        }
+                    }
+                }
+
+                // V_i+1 H_i+1,i = V_i+1, deflated directions leave zero rows in H_i+1,i
+                // and zero columns in V_i+1
+                int rank_i = v[i + 1]->Orthonormalize(S);
+
+                for(int jj = 0; jj < s; ++jj)
+                {
+                    for(int ii = 0; ii < s; ++ii)
+                    {
+                        H[(i + 1) * s + ii + (i * s + jj) * ldh] = S[ii + jj * s];
+                    }
+                }
+
+                // Reduce the new columns of H to upper triangular form, column col has
+                // non-zero entries down to row (i + 2) * s - 1
+                int nrot_max = 2 * s - 1;
+
+                for(int jj = 0; jj < s; ++jj)
+                {
+                    int col = i * s + jj;
+
+                    ValueType* Hc = &H[col * ldh];
+
+                    // Apply all previous rotations
+                    for(int k = 0; k < col; ++k)
+                    {
+                        int nrot = ((k / s) + 2) * s - 1 - k;
+
+                        for(int l = 1; l <= nrot; ++l)
+                        {
+                            ApplyGivensRotation_(c[k * nrot_max + l - 1],
+                                                 sn[k * nrot_max + l - 1],
+                                                 Hc[k],
+                                                 Hc[k + l]);
+                        }
+                    }
+
+                    // Eliminate the sub-diagonal entries of this column
+                    int nrot = (i + 2) * s - 1 - col;
+
+                    for(int l = 1; l <= nrot; ++l)
+                    {
+                        ValueType& cl = c[col * nrot_max + l - 1];
+                        ValueType& sl = sn[col * nrot_max + l - 1];
+
+                        GenerateGivensRotation_(Hc[col], Hc[col + l], cl, sl);
+                        ApplyGivensRotation_(cl, sl, Hc[col], Hc[col + l]);
+
+                        for(int j = 0; j < s; ++j)
+                        {
+                            ApplyGivensRotation_(cl, sl, G[col + j * ldh], G[col + l + j * ldh]);
+                        }
+                    }
+                }
+
+                ++i;
+
+                // Residual of column j is |G(i * s : (i + 1) * s, j)|
+                res = MaxColumnNorm_(s, s, ldh, &G[i * s]);
+
+                if(this->iter_ctrl_.CheckResidual(res))
+                {
+                    converged = true;
+                    break;
+                }
+
+                // The block Krylov space is invariant
+                if(rank_i == 0)
+                {
+                    break;
+                }
+            }
+
+            // Solve the upper triangular system H Y = G in place, zero diagonal entries
+            // belong to deflated directions
+            int nk = i * s;
+
+            for(int j = 0; j < s; ++j)
+            {
+                ValueType* Y = &G[j * ldh];
+
+                for(int r = nk - 1; r >= 0; --r)
+                {
+                    if(H[r + r * ldh] == static_cast<ValueType>(0))
+                    {
+                        Y[r] = static_cast<ValueType>(0);
+                        continue;
+                    }
+
+                    ValueType sum = Y[r];
+
+                    for(int cc = r + 1; cc < nk; ++cc)
+                    {
+                        sum -= H[r + cc * ldh] * Y[cc];
+                    }
+
+                    Y[r] = sum / H[r + r * ldh];
+                }
+            }
+
+            // X = X + sum_k V_k Y_k
+            for(int k = 0; k < i; ++k)
+            {
+                for(int jj = 0; jj < s; ++jj)
+                {
+                    for(int ii = 0; ii < s; ++ii)
+                    {
+                        h[ii + jj * s] = G[k * s + ii + jj * ldh];
+                    }
+                }
+
+                x->ScaleAddProduct(static_cast<ValueType>(1), *v[k], h, static_cast<ValueType>(1));
+            }
+
+            if(converged == true)
+            {
+                break;
+            }
+
+            // Restart with the new residual
+            this->Residual_(rhs, *x, v[0]);
+            rank = v[0]->Orthonormalize(S);
+
+            res = MaxColumnNorm_(s, s, s, S);
+
+            if(this->iter_ctrl_.CheckResidualNoCount(res))
+            {
+                break;
+            }
+        }
+
+        if(rank == 0)
+        {
+            LOG_INFO("BlockGMRES stagnation, residual block is numerically zero");
+        }
+
+        log_debug(this, "BlockGMRES::SolveBlock_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::GenerateGivensRotation_(ValueType  dx,
+                                                                                  ValueType  dy,
+                                                                                  ValueType& c,
+                                                                                  ValueType& s)
+    {
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        if(dy == zero)
+        {
+            c = one;
+            s = zero;
+        }
+        else if(dx == zero)
+        {
+            c = zero;
+            s = one;
+        }
+        else
+        {
+            // Unitary rotation with real c, such that -conj(s) dx + c dy = 0
+            auto abs_dx = std::abs(dx);
+            auto nrm    = std::sqrt(abs_dx * abs_dx + std::abs(dy) * std::abs(dy));
+
+            c = static_cast<ValueType>(abs_dx / nrm);
+            s = (dx / abs_dx) * rocalution_conj(dy) / nrm;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockGMRES<OperatorType, VectorType, ValueType>::ApplyGivensRotation_(ValueType  c,
+                                                                               ValueType  s,
+                                                                               ValueType& dx,
+                                                                               ValueType& dy)
+    {
+        ValueType temp = dx;
+        dx             = c * dx + s * dy;
+        dy             = -rocalution_conj(s) * temp + c * dy;
+    }
+
+    template class BlockGMRES<LocalMatrix<double>, LocalVector<double>, double>;
+    template class BlockGMRES<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class BlockGMRES<LocalMatrix<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class BlockGMRES<LocalMatrix<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+} // namespace rocalution
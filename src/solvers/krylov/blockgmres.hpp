@@ -0,0 +1,147 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_KRYLOV_BLOCKGMRES_HPP_
+#define ROCALUTION_KRYLOV_BLOCKGMRES_HPP_
+
+#include "../../base/local_multi_vector.hpp"
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class BlockGMRES
+  * \brief Block Generalized Minimum Residual Method
+  * \details
+  * The block Generalized Minimum Residual method solves a (non) symmetric linear system
+  * \f$AX=B\f$ with several right-hand sides at once. A single block Krylov subspace is
+  * built from all \f$s\f$ residuals, and the (preconditioned) residual of each column is
+  * minimized over this space. Each iteration performs one sparse matrix times
+  * multi-vector product, a block Gram-Schmidt step with dense \f$s \times s\f$ inner
+  * products and a Cholesky QR factorization of the new block. Directions of the new
+  * block that are numerically linearly dependent are deflated. The stopping criterion
+  * is applied to the maximum L2 residual norm over all right-hand sides.
+  * \cite blockgmres
+  *
+  * The basis size, i.e. the number of blocks before restarting, can be set using
+  * SetBasisSize(). The default size is 30, which requires the storage of
+  * \f$31 \cdot s\f$ vectors. Right-hand sides are passed as LocalMultiVector. Solving a
+  * single LocalVector is supported and equivalent to GMRES.
+  *
+  * \tparam OperatorType - can be LocalMatrix
+  * \tparam VectorType - can be LocalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class BlockGMRES : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        BlockGMRES();
+        ROCALUTION_EXPORT
+        virtual ~BlockGMRES();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Set the size of the block Krylov subspace basis (in blocks) */
+        ROCALUTION_EXPORT
+        virtual void SetBasisSize(int size_basis);
+
+        using IterativeLinearSolver<OperatorType, VectorType, ValueType>::Solve;
+
+        /** \brief Solve AX = B for all columns of B at once
+        * \details
+        * X holds the initial guess on entry and has to be allocated with the same sizes
+        * as B.
+        */
+        ROCALUTION_EXPORT
+        void Solve(const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+        /** \brief Solve the block system, with or without preconditioner */
+        void SolveBlock_(const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x);
+
+        /** \brief Compute the (preconditioned) residual block v = M^-1 (B - AX) */
+        void Residual_(const LocalMultiVector<ValueType>& rhs,
+                       const LocalMultiVector<ValueType>& x,
+                       LocalMultiVector<ValueType>*       v);
+
+        /** \brief Apply the preconditioner to each column of in */
+        void ApplyPrecond_(const LocalMultiVector<ValueType>& in, LocalMultiVector<ValueType>* out);
+
+        /** \brief Return the maximum L2 norm of the columns of a host matrix */
+        static double MaxColumnNorm_(int nrow, int ncol, int ld, const ValueType* A);
+
+        /** \brief Allocate the work blocks for ncol right-hand sides */
+        void AllocateBlocks_(int ncol);
+        /** \brief Free the work blocks */
+        void FreeBlocks_(void);
+
+        /** \brief Generate Givens rotation */
+        static void GenerateGivensRotation_(ValueType dx, ValueType dy, ValueType& c, ValueType& s);
+        /** \brief Apply Givens rotation */
+        static void ApplyGivensRotation_(ValueType c, ValueType s, ValueType& dx, ValueType& dy);
+
+    private:
+        LocalMultiVector<ValueType>** v_;
+        LocalMultiVector<ValueType>   w_;
+
+        // Columns used to apply the preconditioner
+        VectorType t_, u_;
+
+        // Number of right-hand sides the work blocks are allocated for
+        int ncol_;
+
+        ValueType* c_;
+        ValueType* s_;
+        ValueType* G_;
+        ValueType* H_;
+        ValueType* h_;
+        ValueType* S_;
+
+        int size_basis_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_BLOCKGMRES_HPP_
@@ -26,6 +26,7 @@
 #include "../iter_ctrl.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_shell_operator.hpp"
 #include "../../base/local_stencil.hpp"
 #include "../../base/local_vector.hpp"
 
@@ -37,6 +38,7 @@
 
 #include <complex>
 #include <math.h>
+#include <utility>
 
 namespace rocalution
 {
@@ -101,6 +103,8 @@ namespace rocalution
     {
         log_debug(this, "CG::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("CG::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -133,6 +137,9 @@ namespace rocalution
         this->q_.CloneBackend(*this->op_);
         this->q_.Allocate("q", this->op_->GetM());
 
+        this->scalars_.CloneBackend(*this->op_);
+        this->scalars_.Allocate("scalars", 3);
+
         log_debug(this, "CG::Build()", this->build_, " #*# end");
     }
 
@@ -177,6 +184,10 @@ namespace rocalution
         this->q_.Allocate("q", this->op_->GetM());
         this->q_.MoveToAcceleratorAsync();
 
+        this->scalars_.CloneBackend(*this->op_);
+        this->scalars_.Allocate("scalars", 3);
+        this->scalars_.MoveToAcceleratorAsync();
+
         log_debug(this, "CG::BuildMoveToAcceleratorAsync()", this->build_, " #*# end");
     }
 
@@ -194,6 +205,7 @@ namespace rocalution
         this->r_.Sync();
         this->p_.Sync();
         this->q_.Sync();
+        this->scalars_.Sync();
 
         log_debug(this, "CG::Sync()", this->build_, " #*# end");
     }
@@ -214,6 +226,7 @@ namespace rocalution
             this->z_.Clear();
             this->p_.Clear();
             this->q_.Clear();
+            this->scalars_.Clear();
 
             this->iter_ctrl_.Clear();
 
@@ -232,6 +245,7 @@ namespace rocalution
             this->z_.Zeros();
             this->p_.Zeros();
             this->q_.Zeros();
+            this->scalars_.Zeros();
 
             this->iter_ctrl_.Clear();
 
@@ -256,6 +270,7 @@ namespace rocalution
             this->r_.MoveToHost();
             this->p_.MoveToHost();
             this->q_.MoveToHost();
+            this->scalars_.MoveToHost();
 
             if(this->precond_ != NULL)
             {
@@ -275,6 +290,7 @@ namespace rocalution
             this->r_.MoveToAccelerator();
             this->p_.MoveToAccelerator();
             this->q_.MoveToAccelerator();
+            this->scalars_.MoveToAccelerator();
 
             if(this->precond_ != NULL)
             {
@@ -284,6 +300,29 @@ namespace rocalution
         }
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    ValueType CG<OperatorType, VectorType, ValueType>::AddScaleRatioResidualNorm_(
+        const VectorType& x, int64_t num, int64_t den, VectorType* vec)
+    {
+        assert(vec != NULL);
+
+        // The residual is not checked, the update stays on the backend without any
+        // host synchronization
+        if(this->iter_ctrl_.CheckNext() == false)
+        {
+            vec->AddScaleRatio(x, static_cast<ValueType>(-1), this->scalars_, num, den);
+
+            return static_cast<ValueType>(this->iter_ctrl_.GetCurrentResidual());
+        }
+
+        // The norm synchronizes anyway, fetch alpha to keep the update fused with it
+        ValueType s[3];
+        this->scalars_.GetContinuousValues(0, 3, s);
+        _rocalution_sync();
+
+        return this->AddScaleNorm_(x, -s[num] / s[den], vec);
+    }
+
     // TODO
     // re-orthogonalization and
     // residual - re-computed % iter
@@ -305,29 +344,45 @@ namespace rocalution
         VectorType* p = &this->p_;
         VectorType* q = &this->q_;
 
-        ValueType alpha, beta;
-        ValueType rho, rho_old;
+        // Positions of rho, rho_old and (p,q) in the scalars
+        int64_t rho     = 0;
+        int64_t rho_old = 1;
+        int64_t pq      = 2;
+
+        LocalVector<ValueType>* s = &this->scalars_;
 
-        // Initial residual = b - Ax
-        op->Apply(*x, r);
-        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+        // State of the recurrence, that is checkpointed
+        VectorType* state[3] = {x, r, p};
 
-        // Initial residual norm |b-Ax0|
-        ValueType res_norm = this->Norm_(*r);
-        // Initial residual norm |b|
-        //    ValueType res_norm = this->Norm_(rhs);
+        ValueType res_norm;
 
-        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        if(this->Restore_(3, state, s, &rho) == true)
         {
-            log_debug(this, "CG::SolveNonPrecond_()", " #*# end");
-            return;
+            rho_old = 1 - rho;
         }
+        else
+        {
+            // Initial residual = b - Ax
+            op->Apply(*x, r);
+            r->ScaleAdd(static_cast<ValueType>(-1), rhs);
 
-        // p = r
-        p->CopyFrom(*r);
+            // Initial residual norm |b-Ax0|
+            res_norm = this->Norm_(*r);
+            // Initial residual norm |b|
+            //    ValueType res_norm = this->Norm_(rhs);
 
-        // rho = (r,r)
-        rho = r->DotNonConj(*r);
+            if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+            {
+                log_debug(this, "CG::SolveNonPrecond_()", " #*# end");
+                return;
+            }
+
+            // p = r
+            p->CopyFrom(*r);
+
+            // rho = (r,r)
+            r->DotNonConjToScalar(*r, s, rho);
+        }
 
         while(true)
         {
@@ -335,28 +390,28 @@ namespace rocalution
             op->Apply(*p, q);
 
             // alpha = rho / (p,q)
-            alpha = rho / p->DotNonConj(*q);
+            p->DotNonConjToScalar(*q, s, pq);
 
             // x = x + alpha*p
-            x->AddScale(*p, alpha);
+            x->AddScaleRatio(*p, static_cast<ValueType>(1), *s, rho, pq);
 
             // r = r - alpha*q
-            r->AddScale(*q, -alpha);
+            res_norm = this->AddScaleRatioResidualNorm_(*q, rho, pq, r);
 
             // Check convergence
-            res_norm = this->Norm_(*r);
             if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
             {
                 break;
             }
 
             // rho = (r,r)
-            rho_old = rho;
-            rho     = r->DotNonConj(*r);
+            std::swap(rho, rho_old);
+            r->DotNonConjToScalar(*r, s, rho);
+
+            // p = beta*p + r, beta = rho / rho_old
+            p->ScaleRatioAdd(*s, rho, rho_old, *r);
 
-            // p = beta*p + r
-            beta = rho / rho_old;
-            p->ScaleAdd(beta, *r);
+            this->Checkpoint_(3, state, s, rho);
         }
 
         log_debug(this, "CG::SolveNonPrecond_()", " #*# end");
@@ -381,33 +436,49 @@ namespace rocalution
         VectorType* p = &this->p_;
         VectorType* q = &this->q_;
 
-        ValueType alpha, beta;
-        ValueType rho, rho_old;
+        // Positions of rho, rho_old and (p,q) in the scalars
+        int64_t rho     = 0;
+        int64_t rho_old = 1;
+        int64_t pq      = 2;
+
+        LocalVector<ValueType>* s = &this->scalars_;
 
-        // Initial residual = b - Ax
-        op->Apply(*x, r);
-        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+        // State of the recurrence, that is checkpointed
+        VectorType* state[3] = {x, r, p};
 
-        // Initial residual norm |b-Ax0|
-        ValueType res_norm = this->Norm_(*r);
-        // Initial residual norm |b|
-        //    ValueType res_norm = this->Norm_(rhs);
+        ValueType res_norm;
 
-        // |b - Ax0|
-        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        if(this->Restore_(3, state, s, &rho) == true)
         {
-            log_debug(this, "CG::SolvePrecond_()", " #*# end");
-            return;
+            rho_old = 1 - rho;
         }
+        else
+        {
+            // Initial residual = b - Ax
+            op->Apply(*x, r);
+            r->ScaleAdd(static_cast<ValueType>(-1), rhs);
 
-        // Solve Mz=r
-        this->precond_->SolveZeroSol(*r, z);
+            // Initial residual norm |b-Ax0|
+            res_norm = this->Norm_(*r);
+            // Initial residual norm |b|
+            //    ValueType res_norm = this->Norm_(rhs);
+
+            // |b - Ax0|
+            if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+            {
+                log_debug(this, "CG::SolvePrecond_()", " #*# end");
+                return;
+            }
+
+            // Solve Mz=r
+            this->PrecondSolveZeroSol_(*r, z);
 
-        // p = z
-        p->CopyFrom(*z);
+            // p = z
+            p->CopyFrom(*z);
 
-        // rho = (r,z)
-        rho = r->DotNonConj(*z);
+            // rho = (r,z)
+            r->DotNonConjToScalar(*z, s, rho);
+        }
 
         while(true)
         {
@@ -415,31 +486,31 @@ namespace rocalution
             op->Apply(*p, q);
 
             // alpha = rho / (p,q)
-            alpha = rho / p->DotNonConj(*q);
+            p->DotNonConjToScalar(*q, s, pq);
 
             // x = x + alpha*p
-            x->AddScale(*p, alpha);
+            x->AddScaleRatio(*p, static_cast<ValueType>(1), *s, rho, pq);
 
             // r = r - alpha*q
-            r->AddScale(*q, -alpha);
+            res_norm = this->AddScaleRatioResidualNorm_(*q, rho, pq, r);
 
             // Check convergence
-            res_norm = this->Norm_(*r);
             if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
             {
                 break;
             }
 
             // Solve Mz=r
-            this->precond_->SolveZeroSol(*r, z);
+            this->PrecondSolveZeroSol_(*r, z);
 
             // rho = (r,z)
-            rho_old = rho;
-            rho     = r->DotNonConj(*z);
+            std::swap(rho, rho_old);
+            r->DotNonConjToScalar(*z, s, rho);
 
-            // p = beta*p + z
-            beta = rho / rho_old;
-            p->ScaleAdd(beta, *z);
+            // p = beta*p + z, beta = rho / rho_old
+            p->ScaleRatioAdd(*s, rho, rho_old, *z);
+
+            this->Checkpoint_(3, state, s, rho);
         }
 
         log_debug(this, "CG::SolvePrecond_()", " #*# end");
@@ -478,4 +549,15 @@ namespace rocalution
                       std::complex<float>>;
 #endif
 
+    template class CG<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class CG<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class CG<LocalShellOperator<std::complex<double>>,
+                      LocalVector<std::complex<double>>,
+                      std::complex<double>>;
+    template class CG<LocalShellOperator<std::complex<float>>,
+                      LocalVector<std::complex<float>>,
+                      std::complex<float>>;
+#endif
+
 } // namespace rocalution
@@ -76,6 +76,13 @@ namespace rocalution
         virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
         virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
 
+        /** \brief Performs vec = vec - scalars[num] / scalars[den] * x and computes the
+        * residual norm, if it is checked */
+        ValueType AddScaleRatioResidualNorm_(const VectorType& x,
+                                             int64_t           num,
+                                             int64_t           den,
+                                             VectorType*       vec);
+
         virtual void PrintStart_(void) const;
         virtual void PrintEnd_(void) const;
 
@@ -85,6 +92,9 @@ namespace rocalution
     private:
         VectorType r_, z_;
         VectorType p_, q_;
+
+        // rho, rho_old and (p,q) of the recurrences, kept on the backend of the solver
+        LocalVector<ValueType> scalars_;
     };
 
 } // namespace rocalution
@@ -0,0 +1,277 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "cgls.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    CGLS<OperatorType, VectorType, ValueType>::CGLS()
+    {
+        log_debug(this, "CGLS::CGLS()", "default constructor");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    CGLS<OperatorType, VectorType, ValueType>::~CGLS()
+    {
+        log_debug(this, "CGLS::~CGLS()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CGLS<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("CGLS solver");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CGLS<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        LOG_INFO("CGLS (non-precond) least squares solver starts");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CGLS<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        LOG_INFO("CGLS (non-precond) ends");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CGLS<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "CGLS::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("CGLS::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() > 0);
+        assert(this->op_->GetN() > 0);
+
+        if(this->precond_ != NULL)
+        {
+            LOG_INFO("CGLS solver does not support preconditioning");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", this->op_->GetM());
+
+        this->q_.CloneBackend(*this->op_);
+        this->q_.Allocate("q", this->op_->GetM());
+
+        this->s_.CloneBackend(*this->op_);
+        this->s_.Allocate("s", this->op_->GetN());
+
+        this->p_.CloneBackend(*this->op_);
+        this->p_.Allocate("p", this->op_->GetN());
+
+        log_debug(this, "CGLS::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CGLS<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "CGLS::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.Clear();
+            this->q_.Clear();
+            this->s_.Clear();
+            this->p_.Clear();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CGLS<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "CGLS::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.Zeros();
+            this->q_.Zeros();
+            this->s_.Zeros();
+            this->p_.Zeros();
+
+            this->iter_ctrl_.Clear();
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CGLS<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "CGLS::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToHost();
+            this->q_.MoveToHost();
+            this->s_.MoveToHost();
+            this->p_.MoveToHost();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CGLS<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "CGLS::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToAccelerator();
+            this->q_.MoveToAccelerator();
+            this->s_.MoveToAccelerator();
+            this->p_.MoveToAccelerator();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CGLS<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                     VectorType*       x)
+    {
+        log_debug(this, "CGLS::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        const OperatorType* op = this->op_;
+
+        VectorType* r = &this->r_;
+        VectorType* q = &this->q_;
+        VectorType* s = &this->s_;
+        VectorType* p = &this->p_;
+
+        ValueType alpha, beta;
+        ValueType gamma, gamma_old;
+
+        // initial residual r = b - Ax
+        op->Apply(*x, r);
+        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        // normal equations residual s = A^T r
+        op->ApplyTranspose(*r, s);
+
+        // p = s
+        p->CopyFrom(*s);
+
+        // use for |A^T (b-Ax0)|
+        ValueType res_norm = this->Norm_(*s);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        {
+            log_debug(this, "CGLS::SolveNonPrecond_()", " #*# end");
+
+            return;
+        }
+
+        // gamma = (s,s)
+        gamma = s->Dot(*s);
+
+        while(true)
+        {
+            // q = Ap
+            op->Apply(*p, q);
+
+            // alpha = gamma / (q,q)
+            alpha = gamma / q->Dot(*q);
+
+            // x = x + alpha * p
+            x->AddScale(*p, alpha);
+
+            // r = r - alpha * q
+            r->AddScale(*q, -alpha);
+
+            // s = A^T r
+            op->ApplyTranspose(*r, s);
+
+            res_norm = this->ResidualNorm_(*s);
+
+            if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
+            {
+                break;
+            }
+
+            gamma_old = gamma;
+
+            // gamma = (s,s)
+            gamma = s->Dot(*s);
+
+            beta = gamma / gamma_old;
+
+            // p = beta * p + s
+            p->ScaleAdd(beta, *s);
+        }
+
+        log_debug(this, "CGLS::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void CGLS<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                  VectorType*       x)
+    {
+        LOG_INFO("CGLS solver does not support preconditioning");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template class CGLS<LocalMatrix<double>, LocalVector<double>, double>;
+    template class CGLS<LocalMatrix<float>, LocalVector<float>, float>;
+
+    template class CGLS<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class CGLS<GlobalMatrix<float>, GlobalVector<float>, float>;
+
+} // namespace rocalution
@@ -0,0 +1,90 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_CGLS_HPP_
+#define ROCALUTION_KRYLOV_CGLS_HPP_
+
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class CGLS
+  * \brief Conjugate Gradient Method for Least Squares Problems
+  * \details
+  * The CGLS method is an iterative method for solving sparse linear least squares
+  * problems \f$\min_{x} \|Ax-b\|_{2}\f$, where \f$A\f$ can be rectangular. It is
+  * mathematically equivalent to the Conjugate Gradient method applied to the normal
+  * equations \f$A^{T}Ax=A^{T}b\f$, but the normal equations matrix is never formed and
+  * the transposed product is computed without storing \f$A^{T}\f$. The residual of the
+  * normal equations \f$A^{T}(b-Ax)\f$ is monitored, since the residual \f$b-Ax\f$
+  * does not vanish for inconsistent systems. The method cannot be preconditioned.
+  * \cite SAAD
+  *
+  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float or double
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class CGLS : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        CGLS();
+        ROCALUTION_EXPORT
+        virtual ~CGLS();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        // Vectors of the row space
+        VectorType r_, q_;
+        // Vectors of the column space
+        VectorType s_, p_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_CGLS_HPP_
@@ -101,6 +101,8 @@ namespace rocalution
     {
         log_debug(this, "CRG::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("CR::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -296,7 +298,7 @@ namespace rocalution
         // r = r - alpha * q
         r->AddScale(*q, -alpha);
 
-        res_norm = this->Norm_(*r);
+        res_norm = this->ResidualNorm_(*r);
 
         while(!this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
         {
@@ -325,7 +327,7 @@ namespace rocalution
             // r = r - alpha * q
             r->AddScale(*q, -alpha);
 
-            res_norm = this->Norm_(*r);
+            res_norm = this->ResidualNorm_(*r);
         }
 
         log_debug(this, "CR::SolveNonPrecond_()", " #*# end");
@@ -360,7 +362,7 @@ namespace rocalution
         z->ScaleAdd(static_cast<ValueType>(-1), rhs);
 
         // Solve Mr=z
-        this->precond_->SolveZeroSol(*z, r);
+        this->PrecondSolveZeroSol_(*z, r);
 
         // p = r
         p->CopyFrom(*r);
@@ -391,7 +393,7 @@ namespace rocalution
         op->Apply(*p, q);
 
         // Mz=q
-        this->precond_->SolveZeroSol(*q, z);
+        this->PrecondSolveZeroSol_(*q, z);
 
         // alpha = rho / (q,z)
         alpha = rho / q->DotNonConj(*z);
@@ -405,7 +407,7 @@ namespace rocalution
         // t = t - alpha * q
         t->AddScale(*q, -alpha);
 
-        res_norm = this->Norm_(*t);
+        res_norm = this->ResidualNorm_(*t);
 
         while(!this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
         {
@@ -426,7 +428,7 @@ namespace rocalution
             q->ScaleAdd(beta, *v);
 
             // Mz=q
-            this->precond_->SolveZeroSol(*q, z);
+            this->PrecondSolveZeroSol_(*q, z);
 
             // alpha = rho / (q,z)
             alpha = rho / q->DotNonConj(*z);
@@ -440,7 +442,7 @@ namespace rocalution
             // t = t - alpha * q
             t->AddScale(*q, -alpha);
 
-            res_norm = this->Norm_(*t);
+            res_norm = this->ResidualNorm_(*t);
         }
 
         log_debug(this, "CR::SolvePrecond_()", " #*# end");
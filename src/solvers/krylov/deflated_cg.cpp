@@ -0,0 +1,787 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "deflated_cg.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_shell_operator.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+#include "../../utils/type_traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    DeflatedCG<OperatorType, VectorType, ValueType>::DeflatedCG()
+    {
+        log_debug(this, "DeflatedCG::DeflatedCG()", "default constructor");
+
+        this->size_ritz_ = 0;
+        this->window_    = 0;
+
+        this->flexible_         = false;
+        this->deflation_update_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    DeflatedCG<OperatorType, VectorType, ValueType>::~DeflatedCG()
+    {
+        log_debug(this, "DeflatedCG::~DeflatedCG()", "destructor");
+
+        this->Clear();
+        this->ClearDeflationSpace();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        std::string name = (this->flexible_ == true) ? "DeflatedFCG" : "DeflatedCG";
+
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO(name << " solver");
+        }
+        else
+        {
+            LOG_INFO(name << " solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        std::string name = (this->flexible_ == true) ? "DeflatedFCG" : "DeflatedCG";
+
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO(name << "(" << this->W_.size() << ") (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO(name << "(" << this->W_.size() << ") solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        std::string name = (this->flexible_ == true) ? "DeflatedFCG" : "DeflatedCG";
+
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO(name << "(" << this->W_.size() << ") (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO(name << "(" << this->W_.size() << ") ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "DeflatedCG::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("DeflatedCG::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+
+            this->precond_->Build();
+
+            this->z_.CloneBackend(*this->op_);
+            this->z_.Allocate("z", this->op_->GetM());
+        }
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", this->op_->GetM());
+
+        this->p_.CloneBackend(*this->op_);
+        this->p_.Allocate("p", this->op_->GetM());
+
+        this->q_.CloneBackend(*this->op_);
+        this->q_.Allocate("q", this->op_->GetM());
+
+        // Search directions for the Ritz update of the deflation space
+        if(this->size_ritz_ > 0)
+        {
+            this->P_.resize(this->window_);
+            this->AP_.resize(this->window_);
+
+            for(int i = 0; i < this->window_; ++i)
+            {
+                this->P_[i] = new VectorType;
+                this->P_[i]->CloneBackend(*this->op_);
+                this->P_[i]->Allocate("P", this->op_->GetM());
+
+                this->AP_[i] = new VectorType;
+                this->AP_[i]->CloneBackend(*this->op_);
+                this->AP_[i]->Allocate("AP", this->op_->GetM());
+            }
+        }
+
+        // The deflation space may have been set for another operator
+        this->deflation_update_ = !this->W_.empty();
+
+        this->build_ = true;
+
+        log_debug(this, "DeflatedCG::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "DeflatedCG::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->r_.Clear();
+            this->z_.Clear();
+            this->p_.Clear();
+            this->q_.Clear();
+
+            for(size_t i = 0; i < this->P_.size(); ++i)
+            {
+                delete this->P_[i];
+                delete this->AP_[i];
+            }
+
+            this->P_.clear();
+            this->AP_.clear();
+
+            this->dot_x_.clear();
+            this->h_.clear();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "DeflatedCG::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.Zeros();
+            this->z_.Zeros();
+            this->p_.Zeros();
+            this->q_.Zeros();
+
+            // The operator values have changed, W is A-orthonormalized in the next solve
+            this->deflation_update_ = !this->W_.empty();
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::ResetOperator(const OperatorType& op)
+    {
+        log_debug(this, "DeflatedCG::ResetOperator()", (const void*&)op);
+
+        IterativeLinearSolver<OperatorType, VectorType, ValueType>::ResetOperator(op);
+
+        this->deflation_update_ = !this->W_.empty();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "DeflatedCG::MoveToHostLocalData_()", this->build_);
+
+        for(size_t i = 0; i < this->W_.size(); ++i)
+        {
+            this->W_[i]->MoveToHost();
+            this->AW_[i]->MoveToHost();
+        }
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToHost();
+            this->p_.MoveToHost();
+            this->q_.MoveToHost();
+
+            for(size_t i = 0; i < this->P_.size(); ++i)
+            {
+                this->P_[i]->MoveToHost();
+                this->AP_[i]->MoveToHost();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "DeflatedCG::MoveToAcceleratorLocalData_()", this->build_);
+
+        for(size_t i = 0; i < this->W_.size(); ++i)
+        {
+            this->W_[i]->MoveToAccelerator();
+            this->AW_[i]->MoveToAccelerator();
+        }
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToAccelerator();
+            this->p_.MoveToAccelerator();
+            this->q_.MoveToAccelerator();
+
+            for(size_t i = 0; i < this->P_.size(); ++i)
+            {
+                this->P_[i]->MoveToAccelerator();
+                this->AP_[i]->MoveToAccelerator();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::SetDeflationVectors(
+        int count, const VectorType* const* w)
+    {
+        log_debug(this, "DeflatedCG::SetDeflationVectors()", count, w);
+
+        assert(count >= 0);
+        assert(w != NULL || count == 0);
+
+        this->ClearDeflationSpace();
+
+        for(int k = 0; k < count; ++k)
+        {
+            assert(w[k] != NULL);
+
+            VectorType* v  = new VectorType;
+            VectorType* av = new VectorType;
+
+            v->CloneFrom(*w[k]);
+            av->CloneFrom(*w[k]);
+
+            this->W_.push_back(v);
+            this->AW_.push_back(av);
+        }
+
+        this->deflation_update_ = (count > 0);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::SetRitzDeflation(int size, int window)
+    {
+        log_debug(this, "DeflatedCG::SetRitzDeflation()", size, window);
+
+        assert(size >= 0);
+        assert(window >= 0);
+        assert(this->build_ == false);
+
+        this->size_ritz_ = size;
+        this->window_    = window;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::SetFlexible(bool flexible)
+    {
+        log_debug(this, "DeflatedCG::SetFlexible()", flexible);
+
+        this->flexible_ = flexible;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int DeflatedCG<OperatorType, VectorType, ValueType>::GetDeflationSize(void) const
+    {
+        return static_cast<int>(this->W_.size());
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::ClearDeflationSpace(void)
+    {
+        log_debug(this, "DeflatedCG::ClearDeflationSpace()");
+
+        for(size_t i = 0; i < this->W_.size(); ++i)
+        {
+            delete this->W_[i];
+            delete this->AW_[i];
+        }
+
+        this->W_.clear();
+        this->AW_.clear();
+
+        this->deflation_update_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::UpdateDeflationSpace_(void)
+    {
+        int ndefl = static_cast<int>(this->W_.size());
+        int k     = 0;
+
+        log_debug(this, "DeflatedCG::UpdateDeflationSpace_()", ndefl);
+
+        typedef numeric_traits_t<ValueType> RealType;
+
+        // w is dropped if it is numerically contained in the span of the previous vectors
+        RealType tol = std::sqrt(std::numeric_limits<RealType>::epsilon());
+
+        this->h_.resize(ndefl + 2);
+
+        ValueType* h = this->h_.data();
+
+        for(int i = 0; i < ndefl; ++i)
+        {
+            VectorType* w  = this->W_[i];
+            VectorType* aw = this->AW_[i];
+
+            w->CloneBackend(*this->op_);
+            aw->CloneBackend(*this->op_);
+
+            this->op_->Apply(*w, aw);
+
+            RealType nrm0 = std::sqrt(std::abs(std::real(w->Dot(*aw))));
+
+            // Classical Gram-Schmidt in the A inner product, applied twice
+            for(int pass = 0; pass < 2 && k > 0; ++pass)
+            {
+                w->MultiDot(k, this->AW_.data(), h);
+
+                for(int j = 0; j < k; ++j)
+                {
+                    h[j] = -h[j];
+                }
+
+                w->MultiAddScale(k, this->W_.data(), h);
+                aw->MultiAddScale(k, this->AW_.data(), h);
+            }
+
+            RealType nrm = std::sqrt(std::abs(std::real(w->Dot(*aw))));
+
+            if(!(nrm > tol * nrm0))
+            {
+                delete w;
+                delete aw;
+
+                continue;
+            }
+
+            w->Scale(static_cast<ValueType>(1) / static_cast<ValueType>(nrm));
+            aw->Scale(static_cast<ValueType>(1) / static_cast<ValueType>(nrm));
+
+            this->W_[k]  = w;
+            this->AW_[k] = aw;
+
+            ++k;
+        }
+
+        this->W_.resize(k);
+        this->AW_.resize(k);
+
+        this->deflation_update_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::UpdateRitz_(int nstored)
+    {
+        log_debug(this, "DeflatedCG::UpdateRitz_()", nstored);
+
+        typedef numeric_traits_t<ValueType> RealType;
+
+        int ndefl = static_cast<int>(this->W_.size());
+        int n     = ndefl + nstored;
+
+        if(nstored == 0 || this->size_ritz_ == 0)
+        {
+            return;
+        }
+
+        // Z = [W, P] and AZ = [AW, AP]
+        std::vector<const VectorType*> Z(n);
+        std::vector<const VectorType*> AZ(n);
+
+        for(int i = 0; i < ndefl; ++i)
+        {
+            Z[i]  = this->W_[i];
+            AZ[i] = this->AW_[i];
+        }
+
+        for(int i = 0; i < nstored; ++i)
+        {
+            Z[ndefl + i]  = this->P_[i];
+            AZ[ndefl + i] = this->AP_[i];
+        }
+
+        // Projected operator K = Z^H A Z and Gram matrix G = Z^H Z
+        std::vector<ValueType> K(n * n);
+        std::vector<ValueType> G(n * n);
+
+        for(int j = 0; j < n; ++j)
+        {
+            AZ[j]->MultiDot(n, Z.data(), K.data() + j * n);
+            Z[j]->MultiDot(n, Z.data(), G.data() + j * n);
+        }
+
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = 0; i < j; ++i)
+            {
+                ValueType kij = static_cast<ValueType>(0.5)
+                                * (K[i + j * n] + rocalution_conj(K[j + i * n]));
+
+                K[i + j * n] = kij;
+                K[j + i * n] = rocalution_conj(kij);
+            }
+        }
+
+        // The Ritz pairs K y = theta G y follow from G y = mu K y with mu = 1 / theta,
+        // the eigenvectors are K-orthonormal
+        std::vector<double>    mu(n);
+        std::vector<ValueType> Y(n * n);
+
+        if(rocalution_hermitian_generalized_eigensystem(n, G.data(), K.data(), mu.data(), Y.data())
+           == false)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: DeflatedCG::UpdateRitz_() the projected operator is "
+                             "not positive definite, the deflation space is not updated");
+            return;
+        }
+
+        // The largest mu belong to the smallest Ritz values, numerically dependent
+        // search directions result in vanishing mu
+        RealType tol  = std::sqrt(std::numeric_limits<RealType>::epsilon());
+        int      nnew = 0;
+
+        while(nnew < std::min(this->size_ritz_, n)
+              && mu[n - 1 - nnew] > static_cast<double>(tol) * mu[n - 1])
+        {
+            ++nnew;
+        }
+
+        // W = Z y and AW = AZ y, W^H A W = I holds by construction
+        std::vector<VectorType*> W(nnew);
+        std::vector<VectorType*> AW(nnew);
+
+        for(int j = 0; j < nnew; ++j)
+        {
+            const ValueType* y = Y.data() + (n - 1 - j) * n;
+
+            W[j] = new VectorType;
+            W[j]->CloneBackend(*this->op_);
+            W[j]->Allocate("W", this->op_->GetM());
+            W[j]->Zeros();
+            W[j]->MultiAddScale(n, Z.data(), y);
+
+            AW[j] = new VectorType;
+            AW[j]->CloneBackend(*this->op_);
+            AW[j]->Allocate("AW", this->op_->GetM());
+            AW[j]->Zeros();
+            AW[j]->MultiAddScale(n, AZ.data(), y);
+        }
+
+        this->ClearDeflationSpace();
+
+        this->W_  = W;
+        this->AW_ = AW;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                           VectorType*       x)
+    {
+        log_debug(this, "DeflatedCG::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        this->SolveDeflated_(rhs, x);
+
+        log_debug(this, "DeflatedCG::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                        VectorType*       x)
+    {
+        log_debug(this, "DeflatedCG::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        this->SolveDeflated_(rhs, x);
+
+        log_debug(this, "DeflatedCG::SolvePrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void DeflatedCG<OperatorType, VectorType, ValueType>::SolveDeflated_(const VectorType& rhs,
+                                                                         VectorType*       x)
+    {
+        const OperatorType* op = this->op_;
+
+        VectorType* r = &this->r_;
+        VectorType* z = (this->precond_ != NULL) ? &this->z_ : &this->r_;
+        VectorType* p = &this->p_;
+        VectorType* q = &this->q_;
+
+        if(this->deflation_update_ == true)
+        {
+            this->UpdateDeflationSpace_();
+        }
+
+        int ndefl = static_cast<int>(this->W_.size());
+
+        // Fused projections of z onto AW, r and q, see below
+        this->h_.resize(ndefl + 2);
+        this->dot_x_.resize(ndefl + 2);
+
+        for(int j = 0; j < ndefl; ++j)
+        {
+            this->dot_x_[j] = this->AW_[j];
+        }
+
+        this->dot_x_[ndefl]     = r;
+        this->dot_x_[ndefl + 1] = q;
+
+        ValueType* h = this->h_.data();
+
+        // Initial residual = b - Ax
+        op->Apply(*x, r);
+        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        // Coarse correction x = x + W E^-1 W^H r with E = I, such that W^H r = 0
+        if(ndefl > 0)
+        {
+            r->MultiDot(ndefl, this->W_.data(), h);
+            x->MultiAddScale(ndefl, this->W_.data(), h);
+
+            for(int j = 0; j < ndefl; ++j)
+            {
+                h[j] = -h[j];
+            }
+
+            r->MultiAddScale(ndefl, this->AW_.data(), h);
+        }
+
+        // Initial residual norm |b-Ax0|
+        ValueType res = this->Norm_(*r);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res)) == false)
+        {
+            return;
+        }
+
+        // Solve Mz=r
+        if(this->precond_ != NULL)
+        {
+            this->PrecondSolveZeroSol_(*r, z);
+        }
+
+        // h = AW^H z and rho = (r,z) in a single pass
+        z->MultiDot(ndefl + 1, this->dot_x_.data(), h);
+
+        ValueType rho = h[ndefl];
+
+        // p = z - W E^-1 AW^H z
+        p->CopyFrom(*z);
+
+        if(ndefl > 0)
+        {
+            for(int j = 0; j < ndefl; ++j)
+            {
+                h[j] = -h[j];
+            }
+
+            p->MultiAddScale(ndefl, this->W_.data(), h);
+        }
+
+        int nstored = 0;
+
+        while(true)
+        {
+            // q=Ap
+            op->Apply(*p, q);
+
+            // alpha = rho / (p,q)
+            ValueType pq    = p->Dot(*q);
+            ValueType alpha = rho / pq;
+
+            // Keep the first search directions for the Ritz update
+            if(nstored < static_cast<int>(this->P_.size()))
+            {
+                this->P_[nstored]->CopyFrom(*p);
+                this->AP_[nstored]->CopyFrom(*q);
+
+                ++nstored;
+            }
+
+            // x = x + alpha*p
+            x->AddScale(*p, alpha);
+
+            // r = r - alpha*q
+            res = this->AddScaleResidualNorm_(*q, -alpha, r);
+
+            // Check convergence
+            if(this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
+            {
+                break;
+            }
+
+            // Solve Mz=r
+            if(this->precond_ != NULL)
+            {
+                this->PrecondSolveZeroSol_(*r, z);
+            }
+
+            // h = AW^H z, rho = (r,z) and (q,z) in a single pass
+            z->MultiDot(ndefl + 2, this->dot_x_.data(), h);
+
+            // beta = rho / rho_old, or -(q,z) / (p,q) for the flexible variant
+            ValueType beta = (this->flexible_ == true) ? -h[ndefl + 1] / pq : h[ndefl] / rho;
+
+            rho = h[ndefl];
+
+            // p = beta*p + z - W E^-1 AW^H z
+            p->ScaleAdd(beta, *z);
+
+            if(ndefl > 0)
+            {
+                for(int j = 0; j < ndefl; ++j)
+                {
+                    h[j] = -h[j];
+                }
+
+                p->MultiAddScale(ndefl, this->W_.data(), h);
+            }
+        }
+
+        // Ritz update of the deflation space for the next solve
+        if(this->size_ritz_ > 0)
+        {
+            this->UpdateRitz_(nstored);
+        }
+    }
+
+    template class DeflatedCG<LocalMatrix<double>, LocalVector<double>, double>;
+    template class DeflatedCG<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class DeflatedCG<LocalMatrix<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class DeflatedCG<LocalMatrix<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+    template class DeflatedCG<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class DeflatedCG<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class DeflatedCG<GlobalMatrix<std::complex<double>>,
+                              GlobalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class DeflatedCG<GlobalMatrix<std::complex<float>>,
+                              GlobalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+    template class DeflatedCG<LocalStencil<double>, LocalVector<double>, double>;
+    template class DeflatedCG<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class DeflatedCG<LocalStencil<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class DeflatedCG<LocalStencil<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+    template class DeflatedCG<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class DeflatedCG<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class DeflatedCG<LocalShellOperator<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class DeflatedCG<LocalShellOperator<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+} // namespace rocalution
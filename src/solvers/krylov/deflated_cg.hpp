@@ -0,0 +1,173 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_DEFLATED_CG_HPP_
+#define ROCALUTION_KRYLOV_DEFLATED_CG_HPP_
+
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class DeflatedCG
+  * \brief Deflated Conjugate Gradient Method
+  * \details
+  * The deflated CG method removes a subspace \f$W_{k}\f$ of dimension \f$k\f$ from the
+  * (preconditioned) CG iteration. For SPD systems with a few isolated small eigenvalues,
+  * e.g. from high-contrast coefficients, CG (even with AMG) converges slowly until
+  * these have been resolved. If \f$W_{k}\f$ approximates the corresponding
+  * eigenvectors, they are solved for directly by the coarse operator
+  * \f$E = W_{k}^{H}AW_{k}\f$, and the iteration converges as if they were not present.
+  * The initial residual is made orthogonal to \f$W_{k}\f$, and all search directions
+  * are kept \f$A\f$-orthogonal to \f$W_{k}\f$. \cite deflcg
+  *
+  * The deflation vectors can be set with SetDeflationVectors(), or be computed
+  * automatically with SetRitzDeflation(). The latter keeps the first search directions
+  * of each solve and replaces \f$W_{k}\f$ with the Ritz vectors of the smallest Ritz
+  * values of \f$span\{W_{k}, P\}\f$, such that the deflation space improves over a
+  * sequence of solves. \f$W_{k}\f$ is \f$A\f$-orthonormalized once per operator, i.e.
+  * the coarse operator is factored to \f$E = I\f$ and its solves are free. The
+  * projections of the initial residual and of the search directions are fused
+  * multi-vector operations (see LocalVector::MultiDot() and
+  * LocalVector::MultiAddScale()), which add a single pass over \f$z\f$ and one over
+  * \f$p\f$ per iteration.
+  *
+  * After ResetOperator() or ReBuildNumeric(), \f$W_{k}\f$ is \f$A\f$-orthonormalized
+  * for the new operator at the beginning of the next solve, which costs \f$k\f$
+  * operator applications. The deflation space is kept by Clear(), ClearDeflationSpace()
+  * drops it. SetFlexible() switches to the flexible variant (deflated FCG), which
+  * allows variable preconditioners, e.g. multigrid with Krylov smoothers.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class DeflatedCG : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        DeflatedCG();
+        ROCALUTION_EXPORT
+        virtual ~DeflatedCG();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Reset the operator, the deflation space is kept and
+        * \f$A\f$-orthonormalized in the next call to Solve() */
+        ROCALUTION_EXPORT
+        virtual void ResetOperator(const OperatorType& op);
+
+        /** \brief Set the deflation vectors
+        * \details
+        * The \p count vectors are copied, they may be (numerically) linearly dependent.
+        * An existing deflation space is replaced.
+        */
+        ROCALUTION_EXPORT
+        void SetDeflationVectors(int count, const VectorType* const* w);
+
+        /** \brief Compute the deflation space from the previous solves
+        * \details
+        * The first \p window search directions of each solve are kept, and the deflation
+        * space is replaced by the \p size Ritz vectors of the smallest Ritz values of the
+        * span of the deflation space and the search directions after the solve. A
+        * \p size of 0 disables the update, which is the default. The window has to be set
+        * before Build().
+        *
+        * @param[in]
+        * size    maximum dimension of the deflation space.
+        * @param[in]
+        * window  number of search directions that are kept per solve, e.g. 2 * size.
+        */
+        ROCALUTION_EXPORT
+        void SetRitzDeflation(int size, int window);
+
+        /** \brief Use the flexible variant (deflated FCG), default is false */
+        ROCALUTION_EXPORT
+        void SetFlexible(bool flexible);
+
+        /** \brief Return the current dimension of the deflation space */
+        ROCALUTION_EXPORT
+        int GetDeflationSize(void) const;
+
+        /** \brief Drop the deflation space */
+        ROCALUTION_EXPORT
+        void ClearDeflationSpace(void);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        // Deflated iteration, with or without preconditioner
+        void SolveDeflated_(const VectorType& rhs, VectorType* x);
+
+        // AW = A W for the current operator and A-orthonormalization of W
+        void UpdateDeflationSpace_(void);
+
+        // Replace W by the Ritz vectors of span{W, P} with the smallest Ritz values
+        void UpdateRitz_(int nstored);
+
+        // Deflation space, W^H A W = I
+        std::vector<VectorType*> W_;
+        std::vector<VectorType*> AW_;
+
+        // Search directions P and AP of the last solve
+        std::vector<VectorType*> P_;
+        std::vector<VectorType*> AP_;
+
+        VectorType r_, z_;
+        VectorType p_, q_;
+
+        // Dot product buffers of the projections
+        std::vector<const VectorType*> dot_x_;
+        std::vector<ValueType>         h_;
+
+        int size_ritz_;
+        int window_;
+
+        bool flexible_;
+        bool deflation_update_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_DEFLATED_CG_HPP_
@@ -101,6 +101,8 @@ namespace rocalution
     {
         log_debug(this, "FCG::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("FCG::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -287,7 +289,7 @@ namespace rocalution
         // r = r - alpha/rho * q
         r->AddScale(*q, -alpha / rho);
 
-        res = this->Norm_(*r);
+        res = this->ResidualNorm_(*r);
 
         while(!this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
         {
@@ -319,7 +321,7 @@ namespace rocalution
             // r = r - alpha*q
             r->AddScale(*q, -alpha);
 
-            res = this->Norm_(*r);
+            res = this->ResidualNorm_(*r);
         }
 
         log_debug(this, "FCG::SolveNonPrecond_()", " #*# end");
@@ -358,7 +360,7 @@ namespace rocalution
         this->iter_ctrl_.InitResidual(std::abs(res));
 
         // Mz = r
-        this->precond_->SolveZeroSol(*r, z);
+        this->PrecondSolveZeroSol_(*r, z);
 
         // w = Az
         op->Apply(*z, w);
@@ -384,12 +386,12 @@ namespace rocalution
         // r = r - alpha/rho * q
         r->AddScale(*q, -alpha / rho);
 
-        res = this->Norm_(*r);
+        res = this->ResidualNorm_(*r);
 
         while(!this->iter_ctrl_.CheckResidual(std::abs(res), this->index_))
         {
             // Mz = r
-            this->precond_->SolveZeroSol(*r, z);
+            this->PrecondSolveZeroSol_(*r, z);
 
             // w = Az
             op->Apply(*z, w);
@@ -419,7 +421,7 @@ namespace rocalution
             // r = r - alpha*q
             r->AddScale(*q, -alpha);
 
-            res = this->Norm_(*r);
+            res = this->ResidualNorm_(*r);
         }
 
         log_debug(this, "FCG::SolvePrecond_()", " #*# end");
@@ -37,8 +37,10 @@
 #include "../../utils/log.hpp"
 #include "../../utils/math_functions.hpp"
 
+#include <algorithm>
 #include <complex>
 #include <math.h>
+#include <type_traits>
 
 namespace rocalution
 {
@@ -49,13 +51,24 @@ namespace rocalution
         log_debug(this, "FGMRES::FGMRES()", "default constructor");
 
         this->size_basis_ = 30;
+        this->size_max_   = 0;
+        this->nalloc_     = 0;
+
+        this->restart_min_ = 0;
+        this->restart_max_ = 0;
+        this->ortho_alg_  = OrthoAlg_MGS;
+
+        this->basis_float_ = false;
 
         this->c_ = NULL;
         this->s_ = NULL;
         this->r_ = NULL;
         this->H_ = NULL;
+        this->h_ = NULL;
         this->v_ = NULL;
         this->z_ = NULL;
+        this->vf_ = NULL;
+        this->zf_ = NULL;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -69,6 +82,11 @@ namespace rocalution
     template <class OperatorType, class VectorType, typename ValueType>
     void FGMRES<OperatorType, VectorType, ValueType>::Print(void) const
     {
+        if(this->basis_float_ == true)
+        {
+            LOG_INFO("FGMRES Krylov basis stored in single precision");
+        }
+
         if(this->precond_ == NULL)
         {
             LOG_INFO("FGMRES solver");
@@ -112,6 +130,8 @@ namespace rocalution
     {
         log_debug(this, "FGMRES::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("FGMRES::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -126,34 +146,46 @@ namespace rocalution
             this->res_norm_type_ = 2;
         }
 
-        allocate_host(this->size_basis_, &this->c_);
-        allocate_host(this->size_basis_, &this->s_);
-        allocate_host(this->size_basis_ + 1, &this->r_);
-        allocate_host((this->size_basis_ + 1) * this->size_basis_, &this->H_);
+        // With adaptive restarts, the host buffers are sized for the maximum restart length
+        // and the basis vectors are allocated on demand
+        this->size_max_ = std::max(this->size_basis_, this->restart_max_);
 
-        this->v_ = new VectorType*[this->size_basis_ + 1];
+        allocate_host(this->size_max_, &this->c_);
+        allocate_host(this->size_max_, &this->s_);
+        allocate_host(this->size_max_ + 1, &this->r_);
+        allocate_host((this->size_max_ + 1) * this->size_max_, &this->H_);
+        allocate_host(this->size_max_ + 1, &this->h_);
 
-        for(int i = 0; i < this->size_basis_ + 1; ++i)
+        this->v_ = new VectorType*[this->size_max_ + 1];
+
+        if(this->basis_float_ == true)
         {
-            this->v_[i] = new VectorType;
-            this->v_[i]->CloneBackend(*this->op_);
-            this->v_[i]->Allocate("v", this->op_->GetM());
+            this->vf_ = new LocalVector<float>*[this->size_max_ + 1];
+            this->zf_ = new LocalVector<float>*[this->size_max_ + 1];
+
+            this->q_.CloneBackend(*this->op_);
+            this->q_.Allocate("q", this->op_->GetM());
+            this->w_.CloneBackend(*this->op_);
+            this->w_.Allocate("w", this->op_->GetM());
+
+            if(this->precond_ != NULL)
+            {
+                this->p_.CloneBackend(*this->op_);
+                this->p_.Allocate("p", this->op_->GetM());
+            }
         }
 
         if(this->precond_ != NULL)
         {
-            this->z_ = new VectorType*[this->size_basis_ + 1];
-            for(int i = 0; i < this->size_basis_ + 1; ++i)
-            {
-                this->z_[i] = new VectorType;
-                this->z_[i]->CloneBackend(*this->op_);
-                this->z_[i]->Allocate("z", this->op_->GetM());
-            }
+            this->z_ = new VectorType*[this->size_max_ + 1];
 
             this->precond_->SetOperator(*this->op_);
             this->precond_->Build();
         }
 
+        // The basis vectors are allocated on demand during the solve
+        this->nalloc_ = 0;
+
         this->build_ = true;
 
         log_debug(this, "FGMRES::Build()", this->build_, " #*# end");
@@ -166,16 +198,13 @@ namespace rocalution
 
         if(this->build_ == true)
         {
+            this->FreeBasis_();
+
             if(this->precond_ != NULL)
             {
                 this->precond_->Clear();
                 this->precond_ = NULL;
 
-                for(int i = 0; i < this->size_basis_ + 1; ++i)
-                {
-                    this->z_[i]->Clear();
-                    delete this->z_[i];
-                }
                 delete[] this->z_;
                 this->z_ = NULL;
             }
@@ -184,15 +213,20 @@ namespace rocalution
             free_host(&this->s_);
             free_host(&this->r_);
             free_host(&this->H_);
+            free_host(&this->h_);
 
-            for(int i = 0; i < this->size_basis_ + 1; ++i)
-            {
-                this->v_[i]->Clear();
-                delete this->v_[i];
-            }
             delete[] this->v_;
             this->v_ = NULL;
 
+            delete[] this->vf_;
+            delete[] this->zf_;
+            this->vf_ = NULL;
+            this->zf_ = NULL;
+
+            this->q_.Clear();
+            this->w_.Clear();
+            this->p_.Clear();
+
             this->iter_ctrl_.Clear();
 
             this->build_ = false;
@@ -206,16 +240,35 @@ namespace rocalution
 
         if(this->build_ == true)
         {
-            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            if(this->basis_float_ == true)
+            {
+                for(int i = 0; i < this->nalloc_; ++i)
+                {
+                    this->vf_[i]->Zeros();
+
+                    if(this->precond_ != NULL)
+                    {
+                        this->zf_[i]->Zeros();
+                    }
+                }
+
+                this->q_.Zeros();
+                this->w_.Zeros();
+                this->p_.Zeros();
+            }
+            else
             {
-                this->v_[i]->Zeros();
+                for(int i = 0; i < this->nalloc_; ++i)
+                {
+                    this->v_[i]->Zeros();
+                }
             }
 
             this->iter_ctrl_.Clear();
 
             if(this->precond_ != NULL)
             {
-                for(int i = 0; i < this->size_basis_ + 1; ++i)
+                for(int i = 0; i < this->nalloc_ && this->basis_float_ == false; ++i)
                 {
                     this->z_[i]->Zeros();
                 }
@@ -235,14 +288,33 @@ namespace rocalution
 
         if(this->build_ == true)
         {
-            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            if(this->basis_float_ == true)
             {
-                this->v_[i]->MoveToHost();
+                for(int i = 0; i < this->nalloc_; ++i)
+                {
+                    this->vf_[i]->MoveToHost();
+
+                    if(this->precond_ != NULL)
+                    {
+                        this->zf_[i]->MoveToHost();
+                    }
+                }
+
+                this->q_.MoveToHost();
+                this->w_.MoveToHost();
+                this->p_.MoveToHost();
+            }
+            else
+            {
+                for(int i = 0; i < this->nalloc_; ++i)
+                {
+                    this->v_[i]->MoveToHost();
+                }
             }
 
             if(this->precond_ != NULL)
             {
-                for(int i = 0; i < this->size_basis_ + 1; ++i)
+                for(int i = 0; i < this->nalloc_ && this->basis_float_ == false; ++i)
                 {
                     this->z_[i]->MoveToHost();
                 }
@@ -259,14 +331,33 @@ namespace rocalution
 
         if(this->build_ == true)
         {
-            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            if(this->basis_float_ == true)
+            {
+                for(int i = 0; i < this->nalloc_; ++i)
+                {
+                    this->vf_[i]->MoveToAccelerator();
+
+                    if(this->precond_ != NULL)
+                    {
+                        this->zf_[i]->MoveToAccelerator();
+                    }
+                }
+
+                this->q_.MoveToAccelerator();
+                this->w_.MoveToAccelerator();
+                this->p_.MoveToAccelerator();
+            }
+            else
             {
-                this->v_[i]->MoveToAccelerator();
+                for(int i = 0; i < this->nalloc_; ++i)
+                {
+                    this->v_[i]->MoveToAccelerator();
+                }
             }
 
             if(this->precond_ != NULL)
             {
-                for(int i = 0; i < this->size_basis_ + 1; ++i)
+                for(int i = 0; i < this->nalloc_ && this->basis_float_ == false; ++i)
                 {
                     this->z_[i]->MoveToAccelerator();
                 }
@@ -286,10 +377,479 @@ namespace rocalution
         this->size_basis_ = size_basis;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FGMRES<OperatorType, VectorType, ValueType>::SetAdaptiveRestart(int min_size, int max_size)
+    {
+        log_debug(this, "FGMRES::SetAdaptiveRestart()", min_size, max_size);
+
+        assert(min_size > 0);
+        assert(max_size >= min_size);
+        assert(this->build_ == false);
+
+        this->restart_min_ = min_size;
+        this->restart_max_ = max_size;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int FGMRES<OperatorType, VectorType, ValueType>::InitialRestart_(void) const
+    {
+        if(this->restart_max_ == 0)
+        {
+            return this->size_basis_;
+        }
+
+        return std::min(std::max(this->size_basis_, this->restart_min_), this->restart_max_);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FGMRES<OperatorType, VectorType, ValueType>::AllocateBasis_(int size)
+    {
+        assert(size <= this->size_max_);
+
+        for(int i = this->nalloc_; i < size + 1; ++i)
+        {
+            if(this->basis_float_ == true)
+            {
+                this->vf_[i] = new LocalVector<float>;
+                this->vf_[i]->CloneBackend(*this->op_);
+                this->vf_[i]->Allocate("v", this->op_->GetLocalM());
+
+                if(this->precond_ != NULL)
+                {
+                    this->zf_[i] = new LocalVector<float>;
+                    this->zf_[i]->CloneBackend(*this->op_);
+                    this->zf_[i]->Allocate("z", this->op_->GetLocalM());
+                }
+
+                continue;
+            }
+
+            if(this->workspace_ != NULL)
+            {
+                this->v_[i] = this->workspace_->Acquire(*this->op_);
+
+                if(this->precond_ != NULL)
+                {
+                    this->z_[i] = this->workspace_->Acquire(*this->op_);
+                }
+
+                continue;
+            }
+
+            this->v_[i] = new VectorType;
+            this->v_[i]->CloneBackend(*this->op_);
+            this->v_[i]->Allocate("v", this->op_->GetM());
+
+            if(this->precond_ != NULL)
+            {
+                this->z_[i] = new VectorType;
+                this->z_[i]->CloneBackend(*this->op_);
+                this->z_[i]->Allocate("z", this->op_->GetM());
+            }
+        }
+
+        this->nalloc_ = std::max(this->nalloc_, size + 1);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FGMRES<OperatorType, VectorType, ValueType>::FreeBasis_(void)
+    {
+        for(int i = 0; i < this->nalloc_; ++i)
+        {
+            if(this->basis_float_ == true)
+            {
+                delete this->vf_[i];
+
+                if(this->precond_ != NULL)
+                {
+                    delete this->zf_[i];
+                }
+            }
+            else if(this->workspace_ != NULL)
+            {
+                this->workspace_->Release(this->v_[i]);
+
+                if(this->precond_ != NULL)
+                {
+                    this->workspace_->Release(this->z_[i]);
+                }
+            }
+            else
+            {
+                delete this->v_[i];
+
+                if(this->precond_ != NULL)
+                {
+                    delete this->z_[i];
+                }
+            }
+        }
+
+        this->nalloc_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FGMRES<OperatorType, VectorType, ValueType>::ReleaseBasis_(void)
+    {
+        // Vectors of the workspace are returned after each solve, own vectors are kept
+        if(this->workspace_ != NULL && this->basis_float_ == false)
+        {
+            this->FreeBasis_();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int FGMRES<OperatorType, VectorType, ValueType>::AdaptRestart_(int size, double rate)
+    {
+        if(this->restart_max_ == 0)
+        {
+            return size;
+        }
+
+        // Restart strategy of Baker, Jessup and Kolev with the thresholds cos(8 deg) and
+        // cos(80 deg) on the residual reduction of the last cycle. Near stagnation, the
+        // maximum restart length is used. Fast converging cycles keep the restart length,
+        // otherwise it is decreased and wraps around to the maximum at the lower bound.
+        const double rate_max = 0.99027;
+        const double rate_min = 0.17365;
+        const int    step     = 3;
+
+        if(rate > rate_max)
+        {
+            size = this->restart_max_;
+        }
+        else if(rate >= rate_min)
+        {
+            size = (size - step >= this->restart_min_) ? size - step : this->restart_max_;
+        }
+
+        log_debug(this, "FGMRES::AdaptRestart_()", rate, size);
+
+        return size;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FGMRES<OperatorType, VectorType, ValueType>::SetOrthogonalization(OrthoAlg alg)
+    {
+        log_debug(this, "FGMRES::SetOrthogonalization()", alg);
+
+        assert(alg == OrthoAlg_MGS || alg == OrthoAlg_CGS || alg == OrthoAlg_CGS2);
+
+        this->ortho_alg_ = alg;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FGMRES<OperatorType, VectorType, ValueType>::SetReducedPrecisionBasis(bool enable)
+    {
+        log_debug(this, "FGMRES::SetReducedPrecisionBasis()", enable);
+
+        assert(this->build_ == false);
+
+        if(enable == true && std::is_same<ValueType, double>::value == false)
+        {
+            LOG_INFO("Reduced precision Krylov basis is only available for double precision");
+
+            return;
+        }
+
+        this->basis_float_ = enable;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FGMRES<OperatorType, VectorType, ValueType>::Orthogonalize_(int          i,
+                                                                     VectorType** v,
+                                                                     ValueType*   H)
+    {
+        int size = this->size_max_;
+
+        VectorType* w = v[i + 1];
+
+        int ip1i = DENSE_IND(i + 1, i, size + 1, size);
+
+        if(this->ortho_alg_ == OrthoAlg_MGS)
+        {
+            // Modified Gram-Schmidt
+            for(int k = 0; k <= i; ++k)
+            {
+                int idx = DENSE_IND(k, i, size + 1, size);
+                // H_ki = <v_k,v_i+1>
+                H[idx] = v[k]->Dot(*w);
+                // v_i+1 -= H_ki * v_k
+                w->AddScale(*v[k], -H[idx]);
+            }
+
+            // H_i+1i = ||v_i+1||
+            H[ip1i] = this->Norm_(*w);
+
+            return;
+        }
+
+        // Classical Gram-Schmidt, each pass computes h_k = <v_k,v_i+1> and
+        // <v_i+1,v_i+1> with a single reduction
+        int npass = (this->ortho_alg_ == OrthoAlg_CGS2) ? 2 : 1;
+
+        ValueType* h = this->h_;
+        ValueType  ww;
+        ValueType  nrm2;
+
+        for(int k = 0; k <= i; ++k)
+        {
+            H[DENSE_IND(k, i, size + 1, size)] = static_cast<ValueType>(0);
+        }
+
+        for(int pass = 0; pass < npass; ++pass)
+        {
+            w->MultiDot(i + 2, v, h);
+
+            ww   = h[i + 1];
+            nrm2 = ww;
+
+            for(int k = 0; k <= i; ++k)
+            {
+                // H_ki += h_k
+                H[DENSE_IND(k, i, size + 1, size)] += h[k];
+                // v_i+1 -= h_k * v_k
+                w->AddScale(*v[k], -h[k]);
+
+                nrm2 -= rocalution_conj(h[k]) * h[k];
+            }
+        }
+
+        // H_i+1i = ||v_i+1||, obtained from ||v_i+1||^2 - ||h||^2 unless there is
+        // severe cancellation
+        if(std::real(nrm2) > std::real(ww) / 100)
+        {
+            H[ip1i] = static_cast<ValueType>(std::sqrt(std::real(nrm2)));
+        }
+        else
+        {
+            H[ip1i] = this->Norm_(*w);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FGMRES<OperatorType, VectorType, ValueType>::OrthogonalizeFloat_(int         i,
+                                                                          VectorType* w,
+                                                                          ValueType*  H)
+    {
+        int size = this->size_max_;
+
+        LocalVector<float>** v = this->vf_;
+
+        if(this->ortho_alg_ == OrthoAlg_MGS)
+        {
+            // Modified Gram-Schmidt
+            for(int k = 0; k <= i; ++k)
+            {
+                int idx = DENSE_IND(k, i, size + 1, size);
+                // H_ki = <v_k,w>
+                H[idx] = w->DotFloat(*v[k]);
+                // w -= H_ki * v_k
+                w->AddScaleFloat(*v[k], -H[idx]);
+            }
+        }
+        else
+        {
+            // Classical Gram-Schmidt, all projections of a pass are computed before w is
+            // updated. There is no mixed precision MultiDot, such that each projection is
+            // a separate reduction.
+            int npass = (this->ortho_alg_ == OrthoAlg_CGS2) ? 2 : 1;
+
+            ValueType* h = this->h_;
+
+            for(int k = 0; k <= i; ++k)
+            {
+                H[DENSE_IND(k, i, size + 1, size)] = static_cast<ValueType>(0);
+            }
+
+            for(int pass = 0; pass < npass; ++pass)
+            {
+                for(int k = 0; k <= i; ++k)
+                {
+                    h[k] = w->DotFloat(*v[k]);
+                }
+
+                for(int k = 0; k <= i; ++k)
+                {
+                    H[DENSE_IND(k, i, size + 1, size)] += h[k];
+                    w->AddScaleFloat(*v[k], -h[k]);
+                }
+            }
+        }
+
+        // H_i+1i = ||w||
+        H[DENSE_IND(i + 1, i, size + 1, size)] = this->Norm_(*w);
+    }
+
+    // The flexible Arnoldi process with the basis and the preconditioned vectors stored in
+    // single precision. The current vector q = v_i, its preconditioned vector p = z_i and
+    // the next vector w are kept in double precision.
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FGMRES<OperatorType, VectorType, ValueType>::SolveReducedBasis_(const VectorType& rhs,
+                                                                         VectorType*       x)
+    {
+        log_debug(this, "FGMRES::SolveReducedBasis_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+        assert(this->basis_float_ == true);
+        assert(this->res_norm_type_ == 2);
+
+        const OperatorType* op = this->op_;
+
+        VectorType* p = &this->p_;
+        VectorType* q = &this->q_;
+        VectorType* w = &this->w_;
+
+        LocalVector<float>** v = this->vf_;
+        LocalVector<float>** z = (this->precond_ != NULL) ? this->zf_ : this->vf_;
+
+        ValueType* c = this->c_;
+        ValueType* s = this->s_;
+        ValueType* r = this->r_;
+        ValueType* H = this->H_;
+
+        ValueType one = static_cast<ValueType>(1);
+
+        // Leading dimension of H and current restart length
+        int size = this->size_max_;
+        int m    = this->InitialRestart_();
+
+        this->AllocateBasis_(0);
+
+        // Initial residual
+        op->Apply(*x, w);
+        w->ScaleAdd(-one, rhs);
+
+        // r = 0
+        set_to_zero_host(size + 1, r);
+
+        // r_0 = ||w||
+        r[0] = this->Norm_(*w);
+
+        // Initial residual
+        if(this->iter_ctrl_.InitResidual(std::abs(r[0])) == false)
+        {
+            log_debug(this, "FGMRES::SolveReducedBasis_()", " #*# end");
+            return;
+        }
+
+        while(true)
+        {
+            double res_cycle = std::abs(r[0]);
+
+            // q = v_0 = w / r_0
+            w->ScaleCopyToFloat(one / r[0], v[0]);
+            std::swap(q, w);
+
+            // Arnoldi iteration
+            int i = 0;
+            while(i < m)
+            {
+                this->AllocateBasis_(i + 1);
+
+                if(this->precond_ != NULL)
+                {
+                    // Solve Mp = q, z_i = p
+                    this->PrecondSolveZeroSol_(*q, p);
+                    p->ScaleCopyToFloat(one, z[i]);
+
+                    // w = Ap
+                    op->Apply(*p, w);
+                }
+                else
+                {
+                    // w = Aq
+                    op->Apply(*q, w);
+                }
+
+                // Build Hessenberg matrix H, H_ki = <v_k,w> and H_i+1i = ||w||
+                this->OrthogonalizeFloat_(i, w, H);
+
+                // Precompute some indices
+                int ii   = DENSE_IND(i, i, size + 1, size);
+                int ip1i = DENSE_IND(i + 1, i, size + 1, size);
+
+                // q = v_i+1 = w / H_i+1i
+                w->ScaleCopyToFloat(one / H[ip1i], v[i + 1]);
+                std::swap(q, w);
+
+                // Apply Givens rotation J(0),...,J(j-1) on (H(0,i),...,H(i,i))
+                for(int k = 0; k < i; ++k)
+                {
+                    int ki   = DENSE_IND(k, i, size + 1, size);
+                    int kp1i = DENSE_IND(k + 1, i, size + 1, size);
+                    this->ApplyGivensRotation_(c[k], s[k], H[ki], H[kp1i]);
+                }
+
+                // Construct J(i)
+                this->GenerateGivensRotation_(H[ii], H[ip1i], c[i], s[i]);
+
+                // Apply J(i) to H(i,i) and H(i,i+1) such that H(i,i+1) = 0
+                this->ApplyGivensRotation_(c[i], s[i], H[ii], H[ip1i]);
+
+                // Apply J(i) to the norm of the residual sg[i]
+                this->ApplyGivensRotation_(c[i], s[i], r[i], r[i + 1]);
+
+                // Check convergence
+                if(this->iter_ctrl_.CheckResidual(std::abs(r[++i])))
+                {
+                    break;
+                }
+            }
+
+            // Solve upper triangular system
+            for(int j = i - 1; j >= 0; --j)
+            {
+                r[j] /= H[DENSE_IND(j, j, size + 1, size)];
+
+                for(int k = 0; k < j; ++k)
+                {
+                    r[k] -= H[DENSE_IND(k, j, size + 1, size)] * r[j];
+                }
+            }
+
+            // Update solution
+            for(int j = 0; j < i; ++j)
+            {
+                x->AddScaleFloat(*z[j], r[j]);
+            }
+
+            // Compute residual w = b - Ax in double precision
+            op->Apply(*x, w);
+            w->ScaleAdd(-one, rhs);
+
+            // r = 0
+            set_to_zero_host(size + 1, r);
+
+            // r_0 = ||w||
+            r[0] = this->Norm_(*w);
+
+            // Check convergence
+            if(this->iter_ctrl_.CheckResidualNoCount(std::abs(r[0])))
+            {
+                break;
+            }
+
+            // Adapt the restart length to the convergence of the last cycle
+            m = this->AdaptRestart_(m, std::abs(r[0]) / res_cycle);
+        }
+
+        log_debug(this, "FGMRES::SolveReducedBasis_()", " #*# end");
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void FGMRES<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
                                                                        VectorType*       x)
     {
+        if(this->basis_float_ == true)
+        {
+            this->SolveReducedBasis_(rhs, x);
+            return;
+        }
+
         log_debug(this, "FGMRES::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
 
         assert(x != NULL);
@@ -311,7 +871,12 @@ namespace rocalution
 
         ValueType one = static_cast<ValueType>(1);
 
-        int size = this->size_basis_;
+        // Leading dimension of H and current restart length
+        int size = this->size_max_;
+        int m    = this->InitialRestart_();
+
+        // The basis grows on demand, v_0 is needed for the initial residual
+        this->AllocateBasis_(0);
 
         // Initial residual
         op->Apply(*x, v[0]);
@@ -326,39 +891,35 @@ namespace rocalution
         // Initial residual
         if(this->iter_ctrl_.InitResidual(std::abs(r[0])) == false)
         {
+            this->ReleaseBasis_();
+
             log_debug(this, "GMRES::SolvePrecond_()", " #*# end");
             return;
         }
 
         while(true)
         {
+            double res_cycle = std::abs(r[0]);
+
             // Normalize v_0
             v[0]->Scale(one / r[0]);
 
             // Arnoldi iteration
             int i = 0;
-            while(i < size)
+            while(i < m)
             {
+                this->AllocateBasis_(i + 1);
+
                 // v_i+1 = Az_i
                 op->Apply(*v[i], v[i + 1]);
 
-                // Build Hessenberg matrix H
-                for(int k = 0; k <= i; ++k)
-                {
-                    int idx = DENSE_IND(k, i, size + 1, size);
-                    // H_ki = <v_k,v_i+1>
-                    H[idx] = v[k]->Dot(*v[i + 1]);
-                    // v_i+1 -= H_ki * v_k
-                    v[i + 1]->AddScale(*v[k], -H[idx]);
-                }
+                // Build Hessenberg matrix H, H_ki = <v_k,v_i+1> and H_i+1i = ||v_i+1||
+                this->Orthogonalize_(i, v, H);
 
                 // Precompute some indices
                 int ii   = DENSE_IND(i, i, size + 1, size);
                 int ip1i = DENSE_IND(i + 1, i, size + 1, size);
 
-                // H_i+1i = ||v_i+1||
-                H[ip1i] = this->Norm_(*v[i + 1]);
-
                 // v_i+1 /= H_i+1i
                 v[i + 1]->Scale(one / H[ip1i]);
 
@@ -420,8 +981,13 @@ namespace rocalution
             {
                 break;
             }
+
+            // Adapt the restart length to the convergence of the last cycle
+            m = this->AdaptRestart_(m, std::abs(r[0]) / res_cycle);
         }
 
+        this->ReleaseBasis_();
+
         log_debug(this, "FGMRES::SolveNonPrecond_()", " #*# end");
     }
 
@@ -429,6 +995,12 @@ namespace rocalution
     void FGMRES<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
                                                                     VectorType*       x)
     {
+        if(this->basis_float_ == true)
+        {
+            this->SolveReducedBasis_(rhs, x);
+            return;
+        }
+
         log_debug(this, "FGMRES::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
 
         assert(x != NULL);
@@ -451,7 +1023,12 @@ namespace rocalution
 
         ValueType one = static_cast<ValueType>(1);
 
-        int size = this->size_basis_;
+        // Leading dimension of H and current restart length
+        int size = this->size_max_;
+        int m    = this->InitialRestart_();
+
+        // The basis grows on demand, v_0 is needed for the initial residual
+        this->AllocateBasis_(0);
 
         // Initial residual
         op->Apply(*x, v[0]);
@@ -466,42 +1043,38 @@ namespace rocalution
         // Initial residual
         if(this->iter_ctrl_.InitResidual(std::abs(r[0])) == false)
         {
+            this->ReleaseBasis_();
+
             log_debug(this, "GMRES::SolvePrecond_()", " #*# end");
             return;
         }
 
         while(true)
         {
+            double res_cycle = std::abs(r[0]);
+
             // Normalize v_0
             v[0]->Scale(one / r[0]);
 
             // Arnoldi iteration
             int i = 0;
-            while(i < size)
+            while(i < m)
             {
+                this->AllocateBasis_(i + 1);
+
                 // Solve Mz_i = v_i
-                this->precond_->SolveZeroSol(*v[i], z[i]);
+                this->PrecondSolveZeroSol_(*v[i], z[i]);
 
                 // v_i+1 = Az_i
                 op->Apply(*z[i], v[i + 1]);
 
-                // Build Hessenberg matrix H
-                for(int k = 0; k <= i; ++k)
-                {
-                    int idx = DENSE_IND(k, i, size + 1, size);
-                    // H_ki = <v_k,v_i+1>
-                    H[idx] = v[k]->Dot(*v[i + 1]);
-                    // v_i+1 -= H_ki * v_k
-                    v[i + 1]->AddScale(*v[k], -H[idx]);
-                }
+                // Build Hessenberg matrix H, H_ki = <v_k,v_i+1> and H_i+1i = ||v_i+1||
+                this->Orthogonalize_(i, v, H);
 
                 // Precompute some indices
                 int ii   = DENSE_IND(i, i, size + 1, size);
                 int ip1i = DENSE_IND(i + 1, i, size + 1, size);
 
-                // H_i+1i = ||v_i+1||
-                H[ip1i] = this->Norm_(*v[i + 1]);
-
                 // v_i+1 /= H_i+1i
                 v[i + 1]->Scale(one / H[ip1i]);
 
@@ -563,8 +1136,13 @@ namespace rocalution
             {
                 break;
             }
+
+            // Adapt the restart length to the convergence of the last cycle
+            m = this->AdaptRestart_(m, std::abs(r[0]) / res_cycle);
         }
 
+        this->ReleaseBasis_();
+
         log_debug(this, "FGMRES::SolvePrecond_()", " #*# end");
     }
 
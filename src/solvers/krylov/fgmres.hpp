@@ -74,6 +74,48 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual void SetBasisSize(int size_basis);
 
+        /** \brief Adapt the restart length between cycles
+        * \details
+        * After each restart cycle, the restart length is set to \p max_size if the residual
+        * reduction of the cycle indicates stagnation, kept if the cycle converged fast and
+        * decreased otherwise, wrapping around to \p max_size when \p min_size would be
+        * undercut. The initial restart length is the basis size clamped to these bounds.
+        * Basis vectors are allocated on demand, so memory for \p max_size vectors is only
+        * consumed when the convergence requires it.
+        * \cite baker2009
+        *
+        * \param[in]
+        * min_size    minimum restart length.
+        * \param[in]
+        * max_size    maximum restart length.
+        */
+        ROCALUTION_EXPORT
+        void SetAdaptiveRestart(int min_size, int max_size);
+
+        /** \brief Set the orthogonalization algorithm of the Krylov basis
+        * \details
+        * Modified Gram-Schmidt (OrthoAlg_MGS, default) requires one global reduction per
+        * basis vector. The classical Gram-Schmidt variants compute all projections of
+        * an iteration with a single reduction, OrthoAlg_CGS2 adds a second
+        * (re-)orthogonalization pass to recover the stability of modified Gram-Schmidt.
+        */
+        ROCALUTION_EXPORT
+        void SetOrthogonalization(OrthoAlg alg);
+
+        /** \brief Store the Krylov basis in single precision
+        * \details
+        * The basis vectors and the preconditioned vectors are stored rounded to single
+        * precision, which halves their memory footprint and traffic. The current Arnoldi
+        * vector, the Hessenberg matrix and the residual are kept in double precision, and
+        * the single precision entries are widened while they are loaded in the fused dot
+        * product and update kernels. Only available for double precision.
+        *
+        * \param[in]
+        * enable    true to store the basis in single precision.
+        */
+        ROCALUTION_EXPORT
+        void SetReducedPrecisionBasis(bool enable);
+
     protected:
         virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
         virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
@@ -89,16 +131,53 @@ namespace rocalution
         /** \brief Apply Givens rotation */
         static void ApplyGivensRotation_(ValueType c, ValueType s, ValueType& dx, ValueType& dy);
 
+        /** \brief Orthogonalize v_i+1 against v_0, ..., v_i and build column i of H */
+        void Orthogonalize_(int i, VectorType** v, ValueType* H);
+        /** \brief Orthogonalize w against the single precision basis v_0, ..., v_i and build
+        * column i of H */
+        void OrthogonalizeFloat_(int i, VectorType* w, ValueType* H);
+        /** \brief Solve with the Krylov basis stored in single precision */
+        void SolveReducedBasis_(const VectorType& rhs, VectorType* x);
+
+        /** \brief Initial restart length of a solve */
+        int InitialRestart_(void) const;
+        /** \brief Allocate the basis vectors up to index \p size, or acquire them from
+        * the workspace */
+        void AllocateBasis_(int size);
+        /** \brief Free the basis vectors, or return them to the workspace */
+        void FreeBasis_(void);
+        /** \brief Return the basis vectors to the workspace at the end of a solve */
+        void ReleaseBasis_(void);
+        /** \brief Adapt the restart length \p size to the residual reduction \p rate */
+        int AdaptRestart_(int size, double rate);
+
     private:
         VectorType** v_;
         VectorType** z_;
 
+        // Single precision basis and preconditioned vectors, current and next Arnoldi
+        // vector and preconditioned vector
+        LocalVector<float>** vf_;
+        LocalVector<float>** zf_;
+        VectorType           q_;
+        VectorType           w_;
+        VectorType           p_;
+        bool                 basis_float_;
+
         ValueType* c_;
         ValueType* s_;
         ValueType* r_;
         ValueType* H_;
+        ValueType* h_;
 
         int size_basis_;
+        int size_max_;
+        int nalloc_;
+
+        int restart_min_;
+        int restart_max_;
+
+        OrthoAlg ortho_alg_;
     };
 
 } // namespace rocalution
@@ -26,6 +26,7 @@
 #include "../iter_ctrl.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_shell_operator.hpp"
 #include "../../base/local_stencil.hpp"
 #include "../../base/local_vector.hpp"
 #include "../../base/matrix_formats_ind.hpp"
@@ -37,8 +38,10 @@
 #include "../../utils/log.hpp"
 #include "../../utils/math_functions.hpp"
 
+#include <algorithm>
 #include <complex>
 #include <math.h>
+#include <type_traits>
 
 namespace rocalution
 {
@@ -49,12 +52,22 @@ namespace rocalution
         log_debug(this, "GMRES::GMRES()", "default constructor");
 
         this->size_basis_ = 30;
+        this->size_max_   = 0;
+        this->nalloc_     = 0;
+
+        this->restart_min_ = 0;
+        this->restart_max_ = 0;
+        this->ortho_alg_  = OrthoAlg_MGS;
+
+        this->basis_float_ = false;
 
         this->c_ = NULL;
         this->s_ = NULL;
         this->r_ = NULL;
         this->H_ = NULL;
+        this->h_ = NULL;
         this->v_ = NULL;
+        this->vf_ = NULL;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -68,6 +81,11 @@ namespace rocalution
     template <class OperatorType, class VectorType, typename ValueType>
     void GMRES<OperatorType, VectorType, ValueType>::Print(void) const
     {
+        if(this->basis_float_ == true)
+        {
+            LOG_INFO("GMRES Krylov basis stored in single precision");
+        }
+
         if(this->precond_ == NULL)
         {
             LOG_INFO("GMRES solver");
@@ -111,6 +129,8 @@ namespace rocalution
     {
         log_debug(this, "GMRES::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("GMRES::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -129,18 +149,26 @@ namespace rocalution
             this->res_norm_type_ = 2;
         }
 
-        allocate_host(this->size_basis_, &this->c_);
-        allocate_host(this->size_basis_, &this->s_);
-        allocate_host(this->size_basis_ + 1, &this->r_);
-        allocate_host((this->size_basis_ + 1) * this->size_basis_, &this->H_);
+        // With adaptive restarts, the host buffers are sized for the maximum restart length
+        // and the basis vectors are allocated on demand
+        this->size_max_ = std::max(this->size_basis_, this->restart_max_);
 
-        this->v_ = new VectorType*[this->size_basis_ + 1];
+        allocate_host(this->size_max_, &this->c_);
+        allocate_host(this->size_max_, &this->s_);
+        allocate_host(this->size_max_ + 1, &this->r_);
+        allocate_host((this->size_max_ + 1) * this->size_max_, &this->H_);
+        allocate_host(this->size_max_ + 1, &this->h_);
 
-        for(int i = 0; i < this->size_basis_ + 1; ++i)
+        this->v_ = new VectorType*[this->size_max_ + 1];
+
+        if(this->basis_float_ == true)
         {
-            this->v_[i] = new VectorType;
-            this->v_[i]->CloneBackend(*this->op_);
-            this->v_[i]->Allocate("v", this->op_->GetM());
+            this->vf_ = new LocalVector<float>*[this->size_max_ + 1];
+
+            this->q_.CloneBackend(*this->op_);
+            this->q_.Allocate("q", this->op_->GetM());
+            this->w_.CloneBackend(*this->op_);
+            this->w_.Allocate("w", this->op_->GetM());
         }
 
         if(this->precond_ != NULL)
@@ -152,6 +180,9 @@ namespace rocalution
             this->precond_->Build();
         }
 
+        // The basis vectors are allocated on demand during the solve
+        this->nalloc_ = 0;
+
         this->build_ = true;
 
         log_debug(this, "GMRES::Build()", this->build_, " #*# end");
@@ -175,15 +206,19 @@ namespace rocalution
             free_host(&this->s_);
             free_host(&this->r_);
             free_host(&this->H_);
+            free_host(&this->h_);
+
+            this->FreeBasis_();
 
-            for(int i = 0; i < this->size_basis_ + 1; ++i)
-            {
-                this->v_[i]->Clear();
-                delete this->v_[i];
-            }
             delete[] this->v_;
             this->v_ = NULL;
 
+            delete[] this->vf_;
+            this->vf_ = NULL;
+
+            this->q_.Clear();
+            this->w_.Clear();
+
             this->iter_ctrl_.Clear();
 
             this->build_ = false;
@@ -197,9 +232,22 @@ namespace rocalution
 
         if(this->build_ == true)
         {
-            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            for(int i = 0; i < this->nalloc_; ++i)
+            {
+                if(this->basis_float_ == true)
+                {
+                    this->vf_[i]->Zeros();
+                }
+                else
+                {
+                    this->v_[i]->Zeros();
+                }
+            }
+
+            if(this->basis_float_ == true)
             {
-                this->v_[i]->Zeros();
+                this->q_.Zeros();
+                this->w_.Zeros();
             }
 
             this->iter_ctrl_.Clear();
@@ -223,9 +271,22 @@ namespace rocalution
 
         if(this->build_ == true)
         {
-            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            for(int i = 0; i < this->nalloc_; ++i)
             {
-                this->v_[i]->MoveToHost();
+                if(this->basis_float_ == true)
+                {
+                    this->vf_[i]->MoveToHost();
+                }
+                else
+                {
+                    this->v_[i]->MoveToHost();
+                }
+            }
+
+            if(this->basis_float_ == true)
+            {
+                this->q_.MoveToHost();
+                this->w_.MoveToHost();
             }
 
             if(this->precond_ != NULL)
@@ -243,9 +304,22 @@ namespace rocalution
 
         if(this->build_ == true)
         {
-            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            for(int i = 0; i < this->nalloc_; ++i)
             {
-                this->v_[i]->MoveToAccelerator();
+                if(this->basis_float_ == true)
+                {
+                    this->vf_[i]->MoveToAccelerator();
+                }
+                else
+                {
+                    this->v_[i]->MoveToAccelerator();
+                }
+            }
+
+            if(this->basis_float_ == true)
+            {
+                this->q_.MoveToAccelerator();
+                this->w_.MoveToAccelerator();
             }
 
             if(this->precond_ != NULL)
@@ -267,6 +341,453 @@ namespace rocalution
         this->size_basis_ = size_basis;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRES<OperatorType, VectorType, ValueType>::SetAdaptiveRestart(int min_size, int max_size)
+    {
+        log_debug(this, "GMRES::SetAdaptiveRestart()", min_size, max_size);
+
+        assert(min_size > 0);
+        assert(max_size >= min_size);
+        assert(this->build_ == false);
+
+        this->restart_min_ = min_size;
+        this->restart_max_ = max_size;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int GMRES<OperatorType, VectorType, ValueType>::InitialRestart_(void) const
+    {
+        if(this->restart_max_ == 0)
+        {
+            return this->size_basis_;
+        }
+
+        return std::min(std::max(this->size_basis_, this->restart_min_), this->restart_max_);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRES<OperatorType, VectorType, ValueType>::AllocateBasis_(int size)
+    {
+        assert(size <= this->size_max_);
+
+        for(int i = this->nalloc_; i < size + 1; ++i)
+        {
+            if(this->basis_float_ == true)
+            {
+                this->vf_[i] = new LocalVector<float>;
+                this->vf_[i]->CloneBackend(*this->op_);
+                this->vf_[i]->Allocate("v", this->op_->GetLocalM());
+            }
+            else if(this->workspace_ != NULL)
+            {
+                this->v_[i] = this->workspace_->Acquire(*this->op_);
+            }
+            else
+            {
+                this->v_[i] = new VectorType;
+                this->v_[i]->CloneBackend(*this->op_);
+                this->v_[i]->Allocate("v", this->op_->GetM());
+            }
+        }
+
+        this->nalloc_ = std::max(this->nalloc_, size + 1);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRES<OperatorType, VectorType, ValueType>::FreeBasis_(void)
+    {
+        for(int i = 0; i < this->nalloc_; ++i)
+        {
+            if(this->basis_float_ == true)
+            {
+                delete this->vf_[i];
+            }
+            else if(this->workspace_ != NULL)
+            {
+                this->workspace_->Release(this->v_[i]);
+            }
+            else
+            {
+                delete this->v_[i];
+            }
+        }
+
+        this->nalloc_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRES<OperatorType, VectorType, ValueType>::ReleaseBasis_(void)
+    {
+        // Vectors of the workspace are returned after each solve, own vectors are kept
+        if(this->workspace_ != NULL && this->basis_float_ == false)
+        {
+            this->FreeBasis_();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int GMRES<OperatorType, VectorType, ValueType>::AdaptRestart_(int size, double rate)
+    {
+        if(this->restart_max_ == 0)
+        {
+            return size;
+        }
+
+        // Restart strategy of Baker, Jessup and Kolev with the thresholds cos(8 deg) and
+        // cos(80 deg) on the residual reduction of the last cycle. Near stagnation, the
+        // maximum restart length is used. Fast converging cycles keep the restart length,
+        // otherwise it is decreased and wraps around to the maximum at the lower bound.
+        const double rate_max = 0.99027;
+        const double rate_min = 0.17365;
+        const int    step     = 3;
+
+        if(rate > rate_max)
+        {
+            size = this->restart_max_;
+        }
+        else if(rate >= rate_min)
+        {
+            size = (size - step >= this->restart_min_) ? size - step : this->restart_max_;
+        }
+
+        log_debug(this, "GMRES::AdaptRestart_()", rate, size);
+
+        return size;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRES<OperatorType, VectorType, ValueType>::SetOrthogonalization(OrthoAlg alg)
+    {
+        log_debug(this, "GMRES::SetOrthogonalization()", alg);
+
+        assert(alg == OrthoAlg_MGS || alg == OrthoAlg_CGS || alg == OrthoAlg_CGS2);
+
+        this->ortho_alg_ = alg;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRES<OperatorType, VectorType, ValueType>::SetReducedPrecisionBasis(bool enable)
+    {
+        log_debug(this, "GMRES::SetReducedPrecisionBasis()", enable);
+
+        assert(this->build_ == false);
+
+        if(enable == true && std::is_same<ValueType, double>::value == false)
+        {
+            LOG_INFO("Reduced precision Krylov basis is only available for double precision");
+
+            return;
+        }
+
+        this->basis_float_ = enable;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRES<OperatorType, VectorType, ValueType>::Orthogonalize_(int          i,
+                                                                    VectorType** v,
+                                                                    ValueType*   H)
+    {
+        int size = this->size_max_;
+
+        VectorType* w = v[i + 1];
+
+        int ip1i = DENSE_IND(i + 1, i, size + 1, size);
+
+        if(this->ortho_alg_ == OrthoAlg_MGS)
+        {
+            // Modified Gram-Schmidt
+            for(int k = 0; k <= i; ++k)
+            {
+                int idx = DENSE_IND(k, i, size + 1, size);
+                // H_ki = <v_k,v_i+1>
+                H[idx] = v[k]->Dot(*w);
+                // v_i+1 -= H_ki * v_k
+                w->AddScale(*v[k], -H[idx]);
+            }
+
+            // H_i+1i = ||v_i+1||
+            H[ip1i] = this->Norm_(*w);
+
+            return;
+        }
+
+        // Classical Gram-Schmidt, each pass computes h_k = <v_k,v_i+1> and
+        // <v_i+1,v_i+1> with a single reduction
+        int npass = (this->ortho_alg_ == OrthoAlg_CGS2) ? 2 : 1;
+
+        ValueType* h = this->h_;
+        ValueType  ww;
+        ValueType  nrm2;
+
+        for(int k = 0; k <= i; ++k)
+        {
+            H[DENSE_IND(k, i, size + 1, size)] = static_cast<ValueType>(0);
+        }
+
+        for(int pass = 0; pass < npass; ++pass)
+        {
+            w->MultiDot(i + 2, v, h);
+
+            ww   = h[i + 1];
+            nrm2 = ww;
+
+            for(int k = 0; k <= i; ++k)
+            {
+                // H_ki += h_k
+                H[DENSE_IND(k, i, size + 1, size)] += h[k];
+                // v_i+1 -= h_k * v_k
+                w->AddScale(*v[k], -h[k]);
+
+                nrm2 -= rocalution_conj(h[k]) * h[k];
+            }
+        }
+
+        // H_i+1i = ||v_i+1||, obtained from ||v_i+1||^2 - ||h||^2 unless there is
+        // severe cancellation
+        if(std::real(nrm2) > std::real(ww) / 100)
+        {
+            H[ip1i] = static_cast<ValueType>(std::sqrt(std::real(nrm2)));
+        }
+        else
+        {
+            H[ip1i] = this->Norm_(*w);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRES<OperatorType, VectorType, ValueType>::OrthogonalizeFloat_(int         i,
+                                                                         VectorType* w,
+                                                                         ValueType*  H)
+    {
+        int size = this->size_max_;
+
+        LocalVector<float>** v = this->vf_;
+
+        if(this->ortho_alg_ == OrthoAlg_MGS)
+        {
+            // Modified Gram-Schmidt
+            for(int k = 0; k <= i; ++k)
+            {
+                int idx = DENSE_IND(k, i, size + 1, size);
+                // H_ki = <v_k,w>
+                H[idx] = w->DotFloat(*v[k]);
+                // w -= H_ki * v_k
+                w->AddScaleFloat(*v[k], -H[idx]);
+            }
+        }
+        else
+        {
+            // Classical Gram-Schmidt, all projections of a pass are computed before w is
+            // updated. There is no mixed precision MultiDot, such that each projection is
+            // a separate reduction.
+            int npass = (this->ortho_alg_ == OrthoAlg_CGS2) ? 2 : 1;
+
+            ValueType* h = this->h_;
+
+            for(int k = 0; k <= i; ++k)
+            {
+                H[DENSE_IND(k, i, size + 1, size)] = static_cast<ValueType>(0);
+            }
+
+            for(int pass = 0; pass < npass; ++pass)
+            {
+                for(int k = 0; k <= i; ++k)
+                {
+                    h[k] = w->DotFloat(*v[k]);
+                }
+
+                for(int k = 0; k <= i; ++k)
+                {
+                    H[DENSE_IND(k, i, size + 1, size)] += h[k];
+                    w->AddScaleFloat(*v[k], -h[k]);
+                }
+            }
+        }
+
+        // H_i+1i = ||w||
+        H[DENSE_IND(i + 1, i, size + 1, size)] = this->Norm_(*w);
+    }
+
+    // The Arnoldi process with the basis stored in single precision. The current vector
+    // q = v_i and the next vector w are kept in double precision, only the rounded copies
+    // of the basis vectors are used for the orthogonalization and the update of x.
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRES<OperatorType, VectorType, ValueType>::SolveReducedBasis_(const VectorType& rhs,
+                                                                        VectorType*       x)
+    {
+        log_debug(this, "GMRES::SolveReducedBasis_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+        assert(this->basis_float_ == true);
+        assert(this->res_norm_type_ == 2);
+
+        const OperatorType* op = this->op_;
+
+        VectorType* z = &this->z_;
+        VectorType* q = &this->q_;
+        VectorType* w = &this->w_;
+
+        LocalVector<float>** v = this->vf_;
+
+        ValueType* c = this->c_;
+        ValueType* s = this->s_;
+        ValueType* r = this->r_;
+        ValueType* H = this->H_;
+
+        ValueType one = static_cast<ValueType>(1);
+
+        // Leading dimension of H and current restart length
+        int size = this->size_max_;
+        int m    = this->InitialRestart_();
+
+        this->AllocateBasis_(0);
+
+        // Continue from the checkpointed solution of a resumed solve
+        bool resumed = this->Restore_(1, &x, NULL, NULL);
+
+        // Initial residual w = M^-1 (b - Ax)
+        if(this->precond_ != NULL)
+        {
+            op->Apply(*x, z);
+            z->ScaleAdd(-one, rhs);
+            this->PrecondSolveZeroSol_(*z, w);
+        }
+        else
+        {
+            op->Apply(*x, w);
+            w->ScaleAdd(-one, rhs);
+        }
+
+        // r = 0
+        set_to_zero_host(size + 1, r);
+
+        // r_0 = ||w||
+        r[0] = this->Norm_(*w);
+
+        // Initial residual, a resumed solve checks the residual of the restored solution
+        bool done = (resumed == true) ? this->iter_ctrl_.CheckResidualNoCount(std::abs(r[0]))
+                                      : (this->iter_ctrl_.InitResidual(std::abs(r[0])) == false);
+
+        if(done == true)
+        {
+            log_debug(this, "GMRES::SolveReducedBasis_()", " #*# end");
+            return;
+        }
+
+        while(true)
+        {
+            double res_cycle = std::abs(r[0]);
+
+            // q = v_0 = w / r_0
+            w->ScaleCopyToFloat(one / r[0], v[0]);
+            std::swap(q, w);
+
+            // Arnoldi iteration
+            int i = 0;
+            while(i < m)
+            {
+                this->AllocateBasis_(i + 1);
+
+                // w = M^-1 Aq
+                if(this->precond_ != NULL)
+                {
+                    op->Apply(*q, z);
+                    this->PrecondSolveZeroSol_(*z, w);
+                }
+                else
+                {
+                    op->Apply(*q, w);
+                }
+
+                // Build Hessenberg matrix H, H_ki = <v_k,w> and H_i+1i = ||w||
+                this->OrthogonalizeFloat_(i, w, H);
+
+                // Precompute some indices
+                int ii   = DENSE_IND(i, i, size + 1, size);
+                int ip1i = DENSE_IND(i + 1, i, size + 1, size);
+
+                // q = v_i+1 = w / H_i+1i
+                w->ScaleCopyToFloat(one / H[ip1i], v[i + 1]);
+                std::swap(q, w);
+
+                // Apply Givens rotation J(0),...,J(j-1) on (H(0,i),...,H(i,i))
+                for(int k = 0; k < i; ++k)
+                {
+                    int ki   = DENSE_IND(k, i, size + 1, size);
+                    int kp1i = DENSE_IND(k + 1, i, size + 1, size);
+                    this->ApplyGivensRotation_(c[k], s[k], H[ki], H[kp1i]);
+                }
+
+                // Construct J(i)
+                this->GenerateGivensRotation_(H[ii], H[ip1i], c[i], s[i]);
+
+                // Apply J(i) to H(i,i) and H(i,i+1) such that H(i,i+1) = 0
+                this->ApplyGivensRotation_(c[i], s[i], H[ii], H[ip1i]);
+
+                // Apply J(i) to the norm of the residual sg[i]
+                this->ApplyGivensRotation_(c[i], s[i], r[i], r[i + 1]);
+
+                // Check convergence
+                if(this->iter_ctrl_.CheckResidual(std::abs(r[++i])))
+                {
+                    break;
+                }
+            }
+
+            // Solve upper triangular system
+            for(int j = i - 1; j >= 0; --j)
+            {
+                r[j] /= H[DENSE_IND(j, j, size + 1, size)];
+
+                for(int k = 0; k < j; ++k)
+                {
+                    r[k] -= H[DENSE_IND(k, j, size + 1, size)] * r[j];
+                }
+            }
+
+            // Update solution
+            for(int j = 0; j < i; ++j)
+            {
+                x->AddScaleFloat(*v[j], r[j]);
+            }
+
+            // Compute residual w = M^-1 (b - Ax) in double precision
+            if(this->precond_ != NULL)
+            {
+                op->Apply(*x, z);
+                z->ScaleAdd(-one, rhs);
+                this->PrecondSolveZeroSol_(*z, w);
+            }
+            else
+            {
+                op->Apply(*x, w);
+                w->ScaleAdd(-one, rhs);
+            }
+
+            // r = 0
+            set_to_zero_host(size + 1, r);
+
+            // r_0 = ||w||
+            r[0] = this->Norm_(*w);
+
+            // Check convergence
+            if(this->iter_ctrl_.CheckResidualNoCount(std::abs(r[0])))
+            {
+                break;
+            }
+
+            this->Checkpoint_(1, &x, NULL, 0);
+
+            // Adapt the restart length to the convergence of the last cycle
+            m = this->AdaptRestart_(m, std::abs(r[0]) / res_cycle);
+        }
+
+        log_debug(this, "GMRES::SolveReducedBasis_()", " #*# end");
+    }
+
     // GMRES implementation is based on the algorithm described in the book
     // 'Templates for the Solution of Linear Systems: Building Blocks for Iterative Methods'
     // by SIAM on page 18 and modified to fit rocalution structures.
@@ -274,6 +795,12 @@ namespace rocalution
     void GMRES<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
                                                                       VectorType*       x)
     {
+        if(this->basis_float_ == true)
+        {
+            this->SolveReducedBasis_(rhs, x);
+            return;
+        }
+
         log_debug(this, "GMRES::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
 
         assert(x != NULL);
@@ -295,7 +822,15 @@ namespace rocalution
 
         ValueType one = static_cast<ValueType>(1);
 
-        int size = this->size_basis_;
+        // Leading dimension of H and current restart length
+        int size = this->size_max_;
+        int m    = this->InitialRestart_();
+
+        // The basis grows on demand, v_0 is needed for the initial residual
+        this->AllocateBasis_(0);
+
+        // Continue from the checkpointed solution of a resumed solve
+        bool resumed = this->Restore_(1, &x, NULL, NULL);
 
         // Initial residual
         op->Apply(*x, v[0]);
@@ -307,42 +842,41 @@ namespace rocalution
         // r_0 = ||v_0||
         r[0] = this->Norm_(*v[0]);
 
-        // Initial residual
-        if(this->iter_ctrl_.InitResidual(std::abs(r[0])) == false)
+        // Initial residual, a resumed solve checks the residual of the restored solution
+        bool done = (resumed == true) ? this->iter_ctrl_.CheckResidualNoCount(std::abs(r[0]))
+                                      : (this->iter_ctrl_.InitResidual(std::abs(r[0])) == false);
+
+        if(done == true)
         {
+            this->ReleaseBasis_();
+
             log_debug(this, "GMRES::SolveNonPrecond_()", " #*# end");
             return;
         }
 
         while(true)
         {
+            double res_cycle = std::abs(r[0]);
+
             // Normalize v_0
             v[0]->Scale(one / r[0]);
 
             // Arnoldi iteration
             int i = 0;
-            while(i < size)
+            while(i < m)
             {
+                this->AllocateBasis_(i + 1);
+
                 // v_i+1 = Av_i
                 op->Apply(*v[i], v[i + 1]);
 
-                // Build Hessenberg matrix H
-                for(int k = 0; k <= i; ++k)
-                {
-                    int idx = DENSE_IND(k, i, size + 1, size);
-                    // H_ki = <v_k,v_i+1>
-                    H[idx] = v[k]->Dot(*v[i + 1]);
-                    // v_i+1 -= H_ki * v_k
-                    v[i + 1]->AddScale(*v[k], -H[idx]);
-                }
+                // Build Hessenberg matrix H, H_ki = <v_k,v_i+1> and H_i+1i = ||v_i+1||
+                this->Orthogonalize_(i, v, H);
 
                 // Precompute some indices
                 int ii   = DENSE_IND(i, i, size + 1, size);
                 int ip1i = DENSE_IND(i + 1, i, size + 1, size);
 
-                // H_i+1i = ||v_i+1||
-                H[ip1i] = this->Norm_(*v[i + 1]);
-
                 // v_i+1 /= H_i+1i
                 v[i + 1]->Scale(one / H[ip1i]);
 
@@ -404,8 +938,15 @@ namespace rocalution
             {
                 break;
             }
+
+            this->Checkpoint_(1, &x, NULL, 0);
+
+            // Adapt the restart length to the convergence of the last cycle
+            m = this->AdaptRestart_(m, std::abs(r[0]) / res_cycle);
         }
 
+        this->ReleaseBasis_();
+
         log_debug(this, "GMRES::SolveNonPrecond_()", " #*# end");
     }
 
@@ -416,6 +957,12 @@ namespace rocalution
     void GMRES<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
                                                                    VectorType*       x)
     {
+        if(this->basis_float_ == true)
+        {
+            this->SolveReducedBasis_(rhs, x);
+            return;
+        }
+
         log_debug(this, "GMRES::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
 
         assert(x != NULL);
@@ -438,14 +985,22 @@ namespace rocalution
 
         ValueType one = static_cast<ValueType>(1);
 
-        int size = this->size_basis_;
+        // Leading dimension of H and current restart length
+        int size = this->size_max_;
+        int m    = this->InitialRestart_();
+
+        // The basis grows on demand, v_0 is needed for the initial residual
+        this->AllocateBasis_(0);
+
+        // Continue from the checkpointed solution of a resumed solve
+        bool resumed = this->Restore_(1, &x, NULL, NULL);
 
         // Initial residual
         op->Apply(*x, z);
         z->ScaleAdd(-one, rhs);
 
         // Solve Mv_0 = z
-        this->precond_->SolveZeroSol(*z, v[0]);
+        this->PrecondSolveZeroSol_(*z, v[0]);
 
         // r = 0
         set_to_zero_host(size + 1, r);
@@ -453,45 +1008,44 @@ namespace rocalution
         // r_0 = ||v_0||
         r[0] = this->Norm_(*v[0]);
 
-        // Initial residual
-        if(this->iter_ctrl_.InitResidual(std::abs(r[0])) == false)
+        // Initial residual, a resumed solve checks the residual of the restored solution
+        bool done = (resumed == true) ? this->iter_ctrl_.CheckResidualNoCount(std::abs(r[0]))
+                                      : (this->iter_ctrl_.InitResidual(std::abs(r[0])) == false);
+
+        if(done == true)
         {
+            this->ReleaseBasis_();
+
             log_debug(this, "GMRES::SolvePrecond_()", " #*# end");
             return;
         }
 
         while(true)
         {
+            double res_cycle = std::abs(r[0]);
+
             // Normalize v_0
             v[0]->Scale(one / r[0]);
 
             // Arnoldi iteration
             int i = 0;
-            while(i < size)
+            while(i < m)
             {
+                this->AllocateBasis_(i + 1);
+
                 // z = Av_i
                 op->Apply(*v[i], z);
 
                 // Solve M v_i+1 = z
-                this->precond_->SolveZeroSol(*z, v[i + 1]);
+                this->PrecondSolveZeroSol_(*z, v[i + 1]);
 
-                // Build Hessenberg matrix H
-                for(int k = 0; k <= i; ++k)
-                {
-                    int idx = DENSE_IND(k, i, size + 1, size);
-                    // H_ki = <v_k,v_i+1>
-                    H[idx] = v[k]->Dot(*v[i + 1]);
-                    // v_i+1 -= H_ki * v_k
-                    v[i + 1]->AddScale(*v[k], -H[idx]);
-                }
+                // Build Hessenberg matrix H, H_ki = <v_k,v_i+1> and H_i+1i = ||v_i+1||
+                this->Orthogonalize_(i, v, H);
 
                 // Precompute some indices
                 int ii   = DENSE_IND(i, i, size + 1, size);
                 int ip1i = DENSE_IND(i + 1, i, size + 1, size);
 
-                // H_i+1i = ||v_i+1||
-                H[ip1i] = this->Norm_(*v[i + 1]);
-
                 // v_i+1 /= H_i+1i
                 v[i + 1]->Scale(one / H[ip1i]);
 
@@ -543,7 +1097,7 @@ namespace rocalution
             z->ScaleAdd(-one, rhs);
 
             // Solve Mv_0 = z
-            this->precond_->SolveZeroSol(*z, v[0]);
+            this->PrecondSolveZeroSol_(*z, v[0]);
 
             // r = 0
             set_to_zero_host(size + 1, r);
@@ -556,8 +1110,15 @@ namespace rocalution
             {
                 break;
             }
+
+            this->Checkpoint_(1, &x, NULL, 0);
+
+            // Adapt the restart length to the convergence of the last cycle
+            m = this->AdaptRestart_(m, std::abs(r[0]) / res_cycle);
         }
 
+        this->ReleaseBasis_();
+
         log_debug(this, "GMRES::SolvePrecond_()", " #*# end");
     }
 
@@ -638,4 +1199,15 @@ namespace rocalution
                          std::complex<float>>;
 #endif
 
+    template class GMRES<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class GMRES<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class GMRES<LocalShellOperator<std::complex<double>>,
+                         LocalVector<std::complex<double>>,
+                         std::complex<double>>;
+    template class GMRES<LocalShellOperator<std::complex<float>>,
+                         LocalVector<std::complex<float>>,
+                         std::complex<float>>;
+#endif
+
 } // namespace rocalution
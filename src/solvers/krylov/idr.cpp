@@ -58,6 +58,7 @@ namespace rocalution
         this->c_ = NULL;
         this->f_ = NULL;
         this->M_ = NULL;
+        this->d_ = NULL;
 
         this->G_ = NULL;
         this->U_ = NULL;
@@ -118,6 +119,8 @@ namespace rocalution
     {
         log_debug(this, "IDR::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("IDR::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -138,6 +141,7 @@ namespace rocalution
         allocate_host(this->s_, &this->c_);
         allocate_host(this->s_, &this->f_);
         allocate_host(this->s_ * this->s_, &this->M_);
+        allocate_host(this->s_, &this->d_);
 
         this->G_ = new VectorType*[this->s_];
         this->U_ = new VectorType*[this->s_];
@@ -214,6 +218,7 @@ namespace rocalution
             free_host(&this->c_);
             free_host(&this->f_);
             free_host(&this->M_);
+            free_host(&this->d_);
 
             if(this->precond_ != NULL)
             {
@@ -360,8 +365,8 @@ namespace rocalution
         ValueType* c = this->c_;
         ValueType* f = this->f_;
         ValueType* M = this->M_;
+        ValueType* d = this->d_;
 
-        ValueType alpha;
         ValueType beta;
         ValueType rho;
         ValueType omega = one;
@@ -396,10 +401,7 @@ namespace rocalution
         {
             // Generate rhs for small system
             // f = P^T * r
-            for(int i = 0; i < s; ++i)
-            {
-                f[i] = P[i]->Dot(*r);
-            }
+            r->MultiDot(s, P, f);
 
             // Loop over shadow spaces
             for(int k = 0; k < s; ++k)
@@ -432,24 +434,40 @@ namespace rocalution
                 // G_k = A U_k
                 op->Apply(*U[k], G[k]);
 
+                // d = P^T * G_k, all inner products of this shadow space in a single
+                // reduction
+                G[k]->MultiDot(s, P, d);
+
                 // Make G orthogonal to P
+                // Since P^T_i * G_j = M_ij is lower triangular, the projections of the
+                // modified Gram-Schmidt process follow from d by forward substitution
                 for(int i = 0; i < k; ++i)
                 {
-                    // alpha = P^T_i * G_k / M_ii
-                    alpha = P[i]->Dot(*G[k]) / M[DENSE_IND(i, i, s, s)];
+                    // alpha_i = (d_i - sum(M_ij * alpha_j)) / M_ii, j=0,...,i-1
+                    for(int j = 0; j < i; ++j)
+                    {
+                        d[i] -= M[DENSE_IND(i, j, s, s)] * d[j];
+                    }
+
+                    d[i] /= M[DENSE_IND(i, i, s, s)];
 
-                    // G_k = G_k - alpha * G_i
-                    G[k]->AddScale(*G[i], -alpha);
+                    // G_k = G_k - alpha_i * G_i
+                    G[k]->AddScale(*G[i], -d[i]);
 
-                    // U_k = U_k - alpha * U_i
-                    U[k]->AddScale(*U[i], -alpha);
+                    // U_k = U_k - alpha_i * U_i
+                    U[k]->AddScale(*U[i], -d[i]);
                 }
 
                 // Update column k of M
                 for(int i = k; i < s; ++i)
                 {
-                    // M_ik = P^T_i * G_k
-                    M[DENSE_IND(i, k, s, s)] = P[i]->Dot(*G[k]);
+                    // M_ik = P^T_i * G_k = d_i - sum(M_ij * alpha_j), j=0,...,k-1
+                    M[DENSE_IND(i, k, s, s)] = d[i];
+
+                    for(int j = 0; j < k; ++j)
+                    {
+                        M[DENSE_IND(i, k, s, s)] -= M[DENSE_IND(i, j, s, s)] * d[j];
+                    }
                 }
 
                 // Check M_kk for zero
@@ -478,14 +496,11 @@ namespace rocalution
                 // beta = f_k / M_k_k
                 beta = f[k] / M[DENSE_IND(k, k, s, s)];
 
-                // r = r - beta * G_k
-                r->AddScale(*G[k], -beta);
-
                 // x = x + beta * U_k
                 x->AddScale(*U[k], beta);
 
-                // Residual norm
-                res_norm = this->Norm_(*r);
+                // r = r - beta * G_k, fused with the residual norm
+                res_norm = this->AddScaleNorm_(*G[k], -beta, r);
 
                 // Check inner loop for convergence
                 if(this->iter_ctrl_.CheckResidualNoCount(std::abs(res_norm)))
@@ -512,8 +527,11 @@ namespace rocalution
             op->Apply(*r, v);
 
             // omega = (v,r) / ||v||^2
-            ValueType rt = v->Dot(*r);
-            ValueType nt = v->Norm();
+            ValueType dots[2];
+            v->DualDot(*r, *v, dots);
+
+            ValueType rt = dots[0];
+            ValueType nt = std::sqrt(dots[1]);
 
             rt /= nt;
 
@@ -549,11 +567,9 @@ namespace rocalution
             // x = x + omega * r
             x->AddScale(*r, omega);
 
-            // r = r - omega * v
-            r->AddScale(*v, -omega);
-
-            // Residual norm to check outer loop convergence
-            res_norm = this->Norm_(*r);
+            // r = r - omega * v, fused with the residual norm to check outer loop
+            // convergence
+            res_norm = this->AddScaleNorm_(*v, -omega, r);
         }
 
         log_debug(this, "IDR::SolveNonPrecond_()", " #*# end");
@@ -588,8 +604,8 @@ namespace rocalution
         ValueType* c = this->c_;
         ValueType* f = this->f_;
         ValueType* M = this->M_;
+        ValueType* d = this->d_;
 
-        ValueType alpha;
         ValueType beta;
         ValueType rho;
         ValueType omega = one;
@@ -624,10 +640,7 @@ namespace rocalution
         {
             // Generate rhs for small system
             // f = P^T * r
-            for(int i = 0; i < s; ++i)
-            {
-                f[i] = P[i]->Dot(*r);
-            }
+            r->MultiDot(s, P, f);
 
             // Loop over shadow spaces
             for(int k = 0; k < s; ++k)
@@ -650,7 +663,7 @@ namespace rocalution
                 }
 
                 // Apply preconditioner Mt = v
-                this->precond_->SolveZeroSol(*v, t);
+                this->PrecondSolveZeroSol_(*v, t);
 
                 // U_k = omega * t + sum(c_i * U_i), i=k,...,s-1
                 U[k]->ScaleAddScale(c[k], *t, omega);
@@ -663,24 +676,40 @@ namespace rocalution
                 // G_k = A U_k
                 op->Apply(*U[k], G[k]);
 
+                // d = P^T * G_k, all inner products of this shadow space in a single
+                // reduction
+                G[k]->MultiDot(s, P, d);
+
                 // Make G orthogonal to P
+                // Since P^T_i * G_j = M_ij is lower triangular, the projections of the
+                // modified Gram-Schmidt process follow from d by forward substitution
                 for(int i = 0; i < k; ++i)
                 {
-                    // alpha = P^T_i * G_k / M_ii
-                    alpha = P[i]->Dot(*G[k]) / M[DENSE_IND(i, i, s, s)];
+                    // alpha_i = (d_i - sum(M_ij * alpha_j)) / M_ii, j=0,...,i-1
+                    for(int j = 0; j < i; ++j)
+                    {
+                        d[i] -= M[DENSE_IND(i, j, s, s)] * d[j];
+                    }
+
+                    d[i] /= M[DENSE_IND(i, i, s, s)];
 
-                    // G_k = G_k - alpha * G_i
-                    G[k]->AddScale(*G[i], -alpha);
+                    // G_k = G_k - alpha_i * G_i
+                    G[k]->AddScale(*G[i], -d[i]);
 
-                    // U_k = U_k - alpha * U_i
-                    U[k]->AddScale(*U[i], -alpha);
+                    // U_k = U_k - alpha_i * U_i
+                    U[k]->AddScale(*U[i], -d[i]);
                 }
 
                 // Update column k of M
                 for(int i = k; i < s; ++i)
                 {
-                    // M_ik = P^T_i * G_k
-                    M[DENSE_IND(i, k, s, s)] = P[i]->Dot(*G[k]);
+                    // M_ik = P^T_i * G_k = d_i - sum(M_ij * alpha_j), j=0,...,k-1
+                    M[DENSE_IND(i, k, s, s)] = d[i];
+
+                    for(int j = 0; j < k; ++j)
+                    {
+                        M[DENSE_IND(i, k, s, s)] -= M[DENSE_IND(i, j, s, s)] * d[j];
+                    }
                 }
 
                 // Check M_kk for zero
@@ -709,14 +738,11 @@ namespace rocalution
                 // beta = f_k / M_k_k
                 beta = f[k] / M[DENSE_IND(k, k, s, s)];
 
-                // r = r - beta * G_k
-                r->AddScale(*G[k], -beta);
-
                 // x = x + beta * U_k
                 x->AddScale(*U[k], beta);
 
-                // Residual norm
-                res_norm = this->Norm_(*r);
+                // r = r - beta * G_k, fused with the residual norm
+                res_norm = this->AddScaleNorm_(*G[k], -beta, r);
 
                 // Check inner loop for convergence
                 if(this->iter_ctrl_.CheckResidualNoCount(std::abs(res_norm)))
@@ -740,14 +766,17 @@ namespace rocalution
             // Enter the dimension reduction step
 
             // Mv = r
-            this->precond_->SolveZeroSol(*r, v);
+            this->PrecondSolveZeroSol_(*r, v);
 
             // t = Av
             op->Apply(*v, t);
 
             // omega = (t,r) / ||t||^2
-            ValueType rt = t->Dot(*r);
-            ValueType nt = t->Norm();
+            ValueType dots[2];
+            t->DualDot(*r, *t, dots);
+
+            ValueType rt = dots[0];
+            ValueType nt = std::sqrt(dots[1]);
 
             rt /= nt;
 
@@ -780,14 +809,12 @@ namespace rocalution
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
-            // r = r - omega * t
-            r->AddScale(*t, -omega);
-
             // x = x + omega * v
             x->AddScale(*v, omega);
 
-            // Residual norm to check outer loop convergence
-            res_norm = this->Norm_(*r);
+            // r = r - omega * t, fused with the residual norm to check outer loop
+            // convergence
+            res_norm = this->AddScaleNorm_(*t, -omega, r);
         }
 
         log_debug(this, "::SolvePrecond_()", " #*# end");
@@ -94,6 +94,7 @@ namespace rocalution
         ValueType* c_;
         ValueType* f_;
         ValueType* M_;
+        ValueType* d_;
 
         VectorType r_;
         VectorType v_;
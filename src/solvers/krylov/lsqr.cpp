@@ -0,0 +1,309 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "lsqr.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <cmath>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    LSQR<OperatorType, VectorType, ValueType>::LSQR()
+    {
+        log_debug(this, "LSQR::LSQR()", "default constructor");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    LSQR<OperatorType, VectorType, ValueType>::~LSQR()
+    {
+        log_debug(this, "LSQR::~LSQR()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LSQR<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("LSQR solver");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LSQR<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        LOG_INFO("LSQR (non-precond) least squares solver starts");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LSQR<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        LOG_INFO("LSQR (non-precond) ends");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LSQR<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "LSQR::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("LSQR::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() > 0);
+        assert(this->op_->GetN() > 0);
+
+        if(this->res_norm_type_ != 2)
+        {
+            LOG_INFO(
+                "LSQR solver supports only L2 residual norm. The solver is switching to L2 norm");
+            this->res_norm_type_ = 2;
+        }
+
+        if(this->precond_ != NULL)
+        {
+            LOG_INFO("LSQR solver does not support preconditioning");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        this->u_.CloneBackend(*this->op_);
+        this->u_.Allocate("u", this->op_->GetM());
+
+        this->v_.CloneBackend(*this->op_);
+        this->v_.Allocate("v", this->op_->GetN());
+
+        this->w_.CloneBackend(*this->op_);
+        this->w_.Allocate("w", this->op_->GetN());
+
+        this->t_.CloneBackend(*this->op_);
+        this->t_.Allocate("t", this->op_->GetM());
+
+        log_debug(this, "LSQR::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LSQR<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "LSQR::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->u_.Clear();
+            this->v_.Clear();
+            this->w_.Clear();
+            this->t_.Clear();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LSQR<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "LSQR::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->u_.Zeros();
+            this->v_.Zeros();
+            this->w_.Zeros();
+            this->t_.Zeros();
+
+            this->iter_ctrl_.Clear();
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LSQR<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "LSQR::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->u_.MoveToHost();
+            this->v_.MoveToHost();
+            this->w_.MoveToHost();
+            this->t_.MoveToHost();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LSQR<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "LSQR::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->u_.MoveToAccelerator();
+            this->v_.MoveToAccelerator();
+            this->w_.MoveToAccelerator();
+            this->t_.MoveToAccelerator();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LSQR<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                     VectorType*       x)
+    {
+        log_debug(this, "LSQR::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        const OperatorType* op = this->op_;
+
+        VectorType* u = &this->u_;
+        VectorType* v = &this->v_;
+        VectorType* w = &this->w_;
+        VectorType* t = &this->t_;
+
+        const ValueType one  = static_cast<ValueType>(1);
+        const ValueType zero = static_cast<ValueType>(0);
+
+        // beta_1 u_1 = b - Ax
+        op->Apply(*x, u);
+        u->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        ValueType beta = this->Norm_(*u);
+
+        if(beta != zero)
+        {
+            u->Scale(one / beta);
+        }
+
+        // alpha_1 v_1 = A^T u_1
+        op->ApplyTranspose(*u, v);
+
+        ValueType alpha = this->Norm_(*v);
+
+        if(alpha != zero)
+        {
+            v->Scale(one / alpha);
+        }
+
+        // |A^T (b-Ax0)| = alpha_1 beta_1
+        if(this->iter_ctrl_.InitResidual(std::abs(alpha * beta)) == false)
+        {
+            log_debug(this, "LSQR::SolveNonPrecond_()", " #*# end");
+
+            return;
+        }
+
+        // w_1 = v_1
+        w->CopyFrom(*v);
+
+        ValueType phibar = beta;
+        ValueType rhobar = alpha;
+
+        while(true)
+        {
+            // beta_k+1 u_k+1 = A v_k - alpha_k u_k
+            op->Apply(*v, t);
+            u->ScaleAdd(-alpha, *t);
+
+            beta = this->Norm_(*u);
+
+            if(beta != zero)
+            {
+                u->Scale(one / beta);
+            }
+
+            // alpha_k+1 v_k+1 = A^T u_k+1 - beta_k+1 v_k
+            v->Scale(-beta);
+            op->ApplyTransposeAdd(*u, one, v);
+
+            alpha = this->Norm_(*v);
+
+            if(alpha != zero)
+            {
+                v->Scale(one / alpha);
+            }
+
+            // Eliminate the subdiagonal of the bidiagonal matrix with a plane rotation
+            ValueType rho = std::sqrt(rhobar * rhobar + beta * beta);
+            ValueType c   = rhobar / rho;
+            ValueType s   = beta / rho;
+
+            ValueType theta = s * alpha;
+            ValueType phi   = c * phibar;
+
+            rhobar = -c * alpha;
+            phibar = s * phibar;
+
+            // x = x + phi_k / rho_k * w_k
+            x->AddScale(*w, phi / rho);
+
+            // |A^T (b-Ax_k)| = |phibar_k+1 alpha_k+1 c_k|
+            if(this->iter_ctrl_.CheckResidual(std::abs(phibar * alpha * c), this->index_))
+            {
+                break;
+            }
+
+            // w_k+1 = v_k+1 - theta_k+1 / rho_k * w_k
+            w->ScaleAdd(-theta / rho, *v);
+        }
+
+        log_debug(this, "LSQR::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void LSQR<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                  VectorType*       x)
+    {
+        LOG_INFO("LSQR solver does not support preconditioning");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template class LSQR<LocalMatrix<double>, LocalVector<double>, double>;
+    template class LSQR<LocalMatrix<float>, LocalVector<float>, float>;
+
+    template class LSQR<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class LSQR<GlobalMatrix<float>, GlobalVector<float>, float>;
+
+} // namespace rocalution
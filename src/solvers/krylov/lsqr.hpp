@@ -0,0 +1,91 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_LSQR_HPP_
+#define ROCALUTION_KRYLOV_LSQR_HPP_
+
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class LSQR
+  * \brief Least Squares QR Method
+  * \details
+  * The LSQR method is an iterative method for solving sparse linear least squares
+  * problems \f$\min_{x} \|Ax-b\|_{2}\f$, where \f$A\f$ can be rectangular. It is based
+  * on the Golub-Kahan bidiagonalization of \f$A\f$ and is mathematically equivalent to
+  * CGLS, but numerically more reliable on ill-conditioned problems. Only products with
+  * \f$A\f$ and \f$A^{T}\f$ are required, the transposed matrix is never stored. The
+  * residual of the normal equations \f$\|A^{T}(b-Ax)\|_{2}\f$ is monitored through
+  * its estimate from the bidiagonalization, hence only the L2 residual norm is
+  * supported. The method cannot be preconditioned.
+  * \cite lsqr
+  *
+  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float or double
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class LSQR : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        LSQR();
+        ROCALUTION_EXPORT
+        virtual ~LSQR();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        // Bidiagonalization vectors of the row and the column space
+        VectorType u_, v_;
+        // Search direction and temporary of the row space
+        VectorType w_, t_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_LSQR_HPP_
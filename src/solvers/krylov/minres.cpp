@@ -0,0 +1,538 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "minres.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+#include "../../utils/type_traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    MINRES<OperatorType, VectorType, ValueType>::MINRES()
+    {
+        log_debug(this, "MINRES::MINRES()", "default constructor");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    MINRES<OperatorType, VectorType, ValueType>::~MINRES()
+    {
+        log_debug(this, "MINRES::~MINRES()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MINRES<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("MINRES solver");
+        }
+        else
+        {
+            LOG_INFO("PMINRES solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MINRES<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("MINRES (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("PMINRES solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MINRES<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("MINRES (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("PMINRES ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MINRES<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "MINRES::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("MINRES::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+
+        if(this->res_norm_type_ != 2)
+        {
+            LOG_INFO(
+                "MINRES solver supports only L2 residual norm. The solver is switching to L2 norm");
+            this->res_norm_type_ = 2;
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+
+            this->precond_->Build();
+
+            this->r2_.CloneBackend(*this->op_);
+            this->r2_.Allocate("r2", this->op_->GetM());
+        }
+
+        this->r1_.CloneBackend(*this->op_);
+        this->r1_.Allocate("r1", this->op_->GetM());
+
+        this->y_.CloneBackend(*this->op_);
+        this->y_.Allocate("y", this->op_->GetM());
+
+        this->v_.CloneBackend(*this->op_);
+        this->v_.Allocate("v", this->op_->GetM());
+
+        this->w_.CloneBackend(*this->op_);
+        this->w_.Allocate("w", this->op_->GetM());
+
+        this->w1_.CloneBackend(*this->op_);
+        this->w1_.Allocate("w1", this->op_->GetM());
+
+        log_debug(this, "MINRES::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MINRES<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "MINRES::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->r1_.Clear();
+            this->r2_.Clear();
+            this->y_.Clear();
+            this->v_.Clear();
+            this->w_.Clear();
+            this->w1_.Clear();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MINRES<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "MINRES::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r1_.Zeros();
+            this->r2_.Zeros();
+            this->y_.Zeros();
+            this->v_.Zeros();
+            this->w_.Zeros();
+            this->w1_.Zeros();
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MINRES<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "MINRES::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r1_.MoveToHost();
+            this->y_.MoveToHost();
+            this->v_.MoveToHost();
+            this->w_.MoveToHost();
+            this->w1_.MoveToHost();
+
+            if(this->precond_ != NULL)
+            {
+                this->r2_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MINRES<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "MINRES::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r1_.MoveToAccelerator();
+            this->y_.MoveToAccelerator();
+            this->v_.MoveToAccelerator();
+            this->w_.MoveToAccelerator();
+            this->w1_.MoveToAccelerator();
+
+            if(this->precond_ != NULL)
+            {
+                this->r2_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    // MINRES implementation is based on the algorithm of Paige and Saunders, the
+    // tridiagonal Lanczos matrix is reduced with Givens rotations on the fly.
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MINRES<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                       VectorType*       x)
+    {
+        log_debug(this, "MINRES::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        typedef numeric_traits_t<ValueType> RealType;
+
+        const OperatorType* op = this->op_;
+
+        // Lanczos vectors v_k-1, v_k and v_k+1
+        VectorType* v_old = &this->r1_;
+        VectorType* v     = &this->v_;
+        VectorType* u     = &this->y_;
+
+        // Search directions w_k and w_k-1
+        VectorType* w  = &this->w_;
+        VectorType* w1 = &this->w1_;
+
+        const ValueType one = static_cast<ValueType>(1);
+        const RealType  eps = std::numeric_limits<RealType>::epsilon();
+
+        // Initial residual v = b - Ax
+        op->Apply(*x, v);
+        v->ScaleAdd(-one, rhs);
+
+        RealType beta = std::abs(this->Norm_(*v));
+
+        if(this->iter_ctrl_.InitResidual(beta) == false)
+        {
+            log_debug(this, "MINRES::SolveNonPrecond_()", " #*# end");
+
+            return;
+        }
+
+        v->Scale(one / beta);
+
+        v_old->Zeros();
+        w->Zeros();
+        w1->Zeros();
+
+        RealType phibar = beta;
+        RealType dbar   = static_cast<RealType>(0);
+        RealType epsln  = static_cast<RealType>(0);
+        RealType cs     = static_cast<RealType>(-1);
+        RealType sn     = static_cast<RealType>(0);
+
+        while(true)
+        {
+            // u = Av_k - beta_k v_k-1 - alpha_k v_k
+            op->Apply(*v, u);
+            u->AddScale(*v_old, static_cast<ValueType>(-beta));
+
+            RealType alpha = std::real(v->Dot(*u));
+
+            u->AddScale(*v, static_cast<ValueType>(-alpha));
+
+            // beta_k+1 = ||u||
+            beta = std::abs(this->Norm_(*u));
+
+            // Apply the previous rotation and compute the next one
+            RealType oldeps = epsln;
+            RealType delta  = cs * dbar + sn * alpha;
+            RealType gbar   = sn * dbar - cs * alpha;
+
+            epsln = sn * beta;
+            dbar  = -cs * beta;
+
+            RealType gamma = std::max(std::sqrt(gbar * gbar + beta * beta), eps);
+
+            cs = gbar / gamma;
+            sn = beta / gamma;
+
+            RealType phi = cs * phibar;
+            phibar       = sn * phibar;
+
+            // w_k = (v_k - epsilon_k w_k-2 - delta_k w_k-1) / gamma_k, overwriting w_k-2
+            VectorType* tmp = w1;
+            w1              = w;
+            w               = tmp;
+
+            w->ScaleAdd2(static_cast<ValueType>(-oldeps / gamma),
+                         *v,
+                         static_cast<ValueType>(1 / gamma),
+                         *w1,
+                         static_cast<ValueType>(-delta / gamma));
+
+            // x = x + phi_k w_k
+            x->AddScale(*w, static_cast<ValueType>(phi));
+
+            // |phibar_k| = ||b - Ax_k||
+            if(this->iter_ctrl_.CheckResidual(phibar, this->index_))
+            {
+                break;
+            }
+
+            // v_k+1 = u / beta_k+1
+            tmp   = v_old;
+            v_old = v;
+            v     = u;
+            u     = tmp;
+
+            v->Scale(one / beta);
+        }
+
+        log_debug(this, "MINRES::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MINRES<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                    VectorType*       x)
+    {
+        log_debug(this, "MINRES::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        typedef numeric_traits_t<ValueType> RealType;
+
+        const OperatorType* op = this->op_;
+
+        // Unscaled Lanczos vectors r_k-1 = beta_k-1 M v_k-1 and r_k = beta_k M v_k
+        VectorType* r1 = &this->r1_;
+        VectorType* r2 = &this->r2_;
+        VectorType* y  = &this->y_;
+        VectorType* v  = &this->v_;
+
+        // Search directions w_k and w_k-1
+        VectorType* w  = &this->w_;
+        VectorType* w1 = &this->w1_;
+
+        const ValueType one = static_cast<ValueType>(1);
+        const RealType  eps = std::numeric_limits<RealType>::epsilon();
+
+        // Initial residual r2 = b - Ax
+        op->Apply(*x, r2);
+        r2->ScaleAdd(-one, rhs);
+
+        // y = M^-1 r2
+        this->PrecondSolveZeroSol_(*r2, y);
+
+        RealType rho = std::real(r2->Dot(*y));
+
+        if(rho < static_cast<RealType>(0))
+        {
+            LOG_INFO("MINRES preconditioner is not positive definite");
+            rho = static_cast<RealType>(0);
+        }
+
+        // beta_1 = ||b - Ax||_M^-1
+        RealType beta = std::sqrt(rho);
+        RealType oldb = beta;
+
+        if(this->iter_ctrl_.InitResidual(beta) == false)
+        {
+            log_debug(this, "MINRES::SolvePrecond_()", " #*# end");
+
+            return;
+        }
+
+        r1->Zeros();
+        w->Zeros();
+        w1->Zeros();
+
+        RealType phibar = beta;
+        RealType dbar   = static_cast<RealType>(0);
+        RealType epsln  = static_cast<RealType>(0);
+        RealType cs     = static_cast<RealType>(-1);
+        RealType sn     = static_cast<RealType>(0);
+
+        while(true)
+        {
+            // v_k = y / beta_k
+            v->CopyFrom(*y);
+            v->Scale(one / beta);
+
+            // y = Av_k - beta_k / beta_k-1 r_k-1 - alpha_k / beta_k r_k
+            op->Apply(*v, y);
+            y->AddScale(*r1, static_cast<ValueType>(-beta / oldb));
+
+            RealType alpha = std::real(v->Dot(*y));
+
+            y->AddScale(*r2, static_cast<ValueType>(-alpha / beta));
+
+            VectorType* tmp = r1;
+            r1              = r2;
+            r2              = y;
+            y               = tmp;
+
+            // y = M^-1 r_k+1
+            this->PrecondSolveZeroSol_(*r2, y);
+
+            rho = std::real(r2->Dot(*y));
+
+            if(rho < static_cast<RealType>(0))
+            {
+                LOG_INFO("MINRES preconditioner is not positive definite");
+                break;
+            }
+
+            oldb = beta;
+            beta = std::sqrt(rho);
+
+            // Apply the previous rotation and compute the next one
+            RealType oldeps = epsln;
+            RealType delta  = cs * dbar + sn * alpha;
+            RealType gbar   = sn * dbar - cs * alpha;
+
+            epsln = sn * beta;
+            dbar  = -cs * beta;
+
+            RealType gamma = std::max(std::sqrt(gbar * gbar + beta * beta), eps);
+
+            cs = gbar / gamma;
+            sn = beta / gamma;
+
+            RealType phi = cs * phibar;
+            phibar       = sn * phibar;
+
+            // w_k = (v_k - epsilon_k w_k-2 - delta_k w_k-1) / gamma_k, overwriting w_k-2
+            tmp = w1;
+            w1  = w;
+            w   = tmp;
+
+            w->ScaleAdd2(static_cast<ValueType>(-oldeps / gamma),
+                         *v,
+                         static_cast<ValueType>(1 / gamma),
+                         *w1,
+                         static_cast<ValueType>(-delta / gamma));
+
+            // x = x + phi_k w_k
+            x->AddScale(*w, static_cast<ValueType>(phi));
+
+            // |phibar_k| = ||b - Ax_k||_M^-1
+            if(this->iter_ctrl_.CheckResidual(phibar, this->index_))
+            {
+                break;
+            }
+        }
+
+        log_debug(this, "MINRES::SolvePrecond_()", " #*# end");
+    }
+
+    template class MINRES<LocalMatrix<double>, LocalVector<double>, double>;
+    template class MINRES<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class MINRES<LocalMatrix<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class MINRES<LocalMatrix<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class MINRES<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class MINRES<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class MINRES<GlobalMatrix<std::complex<double>>,
+                          GlobalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class MINRES<GlobalMatrix<std::complex<float>>,
+                          GlobalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class MINRES<LocalStencil<double>, LocalVector<double>, double>;
+    template class MINRES<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class MINRES<LocalStencil<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class MINRES<LocalStencil<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,852 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "pipebicgstab.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <complex>
+#include <limits>
+#include <math.h>
+#include <type_traits>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    PipeBiCGStab<OperatorType, VectorType, ValueType>::PipeBiCGStab()
+    {
+        log_debug(this, "PipeBiCGStab::PipeBiCGStab()", "default constructor");
+
+        this->replace_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    PipeBiCGStab<OperatorType, VectorType, ValueType>::~PipeBiCGStab()
+    {
+        log_debug(this, "PipeBiCGStab::~PipeBiCGStab()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("PipeBiCGStab solver");
+        }
+        else
+        {
+            LOG_INFO("PipePBiCGStab solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("PipeBiCGStab (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("PipePBiCGStab solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("PipeBiCGStab (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("PipePBiCGStab ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::SetResidualReplacement(int period)
+    {
+        log_debug(this, "PipeBiCGStab::SetResidualReplacement()", period);
+
+        assert(period >= 0);
+
+        this->replace_ = period;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "PipeBiCGStab::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("PipeBiCGStab::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+
+            this->precond_->Build();
+
+            this->rt_.CloneBackend(*this->op_);
+            this->rt_.Allocate("rt", this->op_->GetM());
+
+            this->wt_.CloneBackend(*this->op_);
+            this->wt_.Allocate("wt", this->op_->GetM());
+
+            this->pt_.CloneBackend(*this->op_);
+            this->pt_.Allocate("pt", this->op_->GetM());
+
+            this->st_.CloneBackend(*this->op_);
+            this->st_.Allocate("st", this->op_->GetM());
+
+            this->zt_.CloneBackend(*this->op_);
+            this->zt_.Allocate("zt", this->op_->GetM());
+        }
+
+        this->r0_.CloneBackend(*this->op_);
+        this->r0_.Allocate("r0", this->op_->GetM());
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", this->op_->GetM());
+
+        this->w_.CloneBackend(*this->op_);
+        this->w_.Allocate("w", this->op_->GetM());
+
+        this->t_.CloneBackend(*this->op_);
+        this->t_.Allocate("t", this->op_->GetM());
+
+        this->p_.CloneBackend(*this->op_);
+        this->p_.Allocate("p", this->op_->GetM());
+
+        this->s_.CloneBackend(*this->op_);
+        this->s_.Allocate("s", this->op_->GetM());
+
+        this->z_.CloneBackend(*this->op_);
+        this->z_.Allocate("z", this->op_->GetM());
+
+        this->v_.CloneBackend(*this->op_);
+        this->v_.Allocate("v", this->op_->GetM());
+
+        log_debug(this, "PipeBiCGStab::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::BuildMoveToAcceleratorAsync(void)
+    {
+        log_debug(this, "PipeBiCGStab::BuildMoveToAcceleratorAsync()", this->build_, " #*# begin");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+
+            this->precond_->BuildMoveToAcceleratorAsync();
+
+            this->rt_.CloneBackend(*this->op_);
+            this->rt_.Allocate("rt", this->op_->GetM());
+            this->rt_.MoveToAcceleratorAsync();
+
+            this->wt_.CloneBackend(*this->op_);
+            this->wt_.Allocate("wt", this->op_->GetM());
+            this->wt_.MoveToAcceleratorAsync();
+
+            this->pt_.CloneBackend(*this->op_);
+            this->pt_.Allocate("pt", this->op_->GetM());
+            this->pt_.MoveToAcceleratorAsync();
+
+            this->st_.CloneBackend(*this->op_);
+            this->st_.Allocate("st", this->op_->GetM());
+            this->st_.MoveToAcceleratorAsync();
+
+            this->zt_.CloneBackend(*this->op_);
+            this->zt_.Allocate("zt", this->op_->GetM());
+            this->zt_.MoveToAcceleratorAsync();
+        }
+
+        this->r0_.CloneBackend(*this->op_);
+        this->r0_.Allocate("r0", this->op_->GetM());
+        this->r0_.MoveToAcceleratorAsync();
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", this->op_->GetM());
+        this->r_.MoveToAcceleratorAsync();
+
+        this->w_.CloneBackend(*this->op_);
+        this->w_.Allocate("w", this->op_->GetM());
+        this->w_.MoveToAcceleratorAsync();
+
+        this->t_.CloneBackend(*this->op_);
+        this->t_.Allocate("t", this->op_->GetM());
+        this->t_.MoveToAcceleratorAsync();
+
+        this->p_.CloneBackend(*this->op_);
+        this->p_.Allocate("p", this->op_->GetM());
+        this->p_.MoveToAcceleratorAsync();
+
+        this->s_.CloneBackend(*this->op_);
+        this->s_.Allocate("s", this->op_->GetM());
+        this->s_.MoveToAcceleratorAsync();
+
+        this->z_.CloneBackend(*this->op_);
+        this->z_.Allocate("z", this->op_->GetM());
+        this->z_.MoveToAcceleratorAsync();
+
+        this->v_.CloneBackend(*this->op_);
+        this->v_.Allocate("v", this->op_->GetM());
+        this->v_.MoveToAcceleratorAsync();
+
+        log_debug(this, "PipeBiCGStab::BuildMoveToAcceleratorAsync()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::Sync(void)
+    {
+        log_debug(this, "PipeBiCGStab::Sync()", this->build_, " #*# begin");
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->Sync();
+            this->rt_.Sync();
+            this->wt_.Sync();
+            this->pt_.Sync();
+            this->st_.Sync();
+            this->zt_.Sync();
+        }
+
+        this->r0_.Sync();
+        this->r_.Sync();
+        this->w_.Sync();
+        this->t_.Sync();
+        this->p_.Sync();
+        this->s_.Sync();
+        this->z_.Sync();
+        this->v_.Sync();
+
+        log_debug(this, "PipeBiCGStab::Sync()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "PipeBiCGStab::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->r0_.Clear();
+            this->r_.Clear();
+            this->w_.Clear();
+            this->t_.Clear();
+            this->p_.Clear();
+            this->s_.Clear();
+            this->z_.Clear();
+            this->v_.Clear();
+            this->rt_.Clear();
+            this->wt_.Clear();
+            this->pt_.Clear();
+            this->st_.Clear();
+            this->zt_.Clear();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "PipeBiCGStab::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r0_.Zeros();
+            this->r_.Zeros();
+            this->w_.Zeros();
+            this->t_.Zeros();
+            this->p_.Zeros();
+            this->s_.Zeros();
+            this->z_.Zeros();
+            this->v_.Zeros();
+            this->rt_.Zeros();
+            this->wt_.Zeros();
+            this->pt_.Zeros();
+            this->st_.Zeros();
+            this->zt_.Zeros();
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "PipeBiCGStab::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r0_.MoveToHost();
+            this->r_.MoveToHost();
+            this->w_.MoveToHost();
+            this->t_.MoveToHost();
+            this->p_.MoveToHost();
+            this->s_.MoveToHost();
+            this->z_.MoveToHost();
+            this->v_.MoveToHost();
+
+            if(this->precond_ != NULL)
+            {
+                this->rt_.MoveToHost();
+                this->wt_.MoveToHost();
+                this->pt_.MoveToHost();
+                this->st_.MoveToHost();
+                this->zt_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "PipeBiCGStab::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r0_.MoveToAccelerator();
+            this->r_.MoveToAccelerator();
+            this->w_.MoveToAccelerator();
+            this->t_.MoveToAccelerator();
+            this->p_.MoveToAccelerator();
+            this->s_.MoveToAccelerator();
+            this->z_.MoveToAccelerator();
+            this->v_.MoveToAccelerator();
+
+            if(this->precond_ != NULL)
+            {
+                this->rt_.MoveToAccelerator();
+                this->wt_.MoveToAccelerator();
+                this->pt_.MoveToAccelerator();
+                this->st_.MoveToAccelerator();
+                this->zt_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                             VectorType*       x)
+    {
+        log_debug(this, "PipeBiCGStab::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        const OperatorType* op = this->op_;
+
+        VectorType* r0 = &this->r0_;
+        VectorType* r  = &this->r_;
+        VectorType* w  = &this->w_;
+        VectorType* t  = &this->t_;
+        VectorType* p  = &this->p_;
+        VectorType* s  = &this->s_;
+        VectorType* z  = &this->z_;
+        VectorType* v  = &this->v_;
+
+        const ValueType one  = static_cast<ValueType>(1);
+        const ValueType zero = static_cast<ValueType>(0);
+
+        ValueType alpha;
+        ValueType beta;
+        ValueType omega;
+        ValueType rho, rho_old;
+
+        // For L2 norms, |r| is reduced together with the other dot products
+        bool fused_norm = (this->res_norm_type_ == 2);
+
+        // Initial residual r0 = b - Ax
+        op->Apply(*x, r0);
+        r0->ScaleAdd(-one, rhs);
+
+        // Initial residual norm |b-Ax0|
+        ValueType res_norm = this->Norm_(*r0);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        {
+            log_debug(this, "PipeBiCGStab::SolveNonPrecond_()", " #*# end");
+            return;
+        }
+
+        // r = r0, w = Ar
+        r->CopyFrom(*r0);
+        op->Apply(*r, w);
+
+        // omega = (y,q) / (y,y), where q and y are stored in r and w
+        const VectorType* omega_x[2] = {w, w};
+        const VectorType* omega_y[2] = {r, w};
+        ValueType         omega_res[2];
+
+        // rho = (r0,r), (r0,w), (r0,s), (r0,z) and (r,r)
+        const VectorType* rho_x[5] = {r0, r0, r0, r0, r};
+        const VectorType* rho_y[5] = {r, w, s, z, r};
+        ValueType         rho_res[5];
+
+        int ndot = fused_norm ? 5 : 4;
+
+        // Start the reduction of (r0,r) and (r0,w), overlap with t = Aw
+        r->DotAsync(2, rho_x, rho_y, rho_res);
+        op->Apply(*w, t);
+        r->DotSync();
+
+        rho   = rho_res[0];
+        alpha = rho / rho_res[1];
+
+        bool first = true;
+        int  since = 0;
+
+        while(true)
+        {
+            if(first == false)
+            {
+                // p = r + beta * (p - omega * s)
+                // s = w + beta * (s - omega * z)
+                // z = t + beta * (z - omega * v)
+                p->ScaleAdd2(beta, *s, -beta * omega, *r, one);
+                s->ScaleAdd2(beta, *z, -beta * omega, *w, one);
+                z->ScaleAdd2(beta, *v, -beta * omega, *t, one);
+            }
+            else
+            {
+                p->CopyFrom(*r);
+                s->CopyFrom(*w);
+                z->CopyFrom(*t);
+
+                first = false;
+            }
+
+            // q = r - alpha * s and y = w - alpha * z, stored in r and w
+            r->AddScale(*s, -alpha);
+            w->AddScale(*z, -alpha);
+
+            // Start the merged reduction
+            r->DotAsync(2, omega_x, omega_y, omega_res);
+
+            // Overlap with v = Az
+            op->Apply(*z, v);
+
+            // Wait for the reduction
+            r->DotSync();
+
+            omega = omega_res[0] / omega_res[1];
+
+            if((std::abs(omega) == std::numeric_limits<ValueType>::infinity()) || (omega != omega)
+               || (omega == zero))
+            {
+                LOG_INFO("PipeBiCGStab omega == 0 || Nan || Inf !!! Updated solution only in "
+                         "p-direction");
+
+                // Update only for p
+                // x = x + alpha * p
+                x->AddScale(*p, alpha);
+
+                op->Apply(*x, p);
+                p->ScaleAdd(-one, rhs);
+
+                res_norm = this->Norm_(*p);
+
+                this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_);
+
+                break;
+            }
+
+            // x = x + alpha * p + omega * q
+            x->ScaleAdd2(one, *p, alpha, *r, omega);
+
+            if(this->replace_ > 0 && ++since == this->replace_)
+            {
+                // Residual replacement, recompute r = b - Ax, w = Ar and restart the
+                // recurrences
+                op->Apply(*x, r);
+                r->ScaleAdd(-one, rhs);
+                op->Apply(*r, w);
+
+                first = true;
+                since = 0;
+            }
+            else
+            {
+                // r = q - omega * y
+                r->AddScale(*w, -omega);
+
+                // w = y - omega * (t - alpha * v)
+                t->AddScale(*v, -alpha);
+                w->AddScale(*t, -omega);
+            }
+
+            // Start the merged reduction
+            r->DotAsync(ndot, rho_x, rho_y, rho_res);
+
+            // Overlap with t = Aw
+            op->Apply(*w, t);
+
+            // Wait for the reduction
+            r->DotSync();
+
+            // Check convergence
+            res_norm = fused_norm ? std::sqrt(std::abs(rho_res[4])) : this->Norm_(*r);
+            if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
+            {
+                break;
+            }
+
+            rho_old = rho;
+            rho     = rho_res[0];
+
+            // Check rho for zero
+            if(rho == zero)
+            {
+                LOG_INFO("PipeBiCGStab rho == 0 !!!");
+                break;
+            }
+
+            if(first == false)
+            {
+                beta  = (rho / rho_old) * (alpha / omega);
+                alpha = rho / (rho_res[1] + beta * rho_res[2] - beta * omega * rho_res[3]);
+            }
+            else
+            {
+                alpha = rho / rho_res[1];
+            }
+        }
+
+        log_debug(this, "PipeBiCGStab::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeBiCGStab<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                          VectorType*       x)
+    {
+        log_debug(this, "PipeBiCGStab::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        const OperatorType* op = this->op_;
+
+        VectorType* r0 = &this->r0_;
+        VectorType* r  = &this->r_;
+        VectorType* w  = &this->w_;
+        VectorType* t  = &this->t_;
+        VectorType* p  = &this->p_;
+        VectorType* s  = &this->s_;
+        VectorType* z  = &this->z_;
+        VectorType* v  = &this->v_;
+        VectorType* rt = &this->rt_;
+        VectorType* wt = &this->wt_;
+        VectorType* pt = &this->pt_;
+        VectorType* st = &this->st_;
+        VectorType* zt = &this->zt_;
+
+        const ValueType one  = static_cast<ValueType>(1);
+        const ValueType zero = static_cast<ValueType>(0);
+
+        ValueType alpha;
+        ValueType beta;
+        ValueType omega;
+        ValueType rho, rho_old;
+
+        // For L2 norms, |r| is reduced together with the other dot products
+        bool fused_norm = (this->res_norm_type_ == 2);
+
+        // Initial residual r0 = b - Ax
+        op->Apply(*x, r0);
+        r0->ScaleAdd(-one, rhs);
+
+        // Initial residual norm |b-Ax0|
+        ValueType res_norm = this->Norm_(*r0);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        {
+            log_debug(this, "PipeBiCGStab::SolvePrecond_()", " #*# end");
+            return;
+        }
+
+        // r = r0, Solve Mrt=r, w = Art
+        r->CopyFrom(*r0);
+        this->PrecondSolveZeroSol_(*r, rt);
+        op->Apply(*rt, w);
+
+        // omega = (y,q) / (y,y), where q and y are stored in r and w
+        const VectorType* omega_x[2] = {w, w};
+        const VectorType* omega_y[2] = {r, w};
+        ValueType         omega_res[2];
+
+        // rho = (r0,r), (r0,w), (r0,s), (r0,z) and (r,r)
+        const VectorType* rho_x[5] = {r0, r0, r0, r0, r};
+        const VectorType* rho_y[5] = {r, w, s, z, r};
+        ValueType         rho_res[5];
+
+        int ndot = fused_norm ? 5 : 4;
+
+        // Start the reduction of (r0,r) and (r0,w), overlap with Solve Mwt=w and t = Awt
+        r->DotAsync(2, rho_x, rho_y, rho_res);
+        this->PrecondSolveZeroSol_(*w, wt);
+        op->Apply(*wt, t);
+        r->DotSync();
+
+        rho   = rho_res[0];
+        alpha = rho / rho_res[1];
+
+        bool first = true;
+        int  since = 0;
+
+        while(true)
+        {
+            if(first == false)
+            {
+                // p = r + beta * (p - omega * s), pt = rt + beta * (pt - omega * st)
+                // s = w + beta * (s - omega * z), st = wt + beta * (st - omega * zt)
+                // z = t + beta * (z - omega * v)
+                p->ScaleAdd2(beta, *s, -beta * omega, *r, one);
+                pt->ScaleAdd2(beta, *st, -beta * omega, *rt, one);
+                s->ScaleAdd2(beta, *z, -beta * omega, *w, one);
+                st->ScaleAdd2(beta, *zt, -beta * omega, *wt, one);
+                z->ScaleAdd2(beta, *v, -beta * omega, *t, one);
+            }
+            else
+            {
+                p->CopyFrom(*r);
+                pt->CopyFrom(*rt);
+                s->CopyFrom(*w);
+                st->CopyFrom(*wt);
+                z->CopyFrom(*t);
+
+                first = false;
+            }
+
+            // q = r - alpha * s, qt = rt - alpha * st and y = w - alpha * z, stored in r, rt
+            // and w
+            r->AddScale(*s, -alpha);
+            rt->AddScale(*st, -alpha);
+            w->AddScale(*z, -alpha);
+
+            // Start the merged reduction
+            r->DotAsync(2, omega_x, omega_y, omega_res);
+
+            // Overlap with Solve Mzt=z and v = Azt
+            this->PrecondSolveZeroSol_(*z, zt);
+            op->Apply(*zt, v);
+
+            // Wait for the reduction
+            r->DotSync();
+
+            omega = omega_res[0] / omega_res[1];
+
+            if((std::abs(omega) == std::numeric_limits<ValueType>::infinity()) || (omega != omega)
+               || (omega == zero))
+            {
+                LOG_INFO("PipeBiCGStab omega == 0 || Nan || Inf !!! Updated solution only in "
+                         "p-direction");
+
+                // Update only for p
+                // x = x + alpha * pt
+                x->AddScale(*pt, alpha);
+
+                op->Apply(*x, p);
+                p->ScaleAdd(-one, rhs);
+
+                res_norm = this->Norm_(*p);
+
+                this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_);
+
+                break;
+            }
+
+            // x = x + alpha * pt + omega * qt
+            x->ScaleAdd2(one, *pt, alpha, *rt, omega);
+
+            if(this->replace_ > 0 && ++since == this->replace_)
+            {
+                // Residual replacement, recompute r = b - Ax, rt = Mr, w = Art and restart
+                // the recurrences
+                op->Apply(*x, r);
+                r->ScaleAdd(-one, rhs);
+                this->PrecondSolveZeroSol_(*r, rt);
+                op->Apply(*rt, w);
+
+                first = true;
+                since = 0;
+            }
+            else
+            {
+                // r = q - omega * y
+                r->AddScale(*w, -omega);
+
+                // rt = qt - omega * (wt - alpha * zt)
+                wt->AddScale(*zt, -alpha);
+                rt->AddScale(*wt, -omega);
+
+                // w = y - omega * (t - alpha * v)
+                t->AddScale(*v, -alpha);
+                w->AddScale(*t, -omega);
+            }
+
+            // Start the merged reduction
+            r->DotAsync(ndot, rho_x, rho_y, rho_res);
+
+            // Overlap with Solve Mwt=w and t = Awt
+            this->PrecondSolveZeroSol_(*w, wt);
+            op->Apply(*wt, t);
+
+            // Wait for the reduction
+            r->DotSync();
+
+            // Check convergence
+            res_norm = fused_norm ? std::sqrt(std::abs(rho_res[4])) : this->Norm_(*r);
+            if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
+            {
+                break;
+            }
+
+            rho_old = rho;
+            rho     = rho_res[0];
+
+            // Check rho for zero
+            if(rho == zero)
+            {
+                LOG_INFO("PipeBiCGStab rho == 0 !!!");
+                break;
+            }
+
+            if(first == false)
+            {
+                beta  = (rho / rho_old) * (alpha / omega);
+                alpha = rho / (rho_res[1] + beta * rho_res[2] - beta * omega * rho_res[3]);
+            }
+            else
+            {
+                alpha = rho / rho_res[1];
+            }
+        }
+
+        log_debug(this, "PipeBiCGStab::SolvePrecond_()", " #*# end");
+    }
+
+    template class PipeBiCGStab<LocalMatrix<double>, LocalVector<double>, double>;
+    template class PipeBiCGStab<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class PipeBiCGStab<LocalMatrix<std::complex<double>>,
+                                LocalVector<std::complex<double>>,
+                                std::complex<double>>;
+    template class PipeBiCGStab<LocalMatrix<std::complex<float>>,
+                                LocalVector<std::complex<float>>,
+                                std::complex<float>>;
+#endif
+
+    template class PipeBiCGStab<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class PipeBiCGStab<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class PipeBiCGStab<GlobalMatrix<std::complex<double>>,
+                                GlobalVector<std::complex<double>>,
+                                std::complex<double>>;
+    template class PipeBiCGStab<GlobalMatrix<std::complex<float>>,
+                                GlobalVector<std::complex<float>>,
+                                std::complex<float>>;
+#endif
+
+    template class PipeBiCGStab<LocalStencil<double>, LocalVector<double>, double>;
+    template class PipeBiCGStab<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class PipeBiCGStab<LocalStencil<std::complex<double>>,
+                                LocalVector<std::complex<double>>,
+                                std::complex<double>>;
+    template class PipeBiCGStab<LocalStencil<std::complex<float>>,
+                                LocalVector<std::complex<float>>,
+                                std::complex<float>>;
+#endif
+
+} // namespace rocalution
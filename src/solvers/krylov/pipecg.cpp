@@ -0,0 +1,662 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "pipecg.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <complex>
+#include <math.h>
+#include <type_traits>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    PipeCG<OperatorType, VectorType, ValueType>::PipeCG()
+    {
+        log_debug(this, "PipeCG::PipeCG()", "default constructor");
+
+        this->replace_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    PipeCG<OperatorType, VectorType, ValueType>::~PipeCG()
+    {
+        log_debug(this, "PipeCG::~PipeCG()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("PipeCG solver");
+        }
+        else
+        {
+            LOG_INFO("PipePCG solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("PipeCG (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("PipePCG solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("PipeCG (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("PipePCG ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::SetResidualReplacement(int period)
+    {
+        log_debug(this, "PipeCG::SetResidualReplacement()", period);
+
+        assert(period >= 0);
+
+        this->replace_ = period;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "PipeCG::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("PipeCG::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+
+            this->precond_->Build();
+
+            this->u_.CloneBackend(*this->op_);
+            this->u_.Allocate("u", this->op_->GetM());
+
+            this->m_.CloneBackend(*this->op_);
+            this->m_.Allocate("m", this->op_->GetM());
+
+            this->q_.CloneBackend(*this->op_);
+            this->q_.Allocate("q", this->op_->GetM());
+        }
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", this->op_->GetM());
+
+        this->w_.CloneBackend(*this->op_);
+        this->w_.Allocate("w", this->op_->GetM());
+
+        this->n_.CloneBackend(*this->op_);
+        this->n_.Allocate("n", this->op_->GetM());
+
+        this->p_.CloneBackend(*this->op_);
+        this->p_.Allocate("p", this->op_->GetM());
+
+        this->s_.CloneBackend(*this->op_);
+        this->s_.Allocate("s", this->op_->GetM());
+
+        this->z_.CloneBackend(*this->op_);
+        this->z_.Allocate("z", this->op_->GetM());
+
+        log_debug(this, "PipeCG::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::BuildMoveToAcceleratorAsync(void)
+    {
+        log_debug(this, "PipeCG::BuildMoveToAcceleratorAsync()", this->build_, " #*# begin");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+
+            this->precond_->BuildMoveToAcceleratorAsync();
+
+            this->u_.CloneBackend(*this->op_);
+            this->u_.Allocate("u", this->op_->GetM());
+            this->u_.MoveToAcceleratorAsync();
+
+            this->m_.CloneBackend(*this->op_);
+            this->m_.Allocate("m", this->op_->GetM());
+            this->m_.MoveToAcceleratorAsync();
+
+            this->q_.CloneBackend(*this->op_);
+            this->q_.Allocate("q", this->op_->GetM());
+            this->q_.MoveToAcceleratorAsync();
+        }
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", this->op_->GetM());
+        this->r_.MoveToAcceleratorAsync();
+
+        this->w_.CloneBackend(*this->op_);
+        this->w_.Allocate("w", this->op_->GetM());
+        this->w_.MoveToAcceleratorAsync();
+
+        this->n_.CloneBackend(*this->op_);
+        this->n_.Allocate("n", this->op_->GetM());
+        this->n_.MoveToAcceleratorAsync();
+
+        this->p_.CloneBackend(*this->op_);
+        this->p_.Allocate("p", this->op_->GetM());
+        this->p_.MoveToAcceleratorAsync();
+
+        this->s_.CloneBackend(*this->op_);
+        this->s_.Allocate("s", this->op_->GetM());
+        this->s_.MoveToAcceleratorAsync();
+
+        this->z_.CloneBackend(*this->op_);
+        this->z_.Allocate("z", this->op_->GetM());
+        this->z_.MoveToAcceleratorAsync();
+
+        log_debug(this, "PipeCG::BuildMoveToAcceleratorAsync()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::Sync(void)
+    {
+        log_debug(this, "PipeCG::Sync()", this->build_, " #*# begin");
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->Sync();
+            this->u_.Sync();
+            this->m_.Sync();
+            this->q_.Sync();
+        }
+
+        this->r_.Sync();
+        this->w_.Sync();
+        this->n_.Sync();
+        this->p_.Sync();
+        this->s_.Sync();
+        this->z_.Sync();
+
+        log_debug(this, "PipeCG::Sync()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "PipeCG::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->r_.Clear();
+            this->u_.Clear();
+            this->w_.Clear();
+            this->m_.Clear();
+            this->n_.Clear();
+            this->p_.Clear();
+            this->q_.Clear();
+            this->s_.Clear();
+            this->z_.Clear();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "PipeCG::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.Zeros();
+            this->u_.Zeros();
+            this->w_.Zeros();
+            this->m_.Zeros();
+            this->n_.Zeros();
+            this->p_.Zeros();
+            this->q_.Zeros();
+            this->s_.Zeros();
+            this->z_.Zeros();
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "PipeCG::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToHost();
+            this->w_.MoveToHost();
+            this->n_.MoveToHost();
+            this->p_.MoveToHost();
+            this->s_.MoveToHost();
+            this->z_.MoveToHost();
+
+            if(this->precond_ != NULL)
+            {
+                this->u_.MoveToHost();
+                this->m_.MoveToHost();
+                this->q_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "PipeCG::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToAccelerator();
+            this->w_.MoveToAccelerator();
+            this->n_.MoveToAccelerator();
+            this->p_.MoveToAccelerator();
+            this->s_.MoveToAccelerator();
+            this->z_.MoveToAccelerator();
+
+            if(this->precond_ != NULL)
+            {
+                this->u_.MoveToAccelerator();
+                this->m_.MoveToAccelerator();
+                this->q_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                       VectorType*       x)
+    {
+        log_debug(this, "PipeCG::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        const OperatorType* op = this->op_;
+
+        VectorType* r = &this->r_;
+        VectorType* w = &this->w_;
+        VectorType* n = &this->n_;
+        VectorType* p = &this->p_;
+        VectorType* s = &this->s_;
+        VectorType* z = &this->z_;
+
+        ValueType alpha, alpha_old;
+        ValueType beta;
+        ValueType gamma, gamma_old;
+        ValueType delta;
+
+        // For real valued L2 norms, |r| is obtained from (r,r) without extra reduction
+        bool fused_norm = (this->res_norm_type_ == 2) && std::is_floating_point<ValueType>::value;
+
+        // Initial residual = b - Ax
+        op->Apply(*x, r);
+        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        // Initial residual norm |b-Ax0|
+        ValueType res_norm = this->Norm_(*r);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        {
+            log_debug(this, "PipeCG::SolveNonPrecond_()", " #*# end");
+            return;
+        }
+
+        // w = Ar
+        op->Apply(*r, w);
+
+        // gamma = (r,r), delta = (w,r)
+        const VectorType* dot_x[2] = {r, w};
+        const VectorType* dot_y[2] = {r, r};
+        ValueType         dot_res[2];
+
+        bool first = true;
+        int  since = 0;
+
+        while(true)
+        {
+            // Start the merged reduction
+            r->DotNonConjAsync(2, dot_x, dot_y, dot_res);
+
+            // Overlap with n = Aw
+            op->Apply(*w, n);
+
+            // Wait for the reduction
+            r->DotSync();
+
+            gamma = dot_res[0];
+            delta = dot_res[1];
+
+            if(first == false)
+            {
+                // Check convergence
+                res_norm = fused_norm ? std::sqrt(std::abs(gamma)) : this->Norm_(*r);
+                if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
+                {
+                    break;
+                }
+
+                beta  = gamma / gamma_old;
+                alpha = gamma / (delta - beta * gamma / alpha_old);
+
+                // z = n + beta*z, s = w + beta*s, p = r + beta*p
+                z->ScaleAdd(beta, *n);
+                s->ScaleAdd(beta, *w);
+                p->ScaleAdd(beta, *r);
+            }
+            else
+            {
+                alpha = gamma / delta;
+
+                z->CopyFrom(*n);
+                s->CopyFrom(*w);
+                p->CopyFrom(*r);
+
+                first = false;
+            }
+
+            // x = x + alpha*p
+            x->AddScale(*p, alpha);
+
+            if(this->replace_ > 0 && ++since == this->replace_)
+            {
+                // Residual replacement, recompute r = b - Ax, w = Ar and restart the
+                // recurrences
+                op->Apply(*x, r);
+                r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+                op->Apply(*r, w);
+
+                first = true;
+                since = 0;
+            }
+            else
+            {
+                // r = r - alpha*s
+                r->AddScale(*s, -alpha);
+
+                // w = w - alpha*z
+                w->AddScale(*z, -alpha);
+            }
+
+            gamma_old = gamma;
+            alpha_old = alpha;
+        }
+
+        log_debug(this, "PipeCG::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PipeCG<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                    VectorType*       x)
+    {
+        log_debug(this, "PipeCG::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        const OperatorType* op = this->op_;
+
+        VectorType* r = &this->r_;
+        VectorType* u = &this->u_;
+        VectorType* w = &this->w_;
+        VectorType* m = &this->m_;
+        VectorType* n = &this->n_;
+        VectorType* p = &this->p_;
+        VectorType* q = &this->q_;
+        VectorType* s = &this->s_;
+        VectorType* z = &this->z_;
+
+        ValueType alpha, alpha_old;
+        ValueType beta;
+        ValueType gamma, gamma_old;
+        ValueType delta;
+
+        // For real valued L2 norms, |r| is reduced together with the other dot products
+        bool fused_norm = (this->res_norm_type_ == 2) && std::is_floating_point<ValueType>::value;
+
+        // Initial residual = b - Ax
+        op->Apply(*x, r);
+        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        // Initial residual norm |b-Ax0|
+        ValueType res_norm = this->Norm_(*r);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        {
+            log_debug(this, "PipeCG::SolvePrecond_()", " #*# end");
+            return;
+        }
+
+        // Solve Mu=r
+        this->PrecondSolveZeroSol_(*r, u);
+
+        // w = Au
+        op->Apply(*u, w);
+
+        // gamma = (r,u), delta = (w,u), (r,r)
+        const VectorType* dot_x[3] = {r, w, r};
+        const VectorType* dot_y[3] = {u, u, r};
+        ValueType         dot_res[3];
+
+        int ndot = fused_norm ? 3 : 2;
+
+        bool first = true;
+        int  since = 0;
+
+        while(true)
+        {
+            // Start the merged reduction
+            r->DotNonConjAsync(ndot, dot_x, dot_y, dot_res);
+
+            // Overlap with Solve Mm=w and n = Am
+            this->PrecondSolveZeroSol_(*w, m);
+            op->Apply(*m, n);
+
+            // Wait for the reduction
+            r->DotSync();
+
+            gamma = dot_res[0];
+            delta = dot_res[1];
+
+            if(first == false)
+            {
+                // Check convergence
+                res_norm = fused_norm ? std::sqrt(std::abs(dot_res[2])) : this->Norm_(*r);
+                if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
+                {
+                    break;
+                }
+
+                beta  = gamma / gamma_old;
+                alpha = gamma / (delta - beta * gamma / alpha_old);
+
+                // z = n + beta*z, q = m + beta*q, s = w + beta*s, p = u + beta*p
+                z->ScaleAdd(beta, *n);
+                q->ScaleAdd(beta, *m);
+                s->ScaleAdd(beta, *w);
+                p->ScaleAdd(beta, *u);
+            }
+            else
+            {
+                alpha = gamma / delta;
+
+                z->CopyFrom(*n);
+                q->CopyFrom(*m);
+                s->CopyFrom(*w);
+                p->CopyFrom(*u);
+
+                first = false;
+            }
+
+            // x = x + alpha*p
+            x->AddScale(*p, alpha);
+
+            if(this->replace_ > 0 && ++since == this->replace_)
+            {
+                // Residual replacement, recompute r = b - Ax, u = Mr, w = Au and
+                // restart the recurrences
+                op->Apply(*x, r);
+                r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+                this->PrecondSolveZeroSol_(*r, u);
+                op->Apply(*u, w);
+
+                first = true;
+                since = 0;
+            }
+            else
+            {
+                // r = r - alpha*s
+                r->AddScale(*s, -alpha);
+
+                // u = u - alpha*q
+                u->AddScale(*q, -alpha);
+
+                // w = w - alpha*z
+                w->AddScale(*z, -alpha);
+            }
+
+            gamma_old = gamma;
+            alpha_old = alpha;
+        }
+
+        log_debug(this, "PipeCG::SolvePrecond_()", " #*# end");
+    }
+
+    template class PipeCG<LocalMatrix<double>, LocalVector<double>, double>;
+    template class PipeCG<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class PipeCG<LocalMatrix<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class PipeCG<LocalMatrix<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class PipeCG<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class PipeCG<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class PipeCG<GlobalMatrix<std::complex<double>>,
+                          GlobalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class PipeCG<GlobalMatrix<std::complex<float>>,
+                          GlobalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class PipeCG<LocalStencil<double>, LocalVector<double>, double>;
+    template class PipeCG<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class PipeCG<LocalStencil<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class PipeCG<LocalStencil<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+} // namespace rocalution
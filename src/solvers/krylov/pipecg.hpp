@@ -0,0 +1,107 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_KRYLOV_PIPECG_HPP_
+#define ROCALUTION_KRYLOV_PIPECG_HPP_
+
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class PipeCG
+  * \brief Pipelined Conjugate Gradient Method
+  * \details
+  * The pipelined Conjugate Gradient method is a mathematically equivalent
+  * reformulation of the (preconditioned) Conjugate Gradient method for symmetric
+  * positive definite (SPD) linear systems \f$Ax=b\f$. By introducing auxiliary
+  * recurrences, all dot products of an iteration are merged into a single
+  * non-blocking global reduction, which is overlapped with the preconditioner
+  * application and the sparse matrix-vector product. This hides the global
+  * synchronization latency on large numbers of processes, at the cost of additional
+  * vector updates and slightly reduced numerical stability compared to CG.
+  * \cite pipecg
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class PipeCG : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        PipeCG();
+        ROCALUTION_EXPORT
+        virtual ~PipeCG();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Set the residual replacement period
+        * \details
+        * The auxiliary recurrences of the pipelined method accumulate rounding errors,
+        * which limit the attainable accuracy, in particular in single precision. If
+        * \p period is positive, the residual is recomputed explicitly every \p period
+        * iterations and the recurrences are restarted. Default is 0 (disabled).
+        */
+        ROCALUTION_EXPORT
+        void SetResidualReplacement(int period);
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+
+        ROCALUTION_EXPORT
+        virtual void BuildMoveToAcceleratorAsync(void);
+        ROCALUTION_EXPORT
+        virtual void Sync(void);
+
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        int replace_;
+
+        VectorType r_, u_, w_;
+        VectorType m_, n_;
+        VectorType p_, q_, s_, z_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_PIPECG_HPP_
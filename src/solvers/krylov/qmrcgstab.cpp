@@ -101,6 +101,8 @@ namespace rocalution
     {
         log_debug(this, "QMRCGStab::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("QMRCGStab::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -519,7 +521,7 @@ namespace rocalution
         p->AddScale(*r, static_cast<ValueType>(1));
 
         // Mz = p
-        this->precond_->SolveZeroSol(*p, z);
+        this->PrecondSolveZeroSol_(*p, z);
 
         // v = Az
         op->Apply(*z, v);
@@ -557,7 +559,7 @@ namespace rocalution
         // Compute t_k, omega and update r_k
 
         // Mz = r
-        this->precond_->SolveZeroSol(*r, z);
+        this->PrecondSolveZeroSol_(*r, z);
 
         // t = Az
         op->Apply(*z, t);
@@ -610,7 +612,7 @@ namespace rocalution
             p->AddScale(*r, static_cast<ValueType>(1));
 
             // Mz = p
-            this->precond_->SolveZeroSol(*p, z);
+            this->PrecondSolveZeroSol_(*p, z);
 
             // v = Ap
             op->Apply(*z, v);
@@ -654,7 +656,7 @@ namespace rocalution
             // Compute t_k, omega and update r_k
 
             // Mz = r
-            this->precond_->SolveZeroSol(*r, z);
+            this->PrecondSolveZeroSol_(*r, z);
 
             // t = Ar
             op->Apply(*z, t);
@@ -0,0 +1,930 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "recycledgmres.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+#include "../../base/matrix_formats_ind.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+#include "../../utils/type_traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    RecycledGMRES<OperatorType, VectorType, ValueType>::RecycledGMRES()
+    {
+        log_debug(this, "RecycledGMRES::RecycledGMRES()", "default constructor");
+
+        this->size_basis_   = 30;
+        this->size_recycle_ = 10;
+        this->nrecycle_     = 0;
+
+        this->recycle_update_ = false;
+
+        this->v_ = NULL;
+        this->z_ = NULL;
+        this->U_ = NULL;
+        this->C_ = NULL;
+
+        this->H_ = NULL;
+        this->B_ = NULL;
+        this->c_ = NULL;
+        this->s_ = NULL;
+        this->r_ = NULL;
+        this->h_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    RecycledGMRES<OperatorType, VectorType, ValueType>::~RecycledGMRES()
+    {
+        log_debug(this, "RecycledGMRES::~RecycledGMRES()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("RecycledGMRES solver");
+        }
+        else
+        {
+            LOG_INFO("RecycledGMRES solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("RecycledGMRES(" << this->size_basis_ << "," << this->size_recycle_
+                                      << ") (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("RecycledGMRES(" << this->size_basis_ << "," << this->size_recycle_
+                                      << ") solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("RecycledGMRES(" << this->size_basis_ << "," << this->size_recycle_
+                                      << ") (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("RecycledGMRES(" << this->size_basis_ << "," << this->size_recycle_
+                                      << ") ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "RecycledGMRES::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("RecycledGMRES::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+
+        if(this->res_norm_type_ != 2)
+        {
+            LOG_INFO("RecycledGMRES solver supports only L2 residual norm. The solver is "
+                     "switching to L2 norm");
+            this->res_norm_type_ = 2;
+        }
+
+        int size = this->size_basis_;
+        int nrec = this->size_recycle_;
+
+        allocate_host(size, &this->c_);
+        allocate_host(size, &this->s_);
+        allocate_host(size + 1, &this->r_);
+        allocate_host((size + 1) * size, &this->H_);
+        allocate_host(std::max(nrec, 1) * size, &this->B_);
+        allocate_host(nrec + size + 2, &this->h_);
+
+        this->dot_x_.resize(nrec + size + 2);
+
+        this->v_ = new VectorType*[size + 1];
+
+        for(int i = 0; i < size + 1; ++i)
+        {
+            this->v_[i] = new VectorType;
+            this->v_[i]->CloneBackend(*this->op_);
+            this->v_[i]->Allocate("v", this->op_->GetM());
+        }
+
+        this->U_ = new VectorType*[std::max(nrec, 1)];
+        this->C_ = new VectorType*[std::max(nrec, 1)];
+
+        for(int i = 0; i < nrec; ++i)
+        {
+            this->U_[i] = new VectorType;
+            this->U_[i]->CloneBackend(*this->op_);
+            this->U_[i]->Allocate("U", this->op_->GetM());
+
+            this->C_[i] = new VectorType;
+            this->C_[i]->CloneBackend(*this->op_);
+            this->C_[i]->Allocate("C", this->op_->GetM());
+        }
+
+        this->u_.CloneBackend(*this->op_);
+        this->u_.Allocate("u", this->op_->GetM());
+
+        this->w_.CloneBackend(*this->op_);
+        this->w_.Allocate("w", this->op_->GetM());
+
+        this->nrecycle_       = 0;
+        this->recycle_update_ = false;
+
+        if(this->precond_ != NULL)
+        {
+            this->z_ = new VectorType*[size];
+
+            for(int i = 0; i < size; ++i)
+            {
+                this->z_[i] = new VectorType;
+                this->z_[i]->CloneBackend(*this->op_);
+                this->z_[i]->Allocate("z", this->op_->GetM());
+            }
+
+            this->precond_->SetOperator(*this->op_);
+            this->precond_->Build();
+        }
+
+        this->build_ = true;
+
+        log_debug(this, "RecycledGMRES::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "RecycledGMRES::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+
+                for(int i = 0; i < this->size_basis_; ++i)
+                {
+                    this->z_[i]->Clear();
+                    delete this->z_[i];
+                }
+
+                delete[] this->z_;
+                this->z_ = NULL;
+            }
+
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->Clear();
+                delete this->v_[i];
+            }
+
+            delete[] this->v_;
+            this->v_ = NULL;
+
+            for(int i = 0; i < this->size_recycle_; ++i)
+            {
+                this->U_[i]->Clear();
+                this->C_[i]->Clear();
+                delete this->U_[i];
+                delete this->C_[i];
+            }
+
+            delete[] this->U_;
+            delete[] this->C_;
+            this->U_ = NULL;
+            this->C_ = NULL;
+
+            this->u_.Clear();
+            this->w_.Clear();
+
+            free_host(&this->c_);
+            free_host(&this->s_);
+            free_host(&this->r_);
+            free_host(&this->H_);
+            free_host(&this->B_);
+            free_host(&this->h_);
+
+            this->dot_x_.clear();
+
+            this->nrecycle_       = 0;
+            this->recycle_update_ = false;
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "RecycledGMRES::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->Zeros();
+            }
+
+            // The operator values have changed, C = AU is updated in the next solve
+            this->recycle_update_ = true;
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                for(int i = 0; i < this->size_basis_; ++i)
+                {
+                    this->z_[i]->Zeros();
+                }
+
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::ResetOperator(const OperatorType& op)
+    {
+        log_debug(this, "RecycledGMRES::ResetOperator()", (const void*&)op);
+
+        IterativeLinearSolver<OperatorType, VectorType, ValueType>::ResetOperator(op);
+
+        if(this->build_ == true)
+        {
+            this->recycle_update_ = true;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "RecycledGMRES::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->MoveToHost();
+            }
+
+            for(int i = 0; i < this->size_recycle_; ++i)
+            {
+                this->U_[i]->MoveToHost();
+                this->C_[i]->MoveToHost();
+            }
+
+            this->u_.MoveToHost();
+            this->w_.MoveToHost();
+
+            if(this->precond_ != NULL)
+            {
+                for(int i = 0; i < this->size_basis_; ++i)
+                {
+                    this->z_[i]->MoveToHost();
+                }
+
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "RecycledGMRES::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->MoveToAccelerator();
+            }
+
+            for(int i = 0; i < this->size_recycle_; ++i)
+            {
+                this->U_[i]->MoveToAccelerator();
+                this->C_[i]->MoveToAccelerator();
+            }
+
+            this->u_.MoveToAccelerator();
+            this->w_.MoveToAccelerator();
+
+            if(this->precond_ != NULL)
+            {
+                for(int i = 0; i < this->size_basis_; ++i)
+                {
+                    this->z_[i]->MoveToAccelerator();
+                }
+
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::SetBasisSize(int size_basis)
+    {
+        log_debug(this, "RecycledGMRES::SetBasisSize()", size_basis);
+
+        assert(size_basis > 0);
+        assert(this->build_ == false);
+
+        this->size_basis_ = size_basis;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::SetRecycleSize(int size_recycle)
+    {
+        log_debug(this, "RecycledGMRES::SetRecycleSize()", size_recycle);
+
+        assert(size_recycle >= 0);
+        assert(this->build_ == false);
+
+        this->size_recycle_ = size_recycle;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int RecycledGMRES<OperatorType, VectorType, ValueType>::GetRecycleSize(void) const
+    {
+        return this->nrecycle_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::ClearRecycleSpace(void)
+    {
+        log_debug(this, "RecycledGMRES::ClearRecycleSpace()");
+
+        this->nrecycle_       = 0;
+        this->recycle_update_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    ValueType RecycledGMRES<OperatorType, VectorType, ValueType>::Orthogonalize_(int         i,
+                                                                                 VectorType* w,
+                                                                                 ValueType*  B,
+                                                                                 ValueType*  H)
+    {
+        int size = this->size_basis_;
+        int ldb  = std::max(this->size_recycle_, 1);
+        int nrec = this->nrecycle_;
+        int n    = nrec + i + 1;
+
+        ValueType* h = this->h_;
+        ValueType  ww;
+        ValueType  nrm2;
+
+        // Project against c_0, ..., c_nrecycle-1, v_0, ..., v_i and compute <w,w> in the
+        // same reduction
+        for(int k = 0; k < nrec; ++k)
+        {
+            this->dot_x_[k] = this->C_[k];
+            B[DENSE_IND(k, i, ldb, size)] = static_cast<ValueType>(0);
+        }
+
+        for(int k = 0; k <= i; ++k)
+        {
+            this->dot_x_[nrec + k] = this->v_[k];
+            H[DENSE_IND(k, i, size + 1, size)] = static_cast<ValueType>(0);
+        }
+
+        this->dot_x_[n] = w;
+
+        // Classical Gram-Schmidt with re-orthogonalization
+        for(int pass = 0; pass < 2; ++pass)
+        {
+            w->MultiDot(n + 1, this->dot_x_.data(), h);
+
+            ww   = h[n];
+            nrm2 = ww;
+
+            for(int k = 0; k < n; ++k)
+            {
+                if(k < nrec)
+                {
+                    // B_ki += <c_k,w>
+                    B[DENSE_IND(k, i, ldb, size)] += h[k];
+                }
+                else
+                {
+                    // H_ki += <v_k,w>
+                    H[DENSE_IND(k - nrec, i, size + 1, size)] += h[k];
+                }
+
+                w->AddScale(*this->dot_x_[k], -h[k]);
+
+                nrm2 -= rocalution_conj(h[k]) * h[k];
+            }
+        }
+
+        // ||w|| from ||w||^2 - ||h||^2 unless there is severe cancellation
+        if(std::real(nrm2) > std::real(ww) / 100)
+        {
+            return static_cast<ValueType>(std::sqrt(std::real(nrm2)));
+        }
+
+        return this->Norm_(*w);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::AppendRecycleSpace_(VectorType* u,
+                                                                                 VectorType* c)
+    {
+        typedef numeric_traits_t<ValueType> RealType;
+
+        int nrec = this->nrecycle_;
+
+        ValueType* h = this->h_;
+
+        // c and u are dropped if c is numerically contained in the span of C
+        RealType tol = std::sqrt(std::numeric_limits<RealType>::epsilon());
+
+        RealType nrm0 = std::real(this->Norm_(*c));
+
+        if(!(nrm0 > static_cast<RealType>(0)))
+        {
+            return;
+        }
+
+        // c is orthogonal to C in exact arithmetic, one pass restores orthogonality
+        if(nrec > 0)
+        {
+            c->MultiDot(nrec, this->C_, h);
+
+            for(int k = 0; k < nrec; ++k)
+            {
+                c->AddScale(*this->C_[k], -h[k]);
+                u->AddScale(*this->U_[k], -h[k]);
+            }
+        }
+
+        RealType nrm = std::real(this->Norm_(*c));
+
+        if(!(nrm > tol * nrm0))
+        {
+            return;
+        }
+
+        // Drop the oldest vector if the recycled subspace is full
+        if(nrec == this->size_recycle_)
+        {
+            VectorType* tmp_u = this->U_[0];
+            VectorType* tmp_c = this->C_[0];
+
+            for(int k = 0; k < nrec - 1; ++k)
+            {
+                this->U_[k] = this->U_[k + 1];
+                this->C_[k] = this->C_[k + 1];
+            }
+
+            this->U_[nrec - 1] = tmp_u;
+            this->C_[nrec - 1] = tmp_c;
+
+            --nrec;
+        }
+
+        ValueType scale = static_cast<ValueType>(1) / static_cast<ValueType>(nrm);
+
+        this->C_[nrec]->CopyFrom(*c);
+        this->C_[nrec]->Scale(scale);
+
+        this->U_[nrec]->CopyFrom(*u);
+        this->U_[nrec]->Scale(scale);
+
+        this->nrecycle_ = nrec + 1;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::UpdateRecycleSpace_(void)
+    {
+        log_debug(this, "RecycledGMRES::UpdateRecycleSpace_()", this->nrecycle_);
+
+        typedef numeric_traits_t<ValueType> RealType;
+
+        const OperatorType* op = this->op_;
+
+        ValueType* h = this->h_;
+
+        RealType tol = std::sqrt(std::numeric_limits<RealType>::epsilon());
+
+        // Recompute C = AU and orthonormalize C, applying the same transformation to U.
+        // Vectors that became numerically dependent are dropped.
+        int n = 0;
+
+        for(int j = 0; j < this->nrecycle_; ++j)
+        {
+            VectorType* u = this->U_[j];
+            VectorType* c = this->C_[j];
+
+            // c_j = Au_j
+            op->Apply(*u, c);
+
+            RealType nrm0 = std::real(this->Norm_(*c));
+            RealType nrm  = nrm0;
+
+            if(n > 0)
+            {
+                // Classical Gram-Schmidt with re-orthogonalization against c_0, ..., c_n-1
+                for(int pass = 0; pass < 2; ++pass)
+                {
+                    c->MultiDot(n, this->C_, h);
+
+                    for(int k = 0; k < n; ++k)
+                    {
+                        c->AddScale(*this->C_[k], -h[k]);
+                        u->AddScale(*this->U_[k], -h[k]);
+                    }
+                }
+
+                nrm = std::real(this->Norm_(*c));
+            }
+
+            if(nrm > tol * nrm0 && nrm > static_cast<RealType>(0))
+            {
+                ValueType scale = static_cast<ValueType>(1) / static_cast<ValueType>(nrm);
+
+                c->Scale(scale);
+                u->Scale(scale);
+
+                // Compact the recycled subspace
+                std::swap(this->U_[n], this->U_[j]);
+                std::swap(this->C_[n], this->C_[j]);
+
+                ++n;
+            }
+        }
+
+        this->nrecycle_       = n;
+        this->recycle_update_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::SolveNonPrecond_(
+        const VectorType& rhs, VectorType* x)
+    {
+        log_debug(this, "RecycledGMRES::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        this->SolveRecycled_(rhs, x);
+
+        log_debug(this, "RecycledGMRES::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                           VectorType*       x)
+    {
+        log_debug(this, "RecycledGMRES::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        this->SolveRecycled_(rhs, x);
+
+        log_debug(this, "RecycledGMRES::SolvePrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::SolveRecycled_(const VectorType& rhs,
+                                                                            VectorType*       x)
+    {
+        assert(this->size_basis_ > 0);
+        assert(this->res_norm_type_ == 2);
+
+        const OperatorType* op = this->op_;
+
+        VectorType** v = this->v_;
+
+        // Without preconditioner, the search directions are the Krylov basis itself
+        VectorType** z = (this->precond_ != NULL) ? this->z_ : this->v_;
+
+        ValueType* c = this->c_;
+        ValueType* s = this->s_;
+        ValueType* r = this->r_;
+        ValueType* H = this->H_;
+        ValueType* B = this->B_;
+        ValueType* h = this->h_;
+
+        ValueType one = static_cast<ValueType>(1);
+
+        int size = this->size_basis_;
+        int ldb  = std::max(this->size_recycle_, 1);
+
+        // Bring the recycled subspace up to date with the current operator
+        if(this->recycle_update_ == true)
+        {
+            this->UpdateRecycleSpace_();
+        }
+
+        // Initial residual v_0 = b - Ax
+        op->Apply(*x, v[0]);
+        v[0]->ScaleAdd(-one, rhs);
+
+        // r = 0
+        set_to_zero_host(size + 1, r);
+
+        // r_0 = ||v_0||
+        r[0] = this->Norm_(*v[0]);
+
+        // Initial residual
+        if(this->iter_ctrl_.InitResidual(std::abs(r[0])) == false)
+        {
+            return;
+        }
+
+        // Minimize the initial residual over the recycled subspace
+        if(this->nrecycle_ > 0)
+        {
+            // h = C^H v_0
+            v[0]->MultiDot(this->nrecycle_, this->C_, h);
+
+            // x = x + Uh, v_0 = v_0 - Ch
+            for(int k = 0; k < this->nrecycle_; ++k)
+            {
+                x->AddScale(*this->U_[k], h[k]);
+                v[0]->AddScale(*this->C_[k], -h[k]);
+            }
+
+            r[0] = this->Norm_(*v[0]);
+
+            if(this->iter_ctrl_.CheckResidualNoCount(std::abs(r[0])))
+            {
+                return;
+            }
+        }
+
+        while(true)
+        {
+            ValueType beta = r[0];
+
+            // Normalize v_0
+            v[0]->Scale(one / beta);
+
+            // Arnoldi iteration with the operator (I - CC^H)AM^-1
+            int i = 0;
+            while(i < size)
+            {
+                // Solve Mz_i = v_i
+                if(this->precond_ != NULL)
+                {
+                    this->PrecondSolveZeroSol_(*v[i], z[i]);
+                }
+
+                // v_i+1 = Az_i
+                op->Apply(*z[i], v[i + 1]);
+
+                // Precompute some indices
+                int ii   = DENSE_IND(i, i, size + 1, size);
+                int ip1i = DENSE_IND(i + 1, i, size + 1, size);
+
+                // B_ki = <c_k,v_i+1>, H_ki = <v_k,v_i+1> and H_i+1i = ||v_i+1||
+                H[ip1i] = this->Orthogonalize_(i, v[i + 1], B, H);
+
+                // v_i+1 /= H_i+1i
+                v[i + 1]->Scale(one / H[ip1i]);
+
+                // Apply Givens rotation J(0),...,J(j-1) on (H(0,i),...,H(i,i))
+                for(int k = 0; k < i; ++k)
+                {
+                    int ki   = DENSE_IND(k, i, size + 1, size);
+                    int kp1i = DENSE_IND(k + 1, i, size + 1, size);
+                    this->ApplyGivensRotation_(c[k], s[k], H[ki], H[kp1i]);
+                }
+
+                // Construct J(i)
+                this->GenerateGivensRotation_(H[ii], H[ip1i], c[i], s[i]);
+
+                // Apply J(i) to H(i,i) and H(i,i+1) such that H(i,i+1) = 0
+                this->ApplyGivensRotation_(c[i], s[i], H[ii], H[ip1i]);
+
+                // Apply J(i) to the norm of the residual sg[i]
+                this->ApplyGivensRotation_(c[i], s[i], r[i], r[i + 1]);
+
+                // Check convergence
+                if(this->iter_ctrl_.CheckResidual(std::abs(r[++i])))
+                {
+                    break;
+                }
+            }
+
+            // Solve upper triangular system
+            for(int j = i - 1; j >= 0; --j)
+            {
+                r[j] /= H[DENSE_IND(j, j, size + 1, size)];
+
+                for(int k = 0; k < j; ++k)
+                {
+                    r[k] -= H[DENSE_IND(k, j, size + 1, size)] * r[j];
+                }
+            }
+
+            // Correction of this cycle u = Zy - UBy
+            this->u_.CopyFrom(*z[0]);
+            this->u_.Scale(r[0]);
+
+            for(int j = 1; j < i; ++j)
+            {
+                this->u_.AddScale(*z[j], r[j]);
+            }
+
+            for(int k = 0; k < this->nrecycle_; ++k)
+            {
+                ValueType by = static_cast<ValueType>(0);
+
+                for(int j = 0; j < i; ++j)
+                {
+                    by += B[DENSE_IND(k, j, ldb, size)] * r[j];
+                }
+
+                this->u_.AddScale(*this->U_[k], -by);
+            }
+
+            // Update solution
+            x->AddScale(this->u_, one);
+
+            // Compute residual v_0 = b - Ax
+            op->Apply(*x, v[0]);
+            v[0]->ScaleAdd(-one, rhs);
+
+            // r = 0
+            set_to_zero_host(size + 1, r);
+
+            // r_0 = ||v_0||
+            r[0] = this->Norm_(*v[0]);
+
+            // The residual does not decrease anymore if the attainable accuracy has been
+            // reached, the correction of this cycle is rounding noise then and discarded
+            if(!(std::abs(r[0]) < std::abs(beta)))
+            {
+                x->AddScale(this->u_, -one);
+                this->iter_ctrl_.CheckResidualNoCount(std::abs(beta));
+
+                break;
+            }
+
+            // Add the correction to the recycled subspace, w = Au is computed explicitly
+            // such that C = AU holds to working precision
+            if(this->size_recycle_ > 0)
+            {
+                op->Apply(this->u_, &this->w_);
+
+                this->AppendRecycleSpace_(&this->u_, &this->w_);
+            }
+
+            // Check convergence
+            if(this->iter_ctrl_.CheckResidualNoCount(std::abs(r[0])))
+            {
+                break;
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::GenerateGivensRotation_(ValueType  dx,
+                                                                                     ValueType  dy,
+                                                                                     ValueType& c,
+                                                                                     ValueType& s)
+    {
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        if(dy == zero)
+        {
+            c = one;
+            s = zero;
+        }
+        else if(dx == zero)
+        {
+            c = zero;
+            s = one;
+        }
+        else if(std::abs(dy) > std::abs(dx))
+        {
+            ValueType tmp = dx / dy;
+            s             = one / sqrt(one + tmp * tmp);
+            c             = tmp * s;
+        }
+        else
+        {
+            ValueType tmp = dy / dx;
+            c             = one / sqrt(one + tmp * tmp);
+            s             = tmp * c;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RecycledGMRES<OperatorType, VectorType, ValueType>::ApplyGivensRotation_(ValueType  c,
+                                                                                  ValueType  s,
+                                                                                  ValueType& dx,
+                                                                                  ValueType& dy)
+    {
+        ValueType temp = dx;
+        dx             = rocalution_conj(c) * dx + rocalution_conj(s) * dy;
+        dy             = -s * temp + c * dy;
+    }
+
+    template class RecycledGMRES<LocalMatrix<double>, LocalVector<double>, double>;
+    template class RecycledGMRES<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class RecycledGMRES<LocalMatrix<std::complex<double>>,
+                                 LocalVector<std::complex<double>>,
+                                 std::complex<double>>;
+    template class RecycledGMRES<LocalMatrix<std::complex<float>>,
+                                 LocalVector<std::complex<float>>,
+                                 std::complex<float>>;
+#endif
+
+    template class RecycledGMRES<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class RecycledGMRES<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class RecycledGMRES<GlobalMatrix<std::complex<double>>,
+                                 GlobalVector<std::complex<double>>,
+                                 std::complex<double>>;
+    template class RecycledGMRES<GlobalMatrix<std::complex<float>>,
+                                 GlobalVector<std::complex<float>>,
+                                 std::complex<float>>;
+#endif
+
+    template class RecycledGMRES<LocalStencil<double>, LocalVector<double>, double>;
+    template class RecycledGMRES<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class RecycledGMRES<LocalStencil<std::complex<double>>,
+                                 LocalVector<std::complex<double>>,
+                                 std::complex<double>>;
+    template class RecycledGMRES<LocalStencil<std::complex<float>>,
+                                 LocalVector<std::complex<float>>,
+                                 std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,166 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_RECYCLEDGMRES_HPP_
+#define ROCALUTION_KRYLOV_RECYCLEDGMRES_HPP_
+
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class RecycledGMRES
+  * \brief Generalized Minimum Residual Method with Krylov subspace recycling
+  * \details
+  * The recycled GMRES method is a restarted, flexible GMRES method of GCRO type for
+  * sequences of linear systems \f$A^{(i)}x^{(i)}=b^{(i)}\f$, e.g. from time stepping or
+  * Newton iterations. It maintains a subspace \f$U_{k}\f$ of dimension \f$k\f$ with
+  * \f$C_{k}=AU_{k}\f$ and \f$C_{k}^{H}C_{k}=I\f$, which is kept between subsequent calls
+  * to Solve(). Each solve starts with the projection of the initial residual onto
+  * \f$C_{k}\f$ and generates the Krylov basis with the operator
+  * \f$(I-C_{k}C_{k}^{H})AM^{-1}\f$, such that the solution is minimized over the recycled
+  * and the Krylov subspace. After each restart cycle, the correction of the cycle is
+  * added to the recycled subspace, which keeps the \f$k\f$ most recent corrections. These
+  * approximate the slowly converging error components, which are therefore removed
+  * from the subsequent cycles and solves. \cite gcrot
+  *
+  * If the operator changes between two solves, ResetOperator() or ReBuildNumeric() mark
+  * the recycled subspace to be updated. The update costs \f$k\f$ operator applications
+  * and is carried out at the beginning of the next solve. ClearRecycleSpace() drops the
+  * recycled subspace, e.g. if the next system is unrelated to the previous one. The
+  * iteration stops early if a restart cycle does not reduce the residual anymore, i.e.
+  * when the attainable accuracy has been reached.
+  *
+  * The Krylov subspace basis size can be set using SetBasisSize(). The default size is
+  * 30. The dimension of the recycled subspace can be set using SetRecycleSize(). The
+  * default dimension is 10, zero results in a flexible GMRES method.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class RecycledGMRES : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        RecycledGMRES();
+        ROCALUTION_EXPORT
+        virtual ~RecycledGMRES();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Reset the operator, the recycled subspace is kept and updated in the
+        * next call to Solve() */
+        ROCALUTION_EXPORT
+        virtual void ResetOperator(const OperatorType& op);
+
+        /** \brief Set the size of the Krylov subspace basis */
+        ROCALUTION_EXPORT
+        void SetBasisSize(int size_basis);
+
+        /** \brief Set the maximum dimension of the recycled subspace */
+        ROCALUTION_EXPORT
+        void SetRecycleSize(int size_recycle);
+
+        /** \brief Return the current dimension of the recycled subspace */
+        ROCALUTION_EXPORT
+        int GetRecycleSize(void) const;
+
+        /** \brief Drop the recycled subspace */
+        ROCALUTION_EXPORT
+        void ClearRecycleSpace(void);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+        /** \brief Generate Givens rotation */
+        static void GenerateGivensRotation_(ValueType dx, ValueType dy, ValueType& c, ValueType& s);
+        /** \brief Apply Givens rotation */
+        static void ApplyGivensRotation_(ValueType c, ValueType s, ValueType& dx, ValueType& dy);
+
+    private:
+        // Restarted recycling iteration, with or without preconditioner
+        void SolveRecycled_(const VectorType& rhs, VectorType* x);
+
+        // C = AU for the current operator and re-orthonormalization of C
+        void UpdateRecycleSpace_(void);
+
+        // Orthogonalize w against c_0, ..., c_nrecycle-1 and v_0, ..., v_i, the projections
+        // are added to the columns i of B and H, returns ||w||
+        ValueType Orthogonalize_(int i, VectorType* w, ValueType* B, ValueType* H);
+
+        // Append (u, c) to the recycled subspace, c = Au is orthonormalized against C
+        void AppendRecycleSpace_(VectorType* u, VectorType* c);
+
+        VectorType** v_;
+        VectorType** z_;
+
+        // Recycled subspace, C = AU with orthonormal C
+        VectorType** U_;
+        VectorType** C_;
+
+        VectorType u_;
+        VectorType w_;
+
+        // Hessenberg matrix and projections B = C^H AZ of the Krylov basis
+        ValueType* H_;
+        ValueType* B_;
+
+        ValueType* c_;
+        ValueType* s_;
+        ValueType* r_;
+        ValueType* h_;
+
+        // Dot product buffer of the orthogonalization
+        std::vector<const VectorType*> dot_x_;
+
+        int size_basis_;
+        int size_recycle_;
+        int nrecycle_;
+
+        bool recycle_update_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_RECYCLEDGMRES_HPP_
@@ -0,0 +1,671 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "sketchedgmres.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+#include "../../utils/type_traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <math.h>
+#include <random>
+#include <vector>
+
+namespace rocalution
+{
+
+    // Inner product of two sketched vectors of length n
+    template <typename ValueType>
+    static ValueType sketch_dot(int n, const ValueType* a, const ValueType* b)
+    {
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(int k = 0; k < n; ++k)
+        {
+            sum += rocalution_conj(a[k]) * b[k];
+        }
+
+        return sum;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SketchedGMRES<OperatorType, VectorType, ValueType>::SketchedGMRES()
+    {
+        log_debug(this, "SketchedGMRES::SketchedGMRES()", "default constructor");
+
+        this->size_basis_  = 30;
+        this->size_sketch_ = 0;
+        this->trunc_       = 2;
+
+        this->v_  = NULL;
+        this->SV_ = NULL;
+        this->Q_  = NULL;
+        this->R_  = NULL;
+        this->sr_ = NULL;
+        this->g_  = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SketchedGMRES<OperatorType, VectorType, ValueType>::~SketchedGMRES()
+    {
+        log_debug(this, "SketchedGMRES::~SketchedGMRES()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SketchedGMRES solver");
+        }
+        else
+        {
+            LOG_INFO("SketchedGMRES solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SketchedGMRES(" << this->size_basis_ << "," << this->trunc_
+                                      << ") (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("SketchedGMRES(" << this->size_basis_ << "," << this->trunc_
+                                      << ") solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SketchedGMRES(" << this->size_basis_ << "," << this->trunc_
+                                      << ") (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("SketchedGMRES(" << this->size_basis_ << "," << this->trunc_ << ") ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "SketchedGMRES::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("SketchedGMRES::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() > 0);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->size_basis_ > 0);
+        assert(this->trunc_ > 0);
+
+        if(this->res_norm_type_ != 2)
+        {
+            LOG_INFO("SketchedGMRES solver supports only L2 residual norm. The solver is "
+                     "switching to L2 norm");
+            this->res_norm_type_ = 2;
+        }
+
+        int size = this->size_basis_;
+
+        if(this->size_sketch_ <= 0)
+        {
+            this->size_sketch_ = 4 * (size + 1);
+        }
+
+        int ns = this->size_sketch_;
+
+        allocate_host(ns * (size + 1), &this->SV_);
+        allocate_host(ns * size, &this->Q_);
+        allocate_host(size * size, &this->R_);
+        allocate_host(ns, &this->sr_);
+        allocate_host(size, &this->g_);
+
+        this->v_ = new VectorType*[size + 1];
+
+        for(int i = 0; i < size + 1; ++i)
+        {
+            this->v_[i] = new VectorType;
+            this->v_[i]->CloneBackend(*this->op_);
+            this->v_[i]->Allocate("v", this->op_->GetM());
+        }
+
+        this->z_.CloneBackend(*this->op_);
+        this->z_.Allocate("z", this->op_->GetM());
+
+        // Sparse sign embedding, each local row is hashed into a random bucket with a
+        // random sign, stored as bucket * 2 + sign bit
+        int64_t nrow = this->op_->GetLocalM();
+
+        std::vector<int> map(nrow);
+
+        std::mt19937                       gen(1234567);
+        std::uniform_int_distribution<int> dist(0, 2 * ns - 1);
+
+        for(int64_t i = 0; i < nrow; ++i)
+        {
+            map[i] = dist(gen);
+        }
+
+        this->sketch_map_.CloneBackend(*this->op_);
+        this->sketch_map_.Allocate("sketch map", nrow);
+        this->sketch_map_.CopyFromHostData(map.data());
+
+        this->sketch_work_.CloneBackend(*this->op_);
+        this->sketch_work_.Allocate("sketch work", 2 * ns);
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+            this->precond_->Build();
+        }
+
+        this->build_ = true;
+
+        log_debug(this, "SketchedGMRES::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "SketchedGMRES::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->z_.Clear();
+
+            this->sketch_map_.Clear();
+            this->sketch_work_.Clear();
+
+            free_host(&this->SV_);
+            free_host(&this->Q_);
+            free_host(&this->R_);
+            free_host(&this->sr_);
+            free_host(&this->g_);
+
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->Clear();
+                delete this->v_[i];
+            }
+            delete[] this->v_;
+            this->v_ = NULL;
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "SketchedGMRES::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->Zeros();
+            }
+
+            this->z_.Zeros();
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "SketchedGMRES::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->MoveToHost();
+            }
+
+            this->z_.MoveToHost();
+
+            this->sketch_map_.MoveToHost();
+            this->sketch_work_.MoveToHost();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "SketchedGMRES::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->MoveToAccelerator();
+            }
+
+            this->z_.MoveToAccelerator();
+
+            this->sketch_map_.MoveToAccelerator();
+            this->sketch_work_.MoveToAccelerator();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::SetBasisSize(int size_basis)
+    {
+        log_debug(this, "SketchedGMRES::SetBasisSize()", size_basis);
+
+        assert(size_basis > 0);
+        assert(this->build_ == false);
+
+        this->size_basis_ = size_basis;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::SetTruncation(int trunc)
+    {
+        log_debug(this, "SketchedGMRES::SetTruncation()", trunc);
+
+        assert(trunc > 0);
+        assert(this->build_ == false);
+
+        this->trunc_ = trunc;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::SetSketchSize(int size_sketch)
+    {
+        log_debug(this, "SketchedGMRES::SetSketchSize()", size_sketch);
+
+        assert(size_sketch >= 0);
+        assert(this->build_ == false);
+
+        this->size_sketch_ = size_sketch;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::SolveNonPrecond_(
+        const VectorType& rhs, VectorType* x)
+    {
+        log_debug(this, "SketchedGMRES::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        this->SolveSketched_(rhs, x);
+
+        log_debug(this, "SketchedGMRES::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                           VectorType*       x)
+    {
+        log_debug(this, "SketchedGMRES::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        this->SolveSketched_(rhs, x);
+
+        log_debug(this, "SketchedGMRES::SolvePrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::Residual_(const VectorType& rhs,
+                                                                       const VectorType& x,
+                                                                       VectorType*       res)
+    {
+        ValueType one = static_cast<ValueType>(1);
+
+        if(this->precond_ != NULL)
+        {
+            this->op_->Apply(x, &this->z_);
+            this->z_.ScaleAdd(-one, rhs);
+
+            this->PrecondSolveZeroSol_(this->z_, res);
+        }
+        else
+        {
+            this->op_->Apply(x, res);
+            res->ScaleAdd(-one, rhs);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::ApplyOperator_(const VectorType& in,
+                                                                            VectorType*       out)
+    {
+        if(this->precond_ != NULL)
+        {
+            this->op_->Apply(in, &this->z_);
+            this->PrecondSolveZeroSol_(this->z_, out);
+        }
+        else
+        {
+            this->op_->Apply(in, out);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SketchedGMRES<OperatorType, VectorType, ValueType>::SolveSketched_(const VectorType& rhs,
+                                                                            VectorType*       x)
+    {
+        typedef numeric_traits_t<ValueType> RealType;
+
+        assert(this->size_basis_ > 0);
+        assert(this->res_norm_type_ == 2);
+
+        VectorType** v = this->v_;
+
+        ValueType* SV = this->SV_;
+        ValueType* Q  = this->Q_;
+        ValueType* R  = this->R_;
+        ValueType* sr = this->sr_;
+        ValueType* g  = this->g_;
+
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        int size = this->size_basis_;
+        int ns   = this->size_sketch_;
+
+        // Columns, whose sketch drops below this fraction in the QR update, are dependent
+        RealType tol = ns * std::numeric_limits<RealType>::epsilon();
+
+        // Sketch of the least-squares residual and of the new basis vector
+        std::vector<ValueType> e(ns);
+        std::vector<ValueType> q(ns);
+        std::vector<ValueType> h(this->trunc_);
+
+        // Initial residual
+        this->Residual_(rhs, *x, v[0]);
+        v[0]->Sketch(this->sketch_map_, &this->sketch_work_, sr);
+
+        RealType beta = std::abs(this->Norm_(*v[0]));
+
+        // Initial residual
+        if(this->iter_ctrl_.InitResidual(beta) == false)
+        {
+            return;
+        }
+
+        while(true)
+        {
+            // Normalize v_0 and its sketch
+            v[0]->Scale(one / beta);
+
+            for(int k = 0; k < ns; ++k)
+            {
+                SV[k] = sr[k] / beta;
+                e[k]  = sr[k];
+            }
+
+            int  i    = 0;
+            bool done = false;
+
+            while(i < size && done == false)
+            {
+                ValueType* Qi  = Q + ns * i;
+                ValueType* Ri  = R + size * i;
+                ValueType* SVn = SV + ns * (i + 1);
+
+                // w = M^-1 A v_i and its sketch, the only global reduction of the iteration
+                this->ApplyOperator_(*v[i], v[i + 1]);
+                v[i + 1]->Sketch(this->sketch_map_, &this->sketch_work_, SVn);
+
+                // Append S w to the QR factorization of S M^-1 A V, Gram-Schmidt applied twice
+                std::copy(SVn, SVn + ns, q.begin());
+
+                RealType nrm_w = std::sqrt(std::abs(sketch_dot(ns, q.data(), q.data())));
+
+                set_to_zero_host(size, Ri);
+
+                for(int pass = 0; pass < 2; ++pass)
+                {
+                    for(int l = 0; l < i; ++l)
+                    {
+                        ValueType rl = sketch_dot(ns, Q + ns * l, q.data());
+
+                        for(int k = 0; k < ns; ++k)
+                        {
+                            q[k] -= rl * Q[ns * l + k];
+                        }
+
+                        Ri[l] += rl;
+                    }
+                }
+
+                RealType rii = std::sqrt(std::abs(sketch_dot(ns, q.data(), q.data())));
+
+                // The column is numerically dependent, the current basis is exhausted
+                if(!(rii > tol * nrm_w))
+                {
+                    break;
+                }
+
+                Ri[i] = static_cast<ValueType>(rii);
+
+                for(int k = 0; k < ns; ++k)
+                {
+                    Qi[k] = q[k] / Ri[i];
+                }
+
+                // Least-squares residual in the sketch, e = S r_0 - Q Q^H S r_0
+                g[i] = sketch_dot(ns, Qi, e.data());
+
+                for(int k = 0; k < ns; ++k)
+                {
+                    e[k] -= g[i] * Qi[k];
+                }
+
+                RealType res = std::sqrt(std::abs(sketch_dot(ns, e.data(), e.data())));
+
+                // Truncated orthogonalization of w against v_i-trunc+1, ..., v_i, with the
+                // projection coefficients taken from the sketch
+                int l0 = std::max(0, i - this->trunc_ + 1);
+                int nt = i - l0 + 1;
+
+                std::fill(h.begin(), h.end(), zero);
+
+                for(int pass = 0; pass < 2; ++pass)
+                {
+                    for(int l = 0; l < nt; ++l)
+                    {
+                        const ValueType* SVl = SV + ns * (l0 + l);
+
+                        ValueType hl = sketch_dot(ns, SVl, SVn);
+
+                        for(int k = 0; k < ns; ++k)
+                        {
+                            SVn[k] -= hl * SVl[k];
+                        }
+
+                        h[l] -= hl;
+                    }
+                }
+
+                v[i + 1]->MultiAddScale(nt, v + l0, h.data());
+
+                // Normalize with the sketched norm, no further reduction required
+                RealType hn = std::sqrt(std::abs(sketch_dot(ns, SVn, SVn)));
+
+                ++i;
+
+                // Check convergence
+                if(this->iter_ctrl_.CheckResidual(res))
+                {
+                    done = true;
+                }
+
+                // Invariant subspace
+                if(hn == static_cast<RealType>(0))
+                {
+                    done = true;
+                }
+                else
+                {
+                    v[i]->Scale(one / static_cast<ValueType>(hn));
+
+                    for(int k = 0; k < ns; ++k)
+                    {
+                        SVn[k] /= static_cast<ValueType>(hn);
+                    }
+                }
+            }
+
+            // Solve R y = g
+            for(int j = i - 1; j >= 0; --j)
+            {
+                g[j] /= R[j + size * j];
+
+                for(int k = 0; k < j; ++k)
+                {
+                    g[k] -= R[k + size * j] * g[j];
+                }
+            }
+
+            // Update solution, x = x + V y
+            if(i > 0)
+            {
+                x->MultiAddScale(i, v, g);
+            }
+
+            // Restart with v_0 = M^-1 (b - Ax)
+            this->Residual_(rhs, *x, v[0]);
+            v[0]->Sketch(this->sketch_map_, &this->sketch_work_, sr);
+
+            beta = std::abs(this->Norm_(*v[0]));
+
+            // Check convergence
+            if(this->iter_ctrl_.CheckResidualNoCount(beta))
+            {
+                break;
+            }
+
+            // No progress possible, M^-1 A annihilates the residual
+            if(i == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    template class SketchedGMRES<LocalMatrix<double>, LocalVector<double>, double>;
+    template class SketchedGMRES<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SketchedGMRES<LocalMatrix<std::complex<double>>,
+                                 LocalVector<std::complex<double>>,
+                                 std::complex<double>>;
+    template class SketchedGMRES<LocalMatrix<std::complex<float>>,
+                                 LocalVector<std::complex<float>>,
+                                 std::complex<float>>;
+#endif
+
+    template class SketchedGMRES<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class SketchedGMRES<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SketchedGMRES<GlobalMatrix<std::complex<double>>,
+                                 GlobalVector<std::complex<double>>,
+                                 std::complex<double>>;
+    template class SketchedGMRES<GlobalMatrix<std::complex<float>>,
+                                 GlobalVector<std::complex<float>>,
+                                 std::complex<float>>;
+#endif
+
+    template class SketchedGMRES<LocalStencil<double>, LocalVector<double>, double>;
+    template class SketchedGMRES<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SketchedGMRES<LocalStencil<std::complex<double>>,
+                                 LocalVector<std::complex<double>>,
+                                 std::complex<double>>;
+    template class SketchedGMRES<LocalStencil<std::complex<float>>,
+                                 LocalVector<std::complex<float>>,
+                                 std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,133 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_SKETCHEDGMRES_HPP_
+#define ROCALUTION_KRYLOV_SKETCHEDGMRES_HPP_
+
+#include "../../base/local_vector.hpp"
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class SketchedGMRES
+  * \brief Sketched Generalized Minimum Residual Method
+  * \details
+  * The sketched GMRES method is a variant of the restarted GMRES method, see GMRES, that
+  * replaces the full orthogonalization of the Krylov basis by a random sketch. All vectors
+  * are mapped into a low dimensional space of size \f$s\f$ by a sparse sign embedding
+  * (CountSketch), see LocalVector::Sketch(). Each new basis vector is only orthogonalized
+  * against the last few basis vectors, with projection coefficients taken from the sketch,
+  * and the least-squares problem of the minimum residual solution is solved in the sketch.
+  * Thus, an iteration requires a single global reduction of \f$s\f$ values and the work
+  * on vectors of full length does not grow with the number of iterations, while the
+  * residual is minimized up to the distortion of the embedding. \cite sketchedgmres
+  *
+  * The Krylov subspace basis size can be set using SetBasisSize(). The default size is 30.
+  * The number of previous basis vectors each new vector is orthogonalized against can be
+  * set using SetTruncation(). The default is 2. The sketch size can be set using
+  * SetSketchSize(). By default, four times the basis size is used.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class SketchedGMRES : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        SketchedGMRES();
+        ROCALUTION_EXPORT
+        virtual ~SketchedGMRES();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Set the size of the Krylov subspace basis */
+        ROCALUTION_EXPORT
+        void SetBasisSize(int size_basis);
+
+        /** \brief Set the number of previous basis vectors a new vector is orthogonalized
+      * against
+      */
+        ROCALUTION_EXPORT
+        void SetTruncation(int trunc);
+
+        /** \brief Set the sketch size, 0 selects four times the basis size */
+        ROCALUTION_EXPORT
+        void SetSketchSize(int size_sketch);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        // Restarted sketched iteration, with or without preconditioner
+        void SolveSketched_(const VectorType& rhs, VectorType* x);
+
+        // v_0 = M^-1 (b - Ax)
+        void Residual_(const VectorType& rhs, const VectorType& x, VectorType* res);
+
+        // out = M^-1 A in
+        void ApplyOperator_(const VectorType& in, VectorType* out);
+
+        VectorType** v_;
+        VectorType   z_;
+
+        // Hash map of the embedding and the bucket sums
+        LocalVector<int>       sketch_map_;
+        LocalVector<ValueType> sketch_work_;
+
+        // Sketched basis S V, orthonormal factor Q and triangular factor R of S M^-1 A V
+        ValueType* SV_;
+        ValueType* Q_;
+        ValueType* R_;
+
+        // Sketched residual and its projection onto Q
+        ValueType* sr_;
+        ValueType* g_;
+
+        int size_basis_;
+        int size_sketch_;
+        int trunc_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_SKETCHEDGMRES_HPP_
@@ -0,0 +1,529 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "sqmr.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+#include "../../utils/type_traits.hpp"
+
+#include <complex>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SQMR<OperatorType, VectorType, ValueType>::SQMR()
+    {
+        log_debug(this, "SQMR::SQMR()", "default constructor");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SQMR<OperatorType, VectorType, ValueType>::~SQMR()
+    {
+        log_debug(this, "SQMR::~SQMR()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SQMR<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SQMR solver");
+        }
+        else
+        {
+            LOG_INFO("PSQMR solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SQMR<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SQMR (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("PSQMR solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SQMR<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SQMR (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("PSQMR ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SQMR<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "SQMR::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("SQMR::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+
+            this->precond_->Build();
+
+            this->u_.CloneBackend(*this->op_);
+            this->u_.Allocate("u", this->op_->GetM());
+        }
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", this->op_->GetM());
+
+        this->rq_.CloneBackend(*this->op_);
+        this->rq_.Allocate("rq", this->op_->GetM());
+
+        this->q_.CloneBackend(*this->op_);
+        this->q_.Allocate("q", this->op_->GetM());
+
+        this->t_.CloneBackend(*this->op_);
+        this->t_.Allocate("t", this->op_->GetM());
+
+        this->d_.CloneBackend(*this->op_);
+        this->d_.Allocate("d", this->op_->GetM());
+
+        this->s_.CloneBackend(*this->op_);
+        this->s_.Allocate("s", this->op_->GetM());
+
+        log_debug(this, "SQMR::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SQMR<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "SQMR::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->r_.Clear();
+            this->rq_.Clear();
+            this->q_.Clear();
+            this->t_.Clear();
+            this->u_.Clear();
+            this->d_.Clear();
+            this->s_.Clear();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SQMR<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "SQMR::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.Zeros();
+            this->rq_.Zeros();
+            this->q_.Zeros();
+            this->t_.Zeros();
+            this->u_.Zeros();
+            this->d_.Zeros();
+            this->s_.Zeros();
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SQMR<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "SQMR::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToHost();
+            this->rq_.MoveToHost();
+            this->q_.MoveToHost();
+            this->t_.MoveToHost();
+            this->d_.MoveToHost();
+            this->s_.MoveToHost();
+
+            if(this->precond_ != NULL)
+            {
+                this->u_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SQMR<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "SQMR::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToAccelerator();
+            this->rq_.MoveToAccelerator();
+            this->q_.MoveToAccelerator();
+            this->t_.MoveToAccelerator();
+            this->d_.MoveToAccelerator();
+            this->s_.MoveToAccelerator();
+
+            if(this->precond_ != NULL)
+            {
+                this->u_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    // SQMR implementation is based on the simplified QMR algorithm of Freund and Nachtigal.
+    // The quasi-minimal residual rq is updated explicitly with s = Ad, such that the true
+    // residual norm is monitored without additional operator applications.
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SQMR<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                     VectorType*       x)
+    {
+        log_debug(this, "SQMR::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        typedef numeric_traits_t<ValueType> RealType;
+
+        const OperatorType* op = this->op_;
+
+        VectorType* r  = &this->r_;
+        VectorType* rq = &this->rq_;
+        VectorType* q  = &this->q_;
+        VectorType* t  = &this->t_;
+        VectorType* d  = &this->d_;
+        VectorType* s  = &this->s_;
+
+        const ValueType one  = static_cast<ValueType>(1);
+        const ValueType zero = static_cast<ValueType>(0);
+
+        // Initial residual r = b - Ax
+        op->Apply(*x, r);
+        r->ScaleAdd(-one, rhs);
+
+        RealType tau = std::abs(this->Norm_(*r));
+
+        // use for |b-Ax0|
+        ValueType res_norm = this->ResidualNorm_(*r);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        {
+            log_debug(this, "SQMR::SolveNonPrecond_()", " #*# end");
+
+            return;
+        }
+
+        // rq = r, q = r
+        rq->CopyFrom(*r);
+        q->CopyFrom(*r);
+
+        d->Zeros();
+        s->Zeros();
+
+        RealType  theta = static_cast<RealType>(0);
+        ValueType rho   = r->DotNonConj(*r);
+
+        while(true)
+        {
+            // t = Aq
+            op->Apply(*q, t);
+
+            ValueType sigma = q->DotNonConj(*t);
+
+            if(sigma == zero)
+            {
+                LOG_INFO("SQMR breakdown, (q,Aq) == 0");
+                break;
+            }
+
+            ValueType alpha = rho / sigma;
+
+            // r = r - alpha t
+            r->AddScale(*t, -alpha);
+
+            // Quasi-minimization
+            RealType theta_old = theta;
+
+            theta = std::abs(this->Norm_(*r)) / tau;
+
+            RealType c2 = static_cast<RealType>(1) / (static_cast<RealType>(1) + theta * theta);
+
+            tau = tau * theta * std::sqrt(c2);
+
+            // d = c^2 theta_old^2 d + c^2 alpha q and s = Ad
+            ValueType scale = static_cast<ValueType>(c2 * theta_old * theta_old);
+
+            d->ScaleAddScale(scale, *q, static_cast<ValueType>(c2) * alpha);
+            s->ScaleAddScale(scale, *t, static_cast<ValueType>(c2) * alpha);
+
+            // x = x + d
+            x->AddScale(*d, one);
+
+            // rq = rq - s
+            res_norm = this->AddScaleResidualNorm_(*s, -one, rq);
+
+            if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
+            {
+                break;
+            }
+
+            if(tau == static_cast<RealType>(0))
+            {
+                LOG_INFO("SQMR breakdown, tau == 0");
+                break;
+            }
+
+            if(rho == zero)
+            {
+                LOG_INFO("SQMR breakdown, rho == 0");
+                break;
+            }
+
+            ValueType rho_old = rho;
+
+            rho = r->DotNonConj(*r);
+
+            // q = r + beta q
+            q->ScaleAdd(rho / rho_old, *r);
+        }
+
+        log_debug(this, "SQMR::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SQMR<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                  VectorType*       x)
+    {
+        log_debug(this, "SQMR::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        typedef numeric_traits_t<ValueType> RealType;
+
+        const OperatorType* op = this->op_;
+
+        VectorType* r  = &this->r_;
+        VectorType* rq = &this->rq_;
+        VectorType* q  = &this->q_;
+        VectorType* t  = &this->t_;
+        VectorType* u  = &this->u_;
+        VectorType* d  = &this->d_;
+        VectorType* s  = &this->s_;
+
+        const ValueType one  = static_cast<ValueType>(1);
+        const ValueType zero = static_cast<ValueType>(0);
+
+        // Initial residual r = b - Ax
+        op->Apply(*x, r);
+        r->ScaleAdd(-one, rhs);
+
+        RealType tau = std::abs(this->Norm_(*r));
+
+        // use for |b-Ax0|
+        ValueType res_norm = this->ResidualNorm_(*r);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        {
+            log_debug(this, "SQMR::SolvePrecond_()", " #*# end");
+
+            return;
+        }
+
+        // rq = r
+        rq->CopyFrom(*r);
+
+        // q = M^-1 r
+        this->PrecondSolveZeroSol_(*r, q);
+
+        d->Zeros();
+        s->Zeros();
+
+        RealType  theta = static_cast<RealType>(0);
+        ValueType rho   = r->DotNonConj(*q);
+
+        while(true)
+        {
+            // t = Aq
+            op->Apply(*q, t);
+
+            ValueType sigma = q->DotNonConj(*t);
+
+            if(sigma == zero)
+            {
+                LOG_INFO("SQMR breakdown, (q,Aq) == 0");
+                break;
+            }
+
+            ValueType alpha = rho / sigma;
+
+            // r = r - alpha t
+            r->AddScale(*t, -alpha);
+
+            // Quasi-minimization
+            RealType theta_old = theta;
+
+            theta = std::abs(this->Norm_(*r)) / tau;
+
+            RealType c2 = static_cast<RealType>(1) / (static_cast<RealType>(1) + theta * theta);
+
+            tau = tau * theta * std::sqrt(c2);
+
+            // d = c^2 theta_old^2 d + c^2 alpha q and s = Ad
+            ValueType scale = static_cast<ValueType>(c2 * theta_old * theta_old);
+
+            d->ScaleAddScale(scale, *q, static_cast<ValueType>(c2) * alpha);
+            s->ScaleAddScale(scale, *t, static_cast<ValueType>(c2) * alpha);
+
+            // x = x + d
+            x->AddScale(*d, one);
+
+            // rq = rq - s
+            res_norm = this->AddScaleResidualNorm_(*s, -one, rq);
+
+            if(this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_))
+            {
+                break;
+            }
+
+            if(tau == static_cast<RealType>(0))
+            {
+                LOG_INFO("SQMR breakdown, tau == 0");
+                break;
+            }
+
+            if(rho == zero)
+            {
+                LOG_INFO("SQMR breakdown, rho == 0");
+                break;
+            }
+
+            // u = M^-1 r
+            this->PrecondSolveZeroSol_(*r, u);
+
+            ValueType rho_old = rho;
+
+            rho = r->DotNonConj(*u);
+
+            // q = u + beta q
+            q->ScaleAdd(rho / rho_old, *u);
+        }
+
+        log_debug(this, "SQMR::SolvePrecond_()", " #*# end");
+    }
+
+    template class SQMR<LocalMatrix<double>, LocalVector<double>, double>;
+    template class SQMR<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SQMR<LocalMatrix<std::complex<double>>,
+                        LocalVector<std::complex<double>>,
+                        std::complex<double>>;
+    template class SQMR<LocalMatrix<std::complex<float>>,
+                        LocalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
+    template class SQMR<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class SQMR<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SQMR<GlobalMatrix<std::complex<double>>,
+                        GlobalVector<std::complex<double>>,
+                        std::complex<double>>;
+    template class SQMR<GlobalMatrix<std::complex<float>>,
+                        GlobalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
+    template class SQMR<LocalStencil<double>, LocalVector<double>, double>;
+    template class SQMR<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SQMR<LocalStencil<std::complex<double>>,
+                        LocalVector<std::complex<double>>,
+                        std::complex<double>>;
+    template class SQMR<LocalStencil<std::complex<float>>,
+                        LocalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,724 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "sstepcg.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+#include "../../utils/type_traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SStepCG<OperatorType, VectorType, ValueType>::SStepCG()
+    {
+        log_debug(this, "SStepCG::SStepCG()", "default constructor");
+
+        this->step_   = 4;
+        this->basis_  = NULL;
+        this->nbasis_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SStepCG<OperatorType, VectorType, ValueType>::~SStepCG()
+    {
+        log_debug(this, "SStepCG::~SStepCG()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SStepCG solver");
+        }
+        else
+        {
+            LOG_INFO("SStepCG solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SStepCG(" << this->step_ << ") (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("SStepCG(" << this->step_ << ") solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SStepCG(" << this->step_ << ") (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("SStepCG(" << this->step_ << ") ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::SetStepSize(int step)
+    {
+        log_debug(this, "SStepCG::SetStepSize()", step);
+
+        assert(step > 0);
+        assert(this->build_ == false);
+
+        this->step_ = step;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "SStepCG::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("SStepCG::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+        assert(this->step_ > 0);
+
+        if(this->res_norm_type_ != 2)
+        {
+            LOG_INFO("SStepCG solver supports only L2 residual norm. The solver is switching to "
+                     "L2 norm");
+            this->res_norm_type_ = 2;
+        }
+
+        int s  = this->step_;
+        int nb = 2 * s + 1;
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+            this->precond_->Build();
+
+            this->z_.CloneBackend(*this->op_);
+            this->z_.Allocate("z", this->op_->GetM());
+        }
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("r", this->op_->GetM());
+
+        this->q_.CloneBackend(*this->op_);
+        this->q_.Allocate("q", this->op_->GetM());
+
+        // Preconditioned basis without z, and its image under M without p and r
+        this->nbasis_ = (this->precond_ != NULL) ? 4 * s - 1 : 2 * s;
+        this->basis_  = new VectorType*[this->nbasis_];
+
+        for(int i = 0; i < this->nbasis_; ++i)
+        {
+            this->basis_[i] = new VectorType;
+            this->basis_[i]->CloneBackend(*this->op_);
+            this->basis_[i]->Allocate("y", this->op_->GetM());
+        }
+
+        // Index j is (M^-1 A)^j p for j <= s, index s+1+j is (M^-1 A)^j z
+        this->y_.assign(nb, NULL);
+        this->yh_.assign(nb, NULL);
+
+        int next = 0;
+
+        for(int j = 0; j < nb; ++j)
+        {
+            if(j != s + 1)
+            {
+                this->y_[j] = this->basis_[next++];
+            }
+        }
+
+        this->y_[s + 1] = (this->precond_ != NULL) ? &this->z_ : &this->r_;
+
+        for(int j = 1; j < nb; ++j)
+        {
+            if(this->precond_ == NULL)
+            {
+                this->yh_[j] = this->y_[j];
+            }
+            else if(j != s + 1)
+            {
+                this->yh_[j] = this->basis_[next++];
+            }
+        }
+
+        this->yh_[s + 1] = &this->r_;
+
+        int ndot = 2 * s + ((this->precond_ != NULL) ? 2 : 1) * s * (2 * s + 1);
+
+        this->dot_x_.resize(ndot);
+        this->dot_y_.resize(ndot);
+        this->dot_res_.resize(ndot);
+
+        log_debug(this, "SStepCG::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "SStepCG::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->r_.Clear();
+            this->z_.Clear();
+            this->q_.Clear();
+
+            for(int i = 0; i < this->nbasis_; ++i)
+            {
+                this->basis_[i]->Clear();
+                delete this->basis_[i];
+            }
+            delete[] this->basis_;
+
+            this->basis_  = NULL;
+            this->nbasis_ = 0;
+
+            this->y_.clear();
+            this->yh_.clear();
+
+            this->dot_x_.clear();
+            this->dot_y_.clear();
+            this->dot_res_.clear();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "SStepCG::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.Zeros();
+            this->z_.Zeros();
+            this->q_.Zeros();
+
+            for(int i = 0; i < this->nbasis_; ++i)
+            {
+                this->basis_[i]->Zeros();
+            }
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "SStepCG::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToHost();
+            this->q_.MoveToHost();
+
+            for(int i = 0; i < this->nbasis_; ++i)
+            {
+                this->basis_[i]->MoveToHost();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToHost();
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "SStepCG::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToAccelerator();
+            this->q_.MoveToAccelerator();
+
+            for(int i = 0; i < this->nbasis_; ++i)
+            {
+                this->basis_[i]->MoveToAccelerator();
+            }
+
+            if(this->precond_ != NULL)
+            {
+                this->z_.MoveToAccelerator();
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                        VectorType*       x)
+    {
+        log_debug(this, "SStepCG::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        this->SolveSStep_(rhs, x);
+
+        log_debug(this, "SStepCG::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                     VectorType*       x)
+    {
+        log_debug(this, "SStepCG::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        this->SolveSStep_(rhs, x);
+
+        log_debug(this, "SStepCG::SolvePrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::MatrixPowers_(int       first,
+                                                                     int       length,
+                                                                     ValueType sigma)
+    {
+        ValueType inv_sigma = static_cast<ValueType>(1) / sigma;
+
+        for(int j = first + 1; j < first + length; ++j)
+        {
+            this->op_->Apply(*this->y_[j - 1], this->yh_[j]);
+            this->yh_[j]->Scale(inv_sigma);
+
+            if(this->precond_ != NULL)
+            {
+                this->PrecondSolveZeroSol_(*this->yh_[j], this->y_[j]);
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepCG<OperatorType, VectorType, ValueType>::SolveSStep_(const VectorType& rhs,
+                                                                   VectorType*       x)
+    {
+        typedef numeric_traits_t<ValueType> RealType;
+
+        assert(this->res_norm_type_ == 2);
+
+        int s  = this->step_;
+        int nb = 2 * s + 1;
+
+        VectorType* r = &this->r_;
+        VectorType* z = this->y_[s + 1];
+        VectorType* p = this->y_[0];
+        VectorType* q = &this->q_;
+
+        const VectorType** dot_x   = this->dot_x_.data();
+        const VectorType** dot_y   = this->dot_y_.data();
+        ValueType*         dot_res = this->dot_res_.data();
+
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        // Gram matrices G = Yh^H Y and Gr = Yh^H Yh, row 0 is not used
+        std::vector<ValueType> G(nb * nb);
+        std::vector<ValueType> Gr(nb * nb);
+
+        // Coordinates of x, p and r in the basis, and the shifted p
+        std::vector<ValueType> xc(nb);
+        std::vector<ValueType> pc(nb);
+        std::vector<ValueType> rc(nb);
+        std::vector<ValueType> bp(nb);
+
+        // u^H M v
+        auto quad = [nb](const std::vector<ValueType>& u,
+                         const std::vector<ValueType>& M,
+                         const std::vector<ValueType>& v) -> RealType {
+            ValueType sum = static_cast<ValueType>(0);
+
+            for(int b = 0; b < nb; ++b)
+            {
+                if(v[b] != static_cast<ValueType>(0))
+                {
+                    for(int a = 1; a < nb; ++a)
+                    {
+                        sum += rocalution_conj(u[a]) * M[a + b * nb] * v[b];
+                    }
+                }
+            }
+
+            return std::real(sum);
+        };
+
+        // r = b - Ax
+        this->op_->Apply(*x, r);
+        r->ScaleAdd(-one, rhs);
+
+        ValueType res_norm = this->Norm_(*r);
+
+        if(this->iter_ctrl_.InitResidual(std::abs(res_norm)) == false)
+        {
+            return;
+        }
+
+        // z = M^-1 r
+        if(this->precond_ != NULL)
+        {
+            this->PrecondSolveZeroSol_(*r, z);
+        }
+
+        // p = z
+        p->CopyFrom(*z);
+
+        // Scaling of the monomial basis, adapted from the Gram matrix of the previous step
+        ValueType sigma = one;
+
+        // Explicit residual norm of the last restart
+        RealType restart_res = std::abs(res_norm);
+
+        bool done = false;
+
+        while(done == false)
+        {
+            // Basis of the search direction and the residual
+            this->MatrixPowers_(0, s + 1, sigma);
+            this->MatrixPowers_(s + 1, s, sigma);
+
+            // Gram matrices with a single reduction
+            int ndot = 0;
+
+            for(int a = 1; a < nb; ++a)
+            {
+                dot_x[ndot] = this->yh_[a];
+                dot_y[ndot] = p;
+                ++ndot;
+            }
+
+            for(int b = 1; b < nb; ++b)
+            {
+                for(int a = 1; a <= b; ++a)
+                {
+                    dot_x[ndot] = this->yh_[a];
+                    dot_y[ndot] = this->y_[b];
+                    ++ndot;
+                }
+            }
+
+            if(this->precond_ != NULL)
+            {
+                for(int b = 1; b < nb; ++b)
+                {
+                    for(int a = 1; a <= b; ++a)
+                    {
+                        dot_x[ndot] = this->yh_[a];
+                        dot_y[ndot] = this->yh_[b];
+                        ++ndot;
+                    }
+                }
+            }
+
+            r->DotAsync(ndot, dot_x, dot_y, dot_res);
+            r->DotSync();
+
+            ndot = 0;
+
+            for(int a = 1; a < nb; ++a)
+            {
+                G[a] = dot_res[ndot++];
+            }
+
+            for(int b = 1; b < nb; ++b)
+            {
+                for(int a = 1; a <= b; ++a)
+                {
+                    G[a + b * nb] = dot_res[ndot];
+                    G[b + a * nb] = rocalution_conj(dot_res[ndot]);
+                    ++ndot;
+                }
+            }
+
+            if(this->precond_ != NULL)
+            {
+                for(int b = 1; b < nb; ++b)
+                {
+                    for(int a = 1; a <= b; ++a)
+                    {
+                        Gr[a + b * nb] = dot_res[ndot];
+                        Gr[b + a * nb] = rocalution_conj(dot_res[ndot]);
+                        ++ndot;
+                    }
+                }
+            }
+            else
+            {
+                Gr = G;
+            }
+
+            // x = 0, p = e_0 and r = e_s+1 in the basis
+            std::fill(xc.begin(), xc.end(), zero);
+            std::fill(pc.begin(), pc.end(), zero);
+            std::fill(rc.begin(), rc.end(), zero);
+
+            pc[0]     = one;
+            rc[s + 1] = one;
+
+            RealType rho = quad(rc, G, rc);
+
+            bool breakdown = false;
+
+            // s CG iterations in the coordinates of the basis
+            for(int k = 0; k < s; ++k)
+            {
+                // bp = (M^-1 A / sigma) p
+                std::fill(bp.begin(), bp.end(), zero);
+
+                for(int j = 0; j < s; ++j)
+                {
+                    bp[j + 1] = pc[j];
+                }
+
+                for(int j = 0; j < s - 1; ++j)
+                {
+                    bp[s + 2 + j] = pc[s + 1 + j];
+                }
+
+                // p^H A p = sigma (M bp)^H p
+                RealType pap = std::real(sigma) * quad(bp, G, pc);
+
+                // Both are positive for SPD systems, unless the basis is numerically singular
+                if(!(pap > static_cast<RealType>(0)) || !(rho > static_cast<RealType>(0)))
+                {
+                    breakdown = true;
+                    break;
+                }
+
+                ValueType alpha = static_cast<ValueType>(rho / pap);
+
+                for(int j = 0; j < nb; ++j)
+                {
+                    xc[j] += alpha * pc[j];
+                    rc[j] -= alpha * sigma * bp[j];
+                }
+
+                res_norm = static_cast<ValueType>(
+                    std::sqrt(std::max(quad(rc, Gr, rc), static_cast<RealType>(0))));
+
+                bool conv = this->iter_ctrl_.CheckResidual(std::abs(res_norm), this->index_);
+
+                RealType rho_old = rho;
+                rho              = quad(rc, G, rc);
+
+                ValueType beta = static_cast<ValueType>(rho / rho_old);
+
+                for(int j = 0; j < nb; ++j)
+                {
+                    pc[j] = rc[j] + beta * pc[j];
+                }
+
+                if(conv == true)
+                {
+                    done = true;
+                    break;
+                }
+            }
+
+            // x = x + Y xc
+            for(int j = 0; j < nb; ++j)
+            {
+                if(xc[j] != zero)
+                {
+                    x->AddScale(*this->y_[j], xc[j]);
+                }
+            }
+
+            // p = Y pc
+            q->Zeros();
+
+            for(int j = 0; j < nb; ++j)
+            {
+                if(pc[j] != zero)
+                {
+                    q->AddScale(*this->y_[j], pc[j]);
+                }
+            }
+
+            p->CopyFrom(*q);
+
+            // Adapt the scaling to the growth of the highest powers of M^-1 A applied to p,
+            // which estimates the largest eigenvalue as in the power method
+            if(s > 1)
+            {
+                RealType g0 = std::real(G[(s - 1) + (s - 1) * nb]);
+                RealType g1 = std::real(G[s + s * nb]);
+
+                if(g0 > static_cast<RealType>(0) && g1 > static_cast<RealType>(0))
+                {
+                    sigma *= static_cast<ValueType>(std::sqrt(g1 / g0));
+                }
+            }
+
+            // The residual norm of the coordinates may be inaccurate for ill-conditioned
+            // bases, convergence is confirmed with the explicit residual r = b - Ax
+            bool restart = (done == true || breakdown == true);
+
+            if(restart == true)
+            {
+                this->op_->Apply(*x, r);
+                r->ScaleAdd(-one, rhs);
+
+                res_norm = this->Norm_(*r);
+                done     = this->iter_ctrl_.CheckResidualNoCount(std::abs(res_norm));
+
+                // Stop, if the attainable accuracy of the basis is reached, i.e. the explicit
+                // residual does not decrease anymore between two restarts
+                if(done == true || (done == false && std::abs(res_norm) >= restart_res))
+                {
+                    break;
+                }
+
+                restart_res = std::abs(res_norm);
+            }
+            else
+            {
+                // r = Yh rc, where p is not part of r
+                q->Zeros();
+
+                for(int j = 1; j < nb; ++j)
+                {
+                    if(rc[j] != zero)
+                    {
+                        q->AddScale(*this->yh_[j], rc[j]);
+                    }
+                }
+
+                r->CopyFrom(*q);
+            }
+
+            // z = M^-1 r, a recurrence for z would drift away from r
+            if(this->precond_ != NULL)
+            {
+                this->PrecondSolveZeroSol_(*r, z);
+            }
+
+            // Restart with p = z, the search direction does not match the new residual
+            if(restart == true)
+            {
+                p->CopyFrom(*z);
+            }
+        }
+    }
+
+    template class SStepCG<LocalMatrix<double>, LocalVector<double>, double>;
+    template class SStepCG<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SStepCG<LocalMatrix<std::complex<double>>,
+                           LocalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class SStepCG<LocalMatrix<std::complex<float>>,
+                           LocalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+    template class SStepCG<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class SStepCG<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SStepCG<GlobalMatrix<std::complex<double>>,
+                           GlobalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class SStepCG<GlobalMatrix<std::complex<float>>,
+                           GlobalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+    template class SStepCG<LocalStencil<double>, LocalVector<double>, double>;
+    template class SStepCG<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SStepCG<LocalStencil<std::complex<double>>,
+                           LocalVector<std::complex<double>>,
+                           std::complex<double>>;
+    template class SStepCG<LocalStencil<std::complex<float>>,
+                           LocalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,119 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_SSTEPCG_HPP_
+#define ROCALUTION_KRYLOV_SSTEPCG_HPP_
+
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class SStepCG
+  * \brief s-step (Communication-Avoiding) Conjugate Gradient Method
+  * \details
+  * The s-step Conjugate Gradient method is a reformulation of the (preconditioned)
+  * Conjugate Gradient method for symmetric positive definite (SPD) linear systems
+  * \f$Ax=b\f$. At the beginning of each outer iteration, a basis of the Krylov
+  * subspaces spanned by the search direction and the residual is generated by
+  * \f$2s-1\f$ consecutive applications of the (preconditioned) operator, i.e. a scaled
+  * monomial basis. The Gram matrix of this basis is computed with a single global
+  * reduction, after which \f$s\f$ CG iterations are carried out on the small
+  * coordinate vectors without further communication. The residual is recomputed
+  * explicitly after each outer iteration. \cite cakrylov
+  *
+  * The step size can be set using SetStepSize(). The default step size is 4. Larger
+  * values further reduce the number of global reductions, at the cost of additional
+  * operator applications and a worse conditioned basis, which may delay convergence.
+  * The Gram matrix amplifies rounding errors of the dot products, such that step sizes
+  * above 3 are not recommended in single precision.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class SStepCG : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        SStepCG();
+        ROCALUTION_EXPORT
+        virtual ~SStepCG();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Set the number of CG iterations per global reduction */
+        ROCALUTION_EXPORT
+        void SetStepSize(int step);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        // Outer s-step iteration, with or without preconditioner
+        void SolveSStep_(const VectorType& rhs, VectorType* x);
+
+        // Basis of a matrix powers chain, y_j = (M^-1 A / sigma) y_j-1
+        void MatrixPowers_(int first, int length, ValueType sigma);
+
+        VectorType r_, z_, q_;
+
+        // Basis vectors, owned by the solver
+        VectorType** basis_;
+        int          nbasis_;
+
+        // Basis [p, ..., (M^-1 A)^s p, z, ..., (M^-1 A)^(s-1) z] and its image under M
+        std::vector<VectorType*> y_;
+        std::vector<VectorType*> yh_;
+
+        // Dot product buffers of the Gram matrix reduction
+        std::vector<const VectorType*> dot_x_;
+        std::vector<const VectorType*> dot_y_;
+        std::vector<ValueType>         dot_res_;
+
+        int step_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_SSTEPCG_HPP_
@@ -0,0 +1,889 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "sstepgmres.hpp"
+#include "../../utils/def.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+#include "../../base/matrix_formats_ind.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+#include "../../utils/type_traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <math.h>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SStepGMRES<OperatorType, VectorType, ValueType>::SStepGMRES()
+    {
+        log_debug(this, "SStepGMRES::SStepGMRES()", "default constructor");
+
+        this->size_basis_ = 30;
+        this->step_       = 4;
+
+        this->c_ = NULL;
+        this->s_ = NULL;
+        this->r_ = NULL;
+        this->H_ = NULL;
+        this->T_ = NULL;
+        this->v_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SStepGMRES<OperatorType, VectorType, ValueType>::~SStepGMRES()
+    {
+        log_debug(this, "SStepGMRES::~SStepGMRES()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SStepGMRES solver");
+        }
+        else
+        {
+            LOG_INFO("SStepGMRES solver, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SStepGMRES(" << this->size_basis_ << "," << this->step_
+                                   << ") (non-precond) linear solver starts");
+        }
+        else
+        {
+            LOG_INFO("SStepGMRES(" << this->size_basis_ << "," << this->step_
+                                   << ") solver starts, with preconditioner:");
+            this->precond_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        if(this->precond_ == NULL)
+        {
+            LOG_INFO("SStepGMRES(" << this->size_basis_ << "," << this->step_
+                                   << ") (non-precond) ends");
+        }
+        else
+        {
+            LOG_INFO("SStepGMRES(" << this->size_basis_ << "," << this->step_ << ") ends");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "SStepGMRES::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("SStepGMRES::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() > 0);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->size_basis_ > 0);
+        assert(this->step_ > 0);
+
+        if(this->res_norm_type_ != 2)
+        {
+            LOG_INFO("SStepGMRES solver supports only L2 residual norm. The solver is switching "
+                     "to L2 norm");
+            this->res_norm_type_ = 2;
+        }
+
+        int size = this->size_basis_;
+
+        allocate_host(size, &this->c_);
+        allocate_host(size, &this->s_);
+        allocate_host(size + 1, &this->r_);
+        allocate_host((size + 1) * size, &this->H_);
+        allocate_host((size + 1) * size, &this->T_);
+
+        // Largest block reduction, the projection onto the full basis
+        int ndot = std::max((size + 1) * this->step_, this->step_ * (this->step_ + 1) / 2);
+
+        this->dot_x_.resize(ndot);
+        this->dot_y_.resize(ndot);
+        this->dot_res_.resize(ndot);
+
+        this->v_ = new VectorType*[size + 1];
+
+        for(int i = 0; i < size + 1; ++i)
+        {
+            this->v_[i] = new VectorType;
+            this->v_[i]->CloneBackend(*this->op_);
+            this->v_[i]->Allocate("v", this->op_->GetM());
+        }
+
+        this->z_.CloneBackend(*this->op_);
+        this->z_.Allocate("z", this->op_->GetM());
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetOperator(*this->op_);
+            this->precond_->Build();
+        }
+
+        this->build_ = true;
+
+        log_debug(this, "SStepGMRES::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "SStepGMRES::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->precond_ != NULL)
+            {
+                this->precond_->Clear();
+                this->precond_ = NULL;
+            }
+
+            this->z_.Clear();
+
+            free_host(&this->c_);
+            free_host(&this->s_);
+            free_host(&this->r_);
+            free_host(&this->H_);
+            free_host(&this->T_);
+
+            this->dot_x_.clear();
+            this->dot_y_.clear();
+            this->dot_res_.clear();
+
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->Clear();
+                delete this->v_[i];
+            }
+            delete[] this->v_;
+            this->v_ = NULL;
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "SStepGMRES::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->Zeros();
+            }
+
+            this->z_.Zeros();
+
+            this->iter_ctrl_.Clear();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "SStepGMRES::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->MoveToHost();
+            }
+
+            this->z_.MoveToHost();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "SStepGMRES::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            for(int i = 0; i < this->size_basis_ + 1; ++i)
+            {
+                this->v_[i]->MoveToAccelerator();
+            }
+
+            this->z_.MoveToAccelerator();
+
+            if(this->precond_ != NULL)
+            {
+                this->precond_->MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::SetBasisSize(int size_basis)
+    {
+        log_debug(this, "SStepGMRES::SetBasisSize()", size_basis);
+
+        assert(size_basis > 0);
+        assert(this->build_ == false);
+
+        this->size_basis_ = size_basis;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::SetStepSize(int step)
+    {
+        log_debug(this, "SStepGMRES::SetStepSize()", step);
+
+        assert(step > 0);
+        assert(this->build_ == false);
+
+        this->step_ = step;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                           VectorType*       x)
+    {
+        log_debug(this, "SStepGMRES::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ == NULL);
+        assert(this->build_ == true);
+
+        this->SolveSStep_(rhs, x);
+
+        log_debug(this, "SStepGMRES::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                        VectorType*       x)
+    {
+        log_debug(this, "SStepGMRES::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        this->SolveSStep_(rhs, x);
+
+        log_debug(this, "SStepGMRES::SolvePrecond_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::Residual_(const VectorType& rhs,
+                                                                    const VectorType& x,
+                                                                    VectorType*       res)
+    {
+        ValueType one = static_cast<ValueType>(1);
+
+        if(this->precond_ != NULL)
+        {
+            this->op_->Apply(x, &this->z_);
+            this->z_.ScaleAdd(-one, rhs);
+
+            this->PrecondSolveZeroSol_(this->z_, res);
+        }
+        else
+        {
+            this->op_->Apply(x, res);
+            res->ScaleAdd(-one, rhs);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::ApplyScaled_(const VectorType& in,
+                                                                       ValueType         sigma,
+                                                                       VectorType*       out)
+    {
+        if(this->precond_ != NULL)
+        {
+            this->op_->Apply(in, &this->z_);
+            this->PrecondSolveZeroSol_(this->z_, out);
+        }
+        else
+        {
+            this->op_->Apply(in, out);
+        }
+
+        out->Scale(static_cast<ValueType>(1) / sigma);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int SStepGMRES<OperatorType, VectorType, ValueType>::OrthogonalizeBlock_(int        i,
+                                                                            int        step,
+                                                                            ValueType* C,
+                                                                            ValueType* R)
+    {
+        typedef numeric_traits_t<ValueType> RealType;
+
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        // Vectors, whose norm drops below this fraction in the Cholesky QR, are dependent
+        RealType tol = std::sqrt(std::numeric_limits<RealType>::epsilon());
+
+        int nq = i + 1;
+        int ld = this->step_;
+        int nb = step;
+
+        VectorType** q = this->v_;
+        VectorType** w = this->v_ + nq;
+
+        const VectorType** dot_x   = this->dot_x_.data();
+        const VectorType** dot_y   = this->dot_y_.data();
+        ValueType*         dot_res = this->dot_res_.data();
+
+        std::vector<ValueType> Cp(nq * step);
+        std::vector<ValueType> Rp(ld * ld);
+        std::vector<ValueType> G(ld * ld);
+        std::vector<ValueType> Rn(ld * ld);
+
+        // C = 0 and R = I, the factors are accumulated over both passes
+        std::fill(C, C + nq * step, zero);
+        std::fill(R, R + ld * ld, zero);
+
+        for(int k = 0; k < step; ++k)
+        {
+            R[k + k * ld] = one;
+        }
+
+        for(int pass = 0; pass < 2; ++pass)
+        {
+            // Projections Cp_lk = <q_l,w_k> with a single reduction
+            int ndot = 0;
+
+            for(int k = 0; k < nb; ++k)
+            {
+                for(int l = 0; l < nq; ++l)
+                {
+                    dot_x[ndot] = q[l];
+                    dot_y[ndot] = w[k];
+                    ++ndot;
+                }
+            }
+
+            w[0]->DotAsync(ndot, dot_x, dot_y, Cp.data());
+            w[0]->DotSync();
+
+            // w_k = w_k - sum_l Cp_lk q_l
+            for(int k = 0; k < nb; ++k)
+            {
+                for(int l = 0; l < nq; ++l)
+                {
+                    w[k]->AddScale(*q[l], -Cp[l + k * nq]);
+                }
+            }
+
+            // Gram matrix G_ab = <w_a,w_b>, a <= b, with a single reduction
+            ndot = 0;
+
+            for(int b = 0; b < nb; ++b)
+            {
+                for(int a = 0; a <= b; ++a)
+                {
+                    dot_x[ndot] = w[a];
+                    dot_y[ndot] = w[b];
+                    ++ndot;
+                }
+            }
+
+            w[0]->DotAsync(ndot, dot_x, dot_y, dot_res);
+            w[0]->DotSync();
+
+            ndot = 0;
+
+            for(int b = 0; b < nb; ++b)
+            {
+                for(int a = 0; a <= b; ++a)
+                {
+                    G[a + b * ld] = dot_res[ndot++];
+                }
+            }
+
+            // Cholesky factorization G = Rp^H Rp, up to the first dependent vector
+            int rank = nb;
+
+            std::fill(Rp.begin(), Rp.end(), zero);
+
+            for(int k = 0; k < nb; ++k)
+            {
+                for(int l = 0; l < k; ++l)
+                {
+                    ValueType sum = G[l + k * ld];
+
+                    for(int p = 0; p < l; ++p)
+                    {
+                        sum -= rocalution_conj(Rp[p + l * ld]) * Rp[p + k * ld];
+                    }
+
+                    Rp[l + k * ld] = sum / Rp[l + l * ld];
+                }
+
+                RealType gkk = std::real(G[k + k * ld]);
+                RealType d   = gkk;
+
+                for(int p = 0; p < k; ++p)
+                {
+                    d -= std::abs(Rp[p + k * ld]) * std::abs(Rp[p + k * ld]);
+                }
+
+                if(!(d > tol * gkk))
+                {
+                    rank = k;
+                    break;
+                }
+
+                Rp[k + k * ld] = static_cast<ValueType>(std::sqrt(d));
+            }
+
+            // C = C + Cp R
+            for(int k = 0; k < nb; ++k)
+            {
+                for(int l = 0; l < nq; ++l)
+                {
+                    ValueType sum = zero;
+
+                    for(int p = 0; p <= k; ++p)
+                    {
+                        sum += Cp[l + p * nq] * R[p + k * ld];
+                    }
+
+                    C[l + k * nq] += sum;
+                }
+            }
+
+            // Breakdown, the first vector of the block is already in the span of q
+            if(rank == 0)
+            {
+                return 0;
+            }
+
+            nb = rank;
+
+            // w_k = (w_k - sum_l<k Rp_lk w_l) / Rp_kk, overwriting the block in place
+            for(int k = 0; k < nb; ++k)
+            {
+                for(int l = 0; l < k; ++l)
+                {
+                    w[k]->AddScale(*w[l], -Rp[l + k * ld]);
+                }
+
+                w[k]->Scale(one / Rp[k + k * ld]);
+            }
+
+            // R = Rp R
+            std::fill(Rn.begin(), Rn.end(), zero);
+
+            for(int k = 0; k < nb; ++k)
+            {
+                for(int l = 0; l <= k; ++l)
+                {
+                    for(int p = l; p <= k; ++p)
+                    {
+                        Rn[l + k * ld] += Rp[l + p * ld] * R[p + k * ld];
+                    }
+                }
+            }
+
+            std::copy(Rn.begin(), Rn.end(), R);
+        }
+
+        return nb;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::BuildHessenberg_(
+        int i, int step, ValueType sigma, const ValueType* C, const ValueType* R)
+    {
+        int size = this->size_basis_;
+        int nq   = i + 1;
+        int ld   = this->step_;
+
+        ValueType* H = this->H_;
+
+        // The block satisfies [v_i, w_1, ..., w_step] = [v_0, ..., v_i+step] Rh with
+        // Rh = [e_i, [C; R]], and (M^-1 A / sigma) w_k-1 = w_k with w_0 = v_i
+        auto Rh = [&](int row, int col) -> ValueType {
+            if(col == 0)
+            {
+                return static_cast<ValueType>(row == i ? 1 : 0);
+            }
+
+            if(row < nq)
+            {
+                return C[row + (col - 1) * nq];
+            }
+
+            int l = row - nq;
+
+            return (l <= col - 1) ? R[l + (col - 1) * ld] : static_cast<ValueType>(0);
+        };
+
+        std::vector<ValueType> y(i + step + 1);
+
+        for(int k = 0; k < step; ++k)
+        {
+            int col = i + k;
+
+            // y = sigma Rh(:,k+1) - H(:,0:i-1) Rh(0:i-1,k)
+            for(int row = 0; row <= i + step; ++row)
+            {
+                y[row] = sigma * Rh(row, k + 1);
+            }
+
+            for(int c = 0; c < i; ++c)
+            {
+                ValueType xc = Rh(c, k);
+
+                if(xc != static_cast<ValueType>(0))
+                {
+                    for(int row = 0; row <= c + 1; ++row)
+                    {
+                        y[row] -= H[DENSE_IND(row, c, size + 1, size)] * xc;
+                    }
+                }
+            }
+
+            // Back substitution with the upper triangular part Rh(i:i+step-1,0:step-1)
+            for(int l = 0; l < k; ++l)
+            {
+                ValueType xl = Rh(i + l, k);
+
+                for(int row = 0; row <= i + l + 1; ++row)
+                {
+                    y[row] -= H[DENSE_IND(row, i + l, size + 1, size)] * xl;
+                }
+            }
+
+            ValueType diag = Rh(i + k, k);
+
+            for(int row = 0; row <= size; ++row)
+            {
+                H[DENSE_IND(row, col, size + 1, size)]
+                    = (row <= col + 1) ? y[row] / diag : static_cast<ValueType>(0);
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::SolveSStep_(const VectorType& rhs,
+                                                                      VectorType*       x)
+    {
+        assert(this->size_basis_ > 0);
+        assert(this->res_norm_type_ == 2);
+
+        VectorType** v = this->v_;
+
+        ValueType* c = this->c_;
+        ValueType* s = this->s_;
+        ValueType* r = this->r_;
+        ValueType* H = this->H_;
+        ValueType* T = this->T_;
+
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        int size = this->size_basis_;
+        int step = this->step_;
+
+        std::vector<ValueType> C((size + 1) * step);
+        std::vector<ValueType> R(step * step);
+
+        // Initial residual
+        this->Residual_(rhs, *x, v[0]);
+
+        // r = 0
+        set_to_zero_host(size + 1, r);
+
+        // r_0 = ||v_0||
+        r[0] = this->Norm_(*v[0]);
+
+        // Initial residual
+        if(this->iter_ctrl_.InitResidual(std::abs(r[0])) == false)
+        {
+            return;
+        }
+
+        // Scaling of the monomial basis, estimated by the first operator application
+        ValueType sigma = zero;
+
+        while(true)
+        {
+            // Normalize v_0
+            v[0]->Scale(one / r[0]);
+
+            int  i    = 0;
+            bool done = false;
+
+            while(i < size && done == false)
+            {
+                int nb = std::min(step, size - i);
+
+                // Matrix powers, v_i+k = (M^-1 A / sigma) v_i+k-1
+                for(int k = 1; k <= nb; ++k)
+                {
+                    if(sigma == zero)
+                    {
+                        this->ApplyScaled_(*v[i + k - 1], one, v[i + k]);
+
+                        sigma = this->Norm_(*v[i + k]);
+                        sigma = (sigma == zero) ? one : sigma;
+
+                        v[i + k]->Scale(one / sigma);
+                    }
+                    else
+                    {
+                        this->ApplyScaled_(*v[i + k - 1], sigma, v[i + k]);
+                    }
+                }
+
+                // Block orthogonalization, four reductions for the whole block
+                nb = this->OrthogonalizeBlock_(i, nb, C.data(), R.data());
+
+                // Invariant subspace, add the last column with zero subdiagonal entry
+                bool breakdown = (nb == 0);
+
+                if(breakdown == true)
+                {
+                    R[0] = zero;
+                    nb   = 1;
+                }
+
+                this->BuildHessenberg_(i, nb, sigma, C.data(), R.data());
+
+                double sigma_next = 0.0;
+
+                for(int k = i; k < i + nb; ++k)
+                {
+                    double col_nrm = 0.0;
+
+                    for(int row = 0; row <= k + 1; ++row)
+                    {
+                        int idx = DENSE_IND(row, k, size + 1, size);
+
+                        T[idx] = H[idx];
+                        col_nrm += std::abs(H[idx]) * std::abs(H[idx]);
+                    }
+
+                    sigma_next = std::max(sigma_next, std::sqrt(col_nrm));
+
+                    int kk   = DENSE_IND(k, k, size + 1, size);
+                    int kp1k = DENSE_IND(k + 1, k, size + 1, size);
+
+                    // Apply Givens rotation J(0),...,J(k-1) on (T(0,k),...,T(k,k))
+                    for(int l = 0; l < k; ++l)
+                    {
+                        int lk   = DENSE_IND(l, k, size + 1, size);
+                        int lp1k = DENSE_IND(l + 1, k, size + 1, size);
+                        this->ApplyGivensRotation_(c[l], s[l], T[lk], T[lp1k]);
+                    }
+
+                    // Construct J(k) and apply it such that T(k+1,k) = 0
+                    this->GenerateGivensRotation_(T[kk], T[kp1k], c[k], s[k]);
+                    this->ApplyGivensRotation_(c[k], s[k], T[kk], T[kp1k]);
+                    this->ApplyGivensRotation_(c[k], s[k], r[k], r[k + 1]);
+
+                    // Check convergence
+                    if(this->iter_ctrl_.CheckResidual(std::abs(r[k + 1])))
+                    {
+                        i    = k + 1;
+                        done = true;
+                        break;
+                    }
+                }
+
+                if(done == false)
+                {
+                    i += nb;
+                    done = breakdown;
+                }
+
+                if(sigma_next > 0.0)
+                {
+                    sigma = static_cast<ValueType>(sigma_next);
+                }
+            }
+
+            // Solve upper triangular system
+            for(int j = i - 1; j >= 0; --j)
+            {
+                r[j] /= T[DENSE_IND(j, j, size + 1, size)];
+
+                for(int k = 0; k < j; ++k)
+                {
+                    r[k] -= T[DENSE_IND(k, j, size + 1, size)] * r[j];
+                }
+            }
+
+            // Update solution
+            for(int j = 0; j < i; ++j)
+            {
+                x->AddScale(*v[j], r[j]);
+            }
+
+            // Restart with v_0 = M^-1 (b - Ax)
+            this->Residual_(rhs, *x, v[0]);
+
+            set_to_zero_host(size + 1, r);
+
+            r[0] = this->Norm_(*v[0]);
+
+            // Check convergence
+            if(this->iter_ctrl_.CheckResidualNoCount(std::abs(r[0])))
+            {
+                break;
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::GenerateGivensRotation_(ValueType  dx,
+                                                                                  ValueType  dy,
+                                                                                  ValueType& c,
+                                                                                  ValueType& s)
+    {
+        ValueType zero = static_cast<ValueType>(0);
+        ValueType one  = static_cast<ValueType>(1);
+
+        if(dy == zero)
+        {
+            c = one;
+            s = zero;
+        }
+        else if(dx == zero)
+        {
+            c = zero;
+            s = one;
+        }
+        else if(std::abs(dy) > std::abs(dx))
+        {
+            ValueType tmp = dx / dy;
+            s             = one / sqrt(one + tmp * tmp);
+            c             = tmp * s;
+        }
+        else
+        {
+            ValueType tmp = dy / dx;
+            c             = one / sqrt(one + tmp * tmp);
+            s             = tmp * c;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SStepGMRES<OperatorType, VectorType, ValueType>::ApplyGivensRotation_(ValueType  c,
+                                                                               ValueType  s,
+                                                                               ValueType& dx,
+                                                                               ValueType& dy)
+    {
+        ValueType temp = dx;
+        dx             = rocalution_conj(c) * dx + rocalution_conj(s) * dy;
+        dy             = -s * temp + c * dy;
+    }
+
+    template class SStepGMRES<LocalMatrix<double>, LocalVector<double>, double>;
+    template class SStepGMRES<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SStepGMRES<LocalMatrix<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class SStepGMRES<LocalMatrix<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+    template class SStepGMRES<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class SStepGMRES<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SStepGMRES<GlobalMatrix<std::complex<double>>,
+                              GlobalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class SStepGMRES<GlobalMatrix<std::complex<float>>,
+                              GlobalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+    template class SStepGMRES<LocalStencil<double>, LocalVector<double>, double>;
+    template class SStepGMRES<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SStepGMRES<LocalStencil<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class SStepGMRES<LocalStencil<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+} // namespace rocalution
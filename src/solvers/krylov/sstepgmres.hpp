@@ -0,0 +1,142 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_SSTEPGMRES_HPP_
+#define ROCALUTION_KRYLOV_SSTEPGMRES_HPP_
+
+#include "../solver.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class SStepGMRES
+  * \brief s-step (Communication-Avoiding) Generalized Minimum Residual Method
+  * \details
+  * The s-step GMRES method is a reformulation of the restarted GMRES method, see GMRES,
+  * that generates \f$s\f$ Krylov basis vectors at a time by \f$s\f$ consecutive
+  * applications of the (preconditioned) operator, i.e. a scaled monomial basis. The
+  * block of new basis vectors is orthogonalized against the previous basis by block
+  * classical Gram-Schmidt and against itself by a Cholesky QR factorization of its Gram
+  * matrix. Both steps are repeated once for stability. All dot products of a step are
+  * merged into a single global reduction, such that a block of \f$s\f$ iterations
+  * requires four global synchronizations, independent of \f$s\f$. The Hessenberg matrix
+  * of the Arnoldi relation is recovered from the triangular factors, and the solution is
+  * computed as in GMRES. \cite cakrylov
+  *
+  * The step size can be set using SetStepSize(). The default step size is 4, larger
+  * values further reduce the number of global reductions at the cost of a worse
+  * conditioned basis. If the basis turns out to be numerically rank deficient, the
+  * block is truncated automatically. The Krylov subspace basis size can be set using
+  * SetBasisSize(). The default size is 30.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class SStepGMRES : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        SStepGMRES();
+        ROCALUTION_EXPORT
+        virtual ~SStepGMRES();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Set the size of the Krylov subspace basis */
+        ROCALUTION_EXPORT
+        void SetBasisSize(int size_basis);
+
+        /** \brief Set the number of basis vectors generated per block */
+        ROCALUTION_EXPORT
+        void SetStepSize(int step);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+        virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+        /** \brief Generate Givens rotation */
+        static void GenerateGivensRotation_(ValueType dx, ValueType dy, ValueType& c, ValueType& s);
+        /** \brief Apply Givens rotation */
+        static void ApplyGivensRotation_(ValueType c, ValueType s, ValueType& dx, ValueType& dy);
+
+    private:
+        // Restarted s-step iteration, with or without preconditioner
+        void SolveSStep_(const VectorType& rhs, VectorType* x);
+
+        // v_0 = M^-1 (b - Ax)
+        void Residual_(const VectorType& rhs, const VectorType& x, VectorType* res);
+
+        // out = M^-1 A in / sigma
+        void ApplyScaled_(const VectorType& in, ValueType sigma, VectorType* out);
+
+        // Orthogonalize v_i+1, ..., v_i+step against v_0, ..., v_i and among each other,
+        // returns the number of numerically independent vectors
+        int OrthogonalizeBlock_(int i, int step, ValueType* C, ValueType* R);
+
+        // Columns i, ..., i+step-1 of the Hessenberg matrix from the block factors
+        void BuildHessenberg_(
+            int i, int step, ValueType sigma, const ValueType* C, const ValueType* R);
+
+        VectorType** v_;
+        VectorType   z_;
+
+        // Hessenberg matrix and its Givens rotated copy
+        ValueType* H_;
+        ValueType* T_;
+
+        ValueType* c_;
+        ValueType* s_;
+        ValueType* r_;
+
+        // Dot product buffers of the block reductions
+        std::vector<const VectorType*> dot_x_;
+        std::vector<const VectorType*> dot_y_;
+        std::vector<ValueType>         dot_res_;
+
+        int size_basis_;
+        int step_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_SSTEPGMRES_HPP_
@@ -168,6 +168,8 @@ namespace rocalution
     {
         log_debug(this, "MixedPrecisionDC::Build()", " #*# begin");
 
+        ROCALUTION_RANGE("MixedPrecisionDC::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -467,4 +469,788 @@ namespace rocalution
                                     LocalVector<float>,
                                     float>;
 
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::MixedPrecisionPreconditioner()
+    {
+        log_debug(this, "MixedPrecisionPreconditioner::MixedPrecisionPreconditioner()");
+
+        this->op_l_     = NULL;
+        this->Solver_L_ = NULL;
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::~MixedPrecisionPreconditioner()
+    {
+        log_debug(this, "MixedPrecisionPreconditioner::~MixedPrecisionPreconditioner()");
+
+        this->Clear();
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::Set(
+        Solver<OperatorTypeL, VectorTypeL, ValueTypeL>& Solver_L)
+    {
+        log_debug(this, "MixedPrecisionPreconditioner::Set()", (const void*&)Solver_L);
+
+        this->Solver_L_ = &Solver_L;
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::Print(void) const
+    {
+        if(this->Solver_L_ == NULL)
+        {
+            LOG_INFO("MixedPrecisionPreconditioner");
+        }
+        else
+        {
+            LOG_INFO("MixedPrecisionPreconditioner [" << 8 * sizeof(ValueTypeH) << "bit-"
+                                                      << 8 * sizeof(ValueTypeL)
+                                                      << "bit], with solver:");
+            this->Solver_L_->Print();
+        }
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::CopyOperator_(void)
+    {
+        assert(this->op_ != NULL);
+        assert(this->op_l_ != NULL);
+
+        // Host CSR copy of the operator, whose arrays are taken over by op_l_
+        OperatorTypeH tmp;
+        tmp.CloneFrom(*this->op_);
+        tmp.MoveToHost();
+        tmp.ConvertToCSR();
+
+        int64_t m   = tmp.GetM();
+        int64_t n   = tmp.GetN();
+        int64_t nnz = tmp.GetNnz();
+
+        PtrType*    row_offset = NULL;
+        int*        col        = NULL;
+        ValueTypeH* val_h      = NULL;
+        ValueTypeL* val_l      = NULL;
+
+        tmp.LeaveDataPtrCSR(&row_offset, &col, &val_h);
+
+        allocate_host(nnz, &val_l);
+
+        for(int64_t i = 0; i < nnz; ++i)
+        {
+            val_l[i] = static_cast<ValueTypeL>(val_h[i]);
+        }
+
+        free_host(&val_h);
+
+        this->op_l_->MoveToHost();
+        this->op_l_->SetDataPtrCSR(&row_offset, &col, &val_l, "Low prec Matrix", nnz, m, n);
+
+        // The inner solver is built on the backend of the operator
+        this->op_l_->CloneBackend(*this->op_);
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::Build(void)
+    {
+        log_debug(this, "MixedPrecisionPreconditioner::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("MixedPrecisionPreconditioner::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->Solver_L_ != NULL);
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+
+        assert(this->op_l_ == NULL);
+        this->op_l_ = new OperatorTypeL;
+
+        this->CopyOperator_();
+
+        this->r_l_.CloneBackend(*this->op_l_);
+        this->z_l_.CloneBackend(*this->op_l_);
+
+        this->r_l_.Allocate("r_l", this->op_l_->GetM());
+        this->z_l_.Allocate("z_l", this->op_l_->GetN());
+
+        this->Solver_L_->SetOperator(*this->op_l_);
+        this->Solver_L_->Build();
+
+        log_debug(this, "MixedPrecisionPreconditioner::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::ReBuildNumeric(void)
+    {
+        log_debug(this, "MixedPrecisionPreconditioner::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->CopyOperator_();
+
+            this->Solver_L_->ResetOperator(*this->op_l_);
+            this->Solver_L_->ReBuildNumeric();
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::Clear(void)
+    {
+        log_debug(this, "MixedPrecisionPreconditioner::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            assert(this->Solver_L_ != NULL);
+            this->Solver_L_->Clear();
+
+            if(this->op_l_ != NULL)
+            {
+                delete this->op_l_;
+                this->op_l_ = NULL;
+            }
+
+            this->r_l_.Clear();
+            this->z_l_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::Solve(const VectorTypeH& rhs,
+                                                             VectorTypeH*       x)
+    {
+        log_debug(this, "MixedPrecisionPreconditioner::Solve()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+        assert(x != &rhs);
+
+        // The current x is the initial guess of the inner solver
+        this->r_l_.CopyFromDouble(rhs);
+        this->z_l_.CopyFromDouble(*x);
+
+        this->Solver_L_->Solve(this->r_l_, &this->z_l_);
+
+        x->CopyFromFloat(this->z_l_);
+
+        log_debug(this, "MixedPrecisionPreconditioner::Solve()", " #*# end");
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::SolveZeroSol(
+        const VectorTypeH& rhs, VectorTypeH* x)
+    {
+        log_debug(
+            this, "MixedPrecisionPreconditioner::SolveZeroSol()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+        assert(x != &rhs);
+
+        this->r_l_.CopyFromDouble(rhs);
+
+        this->Solver_L_->SolveZeroSol(this->r_l_, &this->z_l_);
+
+        x->CopyFromFloat(this->z_l_);
+
+        log_debug(this, "MixedPrecisionPreconditioner::SolveZeroSol()", " #*# end");
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "MixedPrecisionPreconditioner::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->op_l_->MoveToHost();
+            this->r_l_.MoveToHost();
+            this->z_l_.MoveToHost();
+
+            this->Solver_L_->MoveToHost();
+        }
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionPreconditioner<OperatorTypeH,
+                                 VectorTypeH,
+                                 ValueTypeH,
+                                 OperatorTypeL,
+                                 VectorTypeL,
+                                 ValueTypeL>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "MixedPrecisionPreconditioner::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->op_l_->MoveToAccelerator();
+            this->r_l_.MoveToAccelerator();
+            this->z_l_.MoveToAccelerator();
+
+            this->Solver_L_->MoveToAccelerator();
+        }
+    }
+
+    template class MixedPrecisionPreconditioner<LocalMatrix<double>,
+                                                LocalVector<double>,
+                                                double,
+                                                LocalMatrix<float>,
+                                                LocalVector<float>,
+                                                float>;
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    MixedPrecisionIR<OperatorTypeH,
+                     VectorTypeH,
+                     ValueTypeH,
+                     OperatorTypeL,
+                     VectorTypeL,
+                     ValueTypeL>::MixedPrecisionIR()
+    {
+        log_debug(this, "MixedPrecisionIR::MixedPrecisionIR()");
+
+        this->factorization_  = NULL;
+        this->gmres_max_iter_ = 0;
+        this->gmres_rel_tol_  = 1e-4;
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    MixedPrecisionIR<OperatorTypeH,
+                     VectorTypeH,
+                     ValueTypeH,
+                     OperatorTypeL,
+                     VectorTypeL,
+                     ValueTypeL>::~MixedPrecisionIR()
+    {
+        log_debug(this, "MixedPrecisionIR::~MixedPrecisionIR()");
+
+        this->Clear();
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::Set(Solver<OperatorTypeL, VectorTypeL, ValueTypeL>&
+                                               factorization)
+    {
+        log_debug(this, "MixedPrecisionIR::Set()", (const void*&)factorization);
+
+        assert(this->build_ == false);
+
+        this->factorization_ = &factorization;
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::SetGMRES(int max_iter, double rel_tol)
+    {
+        log_debug(this, "MixedPrecisionIR::SetGMRES()", max_iter, rel_tol);
+
+        assert(max_iter >= 0);
+        assert(rel_tol >= 0.0);
+        assert(this->build_ == false);
+
+        this->gmres_max_iter_ = max_iter;
+        this->gmres_rel_tol_  = rel_tol;
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::Print(void) const
+    {
+        if(this->factorization_ == NULL)
+        {
+            LOG_INFO("MixedPrecisionIR solver");
+        }
+        else
+        {
+            LOG_INFO("MixedPrecisionIR solver, with factorization:");
+            this->factorization_->Print();
+        }
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::PrintStart_(void) const
+    {
+        assert(this->factorization_ != NULL);
+
+        if(this->gmres_max_iter_ > 0)
+        {
+            LOG_INFO("MixedPrecisionIR [" << 8 * sizeof(ValueTypeH) << "bit-"
+                                          << 8 * sizeof(ValueTypeL)
+                                          << "bit] solver starts, with GMRES("
+                                          << this->gmres_max_iter_ << ") and factorization:");
+        }
+        else
+        {
+            LOG_INFO("MixedPrecisionIR [" << 8 * sizeof(ValueTypeH) << "bit-"
+                                          << 8 * sizeof(ValueTypeL)
+                                          << "bit] solver starts, with factorization:");
+        }
+
+        this->factorization_->Print();
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::PrintEnd_(void) const
+    {
+        LOG_INFO("MixedPrecisionIR ends");
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::Build(void)
+    {
+        log_debug(this, "MixedPrecisionIR::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("MixedPrecisionIR::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->factorization_ != NULL);
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+        assert(this->op_->GetM() > 0);
+
+        this->precond_l_.Set(*this->factorization_);
+
+        if(this->gmres_max_iter_ > 0)
+        {
+            // GMRES builds the preconditioner, a single cycle per correction
+            this->gmres_.SetOperator(*this->op_);
+            this->gmres_.SetPreconditioner(this->precond_l_);
+            this->gmres_.SetBasisSize(this->gmres_max_iter_);
+            this->gmres_.Init(0.0, this->gmres_rel_tol_, 1e+8, this->gmres_max_iter_);
+            this->gmres_.Verbose(0);
+            this->gmres_.Build();
+        }
+        else
+        {
+            this->precond_l_.SetOperator(*this->op_);
+            this->precond_l_.Build();
+        }
+
+        this->r_.CloneBackend(*this->op_);
+        this->d_.CloneBackend(*this->op_);
+
+        this->r_.Allocate("r", this->op_->GetM());
+        this->d_.Allocate("d", this->op_->GetM());
+
+        log_debug(this, "MixedPrecisionIR::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::ReBuildNumeric(void)
+    {
+        log_debug(this, "MixedPrecisionIR::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.Zeros();
+            this->d_.Zeros();
+
+            this->iter_ctrl_.Clear();
+
+            if(this->gmres_max_iter_ > 0)
+            {
+                this->gmres_.ReBuildNumeric();
+            }
+            else
+            {
+                this->precond_l_.ReBuildNumeric();
+            }
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::Clear(void)
+    {
+        log_debug(this, "MixedPrecisionIR::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            // GMRES also clears its preconditioner
+            this->gmres_.Clear();
+            this->precond_l_.Clear();
+
+            this->factorization_ = NULL;
+
+            this->r_.Clear();
+            this->d_.Clear();
+
+            this->iter_ctrl_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "MixedPrecisionIR::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToHost();
+            this->d_.MoveToHost();
+
+            if(this->gmres_max_iter_ > 0)
+            {
+                this->gmres_.MoveToHost();
+            }
+            else
+            {
+                this->precond_l_.MoveToHost();
+            }
+        }
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "MixedPrecisionIR::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->r_.MoveToAccelerator();
+            this->d_.MoveToAccelerator();
+
+            if(this->gmres_max_iter_ > 0)
+            {
+                this->gmres_.MoveToAccelerator();
+            }
+            else
+            {
+                this->precond_l_.MoveToAccelerator();
+            }
+        }
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::SolveNonPrecond_(const VectorTypeH& rhs, VectorTypeH* x)
+    {
+        log_debug(this, "MixedPrecisionIR::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+
+        // initial residual = b - Ax
+        this->op_->Apply(*x, &this->r_);
+        this->r_.ScaleAdd(static_cast<ValueTypeH>(-1), rhs);
+
+        ValueTypeH res = this->Norm_(this->r_);
+
+        if(this->iter_ctrl_.InitResidual(res) == false)
+        {
+            log_debug(this, "MixedPrecisionIR::SolveNonPrecond_()", " #*# end");
+            return;
+        }
+
+        while(!this->iter_ctrl_.CheckResidual(res, this->index_))
+        {
+            // correction d = A^-1 r, using the lower precision factorization
+            if(this->gmres_max_iter_ > 0)
+            {
+                this->d_.Zeros();
+                this->gmres_.Solve(this->r_, &this->d_);
+            }
+            else
+            {
+                this->precond_l_.SolveZeroSol(this->r_, &this->d_);
+            }
+
+            x->AddScale(this->d_, static_cast<ValueTypeH>(1));
+
+            // r = b - Ax
+            this->op_->Apply(*x, &this->r_);
+            this->r_.ScaleAdd(static_cast<ValueTypeH>(-1), rhs);
+            res = this->Norm_(this->r_);
+        }
+
+        log_debug(this, "MixedPrecisionIR::SolveNonPrecond_()", " #*# end");
+    }
+
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    void MixedPrecisionIR<OperatorTypeH,
+                          VectorTypeH,
+                          ValueTypeH,
+                          OperatorTypeL,
+                          VectorTypeL,
+                          ValueTypeL>::SolvePrecond_(const VectorTypeH& rhs, VectorTypeH* x)
+    {
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+
+        LOG_INFO("MixedPrecisionIR solver does not work with preconditioner. The factorization set "
+                 "with Set() is its preconditioner");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template class MixedPrecisionIR<LocalMatrix<double>,
+                                    LocalVector<double>,
+                                    double,
+                                    LocalMatrix<float>,
+                                    LocalVector<float>,
+                                    float>;
+
 } // namespace rocalution
@@ -24,6 +24,8 @@
 #ifndef ROCALUTION_MIXED_PRECISION_HPP_
 #define ROCALUTION_MIXED_PRECISION_HPP_
 
+#include "krylov/gmres.hpp"
+#include "preconditioners/preconditioner.hpp"
 #include "rocalution/export.hpp"
 #include "solver.hpp"
 
@@ -105,6 +107,206 @@ namespace rocalution
         OperatorTypeL*       op_l_;
     };
 
+    /** \ingroup precond_module
+  * \class MixedPrecisionPreconditioner
+  * \brief Mixed-Precision Preconditioner
+  * \details
+  * The Mixed-Precision preconditioner applies a lower precision solver, such as an AMG
+  * hierarchy, as preconditioner of a higher precision iterative solver. The operator of
+  * the outer solver is rounded to the lower precision when the preconditioner is built,
+  * and the inner solver builds all of its data (e.g. the multigrid hierarchy) from this
+  * copy. In each application, the residual is converted to the lower precision, the
+  * inner solver is applied and the correction is converted back. Conversions are
+  * performed on the backend of the outer solver, such that no data is transferred
+  * between host and accelerator.
+  *
+  * The inner solver is usually configured to perform a single cycle, e.g.
+  * \code{.cpp}
+  *   SAAMG<LocalMatrix<float>, LocalVector<float>, float> amg;
+  *   amg.InitMaxIter(1);
+  *   amg.Verbose(0);
+  *
+  *   MixedPrecisionPreconditioner<LocalMatrix<double>,
+  *                                LocalVector<double>,
+  *                                double,
+  *                                LocalMatrix<float>,
+  *                                LocalVector<float>,
+  *                                float> p;
+  *   p.Set(amg);
+  *
+  *   CG<LocalMatrix<double>, LocalVector<double>, double> cg;
+  *   cg.SetOperator(mat);
+  *   cg.SetPreconditioner(p);
+  *   cg.Build();
+  * \endcode
+  *
+  * \tparam OperatorTypeH - can be LocalMatrix
+  * \tparam VectorTypeH - can be LocalVector
+  * \tparam ValueTypeH - can be double
+  * \tparam OperatorTypeL - can be LocalMatrix
+  * \tparam VectorTypeL - can be LocalVector
+  * \tparam ValueTypeL - can be float
+  */
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    class MixedPrecisionPreconditioner : public Preconditioner<OperatorTypeH, VectorTypeH, ValueTypeH>
+    {
+    public:
+        ROCALUTION_EXPORT
+        MixedPrecisionPreconditioner();
+        ROCALUTION_EXPORT
+        virtual ~MixedPrecisionPreconditioner();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Set the lower precision solver that is applied as preconditioner */
+        ROCALUTION_EXPORT
+        void Set(Solver<OperatorTypeL, VectorTypeL, ValueTypeL>& Solver_L);
+
+        ROCALUTION_EXPORT
+        virtual void Solve(const VectorTypeH& rhs, VectorTypeH* x);
+        ROCALUTION_EXPORT
+        virtual void SolveZeroSol(const VectorTypeH& rhs, VectorTypeH* x);
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        // Round the values of the operator into op_l_, on the backend of the operator
+        void CopyOperator_(void);
+
+        Solver<OperatorTypeL, VectorTypeL, ValueTypeL>* Solver_L_;
+
+        OperatorTypeL* op_l_;
+
+        VectorTypeL r_l_;
+        VectorTypeL z_l_;
+    };
+
+    /** \ingroup solver_module
+  * \class MixedPrecisionIR
+  * \brief Mixed-Precision Iterative Refinement
+  * \details
+  * Iterative refinement with a lower precision factorization, such as LU, ILU or IC. The
+  * scheme
+  * \f[
+  *   x_{k+1} = x_{k} + d_{k}, \quad d_{k} \approx A^{-1} r_{k}, \quad r_{k} = b - Ax_{k},
+  * \f]
+  * computes the residuals and the updates in the higher precision, on the backend of the
+  * operator. The factorization is built from a copy of the operator rounded to the lower
+  * precision (see MixedPrecisionPreconditioner), which halves its cost and memory. The
+  * correction \f$d_{k}\f$ is either a single application of the factorization, or, with
+  * SetGMRES(), the result of a GMRES solve of \f$Ad_{k} = r_{k}\f$ in the higher
+  * precision, preconditioned by the factorization (GMRES-IR). GMRES-IR still converges
+  * when the factorization alone is not accurate enough for classical refinement, e.g.
+  * for incomplete factorizations or more ill-conditioned systems.
+  *
+  * \code{.cpp}
+  *   ILU<LocalMatrix<float>, LocalVector<float>, float> ilu;
+  *
+  *   MixedPrecisionIR<LocalMatrix<double>,
+  *                    LocalVector<double>,
+  *                    double,
+  *                    LocalMatrix<float>,
+  *                    LocalVector<float>,
+  *                    float> ls;
+  *   ls.SetOperator(mat);
+  *   ls.Set(ilu);
+  *   ls.SetGMRES(20);
+  *   ls.Init(1e-12, 1e-10, 1e+8, 100);
+  *   ls.Build();
+  *   ls.Solve(rhs, &x);
+  * \endcode
+  *
+  * \tparam OperatorTypeH - can be LocalMatrix
+  * \tparam VectorTypeH - can be LocalVector
+  * \tparam ValueTypeH - can be double
+  * \tparam OperatorTypeL - can be LocalMatrix
+  * \tparam VectorTypeL - can be LocalVector
+  * \tparam ValueTypeL - can be float
+  */
+    template <class OperatorTypeH,
+              class VectorTypeH,
+              typename ValueTypeH,
+              class OperatorTypeL,
+              class VectorTypeL,
+              typename ValueTypeL>
+    class MixedPrecisionIR : public IterativeLinearSolver<OperatorTypeH, VectorTypeH, ValueTypeH>
+    {
+    public:
+        ROCALUTION_EXPORT
+        MixedPrecisionIR();
+        ROCALUTION_EXPORT
+        virtual ~MixedPrecisionIR();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Set the lower precision factorization that computes the corrections */
+        ROCALUTION_EXPORT
+        void Set(Solver<OperatorTypeL, VectorTypeL, ValueTypeL>& factorization);
+
+        /** \brief Compute the corrections with GMRES (GMRES-IR)
+        * \details
+        * Each correction is computed by at most \p max_iter GMRES iterations in the higher
+        * precision, which stop when the residual of the correction equation is reduced
+        * by \p rel_tol. \p max_iter = 0 applies the factorization once per step (classical
+        * iterative refinement, default).
+        */
+        ROCALUTION_EXPORT
+        void SetGMRES(int max_iter, double rel_tol = 1e-4);
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void SolveNonPrecond_(const VectorTypeH& rhs, VectorTypeH* x);
+        virtual void SolvePrecond_(const VectorTypeH& rhs, VectorTypeH* x);
+
+        virtual void PrintStart_(void) const;
+        virtual void PrintEnd_(void) const;
+
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        Solver<OperatorTypeL, VectorTypeL, ValueTypeL>* factorization_;
+
+        // Lower precision copy of the operator and the factorization
+        MixedPrecisionPreconditioner<OperatorTypeH,
+                                     VectorTypeH,
+                                     ValueTypeH,
+                                     OperatorTypeL,
+                                     VectorTypeL,
+                                     ValueTypeL>
+            precond_l_;
+
+        // Inner solver of GMRES-IR
+        GMRES<OperatorTypeH, VectorTypeH, ValueTypeH> gmres_;
+        int                                           gmres_max_iter_;
+        double                                        gmres_rel_tol_;
+
+        VectorTypeH r_;
+        VectorTypeH d_;
+    };
+
 } // namespace rocalution
 
 #endif // ROCALUTION_MIXED_PRECISION_HPP_
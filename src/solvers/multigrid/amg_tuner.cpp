@@ -0,0 +1,484 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "amg_tuner.hpp"
+#include "../../utils/def.hpp"
+
+#include "ruge_stueben_amg.hpp"
+#include "smoothed_amg.hpp"
+#include "unsmoothed_amg.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/time_functions.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace rocalution
+{
+    static const char* amg_tuning_name(AMGTuningType amg)
+    {
+        switch(amg)
+        {
+        case TuneSAAMG:
+            return "SAAMG";
+        case TuneUAAMG:
+            return "UAAMG";
+        case TuneRSAMG:
+            return "RSAMG";
+        }
+
+        return "unknown";
+    }
+
+    static const char* cycle_name(unsigned int cycle)
+    {
+        switch(cycle)
+        {
+        case Vcycle:
+            return "V";
+        case Wcycle:
+            return "W";
+        case Kcycle:
+            return "K";
+        case Fcycle:
+            return "F";
+        case Acycle:
+            return "A";
+        }
+
+        return "unknown";
+    }
+
+    static void print_config(const AMGTuningConfig& config)
+    {
+        LOG_INFO(amg_tuning_name(config.amg)
+                 << " eps=" << config.coupling_strength
+                 << " coarsening=" << (config.coarsening == Greedy ? "Greedy" : "PMIS")
+                 << " smoother=" << (config.smoother == JacobiSmoother ? "Jacobi" : "Chebyshev")
+                 << " sweeps=" << config.sweeps << " cycle=" << cycle_name(config.cycle)
+                 << " coarsest=" << config.coarsest_level << " setup=" << config.setup_time
+                 << "s solve=" << config.solve_time << "s iter=" << config.iter
+                 << (config.converged ? "" : (config.pruned ? " (pruned)" : " (no convergence)")));
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    AMGTuner<OperatorType, VectorType, ValueType>::AMGTuner()
+    {
+        log_debug(this, "AMGTuner::AMGTuner()", "default constructor");
+
+        this->solver_ = NULL;
+
+        this->abs_tol_  = 1e-15;
+        this->rel_tol_  = 1e-6;
+        this->div_tol_  = 1e+8;
+        this->max_iter_ = 1000;
+
+        this->verb_ = 1;
+
+        this->types_      = {TuneSAAMG, TuneUAAMG, TuneRSAMG};
+        this->coupling_   = {0.001, 0.01, 0.08};
+        this->threshold_  = {0.25, 0.5};
+        this->coarsening_ = {Greedy, PMIS};
+        this->smoothers_  = {JacobiSmoother, ChebyshevSmoother};
+        this->sweeps_     = {1, 2};
+        this->cycles_     = {Vcycle, Kcycle};
+        this->coarsest_   = {300};
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    AMGTuner<OperatorType, VectorType, ValueType>::~AMGTuner()
+    {
+        log_debug(this, "AMGTuner::~AMGTuner()", "destructor");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("AMGTuner " << this->configs_.size() << " configurations");
+
+        for(size_t i = 0; i < this->configs_.size(); ++i)
+        {
+            print_config(this->configs_[i]);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::SetSolver(
+        IterativeLinearSolver<OperatorType, VectorType, ValueType>& solver)
+    {
+        log_debug(this, "AMGTuner::SetSolver()", (const void*&)solver);
+
+        this->solver_ = &solver;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::Init(double abs_tol,
+                                                             double rel_tol,
+                                                             double div_tol,
+                                                             int    max_iter)
+    {
+        log_debug(this, "AMGTuner::Init()", abs_tol, rel_tol, div_tol, max_iter);
+
+        assert(max_iter > 0);
+
+        this->abs_tol_  = abs_tol;
+        this->rel_tol_  = rel_tol;
+        this->div_tol_  = div_tol;
+        this->max_iter_ = max_iter;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::SetAMGTypes(
+        const std::vector<AMGTuningType>& types)
+    {
+        log_debug(this, "AMGTuner::SetAMGTypes()");
+
+        this->types_ = types;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::SetCouplingStrengths(
+        const std::vector<double>& eps)
+    {
+        log_debug(this, "AMGTuner::SetCouplingStrengths()");
+
+        this->coupling_ = eps;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::SetStrengthThresholds(
+        const std::vector<double>& eps)
+    {
+        log_debug(this, "AMGTuner::SetStrengthThresholds()");
+
+        this->threshold_ = eps;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::SetCoarseningStrategies(
+        const std::vector<CoarseningStrategy>& strategies)
+    {
+        log_debug(this, "AMGTuner::SetCoarseningStrategies()");
+
+        this->coarsening_ = strategies;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::SetSmoothers(
+        const std::vector<SmootherType>& smoothers)
+    {
+        log_debug(this, "AMGTuner::SetSmoothers()");
+
+        this->smoothers_ = smoothers;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::SetSweeps(const std::vector<int>& sweeps)
+    {
+        log_debug(this, "AMGTuner::SetSweeps()");
+
+        this->sweeps_ = sweeps;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::SetCycles(
+        const std::vector<unsigned int>& cycles)
+    {
+        log_debug(this, "AMGTuner::SetCycles()");
+
+        this->cycles_ = cycles;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::SetCoarsestLevels(
+        const std::vector<int>& coarse_sizes)
+    {
+        log_debug(this, "AMGTuner::SetCoarsestLevels()");
+
+        this->coarsest_ = coarse_sizes;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::Verbose(int verb)
+    {
+        log_debug(this, "AMGTuner::Verbose()", verb);
+
+        this->verb_ = verb;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int AMGTuner<OperatorType, VectorType, ValueType>::GetNumConfigs(void) const
+    {
+        return static_cast<int>(this->configs_.size());
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    const AMGTuningConfig&
+        AMGTuner<OperatorType, VectorType, ValueType>::GetConfig(int i) const
+    {
+        assert(i >= 0);
+        assert(i < static_cast<int>(this->configs_.size()));
+
+        return this->configs_[i];
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    BaseAMG<OperatorType, VectorType, ValueType>*
+        AMGTuner<OperatorType, VectorType, ValueType>::CreateAMG(const AMGTuningConfig& config)
+    {
+        BaseAMG<OperatorType, VectorType, ValueType>* amg = NULL;
+
+        switch(config.amg)
+        {
+        case TuneSAAMG:
+        {
+            SAAMG<OperatorType, VectorType, ValueType>* sa
+                = new SAAMG<OperatorType, VectorType, ValueType>;
+            sa->SetCouplingStrength(static_cast<ValueType>(config.coupling_strength));
+            sa->SetCoarseningStrategy(config.coarsening);
+            amg = sa;
+            break;
+        }
+        case TuneUAAMG:
+        {
+            UAAMG<OperatorType, VectorType, ValueType>* ua
+                = new UAAMG<OperatorType, VectorType, ValueType>;
+            ua->SetCouplingStrength(static_cast<ValueType>(config.coupling_strength));
+            ua->SetCoarseningStrategy(config.coarsening);
+            amg = ua;
+            break;
+        }
+        case TuneRSAMG:
+        {
+            RugeStuebenAMG<OperatorType, VectorType, ValueType>* rs
+                = new RugeStuebenAMG<OperatorType, VectorType, ValueType>;
+            rs->SetStrengthThreshold(static_cast<float>(config.coupling_strength));
+            rs->SetCoarseningStrategy(config.coarsening);
+            amg = rs;
+            break;
+        }
+        }
+
+        assert(amg != NULL);
+
+        amg->SetDefaultSmoother(config.smoother);
+        amg->SetSmootherPreIter(config.sweeps);
+        amg->SetSmootherPostIter(config.sweeps);
+        amg->SetCycle(config.cycle);
+        amg->SetCoarsestLevel(config.coarsest_level);
+
+        return amg;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    AMGTuningConfig AMGTuner<OperatorType, VectorType, ValueType>::Tune(const OperatorType& A,
+                                                                        const VectorType& rhs)
+    {
+        log_debug(this, "AMGTuner::Tune()", (const void*&)A, (const void*&)rhs);
+
+        assert(A.GetM() == A.GetN());
+        assert(A.GetM() == rhs.GetSize());
+
+        this->configs_.clear();
+
+        // Build the search space
+        for(auto amg : this->types_)
+        {
+            const std::vector<double>& eps
+                = (amg == TuneRSAMG) ? this->threshold_ : this->coupling_;
+
+            for(auto e : eps)
+            {
+                for(auto coarsening : this->coarsening_)
+                {
+                    for(auto smoother : this->smoothers_)
+                    {
+                        for(auto sweeps : this->sweeps_)
+                        {
+                            for(auto cycle : this->cycles_)
+                            {
+                                for(auto coarsest : this->coarsest_)
+                                {
+                                    AMGTuningConfig config = {};
+
+                                    config.amg               = amg;
+                                    config.coupling_strength = e;
+                                    config.coarsening        = coarsening;
+                                    config.smoother          = smoother;
+                                    config.sweeps            = sweeps;
+                                    config.cycle             = cycle;
+                                    config.coarsest_level    = coarsest;
+
+                                    this->configs_.push_back(config);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        if(this->configs_.empty())
+        {
+            LOG_INFO("AMGTuner::Tune() empty search space");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        VectorType x;
+        x.CloneFrom(rhs);
+
+        double best  = std::numeric_limits<double>::infinity();
+        int    ibest = -1;
+
+        for(size_t i = 0; i < this->configs_.size(); ++i)
+        {
+            AMGTuningConfig& config = this->configs_[i];
+
+            this->Run_(A, rhs, &x, best, &config);
+
+            if(this->verb_ > 1)
+            {
+                print_config(config);
+            }
+
+            if(config.converged == true && config.setup_time + config.solve_time < best)
+            {
+                best  = config.setup_time + config.solve_time;
+                ibest = static_cast<int>(i);
+            }
+        }
+
+        if(ibest < 0)
+        {
+            LOG_INFO("AMGTuner::Tune() no configuration converged");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(this->verb_ > 0)
+        {
+            LOG_INFO("AMGTuner best configuration of " << this->configs_.size() << ":");
+            print_config(this->configs_[ibest]);
+        }
+
+        return this->configs_[ibest];
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AMGTuner<OperatorType, VectorType, ValueType>::Run_(const OperatorType& A,
+                                                             const VectorType&   rhs,
+                                                             VectorType*         x,
+                                                             double              best,
+                                                             AMGTuningConfig*    config)
+    {
+        BaseAMG<OperatorType, VectorType, ValueType>* amg = CreateAMG(*config);
+
+        amg->Verbose(0);
+
+        IterativeLinearSolver<OperatorType, VectorType, ValueType>* solver = amg;
+
+        if(this->solver_ != NULL)
+        {
+            amg->InitMaxIter(1);
+
+            solver = this->solver_;
+            solver->SetPreconditioner(*amg);
+            solver->Verbose(0);
+        }
+
+        solver->SetOperator(A);
+
+        // Setup, the configuration is pruned as soon as it cannot beat the best one
+        double time = rocalution_time();
+        solver->Build();
+        config->setup_time = (rocalution_time() - time) / 1e6;
+
+        if(config->setup_time < best)
+        {
+            // A single iteration estimates the time per iteration
+            x->Zeros();
+            solver->Init(this->abs_tol_, this->rel_tol_, this->div_tol_, 1);
+
+            time = rocalution_time();
+            solver->Solve(rhs, x);
+            const double iter_time = (rocalution_time() - time) / 1e6;
+
+            // Iteration budget within the time-to-solution of the best configuration
+            int    max_iter = this->max_iter_;
+            double budget   = (best - config->setup_time) / iter_time;
+
+            const bool limited = budget < max_iter;
+            if(limited == true)
+            {
+                max_iter = std::max(1, static_cast<int>(budget));
+            }
+
+            x->Zeros();
+            solver->Init(this->abs_tol_, this->rel_tol_, this->div_tol_, max_iter);
+
+            time = rocalution_time();
+            solver->Solve(rhs, x);
+            config->solve_time = (rocalution_time() - time) / 1e6;
+
+            const int status = solver->GetSolverStatus();
+
+            config->iter      = solver->GetIterationCount();
+            config->converged = (status == 1 || status == 2);
+            config->pruned    = (config->converged == false && status == 4 && limited == true);
+        }
+        else
+        {
+            config->pruned = true;
+        }
+
+        solver->Clear();
+        amg->Clear();
+
+        delete amg;
+    }
+
+    template class AMGTuner<LocalMatrix<double>, LocalVector<double>, double>;
+    template class AMGTuner<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class AMGTuner<LocalMatrix<float>, LocalVector<float>, float>;
+    template class AMGTuner<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class AMGTuner<LocalMatrix<std::complex<double>>,
+                            LocalVector<std::complex<double>>,
+                            std::complex<double>>;
+    template class AMGTuner<GlobalMatrix<std::complex<double>>,
+                            GlobalVector<std::complex<double>>,
+                            std::complex<double>>;
+    template class AMGTuner<LocalMatrix<std::complex<float>>,
+                            LocalVector<std::complex<float>>,
+                            std::complex<float>>;
+    template class AMGTuner<GlobalMatrix<std::complex<float>>,
+                            GlobalVector<std::complex<float>>,
+                            std::complex<float>>;
+#endif
+
+} // namespace rocalution
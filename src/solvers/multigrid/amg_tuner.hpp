@@ -0,0 +1,225 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_AMG_TUNER_HPP_
+#define ROCALUTION_AMG_TUNER_HPP_
+
+#include "../solver.hpp"
+#include "base_amg.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+    /*! \brief AMG algorithms
+     *  \details
+     *  This is a list of the AMG algorithms that can be searched by the AMGTuner
+     */
+    typedef enum _amg_tuning_type : unsigned int
+    {
+        TuneSAAMG = 0, /**< Smoothed aggregation, see SAAMG. */
+        TuneUAAMG = 1, /**< Unsmoothed aggregation, see UAAMG. */
+        TuneRSAMG = 2 /**< Ruge-Stueben coarsening, see RugeStuebenAMG. */
+    } AMGTuningType;
+
+    /** \ingroup solver_module
+  * \brief Configuration of an AMG solver, as searched by the AMGTuner
+  * \details
+  * The coupling strength is passed to SetCouplingStrength() of the aggregation based
+  * algorithms and to SetStrengthThreshold() of RugeStuebenAMG. The cost fields hold the
+  * setup (hierarchy and smoother build) and solve time in seconds and the iteration count
+  * of the tuning run. A configuration is pruned, if its cost exceeded the cost of the best
+  * configuration found so far before it converged.
+  */
+    struct AMGTuningConfig
+    {
+        AMGTuningType      amg;
+        double             coupling_strength;
+        CoarseningStrategy coarsening;
+        SmootherType       smoother;
+        int                sweeps;
+        unsigned int       cycle;
+        int                coarsest_level;
+
+        double setup_time;
+        double solve_time;
+        int    iter;
+        bool   converged;
+        bool   pruned;
+    };
+
+    /** \ingroup solver_module
+  * \class AMGTuner
+  * \brief Automatic tuning of the AMG parameters
+  * \details
+  * The AMGTuner searches the AMG algorithm, coupling strength, coarsening strategy,
+  * smoother, number of smoothing sweeps, cycle and coarsest level size for the minimal
+  * time-to-solution, i.e. setup plus solve time, on a representative linear system. Each
+  * configuration of the search space is built and solved from a zero initial guess. The
+  * AMG is used as preconditioner of the solver passed with SetSolver(), or as a solver
+  * on its own otherwise. Configurations are terminated early, as soon as their setup time
+  * or the time of their iterations exceeds the time-to-solution of the best configuration
+  * so far, such that the search spends most of its time on good configurations. The best
+  * configuration can be instantiated with CreateAMG().
+  *
+  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  *
+  * \par Example
+  * \code{.cpp}
+  *   AMGTuner<LocalMatrix<double>, LocalVector<double>, double> tuner;
+  *   CG<LocalMatrix<double>, LocalVector<double>, double> cg;
+  *
+  *   tuner.SetSolver(cg);
+  *   tuner.SetCycles({Vcycle, Kcycle});
+  *   tuner.Init(0.0, 1e-8, 1e8, 1000);
+  *
+  *   AMGTuningConfig best = tuner.Tune(mat, rhs);
+  *
+  *   BaseAMG<LocalMatrix<double>, LocalVector<double>, double>* p
+  *       = tuner.CreateAMG(best);
+  * \endcode
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class AMGTuner
+    {
+    public:
+        ROCALUTION_EXPORT
+        AMGTuner();
+        ROCALUTION_EXPORT
+        virtual ~AMGTuner();
+
+        /** \brief Print the configurations of the last tuning run and their cost */
+        ROCALUTION_EXPORT
+        void Print(void) const;
+
+        /** \brief Set the outer solver, which is preconditioned by the AMG
+        * \details
+        * The solver is built and cleared for each configuration. If no solver is set,
+        * the AMG is tuned as a solver.
+        */
+        ROCALUTION_EXPORT
+        void SetSolver(IterativeLinearSolver<OperatorType, VectorType, ValueType>& solver);
+
+        /** \brief Initialize the stopping criteria of the tuning solves, see
+        * IterativeLinearSolver::Init()
+        */
+        ROCALUTION_EXPORT
+        void Init(double abs_tol, double rel_tol, double div_tol, int max_iter);
+
+        /** \brief Set the AMG algorithms to search (default all) */
+        ROCALUTION_EXPORT
+        void SetAMGTypes(const std::vector<AMGTuningType>& types);
+        /** \brief Set the coupling strengths of SAAMG and UAAMG to search
+        * (default 0.001, 0.01, 0.08)
+        */
+        ROCALUTION_EXPORT
+        void SetCouplingStrengths(const std::vector<double>& eps);
+        /** \brief Set the strength thresholds of RugeStuebenAMG to search
+        * (default 0.25, 0.5)
+        */
+        ROCALUTION_EXPORT
+        void SetStrengthThresholds(const std::vector<double>& eps);
+        /** \brief Set the coarsening strategies to search (default Greedy, PMIS) */
+        ROCALUTION_EXPORT
+        void SetCoarseningStrategies(const std::vector<CoarseningStrategy>& strategies);
+        /** \brief Set the smoothers to search (default JacobiSmoother, ChebyshevSmoother) */
+        ROCALUTION_EXPORT
+        void SetSmoothers(const std::vector<SmootherType>& smoothers);
+        /** \brief Set the number of pre- and post-smoothing sweeps to search (default 1, 2) */
+        ROCALUTION_EXPORT
+        void SetSweeps(const std::vector<int>& sweeps);
+        /** \brief Set the cycles to search (default Vcycle, Kcycle) */
+        ROCALUTION_EXPORT
+        void SetCycles(const std::vector<unsigned int>& cycles);
+        /** \brief Set the coarsest level sizes to search (default 300) */
+        ROCALUTION_EXPORT
+        void SetCoarsestLevels(const std::vector<int>& coarse_sizes);
+
+        /** \brief Provide verbose output of the tuning
+        * \details
+        * - verb = 0 -> no output
+        * - verb = 1 -> print the best configuration (default)
+        * - verb = 2 -> print the cost of each configuration
+        */
+        ROCALUTION_EXPORT
+        void Verbose(int verb = 1);
+
+        /** \brief Search the configuration with the minimal time-to-solution of
+        * \f$Ax = b\f$ and return it
+        */
+        ROCALUTION_EXPORT
+        AMGTuningConfig Tune(const OperatorType& A, const VectorType& rhs);
+
+        /** \brief Return the number of configurations of the last tuning run */
+        ROCALUTION_EXPORT
+        int GetNumConfigs(void) const;
+        /** \brief Return configuration \p i of the last tuning run and its cost */
+        ROCALUTION_EXPORT
+        const AMGTuningConfig& GetConfig(int i) const;
+
+        /** \brief Create an AMG solver with the given configuration
+        * \details
+        * The AMG is allocated with new and has to be deleted by the caller. If it is used
+        * as preconditioner, InitMaxIter(1) has to be set as usual.
+        */
+        ROCALUTION_EXPORT
+        static BaseAMG<OperatorType, VectorType, ValueType>*
+            CreateAMG(const AMGTuningConfig& config);
+
+    private:
+        /** \brief Build and solve with one configuration, \p best is the time-to-solution
+        * of the best configuration so far
+        */
+        void Run_(const OperatorType& A,
+                  const VectorType&   rhs,
+                  VectorType*         x,
+                  double              best,
+                  AMGTuningConfig*    config);
+
+        IterativeLinearSolver<OperatorType, VectorType, ValueType>* solver_;
+
+        double abs_tol_;
+        double rel_tol_;
+        double div_tol_;
+        int    max_iter_;
+
+        int verb_;
+
+        std::vector<AMGTuningType>      types_;
+        std::vector<double>             coupling_;
+        std::vector<double>             threshold_;
+        std::vector<CoarseningStrategy> coarsening_;
+        std::vector<SmootherType>       smoothers_;
+        std::vector<int>                sweeps_;
+        std::vector<unsigned int>       cycles_;
+        std::vector<int>                coarsest_;
+
+        std::vector<AMGTuningConfig> configs_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_AMG_TUNER_HPP_
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -28,18 +28,252 @@
 #include "../../base/global_vector.hpp"
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_vector.hpp"
+#include "../chebyshev.hpp"
+#include "../direct/lu.hpp"
+#include "../direct/sparse_lu.hpp"
 #include "../iter_ctrl.hpp"
 
 #include "../krylov/cg.hpp"
 #include "../preconditioners/preconditioner.hpp"
+#include "../preconditioners/preconditioner_redundant.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/time_functions.hpp"
 
+#include <fstream>
+#include <iterator>
 #include <list>
+#include <sstream>
+#include <thread>
 
 namespace rocalution
 {
 
+    // Galerkin product Ac = R * A * P. If numeric is true, Ac already holds the structure
+    // of a previous call with the same sparsity patterns and only its values are
+    // recomputed.
+    template <typename ValueType>
+    static void galerkin_product(const LocalMatrix<ValueType>& R,
+                                 const LocalMatrix<ValueType>& A,
+                                 const LocalMatrix<ValueType>& P,
+                                 bool                          numeric,
+                                 LocalMatrix<ValueType>*       Ac)
+    {
+        if(numeric == true)
+        {
+            Ac->TripleMatrixProductNumeric(R, A, P);
+        }
+        else
+        {
+            Ac->TripleMatrixProduct(R, A, P);
+        }
+    }
+
+    // GlobalMatrix does not support to reuse the structure of the products
+    template <typename ValueType>
+    static void galerkin_product(const GlobalMatrix<ValueType>& R,
+                                 const GlobalMatrix<ValueType>& A,
+                                 const GlobalMatrix<ValueType>& P,
+                                 bool                           numeric,
+                                 GlobalMatrix<ValueType>*       Ac)
+    {
+        Ac->TripleMatrixProduct(R, A, P);
+    }
+
+    // Recompute the flagged rows of Ac = R * A * P, whose structure has been cached by a
+    // previous galerkin_product()
+    template <typename ValueType>
+    static void galerkin_product_rows(const LocalMatrix<ValueType>& R,
+                                      const LocalMatrix<ValueType>& A,
+                                      const LocalMatrix<ValueType>& P,
+                                      const LocalVector<bool>&      rows,
+                                      LocalMatrix<ValueType>*       Ac)
+    {
+        Ac->TripleMatrixProductNumeric(R, A, P, rows);
+    }
+
+    template <typename ValueType>
+    static void galerkin_product_rows(const GlobalMatrix<ValueType>& R,
+                                      const GlobalMatrix<ValueType>& A,
+                                      const GlobalMatrix<ValueType>& P,
+                                      const LocalVector<bool>&       rows,
+                                      GlobalMatrix<ValueType>*       Ac)
+    {
+        Ac->TripleMatrixProduct(R, A, P);
+    }
+
+    // Flag the rows of Ac = R * A * P that depend on the flagged rows of A
+    template <typename ValueType>
+    static void galerkin_affected_rows(const LocalMatrix<ValueType>& R,
+                                       const LocalVector<bool>&      rows,
+                                       LocalVector<bool>*            coarse_rows)
+    {
+        R.ExtractConnectedRows(rows, coarse_rows);
+    }
+
+    template <typename ValueType>
+    static void galerkin_affected_rows(const GlobalMatrix<ValueType>& R,
+                                       const LocalVector<bool>&       rows,
+                                       LocalVector<bool>*             coarse_rows)
+    {
+        coarse_rows->Allocate("affected rows", R.GetLocalM());
+        coarse_rows->SetValues(true);
+    }
+
+    // The overlapped setup attaches the level operators to an execution context, which is
+    // not supported by the halo exchange of global operators
+    template <typename ValueType>
+    static bool overlapped_setup_available(const LocalMatrix<ValueType>& op)
+    {
+        return true;
+    }
+
+    template <typename ValueType>
+    static bool overlapped_setup_available(const GlobalMatrix<ValueType>& op)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    static bool galerkin_reuse_available(const LocalMatrix<ValueType>& op)
+    {
+        return true;
+    }
+
+    template <typename ValueType>
+    static bool galerkin_reuse_available(const GlobalMatrix<ValueType>& op)
+    {
+        return false;
+    }
+
+    template <typename ValueType>
+    static bool operator_hash(const LocalMatrix<ValueType>& op, uint64_t* hash)
+    {
+        *hash = op.Hash();
+
+        return true;
+    }
+
+    template <typename ValueType>
+    static bool operator_hash(const GlobalMatrix<ValueType>& op, uint64_t* hash)
+    {
+        // A decision per process could diverge across the ranks
+        return false;
+    }
+
+    template <typename ValueType>
+    static void sparsify_operator(LocalMatrix<ValueType>* op, double drop_off)
+    {
+        op->CompressLumped(drop_off);
+    }
+
+    // GlobalMatrix does not support sparsification
+    template <typename ValueType>
+    static void sparsify_operator(GlobalMatrix<ValueType>* op, double drop_off)
+    {
+        LOG_VERBOSE_INFO(2,
+                         "*** warning: BaseAMG::Sparsify_() Coarse operator sparsification is "
+                         "not supported for GlobalMatrix");
+    }
+
+    // Restriction as transposed prolongation, out = P^T * in
+    template <typename ValueType>
+    static void apply_transpose(const LocalMatrix<ValueType>& P,
+                                const LocalVector<ValueType>& in,
+                                LocalVector<ValueType>*       out)
+    {
+        P.ApplyTranspose(in, out);
+    }
+
+    // The contributions to the ghost columns of P are sent to their owners
+    template <typename ValueType>
+    static void apply_transpose(const GlobalMatrix<ValueType>& P,
+                                const GlobalVector<ValueType>& in,
+                                GlobalVector<ValueType>*       out)
+    {
+        P.ApplyTranspose(in, out);
+    }
+
+    // Direct coarse grid solver, LU of the coarsest operator
+    template <typename ValueType>
+    static Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>*
+        local_direct_solver(CoarseSolverType cs_type)
+    {
+        if(cs_type == SparseDirectCoarseSolver)
+        {
+            return new SparseLU<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>;
+        }
+
+        return new LU<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>;
+    }
+
+    template <typename ValueType>
+    static Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>* direct_coarse_solver(
+        const LocalMatrix<ValueType>&                                       op,
+        CoarseSolverType                                                    cs_type,
+        Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>** local)
+    {
+        *local = NULL;
+
+        return local_direct_solver<ValueType>(cs_type);
+    }
+
+    // The coarsest GlobalMatrix is gathered on each process and factorized by a local LU
+    template <typename ValueType>
+    static Solver<GlobalMatrix<ValueType>, GlobalVector<ValueType>, ValueType>*
+        direct_coarse_solver(
+            const GlobalMatrix<ValueType>&                                      op,
+            CoarseSolverType                                                    cs_type,
+            Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>** local)
+    {
+        *local = local_direct_solver<ValueType>(cs_type);
+
+        Redundant<GlobalMatrix<ValueType>, GlobalVector<ValueType>, ValueType>* redundant
+            = new Redundant<GlobalMatrix<ValueType>, GlobalVector<ValueType>, ValueType>;
+
+        redundant->Set(**local);
+
+        return redundant;
+    }
+
+    // Name of the file of a hierarchy operator, type is op, pro or res
+    static std::string hierarchy_file_name(const std::string& filename, int level, const char* type)
+    {
+        std::ostringstream name;
+
+        name << filename << ".level." << level << "." << type;
+
+        return name.str();
+    }
+
+    template <typename ValueType>
+    static void write_hierarchy_operator(const LocalMatrix<ValueType>& op,
+                                         const std::string&            filename)
+    {
+        op.WriteFileRSIO(filename, true);
+    }
+
+    template <typename ValueType>
+    static void write_hierarchy_operator(const GlobalMatrix<ValueType>& op,
+                                         const std::string&             filename)
+    {
+        LOG_INFO("BaseAMG::SaveHierarchy() is not supported for GlobalMatrix operators");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <typename ValueType>
+    static void read_hierarchy_operator(LocalMatrix<ValueType>* op, const std::string& filename)
+    {
+        op->ReadFileRSIO(filename);
+    }
+
+    template <typename ValueType>
+    static void read_hierarchy_operator(GlobalMatrix<ValueType>* op, const std::string& filename)
+    {
+        LOG_INFO("BaseAMG::LoadHierarchy() is not supported for GlobalMatrix operators");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     BaseAMG<OperatorType, VectorType, ValueType>::BaseAMG()
     {
@@ -53,16 +287,53 @@ namespace rocalution
 
         // default smoother format
         this->sm_format_ = CSR;
+        // default smoother type
+        this->sm_type_ = JacobiSmoother;
+        // default coarse grid solver type
+        this->cs_type_  = CGCoarseSolver;
+        this->cs_local_ = NULL;
         // default operator format
         this->op_format_ = CSR;
         // default operator block dimension
         this->op_blockdim_ = 1;
+        // operator format is not tuned by default
+        this->op_autotune_ = false;
+        // coarse operators are applied in full precision by default
+        this->op_storage_ = SpMVStorage_Full;
 
         // since hierarchy has not been built yet
         this->hierarchy_ = false;
 
         // initialize temp default smoother pointer
         this->sm_default_ = NULL;
+
+        // Galerkin products are recomputed from scratch by default
+        this->frozen_         = false;
+        this->galerkin_level_ = NULL;
+
+        // Unchanged operators are set up again by default
+        this->skip_unchanged_ = false;
+        this->op_hashed_      = NULL;
+        this->op_hash_        = 0;
+
+        // No aggressive coarsening by default
+        this->aggressive_      = false;
+        this->aggressive_pass_ = false;
+
+        // Restriction operators are stored by default
+        this->low_memory_            = false;
+        this->transpose_restriction_ = false;
+
+        // Transfer operators are stored as matrices by default
+        this->matrix_free_transfer_ = false;
+
+        // Smoothers are built after the hierarchy by default
+        this->overlap_setup_ = false;
+        this->overlap_pass_  = false;
+        this->setup_context_ = NULL;
+
+        // Coarse operators are not sparsified by default
+        this->sparsify_ = 0.0;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -71,6 +342,9 @@ namespace rocalution
         log_debug(this, "BaseAMG::BaseAMG()", "destructor");
 
         this->Clear();
+
+        // The context has to outlive the level operators
+        delete this->setup_context_;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -116,6 +390,27 @@ namespace rocalution
         this->sm_format_ = op_format;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetDefaultSmoother(SmootherType sm_type)
+    {
+        log_debug(this, "BaseAMG::SetDefaultSmoother()", sm_type);
+
+        assert(this->build_ == false);
+
+        this->sm_type_ = sm_type;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetDefaultCoarseSolver(
+        CoarseSolverType cs_type)
+    {
+        log_debug(this, "BaseAMG::SetDefaultCoarseSolver()", cs_type);
+
+        assert(this->build_ == false);
+
+        this->cs_type_ = cs_type;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseAMG<OperatorType, VectorType, ValueType>::SetOperatorFormat(unsigned int op_format,
                                                                          int          op_blockdim)
@@ -126,12 +421,479 @@ namespace rocalution
         this->op_blockdim_ = op_blockdim;
     }
 
-    template <class OperatorType, class VectorType, typename ValueType>
-    int BaseAMG<OperatorType, VectorType, ValueType>::GetNumLevels(void)
-    {
-        assert(this->hierarchy_ != false);
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetOperatorAutoTune(bool autotune)
+    {
+        log_debug(this, "BaseAMG::SetOperatorAutoTune()", autotune);
+
+        this->op_autotune_ = autotune;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetOperatorSpMVStorage(SpMVStorage storage)
+    {
+        log_debug(this, "BaseAMG::SetOperatorSpMVStorage()", storage);
+
+        this->op_storage_ = storage;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::ConvertOperators_(void)
+    {
+        log_debug(this, "BaseAMG::ConvertOperators_()");
+
+        if(this->op_autotune_ == true)
+        {
+            for(int i = 0; i < this->levels_ - 1; ++i)
+            {
+                this->op_level_[i]->ConvertToBest();
+            }
+        }
+        else if(this->op_format_ != CSR)
+        {
+            for(int i = 0; i < this->levels_ - 1; ++i)
+            {
+                this->op_level_[i]->ConvertTo(this->op_format_, this->op_blockdim_);
+            }
+        }
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            this->op_level_[i]->SetSpMVStorage(this->op_storage_);
+            this->restrict_op_level_[i]->SetSpMVStorage(this->op_storage_);
+            this->prolong_op_level_[i]->SetSpMVStorage(this->op_storage_);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetFrozenHierarchy(bool frozen)
+    {
+        log_debug(this, "BaseAMG::SetFrozenHierarchy()", frozen);
+
+        this->frozen_ = frozen;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetSkipUnchangedBuild(bool skip)
+    {
+        log_debug(this, "BaseAMG::SetSkipUnchangedBuild()", skip);
+
+        this->skip_unchanged_ = skip;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    bool BaseAMG<OperatorType, VectorType, ValueType>::UnchangedOperator_(void)
+    {
+        log_debug(this, "BaseAMG::UnchangedOperator_()");
+
+        if(this->skip_unchanged_ == false || this->op_ == NULL)
+        {
+            return false;
+        }
+
+        uint64_t hash;
+
+        if(operator_hash(*this->op_, &hash) == false)
+        {
+            return false;
+        }
+
+        bool unchanged
+            = this->build_ == true && this->op_hashed_ == this->op_ && this->op_hash_ == hash;
+
+        this->op_hashed_ = this->op_;
+        this->op_hash_   = hash;
+
+        if(unchanged == true)
+        {
+            LOG_VERBOSE_INFO(2, "BaseAMG: operator is unchanged, setup is skipped");
+        }
+
+        return unchanged;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::UpdateHierarchy(int nrow, const int* rows)
+    {
+        log_debug(this, "BaseAMG::UpdateHierarchy()", " #*# begin", nrow, rows);
+
+        ROCALUTION_RANGE("BaseAMG::UpdateHierarchy()");
+
+        assert(this->levels_ > 1);
+        assert(this->build_ == true);
+        assert(this->op_ != NULL);
+        assert(nrow >= 0);
+        assert(nrow == 0 || rows != NULL);
+
+        // Only the rows of cached Galerkin structures can be recomputed
+        bool localized = this->frozen_ == true && this->galerkin_level_ != NULL
+                         && this->op_->GetFormat() == CSR;
+
+        for(int i = 0; localized == true && i < this->levels_ - 1; ++i)
+        {
+            localized = this->galerkin_level_[i];
+        }
+
+        if(localized == false)
+        {
+            this->ReBuildNumeric();
+
+            log_debug(this, "BaseAMG::UpdateHierarchy()", " #*# end");
+
+            return;
+        }
+
+        if(this->UnchangedOperator_() == true)
+        {
+            log_debug(this, "BaseAMG::UpdateHierarchy()", " #*# end");
+
+            return;
+        }
+
+        int64_t size = this->op_->GetLocalM();
+
+        // Flag the modified rows of the finest level
+        LocalVector<bool> level_rows;
+        level_rows.Allocate("modified rows", size);
+        level_rows.Zeros();
+
+        for(int k = 0; k < nrow; ++k)
+        {
+            assert(rows[k] >= 0 && rows[k] < size);
+
+            level_rows[rows[k]] = true;
+        }
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            // Temporary transfer operators, if they are not stored
+            OperatorType        res_tmp;
+            OperatorType        pro_tmp;
+            const OperatorType* res = this->Restriction_(i, &res_tmp);
+            const OperatorType* pro = this->Prolongation_(i, &pro_tmp);
+
+            // The first host level requires its fine operator on the host
+            bool move_fine = (i > 0) && (i == this->levels_ - this->host_level_ - 1);
+
+            const OperatorType* op_fine = (i == 0) ? this->op_ : this->op_level_[i - 1];
+
+            if(move_fine == true)
+            {
+                this->op_level_[i - 1]->MoveToHost();
+            }
+
+            // The modified coarse rows are the rows of R that touch a modified fine row
+            LocalVector<bool> coarse_rows;
+            coarse_rows.CloneBackend(*res);
+            level_rows.CloneBackend(*res);
+
+            galerkin_affected_rows(*res, level_rows, &coarse_rows);
+
+            this->op_level_[i]->CloneBackend(*this->restrict_op_level_[i]);
+
+            galerkin_product_rows(*res, *op_fine, *pro, coarse_rows, this->op_level_[i]);
+
+            if(move_fine == true)
+            {
+                this->op_level_[i - 1]->CloneBackend(*this->restrict_op_level_[i - 1]);
+            }
+
+            // The coarse rows are the fine rows of the next level
+            level_rows.Clear();
+            level_rows.CloneFrom(coarse_rows);
+        }
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            if(i > 0)
+            {
+                this->smoother_level_[i]->ResetOperator(*this->op_level_[i - 1]);
+            }
+            else
+            {
+                this->smoother_level_[i]->ResetOperator(*this->op_);
+            }
+
+            this->smoother_level_[i]->ReBuildNumeric();
+            this->smoother_level_[i]->Verbose(0);
+        }
+
+        this->solver_coarse_->ResetOperator(*this->op_level_[this->levels_ - 2]);
+        this->solver_coarse_->ReBuildNumeric();
+        this->solver_coarse_->Verbose(0);
+
+        // Refresh the fused residual restriction operators
+        this->BuildFusedLevelOperations_();
+
+        log_debug(this, "BaseAMG::UpdateHierarchy()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetAggressiveCoarsening(bool aggressive)
+    {
+        log_debug(this, "BaseAMG::SetAggressiveCoarsening()", aggressive);
+
+        assert(this->build_ == false);
+        assert(this->hierarchy_ == false);
+
+        this->aggressive_ = aggressive;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetLowMemorySetup(bool low_memory)
+    {
+        log_debug(this, "BaseAMG::SetLowMemorySetup()", low_memory);
+
+        assert(this->build_ == false);
+        assert(this->hierarchy_ == false);
+
+        this->low_memory_ = low_memory;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetMatrixFreeTransfer(bool matrix_free)
+    {
+        log_debug(this, "BaseAMG::SetMatrixFreeTransfer()", matrix_free);
+
+        assert(this->build_ == false);
+        assert(this->hierarchy_ == false);
+
+        this->matrix_free_transfer_ = matrix_free;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetOverlappedSetup(bool overlap)
+    {
+        log_debug(this, "BaseAMG::SetOverlappedSetup()", overlap);
+
+        assert(this->build_ == false);
+        assert(this->hierarchy_ == false);
+
+        this->overlap_setup_ = overlap;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SetCoarseSparsification(double drop_off,
+                                                                               int    level)
+    {
+        log_debug(this, "BaseAMG::SetCoarseSparsification()", drop_off, level);
+
+        assert(drop_off >= 0.0);
+        assert(level == -1 || level > 0);
+
+        if(level == -1)
+        {
+            this->sparsify_ = drop_off;
+
+            return;
+        }
+
+        // Levels that are not set explicitly are marked by a negative drop off
+        if(level > static_cast<int>(this->sparsify_level_.size()))
+        {
+            this->sparsify_level_.resize(level, -1.0);
+        }
+
+        this->sparsify_level_[level - 1] = drop_off;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    double BaseAMG<OperatorType, VectorType, ValueType>::SparsificationDropOff_(int level) const
+    {
+        assert(level > 0);
+
+        if(level <= static_cast<int>(this->sparsify_level_.size())
+           && this->sparsify_level_[level - 1] >= 0.0)
+        {
+            return this->sparsify_level_[level - 1];
+        }
+
+        return this->sparsify_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::Sparsify_(int level, OperatorType* op) const
+    {
+        double drop_off = this->SparsificationDropOff_(level);
+
+        if(drop_off > 0.0)
+        {
+            log_debug(this, "BaseAMG::Sparsify_()", level, drop_off);
+
+            sparsify_operator(op, drop_off);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    double BaseAMG<OperatorType, VectorType, ValueType>::GetHierarchyTime(int level) const
+    {
+        log_debug(this, "BaseAMG::GetHierarchyTime()", level);
+
+        assert(this->hierarchy_ == true);
+        assert(level >= 0);
+        assert(level < static_cast<int>(this->time_hierarchy_.size()));
+
+        return this->time_hierarchy_[level] / 1e6;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::GetComplexity(
+        double* operator_complexity, double* grid_complexity) const
+    {
+        log_debug(this, "BaseAMG::GetComplexity()", operator_complexity, grid_complexity);
+
+        assert(this->hierarchy_ == true);
+        assert(operator_complexity != NULL);
+        assert(grid_complexity != NULL);
+
+        int64_t nnz  = this->op_->GetNnz();
+        int64_t rows = this->op_->GetM();
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            nnz += this->op_level_[i]->GetNnz();
+            rows += this->op_level_[i]->GetM();
+        }
+
+        *operator_complexity = static_cast<double>(nnz) / std::max<int64_t>(this->op_->GetNnz(), 1);
+        *grid_complexity     = static_cast<double>(rows) / std::max<int64_t>(this->op_->GetM(), 1);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int BaseAMG<OperatorType, VectorType, ValueType>::GetNumLevels(void)
+    {
+        assert(this->hierarchy_ != false);
+
+        return this->levels_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::SaveHierarchy(
+        const std::string& filename) const
+    {
+        log_debug(this, "BaseAMG::SaveHierarchy()", filename);
+
+        assert(this->hierarchy_ == true);
+        assert(this->levels_ > 1);
+
+        std::ofstream headfile(filename.c_str(), std::ofstream::out);
+
+        if(!headfile.is_open())
+        {
+            LOG_INFO("Cannot open AMG hierarchy file [write]: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        headfile << "ROCALUTION_AMG_HIERARCHY 1\n";
+        headfile << "levels " << this->levels_ << "\n";
+
+        headfile.close();
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            write_hierarchy_operator(*this->op_level_[i], hierarchy_file_name(filename, i, "op"));
+            OperatorType pro;
+            write_hierarchy_operator(*this->Prolongation_(i, &pro),
+                                     hierarchy_file_name(filename, i, "pro"));
+
+            OperatorType res;
+            write_hierarchy_operator(*this->Restriction_(i, &res),
+                                     hierarchy_file_name(filename, i, "res"));
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::LoadHierarchy(const std::string& filename)
+    {
+        log_debug(this, "BaseAMG::LoadHierarchy()", filename);
+
+        assert(this->build_ == false);
+        assert(this->hierarchy_ == false);
+        assert(this->op_ != NULL);
+
+        std::ifstream headfile(filename.c_str(), std::ifstream::in);
+
+        if(!headfile.is_open())
+        {
+            LOG_INFO("Cannot open AMG hierarchy file [read]: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        std::string header;
+        std::string levels_key;
+        int         version = 0;
+        int         levels  = 0;
+
+        headfile >> header >> version >> levels_key >> levels;
+
+        if(!headfile || header != "ROCALUTION_AMG_HIERARCHY" || version != 1
+           || levels_key != "levels" || levels < 2)
+        {
+            LOG_INFO("Invalid AMG hierarchy file: " << filename);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        headfile.close();
+
+        // Size of the fine operator of the current level
+        int64_t fine_size = this->op_->GetM();
+
+        this->levels_ = levels;
+
+        // Allocate data structures
+        this->op_level_          = new OperatorType*[this->levels_ - 1];
+        this->restrict_op_level_ = new OperatorType*[this->levels_ - 1];
+        this->prolong_op_level_  = new OperatorType*[this->levels_ - 1];
+        this->trans_level_       = new LocalVector<int>*[this->levels_ - 1];
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            this->op_level_[i]          = new OperatorType;
+            this->restrict_op_level_[i] = new OperatorType;
+            this->prolong_op_level_[i]  = new OperatorType;
+            this->trans_level_[i]       = new LocalVector<int>;
+
+            read_hierarchy_operator(this->op_level_[i], hierarchy_file_name(filename, i, "op"));
+            read_hierarchy_operator(this->prolong_op_level_[i],
+                                    hierarchy_file_name(filename, i, "pro"));
+            read_hierarchy_operator(this->restrict_op_level_[i],
+                                    hierarchy_file_name(filename, i, "res"));
+
+            if(this->prolong_op_level_[i]->GetM() != fine_size
+               || this->restrict_op_level_[i]->GetN() != fine_size
+               || this->prolong_op_level_[i]->GetN() != this->op_level_[i]->GetM()
+               || this->restrict_op_level_[i]->GetM() != this->op_level_[i]->GetM())
+            {
+                LOG_INFO("AMG hierarchy file does not match the operator: " << filename);
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            this->op_level_[i]->CloneBackend(*this->op_);
+            this->restrict_op_level_[i]->CloneBackend(*this->op_);
+            this->prolong_op_level_[i]->CloneBackend(*this->op_);
+            this->trans_level_[i]->CloneBackend(*this->op_);
+
+            fine_size = this->op_level_[i]->GetM();
+        }
+
+        // Release the restriction operators in low memory mode
+        this->transpose_restriction_ = this->low_memory_;
+
+        if(this->transpose_restriction_ == true)
+        {
+            for(int i = 0; i < this->levels_ - 1; ++i)
+            {
+                this->restrict_op_level_[i]->Clear();
+            }
+        }
+
+        // Apply the piecewise constant transfer operators by their aggregate maps
+        this->BuildTransferMaps_();
+
+        // No setup time for hierarchies read from files
+        this->time_hierarchy_.assign(this->levels_ - 1, 0.0);
 
-        return this->levels_;
+        this->hierarchy_ = true;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -139,6 +901,15 @@ namespace rocalution
     {
         log_debug(this, "BaseAMG::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("BaseAMG::Build()");
+
+        if(this->UnchangedOperator_() == true)
+        {
+            log_debug(this, "BaseAMG::Build()", this->build_, " #*# end");
+
+            return;
+        }
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -146,9 +917,23 @@ namespace rocalution
 
         assert(this->build_ == false);
 
+        // Build the default smoothers while coarsening, if enabled
+        this->overlap_pass_ = this->overlap_setup_ == true && this->set_sm_ == false
+                              && this->workspace_ == NULL && this->graph_replay_ == false
+                              && !(this->cycle_ == Acycle && this->concurrent_levels_ > 1)
+                              && _rocalution_available_accelerator() == true
+                              && overlapped_setup_available(*this->op_) == true;
+
+        if(this->overlap_pass_ == true && this->setup_context_ == NULL)
+        {
+            this->setup_context_ = new ExecutionContext;
+        }
+
         // Build hierarchy
         this->BuildHierarchy();
 
+        this->overlap_pass_ = false;
+
         // Build smoothers, if not passed by the user
         if(this->set_sm_ == false)
         {
@@ -156,7 +941,21 @@ namespace rocalution
         }
 
         // Build coarse grid solver, if not passed by the user
-        if(this->set_s_ == false)
+        if(this->set_s_ == false && this->cs_type_ != CGCoarseSolver)
+        {
+            // Factorize the coarsest operator once
+            this->solver_coarse_ = direct_coarse_solver(
+                *this->op_level_[this->levels_ - 2], this->cs_type_, &this->cs_local_);
+
+            // No verbose output
+            this->solver_coarse_->Verbose(0);
+
+            if(this->cs_local_ != NULL)
+            {
+                this->cs_local_->Verbose(0);
+            }
+        }
+        else if(this->set_s_ == false)
         {
             // Coarse Grid Solver
             CG<OperatorType, VectorType, ValueType>* cgs
@@ -175,16 +974,16 @@ namespace rocalution
         this->Initialize();
 
         // Convert operator to op_format
-        if(this->op_format_ != CSR)
-        {
-            for(int i = 0; i < this->levels_ - 1; ++i)
-            {
-                this->op_level_[i]->ConvertTo(this->op_format_, this->op_blockdim_);
-            }
-        }
+        this->ConvertOperators_();
+
+        // Fused residual restriction operators
+        this->BuildFusedLevelOperations_();
 
         this->build_ = true;
 
+        // Place the coarsest levels on the host, if enabled
+        this->AutoHostLevels_();
+
         log_debug(this, "BaseAMG::Build()", this->build_, " #*# end");
     }
 
@@ -208,6 +1007,10 @@ namespace rocalution
                 FATAL_ERROR(__FILE__, __LINE__);
             }
 
+            // In low memory mode, the restriction of each level is released as soon as its
+            // coarse operator has been computed
+            this->transpose_restriction_ = this->low_memory_;
+
             // Lists for the building procedure
             std::list<OperatorType*>     op_list_;
             std::list<OperatorType*>     restrict_list_;
@@ -215,36 +1018,119 @@ namespace rocalution
             std::list<LocalVector<int>*> trans_list_;
 
             this->levels_ = 1;
+            this->time_hierarchy_.clear();
 
-            // Build finest hierarchy
-            op_list_.push_back(new OperatorType);
-            restrict_list_.push_back(new OperatorType);
-            prolong_list_.push_back(new OperatorType);
-            trans_list_.push_back(new LocalVector<int>);
-
-            op_list_.back()->CloneBackend(*this->op_);
-            restrict_list_.back()->CloneBackend(*this->op_);
-            prolong_list_.back()->CloneBackend(*this->op_);
-            trans_list_.back()->CloneBackend(*this->op_);
-
-            // Create prolongation and restriction operators
-            bool success = this->Aggregate_(*this->op_,
-                                            prolong_list_.back(),
-                                            restrict_list_.back(),
-                                            op_list_.back(),
-                                            trans_list_.back());
-
-            // The very first level is not allowed to fail
-            if(success == false)
             {
-                LOG_INFO("Could not build initial AMG level");
-                FATAL_ERROR(__FILE__, __LINE__);
+                double time_begin = rocalution_time();
+
+                // Allocations of the first coarse level
+                RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(1));
+
+                // Build finest hierarchy
+                op_list_.push_back(new OperatorType);
+                restrict_list_.push_back(new OperatorType);
+                prolong_list_.push_back(new OperatorType);
+                trans_list_.push_back(new LocalVector<int>);
+
+                op_list_.back()->CloneBackend(*this->op_);
+                restrict_list_.back()->CloneBackend(*this->op_);
+                prolong_list_.back()->CloneBackend(*this->op_);
+                trans_list_.back()->CloneBackend(*this->op_);
+
+                // Create prolongation and restriction operators
+                bool success = this->Aggregate_(*this->op_,
+                                                prolong_list_.back(),
+                                                restrict_list_.back(),
+                                                op_list_.back(),
+                                                trans_list_.back());
+
+                // The very first level is not allowed to fail
+                if(success == false)
+                {
+                    LOG_INFO("Could not build initial AMG level");
+                    FATAL_ERROR(__FILE__, __LINE__);
+                }
+
+                if(this->transpose_restriction_ == true)
+                {
+                    restrict_list_.back()->Clear();
+                }
+
+                // Aggressive coarsening, the first coarse level is coarsened once more. The
+                // composite transfer operators P1 * P2 and R2 * R1 are assembled, the
+                // intermediate level is dropped afterwards.
+                if(this->aggressive_ == true
+                   && op_list_.back()->GetM() > static_cast<int64_t>(this->coarse_size_))
+                {
+                    OperatorType*     pro    = new OperatorType;
+                    OperatorType*     res    = new OperatorType;
+                    OperatorType*     coarse = new OperatorType;
+                    LocalVector<int>* trans  = new LocalVector<int>;
+
+                    pro->CloneBackend(*this->op_);
+                    res->CloneBackend(*this->op_);
+                    coarse->CloneBackend(*this->op_);
+                    trans->CloneBackend(*this->op_);
+
+                    this->aggressive_pass_ = true;
+
+                    bool success = this->Aggregate_(*op_list_.back(), pro, res, coarse, trans);
+
+                    this->aggressive_pass_ = false;
+
+                    if(success == true)
+                    {
+                        OperatorType* pro_c = new OperatorType;
+                        pro_c->CloneBackend(*this->op_);
+                        pro_c->MatrixMult(*prolong_list_.back(), *pro);
+
+                        // The composite restriction is not required in low memory mode
+                        OperatorType* res_c = new OperatorType;
+                        res_c->CloneBackend(*this->op_);
+
+                        if(this->transpose_restriction_ == false)
+                        {
+                            res_c->MatrixMult(*res, *restrict_list_.back());
+                        }
+
+                        delete prolong_list_.back();
+                        delete restrict_list_.back();
+                        delete op_list_.back();
+                        delete trans_list_.back();
+                        delete pro;
+                        delete res;
+
+                        prolong_list_.back()  = pro_c;
+                        restrict_list_.back() = res_c;
+                        op_list_.back()       = coarse;
+                        trans_list_.back()    = trans;
+                    }
+                    else
+                    {
+                        delete pro;
+                        delete res;
+                        delete coarse;
+                        delete trans;
+
+                        LOG_VERBOSE_INFO(2,
+                                         "*** warning: BaseAMG::BuildHierarchy() Aggressive "
+                                         "coarsening of the first level failed");
+                    }
+                }
+
+                this->Sparsify_(1, op_list_.back());
+
+                this->time_hierarchy_.push_back(rocalution_time() - time_begin);
             }
 
             ++this->levels_;
 
             while(op_list_.back()->GetM() > static_cast<int64_t>(this->coarse_size_))
             {
+                RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(this->levels_));
+
+                double time_begin = rocalution_time();
+
                 // Add new list elements
                 restrict_list_.push_back(new OperatorType);
                 prolong_list_.push_back(new OperatorType);
@@ -257,12 +1143,49 @@ namespace rocalution
                 prolong_list_.back()->CloneBackend(*this->op_);
                 trans_list_.back()->CloneBackend(*this->op_);
 
+                // The smoother of the level preceding prev_op_ is built on a worker thread
+                // while prev_op_ is coarsened
+                std::thread sm_thread;
+                int         sm_level = this->levels_ - 2;
+
+                if(this->overlap_pass_ == true && sm_level > 0)
+                {
+                    OperatorType* sm_op = *std::prev(op_list_.end(), 3);
+
+                    this->sm_prebuilt_.resize(sm_level + 1, NULL);
+                    this->jac_prebuilt_.resize(sm_level + 1, NULL);
+                    this->smoother_prebuilt_.resize(sm_level + 1, false);
+                    this->time_smoother_build_.resize(sm_level + 1, 0.0);
+
+                    this->CreateDefaultSmoother_(&this->sm_prebuilt_[sm_level],
+                                                 &this->jac_prebuilt_[sm_level]);
+
+                    // The level is set up on its own handles and stream
+                    sm_op->SetExecutionContext(*this->setup_context_);
+
+                    sm_thread = std::thread([this, sm_level, sm_op]() {
+                        this->setup_context_->MakeCurrent();
+
+                        this->time_smoother_build_[sm_level] = this->BuildLevelSmoother_(
+                            sm_level, *sm_op, this->sm_prebuilt_[sm_level]);
+
+                        ExecutionContext::ReleaseCurrent();
+                    });
+                }
+
                 bool success = this->Aggregate_(*prev_op_,
                                                 prolong_list_.back(),
                                                 restrict_list_.back(),
                                                 op_list_.back(),
                                                 trans_list_.back());
 
+                if(sm_thread.joinable() == true)
+                {
+                    sm_thread.join();
+
+                    this->smoother_prebuilt_[sm_level] = true;
+                }
+
                 // Check if aggregation was successful
                 if(success == false)
                 {
@@ -285,6 +1208,16 @@ namespace rocalution
                     break;
                 }
 
+                if(this->transpose_restriction_ == true)
+                {
+                    restrict_list_.back()->Clear();
+                }
+
+                // The sparsified operator is coarsened further
+                this->Sparsify_(this->levels_, op_list_.back());
+
+                this->time_hierarchy_.push_back(rocalution_time() - time_begin);
+
                 ++this->levels_;
 
                 if(this->levels_ > 19)
@@ -320,6 +1253,9 @@ namespace rocalution
                 this->trans_level_[i] = *trans_it;
                 ++trans_it;
             }
+
+            // Apply the piecewise constant transfer operators by their aggregate maps
+            this->BuildTransferMaps_();
         }
 
         log_debug(this, "BaseAMG::BuildHierarchy()", " #*# end");
@@ -337,19 +1273,56 @@ namespace rocalution
 
         for(int i = 0; i < this->levels_ - 1; ++i)
         {
-            FixedPoint<OperatorType, VectorType, ValueType>* sm
+            // Smoothers that have been built with the hierarchy are taken over
+            if(i < static_cast<int>(this->sm_prebuilt_.size()) && this->sm_prebuilt_[i] != NULL)
+            {
+                this->smoother_level_[i] = this->sm_prebuilt_[i];
+                this->sm_default_[i]     = this->jac_prebuilt_[i];
+            }
+            else
+            {
+                this->CreateDefaultSmoother_(&this->smoother_level_[i], &this->sm_default_[i]);
+            }
+        }
+
+        this->sm_prebuilt_.clear();
+        this->jac_prebuilt_.clear();
+
+        log_debug(this, "BaseAMG::BuildSmoothers()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::CreateDefaultSmoother_(
+        IterativeLinearSolver<OperatorType, VectorType, ValueType>** sm,
+        Solver<OperatorType, VectorType, ValueType>**                jac) const
+    {
+        Jacobi<OperatorType, VectorType, ValueType>* precond
+            = new Jacobi<OperatorType, VectorType, ValueType>;
+
+        if(this->sm_type_ == ChebyshevSmoother)
+        {
+            Chebyshev<OperatorType, VectorType, ValueType>* cheb
+                = new Chebyshev<OperatorType, VectorType, ValueType>;
+
+            // The smoother targets the upper part of the (estimated) spectrum of
+            // the Jacobi preconditioned level operator
+            cheb->SetSpectrumEstimation(10, 1.1, 0.3);
+            cheb->SetPreconditioner(*precond);
+            cheb->Verbose(0);
+            *sm = cheb;
+        }
+        else
+        {
+            FixedPoint<OperatorType, VectorType, ValueType>* fp
                 = new FixedPoint<OperatorType, VectorType, ValueType>;
-            Jacobi<OperatorType, VectorType, ValueType>* jac
-                = new Jacobi<OperatorType, VectorType, ValueType>;
 
-            sm->SetRelaxation(static_cast<ValueType>(2.f / 3.f));
-            sm->SetPreconditioner(*jac);
-            sm->Verbose(0);
-            this->smoother_level_[i] = sm;
-            this->sm_default_[i]     = jac;
+            fp->SetRelaxation(static_cast<ValueType>(2.f / 3.f));
+            fp->SetPreconditioner(*precond);
+            fp->Verbose(0);
+            *sm = fp;
         }
 
-        log_debug(this, "BaseAMG::BuildSmoothers()", " #*# end");
+        *jac = precond;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -378,6 +1351,16 @@ namespace rocalution
             delete[] this->restrict_op_level_;
             delete[] this->prolong_op_level_;
 
+            // De-allocate aggregate maps
+            this->ClearTransferMaps_();
+
+            // Forget cached Galerkin product structures
+            if(this->galerkin_level_ != NULL)
+            {
+                delete[] this->galerkin_level_;
+                this->galerkin_level_ = NULL;
+            }
+
             // De-allocate smoothers, if not allocated by the user
             if(this->set_sm_ == false)
             {
@@ -395,12 +1378,322 @@ namespace rocalution
             if(this->set_s_ == false)
             {
                 delete this->solver_coarse_;
+                delete this->cs_local_;
+
+                this->cs_local_ = NULL;
+            }
+
+            this->levels_                = -1;
+            this->build_                 = false;
+            this->hierarchy_             = false;
+            this->transpose_restriction_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::ReBuildGalerkin_(void)
+    {
+        log_debug(this, "BaseAMG::ReBuildGalerkin_()", this->frozen_);
+
+        assert(this->levels_ > 1);
+        assert(this->op_ != NULL);
+
+        // The structures can only be reused, if the coarse operators stay in CSR format
+        bool frozen = this->frozen_ == true && this->op_format_ == CSR
+                      && this->op_autotune_ == false
+                      && galerkin_reuse_available(*this->op_) == true;
+
+        if(frozen == true && this->galerkin_level_ == NULL)
+        {
+            this->galerkin_level_ = new bool[this->levels_ - 1];
+
+            for(int i = 0; i < this->levels_ - 1; ++i)
+            {
+                this->galerkin_level_[i] = false;
+            }
+        }
+
+        // The Galerkin product of the finest level requires a CSR operator
+        OperatorType        op_csr;
+        const OperatorType* op_fine = this->op_;
+
+        if(this->op_->GetFormat() != CSR)
+        {
+            op_csr.CloneFrom(*this->op_);
+            op_csr.ConvertToCSR();
+            op_fine = &op_csr;
+        }
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            assert(this->restrict_op_level_[i] != NULL);
+            assert(this->prolong_op_level_[i] != NULL);
+
+            // Temporary transfer operators, if they are not stored
+            OperatorType        res_tmp;
+            OperatorType        pro_tmp;
+            const OperatorType* res = this->Restriction_(i, &res_tmp);
+            const OperatorType* pro = this->Prolongation_(i, &pro_tmp);
+
+            // The first host level requires its fine operator on the host
+            bool move_fine = (i > 0) && (i == this->levels_ - this->host_level_ - 1);
+
+            if(i > 0)
+            {
+                op_fine = this->op_level_[i - 1];
+            }
+
+            if(move_fine == true)
+            {
+                this->op_level_[i - 1]->MoveToHost();
+            }
+
+            // Sparsified operators do not match the cached structures
+            if(frozen == true && res->GetFormat() == CSR && pro->GetFormat() == CSR
+               && this->SparsificationDropOff_(i + 1) == 0.0)
+            {
+                // Only the values are computed, if the structure has been cached before
+                bool numeric = this->galerkin_level_[i];
+
+                this->op_level_[i]->CloneBackend(*this->restrict_op_level_[i]);
+
+                galerkin_product(*res, *op_fine, *pro, numeric, this->op_level_[i]);
+
+                this->galerkin_level_[i] = true;
+            }
+            else
+            {
+                // Create coarse operator
+                this->op_level_[i]->Clear();
+                this->op_level_[i]->ConvertToCSR();
+                this->op_level_[i]->CloneBackend(*this->op_);
+
+                this->op_level_[i]->TripleMatrixProduct(*res, *op_fine, *pro);
+
+                this->Sparsify_(i + 1, this->op_level_[i]);
+            }
+
+            if(move_fine == true)
+            {
+                this->op_level_[i - 1]->CloneBackend(*this->restrict_op_level_[i - 1]);
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    const OperatorType*
+        BaseAMG<OperatorType, VectorType, ValueType>::Restriction_(int           level,
+                                                                   OperatorType* tmp) const
+    {
+        log_debug(this, "BaseAMG::Restriction_()", level, tmp);
+
+        assert(tmp != NULL);
+
+        const OperatorType* pro = this->prolong_op_level_[level];
+        const OperatorType* res = this->restrict_op_level_[level];
+
+        assert(pro != NULL);
+        assert(res != NULL);
+
+        if(this->MatrixFreeLevel_(level) == true)
+        {
+            OperatorType pro_tmp;
+            this->TransferFromMap_(level, tmp, &pro_tmp);
+
+            return tmp;
+        }
+
+        if(this->transpose_restriction_ == false)
+        {
+            return res;
+        }
+
+        tmp->CloneBackend(*pro);
+        pro->Transpose(tmp);
+
+        return tmp;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    const OperatorType*
+        BaseAMG<OperatorType, VectorType, ValueType>::Prolongation_(int           level,
+                                                                    OperatorType* tmp) const
+    {
+        log_debug(this, "BaseAMG::Prolongation_()", level, tmp);
+
+        assert(tmp != NULL);
+
+        if(this->MatrixFreeLevel_(level) == false)
+        {
+            return this->prolong_op_level_[level];
+        }
+
+        OperatorType res_tmp;
+        this->TransferFromMap_(level, &res_tmp, tmp);
+
+        return tmp;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::BuildTransferMaps_(void)
+    {
+        log_debug(this, "BaseAMG::BuildTransferMaps_()", this->matrix_free_transfer_);
+
+        this->ClearTransferMaps_();
+
+        if(this->matrix_free_transfer_ == false)
+        {
+            return;
+        }
+
+        this->transfer_map_level_.assign(this->levels_ - 1, NULL);
+        this->transfer_weight_level_.assign(this->levels_ - 1, static_cast<ValueType>(1));
+        this->transfer_ncol_level_.assign(this->levels_ - 1, 0);
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            LocalVector<int>* map = new LocalVector<int>;
+            ValueType         weight;
+
+            if(this->prolong_op_level_[i]->ExtractAggregateMap(map, &weight) == false)
+            {
+                delete map;
+
+                continue;
             }
 
-            this->levels_    = -1;
-            this->build_     = false;
-            this->hierarchy_ = false;
+            this->transfer_map_level_[i]    = map;
+            this->transfer_weight_level_[i] = weight;
+            this->transfer_ncol_level_[i]   = this->prolong_op_level_[i]->GetLocalN();
+
+            // R = P^T for all aggregation schemes, both are given by the map
+            this->prolong_op_level_[i]->Clear();
+            this->restrict_op_level_[i]->Clear();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::ClearTransferMaps_(void)
+    {
+        log_debug(this, "BaseAMG::ClearTransferMaps_()");
+
+        for(size_t i = 0; i < this->transfer_map_level_.size(); ++i)
+        {
+            delete this->transfer_map_level_[i];
+        }
+
+        this->transfer_map_level_.clear();
+        this->transfer_weight_level_.clear();
+        this->transfer_ncol_level_.clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    bool BaseAMG<OperatorType, VectorType, ValueType>::MatrixFreeLevel_(int level) const
+    {
+        return level >= 0 && level < static_cast<int>(this->transfer_map_level_.size())
+               && this->transfer_map_level_[level] != NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::TransferFromMap_(int           level,
+                                                                        OperatorType* res,
+                                                                        OperatorType* pro) const
+    {
+        log_debug(this, "BaseAMG::TransferFromMap_()", level, res, pro);
+
+        assert(this->MatrixFreeLevel_(level) == true);
+        assert(res != NULL);
+        assert(pro != NULL);
+
+        LocalVector<int>* map = this->transfer_map_level_[level];
+
+        // The operators are formed where the released operators reside
+        map->CloneBackend(*this->prolong_op_level_[level]);
+        res->CloneBackend(*this->prolong_op_level_[level]);
+        pro->CloneBackend(*this->prolong_op_level_[level]);
+
+        res->CreateFromMap(*map, map->GetSize(), this->transfer_ncol_level_[level], pro);
+
+        ValueType weight = this->transfer_weight_level_[level];
+
+        if(weight != static_cast<ValueType>(1))
+        {
+            res->Scale(weight);
+            pro->Scale(weight);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::Restrict_(const VectorType& fine,
+                                                                 VectorType*       coarse)
+    {
+        log_debug(this, "BaseAMG::Restrict_()", (const void*&)fine, coarse);
+
+        if(this->MatrixFreeLevel_(this->current_level_) == true)
+        {
+            LocalVector<int>* map = this->transfer_map_level_[this->current_level_];
+
+            // Sum over the aggregates, the map follows the level vectors
+            map->CloneBackend(fine);
+            coarse->Restriction(fine, *map);
+
+            ValueType weight = this->transfer_weight_level_[this->current_level_];
+
+            if(weight != static_cast<ValueType>(1))
+            {
+                coarse->Scale(weight);
+            }
+
+            return;
+        }
+
+        if(this->transpose_restriction_ == true)
+        {
+            apply_transpose(*this->prolong_op_level_[this->current_level_], fine, coarse);
+
+            return;
+        }
+
+        BaseMultiGrid<OperatorType, VectorType, ValueType>::Restrict_(fine, coarse);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseAMG<OperatorType, VectorType, ValueType>::Prolong_(const VectorType& coarse,
+                                                                VectorType*       fine)
+    {
+        log_debug(this, "BaseAMG::Prolong_()", (const void*&)coarse, fine);
+
+        if(this->MatrixFreeLevel_(this->current_level_) == true)
+        {
+            LocalVector<int>* map = this->transfer_map_level_[this->current_level_];
+
+            // Broadcast the aggregate values
+            map->CloneBackend(*fine);
+            fine->Prolongation(coarse, *map);
+
+            ValueType weight = this->transfer_weight_level_[this->current_level_];
+
+            if(weight != static_cast<ValueType>(1))
+            {
+                fine->Scale(weight);
+            }
+
+            return;
         }
+
+        BaseMultiGrid<OperatorType, VectorType, ValueType>::Prolong_(coarse, fine);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    bool BaseAMG<OperatorType, VectorType, ValueType>::FusableLevel_(int level) const
+    {
+        // The restriction has to be stored explicitly
+        if(this->transpose_restriction_ == true || this->MatrixFreeLevel_(level) == true)
+        {
+            return false;
+        }
+
+        return BaseMultiGrid<OperatorType, VectorType, ValueType>::FusableLevel_(level);
     }
 
     // do nothing
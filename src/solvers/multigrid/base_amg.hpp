@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -24,10 +24,12 @@
 #ifndef ROCALUTION_BASE_AMG_HPP_
 #define ROCALUTION_BASE_AMG_HPP_
 
+#include "../../base/local_matrix.hpp"
 #include "../solver.hpp"
 #include "base_multigrid.hpp"
 #include "rocalution/export.hpp"
 
+#include <string>
 #include <vector>
 
 namespace rocalution
@@ -50,6 +52,19 @@ namespace rocalution
         SubtractWeakConnections = 1
     } LumpingStrategy;
 
+    typedef enum _smoother_type
+    {
+        JacobiSmoother    = 0,
+        ChebyshevSmoother = 1
+    } SmootherType;
+
+    typedef enum _coarse_solver_type
+    {
+        CGCoarseSolver           = 0,
+        DirectCoarseSolver       = 1,
+        SparseDirectCoarseSolver = 2
+    } CoarseSolverType;
+
     /** \ingroup solver_module
   * \class BaseAMG
   * \brief Base class for all algebraic multigrid solvers
@@ -101,14 +116,243 @@ namespace rocalution
         /** \brief Set the smoother operator format */
         ROCALUTION_EXPORT
         void SetDefaultSmootherFormat(unsigned int op_format);
+        /** \brief Set the type of the default smoothers
+        * \details
+        * \p JacobiSmoother (default) builds a damped Jacobi (FixedPoint) smoother on each
+        * level. \p ChebyshevSmoother builds a Jacobi preconditioned Chebyshev smoother,
+        * whose eigenvalue bounds are estimated on each level during the build.
+        */
+        ROCALUTION_EXPORT
+        void SetDefaultSmoother(SmootherType sm_type);
+        /** \brief Set the type of the default coarse grid solver
+        * \details
+        * \p CGCoarseSolver (default) builds an unpreconditioned CG solver on the coarsest
+        * level. \p DirectCoarseSolver factorizes the coarsest operator once with LU during
+        * the build. For GlobalMatrix hierarchies, the coarsest operator is gathered on each
+        * process (see Redundant) and factorized there, such that each coarse grid solve
+        * requires a single gather of the right-hand side instead of the global reductions
+        * of all CG iterations. The coarsest operator is not agglomerated onto a subset of
+        * the processes, each process holds all of it, thus the coarsest level should be
+        * small, see SetCoarsestLevel().
+        * \p SparseDirectCoarseSolver factorizes with SparseLU instead, which keeps the
+        * operator sparse and allows much larger coarsest levels. Its ordering and symbolic
+        * factorization are kept by ReBuildNumeric().
+        */
+        ROCALUTION_EXPORT
+        void SetDefaultCoarseSolver(CoarseSolverType cs_type);
         /** \brief Set the operator format */
         ROCALUTION_EXPORT
         void SetOperatorFormat(unsigned int op_format, int op_blockdim);
+        /** \brief Convert the coarse operators to the format with the fastest
+        * matrix-vector product, see LocalMatrix::ConvertToBest()
+        * \details
+        * If enabled, the format set with \p SetOperatorFormat() is ignored.
+        */
+        ROCALUTION_EXPORT
+        void SetOperatorAutoTune(bool autotune);
+        /** \brief Set the value storage of the coarse level products
+        * \details
+        * The coarse operators and the transfer operators of all levels are applied with
+        * their values rounded to \p storage, see LocalMatrix::SetSpMVStorage(). The
+        * multigrid cycle is dominated by the bandwidth bound products of the smoothers
+        * and the residuals, whereas the rounding error only perturbs the preconditioner.
+        * The operator on the finest level is not affected. Default is SpMVStorage_Full.
+        */
+        ROCALUTION_EXPORT
+        void SetOperatorSpMVStorage(SpMVStorage storage);
+        /** \brief Keep the hierarchy frozen in ReBuildNumeric()
+        * \details
+        * If the values of the operator change, but its sparsity pattern does not,
+        * \p SetFrozenHierarchy(true) lets ReBuildNumeric() reuse the structures of the
+        * Galerkin products. The aggregates, the prolongation and the restriction operators
+        * are kept from Build(). The first ReBuildNumeric() computes the structures of the
+        * coarse operators, all subsequent calls only recompute their values (numeric
+        * triple matrix products R * A * P) and refactorize the smoothers.
+        * The sparsity pattern is reused only for LocalMatrix operators with CSR operator
+        * format, otherwise the Galerkin products are recomputed from scratch.
+        */
+        ROCALUTION_EXPORT
+        void SetFrozenHierarchy(bool frozen);
+        /** \brief Update the hierarchy after a localized change of the operator
+        * \details
+        * \p UpdateHierarchy refreshes the hierarchy after the values of the \p nrow rows
+        * \p rows (local row indices, host array) of the operator have changed, whereas
+        * its sparsity pattern is unchanged. As in ReBuildNumeric() with a frozen
+        * hierarchy, the aggregates and the transfer operators are kept from Build(). On
+        * each level, only the rows of the coarse operator whose restriction touches a
+        * modified row of the finer level are recomputed, which are in turn the modified
+        * rows of the next level. The smoothers and the coarse grid solver are then
+        * rebuilt numerically.
+        *
+        * Localized updates require SetFrozenHierarchy(true), LocalMatrix operators in
+        * CSR format and CSR coarse operators. The first call
+        * after Build() performs a complete ReBuildNumeric() to compute the structures of
+        * the coarse operators. Whenever a localized update is not possible, e.g. for
+        * RugeStuebenAMG or PairwiseAMG, ReBuildNumeric() is called instead.
+        *
+        * \par Example
+        * \code{.cpp}
+        *   amg.SetFrozenHierarchy(true);
+        *   amg.Build();
+        *
+        *   // Update the values of rows[0], ..., rows[nrow - 1]
+        *   mat.UpdateValuesCSR(val);
+        *
+        *   amg.UpdateHierarchy(nrow, rows);
+        * \endcode
+        */
+        ROCALUTION_EXPORT
+        void UpdateHierarchy(int nrow, const int* rows);
+        /** \brief Skip the setup if the operator did not change
+        * \details
+        * With \p SetSkipUnchangedBuild(true), Build(), ReBuildNumeric() and
+        * UpdateHierarchy() of an already built hierarchy compare a hash of the operator
+        * (see LocalMatrix::Hash()) to the hash of the operator of the previous setup and
+        * return immediately if the sizes, the sparsity pattern and all values are
+        * identical. Computing the hash costs about one sweep over the operator, which is
+        * negligible compared to the setup. Changes of the AMG parameters are not
+        * detected, thus the check is disabled by default. GlobalMatrix operators are
+        * always set up.
+        */
+        ROCALUTION_EXPORT
+        void SetSkipUnchangedBuild(bool skip);
+        /** \brief Coarsen the first level aggressively
+        * \details
+        * With \p SetAggressiveCoarsening(true), BuildHierarchy() coarsens the first
+        * coarse level once more (two-pass coarsening). The finest level is then directly
+        * followed by the operator \f$A_{2} = R_{2} R_{1} A P_{1} P_{2}\f$, no smoothing is
+        * performed on the intermediate level. The composite transfer operators
+        * \f$P = P_{1} P_{2}\f$ and \f$R = R_{2} R_{1}\f$ are assembled by
+        * LocalMatrix::MatrixMult() or GlobalMatrix::MatrixMult(), the intermediate
+        * level is not stored. This reduces the number of rows per process on the coarse levels of distributed
+        * hierarchies much faster. Not supported by PairwiseAMG.
+        */
+        ROCALUTION_EXPORT
+        void SetAggressiveCoarsening(bool aggressive);
+        /** \brief Reduce the memory footprint of the hierarchy
+        * \details
+        * With \p SetLowMemorySetup(true), the restriction operator of each level is
+        * released right after its coarse operator has been computed, and the restriction
+        * is applied as transposed prolongation \f$P^{T}\f$ in the cycles instead. Whenever
+        * the restriction is required afterwards (ReBuildNumeric(), SaveHierarchy()), it is
+        * formed temporarily for one level at a time. This lowers the peak memory of the
+        * setup and the memory of the hierarchy at the cost of slower restrictions. For
+        * GlobalMatrix operators, the transposed prolongation exchanges the contributions
+        * to the ghost columns of \f$P\f$ with the neighboring processes.
+        */
+        ROCALUTION_EXPORT
+        void SetLowMemorySetup(bool low_memory);
+        /** \brief Apply piecewise constant transfer operators without matrices
+        * \details
+        * The prolongation of unsmoothed aggregation (UAAMG, PairwiseAMG) has a single
+        * non-zero per row, i.e. it is fully described by the aggregate of each fine
+        * point. With \p SetMatrixFreeTransfer(true), BuildHierarchy() extracts this
+        * aggregate map (see LocalMatrix::ExtractAggregateMap()) and releases the
+        * prolongation and the restriction operators of all levels where this is possible.
+        * The cycles then restrict by summing over the aggregates and prolong by
+        * broadcasting the aggregate values, see LocalVector::Restriction() and
+        * LocalVector::Prolongation(). Whenever the operators are required afterwards
+        * (ReBuildNumeric(), SaveHierarchy()), they are formed temporarily from the map.
+        * Levels with non-constant transfer operators and GlobalMatrix levels whose
+        * prolongation couples to the aggregates of other processes keep their operators.
+        */
+        ROCALUTION_EXPORT
+        void SetMatrixFreeTransfer(bool matrix_free);
+        /** \brief Build the default smoothers while the hierarchy is coarsened
+        * \details
+        * With \p SetOverlappedSetup(true), Build() sets up the default smoother of level
+        * \f$k\f$ on a worker thread while the main thread coarsens level \f$k+1\f$. The
+        * coarse level operators are attached to an internal ExecutionContext, such that
+        * the smoother setup runs on its own rocBLAS and rocSPARSE handles and stream. The
+        * remaining smoothers are built by Initialize() as usual. The overlap is only
+        * applied to LocalMatrix operators and default smoothers. It is not applied with a
+        * SolverWorkspace, with graph replay or with concurrent level corrections of the
+        * additive cycle. The operator must not be attached to an ExecutionContext by the
+        * user.
+        */
+        ROCALUTION_EXPORT
+        void SetOverlappedSetup(bool overlap);
+        /** \brief Sparsify the coarse operators (non-Galerkin coarse operators)
+        * \details
+        * With \p SetCoarseSparsification, the coarse operator of a level is sparsified
+        * right after its Galerkin product has been computed, and before it is coarsened
+        * any further. All off-diagonal entries with
+        * \f$|a_{ij}| \leq drop\_off \sqrt{|a_{ii} a_{jj}|}\f$ are dropped and added to the
+        * diagonal, such that the row sums of the coarse operator are preserved, see
+        * LocalMatrix::CompressLumped(). This limits the growth of the coarse operator
+        * fill and thus the cost of the coarse level SpMVs and halo exchanges, at the
+        * price of a weaker coarse grid correction. \p level selects the coarse level, where
+        * level 1 is the first coarse level; with \p level = -1, \p drop_off applies to
+        * all coarse levels that have not been set explicitly. A \p drop_off of zero (the
+        * default) disables the sparsification. Sparsified levels do not reuse the Galerkin
+        * structures of SetFrozenHierarchy(). Only supported for LocalMatrix operators.
+        *
+        * Coarse operators of smoothed aggregation have many small entries, thresholds
+        * should be well below the strength of connection. Rows of zero row sum, whose
+        * off-diagonal entries are all dropped, end up with a zero diagonal entry.
+        *
+        * \par Example
+        * \code{.cpp}
+        *   // Sparsify all coarse levels, except for the first one
+        *   amg.SetCoarseSparsification(0.01);
+        *   amg.SetCoarseSparsification(0.0, 1);
+        * \endcode
+        */
+        ROCALUTION_EXPORT
+        void SetCoarseSparsification(double drop_off, int level = -1);
 
         /** \brief Returns the number of levels in hierarchy */
         ROCALUTION_EXPORT
         int GetNumLevels(void);
 
+        /** \brief Return the setup time (in seconds) of the coarse operator of \p level
+        * \details
+        * \p GetHierarchyTime returns the time spent in the coarsening, the interpolation
+        * and the Galerkin product that create the transfer operators of \p level and the
+        * operator of level \p level + 1, where level 0 is the finest level. The smoother
+        * build time is returned by GetLevelTime().
+        */
+        ROCALUTION_EXPORT
+        double GetHierarchyTime(int level) const;
+
+        /** \brief Return the operator and the grid complexity of the hierarchy
+        * \details
+        * \p GetComplexity returns the sum of the non-zeros (operator complexity) and of
+        * the rows (grid complexity) of the operators of all levels, relative to the fine
+        * operator. Both are computed from the sizes of the operators, nothing is copied.
+        * The hierarchy has to be created by BuildHierarchy() or Build() before.
+        */
+        ROCALUTION_EXPORT
+        void GetComplexity(double* operator_complexity, double* grid_complexity) const;
+
+        /** \brief Write the AMG hierarchy to files
+        * \details
+        * \p SaveHierarchy writes the coarse operators, the prolongation and the restriction
+        * operators of all levels into compressed rocSPARSE I/O files. The head file
+        * \p filename holds the number of levels, the level files are named
+        * \p filename.level.[i].op, \p filename.level.[i].pro and \p filename.level.[i].res.
+        * The hierarchy has to be created by BuildHierarchy() or Build() before. Only
+        * LocalMatrix operators are supported.
+        */
+        ROCALUTION_EXPORT
+        void SaveHierarchy(const std::string& filename) const;
+        /** \brief Read an AMG hierarchy from files
+        * \details
+        * \p LoadHierarchy replaces BuildHierarchy() by an AMG hierarchy, that has been
+        * written by SaveHierarchy() for the same operator before. Build() then only creates
+        * the smoothers and the coarse grid solver from the loaded operators. The operator
+        * has to be set before.
+        *
+        * \par Example
+        * \code{.cpp}
+        *   amg.SetOperator(mat);
+        *   amg.LoadHierarchy("amg.hierarchy");
+        *   amg.Build();
+        * \endcode
+        */
+        ROCALUTION_EXPORT
+        void LoadHierarchy(const std::string& filename);
+
         /** \private */
         virtual void SetRestrictOperator(OperatorType** op);
         /** \private */
@@ -125,6 +369,52 @@ namespace rocalution
                                 LocalVector<int>*   trans)
             = 0;
 
+        /** \brief Convert the coarse operators to the operator format or tune it */
+        void ConvertOperators_(void);
+        /** \brief Recompute the coarse operators of all levels (Galerkin products) */
+        void ReBuildGalerkin_(void);
+        /** \brief Return the restriction operator of a level
+        * \details
+        * If the restriction is not stored, it is formed into \p tmp as the transposed
+        * prolongation.
+        */
+        const OperatorType* Restriction_(int level, OperatorType* tmp) const;
+        /** \brief Return the prolongation operator of a level
+        * \details
+        * If the prolongation is not stored, it is formed into \p tmp from the aggregate
+        * map of the level.
+        */
+        const OperatorType* Prolongation_(int level, OperatorType* tmp) const;
+        /** \brief Extract the aggregate maps and release the transfer operators, see
+        * SetMatrixFreeTransfer()
+        */
+        void BuildTransferMaps_(void);
+        /** \brief Release the aggregate maps */
+        void ClearTransferMaps_(void);
+        /** \brief Return true, if the transfer operators of \p level are applied by
+        * their aggregate map
+        */
+        bool MatrixFreeLevel_(int level) const;
+        /** \brief Form the restriction and the prolongation of a level from its aggregate
+        * map
+        */
+        void TransferFromMap_(int level, OperatorType* res, OperatorType* pro) const;
+        /** \brief Return true, if the setup can be skipped because the operator is
+        * identical to the operator of the previous setup, see SetSkipUnchangedBuild()
+        */
+        bool UnchangedOperator_(void);
+        /** \brief Create a default smoother \p sm with its Jacobi preconditioner \p jac */
+        void CreateDefaultSmoother_(IterativeLinearSolver<OperatorType, VectorType, ValueType>** sm,
+                                    Solver<OperatorType, VectorType, ValueType>** jac) const;
+        /** \brief Return the sparsification drop off of coarse level \p level */
+        double SparsificationDropOff_(int level) const;
+        /** \brief Sparsify the coarse operator \p op of coarse level \p level */
+        void Sparsify_(int level, OperatorType* op) const;
+
+        virtual void Restrict_(const VectorType& fine, VectorType* coarse);
+        virtual void Prolong_(const VectorType& coarse, VectorType* fine);
+        virtual bool FusableLevel_(int level) const;
+
         /** \brief Maximal coarse grid size */
         int coarse_size_;
 
@@ -141,10 +431,68 @@ namespace rocalution
 
         /** \brief Smoother operator format */
         unsigned int sm_format_;
+        /** \brief Type of the default smoothers */
+        SmootherType sm_type_;
+        /** \brief Type of the default coarse grid solver */
+        CoarseSolverType cs_type_;
+        /** \brief Local solver of the gathered coarsest operator, if any */
+        Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>* cs_local_;
         /** \brief Operator format */
         unsigned int op_format_;
         /** \brief Operator block dimension */
         int op_blockdim_;
+        /** \brief Select the operator formats with LocalMatrix::ConvertToBest() */
+        bool op_autotune_;
+        /** \brief Value storage of the coarse level products */
+        SpMVStorage op_storage_;
+
+        /** \brief Reuse the structures of the Galerkin products in ReBuildNumeric() */
+        bool frozen_;
+        /** \brief Levels with cached coarse operator structures */
+        bool* galerkin_level_;
+
+        /** \brief Skip the setup of an unchanged operator */
+        bool skip_unchanged_;
+        /** \brief Operator and its hash at the previous setup */
+        const OperatorType* op_hashed_;
+        uint64_t            op_hash_;
+
+        /** \brief Coarsen the first level aggressively */
+        bool aggressive_;
+        /** \brief Set while the second coarsening pass of the first level is built */
+        bool aggressive_pass_;
+
+        /** \brief Release the restriction operators after the setup */
+        bool low_memory_;
+        /** \brief Restriction operators are not stored, but applied as transposed
+        * prolongations */
+        bool transpose_restriction_;
+
+        /** \brief Apply piecewise constant transfer operators by their aggregate maps */
+        bool matrix_free_transfer_;
+        /** \brief Aggregate map (NULL, if the operators are stored), weight and number of
+        * aggregates of each level
+        */
+        std::vector<LocalVector<int>*> transfer_map_level_;
+        std::vector<ValueType>         transfer_weight_level_;
+        std::vector<int64_t>           transfer_ncol_level_;
+
+        /** \brief Build the default smoothers while coarsening, see SetOverlappedSetup() */
+        bool overlap_setup_;
+        /** \brief Set while BuildHierarchy() builds the default smoothers concurrently */
+        bool overlap_pass_;
+        /** \brief Execution context of the levels whose smoothers are built concurrently */
+        ExecutionContext* setup_context_;
+        /** \brief Default smoothers and their preconditioners built by BuildHierarchy() */
+        std::vector<IterativeLinearSolver<OperatorType, VectorType, ValueType>*> sm_prebuilt_;
+        std::vector<Solver<OperatorType, VectorType, ValueType>*>                jac_prebuilt_;
+
+        /** \brief Sparsification drop off of all coarse levels and of single levels */
+        double              sparsify_;
+        std::vector<double> sparsify_level_;
+
+        /** \brief Setup time of the coarse operator of each level (in usec) */
+        std::vector<double> time_hierarchy_;
     };
 
 } // namespace rocalution
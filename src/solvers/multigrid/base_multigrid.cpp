@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -33,13 +33,166 @@
 
 #include "../../utils/log.hpp"
 #include "../../utils/math_functions.hpp"
+#include "../../utils/time_functions.hpp"
 
+#include <algorithm>
 #include <complex>
 #include <math.h>
+#include <sstream>
 
 namespace rocalution
 {
 
+    // Fused residual restriction operator RA = R * A, computed in CSR format
+    template <typename ValueType>
+    static bool fused_restriction_product(const LocalMatrix<ValueType>& R,
+                                          const LocalMatrix<ValueType>& A,
+                                          LocalMatrix<ValueType>*       RA)
+    {
+        LocalMatrix<ValueType> R_csr;
+        LocalMatrix<ValueType> A_csr;
+
+        const LocalMatrix<ValueType>* R_ptr = &R;
+        const LocalMatrix<ValueType>* A_ptr = &A;
+
+        if(R.GetFormat() != CSR)
+        {
+            R_csr.CloneFrom(R);
+            R_csr.ConvertToCSR();
+            R_ptr = &R_csr;
+        }
+
+        if(A.GetFormat() != CSR)
+        {
+            A_csr.CloneFrom(A);
+            A_csr.ConvertToCSR();
+            A_ptr = &A_csr;
+        }
+
+        RA->CloneBackend(R);
+        RA->MatrixMult(*R_ptr, *A_ptr);
+
+        return true;
+    }
+
+    // GlobalMatrix does not support the fused residual restriction
+    template <typename ValueType>
+    static bool fused_restriction_product(const GlobalMatrix<ValueType>& R,
+                                          const GlobalMatrix<ValueType>& A,
+                                          GlobalMatrix<ValueType>*       RA)
+    {
+        return false;
+    }
+
+    // Average time (in usec) of an operator application
+    template <typename ValueType>
+    static double apply_time(const LocalMatrix<ValueType>& op, int trials)
+    {
+        LocalVector<ValueType> in;
+        LocalVector<ValueType> out;
+
+        in.CloneBackend(op);
+        out.CloneBackend(op);
+
+        in.Allocate("in", op.GetN());
+        out.Allocate("out", op.GetM());
+
+        in.Ones();
+
+        // Warm up
+        op.Apply(in, &out);
+
+        double time_begin = rocalution_time();
+
+        for(int i = 0; i < trials; ++i)
+        {
+            op.Apply(in, &out);
+        }
+
+        return (rocalution_time() - time_begin) / trials;
+    }
+
+    // Time saved per application (in usec), if the operator is applied on the host
+    // instead of its current backend
+    template <typename ValueType>
+    static double host_saving(const LocalMatrix<ValueType>& op, int trials)
+    {
+        LocalMatrix<ValueType> op_host;
+        op_host.CloneFrom(op);
+        op_host.MoveToHost();
+
+        return apply_time(op, trials) - apply_time(op_host, trials);
+    }
+
+    // Time (in usec) to transfer a vector of the operator size to the host and back
+    template <typename ValueType>
+    static double transfer_time(const LocalMatrix<ValueType>& op)
+    {
+        LocalVector<ValueType> vec;
+
+        vec.CloneBackend(op);
+        vec.Allocate("transfer", op.GetM());
+
+        double time_begin = rocalution_time();
+
+        vec.MoveToHost();
+        vec.CloneBackend(op);
+
+        return rocalution_time() - time_begin;
+    }
+
+    // GlobalMatrix levels are not timed, as all processes would need to agree on the
+    // host levels
+    template <typename ValueType>
+    static bool auto_host_levels_available(const LocalMatrix<ValueType>& op)
+    {
+        return true;
+    }
+
+    template <typename ValueType>
+    static bool auto_host_levels_available(const GlobalMatrix<ValueType>& op)
+    {
+        return false;
+    }
+
+    // The level corrections of GlobalMatrix levels exchange their halos, which is
+    // serialized between host threads
+    template <typename ValueType>
+    static bool concurrent_levels_available(const LocalMatrix<ValueType>& op)
+    {
+        return true;
+    }
+
+    template <typename ValueType>
+    static bool concurrent_levels_available(const GlobalMatrix<ValueType>& op)
+    {
+        return false;
+    }
+
+    // Only levels of global operators communicate
+    template <typename ValueType>
+    static void communication_info(const LocalMatrix<ValueType>& op)
+    {
+    }
+
+    template <typename ValueType>
+    static void communication_info(const GlobalMatrix<ValueType>& op)
+    {
+        op.CommunicationInfo();
+    }
+
+    template <typename ValueType>
+    static double host_saving(const GlobalMatrix<ValueType>& op, int trials)
+    {
+        return 0.0;
+    }
+
+    template <typename ValueType>
+    static double transfer_time(const GlobalMatrix<ValueType>& op)
+    {
+        return 0.0;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     BaseMultiGrid<OperatorType, VectorType, ValueType>::BaseMultiGrid()
     {
@@ -52,11 +205,13 @@ namespace rocalution
         this->iter_post_smooth_ = 1;
 
         this->scaling_ = false;
+        this->fused_   = false;
 
         this->op_level_ = NULL;
 
         this->restrict_op_level_ = NULL;
         this->prolong_op_level_  = NULL;
+        this->fused_op_level_    = NULL;
 
         this->d_level_ = NULL;
         this->r_level_ = NULL;
@@ -64,13 +219,29 @@ namespace rocalution
         this->s_level_ = NULL;
         this->q_level_ = NULL;
 
+        this->mr_level_ = NULL;
+        this->mt_level_ = NULL;
+        this->md_level_ = NULL;
+
         this->solver_coarse_  = NULL;
         this->smoother_level_ = NULL;
 
         this->cycle_      = Vcycle;
-        this->host_level_ = 0;
+        this->host_level_      = 0;
+        this->auto_host_level_ = false;
+
+        this->kcycle_full_       = true;
+        this->cycle_switch_size_ = 0;
+        this->kcycle_fixed_size_ = 0;
+        this->kcycle_alpha_      = static_cast<ValueType>(1);
+        this->kcycle_beta_       = static_cast<ValueType>(1);
+        this->mult_additive_     = false;
 
-        this->kcycle_full_ = true;
+        this->concurrent_levels_ = 1;
+        this->num_contexts_      = 0;
+        this->contexts_          = NULL;
+
+        this->level_timing_ = false;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -79,6 +250,18 @@ namespace rocalution
         log_debug(this, "BaseMultiGrid::~BaseMultiGrid()", "destructor");
 
         this->Clear();
+
+        // Contexts have to outlive the attached level operators, which are released by
+        // the derived classes before
+        if(this->contexts_ != NULL)
+        {
+            for(int c = 0; c < this->num_contexts_; ++c)
+            {
+                delete this->contexts_[c];
+            }
+
+            delete[] this->contexts_;
+        }
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -113,6 +296,23 @@ namespace rocalution
         this->smoother_level_ = smoother;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetGraphReplay(bool onoff)
+    {
+        log_debug(this, "BaseMultiGrid::SetGraphReplay()", onoff);
+
+        this->graph_replay_ = onoff;
+
+        // Smoothers of a built hierarchy, otherwise they are set in Initialize()
+        if(this->build_ == true && this->smoother_level_ != NULL)
+        {
+            for(int i = 0; i < this->levels_ - 1; ++i)
+            {
+                this->smoother_level_[i]->SetGraphReplay(onoff);
+            }
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetSmootherPreIter(int iter)
     {
@@ -157,6 +357,22 @@ namespace rocalution
         }
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetFusedLevelOperations(bool fused)
+    {
+        log_debug(this, "BaseMultiGrid::SetFusedLevelOperations()", fused);
+
+        // The fused operators are computed during the build
+        if(this->build_ == true)
+        {
+            LOG_VERBOSE_INFO(2, "*** warning: Fused level operations must be set before building");
+        }
+        else
+        {
+            this->fused_ = fused;
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetHostLevels(int levels)
     {
@@ -176,6 +392,14 @@ namespace rocalution
         this->MoveHostLevels_();
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetAutoHostLevels(bool automatic)
+    {
+        log_debug(this, "BaseMultiGrid::SetAutoHostLevels()", automatic);
+
+        this->auto_host_level_ = automatic;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetCycle(unsigned int cycle)
     {
@@ -184,6 +408,25 @@ namespace rocalution
         this->cycle_ = cycle;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetMultAdditive(bool mult_additive)
+    {
+        log_debug(this, "BaseMultiGrid::SetMultAdditive()", mult_additive);
+
+        this->mult_additive_ = mult_additive;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetConcurrentLevels(int num)
+    {
+        log_debug(this, "BaseMultiGrid::SetConcurrentLevels()", num);
+
+        assert(this->build_ == false);
+        assert(num > 0);
+
+        this->concurrent_levels_ = num;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetKcycleFull(bool kcycle_full)
     {
@@ -193,165 +436,464 @@ namespace rocalution
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
-    void BaseMultiGrid<OperatorType, VectorType, ValueType>::Print(void) const
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetCycleSwitchSize(int64_t nrow)
     {
-        LOG_INFO("MultiGrid solver");
+        log_debug(this, "BaseMultiGrid::SetCycleSwitchSize()", nrow);
+
+        assert(nrow >= 0);
+
+        this->cycle_switch_size_ = nrow;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
-    void BaseMultiGrid<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetKcycleFixedCoefficients(
+        int64_t nrow, ValueType alpha, ValueType beta)
     {
-        assert(this->levels_ > 0);
+        log_debug(this, "BaseMultiGrid::SetKcycleFixedCoefficients()", nrow, alpha, beta);
 
-        LOG_INFO("MultiGrid solver starts");
-        LOG_INFO("MultiGrid Number of levels " << this->levels_);
-        LOG_INFO("MultiGrid with smoother:");
-        this->smoother_level_[0]->Print();
+        assert(nrow >= 0);
+
+        this->kcycle_fixed_size_ = nrow;
+        this->kcycle_alpha_      = alpha;
+        this->kcycle_beta_       = beta;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
-    void BaseMultiGrid<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SetLevelTiming(bool timing)
     {
-        LOG_INFO("MultiGrid ends");
+        log_debug(this, "BaseMultiGrid::SetLevelTiming()", timing);
+
+        this->level_timing_ = timing;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
-    void BaseMultiGrid<OperatorType, VectorType, ValueType>::Initialize(void)
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::GetLevelTime(int     level,
+                                                                          double* smoother_build,
+                                                                          double* smoothing,
+                                                                          double* residual,
+                                                                          double* transfer) const
     {
-        log_debug(this, "BaseMultiGrid::Initialize()", " #*# begin");
-
-        assert(this->build_ == false);
+        log_debug(this,
+                  "BaseMultiGrid::GetLevelTime()",
+                  level,
+                  smoother_build,
+                  smoothing,
+                  residual,
+                  transfer);
 
-        // Initialize smoothers
-        assert(this->smoother_level_ != NULL);
-
-        // Finest level 0
-        assert(this->smoother_level_[0] != NULL);
+        assert(this->build_ == true);
+        assert(level >= 0);
+        assert(level < static_cast<int>(this->time_smoothing_.size()));
 
-        this->smoother_level_[0]->SetOperator(*this->op_);
-        this->smoother_level_[0]->Build();
-        this->smoother_level_[0]->FlagSmoother();
+        if(smoother_build != NULL)
+        {
+            *smoother_build = this->time_smoother_build_[level] / 1e6;
+        }
 
-        // Coarse levels
-        for(int i = 1; i < this->levels_ - 1; ++i)
+        if(smoothing != NULL)
         {
-            assert(this->smoother_level_[i] != NULL);
+            *smoothing = this->time_smoothing_[level] / 1e6;
+        }
 
-            this->smoother_level_[i]->SetOperator(*this->op_level_[i - 1]);
-            this->smoother_level_[i]->Build();
-            this->smoother_level_[i]->FlagSmoother();
+        if(residual != NULL)
+        {
+            *residual = this->time_residual_[level] / 1e6;
         }
 
-        // Initialize coarse grid solver
-        assert(this->solver_coarse_ != NULL);
+        if(transfer != NULL)
+        {
+            *transfer = this->time_transfer_[level] / 1e6;
+        }
+    }
 
-        this->solver_coarse_->SetOperator(*op_level_[this->levels_ - 2]);
-        this->solver_coarse_->Build();
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::ResetLevelTime(void)
+    {
+        log_debug(this, "BaseMultiGrid::ResetLevelTime()");
 
-        // Setup all temporary vectors for the cycles - needed on all levels
-        this->d_level_ = new VectorType*[this->levels_];
-        this->r_level_ = new VectorType*[this->levels_];
-        this->t_level_ = new VectorType*[this->levels_];
+        std::fill(this->time_smoothing_.begin(), this->time_smoothing_.end(), 0.0);
+        std::fill(this->time_residual_.begin(), this->time_residual_.end(), 0.0);
+        std::fill(this->time_transfer_.begin(), this->time_transfer_.end(), 0.0);
+    }
 
-        // Extra vector for scaling
-        if(this->scaling_)
+    template <class OperatorType, class VectorType, typename ValueType>
+    double BaseMultiGrid<OperatorType, VectorType, ValueType>::LevelTimer_(
+        std::vector<double>* time, double begin)
+    {
+        if(this->level_timing_ == false)
         {
-            this->s_level_ = new VectorType*[this->levels_];
+            return 0.0;
+        }
 
-            this->s_level_[0] = new VectorType;
-            this->s_level_[0]->CloneBackend(*this->op_);
-            this->s_level_[0]->Allocate("temporary", this->op_->GetM());
+        double now = rocalution_time();
 
-            for(int i = 1; i < this->levels_; ++i)
-            {
-                this->s_level_[i] = new VectorType;
-                this->s_level_[i]->CloneBackend(*this->op_level_[i - 1]);
-                this->s_level_[i]->Allocate("temporary", this->op_level_[i - 1]->GetM());
-            }
+        if(time != NULL)
+        {
+            (*time)[this->current_level_] += now - begin;
         }
 
-        // Extra vector for K-cycle
-        if(this->cycle_ == Kcycle)
+        return now;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("MultiGrid solver");
+        this->PrintMemory_();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::CommunicationInfo(void) const
+    {
+        log_debug(this, "BaseMultiGrid::CommunicationInfo()");
+
+        for(int i = 0; i < this->levels_; ++i)
         {
-            this->q_level_ = new VectorType*[this->levels_ - 2];
+            const OperatorType* op = this->op_;
 
-            for(int i = 0; i < this->levels_ - 2; ++i)
+            if(i > 0)
             {
-                this->q_level_[i] = new VectorType;
-                this->q_level_[i]->CloneBackend(*this->op_level_[i]);
-                this->q_level_[i]->Allocate("q", this->op_level_[i]->GetM());
+                op = (this->op_level_ != NULL) ? this->op_level_[i - 1] : NULL;
             }
-        }
-
-        for(int i = 1; i < this->levels_; ++i)
-        {
-            // On finest level, we need to get the size from this->op_ instead
-            this->d_level_[i] = new VectorType;
-            this->d_level_[i]->CloneBackend(*this->op_level_[i - 1]);
-            this->d_level_[i]->Allocate("defect correction", this->op_level_[i - 1]->GetM());
 
-            this->r_level_[i] = new VectorType;
-            this->r_level_[i]->CloneBackend(*this->op_level_[i - 1]);
-            this->r_level_[i]->Allocate("residual", this->op_level_[i - 1]->GetM());
+            if(op == NULL)
+            {
+                break;
+            }
 
-            this->t_level_[i] = new VectorType;
-            this->t_level_[i]->CloneBackend(*this->op_level_[i - 1]);
-            this->t_level_[i]->Allocate("temporary", this->op_level_[i - 1]->GetM());
+            LOG_INFO("MultiGrid level " << i);
+            communication_info(*op);
         }
+    }
 
-        this->r_level_[0] = new VectorType;
-        this->r_level_[0]->CloneBackend(*this->op_);
-        this->r_level_[0]->Allocate("residual", this->op_->GetM());
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+    {
+        assert(this->levels_ > 0);
 
-        this->t_level_[0] = new VectorType;
-        this->t_level_[0]->CloneBackend(*this->op_);
-        this->t_level_[0]->Allocate("temporary", this->op_->GetM());
+        LOG_INFO("MultiGrid solver starts");
+        LOG_INFO("MultiGrid Number of levels " << this->levels_);
+        LOG_INFO("MultiGrid with smoother:");
+        this->smoother_level_[0]->Print();
+    }
 
-        log_debug(this, "BaseMultiGrid::Initialize()", " #*# end");
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+    {
+        LOG_INFO("MultiGrid ends");
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
-    void BaseMultiGrid<OperatorType, VectorType, ValueType>::Build(void)
+    std::string BaseMultiGrid<OperatorType, VectorType, ValueType>::LogTree(void) const
     {
-        log_debug(this, "BaseMultiGrid::Build()", this->build_, " #*# begin");
+        std::ostringstream tree;
 
-        if(this->build_ == true)
+        tree << "{\"name\": \"" << this->LogName_() << "\", \"levels\": [";
+
+        for(int i = 0; i < this->levels_; ++i)
         {
-            this->Clear();
+            const OperatorType* op = this->op_;
+
+            if(i > 0)
+            {
+                op = (this->op_level_ != NULL) ? this->op_level_[i - 1] : NULL;
+            }
+
+            if(op == NULL)
+            {
+                break;
+            }
+
+            tree << (i > 0 ? ", " : "") << "{\"m\": " << op->GetM() << ", \"n\": " << op->GetN()
+                 << ", \"nnz\": " << op->GetNnz() << "}";
         }
 
-        assert(this->build_ == false);
+        tree << "]";
 
-        // Check if all required structures are filled by the user
-        for(int i = 0; i < this->levels_ - 1; ++i)
+        if(this->smoother_level_ != NULL && this->smoother_level_[0] != NULL)
         {
-            assert(this->op_level_[i] != NULL);
-            assert(this->smoother_level_[i] != NULL);
-            assert(this->restrict_op_level_[i] != NULL);
-            assert(this->prolong_op_level_[i] != NULL);
+            tree << ", \"smoother\": " << this->smoother_level_[0]->LogTree();
         }
 
-        assert(this->op_ != NULL);
-        assert(this->solver_coarse_ != NULL);
-        assert(this->levels_ > 0);
-
-        this->Initialize();
+        if(this->solver_coarse_ != NULL)
+        {
+            tree << ", \"coarse\": " << this->solver_coarse_->LogTree();
+        }
 
-        this->build_ = true;
+        tree << "}";
 
-        log_debug(this, "BaseMultiGrid::Build()", this->build_, " #*# end");
+        return tree.str();
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
-    void BaseMultiGrid<OperatorType, VectorType, ValueType>::Clear(void)
+    std::string BaseMultiGrid<OperatorType, VectorType, ValueType>::LevelMemoryTag_(int level) const
     {
-        log_debug(this, "BaseMultiGrid::Clear()", this->build_);
+        std::ostringstream tag;
+        // Object ids are not unique without object tracking, use the address instead
+        tag << "MultiGrid " << static_cast<const void*>(this) << " level " << level;
 
-        if(this->build_ == true)
-        {
-            this->Finalize();
+        return tag.str();
+    }
 
-            this->levels_ = -1;
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::PrintMemory_(void) const
+    {
+        for(int i = 0; i < this->levels_; ++i)
+        {
+            int64_t current;
+            int64_t peak;
+
+            if(get_memory_usage_tag_rocalution(this->LevelMemoryTag_(i), &current, &peak) == true)
+            {
+                LOG_INFO("MultiGrid level " << i << " memory current=" << current
+                                            << " bytes peak=" << peak << " bytes");
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    double BaseMultiGrid<OperatorType, VectorType, ValueType>::BuildLevelSmoother_(
+        int                                                         level,
+        const OperatorType&                                         op,
+        IterativeLinearSolver<OperatorType, VectorType, ValueType>* sm)
+    {
+        assert(sm != NULL);
+
+        RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(level));
+
+        double time_begin = rocalution_time();
+
+        sm->SetOperator(op);
+
+        if(this->workspace_ != NULL)
+        {
+            sm->SetWorkspace(*this->workspace_);
+        }
+
+        sm->Build();
+        sm->FlagSmoother();
+        sm->SetGraphReplay(this->graph_replay_);
+
+        return rocalution_time() - time_begin;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::Initialize(void)
+    {
+        log_debug(this, "BaseMultiGrid::Initialize()", " #*# begin");
+
+        assert(this->build_ == false);
+
+        // Initialize smoothers
+        assert(this->smoother_level_ != NULL);
+
+        // Build times of smoothers that have been built with the hierarchy are kept
+        this->time_smoother_build_.resize(this->levels_, 0.0);
+        this->time_smoothing_.assign(this->levels_, 0.0);
+        this->time_residual_.assign(this->levels_, 0.0);
+        this->time_transfer_.assign(this->levels_, 0.0);
+
+        // Attach the coarse levels to the execution contexts of the concurrent level
+        // corrections, before their smoothers are built
+        if(this->cycle_ == Acycle && this->concurrent_levels_ > 1
+           && _rocalution_available_accelerator() == true
+           && concurrent_levels_available(*this->op_) == true)
+        {
+            if(this->num_contexts_ != this->concurrent_levels_)
+            {
+                for(int c = 0; c < this->num_contexts_; ++c)
+                {
+                    delete this->contexts_[c];
+                }
+
+                delete[] this->contexts_;
+
+                this->num_contexts_ = this->concurrent_levels_;
+                this->contexts_     = new ExecutionContext*[this->num_contexts_];
+
+                for(int c = 0; c < this->num_contexts_; ++c)
+                {
+                    this->contexts_[c] = new ExecutionContext;
+                }
+            }
+
+            // The finest level stays on the default stream
+            for(int i = 1; i < this->levels_; ++i)
+            {
+                this->op_level_[i - 1]->SetExecutionContext(
+                    *this->contexts_[i % this->num_contexts_]);
+            }
+        }
+
+        // Finest level 0 and coarse levels, skipping the smoothers that have already
+        // been built during the setup of the hierarchy
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            assert(this->smoother_level_[i] != NULL);
+
+            if(i < static_cast<int>(this->smoother_prebuilt_.size())
+               && this->smoother_prebuilt_[i] == true)
+            {
+                continue;
+            }
+
+            this->time_smoother_build_[i] = this->BuildLevelSmoother_(
+                i, (i == 0) ? *this->op_ : *this->op_level_[i - 1], this->smoother_level_[i]);
+        }
+
+        this->smoother_prebuilt_.clear();
+
+        // Initialize coarse grid solver
+        assert(this->solver_coarse_ != NULL);
+
+        {
+            RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(this->levels_ - 1));
+
+            double time_begin = rocalution_time();
+
+            this->solver_coarse_->SetOperator(*op_level_[this->levels_ - 2]);
+
+            if(this->workspace_ != NULL)
+            {
+                this->solver_coarse_->SetWorkspace(*this->workspace_);
+            }
+
+            this->solver_coarse_->Build();
+
+            this->time_smoother_build_[this->levels_ - 1] = rocalution_time() - time_begin;
+        }
+
+        // Setup all temporary vectors for the cycles - needed on all levels
+        this->d_level_ = new VectorType*[this->levels_];
+        this->r_level_ = new VectorType*[this->levels_];
+        this->t_level_ = new VectorType*[this->levels_];
+
+        // Extra vector for scaling
+        if(this->scaling_)
+        {
+            this->s_level_ = new VectorType*[this->levels_];
+
+            {
+                RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(0));
+
+                this->s_level_[0] = new VectorType;
+                this->s_level_[0]->CloneBackend(*this->op_);
+                this->s_level_[0]->Allocate("temporary", this->op_->GetM());
+            }
+
+            for(int i = 1; i < this->levels_; ++i)
+            {
+                RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(i));
+
+                this->s_level_[i] = new VectorType;
+                this->s_level_[i]->CloneBackend(*this->op_level_[i - 1]);
+                this->s_level_[i]->Allocate("temporary", this->op_level_[i - 1]->GetM());
+            }
+        }
+
+        // Extra vector for K-cycle
+        if(this->cycle_ == Kcycle)
+        {
+            this->q_level_ = new VectorType*[this->levels_ - 2];
+
+            for(int i = 0; i < this->levels_ - 2; ++i)
+            {
+                RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(i + 1));
+
+                this->q_level_[i] = new VectorType;
+                this->q_level_[i]->CloneBackend(*this->op_level_[i]);
+                this->q_level_[i]->Allocate("q", this->op_level_[i]->GetM());
+            }
+        }
+
+        for(int i = 1; i < this->levels_; ++i)
+        {
+            RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(i));
+
+            // On finest level, we need to get the size from this->op_ instead
+            this->d_level_[i] = new VectorType;
+            this->d_level_[i]->CloneBackend(*this->op_level_[i - 1]);
+            this->d_level_[i]->Allocate("defect correction", this->op_level_[i - 1]->GetM());
+
+            this->r_level_[i] = new VectorType;
+            this->r_level_[i]->CloneBackend(*this->op_level_[i - 1]);
+            this->r_level_[i]->Allocate("residual", this->op_level_[i - 1]->GetM());
+
+            this->t_level_[i] = new VectorType;
+            this->t_level_[i]->CloneBackend(*this->op_level_[i - 1]);
+            this->t_level_[i]->Allocate("temporary", this->op_level_[i - 1]->GetM());
+        }
+
+        RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(0));
+
+        this->r_level_[0] = new VectorType;
+        this->r_level_[0]->CloneBackend(*this->op_);
+        this->r_level_[0]->Allocate("residual", this->op_->GetM());
+
+        this->t_level_[0] = new VectorType;
+        this->t_level_[0]->CloneBackend(*this->op_);
+        this->t_level_[0]->Allocate("temporary", this->op_->GetM());
+
+        // The additive cycle also needs the correction of the finest level
+        this->d_level_[0] = NULL;
+
+        if(this->cycle_ == Acycle)
+        {
+            this->d_level_[0] = new VectorType;
+            this->d_level_[0]->CloneBackend(*this->op_);
+            this->d_level_[0]->Allocate("defect correction", this->op_->GetM());
+        }
+
+        log_debug(this, "BaseMultiGrid::Initialize()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "BaseMultiGrid::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("BaseMultiGrid::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+
+        // Check if all required structures are filled by the user
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            assert(this->op_level_[i] != NULL);
+            assert(this->smoother_level_[i] != NULL);
+            assert(this->restrict_op_level_[i] != NULL);
+            assert(this->prolong_op_level_[i] != NULL);
+        }
+
+        assert(this->op_ != NULL);
+        assert(this->solver_coarse_ != NULL);
+        assert(this->levels_ > 0);
+
+        this->Initialize();
+        this->BuildFusedLevelOperations_();
+
+        this->build_ = true;
+
+        this->AutoHostLevels_();
+
+        log_debug(this, "BaseMultiGrid::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "BaseMultiGrid::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->Finalize();
+
+            this->levels_ = -1;
             this->build_  = false;
         }
     }
@@ -374,10 +916,7 @@ namespace rocalution
             // Clear temporary VectorTypes
             for(int i = 0; i < this->levels_; ++i)
             {
-                if(i > 0)
-                {
-                    delete this->d_level_[i];
-                }
+                delete this->d_level_[i];
                 delete this->r_level_[i];
                 delete this->t_level_[i];
             }
@@ -408,6 +947,21 @@ namespace rocalution
                 delete[] this->q_level_;
             }
 
+            // Clear fused residual restriction operators
+            if(this->fused_op_level_ != NULL)
+            {
+                for(int i = 0; i < this->levels_ - 1; ++i)
+                {
+                    delete this->fused_op_level_[i];
+                }
+
+                delete[] this->fused_op_level_;
+                this->fused_op_level_ = NULL;
+            }
+
+            // Clear block temporaries
+            this->ClearMulti_();
+
             // Clear smoothers
             for(int i = 0; i < this->levels_ - 1; ++i)
             {
@@ -431,6 +985,9 @@ namespace rocalution
 
         if(this->build_ == true)
         {
+            // Block temporaries are allocated again on the next block solve
+            this->ClearMulti_();
+
             this->r_level_[this->levels_ - 1]->MoveToHost();
             this->d_level_[this->levels_ - 1]->MoveToHost();
             this->t_level_[this->levels_ - 1]->MoveToHost();
@@ -441,7 +998,7 @@ namespace rocalution
                 this->op_level_[i]->MoveToHost();
                 this->smoother_level_[i]->MoveToHost();
                 this->r_level_[i]->MoveToHost();
-                if(i > 0)
+                if(this->d_level_[i] != NULL)
                 {
                     this->d_level_[i]->MoveToHost();
                 }
@@ -449,6 +1006,11 @@ namespace rocalution
 
                 this->restrict_op_level_[i]->MoveToHost();
                 this->prolong_op_level_[i]->MoveToHost();
+
+                if(this->fused_op_level_ != NULL && this->fused_op_level_[i] != NULL)
+                {
+                    this->fused_op_level_[i]->MoveToHost();
+                }
             }
 
             // Extra structure for scaling
@@ -485,6 +1047,9 @@ namespace rocalution
 
         if(this->build_ == true)
         {
+            // Block temporaries are allocated again on the next block solve
+            this->ClearMulti_();
+
             // If coarsest level on accelerator
             if(this->host_level_ == 0)
             {
@@ -499,6 +1064,11 @@ namespace rocalution
                     this->op_level_[i]->MoveToAccelerator();
                     this->restrict_op_level_[i]->MoveToAccelerator();
                     this->prolong_op_level_[i]->MoveToAccelerator();
+
+                    if(this->fused_op_level_ != NULL && this->fused_op_level_[i] != NULL)
+                    {
+                        this->fused_op_level_[i]->MoveToAccelerator();
+                    }
                 }
             }
 
@@ -517,7 +1087,7 @@ namespace rocalution
                 if(i < this->levels_ - this->host_level_)
                 {
                     this->r_level_[i]->MoveToAccelerator();
-                    if(i > 0)
+                    if(this->d_level_[i] != NULL)
                     {
                         this->d_level_[i]->MoveToAccelerator();
                     }
@@ -576,6 +1146,11 @@ namespace rocalution
             this->restrict_op_level_[level - 2]->MoveToHost();
             this->prolong_op_level_[level - 2]->MoveToHost();
 
+            if(this->fused_op_level_ != NULL && this->fused_op_level_[level - 2] != NULL)
+            {
+                this->fused_op_level_[level - 2]->MoveToHost();
+            }
+
             // Move temporary vectors
             this->t_level_[level - 1]->MoveToHost();
             this->r_level_[level - 1]->MoveToHost();
@@ -601,6 +1176,64 @@ namespace rocalution
         }
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::AutoHostLevels_(void)
+    {
+        log_debug(this, "BaseMultiGrid::AutoHostLevels_()", this->auto_host_level_);
+
+        assert(this->build_ == true);
+
+        if(this->auto_host_level_ == false || this->levels_ < 2
+           || _rocalution_available_accelerator() == false
+           || auto_host_levels_available(*this->op_) == false)
+        {
+            return;
+        }
+
+        // Operator applications per level visit: smoothing, residual, restriction and
+        // prolongation
+        const double weight = this->iter_pre_smooth_ + this->iter_post_smooth_ + 3;
+        const int    trials = 5;
+
+        double saving      = 0.0;
+        double best        = 0.0;
+        int    host_levels = 0;
+
+        // Start at the coarsest level, the finest level always stays on its backend
+        for(int i = this->levels_ - 1; i > 0; --i)
+        {
+            double level_saving = host_saving(*this->op_level_[i - 1], trials);
+
+            saving += weight * level_saving;
+
+            // The residual and the correction of the boundary level are transferred twice
+            // per visit
+            const OperatorType* op_fine = (i == 1) ? this->op_ : this->op_level_[i - 2];
+
+            double net = saving - 2.0 * transfer_time(*op_fine);
+
+            if(net > best)
+            {
+                best        = net;
+                host_levels = this->levels_ - i;
+            }
+
+            // The finer levels are larger, such that the host will not be faster there
+            if(level_saving <= 0.0)
+            {
+                break;
+            }
+        }
+
+        LOG_VERBOSE_INFO(2, "BaseMultiGrid::AutoHostLevels_() host levels: " << host_levels);
+
+        if(host_levels > 0)
+        {
+            this->host_level_ = host_levels;
+            this->MoveHostLevels_();
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseMultiGrid<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
                                                                    VectorType*       x)
@@ -617,7 +1250,7 @@ namespace rocalution
 
         for(int i = 0; i < this->levels_; ++i)
         {
-            if(i > 0)
+            if(i > 0 || this->cycle_ == Acycle)
             {
                 assert(this->d_level_[i] != NULL);
             }
@@ -650,12 +1283,19 @@ namespace rocalution
             assert(this->prolong_op_level_[i] != NULL);
         }
 
+        RocalutionLogRecord record("solve");
+
         if(this->verb_ > 0)
         {
             this->PrintStart_();
             this->iter_ctrl_.PrintInit();
         }
 
+        if(this->hist_size_ > 0)
+        {
+            this->InitialGuess_(rhs, x);
+        }
+
         // Skip residual, if preconditioner
         if(this->is_precond_ == false)
         {
@@ -667,6 +1307,8 @@ namespace rocalution
 
             if(this->iter_ctrl_.InitResidual(this->res_norm_) == false)
             {
+                this->LogSolve_(&record);
+
                 log_debug(this, "BaseMultiGrid::Solve()", " #*# end");
 
                 return;
@@ -678,17 +1320,41 @@ namespace rocalution
             this->iter_ctrl_.InitResidual(1.0);
         }
 
-        this->Vcycle_(rhs, x);
+        // The additive cycle visits all levels at once
+        if(this->cycle_ == Acycle)
+        {
+            this->Acycle_(rhs, x);
+        }
+        else
+        {
+            this->Vcycle_(rhs, x);
+        }
 
         // If no preconditioner, compute until convergence
         if(this->is_precond_ == false)
         {
             while(!this->iter_ctrl_.CheckResidual(this->res_norm_, this->index_))
             {
-                this->Vcycle_(rhs, x);
+                if(this->cycle_ == Acycle)
+                {
+                    this->Acycle_(rhs, x);
+                }
+                else
+                {
+                    this->Vcycle_(rhs, x);
+                }
             }
         }
 
+        this->iter_ctrl_.EndIterationRange();
+
+        if(this->hist_size_ > 0)
+        {
+            this->UpdateHistory_(*x);
+        }
+
+        this->LogSolve_(&record);
+
         if(this->verb_ > 0)
         {
             this->iter_ctrl_.PrintStatus();
@@ -698,6 +1364,174 @@ namespace rocalution
         log_debug(this, "BaseMultiGrid::Solve()", " #*# end");
     }
 
+    // Largest residual norm of all columns of a block
+    template <typename ValueType>
+    static double multi_max_norm(const LocalMultiVector<ValueType>& r)
+    {
+        int ncol = r.GetNcol();
+
+        std::vector<ValueType> gram(ncol * ncol);
+        r.Dot(r, gram.data());
+
+        double nrm = 0.0;
+
+        for(int j = 0; j < ncol; ++j)
+        {
+            nrm = std::max(nrm, static_cast<double>(std::sqrt(std::abs(gram[j * ncol + j]))));
+        }
+
+        return nrm;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SolveMulti(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "BaseMultiGrid::SolveMulti()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->levels_ > 1);
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(rhs.GetNcol() == x->GetNcol());
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+        assert(this->precond_ == NULL);
+        assert(this->solver_coarse_ != NULL);
+
+        this->AllocateMulti_(rhs.GetNcol());
+
+        const Operator<ValueType>*   op = this->op_;
+        LocalMultiVector<ValueType>* r  = this->mr_level_[0];
+
+        if(this->verb_ > 0)
+        {
+            this->PrintStart_();
+            this->iter_ctrl_.PrintInit();
+        }
+
+        // Skip residual, if preconditioner
+        if(this->is_precond_ == false)
+        {
+            // initial residual = b - Ax
+            op->Apply(*x, r);
+            r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+            this->res_norm_ = multi_max_norm(*r);
+
+            if(this->iter_ctrl_.InitResidual(this->res_norm_) == false)
+            {
+                log_debug(this, "BaseMultiGrid::SolveMulti()", " #*# end");
+
+                return;
+            }
+        }
+        else
+        {
+            // Initialize dummy residual
+            this->iter_ctrl_.InitResidual(1.0);
+        }
+
+        this->VcycleMulti_(rhs, x);
+
+        // If no preconditioner, compute until all columns have converged
+        if(this->is_precond_ == false)
+        {
+            while(!this->iter_ctrl_.CheckResidual(this->res_norm_, this->index_))
+            {
+                this->VcycleMulti_(rhs, x);
+            }
+        }
+
+        this->iter_ctrl_.EndIterationRange();
+
+        if(this->verb_ > 0)
+        {
+            this->iter_ctrl_.PrintStatus();
+            this->PrintEnd_();
+        }
+
+        log_debug(this, "BaseMultiGrid::SolveMulti()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SolveMultiZeroSol(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "BaseMultiGrid::SolveMultiZeroSol()", (const void*&)rhs, x);
+
+        assert(x != NULL);
+
+        x->Zeros();
+        this->SolveMulti(rhs, x);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::AllocateMulti_(int ncol)
+    {
+        log_debug(this, "BaseMultiGrid::AllocateMulti_()", ncol);
+
+        if(this->mr_level_ != NULL && this->mr_level_[0]->GetNcol() == ncol)
+        {
+            return;
+        }
+
+        this->ClearMulti_();
+
+        this->mr_level_ = new LocalMultiVector<ValueType>*[this->levels_];
+        this->mt_level_ = new LocalMultiVector<ValueType>*[this->levels_];
+        this->md_level_ = new LocalMultiVector<ValueType>*[this->levels_];
+
+        for(int i = 0; i < this->levels_; ++i)
+        {
+            RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(i));
+
+            const OperatorType* op = (i == 0) ? this->op_ : this->op_level_[i - 1];
+
+            this->mr_level_[i] = new LocalMultiVector<ValueType>;
+            this->mt_level_[i] = new LocalMultiVector<ValueType>;
+            this->md_level_[i] = new LocalMultiVector<ValueType>;
+
+            this->mr_level_[i]->CloneBackend(*op);
+            this->mt_level_[i]->CloneBackend(*op);
+            this->md_level_[i]->CloneBackend(*op);
+
+            this->mr_level_[i]->Allocate("r", op->GetM(), ncol);
+
+            // The finest level works on the right-hand side and solution of the caller
+            if(i > 0)
+            {
+                this->mt_level_[i]->Allocate("t", op->GetM(), ncol);
+                this->md_level_[i]->Allocate("d", op->GetM(), ncol);
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::ClearMulti_(void)
+    {
+        log_debug(this, "BaseMultiGrid::ClearMulti_()");
+
+        if(this->mr_level_ == NULL)
+        {
+            return;
+        }
+
+        for(int i = 0; i < this->levels_; ++i)
+        {
+            delete this->mr_level_[i];
+            delete this->mt_level_[i];
+            delete this->md_level_[i];
+        }
+
+        delete[] this->mr_level_;
+        delete[] this->mt_level_;
+        delete[] this->md_level_;
+
+        this->mr_level_ = NULL;
+        this->mt_level_ = NULL;
+        this->md_level_ = NULL;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseMultiGrid<OperatorType, VectorType, ValueType>::Restrict_(const VectorType& fine,
                                                                        VectorType*       coarse)
@@ -716,19 +1550,86 @@ namespace rocalution
         this->prolong_op_level_[this->current_level_]->Apply(coarse, fine);
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    bool BaseMultiGrid<OperatorType, VectorType, ValueType>::FusableLevel_(int level) const
+    {
+        return this->scaling_ == false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::BuildFusedLevelOperations_(void)
+    {
+        log_debug(this, "BaseMultiGrid::BuildFusedLevelOperations_()", this->fused_);
+
+        if(this->fused_ == false)
+        {
+            return;
+        }
+
+        if(this->fused_op_level_ == NULL)
+        {
+            this->fused_op_level_ = new OperatorType*[this->levels_ - 1];
+
+            for(int i = 0; i < this->levels_ - 1; ++i)
+            {
+                this->fused_op_level_[i] = NULL;
+            }
+        }
+
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            // The first host level has its restriction and its operator on different backends
+            if(this->FusableLevel_(i) == false
+               || (this->host_level_ > 0 && i == this->levels_ - this->host_level_ - 1))
+            {
+                delete this->fused_op_level_[i];
+                this->fused_op_level_[i] = NULL;
+
+                continue;
+            }
+
+            RocalutionMemoryTag mem_tag(this->LevelMemoryTag_(i));
+
+            if(this->fused_op_level_[i] == NULL)
+            {
+                this->fused_op_level_[i] = new OperatorType;
+            }
+
+            const OperatorType* op = (i == 0) ? this->op_ : this->op_level_[i - 1];
+
+            if(fused_restriction_product(
+                   *this->restrict_op_level_[i], *op, this->fused_op_level_[i])
+               == false)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: Fused level operations are not supported for this operator");
+
+                delete this->fused_op_level_[i];
+                this->fused_op_level_[i] = NULL;
+            }
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseMultiGrid<OperatorType, VectorType, ValueType>::Vcycle_(const VectorType& rhs,
                                                                      VectorType*       x)
     {
         log_debug(this, "BaseMultiGrid::Vcycle_()", " #*# begin", (const void*&)rhs, x);
+        ROCALUTION_RANGE("BaseMultiGrid::Vcycle_() level " + std::to_string(this->current_level_));
+
+        double time_begin = this->LevelTimer_(NULL, 0.0);
 
         // Run coarse grid solver, if coarsest grid has been reached
         if(this->current_level_ == this->levels_ - 1)
         {
             this->solver_coarse_->SolveZeroSol(rhs, x);
+            this->LevelTimer_(&this->time_smoothing_, time_begin);
             return;
         }
 
+        // Migrate the next coarser level, while this level is processed
+        this->PrefetchLevel_(this->current_level_ + 1);
+
         // Smoother on the current level
         IterativeLinearSolver<OperatorType, VectorType, ValueType>* smoother
             = this->smoother_level_[this->current_level_];
@@ -762,6 +1663,8 @@ namespace rocalution
             smoother->Solve(rhs, x);
         }
 
+        time_begin = this->LevelTimer_(&this->time_smoothing_, time_begin);
+
         // Scaling
         if(this->scaling_ == true)
         {
@@ -788,35 +1691,60 @@ namespace rocalution
             }
         }
 
-        // Update residual r = b - Ax
-        op->Apply(*x, r);
-        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
-
-        // Copy s when scaling is enabled
-        if(this->scaling_ && this->current_level_ == 0)
+        // Fused residual restriction rc = R b - (R A) x, the fine residual is not formed
+        if(this->fused_op_level_ != NULL && this->fused_op_level_[this->current_level_] != NULL
+           && this->current_level_ + 1 != this->levels_ - this->host_level_)
         {
-            s->CopyFrom(*r);
-        }
+            this->restrict_op_level_[this->current_level_]->Apply(rhs, rc);
+            this->fused_op_level_[this->current_level_]->ApplyAdd(
+                *x, static_cast<ValueType>(-1), rc);
 
-        // Check if 'continue computation on host' flag is set for this new level
-        if(this->current_level_ + 1 == this->levels_ - this->host_level_)
-        {
-            r->MoveToHost();
+            this->LevelTimer_(&this->time_transfer_, time_begin);
         }
+        else
+        {
+            // Update residual r = b - Ax
+            op->Apply(*x, r);
+            r->ScaleAdd(static_cast<ValueType>(-1), rhs);
 
-        // Restrict residual vector on finest level
-        this->Restrict_(*r, rc);
+            // Copy s when scaling is enabled
+            if(this->scaling_ && this->current_level_ == 0)
+            {
+                s->CopyFrom(*r);
+            }
 
-        if(this->current_level_ + 1 == this->levels_ - this->host_level_)
-        {
-            r->CloneBackend(*op);
+            time_begin = this->LevelTimer_(&this->time_residual_, time_begin);
+
+            // Check if 'continue computation on host' flag is set for this new level
+            if(this->current_level_ + 1 == this->levels_ - this->host_level_)
+            {
+                r->MoveToHost();
+            }
+
+            // Restrict residual vector on finest level
+            this->Restrict_(*r, rc);
+
+            if(this->current_level_ + 1 == this->levels_ - this->host_level_)
+            {
+                r->CloneBackend(*op);
+            }
+
+            this->LevelTimer_(&this->time_transfer_, time_begin);
         }
 
         ++this->current_level_;
 
+        // Small levels continue with V-cycles
+        unsigned int cycle = this->cycle_;
+
+        if(this->op_level_[this->current_level_ - 1]->GetM() < this->cycle_switch_size_)
+        {
+            cycle = Vcycle;
+        }
+
         // Recursive call dependent on the
         // cycle
-        switch(this->cycle_)
+        switch(cycle)
         {
         // V-cycle
         case 0:
@@ -845,6 +1773,9 @@ namespace rocalution
 
         --this->current_level_;
 
+        // The coarser levels have been recorded by the recursion
+        time_begin = this->LevelTimer_(NULL, 0.0);
+
         if(this->current_level_ + 1 == this->levels_ - this->host_level_)
         {
             r->MoveToHost();
@@ -898,10 +1829,14 @@ namespace rocalution
             x->AddScale(*r, static_cast<ValueType>(1));
         }
 
+        time_begin = this->LevelTimer_(&this->time_transfer_, time_begin);
+
         // Post-smoothing on finest level
         smoother->InitMaxIter(this->iter_post_smooth_);
         smoother->Solve(rhs, x);
 
+        time_begin = this->LevelTimer_(&this->time_smoothing_, time_begin);
+
         // Only update the residual, if this is not a preconditioner
         if(this->current_level_ == 0 && this->is_precond_ == false)
         {
@@ -910,11 +1845,382 @@ namespace rocalution
             r->ScaleAdd(static_cast<ValueType>(-1), rhs);
 
             this->res_norm_ = std::abs(this->Norm_(*r));
+
+            this->LevelTimer_(&this->time_residual_, time_begin);
         }
 
         log_debug(this, "BaseMultiGrid::Vcycle_()", " #*# end");
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::VcycleMulti_(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "BaseMultiGrid::VcycleMulti_()", " #*# begin", (const void*&)rhs, x);
+        ROCALUTION_RANGE("BaseMultiGrid::VcycleMulti_() level "
+                         + std::to_string(this->current_level_));
+
+        // Run coarse grid solver, if coarsest grid has been reached
+        if(this->current_level_ == this->levels_ - 1)
+        {
+            this->solver_coarse_->SolveMultiZeroSol(rhs, x);
+            return;
+        }
+
+        // Smoother on the current level
+        IterativeLinearSolver<OperatorType, VectorType, ValueType>* smoother
+            = this->smoother_level_[this->current_level_];
+
+        // Operators on the current level, the multi-vector products are declared by the
+        // operator base class
+        const Operator<ValueType>* op
+            = (this->current_level_ == 0) ? this->op_ : this->op_level_[this->current_level_ - 1];
+        const Operator<ValueType>* restrict_op = this->restrict_op_level_[this->current_level_];
+        const Operator<ValueType>* prolong_op  = this->prolong_op_level_[this->current_level_];
+
+        // Temporary blocks on the current level
+        LocalMultiVector<ValueType>* r  = this->mr_level_[this->current_level_];
+        LocalMultiVector<ValueType>* rc = this->mt_level_[this->current_level_ + 1];
+        LocalMultiVector<ValueType>* xc = this->md_level_[this->current_level_ + 1];
+
+        bool host_transition = (this->current_level_ + 1 == this->levels_ - this->host_level_);
+
+        // Pre-smoothing
+        smoother->InitMaxIter(this->iter_pre_smooth_);
+        if(this->is_precond_ || this->current_level_ != 0)
+        {
+            smoother->SolveMultiZeroSol(rhs, x);
+        }
+        else
+        {
+            smoother->SolveMulti(rhs, x);
+        }
+
+        // Update residual R = B - AX
+        op->Apply(*x, r);
+        r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        // Check if 'continue computation on host' flag is set for this new level
+        if(host_transition == true)
+        {
+            r->MoveToHost();
+        }
+
+        // Restrict residual block
+        restrict_op->Apply(*r, rc);
+
+        ++this->current_level_;
+
+        this->VcycleMulti_(*rc, xc);
+
+        --this->current_level_;
+
+        // Prolong coarse correction
+        prolong_op->Apply(*xc, r);
+
+        if(host_transition == true)
+        {
+            r->CloneBackend(*op);
+        }
+
+        // Defect correction
+        x->AddScale(*r, static_cast<ValueType>(1));
+
+        // Post-smoothing
+        smoother->InitMaxIter(this->iter_post_smooth_);
+        smoother->SolveMulti(rhs, x);
+
+        // Only update the residual, if this is not a preconditioner
+        if(this->current_level_ == 0 && this->is_precond_ == false)
+        {
+            op->Apply(*x, r);
+            r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+            this->res_norm_ = multi_max_norm(*r);
+        }
+
+        log_debug(this, "BaseMultiGrid::VcycleMulti_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::Acycle_(const VectorType& rhs,
+                                                                     VectorType*       x)
+    {
+        log_debug(this, "BaseMultiGrid::Acycle_()", " #*# begin", (const void*&)rhs, x);
+        ROCALUTION_RANGE("BaseMultiGrid::Acycle_()");
+
+        assert(this->current_level_ == 0);
+        assert(this->d_level_[0] != NULL);
+
+        double time_begin = this->LevelTimer_(NULL, 0.0);
+
+        // As a solver, the residual of the finest level is up to date, a preconditioner
+        // starts with a zero initial guess
+        if(this->is_precond_ == true)
+        {
+            this->r_level_[0]->CopyFrom(rhs);
+        }
+
+        // Restrict the residual to all levels
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            this->current_level_ = i;
+
+            const OperatorType* op = (i == 0) ? this->op_ : this->op_level_[i - 1];
+
+            // Residual and temporary vector of the level
+            VectorType* r  = (i == 0) ? this->r_level_[0] : this->t_level_[i];
+            VectorType* z  = (i == 0) ? this->t_level_[0] : this->r_level_[i];
+            VectorType* rc = this->t_level_[i + 1];
+
+            VectorType* fine = r;
+
+            // Smoothed restriction rc = R (r - A S r)
+            if(this->mult_additive_ == true)
+            {
+                this->smoother_level_[i]->InitMaxIter(this->iter_pre_smooth_);
+                this->smoother_level_[i]->SolveZeroSol(*r, this->d_level_[i]);
+
+                time_begin = this->LevelTimer_(&this->time_smoothing_, time_begin);
+
+                op->Apply(*this->d_level_[i], z);
+                z->ScaleAdd(static_cast<ValueType>(-1), *r);
+
+                fine = z;
+
+                this->SyncLevels_();
+
+                time_begin = this->LevelTimer_(&this->time_residual_, time_begin);
+            }
+
+            // Check if 'continue computation on host' flag is set for the next level
+            if(i + 1 == this->levels_ - this->host_level_)
+            {
+                fine->MoveToHost();
+            }
+
+            this->Restrict_(*fine, rc);
+
+            if(i + 1 == this->levels_ - this->host_level_)
+            {
+                fine->CloneBackend(*op);
+            }
+
+            this->SyncLevels_();
+
+            time_begin = this->LevelTimer_(&this->time_transfer_, time_begin);
+        }
+
+        // The mult-additive cycle has computed the smoothing of the levels during the
+        // restriction, only the coarse grid solve is left
+        this->current_level_ = 0;
+        this->AdditiveCorrections_((this->mult_additive_ == true) ? this->levels_ - 1 : 0);
+
+        time_begin = this->LevelTimer_(NULL, 0.0);
+
+        // Prolong and sum up the corrections, starting with the coarsest level
+        for(int i = this->levels_ - 2; i >= 0; --i)
+        {
+            this->current_level_ = i;
+
+            const OperatorType* op = (i == 0) ? this->op_ : this->op_level_[i - 1];
+
+            VectorType* r  = (i == 0) ? this->r_level_[0] : this->t_level_[i];
+            VectorType* z  = (i == 0) ? this->t_level_[0] : this->r_level_[i];
+            VectorType* e  = this->d_level_[i];
+            VectorType* ec = this->d_level_[i + 1];
+
+            // Smoothed prolongation e = (I - S A) P ec + S r, or the plain sum e = e + P ec
+            VectorType* fine = (this->mult_additive_ == true) ? e : z;
+
+            if(i + 1 == this->levels_ - this->host_level_)
+            {
+                fine->MoveToHost();
+            }
+
+            this->Prolong_(*ec, fine);
+
+            if(i + 1 == this->levels_ - this->host_level_)
+            {
+                fine->CloneBackend(*op);
+            }
+
+            this->SyncLevels_();
+
+            if(this->mult_additive_ == true)
+            {
+                time_begin = this->LevelTimer_(&this->time_transfer_, time_begin);
+
+                this->smoother_level_[i]->InitMaxIter(this->iter_post_smooth_);
+                this->smoother_level_[i]->Solve(*r, e);
+
+                time_begin = this->LevelTimer_(&this->time_smoothing_, time_begin);
+            }
+            else
+            {
+                e->AddScale(*z, static_cast<ValueType>(1));
+
+                time_begin = this->LevelTimer_(&this->time_transfer_, time_begin);
+            }
+
+            this->SyncLevels_();
+        }
+
+        // Defect correction
+        if(this->is_precond_ == true)
+        {
+            x->CopyFrom(*this->d_level_[0]);
+        }
+        else
+        {
+            x->AddScale(*this->d_level_[0], static_cast<ValueType>(1));
+
+            // Update residual
+            this->op_->Apply(*x, this->r_level_[0]);
+            this->r_level_[0]->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+            this->res_norm_ = std::abs(this->Norm_(*this->r_level_[0]));
+
+            this->LevelTimer_(&this->time_residual_, time_begin);
+        }
+
+        log_debug(this, "BaseMultiGrid::Acycle_()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::AdditiveCorrections_(int level)
+    {
+        log_debug(this, "BaseMultiGrid::AdditiveCorrections_()", level);
+
+        int nlevel = this->levels_ - level;
+        int nthread = 1;
+
+        if(this->contexts_ != NULL)
+        {
+            nthread = std::min(this->num_contexts_, nlevel);
+        }
+        else if(concurrent_levels_available(*this->op_) == true)
+        {
+            nthread = std::min(this->concurrent_levels_, nlevel);
+        }
+
+        // Sequential level corrections are timed per level
+        if(nthread <= 1)
+        {
+            for(int i = level; i < this->levels_; ++i)
+            {
+                this->current_level_ = i;
+
+                double time_begin = this->LevelTimer_(NULL, 0.0);
+
+                VectorType* r = (i == 0) ? this->r_level_[0] : this->t_level_[i];
+
+                if(i == this->levels_ - 1)
+                {
+                    this->solver_coarse_->SolveZeroSol(*r, this->d_level_[i]);
+                }
+                else
+                {
+                    this->smoother_level_[i]->InitMaxIter(this->iter_pre_smooth_);
+                    this->smoother_level_[i]->SolveZeroSol(*r, this->d_level_[i]);
+                }
+
+                this->LevelTimer_(&this->time_smoothing_, time_begin);
+            }
+
+            this->current_level_ = 0;
+
+            return;
+        }
+
+        // The restricted residuals have been written on the default stream
+        _rocalution_sync_default();
+
+        // Concurrent level corrections are recorded as smoothing time of the finest level
+        this->current_level_ = 0;
+
+        double time_begin = this->LevelTimer_(NULL, 0.0);
+
+        // Each thread works on the levels of one context, level i is attached to the
+        // context i % num_contexts_ and the finest level is processed by the first thread
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthread) schedule(static, 1)
+#endif
+        for(int c = 0; c < nthread; ++c)
+        {
+            if(this->contexts_ != NULL)
+            {
+                this->contexts_[c]->Activate();
+            }
+
+            for(int i = level; i < this->levels_; ++i)
+            {
+                if(i % nthread != c)
+                {
+                    continue;
+                }
+
+                VectorType* r = (i == 0) ? this->r_level_[0] : this->t_level_[i];
+
+                if(i == this->levels_ - 1)
+                {
+                    this->solver_coarse_->SolveZeroSol(*r, this->d_level_[i]);
+                }
+                else
+                {
+                    this->smoother_level_[i]->InitMaxIter(this->iter_pre_smooth_);
+                    this->smoother_level_[i]->SolveZeroSol(*r, this->d_level_[i]);
+                }
+            }
+
+            if(this->contexts_ != NULL)
+            {
+                this->contexts_[c]->Sync();
+            }
+        }
+
+        this->SyncLevels_();
+
+        this->LevelTimer_(&this->time_smoothing_, time_begin);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::SyncLevels_(void) const
+    {
+        // The intergrid transfers run on the default stream, while the level vectors are
+        // updated on the streams of their contexts
+        if(this->contexts_ != NULL)
+        {
+            _rocalution_sync();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BaseMultiGrid<OperatorType, VectorType, ValueType>::PrefetchLevel_(int level) const
+    {
+        if(level <= 0 || level >= this->levels_)
+        {
+            return;
+        }
+
+        this->op_level_[level - 1]->Prefetch();
+
+        if(level < this->levels_ - 1)
+        {
+            this->restrict_op_level_[level]->Prefetch();
+            this->prolong_op_level_[level]->Prefetch();
+
+            if(this->fused_op_level_ != NULL && this->fused_op_level_[level] != NULL)
+            {
+                this->fused_op_level_[level]->Prefetch();
+            }
+        }
+
+        this->d_level_[level]->Prefetch();
+        this->r_level_[level]->Prefetch();
+        this->t_level_[level]->Prefetch();
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BaseMultiGrid<OperatorType, VectorType, ValueType>::Wcycle_(const VectorType& rhs,
                                                                      VectorType*       x)
@@ -942,6 +2248,40 @@ namespace rocalution
         {
             this->Vcycle_(rhs, x);
         }
+        else if(this->current_level_ < this->levels_ - 1
+                && this->op_level_[this->current_level_ - 1]->GetM() < this->kcycle_fixed_size_)
+        {
+            VectorType* q = this->q_level_[this->current_level_ - 1];
+            VectorType* r = this->t_level_[this->current_level_];
+
+            const OperatorType* op = this->op_level_[this->current_level_ - 1];
+
+            // Two cycles with fixed coefficients, without global reductions
+
+            // Cycle
+            this->Vcycle_(rhs, x);
+
+            // x = alpha * x
+            x->Scale(this->kcycle_alpha_);
+
+            // q = Ax
+            op->Apply(*x, q);
+
+            // r = rhs
+            if(r != &rhs)
+            {
+                r->CopyFrom(rhs);
+            }
+
+            // r = r - q
+            r->AddScale(*q, static_cast<ValueType>(-1));
+
+            // Cycle
+            this->Vcycle_(*r, q);
+
+            // x = x + beta * q
+            x->AddScale(*q, this->kcycle_beta_);
+        }
         else if(this->current_level_ < this->levels_ - 1)
         {
             VectorType* q = this->q_level_[this->current_level_ - 1];
@@ -1005,7 +2345,11 @@ namespace rocalution
         }
         else
         {
+            double time_begin = this->LevelTimer_(NULL, 0.0);
+
             this->solver_coarse_->SolveZeroSol(rhs, x);
+
+            this->LevelTimer_(&this->time_smoothing_, time_begin);
         }
     }
 
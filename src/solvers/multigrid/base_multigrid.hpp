@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -28,6 +28,9 @@
 #include "../solver.hpp"
 #include "rocalution/export.hpp"
 
+#include <string>
+#include <vector>
+
 namespace rocalution
 {
 
@@ -36,7 +39,8 @@ namespace rocalution
         Vcycle = 0,
         Wcycle = 1,
         Kcycle = 2,
-        Fcycle = 3
+        Fcycle = 3,
+        Acycle = 4
     };
 
     /** \ingroup solver_module
@@ -58,6 +62,19 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual void Print(void) const;
 
+        /** \brief Print the halo exchange statistics of all levels
+        * \details
+        * For global operators, the statistics of each level are printed with
+        * GlobalMatrix::CommunicationInfo(). This is a collective call.
+        */
+        ROCALUTION_EXPORT
+        void CommunicationInfo(void) const;
+
+        /** \brief Return the solver tree as JSON object, including the operator sizes of
+        * all levels */
+        ROCALUTION_EXPORT
+        virtual std::string LogTree(void) const;
+
         /** \private */
         ROCALUTION_EXPORT
         virtual void SetPreconditioner(Solver<OperatorType, VectorType, ValueType>& precond);
@@ -78,6 +95,11 @@ namespace rocalution
         ROCALUTION_EXPORT
         void SetSmootherPostIter(int iter);
 
+        /** \brief Enable/disable the replay of the FixedPoint smoothing steps from HIP graphs
+        * on all levels, see IterativeLinearSolver::SetGraphReplay() */
+        ROCALUTION_EXPORT
+        virtual void SetGraphReplay(bool onoff);
+
         /** \brief Set the restriction operator for each level */
         virtual void SetRestrictOperator(OperatorType** op) = 0;
 
@@ -91,10 +113,37 @@ namespace rocalution
         ROCALUTION_EXPORT
         void SetScaling(bool scaling);
 
+        /** \brief Enable/disable the fused residual restriction of the cycles
+        * \details
+        * When enabled, the product \f$RA\f$ of the restriction and the operator of each level
+        * is computed during the build, and the cycles restrict the residual after the
+        * pre-smoothing as \f$r_c = Rb - (RA)x\f$, without forming the fine level residual.
+        * This saves writing and twice reading the fine residual vector on each level of a
+        * cycle, at the cost of storing \f$RA\f$. Levels with intergrid transfer scaling,
+        * the first host level and levels without an explicit restriction operator are not
+        * fused. Must be set before building.
+        */
+        ROCALUTION_EXPORT
+        void SetFusedLevelOperations(bool fused);
+
         /** \brief Force computation of coarser levels on the host backend */
         ROCALUTION_EXPORT
         void SetHostLevels(int levels);
 
+        /** \brief Select the number of host levels automatically
+        * \details
+        * With \p SetAutoHostLevels(true), the number of coarsest levels that are computed
+        * on the host is chosen at the end of Build(). The operator application of the coarse
+        * levels is timed on the accelerator and on the host, starting from the coarsest
+        * level. The coarsest levels are moved to the host, see SetHostLevels(), as long as
+        * the time saved in the smoothing, the residual and the intergrid transfers, estimated
+        * from these operator applications, exceeds the time to transfer the vectors of the
+        * boundary level between the backends. Has no effect, if no accelerator is available
+        * or for GlobalMatrix operators.
+        */
+        ROCALUTION_EXPORT
+        void SetAutoHostLevels(bool automatic);
+
         /** \brief Set the MultiGrid Cycle (default: Vcycle) */
         ROCALUTION_EXPORT
         void SetCycle(unsigned int cycle);
@@ -103,6 +152,84 @@ namespace rocalution
         ROCALUTION_EXPORT
         void SetKcycleFull(bool kcycle_full);
 
+        /** \brief Continue W- and K-cycles as V-cycles on small levels
+        * \details
+        * Levels with less than \p nrow (global) rows are visited by V-cycles only, while
+        * the larger levels keep the cycle selected by SetCycle(). W- and K-cycles visit the
+        * coarse levels many times, and in distributed runs these visits are dominated by the
+        * communication latency. Default is 0, i.e. the cycle is used on all levels.
+        */
+        ROCALUTION_EXPORT
+        void SetCycleSwitchSize(int64_t nrow);
+
+        /** \brief Use fixed coefficients for the K-cycle on small levels
+        * \details
+        * The K-cycle accelerates the two cycles of each coarse level by two Krylov steps,
+        * which need three global reductions per visit of the level. On levels with less
+        * than \p nrow (global) rows, \p SetKcycleFixedCoefficients replaces them by the
+        * fixed coefficients \f$x = \alpha B b, \; x = x + \beta B (b - A x)\f$, where
+        * \f$B\f$ denotes the cycle on the next level. Default is 0, i.e. the Krylov
+        * acceleration is used on all K-cycle levels.
+        */
+        ROCALUTION_EXPORT
+        void SetKcycleFixedCoefficients(int64_t nrow, ValueType alpha, ValueType beta);
+
+        /** \brief Use the mult-additive variant of the additive cycle
+        * \details
+        * The additive cycle (Acycle) restricts the residual to all levels, computes the
+        * smoother corrections of all levels independently of each other and sums up their
+        * prolongations. With \p SetMultAdditive, the intergrid transfers are smoothed,
+        * i.e. the residual is restricted by \f$R (I - A S)\f$ and the corrections are
+        * prolonged by \f$(I - S A) P\f$, which yields a convergence close to the V-cycle.
+        * The smoothed restriction and prolongation use the pre- and post-smoothing steps,
+        * respectively, such that only the coarse grid solve is independent of the other
+        * levels. Default is false.
+        */
+        ROCALUTION_EXPORT
+        void SetMultAdditive(bool mult_additive);
+
+        /** \brief Set the number of concurrent level corrections of the additive cycle
+        * \details
+        * The independent level corrections of the additive cycle (Acycle) are computed by
+        * \p num host threads. On the accelerator, the levels are distributed over \p num
+        * execution contexts, such that the smoothers of small levels run concurrently
+        * instead of serializing on a single stream. The level operators are attached to
+        * the contexts of the solver in Build(), thus operators set with
+        * MultiGrid::SetOperatorHierarchy() must not be used after the solver has been
+        * destroyed. Only supported for LocalMatrix hierarchies. Default is 1.
+        */
+        ROCALUTION_EXPORT
+        void SetConcurrentLevels(int num);
+
+        /** \brief Enable/disable the per level timing of the cycles
+        * \details
+        * When enabled, the time spent in the smoothing, the residual computation and the
+        * intergrid transfers is recorded for each level of the cycles. As the accelerator
+        * is synchronized between these phases, the timing is disabled by default.
+        */
+        ROCALUTION_EXPORT
+        void SetLevelTiming(bool timing);
+
+        /** \brief Return the time breakdown of a level
+        * \details
+        * \p GetLevelTime returns the time (in seconds) that has been spent in building the
+        * smoother of \p level and, if enabled by SetLevelTiming(), the accumulated time of
+        * all cycles in the smoothing, the residual computation and the restriction and
+        * prolongation of \p level, where level 0 is the finest level. For the coarsest
+        * level, the build and solve time of the coarse grid solver is returned as smoother
+        * build and smoothing time. Any of the output pointers can be \p NULL.
+        */
+        ROCALUTION_EXPORT
+        void GetLevelTime(int     level,
+                          double* smoother_build,
+                          double* smoothing,
+                          double* residual,
+                          double* transfer) const;
+
+        /** \brief Reset the accumulated per level cycle times */
+        ROCALUTION_EXPORT
+        void ResetLevelTime(void);
+
         /** \brief Set the depth of the multigrid solver */
         ROCALUTION_EXPORT
         void InitLevels(int levels);
@@ -111,6 +238,25 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual void Solve(const VectorType& rhs, VectorType* x);
 
+        /** \brief Solve for all columns of a block of right-hand sides at once
+        * \details
+        * The V-cycle is performed on the whole block, such that the residuals, the
+        * restriction and the prolongation are sparse matrix times multi-vector products
+        * that read each level operator once for all right-hand sides. Smoothers and coarse
+        * grid solvers without block support are applied column by column. Scaling and
+        * fused level operations are not used for blocks, other cycle types are performed
+        * as V-cycles. As a solver, the iteration stops when the largest column residual
+        * norm has converged. Only available for local operators.
+        */
+        ROCALUTION_EXPORT
+        virtual void SolveMulti(const LocalMultiVector<ValueType>& rhs,
+                                LocalMultiVector<ValueType>*       x);
+        /** \brief Solve for all columns of a block of right-hand sides at once, setting
+        * initial x = 0 */
+        ROCALUTION_EXPORT
+        virtual void SolveMultiZeroSol(const LocalMultiVector<ValueType>& rhs,
+                                       LocalMultiVector<ValueType>*       x);
+
         /** \brief Build multigrid solver */
         virtual void Build(void);
         /** \brief Initialize multigrid solver (called from Build()) */
@@ -122,10 +268,15 @@ namespace rocalution
 
     protected:
         /** \brief Restricts a given fine vector to a coarse vector */
-        void Restrict_(const VectorType& fine, VectorType* coarse);
+        virtual void Restrict_(const VectorType& fine, VectorType* coarse);
 
         /** \brief Prolongs a given coarse vector to a fine vector */
-        void Prolong_(const VectorType& coarse, VectorType* fine);
+        virtual void Prolong_(const VectorType& coarse, VectorType* fine);
+
+        /** \brief Return true, if the residual and the restriction of a level can be fused */
+        virtual bool FusableLevel_(int level) const;
+        /** \brief Compute the fused residual restriction operators of all levels */
+        void BuildFusedLevelOperations_(void);
 
         /** \brief V-cycle */
         void Vcycle_(const VectorType& rhs, VectorType* x);
@@ -135,6 +286,40 @@ namespace rocalution
         void Fcycle_(const VectorType& rhs, VectorType* x);
         /** \brief K-cycle */
         void Kcycle_(const VectorType& rhs, VectorType* x);
+        /** \brief V-cycle on a block of right-hand sides */
+        void VcycleMulti_(const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x);
+        /** \brief Allocate the block temporaries of all levels for \p ncol columns */
+        void AllocateMulti_(int ncol);
+        /** \brief Free the block temporaries of all levels */
+        void ClearMulti_(void);
+        /** \brief Additive cycle, called on the finest level only */
+        void Acycle_(const VectorType& rhs, VectorType* x);
+
+        /** \brief Compute the level corrections of the additive cycle, starting with
+        * \p level */
+        void AdditiveCorrections_(int level);
+        /** \brief Synchronize the accelerator, if the levels use execution contexts */
+        void SyncLevels_(void) const;
+
+        /** \brief Start migrating the operators and vectors of a level to the accelerator
+        * (managed memory mode) */
+        void PrefetchLevel_(int level) const;
+
+        /** \brief Record the time since \p begin in \p time of the current level, if the
+        * level timing is enabled, and return the current time */
+        double LevelTimer_(std::vector<double>* time, double begin);
+
+        /** \brief Memory usage tag of a level, see get_memory_usage_tag_rocalution() */
+        std::string LevelMemoryTag_(int level) const;
+        /** \brief Print the current and peak memory usage of all levels */
+        void PrintMemory_(void) const;
+
+        /** \brief Set up and build the smoother \p sm of a level on its operator \p op and
+        * return the build time */
+        double
+            BuildLevelSmoother_(int                                                         level,
+                                const OperatorType&                                         op,
+                                IterativeLinearSolver<OperatorType, VectorType, ValueType>* sm);
 
         /** \private */
         virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
@@ -150,15 +335,21 @@ namespace rocalution
 
         /** \brief Move all level data to the host */
         void MoveHostLevels_(void);
+        /** \brief Select and move the host levels, if enabled by SetAutoHostLevels() */
+        void AutoHostLevels_(void);
 
         /** \brief Number of levels in the hierarchy */
         int levels_;
         /** \brief Host levels */
         int host_level_;
+        /** \brief Select the host levels automatically */
+        bool auto_host_level_;
         /** \brief Current level */
         int current_level_;
         /** \brief Intergrid transfer scaling */
         bool scaling_;
+        /** \brief Fused residual restriction */
+        bool fused_;
         /** \brief Number of pre-smoothing steps */
         int iter_pre_smooth_;
         /** \brief Number of post-smoothing steps */
@@ -167,10 +358,35 @@ namespace rocalution
         unsigned int cycle_;
         /** \brief K-cycle type */
         bool kcycle_full_;
+        /** \brief Levels with less rows continue with V-cycles */
+        int64_t cycle_switch_size_;
+        /** \brief Levels with less rows use fixed K-cycle coefficients */
+        int64_t kcycle_fixed_size_;
+        /** \brief Fixed K-cycle coefficients */
+        ValueType kcycle_alpha_;
+        ValueType kcycle_beta_;
+        /** \brief Mult-additive variant of the additive cycle */
+        bool mult_additive_;
+
+        /** \brief Number of concurrent level corrections */
+        int concurrent_levels_;
+        /** \brief Number of execution contexts */
+        int num_contexts_;
+        /** \brief Execution contexts of the concurrent level corrections */
+        ExecutionContext** contexts_;
 
         /** \brief Residual norm */
         double res_norm_;
 
+        /** \brief Per level cycle timing */
+        bool level_timing_;
+
+        /** \brief Time breakdown per level (in usec) */
+        std::vector<double> time_smoother_build_;
+        std::vector<double> time_smoothing_;
+        std::vector<double> time_residual_;
+        std::vector<double> time_transfer_;
+
         /** \brief Operator hierarchy */
         OperatorType** op_level_;
 
@@ -178,6 +394,8 @@ namespace rocalution
         OperatorType** restrict_op_level_;
         /** \brief Prolongation operator hierarchy */
         OperatorType** prolong_op_level_;
+        /** \brief Fused residual restriction operator hierarchy R * A */
+        OperatorType** fused_op_level_;
 
         VectorType** d_level_; /**< \private */
         VectorType** r_level_; /**< \private */
@@ -185,6 +403,10 @@ namespace rocalution
         VectorType** s_level_; /**< \private */
         VectorType** q_level_; /**< \private */
 
+        LocalMultiVector<ValueType>** mr_level_; /**< \private */
+        LocalMultiVector<ValueType>** mt_level_; /**< \private */
+        LocalMultiVector<ValueType>** md_level_; /**< \private */
+
         /** \brief Transfer mapping */
         LocalVector<int>** trans_level_;
 
@@ -193,6 +415,8 @@ namespace rocalution
 
         /** \brief Smoother for each level */
         IterativeLinearSolver<OperatorType, VectorType, ValueType>** smoother_level_;
+        /** \brief Levels whose smoothers have already been built with the hierarchy */
+        std::vector<bool> smoother_prebuilt_;
     };
 
 } // namespace rocalution
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -83,6 +83,7 @@ namespace rocalution
         LOG_INFO("AMG coarsest operator size = " << this->op_level_[this->levels_ - 2]->GetM());
         int64_t global_nnz = this->op_level_[this->levels_ - 2]->GetNnz();
         LOG_INFO("AMG coarsest level nnz = " << global_nnz);
+        this->PrintMemory_();
         LOG_INFO("AMG with smoother:");
         this->smoother_level_[0]->Print();
     }
@@ -149,6 +150,20 @@ namespace rocalution
         assert(this->build_ == true);
         assert(this->op_ != NULL);
 
+        if(this->UnchangedOperator_() == true)
+        {
+            log_debug(this, "PairwiseAMG::ReBuildNumeric()", " #*# end");
+
+            return;
+        }
+
+        // The aggregates are not part of a hierarchy loaded by LoadHierarchy()
+        if(this->rG_level_.empty() == true)
+        {
+            LOG_INFO("PairwiseAMG::ReBuildNumeric() requires a hierarchy created by Build()");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
         this->op_level_[0]->Clear();
         this->op_level_[0]->CloneBackend(*this->op_);
         this->op_level_[0]->ConvertToCSR();
@@ -205,13 +220,10 @@ namespace rocalution
         this->solver_coarse_->Verbose(0);
 
         // Convert operator to op_format
-        if(this->op_format_ != CSR)
-        {
-            for(int i = 0; i < this->levels_ - 1; ++i)
-            {
-                this->op_level_[i]->ConvertTo(this->op_format_, this->op_blockdim_);
-            }
-        }
+        this->ConvertOperators_();
+
+        // Refresh the fused residual restriction operators
+        this->BuildFusedLevelOperations_();
 
         log_debug(this, "PairwiseAMG::ReBuildNumeric()", " #*# end");
     }
@@ -223,7 +235,7 @@ namespace rocalution
 
         if(this->build_ == true)
         {
-            for(int i = 0; i < this->levels_ - 1; ++i)
+            for(size_t i = 0; i < this->rG_level_.size(); ++i)
             {
                 free_host(&this->rG_level_[i]);
             }
@@ -249,6 +261,14 @@ namespace rocalution
         assert(coarse != NULL);
         assert(trans != NULL);
 
+        // The levels are rebuilt from the transfer mappings, which cannot be composed
+        if(this->aggressive_pass_ == true)
+        {
+            LOG_VERBOSE_INFO(
+                2, "*** warning: PairwiseAMG::Aggregate_() Aggressive coarsening is not supported");
+            return false;
+        }
+
         int  nc;
         int* rG = NULL;
         int  Gsize;
@@ -81,7 +81,12 @@ namespace rocalution
 #endif
         ROCALUTION_EXPORT
         void SetBeta(ValueType beta);
-        /** \brief Set re-ordering for aggregation */
+        /** \brief Set re-ordering for aggregation
+        * \details
+        * The ordering applies to the aggregation on the host. On the accelerator, the
+        * aggregates are formed by a parallel handshake matching, which does not depend on
+        * an ordering.
+        */
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32)
 #else
         [[deprecated("This function will be removed in a future release.")]]
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -24,6 +24,7 @@
 #include "ruge_stueben_amg.hpp"
 #include "../../utils/def.hpp"
 
+#include "../../base/backend_manager.hpp"
 #include "../../base/global_matrix.hpp"
 #include "../../base/global_vector.hpp"
 #include "../../base/local_matrix.hpp"
@@ -33,6 +34,7 @@
 
 #include "../../utils/log.hpp"
 #include "../../utils/math_functions.hpp"
+#include "../../utils/time_functions.hpp"
 
 namespace rocalution
 {
@@ -101,6 +103,22 @@ namespace rocalution
             LOG_INFO("AMG coarsest operator size = " << this->op_level_[this->levels_ - 2]->GetM());
             int64_t global_nnz = this->op_level_[this->levels_ - 2]->GetNnz();
             LOG_INFO("AMG coarsest level nnz = " << global_nnz);
+
+            for(size_t i = 0; i < this->time_galerkin_.size(); ++i)
+            {
+                LOG_INFO("AMG setup level " << i + 1 << " [sec]:"
+                                            << " coarsening=" << this->time_coarsening_[i] / 1e6
+                                            << " interpolation="
+                                            << this->time_interpolation_[i] / 1e6
+                                            << " transpose=" << this->time_transpose_[i] / 1e6
+                                            << " galerkin=" << this->time_galerkin_[i] / 1e6);
+                LOG_INFO("AMG setup level " << i + 1 << " host fallbacks "
+                                            << this->host_fallbacks_[i] << " ("
+                                            << this->host_fallback_time_[i] << " sec)");
+            }
+
+            this->PrintMemory_();
+
             LOG_INFO("AMG with smoother:");
 
             this->smoother_level_[0]->Print();
@@ -186,6 +204,61 @@ namespace rocalution
         this->FF1_ = FF1;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void RugeStuebenAMG<OperatorType, VectorType, ValueType>::GetSetupTime(
+        int      level,
+        double*  coarsening,
+        double*  interpolation,
+        double*  transpose,
+        double*  galerkin,
+        int64_t* host_fallbacks,
+        double*  host_fallback_time) const
+    {
+        log_debug(this,
+                  "RugeStuebenAMG::GetSetupTime()",
+                  level,
+                  coarsening,
+                  interpolation,
+                  transpose,
+                  galerkin,
+                  host_fallbacks,
+                  host_fallback_time);
+
+        assert(this->build_ == true);
+        assert(level >= 0);
+        assert(level < static_cast<int>(this->time_galerkin_.size()));
+
+        if(coarsening != NULL)
+        {
+            *coarsening = this->time_coarsening_[level] / 1e6;
+        }
+
+        if(interpolation != NULL)
+        {
+            *interpolation = this->time_interpolation_[level] / 1e6;
+        }
+
+        if(transpose != NULL)
+        {
+            *transpose = this->time_transpose_[level] / 1e6;
+        }
+
+        if(galerkin != NULL)
+        {
+            *galerkin = this->time_galerkin_[level] / 1e6;
+        }
+
+        if(host_fallbacks != NULL)
+        {
+            *host_fallbacks = this->host_fallbacks_[level];
+        }
+
+        if(host_fallback_time != NULL)
+        {
+            *host_fallback_time = this->host_fallback_time_[level];
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void RugeStuebenAMG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
     {
@@ -195,6 +268,30 @@ namespace rocalution
         assert(this->build_);
         assert(this->op_ != NULL);
 
+        if(this->UnchangedOperator_() == true)
+        {
+            log_debug(this, "RugeStuebenAMG::ReBuildNumeric()", " #*# end");
+
+            return;
+        }
+
+        // Only the Galerkin products are recomputed
+        this->time_coarsening_.assign(this->levels_ - 1, 0.0);
+        this->time_interpolation_.assign(this->levels_ - 1, 0.0);
+        this->time_transpose_.assign(this->levels_ - 1, 0.0);
+        this->time_galerkin_.assign(this->levels_ - 1, 0.0);
+        this->host_fallbacks_.assign(this->levels_ - 1, 0);
+        this->host_fallback_time_.assign(this->levels_ - 1, 0.0);
+
+        int64_t fallbacks_begin;
+        int64_t fallbacks_end;
+        int64_t fallback_bytes;
+        double  fallback_time_begin;
+        double  fallback_time_end;
+        get_host_fallback_rocalution("", &fallbacks_begin, &fallback_bytes, &fallback_time_begin);
+
+        double time_begin = rocalution_time();
+
         // Create coarse operator
         this->op_level_[0]->Clear();
         this->op_level_[0]->ConvertToCSR();
@@ -203,23 +300,43 @@ namespace rocalution
         assert(this->restrict_op_level_[0] != NULL);
         assert(this->prolong_op_level_[0] != NULL);
 
+        // Temporary transfer operators, if they are not stored
+        OperatorType        res_tmp;
+        OperatorType        pro_tmp;
+        const OperatorType* res = this->Restriction_(0, &res_tmp);
+        const OperatorType* pro = this->Prolongation_(0, &pro_tmp);
+
         if(this->op_->GetFormat() != CSR)
         {
             OperatorType op_csr;
             op_csr.CloneFrom(*this->op_);
             op_csr.ConvertToCSR();
 
-            this->op_level_[0]->TripleMatrixProduct(
-                *this->restrict_op_level_[0], op_csr, *this->prolong_op_level_[0]);
+            this->op_level_[0]->TripleMatrixProduct(*res, op_csr, *pro);
         }
         else
         {
-            this->op_level_[0]->TripleMatrixProduct(
-                *this->restrict_op_level_[0], *this->op_, *this->prolong_op_level_[0]);
+            this->op_level_[0]->TripleMatrixProduct(*res, *this->op_, *pro);
         }
 
+        res_tmp.Clear();
+        pro_tmp.Clear();
+
+        this->Sparsify_(1, this->op_level_[0]);
+
+        double time_end = rocalution_time();
+        get_host_fallback_rocalution("", &fallbacks_end, &fallback_bytes, &fallback_time_end);
+
+        this->time_galerkin_[0]      = time_end - time_begin;
+        this->host_fallbacks_[0]     = fallbacks_end - fallbacks_begin;
+        this->host_fallback_time_[0] = fallback_time_end - fallback_time_begin;
+
         for(int i = 1; i < this->levels_ - 1; ++i)
         {
+            fallbacks_begin     = fallbacks_end;
+            fallback_time_begin = fallback_time_end;
+            time_begin          = time_end;
+
             // Create coarse operator
             this->op_level_[i]->Clear();
             this->op_level_[i]->ConvertToCSR();
@@ -233,13 +350,26 @@ namespace rocalution
                 this->op_level_[i - 1]->MoveToHost();
             }
 
-            this->op_level_[i]->TripleMatrixProduct(
-                *this->restrict_op_level_[i], *this->op_level_[i - 1], *this->prolong_op_level_[i]);
+            OperatorType        res_tmp;
+            OperatorType        pro_tmp;
+            const OperatorType* res = this->Restriction_(i, &res_tmp);
+            const OperatorType* pro = this->Prolongation_(i, &pro_tmp);
+
+            this->op_level_[i]->TripleMatrixProduct(*res, *this->op_level_[i - 1], *pro);
+
+            this->Sparsify_(i + 1, this->op_level_[i]);
 
             if(i == this->levels_ - this->host_level_ - 1)
             {
                 this->op_level_[i - 1]->CloneBackend(*this->restrict_op_level_[i - 1]);
             }
+
+            time_end = rocalution_time();
+            get_host_fallback_rocalution("", &fallbacks_end, &fallback_bytes, &fallback_time_end);
+
+            this->time_galerkin_[i]      = time_end - time_begin;
+            this->host_fallbacks_[i]     = fallbacks_end - fallbacks_begin;
+            this->host_fallback_time_[i] = fallback_time_end - fallback_time_begin;
         }
 
         for(int i = 0; i < this->levels_ - 1; ++i)
@@ -262,13 +392,10 @@ namespace rocalution
         this->solver_coarse_->Verbose(0);
 
         // Convert operator to op_format
-        if(this->op_format_ != CSR)
-        {
-            for(int i = 0; i < this->levels_ - 1; ++i)
-            {
-                this->op_level_[i]->ConvertTo(this->op_format_, this->op_blockdim_);
-            }
-        }
+        this->ConvertOperators_();
+
+        // Refresh the fused residual restriction operators
+        this->BuildFusedLevelOperations_();
 
         log_debug(this, "RugeStuebenAMG::ReBuildNumeric()", " #*# end");
     }
@@ -293,6 +420,25 @@ namespace rocalution
         CFmap.CloneBackend(op);
         S.CloneBackend(op);
 
+        // The finest level starts a new setup time breakdown
+        if(&op == this->op_)
+        {
+            this->time_coarsening_.clear();
+            this->time_interpolation_.clear();
+            this->time_transpose_.clear();
+            this->time_galerkin_.clear();
+            this->host_fallbacks_.clear();
+            this->host_fallback_time_.clear();
+        }
+
+        // Host fallbacks prior to this level
+        int64_t fallbacks_begin;
+        int64_t fallback_bytes;
+        double  fallback_time_begin;
+        get_host_fallback_rocalution("", &fallbacks_begin, &fallback_bytes, &fallback_time_begin);
+
+        double time_begin = rocalution_time();
+
         switch(this->coarsening_)
         {
         case Greedy:
@@ -303,6 +449,8 @@ namespace rocalution
             break;
         }
 
+        double time_coarsening = rocalution_time();
+
         // Create prolongation and restriction operators
         switch(this->interpolation_)
         {
@@ -314,6 +462,8 @@ namespace rocalution
             break;
         }
 
+        double time_interpolation = rocalution_time();
+
         // Clean up
         CFmap.Clear();
         S.Clear();
@@ -332,12 +482,44 @@ namespace rocalution
         // Transpose P to obtain R
         pro->Transpose(res);
 
+        double time_transpose = rocalution_time();
+
         // Create coarse operator
         coarse->CloneBackend(op);
 
         // Triple matrix product
         coarse->TripleMatrixProduct(*res, op, *pro);
 
+        double time_galerkin = rocalution_time();
+
+        // Host fallbacks of this level
+        int64_t fallbacks_end;
+        double  fallback_time_end;
+        get_host_fallback_rocalution("", &fallbacks_end, &fallback_bytes, &fallback_time_end);
+
+        // Store the setup time breakdown of this level, the second pass of an aggressively
+        // coarsened level is accounted to the same level
+        if(this->aggressive_pass_ == true)
+        {
+            assert(this->time_coarsening_.empty() == false);
+
+            this->time_coarsening_.back() += time_coarsening - time_begin;
+            this->time_interpolation_.back() += time_interpolation - time_coarsening;
+            this->time_transpose_.back() += time_transpose - time_interpolation;
+            this->time_galerkin_.back() += time_galerkin - time_transpose;
+            this->host_fallbacks_.back() += fallbacks_end - fallbacks_begin;
+            this->host_fallback_time_.back() += fallback_time_end - fallback_time_begin;
+        }
+        else
+        {
+            this->time_coarsening_.push_back(time_coarsening - time_begin);
+            this->time_interpolation_.push_back(time_interpolation - time_coarsening);
+            this->time_transpose_.push_back(time_transpose - time_interpolation);
+            this->time_galerkin_.push_back(time_galerkin - time_transpose);
+            this->host_fallbacks_.push_back(fallbacks_end - fallbacks_begin);
+            this->host_fallback_time_.push_back(fallback_time_end - fallback_time_begin);
+        }
+
         return true;
     }
 
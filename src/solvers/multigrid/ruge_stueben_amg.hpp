@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -77,6 +77,25 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual void ReBuildNumeric(void);
 
+        /** \brief Return the setup time breakdown of a level
+        * \details
+        * \p GetSetupTime returns the time (in seconds) that has been spent in the
+        * coarsening, the interpolation, the transposition of the prolongation and the
+        * Galerkin product when building the coarse operator of \p level, where level 0
+        * is the first coarse level. Additionally, the number of operations that fell back
+        * to the host and the time spent in these host fallbacks are returned. After
+        * ReBuildNumeric(), only the time of the Galerkin product is refreshed, while all
+        * other entries are reset to zero. Any of the output pointers can be \p NULL.
+        */
+        ROCALUTION_EXPORT
+        void GetSetupTime(int      level,
+                          double*  coarsening,
+                          double*  interpolation,
+                          double*  transpose,
+                          double*  galerkin,
+                          int64_t* host_fallbacks     = NULL,
+                          double*  host_fallback_time = NULL) const;
+
     protected:
         virtual bool Aggregate_(const OperatorType& op,
                                 OperatorType*       pro,
@@ -99,6 +118,16 @@ namespace rocalution
 
         /** \brief Interpolation type */
         InterpolationType interpolation_;
+
+        /** \brief Setup time breakdown per level (in usec) */
+        std::vector<double> time_coarsening_;
+        std::vector<double> time_interpolation_;
+        std::vector<double> time_transpose_;
+        std::vector<double> time_galerkin_;
+
+        /** \brief Host fallbacks per level during setup */
+        std::vector<int64_t> host_fallbacks_;
+        std::vector<double>  host_fallback_time_;
     };
 
 } // namespace rocalution
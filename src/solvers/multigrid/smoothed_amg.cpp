@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -38,16 +38,89 @@
 namespace rocalution
 {
 
+    // Near null space prolongation is only available for local operators
+    template <typename ValueType>
+    static bool null_space_prolongation(const LocalMatrix<ValueType>& op,
+                                        ValueType                     relax,
+                                        const LocalVector<bool>&      connections,
+                                        const LocalVector<int64_t>&   aggregates,
+                                        const LocalVector<int64_t>&   aggregate_root_nodes,
+                                        int                           num_null,
+                                        const LocalVector<ValueType>& null_space,
+                                        LocalMatrix<ValueType>*       pro,
+                                        LocalVector<ValueType>*       coarse_null_space,
+                                        int                           lumping_strat)
+    {
+        op.AMGSmoothedAggregation(relax,
+                                  connections,
+                                  aggregates,
+                                  aggregate_root_nodes,
+                                  num_null,
+                                  null_space,
+                                  pro,
+                                  coarse_null_space,
+                                  lumping_strat);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    static bool null_space_prolongation(const GlobalMatrix<ValueType>&,
+                                        ValueType,
+                                        const LocalVector<bool>&,
+                                        const LocalVector<int64_t>&,
+                                        const LocalVector<int64_t>&,
+                                        int,
+                                        const LocalVector<ValueType>&,
+                                        GlobalMatrix<ValueType>*,
+                                        LocalVector<ValueType>*,
+                                        int)
+    {
+        return false;
+    }
+
+    // Truncation and energy minimization of the prolongation are only available for local
+    // operators
+    template <typename ValueType>
+    static bool filter_prolongation(const LocalMatrix<ValueType>& op,
+                                    ValueType                     relax,
+                                    double                        trunc_factor,
+                                    int                           max_row_nnz,
+                                    int                           energy_min_iter,
+                                    LocalMatrix<ValueType>*       pro)
+    {
+        if(trunc_factor > 0.0 || max_row_nnz > 0)
+        {
+            pro->AMGProlongTruncate(trunc_factor, max_row_nnz);
+        }
+
+        op.AMGEnergyMinimization(relax, energy_min_iter, pro);
+
+        return true;
+    }
+
+    template <typename ValueType>
+    static bool filter_prolongation(
+        const GlobalMatrix<ValueType>&, ValueType, double, int, int, GlobalMatrix<ValueType>*)
+    {
+        return false;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     SAAMG<OperatorType, VectorType, ValueType>::SAAMG()
     {
         log_debug(this, "SAAMG::SAAMG()", "default constructor");
 
         // parameter for strong couplings in smoothed aggregation
-        this->eps_           = static_cast<ValueType>(0.01f);
-        this->relax_         = static_cast<ValueType>(2.f / 3.f);
-        this->strat_         = CoarseningStrategy::Greedy;
-        this->lumping_strat_ = LumpingStrategy::AddWeakConnections;
+        this->eps_             = static_cast<ValueType>(0.01f);
+        this->relax_           = static_cast<ValueType>(2.f / 3.f);
+        this->strat_           = CoarseningStrategy::Greedy;
+        this->blockdim_        = 1;
+        this->lumping_strat_   = LumpingStrategy::AddWeakConnections;
+        this->num_null_        = 0;
+        this->trunc_factor_    = 0.0;
+        this->max_row_nnz_     = 0;
+        this->energy_min_iter_ = 0;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -80,8 +153,22 @@ namespace rocalution
             LOG_INFO(
                 "SAAMG lumping strategy subtracts weak connections to diagonal in filter matrix");
         }
+        if(this->num_null_ > 0)
+        {
+            LOG_INFO("SAAMG near null space dimension = " << this->num_null_);
+        }
+        if(this->trunc_factor_ > 0.0 || this->max_row_nnz_ > 0)
+        {
+            LOG_INFO("SAAMG prolongation truncation factor = "
+                     << this->trunc_factor_ << ", max row nnz = " << this->max_row_nnz_);
+        }
+        if(this->energy_min_iter_ > 0)
+        {
+            LOG_INFO("SAAMG prolongation energy minimization steps = " << this->energy_min_iter_);
+        }
         LOG_INFO("SAAMG coarsest operator size = " << this->op_level_[this->levels_ - 2]->GetM());
         LOG_INFO("SAAMG coarsest level nnz = " << this->op_level_[this->levels_ - 2]->GetNnz());
+        this->PrintMemory_();
         LOG_INFO("SAAMG with smoother:");
         this->smoother_level_[0]->Print();
     }
@@ -110,6 +197,19 @@ namespace rocalution
             LOG_INFO(
                 "SAAMG lumping strategy subtracts weak connections to diagonal in filter matrix");
         }
+        if(this->num_null_ > 0)
+        {
+            LOG_INFO("SAAMG near null space dimension = " << this->num_null_);
+        }
+        if(this->trunc_factor_ > 0.0 || this->max_row_nnz_ > 0)
+        {
+            LOG_INFO("SAAMG prolongation truncation factor = "
+                     << this->trunc_factor_ << ", max row nnz = " << this->max_row_nnz_);
+        }
+        if(this->energy_min_iter_ > 0)
+        {
+            LOG_INFO("SAAMG prolongation energy minimization steps = " << this->energy_min_iter_);
+        }
         LOG_INFO("SAAMG coarsest operator size = " << this->op_level_[this->levels_ - 2]->GetM());
         LOG_INFO("SAAMG coarsest level nnz = " << this->op_level_[this->levels_ - 2]->GetNnz());
         LOG_INFO("SAAMG with smoother:");
@@ -146,6 +246,16 @@ namespace rocalution
         this->strat_ = strat;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SAAMG<OperatorType, VectorType, ValueType>::SetBlockDimension(int blockdim)
+    {
+        log_debug(this, "SAAMG::SetBlockDimension()", blockdim);
+
+        assert(blockdim > 0);
+
+        this->blockdim_ = blockdim;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void SAAMG<OperatorType, VectorType, ValueType>::SetLumpingStrategy(
         LumpingStrategy lumping_strat)
@@ -156,61 +266,76 @@ namespace rocalution
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
-    void SAAMG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    void SAAMG<OperatorType, VectorType, ValueType>::SetProlongTruncation(double trunc_factor,
+                                                                          int    max_row_nnz)
     {
-        log_debug(this, "SAAMG::ReBuildNumeric()", " #*# begin");
+        log_debug(this, "SAAMG::SetProlongTruncation()", trunc_factor, max_row_nnz);
 
-        assert(this->levels_ > 1);
-        assert(this->build_);
-        assert(this->op_ != NULL);
+        assert(trunc_factor >= 0.0);
+        assert(max_row_nnz >= 0);
 
-        // Create coarse operator
-        this->op_level_[0]->Clear();
-        this->op_level_[0]->ConvertToCSR();
-        this->op_level_[0]->CloneBackend(*this->op_);
+        this->trunc_factor_ = trunc_factor;
+        this->max_row_nnz_  = max_row_nnz;
+    }
 
-        assert(this->restrict_op_level_[0] != NULL);
-        assert(this->prolong_op_level_[0] != NULL);
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SAAMG<OperatorType, VectorType, ValueType>::SetEnergyMinimization(int iterations)
+    {
+        log_debug(this, "SAAMG::SetEnergyMinimization()", iterations);
 
-        if(this->op_->GetFormat() != CSR)
-        {
-            OperatorType op_csr;
-            op_csr.CloneFrom(*this->op_);
-            op_csr.ConvertToCSR();
+        assert(iterations >= 0);
 
-            this->op_level_[0]->TripleMatrixProduct(
-                *this->restrict_op_level_[0], op_csr, *this->prolong_op_level_[0]);
-        }
-        else
-        {
-            this->op_level_[0]->TripleMatrixProduct(
-                *this->restrict_op_level_[0], *this->op_, *this->prolong_op_level_[0]);
-        }
+        this->energy_min_iter_ = iterations;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SAAMG<OperatorType, VectorType, ValueType>::SetNearNullSpace(int               num_null,
+                                                                      const VectorType* null_space)
+    {
+        log_debug(this, "SAAMG::SetNearNullSpace()", num_null, null_space);
 
-        for(int i = 1; i < this->levels_ - 1; ++i)
+        assert(num_null >= 0);
+        assert(num_null == 0 || null_space != NULL);
+
+        this->num_null_ = num_null;
+        this->null_space_.Clear();
+        this->level_null_space_.Clear();
+
+        if(num_null > 0)
         {
-            // Create coarse operator
-            this->op_level_[i]->Clear();
-            this->op_level_[i]->ConvertToCSR();
-            this->op_level_[i]->CloneBackend(*this->op_);
+            int64_t size = null_space[0].GetInterior().GetSize();
 
-            assert(this->restrict_op_level_[i] != NULL);
-            assert(this->prolong_op_level_[i] != NULL);
+            this->null_space_.CloneBackend(null_space[0].GetInterior());
+            this->null_space_.Allocate("near null space", size * num_null);
 
-            if(i == this->levels_ - this->host_level_ - 1)
+            for(int j = 0; j < num_null; ++j)
             {
-                this->op_level_[i - 1]->MoveToHost();
+                assert(null_space[j].GetInterior().GetSize() == size);
+
+                this->null_space_.CopyFrom(null_space[j].GetInterior(), 0, j * size, size);
             }
+        }
+    }
 
-            this->op_level_[i]->TripleMatrixProduct(
-                *this->restrict_op_level_[i], *this->op_level_[i - 1], *this->prolong_op_level_[i]);
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SAAMG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "SAAMG::ReBuildNumeric()", " #*# begin");
 
-            if(i == this->levels_ - this->host_level_ - 1)
-            {
-                this->op_level_[i - 1]->CloneBackend(*this->restrict_op_level_[i - 1]);
-            }
+        assert(this->levels_ > 1);
+        assert(this->build_);
+        assert(this->op_ != NULL);
+
+        if(this->UnchangedOperator_() == true)
+        {
+            log_debug(this, "SAAMG::ReBuildNumeric()", " #*# end");
+
+            return;
         }
 
+        // Recompute the coarse operators
+        this->ReBuildGalerkin_();
+
         for(int i = 0; i < this->levels_ - 1; ++i)
         {
             if(i > 0)
@@ -231,13 +356,10 @@ namespace rocalution
         this->solver_coarse_->Verbose(0);
 
         // Convert operator to op_format
-        if(this->op_format_ != CSR)
-        {
-            for(int i = 0; i < this->levels_ - 1; ++i)
-            {
-                this->op_level_[i]->ConvertTo(this->op_format_, this->op_blockdim_);
-            }
-        }
+        this->ConvertOperators_();
+
+        // Refresh the fused residual restriction operators
+        this->BuildFusedLevelOperations_();
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -266,26 +388,169 @@ namespace rocalution
         {
             eps *= static_cast<ValueType>(0.5);
         }
-        switch(strat_)
+        bool block_aggregation = this->blockdim_ > 1;
+
+        if(block_aggregation == true && (op.GetM() % this->blockdim_ != 0))
         {
-        case Greedy:
-            op.AMGGreedyAggregate(eps, &connections, &aggregates, &aggregate_root_nodes);
-            break;
-        case PMIS:
-            op.AMGPMISAggregate(eps, &connections, &aggregates, &aggregate_root_nodes);
-            break;
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: SAAMG::Aggregate_() operator size is not a multiple of "
+                             "the block dimension, using scalar aggregation");
+            block_aggregation = false;
         }
 
-        switch(lumping_strat_)
+        if(block_aggregation == true)
         {
-        case AddWeakConnections:
-            op.AMGSmoothedAggregation(
-                this->relax_, connections, aggregates, aggregate_root_nodes, pro, 0);
-            break;
-        case SubtractWeakConnections:
-            op.AMGSmoothedAggregation(
-                this->relax_, connections, aggregates, aggregate_root_nodes, pro, 1);
-            break;
+            // Aggregate the nodes and expand the aggregates to the dofs of each block
+            OperatorType node;
+            node.CloneBackend(op);
+
+            LocalVector<bool>    node_connections;
+            LocalVector<int64_t> node_aggregates;
+            LocalVector<int64_t> node_aggregate_root_nodes;
+
+            node_connections.CloneBackend(op);
+            node_aggregates.CloneBackend(op);
+            node_aggregate_root_nodes.CloneBackend(op);
+
+            op.AMGNodeGraph(this->blockdim_, &node);
+
+            switch(strat_)
+            {
+            case Greedy:
+                node.AMGGreedyAggregate(
+                    eps, &node_connections, &node_aggregates, &node_aggregate_root_nodes);
+                break;
+            case PMIS:
+                node.AMGPMISAggregate(
+                    eps, &node_connections, &node_aggregates, &node_aggregate_root_nodes);
+                break;
+            }
+
+            op.AMGNodeExpand(this->blockdim_,
+                             node,
+                             node_connections,
+                             node_aggregates,
+                             node_aggregate_root_nodes,
+                             &connections,
+                             &aggregates,
+                             &aggregate_root_nodes);
+        }
+        else
+        {
+            switch(strat_)
+            {
+            case Greedy:
+                op.AMGGreedyAggregate(eps, &connections, &aggregates, &aggregate_root_nodes);
+                break;
+            case PMIS:
+                op.AMGPMISAggregate(eps, &connections, &aggregates, &aggregate_root_nodes);
+                break;
+            }
+        }
+
+        bool null_space = this->num_null_ > 0;
+
+        if(null_space == true)
+        {
+            // The near null space of the finest level is given by the user, each coarser
+            // level uses the one computed along with the previous prolongation
+            if(&op == this->op_)
+            {
+                this->level_null_space_.Clear();
+                this->level_null_space_.CloneFrom(this->null_space_);
+            }
+
+            if(this->level_null_space_.GetSize() != op.GetLocalM() * this->num_null_)
+            {
+                // An empty near null space has already been reported on a finer level
+                if(this->level_null_space_.GetSize() > 0)
+                {
+                    LOG_INFO("*** warning: SAAMG::Aggregate_() near null space does not match "
+                             "the operator size, using the constant vector");
+                }
+
+                this->level_null_space_.Clear();
+                null_space = false;
+            }
+        }
+
+        if(null_space == true)
+        {
+            LocalVector<ValueType> level_null_space;
+            LocalVector<ValueType> coarse_null_space;
+
+            level_null_space.CloneBackend(op);
+            coarse_null_space.CloneBackend(op);
+
+            level_null_space.CopyFrom(this->level_null_space_);
+
+            null_space = null_space_prolongation(
+                op,
+                this->relax_,
+                connections,
+                aggregates,
+                aggregate_root_nodes,
+                this->num_null_,
+                level_null_space,
+                pro,
+                &coarse_null_space,
+                this->lumping_strat_ == SubtractWeakConnections ? 1 : 0);
+
+            if(null_space == true)
+            {
+                this->level_null_space_.Clear();
+                this->level_null_space_.CloneFrom(coarse_null_space);
+            }
+            else
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: SAAMG::Aggregate_() near null space is not "
+                                 "supported for this operator, using the constant vector");
+
+                this->level_null_space_.Clear();
+            }
+        }
+
+        if(null_space == false)
+        {
+            switch(lumping_strat_)
+            {
+            case AddWeakConnections:
+                op.AMGSmoothedAggregation(
+                    this->relax_, connections, aggregates, aggregate_root_nodes, pro, 0);
+                break;
+            case SubtractWeakConnections:
+                op.AMGSmoothedAggregation(
+                    this->relax_, connections, aggregates, aggregate_root_nodes, pro, 1);
+                break;
+            }
+        }
+
+        if(this->trunc_factor_ > 0.0 || this->max_row_nnz_ > 0 || this->energy_min_iter_ > 0)
+        {
+            // Energy minimization keeps the row sums of P, which is the interpolation of the
+            // constant vector only
+            int energy_min_iter = null_space == true ? 0 : this->energy_min_iter_;
+
+            if(null_space == true && this->energy_min_iter_ > 0)
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: SAAMG::Aggregate_() energy minimization is not "
+                                 "supported with a near null space");
+            }
+
+            if(filter_prolongation(op,
+                                   this->relax_,
+                                   this->trunc_factor_,
+                                   this->max_row_nnz_,
+                                   energy_min_iter,
+                                   pro)
+               == false)
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: SAAMG::Aggregate_() prolongation truncation and "
+                                 "energy minimization are not supported for this operator");
+            }
         }
 
         // Clean up
@@ -67,10 +67,55 @@ namespace rocalution
         ROCALUTION_EXPORT
         void SetCoarseningStrategy(CoarseningStrategy strat);
 
+        /** \brief Set the block dimension for block-aware aggregation
+        * \details
+        * If \p blockdim is larger than 1, each \p blockdim x \p blockdim block of the
+        * operator is treated as a single node during aggregation, see
+        * LocalMatrix::AMGNodeGraph(). The coarse operators then keep the block structure
+        * and can be stored in BCSR format without padding, see
+        * BaseAMG::SetOperatorFormat(). Default is 1.
+        */
+        ROCALUTION_EXPORT
+        void SetBlockDimension(int blockdim);
+
         /** \brief Set lumping strategy */
         ROCALUTION_EXPORT
         void SetLumpingStrategy(LumpingStrategy lumping_strat);
 
+        /** \brief Set the truncation of the prolongation
+        * \details
+        * Smoothed prolongations can lead to dense coarse operators. Entries of each row
+        * of the prolongation that are smaller than \p trunc_factor times the largest entry
+        * of the row are dropped, and at most \p max_row_nnz entries are kept per row (0
+        * for no limit). The remaining entries are scaled to preserve the row sums, see
+        * LocalMatrix::AMGProlongTruncate(). Default is no truncation.
+        */
+        ROCALUTION_EXPORT
+        void SetProlongTruncation(double trunc_factor, int max_row_nnz = 0);
+
+        /** \brief Set the number of energy minimization steps of the prolongation
+        * \details
+        * After smoothing (and truncation), the prolongation is improved by \p iterations
+        * energy minimization steps on its sparsity pattern, see
+        * LocalMatrix::AMGEnergyMinimization(). This recovers most of the accuracy lost by
+        * a truncated prolongation without adding fill. Default is 0.
+        */
+        ROCALUTION_EXPORT
+        void SetEnergyMinimization(int iterations);
+
+        /** \brief Set the near null space of the operator
+        * \details
+        * By default, the tentative prolongation interpolates the constant vector on
+        * each aggregate. For systems like linear elasticity, the near null space consists
+        * of several vectors (e.g. the rigid body modes), and each aggregate gets one
+        * coarse dof per vector, which is required for optimal convergence. The
+        * \p num_null vectors in \p null_space are copied and must have the size of the
+        * operator. Setting \p num_null to 0 restores the default. Only supported for
+        * LocalMatrix operators, GlobalMatrix operators fall back to the constant vector.
+        */
+        ROCALUTION_EXPORT
+        void SetNearNullSpace(int num_null, const VectorType* null_space);
+
         ROCALUTION_EXPORT
         virtual void ReBuildNumeric(void);
 
@@ -94,8 +139,27 @@ namespace rocalution
         /** \brief Coarsening strategy */
         CoarseningStrategy strat_;
 
+        /** \brief Block dimension for block-aware aggregation */
+        int blockdim_;
+
         /** \brief Lumping strategy */
         LumpingStrategy lumping_strat_;
+
+        /** \brief Truncation factor and maximum row length of the prolongation */
+        double trunc_factor_;
+        int    max_row_nnz_;
+
+        /** \brief Number of energy minimization steps of the prolongation */
+        int energy_min_iter_;
+
+        /** \brief Number of near null space vectors */
+        int num_null_;
+
+        /** \brief Near null space of the operator, vectors stored one after another */
+        LocalVector<ValueType> null_space_;
+
+        /** \brief Near null space of the current level during the hierarchy build */
+        LocalVector<ValueType> level_null_space_;
     };
 
 } // namespace rocalution
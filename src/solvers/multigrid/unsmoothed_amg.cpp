@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -46,6 +46,7 @@ namespace rocalution
         this->eps_         = static_cast<ValueType>(0.01f);
         this->over_interp_ = static_cast<ValueType>(1.5f);
         this->strat_       = CoarseningStrategy::Greedy;
+        this->blockdim_    = 1;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -64,6 +65,7 @@ namespace rocalution
         LOG_INFO("UAAMG using unsmoothed aggregation");
         LOG_INFO("UAAMG coarsest operator size = " << this->op_level_[this->levels_ - 2]->GetM());
         LOG_INFO("UAAMG coarsest level nnz = " << this->op_level_[this->levels_ - 2]->GetNnz());
+        this->PrintMemory_();
         LOG_INFO("UAAMG with smoother:");
         this->smoother_level_[0]->Print();
     }
@@ -112,6 +114,16 @@ namespace rocalution
         this->strat_ = strat;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void UAAMG<OperatorType, VectorType, ValueType>::SetBlockDimension(int blockdim)
+    {
+        log_debug(this, "UAAMG::SetBlockDimension()", blockdim);
+
+        assert(blockdim > 0);
+
+        this->blockdim_ = blockdim;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void UAAMG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
     {
@@ -121,55 +133,15 @@ namespace rocalution
         assert(this->build_);
         assert(this->op_ != NULL);
 
-        // Create coarse operator
-        this->op_level_[0]->Clear();
-        this->op_level_[0]->ConvertToCSR();
-        this->op_level_[0]->CloneBackend(*this->op_);
-
-        assert(this->restrict_op_level_[0] != NULL);
-        assert(this->prolong_op_level_[0] != NULL);
-
-        if(this->op_->GetFormat() != CSR)
+        if(this->UnchangedOperator_() == true)
         {
-            OperatorType op_csr;
-            op_csr.CloneFrom(*this->op_);
-            op_csr.ConvertToCSR();
+            log_debug(this, "UAAMG::ReBuildNumeric()", " #*# end");
 
-            this->op_level_[0]->TripleMatrixProduct(
-                *this->restrict_op_level_[0], op_csr, *this->prolong_op_level_[0]);
-        }
-        else
-        {
-            this->op_level_[0]->TripleMatrixProduct(
-                *this->restrict_op_level_[0], *this->op_, *this->prolong_op_level_[0]);
+            return;
         }
 
-        for(int i = 1; i < this->levels_ - 1; ++i)
-        {
-            this->op_level_[i]->Clear();
-            this->op_level_[i]->ConvertToCSR();
-
-            // Create coarse operator
-            OperatorType tmp;
-            tmp.CloneBackend(*this->op_);
-            this->op_level_[i]->CloneBackend(*this->op_);
-
-            assert(this->restrict_op_level_[i] != NULL);
-            assert(this->prolong_op_level_[i] != NULL);
-
-            if(i == this->levels_ - this->host_level_ - 1)
-            {
-                this->op_level_[i - 1]->MoveToHost();
-            }
-
-            this->op_level_[i]->TripleMatrixProduct(
-                *this->restrict_op_level_[i], *this->op_level_[i - 1], *this->prolong_op_level_[i]);
-
-            if(i == this->levels_ - this->host_level_ - 1)
-            {
-                this->op_level_[i - 1]->CloneBackend(*this->restrict_op_level_[i - 1]);
-            }
-        }
+        // Recompute the coarse operators
+        this->ReBuildGalerkin_();
 
         for(int i = 0; i < this->levels_ - 1; ++i)
         {
@@ -191,13 +163,10 @@ namespace rocalution
         this->solver_coarse_->Verbose(0);
 
         // Convert operator to op_format
-        if(this->op_format_ != CSR)
-        {
-            for(int i = 0; i < this->levels_ - 1; ++i)
-            {
-                this->op_level_[i]->ConvertTo(this->op_format_, this->op_blockdim_);
-            }
-        }
+        this->ConvertOperators_();
+
+        // Refresh the fused residual restriction operators
+        this->BuildFusedLevelOperations_();
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -226,14 +195,64 @@ namespace rocalution
         {
             eps *= static_cast<ValueType>(0.5);
         }
-        switch(strat_)
+        bool block_aggregation = this->blockdim_ > 1;
+
+        if(block_aggregation == true && (op.GetM() % this->blockdim_ != 0))
         {
-        case Greedy:
-            op.AMGGreedyAggregate(eps, &connections, &aggregates, &aggregate_root_nodes);
-            break;
-        case PMIS:
-            op.AMGPMISAggregate(eps, &connections, &aggregates, &aggregate_root_nodes);
-            break;
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: UAAMG::Aggregate_() operator size is not a multiple of "
+                             "the block dimension, using scalar aggregation");
+            block_aggregation = false;
+        }
+
+        if(block_aggregation == true)
+        {
+            // Aggregate the nodes and expand the aggregates to the dofs of each block
+            OperatorType node;
+            node.CloneBackend(op);
+
+            LocalVector<bool>    node_connections;
+            LocalVector<int64_t> node_aggregates;
+            LocalVector<int64_t> node_aggregate_root_nodes;
+
+            node_connections.CloneBackend(op);
+            node_aggregates.CloneBackend(op);
+            node_aggregate_root_nodes.CloneBackend(op);
+
+            op.AMGNodeGraph(this->blockdim_, &node);
+
+            switch(strat_)
+            {
+            case Greedy:
+                node.AMGGreedyAggregate(
+                    eps, &node_connections, &node_aggregates, &node_aggregate_root_nodes);
+                break;
+            case PMIS:
+                node.AMGPMISAggregate(
+                    eps, &node_connections, &node_aggregates, &node_aggregate_root_nodes);
+                break;
+            }
+
+            op.AMGNodeExpand(this->blockdim_,
+                             node,
+                             node_connections,
+                             node_aggregates,
+                             node_aggregate_root_nodes,
+                             &connections,
+                             &aggregates,
+                             &aggregate_root_nodes);
+        }
+        else
+        {
+            switch(strat_)
+            {
+            case Greedy:
+                op.AMGGreedyAggregate(eps, &connections, &aggregates, &aggregate_root_nodes);
+                break;
+            case PMIS:
+                op.AMGPMISAggregate(eps, &connections, &aggregates, &aggregate_root_nodes);
+                break;
+            }
         }
 
         op.AMGUnsmoothedAggregation(aggregates, aggregate_root_nodes, pro);
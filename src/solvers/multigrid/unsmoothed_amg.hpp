@@ -68,6 +68,17 @@ namespace rocalution
         ROCALUTION_EXPORT
         void SetCoarseningStrategy(CoarseningStrategy strat);
 
+        /** \brief Set the block dimension for block-aware aggregation
+        * \details
+        * If \p blockdim is larger than 1, each \p blockdim x \p blockdim block of the
+        * operator is treated as a single node during aggregation, see
+        * LocalMatrix::AMGNodeGraph(). The coarse operators then keep the block structure
+        * and can be stored in BCSR format without padding, see
+        * BaseAMG::SetOperatorFormat(). Default is 1.
+        */
+        ROCALUTION_EXPORT
+        void SetBlockDimension(int blockdim);
+
         ROCALUTION_EXPORT
         virtual void ReBuildNumeric(void);
 
@@ -90,6 +101,9 @@ namespace rocalution
 
         /** \brief Coarsening strategy */
         CoarseningStrategy strat_;
+
+        /** \brief Block dimension for block-aware aggregation */
+        int blockdim_;
     };
 
 } // namespace rocalution
@@ -24,6 +24,7 @@
 #include "preconditioner.hpp"
 #include "../../base/global_matrix.hpp"
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_shell_operator.hpp"
 #include "../../utils/def.hpp"
 #include "../solver.hpp"
 
@@ -32,11 +33,88 @@
 
 #include "../../utils/log.hpp"
 
+#include <algorithm>
 #include <complex>
+#include <map>
 #include <math.h>
 
 namespace rocalution
 {
+    // Lock that serializes the application of a shared preconditioner, all
+    // SharedPreconditioner objects of the same preconditioner obtain the same lock
+    static std::shared_ptr<std::mutex> shared_precond_lock(const void* precond)
+    {
+        static std::mutex                                       registry_mutex;
+        static std::map<const void*, std::weak_ptr<std::mutex>> registry;
+
+        std::lock_guard<std::mutex> guard(registry_mutex);
+
+        // Drop the locks of preconditioners that are no longer shared
+        for(auto it = registry.begin(); it != registry.end();)
+        {
+            it = (it->second.expired() == true) ? registry.erase(it) : std::next(it);
+        }
+
+        std::shared_ptr<std::mutex> lock = registry[precond].lock();
+
+        if(lock == nullptr)
+        {
+            lock              = std::make_shared<std::mutex>();
+            registry[precond] = lock;
+        }
+
+        return lock;
+    }
+
+    // Resolve TriSolverAlg_Auto from the depth of the triangular dependency graphs
+    template <class OperatorType>
+    static void
+        select_tri_solver_alg(SolverDescr* descr, const OperatorType& op, bool lower, bool upper)
+    {
+        if(descr->GetTriSolverAlg() != TriSolverAlg_Auto)
+        {
+            return;
+        }
+
+        int levels = 0;
+
+        if(lower == true)
+        {
+            levels = std::max(levels, op.GetTriangularLevels(true));
+        }
+
+        if(upper == true)
+        {
+            levels = std::max(levels, op.GetTriangularLevels(false));
+        }
+
+        descr->SelectTriSolverAlg(op.GetM(), levels);
+    }
+
+    // Block Jacobi sweeps x = inv (rhs - off x) of TriSolverAlg_BlockInverse
+    template <class OperatorType, class VectorType, typename ValueType>
+    static void block_tri_solve(const SolverDescr&  descr,
+                                const OperatorType& inv,
+                                const OperatorType& off,
+                                const VectorType&   rhs,
+                                VectorType*         r,
+                                VectorType*         x)
+    {
+        // The sweeps are exact after as many sweeps as there are blocks
+        int64_t nblocks = (inv.GetM() + descr.GetTriSolverBlockSize() - 1)
+                          / descr.GetTriSolverBlockSize();
+        int64_t sweeps  = std::min(static_cast<int64_t>(descr.GetIterativeSolverMaxIteration()),
+                                  nblocks);
+
+        inv.Apply(rhs, x);
+
+        for(int64_t k = 1; k < sweeps; ++k)
+        {
+            r->CopyFrom(rhs);
+            off.ApplyAdd(*x, static_cast<ValueType>(-1), r);
+            inv.Apply(*r, x);
+        }
+    }
 
     template <class OperatorType, class VectorType, typename ValueType>
     Preconditioner<OperatorType, VectorType, ValueType>::Preconditioner()
@@ -96,6 +174,8 @@ namespace rocalution
     {
         log_debug(this, "Jacobi::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("Jacobi::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -133,6 +213,13 @@ namespace rocalution
         this->build_ = false;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    bool Jacobi<OperatorType, VectorType, ValueType>::SupportsGraphCapture(void) const
+    {
+        // Without diagonal, Solve() is a synchronous copy
+        return this->inv_diag_entries_.GetSize() > 0;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void Jacobi<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, VectorType* x)
     {
@@ -165,6 +252,55 @@ namespace rocalution
         log_debug(this, "Jacobi::Solve()", " #*# end");
     }
 
+    // Row scaling of a block, only available for local vectors
+    template <typename ValueType>
+    static bool block_pointwise_mult(const LocalVector<ValueType>&      d,
+                                     const LocalMultiVector<ValueType>& rhs,
+                                     LocalMultiVector<ValueType>*       x)
+    {
+        x->CopyFrom(rhs);
+        x->PointWiseMult(d);
+
+        return true;
+    }
+
+    template <class VectorType, typename ValueType>
+    static bool block_pointwise_mult(const VectorType&                  d,
+                                     const LocalMultiVector<ValueType>& rhs,
+                                     LocalMultiVector<ValueType>*       x)
+    {
+        return false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Jacobi<OperatorType, VectorType, ValueType>::SolveMulti(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "Jacobi::SolveMulti()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+        assert(x != &rhs);
+
+        if(this->inv_diag_entries_.GetSize() == 0)
+        {
+            x->CopyFrom(rhs);
+        }
+        else if(block_pointwise_mult(this->inv_diag_entries_, rhs, x) == false)
+        {
+            Solver<OperatorType, VectorType, ValueType>::SolveMulti(rhs, x);
+        }
+
+        log_debug(this, "Jacobi::SolveMulti()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Jacobi<OperatorType, VectorType, ValueType>::SolveMultiZeroSol(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        this->SolveMulti(rhs, x);
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void Jacobi<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
     {
@@ -181,6 +317,130 @@ namespace rocalution
         this->inv_diag_entries_.MoveToAccelerator();
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    PointBlockJacobi<OperatorType, VectorType, ValueType>::PointBlockJacobi()
+    {
+        log_debug(this, "PointBlockJacobi::PointBlockJacobi()", "default constructor");
+
+        this->blockdim_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    PointBlockJacobi<OperatorType, VectorType, ValueType>::~PointBlockJacobi()
+    {
+        log_debug(this, "PointBlockJacobi::~PointBlockJacobi()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PointBlockJacobi<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("Point-Block Jacobi preconditioner");
+
+        if(this->build_ == true)
+        {
+            LOG_INFO("Block dimension = " << this->inv_diag_blocks_.GetBlockDimension());
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PointBlockJacobi<OperatorType, VectorType, ValueType>::SetBlockDimension(int blockdim)
+    {
+        log_debug(this, "PointBlockJacobi::SetBlockDimension()", blockdim);
+
+        assert(blockdim > 0);
+        assert(this->build_ == false);
+
+        this->blockdim_ = blockdim;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PointBlockJacobi<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "PointBlockJacobi::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("PointBlockJacobi::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+
+        int blockdim = this->blockdim_ > 0 ? this->blockdim_ : this->op_->GetBlockDimension();
+
+        // Batched inversion of the dense diagonal blocks
+        this->inv_diag_blocks_.CloneBackend(*this->op_);
+        this->op_->ExtractInverseBlockDiagonal(blockdim, &this->inv_diag_blocks_);
+
+        // The block diagonal product is carried out in BCSR format
+        if(blockdim > 1)
+        {
+            this->inv_diag_blocks_.ConvertToBCSR(blockdim);
+        }
+
+        this->tmp_.CloneBackend(*this->op_);
+        this->tmp_.Allocate("Point-block Jacobi temporary", this->op_->GetM());
+
+        log_debug(this, "PointBlockJacobi::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PointBlockJacobi<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "PointBlockJacobi::Clear()", this->build_);
+
+        this->inv_diag_blocks_.Clear();
+        this->tmp_.Clear();
+
+        this->build_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PointBlockJacobi<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
+                                                                      VectorType*       x)
+    {
+        log_debug(this, "PointBlockJacobi::Solve()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+
+        if(x != &rhs)
+        {
+            this->inv_diag_blocks_.Apply(rhs, x);
+        }
+        else
+        {
+            this->tmp_.CopyFrom(rhs);
+            this->inv_diag_blocks_.Apply(this->tmp_, x);
+        }
+
+        log_debug(this, "PointBlockJacobi::Solve()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PointBlockJacobi<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "PointBlockJacobi::MoveToHostLocalData_()", this->build_);
+
+        this->inv_diag_blocks_.MoveToHost();
+        this->tmp_.MoveToHost();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void PointBlockJacobi<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "PointBlockJacobi::MoveToAcceleratorLocalData_()", this->build_);
+
+        this->inv_diag_blocks_.MoveToAccelerator();
+        this->tmp_.MoveToAccelerator();
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     GS<OperatorType, VectorType, ValueType>::GS()
     {
@@ -207,6 +467,8 @@ namespace rocalution
     {
         log_debug(this, "GS::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("GS::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -217,7 +479,8 @@ namespace rocalution
 
         assert(this->op_ != NULL);
 
-        this->GS_.CloneFrom(*this->op_);
+        this->GS_.ShareStructureFrom(*this->op_);
+        select_tri_solver_alg(&this->solver_descr_, this->GS_, true, false);
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->GS_, LAnalyse, false);
 
         log_debug(this, "GS::Build()", this->build_, " #*# end");
@@ -231,7 +494,8 @@ namespace rocalution
         assert(this->op_ != NULL);
 
         this->GS_.Clear();
-        this->GS_.CloneFrom(*this->op_);
+        this->GS_.ShareStructureFrom(*this->op_);
+        select_tri_solver_alg(&this->solver_descr_, this->GS_, true, false);
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->GS_, LAnalyse, false);
     }
 
@@ -303,6 +567,8 @@ namespace rocalution
     {
         log_debug(this, "SGS::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("SGS::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -313,7 +579,8 @@ namespace rocalution
 
         assert(this->op_ != NULL);
 
-        this->SGS_.CloneFrom(*this->op_);
+        this->SGS_.ShareStructureFrom(*this->op_);
+        select_tri_solver_alg(&this->solver_descr_, this->SGS_, true, true);
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->SGS_, LAnalyse, false);
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->SGS_, UAnalyse, false);
 
@@ -334,12 +601,13 @@ namespace rocalution
         assert(this->op_ != NULL);
 
         this->SGS_.Clear();
-        this->SGS_.CloneFrom(*this->op_);
+        this->SGS_.ShareStructureFrom(*this->op_);
 
         this->diag_entries_.Clear();
         this->diag_entries_.CloneBackend(*this->op_);
         this->SGS_.ExtractDiagonal(&this->diag_entries_);
 
+        select_tri_solver_alg(&this->solver_descr_, this->SGS_, true, true);
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->SGS_, LAnalyse, false);
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->SGS_, UAnalyse, false);
 
@@ -450,6 +718,8 @@ namespace rocalution
     {
         log_debug(this, "ILU::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("ILU::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -460,15 +730,80 @@ namespace rocalution
 
         assert(this->op_ != NULL);
 
-        this->ILU_.CloneFrom(*this->op_);
+        // ILU(0) keeps the pattern of the operator
+        if(this->p_ == 0)
+        {
+            this->ILU_.ShareStructureFrom(*this->op_);
+        }
+        else
+        {
+            this->ILU_.CloneFrom(*this->op_);
+        }
 
         this->ILU_.ILUpFactorize(this->p_, this->level_);
 
-        DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->ILU_, LUAnalyse);
+        if(this->solver_descr_.GetTriSolverAlg() == TriSolverAlg_BlockInverse)
+        {
+            int block_size = this->solver_descr_.GetTriSolverBlockSize();
+
+            this->L_inv_.CloneBackend(this->ILU_);
+            this->L_off_.CloneBackend(this->ILU_);
+            this->U_inv_.CloneBackend(this->ILU_);
+            this->U_off_.CloneBackend(this->ILU_);
+            this->v_.CloneBackend(*this->op_);
+            this->r_.CloneBackend(*this->op_);
+
+            this->ILU_.TriangularBlockInverse(
+                true, true, block_size, &this->L_inv_, &this->L_off_);
+            this->ILU_.TriangularBlockInverse(
+                false, false, block_size, &this->U_inv_, &this->U_off_);
+
+            this->v_.Allocate("v", this->op_->GetM());
+            this->r_.Allocate("r", this->op_->GetM());
+        }
+        else
+        {
+            select_tri_solver_alg(&this->solver_descr_, this->ILU_, true, true);
+            DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->ILU_, LUAnalyse);
+        }
 
         log_debug(this, "ILU::Build()", this->build_, " #*# end");
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void ILU<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "ILU::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == false)
+        {
+            this->Build();
+            return;
+        }
+
+        ROCALUTION_RANGE("ILU::ReBuildNumeric()");
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->ILU_.GetM());
+
+        // ILU(p) is ILU(0) on the pattern of its fill-in, the pattern and the analysis
+        // of the triangular solves are kept and only the values are refactorized
+        this->ILU_.Zeros();
+        this->ILU_.MatrixAdd(
+            *this->op_, static_cast<ValueType>(0), static_cast<ValueType>(1), false);
+        this->ILU_.ILU0Factorize();
+
+        if(this->solver_descr_.GetTriSolverAlg() == TriSolverAlg_BlockInverse)
+        {
+            int block_size = this->solver_descr_.GetTriSolverBlockSize();
+
+            this->ILU_.TriangularBlockInverse(
+                true, true, block_size, &this->L_inv_, &this->L_off_);
+            this->ILU_.TriangularBlockInverse(
+                false, false, block_size, &this->U_inv_, &this->U_off_);
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void ILU<OperatorType, VectorType, ValueType>::Clear(void)
     {
@@ -476,6 +811,14 @@ namespace rocalution
 
         this->ILU_.Clear();
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->ILU_, LUAnalyseClear);
+
+        this->L_inv_.Clear();
+        this->L_off_.Clear();
+        this->U_inv_.Clear();
+        this->U_off_.Clear();
+        this->v_.Clear();
+        this->r_.Clear();
+
         this->build_ = false;
     }
 
@@ -485,7 +828,20 @@ namespace rocalution
         log_debug(this, "ILU::MoveToHostLocalData_()", this->build_);
 
         this->ILU_.MoveToHost();
-        DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->ILU_, LUAnalyse);
+
+        if(this->solver_descr_.GetTriSolverAlg() == TriSolverAlg_BlockInverse)
+        {
+            this->L_inv_.MoveToHost();
+            this->L_off_.MoveToHost();
+            this->U_inv_.MoveToHost();
+            this->U_off_.MoveToHost();
+            this->v_.MoveToHost();
+            this->r_.MoveToHost();
+        }
+        else
+        {
+            DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->ILU_, LUAnalyse);
+        }
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -494,7 +850,20 @@ namespace rocalution
         log_debug(this, "ILU::MoveToAcceleratorLocalData_()", this->build_);
 
         this->ILU_.MoveToAccelerator();
-        DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->ILU_, LUAnalyse);
+
+        if(this->solver_descr_.GetTriSolverAlg() == TriSolverAlg_BlockInverse)
+        {
+            this->L_inv_.MoveToAccelerator();
+            this->L_off_.MoveToAccelerator();
+            this->U_inv_.MoveToAccelerator();
+            this->U_off_.MoveToAccelerator();
+            this->v_.MoveToAccelerator();
+            this->r_.MoveToAccelerator();
+        }
+        else
+        {
+            DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->ILU_, LUAnalyse);
+        }
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -506,7 +875,17 @@ namespace rocalution
         assert(x != NULL);
         assert(x != &rhs);
 
-        DISPATCH_OPERATOR_SOLVE_STRATEGY(this->solver_descr_, this->ILU_, LUSolve, rhs, x);
+        if(this->solver_descr_.GetTriSolverAlg() == TriSolverAlg_BlockInverse)
+        {
+            block_tri_solve<OperatorType, VectorType, ValueType>(
+                this->solver_descr_, this->L_inv_, this->L_off_, rhs, &this->r_, &this->v_);
+            block_tri_solve<OperatorType, VectorType, ValueType>(
+                this->solver_descr_, this->U_inv_, this->U_off_, this->v_, &this->r_, x);
+        }
+        else
+        {
+            DISPATCH_OPERATOR_SOLVE_STRATEGY(this->solver_descr_, this->ILU_, LUSolve, rhs, x);
+        }
 
         log_debug(this, "ILU::Solve()", " #*# end");
     }
@@ -652,6 +1031,8 @@ namespace rocalution
     {
         log_debug(this, "ItILU0::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("ItILU0::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -662,7 +1043,7 @@ namespace rocalution
 
         assert(this->op_ != NULL);
 
-        this->ItILU0_.CloneFrom(*this->op_);
+        this->ItILU0_.ShareStructureFrom(*this->op_);
 
         if((this->option_ & ItILU0Option::ConvergenceHistory) > 0)
         {
@@ -671,11 +1052,36 @@ namespace rocalution
 
         this->ItILU0_.ItILU0Factorize(
             this->alg_, this->option_, this->maxiter_, this->tol_, &this->niter_, this->history_);
+        select_tri_solver_alg(&this->solver_descr_, this->ItILU0_, true, true);
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->ItILU0_, LUAnalyse);
 
         log_debug(this, "ItILU0::Build()", this->build_, " #*# end");
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void ItILU0<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "ItILU0::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == false)
+        {
+            this->Build();
+            return;
+        }
+
+        ROCALUTION_RANGE("ItILU0::ReBuildNumeric()");
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetNnz() == this->ItILU0_.GetNnz());
+
+        // Same pattern, keep the analysis of the triangular solves
+        this->ItILU0_.Zeros();
+        this->ItILU0_.MatrixAdd(
+            *this->op_, static_cast<ValueType>(0), static_cast<ValueType>(1), false);
+        this->ItILU0_.ItILU0Factorize(
+            this->alg_, this->option_, this->maxiter_, this->tol_, &this->niter_, this->history_);
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void ItILU0<OperatorType, VectorType, ValueType>::Clear(void)
     {
@@ -775,6 +1181,8 @@ namespace rocalution
     {
         log_debug(this, "ILUT::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("ILUT::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -787,6 +1195,7 @@ namespace rocalution
 
         this->ILUT_.CloneFrom(*this->op_);
         this->ILUT_.ILUTFactorize(this->t_, this->max_row_);
+        select_tri_solver_alg(&this->solver_descr_, this->ILUT_, true, true);
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->ILUT_, LUAnalyse);
 
         log_debug(this, "ILUT::Build()", this->build_, " #*# end");
@@ -863,6 +1272,8 @@ namespace rocalution
     {
         log_debug(this, "IC::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("IC::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -876,13 +1287,98 @@ namespace rocalution
         this->IC_.CloneBackend(*this->op_);
         this->inv_diag_entries_.CloneBackend(*this->op_);
 
-        this->op_->ExtractL(&this->IC_, true);
+        if(this->op_->GetSymmetricStorage() == true)
+        {
+            // Only the upper triangle is stored, its transpose is the lower triangle
+            this->op_->Transpose(&this->IC_);
+        }
+        else
+        {
+            this->op_->ExtractL(&this->IC_, true);
+        }
+
         this->IC_.ICFactorize(&this->inv_diag_entries_);
-        DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->IC_, LLAnalyse);
+
+        if(this->solver_descr_.GetTriSolverAlg() == TriSolverAlg_BlockInverse)
+        {
+            this->L_inv_.CloneBackend(this->IC_);
+            this->L_off_.CloneBackend(this->IC_);
+            this->Lt_inv_.CloneBackend(this->IC_);
+            this->Lt_off_.CloneBackend(this->IC_);
+            this->v_.CloneBackend(*this->op_);
+            this->r_.CloneBackend(*this->op_);
+
+            this->IC_.TriangularBlockInverse(true,
+                                             false,
+                                             this->solver_descr_.GetTriSolverBlockSize(),
+                                             &this->L_inv_,
+                                             &this->L_off_);
+
+            // The blocks of L^T are the transposed blocks of L
+            this->L_inv_.Transpose(&this->Lt_inv_);
+            this->L_off_.Transpose(&this->Lt_off_);
+
+            this->v_.Allocate("v", this->op_->GetM());
+            this->r_.Allocate("r", this->op_->GetM());
+        }
+        else
+        {
+            select_tri_solver_alg(&this->solver_descr_, this->IC_, true, false);
+            DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->IC_, LLAnalyse);
+        }
 
         log_debug(this, "IC::Build()", this->build_, " #*# end");
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IC<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "IC::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == false)
+        {
+            this->Build();
+            return;
+        }
+
+        ROCALUTION_RANGE("IC::ReBuildNumeric()");
+
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->IC_.GetM());
+
+        // Scatter the lower part of the operator into the factor, the pattern and the
+        // analysis of the triangular solves are kept
+        this->IC_.Zeros();
+
+        if(this->op_->GetSymmetricStorage() == true)
+        {
+            OperatorType lower;
+            lower.CloneBackend(*this->op_);
+
+            this->op_->Transpose(&lower);
+            this->IC_.MatrixAdd(lower, static_cast<ValueType>(0), static_cast<ValueType>(1), false);
+        }
+        else
+        {
+            this->IC_.MatrixAdd(
+                *this->op_, static_cast<ValueType>(0), static_cast<ValueType>(1), false);
+        }
+
+        this->IC_.ICFactorize(&this->inv_diag_entries_);
+
+        if(this->solver_descr_.GetTriSolverAlg() == TriSolverAlg_BlockInverse)
+        {
+            this->IC_.TriangularBlockInverse(true,
+                                             false,
+                                             this->solver_descr_.GetTriSolverBlockSize(),
+                                             &this->L_inv_,
+                                             &this->L_off_);
+
+            this->L_inv_.Transpose(&this->Lt_inv_);
+            this->L_off_.Transpose(&this->Lt_off_);
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void IC<OperatorType, VectorType, ValueType>::Clear(void)
     {
@@ -891,6 +1387,14 @@ namespace rocalution
         this->inv_diag_entries_.Clear();
         this->IC_.Clear();
         DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->IC_, LLAnalyseClear);
+
+        this->L_inv_.Clear();
+        this->L_off_.Clear();
+        this->Lt_inv_.Clear();
+        this->Lt_off_.Clear();
+        this->v_.Clear();
+        this->r_.Clear();
+
         this->build_ = false;
     }
 
@@ -901,6 +1405,13 @@ namespace rocalution
 
         // this->inv_diag_entries_ is NOT needed on accelerator!
         this->IC_.MoveToHost();
+
+        this->L_inv_.MoveToHost();
+        this->L_off_.MoveToHost();
+        this->Lt_inv_.MoveToHost();
+        this->Lt_off_.MoveToHost();
+        this->v_.MoveToHost();
+        this->r_.MoveToHost();
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -910,6 +1421,13 @@ namespace rocalution
 
         // this->inv_diag_entries_ is NOT needed on accelerator!
         this->IC_.MoveToAccelerator();
+
+        this->L_inv_.MoveToAccelerator();
+        this->L_off_.MoveToAccelerator();
+        this->Lt_inv_.MoveToAccelerator();
+        this->Lt_off_.MoveToAccelerator();
+        this->v_.MoveToAccelerator();
+        this->r_.MoveToAccelerator();
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -921,8 +1439,18 @@ namespace rocalution
         assert(x != NULL);
         assert(x != &rhs);
 
-        DISPATCH_OPERATOR_SOLVE_STRATEGY(
-            this->solver_descr_, this->IC_, LLSolve, rhs, this->inv_diag_entries_, x);
+        if(this->solver_descr_.GetTriSolverAlg() == TriSolverAlg_BlockInverse)
+        {
+            block_tri_solve<OperatorType, VectorType, ValueType>(
+                this->solver_descr_, this->L_inv_, this->L_off_, rhs, &this->r_, &this->v_);
+            block_tri_solve<OperatorType, VectorType, ValueType>(
+                this->solver_descr_, this->Lt_inv_, this->Lt_off_, this->v_, &this->r_, x);
+        }
+        else
+        {
+            DISPATCH_OPERATOR_SOLVE_STRATEGY(
+                this->solver_descr_, this->IC_, LLSolve, rhs, this->inv_diag_entries_, x);
+        }
 
         log_debug(this, "IC::Solve()", " #*# end");
     }
@@ -984,6 +1512,8 @@ namespace rocalution
     {
         log_debug(this, "VariablePreconditioner::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("VariablePreconditioner::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -1085,6 +1615,126 @@ namespace rocalution
         }
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    SharedPreconditioner<OperatorType, VectorType, ValueType>::SharedPreconditioner()
+    {
+        log_debug(this, "SharedPreconditioner::SharedPreconditioner()", "default constructor");
+
+        this->shared_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SharedPreconditioner<OperatorType, VectorType, ValueType>::~SharedPreconditioner()
+    {
+        log_debug(this, "SharedPreconditioner::~SharedPreconditioner()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SharedPreconditioner<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->shared_ != NULL)
+        {
+            LOG_INFO("SharedPreconditioner of:");
+            this->shared_->Print();
+        }
+        else
+        {
+            LOG_INFO("SharedPreconditioner preconditioner");
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SharedPreconditioner<OperatorType, VectorType, ValueType>::Set(
+        Solver<OperatorType, VectorType, ValueType>& precond)
+    {
+        log_debug(this, "SharedPreconditioner::Set()", (const void*&)precond);
+
+        assert(this->build_ == false);
+        assert(this != &precond);
+
+        this->shared_ = &precond;
+        this->lock_   = shared_precond_lock(&precond);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SharedPreconditioner<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "SharedPreconditioner::Build()", this->build_, " #*# begin");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        assert(this->op_ != NULL);
+        assert(this->shared_ != NULL);
+
+        // The shared preconditioner is built by its owner
+        this->build_ = true;
+
+        log_debug(this, "SharedPreconditioner::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SharedPreconditioner<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "SharedPreconditioner::Clear()", this->build_);
+
+        // The shared preconditioner is kept, such that the object can be built again
+        this->build_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SharedPreconditioner<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
+                                                                          VectorType*       x)
+    {
+        log_debug(this, "SharedPreconditioner::Solve()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+
+        std::lock_guard<std::mutex> guard(*this->lock_);
+
+        this->shared_->Solve(rhs, x);
+
+        log_debug(this, "SharedPreconditioner::Solve()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SharedPreconditioner<OperatorType, VectorType, ValueType>::SolveZeroSol(
+        const VectorType& rhs, VectorType* x)
+    {
+        log_debug(
+            this, "SharedPreconditioner::SolveZeroSol()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+
+        std::lock_guard<std::mutex> guard(*this->lock_);
+
+        this->shared_->SolveZeroSol(rhs, x);
+
+        log_debug(this, "SharedPreconditioner::SolveZeroSol()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SharedPreconditioner<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        // The shared preconditioner is moved by its owner
+        log_debug(this, "SharedPreconditioner::MoveToHostLocalData_()", this->build_);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SharedPreconditioner<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(
+        void)
+    {
+        // The shared preconditioner is moved by its owner
+        log_debug(this, "SharedPreconditioner::MoveToAcceleratorLocalData_()", this->build_);
+    }
+
     template class Preconditioner<LocalMatrix<double>, LocalVector<double>, double>;
     template class Preconditioner<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -1107,6 +1757,17 @@ namespace rocalution
                                   std::complex<float>>;
 #endif
 
+    template class Preconditioner<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class Preconditioner<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Preconditioner<LocalShellOperator<std::complex<double>>,
+                                  LocalVector<std::complex<double>>,
+                                  std::complex<double>>;
+    template class Preconditioner<LocalShellOperator<std::complex<float>>,
+                                  LocalVector<std::complex<float>>,
+                                  std::complex<float>>;
+#endif
+
     template class Jacobi<LocalMatrix<double>, LocalVector<double>, double>;
     template class Jacobi<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -1129,6 +1790,28 @@ namespace rocalution
                           std::complex<float>>;
 #endif
 
+    template class Jacobi<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class Jacobi<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Jacobi<LocalShellOperator<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class Jacobi<LocalShellOperator<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+    template class PointBlockJacobi<LocalMatrix<double>, LocalVector<double>, double>;
+    template class PointBlockJacobi<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class PointBlockJacobi<LocalMatrix<std::complex<double>>,
+                                    LocalVector<std::complex<double>>,
+                                    std::complex<double>>;
+    template class PointBlockJacobi<LocalMatrix<std::complex<float>>,
+                                    LocalVector<std::complex<float>>,
+                                    std::complex<float>>;
+#endif
+
     template class GS<LocalMatrix<double>, LocalVector<double>, double>;
     template class GS<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -1206,4 +1889,26 @@ namespace rocalution
                                           std::complex<float>>;
 #endif
 
+    template class SharedPreconditioner<LocalMatrix<double>, LocalVector<double>, double>;
+    template class SharedPreconditioner<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SharedPreconditioner<LocalMatrix<std::complex<double>>,
+                                        LocalVector<std::complex<double>>,
+                                        std::complex<double>>;
+    template class SharedPreconditioner<LocalMatrix<std::complex<float>>,
+                                        LocalVector<std::complex<float>>,
+                                        std::complex<float>>;
+#endif
+
+    template class SharedPreconditioner<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class SharedPreconditioner<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SharedPreconditioner<GlobalMatrix<std::complex<double>>,
+                                        GlobalVector<std::complex<double>>,
+                                        std::complex<double>>;
+    template class SharedPreconditioner<GlobalMatrix<std::complex<float>>,
+                                        GlobalVector<std::complex<float>>,
+                                        std::complex<float>>;
+#endif
+
 } // namespace rocalution
@@ -27,6 +27,9 @@
 #include "../solver.hpp"
 #include "rocalution/export.hpp"
 
+#include <memory>
+#include <mutex>
+
 namespace rocalution
 {
 
@@ -87,6 +90,13 @@ namespace rocalution
         virtual void Print(void) const;
         ROCALUTION_EXPORT
         virtual void Solve(const VectorType& rhs, VectorType* x);
+        /** \brief Scale all columns of a block by the inverse diagonal at once */
+        ROCALUTION_EXPORT
+        virtual void SolveMulti(const LocalMultiVector<ValueType>& rhs,
+                                LocalMultiVector<ValueType>*       x);
+        ROCALUTION_EXPORT
+        virtual void SolveMultiZeroSol(const LocalMultiVector<ValueType>& rhs,
+                                       LocalMultiVector<ValueType>*       x);
         ROCALUTION_EXPORT
         virtual void Build(void);
         ROCALUTION_EXPORT
@@ -95,6 +105,10 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual void ResetOperator(const OperatorType& op);
 
+        /** \brief Return true, the Jacobi method is a single point-wise multiplication */
+        ROCALUTION_EXPORT
+        virtual bool SupportsGraphCapture(void) const;
+
     protected:
         virtual void MoveToHostLocalData_(void);
         virtual void MoveToAcceleratorLocalData_(void);
@@ -103,6 +117,62 @@ namespace rocalution
         VectorType inv_diag_entries_;
     };
 
+    /** \ingroup precond_module
+  * \class PointBlockJacobi
+  * \brief Point-Block Jacobi Method
+  * \details
+  * The point-block Jacobi method is the block variant of the Jacobi method for systems
+  * with a fixed number of unknowns per grid point, such as multi-component PDEs. The
+  * dense diagonal blocks \f$D_{i}\f$ of size \f$b\f$ are inverted in a batched fashion
+  * during the building phase, see LocalMatrix::ExtractInverseBlockDiagonal(), and each
+  * application is a single block diagonal matrix-vector product
+  * \f[
+  *   x_{i} = D_{i}^{-1} b_{i}.
+  * \f]
+  * In contrast to the point-wise Jacobi method, the coupling between the unknowns of a
+  * grid point is fully resolved.
+  *
+  * \tparam OperatorType - can be LocalMatrix
+  * \tparam VectorType - can be LocalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class PointBlockJacobi : public Preconditioner<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        PointBlockJacobi();
+        ROCALUTION_EXPORT
+        virtual ~PointBlockJacobi();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+        ROCALUTION_EXPORT
+        virtual void Solve(const VectorType& rhs, VectorType* x);
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Set the dimension of the diagonal blocks
+        * \details
+        * By default, the block dimension of the operator is used, which is one unless
+        * the operator is stored in BCSR format.
+        */
+        ROCALUTION_EXPORT
+        void SetBlockDimension(int blockdim);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        int blockdim_;
+
+        OperatorType inv_diag_blocks_;
+        VectorType   tmp_;
+    };
+
     /** \ingroup precond_module
   * \class GS
   * \brief Gauss-Seidel / Successive Over-Relaxation Method
@@ -231,6 +301,8 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual void Build(void);
         ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
         virtual void Clear(void);
 
     protected:
@@ -241,6 +313,14 @@ namespace rocalution
         OperatorType ILU_;
         int          p_;
         bool         level_;
+
+        // Inverted diagonal blocks and block couplings of TriSolverAlg_BlockInverse
+        OperatorType L_inv_;
+        OperatorType L_off_;
+        OperatorType U_inv_;
+        OperatorType U_off_;
+        VectorType   v_;
+        VectorType   r_;
     };
 
     /*! \brief List of ItILU0 algorithms.
@@ -322,6 +402,8 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual void Build(void);
         ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
         virtual void Clear(void);
 
     protected:
@@ -416,6 +498,8 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual void Build(void);
         ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
         virtual void Clear(void);
 
     protected:
@@ -425,6 +509,14 @@ namespace rocalution
     private:
         OperatorType IC_;
         VectorType   inv_diag_entries_;
+
+        // Inverted diagonal blocks and block couplings of TriSolverAlg_BlockInverse
+        OperatorType L_inv_;
+        OperatorType L_off_;
+        OperatorType Lt_inv_;
+        OperatorType Lt_off_;
+        VectorType   v_;
+        VectorType   r_;
     };
 
     /** \ingroup precond_module
@@ -474,6 +566,85 @@ namespace rocalution
         Solver<OperatorType, VectorType, ValueType>** precond_;
     };
 
+    /** \ingroup precond_module
+  * \class SharedPreconditioner
+  * \brief Shared Preconditioner
+  * \details
+  * The Shared Preconditioner lets several solvers use a single built preconditioner,
+  * e.g. an AMG hierarchy or an ILU factorization of an operator that is common to
+  * multiple fields. Each solver gets its own SharedPreconditioner, which refers to the
+  * shared preconditioner. Build() and Clear() of the SharedPreconditioner, and thus of
+  * the solvers, do not build or clear the shared preconditioner. It is set up by its
+  * owner, also after changes of the operator (e.g. with ReBuildNumeric()), and has to
+  * outlive the SharedPreconditioner objects.
+  *
+  * The Krylov vectors of each solver are private to the solver, only the
+  * preconditioner is stored once. The temporary vectors of the shared preconditioner
+  * are used by all solvers. Therefore, all SharedPreconditioner objects of a
+  * preconditioner serialize its application, such that solves in concurrent contexts
+  * (e.g. Solver::SolveAsync()) can share the preconditioner safely.
+  *
+  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  *
+  * \par Example
+  * \code{.cpp}
+  *   SAAMG<LocalMatrix<double>, LocalVector<double>, double> amg;
+  *
+  *   amg.SetOperator(mat);
+  *   amg.Build();
+  *
+  *   SharedPreconditioner<LocalMatrix<double>, LocalVector<double>, double> p1, p2;
+  *   p1.Set(amg);
+  *   p2.Set(amg);
+  *
+  *   CG<LocalMatrix<double>, LocalVector<double>, double> ls1, ls2;
+  *   ls1.SetOperator(mat);
+  *   ls1.SetPreconditioner(p1);
+  *   ls1.Build();
+  *
+  *   ls2.SetOperator(mat);
+  *   ls2.SetPreconditioner(p2);
+  *   ls2.Build();
+  *
+  *   ls1.Solve(rhs1, &x1);
+  *   ls2.Solve(rhs2, &x2);
+  * \endcode
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class SharedPreconditioner : public Preconditioner<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        SharedPreconditioner();
+        ROCALUTION_EXPORT
+        virtual ~SharedPreconditioner();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+        ROCALUTION_EXPORT
+        virtual void Solve(const VectorType& rhs, VectorType* x);
+        ROCALUTION_EXPORT
+        virtual void SolveZeroSol(const VectorType& rhs, VectorType* x);
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+        /** \brief Set the shared preconditioner, it has to be built by its owner */
+        ROCALUTION_EXPORT
+        void Set(Solver<OperatorType, VectorType, ValueType>& precond);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        Solver<OperatorType, VectorType, ValueType>* shared_;
+        std::shared_ptr<std::mutex>                  lock_;
+    };
+
 } // namespace rocalution
 
 #endif // ROCALUTION_PRECONDITIONER_HPP_
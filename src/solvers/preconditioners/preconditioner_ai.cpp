@@ -25,14 +25,21 @@
 #include "../../utils/def.hpp"
 #include "../solver.hpp"
 
+#include "../../base/global_matrix.hpp"
 #include "../../base/local_matrix.hpp"
 
+#include "../../base/global_vector.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/math_functions.hpp"
+#include "../../utils/type_traits.hpp"
 
+#include <algorithm>
 #include <complex>
+#include <limits>
 #include <math.h>
+#include <type_traits>
 
 namespace rocalution
 {
@@ -45,6 +52,11 @@ namespace rocalution
         this->p_          = 0;
         this->lambda_min_ = static_cast<ValueType>(0);
         this->lambda_max_ = static_cast<ValueType>(0);
+
+        this->estimate_        = false;
+        this->estimate_steps_  = 10;
+        this->estimate_safety_ = 1.1;
+        this->estimate_ratio_  = 0.0;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -81,6 +93,34 @@ namespace rocalution
         this->p_          = p;
         this->lambda_min_ = lambda_min;
         this->lambda_max_ = lambda_max;
+        this->estimate_   = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AIChebyshev<OperatorType, VectorType, ValueType>::Set(int p)
+    {
+        log_debug(this, "AIChebyshev::Set()", p);
+
+        assert(p > 0);
+        assert(this->build_ == false);
+
+        this->p_        = p;
+        this->estimate_ = true;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AIChebyshev<OperatorType, VectorType, ValueType>::SetSpectrumEstimation(
+        int steps, double safety_factor, double ratio)
+    {
+        log_debug(this, "AIChebyshev::SetSpectrumEstimation()", steps, safety_factor, ratio);
+
+        assert(steps > 0);
+        assert(safety_factor >= 1.0);
+        assert(ratio >= 0.0 && ratio < 1.0);
+
+        this->estimate_steps_  = steps;
+        this->estimate_safety_ = safety_factor;
+        this->estimate_ratio_  = ratio;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -88,6 +128,8 @@ namespace rocalution
     {
         log_debug(this, "AIChebyshev::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("AIChebyshev::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -98,6 +140,26 @@ namespace rocalution
 
         assert(this->op_ != NULL);
 
+        if(this->estimate_ == true)
+        {
+            ValueType lambda_min;
+            ValueType lambda_max;
+
+            this->EstimateSpectrum_(this->estimate_steps_, &lambda_min, &lambda_max);
+
+            this->lambda_max_ = lambda_max * static_cast<ValueType>(this->estimate_safety_);
+
+            if(this->estimate_ratio_ > 0.0)
+            {
+                this->lambda_min_
+                    = this->lambda_max_ * static_cast<ValueType>(this->estimate_ratio_);
+            }
+            else
+            {
+                this->lambda_min_ = lambda_min / static_cast<ValueType>(this->estimate_safety_);
+            }
+        }
+
         this->AIChebyshev_.CloneFrom(*this->op_);
 
         ValueType q = (static_cast<ValueType>(1) - sqrt(this->lambda_min_ / this->lambda_max_))
@@ -203,6 +265,464 @@ namespace rocalution
         log_debug(this, "AIChebyshev::Solve()", " #*# end");
     }
 
+    // Conversion of a polynomial coefficient to the value type of the operator, real
+    // operators only have real coefficients
+    static void gmres_poly_coefficient(const std::complex<double>& z, float* val)
+    {
+        *val = static_cast<float>(z.real());
+    }
+
+    static void gmres_poly_coefficient(const std::complex<double>& z, double* val)
+    {
+        *val = z.real();
+    }
+
+    static void gmres_poly_coefficient(const std::complex<double>& z, std::complex<float>* val)
+    {
+        *val = static_cast<std::complex<float>>(z);
+    }
+
+    static void gmres_poly_coefficient(const std::complex<double>& z, std::complex<double>* val)
+    {
+        *val = z;
+    }
+
+    // Solve the dense (column-major) n x n system A x = b in place by Gaussian elimination
+    // with partial pivoting, returns false if A is singular
+    static bool gmres_poly_solve(int n, std::complex<double>* A, std::complex<double>* b)
+    {
+        for(int k = 0; k < n; ++k)
+        {
+            int piv = k;
+
+            for(int i = k + 1; i < n; ++i)
+            {
+                if(std::abs(A[i + k * n]) > std::abs(A[piv + k * n]))
+                {
+                    piv = i;
+                }
+            }
+
+            if(std::abs(A[piv + k * n]) == 0.0)
+            {
+                return false;
+            }
+
+            if(piv != k)
+            {
+                for(int j = k; j < n; ++j)
+                {
+                    std::swap(A[k + j * n], A[piv + j * n]);
+                }
+
+                std::swap(b[k], b[piv]);
+            }
+
+            for(int i = k + 1; i < n; ++i)
+            {
+                std::complex<double> l = A[i + k * n] / A[k + k * n];
+
+                for(int j = k + 1; j < n; ++j)
+                {
+                    A[i + j * n] -= l * A[k + j * n];
+                }
+
+                b[i] -= l * b[k];
+            }
+        }
+
+        for(int k = n - 1; k >= 0; --k)
+        {
+            for(int j = k + 1; j < n; ++j)
+            {
+                b[k] -= A[k + j * n] * b[j];
+            }
+
+            b[k] /= A[k + k * n];
+        }
+
+        return true;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    GMRESPolynomial<OperatorType, VectorType, ValueType>::GMRESPolynomial()
+    {
+        log_debug(this, "GMRESPolynomial::GMRESPolynomial()", "default constructor");
+
+        this->degree_ = 10;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    GMRESPolynomial<OperatorType, VectorType, ValueType>::~GMRESPolynomial()
+    {
+        log_debug(this, "GMRESPolynomial::~GMRESPolynomial()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRESPolynomial<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("GMRES Polynomial(" << this->degree_ << ") preconditioner");
+
+        if(this->build_ == true)
+        {
+            LOG_INFO("Polynomial degree = " << this->roots_.size());
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRESPolynomial<OperatorType, VectorType, ValueType>::Set(int degree)
+    {
+        log_debug(this, "GMRESPolynomial::Set()", degree);
+
+        assert(degree > 0);
+        assert(this->build_ == false);
+
+        this->degree_ = degree;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRESPolynomial<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "GMRESPolynomial::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("GMRESPolynomial::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        assert(this->op_ != NULL);
+        assert(this->op_->GetM() == this->op_->GetN());
+
+        typedef std::complex<double> complex;
+
+        bool is_real = std::is_same<ValueType, numeric_traits_t<ValueType>>::value;
+
+        int d  = this->degree_;
+        int ld = d + 1;
+
+        // Arnoldi factorization A V_m = V_m+1 H from a random start vector, classical
+        // Gram-Schmidt applied twice with batched reductions
+        std::vector<VectorType*> v(d + 1);
+
+        for(int i = 0; i < d + 1; ++i)
+        {
+            v[i] = new VectorType;
+            v[i]->CloneBackend(*this->op_);
+            v[i]->Allocate("v", this->op_->GetM());
+        }
+
+        v[0]->SetRandomUniform(12345ULL, static_cast<ValueType>(-1), static_cast<ValueType>(1));
+        v[0]->Scale(static_cast<ValueType>(1) / v[0]->Norm());
+
+        std::vector<ValueType> H(ld * d, static_cast<ValueType>(0));
+        std::vector<ValueType> h(d);
+
+        int m = d;
+
+        for(int j = 0; j < d; ++j)
+        {
+            this->op_->Apply(*v[j], v[j + 1]);
+
+            double nrm_w = std::abs(v[j + 1]->Norm());
+
+            for(int pass = 0; pass < 2; ++pass)
+            {
+                v[j + 1]->MultiDot(j + 1, v.data(), h.data());
+
+                for(int i = 0; i <= j; ++i)
+                {
+                    H[i + j * ld] += h[i];
+                    h[i] = -h[i];
+                }
+
+                v[j + 1]->MultiAddScale(j + 1, v.data(), h.data());
+            }
+
+            double nrm = std::abs(v[j + 1]->Norm());
+
+            H[(j + 1) + j * ld] = static_cast<ValueType>(nrm);
+
+            // Invariant subspace, the polynomial of degree j + 1 is exact
+            if(!(nrm > std::numeric_limits<double>::epsilon() * nrm_w))
+            {
+                H[(j + 1) + j * ld] = static_cast<ValueType>(0);
+
+                m = j + 1;
+                break;
+            }
+
+            v[j + 1]->Scale(static_cast<ValueType>(1) / static_cast<ValueType>(nrm));
+        }
+
+        for(int i = 0; i < d + 1; ++i)
+        {
+            v[i]->Clear();
+            delete v[i];
+        }
+
+        // Harmonic Ritz values, the eigenvalues of H_m + |h_m+1,m|^2 H_m^-H e_m e_m^T
+        std::vector<complex> Hm(m * m);
+        std::vector<complex> f(m, complex(0.0));
+
+        for(int j = 0; j < m; ++j)
+        {
+            for(int i = 0; i < m; ++i)
+            {
+                Hm[i + j * m] = std::conj(complex(H[j + i * ld]));
+            }
+        }
+
+        f[m - 1] = complex(1.0);
+
+        double hm = std::abs(complex(H[m + (m - 1) * ld]));
+
+        if(hm > 0.0 && gmres_poly_solve(m, Hm.data(), f.data()) == true)
+        {
+            for(int i = 0; i < m; ++i)
+            {
+                f[i] *= hm * hm;
+            }
+        }
+        else
+        {
+            std::fill(f.begin(), f.end(), complex(0.0));
+        }
+
+        for(int j = 0; j < m; ++j)
+        {
+            for(int i = 0; i < m; ++i)
+            {
+                Hm[i + j * m] = complex(H[i + j * ld]);
+            }
+        }
+
+        for(int i = 0; i < m; ++i)
+        {
+            Hm[i + (m - 1) * m] += f[i];
+        }
+
+        std::vector<complex> theta(m);
+        rocalution_hessenberg_eigenvalues(m, Hm.data(), theta.data());
+
+        // Drop vanishing roots, and split the roots of real operators into real roots and
+        // conjugate pairs, represented by the root with positive imaginary part
+        double theta_max = 0.0;
+
+        for(int i = 0; i < m; ++i)
+        {
+            theta_max = std::max(theta_max, std::abs(theta[i]));
+        }
+
+        double tol_zero = std::numeric_limits<double>::epsilon() * theta_max;
+        double tol_real = std::sqrt(std::numeric_limits<double>::epsilon());
+
+        std::vector<complex> cand;
+
+        for(int i = 0; i < m; ++i)
+        {
+            if(!(std::abs(theta[i]) > tol_zero))
+            {
+                continue;
+            }
+
+            if(is_real == true)
+            {
+                if(std::abs(theta[i].imag()) <= tol_real * std::abs(theta[i]))
+                {
+                    theta[i] = complex(theta[i].real());
+                }
+                else if(theta[i].imag() < 0.0)
+                {
+                    continue;
+                }
+            }
+
+            cand.push_back(theta[i]);
+        }
+
+        // Modified Leja order, start with the root of largest modulus and continue with the
+        // root that maximizes the product of distances to all previous roots
+        std::vector<bool>   used(cand.size(), false);
+        std::vector<double> logdist(cand.size(), 0.0);
+
+        for(size_t k = 0; k < cand.size(); ++k)
+        {
+            int next = -1;
+
+            for(size_t i = 0; i < cand.size(); ++i)
+            {
+                if(used[i] == true)
+                {
+                    continue;
+                }
+
+                if(next < 0)
+                {
+                    next = static_cast<int>(i);
+                }
+                else if(k == 0 ? std::abs(cand[i]) > std::abs(cand[next])
+                               : logdist[i] > logdist[next])
+                {
+                    next = static_cast<int>(i);
+                }
+            }
+
+            used[next] = true;
+
+            this->roots_.push_back(cand[next]);
+
+            if(cand[next].imag() != 0.0 && is_real == true)
+            {
+                this->roots_.push_back(std::conj(cand[next]));
+            }
+
+            for(size_t i = 0; i < cand.size(); ++i)
+            {
+                double dist = std::abs(cand[i] - cand[next]);
+
+                logdist[i] += (dist > 0.0) ? std::log(dist) : -std::numeric_limits<double>::max();
+
+                if(cand[next].imag() != 0.0 && is_real == true)
+                {
+                    dist = std::abs(cand[i] - std::conj(cand[next]));
+
+                    logdist[i]
+                        += (dist > 0.0) ? std::log(dist) : -std::numeric_limits<double>::max();
+                }
+            }
+        }
+
+        this->prod_.CloneBackend(*this->op_);
+        this->prod_.Allocate("prod", this->op_->GetM());
+
+        this->w_.CloneBackend(*this->op_);
+        this->w_.Allocate("w", this->op_->GetM());
+
+        this->t_.CloneBackend(*this->op_);
+        this->t_.Allocate("t", this->op_->GetM());
+
+        this->build_ = true;
+
+        log_debug(this, "GMRESPolynomial::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRESPolynomial<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "GMRESPolynomial::Clear()", this->build_);
+
+        this->roots_.clear();
+
+        this->prod_.Clear();
+        this->w_.Clear();
+        this->t_.Clear();
+
+        this->build_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRESPolynomial<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "GMRESPolynomial::MoveToHostLocalData_()", this->build_);
+
+        this->prod_.MoveToHost();
+        this->w_.MoveToHost();
+        this->t_.MoveToHost();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRESPolynomial<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "GMRESPolynomial::MoveToAcceleratorLocalData_()", this->build_);
+
+        this->prod_.MoveToAccelerator();
+        this->w_.MoveToAccelerator();
+        this->t_.MoveToAccelerator();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GMRESPolynomial<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
+                                                                     VectorType*       x)
+    {
+        log_debug(this, "GMRESPolynomial::Solve()", " #*# begin");
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+        assert(x != &rhs);
+
+        bool is_real = std::is_same<ValueType, numeric_traits_t<ValueType>>::value;
+
+        ValueType one = static_cast<ValueType>(1);
+
+        int d = static_cast<int>(this->roots_.size());
+
+        if(d == 0)
+        {
+            x->CopyFrom(rhs);
+
+            return;
+        }
+
+        // x = p(A) rhs, with p(A) = sum_i 1 / theta_i prod_j<i (I - A / theta_j)
+        this->prod_.CopyFrom(rhs);
+        x->Zeros();
+
+        int i = 0;
+
+        while(i < d)
+        {
+            const std::complex<double>& theta = this->roots_[i];
+
+            if(is_real == true && theta.imag() != 0.0)
+            {
+                // Conjugate pair, (I - A / theta)(I - A / conj(theta)) = I - alpha A + beta A^2
+                ValueType alpha;
+                ValueType beta;
+
+                gmres_poly_coefficient(2.0 * theta.real() / std::norm(theta), &alpha);
+                gmres_poly_coefficient(1.0 / std::norm(theta), &beta);
+
+                this->op_->Apply(this->prod_, &this->w_);
+
+                // x = x + alpha prod - beta A prod
+                x->ScaleAdd2(one, this->prod_, alpha, this->w_, -beta);
+
+                if(i + 2 < d)
+                {
+                    // prod = prod - alpha A prod + beta A^2 prod
+                    this->op_->Apply(this->w_, &this->t_);
+                    this->prod_.ScaleAdd2(one, this->w_, -alpha, this->t_, beta);
+                }
+
+                i += 2;
+            }
+            else
+            {
+                ValueType c;
+                gmres_poly_coefficient(1.0 / theta, &c);
+
+                // x = x + prod / theta
+                x->AddScale(this->prod_, c);
+
+                if(i + 1 < d)
+                {
+                    // prod = prod - A prod / theta
+                    this->op_->Apply(this->prod_, &this->w_);
+                    this->prod_.AddScale(this->w_, -c);
+                }
+
+                i += 1;
+            }
+        }
+
+        log_debug(this, "GMRESPolynomial::Solve()", " #*# end");
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     FSAI<OperatorType, VectorType, ValueType>::FSAI()
     {
@@ -211,9 +731,11 @@ namespace rocalution
         this->op_mat_format_      = false;
         this->precond_mat_format_ = CSR;
         this->format_block_dim_   = 0;
+        this->precond_storage_    = SpMVStorage_Full;
 
-        this->matrix_power_     = 1;
-        this->external_pattern_ = false;
+        this->matrix_power_      = 1;
+        this->pattern_threshold_ = 0.0;
+        this->external_pattern_  = false;
         this->matrix_pattern_   = NULL;
     }
 
@@ -235,6 +757,11 @@ namespace rocalution
         {
             LOG_INFO("FSAI matrix nnz = " << this->FSAI_L_.GetNnz() + this->FSAI_LT_.GetNnz()
                                                  - this->FSAI_L_.GetM());
+
+            if(this->pattern_threshold_ > 0.0)
+            {
+                LOG_INFO("FSAI pattern threshold = " << this->pattern_threshold_);
+            }
         }
     }
 
@@ -259,11 +786,24 @@ namespace rocalution
         this->matrix_pattern_ = &pattern;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FSAI<OperatorType, VectorType, ValueType>::SetPatternThreshold(double threshold)
+    {
+        log_debug(this, "FSAI::SetPatternThreshold()", threshold);
+
+        assert(this->build_ == false);
+        assert(threshold >= 0.0);
+
+        this->pattern_threshold_ = threshold;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void FSAI<OperatorType, VectorType, ValueType>::Build(void)
     {
         log_debug(this, "FSAI::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("FSAI::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -275,7 +815,45 @@ namespace rocalution
         assert(this->op_ != NULL);
 
         this->FSAI_L_.CloneFrom(*this->op_);
-        this->FSAI_L_.FSAI(this->matrix_power_, this->matrix_pattern_);
+
+        if((this->matrix_pattern_ == NULL) && (this->matrix_power_ > 1)
+           && (this->pattern_threshold_ > 0.0))
+        {
+            OperatorType scaled;
+            OperatorType pattern;
+            OperatorType tmp;
+            VectorType   diag;
+
+            scaled.CloneFrom(*this->op_);
+            tmp.CloneBackend(*this->op_);
+            diag.CloneBackend(*this->op_);
+
+            // Unit diagonal, such that the threshold is relative to the diagonal
+            scaled.ExtractInverseDiagonal(&diag);
+            diag.Power(0.5);
+            scaled.DiagonalMatrixMultL(diag);
+            scaled.DiagonalMatrixMultR(diag);
+
+            pattern.CloneFrom(scaled);
+
+            // Filter after each product, the fill of the power is never formed
+            for(int i = 1; i < this->matrix_power_; ++i)
+            {
+                tmp.MatrixMult(pattern, scaled);
+                tmp.Compress(this->pattern_threshold_);
+                pattern.CloneFrom(tmp);
+            }
+
+            // Keep at least the pattern of FSAI(1)
+            pattern.MatrixAdd(
+                scaled, static_cast<ValueType>(1), static_cast<ValueType>(1), true);
+
+            this->FSAI_L_.FSAI(this->matrix_power_, &pattern);
+        }
+        else
+        {
+            this->FSAI_L_.FSAI(this->matrix_power_, this->matrix_pattern_);
+        }
 
         this->FSAI_LT_.CloneBackend(*this->op_);
         this->FSAI_L_.Transpose(&this->FSAI_LT_);
@@ -288,6 +866,9 @@ namespace rocalution
             this->FSAI_L_.ConvertTo(this->precond_mat_format_, this->format_block_dim_);
             this->FSAI_LT_.ConvertTo(this->precond_mat_format_, this->format_block_dim_);
         }
+
+        this->FSAI_L_.SetSpMVStorage(this->precond_storage_);
+        this->FSAI_LT_.SetSpMVStorage(this->precond_storage_);
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -323,6 +904,20 @@ namespace rocalution
         this->format_block_dim_   = blockdim;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FSAI<OperatorType, VectorType, ValueType>::SetPrecondSpMVStorage(SpMVStorage storage)
+    {
+        log_debug(this, "FSAI::SetPrecondSpMVStorage()", storage);
+
+        this->precond_storage_ = storage;
+
+        if(this->build_ == true)
+        {
+            this->FSAI_L_.SetSpMVStorage(storage);
+            this->FSAI_LT_.SetSpMVStorage(storage);
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void FSAI<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
     {
@@ -368,6 +963,7 @@ namespace rocalution
         this->op_mat_format_      = false;
         this->precond_mat_format_ = CSR;
         this->format_block_dim_   = 0;
+        this->precond_storage_    = SpMVStorage_Full;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -394,6 +990,8 @@ namespace rocalution
     {
         log_debug(this, "SPAI::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("SPAI::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -412,6 +1010,8 @@ namespace rocalution
             this->SPAI_.ConvertTo(this->precond_mat_format_, this->format_block_dim_);
         }
 
+        this->SPAI_.SetSpMVStorage(this->precond_storage_);
+
         log_debug(this, "SPAI::Build()", this->build_, " #*# end");
     }
 
@@ -443,6 +1043,19 @@ namespace rocalution
         this->format_block_dim_   = blockdim;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SPAI<OperatorType, VectorType, ValueType>::SetPrecondSpMVStorage(SpMVStorage storage)
+    {
+        log_debug(this, "SPAI::SetPrecondSpMVStorage()", storage);
+
+        this->precond_storage_ = storage;
+
+        if(this->build_ == true)
+        {
+            this->SPAI_.SetSpMVStorage(storage);
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void SPAI<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
     {
@@ -524,6 +1137,8 @@ namespace rocalution
     {
         log_debug(this, "TNS::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("TNS::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -723,6 +1338,28 @@ namespace rocalution
                                std::complex<float>>;
 #endif
 
+    template class GMRESPolynomial<LocalMatrix<double>, LocalVector<double>, double>;
+    template class GMRESPolynomial<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class GMRESPolynomial<LocalMatrix<std::complex<double>>,
+                                   LocalVector<std::complex<double>>,
+                                   std::complex<double>>;
+    template class GMRESPolynomial<LocalMatrix<std::complex<float>>,
+                                   LocalVector<std::complex<float>>,
+                                   std::complex<float>>;
+#endif
+
+    template class GMRESPolynomial<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class GMRESPolynomial<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class GMRESPolynomial<GlobalMatrix<std::complex<double>>,
+                                   GlobalVector<std::complex<double>>,
+                                   std::complex<double>>;
+    template class GMRESPolynomial<GlobalMatrix<std::complex<float>>,
+                                   GlobalVector<std::complex<float>>,
+                                   std::complex<float>>;
+#endif
+
     template class FSAI<LocalMatrix<double>, LocalVector<double>, double>;
     template class FSAI<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -24,10 +24,14 @@
 #ifndef ROCALUTION_PRECONDITIONER_AI_HPP_
 #define ROCALUTION_PRECONDITIONER_AI_HPP_
 
+#include "../../base/matrix_formats.hpp"
 #include "../solver.hpp"
 #include "preconditioner.hpp"
 #include "rocalution/export.hpp"
 
+#include <complex>
+#include <vector>
+
 namespace rocalution
 {
 
@@ -61,6 +65,22 @@ namespace rocalution
         /** \brief Set order, min and max eigenvalues */
         ROCALUTION_EXPORT
         void Set(int p, ValueType lambda_min, ValueType lambda_max);
+        /** \brief Set order, the eigenvalues are estimated in Build()
+        * \details
+        * See SetSpectrumEstimation() for the estimation parameters.
+        */
+        ROCALUTION_EXPORT
+        void Set(int p);
+        /** \brief Set the parameters of the eigenvalue estimation in Build()
+        * \details
+        * The extreme eigenvalues are estimated by \p steps Lanczos (CG) iterations on the
+        * operator. The largest estimate is multiplied by \p safety_factor. If \p ratio is
+        * positive, the minimum eigenvalue is set to \p ratio times the maximum eigenvalue,
+        * otherwise the smallest estimate is divided by \p safety_factor. The operator has
+        * to be symmetric positive definite.
+        */
+        ROCALUTION_EXPORT
+        void SetSpectrumEstimation(int steps = 10, double safety_factor = 1.1, double ratio = 0.0);
         ROCALUTION_EXPORT
         virtual void Build(void);
         ROCALUTION_EXPORT
@@ -74,6 +94,68 @@ namespace rocalution
         OperatorType AIChebyshev_;
         int          p_;
         ValueType    lambda_min_, lambda_max_;
+
+        // Spectrum estimation, enabled by Set(p)
+        bool   estimate_;
+        int    estimate_steps_;
+        double estimate_safety_;
+        double estimate_ratio_;
+    };
+
+    /** \ingroup precond_module
+  * \class GMRESPolynomial
+  * \brief GMRES Polynomial Preconditioner
+  * \details
+  * The GMRES Polynomial Preconditioner applies \f$p(A)\f$, where \f$1 - \alpha p(\alpha)\f$
+  * is the residual polynomial of a short GMRES run on the operator. In Build(), an Arnoldi
+  * factorization of the requested degree is computed from a random start vector. The
+  * roots of the polynomial are the harmonic Ritz values of the factorization, which are
+  * stored in (modified) Leja order to keep the application stable. The polynomial is
+  * applied in product form by matrix-vector products and fused vector updates only, i.e.
+  * the application does not require any inner products. Complex conjugate pairs of roots
+  * are combined for real valued operators. In contrast to AIChebyshev, no estimate of
+  * the spectrum is required and the operator does not need to be symmetric.
+  * \cite gmrespoly
+  *
+  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class GMRESPolynomial : public Preconditioner<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        GMRESPolynomial();
+        ROCALUTION_EXPORT
+        virtual ~GMRESPolynomial();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+        ROCALUTION_EXPORT
+        virtual void Solve(const VectorType& rhs, VectorType* x);
+
+        /** \brief Set the polynomial degree, i.e. the number of Arnoldi steps in Build() */
+        ROCALUTION_EXPORT
+        void Set(int degree);
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        int degree_;
+
+        // Roots of the residual polynomial in Leja order, conjugate pairs are adjacent
+        std::vector<std::complex<double>> roots_;
+
+        VectorType prod_;
+        VectorType w_;
+        VectorType t_;
     };
 
     /** \ingroup precond_module
@@ -115,6 +197,16 @@ namespace rocalution
         /** \brief Set an external sparsity pattern */
         ROCALUTION_EXPORT
         void Set(const OperatorType& pattern);
+        /** \brief Filter the pattern of the matrix power by a threshold
+      * \details
+      * The pattern of FSAI(q) is built from the power \f$S^{q}\f$ of the diagonally
+      * scaled system matrix \f$S = D^{-1/2} A D^{-1/2}\f$, dropping entries with
+      * magnitude below \p threshold after each product. The pattern of \f$A\f$ is always
+      * kept. This retains the strong couplings of FSAI(q) at a cost close to FSAI(1).
+      * Default is 0, the full symbolic power.
+      */
+        ROCALUTION_EXPORT
+        void SetPatternThreshold(double threshold);
 
         ROCALUTION_EXPORT
         virtual void Build(void);
@@ -124,6 +216,13 @@ namespace rocalution
         /** \brief Set the matrix format of the preconditioner */
         ROCALUTION_EXPORT
         void SetPrecondMatrixFormat(unsigned int mat_format, int blockdim = 1);
+        /** \brief Set the value storage of the factor products
+        * \details
+        * Both triangular factors are applied with their values rounded to \p storage,
+        * see LocalMatrix::SetSpMVStorage(). Default is SpMVStorage_Full.
+        */
+        ROCALUTION_EXPORT
+        void SetPrecondSpMVStorage(SpMVStorage storage);
 
     protected:
         virtual void MoveToHostLocalData_(void);
@@ -134,7 +233,8 @@ namespace rocalution
         OperatorType FSAI_LT_;
         VectorType   t_;
 
-        int matrix_power_;
+        int    matrix_power_;
+        double pattern_threshold_;
 
         bool                external_pattern_;
         const OperatorType* matrix_pattern_;
@@ -145,6 +245,8 @@ namespace rocalution
         unsigned int precond_mat_format_;
         // Matrix format block dimension
         int format_block_dim_;
+        // Value storage of the preconditioner products
+        SpMVStorage precond_storage_;
     };
 
     /** \ingroup precond_module
@@ -182,6 +284,10 @@ namespace rocalution
         /** \brief Set the matrix format of the preconditioner */
         ROCALUTION_EXPORT
         void SetPrecondMatrixFormat(unsigned int mat_format, int blockdim = 1);
+        /** \brief Set the value storage of the approximate inverse product, see
+        * LocalMatrix::SetSpMVStorage() */
+        ROCALUTION_EXPORT
+        void SetPrecondSpMVStorage(SpMVStorage storage);
 
     protected:
         virtual void MoveToHostLocalData_(void);
@@ -196,6 +302,8 @@ namespace rocalution
         unsigned int precond_mat_format_;
         // Matrix format block dimension
         int format_block_dim_;
+        // Value storage of the preconditioner products
+        SpMVStorage precond_storage_;
     };
 
     /** \ingroup precond_module
@@ -22,6 +22,8 @@
  * ************************************************************************ */
 
 #include "preconditioner_as.hpp"
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_vector.hpp"
 #include "../../utils/def.hpp"
@@ -31,6 +33,7 @@
 
 #include "preconditioner.hpp"
 
+#include <algorithm>
 #include <complex>
 #include <limits>
 
@@ -48,6 +51,9 @@ namespace rocalution
         this->overlap_    = -1;
 
         this->local_precond_ = NULL;
+
+        this->concurrent_blocks_ = 1;
+        this->contexts_          = NULL;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -103,11 +109,24 @@ namespace rocalution
         }
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AS<OperatorType, VectorType, ValueType>::SetConcurrentBlocks(int num)
+    {
+        log_debug(this, "AS::SetConcurrentBlocks()", num);
+
+        assert(num > 0);
+        assert(this->build_ == false);
+
+        this->concurrent_blocks_ = num;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void AS<OperatorType, VectorType, ValueType>::Build(void)
     {
         log_debug(this, "AS::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("AS::Build()");
+
         assert(this->op_ != NULL);
         assert(this->num_blocks_ > 0);
         assert(this->overlap_ >= 0);
@@ -160,6 +179,19 @@ namespace rocalution
         this->r_         = new VectorType*[this->num_blocks_];
         this->z_         = new VectorType*[this->num_blocks_];
 
+        // One execution context per concurrent block solve
+        int nctx = std::min(this->concurrent_blocks_, this->num_blocks_);
+
+        if(nctx > 1 && _rocalution_available_accelerator() == true)
+        {
+            this->contexts_ = new ExecutionContext*[nctx];
+
+            for(int c = 0; c < nctx; ++c)
+            {
+                this->contexts_[c] = new ExecutionContext;
+            }
+        }
+
         for(int i = 0; i < this->num_blocks_; ++i)
         {
             this->r_[i] = new VectorType;
@@ -179,6 +211,17 @@ namespace rocalution
                                         this->sizes_[i],
                                         this->local_mat_[i]);
 
+            // Attach the block before building its preconditioner, such that all
+            // objects of the preconditioner share the context
+            if(this->contexts_ != NULL)
+            {
+                const ExecutionContext& ctx = *this->contexts_[i % nctx];
+
+                this->r_[i]->SetExecutionContext(ctx);
+                this->z_[i]->SetExecutionContext(ctx);
+                this->local_mat_[i]->SetExecutionContext(ctx);
+            }
+
             this->local_precond_[i]->SetOperator(*this->local_mat_[i]);
             this->local_precond_[i]->Build();
         }
@@ -226,6 +269,20 @@ namespace rocalution
             this->pos_   = NULL;
             this->sizes_ = NULL;
 
+            // Contexts have to outlive the attached objects
+            if(this->contexts_ != NULL)
+            {
+                int nctx = std::min(this->concurrent_blocks_, this->num_blocks_);
+
+                for(int c = 0; c < nctx; ++c)
+                {
+                    delete this->contexts_[c];
+                }
+
+                delete[] this->contexts_;
+                this->contexts_ = NULL;
+            }
+
             this->num_blocks_    = 0;
             this->overlap_       = -1;
             this->local_precond_ = NULL;
@@ -243,17 +300,7 @@ namespace rocalution
         assert(x != NULL);
         assert(x != &rhs);
 
-        for(int i = 0; i < this->num_blocks_; ++i)
-        {
-            this->r_[i]->CopyFrom(rhs, this->pos_[i], 0, this->sizes_[i]);
-        }
-
-        // Solve
-        for(int i = 0; i < this->num_blocks_; ++i)
-        {
-            this->local_precond_[i]->SolveZeroSol(*this->r_[i], // rhs
-                                                  this->z_[i]); // x
-        }
+        this->SolveBlocks_(rhs);
 
         x->Zeros();
         for(int i = 0; i < this->num_blocks_; ++i)
@@ -271,6 +318,55 @@ namespace rocalution
         log_debug(this, "AS::Solve_()", " #*# end");
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AS<OperatorType, VectorType, ValueType>::SolveBlocks_(const VectorType& rhs)
+    {
+        int nctx = std::min(this->concurrent_blocks_, this->num_blocks_);
+
+        if(nctx <= 1)
+        {
+            for(int i = 0; i < this->num_blocks_; ++i)
+            {
+                this->r_[i]->CopyFrom(rhs, this->pos_[i], 0, this->sizes_[i]);
+            }
+
+            // Solve
+            for(int i = 0; i < this->num_blocks_; ++i)
+            {
+                this->local_precond_[i]->SolveZeroSol(*this->r_[i], // rhs
+                                                      this->z_[i]); // x
+            }
+
+            return;
+        }
+
+        // The blocks read rhs on the streams of their contexts
+        _rocalution_sync_default();
+
+        // Each thread works on the blocks of one context
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nctx) schedule(static, 1)
+#endif
+        for(int c = 0; c < nctx; ++c)
+        {
+            if(this->contexts_ != NULL)
+            {
+                this->contexts_[c]->Activate();
+            }
+
+            for(int i = c; i < this->num_blocks_; i += nctx)
+            {
+                this->r_[i]->CopyFrom(rhs, this->pos_[i], 0, this->sizes_[i]);
+                this->local_precond_[i]->SolveZeroSol(*this->r_[i], this->z_[i]);
+            }
+
+            if(this->contexts_ != NULL)
+            {
+                this->contexts_[c]->Sync();
+            }
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void AS<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
     {
@@ -348,17 +444,7 @@ namespace rocalution
         assert(x != &rhs);
         assert(this->op_->GetLocalM() / this->num_blocks_ <= std::numeric_limits<int>::max());
 
-        for(int i = 0; i < this->num_blocks_; ++i)
-        {
-            this->r_[i]->CopyFrom(rhs, this->pos_[i], 0, this->sizes_[i]);
-        }
-
-        // Solve
-        for(int i = 0; i < this->num_blocks_; ++i)
-        {
-            this->local_precond_[i]->SolveZeroSol(*this->r_[i], // rhs
-                                                  this->z_[i]); // x
-        }
+        this->SolveBlocks_(rhs);
 
         int size     = static_cast<int>(this->op_->GetLocalM() / this->num_blocks_);
         int z_offset = 0;
@@ -372,6 +458,158 @@ namespace rocalution
         log_debug(this, "RAS::Solve_()", " #*# end");
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    GlobalRAS<OperatorType, VectorType, ValueType>::GlobalRAS()
+    {
+        log_debug(this, "GlobalRAS::GlobalRAS()", "default constructor");
+
+        this->local_precond_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    GlobalRAS<OperatorType, VectorType, ValueType>::~GlobalRAS()
+    {
+        log_debug(this, "GlobalRAS::~GlobalRAS()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GlobalRAS<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("GlobalRAS preconditioner");
+
+        if(this->build_ == true)
+        {
+            LOG_INFO("GlobalRAS overlap = " << this->ghost_.GetSize());
+        }
+
+        this->local_precond_->Print();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GlobalRAS<OperatorType, VectorType, ValueType>::Set(
+        Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>& precond)
+    {
+        log_debug(this, "GlobalRAS::Set()", this->build_, (const void*&)precond);
+
+        assert(this->local_precond_ == NULL);
+        assert(this->build_ == false);
+
+        this->local_precond_ = &precond;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GlobalRAS<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "GlobalRAS::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("GlobalRAS::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->local_precond_ != NULL);
+
+        // Interior rows and the rows of all ghost unknowns
+        this->op_->ExtractOverlapMatrix(&this->overlap_mat_);
+
+        this->local_precond_->SetOperator(this->overlap_mat_);
+        this->local_precond_->Build();
+
+        this->ghost_.CloneBackend(*this->op_);
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("GlobalRAS r", this->overlap_mat_.GetM());
+
+        this->z_.CloneBackend(*this->op_);
+        this->z_.Allocate("GlobalRAS z", this->overlap_mat_.GetM());
+
+        log_debug(this, "GlobalRAS::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GlobalRAS<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "GlobalRAS::Clear()", this->build_);
+
+        if(this->local_precond_ != NULL)
+        {
+            this->local_precond_->Clear();
+        }
+
+        this->local_precond_ = NULL;
+
+        this->overlap_mat_.Clear();
+        this->ghost_.Clear();
+        this->r_.Clear();
+        this->z_.Clear();
+
+        this->build_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GlobalRAS<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
+                                                               VectorType*       x)
+    {
+        log_debug(this, "GlobalRAS::Solve()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+        assert(x != &rhs);
+
+        int64_t m = rhs.GetInterior().GetSize();
+
+        // Right hand side of the overlapping subdomain
+        this->op_->GetGhostValues(rhs, &this->ghost_);
+
+        this->r_.CopyFrom(rhs.GetInterior(), 0, 0, m);
+
+        if(this->ghost_.GetSize() > 0)
+        {
+            this->r_.CopyFrom(this->ghost_, 0, m, this->ghost_.GetSize());
+        }
+
+        this->local_precond_->SolveZeroSol(this->r_, &this->z_);
+
+        // Restrict the solution to the interior unknowns
+        x->GetInterior().CopyFrom(this->z_, 0, 0, m);
+
+        log_debug(this, "GlobalRAS::Solve()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GlobalRAS<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "GlobalRAS::MoveToHostLocalData_()", this->build_);
+
+        this->overlap_mat_.MoveToHost();
+        this->ghost_.MoveToHost();
+        this->r_.MoveToHost();
+        this->z_.MoveToHost();
+
+        this->local_precond_->MoveToHost();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void GlobalRAS<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "GlobalRAS::MoveToAcceleratorLocalData_()", this->build_);
+
+        this->overlap_mat_.MoveToAccelerator();
+        this->ghost_.MoveToAccelerator();
+        this->r_.MoveToAccelerator();
+        this->z_.MoveToAccelerator();
+
+        this->local_precond_->MoveToAccelerator();
+    }
+
     template class AS<LocalMatrix<double>, LocalVector<double>, double>;
     template class AS<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -394,4 +632,15 @@ namespace rocalution
                        std::complex<float>>;
 #endif
 
+    template class GlobalRAS<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class GlobalRAS<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class GlobalRAS<GlobalMatrix<std::complex<double>>,
+                             GlobalVector<std::complex<double>>,
+                             std::complex<double>>;
+    template class GlobalRAS<GlobalMatrix<std::complex<float>>,
+                             GlobalVector<std::complex<float>>,
+                             std::complex<float>>;
+#endif
+
 } // namespace rocalution
@@ -24,6 +24,8 @@
 #ifndef ROCALUTION_PRECONDITIONER_AS_HPP_
 #define ROCALUTION_PRECONDITIONER_AS_HPP_
 
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
 #include "preconditioner.hpp"
 #include "rocalution/export.hpp"
 
@@ -61,6 +63,17 @@ namespace rocalution
         ROCALUTION_EXPORT
         void Set(int nb, int overlap, Solver<OperatorType, VectorType, ValueType>** preconds);
 
+        /** \brief Set the number of block solves that run concurrently
+      * \details
+      * By default, the blocks are solved one after another. With \p num > 1, the
+      * blocks are distributed round-robin over \p num host threads. On the
+      * accelerator, each thread queues its blocks on its own ExecutionContext, such
+      * that the block solves run concurrently on the device. Has to be called before
+      * Build().
+      */
+        ROCALUTION_EXPORT
+        void SetConcurrentBlocks(int num);
+
         ROCALUTION_EXPORT
         virtual void Solve(const VectorType& rhs, VectorType* x);
 
@@ -73,6 +86,9 @@ namespace rocalution
         virtual void MoveToHostLocalData_(void);
         virtual void MoveToAcceleratorLocalData_(void);
 
+        /** \brief Extract the right hand side of each block and solve all blocks */
+        void SolveBlocks_(const VectorType& rhs);
+
         /** \brief Number of blocks */
         int num_blocks_; /**< Number of blocks */
         /** \brief Overlap */
@@ -93,6 +109,11 @@ namespace rocalution
         VectorType** z_;
         /** \brief weights */
         VectorType weight_;
+
+        /** \brief Number of concurrent block solves */
+        int concurrent_blocks_;
+        /** \brief Execution contexts of the concurrent block solves */
+        ExecutionContext** contexts_;
     };
 
     /** \ingroup precond_module
@@ -126,6 +147,60 @@ namespace rocalution
         virtual void Solve(const VectorType& rhs, VectorType* x);
     };
 
+    /** \ingroup precond_module
+  * \class GlobalRAS
+  * \brief Distributed Restricted Additive Schwarz Preconditioner
+  * \details
+  * The distributed Restricted Additive Schwarz preconditioner extends the interior
+  * matrix of each process by one layer of overlap, i.e. by the rows of all ghost
+  * unknowns, which are fetched from the neighboring processes. The overlapping
+  * subdomain problem is solved by a local preconditioner, and only the solution on the
+  * interior unknowns is kept. In contrast to BlockJacobi, the coupling to the
+  * neighboring processes enters the local solves.
+  * \cite RAS
+  *
+  * \tparam OperatorType - can be GlobalMatrix
+  * \tparam VectorType - can be GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class GlobalRAS : public Preconditioner<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        GlobalRAS();
+        ROCALUTION_EXPORT
+        virtual ~GlobalRAS();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Set local preconditioner for the overlapping subdomain */
+        ROCALUTION_EXPORT
+        void Set(Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>& precond);
+
+        ROCALUTION_EXPORT
+        virtual void Solve(const VectorType& rhs, VectorType* x);
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>* local_precond_;
+
+        LocalMatrix<ValueType> overlap_mat_;
+
+        LocalVector<ValueType> ghost_;
+        LocalVector<ValueType> r_;
+        LocalVector<ValueType> z_;
+    };
+
 } // namespace rocalution
 
 #endif // ROCALUTION_PRECONDITIONER_AS_HPP_
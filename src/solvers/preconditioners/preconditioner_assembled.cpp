@@ -0,0 +1,205 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "preconditioner_assembled.hpp"
+#include "../../utils/def.hpp"
+#include "../solver.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_shell_operator.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/log.hpp"
+
+#include "preconditioner.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    AssembledPreconditioner<OperatorType, VectorType, ValueType>::AssembledPreconditioner()
+    {
+        log_debug(this, "AssembledPreconditioner::AssembledPreconditioner()", "default constructor");
+
+        this->solver_ = NULL;
+        this->mat_    = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    AssembledPreconditioner<OperatorType, VectorType, ValueType>::~AssembledPreconditioner()
+    {
+        log_debug(this, "AssembledPreconditioner::~AssembledPreconditioner()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AssembledPreconditioner<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->solver_ == NULL)
+        {
+            LOG_INFO("AssembledPreconditioner");
+        }
+        else
+        {
+            LOG_INFO("AssembledPreconditioner, with solver:");
+            this->solver_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AssembledPreconditioner<OperatorType, VectorType, ValueType>::Set(
+        Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>& solver,
+        const LocalMatrix<ValueType>&                                      mat)
+    {
+        log_debug(this, "AssembledPreconditioner::Set()", (const void*&)solver, (const void*&)mat);
+
+        this->solver_ = &solver;
+        this->mat_    = &mat;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AssembledPreconditioner<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "AssembledPreconditioner::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("AssembledPreconditioner::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->solver_ != NULL);
+        assert(this->mat_ != NULL);
+        assert(this->op_ != NULL);
+        assert(this->mat_->GetM() == this->op_->GetM());
+        assert(this->mat_->GetN() == this->op_->GetN());
+
+        this->solver_->SetOperator(*this->mat_);
+        this->solver_->Build();
+
+        log_debug(this, "AssembledPreconditioner::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AssembledPreconditioner<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "AssembledPreconditioner::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->solver_->ResetOperator(*this->mat_);
+            this->solver_->ReBuildNumeric();
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AssembledPreconditioner<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "AssembledPreconditioner::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            assert(this->solver_ != NULL);
+            this->solver_->Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AssembledPreconditioner<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
+                                                                             VectorType*       x)
+    {
+        log_debug(this, "AssembledPreconditioner::Solve()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+        assert(x != &rhs);
+
+        this->solver_->Solve(rhs, x);
+
+        log_debug(this, "AssembledPreconditioner::Solve()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AssembledPreconditioner<OperatorType, VectorType, ValueType>::SolveZeroSol(
+        const VectorType& rhs, VectorType* x)
+    {
+        log_debug(
+            this, "AssembledPreconditioner::SolveZeroSol()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+        assert(x != &rhs);
+
+        this->solver_->SolveZeroSol(rhs, x);
+
+        log_debug(this, "AssembledPreconditioner::SolveZeroSol()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AssembledPreconditioner<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "AssembledPreconditioner::MoveToHostLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->solver_->MoveToHost();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void AssembledPreconditioner<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(
+        void)
+    {
+        log_debug(this, "AssembledPreconditioner::MoveToAcceleratorLocalData_()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->solver_->MoveToAccelerator();
+        }
+    }
+
+    template class AssembledPreconditioner<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class AssembledPreconditioner<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class AssembledPreconditioner<LocalShellOperator<std::complex<double>>,
+                                           LocalVector<std::complex<double>>,
+                                           std::complex<double>>;
+    template class AssembledPreconditioner<LocalShellOperator<std::complex<float>>,
+                                           LocalVector<std::complex<float>>,
+                                           std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,107 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_PRECONDITIONER_ASSEMBLED_HPP_
+#define ROCALUTION_PRECONDITIONER_ASSEMBLED_HPP_
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
+#include "preconditioner.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup precond_module
+  * \class AssembledPreconditioner
+  * \brief Preconditioner built on an Assembled Approximation
+  * \details
+  * The assembled preconditioner applies a solver, that is built on an assembled
+  * approximation of the operator, as preconditioner. This allows matrix-free operators
+  * (see LocalShellOperator) to be combined with preconditioners that require the matrix
+  * entries, e.g. an AMG hierarchy built from a low order discretization, while the
+  * outer solver works with the (high order) matrix-free operator.
+  *
+  * The inner solver is usually configured to perform a single cycle, e.g.
+  * \code{.cpp}
+  *   SAAMG<LocalMatrix<double>, LocalVector<double>, double> amg;
+  *   amg.InitMaxIter(1);
+  *   amg.Verbose(0);
+  *
+  *   AssembledPreconditioner<LocalShellOperator<double>, LocalVector<double>, double> p;
+  *   p.Set(amg, approx);
+  *
+  *   CG<LocalShellOperator<double>, LocalVector<double>, double> cg;
+  *   cg.SetOperator(op);
+  *   cg.SetPreconditioner(p);
+  *   cg.Build();
+  * \endcode
+  *
+  * \tparam OperatorType - can be LocalShellOperator
+  * \tparam VectorType - can be LocalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class AssembledPreconditioner : public Preconditioner<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        AssembledPreconditioner();
+        ROCALUTION_EXPORT
+        virtual ~AssembledPreconditioner();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Set the solver and the assembled approximation of the operator it is
+      * built on
+      */
+        ROCALUTION_EXPORT
+        void Set(Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>& solver,
+                 const LocalMatrix<ValueType>&                                      mat);
+
+        ROCALUTION_EXPORT
+        virtual void Solve(const VectorType& rhs, VectorType* x);
+        ROCALUTION_EXPORT
+        virtual void SolveZeroSol(const VectorType& rhs, VectorType* x);
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>* solver_;
+
+        const LocalMatrix<ValueType>* mat_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_PRECONDITIONER_ASSEMBLED_HPP_
@@ -81,6 +81,8 @@ namespace rocalution
     {
         log_debug(this, "BlockJacobi::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("BlockJacobi::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -33,6 +33,7 @@
 #include "../../utils/allocate_free.hpp"
 #include "../../utils/log.hpp"
 
+#include <algorithm>
 #include <complex>
 
 namespace rocalution
@@ -51,6 +52,9 @@ namespace rocalution
 
         this->diag_solve_ = false;
         this->A_last_     = NULL;
+
+        this->concurrent_blocks_ = 1;
+        this->contexts_          = NULL;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -95,6 +99,20 @@ namespace rocalution
             delete[] this->A_block_;
             delete[] this->D_solver_;
 
+            // Contexts have to outlive the attached objects
+            if(this->contexts_ != NULL)
+            {
+                int nctx = std::min(this->concurrent_blocks_, this->num_blocks_);
+
+                for(int c = 0; c < nctx; ++c)
+                {
+                    delete this->contexts_[c];
+                }
+
+                delete[] this->contexts_;
+                this->contexts_ = NULL;
+            }
+
             free_host(&this->block_sizes_);
             this->num_blocks_ = 0;
 
@@ -163,6 +181,17 @@ namespace rocalution
         this->diag_solve_ = false;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void BlockPreconditioner<OperatorType, VectorType, ValueType>::SetConcurrentBlocks(int num)
+    {
+        log_debug(this, "BlockPreconditioner::SetConcurrentBlocks()", num);
+
+        assert(num > 0);
+        assert(this->build_ == false);
+
+        this->concurrent_blocks_ = num;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void BlockPreconditioner<OperatorType, VectorType, ValueType>::SetExternalLastMatrix(
         const OperatorType& mat)
@@ -193,6 +222,8 @@ namespace rocalution
     {
         log_debug(this, "BlockPreconditioner::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("BlockPreconditioner::Build()");
+
         assert(this->build_ == false);
         this->build_ = true;
 
@@ -289,6 +320,30 @@ namespace rocalution
             this->A_last_ = NULL;
         }
 
+        // One execution context per concurrent block solve, the diagonal blocks are
+        // attached before their solvers are built, such that all objects of a solver
+        // share the context
+        int nctx = std::min(this->concurrent_blocks_, this->num_blocks_);
+
+        if(this->diag_solve_ == true && nctx > 1 && _rocalution_available_accelerator() == true)
+        {
+            this->contexts_ = new ExecutionContext*[nctx];
+
+            for(int c = 0; c < nctx; ++c)
+            {
+                this->contexts_[c] = new ExecutionContext;
+            }
+
+            for(int i = 0; i < this->num_blocks_; ++i)
+            {
+                const ExecutionContext& ctx = *this->contexts_[i % nctx];
+
+                this->x_block_[i]->SetExecutionContext(ctx);
+                this->tmp_block_[i]->SetExecutionContext(ctx);
+                this->A_block_[i][i]->SetExecutionContext(ctx);
+            }
+        }
+
         for(int i = 0; i < this->num_blocks_; ++i)
         {
             this->D_solver_[i]->SetOperator(*this->A_block_[i][i]);
@@ -358,21 +413,54 @@ namespace rocalution
             }
         }
 
-        // Solve L
-        for(int i = 0; i < this->num_blocks_; ++i)
+        int nctx = std::min(this->concurrent_blocks_, this->num_blocks_);
+
+        if(this->diag_solve_ == true && nctx > 1)
         {
-            if(this->diag_solve_ == false)
+            // The blocks read x on the streams of their contexts
+            _rocalution_sync_default();
+
+            // Each thread works on the blocks of one context
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nctx) schedule(static, 1)
+#endif
+            for(int c = 0; c < nctx; ++c)
             {
-                for(int j = 0; j < i; ++j)
+                if(this->contexts_ != NULL)
+                {
+                    this->contexts_[c]->Activate();
+                }
+
+                for(int i = c; i < this->num_blocks_; i += nctx)
                 {
-                    this->A_block_[i][j]->ApplyAdd(
-                        *this->x_block_[j], static_cast<ValueType>(-1), this->x_block_[i]);
+                    this->D_solver_[i]->SolveZeroSol(*this->x_block_[i], this->tmp_block_[i]);
+                    this->x_block_[i]->CopyFrom(*this->tmp_block_[i]);
+                }
+
+                if(this->contexts_ != NULL)
+                {
+                    this->contexts_[c]->Sync();
                 }
             }
+        }
+        else
+        {
+            // Solve L
+            for(int i = 0; i < this->num_blocks_; ++i)
+            {
+                if(this->diag_solve_ == false)
+                {
+                    for(int j = 0; j < i; ++j)
+                    {
+                        this->A_block_[i][j]->ApplyAdd(
+                            *this->x_block_[j], static_cast<ValueType>(-1), this->x_block_[i]);
+                    }
+                }
 
-            this->D_solver_[i]->SolveZeroSol(*this->x_block_[i], this->tmp_block_[i]);
+                this->D_solver_[i]->SolveZeroSol(*this->x_block_[i], this->tmp_block_[i]);
 
-            this->x_block_[i]->CopyFrom(*this->tmp_block_[i]);
+                this->x_block_[i]->CopyFrom(*this->tmp_block_[i]);
+            }
         }
 
         // Insert Solution
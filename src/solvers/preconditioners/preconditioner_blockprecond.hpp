@@ -85,6 +85,17 @@ namespace rocalution
         ROCALUTION_EXPORT
         void SetLSolver(void);
 
+        /** \brief Set the number of diagonal block solves that run concurrently
+      * \details
+      * In diagonal solver mode (see SetDiagonalSolver()), the blocks are independent.
+      * With \p num > 1, they are distributed round-robin over \p num host threads and,
+      * on the accelerator, over \p num execution contexts, see AS::SetConcurrentBlocks().
+      * The lower triangular sweeps are always solved sequentially. Has to be called
+      * before Build().
+      */
+        ROCALUTION_EXPORT
+        void SetConcurrentBlocks(int num);
+
         /** \brief Set external last block matrix */
         ROCALUTION_EXPORT
         void SetExternalLastMatrix(const OperatorType& mat);
@@ -128,6 +139,11 @@ namespace rocalution
         /** \brief Flag if diagonal solves enabled */
         bool diag_solve_;
 
+        /** \brief Number of concurrent diagonal block solves */
+        int concurrent_blocks_;
+        /** \brief Execution contexts of the concurrent block solves */
+        ExecutionContext** contexts_;
+
         virtual void MoveToHostLocalData_(void);
         virtual void MoveToAcceleratorLocalData_(void);
     };
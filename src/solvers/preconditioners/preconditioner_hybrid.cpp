@@ -0,0 +1,353 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "preconditioner_hybrid.hpp"
+#include "../../utils/def.hpp"
+#include "../solver.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/log.hpp"
+
+#include "preconditioner.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    L1Jacobi<OperatorType, VectorType, ValueType>::L1Jacobi()
+    {
+        log_debug(this, "L1Jacobi::L1Jacobi()", "default constructor");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    L1Jacobi<OperatorType, VectorType, ValueType>::~L1Jacobi()
+    {
+        log_debug(this, "L1Jacobi::~L1Jacobi()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void L1Jacobi<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("L1-Jacobi preconditioner");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void L1Jacobi<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "L1Jacobi::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("L1Jacobi::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+
+        const LocalMatrix<ValueType>& interior = this->op_->GetInterior();
+        const LocalMatrix<ValueType>& ghost    = this->op_->GetGhost();
+
+        // d_i = sum_j |a_ij| over the interior and the ghost part of row i
+        this->inv_diag_entries_.CloneBackend(interior);
+        interior.ExtractRowL1Norm(&this->inv_diag_entries_);
+
+        if(ghost.GetNnz() > 0)
+        {
+            LocalVector<ValueType> ghost_l1;
+            ghost_l1.CloneBackend(ghost);
+            ghost.ExtractRowL1Norm(&ghost_l1);
+
+            this->inv_diag_entries_.AddScale(ghost_l1, static_cast<ValueType>(1));
+        }
+
+        this->inv_diag_entries_.Power(-1.0);
+
+        log_debug(this, "L1Jacobi::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void L1Jacobi<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "L1Jacobi::Clear()", this->build_);
+
+        this->inv_diag_entries_.Clear();
+        this->build_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void L1Jacobi<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
+                                                              VectorType*       x)
+    {
+        log_debug(this, "L1Jacobi::Solve()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+
+        if(x != &rhs)
+        {
+            x->GetInterior().PointWiseMult(this->inv_diag_entries_, rhs.GetInterior());
+        }
+        else
+        {
+            x->GetInterior().PointWiseMult(this->inv_diag_entries_);
+        }
+
+        log_debug(this, "L1Jacobi::Solve()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void L1Jacobi<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "L1Jacobi::MoveToHostLocalData_()", this->build_);
+
+        this->inv_diag_entries_.MoveToHost();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void L1Jacobi<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "L1Jacobi::MoveToAcceleratorLocalData_()", this->build_);
+
+        this->inv_diag_entries_.MoveToAccelerator();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    HybridGS<OperatorType, VectorType, ValueType>::HybridGS()
+    {
+        log_debug(this, "HybridGS::HybridGS()", "default constructor");
+
+        this->l1_        = true;
+        this->symmetric_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    HybridGS<OperatorType, VectorType, ValueType>::~HybridGS()
+    {
+        log_debug(this, "HybridGS::~HybridGS()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void HybridGS<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("Hybrid " << (this->l1_ ? "l1 " : "")
+                           << (this->symmetric_ ? "Symmetric Gauss-Seidel" : "Gauss-Seidel")
+                           << " preconditioner");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void HybridGS<OperatorType, VectorType, ValueType>::SetL1(bool l1)
+    {
+        log_debug(this, "HybridGS::SetL1()", l1);
+
+        assert(this->build_ == false);
+
+        this->l1_ = l1;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void HybridGS<OperatorType, VectorType, ValueType>::SetSymmetric(bool symmetric)
+    {
+        log_debug(this, "HybridGS::SetSymmetric()", symmetric);
+
+        assert(this->build_ == false);
+
+        this->symmetric_ = symmetric;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void HybridGS<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "HybridGS::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("HybridGS::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+
+        const LocalMatrix<ValueType>& interior = this->op_->GetInterior();
+        const LocalMatrix<ValueType>& ghost    = this->op_->GetGhost();
+
+        // d_i = a_ii (+ sum_{j in ghost} |a_ij|)
+        this->inv_diag_entries_.CloneBackend(interior);
+        interior.ExtractDiagonal(&this->inv_diag_entries_);
+
+        if(this->l1_ == true && ghost.GetNnz() > 0)
+        {
+            LocalVector<ValueType> ghost_l1;
+            ghost_l1.CloneBackend(ghost);
+            ghost.ExtractRowL1Norm(&ghost_l1);
+
+            this->inv_diag_entries_.AddScale(ghost_l1, static_cast<ValueType>(1));
+        }
+
+        this->inv_diag_entries_.Power(-1.0);
+
+        // The forward sweep (L + D) x = r is performed as (I + L D^-1) D x = r and the
+        // backward sweep (D + U) x = D v as (I + D^-1 U) x = v, such that the triangular
+        // solves use a unit diagonal and the diagonal D can differ from the one of the
+        // interior matrix
+        this->L_.CloneFrom(interior);
+        this->L_.DiagonalMatrixMultR(this->inv_diag_entries_);
+        DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->L_, LAnalyse, true);
+
+        if(this->symmetric_ == true)
+        {
+            this->U_.CloneFrom(interior);
+            this->U_.DiagonalMatrixMultL(this->inv_diag_entries_);
+            DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->U_, UAnalyse, true);
+        }
+
+        this->v_.CloneBackend(interior);
+        this->v_.Allocate("v", interior.GetM());
+
+        log_debug(this, "HybridGS::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void HybridGS<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "HybridGS::Clear()", this->build_);
+
+        this->L_.Clear();
+        DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->L_, LAnalyseClear);
+
+        this->U_.Clear();
+        DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->U_, UAnalyseClear);
+
+        this->inv_diag_entries_.Clear();
+        this->v_.Clear();
+
+        this->build_ = false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void HybridGS<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
+                                                              VectorType*       x)
+    {
+        log_debug(this, "HybridGS::Solve()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+
+        // Forward sweep, v = (I + L D^-1)^-1 r
+        DISPATCH_OPERATOR_SOLVE_STRATEGY(
+            this->solver_descr_, this->L_, LSolve, rhs.GetInterior(), &this->v_);
+
+        if(this->symmetric_ == true)
+        {
+            // Backward sweep, x = (I + D^-1 U)^-1 D^-1 v
+            this->v_.PointWiseMult(this->inv_diag_entries_);
+
+            DISPATCH_OPERATOR_SOLVE_STRATEGY(
+                this->solver_descr_, this->U_, USolve, this->v_, &x->GetInterior());
+        }
+        else
+        {
+            // x = D^-1 v
+            x->GetInterior().PointWiseMult(this->inv_diag_entries_, this->v_);
+        }
+
+        log_debug(this, "HybridGS::Solve()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void HybridGS<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "HybridGS::MoveToHostLocalData_()", this->build_);
+
+        this->L_.MoveToHost();
+        DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->L_, LAnalyse, true);
+
+        if(this->symmetric_ == true)
+        {
+            this->U_.MoveToHost();
+            DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->U_, UAnalyse, true);
+        }
+
+        this->inv_diag_entries_.MoveToHost();
+        this->v_.MoveToHost();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void HybridGS<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "HybridGS::MoveToAcceleratorLocalData_()", this->build_);
+
+        this->L_.MoveToAccelerator();
+        DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->L_, LAnalyse, true);
+
+        if(this->symmetric_ == true)
+        {
+            this->U_.MoveToAccelerator();
+            DISPATCH_OPERATOR_ANALYSE_STRATEGY(this->solver_descr_, this->U_, UAnalyse, true);
+        }
+
+        this->inv_diag_entries_.MoveToAccelerator();
+        this->v_.MoveToAccelerator();
+    }
+
+    template class L1Jacobi<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class L1Jacobi<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class L1Jacobi<GlobalMatrix<std::complex<double>>,
+                            GlobalVector<std::complex<double>>,
+                            std::complex<double>>;
+    template class L1Jacobi<GlobalMatrix<std::complex<float>>,
+                            GlobalVector<std::complex<float>>,
+                            std::complex<float>>;
+#endif
+
+    template class HybridGS<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class HybridGS<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class HybridGS<GlobalMatrix<std::complex<double>>,
+                            GlobalVector<std::complex<double>>,
+                            std::complex<double>>;
+    template class HybridGS<GlobalMatrix<std::complex<float>>,
+                            GlobalVector<std::complex<float>>,
+                            std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,148 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_PRECONDITIONER_HYBRID_HPP_
+#define ROCALUTION_PRECONDITIONER_HYBRID_HPP_
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
+#include "preconditioner.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup precond_module
+  * \class L1Jacobi
+  * \brief L1-Jacobi Preconditioner
+  * \details
+  * The L1-Jacobi preconditioner scales each row of a distributed operator by the
+  * inverse of its l1 norm, taken over the interior and the ghost part of the row
+  * \f[
+  *   d_{i} = \sum_{j} |a_{ij}|.
+  * \f]
+  * Used as a smoother (e.g. within FixedPoint), L1-Jacobi converges for symmetric
+  * positive definite operators without any damping parameter, independent of the
+  * number of processes.
+  *
+  * \tparam OperatorType - can be GlobalMatrix
+  * \tparam VectorType - can be GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class L1Jacobi : public Preconditioner<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        L1Jacobi();
+        ROCALUTION_EXPORT
+        virtual ~L1Jacobi();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+        ROCALUTION_EXPORT
+        virtual void Solve(const VectorType& rhs, VectorType* x);
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        LocalVector<ValueType> inv_diag_entries_;
+    };
+
+    /** \ingroup precond_module
+  * \class HybridGS
+  * \brief Hybrid Gauss-Seidel Preconditioner
+  * \details
+  * The hybrid Gauss-Seidel preconditioner performs a Gauss-Seidel sweep on the
+  * interior matrix of each process, while the coupling to other processes (the ghost
+  * part) is treated in a Jacobi fashion, i.e. it only enters through the residual.
+  * By default, the diagonal of each row is augmented by the l1 norm of its ghost
+  * entries (l1 Gauss-Seidel)
+  * \f[
+  *   d_{i} = a_{ii} + \sum_{j \in ghost} |a_{ij}|,
+  * \f]
+  * which keeps the smoother convergent for symmetric positive definite operators when
+  * the number of processes grows. Optionally, a symmetric (forward and backward) sweep
+  * can be performed.
+  *
+  * \tparam OperatorType - can be GlobalMatrix
+  * \tparam VectorType - can be GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class HybridGS : public Preconditioner<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        HybridGS();
+        ROCALUTION_EXPORT
+        virtual ~HybridGS();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Set flag to augment the diagonal by the l1 norm of the ghost rows
+        * (default true)
+        */
+        ROCALUTION_EXPORT
+        void SetL1(bool l1);
+        /** \brief Set flag to perform a symmetric (forward and backward) sweep
+        * (default false)
+        */
+        ROCALUTION_EXPORT
+        void SetSymmetric(bool symmetric);
+
+        ROCALUTION_EXPORT
+        virtual void Solve(const VectorType& rhs, VectorType* x);
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        bool l1_;
+        bool symmetric_;
+
+        // Interior matrix scaled by the inverse (l1) diagonal, from the right for the
+        // forward and from the left for the backward sweep
+        LocalMatrix<ValueType> L_;
+        LocalMatrix<ValueType> U_;
+
+        LocalVector<ValueType> inv_diag_entries_;
+        LocalVector<ValueType> v_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_PRECONDITIONER_HYBRID_HPP_
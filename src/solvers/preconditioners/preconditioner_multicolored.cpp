@@ -54,6 +54,8 @@ namespace rocalution
         this->format_block_dim_   = 0;
 
         this->decomp_ = true;
+
+        this->block_dim_ = 1;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -163,7 +165,12 @@ namespace rocalution
     {
         log_debug(this, "MultiColored::Analyse_()");
 
-        if(this->analyzer_op_ != NULL)
+        if(this->block_dim_ > 1)
+        {
+            // Color the point blocks, such that all unknowns of a point share their color
+            this->AnalysePointBlocks_();
+        }
+        else if(this->analyzer_op_ != NULL)
         {
             // use extra matrix
             this->analyzer_op_->MultiColoring(
@@ -176,6 +183,85 @@ namespace rocalution
         }
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColored<OperatorType, VectorType, ValueType>::AnalysePointBlocks_(void)
+    {
+        log_debug(this, "MultiColored::AnalysePointBlocks_()");
+
+        const OperatorType* op = (this->analyzer_op_ != NULL) ? this->analyzer_op_ : this->op_;
+
+        int bs    = this->block_dim_;
+        int n     = static_cast<int>(op->GetM());
+        int nrowb = n / bs;
+
+        assert(n % bs == 0);
+
+        // Prolongation P with a one at (i, i / bs), mapping each point to its unknowns
+        PtrType*   p_row_offset = NULL;
+        int*       p_col        = NULL;
+        ValueType* p_val        = NULL;
+
+        allocate_host(n + 1, &p_row_offset);
+        allocate_host(n, &p_col);
+        allocate_host(n, &p_val);
+
+        for(int i = 0; i < n; ++i)
+        {
+            p_row_offset[i] = i;
+            p_col[i]        = i / bs;
+            p_val[i]        = static_cast<ValueType>(1);
+        }
+
+        p_row_offset[n] = n;
+
+        OperatorType P;
+        OperatorType R;
+        OperatorType G;
+
+        P.SetDataPtrCSR(&p_row_offset, &p_col, &p_val, "Point block prolongation", n, n, nrowb);
+        P.CloneBackend(*op);
+        P.Transpose(&R);
+
+        // Point graph G = P^T A P
+        G.CloneBackend(*op);
+        G.TripleMatrixProduct(R, *op, P);
+
+        P.Clear();
+        R.Clear();
+
+        LocalVector<int> point_perm;
+        point_perm.CloneBackend(*op);
+
+        G.MultiColoring(this->num_blocks_, &this->block_sizes_, &point_perm);
+        G.Clear();
+
+        // Expand the point permutation to all unknowns
+        int* h_point_perm = NULL;
+        int* h_perm       = NULL;
+
+        allocate_host(nrowb, &h_point_perm);
+        allocate_host(n, &h_perm);
+
+        point_perm.CopyToHostData(h_point_perm);
+
+        for(int i = 0; i < n; ++i)
+        {
+            h_perm[i] = h_point_perm[i / bs] * bs + i % bs;
+        }
+
+        free_host(&h_point_perm);
+
+        for(int i = 0; i < this->num_blocks_; ++i)
+        {
+            this->block_sizes_[i] *= bs;
+        }
+
+        this->permutation_.Clear();
+        this->permutation_.MoveToHost();
+        this->permutation_.SetDataPtr(&h_perm, "Point block multi-coloring permutation", n);
+        this->permutation_.CloneBackend(*this->op_);
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void MultiColored<OperatorType, VectorType, ValueType>::Permute_(void)
     {
@@ -253,7 +339,12 @@ namespace rocalution
                 this->diag_block_[i]->Allocate("Diagonal preconditioners blocks",
                                                this->block_sizes_[i]);
 
-                this->preconditioner_block_[i][i]->ExtractDiagonal(this->diag_block_[i]);
+                // In point block mode, the diagonal block is kept and the vector serves as
+                // temporary storage
+                if(this->block_dim_ == 1)
+                {
+                    this->preconditioner_block_[i][i]->ExtractDiagonal(this->diag_block_[i]);
+                }
 
                 this->x_block_[i] = new VectorType; // empty vector
 
@@ -263,14 +354,28 @@ namespace rocalution
 
                 x_offset += this->block_sizes_[i];
 
-                Jacobi<OperatorType, VectorType, ValueType>* jacobi
-                    = new Jacobi<OperatorType, VectorType, ValueType>;
-                jacobi->SetOperator(*this->preconditioner_block_[i][i]);
-                jacobi->Build();
+                if(this->block_dim_ > 1)
+                {
+                    // Batched inverses of the dense point blocks of each color
+                    PointBlockJacobi<OperatorType, VectorType, ValueType>* pbjacobi
+                        = new PointBlockJacobi<OperatorType, VectorType, ValueType>;
+                    pbjacobi->SetOperator(*this->preconditioner_block_[i][i]);
+                    pbjacobi->SetBlockDimension(this->block_dim_);
+                    pbjacobi->Build();
+
+                    this->diag_solver_[i] = pbjacobi;
+                }
+                else
+                {
+                    Jacobi<OperatorType, VectorType, ValueType>* jacobi
+                        = new Jacobi<OperatorType, VectorType, ValueType>;
+                    jacobi->SetOperator(*this->preconditioner_block_[i][i]);
+                    jacobi->Build();
 
-                this->diag_solver_[i] = jacobi;
+                    this->diag_solver_[i] = jacobi;
 
-                this->preconditioner_block_[i][i]->Clear();
+                    this->preconditioner_block_[i][i]->Clear();
+                }
             }
 
             // Clone the format
@@ -304,10 +409,15 @@ namespace rocalution
     {
         log_debug(this, "MultiColored::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("MultiColored::Build()");
+
         assert(this->build_ == false);
 
         assert(this->op_ != NULL);
 
+        // Point block relaxation is only available for the decomposed preconditioner
+        assert((this->block_dim_ == 1) || (this->decomp_ == true));
+
         this->Build_Analyser_();
         this->Analyse_();
 
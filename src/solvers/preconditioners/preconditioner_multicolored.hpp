@@ -96,6 +96,9 @@ namespace rocalution
         /** \brief Decompose the preconditioner into blocks or not */
         bool decomp_;
 
+        /** \brief Dimension of the point blocks that are colored and relaxed together */
+        int block_dim_;
+
         /** \brief Extract b into x under the permutation (see Analyse_()) and
       * decompose x into blocks (x_block_[])
       */
@@ -118,6 +121,8 @@ namespace rocalution
         virtual void Build_Analyser_(void);
         /** \brief Analyse the matrix (i.e. multi-coloring decomposition) */
         void Analyse_(void);
+        /** \brief Multi-coloring of the point blocks of size block_dim_ */
+        void AnalysePointBlocks_(void);
         /** \brief Permute the preconditioning matrix */
         void Permute_(void);
         /** \brief Factorize (i.e. build the preconditioner) */
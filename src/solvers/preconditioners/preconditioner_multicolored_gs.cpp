@@ -64,6 +64,17 @@ namespace rocalution
         this->omega_ = omega;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void MultiColoredSGS<OperatorType, VectorType, ValueType>::SetBlockDimension(int blockdim)
+    {
+        log_debug(this, "MultiColoredSGS::SetBlockDimension()", blockdim);
+
+        assert(blockdim > 0);
+        assert(this->build_ == false);
+
+        this->block_dim_ = blockdim;
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void MultiColoredSGS<OperatorType, VectorType, ValueType>::Print(void) const
     {
@@ -72,6 +83,11 @@ namespace rocalution
         if(this->build_ == true)
         {
             LOG_INFO("number of colors = " << this->num_blocks_);
+
+            if(this->block_dim_ > 1)
+            {
+                LOG_INFO("point block dimension = " << this->block_dim_);
+            }
         }
     }
 
@@ -160,7 +176,17 @@ namespace rocalution
 
         for(int i = 0; i < this->num_blocks_; ++i)
         {
-            this->x_block_[i]->PointWiseMult(*this->diag_block_[i]);
+            if(this->block_dim_ > 1)
+            {
+                // Multiply by the point block diagonal D_i
+                this->preconditioner_block_[i][i]->Apply(*this->x_block_[i],
+                                                         this->diag_block_[i]);
+                this->x_block_[i]->CopyFrom(*this->diag_block_[i]);
+            }
+            else
+            {
+                this->x_block_[i]->PointWiseMult(*this->diag_block_[i]);
+            }
 
             // SSOR
             if(this->omega_ != static_cast<ValueType>(1))
@@ -234,6 +260,11 @@ namespace rocalution
         if(this->build_ == true)
         {
             LOG_INFO("number of colors = " << this->num_blocks_);
+
+            if(this->block_dim_ > 1)
+            {
+                LOG_INFO("point block dimension = " << this->block_dim_);
+            }
         }
     }
 
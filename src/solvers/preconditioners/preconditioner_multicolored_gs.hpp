@@ -68,6 +68,18 @@ namespace rocalution
         ROCALUTION_EXPORT
         void SetRelaxation(ValueType omega);
 
+        /** \brief Set the dimension of the point blocks
+        * \details
+        * With a block dimension \f$b > 1\f$, the unknowns are grouped into consecutive
+        * points of size \f$b\f$, such as the components of a multi-component PDE. The
+        * points are colored instead of the single unknowns and the dense \f$b \times b\f$
+        * diagonal blocks of each color are inverted in a batched fashion, see
+        * PointBlockJacobi. The number of rows has to be a multiple of \f$b\f$ and the
+        * preconditioner has to be decomposed, see SetDecomposition().
+        */
+        ROCALUTION_EXPORT
+        void SetBlockDimension(int blockdim);
+
     protected:
         virtual void PostAnalyse_(void);
 
@@ -154,8 +154,8 @@ namespace rocalution
 
             this->preconditioner_->Permute(this->permutation_);
 
+            // The pattern is unchanged, the analysis of the triangular solves is kept
             this->preconditioner_->ILU0Factorize();
-            this->preconditioner_->LUAnalyse();
         }
         else
         {
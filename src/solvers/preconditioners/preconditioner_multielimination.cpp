@@ -175,6 +175,8 @@ namespace rocalution
     {
         log_debug(this, "MultiElimination::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("MultiElimination::Build()");
+
         assert(this->build_ == false);
         this->build_ = true;
 
@@ -0,0 +1,236 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "preconditioner_redundant.hpp"
+#include "../../utils/def.hpp"
+#include "../solver.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_vector.hpp"
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/log.hpp"
+
+#include "preconditioner.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    Redundant<OperatorType, VectorType, ValueType>::Redundant()
+    {
+        log_debug(this, "Redundant::Redundant()", "default constructor");
+
+        this->solver_ = NULL;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    Redundant<OperatorType, VectorType, ValueType>::~Redundant()
+    {
+        log_debug(this, "Redundant::~Redundant()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Redundant<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        if(this->solver_ == NULL)
+        {
+            LOG_INFO("Redundant solver");
+        }
+        else
+        {
+            LOG_INFO("Redundant solver, with local solver:");
+            this->solver_->Print();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Redundant<OperatorType, VectorType, ValueType>::Set(
+        Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>& solver)
+    {
+        log_debug(this, "Redundant::Set()", (const void*&)solver);
+
+        assert(this->build_ == false);
+
+        this->solver_ = &solver;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Redundant<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "Redundant::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("Redundant::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+        assert(this->solver_ != NULL);
+
+        // Agglomerate the operator on each process
+        this->op_->Gather(&this->mat_);
+
+        this->rhs_.CloneBackend(this->mat_);
+        this->rhs_.Allocate("redundant rhs", this->mat_.GetM());
+
+        this->x_.CloneBackend(this->mat_);
+        this->x_.Allocate("redundant x", this->mat_.GetM());
+
+        this->solver_->SetOperator(this->mat_);
+        this->solver_->Build();
+
+        log_debug(this, "Redundant::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Redundant<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "Redundant::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == true)
+        {
+            assert(this->op_ != NULL);
+
+            this->op_->Gather(&this->mat_);
+
+            this->solver_->ResetOperator(this->mat_);
+            this->solver_->ReBuildNumeric();
+        }
+        else
+        {
+            this->Build();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Redundant<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "Redundant::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            if(this->solver_ != NULL)
+            {
+                this->solver_->Clear();
+            }
+
+            this->mat_.Clear();
+            this->rhs_.Clear();
+            this->x_.Clear();
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Redundant<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
+                                                               VectorType*       x)
+    {
+        log_debug(this, "Redundant::Solve()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+
+        // The current solution serves as initial guess of the local solver
+        x->Gather(&this->x_);
+        rhs.Gather(&this->rhs_);
+
+        this->solver_->Solve(this->rhs_, &this->x_);
+
+        x->Scatter(this->x_);
+
+        log_debug(this, "Redundant::Solve()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Redundant<OperatorType, VectorType, ValueType>::SolveZeroSol(const VectorType& rhs,
+                                                                      VectorType*       x)
+    {
+        log_debug(this, "Redundant::SolveZeroSol()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+
+        rhs.Gather(&this->rhs_);
+
+        this->solver_->SolveZeroSol(this->rhs_, &this->x_);
+
+        x->Scatter(this->x_);
+
+        log_debug(this, "Redundant::SolveZeroSol()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Redundant<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "Redundant::MoveToHostLocalData_()", this->build_);
+
+        this->mat_.MoveToHost();
+        this->rhs_.MoveToHost();
+        this->x_.MoveToHost();
+
+        if(this->build_ == true)
+        {
+            this->solver_->MoveToHost();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Redundant<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "Redundant::MoveToAcceleratorLocalData_()", this->build_);
+
+        this->mat_.MoveToAccelerator();
+        this->rhs_.MoveToAccelerator();
+        this->x_.MoveToAccelerator();
+
+        if(this->build_ == true)
+        {
+            this->solver_->MoveToAccelerator();
+        }
+    }
+
+    template class Redundant<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class Redundant<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Redundant<GlobalMatrix<std::complex<double>>,
+                             GlobalVector<std::complex<double>>,
+                             std::complex<double>>;
+    template class Redundant<GlobalMatrix<std::complex<float>>,
+                             GlobalVector<std::complex<float>>,
+                             std::complex<float>>;
+#endif
+
+} // namespace rocalution
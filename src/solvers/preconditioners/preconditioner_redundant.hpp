@@ -0,0 +1,102 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_PRECONDITIONER_REDUNDANT_HPP_
+#define ROCALUTION_PRECONDITIONER_REDUNDANT_HPP_
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
+#include "preconditioner.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup precond_module
+  * \class Redundant
+  * \brief Redundant Solver
+  * \details
+  * The Redundant solver gathers a (small) distributed operator on each process and
+  * solves the system redundantly with a local solver, i.e. a solver for LocalMatrix
+  * and LocalVector. The right-hand side is gathered with a single collective
+  * operation, the local rows of the solution are then extracted without any further
+  * communication. Used as coarse grid solver of a distributed multigrid hierarchy,
+  * the coarsest levels are agglomerated onto each process, which avoids the latency
+  * bound iterations over all processes. The coarsest level can then be chosen much
+  * larger, e.g. with a local AMG as inner solver.
+  *
+  * The operator is agglomerated onto all processes of the communicator. Redistribution
+  * of the coarse levels onto sub-communicators, i.e. onto a subset of the processes,
+  * is not implemented. Each process stores the complete gathered operator, and each
+  * application gathers the complete right-hand side on each process, such that
+  * memory and communication volume per process grow with the global size of the
+  * operator, independent of the number of processes.
+  *
+  * \tparam OperatorType - can be GlobalMatrix
+  * \tparam VectorType - can be GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class Redundant : public Preconditioner<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        Redundant();
+        ROCALUTION_EXPORT
+        virtual ~Redundant();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Set the local solver, that is applied to the gathered system */
+        ROCALUTION_EXPORT
+        void Set(Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>& solver);
+
+        ROCALUTION_EXPORT
+        virtual void Solve(const VectorType& rhs, VectorType* x);
+        ROCALUTION_EXPORT
+        virtual void SolveZeroSol(const VectorType& rhs, VectorType* x);
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        Solver<LocalMatrix<ValueType>, LocalVector<ValueType>, ValueType>* solver_;
+
+        // Gathered operator, right-hand side and solution
+        LocalMatrix<ValueType> mat_;
+        LocalVector<ValueType> rhs_;
+        LocalVector<ValueType> x_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_PRECONDITIONER_REDUNDANT_HPP_
@@ -149,6 +149,8 @@ namespace rocalution
     {
         log_debug(this, "DiagJacobiSaddlePointPrecond::Build()", this->build_, " #*# begin");
 
+        ROCALUTION_RANGE("DiagJacobiSaddlePointPrecond::Build()");
+
         assert(this->build_ == false);
         this->build_ = true;
 
@@ -178,20 +180,25 @@ namespace rocalution
 
         this->A_.Permute(this->permutation_);
 
-        this->A_.ExtractSubMatrix(0, 0, this->size_, this->size_, &this->K_);
-
-        OperatorType E, F;
+        OperatorType E, F, Z;
         VectorType   inv_K;
 
         E.CloneBackend(*this->op_);
         F.CloneBackend(*this->op_);
+        Z.CloneBackend(*this->op_);
         inv_K.CloneBackend(*this->op_);
 
-        this->A_.ExtractSubMatrix(
-            0, this->size_, this->size_, this->A_.GetLocalN() - this->size_, &F);
+        // Extract K, F and E in a single pass over the permuted matrix
+        int row_offset[3] = {0, this->size_, static_cast<int>(this->A_.GetLocalM())};
+        int col_offset[3] = {0, this->size_, static_cast<int>(this->A_.GetLocalN())};
+
+        OperatorType*  blocks_0[2] = {&this->K_, &F};
+        OperatorType*  blocks_1[2] = {&E, &Z};
+        OperatorType** blocks[2]   = {blocks_0, blocks_1};
+
+        this->A_.ExtractSubMatrices(2, 2, row_offset, col_offset, blocks);
 
-        this->A_.ExtractSubMatrix(
-            this->size_, 0, this->A_.GetLocalM() - this->size_, this->size_, &E);
+        Z.Clear();
 
         this->A_.Clear();
 
@@ -0,0 +1,313 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "preconditioner_schur_ilu.hpp"
+#include "../../base/global_matrix.hpp"
+#include "../../base/local_matrix.hpp"
+#include "../../utils/def.hpp"
+#include "../solver.hpp"
+
+#include "../../base/global_vector.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/log.hpp"
+
+#include "preconditioner.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SchurILU<OperatorType, VectorType, ValueType>::SchurILU()
+    {
+        log_debug(this, "SchurILU::SchurILU()", "default constructor");
+
+        this->p_              = 0;
+        this->level_          = true;
+        this->interface_iter_ = 1;
+        this->ninterface_     = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    SchurILU<OperatorType, VectorType, ValueType>::~SchurILU()
+    {
+        log_debug(this, "SchurILU::~SchurILU()", "destructor");
+
+        this->Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SchurILU<OperatorType, VectorType, ValueType>::Print(void) const
+    {
+        LOG_INFO("SchurILU(" << this->p_ << ") preconditioner");
+
+        if(this->build_ == true)
+        {
+            LOG_INFO("SchurILU interface unknowns = " << this->ninterface_);
+            LOG_INFO("SchurILU interface iterations = " << this->interface_iter_);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SchurILU<OperatorType, VectorType, ValueType>::Set(int p, bool level)
+    {
+        log_debug(this, "SchurILU::Set()", p, level);
+
+        assert(p >= 0);
+        assert(this->build_ == false);
+
+        this->p_     = p;
+        this->level_ = level;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SchurILU<OperatorType, VectorType, ValueType>::SetInterfaceIterations(int iter)
+    {
+        log_debug(this, "SchurILU::SetInterfaceIterations()", iter);
+
+        assert(iter >= 0);
+
+        this->interface_iter_ = iter;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SchurILU<OperatorType, VectorType, ValueType>::Build(void)
+    {
+        log_debug(this, "SchurILU::Build()", this->build_, " #*# begin");
+
+        ROCALUTION_RANGE("SchurILU::Build()");
+
+        if(this->build_ == true)
+        {
+            this->Clear();
+        }
+
+        assert(this->build_ == false);
+        this->build_ = true;
+
+        assert(this->op_ != NULL);
+
+        int64_t m = this->op_->GetLocalM();
+
+        // Mark all rows that are coupled to ghost unknowns as interface rows
+        int* perm = NULL;
+        allocate_host(m, &perm);
+        set_to_zero_host(m, perm);
+
+        if(this->op_->GetGhostNnz() > 0)
+        {
+            LocalMatrix<ValueType> ghost;
+            ghost.CloneFrom(this->op_->GetGhost());
+            ghost.MoveToHost();
+
+            PtrType*   ghost_row_offset = NULL;
+            int*       ghost_col        = NULL;
+            ValueType* ghost_val        = NULL;
+
+            ghost.LeaveDataPtrCSR(&ghost_row_offset, &ghost_col, &ghost_val);
+
+            for(int64_t i = 0; i < m; ++i)
+            {
+                perm[i] = (ghost_row_offset[i + 1] > ghost_row_offset[i]) ? 1 : 0;
+            }
+
+            free_host(&ghost_row_offset);
+            free_host(&ghost_col);
+            free_host(&ghost_val);
+        }
+
+        // Interior rows first, interface rows last
+        int64_t ninterior = 0;
+        for(int64_t i = 0; i < m; ++i)
+        {
+            ninterior += (perm[i] == 0) ? 1 : 0;
+        }
+
+        this->ninterface_ = m - ninterior;
+
+        int64_t next_interior  = 0;
+        int64_t next_interface = ninterior;
+        for(int64_t i = 0; i < m; ++i)
+        {
+            perm[i] = static_cast<int>((perm[i] == 0) ? next_interior++ : next_interface++);
+        }
+
+        this->permutation_.MoveToHost();
+        this->permutation_.SetDataPtr(&perm, "SchurILU permutation", m);
+        this->permutation_.CloneBackend(*this->op_);
+
+        // Factorize the reordered interior matrix, the interface block of the
+        // factors holds the incomplete local Schur complement
+        this->ILU_.CloneFrom(this->op_->GetInterior());
+        this->ILU_.Permute(this->permutation_);
+        this->ILU_.ILUpFactorize(this->p_, this->level_);
+        this->ILU_.LUAnalyse();
+
+        this->r_.CloneBackend(*this->op_);
+        this->r_.Allocate("SchurILU r", m);
+
+        this->z_.CloneBackend(*this->op_);
+        this->z_.Allocate("SchurILU z", m);
+
+        if(this->interface_iter_ > 0)
+        {
+            this->w_.CloneBackend(*this->op_);
+            this->w_.Allocate("SchurILU w", this->op_->GetM());
+        }
+
+        log_debug(this, "SchurILU::Build()", this->build_, " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SchurILU<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+    {
+        log_debug(this, "SchurILU::ReBuildNumeric()", this->build_);
+
+        if(this->build_ == false)
+        {
+            this->Build();
+            return;
+        }
+
+        ROCALUTION_RANGE("SchurILU::ReBuildNumeric()");
+
+        // The interface rows only depend on the sparsity pattern of the ghost matrix,
+        // thus the permutation can be kept
+        this->ILU_.Clear();
+        this->ILU_.CloneFrom(this->op_->GetInterior());
+        this->ILU_.Permute(this->permutation_);
+        this->ILU_.ILUpFactorize(this->p_, this->level_);
+        this->ILU_.LUAnalyse();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SchurILU<OperatorType, VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "SchurILU::Clear()", this->build_);
+
+        if(this->build_ == true)
+        {
+            this->ILU_.Clear();
+            this->permutation_.Clear();
+
+            this->r_.Clear();
+            this->z_.Clear();
+            this->w_.Clear();
+
+            this->ninterface_ = 0;
+
+            this->build_ = false;
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SchurILU<OperatorType, VectorType, ValueType>::LocalSolve_(
+        const LocalVector<ValueType>& rhs, LocalVector<ValueType>* x)
+    {
+        this->r_.CopyFromPermute(rhs, this->permutation_);
+        this->ILU_.LUSolve(this->r_, &this->z_);
+        x->CopyFromPermuteBackward(this->z_, this->permutation_);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SchurILU<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
+                                                              VectorType*       x)
+    {
+        log_debug(this, "SchurILU::Solve()", " #*# begin", (const void*&)rhs, x);
+
+        assert(this->build_ == true);
+        assert(x != NULL);
+        assert(x != &rhs);
+
+        // Independent local solves, ghost couplings are dropped
+        this->LocalSolve_(rhs.GetInterior(), &x->GetInterior());
+
+        // Interface iterations, move the ghost contributions of the current
+        // approximation to the right hand side and solve again
+        for(int k = 0; k < this->interface_iter_; ++k)
+        {
+            // w = A x - A_interior x = A_ghost x_ghost
+            this->op_->Apply(*x, &this->w_);
+            this->op_->GetInterior().ApplyAdd(
+                x->GetInterior(), static_cast<ValueType>(-1), &this->w_.GetInterior());
+
+            // w = rhs - A_ghost x_ghost
+            this->w_.ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+            this->LocalSolve_(this->w_.GetInterior(), &x->GetInterior());
+        }
+
+        log_debug(this, "SchurILU::Solve()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SchurILU<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+    {
+        log_debug(this, "SchurILU::MoveToHostLocalData_()", this->build_);
+
+        this->ILU_.MoveToHost();
+        this->permutation_.MoveToHost();
+
+        this->r_.MoveToHost();
+        this->z_.MoveToHost();
+        this->w_.MoveToHost();
+
+        if(this->build_ == true)
+        {
+            this->ILU_.LUAnalyse();
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void SchurILU<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+    {
+        log_debug(this, "SchurILU::MoveToAcceleratorLocalData_()", this->build_);
+
+        this->ILU_.MoveToAccelerator();
+        this->permutation_.MoveToAccelerator();
+
+        this->r_.MoveToAccelerator();
+        this->z_.MoveToAccelerator();
+        this->w_.MoveToAccelerator();
+
+        if(this->build_ == true)
+        {
+            this->ILU_.LUAnalyse();
+        }
+    }
+
+    template class SchurILU<GlobalMatrix<double>, GlobalVector<double>, double>;
+    template class SchurILU<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SchurILU<GlobalMatrix<std::complex<double>>,
+                            GlobalVector<std::complex<double>>,
+                            std::complex<double>>;
+    template class SchurILU<GlobalMatrix<std::complex<float>>,
+                            GlobalVector<std::complex<float>>,
+                            std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,107 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_PRECONDITIONER_SCHUR_ILU_HPP_
+#define ROCALUTION_PRECONDITIONER_SCHUR_ILU_HPP_
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_vector.hpp"
+#include "preconditioner.hpp"
+#include "rocalution/export.hpp"
+
+namespace rocalution
+{
+
+    /** \ingroup precond_module
+  * \class SchurILU
+  * \brief Domain Decomposition ILU Preconditioner
+  * \details
+  * The SchurILU preconditioner computes an ILU(p) factorization of the interior matrix
+  * of each process, after reordering the unknowns such that all rows without ghost
+  * couplings come first and all interface rows come last. The trailing block of the
+  * factorization is then an incomplete local Schur complement of the interface
+  * unknowns, while the interior unknowns of all processes are factorized in parallel.
+  * Coupling between the processes is restored by a number of interface iterations,
+  * where the ghost contributions of the current approximation are moved to the right
+  * hand side and the local system is solved again. Without interface iterations, the
+  * preconditioner reduces to a Block-Jacobi ILU(p) preconditioner.
+  *
+  * \tparam OperatorType - can be GlobalMatrix
+  * \tparam VectorType - can be GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+    template <class OperatorType, class VectorType, typename ValueType>
+    class SchurILU : public Preconditioner<OperatorType, VectorType, ValueType>
+    {
+    public:
+        ROCALUTION_EXPORT
+        SchurILU();
+        ROCALUTION_EXPORT
+        virtual ~SchurILU();
+
+        ROCALUTION_EXPORT
+        virtual void Print(void) const;
+
+        /** \brief Initialize SchurILU(p) with level of fill-in p, see ILU */
+        ROCALUTION_EXPORT
+        void Set(int p, bool level = true);
+
+        /** \brief Set the number of interface iterations (default 1) */
+        ROCALUTION_EXPORT
+        void SetInterfaceIterations(int iter);
+
+        ROCALUTION_EXPORT
+        virtual void Solve(const VectorType& rhs, VectorType* x);
+
+        ROCALUTION_EXPORT
+        virtual void Build(void);
+        ROCALUTION_EXPORT
+        virtual void ReBuildNumeric(void);
+        ROCALUTION_EXPORT
+        virtual void Clear(void);
+
+    protected:
+        virtual void MoveToHostLocalData_(void);
+        virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+        /** \brief Solve the permuted local system with the ILU factors */
+        void LocalSolve_(const LocalVector<ValueType>& rhs, LocalVector<ValueType>* x);
+
+        LocalMatrix<ValueType> ILU_;
+        LocalVector<int>       permutation_;
+
+        LocalVector<ValueType> r_;
+        LocalVector<ValueType> z_;
+        VectorType             w_;
+
+        int  p_;
+        bool level_;
+        int  interface_iter_;
+
+        int64_t ninterface_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_PRECONDITIONER_SCHUR_ILU_HPP_
@@ -0,0 +1,104 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "solve_handle.hpp"
+#include "../utils/def.hpp"
+#include "../utils/log.hpp"
+
+namespace rocalution
+{
+
+    SolveHandle::SolveHandle()
+        : done_(true)
+        , iter_(0)
+        , res_(0.0)
+        , status_(0)
+    {
+    }
+
+    SolveHandle::~SolveHandle()
+    {
+        this->Wait();
+    }
+
+    void SolveHandle::Wait(void)
+    {
+        if(this->thread_.joinable() == true)
+        {
+            this->thread_.join();
+        }
+    }
+
+    bool SolveHandle::Test(void) const
+    {
+        return this->done_.load(std::memory_order_acquire);
+    }
+
+    int SolveHandle::GetIterationCount(void) const
+    {
+        return this->iter_.load(std::memory_order_relaxed);
+    }
+
+    double SolveHandle::GetCurrentResidual(void) const
+    {
+        return this->res_.load(std::memory_order_relaxed);
+    }
+
+    int SolveHandle::GetSolverStatus(void) const
+    {
+        return this->status_.load(std::memory_order_relaxed);
+    }
+
+    void SolveHandle::Start_(const Rocalution_Backend_Descriptor& backend,
+                             const std::function<void(void)>&     solve)
+    {
+        log_debug(this, "SolveHandle::Start_()");
+
+        // A handle serves one solve at a time
+        this->Wait();
+
+        this->Progress_(0, 0.0, 0);
+        this->done_.store(false, std::memory_order_relaxed);
+
+        this->thread_ = std::thread([this, backend, solve]() {
+            // The current device and the number of OpenMP threads are properties of the
+            // host thread
+            _rocalution_activate_backend(backend);
+
+            solve();
+
+            // Finish the accelerator work of the solve before it is reported as done
+            _rocalution_sync_backend(backend);
+
+            this->done_.store(true, std::memory_order_release);
+        });
+    }
+
+    void SolveHandle::Progress_(int iter, double res, int status)
+    {
+        this->iter_.store(iter, std::memory_order_relaxed);
+        this->res_.store(res, std::memory_order_relaxed);
+        this->status_.store(status, std::memory_order_relaxed);
+    }
+
+} // namespace rocalution
@@ -0,0 +1,124 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_SOLVE_HANDLE_HPP_
+#define ROCALUTION_SOLVE_HANDLE_HPP_
+
+#include "../base/base_rocalution.hpp"
+#include "rocalution/export.hpp"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace rocalution
+{
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    class Solver;
+    class IterationControl;
+
+    /** \ingroup solver_module
+  * \class SolveHandle
+  * \brief Handle of an asynchronous solve
+  * \details
+  * Solver::SolveAsync() runs the solve on a worker thread and returns immediately. The
+  * handle is used to wait for the solve to finish and to query its progress meanwhile.
+  * The iteration count and the residual are updated whenever the iteration control of
+  * an iterative solver checks the residual. The solver status is set when the solve
+  * has finished. The destructor waits for a running solve.
+  *
+  * \par Example
+  * \code{.cpp}
+  *   SolveHandle handle;
+  *
+  *   ls.SolveAsync(rhs, &x, &handle);
+  *
+  *   // Assemble the next system on the host
+  *   // ...
+  *
+  *   handle.Wait();
+  * \endcode
+  */
+    class SolveHandle
+    {
+    public:
+        ROCALUTION_EXPORT
+        SolveHandle();
+        ROCALUTION_EXPORT
+        ~SolveHandle();
+
+        /** \brief Block the host until the solve has finished, including its work on the
+        * accelerator */
+        ROCALUTION_EXPORT
+        void Wait(void);
+
+        /** \brief Return true if the solve has finished, does not block */
+        ROCALUTION_EXPORT
+        bool Test(void) const;
+
+        /** \brief Return the iteration count of the last checked residual */
+        ROCALUTION_EXPORT
+        int GetIterationCount(void) const;
+
+        /** \brief Return the last checked residual */
+        ROCALUTION_EXPORT
+        double GetCurrentResidual(void) const;
+
+        /** \brief Return the solver status, 0 while the solve is running; see
+        * IterativeLinearSolver::GetSolverStatus() */
+        ROCALUTION_EXPORT
+        int GetSolverStatus(void) const;
+
+    private:
+        SolveHandle(const SolveHandle&);
+        SolveHandle& operator=(const SolveHandle&);
+
+        // Run solve on a worker thread, on the device and stream of obj
+        template <typename ValueType>
+        void Start_(const BaseRocalution<ValueType>& obj, const std::function<void(void)>& solve)
+        {
+            this->Start_(obj.local_backend_, solve);
+        }
+
+        void Start_(const Rocalution_Backend_Descriptor& backend,
+                    const std::function<void(void)>& solve);
+
+        // Store the progress of the solve
+        void Progress_(int iter, double res, int status);
+
+        std::thread thread_;
+
+        std::atomic<bool>   done_;
+        std::atomic<int>    iter_;
+        std::atomic<double> res_;
+        std::atomic<int>    status_;
+
+        template <class OperatorType, class VectorType, typename ValueType>
+        friend class Solver;
+        friend class IterationControl;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_SOLVE_HANDLE_HPP_
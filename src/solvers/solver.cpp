@@ -25,16 +25,32 @@
 #include "../utils/def.hpp"
 
 #include "../base/local_matrix.hpp"
+#include "../base/local_shell_operator.hpp"
 #include "../base/local_stencil.hpp"
 #include "../base/local_vector.hpp"
 
 #include "../base/global_matrix.hpp"
 #include "../base/global_vector.hpp"
 
+#include "../base/backend_manager.hpp"
 #include "../utils/log.hpp"
 #include "../utils/math_functions.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <typeinfo>
+#include <vector>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
 
 namespace rocalution
 {
@@ -45,6 +61,11 @@ namespace rocalution
         , itsolver_max_iter_(other.itsolver_max_iter_)
         , itsolver_tol_(other.itsolver_tol_)
         , itsolver_use_tol_(other.itsolver_use_tol_)
+        , tri_auto_parallelism_(other.tri_auto_parallelism_)
+        , tri_levels_(other.tri_levels_)
+        , tri_nrow_(other.tri_nrow_)
+        , tri_auto_alg_(other.tri_auto_alg_)
+        , tri_block_size_(other.tri_block_size_)
     {
     }
 
@@ -54,10 +75,15 @@ namespace rocalution
     {
         if(this != &rhs)
         {
-            this->tri_solver_alg_    = rhs.tri_solver_alg_;
-            this->itsolver_max_iter_ = rhs.itsolver_max_iter_;
-            this->itsolver_tol_      = rhs.itsolver_tol_;
-            this->itsolver_use_tol_  = rhs.itsolver_use_tol_;
+            this->tri_solver_alg_       = rhs.tri_solver_alg_;
+            this->itsolver_max_iter_    = rhs.itsolver_max_iter_;
+            this->itsolver_tol_         = rhs.itsolver_tol_;
+            this->itsolver_use_tol_     = rhs.itsolver_use_tol_;
+            this->tri_auto_parallelism_ = rhs.tri_auto_parallelism_;
+            this->tri_levels_           = rhs.tri_levels_;
+            this->tri_nrow_             = rhs.tri_nrow_;
+            this->tri_auto_alg_         = rhs.tri_auto_alg_;
+            this->tri_block_size_       = rhs.tri_block_size_;
         }
 
         return *this;
@@ -73,6 +99,70 @@ namespace rocalution
         return this->tri_solver_alg_;
     }
 
+    TriSolverAlg SolverDescr::GetActiveTriSolverAlg() const
+    {
+        if(this->tri_solver_alg_ == TriSolverAlg_Auto)
+        {
+            return this->tri_auto_alg_;
+        }
+
+        return this->tri_solver_alg_;
+    }
+
+    void SolverDescr::SetTriSolverAutoParallelism(double min_parallelism)
+    {
+        assert(min_parallelism >= 0.0);
+
+        this->tri_auto_parallelism_ = min_parallelism;
+    }
+
+    double SolverDescr::GetTriSolverAutoParallelism() const
+    {
+        return this->tri_auto_parallelism_;
+    }
+
+    void SolverDescr::SelectTriSolverAlg(int64_t nrow, int levels)
+    {
+        assert(nrow >= 0);
+        assert(levels >= 0);
+
+        this->tri_nrow_   = nrow;
+        this->tri_levels_ = levels;
+
+        // Every level of the dependency graph is a synchronization point of the
+        // level-scheduled solver, deep graphs leave most of the device idle
+        this->tri_auto_alg_ = (this->GetTriSolverParallelism() < this->tri_auto_parallelism_)
+                                  ? TriSolverAlg_Iterative
+                                  : TriSolverAlg_Default;
+    }
+
+    int SolverDescr::GetTriSolverLevels() const
+    {
+        return this->tri_levels_;
+    }
+
+    double SolverDescr::GetTriSolverParallelism() const
+    {
+        if(this->tri_levels_ <= 0)
+        {
+            return 0.0;
+        }
+
+        return static_cast<double>(this->tri_nrow_) / this->tri_levels_;
+    }
+
+    void SolverDescr::SetTriSolverBlockSize(int block_size)
+    {
+        assert(block_size > 0);
+
+        this->tri_block_size_ = block_size;
+    }
+
+    int SolverDescr::GetTriSolverBlockSize() const
+    {
+        return this->tri_block_size_;
+    }
+
     void SolverDescr::SetIterativeSolverMaxIteration(int max_iter)
     {
         this->itsolver_max_iter_ = max_iter;
@@ -83,6 +173,17 @@ namespace rocalution
         return this->itsolver_max_iter_;
     }
 
+    int SolverDescr::GetActiveIterativeSolverMaxIteration() const
+    {
+        // Jacobi sweeps on a triangular system are exact after one sweep per level
+        if(this->tri_solver_alg_ == TriSolverAlg_Auto && this->tri_levels_ > 0)
+        {
+            return std::min(this->itsolver_max_iter_, this->tri_levels_);
+        }
+
+        return this->itsolver_max_iter_;
+    }
+
     void SolverDescr::SetIterativeSolverTolerance(double tol)
     {
         this->itsolver_tol_ = tol;
@@ -111,6 +212,23 @@ namespace rocalution
                 LOG_INFO("TriSolverAlg = iterative (" << this->itsolver_max_iter_ << ")");
             }
             break;
+        case TriSolverAlg_Auto:
+            if(this->tri_auto_alg_ == TriSolverAlg_Iterative)
+            {
+                LOG_INFO("TriSolverAlg = auto, iterative ("
+                         << this->GetActiveIterativeSolverMaxIteration() << ")");
+            }
+            else
+            {
+                LOG_INFO("TriSolverAlg = auto, level-scheduled");
+            }
+            LOG_INFO("TriSolverAlg levels = " << this->tri_levels_ << ", rows per level = "
+                                              << this->GetTriSolverParallelism());
+            break;
+        case TriSolverAlg_BlockInverse:
+            LOG_INFO("TriSolverAlg = block inverse (" << this->tri_block_size_ << ", "
+                                                      << this->itsolver_max_iter_ << ")");
+            break;
         }
     }
 
@@ -134,8 +252,9 @@ namespace rocalution
     {
         log_debug(this, "Solver::Solver()");
 
-        this->op_      = NULL;
-        this->precond_ = NULL;
+        this->op_        = NULL;
+        this->precond_   = NULL;
+        this->workspace_ = NULL;
 
         this->is_precond_  = false;
         this->is_smoother_ = false;
@@ -185,11 +304,129 @@ namespace rocalution
         this->Solve(rhs, x);
     }
 
+    // Solve the columns of a block one after another
+    template <class OperatorType, typename ValueType>
+    static void solve_columns(Solver<OperatorType, LocalVector<ValueType>, ValueType>* solver,
+                              bool                                                     zero,
+                              const LocalMultiVector<ValueType>&                       rhs,
+                              LocalMultiVector<ValueType>*                             x)
+    {
+        LocalVector<ValueType> b;
+        LocalVector<ValueType> y;
+
+        b.CloneBackend(rhs);
+        y.CloneBackend(rhs);
+
+        for(int j = 0; j < rhs.GetNcol(); ++j)
+        {
+            rhs.GetColumn(j, &b);
+
+            if(zero == true)
+            {
+                y.Allocate("y", rhs.GetNrow());
+                solver->SolveZeroSol(b, &y);
+            }
+            else
+            {
+                x->GetColumn(j, &y);
+                solver->Solve(b, &y);
+            }
+
+            x->SetColumn(j, y);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    static void solve_columns(Solver<OperatorType, VectorType, ValueType>* solver,
+                              bool                                         zero,
+                              const LocalMultiVector<ValueType>&           rhs,
+                              LocalMultiVector<ValueType>*                 x)
+    {
+        LOG_INFO("Multi-vector solves are only available for local vectors");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Solver<OperatorType, VectorType, ValueType>::SolveMulti(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "Solver::SolveMulti()", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(rhs.GetNcol() == x->GetNcol());
+
+        solve_columns(this, false, rhs, x);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Solver<OperatorType, VectorType, ValueType>::SolveMultiZeroSol(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "Solver::SolveMultiZeroSol()", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(rhs.GetNcol() == x->GetNcol());
+
+        solve_columns(this, true, rhs, x);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Solver<OperatorType, VectorType, ValueType>::SolveAsync(const VectorType& rhs,
+                                                                 VectorType*       x,
+                                                                 SolveHandle*      handle)
+    {
+        log_debug(this, "Solver::SolveAsync()", (const void*&)rhs, x, handle);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(handle != NULL);
+        assert(this->op_ != NULL);
+        assert(this->build_ == true);
+
+        handle->Start_(*x, [this, &rhs, x, handle]() {
+            this->SetSolveHandle_(handle);
+            this->Solve(rhs, x);
+            this->SetSolveHandle_(NULL);
+        });
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Solver<OperatorType, VectorType, ValueType>::SetSolveHandle_(SolveHandle* handle)
+    {
+        // Only iterative solvers report their progress
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Solver<OperatorType, VectorType, ValueType>::PrecondSolveZeroSol_(const VectorType& rhs,
+                                                                           VectorType*       x)
+    {
+        assert(this->precond_ != NULL);
+
+        RocalutionTimeScope time_scope(TimePreconditioner);
+
+        this->precond_->SolveZeroSol(rhs, x);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Solver<OperatorType, VectorType, ValueType>::PrecondSolve_(const VectorType& rhs,
+                                                                    VectorType*       x)
+    {
+        assert(this->precond_ != NULL);
+
+        RocalutionTimeScope time_scope(TimePreconditioner);
+
+        this->precond_->Solve(rhs, x);
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void Solver<OperatorType, VectorType, ValueType>::Build(void)
     {
         log_debug(this, "Solver::Build()");
 
+        ROCALUTION_RANGE("Solver::Build()");
+
         // by default - nothing to build
 
         if(this->build_ == true)
@@ -289,6 +526,28 @@ namespace rocalution
         this->verb_ = verb;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    bool Solver<OperatorType, VectorType, ValueType>::SupportsGraphCapture(void) const
+    {
+        return false;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Solver<OperatorType, VectorType, ValueType>::SetWorkspace(
+        SolverWorkspace<VectorType, ValueType>& workspace)
+    {
+        log_debug(this, "Solver::SetWorkspace()", (const void*&)workspace);
+
+        assert(this->build_ == false);
+
+        this->workspace_ = &workspace;
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SetWorkspace(workspace);
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void Solver<OperatorType, VectorType, ValueType>::SetSolverDescriptor(const SolverDescr& descr)
     {
@@ -300,6 +559,229 @@ namespace rocalution
         this->solver_descr_ = descr;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    const SolverDescr& Solver<OperatorType, VectorType, ValueType>::GetSolverDescriptor(void) const
+    {
+        return this->solver_descr_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void Solver<OperatorType, VectorType, ValueType>::EstimateSpectrum_(int        steps,
+                                                                        ValueType* lambda_min,
+                                                                        ValueType* lambda_max)
+    {
+        log_debug(this, "Solver::EstimateSpectrum_()", steps);
+
+        assert(steps > 0);
+        assert(lambda_min != NULL);
+        assert(lambda_max != NULL);
+        assert(this->op_ != NULL);
+
+        const OperatorType* op = this->op_;
+
+        VectorType r;
+        VectorType z;
+        VectorType p;
+        VectorType q;
+
+        r.CloneBackend(*op);
+        p.CloneBackend(*op);
+        q.CloneBackend(*op);
+
+        r.Allocate("r", op->GetM());
+        p.Allocate("p", op->GetM());
+        q.Allocate("q", op->GetM());
+
+        bool precond = (this->precond_ != NULL) && (this->precond_->build_ == true);
+
+        if(precond == true)
+        {
+            z.CloneBackend(*op);
+            z.Allocate("z", op->GetM());
+        }
+
+        VectorType* zp = (precond == true) ? &z : &r;
+
+        // CG with x = 0 on a random right-hand side, i.e. r = b
+        r.SetRandomUniform(12345ULL);
+
+        if(precond == true)
+        {
+            this->PrecondSolveZeroSol_(r, &z);
+        }
+
+        p.CopyFrom(*zp);
+
+        double rho = rocalution_double(r.Dot(*zp));
+
+        std::vector<double> diag;
+        std::vector<double> offdiag;
+
+        double alpha_old = 0.0;
+        double beta_old  = 0.0;
+
+        for(int j = 0; j < steps && rho > 0.0; ++j)
+        {
+            op->Apply(p, &q);
+
+            double pq = rocalution_double(p.Dot(q));
+
+            if(pq <= 0.0)
+            {
+                break;
+            }
+
+            double alpha = rho / pq;
+
+            // Lanczos coefficients from the CG coefficients
+            if(j > 0)
+            {
+                offdiag.push_back(std::sqrt(beta_old) / alpha_old);
+            }
+
+            diag.push_back(1.0 / alpha + ((j > 0) ? beta_old / alpha_old : 0.0));
+
+            r.AddScale(q, static_cast<ValueType>(-alpha));
+
+            if(precond == true)
+            {
+                this->PrecondSolveZeroSol_(r, &z);
+            }
+
+            double rho_new = rocalution_double(r.Dot(*zp));
+            double beta    = rho_new / rho;
+
+            p.ScaleAdd(static_cast<ValueType>(beta), *zp);
+
+            rho       = rho_new;
+            alpha_old = alpha;
+            beta_old  = beta;
+        }
+
+        if(diag.size() == 0)
+        {
+            LOG_INFO("Solver::EstimateSpectrum_() failed, operator is not positive definite");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        int    nsteps = static_cast<int>(diag.size());
+        double lmin;
+        double lmax;
+
+        rocalution_tridiagonal_eigenvalues(nsteps, diag.data(), offdiag.data(), &lmin, &lmax);
+
+        *lambda_min = static_cast<ValueType>(lmin);
+        *lambda_max = static_cast<ValueType>(lmax);
+
+        log_debug(this, "Solver::EstimateSpectrum_()", nsteps, lmin, lmax);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    std::string Solver<OperatorType, VectorType, ValueType>::LogName_(void) const
+    {
+        std::string name = typeid(*this).name();
+
+#ifdef __GNUG__
+        int   status;
+        char* demangled = abi::__cxa_demangle(name.c_str(), NULL, NULL, &status);
+
+        if(status == 0)
+        {
+            name = demangled;
+        }
+
+        free(demangled);
+#endif
+
+        // Strip template arguments and namespace
+        name = name.substr(0, name.find('<'));
+
+        size_t pos = name.rfind("::");
+
+        if(pos != std::string::npos)
+        {
+            name = name.substr(pos + 2);
+        }
+
+        return name;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    std::string Solver<OperatorType, VectorType, ValueType>::LogTree(void) const
+    {
+        std::ostringstream tree;
+
+        tree << "{\"name\": \"" << this->LogName_() << "\"";
+
+        if(this->op_ != NULL)
+        {
+            tree << ", \"m\": " << this->op_->GetM() << ", \"n\": " << this->op_->GetN()
+                 << ", \"nnz\": " << this->op_->GetNnz();
+        }
+
+        if(this->precond_ != NULL)
+        {
+            tree << ", \"precond\": " << this->precond_->LogTree();
+        }
+
+        tree << "}";
+
+        return tree.str();
+    }
+
+    // Part of a solver vector that is checkpointed by this process
+    template <typename ValueType>
+    static const LocalVector<ValueType>& checkpoint_part(const LocalVector<ValueType>& vec)
+    {
+        return vec;
+    }
+
+    template <typename ValueType>
+    static LocalVector<ValueType>& checkpoint_part(LocalVector<ValueType>& vec)
+    {
+        return vec;
+    }
+
+    template <typename ValueType>
+    static const LocalVector<ValueType>& checkpoint_part(const GlobalVector<ValueType>& vec)
+    {
+        return vec.GetInterior();
+    }
+
+    template <typename ValueType>
+    static LocalVector<ValueType>& checkpoint_part(GlobalVector<ValueType>& vec)
+    {
+        return vec.GetInterior();
+    }
+
+    // Start the transfer of src into the host vector dst
+    template <typename ValueType>
+    static void checkpoint_stage(const LocalVector<ValueType>& src, LocalVector<ValueType>* dst)
+    {
+        if(dst->GetSize() != src.GetSize())
+        {
+            dst->Clear();
+            dst->Allocate("checkpoint", src.GetSize());
+        }
+
+        dst->CopyFromAsync(src);
+    }
+
+    // Name of a checkpoint file of this process, the header file for name == NULL
+    static std::string checkpoint_filename(const std::string& prefix, int slot, const char* name)
+    {
+        std::ostringstream filename;
+
+        filename << prefix << "." << _get_backend_descriptor()->rank;
+
+        if(name != NULL)
+        {
+            filename << "." << slot << "." << name << ".bin";
+        }
+
+        return filename.str();
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     IterativeLinearSolver<OperatorType, VectorType, ValueType>::IterativeLinearSolver()
     {
@@ -309,12 +791,33 @@ namespace rocalution
 
         this->res_norm_type_ = 2;
         this->index_         = -1;
+        this->graph_replay_  = false;
+
+        this->hist_size_  = 0;
+        this->hist_count_ = 0;
+        this->hist_alg_   = InitialGuessAlg_Projection;
+        this->hist_x_     = NULL;
+        this->hist_ax_    = NULL;
+
+        this->ckpt_interval_    = 0;
+        this->ckpt_iter_        = 0;
+        this->ckpt_slot_        = 0;
+        this->ckpt_pending_     = false;
+        this->ckpt_res_         = 0.0;
+        this->ckpt_index_       = 0;
+        this->ckpt_nvec_        = 0;
+        this->ckpt_has_scalars_ = false;
+        this->ckpt_vec_         = NULL;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
     IterativeLinearSolver<OperatorType, VectorType, ValueType>::~IterativeLinearSolver()
     {
         log_debug(this, "IterativeLinearSolver::~IterativeLinearSolver()");
+
+        this->SetSolutionHistory(0, this->hist_alg_);
+
+        delete[] this->ckpt_vec_;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -325,82 +828,495 @@ namespace rocalution
     {
         log_debug(this, "IterativeLinearSolver::Init()", abs_tol, rel_tol, div_tol, max_iter);
 
-        this->iter_ctrl_.Init(abs_tol, rel_tol, div_tol, max_iter);
+        this->iter_ctrl_.Init(abs_tol, rel_tol, div_tol, max_iter);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::Init(
+        double abs_tol, double rel_tol, double div_tol, int min_iter, int max_iter)
+    {
+        log_debug(
+            this, "IterativeLinearSolver::Init()", abs_tol, rel_tol, div_tol, min_iter, max_iter);
+
+        this->iter_ctrl_.Init(abs_tol, rel_tol, div_tol, min_iter, max_iter);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::InitMinIter(int min_iter)
+    {
+        log_debug(this, "IterativeLinearSolver::InitMinIter()", min_iter);
+
+        this->iter_ctrl_.InitMinimumIterations(min_iter);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::InitMaxIter(int max_iter)
+    {
+        log_debug(this, "IterativeLinearSolver::InitMaxIter()", max_iter);
+
+        this->iter_ctrl_.InitMaximumIterations(max_iter);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::InitTol(double abs,
+                                                                             double rel,
+                                                                             double div)
+    {
+        log_debug(this, "IterativeLinearSolver::Init()", abs, rel, div);
+
+        this->iter_ctrl_.InitTolerance(abs, rel, div);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int IterativeLinearSolver<OperatorType, VectorType, ValueType>::GetIterationCount(void)
+    {
+        log_debug(this, "IterativeLinearSolver::GetIterationCount()");
+
+        return this->iter_ctrl_.GetIterationCount();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    double IterativeLinearSolver<OperatorType, VectorType, ValueType>::GetCurrentResidual(void)
+    {
+        log_debug(this, "IterativeLinearSolver::GetCurrentResidual()");
+
+        return this->iter_ctrl_.GetCurrentResidual();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int IterativeLinearSolver<OperatorType, VectorType, ValueType>::GetSolverStatus(void)
+    {
+        log_debug(this, "IterativeLinearSolver::GetSolverStatus()");
+
+        return this->iter_ctrl_.GetSolverStatus();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    int64_t IterativeLinearSolver<OperatorType, VectorType, ValueType>::GetAmaxResidualIndex(void)
+    {
+        int64_t ind = this->iter_ctrl_.GetAmaxResidualIndex();
+        log_debug(this, "IterativeLinearSolver::GetAmaxResidualIndex()", ind);
+
+        if(this->res_norm_type_ != 3)
+        {
+            LOG_INFO(
+                "Absolute maximum index of residual vector is only available when using Linf norm");
+        }
+
+        return ind;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::SetResidualCheckInterval(
+        int interval)
+    {
+        log_debug(this, "IterativeLinearSolver::SetResidualCheckInterval()", interval);
+
+        assert(interval > 0);
+
+        this->iter_ctrl_.InitCheckInterval(interval);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::InitStagnation(int    window,
+                                                                                    double rate)
+    {
+        log_debug(this, "IterativeLinearSolver::InitStagnation()", window, rate);
+
+        assert(window >= 0);
+        assert(rate > 0.0);
+
+        this->iter_ctrl_.InitStagnation(window, rate);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::SetSolutionHistory(
+        int size, InitialGuessAlg alg)
+    {
+        log_debug(this, "IterativeLinearSolver::SetSolutionHistory()", size, alg);
+
+        assert(size >= 0);
+        assert(alg == InitialGuessAlg_Extrapolation || alg == InitialGuessAlg_Projection);
+
+        this->ClearSolutionHistory();
+
+        if(this->hist_x_ != NULL)
+        {
+            delete[] this->hist_x_;
+            delete[] this->hist_ax_;
+
+            this->hist_x_  = NULL;
+            this->hist_ax_ = NULL;
+        }
+
+        this->hist_size_ = size;
+        this->hist_alg_  = alg;
+
+        if(size > 0)
+        {
+            this->hist_x_  = new VectorType*[size];
+            this->hist_ax_ = new VectorType*[size];
+
+            for(int i = 0; i < size; ++i)
+            {
+                this->hist_x_[i]  = NULL;
+                this->hist_ax_[i] = NULL;
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::ClearSolutionHistory(void)
+    {
+        log_debug(this, "IterativeLinearSolver::ClearSolutionHistory()");
+
+        for(int i = 0; i < this->hist_count_; ++i)
+        {
+            delete this->hist_x_[i];
+            delete this->hist_ax_[i];
+
+            this->hist_x_[i]  = NULL;
+            this->hist_ax_[i] = NULL;
+        }
+
+        this->hist_count_ = 0;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::InitialGuess_(
+        const VectorType& rhs, VectorType* x)
+    {
+        log_debug(this, "IterativeLinearSolver::InitialGuess_()", (const void*&)rhs, x);
+
+        assert(x != NULL);
+
+        if(this->hist_count_ == 0)
+        {
+            return;
+        }
+
+        // The history follows the solution vector to its backend
+        for(int i = 0; i < this->hist_count_; ++i)
+        {
+            this->hist_x_[i]->CloneBackend(*x);
+
+            if(this->hist_ax_[i] != NULL)
+            {
+                this->hist_ax_[i]->CloneBackend(*x);
+            }
+        }
+
+        x->Zeros();
+
+        if(this->hist_alg_ == InitialGuessAlg_Extrapolation)
+        {
+            // Lagrange extrapolation of the last m solutions to the next time step, the
+            // solution j steps back is weighted by (-1)^j binomial(m, j + 1)
+            int m = this->hist_count_;
+
+            ValueType binom = static_cast<ValueType>(m);
+
+            for(int j = 0; j < m; ++j)
+            {
+                ValueType coef = (j % 2 == 0) ? binom : -binom;
+
+                x->AddScale(*this->hist_x_[m - 1 - j], coef);
+
+                binom = binom * static_cast<ValueType>(m - j - 1) / static_cast<ValueType>(j + 2);
+            }
+        }
+        else
+        {
+            // The images of the history are orthonormal, the minimal residual guess is
+            // x = sum_i (A x_i)^H rhs x_i
+            for(int i = 0; i < this->hist_count_; ++i)
+            {
+                x->AddScale(*this->hist_x_[i], this->hist_ax_[i]->Dot(rhs));
+            }
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::UpdateHistory_(
+        const VectorType& x)
+    {
+        log_debug(this, "IterativeLinearSolver::UpdateHistory_()", (const void*&)x);
+
+        VectorType* new_x  = NULL;
+        VectorType* new_ax = NULL;
+
+        // Recycle the oldest solution, if the history is full
+        if(this->hist_count_ == this->hist_size_)
+        {
+            new_x  = this->hist_x_[0];
+            new_ax = this->hist_ax_[0];
+
+            for(int i = 1; i < this->hist_count_; ++i)
+            {
+                this->hist_x_[i - 1]  = this->hist_x_[i];
+                this->hist_ax_[i - 1] = this->hist_ax_[i];
+            }
+
+            --this->hist_count_;
+
+            new_x->CloneBackend(x);
+            new_x->CopyFrom(x);
+        }
+        else
+        {
+            new_x = new VectorType;
+            new_x->CloneFrom(x);
+        }
+
+        if(this->hist_alg_ == InitialGuessAlg_Projection)
+        {
+            if(new_ax == NULL)
+            {
+                new_ax = new VectorType;
+                new_ax->CloneFrom(x);
+            }
+
+            new_ax->CloneBackend(x);
+            this->op_->Apply(*new_x, new_ax);
+
+            ValueType nrm0 = new_ax->Norm();
+
+            // A-orthogonalize against the history with modified Gram-Schmidt
+            for(int i = 0; i < this->hist_count_; ++i)
+            {
+                ValueType h = this->hist_ax_[i]->Dot(*new_ax);
+
+                new_ax->AddScale(*this->hist_ax_[i], -h);
+                new_x->AddScale(*this->hist_x_[i], -h);
+            }
+
+            ValueType nrm = new_ax->Norm();
+
+            // Skip solutions that are (numerically) contained in the history already
+            if(std::abs(nrm) <= 1e-8 * std::abs(nrm0))
+            {
+                delete new_x;
+                delete new_ax;
+
+                return;
+            }
+
+            new_x->Scale(static_cast<ValueType>(1) / nrm);
+            new_ax->Scale(static_cast<ValueType>(1) / nrm);
+        }
+
+        this->hist_x_[this->hist_count_]  = new_x;
+        this->hist_ax_[this->hist_count_] = new_ax;
+
+        ++this->hist_count_;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::SetCheckpoint(
+        const std::string& filename, int interval)
+    {
+        log_debug(this, "IterativeLinearSolver::SetCheckpoint()", filename, interval);
+
+        assert(interval >= 0);
+
+        this->ckpt_file_     = filename;
+        this->ckpt_interval_ = interval;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::Resume(
+        const std::string& filename)
+    {
+        log_debug(this, "IterativeLinearSolver::Resume()", filename);
+
+        this->resume_file_ = filename;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::Checkpoint_(
+        int                           nvec,
+        const VectorType* const*      vec,
+        const LocalVector<ValueType>* scalars,
+        int64_t                       index)
+    {
+        if(this->ckpt_interval_ == 0)
+        {
+            return;
+        }
+
+        assert(nvec > 0);
+        assert(vec != NULL);
+
+        // Write the staged checkpoint, its transfer overlapped with the last iteration
+        this->FlushCheckpoint_();
+
+        int iter = this->iter_ctrl_.GetIterationCount();
+
+        if(iter < this->ckpt_iter_ + this->ckpt_interval_)
+        {
+            return;
+        }
+
+        if(this->ckpt_nvec_ != nvec)
+        {
+            delete[] this->ckpt_vec_;
+
+            this->ckpt_vec_  = new LocalVector<ValueType>[nvec];
+            this->ckpt_nvec_ = nvec;
+        }
+
+        for(int i = 0; i < nvec; ++i)
+        {
+            checkpoint_stage(checkpoint_part(*vec[i]), &this->ckpt_vec_[i]);
+        }
+
+        this->ckpt_has_scalars_ = (scalars != NULL);
+
+        if(scalars != NULL)
+        {
+            checkpoint_stage(*scalars, &this->ckpt_scalars_);
+        }
+
+        this->ckpt_pending_ = true;
+        this->ckpt_iter_    = iter;
+        this->ckpt_res_     = this->iter_ctrl_.GetCurrentResidual();
+        this->ckpt_index_   = index;
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::FlushCheckpoint_(void)
+    {
+        if(this->ckpt_pending_ == false)
+        {
+            return;
+        }
+
+        log_debug(this, "IterativeLinearSolver::FlushCheckpoint_()");
+
+        int slot = this->ckpt_slot_;
+
+        for(int i = 0; i < this->ckpt_nvec_; ++i)
+        {
+            std::ostringstream name;
+            name << i;
+
+            this->ckpt_vec_[i].Sync();
+            this->ckpt_vec_[i].WriteFileBinary(
+                checkpoint_filename(this->ckpt_file_, slot, name.str().c_str()));
+        }
+
+        if(this->ckpt_has_scalars_ == true)
+        {
+            this->ckpt_scalars_.Sync();
+            this->ckpt_scalars_.WriteFileBinary(
+                checkpoint_filename(this->ckpt_file_, slot, "scalars"));
+        }
+
+        // The header is replaced after the data is complete, such that it always refers
+        // to a valid set of files
+        std::string header = checkpoint_filename(this->ckpt_file_, slot, NULL);
+        std::string tmp    = header + ".tmp";
+
+        std::ofstream out(tmp.c_str());
+
+        if(!out.is_open())
+        {
+            LOG_INFO("IterativeLinearSolver::FlushCheckpoint_() cannot open file " << tmp);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        out << std::setprecision(std::numeric_limits<double>::max_digits10);
+        out << this->ckpt_iter_ << " " << this->iter_ctrl_.GetInitialResidual() << " "
+            << this->ckpt_res_ << " " << slot << " " << this->ckpt_nvec_ << " "
+            << this->ckpt_has_scalars_ << " " << this->ckpt_index_ << std::endl;
+        out.close();
+
+        if(std::rename(tmp.c_str(), header.c_str()) != 0)
+        {
+            LOG_INFO("IterativeLinearSolver::FlushCheckpoint_() cannot rename file " << tmp);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        this->ckpt_slot_    = 1 - slot;
+        this->ckpt_pending_ = false;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
-    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::Init(
-        double abs_tol, double rel_tol, double div_tol, int min_iter, int max_iter)
+    bool IterativeLinearSolver<OperatorType, VectorType, ValueType>::Restore_(
+        int nvec, VectorType* const* vec, LocalVector<ValueType>* scalars, int64_t* index)
     {
-        log_debug(
-            this, "IterativeLinearSolver::Init()", abs_tol, rel_tol, div_tol, min_iter, max_iter);
+        if(this->resume_file_.empty() == true)
+        {
+            return false;
+        }
 
-        this->iter_ctrl_.Init(abs_tol, rel_tol, div_tol, min_iter, max_iter);
-    }
+        log_debug(this, "IterativeLinearSolver::Restore_()", nvec, vec, scalars, index);
 
-    template <class OperatorType, class VectorType, typename ValueType>
-    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::InitMinIter(int min_iter)
-    {
-        log_debug(this, "IterativeLinearSolver::InitMinIter()", min_iter);
+        assert(nvec > 0);
+        assert(vec != NULL);
 
-        this->iter_ctrl_.InitMinimumIterations(min_iter);
-    }
+        std::string header = checkpoint_filename(this->resume_file_, 0, NULL);
 
-    template <class OperatorType, class VectorType, typename ValueType>
-    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::InitMaxIter(int max_iter)
-    {
-        log_debug(this, "IterativeLinearSolver::InitMaxIter()", max_iter);
+        std::ifstream in(header.c_str());
 
-        this->iter_ctrl_.InitMaximumIterations(max_iter);
-    }
+        int     iter;
+        double  init_res;
+        double  res;
+        int     slot;
+        int     file_nvec;
+        bool    file_scalars;
+        int64_t file_index;
 
-    template <class OperatorType, class VectorType, typename ValueType>
-    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::InitTol(double abs,
-                                                                             double rel,
-                                                                             double div)
-    {
-        log_debug(this, "IterativeLinearSolver::Init()", abs, rel, div);
+        if(!(in >> iter >> init_res >> res >> slot >> file_nvec >> file_scalars >> file_index))
+        {
+            LOG_INFO("IterativeLinearSolver::Restore_() cannot read checkpoint " << header);
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-        this->iter_ctrl_.InitTolerance(abs, rel, div);
-    }
+        if(file_nvec != nvec || file_scalars != (scalars != NULL))
+        {
+            LOG_INFO("IterativeLinearSolver::Restore_() checkpoint " << header
+                                                                      << " of another solver");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
 
-    template <class OperatorType, class VectorType, typename ValueType>
-    int IterativeLinearSolver<OperatorType, VectorType, ValueType>::GetIterationCount(void)
-    {
-        log_debug(this, "IterativeLinearSolver::GetIterationCount()");
+        LocalVector<ValueType> data;
 
-        return this->iter_ctrl_.GetIterationCount();
-    }
+        for(int i = 0; i < nvec; ++i)
+        {
+            std::ostringstream name;
+            name << i;
 
-    template <class OperatorType, class VectorType, typename ValueType>
-    double IterativeLinearSolver<OperatorType, VectorType, ValueType>::GetCurrentResidual(void)
-    {
-        log_debug(this, "IterativeLinearSolver::GetCurrentResidual()");
+            data.ReadFileBinary(checkpoint_filename(this->resume_file_, slot, name.str().c_str()));
+            checkpoint_part(*vec[i]).CopyFrom(data);
+        }
 
-        return this->iter_ctrl_.GetCurrentResidual();
-    }
+        if(scalars != NULL)
+        {
+            data.ReadFileBinary(checkpoint_filename(this->resume_file_, slot, "scalars"));
+            scalars->CopyFrom(data);
+        }
 
-    template <class OperatorType, class VectorType, typename ValueType>
-    int IterativeLinearSolver<OperatorType, VectorType, ValueType>::GetSolverStatus(void)
-    {
-        log_debug(this, "IterativeLinearSolver::GetSolverStatus()");
+        if(index != NULL)
+        {
+            *index = file_index;
+        }
 
-        return this->iter_ctrl_.GetSolverStatus();
+        this->iter_ctrl_.InitResidual(init_res);
+        this->iter_ctrl_.InitIteration(iter, res);
+
+        this->ckpt_iter_   = iter;
+        this->resume_file_.clear();
+
+        return true;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
-    int64_t IterativeLinearSolver<OperatorType, VectorType, ValueType>::GetAmaxResidualIndex(void)
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::SetGraphReplay(bool onoff)
     {
-        int64_t ind = this->iter_ctrl_.GetAmaxResidualIndex();
-        log_debug(this, "IterativeLinearSolver::GetAmaxResidualIndex()", ind);
-
-        if(this->res_norm_type_ != 3)
-        {
-            LOG_INFO(
-                "Absolute maximum index of residual vector is only available when using Linf norm");
-        }
+        log_debug(this, "IterativeLinearSolver::SetGraphReplay()", onoff);
 
-        return ind;
+        this->graph_replay_ = onoff;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -468,6 +1384,77 @@ namespace rocalution
         return 0;
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    ValueType IterativeLinearSolver<OperatorType, VectorType, ValueType>::AddScaleNorm_(
+        const VectorType& x, ValueType alpha, VectorType* vec)
+    {
+        log_debug(this,
+                  "IterativeLinearSolver::AddScaleNorm_()",
+                  (const void*&)x,
+                  alpha,
+                  vec,
+                  this->res_norm_type_);
+
+        assert(vec != NULL);
+
+        // L2 norm
+        if(this->res_norm_type_ == 2)
+        {
+            return vec->AddScaleNorm(x, alpha);
+        }
+
+        vec->AddScale(x, alpha);
+
+        return this->Norm_(*vec);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    ValueType IterativeLinearSolver<OperatorType, VectorType, ValueType>::ResidualNorm_(
+        const VectorType& vec)
+    {
+        // The residual of the next iteration is not checked, skip the reduction
+        if(this->iter_ctrl_.CheckNext() == false)
+        {
+            return static_cast<ValueType>(this->iter_ctrl_.GetCurrentResidual());
+        }
+
+        return this->Norm_(vec);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    ValueType IterativeLinearSolver<OperatorType, VectorType, ValueType>::AddScaleResidualNorm_(
+        const VectorType& x, ValueType alpha, VectorType* vec)
+    {
+        assert(vec != NULL);
+
+        // The residual of the next iteration is not checked, skip the reduction
+        if(this->iter_ctrl_.CheckNext() == false)
+        {
+            vec->AddScale(x, alpha);
+
+            return static_cast<ValueType>(this->iter_ctrl_.GetCurrentResidual());
+        }
+
+        return this->AddScaleNorm_(x, alpha, vec);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::LogSolve_(
+        RocalutionLogRecord* record) const
+    {
+        assert(record != NULL);
+
+        if(record->IsActive() == false)
+        {
+            return;
+        }
+
+        record->Add("solver", this->LogTree());
+        record->Add("iter", static_cast<int64_t>(this->iter_ctrl_.GetIterationCount()));
+        record->Add("status", static_cast<int64_t>(this->iter_ctrl_.GetSolverStatus()));
+        record->Add("residual", this->iter_ctrl_.GetCurrentResidual());
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void IterativeLinearSolver<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs,
                                                                            VectorType*       x)
@@ -479,12 +1466,22 @@ namespace rocalution
         assert(this->op_ != NULL);
         assert(this->build_ == true);
 
+        RocalutionLogRecord record("solve");
+
         if(this->verb_ > 0)
         {
             this->PrintStart_();
             this->iter_ctrl_.PrintInit();
         }
 
+        // A resumed solve starts from the checkpointed solution
+        if(this->hist_size_ > 0 && this->resume_file_.empty() == true)
+        {
+            this->InitialGuess_(rhs, x);
+        }
+
+        this->ckpt_iter_ = 0;
+
         if(this->precond_ == NULL)
         {
             this->SolveNonPrecond_(rhs, x);
@@ -494,6 +1491,24 @@ namespace rocalution
             this->SolvePrecond_(rhs, x);
         }
 
+        this->iter_ctrl_.EndIterationRange();
+
+        this->FlushCheckpoint_();
+
+        if(this->resume_file_.empty() == false)
+        {
+            LOG_INFO("IterativeLinearSolver::Solve() the solver does not support Resume(), "
+                     "the solve has started from x");
+            this->resume_file_.clear();
+        }
+
+        if(this->hist_size_ > 0)
+        {
+            this->UpdateHistory_(*x);
+        }
+
+        this->LogSolve_(&record);
+
         if(this->verb_ > 0)
         {
             this->iter_ctrl_.PrintStatus();
@@ -501,6 +1516,13 @@ namespace rocalution
         }
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void IterativeLinearSolver<OperatorType, VectorType, ValueType>::SetSolveHandle_(
+        SolveHandle* handle)
+    {
+        this->iter_ctrl_.SetSolveHandle(handle);
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void IterativeLinearSolver<OperatorType, VectorType, ValueType>::SetPreconditioner(
         Solver<OperatorType, VectorType, ValueType>& precond)
@@ -511,6 +1533,11 @@ namespace rocalution
         this->precond_ = &precond;
 
         this->precond_->FlagPrecond();
+
+        if(this->workspace_ != NULL)
+        {
+            this->precond_->SetWorkspace(*this->workspace_);
+        }
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -519,6 +1546,9 @@ namespace rocalution
         log_debug(this, "FixedPoint::FixedPoint()");
 
         this->omega_ = 1.0;
+
+        this->graph_rhs_ = NULL;
+        this->graph_x_   = NULL;
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -535,6 +1565,19 @@ namespace rocalution
         log_debug(this, "FixedPoint::SetRelaxation()", omega);
 
         this->omega_ = omega;
+
+        // The relaxation parameter is part of the graph
+        this->graph_.Clear();
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FixedPoint<OperatorType, VectorType, ValueType>::SetGraphReplay(bool onoff)
+    {
+        log_debug(this, "FixedPoint::SetGraphReplay()", onoff);
+
+        IterativeLinearSolver<OperatorType, VectorType, ValueType>::SetGraphReplay(onoff);
+
+        this->graph_.Clear();
     }
 
     template <class OperatorType, class VectorType, typename ValueType>
@@ -577,6 +1620,8 @@ namespace rocalution
 
             this->iter_ctrl_.Clear();
 
+            this->graph_.Clear();
+
             if(this->precond_ != NULL)
             {
                 this->precond_->ReBuildNumeric();
@@ -604,8 +1649,13 @@ namespace rocalution
             this->x_old_.Clear();
             this->x_res_.Clear();
 
+            this->mx_old_.Clear();
+            this->mx_res_.Clear();
+
             this->iter_ctrl_.Clear();
 
+            this->graph_.Clear();
+
             this->build_ = false;
         }
     }
@@ -615,6 +1665,8 @@ namespace rocalution
     {
         log_debug(this, "FixedPoint::Build()", "#*# begin");
 
+        ROCALUTION_RANGE("FixedPoint::Build()");
+
         if(this->build_ == true)
         {
             this->Clear();
@@ -667,6 +1719,93 @@ namespace rocalution
         }
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FixedPoint<OperatorType, VectorType, ValueType>::AllocateMulti_(int ncol)
+    {
+        if(this->mx_res_.GetNcol() == ncol)
+        {
+            return;
+        }
+
+        this->mx_old_.Clear();
+        this->mx_res_.Clear();
+
+        this->mx_old_.CloneBackend(*this->op_);
+        this->mx_old_.Allocate("x_old", this->op_->GetM(), ncol);
+
+        this->mx_res_.CloneBackend(*this->op_);
+        this->mx_res_.Allocate("x_res", this->op_->GetM(), ncol);
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FixedPoint<OperatorType, VectorType, ValueType>::SolveMultiSteps_(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x, int steps)
+    {
+        const Operator<ValueType>* op = this->op_;
+
+        this->AllocateMulti_(rhs.GetNcol());
+
+        for(int iter = 0; iter < steps; ++iter)
+        {
+            // x_res = b - Ax, the operator is read once for all columns
+            op->Apply(*x, &this->mx_res_);
+            this->mx_res_.ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+            // Solve M x_old = x_res
+            this->precond_->SolveMultiZeroSol(this->mx_res_, &this->mx_old_);
+
+            // x = x + omega * x_old
+            x->AddScale(this->mx_old_, this->omega_);
+        }
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FixedPoint<OperatorType, VectorType, ValueType>::SolveMulti(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "FixedPoint::SolveMulti()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        this->SolveMultiSteps_(rhs, x, this->iter_ctrl_.GetMaximumIterations());
+
+        log_debug(this, "FixedPoint::SolveMulti()", " #*# end");
+    }
+
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FixedPoint<OperatorType, VectorType, ValueType>::SolveMultiZeroSol(
+        const LocalMultiVector<ValueType>& rhs, LocalMultiVector<ValueType>* x)
+    {
+        log_debug(this, "FixedPoint::SolveMultiZeroSol()", " #*# begin", (const void*&)rhs, x);
+
+        assert(x != NULL);
+        assert(x != &rhs);
+        assert(this->op_ != NULL);
+        assert(this->precond_ != NULL);
+        assert(this->build_ == true);
+
+        int steps = this->iter_ctrl_.GetMaximumIterations();
+
+        if(steps < 1)
+        {
+            x->Zeros();
+            return;
+        }
+
+        // x = omega * M^-1 rhs
+        this->precond_->SolveMultiZeroSol(rhs, x);
+        x->Scale(this->omega_);
+
+        // Remaining steps
+        this->SolveMultiSteps_(rhs, x, steps - 1);
+
+        log_debug(this, "FixedPoint::SolveMultiZeroSol()", " #*# end");
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void FixedPoint<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
                                                                            VectorType*       x)
@@ -710,22 +1849,14 @@ namespace rocalution
             this->x_res_.ScaleAdd(static_cast<ValueType>(-1), rhs);
 
             // Solve M x_old = x_res
-            this->precond_->SolveZeroSol(this->x_res_, &this->x_old_);
+            this->PrecondSolveZeroSol_(this->x_res_, &this->x_old_);
 
             // x = x + omega * x_old
             x->AddScale(this->x_old_, this->omega_);
 
             for(int iter = 1; iter < steps; ++iter)
             {
-                // x_res = b - Ax
-                this->op_->Apply(*x, &this->x_res_);
-                this->x_res_.ScaleAdd(static_cast<ValueType>(-1), rhs);
-
-                // Solve M x_old = x_res
-                this->precond_->SolveZeroSol(this->x_res_, &this->x_old_);
-
-                // x = x + x_old
-                x->AddScale(this->x_old_, this->omega_);
+                this->SmoothStep_(rhs, x);
             }
         }
         else
@@ -753,7 +1884,7 @@ namespace rocalution
             while(true)
             {
                 // Solve M x_old = x_res
-                this->precond_->SolveZeroSol(this->x_res_, &this->x_old_);
+                this->PrecondSolveZeroSol_(this->x_res_, &this->x_old_);
 
                 // x = x + omega * x_old
                 x->AddScale(this->x_old_, this->omega_);
@@ -771,7 +1902,7 @@ namespace rocalution
                 this->op_->Apply(*x, &this->x_res_);
                 this->x_res_.ScaleAdd(static_cast<ValueType>(-1), rhs);
 
-                res = this->Norm_(this->x_res_);
+                res = this->ResidualNorm_(this->x_res_);
 
                 if(this->iter_ctrl_.CheckResidual(std::abs(res), this->index_) == true)
                 {
@@ -814,7 +1945,7 @@ namespace rocalution
             // x^(k+1) = x^k + omega * (b - Ax^k)
 
             // Solve M x = rhs
-            this->precond_->Solve(rhs, x);
+            this->PrecondSolve_(rhs, x);
 
             // x *= omega
             x->Scale(this->omega_);
@@ -822,15 +1953,7 @@ namespace rocalution
             // Do remaining smoothing steps
             for(int iter = 1; iter < steps; ++iter)
             {
-                // x_res = rhs - Ax
-                this->op_->Apply(*x, &this->x_res_);
-                this->x_res_.ScaleAdd(static_cast<ValueType>(-1), rhs);
-
-                // Solve M x_old = x_res
-                this->precond_->SolveZeroSol(this->x_res_, &this->x_old_);
-
-                // x = x + omega * x_old
-                x->AddScale(this->x_old_, this->omega_);
+                this->SmoothStep_(rhs, x);
             }
         }
         else
@@ -853,7 +1976,7 @@ namespace rocalution
             }
 
             // Solve M x_old = rhs
-            this->precond_->Solve(rhs, x);
+            this->PrecondSolve_(rhs, x);
 
             // x *= omega
             x->Scale(this->omega_);
@@ -866,7 +1989,7 @@ namespace rocalution
                     this->op_->Apply(*x, &this->x_res_);
                     this->x_res_.ScaleAdd(static_cast<ValueType>(-1), rhs);
 
-                    res = this->Norm_(this->x_res_);
+                    res = this->ResidualNorm_(this->x_res_);
 
                     if(this->iter_ctrl_.CheckResidual(std::abs(res), this->index_) == true)
                     {
@@ -874,7 +1997,7 @@ namespace rocalution
                     }
 
                     // Solve M x_old = x_res
-                    this->precond_->SolveZeroSol(this->x_res_, &this->x_old_);
+                    this->PrecondSolveZeroSol_(this->x_res_, &this->x_old_);
 
                     // x = x + omega * x_old
                     x->AddScale(this->x_old_, this->omega_);
@@ -890,15 +2013,63 @@ namespace rocalution
         log_debug(this, "FixedPoint::SolveZeroSol_()", " #*# end");
     }
 
+    template <class OperatorType, class VectorType, typename ValueType>
+    void FixedPoint<OperatorType, VectorType, ValueType>::SmoothStep_(const VectorType& rhs,
+                                                                      VectorType*       x)
+    {
+        bool capture = false;
+
+        if(this->graph_replay_ == true)
+        {
+            // The graph holds the addresses of the vectors
+            if(this->graph_rhs_ != &rhs || this->graph_x_ != x)
+            {
+                this->graph_.Clear();
+
+                this->graph_rhs_ = &rhs;
+                this->graph_x_   = x;
+            }
+
+            if(this->graph_.Launch() == true)
+            {
+                return;
+            }
+
+            capture = this->precond_->SupportsGraphCapture() == true
+                      && this->graph_.BeginCapture(*x, *this->op_) == true;
+        }
+
+        // x_res = rhs - Ax
+        this->op_->Apply(*x, &this->x_res_);
+        this->x_res_.ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        // Solve M x_old = x_res
+        this->PrecondSolveZeroSol_(this->x_res_, &this->x_old_);
+
+        // x = x + omega * x_old
+        x->AddScale(this->x_old_, this->omega_);
+
+        // Captured work is only executed by launching the graph
+        if(capture == true)
+        {
+            this->graph_.EndCapture();
+            this->graph_.Launch();
+        }
+    }
+
     template <class OperatorType, class VectorType, typename ValueType>
     void FixedPoint<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
     {
         log_debug(this, "FixedPoint::MoveToHostLocalData_()");
 
+        this->graph_.Clear();
+
         if(this->build_ == true)
         {
             this->x_old_.MoveToHost();
             this->x_res_.MoveToHost();
+            this->mx_old_.MoveToHost();
+            this->mx_res_.MoveToHost();
         }
     }
 
@@ -907,10 +2078,14 @@ namespace rocalution
     {
         log_debug(this, "FixedPoint::MoveToAcceleratorLocalData__()");
 
+        this->graph_.Clear();
+
         if(this->build_ == true)
         {
             this->x_old_.MoveToAccelerator();
             this->x_res_.MoveToAccelerator();
+            this->mx_old_.MoveToAccelerator();
+            this->mx_res_.MoveToAccelerator();
         }
     }
 
@@ -947,6 +2122,13 @@ namespace rocalution
         assert(this->op_ != NULL);
         assert(this->build_ == true);
 
+        RocalutionLogRecord record("solve");
+
+        if(record.IsActive() == true)
+        {
+            record.Add("solver", this->LogTree());
+        }
+
         if(this->verb_ > 0)
         {
             this->PrintStart_();
@@ -1048,6 +2230,17 @@ namespace rocalution
                           std::complex<float>>;
 #endif
 
+    template class Solver<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class Solver<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class Solver<LocalShellOperator<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+    template class Solver<LocalShellOperator<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
     template class IterativeLinearSolver<LocalStencil<double>, LocalVector<double>, double>;
     template class IterativeLinearSolver<LocalStencil<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -1059,6 +2252,17 @@ namespace rocalution
                                          std::complex<float>>;
 #endif
 
+    template class IterativeLinearSolver<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class IterativeLinearSolver<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class IterativeLinearSolver<LocalShellOperator<std::complex<double>>,
+                                         LocalVector<std::complex<double>>,
+                                         std::complex<double>>;
+    template class IterativeLinearSolver<LocalShellOperator<std::complex<float>>,
+                                         LocalVector<std::complex<float>>,
+                                         std::complex<float>>;
+#endif
+
     template class FixedPoint<LocalStencil<double>, LocalVector<double>, double>;
     template class FixedPoint<LocalStencil<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -1070,6 +2274,17 @@ namespace rocalution
                               std::complex<float>>;
 #endif
 
+    template class FixedPoint<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class FixedPoint<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class FixedPoint<LocalShellOperator<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+    template class FixedPoint<LocalShellOperator<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
     template class DirectLinearSolver<LocalStencil<double>, LocalVector<double>, double>;
     template class DirectLinearSolver<LocalStencil<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -1081,4 +2296,15 @@ namespace rocalution
                                       std::complex<float>>;
 #endif
 
+    template class DirectLinearSolver<LocalShellOperator<double>, LocalVector<double>, double>;
+    template class DirectLinearSolver<LocalShellOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class DirectLinearSolver<LocalShellOperator<std::complex<double>>,
+                                      LocalVector<std::complex<double>>,
+                                      std::complex<double>>;
+    template class DirectLinearSolver<LocalShellOperator<std::complex<float>>,
+                                      LocalVector<std::complex<float>>,
+                                      std::complex<float>>;
+#endif
+
 } // namespace rocalution
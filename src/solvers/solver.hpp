@@ -25,40 +25,43 @@
 #define ROCALUTION_SOLVER_HPP_
 
 #include "../base/base_rocalution.hpp"
+#include "../base/local_multi_vector.hpp"
 #include "../base/local_vector.hpp"
 #include "iter_ctrl.hpp"
 #include "rocalution/export.hpp"
+#include "solve_handle.hpp"
+#include "workspace.hpp"
 
 // HELPER DEFINITIONS
-#define DISPATCH_OPERATOR_SOLVE_STRATEGY(descr_, op_, func_, ...) \
-    switch(descr_.GetTriSolverAlg())                              \
-    {                                                             \
-    case TriSolverAlg_Default:                                    \
-    {                                                             \
-        op_.func_(__VA_ARGS__);                                   \
-        break;                                                    \
-    }                                                             \
-    case TriSolverAlg_Iterative:                                  \
-    {                                                             \
-        op_.It##func_(descr_.GetIterativeSolverMaxIteration(),    \
-                      descr_.GetIterativeSolverTolerance(),       \
-                      descr_.GetIterativeSolverUseTolerance(),    \
-                      __VA_ARGS__);                               \
-        break;                                                    \
-    }                                                             \
+#define DISPATCH_OPERATOR_SOLVE_STRATEGY(descr_, op_, func_, ...)    \
+    switch(descr_.GetActiveTriSolverAlg())                           \
+    {                                                                \
+    case TriSolverAlg_Iterative:                                     \
+    {                                                                \
+        op_.It##func_(descr_.GetActiveIterativeSolverMaxIteration(), \
+                      descr_.GetIterativeSolverTolerance(),          \
+                      descr_.GetIterativeSolverUseTolerance(),       \
+                      __VA_ARGS__);                                  \
+        break;                                                       \
+    }                                                                \
+    default:                                                         \
+    {                                                                \
+        op_.func_(__VA_ARGS__);                                      \
+        break;                                                       \
+    }                                                                \
     }
 
 #define DISPATCH_OPERATOR_ANALYSE_STRATEGY(descr_, op_, func_, ...) \
-    switch(descr_.GetTriSolverAlg())                                \
+    switch(descr_.GetActiveTriSolverAlg())                          \
     {                                                               \
-    case TriSolverAlg_Default:                                      \
+    case TriSolverAlg_Iterative:                                    \
     {                                                               \
-        op_.func_(__VA_ARGS__);                                     \
+        op_.It##func_(__VA_ARGS__);                                 \
         break;                                                      \
     }                                                               \
-    case TriSolverAlg_Iterative:                                    \
+    default:                                                        \
     {                                                               \
-        op_.It##func_(__VA_ARGS__);                                 \
+        op_.func_(__VA_ARGS__);                                     \
         break;                                                      \
     }                                                               \
     }
@@ -71,10 +74,34 @@ namespace rocalution
      */
     typedef enum _tri_solver_alg : unsigned int
     {
-        TriSolverAlg_Default   = 0, /**< The default direct solver. */
-        TriSolverAlg_Iterative = 1, /**< Iteratively solve triangular systems. */
+        TriSolverAlg_Default      = 0, /**< The default direct solver. */
+        TriSolverAlg_Iterative    = 1, /**< Iteratively solve triangular systems. */
+        TriSolverAlg_Auto         = 2, /**< Select from the level structure of the factors. */
+        TriSolverAlg_BlockInverse = 3, /**< Apply inverted diagonal blocks (ILU and IC only). */
     } TriSolverAlg;
 
+    /*! \brief Initial guess algorithms for sequences of solves
+     *  \details
+     *  This is a list of algorithms to compute the initial guess of a solve from the
+     *  solutions of the previous solves, see IterativeLinearSolver::SetSolutionHistory().
+     */
+    typedef enum _initial_guess_alg : unsigned int
+    {
+        InitialGuessAlg_Extrapolation = 0, /**< Polynomial extrapolation in time. */
+        InitialGuessAlg_Projection    = 1, /**< Minimal residual projection onto the history. */
+    } InitialGuessAlg;
+
+    /*! \brief Orthogonalization algorithms
+     *  \details
+     *  This is a list of algorithms to orthogonalize the Krylov basis in GMRES and FGMRES
+     */
+    typedef enum _ortho_alg : unsigned int
+    {
+        OrthoAlg_MGS  = 0, /**< Modified Gram-Schmidt, one reduction per basis vector. */
+        OrthoAlg_CGS  = 1, /**< Classical Gram-Schmidt, a single reduction. */
+        OrthoAlg_CGS2 = 2, /**< Classical Gram-Schmidt with reorthogonalization, two reductions. */
+    } OrthoAlg;
+
     /** \ingroup precond_module
   * \class SolverDescr
   * \brief Descriptor class that controls the solving strategy.
@@ -103,6 +130,56 @@ namespace rocalution
         /** \brief Get triangular solver algorithm */
         ROCALUTION_EXPORT
         TriSolverAlg GetTriSolverAlg(void) const;
+        /** \brief Get the triangular solver algorithm in use
+        * \details
+        * Returns the selection of \ref TriSolverAlg_Auto, see SelectTriSolverAlg(), or
+        * the algorithm set with SetTriSolverAlg() otherwise.
+        */
+        ROCALUTION_EXPORT
+        TriSolverAlg GetActiveTriSolverAlg(void) const;
+
+        /** \brief Set the minimum parallelism of the level-scheduled solver
+        * \details
+        * \ref TriSolverAlg_Auto keeps the level-scheduled solver, if the triangular
+        * factors have at least \p min_parallelism rows per level on average, and
+        * switches to the iterative solver otherwise. Default is 1024.
+        */
+        ROCALUTION_EXPORT
+        void SetTriSolverAutoParallelism(double min_parallelism);
+        /** \brief Get the minimum parallelism of the level-scheduled solver */
+        ROCALUTION_EXPORT
+        double GetTriSolverAutoParallelism(void) const;
+
+        /** \brief Select the triangular solver from the level structure of the factors
+        * \details
+        * Records the number of levels of the dependency graph of the triangular
+        * factors with \p nrow rows, see LocalMatrix::GetTriangularLevels(). If
+        * \ref TriSolverAlg_Auto is set, the iterative solver is selected when the
+        * average number of rows per level is below GetTriSolverAutoParallelism(). Its
+        * number of sweeps is limited by the number of levels, since the Jacobi sweeps
+        * are exact after that many iterations.
+        */
+        ROCALUTION_EXPORT
+        void SelectTriSolverAlg(int64_t nrow, int levels);
+        /** \brief Get the number of levels of the triangular factors, -1 if unknown */
+        ROCALUTION_EXPORT
+        int GetTriSolverLevels(void) const;
+        /** \brief Get the average number of rows per level of the triangular factors */
+        ROCALUTION_EXPORT
+        double GetTriSolverParallelism(void) const;
+
+        /** \brief Set the block size of \ref TriSolverAlg_BlockInverse
+        * \details
+        * The triangular factors are partitioned into contiguous blocks of
+        * \p block_size rows, whose inverses are applied by SpMV, see
+        * LocalMatrix::TriangularBlockInverse(). The number of block Jacobi sweeps is
+        * set with SetIterativeSolverMaxIteration(). Default is 16.
+        */
+        ROCALUTION_EXPORT
+        void SetTriSolverBlockSize(int block_size);
+        /** \brief Get the block size of \ref TriSolverAlg_BlockInverse */
+        ROCALUTION_EXPORT
+        int GetTriSolverBlockSize(void) const;
 
         /** \brief Set maximum solver iterations */
         ROCALUTION_EXPORT
@@ -110,6 +187,9 @@ namespace rocalution
         /** \brief Get maximum solver iterations */
         ROCALUTION_EXPORT
         int GetIterativeSolverMaxIteration(void) const;
+        /** \brief Get maximum iterations of the iterative solver in use */
+        ROCALUTION_EXPORT
+        int GetActiveIterativeSolverMaxIteration(void) const;
 
         /** \brief Set solver tolerance */
         ROCALUTION_EXPORT
@@ -146,6 +226,21 @@ namespace rocalution
 
         /** \brief Use tolerance as stopping criteria */
         bool itsolver_use_tol_ = true;
+
+        /** \brief Minimum rows per level for the level-scheduled solver in auto mode */
+        double tri_auto_parallelism_ = 1024.0;
+
+        /** \brief Number of levels of the triangular factors */
+        int tri_levels_ = -1;
+
+        /** \brief Number of rows of the triangular factors */
+        int64_t tri_nrow_ = 0;
+
+        /** \brief Algorithm selected in auto mode */
+        TriSolverAlg tri_auto_alg_ = TriSolverAlg_Default;
+
+        /** \brief Rows per diagonal block in block inverse mode */
+        int tri_block_size_ = 16;
     };
 
     /** \ingroup solver_module
@@ -196,6 +291,15 @@ namespace rocalution
         /** \brief Print information about the solver */
         virtual void Print(void) const = 0;
 
+        /** \brief Return the solver tree as JSON object
+        * \details
+        * The object contains the class name of the solver, the sizes of its operator and
+        * the trees of its preconditioner and sub-solvers. It is part of the structured
+        * solve records that are written with \p ROCALUTION_LAYER=2.
+        */
+        ROCALUTION_EXPORT
+        virtual std::string LogTree(void) const;
+
         /** \brief Solve Operator x = rhs */
         virtual void Solve(const VectorType& rhs, VectorType* x) = 0;
 
@@ -203,6 +307,47 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual void SolveZeroSol(const VectorType& rhs, VectorType* x);
 
+        /** \brief Solve Operator x = rhs for all columns of a block
+        * \details
+        * The default implementation solves the columns one after another. Solvers that
+        * can process the whole block at once, such that the operator is read once per
+        * step for all right-hand sides, override this function. Only available for
+        * local vectors.
+        */
+        ROCALUTION_EXPORT
+        virtual void SolveMulti(const LocalMultiVector<ValueType>& rhs,
+                                LocalMultiVector<ValueType>*       x);
+
+        /** \brief Solve Operator x = rhs for all columns of a block, setting initial x = 0 */
+        ROCALUTION_EXPORT
+        virtual void SolveMultiZeroSol(const LocalMultiVector<ValueType>& rhs,
+                                       LocalMultiVector<ValueType>*       x);
+
+        /** \brief Solve Operator x = rhs asynchronously
+        * \details
+        * \p SolveAsync runs Solve() on a worker thread and returns immediately, such that
+        * the host can e.g. assemble the next system meanwhile. The worker thread makes the
+        * device of \p x its current device and queues the accelerator work on the stream
+        * of \p x, see ExecutionContext. \p handle is used to wait for the solve and to
+        * query its progress, see SolveHandle. If \p handle is still in use, the previous
+        * solve is waited for first.
+        *
+        * The solver, its operator, \p rhs and \p x must not be used or destroyed before
+        * the solve has finished. Solves that run concurrently must not share solvers,
+        * vectors or a SolverWorkspace, and should be attached to different execution
+        * contexts. For GlobalMatrix, the MPI library has to support calls from the worker
+        * thread (\p MPI_THREAD_SERIALIZED).
+        *
+        * @param[in]
+        * rhs       right-hand side.
+        * @param[inout]
+        * x         initial guess and solution.
+        * @param[out]
+        * handle    handle of the solve.
+        */
+        ROCALUTION_EXPORT
+        void SolveAsync(const VectorType& rhs, VectorType* x, SolveHandle* handle);
+
         /** \brief Clear (free all local data) the solver */
         ROCALUTION_EXPORT
         virtual void Clear(void);
@@ -244,6 +389,24 @@ namespace rocalution
         /** \brief Set solver descriptor */
         ROCALUTION_EXPORT
         virtual void SetSolverDescriptor(const SolverDescr& descr);
+        /** \brief Get solver descriptor, e.g. to query the level structure of the
+        * triangular factors and the algorithm selected by \ref TriSolverAlg_Auto */
+        ROCALUTION_EXPORT
+        const SolverDescr& GetSolverDescriptor(void) const;
+
+        /** \brief Return true if Solve() can be captured into a HIP graph, i.e. if it
+        * only queues work on the accelerator without synchronizing with the host */
+        ROCALUTION_EXPORT
+        virtual bool SupportsGraphCapture(void) const;
+
+        /** \brief Attach the solver to a shared workspace of temporary vectors
+        * \details
+        * The workspace is passed on to the preconditioner and, for multigrid solvers, to
+        * the smoothers and the coarse grid solver, see SolverWorkspace. It has to be set
+        * before Build().
+        */
+        ROCALUTION_EXPORT
+        virtual void SetWorkspace(SolverWorkspace<VectorType, ValueType>& workspace);
 
         /** \brief Mark this solver as being a preconditioner */
         ROCALUTION_EXPORT
@@ -278,6 +441,10 @@ namespace rocalution
         /** \brief Flag == true after building the solver (e.g. Build()) */
         bool build_;
 
+        /** \brief Pointer to the shared workspace, NULL if the solver allocates its
+        * temporaries itself */
+        SolverWorkspace<VectorType, ValueType>* workspace_;
+
         /** \brief Permutation vector (used if the solver performs permutation/re-ordering
       * techniques)
       */
@@ -295,6 +462,29 @@ namespace rocalution
         virtual void MoveToHostLocalData_(void) = 0;
         /** \brief Move all local data to the accelerator */
         virtual void MoveToAcceleratorLocalData_(void) = 0;
+
+        /** \brief Apply the preconditioner with a zero initial guess, the time spent is
+        * recorded in the solver time breakdown (see set_time_breakdown_rocalution()) */
+        void PrecondSolveZeroSol_(const VectorType& rhs, VectorType* x);
+        /** \brief Apply the preconditioner with \p x as initial guess, the time spent is
+        * recorded in the solver time breakdown */
+        void PrecondSolve_(const VectorType& rhs, VectorType* x);
+
+        /** \brief Estimate the extreme eigenvalues of the (preconditioned) operator
+        * \details
+        * Runs \p steps (preconditioned) CG iterations on a random right-hand side and
+        * returns the extreme eigenvalues of the Lanczos tridiagonal matrix assembled from
+        * the CG coefficients. The preconditioner is used if it is set and built. The
+        * operator has to be (numerically) symmetric positive definite.
+        */
+        void EstimateSpectrum_(int steps, ValueType* lambda_min, ValueType* lambda_max);
+
+        /** \brief Report the progress of the solve to \p handle, NULL detaches the
+        * current handle after reporting the final status */
+        virtual void SetSolveHandle_(SolveHandle* handle);
+
+        /** \brief Class name of the solver, without namespace and template arguments */
+        std::string LogName_(void) const;
     };
 
     /** \ingroup solver_module
@@ -340,6 +530,7 @@ namespace rocalution
   * - 2, if relative tolerance has been reached
   * - 3, if divergence tolerance has been reached
   * - 4, if maximum number of iteration has been reached
+  * - 5, if stagnation has been detected (see InitStagnation())
   *
   * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
   * \tparam VectorType - can be LocalVector or GlobalVector
@@ -387,6 +578,130 @@ namespace rocalution
         ROCALUTION_EXPORT
         void SetResidualNorm(int resnorm);
 
+        /** \brief Check the residual only every \p interval iterations
+      * \details
+      * Computing the residual norm requires a global reduction and a synchronization
+      * with the host in every iteration. With an interval larger than 1, iterative
+      * solvers skip the residual norm on all other iterations, such that consecutive
+      * iterations can be queued on the accelerator without waiting for the host. The
+      * residual is always checked at the maximum number of iterations. As a consequence,
+      * the solver may perform up to \p interval - 1 additional iterations after the
+      * stopping criteria have been met, and the residual history only contains every
+      * \p interval -th residual. Default is 1.
+      * \note Solvers that require the residual norm for the algorithm itself (e.g. GMRES)
+      * still compute it in every iteration.
+      */
+        ROCALUTION_EXPORT
+        void SetResidualCheckInterval(int interval);
+
+        /** \brief Set the stagnation criteria
+      * \details
+      * The solver stops with status 5, if the residual of an iteration is larger than
+      * \p rate times the residual of \p window iterations before, i.e. if the residual
+      * has not been reduced by at least a factor of \p rate within the last \p window
+      * iterations. This avoids spending the maximum number of iterations on a system
+      * that the solver cannot make progress on anymore, e.g. because the attainable
+      * accuracy has been reached or a restarted method stagnates. The criteria is not
+      * applied before the minimum number of iterations. A \p window of 0 disables the
+      * criteria, which is the default.
+      *
+      * @param[in]
+      * window  number of iterations over which the residual reduction is measured.
+      * @param[in]
+      * rate    required reduction of the residual within \p window iterations, e.g.
+      *         0.99.
+      */
+        ROCALUTION_EXPORT
+        void InitStagnation(int window, double rate);
+
+        /** \brief Compute the initial guess from the solutions of the previous solves
+        * \details
+        * For sequences of systems with slowly changing right-hand sides, e.g. in time
+        * stepping, the solver keeps the last \p size solutions on the backend of the
+        * solution vector and replaces the content of \p x in Solve() by a guess computed
+        * from them.
+        * - \ref InitialGuessAlg_Extrapolation extrapolates the last solutions with a
+        *   polynomial of degree \p size - 1, assuming equidistant time steps, e.g.
+        *   \f$x_{0} = 2x_{n} - x_{n-1}\f$ for \p size = 2. Sizes of 2 or 3 are
+        *   recommended.
+        * - \ref InitialGuessAlg_Projection computes the guess \f$x_{0} \in
+        *   span\{x_{n-size+1}, ..., x_{n}\}\f$ with the minimal residual
+        *   \f$\|b - Ax_{0}\|_{2}\f$. The history is kept \f$A\f$-orthonormalized, such
+        *   that the guess costs \p size dot products and vector updates, and each solve
+        *   one additional operator application to add its solution.
+        *
+        * The history is kept across ReBuildNumeric() and ResetOperator(). The guess stays
+        * valid after the operator has changed, but it is only optimal for the operator
+        * the history has been recorded with. ClearSolutionHistory() discards the history.
+        * A \p size of 0 disables the history, which is the default.
+        *
+        * @param[in]
+        * size    number of previous solutions that are kept.
+        * @param[in]
+        * alg     algorithm to compute the initial guess.
+        */
+        ROCALUTION_EXPORT
+        void SetSolutionHistory(int size, InitialGuessAlg alg = InitialGuessAlg_Projection);
+
+        /** \brief Discard the solutions of the previous solves, see SetSolutionHistory() */
+        ROCALUTION_EXPORT
+        void ClearSolutionHistory(void);
+
+        /** \brief Write checkpoints of the solver state during the solve
+        * \details
+        * Every \p interval iterations, the solution, the recurrence vectors and scalars
+        * and the iteration counter of the solve are written to files with the prefix
+        * \p filename. The state is copied to the host asynchronously and written to file
+        * while the next iteration runs on the accelerator. Two sets of files are used in
+        * turn, such that the last complete checkpoint is kept, if the process is
+        * terminated during a write. A solve can be continued from its last checkpoint
+        * with Resume(). Checkpoints are supported by CG (every \p interval iterations)
+        * and GMRES (at the first restart after \p interval iterations). In a distributed
+        * solve, each process writes its own files.
+        *
+        * @param[in]
+        * filename  prefix of the checkpoint files.
+        * @param[in]
+        * interval  number of iterations between two checkpoints, 0 disables the
+        *           checkpoints.
+        */
+        ROCALUTION_EXPORT
+        void SetCheckpoint(const std::string& filename, int interval);
+
+        /** \brief Continue the next solve from a checkpoint
+        * \details
+        * The next call to Solve() restores the state of the checkpoint with the prefix
+        * \p filename, see SetCheckpoint(), and continues the iteration from there,
+        * including the iteration counter and the initial residual for the relative
+        * tolerance. The solver must have been built for the same operator, and a
+        * distributed solve must run on the same number of processes as the checkpointed
+        * one.
+        */
+        ROCALUTION_EXPORT
+        void Resume(const std::string& filename);
+
+        /** \brief Enable/disable the replay of FixedPoint smoothing steps from a HIP graph
+      * \details
+      * A smoothing step launches several small kernels from the host, which dominates
+      * the cost of the cycles for small and medium sized problems. With graph replay,
+      * the first smoothing step is captured into a HIP graph, and all following steps
+      * are launched with a single call. The graph is captured for the given right-hand
+      * side and solution vectors and is captured again after Build(), ReBuildNumeric()
+      * or SetRelaxation(), or if other vectors are passed. Vectors must not be
+      * re-allocated while they are in use with graph replay.
+      *
+      * Graphs can only be captured from the stream of an execution context (see
+      * ExecutionContext) and if the preconditioner does not synchronize with the host
+      * (see Solver::SupportsGraphCapture()). Otherwise, and when the solver time
+      * breakdown is enabled, the steps are launched as usual.
+      *
+      * Only FixedPoint steps are captured, BaseMultiGrid forwards the setting to its
+      * smoothers. Other solvers, e.g. Krylov smoothers like CG, read their scalars back
+      * to the host within each iteration and ignore the setting. Default is off.
+      */
+        ROCALUTION_EXPORT
+        virtual void SetGraphReplay(bool onoff);
+
         /** \brief Record the residual history */
         ROCALUTION_EXPORT
         void RecordResidualHistory(void);
@@ -441,8 +756,91 @@ namespace rocalution
         /** \brief Absolute maximum index of residual vector when using \f$L_\infty\f$ */
         int64_t index_;
 
+        /** \brief Flag whether smoothing steps are replayed from a graph */
+        bool graph_replay_;
+
+        /** \brief Maximum number of solutions in the history */
+        int hist_size_;
+        /** \brief Number of solutions in the history */
+        int hist_count_;
+        /** \brief Initial guess algorithm of the history */
+        InitialGuessAlg hist_alg_;
+        /** \brief Previous solutions, oldest first */
+        VectorType** hist_x_;
+        /** \brief Operator applied to the previous solutions (projection only) */
+        VectorType** hist_ax_;
+
+        /** \brief Checkpoint file prefix */
+        std::string ckpt_file_;
+        /** \brief Number of iterations between two checkpoints */
+        int ckpt_interval_;
+        /** \brief Iteration of the last checkpoint */
+        int ckpt_iter_;
+        /** \brief File set of the next checkpoint */
+        int ckpt_slot_;
+        /** \brief Flag whether a checkpoint is staged and not written yet */
+        bool ckpt_pending_;
+        /** \brief Residual of the staged checkpoint */
+        double ckpt_res_;
+        /** \brief Solver specific index of the staged checkpoint */
+        int64_t ckpt_index_;
+        /** \brief Number of staged vectors */
+        int ckpt_nvec_;
+        /** \brief Flag whether scalars are staged */
+        bool ckpt_has_scalars_;
+        /** \brief Staged vectors on the host */
+        LocalVector<ValueType>* ckpt_vec_;
+        /** \brief Staged scalars on the host */
+        LocalVector<ValueType> ckpt_scalars_;
+        /** \brief Checkpoint file prefix to resume the next solve from */
+        std::string resume_file_;
+
+        /** \brief Replace x by the initial guess computed from the history */
+        void InitialGuess_(const VectorType& rhs, VectorType* x);
+        /** \brief Add the solution x to the history */
+        void UpdateHistory_(const VectorType& x);
+
+        /** \brief Stage a checkpoint of the solver state
+        * \details
+        * Called by the solvers once per iteration. Writes a previously staged
+        * checkpoint to file and, if the checkpoint interval has passed, starts the
+        * transfer of the \p nvec vectors \p vec, the \p scalars (can be NULL) and the
+        * solver specific \p index to the host.
+        */
+        void Checkpoint_(int                           nvec,
+                         const VectorType* const*      vec,
+                         const LocalVector<ValueType>* scalars,
+                         int64_t                       index);
+        /** \brief Write a staged checkpoint to file */
+        void FlushCheckpoint_(void);
+        /** \brief Restore the solver state, if the solve is resumed
+        * \details
+        * Reads the \p nvec vectors \p vec, the \p scalars (can be NULL) and the solver
+        * specific \p index (can be NULL) of the checkpoint, initializes the iteration
+        * control and returns true. Returns false, if the solve is not resumed.
+        */
+        bool Restore_(int                     nvec,
+                      VectorType* const*      vec,
+                      LocalVector<ValueType>* scalars,
+                      int64_t*                index);
+
         /** \brief Computes the vector norm */
         ValueType Norm_(const VectorType& vec);
+        /** \brief Performs vec = vec + alpha * x and computes the vector norm of the
+        * result, fused into a single pass for the L2 norm */
+        ValueType AddScaleNorm_(const VectorType& x, ValueType alpha, VectorType* vec);
+        /** \brief Computes the vector norm for the convergence check, if the residual of
+        * the next iteration is checked, and returns the current residual otherwise */
+        ValueType ResidualNorm_(const VectorType& vec);
+        /** \brief Performs vec = vec + alpha * x and computes the vector norm for the
+        * convergence check, if the residual of the next iteration is checked */
+        ValueType AddScaleResidualNorm_(const VectorType& x, ValueType alpha, VectorType* vec);
+
+        /** \brief Add the solver tree and the iteration results to a structured solve
+        * record */
+        void LogSolve_(RocalutionLogRecord* record) const;
+
+        virtual void SetSolveHandle_(SolveHandle* handle);
     };
 
     /** \ingroup solver_module
@@ -484,6 +882,9 @@ namespace rocalution
         ROCALUTION_EXPORT
         void SetRelaxation(ValueType omega);
 
+        ROCALUTION_EXPORT
+        virtual void SetGraphReplay(bool onoff);
+
         ROCALUTION_EXPORT
         virtual void Build(void);
         ROCALUTION_EXPORT
@@ -493,15 +894,47 @@ namespace rocalution
         ROCALUTION_EXPORT
         virtual void SolveZeroSol(const VectorType& rhs, VectorType* x);
 
+        /** \brief Perform the maximum number of iterations for all columns of a block
+        * \details
+        * The residuals and the preconditioner are computed for the whole block at once.
+        * There is no convergence check, which is the use case of a smoother.
+        */
+        ROCALUTION_EXPORT
+        virtual void SolveMulti(const LocalMultiVector<ValueType>& rhs,
+                                LocalMultiVector<ValueType>*       x);
+        /** \brief Perform the maximum number of iterations for all columns of a block,
+        * setting initial x = 0 */
+        ROCALUTION_EXPORT
+        virtual void SolveMultiZeroSol(const LocalMultiVector<ValueType>& rhs,
+                                       LocalMultiVector<ValueType>*       x);
+
     protected:
         /** \brief Solve Operator x = rhs, setting initial x = 0 */
         void SolveZeroSol_(const VectorType& rhs, VectorType* x);
 
+        /** \brief Allocate the block temporaries for \p ncol columns */
+        void AllocateMulti_(int ncol);
+        /** \brief Perform \p steps iterations for all columns of a block */
+        void SolveMultiSteps_(const LocalMultiVector<ValueType>& rhs,
+                              LocalMultiVector<ValueType>*       x,
+                              int                                steps);
+
+        /** \brief Perform a smoothing step, replayed from the graph if enabled */
+        void SmoothStep_(const VectorType& rhs, VectorType* x);
+
         /** \brief Relaxation parameter */
         ValueType  omega_;
         VectorType x_old_; /**< \private */
         VectorType x_res_; /**< \private */
 
+        LocalMultiVector<ValueType> mx_old_; /**< \private */
+        LocalMultiVector<ValueType> mx_res_; /**< \private */
+
+        // Graph of a smoothing step and the vectors it has been captured for
+        RocalutionGraph   graph_; /**< \private */
+        const VectorType* graph_rhs_; /**< \private */
+        const VectorType* graph_x_; /**< \private */
+
         virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
         virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
 
@@ -518,9 +951,11 @@ namespace rocalution
   * \details
   * The library provides three direct methods - LU, QR and Inversion (based on QR
   * decomposition). The user can pass a sparse matrix, internally it will be converted to
-  * dense and then the selected method will be applied. These methods are not very
-  * optimal and due to the fact that the matrix is converted to a dense format, these
-  * methods should be used only for very small matrices.
+  * dense and then the selected method will be applied. The factors are kept in dense
+  * format. On the accelerator, the factorization and the solves are performed on the
+  * device with rocSOLVER and rocBLAS, which makes these methods suitable as coarse grid
+  * solvers of a few thousand unknowns. Due to the fact that the matrix is converted to
+  * a dense format, these methods should be used only for small matrices.
   *
   * \tparam OperatorType - can be LocalMatrix
   * \tparam VectorType - can be LocalVector
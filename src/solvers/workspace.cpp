@@ -0,0 +1,148 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "workspace.hpp"
+#include "../base/global_vector.hpp"
+#include "../base/local_vector.hpp"
+#include "../utils/def.hpp"
+#include "../utils/log.hpp"
+
+#include <complex>
+
+namespace rocalution
+{
+
+    template <class VectorType, typename ValueType>
+    SolverWorkspace<VectorType, ValueType>::SolverWorkspace()
+    {
+        log_debug(this, "SolverWorkspace::SolverWorkspace()");
+    }
+
+    template <class VectorType, typename ValueType>
+    SolverWorkspace<VectorType, ValueType>::~SolverWorkspace()
+    {
+        log_debug(this, "SolverWorkspace::~SolverWorkspace()");
+
+        this->Clear();
+    }
+
+    template <class VectorType, typename ValueType>
+    void SolverWorkspace<VectorType, ValueType>::Clear(void)
+    {
+        log_debug(this, "SolverWorkspace::Clear()");
+
+        assert(this->GetNumVectorsInUse() == 0);
+
+        for(size_t i = 0; i < this->vec_.size(); ++i)
+        {
+            delete this->vec_[i];
+        }
+
+        this->vec_.clear();
+        this->used_.clear();
+    }
+
+    template <class VectorType, typename ValueType>
+    int SolverWorkspace<VectorType, ValueType>::GetNumVectors(void) const
+    {
+        return static_cast<int>(this->vec_.size());
+    }
+
+    template <class VectorType, typename ValueType>
+    int SolverWorkspace<VectorType, ValueType>::GetNumVectorsInUse(void) const
+    {
+        int nused = 0;
+
+        for(size_t i = 0; i < this->used_.size(); ++i)
+        {
+            nused += this->used_[i] ? 1 : 0;
+        }
+
+        return nused;
+    }
+
+    template <class VectorType, typename ValueType>
+    VectorType* SolverWorkspace<VectorType, ValueType>::Acquire(const Operator<ValueType>& op)
+    {
+        log_debug(this, "SolverWorkspace::Acquire()", (const void*&)op);
+
+        // Reuse a returned vector of the same size
+        for(size_t i = 0; i < this->vec_.size(); ++i)
+        {
+            if(this->used_[i] == false && this->vec_[i]->GetSize() == op.GetM()
+               && this->vec_[i]->GetLocalSize() == op.GetLocalM())
+            {
+                // Follow the operator, if it has been moved to another backend
+                this->vec_[i]->CloneBackend(op);
+                this->used_[i] = true;
+
+                return this->vec_[i];
+            }
+        }
+
+        VectorType* vec = new VectorType;
+
+        vec->CloneBackend(op);
+        vec->Allocate("workspace", op.GetM());
+
+        this->vec_.push_back(vec);
+        this->used_.push_back(true);
+
+        return vec;
+    }
+
+    template <class VectorType, typename ValueType>
+    void SolverWorkspace<VectorType, ValueType>::Release(VectorType* vec)
+    {
+        log_debug(this, "SolverWorkspace::Release()", vec);
+
+        for(size_t i = 0; i < this->vec_.size(); ++i)
+        {
+            if(this->vec_[i] == vec)
+            {
+                assert(this->used_[i] == true);
+                this->used_[i] = false;
+
+                return;
+            }
+        }
+
+        // The vector does not belong to the workspace
+        assert(false);
+    }
+
+    template class SolverWorkspace<LocalVector<double>, double>;
+    template class SolverWorkspace<LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SolverWorkspace<LocalVector<std::complex<double>>, std::complex<double>>;
+    template class SolverWorkspace<LocalVector<std::complex<float>>, std::complex<float>>;
+#endif
+
+    template class SolverWorkspace<GlobalVector<double>, double>;
+    template class SolverWorkspace<GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+    template class SolverWorkspace<GlobalVector<std::complex<double>>, std::complex<double>>;
+    template class SolverWorkspace<GlobalVector<std::complex<float>>, std::complex<float>>;
+#endif
+
+} // namespace rocalution
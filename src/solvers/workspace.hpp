@@ -0,0 +1,105 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_SOLVER_WORKSPACE_HPP_
+#define ROCALUTION_SOLVER_WORKSPACE_HPP_
+
+#include "../base/base_rocalution.hpp"
+#include "../base/operator.hpp"
+#include "rocalution/export.hpp"
+
+#include <vector>
+
+namespace rocalution
+{
+
+    /** \ingroup solver_module
+  * \class SolverWorkspace
+  * \brief Shared pool of temporary vectors for a tree of solvers
+  * \details
+  * Solvers that are attached to a workspace with Solver::SetWorkspace() do not allocate
+  * their temporary vectors in Build(). They acquire them from the workspace on demand
+  * during the solve and return them when the solve ends. The workspace allocates a
+  * vector on the first request that cannot be served by a returned vector of the same
+  * size, so the solvers of a tree share the temporaries as long as their solves do not
+  * overlap, e.g. the smoothers of a multigrid hierarchy or the inner and outer solver
+  * of a flexible Krylov method. The workspace has to outlive the attached solvers.
+  *
+  * Currently, GMRES and FGMRES acquire their Krylov basis from the workspace.
+  *
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  *
+  * \par Example
+  * \code{.cpp}
+  *   SolverWorkspace<LocalVector<double>, double> ws;
+  *
+  *   FGMRES<LocalMatrix<double>, LocalVector<double>, double> ls;
+  *   GMRES<LocalMatrix<double>, LocalVector<double>, double> p;
+  *
+  *   ls.SetOperator(mat);
+  *   ls.SetPreconditioner(p);
+  *   ls.SetWorkspace(ws);
+  *
+  *   ls.Build();
+  *   ls.Solve(rhs, &x);
+  * \endcode
+  */
+    template <class VectorType, typename ValueType>
+    class SolverWorkspace : public RocalutionObj
+    {
+    public:
+        ROCALUTION_EXPORT
+        SolverWorkspace();
+        ROCALUTION_EXPORT
+        virtual ~SolverWorkspace();
+
+        /** \brief Free all vectors of the workspace, none of them may be in use */
+        ROCALUTION_EXPORT
+        void Clear(void);
+
+        /** \brief Return the number of allocated vectors */
+        ROCALUTION_EXPORT
+        int GetNumVectors(void) const;
+        /** \brief Return the number of vectors in use */
+        ROCALUTION_EXPORT
+        int GetNumVectorsInUse(void) const;
+
+        /** \brief Acquire a temporary vector with the size and backend of operator \p op
+        * \details
+        * The content of the vector is undefined.
+        */
+        ROCALUTION_EXPORT
+        VectorType* Acquire(const Operator<ValueType>& op);
+        /** \brief Return a vector that has been acquired from the workspace */
+        ROCALUTION_EXPORT
+        void Release(VectorType* vec);
+
+    private:
+        std::vector<VectorType*> vec_;
+        std::vector<bool>        used_;
+    };
+
+} // namespace rocalution
+
+#endif // ROCALUTION_SOLVER_WORKSPACE_HPP_
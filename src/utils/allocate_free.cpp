@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -34,8 +34,41 @@
 #include <cstdlib>
 #include <cstring>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace rocalution
 {
+    // Host buffers of at least this size are written by all OpenMP threads
+    static const int64_t host_first_touch_bytes = 1 << 20;
+
+    // Call func(begin, end) for the chunk of [0, n) that each thread gets from the static
+    // OpenMP schedule of the host kernels. Pages of a freshly allocated buffer are placed
+    // on the NUMA node of the thread that touches them first, which is then the thread
+    // that works on them in the host kernels.
+    template <typename DataType, typename Func>
+    static void host_first_touch(int64_t n, Func func)
+    {
+#ifdef _OPENMP
+        if(n * static_cast<int64_t>(sizeof(DataType)) >= host_first_touch_bytes
+           && omp_get_max_threads() > 1)
+        {
+#pragma omp parallel
+            {
+                int64_t nt  = omp_get_num_threads();
+                int64_t tid = omp_get_thread_num();
+
+                func(n * tid / nt, n * (tid + 1) / nt);
+            }
+
+            return;
+        }
+#endif
+
+        func(0, n);
+    }
+
     //#define MEM_ALIGNMENT 64
     //#define LONG_PTR size_t
     //#define LONG_PTR long
@@ -94,6 +127,8 @@ namespace rocalution
             // *********************************************************
 
             assert(*ptr != NULL);
+
+            _rocalution_memory_allocate(*ptr, n * sizeof(DataType), HostMemory);
         }
 
         log_debug(0, "allocate_host()", "* end", *ptr);
@@ -120,6 +155,8 @@ namespace rocalution
             return;
         }
 
+        _rocalution_memory_free(*ptr);
+
         // *********************************************************
         // C++ style
         delete[] * ptr;
@@ -157,10 +194,9 @@ namespace rocalution
         {
             assert(ptr != NULL);
 
-            memset(ptr, 0, n * sizeof(DataType));
-
-            // for (int64_t i=0; i<n; ++i)
-            //   ptr[i] = DataType(0);
+            host_first_touch<DataType>(n, [&](int64_t begin, int64_t end) {
+                memset(ptr + begin, 0, (end - begin) * sizeof(DataType));
+            });
         }
     }
 
@@ -174,19 +210,9 @@ namespace rocalution
             assert(src != NULL);
             assert(dst != NULL);
 
-#if 0
-            _set_omp_backend_threads(this->local_backend_, this->nrow_);
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int64_t i = 0; i < n; ++i)
-            {
-                dst[i] = src[i];
-            }
-#else
-            memcpy(dst, src, sizeof(DataType) * n);
-#endif
+            host_first_touch<DataType>(n, [&](int64_t begin, int64_t end) {
+                memcpy(dst + begin, src + begin, (end - begin) * sizeof(DataType));
+            });
         }
     }
 
@@ -203,6 +229,7 @@ namespace rocalution
     template void allocate_host<char>(int64_t, char**);
 #ifdef SUPPORT_MULTINODE
     template void allocate_host<MRequest>(int64_t, MRequest**);
+    template void allocate_host<MComm>(int64_t, MComm**);
 #endif
 
 #ifndef SUPPORT_HIP
@@ -227,6 +254,7 @@ namespace rocalution
     template void free_host<char>(char**);
 #ifdef SUPPORT_MULTINODE
     template void free_host<MRequest>(MRequest**);
+    template void free_host<MComm>(MComm**);
 #endif
 
 #ifndef SUPPORT_HIP
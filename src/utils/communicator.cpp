@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -22,10 +22,14 @@
  * ************************************************************************ */
 
 #include "communicator.hpp"
+#include "../base/backend_manager.hpp"
 #include "def.hpp"
 #include "log_mpi.hpp"
+#include "trace.hpp"
 
+#include <algorithm>
 #include <complex>
+#include <vector>
 
 namespace rocalution
 {
@@ -36,10 +40,43 @@ namespace rocalution
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
 
+    // Reproducible allreduce SUM, the contributions of the ranks are gathered and added in
+    // rank order, which does not depend on the reduction algorithm of the MPI library
+    template <typename ValueType>
+    static void allreduce_ordered_sum(
+        const ValueType* local, ValueType* global, int count, MPI_Datatype type, MPI_Comm comm)
+    {
+        int nprocs;
+        MPI_Comm_size(comm, &nprocs);
+
+        std::vector<ValueType> all(static_cast<size_t>(nprocs) * count);
+
+        int status = MPI_Allgather(local, count, type, all.data(), count, type, comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+
+        for(int k = 0; k < count; ++k)
+        {
+            global[k] = all[k];
+
+            for(int p = 1; p < nprocs; ++p)
+            {
+                global[k] += all[p * count + k];
+            }
+        }
+    }
+
     // Allreduce single SUM - SYNC
     template <>
     void communication_sync_allreduce_single_sum(double* local, double* global, const void* comm)
     {
+        RocalutionTimeScope time_scope(TimeAllreduce);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            allreduce_ordered_sum(local, global, 1, MPI_DOUBLE, *(MPI_Comm*)comm);
+            return;
+        }
+
         int status = MPI_Allreduce(local, global, 1, MPI_DOUBLE, MPI_SUM, *(MPI_Comm*)comm);
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
@@ -47,6 +84,14 @@ namespace rocalution
     template <>
     void communication_sync_allreduce_single_sum(float* local, float* global, const void* comm)
     {
+        RocalutionTimeScope time_scope(TimeAllreduce);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            allreduce_ordered_sum(local, global, 1, MPI_FLOAT, *(MPI_Comm*)comm);
+            return;
+        }
+
         int status = MPI_Allreduce(local, global, 1, MPI_FLOAT, MPI_SUM, *(MPI_Comm*)comm);
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
@@ -57,6 +102,14 @@ namespace rocalution
                                                  std::complex<double>* global,
                                                  const void*           comm)
     {
+        RocalutionTimeScope time_scope(TimeAllreduce);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            allreduce_ordered_sum(local, global, 1, MPI_DOUBLE_COMPLEX, *(MPI_Comm*)comm);
+            return;
+        }
+
         int status = MPI_Allreduce(local, global, 1, MPI_DOUBLE_COMPLEX, MPI_SUM, *(MPI_Comm*)comm);
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
@@ -66,6 +119,14 @@ namespace rocalution
                                                  std::complex<float>* global,
                                                  const void*          comm)
     {
+        RocalutionTimeScope time_scope(TimeAllreduce);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            allreduce_ordered_sum(local, global, 1, MPI_COMPLEX, *(MPI_Comm*)comm);
+            return;
+        }
+
         int status = MPI_Allreduce(local, global, 1, MPI_COMPLEX, MPI_SUM, *(MPI_Comm*)comm);
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
@@ -174,6 +235,127 @@ namespace rocalution
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
 
+    // Allreduce SUM - SYNC
+    template <>
+    void communication_sync_allreduce_sum(double*     local,
+                                          double*     global,
+                                          int         count,
+                                          const void* comm)
+    {
+        RocalutionTimeScope time_scope(TimeAllreduce);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            allreduce_ordered_sum(local, global, count, MPI_DOUBLE, *(MPI_Comm*)comm);
+            return;
+        }
+
+        int status = MPI_Allreduce(local, global, count, MPI_DOUBLE, MPI_SUM, *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_sync_allreduce_sum(float*      local,
+                                          float*      global,
+                                          int         count,
+                                          const void* comm)
+    {
+        RocalutionTimeScope time_scope(TimeAllreduce);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            allreduce_ordered_sum(local, global, count, MPI_FLOAT, *(MPI_Comm*)comm);
+            return;
+        }
+
+        int status = MPI_Allreduce(local, global, count, MPI_FLOAT, MPI_SUM, *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+#ifdef SUPPORT_COMPLEX
+    template <>
+    void communication_sync_allreduce_sum(std::complex<double>* local,
+                                          std::complex<double>* global,
+                                          int                   count,
+                                          const void*           comm)
+    {
+        RocalutionTimeScope time_scope(TimeAllreduce);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            allreduce_ordered_sum(local, global, count, MPI_DOUBLE_COMPLEX, *(MPI_Comm*)comm);
+            return;
+        }
+
+        int status
+            = MPI_Allreduce(local, global, count, MPI_DOUBLE_COMPLEX, MPI_SUM, *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_sync_allreduce_sum(std::complex<float>* local,
+                                          std::complex<float>* global,
+                                          int                  count,
+                                          const void*          comm)
+    {
+        RocalutionTimeScope time_scope(TimeAllreduce);
+
+        if(_get_backend_descriptor()->reproducible_reductions == true)
+        {
+            allreduce_ordered_sum(local, global, count, MPI_COMPLEX, *(MPI_Comm*)comm);
+            return;
+        }
+
+        int status = MPI_Allreduce(local, global, count, MPI_COMPLEX, MPI_SUM, *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+#endif
+
+    // Allreduce SUM - ASYNC
+    template <>
+    void communication_async_allreduce_sum(
+        double* local, double* global, int count, const void* comm, MRequest* request)
+    {
+        int status = MPI_Iallreduce(
+            local, global, count, MPI_DOUBLE, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_async_allreduce_sum(
+        float* local, float* global, int count, const void* comm, MRequest* request)
+    {
+        int status = MPI_Iallreduce(
+            local, global, count, MPI_FLOAT, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+#ifdef SUPPORT_COMPLEX
+    template <>
+    void communication_async_allreduce_sum(std::complex<double>* local,
+                                           std::complex<double>* global,
+                                           int                   count,
+                                           const void*           comm,
+                                           MRequest*             request)
+    {
+        int status = MPI_Iallreduce(
+            local, global, count, MPI_DOUBLE_COMPLEX, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_async_allreduce_sum(std::complex<float>* local,
+                                           std::complex<float>* global,
+                                           int                  count,
+                                           const void*          comm,
+                                           MRequest*            request)
+    {
+        int status = MPI_Iallreduce(
+            local, global, count, MPI_COMPLEX, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+#endif
+
     // Allreduce single MAX - SYNC
     template <>
     void communication_sync_allreduce_single_max(double* local, double* global, const void* comm)
@@ -601,6 +783,105 @@ namespace rocalution
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
 
+    // Allgatherv - SYNC
+    template <>
+    void communication_sync_allgatherv(double*     send,
+                                       int         count,
+                                       double*     recv,
+                                       const int*  recv_count,
+                                       const int*  recv_offset,
+                                       const void* comm)
+    {
+        int status = MPI_Allgatherv(send,
+                                    count,
+                                    MPI_DOUBLE,
+                                    recv,
+                                    recv_count,
+                                    recv_offset,
+                                    MPI_DOUBLE,
+                                    *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_sync_allgatherv(float*      send,
+                                       int         count,
+                                       float*      recv,
+                                       const int*  recv_count,
+                                       const int*  recv_offset,
+                                       const void* comm)
+    {
+        int status = MPI_Allgatherv(
+            send, count, MPI_FLOAT, recv, recv_count, recv_offset, MPI_FLOAT, *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+#ifdef SUPPORT_COMPLEX
+    template <>
+    void communication_sync_allgatherv(std::complex<double>* send,
+                                       int                   count,
+                                       std::complex<double>* recv,
+                                       const int*            recv_count,
+                                       const int*            recv_offset,
+                                       const void*           comm)
+    {
+        int status = MPI_Allgatherv(send,
+                                    count,
+                                    MPI_DOUBLE_COMPLEX,
+                                    recv,
+                                    recv_count,
+                                    recv_offset,
+                                    MPI_DOUBLE_COMPLEX,
+                                    *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_sync_allgatherv(std::complex<float>* send,
+                                       int                  count,
+                                       std::complex<float>* recv,
+                                       const int*           recv_count,
+                                       const int*           recv_offset,
+                                       const void*          comm)
+    {
+        int status = MPI_Allgatherv(send,
+                                    count,
+                                    MPI_COMPLEX,
+                                    recv,
+                                    recv_count,
+                                    recv_offset,
+                                    MPI_COMPLEX,
+                                    *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+#endif
+
+    template <>
+    void communication_sync_allgatherv(int*        send,
+                                       int         count,
+                                       int*        recv,
+                                       const int*  recv_count,
+                                       const int*  recv_offset,
+                                       const void* comm)
+    {
+        int status = MPI_Allgatherv(
+            send, count, MPI_INT, recv, recv_count, recv_offset, MPI_INT, *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_sync_allgatherv(int64_t*    send,
+                                       int         count,
+                                       int64_t*    recv,
+                                       const int*  recv_count,
+                                       const int*  recv_offset,
+                                       const void* comm)
+    {
+        int status = MPI_Allgatherv(
+            send, count, MPI_INT64_T, recv, recv_count, recv_offset, MPI_INT64_T, *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
     // Receive - ASYNC
     template <>
     void communication_async_recv(
@@ -738,17 +1019,428 @@ namespace rocalution
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
 
+    // Persistent recv
+    template <>
+    void communication_persistent_recv_init(
+        double* buf, int count, int source, int tag, MRequest* request, const void* comm)
+    {
+        int status
+            = MPI_Recv_init(buf, count, MPI_DOUBLE, source, tag, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_persistent_recv_init(
+        float* buf, int count, int source, int tag, MRequest* request, const void* comm)
+    {
+        int status
+            = MPI_Recv_init(buf, count, MPI_FLOAT, source, tag, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+#ifdef SUPPORT_COMPLEX
+    template <>
+    void communication_persistent_recv_init(std::complex<double>* buf,
+                                            int                   count,
+                                            int                   source,
+                                            int                   tag,
+                                            MRequest*             request,
+                                            const void*           comm)
+    {
+        int status = MPI_Recv_init(
+            buf, count, MPI_DOUBLE_COMPLEX, source, tag, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_persistent_recv_init(std::complex<float>* buf,
+                                            int                  count,
+                                            int                  source,
+                                            int                  tag,
+                                            MRequest*            request,
+                                            const void*          comm)
+    {
+        int status
+            = MPI_Recv_init(buf, count, MPI_COMPLEX, source, tag, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+#endif
+
+    // Persistent send
+    template <>
+    void communication_persistent_send_init(
+        double* buf, int count, int dest, int tag, MRequest* request, const void* comm)
+    {
+        int status
+            = MPI_Send_init(buf, count, MPI_DOUBLE, dest, tag, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_persistent_send_init(
+        float* buf, int count, int dest, int tag, MRequest* request, const void* comm)
+    {
+        int status
+            = MPI_Send_init(buf, count, MPI_FLOAT, dest, tag, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+#ifdef SUPPORT_COMPLEX
+    template <>
+    void communication_persistent_send_init(std::complex<double>* buf,
+                                            int                   count,
+                                            int                   dest,
+                                            int                   tag,
+                                            MRequest*             request,
+                                            const void*           comm)
+    {
+        int status = MPI_Send_init(
+            buf, count, MPI_DOUBLE_COMPLEX, dest, tag, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_persistent_send_init(
+        std::complex<float>* buf, int count, int dest, int tag, MRequest* request, const void* comm)
+    {
+        int status
+            = MPI_Send_init(buf, count, MPI_COMPLEX, dest, tag, *(MPI_Comm*)comm, &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+#endif
+
+    // Neighborhood collectives
+    void communication_neighbor_comm_create(int         indegree,
+                                            const int*  sources,
+                                            int         outdegree,
+                                            const int*  destinations,
+                                            MComm*      graph,
+                                            const void* comm)
+    {
+        // Ranks are not reordered, the graph communicator keeps the ranks of comm
+        int status = MPI_Dist_graph_create_adjacent(*(MPI_Comm*)comm,
+                                                    indegree,
+                                                    sources,
+                                                    MPI_UNWEIGHTED,
+                                                    outdegree,
+                                                    destinations,
+                                                    MPI_UNWEIGHTED,
+                                                    MPI_INFO_NULL,
+                                                    0,
+                                                    &graph->comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    void communication_neighbor_comm_free(MComm* graph)
+    {
+        // Communicators cannot be freed anymore, once MPI has been finalized
+        int finalized;
+        MPI_Finalized(&finalized);
+
+        if(finalized == 1)
+        {
+            return;
+        }
+
+        int status = MPI_Comm_free(&graph->comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_async_neighbor_alltoallv(double*      send,
+                                                const int*   send_count,
+                                                const int*   send_offset,
+                                                double*      recv,
+                                                const int*   recv_count,
+                                                const int*   recv_offset,
+                                                MRequest*    request,
+                                                const MComm* graph)
+    {
+        int status = MPI_Ineighbor_alltoallv(send,
+                                             send_count,
+                                             send_offset,
+                                             MPI_DOUBLE,
+                                             recv,
+                                             recv_count,
+                                             recv_offset,
+                                             MPI_DOUBLE,
+                                             graph->comm,
+                                             &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_async_neighbor_alltoallv(float*       send,
+                                                const int*   send_count,
+                                                const int*   send_offset,
+                                                float*       recv,
+                                                const int*   recv_count,
+                                                const int*   recv_offset,
+                                                MRequest*    request,
+                                                const MComm* graph)
+    {
+        int status = MPI_Ineighbor_alltoallv(send,
+                                             send_count,
+                                             send_offset,
+                                             MPI_FLOAT,
+                                             recv,
+                                             recv_count,
+                                             recv_offset,
+                                             MPI_FLOAT,
+                                             graph->comm,
+                                             &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+#ifdef SUPPORT_COMPLEX
+    template <>
+    void communication_async_neighbor_alltoallv(std::complex<double>* send,
+                                                const int*            send_count,
+                                                const int*            send_offset,
+                                                std::complex<double>* recv,
+                                                const int*            recv_count,
+                                                const int*            recv_offset,
+                                                MRequest*             request,
+                                                const MComm*          graph)
+    {
+        int status = MPI_Ineighbor_alltoallv(send,
+                                             send_count,
+                                             send_offset,
+                                             MPI_DOUBLE_COMPLEX,
+                                             recv,
+                                             recv_count,
+                                             recv_offset,
+                                             MPI_DOUBLE_COMPLEX,
+                                             graph->comm,
+                                             &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_async_neighbor_alltoallv(std::complex<float>* send,
+                                                const int*           send_count,
+                                                const int*           send_offset,
+                                                std::complex<float>* recv,
+                                                const int*           recv_count,
+                                                const int*           recv_offset,
+                                                MRequest*            request,
+                                                const MComm*         graph)
+    {
+        int status = MPI_Ineighbor_alltoallv(send,
+                                             send_count,
+                                             send_offset,
+                                             MPI_COMPLEX,
+                                             recv,
+                                             recv_count,
+                                             recv_offset,
+                                             MPI_COMPLEX,
+                                             graph->comm,
+                                             &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+#endif
+
+    template <>
+    void communication_async_neighbor_alltoallv(int*         send,
+                                                const int*   send_count,
+                                                const int*   send_offset,
+                                                int*         recv,
+                                                const int*   recv_count,
+                                                const int*   recv_offset,
+                                                MRequest*    request,
+                                                const MComm* graph)
+    {
+        int status = MPI_Ineighbor_alltoallv(send,
+                                             send_count,
+                                             send_offset,
+                                             MPI_INT,
+                                             recv,
+                                             recv_count,
+                                             recv_offset,
+                                             MPI_INT,
+                                             graph->comm,
+                                             &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    template <>
+    void communication_async_neighbor_alltoallv(int64_t*     send,
+                                                const int*   send_count,
+                                                const int*   send_offset,
+                                                int64_t*     recv,
+                                                const int*   recv_count,
+                                                const int*   recv_offset,
+                                                MRequest*    request,
+                                                const MComm* graph)
+    {
+        int status = MPI_Ineighbor_alltoallv(send,
+                                             send_count,
+                                             send_offset,
+                                             MPI_INT64_T,
+                                             recv,
+                                             recv_count,
+                                             recv_offset,
+                                             MPI_INT64_T,
+                                             graph->comm,
+                                             &request->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    void communication_startall(int count, MRequest* requests)
+    {
+        int status = MPI_Startall(count, &requests->req);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    void communication_request_freeall(int count, MRequest* requests)
+    {
+        // Requests cannot be freed anymore, once MPI has been finalized
+        int finalized;
+        MPI_Finalized(&finalized);
+
+        if(finalized == 1)
+        {
+            return;
+        }
+
+        for(int i = 0; i < count; ++i)
+        {
+            int status = MPI_Request_free(&requests[i].req);
+            CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+        }
+    }
+
     // Synchronization
     void communication_sync(MRequest* request)
     {
+        ROCALUTION_RANGE("MPI wait");
+        RocalutionTimeScope time_scope(TimeCommunication);
+
         int status = MPI_Wait(&request->req, MPI_STATUSES_IGNORE);
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
 
     void communication_syncall(int count, MRequest* requests)
     {
+        ROCALUTION_RANGE("MPI wait");
+        RocalutionTimeScope time_scope(TimeCommunication);
+
         int status = MPI_Waitall(count, &requests->req, MPI_STATUSES_IGNORE);
         CHECK_MPI_ERROR(status, __FILE__, __LINE__);
     }
 
+    // Progress
+    bool communication_thread_multiple(void)
+    {
+        int provided;
+
+        int status = MPI_Query_thread(&provided);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+
+        return provided == MPI_THREAD_MULTIPLE;
+    }
+
+    void communication_progress(const void* comm)
+    {
+        int flag;
+
+        // Probing enters the MPI library, which advances all outstanding requests
+        int status = MPI_Iprobe(
+            MPI_ANY_SOURCE, MPI_ANY_TAG, *(MPI_Comm*)comm, &flag, MPI_STATUS_IGNORE);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    // File access
+    bool communication_file_open(const char* filename, MFile* file, const void* comm)
+    {
+        int status = MPI_File_open(
+            *(MPI_Comm*)comm, filename, MPI_MODE_RDONLY, MPI_INFO_NULL, &file->fh);
+
+        return status == MPI_SUCCESS;
+    }
+
+    void communication_file_read_at_all(
+        MFile* file, int64_t offset, int64_t size, void* buf, const void* comm)
+    {
+        // MPI counts are limited to int, read in pieces of at most 1 GB
+        const int64_t piece = 1LL << 30;
+
+        // All ranks have to take part in each collective read
+        int64_t npiece = (size + piece - 1) / piece;
+        int64_t max_npiece;
+
+        int status
+            = MPI_Allreduce(&npiece, &max_npiece, 1, MPI_INT64_T, MPI_MAX, *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+
+        for(int64_t i = 0; i < max_npiece; ++i)
+        {
+            int64_t begin = std::min(i * piece, size);
+            int64_t count = std::min(piece, size - begin);
+
+            status = MPI_File_read_at_all(file->fh,
+                                          static_cast<MPI_Offset>(offset + begin),
+                                          static_cast<char*>(buf) + begin,
+                                          static_cast<int>(count),
+                                          MPI_BYTE,
+                                          MPI_STATUS_IGNORE);
+            CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+        }
+    }
+
+    bool communication_file_create(const char* filename, MFile* file, const void* comm)
+    {
+        int status = MPI_File_open(*(MPI_Comm*)comm,
+                                   filename,
+                                   MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                   MPI_INFO_NULL,
+                                   &file->fh);
+
+        if(status != MPI_SUCCESS)
+        {
+            return false;
+        }
+
+        // Discard the content of an existing file
+        status = MPI_File_set_size(file->fh, 0);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+
+        return true;
+    }
+
+    void communication_file_write_at_all(
+        MFile* file, int64_t offset, int64_t size, const void* buf, const void* comm)
+    {
+        // MPI counts are limited to int, write in pieces of at most 1 GB
+        const int64_t piece = 1LL << 30;
+
+        // All ranks have to take part in each collective write
+        int64_t npiece = (size + piece - 1) / piece;
+        int64_t max_npiece;
+
+        int status
+            = MPI_Allreduce(&npiece, &max_npiece, 1, MPI_INT64_T, MPI_MAX, *(MPI_Comm*)comm);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+
+        for(int64_t i = 0; i < max_npiece; ++i)
+        {
+            int64_t begin = std::min(i * piece, size);
+            int64_t count = std::min(piece, size - begin);
+
+            status = MPI_File_write_at_all(file->fh,
+                                           static_cast<MPI_Offset>(offset + begin),
+                                           static_cast<const char*>(buf) + begin,
+                                           static_cast<int>(count),
+                                           MPI_BYTE,
+                                           MPI_STATUS_IGNORE);
+            CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+        }
+    }
+
+    void communication_file_close(MFile* file)
+    {
+        int status = MPI_File_close(&file->fh);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
 } // namespace rocalution
@@ -1,5 +1,5 @@
 /* ************************************************************************
- * Copyright (C) 2018-2023 Advanced Micro Devices, Inc. All rights Reserved.
+ * Copyright (C) 2018-2024 Advanced Micro Devices, Inc. All rights Reserved.
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -33,6 +33,16 @@ namespace rocalution
         MPI_Request req;
     };
 
+    struct MFile
+    {
+        MPI_File fh;
+    };
+
+    struct MComm
+    {
+        MPI_Comm comm;
+    };
+
     template <typename ValueType>
     void communication_sync_exscan(ValueType* send, ValueType* recv, int count, const void* comm);
 
@@ -47,6 +57,16 @@ namespace rocalution
                                                   const void* comm,
                                                   MRequest*   request);
 
+    template <typename ValueType>
+    void communication_sync_allreduce_sum(ValueType*  local,
+                                          ValueType*  global,
+                                          int         count,
+                                          const void* comm);
+
+    template <typename ValueType>
+    void communication_async_allreduce_sum(
+        ValueType* local, ValueType* global, int count, const void* comm, MRequest* request);
+
     template <typename ValueType>
     void communication_sync_allreduce_single_max(ValueType*  local,
                                                  ValueType*  global,
@@ -76,6 +96,14 @@ namespace rocalution
                                               MRequest*   request,
                                               const void* comm);
 
+    template <typename ValueType>
+    void communication_sync_allgatherv(ValueType*  send,
+                                       int         count,
+                                       ValueType*  recv,
+                                       const int*  recv_count,
+                                       const int*  recv_offset,
+                                       const void* comm);
+
     template <typename ValueType>
     void communication_async_recv(
         ValueType* buf, int count, int source, int tag, MRequest* request, const void* comm);
@@ -84,9 +112,57 @@ namespace rocalution
     void communication_async_send(
         ValueType* buf, int count, int dest, int tag, MRequest* request, const void* comm);
 
+    template <typename ValueType>
+    void communication_persistent_recv_init(
+        ValueType* buf, int count, int source, int tag, MRequest* request, const void* comm);
+
+    template <typename ValueType>
+    void communication_persistent_send_init(
+        ValueType* buf, int count, int dest, int tag, MRequest* request, const void* comm);
+
+    // Neighborhood collectives on a distributed graph communicator
+    void communication_neighbor_comm_create(int         indegree,
+                                            const int*  sources,
+                                            int         outdegree,
+                                            const int*  destinations,
+                                            MComm*      graph,
+                                            const void* comm);
+    void communication_neighbor_comm_free(MComm* graph);
+
+    template <typename ValueType>
+    void communication_async_neighbor_alltoallv(ValueType*   send,
+                                                const int*   send_count,
+                                                const int*   send_offset,
+                                                ValueType*   recv,
+                                                const int*   recv_count,
+                                                const int*   recv_offset,
+                                                MRequest*    request,
+                                                const MComm* graph);
+
+    void communication_startall(int count, MRequest* requests);
+    void communication_request_freeall(int count, MRequest* requests);
+
     void communication_sync(MRequest* request);
     void communication_syncall(int count, MRequest* requests);
 
+    // Return true, if MPI has been initialized with MPI_THREAD_MULTIPLE
+    bool communication_thread_multiple(void);
+    // Drive the progress engine of the MPI library, may be called from a helper thread
+    void communication_progress(const void* comm);
+
+    // Collective read-only file access, returns false on all ranks if the file cannot be opened
+    bool communication_file_open(const char* filename, MFile* file, const void* comm);
+    // Collective read of size bytes at offset, size may differ between ranks
+    void communication_file_read_at_all(
+        MFile* file, int64_t offset, int64_t size, void* buf, const void* comm);
+    // Collective write-only file access, an existing file is truncated, returns false on all
+    // ranks if the file cannot be created
+    bool communication_file_create(const char* filename, MFile* file, const void* comm);
+    // Collective write of size bytes at offset, size may differ between ranks
+    void communication_file_write_at_all(
+        MFile* file, int64_t offset, int64_t size, const void* buf, const void* comm);
+    void communication_file_close(MFile* file);
+
 } // namespace rocalution
 
 #endif // ROCALUTION_UTILS_COMMUNICATOR_HPP_
@@ -40,7 +40,11 @@ namespace rocalution
         char* str_layer_mode;
         if((str_layer_mode = getenv("ROCALUTION_LAYER")) != NULL)
         {
-            if(atoi(str_layer_mode) == 1)
+            // 1 - trace of all function calls
+            // 2 - structured (JSON lines) records of the solves
+            int mode = atoi(str_layer_mode);
+
+            if(mode == 1 || mode == 2)
             {
                 if(_get_backend_descriptor()->log_file != NULL)
                 {
@@ -50,6 +54,7 @@ namespace rocalution
                 assert(_get_backend_descriptor()->log_file == NULL);
 
                 _get_backend_descriptor()->log_file = new std::ofstream;
+                _get_backend_descriptor()->log_mode = mode;
 
                 std::ostringstream str_double;
                 str_double.precision(20);
@@ -60,8 +65,17 @@ namespace rocalution
                 rank << _get_backend_descriptor()->rank;
                 std::string rank_name = rank.str();
 
+                // Processes of different communicators may share a rank
+                std::string comm_name;
+                if(_get_backend_descriptor()->MPI_comm_id >= 0)
+                {
+                    comm_name = "comm-" + std::to_string(_get_backend_descriptor()->MPI_comm_id)
+                                + "-";
+                }
+
                 std::string str_name;
-                str_name = "rocalution-rank-" + rank_name + "-" + mid_name + ".log";
+                str_name = "rocalution-" + comm_name + "rank-" + rank_name + "-" + mid_name
+                           + (mode == 1 ? ".log" : ".jsonl");
 
                 _get_backend_descriptor()->log_file->open(str_name.c_str(),
                                                           std::ios::out | std::ios::trunc);
@@ -78,6 +92,7 @@ namespace rocalution
                 _get_backend_descriptor()->log_file->close();
                 delete _get_backend_descriptor()->log_file;
                 _get_backend_descriptor()->log_file = NULL;
+                _get_backend_descriptor()->log_mode = 0;
             }
         }
     }
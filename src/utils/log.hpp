@@ -26,6 +26,7 @@
 
 #include "../base/backend_manager.hpp"
 #include "def.hpp"
+#include "trace.hpp"
 
 #include <iostream>
 #include <sstream>
@@ -76,7 +77,7 @@ namespace rocalution
     template <typename P, typename F, typename... Ts>
     void log_debug(P ptr, F fct, Ts&... xs)
     {
-        if(_get_backend_descriptor()->log_file != NULL)
+        if(_get_backend_descriptor()->log_file != NULL && _get_backend_descriptor()->log_mode == 1)
         {
             std::string   comma_separator = ", ";
             std::ostream* os              = _get_backend_descriptor()->log_file;
@@ -122,16 +123,22 @@ namespace rocalution
 
 #ifdef LOG_MPI_RANK
 
-#define LOG_INFO(stream)                                    \
-    {                                                       \
-        if(_get_backend_descriptor()->rank == LOG_MPI_RANK) \
-            LOG_STREAM << stream << std::endl;              \
+#define LOG_INFO(stream)                                                                    \
+    {                                                                                       \
+        if(_get_backend_descriptor()->rank == LOG_MPI_RANK)                                 \
+        {                                                                                   \
+            if(_get_backend_descriptor()->MPI_comm_id >= 0)                                 \
+                LOG_STREAM << "[comm:" << _get_backend_descriptor()->MPI_comm_id << "]";    \
+            LOG_STREAM << stream << std::endl;                                              \
+        }                                                                                   \
     }
 
 #else // LOG_MPI_RANK
 
 #define LOG_INFO(stream)                                                                         \
     {                                                                                            \
+        if(_get_backend_descriptor()->MPI_comm_id >= 0)                                          \
+            LOG_STREAM << "[comm:" << _get_backend_descriptor()->MPI_comm_id << "]";             \
         LOG_STREAM << "[rank:" << _get_backend_descriptor()->rank << "]" << stream << std::endl; \
     }
 
@@ -24,9 +24,12 @@
 #include "math_functions.hpp"
 #include "def.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <math.h>
 #include <stdlib.h>
+#include <vector>
 
 namespace rocalution
 {
@@ -62,6 +65,593 @@ namespace rocalution
         return std::numeric_limits<ValueType>::epsilon();
     }
 
+    template <typename ValueType>
+    bool rocalution_cholesky(int n, ValueType* A)
+    {
+        assert(n >= 0);
+        assert(A != NULL || n == 0);
+
+        for(int j = 0; j < n; ++j)
+        {
+            // Off-diagonal entries of column j, R_ij = (A_ij - sum_k conj(R_ki) R_kj) / R_ii
+            for(int i = 0; i < j; ++i)
+            {
+                ValueType sum = A[i + j * n];
+
+                for(int k = 0; k < i; ++k)
+                {
+                    sum -= rocalution_conj(A[k + i * n]) * A[k + j * n];
+                }
+
+                A[i + j * n] = sum / A[i + i * n];
+            }
+
+            // Diagonal entry
+            ValueType sum = A[j + j * n];
+
+            for(int k = 0; k < j; ++k)
+            {
+                sum -= rocalution_conj(A[k + j * n]) * A[k + j * n];
+            }
+
+            if(!(std::real(sum)
+                 > std::abs(A[j + j * n]) * std::abs(rocalution_eps<ValueType>())))
+            {
+                return false;
+            }
+
+            A[j + j * n] = static_cast<ValueType>(std::sqrt(std::real(sum)));
+
+            // Clear the strictly lower part
+            for(int i = j + 1; i < n; ++i)
+            {
+                A[i + j * n] = static_cast<ValueType>(0);
+            }
+        }
+
+        return true;
+    }
+
+    template <typename ValueType>
+    int rocalution_cholesky_pivoted(int n, ValueType* A, int* perm, double tol)
+    {
+        assert(n >= 0);
+        assert(A != NULL || n == 0);
+        assert(perm != NULL || n == 0);
+
+        double max_diag = 0.0;
+
+        for(int i = 0; i < n; ++i)
+        {
+            perm[i]  = i;
+            max_diag = std::max(max_diag, static_cast<double>(std::real(A[i + i * n])));
+        }
+
+        int rank = 0;
+
+        for(int k = 0; k < n; ++k)
+        {
+            // Largest remaining diagonal entry of the Schur complement
+            int p = k;
+
+            for(int i = k + 1; i < n; ++i)
+            {
+                if(std::real(A[i + i * n]) > std::real(A[p + p * n]))
+                {
+                    p = i;
+                }
+            }
+
+            if(!(static_cast<double>(std::real(A[p + p * n])) > tol * max_diag))
+            {
+                break;
+            }
+
+            // Symmetric swap of row and column k and p
+            if(p != k)
+            {
+                for(int i = 0; i < n; ++i)
+                {
+                    std::swap(A[i + k * n], A[i + p * n]);
+                }
+
+                for(int j = 0; j < n; ++j)
+                {
+                    std::swap(A[k + j * n], A[p + j * n]);
+                }
+
+                std::swap(perm[k], perm[p]);
+            }
+
+            // Row k of R
+            ValueType rkk = static_cast<ValueType>(std::sqrt(std::real(A[k + k * n])));
+
+            A[k + k * n] = rkk;
+
+            for(int j = k + 1; j < n; ++j)
+            {
+                A[k + j * n] /= rkk;
+            }
+
+            // Update the Schur complement
+            for(int j = k + 1; j < n; ++j)
+            {
+                for(int i = k + 1; i < n; ++i)
+                {
+                    A[i + j * n] -= rocalution_conj(A[k + i * n]) * A[k + j * n];
+                }
+            }
+
+            ++rank;
+        }
+
+        // Clear everything except the leading rank rows of R
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = std::min(j + 1, rank); i < n; ++i)
+            {
+                A[i + j * n] = static_cast<ValueType>(0);
+            }
+        }
+
+        return rank;
+    }
+
+    // Solve R^H x = b in place for the upper triangular n x n matrix R
+    template <typename ValueType>
+    static void cholesky_forward_substitution(int n, const ValueType* R, ValueType* b)
+    {
+        for(int i = 0; i < n; ++i)
+        {
+            ValueType sum = b[i];
+
+            for(int k = 0; k < i; ++k)
+            {
+                sum -= rocalution_conj(R[k + i * n]) * b[k];
+            }
+
+            b[i] = sum / rocalution_conj(R[i + i * n]);
+        }
+    }
+
+    // Solve R x = b in place for the upper triangular n x n matrix R
+    template <typename ValueType>
+    static void cholesky_backward_substitution(int n, const ValueType* R, ValueType* b)
+    {
+        for(int i = n - 1; i >= 0; --i)
+        {
+            ValueType sum = b[i];
+
+            for(int k = i + 1; k < n; ++k)
+            {
+                sum -= R[i + k * n] * b[k];
+            }
+
+            b[i] = sum / R[i + i * n];
+        }
+    }
+
+    template <typename ValueType>
+    void rocalution_cholesky_solve(int n, int nrhs, const ValueType* R, ValueType* B)
+    {
+        assert(n >= 0);
+        assert(nrhs >= 0);
+
+        for(int r = 0; r < nrhs; ++r)
+        {
+            cholesky_forward_substitution(n, R, B + r * n);
+            cholesky_backward_substitution(n, R, B + r * n);
+        }
+    }
+
+    template <typename ValueType>
+    void rocalution_hermitian_eigensystem(int n, ValueType* A, double* w, ValueType* V)
+    {
+        assert(n >= 0);
+        assert(w != NULL || n == 0);
+        assert(V != NULL || n == 0);
+
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = 0; i < n; ++i)
+            {
+                V[i + j * n] = static_cast<ValueType>(i == j ? 1 : 0);
+            }
+        }
+
+        double norm = 0.0;
+
+        for(int i = 0; i < n * n; ++i)
+        {
+            norm += std::norm(A[i]);
+        }
+
+        double eps = std::numeric_limits<double>::epsilon();
+        double tol = eps * eps * norm;
+
+        for(int sweep = 0; sweep < 50; ++sweep)
+        {
+            double off = 0.0;
+
+            for(int j = 0; j < n; ++j)
+            {
+                for(int i = 0; i < j; ++i)
+                {
+                    off += 2.0 * std::norm(A[i + j * n]);
+                }
+            }
+
+            if(off <= tol)
+            {
+                break;
+            }
+
+            for(int p = 0; p < n - 1; ++p)
+            {
+                for(int q = p + 1; q < n; ++q)
+                {
+                    double apq = std::abs(A[p + q * n]);
+
+                    if(apq == 0.0)
+                    {
+                        continue;
+                    }
+
+                    // The phase u = A(p, q) / |A(p, q)| reduces the 2 x 2 problem to a real
+                    // symmetric one, which is diagonalized by a classical Jacobi rotation
+                    ValueType u = A[p + q * n] / static_cast<ValueType>(apq);
+
+                    double app   = std::real(A[p + p * n]);
+                    double aqq   = std::real(A[q + q * n]);
+                    double theta = (aqq - app) / (2.0 * apq);
+                    double t     = ((theta >= 0.0) ? 1.0 : -1.0)
+                               / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                    double c = 1.0 / std::sqrt(t * t + 1.0);
+
+                    ValueType cs = static_cast<ValueType>(c);
+                    ValueType sn = static_cast<ValueType>(t * c);
+                    ValueType su = sn * u;
+                    ValueType sv = sn * rocalution_conj(u);
+                    ValueType cu = cs * u;
+                    ValueType cv = cs * rocalution_conj(u);
+
+                    // Columns, A = A J and V = V J
+                    for(int i = 0; i < n; ++i)
+                    {
+                        ValueType aip = A[i + p * n];
+                        ValueType aiq = A[i + q * n];
+
+                        A[i + p * n] = cs * aip - sv * aiq;
+                        A[i + q * n] = sn * aip + cv * aiq;
+
+                        ValueType vip = V[i + p * n];
+                        ValueType viq = V[i + q * n];
+
+                        V[i + p * n] = cs * vip - sv * viq;
+                        V[i + q * n] = sn * vip + cv * viq;
+                    }
+
+                    // Rows, A = J^H A
+                    for(int j = 0; j < n; ++j)
+                    {
+                        ValueType apj = A[p + j * n];
+                        ValueType aqj = A[q + j * n];
+
+                        A[p + j * n] = cs * apj - su * aqj;
+                        A[q + j * n] = sn * apj + cu * aqj;
+                    }
+
+                    A[p + q * n] = static_cast<ValueType>(0);
+                    A[q + p * n] = static_cast<ValueType>(0);
+                }
+            }
+        }
+
+        // Sort the eigenpairs in ascending order
+        for(int j = 0; j < n; ++j)
+        {
+            w[j] = std::real(A[j + j * n]);
+        }
+
+        for(int j = 0; j < n - 1; ++j)
+        {
+            int k = j;
+
+            for(int i = j + 1; i < n; ++i)
+            {
+                if(w[i] < w[k])
+                {
+                    k = i;
+                }
+            }
+
+            if(k != j)
+            {
+                std::swap(w[j], w[k]);
+
+                for(int i = 0; i < n; ++i)
+                {
+                    std::swap(V[i + j * n], V[i + k * n]);
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    bool rocalution_hermitian_generalized_eigensystem(
+        int n, ValueType* A, ValueType* B, double* w, ValueType* V)
+    {
+        assert(n >= 0);
+        assert(A != NULL || n == 0);
+        assert(B != NULL || n == 0);
+
+        // B = R^H R
+        if(rocalution_cholesky(n, B) == false)
+        {
+            return false;
+        }
+
+        // A = R^-H A R^-1, by substituting the columns of A and of its conjugate transpose
+        for(int j = 0; j < n; ++j)
+        {
+            cholesky_forward_substitution(n, B, A + j * n);
+        }
+
+        for(int j = 0; j < n; ++j)
+        {
+            for(int i = 0; i <= j; ++i)
+            {
+                ValueType aij = A[i + j * n];
+
+                A[i + j * n] = rocalution_conj(A[j + i * n]);
+                A[j + i * n] = rocalution_conj(aij);
+            }
+        }
+
+        for(int j = 0; j < n; ++j)
+        {
+            cholesky_forward_substitution(n, B, A + j * n);
+        }
+
+        rocalution_hermitian_eigensystem(n, A, w, V);
+
+        // Eigenvectors of the original pencil, V = R^-1 V
+        for(int j = 0; j < n; ++j)
+        {
+            cholesky_backward_substitution(n, B, V + j * n);
+        }
+
+        return true;
+    }
+
+    // Number of eigenvalues of the tridiagonal matrix (d, e) that are smaller than x
+    static int tridiagonal_sturm_count(int n, const double* d, const double* e, double x)
+    {
+        int    count = 0;
+        double q     = 1.0;
+
+        for(int i = 0; i < n; ++i)
+        {
+            double e2 = (i > 0) ? e[i - 1] * e[i - 1] : 0.0;
+
+            q = d[i] - x - ((i > 0) ? e2 / q : 0.0);
+
+            if(q == 0.0)
+            {
+                q = -std::numeric_limits<double>::epsilon() * (std::abs(x) + 1.0);
+            }
+
+            if(q < 0.0)
+            {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+    void rocalution_tridiagonal_eigenvalues(
+        int n, const double* d, const double* e, double* lambda_min, double* lambda_max)
+    {
+        assert(n > 0);
+        assert(lambda_min != NULL);
+        assert(lambda_max != NULL);
+
+        // Gershgorin interval contains all eigenvalues
+        double lo = d[0];
+        double hi = d[0];
+
+        for(int i = 0; i < n; ++i)
+        {
+            double r = 0.0;
+
+            r += (i > 0) ? std::abs(e[i - 1]) : 0.0;
+            r += (i < n - 1) ? std::abs(e[i]) : 0.0;
+
+            lo = std::min(lo, d[i] - r);
+            hi = std::max(hi, d[i] + r);
+        }
+
+        double tol = std::numeric_limits<double>::epsilon() * std::max(std::abs(lo), std::abs(hi));
+
+        // Smallest eigenvalue, i.e. the first x with one eigenvalue below
+        double a = lo;
+        double b = hi;
+
+        while(b - a > tol)
+        {
+            double m = 0.5 * (a + b);
+
+            if(m <= a || m >= b)
+            {
+                break;
+            }
+
+            if(tridiagonal_sturm_count(n, d, e, m) >= 1)
+            {
+                b = m;
+            }
+            else
+            {
+                a = m;
+            }
+        }
+
+        *lambda_min = 0.5 * (a + b);
+
+        // Largest eigenvalue, i.e. the first x with all eigenvalues below
+        a = lo;
+        b = hi;
+
+        while(b - a > tol)
+        {
+            double m = 0.5 * (a + b);
+
+            if(m <= a || m >= b)
+            {
+                break;
+            }
+
+            if(tridiagonal_sturm_count(n, d, e, m) >= n)
+            {
+                b = m;
+            }
+            else
+            {
+                a = m;
+            }
+        }
+
+        *lambda_max = 0.5 * (a + b);
+    }
+
+    void rocalution_hessenberg_eigenvalues(int n, std::complex<double>* H, std::complex<double>* w)
+    {
+        assert(n >= 0);
+        assert(H != NULL || n == 0);
+        assert(w != NULL || n == 0);
+
+        typedef std::complex<double> complex;
+
+        double eps = std::numeric_limits<double>::epsilon();
+
+        // Active block H(lo:hi, lo:hi), eigenvalues are deflated from its bottom
+        int hi    = n - 1;
+        int iter  = 0;
+        int total = 0;
+
+        std::vector<double>  cs(n);
+        std::vector<complex> sn(n);
+
+        while(hi >= 0)
+        {
+            int lo = hi;
+
+            while(lo > 0)
+            {
+                double scale = std::abs(H[(lo - 1) + (lo - 1) * n]) + std::abs(H[lo + lo * n]);
+
+                if(std::abs(H[lo + (lo - 1) * n]) <= eps * scale)
+                {
+                    H[lo + (lo - 1) * n] = complex(0.0);
+                    break;
+                }
+
+                --lo;
+            }
+
+            // A single eigenvalue has converged, or the iteration is exhausted
+            if(lo == hi || total >= 100 * n)
+            {
+                w[hi] = H[hi + hi * n];
+
+                --hi;
+                iter = 0;
+
+                continue;
+            }
+
+            // Wilkinson shift from the trailing 2 x 2 block, the eigenvalue closer to its
+            // last diagonal entry, with an exceptional shift once in a while
+            complex a = H[(hi - 1) + (hi - 1) * n];
+            complex b = H[(hi - 1) + hi * n];
+            complex c = H[hi + (hi - 1) * n];
+            complex d = H[hi + hi * n];
+
+            complex mu;
+
+            if(iter > 0 && iter % 10 == 0)
+            {
+                mu = d + std::abs(c);
+            }
+            else
+            {
+                complex m    = 0.5 * (a + d);
+                complex disc = std::sqrt(0.25 * (a - d) * (a - d) + b * c);
+
+                mu = (std::abs(m + disc - d) < std::abs(m - disc - d)) ? m + disc : m - disc;
+            }
+
+            // QR step H - mu I = QR, H = RQ + mu I, by Givens rotations
+            for(int k = lo; k <= hi; ++k)
+            {
+                H[k + k * n] -= mu;
+            }
+
+            for(int k = lo; k < hi; ++k)
+            {
+                complex x   = H[k + k * n];
+                complex y   = H[(k + 1) + k * n];
+                double  rho = std::sqrt(std::norm(x) + std::norm(y));
+
+                if(rho == 0.0)
+                {
+                    cs[k] = 1.0;
+                    sn[k] = complex(0.0);
+                }
+                else if(std::abs(x) == 0.0)
+                {
+                    cs[k] = 0.0;
+                    sn[k] = complex(1.0);
+                }
+                else
+                {
+                    cs[k] = std::abs(x) / rho;
+                    sn[k] = (x / std::abs(x)) * std::conj(y) / rho;
+                }
+
+                for(int j = k; j <= hi; ++j)
+                {
+                    complex hk  = H[k + j * n];
+                    complex hk1 = H[(k + 1) + j * n];
+
+                    H[k + j * n]       = cs[k] * hk + sn[k] * hk1;
+                    H[(k + 1) + j * n] = -std::conj(sn[k]) * hk + cs[k] * hk1;
+                }
+            }
+
+            for(int k = lo; k < hi; ++k)
+            {
+                for(int i = lo; i <= k + 1; ++i)
+                {
+                    complex hk  = H[i + k * n];
+                    complex hk1 = H[i + (k + 1) * n];
+
+                    H[i + k * n]       = hk * cs[k] + hk1 * std::conj(sn[k]);
+                    H[i + (k + 1) * n] = -hk * sn[k] + hk1 * cs[k];
+                }
+            }
+
+            for(int k = lo; k <= hi; ++k)
+            {
+                H[k + k * n] += mu;
+            }
+
+            ++iter;
+            ++total;
+        }
+    }
+
     template <typename ValueType>
     bool operator<(const std::complex<ValueType>& lhs, const std::complex<ValueType>& rhs)
     {
@@ -119,6 +709,55 @@ namespace rocalution
     template std::complex<double> rocalution_eps(void);
     template std::complex<float>  rocalution_eps(void);
 
+    template bool rocalution_cholesky(int n, double* A);
+    template bool rocalution_cholesky(int n, float* A);
+    template bool rocalution_cholesky(int n, std::complex<double>* A);
+    template bool rocalution_cholesky(int n, std::complex<float>* A);
+
+    template int rocalution_cholesky_pivoted(int n, double* A, int* perm, double tol);
+    template int rocalution_cholesky_pivoted(int n, float* A, int* perm, double tol);
+    template int
+        rocalution_cholesky_pivoted(int n, std::complex<double>* A, int* perm, double tol);
+    template int
+        rocalution_cholesky_pivoted(int n, std::complex<float>* A, int* perm, double tol);
+
+    template void rocalution_cholesky_solve(int n, int nrhs, const double* R, double* B);
+    template void rocalution_cholesky_solve(int n, int nrhs, const float* R, float* B);
+    template void rocalution_cholesky_solve(int                         n,
+                                            int                         nrhs,
+                                            const std::complex<double>* R,
+                                            std::complex<double>*       B);
+    template void rocalution_cholesky_solve(int                        n,
+                                            int                        nrhs,
+                                            const std::complex<float>* R,
+                                            std::complex<float>*       B);
+
+    template void rocalution_hermitian_eigensystem(int n, double* A, double* w, double* V);
+    template void rocalution_hermitian_eigensystem(int n, float* A, double* w, float* V);
+    template void rocalution_hermitian_eigensystem(int                   n,
+                                                   std::complex<double>* A,
+                                                   double*               w,
+                                                   std::complex<double>* V);
+    template void rocalution_hermitian_eigensystem(int                  n,
+                                                   std::complex<float>* A,
+                                                   double*              w,
+                                                   std::complex<float>* V);
+
+    template bool rocalution_hermitian_generalized_eigensystem(
+        int n, double* A, double* B, double* w, double* V);
+    template bool rocalution_hermitian_generalized_eigensystem(
+        int n, float* A, float* B, double* w, float* V);
+    template bool rocalution_hermitian_generalized_eigensystem(int                   n,
+                                                               std::complex<double>* A,
+                                                               std::complex<double>* B,
+                                                               double*               w,
+                                                               std::complex<double>* V);
+    template bool rocalution_hermitian_generalized_eigensystem(int                  n,
+                                                               std::complex<float>* A,
+                                                               std::complex<float>* B,
+                                                               double*              w,
+                                                               std::complex<float>* V);
+
     template bool operator<(const std::complex<float>& lhs, const std::complex<float>& rhs);
     template bool operator<(const std::complex<double>& lhs, const std::complex<double>& rhs);
 
@@ -41,6 +41,21 @@ namespace rocalution
     /** \brief Return double value */
     double rocalution_double(const std::complex<double>& val);
 
+    /** \brief Return conjugate complex */
+    inline bool rocalution_conj(const bool& val)
+    {
+        return val;
+    }
+    /** \brief Return conjugate complex */
+    inline int rocalution_conj(const int& val)
+    {
+        return val;
+    }
+    /** \brief Return conjugate complex */
+    inline int64_t rocalution_conj(const int64_t& val)
+    {
+        return val;
+    }
     /** \brief Return conjugate complex */
     inline float rocalution_conj(const float& val)
     {
@@ -66,6 +81,59 @@ namespace rocalution
     template <typename ValueType>
     ValueType rocalution_eps(void);
 
+    /** \brief Compute the Cholesky factorization A = R^H R of a small dense (column-major)
+    * n x n matrix in place, return false if A is not numerically positive definite */
+    template <typename ValueType>
+    bool rocalution_cholesky(int n, ValueType* A);
+
+    /** \brief Compute the pivoted Cholesky factorization P^T A P = R^H R of a small dense
+    * (column-major) Hermitian positive semi-definite n x n matrix in place
+    * \details
+    * The factorization stops at the first pivot below tol times the largest diagonal
+    * entry of A. The numerical rank r is returned, the first r rows of A hold R and
+    * perm holds the pivoting order, i.e. column j of R corresponds to column perm[j] of
+    * A.
+    */
+    template <typename ValueType>
+    int rocalution_cholesky_pivoted(int n, ValueType* A, int* perm, double tol);
+
+    /** \brief Solve R^H R X = B in place for a Cholesky factor R and a (column-major)
+    * n x nrhs matrix B */
+    template <typename ValueType>
+    void rocalution_cholesky_solve(int n, int nrhs, const ValueType* R, ValueType* B);
+
+    /** \brief Compute all eigenvalues and eigenvectors of a small dense (column-major)
+    * Hermitian n x n matrix by cyclic Jacobi rotations
+    * \details
+    * A is overwritten. The eigenvalues are returned in ascending order in w, the
+    * corresponding orthonormal eigenvectors in the columns of V.
+    */
+    template <typename ValueType>
+    void rocalution_hermitian_eigensystem(int n, ValueType* A, double* w, ValueType* V);
+
+    /** \brief Compute all eigenpairs of a small dense (column-major) Hermitian definite
+    * n x n pencil A v = lambda B v
+    * \details
+    * A and B are overwritten, B holds its Cholesky factor on return. The eigenvalues are
+    * returned in ascending order in w, the corresponding B-orthonormal eigenvectors in the
+    * columns of V. Returns false if B is not numerically positive definite.
+    */
+    template <typename ValueType>
+    bool rocalution_hermitian_generalized_eigensystem(
+        int n, ValueType* A, ValueType* B, double* w, ValueType* V);
+
+    /** \brief Compute the smallest and largest eigenvalue of a small symmetric tridiagonal
+    * n x n matrix with diagonal d and off-diagonal e (n - 1 entries) by Sturm bisection */
+    void rocalution_tridiagonal_eigenvalues(
+        int n, const double* d, const double* e, double* lambda_min, double* lambda_max);
+
+    /** \brief Compute all eigenvalues of a small dense (column-major) upper Hessenberg
+    * n x n matrix by the shifted QR algorithm
+    * \details
+    * H is overwritten. The eigenvalues are returned in w in no particular order.
+    */
+    void rocalution_hessenberg_eigenvalues(int n, std::complex<double>* H, std::complex<double>* w);
+
     /** \brief Overloaded < operator for complex numbers */
     template <typename ValueType>
     bool operator<(const std::complex<ValueType>& lhs, const std::complex<ValueType>& rhs);
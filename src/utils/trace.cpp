@@ -0,0 +1,315 @@
+/* ************************************************************************
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "trace.hpp"
+#include "../base/backend_manager.hpp"
+#include "def.hpp"
+#include "log.hpp"
+#include "time_functions.hpp"
+
+#ifdef SUPPORT_HIP
+#include "../base/hip/backend_hip.hpp"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rocalution
+{
+#ifdef SUPPORT_TRACE
+    // Prefix of the trace files, the trace is recorded if it is not empty
+    static std::string       _rocalution_trace_file;
+    static std::atomic<bool> _rocalution_trace_on(false);
+
+    // Closed range of a host thread, with the accelerator events of the current stream
+    struct TraceEvent
+    {
+        std::string name;
+        int         tid;
+        double      begin;
+        double      end;
+        void*       dev_begin;
+        void*       dev_end;
+    };
+
+    // Open range of a host thread, ranges that have been opened while the trace was
+    // disabled are not recorded
+    struct TraceRange
+    {
+        std::string name;
+        double      begin;
+        void*       dev_begin;
+        bool        active;
+    };
+
+    // Upper bound of recorded ranges, such that long runs cannot exhaust the host memory
+    static const size_t _rocalution_trace_max_events = 1 << 22;
+
+    static std::vector<TraceEvent> _rocalution_trace_events;
+    static std::mutex              _rocalution_trace_mutex;
+    static bool                    _rocalution_trace_full = false;
+    static int                     _rocalution_trace_threads = 0;
+
+    // Host time and accelerator event of the trace origin
+    static double _rocalution_trace_origin = 0.0;
+    static void*  _rocalution_trace_ref    = NULL;
+
+    static thread_local int                     _rocalution_trace_tid = -1;
+    static thread_local std::vector<TraceRange> _rocalution_trace_open;
+
+    static void* _rocalution_trace_device_event(void)
+    {
+#ifdef SUPPORT_HIP
+        if(_rocalution_trace_ref != NULL && _rocalution_available_accelerator() == true)
+        {
+            return rocalution_hip_trace_event();
+        }
+#endif
+        return NULL;
+    }
+
+    static void _rocalution_trace_device_event_destroy(void* event)
+    {
+#ifdef SUPPORT_HIP
+        if(event != NULL)
+        {
+            rocalution_hip_trace_event_destroy(event);
+        }
+#endif
+    }
+
+    void _rocalution_trace_push(const char* name)
+    {
+        TraceRange range;
+
+        range.active    = _rocalution_trace_on.load(std::memory_order_relaxed);
+        range.begin     = 0.0;
+        range.dev_begin = NULL;
+
+        if(range.active == true)
+        {
+            range.name      = name;
+            range.dev_begin = _rocalution_trace_device_event();
+            range.begin     = rocalution_time();
+        }
+
+        _rocalution_trace_open.push_back(range);
+    }
+
+    void _rocalution_trace_pop(void)
+    {
+        if(_rocalution_trace_open.empty() == true)
+        {
+            return;
+        }
+
+        TraceRange& range = _rocalution_trace_open.back();
+
+        if(range.active == true)
+        {
+            TraceEvent event;
+
+            event.end       = rocalution_time();
+            event.dev_end   = (range.dev_begin != NULL) ? _rocalution_trace_device_event() : NULL;
+            event.begin     = range.begin;
+            event.dev_begin = range.dev_begin;
+            event.name      = range.name;
+
+            std::lock_guard<std::mutex> lock(_rocalution_trace_mutex);
+
+            if(_rocalution_trace_tid < 0)
+            {
+                _rocalution_trace_tid = _rocalution_trace_threads++;
+            }
+
+            event.tid = _rocalution_trace_tid;
+
+            if(_rocalution_trace_events.size() < _rocalution_trace_max_events)
+            {
+                _rocalution_trace_events.push_back(event);
+            }
+            else
+            {
+                if(_rocalution_trace_full == false)
+                {
+                    LOG_INFO("*** warning: The timeline trace is full, no more ranges are "
+                             "recorded");
+                    _rocalution_trace_full = true;
+                }
+
+                _rocalution_trace_device_event_destroy(event.dev_begin);
+                _rocalution_trace_device_event_destroy(event.dev_end);
+            }
+        }
+
+        _rocalution_trace_open.pop_back();
+    }
+
+    // Escape a range name for JSON
+    static std::string _rocalution_trace_escape(const std::string& name)
+    {
+        std::string str;
+
+        for(char c : name)
+        {
+            if(c == '"' || c == '\\')
+            {
+                str += '\\';
+            }
+
+            str += c;
+        }
+
+        return str;
+    }
+#endif // SUPPORT_TRACE
+
+    void set_trace_rocalution(const std::string& filename)
+    {
+        log_debug(0, "set_trace_rocalution()", filename);
+
+#ifdef SUPPORT_TRACE
+        std::lock_guard<std::mutex> lock(_rocalution_trace_mutex);
+
+        _rocalution_trace_file = filename;
+
+        if(filename.empty() == false && _rocalution_trace_origin == 0.0)
+        {
+#ifdef SUPPORT_HIP
+            // Accelerator timestamps are measured relative to this event
+            if(_rocalution_available_accelerator() == true)
+            {
+                _rocalution_trace_ref = rocalution_hip_trace_event();
+
+                if(_rocalution_trace_ref != NULL)
+                {
+                    rocalution_hip_trace_elapsed(_rocalution_trace_ref, _rocalution_trace_ref);
+                }
+            }
+#endif
+            _rocalution_trace_origin = rocalution_time();
+        }
+
+        _rocalution_trace_on = (filename.empty() == false);
+#else
+        if(filename.empty() == false)
+        {
+            LOG_INFO("*** warning: rocALUTION has been built without BUILD_WITH_TRACE, no "
+                     "timeline trace is recorded");
+        }
+#endif
+    }
+
+    void _rocalution_trace_write(void)
+    {
+#ifdef SUPPORT_TRACE
+        std::lock_guard<std::mutex> lock(_rocalution_trace_mutex);
+
+        if(_rocalution_trace_file.empty() == false)
+        {
+            int rank = std::max(_get_backend_descriptor()->rank, 0);
+
+            std::string   filename = _rocalution_trace_file + "." + std::to_string(rank) + ".json";
+            std::ofstream file(filename);
+
+            if(file.is_open() == false)
+            {
+                LOG_INFO("*** warning: Cannot write the timeline trace to " << filename);
+            }
+            else
+            {
+                // Chrome trace event format, one process per rank, accelerator ranges are
+                // shown on their own track
+                const int dev_tid = _rocalution_trace_threads;
+
+                file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+                file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+                     << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+
+                for(int t = 0; t < _rocalution_trace_threads; ++t)
+                {
+                    file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank
+                         << ",\"tid\":" << t << ",\"args\":{\"name\":\"host thread " << t
+                         << "\"}}";
+                }
+
+                file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank
+                     << ",\"tid\":" << dev_tid << ",\"args\":{\"name\":\"accelerator\"}}";
+
+                file.precision(3);
+                file << std::fixed;
+
+                for(const TraceEvent& event : _rocalution_trace_events)
+                {
+                    std::string name = _rocalution_trace_escape(event.name);
+
+                    file << ",\n{\"name\":\"" << name << "\",\"cat\":\"host\",\"ph\":\"X\","
+                         << "\"pid\":" << rank << ",\"tid\":" << event.tid
+                         << ",\"ts\":" << event.begin - _rocalution_trace_origin
+                         << ",\"dur\":" << event.end - event.begin << "}";
+
+#ifdef SUPPORT_HIP
+                    if(event.dev_begin != NULL && event.dev_end != NULL)
+                    {
+                        double begin
+                            = rocalution_hip_trace_elapsed(_rocalution_trace_ref, event.dev_begin);
+                        double end
+                            = rocalution_hip_trace_elapsed(_rocalution_trace_ref, event.dev_end);
+
+                        file << ",\n{\"name\":\"" << name
+                             << "\",\"cat\":\"accelerator\",\"ph\":\"X\",\"pid\":" << rank
+                             << ",\"tid\":" << dev_tid << ",\"ts\":" << begin
+                             << ",\"dur\":" << end - begin << "}";
+                    }
+#endif
+                }
+
+                file << "\n]}\n";
+
+                LOG_VERBOSE_INFO(2, "Timeline trace written to " << filename);
+            }
+        }
+
+        // Release the recorded ranges, the accelerator is stopped afterwards
+        for(const TraceEvent& event : _rocalution_trace_events)
+        {
+            _rocalution_trace_device_event_destroy(event.dev_begin);
+            _rocalution_trace_device_event_destroy(event.dev_end);
+        }
+
+        _rocalution_trace_device_event_destroy(_rocalution_trace_ref);
+
+        _rocalution_trace_events.clear();
+        _rocalution_trace_file.clear();
+        _rocalution_trace_on     = false;
+        _rocalution_trace_full   = false;
+        _rocalution_trace_origin = 0.0;
+        _rocalution_trace_ref    = NULL;
+#endif
+    }
+
+} // namespace rocalution
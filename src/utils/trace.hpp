@@ -0,0 +1,121 @@
+/* ************************************************************************
+ * Copyright (C) 2018-2020 Advanced Micro Devices, Inc. All rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_UTILS_TRACE_HPP_
+#define ROCALUTION_UTILS_TRACE_HPP_
+
+// Range markers for timeline profilers (rocprof, omnitrace) and for the built-in timeline
+// trace, see set_trace_rocalution(). The markers are only compiled in, if the library is
+// built with BUILD_WITH_ROCTX=ON or BUILD_WITH_TRACE=ON. Otherwise, the macros expand to
+// nothing and their arguments are not evaluated.
+namespace rocalution
+{
+    // Write the recorded timeline trace of this process, called from stop_rocalution()
+    void _rocalution_trace_write(void);
+
+} // namespace rocalution
+
+#if defined(SUPPORT_ROCTX) || defined(SUPPORT_TRACE)
+
+#ifdef SUPPORT_ROCTX
+#include <roctracer/roctx.h>
+#endif
+#include <string>
+
+namespace rocalution
+{
+
+#ifdef SUPPORT_TRACE
+    // Open / close a range of the built-in timeline trace
+    void _rocalution_trace_push(const char* name);
+    void _rocalution_trace_pop(void);
+#endif
+
+    inline void _rocalution_range_push(const char* name)
+    {
+#ifdef SUPPORT_ROCTX
+        roctxRangePush(name);
+#endif
+#ifdef SUPPORT_TRACE
+        _rocalution_trace_push(name);
+#endif
+    }
+
+    inline void _rocalution_range_push(const std::string& name)
+    {
+        _rocalution_range_push(name.c_str());
+    }
+
+    inline void _rocalution_range_pop(void)
+    {
+#ifdef SUPPORT_TRACE
+        _rocalution_trace_pop();
+#endif
+#ifdef SUPPORT_ROCTX
+        roctxRangePop();
+#endif
+    }
+
+    // Range that is open for the lifetime of the object
+    class RocalutionRange
+    {
+    public:
+        explicit RocalutionRange(const char* name)
+        {
+            _rocalution_range_push(name);
+        }
+
+        explicit RocalutionRange(const std::string& name)
+        {
+            _rocalution_range_push(name);
+        }
+
+        ~RocalutionRange()
+        {
+            _rocalution_range_pop();
+        }
+    };
+
+} // namespace rocalution
+
+#define ROCALUTION_RANGE_NAME_(line) _rocalution_range_##line
+#define ROCALUTION_RANGE_LINE_(line) ROCALUTION_RANGE_NAME_(line)
+
+// Open a range until the end of the current scope
+#define ROCALUTION_RANGE(name) \
+    rocalution::RocalutionRange ROCALUTION_RANGE_LINE_(__LINE__)(name)
+
+// Open and close a range explicitly
+#define ROCALUTION_RANGE_PUSH(name) rocalution::_rocalution_range_push(name)
+#define ROCALUTION_RANGE_POP() rocalution::_rocalution_range_pop()
+
+#else
+
+#define ROCALUTION_RANGE(name)
+#define ROCALUTION_RANGE_PUSH(name)
+#define ROCALUTION_RANGE_POP()
+
+#endif // SUPPORT_ROCTX || SUPPORT_TRACE
+
+#endif // ROCALUTION_UTILS_TRACE_HPP_